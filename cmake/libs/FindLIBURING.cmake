@@ -0,0 +1,22 @@
+# Find liburing libraries and headers.
+# If found, the following variables will be defined:
+# - LIBURING_FOUND: System has liburing.
+# - LIBURING_INCLUDE_DIRS: liburing include directories.
+# - LIBURING_LIBRARIES: liburing libraries.
+# - LIBURING_DEFINITIONS: Compiler switches required for using liburing.
+#
+# In addition, a target Liburing::uring will be created with all of
+# these definitions.
+#
+# References:
+# - https://cmake.org/Wiki/CMake:How_To_Find_Libraries
+# - http://francesco-cek.com/cmake-and-gtk-3-the-easy-way/
+#
+
+INCLUDE(FindLibraryPkgConfig)
+FIND_LIBRARY_PKG_CONFIG(LIBURING
+	liburing		# pkgconfig
+	liburing.h		# header
+	uring			# library
+	Liburing::uring		# imported target
+	)
@@ -43,6 +43,7 @@ IF(UNIX AND NOT APPLE)
 	SET(DIR_INSTALL_MIME "share/mime")
 	SET(DIR_INSTALL_DOC "share/doc/${PACKAGE_NAME}")
 	SET(DIR_INSTALL_DOC_ROOT "${DIR_INSTALL_DOC}")
+	SET(DIR_INSTALL_SHARE "share/rom-properties")
 	SET(DIR_INSTALL_CACHE "share/rom-properties/cache")
 	SET(DIR_INSTALL_EXE_DEBUG "lib/debug/${CMAKE_INSTALL_PREFIX}/${DIR_INSTALL_EXE}")
 	SET(DIR_INSTALL_DLL_DEBUG "lib/debug/${CMAKE_INSTALL_PREFIX}/${DIR_INSTALL_DLL}")
@@ -63,6 +64,7 @@ ELSEIF(APPLE)
 	SET(DIR_INSTALL_MIME "share/mime")
 	SET(DIR_INSTALL_DOC "share/doc/${PACKAGE_NAME}")
 	SET(DIR_INSTALL_DOC_ROOT "${DIR_INSTALL_DOC}")
+	SET(DIR_INSTALL_SHARE "share/rom-properties")
 	SET(DIR_INSTALL_CACHE "share/rom-properties/cache")
 	SET(DIR_INSTALL_EXE_DEBUG "lib/debug/${CMAKE_INSTALL_PREFIX}/${DIR_INSTALL_EXE}")
 	SET(DIR_INSTALL_DLL_DEBUG "lib/debug/${CMAKE_INSTALL_PREFIX}/${DIR_INSTALL_DLL}")
@@ -80,6 +82,7 @@ ELSEIF(WIN32)
 	SET(DIR_INSTALL_MIME "mime")
 	SET(DIR_INSTALL_DOC "doc")
 	SET(DIR_INSTALL_DOC_ROOT ".")
+	SET(DIR_INSTALL_SHARE "${arch}")	# NOTE: Data files are located in the DLL directory.
 	SET(DIR_INSTALL_CACHE "cache")	# NOTE: Not used on Windows.
 	SET(DIR_INSTALL_EXE_DEBUG "debug")
 	# Installing debug symbols for DLLs in the
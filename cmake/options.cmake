@@ -117,6 +117,36 @@ ENDIF(INSTALL_DEBUG AND NOT SPLIT_DEBUG)
 # Enable coverage checking. (gcc/clang only)
 OPTION(ENABLE_COVERAGE "Enable code coverage checking. (gcc/clang only)" OFF)
 
+# Profile-guided optimization. (gcc/clang only)
+# - GENERATE: Build instrumented binaries. Run the `pgo-train` target
+#   to collect profile data using PGO_TRAINING_CORPUS.
+# - USE: Rebuild using the collected profile data.
+# scripts/pgo-build.sh runs all of the steps.
+SET(ENABLE_PGO OFF CACHE STRING "Profile-guided optimization. (OFF, GENERATE, USE; gcc/clang only)")
+SET_PROPERTY(CACHE ENABLE_PGO PROPERTY STRINGS OFF GENERATE USE)
+SET(PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profile" CACHE PATH "Directory for profile-guided optimization data.")
+SET(PGO_TRAINING_CORPUS "" CACHE PATH "Training corpus directory for the `pgo-train` target.")
+
+# Enable hot-path tracing probes. (USDT on Linux, TraceLogging on Windows)
+OPTION(ENABLE_TRACING "Enable hot-path tracing probes. (USDT on Linux, TraceLogging on Windows)" OFF)
+
+# Enable per-subsystem allocation statistics.
+OPTION(ENABLE_ALLOC_STATS "Enable per-subsystem allocation statistics. (adds overhead to every tracked allocation)" OFF)
+
+# Use io_uring for asynchronous batch reads. (Linux only; requires liburing)
+IF(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+	OPTION(ENABLE_IO_URING "Use io_uring for asynchronous batch reads. (requires liburing)" OFF)
+ELSE(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+	SET(ENABLE_IO_URING OFF)
+ENDIF(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+
+# Share decoded images between processes using shared memory.
+OPTION(ENABLE_SHARED_IMAGE_CACHE "Share decoded images between processes, e.g. the thumbnailer and the properties page." ON)
+
+# Decode large block-compressed textures on the GPU using OpenCL.
+# OpenCL is loaded at runtime, so it isn't required at build time.
+OPTION(ENABLE_GPU_DECODE "Decode large block-compressed textures on the GPU using OpenCL, if available at runtime." ON)
+
 # Enable NLS. (internationalization)
 OPTION(ENABLE_NLS "Enable NLS using gettext for localized messages." ON)
 
@@ -105,6 +105,62 @@ IF(ENABLE_COVERAGE)
 		)
 ENDIF(ENABLE_COVERAGE)
 
+# Profile-guided optimization.
+IF(ENABLE_PGO STREQUAL "GENERATE" OR ENABLE_PGO STREQUAL "USE")
+	IF("${CMAKE_CXX_COMPILER_ID}" MATCHES "(Apple)?[Cc]lang")
+		SET(PGO_IS_CLANG ON)
+	ELSEIF(NOT CMAKE_COMPILER_IS_GNUCXX)
+		MESSAGE(FATAL_ERROR "Profile-guided optimization is currently only supported on gcc and clang.")
+	ENDIF()
+
+	# NOTE: gcc names the .gcda files using the object file paths,
+	# so the GENERATE and USE builds must use the same build directory.
+	IF(ENABLE_PGO STREQUAL "GENERATE")
+		SET(RP_C_FLAGS_PGO "-fprofile-generate=${PGO_PROFILE_DIR}")
+		SET(RP_LINKER_FLAGS_PGO "-fprofile-generate=${PGO_PROFILE_DIR}")
+		IF(NOT PGO_IS_CLANG)
+			# ThreadPool workers update the counters concurrently.
+			CHECK_C_COMPILER_FLAG("-fprofile-update=atomic" CFLAG_PROFILE_UPDATE_ATOMIC)
+			IF(CFLAG_PROFILE_UPDATE_ATOMIC)
+				SET(RP_C_FLAGS_PGO "${RP_C_FLAGS_PGO} -fprofile-update=atomic")
+			ENDIF(CFLAG_PROFILE_UPDATE_ATOMIC)
+			UNSET(CFLAG_PROFILE_UPDATE_ATOMIC)
+		ENDIF(NOT PGO_IS_CLANG)
+	ELSE()
+		IF(PGO_IS_CLANG)
+			# clang needs the merged .profdata file. (See scripts/pgo-train.sh.)
+			SET(PGO_PROFDATA "${PGO_PROFILE_DIR}/rom-properties.profdata")
+			IF(NOT EXISTS "${PGO_PROFDATA}")
+				MESSAGE(FATAL_ERROR "${PGO_PROFDATA} not found; run the pgo-train target in an ENABLE_PGO=GENERATE build first.")
+			ENDIF(NOT EXISTS "${PGO_PROFDATA}")
+			SET(RP_C_FLAGS_PGO "-fprofile-use=${PGO_PROFDATA} -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date")
+			SET(RP_LINKER_FLAGS_PGO "-fprofile-use=${PGO_PROFDATA}")
+			UNSET(PGO_PROFDATA)
+		ELSE(PGO_IS_CLANG)
+			IF(NOT EXISTS "${PGO_PROFILE_DIR}")
+				MESSAGE(FATAL_ERROR "${PGO_PROFILE_DIR} not found; run the pgo-train target in an ENABLE_PGO=GENERATE build first.")
+			ENDIF(NOT EXISTS "${PGO_PROFILE_DIR}")
+			# -fprofile-correction handles inconsistent counters from
+			# multithreaded code if -fprofile-update=atomic isn't available.
+			SET(RP_C_FLAGS_PGO "-fprofile-use=${PGO_PROFILE_DIR} -fprofile-correction")
+			SET(RP_LINKER_FLAGS_PGO "-fprofile-use=${PGO_PROFILE_DIR}")
+			# Files that weren't covered by the training corpus are
+			# optimized normally, so don't warn about them.
+			CHECK_C_COMPILER_FLAG("-Wno-missing-profile" CFLAG_NO_MISSING_PROFILE)
+			IF(CFLAG_NO_MISSING_PROFILE)
+				SET(RP_C_FLAGS_PGO "${RP_C_FLAGS_PGO} -Wno-missing-profile")
+			ENDIF(CFLAG_NO_MISSING_PROFILE)
+			UNSET(CFLAG_NO_MISSING_PROFILE)
+		ENDIF(PGO_IS_CLANG)
+	ENDIF()
+
+	SET(RP_C_FLAGS_COMMON "${RP_C_FLAGS_COMMON} ${RP_C_FLAGS_PGO}")
+	SET(RP_CXX_FLAGS_COMMON "${RP_CXX_FLAGS_COMMON} ${RP_C_FLAGS_PGO}")
+	UNSET(PGO_IS_CLANG)
+ELSEIF(ENABLE_PGO)
+	MESSAGE(FATAL_ERROR "Invalid value for ENABLE_PGO: ${ENABLE_PGO} (must be OFF, GENERATE, or USE)")
+ENDIF()
+
 # Test for common LDFLAGS.
 # NOTE: CHECK_C_COMPILER_FLAG() doesn't seem to work, even with
 # CMAKE_TRY_COMPILE_TARGET_TYPE. Check `ld --help` for the various
@@ -192,6 +248,10 @@ IF(NOT WIN32)
 	ENDFOREACH()
 ENDIF(NOT WIN32)
 
+IF(RP_LINKER_FLAGS_PGO)
+	SET(RP_EXE_LINKER_FLAGS_COMMON "${RP_EXE_LINKER_FLAGS_COMMON} ${RP_LINKER_FLAGS_PGO}")
+ENDIF(RP_LINKER_FLAGS_PGO)
+
 SET(RP_SHARED_LINKER_FLAGS_COMMON "${RP_EXE_LINKER_FLAGS_COMMON}")
 SET(RP_MODULE_LINKER_FLAGS_COMMON "${RP_EXE_LINKER_FLAGS_COMMON}")
 
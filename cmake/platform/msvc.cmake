@@ -105,6 +105,11 @@ IF(ENABLE_COVERAGE)
 	MESSAGE(FATAL_ERROR "Code coverage testing is currently only supported on gcc and clang.")
 ENDIF(ENABLE_COVERAGE)
 
+# TODO: Profile-guided optimization for MSVC? (/GENPROFILE, /USEPROFILE)
+IF(ENABLE_PGO)
+	MESSAGE(FATAL_ERROR "Profile-guided optimization is currently only supported on gcc and clang.")
+ENDIF(ENABLE_PGO)
+
 # Debug/release flags.
 SET(RP_C_FLAGS_DEBUG			"/Zi")
 SET(RP_CXX_FLAGS_DEBUG			"/Zi")
@@ -37,11 +37,6 @@ struct PVRTCWord
 	uint32_t colorData;
 };
 
-struct PVRTCWordIndices
-{
-	int P[2], Q[2], R[2], S[2];
-};
-
 template<bool PVRTCII>
 static Pixel32 getColorA(uint32_t colorData)
 {
@@ -97,99 +92,13 @@ static Pixel32 getColorB(uint32_t colorData)
 	return color;
 }
 
-static void interpolateColors(Pixel32 P, Pixel32 Q, Pixel32 R, Pixel32 S, Pixel128S* pPixel, uint8_t bpp)
-{
-	uint32_t wordWidth = 4;
-	uint32_t wordHeight = 4;
-	if (bpp == 2) { wordWidth = 8; }
-
-	// Convert to int 32.
-	Pixel128S hP = { static_cast<int32_t>(P.red), static_cast<int32_t>(P.green), static_cast<int32_t>(P.blue), static_cast<int32_t>(P.alpha) };
-	Pixel128S hQ = { static_cast<int32_t>(Q.red), static_cast<int32_t>(Q.green), static_cast<int32_t>(Q.blue), static_cast<int32_t>(Q.alpha) };
-	Pixel128S hR = { static_cast<int32_t>(R.red), static_cast<int32_t>(R.green), static_cast<int32_t>(R.blue), static_cast<int32_t>(R.alpha) };
-	Pixel128S hS = { static_cast<int32_t>(S.red), static_cast<int32_t>(S.green), static_cast<int32_t>(S.blue), static_cast<int32_t>(S.alpha) };
-
-	// Get vectors.
-	Pixel128S QminusP = { hQ.red - hP.red, hQ.green - hP.green, hQ.blue - hP.blue, hQ.alpha - hP.alpha };
-	Pixel128S SminusR = { hS.red - hR.red, hS.green - hR.green, hS.blue - hR.blue, hS.alpha - hR.alpha };
-
-	// Multiply colors.
-	hP.red *= wordWidth;
-	hP.green *= wordWidth;
-	hP.blue *= wordWidth;
-	hP.alpha *= wordWidth;
-	hR.red *= wordWidth;
-	hR.green *= wordWidth;
-	hR.blue *= wordWidth;
-	hR.alpha *= wordWidth;
-
-	if (bpp == 2)
-	{
-		// Loop through pixels to achieve results.
-		for (uint32_t x = 0; x < wordWidth; x++)
-		{
-			Pixel128S result = { 4 * hP.red, 4 * hP.green, 4 * hP.blue, 4 * hP.alpha };
-			Pixel128S dY = { hR.red - hP.red, hR.green - hP.green, hR.blue - hP.blue, hR.alpha - hP.alpha };
-
-			for (uint32_t y = 0; y < wordHeight; y++)
-			{
-				pPixel[y * wordWidth + x].red = static_cast<int32_t>((result.red >> 7) + (result.red >> 2));
-				pPixel[y * wordWidth + x].green = static_cast<int32_t>((result.green >> 7) + (result.green >> 2));
-				pPixel[y * wordWidth + x].blue = static_cast<int32_t>((result.blue >> 7) + (result.blue >> 2));
-				pPixel[y * wordWidth + x].alpha = static_cast<int32_t>((result.alpha >> 5) + (result.alpha >> 1));
-
-				result.red += dY.red;
-				result.green += dY.green;
-				result.blue += dY.blue;
-				result.alpha += dY.alpha;
-			}
-
-			hP.red += QminusP.red;
-			hP.green += QminusP.green;
-			hP.blue += QminusP.blue;
-			hP.alpha += QminusP.alpha;
-
-			hR.red += SminusR.red;
-			hR.green += SminusR.green;
-			hR.blue += SminusR.blue;
-			hR.alpha += SminusR.alpha;
-		}
-	}
-	else
-	{
-		// Loop through pixels to achieve results.
-		for (uint32_t y = 0; y < wordHeight; y++)
-		{
-			Pixel128S result = { 4 * hP.red, 4 * hP.green, 4 * hP.blue, 4 * hP.alpha };
-			Pixel128S dY = { hR.red - hP.red, hR.green - hP.green, hR.blue - hP.blue, hR.alpha - hP.alpha };
-
-			for (uint32_t x = 0; x < wordWidth; x++)
-			{
-				pPixel[y * wordWidth + x].red = static_cast<int32_t>((result.red >> 6) + (result.red >> 1));
-				pPixel[y * wordWidth + x].green = static_cast<int32_t>((result.green >> 6) + (result.green >> 1));
-				pPixel[y * wordWidth + x].blue = static_cast<int32_t>((result.blue >> 6) + (result.blue >> 1));
-				pPixel[y * wordWidth + x].alpha = static_cast<int32_t>((result.alpha >> 4) + (result.alpha));
-
-				result.red += dY.red;
-				result.green += dY.green;
-				result.blue += dY.blue;
-				result.alpha += dY.alpha;
-			}
-
-			hP.red += QminusP.red;
-			hP.green += QminusP.green;
-			hP.blue += QminusP.blue;
-			hP.alpha += QminusP.alpha;
-
-			hR.red += SminusR.red;
-			hR.green += SminusR.green;
-			hR.blue += SminusR.blue;
-			hR.alpha += SminusR.alpha;
-		}
-	}
-}
-
-static void unpackModulations(const PVRTCWord& word, int32_t offsetX, int32_t offsetY, int32_t modulationValues[16][8], int32_t modulationModes[16][8], uint8_t bpp)
+/// rom-properties: Modulation values are unpacked into an image-sized
+/// buffer so each word is only unpacked once.
+/// 4bpp values are final n/8 values (+10 for punch-through alpha).
+/// 2bpp values are the n/8 values of the stored pixels; use getModulationRow2bpp()
+/// to interpolate the remaining pixels.
+/// Returns the word's modulation mode. (2bpp only)
+static uint8_t unpackModulations(const PVRTCWord& word, uint8_t* pModulationValues, uint32_t stride, uint8_t bpp)
 {
 	uint32_t WordModMode = word.colorData & 0x1;
 	uint32_t ModulationBits = word.modulationData;
@@ -197,6 +106,8 @@ static void unpackModulations(const PVRTCWord& word, int32_t offsetX, int32_t of
 	// Unpack differently depending on 2bpp or 4bpp modes.
 	if (bpp == 2)
 	{
+		static const uint8_t RepVals0[4] = { 0, 3, 5, 8 };
+
 		if (WordModMode)
 		{
 			// determine which of the three modes are in use:
@@ -241,36 +152,35 @@ static void unpackModulations(const PVRTCWord& word, int32_t offsetX, int32_t of
 
 			// run through all the pixels in the block. Note we can now treat all the
 			// "stored" values as if they have 2bits (even when they didn't!)
-			for (uint8_t y = 0; y < 4; y++)
+			for (uint8_t y = 0; y < 4; y++, pModulationValues += stride)
 			{
 				for (uint8_t x = 0; x < 8; x++)
 				{
-					modulationModes[static_cast<uint32_t>(x + offsetX)][static_cast<uint32_t>(y + offsetY)] = WordModMode;
-
 					// if this is a stored value...
-					if (((x ^ y) & 1) == 0) {modulationValues[static_cast<uint32_t>(x + offsetX)][static_cast<uint32_t>(y + offsetY)] = ModulationBits & 3;
+					if (((x ^ y) & 1) == 0)
+					{
+						pModulationValues[x] = RepVals0[ModulationBits & 3];
 						ModulationBits >>= 2;
 					}
+					else
+					{
+						// Interpolated from the neighbours.
+						pModulationValues[x] = 0;
+					}
 				}
 			} // end for y
 		}
 		// else if direct encoded 2bit mode - i.e. 1 mode bit per pixel
 		else
 		{
-			for (uint8_t y = 0; y < 4; y++)
+			for (uint8_t y = 0; y < 4; y++, pModulationValues += stride)
 			{
 				for (uint8_t x = 0; x < 8; x++)
 				{
-					modulationModes[static_cast<uint32_t>(x + offsetX)][static_cast<uint32_t>(y + offsetY)] = WordModMode;
-
 					/*
 					// double the bits so 0=> 00, and 1=>11
 					*/
-					if (ModulationBits & 1) { modulationValues[static_cast<uint32_t>(x + offsetX)][static_cast<uint32_t>(y + offsetY)] = 0x3; }
-					else
-					{
-						modulationValues[static_cast<uint32_t>(x + offsetX)][static_cast<uint32_t>(y + offsetY)] = 0x0;
-					}
+					pModulationValues[x] = RepVals0[(ModulationBits & 1) ? 0x3 : 0x0];
 					ModulationBits >>= 1;
 				}
 			} // end for y
@@ -280,167 +190,57 @@ static void unpackModulations(const PVRTCWord& word, int32_t offsetX, int32_t of
 	{
 		// Much simpler than the 2bpp decompression, only two modes, so the n/8 values are set directly.
 		// run through all the pixels in the word.
-		if (WordModMode)
-		{
-			for (uint8_t y = 0; y < 4; y++)
-			{
-				for (uint8_t x = 0; x < 4; x++)
-				{
-					modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] = ModulationBits & 3;
-					// if (modulationValues==0) {}. We don't need to check 0, 0 = 0/8.
-					if (modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] == 1)
-					{ modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] = 4; }
-					else if (modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] == 2)
-					{
-						modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] = 14; //+10 tells the decompressor to punch through alpha.
-					}
-					else if (modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] == 3)
-					{
-						modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] = 8;
-					}
-					ModulationBits >>= 2;
-				} // end for x
-			} // end for y
-		}
-		else
+		// +10 tells the decompressor to punch through alpha.
+		static const uint8_t ModVals[2][4] = {
+			{ 0, 3, 5, 8 },		// direct
+			{ 0, 4, 14, 8 },	// punch-through
+		};
+		const uint8_t* const pModVals = ModVals[WordModMode];
+		for (uint8_t y = 0; y < 4; y++, pModulationValues += stride)
 		{
-			for (uint8_t y = 0; y < 4; y++)
-			{
-				for (uint8_t x = 0; x < 4; x++)
-				{
-					modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] = ModulationBits & 3;
-					modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] *= 3;
-					if (modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] > 3)
-					{ modulationValues[static_cast<uint32_t>(y + offsetY)][static_cast<uint32_t>(x + offsetX)] -= 1; }
-					ModulationBits >>= 2;
-				} // end for x
-			} // end for y
-		}
-	}
-}
-
-static int32_t getModulationValues(int32_t modulationValues[16][8], int32_t modulationModes[16][8], uint32_t xPos, uint32_t yPos, uint8_t bpp)
-{
-	if (bpp == 2)
-	{
-		const int32_t RepVals0[4] = { 0, 3, 5, 8 };
-
-		// extract the modulation value. If a simple encoding
-		if (modulationModes[xPos][yPos] == 0) { return RepVals0[modulationValues[xPos][yPos]]; }
-		else
-		{
-			// if this is a stored value
-			if (((xPos ^ yPos) & 1) == 0) { return RepVals0[modulationValues[xPos][yPos]]; }
-
-			// else average from the neighbours
-			// if H&V interpolation...
-			else if (modulationModes[xPos][yPos] == 1)
-			{
-				return (RepVals0[modulationValues[xPos][yPos - 1]] + RepVals0[modulationValues[xPos][yPos + 1]] + RepVals0[modulationValues[xPos - 1][yPos]] +
-						   RepVals0[modulationValues[xPos + 1][yPos]] + 2) /
-					4;
-			}
-			// else if H-Only
-			else if (modulationModes[xPos][yPos] == 2)
-			{
-				return (RepVals0[modulationValues[xPos - 1][yPos]] + RepVals0[modulationValues[xPos + 1][yPos]] + 1) / 2;
-			}
-			// else it's V-Only
-			else
+			for (uint8_t x = 0; x < 4; x++)
 			{
-				return (RepVals0[modulationValues[xPos][yPos - 1]] + RepVals0[modulationValues[xPos][yPos + 1]] + 1) / 2;
-			}
-		}
-	}
-	else if (bpp == 4)
-	{
-		return modulationValues[xPos][yPos];
+				pModulationValues[x] = pModVals[ModulationBits & 3];
+				ModulationBits >>= 2;
+			} // end for x
+		} // end for y
 	}
 
-	return 0;
+	return static_cast<uint8_t>(WordModMode);
 }
 
-template<bool PVRTCII>
-static void pvrtcGetDecompressedPixels(const PVRTCWord& P, const PVRTCWord& Q, const PVRTCWord& R, const PVRTCWord& S, Pixel32* pColorData, uint8_t bpp)
+/// rom-properties: Get the modulation values for a row of 2bpp pixels.
+/// Neighbouring values wrap around the edges of the image.
+static void getModulationRow2bpp(const uint8_t* pModulationValues, const uint8_t* pModulationModes,
+	uint32_t width, uint32_t height, uint32_t yPos, uint8_t* pOutput)
 {
-	// 4bpp only needs 8*8 values, but 2bpp needs 16*8, so rather than wasting processor time we just statically allocate 16*8.
-	int32_t modulationValues[16][8];
-	// Only 2bpp needs this.
-	int32_t modulationModes[16][8];
-	// 4bpp only needs 16 values, but 2bpp needs 32, so rather than wasting processor time we just statically allocate 32.
-	Pixel128S upscaledColorA[32];
-	Pixel128S upscaledColorB[32];
-
-	uint32_t wordWidth = 4;
-	uint32_t wordHeight = 4;
-	if (bpp == 2) { wordWidth = 8; }
-
-	// Get the modulations from each word.
-	unpackModulations(P, 0, 0, modulationValues, modulationModes, bpp);
-	unpackModulations(Q, wordWidth, 0, modulationValues, modulationModes, bpp);
-	unpackModulations(R, 0, wordHeight, modulationValues, modulationModes, bpp);
-	unpackModulations(S, wordWidth, wordHeight, modulationValues, modulationModes, bpp);
+	const uint8_t* const pRow = &pModulationValues[yPos * width];
+	const uint8_t* const pRowPrev = &pModulationValues[((yPos > 0 ? yPos : height) - 1) * width];
+	const uint8_t* const pRowNext = &pModulationValues[(yPos + 1 < height ? yPos + 1 : 0) * width];
 
-	// Bilinear upscale image data from 2x2 -> 4x4
-	interpolateColors(getColorA<PVRTCII>(P.colorData), getColorA<PVRTCII>(Q.colorData),
-		getColorA<PVRTCII>(R.colorData), getColorA<PVRTCII>(S.colorData), upscaledColorA, bpp);
-	interpolateColors(getColorB<PVRTCII>(P.colorData), getColorB<PVRTCII>(Q.colorData),
-		getColorB<PVRTCII>(R.colorData), getColorB<PVRTCII>(S.colorData), upscaledColorB, bpp);
-
-	for (uint32_t y = 0; y < wordHeight; y++)
+	for (uint32_t xPos = 0; xPos < width; xPos++)
 	{
-		for (uint32_t x = 0; x < wordWidth; x++)
-		{
-			int32_t mod = getModulationValues(modulationValues, modulationModes, x + wordWidth / 2, y + wordHeight / 2, bpp);
-			bool punchthroughAlpha = false;
-			if (mod > 10)
-			{
-				punchthroughAlpha = true;
-				mod -= 10;
-			}
-
-			Pixel128S result;
-			if (PVRTCII && punchthroughAlpha)
-			{
-				// PVRTC-II: Punch-through alpha sets the RGB values to 0.
-				result.red = 0;
-				result.green = 0;
-				result.blue = 0;
-				result.alpha = 0;
-			}
-			else
-			{
-				result.red = (upscaledColorA[y * wordWidth + x].red * (8 - mod) + upscaledColorB[y * wordWidth + x].red * mod) / 8;
-				result.green = (upscaledColorA[y * wordWidth + x].green * (8 - mod) + upscaledColorB[y * wordWidth + x].green * mod) / 8;
-				result.blue = (upscaledColorA[y * wordWidth + x].blue * (8 - mod) + upscaledColorB[y * wordWidth + x].blue * mod) / 8;
-				if (punchthroughAlpha) { result.alpha = 0; }
-				else
-				{
-					result.alpha = (upscaledColorA[y * wordWidth + x].alpha * (8 - mod) + upscaledColorB[y * wordWidth + x].alpha * mod) / 8;
-				}
-			}
-
-			// Convert the 32bit precision Result to 8 bit per channel color.
-			if (bpp == 2)
-			{
-				pColorData[y * wordWidth + x].red = static_cast<uint8_t>(result.red);
-				pColorData[y * wordWidth + x].green = static_cast<uint8_t>(result.green);
-				pColorData[y * wordWidth + x].blue = static_cast<uint8_t>(result.blue);
-				pColorData[y * wordWidth + x].alpha = static_cast<uint8_t>(result.alpha);
-			}
-			else if (bpp == 4)
-			{
-				pColorData[y + x * wordHeight].red = static_cast<uint8_t>(result.red);
-				pColorData[y + x * wordHeight].green = static_cast<uint8_t>(result.green);
-				pColorData[y + x * wordHeight].blue = static_cast<uint8_t>(result.blue);
-				pColorData[y + x * wordHeight].alpha = static_cast<uint8_t>(result.alpha);
-			}
-		}
+		const uint32_t xPrev = (xPos > 0 ? xPos : width) - 1;
+		const uint32_t xNext = (xPos + 1 < width ? xPos + 1 : 0);
+		const int32_t stored = pRow[xPos];
+
+		// if a simple encoding or if this is a stored value, use it as-is.
+		// else average from the neighbours.
+		// NOTE: All values are calculated and then selected, since
+		// the modulation modes are effectively random.
+		const int32_t left = pRow[xPrev], right = pRow[xNext];
+		const int32_t up = pRowPrev[xPos], down = pRowNext[xPos];
+		const int32_t values[4] = {
+			stored,				// simple encoding
+			(up + down + left + right + 2) / 4,	// H&V interpolation
+			(left + right + 1) / 2,		// H-Only
+			(up + down + 1) / 2,		// V-Only
+		};
+		const uint32_t mode = (((xPos ^ yPos) & 1) != 0 ? pModulationModes[xPos / 8] : 0);
+		pOutput[xPos] = static_cast<uint8_t>(values[mode]);
 	}
 }
 
-static uint32_t wrapWordIndex(uint32_t numWords, int word) { return ((word + numWords) % numWords); }
-
 static bool isPowerOf2(uint32_t input)
 {
 	uint32_t minus1;
@@ -499,84 +299,178 @@ static uint32_t TwiddleUV(uint32_t XSize, uint32_t YSize, uint32_t XPos, uint32_
 	}
 }
 
-static void mapDecompressedData(Pixel32* pOutput, uint32_t width, const Pixel32* pWord, const PVRTCWordIndices& words, uint8_t bpp)
+/// rom-properties: Each word's colors and modulation values are decoded
+/// once, instead of once for each of the four 2x2 word groups that use it.
+/// The A/B colors are then upscaled one row at a time: each row is first
+/// interpolated vertically per word, then horizontally per pixel.
+template<bool PVRTCII>
+static uint32_t pvrtcDecompress(uint8_t* pCompressedData, Pixel32* pDecompressedData, uint32_t width, uint32_t height, uint8_t bpp)
 {
 	uint32_t wordWidth = 4;
 	uint32_t wordHeight = 4;
 	if (bpp == 2) { wordWidth = 8; }
 
-	for (uint32_t y = 0; y < wordHeight / 2; y++)
+	const uint32_t* pWordMembers = (const uint32_t*)pCompressedData;
+
+	// Calculate number of words
+	const uint32_t numXWords = width / wordWidth;
+	const uint32_t numYWords = height / wordHeight;
+
+	// Decode the colors and modulation values of each word.
+	std::vector<Pixel32> colorsA(numXWords * numYWords);
+	std::vector<Pixel32> colorsB(numXWords * numYWords);
+	std::vector<uint8_t> modulationModes(numXWords * numYWords);
+	std::vector<uint8_t> modulationValues(width * height);
+	for (uint32_t wordY = 0; wordY < numYWords; wordY++)
 	{
-		for (uint32_t x = 0; x < wordWidth / 2; x++)
+		for (uint32_t wordX = 0; wordX < numXWords; wordX++)
 		{
-			pOutput[(((words.P[1] * wordHeight) + y + wordHeight / 2) * width + words.P[0] * wordWidth + x + wordWidth / 2)] = pWord[y * wordWidth + x]; // map P
+			// Work out the offset into the twiddle structs, multiply by two as there are two members per word.
+			const uint32_t wordOffset = TwiddleUV<PVRTCII>(numXWords, numYWords, wordX, wordY) * 2;
+
+			PVRTCWord word;
+			word.modulationData = static_cast<uint32_t>(pWordMembers[wordOffset]);
+			word.colorData = static_cast<uint32_t>(pWordMembers[wordOffset + 1]);
+
+			const uint32_t idx = wordY * numXWords + wordX;
+			colorsA[idx] = getColorA<PVRTCII>(word.colorData);
+			colorsB[idx] = getColorB<PVRTCII>(word.colorData);
+			modulationModes[idx] = unpackModulations(word,
+				&modulationValues[(wordY * wordHeight * width) + (wordX * wordWidth)], width, bpp);
+		}
+	}
 
-			pOutput[(((words.Q[1] * wordHeight) + y + wordHeight / 2) * width + words.Q[0] * wordWidth + x)] = pWord[y * wordWidth + x + wordWidth / 2]; // map Q
+	// Shifts to convert the upscaled colors to 8 bits per channel.
+	const int rgbShift1 = (bpp == 2 ? 7 : 6);
+	const int rgbShift2 = (bpp == 2 ? 2 : 1);
+	const int alphaShift1 = (bpp == 2 ? 5 : 4);
+	const int alphaShift2 = (bpp == 2 ? 1 : 0);
+
+	// Vertically-interpolated colors for the current row.
+	std::vector<Pixel128S> rowColorsA(numXWords);
+	std::vector<Pixel128S> rowColorsB(numXWords);
+	// Upscaled colors for the current row.
+	std::vector<Pixel128S> upscaledColorA(width);
+	std::vector<Pixel128S> upscaledColorB(width);
+	// 2bpp modulation values for the current row.
+	std::vector<uint8_t> rowModulationValues(bpp == 2 ? width : 0);
+
+	// Each 2x2 word group covers the pixels between the centres of its words,
+	// so the first group starts at (wordWidth / 2, wordHeight / 2) and the
+	// last group wraps around to the left and top edges.
+	for (uint32_t wordY = 0; wordY < numYWords; wordY++)
+	{
+		const uint32_t nextWordY = (wordY + 1 < numYWords ? wordY + 1 : 0);
+		const Pixel32* pA0 = &colorsA[wordY * numXWords];
+		const Pixel32* pA1 = &colorsA[nextWordY * numXWords];
+		const Pixel32* pB0 = &colorsB[wordY * numXWords];
+		const Pixel32* pB1 = &colorsB[nextWordY * numXWords];
 
-			pOutput[(((words.R[1] * wordHeight) + y) * width + words.R[0] * wordWidth + x + wordWidth / 2)] = pWord[(y + wordHeight / 2) * wordWidth + x]; // map R
+		for (uint32_t r = 0; r < wordHeight; r++)
+		{
+			uint32_t y = wordY * wordHeight + wordHeight / 2 + r;
+			if (y >= height) { y -= height; }
+			const uint8_t* pModValues = &modulationValues[y * width];
+			Pixel32* pOutput = &pDecompressedData[y * width];
 
-			pOutput[(((words.S[1] * wordHeight) + y) * width + words.S[0] * wordWidth + x)] = pWord[(y + wordHeight / 2) * wordWidth + x + wordWidth / 2]; // map S
-		}
-	}
-}
-template<bool PVRTCII>
-static uint32_t pvrtcDecompress(uint8_t* pCompressedData, Pixel32* pDecompressedData, uint32_t width, uint32_t height, uint8_t bpp)
-{
-	uint32_t wordWidth = 4;
-	uint32_t wordHeight = 4;
-	if (bpp == 2) { wordWidth = 8; }
+			if (bpp == 2)
+			{
+				// Resolve the interpolated modulation values for this row.
+				const uint8_t* pModModes = &modulationModes[(y / wordHeight) * numXWords];
+				getModulationRow2bpp(modulationValues.data(), pModModes, width, height, y, rowModulationValues.data());
+				pModValues = rowModulationValues.data();
+			}
 
-	uint32_t* pWordMembers = (uint32_t*)pCompressedData;
-	Pixel32* pOutData = pDecompressedData;
+			// Interpolate the colors vertically.
+			const int32_t r0 = static_cast<int32_t>(wordHeight - r);
+			const int32_t r1 = static_cast<int32_t>(r);
+			for (uint32_t wordX = 0; wordX < numXWords; wordX++)
+			{
+				rowColorsA[wordX].red = r0 * pA0[wordX].red + r1 * pA1[wordX].red;
+				rowColorsA[wordX].green = r0 * pA0[wordX].green + r1 * pA1[wordX].green;
+				rowColorsA[wordX].blue = r0 * pA0[wordX].blue + r1 * pA1[wordX].blue;
+				rowColorsA[wordX].alpha = r0 * pA0[wordX].alpha + r1 * pA1[wordX].alpha;
+				rowColorsB[wordX].red = r0 * pB0[wordX].red + r1 * pB1[wordX].red;
+				rowColorsB[wordX].green = r0 * pB0[wordX].green + r1 * pB1[wordX].green;
+				rowColorsB[wordX].blue = r0 * pB0[wordX].blue + r1 * pB1[wordX].blue;
+				rowColorsB[wordX].alpha = r0 * pB0[wordX].alpha + r1 * pB1[wordX].alpha;
+			}
 
-	// Calculate number of words
-	int i32NumXWords = static_cast<int>(width / wordWidth);
-	int i32NumYWords = static_cast<int>(height / wordHeight);
+			// Interpolate the colors horizontally.
+			for (uint32_t wordX = 0; wordX < numXWords; wordX++)
+			{
+				const uint32_t nextWordX = (wordX + 1 < numXWords ? wordX + 1 : 0);
+				const Pixel128S& hA0 = rowColorsA[wordX];
+				const Pixel128S& hA1 = rowColorsA[nextWordX];
+				const Pixel128S& hB0 = rowColorsB[wordX];
+				const Pixel128S& hB1 = rowColorsB[nextWordX];
 
-	// Structs used for decompression
-	PVRTCWordIndices indices;
-	std::vector<Pixel32> pPixels(wordWidth * wordHeight * sizeof(Pixel32));
+				for (uint32_t c = 0; c < wordWidth; c++)
+				{
+					uint32_t x = wordX * wordWidth + wordWidth / 2 + c;
+					if (x >= width) { x -= width; }
+
+					const int32_t c0 = static_cast<int32_t>(wordWidth - c);
+					const int32_t c1 = static_cast<int32_t>(c);
+					Pixel128S& colorA = upscaledColorA[x];
+					Pixel128S& colorB = upscaledColorB[x];
+					colorA.red = c0 * hA0.red + c1 * hA1.red;
+					colorA.green = c0 * hA0.green + c1 * hA1.green;
+					colorA.blue = c0 * hA0.blue + c1 * hA1.blue;
+					colorA.alpha = c0 * hA0.alpha + c1 * hA1.alpha;
+					colorB.red = c0 * hB0.red + c1 * hB1.red;
+					colorB.green = c0 * hB0.green + c1 * hB1.green;
+					colorB.blue = c0 * hB0.blue + c1 * hB1.blue;
+					colorB.alpha = c0 * hB0.alpha + c1 * hB1.alpha;
+				}
+			}
 
-	// For each row of words
-	for (int32_t wordY = -1; wordY < i32NumYWords - 1; wordY++)
-	{
-		// for each column of words
-		for (int32_t wordX = -1; wordX < i32NumXWords - 1; wordX++)
-		{
-			indices.P[0] = static_cast<int>(wrapWordIndex(i32NumXWords, wordX));
-			indices.P[1] = static_cast<int>(wrapWordIndex(i32NumYWords, wordY));
-			indices.Q[0] = static_cast<int>(wrapWordIndex(i32NumXWords, wordX + 1));
-			indices.Q[1] = static_cast<int>(wrapWordIndex(i32NumYWords, wordY));
-			indices.R[0] = static_cast<int>(wrapWordIndex(i32NumXWords, wordX));
-			indices.R[1] = static_cast<int>(wrapWordIndex(i32NumYWords, wordY + 1));
-			indices.S[0] = static_cast<int>(wrapWordIndex(i32NumXWords, wordX + 1));
-			indices.S[1] = static_cast<int>(wrapWordIndex(i32NumYWords, wordY + 1));
-
-			// Work out the offsets into the twiddle structs, multiply by two as there are two members per word.
-			uint32_t WordOffsets[4] = {
-				TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, indices.P[0], indices.P[1]) * 2,
-				TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, indices.Q[0], indices.Q[1]) * 2,
-				TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, indices.R[0], indices.R[1]) * 2,
-				TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, indices.S[0], indices.S[1]) * 2,
-			};
-
-			// Access individual elements to fill out PVRTCWord
-			PVRTCWord P, Q, R, S;
-			P.colorData = static_cast<uint32_t>(pWordMembers[WordOffsets[0] + 1]);
-			P.modulationData = static_cast<uint32_t>(pWordMembers[WordOffsets[0]]);
-			Q.colorData = static_cast<uint32_t>(pWordMembers[WordOffsets[1] + 1]);
-			Q.modulationData = static_cast<uint32_t>(pWordMembers[WordOffsets[1]]);
-			R.colorData = static_cast<uint32_t>(pWordMembers[WordOffsets[2] + 1]);
-			R.modulationData = static_cast<uint32_t>(pWordMembers[WordOffsets[2]]);
-			S.colorData = static_cast<uint32_t>(pWordMembers[WordOffsets[3] + 1]);
-			S.modulationData = static_cast<uint32_t>(pWordMembers[WordOffsets[3]]);
-
-			// assemble 4 words into struct to get decompressed pixels from
-			pvrtcGetDecompressedPixels<PVRTCII>(P, Q, R, S, pPixels.data(), bpp);
-			mapDecompressedData(pOutData, width, pPixels.data(), indices, bpp);
-
-		} // for each word
-	} // for each row of words
+			// Apply the modulation.
+			for (uint32_t x = 0; x < width; x++)
+			{
+				const Pixel128S& hA = upscaledColorA[x];
+				const Pixel128S& hB = upscaledColorB[x];
+				const Pixel128S colorA = {
+					(hA.red >> rgbShift1) + (hA.red >> rgbShift2),
+					(hA.green >> rgbShift1) + (hA.green >> rgbShift2),
+					(hA.blue >> rgbShift1) + (hA.blue >> rgbShift2),
+					(hA.alpha >> alphaShift1) + (hA.alpha >> alphaShift2),
+				};
+				const Pixel128S colorB = {
+					(hB.red >> rgbShift1) + (hB.red >> rgbShift2),
+					(hB.green >> rgbShift1) + (hB.green >> rgbShift2),
+					(hB.blue >> rgbShift1) + (hB.blue >> rgbShift2),
+					(hB.alpha >> alphaShift1) + (hB.alpha >> alphaShift2),
+				};
+
+				// Modulation values over 10 indicate punch-through alpha.
+				// NOTE: Branch-free, since the modulation values are effectively random.
+				int32_t mod = pModValues[x];
+				const int32_t punchthroughAlpha = (mod > 10);
+				mod -= punchthroughAlpha * 10;
+
+				Pixel128S result;
+				result.red = (colorA.red * (8 - mod) + colorB.red * mod) / 8;
+				result.green = (colorA.green * (8 - mod) + colorB.green * mod) / 8;
+				result.blue = (colorA.blue * (8 - mod) + colorB.blue * mod) / 8;
+				result.alpha = (colorA.alpha * (8 - mod) + colorB.alpha * mod) / 8;
+				result.alpha &= punchthroughAlpha - 1;
+				if (PVRTCII)
+				{
+					// PVRTC-II: Punch-through alpha sets the RGB values to 0.
+					result.red &= punchthroughAlpha - 1;
+					result.green &= punchthroughAlpha - 1;
+					result.blue &= punchthroughAlpha - 1;
+				}
+
+				// Convert the 32bit precision Result to 8 bit per channel color.
+				pOutput[x].red = static_cast<uint8_t>(result.red);
+				pOutput[x].green = static_cast<uint8_t>(result.green);
+				pOutput[x].blue = static_cast<uint8_t>(result.blue);
+				pOutput[x].alpha = static_cast<uint8_t>(result.alpha);
+			}
+		}
+	}
 
 	// Return the data size
 	return width * height / static_cast<uint32_t>((wordWidth / 2));
@@ -161,3 +161,98 @@ int lzx_decompress(const void* lzx_data, size_t lzx_len, void* dest,
 
   return result_code;
 }
+
+/** Incremental LZX decompressor. **/
+
+struct lzx_stream {
+  struct mspack_system sys;
+  struct lzxd_stream* lzxd;
+  lzx_read_cb read_cb;
+  void* userdata;
+  uint8_t* dest;  // NULL to discard output
+  size_t offset;
+  size_t dest_len;
+};
+
+static int lzx_stream_sys_read(struct mspack_file* file, void* buffer,
+                               int chars) {
+  lzx_stream* stream = (lzx_stream*)file;
+  return stream->read_cb(stream->userdata, buffer, chars);
+}
+static int lzx_stream_sys_write(struct mspack_file* file, void* buffer,
+                                int chars) {
+  lzx_stream* stream = (lzx_stream*)file;
+  if (stream->dest) {
+    memcpy(stream->dest, buffer, (size_t)chars);
+    stream->dest += chars;
+  }
+  return chars;
+}
+static void lzx_stream_sys_message(struct mspack_file* file,
+                                   const char* format, ...) {
+  ((void)file);
+  ((void)format);
+}
+
+lzx_stream* lzx_stream_open(uint32_t window_size, size_t dest_len,
+                            lzx_read_cb read_cb, void* userdata) {
+  uint32_t window_bits;
+  lzx_stream* stream;
+
+  if (!read_cb || dest_len >= INT_MAX ||
+      !bit_scan_forward(window_size, &window_bits)) {
+    return NULL;
+  }
+
+  stream = (lzx_stream*)calloc(1, sizeof(lzx_stream));
+  if (!stream) {
+    return NULL;
+  }
+  stream->sys.read = lzx_stream_sys_read;
+  stream->sys.write = lzx_stream_sys_write;
+  stream->sys.message = lzx_stream_sys_message;
+  stream->sys.alloc = mspack_memory_alloc;
+  stream->sys.free = mspack_memory_free;
+  stream->sys.copy = mspack_memory_copy;
+  stream->read_cb = read_cb;
+  stream->userdata = userdata;
+  stream->dest_len = dest_len;
+
+  // NOTE: The stream is used as both the input and output file.
+  stream->lzxd = lzxd_init(&stream->sys, (struct mspack_file*)stream,
+                           (struct mspack_file*)stream, window_bits, 0,
+                           0x8000, (off_t)dest_len, 0);
+  if (!stream->lzxd) {
+    free(stream);
+    return NULL;
+  }
+  return stream;
+}
+
+int lzx_stream_read(lzx_stream* stream, void* dest, size_t len) {
+  int result_code;
+
+  if (!stream || len > stream->dest_len - stream->offset) {
+    return MSPACK_ERR_ARGS;
+  }
+
+  stream->dest = (uint8_t*)dest;
+  result_code = lzxd_decompress(stream->lzxd, (off_t)len);
+  stream->dest = NULL;
+  if (result_code == MSPACK_ERR_OK) {
+    stream->offset += len;
+  }
+  return result_code;
+}
+
+size_t lzx_stream_tell(const lzx_stream* stream) {
+  return (stream ? stream->offset : 0);
+}
+
+void lzx_stream_close(lzx_stream* stream) {
+  if (!stream) {
+    return;
+  }
+  lzxd_free(stream->lzxd);
+  free(stream);
+}
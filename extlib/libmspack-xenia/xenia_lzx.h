@@ -21,6 +21,56 @@ int lzx_decompress(const void* lzx_data, size_t lzx_len, void* dest,
                    size_t dest_len, uint32_t window_size, void* window_data,
                    size_t window_data_len);
 
+/**
+ * Incremental LZX decompressor.
+ * Decompressed data is produced sequentially, and compressed data
+ * is only read from the input callback as needed, so decompression
+ * can stop as soon as the required range has been produced.
+ */
+typedef struct lzx_stream lzx_stream;
+
+/**
+ * LZX input callback.
+ * @param userdata User data.
+ * @param buf Buffer.
+ * @param bytes Maximum number of bytes to read.
+ * @return Number of bytes read; 0 on EOF; negative on error.
+ */
+typedef int (*lzx_read_cb)(void* userdata, void* buf, int bytes);
+
+/**
+ * Open an incremental LZX decompressor.
+ * @param window_size LZX window size.
+ * @param dest_len Total size of the decompressed data.
+ * @param read_cb Input callback.
+ * @param userdata User data for the input callback.
+ * @return lzx_stream, or NULL on error.
+ */
+lzx_stream* lzx_stream_open(uint32_t window_size, size_t dest_len,
+                            lzx_read_cb read_cb, void* userdata);
+
+/**
+ * Decompress the next len bytes.
+ * @param stream lzx_stream
+ * @param dest Destination buffer, or NULL to discard the data.
+ * @param len Number of bytes to decompress.
+ * @return MSPACK_ERR_OK on success; MSPACK_ERR_* on error.
+ */
+int lzx_stream_read(lzx_stream* stream, void* dest, size_t len);
+
+/**
+ * Get the current position in the decompressed data.
+ * @param stream lzx_stream
+ * @return Current position.
+ */
+size_t lzx_stream_tell(const lzx_stream* stream);
+
+/**
+ * Close an incremental LZX decompressor.
+ * @param stream lzx_stream
+ */
+void lzx_stream_close(lzx_stream* stream);
+
 #ifdef __cplusplus
 }
 #endif
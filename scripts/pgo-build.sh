@@ -0,0 +1,53 @@
+#!/bin/sh
+# Profile-guided optimization build script. (gcc/clang only)
+#
+# Builds instrumented binaries, runs the training corpus through
+# rp-bench and rpcli, then rebuilds using the collected profile data.
+#
+# Parameters:
+# - $1: Training corpus directory.
+# - $2: Build directory.
+# - Additional parameters are passed to CMake.
+#
+# The same build directory is used for both builds, since gcc
+# locates the profile data using the object file paths.
+#
+
+if [ "$#" -lt "2" ]; then
+	echo "Syntax: $0 corpus_dir build_dir [cmake options...]"
+	echo "Run this script from the top-level source directory."
+	exit 1
+fi
+
+CORPUS="$(cd "$1" && pwd)" || exit 1
+BUILD_DIR="$2"
+shift 2
+
+if [ ! -f CMakeLists.txt -o ! -f scripts/pgo-build.sh ]; then
+	echo "*** ERROR: Run this script from the top-level source directory." >&2
+	exit 1
+fi
+mkdir -p "${BUILD_DIR}" || exit 1
+BUILD_DIR="$(cd "${BUILD_DIR}" && pwd)" || exit 1
+PROFILE_DIR="${BUILD_DIR}/pgo-profile"
+
+# Step 1: Instrumented build.
+# BUILD_TESTING is required for rp-bench.
+SRC_DIR="$(pwd)"
+(cd "${BUILD_DIR}" && cmake "${SRC_DIR}" -DCMAKE_BUILD_TYPE=Release \
+	-DBUILD_TESTING=ON \
+	-DENABLE_PGO=GENERATE \
+	-DPGO_PROFILE_DIR="${PROFILE_DIR}" \
+	-DPGO_TRAINING_CORPUS="${CORPUS}" \
+	"$@") || exit 1
+cmake --build "${BUILD_DIR}" || exit 1
+
+# Step 2: Training run.
+cmake --build "${BUILD_DIR}" --target pgo-train || exit 1
+
+# Step 3: Optimized build.
+(cd "${BUILD_DIR}" && cmake "${SRC_DIR}" -DENABLE_PGO=USE) || exit 1
+cmake --build "${BUILD_DIR}" || exit 1
+
+echo "*** PGO build complete: ${BUILD_DIR}"
+exit 0
@@ -0,0 +1,61 @@
+#!/bin/sh
+# Profile-guided optimization training script.
+# Called by the `pgo-train` target in ENABLE_PGO=GENERATE builds.
+#
+# Parameters:
+# - $1: Training corpus directory.
+# - $2: Profile data directory.
+# - $3: rp-bench executable.
+# - $4: rpcli executable. (optional)
+# - $5: llvm-profdata executable. (clang only)
+#
+# The corpus should contain at least one file for each RomData
+# subclass and texture format that should be optimized.
+# Anything that isn't in the corpus is optimized normally.
+#
+
+if [ "$#" != "5" ]; then
+	echo "Syntax: $0 corpus_dir profile_dir rp-bench rpcli llvm-profdata"
+	exit 1
+fi
+
+CORPUS="$1"
+PROFILE_DIR="$2"
+RP_BENCH="$3"
+RPCLI="$4"
+LLVM_PROFDATA="$5"
+
+if [ -z "${CORPUS}" -o ! -d "${CORPUS}" ]; then
+	echo "*** ERROR: Training corpus '${CORPUS}' is not a directory." >&2
+	echo "Set PGO_TRAINING_CORPUS to the training corpus directory." >&2
+	exit 1
+fi
+
+# Remove profile data from previous training runs.
+# NOTE: gcc merges the counters into existing .gcda files.
+mkdir -p "${PROFILE_DIR}" || exit 1
+find "${PROFILE_DIR}" -type f \( -name '*.gcda' -o -name '*.profraw' -o -name '*.profdata' \) -delete
+
+# rp-bench: RomDataFactory::create(), fields, image decoding,
+# thumbnail scaling, and PNG compression.
+echo "*** Training: rp-bench ${CORPUS}"
+"${RP_BENCH}" "${CORPUS}" > /dev/null
+if [ "$?" != "0" ]; then
+	echo "*** ERROR: rp-bench failed." >&2
+	exit 1
+fi
+
+# rpcli batch mode: JSON output and the batch read path.
+if [ -n "${RPCLI}" ]; then
+	echo "*** Training: rpcli -j -b"
+	find "${CORPUS}" -type f | "${RPCLI}" -j -b - > /dev/null 2>&1
+fi
+
+# clang writes raw profiles that must be merged.
+if [ -n "${LLVM_PROFDATA}" ]; then
+	echo "*** Merging profile data: ${PROFILE_DIR}/rom-properties.profdata"
+	"${LLVM_PROFDATA}" merge -output="${PROFILE_DIR}/rom-properties.profdata" "${PROFILE_DIR}"/*.profraw || exit 1
+fi
+
+echo "*** Training complete. Reconfigure with -DENABLE_PGO=USE and rebuild."
+exit 0
@@ -8,6 +8,7 @@
 
 #include "stdafx.h"
 #include "CairoImageConv.hpp"
+#include "RpCairoBackend.hpp"
 
 // C++ STL classes.
 using std::array;
@@ -27,6 +28,46 @@ cairo_surface_t *CairoImageConv::rp_image_to_cairo_surface_t(const rp_image *img
 	if (unlikely(!img || !img->isValid()))
 		return nullptr;
 
+	if (premultiply && img->isOpaque()) {
+		// Premultiplying an opaque image doesn't change it.
+		premultiply = false;
+	}
+
+	if (img->format() == rp_image::Format::ARGB32) {
+		// If the image is using RpCairoBackend, its
+		// image data is already in a cairo_surface_t.
+		const RpCairoBackend *backend =
+			dynamic_cast<const RpCairoBackend*>(img->backend());
+		if (backend) {
+			if (!premultiply) {
+				// Use the surface directly.
+				return backend->getCairoSurface();
+			}
+
+			// Premultiply a copy of the image in place.
+			// The duplicated image also uses RpCairoBackend,
+			// so its surface can be returned without copying
+			// the image data again.
+			rp_image *const img_prex = img->dup();
+			if (unlikely(!img_prex || !img_prex->isValid())) {
+				UNREF(img_prex);
+				return nullptr;
+			}
+			img_prex->premultiply();
+			const RpCairoBackend *const prex_backend =
+				dynamic_cast<const RpCairoBackend*>(img_prex->backend());
+			cairo_surface_t *const surface = (prex_backend
+				? prex_backend->getCairoSurface()
+				: nullptr);
+			img_prex->unref();
+			if (surface) {
+				return surface;
+			}
+			// Fall through to the regular conversion if the
+			// duplicated image isn't using RpCairoBackend.
+		}
+	}
+
 	// NOTE: cairo_image_surface_create_for_data() doesn't do a
 	// deep copy, so we can't use it.
 	// NOTE 2: cairo_image_surface_create() always returns a valid
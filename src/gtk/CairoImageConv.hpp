@@ -9,8 +9,9 @@
 #ifndef __ROMPROPERTIES_GTK_CAIROIMAGECONV_HPP__
 #define __ROMPROPERTIES_GTK_CAIROIMAGECONV_HPP__
 
-// NOTE: Cairo doesn't natively support 8bpp. Because of this,
-// we can't simply make a cairo_surface_t rp_image backend.
+// NOTE: Cairo doesn't natively support 8bpp, so RpCairoBackend
+// only uses a cairo_surface_t for ARGB32 images. CI8 images
+// still have to be converted here.
 
 #include "common.h"
 #include "librpcpu/cpu_dispatch.h"
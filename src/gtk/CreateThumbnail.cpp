@@ -9,17 +9,44 @@
 #include "stdafx.h"
 
 // librpbase, librptexture
+#include "librpbase/img/SharedImageCache.hpp"
 using namespace LibRpBase;
 using LibRpTexture::rp_image;
 
 // libromdata
+#include "libromdata/DetectCache.hpp"
 #include "libromdata/RomDataFactory.hpp"
+using LibRomData::DetectCache;
 using LibRomData::RomDataFactory;
+#include "libromdata/img/RecentRomData.hpp"
+using LibRomData::RecentRomData;
+
+// librpfile
+#include "librpfile/RpStats.hpp"
+using namespace LibRpFile;
+
+// librptexture
+#include "librptexture/decoder/ImageDecoder.hpp"
+
+// librpthreads
+#include "librpthreads/Atomics.h"
+#include "librpthreads/CancelToken.hpp"
+#include "librpthreads/Semaphore.hpp"
+using LibRpThreads::CancelToken;
+using LibRpThreads::Semaphore;
+
+#ifdef RP_GTK_USE_CAIRO
+#  include "RpCairoBackend.hpp"
+#endif /* RP_GTK_USE_CAIRO */
 
 // TCreateThumbnail is a templated class,
 // so we have to #include the .cpp file here.
 #include "libromdata/img/TCreateThumbnail.cpp"
 using LibRomData::TCreateThumbnail;
+using LibRomData::CacheManager;
+
+// C includes.
+#include <pthread.h>
 
 // C++ STL classes.
 using std::string;
@@ -64,6 +91,15 @@ class CreateThumbnailPrivate : public TCreateThumbnail<PIMGTYPE>
 			return rp_image_to_PIMGTYPE(img, false);
 		}
 
+		/**
+		 * Does rpImageToImgClass() keep the original image size?
+		 * @return True if rpImageToImgClass() keeps the original image size.
+		 */
+		inline bool rpImageToImgClassKeepsSize(void) const final
+		{
+			return true;
+		}
+
 		/**
 		 * Wrapper function to check if an ImgClass is valid.
 		 * @param imgClass ImgClass
@@ -117,6 +153,14 @@ class CreateThumbnailPrivate : public TCreateThumbnail<PIMGTYPE>
 		 * @return Proxy, or empty string if no proxy is needed.
 		 */
 		string proxyForUrl(const string &url) const final;
+
+	public:
+		/**
+		 * Downscale the thumbnail if it's larger than the maximum size.
+		 * @param outParams	[in,out] getThumbnail() output parameters.
+		 * @param maximum_size	[in] Maximum size.
+		 */
+		void downscaleThumbnail(GetThumbnailOutParams_t &outParams, int maximum_size) const;
 };
 
 CreateThumbnailPrivate::CreateThumbnailPrivate()
@@ -141,6 +185,44 @@ int CreateThumbnailPrivate::getImgClassSize(const PIMGTYPE &imgClass, ImgSize *p
 	return 0;
 }
 
+/**
+ * Downscale the thumbnail if it's larger than the maximum size.
+ * @param outParams	[in,out] getThumbnail() output parameters.
+ * @param maximum_size	[in] Maximum size.
+ */
+void CreateThumbnailPrivate::downscaleThumbnail(GetThumbnailOutParams_t &outParams, int maximum_size) const
+{
+	if (outParams.thumbSize.width <= maximum_size &&
+	    outParams.thumbSize.height <= maximum_size)
+	{
+		// Thumbnail is small enough.
+		return;
+	}
+
+	ImgSize sz = outParams.thumbSize;
+	const ImgSize max_sz = {maximum_size, maximum_size};
+	rescale_aspect(sz, max_sz);
+	// Very narrow images may end up with a dimension of 0.
+	if (sz.width <= 0) {
+		sz.width = 1;
+	}
+	if (sz.height <= 0) {
+		sz.height = 1;
+	}
+
+	// If the thumbnail was degraded to meet the time budget,
+	// use the faster scaling method, since it will be regenerated.
+	PIMGTYPE scaled_img = rescaleImgClass(outParams.retImg, sz,
+		(outParams.degraded ? ScalingMethod::Nearest : ScalingMethod::Bilinear));
+	if (!scaled_img) {
+		// Unable to rescale the image. Use the original size.
+		return;
+	}
+	freeImgClass(outParams.retImg);
+	outParams.retImg = scaled_img;
+	outParams.thumbSize = sz;
+}
+
 /**
  * Get the proxy for the specified URL.
  * @return Proxy, or empty string if no proxy is needed.
@@ -228,7 +310,7 @@ static int openFromFilenameOrURI(const char *source_file, IRpFile **pp_file, str
 			}
 
 			// Open the file using RpFileGio.
-			file = new RpFileGio(source_file);
+			file = RpFileGio::openCached(source_file);
 		}
 	} else {
 		// This is a filename.
@@ -285,15 +367,111 @@ static int openFromFilenameOrURI(const char *source_file, IRpFile **pp_file, str
 }
 
 /**
- * Thumbnail creator function for wrapper programs.
- * @param source_file Source file or URI. (UTF-8)
- * @param output_file Output file. (UTF-8)
- * @param maximum_size Maximum size.
+ * Asynchronous thumbnail job.
+ * Used if an external image is downloaded in the background,
+ * or if the thumbnail is regenerated at full quality.
+ */
+struct AsyncThumbnailJob {
+	string source_file;
+	string output_file;
+	int maximum_size;
+	PFN_RP_THUMBNAIL_READY pfnReady;
+	void *userdata;
+
+	// Released once the initial thumbnail has been written,
+	// so the regenerated thumbnail doesn't overwrite it
+	// while it's still being written.
+	Semaphore sem_initial;
+	int refcnt;
+
+	AsyncThumbnailJob(const char *source_file, const char *output_file, int maximum_size,
+			  PFN_RP_THUMBNAIL_READY pfnReady, void *userdata)
+		: source_file(source_file)
+		, output_file(output_file)
+		, maximum_size(maximum_size)
+		, pfnReady(pfnReady)
+		, userdata(userdata)
+		, sem_initial(0)
+		, refcnt(2)	// initial thumbnail + download thread
+	{ }
+
+	/**
+	 * Unreference the job.
+	 * The job is deleted once it's no longer referenced.
+	 */
+	void unref(void)
+	{
+		if (ATOMIC_DEC_FETCH(&refcnt) <= 0) {
+			delete this;
+		}
+	}
+};
+
+static int create_thumbnail_int(const char *source_file, const char *output_file, int maximum_size,
+	AsyncThumbnailJob *job, bool *pExtImgQueued);
+
+// Cancellation flag for thumbnails created on this thread.
+// Set by rp_set_cancel_flag().
+static thread_local volatile int *tls_cancelFlag = nullptr;
+
+/**
+ * Finish an asynchronous thumbnail job.
+ * This is called from a background thread.
+ * @param job AsyncThumbnailJob
+ * @param regenerate If true, regenerate the thumbnail without a time budget.
+ */
+static void asyncFinishJob(AsyncThumbnailJob *job, bool regenerate)
+{
+	job->sem_initial.obtain();
+
+	int ret = RPCT_SOURCE_FILE_NO_IMAGE;
+	if (regenerate) {
+		ret = create_thumbnail_int(job->source_file.c_str(), job->output_file.c_str(),
+			job->maximum_size, nullptr, nullptr);
+	}
+	job->pfnReady(job->source_file.c_str(), job->output_file.c_str(), ret, job->userdata);
+	job->unref();
+}
+
+/**
+ * An external image download has finished.
+ * This is called from the download thread.
+ * @param cache_filename Cached filename, or empty string if the download failed.
+ * @param userdata AsyncThumbnailJob
+ */
+static void asyncExtImgReady(const string &cache_filename, void *userdata)
+{
+	// Regenerate the thumbnail using the downloaded image.
+	asyncFinishJob(static_cast<AsyncThumbnailJob*>(userdata), !cache_filename.empty());
+}
+
+/**
+ * Regenerate a degraded thumbnail at full quality.
+ * @param userdata AsyncThumbnailJob
+ * @return nullptr
+ */
+static void *asyncRefreshThread(void *userdata)
+{
+	asyncFinishJob(static_cast<AsyncThumbnailJob*>(userdata), true);
+	return nullptr;
+}
+
+/**
+ * Thumbnail creator function.
+ * @param source_file	[in] Source file or URI. (UTF-8)
+ * @param output_file	[in] Output file. (UTF-8)
+ * @param maximum_size	[in] Maximum size.
+ * @param job		[in,opt] Asynchronous thumbnail job, or nullptr to download external images synchronously.
+ * @param pExtImgQueued	[out,opt] Set to true if an external image download or a full-quality refresh was queued.
  * @return 0 on success; non-zero on error.
  */
-extern "C"
-G_MODULE_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const char *output_file, int maximum_size)
+static int create_thumbnail_int(const char *source_file, const char *output_file, int maximum_size,
+	AsyncThumbnailJob *job, bool *pExtImgQueued)
 {
+	if (pExtImgQueued) {
+		*pExtImgQueued = false;
+	}
+
 	// Some of this is based on the GNOME Thumbnailer skeleton project.
 	// https://github.com/hadess/gnome-thumbnailer-skeleton/blob/master/gnome-thumbnailer-skeleton.c
 
@@ -308,6 +486,18 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const
 	g_type_init();
 #endif
 
+#ifdef RP_GTK_USE_CAIRO
+	// Register RpCairoBackend.
+	// TODO: Static initializer somewhere?
+	rp_image::setBackendCreatorFn(RpCairoBackend::creator_fn);
+#endif /* RP_GTK_USE_CAIRO */
+
+	// Share decoded images with other processes.
+	SharedImageCache::setEnabled(true);
+
+	// Remember which RomData subclass was detected for each file.
+	DetectCache::setEnabled(true);
+
 	// NOTE: TCreateThumbnail() has wrappers for opening the
 	// ROM file and getting RomData*, but we're doing it here
 	// in order to return better error codes.
@@ -322,29 +512,63 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const
 	}
 	assert(file != nullptr);
 
+	// Cancellation token, if rp_set_cancel_flag() was called.
+	unique_ptr<CancelToken> cancelToken;
+	if (tls_cancelFlag) {
+		cancelToken.reset(new CancelToken(tls_cancelFlag));
+	}
+	CancelToken::Scope cancelScope(cancelToken.get());
+
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
-	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
+	// NOTE: The RomData object is shared with other requests for
+	// the same file, e.g. for other thumbnail sizes.
+	const RecentRomData recentRomData(file);
 	file->unref();	// file is ref()'d by RomData.
+	RomData *const romData = recentRomData.romData();
 	if (!romData) {
-		// ROM is not supported.
-		return RPCT_SOURCE_FILE_NOT_SUPPORTED;
+		// ROM is not supported, or the request was cancelled.
+		return (CancelToken::isCurrentCancelled() ? RPCT_CANCELLED : RPCT_SOURCE_FILE_NOT_SUPPORTED);
 	}
 
 	// Create the thumbnail.
-	// TODO: If image is larger than maximum_size, resize down.
 	unique_ptr<CreateThumbnailPrivate> d(new CreateThumbnailPrivate());
+	if (job) {
+		// Asynchronous thumbnails are usually requested while
+		// the user is browsing, so use the interactive time budget.
+		// Degraded thumbnails are regenerated in the background.
+		d->setAsyncExtImgCallback(asyncExtImgReady, job);
+		d->setTimeBudget(CreateThumbnailPrivate::DEFAULT_INTERACTIVE_TIME_BUDGET_MS);
+	}
 	CreateThumbnailPrivate::GetThumbnailOutParams_t outParams;
 	ret = d->getThumbnail(romData, maximum_size, &outParams);
+	if (job && ret == 0 && outParams.degraded && !outParams.extImgQueued) {
+		// Regenerate the thumbnail at full quality in the background.
+		// NOTE: If an external image download was queued, the
+		// thumbnail will be regenerated once it has finished.
+		pthread_t thread;
+		if (pthread_create(&thread, nullptr, asyncRefreshThread, job) == 0) {
+			pthread_detach(thread);
+			outParams.extImgQueued = true;
+		}
+	}
+	if (pExtImgQueued) {
+		*pExtImgQueued = outParams.extImgQueued;
+	}
 	if (ret != 0 || !d->isImgClassValid(outParams.retImg)) {
 		// No image.
 		if (outParams.retImg) {
 			d->freeImgClass(outParams.retImg);
 		}
-		romData->unref();
-		return RPCT_SOURCE_FILE_NO_IMAGE;
+		return (ret == RPCT_CANCELLED ? RPCT_CANCELLED : RPCT_SOURCE_FILE_NO_IMAGE);
 	}
 
+	// If the image is larger than maximum_size, resize down.
+	// High-resolution scans may be several megapixels, which
+	// would take a long time to compress and waste disk space
+	// in the thumbnail cache.
+	d->downscaleThumbnail(outParams, maximum_size);
+
 	// Save the image using RpPngWriter.
 	unique_ptr<const uint8_t*[]> row_pointers;
 	guchar *pixels;
@@ -357,6 +581,7 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const
 	char szFile_str[32];
 	GFile *f_src = nullptr;
 	const char *mimeType;
+	RpPngWriter::CompressionParams pngParams;
 
 	// gdk-pixbuf doesn't support CI8, so we'll assume all
 	// images are ARGB32. (Well, ABGR32, but close enough.)
@@ -450,6 +675,11 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const
 
 	/** IHDR **/
 
+	// Thumbnails can be regenerated if they're removed from
+	// the thumbnail cache, so use the fastest compression level.
+	pngParams.level = 1;	// Z_BEST_SPEED
+	pngWriter->setCompressionParams(pngParams);
+
 	// If sBIT wasn't found, all fields will be 0.
 	// RpPngWriter will ignore sBIT in this case.
 	pwRet = pngWriter->write_IHDR(&outParams.sBIT);
@@ -493,6 +723,125 @@ G_MODULE_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const
 
 cleanup:
 	d->freeImgClass(outParams.retImg);
-	romData->unref();
 	return ret;
 }
+
+/**
+ * Thumbnail creator function for wrapper programs.
+ * @param source_file Source file or URI. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param maximum_size Maximum size.
+ * @return 0 on success; non-zero on error.
+ */
+extern "C"
+G_MODULE_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const char *output_file, int maximum_size)
+{
+	return create_thumbnail_int(source_file, output_file, maximum_size, nullptr, nullptr);
+}
+
+/**
+ * Thumbnail creator function for wrapper programs.
+ *
+ * External images that aren't cached yet are downloaded
+ * in the background. The thumbnail is created using the
+ * next available image type, and it's regenerated once
+ * the download has finished.
+ *
+ * The initial thumbnail is created using the interactive time
+ * budget. If a lower-quality thumbnail was created to meet it,
+ * it's regenerated at full quality in the background.
+ *
+ * @param source_file Source file or URI. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param maximum_size Maximum size.
+ * @param pfnReady Callback for the regenerated thumbnail. (always called exactly once)
+ * @param userdata User data for the callback.
+ * @return 0 on success; non-zero on error.
+ */
+extern "C"
+G_MODULE_EXPORT int RP_C_API rp_create_thumbnail_async(const char *source_file, const char *output_file, int maximum_size,
+	PFN_RP_THUMBNAIL_READY pfnReady, void *userdata)
+{
+	assert(pfnReady != nullptr);
+	if (!pfnReady) {
+		return rp_create_thumbnail(source_file, output_file, maximum_size);
+	}
+
+	AsyncThumbnailJob *const job = new AsyncThumbnailJob(
+		source_file, output_file, maximum_size, pfnReady, userdata);
+	bool extImgQueued = false;
+	int ret = create_thumbnail_int(source_file, output_file, maximum_size, job, &extImgQueued);
+	if (!extImgQueued) {
+		// No download was queued.
+		delete job;
+		pfnReady(source_file, output_file, RPCT_SOURCE_FILE_NO_IMAGE, userdata);
+		return ret;
+	}
+
+	// Let the download thread regenerate the thumbnail.
+	job->sem_initial.release();
+	job->unref();
+	return ret;
+}
+
+/**
+ * Get the runtime statistics counters.
+ * Used by wrapper programs to expose I/O, cache, and
+ * decryption statistics for the plugin's process.
+ * @param pfnCallback Callback, called once per counter.
+ * @param userdata User data for the callback.
+ */
+extern "C"
+G_MODULE_EXPORT void RP_C_API rp_get_stats(PFN_RP_STATS_CALLBACK pfnCallback, void *userdata)
+{
+	assert(pfnCallback != nullptr);
+	if (!pfnCallback)
+		return;
+
+	for (int i = 0; i < RpStats::COUNTER_MAX; i++) {
+		const RpStats::Counter counter = static_cast<RpStats::Counter>(i);
+		pfnCallback(RpStats::name(counter), static_cast<uint64_t>(RpStats::get(counter)), userdata);
+	}
+}
+
+/**
+ * Set the number of threads used to decode large images.
+ * Used by wrapper programs that create multiple thumbnails
+ * concurrently, so image decoding doesn't oversubscribe the CPU.
+ * @param count Number of threads. (0 for the number of CPUs; 1 to disable)
+ */
+extern "C"
+G_MODULE_EXPORT void RP_C_API rp_set_decode_threads(unsigned int count)
+{
+	LibRpTexture::ImageDecoder::setDecodeThreadCount(count);
+}
+
+/**
+ * Set the cancellation flag for thumbnails created on the calling thread.
+ * If the flag is set to non-zero while rp_create_thumbnail() or
+ * rp_create_thumbnail_async() is running, thumbnailing stops early
+ * and RPCT_CANCELLED is returned.
+ * @param cancel_flag Cancellation flag, or NULL to clear it. (must remain valid until cleared)
+ */
+extern "C"
+G_MODULE_EXPORT void RP_C_API rp_set_cancel_flag(volatile int *cancel_flag)
+{
+	tls_cancelFlag = cancel_flag;
+}
+
+/**
+ * Start the rp-download daemon, and only use the daemon for downloads.
+ * Used by wrapper programs that enable security options that don't
+ * allow running other programs, e.g. sandboxed worker processes.
+ * The daemon keeps running until the calling process exits.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+extern "C"
+G_MODULE_EXPORT int RP_C_API rp_start_download_daemon(void)
+{
+	// NOTE: The socket is left open so the daemon doesn't exit.
+	CacheManager cache;
+	const int fd = cache.startRpDownloadDaemon();
+	CacheManager::setDaemonOnly(true);
+	return (fd >= 0 ? 0 : fd);
+}
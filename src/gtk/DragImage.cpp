@@ -54,6 +54,11 @@ struct _DragImage {
 	// rp_image. [ref()'d]
 	const rp_image *img;
 
+	// Cached PNG data. [ref()'d]
+	// Encoded the first time the drop target requests it,
+	// and cleared when the image is changed.
+	RpVectorFile *pngData;
+
 	// Animated icon data.
 	struct anim_vars {
 		const IconAnimData *iconAnimData;
@@ -111,6 +116,7 @@ drag_image_init(DragImage *image)
 	image->minimumImageSize.width = DIL_MIN_IMAGE_SIZE;
 	image->minimumImageSize.height = DIL_MIN_IMAGE_SIZE;
 	image->img = nullptr;
+	image->pngData = nullptr;
 	image->anim = nullptr;
 
 	// Create the child GtkImage widget.
@@ -140,8 +146,9 @@ drag_image_dispose(GObject *object)
 	delete image->anim;
 	image->anim = nullptr;
 
-	// Unreference the image.
+	// Unreference the image and PNG data.
 	UNREF_AND_NULL(image->img);
+	UNREF_AND_NULL(image->pngData);
 
 	// Call the superclass dispose() function.
 	G_OBJECT_CLASS(drag_image_parent_class)->dispose(object);
@@ -186,7 +193,12 @@ drag_image_update_pixmaps(DragImage *image)
 	if (anim && anim->iconAnimData) {
 		const IconAnimData *const iconAnimData = anim->iconAnimData;
 
+		// Set up the IconAnimHelper.
+		anim->iconAnimHelper.setIconAnimData(iconAnimData);
+
 		// Convert the frames to PIMGTYPE.
+		// Duplicate frames are skipped, since the IconAnimHelper
+		// only returns base frames.
 		for (int i = iconAnimData->count-1; i >= 0; i--) {
 			// Remove the existing frame first.
 			if (anim->iconFrames[i]) {
@@ -195,14 +207,12 @@ drag_image_update_pixmaps(DragImage *image)
 			}
 
 			const rp_image *const frame = iconAnimData->frames[i];
-			if (frame && frame->isValid()) {
+			if (frame && frame->isValid() && anim->iconAnimHelper.baseFrame(i) == i) {
 				// NOTE: Allowing NULL frames here...
 				anim->iconFrames[i] = rp_image_to_PIMGTYPE(frame);
 			}
 		}
 
-		// Set up the IconAnimHelper.
-		anim->iconAnimHelper.setIconAnimData(iconAnimData);
 		if (anim->iconAnimHelper.isAnimated()) {
 			// Initialize the animation.
 			anim->last_frame_number = anim->iconAnimHelper.frameNumber();
@@ -286,6 +296,7 @@ drag_image_set_rp_image(DragImage *image, const LibRpTexture::rp_image *img)
 	// previously stored image, since the underlying image may
 	// have changed.
 	UNREF_AND_NULL(image->img);
+	UNREF_AND_NULL(image->pngData);
 
 	if (!img) {
 		if (!image->anim || !image->anim->iconAnimData) {
@@ -328,6 +339,7 @@ drag_image_set_icon_anim_data(DragImage *image, const LibRpBase::IconAnimData *i
 	// previously stored image, since the underlying image may
 	// have changed.
 	UNREF_AND_NULL(anim->iconAnimData);
+	UNREF_AND_NULL(image->pngData);
 
 	if (!iconAnimData) {
 		if (anim->tmrIconAnim > 0) {
@@ -367,6 +379,7 @@ drag_image_clear(DragImage *image)
 	}
 
 	UNREF_AND_NULL(image->img);
+	UNREF_AND_NULL(image->pngData);
 	gtk_image_clear(image->imageWidget);
 }
 
@@ -519,6 +532,14 @@ drag_image_drag_data_get(DragImage *image, GdkDragContext *context, GtkSelection
 	RP_UNUSED(user_data);
 	g_return_if_fail(IS_DRAG_IMAGE(image));
 
+	if (image->pngData) {
+		// Use the PNG data from a previous request.
+		const vector<uint8_t> &pngVec = image->pngData->vector();
+		gtk_selection_data_set(data, gdk_atom_intern_static_string("image/png"), 8,
+			pngVec.data(), static_cast<gint>(pngVec.size()));
+		return;
+	}
+
 	auto *const anim = image->anim;
 	const bool isAnimated = (anim && anim->iconAnimData && anim->iconAnimHelper.isAnimated());
 
@@ -571,6 +592,6 @@ drag_image_drag_data_get(DragImage *image, GdkDragContext *context, GtkSelection
 	gtk_selection_data_set(data, gdk_atom_intern_static_string("image/png"), 8,
 		pngVec.data(), static_cast<gint>(pngVec.size()));
 
-	// We're done here.
-	pngData->unref();
+	// Save the PNG data for later requests.
+	image->pngData = pngData;
 }
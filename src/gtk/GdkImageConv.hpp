@@ -23,6 +23,9 @@ namespace LibRpTexture {
 # include "librpcpu/cpuflags_x86.h"
 # define GDKIMAGECONV_HAS_SSSE3 1
 #endif
+#ifdef RP_CPU_ALWAYS_HAS_NEON
+# define GDKIMAGECONV_HAS_NEON 1
+#endif
 
 class GdkImageConv
 {
@@ -51,6 +54,16 @@ class GdkImageConv
 		static GdkPixbuf *rp_image_to_GdkPixbuf_ssse3(const LibRpTexture::rp_image *img);
 #endif /* GDKIMAGECONV_HAS_SSSE3 */
 
+#ifdef GDKIMAGECONV_HAS_NEON
+		/**
+		 * Convert an rp_image to GdkPixbuf.
+		 * NEON-optimized version.
+		 * @param img	[in] rp_image.
+		 * @return GdkPixbuf, or nullptr on error.
+		 */
+		static GdkPixbuf *rp_image_to_GdkPixbuf_neon(const LibRpTexture::rp_image *img);
+#endif /* GDKIMAGECONV_HAS_NEON */
+
 		/**
 		 * Convert an rp_image to GdkPixbuf.
 		 * @param img	[in] rp_image.
@@ -71,14 +84,19 @@ class GdkImageConv
  */
 inline GdkPixbuf *GdkImageConv::rp_image_to_GdkPixbuf(const LibRpTexture::rp_image *img)
 {
-#ifdef GDKIMAGECONV_HAS_SSSE3
+#if defined(GDKIMAGECONV_HAS_NEON)
+	// ARM64 always has NEON.
+	return rp_image_to_GdkPixbuf_neon(img);
+#else /* !GDKIMAGECONV_HAS_NEON */
+# ifdef GDKIMAGECONV_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return rp_image_to_GdkPixbuf_ssse3(img);
 	} else
-#endif /* GDKIMAGECONV_HAS_SSSE3 */
+# endif /* GDKIMAGECONV_HAS_SSSE3 */
 	{
 		return rp_image_to_GdkPixbuf_cpp(img);
 	}
+#endif /* GDKIMAGECONV_HAS_NEON */
 }
 
 #endif /* !defined(RP_HAS_IFUNC) || (!defined(RP_CPU_I386) && !defined(RP_CPU_AMD64)) */
@@ -0,0 +1,197 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (GTK+ common)                      *
+ * GdkImageConv.cpp: Helper functions to convert from rp_image to GDK.     *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "GdkImageConv.hpp"
+
+// librptexture
+using LibRpTexture::rp_image;
+
+// NEON headers.
+#include <arm_neon.h>
+
+/**
+ * GdkPixbufDestroyNotify() callback.
+ * @param pixels Pixel data.
+ * @param data Other data. (unused)
+ */
+static void rp_gdkPixbufDestroyNotify(guchar *pixels, gpointer data)
+{
+	RP_UNUSED(data);
+	aligned_free(pixels);
+}
+
+/**
+ * Convert an rp_image to GdkPixbuf.
+ * NEON-optimized version.
+ * @param img	[in] rp_image.
+ * @return GdkPixbuf, or nullptr on error.
+ */
+GdkPixbuf *GdkImageConv::rp_image_to_GdkPixbuf_neon(const rp_image *img)
+{
+	assert(img != nullptr);
+	if (unlikely(!img || !img->isValid()))
+		return nullptr;
+
+	// We need to allocate our own image buffer, since GdkPixbuf
+	// only guarantees 4-byte alignment.
+	const int width = img->width();
+	const int height = img->height();
+	const int rowstride = ALIGN_BYTES(16, width * sizeof(uint32_t));
+	uint32_t *px_dest = static_cast<uint32_t*>(aligned_malloc(16, height * rowstride));
+	assert(px_dest != nullptr);
+	if (unlikely(!px_dest)) {
+		// Unable to allocate memory.
+		return nullptr;
+	}
+
+	GdkPixbuf *pixbuf = gdk_pixbuf_new_from_data(
+		reinterpret_cast<const guchar*>(px_dest),
+		GDK_COLORSPACE_RGB, true, 8, width, height,
+		rowstride, rp_gdkPixbufDestroyNotify, nullptr);
+	assert(pixbuf != nullptr);
+	if (unlikely(!pixbuf)) {
+		// Unable to create a GdkPixbuf.
+		aligned_free(px_dest);
+		return nullptr;
+	}
+
+	// Sanity check: Make sure rowstride is correct.
+	assert(gdk_pixbuf_get_rowstride(pixbuf) == rowstride);
+	const int dest_stride_adj = (rowstride / sizeof(*px_dest)) - img->width();
+
+	// ABGR shuffle mask.
+	static const uint8_t shuf_ABGR[16] = {2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15};
+	const uint8x16_t shuf_mask = vld1q_u8(shuf_ABGR);
+
+	switch (img->format()) {
+		case rp_image::Format::ARGB32: {
+			// Copy the image data.
+			const uint32_t *img_buf = static_cast<const uint32_t*>(img->bits());
+			const int src_stride_adj = (img->stride() / sizeof(uint32_t)) - width;
+			for (unsigned int y = (unsigned int)height; y > 0; y--) {
+				// Process 16 pixels per iteration using NEON.
+				unsigned int x = (unsigned int)width;
+				for (; x > 15; x -= 16, px_dest += 16, img_buf += 16) {
+					const uint8_t *const src8 = reinterpret_cast<const uint8_t*>(img_buf);
+					uint8_t *const dest8 = reinterpret_cast<uint8_t*>(px_dest);
+
+					const uint8x16_t sa = vld1q_u8(&src8[0]);
+					const uint8x16_t sb = vld1q_u8(&src8[16]);
+					const uint8x16_t sc = vld1q_u8(&src8[32]);
+					const uint8x16_t sd = vld1q_u8(&src8[48]);
+
+					vst1q_u8(&dest8[0],  vqtbl1q_u8(sa, shuf_mask));
+					vst1q_u8(&dest8[16], vqtbl1q_u8(sb, shuf_mask));
+					vst1q_u8(&dest8[32], vqtbl1q_u8(sc, shuf_mask));
+					vst1q_u8(&dest8[48], vqtbl1q_u8(sd, shuf_mask));
+				}
+
+				// Remaining pixels.
+				for (; x > 0; x--) {
+					// Last pixel.
+					*px_dest = (*img_buf & 0xFF00FF00) |
+						  ((*img_buf & 0x00FF0000) >> 16) |
+						  ((*img_buf & 0x000000FF) << 16);
+					img_buf++;
+					px_dest++;
+				}
+
+				// Next line.
+				img_buf += src_stride_adj;
+				px_dest += dest_stride_adj;
+			}
+			break;
+		}
+
+		case rp_image::Format::CI8: {
+			const uint32_t *src_pal = img->palette();
+			const int src_pal_len = img->palette_len();
+			assert(src_pal != nullptr);
+			assert(src_pal_len > 0);
+			if (!src_pal || src_pal_len <= 0)
+				break;
+
+			// Get the palette.
+			static const int dest_pal_len = 256;
+			uint32_t *const palette = static_cast<uint32_t*>(aligned_malloc(16, dest_pal_len*sizeof(uint32_t)));
+			assert(palette != nullptr);
+			if (unlikely(!palette)) {
+				// Unable to allocate memory for the palette.
+				g_object_unref(G_OBJECT(pixbuf));
+				return nullptr;
+			}
+
+			// Process 16 colors per iteration using NEON.
+			unsigned int i = (unsigned int)src_pal_len;
+			uint32_t *dest_pal = palette;
+			for (; i > 15; i -= 16, dest_pal += 16, src_pal += 16) {
+				const uint8_t *const src8 = reinterpret_cast<const uint8_t*>(src_pal);
+				uint8_t *const dest8 = reinterpret_cast<uint8_t*>(dest_pal);
+
+				const uint8x16_t sa = vld1q_u8(&src8[0]);
+				const uint8x16_t sb = vld1q_u8(&src8[16]);
+				const uint8x16_t sc = vld1q_u8(&src8[32]);
+				const uint8x16_t sd = vld1q_u8(&src8[48]);
+
+				vst1q_u8(&dest8[0],  vqtbl1q_u8(sa, shuf_mask));
+				vst1q_u8(&dest8[16], vqtbl1q_u8(sb, shuf_mask));
+				vst1q_u8(&dest8[32], vqtbl1q_u8(sc, shuf_mask));
+				vst1q_u8(&dest8[48], vqtbl1q_u8(sd, shuf_mask));
+			}
+
+			// Remaining colors.
+			for (; i > 0; i--, dest_pal++, src_pal++) {
+				*dest_pal = (*src_pal & 0xFF00FF00) |
+					   ((*src_pal & 0x00FF0000) >> 16) |
+					   ((*src_pal & 0x000000FF) << 16);
+			}
+
+			// Zero out the rest of the palette if the new
+			// palette is larger than the old palette.
+			if (src_pal_len < dest_pal_len) {
+				memset(dest_pal, 0, (dest_pal_len - src_pal_len) * sizeof(uint32_t));
+			}
+
+			// Convert the image data from CI8 to ARGB32.
+			const uint8_t *img_buf = static_cast<const uint8_t*>(img->bits());
+			const int src_stride_adj = img->stride() - width;
+			for (unsigned int y = (unsigned int)height; y > 0; y--) {
+				unsigned int x;
+				for (x = (unsigned int)width; x > 3; x -= 4) {
+					px_dest[0] = palette[img_buf[0]];
+					px_dest[1] = palette[img_buf[1]];
+					px_dest[2] = palette[img_buf[2]];
+					px_dest[3] = palette[img_buf[3]];
+					px_dest += 4;
+					img_buf += 4;
+				}
+				for (; x > 0; x--, px_dest++, img_buf++) {
+					// Last pixels.
+					*px_dest = palette[*img_buf];
+				}
+
+				// Next line.
+				img_buf += src_stride_adj;
+				px_dest += dest_stride_adj;
+			}
+
+			aligned_free(palette);
+			break;
+		}
+
+		default:
+			// Unsupported image format.
+			assert(!"Unsupported rp_image::Format.");
+			g_object_unref(pixbuf);
+			pixbuf = nullptr;
+			break;
+	}
+
+	return pixbuf;
+}
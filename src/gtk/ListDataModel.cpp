@@ -0,0 +1,471 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (GTK+ common)                      *
+ * ListDataModel.cpp: GtkTreeModel for RFT_LISTDATA.                       *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ListDataModel.hpp"
+#include "PIMGTYPE.hpp"
+
+// librpbase, librptexture
+using LibRpBase::RomFields;
+using LibRpTexture::rp_image;
+
+// C++ STL classes.
+using std::string;
+using std::vector;
+
+static void	list_data_model_tree_model_init	(GtkTreeModelIface *iface);
+static void	list_data_model_finalize	(GObject	*object);
+
+// GtkTreeModel interface.
+static GtkTreeModelFlags list_data_model_get_flags	(GtkTreeModel	*tree_model);
+static gint	list_data_model_get_n_columns	(GtkTreeModel	*tree_model);
+static GType	list_data_model_get_column_type	(GtkTreeModel	*tree_model,
+						 gint		 index);
+static gboolean	list_data_model_get_iter	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter,
+						 GtkTreePath	*path);
+static GtkTreePath *list_data_model_get_path	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter);
+static void	list_data_model_get_value	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter,
+						 gint		 column,
+						 GValue		*value);
+static gboolean	list_data_model_iter_next	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter);
+static gboolean	list_data_model_iter_children	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter,
+						 GtkTreeIter	*parent);
+static gboolean	list_data_model_iter_has_child	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter);
+static gint	list_data_model_iter_n_children	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter);
+static gboolean	list_data_model_iter_nth_child	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter,
+						 GtkTreeIter	*parent,
+						 gint		 n);
+static gboolean	list_data_model_iter_parent	(GtkTreeModel	*tree_model,
+						 GtkTreeIter	*iter,
+						 GtkTreeIter	*child);
+
+// ListDataModel class.
+struct _ListDataModelClass {
+	GObjectClass __parent__;
+};
+
+// ListDataModel instance.
+struct _ListDataModel {
+	GObject __parent__;
+
+	const RomFields::Field *field;
+	const RomFields::ListData_t *list_data;
+	gint stamp;		// Iterator stamp.
+
+	int row_count;
+	int col_count;		// Including the checkbox/icon column.
+	int col_start;		// First string column.
+
+	// ListView row -> ListData_t row.
+	// Only used if rows are skipped. (if empty, 1:1)
+	vector<int> *row_map;
+
+	// Checkboxes. (one bit per model row)
+	uint32_t checkboxes;
+	bool has_checkboxes;
+	bool has_icons;
+
+	// Icon cache. Icons are converted when they're
+	// first requested by the view.
+	vector<PIMGTYPE> *icons;
+};
+
+// NOTE: G_DEFINE_TYPE() doesn't work in C++ mode with gcc-6.2
+// due to an implicit int to GTypeFlags conversion.
+G_DEFINE_TYPE_EXTENDED(ListDataModel, list_data_model,
+	G_TYPE_OBJECT, static_cast<GTypeFlags>(0),
+		G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL,
+			list_data_model_tree_model_init));
+
+static void
+list_data_model_class_init(ListDataModelClass *klass)
+{
+	GObjectClass *gobject_class = G_OBJECT_CLASS(klass);
+	gobject_class->finalize = list_data_model_finalize;
+}
+
+static void
+list_data_model_tree_model_init(GtkTreeModelIface *iface)
+{
+	iface->get_flags = list_data_model_get_flags;
+	iface->get_n_columns = list_data_model_get_n_columns;
+	iface->get_column_type = list_data_model_get_column_type;
+	iface->get_iter = list_data_model_get_iter;
+	iface->get_path = list_data_model_get_path;
+	iface->get_value = list_data_model_get_value;
+	iface->iter_next = list_data_model_iter_next;
+	iface->iter_children = list_data_model_iter_children;
+	iface->iter_has_child = list_data_model_iter_has_child;
+	iface->iter_n_children = list_data_model_iter_n_children;
+	iface->iter_nth_child = list_data_model_iter_nth_child;
+	iface->iter_parent = list_data_model_iter_parent;
+}
+
+static void
+list_data_model_init(ListDataModel *model)
+{
+	model->field = nullptr;
+	model->list_data = nullptr;
+	model->stamp = g_random_int();
+	model->row_count = 0;
+	model->col_count = 0;
+	model->col_start = 0;
+	model->row_map = new vector<int>();
+	model->checkboxes = 0;
+	model->has_checkboxes = false;
+	model->has_icons = false;
+	model->icons = new vector<PIMGTYPE>();
+}
+
+static void
+list_data_model_finalize(GObject *object)
+{
+	ListDataModel *const model = LIST_DATA_MODEL(object);
+
+	delete model->row_map;
+	if (model->icons) {
+		for (PIMGTYPE icon : *(model->icons)) {
+			if (icon) {
+				PIMGTYPE_destroy(icon);
+			}
+		}
+		delete model->icons;
+	}
+
+	// Call the superclass finalize() function.
+	G_OBJECT_CLASS(list_data_model_parent_class)->finalize(object);
+}
+
+/**
+ * Create a GtkTreeModel for an RFT_LISTDATA field.
+ *
+ * The field's data is not copied, so it must remain valid
+ * until the model is destroyed. Strings are returned directly
+ * from the ListData_t, and icons are converted when they're
+ * first requested by the view.
+ *
+ * Column layout:
+ * - If the field has checkboxes or icons, column 0 is
+ *   G_TYPE_BOOLEAN or PIMGTYPE_GOBJECT_TYPE.
+ * - The remaining columns are G_TYPE_STRING.
+ *
+ * For RFT_LISTDATA_MULTI, the first language is used
+ * until list_data_model_set_list_data() is called.
+ *
+ * @param field RFT_LISTDATA field.
+ * @return ListDataModel, or nullptr on error.
+ */
+ListDataModel*
+list_data_model_new(const RomFields::Field *field)
+{
+	assert(field != nullptr);
+	assert(!field || field->type == RomFields::RFT_LISTDATA);
+	if (!field || field->type != RomFields::RFT_LISTDATA) {
+		// Not an RFT_LISTDATA field.
+		return nullptr;
+	}
+
+	// Single language ListData_t.
+	// For RFT_LISTDATA_MULTI, the first language is used for now.
+	const auto &listDataDesc = field->desc.list_data;
+	const RomFields::ListData_t *list_data = nullptr;
+	if (listDataDesc.flags & RomFields::RFT_LISTDATA_MULTI) {
+		const auto *const multi = field->data.list_data.data.multi;
+		if (multi && !multi->empty()) {
+			list_data = &multi->cbegin()->second;
+		}
+	} else {
+		list_data = field->data.list_data.data.single;
+	}
+	if (!list_data || list_data->empty()) {
+		// No data...
+		return nullptr;
+	}
+
+	ListDataModel *const model = static_cast<ListDataModel*>(
+		g_object_new(TYPE_LIST_DATA_MODEL, nullptr));
+	model->field = field;
+	model->list_data = list_data;
+	model->has_checkboxes = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_CHECKBOXES);
+	model->has_icons = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_ICONS) &&
+	                   field->data.list_data.mxd.icons != nullptr;
+
+	if (listDataDesc.names) {
+		model->col_count = static_cast<int>(listDataDesc.names->size());
+	} else {
+		// No column headers.
+		// Use the first row.
+		model->col_count = static_cast<int>(list_data->at(0).size());
+	}
+	if (model->has_checkboxes || model->has_icons) {
+		// Prepend an extra column for checkboxes or icons.
+		model->col_start = 1;
+		model->col_count++;
+	}
+
+	if (model->has_checkboxes) {
+		// Rows with no data are skipped.
+		// FIXME: Skip even if we don't have checkboxes?
+		// (also check other UI frontends)
+		uint32_t checkboxes = field->data.list_data.mxd.checkboxes;
+		vector<int> &row_map = *(model->row_map);
+		row_map.reserve(list_data->size());
+		int row = 0;
+		const auto list_data_cend = list_data->cend();
+		for (auto iter = list_data->cbegin(); iter != list_data_cend;
+		     ++iter, row++, checkboxes >>= 1)
+		{
+			if (iter->empty())
+				continue;
+			if (checkboxes & 1) {
+				model->checkboxes |= (1U << row_map.size());
+			}
+			row_map.emplace_back(row);
+		}
+		model->row_count = static_cast<int>(row_map.size());
+	} else {
+		model->row_count = static_cast<int>(list_data->size());
+	}
+
+	if (model->has_icons) {
+		model->icons->resize(model->row_count, nullptr);
+	}
+
+	return model;
+}
+
+/**
+ * Set the ListData_t for an RFT_LISTDATA_MULTI field.
+ * This must have the same number of rows as the
+ * ListData_t that the model was created with.
+ * @param model ListDataModel
+ * @param list_data ListData_t for the selected language.
+ */
+void
+list_data_model_set_list_data(ListDataModel *model, const RomFields::ListData_t *list_data)
+{
+	g_return_if_fail(IS_LIST_DATA_MODEL(model));
+	g_return_if_fail(list_data != nullptr);
+	if (model->list_data == list_data)
+		return;
+
+	model->list_data = list_data;
+
+	// Notify the view that the text has changed.
+	GtkTreeIter iter;
+	iter.stamp = model->stamp;
+	iter.user_data2 = nullptr;
+	iter.user_data3 = nullptr;
+	GtkTreePath *const path = gtk_tree_path_new_first();
+	for (int row = 0; row < model->row_count; row++) {
+		iter.user_data = GINT_TO_POINTER(row);
+		gtk_tree_model_row_changed(GTK_TREE_MODEL(model), path, &iter);
+		gtk_tree_path_next(path);
+	}
+	gtk_tree_path_free(path);
+}
+
+/** GtkTreeModel interface **/
+
+static GtkTreeModelFlags
+list_data_model_get_flags(GtkTreeModel *tree_model)
+{
+	RP_UNUSED(tree_model);
+	return static_cast<GtkTreeModelFlags>(GTK_TREE_MODEL_LIST_ONLY | GTK_TREE_MODEL_ITERS_PERSIST);
+}
+
+static gint
+list_data_model_get_n_columns(GtkTreeModel *tree_model)
+{
+	g_return_val_if_fail(IS_LIST_DATA_MODEL(tree_model), 0);
+	return LIST_DATA_MODEL(tree_model)->col_count;
+}
+
+static GType
+list_data_model_get_column_type(GtkTreeModel *tree_model, gint index)
+{
+	g_return_val_if_fail(IS_LIST_DATA_MODEL(tree_model), G_TYPE_INVALID);
+	ListDataModel *const model = LIST_DATA_MODEL(tree_model);
+	g_return_val_if_fail(index >= 0 && index < model->col_count, G_TYPE_INVALID);
+
+	if (index < model->col_start) {
+		return (model->has_checkboxes ? G_TYPE_BOOLEAN : PIMGTYPE_GOBJECT_TYPE);
+	}
+	return G_TYPE_STRING;
+}
+
+static gboolean
+list_data_model_get_iter(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreePath *path)
+{
+	g_return_val_if_fail(IS_LIST_DATA_MODEL(tree_model), false);
+	g_return_val_if_fail(gtk_tree_path_get_depth(path) > 0, false);
+
+	return list_data_model_iter_nth_child(tree_model, iter, nullptr,
+		gtk_tree_path_get_indices(path)[0]);
+}
+
+static GtkTreePath*
+list_data_model_get_path(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+	g_return_val_if_fail(IS_LIST_DATA_MODEL(tree_model), nullptr);
+	ListDataModel *const model = LIST_DATA_MODEL(tree_model);
+	g_return_val_if_fail(iter->stamp == model->stamp, nullptr);
+
+	return gtk_tree_path_new_from_indices(GPOINTER_TO_INT(iter->user_data), -1);
+}
+
+static void
+list_data_model_get_value(GtkTreeModel *tree_model, GtkTreeIter *iter, gint column, GValue *value)
+{
+	g_return_if_fail(IS_LIST_DATA_MODEL(tree_model));
+	ListDataModel *const model = LIST_DATA_MODEL(tree_model);
+	g_return_if_fail(iter->stamp == model->stamp);
+	g_return_if_fail(column >= 0 && column < model->col_count);
+
+	const int lv_row = GPOINTER_TO_INT(iter->user_data);
+	g_return_if_fail(lv_row >= 0 && lv_row < model->row_count);
+	const int row = (model->row_map->empty() ? lv_row : model->row_map->at(lv_row));
+
+	g_value_init(value, list_data_model_get_column_type(tree_model, column));
+	if (column < model->col_start) {
+		if (model->has_checkboxes) {
+			// Checkbox column.
+			g_value_set_boolean(value, !!(model->checkboxes & (1U << lv_row)));
+			return;
+		}
+
+		// Icon column.
+		// Convert the icon if it hasn't been converted yet.
+		PIMGTYPE &icon = model->icons->at(lv_row);
+		if (!icon) {
+			const auto *const icons = model->field->data.list_data.mxd.icons;
+			const rp_image *const img = (row < static_cast<int>(icons->size())
+				? icons->get(row) : nullptr);
+			if (!img) {
+				// No icon for this row.
+				return;
+			}
+
+			icon = rp_image_to_PIMGTYPE(img);
+			img->unref();
+			if (!icon) {
+				// Unable to convert the icon.
+				return;
+			}
+
+			// TODO: Ideal icon size?
+			// Using 32x32 for now.
+			static const int icon_sz = 32;
+			// NOTE: GtkCellRendererPixbuf can't scale the
+			// pixbuf itself...
+			if (!PIMGTYPE_size_check(icon, icon_sz, icon_sz)) {
+				// TODO: Use nearest-neighbor if upscaling.
+				// Also, preserve the aspect ratio.
+				PIMGTYPE scaled = PIMGTYPE_scale(icon, icon_sz, icon_sz, true);
+				if (scaled) {
+					PIMGTYPE_destroy(icon);
+					icon = scaled;
+				}
+			}
+		}
+#ifdef RP_GTK_USE_CAIRO
+		g_value_set_boxed(value, icon);
+#else /* !RP_GTK_USE_CAIRO */
+		g_value_set_object(value, icon);
+#endif /* RP_GTK_USE_CAIRO */
+		return;
+	}
+
+	// String column.
+	// NOTE: The string isn't copied, since the
+	// ListData_t outlives the model.
+	const vector<string> &data_row = model->list_data->at(row);
+	const int data_col = column - model->col_start;
+	if (data_col < static_cast<int>(data_row.size())) {
+		g_value_set_static_string(value, data_row[data_col].c_str());
+	}
+}
+
+static gboolean
+list_data_model_iter_next(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+	g_return_val_if_fail(IS_LIST_DATA_MODEL(tree_model), false);
+	ListDataModel *const model = LIST_DATA_MODEL(tree_model);
+	g_return_val_if_fail(iter->stamp == model->stamp, false);
+
+	const int row = GPOINTER_TO_INT(iter->user_data) + 1;
+	if (row >= model->row_count) {
+		// No more rows.
+		iter->stamp = 0;
+		return false;
+	}
+	iter->user_data = GINT_TO_POINTER(row);
+	return true;
+}
+
+static gboolean
+list_data_model_iter_children(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *parent)
+{
+	return list_data_model_iter_nth_child(tree_model, iter, parent, 0);
+}
+
+static gboolean
+list_data_model_iter_has_child(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+	// List only. Rows don't have children.
+	RP_UNUSED(tree_model);
+	RP_UNUSED(iter);
+	return false;
+}
+
+static gint
+list_data_model_iter_n_children(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+	g_return_val_if_fail(IS_LIST_DATA_MODEL(tree_model), 0);
+	if (iter) {
+		// List only. Rows don't have children.
+		return 0;
+	}
+	return LIST_DATA_MODEL(tree_model)->row_count;
+}
+
+static gboolean
+list_data_model_iter_nth_child(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *parent, gint n)
+{
+	g_return_val_if_fail(IS_LIST_DATA_MODEL(tree_model), false);
+	ListDataModel *const model = LIST_DATA_MODEL(tree_model);
+	if (parent || n < 0 || n >= model->row_count) {
+		// List only, or row is out of range.
+		iter->stamp = 0;
+		return false;
+	}
+
+	iter->stamp = model->stamp;
+	iter->user_data = GINT_TO_POINTER(n);
+	iter->user_data2 = nullptr;
+	iter->user_data3 = nullptr;
+	return true;
+}
+
+static gboolean
+list_data_model_iter_parent(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *child)
+{
+	// List only. Rows don't have parents.
+	RP_UNUSED(tree_model);
+	RP_UNUSED(child);
+	iter->stamp = 0;
+	return false;
+}
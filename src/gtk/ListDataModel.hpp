@@ -0,0 +1,65 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (GTK+ common)                      *
+ * ListDataModel.hpp: GtkTreeModel for RFT_LISTDATA.                       *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_GTK_LISTDATAMODEL_HPP__
+#define __ROMPROPERTIES_GTK_LISTDATAMODEL_HPP__
+
+#include <gtk/gtk.h>
+
+// librpbase
+#include "librpbase/RomFields.hpp"
+
+G_BEGIN_DECLS
+
+typedef struct _ListDataModelClass	ListDataModelClass;
+typedef struct _ListDataModel		ListDataModel;
+
+#define TYPE_LIST_DATA_MODEL            (list_data_model_get_type())
+#define LIST_DATA_MODEL(obj)            (G_TYPE_CHECK_INSTANCE_CAST((obj), TYPE_LIST_DATA_MODEL, ListDataModel))
+#define LIST_DATA_MODEL_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST((klass),  TYPE_LIST_DATA_MODEL, ListDataModelClass))
+#define IS_LIST_DATA_MODEL(obj)         (G_TYPE_CHECK_INSTANCE_TYPE((obj), TYPE_LIST_DATA_MODEL))
+#define IS_LIST_DATA_MODEL_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass),  TYPE_LIST_DATA_MODEL))
+#define LIST_DATA_MODEL_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS((obj),  TYPE_LIST_DATA_MODEL, ListDataModelClass))
+
+/* this function is implemented automatically by the G_DEFINE_TYPE macro */
+GType		list_data_model_get_type	(void) G_GNUC_CONST G_GNUC_INTERNAL;
+
+G_END_DECLS
+
+/**
+ * Create a GtkTreeModel for an RFT_LISTDATA field.
+ *
+ * The field's data is not copied, so it must remain valid
+ * until the model is destroyed. Strings are returned directly
+ * from the ListData_t, and icons are converted when they're
+ * first requested by the view.
+ *
+ * Column layout:
+ * - If the field has checkboxes or icons, column 0 is
+ *   G_TYPE_BOOLEAN or PIMGTYPE_GOBJECT_TYPE.
+ * - The remaining columns are G_TYPE_STRING.
+ *
+ * For RFT_LISTDATA_MULTI, the first language is used
+ * until list_data_model_set_list_data() is called.
+ *
+ * @param field RFT_LISTDATA field.
+ * @return ListDataModel, or nullptr on error.
+ */
+ListDataModel	*list_data_model_new(const LibRpBase::RomFields::Field *field) G_GNUC_INTERNAL G_GNUC_MALLOC;
+
+/**
+ * Set the ListData_t for an RFT_LISTDATA_MULTI field.
+ * This must have the same number of rows as the
+ * ListData_t that the model was created with.
+ * @param model ListDataModel
+ * @param list_data ListData_t for the selected language.
+ */
+void		list_data_model_set_list_data(ListDataModel *model,
+					      const LibRpBase::RomFields::ListData_t *list_data) G_GNUC_INTERNAL;
+
+#endif /* __ROMPROPERTIES_GTK_LISTDATAMODEL_HPP__ */
@@ -19,17 +19,30 @@
 // Custom widgets
 #include "DragImage.hpp"
 #include "MessageWidget.hpp"
+#include "ListDataModel.hpp"
+#ifdef RP_GTK_USE_CAIRO
+#  include "RpCairoBackend.hpp"
+#endif /* RP_GTK_USE_CAIRO */
 
 // librpbase, librpfile, librptexture
 #include "librpbase/TextOut.hpp"
+#include "librpbase/img/SharedImageCache.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 using LibRpTexture::rp_image;
 
 // libromdata
+#include "libromdata/DetectCache.hpp"
+#include "libromdata/RomDataCache.hpp"
 #include "libromdata/RomDataFactory.hpp"
+using LibRomData::DetectCache;
+using LibRomData::RomDataCache;
 using LibRomData::RomDataFactory;
 
+// librpthreads
+#include "librpthreads/Semaphore.hpp"
+using LibRpThreads::Semaphore;
+
 // C++ STL classes.
 #include <fstream>
 #include <sstream>
@@ -62,6 +75,10 @@ static inline GtkWidget *gtk_tree_view_column_get_button(GtkTreeViewColumn *tree
 }
 #endif /* !GTK_CHECK_VERSION(3,0,0) */
 
+#if !GTK_CHECK_VERSION(2,20,0)
+#  define gtk_widget_get_mapped(widget) GTK_WIDGET_MAPPED(widget)
+#endif /* !GTK_CHECK_VERSION(2,20,0) */
+
 
 // References:
 // - audio-tags plugin
@@ -100,8 +117,16 @@ static void	rom_data_view_desc_format_type_changed(RomDataView *page,
 						 RpDescFormatType desc_format_type);
 
 static void	rom_data_view_init_header_row	(RomDataView	*page);
+static void	rom_data_view_init_header_images(RomDataView	*page);
 static void	rom_data_view_update_display	(RomDataView	*page);
 static gboolean	rom_data_view_load_rom_data	(gpointer	 data);
+static gpointer	rom_data_view_load_thread	(gpointer	 data);
+static void	rom_data_view_load_images_cb	(const RomData	*romData,
+						 uint32_t	 imgbf,
+						 void		*userdata);
+static gboolean	rom_data_view_load_fields_idle	(gpointer	 data);
+static gboolean	rom_data_view_load_images_idle	(gpointer	 data);
+static gboolean	rom_data_view_load_done_idle	(gpointer	 data);
 static void	rom_data_view_delete_tabs	(RomDataView	*page);
 
 /** Signal handlers **/
@@ -150,19 +175,42 @@ enum StandardOptionID {
 };
 
 struct Data_ListDataMulti_t {
-	GtkListStore *listStore;
+	ListDataModel *listModel;
 	GtkTreeView *treeView;
 	const RomFields::Field *field;
 
 	Data_ListDataMulti_t(
-		GtkListStore *listStore,
+		ListDataModel *listModel,
 		GtkTreeView *treeView,
 		const RomFields::Field *field)
-		: listStore(listStore)
+		: listModel(listModel)
 		, treeView(treeView)
 		, field(field) { }
 };
 
+// Asynchronous RomData loading.
+// The worker thread creates the RomData object and loads
+// its fields, then the header images. The main thread is
+// notified using idle callbacks after each step.
+// NOTE: RomData isn't thread-safe. Until the worker thread
+// is done, the main thread may only read the fields.
+struct LoadInfo {
+	RomDataView *page;	// g_object_ref()'d
+	gchar *uri;
+	RomData *romData;	// Set by the worker thread.
+
+	// Set if the page no longer needs this RomData object. (atomic)
+	// If set, the worker thread skips loading the images.
+	gint cancelled;
+
+	// Released by the RomData::loadImagesAsync() callback.
+	// (owned by the worker thread)
+	Semaphore *semImages;
+
+	// Set on the main thread once the header images are shown.
+	bool imagesLoaded;
+};
+
 // GTK+ property page instance.
 struct _RomDataView {
 	super __parent__;
@@ -170,6 +218,10 @@ struct _RomDataView {
 	RomData		*romData;	// ROM data
 	gchar		*uri;		// URI (GVfs)
 
+	// Current asynchronous load, or nullptr if not loading.
+	// Set until the worker thread has loaded the header images.
+	LoadInfo	*load_info;
+
 	// "Options" button.
 	GtkWidget	*btnOptions;
 	GtkWidget	*menuOptions;
@@ -254,6 +306,18 @@ rom_data_view_class_init(RomDataViewClass *klass)
 
 	// Install the properties.
 	g_object_class_install_properties(gobject_class, PROP_LAST, properties);
+
+#ifdef RP_GTK_USE_CAIRO
+	// Register RpCairoBackend.
+	// TODO: Static initializer somewhere?
+	rp_image::setBackendCreatorFn(RpCairoBackend::creator_fn);
+#endif /* RP_GTK_USE_CAIRO */
+
+	// Share decoded images with other processes.
+	SharedImageCache::setEnabled(true);
+
+	// Remember which RomData subclass was detected for each file.
+	DetectCache::setEnabled(true);
 }
 
 /**
@@ -430,6 +494,12 @@ rom_data_view_dispose(GObject *object)
 		page->changed_idle = 0;
 	}
 
+	/* Cancel the asynchronous load */
+	if (page->load_info) {
+		g_atomic_int_set(&page->load_info->cancelled, 1);
+		page->load_info = nullptr;
+	}
+
 #ifndef USE_GTK_MENU_BUTTON
 	// Delete the "Options" button menu.
 	if (page->menuOptions) {
@@ -580,6 +650,12 @@ rom_data_view_set_uri(RomDataView	*page,
 		g_free(page->uri);
 		page->uri = nullptr;
 
+		// Cancel the asynchronous load.
+		if (page->load_info) {
+			g_atomic_int_set(&page->load_info->cancelled, 1);
+			page->load_info = nullptr;
+		}
+
 		// Unreference the existing RomData object.
 		UNREF_AND_NULL(page->romData);
 
@@ -693,6 +769,26 @@ rom_data_view_init_header_row(RomDataView *page)
 		C_("RomDataView", "%1$s\n%2$s"), systemName, fileType);
 	gtk_label_set_text(GTK_LABEL(page->lblSysInfo), sysInfo.c_str());
 
+	if (page->load_info && !page->load_info->imagesLoaded) {
+		// The header images are still being loaded.
+		gtk_widget_hide(page->imgBanner);
+		gtk_widget_hide(page->imgIcon);
+	} else {
+		rom_data_view_init_header_images(page);
+	}
+
+	// Show the header row. (outer box)
+	gtk_widget_show(page->hboxHeaderRow_outer);
+}
+
+static void
+rom_data_view_init_header_images(RomDataView *page)
+{
+	const RomData *const romData = page->romData;
+	assert(romData != nullptr);
+	if (!romData)
+		return;
+
 	// Supported image types.
 	const uint32_t imgbf = romData->supportedImageTypes();
 
@@ -724,9 +820,6 @@ rom_data_view_init_header_row(RomDataView *page)
 			}
 		}
 	}
-
-	// Show the header row. (outer box)
-	gtk_widget_show(page->hboxHeaderRow_outer);
 }
 
 #if GTK_CHECK_VERSION(3,0,0)
@@ -757,8 +850,8 @@ rom_data_view_init_string(RomDataView *page,
 	gtk_label_set_use_underline(GTK_LABEL(widget), false);
 	gtk_widget_show(widget);
 
-	if (!str && field.data.str) {
-		str = field.data.str->c_str();
+	if (!str && field.data.str.data) {
+		str = field.data.str.data;
 	}
 
 	if (field.type == RomFields::RFT_STRING &&
@@ -923,7 +1016,7 @@ static GtkWidget*
 rom_data_view_init_listdata(RomDataView *page,
 	const RomFields::Field &field, int fieldIdx)
 {
-	// ListData type. Create a GtkListStore for the data.
+	// ListData type. Create a ListDataModel for the data.
 	const auto &listDataDesc = field.desc.list_data;
 	// NOTE: listDataDesc.names can be nullptr,
 	// which means we don't have any column headers.
@@ -982,98 +1075,19 @@ rom_data_view_init_listdata(RomDataView *page,
 		colCount = static_cast<int>(list_data->at(0).size());
 	}
 
-	GtkListStore *listStore;
-	int col_start = 0;
-	if (hasCheckboxes) {
-		// Prepend an extra column for checkboxes.
-		GType *types = new GType[colCount+1];
-		types[0] = G_TYPE_BOOLEAN;
-		for (int i = colCount; i > 0; i--) {
-			types[i] = G_TYPE_STRING;
-		}
-		listStore = gtk_list_store_newv(colCount+1, types);
-		delete[] types;
-		col_start = 1;	// Skip the checkbox column for strings.
-	} else if (hasIcons) {
-		// Prepend an extra column for icons.
-		GType *types = new GType[colCount+1];
-		types[0] = PIMGTYPE_GOBJECT_TYPE;
-		for (int i = colCount; i > 0; i--) {
-			types[i] = G_TYPE_STRING;
-		}
-		listStore = gtk_list_store_newv(colCount+1, types);
-		delete[] types;
-		col_start = 1;	// Skip the icon column for strings.
-	} else {
-		// All strings.
-		GType *types = new GType[colCount];
-		for (int i = colCount-1; i >= 0; i--) {
-			types[i] = G_TYPE_STRING;
-		}
-		listStore = gtk_list_store_newv(colCount, types);
-		delete[] types;
-	}
-
-	// Add the row data.
-	uint32_t checkboxes = 0;
-	if (hasCheckboxes) {
-		checkboxes = field.data.list_data.mxd.checkboxes;
-	}
-	unsigned int row = 0;	// for icons [TODO: Use iterator?]
-	const auto list_data_cend = list_data->cend();
-	for (auto iter = list_data->cbegin(); iter != list_data_cend; ++iter, row++) {
-		const vector<string> &data_row = *iter;
-		// FIXME: Skip even if we don't have checkboxes?
-		// (also check other UI frontends)
-		if (hasCheckboxes && data_row.empty()) {
-			// Skip this row.
-			checkboxes >>= 1;
-			continue;
-		}
-
-		GtkTreeIter treeIter;
-		gtk_list_store_append(listStore, &treeIter);
-		if (hasCheckboxes) {
-			// Checkbox column.
-			gtk_list_store_set(listStore, &treeIter,
-				0, (checkboxes & 1), -1);
-			checkboxes >>= 1;
-		} else if (hasIcons) {
-			// Icon column.
-			const rp_image *const icon = field.data.list_data.mxd.icons->at(row);
-			assert(icon != nullptr);
-			if (icon) {
-				PIMGTYPE pixbuf = rp_image_to_PIMGTYPE(icon);
-				if (pixbuf) {
-					// TODO: Ideal icon size?
-					// Using 32x32 for now.
-					static const int icon_sz = 32;
-					// NOTE: GtkCellRendererPixbuf can't scale the
-					// pixbuf itself...
-					if (!PIMGTYPE_size_check(pixbuf, icon_sz, icon_sz)) {
-						// TODO: Use nearest-neighbor if upscaling.
-						// Also, preserve the aspect ratio.
-						PIMGTYPE scaled = PIMGTYPE_scale(pixbuf, icon_sz, icon_sz, true);
-						if (scaled) {
-							PIMGTYPE_destroy(pixbuf);
-							pixbuf = scaled;
-						}
-					}
-					gtk_list_store_set(listStore, &treeIter,
-						0, pixbuf, -1);
-					PIMGTYPE_destroy(pixbuf);
-				}
-			}
-		}
-
-		if (!isMulti) {
-			int col = col_start;
-			const auto data_row_cend = data_row.cend();
-			for (auto iter = data_row.cbegin(); iter != data_row_cend; ++iter, col++) {
-				gtk_list_store_set(listStore, &treeIter, col, iter->c_str(), -1);
-			}
-		}
+	// Create the GtkTreeModel.
+	// NOTE: ListDataModel reads the strings directly from the
+	// ListData_t, so the rows don't need to be copied into a
+	// GtkListStore. For RFT_LISTDATA_MULTI, the language is
+	// set by rom_data_view_update_multi().
+	ListDataModel *const listModel = list_data_model_new(&field);
+	assert(listModel != nullptr);
+	if (!listModel) {
+		// No data...
+		return nullptr;
 	}
+	// If we have checkboxes or icons, start at column 1.
+	const int col_start = (hasCheckboxes || hasIcons) ? 1 : 0;
 
 	// Scroll area for the GtkTreeView.
 	GtkWidget *widget = gtk_scrolled_window_new(nullptr, nullptr);
@@ -1083,7 +1097,8 @@ rom_data_view_init_listdata(RomDataView *page,
 	gtk_widget_show(widget);
 
 	// Create the GtkTreeView.
-	GtkWidget *treeView = gtk_tree_view_new_with_model(GTK_TREE_MODEL(listStore));
+	GtkWidget *treeView = gtk_tree_view_new_with_model(GTK_TREE_MODEL(listModel));
+	g_object_unref(listModel);	// GtkTreeView has a reference.
 	gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(treeView),
 		(listDataDesc.names != nullptr));
 	gtk_widget_show(treeView);
@@ -1176,7 +1191,7 @@ rom_data_view_init_listdata(RomDataView *page,
 
 	if (isMulti) {
 		page->vecListDataMulti->emplace_back(
-			Data_ListDataMulti_t(listStore, GTK_TREE_VIEW(treeView), &field));
+			Data_ListDataMulti_t(listModel, GTK_TREE_VIEW(treeView), &field));
 	}
 
 	page->map_fieldIdx->insert(std::make_pair(fieldIdx, widget));
@@ -1419,7 +1434,7 @@ rom_data_view_update_multi(RomDataView *page, uint32_t user_lc)
 	for (auto iter = page->vecListDataMulti->cbegin();
 	     iter != vecListDataMulti_cend; ++iter)
 	{
-		GtkListStore *const listStore = iter->listStore;
+		ListDataModel *const listModel = iter->listModel;
 		const RomFields::Field *const pField = iter->field;
 		const auto *const pListData_multi = pField->data.list_data.data.multi;
 		assert(pListData_multi != nullptr);
@@ -1444,37 +1459,8 @@ rom_data_view_update_multi(RomDataView *page, uint32_t user_lc)
 		const auto *const pListData = RomFields::getFromListDataMulti(pListData_multi, page->def_lc, user_lc);
 		assert(pListData != nullptr);
 		if (pListData != nullptr) {
-			const auto &listDataDesc = pField->desc.list_data;
-
-			// If we have checkboxes or icons, start at column 1.
-			// Otherwise, start at column 0.
-			int col_start;
-			if (listDataDesc.flags & (RomFields::RFT_LISTDATA_CHECKBOXES | RomFields::RFT_LISTDATA_ICONS)) {
-				// Checkboxes and/or icons are present.
-				col_start = 1;
-			} else {
-				col_start = 0;
-			}
-
 			// Update the list.
-			GtkTreeIter treeIter;
-			gboolean ok = gtk_tree_model_get_iter_first(GTK_TREE_MODEL(listStore), &treeIter);
-			auto iter_listData = pListData->cbegin();
-			const auto pListData_cend = pListData->cend();
-			while (ok && iter_listData != pListData_cend) {
-				// TODO: Verify GtkListStore column count?
-				int col = col_start;
-				const auto iter_listData_cend = iter_listData->cend();
-				for (auto iter_row = iter_listData->cbegin();
-				     iter_row != iter_listData_cend; ++iter_row, col++)
-				{
-					gtk_list_store_set(listStore, &treeIter, col, iter_row->c_str(), -1);
-				}
-
-				// Next row.
-				++iter_listData;
-				ok = gtk_tree_model_iter_next(GTK_TREE_MODEL(listStore), &treeIter);
-			}
+			list_data_model_set_list_data(listModel, pListData);
 
 			// Resize the columns to fit the contents.
 			// NOTE: Only done on first load.
@@ -1629,9 +1615,7 @@ rom_data_view_update_field(RomDataView *page, int fieldIdx)
 				break;
 			}
 
-			gtk_label_set_text(GTK_LABEL(widget), field->data.str
-				? field->data.str->c_str()
-				: nullptr);
+			gtk_label_set_text(GTK_LABEL(widget), field->data.str.data);
 			ret = 0;
 			break;
 		}
@@ -1889,7 +1873,9 @@ rom_data_view_update_display(RomDataView *page)
 	rom_data_view_delete_tabs(page);
 
 	// Create the "Options" button.
-	if (!page->btnOptions) {
+	// NOTE: If the RomData object is still being loaded,
+	// this is done once the worker thread is done with it.
+	if (!page->btnOptions && !page->load_info) {
 		rom_data_view_create_options_button(page);
 	}
 
@@ -2187,53 +2173,266 @@ rom_data_view_load_rom_data(gpointer data)
 	RomDataView *const page = ROM_DATA_VIEW(data);
 	g_return_val_if_fail(page != nullptr || IS_ROM_DATA_VIEW(page), G_SOURCE_REMOVE);
 
+	// Clear the timeout.
+	page->changed_idle = 0;
+
 	if (G_UNLIKELY(page->uri == nullptr)) {
 		// No URI.
 		// TODO: Remove widgets?
-		page->changed_idle = 0;
 		return G_SOURCE_REMOVE;
 	}
 
+	// Cancel the previous load, if any.
+	if (page->load_info) {
+		g_atomic_int_set(&page->load_info->cancelled, 1);
+	}
+
+	// Show a placeholder while loading.
+	// tr: Shown while the ROM is being loaded.
+	gtk_label_set_text(GTK_LABEL(page->lblSysInfo), C_("RomDataView", "Loading..."));
+	gtk_widget_hide(page->imgBanner);
+	gtk_widget_hide(page->imgIcon);
+	gtk_widget_show(page->hboxHeaderRow);
+	gtk_widget_show(page->hboxHeaderRow_outer);
+
+	// Load the RomData object on a worker thread so the
+	// file manager doesn't freeze while it's being loaded.
+	LoadInfo *const info = static_cast<LoadInfo*>(g_malloc0(sizeof(LoadInfo)));
+	info->page = ROM_DATA_VIEW(g_object_ref(page));
+	info->uri = g_strdup(page->uri);
+	page->load_info = info;
+
+#if GLIB_CHECK_VERSION(2,32,0)
+	GThread *const thread = g_thread_new("rp-romdataview", rom_data_view_load_thread, info);
+	g_thread_unref(thread);
+#else /* !GLIB_CHECK_VERSION(2,32,0) */
+	// NOTE: The thread isn't joinable, so it's freed when it exits.
+	g_thread_create(rom_data_view_load_thread, info, false, nullptr);
+#endif /* GLIB_CHECK_VERSION(2,32,0) */
+	return G_SOURCE_REMOVE;
+}
+
+/**
+ * Worker thread for loading the RomData object.
+ * @param data LoadInfo
+ * @return nullptr
+ */
+static gpointer
+rom_data_view_load_thread(gpointer data)
+{
+	LoadInfo *const info = static_cast<LoadInfo*>(data);
+
 	// Check if the URI maps to a local file.
 	IRpFile *file = nullptr;
-	gchar *const filename = g_filename_from_uri(page->uri, nullptr, nullptr);
+	RomData *romData = nullptr;
+	bool isCached = false;
+	gchar *const filename = g_filename_from_uri(info->uri, nullptr, nullptr);
 	if (filename) {
-		// Local file. Use RpFile.
-		file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
-		g_free(filename);
+		// Local file. Check the metadata cache first.
+		romData = RomDataCache::load(filename);
+		isCached = (romData != nullptr);
+		if (!romData) {
+			// Not cached. Use RpFile.
+			file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
+			if (file->isOpen()) {
+				// Create the RomData object.
+				// file is ref()'d by RomData.
+				romData = RomDataFactory::create(file);
+			}
+		}
 	} else {
 		// Not a local file. Use RpFileGio.
-		file = new RpFileGio(page->uri);
-	}
-
-	if (file->isOpen()) {
-		// Create the RomData object.
-		// file is ref()'d by RomData.
-		RomData *const romData = RomDataFactory::create(file);
-		if (romData != page->romData) {
-			// FIXME: If called from rom_data_view_set_property(), this might
-			// result in *two* notifications.
-			page->romData = romData;
-			g_object_notify_by_pspec(G_OBJECT(page), properties[PROP_SHOWING_DATA]);
+		file = RpFileGio::openCached(info->uri);
+		if (file->isOpen()) {
+			// Create the RomData object.
+			// file is ref()'d by RomData.
+			romData = RomDataFactory::create(file);
+		}
+	}
+	if (file) {
+		file->unref();
+	}
+
+	// Start loading the header images while the fields are loaded.
+	// RomData caches them, so rom_data_view_init_header_images()
+	// won't have to load them on the main thread.
+	info->romData = romData;
+	uint32_t imgbf = 0;
+	if (romData) {
+		imgbf = romData->supportedImageTypes() &
+			(RomData::IMGBF_INT_BANNER | RomData::IMGBF_INT_ICON);
+	}
+	if (imgbf != 0) {
+		info->semImages = new Semaphore(0);
+		if (romData->loadImagesAsync(imgbf, rom_data_view_load_images_cb, info) != 0) {
+			// Unable to start the image loading thread.
+			delete info->semImages;
+			info->semImages = nullptr;
 		}
+	}
 
-		// Update the display widgets.
-		rom_data_view_update_display(page);
+	// Load the fields.
+	if (romData) {
+		romData->fields();
+	}
+	g_idle_add(rom_data_view_load_fields_idle, info);
+
+	if (info->semImages) {
+		// Wait for the header images.
+		// NOTE: info must remain valid until the callback returns.
+		info->semImages->obtain();
+		delete info->semImages;
+		info->semImages = nullptr;
+	} else if (imgbf != 0 && !g_atomic_int_get(&info->cancelled)) {
+		// Load the header images here instead.
+		if (imgbf & RomData::IMGBF_INT_BANNER) {
+			romData->image(RomData::IMG_INT_BANNER);
+		}
+		if (imgbf & RomData::IMGBF_INT_ICON) {
+			romData->image(RomData::IMG_INT_ICON);
+			romData->iconAnimData();
+		}
+	}
 
-		// Make sure the underlying file handle is closed,
-		// since we don't need it once the RomData has been
-		// loaded by RomDataView.
-		if (romData) {
-			romData->close();
+	// Save the RomData object to the cache now that the fields and
+	// header images are being displayed, so encoding the images
+	// doesn't delay loading the view.
+	// NOTE: This is done before rom_data_view_load_done_idle(),
+	// since the worker thread still owns the RomData object.
+	// NOTE: Cached RomData objects don't have animated icons or
+	// ROM operations, so objects that have them aren't cached;
+	// the real RomData object will be loaded next time instead.
+	if (filename && romData && !isCached && !g_atomic_int_get(&info->cancelled)) {
+		if (!romData->iconAnimData() && romData->romOps().empty()) {
+			RomDataCache::save(filename, romData);
 		}
 	}
-	file->unref();
+	g_idle_add(rom_data_view_load_done_idle, info);
+	g_free(filename);
+	return nullptr;
+}
 
-	// Animation timer will be started when the page
-	// receives the "map" signal.
+/**
+ * RomData::loadImagesAsync() callback.
+ * This is called from the image loading thread.
+ * @param romData RomData object.
+ * @param imgbf Bitfield of internal images that were loaded.
+ * @param userdata LoadInfo
+ */
+static void
+rom_data_view_load_images_cb(const RomData *romData, uint32_t imgbf, void *userdata)
+{
+	RP_UNUSED(romData);
+	RP_UNUSED(imgbf);
+	LoadInfo *const info = static_cast<LoadInfo*>(userdata);
+	g_idle_add(rom_data_view_load_images_idle, info);
+	info->semImages->release();
+}
 
-	// Clear the timeout.
-	page->changed_idle = 0;
+/**
+ * The worker thread has loaded the fields.
+ * @param data LoadInfo
+ * @return G_SOURCE_REMOVE
+ */
+static gboolean
+rom_data_view_load_fields_idle(gpointer data)
+{
+	LoadInfo *const info = static_cast<LoadInfo*>(data);
+	RomDataView *const page = info->page;
+	if (page->load_info != info) {
+		// Loading was cancelled.
+		return G_SOURCE_REMOVE;
+	}
+
+	RomData *const romData = (info->romData ? info->romData->ref() : nullptr);
+	if (romData != page->romData) {
+		// FIXME: If called from rom_data_view_set_property(), this might
+		// result in *two* notifications.
+		UNREF(page->romData);
+		page->romData = romData;
+		g_object_notify_by_pspec(G_OBJECT(page), properties[PROP_SHOWING_DATA]);
+	} else {
+		UNREF(romData);
+	}
+
+	// Update the display widgets.
+	rom_data_view_update_display(page);
+	return G_SOURCE_REMOVE;
+}
+
+/**
+ * The header images have been loaded.
+ * The fields may still be loading.
+ * @param data LoadInfo
+ * @return G_SOURCE_REMOVE
+ */
+static gboolean
+rom_data_view_load_images_idle(gpointer data)
+{
+	LoadInfo *const info = static_cast<LoadInfo*>(data);
+	RomDataView *const page = info->page;
+	if (page->load_info != info) {
+		// Loading was cancelled.
+		return G_SOURCE_REMOVE;
+	}
+
+	info->imagesLoaded = true;
+	if (page->romData != info->romData) {
+		// The fields haven't been loaded yet.
+		// rom_data_view_init_header_row() will show the images.
+		return G_SOURCE_REMOVE;
+	}
+
+	rom_data_view_init_header_images(page);
+	if (gtk_widget_get_mapped(GTK_WIDGET(page))) {
+		drag_image_start_anim_timer(DRAG_IMAGE(page->imgIcon));
+	}
+	return G_SOURCE_REMOVE;
+}
+
+/**
+ * The worker thread has finished.
+ * @param data LoadInfo
+ * @return G_SOURCE_REMOVE
+ */
+static gboolean
+rom_data_view_load_done_idle(gpointer data)
+{
+	LoadInfo *const info = static_cast<LoadInfo*>(data);
+	RomDataView *const page = info->page;
+	if (page->load_info == info) {
+		page->load_info = nullptr;
+		if (page->romData) {
+			if (!info->imagesLoaded) {
+				rom_data_view_init_header_images(page);
+			}
+
+			// Create the "Options" button.
+			if (!page->btnOptions) {
+				rom_data_view_create_options_button(page);
+				if (page->btnOptions && gtk_widget_get_mapped(GTK_WIDGET(page))) {
+					gtk_widget_show(page->btnOptions);
+				}
+			}
+
+			// Start the animation timer if the page is visible.
+			// Otherwise, it will be started when the page
+			// receives the "map" signal.
+			if (gtk_widget_get_mapped(GTK_WIDGET(page))) {
+				drag_image_start_anim_timer(DRAG_IMAGE(page->imgIcon));
+			}
+
+			// Make sure the underlying file handle is closed,
+			// since we don't need it once the RomData has been
+			// loaded by RomDataView.
+			page->romData->close();
+		}
+	}
+
+	UNREF(info->romData);
+	g_object_unref(info->page);
+	g_free(info->uri);
+	g_free(info);
 	return G_SOURCE_REMOVE;
 }
 
@@ -2381,7 +2580,7 @@ tree_view_realize_signal_handler(GtkTreeView	*treeView,
 	gtk_tree_view_get_background_area(GTK_TREE_VIEW(treeView), path, nullptr, &rect);
 	gtk_tree_path_free(path);
 	if (rect.height <= 0) {
-		// GtkListStore probably doesn't have any items.
+		// The GtkTreeModel probably doesn't have any items.
 		return;
 	}
 	int height = rect.height * rows_visible;
@@ -0,0 +1,221 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (GTK+ 3.x)                         *
+ * RpCairoBackend.cpp: rp_image_backend using cairo_image_surface.         *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpCairoBackend.hpp"
+
+// librpbase, librptexture
+#include "librpbase/aligned_malloc.h"
+using LibRpTexture::rp_image;
+using LibRpTexture::rp_image_backend;
+
+// cairo_surface_t user data keys.
+// The image buffer is owned by the surface, so it's
+// still valid if the surface outlives the rp_image.
+static const cairo_user_data_key_t img_buf_key = {0};
+static const cairo_user_data_key_t parent_surface_key = {0};
+
+RpCairoBackend::RpCairoBackend(int width, int height, rp_image::Format format)
+	: super(width, height, format)
+	, m_surface(nullptr)
+	, m_data(nullptr)
+	, m_palette(nullptr)
+	, m_data_len(0)
+{
+	if (this->width <= 0 || this->height <= 0) {
+		// Image did not initialize successfully.
+		return;
+	}
+
+	// We're using the full stride for the last row
+	// to make it easier to manage.
+	m_data_len = this->height * this->stride;
+
+	// Allocate our own memory buffer.
+	// This is needed in order to use 16-byte row alignment.
+	uint8_t *const data = static_cast<uint8_t*>(aligned_malloc_tag(
+		LibRpFile::RpAllocStats::TAG_RP_IMAGE, 16, m_data_len));
+	if (!data) {
+		// Error allocating the memory buffer.
+		m_data_len = 0;
+		clear_properties();
+		return;
+	}
+
+	switch (format) {
+		case rp_image::Format::ARGB32: {
+			// CAIRO_FORMAT_ARGB32 has the same pixel layout as
+			// rp_image::Format::ARGB32, and Cairo accepts any
+			// stride that's a multiple of 4 bytes.
+			m_surface = cairo_image_surface_create_for_data(data,
+				CAIRO_FORMAT_ARGB32, width, height, this->stride);
+			if (cairo_surface_status(m_surface) != CAIRO_STATUS_SUCCESS ||
+			    cairo_surface_set_user_data(m_surface, &img_buf_key, data, aligned_free) != CAIRO_STATUS_SUCCESS)
+			{
+				// Error creating the surface.
+				cairo_surface_destroy(m_surface);
+				m_surface = nullptr;
+				aligned_free(data);
+				m_data_len = 0;
+				clear_properties();
+				return;
+			}
+			break;
+		}
+
+		case rp_image::Format::CI8: {
+			m_data = data;
+
+			// Palette is initialized to 0 to ensure
+			// there's no weird artifacts if the caller
+			// is converting a lower-color image.
+			const size_t palette_sz = 256*sizeof(*m_palette);
+			m_palette = static_cast<uint32_t*>(aligned_malloc_tag(
+				LibRpFile::RpAllocStats::TAG_RP_IMAGE, 16, palette_sz));
+			if (!m_palette) {
+				// Failed to allocate memory.
+				aligned_free(m_data);
+				m_data = nullptr;
+				m_data_len = 0;
+				clear_properties();
+				return;
+			}
+			memset(m_palette, 0, palette_sz);
+			break;
+		}
+
+		default:
+			assert(!"Unsupported rp_image::Format.");
+			aligned_free(data);
+			m_data_len = 0;
+			clear_properties();
+			return;
+	}
+}
+
+RpCairoBackend::~RpCairoBackend()
+{
+	if (m_surface) {
+		cairo_surface_destroy(m_surface);
+	}
+	aligned_free(m_data);
+	aligned_free(m_palette);
+}
+
+/**
+ * Creator function for rp_image::setBackendCreatorFn().
+ */
+rp_image_backend *RpCairoBackend::creator_fn(int width, int height, rp_image::Format format)
+{
+	return new RpCairoBackend(width, height, format);
+}
+
+void *RpCairoBackend::data(void)
+{
+	if (m_surface) {
+		// The caller is probably going to modify the image data.
+		cairo_surface_flush(m_surface);
+		return cairo_image_surface_get_data(m_surface);
+	}
+	return m_data;
+}
+
+const void *RpCairoBackend::data(void) const
+{
+	if (m_surface) {
+		return cairo_image_surface_get_data(m_surface);
+	}
+	return m_data;
+}
+
+size_t RpCairoBackend::data_len(void) const
+{
+	return m_data_len;
+}
+
+uint32_t *RpCairoBackend::palette(void)
+{
+	return m_palette;
+}
+
+const uint32_t *RpCairoBackend::palette(void) const
+{
+	return m_palette;
+}
+
+int RpCairoBackend::palette_len(void) const
+{
+	return (m_palette ? 256 : 0);
+}
+
+/**
+ * Shrink image dimensions.
+ * @param width New width.
+ * @param height New height.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpCairoBackend::shrink(int width, int height)
+{
+	assert(width > 0);
+	assert(height > 0);
+	assert(this->width > 0);
+	assert(this->height > 0);
+	assert(width <= this->width);
+	assert(height <= this->height);
+	if (width <= 0 || height <= 0 ||
+	    this->width <= 0 || this->height <= 0 ||
+	    width > this->width || height > this->height)
+	{
+		return -EINVAL;
+	}
+
+	if (m_surface) {
+		// Cairo doesn't support changing width/height in-place,
+		// so create a new surface that uses the same image buffer.
+		// The new surface holds a reference to the old surface,
+		// which owns the image buffer.
+		cairo_surface_t *const surface = cairo_image_surface_create_for_data(
+			cairo_image_surface_get_data(m_surface),
+			CAIRO_FORMAT_ARGB32, width, height, this->stride);
+		if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS ||
+		    cairo_surface_set_user_data(surface, &parent_surface_key, m_surface,
+			reinterpret_cast<cairo_destroy_func_t>(cairo_surface_destroy)) != CAIRO_STATUS_SUCCESS)
+		{
+			// Error creating the surface.
+			cairo_surface_destroy(surface);
+			return -ENOMEM;
+		}
+		m_surface = surface;
+	}
+
+	// We can simply reduce width/height without actually
+	// adjusting the image data.
+	this->width = width;
+	this->height = height;
+	m_data_len = height * this->stride;
+	return 0;
+}
+
+/**
+ * Get the underlying cairo_surface_t.
+ * Caller must destroy the surface.
+ *
+ * NOTE: The surface shares its image data with the rp_image.
+ * The image data is *not* premultiplied.
+ *
+ * @return cairo_surface_t, or nullptr if this isn't an ARGB32 image.
+ */
+cairo_surface_t *RpCairoBackend::getCairoSurface(void) const
+{
+	if (!m_surface)
+		return nullptr;
+
+	// rp_image functions modify the image data directly.
+	cairo_surface_mark_dirty(m_surface);
+	return cairo_surface_reference(m_surface);
+}
@@ -0,0 +1,83 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (GTK+ 3.x)                         *
+ * RpCairoBackend.hpp: rp_image_backend using cairo_image_surface.         *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_GTK_RPCAIROBACKEND_HPP__
+#define __ROMPROPERTIES_GTK_RPCAIROBACKEND_HPP__
+
+// librptexture
+#include "librptexture/img/rp_image_backend.hpp"
+
+// Cairo
+#include <cairo.h>
+
+/**
+ * rp_image data storage class using cairo_image_surface.
+ *
+ * ARGB32 images are stored in a CAIRO_FORMAT_ARGB32 surface.
+ * The pixel layout is identical, but the image data is *not*
+ * premultiplied, so the surface can only be used directly
+ * for PNG output or after premultiplying a copy.
+ *
+ * Cairo doesn't support 8bpp, so CI8 images are stored
+ * in a regular memory buffer.
+ */
+class RpCairoBackend : public LibRpTexture::rp_image_backend
+{
+	public:
+		RpCairoBackend(int width, int height, LibRpTexture::rp_image::Format format);
+		virtual ~RpCairoBackend();
+
+	private:
+		typedef LibRpTexture::rp_image_backend super;
+		RP_DISABLE_COPY(RpCairoBackend)
+
+	public:
+		/**
+		 * Creator function for rp_image::setBackendCreatorFn().
+		 */
+		static LibRpTexture::rp_image_backend *creator_fn(int width, int height, LibRpTexture::rp_image::Format format);
+
+		// Image data.
+		void *data(void) final;
+		const void *data(void) const final;
+		size_t data_len(void) const final;
+
+		// Image palette.
+		uint32_t *palette(void) final;
+		const uint32_t *palette(void) const final;
+		int palette_len(void) const final;
+
+	public:
+		/**
+		 * Shrink image dimensions.
+		 * @param width New width.
+		 * @param height New height.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int shrink(int width, int height) final;
+
+	public:
+		/**
+		 * Get the underlying cairo_surface_t.
+		 * Caller must destroy the surface.
+		 *
+		 * NOTE: The surface shares its image data with the rp_image.
+		 * The image data is *not* premultiplied.
+		 *
+		 * @return cairo_surface_t, or nullptr if this isn't an ARGB32 image.
+		 */
+		cairo_surface_t *getCairoSurface(void) const;
+
+	protected:
+		cairo_surface_t *m_surface;	// ARGB32 only
+		uint8_t *m_data;		// CI8 only
+		uint32_t *m_palette;		// CI8 only
+		size_t m_data_len;
+};
+
+#endif /* __ROMPROPERTIES_GTK_RPCAIROBACKEND_HPP__ */
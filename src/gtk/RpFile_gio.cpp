@@ -9,6 +9,11 @@
 #include "stdafx.h"
 #include "RpFile_gio.hpp"
 
+// librpfile
+#include "librpfile/CachedFile.hpp"
+using LibRpFile::CachedFile;
+using LibRpFile::IRpFile;
+
 // gio
 #include <gio/gio.h>
 
@@ -131,6 +136,30 @@ void RpFileGio::init(void)
 	// TODO: Transparent gzip decompression?
 }
 
+/**
+ * Open a file with a read cache.
+ *
+ * Each read from a GVfs stream may be a round trip to a
+ * remote server, e.g. for smb://, sftp://, and mtp://,
+ * so the file is wrapped in a CachedFile.
+ *
+ * @param uri GVfs URI.
+ * @return IRpFile. (Check isOpen() to determine if the file was opened.)
+ */
+IRpFile *RpFileGio::openCached(const char *uri)
+{
+	RpFileGio *const file = new RpFileGio(uri);
+	if (!file->isOpen()) {
+		// Unable to open the file.
+		// Return it as-is so the caller can check the error.
+		return file;
+	}
+
+	CachedFile *const cachedFile = new CachedFile(file);
+	file->unref();	// file is ref()'d by CachedFile.
+	return cachedFile;
+}
+
 RpFileGio::~RpFileGio()
 {
 	delete d_ptr;
@@ -191,6 +220,22 @@ size_t RpFileGio::read(void *ptr, size_t size)
 	return ret;
 }
 
+/**
+ * Read data from multiple file positions.
+ * Nearby requests are coalesced into a single read.
+ *
+ * NOTE: The file position is undefined afterwards.
+ *
+ * @param vec	[in] Read requests.
+ * @param count	[in] Number of read requests.
+ * @return 0 if all requests were read completely; negative POSIX error code on error.
+ */
+int RpFileGio::readv(const ReadVec *vec, size_t count)
+{
+	// GIO streams may be network files, so use a larger gap.
+	return readv_coalesced(vec, count, 64*1024);
+}
+
 /**
  * Write data to the file.
  * (NOTE: Not valid for RpMemFile; this will always return 0.)
@@ -37,7 +37,7 @@ gboolean rp_gtk3_is_uri_supported(const gchar *uri)
 		g_free(filename);
 	} else {
 		// Not a local file. Use RpFileGio.
-		file = new RpFileGio(uri);
+		file = RpFileGio::openCached(uri);
 	}
 
 	// Open the ROM file.
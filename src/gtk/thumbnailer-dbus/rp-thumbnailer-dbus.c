@@ -12,15 +12,20 @@
  */
 
 #include "rp-thumbnailer-dbus.h"
+#include "rp-thumbnailer-workers.h"
 #include "common.h"
 
 #include <glib-object.h>
 #include "SpecializedThumbnailer1.h"
 
 // C includes.
+#include <sys/stat.h>
+#include <errno.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 // from tumbler-utils.h
 #define g_dbus_async_return_val_if_fail(expr, invocation, val) \
@@ -52,12 +57,19 @@ enum RpThumbnailerProperties {
 	PROP_CONNECTION,
 	PROP_CACHE_DIR,
 	PROP_PFN_RP_CREATE_THUMBNAIL,
+	PROP_PFN_RP_CREATE_THUMBNAIL_ASYNC,
+	PROP_PFN_RP_GET_STATS,
+	PROP_PFN_RP_SET_CANCEL_FLAG,
+	PROP_WORKER_POOL,
+	PROP_MAX_THREADS,
 	PROP_EXPORTED,
 
 	PROP_LAST
 };
 static GParamSpec *properties[PROP_LAST];
 
+struct request_info;
+
 // Internal functions.
 static void	rp_thumbnailer_constructed	(GObject	*object);
 static void	rp_thumbnailer_dispose		(GObject	*object);
@@ -73,7 +85,20 @@ static void	rp_thumbnailer_set_property	(GObject	*object,
 						 GParamSpec	*pspec);
 
 static gboolean	rp_thumbnailer_timeout		(RpThumbnailer	*thumbnailer);
-static gboolean	rp_thumbnailer_process		(RpThumbnailer	*thumbnailer);
+static void	rp_thumbnailer_process		(gpointer	 data,
+						 gpointer	 user_data);
+static gboolean	rp_thumbnailer_process_done	(gpointer	 data);
+static void	rp_thumbnailer_enqueue		(RpThumbnailer	*thumbnailer,
+						 struct request_info *req);
+static void	rp_thumbnailer_dispatch		(RpThumbnailer	*thumbnailer);
+
+static void	rp_thumbnailer_async_ready	(const char	*source_file,
+						 const char	*output_file,
+						 int		 err,
+						 void		*userdata);
+static gboolean	rp_thumbnailer_async_ready_idle	(gpointer	 userdata);
+
+static void	rp_thumbnailer_update_stats	(RpThumbnailer	*thumbnailer);
 
 // D-Bus methods.
 static gboolean	rp_thumbnailer_queue		(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
@@ -87,6 +112,12 @@ static gboolean	rp_thumbnailer_dequeue		(OrgFreedesktopThumbnailsSpecializedThum
 						 GDBusMethodInvocation *invocation,
 						 guint32	 handle,
 						 RpThumbnailer	*thumbnailer);
+static gboolean	rp_thumbnailer_create_thumbnail	(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
+						 GDBusMethodInvocation *invocation,
+						 const gchar	*source_file,
+						 const gchar	*output_file,
+						 gint		 maximum_size,
+						 RpThumbnailer	*thumbnailer);
 
 struct _RpThumbnailerClass {
 	GObjectClass __parent__;
@@ -95,12 +126,59 @@ struct _RpThumbnailerClass {
 
 #define SHUTDOWN_TIMEOUT_SECONDS 30
 
+// Background requests that have been waiting this long
+// are processed like foreground requests.
+#define AGING_TIMEOUT_SECONDS 5
+
 // Thumbnail request information.
 struct request_info {
+	RpThumbnailer *thumbnailer;	// ref()'d
 	gchar *uri;
-	guint32 handle;
+	gchar *key;	// Key in RpThumbnailer::pending: "flavor:uri" (NULL for CreateThumbnail)
+	guint32 handle;	// First handle.
 	bool large;	// False for 'normal' (128x128); true for 'large' (256x256)
 	bool urgent;	// 'urgent' value
+
+	// Handles for this request. (guint32)
+	// Duplicate requests for the same URI and flavor are
+	// coalesced into a single request with multiple handles.
+	// NOTE: Only accessed from the main thread.
+	GArray *handles;
+
+	// Link in RpThumbnailer::queue_fg or queue_bg,
+	// depending on 'urgent'. (NULL if not queued)
+	// NOTE: Only accessed from the main thread.
+	GList *link;
+	gint64 queued_time;	// g_get_monotonic_time() when queued
+	bool dispatched;	// Pushed to the worker thread pool
+	bool dispatched_bg;	// Dispatched from queue_bg
+
+	// Set by Dequeue(). (atomic)
+	// If set, the worker thread skips the request,
+	// and no signals are emitted for it. If the request
+	// is already running in-process, it's also passed to
+	// rp_set_cancel_flag() so thumbnailing stops early.
+	gint cancelled;
+
+	// CreateThumbnail() request. (NULL for Queue() requests)
+	// The result is returned directly to the caller, and
+	// no signals are emitted.
+	GDBusMethodInvocation *invocation;
+	gchar *output_file;
+	int maximum_size;
+
+	// Result. (set by the worker thread)
+	const char *err_msg;	// Error message, or NULL on success.
+	int err_code;		// Error code for the Error signal.
+	bool err_uri;		// If false, the Error signal has an empty URI.
+};
+
+// Asynchronous thumbnail information.
+// Used if an external image is downloaded in the background.
+struct async_info {
+	RpThumbnailer *thumbnailer;	// ref()'d
+	gchar *uri;
+	int err;	// rp_create_thumbnail_async() callback error code
 };
 
 struct _RpThumbnailer {
@@ -113,14 +191,43 @@ struct _RpThumbnailer {
 	// Shutdown timeout.
 	guint timeout_id;
 
-	// Idle function for processing.
-	guint idle_process;
+	// Worker thread pool.
+	GThreadPool *pool;
 
 	// Last handle value.
 	guint32 last_handle;
 
-	// Request queue.
-	GQueue request_queue;	// element is struct request_info*
+	// Requests that are queued or being processed.
+	// key: handle; value: struct request_info*
+	// NOTE: Only accessed from the main thread.
+	GHashTable *requests;
+
+	// Requests that haven't been dequeued, indexed by URI and flavor.
+	// key: "flavor:uri" (owned by request_info); value: struct request_info*
+	// NOTE: Only accessed from the main thread.
+	GHashTable *pending;
+
+	// Number of request_info objects that haven't finished yet.
+	// NOTE: Only accessed from the main thread.
+	guint req_count;
+
+	// Requests waiting for a worker thread.
+	// Requests are only pushed to the worker thread pool when
+	// a thread is free, so foreground ('urgent') requests can
+	// be started ahead of background requests queued earlier.
+	// NOTE: Only accessed from the main thread.
+	GQueue queue_fg;
+	GQueue queue_bg;
+
+	// Number of requests in the worker thread pool,
+	// and how many of them came from queue_bg.
+	// NOTE: Only accessed from the main thread.
+	guint running;
+	guint running_bg;
+	guint max_running;
+
+	// Number of thumbnails waiting for background downloads. (atomic)
+	gint async_pending;
 
 	/** Properties. **/
 
@@ -133,6 +240,21 @@ struct _RpThumbnailer {
 	// rp_create_thumbnail() function pointer.
 	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail;
 
+	// rp_create_thumbnail_async() function pointer. (optional)
+	PFN_RP_CREATE_THUMBNAIL_ASYNC pfn_rp_create_thumbnail_async;
+
+	// rp_get_stats() function pointer. (optional)
+	PFN_RP_GET_STATS pfn_rp_get_stats;
+
+	// rp_set_cancel_flag() function pointer. (optional)
+	PFN_RP_SET_CANCEL_FLAG pfn_rp_set_cancel_flag;
+
+	// Worker process pool. (optional; not owned by RpThumbnailer)
+	RpWorkerPool *worker_pool;
+
+	// Maximum number of worker threads. (0 for the number of CPUs)
+	guint max_threads;
+
 	// Is the D-Bus object exported?
 	bool exported;
 };
@@ -211,6 +333,27 @@ rp_thumbnailer_class_init(RpThumbnailerClass *klass, gpointer class_data)
 		"pfn_rp_create_thumbnail", "pfn_rp_create_thumbnail", "rp_create_thumbnail() function pointer.",
 		G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_CONSTRUCT_ONLY);
 
+	properties[PROP_PFN_RP_CREATE_THUMBNAIL_ASYNC] = g_param_spec_pointer(
+		"pfn_rp_create_thumbnail_async", "pfn_rp_create_thumbnail_async", "rp_create_thumbnail_async() function pointer.",
+		G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_CONSTRUCT_ONLY);
+
+	properties[PROP_PFN_RP_GET_STATS] = g_param_spec_pointer(
+		"pfn_rp_get_stats", "pfn_rp_get_stats", "rp_get_stats() function pointer.",
+		G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_CONSTRUCT_ONLY);
+
+	properties[PROP_PFN_RP_SET_CANCEL_FLAG] = g_param_spec_pointer(
+		"pfn_rp_set_cancel_flag", "pfn_rp_set_cancel_flag", "rp_set_cancel_flag() function pointer.",
+		G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_CONSTRUCT_ONLY);
+
+	properties[PROP_WORKER_POOL] = g_param_spec_pointer(
+		"worker_pool", "worker_pool", "Worker process pool. (NULL to thumbnail in-process)",
+		G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_CONSTRUCT_ONLY);
+
+	properties[PROP_MAX_THREADS] = g_param_spec_uint(
+		"max_threads", "max_threads", "Maximum number of worker threads. (0 for the number of CPUs)",
+		0, 256, 0,
+		G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_CONSTRUCT_ONLY);
+
 	properties[PROP_EXPORTED] = g_param_spec_boolean(
 		"exported", "exported", "Is the D-Bus object exported?",
 		false,
@@ -236,6 +379,28 @@ rp_thumbnailer_constructed(GObject *object)
 	RpThumbnailer *const thumbnailer = RP_THUMBNAILER(object);
 
 	GError *error = NULL;
+	thumbnailer->requests = g_hash_table_new(NULL, NULL);
+	thumbnailer->pending = g_hash_table_new(g_str_hash, g_str_equal);
+
+	// Create the worker thread pool.
+	// If worker processes are in use, there's one thread per worker.
+	guint max_threads = thumbnailer->max_threads;
+	if (thumbnailer->worker_pool) {
+		max_threads = rp_worker_pool_get_count(thumbnailer->worker_pool);
+	} else if (max_threads == 0) {
+		const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+		max_threads = (ncpu > 0 ? (guint)ncpu : 1);
+	}
+	thumbnailer->pool = g_thread_pool_new(rp_thumbnailer_process, thumbnailer,
+		(gint)max_threads, FALSE, &error);
+	if (error) {
+		g_critical("Error creating the thumbnailer thread pool: %s", error->message);
+		g_error_free(error);
+		thumbnailer->exported = false;
+		return;
+	}
+	thumbnailer->max_running = max_threads;
+
 	thumbnailer->skeleton = org_freedesktop_thumbnails_specialized_thumbnailer1_skeleton_new();
 	g_dbus_interface_skeleton_export(G_DBUS_INTERFACE_SKELETON(thumbnailer->skeleton),
 		thumbnailer->connection, "/com/gerbilsoft/rom_properties/SpecializedThumbnailer1", &error);
@@ -251,6 +416,11 @@ rp_thumbnailer_constructed(GObject *object)
 			G_CALLBACK(rp_thumbnailer_queue), thumbnailer);
 	g_signal_connect(thumbnailer->skeleton, "handle-dequeue",
 		G_CALLBACK(rp_thumbnailer_dequeue), thumbnailer);
+	g_signal_connect(thumbnailer->skeleton, "handle-create-thumbnail",
+		G_CALLBACK(rp_thumbnailer_create_thumbnail), thumbnailer);
+
+	// Initial statistics.
+	rp_thumbnailer_update_stats(thumbnailer);
 		
 	// Make sure we shut down after inactivity.
 	thumbnailer->timeout_id = g_timeout_add_seconds(SHUTDOWN_TIMEOUT_SECONDS,
@@ -272,12 +442,6 @@ rp_thumbnailer_dispose(GObject *object)
 		thumbnailer->timeout_id = 0;
 	}
 
-	// Unregister idle_process.
-	if (G_UNLIKELY(thumbnailer->idle_process != 0)) {
-		g_source_remove(thumbnailer->idle_process);
-		thumbnailer->idle_process = 0;
-	}
-
 	// No longer exported.
 	thumbnailer->exported = false;
 
@@ -294,15 +458,17 @@ rp_thumbnailer_finalize(GObject *object)
 		g_object_unref(thumbnailer->skeleton);
 	}
 
-	// Delete any remaining requests and free the queue.
-	for (GList *p = thumbnailer->request_queue.head; p != NULL; p = p->next) {
-		if (p->data) {
-			struct request_info *const req = (struct request_info*)p->data;
-			g_free(req->uri);
-			g_free(req);
-		}
+	// NOTE: Each request holds a reference to the RpThumbnailer,
+	// so all requests have been processed at this point.
+	if (thumbnailer->pool) {
+		g_thread_pool_free(thumbnailer->pool, TRUE, TRUE);
+	}
+	if (thumbnailer->requests) {
+		g_hash_table_destroy(thumbnailer->requests);
+	}
+	if (thumbnailer->pending) {
+		g_hash_table_destroy(thumbnailer->pending);
 	}
-	g_queue_clear(&thumbnailer->request_queue);
 
 	/** Properties. **/
 	g_free(thumbnailer->cache_dir);
@@ -335,6 +501,21 @@ rp_thumbnailer_get_property(GObject *object,
 		case PROP_PFN_RP_CREATE_THUMBNAIL:
 			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_create_thumbnail);
 			break;
+		case PROP_PFN_RP_CREATE_THUMBNAIL_ASYNC:
+			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_create_thumbnail_async);
+			break;
+		case PROP_PFN_RP_GET_STATS:
+			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_get_stats);
+			break;
+		case PROP_PFN_RP_SET_CANCEL_FLAG:
+			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_set_cancel_flag);
+			break;
+		case PROP_WORKER_POOL:
+			g_value_set_pointer(value, thumbnailer->worker_pool);
+			break;
+		case PROP_MAX_THREADS:
+			g_value_set_uint(value, thumbnailer->max_threads);
+			break;
 		case PROP_EXPORTED:
 			g_value_set_boolean(value, thumbnailer->exported);
 			break;
@@ -382,6 +563,29 @@ rp_thumbnailer_set_property(GObject *object,
 				(PFN_RP_CREATE_THUMBNAIL)g_value_get_pointer(value);
 			break;
 
+		case PROP_PFN_RP_CREATE_THUMBNAIL_ASYNC:
+			thumbnailer->pfn_rp_create_thumbnail_async =
+				(PFN_RP_CREATE_THUMBNAIL_ASYNC)g_value_get_pointer(value);
+			break;
+
+		case PROP_PFN_RP_GET_STATS:
+			thumbnailer->pfn_rp_get_stats =
+				(PFN_RP_GET_STATS)g_value_get_pointer(value);
+			break;
+
+		case PROP_PFN_RP_SET_CANCEL_FLAG:
+			thumbnailer->pfn_rp_set_cancel_flag =
+				(PFN_RP_SET_CANCEL_FLAG)g_value_get_pointer(value);
+			break;
+
+		case PROP_WORKER_POOL:
+			thumbnailer->worker_pool = (RpWorkerPool*)g_value_get_pointer(value);
+			break;
+
+		case PROP_MAX_THREADS:
+			thumbnailer->max_threads = g_value_get_uint(value);
+			break;
+
 		case PROP_EXPORTED:
 			// FIXME: Read-only property.
 			// Need to show some error message...
@@ -437,21 +641,49 @@ rp_thumbnailer_queue(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
 		handle = ++thumbnailer->last_handle;
 	}
 
-	// Add the URI to the queue.
 	// NOTE: Currently handling all flavors that aren't "large" as "normal".
-	struct request_info *const req = g_malloc(sizeof(struct request_info));
+	const bool large = flavor && (g_ascii_strcasecmp(flavor, "large") == 0);
+	gchar *const key = g_strdup_printf("%s:%s", (large ? "large" : "normal"), uri);
+
+	// If the same URI and flavor is already queued or being
+	// processed, add this handle to the existing request.
+	struct request_info *req = (struct request_info*)g_hash_table_lookup(
+		thumbnailer->pending, key);
+	if (req) {
+		g_free(key);
+		g_array_append_val(req->handles, handle);
+		g_hash_table_insert(thumbnailer->requests, GUINT_TO_POINTER(handle), req);
+
+		if (urgent && !req->urgent && req->link) {
+			// The file was queued by a background prefetch,
+			// but it's visible now. Move it to the foreground queue.
+			g_queue_unlink(&thumbnailer->queue_bg, req->link);
+			g_queue_push_tail_link(&thumbnailer->queue_fg, req->link);
+			req->urgent = true;
+			rp_thumbnailer_dispatch(thumbnailer);
+		}
+
+		org_freedesktop_thumbnails_specialized_thumbnailer1_complete_queue(skeleton, invocation, handle);
+		return true;
+	}
+
+	// Add the URI to the queue.
+	req = g_malloc0(sizeof(struct request_info));
+	req->thumbnailer = g_object_ref(thumbnailer);
 	req->uri = g_strdup(uri);
+	req->key = key;
 	req->handle = handle;
-	req->large = flavor && (g_ascii_strcasecmp(flavor, "large") == 0);
+	req->large = large;
 	req->urgent = urgent;
-	// TODO Put 'urgent' requests at the front of the queue?
-	g_queue_push_tail(&thumbnailer->request_queue, req);
+	req->handles = g_array_new(FALSE, FALSE, sizeof(guint32));
+	g_array_append_val(req->handles, handle);
+	g_hash_table_insert(thumbnailer->requests, GUINT_TO_POINTER(handle), req);
+	g_hash_table_insert(thumbnailer->pending, req->key, req);
+	thumbnailer->req_count++;
 
-	// Make sure the idle process is started.
-	// TODO: Make it multi-threaded? (needs atomic compare and/or mutex...)
-	if (thumbnailer->idle_process == 0) {
-		thumbnailer->idle_process = g_idle_add((GSourceFunc)rp_thumbnailer_process, thumbnailer);
-	}
+	// Process the request in the worker thread pool.
+	// 'urgent' requests are processed first.
+	rp_thumbnailer_enqueue(thumbnailer, req);
 
 	org_freedesktop_thumbnails_specialized_thumbnailer1_complete_queue(skeleton, invocation, handle);
 	return true;
@@ -474,11 +706,185 @@ rp_thumbnailer_dequeue(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton
 	g_dbus_async_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), invocation, false);
 	g_dbus_async_return_val_if_fail(handle != 0, invocation, false);
 
-	// TODO
+	// Remove the handle from its request.
+	// If no other handles are waiting for the request, it's cancelled:
+	// if it's still queued, it's dropped immediately, and if it's
+	// currently being processed, it stops early if possible, and
+	// the result is discarded.
+	struct request_info *const req = (struct request_info*)g_hash_table_lookup(
+		thumbnailer->requests, GUINT_TO_POINTER(handle));
+	if (req) {
+		g_hash_table_remove(thumbnailer->requests, GUINT_TO_POINTER(handle));
+		for (guint i = 0; i < req->handles->len; i++) {
+			if (g_array_index(req->handles, guint32, i) == handle) {
+				g_array_remove_index(req->handles, i);
+				break;
+			}
+		}
+
+		if (req->handles->len == 0) {
+			g_atomic_int_set(&req->cancelled, 1);
+			// New requests for this URI need a new request_info.
+			g_hash_table_remove(thumbnailer->pending, req->key);
+
+			if (req->link) {
+				// Request hasn't been dispatched yet.
+				// Drop it now so it doesn't take up a worker thread.
+				g_queue_delete_link((req->urgent ? &thumbnailer->queue_fg : &thumbnailer->queue_bg), req->link);
+				req->link = NULL;
+				rp_thumbnailer_process_done(req);
+			}
+		}
+	}
+
 	org_freedesktop_thumbnails_specialized_thumbnailer1_complete_dequeue(skeleton, invocation);
 	return true;
 }
 
+/**
+ * Check if a directory is the specified root directory or a subdirectory of it.
+ * @param real_dir	[in] Directory. (must be canonicalized)
+ * @param root		[in] Root directory.
+ * @return True if real_dir is within root; false if not.
+ */
+static bool
+rp_thumbnailer_is_dir_within(const char *real_dir, const char *root)
+{
+	if (!root || root[0] == '\0') {
+		return false;
+	}
+
+	char *const real_root = realpath(root, NULL);
+	if (!real_root) {
+		return false;
+	}
+	const size_t len = strlen(real_root);
+	const bool ret = (strncmp(real_dir, real_root, len) == 0 &&
+	                  (real_dir[len] == '\0' || real_dir[len] == '/'));
+	free(real_root);
+	return ret;
+}
+
+/**
+ * Check if CreateThumbnail() is allowed to write to the specified output file.
+ *
+ * Any client on the session bus can call CreateThumbnail(), so the
+ * output file is restricted to the temporary directory and the
+ * thumbnail cache. Otherwise, it could be used to overwrite arbitrary
+ * files owned by the user.
+ *
+ * @param thumbnailer	[in] RpThumbnailer object.
+ * @param output_file	[in] Output file.
+ * @return True if the output file is allowed; false if not.
+ */
+static bool
+rp_thumbnailer_is_output_file_allowed(const RpThumbnailer *thumbnailer, const gchar *output_file)
+{
+	if (output_file[0] != '/') {
+		// Must be an absolute path.
+		return false;
+	}
+
+	gchar *const dirname = g_path_get_dirname(output_file);
+	char *const real_dir = realpath(dirname, NULL);
+	g_free(dirname);
+	if (!real_dir) {
+		return false;
+	}
+
+	bool ret = rp_thumbnailer_is_dir_within(real_dir, g_get_tmp_dir());
+	if (!ret && thumbnailer->cache_dir && thumbnailer->cache_dir[0] != '\0') {
+		gchar *const thumbnail_dir = g_build_filename(thumbnailer->cache_dir, "thumbnails", NULL);
+		ret = rp_thumbnailer_is_dir_within(real_dir, thumbnail_dir);
+		g_free(thumbnail_dir);
+	}
+	free(real_dir);
+	if (!ret) {
+		return false;
+	}
+
+	// If the output file already exists, it must be a regular file.
+	// Symlinks aren't followed, since they could point anywhere.
+	struct stat sb;
+	if (lstat(output_file, &sb) == 0 && !S_ISREG(sb.st_mode)) {
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Create a thumbnail synchronously. (rom-properties extension)
+ * The thumbnail is created in the worker thread pool, and the
+ * method returns once it's done.
+ * @param skeleton	[in] GDBusObjectSkeleton
+ * @param invocation	[in/out] GDBusMethodInvocation
+ * @param source_file	[in] Source file.
+ * @param output_file	[in] Output file.
+ * @param maximum_size	[in] Maximum thumbnail size.
+ * @param thumbnailer	[in] RpThumbnailer object.
+ * @return True if the signal was handled; false if not.
+ */
+static gboolean
+rp_thumbnailer_create_thumbnail(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
+	GDBusMethodInvocation *invocation,
+	const gchar *source_file, const gchar *output_file,
+	gint maximum_size,
+	RpThumbnailer *thumbnailer)
+{
+	RP_UNUSED(skeleton);
+	g_dbus_async_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), invocation, false);
+	g_dbus_async_return_val_if_fail(source_file != NULL && source_file[0] != 0, invocation, false);
+	g_dbus_async_return_val_if_fail(output_file != NULL && output_file[0] != 0, invocation, false);
+
+	if (G_UNLIKELY(thumbnailer->shutdown_emitted)) {
+		// The shutdown signal was emitted.
+		// Can't queue anything else.
+		g_dbus_method_invocation_return_error(invocation,
+			G_DBUS_ERROR, G_DBUS_ERROR_NO_SERVER, "Service is shutting down.");
+		return true;
+	}
+	if (maximum_size <= 0 || maximum_size > 32768) {
+		g_dbus_method_invocation_return_error(invocation,
+			G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "Invalid maximum size.");
+		return true;
+	}
+	if (!rp_thumbnailer_is_output_file_allowed(thumbnailer, output_file)) {
+		g_dbus_method_invocation_return_error(invocation,
+			G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED,
+			"Output file must be in the temporary directory or the thumbnail cache.");
+		return true;
+	}
+
+	// Stop the inactivity timeout.
+	if (G_LIKELY(thumbnailer->timeout_id != 0)) {
+		g_source_remove(thumbnailer->timeout_id);
+		thumbnailer->timeout_id = 0;
+	}
+
+	// CreateThumbnail() requests can't be dequeued,
+	// so the handle isn't added to RpThumbnailer::requests.
+	guint32 handle = ++thumbnailer->last_handle;
+	if (G_UNLIKELY(handle == 0)) {
+		handle = ++thumbnailer->last_handle;
+	}
+
+	// The caller is blocked waiting for the result,
+	// so the request is always treated as 'urgent'.
+	struct request_info *const req = g_malloc0(sizeof(struct request_info));
+	req->thumbnailer = g_object_ref(thumbnailer);
+	req->uri = g_strdup(source_file);
+	req->handle = handle;
+	req->urgent = true;
+	req->handles = g_array_new(FALSE, FALSE, sizeof(guint32));
+	req->invocation = invocation;
+	req->output_file = g_strdup(output_file);
+	req->maximum_size = maximum_size;
+	thumbnailer->req_count++;
+
+	rp_thumbnailer_enqueue(thumbnailer, req);
+	return true;
+}
+
 /**
  * Inactivity timeout has elapsed.
  * @param thumbnailer RpThumbnailer object.
@@ -487,7 +893,9 @@ static gboolean
 rp_thumbnailer_timeout(RpThumbnailer *thumbnailer)
 {
 	g_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), false);
-	if (!g_queue_is_empty(&thumbnailer->request_queue)) {
+	if (thumbnailer->req_count > 0 ||
+	    g_atomic_int_get(&thumbnailer->async_pending) > 0)
+	{
 		// Still processing stuff.
 		return true;
 	}
@@ -501,45 +909,128 @@ rp_thumbnailer_timeout(RpThumbnailer *thumbnailer)
 	return false;
 }
 
+/**
+ * Add a request to the foreground or background queue.
+ * 'urgent' requests go in the foreground queue.
+ * @param thumbnailer RpThumbnailer
+ * @param req struct request_info
+ */
+static void
+rp_thumbnailer_enqueue(RpThumbnailer *thumbnailer, struct request_info *req)
+{
+	GQueue *const queue = (req->urgent ? &thumbnailer->queue_fg : &thumbnailer->queue_bg);
+	req->queued_time = g_get_monotonic_time();
+	g_queue_push_tail(queue, req);
+	req->link = g_queue_peek_tail_link(queue);
+	rp_thumbnailer_dispatch(thumbnailer);
+}
+
+/**
+ * Push queued requests to the worker thread pool while threads are free.
+ *
+ * Foreground requests are started first. Background requests that
+ * have been waiting for AGING_TIMEOUT_SECONDS are treated like
+ * foreground requests, so they aren't starved. If there are more
+ * than two threads, background requests can't use the last one,
+ * so a newly-visible file can start right away.
+ *
+ * @param thumbnailer RpThumbnailer
+ */
+static void
+rp_thumbnailer_dispatch(RpThumbnailer *thumbnailer)
+{
+	const gint64 now = g_get_monotonic_time();
+	const guint max_bg = (thumbnailer->max_running > 2
+		? thumbnailer->max_running - 1
+		: thumbnailer->max_running);
+
+	while (thumbnailer->running < thumbnailer->max_running) {
+		struct request_info *const fg = (struct request_info*)g_queue_peek_head(&thumbnailer->queue_fg);
+		struct request_info *const bg = (struct request_info*)g_queue_peek_head(&thumbnailer->queue_bg);
+		struct request_info *req;
+
+		if (bg && (now - bg->queued_time) >= (gint64)AGING_TIMEOUT_SECONDS * G_USEC_PER_SEC &&
+		    (!fg || bg->queued_time < fg->queued_time))
+		{
+			// Background request has been waiting too long.
+			req = bg;
+		} else if (fg) {
+			req = fg;
+		} else if (bg && thumbnailer->running_bg < max_bg) {
+			req = bg;
+		} else {
+			// Nothing to dispatch.
+			break;
+		}
+
+		if (req == bg) {
+			g_queue_pop_head(&thumbnailer->queue_bg);
+			thumbnailer->running_bg++;
+			req->dispatched_bg = true;
+		} else {
+			g_queue_pop_head(&thumbnailer->queue_fg);
+		}
+		req->link = NULL;
+		req->dispatched = true;
+		thumbnailer->running++;
+		g_thread_pool_push(thumbnailer->pool, req, NULL);
+	}
+}
+
 /**
  * Process a thumbnail.
- * @param thumbnailer RpThumbnailer object.
+ * This is run in a worker thread.
+ * @param data struct request_info
+ * @param user_data RpThumbnailer object.
  */
-static gboolean
-rp_thumbnailer_process(RpThumbnailer *thumbnailer)
+static void
+rp_thumbnailer_process(gpointer data, gpointer user_data)
 {
-	g_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), FALSE);
+	struct request_info *const req = (struct request_info*)data;
+	RpThumbnailer *const thumbnailer = RP_THUMBNAILER(user_data);
 
 	const gchar *md5_string;	// owned by md5 object
-	const struct request_info *req;	// request info from the map
 	gchar *cache_filename = NULL;	// cache filename (g_strdup_printf())
 	size_t cache_filename_sz;	// size of cache_filename
 	int pos, pos2;			// snprintf() position
 	int ret;
 
-	// Process one thumbnail.
-	req = (struct request_info*)g_queue_pop_head(&thumbnailer->request_queue);
-	if (req == NULL) {
-		// Nothing in the queue.
-		goto cleanup;
+	if (req->invocation) {
+		// CreateThumbnail() request.
+		// NOTE: g_dbus_method_invocation_return_value() is thread-safe.
+		if (thumbnailer->worker_pool) {
+			ret = rp_worker_pool_create_thumbnail(thumbnailer->worker_pool,
+				req->uri, req->output_file, req->maximum_size);
+		} else if (thumbnailer->pfn_rp_create_thumbnail) {
+			ret = thumbnailer->pfn_rp_create_thumbnail(req->uri, req->output_file, req->maximum_size);
+		} else {
+			ret = -ENOSYS;
+		}
+		g_debug("rom-properties thumbnail: %s -> %s [ret=%d]", req->uri, req->output_file, ret);
+		org_freedesktop_thumbnails_specialized_thumbnailer1_complete_create_thumbnail(
+			thumbnailer->skeleton, req->invocation, ret);
+		req->invocation = NULL;
+		goto finished;
+	}
+
+	if (g_atomic_int_get(&req->cancelled)) {
+		// Request was dequeued.
+		goto finished;
 	}
 
 	// NOTE: cache_dir and pfn_rp_create_thumbnail should NOT be NULL
 	// at this point, but we're checking it anyway.
 	if (!thumbnailer->cache_dir || thumbnailer->cache_dir[0] == 0) {
 		// No cache directory...
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, "",
-			0, "Thumbnail cache directory is empty.");
+		req->err_msg = "Thumbnail cache directory is empty.";
 		goto finished;
 	}
 	if (!thumbnailer->pfn_rp_create_thumbnail) {
 		// No thumbnailer function.
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, "",
-			0, "No thumbnailer function is available.");
+		req->err_msg = "No thumbnailer function is available.";
 		goto finished;
 	}
+	req->err_uri = true;
 
 	// TODO: Make sure the URI to thumbnail is not in the cache directory.
 
@@ -558,16 +1049,12 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 	// pos does NOT include the NULL terminator, so check >=.
 	if (pos < 0 || ((size_t)pos + 1 + 32 + 4) > cache_filename_sz) {
 		// Not enough memory.
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot snprintf() the thumbnail cache directory name.");
+		req->err_msg = "Cannot snprintf() the thumbnail cache directory name.";
 		goto finished;
 	}
 
 	if (g_mkdir_with_parents(cache_filename, 0777) != 0) {
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot mkdir() the thumbnail cache directory.");
+		req->err_msg = "Cannot mkdir() the thumbnail cache directory.";
 		goto finished;
 	}
 
@@ -575,9 +1062,7 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 	md5_string = g_compute_checksum_for_data(G_CHECKSUM_MD5, (const guchar*)req->uri, strlen(req->uri));
 	if (!md5_string) {
 		// Cannot compute the checksum...
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "g_compute_checksum_for_data() failed.");
+		req->err_msg = "g_compute_checksum_for_data() failed.";
 		goto finished;
 	}
 
@@ -586,54 +1071,212 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 	// pos and pos2 do NOT include the NULL terminator, so check >=.
 	if (pos2 < 0 || ((size_t)pos + (size_t)pos2) >= cache_filename_sz) {
 		// Not enough memory.
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot snprintf() the thumbnail filename.");
+		req->err_msg = "Cannot snprintf() the thumbnail filename.";
 		goto finished;
 	}
 
 	// Thumbnail the image.
-	ret = thumbnailer->pfn_rp_create_thumbnail(req->uri, cache_filename, req->large ? 256 : 128);
+	// If the request is dequeued while it's running in-process,
+	// thumbnailing stops early. (Worker processes can't see the flag.)
+	if (!thumbnailer->worker_pool && thumbnailer->pfn_rp_set_cancel_flag) {
+		thumbnailer->pfn_rp_set_cancel_flag((volatile int*)&req->cancelled);
+	}
+	if (thumbnailer->worker_pool) {
+		// Thumbnail the image in a sandboxed worker process.
+		// NOTE: Background downloads aren't used here, since
+		// the worker is reused as soon as this request is done.
+		ret = rp_worker_pool_create_thumbnail(thumbnailer->worker_pool,
+			req->uri, cache_filename, req->large ? 256 : 128);
+	} else if (thumbnailer->pfn_rp_create_thumbnail_async) {
+		// External images that aren't cached will be downloaded
+		// in the background. The callback is always called, so
+		// async_info is freed by rp_thumbnailer_async_ready_idle().
+		struct async_info *const info = g_malloc(sizeof(struct async_info));
+		info->thumbnailer = g_object_ref(thumbnailer);
+		info->uri = g_strdup(req->uri);
+		info->err = 0;
+		g_atomic_int_inc(&thumbnailer->async_pending);
+		ret = thumbnailer->pfn_rp_create_thumbnail_async(req->uri, cache_filename, req->large ? 256 : 128,
+			rp_thumbnailer_async_ready, info);
+	} else {
+		ret = thumbnailer->pfn_rp_create_thumbnail(req->uri, cache_filename, req->large ? 256 : 128);
+	}
+	if (!thumbnailer->worker_pool && thumbnailer->pfn_rp_set_cancel_flag) {
+		thumbnailer->pfn_rp_set_cancel_flag(NULL);
+	}
 	if (ret == 0) {
 		// Image thumbnailed successfully.
 		g_debug("rom-properties thumbnail: %s -> %s [OK]", req->uri, cache_filename);
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_ready(
-			thumbnailer->skeleton, req->handle, req->uri);
 	} else {
 		// Error thumbnailing the image...
 		g_debug("rom-properties thumbnail: %s -> %s [ERR=%d]", req->uri, cache_filename, ret);
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			2, "Image thumbnailing failed... (TODO: return code)");
+		switch (ret) {
+			case -ETIMEDOUT:
+				req->err_msg = "Thumbnailer worker timed out.";
+				break;
+			case -ECHILD:
+				req->err_msg = "Thumbnailer worker crashed.";
+				break;
+			default:
+				req->err_msg = "Image thumbnailing failed... (TODO: return code)";
+				break;
+		}
+		req->err_code = 2;
 	}
 
 finished:
-	// Request is finished. Emit the finished signal.
-	org_freedesktop_thumbnails_specialized_thumbnailer1_emit_finished(
-		thumbnailer->skeleton, req->handle);
-
-cleanup:
-	// Free allocated things.
 	g_free(cache_filename);
 
-	// req was allocated using g_malloc() before it was
-	// added to the queue. We'll need to free it here.
-	g_free((gpointer)req);
+	// Emit the signals on the main thread.
+	g_idle_add(rp_thumbnailer_process_done, req);
+}
+
+/**
+ * A thumbnail has been processed by a worker thread.
+ * This emits the signals and frees the request.
+ * Also called by Dequeue() for requests that were never dispatched.
+ * @param data struct request_info
+ * @return FALSE to remove the idle function.
+ */
+static gboolean
+rp_thumbnailer_process_done(gpointer data)
+{
+	struct request_info *const req = (struct request_info*)data;
+	RpThumbnailer *const thumbnailer = req->thumbnailer;
+
+	// Emit the signals for all handles that are waiting for this request.
+	// NOTE: If the request was cancelled, there are no handles left.
+	for (guint i = 0; i < req->handles->len; i++) {
+		const guint32 handle = g_array_index(req->handles, guint32, i);
+		if (!req->err_msg) {
+			org_freedesktop_thumbnails_specialized_thumbnailer1_emit_ready(
+				thumbnailer->skeleton, handle, req->uri);
+		} else {
+			org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
+				thumbnailer->skeleton, handle, (req->err_uri ? req->uri : ""),
+				req->err_code, req->err_msg);
+		}
 
-	// Return TRUE if we still have more thumbnails queued.
-	const bool isEmpty = g_queue_is_empty(&thumbnailer->request_queue);
-	if (isEmpty) {
-		// Clear the idle process.
-		// FIXME: Atomic compare and/or mutex? (assuming multi-threaded...)
-		thumbnailer->idle_process = 0;
+		// Request is finished. Emit the finished signal.
+		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_finished(
+			thumbnailer->skeleton, handle);
+		g_hash_table_remove(thumbnailer->requests, GUINT_TO_POINTER(handle));
+	}
 
+	if (req->key && !g_atomic_int_get(&req->cancelled)) {
+		g_hash_table_remove(thumbnailer->pending, req->key);
+	}
+	if (req->dispatched) {
+		// A worker thread is free now.
+		thumbnailer->running--;
+		if (req->dispatched_bg) {
+			thumbnailer->running_bg--;
+		}
+		rp_thumbnailer_dispatch(thumbnailer);
+	}
+	rp_thumbnailer_update_stats(thumbnailer);
+	thumbnailer->req_count--;
+	if (thumbnailer->req_count == 0) {
 		// Restart the inactivity timeout.
 		if (G_LIKELY(thumbnailer->timeout_id == 0)) {
 			thumbnailer->timeout_id = g_timeout_add_seconds(SHUTDOWN_TIMEOUT_SECONDS,
 				(GSourceFunc)rp_thumbnailer_timeout, thumbnailer);
 		}
 	}
-	return !isEmpty;
+
+	g_array_free(req->handles, TRUE);
+	g_free(req->key);
+	g_free(req->uri);
+	g_free(req->output_file);
+	g_free(req);
+	g_object_unref(thumbnailer);
+	return FALSE;
+}
+
+/**
+ * rp_create_thumbnail_async() callback.
+ * This may be called from a background thread, so the
+ * signals are emitted from an idle function.
+ * @param source_file	[in] Source file.
+ * @param output_file	[in] Output file.
+ * @param err		[in] 0 if the thumbnail was regenerated; non-zero on error.
+ * @param userdata	[in] struct async_info
+ */
+static void
+rp_thumbnailer_async_ready(const char *source_file, const char *output_file, int err, void *userdata)
+{
+	RP_UNUSED(source_file);
+	RP_UNUSED(output_file);
+
+	struct async_info *const info = (struct async_info*)userdata;
+	info->err = err;
+	g_idle_add(rp_thumbnailer_async_ready_idle, info);
+}
+
+/**
+ * Emit the signals for a thumbnail that was regenerated
+ * after downloading an external image.
+ * @param userdata struct async_info
+ * @return FALSE to remove the idle function.
+ */
+static gboolean
+rp_thumbnailer_async_ready_idle(gpointer userdata)
+{
+	struct async_info *const info = (struct async_info*)userdata;
+	RpThumbnailer *const thumbnailer = info->thumbnailer;
+
+	if (info->err == 0 && thumbnailer->exported && !thumbnailer->shutdown_emitted) {
+		// Thumbnail was regenerated with the external image.
+		// NOTE: Ready and Finished were already emitted for this
+		// handle, so they aren't emitted again; clients may have
+		// reused the handle number for another request. The
+		// thumbnail file in the cache directory was replaced,
+		// so clients that monitor it will reload it.
+		g_debug("rom-properties thumbnail: %s [external image downloaded]", info->uri);
+		rp_thumbnailer_update_stats(thumbnailer);
+	}
+
+	g_atomic_int_add(&thumbnailer->async_pending, -1);
+
+	g_object_unref(thumbnailer);
+	g_free(info->uri);
+	g_free(info);
+	return FALSE;
+}
+
+/**
+ * rp_get_stats() callback.
+ * Adds a counter to the GVariantBuilder.
+ * @param name Counter name.
+ * @param value Counter value.
+ * @param userdata GVariantBuilder
+ */
+static void
+rp_thumbnailer_stats_callback(const char *name, guint64 value, void *userdata)
+{
+	GVariantBuilder *const builder = (GVariantBuilder*)userdata;
+	g_variant_builder_add(builder, "{st}", name, value);
+}
+
+/**
+ * Update the Statistics D-Bus property.
+ * This is called from the main thread after requests are processed.
+ * The skeleton emits PropertiesChanged if the value changed.
+ * @param thumbnailer RpThumbnailer
+ */
+static void
+rp_thumbnailer_update_stats(RpThumbnailer *thumbnailer)
+{
+	if (!thumbnailer->pfn_rp_get_stats || !thumbnailer->skeleton) {
+		// Statistics aren't available.
+		return;
+	}
+
+	GVariantBuilder builder;
+	g_variant_builder_init(&builder, G_VARIANT_TYPE("a{st}"));
+	thumbnailer->pfn_rp_get_stats(rp_thumbnailer_stats_callback, &builder);
+	org_freedesktop_thumbnails_specialized_thumbnailer1_set_statistics(
+		thumbnailer->skeleton, g_variant_builder_end(&builder));
 }
 
 /**
@@ -641,17 +1284,32 @@ cleanup:
  * @param connection			[in] GDBusConnection
  * @param cache_dir			[in] Cache directory.
  * @param pfn_rp_create_thumbnail	[in] rp_create_thumbnail() function pointer.
+ * @param pfn_rp_create_thumbnail_async	[in,opt] rp_create_thumbnail_async() function pointer.
+ * @param pfn_rp_get_stats		[in,opt] rp_get_stats() function pointer.
+ * @param pfn_rp_set_cancel_flag	[in,opt] rp_set_cancel_flag() function pointer.
+ * @param worker_pool			[in,opt] Worker process pool. (must outlive the RpThumbnailer)
+ * @param max_threads			[in] Maximum number of worker threads. (0 for the number of CPUs)
  * @return RpThumbnailer object.
  */
 RpThumbnailer*
 rp_thumbnailer_new(GDBusConnection *connection,
 	const gchar *cache_dir,
-	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail)
+	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+	PFN_RP_CREATE_THUMBNAIL_ASYNC pfn_rp_create_thumbnail_async,
+	PFN_RP_GET_STATS pfn_rp_get_stats,
+	PFN_RP_SET_CANCEL_FLAG pfn_rp_set_cancel_flag,
+	RpWorkerPool *worker_pool,
+	guint max_threads)
 {
 	return g_object_new(TYPE_RP_THUMBNAILER,
 		"connection", connection,
 		"cache_dir", cache_dir,
 		"pfn_rp_create_thumbnail", pfn_rp_create_thumbnail,
+		"pfn_rp_create_thumbnail_async", pfn_rp_create_thumbnail_async,
+		"pfn_rp_get_stats", pfn_rp_get_stats,
+		"pfn_rp_set_cancel_flag", pfn_rp_set_cancel_flag,
+		"worker_pool", worker_pool,
+		"max_threads", max_threads,
 		NULL);
 }
 
@@ -23,6 +23,67 @@ G_BEGIN_DECLS
  */
 typedef int (*PFN_RP_CREATE_THUMBNAIL)(const char *source_file, const char *output_file, int maximum_size);
 
+/**
+ * rp_create_thumbnail_async() callback.
+ * This may be called from a background thread.
+ * @param source_file Source file. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param err 0 if the thumbnail was regenerated; non-zero on error.
+ * @param userdata User data.
+ */
+typedef void (*PFN_RP_THUMBNAIL_READY)(const char *source_file, const char *output_file, int err, void *userdata);
+
+/**
+ * rp_create_thumbnail_async() function pointer.
+ * @param source_file Source file. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param maximum_size Maximum size.
+ * @param pfnReady Callback for the regenerated thumbnail. (always called exactly once)
+ * @param userdata User data for the callback.
+ * @return 0 on success; non-zero on error.
+ */
+typedef int (*PFN_RP_CREATE_THUMBNAIL_ASYNC)(const char *source_file, const char *output_file, int maximum_size,
+	PFN_RP_THUMBNAIL_READY pfnReady, void *userdata);
+
+/**
+ * rp_get_stats() callback.
+ * @param name Counter name. (ASCII)
+ * @param value Counter value.
+ * @param userdata User data.
+ */
+typedef void (*PFN_RP_STATS_CALLBACK)(const char *name, guint64 value, void *userdata);
+
+/**
+ * rp_get_stats() function pointer.
+ * @param pfnCallback Callback, called once per counter.
+ * @param userdata User data for the callback.
+ */
+typedef void (*PFN_RP_GET_STATS)(PFN_RP_STATS_CALLBACK pfnCallback, void *userdata);
+
+/**
+ * rp_set_decode_threads() function pointer.
+ * @param count Number of threads. (0 for the number of CPUs; 1 to disable)
+ */
+typedef void (*PFN_RP_SET_DECODE_THREADS)(unsigned int count);
+
+/**
+ * rp_set_cancel_flag() function pointer.
+ * @param cancel_flag Cancellation flag, or NULL to clear it. (must remain valid until cleared)
+ */
+typedef void (*PFN_RP_SET_CANCEL_FLAG)(volatile int *cancel_flag);
+
+/**
+ * rp_start_download_daemon() function pointer.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+typedef int (*PFN_RP_START_DOWNLOAD_DAEMON)(void);
+
+/**
+ * Prefork worker process pool.
+ * See rp-thumbnailer-workers.h.
+ */
+typedef struct _RpWorkerPool		RpWorkerPool;
+
 typedef struct _RpThumbnailerClass	RpThumbnailerClass;
 typedef struct _RpThumbnailer		RpThumbnailer;
 
@@ -37,7 +98,12 @@ GType		rp_thumbnailer_get_type			(void) G_GNUC_CONST G_GNUC_INTERNAL;
 
 RpThumbnailer	*rp_thumbnailer_new			(GDBusConnection *connection,
 							 const gchar *cache_dir,
-							 PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail)
+							 PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+							 PFN_RP_CREATE_THUMBNAIL_ASYNC pfn_rp_create_thumbnail_async,
+							 PFN_RP_GET_STATS pfn_rp_get_stats,
+							 PFN_RP_SET_CANCEL_FLAG pfn_rp_set_cancel_flag,
+							 RpWorkerPool *worker_pool,
+							 guint max_threads)
 							G_GNUC_MALLOC G_GNUC_WARN_UNUSED_RESULT;
 
 gboolean	rp_thumbnailer_is_exported		(RpThumbnailer *thumbnailer);
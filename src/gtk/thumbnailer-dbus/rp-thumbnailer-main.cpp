@@ -10,6 +10,7 @@
 #include "libunixcommon/userdirs.hpp"
 #include "libunixcommon/dll-search.h"
 #include "rp-thumbnailer-dbus.h"
+#include "rp-thumbnailer-workers.h"
 
 // OS-specific security options.
 #include "rptsecure.h"
@@ -17,6 +18,7 @@
 // C includes. (C++ namespace)
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 
 // C++ includes.
 #include <string>
@@ -25,12 +27,18 @@ using std::string;
 // dlopen()
 #include <dlfcn.h>
 
+// sysconf()
+#include <unistd.h>
+
 // Shutdown request.
 static bool stop_main_loop = false;
 
 // Cache directory.
 static string cache_dir;
 
+// Worker process request timeout, in milliseconds.
+static const guint WORKER_TIMEOUT_MS = 30 * 1000;
+
 /**
  * Initialize the cache directory.
  * @return 0 on success; non-zero on error.
@@ -152,11 +160,91 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// rp_create_thumbnail_async() is optional.
+	// If available, external images are downloaded in the background.
+	PFN_RP_CREATE_THUMBNAIL_ASYNC pfn_rp_create_thumbnail_async =
+		(PFN_RP_CREATE_THUMBNAIL_ASYNC)dlsym(pDll, "rp_create_thumbnail_async");
+
+	// rp_get_stats() is optional.
+	// If available, runtime statistics are exposed via D-Bus.
+	PFN_RP_GET_STATS pfn_rp_get_stats =
+		(PFN_RP_GET_STATS)dlsym(pDll, "rp_get_stats");
+
+	// rp_set_cancel_flag() is optional.
+	// If available, dequeued requests stop early if they're already running.
+	PFN_RP_SET_CANCEL_FLAG pfn_rp_set_cancel_flag =
+		(PFN_RP_SET_CANCEL_FLAG)dlsym(pDll, "rp_set_cancel_flag");
+
+	// Number of worker threads.
+	// Defaults to the number of CPUs, but can be overridden
+	// by setting RP_THUMBNAILER_THREADS.
+	// NOTE: Ignored if worker processes are in use.
+	guint max_threads = 0;
+	const char *const threads_env = getenv("RP_THUMBNAILER_THREADS");
+	if (threads_env && threads_env[0] != '\0') {
+		char *endptr = nullptr;
+		const unsigned long val = strtoul(threads_env, &endptr, 10);
+		if (*endptr == '\0' && val <= 256) {
+			max_threads = static_cast<guint>(val);
+		} else {
+			g_warning("Invalid RP_THUMBNAILER_THREADS value: %s", threads_env);
+		}
+	}
+
+	// Worker processes.
+	// If RP_THUMBNAILER_WORKERS is set, each thumbnail is created
+	// in a sandboxed worker process instead of in this process.
+	guint worker_count = 0;
+	const char *const workers_env = getenv("RP_THUMBNAILER_WORKERS");
+	if (workers_env && workers_env[0] != '\0') {
+		char *endptr = nullptr;
+		const unsigned long val = strtoul(workers_env, &endptr, 10);
+		if (*endptr == '\0' && val <= 256) {
+			worker_count = static_cast<guint>(val);
+		} else {
+			g_warning("Invalid RP_THUMBNAILER_WORKERS value: %s", workers_env);
+		}
+	}
+
+	// rp_set_decode_threads() is optional.
+	// Each thumbnail request already runs on its own thread or worker
+	// process, so split the CPUs between the concurrent requests
+	// instead of letting each request decode with every CPU.
+	// NOTE: This must be set before the worker processes are forked.
+	PFN_RP_SET_DECODE_THREADS pfn_rp_set_decode_threads =
+		(PFN_RP_SET_DECODE_THREADS)dlsym(pDll, "rp_set_decode_threads");
+	if (pfn_rp_set_decode_threads) {
+		const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+		const guint cpus = (ncpu > 0 ? static_cast<guint>(ncpu) : 1);
+		guint concurrent = (worker_count > 0 ? worker_count : max_threads);
+		if (concurrent == 0 || concurrent > cpus) {
+			concurrent = cpus;
+		}
+		pfn_rp_set_decode_threads(cpus / concurrent);
+	}
+
+	// NOTE: The worker pool must be created before any threads are started.
+	RpWorkerPool *worker_pool = nullptr;
+	if (worker_count > 0) {
+		// rp_start_download_daemon() is required for worker processes,
+		// since they can't run rp-download once they're sandboxed.
+		PFN_RP_START_DOWNLOAD_DAEMON pfn_rp_start_download_daemon =
+			(PFN_RP_START_DOWNLOAD_DAEMON)dlsym(pDll, "rp_start_download_daemon");
+		if (pfn_rp_start_download_daemon) {
+			worker_pool = rp_worker_pool_new(worker_count,
+				WORKER_TIMEOUT_MS, pfn_rp_create_thumbnail,
+				pfn_rp_start_download_daemon);
+		} else {
+			g_warning("rom-properties plugin doesn't support worker processes; ignoring RP_THUMBNAILER_WORKERS.");
+		}
+	}
+
 	GError *error = nullptr;
 	GDBusConnection *const connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
 	if (error) {
 		g_critical("Unable to connect to the session bus: %s", error->message);
 		g_error_free(error);
+		rp_worker_pool_free(worker_pool);
 		dlclose(pDll);
 		return EXIT_FAILURE;
 	}
@@ -165,7 +253,9 @@ int main(int argc, char *argv[])
 
 	// Create the RpThumbnail service object.
 	RpThumbnailer *const thumbnailer = rp_thumbnailer_new(
-		connection, cache_dir.c_str(), pfn_rp_create_thumbnail);
+		connection, cache_dir.c_str(), pfn_rp_create_thumbnail,
+		pfn_rp_create_thumbnail_async, pfn_rp_get_stats,
+		pfn_rp_set_cancel_flag, worker_pool, max_threads);
 
 	// Register the D-Bus service.
 	g_bus_own_name_on_connection(connection,
@@ -184,6 +274,7 @@ int main(int argc, char *argv[])
 			g_main_loop_run(main_loop);
 		}
 	}
+	rp_worker_pool_free(worker_pool);
 	dlclose(pDll);
 	return 0;
 }
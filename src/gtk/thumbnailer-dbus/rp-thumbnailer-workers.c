@@ -0,0 +1,486 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (D-Bus Thumbnailer)                *
+ * rp-thumbnailer-workers.c: Prefork worker process pool.                  *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "rp-thumbnailer-workers.h"
+#include "common.h"
+
+// OS-specific security options.
+#include "rptsecure.h"
+
+// C includes.
+#include <errno.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+// POSIX includes.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+# include <sys/prctl.h>
+#endif /* __linux__ */
+
+// Maximum length of a filename or URI in a request, including the NULL terminator.
+#define SLOT_PATH_MAX 4096
+
+// Interval for checking if a busy worker is still alive, in milliseconds.
+#define WORKER_POLL_MS 100
+
+// Maximum amount of time to wait for the spawner to fork a worker, in milliseconds.
+#define SPAWN_TIMEOUT_MS 5000
+
+/**
+ * Worker slot.
+ * This is located in shared memory, and is shared by
+ * the main process, the spawner, and the worker.
+ */
+typedef struct _RpWorkerSlot {
+	sem_t req_sem;		// Posted by the main process when a request is ready.
+	sem_t done_sem;		// Posted by the worker when the result is ready.
+	sem_t spawned_sem;	// Posted by the spawner after forking a worker.
+
+	volatile pid_t pid;	// Worker PID. (0 if not running)
+
+	// Request.
+	int maximum_size;
+	char source_file[SLOT_PATH_MAX];
+	char output_file[SLOT_PATH_MAX];
+
+	// Result.
+	int result;
+} RpWorkerSlot;
+
+struct _RpWorkerPool {
+	RpWorkerSlot *slots;	// Shared memory. (mmap())
+	size_t slots_sz;	// Size of slots, in bytes.
+	guint count;		// Number of workers.
+	guint timeout_ms;	// Request timeout.
+
+	// Spawner process.
+	pid_t spawner_pid;
+	int spawner_fd;		// Socket for spawn requests.
+	GMutex spawner_mutex;	// Serializes spawn requests.
+
+	// Idle workers. (stack of slot indexes)
+	guint *idle;
+	guint idle_count;
+	GMutex idle_mutex;
+	GCond idle_cond;
+};
+
+/**
+ * Wait for a semaphore with a timeout.
+ * @param sem Semaphore.
+ * @param ms Timeout, in milliseconds.
+ * @return 0 on success; -ETIMEDOUT on timeout; other negative POSIX error code on error.
+ */
+static int
+rp_sem_timedwait_ms(sem_t *sem, guint ms)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec += ms / 1000;
+	ts.tv_nsec += (long)(ms % 1000) * 1000000L;
+	if (ts.tv_nsec >= 1000000000L) {
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+
+	while (sem_timedwait(sem, &ts) != 0) {
+		if (errno != EINTR) {
+			return -errno;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Make sure this process is killed if its parent process exits.
+ */
+static void
+rp_worker_set_pdeathsig(void)
+{
+#ifdef __linux__
+	const pid_t ppid = getppid();
+	prctl(PR_SET_PDEATHSIG, SIGKILL);
+	if (getppid() != ppid) {
+		// Parent process already exited.
+		_exit(EXIT_FAILURE);
+	}
+#endif /* __linux__ */
+}
+
+/**
+ * Worker process main loop.
+ * @param slot Worker slot.
+ * @param pfn_rp_create_thumbnail rp_create_thumbnail() function pointer.
+ */
+static void G_GNUC_NORETURN
+rp_worker_main(RpWorkerSlot *slot, PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail)
+{
+	rp_worker_set_pdeathsig();
+	signal(SIGCHLD, SIG_DFL);
+
+	// Enable security options.
+	// This only affects the worker; the main process is unchanged.
+	rpt_do_worker_security_options();
+
+	for (;;) {
+		if (sem_wait(&slot->req_sem) != 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		slot->result = pfn_rp_create_thumbnail(slot->source_file, slot->output_file, slot->maximum_size);
+		sem_post(&slot->done_sem);
+	}
+
+	_exit(EXIT_FAILURE);
+}
+
+/**
+ * Spawner process main loop.
+ * Forks a new worker for each slot index received on the socket.
+ * The spawner exits when the socket is closed by the main process.
+ * @param slots Worker slots.
+ * @param count Number of worker slots.
+ * @param fd Socket for spawn requests.
+ * @param pfn_rp_create_thumbnail rp_create_thumbnail() function pointer.
+ * @param pfn_rp_start_download_daemon rp_start_download_daemon() function pointer.
+ */
+static void G_GNUC_NORETURN
+rp_worker_spawner_main(RpWorkerSlot *slots, guint count, int fd,
+	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+	PFN_RP_START_DOWNLOAD_DAEMON pfn_rp_start_download_daemon)
+{
+	rp_worker_set_pdeathsig();
+
+	// Workers can't run rp-download once their security options
+	// are enabled, so start the rp-download daemon here. Workers
+	// inherit the daemon-only setting, and the daemon keeps running
+	// while the spawner is connected to it.
+	// NOTE: This must be done before SIGCHLD is ignored, since the
+	// daemon is started by a child process that must be waited for.
+	if (pfn_rp_start_download_daemon() != 0) {
+		// Not fatal; downloads will fail in the workers.
+		g_warning("Unable to start the rp-download daemon for the worker processes.");
+	}
+
+	// Workers are reaped automatically.
+	signal(SIGCHLD, SIG_IGN);
+
+	for (;;) {
+		guint idx;
+		const ssize_t sz = read(fd, &idx, sizeof(idx));
+		if (sz < 0 && errno == EINTR) {
+			continue;
+		} else if (sz != (ssize_t)sizeof(idx)) {
+			// Socket was closed, or an error occurred.
+			break;
+		} else if (idx >= count) {
+			// Invalid slot index.
+			continue;
+		}
+
+		RpWorkerSlot *const slot = &slots[idx];
+		const pid_t pid = fork();
+		if (pid == 0) {
+			// Worker process.
+			close(fd);
+			rp_worker_main(slot, pfn_rp_create_thumbnail);
+		}
+
+		slot->pid = (pid > 0 ? pid : 0);
+		sem_post(&slot->spawned_sem);
+	}
+
+	// NOTE: Workers are killed by PR_SET_PDEATHSIG.
+	_exit(EXIT_SUCCESS);
+}
+
+/**
+ * Kill a worker process and wait for it to exit.
+ * @param slot Worker slot.
+ */
+static void
+rp_worker_kill(RpWorkerSlot *slot)
+{
+	const pid_t pid = slot->pid;
+	if (pid <= 0)
+		return;
+
+	kill(pid, SIGKILL);
+
+	// The spawner reaps the worker, so poll until it's gone.
+	for (unsigned int i = 0; i < 100; i++) {
+		if (kill(pid, 0) != 0)
+			break;
+		g_usleep(10 * 1000);
+	}
+	slot->pid = 0;
+}
+
+/**
+ * Start a worker process for the specified slot.
+ * The caller must own the slot.
+ * @param pool Worker pool.
+ * @param idx Slot index.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int
+rp_worker_pool_spawn(RpWorkerPool *pool, guint idx)
+{
+	RpWorkerSlot *const slot = &pool->slots[idx];
+
+	// Reset the request semaphores, since the previous
+	// worker may have died while using them.
+	sem_destroy(&slot->req_sem);
+	sem_destroy(&slot->done_sem);
+	sem_init(&slot->req_sem, 1, 0);
+	sem_init(&slot->done_sem, 1, 0);
+	slot->pid = 0;
+
+	g_mutex_lock(&pool->spawner_mutex);
+	const ssize_t sz = send(pool->spawner_fd, &idx, sizeof(idx), MSG_NOSIGNAL);
+	g_mutex_unlock(&pool->spawner_mutex);
+	if (sz != (ssize_t)sizeof(idx)) {
+		// Spawner is gone.
+		return -EPIPE;
+	}
+
+	int ret = rp_sem_timedwait_ms(&slot->spawned_sem, SPAWN_TIMEOUT_MS);
+	if (ret != 0) {
+		return ret;
+	}
+	return (slot->pid > 0 ? 0 : -EAGAIN);
+}
+
+/**
+ * Create a worker pool.
+ *
+ * NOTE: This MUST be called before any threads are created,
+ * including GLib's D-Bus worker thread.
+ *
+ * @param count			[in] Number of worker processes. (1-256)
+ * @param timeout_ms		[in] Request timeout, in milliseconds.
+ * @param pfn_rp_create_thumbnail [in] rp_create_thumbnail() function pointer.
+ * @param pfn_rp_start_download_daemon [in] rp_start_download_daemon() function pointer.
+ * @return Worker pool, or NULL on error.
+ */
+RpWorkerPool*
+rp_worker_pool_new(guint count, guint timeout_ms, PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+	PFN_RP_START_DOWNLOAD_DAEMON pfn_rp_start_download_daemon)
+{
+	g_return_val_if_fail(count > 0 && count <= 256, NULL);
+	g_return_val_if_fail(pfn_rp_create_thumbnail != NULL, NULL);
+	g_return_val_if_fail(pfn_rp_start_download_daemon != NULL, NULL);
+
+	// Allocate the worker slots in shared memory.
+	const size_t slots_sz = count * sizeof(RpWorkerSlot);
+	RpWorkerSlot *const slots = mmap(NULL, slots_sz, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (slots == MAP_FAILED) {
+		g_critical("Unable to allocate shared memory for the worker pool: %s", strerror(errno));
+		return NULL;
+	}
+	for (guint i = 0; i < count; i++) {
+		sem_init(&slots[i].req_sem, 1, 0);
+		sem_init(&slots[i].done_sem, 1, 0);
+		sem_init(&slots[i].spawned_sem, 1, 0);
+		slots[i].pid = 0;
+	}
+
+	// Fork the spawner.
+	int fds[2];
+	if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+		g_critical("Unable to create the worker spawner socket: %s", strerror(errno));
+		munmap(slots, slots_sz);
+		return NULL;
+	}
+	const pid_t spawner_pid = fork();
+	if (spawner_pid < 0) {
+		g_critical("Unable to fork the worker spawner: %s", strerror(errno));
+		close(fds[0]);
+		close(fds[1]);
+		munmap(slots, slots_sz);
+		return NULL;
+	} else if (spawner_pid == 0) {
+		// Spawner process.
+		close(fds[1]);
+		rp_worker_spawner_main(slots, count, fds[0],
+			pfn_rp_create_thumbnail, pfn_rp_start_download_daemon);
+	}
+	close(fds[0]);
+
+	RpWorkerPool *const pool = g_new0(RpWorkerPool, 1);
+	pool->slots = slots;
+	pool->slots_sz = slots_sz;
+	pool->count = count;
+	pool->timeout_ms = timeout_ms;
+	pool->spawner_pid = spawner_pid;
+	pool->spawner_fd = fds[1];
+	g_mutex_init(&pool->spawner_mutex);
+	g_mutex_init(&pool->idle_mutex);
+	g_cond_init(&pool->idle_cond);
+
+	// Prefork the workers.
+	pool->idle = g_new(guint, count);
+	pool->idle_count = count;
+	for (guint i = 0; i < count; i++) {
+		// NOTE: Highest index is at the bottom of the stack
+		// so slot 0 is used first.
+		pool->idle[i] = count - 1 - i;
+		int ret = rp_worker_pool_spawn(pool, i);
+		if (ret != 0) {
+			// Not fatal; this will be retried on the next request.
+			g_warning("Unable to start worker %u: %s", i, strerror(-ret));
+		}
+	}
+
+	return pool;
+}
+
+/**
+ * Free a worker pool.
+ * All worker processes and the spawner process are terminated.
+ * @param pool Worker pool.
+ */
+void
+rp_worker_pool_free(RpWorkerPool *pool)
+{
+	if (!pool)
+		return;
+
+	// Closing the socket makes the spawner exit.
+	close(pool->spawner_fd);
+	for (guint i = 0; i < pool->count; i++) {
+		if (pool->slots[i].pid > 0) {
+			kill(pool->slots[i].pid, SIGKILL);
+		}
+	}
+	waitpid(pool->spawner_pid, NULL, 0);
+
+	for (guint i = 0; i < pool->count; i++) {
+		sem_destroy(&pool->slots[i].req_sem);
+		sem_destroy(&pool->slots[i].done_sem);
+		sem_destroy(&pool->slots[i].spawned_sem);
+	}
+	munmap(pool->slots, pool->slots_sz);
+
+	g_mutex_clear(&pool->spawner_mutex);
+	g_mutex_clear(&pool->idle_mutex);
+	g_cond_clear(&pool->idle_cond);
+	g_free(pool->idle);
+	g_free(pool);
+}
+
+/**
+ * Get the number of worker processes.
+ * @param pool Worker pool.
+ * @return Number of worker processes.
+ */
+guint
+rp_worker_pool_get_count(const RpWorkerPool *pool)
+{
+	g_return_val_if_fail(pool != NULL, 0);
+	return pool->count;
+}
+
+/**
+ * Create a thumbnail using a worker process.
+ * This function is thread-safe. If all workers are busy,
+ * it blocks until a worker is available.
+ *
+ * @param pool		[in] Worker pool.
+ * @param source_file	[in] Source file. (UTF-8)
+ * @param output_file	[in] Output file. (UTF-8)
+ * @param maximum_size	[in] Maximum size.
+ * @return rp_create_thumbnail() return value;
+ *         -ETIMEDOUT if the worker timed out and was killed;
+ *         -ECHILD if the worker crashed;
+ *         other negative POSIX error code on error.
+ */
+int
+rp_worker_pool_create_thumbnail(RpWorkerPool *pool,
+	const char *source_file, const char *output_file, int maximum_size)
+{
+	g_return_val_if_fail(pool != NULL, -EINVAL);
+	g_return_val_if_fail(source_file != NULL && output_file != NULL, -EINVAL);
+	if (strlen(source_file) >= SLOT_PATH_MAX || strlen(output_file) >= SLOT_PATH_MAX) {
+		return -ENAMETOOLONG;
+	}
+
+	// Get an idle worker.
+	g_mutex_lock(&pool->idle_mutex);
+	while (pool->idle_count == 0) {
+		g_cond_wait(&pool->idle_cond, &pool->idle_mutex);
+	}
+	const guint idx = pool->idle[--pool->idle_count];
+	g_mutex_unlock(&pool->idle_mutex);
+
+	RpWorkerSlot *const slot = &pool->slots[idx];
+	int ret = 0;
+	if (slot->pid <= 0 || kill(slot->pid, 0) != 0) {
+		// Worker isn't running. Start a new one.
+		ret = rp_worker_pool_spawn(pool, idx);
+	}
+
+	if (ret == 0) {
+		// Send the request.
+		strcpy(slot->source_file, source_file);
+		strcpy(slot->output_file, output_file);
+		slot->maximum_size = maximum_size;
+		slot->result = 0;
+		sem_post(&slot->req_sem);
+
+		// Wait for the result, checking periodically
+		// that the worker is still alive.
+		guint elapsed_ms = 0;
+		for (;;) {
+			ret = rp_sem_timedwait_ms(&slot->done_sem, WORKER_POLL_MS);
+			if (ret == 0) {
+				ret = slot->result;
+				break;
+			} else if (ret != -ETIMEDOUT) {
+				break;
+			}
+
+			if (kill(slot->pid, 0) != 0) {
+				// Worker crashed.
+				g_warning("Worker %u crashed while thumbnailing: %s", idx, source_file);
+				slot->pid = 0;
+				ret = -ECHILD;
+				break;
+			}
+
+			elapsed_ms += WORKER_POLL_MS;
+			if (elapsed_ms >= pool->timeout_ms) {
+				// Worker is hung. It will be replaced
+				// when this slot is used again.
+				g_warning("Worker %u timed out while thumbnailing: %s", idx, source_file);
+				rp_worker_kill(slot);
+				ret = -ETIMEDOUT;
+				break;
+			}
+		}
+	}
+
+	// Release the worker.
+	g_mutex_lock(&pool->idle_mutex);
+	pool->idle[pool->idle_count++] = idx;
+	g_cond_signal(&pool->idle_cond);
+	g_mutex_unlock(&pool->idle_mutex);
+	return ret;
+}
@@ -0,0 +1,87 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (D-Bus Thumbnailer)                *
+ * rp-thumbnailer-workers.h: Prefork worker process pool.                  *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_GTK_THUMBNAILER_DBUS_RP_THUMBNAILER_WORKERS_H__
+#define __ROMPROPERTIES_GTK_THUMBNAILER_DBUS_RP_THUMBNAILER_WORKERS_H__
+
+#include "rp-thumbnailer-dbus.h"
+
+G_BEGIN_DECLS
+
+/**
+ * Prefork worker process pool.
+ *
+ * Each request is run in a separate sandboxed worker process, so a
+ * crash or a pathological ROM image only affects that request.
+ *
+ * Requests and results are passed through a shared memory slot
+ * for each worker. The worker writes the thumbnail directly to
+ * the output file, so no image data is copied between processes.
+ *
+ * Workers are forked by a single-threaded spawner process, which
+ * is forked when the pool is created. Dead or hung workers are
+ * replaced by the spawner on demand, so the main process never
+ * calls fork() after it has started any threads.
+ *
+ * RpWorkerPool is declared in rp-thumbnailer-dbus.h.
+ */
+
+/**
+ * Create a worker pool.
+ *
+ * NOTE: This MUST be called before any threads are created,
+ * including GLib's D-Bus worker thread.
+ *
+ * @param count			[in] Number of worker processes. (1-256)
+ * @param timeout_ms		[in] Request timeout, in milliseconds.
+ * @param pfn_rp_create_thumbnail [in] rp_create_thumbnail() function pointer.
+ * @param pfn_rp_start_download_daemon [in] rp_start_download_daemon() function pointer.
+ * @return Worker pool, or NULL on error.
+ */
+RpWorkerPool	*rp_worker_pool_new		(guint count,
+						 guint timeout_ms,
+						 PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+						 PFN_RP_START_DOWNLOAD_DAEMON pfn_rp_start_download_daemon)
+						G_GNUC_WARN_UNUSED_RESULT;
+
+/**
+ * Free a worker pool.
+ * All worker processes and the spawner process are terminated.
+ * @param pool Worker pool.
+ */
+void		rp_worker_pool_free		(RpWorkerPool *pool);
+
+/**
+ * Get the number of worker processes.
+ * @param pool Worker pool.
+ * @return Number of worker processes.
+ */
+guint		rp_worker_pool_get_count	(const RpWorkerPool *pool);
+
+/**
+ * Create a thumbnail using a worker process.
+ * This function is thread-safe. If all workers are busy,
+ * it blocks until a worker is available.
+ *
+ * @param pool		[in] Worker pool.
+ * @param source_file	[in] Source file. (UTF-8)
+ * @param output_file	[in] Output file. (UTF-8)
+ * @param maximum_size	[in] Maximum size.
+ * @return rp_create_thumbnail() return value;
+ *         -ETIMEDOUT if the worker timed out and was killed;
+ *         -ECHILD if the worker crashed;
+ *         other negative POSIX error code on error.
+ */
+int		rp_worker_pool_create_thumbnail	(RpWorkerPool *pool,
+						 const char *source_file,
+						 const char *output_file,
+						 int maximum_size);
+
+G_END_DECLS
+
+#endif /* __ROMPROPERTIES_GTK_THUMBNAILER_DBUS_RP_THUMBNAILER_WORKERS_H__ */
@@ -85,7 +85,7 @@ int rpt_do_security_options(void)
 		// glib / D-Bus
 		SCMP_SYS(eventfd2),
 		SCMP_SYS(fcntl), SCMP_SYS(fcntl64),
-		SCMP_SYS(getdents), SCMP_SYS(getdents64)	// g_file_new_for_uri() [rp_create_thumbnail()]
+		SCMP_SYS(getdents), SCMP_SYS(getdents64),	// g_file_new_for_uri() [rp_create_thumbnail()]
 		SCMP_SYS(getegid), SCMP_SYS(geteuid), SCMP_SYS(poll),
 		SCMP_SYS(recvfrom), SCMP_SYS(sendmsg), SCMP_SYS(socket),
 		SCMP_SYS(socketcall),	// FIXME: Enhanced filtering? [cURL+GnuTLS only?]
@@ -117,3 +117,131 @@ int rpt_do_security_options(void)
 	return rp_secure_enable(param);
 #endif
 }
+
+/**
+ * Enable security options for a worker process.
+ *
+ * Worker processes only create thumbnails, so they can use a much
+ * stricter filter than the main process. They can't run other
+ * programs; external images are downloaded by the rp-download
+ * daemon, which is started by the worker spawner.
+ *
+ * NOTE: seccomp can't check filenames, so files can still be
+ * opened for writing. This is needed for the output file and
+ * the rom-properties cache.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int rpt_do_worker_security_options(void)
+{
+	// Set OS-specific security options.
+	rp_secure_param_t param;
+#if defined(_WIN32)
+	param.bHighSec = FALSE;
+#elif defined(HAVE_SECCOMP)
+	static const int syscall_wl[] = {
+		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
+		// defined in earlier versions, including Ubuntu 14.04.
+
+		// NOTE: clone() must be first; only threads are allowed.
+		SCMP_SYS(clone),	// LibRpThreads::ThreadPool [image decoding], GLib worker threads
+
+		SCMP_SYS(close),
+		SCMP_SYS(dup),		// gzdopen()
+		SCMP_SYS(fcntl),     SCMP_SYS(fcntl64),		// gcc profiling
+		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
+		SCMP_SYS(fstatat64), SCMP_SYS(newfstatat),	// Ubuntu 19.10 (32-bit)
+		SCMP_SYS(ftruncate),	// LibRpBase::RpFile::truncate() [from LibRpBase::RpPngWriterPrivate::init()]
+		SCMP_SYS(ftruncate64),
+		SCMP_SYS(futex),	// sem_wait(), sem_post() [worker slot]
+		SCMP_SYS(gettimeofday),	// 32-bit only?
+		SCMP_SYS(lseek), SCMP_SYS(_llseek),
+		SCMP_SYS(lstat), SCMP_SYS(lstat64),	// LibRpBase::FileSystem::is_symlink(), resolve_symlink()
+		SCMP_SYS(mmap), SCMP_SYS(mmap2),
+		SCMP_SYS(mprotect), SCMP_SYS(munmap),
+		SCMP_SYS(open),		// Ubuntu 16.04
+		SCMP_SYS(openat),	// glibc-2.31
+#if defined(__SNR_openat2)
+		SCMP_SYS(openat2),	// Linux 5.6
+#elif defined(__NR_openat2)
+		__NR_openat2,		// Linux 5.6
+#endif /* __SNR_openat2 || __NR_openat2 */
+		SCMP_SYS(pread64),	// LibRpFile::RpFile::pread() [RomDataPrivate::readAt()]
+		SCMP_SYS(readlink),	// realpath() [LibRpBase::FileSystem::resolve_symlink()]
+		SCMP_SYS(statfs), SCMP_SYS(statfs64),	// LibRpBase::FileSystem::isOnBadFS()
+
+		// LibRpFile::RpFile::adviseAccess(), prefetch()
+		// NOTE: posix_fadvise() uses a different syscall depending on the architecture.
+		SCMP_SYS(fadvise64),	// 64-bit
+		SCMP_SYS(fadvise64_64),	// 32-bit
+#if defined(__SNR_arm_fadvise64_64) || defined(__NR_arm_fadvise64_64)
+		SCMP_SYS(arm_fadvise64_64),	// 32-bit ARM
+#endif /* __SNR_arm_fadvise64_64 || __NR_arm_fadvise64_64 */
+
+		// KeyManager (keys.conf)
+		SCMP_SYS(access),	// LibUnixCommon::isWritableDirectory()
+		SCMP_SYS(stat), SCMP_SYS(stat64),	// LibUnixCommon::isWritableDirectory()
+
+#if defined(__SNR_statx) || defined(__NR_statx)
+		SCMP_SYS(getcwd),	// called by glibc's statx()
+		SCMP_SYS(statx),
+#endif /* __SNR_statx || __NR_statx */
+
+		// ConfReader: LibRpBase::ConfWatcher (inotify)
+		SCMP_SYS(inotify_init1), SCMP_SYS(inotify_add_watch),
+		SCMP_SYS(pipe2),	// shutdown pipe
+		SCMP_SYS(poll), SCMP_SYS(ppoll),	// watcher thread (ppoll on arm64)
+
+		// CacheManager: rp-download daemon socket
+		// NOTE: rp-download isn't run directly. See CacheManager::setDaemonOnly().
+		// TODO: Restrict socket() to AF_UNIX.
+		SCMP_SYS(socket), SCMP_SYS(connect),
+		SCMP_SYS(recvfrom), SCMP_SYS(recvmsg),
+		SCMP_SYS(sendto), SCMP_SYS(sendmsg),
+
+		// CacheManager: NegativeCache, CacheIndex
+		SCMP_SYS(getdents), SCMP_SYS(getdents64),	// LibRpFile::FileSystem::read_dir()
+		SCMP_SYS(mkdir), SCMP_SYS(mkdirat),
+		SCMP_SYS(rename), SCMP_SYS(renameat),
+#if defined(__SNR_renameat2) || defined(__NR_renameat2)
+		SCMP_SYS(renameat2),
+#endif /* __SNR_renameat2 || __NR_renameat2 */
+		SCMP_SYS(unlink), SCMP_SYS(unlinkat),
+
+		// LibRpThreads::ThreadPool, GLib worker threads
+		SCMP_SYS(madvise),		// pthread stack cleanup
+		SCMP_SYS(rt_sigprocmask),	// pthread_create()
+		SCMP_SYS(sched_getaffinity),	// sysconf(_SC_NPROCESSORS_ONLN)
+		SCMP_SYS(set_robust_list),	// pthread_create()
+#if defined(__SNR_rseq) || defined(__NR_rseq)
+		SCMP_SYS(rseq),			// glibc-2.35
+#endif /* __SNR_rseq || __NR_rseq */
+		// NOTE: clone3() is rejected with ENOSYS by rp_secure_enable(),
+		// so glibc-2.34's pthread_create() falls back to clone().
+
+		// GLib
+		SCMP_SYS(eventfd2),	// GMainContext
+		SCMP_SYS(getegid), SCMP_SYS(geteuid), SCMP_SYS(getuid),
+		SCMP_SYS(getpid),	// g_get_prgname(), g_log()
+		SCMP_SYS(prctl),	// pthread_setname_np() [g_thread_proxy(), start_thread()]
+
+		-1	// End of whitelist
+	};
+	param.syscall_wl = syscall_wl;
+#elif defined(HAVE_PLEDGE)
+	// Promises:
+	// - stdio: General stdio functionality.
+	// - rpath: Read the source file, ~/.config/rom-properties/, and ~/.cache/rom-properties/
+	// - wpath: Write to the output file and ~/.cache/rom-properties/
+	// - cpath: Create the output file, and ~/.cache/rom-properties/ if it doesn't exist.
+	// - getpw: Get user's home directory if HOME is empty.
+	// - unix: Connect to the rp-download daemon's socket.
+	param.promises = "stdio rpath wpath cpath getpw unix";
+#elif defined(HAVE_TAME)
+	// NOTE: stdio includes fattr, e.g. utimes().
+	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH | TAME_GETPW | TAME_UNIX;
+#else
+	param.dummy = 0;
+#endif
+	return rp_secure_enable(param);
+}
@@ -19,6 +19,14 @@ extern "C" {
  */
 int rpt_do_security_options(void);
 
+/**
+ * Enable security options for a worker process.
+ * The worker can create thumbnails and connect to the
+ * rp-download daemon, but it can't run other programs.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int rpt_do_worker_security_options(void);
+
 #ifdef __cplusplus
 }
 #endif
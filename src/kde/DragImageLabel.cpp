@@ -9,16 +9,18 @@
 // Reference: https://doc.qt.io/qt-5/dnd.html
 #include "stdafx.h"
 #include "DragImageLabel.hpp"
-#include "RpQByteArrayFile.hpp"
+#include "RpPngMimeData.hpp"
 
 // librpbase, librptexture
 #include "librpbase/img/IconAnimData.hpp"
 #include "librpbase/img/IconAnimHelper.hpp"
 using LibRpBase::IconAnimData;
 using LibRpBase::IconAnimHelper;
-using LibRpBase::RpPngWriter;
 using LibRpTexture::rp_image;
 
+// Qt includes.
+#include <QtCore/QPointer>
+
 DragImageLabel::DragImageLabel(const QString &text, QWidget *parent, Qt::WindowFlags f)
 	: super(text, parent, f)
 	, m_minimumImageSize(DIL_MIN_IMAGE_SIZE, DIL_MIN_IMAGE_SIZE)
@@ -58,6 +60,7 @@ bool DragImageLabel::setRpImage(const rp_image *img)
 	// previously stored image, since the underlying image may
 	// have changed.
 	UNREF_AND_NULL(m_img);
+	m_pngData.clear();
 
 	if (!img) {
 		if (!m_anim || !m_anim->iconAnimData) {
@@ -95,6 +98,7 @@ bool DragImageLabel::setIconAnimData(const IconAnimData *iconAnimData)
 	// previously stored image, since the underlying image may
 	// have changed.
 	UNREF_AND_NULL(m_anim->iconAnimData);
+	m_pngData.clear();
 
 	if (!iconAnimData) {
 		if (m_anim->tmrIconAnim) {
@@ -129,6 +133,7 @@ void DragImageLabel::clearRp(void)
 	}
 
 	UNREF_AND_NULL(m_img);
+	m_pngData.clear();
 	this->clear();
 }
 
@@ -171,17 +176,22 @@ bool DragImageLabel::updatePixmaps(void)
 	if (m_anim && m_anim->iconAnimData) {
 		const IconAnimData *const iconAnimData = m_anim->iconAnimData;
 
+		// Set up the IconAnimHelper.
+		m_anim->iconAnimHelper.setIconAnimData(iconAnimData);
+
 		// Convert the icons to QPixmaps.
+		// Duplicate frames are skipped, since the IconAnimHelper
+		// only returns base frames.
 		for (int i = iconAnimData->count-1; i >= 0; i--) {
 			const rp_image *const frame = iconAnimData->frames[i];
-			if (frame && frame->isValid()) {
+			if (frame && frame->isValid() && m_anim->iconAnimHelper.baseFrame(i) == i) {
 				// NOTE: Allowing NULL frames here...
 				m_anim->iconFrames[i] = imgToPixmap(rpToQImage(frame));
+			} else {
+				m_anim->iconFrames[i] = QPixmap();
 			}
 		}
 
-		// Set up the IconAnimHelper.
-		m_anim->iconAnimHelper.setIconAnimData(iconAnimData);
 		if (m_anim->iconAnimHelper.isAnimated()) {
 			// Initialize the animation.
 			m_anim->last_frame_number = m_anim->iconAnimHelper.frameNumber();
@@ -307,52 +317,26 @@ void DragImageLabel::mouseMoveEvent(QMouseEvent *event)
 
 	const bool isAnimated = (m_anim && m_anim->iconAnimData && m_anim->iconAnimHelper.isAnimated());
 
-	RpQByteArrayFile *const pngData = new RpQByteArrayFile();
-	RpPngWriter *pngWriter;
+	// NOTE: The PNG image is only encoded if the drop target requests it.
+	RpPngMimeData *mimeData;
 	if (isAnimated) {
 		// Animated icon.
-		pngWriter = new RpPngWriter(pngData, m_anim->iconAnimData);
+		mimeData = new RpPngMimeData(m_anim->iconAnimData);
 	} else if (m_img) {
 		// Standard icon.
 		// NOTE: Using the source image because we want the original
 		// size, not the resized version.
-		pngWriter = new RpPngWriter(pngData, m_img);
+		mimeData = new RpPngMimeData(m_img);
 	} else {
 		// No icon...
-		pngData->unref();
-		return;
-	}
-
-	if (!pngWriter->isOpen()) {
-		// Unable to open the PNG writer.
-		delete pngWriter;
-		pngData->unref();
 		return;
 	}
-
-	// TODO: Add text fields indicating the source game.
-
-	int pwRet = pngWriter->write_IHDR();
-	if (pwRet != 0) {
-		// Error writing the PNG image...
-		delete pngWriter;
-		pngData->unref();
-		return;
-	}
-	pwRet = pngWriter->write_IDAT();
-	if (pwRet != 0) {
-		// Error writing the PNG image...
-		delete pngWriter;
-		pngData->unref();
-		return;
+	if (!m_pngData.isEmpty()) {
+		// Use the PNG data from a previous drag.
+		mimeData->setPngData(m_pngData);
 	}
-
-	// RpPngWriter will finalize the PNG on delete.
-	delete pngWriter;
-
-	QMimeData *const mimeData = new QMimeData;
-	QByteArray ba = pngData->qByteArray();
-	mimeData->setData(QLatin1String("image/png"), pngData->qByteArray());
+	// NOTE: QDrag takes ownership of the QMimeData.
+	QPointer<RpPngMimeData> pMimeData(mimeData);
 
 	QDrag *const drag = new QDrag(this);
 	drag->setMimeData(mimeData);
@@ -376,5 +360,9 @@ void DragImageLabel::mouseMoveEvent(QMouseEvent *event)
 	}
 
 	drag->exec(Qt::CopyAction);
-	pngData->unref();
+
+	// Save the PNG data for the next drag if it was encoded.
+	if (pMimeData && pMimeData->isEncoded()) {
+		m_pngData = pMimeData->pngData();
+	}
 }
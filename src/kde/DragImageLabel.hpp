@@ -159,6 +159,10 @@ class DragImageLabel : public QLabel
 		// rp_image. (NOTE: Not owned by this object.)
 		const LibRpTexture::rp_image *m_img;
 
+		// Cached PNG data from a previous drag.
+		// Cleared when the image is changed.
+		QByteArray m_pngData;
+
 		// Animated icon data.
 		struct anim_vars {
 			const LibRpBase::IconAnimData *iconAnimData;
@@ -0,0 +1,72 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (KDE4/KF5)                         *
+ * DragImageTreeView.hpp: Drag & Drop tree view.                           *
+ *                                                                         *
+ * Copyright (c) 2019-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// References:
+// - https://doc.qt.io/qt-5/dnd.html
+// - https://wiki.qt.io/QList_Drag_and_Drop_Example
+#include "stdafx.h"
+#include "DragImageTreeView.hpp"
+#include "RpPngMimeData.hpp"
+
+// librptexture
+using LibRpTexture::rp_image;
+
+void DragImageTreeView::startDrag(Qt::DropActions supportedActions)
+{
+	// TODO: Handle supportedActions?
+	// TODO: Multiple PNG images if multiple items are selected?
+	// - May need to write images to a temp directory and use a URI list...
+	Q_UNUSED(supportedActions)
+
+	// Get the selected rows.
+	QModelIndexList indexes = selectionModel()->selectedRows(0);
+	if (indexes.isEmpty()) {
+		// No rows selected.
+		return;
+	}
+
+	// TODO: Handle more than one selected row.
+	indexes = indexes.mid(0, 1);
+
+	// Find rp_image* objects in the rows.
+	// NOTE: The PNG image is only encoded if the drop target requests it.
+	RpPngMimeData *mimeData = nullptr;
+	QIcon dragIcon;
+	const auto iter_end = indexes.cend();
+	for (auto iter = indexes.cbegin(); iter != iter_end; ++iter) {
+		const QModelIndex &index = *iter;
+		const rp_image *const img = static_cast<const rp_image*>(index.data(RpImageRole).value<void*>());
+		if (!img)
+			continue;
+
+		mimeData = new RpPngMimeData(img);
+		img->unref();
+
+		// Save the icon.
+		dragIcon = qvariant_cast<QIcon>(index.data(Qt::DecorationRole));
+		break;
+	}
+
+	if (!mimeData) {
+		// No rp_image* objects...
+		return;
+	}
+
+	QDrag *const drag = new QDrag(this);
+	drag->setMimeData(mimeData);
+
+	QPixmap qpxm;
+	if (!dragIcon.isNull()) {
+		qpxm = dragIcon.pixmap(this->iconSize());
+	}
+	if (!qpxm.isNull()) {
+		drag->setPixmap(qpxm);
+	}
+
+	drag->exec(Qt::CopyAction);
+}
@@ -10,29 +10,30 @@
 // - https://doc.qt.io/qt-5/dnd.html
 // - https://wiki.qt.io/QList_Drag_and_Drop_Example
 
-#ifndef __ROMPROPERTIES_KDE_DRAGIMAGETREEWIDGET_HPP__
-#define __ROMPROPERTIES_KDE_DRAGIMAGETREEWIDGET_HPP__
+#ifndef __ROMPROPERTIES_KDE_DRAGIMAGETREEVIEW_HPP__
+#define __ROMPROPERTIES_KDE_DRAGIMAGETREEVIEW_HPP__
 
-#include <QTreeWidget>
+#include <QTreeView>
 
-class DragImageTreeWidget : public QTreeWidget
+class DragImageTreeView : public QTreeView
 {
 	Q_OBJECT
 
 	public:
-		explicit DragImageTreeWidget(QWidget *parent = nullptr)
+		explicit DragImageTreeView(QWidget *parent = nullptr)
 			: super(parent) { }
 
-		// Role for an rp_image*.
+		// Model role for an rp_image*.
+		// The image is ref()'d; the caller must unref() it.
 		static const int RpImageRole = Qt::UserRole + 0x4049;
 
 	private:
-		typedef QTreeWidget super;
-		Q_DISABLE_COPY(DragImageTreeWidget)
+		typedef QTreeView super;
+		Q_DISABLE_COPY(DragImageTreeView)
 
 	protected:
 		/** Overridden QWidget functions **/
 		void startDrag(Qt::DropActions supportedActions) override;
 };
 
-#endif /* __ROMPROPERTIES_KDE_DRAGIMAGETREEWIDGET_HPP__ */
+#endif /* __ROMPROPERTIES_KDE_DRAGIMAGETREEVIEW_HPP__ */
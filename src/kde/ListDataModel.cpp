@@ -0,0 +1,360 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (KDE4/KF5)                         *
+ * ListDataModel.cpp: QAbstractTableModel for RFT_LISTDATA.                *
+ *                                                                         *
+ * Copyright (c) 2012-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ListDataModel.hpp"
+#include "DragImageTreeView.hpp"
+
+// librpbase, librptexture
+using LibRpBase::RomFields;
+using LibRpTexture::rp_image;
+
+// C++ STL classes.
+using std::string;
+using std::vector;
+
+/** ListDataModelPrivate **/
+
+class ListDataModelPrivate
+{
+	public:
+		explicit ListDataModelPrivate(ListDataModel *q);
+
+	protected:
+		ListDataModel *const q_ptr;
+		Q_DECLARE_PUBLIC(ListDataModel)
+	private:
+		Q_DISABLE_COPY(ListDataModelPrivate)
+
+	public:
+		const RomFields::Field *pField;
+		const RomFields::ListData_t *pListData;
+
+		int rowCount;
+		int columnCount;
+		QVector<QString> columnNames;
+
+		// ListView row -> ListData_t row.
+		// Only used if rows are skipped. (if empty, 1:1)
+		vector<int> rowMap;
+
+		// Checkboxes. (one bit per model row)
+		uint32_t checkboxes;
+		bool hasCheckboxes;
+		bool hasIcons;
+
+		// Icon cache. Icons are converted when they're
+		// first requested by the view.
+		mutable QVector<QIcon> icons;
+
+		// Format table.
+		// All values are known to fit in uint8_t.
+		// NOTE: Need to include AlignVCenter.
+		static const uint8_t align_tbl[4];
+
+		/**
+		 * Get the ListData_t row index for a model row.
+		 * @param row Model row.
+		 * @return ListData_t row, or -1 if invalid.
+		 */
+		inline int dataRow(int row) const
+		{
+			if (row < 0 || row >= rowCount)
+				return -1;
+			return (rowMap.empty() ? row : rowMap[row]);
+		}
+
+		/**
+		 * Get the text alignment for a column.
+		 * @param align Alignment bitfield. (from RomFields)
+		 * @param column Column.
+		 * @return Qt::Alignment
+		 */
+		static inline int alignment(uint32_t align, int column)
+		{
+			return align_tbl[(align >> (column * 2)) & 3];
+		}
+};
+
+const uint8_t ListDataModelPrivate::align_tbl[4] = {
+	// Order: TXA_D, TXA_L, TXA_C, TXA_R
+	Qt::AlignLeft | Qt::AlignVCenter,
+	Qt::AlignLeft | Qt::AlignVCenter,
+	Qt::AlignCenter,
+	Qt::AlignRight | Qt::AlignVCenter,
+};
+
+ListDataModelPrivate::ListDataModelPrivate(ListDataModel *q)
+	: q_ptr(q)
+	, pField(nullptr)
+	, pListData(nullptr)
+	, rowCount(0)
+	, columnCount(0)
+	, checkboxes(0)
+	, hasCheckboxes(false)
+	, hasIcons(false)
+{ }
+
+/** ListDataModel **/
+
+ListDataModel::ListDataModel(QObject *parent)
+	: super(parent)
+	, d_ptr(new ListDataModelPrivate(this))
+{ }
+
+ListDataModel::~ListDataModel()
+{
+	delete d_ptr;
+}
+
+int ListDataModel::rowCount(const QModelIndex& parent) const
+{
+	Q_D(const ListDataModel);
+	if (parent.isValid()) {
+		// No child items.
+		return 0;
+	}
+	return d->rowCount;
+}
+
+int ListDataModel::columnCount(const QModelIndex& parent) const
+{
+	Q_D(const ListDataModel);
+	if (parent.isValid()) {
+		// No child items.
+		return 0;
+	}
+	return d->columnCount;
+}
+
+QVariant ListDataModel::data(const QModelIndex& index, int role) const
+{
+	Q_D(const ListDataModel);
+	if (!d->pListData || !index.isValid())
+		return QVariant();
+
+	const int row = d->dataRow(index.row());
+	const int column = index.column();
+	if (row < 0 || row >= static_cast<int>(d->pListData->size()) ||
+	    column < 0 || column >= d->columnCount)
+	{
+		// Invalid index.
+		return QVariant();
+	}
+
+	switch (role) {
+		case Qt::DisplayRole: {
+			const vector<string> &data_row = d->pListData->at(row);
+			if (column < static_cast<int>(data_row.size())) {
+				return U82Q(data_row[column]);
+			}
+			break;
+		}
+
+		case Qt::TextAlignmentRole:
+			return ListDataModelPrivate::alignment(
+				d->pField->desc.list_data.alignment.data, column);
+
+		case Qt::CheckStateRole:
+			if (d->hasCheckboxes && column == 0) {
+				return ((d->checkboxes & (1U << index.row())) ? Qt::Checked : Qt::Unchecked);
+			}
+			break;
+
+		case Qt::DecorationRole:
+		case DragImageTreeView::RpImageRole: {
+			if (!d->hasIcons || column != 0)
+				break;
+			const auto *const icons = d->pField->data.list_data.mxd.icons;
+			if (row >= static_cast<int>(icons->size()))
+				break;
+			const rp_image *const icon = icons->get(row);
+			if (!icon)
+				break;
+
+			if (role == DragImageTreeView::RpImageRole) {
+				// NOTE: The caller must unref() the image.
+				return QVariant::fromValue((void*)icon);
+			}
+
+			// Convert the icon if it hasn't been converted yet.
+			QIcon &qicon = d->icons[index.row()];
+			if (qicon.isNull()) {
+				qicon = QIcon(QPixmap::fromImage(rpToQImage(icon)));
+			}
+			icon->unref();
+			return qicon;
+		}
+
+		default:
+			break;
+	}
+
+	// Nothing for this role.
+	return QVariant();
+}
+
+Qt::ItemFlags ListDataModel::flags(const QModelIndex &index) const
+{
+	Q_D(const ListDataModel);
+	if (!index.isValid())
+		return Qt::ItemFlags();
+
+	if (d->hasIcons) {
+		// Icons can be dragged.
+		return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+	}
+	return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+QVariant ListDataModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	Q_D(const ListDataModel);
+	if (orientation != Qt::Horizontal || section < 0 || section >= d->columnNames.size())
+		return QVariant();
+
+	switch (role) {
+		case Qt::DisplayRole:
+			return d->columnNames[section];
+
+		case Qt::TextAlignmentRole:
+			return ListDataModelPrivate::alignment(
+				d->pField->desc.list_data.alignment.headers, section);
+
+		default:
+			break;
+	}
+
+	// Default value.
+	return QVariant();
+}
+
+/**
+ * Set the RFT_LISTDATA field to use in this model.
+ *
+ * The field's data is not copied, so it must remain
+ * valid until the model is deleted or another field
+ * is set. Strings are converted when they're requested
+ * by the view, so only the visible rows are converted.
+ *
+ * For RFT_LISTDATA_MULTI, the first language is used
+ * until setListData() is called.
+ *
+ * @param pField RFT_LISTDATA field.
+ */
+void ListDataModel::setField(const RomFields::Field *pField)
+{
+	Q_D(ListDataModel);
+	beginResetModel();
+
+	d->pField = nullptr;
+	d->pListData = nullptr;
+	d->rowCount = 0;
+	d->columnCount = 0;
+	d->columnNames.clear();
+	d->rowMap.clear();
+	d->checkboxes = 0;
+	d->hasCheckboxes = false;
+	d->hasIcons = false;
+	d->icons.clear();
+
+	assert(pField != nullptr);
+	assert(!pField || pField->type == RomFields::RFT_LISTDATA);
+	if (!pField || pField->type != RomFields::RFT_LISTDATA) {
+		// Not an RFT_LISTDATA field.
+		endResetModel();
+		return;
+	}
+
+	// Single language ListData_t.
+	// For RFT_LISTDATA_MULTI, the first language is used for now.
+	const auto &listDataDesc = pField->desc.list_data;
+	const RomFields::ListData_t *list_data = nullptr;
+	if (listDataDesc.flags & RomFields::RFT_LISTDATA_MULTI) {
+		const auto *const multi = pField->data.list_data.data.multi;
+		if (multi && !multi->empty()) {
+			list_data = &multi->cbegin()->second;
+		}
+	} else {
+		list_data = pField->data.list_data.data.single;
+	}
+	if (!list_data || list_data->empty()) {
+		// No data...
+		endResetModel();
+		return;
+	}
+
+	d->pField = pField;
+	d->pListData = list_data;
+	d->hasCheckboxes = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_CHECKBOXES);
+	d->hasIcons = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_ICONS) &&
+	              pField->data.list_data.mxd.icons != nullptr;
+
+	// Column names.
+	if (listDataDesc.names) {
+		d->columnCount = static_cast<int>(listDataDesc.names->size());
+		d->columnNames.reserve(d->columnCount);
+		const auto names_cend = listDataDesc.names->cend();
+		for (auto iter = listDataDesc.names->cbegin(); iter != names_cend; ++iter) {
+			d->columnNames.append(U82Q(*iter));
+		}
+	} else {
+		// No column headers.
+		// Use the first row.
+		d->columnCount = static_cast<int>(list_data->at(0).size());
+	}
+
+	if (d->hasCheckboxes) {
+		// Rows with no data are skipped.
+		// FIXME: Skip even if we don't have checkboxes?
+		// (also check other UI frontends)
+		uint32_t checkboxes = pField->data.list_data.mxd.checkboxes;
+		d->rowMap.reserve(list_data->size());
+		int row = 0;
+		const auto list_data_cend = list_data->cend();
+		for (auto iter = list_data->cbegin(); iter != list_data_cend;
+		     ++iter, row++, checkboxes >>= 1)
+		{
+			if (iter->empty())
+				continue;
+			if (checkboxes & 1) {
+				d->checkboxes |= (1U << d->rowMap.size());
+			}
+			d->rowMap.emplace_back(row);
+		}
+		d->rowCount = static_cast<int>(d->rowMap.size());
+	} else {
+		d->rowCount = static_cast<int>(list_data->size());
+	}
+
+	if (d->hasIcons) {
+		d->icons.resize(d->rowCount);
+	}
+
+	endResetModel();
+}
+
+/**
+ * Set the ListData_t for an RFT_LISTDATA_MULTI field.
+ * This must have the same number of rows as the
+ * ListData_t that was used in setField().
+ * @param pListData ListData_t for the selected language.
+ */
+void ListDataModel::setListData(const RomFields::ListData_t *pListData)
+{
+	Q_D(ListDataModel);
+	assert(pListData != nullptr);
+	if (!pListData || d->pListData == pListData)
+		return;
+
+	d->pListData = pListData;
+	if (d->rowCount > 0 && d->columnCount > 0) {
+		// Only the text has changed.
+		emit dataChanged(index(0, 0), index(d->rowCount - 1, d->columnCount - 1));
+	}
+}
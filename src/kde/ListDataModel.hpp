@@ -0,0 +1,68 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (KDE4/KF5)                         *
+ * ListDataModel.hpp: QAbstractTableModel for RFT_LISTDATA.                *
+ *                                                                         *
+ * Copyright (c) 2012-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_KDE_LISTDATAMODEL_HPP__
+#define __ROMPROPERTIES_KDE_LISTDATAMODEL_HPP__
+
+// librpbase
+#include "librpbase/RomFields.hpp"
+
+// Qt includes.
+#include <QtCore/QAbstractItemModel>
+
+class ListDataModelPrivate;
+class ListDataModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+	public:
+		explicit ListDataModel(QObject *parent = 0);
+		virtual ~ListDataModel();
+
+	private:
+		typedef QAbstractTableModel super;
+		ListDataModelPrivate *const d_ptr;
+		Q_DECLARE_PRIVATE(ListDataModel)
+		Q_DISABLE_COPY(ListDataModel)
+
+	public:
+		// Qt Model/View interface.
+		int rowCount(const QModelIndex& parent = QModelIndex()) const final;
+		int columnCount(const QModelIndex& parent = QModelIndex()) const final;
+
+		QVariant data(const QModelIndex& index, int role) const final;
+		Qt::ItemFlags flags(const QModelIndex &index) const final;
+
+		QVariant headerData(int section, Qt::Orientation orientation, int role) const final;
+
+	public:
+		/**
+		 * Set the RFT_LISTDATA field to use in this model.
+		 *
+		 * The field's data is not copied, so it must remain
+		 * valid until the model is deleted or another field
+		 * is set. Strings are converted when they're requested
+		 * by the view, so only the visible rows are converted.
+		 *
+		 * For RFT_LISTDATA_MULTI, the first language is used
+		 * until setListData() is called.
+		 *
+		 * @param pField RFT_LISTDATA field.
+		 */
+		void setField(const LibRpBase::RomFields::Field *pField);
+
+		/**
+		 * Set the ListData_t for an RFT_LISTDATA_MULTI field.
+		 * This must have the same number of rows as the
+		 * ListData_t that was used in setField().
+		 * @param pListData ListData_t for the selected language.
+		 */
+		void setListData(const LibRpBase::RomFields::ListData_t *pListData);
+};
+
+#endif /* __ROMPROPERTIES_KDE_LISTDATAMODEL_HPP__ */
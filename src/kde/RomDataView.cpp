@@ -13,14 +13,22 @@
 
 // librpbase, librpfile, librptexture
 #include "librpbase/TextOut.hpp"
+#include "librpbase/img/SharedImageCache.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 using LibRpTexture::rp_image;
 
+// libromdata
+#include "libromdata/DetectCache.hpp"
+#include "libromdata/RomDataFactory.hpp"
+using LibRomData::DetectCache;
+using LibRomData::RomDataFactory;
+
 // libi18n
 #include "libi18n/i18n.h"
 
 // C++ STL classes.
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 using std::array;
@@ -32,10 +40,13 @@ using std::unordered_map;
 using std::vector;
 
 // Qt includes.
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
 #include <QtGui/QClipboard>
 
 // Custom Qt widgets.
-#include "DragImageTreeWidget.hpp"
+#include "DragImageTreeView.hpp"
+#include "ListDataModel.hpp"
 
 // KDE4/KF5 includes.
 #if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
@@ -79,6 +90,22 @@ class RomDataViewPrivate
 		// RomData object.
 		RomData *romData;
 
+		// Worker thread for loadRomData().
+		// Set while the RomData object is being loaded.
+		class LoaderThread;
+		LoaderThread *loader;
+
+		// Set once the header images have been loaded
+		// by the worker thread and shown.
+		bool headerImagesLoaded;
+
+		/**
+		 * Stop the worker thread, if it's running.
+		 * NOTE: The RomData constructor can't be interrupted,
+		 * so this waits for the worker thread to finish.
+		 */
+		void stopLoader(void);
+
 		// "Options" button.
 		QPushButton *btnOptions;
 		QMenu *menuOptions;
@@ -100,8 +127,9 @@ class RomDataViewPrivate
 			QVBoxLayout *vbox;
 			QFormLayout *form;
 			QLabel *lblCredits;
+			bool deferred;	// Widgets will be created when the tab is selected.
 
-			tab() : vbox(nullptr), form(nullptr), lblCredits(nullptr) { }
+			tab() : vbox(nullptr), form(nullptr), lblCredits(nullptr), deferred(false) { }
 		};
 		vector<tab> tabs;
 
@@ -128,11 +156,13 @@ class RomDataViewPrivate
 		inline uint32_t sel_lc(void) const;
 
 		// RFT_STRING_MULTI value labels.
-		typedef std::pair<QLabel*, const RomFields::Field*> Data_StringMulti_t;
+		// NOTE: Field indexes are stored instead of Field pointers,
+		// since loading a deferred tab may reallocate the fields.
+		typedef std::pair<QLabel*, int> Data_StringMulti_t;
 		vector<Data_StringMulti_t> vecStringMulti;
 
-		// RFT_LISTDATA_MULTI value QTreeWidgets.
-		typedef std::pair<QTreeWidget*, const RomFields::Field*> Data_ListDataMulti_t;
+		// RFT_LISTDATA_MULTI value QTreeViews.
+		typedef std::pair<QTreeView*, int> Data_ListDataMulti_t;
 		vector<Data_ListDataMulti_t> vecListDataMulti;
 
 		/**
@@ -140,12 +170,22 @@ class RomDataViewPrivate
 		 */
 		void createOptionsButton(void);
 
+		/**
+		 * Add the RomData object's ROM operations to the "Options" menu.
+		 */
+		void addRomOps(void);
+
 		/**
 		 * Initialize the header row widgets.
 		 * The widgets must have already been created by ui.setupUi().
 		 */
 		void initHeaderRow(void);
 
+		/**
+		 * Initialize the banner and icon in the header row.
+		 */
+		void initHeaderImages(void);
+
 		/**
 		 * Clear a QLayout.
 		 * @param layout QLayout.
@@ -258,13 +298,143 @@ class RomDataViewPrivate
 		 * be deleted and recreated.
 		 */
 		void initDisplayWidgets(void);
+
+		/**
+		 * Create the widgets for the fields.
+		 * @param pFields RomFields
+		 * @param onlyTabIdx Tab index, or -1 for all tabs that aren't deferred.
+		 */
+		void initFieldWidgets(const RomFields *pFields, int onlyTabIdx);
+
+		/**
+		 * Load a deferred tab and create its widgets.
+		 * @param tabIdx Tab index.
+		 */
+		void loadDeferredTab(int tabIdx);
+
+		/**
+		 * Are there any tabs whose widgets haven't been created yet?
+		 * @return True if so; false if not.
+		 */
+		bool hasDeferredTabs(void) const;
 };
 
+/** RomDataViewPrivate::LoaderThread **/
+
+/**
+ * Worker thread for RomDataView::loadRomData().
+ *
+ * The RomData object is created and its fields are loaded
+ * on this thread. The header images are loaded at the same
+ * time using RomData::loadImagesAsync(). RomDataView is
+ * notified separately when the fields and the images have
+ * been loaded, so whichever finishes first is shown first.
+ *
+ * NOTE: RomData isn't thread-safe. Until the thread has
+ * finished, the main thread may only read the fields.
+ */
+class RomDataViewPrivate::LoaderThread : public QThread
+{
+	public:
+		LoaderThread(RomDataView *view, IRpFile *file)
+			: QThread(view)
+			, view(view)
+			, file(file->ref())
+			, romData(nullptr)
+		{ }
+
+		~LoaderThread()
+		{
+			wait();
+			UNREF(romData);
+			UNREF(file);
+		}
+
+	private:
+		Q_DISABLE_COPY(LoaderThread)
+
+	protected:
+		void run(void) final;
+
+		/**
+		 * RomData::loadImagesAsync() completion callback.
+		 * @param romData RomData object.
+		 * @param imgbf Bitfield of internal images that were loaded.
+		 * @param userdata LoaderThread
+		 */
+		static void imagesLoaded(const RomData *romData, uint32_t imgbf, void *userdata);
+
+	public:
+		RomDataView *const view;
+		IRpFile *const file;
+		RomData *romData;	// Set by the worker thread.
+
+	private:
+		// Released by imagesLoaded().
+		QSemaphore semImages;
+};
+
+void RomDataViewPrivate::LoaderThread::run(void)
+{
+	// Create the RomData object.
+	romData = RomDataFactory::create(file);
+	if (!romData) {
+		// File isn't supported.
+		QMetaObject::invokeMethod(view, "loader_fieldsLoaded_slot", Qt::QueuedConnection);
+		return;
+	}
+
+	// Start loading the header images.
+	// RomData caches them, so initHeaderImages() won't have to.
+	const uint32_t imgbf = romData->supportedImageTypes() &
+		(RomData::IMGBF_INT_BANNER | RomData::IMGBF_INT_ICON);
+	const bool imagesAsync = (imgbf != 0 &&
+		romData->loadImagesAsync(imgbf, imagesLoaded, this) == 0);
+
+	// Load the fields.
+	// NOTE: Deferred tabs are loaded when they're selected.
+	romData->fieldsDeferred();
+	QMetaObject::invokeMethod(view, "loader_fieldsLoaded_slot", Qt::QueuedConnection);
+
+	if (imagesAsync) {
+		// Wait for the header images. RomDataView isn't
+		// allowed to delete this thread until they're done.
+		semImages.acquire();
+	} else if (imgbf != 0) {
+		// Unable to start the image loading thread.
+		// Load the header images here instead.
+		if (imgbf & RomData::IMGBF_INT_BANNER) {
+			romData->image(RomData::IMG_INT_BANNER);
+		}
+		if (imgbf & RomData::IMGBF_INT_ICON) {
+			romData->image(RomData::IMG_INT_ICON);
+			romData->iconAnimData();
+		}
+	}
+}
+
+/**
+ * RomData::loadImagesAsync() completion callback.
+ * @param romData RomData object.
+ * @param imgbf Bitfield of internal images that were loaded.
+ * @param userdata LoaderThread
+ */
+void RomDataViewPrivate::LoaderThread::imagesLoaded(const RomData *romData, uint32_t imgbf, void *userdata)
+{
+	Q_UNUSED(romData)
+	Q_UNUSED(imgbf)
+	LoaderThread *const loader = static_cast<LoaderThread*>(userdata);
+	QMetaObject::invokeMethod(loader->view, "loader_imagesLoaded_slot", Qt::QueuedConnection);
+	loader->semImages.release();
+}
+
 /** RomDataViewPrivate **/
 
 RomDataViewPrivate::RomDataViewPrivate(RomDataView *q, RomData *romData)
 	: q_ptr(q)
 	, romData(nullptr)
+	, loader(nullptr)
+	, headerImagesLoaded(false)
 	, btnOptions(nullptr)
 	, menuOptions(nullptr)
 	, romOps_firstActionIndex(-1)
@@ -287,15 +457,34 @@ RomDataViewPrivate::RomDataViewPrivate(RomDataView *q, RomData *romData)
 	// Register RpQImageBackend.
 	// TODO: Static initializer somewhere?
 	rp_image::setBackendCreatorFn(RpQImageBackend::creator_fn);
+
+	// Share decoded images with other processes.
+	SharedImageCache::setEnabled(true);
+
+	// Remember which RomData subclass was detected for each file.
+	DetectCache::setEnabled(true);
 }
 
 RomDataViewPrivate::~RomDataViewPrivate()
 {
+	stopLoader();
 	ui.lblIcon->clearRp();
 	ui.lblBanner->clearRp();
 	UNREF(romData);
 }
 
+/**
+ * Stop the worker thread, if it's running.
+ * NOTE: The RomData constructor can't be interrupted,
+ * so this waits for the worker thread to finish.
+ */
+void RomDataViewPrivate::stopLoader(void)
+{
+	// NOTE: LoaderThread's destructor waits for the thread.
+	delete loader;
+	loader = nullptr;
+}
+
 /**
  * Get the selected language code.
  * @return Selected language code, or 0 for none (default).
@@ -428,6 +617,21 @@ void RomDataViewPrivate::createOptionsButton(void)
 	}
 
 	/** ROM operations. **/
+	if (romData) {
+		addRomOps();
+	}
+}
+
+/**
+ * Add the RomData object's ROM operations to the "Options" menu.
+ */
+void RomDataViewPrivate::addRomOps(void)
+{
+	assert(romData != nullptr);
+	if (!menuOptions || romOps_firstActionIndex >= 0)
+		return;
+
+	Q_Q(RomDataView);
 	const vector<RomData::RomOp> ops = romData->romOps();
 	if (!ops.empty()) {
 		menuOptions->addSeparator();
@@ -484,6 +688,20 @@ void RomDataViewPrivate::initHeaderRow(void)
 	ui.lblSysInfo->setText(sysInfo);
 	ui.lblSysInfo->show();
 
+	if (loader && !headerImagesLoaded) {
+		// The header images are still being loaded.
+		ui.lblBanner->hide();
+		ui.lblIcon->hide();
+		return;
+	}
+	initHeaderImages();
+}
+
+/**
+ * Initialize the banner and icon in the header row.
+ */
+void RomDataViewPrivate::initHeaderImages(void)
+{
 	// Supported image types.
 	const uint32_t imgbf = romData->supportedImageTypes();
 
@@ -575,8 +793,8 @@ QLabel *RomDataViewPrivate::initString(QLabel *lblDesc,
 		QString text;
 		if (str) {
 			text = *str;
-		} else if (field.data.str) {
-			text = U82Q(*(field.data.str));
+		} else if (field.data.str.data) {
+			text = U82Q(field.data.str.data, static_cast<int>(field.data.str.size));
 		}
 		text.replace(QChar(L'\n'), QLatin1String("<br/>"));
 		lblString->setText(text);
@@ -588,8 +806,8 @@ QLabel *RomDataViewPrivate::initString(QLabel *lblDesc,
 		lblString->setTextFormat(Qt::PlainText);
 		if (str) {
 			lblString->setText(*str);
-		} else if (field.data.str) {
-			lblString->setText(U82Q(*(field.data.str)));
+		} else if (field.data.str.data) {
+			lblString->setText(U82Q(field.data.str.data, static_cast<int>(field.data.str.size)));
 		}
 	}
 
@@ -722,7 +940,7 @@ void RomDataViewPrivate::initBitfield(QLabel *lblDesc,
 void RomDataViewPrivate::initListData(QLabel *lblDesc,
 	const RomFields::Field &field, int fieldIdx)
 {
-	// ListData type. Create a QTreeWidget.
+	// ListData type. Create a QTreeView.
 	const auto &listDataDesc = field.desc.list_data;
 	// NOTE: listDataDesc.names can be nullptr,
 	// which means we don't have any column headers.
@@ -786,153 +1004,84 @@ void RomDataViewPrivate::initListData(QLabel *lblDesc,
 	}
 
 	Q_Q(RomDataView);
-	QTreeWidget *treeWidget;
-	Qt::ItemFlags itemFlags;
+	QTreeView *treeView;
 	if (hasIcons) {
-		treeWidget = new DragImageTreeWidget(q);
-		treeWidget->setDragEnabled(true);
-		treeWidget->setDefaultDropAction(Qt::CopyAction);
-		treeWidget->setDragDropMode(QAbstractItemView::InternalMove);
-		itemFlags = Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+		treeView = new DragImageTreeView(q);
+		treeView->setDragEnabled(true);
+		treeView->setDefaultDropAction(Qt::CopyAction);
+		treeView->setDragDropMode(QAbstractItemView::InternalMove);
 		// TODO: Get multi-image drag & drop working.
-		//treeWidget->setSelectionMode(QAbstractItemView::ExtendedSelection);
-		treeWidget->setSelectionMode(QAbstractItemView::SingleSelection);
+		//treeView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+		treeView->setSelectionMode(QAbstractItemView::SingleSelection);
 	} else {
-		treeWidget = new QTreeWidget(q);
-		itemFlags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
-		treeWidget->setSelectionMode(QAbstractItemView::SingleSelection);
+		treeView = new QTreeView(q);
+		treeView->setSelectionMode(QAbstractItemView::SingleSelection);
 	}
-	treeWidget->setRootIsDecorated(false);
-	treeWidget->setAlternatingRowColors(true);
+	treeView->setRootIsDecorated(false);
+	treeView->setAlternatingRowColors(true);
 
 	// DISABLED uniform row heights.
 	// Some Xbox 360 achievements take up two lines,
 	// while others might take up three or more.
-	treeWidget->setUniformRowHeights(false);
-
-	// Format table.
-	// All values are known to fit in uint8_t.
-	// NOTE: Need to include AlignVCenter.
-	static const uint8_t align_tbl[4] = {
-		// Order: TXA_D, TXA_L, TXA_C, TXA_R
-		Qt::AlignLeft | Qt::AlignVCenter,
-		Qt::AlignLeft | Qt::AlignVCenter,
-		Qt::AlignCenter,
-		Qt::AlignRight | Qt::AlignVCenter,
-	};
+	treeView->setUniformRowHeights(false);
+
+	// Set up the model.
+	// NOTE: ListDataModel reads the strings directly from the
+	// ListData_t, so only the visible rows are converted.
+	// For RFT_LISTDATA_MULTI, updateMulti() sets the language.
+	ListDataModel *const model = new ListDataModel(treeView);
+	model->setField(&field);
+	treeView->setModel(model);
 
-	// Set up the column names.
-	treeWidget->setColumnCount(colCount);
 	if (listDataDesc.names) {
-		QStringList columnNames;
-		columnNames.reserve(colCount);
-		QTreeWidgetItem *const header = treeWidget->headerItem();
-		uint32_t align = listDataDesc.alignment.headers;
+		// Hide columns with no names.
 		auto iter = listDataDesc.names->cbegin();
-		for (int col = 0; col < colCount; col++, ++iter, align >>= 2) {
-			header->setTextAlignment(col, align_tbl[align & 3]);
-
-			const string &name = *iter;
-			if (!name.empty()) {
-				columnNames.append(U82Q(name));
-			} else {
-				// Don't show this column.
-				columnNames.append(QString());
-				treeWidget->setColumnHidden(col, true);
+		for (int col = 0; col < colCount; col++, ++iter) {
+			if (iter->empty()) {
+				treeView->setColumnHidden(col, true);
 			}
 		}
-		treeWidget->setHeaderLabels(columnNames);
 	} else {
 		// Hide the header.
-		treeWidget->header()->hide();
+		treeView->header()->hide();
 	}
 
 	if (hasIcons) {
 		// TODO: Ideal icon size?
 		// Using 32x32 for now.
-		treeWidget->setIconSize(QSize(32, 32));
-	}
-
-	// Add the row data.
-	// NOTE: For RFT_STRING_MULTI, we're only adding placeholder rows.
-	uint32_t checkboxes = 0;
-	if (hasCheckboxes) {
-		checkboxes = field.data.list_data.mxd.checkboxes;
-	}
-
-	unsigned int row = 0;	// for icons [TODO: Use iterator?]
-	const auto list_data_cend = list_data->cend();
-	for (auto iter = list_data->cbegin(); iter != list_data_cend; ++iter, row++) {
-		const vector<string> &data_row = *iter;
-		// FIXME: Skip even if we don't have checkboxes?
-		// (also check other UI frontends)
-		if (hasCheckboxes && data_row.empty()) {
-			// Skip this row.
-			checkboxes >>= 1;
-			continue;
-		}
-
-		QTreeWidgetItem *const treeWidgetItem = new QTreeWidgetItem(treeWidget);
-		if (hasCheckboxes) {
-			// The checkbox will only show up if setCheckState()
-			// is called at least once, regardless of value.
-			treeWidgetItem->setCheckState(0, (checkboxes & 1) ? Qt::Checked : Qt::Unchecked);
-			checkboxes >>= 1;
-		} else if (hasIcons) {
-			const rp_image *const icon = field.data.list_data.mxd.icons->at(row);
-			if (icon) {
-				treeWidgetItem->setIcon(0, QIcon(
-					QPixmap::fromImage(rpToQImage(icon))));
-				treeWidgetItem->setData(0, DragImageTreeWidget::RpImageRole,
-					QVariant::fromValue((void*)icon));
-			}
-		}
-
-		// Set item flags.
-		treeWidgetItem->setFlags(itemFlags);
-
-		int col = 0;
-		uint32_t align = listDataDesc.alignment.data;
-		const auto data_row_cend = data_row.cend();
-		for (auto iter = data_row.cbegin(); iter != data_row_cend; ++iter) {
-			if (!isMulti) {
-				treeWidgetItem->setData(col, Qt::DisplayRole, U82Q(*iter));
-			}
-			treeWidgetItem->setTextAlignment(col, align_tbl[align & 3]);
-			col++;
-			align >>= 2;
-		}
+		treeView->setIconSize(QSize(32, 32));
 	}
 
 	if (!isMulti) {
 		// Resize the columns to fit the contents.
+		// NOTE: QTreeView only checks the rows near the viewport.
 		for (int i = 0; i < colCount; i++) {
-			treeWidget->resizeColumnToContents(i);
+			treeView->resizeColumnToContents(i);
 		}
-		treeWidget->resizeColumnToContents(colCount);
+		treeView->resizeColumnToContents(colCount);
 	}
 
 	if (listDataDesc.flags & RomFields::RFT_LISTDATA_SEPARATE_ROW) {
 		// Separate rows.
 		tabs[field.tabIdx].form->addRow(lblDesc);
-		tabs[field.tabIdx].form->addRow(treeWidget);
+		tabs[field.tabIdx].form->addRow(treeView);
 	} else {
 		// Single row.
-		tabs[field.tabIdx].form->addRow(lblDesc, treeWidget);
+		tabs[field.tabIdx].form->addRow(lblDesc, treeView);
 	}
-	map_fieldIdx.insert(std::make_pair(fieldIdx, treeWidget));
+	map_fieldIdx.insert(std::make_pair(fieldIdx, treeView));
 
 	// Row height is recalculated when the window is first visible
 	// and/or the system theme is changed.
 	// TODO: Set an actual default number of rows, or let Qt handle it?
 	// (Windows uses 5.)
-	treeWidget->setProperty("RFT_LISTDATA_rows_visible", listDataDesc.rows_visible);
+	treeView->setProperty("RFT_LISTDATA_rows_visible", listDataDesc.rows_visible);
 
 	// Install the event filter.
-	treeWidget->installEventFilter(q);
+	treeView->installEventFilter(q);
 
 	if (isMulti) {
-		vecListDataMulti.emplace_back(std::make_pair(treeWidget, &field));
+		vecListDataMulti.emplace_back(std::make_pair(treeView, fieldIdx));
 	}
 }
 
@@ -959,25 +1108,25 @@ void RomDataViewPrivate::adjustListData(int tabIdx)
 		return;
 	}
 
-	QTreeWidget *const treeWidget = qobject_cast<QTreeWidget*>(liField->widget());
-	if (!treeWidget) {
-		// Not a QTreeWidget.
+	QTreeView *const treeView = qobject_cast<QTreeView*>(liField->widget());
+	if (!treeView) {
+		// Not a QTreeView.
 		return;
 	}
 
-	// Move the treeWidget to the QVBoxLayout.
+	// Move the treeView to the QVBoxLayout.
 	int newRow = tab.vbox->count();
 	if (tab.lblCredits) {
 		newRow--;
 	}
 	assert(newRow >= 0);
 	tab.form->removeItem(liField);
-	tab.vbox->insertWidget(newRow, treeWidget, 999, Qt::Alignment());
+	tab.vbox->insertWidget(newRow, treeView, 999, Qt::Alignment());
 	delete liField;
 
 	// Unset this property to prevent the event filter from
 	// setting a fixed height.
-	treeWidget->setProperty("RFT_LISTDATA_rows_visible", QVariant());
+	treeView->setProperty("RFT_LISTDATA_rows_visible", QVariant());
 }
 
 /**
@@ -1116,7 +1265,7 @@ void RomDataViewPrivate::initStringMulti(QLabel *lblDesc,
 	QString qs_empty;
 	QLabel *const lblStringMulti = initString(lblDesc, field, fieldIdx, &qs_empty);
 	if (lblStringMulti) {
-		vecStringMulti.emplace_back(std::make_pair(lblStringMulti, &field));
+		vecStringMulti.emplace_back(std::make_pair(lblStringMulti, fieldIdx));
 	}
 }
 
@@ -1130,11 +1279,21 @@ void RomDataViewPrivate::updateMulti(uint32_t user_lc)
 	// NOTE: Using std::set instead of QSet for sorting.
 	set<uint32_t> set_lc;
 
+	const RomFields *const pFields = romData->fieldsDeferred();
+	assert(pFields != nullptr);
+	if (!pFields) {
+		// No fields.
+		return;
+	}
+
 	// RFT_STRING_MULTI
 	const auto vecStringMulti_cend = vecStringMulti.cend();
 	for (auto iter = vecStringMulti.cbegin(); iter != vecStringMulti_cend; ++iter) {
 		QLabel *const lblString = iter->first;
-		const RomFields::Field *const pField = iter->second;
+		const RomFields::Field *const pField = pFields->at(iter->second);
+		assert(pField != nullptr);
+		if (!pField)
+			continue;
 		const auto *const pStr_multi = pField->data.str_multi;
 		assert(pStr_multi != nullptr);
 		assert(!pStr_multi->empty());
@@ -1163,8 +1322,11 @@ void RomDataViewPrivate::updateMulti(uint32_t user_lc)
 	// RFT_LISTDATA_MULTI
 	const auto vecListDataMulti_cend = vecListDataMulti.cend();
 	for (auto iter = vecListDataMulti.cbegin(); iter != vecListDataMulti_cend; ++iter) {
-		QTreeWidget *const treeWidget = iter->first;
-		const RomFields::Field *const pField = iter->second;
+		QTreeView *const treeView = iter->first;
+		const RomFields::Field *const pField = pFields->at(iter->second);
+		assert(pField != nullptr);
+		if (!pField)
+			continue;
 		const auto *const pListData_multi = pField->data.list_data.data.multi;
 		assert(pListData_multi != nullptr);
 		assert(!pListData_multi->empty());
@@ -1189,29 +1351,20 @@ void RomDataViewPrivate::updateMulti(uint32_t user_lc)
 		assert(pListData != nullptr);
 		if (pListData != nullptr) {
 			// Update the list.
-			const int rowCount = treeWidget->topLevelItemCount();
-			auto iter_listData = pListData->cbegin();
-			const auto pListData_cend = pListData->cend();
-			for (int row = 0; row < rowCount && iter_listData != pListData_cend; row++, ++iter_listData) {
-				QTreeWidgetItem *const treeWidgetItem = treeWidget->topLevelItem(row);
-
-				int col = 0;
-				const auto iter_listData_cend = iter_listData->cend();
-				for (auto iter_row = iter_listData->cbegin();
-				     iter_row != iter_listData_cend; ++iter_row, col++)
-				{
-					treeWidgetItem->setData(col, Qt::DisplayRole, U82Q(*iter_row));
-				}
+			ListDataModel *const model = qobject_cast<ListDataModel*>(treeView->model());
+			assert(model != nullptr);
+			if (model) {
+				model->setListData(pListData);
 			}
 
 			// Resize the columns to fit the contents.
 			// NOTE: Only done on first load.
 			if (!cboLanguage) {
-				const int colCount = treeWidget->columnCount();
+				const int colCount = treeView->model()->columnCount();
 				for (int i = 0; i < colCount; i++) {
-					treeWidget->resizeColumnToContents(i);
+					treeView->resizeColumnToContents(i);
 				}
-				treeWidget->resizeColumnToContents(colCount);
+				treeView->resizeColumnToContents(colCount);
 			}
 		}
 	}
@@ -1292,7 +1445,7 @@ void RomDataViewPrivate::updateMulti(uint32_t user_lc)
  */
 int RomDataViewPrivate::updateField(int fieldIdx)
 {
-	const RomFields *const pFields = romData->fields();
+	const RomFields *const pFields = romData->fieldsDeferred();
 	assert(pFields != nullptr);
 	if (!pFields) {
 		// No fields.
@@ -1338,8 +1491,8 @@ int RomDataViewPrivate::updateField(int fieldIdx)
 				break;
 			}
 
-			if (field->data.str) {
-				label->setText(U82Q(*(field->data.str)));
+			if (field->data.str.data) {
+				label->setText(U82Q(field->data.str.data, static_cast<int>(field->data.str.size)));
 			} else {
 				label->clear();
 			}
@@ -1435,7 +1588,8 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 	}
 
 	// Get the fields.
-	const RomFields *const pFields = romData->fields();
+	// NOTE: Deferred tabs are loaded when they're selected.
+	const RomFields *const pFields = romData->fieldsDeferred();
 	assert(pFields != nullptr);
 	if (!pFields) {
 		// No fields.
@@ -1459,6 +1613,8 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 
 			auto &tab = tabs[i];
 			QWidget *widget = new QWidget(q);
+			widget->setProperty("RFT_tabIdx", i);
+			tab.deferred = !pFields->isTabLoaded(i);
 
 			// Layouts.
 			// NOTE: We shouldn't zero out the QVBoxLayout margins here.
@@ -1470,6 +1626,13 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 			// Add the tab.
 			ui.tabWidget->addTab(widget, U82Q(name));
 		}
+
+		if (hasDeferredTabs()) {
+			// Load deferred tabs when they're selected.
+			QObject::connect(ui.tabWidget, SIGNAL(currentChanged(int)),
+			                 q, SLOT(tabWidget_currentChanged_slot(int)),
+			                 Qt::UniqueConnection);
+		}
 	} else {
 		// No tabs.
 		// Don't initialize the QTabWidget, but simulate a single
@@ -1490,11 +1653,40 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 	// TODO: Ensure the description column has the
 	// same width on all tabs.
 
+	// Create the data widgets.
+	initFieldWidgets(pFields, -1);
+
+	// Initial update of RFT_STRING_MULTI and RFT_LISTDATA_MULTI fields.
+	if (!vecStringMulti.empty() || !vecListDataMulti.empty()) {
+		def_lc = pFields->defaultLanguageCode();
+		updateMulti(0);
+	}
+
+	// Close the file.
+	// Keeping the file open may prevent the user from
+	// changing the file.
+	// NOTE: Deferred tabs may need to read from the file,
+	// so it's closed after they've been loaded.
+	// The worker thread may also still be using it.
+	if (!hasDeferredTabs() && !loader) {
+		romData->close();
+	}
+}
+
+/**
+ * Create the widgets for the fields.
+ * @param pFields RomFields
+ * @param onlyTabIdx Tab index, or -1 for all tabs that aren't deferred.
+ */
+void RomDataViewPrivate::initFieldWidgets(const RomFields *pFields, int onlyTabIdx)
+{
+	Q_Q(RomDataView);
+
 	// tr: Field description label.
 	const char *const desc_label_fmt = C_("RomDataView", "%s:");
 
 	// Create the data widgets.
-	int prevTabIdx = 0;
+	int prevTabIdx = (onlyTabIdx >= 0 ? onlyTabIdx : 0);
 	int fieldIdx = 0;
 	const auto pFields_cend = pFields->cend();
 	for (auto iter = pFields->cbegin(); iter != pFields_cend; ++iter, fieldIdx++) {
@@ -1511,6 +1703,9 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 		} else if (!tabs[tabIdx].form) {
 			// Tab name is empty. Tab is hidden.
 			continue;
+		} else if (onlyTabIdx >= 0 ? (tabIdx != onlyTabIdx) : tabs[tabIdx].deferred) {
+			// Not creating widgets for this tab right now.
+			continue;
 		}
 
 		// Did the tab index change?
@@ -1563,23 +1758,58 @@ void RomDataViewPrivate::initDisplayWidgets(void)
 		}
 	}
 
-	// Initial update of RFT_STRING_MULTI and RFT_LISTDATA_MULTI fields.
-	if (!vecStringMulti.empty() || !vecListDataMulti.empty()) {
-		def_lc = pFields->defaultLanguageCode();
-		updateMulti(0);
-	}
-
 	// Check if the last field in the last tab
 	// was RFT_LISTDATA. If it is, expand it vertically.
 	// NOTE: Only for RFT_LISTDATA_SEPARATE_ROW.
 	if (!tabs.empty()) {
-		adjustListData(static_cast<int>(tabs.size()-1));
+		adjustListData(onlyTabIdx >= 0 ? onlyTabIdx : prevTabIdx);
 	}
+}
 
-	// Close the file.
-	// Keeping the file open may prevent the user from
-	// changing the file.
-	romData->close();
+/**
+ * Load a deferred tab and create its widgets.
+ * @param tabIdx Tab index.
+ */
+void RomDataViewPrivate::loadDeferredTab(int tabIdx)
+{
+	if (!romData || tabIdx < 0 || tabIdx >= (int)tabs.size() || !tabs[tabIdx].deferred)
+		return;
+	if (loader) {
+		// The worker thread is still using the RomData object.
+		// The tab will be loaded once it's finished.
+		return;
+	}
+	tabs[tabIdx].deferred = false;
+
+	const RomFields *const pFields = romData->fieldsDeferred();
+	assert(pFields != nullptr);
+	if (!pFields)
+		return;
+
+	pFields->loadTab(tabIdx);
+	const size_t multiCount = vecStringMulti.size() + vecListDataMulti.size();
+	initFieldWidgets(pFields, tabIdx);
+
+	if (vecStringMulti.size() + vecListDataMulti.size() != multiCount) {
+		// New RFT_STRING_MULTI and/or RFT_LISTDATA_MULTI fields.
+		def_lc = pFields->defaultLanguageCode();
+		updateMulti(sel_lc());
+	}
+
+	if (!hasDeferredTabs()) {
+		// All tabs have been loaded. Close the file.
+		romData->close();
+	}
+}
+
+/**
+ * Are there any tabs whose widgets haven't been created yet?
+ * @return True if so; false if not.
+ */
+bool RomDataViewPrivate::hasDeferredTabs(void) const
+{
+	return std::any_of(tabs.cbegin(), tabs.cend(),
+		[](const RomDataViewPrivate::tab &tab) { return tab.deferred; });
 }
 
 /** RomDataView **/
@@ -1678,31 +1908,31 @@ bool RomDataView::eventFilter(QObject *object, QEvent *event)
 			return false;
 	}
 
-	// Make sure this is a QTreeWidget.
-	QTreeWidget *const treeWidget = qobject_cast<QTreeWidget*>(object);
-	if (!treeWidget) {
-		// Not a QTreeWidget.
+	// Make sure this is a QTreeView.
+	QTreeView *const treeView = qobject_cast<QTreeView*>(object);
+	if (!treeView || !treeView->model()) {
+		// Not a QTreeView.
 		return false;
 	}
 
 	// Get the requested minimum number of rows.
-	// Recalculate the row heights for this QTreeWidget.
-	const int rows_visible = treeWidget->property("RFT_LISTDATA_rows_visible").toInt();
+	// Recalculate the row heights for this QTreeView.
+	const int rows_visible = treeView->property("RFT_LISTDATA_rows_visible").toInt();
 	if (rows_visible <= 0) {
-		// This QTreeWidget doesn't have a fixed number of rows.
+		// This QTreeView doesn't have a fixed number of rows.
 		// Let Qt decide how to manage its layout.
 		return false;
 	}
 
 	// Get the height of the first item.
-	QTreeWidgetItem *const treeWidgetItem = treeWidget->topLevelItem(0);
-	assert(treeWidgetItem != nullptr);
-	if (!treeWidgetItem) {
+	const QModelIndex index = treeView->model()->index(0, 0);
+	assert(index.isValid());
+	if (!index.isValid()) {
 		// No items...
 		return false;
 	}
 
-	QRect rect = treeWidget->visualItemRect(treeWidgetItem);
+	QRect rect = treeView->visualRect(index);
 	if (rect.height() <= 0) {
 		// Item has no height?!
 		return false;
@@ -1711,15 +1941,15 @@ bool RomDataView::eventFilter(QObject *object, QEvent *event)
 	// Multiply the height by the requested number of visible rows.
 	int height = rect.height() * rows_visible;
 	// Add the header.
-	if (treeWidget->header()->isVisibleTo(treeWidget)) {
-		height += treeWidget->header()->height();
+	if (treeView->header()->isVisibleTo(treeView)) {
+		height += treeView->header()->height();
 	}
-	// Add QTreeWidget borders.
-	height += (treeWidget->frameWidth() * 2);
+	// Add QTreeView borders.
+	height += (treeView->frameWidth() * 2);
 
-	// Set the QTreeWidget height.
-	treeWidget->setMinimumHeight(height);
-	treeWidget->setMaximumHeight(height);
+	// Set the QTreeView height.
+	treeView->setMinimumHeight(height);
+	treeView->setMaximumHeight(height);
 
 	// Allow the event to propagate.
 	return false;
@@ -1759,6 +1989,25 @@ void RomDataView::cboLanguage_currentIndexChanged_slot(int index)
 	d->updateMulti(d->sel_lc());
 }
 
+/**
+ * The selected tab was changed.
+ * Deferred tabs are loaded here.
+ * @param index Tab index.
+ */
+void RomDataView::tabWidget_currentChanged_slot(int index)
+{
+	Q_D(RomDataView);
+	QWidget *const widget = d->ui.tabWidget->widget(index);
+	if (!widget)
+		return;
+
+	bool ok = false;
+	const int tabIdx = widget->property("RFT_tabIdx").toInt(&ok);
+	if (ok) {
+		d->loadDeferredTab(tabIdx);
+	}
+}
+
 /** Properties. **/
 
 /**
@@ -1791,9 +2040,15 @@ void RomDataView::setRomData(RomData *romData)
 		d->ui.lblIcon->resetAnimFrame();
 	}
 
+	// Cancel loadRomData() if it's still running.
+	d->stopLoader();
+
 	UNREF(d->romData);
 	d->romData = (romData ? romData->ref() : nullptr);
 	d->initDisplayWidgets();
+	if (d->romData) {
+		d->addRomOps();
+	}
 
 	if (romData != nullptr && prevAnimTimerRunning) {
 		// Restart the animation timer.
@@ -1804,6 +2059,136 @@ void RomDataView::setRomData(RomData *romData)
 	emit romDataChanged(romData);
 }
 
+/**
+ * Load a RomData object from a file asynchronously.
+ *
+ * A placeholder is shown while the RomData object is
+ * created and its fields are loaded on a worker thread.
+ * The fields are displayed once they're loaded, and the
+ * banner and icon are displayed after that.
+ *
+ * romDataChanged() is emitted once the fields are loaded.
+ * romDataLoadFailed() is emitted if the file isn't supported.
+ *
+ * NOTE: The file must be usable from a worker thread.
+ * The file is ref()'d until loading is complete.
+ *
+ * @param file File to load.
+ */
+void RomDataView::loadRomData(IRpFile *file)
+{
+	assert(file != nullptr);
+	if (!file)
+		return;
+
+	Q_D(RomDataView);
+	d->stopLoader();
+	setRomData(nullptr);
+	d->headerImagesLoaded = false;
+
+	// Show a placeholder while loading.
+	// tr: Shown while the ROM is being loaded.
+	d->ui.lblSysInfo->setText(U82Q(C_("RomDataView", "Loading...")));
+	d->ui.lblSysInfo->show();
+	if (d->btnOptions) {
+		d->btnOptions->setEnabled(false);
+	}
+
+	d->loader = new RomDataViewPrivate::LoaderThread(this, file);
+	connect(d->loader, SIGNAL(finished()),
+		this, SLOT(loader_finished_slot()));
+	d->loader->start();
+}
+
+/**
+ * loadRomData(): The fields have been loaded.
+ * The header images may still be loading.
+ */
+void RomDataView::loader_fieldsLoaded_slot(void)
+{
+	Q_D(RomDataView);
+	if (!d->loader) {
+		// Loading was cancelled.
+		return;
+	}
+
+	RomData *const romData = d->loader->romData;
+	if (!romData) {
+		// File isn't supported.
+		d->stopLoader();
+		d->ui.lblSysInfo->hide();
+		emit romDataLoadFailed();
+		return;
+	}
+
+	d->romData = romData->ref();
+	d->initDisplayWidgets();
+	emit romDataChanged(romData);
+}
+
+/**
+ * loadRomData(): The header images have been loaded.
+ * The fields may still be loading.
+ */
+void RomDataView::loader_imagesLoaded_slot(void)
+{
+	Q_D(RomDataView);
+	if (!d->loader) {
+		// Loading was cancelled.
+		return;
+	}
+
+	d->headerImagesLoaded = true;
+	if (!d->romData) {
+		// The fields haven't been loaded yet.
+		// initHeaderRow() will show the images.
+		return;
+	}
+
+	d->initHeaderImages();
+	if (isVisible()) {
+		d->ui.lblIcon->startAnimTimer();
+	}
+}
+
+/**
+ * loadRomData(): The worker thread has finished.
+ */
+void RomDataView::loader_finished_slot(void)
+{
+	Q_D(RomDataView);
+	if (!d->loader) {
+		// Loading was cancelled, or the file isn't supported.
+		return;
+	}
+	d->stopLoader();
+	if (!d->romData)
+		return;
+
+	if (!d->headerImagesLoaded) {
+		// The header images were loaded on the worker thread.
+		d->initHeaderImages();
+		d->headerImagesLoaded = true;
+	}
+	if (isVisible()) {
+		d->ui.lblIcon->startAnimTimer();
+	}
+
+	// ROM operations may need to access the file, so they're
+	// added once the worker thread is done with the RomData object.
+	d->addRomOps();
+	if (d->btnOptions) {
+		d->btnOptions->setEnabled(true);
+	}
+
+	// Load the current tab if it was selected while loading.
+	tabWidget_currentChanged_slot(d->ui.tabWidget->currentIndex());
+	if (!d->hasDeferredTabs()) {
+		// Close the file.
+		d->romData->close();
+	}
+}
+
 /**
  * An "Options" menu action was triggered.
  * @param id Options ID.
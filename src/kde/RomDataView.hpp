@@ -15,6 +15,10 @@
 #include "librpbase/RomData.hpp"
 Q_DECLARE_METATYPE(LibRpBase::RomData*)
 
+namespace LibRpFile {
+	class IRpFile;
+}
+
 class RomDataViewPrivate;
 class RomDataView : public QWidget
 {
@@ -72,6 +76,13 @@ class RomDataView : public QWidget
 		 */
 		void cboLanguage_currentIndexChanged_slot(int index);
 
+		/**
+		 * The selected tab was changed.
+		 * Deferred tabs are loaded here.
+		 * @param index Tab index.
+		 */
+		void tabWidget_currentChanged_slot(int index);
+
 	public:
 		/** Properties. **/
 
@@ -90,6 +101,25 @@ class RomDataView : public QWidget
 		 */
 		void setRomData(LibRpBase::RomData *romData);
 
+	public:
+		/**
+		 * Load a RomData object from a file asynchronously.
+		 *
+		 * A placeholder is shown while the RomData object is
+		 * created and its fields are loaded on a worker thread.
+		 * The fields are displayed once they're loaded, and the
+		 * banner and icon are displayed after that.
+		 *
+		 * romDataChanged() is emitted once the fields are loaded.
+		 * romDataLoadFailed() is emitted if the file isn't supported.
+		 *
+		 * NOTE: The file must be usable from a worker thread.
+		 * The file is ref()'d until loading is complete.
+		 *
+		 * @param file File to load.
+		 */
+		void loadRomData(LibRpFile::IRpFile *file);
+
 	signals:
 		/**
 		 * The RomData object has been changed.
@@ -97,12 +127,34 @@ class RomDataView : public QWidget
 		 */
 		void romDataChanged(LibRpBase::RomData *romData);
 
+		/**
+		 * loadRomData() failed because the file isn't supported.
+		 */
+		void romDataLoadFailed(void);
+
 	private slots:
 		/**
 		 * An "Options" menu action was triggered.
 		 * @param id Options ID.
 		 */
 		void menuOptions_action_triggered(int id);
+
+		/**
+		 * loadRomData(): The fields have been loaded.
+		 * The header images may still be loading.
+		 */
+		void loader_fieldsLoaded_slot(void);
+
+		/**
+		 * loadRomData(): The header images have been loaded.
+		 * The fields may still be loading.
+		 */
+		void loader_imagesLoaded_slot(void);
+
+		/**
+		 * loadRomData(): The worker thread has finished.
+		 */
+		void loader_finished_slot(void);
 };
 
 #endif /* __ROMPROPERTIES_KDE_ROMDATAVIEW_HPP__ */
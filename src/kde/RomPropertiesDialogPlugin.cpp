@@ -21,6 +21,7 @@
 // librpbase, librpfile
 using LibRpBase::RomData;
 using LibRpFile::IRpFile;
+using LibRpFile::RpFile;
 
 // libromdata
 #include "libromdata/RomDataFactory.hpp"
@@ -28,6 +29,7 @@ using LibRomData::RomDataFactory;
 
 RomPropertiesDialogPlugin::RomPropertiesDialogPlugin(KPropertiesDialog *props, const QVariantList&)
 	: super(props)
+	, m_page(nullptr)
 {
 	if (getuid() == 0 || geteuid() == 0) {
 		qCritical("*** rom-properties-" RP_KDE_LOWER "%u does not support running as root.", QT_VERSION >> 16);
@@ -48,25 +50,54 @@ RomPropertiesDialogPlugin::RomPropertiesDialogPlugin(KPropertiesDialog *props, c
 		return;
 	}
 
-	// Get the appropriate RomData class for this ROM.
-	RomData *const romData = RomDataFactory::create(file);
-	file->unref();	// file is ref()'d by RomData.
-	if (!romData) {
-		// ROM is not supported.
-		return;
+	RomDataView *romDataView;
+	if (dynamic_cast<RpFile*>(file) != nullptr) {
+		// Local file. Load the RomData object on a worker thread
+		// so the properties dialog doesn't freeze while loading.
+		// If the ROM isn't supported, the page will be removed.
+		romDataView = new RomDataView(props);
+		connect(romDataView, SIGNAL(romDataLoadFailed()),
+			this, SLOT(romDataView_loadFailed_slot()));
+		romDataView->loadRomData(file);
+		file->unref();	// file is ref()'d by RomDataView.
+	} else {
+		// Remote file. KIO jobs have to be used from the
+		// main thread, so load the RomData object here.
+		RomData *const romData = RomDataFactory::create(file);
+		file->unref();	// file is ref()'d by RomData.
+		if (!romData) {
+			// ROM is not supported.
+			return;
+		}
+
+		// ROM is supported. Show the properties.
+		romDataView = new RomDataView(romData, props);
+
+		// Make sure the underlying file handle is closed,
+		// since we don't need it once the RomData has been
+		// loaded by RomDataView.
+		romData->close();
+
+		// RomDataView takes a reference to the RomData object.
+		// We don't need to hold on to it.
+		romData->unref();
 	}
 
-	// ROM is supported. Show the properties.
-	RomDataView *const romDataView = new RomDataView(romData, props);
 	// tr: Tab title.
-	props->addPage(romDataView, U82Q(C_("RomDataView", "ROM Properties")));
-
-	// Make sure the underlying file handle is closed,
-	// since we don't need it once the RomData has been
-	// loaded by RomDataView.
-	romData->close();
+	m_page = props->addPage(romDataView, U82Q(C_("RomDataView", "ROM Properties")));
+}
 
-	// RomDataView takes a reference to the RomData object.
-	// We don't need to hold on to it.
-	romData->unref();
+/**
+ * RomDataView couldn't load the file.
+ * The "ROM Properties" page is removed.
+ */
+void RomPropertiesDialogPlugin::romDataView_loadFailed_slot(void)
+{
+	if (m_page) {
+		KPropertiesDialog *const props = qobject_cast<KPropertiesDialog*>(parent());
+		if (props) {
+			props->removePage(m_page);
+		}
+		m_page = nullptr;
+	}
 }
@@ -20,6 +20,16 @@ class Q_DECL_EXPORT RomPropertiesDialogPlugin : public KPropertiesDialogPlugin
 
 	private:
 		typedef KPropertiesDialogPlugin super;
+
+		// "ROM Properties" page.
+		KPageWidgetItem *m_page;
+
+	private slots:
+		/**
+		 * RomDataView couldn't load the file.
+		 * The "ROM Properties" page is removed.
+		 */
+		void romDataView_loadFailed_slot(void);
 };
 
 #endif /* __ROMPROPERTIES_KDE_ROMPROPERTIESDIALOGPLUGIN_HPP__ */
@@ -10,6 +10,12 @@
 #include "RomThumbCreator.hpp"
 #include "RpQImageBackend.hpp"
 
+// librpbase
+#include "librpbase/img/SharedImageCache.hpp"
+
+// librptexture
+#include "librptexture/decoder/ImageDecoder.hpp"
+
 // librpbase, librptexture
 using namespace LibRpBase;
 using LibRpTexture::rp_image;
@@ -18,8 +24,12 @@ using LibRpTexture::rp_image;
 #include "RpFile_kio.hpp"
 
 // libromdata
+#include "libromdata/DetectCache.hpp"
 #include "libromdata/RomDataFactory.hpp"
+using LibRomData::DetectCache;
 using LibRomData::RomDataFactory;
+#include "libromdata/img/RecentRomData.hpp"
+using LibRomData::RecentRomData;
 
 // TCreateThumbnail is a templated class,
 // so we have to #include the .cpp file here.
@@ -58,6 +68,16 @@ extern "C" {
 		// TODO: Static initializer somewhere?
 		rp_image::setBackendCreatorFn(RpQImageBackend::creator_fn);
 
+		// Share decoded images with other processes.
+		SharedImageCache::setEnabled(true);
+
+		// Remember which RomData subclass was detected for each file.
+		DetectCache::setEnabled(true);
+
+		// Decode large textures on the GPU if enabled.
+		LibRpTexture::ImageDecoder::setGpuDecodeEnabled(
+			Config::instance()->gpuTextureDecode());
+
 		return new RomThumbCreator();
 	}
 }
@@ -84,6 +104,15 @@ class RomThumbCreatorPrivate : public TCreateThumbnail<QImage>
 			return rpToQImage(img);
 		}
 
+		/**
+		 * Does rpImageToImgClass() keep the original image size?
+		 * @return True if rpImageToImgClass() keeps the original image size.
+		 */
+		inline bool rpImageToImgClassKeepsSize(void) const final
+		{
+			return true;
+		}
+
 		/**
 		 * Wrapper function to check if an ImgClass is valid.
 		 * @param imgClass ImgClass
@@ -230,11 +259,19 @@ bool RomThumbCreator::create(const QString &path, int width, int height, QImage
 		return false;
 	}
 
+	// Get the shared RomData object for this file.
+	const RecentRomData recentRomData(file);
+	file->unref();	// file is ref()'d by RomData.
+	RomData *const romData = recentRomData.romData();
+	if (!romData) {
+		return false;
+	}
+
 	// Assuming width and height are the same.
 	// TODO: What if they aren't?
 	Q_D(RomThumbCreator);
 	RomThumbCreatorPrivate::GetThumbnailOutParams_t outParams;
-	int ret = d->getThumbnail(file, width, &outParams);
+	int ret = d->getThumbnail(romData, width, &outParams);
 	if (ret == 0) {
 		img = outParams.retImg;
 	}
@@ -277,6 +314,14 @@ Q_DECL_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const ch
 	// TODO: Static initializer somewhere?
 	rp_image::setBackendCreatorFn(RpQImageBackend::creator_fn);
 
+	// Share decoded images with other processes.
+	// NOTE: GPU decoding isn't enabled here, since rp-stub's
+	// seccomp filter doesn't allow loading the OpenCL driver.
+	SharedImageCache::setEnabled(true);
+
+	// Remember which RomData subclass was detected for each file.
+	DetectCache::setEnabled(true);
+
 	// Attempt to open the ROM file.
 	QUrl localUrl = localizeQUrl(QUrl(QString::fromUtf8(source_file)));
 	IRpFile *const file = openQUrl(localUrl, true);
@@ -287,8 +332,11 @@ Q_DECL_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const ch
 
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
-	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
+	// NOTE: The RomData object is shared with other requests for
+	// the same file, e.g. for other thumbnail sizes.
+	const RecentRomData recentRomData(file);
 	file->unref();	// file is ref()'d by RomData.
+	RomData *const romData = recentRomData.romData();
 	if (!romData) {
 		// ROM is not supported.
 		return RPCT_SOURCE_FILE_NOT_SUPPORTED;
@@ -303,7 +351,6 @@ Q_DECL_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const ch
 
 	if (ret != 0 || outParams.retImg.isNull()) {
 		// No image.
-		romData->unref();
 		return RPCT_SOURCE_FILE_NO_IMAGE;
 	}
 
@@ -333,7 +380,6 @@ Q_DECL_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const ch
 		default:
 			// Unsupported...
 			assert(!"Unsupported QImage image format.");
-			romData->unref();
 			return RPCT_OUTPUT_FILE_FAILED;
 	}
 
@@ -342,7 +388,6 @@ Q_DECL_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const ch
 	if (!pngWriter->isOpen()) {
 		// Could not open the PNG writer.
 		delete pngWriter;
-		romData->unref();
 		return RPCT_OUTPUT_FILE_FAILED;
 	}
 
@@ -412,7 +457,6 @@ Q_DECL_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const ch
 		// Error writing IHDR.
 		// TODO: Unlink the PNG image.
 		delete pngWriter;
-		romData->unref();
 		return RPCT_OUTPUT_FILE_FAILED;
 	}
 
@@ -435,6 +479,5 @@ Q_DECL_EXPORT int RP_C_API rp_create_thumbnail(const char *source_file, const ch
 	}
 
 	delete pngWriter;
-	romData->unref();
 	return ret;
 }
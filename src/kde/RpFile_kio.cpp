@@ -9,6 +9,11 @@
 #include "stdafx.h"
 #include "RpFile_kio.hpp"
 
+// librpfile
+#include "librpfile/CachedFile.hpp"
+using LibRpFile::CachedFile;
+using LibRpFile::IRpFile;
+
 // Qt includes.
 #include <QtCore/QEventLoop>
 
@@ -191,6 +196,30 @@ void RpFileKio::init(void)
 	// TODO: Transparent gzip decompression?
 }
 
+/**
+ * Open a file with a read cache.
+ *
+ * Each read from a KIO file job may be a round trip to a
+ * remote server, e.g. for smb://, sftp://, and mtp://,
+ * so the file is wrapped in a CachedFile.
+ *
+ * @param uri KIO URI.
+ * @return IRpFile. (Check isOpen() to determine if the file was opened.)
+ */
+IRpFile *RpFileKio::openCached(const QUrl &uri)
+{
+	RpFileKio *const file = new RpFileKio(uri);
+	if (!file->isOpen()) {
+		// Unable to open the file.
+		// Return it as-is so the caller can check the error.
+		return file;
+	}
+
+	CachedFile *const cachedFile = new CachedFile(file);
+	file->unref();	// file is ref()'d by CachedFile.
+	return cachedFile;
+}
+
 RpFileKio::~RpFileKio()
 {
 	delete d_ptr;
@@ -263,6 +292,22 @@ size_t RpFileKio::read(void *ptr, size_t size)
 	return sz_read_total;
 }
 
+/**
+ * Read data from multiple file positions.
+ * Nearby requests are coalesced into a single read.
+ *
+ * NOTE: The file position is undefined afterwards.
+ *
+ * @param vec	[in] Read requests.
+ * @param count	[in] Number of read requests.
+ * @return 0 if all requests were read completely; negative POSIX error code on error.
+ */
+int RpFileKio::readv(const ReadVec *vec, size_t count)
+{
+	// KIO streams may be network files, so use a larger gap.
+	return readv_coalesced(vec, count, 64*1024);
+}
+
 /**
  * Write data to the file.
  * (NOTE: Not valid for RpMemFile; this will always return 0.)
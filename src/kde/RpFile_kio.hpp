@@ -40,6 +40,18 @@ class RpFileKio : public QObject, public LibRpFile::IRpFile
 		RpFileKio(const char *uri);
 		RpFileKio(const std::string &uri);
 		RpFileKio(const QUrl &uri);
+
+		/**
+		 * Open a file with a read cache.
+		 *
+		 * Each read from a KIO file job may be a round trip to a
+		 * remote server, e.g. for smb://, sftp://, and mtp://,
+		 * so the file is wrapped in a CachedFile.
+		 *
+		 * @param uri KIO URI.
+		 * @return IRpFile. (Check isOpen() to determine if the file was opened.)
+		 */
+		static LibRpFile::IRpFile *openCached(const QUrl &uri);
 	private:
 		void init(void);
 	protected:
@@ -74,6 +86,19 @@ class RpFileKio : public QObject, public LibRpFile::IRpFile
 		ATTR_ACCESS_SIZE(write_only, 2, 3)
 		size_t read(void *ptr, size_t size) final;
 
+		/**
+		 * Read data from multiple file positions.
+		 * Nearby requests are coalesced into a single read.
+		 *
+		 * NOTE: The file position is undefined afterwards.
+		 *
+		 * @param vec	[in] Read requests.
+		 * @param count	[in] Number of read requests.
+		 * @return 0 if all requests were read completely; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int readv(const ReadVec *vec, size_t count) final;
+
 		/**
 		 * Write data to the file.
 		 * (NOTE: Not valid for RpFileKio; this will always return 0.)
@@ -0,0 +1,88 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (KDE4/KF5)                         *
+ * RpPngMimeData.hpp: QMimeData that encodes a PNG image on request.       *
+ *                                                                         *
+ * Copyright (c) 2019-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_KDE_RPPNGMIMEDATA_HPP__
+#define __ROMPROPERTIES_KDE_RPPNGMIMEDATA_HPP__
+
+namespace LibRpBase {
+	class IconAnimData;
+}
+namespace LibRpTexture {
+	class rp_image;
+}
+
+// Qt includes.
+#include <QtCore/QByteArray>
+#include <QtCore/QMimeData>
+
+/**
+ * QMimeData for an rp_image or animated icon.
+ *
+ * The image is only encoded as PNG (or APNG) when the drop target
+ * requests the data, so drags that are cancelled or dropped on a
+ * target that doesn't accept images don't encode anything.
+ */
+class RpPngMimeData : public QMimeData
+{
+	public:
+		/**
+		 * Create an RpPngMimeData for an rp_image.
+		 * @param img rp_image. (will be ref()'d)
+		 */
+		explicit RpPngMimeData(const LibRpTexture::rp_image *img);
+
+		/**
+		 * Create an RpPngMimeData for an animated icon.
+		 * @param iconAnimData IconAnimData. (will be ref()'d)
+		 */
+		explicit RpPngMimeData(const LibRpBase::IconAnimData *iconAnimData);
+
+		~RpPngMimeData();
+
+	private:
+		typedef QMimeData super;
+		Q_DISABLE_COPY(RpPngMimeData)
+
+	public:
+		/**
+		 * Has the image been encoded yet?
+		 * @return True if encoded; false if not.
+		 */
+		bool isEncoded(void) const
+		{
+			return m_encoded;
+		}
+
+		/**
+		 * Get the PNG data, encoding the image if necessary.
+		 * @return PNG data, or an empty QByteArray on error.
+		 */
+		QByteArray pngData(void) const;
+
+		/**
+		 * Set previously-encoded PNG data for this image.
+		 * @param pngData PNG data.
+		 */
+		void setPngData(const QByteArray &pngData);
+
+	public:
+		/** Overridden QMimeData functions **/
+		QStringList formats(void) const final;
+
+	protected:
+		QVariant retrieveData(const QString &mimeType, QVariant::Type type) const final;
+
+	private:
+		const LibRpTexture::rp_image *m_img;
+		const LibRpBase::IconAnimData *m_iconAnimData;
+
+		mutable QByteArray m_pngData;
+		mutable bool m_encoded;
+};
+
+#endif /* __ROMPROPERTIES_KDE_RPPNGMIMEDATA_HPP__ */
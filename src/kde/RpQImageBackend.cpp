@@ -45,7 +45,8 @@ RpQImageBackend::RpQImageBackend(int width, int height, rp_image::Format format)
 
 	// Allocate our own memory buffer.
 	// This is needed in order to use 16-byte row alignment.
-	uint8_t *data = static_cast<uint8_t*>(aligned_malloc(16, height * this->stride));
+	uint8_t *data = static_cast<uint8_t*>(aligned_malloc_tag(
+		LibRpFile::RpAllocStats::TAG_RP_IMAGE, 16, height * this->stride));
 	if (!data) {
 		// Error allocating the memory buffer.
 		clear_properties();
@@ -187,7 +187,7 @@ IRpFile *openQUrl(const QUrl &url, bool isThumbnail)
 	} else {
 		// Remote filename. Use RpFile_kio.
 #ifdef HAVE_RPFILE_KIO
-		file = new RpFileKio(url);
+		file = RpFileKio::openCached(url);
 #else /* !HAVE_RPFILE_KIO */
 		// Not supported...
 		return nullptr;
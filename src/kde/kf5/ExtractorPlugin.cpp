@@ -58,18 +58,20 @@ ExtractorPlugin::ExtractorPlugin(QObject *parent)
 
 QStringList ExtractorPlugin::mimetypes(void) const
 {
+	if (!m_mimeTypes.isEmpty()) {
+		// MIME types were already converted.
+		return m_mimeTypes;
+	}
+
 	// Get the MIME types from RomDataFactory.
 	const vector<const char*> &vec_mimeTypes = RomDataFactory::supportedMimeTypes();
 
 	// Convert to QStringList.
-	QStringList mimeTypes;
-	mimeTypes.reserve(static_cast<int>(vec_mimeTypes.size()));
-	std::for_each(vec_mimeTypes.cbegin(), vec_mimeTypes.cend(),
-		[&mimeTypes](const char *mimeType) {
-			mimeTypes += QLatin1String(mimeType);
-		}
-	);
-	return mimeTypes;
+	m_mimeTypes.reserve(static_cast<int>(vec_mimeTypes.size()));
+	for (const char *mimeType : vec_mimeTypes) {
+		m_mimeTypes += QLatin1String(mimeType);
+	}
+	return m_mimeTypes;
 }
 
 void ExtractorPlugin::extract(ExtractionResult *result)
@@ -83,7 +85,8 @@ void ExtractorPlugin::extract(ExtractionResult *result)
 
 	// Get the appropriate RomData class for this ROM.
 	// file is dup()'d by RomData.
-	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_METADATA);
+	RomData *const romData = RomDataFactory::create(file,
+		RomDataFactory::RDA_HAS_METADATA | RomDataFactory::RDA_METADATA_ONLY);
 	file->unref();	// file is ref()'d by RomData.
 	if (!romData) {
 		// ROM is not supported.
@@ -33,6 +33,11 @@ class ExtractorPlugin final : public ::KFileMetaData::ExtractorPlugin
 	public:
 		QStringList mimetypes(void) const final;
 		void extract(KFileMetaData::ExtractionResult *result) final;
+
+	private:
+		// MIME types. Converted on the first call to mimetypes().
+		// QStringList is implicitly shared, so returning it is cheap.
+		mutable QStringList m_mimeTypes;
 };
 
 // Exported function pointer to create a new RpExtractorPlugin.
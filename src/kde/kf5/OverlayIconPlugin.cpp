@@ -15,7 +15,7 @@
 
 // librpbase, librpfile
 using namespace LibRpBase;
-using LibRpFile::IRpFile;
+using namespace LibRpFile;
 
 // libromdata
 #include "libromdata/RomDataFactory.hpp"
@@ -61,7 +61,7 @@ OverlayIconPlugin::OverlayIconPlugin(QObject *parent)
 
 QStringList OverlayIconPlugin::getOverlays(const QUrl &item)
 {
-	// TODO: Check for slow devices and/or cache this?
+	// TODO: Check for slow devices?
 	QStringList sl;
 
 	const Config *const config = Config::instance();
@@ -70,7 +70,32 @@ QStringList OverlayIconPlugin::getOverlays(const QUrl &item)
 		return sl;
 	}
 
-	// Attempt to open the ROM file.
+	// Only a few RomData subclasses can have "dangerous" permissions.
+	// Check the file extension before doing any file I/O.
+	if (!RomDataFactory::isDangerousPermissionsCandidate(item.fileName().toUtf8().constData())) {
+		// Not a candidate.
+		return sl;
+	}
+
+	const QUrl localUrl = localizeQUrl(item);
+	if (!localUrl.isEmpty() && (localUrl.scheme().isEmpty() || localUrl.isLocalFile())) {
+		// This is a local file.
+		const string s_local_filename = localUrl.toLocalFile().toUtf8().constData();
+		if (FileSystem::isOnBadFS(s_local_filename.c_str(), config->enableThumbnailOnNetworkFS())) {
+			// This file is on a "bad" file system.
+			return sl;
+		}
+
+		// If the ROM image has "dangerous" permissions,
+		// return the "security-medium" overlay icon.
+		// NOTE: The result is cached by RomDataFactory.
+		if (RomDataFactory::hasDangerousPermissions(s_local_filename.c_str())) {
+			sl += QLatin1String("security-medium");
+		}
+		return sl;
+	}
+
+	// Remote file. Attempt to open the ROM file.
 	IRpFile *const file = openQUrl(item, true);
 	if (!file) {
 		// Could not open the file.
@@ -88,7 +88,7 @@
 #include <QSpacerItem>
 #include <QStyle>
 #include <QStyledItemDelegate>
-#include <QTreeWidget>
+#include <QTreeView>
 #include <QWidget>
 
 #include <QFormLayout>
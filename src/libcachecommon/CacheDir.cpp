@@ -74,4 +74,23 @@ const std::string &getCacheDirectory(void)
 	return cache_dir;
 }
 
+#ifndef _WIN32
+/**
+ * Get the rp-download daemon's socket filename.
+ * This is located in the cache directory.
+ * @return Socket filename, or empty string on error.
+ */
+string getDownloadSocketFilename(void)
+{
+	const string &cache_dir = getCacheDirectory();
+	if (cache_dir.empty())
+		return string();
+
+	string sock_filename = cache_dir;
+	sock_filename += DIR_SEP_CHR;
+	sock_filename += "rp-download.sock";
+	return sock_filename;
+}
+#endif /* !_WIN32 */
+
 }
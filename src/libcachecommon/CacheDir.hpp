@@ -24,6 +24,15 @@ namespace LibCacheCommon {
  */
 const std::string &getCacheDirectory(void);
 
+#ifndef _WIN32
+/**
+ * Get the rp-download daemon's socket filename.
+ * This is located in the cache directory.
+ * @return Socket filename, or empty string on error.
+ */
+std::string getDownloadSocketFilename(void);
+#endif /* !_WIN32 */
+
 }
 
 #endif /* __ROMPROPERTIES_LIBCACHECOMMON_CACHEDIR_HPP__ */
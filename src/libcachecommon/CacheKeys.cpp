@@ -17,6 +17,9 @@
 #include <cstring>
 #include <stdint.h>
 
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
 // C++ STL classes.
 using std::string;
 #ifdef _WIN32
@@ -30,6 +33,7 @@ using std::wstring;
 # define DIR_SEP_WCHR L'\\'
 #else /* !_WIN32 */
 # define DIR_SEP_CHR '/'
+# include <sys/stat.h>	/* for mkdir() */
 # include <unistd.h>	/* for R_OK */
 #endif /* _WIN32 */
 
@@ -302,6 +306,214 @@ int filterCacheKey(wchar_t *pCacheKey)
 }
 #endif /* _WIN32 */
 
+/** Fan-out layout **/
+// pthread_once() control variable.
+static pthread_once_t fanout_once_control = PTHREAD_ONCE_INIT;
+// Is the fan-out layout in use?
+static bool fanout_enabled = false;
+
+/**
+ * Check for the fan-out layout marker file.
+ * Called by pthread_once().
+ */
+static void initFanOutLayout(void)
+{
+	const string &cache_dir = getCacheDirectory();
+	if (cache_dir.empty())
+		return;
+
+	string marker = cache_dir;
+	if (marker.at(marker.size()-1) != DIR_SEP_CHR) {
+		marker += DIR_SEP_CHR;
+	}
+	marker += FANOUT_MARKER_FILE;
+#ifdef _WIN32
+	const DWORD dwAttrs = GetFileAttributesA(marker.c_str());
+	fanout_enabled = (dwAttrs != INVALID_FILE_ATTRIBUTES &&
+			  !(dwAttrs & FILE_ATTRIBUTE_DIRECTORY));
+#else /* !_WIN32 */
+	fanout_enabled = (access(marker.c_str(), F_OK) == 0);
+#endif /* _WIN32 */
+}
+
+/**
+ * Is the user's cache directory using the fan-out layout?
+ * @return True if the fan-out layout is in use; false if not.
+ */
+bool isFanOutLayout(void)
+{
+	pthread_once(&fanout_once_control, initFanOutLayout);
+	return fanout_enabled;
+}
+
+/**
+ * Convert a filtered cache key to a fan-out cache key.
+ * Content store keys are returned as-is, since they're already fanned out.
+ * @param pFilteredKey Filtered cache key. (Must be UTF-8, NULL-terminated.)
+ * @return Fan-out cache key, e.g. "wii/disc/US/a8/c0/RMGE01.png"
+ */
+string getFanOutKey(const char *pFilteredKey)
+{
+	assert(pFilteredKey != nullptr);
+	if (!pFilteredKey) {
+		return string();
+	}
+
+	// Content store keys are already fanned out.
+	static const char store_prefix[] = CONTENT_STORE_DIR;
+	static const size_t store_prefix_len = sizeof(store_prefix) - 1;
+	if (!strncmp(pFilteredKey, store_prefix, store_prefix_len) &&
+	    (pFilteredKey[store_prefix_len] == '/' || pFilteredKey[store_prefix_len] == '\\'))
+	{
+		return string(pFilteredKey);
+	}
+
+	// 32-bit FNV-1a of the whole key.
+	// Separators are hashed as '/' so Windows and
+	// non-Windows systems use the same directories.
+	uint32_t hash = 0x811C9DC5U;
+	const char *slash = nullptr;
+	for (const char *p = pFilteredKey; *p != '\0'; p++) {
+		char chr = *p;
+		if (chr == '/' || chr == '\\') {
+			chr = '/';
+			slash = p;
+		}
+		hash ^= static_cast<uint8_t>(chr);
+		hash *= 0x01000193U;
+	}
+
+	// Insert the two fan-out levels before the filename.
+	// NOTE: The separator used in the key is kept.
+	const char sep = (slash ? *slash : DIR_SEP_CHR);
+	char fanout[8];
+	snprintf(fanout, sizeof(fanout), "%02x%c%02x%c",
+		static_cast<unsigned int>(hash >> 24), sep,
+		static_cast<unsigned int>((hash >> 16) & 0xFF), sep);
+
+	string key;
+	const size_t dir_len = (slash ? (slash - pFilteredKey + 1) : 0);
+	key.reserve(strlen(pFilteredKey) + 6);
+	key.assign(pFilteredKey, dir_len);
+	key += fanout;
+	key += &pFilteredKey[dir_len];
+	return key;
+}
+
+#ifndef _WIN32
+/**
+ * Move a cache file from the flat layout to the fan-out layout.
+ * The fan-out directories are created if necessary.
+ * @param flatFilename Cache filename in the flat layout.
+ * @param fanOutFilename Cache filename in the fan-out layout.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int migrateToFanOut(const string &flatFilename, const string &fanOutFilename)
+{
+	// Create the two fan-out directories.
+	// The parent directory already exists, since it has the flat file.
+	const size_t slash2 = fanOutFilename.rfind(DIR_SEP_CHR);
+	if (slash2 == string::npos || slash2 == 0) {
+		return -EINVAL;
+	}
+	const size_t slash1 = fanOutFilename.rfind(DIR_SEP_CHR, slash2 - 1);
+	if (slash1 == string::npos) {
+		return -EINVAL;
+	}
+
+	string dir;
+	for (int i = 0; i < 2; i++) {
+		dir.assign(fanOutFilename, 0, (i == 0 ? slash1 : slash2));
+		if (mkdir(dir.c_str(), 0777) != 0 && errno != EEXIST) {
+			return -errno;
+		}
+	}
+
+	if (rename(flatFilename.c_str(), fanOutFilename.c_str()) != 0) {
+		return -errno;
+	}
+	return 0;
+}
+#else /* _WIN32 */
+/**
+ * Move a cache file from the flat layout to the fan-out layout.
+ * The fan-out directories are created if necessary.
+ * @param flatFilename Cache filename in the flat layout.
+ * @param fanOutFilename Cache filename in the fan-out layout.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int migrateToFanOut(const wstring &flatFilename, const wstring &fanOutFilename)
+{
+	// Create the two fan-out directories.
+	// The parent directory already exists, since it has the flat file.
+	const size_t slash2 = fanOutFilename.rfind(DIR_SEP_WCHR);
+	if (slash2 == wstring::npos || slash2 == 0) {
+		return -EINVAL;
+	}
+	const size_t slash1 = fanOutFilename.rfind(DIR_SEP_WCHR, slash2 - 1);
+	if (slash1 == wstring::npos) {
+		return -EINVAL;
+	}
+
+	wstring dir;
+	for (int i = 0; i < 2; i++) {
+		dir.assign(fanOutFilename, 0, (i == 0 ? slash1 : slash2));
+		if (!CreateDirectoryW(dir.c_str(), nullptr) &&
+		    GetLastError() != ERROR_ALREADY_EXISTS)
+		{
+			return -EIO;
+		}
+	}
+
+	if (!MoveFileW(flatFilename.c_str(), fanOutFilename.c_str())) {
+		return -EIO;
+	}
+	return 0;
+}
+
+/**
+ * Internal U82W() function.
+ * @param mbs UTF-8 string.
+ * @return UTF-16 C++ string.
+ */
+static inline wstring U82W(const string &mbs)
+{
+	wstring ws_ret;
+
+	int cchWcs = MultiByteToWideChar(CP_UTF8, 0, mbs.c_str(), static_cast<int>(mbs.size()), nullptr, 0);
+	if (cchWcs <= 0) {
+		return ws_ret;
+	}
+
+	wchar_t *wcs = new wchar_t[cchWcs];
+	MultiByteToWideChar(CP_UTF8, 0, mbs.c_str(), static_cast<int>(mbs.size()), wcs, cchWcs);
+	ws_ret.assign(wcs, cchWcs);
+	delete[] wcs;
+	return ws_ret;
+}
+
+/**
+ * Internal W2U8() function.
+ * @param wcs UTF-16 string.
+ * @return UTF-8 C++ string.
+ */
+static inline string W2U8(const wstring &wcs)
+{
+	string s_ret;
+
+	int cbMbs = WideCharToMultiByte(CP_UTF8, 0, wcs.c_str(), static_cast<int>(wcs.size()), nullptr, 0, nullptr, nullptr);
+	if (cbMbs <= 0) {
+		return s_ret;
+	}
+
+	char *mbs = new char[cbMbs];
+	WideCharToMultiByte(CP_UTF8, 0, wcs.c_str(), static_cast<int>(wcs.size()), mbs, cbMbs, nullptr, nullptr);
+	s_ret.assign(mbs, cbMbs);
+	delete[] mbs;
+	return s_ret;
+}
+#endif /* _WIN32 */
+
 /**
  * Combine a cache key with the cache directory to get a cache filename.
  * @param cacheKey Cache key. (Must be UTF-8, NULL-terminated.) (Will be filtered using filterCacheKey().)
@@ -338,10 +550,36 @@ string getCacheFilename(const char *pCacheKey)
 		if (cacheFilename_user.at(cacheFilename_user.size()-1) != DIR_SEP_CHR) {
 			cacheFilename_user += DIR_SEP_CHR;
 		}
+		const size_t dir_len = cacheFilename_user.size();
 		cacheFilename_user += filteredCacheKey;
+
+		if (isFanOutLayout()) {
+			// Fan-out layout. If the file is still in the flat
+			// layout, move it to the fan-out layout.
+			string flatFilename;
+			flatFilename.swap(cacheFilename_user);
+			cacheFilename_user.assign(flatFilename, 0, dir_len);
+			cacheFilename_user += getFanOutKey(filteredCacheKey.c_str());
+#ifdef _WIN32
+			const wstring wflat = U82W(flatFilename);
+			const wstring wfanout = U82W(cacheFilename_user);
+			if (GetFileAttributesW(wfanout.c_str()) == INVALID_FILE_ATTRIBUTES &&
+			    GetFileAttributesW(wflat.c_str()) != INVALID_FILE_ATTRIBUTES)
+			{
+				migrateToFanOut(wflat, wfanout);
+			}
+#else /* !_WIN32 */
+			if (access(cacheFilename_user.c_str(), F_OK) != 0 &&
+			    access(flatFilename.c_str(), F_OK) == 0)
+			{
+				migrateToFanOut(flatFilename, cacheFilename_user);
+			}
+#endif /* _WIN32 */
+		}
 	}
 
 #ifdef DIR_INSTALL_CACHE
+	// NOTE: The system-wide cache directory always uses the flat layout.
 	// If the requested file is in the system-wide cache directory,
 	// but is not in the user's cache directory, use the system-wide
 	// version. This is useful in cases where the thumbnailer cannot
@@ -368,27 +606,6 @@ string getCacheFilename(const char *pCacheKey)
 }
 
 #ifdef _WIN32
-/**
- * Internal U82W() function.
- * @param mbs UTF-8 string.
- * @return UTF-16 C++ string.
- */
-static inline wstring U82W(const string &mbs)
-{
-	wstring ws_ret;
-
-	int cchWcs = MultiByteToWideChar(CP_UTF8, 0, mbs.c_str(), static_cast<int>(mbs.size()), nullptr, 0);
-	if (cchWcs <= 0) {
-		return ws_ret;
-	}
-
-	wchar_t *wcs = new wchar_t[cchWcs];
-	MultiByteToWideChar(CP_UTF8, 0, mbs.c_str(), static_cast<int>(mbs.size()), wcs, cchWcs);
-	ws_ret.assign(wcs, cchWcs);
-	delete[] wcs;
-	return ws_ret;
-}
-
 /**
  * Combine a cache key with the cache directory to get a cache filename.
  * @param cacheKey Cache key. (Must be UTF-16.) (Will be filtered using filterCacheKey().)
@@ -425,11 +642,71 @@ wstring getCacheFilename(const wchar_t *pCacheKey)
 	if (cacheFilename_user.at(cacheFilename_user.size()-1) != DIR_SEP_WCHR) {
 		cacheFilename_user += DIR_SEP_WCHR;
 	}
-	cacheFilename_user += filteredCacheKey;
+
+	if (!isFanOutLayout()) {
+		// Flat layout.
+		cacheFilename_user += filteredCacheKey;
+		return cacheFilename_user;
+	}
+
+	// Fan-out layout. If the file is still in the flat
+	// layout, move it to the fan-out layout.
+	// NOTE: The fan-out directories are based on the UTF-8 key.
+	wstring flatFilename = cacheFilename_user;
+	flatFilename += filteredCacheKey;
+	cacheFilename_user += U82W(getFanOutKey(W2U8(filteredCacheKey).c_str()));
+	if (GetFileAttributesW(cacheFilename_user.c_str()) == INVALID_FILE_ATTRIBUTES &&
+	    GetFileAttributesW(flatFilename.c_str()) != INVALID_FILE_ATTRIBUTES)
+	{
+		migrateToFanOut(flatFilename, cacheFilename_user);
+	}
 	return cacheFilename_user;
 }
 #endif /* _WIN32 */
 
+/**
+ * Get the content store key for a downloaded file.
+ *
+ * Files with identical contents have the same content store key,
+ * so they're only stored once. Cache files are hardlinked to the
+ * corresponding file in the content store.
+ *
+ * NOTE: The key is based on a 64-bit FNV-1a hash, so the file
+ * contents must be compared before linking to an existing file.
+ *
+ * @param data File data.
+ * @param size Size of data, in bytes.
+ * @param ext File extension, including the leading dot. (e.g. ".png")
+ * @return Content store key, e.g. "by-hash/3f/3f1c0d2e4b5a6978.png"
+ */
+string getContentStoreKey(const void *data, size_t size, const char *ext)
+{
+	assert(data != nullptr || size == 0);
+	assert(ext != nullptr);
+
+	// 64-bit FNV-1a
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	const uint8_t *p = static_cast<const uint8_t*>(data);
+	for (; size > 0; size--, p++) {
+		hash ^= *p;
+		hash *= 0x100000001B3ULL;
+	}
+
+	// Files are split into 256 subdirectories using
+	// the high byte of the hash.
+	char buf[64];
+	snprintf(buf, sizeof(buf), CONTENT_STORE_DIR "/%02x/%08x%08x",
+		static_cast<unsigned int>(hash >> 56),
+		static_cast<unsigned int>(hash >> 32),
+		static_cast<unsigned int>(hash & 0xFFFFFFFFU));
+
+	string key = buf;
+	if (ext) {
+		key += ext;
+	}
+	return key;
+}
+
 /**
  * urlencode a URL component.
  * This only encodes essential characters, e.g. ' ' and '%'.
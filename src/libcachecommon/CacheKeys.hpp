@@ -9,6 +9,9 @@
 #ifndef __ROMPROPERTIES_LIBCACHECOMMON_CACHEKEYS_HPP__
 #define __ROMPROPERTIES_LIBCACHECOMMON_CACHEKEYS_HPP__
 
+// C includes. (C++ namespace)
+#include <cstddef>
+
 // C++ includes.
 #include <string>
 
@@ -94,6 +97,54 @@ static inline std::wstring getCacheFilename(const std::wstring &cacheKey)
 }
 #endif /* _WIN32 */
 
+// Content store subdirectory, relative to the cache directory.
+#define CONTENT_STORE_DIR "by-hash"
+
+// Fan-out layout marker file, relative to the cache directory.
+// If this file exists, the fan-out layout is used.
+#define FANOUT_MARKER_FILE ".fanout"
+
+/**
+ * Is the user's cache directory using the fan-out layout?
+ *
+ * In the fan-out layout, two directory levels derived from a hash
+ * of the cache key are inserted before the filename, so the number
+ * of files in each directory stays bounded:
+ * - Flat:    wii/disc/US/RMGE01.png
+ * - Fan-out: wii/disc/US/a8/c0/RMGE01.png
+ *
+ * The layout is enabled by creating FANOUT_MARKER_FILE in the
+ * cache directory. This is checked once per process.
+ *
+ * @return True if the fan-out layout is in use; false if not.
+ */
+bool isFanOutLayout(void);
+
+/**
+ * Convert a filtered cache key to a fan-out cache key.
+ * Content store keys are returned as-is, since they're already fanned out.
+ * @param pFilteredKey Filtered cache key. (Must be UTF-8, NULL-terminated.)
+ * @return Fan-out cache key, e.g. "wii/disc/US/a8/c0/RMGE01.png"
+ */
+std::string getFanOutKey(const char *pFilteredKey);
+
+/**
+ * Get the content store key for a downloaded file.
+ *
+ * Files with identical contents have the same content store key,
+ * so they're only stored once. Cache files are hardlinked to the
+ * corresponding file in the content store.
+ *
+ * NOTE: The key is based on a 64-bit FNV-1a hash, so the file
+ * contents must be compared before linking to an existing file.
+ *
+ * @param data File data.
+ * @param size Size of data, in bytes.
+ * @param ext File extension, including the leading dot. (e.g. ".png")
+ * @return Content store key, e.g. "by-hash/3f/3f1c0d2e4b5a6978.png"
+ */
+std::string getContentStoreKey(const void *data, size_t size, const char *ext);
+
 /**
  * urlencode a URL component.
  * This only encodes essential characters, e.g. ' ' and '%'.
@@ -160,6 +160,20 @@ INSTANTIATE_TEST_SUITE_P(CacheManagerTest, FilterCacheKeyTest,
 			"\xC2\xA9______________",
 			"\xC2\xA9______________")
 	));
+
+/**
+ * Test LibCacheCommon::getFanOutKey().
+ */
+TEST(FanOutKeyTest, getFanOutKey)
+{
+	// Two hash-derived levels are inserted before the filename.
+	EXPECT_EQ("wii/disc/US/a8/c0/RMGE01.png", LibCacheCommon::getFanOutKey("wii/disc/US/RMGE01.png"));
+	EXPECT_EQ("wii\\disc\\US\\a8\\c0\\RMGE01.png", LibCacheCommon::getFanOutKey("wii\\disc\\US\\RMGE01.png"));
+	EXPECT_EQ("c4/1b/foo.png", LibCacheCommon::getFanOutKey("foo.png"));
+
+	// Content store keys are already fanned out.
+	EXPECT_EQ("by-hash/3f/3f1c0d2e4b5a6978.png", LibCacheCommon::getFanOutKey("by-hash/3f/3f1c0d2e4b5a6978.png"));
+}
 } }
 
 /**
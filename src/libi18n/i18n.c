@@ -22,6 +22,9 @@
 
 #include "common.h"
 
+// C includes.
+#include <stdint.h>
+
 #ifdef _WIN32
 // Architecture name.
 #if defined(_M_X64) || defined(__amd64__)
@@ -137,4 +140,134 @@ int rp_i18n_init(void)
 }
 #endif /* _WIN32 */
 
+/** Translation cache **/
+
+// Each call to dpgettext() has to determine the current locale
+// and search the message catalog. Field labels are translated
+// for every file that's parsed, so translated strings are cached
+// here, using the msgctxt and msgid pointers as the key.
+//
+// The cache is a lock-free open-addressing hash table.
+// A slot is claimed by setting msgid using compare-and-swap,
+// and it's valid once the translation is set. If a slot is
+// still being filled in, the string is translated without
+// using the cache.
+#define I18N_CACHE_SIZE 4096	/* must be a power of two */
+#define I18N_CACHE_MAX_PROBES 32
+
+typedef struct _i18n_cache_entry {
+	const char *volatile msgid;
+	const char *msgctxt;
+	const char *volatile translation;
+} i18n_cache_entry;
+static i18n_cache_entry i18n_cache[I18N_CACHE_SIZE];
+
+// If 0, strings are not translated.
+static volatile int i18n_enabled = 1;
+
+#if defined(_MSC_VER)
+# include <intrin.h>
+# define CACHE_CMPXCHG_PTR(ptr, cmp, xchg) \
+	_InterlockedCompareExchangePointer((void *volatile*)(ptr), (void*)(xchg), (void*)(cmp))
+// NOTE: Using a no-op compare-and-swap as a load with a full barrier.
+# define CACHE_LOAD_PTR(ptr) \
+	((const char*)_InterlockedCompareExchangePointer((void *volatile*)(ptr), NULL, NULL))
+# define CACHE_STORE_PTR(ptr, val) \
+	_InterlockedExchangePointer((void *volatile*)(ptr), (void*)(val))
+#else /* !_MSC_VER */
+# define CACHE_CMPXCHG_PTR(ptr, cmp, xchg) \
+	__sync_val_compare_and_swap((ptr), (cmp), (xchg))
+# define CACHE_LOAD_PTR(ptr)		__atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+# define CACHE_STORE_PTR(ptr, val)	__atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#endif /* _MSC_VER */
+
+/**
+ * Enable or disable translations.
+ * If disabled, _() and C_() return the original strings.
+ * This should be called before any strings are translated.
+ * @param enabled Non-zero to enable translations; 0 to disable.
+ */
+void rp_i18n_set_enabled(int enabled)
+{
+	i18n_enabled = !!enabled;
+}
+
+/**
+ * Translate a string without using the translation cache.
+ * @param msgctxt Context, or NULL for none.
+ * @param msgid String to translate.
+ * @return Translated string, or msgid if no translation is available.
+ */
+static inline const char *rp_i18n_pgettext_uncached(const char *msgctxt, const char *msgid)
+{
+	return (msgctxt
+		? dpgettext_expr(RP_I18N_DOMAIN, msgctxt, msgid)
+		: dgettext(RP_I18N_DOMAIN, msgid));
+}
+
+/**
+ * Translate a string using the translation cache.
+ *
+ * The cache uses the string pointers as keys, so msgctxt and
+ * msgid must have static storage duration. The locale should
+ * not be changed after the first string is translated.
+ *
+ * @param msgctxt Context, or NULL for none.
+ * @param msgid String to translate.
+ * @return Translated string, or msgid if no translation is available.
+ */
+const char *rp_i18n_pgettext(const char *msgctxt, const char *msgid)
+{
+	const char *translation;
+	unsigned int idx, probes;
+	uintptr_t hash;
+
+	if (!i18n_enabled || !msgid) {
+		// Translations are disabled.
+		return msgid;
+	}
+
+	// Hash the msgid and msgctxt pointers.
+	hash = ((uintptr_t)msgid ^ ((uintptr_t)msgctxt * 31U)) * 0x9E3779B1U;
+	idx = (unsigned int)(hash >> 12);
+
+	for (probes = I18N_CACHE_MAX_PROBES; probes > 0; probes--, idx++) {
+		i18n_cache_entry *const entry = &i18n_cache[idx & (I18N_CACHE_SIZE - 1)];
+		const char *const entry_msgid = CACHE_LOAD_PTR(&entry->msgid);
+
+		if (!entry_msgid) {
+			// Empty slot. Translate the string and try to claim the slot.
+			translation = rp_i18n_pgettext_uncached(msgctxt, msgid);
+			if (CACHE_CMPXCHG_PTR(&entry->msgid, NULL, msgid) == NULL) {
+				entry->msgctxt = msgctxt;
+				CACHE_STORE_PTR(&entry->translation, translation);
+				return translation;
+			}
+
+			// Another thread claimed the slot.
+			// Check it again, since it might be the same string.
+			idx--;
+			probes++;
+			continue;
+		} else if (entry_msgid != msgid) {
+			// Not a match.
+			continue;
+		}
+
+		// msgid matches. Check if the slot is ready.
+		translation = CACHE_LOAD_PTR(&entry->translation);
+		if (!translation) {
+			// Another thread is still filling in this slot.
+			break;
+		} else if (entry->msgctxt == msgctxt) {
+			// Found the string.
+			return translation;
+		}
+	}
+
+	// Not cached, and the cache is either full in this area,
+	// or another thread is filling in the slot.
+	return rp_i18n_pgettext_uncached(msgctxt, msgid);
+}
+
 #endif /* ENABLE_NLS */
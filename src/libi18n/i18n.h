@@ -2,7 +2,7 @@
  * ROM Properties Page shell extension. (libi18n)                          *
  * i18n.h: Internationalization support code.                              *
  *                                                                         *
- * Copyright (c) 2017-2018 by David Korth.                                 *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
  * SPDX-License-Identifier: GPL-2.0-or-later                               *
  ***************************************************************************/
 
@@ -26,8 +26,10 @@
 #ifdef HAVE_GETTEXT
 # include <locale.h>
 # include "gettext.h"
-# define _(msgid)				dgettext(RP_I18N_DOMAIN, msgid)
-# define C_(msgctxt, msgid)			dpgettext(RP_I18N_DOMAIN, msgctxt, msgid)
+// NOTE: _() and C_() use the translation cache.
+// The strings must be compile-time constants.
+# define _(msgid)				rp_i18n_pgettext(NULL, msgid)
+# define C_(msgctxt, msgid)			rp_i18n_pgettext(msgctxt, msgid)
 # define N_(msgid1, msgid2, n)			dngettext(RP_I18N_DOMAIN, msgid1, msgid2, n)
 # define NC_(msgctxt, msgid1, msgid2, n)	dnpgettext(RP_I18N_DOMAIN, msgctxt, msgid1, msgid2, n)
 #else
@@ -54,15 +56,39 @@ extern "C" {
  */
 int rp_i18n_init(void);
 
+/**
+ * Enable or disable translations.
+ * If disabled, _() and C_() return the original strings.
+ * This should be called before any strings are translated.
+ * @param enabled Non-zero to enable translations; 0 to disable.
+ */
+void rp_i18n_set_enabled(int enabled);
+
+/**
+ * Translate a string using the translation cache.
+ *
+ * The cache uses the string pointers as keys, so msgctxt and
+ * msgid must have static storage duration. The locale should
+ * not be changed after the first string is translated.
+ *
+ * @param msgctxt Context, or NULL for none.
+ * @param msgid String to translate.
+ * @return Translated string, or msgid if no translation is available.
+ */
+const char *rp_i18n_pgettext(const char *msgctxt, const char *msgid);
+
 #ifdef __cplusplus
 }
 #endif
 
 #else
 /**
- * Dummy macro for rp_i18n_init() that does nothing.
+ * Dummy macros for rp_i18n_init() and rp_i18n_set_enabled()
+ * that do nothing.
  */
 #define rp_i18n_init() do { } while (0)
+#define rp_i18n_set_enabled(enabled) do { } while (0)
+#define rp_i18n_pgettext(msgctxt, msgid) (msgid)
 #endif /* HAVE_GETTEXT */
 
 // Positional printf().
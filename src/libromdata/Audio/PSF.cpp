@@ -40,12 +40,26 @@ class PSFPrivate final : public RomDataPrivate
 		// NOTE: **NOT** byteswapped in memory.
 		PSF_Header psfHeader;
 
+		// Tags from the tag section.
+		// Loaded by loadTags(), since both loadFieldData()
+		// and loadMetaData() need them.
+		unordered_map<string, string> tags;
+		bool tagsLoaded;
+
+		// Maximum size of the tag section, including the "[TAG]" magic.
+		// The PSF specification limits it to 50,000 bytes.
+		static const unsigned int TAG_SECTION_MAX_SIZE = 50000;
+
 		/**
-		 * Parse the tag section.
-		 * @param tag_addr Tag section starting address.
+		 * Load and parse the tag section.
+		 *
+		 * The tag section is read with a single read. The reserved area
+		 * and the compressed program are skipped, so neither of them
+		 * are read or decompressed.
+		 *
 		 * @return Map containing key/value entries.
 		 */
-		unordered_map<string, string> parseTags(off64_t tag_addr);
+		const unordered_map<string, string> &loadTags(void);
 
 		/**
 		 * Get the "ripped by" tag name for the specified PSF version.
@@ -66,55 +80,70 @@ class PSFPrivate final : public RomDataPrivate
 
 PSFPrivate::PSFPrivate(PSF *q, IRpFile *file)
 	: super(q, file)
+	, tagsLoaded(false)
 {
 	// Clear the PSF header struct.
 	memset(&psfHeader, 0, sizeof(psfHeader));
 }
 
 /**
- * Parse the tag section.
- * @param tag_addr Tag section starting address.
+ * Load and parse the tag section.
+ *
+ * The tag section is read with a single read. The reserved area
+ * and the compressed program are skipped, so neither of them
+ * are read or decompressed.
+ *
  * @return Map containing key/value entries.
  */
-unordered_map<string, string> PSFPrivate::parseTags(off64_t tag_addr)
+const unordered_map<string, string> &PSFPrivate::loadTags(void)
 {
-	unordered_map<string, string> kv;
-
-	// Read the tag magic first.
-	char tag_magic[sizeof(PSF_TAG_MAGIC)-1];
-	size_t size = file->seekAndRead(tag_addr, tag_magic, sizeof(tag_magic));
-	if (size != sizeof(tag_magic)) {
-		// Seek and/or read error.
-		return kv;
+	if (tagsLoaded) {
+		// Tags have already been loaded.
+		return tags;
 	}
+	tagsLoaded = true;
 
-#ifdef HAVE_UNORDERED_MAP_RESERVE
-	kv.reserve(11);
-#endif /* HAVE_UNORDERED_MAP_RESERVE */
+	unordered_map<string, string> &kv = tags;
+	const off64_t tag_addr = static_cast<off64_t>(sizeof(psfHeader)) +
+		le32_to_cpu(psfHeader.reserved_size) +
+		le32_to_cpu(psfHeader.compressed_prg_length);
 
-	// Read the rest of the file.
-	// NOTE: Maximum of 16 KB.
-	off64_t data_len = file->size() - tag_addr - sizeof(tag_magic);
-	if (data_len <= 0) {
+	// Get the size of the tag section, including the magic.
+	static const size_t tag_magic_len = sizeof(PSF_TAG_MAGIC)-1;
+	off64_t data_len = file->size() - tag_addr;
+	if (data_len <= static_cast<off64_t>(tag_magic_len)) {
 		// Not enough data...
 		return kv;
+	} else if (data_len > TAG_SECTION_MAX_SIZE) {
+		data_len = TAG_SECTION_MAX_SIZE;
 	}
 
+	// Read the tag section.
 	// NOTE: Values may be encoded as either cp1252/sjis or UTF-8.
 	// Since we won't be able to determine this until we're finished
 	// decoding variables, we'll have to do character conversion
 	// *after* kv is populated.
 	const size_t data_len_sz = static_cast<size_t>(data_len);
 	unique_ptr<char[]> tag_data(new char[data_len_sz]);
-	size = file->read(tag_data.get(), data_len_sz);
+	size_t size = file->seekAndRead(tag_addr, tag_data.get(), data_len_sz);
 	if (size != data_len_sz) {
-		// Read error.
+		// Seek and/or read error.
 		return kv;
 	}
 
+	// Verify the tag magic.
+	if (memcmp(tag_data.get(), PSF_TAG_MAGIC, tag_magic_len) != 0) {
+		// Not a tag section.
+		return kv;
+	}
+
+#ifdef HAVE_UNORDERED_MAP_RESERVE
+	kv.reserve(11);
+#endif /* HAVE_UNORDERED_MAP_RESERVE */
+
 	bool isUtf8 = false;
-	const char *start = tag_data.get();
-	const char *const endptr = start + data_len;
+	const char *start = tag_data.get() + tag_magic_len;
+	const char *const endptr = tag_data.get() + data_len_sz;
 	for (const char *p = start; p < endptr; p++) {
 		// Find the next newline.
 		const char *nl = static_cast<const char*>(memchr(p, '\n', endptr-p));
@@ -565,10 +594,7 @@ int PSF::loadFieldData(void)
 	}
 
 	// Parse the tags.
-	const off64_t tag_addr = (off64_t)sizeof(*psfHeader) +
-		le32_to_cpu(psfHeader->reserved_size) +
-		le32_to_cpu(psfHeader->compressed_prg_length);
-	unordered_map<string, string> tags = d->parseTags(tag_addr);
+	const unordered_map<string, string> &tags = d->loadTags();
 
 	if (!tags.empty()) {
 		// Title
@@ -680,14 +706,8 @@ int PSF::loadMetaData(void)
 		return -EIO;
 	}
 
-	// PSF header.
-	const PSF_Header *const psfHeader = &d->psfHeader;
-
 	// Attempt to parse the tags before doing anything else.
-	const off64_t tag_addr = (off64_t)sizeof(*psfHeader) +
-		le32_to_cpu(psfHeader->reserved_size) +
-		le32_to_cpu(psfHeader->compressed_prg_length);
-	unordered_map<string, string> tags = d->parseTags(tag_addr);
+	const unordered_map<string, string> &tags = d->loadTags();
 
 	if (tags.empty()) {
 		// No tags.
@@ -753,7 +773,7 @@ int PSF::loadMetaData(void)
 	// FIXME: No property for this...
 	// Ripped By
 	// NOTE: The tag varies based on PSF version.
-	const char *const ripped_by_tag = d->getRippedByTagName(psfHeader->version);
+	const char *const ripped_by_tag = d->getRippedByTagName(d->psfHeader.version);
 	iter = tags.find(ripped_by_tag);
 	if (iter != tags.end()) {
 		// FIXME: No property for this...
@@ -37,6 +37,67 @@ namespace LibRomData {
 
 ROMDATA_IMPL(SNDH)
 
+#ifdef ENABLE_UNICE68
+// Maximum packed and depacked sizes for ICE-compressed files.
+// SNDH files are usually much smaller than this; anything larger
+// is either not SNDH or is corrupted.
+static const int ICE_MAX_SIZE = 4*1024*1024;
+
+/**
+ * Reusable ICE decompression buffer.
+ *
+ * ICE data is depacked from the end of the buffer to the start,
+ * so the tags at the start of the file are only available once
+ * the entire file has been depacked. Listing an SNDH archive
+ * depacks one file after another, so the buffers are kept
+ * per-thread instead of being reallocated for every file.
+ */
+class IceBuffer
+{
+	public:
+		IceBuffer() : m_size(0) { }
+
+	private:
+		RP_DISABLE_COPY(IceBuffer)
+
+	public:
+		// Buffers larger than this are freed after use.
+		static const size_t RETAIN_SIZE = 512*1024;
+
+		/**
+		 * Get a buffer of at least the specified size.
+		 * The contents are not preserved.
+		 * @param size Minimum size.
+		 * @return Buffer.
+		 */
+		uint8_t *get(size_t size)
+		{
+			if (size > m_size) {
+				m_buf.reset(new uint8_t[size]);
+				m_size = size;
+			}
+			return m_buf.get();
+		}
+
+		/**
+		 * Free the buffer if it's larger than RETAIN_SIZE.
+		 */
+		void trim(void)
+		{
+			if (m_size > RETAIN_SIZE) {
+				m_buf.reset();
+				m_size = 0;
+			}
+		}
+
+	private:
+		unique_ptr<uint8_t[]> m_buf;
+		size_t m_size;
+};
+static thread_local IceBuffer iceInBuf;
+static thread_local IceBuffer iceOutBuf;
+#endif /* ENABLE_UNICE68 */
+
 class SNDHPrivate final : public RomDataPrivate
 {
 	public:
@@ -201,30 +262,41 @@ SNDHPrivate::TagData SNDHPrivate::parseTags(void)
 		// Packed with ICE.
 		// FIXME: Return an error if unpacking fails.
 #ifdef ENABLE_UNICE68
-		// Decompress the data.
-		// FIXME: unice68_depacker() only supports decompressing the entire file.
-		// Add a variant that supports buffer sizes.
-		const off64_t fileSize = file->size();
-		if (fileSize < 16) {
+		// Get the packed and depacked sizes from the ICE header.
+		// NOTE: ICE data is depacked backwards, so the entire file
+		// has to be depacked in order to get the tags. Check the
+		// sizes before reading anything else.
+		int packedSize = 0;
+		const int reqSize = unice68_depacked_size(header.get(), &packedSize);
+		if (reqSize <= 0 || reqSize > ICE_MAX_SIZE ||
+		    packedSize < 16 || packedSize > ICE_MAX_SIZE)
+		{
 			return tags;
 		}
-		unique_ptr<uint8_t[]> inbuf(new uint8_t[fileSize]);
-		sz = file->seekAndRead(0, inbuf.get(), fileSize);
-		if (sz != (size_t)fileSize) {
+
+		// Read the packed data.
+		// NOTE: Some files have trailing garbage, so only the
+		// packed size is read, not the entire file.
+		uint8_t *const inbuf = iceInBuf.get(packedSize);
+		sz = file->seekAndRead(0, inbuf, packedSize);
+		if (sz != (size_t)packedSize) {
+			iceInBuf.trim();
 			return tags;
 		}
-		int inbufsz = static_cast<int>(sz);
-		int reqSize = unice68_depacked_size(inbuf.get(), &inbufsz);
-		if (reqSize <= 0) {
-			return tags;
+
+		// Depack the data, then copy the tag region.
+		uint8_t *const outbuf = iceOutBuf.get(reqSize);
+		const int ret = unice68_depacker(outbuf, reqSize, inbuf, packedSize);
+		if (ret == 0) {
+			headerSize = std::min(4096, reqSize);
+			memcpy(header.get(), outbuf, headerSize);
+			header[headerSize] = 0;	// ensure NULL-termination
 		}
-		header.reset(new uint8_t[reqSize+1]);
-		int ret = unice68_depacker(header.get(), reqSize, inbuf.get(), fileSize);
+		iceInBuf.trim();
+		iceOutBuf.trim();
 		if (ret != 0) {
 			return tags;
 		}
-		headerSize = std::min(4096, reqSize);
-		header[headerSize] = 0;	// ensure NULL-termination
 #else /* !ENABLE_UNICE68 */
 		// unice68 is disabled.
 		return tags;
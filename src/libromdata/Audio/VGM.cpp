@@ -49,18 +49,27 @@ class VGMPrivate final : public RomDataPrivate
 		// All strings must be in UTF-8 format.
 		typedef array<string, GD3_TAG_MAX> gd3_tags_t;
 
+		// Loaded GD3 tags. (nullptr if not loaded or not available)
+		// The GD3 tag block is usually at the end of the file, which
+		// means the whole file has to be decompressed for .vgz, so
+		// the tags are cached for both loadFieldData() and loadMetaData().
+		unique_ptr<gd3_tags_t> gd3_tags;
+		bool gd3_loaded;
+
 		/**
 		 * Load GD3 tags.
+		 * The tags are only loaded once.
 		 * @param addr Starting address of the GD3 tag block.
-		 * @return Allocated GD3 tags, or nullptr on error.
+		 * @return GD3 tags, or nullptr on error.
 		 */
-		gd3_tags_t *loadGD3(unsigned int addr);
+		const gd3_tags_t *loadGD3(unsigned int addr);
 };
 
 /** VGMPrivate **/
 
 VGMPrivate::VGMPrivate(VGM *q, IRpFile *file)
 	: super(q, file)
+	, gd3_loaded(false)
 {
 	// Clear the VGM header struct.
 	memset(&vgmHeader, 0, sizeof(vgmHeader));
@@ -98,16 +107,23 @@ string VGMPrivate::formatClockRate(unsigned int clock_rate)
 
 /**
  * Load GD3 tags.
+ * The tags are only loaded once.
  * @param addr Starting address of the GD3 tag block.
- * @return Allocated GD3 tags, or nullptr on error.
+ * @return GD3 tags, or nullptr on error.
  */
-VGMPrivate::gd3_tags_t *VGMPrivate::loadGD3(unsigned int addr)
+const VGMPrivate::gd3_tags_t *VGMPrivate::loadGD3(unsigned int addr)
 {
+	if (gd3_loaded) {
+		// GD3 tags have already been loaded.
+		return gd3_tags.get();
+	}
+
 	assert(file != nullptr);
 	assert(file->isOpen());
 	if (!file || !file->isOpen()) {
 		return nullptr;
 	}
+	gd3_loaded = true;
 
 	GD3_Header gd3Header;
 	size_t size = file->seekAndRead(addr, &gd3Header, sizeof(gd3Header));
@@ -149,7 +165,8 @@ VGMPrivate::gd3_tags_t *VGMPrivate::loadGD3(unsigned int addr)
 		return nullptr;
 	}
 
-	gd3_tags_t *gd3_tags = new gd3_tags_t;
+	gd3_tags_t *const gd3_tags = new gd3_tags_t;
+	this->gd3_tags.reset(gd3_tags);
 
 	// Convert from NULL-terminated strings to gd3_tags_t.
 	size_t tag_idx = 0;
@@ -380,7 +397,7 @@ int VGM::loadFieldData(void)
 	if (d->vgmHeader.gd3_offset != 0) {
 		// TODO: Make sure the GD3 offset is stored after the header.
 		const unsigned int addr = le32_to_cpu(d->vgmHeader.gd3_offset) + offsetof(VGM_Header, gd3_offset);
-		VGMPrivate::gd3_tags_t *const gd3_tags = d->loadGD3(addr);
+		const VGMPrivate::gd3_tags_t *const gd3_tags = d->loadGD3(addr);
 		if (gd3_tags) {
 			// TODO: Option to show Japanese instead of English.
 
@@ -422,8 +439,6 @@ int VGM::loadFieldData(void)
 						dpgettext_expr(RP_I18N_DOMAIN, pTag->ctx, pTag->desc), str);
 				}
 			}
-
-			delete gd3_tags;
 		}
 	}
 
@@ -882,7 +897,7 @@ int VGM::loadMetaData(void)
 	if (d->vgmHeader.gd3_offset != 0) {
 		// TODO: Make sure the GD3 offset is stored after the header.
 		const unsigned int addr = le32_to_cpu(d->vgmHeader.gd3_offset) + offsetof(VGM_Header, gd3_offset);
-		VGMPrivate::gd3_tags_t *const gd3_tags = d->loadGD3(addr);
+		const VGMPrivate::gd3_tags_t *const gd3_tags = d->loadGD3(addr);
 		if (gd3_tags) {
 			// TODO: Option to show Japanese instead of English.
 
@@ -935,8 +950,6 @@ int VGM::loadMetaData(void)
 					d->metaData->addMetaData_string(pTag->prop, str);
 				}
 			}
-
-			delete gd3_tags;
 		}
 	}
 
@@ -453,21 +453,27 @@ const rp_image *DreamcastSavePrivate::loadIcon(void)
 	}
 
 	// Temporary icon buffer.
-	VmsIcon_buf_t buf;
-
-	// Load the palette.
+	// The icons are stored contiguously immediately after the palette,
+	// so the palette and all of the icons are read with a single read.
+	union {
+		uint8_t   u8[DC_VMS_ICON_PALETTE_SIZE + (3 * DC_VMS_ICON_DATA_SIZE)];
+		uint32_t u32[(DC_VMS_ICON_PALETTE_SIZE + (3 * DC_VMS_ICON_DATA_SIZE)) >> 2];
+	} buf;
+	const unsigned int readsize = DC_VMS_ICON_PALETTE_SIZE + (icon_count * DC_VMS_ICON_DATA_SIZE);
 	size_t size = file->seekAndRead(vms_header_offset + static_cast<uint32_t>(sizeof(vms_header)),
-					buf.palette.u16, sizeof(buf.palette.u16));
-	if (size != sizeof(buf.palette.u16)) {
+					buf.u8, readsize);
+	if (size != readsize) {
 		// Seek and/or read error.
 		return nullptr;
 	}
 
 	if (this->saveType == SaveType::DCI) {
-		// Apply 32-bit byteswapping to the palette.
-		__byte_swap_32_array(buf.palette.u32, sizeof(buf.palette.u32));
+		// Apply 32-bit byteswapping to the palette and icons.
+		__byte_swap_32_array(buf.u32, readsize);
 	}
 
+	const uint16_t *const palette = reinterpret_cast<const uint16_t*>(buf.u8);
+
 	this->iconAnimData = new IconAnimData();
 	iconAnimData->count = 0;
 
@@ -477,26 +483,15 @@ const rp_image *DreamcastSavePrivate::loadIcon(void)
 		(vms_header.icon_anim_speed * 100) / 30
 	};
 
-	// Load the icons. (32x32, 4bpp)
-	// Icons are stored contiguously immediately after the palette.
-	for (int i = 0; i < icon_count; i++) {
-		size = file->read(buf.icon_color.u8, sizeof(buf.icon_color.u8));
-		if (size != sizeof(buf.icon_color)) {
-			// Read error.
-			break;
-		}
-
-		if (this->saveType == SaveType::DCI) {
-			// Apply 32-bit byteswapping to the palette.
-			__byte_swap_32_array(buf.icon_color.u32, sizeof(buf.icon_color.u32));
-		}
-
+	// Decode the icons. (32x32, 4bpp)
+	const uint8_t *icon_color = &buf.u8[DC_VMS_ICON_PALETTE_SIZE];
+	for (int i = 0; i < icon_count; i++, icon_color += DC_VMS_ICON_DATA_SIZE) {
 		iconAnimData->delays[i] = delay;
 		iconAnimData->frames[i] = ImageDecoder::fromLinearCI4(
 			ImageDecoder::PXF_ARGB4444, true,
 			DC_VMS_ICON_W, DC_VMS_ICON_H,
-			buf.icon_color.u8, sizeof(buf.icon_color.u8),
-			buf.palette.u16, sizeof(buf.palette.u16));
+			icon_color, DC_VMS_ICON_DATA_SIZE,
+			palette, DC_VMS_ICON_PALETTE_SIZE);
 		if (!iconAnimData->frames[i])
 			break;
 
@@ -21,6 +21,7 @@
 
 // librpbase, librpfile, librptexture
 #include "librpfile/DualFile.hpp"
+#include "librpfile/MultiFile.hpp"
 #include "librpfile/RelatedFile.hpp"
 #include "librpbase/SystemRegion.hpp"
 using namespace LibRpBase;
@@ -127,7 +128,7 @@ class GameCubePrivate final : public RomDataPrivate
 			off64_t start;		// Starting address, in bytes.
 			off64_t size;		// Estimated partition size, in bytes.
 
-			WiiPartition *partition;	// Partition object.
+			WiiPartition *partition;	// Partition object. (Created on first use.)
 			uint32_t type;		// Partition type. (See WiiPartitionType.)
 			uint8_t vg;		// Volume group number.
 			uint8_t pt;		// Partition number.
@@ -136,17 +137,32 @@ class GameCubePrivate final : public RomDataPrivate
 		vector<WiiPartEntry> wiiPtbl;
 		bool wiiPtblLoaded;
 
-		// Pointers to specific partitions within wiiPtbl.
-		WiiPartition *updatePartition;
-		WiiPartition *gamePartition;
+		// Crypto method for partitions in wiiPtbl. (WiiPartition::CryptoMethod)
+		uint8_t wiiCryptoMethod;
+
+		// Indexes of specific partitions within wiiPtbl. (-1 if not present)
+		int updatePartIdx;
+		int gamePartIdx;
 
 		/**
 		 * Load the Wii volume group and partition tables.
 		 * Partition tables are loaded into wiiPtbl.
+		 *
+		 * NOTE: WiiPartition objects are not created here.
+		 * Use openWiiPartition() to get a partition.
+		 *
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		int loadWiiPartitionTables(void);
 
+		/**
+		 * Get a WiiPartition from wiiPtbl.
+		 * The WiiPartition object is created on first use.
+		 * @param idx wiiPtbl index.
+		 * @return WiiPartition, or nullptr if idx is out of range.
+		 */
+		WiiPartition *openWiiPartition(int idx);
+
 	public:
 		/**
 		 * Get the disc publisher.
@@ -216,8 +232,9 @@ GameCubePrivate::GameCubePrivate(GameCube *q, IRpFile *file)
 	, gcnRegion(~0)
 	, hasRegionCode(false)
 	, wiiPtblLoaded(false)
-	, updatePartition(nullptr)
-	, gamePartition(nullptr)
+	, wiiCryptoMethod(0)
+	, updatePartIdx(-1)
+	, gamePartIdx(-1)
 {
 	// Clear the various structs.
 	memset(&discHeader, 0, sizeof(discHeader));
@@ -227,10 +244,6 @@ GameCubePrivate::GameCubePrivate(GameCube *q, IRpFile *file)
 
 GameCubePrivate::~GameCubePrivate()
 {
-	// Wii partition pointers.
-	updatePartition = nullptr;
-	gamePartition = nullptr;
-
 	// Clear the existing partition table vector.
 	std::for_each(wiiPtbl.begin(), wiiPtbl.end(),
 		[](WiiPartEntry &entry) {
@@ -310,14 +323,14 @@ int GameCubePrivate::loadWiiPartitionTables(void)
 
 	// Check the crypto and hash method.
 	// TODO: Lookup table instead of branches?
-	unsigned int cryptoMethod = 0;
+	wiiCryptoMethod = 0;
 	if (discHeader.disc_noCrypto != 0 || (discType & DISC_FORMAT_MASK) == DISC_FORMAT_NASOS) {
 		// No encryption.
-		cryptoMethod |= WiiPartition::CM_UNENCRYPTED;
+		wiiCryptoMethod |= WiiPartition::CM_UNENCRYPTED;
 	}
 	if (discHeader.hash_verify != 0) {
 		// No hashes.
-		cryptoMethod |= WiiPartition::CM_32K;
+		wiiCryptoMethod |= WiiPartition::CM_32K;
 	}
 
 	// Process each volume group.
@@ -348,6 +361,7 @@ int GameCubePrivate::loadWiiPartitionTables(void)
 			entry.pt = static_cast<uint8_t>(j);
 			entry.start = static_cast<off64_t>(be32_to_cpu(pt[j].addr)) << 2;
 			entry.type = be32_to_cpu(pt[j].type);
+			entry.partition = nullptr;
 		}
 	}
 
@@ -376,25 +390,48 @@ int GameCubePrivate::loadWiiPartitionTables(void)
 		}
 	);
 
-	// Create the WiiPartition objects.
-	const auto wiiPtbl_end = wiiPtbl.end();
-	for (auto iter = wiiPtbl.begin(); iter != wiiPtbl_end; ++iter) {
-		iter->partition = new WiiPartition(discReader, iter->start, iter->size,
-			(WiiPartition::CryptoMethod)cryptoMethod);
-
-		if (iter->type == RVL_PT_UPDATE && !updatePartition) {
+	// Find the System Update and Game partitions.
+	// NOTE: The WiiPartition objects are created by openWiiPartition(),
+	// since each one has to read its partition header.
+	updatePartIdx = -1;
+	gamePartIdx = -1;
+	for (size_t i = 0; i < wiiPtbl.size(); i++) {
+		const uint32_t type = wiiPtbl[i].type;
+		if (type == RVL_PT_UPDATE && updatePartIdx < 0) {
 			// System Update partition.
-			updatePartition = iter->partition;
-		} else if (iter->type == RVL_PT_GAME && !gamePartition) {
+			updatePartIdx = static_cast<int>(i);
+		} else if (type == RVL_PT_GAME && gamePartIdx < 0) {
 			// Game partition.
-			gamePartition = iter->partition;
+			gamePartIdx = static_cast<int>(i);
 		}
 	}
 
 	// Done reading the partition tables.
+	wiiPtblLoaded = true;
 	return 0;
 }
 
+/**
+ * Get a WiiPartition from wiiPtbl.
+ * The WiiPartition object is created on first use.
+ * @param idx wiiPtbl index.
+ * @return WiiPartition, or nullptr if idx is out of range.
+ */
+WiiPartition *GameCubePrivate::openWiiPartition(int idx)
+{
+	if (idx < 0 || idx >= static_cast<int>(wiiPtbl.size())) {
+		// Out of range, or the partition isn't present.
+		return nullptr;
+	}
+
+	WiiPartEntry &entry = wiiPtbl[idx];
+	if (!entry.partition) {
+		entry.partition = new WiiPartition(discReader, entry.start, entry.size,
+			(WiiPartition::CryptoMethod)wiiCryptoMethod);
+	}
+	return entry.partition;
+}
+
 /**
  * Get the disc publisher.
  * @return Disc publisher.
@@ -495,6 +532,7 @@ int GameCubePrivate::wii_loadOpeningBnr(void)
 		return 0;
 	}
 
+	WiiPartition *const gamePartition = openWiiPartition(gamePartIdx);
 	if (!gamePartition) {
 		// No game partition...
 		return -ENOENT;
@@ -749,36 +787,45 @@ GameCube::GameCube(IRpFile *file)
 				d->discReader = new WbfsReader(d->file);
 			} else*/ if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) == GameCubePrivate::DISC_FORMAT_WBFS) {
 				// First part of split WBFS.
-				// Check for a WBF1 file.
-				IRpFile *wbfs1 = FileSystem::openRelatedFile(file->filename().c_str(), nullptr, ".wbf1");
-				// COMMIT THIS FIRST BEFORE UNREF
-				if (unlikely(!wbfs1 || !wbfs1->isOpen())) {
-					// Unable to open the .wbf1 file.
-					// Assume it's a single .wbfs file.
-					UNREF_AND_NULL(wbfs1);
+				// Check for .wbf1, .wbf2, etc. files.
+				// NOTE: Parts are opened until one is missing.
+				vector<IRpFile*> parts;
+				const string filename = file->filename();
+				char ext[] = ".wbf1";
+				for (; ext[4] <= '9'; ext[4]++) {
+					IRpFile *const wbfsN = FileSystem::openRelatedFile(filename.c_str(), nullptr, ext);
+					if (!wbfsN || !wbfsN->isOpen()) {
+						// Unable to open this part.
+						UNREF(wbfsN);
+						break;
+					}
+					parts.emplace_back(wbfsN);
 				}
 
-				if (likely(!wbfs1)) {
+				if (likely(parts.empty())) {
 					// Single .wbfs file.
 					d->discReader = new WbfsReader(d->file);
 					break;
 				}
 
-				// Split .wbfs/.wbf1.
-				DualFile *const dualFile = new DualFile(d->file, wbfs1);
-				if (!dualFile->isOpen()) {
-					// Unable to open DualFile.
-					dualFile->unref();
+				// Split .wbfs/.wbf1/.wbf2/etc.
+				parts.insert(parts.begin(), d->file);
+				MultiFile *const multiFile = new MultiFile(parts);
+				// MultiFile maintains its own references.
+				for (auto iter = parts.begin() + 1; iter != parts.end(); ++iter) {
+					(*iter)->unref();
+				}
+				if (!multiFile->isOpen()) {
+					// Unable to open MultiFile.
+					multiFile->unref();
 					d->discType = GameCubePrivate::DISC_UNKNOWN;
 					break;
 				}
 
-				// DualFile maintains its own references, so unreference
-				// d->file and replace it with the DualFile.
+				// Replace d->file with the MultiFile.
 				IRpFile *const file_tmp = d->file;
-				d->file = dualFile;
+				d->file = multiFile;
 				file_tmp->unref();
-				wbfs1->unref();
 
 				// Open the WbfsReader.
 				d->discReader = new WbfsReader(d->file);
@@ -897,7 +944,7 @@ GameCube::GameCube(IRpFile *file)
 			// TODO: What's the difference between the different title IDs?
 			// It might be region code, but what is 'UPD'?
 			pt.type = RVL_PT_UPDATE;
-			d->updatePartition = pt.partition;
+			d->updatePartIdx = 0;
 		} else if (tid.lo == be32_to_cpu('INS')) {
 			// Channel partition.
 			pt.type = RVL_PT_CHANNEL;
@@ -905,7 +952,7 @@ GameCube::GameCube(IRpFile *file)
 			// Game partition.
 			// TODO: Extract partitions from Brawl and check.
 			pt.type = RVL_PT_GAME;
-			d->gamePartition = pt.partition;
+			d->gamePartIdx = 0;
 		}
 
 		// Read the partition header.
@@ -1012,6 +1059,14 @@ GameCube::GameCube(IRpFile *file)
 
 			d->gcnRegion = be32_to_cpu(bootInfo.region_code);
 			d->hasRegionCode = true;
+
+			// The FST is needed to find opening.bnr for the banner,
+			// so let the disc image start loading it now.
+			GCN_Boot_Block bootBlock;
+			size = d->discReader->seekAndRead(GCN_Boot_Block_ADDRESS, &bootBlock, sizeof(bootBlock));
+			if (size == sizeof(bootBlock)) {
+				d->discReader->prefetch(be32_to_cpu(bootBlock.fst_offset), be32_to_cpu(bootBlock.fst_size));
+			}
 			break;
 		}
 
@@ -1091,6 +1146,23 @@ void GameCube::close(void)
 	super::close();
 }
 
+/**
+ * Open a reader for the logical image data.
+ * This is used for whole-file checksums.
+ * @return IDiscReader (caller must unref()), or nullptr on error.
+ */
+IDiscReader *GameCube::openDataReader(void)
+{
+	// NOTE: The disc reader is kept open by close(),
+	// so compressed and sparse images are still handled
+	// after the file is closed.
+	RP_D(GameCube);
+	if (d->discReader) {
+		return d->discReader->ref();
+	}
+	return super::openDataReader();
+}
+
 /** ROM detection functions. **/
 
 /**
@@ -1606,8 +1678,9 @@ int GameCube::loadFieldData(void)
 	int wiiPtLoaded = d->loadWiiPartitionTables();
 
 	// TMD fields.
-	if (d->gamePartition) {
-		const RVL_TMD_Header *const tmdHeader = d->gamePartition->tmdHeader();
+	WiiPartition *const gamePartition = d->openWiiPartition(d->gamePartIdx);
+	if (gamePartition) {
+		const RVL_TMD_Header *const tmdHeader = gamePartition->tmdHeader();
 		if (tmdHeader) {
 			// Title ID.
 			// TID Lo is usually the same as the game ID,
@@ -1673,15 +1746,15 @@ int GameCube::loadFieldData(void)
 			// Unable to load the game name from opening.bnr.
 			// This might be because it's homebrew, a prototype, or a key error.
 			const char *const game_info_title = C_("GameCube", "Game Info");
-			if (!d->gamePartition) {
+			if (!gamePartition) {
 				// No game partition.
 				if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) != GameCubePrivate::DISC_FORMAT_PARTITION) {
 					d->fields->addField_string(game_info_title,
 						C_("GameCube", "ERROR: No game partition was found."));
 				}
-			} else if (d->gamePartition->verifyResult() != KeyManager::VerifyResult::OK) {
+			} else if (gamePartition->verifyResult() != KeyManager::VerifyResult::OK) {
 				// Key error.
-				const char *status = d->wii_getCryptoStatus(d->gamePartition);
+				const char *status = d->wii_getCryptoStatus(gamePartition);
 				d->fields->addField_string(game_info_title,
 					rp_sprintf(C_("GameCube", "ERROR: %s"),
 						(status ? status : C_("GameCube", "Unknown"))));
@@ -1693,7 +1766,8 @@ int GameCube::loadFieldData(void)
 		unsigned int ios_slot = 0, ios_major = 0, ios_minor = 0;
 		unsigned int ios_retail_count = 0;
 		bool isDebugIOS = false;
-		if (d->updatePartition) {
+		WiiPartition *const updatePartition = d->openWiiPartition(d->updatePartIdx);
+		if (updatePartition) {
 			// Get the update version.
 			//
 			// On retail discs, the update partition usually contains
@@ -1715,10 +1789,10 @@ int GameCube::loadFieldData(void)
 			//   - 64: Memory configuration (64 or 128)
 			//   - 56: IOS slot
 			//   - 21.29: IOS version. (21.29 == v5405)
-			IFst::Dir *const dirp = d->updatePartition->opendir("/_sys/");
+			IFst::Dir *const dirp = updatePartition->opendir("/_sys/");
 			if (dirp) {
 				IFst::DirEnt *dirent;
-				while ((dirent = d->updatePartition->readdir(dirp)) != nullptr) {
+				while ((dirent = updatePartition->readdir(dirp)) != nullptr) {
 					if (!dirent->name || dirent->type != DT_REG)
 						continue;
 
@@ -1760,7 +1834,7 @@ int GameCube::loadFieldData(void)
 						}
 					}
 				}
-				d->updatePartition->closedir(dirp);
+				updatePartition->closedir(dirp);
 			}
 		}
 
@@ -1771,10 +1845,10 @@ int GameCube::loadFieldData(void)
 					(ios_major << 8) | ios_minor));
 		} else {
 			if (!sysMenu) {
-				if (!d->updatePartition) {
+				if (!updatePartition) {
 					sysMenu = C_("GameCube", "None");
 				} else {
-					sysMenu = d->wii_getCryptoStatus(d->updatePartition);
+					sysMenu = d->wii_getCryptoStatus(updatePartition);
 				}
 			}
 			d->fields->addField_string(update_title, sysMenu);
@@ -1784,15 +1858,15 @@ int GameCube::loadFieldData(void)
 		auto vv_partitions = new RomFields::ListData_t();
 		vv_partitions->resize(d->wiiPtbl.size());
 
-		auto src_iter = d->wiiPtbl.cbegin();
-		auto dest_iter = vv_partitions->begin();
-		const auto vv_partitions_end = vv_partitions->end();
-		for ( ; dest_iter != vv_partitions_end; ++src_iter, ++dest_iter) {
-			vector<string> &data_row = *dest_iter;
+		const int pt_count = static_cast<int>(d->wiiPtbl.size());
+		for (int i = 0; i < pt_count; i++) {
+			vector<string> &data_row = vv_partitions->at(i);
 			data_row.reserve(5);	// 5 fields per row.
 
 			// Partition entry.
-			const GameCubePrivate::WiiPartEntry &entry = *src_iter;
+			// NOTE: The key and used size require the partition object.
+			const GameCubePrivate::WiiPartEntry &entry = d->wiiPtbl[i];
+			WiiPartition *const partition = d->openWiiPartition(i);
 
 			// Partition number.
 			data_row.emplace_back(rp_sprintf("%dp%d", entry.vg, entry.pt));
@@ -1838,11 +1912,11 @@ int GameCube::loadFieldData(void)
 				// NASOS disc image.
 				// If this would normally be an encrypted image, use encKeyReal().
 				encKey = (d->discHeader.disc_noCrypto == 0
-					? entry.partition->encKeyReal()
-					: entry.partition->encKey());
+					? partition->encKeyReal()
+					: partition->encKey());
 			} else {
 				// Other disc image. Use encKey().
-				encKey = entry.partition->encKey();
+				encKey = partition->encKey();
 			}
 
 			static const char *const wii_key_tbl[] = {
@@ -1876,7 +1950,7 @@ int GameCube::loadFieldData(void)
 			data_row.emplace_back(s_key_name);
 
 			// Used size.
-			const off64_t used_size = entry.partition->partition_size_used();
+			const off64_t used_size = partition->partition_size_used();
 			if (used_size >= 0) {
 				data_row.emplace_back(LibRpBase::formatFileSize(used_size));
 			} else {
@@ -1885,7 +1959,7 @@ int GameCube::loadFieldData(void)
 			}
 
 			// Partition size.
-			data_row.emplace_back(LibRpBase::formatFileSize(entry.partition->partition_size()));
+			data_row.emplace_back(LibRpBase::formatFileSize(partition->partition_size()));
 		}
 
 		// Fields.
@@ -2212,5 +2286,149 @@ int GameCube::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) c
 	// All URLs added.
 	return 0;
 }
+/**
+ * Get the list of operations that can be performed on this ROM.
+ * Internal function; called by RomData::romOps().
+ * @return List of operations.
+ */
+vector<RomData::RomOp> GameCube::romOps_int(void) const
+{
+	vector<RomOp> ops;
+
+#ifdef ENABLE_DECRYPTION
+	// Verify the partition hashes. (Wii only)
+	// NOTE: Unencrypted RVT-H images don't have hashes.
+	RP_D(const GameCube);
+	RomOp op(C_("GameCube|RomOps", "&Verify Partition Hashes"), RomOp::ROF_VERIFY);
+	if ((d->discType & GameCubePrivate::DISC_SYSTEM_MASK) == GameCubePrivate::DISC_SYSTEM_WII &&
+	    const_cast<GameCubePrivate*>(d)->loadWiiPartitionTables() == 0 &&
+	    (d->wiiCryptoMethod & WiiPartition::CM_MASK_SECTOR) == WiiPartition::CM_1K_31K)
+	{
+		op.flags |= RomOp::ROF_ENABLED;
+	}
+	ops.emplace_back(std::move(op));
+#endif /* ENABLE_DECRYPTION */
+
+	return ops;
+}
+
+/**
+ * Perform a ROM operation.
+ * Internal function; called by RomData::doRomOp().
+ * @param id		[in] Operation index.
+ * @param pParams	[in/out] Parameters and results. (for e.g. UI updates)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GameCube::doRomOp_int(int id, RomOpParams *pParams)
+{
+#ifdef ENABLE_DECRYPTION
+	RP_D(GameCube);
+	if (id != 0) {
+		pParams->status = -EINVAL;
+		pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
+		return -EINVAL;
+	}
+
+	// Verify the partition hashes.
+	if ((d->discType & GameCubePrivate::DISC_SYSTEM_MASK) != GameCubePrivate::DISC_SYSTEM_WII ||
+	    d->loadWiiPartitionTables() != 0)
+	{
+		pParams->status = -EIO;
+		pParams->msg = C_("GameCube", "Unable to load the Wii partition tables.");
+		return -EIO;
+	}
+
+	// Report one line per bad group, up to a reasonable limit.
+	static const unsigned int MAX_REPORT_LINES = 64;
+	unsigned int reportLines = 0, reportSkipped = 0;
+	string report;
+
+	unsigned int failed = 0;
+	const int ptCount = static_cast<int>(d->wiiPtbl.size());
+	for (int i = 0; i < ptCount; i++) {
+		const GameCubePrivate::WiiPartEntry &entry = d->wiiPtbl[i];
+		WiiPartition *const partition = d->openWiiPartition(i);
+
+		WiiPartition::HashVerifyResult result;
+		int ret = (partition && partition->isOpen())
+			? partition->verifyHashes(result)
+			: -EIO;
+		if (ret != 0 || !result.h3TableOK || !result.badGroups.empty()) {
+			failed++;
+		}
+
+		if (ret != 0 && result.groupCount == 0) {
+			report += '\n';
+			report += rp_sprintf(C_("GameCube", "Partition %u.%u: Unable to verify the hashes: %s"),
+				entry.vg, entry.pt, strerror(-ret));
+			continue;
+		}
+		if (!result.h3TableOK) {
+			report += '\n';
+			report += rp_sprintf(C_("GameCube", "Partition %u.%u: The H3 table doesn't match the TMD."),
+				entry.vg, entry.pt);
+		}
+
+		for (const WiiPartition::BadGroup &badGroup : result.badGroups) {
+			if (reportLines >= MAX_REPORT_LINES) {
+				reportSkipped++;
+				continue;
+			}
+			reportLines++;
+
+			string levels;
+			static const char hf_names[][5] = {"read", "H0", "H1", "H2", "H3"};
+			for (unsigned int bit = 0; bit < ARRAY_SIZE(hf_names); bit++) {
+				if (badGroup.flags & (1U << bit)) {
+					if (!levels.empty()) {
+						levels += ' ';
+					}
+					levels += hf_names[bit];
+				}
+			}
+
+			// Bad sector bitfield. (bit 0 == first sector in the group)
+			const uint32_t sectors_lo = static_cast<uint32_t>(badGroup.sectors);
+			const uint32_t sectors_hi = static_cast<uint32_t>(badGroup.sectors >> 32);
+			char mask[20];
+			snprintf(mask, sizeof(mask), "%08X%08X", sectors_hi, sectors_lo);
+
+			report += '\n';
+			report += rp_sprintf_p(C_("GameCube", "Partition %1$u.%2$u, group %3$u: %4$s errors in %5$u sector(s) (mask: %6$s)"),
+				entry.vg, entry.pt, badGroup.group, levels.c_str(),
+				popcount(sectors_lo) + popcount(sectors_hi), mask);
+		}
+
+		if (ret != 0) {
+			report += '\n';
+			report += rp_sprintf(C_("GameCube", "Partition %u.%u: Read error after %u groups: %s"),
+				entry.vg, entry.pt, result.groupCount, strerror(-ret));
+		}
+	}
+
+	if (reportSkipped > 0) {
+		report += '\n';
+		report += rp_sprintf(NC_("GameCube",
+			"(%u more bad group not shown)",
+			"(%u more bad groups not shown)", reportSkipped), reportSkipped);
+	}
+
+	pParams->status = 0;
+	if (failed == 0) {
+		pParams->msg = C_("GameCube", "All partition hashes were verified successfully.");
+	} else {
+		pParams->msg = rp_sprintf(NC_("GameCube",
+			"%u partition failed hash verification.",
+			"%u partitions failed hash verification.", failed), failed);
+	}
+	pParams->msg += report;
+	return 0;
+#else /* !ENABLE_DECRYPTION */
+	RP_UNUSED(id);
+	pParams->status = -ENOTSUP;
+	pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
+	return -ENOTSUP;
+#endif /* ENABLE_DECRYPTION */
+}
 
 }
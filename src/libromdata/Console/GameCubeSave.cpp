@@ -43,8 +43,16 @@ class GameCubeSavePrivate final : public RomDataPrivate
 		rp_image *img_banner;
 
 		// Animated icon data.
+		// NOTE: Only created if iconAnimData() is called.
 		IconAnimData *iconAnimData;
 
+		// First icon frame.
+		// Decoded by loadIcon() without decoding the other frames.
+		rp_image *icon_first_frame;
+
+		// Number of icon frames. (-1 if the icon hasn't been loaded)
+		int icon_frame_count;
+
 	public:
 		// RomFields data.
 
@@ -85,15 +93,47 @@ class GameCubeSavePrivate final : public RomDataPrivate
 		static bool isCardDirEntry(const uint8_t *buffer, uint32_t data_size, SaveType saveType);
 
 		/**
-		 * Load the save file's icons.
+		 * Get the size of an icon frame, including its palette.
+		 * @param fmt Icon format. (CARD_ICON_*)
+		 * @return Icon frame size, in bytes.
+		 */
+		static unsigned int iconFrameSize(unsigned int fmt);
+
+		/**
+		 * Decode an icon frame.
+		 * @param fmt Icon format. (CARD_ICON_*)
+		 * @param pIcon Icon data. (For CARD_ICON_CI_UNIQUE, the palette must follow the icon.)
+		 * @param pal_CI8_shared Shared CI8 palette, or nullptr if not present.
+		 * @return Icon frame, or nullptr on error.
+		 */
+		static rp_image *decodeIconFrame(unsigned int fmt, const uint8_t *pIcon, const uint16_t *pal_CI8_shared);
+
+		/**
+		 * Load the save file's icon frames.
+		 *
+		 * All of the required icon data is read with a single read.
+		 *
+		 * @param firstFrameOnly If true, only read and decode the first frame.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadIconFrames(bool firstFrameOnly);
+
+		/**
+		 * Load the save file's icon.
 		 *
-		 * This will load all of the animated icon frames,
-		 * though only the first frame will be returned.
+		 * Only the first frame is decoded.
+		 * Use loadIconAnimData() to decode the animated icon.
 		 *
 		 * @return Icon, or nullptr on error.
 		 */
 		const rp_image *loadIcon(void);
 
+		/**
+		 * Load the save file's animated icon.
+		 * @return Animated icon data, or nullptr on error.
+		 */
+		const IconAnimData *loadIconAnimData(void);
+
 		/**
 		 * Load the save file's banner.
 		 * @return Banner, or nullptr on error.
@@ -107,6 +147,8 @@ GameCubeSavePrivate::GameCubeSavePrivate(GameCubeSave *q, IRpFile *file)
 	: super(q, file)
 	, img_banner(nullptr)
 	, iconAnimData(nullptr)
+	, icon_first_frame(nullptr)
+	, icon_frame_count(-1)
 	, saveType(SaveType::Unknown)
 	, dataOffset(-1)
 {
@@ -118,6 +160,7 @@ GameCubeSavePrivate::~GameCubeSavePrivate()
 {
 	UNREF(img_banner);
 	UNREF(iconAnimData);
+	UNREF(icon_first_frame);
 }
 
 /**
@@ -261,23 +304,85 @@ bool GameCubeSavePrivate::isCardDirEntry(const uint8_t *buffer, uint32_t data_si
 }
 
 /**
- * Load the save file's icons.
- *
- * This will load all of the animated icon frames,
- * though only the first frame will be returned.
- *
- * @return Icon, or nullptr on error.
+ * Get the size of an icon frame, including its palette.
+ * @param fmt Icon format. (CARD_ICON_*)
+ * @return Icon frame size, in bytes.
  */
-const rp_image *GameCubeSavePrivate::loadIcon(void)
+unsigned int GameCubeSavePrivate::iconFrameSize(unsigned int fmt)
 {
-	if (iconAnimData) {
-		// Icon has already been loaded.
-		return iconAnimData->frames[0];
-	} else if (!this->file || !this->isValid) {
-		// Can't load the icon.
-		return nullptr;
+	switch (fmt & CARD_ICON_MASK) {
+		case CARD_ICON_RGB:
+			// RGB5A3
+			return (CARD_ICON_W * CARD_ICON_H * 2);
+		case CARD_ICON_CI_UNIQUE:
+			// CI8 with a unique palette.
+			// Palette is located immediately after the icon.
+			return (CARD_ICON_W * CARD_ICON_H * 1) + (256*2);
+		case CARD_ICON_CI_SHARED:
+			// CI8 with a shared palette.
+			// Palette is located after *all* of the icons.
+			return (CARD_ICON_W * CARD_ICON_H * 1);
+		default:
+			// No icon.
+			return 0;
 	}
+}
+
+/**
+ * Decode an icon frame.
+ * @param fmt Icon format. (CARD_ICON_*)
+ * @param pIcon Icon data. (For CARD_ICON_CI_UNIQUE, the palette must follow the icon.)
+ * @param pal_CI8_shared Shared CI8 palette, or nullptr if not present.
+ * @return Icon frame, or nullptr on error.
+ */
+rp_image *GameCubeSavePrivate::decodeIconFrame(unsigned int fmt, const uint8_t *pIcon, const uint16_t *pal_CI8_shared)
+{
+	switch (fmt & CARD_ICON_MASK) {
+		case CARD_ICON_RGB: {
+			// RGB5A3
+			static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 2;
+			return ImageDecoder::fromGcn16(ImageDecoder::PXF_RGB5A3,
+				CARD_ICON_W, CARD_ICON_H,
+				reinterpret_cast<const uint16_t*>(pIcon), iconsize);
+		}
 
+		case CARD_ICON_CI_UNIQUE: {
+			// CI8 with a unique palette.
+			// Palette is located immediately after the icon.
+			static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 1;
+			return ImageDecoder::fromGcnCI8(
+				CARD_ICON_W, CARD_ICON_H,
+				pIcon, iconsize,
+				reinterpret_cast<const uint16_t*>(pIcon + iconsize), 256*2);
+		}
+
+		case CARD_ICON_CI_SHARED: {
+			// CI8 with a shared palette.
+			static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 1;
+			if (!pal_CI8_shared)
+				return nullptr;
+			return ImageDecoder::fromGcnCI8(
+				CARD_ICON_W, CARD_ICON_H,
+				pIcon, iconsize,
+				pal_CI8_shared, 256*2);
+		}
+
+		default:
+			// No icon.
+			return nullptr;
+	}
+}
+
+/**
+ * Load the save file's icon frames.
+ *
+ * All of the required icon data is read with a single read.
+ *
+ * @param firstFrameOnly If true, only read and decode the first frame.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GameCubeSavePrivate::loadIconFrames(bool firstFrameOnly)
+{
 	// Calculate the icon start address.
 	// The icon is located directly after the banner.
 	uint32_t iconaddr = direntry.iconaddr;
@@ -299,6 +404,7 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 	// Calculate the icon sizes.
 	unsigned int iconsizetotal = 0;
 	bool is_CI8_shared = false;
+	int frame_count = 0;
 	uint16_t iconfmt = direntry.iconfmt;
 	uint16_t iconspeed = direntry.iconspeed;
 	for (unsigned int i = 0; i < CARD_MAXICONS; i++, iconfmt >>= 2, iconspeed >>= 2) {
@@ -307,29 +413,11 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 			break;
 		}
 
-		switch (iconfmt & CARD_ICON_MASK) {
-			case CARD_ICON_RGB:
-				// RGB5A3
-				iconsizetotal += (CARD_ICON_W * CARD_ICON_H * 2);
-				break;
-
-			case CARD_ICON_CI_UNIQUE:
-				// CI8 with a unique palette.
-				// Palette is located immediately after the icon.
-				iconsizetotal += (CARD_ICON_W * CARD_ICON_H * 1) + (256*2);
-				break;
-
-			case CARD_ICON_CI_SHARED:
-				// CI8 with a shared palette.
-				// Palette is located after *all* of the icons.
-				iconsizetotal += (CARD_ICON_W * CARD_ICON_H * 1);
-				is_CI8_shared = true;
-				break;
-
-			default:
-				// No icon.
-				break;
+		iconsizetotal += iconFrameSize(iconfmt);
+		if ((iconfmt & CARD_ICON_MASK) == CARD_ICON_CI_SHARED) {
+			is_CI8_shared = true;
 		}
+		frame_count++;
 	}
 
 	if (is_CI8_shared) {
@@ -338,34 +426,58 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 		iconsizetotal += (256*2);
 	}
 
+	const unsigned int fmt0 = (direntry.iconfmt & CARD_ICON_MASK);
+	if (frame_count == 0 || iconsizetotal == 0) {
+		// No icons.
+		icon_frame_count = 0;
+		return -ENOENT;
+	} else if (firstFrameOnly && fmt0 == CARD_ICON_NONE) {
+		// First frame is blank.
+		icon_frame_count = frame_count;
+		return 0;
+	}
+
+	// If only the first frame is needed, only read the first frame,
+	// unless it uses the shared CI8 palette, which is located after
+	// all of the icons.
+	const unsigned int readsize = (firstFrameOnly && fmt0 != CARD_ICON_CI_SHARED)
+		? iconFrameSize(fmt0)
+		: iconsizetotal;
+
 	// Load the icon data.
-	// TODO: Only read the first frame unless specifically requested?
-	auto icondata = aligned_uptr<uint8_t>(16, iconsizetotal);
-	size_t size = file->seekAndRead(dataOffset + iconaddr, icondata.get(), iconsizetotal);
-	if (size != iconsizetotal) {
+	auto icondata = aligned_uptr<uint8_t>(16, readsize);
+	size_t size = file->seekAndRead(dataOffset + iconaddr, icondata.get(), readsize);
+	if (size != readsize) {
 		// Seek and/or read error.
-		return nullptr;
+		return -EIO;
 	}
 
 	const uint16_t *pal_CI8_shared = nullptr;
-	if (is_CI8_shared) {
+	if (is_CI8_shared && readsize == iconsizetotal) {
 		// Shared CI8 palette is at the end of the data.
 		pal_CI8_shared = reinterpret_cast<const uint16_t*>(
 			icondata.get() + (iconsizetotal - (256*2)));
 	}
 
+	icon_frame_count = frame_count;
+	if (!icon_first_frame) {
+		icon_first_frame = decodeIconFrame(fmt0, icondata.get(), pal_CI8_shared);
+	}
+	if (firstFrameOnly) {
+		// Only the first frame was requested.
+		return 0;
+	}
+
 	this->iconAnimData = new IconAnimData();
-	iconAnimData->count = 0;
+	iconAnimData->count = frame_count;
 
+	// Decode the icon frames.
+	// The first frame was decoded above, or by a previous loadIcon().
 	unsigned int iconaddr_cur = 0;
 	iconfmt = direntry.iconfmt;
 	iconspeed = direntry.iconspeed;
-	for (int i = 0; i < CARD_MAXICONS; i++, iconfmt >>= 2, iconspeed >>= 2) {
+	for (int i = 0; i < frame_count; i++, iconfmt >>= 2, iconspeed >>= 2) {
 		const unsigned int delay = (iconspeed & CARD_SPEED_MASK);
-		if (delay == CARD_SPEED_END) {
-			// End of the icons.
-			break;
-		}
 
 		// Icon delay.
 		// Using 125ms for the fastest speed.
@@ -374,54 +486,16 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 		iconAnimData->delays[i].denom = 8;
 		iconAnimData->delays[i].ms = delay * 125;
 
-		switch (iconfmt & CARD_ICON_MASK) {
-			case CARD_ICON_RGB: {
-				// RGB5A3
-				static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 2;
-				iconAnimData->frames[i] = ImageDecoder::fromGcn16(ImageDecoder::PXF_RGB5A3,
-					CARD_ICON_W, CARD_ICON_H,
-					reinterpret_cast<const uint16_t*>(icondata.get() + iconaddr_cur),
-					iconsize);
-				iconaddr_cur += iconsize;
-				break;
-			}
-
-			case CARD_ICON_CI_UNIQUE: {
-				// CI8 with a unique palette.
-				// Palette is located immediately after the icon.
-				static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 1;
-				iconAnimData->frames[i] = ImageDecoder::fromGcnCI8(
-					CARD_ICON_W, CARD_ICON_H,
-					icondata.get() + iconaddr_cur, iconsize,
-					reinterpret_cast<const uint16_t*>(icondata.get() + iconaddr_cur + iconsize), 256*2);
-				iconaddr_cur += iconsize + (256*2);
-				break;
-			}
-
-			case CARD_ICON_CI_SHARED: {
-				static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 1;
-				iconAnimData->frames[i] = ImageDecoder::fromGcnCI8(
-					CARD_ICON_W, CARD_ICON_H,
-					icondata.get() + iconaddr_cur, iconsize,
-					pal_CI8_shared, 256*2);
-				iconaddr_cur += iconsize;
-				break;
-			}
-
-			default:
-				// No icon.
-				// Add a nullptr as a placeholder.
-				iconAnimData->frames[i] = 0;
-				break;
+		// NOTE: Blank frames are stored as nullptr placeholders.
+		if (i == 0) {
+			iconAnimData->frames[0] = (icon_first_frame ? icon_first_frame->ref() : nullptr);
+		} else {
+			iconAnimData->frames[i] = decodeIconFrame(iconfmt,
+				icondata.get() + iconaddr_cur, pal_CI8_shared);
 		}
-
-		iconAnimData->count++;
+		iconaddr_cur += iconFrameSize(iconfmt);
 	}
 
-	// NOTE: We're not deleting iconAnimData even if we only have
-	// a single icon because iconAnimData() will call loadIcon()
-	// if iconAnimData is nullptr.
-
 	// Set up the icon animation sequence.
 	// FIXME: This isn't done correctly if blank frames are present
 	// and the icon uses the "bounce" animation.
@@ -438,9 +512,50 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 		}
 	}
 	iconAnimData->seq_count = idx;
+	return 0;
+}
+
+/**
+ * Load the save file's icon.
+ *
+ * Only the first frame is decoded.
+ * Use loadIconAnimData() to decode the animated icon.
+ *
+ * @return Icon, or nullptr on error.
+ */
+const rp_image *GameCubeSavePrivate::loadIcon(void)
+{
+	if (icon_frame_count >= 0) {
+		// Icon has already been loaded.
+		return icon_first_frame;
+	} else if (!this->file || !this->isValid) {
+		// Can't load the icon.
+		return nullptr;
+	}
 
-	// Return the first frame.
-	return iconAnimData->frames[0];
+	loadIconFrames(true);
+	return icon_first_frame;
+}
+
+/**
+ * Load the save file's animated icon.
+ * @return Animated icon data, or nullptr on error.
+ */
+const IconAnimData *GameCubeSavePrivate::loadIconAnimData(void)
+{
+	if (iconAnimData) {
+		// Animated icon has already been loaded.
+		return iconAnimData;
+	} else if (icon_frame_count == 0) {
+		// No icons.
+		return nullptr;
+	} else if (!this->file || !this->isValid) {
+		// Can't load the icon.
+		return nullptr;
+	}
+
+	loadIconFrames(false);
+	return iconAnimData;
 }
 
 /**
@@ -816,7 +931,7 @@ uint32_t GameCubeSave::imgpf(ImageType imageType) const
 			// Use nearest-neighbor scaling when resizing.
 			// Also, need to check if this is an animated icon.
 			const_cast<GameCubeSavePrivate*>(d)->loadIcon();
-			if (d->iconAnimData && d->iconAnimData->count > 1) {
+			if (d->icon_frame_count > 1) {
 				// Animated icon.
 				ret = IMGPF_RESCALE_NEAREST | IMGPF_ICON_ANIMATED;
 			} else {
@@ -1035,11 +1150,11 @@ int GameCubeSave::loadInternalImage(ImageType imageType, const rp_image **pImage
 	RP_D(GameCubeSave);
 	switch (imageType) {
 		case IMG_INT_ICON:
-			if (d->iconAnimData) {
+			if (d->icon_first_frame) {
 				// Return the first icon frame.
 				// NOTE: GCN save icon animations are always
 				// sequential, so we can use a shortcut here.
-				*pImage = d->iconAnimData->frames[0];
+				*pImage = d->icon_first_frame;
 				return 0;
 			}
 			break;
@@ -1095,27 +1210,22 @@ int GameCubeSave::loadInternalImage(ImageType imageType, const rp_image **pImage
 const IconAnimData *GameCubeSave::iconAnimData(void) const
 {
 	RP_D(const GameCubeSave);
-	if (!d->iconAnimData) {
-		// Load the icon.
-		if (!const_cast<GameCubeSavePrivate*>(d)->loadIcon()) {
-			// Error loading the icon.
-			return nullptr;
-		}
-		if (!d->iconAnimData) {
-			// Still no icon...
-			return nullptr;
-		}
+	const IconAnimData *const iconAnimData =
+		const_cast<GameCubeSavePrivate*>(d)->loadIconAnimData();
+	if (!iconAnimData) {
+		// Error loading the icon.
+		return nullptr;
 	}
 
-	if (d->iconAnimData->count <= 1 ||
-	    d->iconAnimData->seq_count <= 1)
+	if (iconAnimData->count <= 1 ||
+	    iconAnimData->seq_count <= 1)
 	{
 		// Not an animated icon.
 		return nullptr;
 	}
 
 	// Return the icon animation data.
-	return d->iconAnimData;
+	return iconAnimData;
 }
 
 }
@@ -14,6 +14,7 @@
 #include "MegaDriveRegions.hpp"
 #include "CopierFormats.h"
 #include "utils/SuperMagicDrive.hpp"
+#include "utils/RomChecksum.hpp"
 
 // librpbase, librpfile
 using namespace LibRpBase;
@@ -138,6 +139,28 @@ class MegaDrivePrivate final : public RomDataPrivate
 		 */
 		void addFields_vectorTable(const M68K_VectorTable *pVectors);
 
+	public:
+		/** Checksum verification. (ROF_VERIFY) **/
+
+		// Calculated checksum. (-1 if not verified)
+		int calcChecksum;
+		// Field index for the checksum. (-1 if not loaded)
+		int fieldIdx_checksum;
+
+		/**
+		 * Verify the ROM checksum.
+		 * This reads the entire ROM image.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int verifyChecksum(void);
+
+		/**
+		 * Get the checksum field string.
+		 * @param checksum Checksum from the ROM header.
+		 * @return Checksum field string.
+		 */
+		string getChecksumString(uint16_t checksum) const;
+
 	public:
 		// ROM header.
 		// NOTE: Must be byteswapped on access.
@@ -165,6 +188,8 @@ MegaDrivePrivate::MegaDrivePrivate(MegaDrive *q, IRpFile *file)
 	: super(q, file)
 	, romType(ROM_UNKNOWN)
 	, md_region(0)
+	, calcChecksum(-1)
+	, fieldIdx_checksum(-1)
 {
 	// Clear the various structs.
 	memset(&vectors, 0, sizeof(vectors));
@@ -291,8 +316,12 @@ void MegaDrivePrivate::addFields_romHeader(const MD_RomHeader *pRomHeader, bool
 			RomFields::STRF_TRIM_END);
 	if (!isDisc()) {
 		// Checksum. (MD only; not valid for Mega CD.)
-		fields->addField_string_numeric(C_("RomData", "Checksum"),
-			be16_to_cpu(pRomHeader->checksum), RomFields::Base::Hex, 4,
+		// NOTE: Only the main ROM header can be verified.
+		if (pRomHeader == &romHeader) {
+			fieldIdx_checksum = static_cast<int>(fields->count());
+		}
+		fields->addField_string(C_("RomData", "Checksum"),
+			getChecksumString(be16_to_cpu(pRomHeader->checksum)),
 			RomFields::STRF_MONOSPACE);
 	}
 
@@ -409,6 +438,91 @@ void MegaDrivePrivate::addFields_romHeader(const MD_RomHeader *pRomHeader, bool
 		v_region_code_bitfield_names, 0, md_region_check);
 }
 
+/**
+ * Verify the ROM checksum.
+ * This reads the entire ROM image.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MegaDrivePrivate::verifyChecksum(void)
+{
+	if (!this->file) {
+		return -EBADF;
+	} else if (isDisc()) {
+		// Mega CD discs don't have a checksum.
+		return -ENOTSUP;
+	}
+
+	// The checksum is the sum of all 16-bit BE words
+	// starting at 0x200, i.e. (256 * even bytes) + odd bytes.
+	uint64_t sums[2] = {0, 0};
+	const off64_t fileSize = file->size();
+	if ((romType & ROM_FORMAT_MASK) == ROM_FORMAT_CART_SMD) {
+		// SMD format: Decode the blocks first.
+		// The ROM header is in the first decoded block,
+		// so skip the first 0x200 bytes of decoded data.
+		static const size_t SMD_CHUNK_SIZE = 1024*1024;
+		static_assert(SMD_CHUNK_SIZE % SuperMagicDrive::SMD_BLOCK_SIZE == 0,
+			"SMD_CHUNK_SIZE must be a multiple of SMD_BLOCK_SIZE.");
+		off64_t length = fileSize - 512;
+		if (length <= 0x200 || length % SuperMagicDrive::SMD_BLOCK_SIZE != 0) {
+			// Not a valid SMD image.
+			return -EIO;
+		}
+
+		auto buf = aligned_uptr<uint8_t>(16, SMD_CHUNK_SIZE * 2);
+		uint8_t *const smd_data = buf.get();
+		uint8_t *const bin_data = smd_data + SMD_CHUNK_SIZE;
+		off64_t offset = 512;
+		unsigned int skip = 0x200;
+		while (length > 0) {
+			const size_t chunkSize = static_cast<size_t>(
+				std::min(length, static_cast<off64_t>(SMD_CHUNK_SIZE)));
+			size_t size = file->seekAndRead(offset, smd_data, chunkSize);
+			if (size != chunkSize) {
+				// Short read.
+				const int err = file->lastError();
+				return (err != 0 ? -err : -EIO);
+			}
+
+			SuperMagicDrive::decodeBlocks(bin_data, smd_data,
+				chunkSize / SuperMagicDrive::SMD_BLOCK_SIZE);
+			RomChecksum::sumBytes(bin_data + skip, chunkSize - skip, sums);
+			skip = 0;
+			offset += chunkSize;
+			length -= chunkSize;
+		}
+	} else {
+		// Plain binary format.
+		if (fileSize <= 0x200) {
+			return -EIO;
+		}
+		int ret = RomChecksum::sumFileBytes(file, 0x200, fileSize - 0x200, sums);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	calcChecksum = static_cast<uint16_t>((sums[0] << 8) + sums[1]);
+	return 0;
+}
+
+/**
+ * Get the checksum field string.
+ * @param checksum Checksum from the ROM header.
+ * @return Checksum field string.
+ */
+string MegaDrivePrivate::getChecksumString(uint16_t checksum) const
+{
+	if (calcChecksum < 0) {
+		// Not verified.
+		return rp_sprintf("0x%04X", checksum);
+	} else if (calcChecksum != checksum) {
+		return rp_sprintf_p(C_("MegaDrive", "0x%1$04X (INVALID; should be 0x%2$04X)"),
+			checksum, static_cast<unsigned int>(calcChecksum));
+	}
+	return rp_sprintf(C_("MegaDrive", "0x%04X (valid)"), checksum);
+}
+
 /**
  * Add fields for the vector table.
  *
@@ -1018,4 +1132,66 @@ int MegaDrive::loadFieldData(void)
 	return static_cast<int>(d->fields->count());
 }
 
+/**
+ * Get the list of operations that can be performed on this ROM.
+ * Internal function; called by RomData::romOps().
+ * @return List of operations.
+ */
+vector<RomData::RomOp> MegaDrive::romOps_int(void) const
+{
+	RP_D(const MegaDrive);
+	vector<RomOp> ops;
+
+	// Verify the checksum. (MD only; not valid for Mega CD.)
+	RomOp op(C_("MegaDrive|RomOps", "&Verify Checksum"), RomOp::ROF_VERIFY);
+	if (d->isValid && !d->isDisc()) {
+		op.flags |= RomOp::ROF_ENABLED;
+	}
+	ops.emplace_back(std::move(op));
+
+	return ops;
+}
+
+/**
+ * Perform a ROM operation.
+ * Internal function; called by RomData::doRomOp().
+ * @param id		[in] Operation index.
+ * @param pParams	[in/out] Parameters and results. (for e.g. UI updates)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MegaDrive::doRomOp_int(int id, RomOpParams *pParams)
+{
+	RP_D(MegaDrive);
+	if (id != 0) {
+		pParams->status = -EINVAL;
+		pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
+		return -EINVAL;
+	}
+
+	// Verify the checksum.
+	int ret = d->verifyChecksum();
+	pParams->status = ret;
+	if (ret != 0) {
+		pParams->msg = rp_sprintf(C_("MegaDrive", "Unable to verify the checksum: %s"),
+			strerror(-ret));
+		return ret;
+	}
+
+	const uint16_t checksum = be16_to_cpu(d->romHeader.checksum);
+	if (d->calcChecksum == checksum) {
+		pParams->msg = C_("MegaDrive", "The checksum is valid.");
+	} else {
+		pParams->msg = rp_sprintf(C_("MegaDrive", "The checksum is INVALID. (should be 0x%04X)"),
+			static_cast<unsigned int>(d->calcChecksum));
+	}
+
+	// Update the field if the fields were already loaded.
+	if (!d->fields->empty() && d->fieldIdx_checksum >= 0) {
+		d->fields->updateField_string(d->fieldIdx_checksum,
+			d->getChecksumString(checksum).c_str());
+		pParams->fieldIdx.emplace_back(d->fieldIdx_checksum);
+	}
+	return 0;
+}
+
 }
@@ -14,6 +14,7 @@
 namespace LibRomData {
 
 ROMDATA_DECL_BEGIN(MegaDrive)
+ROMDATA_DECL_ROMOPS()
 ROMDATA_DECL_END()
 
 }
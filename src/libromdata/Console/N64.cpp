@@ -9,6 +9,7 @@
 #include "stdafx.h"
 #include "N64.hpp"
 #include "n64_structs.h"
+#include "utils/RomChecksum.hpp"
 
 // librpbase, librpfile
 using namespace LibRpBase;
@@ -20,6 +21,9 @@ using std::vector;
 
 namespace LibRomData {
 
+// Unswap a 32-bit word in swap2 format.
+#define UNSWAP2(x) (uint32_t)(((x) >> 16) | ((x) << 16))
+
 ROMDATA_IMPL(N64)
 
 class N64Private final : public RomDataPrivate
@@ -49,6 +53,34 @@ class N64Private final : public RomDataPrivate
 		// ROM header.
 		// NOTE: Fields have been byteswapped in the constructor.
 		N64_RomHeader romHeader;
+
+	public:
+		/** CRC verification. (ROF_VERIFY) **/
+
+		// Matching CIC, or one of the CIC_* values.
+		enum {
+			CIC_NOT_VERIFIED	= -1,
+			CIC_NO_MATCH		= -2,
+		};
+		int cic;
+		// Calculated CRCs for CIC-NUS-6102. (used if no CIC matched)
+		uint32_t calcCrc6102[2];
+		// Field index for the CRCs. (-1 if not loaded)
+		int fieldIdx_crcs;
+
+		/**
+		 * Verify the ROM CRCs.
+		 * This reads the first 1 MB of the ROM image
+		 * after the bootcode.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int verifyCrcs(void);
+
+		/**
+		 * Get the CRCs field string.
+		 * @return CRCs field string.
+		 */
+		string getCrcsString(void) const;
 };
 
 /** N64Private **/
@@ -56,9 +88,104 @@ class N64Private final : public RomDataPrivate
 N64Private::N64Private(N64 *q, IRpFile *file)
 	: super(q, file)
 	, romType(RomType::Unknown)
+	, cic(CIC_NOT_VERIFIED)
+	, fieldIdx_crcs(-1)
 {
 	// Clear the ROM header struct.
 	memset(&romHeader, 0, sizeof(romHeader));
+	calcCrc6102[0] = 0;
+	calcCrc6102[1] = 0;
+}
+
+/**
+ * Verify the ROM CRCs.
+ * This reads the first 1 MB of the ROM image
+ * after the bootcode.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int N64Private::verifyCrcs(void)
+{
+	if (!this->file) {
+		return -EBADF;
+	}
+
+	// Read the bootcode and the CRC region.
+	static const size_t CRC_READ_SIZE =
+		RomChecksum::N64_CRC_START + RomChecksum::N64_CRC_LENGTH;
+	auto buf = aligned_uptr<uint8_t>(16, CRC_READ_SIZE);
+	size_t size = file->seekAndRead(0, buf.get(), CRC_READ_SIZE);
+	if (size != CRC_READ_SIZE) {
+		// Short read. The ROM is probably too small.
+		const int err = file->lastError();
+		return (err != 0 ? -err : -EIO);
+	}
+
+	// Convert to Z64 format.
+	switch (romType) {
+		case RomType::Z64:
+			break;
+		case RomType::V64:
+			__byte_swap_16_array(reinterpret_cast<uint16_t*>(buf.get()), CRC_READ_SIZE);
+			break;
+		case RomType::SWAP2: {
+			uint32_t *p32 = reinterpret_cast<uint32_t*>(buf.get());
+			const uint32_t *const p32_end = p32 + (CRC_READ_SIZE / 4);
+			for (; p32 < p32_end; p32++) {
+				*p32 = UNSWAP2(*p32);
+			}
+			break;
+		}
+		case RomType::LE32:
+			__byte_swap_32_array(reinterpret_cast<uint32_t*>(buf.get()), CRC_READ_SIZE);
+			break;
+		default:
+			assert(!"Invalid ROM type.");
+			return -EIO;
+	}
+
+	// Calculate the CRCs for all CIC variants in one pass.
+	uint32_t crcs[RomChecksum::N64_CIC_MAX][2];
+	RomChecksum::n64CicCrcs(buf.get() + RomChecksum::N64_CRC_START, RomChecksum::N64_CRC_LENGTH,
+		buf.get() + RomChecksum::N64_CIC6105_BOOTCODE_ADDR, crcs);
+
+	cic = CIC_NO_MATCH;
+	for (int i = 0; i < RomChecksum::N64_CIC_MAX; i++) {
+		if (crcs[i][0] == romHeader.crc[0] && crcs[i][1] == romHeader.crc[1]) {
+			cic = i;
+			break;
+		}
+	}
+	calcCrc6102[0] = crcs[RomChecksum::N64_CIC_6102][0];
+	calcCrc6102[1] = crcs[RomChecksum::N64_CIC_6102][1];
+	return 0;
+}
+
+/**
+ * Get the CRCs field string.
+ * @return CRCs field string.
+ */
+string N64Private::getCrcsString(void) const
+{
+	static const char cic_names[RomChecksum::N64_CIC_MAX][20] = {
+		"CIC-NUS-6102/7101",
+		"CIC-NUS-6103/7103",
+		"CIC-NUS-6105/7105",
+		"CIC-NUS-6106/7106",
+	};
+
+	switch (cic) {
+		case CIC_NOT_VERIFIED:
+			return rp_sprintf("0x%08X 0x%08X", romHeader.crc[0], romHeader.crc[1]);
+		case CIC_NO_MATCH:
+			// NOTE: Showing the CIC-NUS-6102 CRCs, since that's the most common CIC.
+			return rp_sprintf_p(C_("N64", "0x%1$08X 0x%2$08X (INVALID; should be 0x%3$08X 0x%4$08X for %5$s)"),
+				romHeader.crc[0], romHeader.crc[1],
+				calcCrc6102[0], calcCrc6102[1], cic_names[RomChecksum::N64_CIC_6102]);
+		default:
+			assert(cic >= 0 && cic < RomChecksum::N64_CIC_MAX);
+			return rp_sprintf_p(C_("N64", "0x%1$08X 0x%2$08X (valid; %3$s)"),
+				romHeader.crc[0], romHeader.crc[1], cic_names[cic]);
+	}
 }
 
 /** N64 **/
@@ -119,7 +246,6 @@ N64::N64(IRpFile *file)
 		case N64Private::RomType::SWAP2:
 			// swap2 format. (wordswapped)
 			// Convert the header to Z64 first.
-			#define UNSWAP2(x) (uint32_t)(((x) >> 16) | ((x) << 16))
 			for (int i = 0; i < ARRAY_SIZE(d->romHeader.u32); i++) {
 				d->romHeader.u32[i] = UNSWAP2(d->romHeader.u32[i]);
 			}
@@ -330,10 +456,9 @@ int N64::loadFieldData(void)
 	}
 
 	// CRCs.
-	snprintf(buf, sizeof(buf), "0x%08X 0x%08X",
-		romHeader->crc[0], romHeader->crc[1]);
+	d->fieldIdx_crcs = static_cast<int>(d->fields->count());
 	d->fields->addField_string(C_("N64", "CRCs"),
-		buf, RomFields::STRF_MONOSPACE);
+		d->getCrcsString(), RomFields::STRF_MONOSPACE);
 
 	// Finished reading the field data.
 	return static_cast<int>(d->fields->count());
@@ -376,4 +501,63 @@ int N64::loadMetaData(void)
 	return static_cast<int>(d->metaData->count());
 }
 
+/**
+ * Get the list of operations that can be performed on this ROM.
+ * Internal function; called by RomData::romOps().
+ * @return List of operations.
+ */
+vector<RomData::RomOp> N64::romOps_int(void) const
+{
+	RP_D(const N64);
+	vector<RomOp> ops;
+
+	// Verify the CRCs.
+	RomOp op(C_("N64|RomOps", "&Verify CRCs"), RomOp::ROF_VERIFY);
+	if (d->isValid && (int)d->romType >= 0) {
+		op.flags |= RomOp::ROF_ENABLED;
+	}
+	ops.emplace_back(std::move(op));
+
+	return ops;
+}
+
+/**
+ * Perform a ROM operation.
+ * Internal function; called by RomData::doRomOp().
+ * @param id		[in] Operation index.
+ * @param pParams	[in/out] Parameters and results. (for e.g. UI updates)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int N64::doRomOp_int(int id, RomOpParams *pParams)
+{
+	RP_D(N64);
+	if (id != 0) {
+		pParams->status = -EINVAL;
+		pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
+		return -EINVAL;
+	}
+
+	// Verify the CRCs.
+	int ret = d->verifyCrcs();
+	pParams->status = ret;
+	if (ret != 0) {
+		pParams->msg = rp_sprintf(C_("N64", "Unable to verify the CRCs: %s"),
+			strerror(-ret));
+		return ret;
+	}
+
+	if (d->cic >= 0) {
+		pParams->msg = C_("N64", "The CRCs are valid.");
+	} else {
+		pParams->msg = C_("N64", "The CRCs are INVALID.");
+	}
+
+	// Update the field if the fields were already loaded.
+	if (!d->fields->empty() && d->fieldIdx_crcs >= 0) {
+		d->fields->updateField_string(d->fieldIdx_crcs, d->getCrcsString().c_str());
+		pParams->fieldIdx.emplace_back(d->fieldIdx_crcs);
+	}
+	return 0;
+}
+
 }
@@ -15,6 +15,7 @@ namespace LibRomData {
 
 ROMDATA_DECL_BEGIN(N64)
 ROMDATA_DECL_METADATA()
+ROMDATA_DECL_ROMOPS()
 ROMDATA_DECL_END()
 
 }
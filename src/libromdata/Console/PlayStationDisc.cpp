@@ -175,31 +175,38 @@ int PlayStationDiscPrivate::loadSystemCnf(IsoPartition *pt)
 		return 0;
 	}
 
-	IRpFile *const f_system_cnf = pt->open("SYSTEM.CNF");
+	// Probe for SYSTEM.CNF and PSX.EXE at the same time.
+	// SYSTEM.CNF might not be present.
+	// If it isn't, but PSX.EXE is present, use default values.
+	static const char *const filenames[2] = {"SYSTEM.CNF", "PSX.EXE"};
+	IRpFile *files[2];
+	int errs[2];
+	pt->openMany(filenames, 2, files, errs);
+	IRpFile *const f_system_cnf = files[0];
+	IRpFile *const f_psx_exe = files[1];
 	if (!f_system_cnf) {
-		// SYSTEM.CNF might not be present.
-		// If it isn't, but PSX.EXE is present, use default values.
-		int ret = pt->lastError();
+		int ret = errs[0];
 		if (ret == ENOENT) {
 			// SYSTEM.CNF not found. Check for PSX.EXE.
-			IRpFile *const f_psx_exe = pt->open("PSX.EXE");
 			if (f_psx_exe && f_psx_exe->isOpen()) {
 				// Found PSX.EXE.
 				boot_filename = "PSX.EXE";
 				system_cnf.emplace(std::make_pair("BOOT", boot_filename));
-				if (f_psx_exe) {
-					f_psx_exe->unref();
-				}
+				f_psx_exe->unref();
 				// Pretend that we did find SYSTEM.CNF.
 				return 0;
 			} else {
 				// Not found.
+				UNREF(f_psx_exe);
 				return -ENOENT;
 			}
 		} else {
+			UNREF(f_psx_exe);
 			return (ret == 0 ? -EIO : -ret);
 		}
-	} else if (!f_system_cnf->isOpen()) {
+	}
+	UNREF(f_psx_exe);
+	if (!f_system_cnf->isOpen()) {
 		int ret = -f_system_cnf->lastError();
 		if (ret == 0) {
 			ret = -EIO;
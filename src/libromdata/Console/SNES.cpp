@@ -11,6 +11,7 @@
 #include "data/NintendoPublishers.hpp"
 #include "snes_structs.h"
 #include "CopierFormats.h"
+#include "utils/RomChecksum.hpp"
 
 // librpbase, librpfile
 #include "librpbase/SystemRegion.hpp"
@@ -108,6 +109,27 @@ class SNESPrivate final : public RomDataPrivate
 		 * @return Game ID if available; empty string if not.
 		 */
 		string getGameID(bool doFake = false) const;
+
+	public:
+		/** Checksum verification. (ROF_VERIFY) **/
+
+		// Calculated checksum. (-1 if not verified)
+		int calcChecksum;
+		// Field index for the checksum. (-1 if not loaded)
+		int fieldIdx_checksum;
+
+		/**
+		 * Verify the ROM checksum.
+		 * This reads the entire ROM image.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int verifyChecksum(void);
+
+		/**
+		 * Get the checksum field string.
+		 * @return Checksum field string.
+		 */
+		string getChecksumString(void) const;
 };
 
 /** SNESPrivate **/
@@ -116,11 +138,68 @@ SNESPrivate::SNESPrivate(SNES *q, IRpFile *file)
 	: super(q, file)
 	, romType(RomType::Unknown)
 	, header_address(0)
+	, calcChecksum(-1)
+	, fieldIdx_checksum(-1)
 {
 	// Clear the ROM header struct.
 	memset(&romHeader, 0, sizeof(romHeader));
 }
 
+/**
+ * Verify the ROM checksum.
+ * This reads the entire ROM image.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SNESPrivate::verifyChecksum(void)
+{
+	if (!this->file) {
+		return -EBADF;
+	} else if (romType != RomType::SNES) {
+		// TODO: BS-X checksums.
+		return -ENOTSUP;
+	}
+
+	// If the header is at +512, a copier header is present.
+	const unsigned int copierHeaderSize =
+		((header_address & 0x7FFF) == 0x7FB0) ? 0 : 512;
+	const off64_t fileSize = file->size();
+	if (fileSize <= copierHeaderSize || fileSize > 64*1024*1024) {
+		// File is either too small or too large.
+		return -EIO;
+	}
+
+	// The stored checksum and complement are included in
+	// the sum. They always add up to 0x1FE, so the result
+	// doesn't depend on their values.
+	// TODO: Interleaved ROMs. (SWC/UFO "split" images)
+	uint16_t checksum = 0;
+	int ret = RomChecksum::snesChecksum(file, copierHeaderSize,
+		static_cast<uint32_t>(fileSize - copierHeaderSize), &checksum);
+	if (ret != 0) {
+		return ret;
+	}
+
+	calcChecksum = checksum;
+	return 0;
+}
+
+/**
+ * Get the checksum field string.
+ * @return Checksum field string.
+ */
+string SNESPrivate::getChecksumString(void) const
+{
+	const uint16_t checksum = le16_to_cpu(romHeader.snes.checksum);
+	if (calcChecksum < 0) {
+		// Not verified.
+		return rp_sprintf("0x%04X", checksum);
+	} else if (calcChecksum != checksum) {
+		return rp_sprintf_p(C_("SNES", "0x%1$04X (INVALID; should be 0x%2$04X)"),
+			checksum, static_cast<unsigned int>(calcChecksum));
+	}
+	return rp_sprintf(C_("SNES", "0x%04X (valid)"), checksum);
+}
+
 /**
  * Get the SNES ROM mapping and validate it.
  * @param romHeader	[in] SNES/SFC ROM header to check.
@@ -1194,7 +1273,7 @@ int SNES::loadFieldData(void)
 
 	// ROM file header is read in the constructor.
 	const SNES_RomHeader *const romHeader = &d->romHeader;
-	d->fields->reserve(8); // Maximum of 8 fields.
+	d->fields->reserve(9); // Maximum of 9 fields.
 
 	// Cartridge HW.
 	// TODO: Make this translatable.
@@ -1391,6 +1470,12 @@ int SNES::loadFieldData(void)
 			d->fields->addField_string_numeric(C_("SNES", "Revision"),
 				romHeader->snes.version, RomFields::Base::Dec, 2);
 
+			// Checksum
+			// This is only checked if the ROM image was verified.
+			d->fieldIdx_checksum = static_cast<int>(d->fields->count());
+			d->fields->addField_string(C_("RomData", "Checksum"),
+				d->getChecksumString(), RomFields::STRF_MONOSPACE);
+
 			break;
 		}
 
@@ -1630,4 +1715,64 @@ int SNES::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) const
 	return 0;
 }
 
+/**
+ * Get the list of operations that can be performed on this ROM.
+ * Internal function; called by RomData::romOps().
+ * @return List of operations.
+ */
+vector<RomData::RomOp> SNES::romOps_int(void) const
+{
+	RP_D(const SNES);
+	vector<RomOp> ops;
+
+	// Verify the checksum. (SNES only; not BS-X)
+	RomOp op(C_("SNES|RomOps", "&Verify Checksum"), RomOp::ROF_VERIFY);
+	if (d->isValid && d->romType == SNESPrivate::RomType::SNES) {
+		op.flags |= RomOp::ROF_ENABLED;
+	}
+	ops.emplace_back(std::move(op));
+
+	return ops;
+}
+
+/**
+ * Perform a ROM operation.
+ * Internal function; called by RomData::doRomOp().
+ * @param id		[in] Operation index.
+ * @param pParams	[in/out] Parameters and results. (for e.g. UI updates)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SNES::doRomOp_int(int id, RomOpParams *pParams)
+{
+	RP_D(SNES);
+	if (id != 0) {
+		pParams->status = -EINVAL;
+		pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
+		return -EINVAL;
+	}
+
+	// Verify the checksum.
+	int ret = d->verifyChecksum();
+	pParams->status = ret;
+	if (ret != 0) {
+		pParams->msg = rp_sprintf(C_("SNES", "Unable to verify the checksum: %s"),
+			strerror(-ret));
+		return ret;
+	}
+
+	if (d->calcChecksum == le16_to_cpu(d->romHeader.snes.checksum)) {
+		pParams->msg = C_("SNES", "The checksum is valid.");
+	} else {
+		pParams->msg = rp_sprintf(C_("SNES", "The checksum is INVALID. (should be 0x%04X)"),
+			static_cast<unsigned int>(d->calcChecksum));
+	}
+
+	// Update the field if the fields were already loaded.
+	if (!d->fields->empty() && d->fieldIdx_checksum >= 0) {
+		d->fields->updateField_string(d->fieldIdx_checksum, d->getChecksumString().c_str());
+		pParams->fieldIdx.emplace_back(d->fieldIdx_checksum);
+	}
+	return 0;
+}
+
 }
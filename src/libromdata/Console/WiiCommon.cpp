@@ -16,10 +16,30 @@
 using namespace LibRpBase;
 
 // C++ STL classes.
+using std::shared_ptr;
 using std::string;
 
 namespace LibRomData {
 
+/**
+ * Get the language code for a Wii banner language ID.
+ * @param langID	[in] Language ID.
+ * @param gcnRegion	[in] GameCube region code.
+ * @param id4_region	[in] ID4 region.
+ * @return Language code, or 0 if the language ID isn't valid.
+ */
+static uint32_t getWiiBannerLanguageCode(int langID, uint32_t gcnRegion, char id4_region)
+{
+	if (gcnRegion == GCN_REGION_JPN && id4_region == 'W' && langID == WII_LANG_JAPANESE) {
+		// Special case: RVL-001(TWN) has a JPN region code.
+		// Game discs with disc ID region 'W' are localized
+		// for Taiwan and use Traditional Chinese in the
+		// Japanese language slot.
+		return 'hant';
+	}
+	return NintendoLanguage::getWiiLanguageCode(langID);
+}
+
 /**
  * Get a multi-language string map from a Wii banner.
  * @param pImet		[in] Wii_IMET_t
@@ -45,7 +65,32 @@ RomFields::StringMultiMap_t *WiiCommon::getWiiBannerStrings(
 	// If it is, we'll de-duplicate fields.
 	bool dedupe_titles = (pImet->names[WII_LANG_ENGLISH][0][0] != cpu_to_be16('\0'));
 
-	RomFields::StringMultiMap_t *const pMap_bannerName = new RomFields::StringMultiMap_t();
+	// The strings are converted to UTF-8 when they're first accessed.
+	// NOTE: The converter needs its own copy of the names, since
+	// the field may outlive the caller if it's shared.
+	shared_ptr<Wii_IMET_t> imet = std::make_shared<Wii_IMET_t>(*pImet);
+	RomFields::StringMultiMap_t *const pMap_bannerName = new RomFields::StringMultiMap_t(
+		[imet, gcnRegion, id4_region](uint32_t lc) -> string {
+			for (int langID = 0; langID < WII_LANG_MAX; langID++) {
+				if (langID == 7 || langID == 8)
+					continue;
+				if (getWiiBannerLanguageCode(langID, gcnRegion, id4_region) != lc)
+					continue;
+
+				// NOTE: The banner may have two lines.
+				// Each line is a maximum of 21 characters.
+				// Convert from UTF-16 BE and split into two lines at the same time.
+				const auto &names = imet->names[langID];
+				string info = utf16be_to_utf8(names[0], ARRAY_SIZE(names[0]));
+				if (names[1][0] != cpu_to_be16('\0')) {
+					info += '\n';
+					info += utf16be_to_utf8(names[1], ARRAY_SIZE(names[1]));
+				}
+				return info;
+			}
+			assert(!"Language code not found.");
+			return string();
+		});
 	for (int langID = 0; langID < WII_LANG_MAX; langID++) {
 		if (langID == 7 || langID == 8) {
 			// Unknown languages. Skip them. (Maybe these were Chinese?)
@@ -75,31 +120,13 @@ RomFields::StringMultiMap_t *WiiCommon::getWiiBannerStrings(
 			}
 		}
 
-		uint32_t lc;
-		if (gcnRegion == GCN_REGION_JPN && id4_region == 'W' && langID == WII_LANG_JAPANESE) {
-			// Special case: RVL-001(TWN) has a JPN region code.
-			// Game discs with disc ID region 'W' are localized
-			// for Taiwan and use Traditional Chinese in the
-			// Japanese language slot.
-			lc = 'hant';
-		} else {
-			lc = NintendoLanguage::getWiiLanguageCode(langID);
-			assert(lc != 0);
-			if (lc == 0)
-				continue;
-		}
+		const uint32_t lc = getWiiBannerLanguageCode(langID, gcnRegion, id4_region);
+		assert(lc != 0);
+		if (lc == 0)
+			continue;
 
 		if (pImet->names[langID][0][0] != cpu_to_be16('\0')) {
-			// NOTE: The banner may have two lines.
-			// Each line is a maximum of 21 characters.
-			// Convert from UTF-16 BE and split into two lines at the same time.
-			string info = utf16be_to_utf8(pImet->names[langID][0], ARRAY_SIZE(pImet->names[langID][0]));
-			if (pImet->names[langID][1][0] != cpu_to_be16('\0')) {
-				info += '\n';
-				info += utf16be_to_utf8(pImet->names[langID][1], ARRAY_SIZE(pImet->names[langID][1]));
-			}
-
-			pMap_bannerName->insert(std::make_pair(lc, std::move(info)));
+			pMap_bannerName->addLazy(lc);
 		}
 	}
 
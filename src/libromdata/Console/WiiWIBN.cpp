@@ -40,22 +40,46 @@ class WiiWIBNPrivate final : public RomDataPrivate
 		rp_image *img_banner;
 
 		// Animated icon data.
+		// NOTE: Only created if iconAnimData() is called.
 		IconAnimData *iconAnimData;
 
+		// First icon frame.
+		// Decoded by loadIcon() without decoding the other frames.
+		rp_image *icon_first_frame;
+
+		// Number of icon frames. (-1 if the icon hasn't been loaded)
+		int icon_frame_count;
+
 	public:
 		// File header.
 		Wii_WIBN_Header_t wibnHeader;
 
 		/**
-		 * Load the save file's icons.
+		 * Load the save file's icon frames.
+		 *
+		 * All of the required icon data is read with a single read.
 		 *
-		 * This will load all of the animated icon frames,
-		 * though only the first frame will be returned.
+		 * @param firstFrameOnly If true, only read and decode the first frame.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadIconFrames(bool firstFrameOnly);
+
+		/**
+		 * Load the save file's icon.
+		 *
+		 * Only the first frame is decoded.
+		 * Use loadIconAnimData() to decode the animated icon.
 		 *
 		 * @return Icon, or nullptr on error.
 		 */
 		const rp_image *loadIcon(void);
 
+		/**
+		 * Load the save file's animated icon.
+		 * @return Animated icon data, or nullptr on error.
+		 */
+		const IconAnimData *loadIconAnimData(void);
+
 		/**
 		 * Load the save file's banner.
 		 * @return Banner, or nullptr on error.
@@ -69,6 +93,8 @@ WiiWIBNPrivate::WiiWIBNPrivate(WiiWIBN *q, IRpFile *file)
 	: super(q, file)
 	, img_banner(nullptr)
 	, iconAnimData(nullptr)
+	, icon_first_frame(nullptr)
+	, icon_frame_count(-1)
 {
 	// Clear the WIBN header struct.
 	memset(&wibnHeader, 0, sizeof(wibnHeader));
@@ -78,62 +104,90 @@ WiiWIBNPrivate::~WiiWIBNPrivate()
 {
 	UNREF(img_banner);
 	UNREF(iconAnimData);
+	UNREF(icon_first_frame);
 }
 
 /**
- * Load the save file's icons.
+ * Load the save file's icon frames.
  *
- * This will load all of the animated icon frames,
- * though only the first frame will be returned.
+ * All of the required icon data is read with a single read.
  *
- * @return Icon, or nullptr on error.
+ * @param firstFrameOnly If true, only read and decode the first frame.
+ * @return 0 on success; negative POSIX error code on error.
  */
-const rp_image *WiiWIBNPrivate::loadIcon(void)
+int WiiWIBNPrivate::loadIconFrames(bool firstFrameOnly)
 {
-	if (iconAnimData) {
-		// Icon has already been loaded.
-		return iconAnimData->frames[0];
-	} else if (!this->file || !this->isValid) {
-		// Can't load the icon.
-		return nullptr;
-	}
-
 	// Icon starts after the header and banner.
-	// Read up to 8 icons.
+	// Up to 8 icons may be present. The number of icons is
+	// limited by the file size and the icon speed field.
 	static const unsigned int iconstartaddr = BANNER_WIBN_STRUCT_SIZE;
-	static const unsigned int iconsizetotal = BANNER_WIBN_ICON_SIZE*CARD_MAXICONS;
-	auto icondata = aligned_uptr<uint8_t>(16, iconsizetotal);
-	size_t size = file->seekAndRead(iconstartaddr, icondata.get(), iconsizetotal);
-	if (size < BANNER_WIBN_ICON_SIZE) {
+	const off64_t fileSize = file->size();
+	if (fileSize < static_cast<off64_t>(iconstartaddr + BANNER_WIBN_ICON_SIZE)) {
 		// Unable to read *any* icons.
-		return nullptr;
+		icon_frame_count = 0;
+		return -ENOENT;
+	}
+	unsigned int icons_avail = static_cast<unsigned int>(
+		(fileSize - iconstartaddr) / BANNER_WIBN_ICON_SIZE);
+	if (icons_avail > CARD_MAXICONS) {
+		icons_avail = CARD_MAXICONS;
 	}
 
-	// Number of icons read.
-	const unsigned int icons_read = (unsigned int)(size / BANNER_WIBN_ICON_SIZE);
-
-	this->iconAnimData = new IconAnimData();
-	iconAnimData->count = 0;
-
-	// Process the icons.
+	// Count the icons.
 	// We'll process up to:
-	// - Number of icons read.
+	// - Number of icons in the file.
 	// - Until we hit CARD_SPEED_END.
 	// NOTE: Files with static icons should have a non-zero speed
 	// for the first frame, and 0 for all other frames.
-	uint16_t iconspeed = be16_to_cpu(wibnHeader.iconspeed);
-	unsigned int iconaddr_cur = 0;
-	for (unsigned int i = 0; i < CARD_MAXICONS && i < icons_read; i++, iconspeed >>= 2) {
-		const unsigned int delay = (iconspeed & CARD_SPEED_MASK);
-		if (delay == CARD_SPEED_END) {
+	const uint16_t iconspeed_hdr = be16_to_cpu(wibnHeader.iconspeed);
+	// NOTE: CARD_SPEED_END is ignored for the first icon.
+	unsigned int frame_count = 1;
+	if ((iconspeed_hdr & CARD_SPEED_MASK) == CARD_SPEED_END) {
+		// Static icon.
+		icons_avail = 1;
+	}
+	for (uint16_t iconspeed = (iconspeed_hdr >> 2);
+	     frame_count < icons_avail; frame_count++, iconspeed >>= 2)
+	{
+		if ((iconspeed & CARD_SPEED_MASK) == CARD_SPEED_END) {
 			// End of the icons.
-			// NOTE: Ignore this for the first icon.
-			if (i > 0)
-				break;
-
-			// First icon. Keep going.
-			iconspeed = 0;
+			break;
 		}
+	}
+
+	// Load the icon data.
+	const unsigned int readcount = (firstFrameOnly ? 1 : frame_count);
+	const unsigned int readsize = readcount * BANNER_WIBN_ICON_SIZE;
+	auto icondata = aligned_uptr<uint8_t>(16, readsize);
+	size_t size = file->seekAndRead(iconstartaddr, icondata.get(), readsize);
+	if (size != readsize) {
+		// Seek and/or read error.
+		return -EIO;
+	}
+
+	icon_frame_count = frame_count;
+	if (!icon_first_frame) {
+		// Wii save icons are always RGB5A3.
+		icon_first_frame = ImageDecoder::fromGcn16(ImageDecoder::PXF_RGB5A3,
+			BANNER_WIBN_ICON_W, BANNER_WIBN_ICON_H,
+			reinterpret_cast<const uint16_t*>(icondata.get()),
+			BANNER_WIBN_ICON_SIZE);
+	}
+	if (firstFrameOnly) {
+		// Only the first frame was requested.
+		return 0;
+	}
+
+	this->iconAnimData = new IconAnimData();
+	iconAnimData->count = frame_count;
+
+	// Decode the icon frames.
+	// The first frame was decoded above, or by a previous loadIcon().
+	uint16_t iconspeed = iconspeed_hdr;
+	unsigned int iconaddr_cur = 0;
+	for (unsigned int i = 0; i < frame_count; i++, iconspeed >>= 2) {
+		// NOTE: The first icon may have CARD_SPEED_END.
+		const unsigned int delay = (iconspeed & CARD_SPEED_MASK);
 
 		// Icon delay.
 		// Using 62ms for the fastest speed.
@@ -143,21 +197,18 @@ const rp_image *WiiWIBNPrivate::loadIcon(void)
 		iconAnimData->delays[i].denom = 8;
 		iconAnimData->delays[i].ms = ms_tbl[delay];
 
-		// Wii save icons are always RGB5A3.
-		iconAnimData->frames[i] = ImageDecoder::fromGcn16(ImageDecoder::PXF_RGB5A3,
-			BANNER_WIBN_ICON_W, BANNER_WIBN_ICON_H,
-			reinterpret_cast<const uint16_t*>(icondata.get() + iconaddr_cur),
-			BANNER_WIBN_ICON_SIZE);
+		if (i == 0) {
+			iconAnimData->frames[0] = (icon_first_frame ? icon_first_frame->ref() : nullptr);
+		} else {
+			// Wii save icons are always RGB5A3.
+			iconAnimData->frames[i] = ImageDecoder::fromGcn16(ImageDecoder::PXF_RGB5A3,
+				BANNER_WIBN_ICON_W, BANNER_WIBN_ICON_H,
+				reinterpret_cast<const uint16_t*>(icondata.get() + iconaddr_cur),
+				BANNER_WIBN_ICON_SIZE);
+		}
 		iconaddr_cur += BANNER_WIBN_ICON_SIZE;
-
-		// Next icon.
-		iconAnimData->count++;
 	}
 
-	// NOTE: We're not deleting iconAnimData even if we only have
-	// a single icon because iconAnimData() will call loadIcon()
-	// if iconAnimData is nullptr.
-
 	// Set up the icon animation sequence.
 	int idx = 0;
 	for (int i = 0; i < iconAnimData->count; i++, idx++) {
@@ -173,9 +224,50 @@ const rp_image *WiiWIBNPrivate::loadIcon(void)
 		}
 	}
 	iconAnimData->seq_count = idx;
+	return 0;
+}
 
-	// Return the first frame.
-	return iconAnimData->frames[0];
+/**
+ * Load the save file's icon.
+ *
+ * Only the first frame is decoded.
+ * Use loadIconAnimData() to decode the animated icon.
+ *
+ * @return Icon, or nullptr on error.
+ */
+const rp_image *WiiWIBNPrivate::loadIcon(void)
+{
+	if (icon_frame_count >= 0) {
+		// Icon has already been loaded.
+		return icon_first_frame;
+	} else if (!this->file || !this->isValid) {
+		// Can't load the icon.
+		return nullptr;
+	}
+
+	loadIconFrames(true);
+	return icon_first_frame;
+}
+
+/**
+ * Load the save file's animated icon.
+ * @return Animated icon data, or nullptr on error.
+ */
+const IconAnimData *WiiWIBNPrivate::loadIconAnimData(void)
+{
+	if (iconAnimData) {
+		// Animated icon has already been loaded.
+		return iconAnimData;
+	} else if (icon_frame_count == 0) {
+		// No icons.
+		return nullptr;
+	} else if (!this->file || !this->isValid) {
+		// Can't load the icon.
+		return nullptr;
+	}
+
+	loadIconFrames(false);
+	return iconAnimData;
 }
 
 /**
@@ -432,7 +524,7 @@ uint32_t WiiWIBN::imgpf(ImageType imageType) const
 			// Use nearest-neighbor scaling when resizing.
 			// Also, need to check if this is an animated icon.
 			const_cast<WiiWIBNPrivate*>(d)->loadIcon();
-			if (d->iconAnimData && d->iconAnimData->count > 1) {
+			if (d->icon_frame_count > 1) {
 				// Animated icon.
 				ret = IMGPF_RESCALE_NEAREST | IMGPF_ICON_ANIMATED;
 			} else {
@@ -518,11 +610,11 @@ int WiiWIBN::loadInternalImage(ImageType imageType, const rp_image **pImage)
 	RP_D(WiiWIBN);
 	switch (imageType) {
 		case IMG_INT_ICON:
-			if (d->iconAnimData) {
+			if (d->icon_first_frame) {
 				// Return the first icon frame.
 				// NOTE: Wii save icon animations are always
 				// sequential, so we can use a shortcut here.
-				*pImage = d->iconAnimData->frames[0];
+				*pImage = d->icon_first_frame;
 				return 0;
 			}
 			break;
@@ -578,27 +670,22 @@ int WiiWIBN::loadInternalImage(ImageType imageType, const rp_image **pImage)
 const IconAnimData *WiiWIBN::iconAnimData(void) const
 {
 	RP_D(const WiiWIBN);
-	if (!d->iconAnimData) {
-		// Load the icon.
-		if (!const_cast<WiiWIBNPrivate*>(d)->loadIcon()) {
-			// Error loading the icon.
-			return nullptr;
-		}
-		if (!d->iconAnimData) {
-			// Still no icon...
-			return nullptr;
-		}
+	const IconAnimData *const iconAnimData =
+		const_cast<WiiWIBNPrivate*>(d)->loadIconAnimData();
+	if (!iconAnimData) {
+		// Error loading the icon.
+		return nullptr;
 	}
 
-	if (d->iconAnimData->count <= 1 ||
-	    d->iconAnimData->seq_count <= 1)
+	if (iconAnimData->count <= 1 ||
+	    iconAnimData->seq_count <= 1)
 	{
 		// Not an animated icon.
 		return nullptr;
 	}
 
 	// Return the icon animation data.
-	return d->iconAnimData;
+	return iconAnimData;
 }
 
 /**
@@ -19,8 +19,8 @@
 
 // librpbase, librpfile, librptexture
 #include "librpbase/img/RpPng.hpp"
-#include "librpbase/disc/DiscReader.hpp"
 #include "librpbase/disc/PartitionFile.hpp"
+#include "disc/StfsReader.hpp"
 #include "librpfile/RpMemFile.hpp"
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
@@ -29,6 +29,8 @@ using namespace LibRpTexture;
 
 // C++ STL classes.
 using std::string;
+using std::unique_ptr;
+using std::unordered_map;
 using std::vector;
 
 namespace LibRomData {
@@ -104,7 +106,7 @@ class Xbox360_STFS_Private final : public RomDataPrivate
 
 	public:
 		// XEX executable.
-		DiscReader *xexReader;
+		StfsReader *xexReader;
 		Xbox360_XEX *xex;
 
 		// File table.
@@ -128,6 +130,13 @@ class Xbox360_STFS_Private final : public RomDataPrivate
 			return ret;
 		}
 
+		/**
+		 * Get the hash table block shift.
+		 * If 1, each hash table has two copies.
+		 * @return Hash table block shift.
+		 */
+		int hashTableShift(void) const;
+
 		/**
 		 * Convert a data block number to a physical block number.
 		 * Data block numbers don't include hash blocks.
@@ -136,6 +145,44 @@ class Xbox360_STFS_Private final : public RomDataPrivate
 		 */
 		int32_t dataBlockNumberToPhys(int dataBlockNumber);
 
+		// Hash table cache.
+		// Key is the physical block number.
+		unordered_map<int32_t, unique_ptr<STFS_Hash_Table> > hashTables;
+
+		/**
+		 * Get a hash table for the specified data block.
+		 * Hash tables are cached after they're loaded.
+		 * @param level Hash table level. (0-2)
+		 * @param dataBlockNumber Data block number.
+		 * @return Hash table, or nullptr on error.
+		 */
+		const STFS_Hash_Table *getHashTable(int level, int32_t dataBlockNumber);
+
+		/**
+		 * Get the list of physical block runs for a file.
+		 *
+		 * If the file's blocks are consecutive, the physical
+		 * block numbers are calculated directly. Otherwise,
+		 * the block chain is read from the level-0 hash tables.
+		 *
+		 * @param blockNumber	[in] First data block number.
+		 * @param blockCount	[in] Number of blocks.
+		 * @param consecutive	[in] If true, the blocks are consecutive.
+		 * @param runs		[out] Block runs.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int getBlockRuns(int32_t blockNumber, uint32_t blockCount, bool consecutive,
+			vector<StfsReader::BlockRun> &runs);
+
+		/**
+		 * Open a file in the STFS package.
+		 * @param blockNumber	[in] First data block number.
+		 * @param filesize	[in] File size, in bytes.
+		 * @param consecutive	[in] If true, the blocks are consecutive.
+		 * @return StfsReader on success; nullptr on error.
+		 */
+		StfsReader *openFile(int32_t blockNumber, uint32_t filesize, bool consecutive);
+
 		/**
 		 * Load the file table.
 		 * @return 0 on success; negative POSIX error code on error.
@@ -328,9 +375,15 @@ int Xbox360_STFS_Private::loadHeader(unsigned int header)
  * @param dataBlockNumber Data block number.
  * @return physBlockNumber Physical block number.
  */
-int32_t Xbox360_STFS_Private::dataBlockNumberToPhys(int dataBlockNumber)
+int Xbox360_STFS_Private::hashTableShift(void) const
 {
 	// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
+	// FIXME: Originally compared magic to blockShift,
+	// which doesn't make sense...
+	if (stfsType != StfsType::CON) {
+		return 0;
+	}
+
 	int blockShift;
 	if (((be32_to_cpu(stfsMetadata.header_size) + 0xFFF) & 0xF000) == 0xB000) {
 		blockShift = 1;
@@ -341,34 +394,232 @@ int32_t Xbox360_STFS_Private::dataBlockNumberToPhys(int dataBlockNumber)
 			blockShift = 1;
 		}
 	}
+	return blockShift;
+}
 
-	int32_t base = ((dataBlockNumber + 0xAA) / 0xAA);
-	if (stfsType == StfsType::CON) {
-		base <<= blockShift;
+/**
+ * Convert a data block number to a physical block number.
+ * Data block numbers don't include hash blocks.
+ * @param dataBlockNumber Data block number.
+ * @return physBlockNumber Physical block number.
+ */
+int32_t Xbox360_STFS_Private::dataBlockNumberToPhys(int dataBlockNumber)
+{
+	// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
+	const int blockShift = hashTableShift();
+
+	int32_t ret = (((dataBlockNumber + 0xAA) / 0xAA) << blockShift) + dataBlockNumber;
+	if (dataBlockNumber >= 0xAA) {
+		// Level 1 hash tables.
+		// NOTE: The first level 1 hash table is located
+		// after the first 0xAA data blocks.
+		ret += ((dataBlockNumber + 0x70E4) / 0x70E4) << blockShift;
+
+		if (dataBlockNumber >= 0x70E4) {
+			// Level 2 hash table.
+			ret += (1 << blockShift);
+		}
 	}
 
-	int32_t ret = (base + dataBlockNumber);
-	if (dataBlockNumber > 0xAA) {
-		base = ((dataBlockNumber + 0x70E4) / 0x70E4);
-		if (stfsType == StfsType::CON) {
-			base <<= blockShift;
-		}
-		ret += base;
-
-		if (dataBlockNumber > 0x70E4) {
-			base = ((dataBlockNumber + 0x4AF768) / 0x4AF768);
-			// FIXME: Originally compared magic to blockShift,
-			// which doesn't make sense...
-			if (stfsType == StfsType::CON) {
-				base <<= blockShift;
+	return ret;
+}
+
+/**
+ * Get a hash table for the specified data block.
+ * Hash tables are cached after they're loaded.
+ * @param level Hash table level. (0-2)
+ * @param dataBlockNumber Data block number.
+ * @return Hash table, or nullptr on error.
+ */
+const STFS_Hash_Table *Xbox360_STFS_Private::getHashTable(int level, int32_t dataBlockNumber)
+{
+	// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
+	assert(level >= 0 && level <= 2);
+	assert(dataBlockNumber >= 0);
+
+	// Determine the top hash table level.
+	const uint32_t allocBlockCount = be32_to_cpu(stfsMetadata.stfs_desc.total_alloc_block_count);
+	int topLevel;
+	if (allocBlockCount <= 0xAA) {
+		topLevel = 0;
+	} else if (allocBlockCount <= 0x70E4) {
+		topLevel = 1;
+	} else {
+		topLevel = 2;
+	}
+	if (level > topLevel || dataBlockNumber < 0 ||
+	    static_cast<uint32_t>(dataBlockNumber) >= allocBlockCount)
+	{
+		// Invalid level and/or block number.
+		return nullptr;
+	}
+
+	// Physical block number of the hash table.
+	// Each hash table occupies (1 << blockShift) blocks.
+	const int blockShift = hashTableShift();
+	const int32_t step0 = 0xAA + (1 << blockShift);
+	const int32_t step1 = 0x70E4 + ((0xAA + 1) << blockShift);
+	int32_t physBlockNumber;
+	switch (level) {
+		default:
+		case 0:
+			if (dataBlockNumber < 0xAA) {
+				physBlockNumber = 0;
+				break;
 			}
-			ret += base;
+			physBlockNumber = ((dataBlockNumber / 0xAA) * step0) +
+				(((dataBlockNumber / 0x70E4) + 1) << blockShift);
+			if (dataBlockNumber >= 0x70E4) {
+				physBlockNumber += (1 << blockShift);
+			}
+			break;
+		case 1:
+			if (dataBlockNumber < 0x70E4) {
+				physBlockNumber = step0;
+				break;
+			}
+			physBlockNumber = (1 << blockShift) + ((dataBlockNumber / 0x70E4) * step1);
+			break;
+		case 2:
+			physBlockNumber = step1;
+			break;
+	}
+
+	if (blockShift != 0) {
+		// Two copies of each hash table.
+		// The active copy is indicated by the parent hash table.
+		int copy;
+		if (level == topLevel) {
+			copy = (stfsMetadata.stfs_desc.block_separation >> 1) & 1;
+		} else {
+			const STFS_Hash_Table *const parent = getHashTable(level + 1, dataBlockNumber);
+			if (!parent) {
+				// Unable to load the parent hash table.
+				return nullptr;
+			}
+			const int idx = (level == 0)
+				? ((dataBlockNumber / 0xAA) % STFS_HASH_ENTRIES_PER_TABLE)
+				: ((dataBlockNumber / 0x70E4) % STFS_HASH_ENTRIES_PER_TABLE);
+			copy = !!(parent->entries[idx].status & STFS_HASH_STATUS_ACTIVE_COPY);
 		}
+		physBlockNumber += copy;
+	}
+
+	// Check if this hash table is already cached.
+	auto iter = hashTables.find(physBlockNumber);
+	if (iter != hashTables.end()) {
+		return iter->second.get();
+	}
+
+	// Load the hash table.
+	const int32_t offset = blockNumberToOffset(physBlockNumber);
+	if (offset < 0) {
+		// Invalid block number.
+		return nullptr;
+	}
+	unique_ptr<STFS_Hash_Table> hashTable(new STFS_Hash_Table);
+	size_t size = file->seekAndRead(offset, hashTable.get(), sizeof(*hashTable));
+	if (size != sizeof(*hashTable)) {
+		// Seek and/or read error.
+		return nullptr;
 	}
 
+	const STFS_Hash_Table *const ret = hashTable.get();
+	hashTables.emplace(physBlockNumber, std::move(hashTable));
 	return ret;
 }
 
+/**
+ * Get the list of physical block runs for a file.
+ *
+ * If the file's blocks are consecutive, the physical
+ * block numbers are calculated directly. Otherwise,
+ * the block chain is read from the level-0 hash tables.
+ *
+ * @param blockNumber	[in] First data block number.
+ * @param blockCount	[in] Number of blocks.
+ * @param consecutive	[in] If true, the blocks are consecutive.
+ * @param runs		[out] Block runs.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int Xbox360_STFS_Private::getBlockRuns(int32_t blockNumber, uint32_t blockCount, bool consecutive,
+	vector<StfsReader::BlockRun> &runs)
+{
+	runs.clear();
+	int32_t lastPhysBlock = -2;
+	for (; blockCount > 0; blockCount--) {
+		if (blockNumber < 0 || blockNumber > 0xFFFFFF) {
+			// Invalid block number.
+			runs.clear();
+			return -EIO;
+		}
+
+		// Extend the current run if this block is physically contiguous.
+		const int32_t physBlock = dataBlockNumberToPhys(blockNumber);
+		if (physBlock == lastPhysBlock + 1) {
+			runs.back().blockCount++;
+		} else {
+			const int32_t offset = blockNumberToOffset(physBlock);
+			if (offset < 0) {
+				// Invalid block number.
+				runs.clear();
+				return -EIO;
+			}
+			runs.push_back({offset, 1});
+		}
+		lastPhysBlock = physBlock;
+
+		if (blockCount == 1) {
+			// Last block.
+			break;
+		}
+
+		// Get the next block.
+		if (consecutive) {
+			blockNumber++;
+		} else {
+			const STFS_Hash_Table *const hashTable = getHashTable(0, blockNumber);
+			if (!hashTable) {
+				// Unable to load the hash table.
+				runs.clear();
+				return -EIO;
+			}
+			const STFS_Hash_Entry *const hashEntry =
+				&hashTable->entries[blockNumber % STFS_HASH_ENTRIES_PER_TABLE];
+			blockNumber = (hashEntry->next_block[0] << 16) |
+				      (hashEntry->next_block[1] <<  8) |
+				       hashEntry->next_block[2];
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Open a file in the STFS package.
+ * @param blockNumber	[in] First data block number.
+ * @param filesize	[in] File size, in bytes.
+ * @param consecutive	[in] If true, the blocks are consecutive.
+ * @return StfsReader on success; nullptr on error.
+ */
+StfsReader *Xbox360_STFS_Private::openFile(int32_t blockNumber, uint32_t filesize, bool consecutive)
+{
+	const uint32_t blockCount = (filesize + STFS_BLOCK_SIZE - 1) / STFS_BLOCK_SIZE;
+	vector<StfsReader::BlockRun> runs;
+	int ret = getBlockRuns(blockNumber, blockCount, consecutive, runs);
+	if (ret != 0) {
+		// Unable to get the block runs.
+		return nullptr;
+	}
+
+	StfsReader *const reader = new StfsReader(this->file, runs, filesize);
+	if (!reader->isOpen()) {
+		reader->unref();
+		return nullptr;
+	}
+	return reader;
+}
+
 /**
  * Load the file table.
  * @return 0 on success; negative POSIX error code on error.
@@ -406,20 +657,21 @@ int Xbox360_STFS_Private::loadFileTable(void)
 		(stfsMetadata.stfs_desc.file_table_block_number[0] << 16) |
 		(stfsMetadata.stfs_desc.file_table_block_number[1] <<  8) |
 		 stfsMetadata.stfs_desc.file_table_block_number[2];
-	const int32_t offset = blockNumberToOffset(dataBlockNumberToPhys(blockNumber));
-	if (offset < 0) {
-		// Invalid block number.
-		return -EIO;
-	}
 
 	// Load the file table.
-	size_t fileTableSize = ((uint32_t)blockCount * STFS_BLOCK_SIZE);
-	assert(fileTableSize % sizeof(STFS_DirEntry_t) == 0);
-	if (fileTableSize % sizeof(STFS_DirEntry_t) != 0) {
-		fileTableSize += sizeof(STFS_DirEntry_t);
+	// NOTE: The file table's blocks aren't necessarily consecutive,
+	// so the block chain has to be read from the hash tables.
+	const size_t fileTableSize = ((uint32_t)blockCount * STFS_BLOCK_SIZE);
+	static_assert(STFS_BLOCK_SIZE % sizeof(STFS_DirEntry_t) == 0,
+		"STFS_BLOCK_SIZE is not a multiple of sizeof(STFS_DirEntry_t).");
+	StfsReader *const fileTableReader = openFile(blockNumber, static_cast<uint32_t>(fileTableSize), false);
+	if (!fileTableReader) {
+		// Unable to open the file table.
+		return -EIO;
 	}
 	fileTable.resize(fileTableSize / sizeof(STFS_DirEntry_t));
-	size_t size = file->seekAndRead(offset, fileTable.data(), fileTableSize);
+	size_t size = fileTableReader->read(fileTable.data(), fileTableSize);
+	fileTableReader->unref();
 	if (size != fileTableSize) {
 		// Seek and/or read error.
 		fileTable.clear();
@@ -497,21 +749,19 @@ Xbox360_XEX *Xbox360_STFS_Private::openDefaultXex(void)
 		return nullptr;
 	}
 
-	// Offset and filesize.
+	// Block number and filesize.
 	// NOTE: Block number is **little-endian** here.
 	const int32_t blockNumber =
 		(dirEntry->block_number[2] << 16) |
 		(dirEntry->block_number[1] <<  8) |
 		 dirEntry->block_number[0];
-	const int32_t offset = blockNumberToOffset(dataBlockNumberToPhys(blockNumber));
 	const uint32_t filesize = be32_to_cpu(dirEntry->filesize);
+	const bool consecutive = !!(dirEntry->flags_len & STFS_DIRENT_FLAG_CONSECUTIVE);
 
 	// Load default.xexp.
-	// FIXME: Maybe add a reader class to handle the hashes,
-	// though we only need the XEX header right now.
-	DiscReader *discReader = new DiscReader(this->file);
-	if (discReader->isOpen()) {
-		PartitionFile *const xexFile_tmp = new PartitionFile(discReader, offset, filesize);
+	StfsReader *discReader = openFile(blockNumber, filesize, consecutive);
+	if (discReader) {
+		PartitionFile *const xexFile_tmp = new PartitionFile(discReader, 0, filesize);
 		if (xexFile_tmp->isOpen()) {
 			Xbox360_XEX *const xex_tmp = new Xbox360_XEX(xexFile_tmp);
 			if (xex_tmp->isOpen()) {
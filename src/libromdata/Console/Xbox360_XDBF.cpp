@@ -22,6 +22,7 @@ using LibRpTexture::rp_image;
 
 // C++ STL classes.
 using std::array;
+using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
 using std::unordered_map;
@@ -143,6 +144,15 @@ class Xbox360_XDBF_Private final : public RomDataPrivate
 		 */
 		const rp_image *loadIcon(void);
 
+		/**
+		 * Create a list icons vector that loads the images lazily.
+		 * If the file doesn't support positional reads from other
+		 * threads, the images are loaded immediately instead.
+		 * @param image_ids Image IDs, one per row.
+		 * @return ListDataIcons_t
+		 */
+		RomFields::ListDataIcons_t *createLazyIcons(const vector<uint32_t> &image_ids);
+
 	public:
 		/**
 		 * Get the title type as a string.
@@ -515,6 +525,42 @@ inline uint32_t Xbox360_XDBF_Private::getDefaultLC(void) const
 	return lc;
 }
 
+/**
+ * Read and decode a PNG image.
+ * NOTE: This uses pread(), so the file position is undefined afterwards.
+ * @param file File.
+ * @param addr Image address.
+ * @param length Image length.
+ * @return Decoded image, or nullptr on error.
+ */
+static rp_image *loadPngImage(IRpFile *file, uint32_t addr, uint32_t length)
+{
+	// Sanity check:
+	// - Size must be at least 16 bytes. [TODO: Smallest PNG?]
+	// - Size must be a maximum of 1 MB.
+	assert(length >= 16);
+	assert(length <= 1024*1024);
+	if (length < 16 || length > 1024*1024) {
+		// Size is out of range.
+		return nullptr;
+	}
+
+	unique_ptr<uint8_t[]> png_buf(new uint8_t[length]);
+	size_t size = file->pread(addr, png_buf.get(), length);
+	if (size != length) {
+		// Read error.
+		return nullptr;
+	}
+
+	// Create an RpMemFile and decode the image.
+	// The RpMemFile takes ownership of the PNG buffer.
+	// TODO: For rpcli, shortcut to extract the PNG directly.
+	RpMemFile *const f_mem = new RpMemFile(std::move(png_buf), length);
+	rp_image *img = RpPng::load(f_mem);
+	f_mem->unref();
+	return img;
+}
+
 /**
  * Load an image resource.
  * @param image_id Image ID.
@@ -550,31 +596,9 @@ rp_image *Xbox360_XDBF_Private::loadImage(uint64_t image_id)
 	}
 
 	// Load the image.
-	const uint32_t addr = be32_to_cpu(entry->offset) + this->data_offset;
-	const uint32_t length = be32_to_cpu(entry->length);
-	// Sanity check:
-	// - Size must be at least 16 bytes. [TODO: Smallest PNG?]
-	// - Size must be a maximum of 1 MB.
-	assert(length >= 16);
-	assert(length <= 1024*1024);
-	if (length < 16 || length > 1024*1024) {
-		// Size is out of range.
-		return nullptr;
-	}
-
-	unique_ptr<uint8_t[]> png_buf(new uint8_t[length]);
-	size_t size = file->seekAndRead(addr, png_buf.get(), length);
-	if (size != length) {
-		// Seek and/or read error.
-		return nullptr;
-	}
-
-	// Create an RpMemFile and decode the image.
-	// TODO: For rpcli, shortcut to extract the PNG directly.
-	RpMemFile *const f_mem = new RpMemFile(png_buf.get(), length);
-	rp_image *img = RpPng::load(f_mem);
-	f_mem->unref();
-
+	rp_image *const img = loadPngImage(file,
+		be32_to_cpu(entry->offset) + this->data_offset,
+		be32_to_cpu(entry->length));
 	if (img) {
 		// Save the image for later use.
 		map_images.insert(std::make_pair(image_id, img));
@@ -608,6 +632,68 @@ const rp_image *Xbox360_XDBF_Private::loadIcon(void)
 	return img_icon;
 }
 
+/**
+ * Create a list icons vector that loads the images lazily.
+ * If the file doesn't support positional reads from other
+ * threads, the images are loaded immediately instead.
+ * @param image_ids Image IDs, one per row.
+ * @return ListDataIcons_t
+ */
+RomFields::ListDataIcons_t *Xbox360_XDBF_Private::createLazyIcons(const vector<uint32_t> &image_ids)
+{
+	// The icons may be loaded after this object is deleted
+	// if the fields are shared, so the loader needs its own
+	// reference to the file and its own image locations.
+	struct IconSource {
+		explicit IconSource(IRpFile *file)
+			: file(file->ref()) { }
+		~IconSource() { file->unref(); }
+		RP_DISABLE_COPY(IconSource)
+
+		IRpFile *const file;
+		// Image locations: addr, length
+		// If length is 0, the row doesn't have an icon.
+		vector<std::pair<uint32_t, uint32_t> > locs;
+	};
+
+	if (!file || !isValid || entryTable.empty()) {
+		// Can't load any images.
+		return new RomFields::ListDataIcons_t(image_ids.size());
+	}
+
+	// The loader runs on the UI thread without holding loadMutex,
+	// so it can only use pread() if that doesn't use the shared
+	// file position. (Same check as RomDataPrivate::readAt().)
+	if (file->nativeFd() < 0 || file->isWritable()) {
+		// Load the images now. loadMutex is held by loadFieldData().
+		// NOTE: The images are owned by map_images.
+		RomFields::ListDataIcons_t *const icons = new RomFields::ListDataIcons_t(image_ids.size());
+		for (size_t i = 0; i < image_ids.size(); i++) {
+			(*icons)[i] = loadImage(image_ids[i]);
+		}
+		return icons;
+	}
+
+	shared_ptr<IconSource> src = std::make_shared<IconSource>(file);
+	src->locs.resize(image_ids.size());
+	for (size_t i = 0; i < image_ids.size(); i++) {
+		const XDBF_Entry *const entry = findResource(XDBF_SPA_NAMESPACE_IMAGE, image_ids[i]);
+		if (entry) {
+			src->locs[i] = std::make_pair(
+				be32_to_cpu(entry->offset) + this->data_offset,
+				be32_to_cpu(entry->length));
+		}
+	}
+
+	return new RomFields::ListDataIcons_t(image_ids.size(),
+		[src](size_t idx) -> rp_image* {
+			const auto &loc = src->locs[idx];
+			if (loc.second == 0)
+				return nullptr;
+			return loadPngImage(src->file, loc.first, loc.second);
+		});
+}
+
 /**
  * Get the title type as a string.
  * @return Title type, or nullptr if not found.
@@ -821,13 +907,13 @@ int Xbox360_XDBF_Private::addFields_achievements(void)
 			? new RomFields::ListData_t(xach_count)
 			: nullptr;
 	}
-	auto vv_icons = new RomFields::ListDataIcons_t(xach_count);
-	auto icon_iter = vv_icons->begin();
-	for (unsigned int i = 0; p < p_end && i < xach_count; p++, i++, ++icon_iter) {
+	// Icons are loaded when the rows are displayed.
+	vector<uint32_t> v_image_ids(xach_count);
+	for (unsigned int i = 0; p < p_end && i < xach_count; p++, i++) {
 		// NOTE: Not deduplicating strings here.
 
 		// Icon
-		*icon_iter = loadImage(be32_to_cpu(p->image_id));
+		v_image_ids[i] = be32_to_cpu(p->image_id);
 
 		// Achievement IDs.
 		const uint16_t name_id = be16_to_cpu(p->name_id);
@@ -922,7 +1008,7 @@ int Xbox360_XDBF_Private::addFields_achievements(void)
 	// TODO: Header alignment?
 	params.alignment.headers = 0;
 	params.alignment.data = AFLD_ALIGN3(TXA_L, TXA_L, TXA_C);
-	params.mxd.icons = vv_icons;
+	params.mxd.icons = createLazyIcons(v_image_ids);
 	fields->addField_listData(C_("Xbox360_XDBF", "Achievements"), &params);
 	return 0;
 }
@@ -1029,13 +1115,13 @@ int Xbox360_XDBF_Private::addFields_avatarAwards(void)
 			? new RomFields::ListData_t(xgaa_count)
 			: nullptr;
 	}
-	auto vv_icons = new RomFields::ListDataIcons_t(xgaa_count);
-	auto icon_iter = vv_icons->begin();
-	for (unsigned int i = 0; p < p_end && i < xgaa_count; p++, i++, ++icon_iter) {
+	// Icons are loaded when the rows are displayed.
+	vector<uint32_t> v_image_ids(xgaa_count);
+	for (unsigned int i = 0; p < p_end && i < xgaa_count; p++, i++) {
 		// NOTE: Not deduplicating strings here.
 
 		// Icon
-		*icon_iter = loadImage(be32_to_cpu(p->image_id));
+		v_image_ids[i] = be32_to_cpu(p->image_id);
 
 		// Avatar award IDs.
 		const uint16_t name_id = be16_to_cpu(p->name_id);
@@ -1124,7 +1210,7 @@ int Xbox360_XDBF_Private::addFields_avatarAwards(void)
 				      RomFields::RFT_LISTDATA_MULTI, 2);
 	params.headers = v_xgaa_col_names;
 	params.data.multi = mvv_xgaa;
-	params.mxd.icons = vv_icons;
+	params.mxd.icons = createLazyIcons(v_image_ids);
 	fields->addField_listData(C_("Xbox360_XDBF", "Avatar Awards"), &params);
 	return 0;
 }
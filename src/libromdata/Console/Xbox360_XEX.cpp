@@ -16,12 +16,14 @@
 #include "xbox360_xex_structs.h"
 #include "data/XboxPublishers.hpp"
 
-// librpbase, librpfile, librptexture
+// librpbase, librpfile, librpthreads, librptexture
 #include "librpbase/disc/CBCReader.hpp"
 #include "librpfile/RpMemFile.hpp"
+#include "librpthreads/CancelToken.hpp"
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
 using LibRpFile::RpMemFile;
+using LibRpThreads::CancelToken;
 using LibRpTexture::rp_image;
 
 #ifdef ENABLE_DECRYPTION
@@ -85,6 +87,12 @@ class Xbox360_XEX_Private final : public RomDataPrivate
 		// NOTE: This array of structs **IS NOT** byteswapped!
 		ao::uvector<XEX2_Optional_Header_Tbl> optHdrTbl;
 
+		// XEX headers. (everything before the PE executable)
+		// Loaded on demand by getHeaderData().
+		// Optional header data is usually located here.
+		ao::uvector<uint8_t> headerData;
+		bool isHeaderDataLoaded;
+
 		// Execution ID. (XEX2_OPTHDR_EXECUTION_ID)
 		// Initialized by getXdbfResInfo().
 		// NOTE: This struct **IS** byteswapped,
@@ -126,9 +134,53 @@ class Xbox360_XEX_Private final : public RomDataPrivate
 
 #ifdef ENABLE_LIBMSPACK
 		// Decompressed EXE header.
-		ao::uvector<uint8_t> lzx_peHeader;
+		// The RpMemFile owns the decompressed data.
+		RpMemFile *lzx_peHeader;
 		// Decompressed XDBF section.
-		ao::uvector<uint8_t> lzx_xdbfSection;
+		// The RpMemFile owns the decompressed data.
+		RpMemFile *lzx_xdbfSection;
+
+		/**
+		 * LZX block chain reader.
+		 * De-blocks the compressed data on demand, so only the
+		 * blocks needed for the requested range are read.
+		 * Used as the input callback for lzx_stream.
+		 */
+		class LzxDeblocker {
+			public:
+				LzxDeblocker(CBCReader *reader, uint32_t first_block_size);
+
+			private:
+				RP_DISABLE_COPY(LzxDeblocker)
+
+			public:
+				/**
+				 * lzx_stream input callback.
+				 * @param userdata LzxDeblocker
+				 * @param buf Buffer.
+				 * @param bytes Maximum number of bytes to read.
+				 * @return Number of bytes read; 0 on EOF; negative on error.
+				 */
+				static int read_cb(void *userdata, void *buf, int bytes);
+
+			private:
+				/**
+				 * Advance to the next chunk.
+				 * @return True on success; false on EOF or error.
+				 */
+				bool nextChunk(void);
+
+			public:
+				bool error;			// An error has occurred.
+
+			private:
+				CBCReader *reader;
+				uint32_t cur_block_size;	// Current block size. (0 == end of data)
+				uint32_t next_block_size;	// Next block size, from the current block header.
+				uint32_t block_remaining;	// Bytes remaining in the current block.
+				uint32_t chunk_remaining;	// Bytes remaining in the current chunk.
+				bool in_block;			// Has the current block header been read?
+		};
 #endif /* ENABLE_LIBMSPACK */
 
 		/**
@@ -138,6 +190,25 @@ class Xbox360_XEX_Private final : public RomDataPrivate
 		 */
 		const XEX2_Optional_Header_Tbl *getOptHdrTblEntry(uint32_t header_id) const;
 
+		/**
+		 * Get a pointer to data within the XEX headers.
+		 * The XEX headers are loaded on first use.
+		 * @param offset	[in] Starting offset.
+		 * @param size		[in] Data size.
+		 * @return Pointer to the data, or nullptr if it isn't entirely within the XEX headers.
+		 */
+		const uint8_t *getHeaderData(uint32_t offset, size_t size);
+
+		/**
+		 * Read data from the XEX file.
+		 * The XEX headers are used if possible.
+		 * @param offset	[in] Starting offset.
+		 * @param buf		[out] Output buffer.
+		 * @param size		[in] Data size.
+		 * @return Number of bytes read.
+		 */
+		size_t readHeaderData(uint32_t offset, void *buf, size_t size);
+
 		/**
 		 * Get data from an optional header.
 		 *
@@ -263,8 +334,13 @@ const uint8_t Xbox360_XEXPrivate::EncryptionKeyVerifyData[Xbox360_XEX::Key_Max][
 Xbox360_XEX_Private::Xbox360_XEX_Private(Xbox360_XEX *q, IRpFile *file)
 	: super(q, file)
 	, xexType(XexType::Unknown)
+	, isHeaderDataLoaded(false)
 	, isExecutionIDLoaded(false)
 	, keyInUse(-1)
+#ifdef ENABLE_LIBMSPACK
+	, lzx_peHeader(nullptr)
+	, lzx_xdbfSection(nullptr)
+#endif /* ENABLE_LIBMSPACK */
 	, peReader(nullptr)
 	, pe_exe(nullptr)
 	, pe_xdbf(nullptr)
@@ -281,6 +357,10 @@ Xbox360_XEX_Private::~Xbox360_XEX_Private()
 	UNREF(pe_xdbf);
 	UNREF(pe_exe);
 	UNREF(peReader);
+#ifdef ENABLE_LIBMSPACK
+	UNREF(lzx_peHeader);
+	UNREF(lzx_xdbfSection);
+#endif /* ENABLE_LIBMSPACK */
 }
 
 /**
@@ -313,6 +393,62 @@ const XEX2_Optional_Header_Tbl *Xbox360_XEX_Private::getOptHdrTblEntry(uint32_t
 	return (iter != optHdrTbl.cend() ? &(*iter) : nullptr);
 }
 
+/**
+ * Get a pointer to data within the XEX headers.
+ * The XEX headers are loaded on first use.
+ * @param offset	[in] Starting offset.
+ * @param size		[in] Data size.
+ * @return Pointer to the data, or nullptr if it isn't entirely within the XEX headers.
+ */
+const uint8_t *Xbox360_XEX_Private::getHeaderData(uint32_t offset, size_t size)
+{
+	if (!isHeaderDataLoaded) {
+		// Load the XEX headers.
+		// NOTE: Limited to 256 KB in case the PE offset is invalid.
+		static const uint32_t XEX_HEADER_SIZE_MAX = 256*1024;
+		isHeaderDataLoaded = true;
+		if (!file || !file->isOpen()) {
+			// File isn't open.
+			return nullptr;
+		}
+
+		const uint32_t header_size = std::min(xex2Header.pe_offset, XEX_HEADER_SIZE_MAX);
+		headerData.resize(header_size);
+		size_t sz_read = file->seekAndRead(0, headerData.data(), header_size);
+		headerData.resize(sz_read);
+	}
+
+	if (offset >= headerData.size() || size > headerData.size() - offset) {
+		// Not within the XEX headers.
+		return nullptr;
+	}
+	return &headerData[offset];
+}
+
+/**
+ * Read data from the XEX file.
+ * The XEX headers are used if possible.
+ * @param offset	[in] Starting offset.
+ * @param buf		[out] Output buffer.
+ * @param size		[in] Data size.
+ * @return Number of bytes read.
+ */
+size_t Xbox360_XEX_Private::readHeaderData(uint32_t offset, void *buf, size_t size)
+{
+	const uint8_t *const pData = getHeaderData(offset, size);
+	if (pData) {
+		// Data is within the XEX headers.
+		memcpy(buf, pData, size);
+		return size;
+	}
+
+	if (!file || !file->isOpen()) {
+		// File isn't open.
+		return 0;
+	}
+	return file->seekAndRead(offset, buf, size);
+}
+
 /**
  * Get data from an optional header.
  *
@@ -353,7 +489,7 @@ size_t Xbox360_XEX_Private::getOptHdrData(uint32_t header_id, uint32_t *pOut32)
 
 	// Read the DWORD from the file.
 	uint32_t dwData;
-	size_t size = file->seekAndRead(be32_to_cpu(entry->offset), &dwData, sizeof(dwData));
+	size_t size = readHeaderData(be32_to_cpu(entry->offset), &dwData, sizeof(dwData));
 	if (size != sizeof(dwData)) {
 		// Seek and/or read error.
 		return 0;
@@ -402,7 +538,7 @@ size_t Xbox360_XEX_Private::getOptHdrData(uint32_t header_id, ao::uvector<uint8_
 	} else {
 		// Size is the first DWORD of the data.
 		uint32_t dwSize = 0;
-		size_t sz_read = file->seekAndRead(offset, &dwSize, sizeof(dwSize));
+		size_t sz_read = readHeaderData(offset, &dwSize, sizeof(dwSize));
 		if (sz_read != sizeof(dwSize)) {
 			// Seek and/or read error.
 			return 0;
@@ -413,7 +549,7 @@ size_t Xbox360_XEX_Private::getOptHdrData(uint32_t header_id, ao::uvector<uint8_
 	// Read the data.
 	// NOTE: This includes the size value for 0xFF structs.
 	pVec.resize(size);
-	size_t sz_read = file->seekAndRead(offset, pVec.data(), size);
+	size_t sz_read = readHeaderData(offset, pVec.data(), size);
 	if (sz_read != size) {
 		// Seek and/or read error.
 		return 0;
@@ -521,6 +657,140 @@ const XEX2_Resource_Info *Xbox360_XEX_Private::getXdbfResInfo(const char *resour
 	return &(ins_iter.first->second);
 }
 
+#ifdef ENABLE_LIBMSPACK
+Xbox360_XEX_Private::LzxDeblocker::LzxDeblocker(CBCReader *reader, uint32_t first_block_size)
+	: error(false)
+	, reader(reader)
+	, cur_block_size(first_block_size)
+	, next_block_size(0)
+	, block_remaining(0)
+	, chunk_remaining(0)
+	, in_block(false)
+{
+	// Start at the beginning.
+	reader->rewind();
+}
+
+/**
+ * lzx_stream input callback.
+ * @param userdata LzxDeblocker
+ * @param buf Buffer.
+ * @param bytes Maximum number of bytes to read.
+ * @return Number of bytes read; 0 on EOF; negative on error.
+ */
+int Xbox360_XEX_Private::LzxDeblocker::read_cb(void *userdata, void *buf, int bytes)
+{
+	LzxDeblocker *const d = static_cast<LzxDeblocker*>(userdata);
+	uint8_t *p = static_cast<uint8_t*>(buf);
+	int total = 0;
+
+	if (CancelToken::isCurrentCancelled()) {
+		// Operation was cancelled.
+		// The decompressor will stop with an input error.
+		d->error = true;
+		return -1;
+	}
+
+	while (bytes > 0 && !d->error) {
+		if (d->chunk_remaining == 0) {
+			if (!d->nextChunk()) {
+				// End of data, or error.
+				break;
+			}
+		}
+
+		const uint32_t to_read = std::min(static_cast<uint32_t>(bytes), d->chunk_remaining);
+		const size_t size = d->reader->read(p, to_read);
+		if (size != to_read) {
+			// Seek and/or read error.
+			d->error = true;
+			break;
+		}
+
+		p += to_read;
+		total += static_cast<int>(to_read);
+		bytes -= static_cast<int>(to_read);
+		d->chunk_remaining -= to_read;
+	}
+
+	return (d->error ? -1 : total);
+}
+
+/**
+ * Advance to the next chunk.
+ * @return True on success; false on EOF or error.
+ */
+bool Xbox360_XEX_Private::LzxDeblocker::nextChunk(void)
+{
+	// Based on: https://github.com/xenia-project/xenia/blob/5f764fc752c82674981a9f402f1bbd96b399112a/src/xenia/cpu/xex_module.cc
+	for (;;) {
+		if (!in_block) {
+			if (cur_block_size == 0) {
+				// End of data.
+				return false;
+			}
+
+			// Read the next block header.
+			XEX2_Compression_Normal_Info next_block;
+			size_t size = reader->read(&next_block, sizeof(next_block));
+			if (size != sizeof(next_block)) {
+				// Seek and/or read error.
+				error = true;
+				return false;
+			}
+
+			// Does the block size make sense?
+			// NOTE: If it doesn't, the wrong key is probably in use.
+			next_block_size = be32_to_cpu(next_block.block_size);
+			if (next_block_size > 65536) {
+				// Block size is invalid.
+				error = true;
+				return false;
+			}
+
+			assert(cur_block_size > sizeof(next_block));
+			if (cur_block_size <= sizeof(next_block)) {
+				// Block is missing the "next block" header...
+				error = true;
+				return false;
+			}
+			block_remaining = cur_block_size - sizeof(next_block);
+			in_block = true;
+		}
+
+		if (block_remaining > 2) {
+			// Get the chunk size.
+			uint16_t chunk_size;
+			size_t size = reader->read(&chunk_size, sizeof(chunk_size));
+			if (size != sizeof(chunk_size)) {
+				// Seek and/or read error.
+				error = true;
+				return false;
+			}
+			chunk_size = be16_to_cpu(chunk_size);
+			block_remaining -= 2;
+			if (chunk_size != 0 && chunk_size <= block_remaining) {
+				chunk_remaining = chunk_size;
+				block_remaining -= chunk_size;
+				return true;
+			}
+			// End of block, or not enough data is available.
+		}
+
+		if (block_remaining > 0) {
+			// Empty data at the end of the block.
+			// TODO: SEEK_CUR?
+			reader->seek(reader->tell() + block_remaining);
+			block_remaining = 0;
+		}
+
+		// Next block.
+		cur_block_size = next_block_size;
+		in_block = false;
+	}
+}
+#endif /* ENABLE_LIBMSPACK */
+
 /**
  * Initialize the PE executable reader.
  * @return peReader on success; nullptr on error.
@@ -532,7 +802,7 @@ CBCReader *Xbox360_XEX_Private::initPeReader(void)
 		return peReader;
 	}
 #ifdef ENABLE_LIBMSPACK
-	if (!lzx_peHeader.empty()) {
+	if (lzx_peHeader) {
 		// LZX has been decompressed.
 		return peReader;
 	}
@@ -724,210 +994,111 @@ CBCReader *Xbox360_XEX_Private::initPeReader(void)
 			}
 
 			// Window size.
-			// NOTE: Technically part of XEX2_Compression_Normal_Header,
-			// but we're not using that in order to be
-			// able to swap lzx_blocks.
-			const uint8_t *p = u8_ffi.data() + sizeof(fileFormatInfo);
-			const uint32_t *const pWindowSize =
-				reinterpret_cast<const uint32_t*>(p);
-			const uint32_t window_size = be32_to_cpu(*pWindowSize);
+			const XEX2_Compression_Normal_Header *const pNormalHeader =
+				reinterpret_cast<const XEX2_Compression_Normal_Header*>(
+					u8_ffi.data() + sizeof(fileFormatInfo));
+			const uint32_t window_size = be32_to_cpu(pNormalHeader->window_size);
 
 			// First block.
-			XEX2_Compression_Normal_Info first_block, lzx_blocks[2];
-			unsigned int lzx_idx = 0;
-			memcpy(&first_block, p+sizeof(window_size), sizeof(first_block));
-#if SYS_BYTEORDER == SYS_LIL_ENDIAN
-			first_block.block_size = be32_to_cpu(first_block.block_size);
-#endif /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
-			memcpy(&lzx_blocks[0], &first_block, sizeof(first_block));
 			// First block header is stored in the XEX header.
-			// Second block header is stored at the beginning of the compressed data.
-
-			// NOTE: We can't easily randomly seek within the compressed data,
-			// since the uncompressed block size isn't stored anywhere.
-			// We'll have to load the entire executable into memory,
-			// save the relevant portions, then free it.
-			// FIXME: It *might* be possible to randomly seek...
-			// Need to analyze the format more.
-			const off64_t fileSize = file->size();
-			if (fileSize > 64*1024*1024 || image_size > 64*1024*1024) {
-				// 64 MB is our compressed and uncompressed limit.
-				UNREF(reader[0]);
-				UNREF(reader[1]);
-				return nullptr;
-			}
+			// Subsequent block headers are stored in the compressed data.
+			const uint32_t first_block_size = be32_to_cpu(pNormalHeader->first_block.block_size);
 
-			// Compressed EXE buffer.
-			// We have to de-block the compressed data first.
-			const size_t compressed_size = static_cast<size_t>(fileSize) - xex2Header.pe_offset;
-			unique_ptr<uint8_t[]> compressed_deblock(new uint8_t[compressed_size]);
-
-			// Pointer within the deblocked compressed data.
-			uint8_t *p_dblk = compressed_deblock.get();
-			uint8_t *const p_dblk_end = p_dblk + compressed_size;
-
-			// CBCReader index.
-			// If a block size is invalid, we'll switch to the other one.
-			// If both are invalid, we have a problem.
-			unsigned int rd_idx = (reader[0] ? 0 : 1);
-			if (!reader[rd_idx]) {
-				// No readers available...
-				// FIXME: Not sure if this is needed...
-				UNREF(reader[!rd_idx]);
-				return nullptr;
+			// XDBF section location.
+			// Only decompressed if it's located after the PE header.
+			uint32_t xdbf_physaddr = 0, xdbf_size = 0;
+			const XEX2_Resource_Info *const pResInfo = getXdbfResInfo();
+			if (pResInfo) {
+				const uint32_t load_address = be32_to_cpu(
+					(xexType != XexType::XEX1
+						? secInfo.xex2.load_address
+						: secInfo.xex1.load_address));
+				if (pResInfo->vaddr >= load_address + PE_HEADER_SIZE &&
+				    pResInfo->size > 0 &&
+				    (uint64_t)pResInfo->vaddr - load_address + pResInfo->size <= image_size)
+				{
+					xdbf_physaddr = pResInfo->vaddr - load_address;
+					xdbf_size = pResInfo->size;
+				}
 			}
 
-			// Start at the beginning.
-			reader[rd_idx]->rewind();
-
-			// Based on: https://github.com/xenia-project/xenia/blob/5f764fc752c82674981a9f402f1bbd96b399112a/src/xenia/cpu/xex_module.cc
-			while (lzx_blocks[lzx_idx].block_size != 0) {
-				// Read the next block header.
-				size = reader[rd_idx]->read(&lzx_blocks[!lzx_idx], sizeof(lzx_blocks[!lzx_idx]));
-				if (size != sizeof(lzx_blocks[!lzx_idx])) {
-					// Seek and/or read error.
-					UNREF(reader[0]);
-					UNREF(reader[1]);
-					return nullptr;
+			// NOTE: We can't randomly seek within the compressed data,
+			// since the uncompressed block size isn't stored anywhere.
+			// Instead, the data is de-blocked and decompressed on demand,
+			// and decompression stops once the XDBF section is reached.
+			// The same LZX window is used for the PE header and the XDBF section.
+			// If a block header is invalid with one key, try the other key.
+			int rd_idx = -1;
+			for (size_t i = 0; i < reader.size(); i++) {
+				if (!reader[i])
+					continue;
+				if (CancelToken::isCurrentCancelled()) {
+					// Operation was cancelled.
+					// Don't retry with the other key.
+					break;
 				}
 
-				// Does the block size make sense?
-#if SYS_BYTEORDER == SYS_LIL_ENDIAN
-				lzx_blocks[!lzx_idx].block_size = be32_to_cpu(lzx_blocks[!lzx_idx].block_size);
-#endif /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
-				if (lzx_blocks[!lzx_idx].block_size > 65536) {
-					// Block size is invalid.
-					// Switch to the other reader.
-					if (rd_idx == 1) {
-						// No more readers...
-						UNREF(reader[1]);
-						return nullptr;
-					}
-					UNREF_AND_NULL(reader[0]);
+				LzxDeblocker deblocker(reader[i], first_block_size);
+				lzx_stream *const lzxs = lzx_stream_open(window_size, image_size,
+					LzxDeblocker::read_cb, &deblocker);
+				if (!lzxs) {
+					// Invalid window size.
+					break;
+				}
 
-					// reader[1] might be nullptr here...
-					if (!reader[1]) {
-						// Cannot continue.
-						return nullptr;
-					}
-					rd_idx = 1;
-
-					// Restart decompression in case the first few blocks
-					// were decompressed without any "errors".
-					// TODO: Also do this for errors after reading the block size?
-					reader[1]->rewind();
-					lzx_idx = 0;
-					memcpy(&lzx_blocks[0], &first_block, sizeof(first_block));
-					p_dblk = compressed_deblock.get();
+				// Decompress the PE header.
+				ao::uvector<uint8_t> peHeader(PE_HEADER_SIZE);
+				int res = lzx_stream_read(lzxs, peHeader.data(), PE_HEADER_SIZE);
+				if (res != MSPACK_ERR_OK || deblocker.error) {
+					// Error decompressing the data.
+					lzx_stream_close(lzxs);
 					continue;
 				}
 
-				// Read the current block.
-				uint32_t block_size = lzx_blocks[lzx_idx].block_size;
-				assert(block_size > sizeof(lzx_blocks[!lzx_idx]));
-				if (block_size <= sizeof(lzx_blocks[!lzx_idx])) {
-					// Block is missing the "next block" header...
-					UNREF(reader[0]);
-					UNREF(reader[1]);
-					return nullptr;
+				// Verify the MZ header.
+				uint16_t mz;
+				memcpy(&mz, peHeader.data(), sizeof(mz));
+				if (mz != cpu_to_be16('MZ')) {
+					// MZ header is not valid.
+					// TODO: Other checks?
+					lzx_stream_close(lzxs);
+					continue;
 				}
-				block_size -= sizeof(lzx_blocks[!lzx_idx]);
-
-				while (block_size > 2) {
-					// Get the chunk size.
-					uint16_t chunk_size;
-					size = reader[rd_idx]->read(&chunk_size, sizeof(chunk_size));
-					if (size != sizeof(chunk_size)) {
-						// Seek and/or read error.
-						UNREF(reader[0]);
-						UNREF(reader[1]);
-						return nullptr;
-					}
-#if SYS_BYTEORDER == SYS_LIL_ENDIAN
-					chunk_size = be16_to_cpu(chunk_size);
-#endif /* SYS_BYTEORDER = SYS_LIL_ENDIAN */
-					block_size -= 2;
-					if (chunk_size == 0 || chunk_size > block_size) {
-						// End of block, or not enough data is available.
-						break;
-					}
 
-					// Do we have enough space?
-					if (p_dblk + chunk_size >= p_dblk_end) {
-						// Out of memory.
-						// TODO: Error reporting.
-						UNREF(reader[0]);
-						UNREF(reader[1]);
-						return nullptr;
+				// Decompress the XDBF section.
+				ao::uvector<uint8_t> xdbfSection;
+				if (xdbf_size != 0) {
+					xdbfSection.resize(xdbf_size);
+					res = lzx_stream_read(lzxs, nullptr, xdbf_physaddr - PE_HEADER_SIZE);
+					if (res == MSPACK_ERR_OK) {
+						res = lzx_stream_read(lzxs, xdbfSection.data(), xdbf_size);
 					}
-
-					size = reader[rd_idx]->read(p_dblk, chunk_size);
-					if (size != chunk_size) {
-						// Seek and/or read error.
-						UNREF(reader[0]);
-						UNREF(reader[1]);
-						return nullptr;
+					if (res != MSPACK_ERR_OK || deblocker.error) {
+						// Error decompressing the XDBF section.
+						// The PE header is still usable.
+						xdbfSection.clear();
 					}
-
-					p_dblk += chunk_size;
-					block_size -= chunk_size;
-				}
-				if (block_size > 0) {
-					// Empty data at the end of the block.
-					// TODO: Error handling.
-					// TODO: SEEK_CUR?
-					reader[rd_idx]->seek(reader[rd_idx]->tell() + block_size);
 				}
 
-				// Next block.
-				lzx_idx = !lzx_idx;
-			}
+				lzx_stream_close(lzxs);
 
-			// Decompress the data.
-			unique_ptr<uint8_t[]> decompressed_exe(new uint8_t[image_size]);
-			int res = lzx_decompress(compressed_deblock.get(),
-				static_cast<size_t>(p_dblk - compressed_deblock.get()),
-				decompressed_exe.get(), image_size,
-				window_size, nullptr, 0);
-			if (res != MSPACK_ERR_OK) {
-				// Error decompressing the data.
-				UNREF(reader[0]);
-				UNREF(reader[1]);
-				return nullptr;
+				// The decompressed buffers are moved into RpMemFile
+				// objects, which are shared with the EXE and XDBF
+				// objects, so they aren't copied.
+				lzx_peHeader = new RpMemFile(std::move(peHeader));
+				if (!xdbfSection.empty()) {
+					lzx_xdbfSection = new RpMemFile(std::move(xdbfSection));
+				}
+				rd_idx = static_cast<int>(i);
+				break;
 			}
-
-			// Verify the MZ header.
-			uint16_t mz;
-			memcpy(&mz, decompressed_exe.get(), sizeof(mz));
-			if (mz != cpu_to_be16('MZ')) {
-				// MZ header is not valid.
-				// TODO: Other checks?
+			if (rd_idx < 0) {
+				// Unable to decompress the data.
 				UNREF(reader[0]);
 				UNREF(reader[1]);
 				return nullptr;
 			}
 
-			// Copy the PE header.
-			lzx_peHeader.resize(PE_HEADER_SIZE);
-			memcpy(lzx_peHeader.data(), decompressed_exe.get(), PE_HEADER_SIZE);
-
-			// Copy the XDBF section.
-			const XEX2_Resource_Info *const pResInfo = getXdbfResInfo();
-			if (pResInfo) {
-				const uint32_t load_address = be32_to_cpu(
-					(xexType != XexType::XEX1
-						? secInfo.xex2.load_address
-						: secInfo.xex1.load_address));
-
-				const uint32_t xdbf_physaddr = pResInfo->vaddr - load_address;
-				if (xdbf_physaddr + pResInfo->size <= image_size) {
-					lzx_xdbfSection.resize(pResInfo->size);
-					memcpy(lzx_xdbfSection.data(),
-						decompressed_exe.get() + xdbf_physaddr,
-						pResInfo->size);
-				}
-			}
-
 			// Save the correct reader.
 			this->peReader = reader[rd_idx];
 			reader[rd_idx] = nullptr;
@@ -939,7 +1110,7 @@ CBCReader *Xbox360_XEX_Private::initPeReader(void)
 
 	// Verify the MZ header for non-LZX compression.
 #ifdef ENABLE_LIBMSPACK
-	if (lzx_peHeader.empty())
+	if (!lzx_peHeader)
 #endif /* ENABLE_LIBMSPACK */
 	{
 		// Check the CBCReader objects.
@@ -1173,8 +1344,8 @@ const EXE *Xbox360_XEX_Private::initEXE(void)
 	// Assuming a maximum of 8 KB for the PE headers.
 	IRpFile *peFile_tmp;
 #ifdef ENABLE_LIBMSPACK
-	if (!lzx_peHeader.empty()) {
-		peFile_tmp = new RpMemFile(lzx_peHeader.data(), lzx_peHeader.size());
+	if (lzx_peHeader) {
+		peFile_tmp = lzx_peHeader->ref();
 	} else
 #endif /* ENABLE_LIBMSPACK */
 	{
@@ -1213,8 +1384,8 @@ const Xbox360_XDBF *Xbox360_XEX_Private::initXDBF(void)
 	// Attempt to open the XDBF section.
 	IRpFile *peFile_tmp;
 #ifdef ENABLE_LIBMSPACK
-	if (!lzx_xdbfSection.empty()) {
-		peFile_tmp = new RpMemFile(lzx_xdbfSection.data(), lzx_xdbfSection.size());
+	if (lzx_xdbfSection) {
+		peFile_tmp = lzx_xdbfSection->ref();
 	} else
 #endif /* ENABLE_LIBMSPACK */
 	{
@@ -1426,10 +1597,8 @@ void Xbox360_XEX::close(void)
 	UNREF_AND_NULL(d->peReader);
 
 #ifdef ENABLE_LIBMSPACK
-	d->lzx_peHeader.clear();
-	d->lzx_peHeader.shrink_to_fit();
-	d->lzx_xdbfSection.clear();
-	d->lzx_xdbfSection.shrink_to_fit();
+	UNREF_AND_NULL(d->lzx_peHeader);
+	UNREF_AND_NULL(d->lzx_xdbfSection);
 #endif /* ENABLE_LIBMSPACK */
 
 	// Call the superclass function.
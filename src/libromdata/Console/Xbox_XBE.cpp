@@ -28,6 +28,7 @@ using LibRpTexture::XboxXPR;
 using std::ostringstream;
 using std::string;
 using std::unique_ptr;
+using std::unordered_map;
 using std::vector;
 
 namespace LibRomData {
@@ -56,6 +57,18 @@ class Xbox_XBE_Private final : public RomDataPrivate
 		// NOTE: **NOT** byteswapped.
 		XBE_Certificate xbeCertificate;
 
+		// XBE headers. (total_header_size, or less if the file is truncated)
+		// The certificate, section headers, and section names
+		// are usually located here.
+		unique_ptr<uint8_t[]> headerData;
+		uint32_t headerSize;
+
+		// Section headers. (Byteswapped to host-endian.)
+		vector<XBE_Section_Header> sectionHeaders;
+		// Section name lookup table. (value is the sectionHeaders index)
+		unordered_map<string, unsigned int> sectionNames;
+		bool sectionHeadersLoaded;
+
 		// RomData subclasses.
 		// TODO: Also get the save image? ($$XSIMAGE)
 		DiscReader *discReader;	// Common DiscReader
@@ -73,13 +86,36 @@ class Xbox_XBE_Private final : public RomDataPrivate
 		} xtImage;
 
 	public:
+		/**
+		 * Get a pointer to data within the XBE headers.
+		 * @param address	[in] Memory address.
+		 * @param size		[in] Data size.
+		 * @return Pointer to the data, or nullptr if it isn't entirely within the XBE headers.
+		 */
+		const uint8_t *getHeaderData(uint32_t address, size_t size) const;
+
+		/**
+		 * Read data from a memory address.
+		 * The XBE headers are used if possible.
+		 * @param address	[in] Memory address.
+		 * @param buf		[out] Output buffer.
+		 * @param size		[in] Data size.
+		 * @return Number of bytes read.
+		 */
+		size_t readAddress(uint32_t address, void *buf, size_t size);
+
+		/**
+		 * Load the XBE section headers and build the section name lookup table.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadSectionHeaders(void);
+
 		/**
 		 * Find an XBE section header.
 		 * @param name		[in] Section header name.
-		 * @param pOutHeader	[out] Buffer to store the header. (Byteswapped to host-endian.)
-		 * @return 0 on success; negative POSIX error code on error.
+		 * @return Section header (byteswapped to host-endian), or nullptr if not found.
 		 */
-		int findXbeSectionHeader(const char *name, XBE_Section_Header *pOutHeader);
+		const XBE_Section_Header *findXbeSectionHeader(const char *name);
 
 		/**
 		 * Initialize the title image object.
@@ -105,6 +141,8 @@ class Xbox_XBE_Private final : public RomDataPrivate
 
 Xbox_XBE_Private::Xbox_XBE_Private(Xbox_XBE *q, IRpFile *file)
 	: super(q, file)
+	, headerSize(0)
+	, sectionHeadersLoaded(false)
 	, discReader(nullptr)
 	, pe_exe(nullptr)
 {
@@ -134,98 +172,145 @@ Xbox_XBE_Private::~Xbox_XBE_Private()
 }
 
 /**
- * Find an XBE section header.
- * @param name		[in] Section header name.
- * @param pOutHeader	[out] Buffer to store the header. (Byteswapped to host-endian.)
- * @return 0 on success; negative POSIX error code on error.
+ * Get a pointer to data within the XBE headers.
+ * @param address	[in] Memory address.
+ * @param size		[in] Data size.
+ * @return Pointer to the data, or nullptr if it isn't entirely within the XBE headers.
  */
-int Xbox_XBE_Private::findXbeSectionHeader(const char *name, XBE_Section_Header *pOutHeader)
+const uint8_t *Xbox_XBE_Private::getHeaderData(uint32_t address, size_t size) const
 {
-	// Load the section headers.
-	if (!file || !file->isOpen()) {
-		// File is not open.
-		return -EBADF;
-	}
-
-	// We're loading the first 64 KB of the executable.
-	// Section headers and names are usually there.
-	// TODO: Find any exceptions?
-	static const size_t XBE_READ_SIZE = 64*1024;
-
-	// Load the section headers.
 	const uint32_t base_address = le32_to_cpu(xbeHeader.base_address);
-	const uint32_t section_headers_address = le32_to_cpu(xbeHeader.section_headers_address);
-	if (section_headers_address <= base_address) {
+	if (address <= base_address) {
 		// Out of range.
-		// NOTE: <= - base address would have the magic number.
-		return -EIO;
+		// NOTE: Nothing should point to the XBE magic number.
+		return nullptr;
 	}
 
-	const uint32_t shdr_address_phys = section_headers_address - base_address;
-	if (shdr_address_phys >= XBE_READ_SIZE) {
-		// Section headers is not in the first 64 KB.
-		return -EIO;
+	const uint32_t phys_address = address - base_address;
+	if (phys_address >= headerSize || size > headerSize - phys_address) {
+		// Not within the XBE headers.
+		return nullptr;
 	}
+	return &headerData[phys_address];
+}
 
-	// Read the XBE header.
-	unique_ptr<uint8_t[]> first64KB(new uint8_t[XBE_READ_SIZE]);
-	size_t size = file->seekAndRead(0, first64KB.get(), XBE_READ_SIZE);
-	if (size != XBE_READ_SIZE) {
-		// Seek and/or read error.
-		return -EIO;
+/**
+ * Read data from a memory address.
+ * The XBE headers are used if possible.
+ * @param address	[in] Memory address.
+ * @param buf		[out] Output buffer.
+ * @param size		[in] Data size.
+ * @return Number of bytes read.
+ */
+size_t Xbox_XBE_Private::readAddress(uint32_t address, void *buf, size_t size)
+{
+	const uint8_t *const pData = getHeaderData(address, size);
+	if (pData) {
+		// Data is within the XBE headers.
+		memcpy(buf, pData, size);
+		return size;
 	}
 
-	// Section count.
-	unsigned int section_count = le32_to_cpu(xbeHeader.section_count);
-	// If this goes over the 64 KB limit, reduce the section count.
-	if (shdr_address_phys + (section_count * sizeof(XBE_Section_Header)) > XBE_READ_SIZE) {
-		// Out of bounds. Reduce it.
-		section_count = (XBE_READ_SIZE - shdr_address_phys) / sizeof(XBE_Section_Header);
+	const uint32_t base_address = le32_to_cpu(xbeHeader.base_address);
+	if (address <= base_address || !file || !file->isOpen()) {
+		// Out of range, or the file isn't open.
+		return 0;
 	}
+	return file->seekAndRead(address - base_address, buf, size);
+}
 
-	// First section header.
-	const XBE_Section_Header *pHdr = reinterpret_cast<const XBE_Section_Header*>(
-		&first64KB[shdr_address_phys]);
-	const XBE_Section_Header *const pHdr_end = pHdr + section_count;
+/**
+ * Load the XBE section headers and build the section name lookup table.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int Xbox_XBE_Private::loadSectionHeaders(void)
+{
+	if (sectionHeadersLoaded) {
+		// Section headers have already been loaded.
+		return (!sectionHeaders.empty() ? 0 : -ENOENT);
+	}
+	sectionHeadersLoaded = true;
 
-	// Find the $$XTIMAGE section.
-	// TODO: Cache a "not found" result so we don't have to
-	// re-check the section headers again?
-	for (; pHdr < pHdr_end; pHdr++) {
-		char section_name[16];	// Allow up to 15 chars plus NULL terminator.
-
-		const uint32_t name_address = le32_to_cpu(pHdr->section_name_address);
-		if (name_address <= base_address) {
-			// Out of range.
-			continue;
-		}
+	// Section headers are usually within the XBE headers.
+	const uint32_t section_headers_address = le32_to_cpu(xbeHeader.section_headers_address);
+	const unsigned int section_count = le32_to_cpu(xbeHeader.section_count);
+	if (section_count == 0 || section_count > 1024) {
+		// No sections, or too many sections.
+		return -ENOENT;
+	}
 
-		// Read the name.
-		size = file->seekAndRead(name_address - base_address, section_name, sizeof(section_name));
-		if (size != sizeof(section_name)) {
+	unique_ptr<XBE_Section_Header[]> shdr_buf;
+	const XBE_Section_Header *pHdr = reinterpret_cast<const XBE_Section_Header*>(
+		getHeaderData(section_headers_address, section_count * sizeof(XBE_Section_Header)));
+	if (!pHdr) {
+		// Not within the XBE headers. Read them from the file.
+		shdr_buf.reset(new XBE_Section_Header[section_count]);
+		const size_t shdr_size = section_count * sizeof(XBE_Section_Header);
+		size_t size = readAddress(section_headers_address, shdr_buf.get(), shdr_size);
+		if (size != shdr_size) {
 			// Seek and/or read error.
 			return -EIO;
 		}
-		section_name[sizeof(section_name)-1] = '\0';
-
-		if (!strcmp(section_name, name)) {
-			// Found it!
-			pOutHeader->flags = le32_to_cpu(pHdr->flags);
-			pOutHeader->vaddr = le32_to_cpu(pHdr->vaddr);
-			pOutHeader->vsize = le32_to_cpu(pHdr->vsize);
-			pOutHeader->paddr = le32_to_cpu(pHdr->paddr);
-			pOutHeader->psize = le32_to_cpu(pHdr->psize);
-			pOutHeader->section_name_address		= le32_to_cpu(pHdr->section_name_address);
-			pOutHeader->section_name_refcount		= le32_to_cpu(pHdr->section_name_refcount);
-			pOutHeader->head_shared_page_recount_address	= le32_to_cpu(pHdr->head_shared_page_recount_address);
-			pOutHeader->tail_shared_page_recount_address	= le32_to_cpu(pHdr->tail_shared_page_recount_address);
-			memcpy(pOutHeader->sha1_digest, pHdr->sha1_digest, sizeof(pHdr->sha1_digest));
-			return 0;
+		pHdr = shdr_buf.get();
+	}
+
+	sectionHeaders.resize(section_count);
+	sectionNames.reserve(section_count);
+	for (unsigned int i = 0; i < section_count; i++, pHdr++) {
+		XBE_Section_Header *const pOutHeader = &sectionHeaders[i];
+		pOutHeader->flags = le32_to_cpu(pHdr->flags);
+		pOutHeader->vaddr = le32_to_cpu(pHdr->vaddr);
+		pOutHeader->vsize = le32_to_cpu(pHdr->vsize);
+		pOutHeader->paddr = le32_to_cpu(pHdr->paddr);
+		pOutHeader->psize = le32_to_cpu(pHdr->psize);
+		pOutHeader->section_name_address		= le32_to_cpu(pHdr->section_name_address);
+		pOutHeader->section_name_refcount		= le32_to_cpu(pHdr->section_name_refcount);
+		pOutHeader->head_shared_page_recount_address	= le32_to_cpu(pHdr->head_shared_page_recount_address);
+		pOutHeader->tail_shared_page_recount_address	= le32_to_cpu(pHdr->tail_shared_page_recount_address);
+		memcpy(pOutHeader->sha1_digest, pHdr->sha1_digest, sizeof(pHdr->sha1_digest));
+
+		// Get the section name.
+		// Allow up to 15 chars plus NULL terminator.
+		char section_name[16];
+		const uint32_t name_address = pOutHeader->section_name_address;
+		const uint8_t *const pName = getHeaderData(name_address, 1);
+		if (pName) {
+			// Name is within the XBE headers.
+			const size_t maxlen = std::min(sizeof(section_name)-1,
+				static_cast<size_t>(&headerData[headerSize] - pName));
+			const size_t len = strnlen(reinterpret_cast<const char*>(pName), maxlen);
+			memcpy(section_name, pName, len);
+			section_name[len] = '\0';
+		} else {
+			size_t size = readAddress(name_address, section_name, sizeof(section_name));
+			if (size != sizeof(section_name)) {
+				// Seek and/or read error, or out of range.
+				continue;
+			}
+			section_name[sizeof(section_name)-1] = '\0';
 		}
+
+		// NOTE: If a name is duplicated, the first section is used.
+		sectionNames.emplace(section_name, i);
+	}
+
+	return 0;
+}
+
+/**
+ * Find an XBE section header.
+ * @param name		[in] Section header name.
+ * @return Section header (byteswapped to host-endian), or nullptr if not found.
+ */
+const XBE_Section_Header *Xbox_XBE_Private::findXbeSectionHeader(const char *name)
+{
+	if (loadSectionHeaders() != 0) {
+		// Unable to load the section headers.
+		return nullptr;
 	}
 
-	// Not found.
-	return -ENOENT;
+	auto iter = sectionNames.find(name);
+	return (iter != sectionNames.end() ? &sectionHeaders[iter->second] : nullptr);
 }
 
 /**
@@ -241,9 +326,8 @@ int Xbox_XBE_Private::initXPR0_xtImage(void)
 	}
 
 	// Find the $$XTIMAGE section.
-	XBE_Section_Header hdr_xtImage;
-	int ret = findXbeSectionHeader("$$XTIMAGE", &hdr_xtImage);
-	if (ret != 0) {
+	const XBE_Section_Header *const hdr_xtImage = findXbeSectionHeader("$$XTIMAGE");
+	if (!hdr_xtImage) {
 		// Not found.
 		return -ENOENT;
 	}
@@ -261,9 +345,9 @@ int Xbox_XBE_Private::initXPR0_xtImage(void)
 
 	// Open the XPR0 image.
 	// paddr/psize have absolute addresses.
-	ret = 0;
+	int ret = 0;
 	IRpFile *const ptFile = new PartitionFile(discReader,
-		hdr_xtImage.paddr, hdr_xtImage.psize);
+		hdr_xtImage->paddr, hdr_xtImage->psize);
 	if (ptFile->isOpen()) {
 		// $$XTIMAGE is usually an XPR0 image.
 		// The Burger King games, wihch have both Xbox and Xbox 360
@@ -302,6 +386,9 @@ int Xbox_XBE_Private::initXPR0_xtImage(void)
 				img->unref();
 				ret = -EIO;
 			}
+		} else {
+			// Unsupported image format.
+			ret = -ENOTSUP;
 		}
 		ptFile->unref();
 	} else {
@@ -310,8 +397,7 @@ int Xbox_XBE_Private::initXPR0_xtImage(void)
 		ptFile->unref();
 	}
 
-	// Image loaded.
-	return 0;
+	return ret;
 }
 
 /**
@@ -431,14 +517,21 @@ Xbox_XBE::Xbox_XBE(IRpFile *file)
 		return;
 	}
 
-	// Read the XBE header.
+	// Read the XBE headers.
+	// NOTE: Reading the first 4 KB to reduce seeking.
+	// The rest of the headers are read after validating the XBE header.
+	static const uint32_t XBE_INITIAL_READ_SIZE = 4096;
+	d->headerData.reset(new uint8_t[XBE_INITIAL_READ_SIZE]);
 	d->file->rewind();
-	size_t size = d->file->read(&d->xbeHeader, sizeof(d->xbeHeader));
-	if (size != sizeof(d->xbeHeader)) {
+	size_t size = d->file->read(d->headerData.get(), XBE_INITIAL_READ_SIZE);
+	if (size < sizeof(d->xbeHeader)) {
+		d->headerData.reset();
 		d->xbeHeader.magic = 0;
 		UNREF_AND_NULL_NOCHK(d->file);
 		return;
 	}
+	d->headerSize = static_cast<uint32_t>(size);
+	memcpy(&d->xbeHeader, d->headerData.get(), sizeof(d->xbeHeader));
 
 	// Check if this file is supported.
 	DetectInfo info;
@@ -450,22 +543,35 @@ Xbox_XBE::Xbox_XBE(IRpFile *file)
 	d->isValid = (isRomSupported_static(&info) >= 0);
 
 	if (!d->isValid) {
+		d->headerData.reset();
+		d->headerSize = 0;
 		d->xbeHeader.magic = 0;
 		UNREF_AND_NULL_NOCHK(d->file);
 		return;
 	}
 
+	// Read the rest of the XBE headers, if necessary.
+	// NOTE: Limited to 1 MB in case the header size is invalid.
+	static const uint32_t XBE_HEADER_SIZE_MAX = 1024*1024;
+	uint32_t total_header_size = le32_to_cpu(d->xbeHeader.total_header_size);
+	if (total_header_size > XBE_HEADER_SIZE_MAX) {
+		total_header_size = XBE_HEADER_SIZE_MAX;
+	}
+	if (total_header_size > d->headerSize && d->headerSize == XBE_INITIAL_READ_SIZE) {
+		uint8_t *const newHeaderData = new uint8_t[total_header_size];
+		memcpy(newHeaderData, d->headerData.get(), d->headerSize);
+		d->headerData.reset(newHeaderData);
+		size = d->file->read(&newHeaderData[d->headerSize], total_header_size - d->headerSize);
+		d->headerSize += static_cast<uint32_t>(size);
+	}
+
 	// Load the certificate.
-	const uint32_t base_address = le32_to_cpu(d->xbeHeader.base_address);
 	const uint32_t cert_address = le32_to_cpu(d->xbeHeader.cert_address);
-	if (cert_address > base_address) {
-		size = d->file->seekAndRead(cert_address - base_address,
-			&d->xbeCertificate, sizeof(d->xbeCertificate));
-		if (size != sizeof(d->xbeCertificate)) {
-			// Unable to load the certificate.
-			// Continue anyway.
-			d->xbeCertificate.size = 0;
-		}
+	size = d->readAddress(cert_address, &d->xbeCertificate, sizeof(d->xbeCertificate));
+	if (size != sizeof(d->xbeCertificate)) {
+		// Unable to load the certificate.
+		// Continue anyway.
+		d->xbeCertificate.size = 0;
 	}
 }
 
@@ -744,7 +850,7 @@ int Xbox_XBE::loadFieldData(void)
 	const char *const s_filename_title = C_("Xbox_XBE", "PE Filename");
 	if (filenameW_address > base_address) {
 		char16_t pe_filename_W[260];
-		size_t size = d->file->seekAndRead(filenameW_address - base_address,
+		size_t size = d->readAddress(filenameW_address,
 			pe_filename_W, sizeof(pe_filename_W));
 		if (size == sizeof(pe_filename_W)) {
 			// Convert to UTF-8.
@@ -954,7 +1060,12 @@ int Xbox_XBE::loadInternalImage(ImageType imageType, const rp_image **pImage)
 	}
 
 	if (!d->xtImage.isInit) {
-		d->initXPR0_xtImage();
+		const int ret = d->initXPR0_xtImage();
+		if (ret != 0) {
+			// Unable to load the title image.
+			*pImage = nullptr;
+			return ret;
+		}
 	}
 
 	if (!d->xtImage.isPng) {
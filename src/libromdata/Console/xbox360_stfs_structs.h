@@ -256,6 +256,53 @@ typedef enum {
 	STFS_TRANSFER_FLAG_BIT_PROFILE_TRANSFER		= (1U << 7),
 } STFS_Transfer_Flags_e;
 
+/**
+ * STFS: Hash table entry.
+ * All fields are in big-endian.
+ */
+typedef struct _STFS_Hash_Entry {
+	uint8_t sha1[0x14];		// [0x000] SHA-1 of the block
+	uint8_t status;			// [0x014] Status (See STFS_Hash_Status_e)
+	uint8_t next_block[3];		// [0x015] Next block number (BE24)
+} STFS_Hash_Entry;
+ASSERT_STRUCT(STFS_Hash_Entry, 0x18);
+
+/**
+ * STFS: Hash table entry status.
+ */
+typedef enum {
+	STFS_HASH_STATUS_UNUSED		= 0x00,
+	STFS_HASH_STATUS_FREE		= 0x40,
+	STFS_HASH_STATUS_USED		= 0x80,
+	STFS_HASH_STATUS_NEW		= 0xC0,
+
+	// For level 1 and level 2 hash tables, this bit indicates
+	// which copy of the child hash table is active.
+	STFS_HASH_STATUS_ACTIVE_COPY	= 0x40,
+} STFS_Hash_Status_e;
+
+// Number of entries in each hash table.
+#define STFS_HASH_ENTRIES_PER_TABLE 0xAA
+
+/**
+ * STFS: Hash table.
+ * Each hash table occupies one block.
+ */
+typedef struct _STFS_Hash_Table {
+	STFS_Hash_Entry entries[STFS_HASH_ENTRIES_PER_TABLE];	// [0x000]
+	uint8_t reserved[0x10];					// [0xFF0]
+} STFS_Hash_Table;
+ASSERT_STRUCT(STFS_Hash_Table, STFS_BLOCK_SIZE);
+
+/**
+ * STFS: Directory entry flags. (flags_len)
+ */
+typedef enum {
+	STFS_DIRENT_NAME_LEN_MASK	= 0x3F,	// Filename length
+	STFS_DIRENT_FLAG_CONSECUTIVE	= 0x40,	// Blocks are consecutive
+	STFS_DIRENT_FLAG_DIRECTORY	= 0x80,	// Subdirectory
+} STFS_DirEntry_Flags_e;
+
 /**
  * STFS: Directory entry.
  */
@@ -0,0 +1,490 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * DetectCache.cpp: Persistent RomData detection result cache.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "DetectCache.hpp"
+
+// librpfile, librpthreads
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpFile.hpp"
+#include "librpthreads/Mutex.hpp"
+using namespace LibRpFile;
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
+// libcachecommon
+#include "libcachecommon/CacheDir.hpp"
+
+// C++ includes.
+#include <atomic>
+
+// C++ STL classes.
+using std::string;
+using std::vector;
+
+namespace LibRomData {
+
+/**
+ * Detection cache file format:
+ * - DetCacheHeader
+ * - Array of DetCacheEntry
+ *
+ * New entries are appended to the end of the file. If a
+ * filename hash is present more than once, the last entry
+ * is used. An entry with classHash == 0 removes the file.
+ * The file is rewritten with only the live entries,
+ * sorted by hash, if it grows too large.
+ *
+ * All values are little-endian.
+ */
+static const uint32_t DETCACHE_MAGIC = 'RPDC';
+static const uint32_t DETCACHE_VERSION = 1;
+
+struct DetCacheHeader {
+	uint32_t magic;		// [0x000] 'RPDC'
+	uint32_t version;	// [0x004] Format version.
+};
+ASSERT_STRUCT(DetCacheHeader, 8);
+
+struct DetCacheEntry {
+	uint64_t hash;		// [0x000] FNV-1a hash of the filename.
+	int64_t fileSize;	// [0x008] File size.
+	int64_t mtime;		// [0x010] File modification time.
+	uint32_t classHash;	// [0x018] RomData subclass name hash. (0 == removed)
+	uint32_t address;	// [0x01C] Header address.
+};
+ASSERT_STRUCT(DetCacheEntry, 32);
+
+// Detection cache filename. (in the cache directory)
+static const char DETCACHE_FILENAME[] = "detect.bin";
+
+// How often to check if another process updated the file, in seconds.
+static const time_t DETCACHE_RECHECK_TIME = 60;
+
+// Compact the file if it has at least this many dead records.
+static const size_t DETCACHE_COMPACT_THRESHOLD = 1024;
+
+// Maximum file size. (8 MB; about 256K entries)
+static const off64_t DETCACHE_MAX_SIZE = 8*1024*1024;
+
+/**
+ * Detection cache state.
+ * Shared by all threads in the process.
+ */
+static struct {
+	Mutex mutex;
+
+	// Live entries, sorted by hash. (host-endian)
+	vector<DetCacheEntry> entries;
+
+	// Detection cache filename.
+	string filename;
+
+	// File size and mtime when the file was last loaded.
+	off64_t fileSize;
+	time_t fileMtime;
+
+	// Last time the file was checked for changes.
+	time_t lastCheck;
+	bool loaded;
+} detCache;
+
+// Is the detection cache enabled?
+static std::atomic<bool> detCacheEnabled(false);
+
+/**
+ * Get the FNV-1a hash of a filename.
+ * @param filename Filename.
+ * @return FNV-1a hash.
+ */
+static uint64_t hashFilename(const string &filename)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (const char chr : filename) {
+		hash ^= static_cast<uint8_t>(chr);
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+/**
+ * Compare two entries by hash.
+ */
+static inline bool entryHashLess(const DetCacheEntry &a, const DetCacheEntry &b)
+{
+	return a.hash < b.hash;
+}
+
+/**
+ * Convert an entry to or from little-endian.
+ * @param dest Destination entry.
+ * @param src Source entry.
+ */
+static inline void swapEntry(DetCacheEntry &dest, const DetCacheEntry &src)
+{
+	dest.hash = le64_to_cpu(src.hash);
+	dest.fileSize = static_cast<int64_t>(le64_to_cpu(static_cast<uint64_t>(src.fileSize)));
+	dest.mtime = static_cast<int64_t>(le64_to_cpu(static_cast<uint64_t>(src.mtime)));
+	dest.classHash = le32_to_cpu(src.classHash);
+	dest.address = le32_to_cpu(src.address);
+}
+
+/**
+ * Rewrite the detection cache file using only the live entries.
+ * detCache.mutex must be locked by the caller.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int compactDetectCache(void)
+{
+	vector<uint8_t> buf;
+	buf.resize(sizeof(DetCacheHeader) + (detCache.entries.size() * sizeof(DetCacheEntry)));
+	DetCacheHeader *const header = reinterpret_cast<DetCacheHeader*>(buf.data());
+	header->magic = cpu_to_le32(DETCACHE_MAGIC);
+	header->version = cpu_to_le32(DETCACHE_VERSION);
+	DetCacheEntry *pEntry = reinterpret_cast<DetCacheEntry*>(&buf[sizeof(DetCacheHeader)]);
+	for (const DetCacheEntry &entry : detCache.entries) {
+		swapEntry(*pEntry, entry);
+		pEntry++;
+	}
+
+	// Write to a temporary file first so other processes
+	// never see a partially-written file.
+	const string tmp_filename = detCache.filename + ".tmp";
+	RpFile *const file = new RpFile(tmp_filename, RpFile::FM_CREATE_WRITE);
+	if (!file->isOpen()) {
+		int ret = -file->lastError();
+		file->unref();
+		return (ret != 0 ? ret : -EIO);
+	}
+	const size_t size = file->write(buf.data(), buf.size());
+	file->unref();
+	if (size != buf.size()) {
+		FileSystem::delete_file(tmp_filename);
+		return -EIO;
+	}
+
+#ifdef _WIN32
+	// rename() fails on Windows if the target file exists.
+	FileSystem::delete_file(detCache.filename);
+#endif /* _WIN32 */
+	if (rename(tmp_filename.c_str(), detCache.filename.c_str()) != 0) {
+		int ret = -errno;
+		FileSystem::delete_file(tmp_filename);
+		return (ret != 0 ? ret : -EIO);
+	}
+
+	FileSystem::get_file_size_and_mtime(detCache.filename, &detCache.fileSize, &detCache.fileMtime);
+	return 0;
+}
+
+/**
+ * Load the detection cache file.
+ * detCache.mutex must be locked by the caller.
+ */
+static void loadDetectCache(void)
+{
+	detCache.entries.clear();
+	detCache.fileSize = 0;
+	detCache.fileMtime = 0;
+
+	if (detCache.filename.empty()) {
+		const string &cache_dir = LibCacheCommon::getCacheDirectory();
+		if (cache_dir.empty()) {
+			// No cache directory.
+			return;
+		}
+		detCache.filename = cache_dir;
+		if (detCache.filename.at(detCache.filename.size()-1) != DIR_SEP_CHR) {
+			detCache.filename += DIR_SEP_CHR;
+		}
+		detCache.filename += DETCACHE_FILENAME;
+	}
+
+	RpFile *const file = new RpFile(detCache.filename, RpFile::FM_OPEN_READ);
+	if (!file->isOpen()) {
+		// No detection cache yet.
+		file->unref();
+		return;
+	}
+
+	const off64_t fileSize = file->size();
+	if (fileSize < static_cast<off64_t>(sizeof(DetCacheHeader)) || fileSize > DETCACHE_MAX_SIZE) {
+		// Invalid file size.
+		file->unref();
+		return;
+	}
+
+	vector<uint8_t> buf(static_cast<size_t>(fileSize));
+	const size_t size = file->read(buf.data(), buf.size());
+	file->unref();
+	if (size != buf.size()) {
+		// Read error.
+		return;
+	}
+
+	const DetCacheHeader *const header = reinterpret_cast<const DetCacheHeader*>(buf.data());
+	if (header->magic != cpu_to_le32(DETCACHE_MAGIC) ||
+	    header->version != cpu_to_le32(DETCACHE_VERSION))
+	{
+		// Incorrect magic number or version.
+		return;
+	}
+
+	// NOTE: A partially-written record at the end of
+	// the file from an interrupted append is ignored.
+	const size_t count = (buf.size() - sizeof(DetCacheHeader)) / sizeof(DetCacheEntry);
+	const DetCacheEntry *pEntry = reinterpret_cast<const DetCacheEntry*>(&buf[sizeof(DetCacheHeader)]);
+	detCache.entries.resize(count);
+	for (size_t i = 0; i < count; i++, pEntry++) {
+		swapEntry(detCache.entries[i], *pEntry);
+	}
+
+	// Sort the entries by hash. If a hash is present more than
+	// once, keep the last one, since it was appended last.
+	std::stable_sort(detCache.entries.begin(), detCache.entries.end(), entryHashLess);
+	auto out = detCache.entries.begin();
+	for (auto iter = detCache.entries.begin(); iter != detCache.entries.end(); ++iter) {
+		if (out != detCache.entries.begin() && (out-1)->hash == iter->hash) {
+			*(out-1) = *iter;
+			continue;
+		}
+		*out++ = *iter;
+	}
+	detCache.entries.erase(out, detCache.entries.end());
+
+	// Drop removed entries.
+	detCache.entries.erase(std::remove_if(detCache.entries.begin(), detCache.entries.end(),
+		[](const DetCacheEntry &entry) { return entry.classHash == 0; }),
+		detCache.entries.end());
+
+	FileSystem::get_file_size_and_mtime(detCache.filename, &detCache.fileSize, &detCache.fileMtime);
+
+	if (count - detCache.entries.size() >= DETCACHE_COMPACT_THRESHOLD) {
+		// Too many removed or duplicate records.
+		compactDetectCache();
+	}
+}
+
+/**
+ * Make sure the detection cache is up to date.
+ * detCache.mutex must be locked by the caller.
+ */
+static void updateDetectCache(void)
+{
+	const time_t now = time(nullptr);
+	if (!detCache.loaded) {
+		detCache.loaded = true;
+		detCache.lastCheck = now;
+		loadDetectCache();
+		return;
+	}
+
+	if (now - detCache.lastCheck < DETCACHE_RECHECK_TIME && now >= detCache.lastCheck) {
+		// Checked recently.
+		return;
+	}
+	detCache.lastCheck = now;
+
+	// Reload the file if another process changed it.
+	off64_t fileSize = 0;
+	time_t fileMtime = 0;
+	FileSystem::get_file_size_and_mtime(detCache.filename, &fileSize, &fileMtime);
+	if (fileSize != detCache.fileSize || fileMtime != detCache.fileMtime) {
+		loadDetectCache();
+	}
+}
+
+/**
+ * Enable or disable the detection cache for this process.
+ *
+ * Disabling the cache discards the in-memory copy of the
+ * cache file. It will be reloaded if the cache is re-enabled.
+ *
+ * @param enable True to enable; false to disable. (default is disabled)
+ */
+void DetectCache::setEnabled(bool enable)
+{
+	detCacheEnabled.store(enable, std::memory_order_relaxed);
+	if (!enable) {
+		MutexLocker locker(detCache.mutex);
+		detCache.entries.clear();
+		detCache.entries.shrink_to_fit();
+		detCache.loaded = false;
+	}
+}
+
+/**
+ * Is the detection cache enabled for this process?
+ * @return True if enabled; false if not.
+ */
+bool DetectCache::isEnabled(void)
+{
+	return detCacheEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Get the hash of a RomData subclass name.
+ * @param className Class name.
+ * @return Class name hash. (never 0)
+ */
+uint32_t DetectCache::hashClassName(const char *className)
+{
+	uint32_t hash = 0x811C9DC5U;
+	for (; *className != '\0'; className++) {
+		hash ^= static_cast<uint8_t>(*className);
+		hash *= 0x01000193U;
+	}
+	// 0 is used to indicate a removed entry.
+	return (hash != 0 ? hash : 1);
+}
+
+/**
+ * Look up a file in the detection cache.
+ * @param filename	[in] Filename. (UTF-8)
+ * @param fileSize	[in] File size.
+ * @param mtime		[in] File modification time.
+ * @param pClassHash	[out] Class name hash.
+ * @param pAddress	[out] Header address.
+ * @return True if the file was found; false if not.
+ */
+bool DetectCache::lookup(const string &filename, off64_t fileSize, time_t mtime,
+	uint32_t *pClassHash, uint32_t *pAddress)
+{
+	assert(pClassHash != nullptr);
+	assert(pAddress != nullptr);
+	if (!isEnabled()) {
+		return false;
+	}
+
+	DetCacheEntry key;
+	key.hash = hashFilename(filename);
+
+	MutexLocker locker(detCache.mutex);
+	updateDetectCache();
+
+	auto iter = std::lower_bound(detCache.entries.cbegin(), detCache.entries.cend(), key, entryHashLess);
+	if (iter == detCache.entries.cend() || iter->hash != key.hash) {
+		// Not found.
+		return false;
+	}
+	if (iter->fileSize != static_cast<int64_t>(fileSize) ||
+	    iter->mtime != static_cast<int64_t>(mtime))
+	{
+		// File has changed.
+		return false;
+	}
+
+	*pClassHash = iter->classHash;
+	*pAddress = iter->address;
+	return true;
+}
+
+/**
+ * Store a detection result for a file.
+ * @param filename	[in] Filename. (UTF-8)
+ * @param fileSize	[in] File size.
+ * @param mtime		[in] File modification time.
+ * @param classHash	[in] Class name hash from hashClassName(), or 0 to remove the entry.
+ * @param address	[in] Header address.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int DetectCache::store(const string &filename, off64_t fileSize, time_t mtime,
+	uint32_t classHash, uint32_t address)
+{
+	if (!isEnabled()) {
+		return -ENOTSUP;
+	}
+
+	DetCacheEntry entry;
+	entry.hash = hashFilename(filename);
+	entry.fileSize = static_cast<int64_t>(fileSize);
+	entry.mtime = static_cast<int64_t>(mtime);
+	entry.classHash = classHash;
+	entry.address = address;
+
+	MutexLocker locker(detCache.mutex);
+	updateDetectCache();
+	if (detCache.filename.empty()) {
+		// No cache directory.
+		return -ENOENT;
+	}
+
+	// Update the in-memory cache.
+	auto iter = std::lower_bound(detCache.entries.begin(), detCache.entries.end(), entry, entryHashLess);
+	if (iter != detCache.entries.end() && iter->hash == entry.hash) {
+		if (classHash == 0) {
+			detCache.entries.erase(iter);
+		} else if (!memcmp(&(*iter), &entry, sizeof(entry))) {
+			// Already cached.
+			return 0;
+		} else {
+			*iter = entry;
+		}
+	} else if (classHash != 0) {
+		detCache.entries.insert(iter, entry);
+	} else {
+		// Not cached.
+		return 0;
+	}
+
+	// Append the entry to the file.
+	int ret = 0;
+	RpFile *file = new RpFile(detCache.filename, RpFile::FM_OPEN_WRITE);
+	if (!file->isOpen()) {
+		// Create a new file.
+		file->unref();
+		ret = FileSystem::rmkdir(detCache.filename);
+		if (ret != 0) {
+			return ret;
+		}
+		file = new RpFile(detCache.filename, RpFile::FM_CREATE_WRITE);
+		if (!file->isOpen()) {
+			ret = -file->lastError();
+			file->unref();
+			return (ret != 0 ? ret : -EIO);
+		}
+
+		DetCacheHeader header;
+		header.magic = cpu_to_le32(DETCACHE_MAGIC);
+		header.version = cpu_to_le32(DETCACHE_VERSION);
+		if (file->write(&header, sizeof(header)) != sizeof(header)) {
+			file->unref();
+			FileSystem::delete_file(detCache.filename);
+			return -EIO;
+		}
+	}
+
+	off64_t pos = file->size();
+	if (pos >= DETCACHE_MAX_SIZE) {
+		// File is too big. Rewrite it with only the live entries.
+		file->unref();
+		return compactDetectCache();
+	}
+	// Skip a partially-written record from an interrupted append.
+	pos -= (pos - static_cast<off64_t>(sizeof(DetCacheHeader))) % sizeof(DetCacheEntry);
+
+	// NOTE: If another process appends an entry at the same time,
+	// one of the entries may be lost. This only results in the
+	// file being detected normally the next time it's opened.
+	DetCacheEntry le_entry;
+	swapEntry(le_entry, entry);
+	file->seek(pos);
+	if (file->write(&le_entry, sizeof(le_entry)) != sizeof(le_entry)) {
+		ret = -file->lastError();
+		if (ret == 0) {
+			ret = -EIO;
+		}
+	}
+	file->unref();
+
+	// Our own changes don't need to be reloaded.
+	FileSystem::get_file_size_and_mtime(detCache.filename, &detCache.fileSize, &detCache.fileMtime);
+	return ret;
+}
+
+}
@@ -0,0 +1,113 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * DetectCache.hpp: Persistent RomData detection result cache.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DETECTCACHE_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DETECTCACHE_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+// C includes. (C++ namespace)
+#include <ctime>
+
+// C++ includes.
+#include <string>
+
+namespace LibRomData {
+
+/**
+ * RomData detection result cache.
+ *
+ * Records which RomData subclass RomDataFactory selected for a
+ * file, keyed on the filename, file size, and modification time.
+ * Repeat opens of the same file can construct that subclass
+ * directly instead of checking every subclass in turn.
+ *
+ * NOTE: Only the subclass and header address are stored. Subclasses
+ * that score the header in their constructors, e.g. SNES, NES, and
+ * MegaDrive, still do so when constructed from a cached result.
+ *
+ * The cache is stored in a single file in the cache directory.
+ *
+ * The cache is disabled by default. UI frontends enable it using
+ * setEnabled(). rpcli and the test suites don't use it, since their
+ * seccomp filters don't allow creating the cache directory or
+ * renaming the cache file.
+ */
+class DetectCache
+{
+	private:
+		DetectCache();
+		~DetectCache();
+	private:
+		RP_DISABLE_COPY(DetectCache)
+
+	public:
+		/**
+		 * Enable or disable the detection cache for this process.
+		 *
+		 * Disabling the cache discards the in-memory copy of the
+		 * cache file. It will be reloaded if the cache is re-enabled.
+		 *
+		 * @param enable True to enable; false to disable. (default is disabled)
+		 */
+		static void setEnabled(bool enable);
+
+		/**
+		 * Is the detection cache enabled for this process?
+		 * @return True if enabled; false if not.
+		 */
+		static bool isEnabled(void);
+
+		/**
+		 * Get the hash of a RomData subclass name.
+		 * @param className Class name.
+		 * @return Class name hash. (never 0)
+		 */
+		static uint32_t hashClassName(const char *className);
+
+		/**
+		 * Look up a file in the detection cache.
+		 * @param filename	[in] Filename. (UTF-8)
+		 * @param fileSize	[in] File size.
+		 * @param mtime		[in] File modification time.
+		 * @param pClassHash	[out] Class name hash.
+		 * @param pAddress	[out] Header address.
+		 * @return True if the file was found; false if not.
+		 */
+		static bool lookup(const std::string &filename, off64_t fileSize, time_t mtime,
+			uint32_t *pClassHash, uint32_t *pAddress);
+
+		/**
+		 * Store a detection result for a file.
+		 * @param filename	[in] Filename. (UTF-8)
+		 * @param fileSize	[in] File size.
+		 * @param mtime		[in] File modification time.
+		 * @param classHash	[in] Class name hash from hashClassName(), or 0 to remove the entry.
+		 * @param address	[in] Header address.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int store(const std::string &filename, off64_t fileSize, time_t mtime,
+			uint32_t classHash, uint32_t address);
+
+		/**
+		 * Remove a file from the detection cache.
+		 * @param filename	[in] Filename. (UTF-8)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static inline int remove(const std::string &filename)
+		{
+			return store(filename, 0, 0, 0, 0);
+		}
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DETECTCACHE_HPP__ */
@@ -11,6 +11,7 @@
 #include "DMG.hpp"
 #include "data/NintendoPublishers.hpp"
 #include "dmg_structs.h"
+#include "utils/RomChecksum.hpp"
 
 // librpbase, librpfile
 #include "librpbase/config/Config.hpp"
@@ -158,6 +159,29 @@ class DMGPrivate final : public RomDataPrivate
 		// GBX footer.
 		GBX_Footer gbxFooter;
 
+		// Copier header size. (0 or 512)
+		unsigned int copierHeaderSize;
+
+		/** Global checksum verification. (ROF_VERIFY) **/
+
+		// Calculated global checksum. (-1 if not verified)
+		int globalChecksum;
+		// Field index for the global checksum. (-1 if not loaded)
+		int fieldIdx_globalChecksum;
+
+		/**
+		 * Verify the global checksum.
+		 * This reads the entire ROM image.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int verifyGlobalChecksum(void);
+
+		/**
+		 * Get the global checksum field string.
+		 * @return Global checksum field string.
+		 */
+		string getGlobalChecksumString(void) const;
+
 		/**
 		 * Get the title and game ID.
 		 *
@@ -247,12 +271,71 @@ const DMGPrivate::dmg_cart_type DMGPrivate::dmg_cart_types_end[] = {
 DMGPrivate::DMGPrivate(DMG *q, IRpFile *file)
 	: super(q, file)
 	, romType(RomType::Unknown)
+	, copierHeaderSize(0)
+	, globalChecksum(-1)
+	, fieldIdx_globalChecksum(-1)
 {
 	// Clear the various structs.
 	memset(&romHeader, 0, sizeof(romHeader));
 	memset(&gbxFooter, 0, sizeof(gbxFooter));
 }
 
+/**
+ * Verify the global checksum.
+ * This reads the entire ROM image.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int DMGPrivate::verifyGlobalChecksum(void)
+{
+	if (!this->file) {
+		return -EBADF;
+	}
+
+	// The global checksum is a sum of all bytes in the ROM,
+	// excluding the checksum itself. Copier headers and
+	// the GBX footer aren't part of the ROM.
+	off64_t length = file->size() - copierHeaderSize;
+	if (gbxFooter.magic == cpu_to_be32(GBX_MAGIC)) {
+		const uint32_t footer_size = be32_to_cpu(gbxFooter.footer_size);
+		if (footer_size >= sizeof(gbxFooter) && footer_size < length) {
+			length -= footer_size;
+		} else {
+			length -= sizeof(gbxFooter);
+		}
+	}
+	if (length < 0x150) {
+		// ROM is too small.
+		return -EIO;
+	}
+
+	uint64_t sums[2] = {0, 0};
+	int ret = RomChecksum::sumFileBytes(file, copierHeaderSize, length, sums);
+	if (ret != 0) {
+		return ret;
+	}
+
+	const uint8_t *const pChecksum = reinterpret_cast<const uint8_t*>(&romHeader.rom_checksum);
+	globalChecksum = static_cast<uint16_t>(sums[0] + sums[1] - pChecksum[0] - pChecksum[1]);
+	return 0;
+}
+
+/**
+ * Get the global checksum field string.
+ * @return Global checksum field string.
+ */
+string DMGPrivate::getGlobalChecksumString(void) const
+{
+	const uint16_t rom_checksum = be16_to_cpu(romHeader.rom_checksum);
+	if (globalChecksum < 0) {
+		// Not verified.
+		return rp_sprintf("0x%04X", rom_checksum);
+	} else if (globalChecksum != rom_checksum) {
+		return rp_sprintf_p(C_("DMG", "0x%1$04X (INVALID; should be 0x%2$04X)"),
+			rom_checksum, static_cast<unsigned int>(globalChecksum));
+	}
+	return rp_sprintf(C_("DMG", "0x%04X (valid)"), rom_checksum);
+}
+
 /**
  * Get the system ID for the current ROM image.
  * @return System ID. (DMG_System bitfield)
@@ -588,6 +671,7 @@ DMG::DMG(IRpFile *file)
 			memcpy(&d->romHeader, &header.u8[0x100], sizeof(d->romHeader));
 		} else {
 			memcpy(&d->romHeader, &header.u8[0x300], sizeof(d->romHeader));
+			d->copierHeaderSize = 512;
 		}
 	} else {
 		UNREF_AND_NULL_NOCHK(d->file);
@@ -871,9 +955,9 @@ int DMG::loadFieldData(void)
 	const DMG_RomHeader *const romHeader = &d->romHeader;
 
 	// DMG ROM header:
-	// - 12 regular fields.
+	// - 13 regular fields.
 	// - 5 fields for the GBX footer.
-	d->fields->reserve(12+5);
+	d->fields->reserve(13+5);
 
 	// Reserve at least 3 tabs:
 	// DMG, GBX, GBS
@@ -1049,6 +1133,12 @@ int DMG::loadFieldData(void)
 			rp_sprintf(C_("DMG", "0x%02X (valid)"), checksum));
 	}
 
+	// Global checksum.
+	// This is only checked if the ROM image was verified.
+	d->fieldIdx_globalChecksum = static_cast<int>(d->fields->count());
+	d->fields->addField_string(C_("DMG", "Global Checksum"),
+		d->getGlobalChecksumString(), RomFields::STRF_MONOSPACE);
+
 	/** GBX footer. **/
 	const GBX_Footer *const gbxFooter = &d->gbxFooter;
 	if (gbxFooter->magic == cpu_to_be32(GBX_MAGIC)) {
@@ -1652,4 +1742,64 @@ int DMG::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) const
 	return 0;
 }
 
+/**
+ * Get the list of operations that can be performed on this ROM.
+ * Internal function; called by RomData::romOps().
+ * @return List of operations.
+ */
+vector<RomData::RomOp> DMG::romOps_int(void) const
+{
+	RP_D(const DMG);
+	vector<RomOp> ops;
+
+	// Verify the global checksum.
+	RomOp op(C_("DMG|RomOps", "&Verify Global Checksum"), RomOp::ROF_VERIFY);
+	if (d->isValid) {
+		op.flags |= RomOp::ROF_ENABLED;
+	}
+	ops.emplace_back(std::move(op));
+
+	return ops;
+}
+
+/**
+ * Perform a ROM operation.
+ * Internal function; called by RomData::doRomOp().
+ * @param id		[in] Operation index.
+ * @param pParams	[in/out] Parameters and results. (for e.g. UI updates)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int DMG::doRomOp_int(int id, RomOpParams *pParams)
+{
+	RP_D(DMG);
+	if (id != 0) {
+		pParams->status = -EINVAL;
+		pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
+		return -EINVAL;
+	}
+
+	// Verify the global checksum.
+	int ret = d->verifyGlobalChecksum();
+	pParams->status = ret;
+	if (ret != 0) {
+		pParams->msg = rp_sprintf(C_("DMG", "Unable to verify the global checksum: %s"),
+			strerror(-ret));
+		return ret;
+	}
+
+	if (d->globalChecksum == be16_to_cpu(d->romHeader.rom_checksum)) {
+		pParams->msg = C_("DMG", "The global checksum is valid.");
+	} else {
+		pParams->msg = rp_sprintf(C_("DMG", "The global checksum is INVALID. (should be 0x%04X)"),
+			static_cast<unsigned int>(d->globalChecksum));
+	}
+
+	// Update the field if the fields were already loaded.
+	if (!d->fields->empty() && d->fieldIdx_globalChecksum >= 0) {
+		d->fields->updateField_string(d->fieldIdx_globalChecksum, d->getGlobalChecksumString().c_str());
+		pParams->fieldIdx.emplace_back(d->fieldIdx_globalChecksum);
+	}
+	return 0;
+}
+
 }
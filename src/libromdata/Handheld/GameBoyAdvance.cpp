@@ -362,7 +362,7 @@ int GameBoyAdvance::loadFieldData(void)
 
 	// GBA ROM header
 	const GBA_RomHeader *const romHeader = &d->romHeader;
-	d->fields->reserve(7);	// Maximum of 7 fields.
+	d->fields->reserve(8);	// Maximum of 8 fields.
 
 	// Title
 	d->fields->addField_string(C_("RomData", "Title"),
@@ -387,6 +387,27 @@ int GameBoyAdvance::loadFieldData(void)
 	d->fields->addField_string_numeric(C_("RomData", "Revision"),
 		romHeader->rom_version, RomFields::Base::Dec, 2);
 
+	// Header checksum.
+	// This is a complement check of ROM addresses 0xA0-0xBC.
+	// NOTE: GBA ROMs don't have a checksum of the entire ROM.
+	uint8_t checksum = 0xE7; // -0x19
+	const uint8_t *const romHeader8 = reinterpret_cast<const uint8_t*>(romHeader);
+	for (unsigned int i = 0xA0; i < 0xBD; i++) {
+		checksum -= romHeader8[i];
+	}
+
+	const char *const checksum_title = C_("RomData", "Checksum");
+	if (checksum != romHeader->checksum) {
+		d->fields->addField_string(checksum_title,
+			rp_sprintf_p(C_("GameBoyAdvance", "0x%1$02X (INVALID; should be 0x%2$02X)"),
+				romHeader->checksum, checksum),
+			RomFields::STRF_MONOSPACE);
+	} else {
+		d->fields->addField_string(checksum_title,
+			rp_sprintf(C_("GameBoyAdvance", "0x%02X (valid)"), checksum),
+			RomFields::STRF_MONOSPACE);
+	}
+
 	// Entry point
 	const char *const entry_point_title = C_("GameBoyAdvance", "Entry Point");
 	switch (d->romType) {
@@ -75,6 +75,48 @@ Nintendo3DSPrivate::~Nintendo3DSPrivate()
 	UNREF(ncch_reader);
 }
 
+/**
+ * Get the address of the SMDH section if it's stored
+ * directly in the file. (3DSX extended header or CIA meta)
+ * @return SMDH section address, or 0 if it isn't stored directly in the file.
+ */
+uint32_t Nintendo3DSPrivate::getDirectSMDHAddress(void) const
+{
+	switch (romType) {
+		default:
+			break;
+
+		case RomType::_3DSX:
+			// 3DSX file. SMDH is included only if we have
+			// an extended header.
+			if ((headers_loaded & HEADER_3DSX) &&
+			    le32_to_cpu(mxh.hb3dsx_header.header_size) > N3DS_3DSX_STANDARD_HEADER_SIZE)
+			{
+				return le32_to_cpu(mxh.hb3dsx_header.smdh_offset);
+			}
+			break;
+
+		case RomType::CIA:
+			// CIA file. SMDH may be located at the end of the file
+			// in plaintext, if there's a meta section.
+			// FBI's meta section is 15,040 bytes, but the SMDH section
+			// only takes up 14,016 bytes.
+			if ((headers_loaded & HEADER_CIA) &&
+			    le32_to_cpu(mxh.cia_header.meta_size) >= (uint32_t)N3DS_SMDH_Section_Size)
+			{
+				return toNext64(le32_to_cpu(mxh.cia_header.header_size)) +
+				       toNext64(le32_to_cpu(mxh.cia_header.cert_chain_size)) +
+				       toNext64(le32_to_cpu(mxh.cia_header.ticket_size)) +
+				       toNext64(le32_to_cpu(mxh.cia_header.tmd_size)) +
+				       toNext64(static_cast<uint32_t>(le64_to_cpu(mxh.cia_header.content_size))) +
+				       (uint32_t)sizeof(N3DS_CIA_Meta_Header_t);
+			}
+			break;
+	}
+
+	return 0;
+}
+
 /**
  * Load the SMDH section.
  * @return 0 on success; non-zero on error.
@@ -88,9 +130,6 @@ int Nintendo3DSPrivate::loadSMDH(void)
 
 	// TODO: IRpFile implementation with offset/length, so we don't
 	// have to use both DiscReader and PartitionFile.
-	static const size_t N3DS_SMDH_Section_Size =
-		sizeof(N3DS_SMDH_Header_t) + sizeof(N3DS_SMDH_Icon_t);
-
 	IDiscReader *smdhReader = nullptr;
 	switch (romType) {
 		default:
@@ -131,20 +170,10 @@ int Nintendo3DSPrivate::loadSMDH(void)
 			}
 
 			// Do we have a meta section?
-			// FBI's meta section is 15,040 bytes, but the SMDH section
-			// only takes up 14,016 bytes.
 			if (le32_to_cpu(mxh.cia_header.meta_size) >= (uint32_t)N3DS_SMDH_Section_Size) {
-				// Determine the SMDH starting address.
-				uint32_t addr = toNext64(le32_to_cpu(mxh.cia_header.header_size)) +
-						toNext64(le32_to_cpu(mxh.cia_header.cert_chain_size)) +
-						toNext64(le32_to_cpu(mxh.cia_header.ticket_size)) +
-						toNext64(le32_to_cpu(mxh.cia_header.tmd_size)) +
-						toNext64(static_cast<uint32_t>(le64_to_cpu(mxh.cia_header.content_size))) +
-						(uint32_t)sizeof(N3DS_CIA_Meta_Header_t);
-
 				// Open the SMDH section.
 				// TODO: Verify that this works.
-				smdhReader = new DiscReader(this->file, addr, N3DS_SMDH_Section_Size);
+				smdhReader = new DiscReader(this->file, getDirectSMDHAddress(), N3DS_SMDH_Section_Size);
 				break;
 			}
 
@@ -210,17 +239,15 @@ int Nintendo3DSPrivate::loadSMDH(void)
 }
 
 /**
- * Load the specified NCCH header.
- * @param pOutNcchReader	[out] Output variable for the NCCHReader.
+ * Locate the specified NCCH.
+ * @param idx		[in] Content/partition index.
+ * @param pOffset	[out] NCCH offset.
+ * @param pLength	[out] NCCH length.
+ * @param pCiaReader	[out] CIAReader if the content uses CIA encryption; otherwise, nullptr. (caller must unref())
  * @return 0 on success; negative POSIX error code on error.
- * NOTE: Caller must check NCCHReader::isOpen().
  */
-int Nintendo3DSPrivate::loadNCCH(int idx, NCCHReader **pOutNcchReader)
+int Nintendo3DSPrivate::locateNCCH(int idx, off64_t *pOffset, uint32_t *pLength, CIAReader **pCiaReader)
 {
-	assert(pOutNcchReader != nullptr);
-	if (!pOutNcchReader)
-		return -EINVAL;
-
 	off64_t offset = 0;
 	uint32_t length = 0;
 	switch (romType) {
@@ -340,10 +367,36 @@ int Nintendo3DSPrivate::loadNCCH(int idx, NCCHReader **pOutNcchReader)
 		}
 	}
 
+	*pOffset = offset;
+	*pLength = length;
+	*pCiaReader = ciaReader;
+	return 0;
+}
+
+/**
+ * Load the specified NCCH header.
+ * @param idx			[in] Content/partition index.
+ * @param pOutNcchReader	[out] Output variable for the NCCHReader.
+ * @return 0 on success; negative POSIX error code on error.
+ * NOTE: Caller must check NCCHReader::isOpen().
+ */
+int Nintendo3DSPrivate::loadNCCH(int idx, NCCHReader **pOutNcchReader)
+{
+	assert(pOutNcchReader != nullptr);
+	if (!pOutNcchReader)
+		return -EINVAL;
+
+	off64_t offset;
+	uint32_t length;
+	CIAReader *ciaReader;
+	int ret = locateNCCH(idx, &offset, &length, &ciaReader);
+	if (ret != 0)
+		return ret;
+
 	// Create the NCCHReader.
 	// NOTE: We're not checking isOpen() here.
 	// That should be checked by the caller.
-	if (ciaReader && ciaReader->isOpen()) {
+	if (ciaReader) {
 		// This is an encrypted CIA.
 		// NOTE 2: CIAReader handles the offset, so we need to
 		// tell NCCHReader that the offset is 0.
@@ -358,6 +411,59 @@ int Nintendo3DSPrivate::loadNCCH(int idx, NCCHReader **pOutNcchReader)
 	return 0;
 }
 
+/**
+ * Read NCCH headers without creating NCCHReaders.
+ *
+ * This is used for the contents and partitions tables, which only
+ * need the headers. NCCH key lookup and ExeFS header decryption
+ * are skipped; CIA title key decryption is still done if needed.
+ *
+ * Headers that aren't CIA-encrypted are read using a single
+ * IRpFile::readv() call.
+ *
+ * @param count		[in] Number of contents/partitions, starting at index 0.
+ * @param pNcchHeaders	[out] Array of count NCCH headers, including the signatures.
+ * @param pRet		[out] Array of count return values: 0 on success; negative POSIX error code on error.
+ * NOTE: The headers are not validated; use NCCHReader::contentType_static().
+ */
+void Nintendo3DSPrivate::readNCCHHeaders(unsigned int count, N3DS_NCCH_Header_t *pNcchHeaders, int *pRet)
+{
+	vector<IRpFile::ReadVec> vec;
+	vec.reserve(count);
+
+	for (unsigned int i = 0; i < count; i++) {
+		off64_t offset;
+		uint32_t length;
+		CIAReader *ciaReader;
+		pRet[i] = locateNCCH(static_cast<int>(i), &offset, &length, &ciaReader);
+		if (pRet[i] != 0)
+			continue;
+
+		if (ciaReader) {
+			// CIAReader handles the offset.
+			const size_t size = ciaReader->seekAndRead(0, &pNcchHeaders[i], sizeof(pNcchHeaders[i]));
+			ciaReader->unref();
+			pRet[i] = (size == sizeof(pNcchHeaders[i]) ? 0 : -EIO);
+			continue;
+		}
+
+		// Read this header directly.
+		const IRpFile::ReadVec rv = {offset, &pNcchHeaders[i], sizeof(pNcchHeaders[i])};
+		vec.push_back(rv);
+	}
+	if (vec.empty() || file->readv(vec.data(), vec.size()) == 0)
+		return;
+
+	// At least one header couldn't be read.
+	// Read the headers individually to find out which ones.
+	for (const IRpFile::ReadVec &rv : vec) {
+		const unsigned int i = static_cast<unsigned int>(
+			static_cast<N3DS_NCCH_Header_t*>(rv.ptr) - pNcchHeaders);
+		const size_t size = file->seekAndRead(rv.pos, rv.ptr, rv.size);
+		pRet[i] = (size == rv.size ? 0 : -EIO);
+	}
+}
+
 /**
  * Create an NCCHReader for the primary content.
  * An NCCH reader is created as this->ncch_reader.
@@ -1263,6 +1369,14 @@ Nintendo3DS::Nintendo3DS(IRpFile *file)
 
 	// File is valid.
 	d->isValid = true;
+
+	// If the SMDH section is stored directly in the file,
+	// let the file start loading it now. (3DSX and CIA only;
+	// the ExeFS has to be parsed to find the icon otherwise.)
+	const uint32_t smdh_addr = d->getDirectSMDHAddress();
+	if (smdh_addr != 0) {
+		d->file->prefetch(smdh_addr, Nintendo3DSPrivate::N3DS_SMDH_Section_Size);
+	}
 }
 
 /**
@@ -1852,6 +1966,12 @@ int Nintendo3DS::loadFieldData(void)
 			};
 			v_partitions_names = RomFields::strArrayToVector_i18n(
 				"Nintendo3DS|CCI", cci_partitions_names, ARRAY_SIZE(cci_partitions_names));
+#ifdef ENABLE_DECRYPTION
+			if (!d->contentVerify.empty()) {
+				// Partitions were verified.
+				v_partitions_names->emplace_back("SHA-256");
+			}
+#endif /* ENABLE_DECRYPTION */
 		} else {
 			// eMMC (NAND dump)
 
@@ -1962,6 +2082,16 @@ int Nintendo3DS::loadFieldData(void)
 		auto vv_partitions = new RomFields::ListData_t();
 		vv_partitions->reserve(8);
 
+		// Read the partition NCCH headers.
+		// NOTE: Only the NCCH headers are needed here, so an
+		// NCCHReader isn't created for each partition.
+		unique_ptr<N3DS_NCCH_Header_t[]> part_ncch;
+		int part_ret[8];
+		if (d->romType != Nintendo3DSPrivate::RomType::eMMC) {
+			part_ncch.reset(new N3DS_NCCH_Header_t[8]);
+			d->readNCCHHeaders(8, part_ncch.get(), part_ret);
+		}
+
 		// Process the partition table.
 		for (unsigned int i = 0; i < 8; i++) {
 			const uint32_t length = le32_to_cpu(ncsd_header->partitions[i].length);
@@ -1969,10 +2099,12 @@ int Nintendo3DS::loadFieldData(void)
 				continue;
 
 			// Make sure the partition exists first.
-			NCCHReader *pNcch = nullptr;
-			int ret = d->loadNCCH(i, &pNcch);
-			if (ret == -ENOENT)
-				continue;
+			int ret = -ENOENT;
+			if (d->romType != Nintendo3DSPrivate::RomType::eMMC) {
+				ret = part_ret[i];
+				if (ret == -ENOENT)
+					continue;
+			}
 
 			const size_t vidx = vv_partitions->size();
 			vv_partitions->resize(vidx+1);
@@ -1989,7 +2121,8 @@ int Nintendo3DS::loadFieldData(void)
 
 			if (d->romType != Nintendo3DSPrivate::RomType::eMMC) {
 				const N3DS_NCCH_Header_NoSig_t *const part_ncch_header =
-					(pNcch && pNcch->isOpen() ? pNcch->ncchHeader() : nullptr);
+					(ret == 0 && part_ncch[i].hdr.magic == cpu_to_be32(N3DS_NCCH_HEADER_MAGIC)
+						? &part_ncch[i].hdr : nullptr);
 				if (part_ncch_header) {
 					// Encryption.
 					NCCHReader::CryptoType cryptoType = {nullptr, false, 0, false};
@@ -2047,7 +2180,12 @@ int Nintendo3DS::loadFieldData(void)
 			const off64_t length_bytes = static_cast<off64_t>(length) << d->media_unit_shift;
 			data_row.emplace_back(LibRpBase::formatFileSize(length_bytes));
 
-			UNREF(pNcch);
+#ifdef ENABLE_DECRYPTION
+			if (d->romType == Nintendo3DSPrivate::RomType::CCI && !d->contentVerify.empty()) {
+				// Partition hash.
+				d->addVerifyColumns(data_row, i, false);
+			}
+#endif /* ENABLE_DECRYPTION */
 		}
 
 		// Add the partitions list data.
@@ -2122,6 +2260,14 @@ int Nintendo3DS::loadFieldData(void)
 		auto vv_contents = new RomFields::ListData_t();
 		vv_contents->reserve(d->content_chunks.size());
 
+		// Read the content NCCH headers.
+		// NOTE: Only the NCCH headers are needed here, so an
+		// NCCHReader isn't created for each content.
+		const unsigned int content_count = static_cast<unsigned int>(d->content_chunks.size());
+		unique_ptr<N3DS_NCCH_Header_t[]> content_ncch_all(new N3DS_NCCH_Header_t[content_count]);
+		unique_ptr<int[]> content_ret(new int[content_count]);
+		d->readNCCHHeaders(content_count, content_ncch_all.get(), content_ret.get());
+
 		// Process the contents.
 		// TODO: Content types?
 		int i = 0;
@@ -2130,8 +2276,8 @@ int Nintendo3DS::loadFieldData(void)
 		     iter != content_chunks_cend; ++iter, ++i)
 		{
 			// Make sure the content exists first.
-			NCCHReader *pNcch = nullptr;
-			int ret = d->loadNCCH(i, &pNcch);
+			const N3DS_NCCH_Header_t &content_ncch = content_ncch_all[i];
+			int ret = content_ret[i];
 			if (ret == -ENOENT)
 				continue;
 
@@ -2146,14 +2292,14 @@ int Nintendo3DS::loadFieldData(void)
 			// TODO: Use content_chunk->index?
 			const N3DS_NCCH_Header_NoSig_t *content_ncch_header = nullptr;
 			const char *content_type = nullptr;
-			if (pNcch) {
-				if (pNcch->isOpen()) {
-					content_ncch_header = pNcch->ncchHeader();
+			if (ret == 0) {
+				if (content_ncch.hdr.magic == cpu_to_be32(N3DS_NCCH_HEADER_MAGIC)) {
+					content_ncch_header = &content_ncch.hdr;
 				}
 				// Get the content type regardless of whether or not
-				// the NCCH is open, since it might be a non-NCCH
+				// this is an NCCH, since it might be a non-NCCH
 				// content that we still recognize.
-				content_type = pNcch->contentType();
+				content_type = NCCHReader::contentType_static(&content_ncch);
 			}
 			if (!content_ncch_header) {
 				// Invalid content index, or this content isn't an NCCH.
@@ -2189,7 +2335,12 @@ int Nintendo3DS::loadFieldData(void)
 
 				// Content size.
 				data_row.emplace_back(LibRpBase::formatFileSize(be64_to_cpu(iter->size)));
-				UNREF(pNcch);
+#ifdef ENABLE_DECRYPTION
+				if (!d->contentVerify.empty()) {
+					// Content verification.
+					d->addVerifyColumns(data_row, i, true);
+				}
+#endif /* ENABLE_DECRYPTION */
 				continue;
 			}
 
@@ -2233,9 +2384,14 @@ int Nintendo3DS::loadFieldData(void)
 				le16_to_cpu(content_ncch_header->version)));
 
 			// Content size.
-			data_row.emplace_back(LibRpBase::formatFileSize(pNcch->partition_size()));
+			data_row.emplace_back(LibRpBase::formatFileSize(be64_to_cpu(iter->size)));
 
-			UNREF(pNcch);
+#ifdef ENABLE_DECRYPTION
+			if (!d->contentVerify.empty()) {
+				// Content verification.
+				d->addVerifyColumns(data_row, i, true);
+			}
+#endif /* ENABLE_DECRYPTION */
 		}
 
 		// Add the contents table.
@@ -2248,6 +2404,13 @@ int Nintendo3DS::loadFieldData(void)
 		};
 		vector<string> *const v_contents_names = RomFields::strArrayToVector_i18n(
 			"Nintendo3DS|CtNames", contents_names, ARRAY_SIZE(contents_names));
+#ifdef ENABLE_DECRYPTION
+		if (!d->contentVerify.empty()) {
+			// Contents were verified.
+			v_contents_names->emplace_back("SHA-256");
+			v_contents_names->emplace_back(C_("Nintendo3DS|CtNames", "Verified"));
+		}
+#endif /* ENABLE_DECRYPTION */
 
 		RomFields::AFLD_PARAMS params(RomFields::RFT_LISTDATA_SEPARATE_ROW, 0);
 		params.headers = v_contents_names;
@@ -2369,8 +2532,9 @@ int Nintendo3DS::loadFieldData(void)
 		// Permissions. These are technically part of the
 		// ExHeader, but we're using a separate tab because
 		// there's a lot of them.
-		d->fields->addTab(C_("Nintendo3DS", "Permissions"));
-		d->addFields_permissions();
+		// NOTE: The Permissions tab is only loaded when needed.
+		d->fields->addTab_deferred(C_("Nintendo3DS", "Permissions"),
+			[d](RomFields*) { return d->addFields_permissions(); });
 	}
 
 	// Finished reading the field data.
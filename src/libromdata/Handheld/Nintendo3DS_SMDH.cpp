@@ -20,6 +20,7 @@ using namespace LibRpTexture;
 
 // C++ STL classes.
 using std::array;
+using std::shared_ptr;
 using std::string;
 using std::vector;
 
@@ -471,9 +472,39 @@ int Nintendo3DS_SMDH::loadFieldData(void)
 	bool dedupe_titles = (smdhHeader->titles[N3DS_LANG_ENGLISH].desc_short[0] != cpu_to_le16('\0'));
 
 	// Title fields.
-	RomFields::StringMultiMap_t *const pMap_desc_short = new RomFields::StringMultiMap_t();
-	RomFields::StringMultiMap_t *const pMap_desc_long = new RomFields::StringMultiMap_t();
-	RomFields::StringMultiMap_t *const pMap_publisher = new RomFields::StringMultiMap_t();
+	// The strings are converted to UTF-8 when they're first accessed.
+	// NOTE: The converters need their own copy of the titles, since
+	// the fields may outlive this object if they're shared.
+	typedef array<N3DS_SMDH_Title_t, N3DS_LANG_MAX> titles_t;
+	static_assert(sizeof(titles_t) <= sizeof(smdhHeader->titles), "titles_t is too big");
+	shared_ptr<titles_t> titles = std::make_shared<titles_t>();
+	memcpy(titles->data(), smdhHeader->titles, sizeof(titles_t));
+
+	// Find the title for a language code.
+	auto findTitle = [titles](uint32_t lc) -> const N3DS_SMDH_Title_t* {
+		for (int langID = 0; langID < N3DS_LANG_MAX; langID++) {
+			if (NintendoLanguage::getNDSLanguageCode(langID, N3DS_LANG_MAX-1) == lc)
+				return &(*titles)[langID];
+		}
+		assert(!"Language code not found.");
+		return nullptr;
+	};
+
+	RomFields::StringMultiMap_t *const pMap_desc_short = new RomFields::StringMultiMap_t(
+		[findTitle](uint32_t lc) -> string {
+			const N3DS_SMDH_Title_t *const pTitle = findTitle(lc);
+			return (pTitle ? utf16le_to_utf8(pTitle->desc_short, ARRAY_SIZE(pTitle->desc_short)) : string());
+		});
+	RomFields::StringMultiMap_t *const pMap_desc_long = new RomFields::StringMultiMap_t(
+		[findTitle](uint32_t lc) -> string {
+			const N3DS_SMDH_Title_t *const pTitle = findTitle(lc);
+			return (pTitle ? utf16le_to_utf8(pTitle->desc_long, ARRAY_SIZE(pTitle->desc_long)) : string());
+		});
+	RomFields::StringMultiMap_t *const pMap_publisher = new RomFields::StringMultiMap_t(
+		[findTitle](uint32_t lc) -> string {
+			const N3DS_SMDH_Title_t *const pTitle = findTitle(lc);
+			return (pTitle ? utf16le_to_utf8(pTitle->publisher, ARRAY_SIZE(pTitle->publisher)) : string());
+		});
 	for (int langID = 0; langID < N3DS_LANG_MAX; langID++) {
 		// Check for empty strings first.
 		if (smdhHeader->titles[langID].desc_short[0] == 0 &&
@@ -509,22 +540,13 @@ int Nintendo3DS_SMDH::loadFieldData(void)
 			continue;
 
 		if (smdhHeader->titles[langID].desc_short[0] != cpu_to_le16('\0')) {
-			pMap_desc_short->insert(std::make_pair(lc,
-				utf16le_to_utf8(
-					smdhHeader->titles[langID].desc_short,
-					ARRAY_SIZE(smdhHeader->titles[langID].desc_short))));
+			pMap_desc_short->addLazy(lc);
 		}
 		if (smdhHeader->titles[langID].desc_long[0] != cpu_to_le16('\0')) {
-			pMap_desc_long->insert(std::make_pair(lc,
-				utf16le_to_utf8(
-					smdhHeader->titles[langID].desc_long,
-					ARRAY_SIZE(smdhHeader->titles[langID].desc_long))));
+			pMap_desc_long->addLazy(lc);
 		}
 		if (smdhHeader->titles[langID].publisher[0] != cpu_to_le16('\0')) {
-			pMap_publisher->insert(std::make_pair(lc,
-				utf16le_to_utf8(
-					smdhHeader->titles[langID].publisher,
-					ARRAY_SIZE(smdhHeader->titles[langID].publisher))));
+			pMap_publisher->addLazy(lc);
 		}
 	}
 
@@ -16,12 +16,27 @@
 // librpbase, librpfile
 using LibRpBase::RomData;
 using LibRpBase::RomFields;
+using LibRpBase::rp_sprintf;
 using LibRpFile::IRpFile;
 using LibRpFile::RpFile;
 
 // For sections delegated to other RomData subclasses.
 #include "NintendoDS.hpp"
 
+#ifdef ENABLE_DECRYPTION
+// librpbase, librpthreads
+# include "librpbase/crypto/SHA256Hash.hpp"
+# include "librpthreads/ThreadPool.hpp"
+using LibRpBase::SHA256Hash;
+using LibRpThreads::ThreadPool;
+
+// CIA title key decryption.
+# include "../disc/CIAReader.hpp"
+
+// C++ includes.
+# include <algorithm>
+#endif /* ENABLE_DECRYPTION */
+
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
@@ -31,6 +46,244 @@ namespace LibRomData {
 
 /** Nintendo3DSPrivate **/
 
+#ifdef ENABLE_DECRYPTION
+/**
+ * Verify the CIA contents or CCI partitions using SHA-256.
+ *
+ * Each content is hashed on a separate thread with its
+ * own file handle, so large contents are read in parallel.
+ * Results are stored in contentVerify.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int Nintendo3DSPrivate::verifyContents(void)
+{
+	if (!file || !file->isOpen()) {
+		// File isn't open.
+		return -EBADF;
+	}
+
+	// Content locations.
+	struct VerifyJob {
+		off64_t offset;		// Content offset
+		off64_t length;		// Content length
+		const uint8_t *sha256;	// Expected hash (nullptr if none)
+		uint16_t index;		// TMD content index
+		bool encrypted;		// Encrypted using the CIA title key
+	};
+	vector<VerifyJob> jobs;
+
+	switch (romType) {
+		case RomType::CIA: {
+			if (!(headers_loaded & HEADER_CIA) || loadTicketAndTMD() != 0) {
+				// Unable to load the ticket and TMD header.
+				return -EIO;
+			}
+
+			// Contents are stored in TMD order, aligned to 64 bytes.
+			jobs.reserve(content_chunks.size());
+			off64_t offset = mxh.content_start_addr;
+			for (const N3DS_Content_Chunk_Record_t &chunk : content_chunks) {
+				VerifyJob job;
+				job.offset = offset;
+				job.length = static_cast<off64_t>(be64_to_cpu(chunk.size));
+				job.sha256 = chunk.sha256;
+				job.index = be16_to_cpu(chunk.index);
+				job.encrypted = !!(chunk.type & cpu_to_be16(N3DS_CONTENT_CHUNK_ENCRYPTED));
+				jobs.push_back(job);
+				offset += toNext64(job.length);
+			}
+			break;
+		}
+
+		case RomType::CCI: {
+			if (!(headers_loaded & HEADER_NCSD)) {
+				// NCSD header is not loaded...
+				return -EIO;
+			}
+
+			// NOTE: The NCSD header doesn't have partition hashes,
+			// so the hashes are calculated but not verified.
+			jobs.reserve(ARRAY_SIZE(mxh.ncsd_header.partitions));
+			for (const auto &partition : mxh.ncsd_header.partitions) {
+				VerifyJob job;
+				job.offset = static_cast<off64_t>(le32_to_cpu(partition.offset)) << media_unit_shift;
+				job.length = static_cast<off64_t>(le32_to_cpu(partition.length)) << media_unit_shift;
+				job.sha256 = nullptr;
+				job.index = 0;
+				job.encrypted = false;
+				jobs.push_back(job);
+			}
+			break;
+		}
+
+		default:
+			// Only CIA and CCI can be verified.
+			return -ENOTSUP;
+	}
+
+	// Each content is read using its own file handle, so the
+	// contents can be read in parallel. If the file can't be
+	// reopened (e.g. it's compressed or not a local file),
+	// the contents are read sequentially using this->file.
+	const string filename = file->filename();
+	const bool parallel = (!filename.empty() && !file->isCompressed() &&
+		dynamic_cast<RpFile*>(file) != nullptr && jobs.size() > 1);
+	const unsigned int threadCount = (parallel
+		? std::min(static_cast<unsigned int>(jobs.size()), ThreadPool::cpuCount())
+		: 1);
+
+	vector<ContentVerify> results(jobs.size());
+	const N3DS_Ticket_t *const ticket = (romType == RomType::CIA ? &mxh.ticket : nullptr);
+
+	ThreadPool pool(threadCount);
+	pool.parallelFor(jobs.size(), [&](size_t idx) {
+		const VerifyJob &job = jobs[idx];
+		ContentVerify &cv = results[idx];
+		cv.status = VerifyStatus::Unknown;
+		memset(cv.sha256, 0, sizeof(cv.sha256));
+		if (job.length <= 0)
+			return;
+
+		IRpFile *jobFile;
+		if (parallel) {
+			jobFile = new RpFile(filename, RpFile::FM_OPEN_READ);
+			if (!jobFile->isOpen()) {
+				jobFile->unref();
+				cv.status = VerifyStatus::Error;
+				return;
+			}
+		} else {
+			jobFile = file;
+		}
+
+		// CIA title key encryption is handled by CIAReader.
+		// NOTE: CIAReader only supports 32-bit content lengths.
+		CIAReader *ciaReader = nullptr;
+		int ret = 0;
+		if (job.encrypted) {
+			if (job.length > static_cast<off64_t>(UINT32_MAX)) {
+				ret = -EIO;
+			} else {
+				ciaReader = new CIAReader(jobFile, job.offset,
+					static_cast<uint32_t>(job.length), ticket, job.index);
+				if (!ciaReader->isOpen()) {
+					// Unable to get the title key.
+					cv.status = VerifyStatus::NoKey;
+					ret = -EIO;
+				}
+			}
+		} else if (jobFile->seek(job.offset) != 0) {
+			ret = -EIO;
+		}
+
+		SHA256Hash hash;
+		if (ret == 0 && !hash.isUsable()) {
+			ret = -ENOTSUP;
+		}
+		if (ret == 0) {
+			// Read the content in large blocks.
+			static const size_t VERIFY_BUF_SIZE = 1024U*1024U;
+			unique_ptr<uint8_t[]> buf(new uint8_t[VERIFY_BUF_SIZE]);
+			for (off64_t remain = job.length; remain > 0; ) {
+				const size_t size = static_cast<size_t>(
+					std::min(remain, static_cast<off64_t>(VERIFY_BUF_SIZE)));
+				const size_t sz_read = (ciaReader
+					? ciaReader->read(buf.get(), size)
+					: jobFile->read(buf.get(), size));
+				if (sz_read != size) {
+					ret = -EIO;
+					break;
+				}
+				hash.process(buf.get(), size);
+				remain -= size;
+			}
+		}
+		if (ret == 0) {
+			ret = hash.getHash(cv.sha256, sizeof(cv.sha256));
+		}
+
+		if (ret == 0) {
+			if (job.sha256) {
+				cv.status = (!memcmp(cv.sha256, job.sha256, sizeof(cv.sha256))
+					? VerifyStatus::OK
+					: VerifyStatus::Failed);
+			} else {
+				cv.status = VerifyStatus::NoHash;
+			}
+		} else if (cv.status != VerifyStatus::NoKey) {
+			cv.status = VerifyStatus::Error;
+		}
+
+		UNREF(ciaReader);
+		if (parallel) {
+			jobFile->unref();
+		}
+	});
+
+	contentVerify = std::move(results);
+	return 0;
+}
+
+/**
+ * Add the content verification columns to a contents table row.
+ * @param data_row	[in,out] Row data.
+ * @param idx		[in] Index in contentVerify.
+ * @param showStatus	[in] If true, add a status column. (CIA only)
+ */
+void Nintendo3DSPrivate::addVerifyColumns(vector<string> &data_row, size_t idx, bool showStatus) const
+{
+	const VerifyStatus status = (idx < contentVerify.size()
+		? contentVerify[idx].status
+		: VerifyStatus::Unknown);
+
+	// SHA-256 hash.
+	if (status == VerifyStatus::OK || status == VerifyStatus::Failed || status == VerifyStatus::NoHash) {
+		char s_sha256[sizeof(contentVerify[idx].sha256)*2 + 1];
+		char *p = s_sha256;
+		for (uint8_t byte : contentVerify[idx].sha256) {
+			static const char hex_lookup[] = "0123456789abcdef";
+			*p++ = hex_lookup[byte >> 4];
+			*p++ = hex_lookup[byte & 0x0F];
+		}
+		*p = '\0';
+		data_row.emplace_back(s_sha256);
+	} else {
+		data_row.emplace_back();
+	}
+
+	if (!showStatus)
+		return;
+
+	// Verification status.
+	const char *s_status;
+	switch (status) {
+		default:
+		case VerifyStatus::Unknown:
+			s_status = C_("Nintendo3DS|Verify", "Unknown");
+			break;
+		case VerifyStatus::OK:
+			s_status = C_("Nintendo3DS|Verify", "OK");
+			break;
+		case VerifyStatus::Failed:
+			s_status = C_("Nintendo3DS|Verify", "Hash mismatch");
+			break;
+		case VerifyStatus::NoHash:
+			s_status = C_("Nintendo3DS|Verify", "No hash");
+			break;
+		case VerifyStatus::NoKey:
+			s_status = C_("Nintendo3DS|Verify", "Encryption key missing");
+			break;
+		case VerifyStatus::Error:
+			s_status = C_("Nintendo3DS|Verify", "Read error");
+			break;
+	}
+	data_row.emplace_back(s_status);
+}
+#endif /* ENABLE_DECRYPTION */
+
+/** Nintendo3DS **/
+
 /**
  * Get the list of operations that can be performed on this ROM.
  * Internal function; called by RomData::romOps().
@@ -58,6 +311,18 @@ vector<RomData::RomOp> Nintendo3DS::romOps_int(void) const
 	}
 
 	ops.emplace_back(std::move(op));
+
+#ifdef ENABLE_DECRYPTION
+	// Verify the contents. (CIA and CCI only)
+	RomOp op_verify(C_("Nintendo3DS|RomOps", "&Verify Contents"), RomOp::ROF_VERIFY);
+	if ((d->romType == Nintendo3DSPrivate::RomType::CIA && (d->headers_loaded & Nintendo3DSPrivate::HEADER_TMD)) ||
+	    (d->romType == Nintendo3DSPrivate::RomType::CCI && (d->headers_loaded & Nintendo3DSPrivate::HEADER_NCSD)))
+	{
+		op_verify.flags |= RomOp::ROF_ENABLED;
+	}
+	ops.emplace_back(std::move(op_verify));
+#endif /* ENABLE_DECRYPTION */
+
 	return ops;
 }
 
@@ -72,7 +337,41 @@ int Nintendo3DS::doRomOp_int(int id, RomOpParams *pParams)
 {
 	RP_D(Nintendo3DS);
 
-	// Currently only one ROM operation.
+#ifdef ENABLE_DECRYPTION
+	if (id == 1) {
+		// Verify the contents.
+		int ret = d->verifyContents();
+		pParams->status = ret;
+		if (ret != 0) {
+			pParams->msg = C_("Nintendo3DS", "Unable to verify the contents.");
+			return ret;
+		}
+
+		unsigned int failed = 0;
+		for (const auto &cv : d->contentVerify) {
+			if (cv.status != Nintendo3DSPrivate::VerifyStatus::OK &&
+			    cv.status != Nintendo3DSPrivate::VerifyStatus::NoHash &&
+			    cv.status != Nintendo3DSPrivate::VerifyStatus::Unknown)
+			{
+				failed++;
+			}
+		}
+		if (failed == 0) {
+			pParams->msg = C_("Nintendo3DS", "All contents were verified successfully.");
+		} else {
+			pParams->msg = rp_sprintf(NC_("Nintendo3DS",
+				"%u content failed verification.",
+				"%u contents failed verification.", failed), failed);
+		}
+
+		// NOTE: If the fields were already loaded, they won't
+		// have the verification columns. The status message
+		// has the overall result in that case.
+		return 0;
+	}
+#endif /* ENABLE_DECRYPTION */
+
+	// Extract the SRL.
 	if (id != 0) {
 		pParams->status = -EINVAL;
 		pParams->msg = C_("RomData", "ROM operation ID is invalid for this object.");
@@ -31,6 +31,7 @@ namespace LibRpFile {
 
 namespace LibRomData {
 
+class CIAReader;
 class NCCHReader;
 class Nintendo3DS_SMDH;
 class NintendoDS;
@@ -130,6 +131,29 @@ class Nintendo3DSPrivate final : public LibRpBase::RomDataPrivate
 		// Loaded by loadTicketAndTMD().
 		ao::uvector<N3DS_Content_Chunk_Record_t> content_chunks;
 
+#ifdef ENABLE_DECRYPTION
+		// Content verification status.
+		enum class VerifyStatus : uint8_t {
+			Unknown	= 0,	// Not verified
+			OK	= 1,	// SHA-256 hash matches the TMD
+			Failed	= 2,	// SHA-256 hash does not match the TMD
+			NoHash	= 3,	// No reference hash; SHA-256 hash was calculated
+			NoKey	= 4,	// Encrypted, and the keys aren't available
+			Error	= 5,	// I/O error
+		};
+
+		struct ContentVerify {
+			VerifyStatus status;
+			uint8_t sha256[32];
+		};
+
+		// Content verification results.
+		// - CIA: Indexes match content_chunks.
+		// - CCI: Indexes match the NCSD partition table.
+		// Empty if the contents haven't been verified.
+		std::vector<ContentVerify> contentVerify;
+#endif /* ENABLE_DECRYPTION */
+
 		// TODO: Move the pointers to the union?
 		// That requires careful memory management...
 
@@ -156,12 +180,33 @@ class Nintendo3DSPrivate final : public LibRpBase::RomDataPrivate
 			return (val + static_cast<T>(63)) & ~(static_cast<T>(63));
 		}
 
+		// SMDH section size. (header + icon)
+		static const size_t N3DS_SMDH_Section_Size =
+			sizeof(N3DS_SMDH_Header_t) + sizeof(N3DS_SMDH_Icon_t);
+
+		/**
+		 * Get the address of the SMDH section if it's stored
+		 * directly in the file. (3DSX extended header or CIA meta)
+		 * @return SMDH section address, or 0 if it isn't stored directly in the file.
+		 */
+		uint32_t getDirectSMDHAddress(void) const;
+
 		/**
 		 * Load the SMDH section.
 		 * @return 0 on success; non-zero on error.
 		 */
 		int loadSMDH(void);
 
+		/**
+		 * Locate the specified NCCH.
+		 * @param idx		[in] Content/partition index.
+		 * @param pOffset	[out] NCCH offset.
+		 * @param pLength	[out] NCCH length.
+		 * @param pCiaReader	[out] CIAReader if the content uses CIA encryption; otherwise, nullptr. (caller must unref())
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int locateNCCH(int idx, off64_t *pOffset, uint32_t *pLength, CIAReader **pCiaReader);
+
 		/**
 		 * Load the specified NCCH header.
 		 * @param idx			[in] Content/partition index.
@@ -179,6 +224,23 @@ class Nintendo3DSPrivate final : public LibRpBase::RomDataPrivate
 		 */
 		NCCHReader *loadNCCH(void);
 
+		/**
+		 * Read NCCH headers without creating NCCHReaders.
+		 *
+		 * This is used for the contents and partitions tables, which only
+		 * need the headers. NCCH key lookup and ExeFS header decryption
+		 * are skipped; CIA title key decryption is still done if needed.
+		 *
+		 * Headers that aren't CIA-encrypted are read using a single
+		 * IRpFile::readv() call.
+		 *
+		 * @param count		[in] Number of contents/partitions, starting at index 0.
+		 * @param pNcchHeaders	[out] Array of count NCCH headers, including the signatures.
+		 * @param pRet		[out] Array of count return values: 0 on success; negative POSIX error code on error.
+		 * NOTE: The headers are not validated; use NCCHReader::contentType_static().
+		 */
+		void readNCCHHeaders(unsigned int count, N3DS_NCCH_Header_t *pNcchHeaders, int *pRet);
+
 		/**
 		 * Get the NCCH header from the primary content.
 		 * This uses loadNCCH() to get the NCCH reader.
@@ -255,6 +317,27 @@ class Nintendo3DSPrivate final : public LibRpBase::RomDataPrivate
 		 * @return 0 on success; non-zero on error.
 		 */
 		int addFields_permissions(void);
+
+#ifdef ENABLE_DECRYPTION
+		/**
+		 * Verify the CIA contents or CCI partitions using SHA-256.
+		 *
+		 * Each content is hashed on a separate thread with its
+		 * own file handle, so large contents are read in parallel.
+		 * Results are stored in contentVerify.
+		 *
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int verifyContents(void);
+
+		/**
+		 * Add the content verification columns to a contents table row.
+		 * @param data_row	[in,out] Row data.
+		 * @param idx		[in] Index in contentVerify.
+		 * @param showStatus	[in] If true, add a status column. (CIA only)
+		 */
+		void addVerifyColumns(std::vector<std::string> &data_row, size_t idx, bool showStatus) const;
+#endif /* ENABLE_DECRYPTION */
 };
 
 }
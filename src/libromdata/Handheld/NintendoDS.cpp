@@ -20,8 +20,12 @@ using LibRpFile::IRpFile;
 using LibRpFile::RpFile;
 using namespace LibRpTexture;
 
+// librpthreads
+using LibRpThreads::MutexLocker;
+
 // C++ STL classes.
 using std::array;
+using std::shared_ptr;
 using std::string;
 using std::vector;
 
@@ -36,6 +40,7 @@ NintendoDSPrivate::NintendoDSPrivate(NintendoDS *q, IRpFile *file, bool cia)
 	: super(q, file)
 	, iconAnimData(nullptr)
 	, icon_first_frame(nullptr)
+	, icon_frame_count(0)
 	, romType(RomType::Unknown)
 	, romSize(0)
 	, secData(0)
@@ -48,21 +53,29 @@ NintendoDSPrivate::NintendoDSPrivate(NintendoDS *q, IRpFile *file, bool cia)
 	// Clear the various structs.
 	memset(&romHeader, 0, sizeof(romHeader));
 	memset(&nds_icon_title, 0, sizeof(nds_icon_title));
+
+	// The icon is decoded from nds_icon_title, which is
+	// read using readAt(), so it can be loaded while the
+	// fields are being loaded.
+	concurrentImageLoad = true;
 }
 
 NintendoDSPrivate::~NintendoDSPrivate()
 {
 	UNREF(iconAnimData);
+	UNREF(icon_first_frame);
 }
 
 /**
  * Load the icon/title data.
+ * This is safe to call from multiple threads.
  * @return 0 on success; negative POSIX error code on error.
  */
 int NintendoDSPrivate::loadIconTitleData(void)
 {
 	assert(this->file != nullptr);
 
+	MutexLocker iconTitleLock(iconTitleMutex);
 	if (nds_icon_title_loaded) {
 		// Icon/title data is already loaded.
 		return 0;
@@ -77,7 +90,7 @@ int NintendoDSPrivate::loadIconTitleData(void)
 	}
 
 	// Read the icon/title data.
-	size_t size = this->file->seekAndRead(icon_offset, &nds_icon_title, sizeof(nds_icon_title));
+	size_t size = readAt(icon_offset, &nds_icon_title, sizeof(nds_icon_title));
 
 	// Make sure we have the correct size based on the version.
 	if (size < sizeof(nds_icon_title.version)) {
@@ -114,8 +127,50 @@ int NintendoDSPrivate::loadIconTitleData(void)
 	return 0;
 }
 
+/**
+ * Decode a DSi animated icon frame.
+ * @param high_token High byte of the sequence token.
+ * @return Icon frame, or nullptr on error.
+ */
+rp_image *NintendoDSPrivate::decodeDSiIconFrame(uint8_t high_token) const
+{
+	// Token format: (bits)
+	// - 15:    V flip (1=yes, 0=no)
+	// - 14:    H flip (1=yes, 0=no)
+	// - 13-11: Palette index.
+	// - 10-8:  Bitmap index.
+	// - 7-0:   Frame duration. (units of 60 Hz)
+	const uint8_t bmp = (high_token & 7);
+	const uint8_t pal = (high_token >> 3) & 7;
+	return ImageDecoder::fromNDS_CI4(32, 32,
+		nds_icon_title.dsi_icon_data[bmp],
+		sizeof(nds_icon_title.dsi_icon_data[bmp]),
+		nds_icon_title.dsi_icon_pal[pal],
+		sizeof(nds_icon_title.dsi_icon_pal[pal]));
+}
+
+/**
+ * Get the flip operation for a DSi animated icon token.
+ * @param high_token High byte of the sequence token.
+ * @return Flip operation.
+ */
+static inline rp_image::FlipOp dsiIconFlipOp(uint8_t high_token)
+{
+	rp_image::FlipOp flipOp = rp_image::FLIP_NONE;
+	if (high_token & (1U << 6)) {
+		// H-flip
+		flipOp = rp_image::FLIP_H;
+	}
+	if (high_token & (1U << 7)) {
+		// V-flip
+		flipOp = static_cast<rp_image::FlipOp>(flipOp | rp_image::FLIP_V);
+	}
+	return flipOp;
+}
+
 /**
  * Load the ROM image's icon.
+ * Only the first frame of a DSi animated icon is decoded.
  * @return Icon, or nullptr on error.
  */
 const rp_image *NintendoDSPrivate::loadIcon(void)
@@ -135,11 +190,6 @@ const rp_image *NintendoDSPrivate::loadIcon(void)
 		return nullptr;
 	}
 
-	// Load the icon data.
-	// TODO: Only read the first frame unless specifically requested?
-	this->iconAnimData = new IconAnimData();
-	iconAnimData->count = 0;
-
 	// Check if a DSi animated icon is present.
 	// TODO: Some configuration option to return the standard
 	// NDS icon for the standard icon instead of the first frame
@@ -151,93 +201,138 @@ const rp_image *NintendoDSPrivate::loadIcon(void)
 		// or the animated icon sequence is invalid.
 
 		// Convert the NDS icon to rp_image.
-		iconAnimData->frames[0] = ImageDecoder::fromNDS_CI4(32, 32,
+		icon_first_frame = ImageDecoder::fromNDS_CI4(32, 32,
 			nds_icon_title.icon_data, sizeof(nds_icon_title.icon_data),
 			nds_icon_title.icon_pal,  sizeof(nds_icon_title.icon_pal));
-		iconAnimData->count = 1;
-	} else {
-		// Animated icon is present.
-
-		// Maximum number of combinations based on bitmap index,
-		// palette index, and flip bits is 256. We don't want to
-		// reserve 256 images, so we'll use a map to determine
-		// which combinations go to which bitmap.
-
-		// dsi_icon_seq is limited to 64, so there's still a maximum
-		// of 64 possible bitmaps.
-
-		// Index: High byte of token.
-		// Value: Bitmap index. (0xFF for unused)
-		array<uint8_t, 256> arr_bmpUsed;
-		arr_bmpUsed.fill(0xFF);
-
-		// Parse the icon sequence.
-		uint8_t bmp_idx = 0;
-		int seq_idx;
-		for (seq_idx = 0; seq_idx < ARRAY_SIZE(nds_icon_title.dsi_icon_seq); seq_idx++) {
-			const uint16_t seq = le16_to_cpu(nds_icon_title.dsi_icon_seq[seq_idx]);
-			const int delay = (seq & 0xFF);
-			if (delay == 0) {
-				// End of sequence.
-				break;
+		icon_frame_count = 1;
+		return icon_first_frame;
+	}
+
+	// Animated icon is present.
+	// Count the unique frames, but only decode the first one.
+	// The rest of the frames are decoded by loadIconAnimData().
+	bool tokenUsed[256] = {};
+	uint8_t frame_count = 0;
+	for (int seq_idx = 0; seq_idx < ARRAY_SIZE(nds_icon_title.dsi_icon_seq); seq_idx++) {
+		const uint16_t seq = le16_to_cpu(nds_icon_title.dsi_icon_seq[seq_idx]);
+		if ((seq & 0xFF) == 0) {
+			// End of sequence.
+			break;
+		}
+
+		const uint8_t high_token = (seq >> 8);
+		if (!tokenUsed[high_token]) {
+			tokenUsed[high_token] = true;
+			frame_count++;
+		}
+	}
+	icon_frame_count = frame_count;
+
+	const uint8_t high_token0 = (le16_to_cpu(nds_icon_title.dsi_icon_seq[0]) >> 8);
+	icon_first_frame = decodeDSiIconFrame(high_token0);
+	if (icon_first_frame && (high_token0 & (3U << 6))) {
+		// At least one flip bit is set.
+		icon_first_frame->flip_inplace(dsiIconFlipOp(high_token0));
+	}
+	return icon_first_frame;
+}
+
+/**
+ * Load the DSi animated icon.
+ * @return Animated icon data, or nullptr if the icon isn't animated.
+ */
+const IconAnimData *NintendoDSPrivate::loadIconAnimData(void)
+{
+	if (iconAnimData) {
+		// Animated icon has already been loaded.
+		return iconAnimData;
+	}
+
+	// Make sure the first frame is loaded.
+	if (!loadIcon() || icon_frame_count <= 1) {
+		// No icon, or the icon isn't animated.
+		return nullptr;
+	}
+
+	this->iconAnimData = new IconAnimData();
+
+	// Maximum number of combinations based on bitmap index,
+	// palette index, and flip bits is 256. We don't want to
+	// reserve 256 images, so we'll use a map to determine
+	// which combinations go to which bitmap.
+
+	// dsi_icon_seq is limited to 64, so there's still a maximum
+	// of 64 possible bitmaps.
+
+	// NOTE: IconAnimData doesn't support arbitrary combinations
+	// of palette and bitmap. As a workaround, we'll make each
+	// combination a unique bitmap, which means we have a maximum
+	// of 64 bitmaps.
+
+	// Index: High byte of token.
+	// Value: Bitmap index. (0xFF for unused)
+	array<uint8_t, 256> arr_bmpUsed;
+	arr_bmpUsed.fill(0xFF);
+
+	// Unflipped images, indexed by bitmap/palette combination.
+	// Flipped frames are created from these using rp_image::flip(),
+	// so each combination is only decoded once.
+	array<rp_image*, 64> arr_unflipped;
+	arr_unflipped.fill(nullptr);
+
+	// The first frame was already decoded by loadIcon().
+	const uint8_t high_token0 = (le16_to_cpu(nds_icon_title.dsi_icon_seq[0]) >> 8);
+	iconAnimData->frames[0] = icon_first_frame->ref();
+	arr_bmpUsed[high_token0] = 0;
+	if (!(high_token0 & (3U << 6))) {
+		arr_unflipped[high_token0] = icon_first_frame->ref();
+	}
+
+	// Parse the icon sequence.
+	uint8_t bmp_idx = 1;
+	int seq_idx;
+	for (seq_idx = 0; seq_idx < ARRAY_SIZE(nds_icon_title.dsi_icon_seq); seq_idx++) {
+		const uint16_t seq = le16_to_cpu(nds_icon_title.dsi_icon_seq[seq_idx]);
+		const int delay = (seq & 0xFF);
+		if (delay == 0) {
+			// End of sequence.
+			break;
+		}
+
+		const uint8_t high_token = (seq >> 8);
+		if (arr_bmpUsed[high_token] == 0xFF) {
+			// Not used yet. Create the bitmap.
+			const uint8_t combo = (high_token & 0x3F);
+			if (!arr_unflipped[combo]) {
+				arr_unflipped[combo] = decodeDSiIconFrame(high_token);
 			}
 
-			// Token format: (bits)
-			// - 15:    V flip (1=yes, 0=no) [TODO]
-			// - 14:    H flip (1=yes, 0=no) [TODO]
-			// - 13-11: Palette index.
-			// - 10-8:  Bitmap index.
-			// - 7-0:   Frame duration. (units of 60 Hz)
-
-			// NOTE: IconAnimData doesn't support arbitrary combinations
-			// of palette and bitmap. As a workaround, we'll make each
-			// combination a unique bitmap, which means we have a maximum
-			// of 64 bitmaps.
-			uint8_t high_token = (seq >> 8);
-			if (arr_bmpUsed[high_token] == 0xFF) {
-				// Not used yet. Create the bitmap.
-				const uint8_t bmp = (high_token & 7);
-				const uint8_t pal = (high_token >> 3) & 7;
-				rp_image *img = ImageDecoder::fromNDS_CI4(32, 32,
-					nds_icon_title.dsi_icon_data[bmp],
-					sizeof(nds_icon_title.dsi_icon_data[bmp]),
-					nds_icon_title.dsi_icon_pal[pal],
-					sizeof(nds_icon_title.dsi_icon_pal[pal]));
+			rp_image *img = arr_unflipped[combo];
+			if (img) {
 				if (high_token & (3U << 6)) {
 					// At least one flip bit is set.
-					rp_image::FlipOp flipOp = rp_image::FLIP_NONE;
-					if (high_token & (1U << 6)) {
-						// H-flip
-						flipOp = rp_image::FLIP_H;
-					}
-					if (high_token & (1U << 7)) {
-						// V-flip
-						flipOp = static_cast<rp_image::FlipOp>(flipOp | rp_image::FLIP_V);
-					}
-					rp_image *const flipimg = img->flip(flipOp);
-					img->unref();
-					img = flipimg;
+					img = img->flip(dsiIconFlipOp(high_token));
+				} else {
+					img = img->ref();
 				}
-				iconAnimData->frames[bmp_idx] = img;
-				arr_bmpUsed[high_token] = bmp_idx;
-				bmp_idx++;
 			}
-			iconAnimData->seq_index[seq_idx] = arr_bmpUsed[high_token];
-			iconAnimData->delays[seq_idx].numer = static_cast<uint16_t>(delay);
-			iconAnimData->delays[seq_idx].denom = 60;
-			iconAnimData->delays[seq_idx].ms = delay * 1000 / 60;
+			iconAnimData->frames[bmp_idx] = img;
+			arr_bmpUsed[high_token] = bmp_idx;
+			bmp_idx++;
 		}
-		iconAnimData->count = bmp_idx;
-		iconAnimData->seq_count = seq_idx;
+		iconAnimData->seq_index[seq_idx] = arr_bmpUsed[high_token];
+		iconAnimData->delays[seq_idx].numer = static_cast<uint16_t>(delay);
+		iconAnimData->delays[seq_idx].denom = 60;
+		iconAnimData->delays[seq_idx].ms = delay * 1000 / 60;
 	}
+	iconAnimData->count = bmp_idx;
+	iconAnimData->seq_count = seq_idx;
 
-	// NOTE: We're not deleting iconAnimData even if we only have
-	// a single icon because iconAnimData() will call loadIcon()
-	// if iconAnimData is nullptr.
-
-	// Return a pointer to the first frame.
-	icon_first_frame = iconAnimData->frames[iconAnimData->seq_index[0]];
-	return icon_first_frame;
+	// The frames hold their own references.
+	for (rp_image *img : arr_unflipped) {
+		UNREF(img);
+	}
+	return iconAnimData;
 }
 
 /**
@@ -264,18 +359,10 @@ NDS_Language_ID NintendoDSPrivate::getMaxSupportedLanguage(uint16_t version)
  */
 NDS_Language_ID NintendoDSPrivate::getLanguageID(void) const
 {
-	if (!nds_icon_title_loaded) {
-		// Attempt to load the icon/title data.
-		if (const_cast<NintendoDSPrivate*>(this)->loadIconTitleData() != 0) {
-			// Error loading the icon/title data.
-			return (NDS_Language_ID)-1;
-		}
-
-		// Make sure it was actually loaded.
-		if (!nds_icon_title_loaded) {
-			// Icon/title data was not loaded.
-			return (NDS_Language_ID)-1;
-		}
+	// Attempt to load the icon/title data.
+	if (const_cast<NintendoDSPrivate*>(this)->loadIconTitleData() != 0) {
+		// Error loading the icon/title data.
+		return (NDS_Language_ID)-1;
 	}
 
 	// Version number check is required for ZH and KO.
@@ -613,6 +700,13 @@ void NintendoDS::init(void)
 		return;
 	}
 
+	// The icon/title data is needed for nearly everything,
+	// so let the file start loading it now.
+	const uint32_t icon_offset = le32_to_cpu(d->romHeader.icon_offset);
+	if (icon_offset > 0x8000) {
+		d->file->prefetch(icon_offset, sizeof(d->nds_icon_title));
+	}
+
 	// Check the secure area status.
 	d->secData = d->checkNDSSecurityData();
 	d->secArea = d->checkNDSSecureArea();
@@ -867,11 +961,13 @@ uint32_t NintendoDS::imgpf(ImageType imageType) const
 	RP_D(const NintendoDS);
 	uint32_t ret = 0;
 	switch (imageType) {
-		case IMG_INT_ICON:
+		case IMG_INT_ICON: {
 			// Use nearest-neighbor scaling when resizing.
 			// Also, need to check if this is an animated icon.
+			// NOTE: Only the first frame is decoded here.
+			MutexLocker imageLock(const_cast<NintendoDSPrivate*>(d)->imageLoadMutex());
 			const_cast<NintendoDSPrivate*>(d)->loadIcon();
-			if (d->iconAnimData && d->iconAnimData->count > 1) {
+			if (d->icon_frame_count > 1) {
 				// Animated icon.
 				ret = IMGPF_RESCALE_NEAREST | IMGPF_ICON_ANIMATED;
 			} else {
@@ -879,6 +975,7 @@ uint32_t NintendoDS::imgpf(ImageType imageType) const
 				ret = IMGPF_RESCALE_NEAREST;
 			}
 			break;
+		}
 
 		default:
 			// GameTDB's Nintendo DS cover scans have alpha transparency.
@@ -964,19 +1061,34 @@ int NintendoDS::loadFieldData(void)
 	d->fields->addField_string(C_("RomData", "Title"),
 		latin1_to_utf8(romHeader->title, ARRAY_SIZE(romHeader->title)));
 
-	if (!d->nds_icon_title_loaded) {
-		// Attempt to load the icon/title data.
-		const_cast<NintendoDSPrivate*>(d)->loadIconTitleData();
-	}
-	if (d->nds_icon_title_loaded) {
+	// Attempt to load the icon/title data.
+	if (const_cast<NintendoDSPrivate*>(d)->loadIconTitleData() == 0) {
 		// Full title: Check if English is valid.
 		// If it is, we'll de-duplicate fields.
 		bool dedupe_titles = (d->nds_icon_title.title[NDS_LANG_ENGLISH][0] != cpu_to_le16(0));
 
 		// Full title field.
-		RomFields::StringMultiMap_t *const pMap_full_title = new RomFields::StringMultiMap_t();
+		// The strings are converted to UTF-8 when they're first accessed.
+		// NOTE: The converter needs its own copy of the titles, since
+		// the field may outlive this object if it's shared.
 		const NDS_Language_ID maxID = d->getMaxSupportedLanguage(
 			le16_to_cpu(d->nds_icon_title.version));
+		typedef array<array<char16_t, 128>, 8> titles_t;
+		static_assert(sizeof(titles_t) == sizeof(d->nds_icon_title.title), "titles_t is the wrong size");
+		shared_ptr<titles_t> titles = std::make_shared<titles_t>();
+		memcpy(titles->data(), d->nds_icon_title.title, sizeof(titles_t));
+
+		RomFields::StringMultiMap_t *const pMap_full_title = new RomFields::StringMultiMap_t(
+			[titles, maxID](uint32_t lc) -> string {
+				for (int langID = 0; langID <= maxID; langID++) {
+					if (NintendoLanguage::getNDSLanguageCode(langID, maxID) == lc) {
+						const auto &title = (*titles)[langID];
+						return utf16_to_utf8(title.data(), title.size());
+					}
+				}
+				assert(!"Language code not found.");
+				return string();
+			});
 		for (int langID = 0; langID <= maxID; langID++) {
 			// Check for empty strings first.
 			if (d->nds_icon_title.title[langID][0] == 0) {
@@ -1003,10 +1115,7 @@ int NintendoDS::loadFieldData(void)
 				continue;
 
 			if (d->nds_icon_title.title[langID][0] != cpu_to_le16('\0')) {
-				pMap_full_title->insert(std::make_pair(lc,
-					utf16_to_utf8(
-						d->nds_icon_title.title[langID],
-						ARRAY_SIZE(d->nds_icon_title.title[langID]))));
+				pMap_full_title->addLazy(lc);
 			}
 		}
 
@@ -1331,11 +1440,8 @@ int NintendoDS::loadMetaData(void)
 
 	// Title.
 	string s_title;
-	if (!d->nds_icon_title_loaded) {
-		// Attempt to load the icon/title data.
-		const_cast<NintendoDSPrivate*>(d)->loadIconTitleData();
-	}
-	if (d->nds_icon_title_loaded) {
+	// Attempt to load the icon/title data.
+	if (const_cast<NintendoDSPrivate*>(d)->loadIconTitleData() == 0) {
 		// Full title.
 		// TODO: Use the default LC if it's available.
 		// For now, default to English.
@@ -1415,25 +1521,11 @@ int NintendoDS::loadInternalImage(ImageType imageType, const rp_image **pImage)
 const IconAnimData *NintendoDS::iconAnimData(void) const
 {
 	RP_D(const NintendoDS);
-	if (!d->iconAnimData) {
-		// Load the icon.
-		if (!const_cast<NintendoDSPrivate*>(d)->loadIcon()) {
-			// Error loading the icon.
-			return nullptr;
-		}
-		if (!d->iconAnimData) {
-			// Still no icon...
-			return nullptr;
-		}
-	}
-
-	if (d->iconAnimData->count <= 1) {
-		// Not an animated icon.
-		return nullptr;
-	}
+	MutexLocker imageLock(const_cast<NintendoDSPrivate*>(d)->imageLoadMutex());
 
-	// Return the icon animation data.
-	return d->iconAnimData;
+	// Load the animated icon.
+	// NOTE: This returns nullptr if the icon isn't animated.
+	return const_cast<NintendoDSPrivate*>(d)->loadIconAnimData();
 }
 
 /**
@@ -555,13 +555,7 @@ int NintendoDS::doRomOp_int(int id, RomOpParams *pParams)
 					field->data.bitfield = d->secData;
 				}
 				if (d->fieldIdx_secArea >= 0) {
-					field = const_cast<RomFields::Field*>(d->fields->at(d->fieldIdx_secArea));
-					const char *const s_secArea = d->getNDSSecureAreaString();
-					if (field->data.str) {
-						const_cast<string*>(field->data.str)->assign(s_secArea);
-					} else {
-						field->data.str = new string(s_secArea);
-					}
+					d->fields->updateField_string(d->fieldIdx_secArea, d->getNDSSecureAreaString());
 				}
 			}
 
@@ -43,11 +43,16 @@ class NintendoDSPrivate final : public LibRpBase::RomDataPrivate
 		// Animated icon data.
 		// This class owns all of the icons in here, so we
 		// must delete all of them.
+		// NOTE: Only loaded by loadIconAnimData().
 		LibRpBase::IconAnimData *iconAnimData;
 
-		// Pointer to the first frame in iconAnimData.
+		// First frame of the icon.
 		// Used when showing a static icon.
-		const LibRpTexture::rp_image *icon_first_frame;
+		LibRpTexture::rp_image *icon_first_frame;
+
+		// Number of unique frames in the DSi animated icon.
+		// 1 if the icon isn't animated. (Set by loadIcon().)
+		uint8_t icon_frame_count;
 
 	public:
 		/** RomFields **/
@@ -116,6 +121,10 @@ class NintendoDSPrivate final : public LibRpBase::RomDataPrivate
 		NDS_IconTitleData nds_icon_title;
 		bool nds_icon_title_loaded;
 
+		// Protects nds_icon_title, since it's used by
+		// both the field loader and the icon loader.
+		LibRpThreads::Mutex iconTitleMutex;
+
 		// If true, this is an SRL in a 3DS CIA.
 		// Some fields shouldn't be displayed.
 		bool cia;
@@ -126,16 +135,31 @@ class NintendoDSPrivate final : public LibRpBase::RomDataPrivate
 
 		/**
 		 * Load the icon/title data.
+		 * This is safe to call from multiple threads.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		int loadIconTitleData(void);
 
+		/**
+		 * Decode a DSi animated icon frame.
+		 * @param high_token High byte of the sequence token.
+		 * @return Icon frame, or nullptr on error.
+		 */
+		LibRpTexture::rp_image *decodeDSiIconFrame(uint8_t high_token) const;
+
 		/**
 		 * Load the ROM image's icon.
+		 * Only the first frame of a DSi animated icon is decoded.
 		 * @return Icon, or nullptr on error.
 		 */
 		const LibRpTexture::rp_image *loadIcon(void);
 
+		/**
+		 * Load the DSi animated icon.
+		 * @return Animated icon data, or nullptr if the icon isn't animated.
+		 */
+		const LibRpBase::IconAnimData *loadIconAnimData(void);
+
 		/**
 		 * Get the title index.
 		 * The title that most closely matches the
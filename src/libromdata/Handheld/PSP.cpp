@@ -84,6 +84,14 @@ class PSPPrivate final : public LibRpBase::RomDataPrivate
 		 * @return RomData* on success; nullptr on error.
 		 */
 		RomData *openBootExe(void);
+
+		/**
+		 * Open a disc reader for a PSP disc image.
+		 * CISO-compressed images are decompressed.
+		 * @param file Disc image file.
+		 * @return IDiscReader (caller must unref()), or nullptr on error.
+		 */
+		static IDiscReader *openDiscReader(IRpFile *file);
 };
 
 /** PSPPrivate **/
@@ -179,6 +187,45 @@ RomData *PSPPrivate::openBootExe(void)
 	return nullptr;
 }
 
+/**
+ * Open a disc reader for a PSP disc image.
+ * CISO-compressed images are decompressed.
+ * @param file Disc image file.
+ * @return IDiscReader (caller must unref()), or nullptr on error.
+ */
+IDiscReader *PSPPrivate::openDiscReader(IRpFile *file)
+{
+	// UMD is based on the DVD specification and therefore only has 2048-byte sectors.
+	IDiscReader *discReader = nullptr;
+
+	// Check if this is a supported compressed disc image.
+	uint8_t header[256];
+	size_t size = file->seekAndRead(0, header, sizeof(header));
+	if (size != sizeof(header)) {
+		// Read error.
+		return nullptr;
+	}
+	if (CisoPspReader::isDiscSupported_static(header, sizeof(header)) >= 0) {
+		discReader = new CisoPspReader(file);
+		if (!discReader->isOpen()) {
+			// Not CISO.
+			UNREF_AND_NULL_NOCHK(discReader);
+		}
+	}
+
+	if (!discReader) {
+		// Not a supported compressed disc image.
+		// Try opening as uncompressed.
+		discReader = new DiscReader(file);
+	}
+
+	if (!discReader->isOpen()) {
+		// Error opening the DiscReader.
+		UNREF_AND_NULL_NOCHK(discReader);
+	}
+	return discReader;
+}
+
 /** PSP **/
 
 /**
@@ -208,41 +255,16 @@ PSP::PSP(IRpFile *file)
 		return;
 	}
 
-	// UMD is based on the DVD specification and therefore only has 2048-byte sectors.
-	IDiscReader *discReader = nullptr;
-
-	// Check if this is a supported compressed disc image.
-	uint8_t header[256];
-	d->file->rewind();
-	size_t size = d->file->read(header, sizeof(header));
-	if (size != sizeof(header)) {
-		// Read error.
-		UNREF_AND_NULL_NOCHK(d->file);
-		return;
-	}
-	if (CisoPspReader::isDiscSupported_static(header, sizeof(header)) >= 0) {
-		discReader = new CisoPspReader(d->file);
-		if (!discReader->isOpen()) {
-			// Not CISO.
-			UNREF_AND_NULL_NOCHK(discReader);
-		}
-	}
-
+	// Open the disc image.
+	IDiscReader *const discReader = PSPPrivate::openDiscReader(d->file);
 	if (!discReader) {
-		// Not a supported compressed disc image.
-		// Try opening as uncompressed.
-		discReader = new DiscReader(d->file);
-	}
-
-	if (!discReader->isOpen()) {
-		// Error opening the DiscReader.
-		UNREF(discReader);
+		// Error opening the disc image.
 		UNREF_AND_NULL_NOCHK(d->file);
 		return;
 	}
 
 	// Check the ISO PVD and system ID.
-	size = discReader->seekAndRead(ISO_PVD_ADDRESS_2048, &d->pvd, sizeof(d->pvd));
+	size_t size = discReader->seekAndRead(ISO_PVD_ADDRESS_2048, &d->pvd, sizeof(d->pvd));
 	if (size != sizeof(d->pvd)) {
 		UNREF(discReader);
 		UNREF_AND_NULL_NOCHK(d->file);
@@ -300,6 +322,23 @@ void PSP::close(void)
 	super::close();
 }
 
+/**
+ * Open a reader for the logical image data.
+ * This is used for whole-file checksums.
+ * @return IDiscReader (caller must unref()), or nullptr on error.
+ */
+IDiscReader *PSP::openDataReader(void)
+{
+	RP_D(PSP);
+	if (d->discReader) {
+		return d->discReader->ref();
+	}
+
+	// The disc reader was closed, but the file may
+	// have been reopened by RomData::calcChecksums().
+	return (d->file ? PSPPrivate::openDiscReader(d->file) : nullptr);
+}
+
 /** ROM detection functions. **/
 
 /**
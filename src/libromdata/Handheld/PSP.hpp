@@ -29,6 +29,7 @@ ROMDATA_DECL_CLOSE()
 ROMDATA_DECL_METADATA()
 ROMDATA_DECL_IMGSUPPORT()
 ROMDATA_DECL_IMGINT()
+ROMDATA_DECL_DATAREADER()
 ROMDATA_DECL_END()
 
 }
@@ -16,24 +16,19 @@ extern "C" {
 
 /*
  * Data
+ * Slicing-by-8 tables. crc16tab[0] is the byte-at-a-time table.
  */
-extern const uint16_t crc16tab[];
+extern const uint16_t crc16tab[8][256];
 
 /*
  * CalcCrc16
  * Does not perform final inversion.
  */
-static inline uint16_t CalcCrc16(uint8_t *data, size_t length, uint16_t crc
+uint16_t CalcCrc16(const uint8_t *data, size_t length, uint16_t crc
 #ifdef __cplusplus
 	= (uint16_t)~0U
 #endif /* __cplusplus */
-	)
-{
-	for (; length > 0; length--, data++) {
-		crc = (crc >> 8) ^ crc16tab[(crc ^ *data) & 0xFF];
-	}
-	return crc;
-}
+	);
 
 #ifdef __cplusplus
 }
@@ -14,7 +14,7 @@
 #include "ndscrypt.hpp"
 
 #include "byteswap.h"
-#include "nds_crc.hpp"	// TODO: Optimized versions?
+#include "nds_crc.hpp"
 
 // C includes.
 #include <stdint.h>
@@ -28,18 +28,17 @@
 #include "librpbase/crypto/MD5Hash.hpp"
 #include "librpfile/FileSystem.hpp"
 #include "librpfile/RpFile.hpp"
-#include "librpthreads/Mutex.hpp"
+#include "librpthreads/pthread_once.h"
 using namespace LibRpFile;
 using LibRpBase::MD5Hash;
-using LibRpThreads::Mutex;
-using LibRpThreads::MutexLocker;
 
 // C++ STL classes.
 using std::string;
 
 // Blowfish data.
 // This is loaded from ~/.config/rom-properties/nds-blowfish.bin.
-static Mutex blowfish_mutex;
+// Each file is loaded once using pthread_once(). After that,
+// the data is read-only and can be shared between threads.
 static const uint8_t blowfish_md5[3][16] = {
 	// nds-blowfish
 	{0xC0,0x8C,0x5A,0xFD,0x9C,0x6D,0x95,0x30,
@@ -53,35 +52,27 @@ static const uint8_t blowfish_md5[3][16] = {
 };
 static uint8_t blowfish_data[3][NDS_BLOWFISH_SIZE];
 
+// pthread_once() control variables and load results.
+static pthread_once_t blowfish_once_control[3] = {
+	PTHREAD_ONCE_INIT, PTHREAD_ONCE_INIT, PTHREAD_ONCE_INIT
+};
+static int blowfish_load_ret[3];
+
 /**
  * Load and verify a Blowfish file.
- * These must be present in order to use ndscrypt_secure_area().
+ *
+ * This function MUST be called using pthread_once().
+ *
  * @param bfkey Blowfish key ID.
  * @return 0 on success; negative POSIX error code, positive custom error code on error.
  */
-int ndscrypt_load_blowfish_bin(BlowfishKey bfkey)
+static int load_blowfish_bin_int(BlowfishKey bfkey)
 {
 	static const char *const filenames[] = {
 		"nds-blowfish.bin",
 		"dsi-blowfish.bin",
 		"dsi-devel-blowfish.bin",
 	};
-	assert(bfkey >= NDSCRYPT_BF_NDS);
-	assert(bfkey < NDSCRYPT_BF_MAX);
-	if (bfkey < NDSCRYPT_BF_NDS || bfkey >= NDSCRYPT_BF_MAX)
-		return -EINVAL;
-
-	if (blowfish_data[bfkey][0] != 0) {
-		// Blowfish data was already loaded.
-		return 0;
-	}
-
-	MutexLocker mutexLocker(blowfish_mutex);
-	// Verify again after the mutex is locked.
-	if (blowfish_data[bfkey][0] != 0) {
-		// Blowfish data was already loaded.
-		return 0;
-	}
 
 	// Get the filename.
 	string bin_filename = FileSystem::getConfigDirectory();
@@ -115,23 +106,22 @@ int ndscrypt_load_blowfish_bin(BlowfishKey bfkey)
 
 	// Read the file.
 	size_t size = f_blowfish->read(blowfish_data[bfkey], sizeof(blowfish_data[bfkey]));
-	f_blowfish->unref();
 	if (size != sizeof(blowfish_data[bfkey])) {
 		// Read error.
-		blowfish_data[bfkey][0] = 0;
 		int err = f_blowfish->lastError();
 		if (err == 0) {
 			err = EIO;
 		}
+		UNREF(f_blowfish);
 		return -err;
 	}
+	f_blowfish->unref();
 
 	// Verify the MD5.
 	uint8_t md5[16];
 	MD5Hash::calcHash(md5, sizeof(md5), blowfish_data[bfkey], sizeof(blowfish_data[bfkey]));
 	if (memcmp(md5, blowfish_md5[bfkey], sizeof(md5)) != 0) {
 		// MD5 is incorrect.
-		blowfish_data[bfkey][0] = 0;
 		return 2;
 	}
 
@@ -139,6 +129,50 @@ int ndscrypt_load_blowfish_bin(BlowfishKey bfkey)
 	return 0;
 }
 
+/**
+ * pthread_once() wrappers for load_blowfish_bin_int().
+ */
+static void load_nds_blowfish_bin(void)
+{
+	blowfish_load_ret[NDSCRYPT_BF_NDS] = load_blowfish_bin_int(NDSCRYPT_BF_NDS);
+}
+static void load_dsi_blowfish_bin(void)
+{
+	blowfish_load_ret[NDSCRYPT_BF_DSi] = load_blowfish_bin_int(NDSCRYPT_BF_DSi);
+}
+static void load_dsi_devel_blowfish_bin(void)
+{
+	blowfish_load_ret[NDSCRYPT_BF_DSi_DEVEL] = load_blowfish_bin_int(NDSCRYPT_BF_DSi_DEVEL);
+}
+
+/**
+ * Load and verify a Blowfish file.
+ * These must be present in order to use ndscrypt_secure_area().
+ *
+ * The file is only loaded once. The result is cached, so this
+ * is cheap to call from multiple threads.
+ *
+ * @param bfkey Blowfish key ID.
+ * @return 0 on success; negative POSIX error code, positive custom error code on error.
+ */
+int ndscrypt_load_blowfish_bin(BlowfishKey bfkey)
+{
+	static void (*const load_fns[])(void) = {
+		load_nds_blowfish_bin,
+		load_dsi_blowfish_bin,
+		load_dsi_devel_blowfish_bin,
+	};
+	static_assert(ARRAY_SIZE(load_fns) == NDSCRYPT_BF_MAX, "load_fns[] is out of sync with BlowfishKey");
+
+	assert(bfkey >= NDSCRYPT_BF_NDS);
+	assert(bfkey < NDSCRYPT_BF_MAX);
+	if (bfkey < NDSCRYPT_BF_NDS || bfkey >= NDSCRYPT_BF_MAX)
+		return -EINVAL;
+
+	pthread_once(&blowfish_once_control[bfkey], load_fns[bfkey]);
+	return blowfish_load_ret[bfkey];
+}
+
 // Encryption context.
 class NDSCrypt
 {
@@ -282,7 +316,7 @@ void NDSCrypt::init2(uint32_t *magic, uint32_t a[3])
 void NDSCrypt::init1(BlowfishKey bfkey)
 {
 	// FIXME: Not big-endian safe.
-	memcpy(m_card_hash, &blowfish_data[bfkey], 4*(1024 + 18));
+	memcpy(m_card_hash, blowfish_data[bfkey], 4*(1024 + 18));
 	m_keycode[0] = m_gamecode;
 	m_keycode[1] = m_gamecode >> 1;
 	m_keycode[2] = m_gamecode << 1;
@@ -474,15 +508,8 @@ int ndscrypt_encrypt_secure_area(uint8_t *pRom, size_t len, BlowfishKey bfkey)
 		return -EINVAL;
 
 	// Make sure the Blowfish data has been loaded.
-	if (bfkey == NDSCRYPT_BF_NDS) {
-		if (blowfish_data[NDSCRYPT_BF_NDS][0] != 0x99)
-			return -EIO;
-	} else {
-		// FIXME: Check if it's a development cartridge.
-		if (blowfish_data[NDSCRYPT_BF_DSi][0] != 0x59) {
-			return -EIO;
-		}
-	}
+	if (ndscrypt_load_blowfish_bin(bfkey) != 0)
+		return -EIO;
 
 	// Encrypt the Secure Area.
 	return encryptSecureArea(pRom, bfkey);
@@ -533,15 +560,8 @@ int ndscrypt_decrypt_secure_area(uint8_t *pRom, size_t len, BlowfishKey bfkey)
 		return -EINVAL;
 
 	// Make sure the Blowfish data has been loaded.
-	if (bfkey == NDSCRYPT_BF_NDS) {
-		if (blowfish_data[NDSCRYPT_BF_NDS][0] != 0x99)
-			return -EIO;
-	} else {
-		// FIXME: Check if it's a development cartridge.
-		if (blowfish_data[NDSCRYPT_BF_DSi][0] != 0x59) {
-			return -EIO;
-		}
-	}
+	if (ndscrypt_load_blowfish_bin(bfkey) != 0)
+		return -EIO;
 
 	// Decrypt the Secure Area.
 	return decryptSecureArea(pRom, bfkey);
@@ -10,6 +10,7 @@
 #include "ELF.hpp"
 #include "data/ELFData.hpp"
 #include "elf_structs.h"
+#include "utils/FileReadWindow.hpp"
 
 // librpbase, librpfile
 using namespace LibRpBase;
@@ -90,10 +91,15 @@ class ELFPrivate final : public RomDataPrivate
 			Elf64_Ehdr elf64;
 		} Elf_Header;
 
+		// Buffered read window for the header tables,
+		// notes, PT_INTERP, and PT_DYNAMIC.
+		FileReadWindow window;
+
 		// Header location and size.
 		struct hdr_info_t {
 			off64_t addr;
 			uint64_t size;
+			uint64_t align;
 		};
 
 		/**
@@ -115,6 +121,7 @@ class ELFPrivate final : public RomDataPrivate
 
 		// Section Header information.
 		bool hasCheckedSH;	// Have we checked section headers yet?
+		bool hasNotes;		// Were notes found in PT_NOTE segments?
 		string osVersion;	// Operating system version.
 
 		ao::uvector<uint8_t> build_id;	// GNU `ld` build ID. (raw data)
@@ -144,6 +151,21 @@ class ELFPrivate final : public RomDataPrivate
 				: __swab64(x);
 		}
 
+		/**
+		 * Parse a single ELF note.
+		 * @param nhdr	[in] Note header. (host-endian)
+		 * @param pName	[in] Note name.
+		 * @param pData	[in] Note descriptor.
+		 */
+		void parseNote(const Elf32_Nhdr *nhdr, const char *pName, const uint8_t *pData);
+
+		/**
+		 * Parse all notes in a PT_NOTE segment or SHT_NOTE section.
+		 * @param info Segment or section information.
+		 * @return 0 on success; non-zero on error.
+		 */
+		int parseNotes(const hdr_info_t &info);
+
 		/**
 		 * Check program headers.
 		 * @return 0 on success; non-zero on error.
@@ -168,10 +190,12 @@ class ELFPrivate final : public RomDataPrivate
 ELFPrivate::ELFPrivate(ELF *q, IRpFile *file)
 	: super(q, file)
 	, elfFormat(Elf_Format::Unknown)
+	, window(this->file)
 	, hasCheckedPH(false)
 	, isPie(false)
 	, isWiiU(false)
 	, hasCheckedSH(false)
+	, hasNotes(false)
 	, build_id_type(nullptr)
 {
 	// Clear the structs.
@@ -193,24 +217,257 @@ ELFPrivate::hdr_info_t ELFPrivate::readProgramHeader(const uint8_t *phbuf)
 		if (Elf_Header.primary.e_data == ELFDATAHOST) {
 			info.addr = phdr->p_offset;
 			info.size = phdr->p_filesz;
+			info.align = phdr->p_align;
 		} else {
 			info.addr = __swab64(phdr->p_offset);
 			info.size = __swab64(phdr->p_filesz);
+			info.align = __swab64(phdr->p_align);
 		}
 	} else {
 		const Elf32_Phdr *const phdr = reinterpret_cast<const Elf32_Phdr*>(phbuf);
 		if (Elf_Header.primary.e_data == ELFDATAHOST) {
 			info.addr = phdr->p_offset;
 			info.size = phdr->p_filesz;
+			info.align = phdr->p_align;
 		} else {
 			info.addr = __swab32(phdr->p_offset);
 			info.size = __swab32(phdr->p_filesz);
+			info.align = __swab32(phdr->p_align);
 		}
 	}
 
 	return info;
 }
 
+/**
+ * Parse a single ELF note.
+ * @param nhdr	[in] Note header. (host-endian)
+ * @param pName	[in] Note name.
+ * @param pData	[in] Note descriptor.
+ */
+void ELFPrivate::parseNote(const Elf32_Nhdr *nhdr, const char *pName, const uint8_t *pData)
+{
+	switch (nhdr->n_type) {
+		case NT_GNU_ABI_TAG:
+			// GNU ABI tag.
+			if (nhdr->n_namesz == 5 && !strcmp(pName, "SuSE")) {
+				// SuSE Linux
+				if (nhdr->n_descsz < 2) {
+					// Header is too small...
+					break;
+				}
+				osVersion = rp_sprintf("SuSE Linux %u.%u", pData[0], pData[1]);
+			} else if (nhdr->n_namesz == 4 && !strcmp(pName, ELF_NOTE_GNU)) {
+				// GNU system
+				if (nhdr->n_descsz < sizeof(uint32_t)*4) {
+					// Header is too small...
+					break;
+				}
+				uint32_t desc[4];
+				memcpy(desc, pData, sizeof(desc));
+
+				const uint32_t os_id = elf32_to_cpu(desc[0]);
+				static const char *const os_tbl[] = {
+					"Linux", "Hurd", "Solaris", "kFreeBSD", "kNetBSD"
+				};
+
+				const char *s_os;
+				if (os_id < ARRAY_SIZE(os_tbl)) {
+					s_os = os_tbl[os_id];
+				} else {
+					s_os = "<unknown>";
+				}
+
+				osVersion = rp_sprintf("GNU/%s %u.%u.%u",
+					s_os, elf32_to_cpu(desc[1]),
+					elf32_to_cpu(desc[2]), elf32_to_cpu(desc[3]));
+			} else if (nhdr->n_namesz == 7 && !strcmp(pName, "NetBSD")) {
+				// Check if the version number is valid.
+				// Older versions kept this as 199905.
+				// Newer versions use __NetBSD_Version__.
+				if (nhdr->n_descsz < sizeof(uint32_t)) {
+					// Header is too small...
+					break;
+				}
+
+				uint32_t desc;
+				memcpy(&desc, pData, sizeof(desc));
+				desc = elf32_to_cpu(desc);
+
+				if (desc > 100000000U) {
+					const uint32_t ver_patch = (desc / 100) % 100;
+					uint32_t ver_rel = (desc / 10000) % 100;
+					const uint32_t ver_min = (desc / 1000000) % 100;
+					const uint32_t ver_maj = desc / 100000000;
+					osVersion = rp_sprintf("NetBSD %u.%u", ver_maj, ver_min);
+					if (ver_rel == 0 && ver_patch != 0) {
+						osVersion += rp_sprintf(".%u", ver_patch);
+					} else if (ver_rel != 0) {
+						while (ver_rel > 26) {
+							osVersion += 'Z';
+							ver_rel -= 26;
+						}
+						osVersion += ('A' + ver_rel - 1);
+					}
+				} else {
+					// No version number.
+					osVersion = "NetBSD";
+				}
+			} else if (nhdr->n_namesz == 8 && !strcmp(pName, "FreeBSD")) {
+				if (nhdr->n_descsz < sizeof(uint32_t)) {
+					// Header is too small...
+					break;
+				}
+
+				uint32_t desc;
+				memcpy(&desc, pData, sizeof(desc));
+				desc = elf32_to_cpu(desc);
+
+				if (desc == 460002) {
+					osVersion = "FreeBSD 4.6.2";
+				} else if (desc < 460100) {
+					osVersion = rp_sprintf("FreeBSD %u.%u",
+						desc / 100000, desc / 10000 % 10);
+					if (desc / 1000 % 10 > 0) {
+						osVersion += rp_sprintf(".%u", desc / 1000 % 10);
+					}
+					if ((desc % 1000 > 0) || (desc % 100000 == 0)) {
+						osVersion += rp_sprintf(" (%u)", desc);
+					}
+				} else if (desc < 500000) {
+					osVersion = rp_sprintf("FreeBSD %u.%u",
+						desc / 100000, desc / 10000 % 10 + desc / 1000 % 10);
+					if (desc / 100 % 10 > 0) {
+						osVersion += rp_sprintf(" (%u)", desc);
+					} else if (desc / 10 % 10 > 0) {
+						osVersion += rp_sprintf(".%u", desc / 10 % 10);
+					}
+				} else {
+					osVersion = rp_sprintf("FreeBSD %u.%u",
+						desc / 100000, desc / 1000 % 100);
+					if ((desc / 100 % 10 > 0) || (desc % 100000 / 100 == 0)) {
+						osVersion += rp_sprintf(" (%u)", desc);
+					} else if (desc / 10 % 10 > 0) {
+						osVersion += rp_sprintf(".%u", desc / 10 % 10);
+					}
+				}
+			} else if (nhdr->n_namesz == 8 && !strcmp(pName, "OpenBSD")) {
+				osVersion = "OpenBSD";
+			} else if (nhdr->n_namesz == 10 && !strcmp(pName, "DragonFly")) {
+				if (nhdr->n_descsz < sizeof(uint32_t)) {
+					// Header is too small...
+					break;
+				}
+
+				uint32_t desc;
+				memcpy(&desc, pData, sizeof(desc));
+				desc = elf32_to_cpu(desc);
+
+				osVersion = rp_sprintf("DragonFlyBSD %u.%u.%u",
+					desc / 100000, desc / 10000 % 10, desc % 10000);
+			}
+			break;
+
+		case NT_GNU_BUILD_ID:
+			if (nhdr->n_namesz != 4 || strcmp(pName, ELF_NOTE_GNU) != 0) {
+				// Not a GNU note.
+				break;
+			}
+
+			// Build ID.
+			switch (nhdr->n_descsz) {
+				case 8:
+					build_id_type = "xxHash";
+					break;
+				case 16:
+					build_id_type = "md5/uuid";
+					break;
+				case 20:
+					build_id_type = "sha1";
+					break;
+				default:
+					build_id_type = nullptr;
+					break;
+			}
+
+			// Hexdump will be done when parsing the data.
+			build_id.resize(nhdr->n_descsz);
+			memcpy(build_id.data(), pData, nhdr->n_descsz);
+			break;
+
+		default:
+			break;
+	}
+}
+
+/**
+ * Parse all notes in a PT_NOTE segment or SHT_NOTE section.
+ * @param info Segment or section information.
+ * @return 0 on success; non-zero on error.
+ */
+int ELFPrivate::parseNotes(const hdr_info_t &info)
+{
+	// Sanity check: Notes must be 64 KB or less,
+	// and must be larger than sizeof(Elf32_Nhdr).
+	// NOTE: Elf32_Nhdr and Elf64_Nhdr are identical.
+	if (info.size < sizeof(Elf32_Nhdr) || info.size > 64*1024) {
+		// Out of range. Ignore it.
+		return 0;
+	}
+
+	const size_t size = static_cast<size_t>(info.size);
+	const uint8_t *const buf = window.get(info.addr, size);
+	if (!buf) {
+		// Seek and/or read error.
+		return -EIO;
+	}
+
+	// Notes are normally 4-byte aligned, but some
+	// (e.g. .note.gnu.property on 64-bit) are 8-byte aligned.
+	const unsigned int align = (info.align == 8 ? 8 : 4);
+
+	size_t pos = 0;
+	while (pos + sizeof(Elf32_Nhdr) <= size) {
+		Elf32_Nhdr nhdr;
+		memcpy(&nhdr, &buf[pos], sizeof(nhdr));
+		if (Elf_Header.primary.e_data != ELFDATAHOST) {
+			// Byteswap the fields.
+			nhdr.n_namesz = __swab32(nhdr.n_namesz);
+			nhdr.n_descsz = __swab32(nhdr.n_descsz);
+			nhdr.n_type   = __swab32(nhdr.n_type);
+		}
+		pos += sizeof(Elf32_Nhdr);
+
+		const size_t name_pos = pos;
+		if (nhdr.n_namesz > size - pos) {
+			// Out of range.
+			break;
+		}
+		pos = ALIGN_BYTES(align, pos + nhdr.n_namesz);
+		const size_t desc_pos = pos;
+		if (pos > size || nhdr.n_descsz > size - pos) {
+			// Out of range.
+			break;
+		}
+		pos = ALIGN_BYTES(align, pos + nhdr.n_descsz);
+
+		if (nhdr.n_namesz == 0 || nhdr.n_descsz == 0) {
+			// No name or description...
+			continue;
+		}
+
+		// The name must be NULL-terminated.
+		const char *const pName = reinterpret_cast<const char*>(&buf[name_pos]);
+		if (pName[nhdr.n_namesz - 1] != '\0') {
+			continue;
+		}
+
+		parseNote(&nhdr, pName, &buf[desc_pos]);
+	}
+
+	return 0;
+}
+
 /**
  * Check program headers.
  * @return 0 on success; non-zero on error.
@@ -232,7 +489,6 @@ int ELFPrivate::checkProgramHeaders(void)
 	off64_t e_phoff;
 	unsigned int e_phnum;
 	unsigned int phsize;
-	uint8_t phbuf[sizeof(Elf64_Phdr)];
 
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
 		e_phoff = static_cast<off64_t>(Elf_Header.elf64.e_phoff);
@@ -249,21 +505,23 @@ int ELFPrivate::checkProgramHeaders(void)
 		return 0;
 	}
 
-	int ret = file->seek(e_phoff);
-	if (ret != 0) {
-		// Seek error.
-		return ret;
+	// Read the entire program header table at once.
+	// The table is usually right after the ELF header,
+	// so it's normally already in the read window.
+	const uint8_t *phbuf = window.get(e_phoff, e_phnum * phsize);
+	if (!phbuf) {
+		// Seek and/or read error.
+		return -EIO;
 	}
 
-	// Read all of the program header entries.
+	// Find the relevant program headers.
+	// NOTE: The data is read afterwards, since reading
+	// may move the read window.
+	hdr_info_t pt_interp;
+	bool has_pt_interp = false;
+	vector<hdr_info_t> pt_notes;
 	const bool isHostEndian = (Elf_Header.primary.e_data == ELFDATAHOST);
-	for (; e_phnum > 0; e_phnum--) {
-		size_t size = file->read(phbuf, phsize);
-		if (size != phsize) {
-			// Read error.
-			break;
-		}
-
+	for (; e_phnum > 0; e_phnum--, phbuf += phsize) {
 		// Check the type.
 		uint32_t p_type;
 		memcpy(&p_type, phbuf, sizeof(p_type));
@@ -272,41 +530,12 @@ int ELFPrivate::checkProgramHeaders(void)
 		}
 
 		switch (p_type) {
-			case PT_INTERP: {
+			case PT_INTERP:
 				// If the file type is ET_DYN, this is a PIE executable.
 				isPie = (Elf_Header.primary.e_type == ET_DYN);
-
-				// Get the interpreter name.
-				hdr_info_t info = readProgramHeader(phbuf);
-
-				// Sanity check: Interpreter must be 256 characters or less.
-				// NOTE: Interpreter should be NULL-terminated.
-				if (info.size <= 256) {
-					char buf[256];
-					const off64_t prevoff = file->tell();
-					size = file->seekAndRead(info.addr, buf, info.size);
-					if (size != info.size) {
-						// Seek and/or read error.
-						return -EIO;
-					}
-					ret = file->seek(prevoff);
-					if (ret != 0) {
-						// Seek error.
-						return ret;
-					}
-
-					// Remove trailing NULLs.
-					while (info.size > 0 && buf[info.size-1] == 0) {
-						info.size--;
-					}
-
-					if (info.size > 0) {
-						interpreter.assign(buf, info.size);
-					}
-				}
-
+				pt_interp = readProgramHeader(phbuf);
+				has_pt_interp = true;
 				break;
-			}
 
 			case PT_DYNAMIC:
 				// Executable is dynamically linked.
@@ -314,11 +543,47 @@ int ELFPrivate::checkProgramHeaders(void)
 				pt_dynamic = readProgramHeader(phbuf);
 				break;
 
+			case PT_NOTE:
+				// Notes will be parsed below.
+				pt_notes.emplace_back(readProgramHeader(phbuf));
+				break;
+
 			default:
 				break;
 		}
 	}
 
+	// Get the interpreter name.
+	// Sanity check: Interpreter must be 256 characters or less.
+	// NOTE: Interpreter should be NULL-terminated.
+	if (has_pt_interp && pt_interp.size > 0 && pt_interp.size <= 256) {
+		const char *const buf = reinterpret_cast<const char*>(
+			window.get(pt_interp.addr, static_cast<size_t>(pt_interp.size)));
+		if (!buf) {
+			// Seek and/or read error.
+			return -EIO;
+		}
+
+		// Remove trailing NULLs.
+		size_t size = static_cast<size_t>(pt_interp.size);
+		while (size > 0 && buf[size-1] == 0) {
+			size--;
+		}
+
+		if (size > 0) {
+			interpreter.assign(buf, size);
+		}
+	}
+
+	// Parse the notes.
+	// If any PT_NOTE segments are present, the section headers
+	// don't need to be checked for SHT_NOTE sections.
+	for (const hdr_info_t &info : pt_notes) {
+		if (parseNotes(info) == 0) {
+			hasNotes = true;
+		}
+	}
+
 	// Program headers checked.
 	return 0;
 }
@@ -337,11 +602,18 @@ int ELFPrivate::checkSectionHeaders(void)
 	// Now checking...
 	hasCheckedSH = true;
 
+	if (hasNotes) {
+		// Notes were already found in PT_NOTE segments.
+		// Only notes are read from the section headers right now,
+		// so there's no need to read the section header table,
+		// which is usually at the end of the file.
+		return 0;
+	}
+
 	// Read the section headers.
 	off64_t e_shoff;
 	unsigned int e_shnum;
 	unsigned int shsize;
-	uint8_t shbuf[sizeof(Elf64_Shdr)];
 
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
 		e_shoff = static_cast<off64_t>(Elf_Header.elf64.e_shoff);
@@ -358,21 +630,19 @@ int ELFPrivate::checkSectionHeaders(void)
 		return 0;
 	}
 
-	int ret = file->seek(e_shoff);
-	if (ret != 0) {
-		// Seek error.
-		return ret;
+	// Read the entire section header table at once.
+	const uint8_t *shbuf = window.get(e_shoff, e_shnum * shsize);
+	if (!shbuf) {
+		// Seek and/or read error.
+		return -EIO;
 	}
 
-	// Read all of the section header entries.
+	// Find all SHT_NOTE sections.
+	// NOTE: The data is read afterwards, since reading
+	// may move the read window.
+	vector<hdr_info_t> sht_notes;
 	const bool isHostEndian = (Elf_Header.primary.e_data == ELFDATAHOST);
-	for (; e_shnum > 0; e_shnum--) {
-		size_t size = file->read(shbuf, shsize);
-		if (size != shsize) {
-			// Read error.
-			break;
-		}
-
+	for (; e_shnum > 0; e_shnum--, shbuf += shsize) {
 		// Check the type.
 		uint32_t s_type;
 		memcpy(&s_type, &shbuf[4], sizeof(s_type));
@@ -385,224 +655,39 @@ int ELFPrivate::checkSectionHeaders(void)
 			continue;
 
 		// Get the note address and size.
-		off64_t int_addr;
-		uint64_t int_size;
+		hdr_info_t info;
 		if (Elf_Header.primary.e_class == ELFCLASS64) {
 			const Elf64_Shdr *const shdr = reinterpret_cast<const Elf64_Shdr*>(shbuf);
-			if (Elf_Header.primary.e_data == ELFDATAHOST) {
-				int_addr = shdr->sh_offset;
-				int_size = shdr->sh_size;
+			if (isHostEndian) {
+				info.addr = shdr->sh_offset;
+				info.size = shdr->sh_size;
+				info.align = shdr->sh_addralign;
 			} else {
-				int_addr = __swab64(shdr->sh_offset);
-				int_size = __swab64(shdr->sh_size);
+				info.addr = __swab64(shdr->sh_offset);
+				info.size = __swab64(shdr->sh_size);
+				info.align = __swab64(shdr->sh_addralign);
 			}
 		} else {
 			const Elf32_Shdr *const shdr = reinterpret_cast<const Elf32_Shdr*>(shbuf);
-			if (Elf_Header.primary.e_data == ELFDATAHOST) {
-				int_addr = shdr->sh_offset;
-				int_size = shdr->sh_size;
+			if (isHostEndian) {
+				info.addr = shdr->sh_offset;
+				info.size = shdr->sh_size;
+				info.align = shdr->sh_addralign;
 			} else {
-				int_addr = __swab32(shdr->sh_offset);
-				int_size = __swab32(shdr->sh_size);
+				info.addr = __swab32(shdr->sh_offset);
+				info.size = __swab32(shdr->sh_size);
+				info.align = __swab32(shdr->sh_addralign);
 			}
 		}
+		sht_notes.emplace_back(info);
+	}
 
-		// Sanity check: Note must be 256 bytes or less,
-		// and must be greater than sizeof(Elf32_Nhdr).
-		// NOTE: Elf32_Nhdr and Elf64_Nhdr are identical.
-		if (int_size < sizeof(Elf32_Nhdr) || int_size > 256) {
-			// Out of range. Ignore it.
-			continue;
-		}
-
-		uint8_t buf[256];
-		const off64_t prevoff = file->tell();
-		size = file->seekAndRead(int_addr, buf, int_size);
-		if (size != int_size) {
-			// Seek and/or read error.
-			return -EIO;
-		}
-		ret = file->seek(prevoff);
-		if (ret != 0) {
-			// Seek error.
-			return ret;
-		}
-
-		// Parse the note.
-		Elf32_Nhdr *const nhdr = reinterpret_cast<Elf32_Nhdr*>(buf);
-		if (Elf_Header.primary.e_data != ELFDATAHOST) {
-			// Byteswap the fields.
-			nhdr->n_namesz = __swab32(nhdr->n_namesz);
-			nhdr->n_descsz = __swab32(nhdr->n_descsz);
-			nhdr->n_type   = __swab32(nhdr->n_type);
-		}
-
-		if (nhdr->n_namesz == 0 || nhdr->n_descsz == 0) {
-			// No name or description...
-			continue;
-		}
-
-		if (int_size < sizeof(Elf32_Nhdr) + nhdr->n_namesz + nhdr->n_descsz) {
-			// Section is too small.
-			continue;
-		}
-
-		const char *const pName = reinterpret_cast<const char*>(&buf[sizeof(Elf32_Nhdr)]);
-		const uint8_t *const pData = &buf[sizeof(Elf32_Nhdr) + nhdr->n_namesz];
-		switch (nhdr->n_type) {
-			case NT_GNU_ABI_TAG:
-				// GNU ABI tag.
-				if (nhdr->n_namesz == 5 && !strcmp(pName, "SuSE")) {
-					// SuSE Linux
-					if (nhdr->n_descsz < 2) {
-						// Header is too small...
-						break;
-					}
-					osVersion = rp_sprintf("SuSE Linux %u.%u", pData[0], pData[1]);
-				} else if (nhdr->n_namesz == 4 && !strcmp(pName, ELF_NOTE_GNU)) {
-					// GNU system
-					if (nhdr->n_descsz < sizeof(uint32_t)*4) {
-						// Header is too small...
-						break;
-					}
-					uint32_t desc[4];
-					memcpy(desc, pData, sizeof(desc));
-
-					const uint32_t os_id = elf32_to_cpu(desc[0]);
-					static const char *const os_tbl[] = {
-						"Linux", "Hurd", "Solaris", "kFreeBSD", "kNetBSD"
-					};
-
-					const char *s_os;
-					if (os_id < ARRAY_SIZE(os_tbl)) {
-						s_os = os_tbl[os_id];
-					} else {
-						s_os = "<unknown>";
-					}
-
-					osVersion = rp_sprintf("GNU/%s %u.%u.%u",
-						s_os, elf32_to_cpu(desc[1]),
-						elf32_to_cpu(desc[2]), elf32_to_cpu(desc[3]));
-				} else if (nhdr->n_namesz == 7 && !strcmp(pName, "NetBSD")) {
-					// Check if the version number is valid.
-					// Older versions kept this as 199905.
-					// Newer versions use __NetBSD_Version__.
-					if (nhdr->n_descsz < sizeof(uint32_t)) {
-						// Header is too small...
-						break;
-					}
-
-					uint32_t desc;
-					memcpy(&desc, pData, sizeof(desc));
-					desc = elf32_to_cpu(desc);
-
-					if (desc > 100000000U) {
-						const uint32_t ver_patch = (desc / 100) % 100;
-						uint32_t ver_rel = (desc / 10000) % 100;
-						const uint32_t ver_min = (desc / 1000000) % 100;
-						const uint32_t ver_maj = desc / 100000000;
-						osVersion = rp_sprintf("NetBSD %u.%u", ver_maj, ver_min);
-						if (ver_rel == 0 && ver_patch != 0) {
-							osVersion += rp_sprintf(".%u", ver_patch);
-						} else if (ver_rel != 0) {
-							while (ver_rel > 26) {
-								osVersion += 'Z';
-								ver_rel -= 26;
-							}
-							osVersion += ('A' + ver_rel - 1);
-						}
-					} else {
-						// No version number.
-						osVersion = "NetBSD";
-					}
-				} else if (nhdr->n_namesz == 8 && !strcmp(pName, "FreeBSD")) {
-					if (nhdr->n_descsz < sizeof(uint32_t)) {
-						// Header is too small...
-						break;
-					}
-
-					uint32_t desc;
-					memcpy(&desc, pData, sizeof(desc));
-					desc = elf32_to_cpu(desc);
-
-					if (desc == 460002) {
-						osVersion = "FreeBSD 4.6.2";
-					} else if (desc < 460100) {
-						osVersion = rp_sprintf("FreeBSD %u.%u",
-							desc / 100000, desc / 10000 % 10);
-						if (desc / 1000 % 10 > 0) {
-							osVersion += rp_sprintf(".%u", desc / 1000 % 10);
-						}
-						if ((desc % 1000 > 0) || (desc % 100000 == 0)) {
-							osVersion += rp_sprintf(" (%u)", desc);
-						}
-					} else if (desc < 500000) {
-						osVersion = rp_sprintf("FreeBSD %u.%u",
-							desc / 100000, desc / 10000 % 10 + desc / 1000 % 10);
-						if (desc / 100 % 10 > 0) {
-							osVersion += rp_sprintf(" (%u)", desc);
-						} else if (desc / 10 % 10 > 0) {
-							osVersion += rp_sprintf(".%u", desc / 10 % 10);
-						}
-					} else {
-						osVersion = rp_sprintf("FreeBSD %u.%u",
-							desc / 100000, desc / 1000 % 100);
-						if ((desc / 100 % 10 > 0) || (desc % 100000 / 100 == 0)) {
-							osVersion += rp_sprintf(" (%u)", desc);
-						} else if (desc / 10 % 10 > 0) {
-							osVersion += rp_sprintf(".%u", desc / 10 % 10);
-						}
-					}
-				} else if (nhdr->n_namesz == 8 && !strcmp(pName, "OpenBSD")) {
-					osVersion = "OpenBSD";
-				} else if (nhdr->n_namesz == 10 && !strcmp(pName, "DragonFly")) {
-					if (nhdr->n_descsz < sizeof(uint32_t)) {
-						// Header is too small...
-						break;
-					}
-
-					uint32_t desc;
-					memcpy(&desc, pData, sizeof(desc));
-					desc = elf32_to_cpu(desc);
-
-					osVersion = rp_sprintf("DragonFlyBSD %u.%u.%u",
-						desc / 100000, desc / 10000 % 10, desc % 10000);
-				}
-				break;
-
-			case NT_GNU_BUILD_ID:
-				if (nhdr->n_namesz != 4 || strcmp(pName, ELF_NOTE_GNU) != 0) {
-					// Not a GNU note.
-					break;
-				}
-
-				// Build ID.
-				switch (nhdr->n_descsz) {
-					case 8:
-						build_id_type = "xxHash";
-						break;
-					case 16:
-						build_id_type = "md5/uuid";
-						break;
-					case 20:
-						build_id_type = "sha1";
-						break;
-					default:
-						build_id_type = nullptr;
-						break;
-				}
-
-				// Hexdump will be done when parsing the data.
-				build_id.resize(nhdr->n_descsz);
-				memcpy(build_id.data(), pData, nhdr->n_descsz);
-				break;
-
-			default:
-				break;
-		}
+	// Parse the notes.
+	for (const hdr_info_t &info : sht_notes) {
+		parseNotes(info);
 	}
 
-	// Program headers checked.
+	// Section headers checked.
 	return 0;
 }
 
@@ -626,10 +711,9 @@ int ELFPrivate::addPtDynamicFields(void)
 	}
 
 	// Read the header.
-	const unsigned int sz_to_read = static_cast<unsigned int>(pt_dynamic.size);
-	unique_ptr<uint8_t[]> pt_dyn_buf(new uint8_t[sz_to_read]);
-	size_t size = file->seekAndRead(pt_dynamic.addr, pt_dyn_buf.get(), sz_to_read);
-	if (size != sz_to_read) {
+	const size_t size = static_cast<size_t>(pt_dynamic.size);
+	const uint8_t *const pt_dyn_buf = window.get(pt_dynamic.addr, size);
+	if (!pt_dyn_buf) {
 		// Read error.
 		return -3;
 	}
@@ -642,7 +726,7 @@ int ELFPrivate::addPtDynamicFields(void)
 	// TODO: DT_RPATH/DT_RUNPATH
 	// Requires string table parsing too?
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
-		const Elf64_Dyn *phdr = reinterpret_cast<const Elf64_Dyn*>(pt_dyn_buf.get());
+		const Elf64_Dyn *phdr = reinterpret_cast<const Elf64_Dyn*>(pt_dyn_buf);
 		const Elf64_Dyn *const phdr_end = phdr + (size / sizeof(*phdr));
 		// TODO: Don't allow duplicates?
 		for (; phdr < phdr_end; phdr++) {
@@ -661,7 +745,7 @@ int ELFPrivate::addPtDynamicFields(void)
 			}
 		}
 	} else {
-		const Elf32_Dyn *phdr = reinterpret_cast<const Elf32_Dyn*>(pt_dyn_buf.get());
+		const Elf32_Dyn *phdr = reinterpret_cast<const Elf32_Dyn*>(pt_dyn_buf);
 		const Elf32_Dyn *const phdr_end = phdr + (size / sizeof(*phdr));
 		for (; phdr < phdr_end; phdr++) {
 			Elf32_Sword d_tag = elf32_to_cpu(phdr->d_tag);
@@ -763,8 +847,10 @@ ELF::ELF(IRpFile *file)
 	// Assume this is a 64-bit ELF executable and read a 64-bit header.
 	// 32-bit executables have a smaller header, but they should have
 	// more data than just the header.
-	d->file->rewind();
-	size_t size = d->file->read(&d->Elf_Header, sizeof(d->Elf_Header));
+	// NOTE: This is read through the read window, which also
+	// loads the program header table, PT_INTERP, and notes in
+	// the same read for most executables.
+	size_t size = d->window.read(0, &d->Elf_Header, sizeof(d->Elf_Header));
 	if (size != sizeof(d->Elf_Header)) {
 		UNREF_AND_NULL_NOCHK(d->file);
 		return;
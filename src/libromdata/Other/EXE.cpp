@@ -513,6 +513,10 @@ EXE::EXE(IRpFile *file)
 					break;
 			}
 		}
+
+		// The .rsrc section is needed for the icon and version
+		// information, so let the file start loading it now.
+		d->prefetchPEResources();
 	} else if (d->hdr.ne.sig == cpu_to_be16('NE') /* 'NE' */) {
 		// New Executable.
 		d->exeType = EXEPrivate::ExeType::NE;
@@ -887,6 +891,17 @@ int EXE::loadFieldData(void)
 		d->addFields_MZ();
 	}
 
+#ifdef ENABLE_XML
+	if (d->exeType == EXEPrivate::ExeType::PE ||
+	    d->exeType == EXEPrivate::ExeType::PE32PLUS)
+	{
+		// Add the manifest tab if the manifest is present.
+		// NOTE: This is a deferred tab, so it must be added last.
+		// TODO: Support external manifests, e.g. program.exe.manifest?
+		d->addFields_PE_Manifest();
+	}
+#endif /* ENABLE_XML */
+
 	// Finished reading the field data.
 	return static_cast<int>(d->fields->count());
 }
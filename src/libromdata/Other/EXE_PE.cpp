@@ -12,8 +12,9 @@
 #include "data/EXEData.hpp"
 #include "disc/PEResourceReader.hpp"
 
-// librpbase
+// librpbase, librpfile
 using namespace LibRpBase;
+using LibRpFile::IRpFile;
 
 // C++ STL classes.
 using std::string;
@@ -124,6 +125,24 @@ uint32_t EXEPrivate::pe_vaddr_to_paddr(uint32_t vaddr, uint32_t size)
 	return 0;
 }
 
+/**
+ * Find a PE section by name.
+ * pe_sections must be loaded.
+ * @param name Section name.
+ * @return Section header, or nullptr if not found.
+ */
+const IMAGE_SECTION_HEADER *EXEPrivate::findPESection(const char *name) const
+{
+	// Sections such as .rsrc are usually closer to the end
+	// of the section list, so search back to front.
+	auto iter = std::find_if(pe_sections.crbegin(), pe_sections.crend(),
+		[name](const IMAGE_SECTION_HEADER &section) -> bool {
+			return !strncmp(section.Name, name, sizeof(section.Name));
+		}
+	);
+	return (iter != pe_sections.crend() ? &(*iter) : nullptr);
+}
+
 /**
  * Load the top-level PE resource directory.
  * @return 0 on success; negative POSIX error code on error. (-ENOENT if not found)
@@ -157,20 +176,12 @@ int EXEPrivate::loadPEResourceTypes(void)
 	// data directory entry IMAGE_DATA_DIRECTORY_RESOURCE_TABLE?
 
 	// Find the .rsrc section.
-	// .rsrc is usually closer to the end of the section list,
-	// so search back to front.
-	auto iter = std::find_if(pe_sections.crbegin(), pe_sections.crend(),
-		[](const IMAGE_SECTION_HEADER &section) -> bool {
-			return !strcmp(section.Name, ".rsrc");
-		}
-	);
-	if (iter == pe_sections.crend()) {
+	const IMAGE_SECTION_HEADER *const rsrc = findPESection(".rsrc");
+	if (!rsrc) {
 		// No .rsrc section.
 		return -ENOENT;
 	}
 
-	const IMAGE_SECTION_HEADER *rsrc = &(*iter);
-
 	// Load the resources using PEResourceReader.
 	// NOTE: .rsrc address and size are validated by PEResourceReader.
 	rsrcReader = new PEResourceReader(file,
@@ -188,6 +199,36 @@ int EXEPrivate::loadPEResourceTypes(void)
 	return 0;
 }
 
+/**
+ * Hint that the PE resource directory will be read soon.
+ * This lets the file start loading it while the
+ * rest of the headers are being parsed.
+ */
+void EXEPrivate::prefetchPEResources(void)
+{
+	// Make sure the section table is loaded.
+	if (pe_sections.empty()) {
+		if (loadPESectionTable() != 0) {
+			// Unable to load the section table.
+			return;
+		}
+	}
+
+	const IMAGE_SECTION_HEADER *const rsrc = findPESection(".rsrc");
+	if (!rsrc) {
+		// No .rsrc section.
+		return;
+	}
+
+	// Only prefetch the beginning of the section.
+	// The resource directory is located there, and the
+	// icons and version information are usually nearby.
+	// Large .rsrc sections may contain data that's never read.
+	static const uint32_t RSRC_PREFETCH_MAX = 256U*1024U;
+	file->prefetch(le32_to_cpu(rsrc->PointerToRawData),
+		std::min<uint32_t>(le32_to_cpu(rsrc->SizeOfRawData), RSRC_PREFETCH_MAX));
+}
+
 /**
  * Find the runtime DLL. (PE version)
  * @param refDesc String to store the description.
@@ -269,9 +310,6 @@ int EXEPrivate::findPERuntimeDLL(string &refDesc, string &refLink)
 	// Set containing all of the DLL name VAs.
 	unordered_set<uint32_t> set_dll_vaddrs;
 
-	// Find the lowest and highest DLL name VAs in the import directory table.
-	uint32_t dll_vaddr_low = ~0U;
-	uint32_t dll_vaddr_high = 0U;
 	const IMAGE_IMPORT_DIRECTORY *pImpDirTbl = reinterpret_cast<const IMAGE_IMPORT_DIRECTORY*>(impDirTbl.data());
 	const IMAGE_IMPORT_DIRECTORY *const pImpDirTblEnd = pImpDirTbl + (impDirTbl.size() / sizeof(IMAGE_IMPORT_DIRECTORY));
 	for (; pImpDirTbl < pImpDirTblEnd; pImpDirTbl++) {
@@ -279,45 +317,60 @@ int EXEPrivate::findPERuntimeDLL(string &refDesc, string &refLink)
 			// End of table.
 			break;
 		}
-
-		const uint32_t rvaModuleName = le32_to_cpu(pImpDirTbl->rvaModuleName);
-		set_dll_vaddrs.insert(rvaModuleName);
-		if (rvaModuleName < dll_vaddr_low) {
-			dll_vaddr_low = rvaModuleName;
-		}
-		if (rvaModuleName > dll_vaddr_high) {
-			dll_vaddr_high = rvaModuleName;
-		}
+		set_dll_vaddrs.insert(le32_to_cpu(pImpDirTbl->rvaModuleName));
 	}
 
-	// NOTE: Since the DLL names are NULL-terminated, we'll have to guess
-	// with the last one. It's unlikely that it'll be at EOF, but we'll
-	// allow for 'short reads'.
-	const uint32_t dll_size_min = dll_vaddr_high - dll_vaddr_low + 1;
-	if (dll_size_min > 1*1024*1024) {
-		// More than 1 MB of DLL names is highly unlikely.
+	const size_t dll_count = set_dll_vaddrs.size();
+	if (dll_count == 0) {
+		// No DLLs.
+		return -ENOENT;
+	} else if (dll_count > 1024) {
+		// More than 1024 DLLs is highly unlikely.
 		// There's probably some corruption in the import table.
 		return -EIO;
 	}
-	uint32_t dll_paddr = pe_vaddr_to_paddr(dll_vaddr_low, dll_size_min);
-	if (dll_paddr == 0) {
-		// Invalid VAs...
-		return -ENOENT;
-	}
 
-	const uint32_t dll_size_max = dll_size_min + 260;	// MAX_PATH
-	unique_ptr<char[]> dll_name_data(new char[dll_size_max]);
-	size_t dll_size_read = file->seekAndRead(dll_paddr, reinterpret_cast<uint8_t*>(dll_name_data.get()), dll_size_max);
-	if (dll_size_read < dll_size_min || dll_size_read > dll_size_max) {
+	// Read all of the DLL names using a single readv() call.
+	// The names are usually close together, so they can be
+	// coalesced into one read by the IRpFile subclass.
+	// NOTE: Since the DLL names are NULL-terminated, we'll have to
+	// guess with the length. Reads are truncated at EOF.
+	static const uint32_t DLL_NAME_SIZE_MAX = 260;	// MAX_PATH
+	unique_ptr<char[]> dll_name_data(new char[dll_count * DLL_NAME_SIZE_MAX]);
+	vector<IRpFile::ReadVec> vec;
+	vec.reserve(dll_count);
+	const off64_t fileSize = file->size();
+	const auto set_dll_vaddrs_cend = set_dll_vaddrs.cend();
+	for (auto iter = set_dll_vaddrs.cbegin(); iter != set_dll_vaddrs_cend; ++iter) {
+		const uint32_t dll_paddr = pe_vaddr_to_paddr(*iter, 1);
+		if (dll_paddr == 0 || static_cast<off64_t>(dll_paddr) >= fileSize) {
+			// Invalid VA...
+			return -ENOENT;
+		}
+
+		char *const dll_name = &dll_name_data[vec.size() * DLL_NAME_SIZE_MAX];
+		uint32_t dll_size = DLL_NAME_SIZE_MAX;
+		if (static_cast<off64_t>(dll_paddr) + dll_size > fileSize) {
+			// Short read at EOF.
+			dll_size = static_cast<uint32_t>(fileSize - dll_paddr);
+			memset(&dll_name[dll_size], 0, DLL_NAME_SIZE_MAX - dll_size);
+		}
+		const IRpFile::ReadVec rv = {dll_paddr, dll_name, dll_size};
+		vec.push_back(rv);
+	}
+	if (file->readv(vec.data(), vec.size()) != 0) {
 		// Seek and/or read error.
 		return -EIO;
 	}
-	// Ensure the end of the buffer is NULL-terminated.
-	dll_name_data[dll_size_max-1] = '\0';
+
+	// Ensure each DLL name is NULL-terminated.
+	for (size_t i = 1; i <= dll_count; i++) {
+		dll_name_data[(i * DLL_NAME_SIZE_MAX) - 1] = '\0';
+	}
 
 	// Convert the entire buffer to lowercase. (ASCII characters only)
 	{
-		char *const p_end = &dll_name_data[dll_size_max];
+		char *const p_end = &dll_name_data[dll_count * DLL_NAME_SIZE_MAX];
 		for (char *p = dll_name_data.get(); p < p_end; p++) {
 			if (*p >= 'A' && *p <= 'Z') *p |= 0x20;
 		}
@@ -352,18 +405,9 @@ int EXEPrivate::findPERuntimeDLL(string &refDesc, string &refLink)
 
 	// Check all of the DLL names.
 	bool found = false;
-	const auto set_dll_vaddrs_cend = set_dll_vaddrs.cend();
-	for (auto iter = set_dll_vaddrs.cbegin(); iter != set_dll_vaddrs_cend && !found; ++iter) {
-		uint32_t vaddr = *iter;
-		assert(vaddr >= dll_vaddr_low);
-		assert(vaddr <= dll_vaddr_high);
-		if (vaddr < dll_vaddr_low || vaddr > dll_vaddr_high) {
-			// Out of bounds? This shouldn't have happened...
-			break;
-		}
-
+	for (size_t i = 0; i < dll_count && !found; i++) {
 		// Current DLL name from the import table.
-		const char *const dll_name = &dll_name_data[vaddr - dll_vaddr_low];
+		const char *const dll_name = &dll_name_data[i * DLL_NAME_SIZE_MAX];
 
 		// Check for MSVC 2015-2019. (vcruntime140.dll)
 		if (!strcmp(dll_name, "vcruntime140.dll")) {
@@ -664,12 +708,6 @@ void EXEPrivate::addFields_PE(void)
 	fields->setTabName(1, C_("EXE", "Version"));
 	fields->setTabIndex(1);
 	addFields_VS_VERSION_INFO(&vsffi, &vssfi);
-
-#ifdef ENABLE_XML
-	// Parse the manifest if it's present.
-	// TODO: Support external manifests, e.g. program.exe.manifest?
-	addFields_PE_Manifest();
-#endif /* ENABLE_XML */
 }
 
 }
@@ -66,32 +66,17 @@ do { } while (0)
 } while (0)
 
 /**
- * Load the Win32 manifest resource.
- *
- * The XML is loaded and parsed using the specified
- * TinyXML document.
- *
- * @param doc		[in/out] XML document.
- * @param ppResName	[out,opt] Pointer to receive the loaded resource name. (statically-allocated string)
- * @return 0 on success; negative POSIX error code on error.
+ * Open the Win32 manifest resource.
+ * @param ppResName	[out,opt] Pointer to receive the resource name. (statically-allocated string)
+ * @return Manifest resource, or nullptr if not found. (Must be unref()'d!)
  */
-int EXEPrivate::loadWin32ManifestResource(XMLDocument &doc, const char **ppResName) const
+IRpFile *EXEPrivate::openWin32ManifestResource(const char **ppResName) const
 {
-#if defined(_MSC_VER) && defined(XML_IS_DLL)
-	// Delay load verification.
-	// TODO: Only if linked with /DELAYLOAD?
-	int ret_dl = DelayLoad_test_TinyXML2();
-	if (ret_dl != 0) {
-		// Delay load failed.
-		return ret_dl;
-	}
-#endif /* defined(_MSC_VER) && defined(XML_IS_DLL) */
-
 	// Make sure the resource directory is loaded.
 	int ret = const_cast<EXEPrivate*>(this)->loadPEResourceTypes();
 	if (ret != 0) {
 		// Unable to load the resource directory.
-		return ret;
+		return nullptr;
 	}
 
 	// Manifest resource IDs
@@ -117,6 +102,21 @@ int EXEPrivate::loadWin32ManifestResource(XMLDocument &doc, const char **ppResNa
 			break;
 	}
 
+	if (f_manifest && ppResName) {
+		*ppResName = resource_ids[id_idx].name;
+	}
+	return f_manifest;
+}
+
+/**
+ * Read the Win32 manifest resource into memory.
+ * @param xml		[out] Manifest XML. (NULL-terminated)
+ * @param ppResName	[out,opt] Pointer to receive the resource name. (statically-allocated string)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int EXEPrivate::readWin32ManifestResource(unique_ptr<char[]> &xml, const char **ppResName) const
+{
+	IRpFile *const f_manifest = openWin32ManifestResource(ppResName);
 	if (!f_manifest) {
 		// No manifest resource.
 		return -ENOENT;
@@ -131,7 +131,7 @@ int EXEPrivate::loadWin32ManifestResource(XMLDocument &doc, const char **ppResNa
 		f_manifest->unref();
 		return -ENOMEM;
 	}
-	unique_ptr<char[]> xml(new char[xml_size+1]);
+	xml.reset(new char[xml_size+1]);
 	size_t size = f_manifest->read(xml.get(), xml_size);
 	f_manifest->unref();
 	if (size != xml_size) {
@@ -139,6 +139,37 @@ int EXEPrivate::loadWin32ManifestResource(XMLDocument &doc, const char **ppResNa
 		return -EIO;
 	}
 	xml[xml_size] = 0;
+	return 0;
+}
+
+/**
+ * Load the Win32 manifest resource.
+ *
+ * The XML is loaded and parsed using the specified
+ * TinyXML document.
+ *
+ * @param doc		[in/out] XML document.
+ * @param ppResName	[out,opt] Pointer to receive the loaded resource name. (statically-allocated string)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int EXEPrivate::loadWin32ManifestResource(XMLDocument &doc, const char **ppResName) const
+{
+#if defined(_MSC_VER) && defined(XML_IS_DLL)
+	// Delay load verification.
+	// TODO: Only if linked with /DELAYLOAD?
+	int ret_dl = DelayLoad_test_TinyXML2();
+	if (ret_dl != 0) {
+		// Delay load failed.
+		return ret_dl;
+	}
+#endif /* defined(_MSC_VER) && defined(XML_IS_DLL) */
+
+	unique_ptr<char[]> xml;
+	const char *pResName = nullptr;
+	int ret = readWin32ManifestResource(xml, &pResName);
+	if (ret != 0) {
+		return ret;
+	}
 
 	// Parse the XML.
 	// FIXME: TinyXML2 2.0.0 added XMLDocument::Clear().
@@ -190,16 +221,36 @@ int EXEPrivate::loadWin32ManifestResource(XMLDocument &doc, const char **ppResNa
 
 	// XML document loaded.
 	if (ppResName) {
-		*ppResName = resource_ids[id_idx].name;
+		*ppResName = pResName;
 	}
 	return 0;
 }
 
 /**
- * Add fields from the Win32 manifest resource.
+ * Add the Manifest tab if the Win32 manifest resource is present.
+ * The manifest is only parsed when the tab is loaded.
+ * This must be called after all regular tabs have been added.
  * @return 0 on success; negative POSIX error code on error.
  */
 int EXEPrivate::addFields_PE_Manifest(void)
+{
+	IRpFile *const f_manifest = openWin32ManifestResource();
+	if (!f_manifest) {
+		// No manifest resource.
+		return -ENOENT;
+	}
+	f_manifest->unref();
+
+	fields->addTab_deferred(C_("EXE", "Manifest"),
+		[this](RomFields*) { return loadFields_PE_Manifest(); });
+	return 0;
+}
+
+/**
+ * Load the fields for the Manifest tab.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int EXEPrivate::loadFields_PE_Manifest(void)
 {
 	const char *pResName = nullptr;
 	XMLDocument doc;
@@ -208,9 +259,6 @@ int EXEPrivate::addFields_PE_Manifest(void)
 		return ret;
 	}
 
-	// Add the manifest fields.
-	fields->addTab(C_("EXE", "Manifest"));
-
 	// Manifest ID.
 	fields->addField_string(C_("EXE|Manifest", "Manifest ID"),
 		(pResName ? pResName : C_("RomData", "Unknown")));
@@ -402,53 +450,170 @@ int EXEPrivate::addFields_PE_Manifest(void)
 	return 0;
 }
 
+/**
+ * Skip past the specified terminator.
+ * @param p Current position.
+ * @param term Terminator.
+ * @return Position after the terminator, or nullptr if not found.
+ */
+static inline const char *skipPast(const char *p, const char *term)
+{
+	p = strstr(p, term);
+	return (p ? p + strlen(term) : nullptr);
+}
+
+/**
+ * Find an attribute in the manifest XML without building a DOM.
+ *
+ * This is a minimal scanner that only tracks element nesting.
+ * The first element that matches the entire path is checked.
+ *
+ * Namespace prefixes are ignored, and entities in the attribute
+ * value are not decoded.
+ *
+ * @param xml		[in] Manifest XML. (NULL-terminated)
+ * @param path		[in] Element path, starting at the root element.
+ * @param path_len	[in] Number of elements in path.
+ * @param attr_name	[in] Attribute name.
+ * @param value		[out] Attribute value.
+ * @return True if found; false if not.
+ */
+static bool scanManifestAttribute(const char *xml,
+	const char *const *path, unsigned int path_len,
+	const char *attr_name, string &value)
+{
+	static const char ws[] = " \t\r\n";
+	unsigned int depth = 0;		// Current element depth
+	unsigned int matched = 0;	// Path elements matched at depths [0, matched)
+
+	for (const char *p = strchr(xml, '<'); p != nullptr; p = strchr(p, '<')) {
+		p++;
+		if (*p == '?') {
+			// Processing instruction.
+			p = skipPast(p, "?>");
+		} else if (!strncmp(p, "!--", 3)) {
+			// Comment.
+			p = skipPast(p + 3, "-->");
+		} else if (!strncmp(p, "![CDATA[", 8)) {
+			// CDATA section.
+			p = skipPast(p + 8, "]]>");
+		} else if (*p == '!') {
+			// DOCTYPE.
+			p = skipPast(p, ">");
+		} else if (*p == '/') {
+			// End tag.
+			if (depth == 0)
+				return false;
+			depth--;
+			if (matched > depth)
+				matched = depth;
+			p = skipPast(p, ">");
+		} else {
+			// Start tag. Get the local name.
+			const char *const name = p;
+			p += strcspn(p, " \t\r\n/>");
+			const char *local = name;
+			for (const char *q = name; q < p; q++) {
+				if (*q == ':')
+					local = q + 1;
+			}
+			const size_t local_len = p - local;
+
+			bool isTarget = false;
+			if (matched == depth && matched < path_len &&
+			    strlen(path[matched]) == local_len &&
+			    !strncmp(local, path[matched], local_len))
+			{
+				matched++;
+				isTarget = (matched == path_len);
+			} else if (depth == 0) {
+				// Incorrect root element.
+				return false;
+			}
+
+			// Attributes.
+			bool selfClosing = false;
+			while (p) {
+				p += strspn(p, ws);
+				if (*p == '>') {
+					p++;
+					break;
+				} else if (*p == '/') {
+					selfClosing = true;
+					p = skipPast(p, ">");
+					break;
+				} else if (*p == 0) {
+					return false;
+				}
+
+				const char *const attr = p;
+				p += strcspn(p, " \t\r\n=/>");
+				const size_t attr_len = p - attr;
+				p += strspn(p, ws);
+				if (*p != '=')
+					continue;
+				p++;
+				p += strspn(p, ws);
+				const char quote = *p;
+				if (quote != '"' && quote != '\'')
+					return false;
+				const char *const attr_value = p + 1;
+				p = strchr(attr_value, quote);
+				if (!p)
+					return false;
+
+				if (isTarget && strlen(attr_name) == attr_len &&
+				    !strncmp(attr, attr_name, attr_len))
+				{
+					value.assign(attr_value, p - attr_value);
+					return true;
+				}
+				p++;
+			}
+			if (isTarget) {
+				// First matching element doesn't have the attribute.
+				return false;
+			}
+
+			if (!selfClosing) {
+				depth++;
+			} else if (matched > depth) {
+				matched = depth;
+			}
+		}
+
+		if (!p)
+			break;
+	}
+
+	return false;
+}
+
 /**
  * Is the requestedExecutionLevel set to requireAdministrator?
+ *
+ * This is checked for every file when showing overlay icons,
+ * so the manifest is scanned directly instead of being parsed
+ * into a TinyXML2 DOM.
+ *
  * @return True if set; false if not or unable to determine.
  */
 bool EXEPrivate::doesExeRequireAdministrator(void) const
 {
-#if defined(_MSC_VER) && defined(XML_IS_DLL)
-	// Delay load verification.
-	// TODO: Only if linked with /DELAYLOAD?
-	int ret_dl = DelayLoad_test_TinyXML2();
-	if (ret_dl != 0) {
-		// Delay load failed.
-		return false;
-	}
-#endif /* defined(_MSC_VER) && defined(XML_IS_DLL) */
-
-	XMLDocument doc;
-	int ret = loadWin32ManifestResource(doc);
+	unique_ptr<char[]> xml;
+	int ret = readWin32ManifestResource(xml);
 	if (ret != 0) {
-		return ret;
-	}
-
-	// Assembly element.
-	const XMLElement *const assembly = doc.FirstChildElement("assembly");
-	if (!assembly) {
-		// No assembly element.
 		return false;
 	}
 
-	// Trust info.
-	FIRST_CHILD_ELEMENT_NS(trustInfo, assembly, "trustInfo", "asmv2");
-	if (!trustInfo)
-		return false;
-	FIRST_CHILD_ELEMENT_NS(security, trustInfo, "security", "asmv2");
-	if (!security)
-		return false;
-	FIRST_CHILD_ELEMENT_NS(requestedPrivileges, security, "requestedPrivileges", "asmv2");
-	if (!requestedPrivileges)
-		return false;
-	FIRST_CHILD_ELEMENT_NS(requestedExecutionLevel, requestedPrivileges, "requestedExecutionLevel", "asmv2");
-	if (!requestedExecutionLevel)
-		return false;
-
-	const char *const attr = requestedExecutionLevel->Attribute("level");
-	if (!attr)
+	static const char *const path[] = {
+		"assembly", "trustInfo", "security",
+		"requestedPrivileges", "requestedExecutionLevel",
+	};
+	string level;
+	if (!scanManifestAttribute(xml.get(), path, ARRAY_SIZE(path), "level", level))
 		return false;
-	return (!strcasecmp(attr, "requireAdministrator"));
+	return (!strcasecmp(level.c_str(), "requireAdministrator"));
 }
 
 }
@@ -19,6 +19,9 @@
 // Reference: http://andreoffringa.org/?q=uvector
 #include "uvector.h"
 
+// C++ includes.
+#include <memory>
+
 // TinyXML2
 namespace tinyxml2 {
 	class XMLDocument;
@@ -158,12 +161,27 @@ class EXEPrivate final : public LibRpBase::RomDataPrivate
 		 */
 		uint32_t pe_vaddr_to_paddr(uint32_t vaddr, uint32_t size);
 
+		/**
+		 * Find a PE section by name.
+		 * pe_sections must be loaded.
+		 * @param name Section name.
+		 * @return Section header, or nullptr if not found.
+		 */
+		const IMAGE_SECTION_HEADER *findPESection(const char *name) const;
+
 		/**
 		 * Load the top-level PE resource directory.
 		 * @return 0 on success; negative POSIX error code on error. (-ENOENT if not found)
 		 */
 		int loadPEResourceTypes(void);
 
+		/**
+		 * Hint that the PE resource directory will be read soon.
+		 * This lets the file start loading it while the
+		 * rest of the headers are being parsed.
+		 */
+		void prefetchPEResources(void);
+
 		/**
 		 * Find the runtime DLL. (PE version)
 		 * @param refDesc String to store the description.
@@ -179,6 +197,23 @@ class EXEPrivate final : public LibRpBase::RomDataPrivate
 
 #ifdef ENABLE_XML
 	private:
+		/**
+		 * Open the Win32 manifest resource.
+		 * @param ppResName	[out,opt] Pointer to receive the resource name. (statically-allocated string)
+		 * @return Manifest resource, or nullptr if not found. (Must be unref()'d!)
+		 */
+		ATTR_ACCESS(write_only, 2)
+		LibRpFile::IRpFile *openWin32ManifestResource(const char **ppResName = nullptr) const;
+
+		/**
+		 * Read the Win32 manifest resource into memory.
+		 * @param xml		[out] Manifest XML. (NULL-terminated)
+		 * @param ppResName	[out,opt] Pointer to receive the resource name. (statically-allocated string)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS(write_only, 3)
+		int readWin32ManifestResource(std::unique_ptr<char[]> &xml, const char **ppResName = nullptr) const;
+
 		/**
 		 * Load the Win32 manifest resource.
 		 *
@@ -193,9 +228,17 @@ class EXEPrivate final : public LibRpBase::RomDataPrivate
 		ATTR_ACCESS(write_only, 3)
 		int loadWin32ManifestResource(tinyxml2::XMLDocument &doc, const char **ppResName = nullptr) const;
 
+		/**
+		 * Load the fields for the Manifest tab.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadFields_PE_Manifest(void);
+
 	public:
 		/**
-		 * Add fields from the Win32 manifest resource.
+		 * Add the Manifest tab if the Win32 manifest resource is present.
+		 * The manifest is only parsed when the tab is loaded.
+		 * This must be called after all regular tabs have been added.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		int addFields_PE_Manifest(void);
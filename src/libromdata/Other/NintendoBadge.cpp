@@ -239,11 +239,11 @@ const rp_image *NintendoBadgePrivate::loadImage(int idx)
 	// TODO: Multiple internal image sizes.
 	// For now, 64x64 only.
 	const unsigned int badge_sz = badge_rgb_sz + badge_a4_sz;
-	auto badgeData = aligned_uptr<uint8_t>(16, badge_sz);
 
 	rp_image *img = nullptr;
 	if (!doMegaBadge) {
 		// Single badge.
+		auto badgeData = aligned_uptr<uint8_t>(16, badge_sz);
 		size_t size = file->seekAndRead(start_addr, badgeData.get(), badge_sz);
 		if (size != badge_sz) {
 			// Seek and/or read error.
@@ -269,42 +269,34 @@ const rp_image *NintendoBadgePrivate::loadImage(int idx)
 			img = img48;
 		}
 	} else {
-		// Mega badge. Need to convert each 64x64 badge
-		// and concatenate them manually.
+		// Mega badge. The badges are read all at once and
+		// decoded directly into the combined image.
 
 		// Mega badge dimensions.
-		const unsigned int mb_width     = badgeHeader.prbs.mb_width;
-		const unsigned int mb_height    = badgeHeader.prbs.mb_height;
-		const unsigned int mb_row_bytes = badge_dims * sizeof(uint32_t);
-
-		// Badges are stored vertically, then horizontally.
-		img = new rp_image(badge_dims * mb_width, badge_dims * mb_height, rp_image::Format::ARGB32);
-		for (unsigned int y = 0; y < mb_height; y++) {
-			const unsigned int my = y*badge_dims;
-			for (unsigned int x = 0; x < mb_width; x++, start_addr += (0x2800+0xA00)) {
-				size_t size = file->seekAndRead(start_addr, badgeData.get(), badge_sz);
-				if (size != badge_sz) {
-					// Seek and/or read error.
-					img->unref();
-					return nullptr;
-				}
+		const unsigned int mb_width  = badgeHeader.prbs.mb_width;
+		const unsigned int mb_height = badgeHeader.prbs.mb_height;
+		if (mb_width == 0 || mb_height == 0) {
+			// No badges.
+			return nullptr;
+		}
 
-				rp_image *const mb_img = ImageDecoder::fromN3DSTiledRGB565_A4(
-					badge_dims, badge_dims,
-					reinterpret_cast<const uint16_t*>(badgeData.get()), badge_rgb_sz,
-					badgeData.get() + badge_rgb_sz, badge_a4_sz);
-
-				// Copy the image into place.
-				// TODO: Pointer arithmetic instead of rp_image::scanLine().
-				const unsigned int mx = x*badge_dims;
-				for (int py = badge_dims-1; py >= 0; py--) {
-					const uint32_t *src = static_cast<const uint32_t*>(mb_img->scanLine(py));
-					uint32_t *dest = static_cast<uint32_t*>(img->scanLine(py+my)) + mx;
-					memcpy(dest, src, mb_row_bytes);
-				}
+		// Each badge has both the 64x64 and 32x32 versions.
+		// NOTE: Badges are stored left to right, then top to bottom.
+		static const unsigned int mb_stride = (0x2800+0xA00);
+		const size_t mb_data_sz = ((mb_width * mb_height) - 1) * mb_stride + badge_sz;
+		auto badgeData = aligned_uptr<uint8_t>(16, mb_data_sz);
+		size_t size = file->seekAndRead(start_addr, badgeData.get(), mb_data_sz);
+		if (size != mb_data_sz) {
+			// Seek and/or read error.
+			return nullptr;
+		}
 
-				mb_img->unref();
-			}
+		img = ImageDecoder::fromN3DSTiledRGB565_A4_Grid(
+			badge_dims, badge_dims, mb_width, mb_height,
+			badgeData.get(), mb_data_sz, mb_stride);
+		if (!img) {
+			// Error decoding the badges.
+			return nullptr;
 		}
 	}
 
@@ -361,4 +361,85 @@ int RpTextureWrapper::loadInternalImage(ImageType imageType, const rp_image **pI
 		d->texture->image);	// func
 }
 
+/**
+ * Load an internal image, optionally at a reduced size.
+ * Called by RomData::imageForSize().
+ *
+ * The smallest mipmap that is at least reqSize is loaded,
+ * so only that mipmap level is read and decoded. Formats with
+ * an embedded low-resolution image (e.g. VTF) use it instead
+ * if it's large enough.
+ *
+ * @param imageType	[in] Image type to load.
+ * @param reqSize	[in] Requested size. (single dimension; 0 for the full image)
+ * @param pImage	[out] Pointer to const rp_image* to store the image in.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpTextureWrapper::loadInternalImageForSize(ImageType imageType, int reqSize, const rp_image **pImage)
+{
+	ASSERT_loadInternalImage(imageType, pImage);
+	RP_D(RpTextureWrapper);
+	if (imageType != IMG_INT_IMAGE) {
+		*pImage = nullptr;
+		return -ENOENT;
+	} else if (!d->file) {
+		*pImage = nullptr;
+		return -EBADF;
+	} else if (!d->isValid) {
+		*pImage = nullptr;
+		return -EIO;
+	}
+
+	*pImage = d->texture->mipmapForSize(reqSize);
+	return (*pImage != nullptr ? 0 : -EIO);
+}
+
+/**
+ * Load a mipmap of an internal image.
+ * Called by RomData::imageMipmap().
+ * @param imageType	[in] Image type to load.
+ * @param mip		[in] Mipmap number. (0 for the full image)
+ * @param pImage	[out] Pointer to const rp_image* to store the image in.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpTextureWrapper::loadInternalImageMipmap(ImageType imageType, int mip, const rp_image **pImage)
+{
+	ASSERT_loadInternalImage(imageType, pImage);
+	RP_D(RpTextureWrapper);
+	if (imageType != IMG_INT_IMAGE) {
+		*pImage = nullptr;
+		return -ENOENT;
+	} else if (!d->file) {
+		*pImage = nullptr;
+		return -EBADF;
+	} else if (!d->isValid) {
+		*pImage = nullptr;
+		return -EIO;
+	} else if (mip >= imageMipmapCount(imageType)) {
+		*pImage = nullptr;
+		return -ENOENT;
+	}
+
+	*pImage = (mip == 0 ? d->texture->image() : d->texture->mipmap(mip));
+	return (*pImage != nullptr ? 0 : -EIO);
+}
+
+/**
+ * Get the number of mipmaps for an internal image.
+ * @param imageType Image type.
+ * @return Number of mipmaps, including the full image.
+ */
+int RpTextureWrapper::imageMipmapCount(ImageType imageType) const
+{
+	RP_D(const RpTextureWrapper);
+	if (imageType != IMG_INT_IMAGE || !d->isValid) {
+		return 0;
+	}
+
+	// NOTE: mipmapCount() returns 0 if the texture doesn't
+	// have mipmaps, or -1 if the format doesn't support them.
+	const int mipmapCount = d->texture->mipmapCount();
+	return (mipmapCount > 1 ? mipmapCount : 1);
+}
+
 }
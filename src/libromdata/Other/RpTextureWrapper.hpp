@@ -19,6 +19,35 @@ ROMDATA_DECL_METADATA()
 ROMDATA_DECL_IMGSUPPORT()
 ROMDATA_DECL_IMGPF()
 ROMDATA_DECL_IMGINT()
+
+public:
+	/**
+	 * Load an internal image, optionally at a reduced size.
+	 * Called by RomData::imageForSize().
+	 * @param imageType	[in] Image type to load.
+	 * @param reqSize	[in] Requested size. (single dimension; 0 for the full image)
+	 * @param pImage	[out] Pointer to const rp_image* to store the image in.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int loadInternalImageForSize(ImageType imageType, int reqSize, const LibRpTexture::rp_image **pImage) final;
+
+	/**
+	 * Load a mipmap of an internal image.
+	 * Called by RomData::imageMipmap().
+	 * @param imageType	[in] Image type to load.
+	 * @param mip		[in] Mipmap number. (0 for the full image)
+	 * @param pImage	[out] Pointer to const rp_image* to store the image in.
+	 * @return 0 on success; negative POSIX error code on error.
+	 */
+	int loadInternalImageMipmap(ImageType imageType, int mip, const LibRpTexture::rp_image **pImage) final;
+
+	/**
+	 * Get the number of mipmaps for an internal image.
+	 * @param imageType Image type.
+	 * @return Number of mipmaps, including the full image.
+	 */
+	int imageMipmapCount(ImageType imageType) const final;
+
 ROMDATA_DECL_END()
 
 }
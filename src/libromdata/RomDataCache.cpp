@@ -0,0 +1,716 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomDataCache.cpp: Persistent RomData field and metadata cache.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.version.h"
+#include "RomDataCache.hpp"
+
+// librpbase, librpfile, librptexture
+#include "librpbase/RomFields.hpp"
+#include "librpbase/RomFieldsBinary.hpp"
+#include "librpbase/RomMetaData.hpp"
+#include "librpbase/img/RpPng.hpp"
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpFile.hpp"
+#include "librpfile/RpMemFile.hpp"
+#include "librpfile/RpVectorFile.hpp"
+#include "librptexture/img/rp_image.hpp"
+using namespace LibRpBase;
+using namespace LibRpFile;
+using LibRpTexture::rp_image;
+
+// libcachecommon
+#include "libcachecommon/CacheKeys.hpp"
+
+// C++ STL classes.
+using std::array;
+using std::string;
+using std::vector;
+
+namespace LibRomData {
+
+// Cache file magic and format version.
+// Increment the format version if the file layout changes.
+static const uint32_t CACHE_MAGIC = 'RPDC';
+static const uint32_t CACHE_END_MAGIC = 'RPDE';
+static const uint32_t CACHE_FORMAT_VERSION = 3;
+
+// Maximum cache file size.
+static const off64_t CACHE_MAX_SIZE = 16*1024*1024;
+
+// Number of system name variants. (SYSNAME_TYPE_* | SYSNAME_REGION_*)
+#define SYSNAME_COUNT 8
+
+// NOTE: Only internal images are cached.
+#define CACHE_IMG_COUNT (RomData::IMG_INT_MAX + 1)
+
+/** Serialization helpers **/
+
+class CacheWriter
+{
+	public:
+		inline void u8(uint8_t val)
+		{
+			buf.push_back(val);
+		}
+
+		inline void u32(uint32_t val)
+		{
+			val = cpu_to_le32(val);
+			const uint8_t *const p = reinterpret_cast<const uint8_t*>(&val);
+			buf.insert(buf.end(), p, p + sizeof(val));
+		}
+
+		inline void u64(uint64_t val)
+		{
+			val = cpu_to_le64(val);
+			const uint8_t *const p = reinterpret_cast<const uint8_t*>(&val);
+			buf.insert(buf.end(), p, p + sizeof(val));
+		}
+
+		inline void blob(const void *data, size_t size)
+		{
+			u32(static_cast<uint32_t>(size));
+			const uint8_t *const p = static_cast<const uint8_t*>(data);
+			buf.insert(buf.end(), p, p + size);
+		}
+
+		inline void str(const string &s)
+		{
+			blob(s.data(), s.size());
+		}
+
+		inline void str(const char *s)
+		{
+			// nullptr is saved as an empty string.
+			blob(s, s ? strlen(s) : 0);
+		}
+
+	public:
+		vector<uint8_t> buf;
+};
+
+class CacheReader
+{
+	public:
+		CacheReader(const uint8_t *data, size_t size)
+			: p(data), end(data + size), ok(true)
+		{ }
+
+	private:
+		inline bool check(size_t size)
+		{
+			if (!ok || static_cast<size_t>(end - p) < size) {
+				ok = false;
+			}
+			return ok;
+		}
+
+	public:
+		inline uint8_t u8(void)
+		{
+			if (!check(1))
+				return 0;
+			return *p++;
+		}
+
+		inline uint32_t u32(void)
+		{
+			uint32_t val = 0;
+			if (check(sizeof(val))) {
+				memcpy(&val, p, sizeof(val));
+				p += sizeof(val);
+			}
+			return le32_to_cpu(val);
+		}
+
+		inline uint64_t u64(void)
+		{
+			uint64_t val = 0;
+			if (check(sizeof(val))) {
+				memcpy(&val, p, sizeof(val));
+				p += sizeof(val);
+			}
+			return le64_to_cpu(val);
+		}
+
+		const uint8_t *blob(size_t *pSize)
+		{
+			const size_t size = u32();
+			if (!check(size)) {
+				*pSize = 0;
+				return nullptr;
+			}
+			const uint8_t *const data = p;
+			p += size;
+			*pSize = size;
+			return data;
+		}
+
+		string str(void)
+		{
+			size_t size;
+			const uint8_t *const data = blob(&size);
+			return (data ? string(reinterpret_cast<const char*>(data), size) : string());
+		}
+
+	public:
+		const uint8_t *p;
+		const uint8_t *const end;
+		bool ok;
+};
+
+/** CachedRomData **/
+
+class CachedRomDataPrivate;
+class CachedRomData final : public RomData
+{
+	public:
+		CachedRomData();
+	private:
+		typedef RomData super;
+		friend class CachedRomDataPrivate;
+		RP_DISABLE_COPY(CachedRomData)
+
+	public:
+		int isRomSupported(const DetectInfo *info) const final;
+		const char *systemName(unsigned int type) const final;
+		const char *const *supportedFileExtensions(void) const final;
+		const char *const *supportedMimeTypes(void) const final;
+		uint32_t supportedImageTypes(void) const final;
+		uint32_t imgpf(ImageType imageType) const final;
+		bool hasDangerousPermissions(void) const final;
+
+	protected:
+		int loadFieldData(void) final;
+		int loadMetaData(void) final;
+		int loadInternalImage(ImageType imageType, const rp_image **pImage) final;
+
+	public:
+		/**
+		 * Load the cached data.
+		 * @param reader CacheReader positioned after the cache header.
+		 * @return True on success; false on error.
+		 */
+		bool load(CacheReader &reader);
+};
+
+class CachedRomDataPrivate final : public RomDataPrivate
+{
+	public:
+		explicit CachedRomDataPrivate(CachedRomData *q);
+		~CachedRomDataPrivate() final;
+
+	private:
+		typedef RomDataPrivate super;
+		RP_DISABLE_COPY(CachedRomDataPrivate)
+
+	public:
+		// Strings referenced by RomDataPrivate.
+		string s_className;
+		string s_mimeType;
+
+		// System names.
+		array<string, SYSNAME_COUNT> sysNames;
+
+		// Internal images. (PNG format)
+		array<vector<uint8_t>, CACHE_IMG_COUNT> imgPng;
+		array<uint32_t, CACHE_IMG_COUNT> imgpf;
+		array<rp_image*, CACHE_IMG_COUNT> img;
+
+		bool dangerousPermissions;
+};
+
+CachedRomDataPrivate::CachedRomDataPrivate(CachedRomData *q)
+	: super(q, nullptr)
+	, dangerousPermissions(false)
+{
+	imgpf.fill(0);
+	img.fill(nullptr);
+}
+
+CachedRomDataPrivate::~CachedRomDataPrivate()
+{
+	for (rp_image *pImg : img) {
+		UNREF(pImg);
+	}
+}
+
+CachedRomData::CachedRomData()
+	: super(new CachedRomDataPrivate(this))
+{ }
+
+int CachedRomData::isRomSupported(const DetectInfo *info) const
+{
+	// Cached data can't be used for detection.
+	RP_UNUSED(info);
+	return -1;
+}
+
+const char *CachedRomData::systemName(unsigned int type) const
+{
+	RP_D(const CachedRomData);
+	if (!d->isValid || !isSystemNameTypeValid(type))
+		return nullptr;
+
+	const string &sysName = d->sysNames[type & (SYSNAME_COUNT-1)];
+	return (!sysName.empty() ? sysName.c_str() : nullptr);
+}
+
+const char *const *CachedRomData::supportedFileExtensions(void) const
+{
+	static const char *const exts[] = { nullptr };
+	return exts;
+}
+
+const char *const *CachedRomData::supportedMimeTypes(void) const
+{
+	static const char *const mimeTypes[] = { nullptr };
+	return mimeTypes;
+}
+
+uint32_t CachedRomData::supportedImageTypes(void) const
+{
+	RP_D(const CachedRomData);
+	uint32_t ret = 0;
+	for (unsigned int i = 0; i < CACHE_IMG_COUNT; i++) {
+		if (!d->imgPng[i].empty()) {
+			ret |= (1U << i);
+		}
+	}
+	return ret;
+}
+
+uint32_t CachedRomData::imgpf(ImageType imageType) const
+{
+	ASSERT_imgpf(imageType);
+	RP_D(const CachedRomData);
+	if (imageType >= CACHE_IMG_COUNT)
+		return 0;
+	return d->imgpf[imageType];
+}
+
+bool CachedRomData::hasDangerousPermissions(void) const
+{
+	RP_D(const CachedRomData);
+	return d->dangerousPermissions;
+}
+
+int CachedRomData::loadFieldData(void)
+{
+	// Fields were loaded from the cache.
+	RP_D(const CachedRomData);
+	return d->fields->count();
+}
+
+int CachedRomData::loadMetaData(void)
+{
+	// Metadata was loaded from the cache.
+	RP_D(const CachedRomData);
+	return (d->metaData ? d->metaData->count() : -ENOENT);
+}
+
+int CachedRomData::loadInternalImage(ImageType imageType, const rp_image **pImage)
+{
+	ASSERT_loadInternalImage(imageType, pImage);
+	RP_D(CachedRomData);
+	if (imageType >= CACHE_IMG_COUNT || d->imgPng[imageType].empty()) {
+		*pImage = nullptr;
+		return -ENOENT;
+	} else if (d->img[imageType]) {
+		*pImage = d->img[imageType];
+		return 0;
+	}
+
+	vector<uint8_t> &png = d->imgPng[imageType];
+	RpMemFile *const memFile = new RpMemFile(png.data(), png.size());
+	// NOTE: Cached images were written by RpPng::save(),
+	// so they don't need to be verified.
+	d->img[imageType] = RpPng::load(memFile, RpPng::CheckLevel::None);
+	memFile->unref();
+
+	*pImage = d->img[imageType];
+	return (*pImage != nullptr ? 0 : -EIO);
+}
+
+/**
+ * Load the cached data.
+ * @param reader CacheReader positioned after the cache header.
+ * @return True on success; false on error.
+ */
+bool CachedRomData::load(CacheReader &reader)
+{
+	RP_D(CachedRomData);
+
+	// Class information.
+	d->s_className = reader.str();
+	d->s_mimeType = reader.str();
+	d->className = (!d->s_className.empty() ? d->s_className.c_str() : nullptr);
+	d->mimeType = (!d->s_mimeType.empty() ? d->s_mimeType.c_str() : nullptr);
+	const uint32_t fileType = reader.u32();
+	if (fileType >= static_cast<uint32_t>(FileType::Max))
+		return false;
+	d->fileType = static_cast<FileType>(fileType);
+	for (string &sysName : d->sysNames) {
+		sysName = reader.str();
+	}
+	d->dangerousPermissions = !!reader.u8();
+
+	// Fields and metadata.
+	// These are stored using RomFieldsBinary.
+	size_t binSize;
+	const uint8_t *const binData = reader.blob(&binSize);
+	if (!binData)
+		return false;
+	const RomFieldsBinary bin(binData, binSize);
+	if (!bin.isValid() || bin.tabCount() > 256)
+		return false;
+	if (bin.toRomFields(d->fields) != 0)
+		return false;
+	if (bin.metaDataCount() > 0) {
+		d->metaData = new RomMetaData();
+		if (bin.toRomMetaData(d->metaData) != 0)
+			return false;
+	}
+
+	// Internal images.
+	for (unsigned int i = 0; i < CACHE_IMG_COUNT; i++) {
+		d->imgpf[i] = reader.u32();
+		size_t size;
+		const uint8_t *const png = reader.blob(&size);
+		if (png && size > 0) {
+			d->imgPng[i].assign(png, png + size);
+		}
+	}
+
+	// End marker.
+	if (reader.u32() != CACHE_END_MAGIC || !reader.ok)
+		return false;
+
+	d->isValid = true;
+	return true;
+}
+
+/** RomDataCache **/
+
+/**
+ * Get the cache filename for a file.
+ * @param filename Filename. (UTF-8)
+ * @return Cache filename, or empty string on error.
+ */
+static string getCacheFilenameFor(const char *filename)
+{
+	// FNV-1a hash of the filename.
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (const char *p = filename; *p != '\0'; p++) {
+		hash ^= static_cast<uint8_t>(*p);
+		hash *= 0x100000001B3ULL;
+	}
+
+	char cacheKey[48];
+	snprintf(cacheKey, sizeof(cacheKey), "romdata/%08X%08X.bin",
+		static_cast<unsigned int>(hash >> 32),
+		static_cast<unsigned int>(hash & 0xFFFFFFFFU));
+	return LibCacheCommon::getCacheFilename(cacheKey);
+}
+
+/**
+ * Write the cache header.
+ * @param writer CacheWriter.
+ * @param filename Filename. (UTF-8)
+ * @param fileSize File size.
+ * @param mtime File modification time.
+ */
+static void writeCacheHeader(CacheWriter &writer, const char *filename, off64_t fileSize, time_t mtime)
+{
+	writer.u32(CACHE_MAGIC);
+	writer.u32(CACHE_FORMAT_VERSION);
+	writer.str(RP_VERSION_STRING);
+	writer.str(filename);
+	writer.u64(static_cast<uint64_t>(fileSize));
+	writer.u64(static_cast<uint64_t>(static_cast<int64_t>(mtime)));
+}
+
+/**
+ * Save a RomData object's fields and metadata to the cache.
+ *
+ * The cache entry is keyed on the filename, file size,
+ * modification time, and the rom-properties version.
+ * Internal images are saved as PNG images.
+ *
+ * NOTE: RomData objects with ListData icons are not cached.
+ *
+ * @param filename	[in] Filename. (UTF-8)
+ * @param fileSize	[in] File size.
+ * @param mtime		[in] File modification time.
+ * @param romData	[in] RomData object.
+ * @param thumbImageType [in] Image type selected for thumbnails, or -1 if none.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomDataCache::save(const char *filename, off64_t fileSize, time_t mtime,
+	const RomData *romData, int thumbImageType)
+{
+	assert(filename != nullptr);
+	assert(romData != nullptr);
+	if (!filename || filename[0] == '\0' || !romData || !romData->isValid()) {
+		return -EINVAL;
+	}
+
+	// Metadata-only RomData objects don't have fields or
+	// internal images, so an empty entry is written for them.
+	// Such entries are only returned by loadMetaData().
+	const bool metaDataOnly = romData->isMetaDataOnly();
+	RomFields emptyFields;
+	const RomFields *const fields = (metaDataOnly ? &emptyFields : romData->fields());
+	if (!fields) {
+		return -EIO;
+	}
+
+	CacheWriter writer;
+	writeCacheHeader(writer, filename, fileSize, mtime);
+	writer.u32(static_cast<uint32_t>(thumbImageType));
+	writer.u8(metaDataOnly);
+
+	// Class information.
+	writer.str(romData->className());
+	writer.str(romData->mimeType());
+	writer.u32(static_cast<uint32_t>(romData->fileType()));
+	for (unsigned int i = 0; i < SYSNAME_COUNT; i++) {
+		writer.str(romData->systemName(i));
+	}
+	writer.u8(romData->hasDangerousPermissions());
+
+	// Fields and metadata.
+	// NOTE: RomFieldsBinary returns -ENOTSUP for ListData icons.
+	vector<uint8_t> bin;
+	int ret = RomFieldsBinary::serialize(bin, fields, romData->metaData());
+	if (ret != 0) {
+		return ret;
+	}
+	writer.blob(bin.data(), bin.size());
+
+	// Internal images.
+	// NOTE: Animated icons are saved as a static image.
+	const uint32_t imgbf = (!metaDataOnly ? romData->supportedImageTypes() : 0);
+	for (unsigned int i = 0; i < CACHE_IMG_COUNT; i++) {
+		const RomData::ImageType imageType = static_cast<RomData::ImageType>(i);
+		const rp_image *const img = ((imgbf & (1U << i)) ? romData->image(imageType) : nullptr);
+		if (!img) {
+			writer.u32(0);
+			writer.u32(0);
+			continue;
+		}
+
+		RpVectorFile *const vecFile = new RpVectorFile();
+		if (RpPng::save(vecFile, img) == 0) {
+			writer.u32(romData->imgpf(imageType) & ~RomData::IMGPF_ICON_ANIMATED);
+			writer.blob(vecFile->vector().data(), vecFile->vector().size());
+		} else {
+			writer.u32(0);
+			writer.u32(0);
+		}
+		vecFile->unref();
+	}
+
+	// End marker.
+	writer.u32(CACHE_END_MAGIC);
+	if (writer.buf.size() > static_cast<size_t>(CACHE_MAX_SIZE)) {
+		// Too big to cache.
+		return -EFBIG;
+	}
+
+	// Write the cache file.
+	const string cacheFilename = getCacheFilenameFor(filename);
+	if (cacheFilename.empty()) {
+		return -ENOENT;
+	}
+	ret = FileSystem::rmkdir(cacheFilename);
+	if (ret != 0) {
+		return ret;
+	}
+
+	RpFile *const file = new RpFile(cacheFilename, RpFile::FM_CREATE_WRITE);
+	if (!file->isOpen()) {
+		ret = -file->lastError();
+		file->unref();
+		return (ret != 0 ? ret : -EIO);
+	}
+	const size_t size = file->write(writer.buf.data(), writer.buf.size());
+	if (size != writer.buf.size()) {
+		ret = -file->lastError();
+		if (ret == 0) {
+			ret = -EIO;
+		}
+	}
+	file->unref();
+	if (ret != 0) {
+		// Don't leave a partial cache file behind.
+		FileSystem::delete_file(cacheFilename.c_str());
+	}
+	return ret;
+}
+
+/**
+ * Save a RomData object's fields and metadata to the cache.
+ * The file size and modification time are retrieved from the file system.
+ *
+ * @param filename	[in] Local filename. (UTF-8)
+ * @param romData	[in] RomData object.
+ * @param thumbImageType [in] Image type selected for thumbnails, or -1 if none.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomDataCache::save(const char *filename, const RomData *romData, int thumbImageType)
+{
+	assert(filename != nullptr);
+	if (!filename || filename[0] == '\0') {
+		return -EINVAL;
+	}
+
+	off64_t fileSize;
+	time_t mtime;
+	int ret = FileSystem::get_file_size_and_mtime(filename, &fileSize, &mtime);
+	if (ret != 0) {
+		return ret;
+	}
+	return save(filename, fileSize, mtime, romData, thumbImageType);
+}
+
+/**
+ * Load a RomData object from the cache.
+ * @param filename	[in] Filename. (UTF-8)
+ * @param fileSize	[in] File size.
+ * @param mtime		[in] File modification time.
+ * @param metaDataOnly	[in] If true, metadata-only entries are allowed, and the RomData object is metadata-only.
+ * @param pThumbImageType [out,opt] Image type selected for thumbnails, or -1 if none.
+ * @return RomData object, or nullptr if the file isn't cached or the cache entry is out of date.
+ */
+static RomData *loadCacheEntry(const char *filename, off64_t fileSize, time_t mtime,
+	bool metaDataOnly, int *pThumbImageType)
+{
+	assert(filename != nullptr);
+	if (!filename || filename[0] == '\0') {
+		return nullptr;
+	}
+
+	const string cacheFilename = getCacheFilenameFor(filename);
+	if (cacheFilename.empty()) {
+		return nullptr;
+	}
+
+	// Read the entire cache file.
+	RpFile *const file = new RpFile(cacheFilename, RpFile::FM_OPEN_READ);
+	if (!file->isOpen()) {
+		file->unref();
+		return nullptr;
+	}
+	const off64_t cacheSize = file->size();
+	if (cacheSize <= 0 || cacheSize > CACHE_MAX_SIZE) {
+		file->unref();
+		return nullptr;
+	}
+	vector<uint8_t> buf(static_cast<size_t>(cacheSize));
+	const size_t size = file->read(buf.data(), buf.size());
+	file->unref();
+	if (size != buf.size()) {
+		return nullptr;
+	}
+
+	// Verify the cache header.
+	CacheWriter header;
+	writeCacheHeader(header, filename, fileSize, mtime);
+	if (buf.size() < header.buf.size() ||
+	    memcmp(buf.data(), header.buf.data(), header.buf.size()) != 0)
+	{
+		// Cache entry is for a different file or is out of date.
+		return nullptr;
+	}
+
+	CacheReader reader(buf.data() + header.buf.size(), buf.size() - header.buf.size());
+	const int thumbImageType = static_cast<int>(reader.u32());
+	const bool entryMetaDataOnly = !!reader.u8();
+	if (entryMetaDataOnly && !metaDataOnly) {
+		// Cache entry doesn't have fields or internal images.
+		return nullptr;
+	}
+
+	CachedRomData *const romData = new CachedRomData();
+	if (!romData->load(reader)) {
+		// Cache entry is corrupted.
+		romData->unref();
+		return nullptr;
+	}
+	if (metaDataOnly) {
+		romData->setMetaDataOnly();
+	}
+
+	if (pThumbImageType) {
+		*pThumbImageType = thumbImageType;
+	}
+	return romData;
+}
+
+/**
+ * Load a RomData object from the cache.
+ *
+ * The returned RomData object does not have an open file.
+ * Fields, metadata, the system name, and internal images
+ * are available; external images, animated icons, and ROM
+ * operations are not.
+ *
+ * @param filename	[in] Filename. (UTF-8)
+ * @param fileSize	[in] File size.
+ * @param mtime		[in] File modification time.
+ * @param pThumbImageType [out,opt] Image type selected for thumbnails, or -1 if none.
+ * @return RomData object, or nullptr if the file isn't cached or the cache entry is out of date.
+ */
+RomData *RomDataCache::load(const char *filename, off64_t fileSize, time_t mtime, int *pThumbImageType)
+{
+	return loadCacheEntry(filename, fileSize, mtime, false, pThumbImageType);
+}
+
+/**
+ * Load a RomData object from the cache.
+ * The file size and modification time are retrieved from the file system.
+ *
+ * @param filename	[in] Local filename. (UTF-8)
+ * @param pThumbImageType [out,opt] Image type selected for thumbnails, or -1 if none.
+ * @return RomData object, or nullptr if the file isn't cached or the cache entry is out of date.
+ */
+RomData *RomDataCache::load(const char *filename, int *pThumbImageType)
+{
+	assert(filename != nullptr);
+	if (!filename || filename[0] == '\0') {
+		return nullptr;
+	}
+
+	off64_t fileSize;
+	time_t mtime;
+	if (FileSystem::get_file_size_and_mtime(filename, &fileSize, &mtime) != 0) {
+		return nullptr;
+	}
+	return load(filename, fileSize, mtime, pThumbImageType);
+}
+
+/**
+ * Load a metadata-only RomData object from the cache.
+ *
+ * This accepts entries saved from either a full RomData object
+ * or a metadata-only RomData object. The returned RomData object
+ * is metadata-only. (See RomData::setMetaDataOnly().)
+ *
+ * @param filename	[in] Filename. (UTF-8)
+ * @param fileSize	[in] File size.
+ * @param mtime		[in] File modification time.
+ * @return RomData object, or nullptr if the file isn't cached or the cache entry is out of date.
+ */
+RomData *RomDataCache::loadMetaData(const char *filename, off64_t fileSize, time_t mtime)
+{
+	return loadCacheEntry(filename, fileSize, mtime, true, nullptr);
+}
+
+}
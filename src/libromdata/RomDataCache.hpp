@@ -0,0 +1,113 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomDataCache.hpp: Persistent RomData field and metadata cache.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_ROMDATACACHE_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_ROMDATACACHE_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+// C includes. (C++ namespace)
+#include <ctime>
+
+namespace LibRpBase {
+	class RomData;
+}
+
+namespace LibRomData {
+
+class RomDataCache
+{
+	private:
+		RomDataCache();
+		~RomDataCache();
+	private:
+		RP_DISABLE_COPY(RomDataCache)
+
+	public:
+		/**
+		 * Save a RomData object's fields and metadata to the cache.
+		 *
+		 * The cache entry is keyed on the filename, file size,
+		 * modification time, and the rom-properties version.
+		 * Internal images are saved as PNG images.
+		 *
+		 * NOTE: RomData objects with ListData icons are not cached.
+		 *
+		 * If the RomData object is metadata-only, only the class
+		 * information and metadata are saved, and the entry will
+		 * only be returned by loadMetaData().
+		 *
+		 * @param filename	[in] Filename. (UTF-8)
+		 * @param fileSize	[in] File size.
+		 * @param mtime		[in] File modification time.
+		 * @param romData	[in] RomData object.
+		 * @param thumbImageType [in] Image type selected for thumbnails, or -1 if none.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int save(const char *filename, off64_t fileSize, time_t mtime,
+			const LibRpBase::RomData *romData, int thumbImageType = -1);
+
+		/**
+		 * Save a RomData object's fields and metadata to the cache.
+		 * The file size and modification time are retrieved from the file system.
+		 *
+		 * @param filename	[in] Local filename. (UTF-8)
+		 * @param romData	[in] RomData object.
+		 * @param thumbImageType [in] Image type selected for thumbnails, or -1 if none.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int save(const char *filename, const LibRpBase::RomData *romData, int thumbImageType = -1);
+
+		/**
+		 * Load a RomData object from the cache.
+		 *
+		 * The returned RomData object does not have an open file.
+		 * Fields, metadata, the system name, and internal images
+		 * are available; external images, animated icons, and ROM
+		 * operations are not.
+		 *
+		 * @param filename	[in] Filename. (UTF-8)
+		 * @param fileSize	[in] File size.
+		 * @param mtime		[in] File modification time.
+		 * @param pThumbImageType [out,opt] Image type selected for thumbnails, or -1 if none.
+		 * @return RomData object, or nullptr if the file isn't cached or the cache entry is out of date.
+		 */
+		static LibRpBase::RomData *load(const char *filename, off64_t fileSize, time_t mtime,
+			int *pThumbImageType = nullptr);
+
+		/**
+		 * Load a RomData object from the cache.
+		 * The file size and modification time are retrieved from the file system.
+		 *
+		 * @param filename	[in] Local filename. (UTF-8)
+		 * @param pThumbImageType [out,opt] Image type selected for thumbnails, or -1 if none.
+		 * @return RomData object, or nullptr if the file isn't cached or the cache entry is out of date.
+		 */
+		static LibRpBase::RomData *load(const char *filename, int *pThumbImageType = nullptr);
+
+		/**
+		 * Load a metadata-only RomData object from the cache.
+		 *
+		 * This accepts entries saved from either a full RomData object
+		 * or a metadata-only RomData object. The returned RomData object
+		 * is metadata-only. (See RomData::setMetaDataOnly().)
+		 *
+		 * @param filename	[in] Filename. (UTF-8)
+		 * @param fileSize	[in] File size.
+		 * @param mtime		[in] File modification time.
+		 * @return RomData object, or nullptr if the file isn't cached or the cache entry is out of date.
+		 */
+		static LibRpBase::RomData *loadMetaData(const char *filename, off64_t fileSize, time_t mtime);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_ROMDATACACHE_HPP__ */
@@ -11,14 +11,24 @@
 #include "libromdata/config.libromdata.h"
 
 #include "RomDataFactory.hpp"
+#include "DetectCache.hpp"
 
 // librpbase, librpfile
+#include "librpfile/AsyncReader.hpp"
 #include "librpfile/RelatedFile.hpp"
+#include "librpfile/RpTrace.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 
 // librpthreads
+#include "librpthreads/CancelToken.hpp"
+#include "librpthreads/Mutex.hpp"
 #include "librpthreads/pthread_once.h"
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::CancelToken;
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+using LibRpThreads::ThreadPool;
 
 // librptexture
 #include "librptexture/FileFormatFactory.hpp"
@@ -26,6 +36,7 @@ using LibRpTexture::FileFormatFactory;
 
 // C++ STL classes.
 using std::string;
+using std::unique_ptr;
 using std::unordered_map;
 using std::unordered_set;
 using std::vector;
@@ -119,6 +130,7 @@ class RomDataFactoryPrivate
 		typedef RomData* (*pfnNewRomData_t)(IRpFile *file);
 
 		struct RomDataFns {
+			const char *className;
 			pfnIsRomSupported_t isRomSupported;
 			pfnNewRomData_t newRomData;
 			pfnSupportedFileExtensions_t supportedFileExtensions;
@@ -142,14 +154,14 @@ class RomDataFactoryPrivate
 		}
 
 #define GetRomDataFns(sys, attrs) \
-	{sys::isRomSupported_static, \
+	{#sys, sys::isRomSupported_static, \
 	 RomDataFactoryPrivate::RomData_ctor<sys>, \
 	 sys::supportedFileExtensions_static, \
 	 sys::supportedMimeTypes_static, \
 	 attrs, 0, 0}
 
 #define GetRomDataFns_addr(sys, attrs, address, size) \
-	{sys::isRomSupported_static, \
+	{#sys, sys::isRomSupported_static, \
 	 RomDataFactoryPrivate::RomData_ctor<sys>, \
 	 sys::supportedFileExtensions_static, \
 	 sys::supportedMimeTypes_static, \
@@ -210,6 +222,136 @@ class RomDataFactoryPrivate
 		 */
 		static void init_supportedMimeTypes(void);
 
+		// Magic number dispatch index for romDataFns_magic[].
+		// Key: (address << 32) | magic
+		// Value: Indexes into romDataFns_magic[], in table order.
+		// Built once per session, since create() is called for
+		// every file and a linear scan gets expensive.
+		static unordered_map<uint64_t, vector<uint8_t> > map_magicIdx;
+		// Distinct magic number addresses. (ascending order)
+		static vector<uint32_t> vec_magicAddrs;
+		// DetectCache class index for all RomDataFns tables.
+		// Key: (DetectCache::hashClassName(className) << 32) | address
+		// Value: RomDataFns entry.
+		static unordered_map<uint64_t, const RomDataFns*> map_classIdx;
+		static pthread_once_t once_magicIdx;
+
+		// File extensions supported by RomData subclasses
+		// with RDA_HAS_DPOVERLAY. (lowercase)
+		static unordered_set<string> set_exts_dpOverlay;
+		static pthread_once_t once_exts_dpOverlay;
+
+		/**
+		 * Initialize the "dangerous" permissions file extension set.
+		 *
+		 * Internal function; must be called using pthread_once().
+		 */
+		static void init_exts_dpOverlay(void);
+
+		// "Dangerous" permissions result cache.
+		// Key: FileId dev/ino hash
+		// Value: FileId and result. (FileId must match exactly)
+		struct DPOverlayCacheEntry {
+			FileSystem::FileId fileId;
+			bool dangerous;
+		};
+		static unordered_map<uint64_t, DPOverlayCacheEntry> map_dpOverlayCache;
+		static Mutex dpOverlayCacheMutex;
+
+		/**
+		 * Initialize the magic number dispatch index.
+		 *
+		 * Internal function; must be called using pthread_once().
+		 */
+		static void init_magicIdx(void);
+
+		/**
+		 * Header data used for RomData detection.
+		 */
+		struct DetectHeader {
+			RomData::DetectInfo info;
+			string file_ext;	// Storage for info.ext.
+			unsigned int attrs;	// Required RomDataAttr bitfield.
+
+			// 4,096+256 bytes from the ROM header.
+			// This should be enough to detect most systems.
+			union {
+				uint8_t u8[4096+256];
+				uint32_t u32[(4096+256)/4];
+			} header;
+		};
+
+		/**
+		 * Read the header data used for RomData detection.
+		 * @param file		[in] ROM file.
+		 * @param dh		[out] DetectHeader.
+		 * @param attrs		[in] RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+		 * @param preloaded	[in] If true, the header at address 0 was already loaded into dh.
+		 * @return True on success; false on read error.
+		 */
+		static bool readDetectHeader(IRpFile *file, DetectHeader &dh, unsigned int attrs, bool preloaded = false);
+
+		/**
+		 * Load header data for RomData detection.
+		 *
+		 * If the file supports zero-copy access, info.header.pData
+		 * will point directly to the file data. Otherwise, the data
+		 * will be read into dh.header.
+		 *
+		 * @param file	[in] ROM file.
+		 * @param dh	[in/out] DetectHeader.
+		 * @param addr	[in] Header address.
+		 * @param size	[in] Header size. (must be <= sizeof(dh.header))
+		 * @return Number of bytes loaded.
+		 */
+		static uint32_t loadHeaderData(IRpFile *file, DetectHeader &dh, uint32_t addr, uint32_t size);
+
+		/**
+		 * Create a RomData subclass using previously-read header data.
+		 *
+		 * NOTE: The header buffer may be overwritten if subclasses
+		 * with headers at non-zero addresses or footers are checked.
+		 *
+		 * If pDetect is specified, no RomData subclasses will be
+		 * constructed. Instead, pDetect will be set to the first
+		 * subclass whose isRomSupported_static() function succeeds,
+		 * and nullptr will be returned.
+		 *
+		 * @param file ROM file.
+		 * @param dh DetectHeader from readDetectHeader().
+		 * @param pDetect [out,opt] DetectResult for detection-only mode.
+		 * @param ppFns [out,opt] RomDataFns entry for the returned RomData subclass, or nullptr if not in a table.
+		 * @return RomData subclass, or nullptr if the ROM isn't supported.
+		 */
+		static RomData *create_int(IRpFile *file, DetectHeader &dh,
+			RomDataFactory::DetectResult *pDetect = nullptr,
+			const RomDataFns **ppFns = nullptr);
+
+		/**
+		 * Create a RomData subclass using previously-read header data.
+		 *
+		 * The DetectCache is checked first. If the file was opened
+		 * before and hasn't changed, the RomData subclass that was
+		 * selected last time is constructed directly.
+		 *
+		 * @param file ROM file.
+		 * @param dh DetectHeader from readDetectHeader().
+		 * @return RomData subclass, or nullptr if the ROM isn't supported.
+		 */
+		static RomData *create_cached(IRpFile *file, DetectHeader &dh);
+
+		/**
+		 * Set a DetectResult for a matching RomData subclass.
+		 * @param pDetect		[out] DetectResult
+		 * @param className		[in] Class name
+		 * @param pfnSupportedMimeTypes	[in] supportedMimeTypes_static() function
+		 * @param attrs			[in] RomDataAttr bitfield
+		 * @param romType		[in] Value returned by isRomSupported_static()
+		 */
+		static void setDetectResult(RomDataFactory::DetectResult *pDetect,
+			const char *className, pfnSupportedMimeTypes_t pfnSupportedMimeTypes,
+			unsigned int attrs, int romType);
+
 		/**
 		 * Check an ISO-9660 disc image for a game-specific file system.
 		 *
@@ -217,9 +359,10 @@ class RomDataFactoryPrivate
 		 * RomData subclasses support it, an ISO object will be returned.
 		 *
 		 * @param file ISO-9660 disc image
+		 * @param pDetect [out,opt] DetectResult for detection-only mode.
 		 * @return Game-specific RomData subclass, or nullptr if none are supported.
 		 */
-		static RomData *checkISO(IRpFile *file);
+		static RomData *checkISO(IRpFile *file, RomDataFactory::DetectResult *pDetect = nullptr);
 };
 
 /** RomDataFactoryPrivate **/
@@ -228,6 +371,14 @@ vector<RomDataFactory::ExtInfo> RomDataFactoryPrivate::vec_exts;
 vector<const char*> RomDataFactoryPrivate::vec_mimeTypes;
 pthread_once_t RomDataFactoryPrivate::once_exts = PTHREAD_ONCE_INIT;
 pthread_once_t RomDataFactoryPrivate::once_mimeTypes = PTHREAD_ONCE_INIT;
+unordered_map<uint64_t, vector<uint8_t> > RomDataFactoryPrivate::map_magicIdx;
+vector<uint32_t> RomDataFactoryPrivate::vec_magicAddrs;
+unordered_map<uint64_t, const RomDataFactoryPrivate::RomDataFns*> RomDataFactoryPrivate::map_classIdx;
+pthread_once_t RomDataFactoryPrivate::once_magicIdx = PTHREAD_ONCE_INIT;
+unordered_set<string> RomDataFactoryPrivate::set_exts_dpOverlay;
+pthread_once_t RomDataFactoryPrivate::once_exts_dpOverlay = PTHREAD_ONCE_INIT;
+unordered_map<uint64_t, RomDataFactoryPrivate::DPOverlayCacheEntry> RomDataFactoryPrivate::map_dpOverlayCache;
+Mutex RomDataFactoryPrivate::dpOverlayCacheMutex;
 
 #define ATTR_NONE		RomDataFactory::RDA_NONE
 #define ATTR_HAS_THUMBNAIL	RomDataFactory::RDA_HAS_THUMBNAIL
@@ -287,7 +438,7 @@ const RomDataFactoryPrivate::RomDataFns RomDataFactoryPrivate::romDataFns_magic[
 	GetRomDataFns_addr(Xbox360_STFS, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'PIRS'),
 	GetRomDataFns_addr(Xbox360_STFS, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'LIVE'),
 
-	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
+	{nullptr, nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
 };
 
 // RomData subclasses that use a header.
@@ -349,13 +500,13 @@ const RomDataFactoryPrivate::RomDataFns RomDataFactoryPrivate::romDataFns_header
 	// NOTE: ATTR_HAS_THUMBNAIL is needed for Xbox 360.
 	GetRomDataFns_addr(ISO, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES | ATTR_CHECK_ISO, 0x40000, 0x20),
 
-	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
+	{nullptr, nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
 };
 
 // RomData subclasses that use a footer.
 const RomDataFactoryPrivate::RomDataFns RomDataFactoryPrivate::romDataFns_footer[] = {
 	GetRomDataFns(VirtualBoy, ATTR_NONE),
-	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
+	{nullptr, nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
 };
 
 // Table of pointers to tables.
@@ -368,6 +519,65 @@ const RomDataFactoryPrivate::RomDataFns *const RomDataFactoryPrivate::romDataFns
 	nullptr
 };
 
+// File extensions that require reading headers at non-zero addresses.
+// Used to reduce overhead for file types that don't use this.
+// TODO: Don't hard-code this.
+// Use a pointer to supportedFileExtensions_static() instead?
+// NOTE: Must be sorted for a case-insensitive binary search.
+static const char *const exts_nonZeroAddr[] = {
+	".bin",		/* generic .bin */
+	".gg",		/* Game Gear */
+	".img",		/* CCD/IMG */
+	".iso",		/* ISO-9660 */
+	".min",		/* Pokémon Mini */
+	".sms",		/* Sega Master System */
+	".tgc",		/* game.com */
+	".xiso",	/* Xbox disc image */
+};
+
+/**
+ * Initialize the magic number dispatch index.
+ *
+ * Internal function; must be called using pthread_once().
+ */
+void RomDataFactoryPrivate::init_magicIdx(void)
+{
+	static_assert(ARRAY_SIZE(romDataFns_magic) <= 256,
+		"romDataFns_magic[] has too many entries for uint8_t indexes.");
+
+#ifdef HAVE_UNORDERED_MAP_RESERVE
+	map_magicIdx.reserve(ARRAY_SIZE(romDataFns_magic));
+#endif /* HAVE_UNORDERED_MAP_RESERVE */
+
+	uint8_t idx = 0;
+	for (const RomDataFns *fns = &romDataFns_magic[0];
+	     fns->supportedFileExtensions != nullptr; fns++, idx++)
+	{
+		// NOTE: Indexes are added in table order, so each
+		// vector is already sorted.
+		const uint64_t key = (static_cast<uint64_t>(fns->address) << 32) | fns->size;
+		map_magicIdx[key].emplace_back(idx);
+
+		auto iter = std::lower_bound(vec_magicAddrs.begin(), vec_magicAddrs.end(), fns->address);
+		if (iter == vec_magicAddrs.end() || *iter != fns->address) {
+			vec_magicAddrs.insert(iter, fns->address);
+		}
+	}
+
+	// DetectCache class index.
+	for (const RomDataFns *const *tblptr = &romDataFns_tbl[0];
+	     *tblptr != nullptr; tblptr++)
+	{
+		for (const RomDataFns *fns = *tblptr; fns->supportedFileExtensions != nullptr; fns++) {
+			const uint64_t key = (static_cast<uint64_t>(
+				DetectCache::hashClassName(fns->className)) << 32) | fns->address;
+			// NOTE: If a class is listed more than once with
+			// the same address, the first entry is used.
+			map_classIdx.emplace(key, fns);
+		}
+	}
+}
+
 /**
  * Attempt to open the other file in a Dreamcast .VMI+.VMS pair.
  * @param file One opened file in the .VMI+.VMS pair.
@@ -441,13 +651,14 @@ RomData *RomDataFactoryPrivate::openDreamcastVMSandVMI(IRpFile *file)
  * RomData subclasses support it, an ISO object will be returned.
  *
  * @param file ISO-9660 disc image
+ * @param pDetect [out,opt] DetectResult for detection-only mode.
  * @return Game-specific RomData subclass, or nullptr if none are supported.
  */
-RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
+RomData *RomDataFactoryPrivate::checkISO(IRpFile *file, RomDataFactory::DetectResult *pDetect)
 {
 	// Check for a CD file system with 2048-byte sectors.
 	CDROM_2352_Sector_t sector;
-	size_t size = file->seekAndRead(ISO_PVD_ADDRESS_2048, &sector.m1.data, sizeof(sector.m1.data));
+	size_t size = file->pread(ISO_PVD_ADDRESS_2048, &sector.m1.data, sizeof(sector.m1.data));
 	if (size != sizeof(sector.m1.data)) {
 		// Unable to read the PVD.
 		return nullptr;
@@ -460,7 +671,7 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 		pvd = reinterpret_cast<const ISO_Primary_Volume_Descriptor*>(sector.m1.data);
 	} else {
 		// Check for a CD file system with 2352-byte sectors.
-		size_t size = file->seekAndRead(ISO_PVD_ADDRESS_2352, &sector, sizeof(sector));
+		size_t size = file->pread(ISO_PVD_ADDRESS_2352, &sector, sizeof(sector));
 		if (size != sizeof(sector)) {
 			// Unable to read the PVD.
 			return nullptr;
@@ -483,7 +694,7 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 		// This might be an extracted XDVDFS.
 		// Check for the magic number at the base offset.
 		XDVDFS_Header xdvdfsHeader;
-		size = file->seekAndRead(XDVDFS_HEADER_LBA_OFFSET * XDVDFS_BLOCK_SIZE,
+		size = file->pread(XDVDFS_HEADER_LBA_OFFSET * XDVDFS_BLOCK_SIZE,
 			&xdvdfsHeader, sizeof(xdvdfsHeader));
 		if (size == sizeof(xdvdfsHeader)) {
 			// Check the magic numbers.
@@ -497,6 +708,11 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 	}
 
 	if (mayBeXbox) {
+		if (pDetect) {
+			setDetectResult(pDetect, "XboxDisc", XboxDisc::supportedMimeTypes_static,
+				ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES, 0);
+			return nullptr;
+		}
 		RomData *const romData = new XboxDisc(file);
 		if (romData->isValid()) {
 			// Got an Xbox disc.
@@ -506,8 +722,14 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 	}
 
 	// PlayStation 1 and 2
-	if (PlayStationDisc::isRomSupported_static(pvd) >= 0) {
+	int romType = PlayStationDisc::isRomSupported_static(pvd);
+	if (romType >= 0) {
 		// This might be a PS1 or PS2 disc.
+		if (pDetect) {
+			setDetectResult(pDetect, "PlayStationDisc", PlayStationDisc::supportedMimeTypes_static,
+				ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES, romType);
+			return nullptr;
+		}
 		RomData *const romData = new PlayStationDisc(file);
 		if (romData->isValid()) {
 			// Got a PS1 or PS2 disc.
@@ -517,8 +739,14 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 	}
 
 	// PlayStation Portable
-	if (PSP::isRomSupported_static(pvd) >= 0) {
+	romType = PSP::isRomSupported_static(pvd);
+	if (romType >= 0) {
 		// This might be a PSP disc.
+		if (pDetect) {
+			setDetectResult(pDetect, "PSP", PSP::supportedMimeTypes_static,
+				ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES, romType);
+			return nullptr;
+		}
 		RomData *const romData = new PSP(file);
 		if (romData->isValid()) {
 			// Got a PSP disc.
@@ -529,50 +757,68 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 
 	// Not a game-specific file system.
 	// Use the generic ISO-9660 parser.
+	if (pDetect) {
+		setDetectResult(pDetect, "ISO", ISO::supportedMimeTypes_static,
+			ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES, discType);
+		return nullptr;
+	}
 	return new ISO(file);
 }
 
-/** RomDataFactory **/
+/**
+ * Set a DetectResult for a matching RomData subclass.
+ * @param pDetect		[out] DetectResult
+ * @param className		[in] Class name
+ * @param pfnSupportedMimeTypes	[in] supportedMimeTypes_static() function
+ * @param attrs			[in] RomDataAttr bitfield
+ * @param romType		[in] Value returned by isRomSupported_static()
+ */
+void RomDataFactoryPrivate::setDetectResult(RomDataFactory::DetectResult *pDetect,
+	const char *className, pfnSupportedMimeTypes_t pfnSupportedMimeTypes,
+	unsigned int attrs, int romType)
+{
+	pDetect->className = className;
+	pDetect->mimeType = nullptr;
+	pDetect->attrs = (attrs & ~ATTR_CHECK_ISO);
+	pDetect->romType = romType;
+
+	// Use the first MIME type as the primary MIME type.
+	if (pfnSupportedMimeTypes) {
+		const char *const *mimeTypes = pfnSupportedMimeTypes();
+		if (mimeTypes) {
+			pDetect->mimeType = mimeTypes[0];
+		}
+	}
+}
 
 /**
- * Create a RomData subclass for the specified ROM file.
- *
- * NOTE: RomData::isValid() is checked before returning a
- * created RomData instance, so returned objects can be
- * assumed to be valid as long as they aren't nullptr.
- *
- * If imgbf is non-zero, at least one of the specified image
- * types must be supported by the RomData subclass in order to
- * be returned.
- *
- * @param file ROM file.
- * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
- * @return RomData subclass, or nullptr if the ROM isn't supported.
+ * Read the header data used for RomData detection.
+ * @param file		[in] ROM file.
+ * @param dh		[out] DetectHeader.
+ * @param attrs		[in] RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @param preloaded	[in] If true, the header at address 0 was already loaded into dh.
+ * @return True on success; false on read error.
  */
-RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
+bool RomDataFactoryPrivate::readDetectHeader(IRpFile *file, DetectHeader &dh, unsigned int attrs, bool preloaded)
 {
-	RomData::DetectInfo info;
+	RomData::DetectInfo &info = dh.info;
 
 	// Get the file size.
 	info.szFile = file->size();
 
 	// Read 4,096+256 bytes from the ROM header.
 	// This should be enough to detect most systems.
-	union {
-		uint8_t u8[4096+256];
-		uint32_t u32[(4096+256)/4];
-	} header;
-	file->rewind();
-	info.header.addr = 0;
-	info.header.pData = header.u8;
-	info.header.size = static_cast<uint32_t>(file->read(header.u8, sizeof(header.u8)));
+	if (!preloaded) {
+		loadHeaderData(file, dh, 0, sizeof(dh.header.u8));
+		file->rewind();
+	}
 	if (info.header.size == 0) {
 		// Read error.
-		return nullptr;
+		return false;
 	}
 
 	// File extension.
-	string file_ext;	// temporary storage
+	dh.file_ext.clear();
 	info.ext = nullptr;
 	if (file->isDevice()) {
 		// Device file. Assume it's a CD-ROM.
@@ -585,20 +831,88 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		if (!filename.empty()) {
 			const char *pExt = FileSystem::file_ext(filename);
 			if (pExt) {
-				file_ext = pExt;
-				info.ext = file_ext.c_str();
+				dh.file_ext = pExt;
+				info.ext = dh.file_ext.c_str();
 			}
 		}
 	}
 
+	// RDA_METADATA_ONLY isn't a subclass attribute.
+	dh.attrs = (attrs & ~RomDataFactory::RDA_METADATA_ONLY);
+	return true;
+}
+
+/**
+ * Load header data for RomData detection.
+ *
+ * If the file supports zero-copy access, info.header.pData
+ * will point directly to the file data. Otherwise, the data
+ * will be read into dh.header.
+ *
+ * @param file	[in] ROM file.
+ * @param dh	[in/out] DetectHeader.
+ * @param addr	[in] Header address.
+ * @param size	[in] Header size. (must be <= sizeof(dh.header))
+ * @return Number of bytes loaded.
+ */
+uint32_t RomDataFactoryPrivate::loadHeaderData(IRpFile *file, DetectHeader &dh, uint32_t addr, uint32_t size)
+{
+	RomData::DetectInfo &info = dh.info;
+	assert(size <= sizeof(dh.header.u8));
+	info.header.addr = addr;
+
+	size_t sz = size;
+	const uint8_t *const pView = file->view(addr, &sz);
+	if (pView && (reinterpret_cast<uintptr_t>(pView) % 4) == 0) {
+		// Zero-copy access.
+		// NOTE: Unaligned views aren't used, since isRomSupported()
+		// functions cast the header data to structs directly.
+		info.header.pData = pView;
+		info.header.size = static_cast<uint32_t>(sz);
+	} else {
+		info.header.pData = dh.header.u8;
+		info.header.size = static_cast<uint32_t>(
+			file->pread(addr, dh.header.u8, size));
+	}
+	return info.header.size;
+}
+
+/**
+ * Create a RomData subclass using previously-read header data.
+ *
+ * NOTE: The header buffer may be overwritten if subclasses
+ * with headers at non-zero addresses or footers are checked.
+ *
+ * If pDetect is specified, no RomData subclasses will be
+ * constructed. Instead, pDetect will be set to the first
+ * subclass whose isRomSupported_static() function succeeds,
+ * and nullptr will be returned.
+ *
+ * @param file ROM file.
+ * @param dh DetectHeader from readDetectHeader().
+ * @param pDetect [out,opt] DetectResult for detection-only mode.
+ * @param ppFns [out,opt] RomDataFns entry for the returned RomData subclass, or nullptr if not in a table.
+ * @return RomData subclass, or nullptr if the ROM isn't supported.
+ */
+RomData *RomDataFactoryPrivate::create_int(IRpFile *file, DetectHeader &dh,
+	RomDataFactory::DetectResult *pDetect, const RomDataFns **ppFns)
+{
+	RomData::DetectInfo &info = dh.info;
+	const unsigned int attrs = dh.attrs;
+	if (ppFns) {
+		*ppFns = nullptr;
+	}
+
 	// Special handling for Dreamcast .VMI+.VMS pairs.
-	if (info.ext != nullptr &&
+	// NOTE: Not needed for detection-only mode, since
+	// DreamcastSave can detect either file by itself.
+	if (!pDetect && info.ext != nullptr &&
 	    (!strcasecmp(info.ext, ".vms") ||
 	     !strcasecmp(info.ext, ".vmi")))
 	{
 		// Dreamcast .VMI+.VMS pair.
 		// Attempt to open the other file in the pair.
-		RomData *romData = RomDataFactoryPrivate::openDreamcastVMSandVMI(file);
+		RomData *romData = openDreamcastVMSandVMI(file);
 		if (romData) {
 			if (romData->isValid()) {
 				// .VMI+.VMS pair opened.
@@ -613,37 +927,78 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 
 	// Check RomData subclasses that take a header at 0
 	// and definitely have a 32-bit magic number in the header.
-	const RomDataFactoryPrivate::RomDataFns *fns =
-		&RomDataFactoryPrivate::romDataFns_magic[0];
-	for (; fns->supportedFileExtensions != nullptr; fns++) {
+	// The dispatch index is used to look up candidates for each
+	// distinct magic number address, instead of checking every
+	// entry in romDataFns_magic[].
+	pthread_once(&once_magicIdx, init_magicIdx);
+	uint8_t candidates[ARRAY_SIZE(romDataFns_magic)];
+	unsigned int candidate_count = 0;
+	for (uint32_t address : vec_magicAddrs) {
+		// NOTE: info.header.pData may point to the file data
+		// if zero-copy access is supported, so check the size.
+		assert(address % 4 == 0);
+		assert(address + sizeof(uint32_t) <= sizeof(dh.header.u32));
+		if (address + sizeof(uint32_t) > info.header.size)
+			continue;
+		const uint32_t magic = be32_to_cpu(
+			reinterpret_cast<const uint32_t*>(info.header.pData)[address/4]);
+		auto iter = map_magicIdx.find(
+			(static_cast<uint64_t>(address) << 32) | magic);
+		if (iter == map_magicIdx.end())
+			continue;
+
+		for (uint8_t idx : iter->second) {
+			assert(candidate_count < ARRAY_SIZE(candidates));
+			candidates[candidate_count++] = idx;
+		}
+	}
+
+	// Check the candidates in table order.
+	std::sort(&candidates[0], &candidates[candidate_count]);
+	for (unsigned int i = 0; i < candidate_count; i++) {
+		const RomDataFns *const fns =
+			&romDataFns_magic[candidates[i]];
 		if ((fns->attrs & attrs) != attrs) {
 			// This RomData subclass doesn't have the
 			// required attributes.
 			continue;
 		}
 
-		// Check the magic number.
-		// TODO: Verify alignment restrictions.
-		assert(fns->address % 4 == 0);
-		assert(fns->address + sizeof(uint32_t) <= sizeof(header.u32));
-		uint32_t magic = header.u32[fns->address/4];
-		if (be32_to_cpu(magic) == fns->size) {
-			// Found a matching magic number.
-			if (fns->isRomSupported(&info) >= 0) {
-				RomData *const romData = fns->newRomData(file);
-				if (romData->isValid()) {
-					// RomData subclass obtained.
-					return romData;
-				}
+		// Found a matching magic number.
+		const int romType = fns->isRomSupported(&info);
+		if (romType >= 0) {
+			if (pDetect) {
+				setDetectResult(pDetect, fns->className,
+					fns->supportedMimeTypes, fns->attrs, romType);
+				return nullptr;
+			}
 
-				// Not actually supported.
-				romData->unref();
+			RomData *const romData = fns->newRomData(file);
+			if (romData->isValid()) {
+				// RomData subclass obtained.
+				if (ppFns) {
+					*ppFns = fns;
+				}
+				return romData;
 			}
+
+			// Not actually supported.
+			romData->unref();
 		}
 	}
 
 	// Check for supported textures.
-	{
+	if (pDetect) {
+		const char *mimeType = nullptr;
+		if (!file->isDevice() &&
+		    FileFormatFactory::isTextureSupported(info.header.pData, info.header.size, &mimeType))
+		{
+			static const unsigned int FFF_ATTRS = ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA;
+			setDetectResult(pDetect, "RpTextureWrapper", nullptr, FFF_ATTRS, 0);
+			pDetect->mimeType = mimeType;
+			return nullptr;
+		}
+	} else {
 		// TODO: RpTextureWrapper::isRomSupported()?
 		RomData *const romData = new RpTextureWrapper(file);
 		if (romData->isValid()) {
@@ -657,7 +1012,8 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 
 	// Check other RomData subclasses that take a header,
 	// but don't have a simple 32-bit magic number check.
-	fns = &RomDataFactoryPrivate::romDataFns_header[0];
+	const RomDataFns *fns =
+		&romDataFns_header[0];
 	bool checked_exts = false;
 	for (; fns->supportedFileExtensions != nullptr; fns++) {
 		if ((fns->attrs & attrs) != attrs) {
@@ -673,34 +1029,16 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			if (!checked_exts) {
 				// Check the file extension to reduce overhead
 				// for file types that don't use this.
-				// TODO: Don't hard-code this.
-				// Use a pointer to supportedFileExtensions_static() instead?
-				static const char *const exts[] = {
-					".bin",		/* generic .bin */
-					".sms",		/* Sega Master System */
-					".gg",		/* Game Gear */
-					".tgc",		/* game.com */
-					".iso",		/* ISO-9660 */
-					".img",		/* CCD/IMG */
-					".xiso",	/* Xbox disc image */
-					".min",		/* Pokémon Mini */
-					nullptr
-				};
-
 				if (info.ext == nullptr) {
 					// No file extension...
 					break;
 				}
 
 				// Check for a matching extension.
-				bool found = false;
-				for (const char *const *ext = exts; *ext != nullptr; ext++) {
-					if (!strcasecmp(info.ext, *ext)) {
-						// Found a match!
-						found = true;
-					}
-				}
-				if (!found) {
+				if (!std::binary_search(&exts_nonZeroAddr[0],
+				     &exts_nonZeroAddr[ARRAY_SIZE(exts_nonZeroAddr)], info.ext,
+				     [](const char *a, const char *b) { return strcasecmp(a, b) < 0; }))
+				{
 					// No match.
 					break;
 				}
@@ -715,8 +1053,8 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			// for headers located at 0, since we
 			// read the whole 4096+256 bytes for these.
 			assert(fns->size != 0);
-			assert(fns->size <= sizeof(header));
-			if (fns->size == 0 || fns->size > sizeof(header))
+			assert(fns->size <= sizeof(dh.header));
+			if (fns->size == 0 || fns->size > sizeof(dh.header))
 				continue;
 
 			// Make sure the file is big enough to
@@ -725,20 +1063,30 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 				continue;
 
 			// Read the header data.
-			info.header.addr = fns->address;
-			int ret = file->seek(info.header.addr);
-			if (ret != 0)
-				continue;
-			info.header.size = static_cast<uint32_t>(file->read(header.u8, fns->size));
-			if (info.header.size != fns->size)
+			if (loadHeaderData(file, dh, fns->address, fns->size) != fns->size)
 				continue;
 		}
 
-		if (fns->isRomSupported(&info) >= 0) {
+		const int romType = fns->isRomSupported(&info);
+		if (romType >= 0) {
+			if (pDetect) {
+				if (fns->attrs & ATTR_CHECK_ISO) {
+					// Check for a game-specific ISO subclass.
+					checkISO(file, pDetect);
+					if (pDetect->className != nullptr)
+						return nullptr;
+					continue;
+				}
+
+				setDetectResult(pDetect, fns->className,
+					fns->supportedMimeTypes, fns->attrs, romType);
+				return nullptr;
+			}
+
 			RomData *romData;
-			if (fns->attrs & RDA_CHECK_ISO) {
+			if (fns->attrs & ATTR_CHECK_ISO) {
 				// Check for a game-specific ISO subclass.
-				romData = RomDataFactoryPrivate::checkISO(file);
+				romData = checkISO(file);
 			} else {
 				// Standard RomData subclass.
 				romData = fns->newRomData(file);
@@ -747,6 +1095,9 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			if (romData) {
 				if (romData->isValid()) {
 					// RomData subclass obtained.
+					if (ppFns) {
+						*ppFns = fns;
+					}
 					return romData;
 				}
 				// Not actually supported.
@@ -763,7 +1114,7 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 	}
 
 	bool readFooter = false;
-	fns = &RomDataFactoryPrivate::romDataFns_footer[0];
+	fns = &romDataFns_footer[0];
 	for (; fns->supportedFileExtensions != nullptr; fns++) {
 		if ((fns->attrs & attrs) != attrs) {
 			// This RomData subclass doesn't have the
@@ -783,9 +1134,7 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		if (!readFooter) {
 			static const int footer_size = 1024;
 			if (info.szFile > footer_size) {
-				info.header.addr = static_cast<uint32_t>(info.szFile - footer_size);
-				info.header.size = static_cast<uint32_t>(file->seekAndRead(info.header.addr, header.u8, footer_size));
-				if (info.header.size == 0) {
+				if (loadHeaderData(file, dh, static_cast<uint32_t>(info.szFile - footer_size), footer_size) == 0) {
 					// Seek and/or read error.
 					return nullptr;
 				}
@@ -793,10 +1142,20 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			readFooter = true;
 		}
 
-		if (fns->isRomSupported(&info) >= 0) {
+		const int romType = fns->isRomSupported(&info);
+		if (romType >= 0) {
+			if (pDetect) {
+				setDetectResult(pDetect, fns->className,
+					fns->supportedMimeTypes, fns->attrs, romType);
+				return nullptr;
+			}
+
 			RomData *const romData = fns->newRomData(file);
 			if (romData->isValid()) {
 				// RomData subclass obtained.
+				if (ppFns) {
+					*ppFns = fns;
+				}
 				return romData;
 			}
 
@@ -809,6 +1168,271 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 	return nullptr;
 }
 
+/**
+ * Create a RomData subclass using previously-read header data.
+ *
+ * The DetectCache is checked first. If the file was opened
+ * before and hasn't changed, the RomData subclass that was
+ * selected last time is constructed directly.
+ *
+ * @param file ROM file.
+ * @param dh DetectHeader from readDetectHeader().
+ * @return RomData subclass, or nullptr if the ROM isn't supported.
+ */
+RomData *RomDataFactoryPrivate::create_cached(IRpFile *file, DetectHeader &dh)
+{
+	// Only local files can be cached, since the file
+	// identity is based on the filename, size, and mtime.
+	// NOTE: If the file size doesn't match the on-disk size,
+	// the file is being decompressed transparently.
+	if (file->isDevice() || !DetectCache::isEnabled()) {
+		return create_int(file, dh);
+	}
+	const string filename = file->filename();
+	off64_t fileSize = 0;
+	time_t mtime = 0;
+	if (filename.empty() ||
+	    FileSystem::get_file_size_and_mtime(filename, &fileSize, &mtime) != 0 ||
+	    fileSize != dh.info.szFile)
+	{
+		return create_int(file, dh);
+	}
+
+	uint32_t classHash = 0, address = 0;
+	if (DetectCache::lookup(filename, fileSize, mtime, &classHash, &address)) {
+		pthread_once(&once_magicIdx, init_magicIdx);
+		auto iter = map_classIdx.find((static_cast<uint64_t>(classHash) << 32) | address);
+		if (iter != map_classIdx.end() &&
+		    (iter->second->attrs & dh.attrs) == dh.attrs)
+		{
+			const RomDataFns *const fns = iter->second;
+			RomData *romData;
+			if (fns->attrs & ATTR_CHECK_ISO) {
+				// Check for a game-specific ISO subclass.
+				romData = checkISO(file);
+			} else {
+				// Standard RomData subclass.
+				romData = fns->newRomData(file);
+			}
+
+			if (romData) {
+				if (romData->isValid()) {
+					// RomData subclass obtained.
+					return romData;
+				}
+				// Not actually supported.
+				romData->unref();
+			}
+		}
+
+		if (CancelToken::isCurrentCancelled()) {
+			// Detection was cancelled. The cached result
+			// may still be valid, so don't remove it.
+			return nullptr;
+		}
+
+		// Cached result is no longer valid.
+		// Check all subclasses.
+		file->rewind();
+	}
+
+	const RomDataFns *fns = nullptr;
+	RomData *const romData = create_int(file, dh, nullptr, &fns);
+	if (CancelToken::isCurrentCancelled()) {
+		// Detection was cancelled, so the result may be wrong.
+		if (romData) {
+			romData->unref();
+		}
+		return nullptr;
+	}
+	if (fns) {
+		DetectCache::store(filename, fileSize, mtime,
+			DetectCache::hashClassName(fns->className), fns->address);
+	} else if (classHash != 0) {
+		DetectCache::remove(filename);
+	}
+	return romData;
+}
+
+/** RomDataFactory **/
+
+/**
+ * Create a RomData subclass for the specified ROM file.
+ *
+ * NOTE: RomData::isValid() is checked before returning a
+ * created RomData instance, so returned objects can be
+ * assumed to be valid as long as they aren't nullptr.
+ *
+ * If imgbf is non-zero, at least one of the specified image
+ * types must be supported by the RomData subclass in order to
+ * be returned.
+ *
+ * If the calling thread's CancelToken is cancelled, detection
+ * stops early and nullptr is returned.
+ *
+ * @param file ROM file.
+ * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @return RomData subclass, or nullptr if the ROM isn't supported.
+ */
+RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
+{
+	RP_TRACE_ZONE("RomDataFactory::create");
+
+	if (CancelToken::isCurrentCancelled()) {
+		// Operation was cancelled.
+		return nullptr;
+	}
+
+	RomDataFactoryPrivate::DetectHeader dh;
+	if (!RomDataFactoryPrivate::readDetectHeader(file, dh, attrs)) {
+		// Read error.
+		return nullptr;
+	}
+
+	RomData *const romData = RomDataFactoryPrivate::create_cached(file, dh);
+	if (romData && CancelToken::isCurrentCancelled()) {
+		// Operation was cancelled while the RomData subclass
+		// was being constructed, so it may be incomplete.
+		romData->unref();
+		return nullptr;
+	}
+	if (romData && (attrs & RDA_METADATA_ONLY)) {
+		romData->setMetaDataOnly();
+	}
+	return romData;
+}
+
+/**
+ * Detect the RomData subclass for the specified ROM file
+ * without constructing it.
+ *
+ * Only the isRomSupported_static() functions are checked,
+ * so the RomData subclass isn't guaranteed to be valid.
+ * No RomData objects are constructed, and the header is read
+ * into a stack buffer. The filename and file extension are still
+ * copied into strings, and the first call initializes the
+ * magic number dispatch index.
+ *
+ * @param file ROM file.
+ * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @return DetectResult. (className is nullptr if the ROM isn't supported.)
+ */
+RomDataFactory::DetectResult RomDataFactory::detect(IRpFile *file, unsigned int attrs)
+{
+	DetectResult result = {nullptr, nullptr, RDA_NONE, -1};
+
+	RomDataFactoryPrivate::DetectHeader dh;
+	if (RomDataFactoryPrivate::readDetectHeader(file, dh, attrs)) {
+		RomDataFactoryPrivate::create_int(file, dh, &result);
+	}
+	return result;
+}
+
+/**
+ * Create RomData subclasses for multiple ROM files.
+ *
+ * This is equivalent to calling create() for each file,
+ * but files can optionally be processed concurrently by
+ * a thread pool, which overlaps the header reads.
+ *
+ * If asynchronous reads are available (io_uring on Linux),
+ * the detection headers are read with many reads in flight
+ * at once before running detection on the thread pool.
+ *
+ * NOTE: Each IRpFile must be a separate file object,
+ * since the files may be accessed concurrently.
+ *
+ * @param files ROM files.
+ * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @param threadCount Number of threads to use. (0 for the number of CPUs; 1 for the calling thread only)
+ * @return RomData subclasses, in the same order as files. (nullptr for unsupported files)
+ */
+vector<RomData*> RomDataFactory::createBatch(const vector<IRpFile*> &files, unsigned int attrs, unsigned int threadCount)
+{
+	vector<RomData*> vec_romData(files.size(), nullptr);
+	if (files.empty())
+		return vec_romData;
+
+	if (threadCount == 0) {
+		threadCount = ThreadPool::cpuCount();
+	}
+	if (threadCount > files.size()) {
+		threadCount = static_cast<unsigned int>(files.size());
+	}
+
+	ThreadPool pool(threadCount);
+	AsyncReader asyncReader;
+	if (!asyncReader.isAsync() || files.size() < 2) {
+		// Asynchronous reads aren't available.
+		// Each thread reads its own headers.
+		pool.parallelFor(files.size(), [&files, &vec_romData, attrs](size_t i) {
+			IRpFile *const file = files[i];
+			if (!file || !file->isOpen())
+				return;
+
+			RomDataFactoryPrivate::DetectHeader dh;
+			if (RomDataFactoryPrivate::readDetectHeader(file, dh, attrs)) {
+				RomData *const romData = RomDataFactoryPrivate::create_cached(file, dh);
+				if (romData && (attrs & RDA_METADATA_ONLY)) {
+					romData->setMetaDataOnly();
+				}
+				vec_romData[i] = romData;
+			}
+		});
+		return vec_romData;
+	}
+
+	// Asynchronous reads are available.
+	// The detection headers for each chunk of files are read
+	// with all of the reads in flight at once, then the
+	// thread pool runs detection on the loaded headers.
+	// NOTE: Files that don't support direct reads, e.g. compressed
+	// files, are read synchronously by AsyncReader, so they're
+	// loaded by the thread pool instead.
+	static const size_t ASYNC_CHUNK_SIZE = 256;
+	const size_t chunkSize = std::min(files.size(), ASYNC_CHUNK_SIZE);
+	unique_ptr<RomDataFactoryPrivate::DetectHeader[]> dhs(new RomDataFactoryPrivate::DetectHeader[chunkSize]);
+	unique_ptr<bool[]> preloaded(new bool[chunkSize]);
+
+	for (size_t base = 0; base < files.size(); base += chunkSize) {
+		const size_t count = std::min(chunkSize, files.size() - base);
+		for (size_t i = 0; i < count; i++) {
+			IRpFile *const file = files[base + i];
+			preloaded[i] = (file && file->isOpen() && file->nativeFd() >= 0);
+			if (!preloaded[i])
+				continue;
+
+			RomData::DetectInfo &info = dhs[i].info;
+			info.header.addr = 0;
+			info.header.pData = dhs[i].header.u8;
+			info.header.size = 0;
+			asyncReader.read(file, 0, dhs[i].header.u8, sizeof(dhs[i].header.u8),
+				[&info](size_t size, int err) {
+					RP_UNUSED(err);
+					info.header.size = static_cast<uint32_t>(size);
+				});
+		}
+		asyncReader.wait();
+
+		pool.parallelFor(count, [&files, &vec_romData, &dhs, &preloaded, base, attrs](size_t i) {
+			IRpFile *const file = files[base + i];
+			if (!file || !file->isOpen())
+				return;
+
+			RomDataFactoryPrivate::DetectHeader &dh = dhs[i];
+			if (RomDataFactoryPrivate::readDetectHeader(file, dh, attrs, preloaded[i])) {
+				RomData *const romData = RomDataFactoryPrivate::create_cached(file, dh);
+				if (romData && (attrs & RDA_METADATA_ONLY)) {
+					romData->setMetaDataOnly();
+				}
+				vec_romData[base + i] = romData;
+			}
+		});
+	}
+
+	return vec_romData;
+}
+
 /**
  * Initialize the vector of supported file extensions.
  * Used for Win32 COM registration.
@@ -820,23 +1444,16 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
  */
 void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 {
-	// In order to handle multiple RomData subclasses
-	// that support the same extensions, we're using
-	// an unordered_map<string, unsigned int>. If any of the
-	// handlers for a given extension support thumbnails,
-	// then the thumbnail handlers will be registered.
-	//
-	// The actual data is stored in the vector<ExtInfo>.
-	unordered_map<string, unsigned int> map_exts;
-
-	static const size_t reserve_size =
-		(ARRAY_SIZE(romDataFns_magic) +
-		 ARRAY_SIZE(romDataFns_header) +
-		 ARRAY_SIZE(romDataFns_footer)) * 2;
-	vec_exts.reserve(reserve_size);
-#ifdef HAVE_UNORDERED_MAP_RESERVE
-	map_exts.reserve(reserve_size);
-#endif /* HAVE_UNORDERED_MAP_RESERVE */
+	// Multiple RomData subclasses may support the same
+	// extensions. All extensions are collected, sorted,
+	// and then merged, with the attributes ORed together.
+	// If any of the handlers for a given extension support
+	// thumbnails, then the thumbnail handlers will be registered.
+	const vector<const char*> &vec_exts_fileFormat = FileFormatFactory::supportedFileExtensions();
+	vec_exts.reserve((ARRAY_SIZE(romDataFns_magic) +
+			  ARRAY_SIZE(romDataFns_header) +
+			  ARRAY_SIZE(romDataFns_footer)) * 2 +
+			 vec_exts_fileFormat.size());
 
 	for (const RomDataFns *const *tblptr = &romDataFns_tbl[0];
 	     *tblptr != nullptr; tblptr++)
@@ -848,45 +1465,37 @@ void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 				continue;
 
 			for (; *sys_exts != nullptr; sys_exts++) {
-				auto iter = map_exts.find(*sys_exts);
-				if (iter != map_exts.end()) {
-					// We already had this extension.
-					// Update its attributes.
-					iter->second |= fns->attrs;
-				} else {
-					// First time encountering this extension.
-					map_exts[*sys_exts] = fns->attrs;
-					vec_exts.emplace_back(RomDataFactory::ExtInfo(
-						*sys_exts, fns->attrs));
-				}
+				vec_exts.emplace_back(*sys_exts, fns->attrs);
 			}
 		}
 	}
 
 	// Get file extensions from FileFormatFactory.
 	static const unsigned int FFF_ATTRS = ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA;
-	vector<const char*> vec_exts_fileFormat = FileFormatFactory::supportedFileExtensions();
-	std::for_each(vec_exts_fileFormat.cbegin(), vec_exts_fileFormat.cend(),
-		[&map_exts](const char *ext) {
-			auto iter = map_exts.find(ext);
-			if (iter != map_exts.end()) {
-				// We already had this extension.
-				// Update its attributes.
-				iter->second |= FFF_ATTRS;
-			} else {
-				// First time encountering this extension.
-				map_exts[ext] = FFF_ATTRS;
-				vec_exts.emplace_back(RomDataFactory::ExtInfo(ext, FFF_ATTRS));
-			}
-		}
-	);
+	for (const char *ext : vec_exts_fileFormat) {
+		vec_exts.emplace_back(ext, FFF_ATTRS);
+	}
 
-	// Make sure the vector's attributes fields are up to date.
-	std::for_each(vec_exts.begin(), vec_exts.end(),
-		[&map_exts](RomDataFactory::ExtInfo &extInfo) {
-			extInfo.attrs = map_exts[extInfo.ext];
+	// Sort the extensions, then merge duplicates.
+	std::sort(vec_exts.begin(), vec_exts.end(),
+		[](const RomDataFactory::ExtInfo &a, const RomDataFactory::ExtInfo &b) {
+			return strcmp(a.ext, b.ext) < 0;
 		}
 	);
+	if (!vec_exts.empty()) {
+		auto dest = vec_exts.begin();
+		const auto vec_exts_cend = vec_exts.cend();
+		for (auto iter = dest + 1; iter != vec_exts_cend; ++iter) {
+			if (!strcmp(dest->ext, iter->ext)) {
+				// Same extension. Merge the attributes.
+				dest->attrs |= iter->attrs;
+			} else {
+				*(++dest) = *iter;
+			}
+		}
+		vec_exts.erase(dest + 1, vec_exts.end());
+	}
+	vec_exts.shrink_to_fit();
 }
 
 /**
@@ -897,6 +1506,9 @@ void RomDataFactoryPrivate::init_supportedFileExtensions(void)
  * indicating if the file type handler supports thumbnails
  * and/or may have "dangerous" permissions.
  *
+ * The list is sorted, and duplicates are merged.
+ * It's built once per session.
+ *
  * @return All supported file extensions, including the leading dot.
  */
 const vector<RomDataFactory::ExtInfo> &RomDataFactory::supportedFileExtensions(void)
@@ -915,20 +1527,14 @@ void RomDataFactoryPrivate::init_supportedMimeTypes(void)
 {
 	// TODO: Add generic types, e.g. application/octet-stream?
 
-	// In order to handle multiple RomData subclasses
-	// that support the same MIME types, we're using
-	// an unordered_set<string>. The actual data
-	// is stored in the vector<const char*>.
-	unordered_set<string> set_mimeTypes;
-
-	static const size_t reserve_size =
-		(ARRAY_SIZE(romDataFns_magic) +
-		 ARRAY_SIZE(romDataFns_header) +
-		 ARRAY_SIZE(romDataFns_footer)) * 2;
-	vec_mimeTypes.reserve(reserve_size);
-#ifdef HAVE_UNORDERED_SET_RESERVE
-	set_mimeTypes.reserve(reserve_size);
-#endif /* HAVE_UNORDERED_SET_RESERVE */
+	// Multiple RomData subclasses may support the same
+	// MIME types. All MIME types are collected, sorted,
+	// and then duplicates are removed.
+	const vector<const char*> &vec_mimeTypes_fileFormat = FileFormatFactory::supportedMimeTypes();
+	vec_mimeTypes.reserve((ARRAY_SIZE(romDataFns_magic) +
+			       ARRAY_SIZE(romDataFns_header) +
+			       ARRAY_SIZE(romDataFns_footer)) * 2 +
+			      vec_mimeTypes_fileFormat.size());
 
 	for (const RomDataFns *const *tblptr = &romDataFns_tbl[0];
 	     *tblptr != nullptr; tblptr++)
@@ -940,32 +1546,30 @@ void RomDataFactoryPrivate::init_supportedMimeTypes(void)
 				continue;
 
 			for (; *sys_mimeTypes != nullptr; sys_mimeTypes++) {
-				auto iter = set_mimeTypes.find(*sys_mimeTypes);
-				if (iter == set_mimeTypes.end()) {
-					set_mimeTypes.insert(*sys_mimeTypes);
-					vec_mimeTypes.emplace_back(*sys_mimeTypes);
-				}
+				vec_mimeTypes.emplace_back(*sys_mimeTypes);
 			}
 		}
 	}
 
 	// Get MIME types from FileFormatFactory.
-	vector<const char*> vec_mimeTypes_fileFormat = FileFormatFactory::supportedMimeTypes();
-	std::for_each(vec_mimeTypes_fileFormat.cbegin(), vec_mimeTypes_fileFormat.cend(),
-		[&set_mimeTypes](const char *mimeType) {
-			auto iter = set_mimeTypes.find(mimeType);
-			if (iter == set_mimeTypes.end()) {
-				set_mimeTypes.insert(mimeType);
-				vec_mimeTypes.emplace_back(mimeType);
-			}
-		}
-	);
+	vec_mimeTypes.insert(vec_mimeTypes.end(),
+		vec_mimeTypes_fileFormat.cbegin(), vec_mimeTypes_fileFormat.cend());
+
+	// Sort the MIME types and remove duplicates.
+	std::sort(vec_mimeTypes.begin(), vec_mimeTypes.end(),
+		[](const char *a, const char *b) { return strcmp(a, b) < 0; });
+	vec_mimeTypes.erase(std::unique(vec_mimeTypes.begin(), vec_mimeTypes.end(),
+		[](const char *a, const char *b) { return !strcmp(a, b); }), vec_mimeTypes.end());
+	vec_mimeTypes.shrink_to_fit();
 }
 
 /**
  * Get all supported MIME types.
  * Used for KFileMetaData.
  *
+ * The list is sorted, and duplicates are removed.
+ * It's built once per session.
+ *
  * @return All supported MIME types.
  */
 const vector<const char*> &RomDataFactory::supportedMimeTypes(void)
@@ -974,4 +1578,141 @@ const vector<const char*> &RomDataFactory::supportedMimeTypes(void)
 	return RomDataFactoryPrivate::vec_mimeTypes;
 }
 
+/** "Dangerous" permissions overlay **/
+
+/**
+ * Initialize the "dangerous" permissions file extension set.
+ *
+ * Internal function; must be called using pthread_once().
+ */
+void RomDataFactoryPrivate::init_exts_dpOverlay(void)
+{
+	for (const RomDataFns *const *tblptr = &romDataFns_tbl[0];
+	     *tblptr != nullptr; tblptr++)
+	{
+		for (const RomDataFns *fns = *tblptr; fns->supportedFileExtensions != nullptr; fns++) {
+			if (!(fns->attrs & ATTR_HAS_DPOVERLAY))
+				continue;
+			const char *const *sys_exts = fns->supportedFileExtensions();
+			if (!sys_exts)
+				continue;
+
+			for (; *sys_exts != nullptr; sys_exts++) {
+				string ext_lower(*sys_exts);
+				std::transform(ext_lower.begin(), ext_lower.end(), ext_lower.begin(),
+					[](char c) { return TOLOWER(c); });
+				set_exts_dpOverlay.emplace(std::move(ext_lower));
+			}
+		}
+	}
+}
+
+/**
+ * Check if a file might have "dangerous" permissions,
+ * based on its file extension. No file I/O is done.
+ *
+ * Only a few RomData subclasses have RDA_HAS_DPOVERLAY, so
+ * overlay icon handlers can use this to reject most files
+ * without opening them.
+ *
+ * NOTE: A ".gz" extension is skipped, since compressed
+ * files are opened using FM_OPEN_READ_GZ.
+ *
+ * @param filename Filename. (UTF-8; directory is optional)
+ * @return True if a RomData subclass with RDA_HAS_DPOVERLAY supports the file extension.
+ */
+bool RomDataFactory::isDangerousPermissionsCandidate(const char *filename)
+{
+	assert(filename != nullptr);
+	if (!filename || filename[0] == '\0')
+		return false;
+
+	pthread_once(&RomDataFactoryPrivate::once_exts_dpOverlay, RomDataFactoryPrivate::init_exts_dpOverlay);
+
+	string s_filename(filename);
+	const char *pExt = FileSystem::file_ext(s_filename);
+	if (pExt && !strcasecmp(pExt, ".gz")) {
+		// Check the extension before ".gz".
+		s_filename.resize(pExt - s_filename.c_str());
+		pExt = FileSystem::file_ext(s_filename);
+	}
+	if (!pExt)
+		return false;
+
+	string ext_lower(pExt);
+	std::transform(ext_lower.begin(), ext_lower.end(), ext_lower.begin(),
+		[](char c) { return TOLOWER(c); });
+	return (RomDataFactoryPrivate::set_exts_dpOverlay.find(ext_lower) !=
+		RomDataFactoryPrivate::set_exts_dpOverlay.end());
+}
+
+/**
+ * Check if a local file has "dangerous" permissions.
+ *
+ * This is intended for overlay icon handlers, which are
+ * called for every visible file:
+ * - Files rejected by isDangerousPermissionsCandidate()
+ *   aren't opened.
+ * - Results are cached in memory, keyed on the file identity
+ *   (see FileSystem::FileId), so the RomData object is only
+ *   created the first time a file is checked, or after the
+ *   file has been modified.
+ *
+ * @param filename Local filename. (UTF-8)
+ * @return True if the file has "dangerous" permissions; false if not.
+ */
+bool RomDataFactory::hasDangerousPermissions(const char *filename)
+{
+	if (!isDangerousPermissionsCandidate(filename)) {
+		// No RomData subclass with RDA_HAS_DPOVERLAY
+		// supports this file extension.
+		return false;
+	}
+
+	// Check the result cache.
+	// NOTE: If the file identity can't be retrieved,
+	// the result won't be cached.
+	FileSystem::FileId fileId;
+	const bool hasFileId = (FileSystem::get_file_id(filename, &fileId) == 0);
+	const uint64_t key = (hasFileId ? (fileId.ino ^ (fileId.dev * 0x9E3779B97F4A7C15ULL)) : 0);
+	if (hasFileId) {
+		MutexLocker cacheLock(RomDataFactoryPrivate::dpOverlayCacheMutex);
+		auto iter = RomDataFactoryPrivate::map_dpOverlayCache.find(key);
+		if (iter != RomDataFactoryPrivate::map_dpOverlayCache.end() &&
+		    iter->second.fileId == fileId)
+		{
+			// Found a cached result.
+			return iter->second.dangerous;
+		}
+	}
+
+	// Open the ROM file.
+	bool dangerous = false;
+	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
+	if (file->isOpen()) {
+		RomData *const romData = create(file, RDA_HAS_DPOVERLAY);
+		if (romData) {
+			dangerous = romData->hasDangerousPermissions();
+			romData->unref();
+		}
+	}
+	file->unref();
+
+	if (hasFileId) {
+		// Save the result.
+		// Maximum number of cached results.
+		// The cache is cleared when this is reached.
+		static const size_t DPOVERLAY_CACHE_MAX = 4096;
+		MutexLocker cacheLock(RomDataFactoryPrivate::dpOverlayCacheMutex);
+		if (RomDataFactoryPrivate::map_dpOverlayCache.size() >= DPOVERLAY_CACHE_MAX) {
+			RomDataFactoryPrivate::map_dpOverlayCache.clear();
+		}
+		RomDataFactoryPrivate::DPOverlayCacheEntry &entry =
+			RomDataFactoryPrivate::map_dpOverlayCache[key];
+		entry.fileId = fileId;
+		entry.dangerous = dangerous;
+	}
+	return dangerous;
+}
+
 }
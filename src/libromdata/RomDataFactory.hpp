@@ -53,6 +53,13 @@ class RomDataFactory
 			// checking a device node.
 			RDA_SUPPORTS_DEVICES	= (1U << 3),
 
+			// Create the RomData object in metadata-only mode.
+			// This isn't a subclass attribute; it's only used
+			// by create() and createBatch(). Field data and
+			// internal images will not be loaded.
+			// (See RomData::setMetaDataOnly().)
+			RDA_METADATA_ONLY	= (1U << 4),
+
 			// Check for game-specific disc file systems.
 			// (For internal RomDataFactory use only.)
 			RDA_CHECK_ISO		= (1U << 8),
@@ -69,12 +76,65 @@ class RomDataFactory
 		 * types must be supported by the RomData subclass in order to
 		 * be returned.
 		 *
+		 * If the calling thread's CancelToken is cancelled, detection
+		 * stops early and nullptr is returned.
+		 *
 		 * @param file ROM file.
 		 * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
 		 * @return RomData subclass, or nullptr if the ROM isn't supported.
 		 */
 		static LibRpBase::RomData *create(LibRpFile::IRpFile *file, unsigned int attrs = 0);
 
+		/**
+		 * Detection result from detect().
+		 */
+		struct DetectResult {
+			const char *className;	// RomData subclass name, or nullptr if not supported.
+			const char *mimeType;	// Primary MIME type, or nullptr if unknown.
+			unsigned int attrs;	// RomDataAttr bitfield for the subclass.
+			int romType;		// Subclass-specific ROM type from isRomSupported().
+		};
+
+		/**
+		 * Detect the RomData subclass for the specified ROM file
+		 * without constructing it.
+		 *
+		 * Only the isRomSupported_static() functions are checked,
+		 * so the RomData subclass isn't guaranteed to be valid.
+		 * No RomData objects are constructed, and the header is read
+		 * into a stack buffer. The filename and file extension are still
+		 * copied into strings, and the first call initializes the
+		 * magic number dispatch index.
+		 *
+		 * @param file ROM file.
+		 * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+		 * @return DetectResult. (className is nullptr if the ROM isn't supported.)
+		 */
+		static DetectResult detect(LibRpFile::IRpFile *file, unsigned int attrs = 0);
+
+		/**
+		 * Create RomData subclasses for multiple ROM files.
+		 *
+		 * This is equivalent to calling create() for each file,
+		 * but files can optionally be processed concurrently by
+		 * a thread pool, which overlaps the header reads.
+		 *
+		 * If asynchronous reads are available (io_uring on Linux),
+		 * the detection headers are read with many reads in flight
+		 * at once before running detection on the thread pool.
+		 *
+		 * NOTE: Each IRpFile must be a separate file object,
+		 * since the files may be accessed concurrently.
+		 *
+		 * @param files ROM files.
+		 * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+		 * @param threadCount Number of threads to use. (0 for the number of CPUs; 1 for the calling thread only)
+		 * @return RomData subclasses, in the same order as files. (nullptr for unsupported files)
+		 */
+		static std::vector<LibRpBase::RomData*> createBatch(
+			const std::vector<LibRpFile::IRpFile*> &files,
+			unsigned int attrs = 0, unsigned int threadCount = 1);
+
 		struct ExtInfo {
 			const char *ext;
 			unsigned int attrs;
@@ -93,6 +153,9 @@ class RomDataFactory
 		 * indicating if the file type handler supports thumbnails
 		 * and/or may have "dangerous" permissions.
 		 *
+		 * The list is sorted, and duplicates are merged.
+		 * It's built once per session.
+		 *
 		 * @return All supported file extensions, including the leading dot.
 		 */
 		static const std::vector<ExtInfo> &supportedFileExtensions(void);
@@ -101,9 +164,48 @@ class RomDataFactory
 		 * Get all supported MIME types.
 		 * Used for KFileMetaData.
 		 *
+		 * The list is sorted, and duplicates are removed.
+		 * It's built once per session.
+		 *
 		 * @return All supported MIME types.
 		 */
 		static const std::vector<const char*> &supportedMimeTypes(void);
+
+	public:
+		/** "Dangerous" permissions overlay **/
+
+		/**
+		 * Check if a file might have "dangerous" permissions,
+		 * based on its file extension. No file I/O is done.
+		 *
+		 * Only a few RomData subclasses have RDA_HAS_DPOVERLAY, so
+		 * overlay icon handlers can use this to reject most files
+		 * without opening them.
+		 *
+		 * NOTE: A ".gz" extension is skipped, since compressed
+		 * files are opened using FM_OPEN_READ_GZ.
+		 *
+		 * @param filename Filename. (UTF-8; directory is optional)
+		 * @return True if a RomData subclass with RDA_HAS_DPOVERLAY supports the file extension.
+		 */
+		static bool isDangerousPermissionsCandidate(const char *filename);
+
+		/**
+		 * Check if a local file has "dangerous" permissions.
+		 *
+		 * This is intended for overlay icon handlers, which are
+		 * called for every visible file:
+		 * - Files rejected by isDangerousPermissionsCandidate()
+		 *   aren't opened.
+		 * - Results are cached in memory, keyed on the file identity
+		 *   (see FileSystem::FileId), so the RomData object is only
+		 *   created the first time a file is checked, or after the
+		 *   file has been modified.
+		 *
+		 * @param filename Local filename. (UTF-8)
+		 * @return True if the file has "dangerous" permissions; false if not.
+		 */
+		static bool hasDangerousPermissions(const char *filename);
 };
 
 }
@@ -16,6 +16,17 @@
 
 namespace LibRomData {
 
+/**
+ * amiibo identification data.
+ *
+ * The data is loaded from amiibo-data.bin, which is read into
+ * memory on first use. The user's configuration directory is
+ * checked first, followed by the installed copy. The file is
+ * reloaded if its timestamp changes. If neither file is valid,
+ * a built-in copy of the data is used.
+ *
+ * Returned strings remain valid until shutdown.
+ */
 class AmiiboData
 {
 	private:
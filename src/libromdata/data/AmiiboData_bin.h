@@ -0,0 +1,1434 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * AmiiboData_bin.h: Built-in copy of amiibo-data.bin.                     *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_amiibo_bin.py.                            *
+ * Source: AmiiboData_data.txt                                             *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_AMIIBODATA_BIN_H__
+#define __ROMPROPERTIES_LIBROMDATA_AMIIBODATA_BIN_H__
+
+#include <stdint.h>
+#include "common.h"
+
+namespace LibRomData { namespace AmiiboData_bin {
+
+// amiibo-data.bin (22524 bytes)
+// Sections must be 32-bit aligned.
+static const ALIGNED_VAR(4, uint8_t amiibo_data_bin[22524]) = {
+	0x52, 0x50, 0x2D, 0x41, 0x4D, 0x49, 0x49, 0x42, 0x4F, 0x2D, 0x44, 0x41, 0x54, 0x41, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x37, 0x00, 0x00, 0xCB, 0x20, 0x00, 0x00,
+	0x40, 0x00, 0x00, 0x00, 0xE4, 0x00, 0x00, 0x00, 0xD0, 0x03, 0x00, 0x00, 0xC6, 0x02, 0x00, 0x00,
+	0x00, 0x1A, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x60, 0x1A, 0x00, 0x00, 0x9A, 0x03, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00,
+	0x25, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00,
+	0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00,
+	0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00,
+	0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00,
+	0x39, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00,
+	0x5A, 0x00, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x68, 0x00, 0x00, 0x00,
+	0x74, 0x00, 0x00, 0x00, 0x7C, 0x00, 0x00, 0x00, 0x87, 0x00, 0x00, 0x00, 0x98, 0x00, 0x00, 0x00,
+	0x9C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA5, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00,
+	0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00,
+	0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xBD, 0x00, 0x00, 0x00, 0xBD, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xC6, 0x00, 0x00, 0x00, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xD4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xE0, 0x00, 0x00, 0x00, 0xEA, 0x00, 0x00, 0x00, 0xF5, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x01, 0x00, 0x00, 0x14, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x1E, 0x01, 0x00, 0x00, 0x26, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x01, 0x00, 0x00, 0x3A, 0x01, 0x00, 0x00,
+	0x49, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x58, 0x01, 0x00, 0x00,
+	0x66, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x74, 0x01, 0x00, 0x00, 0x7B, 0x01, 0x00, 0x00, 0x86, 0x01, 0x00, 0x00,
+	0x92, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB0, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xB7, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xBD, 0x01, 0x00, 0x00,
+	0x00, 0x01, 0x00, 0x00, 0xC7, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0xCD, 0x01, 0x00, 0x00,
+	0x00, 0x03, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0xD3, 0x01, 0x00, 0x00,
+	0x00, 0x04, 0x00, 0x00, 0xDE, 0x01, 0x00, 0x00, 0x01, 0x04, 0x00, 0x00, 0xE7, 0x01, 0x00, 0x00,
+	0x00, 0x05, 0x00, 0x00, 0xF7, 0x01, 0x00, 0x00, 0xFF, 0x05, 0x00, 0x00, 0xFE, 0x01, 0x00, 0x00,
+	0x00, 0x06, 0x00, 0x00, 0x11, 0x02, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x1C, 0x02, 0x00, 0x00,
+	0x00, 0x08, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00, 0xFF, 0x08, 0x00, 0x00, 0x22, 0x02, 0x00, 0x00,
+	0x00, 0x09, 0x00, 0x00, 0x3B, 0x02, 0x00, 0x00, 0x00, 0x0A, 0x00, 0x00, 0x46, 0x02, 0x00, 0x00,
+	0x00, 0x13, 0x00, 0x00, 0x4B, 0x02, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x51, 0x02, 0x00, 0x00,
+	0x00, 0x15, 0x00, 0x00, 0x59, 0x02, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x60, 0x02, 0x00, 0x00,
+	0x00, 0x23, 0x00, 0x00, 0x64, 0x02, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x71, 0x02, 0x00, 0x00,
+	0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x00, 0x00, 0x7F, 0x02, 0x00, 0x00,
+	0x00, 0xC0, 0x00, 0x00, 0x8B, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x98, 0x02, 0x00, 0x00,
+	0x01, 0x00, 0x01, 0x00, 0x9D, 0x02, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0xA7, 0x02, 0x00, 0x00,
+	0x01, 0x01, 0x01, 0x00, 0xAD, 0x02, 0x00, 0x00, 0x00, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x02, 0x01, 0x00, 0xB3, 0x02, 0x00, 0x00, 0x00, 0x03, 0x01, 0x00, 0xBD, 0x02, 0x00, 0x00,
+	0x00, 0x05, 0x01, 0x00, 0xCF, 0x02, 0x00, 0x00, 0x00, 0x06, 0x01, 0x00, 0xD5, 0x02, 0x00, 0x00,
+	0x00, 0x07, 0x01, 0x00, 0xDC, 0x02, 0x00, 0x00, 0x00, 0x08, 0x01, 0x00, 0xE2, 0x02, 0x00, 0x00,
+	0x00, 0x40, 0x01, 0x00, 0xE9, 0x02, 0x00, 0x00, 0x00, 0x41, 0x01, 0x00, 0xF2, 0x02, 0x00, 0x00,
+	0x00, 0x80, 0x01, 0x00, 0xFB, 0x02, 0x00, 0x00, 0x00, 0x81, 0x01, 0x00, 0x04, 0x03, 0x00, 0x00,
+	0x01, 0x81, 0x01, 0x00, 0x1D, 0x03, 0x00, 0x00, 0x02, 0x81, 0x01, 0x00, 0x36, 0x03, 0x00, 0x00,
+	0x03, 0x81, 0x01, 0x00, 0x4A, 0x03, 0x00, 0x00, 0x00, 0x82, 0x01, 0x00, 0x5E, 0x03, 0x00, 0x00,
+	0x01, 0x82, 0x01, 0x00, 0x6A, 0x03, 0x00, 0x00, 0x00, 0x83, 0x01, 0x00, 0x72, 0x03, 0x00, 0x00,
+	0x01, 0x83, 0x01, 0x00, 0x7B, 0x03, 0x00, 0x00, 0x00, 0x84, 0x01, 0x00, 0x8F, 0x03, 0x00, 0x00,
+	0x00, 0x85, 0x01, 0x00, 0x9D, 0x03, 0x00, 0x00, 0x02, 0x85, 0x01, 0x00, 0xA3, 0x03, 0x00, 0x00,
+	0x04, 0x85, 0x01, 0x00, 0xB4, 0x03, 0x00, 0x00, 0x01, 0x86, 0x01, 0x00, 0xC5, 0x03, 0x00, 0x00,
+	0x03, 0x86, 0x01, 0x00, 0xD6, 0x03, 0x00, 0x00, 0x00, 0x87, 0x01, 0x00, 0xE7, 0x03, 0x00, 0x00,
+	0x00, 0x88, 0x01, 0x00, 0xED, 0x03, 0x00, 0x00, 0x00, 0x89, 0x01, 0x00, 0xF3, 0x03, 0x00, 0x00,
+	0x00, 0x8A, 0x01, 0x00, 0xFB, 0x03, 0x00, 0x00, 0x00, 0x8B, 0x01, 0x00, 0x01, 0x04, 0x00, 0x00,
+	0x00, 0x8C, 0x01, 0x00, 0x07, 0x04, 0x00, 0x00, 0x01, 0x8C, 0x01, 0x00, 0x0D, 0x04, 0x00, 0x00,
+	0x00, 0x8D, 0x01, 0x00, 0x1E, 0x04, 0x00, 0x00, 0x00, 0x8E, 0x01, 0x00, 0x24, 0x04, 0x00, 0x00,
+	0x01, 0x8E, 0x01, 0x00, 0x2C, 0x04, 0x00, 0x00, 0x00, 0x8F, 0x01, 0x00, 0x3F, 0x04, 0x00, 0x00,
+	0x01, 0x8F, 0x01, 0x00, 0x56, 0x04, 0x00, 0x00, 0x00, 0x90, 0x01, 0x00, 0x6D, 0x04, 0x00, 0x00,
+	0x00, 0x91, 0x01, 0x00, 0x76, 0x04, 0x00, 0x00, 0x00, 0x92, 0x01, 0x00, 0x7E, 0x04, 0x00, 0x00,
+	0x00, 0x93, 0x01, 0x00, 0x87, 0x04, 0x00, 0x00, 0x00, 0x94, 0x01, 0x00, 0x8F, 0x04, 0x00, 0x00,
+	0x00, 0x95, 0x01, 0x00, 0x95, 0x04, 0x00, 0x00, 0x00, 0x96, 0x01, 0x00, 0x9C, 0x04, 0x00, 0x00,
+	0x00, 0x97, 0x01, 0x00, 0xA3, 0x04, 0x00, 0x00, 0x00, 0x98, 0x01, 0x00, 0xAB, 0x04, 0x00, 0x00,
+	0x00, 0x99, 0x01, 0x00, 0xB1, 0x04, 0x00, 0x00, 0x00, 0x9A, 0x01, 0x00, 0xB7, 0x04, 0x00, 0x00,
+	0x00, 0x9B, 0x01, 0x00, 0xBC, 0x04, 0x00, 0x00, 0x00, 0x9C, 0x01, 0x00, 0xC0, 0x04, 0x00, 0x00,
+	0x00, 0x9D, 0x01, 0x00, 0xC8, 0x04, 0x00, 0x00, 0x00, 0x9E, 0x01, 0x00, 0xCF, 0x04, 0x00, 0x00,
+	0x00, 0x9F, 0x01, 0x00, 0xD6, 0x04, 0x00, 0x00, 0x00, 0xA0, 0x01, 0x00, 0xDB, 0x04, 0x00, 0x00,
+	0x00, 0xA1, 0x01, 0x00, 0xE1, 0x04, 0x00, 0x00, 0x00, 0xA2, 0x01, 0x00, 0xE9, 0x04, 0x00, 0x00,
+	0x00, 0xA3, 0x01, 0x00, 0xF2, 0x04, 0x00, 0x00, 0x00, 0xA4, 0x01, 0x00, 0xF7, 0x04, 0x00, 0x00,
+	0x00, 0xA5, 0x01, 0x00, 0xFE, 0x04, 0x00, 0x00, 0x00, 0xA6, 0x01, 0x00, 0x06, 0x05, 0x00, 0x00,
+	0x00, 0xA7, 0x01, 0x00, 0x0D, 0x05, 0x00, 0x00, 0x00, 0xA8, 0x01, 0x00, 0x15, 0x05, 0x00, 0x00,
+	0x01, 0xA8, 0x01, 0x00, 0x1A, 0x05, 0x00, 0x00, 0x00, 0xA9, 0x01, 0x00, 0x2A, 0x05, 0x00, 0x00,
+	0x00, 0xAA, 0x01, 0x00, 0x31, 0x05, 0x00, 0x00, 0x00, 0xAB, 0x01, 0x00, 0x36, 0x05, 0x00, 0x00,
+	0x00, 0xAC, 0x01, 0x00, 0x3B, 0x05, 0x00, 0x00, 0x00, 0xAD, 0x01, 0x00, 0x42, 0x05, 0x00, 0x00,
+	0x00, 0xAE, 0x01, 0x00, 0x47, 0x05, 0x00, 0x00, 0x00, 0xAF, 0x01, 0x00, 0x50, 0x05, 0x00, 0x00,
+	0x00, 0xB0, 0x01, 0x00, 0x57, 0x05, 0x00, 0x00, 0x00, 0xB1, 0x01, 0x00, 0x60, 0x05, 0x00, 0x00,
+	0x01, 0xB1, 0x01, 0x00, 0x6B, 0x05, 0x00, 0x00, 0x00, 0xB3, 0x01, 0x00, 0x72, 0x05, 0x00, 0x00,
+	0x00, 0xB4, 0x01, 0x00, 0x79, 0x05, 0x00, 0x00, 0x00, 0xB5, 0x01, 0x00, 0x7E, 0x05, 0x00, 0x00,
+	0x00, 0xB6, 0x01, 0x00, 0x83, 0x05, 0x00, 0x00, 0x00, 0xC1, 0x01, 0x00, 0x89, 0x05, 0x00, 0x00,
+	0x01, 0xC1, 0x01, 0x00, 0x90, 0x05, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0xA2, 0x05, 0x00, 0x00,
+	0x00, 0x01, 0x02, 0x00, 0xA9, 0x05, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00, 0xB1, 0x05, 0x00, 0x00,
+	0x00, 0x03, 0x02, 0x00, 0xB7, 0x05, 0x00, 0x00, 0x00, 0x06, 0x02, 0x00, 0xC0, 0x05, 0x00, 0x00,
+	0x00, 0x08, 0x02, 0x00, 0xC7, 0x05, 0x00, 0x00, 0x00, 0x09, 0x02, 0x00, 0xD0, 0x05, 0x00, 0x00,
+	0x00, 0x14, 0x02, 0x00, 0xD5, 0x05, 0x00, 0x00, 0x00, 0x15, 0x02, 0x00, 0xDB, 0x05, 0x00, 0x00,
+	0x00, 0x16, 0x02, 0x00, 0xE1, 0x05, 0x00, 0x00, 0x00, 0x17, 0x02, 0x00, 0xE6, 0x05, 0x00, 0x00,
+	0x00, 0x19, 0x02, 0x00, 0xEB, 0x05, 0x00, 0x00, 0x00, 0x1A, 0x02, 0x00, 0xF0, 0x05, 0x00, 0x00,
+	0x00, 0x1B, 0x02, 0x00, 0xF8, 0x05, 0x00, 0x00, 0x00, 0x1C, 0x02, 0x00, 0xFD, 0x05, 0x00, 0x00,
+	0x00, 0x1D, 0x02, 0x00, 0x04, 0x06, 0x00, 0x00, 0x00, 0x1E, 0x02, 0x00, 0x0C, 0x06, 0x00, 0x00,
+	0x00, 0x1F, 0x02, 0x00, 0x12, 0x06, 0x00, 0x00, 0x00, 0x20, 0x02, 0x00, 0x16, 0x06, 0x00, 0x00,
+	0x00, 0x21, 0x02, 0x00, 0x1F, 0x06, 0x00, 0x00, 0x00, 0x22, 0x02, 0x00, 0x26, 0x06, 0x00, 0x00,
+	0x00, 0x2D, 0x02, 0x00, 0x2C, 0x06, 0x00, 0x00, 0x00, 0x2E, 0x02, 0x00, 0x30, 0x06, 0x00, 0x00,
+	0x00, 0x2F, 0x02, 0x00, 0x36, 0x06, 0x00, 0x00, 0x00, 0x30, 0x02, 0x00, 0x3E, 0x06, 0x00, 0x00,
+	0x00, 0x31, 0x02, 0x00, 0x45, 0x06, 0x00, 0x00, 0x00, 0x32, 0x02, 0x00, 0x4D, 0x06, 0x00, 0x00,
+	0x00, 0x33, 0x02, 0x00, 0x53, 0x06, 0x00, 0x00, 0x00, 0x35, 0x02, 0x00, 0x5B, 0x06, 0x00, 0x00,
+	0x00, 0x38, 0x02, 0x00, 0x61, 0x06, 0x00, 0x00, 0x00, 0x3C, 0x02, 0x00, 0x67, 0x06, 0x00, 0x00,
+	0x00, 0x3D, 0x02, 0x00, 0x6D, 0x06, 0x00, 0x00, 0x00, 0x3E, 0x02, 0x00, 0x75, 0x06, 0x00, 0x00,
+	0x00, 0x3F, 0x02, 0x00, 0x7A, 0x06, 0x00, 0x00, 0x00, 0x4A, 0x02, 0x00, 0x81, 0x06, 0x00, 0x00,
+	0x00, 0x4B, 0x02, 0x00, 0x87, 0x06, 0x00, 0x00, 0x00, 0x4D, 0x02, 0x00, 0x8D, 0x06, 0x00, 0x00,
+	0x00, 0x4F, 0x02, 0x00, 0x91, 0x06, 0x00, 0x00, 0x00, 0x51, 0x02, 0x00, 0x98, 0x06, 0x00, 0x00,
+	0x00, 0x52, 0x02, 0x00, 0x9E, 0x06, 0x00, 0x00, 0x00, 0x5D, 0x02, 0x00, 0xA2, 0x06, 0x00, 0x00,
+	0x00, 0x5E, 0x02, 0x00, 0xA6, 0x06, 0x00, 0x00, 0x00, 0x5F, 0x02, 0x00, 0xAC, 0x06, 0x00, 0x00,
+	0x00, 0x60, 0x02, 0x00, 0xB2, 0x06, 0x00, 0x00, 0x00, 0x61, 0x02, 0x00, 0xB9, 0x06, 0x00, 0x00,
+	0x00, 0x62, 0x02, 0x00, 0xBE, 0x06, 0x00, 0x00, 0x00, 0x63, 0x02, 0x00, 0xC4, 0x06, 0x00, 0x00,
+	0x00, 0x64, 0x02, 0x00, 0xCB, 0x06, 0x00, 0x00, 0x00, 0x65, 0x02, 0x00, 0xD1, 0x06, 0x00, 0x00,
+	0x00, 0x66, 0x02, 0x00, 0xD5, 0x06, 0x00, 0x00, 0x00, 0x67, 0x02, 0x00, 0xDC, 0x06, 0x00, 0x00,
+	0x00, 0x68, 0x02, 0x00, 0xE4, 0x06, 0x00, 0x00, 0x00, 0x69, 0x02, 0x00, 0xEC, 0x06, 0x00, 0x00,
+	0x00, 0x6A, 0x02, 0x00, 0xF2, 0x06, 0x00, 0x00, 0x00, 0x6B, 0x02, 0x00, 0xF9, 0x06, 0x00, 0x00,
+	0x00, 0x6C, 0x02, 0x00, 0xFF, 0x06, 0x00, 0x00, 0x00, 0x6D, 0x02, 0x00, 0x03, 0x07, 0x00, 0x00,
+	0x00, 0x6E, 0x02, 0x00, 0x09, 0x07, 0x00, 0x00, 0x00, 0x6F, 0x02, 0x00, 0x12, 0x07, 0x00, 0x00,
+	0x00, 0x70, 0x02, 0x00, 0x18, 0x07, 0x00, 0x00, 0x00, 0x71, 0x02, 0x00, 0x1E, 0x07, 0x00, 0x00,
+	0x00, 0x72, 0x02, 0x00, 0x23, 0x07, 0x00, 0x00, 0x00, 0x7D, 0x02, 0x00, 0x28, 0x07, 0x00, 0x00,
+	0x00, 0x7E, 0x02, 0x00, 0x31, 0x07, 0x00, 0x00, 0x00, 0x7F, 0x02, 0x00, 0x37, 0x07, 0x00, 0x00,
+	0x00, 0x80, 0x02, 0x00, 0x3E, 0x07, 0x00, 0x00, 0x00, 0x81, 0x02, 0x00, 0x44, 0x07, 0x00, 0x00,
+	0x00, 0x82, 0x02, 0x00, 0x49, 0x07, 0x00, 0x00, 0x00, 0x83, 0x02, 0x00, 0x52, 0x07, 0x00, 0x00,
+	0x00, 0x84, 0x02, 0x00, 0x5B, 0x07, 0x00, 0x00, 0x00, 0x86, 0x02, 0x00, 0x62, 0x07, 0x00, 0x00,
+	0x00, 0x87, 0x02, 0x00, 0x68, 0x07, 0x00, 0x00, 0x00, 0x8A, 0x02, 0x00, 0x6E, 0x07, 0x00, 0x00,
+	0x00, 0x8B, 0x02, 0x00, 0x73, 0x07, 0x00, 0x00, 0x00, 0x8C, 0x02, 0x00, 0x79, 0x07, 0x00, 0x00,
+	0x00, 0x8D, 0x02, 0x00, 0x81, 0x07, 0x00, 0x00, 0x00, 0x8E, 0x02, 0x00, 0x88, 0x07, 0x00, 0x00,
+	0x01, 0x8F, 0x02, 0x00, 0x8E, 0x07, 0x00, 0x00, 0x00, 0x99, 0x02, 0x00, 0x9D, 0x07, 0x00, 0x00,
+	0x00, 0x9A, 0x02, 0x00, 0xA3, 0x07, 0x00, 0x00, 0x00, 0x9B, 0x02, 0x00, 0xAC, 0x07, 0x00, 0x00,
+	0x00, 0x9E, 0x02, 0x00, 0xB3, 0x07, 0x00, 0x00, 0x00, 0xA2, 0x02, 0x00, 0xB7, 0x07, 0x00, 0x00,
+	0x00, 0xA3, 0x02, 0x00, 0xBD, 0x07, 0x00, 0x00, 0x00, 0xA4, 0x02, 0x00, 0xC4, 0x07, 0x00, 0x00,
+	0x00, 0xA5, 0x02, 0x00, 0xC9, 0x07, 0x00, 0x00, 0x00, 0xA6, 0x02, 0x00, 0xD2, 0x07, 0x00, 0x00,
+	0x00, 0xB1, 0x02, 0x00, 0xD6, 0x07, 0x00, 0x00, 0x00, 0xB2, 0x02, 0x00, 0xDC, 0x07, 0x00, 0x00,
+	0x00, 0xB7, 0x02, 0x00, 0xE3, 0x07, 0x00, 0x00, 0x00, 0xB8, 0x02, 0x00, 0xE9, 0x07, 0x00, 0x00,
+	0x00, 0xC3, 0x02, 0x00, 0xEF, 0x07, 0x00, 0x00, 0x00, 0xC4, 0x02, 0x00, 0xF7, 0x07, 0x00, 0x00,
+	0x00, 0xC5, 0x02, 0x00, 0xFC, 0x07, 0x00, 0x00, 0x00, 0xC7, 0x02, 0x00, 0x02, 0x08, 0x00, 0x00,
+	0x00, 0xC9, 0x02, 0x00, 0x06, 0x08, 0x00, 0x00, 0x00, 0xCA, 0x02, 0x00, 0x0A, 0x08, 0x00, 0x00,
+	0x00, 0xCB, 0x02, 0x00, 0x10, 0x08, 0x00, 0x00, 0x00, 0xD6, 0x02, 0x00, 0x16, 0x08, 0x00, 0x00,
+	0x00, 0xD7, 0x02, 0x00, 0x1C, 0x08, 0x00, 0x00, 0x00, 0xD8, 0x02, 0x00, 0x20, 0x08, 0x00, 0x00,
+	0x00, 0xD9, 0x02, 0x00, 0x25, 0x08, 0x00, 0x00, 0x00, 0xDA, 0x02, 0x00, 0x2B, 0x08, 0x00, 0x00,
+	0x00, 0xDB, 0x02, 0x00, 0x33, 0x08, 0x00, 0x00, 0x00, 0xDC, 0x02, 0x00, 0x39, 0x08, 0x00, 0x00,
+	0x00, 0xDD, 0x02, 0x00, 0x41, 0x08, 0x00, 0x00, 0x00, 0xDE, 0x02, 0x00, 0x46, 0x08, 0x00, 0x00,
+	0x00, 0xDF, 0x02, 0x00, 0x4C, 0x08, 0x00, 0x00, 0x01, 0xE0, 0x02, 0x00, 0x51, 0x08, 0x00, 0x00,
+	0x00, 0xEA, 0x02, 0x00, 0x62, 0x08, 0x00, 0x00, 0x00, 0xEB, 0x02, 0x00, 0x69, 0x08, 0x00, 0x00,
+	0x00, 0xEC, 0x02, 0x00, 0x6F, 0x08, 0x00, 0x00, 0x00, 0xED, 0x02, 0x00, 0x75, 0x08, 0x00, 0x00,
+	0x00, 0xEE, 0x02, 0x00, 0x7C, 0x08, 0x00, 0x00, 0x00, 0xEF, 0x02, 0x00, 0x82, 0x08, 0x00, 0x00,
+	0x00, 0xF0, 0x02, 0x00, 0x89, 0x08, 0x00, 0x00, 0x00, 0xF1, 0x02, 0x00, 0x4B, 0x02, 0x00, 0x00,
+	0x00, 0xF2, 0x02, 0x00, 0x90, 0x08, 0x00, 0x00, 0x00, 0xF3, 0x02, 0x00, 0x97, 0x08, 0x00, 0x00,
+	0x00, 0xF4, 0x02, 0x00, 0x9E, 0x08, 0x00, 0x00, 0x00, 0xF8, 0x02, 0x00, 0xA2, 0x08, 0x00, 0x00,
+	0x00, 0xF9, 0x02, 0x00, 0xA6, 0x08, 0x00, 0x00, 0x00, 0xFA, 0x02, 0x00, 0xAD, 0x08, 0x00, 0x00,
+	0x00, 0xFB, 0x02, 0x00, 0xB6, 0x08, 0x00, 0x00, 0x00, 0xFC, 0x02, 0x00, 0xBD, 0x08, 0x00, 0x00,
+	0x00, 0x07, 0x03, 0x00, 0xC2, 0x08, 0x00, 0x00, 0x00, 0x08, 0x03, 0x00, 0xC7, 0x08, 0x00, 0x00,
+	0x00, 0x09, 0x03, 0x00, 0xCC, 0x08, 0x00, 0x00, 0x00, 0x0A, 0x03, 0x00, 0xD1, 0x08, 0x00, 0x00,
+	0x00, 0x0B, 0x03, 0x00, 0xD8, 0x08, 0x00, 0x00, 0x00, 0x0C, 0x03, 0x00, 0xDE, 0x08, 0x00, 0x00,
+	0x00, 0x0D, 0x03, 0x00, 0xE5, 0x08, 0x00, 0x00, 0x00, 0x0E, 0x03, 0x00, 0xED, 0x08, 0x00, 0x00,
+	0x00, 0x0F, 0x03, 0x00, 0xF6, 0x08, 0x00, 0x00, 0x00, 0x10, 0x03, 0x00, 0xFD, 0x08, 0x00, 0x00,
+	0x00, 0x11, 0x03, 0x00, 0x03, 0x09, 0x00, 0x00, 0x00, 0x12, 0x03, 0x00, 0x09, 0x09, 0x00, 0x00,
+	0x00, 0x13, 0x03, 0x00, 0x0F, 0x09, 0x00, 0x00, 0x00, 0x14, 0x03, 0x00, 0x17, 0x09, 0x00, 0x00,
+	0x00, 0x16, 0x03, 0x00, 0x1F, 0x09, 0x00, 0x00, 0x00, 0x17, 0x03, 0x00, 0x26, 0x09, 0x00, 0x00,
+	0x00, 0x18, 0x03, 0x00, 0x2C, 0x09, 0x00, 0x00, 0x00, 0x23, 0x03, 0x00, 0x35, 0x09, 0x00, 0x00,
+	0x00, 0x24, 0x03, 0x00, 0x3A, 0x09, 0x00, 0x00, 0x00, 0x25, 0x03, 0x00, 0x40, 0x09, 0x00, 0x00,
+	0x00, 0x26, 0x03, 0x00, 0x48, 0x09, 0x00, 0x00, 0x00, 0x27, 0x03, 0x00, 0x4F, 0x09, 0x00, 0x00,
+	0x00, 0x28, 0x03, 0x00, 0x56, 0x09, 0x00, 0x00, 0x00, 0x29, 0x03, 0x00, 0x5C, 0x09, 0x00, 0x00,
+	0x00, 0x2A, 0x03, 0x00, 0x61, 0x09, 0x00, 0x00, 0x00, 0x2C, 0x03, 0x00, 0x67, 0x09, 0x00, 0x00,
+	0x00, 0x2D, 0x03, 0x00, 0x6E, 0x09, 0x00, 0x00, 0x01, 0x2E, 0x03, 0x00, 0x72, 0x09, 0x00, 0x00,
+	0x00, 0x38, 0x03, 0x00, 0x80, 0x09, 0x00, 0x00, 0x00, 0x39, 0x03, 0x00, 0x85, 0x09, 0x00, 0x00,
+	0x00, 0x3A, 0x03, 0x00, 0x8C, 0x09, 0x00, 0x00, 0x00, 0x3B, 0x03, 0x00, 0x94, 0x09, 0x00, 0x00,
+	0x00, 0x3C, 0x03, 0x00, 0x9D, 0x09, 0x00, 0x00, 0x00, 0x3D, 0x03, 0x00, 0xA3, 0x09, 0x00, 0x00,
+	0x00, 0x3E, 0x03, 0x00, 0xAC, 0x09, 0x00, 0x00, 0x00, 0x3F, 0x03, 0x00, 0xB4, 0x09, 0x00, 0x00,
+	0x00, 0x41, 0x03, 0x00, 0xBD, 0x09, 0x00, 0x00, 0x00, 0x42, 0x03, 0x00, 0xC1, 0x09, 0x00, 0x00,
+	0x00, 0x43, 0x03, 0x00, 0xCA, 0x09, 0x00, 0x00, 0x00, 0x44, 0x03, 0x00, 0xCF, 0x09, 0x00, 0x00,
+	0x00, 0x45, 0x03, 0x00, 0xD6, 0x09, 0x00, 0x00, 0x00, 0x47, 0x03, 0x00, 0xDF, 0x09, 0x00, 0x00,
+	0x00, 0x48, 0x03, 0x00, 0xE6, 0x09, 0x00, 0x00, 0x00, 0x49, 0x03, 0x00, 0xEB, 0x09, 0x00, 0x00,
+	0x00, 0x4A, 0x03, 0x00, 0xF2, 0x09, 0x00, 0x00, 0x00, 0x4B, 0x03, 0x00, 0xF7, 0x09, 0x00, 0x00,
+	0x00, 0x56, 0x03, 0x00, 0xFD, 0x09, 0x00, 0x00, 0x00, 0x57, 0x03, 0x00, 0x04, 0x0A, 0x00, 0x00,
+	0x00, 0x58, 0x03, 0x00, 0x08, 0x0A, 0x00, 0x00, 0x00, 0x5A, 0x03, 0x00, 0x0E, 0x0A, 0x00, 0x00,
+	0x00, 0x5C, 0x03, 0x00, 0x14, 0x0A, 0x00, 0x00, 0x00, 0x5D, 0x03, 0x00, 0x1A, 0x0A, 0x00, 0x00,
+	0x00, 0x5E, 0x03, 0x00, 0x1F, 0x0A, 0x00, 0x00, 0x00, 0x69, 0x03, 0x00, 0x28, 0x0A, 0x00, 0x00,
+	0x00, 0x6A, 0x03, 0x00, 0x2E, 0x0A, 0x00, 0x00, 0x00, 0x6B, 0x03, 0x00, 0x35, 0x0A, 0x00, 0x00,
+	0x00, 0x6D, 0x03, 0x00, 0x3B, 0x0A, 0x00, 0x00, 0x00, 0x6E, 0x03, 0x00, 0x41, 0x0A, 0x00, 0x00,
+	0x00, 0x70, 0x03, 0x00, 0x46, 0x0A, 0x00, 0x00, 0x00, 0x71, 0x03, 0x00, 0x4D, 0x0A, 0x00, 0x00,
+	0x00, 0x72, 0x03, 0x00, 0x50, 0x0A, 0x00, 0x00, 0x00, 0x73, 0x03, 0x00, 0x57, 0x0A, 0x00, 0x00,
+	0x01, 0x74, 0x03, 0x00, 0x5C, 0x0A, 0x00, 0x00, 0x00, 0x7E, 0x03, 0x00, 0x6B, 0x0A, 0x00, 0x00,
+	0x00, 0x7F, 0x03, 0x00, 0x72, 0x0A, 0x00, 0x00, 0x00, 0x80, 0x03, 0x00, 0x78, 0x0A, 0x00, 0x00,
+	0x00, 0x81, 0x03, 0x00, 0x7F, 0x0A, 0x00, 0x00, 0x00, 0x82, 0x03, 0x00, 0x86, 0x0A, 0x00, 0x00,
+	0x00, 0x83, 0x03, 0x00, 0x8D, 0x0A, 0x00, 0x00, 0x00, 0x84, 0x03, 0x00, 0x92, 0x0A, 0x00, 0x00,
+	0x00, 0x85, 0x03, 0x00, 0x99, 0x0A, 0x00, 0x00, 0x00, 0x90, 0x03, 0x00, 0xA2, 0x0A, 0x00, 0x00,
+	0x00, 0x92, 0x03, 0x00, 0xA8, 0x0A, 0x00, 0x00, 0x00, 0x93, 0x03, 0x00, 0xB0, 0x0A, 0x00, 0x00,
+	0x00, 0x94, 0x03, 0x00, 0xB7, 0x0A, 0x00, 0x00, 0x00, 0x95, 0x03, 0x00, 0xBC, 0x0A, 0x00, 0x00,
+	0x00, 0x98, 0x03, 0x00, 0xC2, 0x0A, 0x00, 0x00, 0x00, 0x99, 0x03, 0x00, 0xC8, 0x0A, 0x00, 0x00,
+	0x00, 0xA4, 0x03, 0x00, 0xD0, 0x0A, 0x00, 0x00, 0x00, 0xA5, 0x03, 0x00, 0xD5, 0x0A, 0x00, 0x00,
+	0x00, 0xA6, 0x03, 0x00, 0xDE, 0x0A, 0x00, 0x00, 0x00, 0xA7, 0x03, 0x00, 0xE7, 0x0A, 0x00, 0x00,
+	0x00, 0xA8, 0x03, 0x00, 0xED, 0x0A, 0x00, 0x00, 0x00, 0xA9, 0x03, 0x00, 0xF3, 0x0A, 0x00, 0x00,
+	0x00, 0xAA, 0x03, 0x00, 0xFA, 0x0A, 0x00, 0x00, 0x00, 0xAB, 0x03, 0x00, 0xFD, 0x0A, 0x00, 0x00,
+	0x00, 0xAC, 0x03, 0x00, 0x02, 0x0B, 0x00, 0x00, 0x00, 0xAD, 0x03, 0x00, 0x0A, 0x0B, 0x00, 0x00,
+	0x00, 0xAE, 0x03, 0x00, 0x13, 0x0B, 0x00, 0x00, 0x00, 0xAF, 0x03, 0x00, 0x19, 0x0B, 0x00, 0x00,
+	0x00, 0xB0, 0x03, 0x00, 0x20, 0x0B, 0x00, 0x00, 0x00, 0xB1, 0x03, 0x00, 0x25, 0x0B, 0x00, 0x00,
+	0x00, 0xBC, 0x03, 0x00, 0x2C, 0x0B, 0x00, 0x00, 0x00, 0xBD, 0x03, 0x00, 0x31, 0x0B, 0x00, 0x00,
+	0x00, 0xBE, 0x03, 0x00, 0x37, 0x0B, 0x00, 0x00, 0x00, 0xBF, 0x03, 0x00, 0x3D, 0x0B, 0x00, 0x00,
+	0x00, 0xC0, 0x03, 0x00, 0x44, 0x0B, 0x00, 0x00, 0x00, 0xC1, 0x03, 0x00, 0x4A, 0x0B, 0x00, 0x00,
+	0x00, 0xC4, 0x03, 0x00, 0x50, 0x0B, 0x00, 0x00, 0x00, 0xC5, 0x03, 0x00, 0x59, 0x0B, 0x00, 0x00,
+	0x00, 0xC6, 0x03, 0x00, 0x5F, 0x0B, 0x00, 0x00, 0x00, 0xD1, 0x03, 0x00, 0x66, 0x0B, 0x00, 0x00,
+	0x00, 0xD2, 0x03, 0x00, 0x6B, 0x0B, 0x00, 0x00, 0x00, 0xD3, 0x03, 0x00, 0x74, 0x0B, 0x00, 0x00,
+	0x00, 0xD6, 0x03, 0x00, 0x7B, 0x0B, 0x00, 0x00, 0x00, 0xD7, 0x03, 0x00, 0x82, 0x0B, 0x00, 0x00,
+	0x00, 0xD9, 0x03, 0x00, 0x89, 0x0B, 0x00, 0x00, 0x00, 0xDA, 0x03, 0x00, 0x8E, 0x0B, 0x00, 0x00,
+	0x00, 0xDB, 0x03, 0x00, 0x95, 0x0B, 0x00, 0x00, 0x00, 0xE6, 0x03, 0x00, 0x9C, 0x0B, 0x00, 0x00,
+	0x00, 0xE7, 0x03, 0x00, 0xA0, 0x0B, 0x00, 0x00, 0x00, 0xE8, 0x03, 0x00, 0xA6, 0x0B, 0x00, 0x00,
+	0x00, 0xEA, 0x03, 0x00, 0xAA, 0x0B, 0x00, 0x00, 0x00, 0xEC, 0x03, 0x00, 0xB2, 0x0B, 0x00, 0x00,
+	0x00, 0xED, 0x03, 0x00, 0xB7, 0x0B, 0x00, 0x00, 0x00, 0xEE, 0x03, 0x00, 0xBC, 0x0B, 0x00, 0x00,
+	0x00, 0xFA, 0x03, 0x00, 0xC3, 0x0B, 0x00, 0x00, 0x00, 0xFB, 0x03, 0x00, 0xC8, 0x0B, 0x00, 0x00,
+	0x00, 0xFC, 0x03, 0x00, 0xCE, 0x0B, 0x00, 0x00, 0x00, 0xFD, 0x03, 0x00, 0xD4, 0x0B, 0x00, 0x00,
+	0x00, 0xFE, 0x03, 0x00, 0xDA, 0x0B, 0x00, 0x00, 0x00, 0xFF, 0x03, 0x00, 0xE0, 0x0B, 0x00, 0x00,
+	0x00, 0x00, 0x04, 0x00, 0xE5, 0x0B, 0x00, 0x00, 0x00, 0x01, 0x04, 0x00, 0xEB, 0x0B, 0x00, 0x00,
+	0x00, 0x0C, 0x04, 0x00, 0xF0, 0x0B, 0x00, 0x00, 0x00, 0x0D, 0x04, 0x00, 0xF5, 0x0B, 0x00, 0x00,
+	0x00, 0x0E, 0x04, 0x00, 0xFD, 0x0B, 0x00, 0x00, 0x00, 0x0F, 0x04, 0x00, 0x03, 0x0C, 0x00, 0x00,
+	0x00, 0x10, 0x04, 0x00, 0x08, 0x0C, 0x00, 0x00, 0x00, 0x11, 0x04, 0x00, 0x0F, 0x0C, 0x00, 0x00,
+	0x00, 0x14, 0x04, 0x00, 0x13, 0x0C, 0x00, 0x00, 0x00, 0x15, 0x04, 0x00, 0x19, 0x0C, 0x00, 0x00,
+	0x00, 0x16, 0x04, 0x00, 0x1F, 0x0C, 0x00, 0x00, 0x00, 0x18, 0x04, 0x00, 0x28, 0x0C, 0x00, 0x00,
+	0x00, 0x1A, 0x04, 0x00, 0x31, 0x0C, 0x00, 0x00, 0x00, 0x1B, 0x04, 0x00, 0x37, 0x0C, 0x00, 0x00,
+	0x00, 0x1C, 0x04, 0x00, 0x3F, 0x0C, 0x00, 0x00, 0x00, 0x1D, 0x04, 0x00, 0x45, 0x0C, 0x00, 0x00,
+	0x00, 0x1E, 0x04, 0x00, 0x4E, 0x0C, 0x00, 0x00, 0x00, 0x29, 0x04, 0x00, 0x56, 0x0C, 0x00, 0x00,
+	0x00, 0x2A, 0x04, 0x00, 0x5F, 0x0C, 0x00, 0x00, 0x00, 0x2B, 0x04, 0x00, 0x66, 0x0C, 0x00, 0x00,
+	0x00, 0x36, 0x04, 0x00, 0x6D, 0x0C, 0x00, 0x00, 0x00, 0x37, 0x04, 0x00, 0x75, 0x0C, 0x00, 0x00,
+	0x00, 0x38, 0x04, 0x00, 0x7C, 0x0C, 0x00, 0x00, 0x00, 0x39, 0x04, 0x00, 0x82, 0x0C, 0x00, 0x00,
+	0x00, 0x3B, 0x04, 0x00, 0x8B, 0x0C, 0x00, 0x00, 0x00, 0x3C, 0x04, 0x00, 0x91, 0x0C, 0x00, 0x00,
+	0x00, 0x3D, 0x04, 0x00, 0x9A, 0x0C, 0x00, 0x00, 0x00, 0x3E, 0x04, 0x00, 0x9F, 0x0C, 0x00, 0x00,
+	0x00, 0x3F, 0x04, 0x00, 0xA7, 0x0C, 0x00, 0x00, 0x00, 0x40, 0x04, 0x00, 0xAD, 0x0C, 0x00, 0x00,
+	0x00, 0x4B, 0x04, 0x00, 0xB4, 0x0C, 0x00, 0x00, 0x00, 0x4C, 0x04, 0x00, 0xBB, 0x0C, 0x00, 0x00,
+	0x00, 0x4D, 0x04, 0x00, 0xC2, 0x0C, 0x00, 0x00, 0x00, 0x4E, 0x04, 0x00, 0xC9, 0x0C, 0x00, 0x00,
+	0x00, 0x50, 0x04, 0x00, 0xCE, 0x0C, 0x00, 0x00, 0x00, 0x51, 0x04, 0x00, 0xD4, 0x0C, 0x00, 0x00,
+	0x00, 0x52, 0x04, 0x00, 0xDA, 0x0C, 0x00, 0x00, 0x00, 0x53, 0x04, 0x00, 0xE3, 0x0C, 0x00, 0x00,
+	0x00, 0x54, 0x04, 0x00, 0xEA, 0x0C, 0x00, 0x00, 0x00, 0x5F, 0x04, 0x00, 0xF0, 0x0C, 0x00, 0x00,
+	0x00, 0x60, 0x04, 0x00, 0xF7, 0x0C, 0x00, 0x00, 0x00, 0x61, 0x04, 0x00, 0xFD, 0x0C, 0x00, 0x00,
+	0x00, 0x62, 0x04, 0x00, 0x02, 0x0D, 0x00, 0x00, 0x00, 0x63, 0x04, 0x00, 0x09, 0x0D, 0x00, 0x00,
+	0x00, 0x64, 0x04, 0x00, 0x0F, 0x0D, 0x00, 0x00, 0x00, 0x65, 0x04, 0x00, 0x14, 0x0D, 0x00, 0x00,
+	0x00, 0x68, 0x04, 0x00, 0x19, 0x0D, 0x00, 0x00, 0x00, 0x69, 0x04, 0x00, 0x1E, 0x0D, 0x00, 0x00,
+	0x00, 0x6A, 0x04, 0x00, 0x25, 0x0D, 0x00, 0x00, 0x00, 0x6B, 0x04, 0x00, 0x2B, 0x0D, 0x00, 0x00,
+	0x00, 0x6C, 0x04, 0x00, 0x2F, 0x0D, 0x00, 0x00, 0x00, 0x6D, 0x04, 0x00, 0x33, 0x0D, 0x00, 0x00,
+	0x00, 0x78, 0x04, 0x00, 0x3C, 0x0D, 0x00, 0x00, 0x00, 0x79, 0x04, 0x00, 0x42, 0x0D, 0x00, 0x00,
+	0x00, 0x7A, 0x04, 0x00, 0x4B, 0x0D, 0x00, 0x00, 0x00, 0x7B, 0x04, 0x00, 0x52, 0x0D, 0x00, 0x00,
+	0x00, 0x7C, 0x04, 0x00, 0x57, 0x0D, 0x00, 0x00, 0x00, 0x7D, 0x04, 0x00, 0x5C, 0x0D, 0x00, 0x00,
+	0x00, 0x80, 0x04, 0x00, 0x6A, 0x0D, 0x00, 0x00, 0x00, 0x81, 0x04, 0x00, 0x6F, 0x0D, 0x00, 0x00,
+	0x00, 0x82, 0x04, 0x00, 0x75, 0x0D, 0x00, 0x00, 0x00, 0x83, 0x04, 0x00, 0x7C, 0x0D, 0x00, 0x00,
+	0x00, 0x85, 0x04, 0x00, 0x82, 0x0D, 0x00, 0x00, 0x00, 0x86, 0x04, 0x00, 0x87, 0x0D, 0x00, 0x00,
+	0x00, 0x87, 0x04, 0x00, 0x8D, 0x0D, 0x00, 0x00, 0x00, 0x88, 0x04, 0x00, 0x93, 0x0D, 0x00, 0x00,
+	0x00, 0x89, 0x04, 0x00, 0x9C, 0x0D, 0x00, 0x00, 0x00, 0x94, 0x04, 0x00, 0xA2, 0x0D, 0x00, 0x00,
+	0x00, 0x95, 0x04, 0x00, 0xA9, 0x0D, 0x00, 0x00, 0x00, 0x96, 0x04, 0x00, 0xAF, 0x0D, 0x00, 0x00,
+	0x00, 0x97, 0x04, 0x00, 0xB4, 0x0D, 0x00, 0x00, 0x00, 0x98, 0x04, 0x00, 0xBA, 0x0D, 0x00, 0x00,
+	0x00, 0x99, 0x04, 0x00, 0xC1, 0x0D, 0x00, 0x00, 0x00, 0x9A, 0x04, 0x00, 0xC6, 0x0D, 0x00, 0x00,
+	0x00, 0x9B, 0x04, 0x00, 0xCC, 0x0D, 0x00, 0x00, 0x00, 0x9C, 0x04, 0x00, 0xD4, 0x0D, 0x00, 0x00,
+	0x00, 0x9D, 0x04, 0x00, 0xDA, 0x0D, 0x00, 0x00, 0x00, 0x9E, 0x04, 0x00, 0xDF, 0x0D, 0x00, 0x00,
+	0x00, 0x9F, 0x04, 0x00, 0xE3, 0x0D, 0x00, 0x00, 0x00, 0xA0, 0x04, 0x00, 0xEA, 0x0D, 0x00, 0x00,
+	0x00, 0xA1, 0x04, 0x00, 0xF3, 0x0D, 0x00, 0x00, 0x00, 0xA2, 0x04, 0x00, 0xFB, 0x0D, 0x00, 0x00,
+	0x00, 0xA3, 0x04, 0x00, 0x03, 0x0E, 0x00, 0x00, 0x00, 0xA4, 0x04, 0x00, 0x09, 0x0E, 0x00, 0x00,
+	0x00, 0xA5, 0x04, 0x00, 0x10, 0x0E, 0x00, 0x00, 0x00, 0xA6, 0x04, 0x00, 0x17, 0x0E, 0x00, 0x00,
+	0x00, 0xA7, 0x04, 0x00, 0x1C, 0x0E, 0x00, 0x00, 0x01, 0xA8, 0x04, 0x00, 0x21, 0x0E, 0x00, 0x00,
+	0x00, 0xB2, 0x04, 0x00, 0x2F, 0x0E, 0x00, 0x00, 0x00, 0xB3, 0x04, 0x00, 0x34, 0x0E, 0x00, 0x00,
+	0x00, 0xB4, 0x04, 0x00, 0x3B, 0x0E, 0x00, 0x00, 0x00, 0xB6, 0x04, 0x00, 0x41, 0x0E, 0x00, 0x00,
+	0x00, 0xB9, 0x04, 0x00, 0x49, 0x0E, 0x00, 0x00, 0x00, 0xBA, 0x04, 0x00, 0x52, 0x0E, 0x00, 0x00,
+	0x00, 0xC5, 0x04, 0x00, 0x59, 0x0E, 0x00, 0x00, 0x00, 0xC6, 0x04, 0x00, 0x5F, 0x0E, 0x00, 0x00,
+	0x00, 0xC7, 0x04, 0x00, 0x67, 0x0E, 0x00, 0x00, 0x00, 0xC8, 0x04, 0x00, 0x6E, 0x0E, 0x00, 0x00,
+	0x00, 0xC9, 0x04, 0x00, 0x75, 0x0E, 0x00, 0x00, 0x00, 0xCC, 0x04, 0x00, 0x7E, 0x0E, 0x00, 0x00,
+	0x00, 0xCD, 0x04, 0x00, 0x85, 0x0E, 0x00, 0x00, 0x00, 0xCE, 0x04, 0x00, 0x8C, 0x0E, 0x00, 0x00,
+	0x00, 0xCF, 0x04, 0x00, 0x92, 0x0E, 0x00, 0x00, 0x00, 0xD0, 0x04, 0x00, 0x99, 0x0E, 0x00, 0x00,
+	0x00, 0xD1, 0x04, 0x00, 0x9F, 0x0E, 0x00, 0x00, 0x00, 0xD2, 0x04, 0x00, 0xA5, 0x0E, 0x00, 0x00,
+	0x01, 0xD3, 0x04, 0x00, 0xAC, 0x0E, 0x00, 0x00, 0x00, 0xDD, 0x04, 0x00, 0xBD, 0x0E, 0x00, 0x00,
+	0x00, 0xDE, 0x04, 0x00, 0xC4, 0x0E, 0x00, 0x00, 0x00, 0xDF, 0x04, 0x00, 0xCB, 0x0E, 0x00, 0x00,
+	0x00, 0xE0, 0x04, 0x00, 0xD3, 0x0E, 0x00, 0x00, 0x00, 0xE1, 0x04, 0x00, 0xD9, 0x0E, 0x00, 0x00,
+	0x00, 0xE2, 0x04, 0x00, 0xE1, 0x0E, 0x00, 0x00, 0x00, 0xE3, 0x04, 0x00, 0xE9, 0x0E, 0x00, 0x00,
+	0x00, 0xE4, 0x04, 0x00, 0xF2, 0x0E, 0x00, 0x00, 0x00, 0xE5, 0x04, 0x00, 0xF8, 0x0E, 0x00, 0x00,
+	0x00, 0xE6, 0x04, 0x00, 0xFF, 0x0E, 0x00, 0x00, 0x00, 0xE7, 0x04, 0x00, 0x04, 0x0F, 0x00, 0x00,
+	0x00, 0xE8, 0x04, 0x00, 0x0A, 0x0F, 0x00, 0x00, 0x00, 0xEA, 0x04, 0x00, 0x10, 0x0F, 0x00, 0x00,
+	0x00, 0xEB, 0x04, 0x00, 0x16, 0x0F, 0x00, 0x00, 0x00, 0xEC, 0x04, 0x00, 0x1E, 0x0F, 0x00, 0x00,
+	0x00, 0xED, 0x04, 0x00, 0x24, 0x0F, 0x00, 0x00, 0x00, 0xEE, 0x04, 0x00, 0x2C, 0x0F, 0x00, 0x00,
+	0x00, 0xEF, 0x04, 0x00, 0x34, 0x0F, 0x00, 0x00, 0x00, 0xFA, 0x04, 0x00, 0x3A, 0x0F, 0x00, 0x00,
+	0x00, 0xFB, 0x04, 0x00, 0x3F, 0x0F, 0x00, 0x00, 0x00, 0xFC, 0x04, 0x00, 0x45, 0x0F, 0x00, 0x00,
+	0x00, 0xFD, 0x04, 0x00, 0x4C, 0x0F, 0x00, 0x00, 0x00, 0xFE, 0x04, 0x00, 0x53, 0x0F, 0x00, 0x00,
+	0x00, 0xFF, 0x04, 0x00, 0x5C, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x64, 0x0F, 0x00, 0x00,
+	0x00, 0x0B, 0x05, 0x00, 0x6B, 0x0F, 0x00, 0x00, 0x00, 0x0C, 0x05, 0x00, 0x71, 0x0F, 0x00, 0x00,
+	0x00, 0x0D, 0x05, 0x00, 0x76, 0x0F, 0x00, 0x00, 0x00, 0x0E, 0x05, 0x00, 0x7F, 0x0F, 0x00, 0x00,
+	0x00, 0x0F, 0x05, 0x00, 0x87, 0x0F, 0x00, 0x00, 0x00, 0x10, 0x05, 0x00, 0x8D, 0x0F, 0x00, 0x00,
+	0x00, 0x11, 0x05, 0x00, 0x93, 0x0F, 0x00, 0x00, 0x00, 0x13, 0x05, 0x00, 0x98, 0x0F, 0x00, 0x00,
+	0x00, 0x14, 0x05, 0x00, 0x9F, 0x0F, 0x00, 0x00, 0x00, 0x15, 0x05, 0x00, 0xA4, 0x0F, 0x00, 0x00,
+	0x00, 0x80, 0x05, 0x00, 0xA9, 0x0F, 0x00, 0x00, 0x00, 0x81, 0x05, 0x00, 0xAD, 0x0F, 0x00, 0x00,
+	0x00, 0x84, 0x05, 0x00, 0xB3, 0x0F, 0x00, 0x00, 0x00, 0xC0, 0x05, 0x00, 0xB8, 0x0F, 0x00, 0x00,
+	0x01, 0xC0, 0x05, 0x00, 0xBE, 0x0F, 0x00, 0x00, 0x02, 0xC0, 0x05, 0x00, 0xCE, 0x0F, 0x00, 0x00,
+	0x00, 0xC1, 0x05, 0x00, 0x52, 0x00, 0x00, 0x00, 0x00, 0xC2, 0x05, 0x00, 0xD9, 0x0F, 0x00, 0x00,
+	0x00, 0xC3, 0x05, 0x00, 0xE0, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0xEB, 0x0F, 0x00, 0x00,
+	0x00, 0x40, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x40, 0x06, 0x00, 0xFA, 0x0F, 0x00, 0x00,
+	0x00, 0x42, 0x06, 0x00, 0x61, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x06, 0x00, 0x01, 0x10, 0x00, 0x00,
+	0x00, 0x00, 0x07, 0x00, 0x0C, 0x10, 0x00, 0x00, 0x00, 0x40, 0x07, 0x00, 0x1C, 0x10, 0x00, 0x00,
+	0x00, 0x41, 0x07, 0x00, 0x20, 0x10, 0x00, 0x00, 0x00, 0x42, 0x07, 0x00, 0x29, 0x10, 0x00, 0x00,
+	0x00, 0x80, 0x07, 0x00, 0x32, 0x10, 0x00, 0x00, 0x00, 0x81, 0x07, 0x00, 0x43, 0x10, 0x00, 0x00,
+	0x00, 0x82, 0x07, 0x00, 0x4A, 0x10, 0x00, 0x00, 0x00, 0x8F, 0x07, 0x00, 0x54, 0x10, 0x00, 0x00,
+	0x00, 0xC0, 0x07, 0x00, 0x61, 0x10, 0x00, 0x00, 0x01, 0xC0, 0x07, 0x00, 0x6D, 0x10, 0x00, 0x00,
+	0x02, 0xC0, 0x07, 0x00, 0x7E, 0x10, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x89, 0x10, 0x00, 0x00,
+	0x01, 0x00, 0x08, 0x00, 0x91, 0x10, 0x00, 0x00, 0x02, 0x00, 0x08, 0x00, 0x9E, 0x10, 0x00, 0x00,
+	0x03, 0x00, 0x08, 0x00, 0xAA, 0x10, 0x00, 0x00, 0x00, 0x01, 0x08, 0x00, 0xB8, 0x10, 0x00, 0x00,
+	0x00, 0x02, 0x08, 0x00, 0xBF, 0x10, 0x00, 0x00, 0x00, 0x03, 0x08, 0x00, 0xC5, 0x10, 0x00, 0x00,
+	0x00, 0x04, 0x08, 0x00, 0x5F, 0x0C, 0x00, 0x00, 0x00, 0x05, 0x08, 0x00, 0xCB, 0x10, 0x00, 0x00,
+	0x01, 0x05, 0x08, 0x00, 0xD4, 0x10, 0x00, 0x00, 0x02, 0x05, 0x08, 0x00, 0xE2, 0x10, 0x00, 0x00,
+	0x03, 0x05, 0x08, 0x00, 0xEF, 0x10, 0x00, 0x00, 0x00, 0xC0, 0x09, 0x00, 0xB7, 0x01, 0x00, 0x00,
+	0x01, 0xC0, 0x09, 0x00, 0x00, 0x11, 0x00, 0x00, 0x02, 0xC0, 0x09, 0x00, 0x0F, 0x11, 0x00, 0x00,
+	0x03, 0xC0, 0x09, 0x00, 0x1F, 0x11, 0x00, 0x00, 0x04, 0xC0, 0x09, 0x00, 0x2E, 0x11, 0x00, 0x00,
+	0x05, 0xC0, 0x09, 0x00, 0x3B, 0x11, 0x00, 0x00, 0x00, 0xC1, 0x09, 0x00, 0xC7, 0x01, 0x00, 0x00,
+	0x01, 0xC1, 0x09, 0x00, 0x4F, 0x11, 0x00, 0x00, 0x02, 0xC1, 0x09, 0x00, 0x5E, 0x11, 0x00, 0x00,
+	0x03, 0xC1, 0x09, 0x00, 0x6E, 0x11, 0x00, 0x00, 0x04, 0xC1, 0x09, 0x00, 0x7D, 0x11, 0x00, 0x00,
+	0x05, 0xC1, 0x09, 0x00, 0x8A, 0x11, 0x00, 0x00, 0x00, 0xC2, 0x09, 0x00, 0xCD, 0x01, 0x00, 0x00,
+	0x01, 0xC2, 0x09, 0x00, 0x9E, 0x11, 0x00, 0x00, 0x02, 0xC2, 0x09, 0x00, 0xAD, 0x11, 0x00, 0x00,
+	0x03, 0xC2, 0x09, 0x00, 0xBD, 0x11, 0x00, 0x00, 0x04, 0xC2, 0x09, 0x00, 0xCC, 0x11, 0x00, 0x00,
+	0x05, 0xC2, 0x09, 0x00, 0xD9, 0x11, 0x00, 0x00, 0x00, 0xC3, 0x09, 0x00, 0x4B, 0x02, 0x00, 0x00,
+	0x01, 0xC3, 0x09, 0x00, 0xED, 0x11, 0x00, 0x00, 0x02, 0xC3, 0x09, 0x00, 0xFC, 0x11, 0x00, 0x00,
+	0x03, 0xC3, 0x09, 0x00, 0x0C, 0x12, 0x00, 0x00, 0x04, 0xC3, 0x09, 0x00, 0x1B, 0x12, 0x00, 0x00,
+	0x05, 0xC3, 0x09, 0x00, 0x28, 0x12, 0x00, 0x00, 0x00, 0xC4, 0x09, 0x00, 0x13, 0x00, 0x00, 0x00,
+	0x01, 0xC4, 0x09, 0x00, 0x3C, 0x12, 0x00, 0x00, 0x02, 0xC4, 0x09, 0x00, 0x4B, 0x12, 0x00, 0x00,
+	0x03, 0xC4, 0x09, 0x00, 0x5B, 0x12, 0x00, 0x00, 0x04, 0xC4, 0x09, 0x00, 0x6A, 0x12, 0x00, 0x00,
+	0x05, 0xC4, 0x09, 0x00, 0x77, 0x12, 0x00, 0x00, 0x00, 0xC5, 0x09, 0x00, 0x1C, 0x02, 0x00, 0x00,
+	0x01, 0xC5, 0x09, 0x00, 0x8B, 0x12, 0x00, 0x00, 0x02, 0xC5, 0x09, 0x00, 0x9A, 0x12, 0x00, 0x00,
+	0x03, 0xC5, 0x09, 0x00, 0xAA, 0x12, 0x00, 0x00, 0x04, 0xC5, 0x09, 0x00, 0xB9, 0x12, 0x00, 0x00,
+	0x05, 0xC5, 0x09, 0x00, 0xC6, 0x12, 0x00, 0x00, 0x00, 0xC6, 0x09, 0x00, 0x51, 0x02, 0x00, 0x00,
+	0x01, 0xC6, 0x09, 0x00, 0xDA, 0x12, 0x00, 0x00, 0x02, 0xC6, 0x09, 0x00, 0xEB, 0x12, 0x00, 0x00,
+	0x03, 0xC6, 0x09, 0x00, 0xFD, 0x12, 0x00, 0x00, 0x04, 0xC6, 0x09, 0x00, 0x0E, 0x13, 0x00, 0x00,
+	0x05, 0xC6, 0x09, 0x00, 0x1D, 0x13, 0x00, 0x00, 0x00, 0xC7, 0x09, 0x00, 0x19, 0x00, 0x00, 0x00,
+	0x01, 0xC7, 0x09, 0x00, 0x33, 0x13, 0x00, 0x00, 0x02, 0xC7, 0x09, 0x00, 0x48, 0x13, 0x00, 0x00,
+	0x03, 0xC7, 0x09, 0x00, 0x5E, 0x13, 0x00, 0x00, 0x04, 0xC7, 0x09, 0x00, 0x73, 0x13, 0x00, 0x00,
+	0x05, 0xC7, 0x09, 0x00, 0x86, 0x13, 0x00, 0x00, 0x00, 0xC8, 0x09, 0x00, 0x3B, 0x02, 0x00, 0x00,
+	0x01, 0xC8, 0x09, 0x00, 0xA0, 0x13, 0x00, 0x00, 0x02, 0xC8, 0x09, 0x00, 0xB4, 0x13, 0x00, 0x00,
+	0x03, 0xC8, 0x09, 0x00, 0xC9, 0x13, 0x00, 0x00, 0x04, 0xC8, 0x09, 0x00, 0xDD, 0x13, 0x00, 0x00,
+	0x05, 0xC8, 0x09, 0x00, 0xEF, 0x13, 0x00, 0x00, 0x00, 0xC9, 0x09, 0x00, 0xF7, 0x01, 0x00, 0x00,
+	0x01, 0xC9, 0x09, 0x00, 0x08, 0x14, 0x00, 0x00, 0x02, 0xC9, 0x09, 0x00, 0x18, 0x14, 0x00, 0x00,
+	0x03, 0xC9, 0x09, 0x00, 0x29, 0x14, 0x00, 0x00, 0x04, 0xC9, 0x09, 0x00, 0x39, 0x14, 0x00, 0x00,
+	0x05, 0xC9, 0x09, 0x00, 0x47, 0x14, 0x00, 0x00, 0x00, 0xCA, 0x09, 0x00, 0x11, 0x02, 0x00, 0x00,
+	0x01, 0xCA, 0x09, 0x00, 0x5C, 0x14, 0x00, 0x00, 0x02, 0xCA, 0x09, 0x00, 0x70, 0x14, 0x00, 0x00,
+	0x03, 0xCA, 0x09, 0x00, 0x85, 0x14, 0x00, 0x00, 0x04, 0xCA, 0x09, 0x00, 0x99, 0x14, 0x00, 0x00,
+	0x05, 0xCA, 0x09, 0x00, 0xAB, 0x14, 0x00, 0x00, 0x00, 0xCB, 0x09, 0x00, 0x60, 0x02, 0x00, 0x00,
+	0x01, 0xCB, 0x09, 0x00, 0xC4, 0x14, 0x00, 0x00, 0x02, 0xCB, 0x09, 0x00, 0xD1, 0x14, 0x00, 0x00,
+	0x03, 0xCB, 0x09, 0x00, 0xDF, 0x14, 0x00, 0x00, 0x04, 0xCB, 0x09, 0x00, 0xEC, 0x14, 0x00, 0x00,
+	0x05, 0xCB, 0x09, 0x00, 0xF7, 0x14, 0x00, 0x00, 0x00, 0xCC, 0x09, 0x00, 0x09, 0x15, 0x00, 0x00,
+	0x01, 0xCC, 0x09, 0x00, 0x14, 0x15, 0x00, 0x00, 0x02, 0xCC, 0x09, 0x00, 0x28, 0x15, 0x00, 0x00,
+	0x03, 0xCC, 0x09, 0x00, 0x3D, 0x15, 0x00, 0x00, 0x04, 0xCC, 0x09, 0x00, 0x51, 0x15, 0x00, 0x00,
+	0x05, 0xCC, 0x09, 0x00, 0x63, 0x15, 0x00, 0x00, 0x00, 0xCD, 0x09, 0x00, 0x7C, 0x15, 0x00, 0x00,
+	0x01, 0xCD, 0x09, 0x00, 0x87, 0x15, 0x00, 0x00, 0x02, 0xCD, 0x09, 0x00, 0x9B, 0x15, 0x00, 0x00,
+	0x03, 0xCD, 0x09, 0x00, 0xB0, 0x15, 0x00, 0x00, 0x04, 0xCD, 0x09, 0x00, 0xC4, 0x15, 0x00, 0x00,
+	0x05, 0xCD, 0x09, 0x00, 0xD6, 0x15, 0x00, 0x00, 0x00, 0xCE, 0x09, 0x00, 0xEF, 0x15, 0x00, 0x00,
+	0x01, 0xCE, 0x09, 0x00, 0xF5, 0x15, 0x00, 0x00, 0x02, 0xCE, 0x09, 0x00, 0x04, 0x16, 0x00, 0x00,
+	0x03, 0xCE, 0x09, 0x00, 0x14, 0x16, 0x00, 0x00, 0x04, 0xCE, 0x09, 0x00, 0x23, 0x16, 0x00, 0x00,
+	0x05, 0xCE, 0x09, 0x00, 0x30, 0x16, 0x00, 0x00, 0x00, 0xCF, 0x09, 0x00, 0xDE, 0x01, 0x00, 0x00,
+	0x01, 0xCF, 0x09, 0x00, 0x44, 0x16, 0x00, 0x00, 0x02, 0xCF, 0x09, 0x00, 0x56, 0x16, 0x00, 0x00,
+	0x03, 0xCF, 0x09, 0x00, 0x69, 0x16, 0x00, 0x00, 0x04, 0xCF, 0x09, 0x00, 0x7B, 0x16, 0x00, 0x00,
+	0x05, 0xCF, 0x09, 0x00, 0x8B, 0x16, 0x00, 0x00, 0x00, 0xD0, 0x09, 0x00, 0xA2, 0x16, 0x00, 0x00,
+	0x01, 0xD0, 0x09, 0x00, 0xAE, 0x16, 0x00, 0x00, 0x02, 0xD0, 0x09, 0x00, 0xC3, 0x16, 0x00, 0x00,
+	0x03, 0xD0, 0x09, 0x00, 0xD9, 0x16, 0x00, 0x00, 0x04, 0xD0, 0x09, 0x00, 0xEE, 0x16, 0x00, 0x00,
+	0x05, 0xD0, 0x09, 0x00, 0x01, 0x17, 0x00, 0x00, 0x00, 0xD1, 0x09, 0x00, 0x1B, 0x17, 0x00, 0x00,
+	0x01, 0xD1, 0x09, 0x00, 0x2B, 0x17, 0x00, 0x00, 0x02, 0xD1, 0x09, 0x00, 0x44, 0x17, 0x00, 0x00,
+	0x03, 0xD1, 0x09, 0x00, 0x5E, 0x17, 0x00, 0x00, 0x04, 0xD1, 0x09, 0x00, 0x77, 0x17, 0x00, 0x00,
+	0x05, 0xD1, 0x09, 0x00, 0x8E, 0x17, 0x00, 0x00, 0x00, 0x02, 0x19, 0x00, 0xAC, 0x17, 0x00, 0x00,
+	0x00, 0x06, 0x19, 0x00, 0xB4, 0x17, 0x00, 0x00, 0x00, 0x07, 0x19, 0x00, 0xBE, 0x17, 0x00, 0x00,
+	0x00, 0x19, 0x19, 0x00, 0xC7, 0x17, 0x00, 0x00, 0x00, 0x27, 0x19, 0x00, 0xCF, 0x17, 0x00, 0x00,
+	0x00, 0x96, 0x19, 0x00, 0xDA, 0x17, 0x00, 0x00, 0x00, 0xAC, 0x19, 0x00, 0xE1, 0x17, 0x00, 0x00,
+	0x00, 0xC0, 0x1A, 0x00, 0xE7, 0x17, 0x00, 0x00, 0x00, 0x92, 0x1B, 0x00, 0xEF, 0x17, 0x00, 0x00,
+	0x00, 0xD7, 0x1B, 0x00, 0xF8, 0x17, 0x00, 0x00, 0x00, 0x00, 0x1D, 0x00, 0x03, 0x18, 0x00, 0x00,
+	0x00, 0x01, 0x1D, 0x00, 0x11, 0x18, 0x00, 0x00, 0x00, 0x40, 0x1D, 0x00, 0x23, 0x18, 0x00, 0x00,
+	0x00, 0x00, 0x1F, 0x00, 0xC6, 0x00, 0x00, 0x00, 0x00, 0x01, 0x1F, 0x00, 0x34, 0x18, 0x00, 0x00,
+	0x00, 0x02, 0x1F, 0x00, 0x40, 0x18, 0x00, 0x00, 0x00, 0x03, 0x1F, 0x00, 0x4C, 0x18, 0x00, 0x00,
+	0x00, 0x40, 0x1F, 0x00, 0x57, 0x18, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x5C, 0x18, 0x00, 0x00,
+	0x00, 0x01, 0x21, 0x00, 0x12, 0x06, 0x00, 0x00, 0x00, 0x02, 0x21, 0x00, 0x62, 0x18, 0x00, 0x00,
+	0x00, 0x03, 0x21, 0x00, 0x30, 0x06, 0x00, 0x00, 0x00, 0x04, 0x21, 0x00, 0x69, 0x18, 0x00, 0x00,
+	0x00, 0x05, 0x21, 0x00, 0x6D, 0x18, 0x00, 0x00, 0x01, 0x05, 0x21, 0x00, 0x74, 0x18, 0x00, 0x00,
+	0x00, 0x06, 0x21, 0x00, 0x86, 0x18, 0x00, 0x00, 0x00, 0x07, 0x21, 0x00, 0x8A, 0x18, 0x00, 0x00,
+	0x00, 0x08, 0x21, 0x00, 0x91, 0x18, 0x00, 0x00, 0x00, 0x09, 0x21, 0x00, 0x97, 0x18, 0x00, 0x00,
+	0x00, 0x40, 0x22, 0x00, 0x9C, 0x18, 0x00, 0x00, 0x00, 0x80, 0x22, 0x00, 0xA2, 0x18, 0x00, 0x00,
+	0x00, 0x81, 0x22, 0x00, 0xA7, 0x18, 0x00, 0x00, 0x00, 0xC0, 0x22, 0x00, 0xAD, 0x18, 0x00, 0x00,
+	0x00, 0x00, 0x32, 0x00, 0xB8, 0x18, 0x00, 0x00, 0x00, 0x40, 0x32, 0x00, 0x14, 0x01, 0x00, 0x00,
+	0x01, 0x40, 0x32, 0x00, 0xBE, 0x18, 0x00, 0x00, 0x00, 0x40, 0x33, 0x00, 0x1E, 0x01, 0x00, 0x00,
+	0x00, 0x80, 0x33, 0x00, 0xD3, 0x18, 0x00, 0x00, 0x00, 0x80, 0x34, 0x00, 0x31, 0x01, 0x00, 0x00,
+	0x00, 0xC0, 0x34, 0x00, 0xE5, 0x18, 0x00, 0x00, 0x00, 0xC1, 0x34, 0x00, 0xD2, 0x07, 0x00, 0x00,
+	0x00, 0x00, 0x35, 0x00, 0xE9, 0x18, 0x00, 0x00, 0x01, 0x00, 0x35, 0x00, 0x05, 0x19, 0x00, 0x00,
+	0x02, 0x00, 0x35, 0x00, 0x28, 0x19, 0x00, 0x00, 0x00, 0x01, 0x35, 0x00, 0x4D, 0x19, 0x00, 0x00,
+	0x00, 0x02, 0x35, 0x00, 0x54, 0x19, 0x00, 0x00, 0x01, 0x02, 0x35, 0x00, 0x54, 0x19, 0x00, 0x00,
+	0x00, 0x03, 0x35, 0x00, 0x67, 0x19, 0x00, 0x00, 0x01, 0x03, 0x35, 0x00, 0x67, 0x19, 0x00, 0x00,
+	0x00, 0x04, 0x35, 0x00, 0x7A, 0x19, 0x00, 0x00, 0x01, 0x04, 0x35, 0x00, 0x7A, 0x19, 0x00, 0x00,
+	0x00, 0xC0, 0x35, 0x00, 0x58, 0x01, 0x00, 0x00, 0x00, 0xC1, 0x35, 0x00, 0x8B, 0x19, 0x00, 0x00,
+	0x00, 0xC2, 0x35, 0x00, 0x99, 0x19, 0x00, 0x00, 0x00, 0xC3, 0x35, 0x00, 0xA8, 0x19, 0x00, 0x00,
+	0x00, 0x00, 0x36, 0x00, 0xB4, 0x19, 0x00, 0x00, 0x01, 0x00, 0x36, 0x00, 0xBA, 0x19, 0x00, 0x00,
+	0x00, 0x40, 0x37, 0x00, 0xCB, 0x19, 0x00, 0x00, 0x01, 0x40, 0x37, 0x00, 0xCB, 0x19, 0x00, 0x00,
+	0x00, 0x80, 0x37, 0x00, 0xB4, 0x0D, 0x00, 0x00, 0x00, 0xC0, 0x37, 0x00, 0xC8, 0x0B, 0x00, 0x00,
+	0x00, 0xC1, 0x37, 0x00, 0xDE, 0x19, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0xE6, 0x19, 0x00, 0x00,
+	0x00, 0x01, 0x38, 0x00, 0xEF, 0x19, 0x00, 0x00, 0x00, 0x02, 0x38, 0x00, 0xF5, 0x19, 0x00, 0x00,
+	0x00, 0x03, 0x38, 0x00, 0xFD, 0x19, 0x00, 0x00, 0x00, 0x04, 0x38, 0x00, 0x06, 0x1A, 0x00, 0x00,
+	0x00, 0x05, 0x38, 0x00, 0x0B, 0x1A, 0x00, 0x00, 0x00, 0xC0, 0x38, 0x00, 0x11, 0x1A, 0x00, 0x00,
+	0x1D, 0x1A, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2F, 0x1A, 0x00, 0x00, 0xD3, 0x01, 0x00, 0x00,
+	0x9C, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00, 0x3B, 0x1A, 0x00, 0x00, 0x5E, 0x1A, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x58, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xC6, 0x00, 0x00, 0x00, 0x69, 0x1A, 0x00, 0x00, 0xA5, 0x00, 0x00, 0x00, 0x49, 0x01, 0x00, 0x00,
+	0xCC, 0x00, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00, 0xD4, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00,
+	0x7A, 0x1A, 0x00, 0x00, 0x31, 0x01, 0x00, 0x00, 0xB0, 0x01, 0x00, 0x00, 0x92, 0x01, 0x00, 0x00,
+	0xB7, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0xCD, 0x01, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00,
+	0x13, 0x00, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0x19, 0x00, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00,
+	0x98, 0x02, 0x00, 0x00, 0x05, 0x00, 0x01, 0x00, 0xA9, 0x0F, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00,
+	0xB8, 0x0F, 0x00, 0x00, 0x07, 0x00, 0x01, 0x00, 0x0C, 0x10, 0x00, 0x00, 0x08, 0x00, 0x01, 0x00,
+	0xFB, 0x02, 0x00, 0x00, 0x09, 0x00, 0x01, 0x00, 0xC7, 0x17, 0x00, 0x00, 0x0A, 0x00, 0x01, 0x00,
+	0xC6, 0x00, 0x00, 0x00, 0x0B, 0x00, 0x01, 0x00, 0x5C, 0x18, 0x00, 0x00, 0x0C, 0x00, 0x01, 0x00,
+	0xC7, 0x01, 0x00, 0x00, 0x0F, 0x00, 0x02, 0x00, 0x3B, 0x02, 0x00, 0x00, 0x0E, 0x00, 0x02, 0x00,
+	0xA7, 0x02, 0x00, 0x00, 0x0D, 0x00, 0x02, 0x00, 0x01, 0x10, 0x00, 0x00, 0x10, 0x00, 0x02, 0x00,
+	0x1C, 0x10, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00, 0xE7, 0x17, 0x00, 0x00, 0x15, 0x00, 0x03, 0x00,
+	0xEB, 0x0F, 0x00, 0x00, 0x12, 0x00, 0x02, 0x00, 0xE7, 0x01, 0x00, 0x00, 0x13, 0x00, 0x03, 0x00,
+	0xF7, 0x01, 0x00, 0x00, 0x14, 0x00, 0x03, 0x00, 0x11, 0x02, 0x00, 0x00, 0x2B, 0x00, 0x06, 0x00,
+	0x9D, 0x02, 0x00, 0x00, 0x16, 0x00, 0x03, 0x00, 0xAD, 0x02, 0x00, 0x00, 0x17, 0x00, 0x03, 0x00,
+	0x12, 0x06, 0x00, 0x00, 0x18, 0x00, 0x03, 0x00, 0xBD, 0x01, 0x00, 0x00, 0x2A, 0x00, 0x06, 0x00,
+	0x1C, 0x02, 0x00, 0x00, 0x20, 0x00, 0x04, 0x00, 0xB3, 0x02, 0x00, 0x00, 0x29, 0x00, 0x06, 0x00,
+	0xAD, 0x0F, 0x00, 0x00, 0x34, 0x00, 0x07, 0x00, 0xBE, 0x0F, 0x00, 0x00, 0x28, 0x00, 0x06, 0x00,
+	0xFA, 0x0F, 0x00, 0x00, 0x2C, 0x00, 0x06, 0x00, 0x29, 0x10, 0x00, 0x00, 0x26, 0x00, 0x05, 0x00,
+	0x20, 0x10, 0x00, 0x00, 0x27, 0x00, 0x05, 0x00, 0x61, 0x10, 0x00, 0x00, 0x30, 0x00, 0x07, 0x00,
+	0x6D, 0x10, 0x00, 0x00, 0x31, 0x00, 0x07, 0x00, 0x7E, 0x10, 0x00, 0x00, 0x32, 0x00, 0x07, 0x00,
+	0xB4, 0x17, 0x00, 0x00, 0x21, 0x00, 0x04, 0x00, 0xEF, 0x17, 0x00, 0x00, 0x24, 0x00, 0x04, 0x00,
+	0xCF, 0x17, 0x00, 0x00, 0x25, 0x00, 0x04, 0x00, 0x34, 0x18, 0x00, 0x00, 0x1D, 0x00, 0x03, 0x00,
+	0x40, 0x18, 0x00, 0x00, 0x1C, 0x00, 0x03, 0x00, 0x62, 0x18, 0x00, 0x00, 0x1F, 0x00, 0x04, 0x00,
+	0x30, 0x06, 0x00, 0x00, 0x1E, 0x00, 0x04, 0x00, 0x9C, 0x18, 0x00, 0x00, 0x19, 0x00, 0x03, 0x00,
+	0xA2, 0x18, 0x00, 0x00, 0x22, 0x00, 0x04, 0x00, 0x32, 0x10, 0x00, 0x00, 0x2D, 0x00, 0x06, 0x00,
+	0x80, 0x1A, 0x00, 0x00, 0x36, 0x00, 0x09, 0x00, 0x4A, 0x10, 0x00, 0x00, 0x2F, 0x00, 0x06, 0x00,
+	0xB8, 0x18, 0x00, 0x00, 0x1A, 0x00, 0x03, 0x00, 0x31, 0x01, 0x00, 0x00, 0x1B, 0x00, 0x03, 0x00,
+	0x1E, 0x01, 0x00, 0x00, 0x23, 0x00, 0x04, 0x00, 0x91, 0x1A, 0x00, 0x00, 0x2E, 0x00, 0x06, 0x00,
+	0xB7, 0x01, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0xC7, 0x01, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00,
+	0xCD, 0x01, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x13, 0x00, 0x00, 0x00, 0x05, 0x00, 0x01, 0x00,
+	0x46, 0x02, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0xF7, 0x01, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00,
+	0xAD, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x9E, 0x1A, 0x00, 0x00, 0x07, 0x00, 0x01, 0x00, 0xB3, 0x1A, 0x00, 0x00, 0x08, 0x00, 0x01, 0x00,
+	0x91, 0x10, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x9E, 0x10, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0xAA, 0x10, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xCA, 0x1A, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0xDB, 0x1A, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0xEB, 0x1A, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+	0x01, 0x1B, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x72, 0x03, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00,
+	0x6A, 0x03, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00, 0xE7, 0x03, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00,
+	0x9C, 0x04, 0x00, 0x00, 0x05, 0x00, 0x01, 0x00, 0x24, 0x04, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00,
+	0xF2, 0x04, 0x00, 0x00, 0x07, 0x00, 0x01, 0x00, 0x9D, 0x03, 0x00, 0x00, 0x08, 0x00, 0x01, 0x00,
+	0x07, 0x04, 0x00, 0x00, 0x09, 0x00, 0x01, 0x00, 0xF7, 0x04, 0x00, 0x00, 0x0A, 0x00, 0x01, 0x00,
+	0x76, 0x04, 0x00, 0x00, 0x0B, 0x00, 0x01, 0x00, 0x15, 0x05, 0x00, 0x00, 0x0C, 0x00, 0x01, 0x00,
+	0x06, 0x05, 0x00, 0x00, 0x0D, 0x00, 0x01, 0x00, 0x7E, 0x05, 0x00, 0x00, 0x0E, 0x00, 0x01, 0x00,
+	0x57, 0x05, 0x00, 0x00, 0x0F, 0x00, 0x01, 0x00, 0x31, 0x05, 0x00, 0x00, 0x10, 0x00, 0x01, 0x00,
+	0x89, 0x05, 0x00, 0x00, 0x11, 0x00, 0x01, 0x00, 0xA2, 0x06, 0x00, 0x00, 0x12, 0x00, 0x01, 0x00,
+	0x16, 0x08, 0x00, 0x00, 0x13, 0x00, 0x01, 0x00, 0xE1, 0x05, 0x00, 0x00, 0x14, 0x00, 0x01, 0x00,
+	0x82, 0x08, 0x00, 0x00, 0x15, 0x00, 0x01, 0x00, 0x53, 0x0F, 0x00, 0x00, 0x16, 0x00, 0x01, 0x00,
+	0x68, 0x07, 0x00, 0x00, 0x17, 0x00, 0x01, 0x00, 0xA4, 0x0F, 0x00, 0x00, 0x18, 0x00, 0x01, 0x00,
+	0x4D, 0x0A, 0x00, 0x00, 0x19, 0x00, 0x01, 0x00, 0x52, 0x0E, 0x00, 0x00, 0x1A, 0x00, 0x01, 0x00,
+	0x33, 0x08, 0x00, 0x00, 0x1B, 0x00, 0x01, 0x00, 0xD6, 0x09, 0x00, 0x00, 0x1C, 0x00, 0x01, 0x00,
+	0x4B, 0x0D, 0x00, 0x00, 0x1D, 0x00, 0x01, 0x00, 0xCC, 0x0D, 0x00, 0x00, 0x1E, 0x00, 0x01, 0x00,
+	0x24, 0x0F, 0x00, 0x00, 0x1F, 0x00, 0x01, 0x00, 0x28, 0x07, 0x00, 0x00, 0x20, 0x00, 0x01, 0x00,
+	0xC2, 0x08, 0x00, 0x00, 0x21, 0x00, 0x01, 0x00, 0xB9, 0x06, 0x00, 0x00, 0x22, 0x00, 0x01, 0x00,
+	0xEB, 0x0B, 0x00, 0x00, 0x23, 0x00, 0x01, 0x00, 0xF7, 0x07, 0x00, 0x00, 0x24, 0x00, 0x01, 0x00,
+	0xD5, 0x06, 0x00, 0x00, 0x25, 0x00, 0x01, 0x00, 0xD6, 0x07, 0x00, 0x00, 0x26, 0x00, 0x01, 0x00,
+	0x45, 0x06, 0x00, 0x00, 0x27, 0x00, 0x01, 0x00, 0xE6, 0x09, 0x00, 0x00, 0x28, 0x00, 0x01, 0x00,
+	0x2C, 0x09, 0x00, 0x00, 0x29, 0x00, 0x01, 0x00, 0x95, 0x0B, 0x00, 0x00, 0x2A, 0x00, 0x01, 0x00,
+	0x14, 0x0D, 0x00, 0x00, 0x2B, 0x00, 0x01, 0x00, 0xE5, 0x0B, 0x00, 0x00, 0x2C, 0x00, 0x01, 0x00,
+	0x56, 0x0C, 0x00, 0x00, 0x2D, 0x00, 0x01, 0x00, 0xF3, 0x0A, 0x00, 0x00, 0x2E, 0x00, 0x01, 0x00,
+	0xC4, 0x07, 0x00, 0x00, 0x2F, 0x00, 0x01, 0x00, 0xDA, 0x0C, 0x00, 0x00, 0x30, 0x00, 0x01, 0x00,
+	0x10, 0x0E, 0x00, 0x00, 0x31, 0x00, 0x01, 0x00, 0xC4, 0x06, 0x00, 0x00, 0x32, 0x00, 0x01, 0x00,
+	0x35, 0x09, 0x00, 0x00, 0x33, 0x00, 0x01, 0x00, 0x1E, 0x0F, 0x00, 0x00, 0x34, 0x00, 0x01, 0x00,
+	0xF5, 0x0B, 0x00, 0x00, 0x35, 0x00, 0x01, 0x00, 0xD8, 0x08, 0x00, 0x00, 0x36, 0x00, 0x01, 0x00,
+	0xB4, 0x0D, 0x00, 0x00, 0x37, 0x00, 0x01, 0x00, 0x4C, 0x0F, 0x00, 0x00, 0x38, 0x00, 0x01, 0x00,
+	0x9A, 0x0C, 0x00, 0x00, 0x39, 0x00, 0x01, 0x00, 0xE4, 0x06, 0x00, 0x00, 0x3A, 0x00, 0x01, 0x00,
+	0xEB, 0x05, 0x00, 0x00, 0x3B, 0x00, 0x01, 0x00, 0x08, 0x0C, 0x00, 0x00, 0x3C, 0x00, 0x01, 0x00,
+	0xF8, 0x05, 0x00, 0x00, 0x3D, 0x00, 0x01, 0x00, 0x91, 0x06, 0x00, 0x00, 0x3E, 0x00, 0x01, 0x00,
+	0xFF, 0x0E, 0x00, 0x00, 0x3F, 0x00, 0x01, 0x00, 0x3E, 0x07, 0x00, 0x00, 0x40, 0x00, 0x01, 0x00,
+	0x5B, 0x06, 0x00, 0x00, 0x41, 0x00, 0x01, 0x00, 0x0E, 0x0A, 0x00, 0x00, 0x42, 0x00, 0x01, 0x00,
+	0x92, 0x0A, 0x00, 0x00, 0x43, 0x00, 0x01, 0x00, 0x13, 0x0B, 0x00, 0x00, 0x44, 0x00, 0x01, 0x00,
+	0xFD, 0x0B, 0x00, 0x00, 0x45, 0x00, 0x01, 0x00, 0xB7, 0x0A, 0x00, 0x00, 0x46, 0x00, 0x01, 0x00,
+	0x2C, 0x0B, 0x00, 0x00, 0x47, 0x00, 0x01, 0x00, 0xBC, 0x0B, 0x00, 0x00, 0x48, 0x00, 0x01, 0x00,
+	0x2F, 0x0D, 0x00, 0x00, 0x49, 0x00, 0x01, 0x00, 0x6A, 0x0D, 0x00, 0x00, 0x4A, 0x00, 0x01, 0x00,
+	0xBB, 0x0C, 0x00, 0x00, 0x4B, 0x00, 0x01, 0x00, 0xB4, 0x09, 0x00, 0x00, 0x4C, 0x00, 0x01, 0x00,
+	0xB6, 0x08, 0x00, 0x00, 0x4D, 0x00, 0x01, 0x00, 0xED, 0x0A, 0x00, 0x00, 0x4E, 0x00, 0x01, 0x00,
+	0x42, 0x0D, 0x00, 0x00, 0x4F, 0x00, 0x01, 0x00, 0x5F, 0x0B, 0x00, 0x00, 0x50, 0x00, 0x01, 0x00,
+	0x67, 0x0E, 0x00, 0x00, 0x51, 0x00, 0x01, 0x00, 0x9D, 0x07, 0x00, 0x00, 0x52, 0x00, 0x01, 0x00,
+	0xC7, 0x05, 0x00, 0x00, 0x53, 0x00, 0x01, 0x00, 0xAD, 0x08, 0x00, 0x00, 0x54, 0x00, 0x01, 0x00,
+	0x93, 0x0D, 0x00, 0x00, 0x55, 0x00, 0x01, 0x00, 0x6B, 0x0F, 0x00, 0x00, 0x56, 0x00, 0x01, 0x00,
+	0xA2, 0x0D, 0x00, 0x00, 0x57, 0x00, 0x01, 0x00, 0x8D, 0x0A, 0x00, 0x00, 0x58, 0x00, 0x01, 0x00,
+	0x46, 0x08, 0x00, 0x00, 0x59, 0x00, 0x01, 0x00, 0x5C, 0x09, 0x00, 0x00, 0x5A, 0x00, 0x01, 0x00,
+	0x9F, 0x0E, 0x00, 0x00, 0x5B, 0x00, 0x01, 0x00, 0xF7, 0x09, 0x00, 0x00, 0x5C, 0x00, 0x01, 0x00,
+	0xB0, 0x0A, 0x00, 0x00, 0x5D, 0x00, 0x01, 0x00, 0xA2, 0x05, 0x00, 0x00, 0x5E, 0x00, 0x01, 0x00,
+	0xBD, 0x0E, 0x00, 0x00, 0x5F, 0x00, 0x01, 0x00, 0x17, 0x0E, 0x00, 0x00, 0x60, 0x00, 0x01, 0x00,
+	0x7E, 0x0E, 0x00, 0x00, 0x61, 0x00, 0x01, 0x00, 0xF7, 0x0C, 0x00, 0x00, 0x62, 0x00, 0x01, 0x00,
+	0x26, 0x09, 0x00, 0x00, 0x63, 0x00, 0x01, 0x00, 0x89, 0x08, 0x00, 0x00, 0x64, 0x00, 0x01, 0x00,
+	0x5E, 0x03, 0x00, 0x00, 0x65, 0x00, 0x02, 0x00, 0xFB, 0x03, 0x00, 0x00, 0x66, 0x00, 0x02, 0x00,
+	0x8F, 0x04, 0x00, 0x00, 0x67, 0x00, 0x02, 0x00, 0xF3, 0x03, 0x00, 0x00, 0x68, 0x00, 0x02, 0x00,
+	0xC8, 0x04, 0x00, 0x00, 0x69, 0x00, 0x02, 0x00, 0xCF, 0x04, 0x00, 0x00, 0x6A, 0x00, 0x02, 0x00,
+	0x83, 0x05, 0x00, 0x00, 0x6B, 0x00, 0x02, 0x00, 0x0A, 0x1B, 0x00, 0x00, 0x6C, 0x00, 0x02, 0x00,
+	0x95, 0x04, 0x00, 0x00, 0x6D, 0x00, 0x02, 0x00, 0xAB, 0x04, 0x00, 0x00, 0x6E, 0x00, 0x02, 0x00,
+	0x60, 0x05, 0x00, 0x00, 0x6F, 0x00, 0x02, 0x00, 0x10, 0x1B, 0x00, 0x00, 0x70, 0x00, 0x02, 0x00,
+	0x1D, 0x03, 0x00, 0x00, 0x71, 0x00, 0x02, 0x00, 0x72, 0x05, 0x00, 0x00, 0x72, 0x00, 0x02, 0x00,
+	0xBC, 0x04, 0x00, 0x00, 0x73, 0x00, 0x02, 0x00, 0xB7, 0x04, 0x00, 0x00, 0x74, 0x00, 0x02, 0x00,
+	0x42, 0x05, 0x00, 0x00, 0x75, 0x00, 0x02, 0x00, 0x37, 0x07, 0x00, 0x00, 0x76, 0x00, 0x02, 0x00,
+	0x09, 0x07, 0x00, 0x00, 0x77, 0x00, 0x02, 0x00, 0x4A, 0x0B, 0x00, 0x00, 0x78, 0x00, 0x02, 0x00,
+	0x6E, 0x09, 0x00, 0x00, 0x79, 0x00, 0x02, 0x00, 0x67, 0x06, 0x00, 0x00, 0x7A, 0x00, 0x02, 0x00,
+	0x39, 0x08, 0x00, 0x00, 0x7B, 0x00, 0x02, 0x00, 0xC2, 0x0A, 0x00, 0x00, 0x7C, 0x00, 0x02, 0x00,
+	0x0F, 0x0D, 0x00, 0x00, 0x7D, 0x00, 0x02, 0x00, 0x98, 0x06, 0x00, 0x00, 0x7E, 0x00, 0x02, 0x00,
+	0x66, 0x0B, 0x00, 0x00, 0x7F, 0x00, 0x02, 0x00, 0xFF, 0x06, 0x00, 0x00, 0x80, 0x00, 0x02, 0x00,
+	0xDC, 0x07, 0x00, 0x00, 0x81, 0x00, 0x02, 0x00, 0xCF, 0x09, 0x00, 0x00, 0x82, 0x00, 0x02, 0x00,
+	0xCC, 0x08, 0x00, 0x00, 0x83, 0x00, 0x02, 0x00, 0x52, 0x07, 0x00, 0x00, 0x84, 0x00, 0x02, 0x00,
+	0xDE, 0x0A, 0x00, 0x00, 0x85, 0x00, 0x02, 0x00, 0x1A, 0x0A, 0x00, 0x00, 0x86, 0x00, 0x02, 0x00,
+	0xAD, 0x0C, 0x00, 0x00, 0x87, 0x00, 0x02, 0x00, 0xAC, 0x07, 0x00, 0x00, 0x88, 0x00, 0x02, 0x00,
+	0x90, 0x08, 0x00, 0x00, 0x89, 0x00, 0x02, 0x00, 0x06, 0x08, 0x00, 0x00, 0x8A, 0x00, 0x02, 0x00,
+	0xC4, 0x0E, 0x00, 0x00, 0x8B, 0x00, 0x02, 0x00, 0xCE, 0x0C, 0x00, 0x00, 0x8C, 0x00, 0x02, 0x00,
+	0xC3, 0x0B, 0x00, 0x00, 0x8D, 0x00, 0x02, 0x00, 0x75, 0x06, 0x00, 0x00, 0x8E, 0x00, 0x02, 0x00,
+	0xB2, 0x06, 0x00, 0x00, 0x8F, 0x00, 0x02, 0x00, 0x28, 0x0A, 0x00, 0x00, 0x90, 0x00, 0x02, 0x00,
+	0x09, 0x0E, 0x00, 0x00, 0x91, 0x00, 0x02, 0x00, 0x7F, 0x0A, 0x00, 0x00, 0x92, 0x00, 0x02, 0x00,
+	0x03, 0x09, 0x00, 0x00, 0x93, 0x00, 0x02, 0x00, 0x7F, 0x0F, 0x00, 0x00, 0x94, 0x00, 0x02, 0x00,
+	0x28, 0x0C, 0x00, 0x00, 0x95, 0x00, 0x02, 0x00, 0xAF, 0x0D, 0x00, 0x00, 0x96, 0x00, 0x02, 0x00,
+	0xF0, 0x05, 0x00, 0x00, 0x97, 0x00, 0x02, 0x00, 0x8C, 0x0E, 0x00, 0x00, 0x98, 0x00, 0x02, 0x00,
+	0xEF, 0x07, 0x00, 0x00, 0x99, 0x00, 0x02, 0x00, 0x34, 0x0E, 0x00, 0x00, 0x9A, 0x00, 0x02, 0x00,
+	0x69, 0x08, 0x00, 0x00, 0x9B, 0x00, 0x02, 0x00, 0xC1, 0x0D, 0x00, 0x00, 0x9C, 0x00, 0x02, 0x00,
+	0x31, 0x0C, 0x00, 0x00, 0x9D, 0x00, 0x02, 0x00, 0x92, 0x0E, 0x00, 0x00, 0x9E, 0x00, 0x02, 0x00,
+	0x20, 0x08, 0x00, 0x00, 0x9F, 0x00, 0x02, 0x00, 0x73, 0x07, 0x00, 0x00, 0xA0, 0x00, 0x02, 0x00,
+	0xD5, 0x05, 0x00, 0x00, 0xA1, 0x00, 0x02, 0x00, 0x6B, 0x0B, 0x00, 0x00, 0xA2, 0x00, 0x02, 0x00,
+	0xFA, 0x0A, 0x00, 0x00, 0xA3, 0x00, 0x02, 0x00, 0x64, 0x0F, 0x00, 0x00, 0xA4, 0x00, 0x02, 0x00,
+	0xCB, 0x0E, 0x00, 0x00, 0xA5, 0x00, 0x02, 0x00, 0xF9, 0x06, 0x00, 0x00, 0xA6, 0x00, 0x02, 0x00,
+	0x41, 0x08, 0x00, 0x00, 0xA7, 0x00, 0x02, 0x00, 0x04, 0x0A, 0x00, 0x00, 0xA8, 0x00, 0x02, 0x00,
+	0x9C, 0x0B, 0x00, 0x00, 0xA9, 0x00, 0x02, 0x00, 0xDA, 0x0D, 0x00, 0x00, 0xAA, 0x00, 0x02, 0x00,
+	0xA3, 0x07, 0x00, 0x00, 0xAB, 0x00, 0x02, 0x00, 0x9C, 0x0D, 0x00, 0x00, 0xAC, 0x00, 0x02, 0x00,
+	0x25, 0x0B, 0x00, 0x00, 0xAD, 0x00, 0x02, 0x00, 0x37, 0x0C, 0x00, 0x00, 0xAE, 0x00, 0x02, 0x00,
+	0x2C, 0x06, 0x00, 0x00, 0xAF, 0x00, 0x02, 0x00, 0x33, 0x0D, 0x00, 0x00, 0xB0, 0x00, 0x02, 0x00,
+	0xE0, 0x0B, 0x00, 0x00, 0xB1, 0x00, 0x02, 0x00, 0x52, 0x0D, 0x00, 0x00, 0xB2, 0x00, 0x02, 0x00,
+	0x02, 0x0D, 0x00, 0x00, 0xB3, 0x00, 0x02, 0x00, 0xD3, 0x0E, 0x00, 0x00, 0xB4, 0x00, 0x02, 0x00,
+	0xFD, 0x08, 0x00, 0x00, 0xB5, 0x00, 0x02, 0x00, 0x31, 0x0B, 0x00, 0x00, 0xB6, 0x00, 0x02, 0x00,
+	0x94, 0x09, 0x00, 0x00, 0xB7, 0x00, 0x02, 0x00, 0x1F, 0x0C, 0x00, 0x00, 0xB8, 0x00, 0x02, 0x00,
+	0x87, 0x0D, 0x00, 0x00, 0xB9, 0x00, 0x02, 0x00, 0x16, 0x06, 0x00, 0x00, 0xBA, 0x00, 0x02, 0x00,
+	0x9E, 0x06, 0x00, 0x00, 0xBB, 0x00, 0x02, 0x00, 0x18, 0x07, 0x00, 0x00, 0xBC, 0x00, 0x02, 0x00,
+	0x9D, 0x09, 0x00, 0x00, 0xBD, 0x00, 0x02, 0x00, 0x59, 0x0E, 0x00, 0x00, 0xBE, 0x00, 0x02, 0x00,
+	0xA6, 0x08, 0x00, 0x00, 0xBF, 0x00, 0x02, 0x00, 0xB1, 0x05, 0x00, 0x00, 0xC0, 0x00, 0x02, 0x00,
+	0xE3, 0x0C, 0x00, 0x00, 0xC1, 0x00, 0x02, 0x00, 0x75, 0x0C, 0x00, 0x00, 0xC2, 0x00, 0x02, 0x00,
+	0x99, 0x0A, 0x00, 0x00, 0xC3, 0x00, 0x02, 0x00, 0x8D, 0x0F, 0x00, 0x00, 0xC4, 0x00, 0x02, 0x00,
+	0xDC, 0x06, 0x00, 0x00, 0xC5, 0x00, 0x02, 0x00, 0xE1, 0x0E, 0x00, 0x00, 0xC6, 0x00, 0x02, 0x00,
+	0x40, 0x09, 0x00, 0x00, 0xC7, 0x00, 0x02, 0x00, 0x50, 0x0A, 0x00, 0x00, 0xC8, 0x00, 0x02, 0x00,
+	0x1E, 0x04, 0x00, 0x00, 0xC9, 0x00, 0x03, 0x00, 0x7E, 0x04, 0x00, 0x00, 0xCA, 0x00, 0x03, 0x00,
+	0x72, 0x03, 0x00, 0x00, 0xCB, 0x00, 0x03, 0x00, 0xDB, 0x04, 0x00, 0x00, 0xCC, 0x00, 0x03, 0x00,
+	0xE1, 0x04, 0x00, 0x00, 0xCD, 0x00, 0x03, 0x00, 0xD6, 0x04, 0x00, 0x00, 0xCE, 0x00, 0x03, 0x00,
+	0xED, 0x03, 0x00, 0x00, 0xCF, 0x00, 0x03, 0x00, 0x79, 0x05, 0x00, 0x00, 0xD0, 0x00, 0x03, 0x00,
+	0x0D, 0x05, 0x00, 0x00, 0xD1, 0x00, 0x03, 0x00, 0x01, 0x04, 0x00, 0x00, 0xD2, 0x00, 0x03, 0x00,
+	0xB1, 0x04, 0x00, 0x00, 0xD3, 0x00, 0x03, 0x00, 0x9D, 0x03, 0x00, 0x00, 0xD4, 0x00, 0x03, 0x00,
+	0x07, 0x04, 0x00, 0x00, 0xD5, 0x00, 0x03, 0x00, 0x10, 0x1B, 0x00, 0x00, 0xD6, 0x00, 0x03, 0x00,
+	0x01, 0x1B, 0x00, 0x00, 0xD7, 0x00, 0x03, 0x00, 0x47, 0x05, 0x00, 0x00, 0xD8, 0x00, 0x03, 0x00,
+	0x50, 0x05, 0x00, 0x00, 0xD9, 0x00, 0x03, 0x00, 0x80, 0x09, 0x00, 0x00, 0xDA, 0x00, 0x03, 0x00,
+	0x36, 0x06, 0x00, 0x00, 0xDB, 0x00, 0x03, 0x00, 0xEC, 0x06, 0x00, 0x00, 0xDC, 0x00, 0x03, 0x00,
+	0x44, 0x07, 0x00, 0x00, 0xDD, 0x00, 0x03, 0x00, 0x0F, 0x09, 0x00, 0x00, 0xDE, 0x00, 0x03, 0x00,
+	0x02, 0x08, 0x00, 0x00, 0xDF, 0x00, 0x03, 0x00, 0x0C, 0x06, 0x00, 0x00, 0xE0, 0x00, 0x03, 0x00,
+	0xD2, 0x07, 0x00, 0x00, 0xE1, 0x00, 0x03, 0x00, 0xA6, 0x06, 0x00, 0x00, 0xE2, 0x00, 0x03, 0x00,
+	0x87, 0x06, 0x00, 0x00, 0xE3, 0x00, 0x03, 0x00, 0xA8, 0x0A, 0x00, 0x00, 0xE4, 0x00, 0x03, 0x00,
+	0xC1, 0x09, 0x00, 0x00, 0xE5, 0x00, 0x03, 0x00, 0x14, 0x0A, 0x00, 0x00, 0xE6, 0x00, 0x03, 0x00,
+	0xA0, 0x0B, 0x00, 0x00, 0xE7, 0x00, 0x03, 0x00, 0x50, 0x0B, 0x00, 0x00, 0xE8, 0x00, 0x03, 0x00,
+	0x19, 0x0B, 0x00, 0x00, 0xE9, 0x00, 0x03, 0x00, 0x5F, 0x0C, 0x00, 0x00, 0xEA, 0x00, 0x03, 0x00,
+	0x5C, 0x0D, 0x00, 0x00, 0xEB, 0x00, 0x03, 0x00, 0xED, 0x08, 0x00, 0x00, 0xEC, 0x00, 0x03, 0x00,
+	0x1C, 0x08, 0x00, 0x00, 0xED, 0x00, 0x03, 0x00, 0x09, 0x0D, 0x00, 0x00, 0xEE, 0x00, 0x03, 0x00,
+	0x04, 0x0F, 0x00, 0x00, 0xEF, 0x00, 0x03, 0x00, 0x2B, 0x08, 0x00, 0x00, 0xF0, 0x00, 0x03, 0x00,
+	0x57, 0x0A, 0x00, 0x00, 0xF1, 0x00, 0x03, 0x00, 0xFD, 0x09, 0x00, 0x00, 0xF2, 0x00, 0x03, 0x00,
+	0x10, 0x08, 0x00, 0x00, 0xF3, 0x00, 0x03, 0x00, 0xBE, 0x06, 0x00, 0x00, 0xF4, 0x00, 0x03, 0x00,
+	0xA2, 0x08, 0x00, 0x00, 0xF5, 0x00, 0x03, 0x00, 0x48, 0x09, 0x00, 0x00, 0xF6, 0x00, 0x03, 0x00,
+	0xA3, 0x09, 0x00, 0x00, 0xF7, 0x00, 0x03, 0x00, 0x34, 0x0F, 0x00, 0x00, 0xF8, 0x00, 0x03, 0x00,
+	0x1F, 0x06, 0x00, 0x00, 0xF9, 0x00, 0x03, 0x00, 0xB3, 0x07, 0x00, 0x00, 0xFA, 0x00, 0x03, 0x00,
+	0x79, 0x07, 0x00, 0x00, 0xFB, 0x00, 0x03, 0x00, 0x03, 0x07, 0x00, 0x00, 0xFC, 0x00, 0x03, 0x00,
+	0xD4, 0x0D, 0x00, 0x00, 0xFD, 0x00, 0x03, 0x00, 0x3F, 0x0C, 0x00, 0x00, 0xFE, 0x00, 0x03, 0x00,
+	0x76, 0x0F, 0x00, 0x00, 0xFF, 0x00, 0x03, 0x00, 0xF2, 0x09, 0x00, 0x00, 0x00, 0x01, 0x03, 0x00,
+	0x26, 0x06, 0x00, 0x00, 0x01, 0x01, 0x03, 0x00, 0x4B, 0x02, 0x00, 0x00, 0x02, 0x01, 0x03, 0x00,
+	0xF2, 0x06, 0x00, 0x00, 0x03, 0x01, 0x03, 0x00, 0xCE, 0x0B, 0x00, 0x00, 0x04, 0x01, 0x03, 0x00,
+	0x67, 0x09, 0x00, 0x00, 0x05, 0x01, 0x03, 0x00, 0x9F, 0x0C, 0x00, 0x00, 0x06, 0x01, 0x03, 0x00,
+	0xBA, 0x0D, 0x00, 0x00, 0x07, 0x01, 0x03, 0x00, 0x2C, 0x0F, 0x00, 0x00, 0x08, 0x01, 0x03, 0x00,
+	0x82, 0x0D, 0x00, 0x00, 0x09, 0x01, 0x03, 0x00, 0xC7, 0x08, 0x00, 0x00, 0x0A, 0x01, 0x03, 0x00,
+	0xC6, 0x0D, 0x00, 0x00, 0x0B, 0x01, 0x03, 0x00, 0xD0, 0x0A, 0x00, 0x00, 0x0C, 0x01, 0x03, 0x00,
+	0x03, 0x0C, 0x00, 0x00, 0x0D, 0x01, 0x03, 0x00, 0x8E, 0x0B, 0x00, 0x00, 0x0E, 0x01, 0x03, 0x00,
+	0x85, 0x0E, 0x00, 0x00, 0x0F, 0x01, 0x03, 0x00, 0x9F, 0x0F, 0x00, 0x00, 0x10, 0x01, 0x03, 0x00,
+	0xD1, 0x06, 0x00, 0x00, 0x11, 0x01, 0x03, 0x00, 0xA7, 0x0C, 0x00, 0x00, 0x12, 0x01, 0x03, 0x00,
+	0x6B, 0x0A, 0x00, 0x00, 0x13, 0x01, 0x03, 0x00, 0x7B, 0x0B, 0x00, 0x00, 0x14, 0x01, 0x03, 0x00,
+	0xD4, 0x0B, 0x00, 0x00, 0x15, 0x01, 0x03, 0x00, 0xF0, 0x0B, 0x00, 0x00, 0x16, 0x01, 0x03, 0x00,
+	0x75, 0x08, 0x00, 0x00, 0x17, 0x01, 0x03, 0x00, 0xD5, 0x0A, 0x00, 0x00, 0x18, 0x01, 0x03, 0x00,
+	0x59, 0x0B, 0x00, 0x00, 0x19, 0x01, 0x03, 0x00, 0x46, 0x0A, 0x00, 0x00, 0x1A, 0x01, 0x03, 0x00,
+	0xD4, 0x0C, 0x00, 0x00, 0x1B, 0x01, 0x03, 0x00, 0x4E, 0x0C, 0x00, 0x00, 0x1C, 0x01, 0x03, 0x00,
+	0x49, 0x0E, 0x00, 0x00, 0x1D, 0x01, 0x03, 0x00, 0xFD, 0x0C, 0x00, 0x00, 0x1E, 0x01, 0x03, 0x00,
+	0x5C, 0x0F, 0x00, 0x00, 0x1F, 0x01, 0x03, 0x00, 0x3C, 0x0D, 0x00, 0x00, 0x20, 0x01, 0x03, 0x00,
+	0x1E, 0x0D, 0x00, 0x00, 0x21, 0x01, 0x03, 0x00, 0xE9, 0x0E, 0x00, 0x00, 0x22, 0x01, 0x03, 0x00,
+	0x7A, 0x06, 0x00, 0x00, 0x23, 0x01, 0x03, 0x00, 0x5F, 0x0E, 0x00, 0x00, 0x24, 0x01, 0x03, 0x00,
+	0x3A, 0x0F, 0x00, 0x00, 0x25, 0x01, 0x03, 0x00, 0x31, 0x07, 0x00, 0x00, 0x26, 0x01, 0x03, 0x00,
+	0xA9, 0x05, 0x00, 0x00, 0x27, 0x01, 0x03, 0x00, 0x86, 0x0A, 0x00, 0x00, 0x28, 0x01, 0x03, 0x00,
+	0xB4, 0x0C, 0x00, 0x00, 0x29, 0x01, 0x03, 0x00, 0xF6, 0x08, 0x00, 0x00, 0x2A, 0x01, 0x03, 0x00,
+	0xEA, 0x0D, 0x00, 0x00, 0x2B, 0x01, 0x03, 0x00, 0xF3, 0x0D, 0x00, 0x00, 0x2C, 0x01, 0x03, 0x00,
+	0x01, 0x1B, 0x00, 0x00, 0x2D, 0x01, 0x04, 0x00, 0x6D, 0x04, 0x00, 0x00, 0x2E, 0x01, 0x04, 0x00,
+	0xFE, 0x04, 0x00, 0x00, 0x2F, 0x01, 0x04, 0x00, 0xC0, 0x04, 0x00, 0x00, 0x30, 0x01, 0x04, 0x00,
+	0x87, 0x04, 0x00, 0x00, 0x31, 0x01, 0x04, 0x00, 0x0A, 0x1B, 0x00, 0x00, 0x32, 0x01, 0x04, 0x00,
+	0x2A, 0x05, 0x00, 0x00, 0x33, 0x01, 0x04, 0x00, 0xA3, 0x04, 0x00, 0x00, 0x34, 0x01, 0x04, 0x00,
+	0x24, 0x04, 0x00, 0x00, 0x35, 0x01, 0x04, 0x00, 0x9D, 0x03, 0x00, 0x00, 0x36, 0x01, 0x04, 0x00,
+	0x89, 0x05, 0x00, 0x00, 0x37, 0x01, 0x04, 0x00, 0x6B, 0x05, 0x00, 0x00, 0x38, 0x01, 0x04, 0x00,
+	0x36, 0x05, 0x00, 0x00, 0x39, 0x01, 0x04, 0x00, 0xE9, 0x04, 0x00, 0x00, 0x3A, 0x01, 0x04, 0x00,
+	0x15, 0x05, 0x00, 0x00, 0x3B, 0x01, 0x04, 0x00, 0x3B, 0x05, 0x00, 0x00, 0x3C, 0x01, 0x04, 0x00,
+	0x62, 0x08, 0x00, 0x00, 0x3D, 0x01, 0x04, 0x00, 0x49, 0x07, 0x00, 0x00, 0x3E, 0x01, 0x04, 0x00,
+	0xDB, 0x05, 0x00, 0x00, 0x3F, 0x01, 0x04, 0x00, 0xB2, 0x0B, 0x00, 0x00, 0x40, 0x01, 0x04, 0x00,
+	0xE5, 0x08, 0x00, 0x00, 0x41, 0x01, 0x04, 0x00, 0xA2, 0x0A, 0x00, 0x00, 0x42, 0x01, 0x04, 0x00,
+	0x23, 0x07, 0x00, 0x00, 0x43, 0x01, 0x04, 0x00, 0x78, 0x0A, 0x00, 0x00, 0x44, 0x01, 0x04, 0x00,
+	0x02, 0x0B, 0x00, 0x00, 0x45, 0x01, 0x04, 0x00, 0x3A, 0x09, 0x00, 0x00, 0x46, 0x01, 0x04, 0x00,
+	0x45, 0x0C, 0x00, 0x00, 0x47, 0x01, 0x04, 0x00, 0x35, 0x0A, 0x00, 0x00, 0x48, 0x01, 0x04, 0x00,
+	0xC9, 0x07, 0x00, 0x00, 0x49, 0x01, 0x04, 0x00, 0xEB, 0x09, 0x00, 0x00, 0x4A, 0x01, 0x04, 0x00,
+	0x1F, 0x0A, 0x00, 0x00, 0x4B, 0x01, 0x04, 0x00, 0xBD, 0x08, 0x00, 0x00, 0x4C, 0x01, 0x04, 0x00,
+	0x12, 0x07, 0x00, 0x00, 0x4D, 0x01, 0x04, 0x00, 0x4C, 0x08, 0x00, 0x00, 0x4E, 0x01, 0x04, 0x00,
+	0xA9, 0x0D, 0x00, 0x00, 0x4F, 0x01, 0x04, 0x00, 0xC2, 0x0C, 0x00, 0x00, 0x50, 0x01, 0x04, 0x00,
+	0x6D, 0x0C, 0x00, 0x00, 0x51, 0x01, 0x04, 0x00, 0x93, 0x0F, 0x00, 0x00, 0x52, 0x01, 0x04, 0x00,
+	0x99, 0x0E, 0x00, 0x00, 0x53, 0x01, 0x04, 0x00, 0x2B, 0x0D, 0x00, 0x00, 0x54, 0x01, 0x04, 0x00,
+	0x37, 0x0B, 0x00, 0x00, 0x55, 0x01, 0x04, 0x00, 0x7C, 0x08, 0x00, 0x00, 0x56, 0x01, 0x04, 0x00,
+	0xB7, 0x05, 0x00, 0x00, 0x57, 0x01, 0x04, 0x00, 0x1E, 0x07, 0x00, 0x00, 0x58, 0x01, 0x04, 0x00,
+	0xE9, 0x07, 0x00, 0x00, 0x59, 0x01, 0x04, 0x00, 0x2E, 0x0A, 0x00, 0x00, 0x5A, 0x01, 0x04, 0x00,
+	0x88, 0x07, 0x00, 0x00, 0x5B, 0x01, 0x04, 0x00, 0xD0, 0x05, 0x00, 0x00, 0x5C, 0x01, 0x04, 0x00,
+	0x57, 0x0D, 0x00, 0x00, 0x5D, 0x01, 0x04, 0x00, 0xE7, 0x0A, 0x00, 0x00, 0x5E, 0x01, 0x04, 0x00,
+	0xAC, 0x09, 0x00, 0x00, 0x5F, 0x01, 0x04, 0x00, 0xB7, 0x0B, 0x00, 0x00, 0x60, 0x01, 0x04, 0x00,
+	0xDA, 0x0B, 0x00, 0x00, 0x61, 0x01, 0x04, 0x00, 0x89, 0x0B, 0x00, 0x00, 0x62, 0x01, 0x04, 0x00,
+	0x1C, 0x0E, 0x00, 0x00, 0x63, 0x01, 0x04, 0x00, 0xA5, 0x0E, 0x00, 0x00, 0x64, 0x01, 0x04, 0x00,
+	0xF0, 0x0C, 0x00, 0x00, 0x65, 0x01, 0x04, 0x00, 0x20, 0x0B, 0x00, 0x00, 0x66, 0x01, 0x04, 0x00,
+	0x72, 0x0A, 0x00, 0x00, 0x67, 0x01, 0x04, 0x00, 0x0F, 0x0C, 0x00, 0x00, 0x68, 0x01, 0x04, 0x00,
+	0xCB, 0x06, 0x00, 0x00, 0x69, 0x01, 0x04, 0x00, 0xF8, 0x0E, 0x00, 0x00, 0x6A, 0x01, 0x04, 0x00,
+	0xEA, 0x0C, 0x00, 0x00, 0x6B, 0x01, 0x04, 0x00, 0x66, 0x0C, 0x00, 0x00, 0x6C, 0x01, 0x04, 0x00,
+	0x7C, 0x0D, 0x00, 0x00, 0x6D, 0x01, 0x04, 0x00, 0x85, 0x09, 0x00, 0x00, 0x6E, 0x01, 0x04, 0x00,
+	0x0A, 0x0B, 0x00, 0x00, 0x6F, 0x01, 0x04, 0x00, 0xE6, 0x05, 0x00, 0x00, 0x70, 0x01, 0x04, 0x00,
+	0x82, 0x0B, 0x00, 0x00, 0x71, 0x01, 0x04, 0x00, 0x6D, 0x06, 0x00, 0x00, 0x72, 0x01, 0x04, 0x00,
+	0xF2, 0x0E, 0x00, 0x00, 0x73, 0x01, 0x04, 0x00, 0xDF, 0x0D, 0x00, 0x00, 0x74, 0x01, 0x04, 0x00,
+	0xDE, 0x08, 0x00, 0x00, 0x75, 0x01, 0x04, 0x00, 0x2F, 0x0E, 0x00, 0x00, 0x76, 0x01, 0x04, 0x00,
+	0xB7, 0x07, 0x00, 0x00, 0x77, 0x01, 0x04, 0x00, 0x19, 0x0C, 0x00, 0x00, 0x78, 0x01, 0x04, 0x00,
+	0x3D, 0x0B, 0x00, 0x00, 0x79, 0x01, 0x04, 0x00, 0x81, 0x07, 0x00, 0x00, 0x7A, 0x01, 0x04, 0x00,
+	0xD9, 0x0E, 0x00, 0x00, 0x7B, 0x01, 0x04, 0x00, 0x8D, 0x0D, 0x00, 0x00, 0x7C, 0x01, 0x04, 0x00,
+	0x1F, 0x09, 0x00, 0x00, 0x7D, 0x01, 0x04, 0x00, 0x71, 0x0F, 0x00, 0x00, 0x7E, 0x01, 0x04, 0x00,
+	0xC8, 0x0A, 0x00, 0x00, 0x7F, 0x01, 0x04, 0x00, 0x4F, 0x09, 0x00, 0x00, 0x80, 0x01, 0x04, 0x00,
+	0x6F, 0x08, 0x00, 0x00, 0x81, 0x01, 0x04, 0x00, 0xAC, 0x06, 0x00, 0x00, 0x82, 0x01, 0x04, 0x00,
+	0x3F, 0x0F, 0x00, 0x00, 0x83, 0x01, 0x04, 0x00, 0xD1, 0x08, 0x00, 0x00, 0x84, 0x01, 0x04, 0x00,
+	0x25, 0x08, 0x00, 0x00, 0x85, 0x01, 0x04, 0x00, 0x03, 0x0E, 0x00, 0x00, 0x86, 0x01, 0x04, 0x00,
+	0x0A, 0x08, 0x00, 0x00, 0x87, 0x01, 0x04, 0x00, 0x91, 0x0C, 0x00, 0x00, 0x88, 0x01, 0x04, 0x00,
+	0x8C, 0x09, 0x00, 0x00, 0x89, 0x01, 0x04, 0x00, 0x04, 0x06, 0x00, 0x00, 0x8A, 0x01, 0x04, 0x00,
+	0x0A, 0x0F, 0x00, 0x00, 0x8B, 0x01, 0x04, 0x00, 0xC8, 0x0B, 0x00, 0x00, 0x8C, 0x01, 0x04, 0x00,
+	0x25, 0x0D, 0x00, 0x00, 0x8D, 0x01, 0x04, 0x00, 0x81, 0x06, 0x00, 0x00, 0x8E, 0x01, 0x04, 0x00,
+	0x3E, 0x06, 0x00, 0x00, 0x8F, 0x01, 0x04, 0x00, 0x30, 0x06, 0x00, 0x00, 0x90, 0x01, 0x04, 0x00,
+	0x1C, 0x1B, 0x00, 0x00, 0x91, 0x01, 0x05, 0x00, 0x2F, 0x1B, 0x00, 0x00, 0x92, 0x01, 0x05, 0x00,
+	0x48, 0x1B, 0x00, 0x00, 0x93, 0x01, 0x05, 0x00, 0x63, 0x1B, 0x00, 0x00, 0x94, 0x01, 0x05, 0x00,
+	0x7B, 0x1B, 0x00, 0x00, 0x95, 0x01, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x91, 0x1B, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0xAD, 0x1B, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00,
+	0xFE, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x22, 0x02, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xDA, 0x17, 0x00, 0x00, 0x33, 0x00, 0x07, 0x00,
+	0xC8, 0x1B, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x5E, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xED, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x72, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x07, 0x04, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x89, 0x05, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0xFB, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x01, 0x04, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x7E, 0x04, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0x87, 0x04, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x24, 0x04, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0x8F, 0x04, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+	0x1E, 0x04, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x8F, 0x03, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00,
+	0x9C, 0x04, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0xBD, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00,
+	0x58, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xA7, 0x18, 0x00, 0x00, 0x35, 0x00, 0x08, 0x00,
+	0x69, 0x18, 0x00, 0x00, 0x37, 0x00, 0x09, 0x00, 0xE5, 0x18, 0x00, 0x00, 0x38, 0x00, 0x09, 0x00,
+	0xC6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xD8, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB4, 0x19, 0x00, 0x00, 0x39, 0x00, 0x0A, 0x00,
+	0x6D, 0x18, 0x00, 0x00, 0x3A, 0x00, 0x0A, 0x00, 0x14, 0x01, 0x00, 0x00, 0x3B, 0x00, 0x0A, 0x00,
+	0x03, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xB8, 0x10, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0xBF, 0x10, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0xF0, 0x1B, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0x0A, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x1F, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0xDE, 0x01, 0x00, 0x00, 0x0C, 0x00, 0x02, 0x00, 0x1C, 0x02, 0x00, 0x00, 0x09, 0x00, 0x02, 0x00,
+	0x19, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x02, 0x00, 0x3B, 0x02, 0x00, 0x00, 0x0E, 0x00, 0x02, 0x00,
+	0x4B, 0x02, 0x00, 0x00, 0x0B, 0x00, 0x02, 0x00, 0x51, 0x02, 0x00, 0x00, 0x0A, 0x00, 0x02, 0x00,
+	0x60, 0x02, 0x00, 0x00, 0x0F, 0x00, 0x02, 0x00, 0x00, 0x11, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00,
+	0x36, 0x1C, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x1F, 0x11, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00,
+	0x2E, 0x11, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00, 0x47, 0x1C, 0x00, 0x00, 0x05, 0x00, 0x01, 0x00,
+	0x4F, 0x11, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x5C, 0x1C, 0x00, 0x00, 0x07, 0x00, 0x01, 0x00,
+	0x6E, 0x11, 0x00, 0x00, 0x08, 0x00, 0x01, 0x00, 0x7D, 0x11, 0x00, 0x00, 0x09, 0x00, 0x01, 0x00,
+	0x6D, 0x1C, 0x00, 0x00, 0x0A, 0x00, 0x01, 0x00, 0x9E, 0x11, 0x00, 0x00, 0x0B, 0x00, 0x01, 0x00,
+	0x82, 0x1C, 0x00, 0x00, 0x0C, 0x00, 0x01, 0x00, 0xBD, 0x11, 0x00, 0x00, 0x0D, 0x00, 0x01, 0x00,
+	0xCC, 0x11, 0x00, 0x00, 0x0E, 0x00, 0x01, 0x00, 0x93, 0x1C, 0x00, 0x00, 0x0F, 0x00, 0x01, 0x00,
+	0xED, 0x11, 0x00, 0x00, 0x10, 0x00, 0x01, 0x00, 0xA8, 0x1C, 0x00, 0x00, 0x11, 0x00, 0x01, 0x00,
+	0x0C, 0x12, 0x00, 0x00, 0x12, 0x00, 0x01, 0x00, 0x1B, 0x12, 0x00, 0x00, 0x13, 0x00, 0x01, 0x00,
+	0xB9, 0x1C, 0x00, 0x00, 0x14, 0x00, 0x01, 0x00, 0x3C, 0x12, 0x00, 0x00, 0x15, 0x00, 0x01, 0x00,
+	0xCE, 0x1C, 0x00, 0x00, 0x16, 0x00, 0x01, 0x00, 0x5B, 0x12, 0x00, 0x00, 0x17, 0x00, 0x01, 0x00,
+	0x6A, 0x12, 0x00, 0x00, 0x18, 0x00, 0x01, 0x00, 0xDF, 0x1C, 0x00, 0x00, 0x19, 0x00, 0x01, 0x00,
+	0x8B, 0x12, 0x00, 0x00, 0x1A, 0x00, 0x01, 0x00, 0xF4, 0x1C, 0x00, 0x00, 0x1B, 0x00, 0x01, 0x00,
+	0xAA, 0x12, 0x00, 0x00, 0x1C, 0x00, 0x01, 0x00, 0xB9, 0x12, 0x00, 0x00, 0x1D, 0x00, 0x01, 0x00,
+	0x05, 0x1D, 0x00, 0x00, 0x1E, 0x00, 0x01, 0x00, 0xDA, 0x12, 0x00, 0x00, 0x1F, 0x00, 0x01, 0x00,
+	0x1A, 0x1D, 0x00, 0x00, 0x20, 0x00, 0x01, 0x00, 0xFD, 0x12, 0x00, 0x00, 0x21, 0x00, 0x01, 0x00,
+	0x0E, 0x13, 0x00, 0x00, 0x22, 0x00, 0x01, 0x00, 0x2D, 0x1D, 0x00, 0x00, 0x23, 0x00, 0x01, 0x00,
+	0x33, 0x13, 0x00, 0x00, 0x24, 0x00, 0x01, 0x00, 0x44, 0x1D, 0x00, 0x00, 0x25, 0x00, 0x01, 0x00,
+	0x5E, 0x13, 0x00, 0x00, 0x26, 0x00, 0x01, 0x00, 0x73, 0x13, 0x00, 0x00, 0x27, 0x00, 0x01, 0x00,
+	0x5B, 0x1D, 0x00, 0x00, 0x28, 0x00, 0x01, 0x00, 0xA0, 0x13, 0x00, 0x00, 0x29, 0x00, 0x01, 0x00,
+	0x76, 0x1D, 0x00, 0x00, 0x2A, 0x00, 0x01, 0x00, 0xC9, 0x13, 0x00, 0x00, 0x2B, 0x00, 0x01, 0x00,
+	0xDD, 0x13, 0x00, 0x00, 0x2C, 0x00, 0x01, 0x00, 0x8C, 0x1D, 0x00, 0x00, 0x2D, 0x00, 0x01, 0x00,
+	0x08, 0x14, 0x00, 0x00, 0x2E, 0x00, 0x01, 0x00, 0xA6, 0x1D, 0x00, 0x00, 0x2F, 0x00, 0x01, 0x00,
+	0x29, 0x14, 0x00, 0x00, 0x30, 0x00, 0x01, 0x00, 0x39, 0x14, 0x00, 0x00, 0x31, 0x00, 0x01, 0x00,
+	0xB8, 0x1D, 0x00, 0x00, 0x32, 0x00, 0x01, 0x00, 0x5C, 0x14, 0x00, 0x00, 0x33, 0x00, 0x01, 0x00,
+	0xCE, 0x1D, 0x00, 0x00, 0x34, 0x00, 0x01, 0x00, 0x85, 0x14, 0x00, 0x00, 0x35, 0x00, 0x01, 0x00,
+	0x99, 0x14, 0x00, 0x00, 0x36, 0x00, 0x01, 0x00, 0xE4, 0x1D, 0x00, 0x00, 0x37, 0x00, 0x01, 0x00,
+	0xC4, 0x14, 0x00, 0x00, 0x38, 0x00, 0x01, 0x00, 0xFE, 0x1D, 0x00, 0x00, 0x39, 0x00, 0x01, 0x00,
+	0xDF, 0x14, 0x00, 0x00, 0x3A, 0x00, 0x01, 0x00, 0xEC, 0x14, 0x00, 0x00, 0x3B, 0x00, 0x01, 0x00,
+	0x0D, 0x1E, 0x00, 0x00, 0x3C, 0x00, 0x01, 0x00, 0x14, 0x15, 0x00, 0x00, 0x3D, 0x00, 0x01, 0x00,
+	0x20, 0x1E, 0x00, 0x00, 0x3E, 0x00, 0x01, 0x00, 0x3D, 0x15, 0x00, 0x00, 0x3F, 0x00, 0x01, 0x00,
+	0x51, 0x15, 0x00, 0x00, 0x40, 0x00, 0x01, 0x00, 0x36, 0x1E, 0x00, 0x00, 0x41, 0x00, 0x01, 0x00,
+	0x87, 0x15, 0x00, 0x00, 0x42, 0x00, 0x01, 0x00, 0x50, 0x1E, 0x00, 0x00, 0x43, 0x00, 0x01, 0x00,
+	0xB0, 0x15, 0x00, 0x00, 0x44, 0x00, 0x01, 0x00, 0xC4, 0x15, 0x00, 0x00, 0x45, 0x00, 0x01, 0x00,
+	0x66, 0x1E, 0x00, 0x00, 0x46, 0x00, 0x01, 0x00, 0xF5, 0x15, 0x00, 0x00, 0x47, 0x00, 0x01, 0x00,
+	0x80, 0x1E, 0x00, 0x00, 0x48, 0x00, 0x01, 0x00, 0x14, 0x16, 0x00, 0x00, 0x49, 0x00, 0x01, 0x00,
+	0x23, 0x16, 0x00, 0x00, 0x4A, 0x00, 0x01, 0x00, 0x91, 0x1E, 0x00, 0x00, 0x4B, 0x00, 0x01, 0x00,
+	0x44, 0x16, 0x00, 0x00, 0x4C, 0x00, 0x01, 0x00, 0xA6, 0x1E, 0x00, 0x00, 0x4D, 0x00, 0x01, 0x00,
+	0x69, 0x16, 0x00, 0x00, 0x4E, 0x00, 0x01, 0x00, 0x7B, 0x16, 0x00, 0x00, 0x4F, 0x00, 0x01, 0x00,
+	0xBA, 0x1E, 0x00, 0x00, 0x50, 0x00, 0x01, 0x00, 0xAE, 0x16, 0x00, 0x00, 0x51, 0x00, 0x01, 0x00,
+	0xD2, 0x1E, 0x00, 0x00, 0x52, 0x00, 0x01, 0x00, 0xD9, 0x16, 0x00, 0x00, 0x53, 0x00, 0x01, 0x00,
+	0xEE, 0x16, 0x00, 0x00, 0x54, 0x00, 0x01, 0x00, 0xE9, 0x1E, 0x00, 0x00, 0x55, 0x00, 0x01, 0x00,
+	0x2B, 0x17, 0x00, 0x00, 0x56, 0x00, 0x01, 0x00, 0x04, 0x1F, 0x00, 0x00, 0x57, 0x00, 0x01, 0x00,
+	0x5E, 0x17, 0x00, 0x00, 0x58, 0x00, 0x01, 0x00, 0x77, 0x17, 0x00, 0x00, 0x59, 0x00, 0x01, 0x00,
+	0x1F, 0x1F, 0x00, 0x00, 0x5A, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28, 0x19, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00,
+	0x05, 0x19, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x4D, 0x19, 0x00, 0x00, 0x03, 0x00, 0x01, 0x00,
+	0x54, 0x19, 0x00, 0x00, 0x04, 0x00, 0x02, 0x00, 0x67, 0x19, 0x00, 0x00, 0x05, 0x00, 0x02, 0x00,
+	0x7A, 0x19, 0x00, 0x00, 0x06, 0x00, 0x02, 0x00, 0x98, 0x0F, 0x00, 0x00, 0x01, 0x00, 0x07, 0x00,
+	0xFB, 0x0D, 0x00, 0x00, 0x02, 0x00, 0x07, 0x00, 0x6E, 0x07, 0x00, 0x00, 0x03, 0x00, 0x07, 0x00,
+	0x4D, 0x06, 0x00, 0x00, 0x04, 0x00, 0x07, 0x00, 0x56, 0x09, 0x00, 0x00, 0x05, 0x00, 0x07, 0x00,
+	0x41, 0x0E, 0x00, 0x00, 0x06, 0x00, 0x07, 0x00, 0x6E, 0x0E, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00,
+	0x45, 0x0F, 0x00, 0x00, 0x08, 0x00, 0x07, 0x00, 0xCA, 0x09, 0x00, 0x00, 0x09, 0x00, 0x07, 0x00,
+	0x16, 0x0F, 0x00, 0x00, 0x0A, 0x00, 0x07, 0x00, 0x6F, 0x0D, 0x00, 0x00, 0x0B, 0x00, 0x07, 0x00,
+	0x19, 0x0D, 0x00, 0x00, 0x0C, 0x00, 0x07, 0x00, 0x74, 0x0B, 0x00, 0x00, 0x0D, 0x00, 0x07, 0x00,
+	0x17, 0x09, 0x00, 0x00, 0x0E, 0x00, 0x07, 0x00, 0xA6, 0x0B, 0x00, 0x00, 0x0F, 0x00, 0x07, 0x00,
+	0x8D, 0x06, 0x00, 0x00, 0x10, 0x00, 0x07, 0x00, 0xFD, 0x05, 0x00, 0x00, 0x11, 0x00, 0x07, 0x00,
+	0x61, 0x06, 0x00, 0x00, 0x12, 0x00, 0x07, 0x00, 0x97, 0x08, 0x00, 0x00, 0x13, 0x00, 0x07, 0x00,
+	0x08, 0x0A, 0x00, 0x00, 0x14, 0x00, 0x07, 0x00, 0x41, 0x0A, 0x00, 0x00, 0x15, 0x00, 0x07, 0x00,
+	0xBC, 0x0A, 0x00, 0x00, 0x16, 0x00, 0x07, 0x00, 0x75, 0x0D, 0x00, 0x00, 0x17, 0x00, 0x07, 0x00,
+	0x5B, 0x07, 0x00, 0x00, 0x18, 0x00, 0x07, 0x00, 0xBD, 0x07, 0x00, 0x00, 0x19, 0x00, 0x07, 0x00,
+	0x7C, 0x0C, 0x00, 0x00, 0x1A, 0x00, 0x07, 0x00, 0xE3, 0x0D, 0x00, 0x00, 0x1B, 0x00, 0x07, 0x00,
+	0xDF, 0x09, 0x00, 0x00, 0x1C, 0x00, 0x07, 0x00, 0x8B, 0x0C, 0x00, 0x00, 0x1D, 0x00, 0x07, 0x00,
+	0x3B, 0x0A, 0x00, 0x00, 0x1E, 0x00, 0x07, 0x00, 0x9E, 0x08, 0x00, 0x00, 0x1F, 0x00, 0x07, 0x00,
+	0x53, 0x06, 0x00, 0x00, 0x20, 0x00, 0x07, 0x00, 0x61, 0x09, 0x00, 0x00, 0x21, 0x00, 0x07, 0x00,
+	0xFC, 0x07, 0x00, 0x00, 0x22, 0x00, 0x07, 0x00, 0x09, 0x09, 0x00, 0x00, 0x23, 0x00, 0x07, 0x00,
+	0x13, 0x0C, 0x00, 0x00, 0x24, 0x00, 0x07, 0x00, 0xAA, 0x0B, 0x00, 0x00, 0x25, 0x00, 0x07, 0x00,
+	0x3B, 0x0E, 0x00, 0x00, 0x26, 0x00, 0x07, 0x00, 0x75, 0x0E, 0x00, 0x00, 0x27, 0x00, 0x07, 0x00,
+	0xBD, 0x09, 0x00, 0x00, 0x28, 0x00, 0x07, 0x00, 0xE3, 0x07, 0x00, 0x00, 0x29, 0x00, 0x07, 0x00,
+	0x44, 0x0B, 0x00, 0x00, 0x2A, 0x00, 0x07, 0x00, 0x82, 0x0C, 0x00, 0x00, 0x2B, 0x00, 0x07, 0x00,
+	0xC0, 0x05, 0x00, 0x00, 0x2C, 0x00, 0x07, 0x00, 0x62, 0x07, 0x00, 0x00, 0x2D, 0x00, 0x07, 0x00,
+	0x87, 0x0F, 0x00, 0x00, 0x2E, 0x00, 0x07, 0x00, 0xC9, 0x0C, 0x00, 0x00, 0x2F, 0x00, 0x07, 0x00,
+	0xFD, 0x0A, 0x00, 0x00, 0x30, 0x00, 0x07, 0x00, 0x12, 0x06, 0x00, 0x00, 0x31, 0x00, 0x07, 0x00,
+	0x10, 0x0F, 0x00, 0x00, 0x32, 0x00, 0x07, 0x00, 0x3E, 0x1F, 0x00, 0x00, 0x01, 0x00, 0x06, 0x00,
+	0x44, 0x1F, 0x00, 0x00, 0x02, 0x00, 0x06, 0x00, 0x4A, 0x1F, 0x00, 0x00, 0x03, 0x00, 0x06, 0x00,
+	0x52, 0x1F, 0x00, 0x00, 0x04, 0x00, 0x06, 0x00, 0x57, 0x1F, 0x00, 0x00, 0x05, 0x00, 0x06, 0x00,
+	0x5F, 0x1F, 0x00, 0x00, 0x06, 0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0x7B, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x90, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+	0xA9, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0xBE, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0xCB, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xE6, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x02, 0x20, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00,
+	0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0xE9, 0x02, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00,
+	0xA7, 0x02, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xCF, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0xD5, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+	0xDC, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0xE2, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+	0xF2, 0x02, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x1D, 0x20, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00,
+	0x57, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x86, 0x18, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x8A, 0x18, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+	0xBA, 0x19, 0x00, 0x00, 0x3C, 0x00, 0x0A, 0x00, 0x74, 0x18, 0x00, 0x00, 0x3D, 0x00, 0x0A, 0x00,
+	0xBE, 0x18, 0x00, 0x00, 0x3E, 0x00, 0x0A, 0x00, 0xCE, 0x0F, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00,
+	0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x01, 0x00, 0x59, 0x02, 0x00, 0x00, 0x10, 0x00, 0x03, 0x00,
+	0x64, 0x02, 0x00, 0x00, 0x11, 0x00, 0x03, 0x00, 0x24, 0x20, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00,
+	0x3D, 0x20, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x56, 0x20, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00,
+	0x8B, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x99, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xA8, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x91, 0x18, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+	0x97, 0x18, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x72, 0x20, 0x00, 0x00, 0x12, 0x00, 0x04, 0x00,
+	0x82, 0x20, 0x00, 0x00, 0x13, 0x00, 0x04, 0x00, 0x92, 0x20, 0x00, 0x00, 0x14, 0x00, 0x04, 0x00,
+	0xCB, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xC5, 0x10, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x5F, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00,
+	0xD3, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x4B, 0x02, 0x00, 0x00, 0x45, 0x00, 0x0D, 0x00, 0x8B, 0x02, 0x00, 0x00, 0x42, 0x00, 0x0C, 0x00,
+	0xA3, 0x20, 0x00, 0x00, 0x49, 0x00, 0x0D, 0x00, 0x01, 0x1B, 0x00, 0x00, 0x46, 0x00, 0x0D, 0x00,
+	0xB3, 0x0F, 0x00, 0x00, 0x41, 0x00, 0x0B, 0x00, 0xD9, 0x0F, 0x00, 0x00, 0x40, 0x00, 0x0B, 0x00,
+	0xE0, 0x0F, 0x00, 0x00, 0x51, 0x00, 0x0D, 0x00, 0x54, 0x10, 0x00, 0x00, 0x43, 0x00, 0x0C, 0x00,
+	0x89, 0x10, 0x00, 0x00, 0x3F, 0x00, 0x0B, 0x00, 0xAC, 0x17, 0x00, 0x00, 0x4C, 0x00, 0x0D, 0x00,
+	0xBE, 0x17, 0x00, 0x00, 0x4D, 0x00, 0x0D, 0x00, 0xE1, 0x17, 0x00, 0x00, 0x47, 0x00, 0x0D, 0x00,
+	0xF8, 0x17, 0x00, 0x00, 0x4F, 0x00, 0x0D, 0x00, 0x23, 0x18, 0x00, 0x00, 0x4A, 0x00, 0x0D, 0x00,
+	0x91, 0x18, 0x00, 0x00, 0x50, 0x00, 0x0D, 0x00, 0xD2, 0x07, 0x00, 0x00, 0x48, 0x00, 0x0D, 0x00,
+	0xB4, 0x0D, 0x00, 0x00, 0x4B, 0x00, 0x0D, 0x00, 0xC8, 0x0B, 0x00, 0x00, 0x4E, 0x00, 0x0D, 0x00,
+	0xDE, 0x19, 0x00, 0x00, 0x52, 0x00, 0x0D, 0x00, 0x71, 0x02, 0x00, 0x00, 0x44, 0x00, 0x0C, 0x00,
+	0xD4, 0x10, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0xE2, 0x10, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00,
+	0xEF, 0x10, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x11, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xAE, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE6, 0x19, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0xEF, 0x19, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0xF5, 0x19, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+	0xFD, 0x19, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x06, 0x1A, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+	0x0B, 0x1A, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x98, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x53, 0x75, 0x70, 0x65, 0x72, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x42, 0x72, 0x6F,
+	0x73, 0x2E, 0x00, 0x59, 0x6F, 0x73, 0x68, 0x69, 0x00, 0x44, 0x6F, 0x6E, 0x6B, 0x65, 0x79, 0x20,
+	0x4B, 0x6F, 0x6E, 0x67, 0x00, 0x54, 0x68, 0x65, 0x20, 0x4C, 0x65, 0x67, 0x65, 0x6E, 0x64, 0x20,
+	0x6F, 0x66, 0x20, 0x5A, 0x65, 0x6C, 0x64, 0x61, 0x00, 0x41, 0x6E, 0x69, 0x6D, 0x61, 0x6C, 0x20,
+	0x43, 0x72, 0x6F, 0x73, 0x73, 0x69, 0x6E, 0x67, 0x00, 0x53, 0x74, 0x61, 0x72, 0x20, 0x46, 0x6F,
+	0x78, 0x00, 0x4D, 0x65, 0x74, 0x72, 0x6F, 0x69, 0x64, 0x00, 0x46, 0x2D, 0x5A, 0x65, 0x72, 0x6F,
+	0x00, 0x50, 0x69, 0x6B, 0x6D, 0x69, 0x6E, 0x00, 0x50, 0x75, 0x6E, 0x63, 0x68, 0x2D, 0x4F, 0x75,
+	0x74, 0x21, 0x21, 0x00, 0x57, 0x69, 0x69, 0x20, 0x46, 0x69, 0x74, 0x00, 0x4B, 0x69, 0x64, 0x20,
+	0x49, 0x63, 0x61, 0x72, 0x75, 0x73, 0x00, 0x43, 0x6C, 0x61, 0x73, 0x73, 0x69, 0x63, 0x20, 0x4E,
+	0x69, 0x6E, 0x74, 0x65, 0x6E, 0x64, 0x6F, 0x00, 0x4D, 0x69, 0x69, 0x00, 0x53, 0x70, 0x6C, 0x61,
+	0x74, 0x6F, 0x6F, 0x6E, 0x00, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x53, 0x70, 0x6F, 0x72, 0x74,
+	0x73, 0x20, 0x53, 0x75, 0x70, 0x65, 0x72, 0x73, 0x74, 0x61, 0x72, 0x73, 0x00, 0x50, 0x6F, 0x6B,
+	0xC3, 0xA9, 0x6D, 0x6F, 0x6E, 0x00, 0x4B, 0x69, 0x72, 0x62, 0x79, 0x00, 0x42, 0x6F, 0x78, 0x42,
+	0x6F, 0x79, 0x21, 0x00, 0x46, 0x69, 0x72, 0x65, 0x20, 0x45, 0x6D, 0x62, 0x6C, 0x65, 0x6D, 0x00,
+	0x58, 0x65, 0x6E, 0x6F, 0x62, 0x6C, 0x61, 0x64, 0x65, 0x00, 0x45, 0x61, 0x72, 0x74, 0x68, 0x62,
+	0x6F, 0x75, 0x6E, 0x64, 0x00, 0x43, 0x68, 0x69, 0x62, 0x69, 0x2D, 0x52, 0x6F, 0x62, 0x6F, 0x21,
+	0x00, 0x53, 0x6F, 0x6E, 0x69, 0x63, 0x20, 0x74, 0x68, 0x65, 0x20, 0x48, 0x65, 0x64, 0x67, 0x65,
+	0x68, 0x6F, 0x67, 0x00, 0x42, 0x61, 0x79, 0x6F, 0x6E, 0x65, 0x74, 0x74, 0x61, 0x00, 0x50, 0x61,
+	0x63, 0x2D, 0x4D, 0x61, 0x6E, 0x00, 0x44, 0x61, 0x72, 0x6B, 0x20, 0x53, 0x6F, 0x75, 0x6C, 0x73,
+	0x00, 0x4D, 0x65, 0x67, 0x61, 0x20, 0x4D, 0x61, 0x6E, 0x00, 0x53, 0x74, 0x72, 0x65, 0x65, 0x74,
+	0x20, 0x46, 0x69, 0x67, 0x68, 0x74, 0x65, 0x72, 0x00, 0x4D, 0x6F, 0x6E, 0x73, 0x74, 0x65, 0x72,
+	0x20, 0x48, 0x75, 0x6E, 0x74, 0x65, 0x72, 0x00, 0x53, 0x68, 0x6F, 0x76, 0x65, 0x6C, 0x20, 0x4B,
+	0x6E, 0x69, 0x67, 0x68, 0x74, 0x00, 0x46, 0x69, 0x6E, 0x61, 0x6C, 0x20, 0x46, 0x61, 0x6E, 0x74,
+	0x61, 0x73, 0x79, 0x00, 0x43, 0x65, 0x72, 0x65, 0x61, 0x6C, 0x00, 0x4D, 0x65, 0x74, 0x61, 0x6C,
+	0x20, 0x47, 0x65, 0x61, 0x72, 0x00, 0x43, 0x61, 0x73, 0x74, 0x6C, 0x65, 0x76, 0x61, 0x6E, 0x69,
+	0x61, 0x00, 0x4A, 0x69, 0x6B, 0x6B, 0x79, 0x6F, 0x75, 0x20, 0x50, 0x6F, 0x77, 0x65, 0x72, 0x66,
+	0x75, 0x6C, 0x20, 0x50, 0x72, 0x6F, 0x20, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00,
+	0x44, 0x69, 0x61, 0x62, 0x6C, 0x6F, 0x00, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x00, 0x44, 0x72, 0x2E,
+	0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x00, 0x4C, 0x75, 0x69, 0x67, 0x69, 0x00, 0x50, 0x65, 0x61,
+	0x63, 0x68, 0x00, 0x59, 0x61, 0x72, 0x6E, 0x20, 0x59, 0x6F, 0x73, 0x68, 0x69, 0x00, 0x52, 0x6F,
+	0x73, 0x61, 0x6C, 0x69, 0x6E, 0x61, 0x00, 0x52, 0x6F, 0x73, 0x61, 0x6C, 0x69, 0x6E, 0x61, 0x20,
+	0x26, 0x20, 0x4C, 0x75, 0x6D, 0x61, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x00, 0x48, 0x61,
+	0x6D, 0x6D, 0x65, 0x72, 0x20, 0x53, 0x6C, 0x61, 0x6D, 0x20, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72,
+	0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x4A, 0x72, 0x2E, 0x00, 0x57, 0x61, 0x72, 0x69,
+	0x6F, 0x00, 0x54, 0x75, 0x72, 0x62, 0x6F, 0x20, 0x43, 0x68, 0x61, 0x72, 0x67, 0x65, 0x20, 0x44,
+	0x6F, 0x6E, 0x6B, 0x65, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x00, 0x44, 0x69, 0x64, 0x64, 0x79,
+	0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x00, 0x54, 0x6F, 0x61, 0x64, 0x00, 0x44, 0x61, 0x69, 0x73, 0x79,
+	0x00, 0x57, 0x61, 0x6C, 0x75, 0x69, 0x67, 0x69, 0x00, 0x47, 0x6F, 0x6F, 0x6D, 0x62, 0x61, 0x00,
+	0x42, 0x6F, 0x6F, 0x00, 0x4B, 0x6F, 0x6F, 0x70, 0x61, 0x20, 0x54, 0x72, 0x6F, 0x6F, 0x70, 0x61,
+	0x00, 0x50, 0x69, 0x72, 0x61, 0x6E, 0x68, 0x61, 0x20, 0x50, 0x6C, 0x61, 0x6E, 0x74, 0x00, 0x59,
+	0x61, 0x72, 0x6E, 0x20, 0x50, 0x6F, 0x6F, 0x63, 0x68, 0x79, 0x00, 0x4B, 0x69, 0x6E, 0x67, 0x20,
+	0x4B, 0x2E, 0x20, 0x52, 0x6F, 0x6F, 0x6C, 0x00, 0x4C, 0x69, 0x6E, 0x6B, 0x00, 0x54, 0x6F, 0x6F,
+	0x6E, 0x20, 0x4C, 0x69, 0x6E, 0x6B, 0x00, 0x5A, 0x65, 0x6C, 0x64, 0x61, 0x00, 0x53, 0x68, 0x65,
+	0x69, 0x6B, 0x00, 0x47, 0x61, 0x6E, 0x6F, 0x6E, 0x64, 0x6F, 0x72, 0x66, 0x00, 0x4D, 0x69, 0x64,
+	0x6E, 0x61, 0x20, 0x26, 0x20, 0x57, 0x6F, 0x6C, 0x66, 0x20, 0x4C, 0x69, 0x6E, 0x6B, 0x00, 0x44,
+	0x61, 0x72, 0x75, 0x6B, 0x00, 0x55, 0x72, 0x62, 0x6F, 0x73, 0x61, 0x00, 0x4D, 0x69, 0x70, 0x68,
+	0x61, 0x00, 0x52, 0x65, 0x76, 0x61, 0x6C, 0x69, 0x00, 0x47, 0x75, 0x61, 0x72, 0x64, 0x69, 0x61,
+	0x6E, 0x00, 0x42, 0x6F, 0x6B, 0x6F, 0x62, 0x6C, 0x69, 0x6E, 0x00, 0x56, 0x69, 0x6C, 0x6C, 0x61,
+	0x67, 0x65, 0x72, 0x00, 0x49, 0x73, 0x61, 0x62, 0x65, 0x6C, 0x6C, 0x65, 0x20, 0x28, 0x53, 0x75,
+	0x6D, 0x6D, 0x65, 0x72, 0x20, 0x4F, 0x75, 0x74, 0x66, 0x69, 0x74, 0x29, 0x00, 0x49, 0x73, 0x61,
+	0x62, 0x65, 0x6C, 0x6C, 0x65, 0x20, 0x28, 0x41, 0x75, 0x74, 0x75, 0x6D, 0x6E, 0x20, 0x4F, 0x75,
+	0x74, 0x66, 0x69, 0x74, 0x29, 0x00, 0x49, 0x73, 0x61, 0x62, 0x65, 0x6C, 0x6C, 0x65, 0x20, 0x28,
+	0x53, 0x65, 0x72, 0x69, 0x65, 0x73, 0x20, 0x33, 0x29, 0x00, 0x49, 0x73, 0x61, 0x62, 0x65, 0x6C,
+	0x6C, 0x65, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69, 0x65, 0x73, 0x20, 0x34, 0x29, 0x00, 0x4B, 0x2E,
+	0x4B, 0x2E, 0x20, 0x53, 0x6C, 0x69, 0x64, 0x65, 0x72, 0x00, 0x44, 0x4A, 0x20, 0x4B, 0x2E, 0x4B,
+	0x2E, 0x00, 0x54, 0x6F, 0x6D, 0x20, 0x4E, 0x6F, 0x6F, 0x6B, 0x00, 0x54, 0x6F, 0x6D, 0x20, 0x4E,
+	0x6F, 0x6F, 0x6B, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69, 0x65, 0x73, 0x20, 0x33, 0x29, 0x00, 0x54,
+	0x69, 0x6D, 0x6D, 0x79, 0x20, 0x26, 0x20, 0x54, 0x6F, 0x6D, 0x6D, 0x79, 0x00, 0x54, 0x69, 0x6D,
+	0x6D, 0x79, 0x00, 0x54, 0x69, 0x6D, 0x6D, 0x79, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69, 0x65, 0x73,
+	0x20, 0x33, 0x29, 0x00, 0x54, 0x69, 0x6D, 0x6D, 0x79, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69, 0x65,
+	0x73, 0x20, 0x34, 0x29, 0x00, 0x54, 0x6F, 0x6D, 0x6D, 0x79, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69,
+	0x65, 0x73, 0x20, 0x32, 0x29, 0x00, 0x54, 0x6F, 0x6D, 0x6D, 0x79, 0x20, 0x28, 0x53, 0x65, 0x72,
+	0x69, 0x65, 0x73, 0x20, 0x34, 0x29, 0x00, 0x53, 0x61, 0x62, 0x6C, 0x65, 0x00, 0x4D, 0x61, 0x62,
+	0x65, 0x6C, 0x00, 0x4C, 0x61, 0x62, 0x65, 0x6C, 0x6C, 0x65, 0x00, 0x52, 0x65, 0x65, 0x73, 0x65,
+	0x00, 0x43, 0x79, 0x72, 0x75, 0x73, 0x00, 0x44, 0x69, 0x67, 0x62, 0x79, 0x00, 0x44, 0x69, 0x67,
+	0x62, 0x79, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69, 0x65, 0x73, 0x20, 0x33, 0x29, 0x00, 0x52, 0x6F,
+	0x76, 0x65, 0x72, 0x00, 0x52, 0x65, 0x73, 0x65, 0x74, 0x74, 0x69, 0x00, 0x52, 0x65, 0x73, 0x65,
+	0x74, 0x74, 0x69, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69, 0x65, 0x73, 0x20, 0x34, 0x29, 0x00, 0x44,
+	0x6F, 0x6E, 0x20, 0x52, 0x65, 0x73, 0x65, 0x74, 0x74, 0x69, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69,
+	0x65, 0x73, 0x20, 0x32, 0x29, 0x00, 0x44, 0x6F, 0x6E, 0x20, 0x52, 0x65, 0x73, 0x65, 0x74, 0x74,
+	0x69, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69, 0x65, 0x73, 0x20, 0x33, 0x29, 0x00, 0x42, 0x72, 0x65,
+	0x77, 0x73, 0x74, 0x65, 0x72, 0x00, 0x48, 0x61, 0x72, 0x72, 0x69, 0x65, 0x74, 0x00, 0x42, 0x6C,
+	0x61, 0x74, 0x68, 0x65, 0x72, 0x73, 0x00, 0x43, 0x65, 0x6C, 0x65, 0x73, 0x74, 0x65, 0x00, 0x4B,
+	0x69, 0x63, 0x6B, 0x73, 0x00, 0x50, 0x6F, 0x72, 0x74, 0x65, 0x72, 0x00, 0x4B, 0x61, 0x70, 0x70,
+	0x27, 0x6E, 0x00, 0x4C, 0x65, 0x69, 0x6C, 0x61, 0x6E, 0x69, 0x00, 0x4C, 0x65, 0x6C, 0x69, 0x61,
+	0x00, 0x47, 0x72, 0x61, 0x6D, 0x73, 0x00, 0x43, 0x68, 0x69, 0x70, 0x00, 0x4E, 0x61, 0x74, 0x00,
+	0x50, 0x68, 0x69, 0x6E, 0x65, 0x61, 0x73, 0x00, 0x43, 0x6F, 0x70, 0x70, 0x65, 0x72, 0x00, 0x42,
+	0x6F, 0x6F, 0x6B, 0x65, 0x72, 0x00, 0x50, 0x65, 0x74, 0x65, 0x00, 0x50, 0x65, 0x6C, 0x6C, 0x79,
+	0x00, 0x50, 0x68, 0x79, 0x6C, 0x6C, 0x69, 0x73, 0x00, 0x47, 0x75, 0x6C, 0x6C, 0x69, 0x76, 0x65,
+	0x72, 0x00, 0x4A, 0x6F, 0x61, 0x6E, 0x00, 0x50, 0x61, 0x73, 0x63, 0x61, 0x6C, 0x00, 0x4B, 0x61,
+	0x74, 0x72, 0x69, 0x6E, 0x61, 0x00, 0x53, 0x61, 0x68, 0x61, 0x72, 0x61, 0x00, 0x57, 0x65, 0x6E,
+	0x64, 0x65, 0x6C, 0x6C, 0x00, 0x52, 0x65, 0x64, 0x64, 0x00, 0x52, 0x65, 0x64, 0x64, 0x20, 0x28,
+	0x53, 0x65, 0x72, 0x69, 0x65, 0x73, 0x20, 0x34, 0x29, 0x00, 0x47, 0x72, 0x61, 0x63, 0x69, 0x65,
+	0x00, 0x4C, 0x79, 0x6C, 0x65, 0x00, 0x50, 0x61, 0x76, 0x65, 0x00, 0x5A, 0x69, 0x70, 0x70, 0x65,
+	0x72, 0x00, 0x4A, 0x61, 0x63, 0x6B, 0x00, 0x46, 0x72, 0x61, 0x6E, 0x6B, 0x6C, 0x69, 0x6E, 0x00,
+	0x4A, 0x69, 0x6E, 0x67, 0x6C, 0x65, 0x00, 0x54, 0x6F, 0x72, 0x74, 0x69, 0x6D, 0x65, 0x72, 0x00,
+	0x44, 0x72, 0x2E, 0x20, 0x53, 0x68, 0x72, 0x75, 0x6E, 0x6B, 0x00, 0x53, 0x68, 0x72, 0x75, 0x6E,
+	0x6B, 0x00, 0x42, 0x6C, 0x61, 0x6E, 0x63, 0x61, 0x00, 0x4C, 0x65, 0x69, 0x66, 0x00, 0x4C, 0x75,
+	0x6E, 0x61, 0x00, 0x4B, 0x61, 0x74, 0x69, 0x65, 0x00, 0x4C, 0x6F, 0x74, 0x74, 0x69, 0x65, 0x00,
+	0x4C, 0x6F, 0x74, 0x74, 0x69, 0x65, 0x20, 0x28, 0x53, 0x65, 0x72, 0x69, 0x65, 0x73, 0x20, 0x34,
+	0x29, 0x00, 0x43, 0x79, 0x72, 0x61, 0x6E, 0x6F, 0x00, 0x41, 0x6E, 0x74, 0x6F, 0x6E, 0x69, 0x6F,
+	0x00, 0x50, 0x61, 0x6E, 0x67, 0x6F, 0x00, 0x41, 0x6E, 0x61, 0x62, 0x65, 0x6C, 0x6C, 0x65, 0x00,
+	0x53, 0x6E, 0x6F, 0x6F, 0x74, 0x79, 0x00, 0x41, 0x6E, 0x6E, 0x61, 0x6C, 0x69, 0x73, 0x61, 0x00,
+	0x4F, 0x6C, 0x61, 0x66, 0x00, 0x54, 0x65, 0x64, 0x64, 0x79, 0x00, 0x50, 0x69, 0x6E, 0x6B, 0x79,
+	0x00, 0x43, 0x75, 0x72, 0x74, 0x00, 0x43, 0x68, 0x6F, 0x77, 0x00, 0x4E, 0x61, 0x74, 0x65, 0x00,
+	0x47, 0x72, 0x6F, 0x75, 0x63, 0x68, 0x6F, 0x00, 0x54, 0x75, 0x74, 0x75, 0x00, 0x55, 0x72, 0x73,
+	0x61, 0x6C, 0x61, 0x00, 0x47, 0x72, 0x69, 0x7A, 0x7A, 0x6C, 0x79, 0x00, 0x50, 0x61, 0x75, 0x6C,
+	0x61, 0x00, 0x49, 0x6B, 0x65, 0x00, 0x43, 0x68, 0x61, 0x72, 0x6C, 0x69, 0x73, 0x65, 0x00, 0x42,
+	0x65, 0x61, 0x72, 0x64, 0x6F, 0x00, 0x4B, 0x6C, 0x61, 0x75, 0x73, 0x00, 0x4A, 0x61, 0x79, 0x00,
+	0x52, 0x6F, 0x62, 0x69, 0x6E, 0x00, 0x41, 0x6E, 0x63, 0x68, 0x6F, 0x76, 0x79, 0x00, 0x54, 0x77,
+	0x69, 0x67, 0x67, 0x79, 0x00, 0x4A, 0x69, 0x74, 0x74, 0x65, 0x72, 0x73, 0x00, 0x50, 0x69, 0x70,
+	0x65, 0x72, 0x00, 0x41, 0x64, 0x6D, 0x69, 0x72, 0x61, 0x6C, 0x00, 0x4D, 0x69, 0x64, 0x67, 0x65,
+	0x00, 0x4A, 0x61, 0x63, 0x6F, 0x62, 0x00, 0x4C, 0x75, 0x63, 0x68, 0x61, 0x00, 0x4A, 0x61, 0x63,
+	0x71, 0x75, 0x65, 0x73, 0x00, 0x50, 0x65, 0x63, 0x6B, 0x00, 0x53, 0x70, 0x61, 0x72, 0x72, 0x6F,
+	0x00, 0x41, 0x6E, 0x67, 0x75, 0x73, 0x00, 0x52, 0x6F, 0x64, 0x65, 0x6F, 0x00, 0x53, 0x74, 0x75,
+	0x00, 0x54, 0x2D, 0x42, 0x6F, 0x6E, 0x65, 0x00, 0x43, 0x6F, 0x61, 0x63, 0x68, 0x00, 0x56, 0x69,
+	0x63, 0x00, 0x42, 0x6F, 0x62, 0x00, 0x4D, 0x69, 0x74, 0x7A, 0x69, 0x00, 0x52, 0x6F, 0x73, 0x69,
+	0x65, 0x00, 0x4F, 0x6C, 0x69, 0x76, 0x69, 0x61, 0x00, 0x4B, 0x69, 0x6B, 0x69, 0x00, 0x54, 0x61,
+	0x6E, 0x67, 0x79, 0x00, 0x50, 0x75, 0x6E, 0x63, 0x68, 0x79, 0x00, 0x50, 0x75, 0x72, 0x72, 0x6C,
+	0x00, 0x4D, 0x6F, 0x65, 0x00, 0x4B, 0x61, 0x62, 0x75, 0x6B, 0x69, 0x00, 0x4B, 0x69, 0x64, 0x20,
+	0x43, 0x61, 0x74, 0x00, 0x4D, 0x6F, 0x6E, 0x69, 0x71, 0x75, 0x65, 0x00, 0x54, 0x61, 0x62, 0x62,
+	0x79, 0x00, 0x53, 0x74, 0x69, 0x6E, 0x6B, 0x79, 0x00, 0x4B, 0x69, 0x74, 0x74, 0x79, 0x00, 0x54,
+	0x6F, 0x6D, 0x00, 0x4D, 0x65, 0x72, 0x72, 0x79, 0x00, 0x46, 0x65, 0x6C, 0x69, 0x63, 0x69, 0x74,
+	0x79, 0x00, 0x4C, 0x6F, 0x6C, 0x6C, 0x79, 0x00, 0x41, 0x6E, 0x6B, 0x68, 0x61, 0x00, 0x52, 0x75,
+	0x64, 0x79, 0x00, 0x4B, 0x61, 0x74, 0x74, 0x00, 0x42, 0x6C, 0x75, 0x65, 0x62, 0x65, 0x61, 0x72,
+	0x00, 0x4D, 0x61, 0x70, 0x6C, 0x65, 0x00, 0x50, 0x6F, 0x6E, 0x63, 0x68, 0x6F, 0x00, 0x50, 0x75,
+	0x64, 0x67, 0x65, 0x00, 0x4B, 0x6F, 0x64, 0x79, 0x00, 0x53, 0x74, 0x69, 0x74, 0x63, 0x68, 0x65,
+	0x73, 0x00, 0x56, 0x6C, 0x61, 0x64, 0x69, 0x6D, 0x69, 0x72, 0x00, 0x4D, 0x75, 0x72, 0x70, 0x68,
+	0x79, 0x00, 0x4F, 0x6C, 0x69, 0x76, 0x65, 0x00, 0x43, 0x68, 0x65, 0x72, 0x69, 0x00, 0x4A, 0x75,
+	0x6E, 0x65, 0x00, 0x50, 0x65, 0x6B, 0x6F, 0x65, 0x00, 0x43, 0x68, 0x65, 0x73, 0x74, 0x65, 0x72,
+	0x00, 0x42, 0x61, 0x72, 0x6F, 0x6C, 0x64, 0x00, 0x54, 0x61, 0x6D, 0x6D, 0x79, 0x00, 0x4D, 0x61,
+	0x72, 0x74, 0x79, 0x20, 0x28, 0x53, 0x61, 0x6E, 0x72, 0x69, 0x6F, 0x29, 0x00, 0x47, 0x6F, 0x6F,
+	0x73, 0x65, 0x00, 0x42, 0x65, 0x6E, 0x65, 0x64, 0x69, 0x63, 0x74, 0x00, 0x45, 0x67, 0x62, 0x65,
+	0x72, 0x74, 0x00, 0x41, 0x76, 0x61, 0x00, 0x42, 0x65, 0x63, 0x6B, 0x79, 0x00, 0x50, 0x6C, 0x75,
+	0x63, 0x6B, 0x79, 0x00, 0x4B, 0x6E, 0x6F, 0x78, 0x00, 0x42, 0x72, 0x6F, 0x66, 0x66, 0x69, 0x6E,
+	0x61, 0x00, 0x4B, 0x65, 0x6E, 0x00, 0x50, 0x61, 0x74, 0x74, 0x79, 0x00, 0x54, 0x69, 0x70, 0x70,
+	0x65, 0x72, 0x00, 0x4E, 0x6F, 0x72, 0x6D, 0x61, 0x00, 0x4E, 0x61, 0x6F, 0x6D, 0x69, 0x00, 0x41,
+	0x6C, 0x66, 0x6F, 0x6E, 0x73, 0x6F, 0x00, 0x41, 0x6C, 0x6C, 0x69, 0x00, 0x42, 0x6F, 0x6F, 0x74,
+	0x73, 0x00, 0x44, 0x65, 0x6C, 0x00, 0x53, 0x6C, 0x79, 0x00, 0x47, 0x61, 0x79, 0x6C, 0x65, 0x00,
+	0x44, 0x72, 0x61, 0x67, 0x6F, 0x00, 0x46, 0x61, 0x75, 0x6E, 0x61, 0x00, 0x42, 0x61, 0x6D, 0x00,
+	0x5A, 0x65, 0x6C, 0x6C, 0x00, 0x42, 0x72, 0x75, 0x63, 0x65, 0x00, 0x44, 0x65, 0x69, 0x72, 0x64,
+	0x72, 0x65, 0x00, 0x4C, 0x6F, 0x70, 0x65, 0x7A, 0x00, 0x46, 0x75, 0x63, 0x68, 0x73, 0x69, 0x61,
+	0x00, 0x42, 0x65, 0x61, 0x75, 0x00, 0x44, 0x69, 0x61, 0x6E, 0x61, 0x00, 0x45, 0x72, 0x69, 0x6B,
+	0x00, 0x43, 0x68, 0x65, 0x6C, 0x73, 0x65, 0x61, 0x20, 0x28, 0x53, 0x61, 0x6E, 0x72, 0x69, 0x6F,
+	0x29, 0x00, 0x47, 0x6F, 0x6C, 0x64, 0x69, 0x65, 0x00, 0x42, 0x75, 0x74, 0x63, 0x68, 0x00, 0x4C,
+	0x75, 0x63, 0x6B, 0x79, 0x00, 0x42, 0x69, 0x73, 0x6B, 0x69, 0x74, 0x00, 0x42, 0x6F, 0x6E, 0x65,
+	0x73, 0x00, 0x50, 0x6F, 0x72, 0x74, 0x69, 0x61, 0x00, 0x57, 0x61, 0x6C, 0x6B, 0x65, 0x72, 0x00,
+	0x43, 0x6F, 0x6F, 0x6B, 0x69, 0x65, 0x00, 0x4D, 0x61, 0x64, 0x64, 0x69, 0x65, 0x00, 0x42, 0x65,
+	0x61, 0x00, 0x4D, 0x61, 0x63, 0x00, 0x4D, 0x61, 0x72, 0x63, 0x65, 0x6C, 0x00, 0x42, 0x65, 0x6E,
+	0x6A, 0x61, 0x6D, 0x69, 0x6E, 0x00, 0x43, 0x68, 0x65, 0x72, 0x72, 0x79, 0x00, 0x53, 0x68, 0x65,
+	0x70, 0x00, 0x42, 0x69, 0x6C, 0x6C, 0x00, 0x4A, 0x6F, 0x65, 0x79, 0x00, 0x50, 0x61, 0x74, 0x65,
+	0x00, 0x4D, 0x61, 0x65, 0x6C, 0x6C, 0x65, 0x00, 0x44, 0x65, 0x65, 0x6E, 0x61, 0x00, 0x50, 0x6F,
+	0x6D, 0x70, 0x6F, 0x6D, 0x00, 0x4D, 0x61, 0x6C, 0x6C, 0x61, 0x72, 0x79, 0x00, 0x46, 0x72, 0x65,
+	0x63, 0x6B, 0x6C, 0x65, 0x73, 0x00, 0x44, 0x65, 0x72, 0x77, 0x69, 0x6E, 0x00, 0x44, 0x72, 0x61,
+	0x6B, 0x65, 0x00, 0x53, 0x63, 0x6F, 0x6F, 0x74, 0x00, 0x57, 0x65, 0x62, 0x65, 0x72, 0x00, 0x4D,
+	0x69, 0x72, 0x61, 0x6E, 0x64, 0x61, 0x00, 0x4B, 0x65, 0x74, 0x63, 0x68, 0x75, 0x70, 0x00, 0x47,
+	0x6C, 0x6F, 0x72, 0x69, 0x61, 0x00, 0x4D, 0x6F, 0x6C, 0x6C, 0x79, 0x00, 0x51, 0x75, 0x69, 0x6C,
+	0x6C, 0x73, 0x6F, 0x6E, 0x00, 0x4F, 0x70, 0x61, 0x6C, 0x00, 0x44, 0x69, 0x7A, 0x7A, 0x79, 0x00,
+	0x42, 0x69, 0x67, 0x20, 0x54, 0x6F, 0x70, 0x00, 0x45, 0x6C, 0x6F, 0x69, 0x73, 0x65, 0x00, 0x4D,
+	0x61, 0x72, 0x67, 0x69, 0x65, 0x00, 0x50, 0x61, 0x6F, 0x6C, 0x6F, 0x00, 0x41, 0x78, 0x65, 0x6C,
+	0x00, 0x45, 0x6C, 0x6C, 0x69, 0x65, 0x00, 0x54, 0x75, 0x63, 0x6B, 0x65, 0x72, 0x00, 0x54, 0x69,
+	0x61, 0x00, 0x43, 0x68, 0x61, 0x69, 0x20, 0x28, 0x53, 0x61, 0x6E, 0x72, 0x69, 0x6F, 0x29, 0x00,
+	0x4C, 0x69, 0x6C, 0x79, 0x00, 0x52, 0x69, 0x62, 0x62, 0x6F, 0x74, 0x00, 0x46, 0x72, 0x6F, 0x62,
+	0x65, 0x72, 0x74, 0x00, 0x43, 0x61, 0x6D, 0x6F, 0x66, 0x72, 0x6F, 0x67, 0x00, 0x44, 0x72, 0x69,
+	0x66, 0x74, 0x00, 0x57, 0x61, 0x72, 0x74, 0x20, 0x4A, 0x72, 0x2E, 0x00, 0x50, 0x75, 0x64, 0x64,
+	0x6C, 0x65, 0x73, 0x00, 0x4A, 0x65, 0x72, 0x65, 0x6D, 0x69, 0x61, 0x68, 0x00, 0x54, 0x61, 0x64,
+	0x00, 0x43, 0x6F, 0x75, 0x73, 0x74, 0x65, 0x61, 0x75, 0x00, 0x48, 0x75, 0x63, 0x6B, 0x00, 0x50,
+	0x72, 0x69, 0x6E, 0x63, 0x65, 0x00, 0x4A, 0x61, 0x6D, 0x62, 0x65, 0x74, 0x74, 0x65, 0x00, 0x52,
+	0x61, 0x64, 0x64, 0x6C, 0x65, 0x00, 0x47, 0x69, 0x67, 0x69, 0x00, 0x43, 0x72, 0x6F, 0x71, 0x75,
+	0x65, 0x00, 0x44, 0x69, 0x76, 0x61, 0x00, 0x48, 0x65, 0x6E, 0x72, 0x79, 0x00, 0x43, 0x68, 0x65,
+	0x76, 0x72, 0x65, 0x00, 0x4E, 0x61, 0x6E, 0x00, 0x42, 0x69, 0x6C, 0x6C, 0x79, 0x00, 0x47, 0x72,
+	0x75, 0x66, 0x66, 0x00, 0x56, 0x65, 0x6C, 0x6D, 0x61, 0x00, 0x4B, 0x69, 0x64, 0x64, 0x00, 0x50,
+	0x61, 0x73, 0x68, 0x6D, 0x69, 0x6E, 0x61, 0x00, 0x43, 0x65, 0x73, 0x61, 0x72, 0x00, 0x50, 0x65,
+	0x65, 0x77, 0x65, 0x65, 0x00, 0x42, 0x6F, 0x6F, 0x6E, 0x65, 0x00, 0x4C, 0x6F, 0x75, 0x69, 0x65,
+	0x00, 0x42, 0x6F, 0x79, 0x64, 0x00, 0x56, 0x69, 0x6F, 0x6C, 0x65, 0x74, 0x00, 0x41, 0x6C, 0x00,
+	0x52, 0x6F, 0x63, 0x6B, 0x65, 0x74, 0x00, 0x48, 0x61, 0x6E, 0x73, 0x00, 0x52, 0x69, 0x6C, 0x6C,
+	0x61, 0x20, 0x28, 0x53, 0x61, 0x6E, 0x72, 0x69, 0x6F, 0x29, 0x00, 0x48, 0x61, 0x6D, 0x6C, 0x65,
+	0x74, 0x00, 0x41, 0x70, 0x70, 0x6C, 0x65, 0x00, 0x47, 0x72, 0x61, 0x68, 0x61, 0x6D, 0x00, 0x52,
+	0x6F, 0x64, 0x6E, 0x65, 0x79, 0x00, 0x53, 0x6F, 0x6C, 0x65, 0x69, 0x6C, 0x00, 0x43, 0x6C, 0x61,
+	0x79, 0x00, 0x46, 0x6C, 0x75, 0x72, 0x72, 0x79, 0x00, 0x48, 0x61, 0x6D, 0x70, 0x68, 0x72, 0x65,
+	0x79, 0x00, 0x52, 0x6F, 0x63, 0x63, 0x6F, 0x00, 0x42, 0x75, 0x62, 0x62, 0x6C, 0x65, 0x73, 0x00,
+	0x42, 0x65, 0x72, 0x74, 0x68, 0x61, 0x00, 0x42, 0x69, 0x66, 0x66, 0x00, 0x42, 0x69, 0x74, 0x74,
+	0x79, 0x00, 0x48, 0x61, 0x72, 0x72, 0x79, 0x00, 0x48, 0x69, 0x70, 0x70, 0x65, 0x75, 0x78, 0x00,
+	0x42, 0x75, 0x63, 0x6B, 0x00, 0x56, 0x69, 0x63, 0x74, 0x6F, 0x72, 0x69, 0x61, 0x00, 0x53, 0x61,
+	0x76, 0x61, 0x6E, 0x6E, 0x61, 0x68, 0x00, 0x45, 0x6C, 0x6D, 0x65, 0x72, 0x00, 0x52, 0x6F, 0x73,
+	0x63, 0x6F, 0x00, 0x57, 0x69, 0x6E, 0x6E, 0x69, 0x65, 0x00, 0x45, 0x64, 0x00, 0x43, 0x6C, 0x65,
+	0x6F, 0x00, 0x50, 0x65, 0x61, 0x63, 0x68, 0x65, 0x73, 0x00, 0x41, 0x6E, 0x6E, 0x61, 0x6C, 0x69,
+	0x73, 0x65, 0x00, 0x43, 0x6C, 0x79, 0x64, 0x65, 0x00, 0x43, 0x6F, 0x6C, 0x74, 0x6F, 0x6E, 0x00,
+	0x50, 0x61, 0x70, 0x69, 0x00, 0x4A, 0x75, 0x6C, 0x69, 0x61, 0x6E, 0x00, 0x59, 0x75, 0x6B, 0x61,
+	0x00, 0x41, 0x6C, 0x69, 0x63, 0x65, 0x00, 0x4D, 0x65, 0x6C, 0x62, 0x61, 0x00, 0x53, 0x79, 0x64,
+	0x6E, 0x65, 0x79, 0x00, 0x47, 0x6F, 0x6E, 0x7A, 0x6F, 0x00, 0x4F, 0x7A, 0x7A, 0x69, 0x65, 0x00,
+	0x43, 0x61, 0x6E, 0x62, 0x65, 0x72, 0x72, 0x61, 0x00, 0x4C, 0x79, 0x6D, 0x61, 0x6E, 0x00, 0x45,
+	0x75, 0x67, 0x65, 0x6E, 0x65, 0x00, 0x4B, 0x69, 0x74, 0x74, 0x00, 0x4D, 0x61, 0x74, 0x68, 0x69,
+	0x6C, 0x64, 0x61, 0x00, 0x43, 0x61, 0x72, 0x72, 0x69, 0x65, 0x00, 0x41, 0x73, 0x74, 0x72, 0x69,
+	0x64, 0x00, 0x53, 0x79, 0x6C, 0x76, 0x69, 0x61, 0x00, 0x57, 0x61, 0x6C, 0x74, 0x00, 0x52, 0x6F,
+	0x6F, 0x6E, 0x65, 0x79, 0x00, 0x4D, 0x61, 0x72, 0x63, 0x69, 0x65, 0x00, 0x42, 0x75, 0x64, 0x00,
+	0x45, 0x6C, 0x76, 0x69, 0x73, 0x00, 0x52, 0x65, 0x78, 0x00, 0x4C, 0x65, 0x6F, 0x70, 0x6F, 0x6C,
+	0x64, 0x00, 0x4D, 0x6F, 0x74, 0x74, 0x00, 0x52, 0x6F, 0x72, 0x79, 0x00, 0x4C, 0x69, 0x6F, 0x6E,
+	0x65, 0x6C, 0x00, 0x4E, 0x61, 0x6E, 0x61, 0x00, 0x53, 0x69, 0x6D, 0x6F, 0x6E, 0x00, 0x54, 0x61,
+	0x6D, 0x6D, 0x69, 0x00, 0x4D, 0x6F, 0x6E, 0x74, 0x79, 0x00, 0x45, 0x6C, 0x69, 0x73, 0x65, 0x00,
+	0x46, 0x6C, 0x69, 0x70, 0x00, 0x53, 0x68, 0x61, 0x72, 0x69, 0x00, 0x44, 0x65, 0x6C, 0x69, 0x00,
+	0x44, 0x6F, 0x72, 0x61, 0x00, 0x4C, 0x69, 0x6D, 0x62, 0x65, 0x72, 0x67, 0x00, 0x42, 0x65, 0x6C,
+	0x6C, 0x61, 0x00, 0x42, 0x72, 0x65, 0x65, 0x00, 0x53, 0x61, 0x6D, 0x73, 0x6F, 0x6E, 0x00, 0x52,
+	0x6F, 0x64, 0x00, 0x43, 0x61, 0x6E, 0x64, 0x69, 0x00, 0x52, 0x69, 0x7A, 0x7A, 0x6F, 0x00, 0x41,
+	0x6E, 0x69, 0x63, 0x6F, 0x74, 0x74, 0x69, 0x00, 0x42, 0x72, 0x6F, 0x63, 0x63, 0x6F, 0x6C, 0x6F,
+	0x00, 0x4D, 0x6F, 0x6F, 0x73, 0x65, 0x00, 0x42, 0x65, 0x74, 0x74, 0x69, 0x6E, 0x61, 0x00, 0x47,
+	0x72, 0x65, 0x74, 0x61, 0x00, 0x50, 0x65, 0x6E, 0x65, 0x6C, 0x6F, 0x70, 0x65, 0x00, 0x43, 0x68,
+	0x61, 0x64, 0x64, 0x65, 0x72, 0x00, 0x4F, 0x63, 0x74, 0x61, 0x76, 0x69, 0x61, 0x6E, 0x00, 0x4D,
+	0x61, 0x72, 0x69, 0x6E, 0x61, 0x00, 0x5A, 0x75, 0x63, 0x6B, 0x65, 0x72, 0x00, 0x51, 0x75, 0x65,
+	0x65, 0x6E, 0x69, 0x65, 0x00, 0x47, 0x6C, 0x61, 0x64, 0x79, 0x73, 0x00, 0x53, 0x61, 0x6E, 0x64,
+	0x79, 0x00, 0x53, 0x70, 0x72, 0x6F, 0x63, 0x6B, 0x65, 0x74, 0x00, 0x4A, 0x75, 0x6C, 0x69, 0x61,
+	0x00, 0x43, 0x72, 0x61, 0x6E, 0x73, 0x74, 0x6F, 0x6E, 0x00, 0x50, 0x68, 0x69, 0x6C, 0x00, 0x42,
+	0x6C, 0x61, 0x6E, 0x63, 0x68, 0x65, 0x00, 0x46, 0x6C, 0x6F, 0x72, 0x61, 0x00, 0x50, 0x68, 0x6F,
+	0x65, 0x62, 0x65, 0x00, 0x41, 0x70, 0x6F, 0x6C, 0x6C, 0x6F, 0x00, 0x41, 0x6D, 0x65, 0x6C, 0x69,
+	0x61, 0x00, 0x50, 0x69, 0x65, 0x72, 0x63, 0x65, 0x00, 0x42, 0x75, 0x7A, 0x7A, 0x00, 0x41, 0x76,
+	0x65, 0x72, 0x79, 0x00, 0x46, 0x72, 0x61, 0x6E, 0x6B, 0x00, 0x53, 0x74, 0x65, 0x72, 0x6C, 0x69,
+	0x6E, 0x67, 0x00, 0x4B, 0x65, 0x61, 0x74, 0x6F, 0x6E, 0x00, 0x43, 0x65, 0x6C, 0x69, 0x61, 0x00,
+	0x41, 0x75, 0x72, 0x6F, 0x72, 0x61, 0x00, 0x52, 0x6F, 0x61, 0x6C, 0x64, 0x00, 0x43, 0x75, 0x62,
+	0x65, 0x00, 0x48, 0x6F, 0x70, 0x70, 0x65, 0x72, 0x00, 0x46, 0x72, 0x69, 0x67, 0x61, 0x00, 0x47,
+	0x77, 0x65, 0x6E, 0x00, 0x50, 0x75, 0x63, 0x6B, 0x00, 0x57, 0x61, 0x64, 0x65, 0x00, 0x42, 0x6F,
+	0x6F, 0x6D, 0x65, 0x72, 0x00, 0x49, 0x67, 0x67, 0x6C, 0x79, 0x00, 0x54, 0x65, 0x78, 0x00, 0x46,
+	0x6C, 0x6F, 0x00, 0x53, 0x70, 0x72, 0x69, 0x6E, 0x6B, 0x6C, 0x65, 0x00, 0x43, 0x75, 0x72, 0x6C,
+	0x79, 0x00, 0x54, 0x72, 0x75, 0x66, 0x66, 0x6C, 0x65, 0x73, 0x00, 0x52, 0x61, 0x73, 0x68, 0x65,
+	0x72, 0x00, 0x48, 0x75, 0x67, 0x68, 0x00, 0x4C, 0x75, 0x63, 0x79, 0x00, 0x53, 0x70, 0x6F, 0x72,
+	0x6B, 0x2F, 0x43, 0x72, 0x61, 0x63, 0x6B, 0x6C, 0x65, 0x00, 0x43, 0x6F, 0x62, 0x62, 0x00, 0x42,
+	0x6F, 0x72, 0x69, 0x73, 0x00, 0x4D, 0x61, 0x67, 0x67, 0x69, 0x65, 0x00, 0x50, 0x65, 0x67, 0x67,
+	0x79, 0x00, 0x47, 0x61, 0x6C, 0x61, 0x00, 0x43, 0x68, 0x6F, 0x70, 0x73, 0x00, 0x4B, 0x65, 0x76,
+	0x69, 0x6E, 0x00, 0x50, 0x61, 0x6E, 0x63, 0x65, 0x74, 0x74, 0x69, 0x00, 0x41, 0x67, 0x6E, 0x65,
+	0x73, 0x00, 0x42, 0x75, 0x6E, 0x6E, 0x69, 0x65, 0x00, 0x44, 0x6F, 0x74, 0x74, 0x79, 0x00, 0x43,
+	0x6F, 0x63, 0x6F, 0x00, 0x53, 0x6E, 0x61, 0x6B, 0x65, 0x00, 0x47, 0x61, 0x73, 0x74, 0x6F, 0x6E,
+	0x00, 0x47, 0x61, 0x62, 0x69, 0x00, 0x50, 0x69, 0x70, 0x70, 0x79, 0x00, 0x54, 0x69, 0x66, 0x66,
+	0x61, 0x6E, 0x79, 0x00, 0x47, 0x65, 0x6E, 0x6A, 0x69, 0x00, 0x52, 0x75, 0x62, 0x79, 0x00, 0x44,
+	0x6F, 0x63, 0x00, 0x43, 0x6C, 0x61, 0x75, 0x64, 0x65, 0x00, 0x46, 0x72, 0x61, 0x6E, 0x63, 0x69,
+	0x6E, 0x65, 0x00, 0x43, 0x68, 0x72, 0x69, 0x73, 0x73, 0x79, 0x00, 0x48, 0x6F, 0x70, 0x6B, 0x69,
+	0x6E, 0x73, 0x00, 0x4F, 0x48, 0x61, 0x72, 0x65, 0x00, 0x43, 0x61, 0x72, 0x6D, 0x65, 0x6E, 0x00,
+	0x42, 0x6F, 0x6E, 0x62, 0x6F, 0x6E, 0x00, 0x43, 0x6F, 0x6C, 0x65, 0x00, 0x4D, 0x69, 0x72, 0x61,
+	0x00, 0x54, 0x6F, 0x62, 0x79, 0x20, 0x28, 0x53, 0x61, 0x6E, 0x72, 0x69, 0x6F, 0x29, 0x00, 0x54,
+	0x61, 0x6E, 0x6B, 0x00, 0x52, 0x68, 0x6F, 0x6E, 0x64, 0x61, 0x00, 0x53, 0x70, 0x69, 0x6B, 0x65,
+	0x00, 0x48, 0x6F, 0x72, 0x6E, 0x73, 0x62, 0x79, 0x00, 0x4D, 0x65, 0x72, 0x65, 0x6E, 0x67, 0x75,
+	0x65, 0x00, 0x52, 0x65, 0x6E, 0xC3, 0xA9, 0x65, 0x00, 0x56, 0x65, 0x73, 0x74, 0x61, 0x00, 0x42,
+	0x61, 0x61, 0x62, 0x61, 0x72, 0x61, 0x00, 0x45, 0x75, 0x6E, 0x69, 0x63, 0x65, 0x00, 0x53, 0x74,
+	0x65, 0x6C, 0x6C, 0x61, 0x00, 0x43, 0x61, 0x73, 0x68, 0x6D, 0x65, 0x72, 0x65, 0x00, 0x57, 0x69,
+	0x6C, 0x6C, 0x6F, 0x77, 0x00, 0x43, 0x75, 0x72, 0x6C, 0x6F, 0x73, 0x00, 0x57, 0x65, 0x6E, 0x64,
+	0x79, 0x00, 0x54, 0x69, 0x6D, 0x62, 0x72, 0x61, 0x00, 0x46, 0x72, 0x69, 0x74, 0x61, 0x00, 0x4D,
+	0x75, 0x66, 0x66, 0x79, 0x00, 0x50, 0x69, 0x65, 0x74, 0x72, 0x6F, 0x00, 0xC3, 0x89, 0x74, 0x6F,
+	0x69, 0x6C, 0x65, 0x20, 0x28, 0x53, 0x61, 0x6E, 0x72, 0x69, 0x6F, 0x29, 0x00, 0x50, 0x65, 0x61,
+	0x6E, 0x75, 0x74, 0x00, 0x42, 0x6C, 0x61, 0x69, 0x72, 0x65, 0x00, 0x46, 0x69, 0x6C, 0x62, 0x65,
+	0x72, 0x74, 0x00, 0x50, 0x65, 0x63, 0x61, 0x6E, 0x00, 0x4E, 0x69, 0x62, 0x62, 0x6C, 0x65, 0x73,
+	0x00, 0x41, 0x67, 0x65, 0x6E, 0x74, 0x20, 0x53, 0x00, 0x43, 0x61, 0x72, 0x6F, 0x6C, 0x69, 0x6E,
+	0x65, 0x00, 0x53, 0x61, 0x6C, 0x6C, 0x79, 0x00, 0x53, 0x74, 0x61, 0x74, 0x69, 0x63, 0x00, 0x4D,
+	0x69, 0x6E, 0x74, 0x00, 0x52, 0x69, 0x63, 0x6B, 0x79, 0x00, 0x43, 0x61, 0x6C, 0x6C, 0x79, 0x00,
+	0x54, 0x61, 0x73, 0x68, 0x61, 0x00, 0x53, 0x79, 0x6C, 0x76, 0x61, 0x6E, 0x61, 0x00, 0x50, 0x6F,
+	0x70, 0x70, 0x79, 0x00, 0x53, 0x68, 0x65, 0x6C, 0x64, 0x6F, 0x6E, 0x00, 0x4D, 0x61, 0x72, 0x73,
+	0x68, 0x61, 0x6C, 0x00, 0x48, 0x61, 0x7A, 0x65, 0x6C, 0x00, 0x52, 0x6F, 0x6C, 0x66, 0x00, 0x52,
+	0x6F, 0x77, 0x61, 0x6E, 0x00, 0x54, 0x79, 0x62, 0x61, 0x6C, 0x74, 0x00, 0x42, 0x61, 0x6E, 0x67,
+	0x6C, 0x65, 0x00, 0x4C, 0x65, 0x6F, 0x6E, 0x61, 0x72, 0x64, 0x6F, 0x00, 0x43, 0x6C, 0x61, 0x75,
+	0x64, 0x69, 0x61, 0x00, 0x42, 0x69, 0x61, 0x6E, 0x63, 0x61, 0x00, 0x43, 0x68, 0x69, 0x65, 0x66,
+	0x00, 0x4C, 0x6F, 0x62, 0x6F, 0x00, 0x57, 0x6F, 0x6C, 0x66, 0x67, 0x61, 0x6E, 0x67, 0x00, 0x57,
+	0x68, 0x69, 0x74, 0x6E, 0x65, 0x79, 0x00, 0x44, 0x6F, 0x62, 0x69, 0x65, 0x00, 0x46, 0x72, 0x65,
+	0x79, 0x61, 0x00, 0x46, 0x61, 0x6E, 0x67, 0x00, 0x56, 0x69, 0x76, 0x69, 0x61, 0x6E, 0x00, 0x53,
+	0x6B, 0x79, 0x65, 0x00, 0x4B, 0x79, 0x6C, 0x65, 0x00, 0x46, 0x6F, 0x78, 0x00, 0x46, 0x61, 0x6C,
+	0x63, 0x6F, 0x00, 0x57, 0x6F, 0x6C, 0x66, 0x00, 0x53, 0x61, 0x6D, 0x75, 0x73, 0x00, 0x5A, 0x65,
+	0x72, 0x6F, 0x20, 0x53, 0x75, 0x69, 0x74, 0x20, 0x53, 0x61, 0x6D, 0x75, 0x73, 0x00, 0x53, 0x61,
+	0x6D, 0x75, 0x73, 0x20, 0x41, 0x72, 0x61, 0x6E, 0x00, 0x52, 0x69, 0x64, 0x6C, 0x65, 0x79, 0x00,
+	0x44, 0x61, 0x72, 0x6B, 0x20, 0x53, 0x61, 0x6D, 0x75, 0x73, 0x00, 0x43, 0x61, 0x70, 0x74, 0x61,
+	0x69, 0x6E, 0x20, 0x46, 0x61, 0x6C, 0x63, 0x6F, 0x6E, 0x00, 0x4F, 0x6C, 0x69, 0x6D, 0x61, 0x72,
+	0x00, 0x4C, 0x69, 0x74, 0x74, 0x6C, 0x65, 0x20, 0x4D, 0x61, 0x63, 0x00, 0x57, 0x69, 0x69, 0x20,
+	0x46, 0x69, 0x74, 0x20, 0x54, 0x72, 0x61, 0x69, 0x6E, 0x65, 0x72, 0x00, 0x50, 0x69, 0x74, 0x00,
+	0x44, 0x61, 0x72, 0x6B, 0x20, 0x50, 0x69, 0x74, 0x00, 0x50, 0x61, 0x6C, 0x75, 0x74, 0x65, 0x6E,
+	0x61, 0x00, 0x4D, 0x72, 0x2E, 0x20, 0x47, 0x61, 0x6D, 0x65, 0x20, 0x26, 0x20, 0x57, 0x61, 0x74,
+	0x63, 0x68, 0x00, 0x52, 0x2E, 0x4F, 0x2E, 0x42, 0x2E, 0x00, 0x44, 0x75, 0x63, 0x6B, 0x20, 0x48,
+	0x75, 0x6E, 0x74, 0x00, 0x49, 0x63, 0x65, 0x20, 0x43, 0x6C, 0x69, 0x6D, 0x62, 0x65, 0x72, 0x73,
+	0x00, 0x4D, 0x69, 0x69, 0x20, 0x42, 0x72, 0x61, 0x77, 0x6C, 0x65, 0x72, 0x00, 0x4D, 0x69, 0x69,
+	0x20, 0x53, 0x77, 0x6F, 0x72, 0x64, 0x66, 0x69, 0x67, 0x68, 0x74, 0x65, 0x72, 0x00, 0x4D, 0x69,
+	0x69, 0x20, 0x47, 0x75, 0x6E, 0x6E, 0x65, 0x72, 0x00, 0x49, 0x6E, 0x6B, 0x6C, 0x69, 0x6E, 0x67,
+	0x00, 0x49, 0x6E, 0x6B, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x47, 0x69, 0x72, 0x6C, 0x00, 0x49, 0x6E,
+	0x6B, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x42, 0x6F, 0x79, 0x00, 0x49, 0x6E, 0x6B, 0x6C, 0x69, 0x6E,
+	0x67, 0x20, 0x53, 0x71, 0x75, 0x69, 0x64, 0x00, 0x43, 0x61, 0x6C, 0x6C, 0x69, 0x65, 0x00, 0x4D,
+	0x61, 0x72, 0x69, 0x65, 0x00, 0x50, 0x65, 0x61, 0x72, 0x6C, 0x00, 0x4F, 0x63, 0x74, 0x6F, 0x6C,
+	0x69, 0x6E, 0x67, 0x00, 0x4F, 0x63, 0x74, 0x6F, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x47, 0x69, 0x72,
+	0x6C, 0x00, 0x4F, 0x63, 0x74, 0x6F, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x42, 0x6F, 0x79, 0x00, 0x4F,
+	0x63, 0x74, 0x6F, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x4F, 0x63, 0x74, 0x6F, 0x70, 0x75, 0x73, 0x00,
+	0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x4D,
+	0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x4D,
+	0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x4D, 0x61,
+	0x72, 0x69, 0x6F, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x4D, 0x61, 0x72, 0x69, 0x6F,
+	0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x4C,
+	0x75, 0x69, 0x67, 0x69, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x4C, 0x75,
+	0x69, 0x67, 0x69, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x4C, 0x75,
+	0x69, 0x67, 0x69, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x4C, 0x75, 0x69,
+	0x67, 0x69, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x4C, 0x75, 0x69, 0x67, 0x69, 0x20,
+	0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x50, 0x65,
+	0x61, 0x63, 0x68, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x50, 0x65, 0x61,
+	0x63, 0x68, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x50, 0x65, 0x61,
+	0x63, 0x68, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x50, 0x65, 0x61, 0x63,
+	0x68, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x28,
+	0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x44, 0x61, 0x69,
+	0x73, 0x79, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x44, 0x61, 0x69, 0x73,
+	0x79, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x44, 0x61, 0x69, 0x73,
+	0x79, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x44, 0x61, 0x69, 0x73, 0x79,
+	0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x44, 0x61, 0x69, 0x73, 0x79, 0x20, 0x28, 0x48,
+	0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x59, 0x6F, 0x73, 0x68,
+	0x69, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x59, 0x6F, 0x73, 0x68, 0x69,
+	0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x59, 0x6F, 0x73, 0x68, 0x69,
+	0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x59, 0x6F, 0x73, 0x68, 0x69, 0x20,
+	0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x59, 0x6F, 0x73, 0x68, 0x69, 0x20, 0x28, 0x48, 0x6F,
+	0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x57, 0x61, 0x72, 0x69, 0x6F,
+	0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x57, 0x61, 0x72, 0x69, 0x6F, 0x20,
+	0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x57, 0x61, 0x72, 0x69, 0x6F, 0x20,
+	0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x57, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28,
+	0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x57, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x48, 0x6F, 0x72,
+	0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x57, 0x61, 0x6C, 0x75, 0x69, 0x67,
+	0x69, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x57, 0x61, 0x6C, 0x75, 0x69,
+	0x67, 0x69, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x57, 0x61, 0x6C,
+	0x75, 0x69, 0x67, 0x69, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x57, 0x61,
+	0x6C, 0x75, 0x69, 0x67, 0x69, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x57, 0x61, 0x6C,
+	0x75, 0x69, 0x67, 0x69, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69,
+	0x6E, 0x67, 0x00, 0x44, 0x6F, 0x6E, 0x6B, 0x65, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28,
+	0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x44, 0x6F, 0x6E, 0x6B, 0x65, 0x79, 0x20, 0x4B,
+	0x6F, 0x6E, 0x67, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x44, 0x6F,
+	0x6E, 0x6B, 0x65, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69,
+	0x73, 0x29, 0x00, 0x44, 0x6F, 0x6E, 0x6B, 0x65, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28,
+	0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x44, 0x6F, 0x6E, 0x6B, 0x65, 0x79, 0x20, 0x4B, 0x6F, 0x6E,
+	0x67, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00,
+	0x44, 0x69, 0x64, 0x64, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63,
+	0x65, 0x72, 0x29, 0x00, 0x44, 0x69, 0x64, 0x64, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28,
+	0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x44, 0x69, 0x64, 0x64, 0x79, 0x20, 0x4B,
+	0x6F, 0x6E, 0x67, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x44, 0x69, 0x64,
+	0x64, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x44,
+	0x69, 0x64, 0x64, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65,
+	0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x28,
+	0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x28,
+	0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20,
+	0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20,
+	0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x28, 0x48,
+	0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x42, 0x6F, 0x77, 0x73,
+	0x65, 0x72, 0x20, 0x4A, 0x72, 0x2E, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00,
+	0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x4A, 0x72, 0x2E, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65,
+	0x62, 0x61, 0x6C, 0x6C, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x4A, 0x72, 0x2E, 0x20,
+	0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20,
+	0x4A, 0x72, 0x2E, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65,
+	0x72, 0x20, 0x4A, 0x72, 0x2E, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63,
+	0x69, 0x6E, 0x67, 0x00, 0x42, 0x6F, 0x6F, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29,
+	0x00, 0x42, 0x6F, 0x6F, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x42,
+	0x6F, 0x6F, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x42, 0x6F, 0x6F, 0x20,
+	0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x42, 0x6F, 0x6F, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73,
+	0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4D, 0x61,
+	0x72, 0x69, 0x6F, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28,
+	0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4D, 0x61, 0x72,
+	0x69, 0x6F, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x42, 0x61, 0x62,
+	0x79, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29,
+	0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x47, 0x6F, 0x6C,
+	0x66, 0x29, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x48,
+	0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x42, 0x61, 0x62, 0x79,
+	0x20, 0x4C, 0x75, 0x69, 0x67, 0x69, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4C, 0x75, 0x69, 0x67,
+	0x69, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20,
+	0x4C, 0x75, 0x69, 0x67, 0x69, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00,
+	0x42, 0x61, 0x62, 0x79, 0x20, 0x4C, 0x75, 0x69, 0x67, 0x69, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E,
+	0x69, 0x73, 0x29, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4C, 0x75, 0x69, 0x67, 0x69, 0x20, 0x28,
+	0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4C, 0x75, 0x69, 0x67, 0x69,
+	0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x42,
+	0x69, 0x72, 0x64, 0x6F, 0x00, 0x42, 0x69, 0x72, 0x64, 0x6F, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63,
+	0x65, 0x72, 0x29, 0x00, 0x42, 0x69, 0x72, 0x64, 0x6F, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62,
+	0x61, 0x6C, 0x6C, 0x00, 0x42, 0x69, 0x72, 0x64, 0x6F, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69,
+	0x73, 0x29, 0x00, 0x42, 0x69, 0x72, 0x64, 0x6F, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00,
+	0x42, 0x69, 0x72, 0x64, 0x6F, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63,
+	0x69, 0x6E, 0x67, 0x00, 0x52, 0x6F, 0x73, 0x61, 0x6C, 0x69, 0x6E, 0x61, 0x20, 0x28, 0x53, 0x6F,
+	0x63, 0x63, 0x65, 0x72, 0x29, 0x00, 0x52, 0x6F, 0x73, 0x61, 0x6C, 0x69, 0x6E, 0x61, 0x20, 0x28,
+	0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x52, 0x6F, 0x73, 0x61, 0x6C, 0x69, 0x6E,
+	0x61, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x52, 0x6F, 0x73, 0x61, 0x6C,
+	0x69, 0x6E, 0x61, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x52, 0x6F, 0x73, 0x61, 0x6C,
+	0x69, 0x6E, 0x61, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E,
+	0x67, 0x00, 0x4D, 0x65, 0x74, 0x61, 0x6C, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x00, 0x4D, 0x65,
+	0x74, 0x61, 0x6C, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63, 0x65,
+	0x72, 0x29, 0x00, 0x4D, 0x65, 0x74, 0x61, 0x6C, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28,
+	0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x4D, 0x65, 0x74, 0x61, 0x6C, 0x20, 0x4D,
+	0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x54, 0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x4D, 0x65,
+	0x74, 0x61, 0x6C, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29,
+	0x00, 0x4D, 0x65, 0x74, 0x61, 0x6C, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x48, 0x6F,
+	0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x50, 0x69, 0x6E, 0x6B, 0x20,
+	0x47, 0x6F, 0x6C, 0x64, 0x20, 0x50, 0x65, 0x61, 0x63, 0x68, 0x00, 0x50, 0x69, 0x6E, 0x6B, 0x20,
+	0x47, 0x6F, 0x6C, 0x64, 0x20, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x28, 0x53, 0x6F, 0x63, 0x63,
+	0x65, 0x72, 0x29, 0x00, 0x50, 0x69, 0x6E, 0x6B, 0x20, 0x47, 0x6F, 0x6C, 0x64, 0x20, 0x50, 0x65,
+	0x61, 0x63, 0x68, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x00, 0x50, 0x69,
+	0x6E, 0x6B, 0x20, 0x47, 0x6F, 0x6C, 0x64, 0x20, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x28, 0x54,
+	0x65, 0x6E, 0x6E, 0x69, 0x73, 0x29, 0x00, 0x50, 0x69, 0x6E, 0x6B, 0x20, 0x47, 0x6F, 0x6C, 0x64,
+	0x20, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x66, 0x29, 0x00, 0x50, 0x69,
+	0x6E, 0x6B, 0x20, 0x47, 0x6F, 0x6C, 0x64, 0x20, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x28, 0x48,
+	0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x00, 0x49, 0x76, 0x79, 0x73,
+	0x61, 0x75, 0x72, 0x00, 0x43, 0x68, 0x61, 0x72, 0x69, 0x7A, 0x61, 0x72, 0x64, 0x00, 0x53, 0x71,
+	0x75, 0x69, 0x72, 0x74, 0x6C, 0x65, 0x00, 0x50, 0x69, 0x6B, 0x61, 0x63, 0x68, 0x75, 0x00, 0x4A,
+	0x69, 0x67, 0x67, 0x6C, 0x79, 0x70, 0x75, 0x66, 0x66, 0x00, 0x4D, 0x65, 0x77, 0x74, 0x77, 0x6F,
+	0x00, 0x50, 0x69, 0x63, 0x68, 0x75, 0x00, 0x4C, 0x75, 0x63, 0x61, 0x72, 0x69, 0x6F, 0x00, 0x47,
+	0x72, 0x65, 0x6E, 0x69, 0x6E, 0x6A, 0x61, 0x00, 0x49, 0x6E, 0x63, 0x69, 0x6E, 0x65, 0x72, 0x6F,
+	0x61, 0x72, 0x00, 0x53, 0x68, 0x61, 0x64, 0x6F, 0x77, 0x20, 0x4D, 0x65, 0x77, 0x74, 0x77, 0x6F,
+	0x00, 0x44, 0x65, 0x74, 0x65, 0x63, 0x74, 0x69, 0x76, 0x65, 0x20, 0x50, 0x69, 0x6B, 0x61, 0x63,
+	0x68, 0x75, 0x00, 0x50, 0x6F, 0x6B, 0xC3, 0xA9, 0x6D, 0x6F, 0x6E, 0x20, 0x54, 0x72, 0x61, 0x69,
+	0x6E, 0x65, 0x72, 0x00, 0x4D, 0x65, 0x74, 0x61, 0x20, 0x4B, 0x6E, 0x69, 0x67, 0x68, 0x74, 0x00,
+	0x4B, 0x69, 0x6E, 0x67, 0x20, 0x44, 0x65, 0x64, 0x65, 0x64, 0x65, 0x00, 0x57, 0x61, 0x64, 0x64,
+	0x6C, 0x65, 0x20, 0x44, 0x65, 0x65, 0x00, 0x51, 0x62, 0x62, 0x79, 0x00, 0x4D, 0x61, 0x72, 0x74,
+	0x68, 0x00, 0x4C, 0x75, 0x63, 0x69, 0x6E, 0x61, 0x00, 0x52, 0x6F, 0x79, 0x00, 0x43, 0x6F, 0x72,
+	0x72, 0x69, 0x6E, 0x00, 0x43, 0x6F, 0x72, 0x72, 0x69, 0x6E, 0x20, 0x28, 0x50, 0x6C, 0x61, 0x79,
+	0x65, 0x72, 0x20, 0x32, 0x29, 0x00, 0x41, 0x6C, 0x6D, 0x00, 0x43, 0x65, 0x6C, 0x69, 0x63, 0x61,
+	0x00, 0x43, 0x68, 0x72, 0x6F, 0x6D, 0x00, 0x54, 0x69, 0x6B, 0x69, 0x00, 0x53, 0x68, 0x75, 0x6C,
+	0x6B, 0x00, 0x4E, 0x65, 0x73, 0x73, 0x00, 0x4C, 0x75, 0x63, 0x61, 0x73, 0x00, 0x43, 0x68, 0x69,
+	0x62, 0x69, 0x20, 0x52, 0x6F, 0x62, 0x6F, 0x00, 0x53, 0x6F, 0x6E, 0x69, 0x63, 0x00, 0x42, 0x61,
+	0x79, 0x6F, 0x6E, 0x65, 0x74, 0x74, 0x61, 0x20, 0x28, 0x50, 0x6C, 0x61, 0x79, 0x65, 0x72, 0x20,
+	0x32, 0x29, 0x00, 0x53, 0x6F, 0x6C, 0x61, 0x69, 0x72, 0x65, 0x20, 0x6F, 0x66, 0x20, 0x41, 0x73,
+	0x74, 0x6F, 0x72, 0x61, 0x00, 0x52, 0x79, 0x75, 0x00, 0x4F, 0x6E, 0x65, 0x2D, 0x45, 0x79, 0x65,
+	0x64, 0x20, 0x52, 0x61, 0x74, 0x68, 0x61, 0x6C, 0x6F, 0x73, 0x20, 0x61, 0x6E, 0x64, 0x20, 0x52,
+	0x69, 0x64, 0x65, 0x72, 0x00, 0x4F, 0x6E, 0x65, 0x2D, 0x45, 0x79, 0x65, 0x64, 0x20, 0x52, 0x61,
+	0x74, 0x68, 0x61, 0x6C, 0x6F, 0x73, 0x20, 0x61, 0x6E, 0x64, 0x20, 0x52, 0x69, 0x64, 0x65, 0x72,
+	0x20, 0x28, 0x4D, 0x61, 0x6C, 0x65, 0x29, 0x00, 0x4F, 0x6E, 0x65, 0x2D, 0x45, 0x79, 0x65, 0x64,
+	0x20, 0x52, 0x61, 0x74, 0x68, 0x61, 0x6C, 0x6F, 0x73, 0x20, 0x61, 0x6E, 0x64, 0x20, 0x52, 0x69,
+	0x64, 0x65, 0x72, 0x20, 0x28, 0x46, 0x65, 0x6D, 0x61, 0x6C, 0x65, 0x29, 0x00, 0x4E, 0x61, 0x62,
+	0x69, 0x72, 0x75, 0x00, 0x52, 0x61, 0x74, 0x68, 0x69, 0x61, 0x6E, 0x20, 0x61, 0x6E, 0x64, 0x20,
+	0x43, 0x68, 0x65, 0x76, 0x61, 0x6C, 0x00, 0x42, 0x61, 0x72, 0x69, 0x6F, 0x74, 0x68, 0x20, 0x61,
+	0x6E, 0x64, 0x20, 0x41, 0x79, 0x75, 0x72, 0x69, 0x61, 0x00, 0x51, 0x75, 0x72, 0x75, 0x70, 0x65,
+	0x63, 0x6F, 0x20, 0x61, 0x6E, 0x64, 0x20, 0x44, 0x61, 0x6E, 0x00, 0x50, 0x6C, 0x61, 0x67, 0x75,
+	0x65, 0x20, 0x4B, 0x6E, 0x69, 0x67, 0x68, 0x74, 0x00, 0x53, 0x70, 0x65, 0x63, 0x74, 0x65, 0x72,
+	0x20, 0x4B, 0x6E, 0x69, 0x67, 0x68, 0x74, 0x00, 0x4B, 0x69, 0x6E, 0x67, 0x20, 0x4B, 0x6E, 0x69,
+	0x67, 0x68, 0x74, 0x00, 0x43, 0x6C, 0x6F, 0x75, 0x64, 0x00, 0x43, 0x6C, 0x6F, 0x75, 0x64, 0x20,
+	0x28, 0x50, 0x6C, 0x61, 0x79, 0x65, 0x72, 0x20, 0x32, 0x29, 0x00, 0x53, 0x75, 0x70, 0x65, 0x72,
+	0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x43, 0x65, 0x72, 0x65, 0x61, 0x6C, 0x00, 0x52, 0x69,
+	0x63, 0x68, 0x74, 0x65, 0x72, 0x00, 0x50, 0x61, 0x77, 0x61, 0x70, 0x75, 0x72, 0x6F, 0x00, 0x49,
+	0x6B, 0x61, 0x72, 0x69, 0x00, 0x44, 0x61, 0x69, 0x6A, 0x6F, 0x62, 0x75, 0x00, 0x48, 0x61, 0x79,
+	0x61, 0x6B, 0x61, 0x77, 0x61, 0x00, 0x59, 0x61, 0x62, 0x65, 0x00, 0x47, 0x61, 0x6E, 0x64, 0x61,
+	0x00, 0x4C, 0x6F, 0x6F, 0x74, 0x20, 0x47, 0x6F, 0x62, 0x6C, 0x69, 0x6E, 0x00, 0x53, 0x75, 0x70,
+	0x65, 0x72, 0x20, 0x53, 0x6D, 0x61, 0x73, 0x68, 0x20, 0x42, 0x72, 0x6F, 0x73, 0x2E, 0x00, 0x43,
+	0x68, 0x69, 0x62, 0x69, 0x20, 0x52, 0x6F, 0x62, 0x6F, 0x21, 0x00, 0x53, 0x75, 0x70, 0x65, 0x72,
+	0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x42, 0x72, 0x6F, 0x73, 0x2E, 0x20, 0x33, 0x30, 0x74,
+	0x68, 0x20, 0x41, 0x6E, 0x6E, 0x69, 0x76, 0x65, 0x72, 0x73, 0x61, 0x72, 0x79, 0x00, 0x53, 0x6B,
+	0x79, 0x6C, 0x61, 0x6E, 0x64, 0x65, 0x72, 0x73, 0x00, 0x53, 0x70, 0x65, 0x63, 0x69, 0x61, 0x6C,
+	0x20, 0x50, 0x6F, 0x6B, 0xC3, 0xA9, 0x6D, 0x6F, 0x6E, 0x00, 0x4F, 0x74, 0x68, 0x65, 0x72, 0x00,
+	0x52, 0x2E, 0x4F, 0x2E, 0x42, 0x2E, 0x20, 0x28, 0x46, 0x61, 0x6D, 0x69, 0x63, 0x6F, 0x6D, 0x29,
+	0x00, 0x52, 0x2E, 0x4F, 0x2E, 0x42, 0x2E, 0x20, 0x28, 0x4E, 0x45, 0x53, 0x29, 0x00, 0x4D, 0x61,
+	0x72, 0x69, 0x6F, 0x20, 0x28, 0x47, 0x6F, 0x6C, 0x64, 0x20, 0x45, 0x64, 0x69, 0x74, 0x69, 0x6F,
+	0x6E, 0x29, 0x00, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x53, 0x69, 0x6C, 0x76, 0x65, 0x72,
+	0x20, 0x45, 0x64, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x29, 0x00, 0x47, 0x72, 0x65, 0x65, 0x6E, 0x20,
+	0x59, 0x61, 0x72, 0x6E, 0x20, 0x59, 0x6F, 0x73, 0x68, 0x69, 0x00, 0x50, 0x69, 0x6E, 0x6B, 0x20,
+	0x59, 0x61, 0x72, 0x6E, 0x20, 0x59, 0x6F, 0x73, 0x68, 0x69, 0x00, 0x4C, 0x69, 0x67, 0x68, 0x74,
+	0x20, 0x42, 0x6C, 0x75, 0x65, 0x20, 0x59, 0x61, 0x72, 0x6E, 0x20, 0x59, 0x6F, 0x73, 0x68, 0x69,
+	0x00, 0x49, 0x73, 0x61, 0x62, 0x65, 0x6C, 0x6C, 0x65, 0x00, 0x54, 0x6F, 0x6D, 0x6D, 0x79, 0x00,
+	0x44, 0x6F, 0x6E, 0x20, 0x52, 0x65, 0x73, 0x65, 0x74, 0x74, 0x69, 0x00, 0x49, 0x73, 0x61, 0x62,
+	0x65, 0x6C, 0x6C, 0x65, 0x20, 0x28, 0x50, 0x61, 0x72, 0x66, 0x61, 0x69, 0x74, 0x29, 0x00, 0x47,
+	0x6F, 0x6C, 0x64, 0x69, 0x65, 0x20, 0x28, 0x61, 0x6D, 0x69, 0x69, 0x62, 0x6F, 0x20, 0x46, 0x65,
+	0x73, 0x74, 0x69, 0x76, 0x61, 0x6C, 0x29, 0x00, 0x53, 0x74, 0x69, 0x74, 0x63, 0x68, 0x65, 0x73,
+	0x20, 0x28, 0x61, 0x6D, 0x69, 0x69, 0x62, 0x6F, 0x20, 0x46, 0x65, 0x73, 0x74, 0x69, 0x76, 0x61,
+	0x6C, 0x29, 0x00, 0x52, 0x6F, 0x73, 0x69, 0x65, 0x20, 0x28, 0x61, 0x6D, 0x69, 0x69, 0x62, 0x6F,
+	0x20, 0x46, 0x65, 0x73, 0x74, 0x69, 0x76, 0x61, 0x6C, 0x29, 0x00, 0x4B, 0x2E, 0x4B, 0x2E, 0x20,
+	0x53, 0x6C, 0x69, 0x64, 0x65, 0x72, 0x20, 0x28, 0x50, 0x61, 0x72, 0x66, 0x61, 0x69, 0x74, 0x29,
+	0x00, 0x38, 0x2D, 0x62, 0x69, 0x74, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x43, 0x6C,
+	0x61, 0x73, 0x73, 0x69, 0x63, 0x20, 0x43, 0x6F, 0x6C, 0x6F, 0x72, 0x29, 0x00, 0x38, 0x2D, 0x62,
+	0x69, 0x74, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x4D, 0x6F, 0x64, 0x65, 0x72, 0x6E,
+	0x20, 0x43, 0x6F, 0x6C, 0x6F, 0x72, 0x29, 0x00, 0x4D, 0x65, 0x67, 0x61, 0x20, 0x59, 0x61, 0x72,
+	0x6E, 0x20, 0x59, 0x6F, 0x73, 0x68, 0x69, 0x00, 0x4D, 0x65, 0x67, 0x61, 0x20, 0x4D, 0x61, 0x6E,
+	0x20, 0x28, 0x47, 0x6F, 0x6C, 0x64, 0x20, 0x45, 0x64, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x29, 0x00,
+	0x49, 0x6E, 0x6B, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x47, 0x69, 0x72, 0x6C, 0x20, 0x28, 0x4C, 0x69,
+	0x6D, 0x65, 0x20, 0x47, 0x72, 0x65, 0x65, 0x6E, 0x29, 0x00, 0x49, 0x6E, 0x6B, 0x6C, 0x69, 0x6E,
+	0x67, 0x20, 0x42, 0x6F, 0x79, 0x20, 0x28, 0x50, 0x75, 0x72, 0x70, 0x6C, 0x65, 0x29, 0x00, 0x49,
+	0x6E, 0x6B, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x53, 0x71, 0x75, 0x69, 0x64, 0x20, 0x28, 0x4F, 0x72,
+	0x61, 0x6E, 0x67, 0x65, 0x29, 0x00, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x42, 0x61, 0x73,
+	0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x48, 0x6F,
+	0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x4C, 0x75, 0x69, 0x67,
+	0x69, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x4C, 0x75, 0x69,
+	0x67, 0x69, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67,
+	0x29, 0x00, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C,
+	0x6C, 0x29, 0x00, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20,
+	0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x44, 0x61, 0x69, 0x73, 0x79, 0x20, 0x28, 0x42,
+	0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x44, 0x61, 0x69, 0x73, 0x79, 0x20, 0x28,
+	0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x59, 0x6F,
+	0x73, 0x68, 0x69, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x59,
+	0x6F, 0x73, 0x68, 0x69, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69,
+	0x6E, 0x67, 0x29, 0x00, 0x57, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62,
+	0x61, 0x6C, 0x6C, 0x29, 0x00, 0x57, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73,
+	0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x57, 0x61, 0x6C, 0x75, 0x69, 0x67,
+	0x69, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x57, 0x61, 0x6C,
+	0x75, 0x69, 0x67, 0x69, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69,
+	0x6E, 0x67, 0x29, 0x00, 0x44, 0x6F, 0x6E, 0x6B, 0x65, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20,
+	0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x44, 0x6F, 0x6E, 0x6B, 0x65,
+	0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61,
+	0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x44, 0x69, 0x64, 0x64, 0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67,
+	0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x44, 0x69, 0x64, 0x64,
+	0x79, 0x20, 0x4B, 0x6F, 0x6E, 0x67, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61,
+	0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x28, 0x42, 0x61,
+	0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x28,
+	0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x42, 0x6F,
+	0x77, 0x73, 0x65, 0x72, 0x20, 0x4A, 0x72, 0x2E, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61,
+	0x6C, 0x6C, 0x29, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x4A, 0x72, 0x2E, 0x20, 0x28,
+	0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x42, 0x6F,
+	0x6F, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x42, 0x6F, 0x6F,
+	0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00,
+	0x42, 0x61, 0x62, 0x79, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65,
+	0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F,
+	0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00,
+	0x42, 0x61, 0x62, 0x79, 0x20, 0x4C, 0x75, 0x69, 0x67, 0x69, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65,
+	0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x42, 0x61, 0x62, 0x79, 0x20, 0x4C, 0x75, 0x69, 0x67, 0x69,
+	0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00,
+	0x42, 0x69, 0x72, 0x64, 0x6F, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29,
+	0x00, 0x42, 0x69, 0x72, 0x64, 0x6F, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61,
+	0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x52, 0x6F, 0x73, 0x61, 0x6C, 0x69, 0x6E, 0x61, 0x20, 0x28,
+	0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x52, 0x6F, 0x73, 0x61, 0x6C, 0x69,
+	0x6E, 0x61, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67,
+	0x29, 0x00, 0x4D, 0x65, 0x74, 0x61, 0x6C, 0x20, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x42,
+	0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x4D, 0x65, 0x74, 0x61, 0x6C, 0x20, 0x4D,
+	0x61, 0x72, 0x69, 0x6F, 0x20, 0x28, 0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69,
+	0x6E, 0x67, 0x29, 0x00, 0x50, 0x69, 0x6E, 0x6B, 0x20, 0x47, 0x6F, 0x6C, 0x64, 0x20, 0x50, 0x65,
+	0x61, 0x63, 0x68, 0x20, 0x28, 0x42, 0x61, 0x73, 0x65, 0x62, 0x61, 0x6C, 0x6C, 0x29, 0x00, 0x50,
+	0x69, 0x6E, 0x6B, 0x20, 0x47, 0x6F, 0x6C, 0x64, 0x20, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x28,
+	0x48, 0x6F, 0x72, 0x73, 0x65, 0x20, 0x52, 0x61, 0x63, 0x69, 0x6E, 0x67, 0x29, 0x00, 0x52, 0x69,
+	0x6C, 0x6C, 0x61, 0x00, 0x4D, 0x61, 0x72, 0x74, 0x79, 0x00, 0xC3, 0x89, 0x74, 0x6F, 0x69, 0x6C,
+	0x65, 0x00, 0x43, 0x68, 0x61, 0x69, 0x00, 0x43, 0x68, 0x65, 0x6C, 0x73, 0x65, 0x61, 0x00, 0x54,
+	0x6F, 0x62, 0x79, 0x00, 0x4C, 0x69, 0x6E, 0x6B, 0x20, 0x28, 0x4F, 0x63, 0x61, 0x72, 0x69, 0x6E,
+	0x61, 0x20, 0x6F, 0x66, 0x20, 0x54, 0x69, 0x6D, 0x65, 0x29, 0x00, 0x4C, 0x69, 0x6E, 0x6B, 0x20,
+	0x28, 0x4D, 0x61, 0x6A, 0x6F, 0x72, 0x61, 0x27, 0x73, 0x20, 0x4D, 0x61, 0x73, 0x6B, 0x29, 0x00,
+	0x4C, 0x69, 0x6E, 0x6B, 0x20, 0x28, 0x54, 0x77, 0x69, 0x6C, 0x69, 0x67, 0x68, 0x74, 0x20, 0x50,
+	0x72, 0x69, 0x6E, 0x63, 0x65, 0x73, 0x73, 0x29, 0x00, 0x4C, 0x69, 0x6E, 0x6B, 0x20, 0x28, 0x53,
+	0x6B, 0x79, 0x77, 0x61, 0x72, 0x64, 0x20, 0x53, 0x77, 0x6F, 0x72, 0x64, 0x29, 0x00, 0x4C, 0x69,
+	0x6E, 0x6B, 0x20, 0x28, 0x38, 0x2D, 0x62, 0x69, 0x74, 0x29, 0x00, 0x54, 0x6F, 0x6F, 0x6E, 0x20,
+	0x4C, 0x69, 0x6E, 0x6B, 0x20, 0x28, 0x54, 0x68, 0x65, 0x20, 0x57, 0x69, 0x6E, 0x64, 0x20, 0x57,
+	0x61, 0x6B, 0x65, 0x72, 0x29, 0x00, 0x54, 0x6F, 0x6F, 0x6E, 0x20, 0x5A, 0x65, 0x6C, 0x64, 0x61,
+	0x20, 0x28, 0x54, 0x68, 0x65, 0x20, 0x57, 0x69, 0x6E, 0x64, 0x20, 0x57, 0x61, 0x6B, 0x65, 0x72,
+	0x29, 0x00, 0x4C, 0x69, 0x6E, 0x6B, 0x20, 0x28, 0x41, 0x72, 0x63, 0x68, 0x65, 0x72, 0x29, 0x00,
+	0x4C, 0x69, 0x6E, 0x6B, 0x20, 0x28, 0x52, 0x69, 0x64, 0x65, 0x72, 0x29, 0x00, 0x50, 0x6F, 0x6F,
+	0x63, 0x68, 0x79, 0x00, 0x49, 0x6E, 0x6B, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x47, 0x69, 0x72, 0x6C,
+	0x20, 0x28, 0x4E, 0x65, 0x6F, 0x6E, 0x20, 0x50, 0x69, 0x6E, 0x6B, 0x29, 0x00, 0x49, 0x6E, 0x6B,
+	0x6C, 0x69, 0x6E, 0x67, 0x20, 0x42, 0x6F, 0x79, 0x20, 0x28, 0x4E, 0x65, 0x6F, 0x6E, 0x20, 0x47,
+	0x72, 0x65, 0x65, 0x6E, 0x29, 0x00, 0x49, 0x6E, 0x6B, 0x6C, 0x69, 0x6E, 0x67, 0x20, 0x53, 0x71,
+	0x75, 0x69, 0x64, 0x20, 0x28, 0x4E, 0x65, 0x6F, 0x6E, 0x20, 0x50, 0x75, 0x72, 0x70, 0x6C, 0x65,
+	0x29, 0x00, 0x4D, 0x61, 0x72, 0x69, 0x6F, 0x20, 0x2D, 0x20, 0x57, 0x65, 0x64, 0x64, 0x69, 0x6E,
+	0x67, 0x00, 0x50, 0x65, 0x61, 0x63, 0x68, 0x20, 0x2D, 0x20, 0x57, 0x65, 0x64, 0x64, 0x69, 0x6E,
+	0x67, 0x00, 0x42, 0x6F, 0x77, 0x73, 0x65, 0x72, 0x20, 0x2D, 0x20, 0x57, 0x65, 0x64, 0x64, 0x69,
+	0x6E, 0x67, 0x00, 0x59, 0x6F, 0x75, 0x6E, 0x67, 0x20, 0x4C, 0x69, 0x6E, 0x6B, 0x00, 0x53, 0x68,
+	0x6F, 0x76, 0x65, 0x6C, 0x20, 0x4B, 0x6E, 0x69, 0x67, 0x68, 0x74, 0x20, 0x28, 0x47, 0x6F, 0x6C,
+	0x64, 0x20, 0x45, 0x64, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x29, 0x00, 0x00,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_AMIIBODATA_BIN_H__ */
@@ -0,0 +1,316 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * ELFData_data.h: Generated lookup tables.                                *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: ELFData_data.txt                                                *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_ELFDATA_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_ELFDATA_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace ELFData_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (4250 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"No machine\0"
+	"AT&T WE 32100 (M32)\0"
+	"Sun/Oracle SPARC\0"
+	"Intel i386\0"
+	"Motorola M68K\0"
+	"Motorola M88K\0"
+	"Intel i486\0"
+	"Intel i860\0"
+	"MIPS\0"
+	"IBM System/370\0"
+	"MIPS R3000 LE (deprecated)\0"
+	"SPARC v9 (deprecated)\0"
+	"HP PA-RISC\0"
+	"nCUBE\0"
+	"Fujitsu VPP500\0"
+	"SPARC32PLUS\0"
+	"Intel i960\0"
+	"PowerPC\0"
+	"64-bit PowerPC\0"
+	"IBM System/390\0"
+	"Cell SPU\0"
+	"Cisco SVIP\0"
+	"Cisco 7200\0"
+	"NEC V800\0"
+	"Fujitsu FR20\0"
+	"TRW RH-32\0"
+	"Motorola M*Core\0"
+	"ARM\0"
+	"DEC Alpha\0"
+	"Renesas SuperH\0"
+	"SPARC v9\0"
+	"Siemens Tricore embedded processor\0"
+	"Argonaut RISC Core\0"
+	"Renesas H8/300\0"
+	"Renesas H8/300H\0"
+	"Renesas H8S\0"
+	"Renesas H8/500\0"
+	"Intel Itanium\0"
+	"Stanford MIPS-X\0"
+	"Motorola Coldfire\0"
+	"Motorola MC68HC12\0"
+	"Fujitsu Multimedia Accelerator\0"
+	"Siemens PCP\0"
+	"Sony nCPU\0"
+	"Denso NDR1\0"
+	"Motorola Star*Core\0"
+	"Toyota ME16\0"
+	"STMicroelectronics ST100\0"
+	"Advanced Logic Corp. TinyJ\0"
+	"AMD64\0"
+	"Sony DSP\0"
+	"DEC PDP-10\0"
+	"DEC PDP-11\0"
+	"Siemens FX66\0"
+	"STMicroelectronics ST9+ 8/16-bit\0"
+	"STMicroelectronics ST7 8-bit\0"
+	"Motorola MC68HC16\0"
+	"Motorola MC68HC11\0"
+	"Motorola MC68HC08\0"
+	"Motorola MC68HC05\0"
+	"SGI SVx or Cray NV1\0"
+	"STMicroelectronics ST19 8-bit\0"
+	"Digital VAX\0"
+	"Axis cris\0"
+	"Infineon Technologies 32-bit embedded CPU\0"
+	"Element 14 64-bit DSP\0"
+	"LSI Logic 16-bit DSP\0"
+	"Donald Knuth's 64-bit MMIX CPU\0"
+	"Harvard machine-independent\0"
+	"SiTera Prism\0"
+	"Atmel AVR 8-bit\0"
+	"Fujitsu FR30\0"
+	"Mitsubishi D10V\0"
+	"Mitsubishi D30V\0"
+	"Renesas V850\0"
+	"Renesas M32R\0"
+	"Matsushita MN10300\0"
+	"Matsushita MN10200\0"
+	"picoJava\0"
+	"OpenRISC 1000\0"
+	"ARCompact\0"
+	"Tensilica Xtensa\0"
+	"Alphamosaic VideoCore\0"
+	"Thompson Multimedia GPP\0"
+	"National Semiconductor 32000\0"
+	"Tenor Network TPC\0"
+	"Trebia SNP 1000\0"
+	"STMicroelectronics ST200\0"
+	"Ubicom IP2022\0"
+	"MAX Processor\0"
+	"National Semiconductor CompactRISC\0"
+	"Fujitsu F2MC16\0"
+	"TI msp430\0"
+	"ADI Blackfin\0"
+	"S1C33 Family of Seiko Epson\0"
+	"Sharp embedded\0"
+	"Arca RISC\0"
+	"Unicore\0"
+	"eXcess\0"
+	"Icera Deep Execution Processor\0"
+	"Altera Nios II\0"
+	"National Semiconductor CRX\0"
+	"Motorola XGATE\0"
+	"Infineon C16x/XC16x\0"
+	"Renesas M16C series\0"
+	"Microchip dsPIC30F\0"
+	"Freescale RISC core\0"
+	"Renesas M32C series\0"
+	"Altium TSK3000 core\0"
+	"Freescale RS08\0"
+	"ADI SHARC family\0"
+	"Cyan Technology eCOG2\0"
+	"Sunplus S+core7 RISC\0"
+	"New Japan Radio (NJR) 24-bit DSP\0"
+	"Broadcom VideoCore III\0"
+	"Lattice Mico32\0"
+	"Seiko Epson C17 family\0"
+	"TI TMS320C6000 DSP family\0"
+	"TI TMS320C2000 DSP family\0"
+	"TI TMS320C55x DSP family\0"
+	"TI Programmable Realtime Unit\0"
+	"STMicroelectronics 64-bit VLIW DSP\0"
+	"Cypress M8C\0"
+	"Renesas R32C series\0"
+	"NXP TriMedia family\0"
+	"Qualcomm DSP6\0"
+	"Intel 8051\0"
+	"STMicroelectronics STxP7x family\0"
+	"Andes Technology NDS32\0"
+	"Cyan eCOG1X family\0"
+	"Dallas MAXQ30\0"
+	"New Japan Radio (NJR) 16-bit DSP\0"
+	"M2000 Reconfigurable RISC\0"
+	"Cray NV2 vector architecture\0"
+	"Renesas RX family\0"
+	"Imagination Technologies Meta\0"
+	"MCST Elbrus\0"
+	"Cyan Technology eCOG16 family\0"
+	"National Semiconductor CompactRISC (16-bit)\0"
+	"Freescale Extended Time Processing Unit\0"
+	"Infineon SLE9X\0"
+	"Intel L10M\0"
+	"Intel K10M\0"
+	"Intel (182)\0"
+	"ARM AArch64\0"
+	"ARM (184)\0"
+	"Atmel AVR32\0"
+	"STMicroelectronics STM8 8-bit\0"
+	"Tilera TILE64\0"
+	"Tilera TILEPro\0"
+	"Xilinx MicroBlaze 32-bit RISC\0"
+	"NVIDIA CUDA\0"
+	"Tilera TILE-Gx\0"
+	"CloudShield\0"
+	"KIPO-KAIST Core-A 1st gen.\0"
+	"KIPO-KAIST Core-A 2nd gen.\0"
+	"Synopsys ARCompact V2\0"
+	"Open8 RISC\0"
+	"Renesas RL78 family\0"
+	"Broadcom VideoCore V\0"
+	"Renesas 78K0R\0"
+	"Freescale 56800EX\0"
+	"Beyond BA1\0"
+	"Beyond BA2\0"
+	"XMOS xCORE\0"
+	"Micrchip 8-bit PIC(r)\0"
+	"Intel (205)\0"
+	"Intel (206)\0"
+	"Intel (207)\0"
+	"Intel (208)\0"
+	"Intel (209)\0"
+	"KM211 KM32\0"
+	"KM211 KMX32\0"
+	"KM211 KMX16\0"
+	"KM211 KMX8\0"
+	"KM211 KVARC\0"
+	"Paneve CDP\0"
+	"Cognitive Smart Memory\0"
+	"Bluechip Systems CoolEngine\0"
+	"Nanoradio Optimized RISC\0"
+	"CSR Kalimba\0"
+	"Zilog Z80\0"
+	"Controls and Data Services VISIUMcore\0"
+	"FTDI Chip FT32\0"
+	"Moxie processor\0"
+	"AMD GPU\0"
+	"RISC-V\0"
+	"Lanai\0"
+	"eBPF\0"
+	"Netronome Flow Processor\0"
+	"NEC VE\0"
+	"C-SKY\0"
+	"AVR (unofficial)\0"
+	"MSP430 (unofficial)\0"
+	"Adapteva Epiphany (unofficial)\0"
+	"Morpho MT (unofficial)\0"
+	"Fujitsu FR30 (unofficial)\0"
+	"OpenRISC (obsolete)\0"
+	"WebAssembly (unofficial)\0"
+	"Infineon C166 (unofficial)\0"
+	"Freescale S12Z (unofficial)\0"
+	"Fujitsu FR-V (unofficial)\0"
+	"DLX (unofficial)\0"
+	"Mitsubishi D10V (unofficial)\0"
+	"Mitsubishi D30V (unofficial)\0"
+	"Ubicom IP2xxx (unofficial)\0"
+	"PowerPC (unofficial)\0"
+	"DEC Alpha (unofficial)\0"
+	"Renesas M32R (unofficial)\0"
+	"Renesas V850 (unofficial)\0"
+	"IBM System/390 (obsolete)\0"
+	"Old Xtensa (unofficial)\0"
+	"xstormy16 (unofficial)\0"
+	"Old MicroBlaze (unofficial)\0"
+	"Matsushita MN10300 (unofficial)\0"
+	"Matsushita MN10200 (unofficial)\0"
+	"Toshiba MeP (unofficial)\0"
+	"Renesas M32C (unofficial)\0"
+	"Vitesse IQ2000 (unofficial)\0"
+	"NIOS (unofficial)\0"
+	"Moxie (unofficial)\0"
+	"UNIX System V\0"
+	"HP-UX\0"
+	"NetBSD\0"
+	"GNU/Linux\0"
+	"GNU/Hurd\0"
+	"86Open\0"
+	"Solaris\0"
+	"Monterey\0"
+	"IRIX\0"
+	"FreeBSD\0"
+	"Tru64\0"
+	"Novell Modesto\0"
+	"OpenBSD\0"
+	"OpenVMS\0"
+	"HP NonStop Kernel\0"
+	"AROS Research Operating System\0"
+	"FenixOS\0"
+	"Nuxi CloudABI\0";
+
+/** machineTypes_low: Array table (225 entries) **/
+static const unsigned int machineTypes_low_count = 225;
+static const uint16_t machineTypes_low_name[225] = {
+	1, 12, 32, 49, 60, 74, 88, 99, 110, 115, 130, 157,
+	0, 0, 0, 179, 190, 196, 211, 223, 234, 242, 257, 272,
+	281, 292, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	303, 312, 325, 335, 351, 355, 365, 380, 389, 424, 443, 458,
+	474, 486, 501, 515, 531, 549, 567, 598, 610, 620, 631, 650,
+	662, 687, 714, 720, 729, 740, 751, 764, 797, 826, 844, 862,
+	880, 898, 918, 948, 960, 970, 1012, 1034, 1055, 1086, 1114, 1127,
+	1143, 1156, 1172, 1188, 1201, 1214, 1233, 1252, 1261, 1275, 1285, 1302,
+	1324, 1348, 1377, 1395, 1411, 1436, 1450, 1464, 1499, 1514, 1524, 1537,
+	1565, 1580, 1590, 1598, 1605, 1636, 1651, 1678, 1693, 1713, 1733, 1752,
+	1772, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1792,
+	1812, 1827, 1844, 1866, 1887, 1920, 1943, 1958, 1981, 2007, 2033, 0,
+	2058, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 2088, 2123, 2135, 2155, 2175, 2189, 2200, 2233,
+	2256, 2275, 2289, 2322, 2348, 2377, 2395, 2425, 2437, 2467, 2511, 2551,
+	2566, 2577, 2588, 2600, 2612, 2622, 2634, 2664, 2678, 2693, 2723, 2735,
+	2750, 2762, 2789, 2816, 2838, 2849, 2869, 2890, 2904, 2922, 2933, 2944,
+	2955, 2977, 2989, 3001, 3013, 3025, 3037, 3048, 3060, 3072, 3083, 3095,
+	3106, 3129, 3157, 3182, 3194, 3204, 3242, 3257, 3273,
+};
+
+/** machineTypes_other: Perfect hash table (36 entries) **/
+static const uint16_t machineTypes_other_keys[36] = {
+	0x1057, 0x4688, 0xFEB0, 0xF7, 0x5441, 0x8217, 0x1059, 0x9025,
+	0xFC, 0xFB, 0x4DEF, 0xBAAB, 0xF4, 0x3330, 0x4157, 0x9041,
+	0x7650, 0xA390, 0x9026, 0xF3, 0xBEEF, 0xABC7, 0xFEBB, 0xDEAD,
+	0xAD45, 0x1223, 0xF00D, 0x3426, 0xFA, 0x8472, 0xFEED, 0xFEBA,
+	0x2530, 0x9080, 0x5AA5, 0x7676,
+};
+static const int16_t machineTypes_other_disp[36] = {
+	0, 0, 2, -36, 3, -30, 0, -24, -18, 0, -16, 1,
+	-12, -10, 0, 0, 1, 0, 0, 0, 1, -5, 0, 0,
+	1, 0, 0, 0, 1, 1, 12, 4, 3, 4, -1, 0,
+};
+static const uint16_t machineTypes_other_name[36] = {
+	3337, 3499, 3968, 3294, 3554, 3655, 3354, 3682, 3331, 3324, 3526, 3851,
+	3288, 3428, 3474, 3726, 3597, 3778, 3703, 3281, 3879, 3804, 4022, 3911,
+	3828, 3374, 3943, 3454, 3299, 3454, 4040, 3994, 3405, 3752, 3580, 3626,
+};
+
+/** osabi_names: Array table (18 entries) **/
+static const unsigned int osabi_names_count = 18;
+static const uint16_t osabi_names_name[18] = {
+	4059, 4073, 4079, 4086, 4096, 4105, 4112, 4120, 4129, 4134, 4142, 4148,
+	4163, 4171, 4179, 4197, 4228, 4236,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_ELFDATA_DATA_H__ */
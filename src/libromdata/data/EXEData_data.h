@@ -0,0 +1,147 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * EXEData_data.h: Generated lookup tables.                                *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: EXEData_data.txt                                                *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_EXEDATA_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_EXEDATA_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace EXEData_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (680 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"Intel i386\0"
+	"MIPS R3000 (big-endian)\0"
+	"MIPS R3000\0"
+	"MIPS R4000\0"
+	"MIPS R10000\0"
+	"MIPS (WCE v2)\0"
+	"DEC Alpha AXP\0"
+	"Hitachi SH3\0"
+	"Hitachi SH3 DSP\0"
+	"Hitachi SH3E\0"
+	"Hitachi SH4\0"
+	"Hitachi SH5\0"
+	"ARM\0"
+	"ARM Thumb\0"
+	"ARM Thumb-2\0"
+	"Matsushita AM33\0"
+	"PowerPC\0"
+	"PowerPC with FPU\0"
+	"PowerPC (big-endian)\0"
+	"Intel Itanium\0"
+	"MIPS16\0"
+	"Motorola 68000\0"
+	"PA-RISC\0"
+	"DEC Alpha AXP (64-bit)\0"
+	"MIPS with FPU\0"
+	"MIPS16 with FPU\0"
+	"Infineon TriCore\0"
+	"Common Executable Format\0"
+	"EFI Byte Code\0"
+	"RISC-V (32-bit address space)\0"
+	"RISC-V (64-bit address space)\0"
+	"RISC-V (128-bit address space)\0"
+	"AMD64\0"
+	"Mitsubishi M32R\0"
+	"ARM (64-bit)\0"
+	"MSIL\0"
+	"Intel i286\0"
+	"Intel i486\0"
+	"Intel Pentium\0"
+	"Intel i860 XR (N10)\0"
+	"Intel i860 XP (N11)\0"
+	"MIPS Mark I (R2000, R3000\0"
+	"MIPS Mark II (R6000)\0"
+	"MIPS Mark III (R4000)\0";
+
+/** machineTypes_PE: Perfect hash table (36 entries) **/
+static_assert(IMAGE_FILE_MACHINE_I386 == 0x14C, "IMAGE_FILE_MACHINE_I386 has changed.");
+static_assert(IMAGE_FILE_MACHINE_R3000_BE == 0x160, "IMAGE_FILE_MACHINE_R3000_BE has changed.");
+static_assert(IMAGE_FILE_MACHINE_R3000 == 0x162, "IMAGE_FILE_MACHINE_R3000 has changed.");
+static_assert(IMAGE_FILE_MACHINE_R4000 == 0x166, "IMAGE_FILE_MACHINE_R4000 has changed.");
+static_assert(IMAGE_FILE_MACHINE_R10000 == 0x168, "IMAGE_FILE_MACHINE_R10000 has changed.");
+static_assert(IMAGE_FILE_MACHINE_WCEMIPSV2 == 0x169, "IMAGE_FILE_MACHINE_WCEMIPSV2 has changed.");
+static_assert(IMAGE_FILE_MACHINE_ALPHA == 0x184, "IMAGE_FILE_MACHINE_ALPHA has changed.");
+static_assert(IMAGE_FILE_MACHINE_SH3 == 0x1A2, "IMAGE_FILE_MACHINE_SH3 has changed.");
+static_assert(IMAGE_FILE_MACHINE_SH3DSP == 0x1A3, "IMAGE_FILE_MACHINE_SH3DSP has changed.");
+static_assert(IMAGE_FILE_MACHINE_SH3E == 0x1A4, "IMAGE_FILE_MACHINE_SH3E has changed.");
+static_assert(IMAGE_FILE_MACHINE_SH4 == 0x1A6, "IMAGE_FILE_MACHINE_SH4 has changed.");
+static_assert(IMAGE_FILE_MACHINE_SH5 == 0x1A8, "IMAGE_FILE_MACHINE_SH5 has changed.");
+static_assert(IMAGE_FILE_MACHINE_ARM == 0x1C0, "IMAGE_FILE_MACHINE_ARM has changed.");
+static_assert(IMAGE_FILE_MACHINE_THUMB == 0x1C2, "IMAGE_FILE_MACHINE_THUMB has changed.");
+static_assert(IMAGE_FILE_MACHINE_ARMNT == 0x1C4, "IMAGE_FILE_MACHINE_ARMNT has changed.");
+static_assert(IMAGE_FILE_MACHINE_AM33 == 0x1D3, "IMAGE_FILE_MACHINE_AM33 has changed.");
+static_assert(IMAGE_FILE_MACHINE_POWERPC == 0x1F0, "IMAGE_FILE_MACHINE_POWERPC has changed.");
+static_assert(IMAGE_FILE_MACHINE_POWERPCFP == 0x1F1, "IMAGE_FILE_MACHINE_POWERPCFP has changed.");
+static_assert(IMAGE_FILE_MACHINE_POWERPCBE == 0x1F2, "IMAGE_FILE_MACHINE_POWERPCBE has changed.");
+static_assert(IMAGE_FILE_MACHINE_IA64 == 0x200, "IMAGE_FILE_MACHINE_IA64 has changed.");
+static_assert(IMAGE_FILE_MACHINE_MIPS16 == 0x266, "IMAGE_FILE_MACHINE_MIPS16 has changed.");
+static_assert(IMAGE_FILE_MACHINE_M68K == 0x268, "IMAGE_FILE_MACHINE_M68K has changed.");
+static_assert(IMAGE_FILE_MACHINE_PA_RISC == 0x290, "IMAGE_FILE_MACHINE_PA_RISC has changed.");
+static_assert(IMAGE_FILE_MACHINE_ALPHA64 == 0x284, "IMAGE_FILE_MACHINE_ALPHA64 has changed.");
+static_assert(IMAGE_FILE_MACHINE_MIPSFPU == 0x366, "IMAGE_FILE_MACHINE_MIPSFPU has changed.");
+static_assert(IMAGE_FILE_MACHINE_MIPSFPU16 == 0x466, "IMAGE_FILE_MACHINE_MIPSFPU16 has changed.");
+static_assert(IMAGE_FILE_MACHINE_TRICORE == 0x520, "IMAGE_FILE_MACHINE_TRICORE has changed.");
+static_assert(IMAGE_FILE_MACHINE_CEF == 0xCEF, "IMAGE_FILE_MACHINE_CEF has changed.");
+static_assert(IMAGE_FILE_MACHINE_EBC == 0xEBC, "IMAGE_FILE_MACHINE_EBC has changed.");
+static_assert(IMAGE_FILE_MACHINE_RISCV32 == 0x5032, "IMAGE_FILE_MACHINE_RISCV32 has changed.");
+static_assert(IMAGE_FILE_MACHINE_RISCV64 == 0x5064, "IMAGE_FILE_MACHINE_RISCV64 has changed.");
+static_assert(IMAGE_FILE_MACHINE_RISCV128 == 0x5128, "IMAGE_FILE_MACHINE_RISCV128 has changed.");
+static_assert(IMAGE_FILE_MACHINE_AMD64 == 0x8664, "IMAGE_FILE_MACHINE_AMD64 has changed.");
+static_assert(IMAGE_FILE_MACHINE_M32R == 0x9041, "IMAGE_FILE_MACHINE_M32R has changed.");
+static_assert(IMAGE_FILE_MACHINE_ARM64 == 0xAA64, "IMAGE_FILE_MACHINE_ARM64 has changed.");
+static_assert(IMAGE_FILE_MACHINE_CEE == 0xC0EE, "IMAGE_FILE_MACHINE_CEE has changed.");
+static const uint16_t machineTypes_PE_keys[36] = {
+	0x200, 0x268, 0x366, 0x1A8, 0x1C2, 0x1C0, 0x160, 0x184,
+	0x5032, 0x1A2, 0xCEF, 0x1A4, 0x162, 0x5064, 0x266, 0xEBC,
+	0x284, 0x1A6, 0x1F1, 0x1F2, 0x290, 0x520, 0x169, 0xC0EE,
+	0x14C, 0x166, 0xAA64, 0x8664, 0x9041, 0x1D3, 0x168, 0x1C4,
+	0x466, 0x5128, 0x1A3, 0x1F0,
+};
+static const int16_t machineTypes_PE_disp[36] = {
+	1, -35, 0, 2, -32, 0, 0, 1, 0, 0, -29, -20,
+	0, 0, 0, -17, 3, 0, 0, 0, -13, 2, 3, 0,
+	0, 1, 6, 11, 3, 1, 0, 22, -12, -5, -1, 0,
+};
+static const uint16_t machineTypes_PE_name[36] = {
+	251, 272, 318, 151, 167, 163, 12, 84, 404, 98, 365, 126,
+	36, 434, 265, 390, 295, 139, 213, 230, 287, 348, 70, 530,
+	1, 47, 517, 495, 501, 189, 58, 177, 332, 464, 110, 205,
+};
+
+/** machineTypes_LE: Perfect hash table (9 entries) **/
+static_assert(LE_CPU_80286 == 0x1, "LE_CPU_80286 has changed.");
+static_assert(LE_CPU_80386 == 0x2, "LE_CPU_80386 has changed.");
+static_assert(LE_CPU_80486 == 0x3, "LE_CPU_80486 has changed.");
+static_assert(LE_CPU_80586 == 0x4, "LE_CPU_80586 has changed.");
+static_assert(LE_CPU_i860_N10 == 0x20, "LE_CPU_i860_N10 has changed.");
+static_assert(LE_CPU_i860_N11 == 0x21, "LE_CPU_i860_N11 has changed.");
+static_assert(LE_CPU_MIPS_I == 0x40, "LE_CPU_MIPS_I has changed.");
+static_assert(LE_CPU_MIPS_II == 0x41, "LE_CPU_MIPS_II has changed.");
+static_assert(LE_CPU_MIPS_III == 0x42, "LE_CPU_MIPS_III has changed.");
+static const uint16_t machineTypes_LE_keys[9] = {
+	0x40, 0x2, 0x20, 0x21, 0x1, 0x4, 0x3, 0x41,
+	0x42,
+};
+static const int16_t machineTypes_LE_disp[9] = {
+	2, -9, -6, -4, -2, 0, 0, 1, 0,
+};
+static const uint16_t machineTypes_LE_name[9] = {
+	611, 1, 571, 591, 535, 557, 546, 637, 658,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_EXEDATA_DATA_H__ */
@@ -0,0 +1,646 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * NESMappers_data.h: Generated lookup tables.                             *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: NESMappers_data.txt                                             *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_NESMAPPERS_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_NESMAPPERS_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace NESMappers_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (10743 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"NROM\0"
+	"Nintendo\0"
+	"SxROM (MMC1)\0"
+	"UxROM\0"
+	"CNROM\0"
+	"TxROM (MMC3), HKROM (MMC6)\0"
+	"ExROM (MMC5)\0"
+	"Game Doctor Mode 1\0"
+	"Bung/FFE\0"
+	"AxROM\0"
+	"Game Doctor Mode 4 (GxROM)\0"
+	"PxROM, PEEOROM (MMC2)\0"
+	"FxROM (MMC4)\0"
+	"Color Dreams\0"
+	"MMC3 variant\0"
+	"FFE\0"
+	"NES-CPROM\0"
+	"SL-1632 (MMC3/VRC2 clone)\0"
+	"K-1029 (multicart)\0"
+	"FCG-x\0"
+	"Bandai\0"
+	"FFE #17\0"
+	"SS 88006\0"
+	"Jaleco\0"
+	"Namco 129/163\0"
+	"Namco\0"
+	"Famicom Disk System\0"
+	"VRC4a, VRC4c\0"
+	"Konami\0"
+	"VRC2a\0"
+	"VRC4e, VRC4f, VRC2b\0"
+	"VRC6a\0"
+	"VRC4b, VRC4d, VRC2c\0"
+	"VRC6b\0"
+	"VRC4 variant\0"
+	"Action 53\0"
+	"Homebrew\0"
+	"RET-CUFROM\0"
+	"Sealie Computing\0"
+	"UNROM 512\0"
+	"RetroUSB\0"
+	"NSF Music Compilation\0"
+	"Irem G-101\0"
+	"Irem\0"
+	"Taito TC0190\0"
+	"Taito\0"
+	"BNROM, NINA-001\0"
+	"J.Y. Company ASIC (8 KiB WRAM)\0"
+	"J.Y. Company\0"
+	"TXC PCB 01-22000-400\0"
+	"TXC\0"
+	"MMC3 multicart\0"
+	"GNROM variant\0"
+	"Bit Corp.\0"
+	"BNROM variant\0"
+	"NTDEC 2722 (FDS conversion)\0"
+	"NTDEC\0"
+	"Caltron 6-in-1\0"
+	"Caltron\0"
+	"FDS conversion\0"
+	"TONY-I, YS-612 (FDS conversion)\0"
+	"MMC3 multicart (GA23C)\0"
+	"Rumble Station 15-in-1\0"
+	"Taito TC0690\0"
+	"PCB 761214 (FDS conversion)\0"
+	"N-32\0"
+	"Novel Diamond 9999999-in-1\0"
+	"BTL-MARIO1-MALEE2\0"
+	"KS202 (unlicensed SMB3 reproduction)\0"
+	"Multicart\0"
+	"(C)NROM-based multicart\0"
+	"BMC-T3H53/BMC-D1038 multicart\0"
+	"Reset-based NROM-128 4-in-1 multicart\0"
+	"20-in-1 multicart\0"
+	"Super 700-in-1 multicart\0"
+	"Powerful 250-in-1 multicart\0"
+	"Tengen RAMBO-1\0"
+	"Tengen\0"
+	"Irem H3001\0"
+	"GxROM, MHROM\0"
+	"Sunsoft-3\0"
+	"Sunsoft\0"
+	"Sunsoft-4\0"
+	"Sunsoft FME-7\0"
+	"Family Trainer\0"
+	"Codemasters (UNROM clone)\0"
+	"Codemasters\0"
+	"Jaleco JF-17\0"
+	"VRC3\0"
+	"43-393/860908C (MMC3 clone)\0"
+	"Waixing\0"
+	"VRC1\0"
+	"NAMCOT-3446 (Namcot 108 variant)\0"
+	"Napoleon Senki\0"
+	"Lenar\0"
+	"Holy Diver; Uchuusen - Cosmo Carrier\0"
+	"NINA-03, NINA-06\0"
+	"American Video Entertainment\0"
+	"Taito X1-005\0"
+	"Super Gun\0"
+	"Taito X1-017 (incorrect PRG ROM bank ordering)\0"
+	"Cony/Yoko\0"
+	"PC-SMB2J\0"
+	"VRC7\0"
+	"Jaleco JF-13\0"
+	"CNROM variant\0"
+	"Namcot 118 variant\0"
+	"Sunsoft-2 (Sunsoft-3 board)\0"
+	"J.Y. Company (simple nametable control)\0"
+	"J.Y. Company (Super Fighter III)\0"
+	"Moero!! Pro\0"
+	"Sunsoft-2 (Sunsoft-3R board)\0"
+	"HVC-UN1ROM\0"
+	"NAMCOT-3425\0"
+	"Oeka Kids\0"
+	"Irem TAM-S1\0"
+	"CNROM (Vs. System)\0"
+	"MMC3 variant (hacked ROMs)\0"
+	"Jaleco JF-10 (misdump)\0"
+	"Jaleceo\0"
+	"Doki Doki Panic (FDS conversion)\0"
+	"PEGASUS 5 IN 1\0"
+	"NES-EVENT (MMC1 variant) (Nintendo World Championships 1990)\0"
+	"Super Mario Bros. 3 (bootleg)\0"
+	"Magic Dragon\0"
+	"Magicseries\0"
+	"Cheapocabra GTROM 512k flash board\0"
+	"Membler Industries\0"
+	"NINA-03/06 multicart\0"
+	"MMC3 clone (scrambled registers)\0"
+	"K\307\216sh\303\250ng SFC-02B/-03/-004 (MMC3 clone)\0"
+	"K\307\216sh\303\250ng\0"
+	"SOMARI-P (Huang-1/Huang-2)\0"
+	"Gouder\0"
+	"TxSROM\0"
+	"TQROM\0"
+	"K\307\216sh\303\250ng A9711 and A9713 (MMC3 clone)\0"
+	"K\307\216sh\303\250ng H2288 (MMC3 clone)\0"
+	"Monty no Doki Doki Daisass\305\215 (FDS conversion)\0"
+	"Whirlwind Manu\0"
+	"TXC 05-00002-010 ASIC\0"
+	"Jovial Race\0"
+	"Sachen\0"
+	"T4A54A, WX-KB4K, BS-5652 (MMC3 clone)\0"
+	"Sachen 3011\0"
+	"Sachen 8259D\0"
+	"Sachen 8259B\0"
+	"Sachen 8259C\0"
+	"Jaleco JF-11, JF-14 (GNROM variant)\0"
+	"Sachen 8259A\0"
+	"Kaiser KS202 (FDS conversions)\0"
+	"Kaiser\0"
+	"Copy-protected NROM\0"
+	"Death Race (Color Dreams variant)\0"
+	"American Game Cartridges\0"
+	"Sidewinder (CNROM clone)\0"
+	"Galactic Crusader (NINA-06 clone)\0"
+	"Sachen 3018\0"
+	"Sachen SA-008-A, Tengen 800008\0"
+	"Sachen / Tengen\0"
+	"SA-0036 (CNROM clone)\0"
+	"Sachen SA-015, SA-630\0"
+	"VRC1 (Vs. System)\0"
+	"Kaiser KS202 (FDS conversion)\0"
+	"Bandai FCG: LZ93D50 with SRAM\0"
+	"NAMCOT-3453\0"
+	"MMC1A\0"
+	"DIS23C01\0"
+	"Daou Infosys\0"
+	"Datach Joint ROM System\0"
+	"Tengen 800037\0"
+	"Bandai LZ93D50 with 24C01\0"
+	"Nanjing\0"
+	"Waixing (unlicensed)\0"
+	"Fire Emblem (unlicensed) (MMC2+MMC3 hybrid)\0"
+	"Subor (variant 1)\0"
+	"Subor\0"
+	"Subor (variant 2)\0"
+	"Racermate Challenge 2\0"
+	"Racermate, Inc.\0"
+	"Yuxing\0"
+	"Kaiser KS-7058\0"
+	"Super Mega P-4040\0"
+	"Idea-Tek ET-xx\0"
+	"Idea-Tek\0"
+	"Waixing multicart (MMC3 clone)\0"
+	"H\303\251ngg\303\251 Di\303\240nz\307\220\0"
+	"Waixing / Nanjing / Jncota / Henge Dianzi / GameStar\0"
+	"Crazy Climber (UNROM clone)\0"
+	"Nichibutsu\0"
+	"Seicross v2 (FCEUX hack)\0"
+	"MMC3 clone (scrambled registers) (same as 114)\0"
+	"Suikan Pipe (VRC4e clone)\0"
+	"Sunsoft-1\0"
+	"CNROM with weak copy protection\0"
+	"Study Box\0"
+	"Fukutake Shoten\0"
+	"K\307\216sh\303\250ng A98402 (MMC3 clone)\0"
+	"Bandai Karaoke Studio\0"
+	"Thunder Warrior (MMC3 clone)\0"
+	"Magic Kid GooGoo\0"
+	"MMC3 clone\0"
+	"NTDEC TC-112\0"
+	"Waixing FS303 (MMC3 clone)\0"
+	"Mario bootleg (MMC3 clone)\0"
+	"K\307\216sh\303\250ng (MMC3 clone)\0"
+	"T\305\253nsh\303\255 Ti\304\201nd\303\254 - S\304\201ngu\303\263 W\303\240izhu\303\240n\0"
+	"Waixing (clone of either Mapper 004 or 176)\0"
+	"NROM-256 multicart\0"
+	"150-in-1 multicart\0"
+	"35-in-1 multicart\0"
+	"DxROM (Tengen MIMIC-1, Namcot 118)\0"
+	"Fudou Myouou Den\0"
+	"Street Fighter IV (unlicensed) (MMC3 clone)\0"
+	"J.Y. Company (MMC2/MMC4 clone)\0"
+	"Namcot 175, 340\0"
+	"J.Y. Company (extended nametable control)\0"
+	"BMC Super HiK 300-in-1\0"
+	"(C)NROM-based multicart (same as 058)\0"
+	"Sugar Softec (MMC3 clone)\0"
+	"Sugar Softec\0"
+	"Magic Floor\0"
+	"K\307\216sh\303\250ng A9461 (MMC3 clone)\0"
+	"Summer Carnival '92 - Recca\0"
+	"Naxat Soft\0"
+	"NTDEC N625092\0"
+	"CTC-31 (VRC2 + 74xx)\0"
+	"Jncota KT-008\0"
+	"Jncota\0"
+	"Active Enterprises\0"
+	"BMC 31-IN-1\0"
+	"Codemasters Quattro\0"
+	"Maxi 15 multicart\0"
+	"Golden Game 150-in-1 multicart\0"
+	"Realtec 8155\0"
+	"Realtec\0"
+	"Teletubbies 420-in-1 multicart\0"
+	"BNROM variant (similar to 034)\0"
+	"Unlicensed\0"
+	"Sachen SA-020A\0"
+	"F\304\223ngsh\303\251nb\307\216ng: F\303\272m\303\263 S\304\201n T\303\240iz\307\220 (C&E)\0"
+	"C&E\0"
+	"K\307\216sh\303\250ng SFC-02B/-03/-004 (MMC3 clone) (incorrect assignment; should be 115)\0"
+	"Nitra (MMC3 clone)\0"
+	"Nitra\0"
+	"Waixing - Sangokushi\0"
+	"Dragon Ball Z: Ky\305\215sh\305\253! Saiya-jin (VRC4 clone)\0"
+	"Pikachu Y2K of crypted ROMs\0"
+	"110-in-1 multicart (same as 225)\0"
+	"OneBus Famiclone\0"
+	"UNIF PEC-586\0"
+	"UNIF 158B\0"
+	"UNIF F-15 (MMC3 multicart)\0"
+	"HP10xx/HP20xx multicart\0"
+	"200-in-1 Elfland multicart\0"
+	"Street Heroes (MMC3 clone)\0"
+	"King of Fighters '97 (MMC3 clone)\0"
+	"Cony/Yoko Fighting Games\0"
+	"T-262 multicart\0"
+	"City Fighter IV\0"
+	"8-in-1 JY-119 multicart (MMC3 clone)\0"
+	"SMD132/SMD133 (MMC3 clone)\0"
+	"Multicart (MMC3 clone)\0"
+	"Game Prince RS-16\0"
+	"TXC 4-in-1 multicart (MGC-026)\0"
+	"Akumaj\305\215 Special: Boku Dracula-kun (bootleg)\0"
+	"Gremlins 2 (bootleg)\0"
+	"Cartridge Story multicart\0"
+	"RCM Group\0"
+	"J.Y. Company Super HiK 3/4/5-in-1 multicart\0"
+	"J.Y. Company multicart\0"
+	"Block Family 6-in-1/7-in-1 multicart\0"
+	"Drip\0"
+	"A65AS multicart\0"
+	"Benshieng multicart\0"
+	"Benshieng\0"
+	"4-in-1 multicart (411120-C, 811120-C)\0"
+	"GKCX1 21-in-1 multicart\0"
+	"BMC-60311C\0"
+	"Asder 20-in-1 multicart\0"
+	"Asder\0"
+	"K\307\216sh\303\250ng 2-in-1 multicart (MK6)\0"
+	"Dragon Fighter (unlicensed)\0"
+	"NewStar 12-in-1/76-in-1 multicart\0"
+	"T4A54A, WX-KB4K, BS-5652 (MMC3 clone) (same as 134)\0"
+	"J.Y. Company 13-in-1 multicart\0"
+	"FC Pocket RS-20 / dreamGEAR My Arcade Gamer V\0"
+	"TXC 01-22110-000 multicart\0"
+	"Lethal Weapon (unlicensed) (VRC4 clone)\0"
+	"TXC 6-in-1 multicart (MGC-023)\0"
+	"Golden 190-in-1 multicart\0"
+	"GG1 multicart\0"
+	"Gyruss (FDS conversion)\0"
+	"Almana no Kiseki (FDS conversion)\0"
+	"Dracula II: Noroi no F\305\253in (FDS conversion)\0"
+	"Exciting Basket (FDS conversion)\0"
+	"Metroid (FDS conversion)\0"
+	"Batman (Sunsoft) (bootleg) (VRC2 clone)\0"
+	"Ai Senshi Nicol (FDS conversion)\0"
+	"Monty no Doki Doki Daisass\305\215 (FDS conversion) (same as 125)\0"
+	"Highway Star (bootleg)\0"
+	"Reset-based multicart (MMC3)\0"
+	"Y2K multicart\0"
+	"820732C- or 830134C- multicart\0"
+	"HP-898F, KD-7/9-E multicart\0"
+	"Super HiK 6-in-1 A-030 multicart\0"
+	"35-in-1 (K-3033) multicart\0"
+	"Farid's homebrew 8-in-1 SLROM multicart\0"
+	"Farid's homebrew 8-in-1 UNROM multicart\0"
+	"Super Mali Splash Bomb (bootleg)\0"
+	"Contra/Gryzor (bootleg)\0"
+	"6-in-1 multicart\0"
+	"Test Ver. 1.01 Dlya Proverki TV Pristavok test cartridge\0"
+	"Education Computer 2000\0"
+	"Sangokushi II: Ha\305\215 no Tairiku (bootleg)\0"
+	"7-in-1 (NS03) multicart\0"
+	"Super 40-in-1 multicart\0"
+	"New Star Super 8-in-1 multicart\0"
+	"New Star\0"
+	"5/20-in-1 1993 Copyright multicart\0"
+	"10-in-1 multicart\0"
+	"11-in-1 multicart\0"
+	"12-in-1 Game Card multicart\0"
+	"16-in-1, 200/300/600/1000-in-1 multicart\0"
+	"21-in-1 multicart\0"
+	"Simple 4-in-1 multicart\0"
+	"COOLGIRL multicart (Homebrew)\0"
+	"Kuai Da Jin Ka Zhong Ji Tiao Zhan 3-in-1 multicart\0"
+	"New Star 6-in-1 Game Cartridge multicart\0"
+	"Zanac (FDS conversion)\0"
+	"Yume Koujou: Doki Doki Panic (FDS conversion)\0"
+	"830118C\0"
+	"1994 Super HIK 14-in-1 (G-136) multicart\0"
+	"Super 15-in-1 Game Card multicart\0"
+	"9-in-1 multicart\0"
+	"J.Y. Company / Techline\0"
+	"92 Super Mario Family multicart\0"
+	"250-in-1 multicart\0"
+	"\351\273\203\344\277\241\347\266\255 3D-BLOCK\0"
+	"7-in-1 Rockman (JY-208)\0"
+	"4-in-1 (4602) multicart\0"
+	"SB-5013 / GCL8050 / 841242C multicart\0"
+	"31-in-1 (3150) multicart\0"
+	"YY841101C multicart (MMC3 clone)\0"
+	"830506C multicart (VRC4f clone)\0"
+	"JY830832C multicart\0"
+	"Asder PC-95 educational computer\0"
+	"GN-45 multicart (MMC3 clone)\0"
+	"7-in-1 multicart\0"
+	"Super Mario Bros. 2 (J) (FDS conversion)\0"
+	"YUNG-08\0"
+	"N49C-300\0"
+	"F600\0"
+	"Spanish PEC-586 home computer cartridge\0"
+	"Dongda\0"
+	"Rockman 1-6 (SFC-12) multicart\0"
+	"Super 4-in-1 (SFC-13) multicart\0"
+	"Reset-based MMC1 multicart\0"
+	"135-in-1 (U)NROM multicart\0"
+	"YY841155C multicart\0"
+	"8-in-1 AxROM/UNROM multicart\0"
+	"35-in-1 NROM multicart\0"
+	"970630C\0"
+	"KN-42\0"
+	"830928C\0"
+	"YY840708C (MMC3 clone)\0"
+	"L1A16 (VRC4e clone)\0"
+	"NTDEC 2779\0"
+	"YY860729C\0"
+	"YY850735C / YY850817C\0"
+	"YY841145C / YY850835C\0"
+	"Caltron 9-in-1 multicart\0"
+	"Realtec 8031\0"
+	"NC7000M (MMC3 clone)\0"
+	"Zh\305\215nggu\303\263 D\303\240h\304\223ng\0"
+	"M\304\233i Sh\303\240on\307\232 M\303\250ng G\305\215ngch\307\216ng III\0"
+	"Subor Karaoke\0"
+	"Family Noraebang\0"
+	"Brilliant Com Cocoma Pack\0"
+	"EduBank\0"
+	"Kkachi-wa Nolae Chingu\0"
+	"Subor multicart\0"
+	"UNL-EH8813A\0"
+	"2-in-1 Datach multicart (VRC4e clone)\0"
+	"Korean Igo\0"
+	"F\305\253un Sh\305\215rinken (FDS conversion)\0"
+	"F\304\223ngsh\303\251nb\307\216ng: F\303\272m\303\263 S\304\201n T\303\240iz\307\220 (Jncota)\0"
+	"The Lord of King (Jaleco) (bootleg)\0"
+	"UNL-KS7021A (VRC2b clone)\0"
+	"Sangokushi: Ch\305\253gen no Hasha (bootleg)\0"
+	"Fud\305\215 My\305\215\305\215 Den (bootleg) (VRC2b clone)\0"
+	"1995 New Series Super 2-in-1 multicart\0"
+	"Datach Dragon Ball Z (bootleg) (VRC4e clone)\0"
+	"Super Mario Bros. Pocker Mali (VRC4f clone)\0"
+	"Sachen 3014\0"
+	"2-in-1 Sudoku/Gomoku (NJ064) (MMC3 clone)\0"
+	"Nazo no Murasamej\305\215 (FDS conversion)\0"
+	"Waixing FS303 (MMC3 clone) (same as 195)\0"
+	"60-1064-16L\0"
+	"Kid Icarus (FDS conversion)\0"
+	"Master Fighter VI' hack (variant of 359)\0"
+	"LittleCom 160-in-1 multicart\0"
+	"World Hero hack (VRC4 clone)\0"
+	"5-in-1 (CH-501) multicart (MMC1 clone)\0"
+	"Waixing FS306\0"
+	"Konami QTa adapter (VRC5)\0"
+	"CTC-15\0"
+	"Co Tung Co.\0"
+	"Jncota RPG re-release (variant of 178)\0"
+	"Taito X1-017 (correct PRG ROM bank ordering)\0"
+	"SUROM\0"
+	"SOROM\0"
+	"SXROM\0"
+	"SEROM, SHROM, SH1ROM\0"
+	"Bus conflicts are unspecified\0"
+	"Bus conflicts do not occur\0"
+	"Bus conflicts occur, resulting in: bus AND rom\0"
+	"MMC3C\0"
+	"MMC6\0"
+	"MMC3C with hard-wired mirroring\0"
+	"MC-ACC\0"
+	"MMC3A\0"
+	"LZ93D50 with 24C01\0"
+	"8 KiB of WRAM instead of serial EEPROM\0"
+	"FCG-1/2\0"
+	"LZ93D50 with optional 24C02\0"
+	"Expansion sound volume unspecified\0"
+	"Internal RAM battery-backed; no expansion sound\0"
+	"No expansion sound\0"
+	"N163 expansion sound: 11.0-13.0 dB louder than NES APU\0"
+	"N163 expansion sound: 16.0-17.0 dB louder than NES APU\0"
+	"N163 expansion sound: 18.0-19.5 dB louder than NES APU\0"
+	"VRC4a\0"
+	"VRC4c\0"
+	"VRC4f\0"
+	"VRC4e\0"
+	"VRC2b\0"
+	"VRC4b\0"
+	"VRC4d\0"
+	"VRC2c\0"
+	"Programmable mirroring\0"
+	"Fixed one-screen mirroring\0"
+	"NINA-001\0"
+	"BNROM\0"
+	"Dual Cartridge System (NTB-ROM)\0"
+	"Programmable one-screen mirroring (Fire Hawk)\0"
+	"Programmable one-screen mirroring (Uchuusen: Cosmo Carrier)\0"
+	"Fixed vertical mirroring + WRAM\0"
+	"Programmable H/V mirroring (Holy Diver)\0"
+	"1 KiB CHR-ROM banking, no WRAM\0"
+	"2 KiB CHR-ROM banking, no WRAM\0"
+	"1 KiB CHR-ROM banking, 32 KiB banked WRAM\0"
+	"MMC3 registers: 0,3,1,5,6,7,2,4\0"
+	"MMC3 registers: 0,2,5,3,6,1,7,4\0"
+	"Super Fighter III (PRG-ROM CRC32 0xC333F621)\0"
+	"Super Fighter III (PRG-ROM CRC32 0x2091BEB2)\0"
+	"Mortal Kombat III Special\0"
+	"1995 Super 2-in-1\0"
+	"Namcot 175 (fixed mirroring)\0"
+	"Namcot 340 (programmable mirroring)\0"
+	"UNL-8237\0"
+	"UNL-8237A\0"
+	"Aladdin Deck Enhancer\0"
+	"Waixing VT03\0"
+	"Power Joy Supermax\0"
+	"Zechess/Hummer Team\0"
+	"Sports Game 69-in-1\0"
+	"Waixing VT02\0"
+	"Karaoto\0"
+	"Jungletac\0"
+	"COOLBOY ($6000-$7FFF)\0"
+	"MINDKIDS ($5000-$5FFF)\0"
+	"Game size: 128 KiB PRG, 128 KiB CHR\0"
+	"Game size: 256 KiB PRG, 128 KiB CHR\0"
+	"Game size: 128 KiB PRG, 256 KiB CHR\0"
+	"Game size: 256 KiB PRG, 256 KiB CHR\0"
+	"Game size: 256 KiB PRG (first game); 128 KiB PRG (other games); 128 KiB CHR\0";
+
+/** mappers: Array table (553 entries) **/
+static const unsigned int mappers_count = 553;
+static const uint16_t mappers_name[553] = {
+	1, 15, 28, 34, 40, 67, 80, 108, 114, 141, 163, 176,
+	189, 206, 216, 242, 261, 274, 282, 298, 318, 338, 358, 364,
+	384, 390, 410, 416, 429, 448, 476, 495, 517, 533, 552, 568,
+	612, 637, 652, 676, 690, 724, 747, 762, 637, 794, 817, 637,
+	840, 637, 853, 0, 637, 0, 886, 913, 931, 968, 978, 1002,
+	1032, 1070, 1088, 1113, 1141, 1163, 1174, 1187, 1205, 1215, 1229, 1244,
+	1282, 1295, 1300, 1336, 1341, 1374, 1395, 1432, 1478, 1491, 1501, 1548,
+	1558, 1567, 1572, 1585, 1599, 1618, 1646, 1686, 1719, 1731, 1760, 1771,
+	1783, 1793, 0, 1805, 1824, 1851, 0, 1882, 1915, 1930, 1991, 2021,
+	0, 0, 0, 2046, 1599, 2100, 2121, 2154, 2204, 0, 2238, 2245,
+	0, 2251, 0, 2290, 0, 2319, 0, 0, 0, 0, 0, 0,
+	2380, 2402, 2421, 0, 2459, 2471, 2484, 2497, 2510, 2546, 2559, 2597,
+	2617, 2676, 2701, 2735, 2747, 2794, 2816, 2838, 2856, 2886, 2916, 2928,
+	2934, 2956, 2980, 2994, 0, 0, 0, 3020, 3028, 3049, 3093, 3117,
+	3135, 3173, 0, 3180, 3195, 3213, 968, 0, 3237, 676, 3286, 0,
+	3339, 3378, 3403, 3450, 3476, 3486, 3518, 3544, 3574, 3596, 3625, 3642,
+	3642, 3653, 3642, 3666, 3693, 3720, 3743, 3783, 968, 3827, 3846, 3865,
+	0, 637, 3883, 3918, 3935, 3979, 4010, 4026, 4068, 4091, 0, 4129,
+	0, 0, 4168, 4180, 4209, 4248, 4262, 0, 4283, 968, 968, 968,
+	4304, 4323, 968, 968, 4335, 968, 4355, 4373, 4404, 4425, 0, 0,
+	968, 4456, 4487, 4498, 0, 3642, 4513, 0, 4560, 0, 4638, 0,
+	4663, 4684, 4732, 4760, 4793, 4810, 4823, 4833, 4860, 4884, 4911, 4938,
+	4972, 4997, 5013, 5029, 5066, 5093, 5116, 5134, 5165, 5210, 5231, 0,
+	0, 0, 0, 0, 0, 5267, 5311, 5334, 5371, 5376, 5392, 5422,
+	5460, 5484, 5495, 5525, 5558, 5586, 5620, 5672, 5703, 5749, 5776, 5816,
+	5847, 5873, 5887, 5911, 747, 5945, 5989, 6022, 6047, 6087, 6120, 0,
+	6180, 6203, 6232, 6246, 0, 0, 0, 6277, 6305, 0, 6338, 6365,
+	6405, 6445, 6478, 6502, 6519, 6576, 6600, 6641, 6665, 6689, 6730, 6765,
+	6783, 6801, 6829, 6870, 3865, 6888, 6912, 0, 6942, 6993, 7034, 7057,
+	7103, 7111, 7152, 7186, 0, 7227, 7259, 7278, 7297, 7321, 5311, 7345,
+	7383, 7408, 7441, 5311, 7473, 7493, 7526, 7555, 7572, 7621, 7630, 7635,
+	7682, 7713, 7745, 7772, 7799, 7819, 7848, 7871, 7879, 7885, 7893, 7916,
+	7936, 7947, 7957, 7979, 8001, 8026, 8039, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 8060, 8080, 8116, 8130,
+	8147, 8181, 8204, 8220, 8232, 8270, 8281, 8315, 8361, 8397, 8423, 8462,
+	8503, 8542, 8587, 0, 0, 8631, 8643, 8685, 8722, 8722, 8763, 8775,
+	8803, 8844, 8873, 8902, 8941, 0, 0, 8955, 8981, 0, 0, 9000,
+	9039,
+};
+static const uint16_t mappers_manufacturer[553] = {
+	6, 6, 6, 6, 6, 6, 99, 6, 99, 6, 6, 176,
+	202, 6, 6, 0, 267, 202, 291, 312, 6, 351, 351, 351,
+	351, 351, 351, 0, 439, 459, 486, 439, 528, 546, 0, 599,
+	633, 6, 666, 0, 718, 739, 0, 0, 0, 0, 176, 6,
+	546, 0, 881, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 718, 1156, 528, 6, 1197, 1197, 1197, 267, 1270,
+	291, 351, 1328, 351, 312, 1389, 0, 1449, 546, 718, 546, 1548,
+	0, 351, 291, 0, 0, 1197, 599, 599, 291, 1197, 6, 312,
+	267, 528, 0, 6, 0, 1874, 0, 0, 0, 6, 0, 2034,
+	0, 0, 0, 2081, 0, 0, 0, 2194, 2231, 0, 6, 6,
+	0, 2194, 0, 2194, 0, 2365, 0, 0, 0, 0, 0, 0,
+	633, 2414, 0, 0, 2414, 2414, 2414, 2414, 291, 2414, 2590, 0,
+	2651, 2414, 0, 2414, 2778, 2414, 2414, 351, 2590, 267, 312, 6,
+	2943, 267, 1156, 267, 0, 0, 0, 3020, 1328, 0, 3111, 3111,
+	3157, 3173, 0, 2590, 0, 3228, 0, 0, 1328, 3268, 3286, 0,
+	3367, 3367, 0, 0, 1197, 0, 3528, 2194, 267, 0, 0, 0,
+	0, 718, 0, 1328, 0, 2194, 0, 1328, 0, 0, 0, 0,
+	0, 0, 6, 546, 0, 599, 312, 599, 0, 0, 0, 4155,
+	0, 0, 439, 2194, 4237, 718, 0, 0, 4297, 0, 0, 0,
+	4304, 0, 0, 0, 1270, 0, 0, 0, 4417, 0, 0, 0,
+	0, 0, 0, 2414, 0, 0, 4556, 0, 2194, 0, 4657, 0,
+	1328, 1328, 0, 0, 0, 0, 0, 0, 0, 0, 2414, 0,
+	1548, 0, 0, 599, 0, 0, 0, 633, 0, 0, 5257, 0,
+	0, 0, 0, 0, 0, 599, 599, 0, 439, 0, 5412, 0,
+	0, 0, 5519, 2194, 0, 0, 0, 599, 0, 633, 0, 633,
+	0, 0, 2590, 2590, 2365, 2590, 2590, 2590, 0, 2365, 2365, 0,
+	2590, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 6721, 0, 0,
+	0, 0, 0, 0, 0, 0, 439, 0, 0, 6721, 2590, 2590,
+	0, 0, 0, 7203, 0, 0, 0, 0, 599, 666, 599, 0,
+	666, 599, 599, 599, 599, 5519, 0, 0, 7613, 0, 0, 7675,
+	0, 0, 0, 0, 599, 0, 0, 0, 0, 0, 599, 0,
+	718, 599, 599, 599, 739, 4417, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 2414, 2414, 3111, 0,
+	8173, 0, 3111, 0, 0, 0, 2365, 4297, 0, 2590, 0, 0,
+	0, 0, 0, 0, 0, 2414, 0, 2365, 1328, 1328, 0, 0,
+	0, 0, 0, 0, 1328, 0, 0, 351, 8988, 0, 0, 4297,
+	546,
+};
+
+/** submappers: Perfect hash table (75 entries) **/
+static const uint32_t submappers_keys[75] = {
+	0x5301, 0x1302, 0x13902, 0x1005, 0x10C01, 0x301, 0xD701, 0x10004,
+	0x1000F, 0x1305, 0x13901, 0x10C00, 0x13903, 0x10002, 0x1003, 0x1502,
+	0x1501, 0x10005, 0x302, 0x2001, 0x4701, 0x402, 0x102, 0x2202,
+	0x1303, 0xD700, 0x101, 0x103, 0x105, 0x5300, 0xE801, 0x4E03,
+	0x10001, 0x400, 0x13904, 0x1301, 0x202, 0x1002, 0x700, 0xD202,
+	0x1004, 0x5302, 0x1701, 0x1901, 0xC503, 0x4E01, 0x1702, 0x200,
+	0x1001, 0x201, 0x403, 0x2201, 0x7201, 0x7200, 0x1300, 0xD201,
+	0x1304, 0x702, 0xC501, 0x701, 0x1000E, 0x1902, 0x2000, 0x1903,
+	0x10003, 0x404, 0x4E02, 0x104, 0x1703, 0xC500, 0xC502, 0x4401,
+	0x13900, 0x300, 0x401,
+};
+static const int16_t submappers_disp[75] = {
+	-75, 0, 0, -70, 1, 4, 0, -66, 0, 0, 0, 0,
+	-55, -54, 0, 2, 1, -53, 1, 1, 0, -50, -46, 0,
+	0, 0, -43, 0, 0, 1, -37, -34, 0, -30, -28, -25,
+	0, 3, 0, -24, 1, 0, 1, -22, 1, -18, 0, 3,
+	4, -15, 0, 0, 0, -14, 0, -12, 1, -11, 0, 2,
+	0, -9, 2, 0, 3, 3, -4, 0, 5, 0, 10, -3,
+	0, 7, 0,
+};
+static const uint16_t submappers_deprecated[75] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 153, 0, 0, 0, 0, 0, 0, 65535, 1, 0,
+	0, 0, 1, 155, 0, 0, 0, 0, 0, 0, 0, 19,
+	0, 157, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	159, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 65535, 1, 0, 0, 0, 0,
+	0, 0, 0,
+};
+static const uint16_t submappers_desc[75] = {
+	9998, 9460, 10595, 9349, 10500, 9153, 10343, 10427, 10468, 9589, 10559, 10478,
+	10631, 10388, 9302, 9650, 9644, 10447, 9180, 9715, 9789, 9238, 9090, 9751,
+	9479, 10334, 9084, 2928, 9102, 9967, 10353, 9927, 10375, 9227, 10667, 9412,
+	9180, 2956, 9123, 10298, 9341, 10029, 9656, 9674, 10251, 9835, 9662, 9123,
+	9283, 9153, 9270, 9742, 10103, 10071, 9377, 10269, 9534, 9180, 10180, 9153,
+	10460, 9680, 9692, 9686, 10407, 9277, 9895, 9096, 9668, 10135, 10225, 9757,
+	10523, 9123, 9233,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_NESMAPPERS_DATA_H__ */
@@ -0,0 +1,189 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * Nintendo3DSSysTitles_data.h: Generated lookup tables.                   *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: Nintendo3DSSysTitles_data.txt                                   *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_NINTENDO3DSSYSTITLES_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_NINTENDO3DSSYSTITLES_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace Nintendo3DSSysTitles_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (548 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"System Settings\0"
+	"Download Play\0"
+	"Activity Log\0"
+	"Health and Safety Information\0"
+	"Nintendo 3DS Camera\0"
+	"Nintendo 3DS Sound\0"
+	"Mii Maker\0"
+	"StreetPass Mii Plaza\0"
+	"eShop\0"
+	"System Transfer\0"
+	"Nintendo Zone\0"
+	"Face Raiders\0"
+	"AR Games\0"
+	"System Updater (SAFE_MODE)\0"
+	"Promotional Video (v1.1.0)\0"
+	"Nintendo Network ID Settings\0"
+	"microSD Management\0"
+	"HOME Menu\0"
+	"Camera\0"
+	"Instruction Manual\0"
+	"Game Notes\0"
+	"Internet Browser\0"
+	"Friend List\0"
+	"Notifications\0"
+	"Software Keyboard\0"
+	"Software Keyboard (SAFE_MODE)\0"
+	"Mii picker\0"
+	"Picture picker\0"
+	"Voice memo picker\0"
+	"eShop applet\0"
+	"Miiverse\0"
+	"Miiverse posting applet\0"
+	"amiibo Settings\0";
+
+/** sys_title_00040010: Perfect hash table (96 entries) **/
+static const uint32_t sys_title_00040010_keys[96] = {
+	0x21B00, 0x28F00, 0x21400, 0x20022300, 0x20020300, 0x20800, 0x22E00, 0x20700,
+	0x22400, 0x2BF00, 0x21E00, 0x22700, 0x20027D00, 0x20900, 0x28E00, 0x20022D00,
+	0x20100, 0x21700, 0x21100, 0x2C000, 0x27900, 0x22D00, 0x28D00, 0x22100,
+	0x26500, 0x21800, 0x20300, 0x21A00, 0x27E00, 0x21000, 0x27D00, 0x26300,
+	0x20D00, 0x28800, 0x20B00, 0x21500, 0x28100, 0x21D00, 0x20400, 0x27A00,
+	0x27800, 0x22500, 0x22B00, 0x20020D00, 0x20F00, 0x26E00, 0x28300, 0x22300,
+	0x23000, 0x26800, 0x28900, 0x27100, 0x28A00, 0x22200, 0x20023100, 0x27000,
+	0x20021D00, 0x20A00, 0x28700, 0x20025100, 0x20021300, 0x22F00, 0x26200, 0x28400,
+	0x21200, 0x20000, 0x27300, 0x27400, 0x27500, 0x28500, 0x26100, 0x25000,
+	0x26400, 0x22A00, 0x22900, 0x22000, 0x20200, 0x20024100, 0x28200, 0x26700,
+	0x26F00, 0x27700, 0x27F00, 0x20500, 0x21F00, 0x2C100, 0x22800, 0x24000,
+	0x21900, 0x21300, 0x26D00, 0x20027300, 0x26000, 0x28000, 0x20E00, 0x27200,
+};
+static const int16_t sys_title_00040010_disp[96] = {
+	0, 0, 0, 0, 1, 0, -95, -94, -90, 0, -83, -82,
+	-81, 0, -77, -76, 3, 0, 0, 0, -75, 0, -73, 0,
+	-69, -68, -65, 1, 1, 2, -64, 0, -63, -61, 0, 0,
+	1, -58, -56, 0, 1, -55, 1, 2, 0, 1, -52, -51,
+	-50, -47, 2, 0, 1, 0, -42, -39, 0, 1, -38, 0,
+	0, 1, 0, -37, 1, -36, 4, 13, -31, 0, 0, 0,
+	-30, 1, -26, 0, 1, 12, 0, 3, -25, 0, -22, 1,
+	0, 0, 0, 0, 0, 2, -10, 0, -9, 1, 5, -3,
+};
+static const uint8_t sys_title_00040010_region[96] = {
+	1, 5, 1, 2, 0, 0, 2, 0, 2, 0, 1, 2,
+	4, 0, 5, 2, 0, 1, 1, 1, 4, 2, 5, 2,
+	3, 1, 0, 1, 4, 1, 4, 3, 0, 5, 0, 1,
+	5, 1, 0, 4, 4, 2, 2, 0, 0, 3, 5, 2,
+	0, 3, 5, 4, 5, 2, 0, 4, 1, 0, 5, 2,
+	1, 2, 3, 5, 1, 0, 4, 4, 4, 5, 3, 2,
+	3, 2, 2, 2, 0, 1, 5, 3, 3, 4, 4, 0,
+	1, 2, 2, 1, 1, 1, 3, 4, 3, 5, 0, 4,
+};
+static const uint16_t sys_title_00040010_desc[96] = {
+	166, 202, 74, 44, 44, 123, 193, 113, 74, 256, 193, 113,
+	180, 144, 193, 180, 17, 113, 17, 256, 144, 180, 180, 17,
+	94, 123, 44, 150, 193, 1, 180, 44, 180, 123, 166, 94,
+	17, 180, 74, 150, 123, 94, 166, 180, 202, 193, 44, 44,
+	229, 123, 144, 17, 150, 31, 285, 1, 180, 150, 113, 285,
+	44, 202, 31, 74, 31, 1, 44, 74, 94, 94, 17, 229,
+	74, 150, 144, 1, 31, 285, 31, 113, 202, 113, 202, 94,
+	202, 256, 123, 229, 144, 44, 180, 44, 1, 1, 193, 31,
+};
+
+/** sys_title_00040030: Perfect hash table (96 entries) **/
+static const uint32_t sys_title_00040030_keys[96] = {
+	0xAD02, 0xA702, 0xD402, 0xA402, 0x9502, 0xC003, 0x20008802, 0xCB02,
+	0xE102, 0xDE03, 0xD802, 0x8F02, 0xAC02, 0x9802, 0x8602, 0xC402,
+	0x2000AE02, 0xAF02, 0xA502, 0xBD02, 0x9002, 0xB802, 0x20009D02, 0xD003,
+	0xD803, 0xD002, 0xC302, 0xCC02, 0x9F02, 0xB502, 0xBA02, 0x9702,
+	0x9202, 0xC902, 0x8B02, 0x9602, 0xAE02, 0x9D02, 0x20009402, 0xBC02,
+	0xC102, 0x2000C803, 0x9302, 0x9C02, 0x8202, 0xDF02, 0xC802, 0x8C02,
+	0xD602, 0xB002, 0xDC02, 0xE902, 0xE702, 0xC602, 0x8402, 0xE302,
+	0xBE02, 0xD902, 0xB102, 0xE402, 0xE403, 0x9E02, 0xE502, 0x8E02,
+	0xDE02, 0xC002, 0xE802, 0xAA02, 0xA202, 0xB902, 0xBF02, 0x8702,
+	0xB602, 0x8302, 0xD102, 0xC803, 0xCE02, 0xD302, 0xB202, 0xA802,
+	0x8802, 0xB402, 0x2000D003, 0x9402, 0xDB02, 0x9902, 0xA602, 0x2000C003,
+	0xA002, 0xA102, 0x8D02, 0xA902, 0xB702, 0x9B02, 0x2000DE03, 0xE202,
+};
+static const int16_t sys_title_00040030_disp[96] = {
+	0, 1, 1, 1, 2, 0, 2, 1, -96, 0, 0, -94,
+	-90, 0, 1, -89, -84, 1, 0, 0, 0, -82, -80, -78,
+	2, -77, 0, -76, -75, -66, -63, 1, 0, -58, 0, 0,
+	-56, 0, -55, -54, 0, 0, 0, -52, 0, 1, 1, -48,
+	-44, 3, -43, -42, 0, 0, 0, 0, -31, 0, 0, 2,
+	0, -30, 0, 0, 1, -27, -26, 0, -25, 3, -22, -21,
+	2, 1, -20, 4, 0, -19, 2, -18, 0, 0, 0, 2,
+	-14, 13, 0, 0, -9, -8, -3, 0, 2, 7, 0, -2,
+};
+static const uint8_t sys_title_00040030_region[96] = {
+	4, 3, 2, 3, 0, 0, 0, 1, 4, 4, 3, 1,
+	4, 2, 0, 0, 4, 4, 3, 1, 1, 5, 2, 2,
+	3, 2, 0, 1, 2, 5, 2, 1, 1, 1, 1, 1,
+	4, 2, 1, 0, 0, 1, 1, 2, 0, 4, 1, 4,
+	2, 4, 3, 5, 5, 0, 0, 4, 2, 3, 5, 5,
+	5, 1, 5, 0, 4, 0, 5, 4, 3, 2, 5, 0,
+	5, 0, 2, 1, 1, 2, 5, 3, 0, 5, 2, 1,
+	3, 2, 3, 0, 2, 3, 0, 4, 5, 2, 4, 4,
+};
+static const uint16_t sys_title_00040030_desc[96] = {
+	340, 368, 468, 321, 532, 412, 351, 453, 453, 412, 394, 304,
+	321, 304, 321, 468, 351, 368, 340, 499, 314, 380, 351, 412,
+	412, 394, 453, 468, 368, 340, 508, 380, 321, 442, 508, 368,
+	351, 351, 351, 499, 442, 412, 340, 340, 304, 442, 394, 532,
+	486, 380, 468, 486, 453, 486, 314, 486, 499, 442, 304, 394,
+	412, 532, 442, 380, 394, 394, 468, 314, 314, 532, 532, 340,
+	351, 508, 442, 412, 486, 453, 314, 380, 351, 321, 412, 351,
+	453, 314, 351, 412, 380, 304, 368, 304, 368, 321, 412, 468,
+};
+
+} }
+
+// Translatable strings. (for xgettext only)
+#if 0
+NOP_C_("Nintendo3DSSysTitles", "System Settings");
+NOP_C_("Nintendo3DSSysTitles", "Download Play");
+NOP_C_("Nintendo3DSSysTitles", "Activity Log");
+NOP_C_("Nintendo3DSSysTitles", "Health and Safety Information");
+NOP_C_("Nintendo3DSSysTitles", "Nintendo 3DS Camera");
+NOP_C_("Nintendo3DSSysTitles", "Nintendo 3DS Sound");
+NOP_C_("Nintendo3DSSysTitles", "Mii Maker");
+NOP_C_("Nintendo3DSSysTitles", "StreetPass Mii Plaza");
+NOP_C_("Nintendo3DSSysTitles", "eShop");
+NOP_C_("Nintendo3DSSysTitles", "System Transfer");
+NOP_C_("Nintendo3DSSysTitles", "Nintendo Zone");
+NOP_C_("Nintendo3DSSysTitles", "Face Raiders");
+NOP_C_("Nintendo3DSSysTitles", "AR Games");
+NOP_C_("Nintendo3DSSysTitles", "System Updater (SAFE_MODE)");
+NOP_C_("Nintendo3DSSysTitles", "Promotional Video (v1.1.0)");
+NOP_C_("Nintendo3DSSysTitles", "Nintendo Network ID Settings");
+NOP_C_("Nintendo3DSSysTitles", "microSD Management");
+NOP_C_("Nintendo3DSSysTitles", "HOME Menu");
+NOP_C_("Nintendo3DSSysTitles", "Camera");
+NOP_C_("Nintendo3DSSysTitles", "Instruction Manual");
+NOP_C_("Nintendo3DSSysTitles", "Game Notes");
+NOP_C_("Nintendo3DSSysTitles", "Internet Browser");
+NOP_C_("Nintendo3DSSysTitles", "Friend List");
+NOP_C_("Nintendo3DSSysTitles", "Notifications");
+NOP_C_("Nintendo3DSSysTitles", "Software Keyboard");
+NOP_C_("Nintendo3DSSysTitles", "Software Keyboard (SAFE_MODE)");
+NOP_C_("Nintendo3DSSysTitles", "Mii picker");
+NOP_C_("Nintendo3DSSysTitles", "Picture picker");
+NOP_C_("Nintendo3DSSysTitles", "Voice memo picker");
+NOP_C_("Nintendo3DSSysTitles", "eShop applet");
+NOP_C_("Nintendo3DSSysTitles", "Miiverse");
+NOP_C_("Nintendo3DSSysTitles", "Miiverse posting applet");
+NOP_C_("Nintendo3DSSysTitles", "amiibo Settings");
+#endif
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_NINTENDO3DSSYSTITLES_DATA_H__ */
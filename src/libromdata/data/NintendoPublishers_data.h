@@ -0,0 +1,616 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * NintendoPublishers_data.h: Generated lookup tables.                     *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: NintendoPublishers_data.txt                                     *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_NINTENDOPUBLISHERS_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_NINTENDOPUBLISHERS_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace NintendoPublishers_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (6160 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"<unlicensed>\0"
+	"Nintendo\0"
+	"Rocket Games / Ajinomoto\0"
+	"Imagineer-Zoom\0"
+	"Gray Matter\0"
+	"Zamuse\0"
+	"Falcom\0"
+	"Enix\0"
+	"Capcom\0"
+	"Hot B Co.\0"
+	"Jaleco\0"
+	"Coconuts Japan\0"
+	"Coconuts Japan / G.X.Media\0"
+	"Micronet\0"
+	"Technos\0"
+	"Mebio Software\0"
+	"Shouei System\0"
+	"Starfish\0"
+	"Mitsui Fudosan / Dentsu\0"
+	"Warashi Inc.\0"
+	"Nowpro\0"
+	"Game Village\0"
+	"IE Institute\0"
+	"Infocom\0"
+	"Electronic Arts Japan\0"
+	"Cobra Team\0"
+	"Human / Field\0"
+	"KOEI\0"
+	"Hudson Soft\0"
+	"S.C.P.\0"
+	"Yanoman\0"
+	"Tecmo Products\0"
+	"Japan Glary Business\0"
+	"Forum / OpenSystem\0"
+	"Virgin Games (Japan)\0"
+	"SMDE\0"
+	"Daikokudenki\0"
+	"Creatures Inc.\0"
+	"TDK Deep Impresion\0"
+	"Zoo\0"
+	"Sunsoft / Tokai Engineering\0"
+	"POW (Planning Office Wada) / VR1 Japan\0"
+	"Micro World\0"
+	"San-X\0"
+	"Loriciel / Electro Brain\0"
+	"Kemco Japan\0"
+	"Seta\0"
+	"Culture Brain\0"
+	"Palsoft\0"
+	"Visit Co.,Ltd.\0"
+	"Intec\0"
+	"System Sacom\0"
+	"Poppo\0"
+	"Ubisoft Japan\0"
+	"Media Works\0"
+	"NEC InterChannel\0"
+	"Tam\0"
+	"Jordan\0"
+	"Smilesoft / Rocket\0"
+	"Mediakite\0"
+	"Viacom\0"
+	"Carrozzeria\0"
+	"Dynamic\0"
+	"Magifact\0"
+	"Hect\0"
+	"Codemasters\0"
+	"Taito / GAGA Communications\0"
+	"Laguna\0"
+	"Telstar / Event / Taito\0"
+	"Soedesco\0"
+	"Arcade Zone Ltd\0"
+	"Entertainment International / Empire Software\0"
+	"Loriciel\0"
+	"Gremlin Graphics\0"
+	"K.Amusement Leasing Co.\0"
+	"Seika Corp.\0"
+	"Ubi Soft Entertainment\0"
+	"Sunsoft US\0"
+	"Life Fitness\0"
+	"System 3\0"
+	"Spectrum Holobyte\0"
+	"Irem\0"
+	"Gakken\0"
+	"Raya Systems\0"
+	"Renovation Products\0"
+	"Malibu Games\0"
+	"Eidos\0"
+	"Playmates Interactive\0"
+	"Fox Interactive\0"
+	"Time Warner Interactive\0"
+	"Disney Interactive\0"
+	"Black Pearl\0"
+	"Advanced Productions\0"
+	"GT Interactive\0"
+	"RARE\0"
+	"Crave Entertainment\0"
+	"Absolute Entertainment\0"
+	"Acclaim\0"
+	"Activision\0"
+	"American Sammy\0"
+	"Take 2 Interactive / GameTek\0"
+	"Hi Tech\0"
+	"LJN LTD.\0"
+	"Mattel\0"
+	"Mindscape / Red Orb Entertainment\0"
+	"Romstar\0"
+	"Taxan\0"
+	"Midway / Tradewest\0"
+	"American Softworks\0"
+	"Majesco Sales Inc\0"
+	"3DO\0"
+	"Hasbro\0"
+	"NewKidCo\0"
+	"Telegames\0"
+	"Metro3D\0"
+	"Vatical Entertainment\0"
+	"LEGO Media\0"
+	"Xicat Interactive\0"
+	"Cryo Interactive\0"
+	"Red Storm Entertainment\0"
+	"Microids\0"
+	"Data Design / Conspiracy / Swing\0"
+	"Titus\0"
+	"Virgin Interactive\0"
+	"Maxis\0"
+	"LucasArts Entertainment\0"
+	"Ocean\0"
+	"Bethesda Softworks\0"
+	"Electronic Arts\0"
+	"Laser Beam\0"
+	"Elite Systems\0"
+	"Electro Brain\0"
+	"The Learning Company\0"
+	"BBC\0"
+	"Software 2000\0"
+	"UFO Interactive Games\0"
+	"BAM! Entertainment\0"
+	"Studio 3\0"
+	"Classified Games\0"
+	"TDK Mediactive\0"
+	"DreamCatcher\0"
+	"JoWood Produtions\0"
+	"Sega\0"
+	"Wannado Edition\0"
+	"LSP (Light & Shadow Prod.)\0"
+	"ITE Media\0"
+	"Atari (Infogrames)\0"
+	"Interplay\0"
+	"JVC (US)\0"
+	"Parker Brothers\0"
+	"Sales Curve (Storm / SCI)\0"
+	"THQ\0"
+	"Accolade\0"
+	"Triffix Entertainment\0"
+	"Microprose Software\0"
+	"Sierra / Universal Interactive\0"
+	"Kemco\0"
+	"Rage Software\0"
+	"Encore\0"
+	"Kiddinx\0"
+	"Simon & Schuster Interactive\0"
+	"Asmik Ace Entertainment Inc.\0"
+	"Empire Interactive\0"
+	"Jester Interactive\0"
+	"Rockstar Games\0"
+	"Scholastic\0"
+	"Ignition Entertainment\0"
+	"Summitsoft\0"
+	"Stadlbauer\0"
+	"Misawa\0"
+	"Teichiku\0"
+	"Namco Ltd.\0"
+	"LOZC\0"
+	"Tokuma Shoten Intermedia\0"
+	"Tsukuda Original\0"
+	"DATAM-Polystar\0"
+	"BulletProof Software (BPS)\0"
+	"Vic Tokai Inc.\0"
+	"Character Soft\0"
+	"I'Max\0"
+	"Saurus\0"
+	"General Entertainment\0"
+	"Cyberfront Korea\0"
+	"Success\0"
+	"Sega Japan\0"
+	"Takara Amusement\0"
+	"Chun Soft\0"
+	"Video System /  Mc O' River\0"
+	"BEC\0"
+	"Varie\0"
+	"Yonezawa / S'pal\0"
+	"Kaneko\0"
+	"Marvelous Entertainment\0"
+	"Nichibutsu / Nihon Bussan\0"
+	"Tecmo\0"
+	"Imagineer\0"
+	"Nova\0"
+	"Take2 / Den'Z / Global Star\0"
+	"Bottom Up\0"
+	"TGL (Technical Group Laboratory)\0"
+	"Hasbro Japan\0"
+	"Keynet Inc.\0"
+	"Hands-On Entertainment\0"
+	"Telenet\0"
+	"Hori\0"
+	"Scorpion Soft\0"
+	"Konami\0"
+	"Kawada Co., Ltd.\0"
+	"Takara\0"
+	"Royal Industries\0"
+	"Technos Japan Corp.\0"
+	"JVC / Victor\0"
+	"Toei Animation\0"
+	"Toho\0"
+	"Namco\0"
+	"Media Rings Corporation\0"
+	"J-Wing\0"
+	"Pioneer LDC\0"
+	"KID\0"
+	"Mediafactory\0"
+	"Infogrames / Hudson\0"
+	"Kiratto. Ludic Inc\0"
+	"Yacht Club Games\0"
+	"Acclaim Japan\0"
+	"ASCII Corporation\0"
+	"Bandai\0"
+	"Soft Pro Inc.\0"
+	"HAL Laboratory\0"
+	"SNK\0"
+	"Pony Canyon\0"
+	"Sunsoft\0"
+	"Toshiba EMI\0"
+	"Sony Imagesoft\0"
+	"Sammy\0"
+	"Magical\0"
+	"Visco\0"
+	"Compile\0"
+	"MTO Inc.\0"
+	"Sunrise Interactive\0"
+	"Global A Entertainment\0"
+	"Fuuki\0"
+	"Taito\0"
+	"Sunsoft / Ask Co., Ltd.\0"
+	"Square\0"
+	"Tokuma Shoten\0"
+	"Data East\0"
+	"Tonkin House / Tokyo Shoseki\0"
+	"East Cube\0"
+	"Koei\0"
+	"Konami / Ultra / Palcom\0"
+	"NTVIC / VAP\0"
+	"Use Co., Ltd.\0"
+	"Meldac\0"
+	"Pony Canyon / FCI\0"
+	"Angel / Sotsu Agency / Sunrise\0"
+	"Yumedia / Aroma Co., Ltd\0"
+	"Boss\0"
+	"Axela / Crea-Tech\0"
+	"Sekaibunka-Sha / Sumire Kobo / Marigul Management Inc.\0"
+	"Konami Computer Entertainment Osaka\0"
+	"NEC Interchannel\0"
+	"Enterbrain\0"
+	"From Software\0"
+	"Taito / Disco\0"
+	"Sofel\0"
+	"Quest / Bothtec\0"
+	"Sigma\0"
+	"Ask Kodansha\0"
+	"Naxat\0"
+	"Copya System\0"
+	"Capcom Co., Ltd.\0"
+	"Banpresto\0"
+	"Tomy\0"
+	"LJN Japan\0"
+	"NCS\0"
+	"Human Entertainment\0"
+	"Altron\0"
+	"Gaps Inc.\0"
+	"Elf\0"
+	"Compile Heart\0"
+	"FarSight Studios\0"
+	"Yutaka\0"
+	"T&ESoft\0"
+	"Epoch\0"
+	"Athena\0"
+	"Asmik\0"
+	"Natsume\0"
+	"King Records\0"
+	"Atlus\0"
+	"Epic / Sony Records\0"
+	"IGS (Information Global Service)\0"
+	"Chatnoir\0"
+	"Right Stuff\0"
+	"Spike\0"
+	"Konami Computer Entertainment Tokyo\0"
+	"Alphadream Corporation\0"
+	"Sting\0"
+	"Star-Fish\0"
+	"A Wave\0"
+	"Motown Software\0"
+	"Left Field Entertainment\0"
+	"Extreme Ent. Grp.\0"
+	"TecMagik\0"
+	"Cybersoft\0"
+	"Psygnosis\0"
+	"Davidson / Western Tech.\0"
+	"The Game Factory\0"
+	"Hip Games\0"
+	"Aspyr\0"
+	"Mastiff\0"
+	"iQue\0"
+	"Digital Tainment Pool\0"
+	"XS Games / Jack Of All Games\0"
+	"Daewon Media\0"
+	"Alpha Unit\0"
+	"PCCW Japan\0"
+	"Yuke's Media Creations\0"
+	"KiKi Co Ltd\0"
+	"Open Sesame Inc\0"
+	"Sims\0"
+	"Broccoli\0"
+	"Avex\0"
+	"D3 Publisher\0"
+	"Konami Computer Entertainment Japan\0"
+	"Square-Enix\0"
+	"KSG\0"
+	"Micott & Basara Inc.\0"
+	"O3 Entertainment\0"
+	"Orbital Media\0"
+	"Detn8 Games\0"
+	"Gameloft / Ubi Soft\0"
+	"Gamecock Media Group\0"
+	"Oxygen Games\0"
+	"505 Games\0"
+	"Treasure\0"
+	"Aruze\0"
+	"Ertain\0"
+	"SNK Playmore\0"
+	"Level-5\0"
+	"Genius Products\0"
+	"Reef Entertainment\0"
+	"Nordcurrent\0"
+	"Yojigen\0"
+	"AQ Interactive\0"
+	"Arc System Works\0"
+	"Deep Silver\0"
+	"Atari\0"
+	"Nihon System\0"
+	"NIS America\0"
+	"Purple Hills\0"
+	"Trend Verlag / East Entertainment\0"
+	"Legacy Interactive\0"
+	"SilverStar Games\0"
+	"Mumbo Jumbo\0"
+	"Mindscape\0"
+	"Milestone / UFO Interactive\0"
+	"Blast !\0"
+	"Terabox\0"
+	"Nordic Games\0"
+	"Neko Entertainment / Diffusion / Naps team\0"
+	"Nobilis\0"
+	"Namco Bandai\0"
+	"Data Design / Destineer Studios\0"
+	"Phoenix Games\0"
+	"Playlogic\0"
+	"Rondomedia\0"
+	"Warner Bros. Interactive Entertainment Inc.\0"
+	"RTL Games\0"
+	"RealNetworks\0"
+	"Southpeak Interactive\0"
+	"Blade Interactive Studios\0"
+	"SevenGames\0"
+	"Storm City\0"
+	"Tasuke / Works\0"
+	"Tivola\0"
+	"Metro 3D / Data Design\0"
+	"Valcon Games\0"
+	"Virgin Play\0"
+	"Little Orbit\0"
+	"Xseed Games\0"
+	"Aksys Games\0"
+	"Fun Box Media\0"
+	"O2 Games\0"
+	"Bergsala Lightweight\0"
+	"Barunson Creative\0"
+	"Ntreev Soft\0"
+	"WBA Interactive\0"
+	"Internal Engine\0"
+	"Zinkia\0"
+	"Judo Baby\0"
+	"Topware Interactive\0"
+	"<\351\235\236\345\205\254\350\252\215>\0"
+	"\344\273\273\345\244\251\345\240\202\0"
+	"\343\202\253\343\203\227\343\202\263\343\203\263\0"
+	"\343\202\270\343\203\243\343\203\254\343\202\263\0"
+	"\343\203\217\343\203\211\343\202\275\343\203\263\0"
+	"\343\202\242\343\202\244\343\203\254\343\203\240\0"
+	"\345\255\246\347\277\222\347\240\224\347\251\266\347\244\276\0"
+	"BPS\0"
+	"Pack-In-Video\0"
+	"\343\203\221\343\203\203\343\202\257\343\202\244\343\203\263\343\203\223\343\203\207\343\202\252\0"
+	"\343\203\206\343\202\257\343\203\242\0"
+	"\343\202\244\343\203\236\343\202\270\343\203\213\343\202\242\0"
+	"\343\202\271\343\202\263\343\203\274\343\203\224\343\202\252\343\203\263\343\202\275\343\203\225\343\203\210\0"
+	"\343\202\263\343\203\212\343\203\237\0"
+	"\346\262\263\347\224\260\0"
+	"\343\202\277\343\202\253\343\203\251\0"
+	"\343\203\255\343\202\244\343\203\244\343\203\253\345\267\245\346\245\255\0"
+	"\346\235\261\346\230\240\345\213\225\347\224\273\0"
+	"\343\203\212\343\203\240\343\202\263\0"
+	"\343\202\242\343\202\271\343\202\255\343\203\274\0"
+	"\343\203\220\343\203\263\343\203\200\343\202\244\0"
+	"\343\202\275\343\203\225\343\203\210\343\203\227\343\203\255\0"
+	"HAL\347\240\224\347\251\266\346\211\200\0"
+	"\343\202\265\343\203\263\343\202\275\343\203\225\343\203\210\0"
+	"\346\235\261\350\212\235EMI\0"
+	"\343\202\277\343\202\244\343\203\210\343\203\274\0"
+	"\343\202\265\343\203\263\343\202\275\343\203\225\343\203\210 \343\202\242\343\202\271\343\202\257\350\254\233\350\253\207\347\244\276\0"
+	"\343\202\261\343\203\240\343\202\263\0"
+	"\343\202\271\343\202\257\343\202\246\343\202\247\343\202\242\0"
+	"\345\276\263\351\226\223\346\233\270\345\272\227\0"
+	"\343\203\207\343\203\274\343\202\277\343\202\244\343\203\274\343\202\271\343\203\210\0"
+	"\343\203\210\343\203\263\343\202\255\343\203\263\343\203\217\343\202\246\343\202\271\0"
+	"\343\202\244\343\203\274\343\202\271\343\203\210\343\202\255\343\203\245\343\203\274\343\203\226\0"
+	"\343\203\220\343\203\203\343\203\227\0"
+	"\343\203\246\343\203\274\343\202\271\0"
+	"\343\203\235\343\203\213\343\203\274\343\202\255\343\203\243\343\203\213\343\202\252\343\203\263\0"
+	"\343\202\275\343\203\225\343\202\250\343\203\253\0"
+	"Bothtec, Inc.\0"
+	"\343\203\234\343\203\274\343\202\271\343\203\206\343\203\203\343\202\257\0"
+	"Hiro Co., Ltd.\0"
+	"\343\203\222\343\203\255\0"
+	"\343\202\242\343\203\206\343\203\212\0"
+	"\343\202\242\343\203\210\343\203\251\343\202\271\0";
+
+/** thirdParty: Perfect hash table (408 entries) **/
+static const uint16_t thirdParty_keys[408] = {
+	0x3443, 0x345A, 0x434C, 0x424C, 0x4431, 0x4548, 0x4351, 0x565A,
+	0x3646, 0x3251, 0x3442, 0x3933, 0x4B50, 0x4534, 0x4233, 0x3330,
+	0x5047, 0x4734, 0x3037, 0x3741, 0x3733, 0x4652, 0x4B42, 0x3843,
+	0x3739, 0x4532, 0x3447, 0x3630, 0x3639, 0x4243, 0x4332, 0x3332,
+	0x364B, 0x4430, 0x374B, 0x3458, 0x3542, 0x4130, 0x3151, 0x3036,
+	0x3139, 0x3756, 0x374A, 0x3035, 0x3241, 0x4334, 0x3845, 0x4D4A,
+	0x3233, 0x3655, 0x3748, 0x4639, 0x3935, 0x3459, 0x3334, 0x524D,
+	0x4E39, 0x474E, 0x3653, 0x354D, 0x3136, 0x4738, 0x374E, 0x4739,
+	0x3230, 0x434A, 0x3648, 0x4737, 0x3647, 0x4439, 0x3832, 0x4132,
+	0x3943, 0x3651, 0x3642, 0x3141, 0x3338, 0x4346, 0x4E50, 0x4834,
+	0x3657, 0x3830, 0x3544, 0x4547, 0x3656, 0x354E, 0x4137, 0x3132,
+	0x3533, 0x3146, 0x5254, 0x4331, 0x4338, 0x484A, 0x3553, 0x4B4D,
+	0x4630, 0x3850, 0x4345, 0x454E, 0x3044, 0x5456, 0x384A, 0x4230,
+	0x3757, 0x4234, 0x3543, 0x324A, 0x3039, 0x4337, 0x4B36, 0x344A,
+	0x4144, 0x4330, 0x3531, 0x4451, 0x4731, 0x3837, 0x3659, 0x4A39,
+	0x434B, 0x3541, 0x464D, 0x4237, 0x424A, 0x3730, 0x5A48, 0x4442,
+	0x4747, 0x4742, 0x4542, 0x4539, 0x3239, 0x3753, 0x3836, 0x3143,
+	0x3738, 0x5253, 0x564E, 0x3339, 0x4C48, 0x304C, 0x3137, 0x3048,
+	0x3050, 0x3344, 0x4236, 0x4342, 0x4438, 0x304E, 0x4D45, 0x4651,
+	0x3346, 0x4239, 0x4141, 0x4859, 0x3558, 0x304A, 0x4633, 0x474A,
+	0x3557, 0x3145, 0x4247, 0x5335, 0x3451, 0x4832, 0x4642, 0x3238,
+	0x4550, 0x314A, 0x4242, 0x3634, 0x3838, 0x3038, 0x3536, 0x4147,
+	0x3453, 0x3632, 0x444E, 0x5257, 0x4553, 0x4645, 0x5A41, 0x3637,
+	0x3133, 0x4533, 0x3231, 0x5954, 0x3942, 0x4735, 0x4650, 0x4948,
+	0x3930, 0x434D, 0x3546, 0x3235, 0x5A31, 0x4150, 0x4333, 0x3948,
+	0x3436, 0x4446, 0x4434, 0x5A58, 0x4631, 0x3941, 0x4E47, 0x4A57,
+	0x3434, 0x4136, 0x4244, 0x4143, 0x4246, 0x3331, 0x4C54, 0x3444,
+	0x544B, 0x4E52, 0x364A, 0x4653, 0x3047, 0x355A, 0x3547, 0x4537,
+	0x4159, 0x4433, 0x4E4B, 0x4341, 0x3932, 0x3343, 0x4545, 0x3135,
+	0x4754, 0x3150, 0x4730, 0x3431, 0x3946, 0x384E, 0x5350, 0x3951,
+	0x384D, 0x5946, 0x3437, 0x4437, 0x3532, 0x374C, 0x4241, 0x4248,
+	0x4138, 0x3144, 0x3232, 0x4543, 0x344B, 0x4250, 0x4131, 0x3046,
+	0x434E, 0x4833, 0x4D54, 0x4146, 0x5752, 0x3034, 0x354C, 0x3950,
+	0x4148, 0x3236, 0x3246, 0x414C, 0x4736, 0x464C, 0x414B, 0x4A4A,
+	0x3937, 0x3842, 0x3530, 0x4432, 0x5A57, 0x4135, 0x4746, 0x504C,
+	0x3538, 0x3342, 0x4134, 0x4759, 0x4A46, 0x4251, 0x3441, 0x464B,
+	0x3032, 0x4538, 0x4343, 0x3834, 0x3751, 0x354B, 0x4232, 0x4535,
+	0x3755, 0x3746, 0x394E, 0x474D, 0x3439, 0x424E, 0x4632, 0x4347,
+	0x4445, 0x3045, 0x3550, 0x3833, 0x5650, 0x3535, 0x4744, 0x4654,
+	0x4831, 0x4E53, 0x364D, 0x3731, 0x4E51, 0x3645, 0x4D52, 0x3847,
+	0x4748, 0x3051, 0x3947, 0x4350, 0x4447, 0x5A34, 0x3336, 0x365A,
+	0x3033, 0x4448, 0x4530, 0x3042, 0x535A, 0x5854, 0x4436, 0x3931,
+	0x3432, 0x3658, 0x364C, 0x4336, 0x3631, 0x454C, 0x4335, 0x3345,
+	0x4231, 0x3754, 0x4444, 0x3430, 0x3747, 0x4541, 0x3237, 0x3743,
+	0x4634, 0x5547, 0x584A, 0x3041, 0x3939, 0x4D53, 0x0, 0x3534,
+	0x4732, 0x3732, 0x3455, 0x3936, 0x374D, 0x454D, 0x324E, 0x5356,
+	0x3043, 0x324D, 0x394A, 0x3247, 0x4745, 0x324B, 0x594D, 0x3341,
+	0x3138, 0x4441, 0x4139, 0x3846, 0x3244, 0x4456, 0x3031, 0x3446,
+	0x3243, 0x4344, 0x3337, 0x3147, 0x3554, 0x3335, 0x3548, 0x4846,
+	0x5853, 0x3638, 0x474C, 0x394C, 0x3735, 0x4151, 0x3551, 0x485A,
+	0x5A53, 0x414A, 0x3030, 0x3248, 0x3744, 0x3245, 0x3831, 0x324C,
+};
+static const int16_t thirdParty_disp[408] = {
+	1, -406, 1, 0, 1, -404, 0, 2, -403, -399, 0, 0,
+	-397, -393, 0, -392, -390, 1, 3, -382, 0, 0, 0, 0,
+	0, 2, 4, -380, 0, 1, -378, -374, -373, 0, -372, -371,
+	-364, -362, -361, 1, -360, -353, -352, -351, 1, 0, 1, 1,
+	0, 0, -350, 1, 0, -347, 1, -341, 4, 1, 1, 1,
+	-339, 0, 0, -338, -333, -331, -330, -327, 2, 0, 0, 7,
+	1, 0, -316, -312, 2, 0, -311, 0, 0, 0, 0, 0,
+	2, 3, 0, 0, 5, 0, 0, -310, 2, 0, 0, 6,
+	-308, -304, -303, -301, 1, -300, 2, 0, -296, -295, 2, 4,
+	2, -292, 0, 5, 2, 0, -291, -290, -288, 2, 1, 1,
+	2, -286, -277, -276, 0, -273, -272, -268, -267, -264, 0, 2,
+	-261, 0, 1, -256, 1, 2, 0, -254, -253, 0, 2, 2,
+	-252, 0, -251, 0, -250, -247, 0, -242, 0, -238, 2, -237,
+	3, -236, 0, -233, 6, 0, 0, -231, 0, 3, -224, 1,
+	2, 1, -222, -221, 2, -218, 0, -215, 0, -214, -213, 2,
+	-208, -207, 0, 0, -206, 3, 2, 0, -205, 0, -199, -195,
+	0, -193, 0, 0, 0, 0, -192, 1, -191, -188, 0, 0,
+	17, 0, -186, -185, 0, -183, 0, -180, -176, -175, 2, 15,
+	0, 4, 0, 0, 0, 0, 0, 1, 2, 0, -170, -165,
+	2, -164, 26, -160, 1, 0, 2, 0, 0, 0, -156, -153,
+	-148, -146, 0, 9, 4, 3, -143, 0, -137, 0, -136, -135,
+	-131, -129, 0, 0, 0, -127, 1, 2, 0, 0, -125, 1,
+	-116, 0, 0, -113, 0, -112, 6, 0, 1, 0, 0, 0,
+	6, 9, 0, 0, 9, 0, 1, 0, 1, 0, 0, 0,
+	2, 0, -110, -107, -103, 0, -100, 0, 0, 1, 1, 0,
+	0, 0, 1, -99, 0, -97, 0, -95, 9, 0, -94, 0,
+	5, 0, 0, -93, 1, 0, -85, 0, -84, 4, 0, -83,
+	-82, 0, 0, 10, 1, 0, -76, -75, -74, 2, -73, -71,
+	-70, 0, 6, 0, -67, 4, 0, 1, 0, 0, 1, -61,
+	0, -59, 1, -55, 0, 0, 2, 0, -52, 0, 0, 0,
+	9, 11, -51, -49, 1, 0, 9, -47, 0, -45, -43, -42,
+	0, 0, 0, 1, 2, -35, 0, 0, -32, 0, -31, 0,
+	-27, 5, 0, 0, 4, 0, 0, -22, 0, 0, 0, 0,
+	0, 1, 0, -19, -13, -7, 0, -3, -2, -1, 0, 0,
+};
+static const uint16_t thirdParty_publisher[408] = {
+	1120, 1293, 3622, 3305, 3769, 4070, 3741, 5351, 1820, 766, 1107, 2684,
+	4851, 3954, 3197, 776, 5109, 4438, 89, 2137, 2082, 4329, 4839, 2528,
+	2128, 3947, 1159, 1699, 1779, 3250, 2210, 795, 1873, 3755, 2237, 1273,
+	1457, 2908, 481, 82, 357, 2390, 500, 75, 631, 3400, 2543, 4934,
+	571, 1955, 2230, 4238, 2688, 1288, 803, 5133, 4992, 4655, 1940, 1547,
+	326, 4480, 2303, 4485, 500, 3599, 1855, 4471, 1834, 3846, 2428, 2921,
+	2774, 1923, 1795, 364, 857, 3543, 5056, 4700, 1986, 2412, 1471, 4061,
+	1968, 1557, 2959, 285, 1355, 427, 5188, 3369, 3463, 4721, 1598, 4808,
+	4163, 2618, 3525, 4124, 160, 5296, 2571, 3158, 2401, 89, 1465, 707,
+	101, 3453, 4826, 1181, 3031, 3363, 1336, 3916, 4404, 2469, 2007, 4776,
+	3604, 1423, 4310, 3226, 3297, 2044, 5478, 3861, 4571, 4498, 4002, 3981,
+	626, 2341, 2444, 372, 2124, 5144, 5326, 864, 4864, 239, 340, 206,
+	259, 959, 3211, 3492, 3829, 252, 4917, 4324, 985, 3230, 3003, 4737,
+	1657, 215, 4211, 4602, 1633, 408, 3283, 5211, 1221, 4687, 4248, 614,
+	4147, 453, 3242, 1730, 2486, 94, 1407, 3042, 1240, 1724, 3912, 5198,
+	4153, 4258, 5462, 1754, 293, 2688, 504, 5326, 2768, 4450, 4316, 4768,
+	2629, 3677, 1490, 583, 5432, 3102, 3393, 2817, 1068, 3895, 3797, 5511,
+	4170, 2742, 5000, 4820, 1055, 2942, 3262, 3016, 3277, 783, 4898, 1140,
+	5281, 5077, 1859, 4351, 192, 1666, 1509, 3968, 3141, 3791, 5013, 3468,
+	2656, 913, 4028, 315, 4668, 466, 4393, 1021, 2784, 2610, 5233, 2885,
+	2593, 5402, 1077, 3816, 1344, 2245, 631, 3291, 2966, 387, 532, 4008,
+	1197, 3334, 2916, 177, 3713, 4693, 4984, 3036, 5144, 63, 1538, 2873,
+	3066, 89, 674, 3089, 4466, 4300, 3085, 4808, 2711, 2501, 1313, 3775,
+	5501, 985, 4550, 5123, 1416, 897, 2935, 4283, 4791, 3357, 1100, 4283,
+	23, 3975, 3504, 340, 2322, 1531, 3190, 3962, 2367, 2210, 2718, 4634,
+	1095, 3314, 4186, 3574, 3875, 169, 1565, 2439, 5339, 1399, 4534, 4380,
+	4678, 4839, 1914, 2063, 5064, 1806, 4946, 2564, 4588, 272, 2789, 3730,
+	111, 5450, 817, 2034, 48, 3902, 111, 118, 5270, 5388, 3810, 2646,
+	1044, 1991, 1895, 3424, 1705, 4082, 3414, 968, 3172, 2356, 3871, 1009,
+	2216, 3989, 589, 2159, 4229, 5303, 5364, 111, 2718, 4956, 1, 1370,
+	4415, 2073, 1252, 2694, 2274, 4088, 747, 5259, 133, 740, 2827, 687,
+	4546, 719, 5411, 888, 345, 3856, 2983, 2558, 653, 3930, 14, 1153,
+	645, 3518, 829, 448, 1616, 812, 1527, 4713, 5376, 1760, 4614, 2860,
+	2098, 3122, 1587, 4756, 5494, 3073, 1, 693, 2179, 668, 2419, 736,
+};
+
+/** thirdParty_fds: Perfect hash table (41 entries) **/
+static const uint8_t thirdParty_fds_keys[41] = {
+	0xD1, 0xB2, 0xA, 0xA6, 0xB1, 0xE7, 0xC6, 0xC1,
+	0xCB, 0xBB, 0x18, 0xC2, 0xAF, 0xC0, 0x4A, 0xAC,
+	0xC4, 0xBC, 0xD2, 0x0, 0xC5, 0x99, 0xC3, 0x9C,
+	0xCC, 0x8B, 0xA2, 0xDB, 0xB6, 0x9B, 0xC7, 0x1,
+	0xA4, 0xCA, 0xA7, 0xCE, 0x49, 0xA8, 0x8, 0xEB,
+	0xB3,
+};
+static const int16_t thirdParty_fds_disp[41] = {
+	1, -38, -36, 1, -35, 0, 0, -31, 0, 0, 0, 1,
+	-30, 0, -23, -21, -17, 1, -14, 1, 0, 0, 1, 0,
+	-12, 0, 1, 4, -11, -10, 0, -9, -6, 0, 0, -2,
+	0, 1, 6, -1, 4,
+};
+static const uint16_t thirdParty_fds_publisher_en[41] = {
+	3769, 3190, 111, 2942, 3172, 3968, 3424, 3369, 3492, 3242, 345, 2210,
+	3036, 3363, 1100, 3016, 3400, 3250, 6082, 1, 3414, 5625, 3393, 2774,
+	3504, 2501, 2921, 6115, 3211, 2768, 3453, 14, 2935, 3468, 2959, 3525,
+	1095, 2966, 94, 4002, 3197,
+};
+static const uint16_t thirdParty_fds_publisher_jp[41] = {
+	6069, 5800, 5566, 5728, 5787, 6137, 5977, 5881, 6024, 5842, 5579, 5916,
+	5777, 5868, 5605, 5764, 5942, 5858, 6096, 5531, 5955, 5639, 5926, 5674,
+	6034, 5621, 5690, 6130, 5829, 5664, 5999, 5543, 5718, 5718, 5735, 6044,
+	5592, 5745, 5553, 6147, 5813,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_NINTENDOPUBLISHERS_DATA_H__ */
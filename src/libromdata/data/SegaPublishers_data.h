@@ -0,0 +1,482 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * SegaPublishers_data.h: Generated lookup tables.                         *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: SegaPublishers_data.txt                                         *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_SEGAPUBLISHERS_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_SEGAPUBLISHERS_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace SegaPublishers_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (4927 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"Sega\0"
+	"Taito\0"
+	"Capcom\0"
+	"Data East\0"
+	"Namco (Namcot)\0"
+	"Sun Electronics (Sunsoft)\0"
+	"Ma-Ba\0"
+	"Dempa\0"
+	"Tecno Soft\0"
+	"Asmik\0"
+	"ASCII\0"
+	"Micronet\0"
+	"VIC Tokai\0"
+	"Treco, Sammy\0"
+	"Nippon Computer Systems (Masaya)\0"
+	"Sigma Enterprises\0"
+	"Toho\0"
+	"HOT-B\0"
+	"Kyugo\0"
+	"Video System\0"
+	"SNK\0"
+	"Wolf Team\0"
+	"Kaneko\0"
+	"DreamWorks\0"
+	"Seismic Software\0"
+	"Tecmo\0"
+	"Mediagenic\0"
+	"Toaplan\0"
+	"UNIPACC\0"
+	"UPL\0"
+	"Human\0"
+	"Sanritsu (SIMS)\0"
+	"Game Arts\0"
+	"Kodansha Research Institute\0"
+	"Sage's Creation\0"
+	"Tengen (Time Warner Interactive)\0"
+	"Telenet Japan, Micro World\0"
+	"Electronic Arts\0"
+	"Microcabin\0"
+	"SystemSoft (SystemSoft Alpha)\0"
+	"Riverhillsoft\0"
+	"Face\0"
+	"Nuvision Entertainment\0"
+	"Razorsoft\0"
+	"Jaleco\0"
+	"Visco\0"
+	"Victor Musical Industries (Victor Entertainment, Victor Soft)\0"
+	"Toyo Recording Co. (Wonder Amusement Studio)\0"
+	"Sony Imagesoft\0"
+	"Toshiba EMI\0"
+	"Information Global Service\0"
+	"Tsukuda Ideal\0"
+	"Compile\0"
+	"Home Data (Magical)\0"
+	"CSK Research Institute (CRI)\0"
+	"Arena Entertainment\0"
+	"Virgin Interactive\0"
+	"Nihon Bussan (Nichibutsu)\0"
+	"Varie\0"
+	"Coconuts Japan, Soft Vision\0"
+	"PALSOFT\0"
+	"Pony Canyon\0"
+	"Koei\0"
+	"Takeru (Sur De Wave)\0"
+	"U.S. Gold\0"
+	"Acclaim Entertainment, Flying Edge\0"
+	"GameTek\0"
+	"Datawest\0"
+	"PCM Complete\0"
+	"Absolute Entertainment\0"
+	"Mindscape (The Software Toolworks)\0"
+	"Domark\0"
+	"Parker Brothers\0"
+	"Pack-In Video (Victor Interactive Software, Pack-In-Soft, Victor Soft)\0"
+	"Polydor (Sandstorm)\0"
+	"Sony\0"
+	"Konami\0"
+	"Tradewest, Williams Entertainment, Midway Games\0"
+	"Success\0"
+	"THQ, Black Pearl Software)\0"
+	"TecMagik Entertainment\0"
+	"Samsung\0"
+	"Takara\0"
+	"Shogakukan Production\0"
+	"Electronic Arts Victor\0"
+	"Electro Brain\0"
+	"Saddleback Graphics\0"
+	"Dynamix (Simon & Schuster Interactive)\0"
+	"American Laser Games\0"
+	"Hi-Tech Expressions\0"
+	"Psygnosis\0"
+	"T&E Soft\0"
+	"Core Design\0"
+	"The Learning Company\0"
+	"Accolade\0"
+	"Codemasters\0"
+	"ReadySoft\0"
+	"Gremlin Interactive\0"
+	"Spectrum Holobyte\0"
+	"Interplay\0"
+	"Maxis\0"
+	"Working Designs\0"
+	"Activision\0"
+	"Playmates Interactive Entertainment\0"
+	"Bandai\0"
+	"CapDisc\0"
+	"ASC Games\0"
+	"Viacom New Media\0"
+	"Toei Video\0"
+	"Hudson (Hudson Soft)\0"
+	"Atlus\0"
+	"Sony Music Entertainment\0"
+	"Sansan\0"
+	"Nisshouiwai Infocom\0"
+	"Imagineer (Imadio)\0"
+	"Infogrames\0"
+	"Davidson & Associates\0"
+	"Rocket Science Games\0"
+	"Techn\305\215s Japan\0"
+	"Angel\0"
+	"Mindscape\0"
+	"Crystal Dynamics\0"
+	"Sales Curve Interactive\0"
+	"Fox Interactive\0"
+	"Digital Pictures\0"
+	"Ocean Software\0"
+	"Seta\0"
+	"Altron\0"
+	"ASK Kodansha\0"
+	"Athena\0"
+	"Gakken\0"
+	"General Entertainment\0"
+	"EA Sports\0"
+	"Glams\0"
+	"ASCII Something Good\0"
+	"Ubisoft\0"
+	"Hitachi\0"
+	"BMG Interactive Entertainment (BMG Victor, BMG Japan)\0"
+	"Obunsha\0"
+	"Thinking Cap\0"
+	"Gaga Communications\0"
+	"SoftBank (Game Bank)\0"
+	"Naxat Soft (Pionesoft)\0"
+	"Mizuki (Spike, Maxbet)\0"
+	"KAZe\0"
+	"Sega Yonezawa\0"
+	"We Net\0"
+	"Datam Polystar\0"
+	"KID\0"
+	"Epoch\0"
+	"Ving\0"
+	"Yoshimoto Kogyo\0"
+	"NEC Interchannel (InterChannel)\0"
+	"Sonnet Computer Entertainment\0"
+	"Game Studio\0"
+	"Psikyo\0"
+	"Media Entertainment\0"
+	"Banpresto\0"
+	"Ecseco Development\0"
+	"Bullet-Proof Software (BPS)\0"
+	"Sieg\0"
+	"Yanoman\0"
+	"Oz Club\0"
+	"Nihon Create\0"
+	"Media Rings Corporation\0"
+	"Shoeisha\0"
+	"OPeNBooK\0"
+	"Hakuhodo (Hamlet)\0"
+	"Aroma (Yumedia)\0"
+	"Societa Daikanyama\0"
+	"Arc System Works\0"
+	"Climax Entertainment\0"
+	"Pioneer LDC\0"
+	"Tokuma Shoten\0"
+	"I'MAX\0"
+	"Shogakukan\0"
+	"Vantan International\0"
+	"Titus\0"
+	"LucasArts\0"
+	"Pai\0"
+	"Ecole (Reindeer)\0"
+	"Nayuta\0"
+	"Bandai Visual\0"
+	"Quintet\0"
+	"Disney Interactive\0"
+	"9003 (OpenBook9003)\0"
+	"Multisoft\0"
+	"Sky Think System\0"
+	"OCC\0"
+	"Increment P (iPC)\0"
+	"King Records\0"
+	"Fun House\0"
+	"Patra\0"
+	"Inner Brain\0"
+	"Make Software\0"
+	"GT Interactive Software\0"
+	"Kodansha\0"
+	"Clef\0"
+	"C-Seven\0"
+	"Fujitsu Parex\0"
+	"Xing Entertainment\0"
+	"Media Quest\0"
+	"Wooyoung System\0"
+	"Nihon System\0"
+	"Scholar\0"
+	"Datt Japan\0"
+	"MediaWorks\0"
+	"Kadokawa Shoten\0"
+	"Elf\0"
+	"Tomy\0"
+	"KSS\0"
+	"Mainichi Communications\0"
+	"Warashi\0"
+	"Metro\0"
+	"Sai-Mate\0"
+	"Kokopeli Digital Studios\0"
+	"Planning Office Wada (POW)\0"
+	"Telstar\0"
+	"Warp, Kumon Publishing\0"
+	"Masudaya\0"
+	"Soft Office\0"
+	"Empire Interactive\0"
+	"Genki (Sada Soft)\0"
+	"Neverland\0"
+	"Shar Rock\0"
+	"Natsume\0"
+	"Nexus Interact\0"
+	"Aplix Corporation\0"
+	"Omiya Soft\0"
+	"JVC\0"
+	"Zoom\0"
+	"TEN Institute\0"
+	"Fujitsu\0"
+	"TGL\0"
+	"Red Company (Red Entertainment)\0"
+	"Waka Manufacturing\0"
+	"Treasure\0"
+	"Tokuma Shoten Intermedia\0"
+	"Sonic! Software Planning (Camelot)\0"
+	"Sting\0"
+	"Chunsoft\0"
+	"Aki\0"
+	"From Software\0"
+	"Daiki\0"
+	"Aspect\0"
+	"Micro Vision\0"
+	"Gainax\0"
+	"FortyFive (45XLV)\0"
+	"Enix\0"
+	"Ray Corporation\0"
+	"Tonkin House\0"
+	"Outrigger\0"
+	"B-Factory\0"
+	"LayUp\0"
+	"Axela\0"
+	"WorkJam\0"
+	"Nihon Syscom (Syscom Entertainment)\0"
+	"FOG (Full On Games)\0"
+	"Eidos Interactive\0"
+	"UEP Systems\0"
+	"Shouei System\0"
+	"GMF\0"
+	"ADK\0"
+	"Softstar Entertainment\0"
+	"Nexton\0"
+	"Denshi Media Services\0"
+	"Takuyo\0"
+	"Starlight Marry\0"
+	"Crystal Vision\0"
+	"Kamata and Partners\0"
+	"AquaPlus\0"
+	"Media Gallop\0"
+	"Culture Brain\0"
+	"Locus\0"
+	"Entertainment Software Publishing (ESP)\0"
+	"NEC Home Electronics\0"
+	"Pulse Interactive\0"
+	"Random House\0"
+	"Vivarium\0"
+	"Mebius\0"
+	"Panther Software\0"
+	"TBS\0"
+	"NetVillage (Gamevillage)\0"
+	"Vision (Noisia)\0"
+	"Shangri-La\0"
+	"Crave Entertainment\0"
+	"Metro3D\0"
+	"Majesco\0"
+	"Take-Two Interactive\0"
+	"Hasbro Interactive\0"
+	"Rage Software (Rage Games)\0"
+	"Marvelous Entertainment\0"
+	"Bottom Up\0"
+	"Daikoku Denki\0"
+	"Sunrise Interactive\0"
+	"Bimboosoft\0"
+	"UFO\0"
+	"Mattel Interactive\0"
+	"CaramelPot\0"
+	"Vatical Entertainment\0"
+	"Ripcord Games\0"
+	"Sega Toys\0"
+	"Gathering of Developers\0"
+	"Rockstar Games\0"
+	"Winkysoft\0"
+	"Cyberfront\0"
+	"DaZZ\0"
+	"Kobi\0"
+	"Fujicom\0"
+	"Real Vision\0"
+	"Visit\0"
+	"Global A Entertainment\0"
+	"Studio Wonder Effect\0"
+	"Media Factory\0"
+	"Red\0"
+	"Agetec\0"
+	"Abel\0"
+	"Softmax\0"
+	"Isao\0"
+	"Kool Kizz\0"
+	"GeneX\0"
+	"Xicat Interactive\0"
+	"Swing! Entertainment\0"
+	"Yuke's\0"
+	"AAA Game\0"
+	"TV Asahi\0"
+	"Crazy Games\0"
+	"Atmark\0"
+	"Hackberry\0"
+	"AIA\0"
+	"Starfish-SD\0"
+	"Idea Factory\0"
+	"Broccoli\0"
+	"Oaks (Princess Soft)\0"
+	"Bigben Interactive\0"
+	"G.rev\0"
+	"Symbio Planning\0"
+	"Alchemist\0"
+	"SNK Playmore\0"
+	"D3Publisher\0"
+	"Rain Software (Charara)\0"
+	"Good Navigate (GN Software)\0"
+	"Alfa System\0"
+	"Milestone Inc.\0"
+	"Triangle Service\0";
+
+/** tcode: Perfect hash table (347 entries) **/
+static const uint16_t tcode_keys[347] = {
+	0xDF, 0xC8, 0x44, 0x5B, 0xE6, 0x181, 0x6B, 0x180,
+	0x30, 0xD2, 0xDD, 0x16D, 0x40, 0x6A, 0xEF, 0x1B6,
+	0x2F, 0x1A3, 0x162, 0x1AD, 0x15E, 0x35, 0x156, 0x8D,
+	0xC6, 0x187, 0x97, 0x1D3, 0xD8, 0x16F, 0x1C0, 0x26,
+	0x7B, 0x173, 0xB2, 0x19E, 0x2A, 0xBC, 0xA6, 0x78,
+	0xD, 0x13A, 0x186, 0x12F, 0xA4, 0x3C, 0x118, 0x45,
+	0x14B, 0x1CA, 0x3F, 0xCE, 0x16, 0x19A, 0x57, 0x49,
+	0x154, 0xFC, 0x16C, 0x153, 0xAA, 0x11A, 0x163, 0x1C,
+	0x117, 0xB0, 0x15A, 0x42, 0x6F, 0xDE, 0xD7, 0x1BC,
+	0x2B, 0xC2, 0x23, 0x129, 0x17, 0x196, 0x148, 0x177,
+	0x58, 0x101, 0x1C2, 0xF9, 0x87, 0x12C, 0xF6, 0xB6,
+	0x191, 0x121, 0x133, 0x72, 0x175, 0x139, 0x59, 0x141,
+	0x1C7, 0xE, 0x8B, 0x165, 0xEA, 0xE5, 0x1A0, 0xD6,
+	0x183, 0xD9, 0x3A, 0x38, 0x1D2, 0x10E, 0xFE, 0x18E,
+	0x6D, 0x9D, 0x155, 0x21, 0x7D, 0x4A, 0x142, 0x164,
+	0xDC, 0x7F, 0xA0, 0xF0, 0x36, 0x178, 0xC5, 0xCC,
+	0x13B, 0x43, 0x105, 0x4C, 0x1A2, 0x67, 0x169, 0xDA,
+	0x85, 0x7C, 0x182, 0xD4, 0x95, 0x1C3, 0x15C, 0x18A,
+	0x29, 0x73, 0x1BF, 0x10F, 0xFF, 0x22, 0x17B, 0xB,
+	0x1B7, 0x66, 0x124, 0x135, 0xCB, 0x2D, 0x149, 0x17F,
+	0x1D7, 0xA2, 0x1E, 0x19C, 0xBD, 0x138, 0x1CC, 0xBA,
+	0x92, 0x170, 0x1F, 0x63, 0x1DC, 0x1D5, 0x1D1, 0xD0,
+	0x1CF, 0xEB, 0xB4, 0x1A1, 0x71, 0x134, 0x111, 0x33,
+	0xA7, 0x14A, 0x4F, 0x15F, 0x34, 0x56, 0x53, 0xB1,
+	0x145, 0xF, 0x108, 0x77, 0xCD, 0x61, 0x137, 0x47,
+	0xA9, 0x1B, 0x4B, 0x37, 0x12, 0xF1, 0x128, 0x1A5,
+	0x5F, 0xF2, 0x98, 0x184, 0x90, 0x132, 0x16A, 0xE8,
+	0x11, 0x2C, 0x1B9, 0xC, 0x46, 0x1BE, 0x18, 0x99,
+	0x1D, 0x192, 0x18B, 0x10, 0xA8, 0x1A8, 0x1CE, 0x19,
+	0x2E, 0x126, 0x172, 0xC1, 0x136, 0x17E, 0x19D, 0x39,
+	0x1AC, 0xAC, 0x198, 0xFD, 0x1BD, 0x9A, 0x17C, 0x55,
+	0x82, 0x1C9, 0x7E, 0xE0, 0x1B1, 0x19B, 0x10C, 0x1A7,
+	0x1DE, 0x190, 0x4D, 0x116, 0x5C, 0x9E, 0x1BB, 0x1DF,
+	0x1C6, 0x13C, 0x14, 0xC3, 0x3D, 0xB9, 0x51, 0x8F,
+	0x1DD, 0x89, 0x79, 0x69, 0x9F, 0x91, 0x193, 0xE9,
+	0xD1, 0x176, 0x125, 0x197, 0x123, 0x17D, 0xE7, 0x1B3,
+	0x70, 0x28, 0xD5, 0x76, 0xCF, 0x194, 0xFA, 0xE3,
+	0x1D9, 0x41, 0x6E, 0x122, 0x15, 0x13, 0xF3, 0x195,
+	0x1CD, 0x1B2, 0x93, 0x1DB, 0x20, 0x18D, 0x32, 0x171,
+	0xCA, 0xB5, 0x16B, 0x1A, 0x104, 0x48, 0xA1, 0x84,
+	0xE2, 0x5D, 0x18C, 0xBB, 0xC9, 0x19F, 0x54, 0xC7,
+	0x1A6, 0xFB, 0x65, 0x96, 0x168, 0x3E, 0x103, 0x1DA,
+	0x146, 0x1C1, 0xAE, 0x199, 0xA5, 0x64, 0x31, 0x24,
+	0x0, 0x1C8, 0xDB,
+};
+static const int16_t tcode_disp[347] = {
+	-345, 2, 0, 0, 2, 1, -344, 0, 2, 2, 1, -343,
+	-342, 2, -340, -336, 3, 1, -334, 0, -333, 2, -329, 2,
+	-328, -323, -322, 0, -321, 0, -318, 0, 2, 3, 2, 0,
+	5, 0, 0, -317, 1, 0, 0, -316, -315, -312, -311, 0,
+	-310, 1, -300, 2, 2, -298, 3, -297, 0, 2, 2, -292,
+	1, 0, -291, 1, 0, -290, 0, 0, -289, 0, -287, 0,
+	-283, -281, 1, 1, -277, 0, -276, 3, -274, -271, -270, -261,
+	0, 0, 0, 1, 0, 2, 0, 0, 3, -259, 3, 0,
+	0, 2, 2, 0, 0, 1, 10, -255, -254, -253, 1, 0,
+	0, -250, 0, 0, -247, 0, 0, -240, -239, -238, 0, 5,
+	1, 0, 0, 0, 2, 0, 0, 1, -235, -231, -230, -229,
+	-225, -222, 0, -221, 0, 1, -218, -217, -216, 2, 7, -215,
+	-203, -202, 0, 1, -201, 0, 6, 0, -198, 0, 1, 1,
+	0, 2, 1, -196, 0, -194, 1, -193, 2, 0, -192, -191,
+	-190, 0, -187, -184, 0, -182, 1, -180, -179, -175, 0, 2,
+	-174, 0, -171, -168, 0, 1, -166, -165, -164, 0, -163, 0,
+	-161, 0, 0, -159, 1, 0, -158, 0, 0, 0, -154, 0,
+	2, 0, 4, -153, -152, 3, 3, -151, -148, -146, 9, -142,
+	-136, -135, 0, -134, -132, 0, -127, 4, 1, -125, -124, 0,
+	0, 3, -122, 0, 0, 0, -120, 0, 5, -117, 0, 1,
+	-116, 0, -115, 6, 0, 0, -109, -106, -100, 0, 0, 0,
+	-99, -98, 2, 3, 0, 0, -95, 4, -93, 3, -91, 0,
+	1, 1, 0, 0, -90, -87, 0, -84, 0, -82, 0, 8,
+	-81, -79, -78, 0, -77, -75, -72, 0, -69, 0, 0, 0,
+	0, 2, 0, -68, -61, 1, -59, 0, 0, 8, -58, 8,
+	0, 0, -54, -53, -50, -48, -47, 0, 3, 0, -40, -38,
+	0, 2, 0, -37, 13, -34, -31, 1, 1, 0, 0, 3,
+	5, 0, 0, -30, 0, 0, 0, 0, -28, -26, 1, -25,
+	-23, 0, -18, -10, 0, -8, 4, 0, 0, 0, -5,
+};
+static const uint16_t tcode_publisher[347] = {
+	2688, 2335, 765, 1095, 2746, 3941, 1364, 3928, 380, 2514, 2655, 3701,
+	696, 1341, 2806, 4523, 364, 4404, 3609, 4474, 3589, 497, 3562, 1720,
+	2324, 4040, 1829, 4774, 2576, 3737, 4597, 273, 1561, 3801, 2109, 4328,
+	300, 2256, 2008, 1539, 19, 3377, 4022, 3258, 1988, 562, 3115, 794,
+	3508, 4686, 684, 2452, 105, 4279, 1037, 865, 3549, 2923, 3693, 3543,
+	2042, 3119, 3627, 193, 3099, 2080, 3576, 737, 1437, 2676, 2567, 4569,
+	304, 2298, 250, 3227, 114, 4199, 3455, 3832, 1072, 2982, 4621, 2894,
+	1685, 3235, 2876, 2179, 4131, 3124, 3279, 1488, 3805, 3359, 1079, 3397,
+	4658, 29, 1703, 3648, 2784, 2740, 4358, 2543, 3961, 2585, 556, 539,
+	4755, 3056, 2949, 4090, 1378, 1898, 3558, 232, 1599, 893, 3411, 3632,
+	2638, 1615, 1931, 2825, 511, 3839, 2320, 2425, 3388, 745, 3009, 913,
+	4394, 1312, 3671, 2603, 1678, 1581, 3955, 2522, 1790, 4642, 3582, 4053,
+	292, 1497, 4587, 3069, 2973, 239, 3861, 6, 4544, 1304, 3160, 3316,
+	2413, 326, 3474, 3919, 4796, 1971, 205, 4313, 2279, 3344, 4696, 2212,
+	1312, 3757, 218, 1246, 4855, 4780, 4734, 2481, 4725, 2798, 2117, 4380,
+	1478, 3298, 3077, 456, 2015, 3483, 939, 3602, 467, 1014, 984, 2101,
+	3419, 44, 3028, 1530, 2432, 1198, 3336, 833, 2035, 188, 901, 516,
+	82, 2845, 3200, 4428, 1191, 2855, 1840, 4001, 1752, 3267, 3681, 2760,
+	76, 310, 4558, 12, 814, 4582, 124, 1862, 199, 4142, 4062, 70,
+	2028, 4464, 4712, 137, 336, 3175, 3787, 2284, 3326, 3899, 4324, 549,
+	4469, 2064, 4245, 2935, 4574, 1883, 3868, 1001, 1631, 4679, 1609, 2702,
+	4482, 4293, 3040, 4453, 4895, 4115, 918, 3088, 1166, 1904, 4562, 4910,
+	4649, 3392, 93, 2305, 624, 2192, 949, 1731, 4883, 1693, 1551, 1319,
+	1914, 1758, 4162, 2777, 2509, 3809, 3166, 4218, 3152, 3884, 2756, 4500,
+	1458, 284, 2530, 1509, 2462, 4170, 2907, 2719, 4806, 723, 1398, 3128,
+	99, 82, 2872, 4178, 4700, 4494, 1783, 4831, 222, 4086, 440, 3775,
+	2383, 2171, 3687, 170, 2995, 859, 1955, 1642, 2708, 1186, 4069, 2233,
+	2351, 4347, 992, 2330, 4443, 2917, 1281, 1810, 3661, 669, 2987, 4819,
+	3423, 4603, 2074, 4269, 2003, 1254, 413, 267, 1, 4667, 2619,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_SEGAPUBLISHERS_DATA_H__ */
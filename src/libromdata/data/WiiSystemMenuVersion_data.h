@@ -0,0 +1,89 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * WiiSystemMenuVersion_data.h: Generated lookup tables.                   *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: WiiSystemMenuVersion_data.txt                                   *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_WIISYSTEMMENUVERSION_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_WIISYSTEMMENUVERSION_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace WiiSystemMenuVersion_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (200 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"1.0\0"
+	"2.0U\0"
+	"2.0J\0"
+	"2.0E\0"
+	"2.1E\0"
+	"2.2J\0"
+	"2.2U\0"
+	"2.2E\0"
+	"3.0J\0"
+	"3.0U\0"
+	"3.0E\0"
+	"3.1J\0"
+	"3.1U\0"
+	"3.1E\0"
+	"3.2J\0"
+	"3.2U\0"
+	"3.2E\0"
+	"3.3K\0"
+	"3.3J\0"
+	"3.3U\0"
+	"3.3E\0"
+	"3.4J\0"
+	"3.4U\0"
+	"3.4E\0"
+	"3.5K\0"
+	"4.0J\0"
+	"4.0U\0"
+	"4.0E\0"
+	"4.1J\0"
+	"4.1U\0"
+	"4.1E\0"
+	"4.1K\0"
+	"4.2J\0"
+	"4.2U\0"
+	"4.2E\0"
+	"4.2K\0"
+	"4.3J\0"
+	"4.3U\0"
+	"4.3E\0"
+	"4.3K\0";
+
+/** sysVersion: Perfect hash table (46 entries) **/
+static const uint16_t sysVersion_keys[46] = {
+	0x1A2, 0x1E1, 0xE0, 0x262, 0x82, 0x61, 0x1C2, 0x161,
+	0xC1, 0x1C0, 0x1A1, 0x220, 0x146, 0x21, 0xA2, 0x200,
+	0x261, 0x1E2, 0x186, 0x201, 0x122, 0xC0, 0x181, 0x100,
+	0x1E0, 0xC2, 0x160, 0x202, 0x221, 0x102, 0xE1, 0x222,
+	0xE2, 0x1C1, 0x80, 0x260, 0x1A0, 0x1C6, 0x206, 0x180,
+	0x120, 0x101, 0x162, 0x1E3, 0x182, 0x121,
+};
+static const int16_t sysVersion_disp[46] = {
+	-44, 0, 0, 0, 0, 0, -43, 0, 0, 0, -41, 0,
+	3, -36, 0, -35, -32, 1, -28, -27, 1, -26, 0, 0,
+	-18, -17, -16, 0, 1, 1, 1, 3, 2, 0, -11, 0,
+	0, -6, 5, -2, 6, -1, 9, 0, 0, 15,
+};
+static const uint16_t sysVersion_str[46] = {
+	135, 165, 40, 190, 15, 5, 150, 95, 30, 140, 130, 180,
+	85, 1, 20, 180, 185, 170, 120, 185, 80, 25, 110, 55,
+	160, 35, 90, 190, 185, 65, 45, 190, 50, 145, 10, 180,
+	125, 155, 195, 105, 70, 60, 100, 175, 115, 75,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_WIISYSTEMMENUVERSION_DATA_H__ */
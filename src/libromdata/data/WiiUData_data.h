@@ -0,0 +1,115 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * WiiUData_data.h: Generated lookup tables.                               *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: WiiUData_data.txt                                               *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_WIIUDATA_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_WIIUDATA_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace WiiUData_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (1 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0";
+
+/** noregion: Perfect hash table (195 entries) **/
+static const uint32_t noregion_keys[195] = {
+	0x41533278, 0x41414C78, 0x414E5878, 0x42523578, 0x41565878, 0x41483978, 0x414C4178, 0x41424678,
+	0x41454378, 0x434E4678, 0x41464D78, 0x424C3678, 0x41463678, 0x42504578, 0x41543578, 0x414B4278,
+	0x42444C78, 0x415A4178, 0x41534E78, 0x414C4378, 0x41555278, 0x414A5378, 0x41543778, 0x41505778,
+	0x41534C78, 0x42414B78, 0x42504378, 0x41575378, 0x414D4478, 0x41554E78, 0x42584178, 0x41524478,
+	0x41505078, 0x41445078, 0x414C4A78, 0x41574678, 0x414D4B78, 0x41505A78, 0x424C5478, 0x41535345,
+	0x41445278, 0x41515578, 0x42454E78, 0x41463378, 0x41544B78, 0x414E5278, 0x414D5678, 0x41484B78,
+	0x42443378, 0x414E4278, 0x41414678, 0x41434578, 0x414D4678, 0x41504378, 0x41425478, 0x424B4678,
+	0x41485778, 0x41534578, 0x414D5A78, 0x42454478, 0x41545278, 0x424A3778, 0x41504C78, 0x42413478,
+	0x414C4D78, 0x42543978, 0x41424178, 0x414E5978, 0x4156414A, 0x41563378, 0x414C4878, 0x41454D78,
+	0x41594578, 0x42445178, 0x57474478, 0x534E4878, 0x41534678, 0x534E4378, 0x41595378, 0x41475A78,
+	0x42543378, 0x41433278, 0x41524278, 0x414A5478, 0x41424278, 0x414D5178, 0x57444B78, 0x574B4E78,
+	0x534E4778, 0x415A4578, 0x534E4A78, 0x424B3778, 0x42534678, 0x41505578, 0x574E4378, 0x414C3578,
+	0x414A4478, 0x414E5378, 0x414E4778, 0x414D4578, 0x41483578, 0x41444E78, 0x41425778, 0x414D3978,
+	0x42525178, 0x414D4178, 0x41464478, 0x41463978, 0x41585978, 0x57414678, 0x415A4278, 0x424C4778,
+	0x41535578, 0x41583578, 0x414C5678, 0x41434178, 0x41594378, 0x424B5378, 0x41535678, 0x41465278,
+	0x414C5A78, 0x414D3878, 0x41524D78, 0x41504B78, 0x414A4B78, 0x42525378, 0x41544478, 0x41443278,
+	0x41435078, 0x42464E78, 0x42574678, 0x41504778, 0x41535778, 0x41574378, 0x41535478, 0x42535378,
+	0x41533578, 0x42504D78, 0x41473678, 0x41525078, 0x424C4B78, 0x41434378, 0x42544D78, 0x41474D78,
+	0x41505478, 0x41574478, 0x41554D78, 0x415A5578, 0x41425078, 0x41484678, 0x41424C78, 0x414B4E78,
+	0x41473578, 0x41545778, 0x41475278, 0x41534278, 0x41563478, 0x414C4278, 0x41473978, 0x41464278,
+	0x41465878, 0x41475078, 0x41564378, 0x41535078, 0x42435A78, 0x41424A78, 0x41484478, 0x41525978,
+	0x414A3678, 0x41444378, 0x41445878, 0x57414878, 0x414C5278, 0x424D5378, 0x414A3578, 0x41524B78,
+	0x41434D78, 0x41484278, 0x42483978, 0x42545078, 0x41445178, 0x41474E78, 0x41533978, 0x41424878,
+	0x414D3778, 0x424A4478, 0x41433378, 0x42555478, 0x41584678, 0x41533778, 0x41525378, 0x41504178,
+	0x41534178, 0x414A5078, 0x42533578,
+};
+static const int16_t noregion_disp[195] = {
+	-194, 0, 0, 0, 1, 2, 2, -193, 0, -192, -191, 0,
+	0, -190, -189, 1, 0, 1, 1, -181, 2, 0, 0, -174,
+	1, -172, 1, -171, 4, 2, -170, 2, 3, -166, 3, -160,
+	-155, 0, -152, -151, 1, 0, -149, 3, -148, -145, -143, 0,
+	-140, 0, -137, 0, 0, -135, -131, 0, -130, 0, 0, -124,
+	-120, 1, 0, 4, -119, 0, 7, -116, -114, 0, 0, 0,
+	1, 1, -108, -104, -102, -99, 4, 0, 4, 0, 0, 0,
+	-96, 0, 1, 0, 1, 0, 0, 1, 0, 0, 1, 9,
+	0, 0, 0, 3, -93, 1, 1, -92, 0, 0, 0, 2,
+	-84, 0, -82, -81, -77, 4, 0, 1, 2, 0, 0, 1,
+	0, -73, 0, 0, 0, 1, 17, 1, 6, 0, -72, 0,
+	-69, 12, 0, 0, 1, 0, 1, -65, 0, -64, -63, 0,
+	-62, -59, -54, 0, 1, 6, 0, -49, 0, -48, -46, 0,
+	-44, 1, 0, 0, 0, 0, -43, -38, 5, 1, -32, 2,
+	0, 2, -27, -26, 1, 6, -23, 0, -16, -15, 0, 0,
+	34, -11, 7, -8, 0, 0, 0, 0, 0, -4, -3, 0,
+	0, 8, -2,
+};
+static const uint32_t noregion_publisher[195] = {
+	808466512, 808464433, 808464433, 808471128, 808464433, 808469304, 808474450, 808465714, 808465714, 808464433, 808474950, 808465714,
+	808465714, 808465714, 808468806, 808464433, 808470340, 808464433, 808466512, 808464433, 808464433, 808474450, 808465988, 808468806,
+	808465714, 808473676, 808464433, 808464433, 808465977, 808468806, 808464433, 808464433, 808464440, 808465457, 808474450, 808466232,
+	808464433, 808474450, 808468806, 808465457, 808465489, 808464433, 808466520, 808465977, 808468806, 808465714, 808465457, 808474957,
+	808465489, 808465716, 808464433, 808465714, 808464440, 808468806, 808474450, 808474202, 808474450, 808464433, 808465714, 808466232,
+	808465714, 808465457, 808464433, 808474450, 808474450, 808468806, 808464433, 808470340, 808470598, 808465714, 808474450, 808465489,
+	808465714, 808470340, 808465217, 808466774, 808465714, 808465975, 808465457, 808471877, 808468806, 808474202, 808465457, 808474708,
+	808474202, 808471373, 808464440, 808468825, 808464464, 808474450, 808465994, 808465714, 808468806, 808469304, 808464433, 808464433,
+	808465457, 808465977, 808464433, 808465977, 808472139, 808464433, 808468806, 808465714, 808474202, 808464433, 808464433, 808465206,
+	808464433, 808464433, 808465735, 808474450, 808465457, 808464433, 808474950, 808465714, 808464433, 808466263, 808465714, 808474202,
+	808464433, 808464440, 808465457, 808464433, 808465457, 808468806, 808474202, 808466232, 808465714, 808474202, 808464433, 808474202,
+	808464433, 808465457, 808464433, 808466512, 808465714, 808468806, 808464440, 808464433, 808466006, 808472139, 808474450, 808464433,
+	808466512, 808465714, 808469589, 808465457, 808469590, 808474457, 808474950, 808468806, 808464440, 808464433, 808465714, 808465457,
+	808465714, 808474450, 808469304, 808470356, 808464433, 808474450, 808465714, 808465457, 808464433, 808464433, 808464440, 808466512,
+	808465457, 808474450, 808470340, 808464433, 808474450, 808474202, 808465457, 808464433, 808464433, 808469304, 808464440, 808470340,
+	808470340, 808465714, 808465457, 808464440, 808464440, 808465457, 808464433, 808466006, 808464433, 808465714, 808464433, 808465489,
+	808464433, 808466232, 808465714,
+};
+
+/** region: Perfect hash table (37 entries) **/
+static const uint32_t region_keys[37] = {
+	0x41534345, 0x41504650, 0x41544245, 0x42524445, 0x41425650, 0x42575045, 0x414A3850, 0x4254584A,
+	0x41435250, 0x41544250, 0x41425645, 0x41534350, 0x4146504A, 0x41445250, 0x41533850, 0x4257504A,
+	0x42545845, 0x4144525A, 0x41524750, 0x41465050, 0x41445245, 0x41533845, 0x41445645, 0x414A3845,
+	0x42545850, 0x41465045, 0x41445650, 0x41524745, 0x4252444A, 0x4144524A, 0x41424550, 0x42575050,
+	0x41435245, 0x42524450, 0x41424545, 0x41504645, 0x4153384A,
+};
+static const int16_t region_disp[37] = {
+	-37, -34, -33, -31, 1, 0, 2, -30, 0, -29, -28, -27,
+	0, 0, 0, -26, -25, 0, 2, -23, 0, -14, -13, 2,
+	5, -10, 0, 0, -8, 0, 0, 0, -6, 13, -3, 2,
+	-2,
+};
+static const uint32_t region_publisher[37] = {
+	808474450, 808470356, 808470329, 808472147, 808468806, 808464433, 808474199, 808469836, 808468806, 808468806, 808470329, 808464433,
+	808470329, 808465489, 808470356, 808469304, 808470356, 808465489, 808468806, 808468806, 808465489, 808470356, 808470329, 808466745,
+	808470356, 808470329, 808468806, 808470329, 808466506, 808468806, 808468806, 808464433, 808470329, 808472147, 808470329, 808465735,
+	808465457,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_WIIUDATA_DATA_H__ */
@@ -0,0 +1,138 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * Xbox360_STFS_ContentType_data.h: Generated lookup tables.               *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: Xbox360_STFS_ContentType_data.txt                               *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_XBOX360_STFS_CONTENTTYPE_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_XBOX360_STFS_CONTENTTYPE_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace Xbox360_STFS_ContentType_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (371 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"Saved Game\0"
+	"Marketplace Content\0"
+	"Publisher\0"
+	"Xbox 360 Game\0"
+	"IPTV Pause Buffer\0"
+	"Installed Game\0"
+	"Original Xbox Game\0"
+	"Avatar Item\0"
+	"Profile\0"
+	"Gamer Picture\0"
+	"Theme\0"
+	"Cache File\0"
+	"Storage Download\0"
+	"Original Xbox Saved Game\0"
+	"Original Xbox Download\0"
+	"Game Demo\0"
+	"Video\0"
+	"Game\0"
+	"Installer\0"
+	"Game Trailer\0"
+	"Arcade Game\0"
+	"XNA\0"
+	"License Store\0"
+	"Movie\0"
+	"TV\0"
+	"Music Video\0"
+	"Game Video\0"
+	"Podcast Video\0"
+	"Viral Video\0"
+	"Community Game\0";
+
+/** contentType: Perfect hash table (30 entries) **/
+static_assert(STFS_CONTENT_TYPE_SAVED_GAME == 0x1, "STFS_CONTENT_TYPE_SAVED_GAME has changed.");
+static_assert(STFS_CONTENT_TYPE_MARKETPLACE_CONTENT == 0x2, "STFS_CONTENT_TYPE_MARKETPLACE_CONTENT has changed.");
+static_assert(STFS_CONTENT_TYPE_PUBLISHER == 0x3, "STFS_CONTENT_TYPE_PUBLISHER has changed.");
+static_assert(STFS_CONTENT_TYPE_XBOX_360_TITLE == 0x1000, "STFS_CONTENT_TYPE_XBOX_360_TITLE has changed.");
+static_assert(STFS_CONTENT_TYPE_IPTV_PAUSE_BUFFER == 0x2000, "STFS_CONTENT_TYPE_IPTV_PAUSE_BUFFER has changed.");
+static_assert(STFS_CONTENT_TYPE_INSTALLED_GAME == 0x4000, "STFS_CONTENT_TYPE_INSTALLED_GAME has changed.");
+static_assert(STFS_CONTENT_TYPE_XBOX_ORIGINAL_GAME == 0x5000, "STFS_CONTENT_TYPE_XBOX_ORIGINAL_GAME has changed.");
+static_assert(STFS_CONTENT_TYPE_AVATAR_ITEM == 0x9000, "STFS_CONTENT_TYPE_AVATAR_ITEM has changed.");
+static_assert(STFS_CONTENT_TYPE_PROFILE == 0x10000, "STFS_CONTENT_TYPE_PROFILE has changed.");
+static_assert(STFS_CONTENT_TYPE_GAMER_PICTURE == 0x20000, "STFS_CONTENT_TYPE_GAMER_PICTURE has changed.");
+static_assert(STFS_CONTENT_TYPE_THEME == 0x30000, "STFS_CONTENT_TYPE_THEME has changed.");
+static_assert(STFS_CONTENT_TYPE_CACHE_FILE == 0x40000, "STFS_CONTENT_TYPE_CACHE_FILE has changed.");
+static_assert(STFS_CONTENT_TYPE_STORAGE_DOWNLOAD == 0x50000, "STFS_CONTENT_TYPE_STORAGE_DOWNLOAD has changed.");
+static_assert(STFS_CONTENT_TYPE_XBOX_SAVED_GAME == 0x60000, "STFS_CONTENT_TYPE_XBOX_SAVED_GAME has changed.");
+static_assert(STFS_CONTENT_TYPE_XBOX_DOWNLOAD == 0x70000, "STFS_CONTENT_TYPE_XBOX_DOWNLOAD has changed.");
+static_assert(STFS_CONTENT_TYPE_GAME_DEMO == 0x80000, "STFS_CONTENT_TYPE_GAME_DEMO has changed.");
+static_assert(STFS_CONTENT_TYPE_VIDEO == 0x90000, "STFS_CONTENT_TYPE_VIDEO has changed.");
+static_assert(STFS_CONTENT_TYPE_GAME_TITLE == 0xA0000, "STFS_CONTENT_TYPE_GAME_TITLE has changed.");
+static_assert(STFS_CONTENT_TYPE_INSTALLER == 0xB0000, "STFS_CONTENT_TYPE_INSTALLER has changed.");
+static_assert(STFS_CONTENT_TYPE_GAME_TRAILER == 0xC0000, "STFS_CONTENT_TYPE_GAME_TRAILER has changed.");
+static_assert(STFS_CONTENT_TYPE_ARCADE_TITLE == 0xD0000, "STFS_CONTENT_TYPE_ARCADE_TITLE has changed.");
+static_assert(STFS_CONTENT_TYPE_XNA == 0xE0000, "STFS_CONTENT_TYPE_XNA has changed.");
+static_assert(STFS_CONTENT_TYPE_LICENSE_STORE == 0xF0000, "STFS_CONTENT_TYPE_LICENSE_STORE has changed.");
+static_assert(STFS_CONTENT_TYPE_MOVIE == 0x100000, "STFS_CONTENT_TYPE_MOVIE has changed.");
+static_assert(STFS_CONTENT_TYPE_TV == 0x200000, "STFS_CONTENT_TYPE_TV has changed.");
+static_assert(STFS_CONTENT_TYPE_MUSIC_VIDEO == 0x300000, "STFS_CONTENT_TYPE_MUSIC_VIDEO has changed.");
+static_assert(STFS_CONTENT_TYPE_GAME_VIDEO == 0x400000, "STFS_CONTENT_TYPE_GAME_VIDEO has changed.");
+static_assert(STFS_CONTENT_TYPE_PODCAST_VIDEO == 0x500000, "STFS_CONTENT_TYPE_PODCAST_VIDEO has changed.");
+static_assert(STFS_CONTENT_TYPE_VIRAL_VIDEO == 0x600000, "STFS_CONTENT_TYPE_VIRAL_VIDEO has changed.");
+static_assert(STFS_CONTENT_TYPE_COMMUNITY_GAME == 0x2000000, "STFS_CONTENT_TYPE_COMMUNITY_GAME has changed.");
+static const uint32_t contentType_keys[30] = {
+	0x60000, 0x5000, 0x500000, 0x400000, 0x50000, 0x40000, 0x3, 0x90000,
+	0x20000, 0x30000, 0x300000, 0xE0000, 0x80000, 0x10000, 0xD0000, 0x2000000,
+	0xC0000, 0x2000, 0x100000, 0x1, 0x600000, 0xF0000, 0x70000, 0x4000,
+	0x1000, 0x200000, 0xB0000, 0x9000, 0xA0000, 0x2,
+};
+static const int16_t contentType_disp[30] = {
+	-29, -28, 1, 0, -27, 2, 0, 4, 1, -23, -22, 0,
+	-15, 0, 3, -13, 0, 0, 0, 1, 0, -8, -6, -5,
+	0, 0, 0, 1, 11, -1,
+};
+static const uint16_t contentType_contentType[30] = {
+	176, 89, 330, 319, 159, 148, 32, 234, 128, 142, 307, 280,
+	224, 120, 268, 356, 255, 56, 298, 1, 344, 284, 201, 74,
+	42, 304, 245, 108, 240, 12,
+};
+
+} }
+
+// Translatable strings. (for xgettext only)
+#if 0
+NOP_C_("Xbox360_STFS|ContentType", "Saved Game");
+NOP_C_("Xbox360_STFS|ContentType", "Marketplace Content");
+NOP_C_("Xbox360_STFS|ContentType", "Publisher");
+NOP_C_("Xbox360_STFS|ContentType", "Xbox 360 Game");
+NOP_C_("Xbox360_STFS|ContentType", "IPTV Pause Buffer");
+NOP_C_("Xbox360_STFS|ContentType", "Installed Game");
+NOP_C_("Xbox360_STFS|ContentType", "Original Xbox Game");
+NOP_C_("Xbox360_STFS|ContentType", "Avatar Item");
+NOP_C_("Xbox360_STFS|ContentType", "Profile");
+NOP_C_("Xbox360_STFS|ContentType", "Gamer Picture");
+NOP_C_("Xbox360_STFS|ContentType", "Theme");
+NOP_C_("Xbox360_STFS|ContentType", "Cache File");
+NOP_C_("Xbox360_STFS|ContentType", "Storage Download");
+NOP_C_("Xbox360_STFS|ContentType", "Original Xbox Saved Game");
+NOP_C_("Xbox360_STFS|ContentType", "Original Xbox Download");
+NOP_C_("Xbox360_STFS|ContentType", "Game Demo");
+NOP_C_("Xbox360_STFS|ContentType", "Video");
+NOP_C_("Xbox360_STFS|ContentType", "Game");
+NOP_C_("Xbox360_STFS|ContentType", "Installer");
+NOP_C_("Xbox360_STFS|ContentType", "Game Trailer");
+NOP_C_("Xbox360_STFS|ContentType", "Arcade Game");
+NOP_C_("Xbox360_STFS|ContentType", "License Store");
+NOP_C_("Xbox360_STFS|ContentType", "Movie");
+NOP_C_("Xbox360_STFS|ContentType", "TV");
+NOP_C_("Xbox360_STFS|ContentType", "Music Video");
+NOP_C_("Xbox360_STFS|ContentType", "Game Video");
+NOP_C_("Xbox360_STFS|ContentType", "Podcast Video");
+NOP_C_("Xbox360_STFS|ContentType", "Viral Video");
+NOP_C_("Xbox360_STFS|ContentType", "Community Game");
+#endif
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_XBOX360_STFS_CONTENTTYPE_DATA_H__ */
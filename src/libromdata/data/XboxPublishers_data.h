@@ -0,0 +1,162 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * XboxPublishers_data.h: Generated lookup tables.                         *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: XboxPublishers_data.txt                                         *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_XBOXPUBLISHERS_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_XBOXPUBLISHERS_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRomData { namespace XboxPublishers_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (1414 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"<unlicensed>\0"
+	"Acclaim Entertainment\0"
+	"ARUSH Entertainment\0"
+	"Aqua System\0"
+	"ASK\0"
+	"Atlus\0"
+	"Activision\0"
+	"Aspyr Media\0"
+	"Bandai\0"
+	"Black Box\0"
+	"BAM! Entertainment\0"
+	"Broccoli Co.\0"
+	"Bethesda Softworks\0"
+	"Bunkasha Co.\0"
+	"Buena Vista Games\0"
+	"BBC Multimedia\0"
+	"Blizzard\0"
+	"Capcom\0"
+	"Kemco Corporation\0"
+	"Codemasters\0"
+	"Crave Entertainment\0"
+	"DreamCatcher Interactive\0"
+	"Davilex\0"
+	"Electronic Arts (EA)\0"
+	"Encore inc\0"
+	"Enlight Software\0"
+	"Empire Interactive\0"
+	"Eidos Interactive\0"
+	"Fox Interactive\0"
+	"From Software\0"
+	"Genki Co.\0"
+	"Groove Games\0"
+	"Tru Blu\0"
+	"Hip games\0"
+	"Hudson Soft\0"
+	"Highwaystar\0"
+	"Mad Catz Interactive\0"
+	"Idea Factory\0"
+	"Infogrames\0"
+	"Interlex Corporation\0"
+	"Imagine Media\0"
+	"Ignition Entertainment\0"
+	"Interplay Entertainment\0"
+	"InXile Entertainment\0"
+	"Jaleco\0"
+	"JoWooD\0"
+	"Kemco\0"
+	"Kids Station Inc.\0"
+	"Konami\0"
+	"KOEI\0"
+	"Kobi and/or GAE\0"
+	"LucasArts\0"
+	"Black Bean Games\0"
+	"Metro3D\0"
+	"Medix\0"
+	"Micro\303\257ds\0"
+	"Majesco Entertainment\0"
+	"Myelin Media\0"
+	"MediaQuest\0"
+	"Microsoft Game Studios\0"
+	"Midway Games\0"
+	"NewKidCo\0"
+	"NovaLogic\0"
+	"Namco\0"
+	"Oxygen Interactive\0"
+	"Playlogic Entertainment\0"
+	"Phantagram Co., Ltd.\0"
+	"Rage\0"
+	"Sammy\0"
+	"SCi Games\0"
+	"SEGA\0"
+	"SNK\0"
+	"Simon & Schuster\0"
+	"Success Corporation\0"
+	"Swing! Deutschland\0"
+	"Takara\0"
+	"Tecmo\0"
+	"The 3DO Company\0"
+	"Takuyo\0"
+	"TDK Mediactive\0"
+	"THQ\0"
+	"Titus Interactive\0"
+	"Take-Two Interactive Software\0"
+	"Ubisoft\0"
+	"Victor Interactive Software\0"
+	"Vivendi Universal Games\0"
+	"Wanadoo Edition\0"
+	"Warner Bros. Interactive Entertainment\0"
+	"XPEC Entertainment and Idea Factory\0"
+	"Xbox kiosk disk\0"
+	"Xbox special bundled or live demo disk\0"
+	"Evolved Games\0"
+	"XPEC Entertainment\0"
+	"Panorama\0"
+	"YBM Sisa\0"
+	"Zushi Games (Zoo Digital Publishing)\0";
+
+/** thirdParty: Perfect hash table (99 entries) **/
+static const uint16_t thirdParty_keys[99] = {
+	0x4E4D, 0x4850, 0x4857, 0x5355, 0x4C53, 0x4156, 0x4947, 0x454C,
+	0x544D, 0x4D50, 0x5353, 0x4A41, 0x4443, 0x5A44, 0x4553, 0x494D,
+	0x5357, 0x5849, 0x4241, 0x4D4A, 0x4B4F, 0x424D, 0x5343, 0x4958,
+	0x454D, 0x0, 0x4B55, 0x4D57, 0x5745, 0x494C, 0x4B49, 0x434D,
+	0x4151, 0x4756, 0x4649, 0x5453, 0x4256, 0x5341, 0x4143, 0x584D,
+	0x4159, 0x5942, 0x425A, 0x4D58, 0x584B, 0x4153, 0x5443, 0x5441,
+	0x4B42, 0x4D44, 0x4253, 0x434B, 0x4855, 0x4458, 0x584C, 0x4E4C,
+	0x4B4E, 0x5451, 0x564E, 0x4C41, 0x5852, 0x4541, 0x4D49, 0x5655,
+	0x4941, 0x4946, 0x4252, 0x5752, 0x4D45, 0x5454, 0x534E, 0x494F,
+	0x5345, 0x5553, 0x4745, 0x504C, 0x4E4B, 0x4D53, 0x424C, 0x5850,
+	0x544B, 0x4148, 0x4653, 0x4A57, 0x5043, 0x4D4D, 0x4543, 0x4255,
+	0x4F58, 0x4950, 0x5444, 0x4343, 0x5656, 0x5241, 0x4845, 0x4356,
+	0x4257, 0x5643, 0x4154,
+};
+static const int16_t thirdParty_disp[99] = {
+	3, 0, -99, -94, 1, 0, 0, 0, 3, -92, 1, -83,
+	1, 1, -82, 3, -74, 1, -73, 0, 1, 3, 0, -69,
+	5, 2, 0, -67, -66, -62, 4, -58, 19, -54, 0, 2,
+	2, 1, 0, 1, -52, 0, 0, 0, -51, -46, -45, 2,
+	0, 0, -44, -43, -42, -40, 0, 0, -39, 0, 0, 0,
+	0, 0, 2, 0, 5, 2, 0, -38, 0, 10, -37, 0,
+	-35, 3, -33, 1, -29, 0, 0, -27, 0, 0, -25, -22,
+	-21, -15, 0, 5, -14, 0, 0, -12, 1, 0, -11, 0,
+	-9, -2, 0,
+};
+static const uint16_t thirdParty_publisher[99] = {
+	861, 461, 483, 978, 719, 78, 529, 346, 1053, 795, 961, 643,
+	281, 1377, 382, 561, 998, 1235, 101, 760, 688, 118, 942, 622,
+	363, 1, 693, 829, 1180, 540, 663, 249, 56, 440, 400, 1072,
+	182, 936, 14, 1326, 89, 1368, 215, 363, 1271, 68, 1024, 1017,
+	657, 736, 150, 231, 471, 306, 1287, 851, 681, 1068, 1156, 709,
+	1359, 314, 750, 1156, 495, 516, 137, 1196, 744, 1090, 957, 575,
+	952, 1120, 430, 910, 842, 806, 108, 1340, 1046, 36, 416, 650,
+	886, 782, 335, 169, 867, 598, 1030, 224, 1156, 931, 453, 261,
+	200, 1128, 72,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_XBOXPUBLISHERS_DATA_H__ */
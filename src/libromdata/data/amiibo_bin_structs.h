@@ -0,0 +1,89 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * amiibo_bin_structs.h: Nintendo amiibo identification data structures.   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * amiibo-data.bin is generated from AmiiboData_data.txt by
+ * gen_amiibo_bin.py. All values are little-endian, and all
+ * offsets are relative to the start of the file.
+ *
+ * String columns contain offsets into the string table.
+ * Offset 0 is nullptr. The string table must end with
+ * a NULL terminator.
+ */
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_AMIIBO_BIN_STRUCTS_H__
+#define __ROMPROPERTIES_LIBROMDATA_AMIIBO_BIN_STRUCTS_H__
+
+#include <stdint.h>
+#include "common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * amiibo-data.bin header.
+ * All fields are in little-endian.
+ */
+#define AMIIBO_BIN_MAGIC "RP-AMIIBO-DATA\0"
+#define AMIIBO_BIN_VERSION 1
+typedef struct _AmiiboBinHeader {
+	char magic[16];			// [0x000] AMIIBO_BIN_MAGIC
+	uint32_t version;		// [0x010] AMIIBO_BIN_VERSION
+	uint32_t reserved;		// [0x014]
+
+	uint32_t strtbl_offset;		// [0x018] String table
+	uint32_t strtbl_len;		// [0x01C]
+
+	// Page 21: Character series. (uint32_t string offsets)
+	// Array index == sss, rshifted by 2.
+	uint32_t cseries_offset;	// [0x020]
+	uint32_t cseries_count;		// [0x024]
+
+	// Page 21: Characters. (AmiiboBinCharEntry)
+	// Sorted by char_id.
+	uint32_t char_offset;		// [0x028]
+	uint32_t char_count;		// [0x02C]
+
+	// Page 22: amiibo series. (uint32_t string offsets)
+	// Array index == SS.
+	uint32_t aseries_offset;	// [0x030]
+	uint32_t aseries_count;		// [0x034]
+
+	// Page 22: amiibo IDs. (AmiiboBinIdEntry)
+	// Array index == aaaa.
+	uint32_t amiibo_offset;		// [0x038]
+	uint32_t amiibo_count;		// [0x03C]
+} AmiiboBinHeader;
+ASSERT_STRUCT(AmiiboBinHeader, 0x40);
+
+/**
+ * amiibo-data.bin: Character entry.
+ */
+typedef struct _AmiiboBinCharEntry {
+	uint32_t char_id;	// [0x000] Character ID (including series ID) << 8 | variant ID
+	uint32_t name;		// [0x004] Character name (string offset)
+} AmiiboBinCharEntry;
+ASSERT_STRUCT(AmiiboBinCharEntry, 8);
+
+/**
+ * amiibo-data.bin: amiibo ID entry.
+ */
+typedef struct _AmiiboBinIdEntry {
+	uint32_t name;		// [0x000] amiibo name (string offset)
+	uint16_t release_no;	// [0x004] Release number (0 for no ordering)
+	uint8_t wave_no;	// [0x006] Wave number
+	uint8_t reserved;	// [0x007]
+} AmiiboBinIdEntry;
+ASSERT_STRUCT(AmiiboBinIdEntry, 8);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_AMIIBO_BIN_STRUCTS_H__ */
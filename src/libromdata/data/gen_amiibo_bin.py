@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###########################################################################
+# ROM Properties Page shell extension. (libromdata)                       #
+# gen_amiibo_bin.py: amiibo-data.bin generator.                           #
+#                                                                         #
+# Copyright (c) 2016-2020 by David Korth.                                 #
+# SPDX-License-Identifier: GPL-2.0-or-later                               #
+###########################################################################
+
+"""
+Generate amiibo-data.bin from AmiiboData_data.txt.
+
+Usage: gen_amiibo_bin.py AmiiboData_data.txt amiibo-data.bin AmiiboData_bin.h
+
+The input file uses the gen_lookup_tables.py format. The output
+file format is described in amiibo_bin_structs.h. A copy of the
+output file is also written to AmiiboData_bin.h, which is compiled
+into libromdata as a fallback. The generated files are committed
+to the repository, so this script only needs to be run when the
+amiibo data is modified.
+"""
+
+import os
+import struct
+import sys
+
+from gen_lookup_tables import StringTable, format_array, parse_file
+
+# NOTE: Must match amiibo_bin_structs.h.
+AMIIBO_BIN_MAGIC = b'RP-AMIIBO-DATA\0\0'
+AMIIBO_BIN_VERSION = 1
+HEADER_SIZE = 0x40
+
+def get_table(tables, name):
+	for t in tables:
+		if t.name == name:
+			return t
+	raise SystemExit('missing table: ' + name)
+
+def check_dups(t):
+	keys = [r[0] for r in t.rows]
+	if len(set(keys)) != len(keys):
+		dups = sorted(set(k for k in keys if keys.count(k) > 1))
+		raise SystemExit('table %s has duplicate keys: %s' % (
+			t.name, ', '.join('0x%X' % k for k in dups)))
+
+def array_rows(t):
+	"""Convert an array table to a list of rows indexed by key."""
+	check_dups(t)
+	rows = [None] * (max(r[0] for r in t.rows) + 1)
+	for r in t.rows:
+		rows[r[0]] = r[1]
+	return rows
+
+def write_header(data, in_filename, h_filename):
+	"""Write a copy of amiibo-data.bin as a C array."""
+	base = os.path.basename(h_filename)
+	guard = '__ROMPROPERTIES_LIBROMDATA_%s_H__' % os.path.splitext(base)[0].upper()
+
+	out = []
+	out.append('/***************************************************************************')
+	line = ' * ROM Properties Page shell extension. (libromdata)'
+	out.append(line + ' ' * max(0, 75 - len(line)) + '*')
+	line = ' * %s: Built-in copy of amiibo-data.bin.' % base
+	out.append(line + ' ' * max(0, 75 - len(line)) + '*')
+	out.append(' *                                                                         *')
+	line = ' * DO NOT EDIT! Generated by gen_amiibo_bin.py.'
+	out.append(line + ' ' * max(0, 75 - len(line)) + '*')
+	line = ' * Source: %s' % os.path.basename(in_filename)
+	out.append(line + ' ' * max(0, 75 - len(line)) + '*')
+	out.append(' *                                                                         *')
+	out.append(' * SPDX-License-Identifier: GPL-2.0-or-later                               *')
+	out.append(' ***************************************************************************/')
+	out.append('')
+	out.append('#ifndef ' + guard)
+	out.append('#define ' + guard)
+	out.append('')
+	out.append('#include <stdint.h>')
+	out.append('#include "common.h"')
+	out.append('')
+	out.append('namespace LibRomData { namespace AmiiboData_bin {')
+	out.append('')
+	out.append('// amiibo-data.bin (%d bytes)' % len(data))
+	out.append('// Sections must be 32-bit aligned.')
+	lines = format_array('uint8_t', 'amiibo_data_bin', data, 16, lambda v: '0x%02X' % v)
+	lines[0] = 'static const ALIGNED_VAR(4, uint8_t amiibo_data_bin[%d]) = {' % len(data)
+	out += lines
+	out.append('')
+	out.append('} }')
+	out.append('')
+	out.append('#endif /* %s */' % guard)
+
+	with open(h_filename, 'w', encoding='utf-8', newline='\n') as f:
+		f.write('\n'.join(out) + '\n')
+
+def generate(in_filename, out_filename, h_filename):
+	library, namespace, msgctxt, notranslate, tables = parse_file(in_filename)
+	strtbl = StringTable()
+
+	# Character series: uint32_t[]
+	cseries = array_rows(get_table(tables, 'char_series_names'))
+	cseries_data = b''.join(struct.pack('<I', strtbl.add(r[0]) if r else 0) for r in cseries)
+
+	# Characters: AmiiboBinCharEntry[], sorted by char_id
+	t = get_table(tables, 'char_ids')
+	check_dups(t)
+	chars = sorted(t.rows, key=lambda r: r[0])
+	char_data = b''.join(struct.pack('<II', r[0], strtbl.add(r[1][0])) for r in chars)
+
+	# amiibo series: uint32_t[]
+	aseries = array_rows(get_table(tables, 'amiibo_series_names'))
+	aseries_data = b''.join(struct.pack('<I', strtbl.add(r[0]) if r else 0) for r in aseries)
+
+	# amiibo IDs: AmiiboBinIdEntry[]
+	amiibos = array_rows(get_table(tables, 'amiibo_ids'))
+	amiibo_data = b''.join(
+		struct.pack('<IHBB', strtbl.add(r[2]), r[0], r[1], 0) if r else bytes(8)
+		for r in amiibos)
+
+	# Section layout. All sections are 4-byte aligned.
+	sections = [cseries_data, char_data, aseries_data, amiibo_data, bytes(strtbl.blob)]
+	offsets = []
+	pos = HEADER_SIZE
+	for s in sections:
+		offsets.append(pos)
+		pos += (len(s) + 3) & ~3
+
+	header = AMIIBO_BIN_MAGIC + struct.pack('<II', AMIIBO_BIN_VERSION, 0)
+	header += struct.pack('<II', offsets[4], len(strtbl.blob))
+	header += struct.pack('<II', offsets[0], len(cseries))
+	header += struct.pack('<II', offsets[1], len(chars))
+	header += struct.pack('<II', offsets[2], len(aseries))
+	header += struct.pack('<II', offsets[3], len(amiibos))
+	assert len(header) == HEADER_SIZE
+
+	out = bytearray(header)
+	for s in sections:
+		out += s
+		out += bytes(-len(s) & 3)
+
+	with open(out_filename, 'wb') as f:
+		f.write(out)
+	write_header(out, in_filename, h_filename)
+
+if __name__ == '__main__':
+	if len(sys.argv) != 4:
+		sys.stderr.write('Usage: %s AmiiboData_data.txt amiibo-data.bin AmiiboData_bin.h\n' % sys.argv[0])
+		sys.exit(1)
+	generate(sys.argv[1], sys.argv[2], sys.argv[3])
@@ -0,0 +1,379 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+###########################################################################
+# ROM Properties Page shell extension. (libromdata)                       #
+# gen_lookup_tables.py: Lookup table generator.                           #
+#                                                                         #
+# Copyright (c) 2016-2020 by David Korth.                                 #
+# SPDX-License-Identifier: GPL-2.0-or-later                               #
+###########################################################################
+
+"""
+Generate packed lookup tables from *_data.txt files.
+
+Usage: gen_lookup_tables.py Module_data.txt [...]
+Each Module_data.txt file is converted to Module_data.h in the same
+directory. The generated headers are committed to the repository,
+so this script only needs to be run when a table is modified.
+
+Input format:
+- Comments start with '#'. Blank lines are ignored.
+- Fields are separated by one or more tabs. A field starting
+  with '#' starts a comment.
+- %library Name
+  Library namespace. (default is LibRomData)
+- %namespace Name
+  C++ namespace for the generated tables. (nested in the library namespace)
+- %msgctxt Context
+  Strings are translatable using the specified context.
+  A NOP_C_() block is emitted for xgettext.
+- %notranslate String
+  Don't mark the specified string as translatable.
+- %table name kind key:type column:type [column:type...]
+  Start a table. kind is one of:
+  - hash: Minimal perfect hash over the keys.
+  - array: Directly-indexed array. (key == index; gaps are zeroed)
+  Types: u8, u16, u32, str
+- %end
+  End a table.
+
+Keys and integer columns can be decimal, hex (0x...), multi-character
+literals ('AB' == 0x4142), or NAME=value, which emits a static_assert()
+that NAME == value.
+
+String columns: '-' is nullptr. All strings in a file are stored in
+a single NULL-separated blob, and string columns contain offsets into
+that blob. Offset 0 is reserved for nullptr.
+"""
+
+import os
+import sys
+
+# NOTE: Must match PerfectHash::hash() in librpbase/PerfectHash.hpp.
+def phash(key, seed):
+	x = (key ^ ((seed * 0x9E3779B9) & 0xFFFFFFFF)) & 0xFFFFFFFF
+	x ^= x >> 16
+	x = (x * 0x85EBCA6B) & 0xFFFFFFFF
+	x ^= x >> 13
+	x = (x * 0xC2B2AE35) & 0xFFFFFFFF
+	x ^= x >> 16
+	return x
+
+INT_TYPES = {
+	'u8':  ('uint8_t',  0xFF),
+	'u16': ('uint16_t', 0xFFFF),
+	'u32': ('uint32_t', 0xFFFFFFFF),
+}
+
+class ParseError(Exception):
+	pass
+
+class Table:
+	def __init__(self, name, kind, key, columns):
+		self.name = name
+		self.kind = kind
+		self.key = key			# (name, type)
+		self.columns = columns		# [(name, type), ...]
+		self.rows = []			# [(key, [values...]), ...]
+		self.asserts = []		# [(symbol, value), ...]
+
+def parse_int(s, asserts):
+	"""Parse an integer field."""
+	if '=' in s:
+		sym, val = s.split('=', 1)
+		v = parse_int(val.strip(), asserts)
+		asserts.append((sym.strip(), v))
+		return v
+	if len(s) >= 3 and s[0] == "'" and s[-1] == "'":
+		v = 0
+		for c in s[1:-1].encode('utf-8'):
+			v = (v << 8) | c
+		return v
+	return int(s, 0)
+
+def parse_file(filename):
+	"""Parse a *_data.txt file."""
+	library = 'LibRomData'
+	namespace = None
+	msgctxt = None
+	notranslate = set()
+	tables = []
+	table = None
+
+	with open(filename, 'r', encoding='utf-8') as f:
+		for lineno, line in enumerate(f, 1):
+			line = line.rstrip('\r\n')
+			stripped = line.strip()
+			if not stripped or stripped.startswith('#'):
+				continue
+
+			try:
+				if stripped.startswith('%'):
+					args = stripped.split()
+					cmd = args[0]
+					if cmd == '%library':
+						library = args[1]
+					elif cmd == '%namespace':
+						namespace = args[1]
+					elif cmd == '%msgctxt':
+						msgctxt = stripped[len(cmd):].strip()
+					elif cmd == '%notranslate':
+						notranslate.add(stripped[len(cmd):].strip())
+					elif cmd == '%table':
+						if table:
+							raise ParseError('nested %table')
+						if args[2] not in ('hash', 'array'):
+							raise ParseError('invalid table kind: ' + args[2])
+						fields = [tuple(a.split(':')) for a in args[3:]]
+						for fname, ftype in fields:
+							if ftype != 'str' and ftype not in INT_TYPES:
+								raise ParseError('invalid type: ' + ftype)
+						if fields[0][1] == 'str':
+							raise ParseError('key cannot be a string')
+						table = Table(args[1], args[2], fields[0], fields[1:])
+					elif cmd == '%end':
+						if not table:
+							raise ParseError('%end without %table')
+						tables.append(table)
+						table = None
+					else:
+						raise ParseError('unknown directive: ' + cmd)
+					continue
+
+				if not table:
+					raise ParseError('row outside of %table')
+				fields = []
+				for x in line.split('\t'):
+					x = x.strip()
+					if x.startswith('#'):
+						break
+					elif x:
+						fields.append(x)
+				if len(fields) != len(table.columns) + 1:
+					raise ParseError('expected %d fields, got %d' % (len(table.columns) + 1, len(fields)))
+				key = parse_int(fields[0], table.asserts)
+				if key > INT_TYPES[table.key[1]][1]:
+					raise ParseError('key is out of range')
+				values = []
+				for (cname, ctype), val in zip(table.columns, fields[1:]):
+					if ctype == 'str':
+						values.append(None if val == '-' else val)
+					else:
+						v = parse_int(val, table.asserts)
+						if v > INT_TYPES[ctype][1]:
+							raise ParseError('value is out of range for column ' + cname)
+						values.append(v)
+				table.rows.append((key, values))
+			except (ParseError, ValueError, IndexError) as e:
+				raise SystemExit('%s:%d: %s' % (filename, lineno, e))
+
+	if table:
+		raise SystemExit('%s: missing %%end' % filename)
+	if not namespace:
+		raise SystemExit('%s: missing %%namespace' % filename)
+	return library, namespace, msgctxt, notranslate, tables
+
+def build_perfect_hash(keys):
+	"""
+	Build a minimal perfect hash using "hash, displace, and compress".
+	Reference: http://stevehanov.ca/blog/index.php?id=119
+	:return: (slots, disp) slots[i] is the key index for slot i.
+	"""
+	n = len(keys)
+	buckets = [[] for _ in range(n)]
+	for i, k in enumerate(keys):
+		buckets[phash(k, 0) % n].append(i)
+	order = sorted(range(n), key=lambda b: -len(buckets[b]))
+
+	slots = [None] * n
+	disp = [0] * n
+	for b in order:
+		bucket = buckets[b]
+		if len(bucket) <= 1:
+			break
+		d = 1
+		while True:
+			used = set()
+			for i in bucket:
+				s = phash(keys[i], d) % n
+				if slots[s] is not None or s in used:
+					break
+				used.add(s)
+			else:
+				break
+			d += 1
+			if d > 0x7FFF:
+				raise SystemExit('Unable to find a displacement value.')
+		disp[b] = d
+		for i in bucket:
+			slots[phash(keys[i], d) % n] = i
+
+	# Buckets with one key are placed in the remaining slots directly.
+	free = [s for s in range(n) if slots[s] is None]
+	for b in order:
+		bucket = buckets[b]
+		if len(bucket) != 1:
+			continue
+		s = free.pop()
+		disp[b] = -s - 1
+		slots[s] = bucket[0]
+	return slots, disp
+
+class StringTable:
+	def __init__(self):
+		self.blob = bytearray(b'\0')	# Offset 0 == nullptr
+		self.offsets = {}
+		self.strings = []
+
+	def add(self, s):
+		if s is None:
+			return 0
+		if s in self.offsets:
+			return self.offsets[s]
+		off = len(self.blob)
+		self.offsets[s] = off
+		self.strings.append(s)
+		self.blob += s.encode('utf-8') + b'\0'
+		return off
+
+def c_string(s):
+	"""Convert a string to a C string literal. (octal escapes for non-ASCII)"""
+	out = []
+	for c in s.encode('utf-8'):
+		if c == ord('"') or c == ord('\\'):
+			out.append('\\' + chr(c))
+		elif c < 0x20 or c >= 0x7F:
+			out.append('\\%03o' % c)
+		else:
+			out.append(chr(c))
+	return '"' + ''.join(out) + '\\0"'
+
+def format_array(ctype, name, values, per_line, fmt):
+	lines = ['static const %s %s[%d] = {' % (ctype, name, len(values))]
+	for i in range(0, len(values), per_line):
+		lines.append('\t' + ', '.join(fmt(v) for v in values[i:i+per_line]) + ',')
+	lines.append('};')
+	return lines
+
+def generate(filename):
+	library, namespace, msgctxt, notranslate, tables = parse_file(filename)
+	base = os.path.basename(filename)
+	out_filename = os.path.splitext(filename)[0] + '.h'
+	guard = '__ROMPROPERTIES_%s_%s_H__' % (library.upper(), os.path.splitext(base)[0].upper())
+
+	strtbl = StringTable()
+	body = []
+	for t in tables:
+		keys = [r[0] for r in t.rows]
+		if len(set(keys)) != len(keys):
+			dups = sorted(set(k for k in keys if keys.count(k) > 1))
+			raise SystemExit('%s: table %s has duplicate keys: %s' % (
+				filename, t.name, ', '.join('0x%X' % k for k in dups)))
+
+		if t.kind == 'hash':
+			slots, disp = build_perfect_hash(keys)
+			rows = [t.rows[i] for i in slots]
+		else:
+			size = max(keys) + 1
+			rows = [None] * size
+			for r in t.rows:
+				rows[r[0]] = r
+			rows = [r if r else (i, [None if c[1] == 'str' else 0 for c in t.columns])
+				for i, r in enumerate(rows)]
+
+		# Add the strings first so the offset type is known.
+		for r in t.rows:
+			for (cname, ctype), v in zip(t.columns, r[1]):
+				if ctype == 'str':
+					strtbl.add(v)
+		t._rows = rows
+		if t.kind == 'hash':
+			t._disp = disp
+
+	off_type = 'uint16_t' if len(strtbl.blob) <= 0x10000 else 'uint32_t'
+	if len(strtbl.blob) > 65535:
+		# MSVC has a 65,535-byte limit for string literals. (C2026)
+		raise SystemExit('%s: string table is too large.' % filename)
+
+	for t in tables:
+		rows = t._rows
+		n = len(rows)
+		body.append('')
+		body.append('/** %s: %s table (%d entries) **/' % (t.name,
+			'Perfect hash' if t.kind == 'hash' else 'Array', n))
+		for sym, val in t.asserts:
+			body.append('static_assert(%s == 0x%X, "%s has changed.");' % (sym, val, sym))
+		if t.kind == 'hash':
+			ktype = INT_TYPES[t.key[1]][0]
+			body += format_array(ktype, t.name + '_keys', [r[0] for r in rows], 8,
+				lambda v: '0x%X' % v)
+			dtype = 'int16_t'
+			body += format_array(dtype, t.name + '_disp', t._disp, 12, str)
+		else:
+			body.append('static const unsigned int %s_count = %d;' % (t.name, n))
+		for ci, (cname, ctype) in enumerate(t.columns):
+			if ctype == 'str':
+				body += format_array(off_type, '%s_%s' % (t.name, cname),
+					[strtbl.offsets[r[1][ci]] if r[1][ci] is not None else 0 for r in rows],
+					12, str)
+			else:
+				body += format_array(INT_TYPES[ctype][0], '%s_%s' % (t.name, cname),
+					[r[1][ci] for r in rows], 12, str)
+
+	out = []
+	out.append('/***************************************************************************')
+	line = ' * ROM Properties Page shell extension. (%s)' % library.lower()
+	out.append(line + ' ' * max(0, 75 - len(line)) + '*')
+	line = ' * %s: Generated lookup tables.' % os.path.basename(out_filename)
+	out.append(line + ' ' * max(0, 75 - len(line)) + '*')
+	out.append(' *                                                                         *')
+	line = ' * DO NOT EDIT! Generated by gen_lookup_tables.py.'
+	out.append(line + ' ' * max(0, 75 - len(line)) + '*')
+	line = ' * Source: %s' % base
+	out.append(line + ' ' * max(0, 75 - len(line)) + '*')
+	out.append(' *                                                                         *')
+	out.append(' * SPDX-License-Identifier: GPL-2.0-or-later                               *')
+	out.append(' ***************************************************************************/')
+	out.append('')
+	out.append('#ifndef ' + guard)
+	out.append('#define ' + guard)
+	out.append('')
+	out.append('#include "librpbase/PerfectHash.hpp"')
+	out.append('')
+	out.append('namespace %s { namespace %s {' % (library, namespace))
+	out.append('')
+	out.append('namespace PerfectHash = LibRpBase::PerfectHash;')
+	out.append('')
+	out.append('// String table. (%d bytes)' % len(strtbl.blob))
+	out.append('// Offset 0 is nullptr.')
+	out.append('static const char strtbl[] =')
+	out.append('\t' + c_string(''))
+	for s in strtbl.strings:
+		out.append('\t' + c_string(s))
+	out[-1] += ';'
+	out += body
+	out.append('')
+	out.append('} }')
+
+	if msgctxt:
+		out.append('')
+		out.append('// Translatable strings. (for xgettext only)')
+		out.append('#if 0')
+		for s in strtbl.strings:
+			if s in notranslate:
+				continue
+			out.append('NOP_C_("%s", "%s");' % (msgctxt, s.replace('\\', '\\\\').replace('"', '\\"')))
+		out.append('#endif')
+
+	out.append('')
+	out.append('#endif /* %s */' % guard)
+
+	with open(out_filename, 'w', encoding='utf-8', newline='\n') as f:
+		f.write('\n'.join(out) + '\n')
+
+if __name__ == '__main__':
+	if len(sys.argv) < 2:
+		sys.stderr.write('Usage: %s Module_data.txt [...]\n' % sys.argv[0])
+		sys.exit(1)
+	for arg in sys.argv[1:]:
+		generate(arg)
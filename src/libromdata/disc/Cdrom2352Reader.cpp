@@ -40,6 +40,11 @@ class Cdrom2352ReaderPrivate : public SparseDiscReaderPrivate {
 
 		// Number of 2352-byte blocks.
 		unsigned int blockCount;
+
+		// Raw sector buffer for readBlocks(). (Allocated on first use.)
+		// 32 sectors is ~73 KiB per read.
+		static const unsigned int BATCH_SECTORS = 32;
+		ao::uvector<CDROM_2352_Sector_t> sectorBuf;
 };
 
 /** Cdrom2352ReaderPrivate **/
@@ -177,7 +182,7 @@ int Cdrom2352Reader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t siz
 	// determine the data offset, since Mode 1 and Mode 2 XA have different
 	// sector layouts.
 	CDROM_2352_Sector_t sector;
-	size_t sz_read = m_file->seekAndRead(physBlockAddr, &sector, sizeof(sector));
+	size_t sz_read = m_file->pread(physBlockAddr, &sector, sizeof(sector));
 	m_lastError = m_file->lastError();
 	if (sz_read != sizeof(sector)) {
 		// Read error.
@@ -190,4 +195,72 @@ int Cdrom2352Reader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t siz
 	return size;
 }
 
+/**
+ * Read multiple full blocks.
+ *
+ * The raw sectors are read in batches, and the user data
+ * is extracted from each sector based on its mode.
+ *
+ * @param blockIdx	[in] First block index.
+ * @param count		[in] Maximum number of blocks to read. (at least 2)
+ * @param ptr		[out] Output buffer. (count * block_size bytes)
+ * @return Number of blocks read; 0 if not supported; -1 on error.
+ */
+int Cdrom2352Reader::readBlocks(uint32_t blockIdx, unsigned int count, uint8_t *ptr)
+{
+	RP_D(Cdrom2352Reader);
+	assert(d->block_size == 2048);
+	if (blockIdx >= d->blockCount) {
+		// Out of range.
+		return -1;
+	}
+
+	// Don't read past the end of the disc.
+	// Limit the total to 1 GB so the return value fits in an int.
+	if (count > d->blockCount - blockIdx) {
+		count = d->blockCount - blockIdx;
+	}
+	const unsigned int maxCount = (1U << 30) / 2048;
+	if (count > maxCount) {
+		count = maxCount;
+	}
+
+	if (d->sectorBuf.empty()) {
+		d->sectorBuf.resize(Cdrom2352ReaderPrivate::BATCH_SECTORS);
+	}
+	const CDROM_2352_Sector_t *const pSectors = d->sectorBuf.data();
+
+	unsigned int blocksRead = 0;
+	while (blocksRead < count) {
+		unsigned int batch = count - blocksRead;
+		if (batch > Cdrom2352ReaderPrivate::BATCH_SECTORS) {
+			batch = Cdrom2352ReaderPrivate::BATCH_SECTORS;
+		}
+
+		// Read the raw sectors.
+		const off64_t physBlockAddr = static_cast<off64_t>(blockIdx + blocksRead) * d->physBlockSize;
+		const size_t sz_batch = static_cast<size_t>(batch) * sizeof(CDROM_2352_Sector_t);
+		const size_t sz_read = m_file->pread(physBlockAddr, d->sectorBuf.data(), sz_batch);
+		if (sz_read != sz_batch) {
+			// Read error.
+			m_lastError = m_file->lastError();
+			if (m_lastError == 0) {
+				m_lastError = EIO;
+			}
+			return (blocksRead > 0 ? static_cast<int>(blocksRead) : -1);
+		}
+
+		// Extract the user data from each sector.
+		// NOTE: Sector user data area position depends on the sector mode.
+		// Mode 2 Form 1 and Form 2 both have the user data at the same
+		// offset, so only the mode byte needs to be checked.
+		for (unsigned int i = 0; i < batch; i++, ptr += 2048) {
+			memcpy(ptr, cdromSectorDataPtr(&pSectors[i]), 2048);
+		}
+		blocksRead += batch;
+	}
+
+	return static_cast<int>(blocksRead);
+}
+
 }
@@ -75,6 +75,19 @@ class Cdrom2352Reader : public LibRpBase::SparseDiscReader
 		 */
 		ATTR_ACCESS_SIZE(write_only, 4, 5)
 		int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size) final;
+
+		/**
+		 * Read multiple full blocks.
+		 *
+		 * The raw sectors are read in batches, and the user data
+		 * is extracted from each sector based on its mode.
+		 *
+		 * @param blockIdx	[in] First block index.
+		 * @param count		[in] Maximum number of blocks to read. (at least 2)
+		 * @param ptr		[out] Output buffer. (count * block_size bytes)
+		 * @return Number of blocks read; 0 if not supported; -1 on error.
+		 */
+		int readBlocks(uint32_t blockIdx, unsigned int count, uint8_t *ptr) final;
 };
 
 }
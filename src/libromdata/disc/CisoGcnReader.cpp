@@ -21,6 +21,7 @@ using LibRpFile::IRpFile;
 
 // C++ STL classes.
 using std::array;
+using std::unique_ptr;
 
 namespace LibRomData {
 
@@ -33,13 +34,16 @@ class CisoGcnReaderPrivate : public SparseDiscReaderPrivate {
 		RP_DISABLE_COPY(CisoGcnReaderPrivate)
 
 	public:
-		// CISO header.
-		CISOHeader cisoHeader;
+		// Block map, stored as a bitmap.
+		// Bit (i % 32) of word (i / 32) is set if logical block i is used.
+		// Used blocks are stored in order after the CISO header.
+		static const unsigned int BLOCK_MAP_WORDS = (CISO_MAP_SIZE + 31) / 32;
+		array<uint32_t, BLOCK_MAP_WORDS> blockBitmap;
 
-		// Block map.
-		// 0x0000 == first block after CISO header.
-		// 0xFFFF == empty block.
-		array<uint16_t, CISO_MAP_SIZE> blockMap;
+		// Number of used blocks before each blockBitmap word.
+		// The physical block index is this value plus the number
+		// of used blocks before the logical block in its word.
+		array<uint16_t, BLOCK_MAP_WORDS> blockPrefix;
 
 		// Index of the last used block.
 		int maxLogicalBlockUsed;
@@ -51,10 +55,9 @@ CisoGcnReaderPrivate::CisoGcnReaderPrivate(CisoGcnReader *q)
 	: super(q)
 	, maxLogicalBlockUsed(-1)
 {
-	// Clear the CISO header struct.
-	memset(&cisoHeader, 0, sizeof(cisoHeader));
 	// Clear the CISO block map initially.
-	blockMap.fill(0xFFFF);
+	blockBitmap.fill(0);
+	blockPrefix.fill(0);
 }
 
 /** CisoGcnReader **/
@@ -68,12 +71,14 @@ CisoGcnReader::CisoGcnReader(IRpFile *file)
 	}
 
 	// Read the CISO header.
+	// NOTE: Only the block map is kept after parsing the header.
 	RP_D(CisoGcnReader);
 	static_assert(sizeof(CISOHeader) == CISO_HEADER_SIZE,
 		"CISOHeader is the wrong size. (Should be 32,768 bytes.)");
+	unique_ptr<CISOHeader> cisoHeader(new CISOHeader);
 	m_file->rewind();
-	size_t sz = m_file->read(&d->cisoHeader, sizeof(d->cisoHeader));
-	if (sz != sizeof(d->cisoHeader)) {
+	size_t sz = m_file->read(cisoHeader.get(), sizeof(*cisoHeader));
+	if (sz != sizeof(*cisoHeader)) {
 		// Error reading the CISO header.
 		UNREF_AND_NULL_NOCHK(m_file);
 		m_lastError = EIO;
@@ -81,7 +86,7 @@ CisoGcnReader::CisoGcnReader(IRpFile *file)
 	}
 
 	// Verify the CISO header.
-	if (d->cisoHeader.magic != cpu_to_be32(CISO_MAGIC)) {
+	if (cisoHeader->magic != cpu_to_be32(CISO_MAGIC)) {
 		// Invalid magic.
 		UNREF_AND_NULL_NOCHK(m_file);
 		m_lastError = EIO;
@@ -91,7 +96,7 @@ CisoGcnReader::CisoGcnReader(IRpFile *file)
 	// Check if the block size is a supported power of two.
 	// - Minimum: CISO_BLOCK_SIZE_MIN (32 KB, 1 << 15)
 	// - Maximum: CISO_BLOCK_SIZE_MAX (16 MB, 1 << 24)
-	d->block_size = le32_to_cpu(d->cisoHeader.block_size);
+	d->block_size = le32_to_cpu(cisoHeader->block_size);
 	if (!isPow2(d->block_size) ||
 	    d->block_size < CISO_BLOCK_SIZE_MIN || d->block_size > CISO_BLOCK_SIZE_MAX)
 	{
@@ -105,23 +110,32 @@ CisoGcnReader::CisoGcnReader(IRpFile *file)
 	}
 
 	// Parse the CISO block map.
-	uint16_t physBlockIdx = 0;
-	for (int i = 0; i < static_cast<int>(d->blockMap.size()); i++) {
-		switch (d->cisoHeader.map[i]) {
-			case 0:
-				// Empty block.
-				continue;
-			case 1:
-				// Used block.
-				d->blockMap[i] = physBlockIdx;
-				physBlockIdx++;
-				d->maxLogicalBlockUsed = i;
-				break;
-			default:
-				// Invalid entry.
-				UNREF_AND_NULL_NOCHK(m_file);
-				m_lastError = EIO;
-				return;
+	// Each map entry is 0 (empty) or 1 (used), so they can
+	// be packed directly into the bitmap.
+	unsigned int physBlockCount = 0;
+	for (unsigned int w = 0; w < CisoGcnReaderPrivate::BLOCK_MAP_WORDS; w++) {
+		const unsigned int base = w * 32;
+		const unsigned int count = std::min(32U, static_cast<unsigned int>(CISO_MAP_SIZE) - base);
+		const uint8_t *const pMap = &cisoHeader->map[base];
+
+		uint8_t invalid = 0;
+		uint32_t bits = 0;
+		for (unsigned int i = 0; i < count; i++) {
+			invalid |= pMap[i];
+			bits |= static_cast<uint32_t>(pMap[i] & 1) << i;
+		}
+		if (invalid > 1) {
+			// Invalid entry.
+			UNREF_AND_NULL_NOCHK(m_file);
+			m_lastError = EIO;
+			return;
+		}
+
+		d->blockBitmap[w] = bits;
+		d->blockPrefix[w] = static_cast<uint16_t>(physBlockCount);
+		if (bits != 0) {
+			physBlockCount += popcount(bits);
+			d->maxLogicalBlockUsed = static_cast<int>(base + uilog2(bits));
 		}
 	}
 
@@ -194,21 +208,26 @@ off64_t CisoGcnReader::getPhysBlockAddr(uint32_t blockIdx) const
 	// Make sure the block index is in range.
 	// TODO: Check against maxLogicalBlockUsed?
 	RP_D(const CisoGcnReader);
-	assert(blockIdx < d->blockMap.size());
-	if (blockIdx >= d->blockMap.size()) {
+	assert(blockIdx < CISO_MAP_SIZE);
+	if (blockIdx >= CISO_MAP_SIZE) {
 		// Out of range.
 		return -1;
 	}
 
-	// Get the physical block index.
-	const unsigned int physBlockIdx = d->blockMap[blockIdx];
-	if (physBlockIdx >= 0xFFFF) {
+	// Check if the block is used.
+	const uint32_t bits = d->blockBitmap[blockIdx / 32];
+	const uint32_t mask = (1U << (blockIdx % 32));
+	if (!(bits & mask)) {
 		// Empty block.
 		return 0;
 	}
 
+	// Get the physical block index.
+	const unsigned int physBlockIdx = d->blockPrefix[blockIdx / 32] +
+		popcount(bits & (mask - 1));
+
 	// Convert to a physical block address and return.
-	return static_cast<off64_t>(sizeof(d->cisoHeader)) +
+	return static_cast<off64_t>(CISO_HEADER_SIZE) +
 	      (static_cast<off64_t>(physBlockIdx) * d->block_size);
 }
 
@@ -17,6 +17,11 @@
 #include "librpbase/disc/SparseDiscReader_p.hpp"
 #include "ciso_psp_structs.h"
 
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
 // zlib
 #include <zlib.h>
 #ifdef _MSC_VER
@@ -94,22 +99,63 @@ class CisoPspReaderPrivate : public SparseDiscReaderPrivate {
 		// High bit interpretation depends on CISO version.
 		// - v0/v1: If set, block is not compressed.
 		// - v2: If set, block is compressed using LZ4; otherwise, deflate.
-		ao::uvector<uint32_t> indexEntries;
-
-		// DAX: Size and NC area tables.
-		ao::uvector<uint16_t> daxSizeTable;
-		std::vector<uint8_t> daxNCTable;	// 0 = compressed; 1 = not compressed
+		// NOTE: The index table is not loaded at once. It's read
+		// on demand in pages using readIndexTbl().
+		uint32_t indexTblPos;		// Index table starting address.
+		uint32_t indexTblSize;		// Index table size, in bytes. (Includes the DAX size table.)
+		uint32_t indexEntryCount;	// Number of index entries.
+		uint32_t num_blocks;		// Number of blocks.
+
+		// DAX: NC areas. (host-endian; sorted by starting block)
+		// The size table immediately follows the index entries,
+		// and is paged in along with them.
+		ao::uvector<DaxNCArea> daxNCAreas;
 
 		bool isDaxWithoutNCTable;	// Convenience variable.
 		uint8_t index_shift;		// Index shift value.
 
-		// Block cache.
-		ao::uvector<uint8_t> blockCache;
-		uint32_t blockCacheIdx;
+		/** Index table page cache. **/
+
+		// Page size, in bytes. Each page covers 512 index entries.
+		static const unsigned int INDEX_PAGE_SIZE = 2048;
+		// Number of pages to cache.
+		static const unsigned int INDEX_PAGE_CACHE_COUNT = 8;
+
+		struct IndexPage {
+			uint32_t pageNum;	// Page number. (~0U == unused)
+			uint32_t lastUsed;	// indexPageTick value when last used.
+			uint8_t data[INDEX_PAGE_SIZE];
+		};
+		mutable IndexPage indexPages[INDEX_PAGE_CACHE_COUNT];
+		mutable uint32_t indexPageTick;	// LRU counter.
+
+		// decodeRawBlock() may be called from multiple threads.
+		mutable Mutex indexMutex;
 
-		// Decompression buffer.
-		// (Same size as blockCache.)
-		ao::uvector<uint8_t> z_buffer;
+		/**
+		 * Read data from the index table, using the page cache.
+		 * The data must not cross a page boundary.
+		 * @param offset	[in] Offset in the index table.
+		 * @param pDest		[out] Destination buffer.
+		 * @param size		[in] Size to read.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int readIndexTbl(uint32_t offset, void *pDest, unsigned int size) const;
+
+		/**
+		 * Get an index entry.
+		 * @param idx	[in] Index entry number.
+		 * @param entry	[out] Index entry. (host-endian)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int getIndexEntry(uint32_t idx, uint32_t &entry) const;
+
+		/**
+		 * Is a DAX block in an NC (non-compressed) area?
+		 * @param blockNum Block number.
+		 * @return True if the block is not compressed; false if it is.
+		 */
+		bool isDaxNCBlock(uint32_t blockNum) const;
 
 		/**
 		 * Get the compressed size of a block.
@@ -117,6 +163,28 @@ class CisoPspReaderPrivate : public SparseDiscReaderPrivate {
 		 * @return Block's compressed size, or 0 on error.
 		 */
 		uint32_t getBlockCompressedSize(uint32_t blockNum) const;
+
+		enum class CompressionMode {
+			None = 0,
+			Deflate = 1,
+			LZ4 = 2,
+			LZO = 3,
+		};
+
+		struct BlockInfo {
+			off64_t physBlockAddr;		// Physical address of the block data.
+			uint32_t z_block_size;		// Compressed size.
+			CompressionMode z_mode;		// Compression mode.
+			int windowBits;			// zlib window bits. (Deflate only)
+		};
+
+		/**
+		 * Get information about a block.
+		 * @param blockIdx	[in] Block index.
+		 * @param info		[out] Block information.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int getBlockInfo(uint32_t blockIdx, BlockInfo &info) const;
 };
 
 /** CisoPspReaderPrivate **/
@@ -124,12 +192,129 @@ class CisoPspReaderPrivate : public SparseDiscReaderPrivate {
 CisoPspReaderPrivate::CisoPspReaderPrivate(CisoPspReader *q)
 	: super(q)
 	, cisoType(CisoType::Unknown)
+	, indexTblPos(0)
+	, indexTblSize(0)
+	, indexEntryCount(0)
+	, num_blocks(0)
 	, isDaxWithoutNCTable(false)
 	, index_shift(0)
-	, blockCacheIdx(~0U)
+	, indexPageTick(0)
 {
 	// Clear the header structs.
 	memset(&header, 0, sizeof(header));
+
+	// Mark all index pages as unused.
+	for (IndexPage &page : indexPages) {
+		page.pageNum = ~0U;
+		page.lastUsed = 0;
+	}
+}
+
+/**
+ * Read data from the index table, using the page cache.
+ * The data must not cross a page boundary.
+ * @param offset	[in] Offset in the index table.
+ * @param pDest		[out] Destination buffer.
+ * @param size		[in] Size to read.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CisoPspReaderPrivate::readIndexTbl(uint32_t offset, void *pDest, unsigned int size) const
+{
+	const uint32_t pageNum = offset / INDEX_PAGE_SIZE;
+	const unsigned int pageOffset = offset % INDEX_PAGE_SIZE;
+	assert(pageOffset + size <= INDEX_PAGE_SIZE);
+	assert(offset + size <= indexTblSize);
+	if (pageOffset + size > INDEX_PAGE_SIZE || offset + size > indexTblSize) {
+		// Out of range.
+		return -EINVAL;
+	}
+
+	MutexLocker locker(indexMutex);
+
+	// Check if the page is already cached.
+	// If it isn't, replace the least-recently-used page.
+	IndexPage *pPage = nullptr;
+	IndexPage *pLRU = &indexPages[0];
+	for (IndexPage &page : indexPages) {
+		if (page.pageNum == pageNum) {
+			pPage = &page;
+			break;
+		}
+		if (page.pageNum == ~0U) {
+			// Unused page. Prefer this over evicting a used page.
+			if (pLRU->pageNum != ~0U) {
+				pLRU = &page;
+			}
+		} else if (pLRU->pageNum != ~0U && page.lastUsed < pLRU->lastUsed) {
+			pLRU = &page;
+		}
+	}
+
+	if (!pPage) {
+		// Read the page from the file.
+		// NOTE: The last page may be smaller than INDEX_PAGE_SIZE.
+		RP_Q(const CisoPspReader);
+		const uint32_t pageStart = pageNum * INDEX_PAGE_SIZE;
+		const size_t pageSize = std::min(static_cast<uint32_t>(INDEX_PAGE_SIZE), indexTblSize - pageStart);
+		pLRU->pageNum = ~0U;
+		size_t sz = q->m_file->pread(indexTblPos + pageStart, pLRU->data, pageSize);
+		if (sz != pageSize) {
+			// Read error.
+			int err = q->m_file->lastError();
+			if (err == 0) {
+				err = EIO;
+			}
+			return -err;
+		}
+		pPage = pLRU;
+		pPage->pageNum = pageNum;
+	}
+
+	pPage->lastUsed = ++indexPageTick;
+	memcpy(pDest, &pPage->data[pageOffset], size);
+	return 0;
+}
+
+/**
+ * Get an index entry.
+ * @param idx	[in] Index entry number.
+ * @param entry	[out] Index entry. (host-endian)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CisoPspReaderPrivate::getIndexEntry(uint32_t idx, uint32_t &entry) const
+{
+	assert(idx < indexEntryCount);
+	if (idx >= indexEntryCount) {
+		// Out of range.
+		return -EINVAL;
+	}
+
+	uint32_t entry_le;
+	int ret = readIndexTbl(idx * sizeof(uint32_t), &entry_le, sizeof(entry_le));
+	if (ret == 0) {
+		entry = le32_to_cpu(entry_le);
+	}
+	return ret;
+}
+
+/**
+ * Is a DAX block in an NC (non-compressed) area?
+ * @param blockNum Block number.
+ * @return True if the block is not compressed; false if it is.
+ */
+bool CisoPspReaderPrivate::isDaxNCBlock(uint32_t blockNum) const
+{
+	// Find the last NC area that starts at or before this block.
+	auto iter = std::upper_bound(daxNCAreas.cbegin(), daxNCAreas.cend(), blockNum,
+		[](uint32_t blockNum, const DaxNCArea &area) noexcept -> bool {
+			return (blockNum < area.start);
+		});
+	if (iter == daxNCAreas.cbegin()) {
+		// No NC area starts at or before this block.
+		return false;
+	}
+	--iter;
+	return (blockNum - iter->start < iter->count);
 }
 
 /**
@@ -139,9 +324,8 @@ CisoPspReaderPrivate::CisoPspReaderPrivate(CisoPspReader *q)
  */
 uint32_t CisoPspReaderPrivate::getBlockCompressedSize(uint32_t blockNum) const
 {
-	assert(!indexEntries.empty());
-	assert(blockNum < indexEntries.size());
-	if (indexEntries.empty() || blockNum >= indexEntries.size()) {
+	assert(blockNum < num_blocks);
+	if (blockNum >= num_blocks) {
 		// Out of range.
 		return 0;
 	}
@@ -157,41 +341,195 @@ uint32_t CisoPspReaderPrivate::getBlockCompressedSize(uint32_t blockNum) const
 #ifdef HAVE_LZ4
 		case CisoPspReaderPrivate::CisoType::ZISO:
 #endif /* HAVE_LZ4 */
+		case CisoPspReaderPrivate::CisoType::JISO: {
 			// Index entry table has an extra entry for the final block.
 			// Hence, we don't need the same workaround as GCZ.
-			assert(blockNum != indexEntries.size()-1);
-			if (blockNum < indexEntries.size()-1) {
-				// High bit is reserved as a flag for all CISO versions.
-				off64_t idxStart = le32_to_cpu(indexEntries[blockNum]) & ~CISO_PSP_V0_NOT_COMPRESSED;
-				off64_t idxEnd = le32_to_cpu(indexEntries[blockNum + 1]) & ~CISO_PSP_V0_NOT_COMPRESSED;
-				idxStart <<= index_shift;
-				idxEnd <<= index_shift;
-				size = static_cast<uint32_t>(idxEnd - idxStart);
+			uint32_t entryStart, entryEnd;
+			if (getIndexEntry(blockNum, entryStart) != 0 ||
+			    getIndexEntry(blockNum + 1, entryEnd) != 0)
+			{
+				// Unable to read the index entries.
+				return 0;
 			}
-			break;
 
-		case CisoPspReaderPrivate::CisoType::JISO:
-			// Index entry table has an extra entry for the final block.
-			// Hence, we don't need the same workaround as GCZ.
+			// High bit is reserved as a flag for all CISO versions.
 			// NOTE: JISO doesn't use the high bit for NC.
-			assert(blockNum != indexEntries.size()-1);
-			if (blockNum < indexEntries.size()-1) {
-				off64_t idxStart = le32_to_cpu(indexEntries[blockNum]);
-				off64_t idxEnd = le32_to_cpu(indexEntries[blockNum + 1]);
-				idxStart <<= index_shift;
-				idxEnd <<= index_shift;
-				size = static_cast<uint32_t>(idxEnd - idxStart);
+			if (cisoType != CisoPspReaderPrivate::CisoType::JISO) {
+				entryStart &= ~CISO_PSP_V0_NOT_COMPRESSED;
+				entryEnd &= ~CISO_PSP_V0_NOT_COMPRESSED;
 			}
+			const off64_t idxStart = static_cast<off64_t>(entryStart) << index_shift;
+			const off64_t idxEnd = static_cast<off64_t>(entryEnd) << index_shift;
+			size = static_cast<uint32_t>(idxEnd - idxStart);
 			break;
+		}
 
-		case CisoPspReaderPrivate::CisoType::DAX:
+		case CisoPspReaderPrivate::CisoType::DAX: {
 			// DAX uses a separate size table.
-			size = static_cast<uint32_t>(daxSizeTable[blockNum]);
+			// It's located immediately after the index entry table.
+			uint16_t size_le;
+			if (readIndexTbl((indexEntryCount * sizeof(uint32_t)) + (blockNum * sizeof(uint16_t)),
+			                 &size_le, sizeof(size_le)) != 0)
+			{
+				// Unable to read the size table entry.
+				return 0;
+			}
+			size = le16_to_cpu(size_le);
 			break;
+		}
 	}
 	return size;
 }
 
+/**
+ * Get information about a block.
+ * @param blockIdx	[in] Block index.
+ * @param info		[out] Block information.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CisoPspReaderPrivate::getBlockInfo(uint32_t blockIdx, BlockInfo &info) const
+{
+	uint32_t indexEntry;
+	int ret = getIndexEntry(blockIdx, indexEntry);
+	if (ret != 0) {
+		// Unable to read the index entry.
+		return ret;
+	}
+	info.z_block_size = getBlockCompressedSize(blockIdx);
+	info.windowBits = 0;
+	if (info.z_block_size == 0) {
+		// Unable to get the block's compressed size...
+		return -EIO;
+	}
+
+	switch (cisoType) {
+		default:
+		case CisoType::Unknown:
+			assert(!"Unsupported CisoType.");
+			return -ENOTSUP;
+
+		case CisoType::CISO:
+			// CISO uses raw deflate.
+			info.windowBits = -15;
+
+			// Mask off the compression bit, and shift the address
+			// based on the index shift.
+			info.physBlockAddr = static_cast<off64_t>(indexEntry & ~CISO_PSP_V0_NOT_COMPRESSED);
+			info.physBlockAddr <<= index_shift;
+
+			if (header.cisoPsp.version < 2) {
+				// CISO v0/v1: Check if compressed.
+				info.z_mode = (indexEntry & CISO_PSP_V0_NOT_COMPRESSED)
+					? CompressionMode::None
+					: CompressionMode::Deflate;
+
+				if (info.z_mode == CompressionMode::None) {
+					// (Un)compressed block size must match the actual block size.
+					if (info.z_block_size != block_size) {
+						// Error...
+						return -EIO;
+					}
+				}
+			} else {
+				// CISO v2: Check if compressed, and if so, which algorithm.
+				if (info.z_block_size == block_size) {
+					info.z_mode = CompressionMode::None;
+				} else {
+					info.z_mode = (indexEntry & CISO_PSP_V2_LZ4_COMPRESSED)
+						? CompressionMode::LZ4
+						: CompressionMode::Deflate;
+				}
+			}
+			break;
+
+#ifdef HAVE_LZ4
+		case CisoType::ZISO:
+			// ZISO uses LZ4.
+
+			// Mask off the compression bit, and shift the address
+			// based on the index shift.
+			info.physBlockAddr = static_cast<off64_t>(indexEntry & ~CISO_PSP_V0_NOT_COMPRESSED);
+			info.physBlockAddr <<= index_shift;
+
+			info.z_mode = (indexEntry & CISO_PSP_V0_NOT_COMPRESSED)
+				? CompressionMode::None
+				: CompressionMode::LZ4;
+			break;
+#endif /* HAVE_LZ4 */
+
+#ifdef HAVE_LZO
+		case CisoType::JISO:
+			// JISO uses LZO or zlib.
+			// TODO: Verify the rest of this.
+
+			// JISO does *not* indicate compression using the high bit.
+			// Instead, the compressed block size will match the uncompressed
+			// block size, similar to CISOv2.
+			info.physBlockAddr = static_cast<off64_t>(indexEntry);
+			info.physBlockAddr <<= index_shift;
+
+			if (header.jiso.block_headers) {
+				// Block headers are present.
+				// TODO: jiso.exe says this can provide for "faster decompression".
+				if (info.z_block_size <= 4) {
+					// Incorrect block size.
+					return -EIO;
+				}
+				info.physBlockAddr += 4;
+				info.z_block_size -= 4;
+			}
+
+			if (info.z_block_size == block_size) {
+				info.z_mode = CompressionMode::None;
+			} else {
+				switch (header.jiso.method) {
+					case JISO_METHOD_LZO:
+						info.z_mode = CompressionMode::LZO;
+						break;
+					case JISO_METHOD_ZLIB:
+						// JISO zlib uses raw deflate.
+						info.windowBits = -15;
+						info.z_mode = CompressionMode::Deflate;
+						break;
+					default:
+						assert(!"Unsupported JISO compression method.");
+						return -ENOTSUP;
+				}
+			}
+			break;
+#endif /* HAVE_LZO */
+
+		case CisoType::DAX:
+			info.physBlockAddr = static_cast<off64_t>(indexEntry);
+			if (!isDaxWithoutNCTable && isDaxNCBlock(blockIdx)) {
+				// Uncompressed block.
+				info.z_mode = CompressionMode::None;
+			} else {
+				// Compressed block.
+				// DAX uses zlib deflate.
+				info.windowBits = 15;
+				info.z_mode = CompressionMode::Deflate;
+			}
+			break;
+	}
+
+	if (info.z_mode != CompressionMode::None) {
+		uint32_t z_max_size = block_size;
+		if (unlikely(isDaxWithoutNCTable)) {
+			// DAX without NC table can end up compressing to larger
+			// than the uncompressed size.
+			z_max_size *= 2;
+		}
+		if (info.z_block_size > z_max_size) {
+			// Compressed data is larger than the uncompressed block size.
+			// This is only allowed for DAX without NC table.
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
 /** CisoPspReader **/
 
 CisoPspReader::CisoPspReader(IRpFile *file)
@@ -378,33 +716,39 @@ CisoPspReader::CisoPspReader(IRpFile *file)
 		return;
 	}
 
-	// Read the index entries.
-	// NOTE: These are byteswapped on demand, not ahead of time.
-	uint32_t num_blocks_alloc = num_blocks;
+	// Determine the index table size.
+	// NOTE: The index entries are read on demand using the page cache.
+	// Only the size is validated here.
+	d->num_blocks = num_blocks;
+	d->indexEntryCount = num_blocks;
 	switch (d->cisoType) {
 		case CisoPspReaderPrivate::CisoType::CISO:
 #ifdef HAVE_LZ4
 		case CisoPspReaderPrivate::CisoType::ZISO:
 #endif /* HAVE_LZ4 */
 		case CisoPspReaderPrivate::CisoType::JISO:
-			num_blocks_alloc++;
+			d->indexEntryCount++;
 			break;
 
 		default:
 			break;
 	}
-	d->indexEntries.resize(num_blocks_alloc);
-	size_t expected_size = num_blocks_alloc * sizeof(uint32_t);
-	size_t size = m_file->seekAndRead(indexEntryTblPos, d->indexEntries.data(), expected_size);
-	if (size != expected_size) {
-		// Read error.
-		m_lastError = m_file->lastError();
-		if (m_lastError == 0) {
-			m_lastError = EIO;
-		}
+	d->indexTblPos = indexEntryTblPos;
+	uint64_t indexTblSize = static_cast<uint64_t>(d->indexEntryCount) * sizeof(uint32_t);
+	if (d->cisoType == CisoPspReaderPrivate::CisoType::DAX) {
+		// The DAX size table immediately follows the index entry table.
+		indexTblSize += static_cast<uint64_t>(num_blocks) * sizeof(uint16_t);
+	}
+	const off64_t fileSize = m_file->size();
+	if (indexTblSize > 0xFFFFFFFFU - indexEntryTblPos ||
+	    fileSize < static_cast<off64_t>(indexEntryTblPos + indexTblSize))
+	{
+		// Index table is out of range.
 		UNREF_AND_NULL_NOCHK(m_file);
+		m_lastError = EIO;
 		return;
 	}
+	d->indexTblSize = static_cast<uint32_t>(indexTblSize);
 
 #ifdef HAVE_LZO
 	if (d->cisoType == CisoPspReaderPrivate::CisoType::JISO &&
@@ -417,27 +761,19 @@ CisoPspReader::CisoPspReader(IRpFile *file)
 
 	// TODO: NC areas for JISO.
 	if (d->cisoType == CisoPspReaderPrivate::CisoType::DAX) {
-		// Read the DAX size table.
-		d->daxSizeTable.resize(num_blocks);
-		expected_size = num_blocks * sizeof(uint16_t);
-		size = m_file->read(d->daxSizeTable.data(), expected_size);
-		if (size != expected_size) {
-			// Read error.
-			m_lastError = m_file->lastError();
-			if (m_lastError == 0) {
-				m_lastError = EIO;
-			}
-			UNREF_AND_NULL_NOCHK(m_file);
-			return;
-		}
-
 		if (d->header.dax.nc_areas > 0) {
 			// Handle the NC (non-compressed) areas.
-			// This table is stored immediately after the index entry table.
-			ao::uvector<DaxNCArea> nc_areas;
-			nc_areas.resize(d->header.dax.nc_areas);
-			expected_size = d->header.dax.nc_areas * sizeof(DaxNCArea);
-			size = m_file->read(nc_areas.data(), expected_size);
+			// This table is stored immediately after the size table.
+			if (d->header.dax.nc_areas > num_blocks) {
+				// Too many NC areas...
+				UNREF_AND_NULL_NOCHK(m_file);
+				m_lastError = EIO;
+				return;
+			}
+			d->daxNCAreas.resize(d->header.dax.nc_areas);
+			const size_t expected_size = d->header.dax.nc_areas * sizeof(DaxNCArea);
+			size_t size = m_file->seekAndRead(indexEntryTblPos + d->indexTblSize,
+				d->daxNCAreas.data(), expected_size);
 			if (size != expected_size) {
 				// Read error.
 				m_lastError = m_file->lastError();
@@ -449,30 +785,30 @@ CisoPspReader::CisoPspReader(IRpFile *file)
 			}
 
 			// Process the NC areas.
-			d->daxNCTable.resize(num_blocks);
-			const auto nc_areas_end = nc_areas.cend();
-			for (auto iter = nc_areas.cbegin(); iter != nc_areas_end; ++iter) {
-				uint32_t i = le32_to_cpu(iter->start);
-				const uint32_t end = i + le32_to_cpu(iter->count);
-				if (end > num_blocks) {
+			for (DaxNCArea &area : d->daxNCAreas) {
+				area.start = le32_to_cpu(area.start);
+				area.count = le32_to_cpu(area.count);
+				if (area.start > num_blocks || area.count > num_blocks - area.start) {
 					// Out of range...
 					m_lastError = EIO;
 					UNREF_AND_NULL_NOCHK(m_file);
 					return;
 				}
-
-				// TODO: Assert on overlapping NC areas?
-				for (; i < end; i++) {
-					d->daxNCTable[i] = true;
-				}
 			}
+
+			// Sort the NC areas by starting block for isDaxNCBlock().
+			// TODO: Assert on overlapping NC areas?
+			std::sort(d->daxNCAreas.begin(), d->daxNCAreas.end(),
+				[](const DaxNCArea &a, const DaxNCArea &b) noexcept -> bool {
+					return (a.start < b.start);
+				});
 		} else {
 			// No NC areas.
 			d->isDaxWithoutNCTable = true;
 		}
 	}
 
-	// Initialize the block cache and decompression buffer.
+	// Initialize the block cache.
 	// NOTE: Extra 64 bytes is for zlib, in case it needs it.
 	size_t cache_size = d->block_size + 64;
 	if (d->isDaxWithoutNCTable) {
@@ -481,9 +817,10 @@ CisoPspReader::CisoPspReader(IRpFile *file)
 		// more space than uncompressed.
 		cache_size *= 2;
 	}
-	d->blockCache.resize(cache_size);
-	d->z_buffer.resize(cache_size);
-	d->blockCacheIdx = ~0U;
+	// Extra blocks are cached for sequential read-ahead.
+	d->initBlockCache(SparseDiscReaderPrivate::DEFAULT_BLOCK_CACHE_COUNT +
+		SparseDiscReaderPrivate::DEFAULT_READ_AHEAD_COUNT, cache_size);
+	d->parallelLoad = true;
 
 	// Reset the disc position.
 	d->pos = 0;
@@ -678,10 +1015,10 @@ off64_t CisoPspReader::getPhysBlockAddr(uint32_t blockIdx) const
 	// Make sure the block index is in range.
 	// TODO: Check against maxLogicalBlockUsed?
 	RP_D(const CisoPspReader);
-	assert(!d->indexEntries.empty());
-	assert(blockIdx < d->indexEntries.size()-1);
-	if (d->indexEntries.empty() || blockIdx >= d->indexEntries.size()-1) {
-		// Out of range.
+	assert(blockIdx < d->num_blocks);
+	uint32_t indexEntry;
+	if (blockIdx >= d->num_blocks || d->getIndexEntry(blockIdx, indexEntry) != 0) {
+		// Out of range, or unable to read the index entry.
 		return -1;
 	}
 
@@ -698,20 +1035,20 @@ off64_t CisoPspReader::getPhysBlockAddr(uint32_t blockIdx) const
 #ifdef HAVE_LZ4
 		case CisoPspReaderPrivate::CisoType::ZISO:
 #endif /* HAVE_LZ4 */
-			addr = static_cast<off64_t>(d->indexEntries[blockIdx] & ~CISO_PSP_V0_NOT_COMPRESSED);
+			addr = static_cast<off64_t>(indexEntry & ~CISO_PSP_V0_NOT_COMPRESSED);
 			addr <<= d->index_shift;
 			break;
 
 #ifdef HAVE_LZO
 		case CisoPspReaderPrivate::CisoType::JISO:
 			// TODO: Is index_shift actually supported by JISO?
-			addr = static_cast<off64_t>(d->indexEntries[blockIdx]);
+			addr = static_cast<off64_t>(indexEntry);
 			addr <<= d->index_shift;
 			break;
 #endif /* HAVE_LZO */
 
 		case CisoPspReaderPrivate::CisoType::DAX:
-			addr = static_cast<off64_t>(d->indexEntries[blockIdx]);
+			addr = static_cast<off64_t>(indexEntry);
 			break;
 	}
 
@@ -719,237 +1056,84 @@ off64_t CisoPspReader::getPhysBlockAddr(uint32_t blockIdx) const
 }
 
 /**
- * Read the specified block.
- *
- * This can read either a full block or a partial block.
- * For a full block, set pos = 0 and size = block_size.
+ * Read the raw data for the specified block.
+ * This reads the compressed data if the block is compressed.
  *
  * @param blockIdx	[in] Block index.
- * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
- * @param ptr		[out] Output data buffer.
- * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
- * @return Number of bytes read, or -1 if the block index is invalid.
+ * @param pRaw		[out] Raw data buffer. (size is the block cache buffer size)
+ * @param pRawSize	[out] Size of the raw data.
+ * @return 0 on success; negative POSIX error code on error.
  */
-int CisoPspReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
+int CisoPspReader::readRawBlock(uint32_t blockIdx, uint8_t *pRaw, size_t *pRawSize)
 {
-	// Read 'size' bytes of block 'blockIdx', starting at 'pos'.
 	// NOTE: This can only be called by SparseDiscReader,
 	// so the main assertions are already checked there.
-	RP_D(CisoPspReader);
-	assert(pos >= 0 && pos < (int)d->block_size);
-	assert(size <= d->block_size);
-	// TODO: Make sure overflow doesn't occur.
-	assert(static_cast<off64_t>(pos + size) <= static_cast<off64_t>(d->block_size));
-	if (pos < 0 || static_cast<off64_t>(pos + size) > static_cast<off64_t>(d->block_size)) {
-		// pos+size is out of range.
-		return -1;
-	}
-
-	if (unlikely(size == 0)) {
-		// Nothing to read.
-		return 0;
-	}
+	RP_D(const CisoPspReader);
 
-	if (blockIdx == d->blockCacheIdx) {
-		// Block is cached.
-		memcpy(ptr, &d->blockCache[pos], size);
-		return size;
+	CisoPspReaderPrivate::BlockInfo info;
+	int ret = d->getBlockInfo(blockIdx, info);
+	if (ret != 0) {
+		return ret;
 	}
 
-	// Get the physical address first.
-	const uint32_t indexEntry = d->indexEntries[blockIdx];
-	uint32_t z_block_size = d->getBlockCompressedSize(blockIdx);
-	if (z_block_size == 0) {
-		// Unable to get the block's compressed size...
-		m_lastError = EIO;
-		return 0;
+	size_t sz_read = m_file->pread(info.physBlockAddr, pRaw, info.z_block_size);
+	if (sz_read != info.z_block_size) {
+		// Read error.
+		int err = m_file->lastError();
+		if (err == 0) {
+			err = EIO;
+		}
+		return -err;
 	}
 
-	enum class CompressionMode {
-		None = 0,
-		Deflate = 1,
-		LZ4 = 2,
-		LZO = 3,
-	};
-	CompressionMode z_mode;
-	int windowBits = 0;
-
-	off64_t physBlockAddr;
-	switch (d->cisoType) {
-		default:
-		case CisoPspReaderPrivate::CisoType::Unknown:
-			assert(!"Unsupported CisoType.");
-			UNREF_AND_NULL_NOCHK(m_file);
-			m_lastError = ENOTSUP;
-			return 0;
-
-		case CisoPspReaderPrivate::CisoType::CISO:
-			// CISO uses raw deflate.
-			windowBits = -15;
-
-			// Mask off the compression bit, and shift the address
-			// based on the index shift.
-			physBlockAddr = static_cast<off64_t>(indexEntry & ~CISO_PSP_V0_NOT_COMPRESSED);
-			physBlockAddr <<= d->index_shift;
-
-			if (d->header.cisoPsp.version < 2) {
-				// CISO v0/v1: Check if compressed.
-				z_mode = (indexEntry & CISO_PSP_V0_NOT_COMPRESSED)
-					? CompressionMode::None
-					: CompressionMode::Deflate;
-
-				if (z_mode == CompressionMode::None) {
-					// (Un)compressed block size must match the actual block size.
-					if (z_block_size != d->block_size) {
-						// Error...
-						m_lastError = EIO;
-						return 0;
-					}
-				}
-			} else {
-				// CISO v2: Check if compressed, and if so, which algorithm.
-				if (z_block_size == d->block_size) {
-					z_mode = CompressionMode::None;
-				} else {
-					z_mode = (indexEntry & CISO_PSP_V2_LZ4_COMPRESSED)
-						? CompressionMode::LZ4
-						: CompressionMode::Deflate;
-				}
-			}
-			break;
-
-#ifdef HAVE_LZ4
-		case CisoPspReaderPrivate::CisoType::ZISO:
-			// ZISO uses LZ4.
-
-			// Mask off the compression bit, and shift the address
-			// based on the index shift.
-			physBlockAddr = static_cast<off64_t>(indexEntry & ~CISO_PSP_V0_NOT_COMPRESSED);
-			physBlockAddr <<= d->index_shift;
-
-			z_mode = (indexEntry & CISO_PSP_V0_NOT_COMPRESSED)
-				? CompressionMode::None
-				: CompressionMode::LZ4;
-			break;
-#endif /* HAVE_LZ4 */
-
-#ifdef HAVE_LZO
-		case CisoPspReaderPrivate::CisoType::JISO:
-			// JISO uses LZO or zlib.
-			// TODO: Verify the rest of this.
-
-			// JISO does *not* indicate compression using the high bit.
-			// Instead, the compressed block size will match the uncompressed
-			// block size, similar to CISOv2.
-			physBlockAddr = static_cast<off64_t>(indexEntry);
-			physBlockAddr <<= d->index_shift;
-
-			if (d->header.jiso.block_headers) {
-				// Block headers are present.
-				// TODO: jiso.exe says this can provide for "faster decompression".
-				if (z_block_size <= 4) {
-					// Incorrect block size.
-					m_lastError = EIO;
-					return 0;
-				}
-				physBlockAddr += 4;
-				z_block_size -= 4;
-			}
+	*pRawSize = sz_read;
+	return 0;
+}
 
-			if (z_block_size == d->block_size) {
-				z_mode = CompressionMode::None;
-			} else {
-				switch (d->header.jiso.method) {
-					case JISO_METHOD_LZO:
-						z_mode = CompressionMode::LZO;
-						break;
-					case JISO_METHOD_ZLIB:
-						// JISO zlib uses raw deflate.
-						windowBits = -15;
-						z_mode = CompressionMode::Deflate;
-						break;
-					default:
-						assert(!"Unsupported JISO compression method.");
-						m_lastError = ENOTSUP;
-						return 0;
-				}
-			}
-			break;
-#endif /* HAVE_LZO */
+/**
+ * Decode raw block data into a block buffer.
+ * The block will be decompressed if necessary.
+ *
+ * @param blockIdx	[in] Block index.
+ * @param pRaw		[in] Raw data from readRawBlock().
+ * @param rawSize	[in] Size of the raw data.
+ * @param pBuf		[out] Block buffer. (at least block_size bytes)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CisoPspReader::decodeRawBlock(uint32_t blockIdx, const uint8_t *pRaw, size_t rawSize, uint8_t *pBuf) const
+{
+	RP_D(const CisoPspReader);
 
-		case CisoPspReaderPrivate::CisoType::DAX:
-			physBlockAddr = static_cast<off64_t>(indexEntry);
-			if (d->header.dax.nc_areas > 0 && d->daxNCTable[blockIdx]) {
-				// Uncompressed block.
-				z_mode = CompressionMode::None;
-			} else {
-				// Compressed block.
-				// DAX uses zlib deflate.
-				windowBits = 15;
-				z_mode = CompressionMode::Deflate;
-			}
-			break;
+	CisoPspReaderPrivate::BlockInfo info;
+	int ret = d->getBlockInfo(blockIdx, info);
+	if (ret != 0) {
+		return ret;
 	}
+	assert(rawSize == info.z_block_size);
+	const uint32_t z_block_size = static_cast<uint32_t>(rawSize);
 
-	switch (z_mode) {
+	switch (info.z_mode) {
 		default:
 			assert(!"Compression mode not supported...");
-			m_lastError = ENOTSUP;
-			return 0;
-
-		case CompressionMode::None: {
-			// Reading uncompressed data directly into the cache.
-			size_t sz_read = m_file->seekAndRead(physBlockAddr, d->blockCache.data(), z_block_size);
-			if (sz_read != z_block_size) {
-				// Seek and/or read error.
-				d->blockCacheIdx = ~0U;
-				m_lastError = m_file->lastError();
-				if (m_lastError == 0) {
-					m_lastError = EIO;
-				}
-				return 0;
-			}
-			d->blockCacheIdx = blockIdx;
-			break;
-		}
+			return -ENOTSUP;
 
-		case CompressionMode::Deflate: {
-			// Read compressed data into a temporary buffer,
-			// then decompress it.
-			assert(windowBits != 0);
-			if (windowBits == 0) {
-				m_lastError = EINVAL;
-			}
-			uint32_t z_max_size = d->block_size;
-			if (unlikely(d->isDaxWithoutNCTable)) {
-				// DAX without NC table can end up compressing to larger
-				// than the uncompressed size.
-				z_max_size *= 2;
-			}
-			if (z_block_size > z_max_size) {
-				// Compressed data is larger than the uncompressed block size.
-				// This is only allowed for DAX without NC table.
-				m_lastError = EIO;
-				return 0;
-			}
+		case CisoPspReaderPrivate::CompressionMode::None:
+			// Uncompressed data.
+			return super::decodeRawBlock(blockIdx, pRaw, rawSize, pBuf);
 
-			size_t sz_read = m_file->seekAndRead(physBlockAddr, d->z_buffer.data(), z_block_size);
-			if (sz_read != z_block_size) {
-				// Seek and/or read error.
-				m_lastError = m_file->lastError();
-				if (m_lastError == 0) {
-					m_lastError = EIO;
-				}
-				return 0;
+		case CisoPspReaderPrivate::CompressionMode::Deflate: {
+			assert(info.windowBits != 0);
+			if (info.windowBits == 0) {
+				return -EINVAL;
 			}
 
 			// Decompress the data.
 			z_stream z = { };
-			z.next_in = d->z_buffer.data();
+			z.next_in = const_cast<Bytef*>(pRaw);
 			z.avail_in = z_block_size;
-			z.next_out = d->blockCache.data();
+			z.next_out = pBuf;
 			z.avail_out = d->block_size;
-			inflateInit2(&z, windowBits);
+			inflateInit2(&z, info.windowBits);
 
 			int status = inflate(&z, Z_FULL_FLUSH);
 			const uint32_t uncomp_size = d->block_size - z.avail_out;
@@ -958,115 +1142,55 @@ int CisoPspReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 			if (status != Z_STREAM_END || uncomp_size != d->block_size) {
 				// Decompression error.
 				// TODO: Print warnings and/or more comprehensive error codes.
-				d->blockCacheIdx = ~0U;
-				m_lastError = EIO;
-				return 0;
+				return -EIO;
 			}
 			break;
 		}
 
-		case CompressionMode::LZ4: {
+		case CisoPspReaderPrivate::CompressionMode::LZ4: {
 #ifdef HAVE_LZ4
-			// Read compressed data into a temporary buffer,
-			// then decompress it.
-			uint32_t z_max_size = d->block_size;
-			if (unlikely(d->isDaxWithoutNCTable)) {
-				// DAX without NC table can end up compressing to larger
-				// than the uncompressed size.
-				z_max_size *= 2;
-			}
-			if (z_block_size > z_max_size) {
-				// Compressed data is larger than the uncompressed block size.
-				// This is only allowed for DAX without NC table.
-				m_lastError = EIO;
-				return 0;
-			}
-
-			size_t sz_read = m_file->seekAndRead(physBlockAddr, d->z_buffer.data(), z_block_size);
-			if (sz_read != z_block_size) {
-				// Seek and/or read error.
-				m_lastError = m_file->lastError();
-				if (m_lastError == 0) {
-					m_lastError = EIO;
-				}
-				return 0;
-			}
-
 			// Decompress the data.
 			int size = LZ4_decompress_safe(
-				reinterpret_cast<const char*>(d->z_buffer.data()),
-				reinterpret_cast<char*>(d->blockCache.data()),
+				reinterpret_cast<const char*>(pRaw),
+				reinterpret_cast<char*>(pBuf),
 				z_block_size, d->block_size);
 			if (size != (int)d->block_size) {
 				// Decompression error.
 				// TODO: Print warnings and/or more comprehensive error codes.
-				d->blockCacheIdx = ~0U;
-				m_lastError = EIO;
-				return 0;
+				return -EIO;
 			}
 			break;
 #else /* !HAVE_LZ4 */
 			// TODO: If it's CISOv2, check for LZ4-compressed blocks and fail early?
 			assert(!"LZ4 is not enabled in this build.");
-			m_lastError = EIO;
-			return 0;
+			return -EIO;
 #endif /* HAVE_LZ4 */
 		}
 
-		case CompressionMode::LZO: {
+		case CisoPspReaderPrivate::CompressionMode::LZO: {
 #ifdef HAVE_LZO
-			// Read compressed data into a temporary buffer,
-			// then decompress it.
-			uint32_t z_max_size = d->block_size;
-			if (unlikely(d->isDaxWithoutNCTable)) {
-				// DAX without NC table can end up compressing to larger
-				// than the uncompressed size.
-				z_max_size *= 2;
-			}
-			if (z_block_size > z_max_size) {
-				// Compressed data is larger than the uncompressed block size.
-				// This is only allowed for DAX without NC table.
-				m_lastError = EIO;
-				return 0;
-			}
-
-			size_t sz_read = m_file->seekAndRead(physBlockAddr, d->z_buffer.data(), z_block_size);
-			if (sz_read != z_block_size) {
-				// Seek and/or read error.
-				m_lastError = m_file->lastError();
-				if (m_lastError == 0) {
-					m_lastError = EIO;
-				}
-				return 0;
-			}
-
 			// Decompress the data.
 			// TODO: LZO in-place decompression?
 			lzo_uint dst_len = d->block_size;
 			int ret = lzo1x_decompress_safe(
-				d->z_buffer.data(), z_block_size,
-				d->blockCache.data(), &dst_len,
+				pRaw, z_block_size,
+				pBuf, &dst_len,
 				nullptr);
 			if (ret != LZO_E_OK || dst_len != d->block_size) {
 				// Decompression error.
 				// TODO: Print warnings and/or more comprehensive error codes.
-				d->blockCacheIdx = ~0U;
-				m_lastError = EIO;
-				return 0;
+				return -EIO;
 			}
 			break;
 #else /* !HAVE_LZO */
 			assert(!"LZO is not enabled in this build.");
-			m_lastError = EIO;
-			return 0;
+			return -EIO;
 #endif /* HAVE_LZO */
 		}
 	}
 
-	// Block has been loaded into the cache.
-	memcpy(ptr, &d->blockCache[pos], size);
-	d->blockCacheIdx = blockIdx;
-	return size;
+	// Block has been decompressed.
+	return 0;
 }
 
 }
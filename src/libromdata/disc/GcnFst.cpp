@@ -18,13 +18,20 @@ using namespace LibRpBase;
 // C++ STL classes.
 using std::string;
 using std::unordered_map;
+using std::vector;
 
 namespace LibRomData {
 
 class GcnFstPrivate
 {
 	public:
-		GcnFstPrivate(const uint8_t *fstData, uint32_t len, uint8_t offsetShift);
+		/**
+		 * Parse a GameCube FST.
+		 * @param fst8 FST data. (takes ownership; must have len+1 bytes allocated with new[])
+		 * @param len Length of the FST data, in bytes.
+		 * @param offsetShift File offset shift. (0 = GCN, 2 = Wii)
+		 */
+		GcnFstPrivate(uint8_t *fst8, uint32_t len, uint8_t offsetShift);
 		~GcnFstPrivate();
 
 	private:
@@ -52,6 +59,58 @@ class GcnFstPrivate
 		// IFst::Dir* reference counter.
 		int fstDirCount;
 
+		/** Path index. (Built by buildPathIndex().) **/
+
+		struct PathIndexEntry {
+			uint32_t hash;	// Full path hash
+			int idx;	// FST entry index
+
+			inline bool operator<(const PathIndexEntry &other) const
+			{
+				return (hash < other.hash ||
+					(hash == other.hash && idx < other.idx));
+			}
+		};
+
+		// Sorted by hash, then by FST entry index.
+		vector<PathIndexEntry> path_index;
+
+		// All entry names, converted to UTF-8.
+		// Names are NULL-terminated and stored contiguously.
+		// NOTE: This buffer is never modified after the index is built,
+		// since DirEnt::name points into it.
+		string u8_names;
+		// Per-entry offset into u8_names. (UINT32_MAX if invalid)
+		vector<uint32_t> u8_name_offsets;
+		// Per-entry parent directory index.
+		vector<int> parent_idx;
+
+		/**
+		 * Hash a path component. (FNV-1a)
+		 * The component is prefixed with '/'.
+		 * @param hash Hash of the parent directory's path.
+		 * @param name Path component.
+		 * @param len Length of name.
+		 * @return Hash of the full path.
+		 */
+		static inline uint32_t path_hash(uint32_t hash, const char *name, size_t len);
+
+		// FNV-1a offset basis. (hash of the root directory)
+		static const uint32_t PATH_HASH_ROOT = 0x811C9DC5U;
+
+		/**
+		 * Build the path index.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int buildPathIndex(void);
+
+		/**
+		 * Find a path using the path index.
+		 * @param path Path. (Absolute paths only!)
+		 * @return fst_entry if found, or nullptr if not.
+		 */
+		const GCN_FST_Entry *find_path_indexed(const char *path) const;
+
 		/**
 		 * Check if an fst_entry is a directory.
 		 * @return True if this is a directory; false if it's a regular file.
@@ -83,29 +142,37 @@ class GcnFstPrivate
 		 * @return fst_entry if found, or nullptr if not.
 		 */
 		const GCN_FST_Entry *find_path(const char *path) const;
+
+		/**
+		 * Copy FST data into a new buffer for GcnFstPrivate.
+		 * @param fstData FST data.
+		 * @param len Length of fstData, in bytes.
+		 * @return Buffer allocated with new[], with len+1 bytes; nullptr if fstData is nullptr.
+		 */
+		static uint8_t *dupFstData(const uint8_t *fstData, uint32_t len);
 };
 
 /** GcnFstPrivate **/
 
-GcnFstPrivate::GcnFstPrivate(const uint8_t *fstData, uint32_t len, uint8_t offsetShift)
+GcnFstPrivate::GcnFstPrivate(uint8_t *fst8, uint32_t len, uint8_t offsetShift)
 	: hasErrors(false)
-	, fstData(nullptr)
+	, fstData(reinterpret_cast<GCN_FST_Entry*>(fst8))
 	, fstData_sz(len)
 	, string_table_ptr(nullptr)
 	, string_table_sz(0)
 	, offsetShift(offsetShift)
 	, fstDirCount(0)
 {
-	assert(fstData != nullptr);
+	assert(fst8 != nullptr);
 	assert(len >= sizeof(GCN_FST_Entry));
-	if (!fstData || len < sizeof(GCN_FST_Entry)) {
+	if (!fst8 || len < sizeof(GCN_FST_Entry)) {
 		// Invalid parameters.
 		hasErrors = true;
 		return;
 	}
 
 	// String table is stored directly after the root entry.
-	const GCN_FST_Entry *root_entry = reinterpret_cast<const GCN_FST_Entry*>(fstData);
+	const GCN_FST_Entry *root_entry = fstData;
 	const uint32_t file_count = be32_to_cpu(root_entry->root_dir.file_count);
 	if (file_count <= 1 || file_count > (fstData_sz / sizeof(GCN_FST_Entry))) {
 		// Sanity check: File count is invalid.
@@ -123,12 +190,8 @@ GcnFstPrivate::GcnFstPrivate(const uint8_t *fstData, uint32_t len, uint8_t offse
 		return;
 	}
 
-	// Copy the FST data.
-	// NOTE: +1 for NULL termination.
-	uint8_t *const fst8 = new uint8_t[fstData_sz + 1];
-	memcpy(fst8, fstData, fstData_sz);
+	// NOTE: The buffer has an extra byte for NULL termination.
 	fst8[fstData_sz] = 0; // Make sure the string table is NULL-terminated.
-	this->fstData = reinterpret_cast<GCN_FST_Entry*>(fst8);
 
 	// Save a pointer to the string table.
 	string_table_ptr = reinterpret_cast<char*>(&fst8[string_table_offset]);
@@ -147,6 +210,23 @@ GcnFstPrivate::~GcnFstPrivate()
 	delete[] fstData;
 }
 
+/**
+ * Copy FST data into a new buffer for GcnFstPrivate.
+ * @param fstData FST data.
+ * @param len Length of fstData, in bytes.
+ * @return Buffer allocated with new[], with len+1 bytes; nullptr if fstData is nullptr.
+ */
+uint8_t *GcnFstPrivate::dupFstData(const uint8_t *fstData, uint32_t len)
+{
+	if (!fstData)
+		return nullptr;
+
+	// NOTE: +1 for NULL termination.
+	uint8_t *const fst8 = new uint8_t[static_cast<size_t>(len) + 1];
+	memcpy(fst8, fstData, len);
+	return fst8;
+}
+
 /**
  * Check if an fst_entry is a directory.
  * @return True if this is a directory; false if it's a regular file.
@@ -163,6 +243,12 @@ inline bool GcnFstPrivate::is_dir(const GCN_FST_Entry *fst_entry)
  */
 inline const char *GcnFstPrivate::entry_name(const GCN_FST_Entry *fst_entry) const
 {
+	if (!u8_name_offsets.empty()) {
+		// Path index has been built.
+		const uint32_t u8_offset = u8_name_offsets[fst_entry - fstData];
+		return (u8_offset != UINT32_MAX ? &u8_names[u8_offset] : nullptr);
+	}
+
 	// Get the name entry from the string table.
 	uint32_t offset = be32_to_cpu(fst_entry->file_type_name_offset) & 0xFFFFFF;
 	if (offset >= string_table_sz) {
@@ -247,6 +333,11 @@ const GCN_FST_Entry *GcnFstPrivate::find_path(const char *path) const
 		return fst_entry;
 	}
 
+	if (!path_index.empty()) {
+		// Use the path index.
+		return find_path_indexed(path);
+	}
+
 	// Store the path as a temporary string.
 	string s_path;
 	if (path[0] != '/') {
@@ -346,6 +437,205 @@ const GCN_FST_Entry *GcnFstPrivate::find_path(const char *path) const
 	return fst_entry;
 }
 
+/**
+ * Hash a path component. (FNV-1a)
+ * The component is prefixed with '/'.
+ * @param hash Hash of the parent directory's path.
+ * @param name Path component.
+ * @param len Length of name.
+ * @return Hash of the full path.
+ */
+inline uint32_t GcnFstPrivate::path_hash(uint32_t hash, const char *name, size_t len)
+{
+	hash = (hash ^ '/') * 0x01000193U;
+	for (; len > 0; len--, name++) {
+		hash = (hash ^ static_cast<uint8_t>(*name)) * 0x01000193U;
+	}
+	return hash;
+}
+
+/**
+ * Build the path index.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GcnFstPrivate::buildPathIndex(void)
+{
+	if (!string_table_ptr) {
+		// FST is not valid.
+		return -EIO;
+	} else if (!path_index.empty()) {
+		// Path index has already been built.
+		return 0;
+	}
+
+	const int file_count = static_cast<int>(be32_to_cpu(fstData[0].root_dir.file_count));
+	vector<PathIndexEntry> new_path_index;
+	vector<uint32_t> new_name_offsets;
+	vector<int> new_parent_idx;
+	string new_u8_names;
+	new_path_index.reserve(file_count - 1);
+	new_name_offsets.resize(file_count);
+	new_parent_idx.resize(file_count);
+	// NOTE: Most names are ASCII, so the UTF-8 names
+	// will usually be the same size as the string table.
+	new_u8_names.reserve(string_table_sz);
+
+	// Directory stack.
+	struct DirStackEntry {
+		int idx;		// FST entry index
+		int next_idx;		// Index *after* the last entry in the directory
+		uint32_t hash;		// Full path hash
+		bool reachable;		// False if find_path() can't reach this directory
+	};
+	vector<DirStackEntry> dir_stack;
+	dir_stack.push_back({0, file_count, PATH_HASH_ROOT, true});
+
+	const GCN_FST_Entry *fst_entry = fstData;
+	for (int idx = 0; idx < file_count; idx++, fst_entry++) {
+		// Convert the name.
+		// NOTE: The root directory's name is also converted,
+		// since opendir("/") returns it.
+		const uint32_t offset = be32_to_cpu(fst_entry->file_type_name_offset) & 0xFFFFFF;
+		string u8str;
+		const char *u8_name = nullptr;
+		size_t u8_name_len = 0;
+		if (offset < string_table_sz) {
+			const char *const str = &string_table_ptr[offset];
+			u8str = cp1252_sjis_to_utf8(str, static_cast<int>(strlen(str)));
+			new_name_offsets[idx] = static_cast<uint32_t>(new_u8_names.size());
+			new_u8_names.append(u8str.c_str(), u8str.size() + 1);
+			u8_name = u8str.c_str();
+			u8_name_len = u8str.size();
+			if (u8_name_len > 0 && memchr(u8_name, '/', u8_name_len) != nullptr) {
+				// Names with slashes can't be found by find_path().
+				u8_name = nullptr;
+			}
+		} else {
+			// Out of range.
+			new_name_offsets[idx] = UINT32_MAX;
+		}
+
+		if (idx == 0) {
+			// Root directory.
+			new_parent_idx[0] = -1;
+			continue;
+		}
+
+		// Find the parent directory.
+		while (idx >= dir_stack.back().next_idx) {
+			dir_stack.pop_back();
+		}
+		const DirStackEntry &parent = dir_stack.back();
+		new_parent_idx[idx] = parent.idx;
+
+		// Empty names can't be found by find_path().
+		const bool reachable = (parent.reachable && u8_name_len > 0 && u8_name != nullptr);
+		const uint32_t hash = (reachable ? path_hash(parent.hash, u8_name, u8_name_len) : 0);
+		if (reachable) {
+			new_path_index.push_back({hash, idx});
+		}
+
+		if (is_dir(fst_entry)) {
+			// NOTE: next_offset is the index *after* the
+			// last entry in the subdirectory.
+			const int next_idx = static_cast<int>(be32_to_cpu(fst_entry->dir.next_offset));
+			if (next_idx <= idx || next_idx > parent.next_idx) {
+				// Subdirectory is out of range.
+				return -EIO;
+			}
+			dir_stack.push_back({idx, next_idx, hash, reachable});
+		}
+	}
+
+	std::sort(new_path_index.begin(), new_path_index.end());
+	path_index = std::move(new_path_index);
+	u8_names = std::move(new_u8_names);
+	u8_name_offsets = std::move(new_name_offsets);
+	parent_idx = std::move(new_parent_idx);
+	return 0;
+}
+
+/**
+ * Find a path using the path index.
+ * @param path Path. (Absolute paths only!)
+ * @return fst_entry if found, or nullptr if not.
+ */
+const GCN_FST_Entry *GcnFstPrivate::find_path_indexed(const char *path) const
+{
+	// Hash the path, skipping empty path components.
+	// This is equivalent to the path normalization in find_path().
+	uint32_t hash = PATH_HASH_ROOT;
+	bool has_components = false;
+	const char *p = path;
+	while (*p != '\0') {
+		if (*p == '/') {
+			p++;
+			continue;
+		}
+		const char *const slash = strchr(p, '/');
+		const size_t len = (slash ? static_cast<size_t>(slash - p) : strlen(p));
+		hash = path_hash(hash, p, len);
+		has_components = true;
+		p += len;
+	}
+	if (!has_components) {
+		// Root directory.
+		return fstData;
+	}
+	const char *const path_end = p;
+
+	// Check all entries with this hash.
+	// If there's more than one match, the first entry is used.
+	const PathIndexEntry key = {hash, 0};
+	const auto path_index_cend = path_index.cend();
+	for (auto iter = std::lower_bound(path_index.cbegin(), path_index_cend, key);
+	     iter != path_index_cend && iter->hash == hash; ++iter)
+	{
+		// Compare the path components in reverse order.
+		int idx = iter->idx;
+		const char *comp_end = path_end;
+		bool match = true;
+		while (match) {
+			// Skip slashes.
+			while (comp_end > path && comp_end[-1] == '/') {
+				comp_end--;
+			}
+			if (comp_end == path) {
+				// No more path components.
+				// This should be the root directory.
+				match = (idx == 0);
+				break;
+			} else if (idx <= 0) {
+				// More path components, but no more parent directories.
+				match = false;
+				break;
+			}
+
+			const char *comp = comp_end;
+			while (comp > path && comp[-1] != '/') {
+				comp--;
+			}
+			const size_t comp_len = static_cast<size_t>(comp_end - comp);
+
+			const uint32_t u8_offset = u8_name_offsets[idx];
+			const char *const name = &u8_names[u8_offset];
+			match = (u8_offset != UINT32_MAX &&
+				 strlen(name) == comp_len &&
+				 !memcmp(name, comp, comp_len));
+
+			comp_end = comp;
+			idx = parent_idx[idx];
+		}
+
+		if (match) {
+			return &fstData[iter->idx];
+		}
+	}
+
+	// Not found.
+	return nullptr;
+}
+
 /** GcnFst **/
 
 /**
@@ -356,9 +646,36 @@ const GCN_FST_Entry *GcnFstPrivate::find_path(const char *path) const
  */
 GcnFst::GcnFst(const uint8_t *fstData, uint32_t len, uint8_t offsetShift)
 	: super()
-	, d(new GcnFstPrivate(fstData, len, offsetShift))
+	, d(new GcnFstPrivate(GcnFstPrivate::dupFstData(fstData, len), len, offsetShift))
 { }
 
+/**
+ * Internal constructor used by takeFstData().
+ * @param d GcnFstPrivate.
+ */
+GcnFst::GcnFst(GcnFstPrivate *d)
+	: super()
+	, d(d)
+{ }
+
+/**
+ * Parse a GameCube FST without copying the FST data.
+ *
+ * The FST buffer must be allocated using new[] and must
+ * have room for len+1 bytes. The extra byte is used for
+ * NULL-terminating the string table. GcnFst takes ownership
+ * of the buffer, even if the FST has errors.
+ *
+ * @param fstData FST data.
+ * @param len Length of the FST data, in bytes. (not including the extra byte)
+ * @param offsetShift File offset shift. (0 = GCN, 2 = Wii)
+ * @return GcnFst. (check hasErrors())
+ */
+GcnFst *GcnFst::takeFstData(uint8_t *fstData, uint32_t len, uint8_t offsetShift)
+{
+	return new GcnFst(new GcnFstPrivate(fstData, len, offsetShift));
+}
+
 GcnFst::~GcnFst()
 {
 	delete d;
@@ -577,6 +894,23 @@ int GcnFst::find_file(const char *filename, DirEnt *dirent)
 	return 0;
 }
 
+/**
+ * Build a path index.
+ *
+ * This converts all filenames to UTF-8 and builds a sorted
+ * index of path hashes, which speeds up path lookups in
+ * opendir() and find_file() for large FSTs.
+ *
+ * NOTE: This should be called before using opendir()
+ * or find_file() if many lookups will be done.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GcnFst::buildPathIndex(void)
+{
+	return d->buildPathIndex();
+}
+
 /**
  * Get the total size of all files.
  *
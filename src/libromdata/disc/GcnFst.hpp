@@ -27,10 +27,33 @@ class GcnFst : public LibRpBase::IFst
 		GcnFst(const uint8_t *fstData, uint32_t len, uint8_t offsetShift);
 		virtual ~GcnFst();
 
+	private:
+		/**
+		 * Internal constructor used by takeFstData().
+		 * @param d GcnFstPrivate.
+		 */
+		explicit GcnFst(GcnFstPrivate *d);
+
 	private:
 		typedef IFst super;
 		RP_DISABLE_COPY(GcnFst)
 
+	public:
+		/**
+		 * Parse a GameCube FST without copying the FST data.
+		 *
+		 * The FST buffer must be allocated using new[] and must
+		 * have room for len+1 bytes. The extra byte is used for
+		 * NULL-terminating the string table. GcnFst takes ownership
+		 * of the buffer, even if the FST has errors.
+		 *
+		 * @param fstData FST data.
+		 * @param len Length of the FST data, in bytes. (not including the extra byte)
+		 * @param offsetShift File offset shift. (0 = GCN, 2 = Wii)
+		 * @return GcnFst. (check hasErrors())
+		 */
+		static GcnFst *takeFstData(uint8_t *fstData, uint32_t len, uint8_t offsetShift);
+
 	private:
 		friend class GcnFstPrivate;
 		GcnFstPrivate *const d;
@@ -82,6 +105,20 @@ class GcnFst : public LibRpBase::IFst
 		int find_file(const char *filename, DirEnt *dirent) final;
 
 	public:
+		/**
+		 * Build a path index.
+		 *
+		 * This converts all filenames to UTF-8 and builds a sorted
+		 * index of path hashes, which speeds up path lookups in
+		 * opendir() and find_file() for large FSTs.
+		 *
+		 * NOTE: This should be called before using opendir()
+		 * or find_file() if many lookups will be done.
+		 *
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int buildPathIndex(void);
+
 		/**
 		 * Get the total size of all files.
 		 *
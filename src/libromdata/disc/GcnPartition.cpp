@@ -255,36 +255,61 @@ IRpFile *GcnPartition::open(const char *filename)
 {
 	// TODO: File reference counter.
 	// This might be difficult to do because GcnFile is a separate class.
-	RP_D(GcnPartition);
-	if (!d->fst) {
-		// FST isn't loaded.
-		if (d->loadFst() != 0) {
-			// FST load failed.
-			m_lastError = EIO;
-			return nullptr;
-		}
+	off64_t offset, size;
+	int ret = findFileExtent(filename, &offset, &size);
+	if (ret != 0) {
+		m_lastError = -ret;
+		return nullptr;
 	}
 
+	// Create the PartitionFile.
+	// This is an IRpFile implementation that uses an
+	// IPartition as the reader and takes an offset
+	// and size as the file parameters.
+	return new PartitionFile(this, offset, size);
+}
+
+/** Bulk extraction **/
+
+/**
+ * Find a file's extent within the partition.
+ * The offset is the same one PartitionFile uses.
+ * @param filename	[in] Filename.
+ * @param pOffset	[out] Partition offset.
+ * @param pSize		[out] File size.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GcnPartition::findFileExtent(const char *filename, off64_t *pOffset, off64_t *pSize)
+{
+	RP_D(GcnPartition);
 	if (!filename) {
 		// No filename.
-		m_lastError = EINVAL;
-		return nullptr;
+		return -EINVAL;
 	}
 
 	// Find the file in the FST.
+	// If the FST isn't loaded, only the blocks needed
+	// to look up this file are read.
 	IFst::DirEnt dirent;
-	int ret = d->fst->find_file(filename, &dirent);
+	int ret;
+	if (d->fst) {
+		ret = d->fst->find_file(filename, &dirent);
+	} else {
+		ret = d->findFilePartial(filename, &dirent);
+		if (ret != 0 && ret != -ENOENT) {
+			// FST load failed.
+			return -EIO;
+		}
+	}
 	if (ret != 0) {
 		// File not found.
-		m_lastError = ENOENT;
-		return nullptr;
+		return -ENOENT;
 	}
 
 	// Make sure this is a regular file.
 	if (dirent.type != DT_REG) {
 		// Not a regular file.
-		m_lastError = (dirent.type == DT_DIR ? EISDIR : EPERM);
-		return nullptr;
+		return (dirent.type == DT_DIR ? -EISDIR : -EPERM);
 	}
 
 	// Make sure the file is in bounds.
@@ -292,15 +317,12 @@ IRpFile *GcnPartition::open(const char *filename)
 	    dirent.offset > d->partition_size - dirent.size)
 	{
 		// File is out of bounds.
-		m_lastError = EIO;
-		return nullptr;
+		return -EIO;
 	}
 
-	// Create the PartitionFile.
-	// This is an IRpFile implementation that uses an
-	// IPartition as the reader and takes an offset
-	// and size as the file parameters.
-	return new PartitionFile(this, dirent.offset, dirent.size);
+	*pOffset = dirent.offset;
+	*pSize = dirent.size;
+	return 0;
 }
 
 }
@@ -135,6 +135,19 @@ class GcnPartition : public LibRpBase::IPartition
 		 * @return IRpFile*, or nullptr on error.
 		 */
 		LibRpFile::IRpFile *open(const char *filename);
+
+	public:
+		/** Bulk extraction **/
+
+		/**
+		 * Find a file's extent within the partition.
+		 * The offset is the same one PartitionFile uses.
+		 * @param filename	[in] Filename.
+		 * @param pOffset	[out] Partition offset.
+		 * @param pSize		[out] File size.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int findFileExtent(const char *filename, off64_t *pOffset, off64_t *pSize) override;
 };
 
 }
@@ -13,7 +13,10 @@
 #include "GcnPartition.hpp"
 
 // librpbase
-using LibRpBase::IDiscReader;
+using namespace LibRpBase;
+
+// C++ STL classes.
+using std::string;
 
 namespace LibRomData {
 
@@ -27,6 +30,9 @@ GcnPartitionPrivate::GcnPartitionPrivate(GcnPartition *q,
 	, bootLoaded(false)
 	, offsetShift(offsetShift)
 	, fst(nullptr)
+	, fstPartial(nullptr)
+	, fstPartial_len(0)
+	, fstFileCount(0)
 {
 	// NOTE: The discReader parameter is needed because
 	// WiiPartitionPrivate is created *before* the
@@ -45,6 +51,7 @@ GcnPartitionPrivate::GcnPartitionPrivate(GcnPartition *q,
 GcnPartitionPrivate::~GcnPartitionPrivate()
 {
 	delete fst;
+	delete[] fstPartial;
 }
 
 /**
@@ -109,6 +116,7 @@ int GcnPartitionPrivate::loadBootBlockAndInfo(void)
 
 /**
  * Load the FST.
+ * Blocks that were already read by findFilePartial() aren't read again.
  * @return 0 on success; negative POSIX error code on error.
  */
 int GcnPartitionPrivate::loadFst(void)
@@ -117,6 +125,49 @@ int GcnPartitionPrivate::loadFst(void)
 	if (fst) {
 		// FST is already loaded.
 		return 0;
+	}
+
+	int ret = initFstPartial();
+	if (ret != 0) {
+		// Error initializing the FST buffer.
+		return ret;
+	}
+
+	// Read the rest of the FST.
+	if (!fstRange(0, fstPartial_len)) {
+		// Read error.
+		return -q->m_lastError;
+	}
+
+	// Create the GcnFst.
+	// NOTE: GcnFst takes ownership of the buffer,
+	// so it isn't copied.
+	GcnFst *const gcnFst = GcnFst::takeFstData(fstPartial, fstPartial_len, offsetShift);
+	fstPartial = nullptr;
+	fstPartial_len = 0;
+	fstFileCount = 0;
+	fstBlockLoaded.clear();
+	if (gcnFst->hasErrors()) {
+		// FST has errors.
+		delete gcnFst;
+		q->m_lastError = EIO;
+		return -EIO;
+	}
+	this->fst = gcnFst;
+	return 0;
+}
+
+/**
+ * Initialize partial FST loading.
+ * This validates the FST size and reads the root directory entry.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GcnPartitionPrivate::initFstPartial(void)
+{
+	RP_Q(GcnPartition);
+	if (fstPartial) {
+		// Already initialized.
+		return 0;
 	} else if (data_offset < 0) {
 		// Partition is invalid.
 		q->m_lastError = EINVAL;
@@ -143,35 +194,232 @@ int GcnPartitionPrivate::loadFst(void)
 		return -EIO;
 	}
 
-	// Seek to the beginning of the FST.
-	ret = q->seek(static_cast<off64_t>(bootBlock.fst_offset) << offsetShift);
-	if (ret != 0) {
-		// Seek failed.
+	// NOTE: +1 for NULL termination. (required by GcnFst)
+	const uint32_t fstData_len = bootBlock.fst_size << offsetShift;
+	if (fstData_len < sizeof(GCN_FST_Entry)) {
+		// FST is too small.
+		q->m_lastError = EIO;
+		return -EIO;
+	}
+	fstPartial = new uint8_t[static_cast<size_t>(fstData_len) + 1];
+	fstPartial[fstData_len] = 0;
+	fstPartial_len = fstData_len;
+	fstBlockLoaded.assign((fstData_len + FST_BLOCK_SIZE - 1) / FST_BLOCK_SIZE, false);
+
+	// Get the file count from the root directory entry.
+	// These checks match GcnFst.
+	const GCN_FST_Entry *const root_entry =
+		reinterpret_cast<const GCN_FST_Entry*>(fstRange(0, sizeof(GCN_FST_Entry)));
+	if (!root_entry) {
+		// Read error.
 		return -q->m_lastError;
 	}
+	const uint32_t file_count = be32_to_cpu(root_entry->root_dir.file_count);
+	if (file_count <= 1 || file_count > (fstData_len / sizeof(GCN_FST_Entry)) ||
+	    file_count * sizeof(GCN_FST_Entry) >= fstData_len)
+	{
+		// File count is invalid.
+		// NOTE: fstFileCount stays 0, so findFilePartial() fails.
+		return 0;
+	}
+	fstFileCount = file_count;
+	return 0;
+}
 
-	// Read the FST.
-	// TODO: Eliminate the extra copy?
-	uint32_t fstData_len = bootBlock.fst_size << offsetShift;
-	uint8_t *const fstData = new uint8_t[fstData_len];
-	size_t size = q->read(fstData, fstData_len);
-	if (size != fstData_len) {
-		// Short read.
-		delete[] fstData;
+/**
+ * Get a range of the FST, reading any blocks that aren't loaded yet.
+ * initFstPartial() must have been called first.
+ * @param offset Offset in the FST.
+ * @param len Length.
+ * @return Pointer to the range in fstPartial, or nullptr on error.
+ */
+const uint8_t *GcnPartitionPrivate::fstRange(uint32_t offset, uint32_t len)
+{
+	RP_Q(GcnPartition);
+	assert(fstPartial != nullptr);
+	if (!fstPartial || offset > fstPartial_len || len > fstPartial_len - offset) {
+		// Out of range.
 		q->m_lastError = EIO;
-		return -EIO;
+		return nullptr;
+	} else if (len == 0) {
+		return &fstPartial[offset];
 	}
 
-	// Create the GcnFst.
-	GcnFst *const gcnFst = new GcnFst(fstData, fstData_len, offsetShift);
-	delete[] fstData;	// TODO: Eliminate the extra copy?
-	if (gcnFst->hasErrors()) {
-		// FST has errors.
-		delete gcnFst;
-		q->m_lastError = EIO;
+	const uint32_t firstBlock = offset / FST_BLOCK_SIZE;
+	const uint32_t lastBlock = (offset + len - 1) / FST_BLOCK_SIZE;
+	for (uint32_t block = firstBlock; block <= lastBlock; block++) {
+		if (fstBlockLoaded[block])
+			continue;
+
+		// Read consecutive missing blocks at once.
+		uint32_t endBlock = block + 1;
+		while (endBlock <= lastBlock && !fstBlockLoaded[endBlock]) {
+			endBlock++;
+		}
+		const uint32_t blockStart = block * FST_BLOCK_SIZE;
+		const uint32_t blockEnd = std::min(endBlock * FST_BLOCK_SIZE, fstPartial_len);
+		const uint32_t readLen = blockEnd - blockStart;
+
+		int ret = q->seek((static_cast<off64_t>(bootBlock.fst_offset) << offsetShift) + blockStart);
+		if (ret != 0) {
+			// Seek failed.
+			return nullptr;
+		}
+		size_t size = q->read(&fstPartial[blockStart], readLen);
+		if (size != readLen) {
+			// Short read.
+			q->m_lastError = EIO;
+			return nullptr;
+		}
+
+		for (; block < endBlock; block++) {
+			fstBlockLoaded[block] = true;
+		}
+		block--;
+	}
+
+	return &fstPartial[offset];
+}
+
+/**
+ * Get an FST entry's name using partial FST loading.
+ * @param fst_entry FST entry.
+ * @return Name, converted to UTF-8. (empty on error)
+ */
+string GcnPartitionPrivate::fstEntryNamePartial(const GCN_FST_Entry *fst_entry)
+{
+	const uint32_t string_table_offset = fstFileCount * sizeof(GCN_FST_Entry);
+	const uint32_t name_offset = be32_to_cpu(fst_entry->file_type_name_offset) & 0xFFFFFF;
+	if (name_offset >= fstPartial_len - string_table_offset) {
+		// Out of range.
+		return string();
+	}
+
+	// Read blocks until the NULL terminator is found.
+	// NOTE: fstPartial[fstPartial_len] is always 0.
+	uint32_t pos = string_table_offset + name_offset;
+	const char *const str = reinterpret_cast<const char*>(&fstPartial[pos]);
+	while (pos < fstPartial_len) {
+		const uint32_t blockEnd = std::min((pos / FST_BLOCK_SIZE + 1) * FST_BLOCK_SIZE, fstPartial_len);
+		if (!fstRange(pos, blockEnd - pos)) {
+			// Read error.
+			return string();
+		}
+		if (memchr(&fstPartial[pos], 0, blockEnd - pos) != nullptr)
+			break;
+		pos = blockEnd;
+	}
+
+	return cp1252_sjis_to_utf8(str, static_cast<int>(strlen(str)));
+}
+
+/**
+ * Find a file using partial FST loading.
+ * This matches GcnFst::find_file(), except dirent->name isn't set.
+ * @param filename	[in] Filename.
+ * @param dirent	[out] Directory entry.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GcnPartitionPrivate::findFilePartial(const char *filename, IFst::DirEnt *dirent)
+{
+	assert(filename != nullptr);
+	assert(dirent != nullptr);
+	if (!filename || !dirent) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	int ret = initFstPartial();
+	if (ret != 0) {
+		// Error initializing the FST buffer.
+		return ret;
+	} else if (fstFileCount == 0) {
+		// FST is invalid.
 		return -EIO;
 	}
-	this->fst = gcnFst;
+
+	// Directory being searched: [idx, last_fst_idx)
+	// NOTE: last_fst_idx is the index *after* the last file.
+	uint32_t idx = 0;	// root directory
+	uint32_t last_fst_idx = fstFileCount;
+	GCN_FST_Entry fst_entry;
+	memcpy(&fst_entry, fstPartial, sizeof(fst_entry));
+	bool is_dir = true;
+
+	const char *p = filename;
+	while (*p != '\0') {
+		// Skip slashes, including empty path components.
+		if (*p == '/') {
+			p++;
+			continue;
+		}
+
+		if (!is_dir) {
+			// More path components after a file.
+			return -ENOENT;
+		}
+
+		const char *const slash = strchr(p, '/');
+		const string path_component(p, (slash ? static_cast<size_t>(slash - p) : strlen(p)));
+		p += path_component.size();
+
+		// Search this directory for a matching path component.
+		bool found = false;
+		for (idx++; idx < last_fst_idx; idx++) {
+			const GCN_FST_Entry *const pEntry = reinterpret_cast<const GCN_FST_Entry*>(
+				fstRange(idx * sizeof(GCN_FST_Entry), sizeof(GCN_FST_Entry)));
+			if (!pEntry) {
+				// Read error.
+				return -EIO;
+			}
+			memcpy(&fst_entry, pEntry, sizeof(fst_entry));
+			is_dir = ((be32_to_cpu(fst_entry.file_type_name_offset) >> 24) == 1);
+
+			// TODO: Is GCN/Wii case-sensitive?
+			if (fstEntryNamePartial(&fst_entry) == path_component) {
+				// Found a match.
+				found = true;
+				break;
+			}
+
+			// If this is a directory, skip it.
+			if (is_dir) {
+				// NOTE: next_offset is the index *after* the
+				// last entry in the subdirectory, so we have to
+				// subtract 1 for proper enumeration.
+				const uint32_t next_offset = be32_to_cpu(fst_entry.dir.next_offset);
+				if (next_offset <= idx) {
+					// Subdirectory is out of range.
+					return -EIO;
+				}
+				idx = next_offset - 1;
+			}
+		}
+
+		if (!found) {
+			// No match.
+			return -ENOENT;
+		}
+
+		if (is_dir) {
+			// Search the subdirectory next.
+			const uint32_t next_offset = be32_to_cpu(fst_entry.dir.next_offset);
+			last_fst_idx = std::min(next_offset, fstFileCount);
+		}
+	}
+
+	// Copy the relevant information to dirent.
+	dirent->type = (is_dir ? DT_DIR : DT_REG);
+	dirent->name = nullptr;
+	if (is_dir) {
+		// offset and size are not valid for directories.
+		dirent->offset = 0;
+		dirent->size = 0;
+	} else {
+		// Save the offset and size.
+		dirent->offset = static_cast<off64_t>(be32_to_cpu(fst_entry.file.offset)) << offsetShift;
+		dirent->size = be32_to_cpu(fst_entry.file.size);
+	}
 	return 0;
 }
 
@@ -12,6 +12,12 @@
 #include <stdint.h>
 #include "../Console/gcn_structs.h"
 
+// librpbase
+#include "librpbase/disc/IFst.hpp"
+
+// C++ includes.
+#include <vector>
+
 namespace LibRpBase {
 	class IDiscReader;
 }
@@ -68,9 +74,58 @@ class GcnPartitionPrivate
 
 		/**
 		 * Load the FST.
+		 * Blocks that were already read by findFilePartial() aren't read again.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		int loadFst(void);
+
+		/** Partial FST loading **/
+
+		// Looking up a single file only needs a few FST entries
+		// and names, so findFilePartial() reads the FST in blocks
+		// as needed instead of loading the whole thing. This matters
+		// for Wii partitions, where every byte has to be decrypted.
+		static const uint32_t FST_BLOCK_SIZE = 4096;
+
+		// FST buffer. (len+1 bytes, allocated with new[])
+		// Only blocks marked in fstBlockLoaded are valid.
+		// loadFst() takes ownership of this buffer.
+		uint8_t *fstPartial;
+		uint32_t fstPartial_len;
+		uint32_t fstFileCount;
+		std::vector<bool> fstBlockLoaded;
+
+		/**
+		 * Initialize partial FST loading.
+		 * This validates the FST size and reads the root directory entry.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int initFstPartial(void);
+
+		/**
+		 * Get a range of the FST, reading any blocks that aren't loaded yet.
+		 * initFstPartial() must have been called first.
+		 * @param offset Offset in the FST.
+		 * @param len Length.
+		 * @return Pointer to the range in fstPartial, or nullptr on error.
+		 */
+		const uint8_t *fstRange(uint32_t offset, uint32_t len);
+
+		/**
+		 * Get an FST entry's name using partial FST loading.
+		 * @param fst_entry FST entry.
+		 * @return Name, converted to UTF-8. (empty on error)
+		 */
+		std::string fstEntryNamePartial(const GCN_FST_Entry *fst_entry);
+
+		/**
+		 * Find a file using partial FST loading.
+		 * This matches GcnFst::find_file(), except dirent->name isn't set.
+		 * @param filename	[in] Filename.
+		 * @param dirent	[out] Directory entry.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int findFilePartial(const char *filename, LibRpBase::IFst::DirEnt *dirent);
 };
 
 }
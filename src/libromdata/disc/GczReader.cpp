@@ -56,14 +56,6 @@ class GczReaderPrivate : public SparseDiscReaderPrivate {
 		ao::uvector<uint64_t> blockPointers;
 		ao::uvector<uint32_t> hashes;
 
-		// Block cache.
-		ao::uvector<uint8_t> blockCache;
-		uint32_t blockCacheIdx;
-
-		// Decompression buffer.
-		// (Same size as blockCache.)
-		ao::uvector<uint8_t> z_buffer;
-
 		// Starting offset of the data area.
 		// This offset must be added to the blockPointers value.
 		uint32_t dataOffset;
@@ -80,7 +72,6 @@ class GczReaderPrivate : public SparseDiscReaderPrivate {
 
 GczReaderPrivate::GczReaderPrivate(GczReader *q)
 	: super(q)
-	, blockCacheIdx(~0U)
 	, dataOffset(0)
 {
 	// Clear the GCZ header struct.
@@ -263,11 +254,12 @@ GczReader::GczReader(IRpFile *file)
 	}
 	d->dataOffset = static_cast<uint32_t>(pos);
 
-	// Initialize the block cache and decompression buffer.
+	// Initialize the block cache.
 	// NOTE: Extra 64 bytes is for zlib, in case it needs it.
-	d->blockCache.resize(d->block_size + 64);
-	d->z_buffer.resize(d->block_size + 64);
-	d->blockCacheIdx = ~0U;
+	// Extra blocks are cached for sequential read-ahead.
+	d->initBlockCache(SparseDiscReaderPrivate::DEFAULT_BLOCK_CACHE_COUNT +
+		SparseDiscReaderPrivate::DEFAULT_READ_AHEAD_COUNT, d->block_size + 64);
+	d->parallelLoad = true;
 
 	// Reset the disc position.
 	d->pos = 0;
@@ -374,42 +366,19 @@ off64_t GczReader::getPhysBlockAddr(uint32_t blockIdx) const
 }
 
 /**
- * Read the specified block.
- *
- * This can read either a full block or a partial block.
- * For a full block, set pos = 0 and size = block_size.
+ * Read the raw data for the specified block.
+ * This reads the compressed data if the block is compressed.
  *
  * @param blockIdx	[in] Block index.
- * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
- * @param ptr		[out] Output data buffer.
- * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
- * @return Number of bytes read, or -1 if the block index is invalid.
+ * @param pRaw		[out] Raw data buffer. (size is the block cache buffer size)
+ * @param pRawSize	[out] Size of the raw data.
+ * @return 0 on success; negative POSIX error code on error.
  */
-int GczReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
+int GczReader::readRawBlock(uint32_t blockIdx, uint8_t *pRaw, size_t *pRawSize)
 {
-	// Read 'size' bytes of block 'blockIdx', starting at 'pos'.
 	// NOTE: This can only be called by SparseDiscReader,
 	// so the main assertions are already checked there.
-	RP_D(GczReader);
-	assert(pos >= 0 && pos < (int)d->block_size);
-	assert(size <= d->block_size);
-	// TODO: Make sure overflow doesn't occur.
-	assert(static_cast<off64_t>(pos + size) <= static_cast<off64_t>(d->block_size));
-	if (pos < 0 || static_cast<off64_t>(pos + size) > static_cast<off64_t>(d->block_size)) {
-		// pos+size is out of range.
-		return -1;
-	}
-
-	if (unlikely(size == 0)) {
-		// Nothing to read.
-		return 0;
-	}
-
-	if (blockIdx == d->blockCacheIdx) {
-		// Block is cached.
-		memcpy(ptr, &d->blockCache[pos], size);
-		return size;
-	}
+	RP_D(const GczReader);
 
 	// NOTE: If this is the last block, then we might have
 	// a short read. We'll allow it.
@@ -419,93 +388,87 @@ int GczReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 	const uint64_t blockPointer = d->blockPointers[blockIdx];
 	const off64_t physBlockAddr = static_cast<off64_t>(blockPointer & ~GCZ_FLAG_BLOCK_NOT_COMPRESSED) + d->dataOffset;
 	const uint32_t z_block_size = d->getBlockCompressedSize(blockIdx);
-	if (z_block_size == 0) {
-		// Unable to get the block's compressed size...
-		m_lastError = EIO;
-		return 0;
+	if (z_block_size == 0 || z_block_size > d->block_size) {
+		// Unable to get the block's compressed size,
+		// or the compressed data is larger than the
+		// uncompressed block size...
+		return -EIO;
 	}
 
-	bool compressed = (!(blockPointer & GCZ_FLAG_BLOCK_NOT_COMPRESSED));
+	const bool compressed = (!(blockPointer & GCZ_FLAG_BLOCK_NOT_COMPRESSED));
 	if (!compressed) {
 		// (Un)compressed block size must match the actual block size.
 		if (z_block_size != d->block_size) {
 			// Error...
-			m_lastError = EIO;
-			return 0;
+			return -EIO;
 		}
 	}
 
-	if (!compressed) {
-		// Reading uncompressed data directly into the cache.
-		if (isLastBlock) {
-			memset(d->blockCache.data(), 0, d->blockCache.size());
+	size_t sz_read = m_file->pread(physBlockAddr, pRaw, z_block_size);
+	if (sz_read != z_block_size && (compressed || !isLastBlock)) {
+		// Read error.
+		int err = m_file->lastError();
+		if (err == 0) {
+			err = EIO;
 		}
+		return -err;
+	}
 
-		size_t sz_read = m_file->seekAndRead(physBlockAddr, d->blockCache.data(), z_block_size);
-		if (sz_read != z_block_size && !isLastBlock) {
-			// Seek and/or read error.
-			d->blockCacheIdx = ~0U;
-			m_lastError = m_file->lastError();
-			if (m_lastError == 0) {
-				m_lastError = EIO;
-			}
-			return 0;
-		}
-		d->blockCacheIdx = blockIdx;
-	} else {
-		// Read compressed data into a temporary buffer,
-		// then decompress it.
-		if (z_block_size > d->block_size) {
-			// Compressed data is larger than the uncompressed block size...
-			m_lastError = EIO;
-			return 0;
-		}
+	*pRawSize = sz_read;
+	return 0;
+}
 
-		size_t sz_read = m_file->seekAndRead(physBlockAddr, d->z_buffer.data(), z_block_size);
-		if (sz_read != z_block_size) {
-			// Seek and/or read error.
-			m_lastError = m_file->lastError();
-			if (m_lastError == 0) {
-				m_lastError = EIO;
-			}
-			return 0;
-		}
+/**
+ * Decode raw block data into a block buffer.
+ * The block will be decompressed if necessary.
+ *
+ * @param blockIdx	[in] Block index.
+ * @param pRaw		[in] Raw data from readRawBlock().
+ * @param rawSize	[in] Size of the raw data.
+ * @param pBuf		[out] Block buffer. (at least block_size bytes)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GczReader::decodeRawBlock(uint32_t blockIdx, const uint8_t *pRaw, size_t rawSize, uint8_t *pBuf) const
+{
+	RP_D(const GczReader);
 
-		// Verify the hash of the *compressed* data.
-		uint32_t hash_calc = adler32(0L, Z_NULL, 0);
-		hash_calc = adler32(hash_calc, d->z_buffer.data(), z_block_size);
-		if (hash_calc != le32_to_cpu(d->hashes[blockIdx])) {
-			// Hash error.
-			// TODO: Print warnings and/or more comprehensive error codes.
-			m_lastError = EIO;
-			return 0;
-		}
+	const bool compressed = (!(d->blockPointers[blockIdx] & GCZ_FLAG_BLOCK_NOT_COMPRESSED));
+	if (!compressed) {
+		// Uncompressed data.
+		// NOTE: The last block might be a short read.
+		return super::decodeRawBlock(blockIdx, pRaw, rawSize, pBuf);
+	}
 
-		// Decompress the data.
-		z_stream z = { };
-		z.next_in = d->z_buffer.data();
-		z.avail_in = z_block_size;
-		z.next_out = d->blockCache.data();
-		z.avail_out = d->block_size;
-		inflateInit(&z);
-
-		int status = inflate(&z, Z_FULL_FLUSH);
-		const uint32_t uncomp_size = d->block_size - z.avail_out;
-		inflateEnd(&z);
-
-		if (status != Z_STREAM_END || uncomp_size != d->block_size) {
-			// Decompression error.
-			// TODO: Print warnings and/or more comprehensive error codes.
-			d->blockCacheIdx = ~0U;
-			m_lastError = EIO;
-			return 0;
-		}
+	// Verify the hash of the *compressed* data.
+	const uint32_t z_block_size = static_cast<uint32_t>(rawSize);
+	uint32_t hash_calc = adler32(0L, Z_NULL, 0);
+	hash_calc = adler32(hash_calc, pRaw, z_block_size);
+	if (hash_calc != le32_to_cpu(d->hashes[blockIdx])) {
+		// Hash error.
+		// TODO: Print warnings and/or more comprehensive error codes.
+		return -EIO;
 	}
 
-	// Block has been loaded into the cache.
-	memcpy(ptr, &d->blockCache[pos], size);
-	d->blockCacheIdx = blockIdx;
-	return size;
+	// Decompress the data.
+	z_stream z = { };
+	z.next_in = const_cast<Bytef*>(pRaw);
+	z.avail_in = z_block_size;
+	z.next_out = pBuf;
+	z.avail_out = d->block_size;
+	inflateInit(&z);
+
+	int status = inflate(&z, Z_FULL_FLUSH);
+	const uint32_t uncomp_size = d->block_size - z.avail_out;
+	inflateEnd(&z);
+
+	if (status != Z_STREAM_END || uncomp_size != d->block_size) {
+		// Decompression error.
+		// TODO: Print warnings and/or more comprehensive error codes.
+		return -EIO;
+	}
+
+	// Block has been decompressed.
+	return 0;
 }
 
 }
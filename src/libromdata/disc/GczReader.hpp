@@ -64,19 +64,27 @@ class GczReader : public LibRpBase::SparseDiscReader
 		off64_t getPhysBlockAddr(uint32_t blockIdx) const final;
 
 		/**
-		 * Read the specified block.
+		 * Read the raw data for the specified block.
+		 * This reads the compressed data if the block is compressed.
 		 *
-		 * This can read either a full block or a partial block.
-		 * For a full block, set pos = 0 and size = block_size.
+		 * @param blockIdx	[in] Block index.
+		 * @param pRaw		[out] Raw data buffer. (size is the block cache buffer size)
+		 * @param pRawSize	[out] Size of the raw data.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int readRawBlock(uint32_t blockIdx, uint8_t *pRaw, size_t *pRawSize) final;
+
+		/**
+		 * Decode raw block data into a block buffer.
+		 * The block will be decompressed if necessary.
 		 *
 		 * @param blockIdx	[in] Block index.
-		 * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
-		 * @param ptr		[out] Output data buffer.
-		 * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
-		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 * @param pRaw		[in] Raw data from readRawBlock().
+		 * @param rawSize	[in] Size of the raw data.
+		 * @param pBuf		[out] Block buffer. (at least block_size bytes)
+		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		ATTR_ACCESS_SIZE(write_only, 4, 5)
-		int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size) final;
+		int decodeRawBlock(uint32_t blockIdx, const uint8_t *pRaw, size_t rawSize, uint8_t *pBuf) const final;
 };
 
 }
@@ -47,6 +47,7 @@ class GdiReaderPrivate : public SparseDiscReaderPrivate {
 
 		// Block range mapping.
 		// NOTE: This currently *only* contains data tracks.
+		// Sorted by blockStart.
 		struct BlockRange {
 			unsigned int blockStart;	// First LBA.
 			unsigned int blockEnd;		// Last LBA. (inclusive) (0 if the file hasn't been opened yet)
@@ -54,8 +55,10 @@ class GdiReaderPrivate : public SparseDiscReaderPrivate {
 			uint8_t trackNumber;		// 01 through 99
 			uint8_t reserved;
 			// TODO: Data vs. audio?
+			int openError;			// Error from openTrack(). (0 if not attempted or successful)
+			unsigned int lastUsed;		// openTrack() usage counter value, for closing old tracks.
 			string filename;		// Relative to the .gdi file. Cleared on error.
-			IRpFile *file;
+			IRpFile *file;			// Track file. (nullptr if not open)
 		};
 		vector<BlockRange> blockRanges;
 
@@ -64,6 +67,18 @@ class GdiReaderPrivate : public SparseDiscReaderPrivate {
 		// Value = pointer to BlockRange in blockRanges.
 		vector<BlockRange*> trackMappings;
 
+		// Maximum number of track files that can be open at once.
+		// If another track is needed, the least recently used
+		// track file is closed. Its block range is kept, so it
+		// can be reopened without probing the other tracks.
+		static const unsigned int MAX_OPEN_TRACKS = 4;
+		unsigned int openTrackCount;	// Number of open track files.
+		unsigned int useCounter;	// Incremented by openTrack().
+
+		// Block range used by the last readBlock() call.
+		// Sequential reads usually stay within the same track.
+		BlockRange *lastBlockRange;
+
 		/**
 		 * Close all opened files.
 		 */
@@ -83,6 +98,14 @@ class GdiReaderPrivate : public SparseDiscReaderPrivate {
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		int openTrack(int trackNumber);
+
+		/**
+		 * Find the block range containing the specified block
+		 * and make sure its track file is open.
+		 * @param blockIdx Block index.
+		 * @return Block range, or nullptr if not found.
+		 */
+		BlockRange *findBlockRange(uint32_t blockIdx);
 };
 
 /** GdiReaderPrivate **/
@@ -90,6 +113,9 @@ class GdiReaderPrivate : public SparseDiscReaderPrivate {
 GdiReaderPrivate::GdiReaderPrivate(GdiReader *q)
 	: super(q)
 	, blockCount(0)
+	, openTrackCount(0)
+	, useCounter(0)
+	, lastBlockRange(nullptr)
 { }
 
 GdiReaderPrivate::~GdiReaderPrivate()
@@ -109,6 +135,8 @@ void GdiReaderPrivate::close(void)
 	);
 	blockRanges.clear();
 	trackMappings.clear();
+	openTrackCount = 0;
+	lastBlockRange = nullptr;
 
 	// GDI file.
 	RP_Q(GdiReader);
@@ -213,6 +241,8 @@ int GdiReaderPrivate::parseGdiFile(char *gdibuf)
 		blockRange.sectorSize = static_cast<uint16_t>(sectorSize);
 		blockRange.trackNumber = static_cast<uint8_t>(trackNumber);
 		blockRange.reserved = 0;
+		blockRange.openError = 0;
+		blockRange.lastUsed = 0;
 		// FIXME: UTF-8 or Latin-1?
 		filename[sizeof(filename)-1] = 0;
 		blockRange.filename = latin1_to_utf8(filename, -1);
@@ -222,8 +252,18 @@ int GdiReaderPrivate::parseGdiFile(char *gdibuf)
 		trackMappings[trackNumber-1] = &blockRange;
 	}
 
+	// Sort the block ranges by LBA so findBlockRange()
+	// can use a binary search, then update the track mappings.
+	std::sort(blockRanges.begin(), blockRanges.end(),
+		[](const BlockRange &a, const BlockRange &b) {
+			return (a.blockStart < b.blockStart);
+		}
+	);
+	for (BlockRange &blockRange : blockRanges) {
+		trackMappings[blockRange.trackNumber-1] = &blockRange;
+	}
+
 	// Done parsing the GDI.
-	// TODO: Sort by LBA?
 	return 0;
 }
 
@@ -256,7 +296,27 @@ int GdiReaderPrivate::openTrack(int trackNumber)
 
 	if (blockRange->file) {
 		// File is already open.
+		blockRange->lastUsed = ++useCounter;
 		return 0;
+	} else if (blockRange->openError != 0) {
+		// A previous attempt to open this track failed.
+		// Don't probe for the file again.
+		return blockRange->openError;
+	}
+
+	if (openTrackCount >= MAX_OPEN_TRACKS) {
+		// Too many open tracks. Close the least recently used one.
+		BlockRange *lru = nullptr;
+		for (BlockRange &br : blockRanges) {
+			if (br.file && (!lru || br.lastUsed < lru->lastUsed)) {
+				lru = &br;
+			}
+		}
+		assert(lru != nullptr);
+		if (lru) {
+			UNREF_AND_NULL_NOCHK(lru->file);
+			openTrackCount--;
+		}
 	}
 
 	// Separate the file extension.
@@ -276,6 +336,7 @@ int GdiReaderPrivate::openTrack(int trackNumber)
 	if (!file) {
 		// Unable to open the file.
 		// TODO: Return the actual error.
+		blockRange->openError = -ENOENT;
 		return -ENOENT;
 	}
 
@@ -284,6 +345,7 @@ int GdiReaderPrivate::openTrack(int trackNumber)
 	if (fileSize <= 0) {
 		// Empty or invalid file...
 		file->unref();
+		blockRange->openError = -EIO;
 		return -EIO;
 	}
 
@@ -291,15 +353,59 @@ int GdiReaderPrivate::openTrack(int trackNumber)
 	if (fileSize % blockRange->sectorSize != 0) {
 		// Not a multiple of the sector size.
 		file->unref();
+		blockRange->openError = -EIO;
 		return -EIO;
 	}
 
 	// File opened.
+	// NOTE: If the track was closed by the open track limit,
+	// blockEnd was already set, but the file might have changed.
 	blockRange->blockEnd = blockRange->blockStart + static_cast<unsigned int>(fileSize / blockRange->sectorSize) - 1;
 	blockRange->file = file;
+	blockRange->lastUsed = ++useCounter;
+	openTrackCount++;
 	return 0;
 }
 
+/**
+ * Find the block range containing the specified block
+ * and make sure its track file is open.
+ * @param blockIdx Block index.
+ * @return Block range, or nullptr if not found.
+ */
+GdiReaderPrivate::BlockRange *GdiReaderPrivate::findBlockRange(uint32_t blockIdx)
+{
+	BlockRange *blockRange = lastBlockRange;
+	if (!blockRange || blockIdx < blockRange->blockStart || blockIdx > blockRange->blockEnd) {
+		// Not in the previous block range.
+		// Find the last block range that starts at or before blockIdx.
+		auto iter = std::upper_bound(blockRanges.begin(), blockRanges.end(), blockIdx,
+			[](uint32_t blockIdx, const BlockRange &br) {
+				return (blockIdx < br.blockStart);
+			}
+		);
+		if (iter == blockRanges.begin()) {
+			// Before the first data track.
+			return nullptr;
+		}
+		blockRange = &(*(iter - 1));
+	}
+
+	// Make sure the track is open.
+	// NOTE: blockEnd is set by openTrack().
+	if (openTrack(blockRange->trackNumber) != 0) {
+		// Unable to open the track.
+		return nullptr;
+	}
+	if (blockIdx > blockRange->blockEnd) {
+		// Past the end of this track, e.g. an audio track.
+		return nullptr;
+	}
+
+	lastBlockRange = blockRange;
+	return blockRange;
+}
+
 /** GdiReader **/
 
 GdiReader::GdiReader(IRpFile *file)
@@ -505,36 +611,7 @@ int GdiReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 	}
 
 	// Find the block.
-	// TODO: Cache this lookup somewhere or something.
-	const GdiReaderPrivate::BlockRange *blockRange = nullptr;
-	const auto blockRanges_cend = d->blockRanges.cend();
-	for (auto iter = d->blockRanges.cbegin(); iter != blockRanges_cend; ++iter) {
-		// NOTE: Using volatile because it can change in d->openTrack().
-		const volatile GdiReaderPrivate::BlockRange *const vbr = &(*iter);
-		if (blockIdx < vbr->blockStart) {
-			// Not in this track.
-			continue;
-		}
-
-		// Is the track loaded?
-		if (vbr->blockEnd == 0) {
-			// Track isn't loaded. Load it.
-			int ret = d->openTrack(vbr->trackNumber);
-			if (ret != 0) {
-				// Unable to load the track.
-				// Skip for now.
-				continue;
-			}
-		}
-
-		// Check the end block.
-		if (vbr->blockEnd != 0 && blockIdx <= vbr->blockEnd) {
-			// Found the track.
-			blockRange = (const GdiReaderPrivate::BlockRange*)vbr;
-			break;
-		}
-	}
-
+	const GdiReaderPrivate::BlockRange *const blockRange = d->findBlockRange(blockIdx);
 	if (!blockRange) {
 		// Not found in any block range.
 		return 0;
@@ -552,7 +629,7 @@ int GdiReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 		// 2352-byte sectors.
 		// TODO: Handle audio tracks properly?
 		CDROM_2352_Sector_t sector;
-		size_t sz_read = blockRange->file->seekAndRead(phys_pos, &sector, sizeof(sector));
+		size_t sz_read = blockRange->file->pread(phys_pos, &sector, sizeof(sector));
 		m_lastError = blockRange->file->lastError();
 		if (sz_read != sizeof(sector)) {
 			// Read error.
@@ -566,7 +643,7 @@ int GdiReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 	}
 
 	// 2048-byte sectors.
-	size_t sz_read = blockRange->file->seekAndRead(phys_pos, ptr, size);
+	size_t sz_read = blockRange->file->pread(phys_pos, ptr, size);
 	return (sz_read > 0 ? (int)sz_read : -1);
 }
 
@@ -16,7 +16,7 @@ using LibRpFile::IRpFile;
 
 // C++ STL classes.
 using std::string;
-using std::unordered_map;
+using std::vector;
 
 namespace LibRomData {
 
@@ -44,13 +44,37 @@ class IsoPartitionPrivate
 		// ISO primary volume descriptor.
 		ISO_Primary_Volume_Descriptor pvd;
 
-		// Directories.
-		// - Key: Directory name, WITHOUT leading slash. (Root == empty string)
-		// - Value: Directory entries.
+		// Raw directory records.
 		// NOTE: Directory entries are variable-length, so this
 		// is a byte array, not an ISO_DirEntry array.
 		typedef ao::uvector<uint8_t> DirData_t;
-		unordered_map<string, DirData_t> dir_data;
+
+		// Directory index entry.
+		struct DirEntryIdx_t {
+			uint32_t name_hash;	// Hash of the normalized name.
+			uint32_t name_offset;	// Normalized name offset in name_arena.
+			uint16_t name_len;	// Normalized name length.
+			bool has_version;	// True if the on-disc name has a ";1" suffix.
+			uint32_t rec_offset;	// ISO_DirEntry offset in Dir_t::data.
+			int subdir;		// Subdirectory index in dirs[], or -1 if not loaded.
+		};
+
+		// Directory.
+		// Each directory is read once. Its entries are indexed in a
+		// hash table keyed by the normalized name, i.e. uppercase
+		// with the ";1" suffix removed.
+		struct Dir_t {
+			DirData_t data;				// Raw directory records.
+			ao::uvector<DirEntryIdx_t> entries;	// Indexed entries, in on-disc order.
+			ao::uvector<uint32_t> buckets;		// Hash table: entry index + 1. (0 == empty)
+		};
+
+		// Loaded directories. (dirs[0] == root)
+		vector<Dir_t> dirs;
+
+		// Normalized entry names for all directories.
+		// Names are interned here to avoid a heap allocation per entry.
+		ao::uvector<char> name_arena;
 
 		/**
 		 * Find the last slash or backslash in a path.
@@ -70,21 +94,49 @@ class IsoPartitionPrivate
 		}
 
 		/**
-		 * Look up a directory entry from a base filename and directory.
-		 * @param pDir		[in] Directory.
+		 * Normalize a filename for lookup.
+		 * Converts to uppercase and removes a ";1" suffix.
+		 * @param dest		[out] Output buffer. (must be at least len bytes)
+		 * @param name		[in] Filename. (cp1252)
+		 * @param len		[in] Filename length.
+		 * @param pHash		[out] Hash of the normalized name.
+		 * @param pHasVersion	[out,opt] Set to true if a ";1" suffix was removed.
+		 * @return Normalized filename length.
+		 */
+		static unsigned int normalizeName(char *dest, const char *name, unsigned int len,
+			uint32_t *pHash, bool *pHasVersion = nullptr);
+
+		/**
+		 * Load and index a directory.
+		 * @param dir_addr	[in] Directory address, in bytes.
+		 * @param dir_size	[in] Directory size, in bytes.
+		 * @return Directory index on success; negative POSIX error code on error.
+		 */
+		int loadDir(off64_t dir_addr, uint32_t dir_size);
+
+		/**
+		 * Load the root directory.
+		 * @return Root directory index (0) on success; negative POSIX error code on error.
+		 */
+		int loadRootDir(void);
+
+		/**
+		 * Find an entry in a directory.
+		 * @param dirIdx	[in] Directory index.
 		 * @param filename	[in] Base filename. (cp1252)
+		 * @param len		[in] Filename length.
 		 * @param bFindDir	[in] True to find a subdirectory; false to find a file.
-		 * @return ISO directory entry.
+		 * @return Entry index on success; negative POSIX error code on error.
 		 */
-		const ISO_DirEntry *lookup_int(const DirData_t *pDir, const char *filename, bool bFindDir);
+		int findEntry(int dirIdx, const char *filename, unsigned int len, bool bFindDir) const;
 
 		/**
 		 * Get a directory.
 		 * @param path		[in] Pathname. (cp1252) (For root, specify "" or "/".)
-		 * @param pError	[out] POSIX error code on error.
-		 * @return Directory on success; nullptr on error.
+		 * @param path_len	[in] Pathname length.
+		 * @return Directory index on success; negative POSIX error code on error.
 		 */
-		const DirData_t *getDirectory(const char *path, int *pError = nullptr);
+		int getDirectory(const char *path, size_t path_len);
 
 		/**
 		 * Look up a directory entry from a filename.
@@ -148,34 +200,96 @@ IsoPartitionPrivate::IsoPartitionPrivate(IsoPartition *q,
 	}
 
 	// Load the root directory.
-	getDirectory("/");
+	loadRootDir();
 }
 
 IsoPartitionPrivate::~IsoPartitionPrivate()
 { }
 
 /**
- * Look up a directory entry from a base filename and directory.
- * @param pDir		[in] Directory.
- * @param filename	[in] Base filename. (cp1252)
- * @param bFindDir	[in] True to find a subdirectory; false to find a file.
- * @return ISO directory entry.
+ * Normalize a filename for lookup.
+ * Converts to uppercase and removes a ";1" suffix.
+ * @param dest		[out] Output buffer. (must be at least len bytes)
+ * @param name		[in] Filename. (cp1252)
+ * @param len		[in] Filename length.
+ * @param pHash		[out] Hash of the normalized name.
+ * @param pHasVersion	[out,opt] Set to true if a ";1" suffix was removed.
+ * @return Normalized filename length.
  */
-const ISO_DirEntry *IsoPartitionPrivate::lookup_int(const DirData_t *pDir, const char *filename, bool bFindDir)
+unsigned int IsoPartitionPrivate::normalizeName(char *dest, const char *name, unsigned int len,
+	uint32_t *pHash, bool *pHasVersion)
 {
-	// Find the file in the directory.
+	// 1990s and early 2000s CD-ROM games usually have
+	// ";1" filenames, so strip that here.
+	// TODO: Also allow other version numbers?
+	const bool has_version = (len >= 2 && name[len-2] == ';' && name[len-1] == '1');
+	if (has_version) {
+		len -= 2;
+	}
+	if (pHasVersion) {
+		*pHasVersion = has_version;
+	}
+
+	// FNV-1a hash of the uppercase name.
 	// NOTE: Filenames are case-insensitive.
-	// NOTE: File might have a ";1" suffix.
-	int err = ENOENT;
-	const unsigned int filename_len = static_cast<unsigned int>(strlen(filename));
-	const ISO_DirEntry *dirEntry_found = nullptr;
-	const uint8_t *p = pDir->data();
-	const uint8_t *const p_end = p + pDir->size();
-	while (p < p_end) {
-		const ISO_DirEntry *dirEntry = reinterpret_cast<const ISO_DirEntry*>(p);
+	uint32_t hash = 2166136261U;
+	for (unsigned int i = 0; i < len; i++) {
+		const char chr = static_cast<char>(TOUPPER(name[i]));
+		dest[i] = chr;
+		hash = (hash ^ static_cast<uint8_t>(chr)) * 16777619U;
+	}
+	*pHash = hash;
+	return len;
+}
+
+/**
+ * Load and index a directory.
+ * @param dir_addr	[in] Directory address, in bytes.
+ * @param dir_size	[in] Directory size, in bytes.
+ * @return Directory index on success; negative POSIX error code on error.
+ */
+int IsoPartitionPrivate::loadDir(off64_t dir_addr, uint32_t dir_size)
+{
+	RP_Q(IsoPartition);
+	if (dir_size > 16*1024*1024) {
+		// Directory is too big.
+		q->m_lastError = EIO;
+		return -EIO;
+	}
+
+	// NOTE: Due to variable-length entries, we need to load
+	// the entire directory all at once.
+	Dir_t dir;
+	dir.data.resize(dir_size);
+	size_t size = q->m_discReader->seekAndRead(dir_addr, dir.data.data(), dir.data.size());
+	if (size != dir.data.size()) {
+		// Seek and/or read error.
+		q->m_lastError = q->m_discReader->lastError();
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+		return -q->m_lastError;
+	}
+
+	// Index the directory entries.
+	// Block size. Directory records don't cross block boundaries;
+	// the remainder of a block is zero-padded.
+	const unsigned int block_size = pvd.logical_block_size.he;
+	const uint8_t *const p_start = dir.data.data();
+	const uint8_t *p = p_start;
+	const uint8_t *const p_end = p + dir.data.size();
+	while (p + sizeof(ISO_DirEntry) <= p_end) {
+		const ISO_DirEntry *const dirEntry = reinterpret_cast<const ISO_DirEntry*>(p);
 		if (dirEntry->entry_length < sizeof(*dirEntry)) {
-			// End of directory.
-			break;
+			// Padding at the end of the block.
+			// Skip to the next block.
+			const size_t pos = static_cast<size_t>(p - p_start);
+			if (block_size == 0 || dirEntry->entry_length != 0) {
+				// End of directory.
+				break;
+			}
+			p = p_start + ((pos / block_size) + 1) * block_size;
+			continue;
 		}
 
 		const char *const entry_filename = reinterpret_cast<const char*>(p) + sizeof(*dirEntry);
@@ -184,211 +298,211 @@ const ISO_DirEntry *IsoPartitionPrivate::lookup_int(const DirData_t *pDir, const
 			break;
 		}
 
-		// Check the filename.
-		// 1990s and early 2000s CD-ROM games usually have
-		// ";1" filenames, so check for that first.
-		if (dirEntry->filename_length == filename_len + 2) {
-			// +2 length match.
-			// This might have ";1".
-			if (!strncasecmp(entry_filename, filename, filename_len)) {
-				// Check for ";1".
-				// TODO: Also allow other version numbers?
-				if (entry_filename[filename_len]   == ';' &&
-				    entry_filename[filename_len+1] == '1')
-				{
-					// Found it!
-					// Verify directory vs. file.
-					bool isDir = !!(dirEntry->flags & ISO_FLAG_DIRECTORY);
-					if (isDir == bFindDir) {
-						// Directory attribute matches.
-						dirEntry_found = dirEntry;
-					} else {
-						// Not a match.
-						err = (isDir ? EISDIR : ENOTDIR);
-					}
-					break;
-				}
-			}
-		} else if (dirEntry->filename_length == filename_len) {
-			// Exact length match.
-			if (!strncasecmp(entry_filename, filename, filename_len)) {
-				// Found it!
-				dirEntry_found = dirEntry;
-				break;
-			}
-		}
+		// Intern the normalized name.
+		DirEntryIdx_t entry;
+		entry.name_offset = static_cast<uint32_t>(name_arena.size());
+		name_arena.resize(name_arena.size() + dirEntry->filename_length);
+		entry.name_len = static_cast<uint16_t>(normalizeName(
+			name_arena.data() + entry.name_offset, entry_filename, dirEntry->filename_length,
+			&entry.name_hash, &entry.has_version));
+		name_arena.resize(entry.name_offset + entry.name_len);
+		entry.rec_offset = static_cast<uint32_t>(p - p_start);
+		entry.subdir = -1;
+		dir.entries.push_back(entry);
 
 		// Next entry.
 		p += dirEntry->entry_length;
 	}
 
-	if (!dirEntry_found) {
-		RP_Q(IsoPartition);
-		q->m_lastError = err;
+	// Build the hash table.
+	// Load factor is at most 50%.
+	size_t bucket_count = 8;
+	while (bucket_count < dir.entries.size() * 2) {
+		bucket_count *= 2;
+	}
+	const size_t mask = bucket_count - 1;
+	dir.buckets.resize(bucket_count);
+	std::fill(dir.buckets.begin(), dir.buckets.end(), 0U);
+	for (size_t i = 0; i < dir.entries.size(); i++) {
+		// NOTE: Linear probing preserves on-disc order for duplicate names.
+		size_t b = dir.entries[i].name_hash & mask;
+		while (dir.buckets[b] != 0) {
+			b = (b + 1) & mask;
+		}
+		dir.buckets[b] = static_cast<uint32_t>(i + 1);
 	}
-	return dirEntry_found;
+
+	dirs.push_back(std::move(dir));
+	return static_cast<int>(dirs.size() - 1);
 }
 
 /**
- * Get a directory.
- * @param path		[in] Pathname. (cp1252) (For root, specify "" or "/".)
- * @param pError	[out] POSIX error code on error.
- * @return Directory on success; nullptr on error.
+ * Load the root directory.
+ * @return Root directory index (0) on success; negative POSIX error code on error.
  */
-const IsoPartitionPrivate::DirData_t *IsoPartitionPrivate::getDirectory(const char *path, int *pError)
+int IsoPartitionPrivate::loadRootDir(void)
 {
-	RP_Q(IsoPartition);
-	if (!path || !strcmp(path, "/")) {
-		// Root directory. Use "".
-		path = "";
-	}
-
-	// Check if this directory was already loaded.
-	auto iter = dir_data.find(path);
-	if (iter != dir_data.end()) {
-		// Directory is already loaded.
-		return &iter->second;
+	if (!dirs.empty()) {
+		// Root directory is already loaded.
+		return 0;
 	}
 
+	RP_Q(IsoPartition);
 	if (unlikely(!q->m_discReader)) {
 		// DiscReader isn't open.
 		q->m_lastError = EIO;
-		if (pError) {
-			*pError = EIO;
-		}
-		return nullptr;
+		return -EIO;
 	} else if (unlikely(pvd.header.type != ISO_VDT_PRIMARY || pvd.header.version != ISO_VD_VERSION)) {
 		// PVD isn't loaded.
 		q->m_lastError = EIO;
-		if (pError) {
-			*pError = EIO;
+		return -EIO;
+	}
+
+	// Check the root directory entry.
+	const ISO_DirEntry *const rootdir = &pvd.dir_entry_root;
+	if (iso_start_offset >= 0) {
+		// ISO start address was already determined.
+		if (rootdir->block.he < ((unsigned int)iso_start_offset + 2)) {
+			// Starting block is invalid.
+			q->m_lastError = EIO;
+			return -EIO;
 		}
-		return nullptr;
+	} else {
+		// We didn't find the ISO start address yet.
+		// This might be a 2048-byte single-track image,
+		// in which case, we'll need to assume that the
+		// root directory starts at block 20.
+		// TODO: Better heuristics.
+		if (rootdir->block.he < 20) {
+			// Starting block is invalid.
+			q->m_lastError = EIO;
+			return -EIO;
+		}
+		iso_start_offset = static_cast<int>(rootdir->block.he - 20);
 	}
 
 	// Block size.
 	// Should be 2048, but other values are possible.
 	const unsigned int block_size = pvd.logical_block_size.he;
 
-	if (path[0] == '\0') {
-		// Loading the root directory.
-
-		// Check the root directory entry.
-		const ISO_DirEntry *const rootdir = &pvd.dir_entry_root;
-		if (rootdir->size.he > 16*1024*1024) {
-			// Root directory is too big.
-			q->m_lastError = EIO;
-			if (pError) {
-				*pError = EIO;
-			}
-			return nullptr;
-		}
+	// Load the root directory.
+	const off64_t rootDir_addr = partition_offset +
+		static_cast<off64_t>(rootdir->block.he - iso_start_offset) * block_size;
+	return loadDir(rootDir_addr, rootdir->size.he);
+}
 
-		if (iso_start_offset >= 0) {
-			// ISO start address was already determined.
-			if (rootdir->block.he < ((unsigned int)iso_start_offset + 2)) {
-				// Starting block is invalid.
-				q->m_lastError = EIO;
-				if (pError) {
-					*pError = EIO;
-				}
-				return nullptr;
-			}
-		} else {
-			// We didn't find the ISO start address yet.
-			// This might be a 2048-byte single-track image,
-			// in which case, we'll need to assume that the
-			// root directory starts at block 20.
-			// TODO: Better heuristics.
-			if (rootdir->block.he < 20) {
-				// Starting block is invalid.
-				q->m_lastError = EIO;
-				if (pError) {
-					*pError = EIO;
-				}
-				return nullptr;
-			}
-			iso_start_offset = static_cast<int>(rootdir->block.he - 20);
+/**
+ * Find an entry in a directory.
+ * @param dirIdx	[in] Directory index.
+ * @param filename	[in] Base filename. (cp1252)
+ * @param len		[in] Filename length.
+ * @param bFindDir	[in] True to find a subdirectory; false to find a file.
+ * @return Entry index on success; negative POSIX error code on error.
+ */
+int IsoPartitionPrivate::findEntry(int dirIdx, const char *filename, unsigned int len, bool bFindDir) const
+{
+	assert(dirIdx >= 0 && dirIdx < static_cast<int>(dirs.size()));
+	const Dir_t &dir = dirs[dirIdx];
+
+	char nbuf[256];
+	if (len > sizeof(nbuf)) {
+		// Filename is too long for ISO-9660.
+		return -ENOENT;
+	}
+	uint32_t hash;
+	len = normalizeName(nbuf, filename, len, &hash);
+
+	const size_t mask = dir.buckets.size() - 1;
+	for (size_t b = hash & mask; dir.buckets[b] != 0; b = (b + 1) & mask) {
+		const unsigned int i = dir.buckets[b] - 1;
+		const DirEntryIdx_t &entry = dir.entries[i];
+		if (entry.name_hash != hash || entry.name_len != len ||
+		    memcmp(name_arena.data() + entry.name_offset, nbuf, len) != 0)
+		{
+			continue;
 		}
 
-		// Load the root directory.
-		// NOTE: Due to variable-length entries, we need to load
-		// the entire root directory all at once.
-		DirData_t dir;
-		dir.resize(rootdir->size.he);
-		const off64_t rootDir_addr = partition_offset +
-			static_cast<off64_t>(rootdir->block.he - iso_start_offset) * block_size;
-		size_t size = q->m_discReader->seekAndRead(rootDir_addr, dir.data(), dir.size());
-		if (size != dir.size()) {
-			// Seek and/or read error.
-			dir.clear();
-			q->m_lastError = q->m_discReader->lastError();
-			if (q->m_lastError == 0) {
-				q->m_lastError = EIO;
-			}
-			if (pError) {
-				*pError = q->m_lastError;
+		// Found it!
+		if (entry.has_version) {
+			// Verify directory vs. file.
+			const ISO_DirEntry *const dirEntry =
+				reinterpret_cast<const ISO_DirEntry*>(&dir.data[entry.rec_offset]);
+			const bool isDir = !!(dirEntry->flags & ISO_FLAG_DIRECTORY);
+			if (isDir != bFindDir) {
+				// Not a match.
+				return (isDir ? -EISDIR : -ENOTDIR);
 			}
-			return nullptr;
 		}
-
-		// Root directory loaded.
-		auto ins = dir_data.emplace("", std::move(dir));
-		return &(ins.first->second);
+		return static_cast<int>(i);
 	}
 
-	// Get the parent directory.
-	const DirData_t *pDir;
-	const char *const sl = findLastSlash(path);
-	if (!sl) {
-		// No slash. Parent is root.
-		pDir = getDirectory("");
-	} else {
-		// Found a slash.
-		string s_parentDir(path, (sl - path));
-		path = sl + 1;
-		pDir = getDirectory(s_parentDir.c_str());
-	}
+	// Not found.
+	return -ENOENT;
+}
 
-	if (!pDir) {
-		// Can't find the parent directory.
-		// getDirectory() already set q->lastError().
-		return nullptr;
+/**
+ * Get a directory.
+ * @param path		[in] Pathname. (cp1252) (For root, specify "" or "/".)
+ * @param path_len	[in] Pathname length.
+ * @return Directory index on success; negative POSIX error code on error.
+ */
+int IsoPartitionPrivate::getDirectory(const char *path, size_t path_len)
+{
+	RP_Q(IsoPartition);
+	int dirIdx = loadRootDir();
+	if (dirIdx < 0) {
+		// loadRootDir() already set q->lastError().
+		return dirIdx;
 	}
 
-	// Find this directory.
-	string s_subdir(utf8_to_cp1252(path, -1));
-	const ISO_DirEntry *const entry = lookup_int(pDir, s_subdir.c_str(), true);
-	if (!entry) {
-		// Not found.
-		// lookup_int() already set q->lastError().
-		return nullptr;
-	}
+	// Block size.
+	// Should be 2048, but other values are possible.
+	const unsigned int block_size = pvd.logical_block_size.he;
 
-	// Load the subdirectory.
-	// NOTE: Due to variable-length entries, we need to load
-	// the entire root directory all at once.
-	DirData_t dir;
-	dir.resize(entry->size.he);
-	const off64_t rootDir_addr = partition_offset +
-		static_cast<off64_t>(entry->block.he - iso_start_offset) * block_size;
-	size_t size = q->m_discReader->seekAndRead(rootDir_addr, dir.data(), dir.size());
-	if (size != dir.size()) {
-		// Seek and/or read error.
-		dir.clear();
-		q->m_lastError = q->m_discReader->lastError();
-		if (q->m_lastError == 0) {
-			q->m_lastError = EIO;
+	// Walk the path, one component at a time.
+	const char *p = path;
+	const char *const p_end = path + path_len;
+	while (p < p_end) {
+		// Find the end of this component.
+		const char *sl = p;
+		while (sl < p_end && *sl != '/' && *sl != '\\') {
+			sl++;
 		}
-		if (pError) {
-			*pError = q->m_lastError;
+		if (sl == p) {
+			// Empty component.
+			p++;
+			continue;
 		}
-		return nullptr;
+
+		// Find this subdirectory.
+		const int entryIdx = findEntry(dirIdx, p, static_cast<unsigned int>(sl - p), true);
+		if (entryIdx < 0) {
+			// Not found.
+			q->m_lastError = -entryIdx;
+			return entryIdx;
+		}
+
+		int subdir = dirs[dirIdx].entries[entryIdx].subdir;
+		if (subdir < 0) {
+			// Load the subdirectory.
+			const ISO_DirEntry *const dirEntry = reinterpret_cast<const ISO_DirEntry*>(
+				&dirs[dirIdx].data[dirs[dirIdx].entries[entryIdx].rec_offset]);
+			const off64_t dir_addr = partition_offset +
+				static_cast<off64_t>(dirEntry->block.he - iso_start_offset) * block_size;
+			subdir = loadDir(dir_addr, dirEntry->size.he);
+			if (subdir < 0) {
+				// loadDir() already set q->lastError().
+				return subdir;
+			}
+			// NOTE: loadDir() may have reallocated dirs[].
+			dirs[dirIdx].entries[entryIdx].subdir = subdir;
+		}
+
+		dirIdx = subdir;
+		p = sl;
 	}
 
-	// Subdirectory loaded.
-	auto ins = dir_data.emplace(std::move(s_subdir), std::move(dir));
-	return &(ins.first->second);
+	return dirIdx;
 }
 
 /**
@@ -414,30 +528,40 @@ const ISO_DirEntry *IsoPartitionPrivate::lookup(const char *filename)
 
 	// TODO: Which encoding?
 	// Assuming cp1252...
-	const DirData_t *pDir;
+	const string s_filename = utf8_to_cp1252(filename, -1);
+	const char *const cp_filename = s_filename.c_str();
 
 	// Is this file in a subdirectory?
-	const char *const sl = findLastSlash(filename);
+	const char *const sl = findLastSlash(cp_filename);
+	const char *basename;
+	int dirIdx;
 	if (sl) {
 		// This file is in a subdirectory.
-		string s_parentDir = utf8_to_cp1252(filename, static_cast<int>(sl - filename));
-		filename = sl + 1;
-		pDir = getDirectory(s_parentDir.c_str());
+		basename = sl + 1;
+		dirIdx = getDirectory(cp_filename, static_cast<size_t>(sl - cp_filename));
 	} else {
 		// Not in a subdirectory.
 		// Parent directory is root.
-		pDir = getDirectory("");
+		basename = cp_filename;
+		dirIdx = getDirectory("", 0);
 	}
 
-	if (!pDir) {
+	if (dirIdx < 0) {
 		// Error getting the directory.
 		// getDirectory() has already set q->lastError.
 		return nullptr;
 	}
 
 	// Find the file in the directory.
-	string s_filename = utf8_to_cp1252(filename, -1);
-	return lookup_int(pDir, s_filename.c_str(), false);
+	const int entryIdx = findEntry(dirIdx, basename,
+		static_cast<unsigned int>(s_filename.size() - (basename - cp_filename)), false);
+	if (entryIdx < 0) {
+		q->m_lastError = -entryIdx;
+		return nullptr;
+	}
+
+	const Dir_t &dir = dirs[dirIdx];
+	return reinterpret_cast<const ISO_DirEntry*>(&dir.data[dir.entries[entryIdx].rec_offset]);
 }
 
 /**
@@ -681,48 +805,12 @@ int IsoPartition::closedir(IFst::Dir *dirp)
  */
 IRpFile *IsoPartition::open(const char *filename)
 {
-	RP_D(IsoPartition);
-	assert(m_discReader != nullptr);
-	assert(m_discReader->isOpen());
-	if (!m_discReader ||  !m_discReader->isOpen()) {
-		m_lastError = EBADF;
-		return nullptr;
-	}
-
-	assert(filename != nullptr);
-	if (!filename || filename[0] == 0) {
-		// No filename.
-		m_lastError = EINVAL;
-		return nullptr;
-	}
-
 	// TODO: File reference counter.
 	// This might be difficult to do because PartitionFile is a separate class.
-	const ISO_DirEntry *const dirEntry = d->lookup(filename);
-	if (!dirEntry) {
-		// Not found.
-		return nullptr;
-	}
-
-	// Make sure this is a regular file.
-	// TODO: What is an "associated" file?
-	if (dirEntry->flags & (ISO_FLAG_ASSOCIATED | ISO_FLAG_DIRECTORY)) {
-		// Not a regular file.
-		m_lastError = ((dirEntry->flags & ISO_FLAG_DIRECTORY) ? EISDIR : EPERM);
-		return nullptr;
-	}
-
-	// Block size.
-	// Should be 2048, but other values are possible.
-	const unsigned int block_size = d->pvd.logical_block_size.he;
-
-	// Make sure the file is in bounds.
-	const off64_t file_addr = (static_cast<off64_t>(dirEntry->block.he) - d->iso_start_offset) * block_size;
-	if (file_addr >= d->partition_size + d->partition_offset ||
-	    file_addr > d->partition_size + d->partition_offset - dirEntry->size.he)
-	{
-		// File is out of bounds.
-		m_lastError = EIO;
+	off64_t file_addr, file_size;
+	int ret = findFileExtent(filename, &file_addr, &file_size);
+	if (ret != 0) {
+		m_lastError = -ret;
 		return nullptr;
 	}
 
@@ -730,7 +818,36 @@ IRpFile *IsoPartition::open(const char *filename)
 	// This is an IRpFile implementation that uses an
 	// IPartition as the reader and takes an offset
 	// and size as the file parameters.
-	return new PartitionFile(this, file_addr, dirEntry->size.he);
+	return new PartitionFile(this, file_addr, file_size);
+}
+
+/**
+ * Open multiple files. (read-only)
+ * Useful for probing a disc for several files at once.
+ * Directories are indexed on first use, so each directory
+ * is only read once.
+ * @param filenames	[in] Filenames.
+ * @param count		[in] Number of filenames.
+ * @param pFiles	[out] IRpFile* for each file, or nullptr if it couldn't be opened. (caller must unref())
+ * @param pErrors	[out,opt] POSIX error code for each file. (0 if opened)
+ * @return Number of files opened.
+ */
+unsigned int IsoPartition::openMany(const char *const *filenames, unsigned int count,
+	IRpFile **pFiles, int *pErrors)
+{
+	assert(filenames != nullptr);
+	assert(pFiles != nullptr);
+	unsigned int opened = 0;
+	for (unsigned int i = 0; i < count; i++) {
+		pFiles[i] = open(filenames[i]);
+		if (pFiles[i]) {
+			opened++;
+		}
+		if (pErrors) {
+			pErrors[i] = (pFiles[i] ? 0 : m_lastError);
+		}
+	}
+	return opened;
 }
 
 /**
@@ -767,4 +884,61 @@ time_t IsoPartition::get_mtime(const char *filename)
 	return d->parseTimestamp(&dirEntry->mtime);
 }
 
+/** Bulk extraction **/
+
+/**
+ * Find a file's extent within the partition.
+ * The offset is the same one PartitionFile uses.
+ * @param filename	[in] Filename.
+ * @param pOffset	[out] Partition offset.
+ * @param pSize		[out] File size.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int IsoPartition::findFileExtent(const char *filename, off64_t *pOffset, off64_t *pSize)
+{
+	RP_D(IsoPartition);
+	assert(m_discReader != nullptr);
+	assert(m_discReader->isOpen());
+	if (!m_discReader ||  !m_discReader->isOpen()) {
+		return -EBADF;
+	}
+
+	assert(filename != nullptr);
+	if (!filename || filename[0] == 0) {
+		// No filename.
+		return -EINVAL;
+	}
+
+	const ISO_DirEntry *const dirEntry = d->lookup(filename);
+	if (!dirEntry) {
+		// Not found.
+		// lookup() has already set m_lastError.
+		return (m_lastError != 0 ? -m_lastError : -ENOENT);
+	}
+
+	// Make sure this is a regular file.
+	// TODO: What is an "associated" file?
+	if (dirEntry->flags & (ISO_FLAG_ASSOCIATED | ISO_FLAG_DIRECTORY)) {
+		// Not a regular file.
+		return ((dirEntry->flags & ISO_FLAG_DIRECTORY) ? -EISDIR : -EPERM);
+	}
+
+	// Block size.
+	// Should be 2048, but other values are possible.
+	const unsigned int block_size = d->pvd.logical_block_size.he;
+
+	// Make sure the file is in bounds.
+	const off64_t file_addr = (static_cast<off64_t>(dirEntry->block.he) - d->iso_start_offset) * block_size;
+	if (file_addr >= d->partition_size + d->partition_offset ||
+	    file_addr > d->partition_size + d->partition_offset - dirEntry->size.he)
+	{
+		// File is out of bounds.
+		return -EIO;
+	}
+
+	*pOffset = file_addr;
+	*pSize = dirEntry->size.he;
+	return 0;
+}
+
 }
@@ -136,12 +136,39 @@ class IsoPartition : public LibRpBase::IPartition
 		 */
 		LibRpFile::IRpFile *open(const char *filename);
 
+		/**
+		 * Open multiple files. (read-only)
+		 * Useful for probing a disc for several files at once.
+		 * Directories are indexed on first use, so each directory
+		 * is only read once.
+		 * @param filenames	[in] Filenames.
+		 * @param count		[in] Number of filenames.
+		 * @param pFiles	[out] IRpFile* for each file, or nullptr if it couldn't be opened. (caller must unref())
+		 * @param pErrors	[out,opt] POSIX error code for each file. (0 if opened)
+		 * @return Number of files opened.
+		 */
+		unsigned int openMany(const char *const *filenames, unsigned int count,
+			LibRpFile::IRpFile **pFiles, int *pErrors = nullptr);
+
 		/**
 		 * Get a file's timestamp.
 		 * @param filename Filename.
 		 * @return Timestamp, or -1 on error.
 		 */
 		time_t get_mtime(const char *filename);
+
+	public:
+		/** Bulk extraction **/
+
+		/**
+		 * Find a file's extent within the partition.
+		 * The offset is the same one PartitionFile uses.
+		 * @param filename	[in] Filename.
+		 * @param pOffset	[out] Partition offset.
+		 * @param pSize		[out] File size.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int findFileExtent(const char *filename, off64_t *pOffset, off64_t *pSize) override;
 };
 
 }
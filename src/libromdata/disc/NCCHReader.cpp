@@ -12,6 +12,7 @@
 #include "NCCHReader.hpp"
 
 // librpbase, librpfile
+#include "librpfile/RpTrace.hpp"
 #ifdef ENABLE_DECRYPTION
 #include "librpbase/crypto/AesCipherFactory.hpp"
 #include "librpbase/crypto/IAesCipher.hpp"
@@ -40,7 +41,6 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 	, nonNcchContentType(NonNCCHContentType::Unknown)
 #ifdef ENABLE_DECRYPTION
 	, tid_be(0)
-	, cipher(nullptr)
 	, tmd_content_index(0)
 	, isDebug(false)
 #endif /* ENABLE_DECRYPTION */
@@ -49,6 +49,14 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 	memset(&ncch_header, 0, sizeof(ncch_header));
 	memset(&ncch_exheader, 0, sizeof(ncch_exheader));
 	memset(&exefs_header, 0, sizeof(exefs_header));
+#ifdef ENABLE_DECRYPTION
+	for (int i = 0; i < ARRAY_SIZE(cipher); i++) {
+		cipher[i] = nullptr;
+		cipher_state[i].section = 0;
+		cipher_state[i].ctr_base = 0;
+		cipher_state[i].pos = ~0U;
+	}
+#endif /* ENABLE_DECRYPTION */
 
 	// Read the NCCH header.
 	// We're including the signature, since the first 16 bytes
@@ -155,17 +163,17 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 	if (!(ncch_header.hdr.flags[N3DS_NCCH_FLAG_BIT_MASKS] & N3DS_NCCH_BIT_MASK_NoCrypto)) {
 		// Initialize the AES cipher.
 		// TODO: Check for errors.
-		cipher = AesCipherFactory::create();
-		cipher->setChainingMode(IAesCipher::ChainingMode::CTR);
+		cipher[0] = AesCipherFactory::create();
+		cipher[0]->setChainingMode(IAesCipher::ChainingMode::CTR);
 		u128_t ctr;
 
 		if (headers_loaded & HEADER_EXEFS) {
 			// Decrypt the ExeFS header.
 			// ExeFS header uses ncchKey0.
-			cipher->setKey(ncch_keys[0].u8, sizeof(ncch_keys[0].u8));
+			cipher[0]->setKey(ncch_keys[0].u8, sizeof(ncch_keys[0].u8));
 			ctr.init_ctr(tid_be, N3DS_NCCH_SECTION_EXEFS, 0);
-			cipher->setIV(ctr.u8, sizeof(ctr.u8));
-			cipher->decrypt(reinterpret_cast<uint8_t*>(&exefs_header), sizeof(exefs_header));
+			cipher[0]->setIV(ctr.u8, sizeof(ctr.u8));
+			cipher[0]->decrypt(reinterpret_cast<uint8_t*>(&exefs_header), sizeof(exefs_header));
 
 			// For CXI: First file should be ".code".
 			// For CFA: First file should be "icon".
@@ -180,8 +188,8 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 					// Zero out the keys.
 					memset(ncch_keys, 0, sizeof(ncch_keys));
 					q->m_lastError = EIO;
-					delete cipher;
-					cipher = nullptr;
+					delete cipher[0];
+					cipher[0] = nullptr;
 					closeFileOrDiscReader();
 					return;
 				}
@@ -196,8 +204,8 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 					// Zero out the keys.
 					memset(ncch_keys, 0, sizeof(ncch_keys));
 					q->m_lastError = EIO;
-					delete cipher;
-					cipher = nullptr;
+					delete cipher[0];
+					cipher[0] = nullptr;
 					closeFileOrDiscReader();
 					return;
 				}
@@ -207,27 +215,27 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 				if (size != sizeof(exefs_header)) {
 					// Read error.
 					// NOTE: readFromROM() sets q->m_lastError.
-					delete cipher;
-					cipher = nullptr;
+					delete cipher[0];
+					cipher[0] = nullptr;
 					closeFileOrDiscReader();
 					return;
 				}
 
 				// Decrypt the ExeFS header.
 				// ExeFS header uses ncchKey0.
-				cipher->setKey(ncch_keys[0].u8, sizeof(ncch_keys[0].u8));
+				cipher[0]->setKey(ncch_keys[0].u8, sizeof(ncch_keys[0].u8));
 				ctr.init_ctr(tid_be, N3DS_NCCH_SECTION_EXEFS, 0);
-				cipher->setIV(ctr.u8, sizeof(ctr.u8));
-				cipher->decrypt(reinterpret_cast<uint8_t*>(&exefs_header), sizeof(exefs_header));
+				cipher[0]->setIV(ctr.u8, sizeof(ctr.u8));
+				cipher[0]->decrypt(reinterpret_cast<uint8_t*>(&exefs_header), sizeof(exefs_header));
 
 				// Check the first filename, again.
 				if (strcmp(exefs_header.files[0].name, ".code") != 0 &&
 				    strcmp(exefs_header.files[0].name, "icon") != 0)
 				{
 					// Still not usable.
-					delete cipher;
+					delete cipher[0];
 					q->m_lastError = EIO;
-					cipher = nullptr;
+					cipher[0] = nullptr;
 					closeFileOrDiscReader();
 					return;
 				}
@@ -312,6 +320,15 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 				0, N3DS_NCCH_SECTION_ROMFS));
 		}
 
+		// If both keys are identical, e.g. for titles that don't
+		// use a secondary keyslot, use ncchKey0 for everything
+		// so cipher[1] isn't needed.
+		if (!memcmp(ncch_keys[0].u8, ncch_keys[1].u8, sizeof(ncch_keys[0].u8))) {
+			for (EncSection &encSection : encSections) {
+				encSection.keyIdx = 0;
+			}
+		}
+
 		// Sort encSections by NCCH-relative address.
 		// TODO: Check for overlap?
 		std::sort(encSections.begin(), encSections.end());
@@ -322,7 +339,8 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 NCCHReaderPrivate::~NCCHReaderPrivate()
 {
 #ifdef ENABLE_DECRYPTION
-	delete cipher;
+	delete cipher[0];
+	delete cipher[1];
 #endif /* ENABLE_DECRYPTION */
 }
 
@@ -540,6 +558,7 @@ NCCHReader::~NCCHReader()
  */
 size_t NCCHReader::read(void *ptr, size_t size)
 {
+	RP_TRACE_ZONE("NCCHReader::read");
 	RP_D(NCCHReader);
 	assert(ptr != nullptr);
 	assert(isOpen());
@@ -612,18 +631,38 @@ size_t NCCHReader::read(void *ptr, size_t size)
 		size_t ret_sz = d->readFromROM(d->pos, ptr8, sz_to_read);
 
 		if (section && section->section > N3DS_NCCH_SECTION_PLAIN) {
-			// Set the required key.
-			// TODO: Don't set the key if it hasn't changed.
-			d->cipher->setKey(d->ncch_keys[section->keyIdx].u8, sizeof(d->ncch_keys[section->keyIdx].u8));
+			// Get the cipher for this section's key.
+			// cipher[0] is initialized by the constructor.
+			const uint8_t keyIdx = section->keyIdx;
+			IAesCipher *cipher = d->cipher[keyIdx];
+			if (!cipher) {
+				// TODO: Check for errors.
+				cipher = AesCipherFactory::create();
+				cipher->setChainingMode(IAesCipher::ChainingMode::CTR);
+				cipher->setKey(d->ncch_keys[keyIdx].u8, sizeof(d->ncch_keys[keyIdx].u8));
+				d->cipher[keyIdx] = cipher;
+			}
+			NCCHReaderPrivate::CipherState &state = d->cipher_state[keyIdx];
 
-			// Initialize the counter based on section and offset.
-			u128_t ctr;
-			ctr.init_ctr(d->tid_be, section->section, d->pos - section->ctr_base);
-			d->cipher->setIV(ctr.u8, sizeof(ctr.u8));
+			// Initialize the counter based on section and offset,
+			// unless we're continuing from the previous read.
+			if (state.pos != d->pos ||
+			    state.section != section->section ||
+			    state.ctr_base != section->ctr_base)
+			{
+				u128_t ctr;
+				ctr.init_ctr(d->tid_be, section->section, d->pos - section->ctr_base);
+				cipher->setIV(ctr.u8, sizeof(ctr.u8));
+				state.section = section->section;
+				state.ctr_base = section->ctr_base;
+			}
 
 			// Decrypt the data.
 			// FIXME: Round up to 16 if a short read occurred?
-			ret_sz = d->cipher->decrypt(static_cast<uint8_t*>(ptr), ret_sz);
+			ret_sz = cipher->decrypt(ptr8, ret_sz);
+			state.pos = (ret_sz > 0 && ret_sz % 16 == 0
+				? d->pos + static_cast<uint32_t>(ret_sz)
+				: ~0U);
 		}
 
 		d->pos += static_cast<uint32_t>(ret_sz);
@@ -919,13 +958,11 @@ bool NCCHReader::isDebug(void) const
  */
 const char *NCCHReader::contentType(void) const
 {
-	const char *content_type;
-
-	const N3DS_NCCH_Header_NoSig_t *ncch_header = ncchHeader();
-	if (!ncch_header) {
+	RP_D(const NCCHReader);
+	if (!ncchHeader()) {
 		// NCCH header is not loaded.
 		// Check if this is another content type.
-		RP_D(const NCCHReader);
+		const char *content_type;
 		switch (d->nonNcchContentType) {
 			case NCCHReaderPrivate::NonNCCHContentType::NDHT:
 				// NDHT (DS Whitelist)
@@ -942,7 +979,37 @@ const char *NCCHReader::contentType(void) const
 		return content_type;
 	}
 
-	const uint8_t ctype_flag = ncch_header->flags[N3DS_NCCH_FLAG_CONTENT_TYPE];
+	return contentType_static(&d->ncch_header);
+}
+
+/**
+ * Get the content type as a string.
+ * Non-NCCH contents (NDHT, NARC) are also detected.
+ * @param pNcchHeader	[in] NCCH header, including the signature.
+ * @return Content type, or nullptr on error.
+ */
+const char *NCCHReader::contentType_static(const N3DS_NCCH_Header_t *pNcchHeader)
+{
+	assert(pNcchHeader != nullptr);
+	if (!pNcchHeader)
+		return nullptr;
+
+	if (pNcchHeader->hdr.magic != cpu_to_be32(N3DS_NCCH_HEADER_MAGIC)) {
+		// Not an NCCH. Check for non-NCCH types.
+		if (pNcchHeader->hdr.magic == cpu_to_be32('NDHT')) {
+			// NDHT (DS Whitelist)
+			return "NDHT";
+		}
+		const uint32_t magic_narc = reinterpret_cast<const uint32_t*>(pNcchHeader)[0x80/4];
+		if (magic_narc == cpu_to_be32('NARC')) {
+			// NARC (TWL Version Data)
+			return "NARC";
+		}
+		return nullptr;
+	}
+
+	const char *content_type;
+	const uint8_t ctype_flag = pNcchHeader->hdr.flags[N3DS_NCCH_FLAG_CONTENT_TYPE];
 	if ((ctype_flag & N3DS_NCCH_CONTENT_TYPE_Child) == N3DS_NCCH_CONTENT_TYPE_Child) {
 		// DLP child
 		content_type = "Download Play";
@@ -175,6 +175,14 @@ class NCCHReader : public LibRpBase::IPartition
 		bool isDebug(void) const;
 #endif /* ENABLE_DECRYPTION */
 
+		/**
+		 * Get the content type as a string.
+		 * Non-NCCH contents (NDHT, NARC) are also detected.
+		 * @param pNcchHeader	[in] NCCH header, including the signature.
+		 * @return Content type, or nullptr on error.
+		 */
+		static const char *contentType_static(const N3DS_NCCH_Header_t *pNcchHeader);
+
 		/**
 		 * Get the content type as a string.
 		 * @return Content type, or nullptr on error.
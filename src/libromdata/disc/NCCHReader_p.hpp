@@ -119,8 +119,22 @@ class NCCHReaderPrivate
 		// Encryption keys.
 		u128_t ncch_keys[2];
 
-		// NCCH cipher.
-		LibRpBase::IAesCipher *cipher;
+		// NCCH ciphers, indexed by ncch_keys[] index.
+		// Each cipher's key is only set once, so switching between
+		// sections that use different keys doesn't require another
+		// AES key expansion. cipher[1] is created on first use.
+		LibRpBase::IAesCipher *cipher[2];
+
+		// Current NCCH cipher state.
+		// setIV() is skipped if the cipher already has the
+		// correct counter, e.g. for sequential reads.
+		// NOTE: decrypt() automatically advances the counter.
+		struct CipherState {
+			uint8_t section;	// N3DS_NCCH_Sections
+			uint32_t ctr_base;	// Counter base address
+			uint32_t pos;		// Address for the current counter (~0U if not set)
+		};
+		CipherState cipher_state[2];
 
 		// Encrypted section addresses.
 		struct EncSection {
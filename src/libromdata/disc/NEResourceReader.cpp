@@ -8,6 +8,7 @@
 
 #include "stdafx.h"
 #include "NEResourceReader.hpp"
+#include "librpfile/RpMemFile.hpp"
 
 // librpbase, librpfile
 using namespace LibRpBase;
@@ -43,10 +44,19 @@ class NEResourceReaderPrivate
 			uint32_t addr;	// Address of the resource data. (0 = start of EXE)
 			uint32_t len;	// Length of the resource data.
 		};
-		typedef ao::uvector<ResTblEntry> rsrc_dir_t;
 
-		// Resource types.
-		unordered_map<uint16_t, rsrc_dir_t> res_types;
+		// All resources, in resource table order.
+		ao::uvector<ResTblEntry> res_tbl;
+
+		// Resource type index.
+		// Key: Resource type
+		// Value: Index of the type's first resource in res_tbl.
+		unordered_map<uint16_t, unsigned int> res_types;
+
+		// Resource index.
+		// Key: LOWORD == id, HIWORD == type
+		// Value: Index of the resource in res_tbl.
+		unordered_map<uint32_t, unsigned int> res_index;
 
 		/**
 		 * Load the resource table.
@@ -54,6 +64,14 @@ class NEResourceReaderPrivate
 		 */
 		int loadResTbl(void);
 
+		/**
+		 * Find a resource in the resource index.
+		 * @param type Resource type ID. (high bit set)
+		 * @param id Resource ID. (high bit set; -1 for "first entry")
+		 * @return Resource table entry, or nullptr if not found.
+		 */
+		const ResTblEntry *findResource(uint16_t type, int id) const;
+
 		/**
 		 * Read the section header in an NE version resource.
 		 *
@@ -179,8 +197,12 @@ int NEResourceReaderPrivate::loadResTbl(void)
 	}
 	unsigned int pos = 2;
 
-	// Initialize the resource types list.
+	// Initialize the resource index.
+	// NOTE: The entire table was loaded above, so the
+	// indexes are built here without any further I/O.
+	res_tbl.clear();
 	res_types.clear();
+	res_index.clear();
 
 	// TODO: Overflow prevention.
 	// TODO: Use pointers for pos and endpos?
@@ -218,19 +240,11 @@ int NEResourceReaderPrivate::loadResTbl(void)
 			break;
 		}
 
-		// Create a new vector for the resource type.
-		auto iter_type = res_types.insert(std::make_pair(rtTypeID, rsrc_dir_t()));
-		assert(iter_type.second);
-		if (!iter_type.second) {
-			// Error adding to the map.
-			ret = -ENOMEM;
-			break;
-		}
-		rsrc_dir_t &dir = iter_type.first->second;
 		const unsigned int resCount = le16_to_cpu(typeInfo->rtResourceCount);
-		dir.resize(resCount);
-		unsigned int entriesRead = 0;
+		res_tbl.reserve(res_tbl.size() + resCount);
+		res_index.reserve(res_index.size() + resCount);
 		bool isErr = false;
+		bool isFirst = true;
 		for (unsigned int i = 0; i < resCount; i++) {
 			// Read a NAMEINFO struct.
 			if ((pos + sizeof(NE_NAMEINFO)) >= rsrc_tbl_size) {
@@ -248,25 +262,57 @@ int NEResourceReaderPrivate::loadResTbl(void)
 			}
 
 			// Add the resource information.
-			auto &entry = dir[entriesRead];
+			const unsigned int idx = static_cast<unsigned int>(res_tbl.size());
+			ResTblEntry entry;
 			entry.id = rnID;
 			// NOTE: Wine shifts both addr and len; all documentation
 			// I can find says only addr is shifted, but then the len
 			// value is too small...
 			entry.addr = le32_to_cpu(nameInfo->rnOffset) << rscAlignShift;
 			entry.len = le16_to_cpu(nameInfo->rnLength) << rscAlignShift;
-			entriesRead++;
+			res_tbl.push_back(entry);
+
+			// Index the resource.
+			// NOTE: If an ID is duplicated, the first one is used.
+			res_index.emplace((static_cast<uint32_t>(rtTypeID) << 16) | rnID, idx);
+			if (isFirst) {
+				res_types.emplace(rtTypeID, idx);
+				isFirst = false;
+			}
 		}
 		if (isErr)
 			break;
-
-		// Shrink the vector in case we skipped some entries.
-		dir.resize(entriesRead);
 	}
 
 	return ret;
 }
 
+/**
+ * Find a resource in the resource index.
+ * @param type Resource type ID. (high bit set)
+ * @param id Resource ID. (high bit set; -1 for "first entry")
+ * @return Resource table entry, or nullptr if not found.
+ */
+const NEResourceReaderPrivate::ResTblEntry *NEResourceReaderPrivate::findResource(uint16_t type, int id) const
+{
+	unsigned int idx;
+	if (id == -1) {
+		// Get the first ID for this type.
+		auto iter = res_types.find(type);
+		if (iter == res_types.end())
+			return nullptr;
+		idx = iter->second;
+	} else {
+		auto iter = res_index.find((static_cast<uint32_t>(type) << 16) | static_cast<uint16_t>(id));
+		if (iter == res_index.end())
+			return nullptr;
+		idx = iter->second;
+	}
+
+	assert(idx < res_tbl.size());
+	return &res_tbl[idx];
+}
+
 /**
  * Read the section header in an NE version resource.
  *
@@ -639,32 +685,11 @@ IRpFile *NEResourceReader::open(uint16_t type, int id, int lang)
 	type |= 0x8000;
 	id |= 0x8000;
 
-	// Get the directory for the specified type.
-	auto iter_dir = d->res_types.find(type);
-	if (iter_dir == d->res_types.end())
-		return nullptr;
-	auto &dir = iter_dir->second;
-	if (dir.empty())
+	// Find the resource.
+	const NEResourceReaderPrivate::ResTblEntry *const entry = d->findResource(type, id);
+	if (!entry) {
+		// Not found.
 		return nullptr;
-	
-	const NEResourceReaderPrivate::ResTblEntry *entry = nullptr;
-	if (id == -1) {
-		// Get the first ID for this type.
-		entry = &dir[0];
-	} else {
-		// Search for the ID.
-		// TODO: unordered_map?
-		auto iter = std::find_if(dir.cbegin(), dir.cend(),
-			[id](const NEResourceReaderPrivate::ResTblEntry &entry) -> bool {
-				return (entry.id == static_cast<uint16_t>(id));
-			}
-		);
-		if (iter != dir.cend()) {
-			entry = &(*iter);
-		} else {
-			// ID not found.
-			return nullptr;
-		}
 	}
 
 	// Create the PartitionFile.
@@ -693,13 +718,31 @@ int NEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 		return -EINVAL;
 	}
 
-	// Open the VS_VERSION_INFO resource.
-	unique_RefBase<IRpFile> f_ver(this->open(RT_VERSION, id, lang));
-	if (!f_ver) {
+	// Find the VS_VERSION_INFO resource.
+	// NOTE: The language ID is not used in NE resources.
+	RP_UNUSED(lang);
+	RP_D(NEResourceReader);
+	const NEResourceReaderPrivate::ResTblEntry *const entry =
+		d->findResource(RT_VERSION | 0x8000, id | 0x8000);
+	if (!entry) {
 		// Not found.
 		return -ENOENT;
 	}
 
+	// Load the entire resource with a single read.
+	// NOTE: wLength is 16-bit, so VS_VERSION_INFO can't be larger than 64 KB.
+	const uint32_t ver_size = std::min(entry->len, 65536U);
+	if (ver_size == 0) {
+		return -EIO;
+	}
+	unique_ptr<uint8_t[]> ver_buf(new uint8_t[ver_size]);
+	size_t size = m_file->seekAndRead(entry->addr, ver_buf.get(), ver_size);
+	if (size != ver_size) {
+		// Seek and/or read error.
+		return -EIO;
+	}
+	unique_RefBase<IRpFile> f_ver(new RpMemFile(ver_buf.get(), ver_size));
+
 	// Read the version header.
 	static const char vsvi[] = "VS_VERSION_INFO";
 	uint16_t len, valueLen;
@@ -717,7 +760,7 @@ int NEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 	}
 
 	// Read the version information.
-	size_t size = f_ver->read(pVsFfi, sizeof(*pVsFfi));
+	size = f_ver->read(pVsFfi, sizeof(*pVsFfi));
 	if (size != sizeof(*pVsFfi)) {
 		// Read error.
 		return -EIO;
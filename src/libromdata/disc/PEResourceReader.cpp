@@ -10,13 +10,13 @@
 #include "PEResourceReader.hpp"
 
 // librpbase, librpfile
+#include "librpfile/RpMemFile.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
-using std::unordered_map;
 using std::vector;
 
 // Uninitialized vector class.
@@ -45,54 +45,40 @@ class PEResourceReaderPrivate
 		// Read position.
 		off64_t pos;
 
-		// Resource directory entry.
-		struct ResDirEntry {
-			uint16_t id;	// Resource ID.
-			uint32_t addr;	// Address of the IMAGE_RESOURCE_DIRECTORY or
-					// IMAGE_RESOURCE_DATA_ENTRY, relative to rsrc_addr.
-					// NOTE: If the high bit is set, this is a subdirectory.
+		// Resource index entry.
+		// The entire resource tree is flattened into a single table
+		// that's sorted by type, ID, and language.
+		struct ResEntry {
+			uint16_t type;		// Resource type.
+			uint16_t id;		// Resource ID.
+			uint16_t lang;		// Language ID.
+			uint32_t data_addr;	// Address of the resource data, relative to rsrc_addr.
+			uint32_t size;		// Size of the resource data.
 		};
-		typedef ao::uvector<ResDirEntry> rsrc_dir_t;
-
-		// Resource types. (Top-level directory.)
-		rsrc_dir_t res_types;
-
-		// Cached top-level directories. (type)
-		// Key: type
-		// Value: Resources contained within the directory.
-		unordered_map<uint16_t, rsrc_dir_t> type_dirs;
-
-		// Cached second-level directories. (type and ID)
-		// Key: LOWORD == type, HIWORD == id
-		// Value: Resources contained within the directory.
-		unordered_map<uint32_t, rsrc_dir_t> type_and_id_dirs;
+		ao::uvector<ResEntry> res_index;
 
 		/**
-		 * Load a resource directory.
+		 * Load the resource index.
+		 *
+		 * The resource directories and data entries are read from
+		 * the beginning of .rsrc in as few reads as possible,
+		 * usually one. Resource data is not read here.
 		 *
 		 * NOTE: Only numeric resources and/or subdirectories are loaded.
 		 * Named resources and/or subdirectores are ignored.
 		 *
-		 * @param addr	[in] Starting address of the directory. (relative to the start of .rsrc)
-		 * @param dir	[out] Resource directory.
-		 * @return Number of entries loaded, or negative POSIX error code on error.
+		 * @return Number of resources loaded, or negative POSIX error code on error.
 		 */
-		int loadResDir(uint32_t addr, rsrc_dir_t &dir);
+		int loadResIndex(void);
 
 		/**
-		 * Get the resource directory for the specified type.
-		 * @param type Resource type.
-		 * @return Resource directory, or nullptr if not found.
+		 * Find a resource in the resource index.
+		 * @param type Resource type ID.
+		 * @param id Resource ID. (-1 for "first entry")
+		 * @param lang Language ID. (-1 for "first entry")
+		 * @return Resource index entry, or nullptr if not found.
 		 */
-		const rsrc_dir_t *getTypeDir(uint16_t type);
-
-		/**
-		 * Get the resource directory for the specified type and ID.
-		 * @param type Resource type.
-		 * @param id Resource ID.
-		 * @return Resource directory, or nullptr if not found.
-		 */
-		const rsrc_dir_t *getTypeIdDir(uint16_t type, uint16_t id);
+		const ResEntry *findResource(uint16_t type, int id, int lang) const;
 
 		/**
 		 * Read the section header in a PE version resource.
@@ -161,8 +147,8 @@ PEResourceReaderPrivate::PEResourceReaderPrivate(
 		return;
 	}
 
-	// Load the root resource directory.
-	int ret = loadResDir(0, res_types);
+	// Load the resource index.
+	int ret = loadResIndex();
 	if (ret <= 0) {
 		// No resources, or an error occurred.
 		UNREF_AND_NULL_NOCHK(q->m_file);
@@ -170,170 +156,211 @@ PEResourceReaderPrivate::PEResourceReaderPrivate(
 }
 
 /**
- * Load a resource directory.
+ * Load the resource index.
+ *
+ * The resource directories and data entries are read from
+ * the beginning of .rsrc in as few reads as possible,
+ * usually one. Resource data is not read here.
  *
  * NOTE: Only numeric resources and/or subdirectories are loaded.
  * Named resources and/or subdirectores are ignored.
  *
- * @param addr	[in] Starting address of the directory. (relative to the start of .rsrc)
- * @param dir	[out] Resource directory.
- * @return Number of entries loaded, or negative POSIX error code on error.
+ * @return Number of resources loaded, or negative POSIX error code on error.
  */
-int PEResourceReaderPrivate::loadResDir(uint32_t addr, rsrc_dir_t &dir)
+int PEResourceReaderPrivate::loadResIndex(void)
 {
 	RP_Q(PEResourceReader);
 
-	IMAGE_RESOURCE_DIRECTORY root;
-	size_t size = q->m_file->seekAndRead(rsrc_addr + addr, &root, sizeof(root));
-	if (size != sizeof(root)) {
-		// Seek and/or read error.
-		q->m_lastError = q->m_file->lastError();
-		return q->m_lastError;
-	}
-
-	// Total number of entries.
-	unsigned int entryCount = le16_to_cpu(root.NumberOfNamedEntries) + le16_to_cpu(root.NumberOfIdEntries);
-	assert(entryCount <= 64);
-	if (entryCount > 64) {
-		// Sanity check; constrain to 64 entries.
-		entryCount = 64;
-	}
-	uint32_t szToRead = static_cast<uint32_t>(entryCount * sizeof(IMAGE_RESOURCE_DIRECTORY_ENTRY));
-	unique_ptr<IMAGE_RESOURCE_DIRECTORY_ENTRY[]> irdEntries(new IMAGE_RESOURCE_DIRECTORY_ENTRY[entryCount]);
-	size = q->m_file->read(irdEntries.get(), szToRead);
-	if (size != szToRead) {
-		// Read error.
-		q->m_lastError = q->m_file->lastError();
-		return q->m_lastError;
-	}
-
-	// Read each directory header.
-	dir.resize(entryCount);
-	const IMAGE_RESOURCE_DIRECTORY_ENTRY *irdEntry = irdEntries.get();
-	unsigned int entriesRead = 0;
-	for (unsigned int i = 0; i < entryCount; i++, irdEntry++) {
-		// Skipping any root directory entry that isn't an ID.
-		uint32_t id = le32_to_cpu(irdEntry->Name);
-		if (id > 0xFFFF) {
-			// Not an ID.
-			continue;
+	// The resource directories and data entries are normally
+	// stored at the start of .rsrc, followed by the name strings
+	// and the resource data. Read the first 64 KB, and extend the
+	// buffer if anything is referenced past the end of it.
+	static const uint32_t DIR_BUF_SIZE_INIT = 64*1024;
+	static const uint32_t DIR_BUF_SIZE_MAX = 16*1024*1024;
+	ao::uvector<uint8_t> dirbuf;
+
+	// Make sure the specified range is loaded.
+	// Returns 0 on success; negative POSIX error code on error.
+	auto ensureLoaded = [q, this, &dirbuf](uint32_t addr, uint32_t size) -> int {
+		if (addr > rsrc_size || size > rsrc_size - addr) {
+			// Out of range.
+			return -EIO;
+		}
+		const uint32_t end = addr + size;
+		const uint32_t cur_size = static_cast<uint32_t>(dirbuf.size());
+		if (end <= cur_size) {
+			// Already loaded.
+			return 0;
 		}
 
-		// Entry data.
-		auto &entry = dir[entriesRead];
-		entry.id = static_cast<uint16_t>(id);
-		// addr points to IMAGE_RESOURCE_DIRECTORY
-		// or IMAGE_RESOURCE_DATA_ENTRY.
-		entry.addr = le32_to_cpu(irdEntry->OffsetToData);
-
-		// Next entry.
-		entriesRead++;
-	}
-
-	// Shrink the vector in case we skipped some types.
-	dir.resize(entriesRead);
-	return (int)entriesRead;
-}
-
-/**
- * Get the resource directory for the specified type.
- * @param type Resource type.
- * @return Resource directory, or nullptr if not found.
- */
-const PEResourceReaderPrivate::rsrc_dir_t *PEResourceReaderPrivate::getTypeDir(uint16_t type)
-{
-	// Check if the type is already cached.
-	auto iter_td = type_dirs.find(type);
-	if (iter_td != type_dirs.end()) {
-		// Type is already cached.
-		return &(iter_td->second);
-	}
+		uint32_t new_size = std::max(end, std::max(cur_size * 2, DIR_BUF_SIZE_INIT));
+		new_size = std::min(new_size, rsrc_size);
+		if (new_size > DIR_BUF_SIZE_MAX) {
+			// Too much directory data.
+			if (end > DIR_BUF_SIZE_MAX) {
+				return -ENOMEM;
+			}
+			new_size = DIR_BUF_SIZE_MAX;
+		}
 
-	// Not cached. Find the type in the root directory.
-	auto iter = std::find_if(res_types.cbegin(), res_types.cend(),
-		[type](const ResDirEntry &entry) -> bool {
-			return (entry.id == type);
+		dirbuf.resize(new_size);
+		const size_t sz_read = new_size - cur_size;
+		size_t sz = q->m_file->seekAndRead(rsrc_addr + cur_size, &dirbuf[cur_size], sz_read);
+		if (sz != sz_read) {
+			// Seek and/or read error.
+			dirbuf.resize(cur_size);
+			int err = q->m_file->lastError();
+			if (err == 0) {
+				err = EIO;
+			}
+			return -err;
 		}
-	);
-
-	uint32_t type_addr = 0;
-	if (iter != res_types.cend()) {
-		// Make sure this type is a subdirectory.
-		if (iter->addr & 0x80000000) {
-			// This is a subdirectory.
-			type_addr = (iter->addr & ~0x80000000);
+		return 0;
+	};
+
+	// Get a resource directory's ID entries.
+	// Returns the number of entries, or negative POSIX error code on error.
+	auto loadDir = [&dirbuf, &ensureLoaded](uint32_t addr, const IMAGE_RESOURCE_DIRECTORY_ENTRY **ppEntries) -> int {
+		int ret = ensureLoaded(addr, sizeof(IMAGE_RESOURCE_DIRECTORY));
+		if (ret != 0) {
+			return ret;
+		}
+		const IMAGE_RESOURCE_DIRECTORY *const dir =
+			reinterpret_cast<const IMAGE_RESOURCE_DIRECTORY*>(&dirbuf[addr]);
+		const unsigned int entryCount =
+			le16_to_cpu(dir->NumberOfNamedEntries) + le16_to_cpu(dir->NumberOfIdEntries);
+		addr += sizeof(IMAGE_RESOURCE_DIRECTORY);
+		ret = ensureLoaded(addr, entryCount * sizeof(IMAGE_RESOURCE_DIRECTORY_ENTRY));
+		if (ret != 0) {
+			return ret;
 		}
+		// NOTE: dirbuf may have been reallocated by ensureLoaded().
+		*ppEntries = reinterpret_cast<const IMAGE_RESOURCE_DIRECTORY_ENTRY*>(&dirbuf[addr]);
+		return static_cast<int>(entryCount);
+	};
+
+	// Sanity check: Maximum of 65,536 resources.
+	static const size_t RES_COUNT_MAX = 65536;
+	res_index.clear();
+
+	// Root directory: Types.
+	// NOTE: Entry pointers are invalidated if dirbuf is reallocated,
+	// so the entries are copied before loading subdirectories.
+	const IMAGE_RESOURCE_DIRECTORY_ENTRY *pEntries;
+	int ret = loadDir(0, &pEntries);
+	if (ret < 0) {
+		q->m_lastError = ret;
+		return ret;
 	}
+	const vector<IMAGE_RESOURCE_DIRECTORY_ENTRY> typeEntries(pEntries, pEntries + ret);
 
-	if (type_addr == 0) {
-		// Not found.
-		return nullptr;
-	}
+	for (const IMAGE_RESOURCE_DIRECTORY_ENTRY &typeEntry : typeEntries) {
+		// Skip named entries and data entries.
+		const uint32_t type = le32_to_cpu(typeEntry.Name);
+		const uint32_t type_addr = le32_to_cpu(typeEntry.OffsetToData);
+		if (type > 0xFFFF || !(type_addr & 0x80000000))
+			continue;
 
-	// Load the directory.
-	auto iter_type = type_dirs.insert(std::make_pair(type, rsrc_dir_t()));
-	if (!iter_type.second) {
-		// Error adding to the map.
-		return nullptr;
+		// Type directory: IDs.
+		ret = loadDir(type_addr & ~0x80000000, &pEntries);
+		if (ret <= 0)
+			continue;
+		const vector<IMAGE_RESOURCE_DIRECTORY_ENTRY> idEntries(pEntries, pEntries + ret);
+
+		for (const IMAGE_RESOURCE_DIRECTORY_ENTRY &idEntry : idEntries) {
+			// Skip named entries and data entries.
+			const uint32_t id = le32_to_cpu(idEntry.Name);
+			const uint32_t id_addr = le32_to_cpu(idEntry.OffsetToData);
+			if (id > 0xFFFF || !(id_addr & 0x80000000))
+				continue;
+
+			// ID directory: Languages.
+			ret = loadDir(id_addr & ~0x80000000, &pEntries);
+			if (ret <= 0)
+				continue;
+			const vector<IMAGE_RESOURCE_DIRECTORY_ENTRY> langEntries(pEntries, pEntries + ret);
+
+			for (const IMAGE_RESOURCE_DIRECTORY_ENTRY &langEntry : langEntries) {
+				// Skip named entries and subdirectories.
+				const uint32_t lang = le32_to_cpu(langEntry.Name);
+				const uint32_t data_entry_addr = le32_to_cpu(langEntry.OffsetToData);
+				if (lang > 0xFFFF || (data_entry_addr & 0x80000000))
+					continue;
+
+				// Get the IMAGE_RESOURCE_DATA_ENTRY.
+				if (ensureLoaded(data_entry_addr, sizeof(IMAGE_RESOURCE_DATA_ENTRY)) != 0)
+					continue;
+				const IMAGE_RESOURCE_DATA_ENTRY *const irdata =
+					reinterpret_cast<const IMAGE_RESOURCE_DATA_ENTRY*>(&dirbuf[data_entry_addr]);
+
+				// NOTE: OffsetToData is an RVA, not relative to the physical address.
+				// NOTE: Address 0 in IDiscReader equals rsrc_addr.
+				ResEntry entry;
+				entry.type = static_cast<uint16_t>(type);
+				entry.id = static_cast<uint16_t>(id);
+				entry.lang = static_cast<uint16_t>(lang);
+				entry.data_addr = le32_to_cpu(irdata->OffsetToData) - rsrc_va;
+				entry.size = le32_to_cpu(irdata->Size);
+				res_index.push_back(entry);
+				if (res_index.size() >= RES_COUNT_MAX)
+					goto done;
+			}
+		}
 	}
-	rsrc_dir_t *type_dir = &(iter_type.first->second);
-	loadResDir(type_addr, *type_dir);
-	return type_dir;
+
+done:
+	// Sort the index by type, ID, and language.
+	// NOTE: The PE format requires directory entries to be sorted
+	// in ascending order, so "first entry" lookups are unchanged.
+	std::sort(res_index.begin(), res_index.end(),
+		[](const ResEntry &a, const ResEntry &b) noexcept -> bool {
+			if (a.type != b.type) return (a.type < b.type);
+			if (a.id != b.id) return (a.id < b.id);
+			return (a.lang < b.lang);
+		});
+	return static_cast<int>(res_index.size());
 }
 
 /**
- * Get the resource directory for the specified type and ID.
- * @param type Resource type.
- * @param id Resource ID.
- * @return Resource directory, or nullptr if not found.
+ * Find a resource in the resource index.
+ * @param type Resource type ID.
+ * @param id Resource ID. (-1 for "first entry")
+ * @param lang Language ID. (-1 for "first entry")
+ * @return Resource index entry, or nullptr if not found.
  */
-const PEResourceReaderPrivate::rsrc_dir_t *PEResourceReaderPrivate::getTypeIdDir(uint16_t type, uint16_t id)
+const PEResourceReaderPrivate::ResEntry *PEResourceReaderPrivate::findResource(uint16_t type, int id, int lang) const
 {
-	// Check if the type and ID is already cached.
-	uint32_t type_and_id = (type | (static_cast<uint32_t>(id) << 16));
-	auto iter_td = type_and_id_dirs.find(type_and_id);
-	if (iter_td != type_and_id_dirs.end()) {
-		// Type and ID is already cached.
-		return &(iter_td->second);
-	}
-
-	// Not cached. Find the type in the root directory.
-	const rsrc_dir_t *type_dir = getTypeDir(type);
-	if (!type_dir) {
-		// Type not found.
-		return nullptr;
-	}
+	auto lower = [this](uint16_t type, uint16_t id, uint16_t lang) {
+		return std::lower_bound(res_index.cbegin(), res_index.cend(), 0,
+			[type, id, lang](const ResEntry &entry, int) noexcept -> bool {
+				if (entry.type != type) return (entry.type < type);
+				if (entry.id != id) return (entry.id < id);
+				return (entry.lang < lang);
+			});
+	};
 
-	// Find the ID in the type directory.
-	auto iter = std::find_if(type_dir->cbegin(), type_dir->cend(),
-		[id](const ResDirEntry &entry) -> bool {
-			return (entry.id == id);
-		}
-	);
-
-	uint32_t id_addr = 0;
-	if (iter != type_dir->cend()) {
-		// Make sure this ID is a subdirectory.
-		if (iter->addr & 0x80000000) {
-			// This is a subdirectory.
-			id_addr = (iter->addr & ~0x80000000);
+	if (id == -1) {
+		// Get the first ID for this type.
+		auto iter = lower(type, 0, 0);
+		if (iter == res_index.cend() || iter->type != type) {
+			// Not found.
+			return nullptr;
 		}
+		id = iter->id;
 	}
 
-	if (id_addr == 0) {
+	// Find the specified language ID, or the first language
+	// for this type and ID if lang == -1.
+	auto iter = lower(type, static_cast<uint16_t>(id),
+		(lang == -1 ? 0 : static_cast<uint16_t>(lang)));
+	if (iter == res_index.cend() || iter->type != type ||
+	    iter->id != static_cast<uint16_t>(id) ||
+	    (lang != -1 && iter->lang != static_cast<uint16_t>(lang)))
+	{
 		// Not found.
 		return nullptr;
 	}
-
-	// Load the directory.
-	auto iter_type_and_id = type_and_id_dirs.insert(std::make_pair(type_and_id, rsrc_dir_t()));
-	if (!iter_type_and_id.second) {
-		// Error adding to the map.
-		return nullptr;
-	}
-	rsrc_dir_t *id_dir = &(iter_type_and_id.first->second);
-	loadResDir(id_addr, *id_dir);
-	return id_dir;
+	return &(*iter);
 }
 
 /**
@@ -696,70 +723,20 @@ off64_t PEResourceReader::partition_size_used(void) const
  */
 IRpFile *PEResourceReader::open(uint16_t type, int id, int lang)
 {
-	// Check if the directory has been cached.
+	// Find the resource in the resource index.
 	RP_D(PEResourceReader);
-
-	if (id == -1) {
-		// Get the first ID for this type.
-		const PEResourceReaderPrivate::rsrc_dir_t *type_dir = d->getTypeDir(type);
-		if (!type_dir || type_dir->empty())
-			return nullptr;
-		id = type_dir->at(0).id;
-	}
-
-	// Get the directory for the type and ID.
-	const PEResourceReaderPrivate::rsrc_dir_t *type_id_dir =
-		d->getTypeIdDir(type, static_cast<uint16_t>(id));
-	if (!type_id_dir || type_id_dir->empty())
-		return nullptr;
-
-	const PEResourceReaderPrivate::ResDirEntry *dirEntry = nullptr;
-	if (lang == -1) {
-		// Get the first language for this type.
-		dirEntry = &type_id_dir->at(0);
-	} else {
-		// Find the specified language ID.
-		auto iter = std::find_if(type_id_dir->cbegin(), type_id_dir->cend(),
-			[lang](const PEResourceReaderPrivate::ResDirEntry &entry) -> bool {
-				return (entry.id == static_cast<uint16_t>(lang));
-			}
-		);
-
-		if (iter == type_id_dir->cend()) {
-			// Not found.
-			return nullptr;
-		}
-
-		// Found the language ID.
-		dirEntry = &(*iter);
-	}
-
-	// Make sure this is a file.
-	assert(!(dirEntry->addr & 0x80000000));
-	if (dirEntry->addr & 0x80000000) {
-		// This is a subdirectory.
-		return nullptr;
-	}
-
-	// Get the IMAGE_RESOURCE_DATA_ENTRY.
-	IMAGE_RESOURCE_DATA_ENTRY irdata;
-	size_t size = m_file->seekAndRead(d->rsrc_addr + dirEntry->addr, &irdata, sizeof(irdata));
-	if (size != sizeof(irdata)) {
-		// Seek and/or read error.
-		m_lastError = m_file->lastError();
+	const PEResourceReaderPrivate::ResEntry *const entry = d->findResource(type, id, lang);
+	if (!entry) {
+		// Not found.
 		return nullptr;
 	}
 
-	// NOTE: OffsetToData is an RVA, not relative to the physical address.
-	// NOTE: Address 0 in IDiscReader equals rsrc_addr.
-	const uint32_t data_addr = le32_to_cpu(irdata.OffsetToData) - d->rsrc_va;
-
 	// Create the PartitionFile.
 	// This is an IRpFile implementation that uses an
 	// IPartition as the reader and takes an offset
 	// and size as the file parameters.
 	// TODO: Set the codepage somewhere?
-	return new PartitionFile(this, data_addr, le32_to_cpu(irdata.Size));
+	return new PartitionFile(this, entry->data_addr, entry->size);
 }
 
 /**
@@ -780,13 +757,28 @@ int PEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 		return -EINVAL;
 	}
 
-	// Open the VS_VERSION_INFO resource.
-	unique_RefBase<IRpFile> f_ver(this->open(RT_VERSION, id, lang));
-	if (!f_ver) {
+	// Find the VS_VERSION_INFO resource.
+	RP_D(PEResourceReader);
+	const PEResourceReaderPrivate::ResEntry *const entry = d->findResource(RT_VERSION, id, lang);
+	if (!entry) {
 		// Not found.
 		return -ENOENT;
 	}
 
+	// Load the entire resource with a single read.
+	// NOTE: wLength is 16-bit, so VS_VERSION_INFO can't be larger than 64 KB.
+	const uint32_t ver_size = std::min(entry->size, 65536U);
+	if (ver_size == 0) {
+		return -EIO;
+	}
+	unique_ptr<uint8_t[]> ver_buf(new uint8_t[ver_size]);
+	size_t size = seekAndRead(entry->data_addr, ver_buf.get(), ver_size);
+	if (size != ver_size) {
+		// Seek and/or read error.
+		return -EIO;
+	}
+	unique_RefBase<IRpFile> f_ver(new RpMemFile(ver_buf.get(), ver_size));
+
 	// Read the version header.
 	static const char16_t vsvi[] = {'V','S','_','V','E','R','S','I','O','N','_','I','N','F','O',0};
 	uint16_t len, valueLen;
@@ -804,7 +796,7 @@ int PEResourceReader::load_VS_VERSION_INFO(int id, int lang, VS_FIXEDFILEINFO *p
 	}
 
 	// Read the version information.
-	size_t size = f_ver->read(pVsFfi, sizeof(*pVsFfi));
+	size = f_ver->read(pVsFfi, sizeof(*pVsFfi));
 	if (size != sizeof(*pVsFfi)) {
 		// Read error.
 		return -EIO;
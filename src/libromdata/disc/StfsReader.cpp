@@ -0,0 +1,283 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * StfsReader.cpp: Microsoft Xbox 360 STFS file reader.                    *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "StfsReader.hpp"
+#include "../Console/xbox360_stfs_structs.h"
+
+// librpbase, librpfile
+using namespace LibRpBase;
+using LibRpFile::IRpFile;
+
+// C++ STL classes.
+using std::vector;
+
+namespace LibRomData {
+
+class StfsReaderPrivate
+{
+	public:
+		StfsReaderPrivate(StfsReader *q, const vector<StfsReader::BlockRun> &runs, off64_t length);
+
+	private:
+		RP_DISABLE_COPY(StfsReaderPrivate)
+	protected:
+		StfsReader *const q_ptr;
+
+	public:
+		// Block run, with the logical starting block.
+		struct Run {
+			off64_t physAddr;	// Physical address of the first block.
+			uint32_t firstBlock;	// First logical block.
+			uint32_t blockCount;	// Number of blocks.
+		};
+		vector<Run> runs;
+
+		off64_t length;		// File length.
+		off64_t pos;		// Read position.
+
+		/**
+		 * Find the run containing the specified logical block.
+		 * @param block Logical block.
+		 * @return Run, or nullptr if not found.
+		 */
+		const Run *findRun(uint32_t block) const;
+};
+
+/** StfsReaderPrivate **/
+
+StfsReaderPrivate::StfsReaderPrivate(StfsReader *q,
+	const vector<StfsReader::BlockRun> &runs, off64_t length)
+	: q_ptr(q)
+	, length(length)
+	, pos(0)
+{
+	// Merge physically contiguous runs.
+	this->runs.reserve(runs.size());
+	uint32_t firstBlock = 0;
+	for (const StfsReader::BlockRun &run : runs) {
+		if (run.blockCount == 0)
+			continue;
+
+		if (!this->runs.empty()) {
+			Run &prev = this->runs.back();
+			if (prev.physAddr + (static_cast<off64_t>(prev.blockCount) * STFS_BLOCK_SIZE) == run.physAddr) {
+				// Physically contiguous.
+				prev.blockCount += run.blockCount;
+				firstBlock += run.blockCount;
+				continue;
+			}
+		}
+
+		this->runs.push_back({run.physAddr, firstBlock, run.blockCount});
+		firstBlock += run.blockCount;
+	}
+
+	// Make sure the file length doesn't exceed the block runs.
+	const off64_t maxLength = static_cast<off64_t>(firstBlock) * STFS_BLOCK_SIZE;
+	if (this->length > maxLength) {
+		this->length = maxLength;
+	}
+}
+
+/**
+ * Find the run containing the specified logical block.
+ * @param block Logical block.
+ * @return Run, or nullptr if not found.
+ */
+const StfsReaderPrivate::Run *StfsReaderPrivate::findRun(uint32_t block) const
+{
+	// Find the first run that starts *after* the block,
+	// then go back one run.
+	auto iter = std::upper_bound(runs.cbegin(), runs.cend(), block,
+		[](uint32_t block, const Run &run) {
+			return (block < run.firstBlock);
+		});
+	if (iter == runs.cbegin())
+		return nullptr;
+	--iter;
+	return (block - iter->firstBlock < iter->blockCount ? &(*iter) : nullptr);
+}
+
+/** StfsReader **/
+
+/**
+ * Construct an StfsReader with the specified IRpFile.
+ *
+ * Each block run is read using a single read from the
+ * underlying file. Adjacent runs that are physically
+ * contiguous are merged.
+ *
+ * NOTE: The IRpFile *must* remain valid while this
+ * StfsReader is open.
+ *
+ * @param file		[in] IRpFile.
+ * @param runs		[in] Block runs, in logical block order.
+ * @param length	[in] File length, in bytes.
+ */
+StfsReader::StfsReader(IRpFile *file, const vector<BlockRun> &runs, off64_t length)
+	: super(file)
+	, d_ptr(new StfsReaderPrivate(this, runs, length))
+{
+	if (!m_file) {
+		// File isn't open.
+		m_lastError = EBADF;
+		return;
+	}
+}
+
+StfsReader::~StfsReader()
+{
+	delete d_ptr;
+}
+
+/** IDiscReader **/
+
+/**
+ * Read data from the file.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t StfsReader::read(void *ptr, size_t size)
+{
+	RP_D(StfsReader);
+	assert(ptr != nullptr);
+	assert(m_file != nullptr);
+	if (!ptr) {
+		m_lastError = EINVAL;
+		return 0;
+	} else if (!m_file || !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	// Are we already at the end of the file?
+	if (d->pos >= d->length)
+		return 0;
+
+	// Make sure d->pos + size <= d->length.
+	// If it isn't, we'll do a short read.
+	if (d->pos + static_cast<off64_t>(size) >= d->length) {
+		size = static_cast<size_t>(d->length - d->pos);
+	}
+
+	// Read each block run using a single read.
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t ret = 0;
+	while (size > 0) {
+		const StfsReaderPrivate::Run *const run =
+			d->findRun(static_cast<uint32_t>(d->pos / STFS_BLOCK_SIZE));
+		if (!run) {
+			// Block is out of range.
+			m_lastError = EIO;
+			break;
+		}
+
+		const off64_t runOffset = d->pos - (static_cast<off64_t>(run->firstBlock) * STFS_BLOCK_SIZE);
+		const off64_t runRemain = (static_cast<off64_t>(run->blockCount) * STFS_BLOCK_SIZE) - runOffset;
+		const size_t rd_size = (static_cast<off64_t>(size) > runRemain
+			? static_cast<size_t>(runRemain) : size);
+
+		const size_t sz_read = m_file->seekAndRead(run->physAddr + runOffset, ptr8, rd_size);
+		ret += sz_read;
+		d->pos += sz_read;
+		if (sz_read != rd_size) {
+			// Seek and/or read error.
+			m_lastError = m_file->lastError();
+			if (m_lastError == 0) {
+				m_lastError = EIO;
+			}
+			break;
+		}
+
+		ptr8 += rd_size;
+		size -= rd_size;
+	}
+
+	return ret;
+}
+
+/**
+ * Set the file position.
+ * @param pos File position.
+ * @return 0 on success; -1 on error.
+ */
+int StfsReader::seek(off64_t pos)
+{
+	RP_D(StfsReader);
+	assert(m_file != nullptr);
+	if (!m_file || !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	// Handle out-of-range cases.
+	if (pos < 0) {
+		// Negative is invalid.
+		m_lastError = EINVAL;
+		return -1;
+	} else if (pos >= d->length) {
+		d->pos = d->length;
+	} else {
+		d->pos = pos;
+	}
+	return 0;
+}
+
+/**
+ * Get the file position.
+ * @return File position on success; -1 on error.
+ */
+off64_t StfsReader::tell(void)
+{
+	RP_D(const StfsReader);
+	assert(m_file != nullptr);
+	if (!m_file || !m_file->isOpen()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return d->pos;
+}
+
+/**
+ * Get the file size.
+ * @return File size, or -1 on error.
+ */
+off64_t StfsReader::size(void)
+{
+	RP_D(const StfsReader);
+	return d->length;
+}
+
+/** IPartition **/
+
+/**
+ * Get the partition size.
+ * This is the same as the file size.
+ * @return Partition size, or -1 on error.
+ */
+off64_t StfsReader::partition_size(void) const
+{
+	RP_D(const StfsReader);
+	return d->length;
+}
+
+/**
+ * Get the used partition size.
+ * This is the same as the file size.
+ * @return Used partition size, or -1 on error.
+ */
+off64_t StfsReader::partition_size_used(void) const
+{
+	RP_D(const StfsReader);
+	return d->length;
+}
+
+}
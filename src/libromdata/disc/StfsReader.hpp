@@ -0,0 +1,111 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * StfsReader.hpp: Microsoft Xbox 360 STFS file reader.                    *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__
+
+// librpbase
+#include "librpbase/disc/IPartition.hpp"
+
+// C++ includes.
+#include <vector>
+
+namespace LibRomData {
+
+class StfsReaderPrivate;
+class StfsReader : public LibRpBase::IPartition
+{
+	public:
+		/**
+		 * Run of physically contiguous STFS blocks.
+		 * Runs are stored in logical block order.
+		 */
+		struct BlockRun {
+			off64_t physAddr;	// Physical address of the first block.
+			uint32_t blockCount;	// Number of blocks.
+		};
+
+		/**
+		 * Construct an StfsReader with the specified IRpFile.
+		 *
+		 * Each block run is read using a single read from the
+		 * underlying file. Adjacent runs that are physically
+		 * contiguous are merged.
+		 *
+		 * NOTE: The IRpFile *must* remain valid while this
+		 * StfsReader is open.
+		 *
+		 * @param file		[in] IRpFile.
+		 * @param runs		[in] Block runs, in logical block order.
+		 * @param length	[in] File length, in bytes.
+		 */
+		StfsReader(LibRpFile::IRpFile *file,
+			const std::vector<BlockRun> &runs, off64_t length);
+	protected:
+		virtual ~StfsReader();	// call unref() instead
+
+	private:
+		typedef IPartition super;
+		RP_DISABLE_COPY(StfsReader)
+
+	protected:
+		friend class StfsReaderPrivate;
+		StfsReaderPrivate *const d_ptr;
+
+	public:
+		/** IDiscReader **/
+
+		/**
+		 * Read data from the file.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 2, 3)
+		size_t read(void *ptr, size_t size) final;
+
+		/**
+		 * Set the file position.
+		 * @param pos File position.
+		 * @return 0 on success; -1 on error.
+		 */
+		int seek(off64_t pos) final;
+
+		/**
+		 * Get the file position.
+		 * @return File position on success; -1 on error.
+		 */
+		off64_t tell(void) final;
+
+		/**
+		 * Get the file size.
+		 * @return File size, or -1 on error.
+		 */
+		off64_t size(void) final;
+
+	public:
+		/** IPartition **/
+
+		/**
+		 * Get the partition size.
+		 * This is the same as the file size.
+		 * @return Partition size, or -1 on error.
+		 */
+		off64_t partition_size(void) const final;
+
+		/**
+		 * Get the used partition size.
+		 * This is the same as the file size.
+		 * @return Used partition size, or -1 on error.
+		 */
+		off64_t partition_size_used(void) const final;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__ */
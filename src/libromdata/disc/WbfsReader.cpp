@@ -368,6 +368,10 @@ WbfsReader::WbfsReader(IRpFile *file)
 
 	// Get the size of the WBFS disc.
 	d->disc_size = d->getWbfsDiscSize(d->m_wbfs_disc);
+
+	// WBFS blocks are usually allocated sequentially,
+	// so adjacent blocks can be read with a single read.
+	d->coalesceRuns = true;
 }
 
 /**
@@ -12,17 +12,27 @@
 #include "WiiPartition.hpp"
 #include "Console/wii_structs.h"
 
-// librpbase, librpfile
+// librpbase, librpfile, librpthreads
 #include "librpbase/crypto/KeyManager.hpp"
+#include "librpfile/RpTrace.hpp"
+#include "librpthreads/CancelToken.hpp"
+using LibRpThreads::CancelToken;
 #ifdef ENABLE_DECRYPTION
 # include "librpbase/crypto/IAesCipher.hpp"
 # include "librpbase/crypto/AesCipherFactory.hpp"
+# include "librpbase/crypto/SHA1Hash.hpp"
+# include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::ThreadPool;
 #endif /* ENABLE_DECRYPTION */
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
 
+// C++ includes.
+#include <algorithm>
+
 // C++ STL classes.
 using std::unique_ptr;
+using std::vector;
 
 #include "GcnPartitionPrivate.hpp"
 namespace LibRomData {
@@ -69,10 +79,9 @@ class WiiPartitionPrivate : public GcnPartitionPrivate
 		// NOTE: Actual read position if ((cryptoMethod & CM_MASK_SECTOR) == CM_32K).
 		off64_t pos_7C00;
 
-		// Decrypted sector cache.
+		// Decrypted sector.
 		// NOTE: Actual data starts at 0x400.
 		// Hashes and the sector IV are stored first.
-		uint32_t sector_num;				// Sector number.
 		union EncSector_t {
 			struct {
 				// NOTE: &hashes.H2[7][4], when encrypted, is the sector IV.
@@ -90,16 +99,53 @@ class WiiPartitionPrivate : public GcnPartitionPrivate
 		};
 		ASSERT_STRUCT(EncSector_t, SECTOR_SIZE_ENCRYPTED);
 		static_assert(offsetof(EncSector_t, hashes.H2) + (7*20) + 4 == 0x3D0, "IV location is wrong");
-		EncSector_t sector_buf;	// Decrypted sector data.
+
+		// Decrypted sector cache.
+		// Sectors are replaced in least-recently used order.
+		static const unsigned int SECTOR_CACHE_COUNT = 4;
+		struct SectorCacheEntry {
+			uint32_t sector_num;	// Sector number. (~0 if empty)
+			uint32_t lastUsed;	// sectorCacheTick value when last used.
+		};
+		SectorCacheEntry sectorCacheIdx[SECTOR_CACHE_COUNT];
+		unique_ptr<EncSector_t[]> sectorCache;	// Allocated on first use.
+		uint32_t sectorCacheTick;		// LRU counter.
+
+		/**
+		 * Decrypt a sector in place.
+		 * @param sector Sector.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int decryptSector(EncSector_t *sector);
 
 		/**
 		 * Read and decrypt a sector.
-		 * The decrypted sector is stored in sector_buf.
+		 * The decrypted sector is stored in the sector cache.
 		 *
 		 * @param sector_num Sector number. (address / 0x7C00)
-		 * @return 0 on success; negative POSIX error code on error.
+		 * @return Decrypted sector, or nullptr on error.
+		 */
+		const EncSector_t *readSector(uint32_t sector_num);
+
+		// Maximum number of sectors to read at once in readSectors().
+		static const unsigned int BULK_SECTOR_COUNT = 16;
+		// Raw sector buffer for readSectors(). (Allocated on first use.)
+		unique_ptr<EncSector_t[]> bulkBuf;
+
+		/**
+		 * Read and decrypt multiple contiguous sectors.
+		 * Only the sector data is copied to ptr; the sector cache is bypassed.
+		 *
+		 * Sectors are read from the disc in runs of up to BULK_SECTOR_COUNT,
+		 * so a large read needs far fewer I/O requests than reading each
+		 * sector through readSector().
+		 *
+		 * @param sector_num	[in] First sector number.
+		 * @param count		[in] Number of sectors.
+		 * @param ptr		[out] Output buffer. (count * sector data size)
+		 * @return Number of sectors read.
 		 */
-		int readSector(uint32_t sector_num);
+		unsigned int readSectors(uint32_t sector_num, unsigned int count, uint8_t *ptr);
 
 #ifdef ENABLE_DECRYPTION
 	public:
@@ -114,6 +160,21 @@ class WiiPartitionPrivate : public GcnPartitionPrivate
 		 */
 		KeyManager::VerifyResult initDecryption(void);
 
+		/**
+		 * Decrypt and verify a group of sectors.
+		 *
+		 * This function is thread-safe, since each call uses
+		 * its own AES cipher and hash objects.
+		 *
+		 * @param sectors	[in/out] Encrypted sectors. (Decrypted in place.)
+		 * @param count		[in] Number of sectors. (up to 64)
+		 * @param h3		[in] Expected H3 hash for this group.
+		 * @param pBadSectors	[out] Bitfield of sectors that failed verification.
+		 * @return WiiPartition::HashFailFlags, or 0 if the group is OK.
+		 */
+		uint32_t verifyGroup(EncSector_t *sectors, unsigned int count,
+			const uint8_t *h3, uint64_t *pBadSectors) const;
+
 	public:
 		// Verification key names.
 		static const char *const EncryptionKeyNames[WiiPartition::Key_Max];
@@ -194,7 +255,7 @@ WiiPartitionPrivate::WiiPartitionPrivate(WiiPartition *q,
 	, encKeyReal(WiiPartition::EncKey::Unknown)
 	, cryptoMethod(cryptoMethod)
 	, pos_7C00(-1)
-	, sector_num(~0)
+	, sectorCacheTick(0)
 	, aes_title(nullptr)
 #else /* !ENABLE_DECRYPTION */
 	, verifyResult(KeyManager::VerifyResult::NoSupport)
@@ -202,7 +263,7 @@ WiiPartitionPrivate::WiiPartitionPrivate(WiiPartition *q,
 	, encKeyReal(WiiPartition::EncKey::Unknown)
 	, cryptoMethod(cryptoMethod)
 	, pos_7C00(-1)
-	, sector_num(~0)
+	, sectorCacheTick(0)
 #endif /* ENABLE_DECRYPTION */
 {
 	// Clear data set by GcnPartition in case the
@@ -214,6 +275,12 @@ WiiPartitionPrivate::WiiPartitionPrivate(WiiPartition *q,
 	// Clear the partition header struct.
 	memset(&partitionHeader, 0, sizeof(partitionHeader));
 
+	// Clear the sector cache.
+	for (SectorCacheEntry &entry : sectorCacheIdx) {
+		entry.sector_num = ~0U;
+		entry.lastUsed = 0;
+	}
+
 	// Partition header will be read in the WiiPartition constructor.
 }
 
@@ -380,7 +447,8 @@ KeyManager::VerifyResult WiiPartitionPrivate::initDecryption(void)
 
 	// Read sector 0, which contains a disc header.
 	// NOTE: readSector() doesn't check verifyResult.
-	if (readSector(0) != 0) {
+	const EncSector_t *const sector0 = readSector(0);
+	if (!sector0) {
 		// Error reading sector 0.
 		delete aes_title;
 		aes_title = nullptr;
@@ -391,7 +459,7 @@ KeyManager::VerifyResult WiiPartitionPrivate::initDecryption(void)
 	// Verify that this is a Wii partition.
 	// If it isn't, the key is probably wrong.
 	const GCN_DiscHeader *const discHeader =
-		reinterpret_cast<const GCN_DiscHeader*>(sector_buf.data);
+		reinterpret_cast<const GCN_DiscHeader*>(sector0->data);
 	if (discHeader->magic_wii != cpu_to_be32(WII_MAGIC)) {
 		// Invalid disc header.
 
@@ -402,7 +470,7 @@ KeyManager::VerifyResult WiiPartitionPrivate::initDecryption(void)
 			0x00,0x00,0x00,0x10, 0x00,0x00,0x00,0x14,
 			0x00,0x00,0x00,0x18, 0x00,0x00,0x00,0x1C,
 		};
-		if (!memcmp(sector_buf.data, incr_vals, sizeof(incr_vals))) {
+		if (!memcmp(sector0->data, incr_vals, sizeof(incr_vals))) {
 			// Found incrementing values.
 			verifyResult = KeyManager::VerifyResult::IncrementingValues;
 		} else {
@@ -426,68 +494,289 @@ WiiPartitionPrivate::~WiiPartitionPrivate()
 #endif /* ENABLE_DECRYPTION */
 }
 
+/**
+ * Decrypt a sector in place.
+ * @param sector Sector.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int WiiPartitionPrivate::decryptSector(EncSector_t *sector)
+{
+	const bool isCrypted = ((cryptoMethod & WiiPartition::CM_MASK_ENCRYPTED) == WiiPartition::CM_ENCRYPTED);
+	if (!isCrypted) {
+		// Sector is not encrypted.
+		return 0;
+	}
+
+#ifdef ENABLE_DECRYPTION
+	// Decrypt the sector.
+	// NOTE: This function doesn't check verifyResult,
+	// since it's called by initDecryption() before
+	// verifyResult is set.
+	if (aes_title->decrypt(sector->data, sizeof(sector->data),
+	    &sector->hashes.H2[7][4], 16) != SECTOR_SIZE_DECRYPTED)
+	{
+		return -EIO;
+	}
+	return 0;
+#else /* !ENABLE_DECRYPTION */
+	// Decryption is disabled.
+	RP_UNUSED(sector);
+	return -EIO;
+#endif /* ENABLE_DECRYPTION */
+}
+
 /**
  * Read and decrypt a sector.
- * The decrypted sector is stored in sector_buf.
+ * The decrypted sector is stored in the sector cache.
  *
  * @param sector_num Sector number. (address / 0x7C00)
- * @return 0 on success; negative POSIX error code on error.
+ * @return Decrypted sector, or nullptr on error.
  */
-int WiiPartitionPrivate::readSector(uint32_t sector_num)
+const WiiPartitionPrivate::EncSector_t *WiiPartitionPrivate::readSector(uint32_t sector_num)
 {
-	if (this->sector_num == sector_num) {
-		// Sector is already in memory.
-		return 0;
+	RP_TRACE_ZONE("WiiPartitionPrivate::readSector");
+
+	// Check if the sector is already in memory.
+	// Empty entries have lastUsed == 0, so they're replaced first.
+	SectorCacheEntry *lru = &sectorCacheIdx[0];
+	for (SectorCacheEntry &entry : sectorCacheIdx) {
+		if (entry.sector_num == sector_num) {
+			// Sector is already in memory.
+			entry.lastUsed = ++sectorCacheTick;
+			return &sectorCache[&entry - sectorCacheIdx];
+		}
+		if (entry.lastUsed < lru->lastUsed) {
+			lru = &entry;
+		}
 	}
 
 	RP_Q(WiiPartition);
-	const bool isCrypted = ((cryptoMethod & WiiPartition::CM_MASK_ENCRYPTED) == WiiPartition::CM_ENCRYPTED);
-#ifndef ENABLE_DECRYPTION
-	if (isCrypted) {
-		// Decryption is disabled.
-		q->m_lastError = EIO;
-		return -1;
+	if (!sectorCache) {
+		sectorCache.reset(new EncSector_t[SECTOR_CACHE_COUNT]);
 	}
-#endif /* !ENABLE_DECRYPTION */
+	EncSector_t *const sector = &sectorCache[lru - sectorCacheIdx];
+
+	// Read the sector into the least-recently used entry.
+	// It's marked as empty until the sector is decrypted.
+	lru->sector_num = ~0U;
+	lru->lastUsed = 0;
 
-	// NOTE: This function doesn't check verifyResult,
-	// since it's called by initDecryption() before
-	// verifyResult is set.
 	off64_t sector_addr = partition_offset + data_offset;
 	sector_addr += (static_cast<off64_t>(sector_num) * SECTOR_SIZE_ENCRYPTED);
 
-	int ret = q->m_discReader->seek(sector_addr);
-	if (ret != 0) {
+	size_t sz = q->m_discReader->seekAndRead(sector_addr, sector, sizeof(*sector));
+	if (sz != sizeof(*sector)) {
 		q->m_lastError = q->m_discReader->lastError();
-		return ret;
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+		return nullptr;
 	}
 
-	size_t sz = q->m_discReader->read(&sector_buf, sizeof(sector_buf));
-	if (sz != sizeof(sector_buf)) {
-		// sector_buf may be invalid.
-		this->sector_num = ~0;
+	if (decryptSector(sector) != 0) {
 		q->m_lastError = EIO;
-		return -1;
+		return nullptr;
+	}
+
+	// Sector read and decrypted.
+	lru->sector_num = sector_num;
+	lru->lastUsed = ++sectorCacheTick;
+	return sector;
+}
+
+/**
+ * Read and decrypt multiple contiguous sectors.
+ * Only the sector data is copied to ptr; the sector cache is bypassed.
+ *
+ * Sectors are read from the disc in runs of up to BULK_SECTOR_COUNT,
+ * so a large read needs far fewer I/O requests than reading each
+ * sector through readSector().
+ *
+ * @param sector_num	[in] First sector number.
+ * @param count		[in] Number of sectors.
+ * @param ptr		[out] Output buffer. (count * sector data size)
+ * @return Number of sectors read.
+ */
+unsigned int WiiPartitionPrivate::readSectors(uint32_t sector_num, unsigned int count, uint8_t *ptr)
+{
+	RP_Q(WiiPartition);
+	off64_t sector_addr = partition_offset + data_offset;
+	sector_addr += (static_cast<off64_t>(sector_num) * SECTOR_SIZE_ENCRYPTED);
+
+	if ((cryptoMethod & WiiPartition::CM_MASK_SECTOR) == WiiPartition::CM_32K) {
+		// Full 32K sectors. (implies no encryption)
+		// Read the sectors directly into the output buffer.
+		const size_t size = static_cast<size_t>(count) * SECTOR_SIZE_ENCRYPTED;
+		size_t sz = q->m_discReader->seekAndRead(sector_addr, ptr, size);
+		if (sz != size) {
+			q->m_lastError = q->m_discReader->lastError();
+			if (q->m_lastError == 0) {
+				q->m_lastError = EIO;
+			}
+		}
+		return static_cast<unsigned int>(sz / SECTOR_SIZE_ENCRYPTED);
+	}
+
+	if (!bulkBuf) {
+		bulkBuf.reset(new EncSector_t[BULK_SECTOR_COUNT]);
+	}
+
+	unsigned int sectors_read = 0;
+	while (count > 0) {
+		if (CancelToken::isCurrentCancelled()) {
+			// Operation was cancelled.
+			q->m_lastError = ECANCELED;
+			break;
+		}
+
+		unsigned int run = (count < BULK_SECTOR_COUNT ? count : BULK_SECTOR_COUNT);
+		const size_t size = static_cast<size_t>(run) * SECTOR_SIZE_ENCRYPTED;
+		size_t sz = q->m_discReader->seekAndRead(sector_addr, bulkBuf.get(), size);
+		const bool isShortRead = (sz != size);
+		if (isShortRead) {
+			// Short read. Process the sectors that were read.
+			q->m_lastError = q->m_discReader->lastError();
+			if (q->m_lastError == 0) {
+				q->m_lastError = EIO;
+			}
+			run = static_cast<unsigned int>(sz / SECTOR_SIZE_ENCRYPTED);
+		}
+
+		// Decrypt the sectors.
+		for (unsigned int i = 0; i < run; i++) {
+			EncSector_t *const sector = &bulkBuf[i];
+			if (decryptSector(sector) != 0) {
+				q->m_lastError = EIO;
+				return sectors_read;
+			}
+			memcpy(ptr, sector->data, SECTOR_SIZE_DECRYPTED);
+			ptr += SECTOR_SIZE_DECRYPTED;
+			sectors_read++;
+		}
+
+		if (isShortRead)
+			break;
+		sector_addr += size;
+		count -= run;
 	}
 
+	return sectors_read;
+}
+
 #ifdef ENABLE_DECRYPTION
-	if (isCrypted) {
-		// Decrypt the sector.
-		if (aes_title->decrypt(sector_buf.data, sizeof(sector_buf.data),
-		    &sector_buf.hashes.H2[7][4], 16) != SECTOR_SIZE_DECRYPTED)
+/**
+ * Decrypt and verify a group of sectors.
+ *
+ * This function is thread-safe, since each call uses
+ * its own AES cipher and hash objects.
+ *
+ * @param sectors	[in/out] Encrypted sectors. (Decrypted in place.)
+ * @param count		[in] Number of sectors. (up to 64)
+ * @param h3		[in] Expected H3 hash for this group.
+ * @param pBadSectors	[out] Bitfield of sectors that failed verification.
+ * @return WiiPartition::HashFailFlags, or 0 if the group is OK.
+ */
+uint32_t WiiPartitionPrivate::verifyGroup(EncSector_t *sectors, unsigned int count,
+	const uint8_t *h3, uint64_t *pBadSectors) const
+{
+	assert(count > 0);
+	assert(count <= 64);
+
+	unique_ptr<IAesCipher> cipher;
+	if ((cryptoMethod & WiiPartition::CM_MASK_ENCRYPTED) == WiiPartition::CM_ENCRYPTED) {
+		// aes_title can't be shared between threads.
+		cipher.reset(AesCipherFactory::create());
+		if (!cipher || !cipher->isInit() ||
+		    cipher->setKey(title_key, sizeof(title_key)) != 0 ||
+		    cipher->setChainingMode(IAesCipher::ChainingMode::CBC) != 0)
 		{
-			// sector_buf may be invalid.
-			this->sector_num = ~0;
-			q->m_lastError = EIO;
-			return -1;
+			*pBadSectors = (count < 64 ? ((1ULL << count) - 1) : ~0ULL);
+			return WiiPartition::HF_READ;
 		}
 	}
-#endif /* ENABLE_DECRYPTION */
 
-	// Sector read and decrypted.
-	this->sector_num = sector_num;
-	return 0;
+	SHA1Hash sha1;
+	if (!sha1.isUsable()) {
+		*pBadSectors = (count < 64 ? ((1ULL << count) - 1) : ~0ULL);
+		return WiiPartition::HF_READ;
+	}
+
+	uint32_t flags = 0;
+	uint64_t badSectors = 0;
+	uint8_t hash[SHA1Hash::HASH_LEN];
+
+	for (unsigned int i = 0; i < count; i++) {
+		EncSector_t *const sector = &sectors[i];
+		if (cipher) {
+			// The data IV is stored in the encrypted hash block,
+			// so the data must be decrypted first.
+			static const uint8_t zero_iv[16] = {0};
+			if (cipher->decrypt(sector->data, sizeof(sector->data),
+			                    &sector->hashes.H2[7][4], 16) != SECTOR_SIZE_DECRYPTED ||
+			    cipher->decrypt(sector->fulldata, SECTOR_SIZE_DECRYPTED_OFFSET,
+			                    zero_iv, sizeof(zero_iv)) != SECTOR_SIZE_DECRYPTED_OFFSET)
+			{
+				flags |= WiiPartition::HF_READ;
+				badSectors |= (1ULL << i);
+				continue;
+			}
+		}
+
+		// H0: One hash per 1 KB block of sector data.
+		for (unsigned int j = 0; j < ARRAY_SIZE(sector->hashes.H0); j++) {
+			sha1.reset();
+			sha1.process(&sector->data[j * 0x400], 0x400);
+			sha1.getHash(hash, sizeof(hash));
+			if (memcmp(hash, sector->hashes.H0[j], sizeof(hash)) != 0) {
+				flags |= WiiPartition::HF_H0;
+				badSectors |= (1ULL << i);
+				break;
+			}
+		}
+
+		// H1: One hash per sector's H0 table.
+		// All sectors in a subgroup have the same H1 table.
+		sha1.reset();
+		sha1.process(sector->hashes.H0, sizeof(sector->hashes.H0));
+		sha1.getHash(hash, sizeof(hash));
+		if (memcmp(hash, sector->hashes.H1[i & 7], sizeof(hash)) != 0 ||
+		    memcmp(sector->hashes.H1, sectors[i & ~7U].hashes.H1, sizeof(sector->hashes.H1)) != 0)
+		{
+			flags |= WiiPartition::HF_H1;
+			badSectors |= (1ULL << i);
+		}
+
+		// All sectors in a group have the same H2 table.
+		if (memcmp(sector->hashes.H2, sectors[0].hashes.H2, sizeof(sector->hashes.H2)) != 0) {
+			flags |= WiiPartition::HF_H2;
+			badSectors |= (1ULL << i);
+		}
+	}
+
+	// H2: One hash per subgroup's H1 table.
+	for (unsigned int i = 0; i < count; i += 8) {
+		sha1.reset();
+		sha1.process(sectors[i].hashes.H1, sizeof(sectors[i].hashes.H1));
+		sha1.getHash(hash, sizeof(hash));
+		if (memcmp(hash, sectors[0].hashes.H2[i / 8], sizeof(hash)) != 0) {
+			const unsigned int sg_count = std::min(count - i, 8U);
+			flags |= WiiPartition::HF_H2;
+			badSectors |= (((1ULL << sg_count) - 1) << i);
+		}
+	}
+
+	// H3: One hash per group's H2 table.
+	sha1.reset();
+	sha1.process(sectors[0].hashes.H2, sizeof(sectors[0].hashes.H2));
+	sha1.getHash(hash, sizeof(hash));
+	if (memcmp(hash, h3, sizeof(hash)) != 0) {
+		flags |= WiiPartition::HF_H3;
+	}
+
+	*pBadSectors = badSectors;
+	return flags;
 }
+#endif /* ENABLE_DECRYPTION */
 
 /** WiiPartition **/
 
@@ -598,7 +887,6 @@ size_t WiiPartition::read(void *ptr, size_t size)
 		return 0;
 	}
 
-	// TODO: Consolidate this code and optimize it.
 	size_t ret = 0;
 	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
 
@@ -612,149 +900,109 @@ size_t WiiPartition::read(void *ptr, size_t size)
 		size = static_cast<size_t>(d->data_size - d->pos_7C00);
 	}
 
-	if ((d->cryptoMethod & CM_MASK_SECTOR) == CM_32K) {
-		// Full 32K sectors. (implies no encryption)
-
-		// Check if we're not starting on a block boundary.
-		const uint32_t blockStartOffset = d->pos_7C00 % SECTOR_SIZE_ENCRYPTED;
-		if (blockStartOffset != 0) {
-			// Not a block boundary.
-			// Read the end of the block.
-			uint32_t read_sz = SECTOR_SIZE_ENCRYPTED - blockStartOffset;
-			if (size < static_cast<size_t>(read_sz)) {
-				read_sz = static_cast<uint32_t>(size);
-			}
-
-			// Read and decrypt the sector.
-			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_ENCRYPTED);
-			d->readSector(blockStart);
-
-			// Copy data from the sector.
-			memcpy(ptr8, &d->sector_buf.fulldata[blockStartOffset], read_sz);
-
-			// Starting block read.
-			size -= read_sz;
-			ptr8 += read_sz;
-			ret += read_sz;
-			d->pos_7C00 += read_sz;
-		}
-
-		// Read entire blocks.
-		for (; size >= SECTOR_SIZE_ENCRYPTED;
-		     size -= SECTOR_SIZE_ENCRYPTED, ptr8 += SECTOR_SIZE_ENCRYPTED,
-		     ret += SECTOR_SIZE_ENCRYPTED, d->pos_7C00 += SECTOR_SIZE_ENCRYPTED)
-		{
-			assert(d->pos_7C00 % SECTOR_SIZE_ENCRYPTED == 0);
-
-			// Read the sector.
-			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_ENCRYPTED);
-			d->readSector(blockStart);
-
-			// Copy data from the sector.
-			memcpy(ptr8, d->sector_buf.fulldata, SECTOR_SIZE_ENCRYPTED);
-		}
-
-		// Check if we still have data left. (not a full block)
-		if (size > 0) {
-			// Not a full block.
-
-			// Read the sector.
-			assert(d->pos_7C00 % SECTOR_SIZE_ENCRYPTED == 0);
-			const uint32_t blockEnd = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_ENCRYPTED);
-			d->readSector(blockEnd);
-
-			// Copy data from the sector.
-			memcpy(ptr8, d->sector_buf.fulldata, size);
-
-			ret += size;
-			d->pos_7C00 += size;
-		}
-	} else {
-		if ((d->cryptoMethod & CM_MASK_ENCRYPTED) == CM_ENCRYPTED) {
+	if ((d->cryptoMethod & CM_MASK_ENCRYPTED) == CM_ENCRYPTED) {
 #ifdef ENABLE_DECRYPTION
-			// Make sure decryption is initialized.
-			switch (d->verifyResult) {
-				case KeyManager::VerifyResult::Unknown:
-					// Attempt to initialize decryption.
-					if (d->initDecryption() != KeyManager::VerifyResult::OK) {
-						// Decryption could not be initialized.
-						// TODO: Better error?
-						m_lastError = EIO;
-						return 0;
-					}
-					break;
-
-				case KeyManager::VerifyResult::OK:
-					// Decryption is initialized.
-					break;
-
-				default:
-					// Decryption failed to initialize.
+		// Make sure decryption is initialized.
+		switch (d->verifyResult) {
+			case KeyManager::VerifyResult::Unknown:
+				// Attempt to initialize decryption.
+				if (d->initDecryption() != KeyManager::VerifyResult::OK) {
+					// Decryption could not be initialized.
 					// TODO: Better error?
 					m_lastError = EIO;
 					return 0;
-			}
+				}
+				break;
+
+			case KeyManager::VerifyResult::OK:
+				// Decryption is initialized.
+				break;
+
+			default:
+				// Decryption failed to initialize.
+				// TODO: Better error?
+				m_lastError = EIO;
+				return 0;
+		}
 #else /* !ENABLE_DECRYPTION */
-			// Decryption is not enabled.
-			m_lastError = EIO;
-			ret = 0;
+		// Decryption is not enabled.
+		m_lastError = EIO;
+		ret = 0;
 #endif /* ENABLE_DECRYPTION */
-		}
-
-		// Check if we're not starting on a block boundary.
-		const uint32_t blockStartOffset = d->pos_7C00 % SECTOR_SIZE_DECRYPTED;
-		if (blockStartOffset != 0) {
-			// Not a block boundary.
-			// Read the end of the block.
-			uint32_t read_sz = SECTOR_SIZE_DECRYPTED - blockStartOffset;
-			if (size < static_cast<size_t>(read_sz)) {
-				read_sz = static_cast<uint32_t>(size);
-			}
-
-			// Read and decrypt the sector.
-			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
-			d->readSector(blockStart);
+	}
 
-			// Copy data from the sector.
-			memcpy(ptr8, &d->sector_buf.data[blockStartOffset], read_sz);
+	// Full 32K sectors imply no encryption.
+	// Otherwise, only 0x7C00 bytes of each sector are data.
+	const bool is32K = ((d->cryptoMethod & CM_MASK_SECTOR) == CM_32K);
+	const uint32_t sector_size = (is32K ? SECTOR_SIZE_ENCRYPTED : SECTOR_SIZE_DECRYPTED);
+	const uint32_t data_start = (is32K ? 0 : SECTOR_SIZE_DECRYPTED_OFFSET);
+
+	// Check if we're not starting on a block boundary.
+	const uint32_t blockStartOffset = d->pos_7C00 % sector_size;
+	if (blockStartOffset != 0) {
+		// Not a block boundary.
+		// Read the end of the block.
+		uint32_t read_sz = sector_size - blockStartOffset;
+		if (size < static_cast<size_t>(read_sz)) {
+			read_sz = static_cast<uint32_t>(size);
+		}
 
-			// Starting block read.
-			size -= read_sz;
-			ptr8 += read_sz;
-			ret += read_sz;
-			d->pos_7C00 += read_sz;
+		// Read and decrypt the sector.
+		const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / sector_size);
+		const WiiPartitionPrivate::EncSector_t *const sector = d->readSector(blockStart);
+		if (!sector) {
+			// Error reading the sector.
+			return ret;
 		}
 
-		// Read entire blocks.
-		for (; size >= SECTOR_SIZE_DECRYPTED;
-		size -= SECTOR_SIZE_DECRYPTED, ptr8 += SECTOR_SIZE_DECRYPTED,
-		ret += SECTOR_SIZE_DECRYPTED, d->pos_7C00 += SECTOR_SIZE_DECRYPTED)
-		{
-			assert(d->pos_7C00 % SECTOR_SIZE_DECRYPTED == 0);
+		// Copy data from the sector.
+		memcpy(ptr8, &sector->fulldata[data_start + blockStartOffset], read_sz);
 
-			// Read and decrypt the sector.
-			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
-			d->readSector(blockStart);
+		// Starting block read.
+		size -= read_sz;
+		ptr8 += read_sz;
+		ret += read_sz;
+		d->pos_7C00 += read_sz;
+	}
 
-			// Copy data from the sector.
-			memcpy(ptr8, d->sector_buf.data, SECTOR_SIZE_DECRYPTED);
+	// Read entire blocks.
+	if (size >= sector_size) {
+		assert(d->pos_7C00 % sector_size == 0);
+
+		// Read and decrypt the sectors.
+		const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / sector_size);
+		const unsigned int count = static_cast<unsigned int>(size / sector_size);
+		const unsigned int sectors_read = d->readSectors(blockStart, count, ptr8);
+
+		const size_t sz_read = static_cast<size_t>(sectors_read) * sector_size;
+		size -= sz_read;
+		ptr8 += sz_read;
+		ret += sz_read;
+		d->pos_7C00 += sz_read;
+		if (sectors_read != count) {
+			// Error reading the sectors.
+			return ret;
 		}
+	}
 
-		// Check if we still have data left. (not a full block)
-		if (size > 0) {
-			// Not a full block.
-
-			// Read and decrypt the sector.
-			assert(d->pos_7C00 % SECTOR_SIZE_DECRYPTED == 0);
-			const uint32_t blockEnd = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
-			d->readSector(blockEnd);
+	// Check if we still have data left. (not a full block)
+	if (size > 0) {
+		// Not a full block.
+
+		// Read and decrypt the sector.
+		assert(d->pos_7C00 % sector_size == 0);
+		const uint32_t blockEnd = static_cast<uint32_t>(d->pos_7C00 / sector_size);
+		const WiiPartitionPrivate::EncSector_t *const sector = d->readSector(blockEnd);
+		if (!sector) {
+			// Error reading the sector.
+			return ret;
+		}
 
-			// Copy data from the sector.
-			memcpy(ptr8, d->sector_buf.data, size);
+		// Copy data from the sector.
+		memcpy(ptr8, &sector->fulldata[data_start], size);
 
-			ret += size;
-			d->pos_7C00 += size;
-		}
+		ret += size;
+		d->pos_7C00 += size;
 	}
 
 	// Finished reading the data.
@@ -900,6 +1148,169 @@ const RVL_TMD_Header *WiiPartition::tmdHeader(void) const
 		: nullptr);
 }
 
+#ifdef ENABLE_DECRYPTION
+/** Hash verification **/
+
+/**
+ * Verify the partition's hash tree.
+ *
+ * The H3 table is checked against the TMD, and each group
+ * is checked against the H3 table. Groups are read in large
+ * batches, and each batch is decrypted and hashed on
+ * multiple threads.
+ *
+ * Only the used part of the partition is checked.
+ *
+ * @param result	[out] Verification results.
+ * @return 0 on success; negative POSIX error code on error.
+ * (On a read error, result has the groups checked so far.)
+ */
+int WiiPartition::verifyHashes(HashVerifyResult &result)
+{
+	RP_D(WiiPartition);
+	result.groupCount = 0;
+	result.h3TableOK = false;
+	result.badGroups.clear();
+
+	assert(m_discReader != nullptr);
+	assert(m_discReader->isOpen());
+	if (!m_discReader || !m_discReader->isOpen()) {
+		m_lastError = EBADF;
+		return -EBADF;
+	} else if ((d->cryptoMethod & CM_MASK_SECTOR) == CM_32K) {
+		// Sectors don't have hashes.
+		return -ENOTSUP;
+	}
+
+	if ((d->cryptoMethod & CM_MASK_ENCRYPTED) == CM_ENCRYPTED &&
+	    d->initDecryption() != KeyManager::VerifyResult::OK)
+	{
+		// Unable to initialize decryption.
+		m_lastError = EIO;
+		return -EIO;
+	}
+
+	// Load the H3 table.
+	static const unsigned int H3_TABLE_SIZE = 0x18000;
+	static const unsigned int H3_ENTRY_COUNT = H3_TABLE_SIZE / SHA1Hash::HASH_LEN;
+	unique_ptr<uint8_t[]> h3_table(new uint8_t[H3_TABLE_SIZE]);
+	const off64_t h3_table_offset = d->partition_offset +
+		(static_cast<off64_t>(be32_to_cpu(d->partitionHeader.h3_table_offset)) << 2);
+	size_t size = m_discReader->seekAndRead(h3_table_offset, h3_table.get(), H3_TABLE_SIZE);
+	if (size != H3_TABLE_SIZE) {
+		m_lastError = m_discReader->lastError();
+		if (m_lastError == 0) {
+			m_lastError = EIO;
+		}
+		return -m_lastError;
+	}
+
+	// Content 0 in the TMD has the H3 table hash.
+	const RVL_TMD_Header *const tmd = tmdHeader();
+	if (tmd && be16_to_cpu(tmd->nbr_cont) > 0) {
+		const RVL_Content_Entry *const content0 = reinterpret_cast<const RVL_Content_Entry*>(
+			&d->partitionHeader.tmd[sizeof(RVL_TMD_Header)]);
+		uint8_t hash[SHA1Hash::HASH_LEN];
+		if (SHA1Hash::calcHash(hash, sizeof(hash), h3_table.get(), H3_TABLE_SIZE) == 0) {
+			result.h3TableOK = !memcmp(hash, content0->sha1_hash, sizeof(hash));
+		}
+	}
+
+	// Determine the number of sectors to check.
+	// Unused areas may be scrubbed, so only check the used size.
+	off64_t check_size = d->data_size;
+	const off64_t size_used = partition_size_used();
+	if (size_used > d->data_offset && size_used - d->data_offset < check_size) {
+		check_size = size_used - d->data_offset;
+	}
+	static const unsigned int GROUP_SECTORS = 64;
+	uint32_t sector_count = static_cast<uint32_t>(
+		(check_size + SECTOR_SIZE_ENCRYPTED - 1) / SECTOR_SIZE_ENCRYPTED);
+	uint32_t group_count = (sector_count + GROUP_SECTORS - 1) / GROUP_SECTORS;
+	if (group_count > H3_ENTRY_COUNT) {
+		group_count = H3_ENTRY_COUNT;
+		sector_count = group_count * GROUP_SECTORS;
+	}
+
+	// Groups are read on this thread, then decrypted and hashed in parallel.
+	// Each batch has two groups per thread so the threads don't have to
+	// wait on each other as much. The number of threads is limited to
+	// keep the batch buffer reasonably small. (2 MB per group)
+	static const unsigned int MAX_THREADS = 8;
+	ThreadPool pool(std::min(ThreadPool::cpuCount(), MAX_THREADS));
+	const unsigned int batchGroups = pool.threadCount() * 2;
+	unique_ptr<WiiPartitionPrivate::EncSector_t[]> batchBuf(
+		new WiiPartitionPrivate::EncSector_t[batchGroups * GROUP_SECTORS]);
+
+	struct GroupJob {
+		uint32_t flags;
+		uint64_t sectors;
+	};
+	vector<GroupJob> jobs(batchGroups);
+
+	int ret = 0;
+	for (uint32_t group = 0; group < group_count && ret == 0; group += batchGroups) {
+		if (CancelToken::isCurrentCancelled()) {
+			// Operation was cancelled.
+			m_lastError = ECANCELED;
+			ret = -ECANCELED;
+			break;
+		}
+
+		const unsigned int jobCount = std::min(group_count - group, batchGroups);
+		const uint32_t first_sector = group * GROUP_SECTORS;
+		const unsigned int batchSectors = std::min(
+			sector_count - first_sector, jobCount * GROUP_SECTORS);
+
+		// Read the entire batch with a single read.
+		const off64_t addr = d->partition_offset + d->data_offset +
+			(static_cast<off64_t>(first_sector) * SECTOR_SIZE_ENCRYPTED);
+		const size_t batchSize = static_cast<size_t>(batchSectors) * SECTOR_SIZE_ENCRYPTED;
+		size = m_discReader->seekAndRead(addr, batchBuf.get(), batchSize);
+		const unsigned int sectorsRead = static_cast<unsigned int>(size / SECTOR_SIZE_ENCRYPTED);
+		if (size != batchSize) {
+			m_lastError = m_discReader->lastError();
+			if (m_lastError == 0) {
+				m_lastError = EIO;
+			}
+			ret = -m_lastError;
+		}
+
+		pool.parallelFor(jobCount, [&](size_t i) {
+			GroupJob &job = jobs[i];
+			const unsigned int start = static_cast<unsigned int>(i) * GROUP_SECTORS;
+			const unsigned int count = std::min(batchSectors - start, GROUP_SECTORS);
+			if (start + count > sectorsRead) {
+				// Short read.
+				const unsigned int avail = (sectorsRead > start ? sectorsRead - start : 0);
+				job.flags = HF_READ;
+				job.sectors = ~((1ULL << avail) - 1);
+				if (count < 64) {
+					job.sectors &= ((1ULL << count) - 1);
+				}
+				return;
+			}
+
+			job.flags = d->verifyGroup(&batchBuf[start], count,
+				&h3_table[(group + i) * SHA1Hash::HASH_LEN], &job.sectors);
+		});
+
+		for (unsigned int i = 0; i < jobCount; i++) {
+			if (jobs[i].flags != 0) {
+				BadGroup badGroup;
+				badGroup.group = group + i;
+				badGroup.flags = jobs[i].flags;
+				badGroup.sectors = jobs[i].sectors;
+				result.badGroups.emplace_back(badGroup);
+			}
+		}
+		result.groupCount += jobCount;
+	}
+
+	return ret;
+}
+#endif /* ENABLE_DECRYPTION */
+
 #ifdef ENABLE_DECRYPTION
 /** Encryption keys. **/
 
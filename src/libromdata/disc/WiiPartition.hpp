@@ -16,6 +16,9 @@
 // librpbase
 #include "librpbase/crypto/KeyManager.hpp"
 
+// C++ includes.
+#include <vector>
+
 namespace LibRomData {
 
 class WiiPartitionPrivate;
@@ -168,6 +171,53 @@ class WiiPartition : public GcnPartition
 		};
 
 #ifdef ENABLE_DECRYPTION
+	public:
+		/** Hash verification **/
+
+		// Hash verification failure flags.
+		enum HashFailFlags {
+			HF_READ	= (1U << 0),	// Read or decryption error
+			HF_H0	= (1U << 1),	// H0 mismatch (sector data)
+			HF_H1	= (1U << 2),	// H1 mismatch (H0 table)
+			HF_H2	= (1U << 3),	// H2 mismatch (H1 table)
+			HF_H3	= (1U << 4),	// H3 mismatch (H2 table)
+		};
+
+		/**
+		 * Group that failed hash verification.
+		 * A group is 64 sectors. (2 MB)
+		 */
+		struct BadGroup {
+			uint32_t group;		// Group number
+			uint32_t flags;		// HashFailFlags
+			uint64_t sectors;	// Bitfield of sectors within the group that failed
+		};
+
+		/**
+		 * Hash verification results.
+		 */
+		struct HashVerifyResult {
+			uint32_t groupCount;		// Number of groups checked
+			bool h3TableOK;			// H3 table matches the TMD
+			std::vector<BadGroup> badGroups;	// Groups that failed verification
+		};
+
+		/**
+		 * Verify the partition's hash tree.
+		 *
+		 * The H3 table is checked against the TMD, and each group
+		 * is checked against the H3 table. Groups are read in large
+		 * batches, and each batch is decrypted and hashed on
+		 * multiple threads.
+		 *
+		 * Only the used part of the partition is checked.
+		 *
+		 * @param result	[out] Verification results.
+		 * @return 0 on success; negative POSIX error code on error.
+		 * (On a read error, result has the groups checked so far.)
+		 */
+		int verifyHashes(HashVerifyResult &result);
+
 	public:
 		/**
 		 * Get the total number of encryption key names.
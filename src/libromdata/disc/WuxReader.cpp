@@ -20,6 +20,7 @@ using LibRpFile::IRpFile;
 
 // C++ STL classes.
 using std::array;
+using std::vector;
 
 namespace LibRomData {
 
@@ -42,6 +43,43 @@ class WuxReaderPrivate : public SparseDiscReaderPrivate {
 		// Data start position.
 		// Starts immediately after the index table.
 		off64_t dataOffset;
+
+	public:
+		/** Shared block cache. **/
+
+		// Physical blocks that are referenced by more than one
+		// logical block, e.g. deduplicated padding and common
+		// partition data. Indexed by physical block index.
+		vector<bool> sharedBlocks;
+
+		/**
+		 * Find the physical blocks that are referenced
+		 * by more than one logical block.
+		 */
+		void findSharedBlocks(void);
+
+		/**
+		 * Get a shared physical block, loading it if necessary.
+		 * @param physBlockIdx Physical block index.
+		 * @return Block data, or nullptr on error.
+		 */
+		const uint8_t *getSharedBlock(uint32_t physBlockIdx);
+
+		// Shared blocks are only cached if the block size
+		// is at most this size, since the maximum block
+		// size is 128 MB.
+		static const unsigned int SHARED_CACHE_MAX_BLOCK_SIZE = 64*1024;
+
+		// Default number of shared blocks to cache.
+		static const unsigned int DEFAULT_SHARED_CACHE_COUNT = 8;
+
+		struct SharedCacheEntry {
+			uint32_t physBlockIdx;	// Physical block index. (~0U if empty)
+			uint32_t lastUsed;	// sharedCacheTick value when last used.
+			ao::uvector<uint8_t> data;
+		};
+		vector<SharedCacheEntry> sharedCache;
+		uint32_t sharedCacheTick;	// LRU counter.
 };
 
 /** WuxReaderPrivate **/
@@ -49,11 +87,85 @@ class WuxReaderPrivate : public SparseDiscReaderPrivate {
 WuxReaderPrivate::WuxReaderPrivate(WuxReader *q)
 	: super(q)
 	, dataOffset(0)
+	, sharedCacheTick(0)
 {
 	// Clear the .wux header struct.
 	memset(&wuxHeader, 0, sizeof(wuxHeader));
 }
 
+/**
+ * Find the physical blocks that are referenced
+ * by more than one logical block.
+ */
+void WuxReaderPrivate::findSharedBlocks(void)
+{
+	// Physical block indexes can't be larger than
+	// the number of logical blocks.
+	const size_t count = idxTbl.size();
+	vector<bool> seen(count);
+	sharedBlocks.assign(count, false);
+
+	for (uint32_t physBlockIdx : idxTbl) {
+		physBlockIdx = le32_to_cpu(physBlockIdx);
+		if (physBlockIdx >= count)
+			continue;
+		if (seen[physBlockIdx]) {
+			sharedBlocks[physBlockIdx] = true;
+		} else {
+			seen[physBlockIdx] = true;
+		}
+	}
+}
+
+/**
+ * Get a shared physical block, loading it if necessary.
+ * @param physBlockIdx Physical block index.
+ * @return Block data, or nullptr on error.
+ */
+const uint8_t *WuxReaderPrivate::getSharedBlock(uint32_t physBlockIdx)
+{
+	assert(!sharedCache.empty());
+
+	// Is the block already cached?
+	// Empty entries have lastUsed == 0, so they're used first.
+	SharedCacheEntry *pLRU = &sharedCache[0];
+	for (SharedCacheEntry &entry : sharedCache) {
+		if (entry.physBlockIdx == physBlockIdx) {
+			// Found the block.
+			entry.lastUsed = ++sharedCacheTick;
+			return entry.data.data();
+		}
+		if (entry.lastUsed < pLRU->lastUsed) {
+			pLRU = &entry;
+		}
+	}
+
+	// Load the block into the least-recently used entry.
+	RP_Q(WuxReader);
+	if (pLRU->data.size() != block_size) {
+		pLRU->data.resize(block_size);
+	}
+	const off64_t physBlockAddr = dataOffset + (static_cast<off64_t>(physBlockIdx) * block_size);
+	const size_t sz_read = q->m_file->pread(physBlockAddr, pLRU->data.data(), block_size);
+	if (sz_read == 0) {
+		// Read error.
+		q->m_lastError = q->m_file->lastError();
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+		pLRU->physBlockIdx = ~0U;
+		pLRU->lastUsed = 0;
+		return nullptr;
+	} else if (sz_read < block_size) {
+		// The last block in the file might be a short read.
+		memset(&pLRU->data[sz_read], 0, block_size - sz_read);
+	}
+
+	pLRU->physBlockIdx = physBlockIdx;
+	pLRU->lastUsed = ++sharedCacheTick;
+	return pLRU->data.data();
+}
+
 /** WuxReader **/
 
 WuxReader::WuxReader(IRpFile *file)
@@ -126,6 +238,16 @@ WuxReader::WuxReader(IRpFile *file)
 	d->dataOffset = sizeof(d->wuxHeader) + (idxTbl_count * sizeof(uint32_t));
 	d->dataOffset = ALIGN_BYTES(d->block_size, d->dataOffset);
 
+	// Consecutive physical blocks are read with a single read.
+	d->coalesceRuns = true;
+
+	// Cache deduplicated blocks, since they're likely to be
+	// read more than once.
+	if (d->block_size <= WuxReaderPrivate::SHARED_CACHE_MAX_BLOCK_SIZE) {
+		d->findSharedBlocks();
+		setSharedBlockCacheCount(WuxReaderPrivate::DEFAULT_SHARED_CACHE_COUNT);
+	}
+
 	// Reset the disc position.
 	d->pos = 0;
 }
@@ -205,4 +327,77 @@ off64_t WuxReader::getPhysBlockAddr(uint32_t blockIdx) const
 	return d->dataOffset + (static_cast<off64_t>(physBlockIdx) * d->block_size);
 }
 
+/**
+ * Read the specified block.
+ *
+ * This can read either a full block or a partial block.
+ * For a full block, set pos = 0 and size = block_size.
+ *
+ * @param blockIdx	[in] Block index.
+ * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
+ * @param ptr		[out] Output data buffer.
+ * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int WuxReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
+{
+	RP_D(WuxReader);
+	if (d->sharedCache.empty() || blockIdx >= d->idxTbl.size()) {
+		// Shared block cache is disabled, or the block index is invalid.
+		return super::readBlock(blockIdx, pos, ptr, size);
+	}
+
+	const uint32_t physBlockIdx = le32_to_cpu(d->idxTbl[blockIdx]);
+	if (physBlockIdx >= d->sharedBlocks.size() || !d->sharedBlocks[physBlockIdx]) {
+		// Not a shared block.
+		return super::readBlock(blockIdx, pos, ptr, size);
+	}
+
+	assert(pos >= 0 && pos < (int)d->block_size);
+	assert(size <= d->block_size);
+	if (pos < 0 || static_cast<off64_t>(pos + size) > static_cast<off64_t>(d->block_size)) {
+		// pos+size is out of range.
+		return -1;
+	}
+
+	const uint8_t *const pData = d->getSharedBlock(physBlockIdx);
+	if (!pData) {
+		// Error loading the block.
+		return -1;
+	}
+	memcpy(ptr, &pData[pos], size);
+	return static_cast<int>(size);
+}
+
+/** WuxReader **/
+
+/**
+ * Set the number of deduplicated blocks to cache.
+ *
+ * Physical blocks that are referenced by more than one logical
+ * block are cached in least-recently used order. The cache is
+ * disabled for block sizes larger than 64 KB.
+ *
+ * NOTE: Changing the count clears the cache.
+ *
+ * @param count Number of blocks to cache. (0 to disable)
+ */
+void WuxReader::setSharedBlockCacheCount(unsigned int count)
+{
+	RP_D(WuxReader);
+	if (d->sharedBlocks.empty()) {
+		// Shared blocks aren't supported with this block size.
+		return;
+	}
+
+	// NOTE: Buffers are allocated on first use.
+	d->sharedCache.clear();
+	d->sharedCache.resize(count);
+	for (WuxReaderPrivate::SharedCacheEntry &entry : d->sharedCache) {
+		entry.physBlockIdx = ~0U;
+		entry.lastUsed = 0;
+	}
+	d->sharedCacheTick = 0;
+}
+
 }
@@ -62,6 +62,37 @@ class WuxReader : public LibRpBase::SparseDiscReader
 		 * @return Physical address. (0 == empty block; -1 == invalid block index)
 		 */
 		off64_t getPhysBlockAddr(uint32_t blockIdx) const final;
+
+		/**
+		 * Read the specified block.
+		 *
+		 * This can read either a full block or a partial block.
+		 * For a full block, set pos = 0 and size = block_size.
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
+		 * @param ptr		[out] Output data buffer.
+		 * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 4, 5)
+		int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size) final;
+
+	public:
+		/** WuxReader-specific functions. **/
+
+		/**
+		 * Set the number of deduplicated blocks to cache.
+		 *
+		 * Physical blocks that are referenced by more than one logical
+		 * block are cached in least-recently used order. The cache is
+		 * disabled for block sizes larger than 64 KB.
+		 *
+		 * NOTE: Changing the count clears the cache.
+		 *
+		 * @param count Number of blocks to cache. (0 to disable)
+		 */
+		void setSharedBlockCacheCount(unsigned int count);
 };
 
 }
@@ -10,13 +10,16 @@
 #include "XDVDFSPartition.hpp"
 #include "xdvdfs_structs.h"
 
+// C includes. (C++ namespace)
+#include <climits>
+
 // librpbase, librpfile
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
 
 // C++ STL classes.
 using std::string;
-using std::unordered_map;
+using std::vector;
 
 namespace LibRomData {
 
@@ -41,28 +44,62 @@ class XDVDFSPartitionPrivate
 		// All fields are byteswapped in the constructor.
 		XDVDFS_Header xdvdfsHeader;
 
-		// Cached directories.
-		// - Key: Directory. ("/" for root)
-		// - Value: Raw directory table from the disc.
-		// NOTE: Directory entries are variable-length, so this
-		// is a byte array, not an ISO_DirEntry array.
-		unordered_map<std::string, ao::uvector<uint8_t> > dirTables;
+		// Directory index.
+		// Each directory's entries are stored contiguously in
+		// idxEntries, sorted using xdvdfs_strcasecmp(), so lookups
+		// are a binary search per path component. All fields are
+		// offsets or indexes, so the index has no internal pointers.
+		struct IdxEntry_t {
+			uint32_t name_offset;	// Filename offset in name_arena. (cp1252, NULL-terminated)
+			uint32_t u8name_offset;	// Filename offset in name_arena. (UTF-8, NULL-terminated)
+			uint32_t start_sector;	// Starting sector
+			uint32_t file_size;	// File size, in bytes
+			int subdir;		// Subdirectory index in idxDirs, or -1 if not loaded.
+			uint8_t attributes;	// Attributes bitfield (See XDVDFS_Attributes_e)
+		};
+		struct IdxDir_t {
+			uint32_t first;		// First entry in idxEntries.
+			uint32_t count;		// Number of entries.
+		};
+		ao::uvector<IdxEntry_t> idxEntries;
+		ao::uvector<IdxDir_t> idxDirs;	// [0] == root
+		ao::uvector<char> name_arena;
+
+		// Number of open directories.
+		int dirCount;
 
 		/**
-		 * Get an entry within a specified directory table.
-		 * @param dirTable Directory table.
-		 * @param filename Filename to find, without subdirectories.
-		 * @return Pointer to XDVDFS_DirEntry within dirTable, or nullptr if not found.
+		 * Load and index a directory table.
+		 * @param dir_addr Directory table address, in bytes.
+		 * @param dir_size Directory table size, in bytes.
+		 * @return Directory index on success; negative POSIX error code on error.
 		 */
-		const XDVDFS_DirEntry *getDirEntry(const ao::uvector<uint8_t> *dirTable, const char *filename);
+		int loadDirectory(off64_t dir_addr, uint32_t dir_size);
+
+		/**
+		 * Find an entry within a loaded directory.
+		 * @param dir_idx Directory index.
+		 * @param filename Filename to find, without subdirectories. (cp1252)
+		 * @return Entry index in idxEntries, or -1 if not found.
+		 */
+		int findEntry(int dir_idx, const char *filename) const;
 
 		/**
 		 * Get the specified directory.
 		 * This should *only* be the directory, not a filename.
-		 * @param path Directory path.
-		 * @return Pointer to directory table (ao::uvector), or nullptr if not found.
+		 * @param path Directory path. (cp1252)
+		 * @param path_len Directory path length.
+		 * @return Directory index on success; negative POSIX error code on error.
 		 */
-		const ao::uvector<uint8_t> *getDirectory(const char *path);
+		int getDirectory(const char *path, size_t path_len);
+
+		/**
+		 * Look up a path.
+		 * @param path Path. (UTF-8)
+		 * @return Entry index in idxEntries on success; negative POSIX error code on error.
+		 * If the path refers to the root directory, INT_MAX is returned.
+		 */
+		int lookup(const char *path);
 
 		/**
 		 * XDVDFS strcasecmp() implementation.
@@ -81,6 +118,7 @@ XDVDFSPartitionPrivate::XDVDFSPartitionPrivate(XDVDFSPartition *q,
 	: q_ptr(q)
 	, partition_offset(partition_offset)
 	, partition_size(partition_size)
+	, dirCount(0)
 {
 	// Clear the XDVDFS header struct.
 	memset(&xdvdfsHeader, 0, sizeof(xdvdfsHeader));
@@ -126,11 +164,13 @@ XDVDFSPartitionPrivate::XDVDFSPartitionPrivate(XDVDFSPartition *q,
 #endif /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
 
 	// Load the root directory.
-	getDirectory("/");
+	getDirectory("", 0);
 }
 
 XDVDFSPartitionPrivate::~XDVDFSPartitionPrivate()
-{ }
+{
+	assert(dirCount == 0);
+}
 
 /**
  * XDVDFS strcasecmp() implementation.
@@ -161,164 +201,260 @@ int XDVDFSPartitionPrivate::xdvdfs_strcasecmp(const char *s1, const char *s2)
 }
 
 /**
- * Get an entry within a specified directory table.
- * @param dirTable Directory table.
- * @param filename Filename to find, without subdirectories.
- * @return Pointer to XDVDFS_DirEntry within dirTable, or nullptr if not found.
+ * Load and index a directory table.
+ * @param dir_addr Directory table address, in bytes.
+ * @param dir_size Directory table size, in bytes.
+ * @return Directory index on success; negative POSIX error code on error.
  */
-const XDVDFS_DirEntry *XDVDFSPartitionPrivate::getDirEntry(const ao::uvector<uint8_t> *dirTable, const char *filename)
+int XDVDFSPartitionPrivate::loadDirectory(off64_t dir_addr, uint32_t dir_size)
 {
-	assert(dirTable != nullptr);
-	assert(filename != nullptr);
-	if (unlikely(!dirTable || !filename)) {
-		RP_Q(XDVDFSPartition);
-		q->m_lastError = EINVAL;
-		return nullptr;
+	RP_Q(XDVDFSPartition);
+
+	// Directory tables should be less than 16 MB.
+	if (dir_size > 16*1024*1024) {
+		// Directory table is too big.
+		q->m_lastError = EIO;
+		return -EIO;
 	}
 
-	// Convert the filename portion to cp1252 before searching.
-	const string s_filename = utf8_to_cp1252(filename, -1);
+	// Read the directory table.
+	ao::uvector<uint8_t> dirTable(dir_size);
+	size_t size = q->m_discReader->seekAndRead(dir_addr, dirTable.data(), dirTable.size());
+	if (size != dirTable.size()) {
+		// Seek and/or read error.
+		q->m_lastError = q->m_discReader->lastError();
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+		return -q->m_lastError;
+	}
 
-	// Find the file in the specified directory.
-	// NOTE: Filenames are case-insensitive.
-	const XDVDFS_DirEntry *dirEntry_found = nullptr;
-	const uint8_t *const p_start = dirTable->data();
-	const uint8_t *const p_end = p_start + dirTable->size();
-	const uint8_t *p = p_start;
-	string s_entry_filename;	// Temporary for NULL termination.
-	while (p < p_end) {
-		const XDVDFS_DirEntry *dirEntry = reinterpret_cast<const XDVDFS_DirEntry*>(p);
-		const char *entry_filename = reinterpret_cast<const char*>(p) + sizeof(*dirEntry);
-		if (entry_filename + dirEntry->name_length > reinterpret_cast<const char*>(p_end)) {
+	// Walk the on-disc AVL tree and add all entries.
+	// NOTE: Each entry is visited at most once, in case the tree is corrupted.
+	const uint32_t first = static_cast<uint32_t>(idxEntries.size());
+	const uint8_t *const p_start = dirTable.data();
+	const uint8_t *const p_end = p_start + dirTable.size();
+	vector<bool> visited(dir_size / sizeof(uint32_t));
+	vector<uint16_t> stack;
+	if (dir_size >= sizeof(XDVDFS_DirEntry)) {
+		stack.push_back(0);
+	}
+	while (!stack.empty()) {
+		const uint16_t offset = stack.back();
+		stack.pop_back();
+		if (offset >= visited.size() || visited[offset]) {
+			// Out of range, or already visited.
+			continue;
+		}
+		visited[offset] = true;
+
+		const uint8_t *const p = p_start + (offset * sizeof(uint32_t));
+		const XDVDFS_DirEntry *const dirEntry = reinterpret_cast<const XDVDFS_DirEntry*>(p);
+		const char *const entry_filename = reinterpret_cast<const char*>(p) + sizeof(*dirEntry);
+		if (p + sizeof(*dirEntry) > p_end ||
+		    entry_filename + dirEntry->name_length > reinterpret_cast<const char*>(p_end))
+		{
 			// Filename is out of bounds.
-			break;
+			continue;
+		}
+		if (dirEntry->name_length == 0 || dirEntry->name_length == 0xFF) {
+			// Empty directory, or padding.
+			continue;
 		}
 
+		// Add the entry.
 		// NOTE: Filename might not be NULL-terminated.
-		// Temporarily cache the filename.
-		s_entry_filename.assign(entry_filename, dirEntry->name_length);
-
-		// Check the filename.
-		// TODO: Use non-locale-specific case-insensitive check? (only letters)
-		uint16_t subtree_offset = 0;
-		int cmp = xdvdfs_strcasecmp(s_filename.c_str(), s_entry_filename.c_str());
-		if (cmp == 0) {
-			// Found it!
-			dirEntry_found = dirEntry;
-			break;
-		} else if (cmp < 0) {
-			// Left subtree.
-			subtree_offset = le16_to_cpu(dirEntry->left_offset);
-		} else if (cmp > 0) {
-			// Right subtree.
-			subtree_offset = le16_to_cpu(dirEntry->right_offset);
+		IdxEntry_t entry;
+		entry.name_offset = static_cast<uint32_t>(name_arena.size());
+		name_arena.insert(name_arena.end(), entry_filename, entry_filename + dirEntry->name_length);
+		name_arena.push_back('\0');
+		const string u8name = cp1252_to_utf8(entry_filename, dirEntry->name_length);
+		entry.u8name_offset = static_cast<uint32_t>(name_arena.size());
+		name_arena.insert(name_arena.end(), u8name.c_str(), u8name.c_str() + u8name.size() + 1);
+		entry.start_sector = le32_to_cpu(dirEntry->start_sector);
+		entry.file_size = le32_to_cpu(dirEntry->file_size);
+		entry.attributes = dirEntry->attributes;
+		entry.subdir = -1;
+		idxEntries.push_back(entry);
+
+		// Subtrees.
+		const uint16_t left_offset = le16_to_cpu(dirEntry->left_offset);
+		const uint16_t right_offset = le16_to_cpu(dirEntry->right_offset);
+		if (left_offset != 0 && left_offset != 0xFFFF) {
+			stack.push_back(left_offset);
 		}
-
-		if (subtree_offset == 0 || subtree_offset == 0xFFFF) {
-			// End of directory.
-			break;
+		if (right_offset != 0 && right_offset != 0xFFFF) {
+			stack.push_back(right_offset);
 		}
-		p = p_start + (subtree_offset * sizeof(uint32_t));
 	}
 
-	if (!dirEntry_found) {
-		// Not found.
-		return nullptr;
-	}
+	// Sort the entries for binary search.
+	const char *const names = name_arena.data();
+	std::sort(idxEntries.begin() + first, idxEntries.end(),
+		[names](const IdxEntry_t &a, const IdxEntry_t &b) {
+			return (xdvdfs_strcasecmp(&names[a.name_offset], &names[b.name_offset]) < 0);
+		});
+
+	IdxDir_t dir;
+	dir.first = first;
+	dir.count = static_cast<uint32_t>(idxEntries.size() - first);
+	idxDirs.push_back(dir);
+	return static_cast<int>(idxDirs.size() - 1);
+}
 
-	// Make sure the file is in bounds.
-	const uint32_t file_size = le32_to_cpu(dirEntry_found->file_size);
-	const off64_t file_addr = static_cast<off64_t>(
-		le32_to_cpu(dirEntry_found->start_sector)) * XDVDFS_BLOCK_SIZE;
-	if (file_addr >= (this->partition_size + this->partition_offset) ||
-	    file_addr > (this->partition_size + this->partition_offset - file_size))
-	{
-		// File is out of bounds.
-		RP_Q(XDVDFSPartition);
-		q->m_lastError = EIO;
-		return nullptr;
+/**
+ * Find an entry within a loaded directory.
+ * @param dir_idx Directory index.
+ * @param filename Filename to find, without subdirectories. (cp1252)
+ * @return Entry index in idxEntries, or -1 if not found.
+ */
+int XDVDFSPartitionPrivate::findEntry(int dir_idx, const char *filename) const
+{
+	assert(dir_idx >= 0 && dir_idx < static_cast<int>(idxDirs.size()));
+	const IdxDir_t &dir = idxDirs[dir_idx];
+	const char *const names = name_arena.data();
+
+	// Binary search.
+	const IdxEntry_t *const p_begin = &idxEntries[dir.first];
+	const IdxEntry_t *const p_end = p_begin + dir.count;
+	const IdxEntry_t *const p = std::lower_bound(p_begin, p_end, filename,
+		[names](const IdxEntry_t &entry, const char *name) {
+			return (xdvdfs_strcasecmp(&names[entry.name_offset], name) < 0);
+		});
+	if (p == p_end || xdvdfs_strcasecmp(&names[p->name_offset], filename) != 0) {
+		// Not found.
+		return -1;
 	}
-
-	// Return the directory entry.
-	return dirEntry_found;
+	return static_cast<int>(p - idxEntries.data());
 }
 
 /**
  * Get the specified directory.
  * This should *only* be the directory, not a filename.
- * @param path Directory path.
- * @return Pointer to directory table (ao::uvector), or nullptr if not found.
+ * @param path Directory path. (cp1252)
+ * @param path_len Directory path length.
+ * @return Directory index on success; negative POSIX error code on error.
  */
-const ao::uvector<uint8_t> *XDVDFSPartitionPrivate::getDirectory(const char *path)
+int XDVDFSPartitionPrivate::getDirectory(const char *path, size_t path_len)
 {
 	RP_Q(XDVDFSPartition);
-	if (unlikely(!path || path[0] != '/')) {
-		// Invalid path.
-		q->m_lastError = EINVAL;
-		return nullptr;
-	} else if (unlikely(xdvdfsHeader.magic[0] == '\0')) {
+	if (unlikely(xdvdfsHeader.magic[0] == '\0')) {
 		// XDVDFS isn't loaded.
 		q->m_lastError = EIO;
-		return nullptr;
+		return -EIO;
 	}
 
-	// TODO: Remove unnecessary leading and trailing slashes.
+	if (idxDirs.empty()) {
+		// Load the root directory.
+		if (unlikely(!q->m_discReader)) {
+			// DiscReader isn't open.
+			q->m_lastError = EIO;
+			return -EIO;
+		}
 
-	// Is this directory table already loaded?
-	auto iter = dirTables.find(path);
-	if (iter != dirTables.end()) {
-		// Directory table is already loaded.
-		return &(iter->second);
+		const off64_t dir_addr = partition_offset + (
+			static_cast<off64_t>(xdvdfsHeader.root_dir_sector) * XDVDFS_BLOCK_SIZE);
+		const int ret = loadDirectory(dir_addr, xdvdfsHeader.root_dir_size);
+		if (ret < 0) {
+			// loadDirectory() has already set m_lastError.
+			return ret;
+		}
 	}
 
-	// DiscReader must be available now.
-	if (unlikely(!q->m_discReader)) {
-		// DiscReader isn't open.
-		q->m_lastError = EIO;
-		return nullptr;
+	// Walk the path, one component at a time.
+	int dir_idx = 0;
+	const char *p = path;
+	const char *const p_end = path + path_len;
+	string component;
+	while (p < p_end) {
+		// Find the end of this component.
+		const char *sl = p;
+		while (sl < p_end && *sl != '/') {
+			sl++;
+		}
+		if (sl == p) {
+			// Empty component.
+			p++;
+			continue;
+		}
+
+		component.assign(p, sl - p);
+		const int entry_idx = findEntry(dir_idx, component.c_str());
+		if (entry_idx < 0) {
+			// Not found.
+			q->m_lastError = ENOENT;
+			return -ENOENT;
+		}
+		if (!(idxEntries[entry_idx].attributes & XDVDFS_ATTR_DIRECTORY)) {
+			// Not a directory.
+			q->m_lastError = ENOTDIR;
+			return -ENOTDIR;
+		}
+
+		int subdir = idxEntries[entry_idx].subdir;
+		if (subdir < 0) {
+			// Load the subdirectory.
+			if (unlikely(!q->m_discReader)) {
+				// DiscReader isn't open.
+				q->m_lastError = EIO;
+				return -EIO;
+			}
+			const off64_t dir_addr = partition_offset + (
+				static_cast<off64_t>(idxEntries[entry_idx].start_sector) * XDVDFS_BLOCK_SIZE);
+			subdir = loadDirectory(dir_addr, idxEntries[entry_idx].file_size);
+			if (subdir < 0) {
+				// loadDirectory() has already set m_lastError.
+				return subdir;
+			}
+			idxEntries[entry_idx].subdir = subdir;
+		}
+
+		dir_idx = subdir;
+		p = sl;
 	}
 
-	// Directory table address and size.
-	off64_t dir_addr = 0;
-	uint32_t dir_size = 0;
+	return dir_idx;
+}
 
-	if (!strcmp(path, "/")) {
-		// Special handling for the root directory.
+/**
+ * Look up a path.
+ * @param path Path. (UTF-8)
+ * @return Entry index in idxEntries on success; negative POSIX error code on error.
+ * If the path refers to the root directory, INT_MAX is returned.
+ */
+int XDVDFSPartitionPrivate::lookup(const char *path)
+{
+	RP_Q(XDVDFSPartition);
 
-		// Root directory size should be less than 16 MB.
-		if (xdvdfsHeader.root_dir_size > 16*1024*1024) {
-			// Root directory is too big.
-			q->m_lastError = EIO;
-			return nullptr;
-		}
+	// Convert the path to cp1252 before searching.
+	string s_path = utf8_to_cp1252(path, -1);
 
-		// Root directory offsets.
-		dir_addr = partition_offset + (
-			static_cast<off64_t>(xdvdfsHeader.root_dir_sector) * XDVDFS_BLOCK_SIZE);
-		dir_size = xdvdfsHeader.root_dir_size;
-	} else {
-		// Get the parent directory.
-		// TODO
-		return nullptr;
+	// Remove trailing slashes.
+	while (!s_path.empty() && s_path[s_path.size()-1] == '/') {
+		s_path.resize(s_path.size()-1);
 	}
 
-	// Read the directory.
-	ao::uvector<uint8_t> dirTable(dir_size);
-	size_t size = q->m_discReader->seekAndRead(dir_addr, dirTable.data(), dirTable.size());
-	if (size != dirTable.size()) {
-		// Seek and/or read error.
-		q->m_lastError = q->m_discReader->lastError();
-		if (q->m_lastError == 0) {
-			q->m_lastError = EIO;
-		}
-		return nullptr;
+	const size_t sl = s_path.rfind('/');
+	const size_t name_pos = (sl != string::npos ? sl + 1 : 0);
+	if (name_pos >= s_path.size()) {
+		// Root directory.
+		const int ret = getDirectory("", 0);
+		return (ret < 0 ? ret : INT_MAX);
 	}
 
-	// Save the directory table for later.
-	auto ins_iter = dirTables.insert(std::make_pair(path, std::move(dirTable)));
+	const int dir_idx = getDirectory(s_path.c_str(), name_pos);
+	if (dir_idx < 0) {
+		// getDirectory() has already set m_lastError.
+		return dir_idx;
+	}
 
-	// Root directory loaded.
-	return &(ins_iter.first->second);
+	const int entry_idx = findEntry(dir_idx, &s_path[name_pos]);
+	if (entry_idx < 0) {
+		// Not found.
+		q->m_lastError = ENOENT;
+		return -ENOENT;
+	}
+	return entry_idx;
 }
 
 /** XDVDFSPartition **/
@@ -456,9 +592,6 @@ off64_t XDVDFSPartition::partition_size_used(void) const
 
 /** IFst wrapper functions. **/
 
-// TODO
-
-#if 0
 /**
  * Open a directory.
  * @param path	[in] Directory path.
@@ -467,51 +600,97 @@ off64_t XDVDFSPartition::partition_size_used(void) const
 IFst::Dir *XDVDFSPartition::opendir(const char *path)
 {
 	RP_D(XDVDFSPartition);
-	if (!d->fst) {
-		// FST isn't loaded.
-		if (d->loadFst() != 0) {
-			// FST load failed.
-			// TODO: Errors?
+	if (!path || path[0] != '/') {
+		// Only absolute paths are supported.
+		m_lastError = EINVAL;
+		return nullptr;
+	}
+
+	int dir_idx;
+	const int entry_idx = d->lookup(path);
+	if (entry_idx < 0) {
+		// Directory not found.
+		// lookup() has already set m_lastError.
+		return nullptr;
+	} else if (entry_idx == INT_MAX) {
+		// Root directory.
+		dir_idx = 0;
+	} else {
+		// Load the subdirectory.
+		// NOTE: getDirectory() takes a cp1252 path.
+		const string s_path = utf8_to_cp1252(path, -1);
+		dir_idx = d->getDirectory(s_path.c_str(), s_path.size());
+		if (dir_idx < 0) {
+			// getDirectory() has already set m_lastError.
 			return nullptr;
 		}
 	}
 
-	return d->fst->opendir(path);
+	IFst::Dir *const dirp = new IFst::Dir;
+	d->dirCount++;
+	dirp->parent = nullptr;
+	dirp->dir_idx = dir_idx;
+
+	// readdir() will return the first entry.
+	dirp->entry.idx = -1;
+	dirp->entry.offset = 0;
+	dirp->entry.size = 0;
+	dirp->entry.name = nullptr;
+	dirp->entry.type = DT_UNKNOWN;
+	return dirp;
 }
 
 /**
  * Read a directory entry.
- * @param dirp FstDir pointer.
+ * Entries are returned in case-insensitive sorted order.
+ * @param dirp IFst::Dir pointer.
  * @return IFst::DirEnt*, or nullptr if end of directory or on error.
  * (TODO: Add lastError()?)
  */
 IFst::DirEnt *XDVDFSPartition::readdir(IFst::Dir *dirp)
 {
 	RP_D(XDVDFSPartition);
-	if (!d->fst) {
-		// TODO: Errors?
+	assert(dirp != nullptr);
+	if (!dirp || dirp->dir_idx < 0 || dirp->dir_idx >= static_cast<int>(d->idxDirs.size())) {
+		// No directory specified.
+		return nullptr;
+	}
+
+	const XDVDFSPartitionPrivate::IdxDir_t &dir = d->idxDirs[dirp->dir_idx];
+	const int idx = dirp->entry.idx + 1;
+	if (idx >= static_cast<int>(dir.count)) {
+		// End of directory.
 		return nullptr;
 	}
 
-	return d->fst->readdir(dirp);
+	const XDVDFSPartitionPrivate::IdxEntry_t &entry = d->idxEntries[dir.first + idx];
+	dirp->entry.idx = idx;
+	dirp->entry.offset = static_cast<off64_t>(entry.start_sector) * XDVDFS_BLOCK_SIZE;
+	dirp->entry.size = entry.file_size;
+	dirp->entry.name = &d->name_arena[entry.u8name_offset];
+	dirp->entry.type = (entry.attributes & XDVDFS_ATTR_DIRECTORY) ? DT_DIR : DT_REG;
+	return &dirp->entry;
 }
 
 /**
  * Close an opened directory.
- * @param dirp FstDir pointer.
+ * @param dirp IFst::Dir pointer.
  * @return 0 on success; negative POSIX error code on error.
  */
 int XDVDFSPartition::closedir(IFst::Dir *dirp)
 {
 	RP_D(XDVDFSPartition);
-	if (!d->fst) {
-		// TODO: Errors?
-		return -EBADF;
+	assert(dirp != nullptr);
+	if (!dirp) {
+		// No directory specified.
+		return -EINVAL;
 	}
 
-	return d->fst->closedir(dirp);
+	assert(d->dirCount > 0);
+	delete dirp;
+	d->dirCount--;
+	return 0;
 }
-#endif
 
 /**
  * Open a file. (read-only)
@@ -522,61 +701,72 @@ IRpFile *XDVDFSPartition::open(const char *filename)
 {
 	// TODO: File reference counter.
 	// This might be difficult to do because PartitionFile is a separate class.
+	off64_t file_addr, file_size;
+	int ret = findFileExtent(filename, &file_addr, &file_size);
+	if (ret != 0) {
+		m_lastError = -ret;
+		return nullptr;
+	}
 
-	// TODO: Support subdirectories.
+	// Create the PartitionFile.
+	// This is an IRpFile implementation that uses an
+	// IPartition as the reader and takes an offset
+	// and size as the file parameters.
+	return new PartitionFile(this, file_addr, file_size);
+}
+
+/** Bulk extraction **/
 
+/**
+ * Find a file's extent within the partition.
+ * The offset is the same one PartitionFile uses.
+ * @param filename	[in] Filename.
+ * @param pOffset	[out] Partition offset.
+ * @param pSize		[out] File size.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int XDVDFSPartition::findFileExtent(const char *filename, off64_t *pOffset, off64_t *pSize)
+{
 	// Filename must be valid, and must start with a slash.
 	// Only absolute paths are supported.
 	if (!filename || filename[0] != '/') {
 		// No filename and/or does not start with a slash.
 		// TODO: Prepend a slash like GcnFst, or remove slash prepending from GcnFst?
-		m_lastError = EINVAL;
-		return nullptr;
-	}
-
-	// Remove leading slashes.
-	while (*filename == '/') {
-		filename++;
-	}
-	if (filename[0] == 0) {
-		// Nothing but slashes...
-		return nullptr;
+		return -EINVAL;
 	}
 
-	// TODO: Handle subdirectories.
-	// For now, assuming the file is in the root directory.
 	RP_D(XDVDFSPartition);
-	const ao::uvector<uint8_t> *const dirTable = d->getDirectory("/");
-	if (!dirTable) {
-		// Directory not found.
-		// getDirectory() has already set m_lastError.
-		return nullptr;
-	}
-
-	// Find the file in the root directory.
-	const XDVDFS_DirEntry *const dirEntry = d->getDirEntry(dirTable, filename);
-	if (!dirEntry) {
+	const int entry_idx = d->lookup(filename);
+	if (entry_idx < 0) {
 		// File not found.
-		// getDirEntry() has already set m_lastError.
-		return nullptr;
+		// lookup() has already set m_lastError.
+		return (m_lastError != 0 ? -m_lastError : -ENOENT);
+	} else if (entry_idx == INT_MAX) {
+		// Root directory.
+		return -EISDIR;
 	}
+	const XDVDFSPartitionPrivate::IdxEntry_t &entry = d->idxEntries[entry_idx];
 
 	// Make sure this is a regular file.
 	// TODO: Check for XDVDFS_ATTR_NORMAL?
-	if (dirEntry->attributes & XDVDFS_ATTR_DIRECTORY) {
+	if (entry.attributes & XDVDFS_ATTR_DIRECTORY) {
 		// Not a regular file.
-		m_lastError = EISDIR;
-		return nullptr;
+		return -EISDIR;
 	}
 
-	const uint32_t file_size = le32_to_cpu(dirEntry->file_size);
-	const off64_t file_addr = static_cast<off64_t>(le32_to_cpu(dirEntry->start_sector)) * XDVDFS_BLOCK_SIZE;
+	// Make sure the file is in bounds.
+	const uint32_t file_size = entry.file_size;
+	const off64_t file_addr = static_cast<off64_t>(entry.start_sector) * XDVDFS_BLOCK_SIZE;
+	if (file_addr >= (d->partition_size + d->partition_offset) ||
+	    file_addr > (d->partition_size + d->partition_offset - file_size))
+	{
+		// File is out of bounds.
+		return -EIO;
+	}
 
-	// Create the PartitionFile.
-	// This is an IRpFile implementation that uses an
-	// IPartition as the reader and takes an offset
-	// and size as the file parameters.
-	return new PartitionFile(this, file_addr, file_size);
+	*pOffset = file_addr;
+	*pSize = file_size;
+	return 0;
 }
 
 /** XDVDFSPartition **/
@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBROMDATA_DISC_XDVDFSPARTITION_HPP__
 
 #include "librpbase/disc/IPartition.hpp"
+#include "librpbase/disc/IFst.hpp"
 
 // C includes. (C++ namespace)
 #include <ctime>
@@ -96,8 +97,6 @@ class XDVDFSPartition : public LibRpBase::IPartition
 	public:
 		/** IFst wrapper functions. **/
 
-		// TODO
-#if 0
 		/**
 		 * Open a directory.
 		 * @param path	[in] Directory path.
@@ -129,7 +128,6 @@ class XDVDFSPartition : public LibRpBase::IPartition
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		int closedir(LibRpBase::IFst::Dir *dirp);
-#endif
 
 		/**
 		 * Open a file. (read-only)
@@ -138,6 +136,19 @@ class XDVDFSPartition : public LibRpBase::IPartition
 		 */
 		LibRpFile::IRpFile *open(const char *filename);
 
+	public:
+		/** Bulk extraction **/
+
+		/**
+		 * Find a file's extent within the partition.
+		 * The offset is the same one PartitionFile uses.
+		 * @param filename	[in] Filename.
+		 * @param pOffset	[out] Partition offset.
+		 * @param pSize		[out] File size.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int findFileExtent(const char *filename, off64_t *pOffset, off64_t *pSize) override;
+
 	public:
 		/** XDVDFSPartition **/
 
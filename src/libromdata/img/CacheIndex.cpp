@@ -0,0 +1,672 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * CacheIndex.cpp: Access index and size limit for the download cache.     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "CacheIndex.hpp"
+#include "NegativeCache.hpp"
+
+// librpfile, librpthreads
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpFile.hpp"
+#include "librpthreads/Mutex.hpp"
+using namespace LibRpFile;
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
+// libcachecommon
+#include "libcachecommon/CacheDir.hpp"
+#include "libcachecommon/CacheKeys.hpp"
+
+// OS-specific includes.
+#ifdef _WIN32
+# include "libwin32common/RpWin32_sdk.h"
+#else /* !_WIN32 */
+# include <pthread.h>
+# include <sched.h>
+#endif /* _WIN32 */
+
+// C++ STL classes.
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+namespace LibRomData {
+
+/**
+ * Cache index file format:
+ * - CacheIndexHeader
+ * - Array of CacheIndexRecord, each followed by
+ *   the filename relative to the cache directory.
+ *
+ * New records are appended to the end of the file.
+ * If a filename is present more than once, the last
+ * record is used. The file is rewritten with only
+ * the live entries when files are pruned, or if it
+ * has too many outdated records.
+ *
+ * All values are little-endian.
+ */
+static const uint32_t CACHEINDEX_MAGIC = 'RPCI';
+static const uint32_t CACHEINDEX_VERSION = 1;
+
+struct CacheIndexHeader {
+	uint32_t magic;		// [0x000] 'RPCI'
+	uint32_t version;	// [0x004] Format version.
+};
+ASSERT_STRUCT(CacheIndexHeader, 8);
+
+struct CacheIndexRecord {
+	int64_t atime;		// [0x000] Last access time.
+	int64_t size;		// [0x008] File size, or -1 if the file was removed.
+	uint16_t name_len;	// [0x010] Filename length, in bytes. (not NULL-terminated)
+	uint16_t reserved[3];	// [0x012]
+};
+ASSERT_STRUCT(CacheIndexRecord, 24);
+
+// Cache index filename. (in the cache directory)
+static const char CACHEINDEX_FILENAME[] = "index.bin";
+
+// Maximum filename length in a record.
+static const uint16_t CACHEINDEX_MAX_NAME_LEN = 1024;
+
+// How often to check if another process updated the file, in seconds.
+static const time_t CACHEINDEX_RECHECK_TIME = 60;
+
+// Access times are only updated in the file if they're at least
+// this old, so repeatedly viewing the same files doesn't keep
+// appending records.
+static const time_t CACHEINDEX_ATIME_RESOLUTION = 3600;
+
+// Compact the file if it has at least this many outdated records.
+static const size_t CACHEINDEX_COMPACT_THRESHOLD = 4096;
+
+// Maximum file size. (64 MB)
+static const off64_t CACHEINDEX_MAX_SIZE = 64*1024*1024;
+
+// Minimum time between background prunes, in seconds.
+static const time_t CACHEINDEX_PRUNE_INTERVAL = 300;
+
+/**
+ * Cache index entry.
+ */
+struct IndexEntry {
+	time_t atime;	// Last access time.
+	off64_t size;	// File size.
+};
+
+/**
+ * Cache index state.
+ * Shared by all threads in the process.
+ */
+static struct {
+	Mutex mutex;
+
+	// Live entries. (key is relative to the cache directory)
+	unordered_map<string, IndexEntry> entries;
+	off64_t totalSize;
+
+	// Cache directory, with a trailing separator.
+	string cache_dir;
+	// Cache index filename.
+	string filename;
+
+	// File size and mtime when the file was last loaded.
+	off64_t fileSize;
+	time_t fileMtime;
+
+	// Number of outdated records in the file.
+	size_t deadRecords;
+
+	// Last time the file was checked for changes.
+	time_t lastCheck;
+	bool loaded;
+
+	// Background pruning.
+	time_t lastPrune;
+	bool pruning;
+} cacheIndex;
+
+/**
+ * Serialize a record.
+ * @param buf		[out] Output buffer.
+ * @param name		[in] Filename, relative to the cache directory.
+ * @param atime		[in] Last access time.
+ * @param size		[in] File size, or -1 if the file was removed.
+ */
+static void appendRecord(vector<uint8_t> &buf, const string &name, time_t atime, off64_t size)
+{
+	CacheIndexRecord record;
+	record.atime = cpu_to_le64(static_cast<uint64_t>(atime));
+	record.size = cpu_to_le64(static_cast<uint64_t>(size));
+	record.name_len = cpu_to_le16(static_cast<uint16_t>(name.size()));
+	memset(record.reserved, 0, sizeof(record.reserved));
+
+	const size_t pos = buf.size();
+	buf.resize(pos + sizeof(record) + name.size());
+	memcpy(&buf[pos], &record, sizeof(record));
+	memcpy(&buf[pos + sizeof(record)], name.data(), name.size());
+}
+
+/**
+ * Rewrite the cache index file using only the live entries.
+ * cacheIndex.mutex must be locked by the caller.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int compactCacheIndex(void)
+{
+	vector<uint8_t> buf;
+	buf.reserve(sizeof(CacheIndexHeader) + (cacheIndex.entries.size() * (sizeof(CacheIndexRecord) + 64)));
+	buf.resize(sizeof(CacheIndexHeader));
+	CacheIndexHeader header;
+	header.magic = cpu_to_le32(CACHEINDEX_MAGIC);
+	header.version = cpu_to_le32(CACHEINDEX_VERSION);
+	memcpy(buf.data(), &header, sizeof(header));
+	for (const auto &entry : cacheIndex.entries) {
+		appendRecord(buf, entry.first, entry.second.atime, entry.second.size);
+	}
+
+	// Write to a temporary file first so other processes
+	// never see a partially-written file.
+	const string tmp_filename = cacheIndex.filename + ".tmp";
+	RpFile *const file = new RpFile(tmp_filename, RpFile::FM_CREATE_WRITE);
+	if (!file->isOpen()) {
+		int ret = -file->lastError();
+		file->unref();
+		return (ret != 0 ? ret : -EIO);
+	}
+	const size_t size = file->write(buf.data(), buf.size());
+	file->unref();
+	if (size != buf.size()) {
+		FileSystem::delete_file(tmp_filename);
+		return -EIO;
+	}
+
+#ifdef _WIN32
+	// rename() fails on Windows if the target file exists.
+	FileSystem::delete_file(cacheIndex.filename);
+#endif /* _WIN32 */
+	if (rename(tmp_filename.c_str(), cacheIndex.filename.c_str()) != 0) {
+		int ret = -errno;
+		FileSystem::delete_file(tmp_filename);
+		return (ret != 0 ? ret : -EIO);
+	}
+
+	cacheIndex.deadRecords = 0;
+	FileSystem::get_file_size_and_mtime(cacheIndex.filename, &cacheIndex.fileSize, &cacheIndex.fileMtime);
+	return 0;
+}
+
+/**
+ * Load the cache index file.
+ * cacheIndex.mutex must be locked by the caller.
+ */
+static void loadCacheIndex(void)
+{
+	cacheIndex.entries.clear();
+	cacheIndex.totalSize = 0;
+	cacheIndex.fileSize = 0;
+	cacheIndex.fileMtime = 0;
+	cacheIndex.deadRecords = 0;
+
+	if (cacheIndex.filename.empty()) {
+		const string &cache_dir = LibCacheCommon::getCacheDirectory();
+		if (cache_dir.empty()) {
+			// No cache directory.
+			return;
+		}
+		cacheIndex.cache_dir = cache_dir;
+		if (cacheIndex.cache_dir.at(cacheIndex.cache_dir.size()-1) != DIR_SEP_CHR) {
+			cacheIndex.cache_dir += DIR_SEP_CHR;
+		}
+		cacheIndex.filename = cacheIndex.cache_dir;
+		cacheIndex.filename += CACHEINDEX_FILENAME;
+	}
+
+	RpFile *const file = new RpFile(cacheIndex.filename, RpFile::FM_OPEN_READ);
+	if (!file->isOpen()) {
+		// No cache index yet.
+		file->unref();
+		return;
+	}
+
+	const off64_t fileSize = file->size();
+	if (fileSize < static_cast<off64_t>(sizeof(CacheIndexHeader)) || fileSize > CACHEINDEX_MAX_SIZE) {
+		// Invalid file size.
+		file->unref();
+		return;
+	}
+
+	vector<uint8_t> buf(static_cast<size_t>(fileSize));
+	const size_t size = file->read(buf.data(), buf.size());
+	file->unref();
+	if (size != buf.size()) {
+		// Read error.
+		return;
+	}
+
+	CacheIndexHeader header;
+	memcpy(&header, buf.data(), sizeof(header));
+	if (header.magic != cpu_to_le32(CACHEINDEX_MAGIC) ||
+	    header.version != cpu_to_le32(CACHEINDEX_VERSION))
+	{
+		// Incorrect magic number or version.
+		return;
+	}
+
+	// NOTE: A partially-written record at the end of the
+	// file from an interrupted append is ignored.
+	size_t records = 0;
+	size_t pos = sizeof(CacheIndexHeader);
+	string name;
+	while (pos + sizeof(CacheIndexRecord) <= buf.size()) {
+		CacheIndexRecord record;
+		memcpy(&record, &buf[pos], sizeof(record));
+		const uint16_t name_len = le16_to_cpu(record.name_len);
+		if (name_len == 0 || name_len > CACHEINDEX_MAX_NAME_LEN ||
+		    pos + sizeof(record) + name_len > buf.size())
+		{
+			// Invalid or truncated record.
+			break;
+		}
+		name.assign(reinterpret_cast<const char*>(&buf[pos + sizeof(record)]), name_len);
+		pos += sizeof(record) + name_len;
+		records++;
+
+		const off64_t fsize = static_cast<off64_t>(le64_to_cpu(record.size));
+		if (fsize < 0) {
+			// File was removed.
+			cacheIndex.entries.erase(name);
+			continue;
+		}
+
+		IndexEntry &entry = cacheIndex.entries[name];
+		entry.atime = static_cast<time_t>(le64_to_cpu(record.atime));
+		entry.size = fsize;
+	}
+
+	for (const auto &entry : cacheIndex.entries) {
+		cacheIndex.totalSize += entry.second.size;
+	}
+	cacheIndex.deadRecords = records - cacheIndex.entries.size();
+
+	FileSystem::get_file_size_and_mtime(cacheIndex.filename, &cacheIndex.fileSize, &cacheIndex.fileMtime);
+
+	if (cacheIndex.deadRecords >= CACHEINDEX_COMPACT_THRESHOLD) {
+		// Too many outdated records.
+		compactCacheIndex();
+	}
+}
+
+/**
+ * Make sure the cache index is up to date.
+ * cacheIndex.mutex must be locked by the caller.
+ * @param now Current time.
+ */
+static void updateCacheIndex(time_t now)
+{
+	if (!cacheIndex.loaded) {
+		cacheIndex.loaded = true;
+		cacheIndex.lastCheck = now;
+		loadCacheIndex();
+		return;
+	}
+
+	if (now - cacheIndex.lastCheck < CACHEINDEX_RECHECK_TIME && now >= cacheIndex.lastCheck) {
+		// Checked recently.
+		return;
+	}
+	cacheIndex.lastCheck = now;
+
+	// Reload the file if another process changed it.
+	off64_t fileSize = 0;
+	time_t fileMtime = 0;
+	FileSystem::get_file_size_and_mtime(cacheIndex.filename, &fileSize, &fileMtime);
+	if (fileSize != cacheIndex.fileSize || fileMtime != cacheIndex.fileMtime) {
+		loadCacheIndex();
+	}
+}
+
+/**
+ * Append records to the cache index file.
+ * cacheIndex.mutex must be locked by the caller.
+ * @param buf Serialized records.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int writeRecords(const vector<uint8_t> &buf)
+{
+	int ret = 0;
+	RpFile *file = new RpFile(cacheIndex.filename, RpFile::FM_OPEN_WRITE);
+	if (!file->isOpen()) {
+		// Create a new file.
+		file->unref();
+		ret = FileSystem::rmkdir(cacheIndex.filename);
+		if (ret != 0) {
+			return ret;
+		}
+		file = new RpFile(cacheIndex.filename, RpFile::FM_CREATE_WRITE);
+		if (!file->isOpen()) {
+			ret = -file->lastError();
+			file->unref();
+			return (ret != 0 ? ret : -EIO);
+		}
+
+		CacheIndexHeader header;
+		header.magic = cpu_to_le32(CACHEINDEX_MAGIC);
+		header.version = cpu_to_le32(CACHEINDEX_VERSION);
+		if (file->write(&header, sizeof(header)) != sizeof(header)) {
+			file->unref();
+			FileSystem::delete_file(cacheIndex.filename);
+			return -EIO;
+		}
+	}
+
+	const off64_t pos = file->size();
+	if (pos >= CACHEINDEX_MAX_SIZE) {
+		// File is too big.
+		file->unref();
+		return -EFBIG;
+	}
+
+	// NOTE: Each record is written with a single write() so
+	// appends from other processes aren't interleaved with it.
+	// If another process appends at the same time, one of the
+	// records may be lost; the file is then re-added to the
+	// index the next time it's accessed.
+	file->seek(pos);
+	if (file->write(buf.data(), buf.size()) != buf.size()) {
+		ret = -file->lastError();
+		if (ret == 0) {
+			ret = -EIO;
+		}
+	}
+	file->unref();
+
+	// Our own changes don't need to be reloaded.
+	FileSystem::get_file_size_and_mtime(cacheIndex.filename, &cacheIndex.fileSize, &cacheIndex.fileMtime);
+	return ret;
+}
+
+/**
+ * Background pruning thread.
+ * @param param Unused.
+ * @return 0
+ */
+#ifdef _WIN32
+static DWORD WINAPI pruneThread(LPVOID param)
+#else /* !_WIN32 */
+static void *pruneThread(void *param)
+#endif /* _WIN32 */
+{
+	RP_UNUSED(param);
+
+	// Pruning is I/O-bound and not time-critical, so make
+	// sure it doesn't compete with thumbnailing.
+#ifdef _WIN32
+	SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#elif defined(SCHED_IDLE)
+	struct sched_param sp;
+	sp.sched_priority = 0;
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &sp);
+#endif
+
+	CacheIndex::prune(CacheIndex::DEFAULT_MAX_SIZE, CacheIndex::DEFAULT_MAX_FILES);
+
+	MutexLocker locker(cacheIndex.mutex);
+	cacheIndex.pruning = false;
+	return 0;
+}
+
+/**
+ * Start the background pruning thread if it isn't already running.
+ * cacheIndex.mutex must be locked by the caller.
+ * @param now Current time.
+ */
+static void startPruneThread(time_t now)
+{
+	if (cacheIndex.pruning ||
+	    (now - cacheIndex.lastPrune < CACHEINDEX_PRUNE_INTERVAL && now >= cacheIndex.lastPrune))
+	{
+		// Already pruning, or pruned recently.
+		return;
+	}
+	cacheIndex.lastPrune = now;
+
+	// NOTE: The thread is detached.
+#ifdef _WIN32
+	HANDLE hThread = CreateThread(nullptr, 0, pruneThread, nullptr, 0, nullptr);
+	if (hThread) {
+		cacheIndex.pruning = true;
+		CloseHandle(hThread);
+	}
+#else /* !_WIN32 */
+	pthread_t thread;
+	if (pthread_create(&thread, nullptr, pruneThread, nullptr) == 0) {
+		cacheIndex.pruning = true;
+		pthread_detach(thread);
+	}
+#endif /* _WIN32 */
+}
+
+/**
+ * Record an access to a file in the cache.
+ *
+ * If the cache exceeds its limits, least-recently-used
+ * files are removed by a low-priority background thread.
+ *
+ * Files that aren't in the user's cache directory,
+ * e.g. the system-wide cache, are ignored.
+ *
+ * @param cache_filename Absolute path to the cached file.
+ * @param size File size, or -1 if not known.
+ */
+void CacheIndex::touch(const string &cache_filename, off64_t size)
+{
+	const time_t now = time(nullptr);
+
+	MutexLocker locker(cacheIndex.mutex);
+	updateCacheIndex(now);
+	if (cacheIndex.filename.empty() ||
+	    cache_filename.size() <= cacheIndex.cache_dir.size() ||
+	    cache_filename.compare(0, cacheIndex.cache_dir.size(), cacheIndex.cache_dir) != 0)
+	{
+		// No cache directory, or the file isn't in the cache directory.
+		return;
+	}
+
+	const string name = cache_filename.substr(cacheIndex.cache_dir.size());
+	if (name.size() > CACHEINDEX_MAX_NAME_LEN) {
+		// Filename is too long.
+		return;
+	}
+
+	auto iter = cacheIndex.entries.find(name);
+	if (iter != cacheIndex.entries.end()) {
+		IndexEntry &entry = iter->second;
+		if (size < 0) {
+			size = entry.size;
+		}
+		if (entry.size == size && (now - entry.atime) < CACHEINDEX_ATIME_RESOLUTION && now >= entry.atime) {
+			// Accessed recently. Don't update the file.
+			return;
+		}
+		cacheIndex.totalSize += size - entry.size;
+		cacheIndex.deadRecords++;
+		entry.atime = now;
+		entry.size = size;
+	} else {
+		if (size < 0) {
+			// Get the file size.
+			time_t mtime;
+			if (FileSystem::get_file_size_and_mtime(cache_filename, &size, &mtime) != 0) {
+				// File doesn't exist.
+				return;
+			}
+		}
+		IndexEntry &entry = cacheIndex.entries[name];
+		entry.atime = now;
+		entry.size = size;
+		cacheIndex.totalSize += size;
+	}
+
+	vector<uint8_t> buf;
+	appendRecord(buf, name, now, size);
+	writeRecords(buf);
+	if (cacheIndex.deadRecords >= CACHEINDEX_COMPACT_THRESHOLD) {
+		// Too many outdated records.
+		compactCacheIndex();
+	}
+
+	if (cacheIndex.totalSize > DEFAULT_MAX_SIZE || cacheIndex.entries.size() > DEFAULT_MAX_FILES) {
+		// Cache is too big.
+		startPruneThread(now);
+	}
+}
+
+typedef std::pair<const string, IndexEntry> IndexPair;
+
+/**
+ * Compare two entries by access time.
+ */
+static inline bool entryAtimeLess(const IndexPair *a, const IndexPair *b)
+{
+	return a->second.atime < b->second.atime;
+}
+
+/**
+ * Remove files from the content store that are no longer
+ * linked to any cache files.
+ * @param cache_dir Cache directory, with a trailing separator.
+ * @return Number of files removed.
+ */
+static int pruneContentStore(const string &cache_dir)
+{
+	const string store_dir = cache_dir + CONTENT_STORE_DIR;
+	vector<string> vEntries, vSubdirs;
+	if (FileSystem::read_dir(store_dir, vEntries, &vSubdirs) != 0) {
+		// No content store.
+		return 0;
+	}
+
+	int count = 0;
+	string subdir, filename;
+	for (const string &name : vSubdirs) {
+		subdir = store_dir;
+		subdir += DIR_SEP_CHR;
+		subdir += name;
+		subdir += DIR_SEP_CHR;
+
+		vEntries.clear();
+		if (FileSystem::read_dir(subdir, vEntries) != 0) {
+			continue;
+		}
+		for (const string &entry : vEntries) {
+			// If the content store has the only link to the file,
+			// none of the cache files are using it.
+			filename = subdir;
+			filename += entry;
+			if (FileSystem::get_link_count(filename) == 1 &&
+			    FileSystem::delete_file(filename) == 0)
+			{
+				count++;
+			}
+		}
+	}
+	return count;
+}
+
+/**
+ * Remove least-recently-used files from the cache
+ * until it's below the specified limits.
+ *
+ * Expired "not found" marker files are also removed, along with
+ * content store files that are no longer linked to any cache files.
+ *
+ * @param maxSize Maximum total size of the cached files, in bytes.
+ * @param maxFiles Maximum number of cached files.
+ * @return Number of files removed, or negative POSIX error code on error.
+ */
+int CacheIndex::prune(off64_t maxSize, unsigned int maxFiles)
+{
+	const time_t now = time(nullptr);
+	vector<string> victims;
+
+	{
+		MutexLocker locker(cacheIndex.mutex);
+		updateCacheIndex(now);
+		if (cacheIndex.filename.empty()) {
+			// No cache directory.
+			return -ENOENT;
+		}
+
+		// Prune down to 7/8 of the limits so this doesn't
+		// have to run again as soon as another file is added.
+		const off64_t targetSize = maxSize - (maxSize / 8);
+		const size_t targetFiles = maxFiles - (maxFiles / 8);
+
+		// Sort the entries by access time, oldest first.
+		vector<const IndexPair*> lru;
+		lru.reserve(cacheIndex.entries.size());
+		for (const IndexPair &entry : cacheIndex.entries) {
+			lru.push_back(&entry);
+		}
+		std::sort(lru.begin(), lru.end(), entryAtimeLess);
+
+		off64_t totalSize = cacheIndex.totalSize;
+		size_t totalFiles = cacheIndex.entries.size();
+		const bool overLimit = (totalSize > maxSize || totalFiles > maxFiles);
+		for (const IndexPair *p : lru) {
+			const IndexEntry &entry = p->second;
+			const bool expiredMarker = (entry.size == 0 &&
+				(now - entry.atime) >= NegativeCache::EXPIRE_TIME);
+			if (!expiredMarker &&
+			    (!overLimit || (totalSize <= targetSize && totalFiles <= targetFiles)))
+			{
+				// Cache is within the limits.
+				continue;
+			}
+			totalSize -= entry.size;
+			totalFiles--;
+			victims.push_back(p->first);
+		}
+
+		if (victims.empty()) {
+			// Nothing to remove.
+			return 0;
+		}
+
+		// Remove the entries from the index.
+		for (const string &name : victims) {
+			cacheIndex.entries.erase(name);
+		}
+		cacheIndex.totalSize = totalSize;
+		int ret = compactCacheIndex();
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	// Delete the files.
+	// NOTE: This is done without holding the mutex, since
+	// it may take a while for large caches.
+	int count = 0;
+	string filename;
+	for (const string &name : victims) {
+		filename = cacheIndex.cache_dir;
+		filename += name;
+		if (FileSystem::delete_file(filename) == 0) {
+			count++;
+		}
+	}
+
+	// Some of the deleted files may have been the last
+	// cache files using files in the content store.
+	count += pruneContentStore(cacheIndex.cache_dir);
+	return count;
+}
+
+}
@@ -0,0 +1,83 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * CacheIndex.hpp: Access index and size limit for the download cache.     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_IMG_CACHEINDEX_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_IMG_CACHEINDEX_HPP__
+
+#include "common.h"
+
+// C++ includes.
+#include <string>
+
+namespace LibRomData {
+
+/**
+ * Download cache index.
+ *
+ * Keeps track of the size and last access time of each file
+ * in the user's cache directory, so the least-recently-used
+ * files can be removed once the cache exceeds its size limit
+ * without having to scan the cache directory.
+ *
+ * The index is stored in a single file in the cache directory.
+ * Files are added to the index when they're downloaded or
+ * accessed, so files that were cached before the index existed
+ * are tracked once they're used again.
+ */
+class CacheIndex
+{
+	private:
+		CacheIndex();
+		~CacheIndex();
+	private:
+		RP_DISABLE_COPY(CacheIndex)
+
+	public:
+		/**
+		 * Default maximum total size of the cached files, in bytes.
+		 * TODO: Configurable size.
+		 */
+		static const off64_t DEFAULT_MAX_SIZE = 256LL*1024*1024;
+
+		/**
+		 * Default maximum number of cached files.
+		 * This includes zero-byte "not found" marker files.
+		 */
+		static const unsigned int DEFAULT_MAX_FILES = 32768;
+
+		/**
+		 * Record an access to a file in the cache.
+		 *
+		 * If the cache exceeds its limits, least-recently-used
+		 * files are removed by a low-priority background thread.
+		 *
+		 * Files that aren't in the user's cache directory,
+		 * e.g. the system-wide cache, are ignored.
+		 *
+		 * @param cache_filename Absolute path to the cached file.
+		 * @param size File size, or -1 if not known.
+		 */
+		static void touch(const std::string &cache_filename, off64_t size);
+
+		/**
+		 * Remove least-recently-used files from the cache
+		 * until it's below the specified limits.
+		 *
+		 * Expired "not found" marker files are also removed, along with
+ * content store files that are no longer linked to any cache files.
+		 *
+		 * @param maxSize Maximum total size of the cached files, in bytes.
+		 * @param maxFiles Maximum number of cached files.
+		 * @return Number of files removed, or negative POSIX error code on error.
+		 */
+		static int prune(off64_t maxSize, unsigned int maxFiles);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_IMG_CACHEINDEX_HPP__ */
@@ -9,13 +9,18 @@
 #include "stdafx.h"
 #include "config.libromdata.h"
 #include "CacheManager.hpp"
+#include "CacheIndex.hpp"
+#include "NegativeCache.hpp"
 
 // librpbase, librpfile, librpthreads
 #include "librpbase/TextFuncs.hpp"
 #include "librpfile/RpFile.hpp"
 #include "librpfile/FileSystem.hpp"
+#include "librpfile/RpStats.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
 using LibRpThreads::Semaphore;
 using LibRpThreads::SemaphoreLocker;
 
@@ -27,6 +32,7 @@ using LibRpThreads::SemaphoreLocker;
 # include "libwin32common/RpWin32_sdk.h"
 # include "librpbase/TextFuncs_wchar.hpp"
 #else /* !_WIN32 */
+# include <pthread.h>
 # include <sys/types.h>
 # include <sys/wait.h>
 # include <unistd.h>
@@ -39,8 +45,12 @@ using LibRpThreads::SemaphoreLocker;
 #include <ctime>
 
 // C++ includes.
+#include <deque>
 #include <string>
+#include <vector>
+using std::deque;
 using std::string;
+using std::vector;
 #ifdef _WIN32
 using std::wstring;
 #endif /* _WIN32 */
@@ -117,10 +127,32 @@ string CacheManager::download(const string &cache_key)
 		return string();
 	}
 
+	// Check the negative cache first. This skips the
+	// zero-byte marker file and rp-download if the file
+	// was recently found to be missing on the server.
+	if (NegativeCache::isMissing(cache_key)) {
+		RpStats::inc(RpStats::DOWNLOADS_SKIPPED);
+		return string();
+	}
+
 	// Lock the semaphore to make sure we don't
 	// download too many files at once.
-	SemaphoreLocker locker(m_dlsem);
+	if (m_limitDownloads) {
+		SemaphoreLocker locker(m_dlsem);
+		return downloadIfNotCached(cache_key, cache_filename);
+	}
+	return downloadIfNotCached(cache_key, cache_filename);
+}
 
+/**
+ * Download a file if it isn't already in the cache.
+ * Called by download() after checking the negative cache.
+ * @param cache_key Cache key.
+ * @param cache_filename Cache filename.
+ * @return Absolute path to the cached file, or empty string on error.
+ */
+string CacheManager::downloadIfNotCached(const string &cache_key, const string &cache_filename)
+{
 	// Check if the file already exists.
 	off64_t filesize = 0;
 	time_t filemtime = 0;
@@ -134,8 +166,11 @@ string CacheManager::download(const string &cache_key)
 			// try to redownload it.
 			// TODO: Configurable time.
 			const time_t systime = time(nullptr);
-			if ((systime - filemtime) < (86400*7)) {
+			if ((systime - filemtime) < NegativeCache::EXPIRE_TIME) {
 				// Less than a week old.
+				// Add it to the negative cache for next time.
+				NegativeCache::addMissing(cache_key, filemtime);
+				RpStats::inc(RpStats::DOWNLOADS_SKIPPED);
 				return string();
 			}
 
@@ -148,6 +183,8 @@ string CacheManager::download(const string &cache_key)
 		} else if (filesize > 0) {
 			// File is larger than 0 bytes, which indicates
 			// it was cached successfully.
+			RpStats::inc(RpStats::CACHE_HITS);
+			CacheIndex::touch(cache_filename, filesize);
 			return cache_filename;
 		}
 	} else if (ret != -ENOENT) {
@@ -167,13 +204,24 @@ string CacheManager::download(const string &cache_key)
 	// NOTE: Using the unfiltered cache key, since filtering it
 	// results in slashes being changed to backslashes on Windows.
 	// rp-download will filter the key itself.
+	RpStats::inc(RpStats::CACHE_MISSES);
+	RpStats::inc(RpStats::DOWNLOADS_ATTEMPTED);
 	ret = execRpDownload(cache_key);
 	if (ret != 0) {
 		// rp-download failed for some reason.
+		// If it created a zero-byte file, the file
+		// wasn't found on the server.
+		if (FileSystem::get_file_size_and_mtime(cache_filename.c_str(), &filesize, &filemtime) == 0 &&
+		    filesize == 0)
+		{
+			NegativeCache::addMissing(cache_key, filemtime);
+			CacheIndex::touch(cache_filename, 0);
+		}
 		return string();
 	}
 
 	// rp-download has successfully downloaded the file.
+	CacheIndex::touch(cache_filename, -1);
 	return cache_filename;
 }
 
@@ -191,12 +239,215 @@ string CacheManager::findInCache(const string &cache_key)
 		return string();
 	}
 
+	// Skip files that are known to be missing on the server.
+	if (NegativeCache::isMissing(cache_key)) {
+		return string();
+	}
+
 	// Return the filename if the file exists.
 	if (FileSystem::access(cache_filename, R_OK) != 0) {
 		// Unable to read the cache file.
+		RpStats::inc(RpStats::CACHE_MISSES);
 		cache_filename.clear();
+	} else {
+		RpStats::inc(RpStats::CACHE_HITS);
+		CacheIndex::touch(cache_filename, -1);
 	}
 	return cache_filename;
 }
 
+/**
+ * Check if a cached file was updated on the server.
+ *
+ * A conditional request is used, so the file is only
+ * downloaded again if it was changed on the server.
+ * Files that were checked recently are skipped without
+ * contacting the server.
+ *
+ * @param cache_key Cache key.
+ * @return 0 on success; negative POSIX error code on error. (-ENOENT if the file isn't cached)
+ */
+int CacheManager::revalidate(const string &cache_key)
+{
+	// Get the cache key filename.
+	const string cache_filename = LibCacheCommon::getCacheFilename(cache_key);
+	if (cache_filename.empty()) {
+		// Error obtaining the cache key filename.
+		return -EINVAL;
+	}
+
+	// Only files that were downloaded successfully are revalidated.
+	// Zero-byte "not found" marker files expire on their own.
+	off64_t filesize = 0;
+	time_t filemtime = 0;
+	int ret = FileSystem::get_file_size_and_mtime(cache_filename.c_str(), &filesize, &filemtime);
+	if (ret != 0) {
+		return ret;
+	} else if (filesize <= 0) {
+		return -ENOENT;
+	}
+
+	// NOTE: Using the unfiltered cache key, same as download().
+	if (m_limitDownloads) {
+		SemaphoreLocker locker(m_dlsem);
+		ret = execRpDownload(cache_key, true);
+	} else {
+		ret = execRpDownload(cache_key, true);
+	}
+	if (ret == 0) {
+		// The file may have been updated.
+		CacheIndex::touch(cache_filename, -1);
+	}
+	return ret;
+}
+
+/** Background downloads. **/
+
+/**
+ * Background download job.
+ */
+struct DownloadAsyncJob {
+	string proxyUrl;
+	vector<string> cache_keys;
+	CacheManager::PFN_DOWNLOAD_COMPLETE pfnComplete;
+	void *userdata;
+};
+
+// Background download queue.
+// Jobs are processed by up to DOWNLOAD_ASYNC_THREADS_MAX threads,
+// which exit once the queue is empty.
+// NOTE: The number of threads matches m_dlsem, so the
+// threads don't block each other.
+static const unsigned int DOWNLOAD_ASYNC_THREADS_MAX = 2;
+static const size_t DOWNLOAD_ASYNC_QUEUE_MAX = 256;
+static Mutex dlQueueMutex;
+static deque<DownloadAsyncJob*> dlQueue;
+static unsigned int dlQueueThreads = 0;
+
+/**
+ * Background download thread.
+ * Processes jobs from the download queue until it's empty.
+ * @param param Unused.
+ * @return 0
+ */
+#ifdef _WIN32
+static DWORD WINAPI downloadAsyncThread(LPVOID param)
+#else /* !_WIN32 */
+static void *downloadAsyncThread(void *param)
+#endif /* _WIN32 */
+{
+	RP_UNUSED(param);
+
+	CacheManager cache;
+	string cache_filename;
+	for (;;) {
+		DownloadAsyncJob *job;
+		{
+			MutexLocker locker(dlQueueMutex);
+			if (dlQueue.empty()) {
+				// No more jobs.
+				dlQueueThreads--;
+				break;
+			}
+			job = dlQueue.front();
+			dlQueue.pop_front();
+		}
+
+		cache.setProxyUrl(job->proxyUrl);
+		cache_filename.clear();
+		for (const string &cache_key : job->cache_keys) {
+			cache_filename = cache.download(cache_key);
+			if (!cache_filename.empty())
+				break;
+		}
+
+		job->pfnComplete(cache_filename, job->userdata);
+		delete job;
+	}
+	return 0;
+}
+
+/**
+ * Download a file in the background.
+ *
+ * Each cache key is tried in order, using download(),
+ * until one of them succeeds. The current proxy server
+ * is used for all cache keys.
+ *
+ * If this function succeeds, the callback will be called
+ * exactly once from a background thread, even if none of
+ * the files could be downloaded.
+ *
+ * @param cache_keys Cache keys.
+ * @param pfnComplete Completion callback.
+ * @param userdata User data for the completion callback.
+ * @return 0 if the download was queued; negative POSIX error code on error. (-EBUSY if the queue is full)
+ */
+int CacheManager::downloadAsync(const vector<string> &cache_keys,
+	PFN_DOWNLOAD_COMPLETE pfnComplete, void *userdata)
+{
+	assert(!cache_keys.empty());
+	assert(pfnComplete != nullptr);
+	if (cache_keys.empty() || !pfnComplete) {
+		return -EINVAL;
+	}
+
+	DownloadAsyncJob *const job = new DownloadAsyncJob;
+	job->proxyUrl = m_proxyUrl;
+	job->cache_keys = cache_keys;
+	job->pfnComplete = pfnComplete;
+	job->userdata = userdata;
+
+	bool startThread = false;
+	{
+		MutexLocker locker(dlQueueMutex);
+		if (dlQueue.size() >= DOWNLOAD_ASYNC_QUEUE_MAX) {
+			// Too many pending downloads.
+			delete job;
+			return -EBUSY;
+		}
+		dlQueue.push_back(job);
+		if (dlQueueThreads < DOWNLOAD_ASYNC_THREADS_MAX) {
+			dlQueueThreads++;
+			startThread = true;
+		}
+	}
+	if (!startThread) {
+		// An existing thread will process the job.
+		return 0;
+	}
+
+	// NOTE: The thread is detached.
+	int ret = 0;
+#ifdef _WIN32
+	HANDLE hThread = CreateThread(nullptr, 0, downloadAsyncThread, nullptr, 0, nullptr);
+	if (hThread) {
+		CloseHandle(hThread);
+	} else {
+		ret = -ENOMEM;
+	}
+#else /* !_WIN32 */
+	pthread_t thread;
+	ret = -pthread_create(&thread, nullptr, downloadAsyncThread, nullptr);
+	if (ret == 0) {
+		pthread_detach(thread);
+	}
+#endif /* _WIN32 */
+	if (ret != 0) {
+		// Unable to start the thread.
+		// If the job is still queued, remove it. Otherwise,
+		// another thread has already started processing it.
+		MutexLocker locker(dlQueueMutex);
+		dlQueueThreads--;
+		for (auto iter = dlQueue.begin(); iter != dlQueue.end(); ++iter) {
+			if (*iter == job) {
+				dlQueue.erase(iter);
+				delete job;
+				return ret;
+			}
+		}
+	}
+	return 0;
+}
+
 }
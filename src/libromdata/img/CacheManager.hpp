@@ -16,13 +16,16 @@
 
 // C++ includes.
 #include <string>
+#include <vector>
 
 namespace LibRomData {
 
 class CacheManager
 {
 	public:
-		CacheManager() { }
+		CacheManager()
+			: m_limitDownloads(true)
+		{ }
 		~CacheManager() { }
 
 	private:
@@ -51,6 +54,47 @@ class CacheManager
 		 */
 		void setProxyUrl(const std::string &proxyUrl);
 
+		/**
+		 * Limit the number of simultaneous downloads?
+		 *
+		 * This is enabled by default. Callers that download many files
+		 * at once can disable it, but they're then responsible for
+		 * limiting the number of simultaneous downloads themselves.
+		 *
+		 * @param limitDownloads True to limit simultaneous downloads.
+		 */
+		inline void setLimitDownloads(bool limitDownloads)
+		{
+			m_limitDownloads = limitDownloads;
+		}
+
+		/**
+		 * Start the rp-download daemon if it isn't running, and connect to it.
+		 *
+		 * The daemon doesn't exit while a client is connected, so it keeps
+		 * running until the returned socket is closed. This is used by
+		 * processes that can't run rp-download after enabling their
+		 * security options, e.g. rpcli --prefetch.
+		 *
+		 * NOTE: Not supported on Windows, which doesn't have the daemon.
+		 *
+		 * @return Socket connected to the daemon, or negative POSIX error code on error.
+		 */
+		int startRpDownloadDaemon(void);
+
+		/**
+		 * Only use the rp-download daemon for downloads.
+		 *
+		 * If the daemon isn't running, downloads fail instead of
+		 * starting the daemon or running rp-download directly.
+		 * This is needed if the process can't run other programs.
+		 *
+		 * NOTE: No effect on Windows, which doesn't have the daemon.
+		 *
+		 * @param daemonOnly True to only use the rp-download daemon.
+		 */
+		static void setDaemonOnly(bool daemonOnly);
+
 	public:
 		/**
 		 * Download a file.
@@ -77,16 +121,71 @@ class CacheManager
 		 */
 		std::string findInCache(const std::string &cache_key);
 
+		/**
+		 * Check if a cached file was updated on the server.
+		 *
+		 * A conditional request is used, so the file is only
+		 * downloaded again if it was changed on the server.
+		 * Files that were checked recently are skipped without
+		 * contacting the server.
+		 *
+		 * @param cache_key Cache key.
+		 * @return 0 on success; negative POSIX error code on error. (-ENOENT if the file isn't cached)
+		 */
+		int revalidate(const std::string &cache_key);
+
+	public:
+		/**
+		 * downloadAsync() completion callback.
+		 * This is called from the download thread.
+		 * @param cache_filename Absolute path to the cached file, or empty string if no file could be downloaded.
+		 * @param userdata User data specified when calling downloadAsync().
+		 */
+		typedef void (*PFN_DOWNLOAD_COMPLETE)(const std::string &cache_filename, void *userdata);
+
+		/**
+		 * Download a file in the background.
+		 *
+		 * Each cache key is tried in order, using download(),
+		 * until one of them succeeds. The current proxy server
+		 * is used for all cache keys.
+		 *
+		 * Downloads are queued and processed by a small, fixed
+		 * number of background threads.
+		 *
+		 * If this function succeeds, the callback will be called
+		 * exactly once from a background thread, even if none of
+		 * the files could be downloaded.
+		 *
+		 * @param cache_keys Cache keys.
+		 * @param pfnComplete Completion callback.
+		 * @param userdata User data for the completion callback.
+		 * @return 0 if the download was queued; negative POSIX error code on error. (-EBUSY if the queue is full)
+		 */
+		int downloadAsync(const std::vector<std::string> &cache_keys,
+			PFN_DOWNLOAD_COMPLETE pfnComplete, void *userdata);
+
 	protected:
+		/**
+		 * Download a file if it isn't already in the cache.
+		 * Called by download() after checking the negative cache.
+		 * @param cache_key Cache key.
+		 * @param cache_filename Cache filename.
+		 * @return Absolute path to the cached file, or empty string on error.
+		 */
+		std::string downloadIfNotCached(const std::string &cache_key, const std::string &cache_filename);
+
 		/**
 		 * Execute rp-download.
 		 * @param filtered_cache_key Filtered cache key.
+		 * @param revalidate If true, check if the cached file was updated on the server.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		int execRpDownload(const std::string &filtered_cache_key);
+		int execRpDownload(const std::string &filtered_cache_key, bool revalidate = false);
 
 	protected:
 		std::string m_proxyUrl;
+		bool m_limitDownloads;
 
 		// Semaphore used to limit the number of simultaneous downloads.
 		static LibRpThreads::Semaphore m_dlsem;
@@ -18,12 +18,33 @@ namespace LibRomData {
 /**
  * Execute rp-download. (Dummy version)
  * @param filteredCacheKey Filtered cache key.
+ * @param revalidate If true, check if the cached file was updated on the server.
  * @return 0 on success; negative POSIX error code on error.
  */
-int CacheManager::execRpDownload(const string &filteredCacheKey)
+int CacheManager::execRpDownload(const string &filteredCacheKey, bool revalidate)
 {
 #warning CacheManager::execRpDownload() is not implemented!
 	return -ENOSYS;
 }
 
+/**
+ * Start the rp-download daemon if it isn't running, and connect to it.
+ * (Dummy version)
+ * @return Negative POSIX error code.
+ */
+int CacheManager::startRpDownloadDaemon(void)
+{
+	return -ENOSYS;
+}
+
+/**
+ * Only use the rp-download daemon for downloads.
+ * (Dummy version)
+ * @param daemonOnly True to only use the rp-download daemon.
+ */
+void CacheManager::setDaemonOnly(bool daemonOnly)
+{
+	RP_UNUSED(daemonOnly);
+}
+
 }
@@ -10,14 +10,29 @@
 #include "config.libromdata.h"
 #include "CacheManager.hpp"
 
+// libcachecommon
+#include "libcachecommon/CacheDir.hpp"
+
+// librpthreads
+#include "librpthreads/Atomics.h"
+
 // OS-specific includes.
+#include <poll.h>
 #include <signal.h>
+#include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #ifdef HAVE_POSIX_SPAWN
 # include <spawn.h>
 #endif /* HAVE_POSIX_SPAWN */
+#ifdef __linux__
+# include <sys/syscall.h>
+#endif /* __linux__ */
+#ifndef MSG_NOSIGNAL
+# define MSG_NOSIGNAL 0
+#endif /* !MSG_NOSIGNAL */
 
 // C++ includes.
 #include <string>
@@ -25,30 +40,34 @@ using std::string;
 
 namespace LibRomData {
 
+// Set if the rp-download daemon couldn't be started.
+// rp-download will be run directly for each download.
+static int rpDownloadDaemonFailed = 0;
+
+// Set if only the rp-download daemon should be used.
+// See CacheManager::setDaemonOnly().
+static int rpDownloadDaemonOnly = 0;
+
+// rp-download executable.
+// TODO: Mac OS X path. (bundle?)
+static const char rp_download_exe[] = DIR_INSTALL_LIBEXEC "/rp-download";
+
+// Maximum number of environment variables for rp-download, plus NULL.
+static const unsigned int RP_DOWNLOAD_ENVP_MAX = 5;
+
 /**
- * Execute rp-download. (POSIX version)
- * @param filteredCacheKey Filtered cache key.
- * @return 0 on success; negative POSIX error code on error.
+ * Build a minimal environment for rp-download.
+ * This will include http_proxy and https_proxy if the proxy URL is set.
+ * TODO: Separate proxies for http and https?
+ * @param proxyUrl	[in] Proxy URL, or empty string to use the environment.
+ * @param s_env		[out] Buffer for the environment variables.
+ * @param envp		[out] Environment. (pointers into s_env; NULL-terminated)
  */
-int CacheManager::execRpDownload(const string &filteredCacheKey)
+static void buildRpDownloadEnv(const string &proxyUrl, string &s_env, const char *envp[RP_DOWNLOAD_ENVP_MAX])
 {
-	// TODO: Mac OS X path. (bundle?)
- 	static const char rp_download_exe[] = DIR_INSTALL_LIBEXEC "/rp-download";
-
-	// Parameters.
-	const char *const argv[3] = {
-		rp_download_exe,
-		filteredCacheKey.c_str(),
-		nullptr
-	};
-
-	// Define a minimal environment for cURL.
-	// This will include http_proxy and https_proxy if the proxy URL is set.
-	// TODO: Separate proxies for http and https?
-	// TODO: Only build this once?
-	int pos[5] = {-1, -1, -1, -1, -1};
+	int pos[RP_DOWNLOAD_ENVP_MAX] = {-1, -1, -1, -1, -1};
 	int count = 0;
-	std::string s_env;
+	s_env.clear();
 	s_env.reserve(1024);
 
 	// We want the HOME and USER variables.
@@ -68,7 +87,7 @@ int CacheManager::execRpDownload(const string &filteredCacheKey)
 		s_env += envtmp;
 		s_env += '\0';
 	}
-	if (m_proxyUrl.empty()) {
+	if (proxyUrl.empty()) {
 		// Proxy URL is empty. Get the URLs from the environment.
 		envtmp = getenv("http_proxy");
 		if (envtmp && envtmp[0] != '\0') {
@@ -87,20 +106,235 @@ int CacheManager::execRpDownload(const string &filteredCacheKey)
 	} else {
 		// Proxy URL is set. Use it.
 		pos[count++] = static_cast<int>(s_env.size());
-		s_env += "http_proxy=" + m_proxyUrl;
+		s_env += "http_proxy=" + proxyUrl;
+		s_env += '\0';
 		pos[count++] = static_cast<int>(s_env.size());
-		s_env += "https_proxy=" + m_proxyUrl;
+		s_env += "https_proxy=" + proxyUrl;
+		s_env += '\0';
 	}
 
 	// Build envp.
-	const char *envp[5] = {nullptr, nullptr, nullptr, nullptr, nullptr};
 	unsigned int envp_idx = 0;
-	for (unsigned int i = 0; i < 5; i++) {
+	for (unsigned int i = 0; i < RP_DOWNLOAD_ENVP_MAX; i++) {
 		if (pos[i] >= 0) {
 			envp[envp_idx++] = &s_env[pos[i]];
 		}
 	}
+	for (; envp_idx < RP_DOWNLOAD_ENVP_MAX; envp_idx++) {
+		envp[envp_idx] = nullptr;
+	}
+}
+
+/**
+ * Connect to the rp-download daemon.
+ * @return Socket, or -1 if the daemon isn't running.
+ */
+static int connectRpDownloadDaemon(void)
+{
+	const string sock_filename = LibCacheCommon::getDownloadSocketFilename();
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	if (sock_filename.empty() || sock_filename.size() >= sizeof(addr.sun_path)) {
+		// Socket filename is invalid.
+		return -1;
+	}
+	addr.sun_family = AF_UNIX;
+	memcpy(addr.sun_path, sock_filename.c_str(), sock_filename.size());
+
+	int fd = socket(AF_UNIX, SOCK_STREAM
+#ifdef SOCK_CLOEXEC
+		| SOCK_CLOEXEC
+#endif /* SOCK_CLOEXEC */
+		, 0);
+	if (fd < 0) {
+		return -1;
+	}
+	if (connect(fd, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/**
+ * Start the rp-download daemon and connect to it.
+ *
+ * The daemon is started using a double-fork so it's reparented
+ * to init and doesn't need to be reaped by this process.
+ *
+ * If the daemon can't be started, it won't be started again
+ * by this process, and rp-download will be run directly.
+ *
+ * @param envp Environment.
+ * @return Socket, or -1 if the daemon couldn't be started.
+ */
+static int spawnRpDownloadDaemon(const char *const *envp)
+{
+	const char *const argv[3] = {
+		rp_download_exe,
+		"-d",
+		nullptr
+	};
+
+	// File descriptors above stderr are closed in the daemon,
+	// since it would otherwise keep our files and sockets open.
+	// NOTE: sysconf() isn't async-signal-safe, so call it here.
+	long max_fd = sysconf(_SC_OPEN_MAX);
+	if (max_fd < 0 || max_fd > 65536) {
+		max_fd = 65536;
+	}
+
+	// NOTE: Only async-signal-safe functions can be used
+	// in the child process, since we might be multi-threaded.
+	pid_t pid = fork();
+	if (pid == 0) {
+		// Child process.
+		// Start a new session so the daemon isn't affected
+		// by signals sent to the parent process group.
+		setsid();
+		if (fork() == 0) {
+			// Don't keep the current directory in use.
+			if (chdir("/") != 0) {
+				_exit(EXIT_FAILURE);
+			}
+
+#if defined(__linux__) && defined(SYS_close_range)
+			// Linux 5.9: Close all file descriptors at once.
+			if (syscall(SYS_close_range, 3U, ~0U, 0U) != 0)
+#endif /* __linux__ && SYS_close_range */
+			{
+				for (int fd = 3; fd < max_fd; fd++) {
+					close(fd);
+				}
+			}
+
+			execve(rp_download_exe, (char *const *)argv, (char *const *)envp);
+		}
+		_exit(EXIT_FAILURE);
+	} else if (pid > 0) {
+		// Reap the intermediate child process.
+		int wstatus;
+		waitpid(pid, &wstatus, 0);
+	}
 
+	// Wait up to 1 second for the daemon to start.
+	int fd = -1;
+	for (unsigned int i = 20; i > 0 && fd < 0; i--) {
+		usleep(50*1000);
+		fd = connectRpDownloadDaemon();
+	}
+	if (fd < 0) {
+		// Don't try to start the daemon again.
+		ATOMIC_OR_FETCH(&rpDownloadDaemonFailed, 1);
+	}
+	return fd;
+}
+
+/**
+ * Request a download from the rp-download daemon.
+ * The socket is closed by this function.
+ * @param fd Socket connected to the daemon.
+ * @param filteredCacheKey Filtered cache key.
+ * @param revalidate If true, check if the cached file was updated on the server.
+ * @return 0 on success; negative POSIX error code on error. (-ENOTCONN if the daemon didn't respond)
+ */
+static int requestRpDownloadDaemon(int fd, const string &filteredCacheKey, bool revalidate)
+{
+	string request;
+	if (revalidate) {
+		request = "-r ";
+	}
+	request += filteredCacheKey;
+	request += '\n';
+	if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+		// Error sending the request.
+		close(fd);
+		return -ENOTCONN;
+	}
+
+	// Wait up to 15 seconds for a reply.
+	// The daemon uses a 10-second timeout for each transfer,
+	// but it might be busy with other clients.
+	// TODO: User-configurable timeout?
+	char buf[16];
+	size_t len = 0;
+	while (len < sizeof(buf)-1) {
+		struct pollfd pfd;
+		pfd.fd = fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		int ret = poll(&pfd, 1, 15*1000);
+		if (ret == 0) {
+			// Timed out.
+			close(fd);
+			return -ETIMEDOUT;
+		} else if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		const ssize_t sz = recv(fd, &buf[len], sizeof(buf)-1-len, 0);
+		if (sz <= 0)
+			break;
+		len += sz;
+		if (memchr(buf, '\n', len) != nullptr)
+			break;
+	}
+	close(fd);
+
+	buf[len] = '\0';
+	if (len == 0 || !strchr(buf, '\n')) {
+		// Daemon closed the connection without replying.
+		return -ENOTCONN;
+	}
+
+	// Reply is the rp-download exit status.
+	// TODO: Report errors somewhere.
+	return (atoi(buf) == 0 ? 0 : -EIO);
+}
+
+/**
+ * Execute rp-download. (POSIX version)
+ * @param filteredCacheKey Filtered cache key.
+ * @param revalidate If true, check if the cached file was updated on the server.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CacheManager::execRpDownload(const string &filteredCacheKey, bool revalidate)
+{
+	// Parameters.
+	const char *const argv[4] = {
+		rp_download_exe,
+		(revalidate ? "-r" : filteredCacheKey.c_str()),
+		(revalidate ? filteredCacheKey.c_str() : nullptr),
+		nullptr
+	};
+
+	// Define a minimal environment for cURL.
+	string s_env;
+	const char *envp[RP_DOWNLOAD_ENVP_MAX];
+	buildRpDownloadEnv(m_proxyUrl, s_env, envp);
+
+	// Use the rp-download daemon if possible.
+	// The daemon keeps connections to the image servers open
+	// across multiple downloads, including downloads requested
+	// by other processes.
+	int fd = connectRpDownloadDaemon();
+	if (fd < 0 && ATOMIC_OR_FETCH(&rpDownloadDaemonOnly, 0)) {
+		// rp-download can't be run by this process.
+		return -ENOTCONN;
+	}
+	if (fd < 0 && !ATOMIC_OR_FETCH(&rpDownloadDaemonFailed, 0)) {
+		fd = spawnRpDownloadDaemon(envp);
+	}
+	if (fd >= 0) {
+		int ret = requestRpDownloadDaemon(fd, filteredCacheKey, revalidate);
+		if (ret != -ENOTCONN) {
+			return ret;
+		}
+	}
+
+	// Daemon isn't available. Run rp-download directly.
 	// TODO: Maybe we should close file handles...
 #ifdef HAVE_POSIX_SPAWN
 	// posix_spawn()
@@ -192,4 +426,40 @@ int CacheManager::execRpDownload(const string &filteredCacheKey)
 	return 0;
 }
 
+/**
+ * Start the rp-download daemon if it isn't running, and connect to it.
+ *
+ * The daemon doesn't exit while a client is connected, so it keeps
+ * running until the returned socket is closed. This is used by
+ * processes that can't run rp-download after enabling their
+ * security options, e.g. rpcli --prefetch.
+ *
+ * @return Socket connected to the daemon, or negative POSIX error code on error.
+ */
+int CacheManager::startRpDownloadDaemon(void)
+{
+	int fd = connectRpDownloadDaemon();
+	if (fd < 0) {
+		string s_env;
+		const char *envp[RP_DOWNLOAD_ENVP_MAX];
+		buildRpDownloadEnv(m_proxyUrl, s_env, envp);
+		fd = spawnRpDownloadDaemon(envp);
+	}
+	return (fd >= 0 ? fd : -ENOTCONN);
+}
+
+/**
+ * Only use the rp-download daemon for downloads.
+ *
+ * If the daemon isn't running, downloads fail instead of
+ * starting the daemon or running rp-download directly.
+ * This is needed if the process can't run other programs.
+ *
+ * @param daemonOnly True to only use the rp-download daemon.
+ */
+void CacheManager::setDaemonOnly(bool daemonOnly)
+{
+	ATOMIC_EXCHANGE(&rpDownloadDaemonOnly, (daemonOnly ? 1 : 0));
+}
+
 }
@@ -31,9 +31,10 @@ namespace LibRomData {
 /**
  * Execute rp-download. (Win32 version)
  * @param filteredCacheKey Filtered cache key.
+ * @param revalidate If true, check if the cached file was updated on the server.
  * @return 0 on success; negative POSIX error code on error.
  */
-int CacheManager::execRpDownload(const string &filteredCacheKey)
+int CacheManager::execRpDownload(const string &filteredCacheKey, bool revalidate)
 {
 	// The executable should be located in the DLL directory.
 	tstring rp_download_exe = dll_filename;
@@ -52,10 +53,10 @@ int CacheManager::execRpDownload(const string &filteredCacheKey)
 	// needs to be quoted properly.
 	tstring t_filteredCacheKey = U82T_s(filteredCacheKey);
 	tstring t_cmd_line;
-	t_cmd_line.reserve(rp_download_exe.size() + 5 + t_filteredCacheKey.size());
+	t_cmd_line.reserve(rp_download_exe.size() + 8 + t_filteredCacheKey.size());
 	t_cmd_line += _T('"');
 	t_cmd_line += rp_download_exe;
-	t_cmd_line += _T("\" \"");
+	t_cmd_line += (revalidate ? _T("\" -r \"") : _T("\" \""));
 	t_cmd_line += t_filteredCacheKey;
 	t_cmd_line += _T('"');
 
@@ -135,4 +136,24 @@ int CacheManager::execRpDownload(const string &filteredCacheKey)
 	return 0;
 }
 
+/**
+ * Start the rp-download daemon if it isn't running, and connect to it.
+ * (Windows version; the daemon isn't available.)
+ * @return Negative POSIX error code.
+ */
+int CacheManager::startRpDownloadDaemon(void)
+{
+	return -ENOTSUP;
+}
+
+/**
+ * Only use the rp-download daemon for downloads.
+ * (Windows version; the daemon isn't available.)
+ * @param daemonOnly True to only use the rp-download daemon.
+ */
+void CacheManager::setDaemonOnly(bool daemonOnly)
+{
+	RP_UNUSED(daemonOnly);
+}
+
 }
@@ -0,0 +1,400 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * NegativeCache.cpp: Negative-result cache for external downloads.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "NegativeCache.hpp"
+
+// librpfile, librpthreads
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpFile.hpp"
+#include "librpthreads/Mutex.hpp"
+using namespace LibRpFile;
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
+// libcachecommon
+#include "libcachecommon/CacheDir.hpp"
+
+// C++ STL classes.
+using std::string;
+using std::vector;
+
+namespace LibRomData {
+
+/**
+ * Negative cache file format:
+ * - NegCacheHeader
+ * - Array of NegCacheEntry
+ *
+ * New entries are appended to the end of the file.
+ * The file is rewritten with only the live entries,
+ * sorted by hash, if it grows too large.
+ *
+ * All values are little-endian.
+ */
+static const uint32_t NEGCACHE_MAGIC = 'RPNC';
+static const uint32_t NEGCACHE_VERSION = 1;
+
+struct NegCacheHeader {
+	uint32_t magic;		// [0x000] 'RPNC'
+	uint32_t version;	// [0x004] Format version.
+};
+ASSERT_STRUCT(NegCacheHeader, 8);
+
+struct NegCacheEntry {
+	uint64_t hash;		// [0x000] FNV-1a hash of the cache key.
+	int64_t timestamp;	// [0x008] Time the cache key was found to be missing.
+};
+ASSERT_STRUCT(NegCacheEntry, 16);
+
+// Negative cache filename. (in the cache directory)
+static const char NEGCACHE_FILENAME[] = "negative.bin";
+
+// How often to check if another process updated the file, in seconds.
+static const time_t NEGCACHE_RECHECK_TIME = 60;
+
+// Compact the file if it has at least this many dead records.
+static const size_t NEGCACHE_COMPACT_THRESHOLD = 1024;
+
+// Maximum file size. (16 MB; about one million entries)
+static const off64_t NEGCACHE_MAX_SIZE = 16*1024*1024;
+
+/**
+ * Negative cache state.
+ * Shared by all threads in the process.
+ */
+static struct {
+	Mutex mutex;
+
+	// Live entries, sorted by hash. (host-endian)
+	vector<NegCacheEntry> entries;
+
+	// Negative cache filename.
+	string filename;
+
+	// File size and mtime when the file was last loaded.
+	off64_t fileSize;
+	time_t fileMtime;
+
+	// Last time the file was checked for changes.
+	time_t lastCheck;
+	bool loaded;
+} negCache;
+
+/**
+ * Get the hash of a cache key.
+ * @param cache_key Cache key.
+ * @return FNV-1a hash.
+ */
+static uint64_t hashCacheKey(const string &cache_key)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (const char chr : cache_key) {
+		hash ^= static_cast<uint8_t>(chr);
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+/**
+ * Compare two entries by hash.
+ */
+static inline bool entryHashLess(const NegCacheEntry &a, const NegCacheEntry &b)
+{
+	return a.hash < b.hash;
+}
+
+/**
+ * Rewrite the negative cache file using only the live entries.
+ * negCache.mutex must be locked by the caller.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int compactNegativeCache(void)
+{
+	vector<uint8_t> buf;
+	buf.resize(sizeof(NegCacheHeader) + (negCache.entries.size() * sizeof(NegCacheEntry)));
+	NegCacheHeader *const header = reinterpret_cast<NegCacheHeader*>(buf.data());
+	header->magic = cpu_to_le32(NEGCACHE_MAGIC);
+	header->version = cpu_to_le32(NEGCACHE_VERSION);
+	NegCacheEntry *pEntry = reinterpret_cast<NegCacheEntry*>(&buf[sizeof(NegCacheHeader)]);
+	for (const NegCacheEntry &entry : negCache.entries) {
+		pEntry->hash = cpu_to_le64(entry.hash);
+		pEntry->timestamp = cpu_to_le64(static_cast<uint64_t>(entry.timestamp));
+		pEntry++;
+	}
+
+	// Write to a temporary file first so other processes
+	// never see a partially-written file.
+	const string tmp_filename = negCache.filename + ".tmp";
+	RpFile *const file = new RpFile(tmp_filename, RpFile::FM_CREATE_WRITE);
+	if (!file->isOpen()) {
+		int ret = -file->lastError();
+		file->unref();
+		return (ret != 0 ? ret : -EIO);
+	}
+	const size_t size = file->write(buf.data(), buf.size());
+	file->unref();
+	if (size != buf.size()) {
+		FileSystem::delete_file(tmp_filename);
+		return -EIO;
+	}
+
+#ifdef _WIN32
+	// rename() fails on Windows if the target file exists.
+	FileSystem::delete_file(negCache.filename);
+#endif /* _WIN32 */
+	if (rename(tmp_filename.c_str(), negCache.filename.c_str()) != 0) {
+		int ret = -errno;
+		FileSystem::delete_file(tmp_filename);
+		return (ret != 0 ? ret : -EIO);
+	}
+
+	FileSystem::get_file_size_and_mtime(negCache.filename, &negCache.fileSize, &negCache.fileMtime);
+	return 0;
+}
+
+/**
+ * Load the negative cache file.
+ * negCache.mutex must be locked by the caller.
+ * @param now Current time.
+ */
+static void loadNegativeCache(time_t now)
+{
+	negCache.entries.clear();
+	negCache.fileSize = 0;
+	negCache.fileMtime = 0;
+
+	if (negCache.filename.empty()) {
+		const string &cache_dir = LibCacheCommon::getCacheDirectory();
+		if (cache_dir.empty()) {
+			// No cache directory.
+			return;
+		}
+		negCache.filename = cache_dir;
+		if (negCache.filename.at(negCache.filename.size()-1) != DIR_SEP_CHR) {
+			negCache.filename += DIR_SEP_CHR;
+		}
+		negCache.filename += NEGCACHE_FILENAME;
+	}
+
+	RpFile *const file = new RpFile(negCache.filename, RpFile::FM_OPEN_READ);
+	if (!file->isOpen()) {
+		// No negative cache yet.
+		file->unref();
+		return;
+	}
+
+	const off64_t fileSize = file->size();
+	if (fileSize < static_cast<off64_t>(sizeof(NegCacheHeader)) || fileSize > NEGCACHE_MAX_SIZE) {
+		// Invalid file size.
+		file->unref();
+		return;
+	}
+
+	vector<uint8_t> buf(static_cast<size_t>(fileSize));
+	const size_t size = file->read(buf.data(), buf.size());
+	file->unref();
+	if (size != buf.size()) {
+		// Read error.
+		return;
+	}
+
+	const NegCacheHeader *const header = reinterpret_cast<const NegCacheHeader*>(buf.data());
+	if (header->magic != cpu_to_le32(NEGCACHE_MAGIC) ||
+	    header->version != cpu_to_le32(NEGCACHE_VERSION))
+	{
+		// Incorrect magic number or version.
+		return;
+	}
+
+	// NOTE: A partially-written record at the end of
+	// the file from an interrupted append is ignored.
+	const size_t count = (buf.size() - sizeof(NegCacheHeader)) / sizeof(NegCacheEntry);
+	const NegCacheEntry *pEntry = reinterpret_cast<const NegCacheEntry*>(&buf[sizeof(NegCacheHeader)]);
+	negCache.entries.reserve(count);
+	for (size_t i = 0; i < count; i++, pEntry++) {
+		NegCacheEntry entry;
+		entry.hash = le64_to_cpu(pEntry->hash);
+		entry.timestamp = static_cast<int64_t>(le64_to_cpu(pEntry->timestamp));
+		if ((now - static_cast<time_t>(entry.timestamp)) >= NegativeCache::EXPIRE_TIME) {
+			// Entry has expired.
+			continue;
+		}
+		negCache.entries.push_back(entry);
+	}
+
+	// Sort the entries by hash. If a hash is present
+	// more than once, keep the newest timestamp.
+	std::sort(negCache.entries.begin(), negCache.entries.end(), entryHashLess);
+	auto out = negCache.entries.begin();
+	for (auto iter = negCache.entries.begin(); iter != negCache.entries.end(); ++iter) {
+		if (out != negCache.entries.begin() && (out-1)->hash == iter->hash) {
+			if (iter->timestamp > (out-1)->timestamp) {
+				(out-1)->timestamp = iter->timestamp;
+			}
+			continue;
+		}
+		*out++ = *iter;
+	}
+	negCache.entries.erase(out, negCache.entries.end());
+
+	FileSystem::get_file_size_and_mtime(negCache.filename, &negCache.fileSize, &negCache.fileMtime);
+
+	if (count - negCache.entries.size() >= NEGCACHE_COMPACT_THRESHOLD) {
+		// Too many expired or duplicate records.
+		compactNegativeCache();
+	}
+}
+
+/**
+ * Make sure the negative cache is up to date.
+ * negCache.mutex must be locked by the caller.
+ * @param now Current time.
+ */
+static void updateNegativeCache(time_t now)
+{
+	if (!negCache.loaded) {
+		negCache.loaded = true;
+		negCache.lastCheck = now;
+		loadNegativeCache(now);
+		return;
+	}
+
+	if (now - negCache.lastCheck < NEGCACHE_RECHECK_TIME && now >= negCache.lastCheck) {
+		// Checked recently.
+		return;
+	}
+	negCache.lastCheck = now;
+
+	// Reload the file if another process changed it.
+	off64_t fileSize = 0;
+	time_t fileMtime = 0;
+	FileSystem::get_file_size_and_mtime(negCache.filename, &fileSize, &fileMtime);
+	if (fileSize != negCache.fileSize || fileMtime != negCache.fileMtime) {
+		loadNegativeCache(now);
+	}
+}
+
+/**
+ * Check if a cache key is known to be missing on the server.
+ * @param cache_key Cache key.
+ * @return True if the cache key is known to be missing; false if not.
+ */
+bool NegativeCache::isMissing(const string &cache_key)
+{
+	const time_t now = time(nullptr);
+	const uint64_t hash = hashCacheKey(cache_key);
+
+	MutexLocker locker(negCache.mutex);
+	updateNegativeCache(now);
+
+	NegCacheEntry key;
+	key.hash = hash;
+	key.timestamp = 0;
+	auto iter = std::lower_bound(negCache.entries.cbegin(), negCache.entries.cend(), key, entryHashLess);
+	if (iter == negCache.entries.cend() || iter->hash != hash) {
+		// Not found.
+		return false;
+	}
+	return ((now - static_cast<time_t>(iter->timestamp)) < EXPIRE_TIME);
+}
+
+/**
+ * Mark a cache key as missing on the server.
+ * @param cache_key Cache key.
+ * @param timestamp Time the cache key was found to be missing.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int NegativeCache::addMissing(const string &cache_key, time_t timestamp)
+{
+	const time_t now = time(nullptr);
+	if ((now - timestamp) >= EXPIRE_TIME) {
+		// Entry has already expired.
+		return 0;
+	}
+
+	NegCacheEntry entry;
+	entry.hash = hashCacheKey(cache_key);
+	entry.timestamp = static_cast<int64_t>(timestamp);
+
+	MutexLocker locker(negCache.mutex);
+	updateNegativeCache(now);
+	if (negCache.filename.empty()) {
+		// No cache directory.
+		return -ENOENT;
+	}
+
+	// Add the entry to the in-memory cache.
+	auto iter = std::lower_bound(negCache.entries.begin(), negCache.entries.end(), entry, entryHashLess);
+	if (iter != negCache.entries.end() && iter->hash == entry.hash) {
+		if (iter->timestamp >= entry.timestamp) {
+			// Already cached.
+			return 0;
+		}
+		iter->timestamp = entry.timestamp;
+	} else {
+		negCache.entries.insert(iter, entry);
+	}
+
+	// Append the entry to the file.
+	int ret = 0;
+	RpFile *file = new RpFile(negCache.filename, RpFile::FM_OPEN_WRITE);
+	if (!file->isOpen()) {
+		// Create a new file.
+		file->unref();
+		ret = FileSystem::rmkdir(negCache.filename);
+		if (ret != 0) {
+			return ret;
+		}
+		file = new RpFile(negCache.filename, RpFile::FM_CREATE_WRITE);
+		if (!file->isOpen()) {
+			ret = -file->lastError();
+			file->unref();
+			return (ret != 0 ? ret : -EIO);
+		}
+
+		NegCacheHeader header;
+		header.magic = cpu_to_le32(NEGCACHE_MAGIC);
+		header.version = cpu_to_le32(NEGCACHE_VERSION);
+		if (file->write(&header, sizeof(header)) != sizeof(header)) {
+			file->unref();
+			FileSystem::delete_file(negCache.filename);
+			return -EIO;
+		}
+	}
+
+	off64_t pos = file->size();
+	if (pos >= NEGCACHE_MAX_SIZE) {
+		// File is too big.
+		file->unref();
+		return -EFBIG;
+	}
+	// Skip a partially-written record from an interrupted append.
+	pos -= (pos - static_cast<off64_t>(sizeof(NegCacheHeader))) % sizeof(NegCacheEntry);
+
+	// NOTE: If another process appends an entry at the same time,
+	// one of the entries may be lost. The zero-byte marker file
+	// in the cache directory is still present in that case.
+	NegCacheEntry le_entry;
+	le_entry.hash = cpu_to_le64(entry.hash);
+	le_entry.timestamp = cpu_to_le64(static_cast<uint64_t>(entry.timestamp));
+	file->seek(pos);
+	if (file->write(&le_entry, sizeof(le_entry)) != sizeof(le_entry)) {
+		ret = -file->lastError();
+		if (ret == 0) {
+			ret = -EIO;
+		}
+	}
+	file->unref();
+
+	// Our own changes don't need to be reloaded.
+	FileSystem::get_file_size_and_mtime(negCache.filename, &negCache.fileSize, &negCache.fileMtime);
+	return ret;
+}
+
+}
@@ -0,0 +1,65 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * NegativeCache.hpp: Negative-result cache for external downloads.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_IMG_NEGATIVECACHE_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_IMG_NEGATIVECACHE_HPP__
+
+#include "common.h"
+
+// C includes. (C++ namespace)
+#include <ctime>
+
+// C++ includes.
+#include <string>
+
+namespace LibRomData {
+
+/**
+ * Negative-result cache.
+ *
+ * Keeps track of cache keys that weren't found on the server,
+ * so they can be skipped without checking the zero-byte marker
+ * file in the cache directory or running rp-download.
+ *
+ * The cache is stored in a single file in the cache directory.
+ * Entries expire after the same interval as the marker files.
+ */
+class NegativeCache
+{
+	private:
+		NegativeCache();
+		~NegativeCache();
+	private:
+		RP_DISABLE_COPY(NegativeCache)
+
+	public:
+		/**
+		 * Entry expiration time, in seconds.
+		 * TODO: Configurable time.
+		 */
+		static const time_t EXPIRE_TIME = 86400*7;
+
+		/**
+		 * Check if a cache key is known to be missing on the server.
+		 * @param cache_key Cache key.
+		 * @return True if the cache key is known to be missing; false if not.
+		 */
+		static bool isMissing(const std::string &cache_key);
+
+		/**
+		 * Mark a cache key as missing on the server.
+		 * @param cache_key Cache key.
+		 * @param timestamp Time the cache key was found to be missing.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int addMissing(const std::string &cache_key, time_t timestamp);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_IMG_NEGATIVECACHE_HPP__ */
@@ -0,0 +1,275 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RecentRomData.cpp: Shared RomData objects for thumbnailers.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RecentRomData.hpp"
+
+// librpbase, librpfile, librpthreads
+#include "librpbase/RomData.hpp"
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/IRpFile.hpp"
+#include "librpthreads/CancelToken.hpp"
+#include "librpthreads/Mutex.hpp"
+using namespace LibRpBase;
+using namespace LibRpFile;
+using LibRpThreads::CancelToken;
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
+// libromdata
+#include "../RomDataFactory.hpp"
+
+// OS-specific includes.
+#ifdef _WIN32
+# include "libwin32common/RpWin32_sdk.h"
+#else /* !_WIN32 */
+# include <pthread.h>
+# include <unistd.h>
+#endif /* _WIN32 */
+
+// C includes. (C++ namespace)
+#include <ctime>
+
+// C++ includes.
+#include <list>
+
+// C++ STL classes.
+using std::list;
+using std::string;
+
+namespace LibRomData {
+
+// Keep unused RomData objects for this many seconds.
+// NOTE: Unused RomData objects keep their files open, so they're
+// released by a background thread once this time has elapsed.
+static const time_t RECENT_KEEP_TIME = 10;
+
+// Maximum number of unused RomData objects to keep.
+static const size_t RECENT_MAX_UNUSED = 8;
+
+struct RecentRomDataEntry {
+	string filename;
+	FileSystem::FileId fileId;	// includes the size and mtime in nanoseconds
+
+	// Locked while the RomData object is in use.
+	Mutex mutex;
+
+	RomData *romData;	// ref()'d; may be nullptr if unsupported
+	bool checked;		// True if RomDataFactory::create() was called.
+
+	// Protected by recentMutex.
+	int users;
+	time_t lastUsed;
+
+	RecentRomDataEntry()
+		: romData(nullptr)
+		, checked(false)
+		, users(0)
+		, lastUsed(0)
+	{ }
+
+	~RecentRomDataEntry()
+	{
+		UNREF(romData);
+	}
+};
+
+// Shared entries.
+static Mutex recentMutex;
+static list<RecentRomDataEntry*> recentEntries;	// most recently used first
+
+// True if the purge thread is running. (protected by recentMutex)
+static bool purgeThreadRunning = false;
+
+/**
+ * Remove entries that haven't been used recently.
+ * recentMutex must be locked by the caller.
+ * @param now Current time.
+ */
+static void purgeRecentEntries(time_t now)
+{
+	size_t unused = 0;
+	for (auto iter = recentEntries.begin(); iter != recentEntries.end(); ) {
+		RecentRomDataEntry *const entry = *iter;
+		if (entry->users > 0) {
+			++iter;
+			continue;
+		}
+
+		unused++;
+		if (unused > RECENT_MAX_UNUSED || (now - entry->lastUsed) >= RECENT_KEEP_TIME) {
+			delete entry;
+			iter = recentEntries.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+}
+
+/**
+ * Background purge thread.
+ * Releases unused entries once they expire, and exits
+ * once there are no unused entries left.
+ * @param param Unused.
+ * @return 0
+ */
+#ifdef _WIN32
+static DWORD WINAPI purgeThread(LPVOID param)
+#else /* !_WIN32 */
+static void *purgeThread(void *param)
+#endif /* _WIN32 */
+{
+	RP_UNUSED(param);
+
+	for (;;) {
+		time_t sleepTime;
+		{
+			MutexLocker locker(recentMutex);
+			const time_t now = time(nullptr);
+			purgeRecentEntries(now);
+
+			// Find the unused entry that expires first.
+			bool haveUnused = false;
+			time_t lastUsed = now;
+			for (const RecentRomDataEntry *entry : recentEntries) {
+				if (entry->users == 0 && (!haveUnused || entry->lastUsed < lastUsed)) {
+					lastUsed = entry->lastUsed;
+					haveUnused = true;
+				}
+			}
+			if (!haveUnused) {
+				// Nothing left to purge.
+				purgeThreadRunning = false;
+				break;
+			}
+
+			sleepTime = (lastUsed + RECENT_KEEP_TIME) - now;
+			if (sleepTime < 1) {
+				sleepTime = 1;
+			}
+		}
+
+#ifdef _WIN32
+		Sleep(static_cast<DWORD>(sleepTime) * 1000);
+#else /* !_WIN32 */
+		sleep(static_cast<unsigned int>(sleepTime));
+#endif /* _WIN32 */
+	}
+	return 0;
+}
+
+/**
+ * Start the purge thread if it isn't running.
+ * recentMutex must be locked by the caller.
+ */
+static void startPurgeThread(void)
+{
+	if (purgeThreadRunning)
+		return;
+
+	// NOTE: The thread is detached.
+	// If it can't be started, unused entries will be purged
+	// on the next request instead.
+#ifdef _WIN32
+	HANDLE hThread = CreateThread(nullptr, 0, purgeThread, nullptr, 0, nullptr);
+	if (hThread) {
+		CloseHandle(hThread);
+		purgeThreadRunning = true;
+	}
+#else /* !_WIN32 */
+	pthread_t thread;
+	if (pthread_create(&thread, nullptr, purgeThread, nullptr) == 0) {
+		pthread_detach(thread);
+		purgeThreadRunning = true;
+	}
+#endif /* _WIN32 */
+}
+
+/**
+ * Get the shared RomData object for a file.
+ * If the file isn't shared yet, a RomData object will be
+ * created using RomDataFactory::RDA_HAS_THUMBNAIL.
+ * @param file Open file.
+ */
+RecentRomData::RecentRomData(IRpFile *file)
+	: m_entry(nullptr)
+	, m_romData(nullptr)
+{
+	assert(file != nullptr);
+	if (!file) {
+		return;
+	}
+
+	FileSystem::FileId fileId;
+	const string filename = file->filename();
+	if (filename.empty() || FileSystem::get_file_id(filename, &fileId) != 0) {
+		// Not a local file. Don't share it.
+		m_romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
+		return;
+	}
+
+	const time_t now = time(nullptr);
+	{
+		MutexLocker locker(recentMutex);
+		purgeRecentEntries(now);
+
+		for (auto iter = recentEntries.begin(); iter != recentEntries.end(); ++iter) {
+			RecentRomDataEntry *const entry = *iter;
+			if (entry->fileId == fileId && entry->filename == filename) {
+				// Found a matching entry.
+				// Move it to the front of the list.
+				recentEntries.erase(iter);
+				recentEntries.push_front(entry);
+				m_entry = entry;
+				break;
+			}
+		}
+
+		if (!m_entry) {
+			m_entry = new RecentRomDataEntry;
+			m_entry->filename = filename;
+			m_entry->fileId = fileId;
+			recentEntries.push_front(m_entry);
+		}
+		m_entry->users++;
+	}
+
+	// Lock the entry. If another thread is using it,
+	// this will wait until that thread is done.
+	m_entry->mutex.lock();
+	if (!m_entry->checked) {
+		// If this request was cancelled, the file wasn't fully
+		// checked, so let the next request check it again.
+		m_entry->romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
+		m_entry->checked = (m_entry->romData != nullptr || !CancelToken::isCurrentCancelled());
+	}
+	m_romData = m_entry->romData;
+}
+
+RecentRomData::~RecentRomData()
+{
+	if (!m_entry) {
+		// Not shared.
+		UNREF(m_romData);
+		return;
+	}
+
+	m_entry->mutex.unlock();
+
+	MutexLocker locker(recentMutex);
+	m_entry->users--;
+	m_entry->lastUsed = time(nullptr);
+	const bool isUnused = (m_entry->users == 0);
+	purgeRecentEntries(m_entry->lastUsed);
+	if (isUnused) {
+		// Release the entry once it expires.
+		startPurgeThread();
+	}
+}
+
+}
@@ -0,0 +1,79 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RecentRomData.hpp: Shared RomData objects for thumbnailers.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_IMG_RECENTROMDATA_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_IMG_RECENTROMDATA_HPP__
+
+#include "common.h"
+
+namespace LibRpBase {
+	class RomData;
+}
+namespace LibRpFile {
+	class IRpFile;
+}
+
+namespace LibRomData {
+
+struct RecentRomDataEntry;
+
+/**
+ * Shared RomData object for thumbnailers.
+ *
+ * Thumbnailers often get several requests for the same file in quick
+ * succession, e.g. one for each thumbnail size. Instead of parsing the
+ * file for every request, the RomData object is shared by all requests
+ * for the same local file, including requests that are processed
+ * concurrently, and it's kept for a few seconds after the last request
+ * has finished. Since RomData caches its decoded images, each image is
+ * only decoded once. Unused RomData objects are released by a background
+ * thread, so their files aren't kept open indefinitely.
+ *
+ * Files are matched by filename and FileSystem::FileId, so a file that's
+ * rewritten within the same second isn't served from a stale RomData.
+ *
+ * The RomData object is locked for as long as the RecentRomData
+ * object exists, so other threads requesting the same file will
+ * wait until it's destroyed.
+ *
+ * Files that don't have a local filename are not shared.
+ */
+class RecentRomData
+{
+	public:
+		/**
+		 * Get the shared RomData object for a file.
+		 * If the file isn't shared yet, a RomData object will be
+		 * created using RomDataFactory::RDA_HAS_THUMBNAIL.
+		 * @param file Open file.
+		 */
+		explicit RecentRomData(LibRpFile::IRpFile *file);
+		~RecentRomData();
+
+	private:
+		RP_DISABLE_COPY(RecentRomData)
+
+	public:
+		/**
+		 * Get the RomData object.
+		 * NOTE: This object is NOT ref()'d.
+		 * @return RomData object, or nullptr if the file isn't supported.
+		 */
+		inline LibRpBase::RomData *romData(void) const
+		{
+			return m_romData;
+		}
+
+	private:
+		RecentRomDataEntry *m_entry;
+		LibRpBase::RomData *m_romData;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_IMG_RECENTROMDATA_HPP__ */
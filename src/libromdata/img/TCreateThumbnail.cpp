@@ -13,12 +13,14 @@
 
 // Cache Manager
 #include "CacheManager.hpp"
+#include "NegativeCache.hpp"
 
 // librpbase, librpfile
 #include "librpbase/RomData.hpp"
 #include "librpbase/config/Config.hpp"
 #include "librpbase/img/RpImageLoader.hpp"
 #include "librpfile/RpFile.hpp"
+#include "librpfile/RpTrace.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 
@@ -26,6 +28,11 @@ using namespace LibRpFile;
 #include "librptexture/img/rp_image.hpp"
 using LibRpTexture::rp_image;
 
+// librpthreads
+#include "librpthreads/CancelToken.hpp"
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::CancelToken;
+
 // libromdata
 #include "../RomDataFactory.hpp"
 
@@ -35,12 +42,24 @@ using LibRpTexture::rp_image;
 
 // C++ includes.
 #include <memory>
+#include <string>
+#include <vector>
+using std::string;
 using std::unique_ptr;
+using std::vector;
 
 namespace LibRomData {
 
 template<typename ImgClass>
 TCreateThumbnail<ImgClass>::TCreateThumbnail()
+	: m_pfnExtImgReady(nullptr)
+	, m_extImgReadyUserData(nullptr)
+	, m_extImgQueued(false)
+	, m_extImgPrefetchCount(DEFAULT_EXT_IMG_PREFETCH_COUNT)
+	, m_cancelToken(nullptr)
+	, m_timeBudgetMs(0)
+	, m_extImgCacheOnly(false)
+	, m_degraded(false)
 { }
 
 template<typename ImgClass>
@@ -49,18 +68,30 @@ TCreateThumbnail<ImgClass>::~TCreateThumbnail()
 
 /**
  * Get an internal image.
+ *
+ * If req_size is specified and the RomData subclass supports it
+ * (e.g. textures with mipmaps), only the smallest version of the
+ * image that is at least req_size will be loaded.
+ *
+ * If pOutScaledSize is specified and the image needs nearest-neighbor
+ * upscaling or 8:7 aspect ratio correction, the image is rescaled to
+ * the final thumbnail size before conversion to ImgClass.
+ *
  * @param romData	[in] RomData object.
  * @param imageType	[in] Image type.
+ * @param req_size	[in] Requested image size. (0 for the full image)
  * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
  * @param sBIT		[out,opt] sBIT metadata.
+ * @param pOutScaledSize [out,opt] Rescaled size, if the image was rescaled; otherwise, 0x0.
  * @return Internal image, or null ImgClass on error.
  */
 template<typename ImgClass>
 ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 	const RomData *romData,
 	RomData::ImageType imageType,
-	ImgSize *pOutSize,
-	rp_image::sBIT_t *sBIT)
+	int req_size, ImgSize *pOutSize,
+	rp_image::sBIT_t *sBIT,
+	ImgSize *pOutScaledSize)
 {
 	assert(imageType >= RomData::IMG_INT_MIN && imageType <= RomData::IMG_INT_MAX);
 	if (imageType < RomData::IMG_INT_MIN || imageType > RomData::IMG_INT_MAX) {
@@ -71,7 +102,7 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 		return getNullImgClass();
 	}
 
-	const rp_image *image = romData->image(imageType);
+	const rp_image *image = romData->imageForSize(imageType, req_size);
 	if (!image) {
 		// No image.
 		if (sBIT) {
@@ -80,11 +111,39 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 		return getNullImgClass();
 	}
 
+	// If the image needs nearest-neighbor upscaling and/or 8:7
+	// aspect ratio correction, do both in a single resample
+	// before converting it to ImgClass. CI8 images are converted
+	// to ARGB32 during the resample.
+	rp_image *scaled_image = nullptr;
+	ImgSize scaled_sz = {0, 0};
+	if (pOutScaledSize && rpImageToImgClassKeepsSize()) {
+		const uint32_t imgpf = romData->imgpf(imageType);
+		if (imgpf & (RomData::IMGPF_RESCALE_NEAREST | RomData::IMGPF_RESCALE_ASPECT_8to7)) {
+			ImgSize full_sz = {image->width(), image->height()};
+			if (calcThumbnailSize(full_sz, imgpf, req_size, &scaled_sz)) {
+				scaled_image = image->scaled_nearest_ARGB32(scaled_sz.width, scaled_sz.height);
+			}
+		}
+	}
+
 	// Convert the rp_image to ImgClass.
-	ImgClass ret_img = rpImageToImgClass(image);
+	ImgClass ret_img = rpImageToImgClass(scaled_image ? scaled_image : image);
+	if (pOutScaledSize) {
+		pOutScaledSize->width = 0;
+		pOutScaledSize->height = 0;
+	}
 	if (isImgClassValid(ret_img)) {
 		// Image converted successfully.
-		if (pOutSize) {
+		if (scaled_image) {
+			// Image was rescaled.
+			// Return the original size as the image size.
+			if (pOutSize) {
+				pOutSize->width = image->width();
+				pOutSize->height = image->height();
+			}
+			*pOutScaledSize = scaled_sz;
+		} else if (pOutSize) {
 			// Get the image size.
 			// NOTE: The image may have been resized on Windows,
 			// since Windows has issues with non-square images.
@@ -98,9 +157,13 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 				// No sBIT metadata.
 				// Clear the struct.
 				memset(sBIT, 0, sizeof(*sBIT));
+			} else if (sBIT->alpha > 0 && image->isOpaque()) {
+				// Image is fully opaque, so the alpha channel isn't needed.
+				sBIT->alpha = 0;
 			}
 		}
 	}
+	UNREF(scaled_image);
 	return ret_img;
 }
 
@@ -128,7 +191,9 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 		return getNullImgClass();
 	}
 
-	// Synchronously download from the source URLs.
+	// Download from the source URLs.
+	// If asynchronous downloads are enabled, uncached images
+	// are downloaded in the background instead.
 	// TODO: Image size selection.
 	std::vector<RomData::ExtURL> extURLs;
 	int ret = romData->extURLs(imageType, &extURLs, req_size);
@@ -146,9 +211,17 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 	const bool downloadHighResScans = config->downloadHighResScans();
 
 	CacheManager cache;
+	std::vector<std::string> asyncCacheKeys;
+	std::string asyncProxy;
 	const auto extURLs_cend = extURLs.cend();
 	for (auto iter = extURLs.cbegin(); iter != extURLs_cend; ++iter) {
 		const RomData::ExtURL &extURL = *iter;
+		if (NegativeCache::isMissing(extURL.cache_key)) {
+			// This image was recently found to be missing
+			// on the server. Don't bother checking the cache.
+			continue;
+		}
+
 		std::string proxy = proxyForUrl(extURL.url);
 		cache.setProxyUrl(!proxy.empty() ? proxy.c_str() : nullptr);
 
@@ -164,7 +237,25 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 
 		// TODO: Have download() return the actual data and/or load the cached file.
 		std::string cache_filename;
-		if (download) {
+		if (download && m_pfnExtImgReady) {
+			// Check the rom-properties cache. If the image isn't
+			// present, it will be downloaded in the background.
+			cache_filename = cache.findInCache(extURL.cache_key);
+			if (cache_filename.empty()) {
+				if (asyncCacheKeys.empty()) {
+					asyncProxy = std::move(proxy);
+				}
+				asyncCacheKeys.push_back(extURL.cache_key);
+				continue;
+			}
+		} else if (download && m_extImgCacheOnly) {
+			// Downloading would go over the time budget.
+			// Only check the rom-properties cache.
+			cache_filename = cache.findInCache(extURL.cache_key);
+			if (cache_filename.empty()) {
+				m_degraded = true;
+			}
+		} else if (download) {
 			// Attempt to download the image if it isn't already
 			// present in the rom-properties cache.
 			cache_filename = cache.download(extURL.cache_key);
@@ -177,9 +268,14 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 			continue;
 
 		// Attempt to load the image.
+		// NOTE: Images in the rom-properties cache were downloaded
+		// by rom-properties, so only the PNG chunk structure is checked.
+		// NOTE: Large JPEG scans are decoded at a reduced size
+		// that's still at least req_size.
 		unique_RefBase<RpFile> file(new RpFile(cache_filename, RpFile::FM_OPEN_READ));
 		if (file->isOpen()) {
-			rp_image *const dl_img = RpImageLoader::load(file.get());
+			rp_image *const dl_img = RpImageLoader::load(file.get(),
+				RpPng::CheckLevel::Structure, req_size);
 			if (dl_img && dl_img->isValid()) {
 				// Image loaded successfully.
 				file->close();
@@ -197,9 +293,13 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 							// No sBIT metadata.
 							// Clear the struct.
 							memset(sBIT, 0, sizeof(*sBIT));
+						} else if (sBIT->alpha > 0 && dl_img->isOpaque()) {
+							// Image is fully opaque, so the alpha channel isn't needed.
+							sBIT->alpha = 0;
 						}
 					}
 					// TODO: Transparency processing?
+					dl_img->unref();
 					return ret_img;
 				}
 			}
@@ -207,6 +307,14 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 		}
 	}
 
+	if (!asyncCacheKeys.empty() && !m_extImgQueued) {
+		// Download the image in the background.
+		cache.setProxyUrl(asyncProxy);
+		if (cache.downloadAsync(asyncCacheKeys, m_pfnExtImgReady, m_extImgReadyUserData) == 0) {
+			m_extImgQueued = true;
+		}
+	}
+
 	// No image.
 	if (sBIT) {
 		memset(sBIT, 0, sizeof(*sBIT));
@@ -242,6 +350,230 @@ inline void TCreateThumbnail<ImgClass>::rescale_aspect(ImgSize &rs_size, const I
 	}
 }
 
+/**
+ * Calculate the size for nearest-neighbor upscaling.
+ * Used for images with IMGPF_RESCALE_NEAREST.
+ * @param fullSize	[in] Full image size.
+ * @param reqSize	[in] Requested thumbnail size.
+ * @param pOutSize	[out] Upscaled size.
+ * @return True if the image should be upscaled; false if not.
+ */
+template<typename ImgClass>
+bool TCreateThumbnail<ImgClass>::calcRescaleNearestSize(const ImgSize &fullSize, int reqSize, ImgSize *pOutSize)
+{
+	if (reqSize <= 0 || fullSize.width <= 0 || fullSize.height <= 0) {
+		// Invalid size.
+		return false;
+	}
+
+	// TODO: User configuration.
+	ResizeNearestUpPolicy resize_up = RESIZE_UP_HALF;
+	bool needs_resize_up = false;
+
+	// FIXME: Only if both dimensions are less, or if the second dimension
+	// isn't much bigger? (e.g. skip 64x1024)
+	switch (resize_up) {
+		case RESIZE_UP_NONE:
+			// No resize.
+			break;
+
+		case RESIZE_UP_HALF:
+		default:
+			// Only resize images that are less than or equal to
+			// half requested thumbnail size.
+			needs_resize_up = (fullSize.width  <= (reqSize/2)) ||
+					  (fullSize.height <= (reqSize/2));
+			break;
+
+		case RESIZE_UP_ALL:
+			// Resize all images that are smaller than the
+			// requested thumbnail size.
+			needs_resize_up = (fullSize.width  < reqSize) ||
+					  (fullSize.height < reqSize);
+			break;
+	}
+
+	if (!needs_resize_up) {
+		// Resize Up isn't needed.
+		return false;
+	}
+
+	// Need to upscale the image.
+	ImgSize int_sz = {reqSize, reqSize};
+	// Resize to the next highest integer multiple.
+	int_sz.width -= (int_sz.width % fullSize.width);
+	int_sz.height -= (int_sz.height % fullSize.height);
+
+	// Calculate the closest size while maintaining the aspect ratio.
+	// Based on Qt 4.8's QSize::scale().
+	*pOutSize = fullSize;
+	rescale_aspect(*pOutSize, int_sz);
+
+	// FIXME: If the original image is 64x1024, the rescale
+	// may result in 0x0, which is no good. If this happens,
+	// skip the rescaling entirely.
+	return (pOutSize->width > 0 && pOutSize->height > 0);
+}
+
+/**
+ * Calculate the final thumbnail size.
+ * This combines 8:7 pixel aspect ratio correction and
+ * nearest-neighbor upscaling, so the image only has to
+ * be resampled once.
+ * @param fullSize	[in,out] Image size. (adjusted for the pixel aspect ratio on return)
+ * @param imgpf		[in] Image processing flags.
+ * @param reqSize	[in] Requested thumbnail size.
+ * @param pOutSize	[out] Thumbnail size.
+ * @return True if the image needs to be rescaled; false if not.
+ */
+template<typename ImgClass>
+bool TCreateThumbnail<ImgClass>::calcThumbnailSize(ImgSize &fullSize, uint32_t imgpf, int reqSize, ImgSize *pOutSize)
+{
+	const ImgSize origSize = fullSize;
+
+	if (imgpf & RomData::IMGPF_RESCALE_ASPECT_8to7) {
+		// If the image width is 256 or 512, rescale to an 8:7 pixel aspect ratio.
+		switch (fullSize.width) {
+			case 256:
+				fullSize.width = 292;
+				break;
+			case 512:
+				fullSize.width = 584;
+				break;
+			default:
+				break;
+		}
+	}
+
+	// TODO: If image is larger than req_size, resize down.
+	if (!(imgpf & RomData::IMGPF_RESCALE_NEAREST) ||
+	    !calcRescaleNearestSize(fullSize, reqSize, pOutSize))
+	{
+		// Resize Up isn't needed, or the image can't be rescaled.
+		// Use the (aspect-corrected) full image size.
+		*pOutSize = fullSize;
+	}
+
+	return (pOutSize->width != origSize.width || pOutSize->height != origSize.height);
+}
+
+/**
+ * Is the time budget at risk?
+ * @return True if more than half of the time budget has been used; false if not, or if no time budget is set.
+ */
+template<typename ImgClass>
+bool TCreateThumbnail<ImgClass>::isTimeBudgetAtRisk(void) const
+{
+	if (m_timeBudgetMs == 0) {
+		// No time budget.
+		return false;
+	}
+
+	// NOTE: Decoding an image usually takes about as long as
+	// RomData detection, so check against half of the budget.
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - m_budgetStart);
+	return (elapsed.count() >= static_cast<int64_t>(m_timeBudgetMs / 2));
+}
+
+/**
+ * Download the highest-priority external image types concurrently.
+ * The images are downloaded to the cache, so getExternalImage()
+ * can load them without waiting for each download in turn.
+ * @param romData	[in] RomData object.
+ * @param imgTypes	[in] Image types, in priority order.
+ * @param count		[in] Number of image types.
+ * @param imgbf		[in] Image types that may be present.
+ * @param reqSize	[in] Requested image size.
+ */
+template<typename ImgClass>
+void TCreateThumbnail<ImgClass>::prefetchExternalImages(const RomData *romData,
+	const uint8_t *imgTypes, unsigned int count, uint32_t imgbf, int reqSize)
+{
+	const Config *const config = Config::instance();
+	const bool downloadHighResScans = config->downloadHighResScans();
+
+	// Cache keys for each image type that needs to be downloaded.
+	// Each image type's cache keys are tried in order, same as
+	// in getExternalImage().
+	struct PrefetchJob {
+		vector<string> cache_keys;
+		string proxy;
+	};
+	vector<PrefetchJob> jobs;
+
+	CacheManager cache;
+	for (unsigned int i = 0; i < count && jobs.size() < m_extImgPrefetchCount; i++) {
+		const RomData::ImageType imgType = static_cast<RomData::ImageType>(imgTypes[i]);
+		if (imgType > RomData::IMG_EXT_MAX || !(imgbf & (1U << imgType))) {
+			// Invalid image type, or image is not present.
+			continue;
+		}
+		if (imgType <= RomData::IMG_INT_MAX) {
+			// Internal image. Lower-priority image types
+			// won't be used unless it can't be loaded.
+			break;
+		}
+
+		vector<RomData::ExtURL> extURLs;
+		if (romData->extURLs(imgType, &extURLs, reqSize) != 0 || extURLs.empty()) {
+			// No URLs.
+			continue;
+		}
+
+		PrefetchJob job;
+		bool cached = false;
+		for (const RomData::ExtURL &extURL : extURLs) {
+			if (NegativeCache::isMissing(extURL.cache_key)) {
+				// Recently found to be missing on the server.
+				continue;
+			}
+			if (!cache.findInCache(extURL.cache_key).empty()) {
+				// Already cached.
+				// Cache keys after this one won't be used.
+				cached = job.cache_keys.empty();
+				break;
+			}
+			if (!downloadHighResScans && extURL.high_res) {
+				// High-resolution images aren't downloaded.
+				continue;
+			}
+			if (job.cache_keys.empty()) {
+				job.proxy = proxyForUrl(extURL.url);
+			}
+			job.cache_keys.push_back(extURL.cache_key);
+		}
+
+		if (cached) {
+			// This image type is already cached, so
+			// lower-priority image types won't be used.
+			break;
+		}
+		if (!job.cache_keys.empty()) {
+			jobs.push_back(std::move(job));
+		}
+	}
+
+	if (jobs.size() < 2) {
+		// Nothing to download concurrently.
+		// getExternalImage() will download the image, if needed.
+		return;
+	}
+
+	// Download the images.
+	// NOTE: Concurrent downloads are still limited by CacheManager.
+	LibRpThreads::ThreadPool pool(static_cast<unsigned int>(jobs.size()));
+	pool.parallelFor(jobs.size(), [&jobs](size_t i) {
+		const PrefetchJob &job = jobs[i];
+		CacheManager cache;
+		cache.setProxyUrl(!job.proxy.empty() ? job.proxy.c_str() : nullptr);
+		for (const string &cache_key : job.cache_keys) {
+			if (!cache.download(cache_key).empty())
+				break;
+		}
+	});
+}
+
 /**
  * Create a thumbnail for the specified ROM file.
  * @param romData	[in] RomData object.
@@ -252,9 +584,28 @@ inline void TCreateThumbnail<ImgClass>::rescale_aspect(ImgSize &rs_size, const I
 template<typename ImgClass>
 int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize, GetThumbnailOutParams_t *pOutParams)
 {
+	m_budgetStart = std::chrono::steady_clock::now();
+	return getThumbnail_int(romData, reqSize, pOutParams);
+}
+
+/**
+ * Create a thumbnail for the specified ROM file.
+ * The time budget is counted from m_budgetStart.
+ * @param romData	[in] RomData object.
+ * @param reqSize	[in] Requested image size. (single dimension; assuming square image)
+ * @param pOutParams	[out] Output parameters.
+ * @return 0 on success; non-zero on error.
+ */
+template<typename ImgClass>
+int TCreateThumbnail<ImgClass>::getThumbnail_int(const RomData *romData, int reqSize, GetThumbnailOutParams_t *pOutParams)
+{
+	RP_TRACE_ZONE("TCreateThumbnail::getThumbnail");
+
 	assert(romData != nullptr);
 	assert(reqSize > 0);
 	assert(pOutParams != nullptr);
+	pOutParams->extImgQueued = false;
+	pOutParams->degraded = false;
 	if (reqSize <= 0) {
 		// Invalid parameter...
 		return RPCT_INVALID_IMAGE_SIZE;
@@ -267,14 +618,26 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 	pOutParams->fullSize.height = 0;
 	memset(&pOutParams->sBIT, 0, sizeof(pOutParams->sBIT));
 	pOutParams->retImg = getNullImgClass();
+	m_extImgQueued = false;
+	m_degraded = false;
+
+	// If a time budget is set, don't wait for external image downloads.
+	// Asynchronous downloads don't block, so they're still allowed.
+	m_extImgCacheOnly = (m_timeBudgetMs > 0 && !m_pfnExtImgReady);
+
+	// Use the cancellation token for everything below,
+	// including reads and decoding done by RomData.
+	CancelToken::Scope cancelScope(m_cancelToken);
 
 	uint32_t imgbf = romData->supportedImageTypes();
 	uint32_t imgpf = 0;
+	int intImgType = -1;	// Internal image type, if one was used.
+	ImgSize scaledSize = {0, 0};	// Rescaled size, if getInternalImage() rescaled the image.
 
 	// Get the image priority.
 	const Config *const config = Config::instance();
 	Config::ImgTypePrio_t imgTypePrio;
-	Config::ImgTypeResult res = config->getImgTypePrio(romData->className(), &imgTypePrio);
+	Config::ImgTypeResult res = config->getImgTypePrio(romData->classId(), &imgTypePrio);
 	switch (res) {
 		case Config::IMGTR_SUCCESS:
 		case Config::IMGTR_SUCCESS_DEFAULTS:
@@ -296,7 +659,8 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		// Check for an icon first.
 		// TODO: Define "small sizes" somewhere. (DPI independence?)
 		if (imgbf & RomData::IMGBF_INT_ICON) {
-			pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON, &pOutParams->fullSize, &pOutParams->sBIT);
+			pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON, reqSize,
+				&pOutParams->fullSize, &pOutParams->sBIT, &scaledSize);
 			imgpf = romData->imgpf(RomData::IMG_INT_ICON);
 			imgbf &= ~RomData::IMGBF_INT_ICON;
 
@@ -308,9 +672,20 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		}
 	}
 
+	if (m_extImgPrefetchCount > 1 && !m_pfnExtImgReady && !m_extImgCacheOnly && config->extImgDownloadEnabled()) {
+		// Download the highest-priority external images concurrently.
+		// The loop below will then find them in the cache.
+		prefetchExternalImages(romData, imgTypePrio.imgTypes, imgTypePrio.length, imgbf, reqSize);
+	}
+
 	// Check all available images in image priority order.
 	// TODO: Use pointer arithmetic in this loop?
 	for (unsigned int i = 0; i < imgTypePrio.length; i++) {
+		if (CancelToken::isCurrentCancelled()) {
+			// Thumbnail request was cancelled.
+			break;
+		}
+
 		const RomData::ImageType imgType =
 			static_cast<RomData::ImageType>(imgTypePrio.imgTypes[i]);
 		assert(imgType <= RomData::IMG_EXT_MAX);
@@ -326,10 +701,43 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		}
 
 		// This image may be present.
-		if (imgType <= RomData::IMG_INT_MAX) {
+		if (imgType <= RomData::IMG_INT_MAX && isTimeBudgetAtRisk()) {
+			// Internal image, but the time budget is at risk.
+			// Use the icon if it's available, since it's usually
+			// much smaller. Otherwise, load a smaller version of
+			// the image, e.g. a lower-resolution mipmap, and let
+			// the rescale below upscale it.
+			m_degraded = true;
+			if (imgType != RomData::IMG_INT_ICON && (imgbf & RomData::IMGBF_INT_ICON)) {
+				pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON, reqSize,
+					&pOutParams->fullSize, &pOutParams->sBIT, &scaledSize);
+				imgpf = romData->imgpf(RomData::IMG_INT_ICON);
+				imgbf &= ~RomData::IMGBF_INT_ICON;
+				if (isImgClassValid(pOutParams->retImg)) {
+					intImgType = RomData::IMG_INT_ICON;
+					break;
+				}
+			}
+
+			// NOTE: The final size is calculated below using the
+			// full reqSize, so don't let getInternalImage() rescale it.
+			const int smallReqSize = (reqSize > 1 ? reqSize / 2 : 1);
+			pOutParams->retImg = getInternalImage(romData, imgType, smallReqSize,
+				&pOutParams->fullSize, &pOutParams->sBIT);
+			imgpf = romData->imgpf(imgType);
+			if (isImgClassValid(pOutParams->retImg)) {
+				intImgType = imgType;
+			}
+		} else if (imgType <= RomData::IMG_INT_MAX) {
 			// Internal image.
-			pOutParams->retImg = getInternalImage(romData, imgType, &pOutParams->fullSize, &pOutParams->sBIT);
+			// NOTE: Only the smallest version of the image that's
+			// at least reqSize will be decoded, if supported.
+			pOutParams->retImg = getInternalImage(romData, imgType, reqSize,
+				&pOutParams->fullSize, &pOutParams->sBIT, &scaledSize);
 			imgpf = romData->imgpf(imgType);
+			if (isImgClassValid(pOutParams->retImg)) {
+				intImgType = imgType;
+			}
 		} else {
 			// External image.
 			pOutParams->retImg = getExternalImage(romData, imgType, reqSize, &pOutParams->fullSize, &pOutParams->sBIT);
@@ -346,6 +754,18 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		// priority list.
 		imgbf &= ~bf;
 	}
+	pOutParams->extImgQueued = m_extImgQueued;
+	pOutParams->degraded = m_degraded;
+
+	if (CancelToken::isCurrentCancelled()) {
+		// Thumbnail request was cancelled.
+		// The image may be incomplete, so don't return it.
+		if (isImgClassValid(pOutParams->retImg)) {
+			freeImgClass(pOutParams->retImg);
+			pOutParams->retImg = getNullImgClass();
+		}
+		return RPCT_CANCELLED;
+	}
 
 	if (!isImgClassValid(pOutParams->retImg)) {
 		// No image.
@@ -360,87 +780,32 @@ skip_image_check:
 		return RPCT_SOURCE_FILE_ERROR;
 	}
 
-	if (imgpf & RomData::IMGPF_RESCALE_ASPECT_8to7) {
-		// If the image width is 256 or 512, rescale to an 8:7 pixel aspect ratio.
-		int scaleW = 0;
-		switch (pOutParams->fullSize.width) {
-			case 256:
-				scaleW = 292;
-				break;
-			case 512:
-				scaleW = 584;
-				break;
-			default:
-				break;
-		}
-		if (scaleW != 0) {
-			pOutParams->fullSize.width = scaleW;
-			ImgClass scaled_img = rescaleImgClass(pOutParams->retImg, pOutParams->fullSize);
+	// Calculate the final thumbnail size, including 8:7 aspect ratio
+	// correction and nearest-neighbor upscaling, and resample once.
+	if (calcThumbnailSize(pOutParams->fullSize, imgpf, reqSize, &pOutParams->thumbSize)) {
+		if (scaledSize.width > 0 && scaledSize.height > 0) {
+			// Internal image was already rescaled by getInternalImage().
+			assert(scaledSize.width == pOutParams->thumbSize.width);
+			assert(scaledSize.height == pOutParams->thumbSize.height);
+			pOutParams->thumbSize = scaledSize;
+		} else {
+			ImgClass scaled_img = rescaleImgClass(pOutParams->retImg, pOutParams->thumbSize);
 			freeImgClass(pOutParams->retImg);
 			pOutParams->retImg = scaled_img;
 		}
 	}
 
-	// TODO: If image is larger than req_size, resize down.
-	if (imgpf & RomData::IMGPF_RESCALE_NEAREST) {
-		// TODO: User configuration.
-		ResizeNearestUpPolicy resize_up = RESIZE_UP_HALF;
-		bool needs_resize_up = false;
-
-		// FIXME: Only if both dimensions are less, or if the second dimension
-		// isn't much bigger? (e.g. skip 64x1024)
-		switch (resize_up) {
-			case RESIZE_UP_NONE:
-				// No resize.
-				break;
-
-			case RESIZE_UP_HALF:
-			default:
-				// Only resize images that are less than or equal to
-				// half requested thumbnail size.
-				needs_resize_up = (pOutParams->fullSize.width  <= (reqSize/2)) ||
-						  (pOutParams->fullSize.height <= (reqSize/2));
-				break;
-
-			case RESIZE_UP_ALL:
-				// Resize all images that are smaller than the
-				// requested thumbnail size.
-				needs_resize_up = (pOutParams->fullSize.width  < reqSize) ||
-						  (pOutParams->fullSize.height < reqSize);
-				break;
-		}
-
-		if (needs_resize_up) {
-			// Need to upscale the image.
-			ImgSize int_sz = {reqSize, reqSize};
-			// Resize to the next highest integer multiple.
-			int_sz.width -= (int_sz.width % pOutParams->fullSize.width);
-			int_sz.height -= (int_sz.height % pOutParams->fullSize.height);
-
-			// Calculate the closest size while maintaining the aspect ratio.
-			// Based on Qt 4.8's QSize::scale().
-			ImgSize rescale_sz = pOutParams->fullSize;
-			rescale_aspect(rescale_sz, int_sz);
-
-			// FIXME: If the original image is 64x1024, the rescale
-			// may result in 0x0, which is no good. If this happens,
-			// skip the rescaling entirely.
-			if (rescale_sz.width > 0 && rescale_sz.height > 0) {
-				pOutParams->thumbSize = rescale_sz;
-				ImgClass scaled_img = rescaleImgClass(pOutParams->retImg, rescale_sz);
-				freeImgClass(pOutParams->retImg);
-				pOutParams->retImg = scaled_img;
-			} else {
-				// Unable to rescale. Use the full image size.
-				pOutParams->thumbSize = pOutParams->fullSize;
-			}
-		} else {
-			// Resize Up isn't needed. Use the full image size.
-			pOutParams->thumbSize = pOutParams->fullSize;
+	if (intImgType >= 0) {
+		// If a reduced-size internal image was loaded (e.g. a mipmap),
+		// report the size of the full image instead.
+		const auto sizeDefs = romData->supportedImageSizes(static_cast<RomData::ImageType>(intImgType));
+		if (!sizeDefs.empty() &&
+		    sizeDefs[0].width > pOutParams->fullSize.width &&
+		    sizeDefs[0].height >= pOutParams->fullSize.height)
+		{
+			pOutParams->fullSize.width = sizeDefs[0].width;
+			pOutParams->fullSize.height = sizeDefs[0].height;
 		}
-	} else {
-		// Thumbnail size matches the full image size.
-		pOutParams->thumbSize = pOutParams->fullSize;
 	}
 
 	// Image retrieved successfully.
@@ -460,21 +825,25 @@ int TCreateThumbnail<ImgClass>::getThumbnail(IRpFile *file, int reqSize, GetThum
 	assert(file != nullptr);
 	assert(reqSize > 0);
 	assert(pOutParams != nullptr);
+	pOutParams->extImgQueued = false;
+	pOutParams->degraded = false;
 	if (reqSize <= 0) {
 		// Invalid parameter...
 		return RPCT_INVALID_IMAGE_SIZE;
 	}
+	m_budgetStart = std::chrono::steady_clock::now();
 
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
+	CancelToken::Scope cancelScope(m_cancelToken);
 	RomData *romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
 	if (!romData) {
-		// ROM is not supported.
-		return RPCT_SOURCE_FILE_NOT_SUPPORTED;
+		// ROM is not supported, or the request was cancelled.
+		return (CancelToken::isCurrentCancelled() ? RPCT_CANCELLED : RPCT_SOURCE_FILE_NOT_SUPPORTED);
 	}
 
 	// Call the actual function.
-	int ret = getThumbnail(romData, reqSize, pOutParams);
+	int ret = getThumbnail_int(romData, reqSize, pOutParams);
 	romData->unref();
 	return ret;
 }
@@ -492,15 +861,21 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const char *filename, int reqSize,
 	assert(filename != nullptr);
 	assert(reqSize > 0);
 	assert(pOutParams != nullptr);
+	pOutParams->extImgQueued = false;
+	pOutParams->degraded = false;
 	if (reqSize <= 0) {
 		// Invalid parameter...
 		return RPCT_INVALID_IMAGE_SIZE;
 	}
+	m_budgetStart = std::chrono::steady_clock::now();
 
 	// Attempt to open the ROM file.
 	// TODO: OS-specific wrappers, e.g. RpQFile or RpGVfsFile.
-	// For now, using RpFile, which is an stdio wrapper.
-	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
+	// NOTE: RpFile_mmap isn't used here. Thumbnailers usually run in
+	// long-lived processes, e.g. the file manager or rp-thumbnailer-dbus,
+	// and if the file is truncated while it's mapped, reading the
+	// truncated area raises SIGBUS, which would kill the process.
+	IRpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
 	if (!file->isOpen()) {
 		// Could not open the file.
 		file->unref();
@@ -509,15 +884,16 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const char *filename, int reqSize,
 
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
+	CancelToken::Scope cancelScope(m_cancelToken);
 	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
 	file->unref();	// file is ref()'d by RomData.
 	if (!romData) {
-		// ROM is not supported.
-		return RPCT_SOURCE_FILE_NOT_SUPPORTED;
+		// ROM is not supported, or the request was cancelled.
+		return (CancelToken::isCurrentCancelled() ? RPCT_CANCELLED : RPCT_SOURCE_FILE_NOT_SUPPORTED);
 	}
 
 	// Call the actual function.
-	int ret = getThumbnail(romData, reqSize, pOutParams);
+	int ret = getThumbnail_int(romData, reqSize, pOutParams);
 	romData->unref();
 	return ret;
 }
@@ -15,6 +15,9 @@
  * be compiled correctly.
  */
 
+// C includes.
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,6 +36,7 @@ typedef enum {
 	RPCT_SOURCE_FILE_BAD_FS		= 7,	// Source file is located on a "bad" file system.
 	RPCT_RUNNING_AS_ROOT		= 8,	// Running as root is not supported.
 	RPCT_INVALID_IMAGE_SIZE		= 9,	// Invalid image size requested. (e.g. 0 or less)
+	RPCT_CANCELLED			= 10,	// Thumbnail request was cancelled.
 } RpCreateThumbnailError;
 
 /**
@@ -64,6 +68,80 @@ typedef enum {
  */
 typedef int (RP_C_API *PFN_RP_CREATE_THUMBNAIL)(const char *source_file, const char *output_file, int maximum_size);
 
+/**
+ * rp_create_thumbnail_async() callback.
+ * This is called from a background thread after an external
+ * image has been downloaded, or after a lower-quality thumbnail
+ * was regenerated at full quality.
+ * If no download was needed, this is called before
+ * rp_create_thumbnail_async() returns, with err set to
+ * RPCT_SOURCE_FILE_NO_IMAGE.
+ * @param source_file Source file. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param err 0 if the thumbnail was regenerated; non-zero on error.
+ * @param userdata User data.
+ */
+typedef void (RP_C_API *PFN_RP_THUMBNAIL_READY)(const char *source_file, const char *output_file, int err, void *userdata);
+
+/**
+ * rp_create_thumbnail_async() function pointer.
+ * Same as rp_create_thumbnail(), but external images that aren't
+ * cached yet are downloaded in the background. The thumbnail is
+ * created using the next available image type, and it's
+ * regenerated once the download has finished. A thumbnail
+ * that was degraded to meet the interactive time budget is
+ * also regenerated in the background.
+ * @param source_file Source file. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param maximum_size Maximum size.
+ * @param pfnReady Callback for the regenerated thumbnail. (always called exactly once)
+ * @param userdata User data for the callback.
+ * @return 0 on success; non-zero on error.
+ */
+typedef int (RP_C_API *PFN_RP_CREATE_THUMBNAIL_ASYNC)(const char *source_file, const char *output_file, int maximum_size,
+	PFN_RP_THUMBNAIL_READY pfnReady, void *userdata);
+
+/**
+ * rp_get_stats() callback.
+ * Called once for each runtime statistics counter.
+ * @param name Counter name. (ASCII, e.g. "bytes_read_file")
+ * @param value Counter value.
+ * @param userdata User data.
+ */
+typedef void (RP_C_API *PFN_RP_STATS_CALLBACK)(const char *name, uint64_t value, void *userdata);
+
+/**
+ * rp_get_stats() function pointer.
+ * Retrieves the process-wide runtime statistics counters.
+ * @param pfnCallback Callback, called once per counter.
+ * @param userdata User data for the callback.
+ */
+typedef void (RP_C_API *PFN_RP_GET_STATS)(PFN_RP_STATS_CALLBACK pfnCallback, void *userdata);
+
+/**
+ * rp_set_decode_threads() function pointer.
+ * Sets the number of threads used to decode large images.
+ * @param count Number of threads. (0 for the number of CPUs; 1 to disable)
+ */
+typedef void (RP_C_API *PFN_RP_SET_DECODE_THREADS)(unsigned int count);
+
+/**
+ * rp_set_cancel_flag() function pointer.
+ * Sets the cancellation flag for thumbnails created on the calling thread.
+ * If the flag is set to non-zero while rp_create_thumbnail() or
+ * rp_create_thumbnail_async() is running, thumbnailing stops early
+ * and RPCT_CANCELLED is returned.
+ * @param cancel_flag Cancellation flag, or NULL to clear it. (must remain valid until cleared)
+ */
+typedef void (RP_C_API *PFN_RP_SET_CANCEL_FLAG)(volatile int *cancel_flag);
+
+/**
+ * rp_start_download_daemon() function pointer.
+ * Starts the rp-download daemon, and only uses the daemon for downloads.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+typedef int (RP_C_API *PFN_RP_START_DOWNLOAD_DAEMON)(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -71,8 +149,10 @@ typedef int (RP_C_API *PFN_RP_CREATE_THUMBNAIL)(const char *source_file, const c
 #ifdef __cplusplus
 #include "librpbase/RomData.hpp"
 #include "librptexture/img/rp_image.hpp"
+#include "CacheManager.hpp"
 
 // C++ includes.
+#include <chrono>
 #include <string>
 
 namespace LibRpBase {
@@ -81,6 +161,9 @@ namespace LibRpBase {
 namespace LibRpFile {
 	class IRpFile;
 }
+namespace LibRpThreads {
+	class CancelToken;
+}
 
 namespace LibRomData {
 
@@ -106,14 +189,17 @@ class TCreateThumbnail
 		 * Get an internal image.
 		 * @param romData	[in] RomData object.
 		 * @param imageType	[in] Image type.
+		 * @param req_size	[in] Requested image size. (0 for the full image)
 		 * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
 		 * @param sBIT		[out,opt] sBIT metadata.
+		 * @param pOutScaledSize [out,opt] Rescaled size, if the image was rescaled; otherwise, 0x0.
 		 * @return Internal image, or null ImgClass on error.
 		 */
 		ImgClass getInternalImage(const LibRpBase::RomData *romData,
 			LibRpBase::RomData::ImageType imageType,
-			ImgSize *pOutSize = nullptr,
-			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr);
+			int req_size = 0, ImgSize *pOutSize = nullptr,
+			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr,
+			ImgSize *pOutScaledSize = nullptr);
 
 		/**
 		 * Get an external image.
@@ -137,6 +223,8 @@ class TCreateThumbnail
 			ImgSize fullSize;			// [out] Full image size.
 			LibRpTexture::rp_image::sBIT_t sBIT;	// [out] sBIT metadata.
 			ImgClass retImg;			// [out] Returned image.
+			bool extImgQueued;			// [out] True if an external image download was queued.
+			bool degraded;				// [out] True if a lower-quality image was returned to meet the time budget.
 		};
 
 		/**
@@ -166,6 +254,114 @@ class TCreateThumbnail
 		 */
 		int getThumbnail(const char *filename, int reqSize, GetThumbnailOutParams_t *pOutParams);
 
+	private:
+		/**
+		 * Create a thumbnail for the specified ROM file.
+		 * The time budget is counted from m_budgetStart.
+		 * @param romData	[in] RomData object.
+		 * @param reqSize	[in] Requested image size. (single dimension; assuming square image)
+		 * @param pOutParams	[out] Output parameters.
+		 * @return 0 on success; non-zero on error.
+		 */
+		int getThumbnail_int(const LibRpBase::RomData *romData, int reqSize, GetThumbnailOutParams_t *pOutParams);
+
+	public:
+		/**
+		 * Enable asynchronous external image downloads.
+		 *
+		 * If enabled, external images that aren't cached yet are
+		 * downloaded in the background instead of blocking
+		 * getThumbnail(). The next image type in the priority list,
+		 * usually an internal image, is returned in the meantime,
+		 * and GetThumbnailOutParams_t::extImgQueued is set.
+		 *
+		 * If a download was queued, the callback will be called
+		 * exactly once from a background thread when the download
+		 * has finished. The thumbnail can then be regenerated to
+		 * get the external image from the cache.
+		 *
+		 * NOTE: Only one download is queued per getThumbnail() call.
+		 *
+		 * @param pfnExtImgReady Callback, or nullptr to download synchronously. (default)
+		 * @param userdata User data for the callback.
+		 */
+		void setAsyncExtImgCallback(CacheManager::PFN_DOWNLOAD_COMPLETE pfnExtImgReady, void *userdata)
+		{
+			m_pfnExtImgReady = pfnExtImgReady;
+			m_extImgReadyUserData = userdata;
+		}
+
+		/**
+		 * Default number of external image types to prefetch.
+		 * This matches the number of concurrent downloads
+		 * allowed by CacheManager.
+		 */
+		static const unsigned int DEFAULT_EXT_IMG_PREFETCH_COUNT = 2;
+
+		/**
+		 * Set the number of external image types to prefetch.
+		 *
+		 * When downloading synchronously, getThumbnail() normally
+		 * downloads each external image type in priority order,
+		 * waiting for each download to finish before trying the
+		 * next type. If prefetching is enabled, the first count
+		 * external image types that aren't cached yet are
+		 * downloaded concurrently, and the highest-priority image
+		 * that was downloaded successfully is used.
+		 *
+		 * @param count Number of image types. (0 or 1 to disable)
+		 */
+		void setExtImgPrefetchCount(unsigned int count)
+		{
+			m_extImgPrefetchCount = count;
+		}
+
+		/**
+		 * Set the cancellation token for getThumbnail().
+		 *
+		 * The token is set as the calling thread's CancelToken while
+		 * getThumbnail() is running. If it's cancelled, RomData
+		 * detection, disc image reads, and image decoding stop early,
+		 * and getThumbnail() returns RPCT_CANCELLED.
+		 *
+		 * @param cancelToken CancelToken, or nullptr to only use the calling thread's token. (default)
+		 */
+		void setCancelToken(const LibRpThreads::CancelToken *cancelToken)
+		{
+			m_cancelToken = cancelToken;
+		}
+
+		/**
+		 * Suggested time budget for interactive thumbnailing, in milliseconds.
+		 */
+		static const unsigned int DEFAULT_INTERACTIVE_TIME_BUDGET_MS = 100;
+
+		/**
+		 * Set the time budget for getThumbnail().
+		 *
+		 * If a time budget is set, getThumbnail() returns a
+		 * lower-quality thumbnail instead of going over it:
+		 * - External images are only loaded from the cache.
+		 *   (Asynchronous downloads are still queued.)
+		 * - If half of the budget has been used up before an
+		 *   internal image is loaded, the icon is used instead,
+		 *   or a smaller version of the image is loaded, e.g. a
+		 *   lower-resolution mipmap.
+		 *
+		 * GetThumbnailOutParams_t::degraded is set if this
+		 * happened, so the caller can regenerate the thumbnail
+		 * later without a time budget.
+		 *
+		 * The budget includes RomData detection if getThumbnail()
+		 * is called with a file or filename.
+		 *
+		 * @param ms Time budget, in milliseconds. (0 for no limit; default)
+		 */
+		void setTimeBudget(unsigned int ms)
+		{
+			m_timeBudgetMs = ms;
+		}
+
 	protected:
 		/**
 		 * Rescale a size while maintaining the aspect ratio.
@@ -175,6 +371,48 @@ class TCreateThumbnail
 		 */
 		static inline void rescale_aspect(ImgSize &rs_size, const ImgSize &tgt_size);
 
+		/**
+		 * Calculate the size for nearest-neighbor upscaling.
+		 * Used for images with IMGPF_RESCALE_NEAREST.
+		 * @param fullSize	[in] Full image size.
+		 * @param reqSize	[in] Requested thumbnail size.
+		 * @param pOutSize	[out] Upscaled size.
+		 * @return True if the image should be upscaled; false if not.
+		 */
+		static bool calcRescaleNearestSize(const ImgSize &fullSize, int reqSize, ImgSize *pOutSize);
+
+		/**
+		 * Calculate the final thumbnail size.
+		 * This combines 8:7 pixel aspect ratio correction and
+		 * nearest-neighbor upscaling, so the image only has to
+		 * be resampled once.
+		 * @param fullSize	[in,out] Image size. (adjusted for the pixel aspect ratio on return)
+		 * @param imgpf		[in] Image processing flags.
+		 * @param reqSize	[in] Requested thumbnail size.
+		 * @param pOutSize	[out] Thumbnail size.
+		 * @return True if the image needs to be rescaled; false if not.
+		 */
+		static bool calcThumbnailSize(ImgSize &fullSize, uint32_t imgpf, int reqSize, ImgSize *pOutSize);
+
+		/**
+		 * Is the time budget at risk?
+		 * @return True if more than half of the time budget has been used; false if not, or if no time budget is set.
+		 */
+		bool isTimeBudgetAtRisk(void) const;
+
+		/**
+		 * Download the highest-priority external image types concurrently.
+		 * The images are downloaded to the cache, so getExternalImage()
+		 * can load them without waiting for each download in turn.
+		 * @param romData	[in] RomData object.
+		 * @param imgTypes	[in] Image types, in priority order.
+		 * @param count		[in] Number of image types.
+		 * @param imgbf		[in] Image types that may be present.
+		 * @param reqSize	[in] Requested image size.
+		 */
+		void prefetchExternalImages(const LibRpBase::RomData *romData,
+			const uint8_t *imgTypes, unsigned int count, uint32_t imgbf, int reqSize);
+
 	protected:
 		/** Pure virtual functions. **/
 
@@ -185,6 +423,22 @@ class TCreateThumbnail
 		 */
 		virtual ImgClass rpImageToImgClass(const LibRpTexture::rp_image *img) const = 0;
 
+		/**
+		 * Does rpImageToImgClass() keep the original image size?
+		 *
+		 * If it does, internal images that need nearest-neighbor
+		 * upscaling or 8:7 aspect ratio correction are rescaled to
+		 * ARGB32 as rp_image before conversion to ImgClass. CI8 images
+		 * are converted during the rescale, so there's no full-size
+		 * ARGB32 copy.
+		 *
+		 * @return True if rpImageToImgClass() keeps the original image size.
+		 */
+		virtual bool rpImageToImgClassKeepsSize(void) const
+		{
+			return false;
+		}
+
 		/**
 		 * Wrapper function to check if an ImgClass is valid.
 		 * @param imgClass ImgClass
@@ -235,6 +489,22 @@ class TCreateThumbnail
 		 * @return Proxy, or empty string if no proxy is needed.
 		 */
 		virtual std::string proxyForUrl(const std::string &url) const = 0;
+
+	private:
+		// Asynchronous external image downloads.
+		CacheManager::PFN_DOWNLOAD_COMPLETE m_pfnExtImgReady;
+		void *m_extImgReadyUserData;
+		bool m_extImgQueued;	// True if a download was queued by the current getThumbnail() call.
+		unsigned int m_extImgPrefetchCount;	// Number of external image types to prefetch.
+
+		// Cancellation token. (not owned by TCreateThumbnail)
+		const LibRpThreads::CancelToken *m_cancelToken;
+
+		// Time budget.
+		unsigned int m_timeBudgetMs;	// 0 for no limit
+		std::chrono::steady_clock::time_point m_budgetStart;
+		bool m_extImgCacheOnly;	// True if external images should only be loaded from the cache.
+		bool m_degraded;	// True if the current getThumbnail() call returned a lower-quality image.
 };
 
 }
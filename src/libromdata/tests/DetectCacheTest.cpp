@@ -0,0 +1,279 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * DetectCacheTest.cpp: DetectCache test.                                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// libromdata
+#include "DetectCache.hpp"
+
+// librpfile
+#include "librpfile/FileSystem.hpp"
+using namespace LibRpFile;
+
+// libcachecommon
+#include "libcachecommon/CacheDir.hpp"
+
+// C includes.
+#include <stdlib.h>
+#include <unistd.h>
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ STL classes.
+using std::string;
+
+namespace LibRomData { namespace Tests {
+
+// Temporary cache directory. (set by gtest_main())
+static char tmp_cache_dir[] = "/tmp/rpDetectCacheTest.XXXXXX";
+
+// Sizes from the detection cache file format.
+static const off64_t HEADER_SIZE = 8;
+static const off64_t ENTRY_SIZE = 32;
+
+class DetectCacheTest : public ::testing::Test
+{
+	protected:
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+	public:
+		/**
+		 * Get the detection cache filename.
+		 * @return Detection cache filename.
+		 */
+		static string cacheFilename(void)
+		{
+			return LibCacheCommon::getCacheDirectory() + "/detect.bin";
+		}
+
+		/**
+		 * Get the detection cache file size.
+		 * @return File size, or -1 if the file doesn't exist.
+		 */
+		static off64_t cacheFileSize(void)
+		{
+			off64_t fileSize = 0;
+			time_t mtime = 0;
+			if (FileSystem::get_file_size_and_mtime(cacheFilename(), &fileSize, &mtime) != 0) {
+				return -1;
+			}
+			return fileSize;
+		}
+
+		/**
+		 * Discard the in-memory cache so the file is reloaded.
+		 */
+		static void reload(void)
+		{
+			DetectCache::setEnabled(false);
+			DetectCache::setEnabled(true);
+		}
+
+		/**
+		 * Check if a file is in the detection cache with the specified values.
+		 * @param filename	[in] Filename.
+		 * @param fileSize	[in] File size.
+		 * @param mtime		[in] File modification time.
+		 * @param classHash	[in] Expected class name hash.
+		 * @param address	[in] Expected header address.
+		 */
+		static ::testing::AssertionResult isCached(const char *filename, off64_t fileSize, time_t mtime,
+			uint32_t classHash, uint32_t address)
+		{
+			uint32_t gotClassHash = 0, gotAddress = 0;
+			if (!DetectCache::lookup(filename, fileSize, mtime, &gotClassHash, &gotAddress)) {
+				return ::testing::AssertionFailure() << filename << " is not cached";
+			}
+			if (gotClassHash != classHash || gotAddress != address) {
+				return ::testing::AssertionFailure() << filename << " has the wrong class or address";
+			}
+			return ::testing::AssertionSuccess();
+		}
+};
+
+void DetectCacheTest::SetUp(void)
+{
+	// Start with an empty cache.
+	DetectCache::setEnabled(false);
+	FileSystem::delete_file(cacheFilename());
+	DetectCache::setEnabled(true);
+}
+
+void DetectCacheTest::TearDown(void)
+{
+	DetectCache::setEnabled(false);
+	FileSystem::delete_file(cacheFilename());
+}
+
+/**
+ * Store, look up, and remove a file.
+ */
+TEST_F(DetectCacheTest, lookupStoreRemove)
+{
+	const uint32_t snesHash = DetectCache::hashClassName("SNES");
+	uint32_t classHash = 0, address = 0;
+	EXPECT_FALSE(DetectCache::lookup("/roms/test.sfc", 1024, 1000, &classHash, &address));
+
+	ASSERT_EQ(0, DetectCache::store("/roms/test.sfc", 1024, 1000, snesHash, 0x7FC0));
+	EXPECT_TRUE(isCached("/roms/test.sfc", 1024, 1000, snesHash, 0x7FC0));
+	EXPECT_EQ(HEADER_SIZE + ENTRY_SIZE, cacheFileSize());
+
+	// A different size or mtime means the file has changed.
+	EXPECT_FALSE(DetectCache::lookup("/roms/test.sfc", 1025, 1000, &classHash, &address));
+	EXPECT_FALSE(DetectCache::lookup("/roms/test.sfc", 1024, 1001, &classHash, &address));
+	EXPECT_FALSE(DetectCache::lookup("/roms/other.sfc", 1024, 1000, &classHash, &address));
+
+	// Storing the same result again doesn't write anything.
+	ASSERT_EQ(0, DetectCache::store("/roms/test.sfc", 1024, 1000, snesHash, 0x7FC0));
+	EXPECT_EQ(HEADER_SIZE + ENTRY_SIZE, cacheFileSize());
+
+	// The result is loaded from the file.
+	reload();
+	EXPECT_TRUE(isCached("/roms/test.sfc", 1024, 1000, snesHash, 0x7FC0));
+
+	// Remove the file.
+	ASSERT_EQ(0, DetectCache::remove("/roms/test.sfc"));
+	EXPECT_FALSE(DetectCache::lookup("/roms/test.sfc", 1024, 1000, &classHash, &address));
+	reload();
+	EXPECT_FALSE(DetectCache::lookup("/roms/test.sfc", 1024, 1000, &classHash, &address));
+}
+
+/**
+ * The last entry for a file is used.
+ */
+TEST_F(DetectCacheTest, storeUpdate)
+{
+	const uint32_t nesHash = DetectCache::hashClassName("NES");
+	const uint32_t mdHash = DetectCache::hashClassName("MegaDrive");
+	ASSERT_EQ(0, DetectCache::store("/roms/a.bin", 0x20000, 1000, nesHash, 0));
+	ASSERT_EQ(0, DetectCache::store("/roms/b.bin", 0x40000, 2000, nesHash, 0));
+	ASSERT_EQ(0, DetectCache::store("/roms/a.bin", 0x20000, 1001, mdHash, 0x100));
+	EXPECT_EQ(HEADER_SIZE + (3 * ENTRY_SIZE), cacheFileSize());
+
+	reload();
+	EXPECT_TRUE(isCached("/roms/a.bin", 0x20000, 1001, mdHash, 0x100));
+	EXPECT_TRUE(isCached("/roms/b.bin", 0x40000, 2000, nesHash, 0));
+}
+
+/**
+ * A partially-written record from an interrupted append is skipped,
+ * and is overwritten by the next entry.
+ */
+TEST_F(DetectCacheTest, tornRecord)
+{
+	const uint32_t snesHash = DetectCache::hashClassName("SNES");
+	ASSERT_EQ(0, DetectCache::store("/roms/a.sfc", 1024, 1000, snesHash, 0x7FC0));
+
+	// Append part of a record.
+	FILE *f = fopen(cacheFilename().c_str(), "ab");
+	ASSERT_TRUE(f != nullptr);
+	static const uint8_t partial[13] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x12, 0x34, 0x56, 0x78, 0x9A};
+	EXPECT_EQ(sizeof(partial), fwrite(partial, 1, sizeof(partial), f));
+	fclose(f);
+	ASSERT_EQ(HEADER_SIZE + ENTRY_SIZE + static_cast<off64_t>(sizeof(partial)), cacheFileSize());
+
+	reload();
+	EXPECT_TRUE(isCached("/roms/a.sfc", 1024, 1000, snesHash, 0x7FC0));
+
+	ASSERT_EQ(0, DetectCache::store("/roms/b.sfc", 2048, 2000, snesHash, 0xFFC0));
+	EXPECT_EQ(HEADER_SIZE + (2 * ENTRY_SIZE), cacheFileSize());
+
+	reload();
+	EXPECT_TRUE(isCached("/roms/a.sfc", 1024, 1000, snesHash, 0x7FC0));
+	EXPECT_TRUE(isCached("/roms/b.sfc", 2048, 2000, snesHash, 0xFFC0));
+}
+
+/**
+ * The file is rewritten with only the live entries
+ * if it has too many dead records.
+ */
+TEST_F(DetectCacheTest, compaction)
+{
+	const uint32_t nesHash = DetectCache::hashClassName("NES");
+	const uint32_t snesHash = DetectCache::hashClassName("SNES");
+	static const unsigned int COUNT = 1100;
+	for (unsigned int i = 0; i < COUNT; i++) {
+		ASSERT_EQ(0, DetectCache::store("/roms/a.nes", 40976, 1000 + i, nesHash, 0));
+	}
+	ASSERT_EQ(0, DetectCache::store("/roms/b.sfc", 1024, 1000, snesHash, 0x7FC0));
+	ASSERT_EQ(0, DetectCache::store("/roms/c.sfc", 1024, 1000, snesHash, 0x7FC0));
+	ASSERT_EQ(0, DetectCache::remove("/roms/c.sfc"));
+	ASSERT_EQ(HEADER_SIZE + ((COUNT + 3) * ENTRY_SIZE), cacheFileSize());
+
+	// Loading the file compacts it.
+	reload();
+	EXPECT_TRUE(isCached("/roms/a.nes", 40976, 1000 + COUNT - 1, nesHash, 0));
+	EXPECT_TRUE(isCached("/roms/b.sfc", 1024, 1000, snesHash, 0x7FC0));
+	uint32_t classHash = 0, address = 0;
+	EXPECT_FALSE(DetectCache::lookup("/roms/c.sfc", 1024, 1000, &classHash, &address));
+	EXPECT_EQ(HEADER_SIZE + (2 * ENTRY_SIZE), cacheFileSize());
+	EXPECT_NE(0, access((cacheFilename() + ".tmp").c_str(), F_OK));
+
+	// The compacted file can be loaded.
+	reload();
+	EXPECT_TRUE(isCached("/roms/a.nes", 40976, 1000 + COUNT - 1, nesHash, 0));
+	EXPECT_TRUE(isCached("/roms/b.sfc", 1024, 1000, snesHash, 0x7FC0));
+}
+
+/**
+ * A disabled cache doesn't look up or store anything.
+ */
+TEST_F(DetectCacheTest, disabled)
+{
+	const uint32_t snesHash = DetectCache::hashClassName("SNES");
+	ASSERT_EQ(0, DetectCache::store("/roms/a.sfc", 1024, 1000, snesHash, 0x7FC0));
+
+	DetectCache::setEnabled(false);
+	EXPECT_FALSE(DetectCache::isEnabled());
+	uint32_t classHash = 0, address = 0;
+	EXPECT_FALSE(DetectCache::lookup("/roms/a.sfc", 1024, 1000, &classHash, &address));
+	EXPECT_EQ(-ENOTSUP, DetectCache::store("/roms/b.sfc", 1024, 1000, snesHash, 0x7FC0));
+	EXPECT_EQ(HEADER_SIZE + ENTRY_SIZE, cacheFileSize());
+
+	DetectCache::setEnabled(true);
+	EXPECT_TRUE(isCached("/roms/a.sfc", 1024, 1000, snesHash, 0x7FC0));
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: DetectCache tests.\n\n");
+	fflush(nullptr);
+
+	// Use a temporary cache directory.
+	// NOTE: This must be done before the cache directory is used.
+	char *const tmp_cache_dir = LibRomData::Tests::tmp_cache_dir;
+	if (!mkdtemp(tmp_cache_dir)) {
+		fprintf(stderr, "*** ERROR: Unable to create a temporary directory: %s\n", strerror(errno));
+		return EXIT_FAILURE;
+	}
+	setenv("XDG_CACHE_HOME", tmp_cache_dir, 1);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	const int ret = RUN_ALL_TESTS();
+
+	// Remove the temporary cache directory.
+	// NOTE: The detection cache file is deleted by each test.
+	const string &cache_dir = LibCacheCommon::getCacheDirectory();
+	if (!cache_dir.empty()) {
+		rmdir(cache_dir.c_str());
+	}
+	rmdir(tmp_cache_dir);
+	return ret;
+}
@@ -0,0 +1,125 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * NdsCrcTest.cpp: Nintendo DS CRC16 test.                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// CalcCrc16()
+#include "common.h"
+#include "../Handheld/nds_crc.hpp"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+
+// C++ includes.
+#include <algorithm>
+#include <vector>
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+class NdsCrcTest : public ::testing::Test
+{
+	protected:
+		void SetUp(void) final
+		{
+			// Deterministic pseudo-random test data.
+			m_data.resize(TEST_DATA_SIZE);
+			uint32_t seed = 0x12345678;
+			for (uint8_t &byte : m_data) {
+				seed = seed * 1103515245U + 12345U;
+				byte = static_cast<uint8_t>(seed >> 16);
+			}
+		}
+
+	public:
+		// Secure Area size, plus some extra bytes
+		// so the length isn't a multiple of 8.
+		static const size_t TEST_DATA_SIZE = 0x4000 + 13;
+
+		vector<uint8_t> m_data;
+
+		/**
+		 * Reference CRC16 implementation. (byte-at-a-time)
+		 * @param data Data.
+		 * @param length Length of data.
+		 * @param crc Initial CRC.
+		 * @return CRC16.
+		 */
+		static uint16_t CalcCrc16_ref(const uint8_t *data, size_t length, uint16_t crc = 0xFFFF)
+		{
+			for (; length > 0; length--, data++) {
+				crc = (crc >> 8) ^ crc16tab[0][(crc ^ *data) & 0xFF];
+			}
+			return crc;
+		}
+};
+
+/**
+ * Test CalcCrc16() using the standard check string.
+ * The DS CRC16 is CRC-16/MODBUS.
+ */
+TEST_F(NdsCrcTest, checkString)
+{
+	static const char check[] = "123456789";
+	EXPECT_EQ(0x4B37, CalcCrc16(reinterpret_cast<const uint8_t*>(check), sizeof(check)-1));
+}
+
+/**
+ * Test CalcCrc16() against the byte-at-a-time table
+ * using various lengths and alignments.
+ */
+TEST_F(NdsCrcTest, compareToReference)
+{
+	const uint8_t *const pData = m_data.data();
+	for (size_t offset = 0; offset < 8; offset++) {
+		for (size_t len = 0; len <= 64; len++) {
+			EXPECT_EQ(CalcCrc16_ref(&pData[offset], len), CalcCrc16(&pData[offset], len)) <<
+				"offset == " << offset << ", len == " << len;
+		}
+
+		const size_t len = TEST_DATA_SIZE - offset;
+		EXPECT_EQ(CalcCrc16_ref(&pData[offset], len), CalcCrc16(&pData[offset], len)) <<
+			"offset == " << offset << ", len == " << len;
+	}
+}
+
+/**
+ * Test CalcCrc16() with a non-default initial CRC,
+ * and with the data split into multiple chunks.
+ */
+TEST_F(NdsCrcTest, chunked)
+{
+	const uint8_t *const pData = m_data.data();
+	const uint16_t crc_exp = CalcCrc16_ref(pData, TEST_DATA_SIZE, 0x1234);
+
+	uint16_t crc = 0x1234;
+	size_t pos = 0;
+	for (size_t chunk = 1; pos < TEST_DATA_SIZE; chunk += 7) {
+		const size_t len = std::min(chunk, TEST_DATA_SIZE - pos);
+		crc = CalcCrc16(&pData[pos], len, crc);
+		pos += len;
+	}
+	EXPECT_EQ(crc_exp, crc);
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: Nintendo DS CRC16 tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
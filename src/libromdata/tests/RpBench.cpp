@@ -0,0 +1,506 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * RpBench.cpp: End-to-end throughput benchmark over a corpus directory.   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// librpbase, librpfile, librptexture
+#include "librpbase/RomData.hpp"
+#include "librpbase/img/RpPng.hpp"
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpAllocStats.hpp"
+#include "librpfile/RpFile_mmap.hpp"
+#include "librpfile/RpVectorFile.hpp"
+#include "librptexture/img/rp_image.hpp"
+using namespace LibRpBase;
+using namespace LibRpFile;
+using LibRpTexture::rp_image;
+
+// libromdata
+#include "libromdata/RomDataFactory.hpp"
+using LibRomData::RomDataFactory;
+
+// i18n
+#include "libi18n/i18n.h"
+
+// C includes.
+#include <stdlib.h>
+#ifdef _WIN32
+# include "libwin32common/RpWin32_sdk.h"
+# include <psapi.h>
+#else /* !_WIN32 */
+# include <sys/resource.h>
+# include <unistd.h>
+#endif /* _WIN32 */
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+using std::map;
+using std::ofstream;
+using std::string;
+using std::vector;
+
+// librpsecure
+#include "librpsecure/os-secure.h"
+
+// Directory separator. (tcharx.h's DIR_SEP_CHR is a TCHAR)
+#ifdef _WIN32
+static const char dir_sep = '\\';
+#else /* !_WIN32 */
+static const char dir_sep = '/';
+#endif /* _WIN32 */
+
+// Thumbnail size for the scaling phase. (same as the default XDG thumbnail size)
+static const int THUMBNAIL_SIZE = 256;
+
+/**
+ * Benchmark phases.
+ */
+enum BenchPhase {
+	PHASE_HEADER = 0,	// Header read and detection
+	PHASE_CREATE,		// RomDataFactory::create()
+	PHASE_FIELDS,		// loadFieldData()
+	PHASE_IMAGE,		// Internal image decoding
+	PHASE_SCALE,		// Thumbnail scaling
+	PHASE_PNG,		// PNG write
+
+	PHASE_MAX
+};
+
+static const char *const phase_names[PHASE_MAX] = {
+	"header", "create", "fields", "image", "scale", "png"
+};
+
+/**
+ * Per-class statistics.
+ */
+struct ClassStats {
+	unsigned int count;
+	size_t maxRss;			// Maximum resident memory after a file, in bytes.
+	uint64_t totalInstMem;		// Total per-instance memory, in bytes.
+	size_t maxInstMem;		// Maximum per-instance memory, in bytes.
+	vector<double> times[PHASE_MAX];	// Phase times, in milliseconds.
+
+	ClassStats()
+		: count(0), maxRss(0)
+		, totalInstMem(0), maxInstMem(0)
+	{ }
+};
+
+/**
+ * Get the current resident memory size.
+ * @return Resident memory size, in bytes. (0 if unknown)
+ */
+static size_t getResidentMemory(void)
+{
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+		return pmc.WorkingSetSize;
+	}
+	return 0;
+#elif defined(__linux__)
+	// statm: size resident shared text lib data dt (in pages)
+	FILE *f = fopen("/proc/self/statm", "r");
+	if (!f)
+		return 0;
+	unsigned long size = 0, resident = 0;
+	const int ret = fscanf(f, "%lu %lu", &size, &resident);
+	fclose(f);
+	return (ret == 2 ? static_cast<size_t>(resident) * sysconf(_SC_PAGESIZE) : 0);
+#else
+	// No portable way to get the current RSS.
+	// Use the peak RSS instead.
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru) != 0)
+		return 0;
+# ifdef __APPLE__
+	return static_cast<size_t>(ru.ru_maxrss);	// bytes
+# else
+	return static_cast<size_t>(ru.ru_maxrss) * 1024;	// KB
+# endif
+#endif
+}
+
+/**
+ * Get the peak resident memory size.
+ * @return Peak resident memory size, in bytes. (0 if unknown)
+ */
+static size_t getPeakResidentMemory(void)
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+		return pmc.PeakWorkingSetSize;
+	}
+	return 0;
+#else /* !_WIN32 */
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru) != 0)
+		return 0;
+# ifdef __APPLE__
+	return static_cast<size_t>(ru.ru_maxrss);	// bytes
+# else
+	return static_cast<size_t>(ru.ru_maxrss) * 1024;	// KB
+# endif
+#endif /* _WIN32 */
+}
+
+/**
+ * Recursively find all files in a directory.
+ * @param dirname	[in] Directory name.
+ * @param vFiles	[out] Full pathnames.
+ */
+static void walkCorpus(const string &dirname, vector<string> &vFiles)
+{
+	vector<string> vEntries, vSubdirs;
+	if (FileSystem::read_dir(dirname, vEntries, &vSubdirs) != 0)
+		return;
+
+	string path = dirname;
+	if (!path.empty() && path[path.size()-1] != dir_sep) {
+		path += dir_sep;
+	}
+
+	std::sort(vEntries.begin(), vEntries.end());
+	for (const string &name : vEntries) {
+		vFiles.emplace_back(path + name);
+	}
+	std::sort(vSubdirs.begin(), vSubdirs.end());
+	for (const string &name : vSubdirs) {
+		walkCorpus(path + name, vFiles);
+	}
+}
+
+/**
+ * Get a percentile from a vector of times.
+ * The vector will be sorted.
+ * @param v	[in/out] Times.
+ * @param pct	[in] Percentile. (0-100)
+ * @return Percentile value, or 0 if the vector is empty.
+ */
+static double percentile(vector<double> &v, int pct)
+{
+	if (v.empty())
+		return 0;
+	std::sort(v.begin(), v.end());
+	// Nearest-rank method.
+	size_t rank = (v.size() * pct + 99) / 100;
+	if (rank > 0)
+		rank--;
+	return v[std::min(rank, v.size() - 1)];
+}
+
+/**
+ * Escape a string for JSON output.
+ * @param str String.
+ * @return Escaped string.
+ */
+static string jsonEscape(const char *str)
+{
+	string ret;
+	for (; *str != '\0'; str++) {
+		const char chr = *str;
+		switch (chr) {
+			case '"':	ret += "\\\""; break;
+			case '\\':	ret += "\\\\"; break;
+			case '\n':	ret += "\\n"; break;
+			case '\t':	ret += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(chr) < 0x20) {
+					char buf[8];
+					snprintf(buf, sizeof(buf), "\\u%04X", static_cast<unsigned char>(chr));
+					ret += buf;
+				} else {
+					ret += chr;
+				}
+				break;
+		}
+	}
+	return ret;
+}
+
+/**
+ * Benchmark a single file.
+ * @param filename	[in] Filename.
+ * @param stats		[in/out] Per-class statistics.
+ * @return True if the file was supported; false if not.
+ */
+static bool benchFile(const char *filename, map<string, ClassStats> &stats)
+{
+	typedef std::chrono::steady_clock clock;
+	double times[PHASE_MAX];
+	std::fill(times, times + PHASE_MAX, 0.0);
+	auto ms_since = [](clock::time_point start) -> double {
+		return std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	};
+
+	IRpFile *const file = RpFile_mmap::openReadOnly(filename);
+	if (!file->isOpen()) {
+		file->unref();
+		return false;
+	}
+
+	// Header read and detection.
+	clock::time_point start = clock::now();
+	const RomDataFactory::DetectResult detect = RomDataFactory::detect(file);
+	times[PHASE_HEADER] = ms_since(start);
+	if (!detect.className) {
+		// Not supported.
+		file->unref();
+		return false;
+	}
+
+	// RomData construction.
+	// Resident memory is measured from here until after
+	// RomData::compact() to get the per-instance memory usage.
+	const size_t rssBefore = getResidentMemory();
+	start = clock::now();
+	RomData *const romData = RomDataFactory::create(file);
+	times[PHASE_CREATE] = ms_since(start);
+	file->unref();
+	if (!romData) {
+		return false;
+	}
+
+	// Field data.
+	start = clock::now();
+	romData->fields();
+	times[PHASE_FIELDS] = ms_since(start);
+
+	// Internal images.
+	// The first image is used for the thumbnail phases.
+	const rp_image *thumbSrc = nullptr;
+	uint32_t thumbImgpf = 0;
+	const uint32_t imgbf = romData->supportedImageTypes();
+	start = clock::now();
+	for (int i = RomData::IMG_INT_MIN; i <= RomData::IMG_INT_MAX; i++) {
+		if (!(imgbf & (1U << i)))
+			continue;
+		const rp_image *const img = romData->image(static_cast<RomData::ImageType>(i));
+		if (img && img->isValid() && !thumbSrc) {
+			thumbSrc = img;
+			thumbImgpf = romData->imgpf(static_cast<RomData::ImageType>(i));
+		}
+	}
+	times[PHASE_IMAGE] = ms_since(start);
+
+	if (thumbSrc) {
+		// Thumbnail scaling.
+		// NOTE: Aspect ratio is preserved, and images
+		// are only scaled if they're too large.
+		int width = thumbSrc->width();
+		int height = thumbSrc->height();
+		if (width > THUMBNAIL_SIZE || height > THUMBNAIL_SIZE) {
+			if (width > height) {
+				height = std::max(1, height * THUMBNAIL_SIZE / width);
+				width = THUMBNAIL_SIZE;
+			} else {
+				width = std::max(1, width * THUMBNAIL_SIZE / height);
+				height = THUMBNAIL_SIZE;
+			}
+		}
+
+		start = clock::now();
+		rp_image *const thumb = thumbSrc->scaled(width, height,
+			(thumbImgpf & RomData::IMGPF_RESCALE_NEAREST) ? rp_image::SCALE_NEAREST : rp_image::SCALE_BOX);
+		times[PHASE_SCALE] = ms_since(start);
+
+		// PNG write. (in memory)
+		RpVectorFile *const pngFile = new RpVectorFile();
+		start = clock::now();
+		RpPng::save(pngFile, thumb ? thumb : thumbSrc);
+		times[PHASE_PNG] = ms_since(start);
+		pngFile->unref();
+		UNREF(thumb);
+	}
+
+	// Release the file and parsing buffers, then measure
+	// how much memory this instance is still holding.
+	romData->compact(imgbf);
+	const size_t rssAfter = getResidentMemory();
+	const size_t instMem = (rssAfter > rssBefore ? rssAfter - rssBefore : 0);
+
+	const char *className = romData->className();
+	ClassStats &cs = stats[className ? className : detect.className];
+	cs.count++;
+	for (int i = 0; i < PHASE_MAX; i++) {
+		cs.times[i].push_back(times[i]);
+	}
+	cs.totalInstMem += instMem;
+	if (instMem > cs.maxInstMem) {
+		cs.maxInstMem = instMem;
+	}
+	romData->unref();
+
+	const size_t rss = getResidentMemory();
+	if (rss > cs.maxRss) {
+		cs.maxRss = rss;
+	}
+	return true;
+}
+
+int RP_C_API main(int argc, char *argv[])
+{
+	// Set OS-specific security options.
+	// TODO: Non-Windows syscall stuff.
+#ifdef _WIN32
+	rp_secure_param_t param;
+	param.bHighSec = FALSE;
+	rp_secure_enable(param);
+#endif /* _WIN32 */
+
+	// Initialize i18n.
+	rp_i18n_init();
+
+	// Parse the command line.
+	const char *corpus_dir = nullptr;
+	const char *json_filename = nullptr;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+			json_filename = argv[++i];
+		} else if (!corpus_dir) {
+			corpus_dir = argv[i];
+		} else {
+			corpus_dir = nullptr;
+			break;
+		}
+	}
+	if (!corpus_dir) {
+		fputs("Syntax: rp-bench [-j results.json] corpus_dir\n", stderr);
+		fputs("Times each RomData phase for every file in corpus_dir (recursive).\n", stderr);
+		fputs("Phases: header read, create, fields, image decode, thumbnail scaling, PNG write\n", stderr);
+		return EXIT_FAILURE;
+	}
+
+	vector<string> vFiles;
+	walkCorpus(corpus_dir, vFiles);
+	if (vFiles.empty()) {
+		fprintf(stderr, "*** ERROR: No files found in '%s'.\n", corpus_dir);
+		return EXIT_FAILURE;
+	}
+
+	map<string, ClassStats> stats;
+	unsigned int supported = 0;
+	const auto total_start = std::chrono::steady_clock::now();
+	for (const string &filename : vFiles) {
+		if (benchFile(filename.c_str(), stats)) {
+			supported++;
+		}
+	}
+	const double total_ms = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - total_start).count();
+	const size_t peakRss = getPeakResidentMemory();
+
+	// Calculate the percentiles.
+	struct Percentiles {
+		double p50[PHASE_MAX];
+		double p99[PHASE_MAX];
+	};
+	map<string, Percentiles> pct;
+	for (auto &iter : stats) {
+		Percentiles &p = pct[iter.first];
+		for (int i = 0; i < PHASE_MAX; i++) {
+			p.p50[i] = percentile(iter.second.times[i], 50);
+			p.p99[i] = percentile(iter.second.times[i], 99);
+		}
+	}
+
+	// Print the results.
+	printf("%u files, %u supported, %.1f ms total, peak RSS %zu KB\n",
+		static_cast<unsigned int>(vFiles.size()), supported, total_ms, peakRss / 1024);
+	printf("%-24s %6s", "class", "count");
+	for (int i = 0; i < PHASE_MAX; i++) {
+		printf(" %8s p50/p99", phase_names[i]);
+	}
+	printf(" %10s %10s %10s\n", "RSS (KB)", "inst avg", "inst max");
+	for (const auto &iter : stats) {
+		const Percentiles &p = pct[iter.first];
+		printf("%-24s %6u", iter.first.c_str(), iter.second.count);
+		for (int i = 0; i < PHASE_MAX; i++) {
+			printf(" %7.2f/%-8.2f", p.p50[i], p.p99[i]);
+		}
+		printf(" %10zu %10zu %10zu\n", iter.second.maxRss / 1024,
+			static_cast<size_t>(iter.second.totalInstMem / iter.second.count / 1024),
+			iter.second.maxInstMem / 1024);
+	}
+
+	if (RpAllocStats::isEnabled()) {
+		// Allocation statistics.
+		printf("\n%-24s %12s %14s %14s\n", "allocations", "count", "bytes", "peak (KB)");
+		for (int i = 0; i < RpAllocStats::TAG_MAX; i++) {
+			const RpAllocStats::Tag tag = static_cast<RpAllocStats::Tag>(i);
+			RpAllocStats::Counters counters;
+			RpAllocStats::get(tag, &counters);
+			printf("%-24s %12lld %14lld %14lld\n", RpAllocStats::name(tag),
+				static_cast<long long>(counters.count),
+				static_cast<long long>(counters.bytes),
+				static_cast<long long>(counters.peak / 1024));
+		}
+	}
+
+	if (json_filename) {
+		// Export the results as JSON.
+		ofstream json(json_filename);
+		if (!json.is_open()) {
+			fprintf(stderr, "*** ERROR: Unable to open '%s' for writing.\n", json_filename);
+			return EXIT_FAILURE;
+		}
+
+		char buf[64];
+		json << "{\n";
+		json << "\t\"files\": " << vFiles.size() << ",\n";
+		json << "\t\"supported\": " << supported << ",\n";
+		snprintf(buf, sizeof(buf), "%.3f", total_ms);
+		json << "\t\"total_ms\": " << buf << ",\n";
+		json << "\t\"peak_rss\": " << peakRss << ",\n";
+		json << "\t\"classes\": {";
+		bool first = true;
+		for (const auto &iter : stats) {
+			const Percentiles &p = pct[iter.first];
+			json << (first ? "\n" : ",\n");
+			first = false;
+			json << "\t\t\"" << jsonEscape(iter.first.c_str()) << "\": {\n";
+			json << "\t\t\t\"count\": " << iter.second.count << ",\n";
+			json << "\t\t\t\"max_rss\": " << iter.second.maxRss << ",\n";
+			json << "\t\t\t\"avg_instance_mem\": " << (iter.second.totalInstMem / iter.second.count) << ",\n";
+			json << "\t\t\t\"max_instance_mem\": " << iter.second.maxInstMem << ",\n";
+			for (int i = 0; i < PHASE_MAX; i++) {
+				snprintf(buf, sizeof(buf), "{\"p50_ms\": %.3f, \"p99_ms\": %.3f}",
+					p.p50[i], p.p99[i]);
+				json << "\t\t\t\"" << phase_names[i] << "\": " << buf
+				     << (i < PHASE_MAX - 1 ? ",\n" : "\n");
+			}
+			json << "\t\t}";
+		}
+		json << "\n\t}";
+		if (RpAllocStats::isEnabled()) {
+			json << ",\n\t\"allocations\": {";
+			for (int i = 0; i < RpAllocStats::TAG_MAX; i++) {
+				const RpAllocStats::Tag tag = static_cast<RpAllocStats::Tag>(i);
+				RpAllocStats::Counters counters;
+				RpAllocStats::get(tag, &counters);
+				json << (i == 0 ? "\n" : ",\n");
+				json << "\t\t\"" << RpAllocStats::name(tag) << "\": {"
+				     << "\"count\": " << counters.count << ", "
+				     << "\"bytes\": " << counters.bytes << ", "
+				     << "\"peak\": " << counters.peak << "}";
+			}
+			json << "\n\t}";
+		}
+		json << "\n}\n";
+	}
+
+	return EXIT_SUCCESS;
+}
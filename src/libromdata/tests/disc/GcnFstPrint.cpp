@@ -133,6 +133,13 @@ int RP_C_API main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// Build the path index.
+	// fstPrint() opens every subdirectory by path, so this
+	// speeds things up significantly for large FSTs.
+	// NOTE: If this fails, the FST can still be printed
+	// using linear path lookups.
+	fst->buildPathIndex();
+
 	// Print the FST to an ostringstream.
 	ostringstream oss;
 	LibRomData::fstPrint(fst, oss);
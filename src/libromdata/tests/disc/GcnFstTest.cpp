@@ -12,6 +12,7 @@
 // Google Test
 #include "gtest/gtest.h"
 #include "tcharx.h"
+#include "byteswap.h"
 
 // MiniZip
 #include <zlib.h>
@@ -20,12 +21,19 @@
 
 // librpbase, librpfile
 #include "librpbase/TextFuncs.hpp"
+#include "librpbase/disc/DiscReader.hpp"
 #include "librpfile/FileSystem.hpp"
+#include "librpfile/RpMemFile.hpp"
 using namespace LibRpBase;
+using LibRpFile::IRpFile;
+using LibRpFile::RpMemFile;
 
 // libromdata
 #include "disc/GcnFst.hpp"
+#include "disc/GcnPartition.hpp"
+#include "Console/gcn_structs.h"
 using LibRomData::GcnFst;
+using LibRomData::GcnPartition;
 
 // libwin32common
 #ifdef _WIN32
@@ -37,10 +45,12 @@ using LibRomData::GcnFst;
 
 // C includes. (C++ namespace)
 #include "ctypex.h"
+#include <ctime>
 
 // C++ includes.
 #include <sstream>
 #include <string>
+#include <memory>
 #include <unordered_set>
 #include <vector>
 using std::istringstream;
@@ -93,6 +103,7 @@ class GcnFstTest : public ::testing::TestWithParam<GcnFstTest_mode>
 		GcnFstTest()
 			: ::testing::TestWithParam<GcnFstTest_mode>()
 			, m_fst(nullptr)
+			, m_fst_start_offset(0)
 		{ }
 
 		void SetUp(void) final;
@@ -129,6 +140,39 @@ class GcnFstTest : public ::testing::TestWithParam<GcnFstTest_mode>
 		 */
 		void checkNoDuplicateFilenames(const char *subdir);
 
+		/**
+		 * Recursively get all paths in a subdirectory.
+		 * @param subdir	[in] Subdirectory path.
+		 * @param paths		[out] Vector for the paths.
+		 */
+		void getAllPaths(const char *subdir, vector<string> &paths);
+
+		/**
+		 * Reduce a list of paths to at most MAX_SAMPLE_PATHS paths,
+		 * evenly distributed throughout the original list.
+		 *
+		 * Linear path lookups are O(n) per lookup, so checking
+		 * all paths in large FSTs takes too long.
+		 *
+		 * @param paths	[in/out] Paths.
+		 */
+		static void samplePaths(vector<string> &paths);
+
+		// Maximum number of paths to check in path index tests.
+		static const size_t MAX_SAMPLE_PATHS = 1024;
+
+		/**
+		 * Create a second GcnFst with a path index.
+		 * @return GcnFst with a path index, or nullptr on error.
+		 */
+		GcnFst *createIndexedFst(void) const;
+
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 2;
+
+		// FST start offset in m_fst_buf.
+		unsigned int m_fst_start_offset;
+
 	public:
 		/** Test case parameters. **/
 
@@ -187,6 +231,7 @@ void GcnFstTest::SetUp(void)
 	}
 
 	// Create the GcnFst object.
+	m_fst_start_offset = fst_start_offset;
 	m_fst = new GcnFst(&m_fst_buf[fst_start_offset],
 		static_cast<uint32_t>(m_fst_buf.size() - fst_start_offset), mode.offsetShift);
 	ASSERT_TRUE(m_fst->isOpen());
@@ -376,6 +421,82 @@ void GcnFstTest::checkNoDuplicateFilenames(const char *subdir)
 	m_fst->closedir(dirp);
 }
 
+/**
+ * Recursively get all paths in a subdirectory.
+ * @param subdir	[in] Subdirectory path.
+ * @param paths		[out] Vector for the paths.
+ */
+void GcnFstTest::getAllPaths(const char *subdir, vector<string> &paths)
+{
+	IFst::Dir *dirp = m_fst->opendir(subdir);
+	ASSERT_TRUE(dirp != nullptr) <<
+		"Failed to open directory '" << subdir << "'.";
+
+	vector<string> subdirs;
+	IFst::DirEnt *dirent = m_fst->readdir(dirp);
+	while (dirent != nullptr) {
+		string path = subdir;
+		if (!path.empty() && path[path.size()-1] != '/') {
+			path += '/';
+		}
+		path += dirent->name;
+		if (dirent->type == DT_DIR) {
+			subdirs.emplace_back(path);
+		}
+		paths.emplace_back(std::move(path));
+
+		// Next entry.
+		dirent = m_fst->readdir(dirp);
+	}
+
+	// End of directory.
+	m_fst->closedir(dirp);
+
+	// Check subdirectories.
+	for (const string &path : subdirs) {
+		getAllPaths(path.c_str(), paths);
+	}
+}
+
+/**
+ * Reduce a list of paths to at most MAX_SAMPLE_PATHS paths,
+ * evenly distributed throughout the original list.
+ *
+ * Linear path lookups are O(n) per lookup, so checking
+ * all paths in large FSTs takes too long.
+ *
+ * @param paths	[in/out] Paths.
+ */
+void GcnFstTest::samplePaths(vector<string> &paths)
+{
+	const size_t stride = (paths.size() + MAX_SAMPLE_PATHS - 1) / MAX_SAMPLE_PATHS;
+	if (stride <= 1)
+		return;
+
+	// NOTE: paths[0] is already in place.
+	size_t j = 1;
+	for (size_t i = stride; i < paths.size(); i += stride, j++) {
+		paths[j] = std::move(paths[i]);
+	}
+	paths.resize(j);
+}
+
+/**
+ * Create a second GcnFst with a path index.
+ * @return GcnFst with a path index, or nullptr on error.
+ */
+GcnFst *GcnFstTest::createIndexedFst(void) const
+{
+	const GcnFstTest_mode &mode = GetParam();
+	GcnFst *const fst = new GcnFst(&m_fst_buf[m_fst_start_offset],
+		static_cast<uint32_t>(m_fst_buf.size() - m_fst_start_offset), mode.offsetShift);
+	if (!fst->isOpen() || fst->buildPathIndex() != 0) {
+		delete fst;
+		return nullptr;
+	}
+	return fst;
+}
+
 /**
  * Verify that '/' is collapsed correctly.
  */
@@ -400,6 +521,173 @@ TEST_P(GcnFstTest, NoDuplicateFilenames)
 	EXPECT_FALSE(m_fst->hasErrors());
 }
 
+/**
+ * Verify that find_file() returns the same results
+ * with and without the path index.
+ */
+TEST_P(GcnFstTest, PathIndex)
+{
+	vector<string> paths;
+	ASSERT_NO_FATAL_FAILURE(getAllPaths("/", paths));
+	samplePaths(paths);
+
+	// Add some path variants that should be normalized,
+	// plus some paths that shouldn't be found.
+	const size_t path_count = paths.size();
+	paths.reserve(path_count * 5 + 2);
+	for (size_t i = 0; i < path_count; i++) {
+		const string path = paths[i];
+		paths.emplace_back(path.substr(1));
+		paths.emplace_back("//" + path + '/');
+		paths.emplace_back(path + "/nonexistent");
+		paths.emplace_back(path + 'x');
+	}
+	paths.emplace_back("/nonexistent");
+	paths.emplace_back("///");
+
+	std::unique_ptr<GcnFst> idx_fst(createIndexedFst());
+	ASSERT_TRUE(idx_fst != nullptr) << "buildPathIndex() failed.";
+
+	for (const string &path : paths) {
+		IFst::DirEnt dirent_expected, dirent_actual;
+		const int ret_expected = m_fst->find_file(path.c_str(), &dirent_expected);
+		const int ret_actual = idx_fst->find_file(path.c_str(), &dirent_actual);
+		ASSERT_EQ(ret_expected, ret_actual) << "find_file('" << path << "') returned a different result.";
+		if (ret_expected != 0)
+			continue;
+
+		EXPECT_EQ(dirent_expected.type, dirent_actual.type) << "Path: " << path;
+		EXPECT_EQ(dirent_expected.offset, dirent_actual.offset) << "Path: " << path;
+		EXPECT_EQ(dirent_expected.size, dirent_actual.size) << "Path: " << path;
+		ASSERT_TRUE(dirent_actual.name != nullptr) << "Path: " << path;
+		EXPECT_STREQ(dirent_expected.name, dirent_actual.name) << "Path: " << path;
+	}
+	EXPECT_FALSE(idx_fst->hasErrors());
+}
+
+/**
+ * DiscReader that reports a large disc size,
+ * so file offsets in real FSTs are in bounds.
+ */
+class LargeDiscReader : public DiscReader
+{
+	public:
+		explicit LargeDiscReader(IRpFile *file)
+			: DiscReader(file)
+		{ }
+
+	public:
+		off64_t size(void) final
+		{
+			return 8LL*1024*1024*1024;
+		}
+};
+
+/**
+ * Verify that GcnPartition's partial FST lookups return
+ * the same results as a fully-loaded FST.
+ */
+TEST_P(GcnFstTest, PartialLookup)
+{
+	vector<string> paths;
+	ASSERT_NO_FATAL_FAILURE(getAllPaths("/", paths));
+	samplePaths(paths);
+
+	// Add some path variants that should be normalized,
+	// plus some paths that shouldn't be found.
+	const size_t path_count = paths.size();
+	paths.reserve(path_count * 3 + 2);
+	for (size_t i = 0; i < path_count; i++) {
+		const string path = paths[i];
+		paths.emplace_back(path.substr(1));
+		paths.emplace_back("//" + path + '/');
+		paths.emplace_back(path + "/nonexistent");
+	}
+	paths.emplace_back("/nonexistent");
+	paths.emplace_back("///");
+
+	// GcnPartition uses an offset shift of 0,
+	// so create a reference FST with the same shift.
+	const uint8_t *const fstData = &m_fst_buf[m_fst_start_offset];
+	const uint32_t fstData_len = static_cast<uint32_t>(m_fst_buf.size() - m_fst_start_offset);
+	GcnFst ref_fst(fstData, fstData_len, 0);
+	ASSERT_TRUE(ref_fst.isOpen());
+
+	// Create a minimal disc image with the FST.
+	static const uint32_t FST_OFFSET = 0x10000;
+	vector<uint8_t> image(FST_OFFSET + fstData_len, 0);
+	GCN_Boot_Block *const bootBlock = reinterpret_cast<GCN_Boot_Block*>(&image[GCN_Boot_Block_ADDRESS]);
+	bootBlock->fst_offset = cpu_to_be32(FST_OFFSET);
+	bootBlock->fst_size = cpu_to_be32(fstData_len);
+	bootBlock->fst_max_size = cpu_to_be32(fstData_len);
+	memcpy(&image[FST_OFFSET], fstData, fstData_len);
+
+	RpMemFile *const memFile = new RpMemFile(image.data(), image.size());
+	LargeDiscReader *const discReader = new LargeDiscReader(memFile);
+	GcnPartition *const partition = new GcnPartition(discReader, 0);
+
+	for (const string &path : paths) {
+		IFst::DirEnt dirent;
+		int ret_expected = ref_fst.find_file(path.c_str(), &dirent);
+		if (ret_expected != 0) {
+			ret_expected = -ENOENT;
+		} else if (dirent.type == DT_DIR) {
+			ret_expected = -EISDIR;
+		}
+
+		off64_t offset = 0, size = 0;
+		const int ret_actual = partition->findFileExtent(path.c_str(), &offset, &size);
+		ASSERT_EQ(ret_expected, ret_actual) << "findFileExtent('" << path << "') returned a different result.";
+		if (ret_expected != 0)
+			continue;
+
+		EXPECT_EQ(dirent.offset, offset) << "Path: " << path;
+		EXPECT_EQ(dirent.size, size) << "Path: " << path;
+	}
+
+	partition->unref();
+	discReader->unref();
+	memFile->unref();
+}
+
+/**
+ * Benchmark find_file() with and without the path index.
+ */
+TEST_P(GcnFstTest, PathIndexBenchmark)
+{
+	vector<string> paths;
+	ASSERT_NO_FATAL_FAILURE(getAllPaths("/", paths));
+	samplePaths(paths);
+
+	clock_t start = clock();
+	std::unique_ptr<GcnFst> idx_fst(createIndexedFst());
+	const clock_t build_ticks = clock() - start;
+	ASSERT_TRUE(idx_fst != nullptr) << "buildPathIndex() failed.";
+
+	IFst::DirEnt dirent;
+	start = clock();
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		for (const string &path : paths) {
+			m_fst->find_file(path.c_str(), &dirent);
+		}
+	}
+	const clock_t linear_ticks = clock() - start;
+
+	start = clock();
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		for (const string &path : paths) {
+			idx_fst->find_file(path.c_str(), &dirent);
+		}
+	}
+	const clock_t indexed_ticks = clock() - start;
+
+	printf("%u paths: linear %.3f ms, indexed %.3f ms (index build: %.3f ms)\n",
+		static_cast<unsigned int>(paths.size()),
+		static_cast<double>(linear_ticks) * 1000 / CLOCKS_PER_SEC,
+		static_cast<double>(indexed_ticks) * 1000 / CLOCKS_PER_SEC,
+		static_cast<double>(build_ticks) * 1000 / CLOCKS_PER_SEC);
+}
+
 /**
  * Print the FST directory structure and compare it to a known-good version.
  */
@@ -597,6 +885,7 @@ INSTANTIATE_TEST_SUITE_P(Wii, GcnFstTest,
 extern "C" int gtest_main(int argc, TCHAR *argv[])
 {
 	fprintf(stderr, "LibRomData test suite: GcnFst tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u\n", LibRomData::Tests::GcnFstTest::BENCHMARK_ITERATIONS);
 	fflush(nullptr);
 
 	// Make sure the CRC32 table is initialized.
@@ -0,0 +1,279 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * GczReaderTest.cpp: GCZ disc image reader test.                          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+#include "byteswap.h"
+
+// zlib
+#include <zlib.h>
+
+// librpfile
+#include "librpfile/RpMemFile.hpp"
+using LibRpFile::RpMemFile;
+
+// libromdata
+#include "disc/GczReader.hpp"
+#include "disc/gcz_structs.h"
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+/**
+ * Test parameter: Number of blocks to cache. (0 to disable)
+ */
+class GczReaderTest : public ::testing::TestWithParam<unsigned int>
+{
+	protected:
+		GczReaderTest()
+			: m_memFile(nullptr)
+			, m_gczReader(nullptr)
+		{ }
+
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+	public:
+		// Number of blocks in the test image.
+		static const unsigned int BLOCK_COUNT = 16;
+		static const unsigned int BLOCK_SIZE = GCZ_BLOCK_SIZE_MIN;
+
+		// This block is stored uncompressed.
+		static const unsigned int UNCOMPRESSED_BLOCK = 5;
+
+	protected:
+		/**
+		 * Get the expected data byte at the specified disc position.
+		 * Most blocks are compressible; UNCOMPRESSED_BLOCK isn't.
+		 * @param pos Disc position.
+		 * @return Data byte.
+		 */
+		static inline uint8_t dataByte(uint32_t pos)
+		{
+			if (pos / BLOCK_SIZE == UNCOMPRESSED_BLOCK) {
+				uint32_t x = pos * 0x9E3779B1U;
+				x ^= (x >> 15);
+				x *= 0x85EBCA77U;
+				x ^= (x >> 13);
+				return static_cast<uint8_t>(x >> 24);
+			}
+			return static_cast<uint8_t>((pos / 64) ^ (pos / BLOCK_SIZE));
+		}
+
+	protected:
+		vector<uint8_t> m_image;	// GCZ image.
+		vector<uint8_t> m_expected;	// Expected disc data.
+		RpMemFile *m_memFile;
+		GczReader *m_gczReader;
+};
+
+/**
+ * Create a GCZ image in memory.
+ */
+void GczReaderTest::SetUp(void)
+{
+	m_expected.resize(BLOCK_COUNT * BLOCK_SIZE);
+	for (unsigned int i = 0; i < m_expected.size(); i++) {
+		m_expected[i] = dataByte(i);
+	}
+
+	// Compress the blocks.
+	vector<uint64_t> blockPointers(BLOCK_COUNT);
+	vector<uint32_t> hashes(BLOCK_COUNT);
+	vector<uint8_t> z_data;
+	vector<uint8_t> z_block(compressBound(BLOCK_SIZE));
+	for (unsigned int block = 0; block < BLOCK_COUNT; block++) {
+		const uint8_t *const pBlock = &m_expected[block * BLOCK_SIZE];
+		uLongf z_size = static_cast<uLongf>(z_block.size());
+		ASSERT_EQ(Z_OK, compress2(z_block.data(), &z_size, pBlock, BLOCK_SIZE, Z_BEST_SPEED));
+
+		uint64_t blockPointer = z_data.size();
+		if (z_size < BLOCK_SIZE) {
+			// Block is compressed.
+			z_data.insert(z_data.end(), z_block.data(), z_block.data() + z_size);
+			hashes[block] = cpu_to_le32(adler32(adler32(0L, Z_NULL, 0), z_block.data(), z_size));
+		} else {
+			// Block can't be compressed.
+			z_data.insert(z_data.end(), pBlock, pBlock + BLOCK_SIZE);
+			hashes[block] = cpu_to_le32(adler32(adler32(0L, Z_NULL, 0), pBlock, BLOCK_SIZE));
+			blockPointer |= GCZ_FLAG_BLOCK_NOT_COMPRESSED;
+		}
+		blockPointers[block] = cpu_to_le64(blockPointer);
+	}
+	ASSERT_NE(0U, le64_to_cpu(blockPointers[UNCOMPRESSED_BLOCK]) & GCZ_FLAG_BLOCK_NOT_COMPRESSED)
+		<< "UNCOMPRESSED_BLOCK was compressed";
+
+	// GCZ header, followed by the block pointers, hashes, and data.
+	GczHeader gczHeader;
+	gczHeader.magic = cpu_to_le32(GCZ_MAGIC);
+	gczHeader.sub_type = cpu_to_le32(GCZ_SubType_GameCube);
+	gczHeader.z_data_size = cpu_to_le64(z_data.size());
+	gczHeader.data_size = cpu_to_le64(m_expected.size());
+	gczHeader.block_size = cpu_to_le32(BLOCK_SIZE);
+	gczHeader.num_blocks = cpu_to_le32(BLOCK_COUNT);
+
+	const uint8_t *const pHdr = reinterpret_cast<const uint8_t*>(&gczHeader);
+	const uint8_t *const pPtrs = reinterpret_cast<const uint8_t*>(blockPointers.data());
+	const uint8_t *const pHashes = reinterpret_cast<const uint8_t*>(hashes.data());
+	m_image.assign(pHdr, pHdr + sizeof(gczHeader));
+	m_image.insert(m_image.end(), pPtrs, pPtrs + (BLOCK_COUNT * sizeof(uint64_t)));
+	m_image.insert(m_image.end(), pHashes, pHashes + (BLOCK_COUNT * sizeof(uint32_t)));
+	m_image.insert(m_image.end(), z_data.begin(), z_data.end());
+	ASSERT_LT(m_image.size(), m_expected.size());
+
+	m_memFile = new RpMemFile(m_image.data(), m_image.size());
+	m_gczReader = new GczReader(m_memFile);
+	ASSERT_TRUE(m_gczReader->isOpen());
+	ASSERT_EQ(static_cast<off64_t>(m_expected.size()), m_gczReader->size());
+	m_gczReader->setBlockCacheCount(GetParam());
+	ASSERT_EQ(GetParam(), m_gczReader->blockCacheCount());
+}
+
+void GczReaderTest::TearDown(void)
+{
+	UNREF_AND_NULL(m_gczReader);
+	UNREF_AND_NULL(m_memFile);
+}
+
+/**
+ * Read the entire disc image in one read() call.
+ */
+TEST_P(GczReaderTest, readAll)
+{
+	vector<uint8_t> buf(m_expected.size());
+	ASSERT_EQ(0, m_gczReader->seek(0));
+	EXPECT_EQ(buf.size(), m_gczReader->read(buf.data(), buf.size()));
+	EXPECT_TRUE(buf == m_expected);
+
+	// Reading at the end of the disc image should return 0.
+	EXPECT_EQ(0U, m_gczReader->read(buf.data(), 1));
+}
+
+/**
+ * Read the disc image sequentially using reads that straddle blocks.
+ */
+TEST_P(GczReaderTest, readSequential)
+{
+	static const size_t chunkSizes[] = {0x100, 0x1234, 0x4000, 0x8000, 0x12345};
+	for (size_t chunkSize : chunkSizes) {
+		vector<uint8_t> buf(m_expected.size());
+		ASSERT_EQ(0, m_gczReader->seek(0));
+
+		size_t pos = 0;
+		while (pos < buf.size()) {
+			const size_t sz = m_gczReader->read(&buf[pos], chunkSize);
+			ASSERT_GT(sz, 0U);
+			pos += sz;
+		}
+		EXPECT_EQ(buf.size(), pos);
+		EXPECT_TRUE(buf == m_expected) << "chunkSize == " << chunkSize;
+	}
+}
+
+/**
+ * Read the disc image at random positions.
+ */
+TEST_P(GczReaderTest, readRandom)
+{
+	srand(1);
+	vector<uint8_t> buf(0x18000);
+	const size_t size = m_expected.size();
+	for (unsigned int i = 0; i < 500; i++) {
+		const size_t pos = static_cast<size_t>(rand()) % size;
+		size_t sz = static_cast<size_t>(rand()) % buf.size() + 1;
+		if (pos + sz > size) {
+			sz = size - pos;
+		}
+
+		ASSERT_EQ(0, m_gczReader->seek(pos));
+		ASSERT_EQ(sz, m_gczReader->read(buf.data(), sz));
+		ASSERT_EQ(0, memcmp(buf.data(), &m_expected[pos], sz)) << "pos == " << pos << ", size == " << sz;
+	}
+}
+
+/**
+ * Read the disc image sequentially using parallel block loading.
+ * (Only has an effect if the block cache is enabled.)
+ */
+TEST_P(GczReaderTest, readParallel)
+{
+	m_gczReader->setThreadCount(4);
+
+	vector<uint8_t> buf(m_expected.size());
+	ASSERT_EQ(0, m_gczReader->seek(0));
+	size_t pos = 0;
+	while (pos < buf.size()) {
+		const size_t sz = m_gczReader->read(&buf[pos], 0x1234);
+		ASSERT_GT(sz, 0U);
+		pos += sz;
+	}
+	EXPECT_TRUE(buf == m_expected);
+
+	ASSERT_EQ(0, m_gczReader->seek(0));
+	EXPECT_EQ(buf.size(), m_gczReader->read(buf.data(), buf.size()));
+	EXPECT_TRUE(buf == m_expected);
+}
+
+/**
+ * Corrupted compressed data must result in a read error,
+ * not in the compressed data being returned as disc data.
+ */
+TEST_P(GczReaderTest, readCorrupted)
+{
+	// Corrupt the last byte of the first block's compressed data.
+	const size_t dataOffset = sizeof(GczHeader) + (BLOCK_COUNT * (sizeof(uint64_t) + sizeof(uint32_t)));
+	const uint64_t *const pBlockPointers = reinterpret_cast<const uint64_t*>(&m_image[sizeof(GczHeader)]);
+	const size_t z_size = static_cast<size_t>(le64_to_cpu(pBlockPointers[1]));
+	m_image[dataOffset + z_size - 1] ^= 0xFF;
+
+	// Reopen the GCZ image, since the header was already read.
+	UNREF_AND_NULL(m_gczReader);
+	UNREF_AND_NULL(m_memFile);
+	m_memFile = new RpMemFile(m_image.data(), m_image.size());
+	m_gczReader = new GczReader(m_memFile);
+	ASSERT_TRUE(m_gczReader->isOpen());
+	m_gczReader->setBlockCacheCount(GetParam());
+
+	uint8_t buf[0x100];
+	ASSERT_EQ(0, m_gczReader->seek(0x80));
+	EXPECT_EQ(0U, m_gczReader->read(buf, sizeof(buf)));
+	EXPECT_EQ(EIO, m_gczReader->lastError());
+
+	// Other blocks can still be read.
+	ASSERT_EQ(0, m_gczReader->seek(BLOCK_SIZE + 0x80));
+	EXPECT_EQ(sizeof(buf), m_gczReader->read(buf, sizeof(buf)));
+	EXPECT_EQ(0, memcmp(buf, &m_expected[BLOCK_SIZE + 0x80], sizeof(buf)));
+}
+
+INSTANTIATE_TEST_CASE_P(GczReaderTest, GczReaderTest,
+	::testing::Values(0U, 1U, 16U));
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: GczReader tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,244 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * WiiPartitionTest.cpp: Wii partition reader test.                        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+#include "byteswap.h"
+
+// librpbase, librpfile
+#include "librpbase/disc/DiscReader.hpp"
+#include "librpfile/RpMemFile.hpp"
+using LibRpBase::DiscReader;
+using LibRpFile::RpMemFile;
+
+// libromdata
+#include "disc/WiiPartition.hpp"
+#include "Console/wii_structs.h"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <ctime>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+class WiiPartitionTest : public ::testing::TestWithParam<WiiPartition::CryptoMethod>
+{
+	protected:
+		WiiPartitionTest()
+			: m_memFile(nullptr)
+			, m_discReader(nullptr)
+			, m_partition(nullptr)
+		{ }
+
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+	public:
+		// Number of sectors in the test partition.
+		static const unsigned int SECTOR_COUNT = 256;
+		static const unsigned int SECTOR_SIZE = 0x8000;
+		static const unsigned int SECTOR_DATA_SIZE = 0x7C00;
+
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 20;
+
+	protected:
+		/**
+		 * Get the expected data byte at the specified partition position.
+		 * @param pos Partition position.
+		 * @return Data byte.
+		 */
+		static inline uint8_t dataByte(uint32_t pos)
+		{
+			return static_cast<uint8_t>((pos * 0x9E3779B1U) >> 24);
+		}
+
+		/**
+		 * Get the sector data size for the current crypto method.
+		 * @return Sector data size.
+		 */
+		unsigned int sectorDataSize(void) const
+		{
+			return ((GetParam() & WiiPartition::CM_MASK_SECTOR) == WiiPartition::CM_32K)
+				? SECTOR_SIZE
+				: SECTOR_DATA_SIZE;
+		}
+
+		/**
+		 * Benchmark reading the partition.
+		 * @param chunkSize Read size.
+		 */
+		void readBenchmark(size_t chunkSize);
+
+	protected:
+		vector<uint8_t> m_image;	// Partition image.
+		vector<uint8_t> m_expected;	// Expected partition data.
+		RpMemFile *m_memFile;
+		DiscReader *m_discReader;
+		WiiPartition *m_partition;
+};
+
+/**
+ * Create an unencrypted Wii partition in memory.
+ */
+void WiiPartitionTest::SetUp(void)
+{
+	const WiiPartition::CryptoMethod cryptoMethod = GetParam();
+	const bool is32K = ((cryptoMethod & WiiPartition::CM_MASK_SECTOR) == WiiPartition::CM_32K);
+	const unsigned int dataSize = sectorDataSize();
+
+	// Partition header, followed by the sectors.
+	m_image.assign(sizeof(RVL_PartitionHeader) + (SECTOR_COUNT * SECTOR_SIZE), 0);
+	RVL_PartitionHeader *const pHdr = reinterpret_cast<RVL_PartitionHeader*>(m_image.data());
+	pHdr->ticket.signature_type = cpu_to_be32(RVL_SIGNATURE_TYPE_RSA2048);
+	pHdr->data_offset = cpu_to_be32(sizeof(RVL_PartitionHeader) >> 2);
+	pHdr->data_size = cpu_to_be32((SECTOR_COUNT * SECTOR_SIZE) >> 2);
+
+	// Fill the sector data. The hash area is left empty.
+	m_expected.resize(SECTOR_COUNT * dataSize);
+	for (unsigned int i = 0; i < m_expected.size(); i++) {
+		m_expected[i] = dataByte(i);
+	}
+	for (unsigned int sector = 0; sector < SECTOR_COUNT; sector++) {
+		uint8_t *const pSector = &m_image[sizeof(RVL_PartitionHeader) + (sector * SECTOR_SIZE)];
+		memcpy(&pSector[is32K ? 0 : (SECTOR_SIZE - SECTOR_DATA_SIZE)],
+			&m_expected[sector * dataSize], dataSize);
+	}
+
+	m_memFile = new RpMemFile(m_image.data(), m_image.size());
+	m_discReader = new DiscReader(m_memFile);
+	m_partition = new WiiPartition(m_discReader, 0, m_image.size(), cryptoMethod);
+	ASSERT_TRUE(m_partition->isOpen());
+}
+
+void WiiPartitionTest::TearDown(void)
+{
+	UNREF_AND_NULL(m_partition);
+	UNREF_AND_NULL(m_discReader);
+	UNREF_AND_NULL(m_memFile);
+}
+
+/**
+ * Benchmark reading the partition.
+ * @param chunkSize Read size.
+ */
+void WiiPartitionTest::readBenchmark(size_t chunkSize)
+{
+	vector<uint8_t> buf(chunkSize);
+	const size_t size = m_expected.size();
+
+	const clock_t start = clock();
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_partition->seek(0);
+		for (size_t pos = 0; pos < size; pos += chunkSize) {
+			m_partition->read(buf.data(), chunkSize);
+		}
+	}
+	const double secs = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+	const double sectors = static_cast<double>(SECTOR_COUNT) * BENCHMARK_ITERATIONS;
+	printf("Read size 0x%X: %.0f sectors/second\n",
+		static_cast<unsigned int>(chunkSize),
+		(secs > 0 ? sectors / secs : 0.0));
+}
+
+/**
+ * Read the entire partition in one read() call.
+ */
+TEST_P(WiiPartitionTest, readAll)
+{
+	vector<uint8_t> buf(m_expected.size());
+	ASSERT_EQ(0, m_partition->seek(0));
+	EXPECT_EQ(buf.size(), m_partition->read(buf.data(), buf.size()));
+	EXPECT_TRUE(buf == m_expected);
+
+	// Reading at the end of the partition should return 0.
+	EXPECT_EQ(0U, m_partition->read(buf.data(), 1));
+}
+
+/**
+ * Read the partition sequentially using reads that straddle sectors.
+ */
+TEST_P(WiiPartitionTest, readSequential)
+{
+	static const size_t chunkSizes[] = {0x100, 0x1234, 0x7C00, 0x8000, 0x12345};
+	for (size_t chunkSize : chunkSizes) {
+		vector<uint8_t> buf(m_expected.size());
+		ASSERT_EQ(0, m_partition->seek(0));
+
+		size_t pos = 0;
+		while (pos < buf.size()) {
+			const size_t sz = m_partition->read(&buf[pos], chunkSize);
+			ASSERT_GT(sz, 0U);
+			pos += sz;
+		}
+		EXPECT_EQ(buf.size(), pos);
+		EXPECT_TRUE(buf == m_expected) << "chunkSize == " << chunkSize;
+	}
+}
+
+/**
+ * Read the partition at random positions.
+ */
+TEST_P(WiiPartitionTest, readRandom)
+{
+	srand(1);
+	vector<uint8_t> buf(0x30000);
+	const size_t size = m_expected.size();
+	for (unsigned int i = 0; i < 2000; i++) {
+		const size_t pos = static_cast<size_t>(rand()) % size;
+		size_t sz = static_cast<size_t>(rand()) % buf.size() + 1;
+		if (pos + sz > size) {
+			sz = size - pos;
+		}
+
+		ASSERT_EQ(0, m_partition->seek(pos));
+		ASSERT_EQ(sz, m_partition->read(buf.data(), sz));
+		ASSERT_EQ(0, memcmp(buf.data(), &m_expected[pos], sz)) << "pos == " << pos << ", size == " << sz;
+	}
+}
+
+/**
+ * Benchmark small reads that straddle sectors.
+ */
+TEST_P(WiiPartitionTest, readSmall_benchmark)
+{
+	readBenchmark(0x1000);
+}
+
+/**
+ * Benchmark large reads.
+ */
+TEST_P(WiiPartitionTest, readLarge_benchmark)
+{
+	readBenchmark(0x100000);
+}
+
+INSTANTIATE_TEST_CASE_P(WiiPartitionTest, WiiPartitionTest,
+	::testing::Values(WiiPartition::CM_NASOS, WiiPartition::CM_RVTH));
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: WiiPartition tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u\n", LibRomData::Tests::WiiPartitionTest::BENCHMARK_ITERATIONS);
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,249 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * RomChecksumTest.cpp: RomChecksum class test.                            *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// RomChecksum
+#include "libromdata/utils/RomChecksum.hpp"
+#include "librpbase/aligned_malloc.h"
+#include "librpfile/RpMemFile.hpp"
+using LibRpFile::RpMemFile;
+
+// C includes. (C++ namespace)
+#include <cstdio>
+
+namespace LibRomData { namespace Tests {
+
+class RomChecksumTest : public ::testing::Test
+{
+	protected:
+		RomChecksumTest() = default;
+
+	public:
+		// Test data size. (3 MB; not a power of two)
+		static const size_t DATA_SIZE = 3*1024*1024;
+
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 100;
+
+		// Test data.
+		static uint8_t *m_data;
+
+		/**
+		 * Initialize the test data.
+		 * A simple LCG is used so the data is reproducible.
+		 * @return 0 on success; non-zero on error.
+		 */
+		static int initData(void);
+
+		/**
+		 * Reference even/odd byte sum.
+		 * @param pSrc	[in] Source buffer.
+		 * @param size	[in] Size of pSrc.
+		 * @param sums	[out] Sums.
+		 */
+		static void refSumBytes(const uint8_t *pSrc, size_t size, uint64_t sums[2]);
+};
+
+uint8_t *RomChecksumTest::m_data = nullptr;
+
+/**
+ * Initialize the test data.
+ * A simple LCG is used so the data is reproducible.
+ * @return 0 on success; non-zero on error.
+ */
+int RomChecksumTest::initData(void)
+{
+	m_data = static_cast<uint8_t*>(aligned_malloc(16, DATA_SIZE));
+	if (!m_data) {
+		return -1;
+	}
+
+	uint32_t seed = 0x12345678;
+	for (size_t i = 0; i < DATA_SIZE; i++) {
+		seed = (seed * 1103515245) + 12345;
+		m_data[i] = static_cast<uint8_t>(seed >> 16);
+	}
+	return 0;
+}
+
+/**
+ * Reference even/odd byte sum.
+ * @param pSrc	[in] Source buffer.
+ * @param size	[in] Size of pSrc.
+ * @param sums	[out] Sums.
+ */
+void RomChecksumTest::refSumBytes(const uint8_t *pSrc, size_t size, uint64_t sums[2])
+{
+	sums[0] = 0;
+	sums[1] = 0;
+	for (size_t i = 0; i < size; i++) {
+		sums[i & 1] += pSrc[i];
+	}
+}
+
+/**
+ * Test the standard byte sum function.
+ */
+TEST_F(RomChecksumTest, sumBytes_cpp_test)
+{
+	uint64_t ref[2], sums[2] = {0, 0};
+	refSumBytes(m_data, DATA_SIZE - 3, ref);
+	RomChecksum::sumBytes_cpp(m_data, DATA_SIZE - 3, sums);
+	EXPECT_EQ(ref[0], sums[0]);
+	EXPECT_EQ(ref[1], sums[1]);
+}
+
+#ifdef ROMCHK_HAS_SSE2
+/**
+ * Test the SSE2-optimized byte sum function.
+ */
+TEST_F(RomChecksumTest, sumBytes_sse2_test)
+{
+	if (!RP_CPU_HasSSE2()) {
+		fprintf(stderr, "*** SSE2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	uint64_t ref[2], sums[2] = {0, 0};
+	refSumBytes(m_data, DATA_SIZE - 3, ref);
+	RomChecksum::sumBytes_sse2(m_data, DATA_SIZE - 3, sums);
+	EXPECT_EQ(ref[0], sums[0]);
+	EXPECT_EQ(ref[1], sums[1]);
+}
+
+/**
+ * Benchmark the SSE2-optimized byte sum function.
+ */
+TEST_F(RomChecksumTest, sumBytes_sse2_benchmark)
+{
+	if (!RP_CPU_HasSSE2()) {
+		fprintf(stderr, "*** SSE2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	uint64_t sums[2] = {0, 0};
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		RomChecksum::sumBytes_sse2(m_data, DATA_SIZE, sums);
+	}
+}
+#endif /* ROMCHK_HAS_SSE2 */
+
+#ifdef ROMCHK_HAS_AVX2
+/**
+ * Test the AVX2-optimized byte sum function.
+ */
+TEST_F(RomChecksumTest, sumBytes_avx2_test)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	uint64_t ref[2], sums[2] = {0, 0};
+	refSumBytes(m_data, DATA_SIZE - 3, ref);
+	RomChecksum::sumBytes_avx2(m_data, DATA_SIZE - 3, sums);
+	EXPECT_EQ(ref[0], sums[0]);
+	EXPECT_EQ(ref[1], sums[1]);
+}
+
+/**
+ * Benchmark the AVX2-optimized byte sum function.
+ */
+TEST_F(RomChecksumTest, sumBytes_avx2_benchmark)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	uint64_t sums[2] = {0, 0};
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		RomChecksum::sumBytes_avx2(m_data, DATA_SIZE, sums);
+	}
+}
+#endif /* ROMCHK_HAS_AVX2 */
+
+/**
+ * Benchmark the standard byte sum function.
+ */
+TEST_F(RomChecksumTest, sumBytes_cpp_benchmark)
+{
+	uint64_t sums[2] = {0, 0};
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		RomChecksum::sumBytes_cpp(m_data, DATA_SIZE, sums);
+	}
+}
+
+#ifdef ROMCHK_HAS_SSE2
+/**
+ * Test the SSE2-optimized N64 CRC function.
+ * The standard version is used as the reference.
+ */
+TEST_F(RomChecksumTest, n64CicCrcs_sse2_test)
+{
+	if (!RP_CPU_HasSSE2()) {
+		fprintf(stderr, "*** SSE2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	uint32_t ref[RomChecksum::N64_CIC_MAX][2];
+	uint32_t crcs[RomChecksum::N64_CIC_MAX][2];
+	const uint8_t *const pData = m_data + RomChecksum::N64_CRC_START;
+	const uint8_t *const pBootcode = m_data + RomChecksum::N64_CIC6105_BOOTCODE_ADDR;
+	RomChecksum::n64CicCrcs_cpp(pData, RomChecksum::N64_CRC_LENGTH, pBootcode, ref);
+	RomChecksum::n64CicCrcs_sse2(pData, RomChecksum::N64_CRC_LENGTH, pBootcode, crcs);
+	EXPECT_EQ(0, memcmp(ref, crcs, sizeof(ref)));
+}
+#endif /* ROMCHK_HAS_SSE2 */
+
+/**
+ * Test the SNES checksum with mirroring.
+ * 3 MB = 2 MB + 1 MB; the last 1 MB is mirrored.
+ */
+TEST_F(RomChecksumTest, snesChecksum_test)
+{
+	uint64_t sums_lo[2], sums_hi[2];
+	refSumBytes(m_data, 2*1024*1024, sums_lo);
+	refSumBytes(m_data + 2*1024*1024, 1*1024*1024, sums_hi);
+	const uint16_t ref = static_cast<uint16_t>(
+		sums_lo[0] + sums_lo[1] + 2*(sums_hi[0] + sums_hi[1]));
+
+	RpMemFile *const memFile = new RpMemFile(m_data, DATA_SIZE);
+	uint16_t checksum = 0;
+	EXPECT_EQ(0, RomChecksum::snesChecksum(memFile, 0, DATA_SIZE, &checksum));
+	EXPECT_EQ(ref, checksum);
+	memFile->unref();
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: RomChecksum tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u\n", LibRomData::Tests::RomChecksumTest::BENCHMARK_ITERATIONS);
+	fflush(nullptr);
+
+	// Initialize the test data.
+	if (LibRomData::Tests::RomChecksumTest::initData() != 0) {
+		fprintf(stderr, "*** FATAL ERROR: Could not allocate the test data.\n");
+		return EXIT_FAILURE;
+	}
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	int ret = RUN_ALL_TESTS();
+
+	aligned_free(LibRomData::Tests::RomChecksumTest::m_data);
+	return ret;
+}
@@ -42,6 +42,9 @@ class SuperMagicDriveTest : public ::testing::Test
 		// Number of iterations for benchmarks.
 		static const unsigned int BENCHMARK_ITERATIONS = 100000;
 
+		// Number of blocks for the decodeBlocks() tests. (4 MB)
+		static const unsigned int BULK_BLOCK_COUNT = 256;
+
 		/**
 		 * 16 KB SMD-interleaved data block.
 		 */
@@ -300,8 +303,39 @@ TEST_F(SuperMagicDriveTest, decodeBlock_sse2_benchmark)
 }
 #endif /* SMD_HAS_SSE2 */
 
+#ifdef SMD_HAS_AVX2
+/**
+ * Test the AVX2-optimized SMD decoder.
+ */
+TEST_F(SuperMagicDriveTest, decodeBlock_avx2_test)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	SuperMagicDrive::decodeBlock_avx2(align_buf, m_smd_data);
+	EXPECT_EQ(0, memcmp(m_bin_data, align_buf, SuperMagicDrive::SMD_BLOCK_SIZE));
+}
+
+/**
+ * Benchmark the AVX2-optimized SMD decoder.
+ */
+TEST_F(SuperMagicDriveTest, decodeBlock_avx2_benchmark)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		SuperMagicDrive::decodeBlock_avx2(align_buf, m_smd_data);
+	}
+}
+#endif /* SMD_HAS_AVX2 */
+
 // NOTE: Add more instruction sets to the #ifdef if other optimizations are added.
-#if defined(SMD_HAS_MMX) || defined(SMD_HAS_SSE2)
+#if defined(SMD_HAS_MMX) || defined(SMD_HAS_SSE2) || defined(SMD_HAS_AVX2)
 /**
  * Test the decodeBlock() dispatch function.
  */
@@ -320,7 +354,54 @@ TEST_F(SuperMagicDriveTest, decodeBlock_dispatch_benchmark)
 		SuperMagicDrive::decodeBlock(align_buf, m_smd_data);
 	}
 }
-#endif /* SMD_HAS_MMX || SMD_HAS_SSE2 */
+#endif /* SMD_HAS_MMX || SMD_HAS_SSE2 || SMD_HAS_AVX2 */
+
+/**
+ * Test the decodeBlocks() bulk function.
+ */
+TEST_F(SuperMagicDriveTest, decodeBlocks_test)
+{
+	// Use enough blocks to enable multithreading.
+	static const size_t BLOCK_COUNT = BULK_BLOCK_COUNT;
+	static const size_t BUF_SIZE = BLOCK_COUNT * SuperMagicDrive::SMD_BLOCK_SIZE;
+
+	auto smd_buf = aligned_uptr<uint8_t>(16, BUF_SIZE);
+	auto bin_buf = aligned_uptr<uint8_t>(16, BUF_SIZE);
+	ASSERT_TRUE(smd_buf != nullptr);
+	ASSERT_TRUE(bin_buf != nullptr);
+	for (size_t i = 0; i < BLOCK_COUNT; i++) {
+		memcpy(&smd_buf.get()[i * SuperMagicDrive::SMD_BLOCK_SIZE], m_smd_data, SuperMagicDrive::SMD_BLOCK_SIZE);
+	}
+	memset(bin_buf.get(), 0, BUF_SIZE);
+
+	SuperMagicDrive::decodeBlocks(bin_buf.get(), smd_buf.get(), BLOCK_COUNT);
+	for (size_t i = 0; i < BLOCK_COUNT; i++) {
+		EXPECT_EQ(0, memcmp(m_bin_data, &bin_buf.get()[i * SuperMagicDrive::SMD_BLOCK_SIZE],
+			SuperMagicDrive::SMD_BLOCK_SIZE)) << "block " << i;
+	}
+}
+
+/**
+ * Benchmark the decodeBlocks() bulk function.
+ */
+TEST_F(SuperMagicDriveTest, decodeBlocks_benchmark)
+{
+	static const size_t BLOCK_COUNT = BULK_BLOCK_COUNT;
+	static const size_t BUF_SIZE = BLOCK_COUNT * SuperMagicDrive::SMD_BLOCK_SIZE;
+
+	auto smd_buf = aligned_uptr<uint8_t>(16, BUF_SIZE);
+	auto bin_buf = aligned_uptr<uint8_t>(16, BUF_SIZE);
+	ASSERT_TRUE(smd_buf != nullptr);
+	ASSERT_TRUE(bin_buf != nullptr);
+	for (size_t i = 0; i < BLOCK_COUNT; i++) {
+		memcpy(&smd_buf.get()[i * SuperMagicDrive::SMD_BLOCK_SIZE], m_smd_data, SuperMagicDrive::SMD_BLOCK_SIZE);
+	}
+
+	// Same total number of blocks as the single-block benchmarks.
+	for (unsigned int i = BENCHMARK_ITERATIONS / BLOCK_COUNT; i > 0; i--) {
+		SuperMagicDrive::decodeBlocks(bin_buf.get(), smd_buf.get(), BLOCK_COUNT);
+	}
+}
 
 } }
 
@@ -0,0 +1,103 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * FileReadWindow.cpp: Buffered read window for header parsing.            *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "FileReadWindow.hpp"
+
+// librpfile
+using LibRpFile::IRpFile;
+
+namespace LibRomData {
+
+/**
+ * Create a read window.
+ *
+ * NOTE: The file is NOT ref()'d, so it must remain
+ * valid while this FileReadWindow is in use.
+ *
+ * @param file File.
+ * @param readAhead Minimum number of bytes to read when moving the window.
+ */
+FileReadWindow::FileReadWindow(IRpFile *file, size_t readAhead)
+	: m_file(file)
+	, m_addr(0)
+	, m_readAhead(readAhead)
+{ }
+
+/**
+ * Get a pointer to file data.
+ *
+ * The returned pointer is only valid until the next call
+ * to get() or invalidate(). Copy the data if it's needed
+ * while other data is being read.
+ *
+ * @param addr Address.
+ * @param size Size. (must be MAX_REQUEST_SIZE or less)
+ * @return Pointer to the data, or nullptr on error.
+ */
+const uint8_t *FileReadWindow::get(off64_t addr, size_t size)
+{
+	assert(m_file != nullptr);
+	assert(size <= MAX_REQUEST_SIZE);
+	if (!m_file || addr < 0 || size == 0 || size > MAX_REQUEST_SIZE) {
+		return nullptr;
+	}
+
+	// Is the requested data already in the window?
+	if (addr >= m_addr && addr - m_addr <= static_cast<off64_t>(m_buf.size()) &&
+	    size <= m_buf.size() - static_cast<size_t>(addr - m_addr))
+	{
+		return &m_buf[static_cast<size_t>(addr - m_addr)];
+	}
+
+	// Move the window to the requested address.
+	// The window may be shorter than the read-ahead size
+	// if it's near the end of the file.
+	const size_t win_size = std::max(size, m_readAhead);
+	m_buf.resize(win_size);
+	size_t sz_read = m_file->seekAndRead(addr, m_buf.data(), win_size);
+	if (sz_read < size) {
+		// Seek and/or read error.
+		m_buf.clear();
+		m_addr = 0;
+		return nullptr;
+	}
+	m_buf.resize(sz_read);
+	m_addr = addr;
+	return m_buf.data();
+}
+
+/**
+ * Copy file data into a buffer.
+ * @param addr Address.
+ * @param ptr Output buffer.
+ * @param size Size. (must be MAX_REQUEST_SIZE or less)
+ * @return Number of bytes copied. (either size or 0)
+ */
+size_t FileReadWindow::read(off64_t addr, void *ptr, size_t size)
+{
+	const uint8_t *const p = get(addr, size);
+	if (!p) {
+		return 0;
+	}
+	memcpy(ptr, p, size);
+	return size;
+}
+
+/**
+ * Invalidate the window.
+ * This also releases the window buffer.
+ */
+void FileReadWindow::invalidate(void)
+{
+	m_buf.clear();
+	m_buf.shrink_to_fit();
+	m_addr = 0;
+}
+
+}
@@ -0,0 +1,91 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * FileReadWindow.hpp: Buffered read window for header parsing.            *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_UTILS_FILEREADWINDOW_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_UTILS_FILEREADWINDOW_HPP__
+
+#include "common.h"
+#include "librpfile/IRpFile.hpp"
+
+// Uninitialized vector class.
+#include "librpbase/uvector.h"
+
+namespace LibRomData {
+
+/**
+ * Buffered read window.
+ *
+ * Executable format parsers need many small structures that are
+ * usually located close together: header tables, notes, strings.
+ * FileReadWindow keeps one contiguous window of the file in memory.
+ * If a request isn't within the current window, the window is moved
+ * to the requested address and filled with a single read, including
+ * read-ahead, so nearby structures don't need additional reads.
+ */
+class FileReadWindow
+{
+	public:
+		/**
+		 * Create a read window.
+		 *
+		 * NOTE: The file is NOT ref()'d, so it must remain
+		 * valid while this FileReadWindow is in use.
+		 *
+		 * @param file File.
+		 * @param readAhead Minimum number of bytes to read when moving the window.
+		 */
+		explicit FileReadWindow(LibRpFile::IRpFile *file, size_t readAhead = DEFAULT_READ_AHEAD);
+
+	private:
+		RP_DISABLE_COPY(FileReadWindow)
+
+	public:
+		// Default read-ahead size.
+		static const size_t DEFAULT_READ_AHEAD = 64*1024;
+
+		// Maximum request size.
+		static const size_t MAX_REQUEST_SIZE = 16*1024*1024;
+
+		/**
+		 * Get a pointer to file data.
+		 *
+		 * The returned pointer is only valid until the next call
+		 * to get() or invalidate(). Copy the data if it's needed
+		 * while other data is being read.
+		 *
+		 * @param addr Address.
+		 * @param size Size. (must be MAX_REQUEST_SIZE or less)
+		 * @return Pointer to the data, or nullptr on error.
+		 */
+		const uint8_t *get(off64_t addr, size_t size);
+
+		/**
+		 * Copy file data into a buffer.
+		 * @param addr Address.
+		 * @param ptr Output buffer.
+		 * @param size Size. (must be MAX_REQUEST_SIZE or less)
+		 * @return Number of bytes copied. (either size or 0)
+		 */
+		size_t read(off64_t addr, void *ptr, size_t size);
+
+		/**
+		 * Invalidate the window.
+		 * This also releases the window buffer.
+		 */
+		void invalidate(void);
+
+	private:
+		LibRpFile::IRpFile *m_file;
+		ao::uvector<uint8_t> m_buf;	// Window data.
+		off64_t m_addr;			// Window starting address.
+		size_t m_readAhead;		// Read-ahead size.
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_UTILS_FILEREADWINDOW_HPP__ */
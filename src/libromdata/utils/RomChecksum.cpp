@@ -0,0 +1,299 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomChecksum.cpp: Internal ROM checksum algorithms.                      *
+ * Standard version. (C++ code only)                                       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RomChecksum.hpp"
+
+// librpbase, librpfile
+#include "librpbase/aligned_malloc.h"
+using LibRpFile::IRpFile;
+
+// librpcpu
+#include "librpcpu/simd_registry.h"
+
+namespace LibRomData {
+
+// Chunk size for file reads.
+static const size_t READ_CHUNK_SIZE = 1024*1024;
+
+// N64 CRC seeds, indexed by N64_CIC.
+static const uint32_t n64_cic_seeds[RomChecksum::N64_CIC_MAX] = {
+	0xF8CA4DDC,	// 6102
+	0xA3886759,	// 6103
+	0xDF26F436,	// 6105
+	0x1FEA617A,	// 6106
+};
+
+/**
+ * Sum the even and odd bytes of a buffer.
+ * Standard version using regular C++ code.
+ * @param pSrc	[in] Source buffer.
+ * @param size	[in] Size of pSrc, in bytes.
+ * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+ */
+void RomChecksum::sumBytes_cpp(const uint8_t *pSrc, size_t size, uint64_t sums[2])
+{
+	// 32-bit accumulators can't overflow within 8 MB.
+	static const size_t BLOCK_SIZE = 8*1024*1024;
+
+	uint64_t even = 0, odd = 0;
+	while (size >= 2) {
+		const size_t blockSize = std::min(size & ~static_cast<size_t>(1), BLOCK_SIZE);
+		const uint8_t *const pBlockEnd = pSrc + blockSize;
+		uint32_t even32 = 0, odd32 = 0;
+		for (; pSrc < pBlockEnd; pSrc += 2) {
+			even32 += pSrc[0];
+			odd32 += pSrc[1];
+		}
+		even += even32;
+		odd += odd32;
+		size -= blockSize;
+	}
+	if (size != 0) {
+		// Last byte is even.
+		even += *pSrc;
+	}
+
+	sums[0] += even;
+	sums[1] += odd;
+}
+
+/**
+ * Calculate the N64 CRCs for all CIC variants.
+ * Standard version using regular C++ code.
+ * @param pData		[in] ROM data starting at N64_CRC_START. (Z64 byte order)
+ * @param size		[in] Size of pData. (normally N64_CRC_LENGTH; must be a multiple of 4)
+ * @param pBootcode6105	[in] 256 bytes of ROM data starting at N64_CIC6105_BOOTCODE_ADDR. (Z64 byte order)
+ * @param crcs		[out] CRCs, indexed by N64_CIC.
+ */
+void RomChecksum::n64CicCrcs_cpp(const uint8_t *pData, size_t size,
+	const uint8_t *pBootcode6105, uint32_t crcs[N64_CIC_MAX][2])
+{
+	assert(size % 4 == 0);
+
+	// All CIC variants are calculated in one pass.
+	uint32_t t1[N64_CIC_MAX], t2[N64_CIC_MAX], t3[N64_CIC_MAX];
+	uint32_t t4[N64_CIC_MAX], t5[N64_CIC_MAX], t6[N64_CIC_MAX];
+	for (unsigned int cic = 0; cic < N64_CIC_MAX; cic++) {
+		t1[cic] = t2[cic] = t3[cic] = n64_cic_seeds[cic];
+		t4[cic] = t5[cic] = t6[cic] = n64_cic_seeds[cic];
+	}
+
+	for (size_t i = 0; i < size; i += 4) {
+		const uint32_t d = (pData[i] << 24) | (pData[i+1] << 16) | (pData[i+2] << 8) | pData[i+3];
+		const unsigned int rot = (d & 0x1F);
+		const uint32_t r = (d << rot) | (d >> ((32 - rot) & 0x1F));
+		const uint8_t *const pBc = &pBootcode6105[i & 0xFF];
+		const uint32_t bc = (pBc[0] << 24) | (pBc[1] << 16) | (pBc[2] << 8) | pBc[3];
+
+		for (unsigned int cic = 0; cic < N64_CIC_MAX; cic++) {
+			if (t6[cic] + d < t6[cic]) {
+				t4[cic]++;
+			}
+			t6[cic] += d;
+			t3[cic] ^= d;
+			t5[cic] += r;
+			if (t2[cic] > d) {
+				t2[cic] ^= r;
+			} else {
+				t2[cic] ^= t6[cic] ^ d;
+			}
+			if (cic == N64_CIC_6105) {
+				t1[cic] += bc ^ d;
+			} else {
+				t1[cic] += t5[cic] ^ d;
+			}
+		}
+	}
+
+	for (unsigned int cic = 0; cic < N64_CIC_MAX; cic++) {
+		switch (cic) {
+			case N64_CIC_6103:
+				crcs[cic][0] = (t6[cic] ^ t4[cic]) + t3[cic];
+				crcs[cic][1] = (t5[cic] ^ t2[cic]) + t1[cic];
+				break;
+			case N64_CIC_6106:
+				crcs[cic][0] = (t6[cic] * t4[cic]) + t3[cic];
+				crcs[cic][1] = (t5[cic] * t2[cic]) + t1[cic];
+				break;
+			default:
+				crcs[cic][0] = t6[cic] ^ t4[cic] ^ t3[cic];
+				crcs[cic][1] = t5[cic] ^ t2[cic] ^ t1[cic];
+				break;
+		}
+	}
+}
+
+/**
+ * Sum the even and odd bytes of a region of a file.
+ * The region is read in large chunks.
+ * @param file	[in] File.
+ * @param offset	[in] Starting address. (should be even)
+ * @param length	[in] Length of the region, in bytes.
+ * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomChecksum::sumFileBytes(IRpFile *file, off64_t offset, off64_t length, uint64_t sums[2])
+{
+	assert(file != nullptr);
+	assert(offset >= 0);
+	assert(length >= 0);
+	if (!file || offset < 0 || length < 0) {
+		return -EINVAL;
+	}
+
+	auto buf = aligned_uptr<uint8_t>(16, static_cast<size_t>(
+		std::min(length, static_cast<off64_t>(READ_CHUNK_SIZE))));
+	while (length > 0) {
+		const size_t chunkSize = static_cast<size_t>(
+			std::min(length, static_cast<off64_t>(READ_CHUNK_SIZE)));
+		size_t size = file->seekAndRead(offset, buf.get(), chunkSize);
+		if (size != chunkSize) {
+			// Short read.
+			const int err = file->lastError();
+			return (err != 0 ? -err : -EIO);
+		}
+
+		sumBytes(buf.get(), chunkSize, sums);
+		offset += chunkSize;
+		length -= chunkSize;
+	}
+
+	return 0;
+}
+
+/**
+ * Calculate a SNES checksum, with mirroring.
+ *
+ * If the ROM size isn't a power of two, the last part
+ * of the ROM is mirrored to fill the next power of two,
+ * as on the real cartridge board. The ROM is split into
+ * power-of-two segments, one per set bit of the length,
+ * starting with the most significant bit.
+ *
+ * @param file	[in] File.
+ * @param offset	[in] Starting address. (after any copier header)
+ * @param length	[in] ROM size, in bytes.
+ * @param pChecksum	[out] Checksum.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomChecksum::snesChecksum(IRpFile *file, off64_t offset, uint32_t length, uint16_t *pChecksum)
+{
+	assert(pChecksum != nullptr);
+	if (!pChecksum) {
+		return -EINVAL;
+	} else if (length == 0) {
+		*pChecksum = 0;
+		return 0;
+	}
+
+	// Sum each segment. The segments are contiguous,
+	// so the ROM is still only read once.
+	uint32_t seg_size[32], seg_sum[32];
+	unsigned int seg_count = 0;
+	for (int bit = 31; bit >= 0; bit--) {
+		const uint32_t size = (1U << bit);
+		if (!(length & size))
+			continue;
+
+		uint64_t sums[2] = {0, 0};
+		int ret = sumFileBytes(file, offset, size, sums);
+		if (ret != 0) {
+			return ret;
+		}
+		seg_size[seg_count] = size;
+		seg_sum[seg_count] = static_cast<uint32_t>(sums[0] + sums[1]);
+		seg_count++;
+		offset += size;
+	}
+
+	// Combine the segments, starting with the smallest.
+	// Each smaller segment is doubled until it's as large
+	// as the next larger segment.
+	uint32_t sum = seg_sum[seg_count-1];
+	uint32_t sum_size = seg_size[seg_count-1];
+	for (int i = static_cast<int>(seg_count) - 2; i >= 0; i--) {
+		while (sum_size < seg_size[i]) {
+			sum_size <<= 1;
+			sum <<= 1;
+		}
+		sum += seg_sum[i];
+		sum_size += seg_size[i];
+	}
+
+	*pChecksum = static_cast<uint16_t>(sum);
+	return 0;
+}
+
+/** SIMD registry **/
+
+/**
+ * Benchmark a sumBytes() variant.
+ * @tparam sumBytes_fn sumBytes() variant.
+ * @param buf Buffer.
+ * @param size Size of buf.
+ */
+template<void (*sumBytes_fn)(const uint8_t*, size_t, uint64_t[2])>
+static void bench_sumBytes(uint8_t *buf, size_t size)
+{
+	uint64_t sums[2] = {0, 0};
+	sumBytes_fn(buf, size, sums);
+	// Store the result so the call isn't optimized out.
+	memcpy(buf, sums, sizeof(sums));
+}
+
+/**
+ * Benchmark an n64CicCrcs() variant.
+ * @tparam n64CicCrcs_fn n64CicCrcs() variant.
+ * @param buf Buffer.
+ * @param size Size of buf.
+ */
+template<void (*n64CicCrcs_fn)(const uint8_t*, size_t, const uint8_t*, uint32_t[RomChecksum::N64_CIC_MAX][2])>
+static void bench_n64CicCrcs(uint8_t *buf, size_t size)
+{
+	uint32_t crcs[RomChecksum::N64_CIC_MAX][2];
+	n64CicCrcs_fn(buf, size & ~static_cast<size_t>(3), buf, crcs);
+	// Store the result so the call isn't optimized out.
+	memcpy(buf, crcs, sizeof(crcs));
+}
+
+/**
+ * Register the SIMD variants with the SIMD registry.
+ * This is used by `rpcli --cpu-selftest`.
+ */
+void RomChecksum::registerSimdKernels(void)
+{
+	// NOTE: Must be in the same order as the dispatch functions.
+	static const RP_SIMD_Variant sumBytes_variants[] = {
+#ifdef ROMCHK_HAS_AVX2
+		{"avx2", RP_CPUFLAG_X86_AVX2, bench_sumBytes<sumBytes_avx2>},
+#endif /* ROMCHK_HAS_AVX2 */
+#ifdef ROMCHK_HAS_SSE2
+		{"sse2", RP_CPUFLAG_X86_SSE2, bench_sumBytes<sumBytes_sse2>},
+#endif /* ROMCHK_HAS_SSE2 */
+		{"cpp", 0, bench_sumBytes<sumBytes_cpp>},
+	};
+	static const RP_SIMD_Kernel sumBytes_kernel = {
+		"RomChecksum::sumBytes", sumBytes_variants, ARRAY_SIZE(sumBytes_variants)
+	};
+	RP_SIMD_RegisterKernel(&sumBytes_kernel);
+
+	static const RP_SIMD_Variant n64CicCrcs_variants[] = {
+#ifdef ROMCHK_HAS_SSE2
+		{"sse2", RP_CPUFLAG_X86_SSE2, bench_n64CicCrcs<n64CicCrcs_sse2>},
+#endif /* ROMCHK_HAS_SSE2 */
+		{"cpp", 0, bench_n64CicCrcs<n64CicCrcs_cpp>},
+	};
+	static const RP_SIMD_Kernel n64CicCrcs_kernel = {
+		"RomChecksum::n64CicCrcs", n64CicCrcs_variants, ARRAY_SIZE(n64CicCrcs_variants)
+	};
+	RP_SIMD_RegisterKernel(&n64CicCrcs_kernel);
+}
+
+}
@@ -0,0 +1,248 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomChecksum.hpp: Internal ROM checksum algorithms.                      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_UTILS_ROMCHECKSUM_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_UTILS_ROMCHECKSUM_HPP__
+
+#include "common.h"
+#include "librpcpu/cpu_dispatch.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// librpfile
+#include "librpfile/IRpFile.hpp"
+
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# include "librpcpu/cpuflags_x86.h"
+# define ROMCHK_HAS_SSE2 1
+/* AVX2 requires MSVC 2013 or later. */
+# if !defined(_MSC_VER) || _MSC_VER >= 1800
+#  define ROMCHK_HAS_AVX2 1
+# endif
+#endif
+#ifdef RP_CPU_AMD64
+# define ROMCHK_ALWAYS_HAS_SSE2 1
+#endif
+
+namespace LibRomData {
+
+class RomChecksum
+{
+	private:
+		// Static class.
+		RomChecksum();
+		~RomChecksum();
+		RP_DISABLE_COPY(RomChecksum)
+
+	public:
+		/**
+		 * N64 CIC variants with distinct CRC algorithms.
+		 * PAL CICs (71xx) use the same algorithm as
+		 * the corresponding NTSC CICs (61xx).
+		 */
+		enum N64_CIC {
+			N64_CIC_6102	= 0,	// also 6101, 7101, 7102
+			N64_CIC_6103	= 1,	// also 7103
+			N64_CIC_6105	= 2,	// also 7105
+			N64_CIC_6106	= 3,	// also 7106
+
+			N64_CIC_MAX
+		};
+
+		// N64 CRC region.
+		static const unsigned int N64_CRC_START = 0x1000;
+		static const unsigned int N64_CRC_LENGTH = 0x100000;
+
+		// CIC-NUS-6105 reads 256 bytes of the bootcode
+		// starting at this address.
+		static const unsigned int N64_CIC6105_BOOTCODE_ADDR = 0x750;
+
+		/** Internal algorithms. **/
+		// NOTE: These are public to allow for unit tests and benchmarking.
+
+		/**
+		 * Sum the even and odd bytes of a buffer.
+		 * Standard version using regular C++ code.
+		 * @param pSrc	[in] Source buffer.
+		 * @param size	[in] Size of pSrc, in bytes.
+		 * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+		 */
+		static void sumBytes_cpp(const uint8_t *pSrc, size_t size, uint64_t sums[2]);
+
+#if ROMCHK_HAS_SSE2
+		/**
+		 * Sum the even and odd bytes of a buffer.
+		 * SSE2-optimized version.
+		 * NOTE: pSrc must be 16-byte aligned.
+		 * @param pSrc	[in] Source buffer.
+		 * @param size	[in] Size of pSrc, in bytes.
+		 * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+		 */
+		static void sumBytes_sse2(const uint8_t *pSrc, size_t size, uint64_t sums[2]);
+#endif /* ROMCHK_HAS_SSE2 */
+
+#if ROMCHK_HAS_AVX2
+		/**
+		 * Sum the even and odd bytes of a buffer.
+		 * AVX2-optimized version.
+		 * NOTE: pSrc must be 16-byte aligned.
+		 * @param pSrc	[in] Source buffer.
+		 * @param size	[in] Size of pSrc, in bytes.
+		 * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+		 */
+		static void sumBytes_avx2(const uint8_t *pSrc, size_t size, uint64_t sums[2]);
+#endif /* ROMCHK_HAS_AVX2 */
+
+		/**
+		 * Calculate the N64 CRCs for all CIC variants.
+		 * Standard version using regular C++ code.
+		 * @param pData		[in] ROM data starting at N64_CRC_START. (Z64 byte order)
+		 * @param size		[in] Size of pData. (normally N64_CRC_LENGTH; must be a multiple of 4)
+		 * @param pBootcode6105	[in] 256 bytes of ROM data starting at N64_CIC6105_BOOTCODE_ADDR. (Z64 byte order)
+		 * @param crcs		[out] CRCs, indexed by N64_CIC.
+		 */
+		static void n64CicCrcs_cpp(const uint8_t *pData, size_t size,
+			const uint8_t *pBootcode6105, uint32_t crcs[N64_CIC_MAX][2]);
+
+#if ROMCHK_HAS_SSE2
+		/**
+		 * Calculate the N64 CRCs for all CIC variants.
+		 * SSE2-optimized version. Each CIC is a 32-bit lane.
+		 * @param pData		[in] ROM data starting at N64_CRC_START. (Z64 byte order)
+		 * @param size		[in] Size of pData. (normally N64_CRC_LENGTH; must be a multiple of 4)
+		 * @param pBootcode6105	[in] 256 bytes of ROM data starting at N64_CIC6105_BOOTCODE_ADDR. (Z64 byte order)
+		 * @param crcs		[out] CRCs, indexed by N64_CIC.
+		 */
+		static void n64CicCrcs_sse2(const uint8_t *pData, size_t size,
+			const uint8_t *pBootcode6105, uint32_t crcs[N64_CIC_MAX][2]);
+#endif /* ROMCHK_HAS_SSE2 */
+
+	public:
+		/**
+		 * Sum the even and odd bytes of a buffer.
+		 * NOTE: pSrc must be 16-byte aligned if using SSE2.
+		 * @param pSrc	[in] Source buffer.
+		 * @param size	[in] Size of pSrc, in bytes.
+		 * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+		 */
+		static IFUNC_INLINE void sumBytes(const uint8_t *pSrc, size_t size, uint64_t sums[2]);
+
+		/**
+		 * Calculate the N64 CRCs for all CIC variants.
+		 * @param pData		[in] ROM data starting at N64_CRC_START. (Z64 byte order)
+		 * @param size		[in] Size of pData. (normally N64_CRC_LENGTH; must be a multiple of 4)
+		 * @param pBootcode6105	[in] 256 bytes of ROM data starting at N64_CIC6105_BOOTCODE_ADDR. (Z64 byte order)
+		 * @param crcs		[out] CRCs, indexed by N64_CIC.
+		 */
+		static IFUNC_INLINE void n64CicCrcs(const uint8_t *pData, size_t size,
+			const uint8_t *pBootcode6105, uint32_t crcs[N64_CIC_MAX][2]);
+
+		/**
+		 * Sum the even and odd bytes of a region of a file.
+		 * The region is read in large chunks.
+		 * @param file	[in] File.
+		 * @param offset	[in] Starting address. (should be even)
+		 * @param length	[in] Length of the region, in bytes.
+		 * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int sumFileBytes(LibRpFile::IRpFile *file, off64_t offset, off64_t length, uint64_t sums[2]);
+
+		/**
+		 * Calculate a SNES checksum, with mirroring.
+		 *
+		 * If the ROM size isn't a power of two, the last part
+		 * of the ROM is mirrored to fill the next power of two,
+		 * as on the real cartridge board. The ROM is split into
+		 * power-of-two segments, one per set bit of the length,
+		 * starting with the most significant bit.
+		 *
+		 * @param file	[in] File.
+		 * @param offset	[in] Starting address. (after any copier header)
+		 * @param length	[in] ROM size, in bytes.
+		 * @param pChecksum	[out] Checksum.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int snesChecksum(LibRpFile::IRpFile *file, off64_t offset, uint32_t length, uint16_t *pChecksum);
+
+		/**
+		 * Register the SIMD variants with the SIMD registry.
+		 * This is used by `rpcli --cpu-selftest`.
+		 */
+		static void registerSimdKernels(void);
+};
+
+/** Dispatch functions. **/
+
+// NOTE: IFUNC is used on amd64 as well, since AVX2 isn't
+// guaranteed to be available.
+
+#if !defined(RP_HAS_IFUNC) || (!defined(RP_CPU_I386) && !defined(RP_CPU_AMD64))
+
+/**
+ * Sum the even and odd bytes of a buffer.
+ * NOTE: pSrc must be 16-byte aligned if using SSE2.
+ * @param pSrc	[in] Source buffer.
+ * @param size	[in] Size of pSrc, in bytes.
+ * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+ */
+inline void RomChecksum::sumBytes(const uint8_t *pSrc, size_t size, uint64_t sums[2])
+{
+#ifdef ROMCHK_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		sumBytes_avx2(pSrc, size, sums);
+	} else
+#endif /* ROMCHK_HAS_AVX2 */
+#ifdef ROMCHK_ALWAYS_HAS_SSE2
+	{
+		// amd64 always has SSE2.
+		sumBytes_sse2(pSrc, size, sums);
+	}
+#else /* ROMCHK_ALWAYS_HAS_SSE2 */
+# ifdef ROMCHK_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		sumBytes_sse2(pSrc, size, sums);
+	} else
+# endif /* ROMCHK_HAS_SSE2 */
+	{
+		sumBytes_cpp(pSrc, size, sums);
+	}
+#endif /* ROMCHK_ALWAYS_HAS_SSE2 */
+}
+
+/**
+ * Calculate the N64 CRCs for all CIC variants.
+ * @param pData		[in] ROM data starting at N64_CRC_START. (Z64 byte order)
+ * @param size		[in] Size of pData. (normally N64_CRC_LENGTH; must be a multiple of 4)
+ * @param pBootcode6105	[in] 256 bytes of ROM data starting at N64_CIC6105_BOOTCODE_ADDR. (Z64 byte order)
+ * @param crcs		[out] CRCs, indexed by N64_CIC.
+ */
+inline void RomChecksum::n64CicCrcs(const uint8_t *pData, size_t size,
+	const uint8_t *pBootcode6105, uint32_t crcs[N64_CIC_MAX][2])
+{
+#ifdef ROMCHK_ALWAYS_HAS_SSE2
+	// amd64 always has SSE2.
+	n64CicCrcs_sse2(pData, size, pBootcode6105, crcs);
+#else /* ROMCHK_ALWAYS_HAS_SSE2 */
+# ifdef ROMCHK_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		n64CicCrcs_sse2(pData, size, pBootcode6105, crcs);
+	} else
+# endif /* ROMCHK_HAS_SSE2 */
+	{
+		n64CicCrcs_cpp(pData, size, pBootcode6105, crcs);
+	}
+#endif /* ROMCHK_ALWAYS_HAS_SSE2 */
+}
+
+#endif /* !defined(RP_HAS_IFUNC) || (!defined(RP_CPU_I386) && !defined(RP_CPU_AMD64)) */
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_UTILS_ROMCHECKSUM_HPP__ */
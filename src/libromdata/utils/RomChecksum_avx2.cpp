@@ -0,0 +1,68 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomChecksum_avx2.cpp: Internal ROM checksum algorithms.                 *
+ * AVX2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RomChecksum.hpp"
+
+// C includes. (C++ namespace)
+#include <cassert>
+
+// AVX2 intrinsics.
+#include <immintrin.h>
+
+namespace LibRomData {
+
+/**
+ * Sum the even and odd bytes of a buffer.
+ * AVX2-optimized version.
+ * NOTE: pSrc must be 16-byte aligned.
+ * @param pSrc	[in] Source buffer.
+ * @param size	[in] Size of pSrc, in bytes.
+ * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+ */
+void RomChecksum::sumBytes_avx2(const uint8_t *pSrc, size_t size, uint64_t sums[2])
+{
+	ASSERT_ALIGNMENT(16, pSrc);
+
+	// VPSADBW against zero sums each group of 8 bytes
+	// into a 64-bit lane, so the sums can't overflow.
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i mask_even = _mm256_set1_epi16(0x00FF);
+	__m256i even = _mm256_setzero_si256();
+	__m256i odd = _mm256_setzero_si256();
+
+	// NOTE: Buffers are only guaranteed to be 16-byte aligned.
+	const __m256i *p = reinterpret_cast<const __m256i*>(pSrc);
+	const __m256i *const pEnd = p + (size / 32);
+	for (; p < pEnd; p++) {
+		const __m256i v = _mm256_loadu_si256(p);
+		even = _mm256_add_epi64(even, _mm256_sad_epu8(_mm256_and_si256(v, mask_even), zero));
+		odd = _mm256_add_epi64(odd, _mm256_sad_epu8(_mm256_srli_epi16(v, 8), zero));
+	}
+
+	// Combine the four 64-bit lanes.
+	__m128i even128 = _mm_add_epi64(_mm256_castsi256_si128(even), _mm256_extracti128_si256(even, 1));
+	__m128i odd128 = _mm_add_epi64(_mm256_castsi256_si128(odd), _mm256_extracti128_si256(odd, 1));
+	even128 = _mm_add_epi64(even128, _mm_unpackhi_epi64(even128, even128));
+	odd128 = _mm_add_epi64(odd128, _mm_unpackhi_epi64(odd128, odd128));
+	uint64_t tmp[2];
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(&tmp[0]), even128);
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(&tmp[1]), odd128);
+	sums[0] += tmp[0];
+	sums[1] += tmp[1];
+
+	// Remaining bytes.
+	// NOTE: size/32 blocks were processed, so the
+	// even/odd parity is unchanged.
+	if (size % 32 != 0) {
+		sumBytes_cpp(reinterpret_cast<const uint8_t*>(pEnd), size % 32, sums);
+	}
+}
+
+}
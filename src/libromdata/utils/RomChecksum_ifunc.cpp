@@ -0,0 +1,78 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomChecksum_ifunc.cpp: RomChecksum IFUNC resolution functions.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librpbase.h"
+#include "librpcpu/cpu_dispatch.h"
+
+#ifdef RP_HAS_IFUNC
+
+#include "RomChecksum.hpp"
+using LibRomData::RomChecksum;
+
+// IFUNC attribute doesn't support C++ name mangling.
+extern "C" {
+
+/**
+ * IFUNC resolver function for sumBytes().
+ * @return Function pointer.
+ */
+static __typeof__(&RomChecksum::sumBytes_cpp) sumBytes_resolve(void)
+{
+#ifdef ROMCHK_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return &RomChecksum::sumBytes_avx2;
+	} else
+#endif /* ROMCHK_HAS_AVX2 */
+#ifdef ROMCHK_ALWAYS_HAS_SSE2
+	{
+		// amd64 always has SSE2.
+		return &RomChecksum::sumBytes_sse2;
+	}
+#else /* !ROMCHK_ALWAYS_HAS_SSE2 */
+# ifdef ROMCHK_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		return &RomChecksum::sumBytes_sse2;
+	} else
+# endif /* ROMCHK_HAS_SSE2 */
+	{
+		return &RomChecksum::sumBytes_cpp;
+	}
+#endif /* ROMCHK_ALWAYS_HAS_SSE2 */
+}
+
+/**
+ * IFUNC resolver function for n64CicCrcs().
+ * @return Function pointer.
+ */
+static __typeof__(&RomChecksum::n64CicCrcs_cpp) n64CicCrcs_resolve(void)
+{
+#ifdef ROMCHK_ALWAYS_HAS_SSE2
+	// amd64 always has SSE2.
+	return &RomChecksum::n64CicCrcs_sse2;
+#else /* !ROMCHK_ALWAYS_HAS_SSE2 */
+# ifdef ROMCHK_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		return &RomChecksum::n64CicCrcs_sse2;
+	} else
+# endif /* ROMCHK_HAS_SSE2 */
+	{
+		return &RomChecksum::n64CicCrcs_cpp;
+	}
+#endif /* ROMCHK_ALWAYS_HAS_SSE2 */
+}
+
+}
+
+void RomChecksum::sumBytes(const uint8_t *pSrc, size_t size, uint64_t sums[2])
+	IFUNC_ATTR(sumBytes_resolve);
+void RomChecksum::n64CicCrcs(const uint8_t *pData, size_t size,
+	const uint8_t *pBootcode6105, uint32_t crcs[N64_CIC_MAX][2])
+	IFUNC_ATTR(n64CicCrcs_resolve);
+
+#endif /* RP_HAS_IFUNC */
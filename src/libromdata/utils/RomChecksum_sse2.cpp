@@ -0,0 +1,154 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomChecksum_sse2.cpp: Internal ROM checksum algorithms.                 *
+ * SSE2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RomChecksum.hpp"
+
+// C includes. (C++ namespace)
+#include <cassert>
+
+// SSE2 intrinsics.
+#include <emmintrin.h>
+
+namespace LibRomData {
+
+/**
+ * Sum the even and odd bytes of a buffer.
+ * SSE2-optimized version.
+ * NOTE: pSrc must be 16-byte aligned.
+ * @param pSrc	[in] Source buffer.
+ * @param size	[in] Size of pSrc, in bytes.
+ * @param sums	[in/out] sums[0] += even bytes; sums[1] += odd bytes.
+ */
+void RomChecksum::sumBytes_sse2(const uint8_t *pSrc, size_t size, uint64_t sums[2])
+{
+	ASSERT_ALIGNMENT(16, pSrc);
+
+	// PSADBW against zero sums each group of 8 bytes
+	// into a 64-bit lane, so the sums can't overflow.
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask_even = _mm_set1_epi16(0x00FF);
+	__m128i even = _mm_setzero_si128();
+	__m128i odd = _mm_setzero_si128();
+
+	const __m128i *p = reinterpret_cast<const __m128i*>(pSrc);
+	const __m128i *const pEnd = p + (size / 16);
+	for (; p < pEnd; p++) {
+		const __m128i v = _mm_load_si128(p);
+		even = _mm_add_epi64(even, _mm_sad_epu8(_mm_and_si128(v, mask_even), zero));
+		odd = _mm_add_epi64(odd, _mm_sad_epu8(_mm_srli_epi16(v, 8), zero));
+	}
+
+	// Combine the two 64-bit lanes.
+	even = _mm_add_epi64(even, _mm_unpackhi_epi64(even, even));
+	odd = _mm_add_epi64(odd, _mm_unpackhi_epi64(odd, odd));
+	uint64_t tmp[2];
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(&tmp[0]), even);
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(&tmp[1]), odd);
+	sums[0] += tmp[0];
+	sums[1] += tmp[1];
+
+	// Remaining bytes.
+	// NOTE: size/16 blocks were processed, so the
+	// even/odd parity is unchanged.
+	if (size % 16 != 0) {
+		sumBytes_cpp(reinterpret_cast<const uint8_t*>(pEnd), size % 16, sums);
+	}
+}
+
+/**
+ * Calculate the N64 CRCs for all CIC variants.
+ * SSE2-optimized version. Each CIC is a 32-bit lane.
+ * @param pData		[in] ROM data starting at N64_CRC_START. (Z64 byte order)
+ * @param size		[in] Size of pData. (normally N64_CRC_LENGTH; must be a multiple of 4)
+ * @param pBootcode6105	[in] 256 bytes of ROM data starting at N64_CIC6105_BOOTCODE_ADDR. (Z64 byte order)
+ * @param crcs		[out] CRCs, indexed by N64_CIC.
+ */
+void RomChecksum::n64CicCrcs_sse2(const uint8_t *pData, size_t size,
+	const uint8_t *pBootcode6105, uint32_t crcs[N64_CIC_MAX][2])
+{
+	assert(size % 4 == 0);
+	static_assert(N64_CIC_MAX == 4, "N64_CIC_MAX must be 4 for SSE2.");
+
+	// Lanes are in N64_CIC order.
+	const __m128i seeds = _mm_setr_epi32(
+		static_cast<int>(0xF8CA4DDC), static_cast<int>(0xA3886759),
+		static_cast<int>(0xDF26F436), static_cast<int>(0x1FEA617A));
+	// CIC-NUS-6105 uses the bootcode for t1.
+	const __m128i mask_6105 = _mm_setr_epi32(0, 0, -1, 0);
+	// SSE2 doesn't have unsigned comparisons, so flip the sign bits.
+	const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000));
+
+	__m128i t1 = seeds, t2 = seeds, t3 = seeds;
+	__m128i t4 = seeds, t5 = seeds, t6 = seeds;
+
+	for (size_t i = 0; i < size; i += 4) {
+		// The data word is the same for all lanes,
+		// so the rotation is done with scalar code.
+		const uint32_t d = (pData[i] << 24) | (pData[i+1] << 16) | (pData[i+2] << 8) | pData[i+3];
+		const unsigned int rot = (d & 0x1F);
+		const uint32_t r = (d << rot) | (d >> ((32 - rot) & 0x1F));
+		const uint8_t *const pBc = &pBootcode6105[i & 0xFF];
+		const uint32_t bc = (pBc[0] << 24) | (pBc[1] << 16) | (pBc[2] << 8) | pBc[3];
+
+		const __m128i vd = _mm_set1_epi32(static_cast<int>(d));
+		const __m128i vr = _mm_set1_epi32(static_cast<int>(r));
+		const __m128i vd_s = _mm_xor_si128(vd, sign);
+
+		// if (t6 + d < t6) t4++;
+		const __m128i t6_new = _mm_add_epi32(t6, vd);
+		const __m128i carry = _mm_cmpgt_epi32(_mm_xor_si128(t6, sign), _mm_xor_si128(t6_new, sign));
+		t4 = _mm_sub_epi32(t4, carry);
+		t6 = t6_new;
+
+		t3 = _mm_xor_si128(t3, vd);
+		t5 = _mm_add_epi32(t5, vr);
+
+		// if (t2 > d) t2 ^= r; else t2 ^= t6 ^ d;
+		const __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(t2, sign), vd_s);
+		t2 = _mm_xor_si128(t2, _mm_or_si128(
+			_mm_and_si128(gt, vr),
+			_mm_andnot_si128(gt, _mm_xor_si128(t6, vd))));
+
+		// 6105: t1 += bc ^ d; others: t1 += t5 ^ d;
+		const __m128i vbc = _mm_set1_epi32(static_cast<int>(bc ^ d));
+		t1 = _mm_add_epi32(t1, _mm_or_si128(
+			_mm_and_si128(mask_6105, vbc),
+			_mm_andnot_si128(mask_6105, _mm_xor_si128(t5, vd))));
+	}
+
+	// Final combination differs per CIC, and SSE2
+	// doesn't have a 32-bit multiply, so use scalar code.
+	uint32_t a1[4], a2[4], a3[4], a4[4], a5[4], a6[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(a1), t1);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(a2), t2);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(a3), t3);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(a4), t4);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(a5), t5);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(a6), t6);
+
+	for (unsigned int cic = 0; cic < N64_CIC_MAX; cic++) {
+		switch (cic) {
+			case N64_CIC_6103:
+				crcs[cic][0] = (a6[cic] ^ a4[cic]) + a3[cic];
+				crcs[cic][1] = (a5[cic] ^ a2[cic]) + a1[cic];
+				break;
+			case N64_CIC_6106:
+				crcs[cic][0] = (a6[cic] * a4[cic]) + a3[cic];
+				crcs[cic][1] = (a5[cic] * a2[cic]) + a1[cic];
+				break;
+			default:
+				crcs[cic][0] = a6[cic] ^ a4[cic] ^ a3[cic];
+				crcs[cic][1] = a5[cic] ^ a2[cic] ^ a1[cic];
+				break;
+		}
+	}
+}
+
+}
@@ -10,6 +10,13 @@
 #include "stdafx.h"
 #include "SuperMagicDrive.hpp"
 
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::ThreadPool;
+
+// librpcpu
+#include "librpcpu/simd_registry.h"
+
 namespace LibRomData {
 
 /**
@@ -47,4 +54,86 @@ void SuperMagicDrive::decodeBlock_cpp(uint8_t *RESTRICT pDest, const uint8_t *RE
 	}
 }
 
+/**
+ * Decode multiple Super Magic Drive interleaved blocks.
+ * This is intended for converting entire ROM images.
+ *
+ * If there are enough blocks, they will be decoded
+ * in parallel using multiple threads.
+ *
+ * NOTE: Pointers must be 16-byte aligned if using SSE2.
+ * @param pDest	[out] Destination buffer. (Must be count * 16 KB.)
+ * @param pSrc	[in] Source buffer. (Must be count * 16 KB.)
+ * @param count	[in] Number of blocks.
+ */
+void SuperMagicDrive::decodeBlocks(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc, size_t count)
+{
+	// Blocks are processed in groups to reduce the
+	// per-work-item overhead. (256 KB per group)
+	static const size_t BLOCKS_PER_GROUP = 16;
+	const size_t groups = (count + BLOCKS_PER_GROUP - 1) / BLOCKS_PER_GROUP;
+
+	const unsigned int threadCount = static_cast<unsigned int>(
+		std::min(groups, static_cast<size_t>(ThreadPool::cpuCount())));
+	if (threadCount <= 1) {
+		// Not enough blocks to bother with threads.
+		for (; count > 0; count--, pDest += SMD_BLOCK_SIZE, pSrc += SMD_BLOCK_SIZE) {
+			decodeBlock(pDest, pSrc);
+		}
+		return;
+	}
+
+	ThreadPool pool(threadCount);
+	pool.parallelFor(groups, [=](size_t group) {
+		const size_t start = group * BLOCKS_PER_GROUP;
+		const size_t end = std::min(start + BLOCKS_PER_GROUP, count);
+		for (size_t i = start; i < end; i++) {
+			decodeBlock(&pDest[i * SMD_BLOCK_SIZE], &pSrc[i * SMD_BLOCK_SIZE]);
+		}
+	});
+}
+
+/** SIMD registry **/
+
+/**
+ * Benchmark a decodeBlock() variant.
+ * The first half of the buffer is decoded into the second half.
+ * @tparam decodeBlock_fn decodeBlock() variant.
+ * @param buf Buffer.
+ * @param size Size of buf.
+ */
+template<void (*decodeBlock_fn)(uint8_t *RESTRICT, const uint8_t *RESTRICT)>
+static void bench_decodeBlock(uint8_t *buf, size_t size)
+{
+	const size_t half = size / 2;
+	for (size_t i = 0; i + SuperMagicDrive::SMD_BLOCK_SIZE <= half; i += SuperMagicDrive::SMD_BLOCK_SIZE) {
+		decodeBlock_fn(&buf[half + i], &buf[i]);
+	}
+}
+
+/**
+ * Register the decodeBlock() variants with the SIMD registry.
+ * This is used by `rpcli --cpu-selftest`.
+ */
+void SuperMagicDrive::registerSimdKernels(void)
+{
+	// NOTE: Must be in the same order as the decodeBlock() dispatch function.
+	static const RP_SIMD_Variant variants[] = {
+#ifdef SMD_HAS_AVX2
+		{"avx2", RP_CPUFLAG_X86_AVX2, bench_decodeBlock<decodeBlock_avx2>},
+#endif /* SMD_HAS_AVX2 */
+#ifdef SMD_HAS_SSE2
+		{"sse2", RP_CPUFLAG_X86_SSE2, bench_decodeBlock<decodeBlock_sse2>},
+#endif /* SMD_HAS_SSE2 */
+#ifdef SMD_HAS_MMX
+		{"mmx", RP_CPUFLAG_X86_MMX, bench_decodeBlock<decodeBlock_mmx>},
+#endif /* SMD_HAS_MMX */
+		{"cpp", 0, bench_decodeBlock<decodeBlock_cpp>},
+	};
+	static const RP_SIMD_Kernel kernel = {
+		"SuperMagicDrive::decodeBlock", variants, ARRAY_SIZE(variants)
+	};
+	RP_SIMD_RegisterKernel(&kernel);
+}
+
 }
@@ -12,6 +12,7 @@
 #include "common.h"
 #include "librpcpu/cpu_dispatch.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
@@ -24,6 +25,10 @@
 #  define SMD_HAS_MMX 1
 # endif
 # define SMD_HAS_SSE2 1
+/* AVX2 requires MSVC 2013 or later. */
+# if !defined(_MSC_VER) || _MSC_VER >= 1800
+#  define SMD_HAS_AVX2 1
+# endif
 #endif
 #ifdef RP_CPU_AMD64
 # define SMD_ALWAYS_HAS_SSE2 1
@@ -73,6 +78,17 @@ class SuperMagicDrive
 		static void decodeBlock_sse2(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc);
 #endif /* SMD_HAS_SSE2 */
 
+#if SMD_HAS_AVX2
+		/**
+		 * Decode a Super Magic Drive interleaved block.
+		 * AVX2-optimized version.
+		 * NOTE: Pointers must be 16-byte aligned.
+		 * @param pDest	[out] Destination block. (Must be 16 KB.)
+		 * @param pSrc	[in] Source block. (Must be 16 KB.)
+		 */
+		static void decodeBlock_avx2(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc);
+#endif /* SMD_HAS_AVX2 */
+
 	public:
 		// SMD block size.
 		static const unsigned int SMD_BLOCK_SIZE = 16384;
@@ -83,7 +99,27 @@ class SuperMagicDrive
 		 * @param pDest	[out] Destination block. (Must be 16 KB.)
 		 * @param pSrc	[in] Source block. (Must be 16 KB.)
 		 */
-		static IFUNC_SSE2_INLINE void decodeBlock(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc);
+		static IFUNC_INLINE void decodeBlock(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc);
+
+		/**
+		 * Decode multiple Super Magic Drive interleaved blocks.
+		 * This is intended for converting entire ROM images.
+		 *
+		 * If there are enough blocks, they will be decoded
+		 * in parallel using multiple threads.
+		 *
+		 * NOTE: Pointers must be 16-byte aligned if using SSE2.
+		 * @param pDest	[out] Destination buffer. (Must be count * 16 KB.)
+		 * @param pSrc	[in] Source buffer. (Must be count * 16 KB.)
+		 * @param count	[in] Number of blocks.
+		 */
+		static void decodeBlocks(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc, size_t count);
+
+		/**
+		 * Register the decodeBlock() variants with the SIMD registry.
+		 * This is used by `rpcli --cpu-selftest`.
+		 */
+		static void registerSimdKernels(void);
 };
 
 // TODO: Use gcc target-specific function attributes if available?
@@ -91,24 +127,8 @@ class SuperMagicDrive
 
 /** Dispatch functions. **/
 
-#if defined(RP_HAS_IFUNC) && defined(SMD_ALWAYS_HAS_SSE2)
-
-// System does support IFUNC, but it's always guaranteed to have SSE2.
-// Eliminate the IFUNC dispatch on this system.
-
-/**
- * Decode a Super Magic Drive interleaved block.
- * NOTE: Pointers must be 16-byte aligned if using SSE2.
- * @param dest	[out] Destination block. (Must be 16 KB.)
- * @param src	[in] Source block. (Must be 16 KB.)
- */
-inline void SuperMagicDrive::decodeBlock(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc)
-{
-	// amd64 always has SSE2.
-	decodeBlock_sse2(pDest, pSrc);
-}
-
-#endif /* defined(RP_HAS_IFUNC) && defined(SMD_ALWAYS_HAS_SSE2) */
+// NOTE: IFUNC is used on amd64 as well, since AVX2 isn't
+// guaranteed to be available.
 
 #if !defined(RP_HAS_IFUNC) || (!defined(RP_CPU_I386) && !defined(RP_CPU_AMD64))
 
@@ -120,9 +140,16 @@ inline void SuperMagicDrive::decodeBlock(uint8_t *RESTRICT pDest, const uint8_t
  */
 inline void SuperMagicDrive::decodeBlock(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc)
 {
+#ifdef SMD_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		decodeBlock_avx2(pDest, pSrc);
+	} else
+#endif /* SMD_HAS_AVX2 */
 #ifdef SMD_ALWAYS_HAS_SSE2
-	// amd64 always has SSE2.
-	decodeBlock_sse2(pDest, pSrc);
+	{
+		// amd64 always has SSE2.
+		decodeBlock_sse2(pDest, pSrc);
+	}
 #else /* SMD_ALWAYS_HAS_SSE2 */
 # ifdef SMD_HAS_SSE2
 	if (RP_CPU_HasSSE2()) {
@@ -18,34 +18,42 @@ using LibRomData::SuperMagicDrive;
 // IFUNC attribute doesn't support C++ name mangling.
 extern "C" {
 
-#ifndef SMD_ALWAYS_HAS_SSE2
 /**
  * IFUNC resolver function for decodeBlock().
  * @return Function pointer.
  */
 static __typeof__(&SuperMagicDrive::decodeBlock_cpp) decodeBlock_resolve(void)
 {
-#ifdef SMD_HAS_SSE2
+#ifdef SMD_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return &SuperMagicDrive::decodeBlock_avx2;
+	} else
+#endif /* SMD_HAS_AVX2 */
+#ifdef SMD_ALWAYS_HAS_SSE2
+	{
+		// amd64 always has SSE2.
+		return &SuperMagicDrive::decodeBlock_sse2;
+	}
+#else /* !SMD_ALWAYS_HAS_SSE2 */
+# ifdef SMD_HAS_SSE2
 	if (RP_CPU_HasSSE2()) {
 		return &SuperMagicDrive::decodeBlock_sse2;
 	} else
-#endif /* SMD_HAS_SSE2 */
-#ifdef SMD_HAS_MMX
+# endif /* SMD_HAS_SSE2 */
+# ifdef SMD_HAS_MMX
 	if (RP_CPU_HasMMX()) {
 		return &SuperMagicDrive::decodeBlock_mmx;
 	} else
-#endif /* SMD_HAS_MMX */
+# endif /* SMD_HAS_MMX */
 	{
 		return &SuperMagicDrive::decodeBlock_cpp;
 	}
-}
 #endif /* SMD_ALWAYS_HAS_SSE2 */
+}
 
 }
 
-#ifndef SMD_ALWAYS_HAS_SSE2
 void SuperMagicDrive::decodeBlock(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc)
 	IFUNC_ATTR(decodeBlock_resolve);
-#endif /* SMD_ALWAYS_HAS_SSE2 */
 
 #endif /* RP_HAS_IFUNC */
@@ -0,0 +1,149 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * Arena.cpp: Simple bump allocator.                                       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "Arena.hpp"
+
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
+// librpfile
+#include "librpfile/RpAllocStats.hpp"
+namespace RpAllocStats = LibRpFile::RpAllocStats;
+
+// C includes. (C++ namespace)
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+namespace LibRpBase {
+
+// Process-wide block cache.
+static Mutex blockCacheMutex;
+Arena::Block *Arena::ms_blockCache = nullptr;
+unsigned int Arena::ms_blockCacheCount = 0;
+
+Arena::Arena()
+	: m_head(nullptr)
+	, m_pos(nullptr)
+	, m_end(nullptr)
+{ }
+
+Arena::~Arena()
+{
+	reset();
+}
+
+/**
+ * Start a new block large enough for the specified allocation.
+ * @param size Allocation size.
+ * @param align Allocation alignment.
+ */
+void Arena::newBlock(size_t size, size_t align)
+{
+	// Block data starts immediately after the header,
+	// which is aligned to at least sizeof(uint64_t).
+	static_assert(sizeof(Block) % sizeof(uint64_t) == 0, "sizeof(Block) is not a multiple of 8");
+
+	Block *block = nullptr;
+	const size_t needed = size + align;
+	if (needed <= BLOCK_SIZE) {
+		// Standard block. Check the cache first.
+		MutexLocker locker(blockCacheMutex);
+		if (ms_blockCache) {
+			block = ms_blockCache;
+			ms_blockCache = block->next;
+			ms_blockCacheCount--;
+		}
+	}
+
+	if (!block) {
+		const size_t dataSize = (needed <= BLOCK_SIZE ? BLOCK_SIZE : needed);
+		block = static_cast<Block*>(malloc(sizeof(Block) + dataSize));
+		if (!block) {
+			throw std::bad_alloc();
+		}
+		block->size = dataSize;
+		RpAllocStats::onAlloc(RpAllocStats::TAG_ROMFIELDS, sizeof(Block) + dataSize);
+	}
+
+	block->next = m_head;
+	m_head = block;
+	m_pos = reinterpret_cast<uint8_t*>(block + 1);
+	m_end = m_pos + block->size;
+}
+
+/**
+ * Allocate memory.
+ * @param size Size, in bytes.
+ * @param align Alignment. (must be a power of two)
+ * @return Allocated memory. (never nullptr)
+ */
+void *Arena::alloc(size_t size, size_t align)
+{
+	assert(align != 0 && (align & (align - 1)) == 0);
+
+	uintptr_t p = (reinterpret_cast<uintptr_t>(m_pos) + (align - 1)) & ~(uintptr_t)(align - 1);
+	if (!m_head || p + size > reinterpret_cast<uintptr_t>(m_end)) {
+		newBlock(size, align);
+		p = (reinterpret_cast<uintptr_t>(m_pos) + (align - 1)) & ~(uintptr_t)(align - 1);
+	}
+
+	m_pos = reinterpret_cast<uint8_t*>(p + size);
+	return reinterpret_cast<void*>(p);
+}
+
+/**
+ * Copy a string into the arena.
+ * The copy is always NUL-terminated.
+ * @param str String.
+ * @param len Length of str, in bytes.
+ * @return Copy of the string.
+ */
+const char *Arena::strdup(const char *str, size_t len)
+{
+	char *const s = static_cast<char*>(alloc(len + 1, 1));
+	if (len > 0) {
+		memcpy(s, str, len);
+	}
+	s[len] = '\0';
+	return s;
+}
+
+/**
+ * Release all allocations.
+ * Blocks are returned to the process-wide block cache.
+ */
+void Arena::reset(void)
+{
+	if (!m_head)
+		return;
+
+	MutexLocker locker(blockCacheMutex);
+	Block *block = m_head;
+	while (block) {
+		Block *const next = block->next;
+		if (block->size == BLOCK_SIZE && ms_blockCacheCount < BLOCK_CACHE_MAX) {
+			block->next = ms_blockCache;
+			ms_blockCache = block;
+			ms_blockCacheCount++;
+		} else {
+			RpAllocStats::onFree(RpAllocStats::TAG_ROMFIELDS, sizeof(Block) + block->size);
+			free(block);
+		}
+		block = next;
+	}
+
+	m_head = nullptr;
+	m_pos = nullptr;
+	m_end = nullptr;
+}
+
+}
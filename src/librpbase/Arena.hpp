@@ -0,0 +1,113 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * Arena.hpp: Simple bump allocator.                                       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_ARENA_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_ARENA_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+// C includes. (C++ namespace)
+#include <cstddef>
+
+// C++ includes.
+#include <new>
+
+namespace LibRpBase {
+
+/**
+ * Bump allocator for small objects that share a lifetime.
+ *
+ * Allocations are carved out of large blocks and are only
+ * released all at once by reset() or the destructor.
+ * Destructors are NOT called, so only trivially-destructible
+ * types can be stored here.
+ *
+ * Standard-size blocks are returned to a process-wide cache
+ * when an arena is reset or destroyed, so arenas created for
+ * subsequent files (e.g. rpcli batch mode) reuse them.
+ */
+class Arena
+{
+	public:
+		Arena();
+		~Arena();
+
+	private:
+		RP_DISABLE_COPY(Arena)
+
+	public:
+		/**
+		 * Allocate memory.
+		 * @param size Size, in bytes.
+		 * @param align Alignment. (must be a power of two)
+		 * @return Allocated memory. (never nullptr)
+		 */
+		void *alloc(size_t size, size_t align = sizeof(uint64_t));
+
+		/**
+		 * Copy a string into the arena.
+		 * The copy is always NUL-terminated.
+		 * @param str String.
+		 * @param len Length of str, in bytes.
+		 * @return Copy of the string.
+		 */
+		const char *strdup(const char *str, size_t len);
+
+		/**
+		 * Copy an object into the arena.
+		 * T must be trivially destructible.
+		 * @param src Object to copy.
+		 * @return Copy of the object.
+		 */
+		template<typename T>
+		inline T *copy(const T &src)
+		{
+			return new (alloc(sizeof(T))) T(src);
+		}
+
+		/**
+		 * Release all allocations.
+		 * Blocks are returned to the process-wide block cache.
+		 */
+		void reset(void);
+
+	public:
+		// Size of a standard block.
+		// Larger allocations get a dedicated block.
+		static const size_t BLOCK_SIZE = 8192;
+
+	private:
+		struct Block {
+			Block *next;
+			size_t size;	// Size of the data area.
+		};
+
+		/**
+		 * Start a new block large enough for the specified allocation.
+		 * @param size Allocation size.
+		 * @param align Allocation alignment.
+		 */
+		void newBlock(size_t size, size_t align);
+
+		Block *m_head;	// Current block. (Blocks are a singly-linked list.)
+		uint8_t *m_pos;	// Next free byte in the current block.
+		uint8_t *m_end;	// End of the current block.
+
+		// Process-wide cache of standard-size blocks.
+		// Protected by a mutex in Arena.cpp.
+		static Block *ms_blockCache;
+		static unsigned int ms_blockCacheCount;
+		static const unsigned int BLOCK_CACHE_MAX = 64;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_ARENA_HPP__ */
@@ -0,0 +1,84 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * PerfectHash.hpp: Lookup functions for generated lookup tables.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_PERFECTHASH_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_PERFECTHASH_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+/**
+ * Lookup tables are generated from *_data.txt by gen_lookup_tables.py.
+ * (located in src/libromdata/data/)
+ * Each table is stored as one array per column, and string columns
+ * are stored as offsets into a single per-module string table.
+ * This avoids a relocation for every string pointer, and the
+ * tables can be placed in read-only memory.
+ *
+ * "hash" tables use a minimal perfect hash. (hash, displace, and compress)
+ * The key is hashed with seed 0 to find a displacement value d:
+ * - d < 0: The key is at slot (-d - 1).
+ * - d >= 0: The key is at slot hash(key, d) % N.
+ * The key at that slot must be checked, since keys that aren't in
+ * the table will also map to a valid slot.
+ */
+
+namespace LibRpBase { namespace PerfectHash {
+
+/**
+ * Hash function.
+ * NOTE: Must match phash() in gen_lookup_tables.py.
+ * @param key Key.
+ * @param seed Seed.
+ * @return Hash value.
+ */
+static inline uint32_t hash(uint32_t key, uint32_t seed)
+{
+	// MurmurHash3 finalizer.
+	uint32_t x = key ^ (seed * 0x9E3779B9U);
+	x ^= x >> 16;
+	x *= 0x85EBCA6BU;
+	x ^= x >> 13;
+	x *= 0xC2B2AE35U;
+	x ^= x >> 16;
+	return x;
+}
+
+/**
+ * Find a key in a perfect hash table.
+ * @param keys Key array.
+ * @param disp Displacement array.
+ * @param key Key to find.
+ * @return Slot index, or -1 if not found.
+ */
+template<typename Key, size_t N>
+static inline int find(const Key (&keys)[N], const int16_t (&disp)[N], uint32_t key)
+{
+	const int d = disp[hash(key, 0) % N];
+	const unsigned int idx = (d < 0
+		? static_cast<unsigned int>(-d - 1)
+		: hash(key, static_cast<uint32_t>(d)) % N);
+	return (keys[idx] == key ? static_cast<int>(idx) : -1);
+}
+
+/**
+ * Get a string from a string table.
+ * @param strtbl String table.
+ * @param offset Offset.
+ * @return String, or nullptr if offset is 0.
+ */
+static inline const char *str(const char *strtbl, unsigned int offset)
+{
+	return (offset != 0 ? &strtbl[offset] : nullptr);
+}
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_PERFECTHASH_HPP__ */
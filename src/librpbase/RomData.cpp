@@ -19,12 +19,27 @@
 using std::string;
 using std::vector;
 
+// Whole-file checksums.
+#include "disc/DiscReader.hpp"
+#include "disc/SparseDiscReader.hpp"
+
 // librpfile, librptexture
 #include "librptexture/img/rp_image.hpp"
 using LibRpFile::IRpFile;
 using LibRpFile::RpFile;
 using LibRpTexture::rp_image;
 
+// librpthreads
+#include "librpthreads/Atomics.h"
+#include "librpthreads/CancelToken.hpp"
+using LibRpThreads::CancelToken;
+using LibRpThreads::MutexLocker;
+
+// OS-specific includes.
+#ifndef _WIN32
+# include <pthread.h>
+#endif /* !_WIN32 */
+
 namespace LibRpBase {
 
 /** RomDataPrivate **/
@@ -39,16 +54,28 @@ RomDataPrivate::RomDataPrivate(RomData *q, IRpFile *file)
 	: q_ptr(q)
 	, isValid(false)
 	, isCompressed(false)
+	, metaDataOnly(false)
 	, file(nullptr)
 	, fields(new RomFields())
 	, metaData(nullptr)
+	, loadMutex(true)
+	, imageMutex(true)
+	, concurrentImageLoad(false)
+	, fieldsLoaded(0)
+	, metaDataLoaded(0)
 	, className(nullptr)
 	, mimeType(nullptr)
 	, fileType(RomData::FileType::ROM_Image)
+	, classId(-1)
+	, imgCacheKeyState(0)
+	, checksumTabAdded(false)
 {
 	// Initialize i18n.
 	rp_i18n_init();
 
+	memset(imgShared, 0, sizeof(imgShared));
+	memset(&checksums, 0, sizeof(checksums));
+
 	if (file) {
 		// Reference the file.
 		this->file = file->ref();
@@ -62,10 +89,143 @@ RomDataPrivate::~RomDataPrivate()
 	delete fields;
 	delete metaData;
 
+	// Unreference shared images.
+	for (const rp_image *img : imgShared) {
+		UNREF(img);
+	}
+
 	// Unreference the file.
 	UNREF(this->file);
 }
 
+/**
+ * Read data from the file at the specified position.
+ *
+ * If the file has a native file descriptor, a positional
+ * read is used, which doesn't change the file position and
+ * is safe to call from multiple threads. Otherwise, the
+ * read is done with loadMutex held.
+ *
+ * @param pos	[in] File position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RomDataPrivate::readAt(off64_t pos, void *ptr, size_t size)
+{
+	if (!file)
+		return 0;
+
+	if (file->nativeFd() >= 0 && !file->isWritable()) {
+		// IRpFile::pread() doesn't use the file position.
+		return file->pread(pos, ptr, size);
+	}
+
+	MutexLocker loadLock(loadMutex);
+	return file->pread(pos, ptr, size);
+}
+
+/**
+ * Initialize the ImageCache key for an internal image.
+ * @param imageType Image type.
+ * @return True if the key is valid; false if the image can't be cached.
+ */
+bool RomDataPrivate::initImageCacheKey(RomData::ImageType imageType)
+{
+	if (imgCacheKeyState == 0) {
+		// Get the file identity.
+		// NOTE: The class name is needed to distinguish between
+		// RomData subclasses that were opened using the same file.
+		imgCacheKeyState = (className && ImageCache::initKey(imgCacheKey, file, className, 0)) ? 1 : -1;
+	}
+
+	if (imgCacheKeyState < 0)
+		return false;
+	imgCacheKey.imageType = imageType;
+	return true;
+}
+
+/**
+ * Convert binary data to a lowercase hexadecimal string.
+ * @param pData Data.
+ * @param len Length of data.
+ * @return Hexadecimal string.
+ */
+static string hexString(const uint8_t *pData, size_t len)
+{
+	static const char hex_lookup[] = "0123456789abcdef";
+	string s;
+	s.reserve(len * 2);
+	for (; len > 0; len--, pData++) {
+		s += hex_lookup[*pData >> 4];
+		s += hex_lookup[*pData & 0x0F];
+	}
+	return s;
+}
+
+/**
+ * Add the "Checksums" tab to the fields.
+ * This is done after the subclass loads its fields.
+ */
+void RomDataPrivate::addChecksumTab(void)
+{
+	if (checksumTabAdded || checksums.flags == 0)
+		return;
+	checksumTabAdded = true;
+
+	// If the first tab doesn't have a name, use the system name.
+	const char *const tab0name = fields->tabName(0);
+	if (!tab0name || tab0name[0] == '\0') {
+		const char *const sysName = q_ptr->systemName(
+			RomData::SYSNAME_TYPE_LONG | RomData::SYSNAME_REGION_GENERIC);
+		fields->setTabName(0, sysName ? sysName : C_("RomData", "ROM"));
+	}
+
+	// NOTE: A deferred tab is used, since regular tabs
+	// can't be added after the subclass's deferred tabs.
+	const FileHasher::Hashes hashes = checksums;
+	fields->addTab_deferred(C_("RomData", "Checksums"), [hashes](RomFields *fields) -> int {
+		if (hashes.flags & FileHasher::HASH_CRC32) {
+			fields->addField_string(C_("RomData", "CRC32"),
+				rp_sprintf("%08x", hashes.crc), RomFields::STRF_MONOSPACE);
+		}
+		if (hashes.flags & FileHasher::HASH_MD5) {
+			fields->addField_string(C_("RomData", "MD5"),
+				hexString(hashes.md5, sizeof(hashes.md5)), RomFields::STRF_MONOSPACE);
+		}
+		if (hashes.flags & FileHasher::HASH_SHA1) {
+			fields->addField_string(C_("RomData", "SHA-1"),
+				hexString(hashes.sha1, sizeof(hashes.sha1)), RomFields::STRF_MONOSPACE);
+		}
+		return 0;
+	});
+}
+
+/**
+ * Format the checksums as a status message.
+ * @return Status message.
+ */
+string RomDataPrivate::checksumsMessage(void) const
+{
+	string msg;
+	if (checksums.flags & FileHasher::HASH_CRC32) {
+		msg += rp_sprintf(C_("RomData", "CRC32: %08x"), checksums.crc);
+	}
+	if (checksums.flags & FileHasher::HASH_MD5) {
+		if (!msg.empty())
+			msg += '\n';
+		msg += rp_sprintf(C_("RomData", "MD5: %s"),
+			hexString(checksums.md5, sizeof(checksums.md5)).c_str());
+	}
+	if (checksums.flags & FileHasher::HASH_SHA1) {
+		if (!msg.empty())
+			msg += '\n';
+		msg += rp_sprintf(C_("RomData", "SHA-1: %s"),
+			hexString(checksums.sha1, sizeof(checksums.sha1)).c_str());
+	}
+	return msg;
+}
+
 /** Convenience functions. **/
 
 /**
@@ -526,6 +686,59 @@ void RomData::close(void)
 	UNREF_AND_NULL(d->file);
 }
 
+/**
+ * Release resources that aren't needed once loading is done.
+ *
+ * Field data, metadata, and the specified internal images
+ * are loaded, and then the file is closed. This releases the
+ * file handle, any DiscReaders, and any subclass buffers that
+ * are only needed to parse the file.
+ *
+ * Anything that was loaded remains available afterwards.
+ * Internal images that weren't loaded here will not be
+ * available, since the file is no longer open.
+ *
+ * This is intended for long-lived RomData objects, e.g. in
+ * property pages and caches, and for batch processing of
+ * many files.
+ *
+ * @param imgbf Bitfield of internal image types to load. (1U << IMG_INT_*)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomData::compact(uint32_t imgbf)
+{
+	RP_D(const RomData);
+	if (!d->isValid) {
+		// Unknown ROM image type.
+		return -EIO;
+	}
+
+	if (d->file) {
+		// Load everything that requires the file.
+		if (!d->metaDataOnly) {
+			fields();
+		}
+		metaData();
+
+		imgbf &= supportedImageTypes();
+		for (int i = IMG_INT_MIN; i <= IMG_INT_MAX && imgbf != 0; i++, imgbf >>= 1) {
+			if (!(imgbf & 1))
+				continue;
+			const ImageType imageType = static_cast<ImageType>(i);
+			image(imageType);
+			if (imageType == IMG_INT_ICON && (imgpf(imageType) & IMGPF_ICON_ANIMATED)) {
+				// Load the animated icon data as well.
+				iconAnimData();
+			}
+		}
+	}
+
+	// Close the file.
+	// Subclasses release their readers and buffers in close().
+	close();
+	return 0;
+}
+
 /**
  * Get a reference to the internal file.
  * @return Reference to file, or nullptr on error.
@@ -568,6 +781,57 @@ const char *RomData::className(void) const
 	return d->className;
 }
 
+/**
+ * Get the class ID for the user configuration.
+ * This is looked up from className() on first use.
+ * @return Class ID. (RomDataClassId::Unknown if the class name isn't known)
+ */
+RomDataClassId RomData::classId(void) const
+{
+	RomDataPrivate *const d = const_cast<RomDataPrivate*>(d_ptr);
+	int classId = ATOMIC_OR_FETCH(&d->classId, 0);
+	if (classId < 0) {
+		// Not looked up yet.
+		// NOTE: No lock is needed, since the result is always the same.
+		classId = static_cast<int>(lookupClassId(d->className));
+		ATOMIC_EXCHANGE(&d->classId, classId);
+	}
+	return static_cast<RomDataClassId>(classId);
+}
+
+/**
+ * Look up a class ID by class name.
+ * @param className Class name. (ASCII, case-insensitive)
+ * @return Class ID, or RomDataClassId::Unknown if not found.
+ */
+RomDataClassId RomData::lookupClassId(const char *className)
+{
+	// Class names. (sorted case-insensitively)
+	// Index + 1 == RomDataClassId.
+	static const char *const classNames[] = {
+#define RP_ROMDATA_CLASS_ID_NAME(klass) #klass,
+		RP_ROMDATA_CLASS_NAMES(RP_ROMDATA_CLASS_ID_NAME)
+#undef RP_ROMDATA_CLASS_ID_NAME
+	};
+	static_assert(ARRAY_SIZE(classNames) == static_cast<size_t>(RomDataClassId::Max) - 1,
+		"classNames[] is out of sync with RomDataClassId");
+
+	if (!className || className[0] == '\0') {
+		return RomDataClassId::Unknown;
+	}
+
+	// Binary search for the class name.
+	auto pName = std::lower_bound(&classNames[0], &classNames[ARRAY_SIZE(classNames)], className,
+		[](const char *name1, const char *name2) {
+			return (strcasecmp(name1, name2) < 0);
+		});
+	if (pName == &classNames[ARRAY_SIZE(classNames)] || strcasecmp(*pName, className) != 0) {
+		// Not found.
+		return RomDataClassId::Unknown;
+	}
+	return static_cast<RomDataClassId>(pName - &classNames[0] + 1);
+}
+
 /**
  * Get the general file type.
  * @return General file type.
@@ -747,6 +1011,61 @@ int RomData::loadInternalImage(ImageType imageType, const rp_image **pImage)
 	return -ENOENT;
 }
 
+/**
+ * Load an internal image, optionally at a reduced size.
+ * Called by RomData::imageForSize().
+ *
+ * Subclasses that can cheaply produce a smaller version of
+ * an image (e.g. textures with mipmaps) should override this.
+ * The default implementation calls loadInternalImage().
+ *
+ * @param imageType	[in] Image type to load.
+ * @param reqSize	[in] Requested size. (single dimension; 0 for the full image)
+ * @param pImage	[out] Pointer to const rp_image* to store the image in.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomData::loadInternalImageForSize(ImageType imageType, int reqSize, const rp_image **pImage)
+{
+	RP_UNUSED(reqSize);
+	return loadInternalImage(imageType, pImage);
+}
+
+/**
+ * Load a mipmap of an internal image.
+ * Called by RomData::imageMipmap().
+ *
+ * Subclasses that have internal images with mipmaps
+ * should override this and imageMipmapCount().
+ * The default implementation calls loadInternalImage()
+ * for mipmap 0.
+ *
+ * @param imageType	[in] Image type to load.
+ * @param mip		[in] Mipmap number. (0 for the full image)
+ * @param pImage	[out] Pointer to const rp_image* to store the image in.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomData::loadInternalImageMipmap(ImageType imageType, int mip, const rp_image **pImage)
+{
+	if (mip != 0) {
+		*pImage = nullptr;
+		return -ENOENT;
+	}
+	return loadInternalImage(imageType, pImage);
+}
+
+/**
+ * Get the number of mipmaps for an internal image.
+ * The default implementation returns 1, since most
+ * internal images don't have mipmaps.
+ * @param imageType Image type.
+ * @return Number of mipmaps, including the full image.
+ */
+int RomData::imageMipmapCount(ImageType imageType) const
+{
+	RP_UNUSED(imageType);
+	return 1;
+}
+
 /**
  * Load metadata properties.
  * Called by RomData::metaData() if the field data hasn't been loaded yet.
@@ -758,38 +1077,129 @@ int RomData::loadMetaData(void)
 	return -ENOTSUP;
 }
 
+/**
+ * Restrict this RomData object to metadata.
+ *
+ * This is intended for background indexers that only call
+ * metaData(), e.g. KFileMetaData and the Windows property
+ * store. Once set, field data and internal images will not
+ * be loaded, so fields(), fieldsDeferred(), image(), and
+ * imageForSize() will return nullptr.
+ *
+ * NOTE: This cannot be unset.
+ */
+void RomData::setMetaDataOnly(void)
+{
+	RP_D(RomData);
+	d->metaDataOnly = true;
+}
+
+/**
+ * Is this RomData object restricted to metadata?
+ * @return True if only metadata can be loaded; false if not.
+ */
+bool RomData::isMetaDataOnly(void) const
+{
+	RP_D(const RomData);
+	return d->metaDataOnly;
+}
+
 /**
  * Get the ROM Fields object.
+ * All tabs are loaded, including deferred tabs.
  * @return ROM Fields object.
  */
 const RomFields *RomData::fields(void) const
 {
-	RP_D(const RomData);
-	if (d->fields->empty()) {
-		// Data has not been loaded.
-		// Load it now.
-		int ret = const_cast<RomData*>(this)->loadFieldData();
-		if (ret < 0)
-			return nullptr;
+	const RomFields *const fields = fieldsDeferred();
+	if (fields) {
+		// Deferred tab loaders may read from the file.
+		RomDataPrivate *const d = const_cast<RomDataPrivate*>(d_ptr);
+		MutexLocker loadLock(d->loadMutex);
+		fields->loadAllTabs();
+	}
+	return fields;
+}
+
+/**
+ * Get the ROM Fields object without loading deferred tabs.
+ * Deferred tabs can be loaded later using RomFields::loadTab().
+ * This is intended for UIs that only show one tab at a time.
+ *
+ * If the calling thread's CancelToken is cancelled while the
+ * fields are being loaded, loading fails and nullptr is returned.
+ *
+ * @return ROM Fields object.
+ */
+const RomFields *RomData::fieldsDeferred(void) const
+{
+	RomDataPrivate *const d = const_cast<RomDataPrivate*>(d_ptr);
+	if (unlikely(d->metaDataOnly)) {
+		// Only metadata can be loaded.
+		return nullptr;
+	}
+
+	int loaded = ATOMIC_OR_FETCH(&d->fieldsLoaded, 0);
+	if (loaded == 0) {
+		MutexLocker loadLock(d->loadMutex);
+		loaded = d->fieldsLoaded;
+		if (loaded == 0) {
+			// Data has not been loaded.
+			// Load it now.
+			int ret = 0;
+			if (d->fields->empty()) {
+				ret = const_cast<RomData*>(this)->loadFieldData();
+				if (CancelToken::isCurrentCancelled()) {
+					// Loading was cancelled, so the fields may be incomplete.
+					ret = -ECANCELED;
+				}
+			}
+			loaded = (ret >= 0 ? 1 : -1);
+			ATOMIC_EXCHANGE(&d->fieldsLoaded, loaded);
+		}
+	}
+	if (loaded < 0)
+		return nullptr;
+
+	if (d->checksums.flags != 0 && !d->checksumTabAdded) {
+		// Checksums were calculated. Add them to the fields.
+		MutexLocker loadLock(d->loadMutex);
+		d->addChecksumTab();
 	}
 	return d->fields;
 }
 
 /**
  * Get the ROM Metadata object.
+ *
+ * If the calling thread's CancelToken is cancelled while the
+ * metadata is being loaded, loading fails and nullptr is returned.
+ *
  * @return ROM Metadata object.
  */
 const RomMetaData *RomData::metaData(void) const
 {
-	RP_D(const RomData);
-	if (!d->metaData || d->metaData->empty()) {
-		// Data has not been loaded.
-		// Load it now.
-		int ret = const_cast<RomData*>(this)->loadMetaData();
-		if (ret < 0)
-			return nullptr;
-	}
-	return d->metaData;
+	RomDataPrivate *const d = const_cast<RomDataPrivate*>(d_ptr);
+	int loaded = ATOMIC_OR_FETCH(&d->metaDataLoaded, 0);
+	if (loaded == 0) {
+		MutexLocker loadLock(d->loadMutex);
+		loaded = d->metaDataLoaded;
+		if (loaded == 0) {
+			// Data has not been loaded.
+			// Load it now.
+			int ret = 0;
+			if (!d->metaData || d->metaData->empty()) {
+				ret = const_cast<RomData*>(this)->loadMetaData();
+				if (CancelToken::isCurrentCancelled()) {
+					// Loading was cancelled, so the metadata may be incomplete.
+					ret = -ECANCELED;
+				}
+			}
+			loaded = (ret >= 0 ? 1 : -1);
+			ATOMIC_EXCHANGE(&d->metaDataLoaded, loaded);
+		}
+	}
+	return (loaded > 0 ? d->metaData : nullptr);
 }
 
 /**
@@ -798,6 +1208,10 @@ const RomMetaData *RomData::metaData(void) const
  * The retrieved image must be ref()'d by the caller if the
  * caller stores it instead of using it immediately.
  *
+ * If the calling thread's CancelToken is cancelled while the
+ * image is being loaded, nullptr is returned, and the image
+ * isn't shared with other RomData objects.
+ *
  * @param imageType Image type to load.
  * @return Internal image, or nullptr if the ROM doesn't have one.
  */
@@ -810,6 +1224,30 @@ const rp_image *RomData::image(ImageType imageType) const
 	}
 	// TODO: Check supportedImageTypes()?
 
+	RP_D(RomData);
+	if (unlikely(d->metaDataOnly)) {
+		// Only metadata can be loaded.
+		return nullptr;
+	}
+
+	// NOTE: Subclasses cache their internal images,
+	// so the image loading mutex also acts as the once flag here.
+	MutexLocker loadLock(d->imageLoadMutex());
+
+	// Check if the image was already decoded by another
+	// RomData object for the same file.
+	const rp_image *&imgShared = d->imgShared[imageType - IMG_INT_MIN];
+	if (imgShared) {
+		return imgShared;
+	}
+	const bool useImageCache = d->initImageCacheKey(imageType);
+	if (useImageCache) {
+		imgShared = ImageCache::lookup(d->imgCacheKey);
+		if (imgShared) {
+			return imgShared;
+		}
+	}
+
 	// Load the internal image.
 	// The subclass maintains ownership of the image.
 #ifdef _DEBUG
@@ -829,9 +1267,226 @@ const rp_image *RomData::image(ImageType imageType) const
 	// SANITY CHECK: `img` must not be -1LL.
 	assert(img != INVALID_IMG_PTR);
 
+	if (ret != 0)
+		return nullptr;
+
+	if (CancelToken::isCurrentCancelled()) {
+		// Loading was cancelled. Don't share the image,
+		// since reads may have been cut short.
+		return nullptr;
+	}
+
+	// Share the image with other RomData objects.
+	if (useImageCache) {
+		ImageCache::insert(d->imgCacheKey, img);
+	}
+	return img;
+}
+
+/**
+ * Get an internal image from the ROM, optionally at a reduced size.
+ *
+ * If the subclass supports it, the returned image is the
+ * smallest available version that is at least reqSize on
+ * its larger side. Otherwise, this is the same as image().
+ *
+ * The retrieved image must be ref()'d by the caller if the
+ * caller stores it instead of using it immediately.
+ *
+ * @param imageType Image type to load.
+ * @param reqSize Requested size. (single dimension; 0 for the full image)
+ * @return Internal image, or nullptr if the ROM doesn't have one.
+ */
+const rp_image *RomData::imageForSize(ImageType imageType, int reqSize) const
+{
+	assert(imageType >= IMG_INT_MIN && imageType <= IMG_INT_MAX);
+	if (imageType < IMG_INT_MIN || imageType > IMG_INT_MAX) {
+		// ImageType is out of range.
+		return nullptr;
+	} else if (reqSize <= 0) {
+		// Full image requested.
+		return image(imageType);
+	}
+
+	RP_D(const RomData);
+	if (unlikely(d->metaDataOnly)) {
+		// Only metadata can be loaded.
+		return nullptr;
+	}
+
+	// Load the internal image.
+	// The subclass maintains ownership of the image.
+	MutexLocker loadLock(const_cast<RomDataPrivate*>(d)->imageLoadMutex());
+	const rp_image *img = nullptr;
+	int ret = const_cast<RomData*>(this)->loadInternalImageForSize(imageType, reqSize, &img);
+
+	// SANITY CHECK: If loadInternalImageForSize() returns 0,
+	// img *must* be valid. Otherwise, it must be nullptr.
+	assert((ret == 0 && img != nullptr) ||
+	       (ret != 0 && img == nullptr));
+
 	return (ret == 0 ? img : nullptr);
 }
 
+/**
+ * Get a mipmap of an internal image from the ROM.
+ * Mipmap 0 is the same as image().
+ *
+ * The retrieved image must be ref()'d by the caller if the
+ * caller stores it instead of using it immediately.
+ *
+ * @param imageType Image type to load.
+ * @param mip Mipmap number. (See imageMipmapCount().)
+ * @return Mipmap, or nullptr if the ROM doesn't have it.
+ */
+const rp_image *RomData::imageMipmap(ImageType imageType, int mip) const
+{
+	assert(imageType >= IMG_INT_MIN && imageType <= IMG_INT_MAX);
+	assert(mip >= 0);
+	if (imageType < IMG_INT_MIN || imageType > IMG_INT_MAX || mip < 0) {
+		// ImageType or mipmap number is out of range.
+		return nullptr;
+	} else if (mip == 0) {
+		// Full image requested.
+		return image(imageType);
+	}
+
+	RP_D(const RomData);
+	if (unlikely(d->metaDataOnly)) {
+		// Only metadata can be loaded.
+		return nullptr;
+	}
+
+	// Load the mipmap.
+	// The subclass maintains ownership of the image.
+	MutexLocker loadLock(const_cast<RomDataPrivate*>(d)->imageLoadMutex());
+	const rp_image *img = nullptr;
+	int ret = const_cast<RomData*>(this)->loadInternalImageMipmap(imageType, mip, &img);
+
+	// SANITY CHECK: If loadInternalImageMipmap() returns 0,
+	// img *must* be valid. Otherwise, it must be nullptr.
+	assert((ret == 0 && img != nullptr) ||
+	       (ret != 0 && img == nullptr));
+
+	return (ret == 0 ? img : nullptr);
+}
+
+/**
+ * Background image loading job.
+ */
+struct LoadImagesAsyncJob {
+	const RomData *romData;		// ref()'d
+	uint32_t imgbf;
+	RomData::PFN_IMAGES_LOADED pfnComplete;
+	void *userdata;
+};
+
+/**
+ * Background image loading thread.
+ * @param param LoadImagesAsyncJob (will be deleted by this function)
+ * @return 0
+ */
+#ifdef _WIN32
+static DWORD WINAPI loadImagesAsyncThread(LPVOID param)
+#else /* !_WIN32 */
+static void *loadImagesAsyncThread(void *param)
+#endif /* _WIN32 */
+{
+	LoadImagesAsyncJob *const job = static_cast<LoadImagesAsyncJob*>(param);
+	const RomData *const romData = job->romData;
+
+	uint32_t loaded = 0;
+	uint32_t imgbf = job->imgbf;
+	for (int i = RomData::IMG_INT_MIN; i <= RomData::IMG_INT_MAX && imgbf != 0; i++, imgbf >>= 1) {
+		if (!(imgbf & 1))
+			continue;
+		const RomData::ImageType imageType = static_cast<RomData::ImageType>(i);
+		if (!romData->image(imageType))
+			continue;
+		loaded |= (1U << i);
+
+		if (imageType == RomData::IMG_INT_ICON &&
+		    (romData->imgpf(imageType) & RomData::IMGPF_ICON_ANIMATED))
+		{
+			// Load the animated icon data as well.
+			romData->iconAnimData();
+		}
+	}
+
+	job->pfnComplete(romData, loaded, job->userdata);
+	const_cast<RomData*>(romData)->unref();
+	delete job;
+	return 0;
+}
+
+/**
+ * Load internal images in the background.
+ *
+ * The specified internal images are decoded on a separate
+ * thread using image(). If the icon is animated, the animated
+ * icon data is loaded as well. The caller can load the field
+ * data on its own thread in the meantime.
+ *
+ * Image decoding only runs concurrently with field parsing
+ * if the subclass supports it. Otherwise, the two will be
+ * serialized, but the caller's thread won't be blocked
+ * until it actually needs the file.
+ *
+ * This RomData object is ref()'d until the callback returns.
+ *
+ * If this function succeeds, the callback will be called
+ * exactly once from a background thread, even if none of
+ * the images could be loaded.
+ *
+ * @param imgbf Bitfield of internal image types to load. (1U << IMG_INT_*)
+ * @param pfnComplete Completion callback.
+ * @param userdata User data for the completion callback.
+ * @return 0 if image loading was started; negative POSIX error code on error.
+ */
+int RomData::loadImagesAsync(uint32_t imgbf, PFN_IMAGES_LOADED pfnComplete, void *userdata) const
+{
+	assert(pfnComplete != nullptr);
+	if (!pfnComplete) {
+		return -EINVAL;
+	}
+
+	RP_D(const RomData);
+	if (!d->isValid) {
+		// Unknown ROM image type.
+		return -EIO;
+	} else if (d->metaDataOnly) {
+		// Only metadata can be loaded.
+		return -ENOTSUP;
+	}
+
+	LoadImagesAsyncJob *const job = new LoadImagesAsyncJob;
+	job->romData = const_cast<RomData*>(this)->ref();
+	job->imgbf = imgbf & supportedImageTypes();
+	job->pfnComplete = pfnComplete;
+	job->userdata = userdata;
+
+	// NOTE: The thread is detached.
+#ifdef _WIN32
+	HANDLE hThread = CreateThread(nullptr, 0, loadImagesAsyncThread, job, 0, nullptr);
+	if (!hThread) {
+		const_cast<RomData*>(job->romData)->unref();
+		delete job;
+		return -ENOMEM;
+	}
+	CloseHandle(hThread);
+#else /* !_WIN32 */
+	pthread_t thread;
+	int ret = pthread_create(&thread, nullptr, loadImagesAsyncThread, job);
+	if (ret != 0) {
+		const_cast<RomData*>(job->romData)->unref();
+		delete job;
+		return -ret;
+	}
+	pthread_detach(thread);
+#endif /* _WIN32 */
+	return 0;
+}
+
 /**
  * Get a list of URLs for an external image type.
  *
@@ -975,6 +1630,10 @@ vector<RomData::RomOp> RomData::romOps(void) const
 		);
 	}
 
+	// Whole-file checksums are available for all RomData subclasses.
+	v_ops.emplace_back(C_("RomData|RomOps", "Calculate &Checksums"),
+		(d->file || !d->filename.empty()) ? RomOp::ROF_ENABLED : 0);
+
 	return v_ops;
 }
 
@@ -990,12 +1649,25 @@ int RomData::doRomOp(int id, RomOpParams *pParams)
 	// TODO: Function to retrieve only a single RomOp.
 	const vector<RomOp> v_ops = romOps_int();
 	assert(id >= 0);
-	assert(id < (int)v_ops.size());
+	assert(id <= (int)v_ops.size());
 	assert(pParams != nullptr);
-	if (id < 0 || id >= (int)v_ops.size() || !pParams) {
+	if (id < 0 || id > (int)v_ops.size() || !pParams) {
 		return -EINVAL;
 	}
 
+	if (id == (int)v_ops.size()) {
+		// Whole-file checksums. (base class ROM operation)
+		const int ret = calcChecksums();
+		pParams->status = ret;
+		if (ret == 0) {
+			pParams->msg = d->checksumsMessage();
+		} else {
+			pParams->msg = rp_sprintf(C_("RomData", "Unable to calculate checksums: %s"),
+				strerror(-ret));
+		}
+		return ret;
+	}
+
 	bool closeFileAfter;
 	if (d->file) {
 		closeFileAfter = false;
@@ -1080,4 +1752,110 @@ int RomData::doRomOp_int(int id, RomOpParams *pParams)
 	return -ENOTSUP;
 }
 
+/** Checksums **/
+
+/**
+ * Calculate whole-file checksums. (CRC32, MD5, SHA-1)
+ *
+ * The logical image is hashed, so compressed and sparse
+ * disc image formats produce the checksums of the
+ * decompressed image. MD5 and SHA-1 are only available
+ * if decryption is enabled.
+ *
+ * If this is called before the fields are loaded, the
+ * checksums will be included in a "Checksums" tab.
+ *
+ * This is also available as the last ROM operation.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomData::calcChecksums(void)
+{
+	RP_D(RomData);
+	// The whole file is read using the shared IRpFile.
+	MutexLocker loadLock(d->loadMutex);
+	if (d->checksums.flags != 0) {
+		// Checksums were already calculated.
+		return 0;
+	}
+
+	bool closeFileAfter = false;
+	if (!d->file) {
+		// Reopen the file.
+		if (d->filename.empty()) {
+			return -EBADF;
+		}
+		RpFile *const file = new RpFile(d->filename, d->isCompressed
+			? RpFile::FM_OPEN_READ_GZ
+			: RpFile::FM_OPEN_READ);
+		if (!file->isOpen()) {
+			// Error opening the file.
+			int ret = -file->lastError();
+			if (ret == 0) {
+				ret = -EIO;
+			}
+			UNREF(file);
+			return ret;
+		}
+		d->file = file;
+		closeFileAfter = true;
+	}
+
+	int ret;
+	IDiscReader *const discReader = openDataReader();
+	if (discReader) {
+		// The entire image is read once, so don't let it
+		// evict everything else from the OS cache.
+		discReader->adviseAccess(IRpFile::AccessPattern::Streaming);
+
+		// Compressed images: Decompress blocks in parallel.
+		// NOTE: The disc reader may be shared with the RomData
+		// subclass, so the original thread count is restored.
+		SparseDiscReader *const sparseReader = dynamic_cast<SparseDiscReader*>(discReader);
+		const unsigned int oldThreadCount = (sparseReader ? sparseReader->threadCount() : 1);
+		if (sparseReader) {
+			sparseReader->setThreadCount(0);
+		}
+
+		ret = FileHasher::hashDisc(d->checksums, discReader);
+
+		if (sparseReader) {
+			sparseReader->setThreadCount(oldThreadCount);
+		}
+		if (!closeFileAfter) {
+			discReader->adviseAccess(IRpFile::AccessPattern::Normal);
+		}
+		discReader->unref();
+	} else {
+		ret = -EIO;
+	}
+
+	if (closeFileAfter) {
+		UNREF_AND_NULL_NOCHK(d->file);
+	}
+	return ret;
+}
+
+/**
+ * Open a reader for the logical image data.
+ * This is used for whole-file checksums.
+ *
+ * The default implementation reads the file as-is.
+ * Subclasses for compressed or sparse container formats
+ * should return the reader for the decompressed image.
+ *
+ * NOTE: The file may have been reopened temporarily
+ * if the RomData object was closed.
+ *
+ * @return IDiscReader (caller must unref()), or nullptr on error.
+ */
+IDiscReader *RomData::openDataReader(void)
+{
+	RP_D(RomData);
+	if (!d->file) {
+		return nullptr;
+	}
+	return new DiscReader(d->file);
+}
+
 }
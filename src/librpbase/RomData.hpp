@@ -12,6 +12,7 @@
 #include "common.h"
 #include "RefBase.hpp"
 #include "RomData_decl.hpp"
+#include "RomDataClassId.hpp"
 
 // C includes.
 #include <stdint.h>
@@ -32,6 +33,7 @@ namespace LibRpBase {
 
 class RomFields;
 class RomMetaData;
+class IDiscReader;
 struct IconAnimData;
 
 class RomDataPrivate;
@@ -105,6 +107,27 @@ class RomData : public RefBase
 		 */
 		virtual void close(void);
 
+		/**
+		 * Release resources that aren't needed once loading is done.
+		 *
+		 * Field data, metadata, and the specified internal images
+		 * are loaded, and then the file is closed. This releases the
+		 * file handle, any DiscReaders, and any subclass buffers that
+		 * are only needed to parse the file.
+		 *
+		 * Anything that was loaded remains available afterwards.
+		 * Internal images that weren't loaded here will not be
+		 * available, since the file is no longer open.
+		 *
+		 * This is intended for long-lived RomData objects, e.g. in
+		 * property pages and caches, and for batch processing of
+		 * many files.
+		 *
+		 * @param imgbf Bitfield of internal image types to load. (1U << IMG_INT_*)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int compact(uint32_t imgbf = 0);
+
 		/**
 		 * Get a reference to the internal file.
 		 * @return Reference to file, or nullptr on error.
@@ -206,6 +229,20 @@ class RomData : public RefBase
 		 */
 		const char *className(void) const;
 
+		/**
+		 * Get the class ID for the user configuration.
+		 * This is looked up from className() on first use.
+		 * @return Class ID. (RomDataClassId::Unknown if the class name isn't known)
+		 */
+		RomDataClassId classId(void) const;
+
+		/**
+		 * Look up a class ID by class name.
+		 * @param className Class name. (ASCII, case-insensitive)
+		 * @return Class ID, or RomDataClassId::Unknown if not found.
+		 */
+		static RomDataClassId lookupClassId(const char *className);
+
 		enum class FileType {
 			Unknown = 0,
 
@@ -433,15 +470,92 @@ class RomData : public RefBase
 		 */
 		virtual int loadInternalImage(ImageType imageType, const LibRpTexture::rp_image **pImage);
 
+		/**
+		 * Load an internal image, optionally at a reduced size.
+		 * Called by RomData::imageForSize().
+		 *
+		 * Subclasses that can cheaply produce a smaller version of
+		 * an image (e.g. textures with mipmaps) should override this.
+		 * The default implementation calls loadInternalImage().
+		 *
+		 * @param imageType	[in] Image type to load.
+		 * @param reqSize	[in] Requested size. (single dimension; 0 for the full image)
+		 * @param pImage	[out] Pointer to const rp_image* to store the image in.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int loadInternalImageForSize(ImageType imageType, int reqSize, const LibRpTexture::rp_image **pImage);
+
+		/**
+		 * Load a mipmap of an internal image.
+		 * Called by RomData::imageMipmap().
+		 *
+		 * Subclasses that have internal images with mipmaps
+		 * should override this and imageMipmapCount().
+		 * The default implementation calls loadInternalImage()
+		 * for mipmap 0.
+		 *
+		 * @param imageType	[in] Image type to load.
+		 * @param mip		[in] Mipmap number. (0 for the full image)
+		 * @param pImage	[out] Pointer to const rp_image* to store the image in.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int loadInternalImageMipmap(ImageType imageType, int mip, const LibRpTexture::rp_image **pImage);
+
+		/**
+		 * Get the number of mipmaps for an internal image.
+		 * The default implementation returns 1, since most
+		 * internal images don't have mipmaps.
+		 * @param imageType Image type.
+		 * @return Number of mipmaps, including the full image.
+		 */
+		virtual int imageMipmapCount(ImageType imageType) const;
+
+	public:
+		/**
+		 * Restrict this RomData object to metadata.
+		 *
+		 * This is intended for background indexers that only call
+		 * metaData(), e.g. KFileMetaData and the Windows property
+		 * store. Once set, field data and internal images will not
+		 * be loaded, so fields(), fieldsDeferred(), image(), and
+		 * imageForSize() will return nullptr.
+		 *
+		 * NOTE: This cannot be unset.
+		 */
+		void setMetaDataOnly(void);
+
+		/**
+		 * Is this RomData object restricted to metadata?
+		 * @return True if only metadata can be loaded; false if not.
+		 */
+		bool isMetaDataOnly(void) const;
+
 	public:
 		/**
 		 * Get the ROM Fields object.
+		 * All tabs are loaded, including deferred tabs.
 		 * @return ROM Fields object.
 		 */
 		const RomFields *fields(void) const;
 
+		/**
+		 * Get the ROM Fields object without loading deferred tabs.
+		 * Deferred tabs can be loaded later using RomFields::loadTab().
+		 * This is intended for UIs that only show one tab at a time.
+		 *
+		 * If the calling thread's CancelToken is cancelled while the
+		 * fields are being loaded, loading fails and nullptr is returned.
+		 *
+		 * @return ROM Fields object.
+		 */
+		const RomFields *fieldsDeferred(void) const;
+
 		/**
 		 * Get the ROM Metadata object.
+		 *
+		 * If the calling thread's CancelToken is cancelled while the
+		 * metadata is being loaded, loading fails and nullptr is returned.
+		 *
 		 * @return ROM Metadata object.
 		 */
 		const RomMetaData *metaData(void) const;
@@ -461,11 +575,79 @@ class RomData : public RefBase
 		 * The retrieved image must be ref()'d by the caller if the
 		 * caller stores it instead of using it immediately.
 		 *
+		 * If the calling thread's CancelToken is cancelled while the
+		 * image is being loaded, nullptr is returned, and the image
+		 * isn't shared with other RomData objects.
+		 *
 		 * @param imageType Image type to load.
 		 * @return Internal image, or nullptr if the ROM doesn't have one.
 		 */
 		const LibRpTexture::rp_image *image(ImageType imageType) const;
 
+		/**
+		 * Get an internal image from the ROM, optionally at a reduced size.
+		 *
+		 * If the subclass supports it, the returned image is the
+		 * smallest available version that is at least reqSize on
+		 * its larger side. Otherwise, this is the same as image().
+		 *
+		 * The retrieved image must be ref()'d by the caller if the
+		 * caller stores it instead of using it immediately.
+		 *
+		 * @param imageType Image type to load.
+		 * @param reqSize Requested size. (single dimension; 0 for the full image)
+		 * @return Internal image, or nullptr if the ROM doesn't have one.
+		 */
+		const LibRpTexture::rp_image *imageForSize(ImageType imageType, int reqSize) const;
+
+		/**
+		 * Get a mipmap of an internal image from the ROM.
+		 * Mipmap 0 is the same as image().
+		 *
+		 * The retrieved image must be ref()'d by the caller if the
+		 * caller stores it instead of using it immediately.
+		 *
+		 * @param imageType Image type to load.
+		 * @param mip Mipmap number. (See imageMipmapCount().)
+		 * @return Mipmap, or nullptr if the ROM doesn't have it.
+		 */
+		const LibRpTexture::rp_image *imageMipmap(ImageType imageType, int mip) const;
+
+		/**
+		 * loadImagesAsync() completion callback.
+		 * This is called from the image loading thread.
+		 * @param romData RomData object.
+		 * @param imgbf Bitfield of internal images that were loaded. (1U << IMG_INT_*)
+		 * @param userdata User data specified when calling loadImagesAsync().
+		 */
+		typedef void (*PFN_IMAGES_LOADED)(const RomData *romData, uint32_t imgbf, void *userdata);
+
+		/**
+		 * Load internal images in the background.
+		 *
+		 * The specified internal images are decoded on a separate
+		 * thread using image(). If the icon is animated, the animated
+		 * icon data is loaded as well. The caller can load the field
+		 * data on its own thread in the meantime.
+		 *
+		 * Image decoding only runs concurrently with field parsing
+		 * if the subclass supports it. Otherwise, the two will be
+		 * serialized, but the caller's thread won't be blocked
+		 * until it actually needs the file.
+		 *
+		 * This RomData object is ref()'d until the callback returns.
+		 *
+		 * If this function succeeds, the callback will be called
+		 * exactly once from a background thread, even if none of
+		 * the images could be loaded.
+		 *
+		 * @param imgbf Bitfield of internal image types to load. (1U << IMG_INT_*)
+		 * @param pfnComplete Completion callback.
+		 * @param userdata User data for the completion callback.
+		 * @return 0 if image loading was started; negative POSIX error code on error.
+		 */
+		int loadImagesAsync(uint32_t imgbf, PFN_IMAGES_LOADED pfnComplete, void *userdata) const;
+
 		/**
 		 * External URLs for a media type.
 		 * Includes URL and "cache key" for local caching,
@@ -580,6 +762,7 @@ class RomData : public RefBase
 				ROF_ENABLED		= (1U << 0),	// Set to enable the ROM op
 				ROF_REQ_WRITABLE	= (1U << 1),	// Requires a writable RomData
 				ROF_SAVE_FILE		= (1U << 2),	// Prompt to save a new file
+				ROF_VERIFY		= (1U << 3),	// Read-only data verification
 			};
 
 			// Data depends on RomOpsFlags.
@@ -646,6 +829,42 @@ class RomData : public RefBase
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		virtual int doRomOp_int(int id, RomOpParams *pParams);
+
+	public:
+		/** Checksums **/
+
+		/**
+		 * Calculate whole-file checksums. (CRC32, MD5, SHA-1)
+		 *
+		 * The logical image is hashed, so compressed and sparse
+		 * disc image formats produce the checksums of the
+		 * decompressed image. MD5 and SHA-1 are only available
+		 * if decryption is enabled.
+		 *
+		 * If this is called before the fields are loaded, the
+		 * checksums will be included in a "Checksums" tab.
+		 *
+		 * This is also available as the last ROM operation.
+		 *
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int calcChecksums(void);
+
+	protected:
+		/**
+		 * Open a reader for the logical image data.
+		 * This is used for whole-file checksums.
+		 *
+		 * The default implementation reads the file as-is.
+		 * Subclasses for compressed or sparse container formats
+		 * should return the reader for the decompressed image.
+		 *
+		 * NOTE: The file may have been reopened temporarily
+		 * if the RomData object was closed.
+		 *
+		 * @return IDiscReader (caller must unref()), or nullptr on error.
+		 */
+		virtual IDiscReader *openDataReader(void);
 };
 
 }
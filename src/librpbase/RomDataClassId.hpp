@@ -0,0 +1,98 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * RomDataClassId.hpp: RomData class IDs.                                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_ROMDATACLASSID_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_ROMDATACLASSID_HPP__
+
+// C includes.
+#include <stdint.h>
+
+/**
+ * RomData class names, as set in RomDataPrivate::className.
+ *
+ * This list covers the classes registered in RomDataFactory.
+ * Classes that share a configuration section with another
+ * class (e.g. Nintendo3DS_SMDH -> Nintendo3DS) use the
+ * shared class name, so they aren't listed separately.
+ *
+ * NOTE: This list MUST be sorted case-insensitively, since
+ * RomData::lookupClassId() uses a binary search.
+ * New classes can be inserted anywhere; class IDs are only
+ * used at runtime and are never saved.
+ */
+#define RP_ROMDATA_CLASS_NAMES(X) \
+	X(ADX) \
+	X(Amiibo) \
+	X(BCSTM) \
+	X(BRSTM) \
+	X(DMG) \
+	X(Dreamcast) \
+	X(DreamcastSave) \
+	X(ELF) \
+	X(EXE) \
+	X(GameBoyAdvance) \
+	X(GameCom) \
+	X(GameCube) \
+	X(GameCubeSave) \
+	X(GBS) \
+	X(iQuePlayer) \
+	X(ISO) \
+	X(Lynx) \
+	X(MachO) \
+	X(MegaDrive) \
+	X(N64) \
+	X(NES) \
+	X(NGPC) \
+	X(Nintendo3DS) \
+	X(Nintendo3DSFirm) \
+	X(NintendoBadge) \
+	X(NintendoDS) \
+	X(NSF) \
+	X(PlayStationDisc) \
+	X(PlayStationEXE) \
+	X(PlayStationSave) \
+	X(PokemonMini) \
+	X(PSF) \
+	X(PSP) \
+	X(RpTextureWrapper) \
+	X(SAP) \
+	X(Sega8Bit) \
+	X(SegaSaturn) \
+	X(SID) \
+	X(SNDH) \
+	X(SNES) \
+	X(SPC) \
+	X(VGM) \
+	X(VirtualBoy) \
+	X(WiiSave) \
+	X(WiiU) \
+	X(WiiWAD) \
+	X(Xbox360_STFS) \
+	X(Xbox360_XEX) \
+	X(Xbox_XBE) \
+	X(XboxDisc)
+
+namespace LibRpBase {
+
+/**
+ * RomData class ID.
+ * Used for direct-indexed per-class tables, e.g. image type priorities.
+ */
+enum class RomDataClassId : uint8_t {
+	Unknown = 0,
+
+#define RP_ROMDATA_CLASS_ID_ENUM(klass) klass,
+	RP_ROMDATA_CLASS_NAMES(RP_ROMDATA_CLASS_ID_ENUM)
+#undef RP_ROMDATA_CLASS_ID_ENUM
+
+	Max
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_ROMDATACLASSID_HPP__ */
@@ -277,6 +277,19 @@ class klass final : public LibRpBase::RomData { \
 		 */ \
 		int doRomOp_int(int id, RomOpParams *pParams) final;
 
+/**
+ * RomData subclass function declaration for reading the logical image data.
+ * Needed for compressed or sparse container formats.
+ */
+#define ROMDATA_DECL_DATAREADER() \
+	protected: \
+		/** \
+		 * Open a reader for the logical image data. \
+		 * This is used for whole-file checksums. \
+		 * @return IDiscReader (caller must unref()), or nullptr on error. \
+		 */ \
+		LibRpBase::IDiscReader *openDataReader(void) final;
+
 /**
  * RomData subclass function declaration for closing the internal file handle.
  * Only needed if extra handling is needed, e.g. if multiple files are opened.
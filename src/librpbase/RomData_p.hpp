@@ -21,6 +21,15 @@
 #include "RomFields.hpp"
 #include "RomMetaData.hpp"
 
+// Process-wide image cache.
+#include "img/ImageCache.hpp"
+
+// Whole-file checksums.
+#include "crypto/FileHasher.hpp"
+
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+
 namespace LibRpFile {
 	class IRpFile;
 }
@@ -55,17 +64,112 @@ class RomDataPrivate
 	public:
 		bool isValid;			// Subclass must set this to true if the ROM is valid.
 		bool isCompressed;		// True if the file is compressed. (transparent decompression)
+		bool metaDataOnly;		// True if only metadata will be loaded. (see RomData::setMetaDataOnly())
 		LibRpFile::IRpFile *file;	// Open file.
 		std::string filename;		// Copy of the filename.
 		RomFields *const fields;	// ROM fields. (NOTE: allocated by the base class)
 		RomMetaData *metaData;		// ROM metadata. (NOTE: nullptr initially.)
 
+	public:
+		/** Thread safety **/
+
+		// Lazy loading mutex. (recursive)
+		// Held while the subclass loads fields, metadata, and images,
+		// since the subclass loaders use seek() and read() on the
+		// shared IRpFile. This also protects imgShared[] unless
+		// concurrentImageLoad is set.
+		LibRpThreads::Mutex loadMutex;
+
+		// Image loading mutex. (recursive)
+		// Only used if concurrentImageLoad is set.
+		LibRpThreads::Mutex imageMutex;
+
+		// Set this to true in the subclass constructor if the
+		// internal image loaders don't share any state with the
+		// field and metadata loaders, i.e. they only use readAt()
+		// and data that's read in the constructor. Internal images
+		// can then be decoded while the fields are being loaded.
+		bool concurrentImageLoad;
+
+		/**
+		 * Get the mutex that protects the internal image loaders.
+		 * Subclasses must hold this while loading internal images
+		 * outside of loadInternalImage(), e.g. in iconAnimData().
+		 * @return Image loading mutex.
+		 */
+		inline LibRpThreads::Mutex &imageLoadMutex(void)
+		{
+			return (concurrentImageLoad ? imageMutex : loadMutex);
+		}
+
+		// Once flags for lazily-loaded data.
+		// Accessed using ATOMIC_OR_FETCH() so the loaded data
+		// can be returned without locking loadMutex.
+		// 0 == not loaded; 1 == loaded; -1 == error
+		volatile int fieldsLoaded;
+		volatile int metaDataLoaded;
+
+		/**
+		 * Read data from the file at the specified position.
+		 *
+		 * If the file has a native file descriptor, a positional
+		 * read is used, which doesn't change the file position and
+		 * is safe to call from multiple threads. Otherwise, the
+		 * read is done with loadMutex held.
+		 *
+		 * @param pos	[in] File position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		size_t readAt(off64_t pos, void *ptr, size_t size);
+
 	public:
 		/** These fields must be set by RomData subclasses in their constructors. **/
 		const char *className;		// Class name for user configuration. (ASCII) (default is nullptr)
 		const char *mimeType;		// MIME type. (ASCII) (default is nullptr)
 		RomData::FileType fileType;	// File type. (default is FileType::ROM_Image)
 
+		// Class ID, looked up from className on first use.
+		// (-1 if not looked up yet)
+		volatile int classId;
+
+	public:
+		// Internal images obtained from the process-wide ImageCache.
+		// These are ref()'d, since RomData::image() doesn't transfer
+		// ownership to the caller.
+		const LibRpTexture::rp_image *imgShared[RomData::IMG_INT_MAX - RomData::IMG_INT_MIN + 1];
+
+		// ImageCache key for this file.
+		// imgCacheKeyState: 0 == not initialized; 1 == valid; -1 == file can't be cached
+		ImageCache::Key imgCacheKey;
+		int8_t imgCacheKeyState;
+
+		/**
+		 * Initialize the ImageCache key for an internal image.
+		 * @param imageType Image type.
+		 * @return True if the key is valid; false if the image can't be cached.
+		 */
+		bool initImageCacheKey(RomData::ImageType imageType);
+
+	public:
+		// Whole-file checksums. (flags == 0 if not calculated)
+		FileHasher::Hashes checksums;
+		bool checksumTabAdded;
+
+		/**
+		 * Add the "Checksums" tab to the fields.
+		 * This is done after the subclass loads its fields.
+		 */
+		void addChecksumTab(void);
+
+		/**
+		 * Format the checksums as a status message.
+		 * @return Status message.
+		 */
+		std::string checksumsMessage(void) const;
+
 	public:
 		/** Convenience functions. **/
 
@@ -8,11 +8,21 @@
 
 #include "stdafx.h"
 #include "RomFields.hpp"
+#include "Arena.hpp"
+#include "RefBase.hpp"
+#include "librptexture/img/rp_image.hpp"
 
 #include "libi18n/i18n.h"
 
 // librpthreads
 #include "librpthreads/Atomics.h"
+#include "librpthreads/Mutex.hpp"
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
+// librpfile
+#include "librpfile/RpAllocStats.hpp"
+namespace RpAllocStats = LibRpFile::RpAllocStats;
 
 // C++ STL classes.
 using std::map;
@@ -24,11 +34,14 @@ using LibRpTexture::rp_image;
 
 namespace LibRpBase {
 
-class RomFieldsPrivate
+// NOTE: RomFieldsPrivate is reference-counted so its field data
+// can be shared by other RomFields objects. See addFields_romFields().
+class RomFieldsPrivate : public RefBase
 {
 	public:
 		RomFieldsPrivate();
-		~RomFieldsPrivate();
+	protected:
+		~RomFieldsPrivate() final;	// call unref() instead
 
 	private:
 		RP_DISABLE_COPY(RomFieldsPrivate)
@@ -42,11 +55,82 @@ class RomFieldsPrivate
 		// Tab names.
 		vector<string> tabNames;
 
+		// Loaders for deferred tabs, indexed by tab.
+		// An empty function means the tab has been loaded.
+		// Only resized if a deferred tab is added.
+		vector<RomFields::TabLoader> tabLoaders;
+		int firstDeferredTab;	// -1 if none
+
 		// Default language code.
 		// Set by the first call to addField_string_multi()
 		// and/or addField_listData with RFT_LISTDATA_MULTI.
 		uint32_t def_lc;
 
+		// Arena for RFT_STRING and RFT_AGE_RATINGS data.
+		Arena arena;
+
+		// Other RomFieldsPrivate objects whose field data is
+		// shared by this object. (ref()'d)
+		// Fields with shared data have isShared set.
+		vector<RomFieldsPrivate*> shared;
+
+#ifdef ENABLE_ALLOC_STATS
+		// fields.capacity() as last reported to RpAllocStats.
+		size_t fieldsCapacity;
+#endif /* ENABLE_ALLOC_STATS */
+
+		/**
+		 * Share field data from another RomFieldsPrivate object.
+		 * @param other Other RomFieldsPrivate object.
+		 */
+		void addShared(RomFieldsPrivate *other)
+		{
+			if (std::find(shared.cbegin(), shared.cend(), other) == shared.cend()) {
+				shared.push_back(other->ref<RomFieldsPrivate>());
+			}
+		}
+
+		/**
+		 * Set an RFT_STRING field's string data.
+		 * @param field Field.
+		 * @param str String. (nullptr or empty for an empty string)
+		 * @param len Length of str.
+		 */
+		inline void setFieldString(RomFields::Field &field, const char *str, size_t len)
+		{
+			if (str && len > 0) {
+				field.data.str.data = arena.strdup(str, len);
+				field.data.str.size = len;
+			} else {
+				field.data.str.data = nullptr;
+				field.data.str.size = 0;
+			}
+		}
+
+		/**
+		 * Report changes in this->fields' capacity to RpAllocStats.
+		 * Call this after any operation that may reallocate the vector.
+		 */
+#ifdef ENABLE_ALLOC_STATS
+		void updateFieldsCapacity(void)
+		{
+			const size_t capacity = fields.capacity();
+			if (capacity == fieldsCapacity)
+				return;
+			if (fieldsCapacity > 0) {
+				RpAllocStats::onFree(RpAllocStats::TAG_ROMFIELDS,
+					fieldsCapacity * sizeof(RomFields::Field));
+			}
+			if (capacity > 0) {
+				RpAllocStats::onAlloc(RpAllocStats::TAG_ROMFIELDS,
+					capacity * sizeof(RomFields::Field));
+			}
+			fieldsCapacity = capacity;
+		}
+#else /* !ENABLE_ALLOC_STATS */
+		inline void updateFieldsCapacity(void) { }
+#endif /* ENABLE_ALLOC_STATS */
+
 		/**
 		 * Delete allocated objects in this->fields.
 		 * The vector will be cleared afterwards.
@@ -58,12 +142,27 @@ class RomFieldsPrivate
 
 RomFieldsPrivate::RomFieldsPrivate()
 	: tabIdx(0)
+	, firstDeferredTab(-1)
 	, def_lc(0)
+#ifdef ENABLE_ALLOC_STATS
+	, fieldsCapacity(0)
+#endif /* ENABLE_ALLOC_STATS */
 { }
 
 RomFieldsPrivate::~RomFieldsPrivate()
 {
 	delete_data();
+#ifdef ENABLE_ALLOC_STATS
+	if (fieldsCapacity > 0) {
+		RpAllocStats::onFree(RpAllocStats::TAG_ROMFIELDS,
+			fieldsCapacity * sizeof(RomFields::Field));
+	}
+#endif /* ENABLE_ALLOC_STATS */
+
+	// Release shared field data.
+	for (RomFieldsPrivate *p : shared) {
+		p->unref();
+	}
 }
 
 /**
@@ -75,8 +174,9 @@ void RomFieldsPrivate::delete_data(void)
 	// Delete all of the allocated objects in this->fields.
 	std::for_each(fields.begin(), fields.end(),
 		[](RomFields::Field &field) {
-			if (!field.isValid) {
-				// No data here.
+			if (!field.isValid || field.isShared) {
+				// No data here, or the data is owned
+				// by another RomFieldsPrivate object.
 				return;
 			}
 
@@ -88,7 +188,8 @@ void RomFieldsPrivate::delete_data(void)
 					break;
 
 				case RomFields::RFT_STRING:
-					delete const_cast<string*>(field.data.str);
+				case RomFields::RFT_AGE_RATINGS:
+					// Data is owned by the arena.
 					break;
 				case RomFields::RFT_BITFIELD:
 					delete const_cast<vector<string>*>(field.desc.bitfield.names);
@@ -104,9 +205,6 @@ void RomFieldsPrivate::delete_data(void)
 						delete const_cast<RomFields::ListDataIcons_t*>(field.data.list_data.mxd.icons);
 					}
 					break;
-				case RomFields::RFT_AGE_RATINGS:
-					delete const_cast<RomFields::age_ratings_t*>(field.data.age_ratings);
-					break;
 				case RomFields::RFT_STRING_MULTI:
 					delete const_cast<RomFields::StringMultiMap_t*>(field.data.str_multi);
 					break;
@@ -120,6 +218,7 @@ void RomFieldsPrivate::delete_data(void)
 
 	// Clear the fields vector.
 	this->fields.clear();
+	arena.reset();
 }
 
 /** RomFields **/
@@ -135,7 +234,9 @@ RomFields::RomFields()
 
 RomFields::~RomFields()
 {
-	delete d_ptr;
+	// NOTE: The field data may still be shared
+	// by other RomFields objects.
+	d_ptr->unref();
 }
 
 /**
@@ -351,6 +452,145 @@ string RomFields::ageRatingsDecode(const age_ratings_t *age_ratings, bool newlin
 	return str;
 }
 
+/** StringMultiMap_t **/
+
+/**
+ * Add a string that will be converted the first time it's accessed.
+ * The map must have been created with a converter function.
+ * @param lc Language code.
+ */
+void RomFields::StringMultiMap_t::addLazy(uint32_t lc)
+{
+	assert(m_converter);
+	if (!m_converter)
+		return;
+
+	// The string is empty until it's converted.
+	(*this)[lc].clear();
+	m_lazy.insert(lc);
+}
+
+/**
+ * Get a string, converting it if necessary.
+ * @param lc Language code.
+ * @return String, or nullptr if not found.
+ */
+const string *RomFields::StringMultiMap_t::get(uint32_t lc) const
+{
+	const_iterator iter = find(lc);
+	if (iter == cend())
+		return nullptr;
+	return &get(iter);
+}
+
+/**
+ * Get a string, converting it if necessary.
+ * @param iter Iterator. (must be valid)
+ * @return String.
+ */
+const string &RomFields::StringMultiMap_t::get(const_iterator iter) const
+{
+	if (!m_lazy.empty() && m_lazy.erase(iter->first) != 0) {
+		// Convert the string now.
+		// NOTE: The map is never actually const, since
+		// RomFields allocates it. Only the value is changed.
+		const_cast<string&>(iter->second) = m_converter(iter->first);
+	}
+	return iter->second;
+}
+
+/**
+ * Convert all lazy strings.
+ */
+void RomFields::StringMultiMap_t::loadAll(void) const
+{
+	if (m_lazy.empty())
+		return;
+
+	for (const uint32_t lc : m_lazy) {
+		const_iterator iter = find(lc);
+		if (iter != cend()) {
+			const_cast<string&>(iter->second) = m_converter(lc);
+		}
+	}
+	m_lazy.clear();
+}
+
+/** ListDataIcons_t **/
+
+/**
+ * Create a vector for lazy icons.
+ * @param count Number of rows.
+ * @param loader Loader function.
+ * @param maxCached Maximum number of icons to keep loaded.
+ */
+RomFields::ListDataIcons_t::ListDataIcons_t(size_type count, Loader_t &&loader, size_t maxCached)
+	: std::vector<const rp_image*>(count)
+	, m_loader(std::move(loader))
+	, m_maxCached(maxCached > 0 ? maxCached : 1)
+	, m_mutex(new Mutex())
+{
+	m_lru.reserve(m_maxCached);
+}
+
+RomFields::ListDataIcons_t::~ListDataIcons_t()
+{
+	if (!m_loader)
+		return;
+
+	// Lazy icons are owned by this vector.
+	for (const rp_image *img : *this) {
+		UNREF(img);
+	}
+	delete m_mutex;
+}
+
+/**
+ * Get an icon, loading it if necessary.
+ * The icon is ref()'d, since another thread may
+ * evict it from the cache while it's being used.
+ * @param idx Row index.
+ * @return Icon (caller must unref()), or nullptr if the row has no icon.
+ */
+const rp_image *RomFields::ListDataIcons_t::get(size_t idx) const
+{
+	assert(idx < size());
+	if (idx >= size())
+		return nullptr;
+	if (!m_loader) {
+		// Not lazy.
+		const rp_image *const img = (*this)[idx];
+		return (img ? img->ref() : nullptr);
+	}
+
+	// NOTE: The loader is called with the mutex held,
+	// so a row is never loaded by two threads at once.
+	MutexLocker locker(*m_mutex);
+
+	// NOTE: The vector is never actually const, since
+	// RomFields allocates it. Only the cache is changed.
+	const rp_image *&img = const_cast<const rp_image*&>((*this)[idx]);
+
+	auto iter = std::find(m_lru.begin(), m_lru.end(), idx);
+	if (iter != m_lru.end()) {
+		// Already loaded. Mark it as most recently used.
+		m_lru.erase(iter);
+		m_lru.push_back(idx);
+		return (img ? img->ref() : nullptr);
+	}
+
+	if (m_lru.size() >= m_maxCached) {
+		// Evict the least recently used icon.
+		const rp_image *&old_img = const_cast<const rp_image*&>((*this)[m_lru.front()]);
+		UNREF_AND_NULL(old_img);
+		m_lru.erase(m_lru.begin());
+	}
+
+	img = m_loader(idx);
+	m_lru.push_back(idx);
+	return (img ? img->ref() : nullptr);
+}
+
 /** Multi-language convenience functions. **/
 
 /**
@@ -368,26 +608,27 @@ const string *RomFields::getFromStringMulti(const StringMultiMap_t *pStr_multi,
 		return nullptr;
 	}
 
+	// NOTE: Lazy strings are only converted if they're returned.
 	if (user_lc != 0) {
 		// Search for the user-specified lc first.
-		auto iter_sm = pStr_multi->find(user_lc);
-		if (iter_sm != pStr_multi->end()) {
+		const string *const pStr = pStr_multi->get(user_lc);
+		if (pStr) {
 			// Found the user-specified lc.
-			return &(iter_sm->second);
+			return pStr;
 		}
 	}
 
 	if (def_lc != user_lc) {
 		// Search for the ROM-default lc.
-		auto iter_sm = pStr_multi->find(def_lc);
-		if (iter_sm != pStr_multi->end()) {
+		const string *const pStr = pStr_multi->get(def_lc);
+		if (pStr) {
 			// Found the ROM-default lc.
-			return &(iter_sm->second);
+			return pStr;
 		}
 	}
 
 	// Not found. Return the first entry.
-	return &(pStr_multi->cbegin()->second);
+	return &(pStr_multi->get(pStr_multi->cbegin()));
 }
 
 /**
@@ -446,8 +687,10 @@ int RomFields::count(void) const
  */
 bool RomFields::empty(void) const
 {
+	// NOTE: Deferred tabs that haven't been loaded yet count as fields.
+	// Otherwise, RomData subclasses would reload the field data.
 	RP_D(const RomFields);
-	return d->fields.empty();
+	return d->fields.empty() && d->firstDeferredTab < 0;
 }
 
 /**
@@ -543,11 +786,119 @@ void RomFields::setTabName(int tabIdx, const char *name)
 int RomFields::addTab(const char *name)
 {
 	RP_D(RomFields);
+	// Regular tabs can't be added after deferred tabs.
+	assert(d->firstDeferredTab < 0);
 	d->tabNames.emplace_back(name);
 	d->tabIdx = static_cast<int>(d->tabNames.size() - 1);
 	return d->tabIdx;
 }
 
+/**
+ * Add a tab whose fields are only loaded when requested.
+ * This is intended for tabs that are expensive to parse.
+ *
+ * Deferred tabs must be added after all regular tabs,
+ * and fields cannot be added to them directly.
+ * The tab index for new fields is not changed.
+ *
+ * @param name Tab name.
+ * @param loader Function that adds the tab's fields.
+ * @return Tab index.
+ */
+int RomFields::addTab_deferred(const char *name, const TabLoader &loader)
+{
+	RP_D(RomFields);
+	assert(loader);
+	d->tabNames.emplace_back(name);
+	const int tabIdx = static_cast<int>(d->tabNames.size() - 1);
+	d->tabLoaders.resize(tabIdx + 1);
+	d->tabLoaders[tabIdx] = loader;
+	if (d->firstDeferredTab < 0) {
+		d->firstDeferredTab = tabIdx;
+	}
+	return tabIdx;
+}
+
+/**
+ * Have the fields for the specified tab been loaded?
+ * @param tabIdx Tab index.
+ * @return True if loaded (or not deferred); false if not.
+ */
+bool RomFields::isTabLoaded(int tabIdx) const
+{
+	RP_D(const RomFields);
+	if (tabIdx < 0 || tabIdx >= static_cast<int>(d->tabLoaders.size()))
+		return true;
+	return !d->tabLoaders[tabIdx];
+}
+
+/**
+ * Load the fields for a deferred tab.
+ *
+ * Earlier deferred tabs are loaded first so the fields
+ * remain sorted by tab index. Existing field indexes
+ * don't change, but Field pointers and iterators may
+ * be invalidated.
+ *
+ * NOTE: Like RomData::fields(), this loads data on
+ * demand, so it's usable on a const RomFields.
+ *
+ * @param tabIdx Tab index.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomFields::loadTab(int tabIdx) const
+{
+	RomFieldsPrivate *const d = const_cast<RomFieldsPrivate*>(d_ptr);
+	if (d->firstDeferredTab < 0 || tabIdx < d->firstDeferredTab) {
+		// Not a deferred tab, or everything is loaded.
+		return 0;
+	}
+
+	if (tabIdx >= static_cast<int>(d->tabLoaders.size())) {
+		tabIdx = static_cast<int>(d->tabLoaders.size() - 1);
+	}
+
+	int ret = 0;
+	const int prevTabIdx = d->tabIdx;
+	for (int i = d->firstDeferredTab; i <= tabIdx; i++) {
+		if (!d->tabLoaders[i])
+			continue;
+
+		// Clear the loader before calling it, since it's only
+		// called once, even if it fails.
+		TabLoader loader;
+		std::swap(loader, d->tabLoaders[i]);
+		d->tabIdx = i;
+		int ret_tab = loader(const_cast<RomFields*>(this));
+		if (ret_tab != 0 && ret == 0) {
+			ret = ret_tab;
+		}
+	}
+	d->tabIdx = prevTabIdx;
+
+	// Find the next deferred tab.
+	d->firstDeferredTab = -1;
+	for (int i = tabIdx + 1; i < static_cast<int>(d->tabLoaders.size()); i++) {
+		if (d->tabLoaders[i]) {
+			d->firstDeferredTab = i;
+			break;
+		}
+	}
+	return ret;
+}
+
+/**
+ * Load the fields for all deferred tabs.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomFields::loadAllTabs(void) const
+{
+	RP_D(const RomFields);
+	if (d->firstDeferredTab < 0)
+		return 0;
+	return loadTab(static_cast<int>(d->tabLoaders.size() - 1));
+}
+
 /**
  * Get the tab count.
  * @return Tab count. (highest tab index, plus 1)
@@ -607,6 +958,7 @@ void RomFields::reserve(int n)
 	if (n > 0) {
 		RP_D(RomFields);
 		d->fields.reserve(n);
+		d->updateFieldsCapacity();
 	}
 }
 
@@ -637,6 +989,10 @@ vector<string> *RomFields::strArrayToVector(const char *const *strArray, size_t
 /**
  * Convert an array of char strings to a vector of std::string.
  * This can be used for addField_bitfield() and addField_listData().
+ *
+ * Strings are translated using the translation cache, so
+ * msgctxt and strArray's strings must be static.
+ *
  * @param msgctxt i18n context.
  * @param strArray Array of strings.
  * @param count Number of strings. (nullptrs will be handled as empty strings)
@@ -659,7 +1015,7 @@ vector<string> *RomFields::strArrayToVector_i18n(const char *msgctxt, const char
 		// nullptr will be handled as empty strings.
 		const char* const str = *strArray;
 		pVec->emplace_back(str
-			? dpgettext_expr(RP_I18N_DOMAIN, msgctxt, str)
+			? rp_i18n_pgettext(msgctxt, str)
 			: "");
 	}
 
@@ -668,6 +1024,12 @@ vector<string> *RomFields::strArrayToVector_i18n(const char *msgctxt, const char
 
 /**
  * Add fields from another RomFields object.
+ *
+ * The field data isn't copied. Instead, it's shared with
+ * the other RomFields object, which keeps the data alive
+ * until both objects have been deleted. Field data is never
+ * modified after it's added, so no copies are needed.
+ *
  * @param other Source RomFields object.
  * @param tabOffset Tab index to add to the original tabs.
  *
@@ -685,6 +1047,8 @@ int RomFields::addFields_romFields(const RomFields *other, int tabOffset)
 	if (!other)
 		return -1;
 
+	// Deferred tabs aren't shared, so load them now.
+	other->loadAllTabs();
 	if (other->empty()) {
 		// Nothing to add...
 		return 0;
@@ -695,6 +1059,7 @@ int RomFields::addFields_romFields(const RomFields *other, int tabOffset)
 	// - Add all to specified tab or to current tab.
 	// - Use absolute or relative tab offset.
 	d->fields.reserve(d->fields.size() + other->count());
+	d->updateFieldsCapacity();
 
 	// Do we need to add the other tabs?
 	if (tabOffset == TabOffset_AddTabs) {
@@ -715,90 +1080,24 @@ int RomFields::addFields_romFields(const RomFields *other, int tabOffset)
 		d->def_lc = other->d_ptr->def_lc;
 	}
 
+	// Share the other object's field data.
+	// NOTE: Data that the other object is sharing from
+	// elsewhere is kept alive by the other object.
+	d->addShared(other->d_ptr);
+
 	const auto other_fields_cend = other->d_ptr->fields.cend();
 	for (auto old_iter = other->d_ptr->fields.cbegin();
 	     old_iter != other_fields_cend; ++old_iter)
 	{
-		size_t idx = d->fields.size();
-		d->fields.resize(idx+1);
+		// NOTE: Only the Field struct is copied.
+		// The field data is owned by the other object.
 		const Field &field_src = *old_iter;
-		Field &field_dest = d->fields.at(idx);
-
-		field_dest.name = field_src.name;
-		field_dest.type = field_src.type;
+		d->fields.emplace_back(field_src);
+		Field &field_dest = d->fields.back();
 		field_dest.tabIdx = (tabOffset != -1 ? (field_src.tabIdx + tabOffset) : d->tabIdx);
-		field_dest.isValid = field_src.isValid;
-		field_dest.desc.flags = field_src.desc.flags;
-
-		switch (field_src.type) {
-			case RFT_INVALID:
-				// No data here...
-				break;
-
-			case RFT_STRING:
-				field_dest.data.str = (field_src.data.str ? new string(*field_src.data.str) : nullptr);
-				break;
-			case RFT_BITFIELD:
-				field_dest.desc.bitfield.elemsPerRow = field_src.desc.bitfield.elemsPerRow;
-				field_dest.desc.bitfield.names = (field_src.desc.bitfield.names
-						? new vector<string>(*(field_src.desc.bitfield.names))
-						: nullptr);
-				field_dest.data.bitfield = field_src.data.bitfield;
-				break;
-			case RFT_LISTDATA:
-				field_dest.desc.list_data.flags =
-					field_src.desc.list_data.flags;
-				field_dest.desc.list_data.rows_visible =
-					field_src.desc.list_data.rows_visible;
-				field_dest.desc.list_data.names = (field_src.desc.list_data.names
-						? new vector<string>(*(field_src.desc.list_data.names))
-						: nullptr);
-				field_dest.desc.list_data.alignment.headers =
-					field_src.desc.list_data.alignment.headers;
-				field_dest.desc.list_data.alignment.data =
-					field_src.desc.list_data.alignment.data;
-				if (field_src.desc.list_data.flags & RFT_LISTDATA_MULTI) {
-					field_dest.data.list_data.data.multi = (field_src.data.list_data.data.multi
-						? new ListDataMultiMap_t(*(field_src.data.list_data.data.multi))
-						: nullptr);
-				} else {
-					field_dest.data.list_data.data.single = (field_src.data.list_data.data.single
-						? new ListData_t(*(field_src.data.list_data.data.single))
-						: nullptr);
-				}
-				if (field_src.desc.list_data.flags & RFT_LISTDATA_ICONS) {
-					// Icons: Copy the icon vector if set.
-					field_dest.data.list_data.mxd.icons = (field_src.data.list_data.mxd.icons
-						? new ListDataIcons_t(*(field_src.data.list_data.mxd.icons))
-						: nullptr);
-				} else {
-					// No icons. Copy checkboxes.
-					field_dest.data.list_data.mxd.checkboxes =
-						field_src.data.list_data.mxd.checkboxes;
-				}
-				break;
-			case RFT_DATETIME:
-				field_dest.data.date_time = field_src.data.date_time;
-				break;
-			case RFT_AGE_RATINGS:
-				field_dest.data.age_ratings = (field_src.data.age_ratings
-						? new age_ratings_t(*field_src.data.age_ratings)
-						: nullptr);
-				break;
-			case RFT_DIMENSIONS:
-				memcpy(field_dest.data.dimensions, field_src.data.dimensions, sizeof(field_src.data.dimensions));
-				break;
-			case RFT_STRING_MULTI:
-				field_dest.data.str_multi = (field_src.data.str_multi
-					? new StringMultiMap_t(*(field_src.data.str_multi))
-					: nullptr);
-				break;
-
-			default:
-				assert(!"Unsupported RomFields::RomFieldsType.");
-				break;
-		}
+		field_dest.isShared = true;
 	}
+	d->updateFieldsCapacity();
 
 	// Fields added.
 	return static_cast<int>(d->fields.size() - 1);
@@ -821,20 +1120,24 @@ int RomFields::addField_string(const char *name, const char *str, unsigned int f
 	RP_D(RomFields);
 	size_t idx = d->fields.size();
 	d->fields.resize(idx+1);
+	d->updateFieldsCapacity();
 	Field &field = d->fields.at(idx);
 
-	string *const nstr = (str ? new string(str) : nullptr);
+	size_t len = (str ? strlen(str) : 0);
+	if (flags & STRF_TRIM_END) {
+		// Handle string trimming flags.
+		// TODO: Check for U+3000? (UTF-8: "\xE3\x80\x80")
+		while (len > 0 && str[len-1] == ' ') {
+			len--;
+		}
+	}
+
 	field.name = name;
 	field.type = RFT_STRING;
 	field.desc.flags = flags;
-	field.data.str = nstr;
+	d->setFieldString(field, str, len);
 	field.tabIdx = d->tabIdx;
 	field.isValid = (name != nullptr);
-
-	// Handle string trimming flags.
-	if (nstr && (flags & STRF_TRIM_END)) {
-		trimEnd(*nstr);
-	}
 	return static_cast<int>(idx);
 }
 
@@ -855,23 +1158,51 @@ int RomFields::addField_string(const char *name, const string &str, unsigned int
 	RP_D(RomFields);
 	size_t idx = d->fields.size();
 	d->fields.resize(idx+1);
+	d->updateFieldsCapacity();
 	Field &field = d->fields.at(idx);
 
-	string *const nstr = (!str.empty() ? new string(str) : nullptr);
+	size_t len = str.size();
+	if (flags & STRF_TRIM_END) {
+		// Handle string trimming flags.
+		// TODO: Check for U+3000? (UTF-8: "\xE3\x80\x80")
+		while (len > 0 && str[len-1] == ' ') {
+			len--;
+		}
+	}
+
 	field.name = name;
 	field.type = RFT_STRING;
 	field.desc.flags = flags;
-	field.data.str = nstr;
+	d->setFieldString(field, str.data(), len);
 	field.tabIdx = d->tabIdx;
 	field.isValid = true;
-
-	// Handle string trimming flags.
-	if (nstr && (flags & STRF_TRIM_END)) {
-		trimEnd(*nstr);
-	}
 	return static_cast<int>(idx);
 }
 
+/**
+ * Replace the string data of an existing RFT_STRING field.
+ * NOTE: The old string data remains in the arena
+ * until the RomFields object is deleted.
+ * @param idx Field index.
+ * @param str New string.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomFields::updateField_string(int idx, const char *str)
+{
+	RP_D(RomFields);
+	assert(idx >= 0 && idx < static_cast<int>(d->fields.size()));
+	if (idx < 0 || idx >= static_cast<int>(d->fields.size()))
+		return -ERANGE;
+
+	Field &field = d->fields[idx];
+	assert(field.type == RFT_STRING);
+	if (field.type != RFT_STRING)
+		return -EINVAL;
+
+	d->setFieldString(field, str, (str ? strlen(str) : 0));
+	return 0;
+}
+
 /**
  * Add string field data using a numeric value.
  * @param name Field name.
@@ -1022,6 +1353,7 @@ int RomFields::addField_bitfield(const char *name,
 	RP_D(RomFields);
 	size_t idx = d->fields.size();
 	d->fields.resize(idx+1);
+	d->updateFieldsCapacity();
 	Field &field = d->fields.at(idx);
 
 	field.name = name;
@@ -1070,6 +1402,7 @@ int RomFields::addField_listData(const char *name, const AFLD_PARAMS *params)
 	RP_D(RomFields);
 	size_t idx = d->fields.size();
 	d->fields.resize(idx+1);
+	d->updateFieldsCapacity();
 	Field &field = d->fields.at(idx);
 
 	field.name = name;
@@ -1129,6 +1462,7 @@ int RomFields::addField_dateTime(const char *name, time_t date_time, unsigned in
 	RP_D(RomFields);
 	size_t idx = d->fields.size();
 	d->fields.resize(idx+1);
+	d->updateFieldsCapacity();
 	Field &field = d->fields.at(idx);
 
 	field.name = name;
@@ -1157,11 +1491,12 @@ int RomFields::addField_ageRatings(const char *name, const age_ratings_t &age_ra
 	RP_D(RomFields);
 	size_t idx = d->fields.size();
 	d->fields.resize(idx+1);
+	d->updateFieldsCapacity();
 	Field &field = d->fields.at(idx);
 
 	field.name = name;
 	field.type = RFT_AGE_RATINGS;
-	field.data.age_ratings = new age_ratings_t(age_ratings);
+	field.data.age_ratings = d->arena.copy(age_ratings);
 	field.tabIdx = d->tabIdx;
 	field.isValid = true;
 	return static_cast<int>(idx);
@@ -1185,6 +1520,7 @@ int RomFields::addField_dimensions(const char *name, int dimX, int dimY, int dim
 	RP_D(RomFields);
 	size_t idx = d->fields.size();
 	d->fields.resize(idx+1);
+	d->updateFieldsCapacity();
 	Field &field = d->fields.at(idx);
 
 	field.name = name;
@@ -1216,6 +1552,7 @@ int RomFields::addField_string_multi(const char *name, const StringMultiMap_t *s
 	RP_D(RomFields);
 	size_t idx = d->fields.size();
 	d->fields.resize(idx+1);
+	d->updateFieldsCapacity();
 	Field &field = d->fields.at(idx);
 
 	if (d->def_lc == 0) {
@@ -20,13 +20,18 @@
 
 // C++ includes.
 #include <array>
+#include <functional>
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 namespace LibRpTexture {
 	class rp_image;
 }
+namespace LibRpThreads {
+	class Mutex;
+}
 
 namespace LibRpBase {
 
@@ -172,11 +177,141 @@ class RomFields
 			TXA_RIGHT	= 3,
 		};
 
+		/**
+		 * Map of strings with language codes. (RFT_STRING_MULTI)
+		 * - Key: Language code ('en', 'es', etc; multi-char constant)
+		 * - Value: String
+		 *
+		 * Strings can be added lazily using addLazy(), in which case
+		 * they're converted to UTF-8 by the converter function the
+		 * first time they're accessed using get(). This way, only
+		 * the languages that are actually displayed are converted.
+		 *
+		 * NOTE: Code that reads the values directly, e.g. by
+		 * iterating over the map, must call loadAll() first.
+		 * Iterating over the keys is always fine.
+		 */
+		class StringMultiMap_t : public std::map<uint32_t, std::string>
+		{
+			public:
+				/**
+				 * Converter function for lazy strings.
+				 * @param lc Language code.
+				 * @return UTF-8 string.
+				 */
+				typedef std::function<std::string(uint32_t lc)> Converter_t;
+
+				StringMultiMap_t() = default;
+
+				/**
+				 * Create a map for lazy strings.
+				 * @param converter Converter function.
+				 */
+				explicit StringMultiMap_t(Converter_t &&converter)
+					: m_converter(std::move(converter)) { }
+
+			public:
+				/**
+				 * Add a string that will be converted the first time it's accessed.
+				 * The map must have been created with a converter function.
+				 * @param lc Language code.
+				 */
+				void addLazy(uint32_t lc);
+
+				/**
+				 * Get a string, converting it if necessary.
+				 * @param lc Language code.
+				 * @return String, or nullptr if not found.
+				 */
+				const std::string *get(uint32_t lc) const;
+
+				/**
+				 * Get a string, converting it if necessary.
+				 * @param iter Iterator. (must be valid)
+				 * @return String.
+				 */
+				const std::string &get(const_iterator iter) const;
+
+				/**
+				 * Convert all lazy strings.
+				 */
+				void loadAll(void) const;
+
+			private:
+				Converter_t m_converter;
+				// Language codes of strings that haven't been converted yet.
+				mutable std::set<uint32_t> m_lazy;
+		};
+
+		/**
+		 * Icons for RFT_LISTDATA_ICONS. One icon per row.
+		 * A row may have no icon, in which case its value is nullptr.
+		 *
+		 * Icons can be loaded lazily if the vector is created with
+		 * a loader function. Rows are then loaded the first time
+		 * they're accessed using get(), and only the most recently
+		 * used icons are kept in memory. This way, large lists only
+		 * decode the icons for rows that are actually displayed.
+		 *
+		 * NOTE: Code that reads the icons must use get(), which
+		 * returns a new reference. get() can be called from multiple
+		 * threads, e.g. if two UI frontends display the same fields.
+		 */
+		class ListDataIcons_t : public std::vector<const LibRpTexture::rp_image*>
+		{
+			public:
+				/**
+				 * Loader function for lazy icons.
+				 * @param idx Row index.
+				 * @return Icon (caller takes ownership), or nullptr if the row has no icon.
+				 */
+				typedef std::function<LibRpTexture::rp_image*(size_t idx)> Loader_t;
+
+				ListDataIcons_t()
+					: m_maxCached(0), m_mutex(nullptr) { }
+				explicit ListDataIcons_t(size_type count)
+					: std::vector<const LibRpTexture::rp_image*>(count)
+					, m_maxCached(0), m_mutex(nullptr) { }
+
+				/**
+				 * Create a vector for lazy icons.
+				 * @param count Number of rows.
+				 * @param loader Loader function.
+				 * @param maxCached Maximum number of icons to keep loaded.
+				 */
+				ListDataIcons_t(size_type count, Loader_t &&loader, size_t maxCached = 32);
+
+				~ListDataIcons_t();
+
+			private:
+				ListDataIcons_t(const ListDataIcons_t &) = delete;
+				ListDataIcons_t &operator=(const ListDataIcons_t &) = delete;
+
+			public:
+				/**
+				 * Get an icon, loading it if necessary.
+				 * The icon is ref()'d, since another thread may
+				 * evict it from the cache while it's being used.
+				 * @param idx Row index.
+				 * @return Icon (caller must unref()), or nullptr if the row has no icon.
+				 */
+				const LibRpTexture::rp_image *get(size_t idx) const;
+
+			private:
+				Loader_t m_loader;
+				size_t m_maxCached;
+
+				// Protects the icon slots and m_lru for lazy icons.
+				LibRpThreads::Mutex *m_mutex;
+
+				// Rows that have been loaded, including rows with no icon.
+				// Least recently used is first.
+				mutable std::vector<size_t> m_lru;
+		};
+
 		// Typedefs for various containers.
-		typedef std::map<uint32_t, std::string> StringMultiMap_t;
 		typedef std::vector<std::vector<std::string> > ListData_t;
 		typedef std::map<uint32_t, ListData_t> ListDataMultiMap_t;
-		typedef std::vector<const LibRpTexture::rp_image*> ListDataIcons_t;
 
 		// ROM field struct.
 		// Dynamically allocated.
@@ -185,6 +320,7 @@ class RomFields
 			RomFieldType type;	// ROM field type.
 			uint8_t tabIdx;		// Tab index. (0 for default)
 			bool isValid;		// True if this field has valid data.
+			bool isShared;		// True if the data is owned by another RomFields object.
 
 			// Field description.
 			union _desc {
@@ -230,7 +366,13 @@ class RomFields
 				uint64_t generic;
 
 				// RFT_STRING
-				const std::string *str;
+				// NOTE: String data is owned by the RomFields
+				// object's arena and is always NUL-terminated.
+				// data == nullptr indicates an empty string.
+				struct _str {
+					const char *data;
+					size_t size;
+				} str;
 
 				// RFT_BITFIELD
 				uint32_t bitfield;
@@ -265,6 +407,7 @@ class RomFields
 
 				// RFT_AGE_RATINGS
 				// See AgeRatingsCountry for field indexes.
+				// NOTE: Owned by the RomFields object's arena.
 				const age_ratings_t *age_ratings;
 
 				// RFT_DIMENSIONS
@@ -411,6 +554,59 @@ class RomFields
 		 */
 		int addTab(const char *name);
 
+		/**
+		 * Deferred tab loader.
+		 * Adds the fields for a tab that was added with addTab_deferred().
+		 * The tab index for new fields is set to the deferred tab
+		 * before the loader is called.
+		 * @param fields RomFields object.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		typedef std::function<int(RomFields *fields)> TabLoader;
+
+		/**
+		 * Add a tab whose fields are only loaded when requested.
+		 * This is intended for tabs that are expensive to parse.
+		 *
+		 * Deferred tabs must be added after all regular tabs,
+		 * and fields cannot be added to them directly.
+		 * The tab index for new fields is not changed.
+		 *
+		 * @param name Tab name.
+		 * @param loader Function that adds the tab's fields.
+		 * @return Tab index.
+		 */
+		int addTab_deferred(const char *name, const TabLoader &loader);
+
+		/**
+		 * Have the fields for the specified tab been loaded?
+		 * @param tabIdx Tab index.
+		 * @return True if loaded (or not deferred); false if not.
+		 */
+		bool isTabLoaded(int tabIdx) const;
+
+		/**
+		 * Load the fields for a deferred tab.
+		 *
+		 * Earlier deferred tabs are loaded first so the fields
+		 * remain sorted by tab index. Existing field indexes
+		 * don't change, but Field pointers and iterators may
+		 * be invalidated.
+		 *
+		 * NOTE: Like RomData::fields(), this loads data on
+		 * demand, so it's usable on a const RomFields.
+		 *
+		 * @param tabIdx Tab index.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadTab(int tabIdx) const;
+
+		/**
+		 * Load the fields for all deferred tabs.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadAllTabs(void) const;
+
 		/**
 		 * Get the tab count.
 		 * @return Tab count. (highest tab index, plus 1)
@@ -450,6 +646,10 @@ class RomFields
 		/**
 		 * Convert an array of char strings to a vector of std::string.
 		 * This can be used for addField_bitfield() and addField_listData().
+		 *
+		 * Strings are translated using the translation cache, so
+		 * msgctxt and strArray's strings must be static.
+		 *
 		 * @param msgctxt i18n context.
 		 * @param strArray Array of strings.
 		 * @param count Number of strings. (nullptrs will be handled as empty strings)
@@ -464,6 +664,12 @@ class RomFields
 
 		/**
 		 * Add fields from another RomFields object.
+		 *
+		 * The field data isn't copied. Instead, it's shared with
+		 * the other RomFields object, which keeps the data alive
+		 * until both objects have been deleted. Field data is never
+		 * modified after it's added, so no copies are needed.
+		 *
 		 * @param other Source RomFields object.
 		 * @param tabOffset Tab index to add to the original tabs.
 		 *
@@ -493,6 +699,16 @@ class RomFields
 		 */
 		int addField_string(const char *name, const std::string &str, unsigned int flags = 0);
 
+		/**
+		 * Replace the string data of an existing RFT_STRING field.
+		 * NOTE: The old string data remains in the arena
+		 * until the RomFields object is deleted.
+		 * @param idx Field index.
+		 * @param str New string.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int updateField_string(int idx, const char *str);
+
 		enum class Base {
 			Dec,	// Decimal (Base 10)
 			Hex,	// Hexadecimal (Base 16)
@@ -619,7 +835,7 @@ class RomFields
 
 				// Icons vector.
 				// Requires RFT_LISTDATA_ICONS.
-				const std::vector<const LibRpTexture::rp_image*> *icons;
+				const ListDataIcons_t *icons;
 			} mxd;
 		};
 
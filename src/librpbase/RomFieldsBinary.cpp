@@ -0,0 +1,1143 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * RomFieldsBinary.cpp: Binary RomFields/RomMetaData serialization.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RomFieldsBinary.hpp"
+
+// C++ STL classes.
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+namespace LibRpBase {
+
+/** Binary format structs **/
+
+// NOTE: These structs document the layout. Values are
+// read using memcpy(), so the buffer doesn't need to be
+// aligned, and they're converted from little-endian.
+
+// String reference.
+// offset is relative to the start of the string table,
+// and the string is always NUL-terminated.
+struct RFB_StrRef {
+	uint32_t offset;
+	uint32_t length;	// not including the NUL terminator
+};
+ASSERT_STRUCT(RFB_StrRef, 8);
+
+// Array reference.
+// offset is relative to the start of the buffer.
+// offset == 0 indicates a null array.
+struct RFB_ArrayRef {
+	uint32_t offset;
+	uint32_t count;
+};
+ASSERT_STRUCT(RFB_ArrayRef, 8);
+
+struct RFB_Header {
+	uint32_t magic;			// [0x000] 'RPFB'
+	uint16_t version;		// [0x004] Format version
+	uint16_t header_size;		// [0x006] sizeof(RFB_Header)
+	uint32_t total_size;		// [0x008] Total size, including the string table
+	uint32_t def_lc;		// [0x00C] Default language code
+	RFB_ArrayRef tabs;		// [0x010] RFB_StrRef[]
+	RFB_ArrayRef fields;		// [0x018] RFB_Field[]
+	RFB_ArrayRef metaData;		// [0x020] RFB_MetaData[]
+	uint32_t strtab_offset;		// [0x028] String table offset
+	uint32_t strtab_size;		// [0x02C] String table size
+};
+ASSERT_STRUCT(RFB_Header, 48);
+
+struct RFB_Field {
+	RFB_StrRef name;		// [0x000] Field name
+	uint8_t type;			// [0x008] RomFields::RomFieldType
+	uint8_t tabIdx;			// [0x009] Tab index
+	uint16_t reserved;		// [0x00A]
+	uint32_t flags;			// [0x00C] Field flags
+	union {				// [0x010]
+		RFB_StrRef str;		// RFT_STRING
+		struct {
+			int32_t elemsPerRow;
+			uint32_t bitfield;
+			RFB_ArrayRef names;	// RFB_StrRef[]
+		} bitfield;		// RFT_BITFIELD
+		uint32_t list_data;	// RFT_LISTDATA: RFB_ListData offset
+		uint32_t date_time[2];	// RFT_DATETIME: low, high
+		uint32_t age_ratings;	// RFT_AGE_RATINGS: uint16_t[AGE_MAX] offset
+		int32_t dimensions[3];	// RFT_DIMENSIONS
+		RFB_ArrayRef str_multi;	// RFT_STRING_MULTI: RFB_StrMulti[]
+		uint32_t raw[4];
+	} data;
+};
+ASSERT_STRUCT(RFB_Field, 32);
+
+struct RFB_ListData {
+	int32_t rows_visible;		// [0x000]
+	uint32_t align_headers;		// [0x004]
+	uint32_t align_data;		// [0x008]
+	uint32_t checkboxes;		// [0x00C]
+	RFB_ArrayRef headers;		// [0x010] RFB_StrRef[] (offset 0 if no headers)
+	RFB_ArrayRef lists;		// [0x018] RFB_ListDataLC[] (one entry with lc == 0 if not multi)
+};
+ASSERT_STRUCT(RFB_ListData, 32);
+
+struct RFB_ListDataLC {
+	uint32_t lc;			// [0x000] Language code
+	RFB_ArrayRef rows;		// [0x004] RFB_ArrayRef[], each of which is RFB_StrRef[]
+};
+ASSERT_STRUCT(RFB_ListDataLC, 12);
+
+struct RFB_StrMulti {
+	uint32_t lc;			// [0x000] Language code
+	RFB_StrRef str;			// [0x004] String
+};
+ASSERT_STRUCT(RFB_StrMulti, 12);
+
+struct RFB_MetaData {
+	uint32_t name;			// [0x000] Property::Property
+	uint32_t type;			// [0x004] PropertyType::PropertyType
+	union {				// [0x008]
+		int32_t ivalue;
+		uint32_t uvalue;
+		RFB_StrRef str;
+		uint32_t timestamp[2];	// low, high
+	} data;
+};
+ASSERT_STRUCT(RFB_MetaData, 16);
+
+/** Serialization **/
+
+class RomFieldsBinaryWriter
+{
+	public:
+		explicit RomFieldsBinaryWriter(vector<uint8_t> &buf)
+			: buf(buf)
+		{
+			// Offset 0 is the empty string.
+			strtab.push_back('\0');
+		}
+
+	private:
+		RP_DISABLE_COPY(RomFieldsBinaryWriter)
+
+	public:
+		/**
+		 * Allocate zero-filled space in the buffer.
+		 * NOTE: This may reallocate the buffer, so use offsets.
+		 * @param size Size.
+		 * @return Offset. (4-byte aligned)
+		 */
+		uint32_t alloc(size_t size)
+		{
+			const size_t offset = (buf.size() + 3) & ~static_cast<size_t>(3);
+			buf.resize(offset + size);
+			return static_cast<uint32_t>(offset);
+		}
+
+		inline void put32(uint32_t offset, uint32_t val)
+		{
+			val = cpu_to_le32(val);
+			memcpy(&buf[offset], &val, sizeof(val));
+		}
+
+		inline void put64(uint32_t offset, int64_t val)
+		{
+			put32(offset, static_cast<uint32_t>(static_cast<uint64_t>(val)));
+			put32(offset + 4, static_cast<uint32_t>(static_cast<uint64_t>(val) >> 32));
+		}
+
+		/**
+		 * Write a string reference.
+		 * Identical strings are only stored once.
+		 * @param offset String reference offset.
+		 * @param str String. (may be nullptr)
+		 * @param len String length.
+		 */
+		void putStr(uint32_t offset, const char *str, size_t len)
+		{
+			if (!str || len == 0) {
+				// Empty string. (already zeroed)
+				return;
+			}
+
+			string s(str, len);
+			auto iter = strMap.find(s);
+			uint32_t strOffset;
+			if (iter != strMap.end()) {
+				strOffset = iter->second;
+			} else {
+				strOffset = static_cast<uint32_t>(strtab.size());
+				strtab.insert(strtab.end(), str, str + len);
+				strtab.push_back('\0');
+				strMap.emplace(std::move(s), strOffset);
+			}
+			put32(offset, strOffset);
+			put32(offset + 4, static_cast<uint32_t>(len));
+		}
+
+		inline void putStr(uint32_t offset, const char *str)
+		{
+			putStr(offset, str, str ? strlen(str) : 0);
+		}
+
+		inline void putStr(uint32_t offset, const string &str)
+		{
+			putStr(offset, str.data(), str.size());
+		}
+
+		/**
+		 * Write a string vector.
+		 * @param offset Array reference offset.
+		 * @param vec String vector. (may be nullptr)
+		 */
+		void putStrVector(uint32_t offset, const vector<string> *vec)
+		{
+			if (!vec)
+				return;
+
+			const uint32_t count = static_cast<uint32_t>(vec->size());
+			const uint32_t arr = alloc(count * sizeof(RFB_StrRef));
+			put32(offset, arr);
+			put32(offset + 4, count);
+			for (uint32_t i = 0; i < count; i++) {
+				putStr(arr + (i * sizeof(RFB_StrRef)), vec->at(i));
+			}
+		}
+
+		/**
+		 * Write ListData.
+		 * @param offset Array reference offset.
+		 * @param list_data ListData. (may be nullptr)
+		 */
+		void putListData(uint32_t offset, const RomFields::ListData_t *list_data)
+		{
+			if (!list_data)
+				return;
+
+			const uint32_t count = static_cast<uint32_t>(list_data->size());
+			const uint32_t arr = alloc(count * sizeof(RFB_ArrayRef));
+			put32(offset, arr);
+			put32(offset + 4, count);
+			for (uint32_t i = 0; i < count; i++) {
+				putStrVector(arr + (i * sizeof(RFB_ArrayRef)), &list_data->at(i));
+			}
+		}
+
+	public:
+		vector<uint8_t> &buf;
+		vector<char> strtab;
+		unordered_map<string, uint32_t> strMap;
+};
+
+/**
+ * Serialize RomFields and RomMetaData.
+ *
+ * Deferred tabs are loaded first.
+ * Invalid fields are skipped.
+ *
+ * @param out		[out] Serialized data.
+ * @param fields	[in,opt] RomFields.
+ * @param metaData	[in,opt] RomMetaData.
+ * @return 0 on success; negative POSIX error code on error. (-ENOTSUP for ListData icons)
+ */
+int RomFieldsBinary::serialize(vector<uint8_t> &out,
+	const RomFields *fields, const RomMetaData *metaData)
+{
+	out.clear();
+	RomFieldsBinaryWriter w(out);
+	const uint32_t hdr = w.alloc(sizeof(RFB_Header));
+
+	// Tabs.
+	uint32_t tabCount = 0;
+	uint32_t fieldCount = 0;
+	if (fields) {
+		fields->loadAllTabs();
+		tabCount = static_cast<uint32_t>(fields->tabCount());
+		const auto iter_end = fields->cend();
+		for (auto iter = fields->cbegin(); iter != iter_end; ++iter) {
+			if (iter->isValid) {
+				fieldCount++;
+			}
+		}
+	}
+	const uint32_t tabsOffset = w.alloc(tabCount * sizeof(RFB_StrRef));
+	for (uint32_t i = 0; i < tabCount; i++) {
+		w.putStr(tabsOffset + (i * sizeof(RFB_StrRef)), fields->tabName(static_cast<int>(i)));
+	}
+
+	// Record tables.
+	const uint32_t fieldsOffset = w.alloc(fieldCount * sizeof(RFB_Field));
+	const uint32_t metaCount = (metaData ? static_cast<uint32_t>(metaData->count()) : 0);
+	const uint32_t metaOffset = w.alloc(metaCount * sizeof(RFB_MetaData));
+
+	// Fields.
+	uint32_t rec = fieldsOffset;
+	if (fields) {
+		const auto iter_end = fields->cend();
+		for (auto iter = fields->cbegin(); iter != iter_end; ++iter) {
+			const RomFields::Field &field = *iter;
+			if (!field.isValid)
+				continue;
+
+			w.putStr(rec + offsetof(RFB_Field, name), field.name);
+			w.buf[rec + offsetof(RFB_Field, type)] = field.type;
+			w.buf[rec + offsetof(RFB_Field, tabIdx)] = field.tabIdx;
+			const uint32_t data = rec + offsetof(RFB_Field, data);
+
+			switch (field.type) {
+				case RomFields::RFT_STRING:
+					w.put32(rec + offsetof(RFB_Field, flags), field.desc.flags);
+					w.putStr(data, field.data.str.data, field.data.str.size);
+					break;
+
+				case RomFields::RFT_BITFIELD:
+					w.put32(data, static_cast<uint32_t>(field.desc.bitfield.elemsPerRow));
+					w.put32(data + 4, field.data.bitfield);
+					w.putStrVector(data + 8, field.desc.bitfield.names);
+					break;
+
+				case RomFields::RFT_LISTDATA: {
+					const unsigned int flags = field.desc.list_data.flags;
+					if (flags & RomFields::RFT_LISTDATA_ICONS) {
+						// TODO: Serialize ListData icons.
+						out.clear();
+						return -ENOTSUP;
+					}
+					w.put32(rec + offsetof(RFB_Field, flags), flags);
+
+					const uint32_t ld = w.alloc(sizeof(RFB_ListData));
+					w.put32(data, ld);
+					w.put32(ld + offsetof(RFB_ListData, rows_visible),
+						static_cast<uint32_t>(field.desc.list_data.rows_visible));
+					w.put32(ld + offsetof(RFB_ListData, align_headers), field.desc.list_data.alignment.headers);
+					w.put32(ld + offsetof(RFB_ListData, align_data), field.desc.list_data.alignment.data);
+					if (flags & RomFields::RFT_LISTDATA_CHECKBOXES) {
+						w.put32(ld + offsetof(RFB_ListData, checkboxes), field.data.list_data.mxd.checkboxes);
+					}
+					w.putStrVector(ld + offsetof(RFB_ListData, headers), field.desc.list_data.names);
+
+					if (flags & RomFields::RFT_LISTDATA_MULTI) {
+						const RomFields::ListDataMultiMap_t *const multi = field.data.list_data.data.multi;
+						const uint32_t count = (multi ? static_cast<uint32_t>(multi->size()) : 0);
+						const uint32_t arr = w.alloc(count * sizeof(RFB_ListDataLC));
+						w.put32(ld + offsetof(RFB_ListData, lists), arr);
+						w.put32(ld + offsetof(RFB_ListData, lists) + 4, count);
+						if (multi) {
+							uint32_t lcRec = arr;
+							for (const auto &p : *multi) {
+								w.put32(lcRec, p.first);
+								w.putListData(lcRec + offsetof(RFB_ListDataLC, rows), &p.second);
+								lcRec += sizeof(RFB_ListDataLC);
+							}
+						}
+					} else {
+						const uint32_t arr = w.alloc(sizeof(RFB_ListDataLC));
+						w.put32(ld + offsetof(RFB_ListData, lists), arr);
+						w.put32(ld + offsetof(RFB_ListData, lists) + 4, 1);
+						w.putListData(arr + offsetof(RFB_ListDataLC, rows), field.data.list_data.data.single);
+					}
+					break;
+				}
+
+				case RomFields::RFT_DATETIME:
+					w.put32(rec + offsetof(RFB_Field, flags), field.desc.flags);
+					w.put64(data, static_cast<int64_t>(field.data.date_time));
+					break;
+
+				case RomFields::RFT_AGE_RATINGS: {
+					const uint32_t arr = w.alloc(RomFields::AGE_MAX * sizeof(uint16_t));
+					w.put32(data, arr);
+					if (field.data.age_ratings) {
+						for (unsigned int i = 0; i < RomFields::AGE_MAX; i++) {
+							const uint16_t rating = cpu_to_le16(field.data.age_ratings->at(i));
+							memcpy(&w.buf[arr + (i * sizeof(uint16_t))], &rating, sizeof(rating));
+						}
+					}
+					break;
+				}
+
+				case RomFields::RFT_DIMENSIONS:
+					for (unsigned int i = 0; i < 3; i++) {
+						w.put32(data + (i * 4), static_cast<uint32_t>(field.data.dimensions[i]));
+					}
+					break;
+
+				case RomFields::RFT_STRING_MULTI: {
+					w.put32(rec + offsetof(RFB_Field, flags), field.desc.flags);
+					const RomFields::StringMultiMap_t *const str_multi = field.data.str_multi;
+					const uint32_t count = (str_multi ? static_cast<uint32_t>(str_multi->size()) : 0);
+					const uint32_t arr = w.alloc(count * sizeof(RFB_StrMulti));
+					w.put32(data, arr);
+					w.put32(data + 4, count);
+					if (str_multi) {
+						// All languages are serialized, so convert any lazy strings.
+						str_multi->loadAll();
+						uint32_t smRec = arr;
+						for (const auto &p : *str_multi) {
+							w.put32(smRec, p.first);
+							w.putStr(smRec + offsetof(RFB_StrMulti, str), p.second);
+							smRec += sizeof(RFB_StrMulti);
+						}
+					}
+					break;
+				}
+
+				default:
+					assert(!"Unsupported RomFields::RomFieldsType.");
+					out.clear();
+					return -ENOTSUP;
+			}
+
+			rec += sizeof(RFB_Field);
+		}
+	}
+
+	// Metadata.
+	rec = metaOffset;
+	for (uint32_t i = 0; i < metaCount; i++, rec += sizeof(RFB_MetaData)) {
+		const RomMetaData::MetaData *const prop = metaData->prop(static_cast<int>(i));
+		w.put32(rec + offsetof(RFB_MetaData, name), prop->name);
+		w.put32(rec + offsetof(RFB_MetaData, type), prop->type);
+		const uint32_t data = rec + offsetof(RFB_MetaData, data);
+		switch (prop->type) {
+			case PropertyType::Integer:
+				w.put32(data, static_cast<uint32_t>(prop->data.ivalue));
+				break;
+			case PropertyType::UnsignedInteger:
+				w.put32(data, prop->data.uvalue);
+				break;
+			case PropertyType::String:
+				if (prop->data.str) {
+					w.putStr(data, *prop->data.str);
+				}
+				break;
+			case PropertyType::Timestamp:
+				w.put64(data, static_cast<int64_t>(prop->data.timestamp));
+				break;
+			default:
+				assert(!"Unsupported PropertyType.");
+				out.clear();
+				return -ENOTSUP;
+		}
+	}
+
+	// String table.
+	const uint32_t strtabOffset = w.alloc(w.strtab.size());
+	memcpy(&out[strtabOffset], w.strtab.data(), w.strtab.size());
+	if (out.size() > 0xFFFFFFFFU) {
+		// Too big for 32-bit offsets.
+		out.clear();
+		return -EFBIG;
+	}
+
+	// Header.
+	w.put32(hdr + offsetof(RFB_Header, magic), MAGIC);
+	w.put32(hdr + offsetof(RFB_Header, version), VERSION | (sizeof(RFB_Header) << 16));
+	w.put32(hdr + offsetof(RFB_Header, total_size), static_cast<uint32_t>(out.size()));
+	w.put32(hdr + offsetof(RFB_Header, def_lc), (fields ? fields->defaultLanguageCode() : 0));
+	w.put32(hdr + offsetof(RFB_Header, tabs), tabsOffset);
+	w.put32(hdr + offsetof(RFB_Header, tabs) + 4, tabCount);
+	w.put32(hdr + offsetof(RFB_Header, fields), fieldsOffset);
+	w.put32(hdr + offsetof(RFB_Header, fields) + 4, fieldCount);
+	w.put32(hdr + offsetof(RFB_Header, metaData), metaOffset);
+	w.put32(hdr + offsetof(RFB_Header, metaData) + 4, metaCount);
+	w.put32(hdr + offsetof(RFB_Header, strtab_offset), strtabOffset);
+	w.put32(hdr + offsetof(RFB_Header, strtab_size), static_cast<uint32_t>(w.strtab.size()));
+	return 0;
+}
+
+/** View **/
+
+/**
+ * Create a view over a serialized buffer.
+ *
+ * The buffer is not copied, and it must remain valid
+ * for as long as the view (and any Field or MetaData
+ * views obtained from it) is in use.
+ *
+ * The header and record tables are validated here;
+ * everything else is bounds-checked on access.
+ *
+ * @param data Serialized data.
+ * @param size Size of data.
+ */
+RomFieldsBinary::RomFieldsBinary(const void *data, size_t size)
+	: m_data(nullptr)
+	, m_size(0)
+	, m_def_lc(0)
+	, m_tabCount(0)
+	, m_tabsOffset(0)
+	, m_fieldCount(0)
+	, m_fieldsOffset(0)
+	, m_metaCount(0)
+	, m_metaOffset(0)
+	, m_strtabOffset(0)
+	, m_strtabSize(0)
+{
+	assert(data != nullptr);
+	if (!data || size < sizeof(RFB_Header))
+		return;
+
+	RFB_Header hdr;
+	memcpy(&hdr, data, sizeof(hdr));
+	const uint32_t total_size = le32_to_cpu(hdr.total_size);
+	if (hdr.magic != cpu_to_le32(MAGIC) ||
+	    hdr.version != cpu_to_le16(VERSION) ||
+	    le16_to_cpu(hdr.header_size) < sizeof(RFB_Header) ||
+	    total_size > size || total_size < sizeof(RFB_Header))
+	{
+		// Invalid header.
+		return;
+	}
+
+	// Validate the record tables and the string table.
+	auto checkTable = [total_size](uint32_t offset, uint32_t count, uint32_t elemSize) -> bool {
+		return (static_cast<uint64_t>(offset) + (static_cast<uint64_t>(count) * elemSize) <= total_size);
+	};
+	const uint32_t tabsOffset = le32_to_cpu(hdr.tabs.offset);
+	const uint32_t tabCount = le32_to_cpu(hdr.tabs.count);
+	const uint32_t fieldsOffset = le32_to_cpu(hdr.fields.offset);
+	const uint32_t fieldCount = le32_to_cpu(hdr.fields.count);
+	const uint32_t metaOffset = le32_to_cpu(hdr.metaData.offset);
+	const uint32_t metaCount = le32_to_cpu(hdr.metaData.count);
+	const uint32_t strtabOffset = le32_to_cpu(hdr.strtab_offset);
+	const uint32_t strtabSize = le32_to_cpu(hdr.strtab_size);
+	if (!checkTable(tabsOffset, tabCount, sizeof(RFB_StrRef)) ||
+	    !checkTable(fieldsOffset, fieldCount, sizeof(RFB_Field)) ||
+	    !checkTable(metaOffset, metaCount, sizeof(RFB_MetaData)) ||
+	    !checkTable(strtabOffset, strtabSize, 1) || strtabSize == 0)
+	{
+		// Table is out of bounds.
+		return;
+	}
+
+	const uint8_t *const data8 = static_cast<const uint8_t*>(data);
+	if (data8[strtabOffset + strtabSize - 1] != '\0') {
+		// String table isn't NUL-terminated.
+		return;
+	}
+
+	m_data = data8;
+	m_size = total_size;
+	m_def_lc = le32_to_cpu(hdr.def_lc);
+	m_tabCount = tabCount;
+	m_tabsOffset = tabsOffset;
+	m_fieldCount = fieldCount;
+	m_fieldsOffset = fieldsOffset;
+	m_metaCount = metaCount;
+	m_metaOffset = metaOffset;
+	m_strtabOffset = strtabOffset;
+	m_strtabSize = strtabSize;
+}
+
+/**
+ * Read a 32-bit value.
+ * @param offset Offset. (must be in bounds)
+ * @return Value.
+ */
+uint32_t RomFieldsBinary::u32(uint32_t offset) const
+{
+	assert(static_cast<size_t>(offset) + 4 <= m_size);
+	uint32_t val;
+	memcpy(&val, &m_data[offset], sizeof(val));
+	return le32_to_cpu(val);
+}
+
+/**
+ * Get a string from a string reference.
+ * @param offset String reference offset. (must be in bounds)
+ * @param pLen [out,opt] String length.
+ * @return NUL-terminated string. (empty string on error)
+ */
+const char *RomFieldsBinary::strRef(uint32_t offset, size_t *pLen) const
+{
+	const uint32_t strOffset = u32(offset);
+	const uint32_t len = u32(offset + 4);
+	if (strOffset >= m_strtabSize || len >= m_strtabSize - strOffset) {
+		// Out of bounds.
+		if (pLen) {
+			*pLen = 0;
+		}
+		return "";
+	}
+
+	const char *const str = reinterpret_cast<const char*>(&m_data[m_strtabOffset + strOffset]);
+	if (str[len] != '\0') {
+		// Not NUL-terminated.
+		if (pLen) {
+			*pLen = 0;
+		}
+		return "";
+	}
+	if (pLen) {
+		*pLen = len;
+	}
+	return str;
+}
+
+/**
+ * Check an array reference.
+ * @param offset Array reference offset. (must be in bounds)
+ * @param elemSize Element size.
+ * @param pCount [out] Element count. (0 on error)
+ * @return Array offset, or 0 if the array is null or out of bounds.
+ */
+uint32_t RomFieldsBinary::arrayRef(uint32_t offset, uint32_t elemSize, uint32_t *pCount) const
+{
+	const uint32_t arr = u32(offset);
+	const uint32_t count = u32(offset + 4);
+	if (arr == 0 || static_cast<uint64_t>(arr) + (static_cast<uint64_t>(count) * elemSize) > m_size) {
+		*pCount = 0;
+		return 0;
+	}
+	*pCount = count;
+	return arr;
+}
+
+/**
+ * Get the name of the specified tab.
+ * @param tabIdx Tab index.
+ * @return Tab name, or nullptr if no name is set.
+ */
+const char *RomFieldsBinary::tabName(int tabIdx) const
+{
+	if (tabIdx < 0 || static_cast<uint32_t>(tabIdx) >= m_tabCount)
+		return nullptr;
+
+	const char *const name = strRef(m_tabsOffset + (tabIdx * sizeof(RFB_StrRef)));
+	return (name[0] != '\0' ? name : nullptr);
+}
+
+/**
+ * Get a field view.
+ * @param idx Field index. (must be valid)
+ * @return Field view.
+ */
+RomFieldsBinary::Field RomFieldsBinary::at(int idx) const
+{
+	assert(idx >= 0 && static_cast<uint32_t>(idx) < m_fieldCount);
+	return Field(this, m_fieldsOffset + (idx * sizeof(RFB_Field)));
+}
+
+/**
+ * Get a metadata property view.
+ * @param idx Metadata index. (must be valid)
+ * @return Metadata property view.
+ */
+RomFieldsBinary::MetaData RomFieldsBinary::metaDataAt(int idx) const
+{
+	assert(idx >= 0 && static_cast<uint32_t>(idx) < m_metaCount);
+	return MetaData(this, m_metaOffset + (idx * sizeof(RFB_MetaData)));
+}
+
+/** Field view **/
+
+#define FIELD_DATA(n) (m_offset + offsetof(RFB_Field, data) + ((n) * 4))
+
+const char *RomFieldsBinary::Field::name(void) const
+{
+	return m_bin->strRef(m_offset + offsetof(RFB_Field, name));
+}
+
+RomFields::RomFieldType RomFieldsBinary::Field::type(void) const
+{
+	return static_cast<RomFields::RomFieldType>(m_bin->m_data[m_offset + offsetof(RFB_Field, type)]);
+}
+
+uint8_t RomFieldsBinary::Field::tabIdx(void) const
+{
+	return m_bin->m_data[m_offset + offsetof(RFB_Field, tabIdx)];
+}
+
+unsigned int RomFieldsBinary::Field::flags(void) const
+{
+	return m_bin->u32(m_offset + offsetof(RFB_Field, flags));
+}
+
+const char *RomFieldsBinary::Field::str(size_t *pLen) const
+{
+	if (type() != RomFields::RFT_STRING) {
+		if (pLen) {
+			*pLen = 0;
+		}
+		return "";
+	}
+	return m_bin->strRef(FIELD_DATA(0), pLen);
+}
+
+int RomFieldsBinary::Field::bitfieldElemsPerRow(void) const
+{
+	return (type() == RomFields::RFT_BITFIELD ? static_cast<int>(m_bin->u32(FIELD_DATA(0))) : 0);
+}
+
+uint32_t RomFieldsBinary::Field::bitfield(void) const
+{
+	return (type() == RomFields::RFT_BITFIELD ? m_bin->u32(FIELD_DATA(1)) : 0);
+}
+
+unsigned int RomFieldsBinary::Field::bitfieldNameCount(void) const
+{
+	if (type() != RomFields::RFT_BITFIELD)
+		return 0;
+	uint32_t count;
+	m_bin->arrayRef(FIELD_DATA(2), sizeof(RFB_StrRef), &count);
+	return count;
+}
+
+const char *RomFieldsBinary::Field::bitfieldName(unsigned int idx) const
+{
+	if (type() != RomFields::RFT_BITFIELD)
+		return "";
+	uint32_t count;
+	const uint32_t arr = m_bin->arrayRef(FIELD_DATA(2), sizeof(RFB_StrRef), &count);
+	if (idx >= count)
+		return "";
+	return m_bin->strRef(arr + (idx * sizeof(RFB_StrRef)));
+}
+
+// Get the RFB_ListData offset for an RFT_LISTDATA field.
+// Evaluates to 0 if this isn't RFT_LISTDATA or if it's out of bounds.
+#define LIST_DATA_OFFSET() \
+	((type() == RomFields::RFT_LISTDATA && \
+	  static_cast<uint64_t>(m_bin->u32(FIELD_DATA(0))) + sizeof(RFB_ListData) <= m_bin->m_size) \
+		? m_bin->u32(FIELD_DATA(0)) : 0U)
+
+int RomFieldsBinary::Field::listRowsVisible(void) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	return (ld != 0 ? static_cast<int>(m_bin->u32(ld + offsetof(RFB_ListData, rows_visible))) : 0);
+}
+
+uint32_t RomFieldsBinary::Field::listAlignHeaders(void) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	return (ld != 0 ? m_bin->u32(ld + offsetof(RFB_ListData, align_headers)) : 0);
+}
+
+uint32_t RomFieldsBinary::Field::listAlignData(void) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	return (ld != 0 ? m_bin->u32(ld + offsetof(RFB_ListData, align_data)) : 0);
+}
+
+uint32_t RomFieldsBinary::Field::listCheckboxes(void) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	return (ld != 0 ? m_bin->u32(ld + offsetof(RFB_ListData, checkboxes)) : 0);
+}
+
+bool RomFieldsBinary::Field::listHasHeaders(void) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	if (ld == 0)
+		return false;
+	uint32_t count;
+	return (m_bin->arrayRef(ld + offsetof(RFB_ListData, headers), sizeof(RFB_StrRef), &count) != 0);
+}
+
+unsigned int RomFieldsBinary::Field::listHeaderCount(void) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	if (ld == 0)
+		return 0;
+	uint32_t count;
+	m_bin->arrayRef(ld + offsetof(RFB_ListData, headers), sizeof(RFB_StrRef), &count);
+	return count;
+}
+
+const char *RomFieldsBinary::Field::listHeader(unsigned int idx) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	if (ld == 0)
+		return "";
+	uint32_t count;
+	const uint32_t arr = m_bin->arrayRef(ld + offsetof(RFB_ListData, headers), sizeof(RFB_StrRef), &count);
+	if (idx >= count)
+		return "";
+	return m_bin->strRef(arr + (idx * sizeof(RFB_StrRef)));
+}
+
+/**
+ * Get the number of ListData tables.
+ * This is 1 for standard ListData, or the number
+ * of languages for RFT_LISTDATA_MULTI.
+ * @return Number of ListData tables.
+ */
+unsigned int RomFieldsBinary::Field::listDataCount(void) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	if (ld == 0)
+		return 0;
+	uint32_t count;
+	m_bin->arrayRef(ld + offsetof(RFB_ListData, lists), sizeof(RFB_ListDataLC), &count);
+	return count;
+}
+
+/**
+ * Get a ListData table's language code.
+ * @param lcIdx ListData table index.
+ * @return Language code. (0 for standard ListData)
+ */
+uint32_t RomFieldsBinary::Field::listDataLC(unsigned int lcIdx) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	if (ld == 0)
+		return 0;
+	uint32_t count;
+	const uint32_t arr = m_bin->arrayRef(ld + offsetof(RFB_ListData, lists), sizeof(RFB_ListDataLC), &count);
+	if (lcIdx >= count)
+		return 0;
+	return m_bin->u32(arr + (lcIdx * sizeof(RFB_ListDataLC)));
+}
+
+unsigned int RomFieldsBinary::Field::listRowCount(unsigned int lcIdx) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	if (ld == 0)
+		return 0;
+	uint32_t count;
+	const uint32_t arr = m_bin->arrayRef(ld + offsetof(RFB_ListData, lists), sizeof(RFB_ListDataLC), &count);
+	if (lcIdx >= count)
+		return 0;
+	m_bin->arrayRef(arr + (lcIdx * sizeof(RFB_ListDataLC)) + offsetof(RFB_ListDataLC, rows),
+		sizeof(RFB_ArrayRef), &count);
+	return count;
+}
+
+unsigned int RomFieldsBinary::Field::listColCount(unsigned int lcIdx, unsigned int row) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	if (ld == 0)
+		return 0;
+	uint32_t count;
+	const uint32_t arr = m_bin->arrayRef(ld + offsetof(RFB_ListData, lists), sizeof(RFB_ListDataLC), &count);
+	if (lcIdx >= count)
+		return 0;
+	const uint32_t rows = m_bin->arrayRef(arr + (lcIdx * sizeof(RFB_ListDataLC)) + offsetof(RFB_ListDataLC, rows),
+		sizeof(RFB_ArrayRef), &count);
+	if (row >= count)
+		return 0;
+	m_bin->arrayRef(rows + (row * sizeof(RFB_ArrayRef)), sizeof(RFB_StrRef), &count);
+	return count;
+}
+
+const char *RomFieldsBinary::Field::listCell(unsigned int lcIdx, unsigned int row, unsigned int col) const
+{
+	const uint32_t ld = LIST_DATA_OFFSET();
+	if (ld == 0)
+		return "";
+	uint32_t count;
+	const uint32_t arr = m_bin->arrayRef(ld + offsetof(RFB_ListData, lists), sizeof(RFB_ListDataLC), &count);
+	if (lcIdx >= count)
+		return "";
+	const uint32_t rows = m_bin->arrayRef(arr + (lcIdx * sizeof(RFB_ListDataLC)) + offsetof(RFB_ListDataLC, rows),
+		sizeof(RFB_ArrayRef), &count);
+	if (row >= count)
+		return "";
+	const uint32_t cols = m_bin->arrayRef(rows + (row * sizeof(RFB_ArrayRef)), sizeof(RFB_StrRef), &count);
+	if (col >= count)
+		return "";
+	return m_bin->strRef(cols + (col * sizeof(RFB_StrRef)));
+}
+
+time_t RomFieldsBinary::Field::dateTime(void) const
+{
+	if (type() != RomFields::RFT_DATETIME)
+		return -1;
+	const uint64_t val = static_cast<uint64_t>(m_bin->u32(FIELD_DATA(0))) |
+		(static_cast<uint64_t>(m_bin->u32(FIELD_DATA(1))) << 32);
+	return static_cast<time_t>(static_cast<int64_t>(val));
+}
+
+void RomFieldsBinary::Field::ageRatings(RomFields::age_ratings_t &age_ratings) const
+{
+	age_ratings.fill(0);
+	if (type() != RomFields::RFT_AGE_RATINGS)
+		return;
+	const uint32_t arr = m_bin->u32(FIELD_DATA(0));
+	if (static_cast<uint64_t>(arr) + (RomFields::AGE_MAX * sizeof(uint16_t)) > m_bin->m_size)
+		return;
+	for (unsigned int i = 0; i < RomFields::AGE_MAX; i++) {
+		uint16_t rating;
+		memcpy(&rating, &m_bin->m_data[arr + (i * sizeof(uint16_t))], sizeof(rating));
+		age_ratings[i] = le16_to_cpu(rating);
+	}
+}
+
+int RomFieldsBinary::Field::dimension(unsigned int idx) const
+{
+	if (type() != RomFields::RFT_DIMENSIONS || idx >= 3)
+		return 0;
+	return static_cast<int>(m_bin->u32(FIELD_DATA(idx)));
+}
+
+unsigned int RomFieldsBinary::Field::strMultiCount(void) const
+{
+	if (type() != RomFields::RFT_STRING_MULTI)
+		return 0;
+	uint32_t count;
+	m_bin->arrayRef(FIELD_DATA(0), sizeof(RFB_StrMulti), &count);
+	return count;
+}
+
+const char *RomFieldsBinary::Field::strMulti(unsigned int idx, uint32_t *pLC) const
+{
+	*pLC = 0;
+	if (type() != RomFields::RFT_STRING_MULTI)
+		return "";
+	uint32_t count;
+	const uint32_t arr = m_bin->arrayRef(FIELD_DATA(0), sizeof(RFB_StrMulti), &count);
+	if (idx >= count)
+		return "";
+	const uint32_t smRec = arr + (idx * sizeof(RFB_StrMulti));
+	*pLC = m_bin->u32(smRec);
+	return m_bin->strRef(smRec + offsetof(RFB_StrMulti, str));
+}
+
+/** MetaData view **/
+
+Property::Property RomFieldsBinary::MetaData::name(void) const
+{
+	const uint32_t name = m_bin->u32(m_offset + offsetof(RFB_MetaData, name));
+	return (name > static_cast<uint32_t>(Property::FirstProperty) &&
+		name <= static_cast<uint32_t>(Property::LastProperty)
+		? static_cast<Property::Property>(name)
+		: Property::Empty);
+}
+
+PropertyType::PropertyType RomFieldsBinary::MetaData::type(void) const
+{
+	const uint32_t type = m_bin->u32(m_offset + offsetof(RFB_MetaData, type));
+	return (type <= static_cast<uint32_t>(PropertyType::LastPropertyType)
+		? static_cast<PropertyType::PropertyType>(type)
+		: PropertyType::Invalid);
+}
+
+int RomFieldsBinary::MetaData::ivalue(void) const
+{
+	return static_cast<int>(m_bin->u32(m_offset + offsetof(RFB_MetaData, data)));
+}
+
+unsigned int RomFieldsBinary::MetaData::uvalue(void) const
+{
+	return m_bin->u32(m_offset + offsetof(RFB_MetaData, data));
+}
+
+const char *RomFieldsBinary::MetaData::str(size_t *pLen) const
+{
+	if (type() != PropertyType::String) {
+		if (pLen) {
+			*pLen = 0;
+		}
+		return "";
+	}
+	return m_bin->strRef(m_offset + offsetof(RFB_MetaData, data), pLen);
+}
+
+time_t RomFieldsBinary::MetaData::timestamp(void) const
+{
+	const uint32_t data = m_offset + offsetof(RFB_MetaData, data);
+	const uint64_t val = static_cast<uint64_t>(m_bin->u32(data)) |
+		(static_cast<uint64_t>(m_bin->u32(data + 4)) << 32);
+	return static_cast<time_t>(static_cast<int64_t>(val));
+}
+
+/** Conversion **/
+
+/**
+ * Add the serialized fields to a RomFields object.
+ * This is needed for code that only handles RomFields.
+ * @param fields RomFields object.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomFieldsBinary::toRomFields(RomFields *fields) const
+{
+	assert(fields != nullptr);
+	if (!fields)
+		return -EINVAL;
+	else if (!isValid())
+		return -EIO;
+
+	// Tabs.
+	fields->reserveTabs(static_cast<int>(m_tabCount));
+	for (uint32_t i = 0; i < m_tabCount; i++) {
+		const char *const name = tabName(static_cast<int>(i));
+		if (name) {
+			fields->setTabName(static_cast<int>(i), name);
+		}
+	}
+
+	// Fields.
+	fields->reserve(static_cast<int>(m_fieldCount));
+	for (uint32_t i = 0; i < m_fieldCount; i++) {
+		const Field field = at(static_cast<int>(i));
+		if (field.tabIdx() >= m_tabCount && m_tabCount > 0) {
+			// Invalid tab index.
+			return -EIO;
+		}
+		fields->setTabIndex(field.tabIdx());
+		const char *const name = field.name();
+
+		switch (field.type()) {
+			case RomFields::RFT_STRING: {
+				size_t len;
+				const char *const str = field.str(&len);
+				fields->addField_string(name, string(str, len), field.flags());
+				break;
+			}
+
+			case RomFields::RFT_BITFIELD: {
+				const unsigned int count = field.bitfieldNameCount();
+				vector<string> *const names = new vector<string>();
+				names->reserve(count);
+				for (unsigned int j = 0; j < count; j++) {
+					names->emplace_back(field.bitfieldName(j));
+				}
+				fields->addField_bitfield(name, names, field.bitfieldElemsPerRow(), field.bitfield());
+				break;
+			}
+
+			case RomFields::RFT_LISTDATA: {
+				RomFields::AFLD_PARAMS params;
+				params.flags = field.flags();
+				params.rows_visible = field.listRowsVisible();
+				params.alignment.headers = field.listAlignHeaders();
+				params.alignment.data = field.listAlignData();
+				params.def_lc = m_def_lc;
+				if ((params.flags & RomFields::RFT_LISTDATA_ICONS) || params.rows_visible < 0) {
+					// Icons are not serialized, and rows_visible can't be negative.
+					return -EIO;
+				}
+				if (params.flags & RomFields::RFT_LISTDATA_CHECKBOXES) {
+					params.mxd.checkboxes = field.listCheckboxes();
+				}
+				if (field.listHasHeaders()) {
+					const unsigned int count = field.listHeaderCount();
+					vector<string> *const headers = new vector<string>();
+					headers->reserve(count);
+					for (unsigned int j = 0; j < count; j++) {
+						headers->emplace_back(field.listHeader(j));
+					}
+					params.headers = headers;
+				}
+
+				auto toListData = [&field](unsigned int lcIdx, RomFields::ListData_t &list_data) {
+					const unsigned int rowCount = field.listRowCount(lcIdx);
+					list_data.resize(rowCount);
+					for (unsigned int row = 0; row < rowCount; row++) {
+						const unsigned int colCount = field.listColCount(lcIdx, row);
+						vector<string> &data_row = list_data[row];
+						data_row.reserve(colCount);
+						for (unsigned int col = 0; col < colCount; col++) {
+							data_row.emplace_back(field.listCell(lcIdx, row, col));
+						}
+					}
+				};
+
+				const unsigned int lcCount = field.listDataCount();
+				if (params.flags & RomFields::RFT_LISTDATA_MULTI) {
+					RomFields::ListDataMultiMap_t *const multi = new RomFields::ListDataMultiMap_t();
+					for (unsigned int j = 0; j < lcCount; j++) {
+						toListData(j, (*multi)[field.listDataLC(j)]);
+					}
+					params.data.multi = multi;
+				} else if (lcCount > 0) {
+					RomFields::ListData_t *const list_data = new RomFields::ListData_t();
+					toListData(0, *list_data);
+					params.data.single = list_data;
+				}
+				fields->addField_listData(name, &params);
+				break;
+			}
+
+			case RomFields::RFT_DATETIME:
+				fields->addField_dateTime(name, field.dateTime(), field.flags());
+				break;
+
+			case RomFields::RFT_AGE_RATINGS: {
+				RomFields::age_ratings_t age_ratings;
+				field.ageRatings(age_ratings);
+				fields->addField_ageRatings(name, age_ratings);
+				break;
+			}
+
+			case RomFields::RFT_DIMENSIONS:
+				fields->addField_dimensions(name,
+					field.dimension(0), field.dimension(1), field.dimension(2));
+				break;
+
+			case RomFields::RFT_STRING_MULTI: {
+				const unsigned int count = field.strMultiCount();
+				RomFields::StringMultiMap_t *const str_multi = new RomFields::StringMultiMap_t();
+				for (unsigned int j = 0; j < count; j++) {
+					uint32_t lc;
+					const char *const str = field.strMulti(j, &lc);
+					(*str_multi)[lc] = str;
+				}
+				fields->addField_string_multi(name, str_multi, m_def_lc, field.flags());
+				break;
+			}
+
+			default:
+				// Unsupported field type.
+				return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Add the serialized metadata to a RomMetaData object.
+ * @param metaData RomMetaData object.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RomFieldsBinary::toRomMetaData(RomMetaData *metaData) const
+{
+	assert(metaData != nullptr);
+	if (!metaData)
+		return -EINVAL;
+	else if (!isValid())
+		return -EIO;
+
+	metaData->reserve(static_cast<int>(m_metaCount));
+	for (uint32_t i = 0; i < m_metaCount; i++) {
+		const MetaData prop = metaDataAt(static_cast<int>(i));
+		const Property::Property name = prop.name();
+		if (name == Property::Empty) {
+			// Invalid property name.
+			return -EIO;
+		}
+
+		switch (prop.type()) {
+			case PropertyType::Integer:
+				metaData->addMetaData_integer(name, prop.ivalue());
+				break;
+			case PropertyType::UnsignedInteger:
+				metaData->addMetaData_uint(name, prop.uvalue());
+				break;
+			case PropertyType::String: {
+				size_t len;
+				const char *const str = prop.str(&len);
+				metaData->addMetaData_string(name, string(str, len));
+				break;
+			}
+			case PropertyType::Timestamp:
+				metaData->addMetaData_timestamp(name, prop.timestamp());
+				break;
+			default:
+				// Unsupported property type.
+				return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+}
@@ -0,0 +1,325 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * RomFieldsBinary.hpp: Binary RomFields/RomMetaData serialization.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_ROMFIELDSBINARY_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_ROMFIELDSBINARY_HPP__
+
+#include "RomFields.hpp"
+#include "RomMetaData.hpp"
+
+// C includes.
+#include <stddef.h>	/* size_t */
+#include <stdint.h>
+
+// C includes. (C++ namespace)
+#include <ctime>
+
+// C++ includes.
+#include <vector>
+
+namespace LibRpBase {
+
+/**
+ * Binary RomFields/RomMetaData format.
+ *
+ * The format is flat and offset-based, so it can be read in place
+ * from a memory-mapped file or an IPC buffer without parsing it
+ * into heap objects first. All values are little-endian, and all
+ * records are 4-byte aligned relative to the start of the buffer.
+ * Strings are stored once in a NUL-terminated string table.
+ *
+ * Layout:
+ * - Header
+ * - Tab names (string references)
+ * - Field records (32 bytes each)
+ * - Metadata records (16 bytes each)
+ * - Variable-length data (arrays, ListData)
+ * - String table
+ *
+ * Increment VERSION if the layout changes.
+ */
+class RomFieldsBinary
+{
+	public:
+		static const uint32_t MAGIC = 'RPFB';
+		static const uint16_t VERSION = 1;
+
+		/**
+		 * Create a view over a serialized buffer.
+		 *
+		 * The buffer is not copied, and it must remain valid
+		 * for as long as the view (and any Field or MetaData
+		 * views obtained from it) is in use.
+		 *
+		 * The header and record tables are validated here;
+		 * everything else is bounds-checked on access.
+		 *
+		 * @param data Serialized data.
+		 * @param size Size of data.
+		 */
+		RomFieldsBinary(const void *data, size_t size);
+
+	public:
+		/**
+		 * Serialize RomFields and RomMetaData.
+		 *
+		 * Deferred tabs are loaded first.
+		 * Invalid fields are skipped.
+		 *
+		 * @param out		[out] Serialized data.
+		 * @param fields	[in,opt] RomFields.
+		 * @param metaData	[in,opt] RomMetaData.
+		 * @return 0 on success; negative POSIX error code on error. (-ENOTSUP for ListData icons)
+		 */
+		static int serialize(std::vector<uint8_t> &out,
+			const RomFields *fields, const RomMetaData *metaData);
+
+	public:
+		/**
+		 * Is the serialized data valid?
+		 * @return True if valid; false if not.
+		 */
+		inline bool isValid(void) const
+		{
+			return (m_data != nullptr);
+		}
+
+		/**
+		 * Get the serialized data size, as stored in the header.
+		 * @return Serialized data size.
+		 */
+		inline size_t size(void) const
+		{
+			return m_size;
+		}
+
+		/**
+		 * Get the default language code for RFT_STRING_MULTI and RFT_LISTDATA_MULTI.
+		 * @return Default language code, or 0 if not set.
+		 */
+		inline uint32_t defaultLanguageCode(void) const
+		{
+			return m_def_lc;
+		}
+
+		/**
+		 * Get the tab count.
+		 * @return Tab count.
+		 */
+		inline int tabCount(void) const
+		{
+			return static_cast<int>(m_tabCount);
+		}
+
+		/**
+		 * Get the name of the specified tab.
+		 * @param tabIdx Tab index.
+		 * @return Tab name, or nullptr if no name is set.
+		 */
+		const char *tabName(int tabIdx) const;
+
+	public:
+		/**
+		 * In-place view of a serialized field.
+		 * Accessors for other field types return default values.
+		 */
+		class Field
+		{
+			public:
+				Field(const RomFieldsBinary *bin, uint32_t offset)
+					: m_bin(bin), m_offset(offset) { }
+
+			public:
+				const char *name(void) const;
+				RomFields::RomFieldType type(void) const;
+				uint8_t tabIdx(void) const;
+
+				/**
+				 * Get the field flags.
+				 * This is StringFormat for RFT_STRING and RFT_STRING_MULTI,
+				 * DateTimeFlags for RFT_DATETIME, and ListDataFlags
+				 * for RFT_LISTDATA.
+				 * @return Flags.
+				 */
+				unsigned int flags(void) const;
+
+				/** RFT_STRING **/
+
+				/**
+				 * Get the string.
+				 * @param pLen [out,opt] String length.
+				 * @return NUL-terminated string. (empty string if not set)
+				 */
+				const char *str(size_t *pLen = nullptr) const;
+
+				/** RFT_BITFIELD **/
+				int bitfieldElemsPerRow(void) const;
+				uint32_t bitfield(void) const;
+				unsigned int bitfieldNameCount(void) const;
+				const char *bitfieldName(unsigned int idx) const;
+
+				/** RFT_LISTDATA **/
+				int listRowsVisible(void) const;
+				uint32_t listAlignHeaders(void) const;
+				uint32_t listAlignData(void) const;
+				uint32_t listCheckboxes(void) const;
+				bool listHasHeaders(void) const;
+				unsigned int listHeaderCount(void) const;
+				const char *listHeader(unsigned int idx) const;
+
+				/**
+				 * Get the number of ListData tables.
+				 * This is 1 for standard ListData, or the number
+				 * of languages for RFT_LISTDATA_MULTI.
+				 * @return Number of ListData tables.
+				 */
+				unsigned int listDataCount(void) const;
+
+				/**
+				 * Get a ListData table's language code.
+				 * @param lcIdx ListData table index.
+				 * @return Language code. (0 for standard ListData)
+				 */
+				uint32_t listDataLC(unsigned int lcIdx) const;
+
+				unsigned int listRowCount(unsigned int lcIdx) const;
+				unsigned int listColCount(unsigned int lcIdx, unsigned int row) const;
+				const char *listCell(unsigned int lcIdx, unsigned int row, unsigned int col) const;
+
+				/** RFT_DATETIME **/
+				time_t dateTime(void) const;
+
+				/** RFT_AGE_RATINGS **/
+				void ageRatings(RomFields::age_ratings_t &age_ratings) const;
+
+				/** RFT_DIMENSIONS **/
+				int dimension(unsigned int idx) const;
+
+				/** RFT_STRING_MULTI **/
+				unsigned int strMultiCount(void) const;
+				const char *strMulti(unsigned int idx, uint32_t *pLC) const;
+
+			private:
+				const RomFieldsBinary *m_bin;
+				uint32_t m_offset;	// Field record offset
+		};
+
+		/**
+		 * Get the number of fields.
+		 * @return Number of fields.
+		 */
+		inline int count(void) const
+		{
+			return static_cast<int>(m_fieldCount);
+		}
+
+		/**
+		 * Get a field view.
+		 * @param idx Field index. (must be valid)
+		 * @return Field view.
+		 */
+		Field at(int idx) const;
+
+	public:
+		/**
+		 * In-place view of a serialized metadata property.
+		 */
+		class MetaData
+		{
+			public:
+				MetaData(const RomFieldsBinary *bin, uint32_t offset)
+					: m_bin(bin), m_offset(offset) { }
+
+			public:
+				Property::Property name(void) const;
+				PropertyType::PropertyType type(void) const;
+				int ivalue(void) const;
+				unsigned int uvalue(void) const;
+				const char *str(size_t *pLen = nullptr) const;
+				time_t timestamp(void) const;
+
+			private:
+				const RomFieldsBinary *m_bin;
+				uint32_t m_offset;	// Metadata record offset
+		};
+
+		/**
+		 * Get the number of metadata properties.
+		 * @return Number of metadata properties.
+		 */
+		inline int metaDataCount(void) const
+		{
+			return static_cast<int>(m_metaCount);
+		}
+
+		/**
+		 * Get a metadata property view.
+		 * @param idx Metadata index. (must be valid)
+		 * @return Metadata property view.
+		 */
+		MetaData metaDataAt(int idx) const;
+
+	public:
+		/**
+		 * Add the serialized fields to a RomFields object.
+		 * This is needed for code that only handles RomFields.
+		 * @param fields RomFields object.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int toRomFields(RomFields *fields) const;
+
+		/**
+		 * Add the serialized metadata to a RomMetaData object.
+		 * @param metaData RomMetaData object.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int toRomMetaData(RomMetaData *metaData) const;
+
+	private:
+		/**
+		 * Read a 32-bit value.
+		 * @param offset Offset. (must be in bounds)
+		 * @return Value.
+		 */
+		uint32_t u32(uint32_t offset) const;
+
+		/**
+		 * Get a string from a string reference.
+		 * @param offset String reference offset. (must be in bounds)
+		 * @param pLen [out,opt] String length.
+		 * @return NUL-terminated string. (empty string on error)
+		 */
+		const char *strRef(uint32_t offset, size_t *pLen = nullptr) const;
+
+		/**
+		 * Check an array reference.
+		 * @param offset Array reference offset. (must be in bounds)
+		 * @param elemSize Element size.
+		 * @param pCount [out] Element count. (0 on error)
+		 * @return Array offset, or 0 if the array is null or out of bounds.
+		 */
+		uint32_t arrayRef(uint32_t offset, uint32_t elemSize, uint32_t *pCount) const;
+
+	private:
+		const uint8_t *m_data;	// nullptr if invalid
+		size_t m_size;
+
+		uint32_t m_def_lc;
+		uint32_t m_tabCount;
+		uint32_t m_tabsOffset;
+		uint32_t m_fieldCount;
+		uint32_t m_fieldsOffset;
+		uint32_t m_metaCount;
+		uint32_t m_metaOffset;
+		uint32_t m_strtabOffset;
+		uint32_t m_strtabSize;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_ROMFIELDSBINARY_HPP__ */
@@ -45,6 +45,9 @@ class RomMetaDataPrivate
 		// Property type mapping.
 		static const uint8_t PropertyTypeMap[];
 
+		// Property name mapping.
+		static const char *const PropertyNameMap[];
+
 		/**
 		 * Add or overwrite a Property.
 		 * @param name Property name.
@@ -147,10 +150,56 @@ const uint8_t RomMetaDataPrivate::PropertyTypeMap[] = {
 	PropertyType::String,	// License
 };
 
+// Property name mapping.
+// NOTE: These match the KFileMetaData property names.
+const char *const RomMetaDataPrivate::PropertyNameMap[] = {
+	nullptr,	// first property is invalid
+
+	// Audio
+	"bitRate", "channels", "duration", "genre", "sampleRate",
+	"trackNumber", "releaseYear", "comment", "artist", "album",
+	"albumArtist", "composer", "lyricist",
+
+	// Document
+	"author", "title", "subject", "generator", "pageCount",
+	"wordCount", "lineCount", "language", "copyright", "publisher",
+	"creationDate", "keywords",
+
+	// Media
+	"width", "height", "aspectRatio", "frameRate",
+
+	// Images
+	"imageMake", "imageModel", "imageDateTime", "imageOrientation",
+	"photoFlash", "photoPixelXDimension", "photoPixelYDimension",
+	"photoDateTimeOriginal", "photoFocalLength", "photoFocalLengthIn35mmFilm",
+	"photoExposureTime", "photoFNumber", "photoApertureValue",
+	"photoExposureBiasValue", "photoWhiteBalance", "photoMeteringMode",
+	"photoISOSpeedRatings", "photoSaturation", "photoSharpness",
+	"photoGpsLatitude", "photoGpsLongitude", "photoGpsAltitude",
+
+	// Translations
+	"translationUnitsTotal", "translationUnitsWithTranslation",
+	"translationUnitsWithDraftTranslation", "translationLastAuthor",
+	"translationLastUpDate", "translationTemplateDate",
+
+	// Origin
+	"originUrl", "originEmailSubject", "originEmailSender",
+	"originEmailMessageId",
+
+	// Audio
+	"discNumber", "location", "performer", "ensemble",
+	"arranger", "conductor", "opus",
+
+	// Other
+	"label", "compilation", "license",
+};
+
 RomMetaDataPrivate::RomMetaDataPrivate()
 {
 	static_assert(ARRAY_SIZE(RomMetaDataPrivate::PropertyTypeMap) == Property::PropertyCount,
 		      "PropertyTypeMap needs to be updated!");
+	static_assert(ARRAY_SIZE(RomMetaDataPrivate::PropertyNameMap) == Property::PropertyCount,
+		      "PropertyNameMap needs to be updated!");
 	map_metaData.fill(-1);
 }
 
@@ -292,6 +341,22 @@ bool RomMetaData::empty(void) const
 	return d->metaData.empty();
 }
 
+/**
+ * Get the name of a metadata property.
+ * These match the KFileMetaData property names,
+ * with a lowercase first letter.
+ * @param name Property.
+ * @return Property name, or nullptr if invalid.
+ */
+const char *RomMetaData::getPropertyName(Property::Property name)
+{
+	assert(name > Property::FirstProperty);
+	assert(name < Property::PropertyCount);
+	if (name <= Property::FirstProperty || name >= Property::PropertyCount)
+		return nullptr;
+	return RomMetaDataPrivate::PropertyNameMap[name];
+}
+
 /** Convenience functions for RomData subclasses. **/
 
 /**
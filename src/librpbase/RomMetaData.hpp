@@ -209,6 +209,15 @@ class RomMetaData
 		 */
 		bool empty(void) const;
 
+		/**
+		 * Get the name of a metadata property.
+		 * These match the KFileMetaData property names,
+		 * with a lowercase first letter.
+		 * @param name Property.
+		 * @return Property name, or nullptr if invalid.
+		 */
+		static const char *getPropertyName(Property::Property name);
+
 	public:
 		/** Convenience functions for RomData subclasses. **/
 
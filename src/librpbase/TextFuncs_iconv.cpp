@@ -2,7 +2,7 @@
  * ROM Properties Page shell extension. (librpbase)                        *
  * TextFuncs_iconv.cpp: Text encoding functions. (iconv version)           *
  *                                                                         *
- * Copyright (c) 2009-2019 by David Korth.                                 *
+ * Copyright (c) 2009-2020 by David Korth.                                 *
  * SPDX-License-Identifier: GPL-2.0-or-later                               *
  ***************************************************************************/
 
@@ -38,12 +38,249 @@
 # include <iconv.h>
 #endif
 
+// SSE2 is used for the ASCII check if it's available.
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif /* __SSE2__ */
+
 // C++ STL classes.
+using std::array;
 using std::string;
 using std::u16string;
 
 namespace LibRpBase {
 
+/** iconv descriptor cache. **/
+
+/**
+ * Per-thread cache of iconv descriptors.
+ *
+ * iconv_open() has to look up both character sets and
+ * usually allocates conversion tables, so opening a new
+ * descriptor for every string is expensive. iconv_t isn't
+ * thread-safe, so each thread gets its own cache.
+ */
+class IconvCache
+{
+	public:
+		IconvCache()
+			: m_count(0)
+			, m_next(0)
+		{ }
+
+		~IconvCache()
+		{
+			for (unsigned int i = 0; i < m_count; i++) {
+				iconv_close(m_entries[i].cd);
+			}
+		}
+
+	private:
+		RP_DISABLE_COPY(IconvCache)
+
+	public:
+		/**
+		 * Get an iconv descriptor.
+		 * The descriptor's conversion state is reset.
+		 *
+		 * The caller must NOT close the descriptor if it's cached.
+		 *
+		 * @param src_charset	[in] Source character set.
+		 * @param dest_charset	[in] Destination character set.
+		 * @param ignoreErr	[in] If true, ignore errors. ("//IGNORE" on glibc/libiconv)
+		 * @param pIsCached	[out] Set to true if the descriptor is cached.
+		 * @return iconv descriptor, or (iconv_t)(-1) on error.
+		 */
+		iconv_t get(const char *src_charset, const char *dest_charset,
+			bool ignoreErr, bool *pIsCached);
+
+	private:
+		/**
+		 * Open an iconv descriptor.
+		 * @param src_charset	[in] Source character set.
+		 * @param dest_charset	[in] Destination character set.
+		 * @param ignoreErr	[in] If true, ignore errors. ("//IGNORE" on glibc/libiconv)
+		 * @return iconv descriptor, or (iconv_t)(-1) on error.
+		 */
+		static iconv_t open(const char *src_charset, const char *dest_charset, bool ignoreErr);
+
+	private:
+		struct Entry {
+			char src_charset[24];
+			char dest_charset[24];
+			bool ignoreErr;
+			iconv_t cd;
+		};
+
+		// Most files only use one or two conversions,
+		// so a small cache with round-robin replacement
+		// is sufficient.
+		static const unsigned int CACHE_SIZE = 8;
+		array<Entry, CACHE_SIZE> m_entries;
+		unsigned int m_count;	// Number of valid entries.
+		unsigned int m_next;	// Next entry to replace if the cache is full.
+};
+
+/**
+ * Open an iconv descriptor.
+ * @param src_charset	[in] Source character set.
+ * @param dest_charset	[in] Destination character set.
+ * @param ignoreErr	[in] If true, ignore errors. ("//IGNORE" on glibc/libiconv)
+ * @return iconv descriptor, or (iconv_t)(-1) on error.
+ */
+iconv_t IconvCache::open(const char *src_charset, const char *dest_charset, bool ignoreErr)
+{
+#if defined(__linux__) || defined(HAVE_ICONV_LIBICONV)
+	// glibc/libiconv: Append "//IGNORE" to the source character set
+	// if ignoreErr == true.
+	// TODO: Destination, not source?
+	if (ignoreErr) {
+		char tmpsrc[32];
+		snprintf(tmpsrc, sizeof(tmpsrc), "%s//IGNORE", src_charset);
+		return iconv_open(dest_charset, tmpsrc);
+	}
+#else
+	RP_UNUSED(ignoreErr);
+#endif
+
+	// Not ignoring errors.
+	return iconv_open(dest_charset, src_charset);
+}
+
+/**
+ * Get an iconv descriptor.
+ * The descriptor's conversion state is reset.
+ *
+ * The caller must NOT close the descriptor if it's cached.
+ *
+ * @param src_charset	[in] Source character set.
+ * @param dest_charset	[in] Destination character set.
+ * @param ignoreErr	[in] If true, ignore errors. ("//IGNORE" on glibc/libiconv)
+ * @param pIsCached	[out] Set to true if the descriptor is cached.
+ * @return iconv descriptor, or (iconv_t)(-1) on error.
+ */
+iconv_t IconvCache::get(const char *src_charset, const char *dest_charset,
+	bool ignoreErr, bool *pIsCached)
+{
+	for (unsigned int i = 0; i < m_count; i++) {
+		Entry &entry = m_entries[i];
+		if (entry.ignoreErr == ignoreErr &&
+		    !strcmp(entry.src_charset, src_charset) &&
+		    !strcmp(entry.dest_charset, dest_charset))
+		{
+			// Found a cached descriptor.
+			// Reset the conversion state in case the
+			// previous conversion failed partway through.
+			iconv(entry.cd, nullptr, nullptr, nullptr, nullptr);
+			*pIsCached = true;
+			return entry.cd;
+		}
+	}
+
+	iconv_t cd = open(src_charset, dest_charset, ignoreErr);
+	if (cd == (iconv_t)(-1) ||
+	    strlen(src_charset) >= sizeof(Entry::src_charset) ||
+	    strlen(dest_charset) >= sizeof(Entry::dest_charset))
+	{
+		// Error opening iconv, or the character set names
+		// are too long to be cached.
+		*pIsCached = false;
+		return cd;
+	}
+
+	// Add the descriptor to the cache.
+	Entry *entry;
+	if (m_count < CACHE_SIZE) {
+		entry = &m_entries[m_count++];
+	} else {
+		entry = &m_entries[m_next];
+		iconv_close(entry->cd);
+		m_next = (m_next + 1) % CACHE_SIZE;
+	}
+	strcpy(entry->src_charset, src_charset);
+	strcpy(entry->dest_charset, dest_charset);
+	entry->ignoreErr = ignoreErr;
+	entry->cd = cd;
+
+	*pIsCached = true;
+	return cd;
+}
+
+static thread_local IconvCache iconvCache;
+
+/** ASCII fast path. **/
+
+/**
+ * Check if a string only contains ASCII characters.
+ * @param str	[in] String.
+ * @param len	[in] Length of str, in bytes.
+ * @return True if str is 7-bit ASCII; false if not.
+ */
+static bool isAscii(const char *str, size_t len)
+{
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(str);
+	const uint8_t *const p_end = p + len;
+
+#ifdef __SSE2__
+	// Check 16 bytes at a time.
+	// _mm_movemask_epi8() returns the high bit of each byte.
+	for (; p + 16 <= p_end; p += 16) {
+		const __m128i xmm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		if (_mm_movemask_epi8(xmm) != 0)
+			return false;
+	}
+#else /* !__SSE2__ */
+	// Check a machine word at a time.
+	static const uintptr_t hibits = static_cast<uintptr_t>(0x8080808080808080ULL);
+	for (; p + sizeof(uintptr_t) <= p_end; p += sizeof(uintptr_t)) {
+		uintptr_t word;
+		memcpy(&word, p, sizeof(word));
+		if (word & hibits)
+			return false;
+	}
+#endif /* __SSE2__ */
+
+	// Check the remaining bytes.
+	for (; p < p_end; p++) {
+		if (*p & 0x80)
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Is the specified code page a superset of ASCII?
+ * If it is, 7-bit ASCII text doesn't need to be converted.
+ * NOTE: EBCDIC, UTF-7, and UTF-16 code pages are NOT supersets of ASCII.
+ * @param cp Code page number.
+ * @return True if the code page is a superset of ASCII; false if not.
+ */
+static inline bool isAsciiCompatible(unsigned int cp)
+{
+	switch (cp) {
+		case CP_ACP:
+		case CP_LATIN1:
+		case CP_UTF8:
+		case 437:	// DOS (US)
+		case 850:	// DOS (Latin-1)
+		case 852:	// DOS (Latin-2)
+		case 866:	// DOS (Cyrillic)
+		case 874:	// Thai
+		case 932:	// Shift-JIS (cp932 maps 0x5C and 0x7E to ASCII)
+		case 936:	// GBK
+		case 949:	// Korean
+		case 950:	// Big5
+		case 20127:	// US-ASCII
+			return true;
+		default:
+			break;
+	}
+
+	// Windows code pages and ISO-8859-x.
+	return (cp >= 1250 && cp <= 1258) ||
+	       (cp >= 28591 && cp <= 28605);
+}
+
 /** OS-specific text conversion functions. **/
 
 /**
@@ -75,24 +312,9 @@ static char *rp_iconv(const char *src, int len,
 	// * http://www.delorie.com/gnu/docs/glibc/libc_101.html
 	// * http://www.codase.com/search/call?name=iconv
 
-	// Open an iconv descriptor.
-	iconv_t cd;
-#if defined(__linux__) || defined(HAVE_ICONV_LIBICONV)
-	// glibc/libiconv: Append "//IGNORE" to the source character set
-	// if ignoreErr == true.
-	// TODO: Destination, not source?
-	if (ignoreErr) {
-		char tmpsrc[32];
-		snprintf(tmpsrc, sizeof(tmpsrc), "%s//IGNORE", src_charset);
-		cd = iconv_open(dest_charset, tmpsrc);
-	} else {
-		// Not ignoring errors.
-		cd = iconv_open(dest_charset, src_charset);
-	}
-#else
-	cd = iconv_open(dest_charset, src_charset);
-#endif
-
+	// Get an iconv descriptor.
+	bool isCached;
+	iconv_t cd = iconvCache.get(src_charset, dest_charset, ignoreErr, &isCached);
 	if (cd == (iconv_t)(-1)) {
 		// Error opening iconv.
 		return nullptr;
@@ -137,8 +359,10 @@ static char *rp_iconv(const char *src, int len,
 		}
 	}
 
-	// Close the iconv descriptor.
-	iconv_close(cd);
+	// Close the iconv descriptor if it isn't cached.
+	if (!isCached) {
+		iconv_close(cd);
+	}
 
 	if (success) {
 		// The string was converted successfully.
@@ -202,6 +426,10 @@ static inline void codePageToEncName(char *enc_name, size_t len, unsigned int cp
 string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags)
 {
 	len = check_NULL_terminator(str, len);
+	if (isAsciiCompatible(cp) && isAscii(str, len)) {
+		// ASCII text doesn't need to be converted.
+		return string(str, len);
+	}
 
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
@@ -269,6 +497,10 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 u16string cpN_to_utf16(unsigned int cp, const char *str, int len, unsigned int flags)
 {
 	len = check_NULL_terminator(str, len);
+	if (isAsciiCompatible(cp) && isAscii(str, len)) {
+		// ASCII text only needs to be widened.
+		return u16string(str, str + len);
+	}
 
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
@@ -332,6 +564,10 @@ u16string cpN_to_utf16(unsigned int cp, const char *str, int len, unsigned int f
 string utf8_to_cpN(unsigned int cp, const char *str, int len)
 {
 	len = check_NULL_terminator(str, len);
+	if (isAsciiCompatible(cp) && isAscii(str, len)) {
+		// ASCII text doesn't need to be converted.
+		return string(str, len);
+	}
 
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
@@ -380,48 +616,4 @@ string utf16_to_cpN(unsigned int cp, const char16_t *wcs, int len)
 	return ret;
 }
 
-/** Specialized UTF-16 conversion functions. **/
-
-/**
- * Convert UTF-16LE text to UTF-8.
- * Trailing NULL bytes will be removed.
- * @param wcs	[in] UTF-16LE text.
- * @param len	[in] Length of wcs, in characters. (-1 for NULL-terminated string)
- * @return UTF-8 string.
- */
-string utf16le_to_utf8(const char16_t *wcs, int len)
-{
-	len = check_NULL_terminator(wcs, len);
-
-	// Attempt to convert the text from UTF-16LE to UTF-8.
-	string ret;
-	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)wcs, len*sizeof(*wcs), "UTF-16LE", "UTF-8"));
-	if (mbs) {
-		ret.assign(mbs);
-		free(mbs);
-	}
-	return ret;
-}
-
-/**
- * Convert UTF-16BE text to UTF-8.
- * Trailing NULL bytes will be removed.
- * @param wcs	[in] UTF-16BE text.
- * @param len	[in] Length of wcs, in characters. (-1 for NULL-terminated string)
- * @return UTF-8 string.
- */
-string utf16be_to_utf8(const char16_t *wcs, int len)
-{
-	len = check_NULL_terminator(wcs, len);
-
-	// Attempt to convert the text from UTF-16BE to UTF-8.
-	string ret;
-	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)wcs, len*sizeof(*wcs), "UTF-16BE", "UTF-8"));
-	if (mbs) {
-		ret.assign(mbs);
-		free(mbs);
-	}
-	return ret;
-}
-
 }
@@ -0,0 +1,105 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * TextFuncs_utf16.cpp: UTF-16 to UTF-8 conversion.                        *
+ *                                                                         *
+ * Copyright (c) 2009-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "TextFuncs.hpp"
+#include "TextFuncs_NULL.hpp"
+#include "TextFuncs_utf16_p.hpp"
+
+// C++ STL classes.
+using std::string;
+
+// UTF-16 to UTF-8 conversion is done natively instead of
+// using iconv() or WideCharToMultiByte(), since it's used
+// for nearly every string in some formats, e.g. Nintendo 3DS
+// SMDH titles and Xbox 360 XDBF strings.
+
+namespace LibRpBase {
+
+/**
+ * Convert UTF-16 text to UTF-8.
+ * Trailing NULL bytes will be removed.
+ * Unpaired surrogates are replaced with U+FFFD.
+ * @tparam swap If true, byteswap the code units.
+ * @param wcs	[in] UTF-16 text.
+ * @param len	[in] Length of wcs, in characters. (-1 for NULL-terminated string)
+ * @return UTF-8 string.
+ */
+template<bool swap>
+static string T_utf16_to_utf8(const char16_t *wcs, int len)
+{
+	assert(wcs != nullptr);
+	if (!wcs) {
+		return string();
+	}
+	len = check_NULL_terminator(wcs, len);
+	if (len <= 0) {
+		return string();
+	}
+
+	// Each UTF-16 code unit is at most 3 UTF-8 bytes.
+	// (Surrogate pairs are 4 UTF-8 bytes for two code units.)
+	string ret;
+	ret.resize(static_cast<size_t>(len) * 3);
+	char *const out = &ret[0];
+	const char16_t *const end = wcs + len;
+
+	char *out_end;
+#if defined(TEXTFUNCS_ALWAYS_HAS_SSE2)
+	out_end = (swap
+		? utf16be_to_utf8_sse2(out, wcs, end)
+		: utf16le_to_utf8_sse2(out, wcs, end));
+#elif defined(TEXTFUNCS_HAS_SSE2)
+	if (RP_CPU_HasSSE2()) {
+		out_end = (swap
+			? utf16be_to_utf8_sse2(out, wcs, end)
+			: utf16le_to_utf8_sse2(out, wcs, end));
+	} else {
+		out_end = utf16_to_utf8_cpp<swap>(out, wcs, end);
+	}
+#else
+	out_end = utf16_to_utf8_cpp<swap>(out, wcs, end);
+#endif
+
+	ret.resize(out_end - out);
+	return ret;
+}
+
+/**
+ * Convert UTF-16LE text to UTF-8.
+ * Trailing NULL bytes will be removed.
+ * @param wcs	[in] UTF-16LE text.
+ * @param len	[in] Length of wcs, in characters. (-1 for NULL-terminated string)
+ * @return UTF-8 string.
+ */
+string utf16le_to_utf8(const char16_t *wcs, int len)
+{
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+	return T_utf16_to_utf8<false>(wcs, len);
+#else /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
+	return T_utf16_to_utf8<true>(wcs, len);
+#endif
+}
+
+/**
+ * Convert UTF-16BE text to UTF-8.
+ * Trailing NULL bytes will be removed.
+ * @param wcs	[in] UTF-16BE text.
+ * @param len	[in] Length of wcs, in characters. (-1 for NULL-terminated string)
+ * @return UTF-8 string.
+ */
+string utf16be_to_utf8(const char16_t *wcs, int len)
+{
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+	return T_utf16_to_utf8<true>(wcs, len);
+#else /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
+	return T_utf16_to_utf8<false>(wcs, len);
+#endif
+}
+
+}
@@ -0,0 +1,141 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * TextFuncs_utf16_p.hpp: UTF-16 to UTF-8 conversion. (PRIVATE HEADER)     *
+ *                                                                         *
+ * Copyright (c) 2009-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_TEXTFUNCS_UTF16_P_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_TEXTFUNCS_UTF16_P_HPP__
+
+#include "common.h"
+#include "librpcpu/byteswap.h"
+#include "librpcpu/cpu_dispatch.h"
+
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# include "librpcpu/cpuflags_x86.h"
+# define TEXTFUNCS_HAS_SSE2 1
+#endif
+#ifdef RP_CPU_AMD64
+# define TEXTFUNCS_ALWAYS_HAS_SSE2 1
+#endif
+
+// C includes.
+#include <stdint.h>
+
+namespace LibRpBase {
+
+/**
+ * Get a UTF-16 code unit.
+ * @tparam swap If true, byteswap the code unit.
+ * @param wcs UTF-16 text.
+ * @return Host-endian code unit.
+ */
+template<bool swap>
+static FORCEINLINE uint16_t utf16_load(const char16_t *wcs)
+{
+	return (swap ? __swab16(static_cast<uint16_t>(*wcs)) : static_cast<uint16_t>(*wcs));
+}
+
+/**
+ * Encode a BMP code point that isn't a surrogate as UTF-8.
+ * @param out	[in/out] Output pointer. (Advanced past the encoded bytes.)
+ * @param c	[in] Code point.
+ */
+static FORCEINLINE void utf16_encode_bmp(char *&out, uint16_t c)
+{
+	if (c < 0x80) {
+		*out++ = static_cast<char>(c);
+	} else if (c < 0x800) {
+		*out++ = static_cast<char>(0xC0 | (c >> 6));
+		*out++ = static_cast<char>(0x80 | (c & 0x3F));
+	} else {
+		*out++ = static_cast<char>(0xE0 | (c >> 12));
+		*out++ = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+		*out++ = static_cast<char>(0x80 | (c & 0x3F));
+	}
+}
+
+/**
+ * Convert one UTF-16 character to UTF-8.
+ * Unpaired surrogates are replaced with U+FFFD.
+ * @tparam swap If true, byteswap the code units.
+ * @param out	[in/out] Output pointer. (Advanced past the encoded bytes.)
+ * @param wcs	[in] UTF-16 text.
+ * @param end	[in] End of the UTF-16 text.
+ * @return Pointer to the next UTF-16 character.
+ */
+template<bool swap>
+static FORCEINLINE const char16_t *utf16_to_utf8_one(char *&out, const char16_t *wcs, const char16_t *end)
+{
+	const uint16_t c = utf16_load<swap>(wcs++);
+	if ((c & 0xF800) != 0xD800) {
+		// Not a surrogate.
+		utf16_encode_bmp(out, c);
+		return wcs;
+	}
+
+	if (c < 0xDC00 && wcs < end) {
+		// High surrogate. Check for a low surrogate.
+		const uint16_t c2 = utf16_load<swap>(wcs);
+		if ((c2 & 0xFC00) == 0xDC00) {
+			const uint32_t cp = 0x10000 + (((c & 0x3FF) << 10) | (c2 & 0x3FF));
+			*out++ = static_cast<char>(0xF0 | (cp >> 18));
+			*out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+			*out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+			*out++ = static_cast<char>(0x80 | (cp & 0x3F));
+			return wcs + 1;
+		}
+	}
+
+	// Unpaired surrogate.
+	*out++ = static_cast<char>(0xEF);
+	*out++ = static_cast<char>(0xBF);
+	*out++ = static_cast<char>(0xBD);
+	return wcs;
+}
+
+/**
+ * Convert UTF-16 text to UTF-8.
+ * Standard version using regular C++ code.
+ * @tparam swap If true, byteswap the code units.
+ * @param out	[out] Output buffer. (Must have room for 3 bytes per code unit.)
+ * @param wcs	[in] UTF-16 text.
+ * @param end	[in] End of the UTF-16 text.
+ * @return Pointer to the end of the UTF-8 text.
+ */
+template<bool swap>
+static inline char *utf16_to_utf8_cpp(char *out, const char16_t *wcs, const char16_t *end)
+{
+	while (wcs < end) {
+		wcs = utf16_to_utf8_one<swap>(out, wcs, end);
+	}
+	return out;
+}
+
+#ifdef TEXTFUNCS_HAS_SSE2
+/**
+ * Convert little-endian UTF-16 text to UTF-8.
+ * SSE2-optimized version.
+ * @param out	[out] Output buffer. (Must have room for 3 bytes per code unit.)
+ * @param wcs	[in] UTF-16LE text.
+ * @param end	[in] End of the UTF-16LE text.
+ * @return Pointer to the end of the UTF-8 text.
+ */
+char *utf16le_to_utf8_sse2(char *out, const char16_t *wcs, const char16_t *end);
+
+/**
+ * Convert big-endian UTF-16 text to UTF-8.
+ * SSE2-optimized version.
+ * @param out	[out] Output buffer. (Must have room for 3 bytes per code unit.)
+ * @param wcs	[in] UTF-16BE text.
+ * @param end	[in] End of the UTF-16BE text.
+ * @return Pointer to the end of the UTF-8 text.
+ */
+char *utf16be_to_utf8_sse2(char *out, const char16_t *wcs, const char16_t *end);
+#endif /* TEXTFUNCS_HAS_SSE2 */
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_TEXTFUNCS_UTF16_P_HPP__ */
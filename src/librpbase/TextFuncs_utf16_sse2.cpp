@@ -0,0 +1,107 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * TextFuncs_utf16_sse2.cpp: UTF-16 to UTF-8 conversion.                   *
+ * SSE2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2009-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "TextFuncs_utf16_p.hpp"
+
+// SSE2 intrinsics.
+#include <emmintrin.h>
+
+namespace LibRpBase {
+
+/**
+ * Convert UTF-16 text to UTF-8.
+ * SSE2-optimized version.
+ *
+ * Blocks of 8 ASCII characters are packed directly.
+ * Blocks without surrogates are encoded without
+ * checking for surrogate pairs.
+ *
+ * @tparam swap If true, byteswap the code units.
+ * @param out	[out] Output buffer. (Must have room for 3 bytes per code unit.)
+ * @param wcs	[in] UTF-16 text.
+ * @param end	[in] End of the UTF-16 text.
+ * @return Pointer to the end of the UTF-8 text.
+ */
+template<bool swap>
+static inline char *T_utf16_to_utf8_sse2(char *out, const char16_t *wcs, const char16_t *end)
+{
+	const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+	const __m128i surrogateMask = _mm_set1_epi16(static_cast<int16_t>(0xF800));
+	const __m128i surrogateVal = _mm_set1_epi16(static_cast<int16_t>(0xD800));
+	const __m128i zero = _mm_setzero_si128();
+
+	while (end - wcs >= 8) {
+		__m128i xmm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wcs));
+		if (swap) {
+			xmm = _mm_or_si128(_mm_slli_epi16(xmm, 8), _mm_srli_epi16(xmm, 8));
+		}
+
+		const __m128i isAscii = _mm_cmpeq_epi16(_mm_and_si128(xmm, nonAsciiMask), zero);
+		if (_mm_movemask_epi8(isAscii) == 0xFFFF) {
+			// All ASCII. Pack to 8-bit.
+			// NOTE: The output buffer has room for 24 bytes here.
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(xmm, xmm));
+			out += 8;
+			wcs += 8;
+			continue;
+		}
+
+		const __m128i isSurrogate = _mm_cmpeq_epi16(_mm_and_si128(xmm, surrogateMask), surrogateVal);
+		if (_mm_movemask_epi8(isSurrogate) == 0) {
+			// BMP only. No surrogate pairs.
+			ALIGNED_VAR(16, uint16_t tmp[8]);
+			_mm_store_si128(reinterpret_cast<__m128i*>(tmp), xmm);
+			for (unsigned int i = 0; i < 8; i++) {
+				utf16_encode_bmp(out, tmp[i]);
+			}
+			wcs += 8;
+			continue;
+		}
+
+		// Surrogates. Use the standard conversion for this block.
+		// NOTE: A surrogate pair at the end of the block
+		// will consume one character from the next block.
+		const char16_t *const blk_end = wcs + 8;
+		do {
+			wcs = utf16_to_utf8_one<swap>(out, wcs, end);
+		} while (wcs < blk_end);
+	}
+
+	// Remaining characters.
+	return utf16_to_utf8_cpp<swap>(out, wcs, end);
+}
+
+/**
+ * Convert little-endian UTF-16 text to UTF-8.
+ * SSE2-optimized version.
+ * @param out	[out] Output buffer. (Must have room for 3 bytes per code unit.)
+ * @param wcs	[in] UTF-16LE text.
+ * @param end	[in] End of the UTF-16LE text.
+ * @return Pointer to the end of the UTF-8 text.
+ */
+char *utf16le_to_utf8_sse2(char *out, const char16_t *wcs, const char16_t *end)
+{
+	return T_utf16_to_utf8_sse2<false>(out, wcs, end);
+}
+
+/**
+ * Convert big-endian UTF-16 text to UTF-8.
+ * SSE2-optimized version.
+ * @param out	[out] Output buffer. (Must have room for 3 bytes per code unit.)
+ * @param wcs	[in] UTF-16BE text.
+ * @param end	[in] End of the UTF-16BE text.
+ * @return Pointer to the end of the UTF-8 text.
+ */
+char *utf16be_to_utf8_sse2(char *out, const char16_t *wcs, const char16_t *end)
+{
+	return T_utf16_to_utf8_sse2<true>(out, wcs, end);
+}
+
+}
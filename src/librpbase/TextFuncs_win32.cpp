@@ -286,55 +286,4 @@ string utf16_to_cpN(unsigned int cp, const char16_t *wcs, int len)
 	return ret;
 }
 
-/** Specialized UTF-16 conversion functions. **/
-
-/**
- * Convert UTF-16LE text to UTF-8.
- * Trailing NULL bytes will be removed.
- * @param wcs	[in] UTF-16LE text.
- * @param len	[in] Length of wcs, in characters. (-1 for NULL-terminated string)
- * @return UTF-8 string.
- */
-string utf16le_to_utf8(const char16_t *wcs, int len)
-{
-	// Wrapper around utf16_to_cpN().
-	return utf16_to_cpN(CP_UTF8, wcs, len);
-}
-
-/**
- * Convert UTF-16BE text to UTF-8.
- * Trailing NULL bytes will be removed.
- * @param wcs	[in] UTF-16BE text.
- * @param len	[in] Length of wcs, in characters. (-1 for NULL-terminated string)
- * @return UTF-8 string.
- */
-string utf16be_to_utf8(const char16_t *wcs, int len)
-{
-	if (!wcs || !*wcs || len == 0) {
-		// Empty string.
-		return string();
-	}
-
-	// NOTE: NULL characters are NOT truncated in the
-	// byteswap function. That's done in the regular
-	// utf16le_to_utf8() function.
-
-	// WideCharToMultiByte() doesn't support UTF-16BE.
-	// Byteswap the text first.
-	u16string bwcs = utf16_bswap(wcs, len);
-	if (bwcs.empty()) {
-		// Error byteswapping the string...
-		return string();
-	} else if (len > 0 && len != static_cast<int>(bwcs.size())) {
-		// Byteswapping failed.
-		// NOTE: Only checking if an explicit length
-		// is specified, since we don't want to
-		// call u16_strlen() here.
-		return string();
-	}
-
-	// Convert the byteswapped text.
-	return utf16_to_cpN(CP_UTF8, bwcs.data(), static_cast<int>(bwcs.size()));
-}
-
 }
@@ -16,10 +16,12 @@
 // C++ includes.
 #include <string>
 #include <ostream>
+#include <vector>
 
 namespace LibRpBase {
 
 class RomData;
+class RomFields;
 
 /**
  * Partially unescape a URL.
@@ -29,18 +31,84 @@ class RomData;
  */
 std::string urlPartialUnescape(const std::string &url);
 
+/**
+ * Output filter for ROMOutput and JSONROMOutput.
+ *
+ * If tabs or fields are specified, only matching fields are written,
+ * and deferred tabs that can't contain a match aren't loaded.
+ * Images aren't written if any filter is set.
+ */
+struct TextOutFilter {
+	std::vector<std::string> tabs;		// Tab names or indexes. (empty for all)
+	std::vector<std::string> fields;	// Field names. (empty for all)
+	bool metaDataOnly;			// Only write metadata properties.
+
+	TextOutFilter()
+		: metaDataOnly(false) { }
+
+	/**
+	 * Is any filter set?
+	 * @return True if any filter is set; false if everything is written.
+	 */
+	inline bool isSet(void) const {
+		return metaDataOnly || !tabs.empty() || !fields.empty();
+	}
+
+	/**
+	 * Get the ROM Fields object for the specified RomData object.
+	 * Deferred tabs after the last matching tab aren't loaded.
+	 * @param romdata RomData object
+	 * @return ROM Fields object, or nullptr if metaDataOnly is set.
+	 */
+	const RomFields *loadFields(const RomData *romdata) const;
+
+	/**
+	 * Does a tab match the tab filter?
+	 * @param fields RomFields
+	 * @param tabIdx Tab index
+	 * @return True if the tab matches; false if not.
+	 */
+	bool matchTab(const RomFields *fields, int tabIdx) const;
+
+	/**
+	 * Does a field match the filter?
+	 * @param fields RomFields
+	 * @param tabIdx Field's tab index
+	 * @param name Field name
+	 * @return True if the field matches; false if not.
+	 */
+	bool matchField(const RomFields *fields, int tabIdx, const std::string &name) const;
+};
+
 class ROMOutput {
 	const RomData *const romdata;
 	uint32_t lc;
+	const TextOutFilter *filter_;
 public:
 	explicit ROMOutput(const RomData *romdata, uint32_t lc = 0);
 	friend std::ostream& operator<<(std::ostream& os, const ROMOutput& fo);
+
+	/**
+	 * If set, only the data selected by the filter is written.
+	 * NOTE: The filter is not copied; it must remain valid
+	 * until the object has been written.
+	 */
+	inline const TextOutFilter *filter(void) const {
+		return filter_;
+	}
+
+	inline void setFilter(const TextOutFilter *filter) {
+		filter_ = filter;
+	}
 };
 
 class JSONROMOutput {
 	const RomData *const romdata;
 	uint32_t lc;
+	const char *path_;
+	const TextOutFilter *filter_;
 	bool crlf_;
+	bool compact_;
 public:
 	explicit JSONROMOutput(const RomData *romdata, uint32_t lc = 0);
 	friend std::ostream& operator<<(std::ostream& os, const JSONROMOutput& fo);
@@ -52,6 +120,44 @@ public:
 	inline void setCrlf(bool val) {
 		crlf_ = val;
 	}
+
+	/**
+	 * Compact output writes the entire object on a single line.
+	 * This is used for newline-delimited JSON. (NDJSON)
+	 */
+	inline bool compact(void) const {
+		return compact_;
+	}
+
+	inline void setCompact(bool val) {
+		compact_ = val;
+	}
+
+	/**
+	 * If set, the path is written as the first member of the object.
+	 * NOTE: The string is not copied; it must remain valid
+	 * until the object has been written.
+	 */
+	inline const char *path(void) const {
+		return path_;
+	}
+
+	inline void setPath(const char *path) {
+		path_ = path;
+	}
+
+	/**
+	 * If set, only the data selected by the filter is written.
+	 * NOTE: The filter is not copied; it must remain valid
+	 * until the object has been written.
+	 */
+	inline const TextOutFilter *filter(void) const {
+		return filter_;
+	}
+
+	inline void setFilter(const TextOutFilter *filter) {
+		filter_ = filter;
+	}
 };
 
 }
@@ -9,6 +9,8 @@
 
 #include "stdafx.h"
 #include "TextOut.hpp"
+#include "RomData.hpp"
+#include "RomFields.hpp"
 
 // C includes. (C++ namespace)
 #include "ctypex.h"
@@ -63,4 +65,89 @@ string urlPartialUnescape(const string &url)
 	return unesc_url;
 }
 
+/** TextOutFilter **/
+
+/**
+ * Get the ROM Fields object for the specified RomData object.
+ * Deferred tabs after the last matching tab aren't loaded.
+ * @param romdata RomData object
+ * @return ROM Fields object, or nullptr if metaDataOnly is set.
+ */
+const RomFields *TextOutFilter::loadFields(const RomData *romdata) const
+{
+	if (metaDataOnly) {
+		return nullptr;
+	} else if (tabs.empty()) {
+		// All tabs are needed, since any tab
+		// may have a matching field.
+		return romdata->fields();
+	}
+
+	const RomFields *const fields = romdata->fieldsDeferred();
+	if (!fields) {
+		return nullptr;
+	}
+
+	// Find the last matching tab.
+	// RomFields::loadTab() loads all earlier deferred tabs.
+	for (int i = fields->tabCount() - 1; i >= 0; i--) {
+		if (matchTab(fields, i)) {
+			fields->loadTab(i);
+			break;
+		}
+	}
+	return fields;
+}
+
+/**
+ * Does a tab match the tab filter?
+ * @param fields RomFields
+ * @param tabIdx Tab index
+ * @return True if the tab matches; false if not.
+ */
+bool TextOutFilter::matchTab(const RomFields *fields, int tabIdx) const
+{
+	if (tabs.empty()) {
+		return true;
+	}
+
+	const char *const tabName = fields->tabName(tabIdx);
+	for (const string &tab : tabs) {
+		// Tabs can be specified by index or by name.
+		if (!tab.empty() && ISDIGIT(tab[0])) {
+			char *endptr = nullptr;
+			const long idx = strtol(tab.c_str(), &endptr, 10);
+			if (*endptr == '\0' && idx == tabIdx) {
+				return true;
+			}
+		} else if (tabName && !strcasecmp(tab.c_str(), tabName)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Does a field match the filter?
+ * @param fields RomFields
+ * @param tabIdx Field's tab index
+ * @param name Field name
+ * @return True if the field matches; false if not.
+ */
+bool TextOutFilter::matchField(const RomFields *fields, int tabIdx, const string &name) const
+{
+	if (!matchTab(fields, tabIdx)) {
+		return false;
+	} else if (this->fields.empty()) {
+		return true;
+	}
+
+	for (const string &field : this->fields) {
+		if (!strcasecmp(field.c_str(), name.c_str())) {
+			return true;
+		}
+	}
+	return false;
+}
+
 }
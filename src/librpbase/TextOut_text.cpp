@@ -27,6 +27,7 @@ using std::vector;
 // librpbase
 #include "RomData.hpp"
 #include "RomFields.hpp"
+#include "RomMetaData.hpp"
 #include "TextFuncs.hpp"
 #include "img/IconAnimData.hpp"
 
@@ -170,8 +171,8 @@ public:
 		// NOTE: nullptr string is an empty string, not an error.
 		auto romField = field.romField;
 		os << ColonPad(field.width, romField.name.c_str());
-		if (romField.data.str) {
-			os << SafeString(romField.data.str, true, field.width);
+		if (romField.data.str.data) {
+			os << SafeString(romField.data.str.data, romField.data.str.size, true, field.width);
 		} else {
 			// Empty string.
 			os << "''";
@@ -651,14 +652,29 @@ public:
 class FieldsOutput {
 	const RomFields& fields;
 	uint32_t lc;
+	const TextOutFilter *filter;
 public:
-	explicit FieldsOutput(const RomFields& fields, uint32_t lc = 0)
-		: fields(fields), lc(lc) { }
+	explicit FieldsOutput(const RomFields& fields, uint32_t lc = 0, const TextOutFilter *filter = nullptr)
+		: fields(fields), lc(lc), filter(filter) { }
+
+	/**
+	 * Should a field be written?
+	 * @param romField Field
+	 * @return True if the field is valid and matches the filter.
+	 */
+	inline bool isWritable(const RomFields::Field &romField) const
+	{
+		return romField.isValid &&
+			(!filter || filter->matchField(&fields, romField.tabIdx, romField.name));
+	}
+
 	friend std::ostream& operator<<(std::ostream& os, const FieldsOutput& fo) {
 		size_t maxWidth = 0;
 		std::for_each(fo.fields.cbegin(), fo.fields.cend(),
-			[&maxWidth](const RomFields::Field &field) {
-				maxWidth = max(maxWidth, field.name.size());
+			[&fo, &maxWidth](const RomFields::Field &field) {
+				if (fo.isWritable(field)) {
+					maxWidth = max(maxWidth, field.name.size());
+				}
 			}
 		);
 		maxWidth += 2;
@@ -674,7 +690,7 @@ public:
 		const auto fields_cend = fo.fields.cend();
 		for (auto iter = fo.fields.cbegin(); iter != fields_cend; ++iter) {
 			const auto &romField = *iter;
-			if (!romField.isValid)
+			if (!fo.isWritable(romField))
 				continue;
 
 			if (printed_first)
@@ -682,8 +698,9 @@ public:
 
 			// New tab?
 			if (tabCount > 1 && tabIdx != romField.tabIdx) {
-				// Tab indexes must be consecutive.
-				assert(tabIdx + 1 == romField.tabIdx);
+				// Tab indexes must be consecutive,
+				// unless tabs were filtered out.
+				assert(fo.filter || tabIdx + 1 == romField.tabIdx);
 				tabIdx = romField.tabIdx;
 
 				// TODO: Better formatting?
@@ -739,7 +756,8 @@ public:
 
 ROMOutput::ROMOutput(const RomData *romdata, uint32_t lc)
 	: romdata(romdata)
-	, lc(lc) { }
+	, lc(lc)
+	, filter_(nullptr) { }
 std::ostream& operator<<(std::ostream& os, const ROMOutput& fo) {
 	auto romdata = fo.romdata;
 	const char *const systemName = romdata->systemName(RomData::SYSNAME_TYPE_LONG | RomData::SYSNAME_REGION_ROM_LOCAL);
@@ -750,6 +768,54 @@ std::ostream& operator<<(std::ostream& os, const ROMOutput& fo) {
 	os << "-- " << (systemName ? systemName : "(unknown system)") <<
 	      ' ' << (fileType ? fileType : "(unknown filetype)") <<
 	      " detected" << '\n';
+
+	const TextOutFilter *const filter = fo.filter_;
+	if (filter && filter->isSet()) {
+		if (filter->metaDataOnly) {
+			// Metadata properties.
+			const RomMetaData *const metaData = romdata->metaData();
+			const int count = (metaData ? metaData->count() : 0);
+			for (int i = 0; i < count; i++) {
+				const RomMetaData::MetaData *const prop = metaData->prop(i);
+				const char *const name = (prop ? RomMetaData::getPropertyName(prop->name) : nullptr);
+				if (!name)
+					continue;
+
+				os << name << ": ";
+				switch (prop->type) {
+					case PropertyType::Integer:
+						os << prop->data.ivalue;
+						break;
+					case PropertyType::UnsignedInteger:
+						os << prop->data.uvalue;
+						break;
+					case PropertyType::String:
+						if (prop->data.str) {
+							os << *(prop->data.str);
+						}
+						break;
+					case PropertyType::Timestamp:
+						os << static_cast<int64_t>(prop->data.timestamp);
+						break;
+					default:
+						assert(!"Unsupported PropertyType");
+						break;
+				}
+				os << '\n';
+			}
+		} else {
+			// Selected fields.
+			const RomFields *const fields = filter->loadFields(romdata);
+			if (fields) {
+				os << FieldsOutput(*fields, fo.lc, filter) << '\n';
+			}
+		}
+
+		// NOTE: Images aren't written if a filter is set.
+		os.flush();
+		return os;
+	}
+
 	const RomFields *const fields = romdata->fields();
 	assert(fields != nullptr);
 	if (fields) {
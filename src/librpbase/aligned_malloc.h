@@ -36,6 +36,10 @@
  *     power of two multiple of sizeof(void*).
  * - aligned_free(): Free aligned memory.
  *   - Required for MSVC and custom implementations.
+ *
+ * C++ code can also use aligned_malloc_tag(), which counts the
+ * allocation under a RpAllocStats tag if ENABLE_ALLOC_STATS is set.
+ * aligned_malloc() uses RpAllocStats::TAG_ALIGNED.
  */
 
 #include <errno.h>
@@ -54,12 +58,12 @@
 // MSVC _aligned_malloc()
 #include <malloc.h>
 
-static FORCEINLINE void *aligned_malloc(size_t alignment, size_t size)
+static FORCEINLINE void *aligned_malloc_int(size_t alignment, size_t size)
 {
 	return _aligned_malloc(size, alignment);
 }
 
-static FORCEINLINE void aligned_free(void *memptr)
+static FORCEINLINE void aligned_free_int(void *memptr)
 {
 	_aligned_free(memptr);
 }
@@ -69,12 +73,12 @@ static FORCEINLINE void aligned_free(void *memptr)
 // C11 aligned_alloc()
 #include <stdlib.h>
 
-static FORCEINLINE void *aligned_malloc(size_t alignment, size_t size)
+static FORCEINLINE void *aligned_malloc_int(size_t alignment, size_t size)
 {
 	return aligned_alloc(alignment, size);
 }
 
-static FORCEINLINE void aligned_free(void *memptr)
+static FORCEINLINE void aligned_free_int(void *memptr)
 {
 	free(memptr);
 }
@@ -84,7 +88,7 @@ static FORCEINLINE void aligned_free(void *memptr)
 // posix_memalign()
 #include <stdlib.h>
 
-static FORCEINLINE void *aligned_malloc(size_t alignment, size_t size)
+static FORCEINLINE void *aligned_malloc_int(size_t alignment, size_t size)
 {
 	void *ptr;
 	int ret = posix_memalign(&ptr, alignment, size);
@@ -96,7 +100,7 @@ static FORCEINLINE void *aligned_malloc(size_t alignment, size_t size)
 	return ptr;
 }
 
-static FORCEINLINE void aligned_free(void *memptr)
+static FORCEINLINE void aligned_free_int(void *memptr)
 {
 	free(memptr);
 }
@@ -106,12 +110,12 @@ static FORCEINLINE void aligned_free(void *memptr)
 // memalign()
 #include <malloc.h>
 
-static FORCEINLINE void *aligned_malloc(size_t alignment, size_t size)
+static FORCEINLINE void *aligned_malloc_int(size_t alignment, size_t size)
 {
 	return memalign(alignment, size);
 }
 
-static FORCEINLINE void aligned_free(void *memptr)
+static FORCEINLINE void aligned_free_int(void *memptr)
 {
 	free(memptr);
 }
@@ -120,6 +124,84 @@ static FORCEINLINE void aligned_free(void *memptr)
 # error Missing aligned malloc() function for this system.
 #endif
 
+#ifdef __cplusplus
+#include "librpfile/RpAllocStats.hpp"
+#endif /* __cplusplus */
+
+#if defined(ENABLE_ALLOC_STATS) && defined(__cplusplus)
+
+// Allocation statistics are enabled.
+// Each allocation has a header immediately before the returned
+// pointer with the size and tag, so aligned_free() can account
+// for it. The header area is one alignment unit.
+#include <stdint.h>
+
+typedef struct _aligned_malloc_hdr_t {
+	uint64_t size;
+	uint32_t tag;
+	uint32_t offset;	// Offset from the start of the allocation.
+} aligned_malloc_hdr_t;
+
+static inline void *aligned_malloc_tag(LibRpFile::RpAllocStats::Tag tag, size_t alignment, size_t size)
+{
+	static_assert(sizeof(aligned_malloc_hdr_t) == 16, "sizeof(aligned_malloc_hdr_t) != 16");
+	if (alignment < sizeof(aligned_malloc_hdr_t)) {
+		alignment = sizeof(aligned_malloc_hdr_t);
+	}
+
+	uint8_t *const base = static_cast<uint8_t*>(aligned_malloc_int(alignment, alignment + size));
+	if (!base) {
+		return NULL;
+	}
+
+	uint8_t *const ptr = base + alignment;
+	aligned_malloc_hdr_t *const hdr = reinterpret_cast<aligned_malloc_hdr_t*>(ptr) - 1;
+	hdr->size = size;
+	hdr->tag = static_cast<uint32_t>(tag);
+	hdr->offset = static_cast<uint32_t>(alignment);
+	LibRpFile::RpAllocStats::onAlloc(tag, size);
+	return ptr;
+}
+
+static inline void *aligned_malloc(size_t alignment, size_t size)
+{
+	return aligned_malloc_tag(LibRpFile::RpAllocStats::TAG_ALIGNED, alignment, size);
+}
+
+static inline void aligned_free(void *memptr)
+{
+	if (!memptr) {
+		return;
+	}
+
+	const aligned_malloc_hdr_t *const hdr = static_cast<const aligned_malloc_hdr_t*>(memptr) - 1;
+	LibRpFile::RpAllocStats::onFree(static_cast<LibRpFile::RpAllocStats::Tag>(hdr->tag),
+		static_cast<size_t>(hdr->size));
+	aligned_free_int(static_cast<uint8_t*>(memptr) - hdr->offset);
+}
+
+#else /* !(ENABLE_ALLOC_STATS && __cplusplus) */
+
+static FORCEINLINE void *aligned_malloc(size_t alignment, size_t size)
+{
+	return aligned_malloc_int(alignment, size);
+}
+
+static FORCEINLINE void aligned_free(void *memptr)
+{
+	aligned_free_int(memptr);
+}
+
+#ifdef __cplusplus
+static FORCEINLINE void *aligned_malloc_tag(LibRpFile::RpAllocStats::Tag tag, size_t alignment, size_t size)
+{
+	((void)tag);
+	return aligned_malloc_int(alignment, size);
+}
+#endif /* __cplusplus */
+
+#endif /* ENABLE_ALLOC_STATS && __cplusplus */
+
 #ifdef __cplusplus
 
 // std::unique_ptr<> wrapper for aligned_malloc().
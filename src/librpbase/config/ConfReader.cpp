@@ -9,6 +9,7 @@
 #include "stdafx.h"
 #include "ConfReader.hpp"
 #include "ConfReader_p.hpp"
+#include "ConfWatcher.hpp"
 
 // librpbase, librpfile, librpthreads
 #include "TextFuncs.hpp"
@@ -28,10 +29,13 @@ ConfReaderPrivate::ConfReaderPrivate(const char *filename)
 	, conf_was_found(false)
 	, conf_mtime(0)
 	, conf_last_checked(0)
+	, watcher(nullptr)
 { }
 
 ConfReaderPrivate::~ConfReaderPrivate()
-{ }
+{
+	delete watcher.load();
+}
 
 /**
  * Process a configuration line.
@@ -94,7 +98,18 @@ int ConfReader::load(bool force)
 {
 	RP_D(ConfReader);
 
-	if (!force && d->conf_was_found) {
+	// If the file is being watched, the OS will tell us
+	// if it was changed, so we don't have to check the
+	// timestamp. This doesn't make any system calls.
+	bool changed = false;
+	ConfWatcher *const watcher = d->watcher.load(std::memory_order_acquire);
+	if (!force && watcher && watcher->isWatching()) {
+		if (!watcher->checkChanged()) {
+			// File has not changed since it was last loaded.
+			return (d->conf_was_found ? 0 : -EIO);
+		}
+		changed = true;
+	} else if (!force && d->conf_was_found) {
 		// Have we checked the timestamp recently?
 		// TODO: Define the threshold somewhere.
 		const time_t cur_time = time(nullptr);
@@ -136,7 +151,7 @@ int ConfReader::load(bool force)
 			}
 			d->conf_filename += d->conf_rel_filename;
 		}
-	} else if (!force && d->conf_was_found) {
+	} else if (!force && !changed && d->conf_was_found) {
 		// Check if the keys.conf timestamp has changed.
 		// NOTE: Second check once the mutex is locked.
 		time_t mtime;
@@ -154,6 +169,15 @@ int ConfReader::load(bool force)
 		}
 	}
 
+	// Start watching the file for changes.
+	// NOTE: This must be done before the file is loaded
+	// in order to prevent changes from being missed, but
+	// the watcher isn't used until loading has finished.
+	std::unique_ptr<ConfWatcher> newWatcher;
+	if (!d->watcher.load(std::memory_order_relaxed) && !d->conf_filename.empty()) {
+		newWatcher.reset(new ConfWatcher(d->conf_filename));
+	}
+
 	// Reset the configuration to the default values.
 	d->reset();
 
@@ -183,6 +207,10 @@ int ConfReader::load(bool force)
 	if (ret != 0) {
 		// Error parsing the INI file.
 		d->reset();
+		d->loadFinished();
+		if (newWatcher) {
+			d->watcher.store(newWatcher.release(), std::memory_order_release);
+		}
 		if (ret == -2)
 			return -ENOMEM;
 		return -EIO;
@@ -202,6 +230,10 @@ int ConfReader::load(bool force)
 
 	// Keys loaded.
 	d->conf_was_found = true;
+	d->loadFinished();
+	if (newWatcher) {
+		d->watcher.store(newWatcher.release(), std::memory_order_release);
+	}
 	return 0;
 }
 
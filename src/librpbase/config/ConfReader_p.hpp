@@ -19,11 +19,13 @@
 #include "ini.h"
 
 // C++ includes.
+#include <atomic>
 #include <string>
 
 namespace LibRpBase {
 
 class ConfReader;
+class ConfWatcher;
 class ConfReaderPrivate
 {
 	public:
@@ -50,6 +52,12 @@ class ConfReaderPrivate
 		time_t conf_mtime;
 		time_t conf_last_checked;
 
+		// File change watcher.
+		// Created by load() once the filename is known.
+		// If the file is being watched, load() doesn't need
+		// to check the timestamp.
+		std::atomic<ConfWatcher*> watcher;
+
 	public:
 		/**
 		 * Reset the configuration to the default values.
@@ -80,6 +88,16 @@ class ConfReaderPrivate
 		 */
 		virtual int processConfigLine(const char *section,
 			const char *name, const char *value) = 0;
+
+		/**
+		 * Loading the configuration has finished.
+		 * Called by load() with mtxLoad locked, after all
+		 * configuration lines have been processed, or after
+		 * reset() if loading the configuration failed.
+		 *
+		 * The default implementation does nothing.
+		 */
+		virtual void loadFinished(void) { }
 };
 
 }
@@ -0,0 +1,67 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ConfWatcher.hpp: Configuration file change watcher.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_CONFIG_CONFWATCHER_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_CONFIG_CONFWATCHER_HPP__
+
+#include "common.h"
+
+// C++ includes.
+#include <string>
+
+namespace LibRpBase {
+
+class ConfWatcherPrivate;
+class ConfWatcher
+{
+	public:
+		/**
+		 * Watch a configuration file for changes.
+		 *
+		 * The file's directory is watched, since most editors
+		 * replace the file instead of writing to it directly.
+		 * The file doesn't have to exist yet.
+		 *
+		 * @param filename Configuration filename. (absolute path, UTF-8)
+		 */
+		explicit ConfWatcher(const std::string &filename);
+		~ConfWatcher();
+
+	private:
+		RP_DISABLE_COPY(ConfWatcher)
+	private:
+		friend class ConfWatcherPrivate;
+		ConfWatcherPrivate *const d_ptr;
+
+	public:
+		/**
+		 * Is the configuration file being watched?
+		 *
+		 * If this returns false, file change notifications are
+		 * not available, and the caller should check the file's
+		 * timestamp instead.
+		 *
+		 * @return True if the file is being watched; false if not.
+		 */
+		bool isWatching(void) const;
+
+		/**
+		 * Check if the configuration file may have changed
+		 * since the last time this function was called.
+		 *
+		 * On most systems, this does not make any system calls.
+		 * If the file isn't being watched, this always returns true.
+		 *
+		 * @return True if the file may have changed; false if not.
+		 */
+		bool checkChanged(void);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_CONFIG_CONFWATCHER_HPP__ */
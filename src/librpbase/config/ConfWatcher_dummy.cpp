@@ -0,0 +1,66 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ConfWatcher_dummy.cpp: Configuration file change watcher. (dummy)       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ConfWatcher.hpp"
+
+// C++ STL classes.
+using std::string;
+
+namespace LibRpBase {
+
+/**
+ * Watch a configuration file for changes.
+ *
+ * The file's directory is watched, since most editors
+ * replace the file instead of writing to it directly.
+ * The file doesn't have to exist yet.
+ *
+ * @param filename Configuration filename. (absolute path, UTF-8)
+ */
+ConfWatcher::ConfWatcher(const string &filename)
+	: d_ptr(nullptr)
+{
+	// Not supported on this OS.
+	RP_UNUSED(filename);
+}
+
+ConfWatcher::~ConfWatcher()
+{ }
+
+/**
+ * Is the configuration file being watched?
+ *
+ * If this returns false, file change notifications are
+ * not available, and the caller should check the file's
+ * timestamp instead.
+ *
+ * @return True if the file is being watched; false if not.
+ */
+bool ConfWatcher::isWatching(void) const
+{
+	// Not supported on this OS.
+	return false;
+}
+
+/**
+ * Check if the configuration file may have changed
+ * since the last time this function was called.
+ *
+ * On most systems, this does not make any system calls.
+ * If the file isn't being watched, this always returns true.
+ *
+ * @return True if the file may have changed; false if not.
+ */
+bool ConfWatcher::checkChanged(void)
+{
+	// Not supported on this OS.
+	return true;
+}
+
+}
@@ -0,0 +1,288 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ConfWatcher_inotify.cpp: Configuration file change watcher. (inotify)   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ConfWatcher.hpp"
+
+// C includes.
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+// C++ includes.
+#include <atomic>
+
+// C++ STL classes.
+using std::string;
+
+namespace LibRpBase {
+
+class ConfWatcherPrivate
+{
+	public:
+		explicit ConfWatcherPrivate(const string &filename);
+		~ConfWatcherPrivate();
+
+	private:
+		RP_DISABLE_COPY(ConfWatcherPrivate)
+
+	public:
+		// Filename to watch, without the directory.
+		string basename;
+
+		int inotify_fd;		// inotify file descriptor
+		int pipe_fd[2];		// Shutdown pipe (read, write)
+		pthread_t thread;	// Watcher thread
+		bool thread_started;
+
+		// Set by the watcher thread.
+		std::atomic<bool> watching;
+		std::atomic<bool> changed;
+
+		/**
+		 * Watcher thread entry point.
+		 * @param param ConfWatcherPrivate
+		 */
+		static void *watchThread(void *param);
+
+		/**
+		 * Process events from the inotify file descriptor.
+		 * @return True to continue watching; false to stop.
+		 */
+		bool processEvents(void);
+};
+
+/** ConfWatcherPrivate **/
+
+ConfWatcherPrivate::ConfWatcherPrivate(const string &filename)
+	: inotify_fd(-1)
+	, thread_started(false)
+	, watching(false)
+	, changed(false)
+{
+	pipe_fd[0] = -1;
+	pipe_fd[1] = -1;
+
+	// Split the filename into directory and basename.
+	const size_t slash_pos = filename.rfind('/');
+	if (slash_pos == string::npos || slash_pos == filename.size()-1) {
+		// Not an absolute filename.
+		return;
+	}
+	const string dirname = (slash_pos > 0 ? filename.substr(0, slash_pos) : string("/"));
+	basename = filename.substr(slash_pos + 1);
+
+	inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotify_fd < 0) {
+		// inotify isn't available.
+		return;
+	}
+
+	// Watch the directory.
+	// NOTE: The directory has to exist.
+	static const uint32_t mask = IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB |
+		IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+		IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+	if (inotify_add_watch(inotify_fd, dirname.c_str(), mask) < 0) {
+		// Unable to watch the directory.
+		close(inotify_fd);
+		inotify_fd = -1;
+		return;
+	}
+
+	// Shutdown pipe.
+	if (pipe2(pipe_fd, O_CLOEXEC) != 0) {
+		pipe_fd[0] = -1;
+		pipe_fd[1] = -1;
+		close(inotify_fd);
+		inotify_fd = -1;
+		return;
+	}
+
+	// Start the watcher thread.
+	// NOTE: The watch was set up before the thread was started,
+	// so changes made after this point won't be missed.
+	watching = true;
+	if (pthread_create(&thread, nullptr, watchThread, this) != 0) {
+		// Unable to start the thread.
+		watching = false;
+		return;
+	}
+	thread_started = true;
+}
+
+ConfWatcherPrivate::~ConfWatcherPrivate()
+{
+	if (thread_started) {
+		// Tell the watcher thread to exit.
+		const char c = 0;
+		ssize_t sz;
+		do {
+			sz = write(pipe_fd[1], &c, 1);
+		} while (sz < 0 && errno == EINTR);
+		pthread_join(thread, nullptr);
+	}
+
+	if (pipe_fd[0] >= 0) {
+		close(pipe_fd[0]);
+		close(pipe_fd[1]);
+	}
+	if (inotify_fd >= 0) {
+		close(inotify_fd);
+	}
+}
+
+/**
+ * Watcher thread entry point.
+ * @param param ConfWatcherPrivate
+ */
+void *ConfWatcherPrivate::watchThread(void *param)
+{
+	ConfWatcherPrivate *const d = static_cast<ConfWatcherPrivate*>(param);
+
+	struct pollfd fds[2];
+	fds[0].fd = d->inotify_fd;
+	fds[0].events = POLLIN;
+	fds[1].fd = d->pipe_fd[0];
+	fds[1].events = POLLIN;
+
+	while (true) {
+		fds[0].revents = 0;
+		fds[1].revents = 0;
+		const int ret = poll(fds, 2, -1);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			// poll() failed.
+			break;
+		}
+
+		if (fds[1].revents != 0) {
+			// Shutdown requested.
+			return nullptr;
+		}
+		if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			// Error on the inotify file descriptor.
+			break;
+		}
+		if ((fds[0].revents & POLLIN) && !d->processEvents()) {
+			// Directory is no longer being watched.
+			break;
+		}
+	}
+
+	// Can't watch the file anymore.
+	// The caller will have to check the timestamp.
+	d->watching.store(false, std::memory_order_release);
+	return nullptr;
+}
+
+/**
+ * Process events from the inotify file descriptor.
+ * @return True to continue watching; false to stop.
+ */
+bool ConfWatcherPrivate::processEvents(void)
+{
+	// NOTE: The buffer must be aligned for struct inotify_event.
+	union {
+		struct inotify_event ev;
+		char buf[4096];
+	} u;
+
+	while (true) {
+		const ssize_t len = read(inotify_fd, u.buf, sizeof(u.buf));
+		if (len < 0) {
+			// EAGAIN: No more events.
+			return (errno == EAGAIN || errno == EINTR);
+		} else if (len == 0) {
+			return true;
+		}
+
+		for (ssize_t i = 0; i < len; ) {
+			const struct inotify_event *const ev =
+				reinterpret_cast<const struct inotify_event*>(&u.buf[i]);
+			i += sizeof(*ev) + ev->len;
+
+			if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED | IN_UNMOUNT)) {
+				// The directory is gone.
+				changed.store(true, std::memory_order_release);
+				return false;
+			} else if (ev->mask & IN_Q_OVERFLOW) {
+				// Events were dropped.
+				changed.store(true, std::memory_order_release);
+			} else if (ev->len > 0 && basename == ev->name) {
+				// The configuration file was changed.
+				changed.store(true, std::memory_order_release);
+			}
+		}
+	}
+}
+
+/** ConfWatcher **/
+
+/**
+ * Watch a configuration file for changes.
+ *
+ * The file's directory is watched, since most editors
+ * replace the file instead of writing to it directly.
+ * The file doesn't have to exist yet.
+ *
+ * @param filename Configuration filename. (absolute path, UTF-8)
+ */
+ConfWatcher::ConfWatcher(const string &filename)
+	: d_ptr(new ConfWatcherPrivate(filename))
+{ }
+
+ConfWatcher::~ConfWatcher()
+{
+	delete d_ptr;
+}
+
+/**
+ * Is the configuration file being watched?
+ *
+ * If this returns false, file change notifications are
+ * not available, and the caller should check the file's
+ * timestamp instead.
+ *
+ * @return True if the file is being watched; false if not.
+ */
+bool ConfWatcher::isWatching(void) const
+{
+	RP_D(const ConfWatcher);
+	return d->watching.load(std::memory_order_acquire);
+}
+
+/**
+ * Check if the configuration file may have changed
+ * since the last time this function was called.
+ *
+ * On most systems, this does not make any system calls.
+ * If the file isn't being watched, this always returns true.
+ *
+ * @return True if the file may have changed; false if not.
+ */
+bool ConfWatcher::checkChanged(void)
+{
+	RP_D(ConfWatcher);
+	if (!d->watching.load(std::memory_order_acquire)) {
+		// Not watching. Assume the file has changed.
+		return true;
+	}
+
+	// Check the changed flag without clearing it first,
+	// since that's the common case.
+	if (!d->changed.load(std::memory_order_acquire)) {
+		return false;
+	}
+	return d->changed.exchange(false, std::memory_order_acq_rel);
+}
+
+}
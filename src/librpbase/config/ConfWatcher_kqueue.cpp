@@ -0,0 +1,302 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ConfWatcher_kqueue.cpp: Configuration file change watcher. (kqueue)     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ConfWatcher.hpp"
+
+// C includes.
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// C++ includes.
+#include <atomic>
+
+// C++ STL classes.
+using std::string;
+
+// O_EVTONLY is only available on macOS.
+// It prevents the watch from blocking unmounts.
+#ifndef O_EVTONLY
+# define O_EVTONLY O_RDONLY
+#endif
+
+namespace LibRpBase {
+
+class ConfWatcherPrivate
+{
+	public:
+		explicit ConfWatcherPrivate(const string &filename);
+		~ConfWatcherPrivate();
+
+	private:
+		RP_DISABLE_COPY(ConfWatcherPrivate)
+
+	public:
+		// Filename to watch.
+		string filename;
+
+		int kq;			// kqueue file descriptor
+		int dir_fd;		// Directory file descriptor
+		int file_fd;		// Configuration file descriptor (may be -1)
+		int pipe_fd[2];		// Shutdown pipe (read, write)
+		pthread_t thread;	// Watcher thread
+		bool thread_started;
+
+		// Set by the watcher thread.
+		std::atomic<bool> watching;
+		std::atomic<bool> changed;
+
+		/**
+		 * (Re-)open the configuration file and watch it.
+		 * The file might not exist yet.
+		 */
+		void watchFile(void);
+
+		/**
+		 * Watcher thread entry point.
+		 * @param param ConfWatcherPrivate
+		 */
+		static void *watchThread(void *param);
+};
+
+/** ConfWatcherPrivate **/
+
+ConfWatcherPrivate::ConfWatcherPrivate(const string &filename)
+	: filename(filename)
+	, kq(-1)
+	, dir_fd(-1)
+	, file_fd(-1)
+	, thread_started(false)
+	, watching(false)
+	, changed(false)
+{
+	pipe_fd[0] = -1;
+	pipe_fd[1] = -1;
+
+	// Get the directory name.
+	const size_t slash_pos = filename.rfind('/');
+	if (slash_pos == string::npos || slash_pos == filename.size()-1) {
+		// Not an absolute filename.
+		return;
+	}
+	const string dirname = (slash_pos > 0 ? filename.substr(0, slash_pos) : string("/"));
+
+	kq = kqueue();
+	if (kq < 0) {
+		// kqueue isn't available.
+		return;
+	}
+	fcntl(kq, F_SETFD, FD_CLOEXEC);
+
+	// Shutdown pipe.
+	if (pipe(pipe_fd) != 0) {
+		pipe_fd[0] = -1;
+		pipe_fd[1] = -1;
+		return;
+	}
+	fcntl(pipe_fd[0], F_SETFD, FD_CLOEXEC);
+	fcntl(pipe_fd[1], F_SETFD, FD_CLOEXEC);
+
+	// Watch the directory.
+	// NOTE: kqueue can't report which file in the directory
+	// was changed, so any change to the directory counts.
+	dir_fd = open(dirname.c_str(), O_EVTONLY | O_CLOEXEC);
+	if (dir_fd < 0) {
+		// Unable to open the directory.
+		return;
+	}
+
+	struct kevent kev[2];
+	EV_SET(&kev[0], dir_fd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+		NOTE_WRITE | NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE, 0, nullptr);
+	EV_SET(&kev[1], pipe_fd[0], EVFILT_READ, EV_ADD, 0, 0, nullptr);
+	if (kevent(kq, kev, 2, nullptr, 0, nullptr) != 0) {
+		// Unable to watch the directory.
+		return;
+	}
+
+	// Watch the file itself, if it exists.
+	watchFile();
+
+	// Start the watcher thread.
+	// NOTE: The watches were set up before the thread was started,
+	// so changes made after this point won't be missed.
+	watching = true;
+	if (pthread_create(&thread, nullptr, watchThread, this) != 0) {
+		// Unable to start the thread.
+		watching = false;
+		return;
+	}
+	thread_started = true;
+}
+
+ConfWatcherPrivate::~ConfWatcherPrivate()
+{
+	if (thread_started) {
+		// Tell the watcher thread to exit.
+		const char c = 0;
+		ssize_t sz;
+		do {
+			sz = write(pipe_fd[1], &c, 1);
+		} while (sz < 0 && errno == EINTR);
+		pthread_join(thread, nullptr);
+	}
+
+	if (file_fd >= 0) {
+		close(file_fd);
+	}
+	if (dir_fd >= 0) {
+		close(dir_fd);
+	}
+	if (pipe_fd[0] >= 0) {
+		close(pipe_fd[0]);
+		close(pipe_fd[1]);
+	}
+	if (kq >= 0) {
+		close(kq);
+	}
+}
+
+/**
+ * (Re-)open the configuration file and watch it.
+ * The file might not exist yet.
+ */
+void ConfWatcherPrivate::watchFile(void)
+{
+	if (file_fd >= 0) {
+		// Closing the file descriptor removes its kevents.
+		close(file_fd);
+	}
+
+	file_fd = open(filename.c_str(), O_EVTONLY | O_CLOEXEC);
+	if (file_fd < 0) {
+		// File doesn't exist yet.
+		return;
+	}
+
+	struct kevent kev;
+	EV_SET(&kev, file_fd, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+		NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE,
+		0, nullptr);
+	if (kevent(kq, &kev, 1, nullptr, 0, nullptr) != 0) {
+		close(file_fd);
+		file_fd = -1;
+	}
+}
+
+/**
+ * Watcher thread entry point.
+ * @param param ConfWatcherPrivate
+ */
+void *ConfWatcherPrivate::watchThread(void *param)
+{
+	ConfWatcherPrivate *const d = static_cast<ConfWatcherPrivate*>(param);
+
+	while (true) {
+		struct kevent kev;
+		const int ret = kevent(d->kq, nullptr, 0, &kev, 1, nullptr);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			// kevent() failed.
+			break;
+		} else if (ret == 0) {
+			continue;
+		}
+
+		if (kev.filter == EVFILT_READ) {
+			// Shutdown requested.
+			return nullptr;
+		}
+
+		d->changed.store(true, std::memory_order_release);
+		if (static_cast<int>(kev.ident) == d->dir_fd) {
+			if (kev.fflags & (NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE)) {
+				// The directory is gone.
+				break;
+			}
+			// A file in the directory was created, deleted, or renamed.
+			// The configuration file might have been replaced.
+			d->watchFile();
+		} else if (kev.fflags & (NOTE_DELETE | NOTE_RENAME | NOTE_REVOKE)) {
+			// The configuration file was deleted or replaced.
+			d->watchFile();
+		}
+	}
+
+	// Can't watch the file anymore.
+	// The caller will have to check the timestamp.
+	d->watching.store(false, std::memory_order_release);
+	return nullptr;
+}
+
+/** ConfWatcher **/
+
+/**
+ * Watch a configuration file for changes.
+ *
+ * The file's directory is watched, since most editors
+ * replace the file instead of writing to it directly.
+ * The file doesn't have to exist yet.
+ *
+ * @param filename Configuration filename. (absolute path, UTF-8)
+ */
+ConfWatcher::ConfWatcher(const string &filename)
+	: d_ptr(new ConfWatcherPrivate(filename))
+{ }
+
+ConfWatcher::~ConfWatcher()
+{
+	delete d_ptr;
+}
+
+/**
+ * Is the configuration file being watched?
+ *
+ * If this returns false, file change notifications are
+ * not available, and the caller should check the file's
+ * timestamp instead.
+ *
+ * @return True if the file is being watched; false if not.
+ */
+bool ConfWatcher::isWatching(void) const
+{
+	RP_D(const ConfWatcher);
+	return d->watching.load(std::memory_order_acquire);
+}
+
+/**
+ * Check if the configuration file may have changed
+ * since the last time this function was called.
+ *
+ * On most systems, this does not make any system calls.
+ * If the file isn't being watched, this always returns true.
+ *
+ * @return True if the file may have changed; false if not.
+ */
+bool ConfWatcher::checkChanged(void)
+{
+	RP_D(ConfWatcher);
+	if (!d->watching.load(std::memory_order_acquire)) {
+		// Not watching. Assume the file has changed.
+		return true;
+	}
+
+	// Check the changed flag without clearing it first,
+	// since that's the common case.
+	if (!d->changed.load(std::memory_order_acquire)) {
+		return false;
+	}
+	return d->changed.exchange(false, std::memory_order_acq_rel);
+}
+
+}
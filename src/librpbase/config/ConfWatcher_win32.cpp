@@ -0,0 +1,132 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ConfWatcher_win32.cpp: Configuration file change watcher. (Win32)       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ConfWatcher.hpp"
+#include "TextFuncs_wchar.hpp"
+
+// C++ STL classes.
+using std::string;
+
+namespace LibRpBase {
+
+class ConfWatcherPrivate
+{
+	public:
+		explicit ConfWatcherPrivate(const string &filename);
+		~ConfWatcherPrivate();
+
+	private:
+		RP_DISABLE_COPY(ConfWatcherPrivate)
+
+	public:
+		// Change notification handle.
+		// NOTE: A watcher thread isn't used on Windows, since
+		// the thread can't be stopped safely if the DLL is
+		// unloaded while the loader lock is held. Checking
+		// the handle doesn't access the file system, though.
+		HANDLE hChange;
+};
+
+/** ConfWatcherPrivate **/
+
+ConfWatcherPrivate::ConfWatcherPrivate(const string &filename)
+	: hChange(INVALID_HANDLE_VALUE)
+{
+	// Get the directory name.
+	const size_t slash_pos = filename.find_last_of("\\/");
+	if (slash_pos == string::npos || slash_pos == 0) {
+		// Not an absolute filename.
+		return;
+	}
+	const string dirname = filename.substr(0, slash_pos);
+
+	// Watch the directory.
+	// NOTE: Change notifications don't indicate which file
+	// was changed, so any change to the directory counts.
+	hChange = FindFirstChangeNotification(U82T_s(dirname), FALSE,
+		FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE);
+}
+
+ConfWatcherPrivate::~ConfWatcherPrivate()
+{
+	if (hChange != INVALID_HANDLE_VALUE) {
+		FindCloseChangeNotification(hChange);
+	}
+}
+
+/** ConfWatcher **/
+
+/**
+ * Watch a configuration file for changes.
+ *
+ * The file's directory is watched, since most editors
+ * replace the file instead of writing to it directly.
+ * The file doesn't have to exist yet.
+ *
+ * @param filename Configuration filename. (absolute path, UTF-8)
+ */
+ConfWatcher::ConfWatcher(const string &filename)
+	: d_ptr(new ConfWatcherPrivate(filename))
+{ }
+
+ConfWatcher::~ConfWatcher()
+{
+	delete d_ptr;
+}
+
+/**
+ * Is the configuration file being watched?
+ *
+ * If this returns false, file change notifications are
+ * not available, and the caller should check the file's
+ * timestamp instead.
+ *
+ * @return True if the file is being watched; false if not.
+ */
+bool ConfWatcher::isWatching(void) const
+{
+	RP_D(const ConfWatcher);
+	return (d->hChange != INVALID_HANDLE_VALUE);
+}
+
+/**
+ * Check if the configuration file may have changed
+ * since the last time this function was called.
+ *
+ * On most systems, this does not make any system calls.
+ * If the file isn't being watched, this always returns true.
+ *
+ * @return True if the file may have changed; false if not.
+ */
+bool ConfWatcher::checkChanged(void)
+{
+	RP_D(ConfWatcher);
+	if (d->hChange == INVALID_HANDLE_VALUE) {
+		// Not watching. Assume the file has changed.
+		return true;
+	}
+
+	// Check if the change notification was signalled.
+	// NOTE: This doesn't wait, and doesn't access the file system.
+	const DWORD dwRet = WaitForSingleObject(d->hChange, 0);
+	if (dwRet == WAIT_TIMEOUT) {
+		// No changes.
+		return false;
+	}
+
+	// Directory was changed. Wait for the next change.
+	if (dwRet != WAIT_OBJECT_0 || !FindNextChangeNotification(d->hChange)) {
+		// Error. Stop watching.
+		FindCloseChangeNotification(d->hChange);
+		d->hChange = INVALID_HANDLE_VALUE;
+	}
+	return true;
+}
+
+}
@@ -14,10 +14,14 @@
 
 // C++ STL classes.
 using std::string;
-using std::unordered_map;
+using std::unique_ptr;
 
 #include "RomData.hpp"
 
+// librpthreads
+#include "librpthreads/AtomicSnapshot.hpp"
+using LibRpThreads::AtomicSnapshot;
+
 namespace LibRpBase {
 
 class ConfigPrivate : public ConfReaderPrivate
@@ -54,6 +58,14 @@ class ConfigPrivate : public ConfReaderPrivate
 		int processConfigLine(const char *section,
 			const char *name, const char *value) final;
 
+		/**
+		 * Loading the configuration has finished.
+		 * Called by load() with mtxLoad locked, after all
+		 * configuration lines have been processed, or after
+		 * reset() if loading the configuration failed.
+		 */
+		void loadFinished(void) final;
+
 	public:
 		/**
 		 * Default image type priority.
@@ -62,32 +74,58 @@ class ConfigPrivate : public ConfReaderPrivate
 		 */
 		static const uint8_t defImgTypePrio[];
 
-		// Image type priority data.
-		// Managed as a single block in order to reduce
-		// memory allocations.
-		ao::uvector<uint8_t> vImgTypePrio;
-
 		/**
-		 * Map of RomData subclass names to vImgTypePrio indexes.
-		 * - Key: RomData subclass name.
-		 * - Value: vImgTypePrio information.
-		 *   - High byte: Data length.
-		 *   - Low 3 bytes: Data offset.
+		 * Configuration data.
+		 *
+		 * Configuration data is immutable once it's published,
+		 * so it can be read from multiple threads without locking.
+		 * A new ConfigData is created when the configuration is
+		 * reloaded. The constructor sets the default values.
 		 */
-		unordered_map<string, uint32_t> mapImgTypePrio;
-
-		// Download options.
-		bool extImgDownloadEnabled;
-		bool useIntIconForSmallSizes;
-		bool downloadHighResScans;
-		bool storeFileOriginInfo;
-
-		// DMG title screen mode. [index is ROM type]
-		Config::DMG_TitleScreen_Mode dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_MAX];
-
-		// Other options.
-		bool showDangerousPermissionsOverlayIcon;
-		bool enableThumbnailOnNetworkFS;
+		struct ConfigData {
+			ConfigData();
+
+			// Image type priority data.
+			// Managed as a single block in order to reduce
+			// memory allocations.
+			ao::uvector<uint8_t> vImgTypePrio;
+
+			/**
+			 * vImgTypePrio indexes for each RomData class.
+			 * - Index: RomDataClassId.
+			 * - Value: vImgTypePrio information. (0 if not set)
+			 *   - High byte: Data length.
+			 *   - Low 3 bytes: Data offset.
+			 */
+			uint32_t imgTypePrioIdx[static_cast<size_t>(RomDataClassId::Max)];
+
+			// Download options.
+			bool extImgDownloadEnabled;
+			bool useIntIconForSmallSizes;
+			bool downloadHighResScans;
+			bool storeFileOriginInfo;
+
+			// DMG title screen mode. [index is ROM type]
+			Config::DMG_TitleScreen_Mode dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_MAX];
+
+			// Other options.
+			bool showDangerousPermissionsOverlayIcon;
+			bool enableThumbnailOnNetworkFS;
+			bool gpuTextureDecode;
+
+			// True if no configuration lines were processed.
+			bool isDefault;
+		};
+
+		// Configuration data being loaded by load(). (protected by mtxLoad)
+		unique_ptr<ConfigData> loadingData;
+
+		// Current configuration data.
+		// This is replaced when rom-properties.conf is reloaded.
+		// NOTE: Old configuration data isn't deleted until Config
+		// is destroyed, since callers may still have pointers to
+		// the image type priority data.
+		AtomicSnapshot<ConfigData> data;
 };
 
 /** ConfigPrivate **/
@@ -117,8 +155,18 @@ const uint8_t ConfigPrivate::defImgTypePrio[] = {
 
 ConfigPrivate::ConfigPrivate()
 	: super("rom-properties.conf")
+{
+	// Publish the default configuration so there's
+	// always configuration data, even before load().
+	data.publish(new ConfigData);
+}
+
+/**
+ * Create configuration data with the default values.
+ */
+ConfigPrivate::ConfigData::ConfigData()
 	/* Download options */
-	, extImgDownloadEnabled(true)
+	: extImgDownloadEnabled(true)
 	, useIntIconForSmallSizes(true)
 	, downloadHighResScans(true)
 	, storeFileOriginInfo(true)
@@ -126,9 +174,16 @@ ConfigPrivate::ConfigPrivate()
 	, showDangerousPermissionsOverlayIcon(true)
 	/* Enable thumbnailing and metadata on network FS */
 	, enableThumbnailOnNetworkFS(false)
+	/* Decode large textures on the GPU */
+	, gpuTextureDecode(false)
+	, isDefault(true)
 {
-	// NOTE: Configuration is also initialized in the reset() function.
-	memset(dmgTSMode, 0, sizeof(dmgTSMode));
+	memset(imgTypePrioIdx, 0, sizeof(imgTypePrioIdx));
+
+	// DMG title screen mode.
+	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_DMG] = Config::DMG_TitleScreen_Mode::DMG_TS_DMG;
+	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_SGB] = Config::DMG_TitleScreen_Mode::DMG_TS_SGB;
+	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_CGB] = Config::DMG_TitleScreen_Mode::DMG_TS_CGB;
 }
 
 /**
@@ -136,32 +191,38 @@ ConfigPrivate::ConfigPrivate()
  */
 void ConfigPrivate::reset(void)
 {
-	// Clear the image type priorities vector and map.
-	vImgTypePrio.clear();
-	mapImgTypePrio.clear();
+	// Start new configuration data.
+	// NOTE: The current configuration data remains
+	// published until loading has finished.
+	loadingData.reset(new ConfigData);
 
 	// Reserve 1 KB for the image type priorities store.
-	vImgTypePrio.reserve(1024);
-#ifdef HAVE_UNORDERED_MAP_RESERVE
-	// Reserve 16 entries for the map.
-	mapImgTypePrio.reserve(16);
-#endif
-
-	// Download options
-	extImgDownloadEnabled = true;
-	useIntIconForSmallSizes = true;
-	downloadHighResScans = true;
-	storeFileOriginInfo = true;
+	loadingData->vImgTypePrio.reserve(1024);
+}
 
-	// DMG title screen mode.
-	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_DMG] = Config::DMG_TitleScreen_Mode::DMG_TS_DMG;
-	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_SGB] = Config::DMG_TitleScreen_Mode::DMG_TS_SGB;
-	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_CGB] = Config::DMG_TitleScreen_Mode::DMG_TS_CGB;
+/**
+ * Loading the configuration has finished.
+ * Called by load() with mtxLoad locked, after all
+ * configuration lines have been processed, or after
+ * reset() if loading the configuration failed.
+ */
+void ConfigPrivate::loadFinished(void)
+{
+	if (!loadingData) {
+		// reset() wasn't called...
+		loadingData.reset(new ConfigData);
+	}
+
+	// If rom-properties.conf is missing, it will be reloaded every time.
+	// Don't replace the default configuration with another default configuration.
+	const ConfigData *const curData = data.get();
+	if (curData && curData->isDefault && loadingData->isDefault) {
+		loadingData.reset();
+		return;
+	}
 
-	// Overlay icon
-	showDangerousPermissionsOverlayIcon = true;
-	// Enable thumbnail and metadata on network FS
-	enableThumbnailOnNetworkFS = false;
+	// Publish the new configuration data.
+	data.publish(loadingData.release());
 }
 
 /**
@@ -186,18 +247,26 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 		return 1;
 	}
 
+	ConfigData *const cfg = loadingData.get();
+	assert(cfg != nullptr);
+	if (!cfg) {
+		// reset() wasn't called...
+		return 1;
+	}
+	cfg->isDefault = false;
+
 	// Which section are we in?
 	if (!strcasecmp(section, "Downloads")) {
 		// Downloads. Check for one of the three boolean options.
 		bool *param;
 		if (!strcasecmp(name, "ExtImageDownload")) {
-			param = &extImgDownloadEnabled;
+			param = &cfg->extImgDownloadEnabled;
 		} else if (!strcasecmp(name, "UseIntIconForSmallSizes")) {
-			param = &useIntIconForSmallSizes;
+			param = &cfg->useIntIconForSmallSizes;
 		} else if (!strcasecmp(name, "DownloadHighResScans")) {
-			param = &downloadHighResScans;
+			param = &cfg->downloadHighResScans;
 		} else if (!strcasecmp(name, "StoreFileOriginInfo")) {
-			param = &storeFileOriginInfo;
+			param = &cfg->storeFileOriginInfo;
 		} else {
 			// Invalid option.
 			return 1;
@@ -240,14 +309,16 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 			return 1;
 		}
 
-		dmgTSMode[dmg_key] = dmg_value;
+		cfg->dmgTSMode[dmg_key] = dmg_value;
 	} else if (!strcasecmp(section, "Options")) {
 		// Options.
 		bool *param;
 		if (!strcasecmp(name, "ShowDangerousPermissionsOverlayIcon")) {
-			param = &showDangerousPermissionsOverlayIcon;
+			param = &cfg->showDangerousPermissionsOverlayIcon;
 		} else if (!strcasecmp(name, "EnableThumbnailOnNetworkFS")) {
-			param = &enableThumbnailOnNetworkFS;
+			param = &cfg->enableThumbnailOnNetworkFS;
+		} else if (!strcasecmp(name, "GpuTextureDecode")) {
+			param = &cfg->gpuTextureDecode;
 		} else {
 			// Invalid option.
 			return 1;
@@ -263,9 +334,16 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 			// TODO: Show a warning or something?
 		}
 	} else if (!strcasecmp(section, "ImageTypes")) {
-		// NOTE: Duplicates will overwrite previous entries in the map,
+		// NOTE: Duplicates will overwrite previous entries in the index,
 		// though all of the data will remain in the vector.
 
+		// Look up the class ID.
+		// Unknown class names are ignored, since nothing can use them.
+		const RomDataClassId classId = RomData::lookupClassId(name);
+		if (classId == RomDataClassId::Unknown) {
+			return 1;
+		}
+
 		// inih automatically trims spaces from the
 		// start and end of the string.
 
@@ -279,6 +357,7 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 		}
 
 		// Parse the comma-separated values.
+		ao::uvector<uint8_t> &vImgTypePrio = cfg->vImgTypePrio;
 		const size_t vStartPos = vImgTypePrio.size();
 		unsigned int count = 0;	// Number of image types.
 		uint32_t imgbf = 0;	// Image type bitfield to prevent duplicates.
@@ -396,15 +475,10 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 		}
 
 		if (count > 0) {
-			// Convert the class name to lowercase.
-			string className(name);
-			std::transform(className.begin(), className.end(), className.begin(),
-				[](unsigned char c) { return std::tolower(c); });
-
-			// Add the class name information to the map.
+			// Add the class information to the index.
 			uint32_t keyIdx = static_cast<uint32_t>(vStartPos);
 			keyIdx |= (count << 24);
-			mapImgTypePrio.insert(std::make_pair(className, keyIdx));
+			cfg->imgTypePrioIdx[static_cast<size_t>(classId)] = keyIdx;
 		}
 	}
 
@@ -448,46 +522,60 @@ Config *Config::instance(void)
 Config::ImgTypeResult Config::getImgTypePrio(const char *className, ImgTypePrio_t *imgTypePrio) const
 {
 	assert(className != nullptr);
+	if (!className) {
+		return IMGTR_ERR_INVALID_PARAMS;
+	}
+	return getImgTypePrio(RomData::lookupClassId(className), imgTypePrio);
+}
+
+/**
+ * Get the image type priority data for the specified class ID.
+ * NOTE: Call load() before using this function.
+ * @param classId	[in] Class ID.
+ * @param imgTypePrio	[out] Image type priority data.
+ * @return ImgTypeResult
+ */
+Config::ImgTypeResult Config::getImgTypePrio(RomDataClassId classId, ImgTypePrio_t *imgTypePrio) const
+{
 	assert(imgTypePrio != nullptr);
-	if (!className || !imgTypePrio) {
+	assert(classId < RomDataClassId::Max);
+	if (!imgTypePrio || classId >= RomDataClassId::Max) {
 		return IMGTR_ERR_INVALID_PARAMS;
 	}
 
-	// Find the class name in the map.
+	// Check the class ID's index entry.
 	RP_D(const Config);
-	string className_lower(className);
-	std::transform(className_lower.begin(), className_lower.end(), className_lower.begin(), ::tolower);
-	auto iter = d->mapImgTypePrio.find(className_lower);
-	if (iter == d->mapImgTypePrio.end()) {
-		// Class name not found.
+	const ConfigPrivate::ConfigData *const cfg = d->data.get();
+	const uint32_t keyIdx = cfg->imgTypePrioIdx[static_cast<size_t>(classId)];
+	if (keyIdx == 0) {
+		// No custom configuration for this class.
 		// Use the global defaults.
 		imgTypePrio->imgTypes = d->defImgTypePrio;
 		imgTypePrio->length = ARRAY_SIZE(d->defImgTypePrio);
 		return IMGTR_SUCCESS_DEFAULTS;
 	}
 
-	// Class name found.
+	// Class found.
 	// Check its entry.
-	const uint32_t keyIdx = iter->second;
 	const uint32_t idx = (keyIdx & 0xFFFFFF);
 	const uint8_t len = ((keyIdx >> 24) & 0xFF);
 	assert(len > 0);
-	assert(idx < d->vImgTypePrio.size());
-	assert(idx + len <= d->vImgTypePrio.size());
-	if (len == 0 || idx >= d->vImgTypePrio.size() || idx + len > d->vImgTypePrio.size()) {
+	assert(idx < cfg->vImgTypePrio.size());
+	assert(idx + len <= cfg->vImgTypePrio.size());
+	if (len == 0 || idx >= cfg->vImgTypePrio.size() || idx + len > cfg->vImgTypePrio.size()) {
 		// Entry is invalid...
 		// TODO: Force a configuration reload?
 		return IMGTR_ERR_MAP_CORRUPTED;
 	}
 
 	// Is the first entry RomData::IMG_DISABLED?
-	if (d->vImgTypePrio[idx] == static_cast<uint8_t>(RomData::IMG_DISABLED)) {
+	if (cfg->vImgTypePrio[idx] == static_cast<uint8_t>(RomData::IMG_DISABLED)) {
 		// Thumbnails are disabled for this class.
 		return IMGTR_DISABLED;
 	}
 
 	// Return the starting address and length.
-	imgTypePrio->imgTypes = &d->vImgTypePrio[idx];
+	imgTypePrio->imgTypes = &cfg->vImgTypePrio[idx];
 	imgTypePrio->length = len;
 	return IMGTR_SUCCESS;
 }
@@ -518,7 +606,7 @@ void Config::getDefImgTypePrio(ImgTypePrio_t *imgTypePrio) const
 bool Config::extImgDownloadEnabled(void) const
 {
 	RP_D(const Config);
-	return d->extImgDownloadEnabled;
+	return d->data.get()->extImgDownloadEnabled;
 }
 
 /**
@@ -530,7 +618,7 @@ bool Config::extImgDownloadEnabled(void) const
 bool Config::useIntIconForSmallSizes(void) const
 {
 	RP_D(const Config);
-	return d->useIntIconForSmallSizes;
+	return d->data.get()->useIntIconForSmallSizes;
 }
 
 /**
@@ -541,7 +629,7 @@ bool Config::useIntIconForSmallSizes(void) const
 bool Config::downloadHighResScans(void) const
 {
 	RP_D(const Config);
-	return d->downloadHighResScans;
+	return d->data.get()->downloadHighResScans;
 }
 
 /**
@@ -552,7 +640,7 @@ bool Config::downloadHighResScans(void) const
 bool Config::storeFileOriginInfo(void) const
 {
 	RP_D(const Config);
-	return d->storeFileOriginInfo;
+	return d->data.get()->storeFileOriginInfo;
 }
 
 /** DMG title screen mode **/
@@ -574,7 +662,7 @@ Config::DMG_TitleScreen_Mode Config::dmgTitleScreenMode(DMG_TitleScreen_Mode rom
 	}
 
 	RP_D(const Config);
-	return d->dmgTSMode[romType];
+	return d->data.get()->dmgTSMode[romType];
 }
 
 /** Other options **/
@@ -587,7 +675,7 @@ Config::DMG_TitleScreen_Mode Config::dmgTitleScreenMode(DMG_TitleScreen_Mode rom
 bool Config::showDangerousPermissionsOverlayIcon(void) const
 {
 	RP_D(const Config);
-	return d->showDangerousPermissionsOverlayIcon;
+	return d->data.get()->showDangerousPermissionsOverlayIcon;
 }
 
 /**
@@ -598,7 +686,18 @@ bool Config::showDangerousPermissionsOverlayIcon(void) const
 bool Config::enableThumbnailOnNetworkFS(void) const
 {
 	RP_D(const Config);
-	return d->enableThumbnailOnNetworkFS;
+	return d->data.get()->enableThumbnailOnNetworkFS;
+}
+
+/**
+ * Decode large block-compressed textures on the GPU?
+ * NOTE: Call load() before using this function.
+ * @return True if we should use the GPU; false if not.
+ */
+bool Config::gpuTextureDecode(void) const
+{
+	RP_D(const Config);
+	return d->data.get()->gpuTextureDecode;
 }
 
 }
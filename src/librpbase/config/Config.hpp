@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBRPBASE_CONFIG_CONFIG_HPP__
 
 #include "ConfReader.hpp"
+#include "../RomDataClassId.hpp"
 
 // C includes.
 #include <stdint.h>
@@ -76,6 +77,15 @@ class Config : public ConfReader
 		 */
 		ImgTypeResult getImgTypePrio(const char *className, ImgTypePrio_t *imgTypePrio) const;
 
+		/**
+		 * Get the image type priority data for the specified class ID.
+		 * NOTE: Call load() before using this function.
+		 * @param classId	[in] Class ID.
+		 * @param imgTypePrio	[out] Image type priority data.
+		 * @return ImgTypeResult
+		 */
+		ImgTypeResult getImgTypePrio(RomDataClassId classId, ImgTypePrio_t *imgTypePrio) const;
+
 		/**
 		 * Get the default image type priority data.
 		 * This is the priority data used if a custom configuration
@@ -147,6 +157,13 @@ class Config : public ConfReader
 		 * @return True if we should enable; false if not.
 		 */
 		bool enableThumbnailOnNetworkFS(void) const;
+
+		/**
+		 * Decode large block-compressed textures on the GPU?
+		 * NOTE: Call load() before using this function.
+		 * @return True if we should use the GPU; false if not.
+		 */
+		bool gpuTextureDecode(void) const;
 };
 
 }
@@ -13,6 +13,10 @@
 #include "libwin32common/RpWin32_sdk.h"
 #include "libwin32common/w32err.h"
 
+// librpfile
+#include "librpfile/RpStats.hpp"
+using namespace LibRpFile;
+
 // References:
 // - http://www.codeproject.com/Tips/787096/Operation-Password-CryptoAPI-with-AES
 //   [Google: "CryptoAPI decrypting AES example" (no quotes)]
@@ -398,7 +402,10 @@ size_t AesCAPI::decrypt(uint8_t *RESTRICT pData, size_t size)
 		CryptDestroyKey(hMyKey);
 	}
 
-	return (bRet ? dwLen : 0);
+	if (!bRet)
+		return 0;
+	RpStats::add(RpStats::AES_BYTES_DECRYPTED, dwLen);
+	return dwLen;
 }
 
 }
@@ -15,6 +15,10 @@
 // librpthreads
 #include "librpthreads/Atomics.h"
 
+// librpfile
+#include "librpfile/RpStats.hpp"
+using namespace LibRpFile;
+
 // References:
 // - https://msdn.microsoft.com/en-us/library/windows/desktop/aa376234%28v=vs.85%29.aspx?f=255&MSPPError=-2147217396
 #include <bcrypt.h>
@@ -576,7 +580,10 @@ size_t AesCAPI_NG::decrypt(uint8_t *RESTRICT pData, size_t size)
 			return 0;
 	}
 	
-	return (NT_SUCCESS(status) ? cbResult : 0);
+	if (!NT_SUCCESS(status))
+		return 0;
+	RpStats::add(RpStats::AES_BYTES_DECRYPTED, cbResult);
+	return cbResult;
 }
 
 }
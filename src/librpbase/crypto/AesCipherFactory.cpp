@@ -2,7 +2,7 @@
  * ROM Properties Page shell extension. (librpbase)                        *
  * AesCipherFactory.cpp: IAesCipher factory class.                         *
  *                                                                         *
- * Copyright (c) 2016-2019 by David Korth.                                 *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
  * SPDX-License-Identifier: GPL-2.0-or-later                               *
  ***************************************************************************/
 
@@ -12,6 +12,7 @@
 #include "AesCipherFactory.hpp"
 
 // IAesCipher implementations.
+#include "AesNI.hpp"
 #if defined(_WIN32)
 # include "AesCAPI.hpp"
 # include "AesCAPI_NG.hpp"
@@ -32,6 +33,14 @@ namespace LibRpBase {
  */
 IAesCipher *AesCipherFactory::create(void)
 {
+#ifdef AESCIPHER_HAS_AESNI
+	// Use AES-NI if the CPU supports it.
+	// This is significantly faster than the OS implementations.
+	if (AesNI::isUsable()) {
+		return new AesNI();
+	}
+#endif /* AESCIPHER_HAS_AESNI */
+
 #if defined(_WIN32)
 	// Windows: Use CryptoAPI NG if available.
 	// If not, fall back to CryptoAPI.
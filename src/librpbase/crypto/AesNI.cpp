@@ -0,0 +1,538 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * AesNI.cpp: AES decryption class using Intel AES-NI instructions.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "AesNI.hpp"
+
+#ifndef AESCIPHER_HAS_AESNI
+# error Do not compile AesNI.cpp on non-x86 CPUs!
+#endif
+
+// librpcpu
+#include "librpcpu/byteswap.h"
+#include "librpcpu/cpuflags_x86.h"
+
+// librpfile
+#include "librpfile/RpStats.hpp"
+using namespace LibRpFile;
+
+// AES-NI intrinsics.
+#include <wmmintrin.h>
+#include <emmintrin.h>
+
+namespace LibRpBase {
+
+class AesNIPrivate
+{
+	public:
+		AesNIPrivate();
+		~AesNIPrivate() { }
+
+	private:
+		RP_DISABLE_COPY(AesNIPrivate)
+
+	public:
+		static const unsigned int AES_BLOCK_SIZE = 16;
+
+		// Maximum number of rounds. (AES-256)
+		static const unsigned int MAX_ROUNDS = 14;
+
+		// Number of blocks to process in parallel.
+		// AES-NI instructions have a latency of several cycles,
+		// but a throughput of one per cycle, so interleaving
+		// independent blocks keeps the AES unit busy.
+		static const unsigned int PIPELINE_BLOCKS = 4;
+
+		// Round keys.
+		// NOTE: Stored as bytes, since operator new doesn't
+		// guarantee 16-byte alignment on all platforms.
+		// The kernels load these into aligned local arrays.
+		uint8_t rk_enc[(MAX_ROUNDS + 1) * AES_BLOCK_SIZE];
+		uint8_t rk_dec[(MAX_ROUNDS + 1) * AES_BLOCK_SIZE];
+		unsigned int rounds;	// 0 if no key is set.
+
+		// CBC: Initialization vector.
+		// CTR: Counter.
+		uint8_t iv[AES_BLOCK_SIZE];
+
+		IAesCipher::ChainingMode chainingMode;
+
+	public:
+		/**
+		 * Expand the encryption key into the round keys.
+		 * @param pKey	[in] Key data.
+		 * @param size	[in] Size of pKey, in bytes. (16, 24, or 32)
+		 */
+		void expandKey(const uint8_t *RESTRICT pKey, size_t size);
+
+		/**
+		 * Load round keys into an aligned array.
+		 * @param rk	[out] Round keys.
+		 * @param src	[in] Source round keys.
+		 */
+		inline void loadRoundKeys(__m128i *rk, const uint8_t *src) const
+		{
+			for (unsigned int i = 0; i <= rounds; i++) {
+				rk[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i * AES_BLOCK_SIZE]));
+			}
+		}
+
+		/**
+		 * Decrypt data using ECB.
+		 * @param pData	[in/out] Data.
+		 * @param size	[in] Size of data. (multiple of 16)
+		 */
+		void decryptECB(uint8_t *RESTRICT pData, size_t size);
+
+		/**
+		 * Decrypt data using CBC.
+		 * The IV is updated for the next call.
+		 * @param pData	[in/out] Data.
+		 * @param size	[in] Size of data. (multiple of 16)
+		 */
+		void decryptCBC(uint8_t *RESTRICT pData, size_t size);
+
+		/**
+		 * Decrypt data using CTR.
+		 * The counter is updated for the next call.
+		 * @param pData	[in/out] Data.
+		 * @param size	[in] Size of data. (multiple of 16)
+		 */
+		void decryptCTR(uint8_t *RESTRICT pData, size_t size);
+};
+
+/** AesNIPrivate **/
+
+AesNIPrivate::AesNIPrivate()
+	: rounds(0)
+	, chainingMode(IAesCipher::ChainingMode::ECB)
+{
+	// Clear the keys.
+	memset(rk_enc, 0, sizeof(rk_enc));
+	memset(rk_dec, 0, sizeof(rk_dec));
+	memset(iv, 0, sizeof(iv));
+}
+
+/**
+ * Apply the AES S-box to a key schedule word.
+ * @param w	[in] Key schedule word. (little-endian)
+ * @param rot	[in] If true, also apply RotWord().
+ * @return SubWord(w), or SubWord(RotWord(w)) if rot is true.
+ */
+static inline uint32_t aesni_subword(uint32_t w, bool rot)
+{
+	// AESKEYGENASSIST operates on dwords 1 and 3.
+	// Broadcast the word to all lanes, then pick either
+	// dword 0 (SubWord) or dword 1 (RotWord(SubWord), with Rcon == 0).
+	__m128i x = _mm_shuffle_epi32(_mm_cvtsi32_si128(static_cast<int>(w)), 0x00);
+	x = _mm_aeskeygenassist_si128(x, 0);
+	if (rot) {
+		x = _mm_shuffle_epi32(x, 0x55);
+	}
+	return static_cast<uint32_t>(_mm_cvtsi128_si32(x));
+}
+
+/**
+ * Expand the encryption key into the round keys.
+ * @param pKey	[in] Key data.
+ * @param size	[in] Size of pKey, in bytes. (16, 24, or 32)
+ */
+void AesNIPrivate::expandKey(const uint8_t *RESTRICT pKey, size_t size)
+{
+	static const uint8_t rcon[10] = {
+		0x01, 0x02, 0x04, 0x08, 0x10,
+		0x20, 0x40, 0x80, 0x1B, 0x36
+	};
+
+	// Standard FIPS-197 key expansion.
+	// Words are stored in little-endian order, which matches
+	// the byte order used by the AES-NI instructions.
+	const unsigned int nk = static_cast<unsigned int>(size / 4);
+	rounds = nk + 6;
+	const unsigned int total = (rounds + 1) * 4;
+
+	uint32_t w[(MAX_ROUNDS + 1) * 4];
+	memcpy(w, pKey, size);
+	for (unsigned int i = nk; i < total; i++) {
+		uint32_t temp = w[i - 1];
+		if (i % nk == 0) {
+			temp = aesni_subword(temp, true) ^ rcon[(i / nk) - 1];
+		} else if (nk > 6 && (i % nk) == 4) {
+			temp = aesni_subword(temp, false);
+		}
+		w[i] = w[i - nk] ^ temp;
+	}
+	memcpy(rk_enc, w, total * sizeof(uint32_t));
+
+	// Decryption round keys for the Equivalent Inverse Cipher:
+	// reversed order, with InvMixColumns applied to the middle keys.
+	__m128i *const pEnc = reinterpret_cast<__m128i*>(rk_enc);
+	__m128i *const pDec = reinterpret_cast<__m128i*>(rk_dec);
+	_mm_storeu_si128(&pDec[0], _mm_loadu_si128(&pEnc[rounds]));
+	for (unsigned int i = 1; i < rounds; i++) {
+		_mm_storeu_si128(&pDec[i], _mm_aesimc_si128(_mm_loadu_si128(&pEnc[rounds - i])));
+	}
+	_mm_storeu_si128(&pDec[rounds], _mm_loadu_si128(&pEnc[0]));
+}
+
+/**
+ * Decrypt a single block.
+ * @param x	[in] Ciphertext block.
+ * @param rk	[in] Decryption round keys.
+ * @param nr	[in] Number of rounds.
+ * @return Plaintext block.
+ */
+static FORCEINLINE __m128i aesni_decrypt1(__m128i x, const __m128i *rk, unsigned int nr)
+{
+	x = _mm_xor_si128(x, rk[0]);
+	for (unsigned int i = 1; i < nr; i++) {
+		x = _mm_aesdec_si128(x, rk[i]);
+	}
+	return _mm_aesdeclast_si128(x, rk[nr]);
+}
+
+/**
+ * Encrypt a single block.
+ * @param x	[in] Plaintext block.
+ * @param rk	[in] Encryption round keys.
+ * @param nr	[in] Number of rounds.
+ * @return Ciphertext block.
+ */
+static FORCEINLINE __m128i aesni_encrypt1(__m128i x, const __m128i *rk, unsigned int nr)
+{
+	x = _mm_xor_si128(x, rk[0]);
+	for (unsigned int i = 1; i < nr; i++) {
+		x = _mm_aesenc_si128(x, rk[i]);
+	}
+	return _mm_aesenclast_si128(x, rk[nr]);
+}
+
+/**
+ * Decrypt four independent blocks in parallel.
+ * @param x	[in/out] Blocks.
+ * @param rk	[in] Decryption round keys.
+ * @param nr	[in] Number of rounds.
+ */
+static FORCEINLINE void aesni_decrypt4(__m128i x[4], const __m128i *rk, unsigned int nr)
+{
+	x[0] = _mm_xor_si128(x[0], rk[0]);
+	x[1] = _mm_xor_si128(x[1], rk[0]);
+	x[2] = _mm_xor_si128(x[2], rk[0]);
+	x[3] = _mm_xor_si128(x[3], rk[0]);
+	for (unsigned int i = 1; i < nr; i++) {
+		x[0] = _mm_aesdec_si128(x[0], rk[i]);
+		x[1] = _mm_aesdec_si128(x[1], rk[i]);
+		x[2] = _mm_aesdec_si128(x[2], rk[i]);
+		x[3] = _mm_aesdec_si128(x[3], rk[i]);
+	}
+	x[0] = _mm_aesdeclast_si128(x[0], rk[nr]);
+	x[1] = _mm_aesdeclast_si128(x[1], rk[nr]);
+	x[2] = _mm_aesdeclast_si128(x[2], rk[nr]);
+	x[3] = _mm_aesdeclast_si128(x[3], rk[nr]);
+}
+
+/**
+ * Encrypt four independent blocks in parallel.
+ * @param x	[in/out] Blocks.
+ * @param rk	[in] Encryption round keys.
+ * @param nr	[in] Number of rounds.
+ */
+static FORCEINLINE void aesni_encrypt4(__m128i x[4], const __m128i *rk, unsigned int nr)
+{
+	x[0] = _mm_xor_si128(x[0], rk[0]);
+	x[1] = _mm_xor_si128(x[1], rk[0]);
+	x[2] = _mm_xor_si128(x[2], rk[0]);
+	x[3] = _mm_xor_si128(x[3], rk[0]);
+	for (unsigned int i = 1; i < nr; i++) {
+		x[0] = _mm_aesenc_si128(x[0], rk[i]);
+		x[1] = _mm_aesenc_si128(x[1], rk[i]);
+		x[2] = _mm_aesenc_si128(x[2], rk[i]);
+		x[3] = _mm_aesenc_si128(x[3], rk[i]);
+	}
+	x[0] = _mm_aesenclast_si128(x[0], rk[nr]);
+	x[1] = _mm_aesenclast_si128(x[1], rk[nr]);
+	x[2] = _mm_aesenclast_si128(x[2], rk[nr]);
+	x[3] = _mm_aesenclast_si128(x[3], rk[nr]);
+}
+
+/**
+ * Decrypt data using ECB.
+ * @param pData	[in/out] Data.
+ * @param size	[in] Size of data. (multiple of 16)
+ */
+void AesNIPrivate::decryptECB(uint8_t *RESTRICT pData, size_t size)
+{
+	__m128i rk[MAX_ROUNDS + 1];
+	loadRoundKeys(rk, rk_dec);
+	const unsigned int nr = rounds;
+
+	__m128i *p = reinterpret_cast<__m128i*>(pData);
+	size_t blocks = size / AES_BLOCK_SIZE;
+	for (; blocks >= PIPELINE_BLOCKS; blocks -= PIPELINE_BLOCKS, p += PIPELINE_BLOCKS) {
+		__m128i x[4];
+		x[0] = _mm_loadu_si128(&p[0]);
+		x[1] = _mm_loadu_si128(&p[1]);
+		x[2] = _mm_loadu_si128(&p[2]);
+		x[3] = _mm_loadu_si128(&p[3]);
+		aesni_decrypt4(x, rk, nr);
+		_mm_storeu_si128(&p[0], x[0]);
+		_mm_storeu_si128(&p[1], x[1]);
+		_mm_storeu_si128(&p[2], x[2]);
+		_mm_storeu_si128(&p[3], x[3]);
+	}
+	for (; blocks > 0; blocks--, p++) {
+		_mm_storeu_si128(p, aesni_decrypt1(_mm_loadu_si128(p), rk, nr));
+	}
+}
+
+/**
+ * Decrypt data using CBC.
+ * The IV is updated for the next call.
+ * @param pData	[in/out] Data.
+ * @param size	[in] Size of data. (multiple of 16)
+ */
+void AesNIPrivate::decryptCBC(uint8_t *RESTRICT pData, size_t size)
+{
+	__m128i rk[MAX_ROUNDS + 1];
+	loadRoundKeys(rk, rk_dec);
+	const unsigned int nr = rounds;
+
+	// CBC decryption doesn't depend on the previous plaintext,
+	// so multiple blocks can be decrypted in parallel.
+	__m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+	__m128i *p = reinterpret_cast<__m128i*>(pData);
+	size_t blocks = size / AES_BLOCK_SIZE;
+	for (; blocks >= PIPELINE_BLOCKS; blocks -= PIPELINE_BLOCKS, p += PIPELINE_BLOCKS) {
+		__m128i c[4], x[4];
+		x[0] = c[0] = _mm_loadu_si128(&p[0]);
+		x[1] = c[1] = _mm_loadu_si128(&p[1]);
+		x[2] = c[2] = _mm_loadu_si128(&p[2]);
+		x[3] = c[3] = _mm_loadu_si128(&p[3]);
+		aesni_decrypt4(x, rk, nr);
+		_mm_storeu_si128(&p[0], _mm_xor_si128(x[0], prev));
+		_mm_storeu_si128(&p[1], _mm_xor_si128(x[1], c[0]));
+		_mm_storeu_si128(&p[2], _mm_xor_si128(x[2], c[1]));
+		_mm_storeu_si128(&p[3], _mm_xor_si128(x[3], c[2]));
+		prev = c[3];
+	}
+	for (; blocks > 0; blocks--, p++) {
+		const __m128i c = _mm_loadu_si128(p);
+		_mm_storeu_si128(p, _mm_xor_si128(aesni_decrypt1(c, rk, nr), prev));
+		prev = c;
+	}
+
+	// Save the IV for the next call.
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(iv), prev);
+}
+
+/**
+ * Get the current CTR counter block and increment the counter.
+ * @param ctr_hi	[in/out] High 64 bits of the counter. (host-endian)
+ * @param ctr_lo	[in/out] Low 64 bits of the counter. (host-endian)
+ * @return Counter block.
+ */
+static FORCEINLINE __m128i aesni_ctr_next(uint64_t &ctr_hi, uint64_t &ctr_lo)
+{
+	const __m128i x = _mm_set_epi64x(
+		static_cast<int64_t>(cpu_to_be64(ctr_lo)),
+		static_cast<int64_t>(cpu_to_be64(ctr_hi)));
+	if (++ctr_lo == 0) {
+		ctr_hi++;
+	}
+	return x;
+}
+
+/**
+ * Decrypt data using CTR.
+ * The counter is updated for the next call.
+ * @param pData	[in/out] Data.
+ * @param size	[in] Size of data. (multiple of 16)
+ */
+void AesNIPrivate::decryptCTR(uint8_t *RESTRICT pData, size_t size)
+{
+	__m128i rk[MAX_ROUNDS + 1];
+	loadRoundKeys(rk, rk_enc);
+	const unsigned int nr = rounds;
+
+	// The counter is a 128-bit big-endian integer.
+	uint64_t ctr_hi, ctr_lo;
+	memcpy(&ctr_hi, &iv[0], sizeof(ctr_hi));
+	memcpy(&ctr_lo, &iv[8], sizeof(ctr_lo));
+	ctr_hi = be64_to_cpu(ctr_hi);
+	ctr_lo = be64_to_cpu(ctr_lo);
+
+	__m128i *p = reinterpret_cast<__m128i*>(pData);
+	size_t blocks = size / AES_BLOCK_SIZE;
+	for (; blocks >= PIPELINE_BLOCKS; blocks -= PIPELINE_BLOCKS, p += PIPELINE_BLOCKS) {
+		__m128i x[4];
+		x[0] = aesni_ctr_next(ctr_hi, ctr_lo);
+		x[1] = aesni_ctr_next(ctr_hi, ctr_lo);
+		x[2] = aesni_ctr_next(ctr_hi, ctr_lo);
+		x[3] = aesni_ctr_next(ctr_hi, ctr_lo);
+		aesni_encrypt4(x, rk, nr);
+		_mm_storeu_si128(&p[0], _mm_xor_si128(x[0], _mm_loadu_si128(&p[0])));
+		_mm_storeu_si128(&p[1], _mm_xor_si128(x[1], _mm_loadu_si128(&p[1])));
+		_mm_storeu_si128(&p[2], _mm_xor_si128(x[2], _mm_loadu_si128(&p[2])));
+		_mm_storeu_si128(&p[3], _mm_xor_si128(x[3], _mm_loadu_si128(&p[3])));
+	}
+	for (; blocks > 0; blocks--, p++) {
+		const __m128i x = aesni_encrypt1(aesni_ctr_next(ctr_hi, ctr_lo), rk, nr);
+		_mm_storeu_si128(p, _mm_xor_si128(x, _mm_loadu_si128(p)));
+	}
+
+	// Save the counter for the next call.
+	ctr_hi = cpu_to_be64(ctr_hi);
+	ctr_lo = cpu_to_be64(ctr_lo);
+	memcpy(&iv[0], &ctr_hi, sizeof(ctr_hi));
+	memcpy(&iv[8], &ctr_lo, sizeof(ctr_lo));
+}
+
+/** AesNI **/
+
+AesNI::AesNI()
+	: d_ptr(new AesNIPrivate())
+{ }
+
+AesNI::~AesNI()
+{
+	delete d_ptr;
+}
+
+/**
+ * Is AES-NI usable on this system?
+ * @return True if the CPU supports AES-NI.
+ */
+bool AesNI::isUsable(void)
+{
+	return !!RP_CPU_HasAESNI();
+}
+
+/**
+ * Get the name of the AesCipher implementation.
+ * @return Name.
+ */
+const char *AesNI::name(void) const
+{
+	return "AES-NI";
+}
+
+/**
+ * Has the cipher been initialized properly?
+ * @return True if initialized; false if not.
+ */
+bool AesNI::isInit(void) const
+{
+	// AES-NI works as long as the CPU supports it.
+	return isUsable();
+}
+
+/**
+ * Set the encryption key.
+ * @param pKey	[in] Key data.
+ * @param size	[in] Size of pKey, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AesNI::setKey(const uint8_t *RESTRICT pKey, size_t size)
+{
+	// Acceptable key lengths:
+	// - 16 (AES-128)
+	// - 24 (AES-192)
+	// - 32 (AES-256)
+	if (!pKey || !(size == 16 || size == 24 || size == 32)) {
+		return -EINVAL;
+	} else if (!isUsable()) {
+		// AES-NI is not supported on this CPU.
+		return -ENOTSUP;
+	}
+
+	// The key schedule is the same for all chaining modes,
+	// so it can be expanded immediately.
+	RP_D(AesNI);
+	d->expandKey(pKey, size);
+	return 0;
+}
+
+/**
+ * Set the cipher chaining mode.
+ *
+ * Note that the IV/counter must be set *after* setting
+ * the chaining mode; otherwise, setIV() will fail.
+ *
+ * @param mode Cipher chaining mode.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AesNI::setChainingMode(ChainingMode mode)
+{
+	if (mode < ChainingMode::ECB || mode >= ChainingMode::Max) {
+		return -EINVAL;
+	}
+
+	RP_D(AesNI);
+	d->chainingMode = mode;
+	return 0;
+}
+
+/**
+ * Set the IV (CBC mode) or counter (CTR mode).
+ * @param pIV	[in] IV/counter data.
+ * @param size	[in] Size of pIV, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AesNI::setIV(const uint8_t *RESTRICT pIV, size_t size)
+{
+	RP_D(AesNI);
+	if (!pIV || size != AesNIPrivate::AES_BLOCK_SIZE ||
+	    d->chainingMode < ChainingMode::CBC || d->chainingMode >= ChainingMode::Max)
+	{
+		// Invalid parameters and/or chaining mode.
+		return -EINVAL;
+	}
+
+	// Set the IV/counter.
+	memcpy(d->iv, pIV, AesNIPrivate::AES_BLOCK_SIZE);
+	return 0;
+}
+
+/**
+ * Decrypt a block of data.
+ * @param pData	[in/out] Data block.
+ * @param size	[in] Length of data block. (Must be a multiple of 16.)
+ * @return Number of bytes decrypted on success; 0 on error.
+ */
+size_t AesNI::decrypt(uint8_t *RESTRICT pData, size_t size)
+{
+	if (!pData || size == 0 || (size % AesNIPrivate::AES_BLOCK_SIZE != 0)) {
+		// Invalid parameters.
+		return 0;
+	}
+
+	RP_D(AesNI);
+	if (d->rounds == 0) {
+		// No key set...
+		return 0;
+	}
+
+	switch (d->chainingMode) {
+		case ChainingMode::ECB:
+			d->decryptECB(pData, size);
+			break;
+		case ChainingMode::CBC:
+			d->decryptCBC(pData, size);
+			break;
+		case ChainingMode::CTR:
+			d->decryptCTR(pData, size);
+			break;
+		default:
+			return 0;
+	}
+
+	RpStats::add(RpStats::AES_BYTES_DECRYPTED, size);
+	return size;
+}
+
+}
@@ -17,6 +17,10 @@
 #include <nettle/cbc.h>
 #include <nettle/ctr.h>
 
+// librpfile
+#include "librpfile/RpStats.hpp"
+using namespace LibRpFile;
+
 namespace LibRpBase {
 
 class AesNettlePrivate
@@ -304,6 +308,7 @@ size_t AesNettle::decrypt(uint8_t *RESTRICT pData, size_t size)
 	}
 #endif /* HAVE_NETTLE_3 */
 
+	RpStats::add(RpStats::AES_BYTES_DECRYPTED, size);
 	return size;
 }
 
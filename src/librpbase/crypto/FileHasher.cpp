@@ -0,0 +1,256 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * FileHasher.cpp: Whole-file checksum calculation.                        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librpbase.h"
+#include "FileHasher.hpp"
+
+#include "../aligned_malloc.h"
+#include "../disc/IDiscReader.hpp"
+
+#ifdef FILEHASHER_HAS_PCLMUL
+# include "librpcpu/cpuflags_x86.h"
+#endif /* FILEHASHER_HAS_PCLMUL */
+
+#ifdef ENABLE_DECRYPTION
+# include "MD5Hash.hpp"
+# include "SHA1Hash.hpp"
+#endif /* ENABLE_DECRYPTION */
+
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::ThreadPool;
+
+// zlib for crc32()
+#include <zlib.h>
+
+// C++ STL classes.
+using std::unique_ptr;
+
+namespace LibRpBase {
+
+/**
+ * Get the hash algorithms supported by this build.
+ * @return HashFlags
+ */
+unsigned int FileHasher::supportedHashes(void)
+{
+#ifdef ENABLE_DECRYPTION
+	return HASH_CRC32 | HASH_MD5 | HASH_SHA1;
+#else /* !ENABLE_DECRYPTION */
+	return HASH_CRC32;
+#endif /* ENABLE_DECRYPTION */
+}
+
+/**
+ * Update a CRC32 checksum.
+ * This is compatible with zlib's crc32(), and uses
+ * PCLMULQDQ folding on large buffers if available.
+ * @param crc	[in] Current CRC32. (Use 0 for the initial value.)
+ * @param pData	[in] Data.
+ * @param len	[in] Length of data.
+ * @return Updated CRC32.
+ */
+uint32_t FileHasher::calcCrc32(uint32_t crc, const void *pData, size_t len)
+{
+	assert(pData != nullptr || len == 0);
+	const uint8_t *p = static_cast<const uint8_t*>(pData);
+
+#ifdef FILEHASHER_HAS_PCLMUL
+	if (len >= 64 && RP_CPU_HasPCLMULQDQ()) {
+		// Fold as many 16-byte blocks as possible.
+		// The remainder is handled by zlib.
+		const size_t chunk_len = len & ~static_cast<size_t>(15);
+		crc = ~crc32_pclmul(~crc, p, chunk_len);
+		p += chunk_len;
+		len -= chunk_len;
+	}
+#endif /* FILEHASHER_HAS_PCLMUL */
+
+	// NOTE: zlib's crc32() takes a uInt length.
+	while (len > 0) {
+		const uInt cb = (len > 0x40000000U ? 0x40000000U : static_cast<uInt>(len));
+		crc = static_cast<uint32_t>(::crc32(crc, p, cb));
+		p += cb;
+		len -= cb;
+	}
+	return crc;
+}
+
+/**
+ * Calculate checksums for an entire disc image in a single pass.
+ *
+ * The disc reader's logical view is hashed, so compressed
+ * and sparse formats (e.g. GCZ, CISO, WBFS, CSO) produce the
+ * checksums of the decompressed image.
+ *
+ * @param hashes	[out] Calculated checksums.
+ * @param discReader	[in] Disc reader.
+ * @param flags		[in] HashFlags to calculate. (Unsupported hashes are skipped.)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int FileHasher::hashDisc(Hashes &hashes, IDiscReader *discReader, unsigned int flags)
+{
+	memset(&hashes, 0, sizeof(hashes));
+	assert(discReader != nullptr);
+	if (!discReader || !discReader->isOpen()) {
+		return -EBADF;
+	}
+
+	flags &= supportedHashes();
+	if (flags == 0) {
+		// Nothing to do.
+		return -ENOTSUP;
+	}
+
+	const off64_t fileSize = discReader->size();
+	if (fileSize < 0) {
+		const int err = discReader->lastError();
+		return (err != 0 ? -err : -EIO);
+	}
+
+#ifdef ENABLE_DECRYPTION
+	unique_ptr<MD5Hash> md5;
+	unique_ptr<SHA1Hash> sha1;
+	if (flags & HASH_MD5) {
+		md5.reset(new MD5Hash());
+		if (!md5->isUsable()) {
+			md5.reset();
+			flags &= ~HASH_MD5;
+		}
+	}
+	if (flags & HASH_SHA1) {
+		sha1.reset(new SHA1Hash());
+		if (!sha1->isUsable()) {
+			sha1.reset();
+			flags &= ~HASH_SHA1;
+		}
+	}
+#endif /* ENABLE_DECRYPTION */
+
+	// Two buffers are used so the next block can be read
+	// while the current block is being hashed. Each hash
+	// algorithm runs on its own thread, if available.
+	static const size_t BUF_SIZE = 1024U*1024U;
+	auto buf = aligned_uptr<uint8_t>(64, BUF_SIZE * 2);
+	if (!buf) {
+		return -ENOMEM;
+	}
+	uint8_t *bufs[2] = {buf.get(), buf.get() + BUF_SIZE};
+
+	// Tasks for each block.
+	enum class Task : uint8_t {
+		Read,
+		CRC32,
+		MD5,
+		SHA1,
+	};
+	Task tasks[4];
+	int taskErr[4] = {0, 0, 0, 0};
+	unsigned int taskCount = 0;
+	tasks[taskCount++] = Task::Read;
+	if (flags & HASH_CRC32)
+		tasks[taskCount++] = Task::CRC32;
+	if (flags & HASH_MD5)
+		tasks[taskCount++] = Task::MD5;
+	if (flags & HASH_SHA1)
+		tasks[taskCount++] = Task::SHA1;
+
+	ThreadPool pool(std::min(taskCount, ThreadPool::cpuCount()));
+
+	// Read the first block.
+	int cur = 0;
+	off64_t pos = 0;
+	size_t cur_len = (fileSize > 0
+		? discReader->seekAndRead(0, bufs[0], static_cast<size_t>(
+			std::min(fileSize, static_cast<off64_t>(BUF_SIZE))))
+		: 0);
+	size_t next_len = 0;
+	uint32_t crc = 0;
+
+	int ret = 0;
+	while (cur_len > 0) {
+		pos += cur_len;
+		const size_t want = static_cast<size_t>(
+			std::min(fileSize - pos, static_cast<off64_t>(BUF_SIZE)));
+		const uint8_t *const cur_buf = bufs[cur];
+		uint8_t *const next_buf = bufs[cur ^ 1];
+
+		pool.parallelFor(taskCount, [&](size_t idx) {
+			switch (tasks[idx]) {
+				case Task::Read:
+					next_len = (want > 0 ? discReader->read(next_buf, want) : 0);
+					break;
+				case Task::CRC32:
+					crc = calcCrc32(crc, cur_buf, cur_len);
+					break;
+#ifdef ENABLE_DECRYPTION
+				case Task::MD5:
+					taskErr[idx] = md5->process(cur_buf, cur_len);
+					break;
+				case Task::SHA1:
+					taskErr[idx] = sha1->process(cur_buf, cur_len);
+					break;
+#endif /* ENABLE_DECRYPTION */
+				default:
+					assert(!"Unsupported hash task.");
+					break;
+			}
+		});
+
+		for (unsigned int i = 0; i < taskCount; i++) {
+			if (taskErr[i] != 0) {
+				ret = taskErr[i];
+				break;
+			}
+		}
+		if (ret != 0)
+			break;
+
+		if (next_len != want) {
+			// Short read.
+			const int err = discReader->lastError();
+			ret = (err != 0 ? -err : -EIO);
+			break;
+		}
+
+		cur ^= 1;
+		cur_len = next_len;
+	}
+
+	if (ret == 0 && pos != fileSize) {
+		// Initial read failed.
+		const int err = discReader->lastError();
+		ret = (err != 0 ? -err : -EIO);
+	}
+	if (ret != 0) {
+		return ret;
+	}
+
+	if (flags & HASH_CRC32) {
+		hashes.crc = crc;
+	}
+#ifdef ENABLE_DECRYPTION
+	if (flags & HASH_MD5) {
+		ret = md5->getHash(hashes.md5, sizeof(hashes.md5));
+		if (ret != 0)
+			return ret;
+	}
+	if (flags & HASH_SHA1) {
+		ret = sha1->getHash(hashes.sha1, sizeof(hashes.sha1));
+		if (ret != 0)
+			return ret;
+	}
+#endif /* ENABLE_DECRYPTION */
+
+	hashes.flags = flags;
+	hashes.size = fileSize;
+	return 0;
+}
+
+}
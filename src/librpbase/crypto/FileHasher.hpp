@@ -0,0 +1,109 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * FileHasher.hpp: Whole-file checksum calculation.                        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_CRYPTO_FILEHASHER_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_CRYPTO_FILEHASHER_HPP__
+
+#include "common.h"
+#include "librpcpu/cpu_dispatch.h"
+
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# define FILEHASHER_HAS_PCLMUL 1
+#endif
+
+// C includes.
+#include <stddef.h>	/* size_t */
+#include <stdint.h>
+
+namespace LibRpBase {
+
+class IDiscReader;
+
+class FileHasher
+{
+	private:
+		// FileHasher is a static class.
+		FileHasher();
+		~FileHasher();
+		RP_DISABLE_COPY(FileHasher)
+
+	public:
+		/**
+		 * Hash algorithms.
+		 */
+		enum HashFlags : unsigned int {
+			HASH_CRC32	= (1U << 0),
+			HASH_MD5	= (1U << 1),	// Requires ENABLE_DECRYPTION.
+			HASH_SHA1	= (1U << 2),	// Requires ENABLE_DECRYPTION.
+
+			HASH_ALL	= HASH_CRC32 | HASH_MD5 | HASH_SHA1,
+		};
+
+		/**
+		 * Calculated checksums.
+		 */
+		struct Hashes {
+			unsigned int flags;	// HashFlags that were calculated
+			uint32_t crc;		// CRC32
+			uint8_t md5[16];
+			uint8_t sha1[20];
+			int64_t size;		// Number of bytes hashed
+		};
+
+		/**
+		 * Get the hash algorithms supported by this build.
+		 * @return HashFlags
+		 */
+		static unsigned int supportedHashes(void);
+
+		/**
+		 * Update a CRC32 checksum.
+		 * This is compatible with zlib's crc32(), and uses
+		 * PCLMULQDQ folding on large buffers if available.
+		 * @param crc	[in] Current CRC32. (Use 0 for the initial value.)
+		 * @param pData	[in] Data.
+		 * @param len	[in] Length of data.
+		 * @return Updated CRC32.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		static uint32_t calcCrc32(uint32_t crc, const void *pData, size_t len);
+
+		/**
+		 * Calculate checksums for an entire disc image in a single pass.
+		 *
+		 * The disc reader's logical view is hashed, so compressed
+		 * and sparse formats (e.g. GCZ, CISO, WBFS, CSO) produce the
+		 * checksums of the decompressed image.
+		 *
+		 * @param hashes	[out] Calculated checksums.
+		 * @param discReader	[in] Disc reader.
+		 * @param flags		[in] HashFlags to calculate. (Unsupported hashes are skipped.)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int hashDisc(Hashes &hashes, IDiscReader *discReader,
+			unsigned int flags = HASH_ALL);
+
+#ifdef FILEHASHER_HAS_PCLMUL
+	private:
+		/**
+		 * Update a CRC32 using PCLMULQDQ.
+		 *
+		 * NOTE: The CRC is NOT pre- or post-inverted here.
+		 *
+		 * @param crc	[in] Current CRC32, inverted.
+		 * @param buf	[in] Data. (len must be at least 64 and a multiple of 16)
+		 * @param len	[in] Length of data.
+		 * @return Updated CRC32, inverted.
+		 */
+		static uint32_t crc32_pclmul(uint32_t crc, const uint8_t *buf, size_t len);
+#endif /* FILEHASHER_HAS_PCLMUL */
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_CRYPTO_FILEHASHER_HPP__ */
@@ -18,6 +18,11 @@ using std::string;
 using std::unique_ptr;
 using std::unordered_map;
 
+// librpthreads
+#include "librpthreads/AtomicSnapshot.hpp"
+using LibRpThreads::AtomicSnapshot;
+using LibRpThreads::MutexLocker;
+
 #include "IAesCipher.hpp"
 #include "AesCipherFactory.hpp"
 
@@ -27,6 +32,7 @@ class KeyManagerPrivate : public ConfReaderPrivate
 {
 	public:
 		KeyManagerPrivate();
+		~KeyManagerPrivate() final;
 
 	private:
 		typedef ConfReaderPrivate super;
@@ -59,29 +65,107 @@ class KeyManagerPrivate : public ConfReaderPrivate
 		int processConfigLine(const char *section,
 			const char *name, const char *value) final;
 
-	public:
+		/**
+		 * Loading the configuration has finished.
+		 * Called by load() with mtxLoad locked, after all
+		 * configuration lines have been processed, or after
+		 * reset() if loading the configuration failed.
+		 */
+		void loadFinished(void) final;
+
 #ifdef ENABLE_DECRYPTION
-		// Encryption key data.
-		// Managed as a single block in order to reduce
-		// memory allocations.
-		ao::uvector<uint8_t> vKeys;
+	public:
+		/**
+		 * Key store.
+		 *
+		 * Key stores are immutable once they're published,
+		 * so they can be read from multiple threads without
+		 * locking.
+		 */
+		struct KeyStore {
+			// Encryption key data.
+			// Managed as a single block in order to reduce
+			// memory allocations.
+			ao::uvector<uint8_t> vKeys;
+
+			/**
+			 * Map of key names to vKeys indexes.
+			 * - Key: Key name.
+			 * - Value: vKeys information.
+			 *   - High byte: Key length.
+			 *   - Low 3 bytes: Key index.
+			 */
+			unordered_map<string, uint32_t> mapKeyNames;
+
+			/**
+			 * Map of invalid key names to errors.
+			 * These are stored for better error reporting.
+			 * - Key: Key name.
+			 * - Value: Verification result.
+			 */
+			unordered_map<string, uint8_t> mapInvalidKeyNames;
+		};
+
+		// Key store being loaded by load(). (protected by mtxLoad)
+		unique_ptr<KeyStore> loadingKeyStore;
+
+		// Current key store.
+		// This is replaced when keys.conf is reloaded.
+		// NOTE: Old key stores aren't deleted until the KeyManager
+		// is destroyed, since callers may still have pointers to
+		// their key data.
+		AtomicSnapshot<KeyStore> keyStore;
+
+		/**
+		 * Verified key cache.
+		 *
+		 * This is a copy-on-write cache: a new cache is published
+		 * every time a result is added. Old caches are retired,
+		 * since other threads may still be reading them.
+		 */
+		struct VerifyCache {
+			// Key store that the results are valid for.
+			const KeyStore *keyStore;
+
+			/**
+			 * Verification results.
+			 * - Key: Key name, NULL, and the verification data.
+			 * - Value: VerifyResult.
+			 */
+			unordered_map<string, uint8_t> results;
+		};
+
+		// Current verified key cache.
+		// mtxVerify serializes updates.
+		AtomicSnapshot<VerifyCache> verifyCache;
+		LibRpThreads::Mutex mtxVerify;
+
+		/**
+		 * Get an encryption key from a key store.
+		 * @param keyStore	[in] Key store.
+		 * @param keyName	[in] Encryption key name.
+		 * @param pKeyData	[out,opt] Key data struct.
+		 * @return VerifyResult.
+		 */
+		static KeyManager::VerifyResult getKey(const KeyStore *keyStore,
+			const char *keyName, KeyManager::KeyData_t *pKeyData);
 
 		/**
-		 * Map of key names to vKeys indexes.
-		 * - Key: Key name.
-		 * - Value: vKeys information.
-		 *   - High byte: Key length.
-		 *   - Low 3 bytes: Key index.
+		 * Verify an encryption key.
+		 * @param pKeyData	[in] Key data.
+		 * @param pVerifyData	[in] Verification data block. (16 bytes)
+		 * @return VerifyResult.
 		 */
-		unordered_map<string, uint32_t> mapKeyNames;
+		static KeyManager::VerifyResult verifyKey(const KeyManager::KeyData_t *pKeyData,
+			const uint8_t *pVerifyData);
 
 		/**
-		 * Map of invalid key names to errors.
-		 * These are stored for better error reporting.
-		 * - Key: Key name.
-		 * - Value: Verification result.
+		 * Add a result to the verified key cache.
+		 * @param keyStore	[in] Key store used to get the key.
+		 * @param cacheKey	[in] Cache key.
+		 * @param res		[in] VerifyResult.
 		 */
-		unordered_map<string, uint8_t> mapInvalidKeyNames;
+		void addVerifyResult(const KeyStore *keyStore, string &&cacheKey, KeyManager::VerifyResult res);
 #endif /* ENABLE_DECRYPTION */
 };
 
@@ -105,23 +189,26 @@ KeyManagerPrivate::KeyManagerPrivate()
 	: super("keys.conf")
 { }
 
+KeyManagerPrivate::~KeyManagerPrivate()
+{ }
+
 /**
  * Reset the configuration to the default values.
  */
 void KeyManagerPrivate::reset(void)
 {
 #ifdef ENABLE_DECRYPTION
-	// Clear the loaded keys.
-	vKeys.clear();
-	mapKeyNames.clear();
-	mapInvalidKeyNames.clear();
+	// Start a new key store.
+	// NOTE: The current key store remains published
+	// until loading has finished.
+	loadingKeyStore.reset(new KeyStore);
 
 	// Reserve 1 KB for the key store.
-	vKeys.reserve(1024);
+	loadingKeyStore->vKeys.reserve(1024);
 #ifdef HAVE_UNORDERED_MAP_RESERVE
 	// Reserve entries for the key names map.
 	// NOTE: Not reserving entries for invalid key names.
-	mapKeyNames.reserve(64);
+	loadingKeyStore->mapKeyNames.reserve(64);
 #endif
 #else /* !ENABLE_DECRYPTION */
 	assert(!"Should not be called in no-decryption builds.");
@@ -161,6 +248,13 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 		return 1;
 	}
 
+	assert((bool)loadingKeyStore);
+	if (!loadingKeyStore) {
+		// reset() wasn't called...
+		return 1;
+	}
+	ao::uvector<uint8_t> &vKeys = loadingKeyStore->vKeys;
+
 	// Check the value length.
 	// TODO: Check for <= 0?
 	const size_t value_len = strlen(value);
@@ -204,7 +298,7 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 	// Value parsed successfully.
 	uint32_t keyIdx = vKeys_start_pos;
 	keyIdx |= (len << 24);
-	mapKeyNames.insert(std::make_pair(string(name), keyIdx));
+	loadingKeyStore->mapKeyNames.insert(std::make_pair(string(name), keyIdx));
 	return 1;
 #else /* !ENABLE_DECRYPTION */
 	RP_UNUSED(section);
@@ -215,6 +309,169 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 #endif /* ENABLE_DECRYPTION */
 }
 
+/**
+ * Loading the configuration has finished.
+ * Called by load() with mtxLoad locked, after all
+ * configuration lines have been processed, or after
+ * reset() if loading the configuration failed.
+ */
+void KeyManagerPrivate::loadFinished(void)
+{
+#ifdef ENABLE_DECRYPTION
+	if (!loadingKeyStore) {
+		// reset() wasn't called...
+		loadingKeyStore.reset(new KeyStore);
+	}
+
+	// If keys.conf is missing, it will be reloaded every time.
+	// Don't replace an empty key store with another empty key store.
+	const KeyStore *const curKeyStore = keyStore.get();
+	if (curKeyStore && curKeyStore->mapKeyNames.empty() && curKeyStore->mapInvalidKeyNames.empty() &&
+	    loadingKeyStore->mapKeyNames.empty() && loadingKeyStore->mapInvalidKeyNames.empty())
+	{
+		loadingKeyStore.reset();
+		return;
+	}
+
+	// Publish the new key store.
+	// The verified key cache is tied to the key store,
+	// so it will be replaced once a key is verified.
+	keyStore.publish(loadingKeyStore.release());
+#else /* !ENABLE_DECRYPTION */
+	assert(!"Should not be called in no-decryption builds.");
+#endif /* ENABLE_DECRYPTION */
+}
+
+#ifdef ENABLE_DECRYPTION
+/**
+ * Get an encryption key from a key store.
+ * @param keyStore	[in] Key store.
+ * @param keyName	[in] Encryption key name.
+ * @param pKeyData	[out,opt] Key data struct.
+ * @return VerifyResult.
+ */
+KeyManager::VerifyResult KeyManagerPrivate::getKey(const KeyStore *keyStore,
+	const char *keyName, KeyManager::KeyData_t *pKeyData)
+{
+	if (!keyStore) {
+		// Keys are not loaded.
+		return KeyManager::VerifyResult::KeyDBNotLoaded;
+	}
+
+	// Attempt to get the key from the map.
+	auto iter = keyStore->mapKeyNames.find(keyName);
+	if (iter == keyStore->mapKeyNames.end()) {
+		// Key was not parsed. Figure out why.
+		auto iter2 = keyStore->mapInvalidKeyNames.find(keyName);
+		if (iter2 != keyStore->mapInvalidKeyNames.end()) {
+			// An error occurred when parsing the key.
+			return (KeyManager::VerifyResult)iter2->second;
+		}
+
+		// Key was not found.
+		return KeyManager::VerifyResult::KeyNotFound;
+	}
+
+	// Found the key.
+	const uint32_t keyIdx = iter->second;
+	const uint32_t idx = (keyIdx & 0xFFFFFF);
+	const uint8_t len = ((keyIdx >> 24) & 0xFF);
+
+	// Make sure the key index is valid.
+	assert(idx + len <= keyStore->vKeys.size());
+	if (idx + len > keyStore->vKeys.size()) {
+		// Should not happen...
+		return KeyManager::VerifyResult::KeyDBError;
+	}
+
+	if (pKeyData) {
+		pKeyData->key = keyStore->vKeys.data() + idx;
+		pKeyData->length = len;
+	}
+	return KeyManager::VerifyResult::OK;
+}
+
+/**
+ * Verify an encryption key.
+ * @param pKeyData	[in] Key data.
+ * @param pVerifyData	[in] Verification data block. (16 bytes)
+ * @return VerifyResult.
+ */
+KeyManager::VerifyResult KeyManagerPrivate::verifyKey(const KeyManager::KeyData_t *pKeyData,
+	const uint8_t *pVerifyData)
+{
+	// Verify the key length.
+	if (pKeyData->length != 16 && pKeyData->length != 24 && pKeyData->length != 32) {
+		// Key length is invalid.
+		return KeyManager::VerifyResult::KeyInvalid;
+	}
+
+	// Decrypt the test data.
+	unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
+	if (!cipher) {
+		// Unable to create the IAesCipher.
+		return KeyManager::VerifyResult::IAesCipherInitErr;
+	}
+
+	// Set cipher parameters.
+	int ret = cipher->setChainingMode(IAesCipher::ChainingMode::ECB);
+	if (ret != 0) {
+		return KeyManager::VerifyResult::IAesCipherInitErr;
+	}
+	ret = cipher->setKey(pKeyData->key, pKeyData->length);
+	if (ret != 0) {
+		return KeyManager::VerifyResult::IAesCipherInitErr;
+	}
+
+	// Decrypt the test data.
+	// NOTE: IAesCipher decrypts in place, so we need to
+	// make a temporary copy.
+	uint8_t tmpData[16];
+	memcpy(tmpData, pVerifyData, sizeof(tmpData));
+	size_t size = cipher->decrypt(tmpData, sizeof(tmpData));
+	if (size != sizeof(tmpData)) {
+		// Decryption failed.
+		return KeyManager::VerifyResult::IAesCipherDecryptErr;
+	}
+
+	// Verify the test data.
+	if (memcmp(tmpData, KeyManager::verifyTestString, sizeof(tmpData)) != 0) {
+		// Verification failed.
+		return KeyManager::VerifyResult::WrongKey;
+	}
+
+	// Test data verified.
+	return KeyManager::VerifyResult::OK;
+}
+
+/**
+ * Add a result to the verified key cache.
+ * @param keyStore	[in] Key store used to get the key.
+ * @param cacheKey	[in] Cache key.
+ * @param res		[in] VerifyResult.
+ */
+void KeyManagerPrivate::addVerifyResult(const KeyStore *keyStore, string &&cacheKey, KeyManager::VerifyResult res)
+{
+	MutexLocker mtxLocker(mtxVerify);
+	if (keyStore != this->keyStore.get()) {
+		// keys.conf was reloaded. Don't cache this result.
+		return;
+	}
+
+	// Copy the current cache if it's for the same key store.
+	VerifyCache *const newCache = new VerifyCache;
+	newCache->keyStore = keyStore;
+	const VerifyCache *const oldCache = verifyCache.get();
+	if (oldCache && oldCache->keyStore == keyStore) {
+		newCache->results = oldCache->results;
+	}
+	newCache->results.emplace(std::move(cacheKey), static_cast<uint8_t>(res));
+
+	// Publish the new cache.
+	verifyCache.publish(newCache);
+}
+#endif /* ENABLE_DECRYPTION */
+
 /** KeyManager **/
 
 KeyManager::KeyManager()
@@ -297,38 +554,11 @@ KeyManager::VerifyResult KeyManager::get(const char *keyName, KeyData_t *pKeyDat
 		return VerifyResult::KeyDBNotLoaded;
 	}
 
-	// Attempt to get the key from the map.
+	// Get the key from the current key store.
+	// NOTE: Key data remains valid even if keys.conf
+	// is reloaded later.
 	RP_D(const KeyManager);
-	auto iter = d->mapKeyNames.find(keyName);
-	if (iter == d->mapKeyNames.end()) {
-		// Key was not parsed. Figure out why.
-		auto iter2 = d->mapInvalidKeyNames.find(keyName);
-		if (iter2 != d->mapInvalidKeyNames.end()) {
-			// An error occurred when parsing the key.
-			return (VerifyResult)iter2->second;
-		}
-
-		// Key was not found.
-		return VerifyResult::KeyNotFound;
-	}
-
-	// Found the key.
-	const uint32_t keyIdx = iter->second;
-	const uint32_t idx = (keyIdx & 0xFFFFFF);
-	const uint8_t len = ((keyIdx >> 24) & 0xFF);
-
-	// Make sure the key index is valid.
-	assert(idx + len <= d->vKeys.size());
-	if (idx + len > d->vKeys.size()) {
-		// Should not happen...
-		return VerifyResult::KeyDBError;
-	}
-
-	if (pKeyData) {
-		pKeyData->key = d->vKeys.data() + idx;
-		pKeyData->length = len;
-	}
-	return VerifyResult::OK;
+	return KeyManagerPrivate::getKey(d->keyStore.get(), keyName, pKeyData);
 }
 
 /**
@@ -364,8 +594,19 @@ KeyManager::VerifyResult KeyManager::getAndVerify(const char *keyName, KeyData_t
 		pKeyData = &tmp_key_data;
 	}
 
+	// Check if keys.conf needs to be reloaded.
+	const_cast<KeyManager*>(this)->load();
+	if (!isLoaded()) {
+		// Keys are not loaded.
+		return VerifyResult::KeyDBNotLoaded;
+	}
+
 	// Get the key first.
-	VerifyResult res = get(keyName, pKeyData);
+	// NOTE: The same key store must be used for the
+	// verified key cache lookup.
+	RP_D(const KeyManager);
+	const KeyManagerPrivate::KeyStore *const keyStore = d->keyStore.get();
+	VerifyResult res = KeyManagerPrivate::getKey(keyStore, keyName, pKeyData);
 	if (res != VerifyResult::OK) {
 		// Error obtaining the key.
 		return res;
@@ -374,49 +615,23 @@ KeyManager::VerifyResult KeyManager::getAndVerify(const char *keyName, KeyData_t
 		return VerifyResult::KeyInvalid;
 	}
 
-	// Verify the key length.
-	if (pKeyData->length != 16 && pKeyData->length != 24 && pKeyData->length != 32) {
-		// Key length is invalid.
-		return VerifyResult::KeyInvalid;
-	}
-
-	// Decrypt the test data.
-	// TODO: Keep this IAesCipher instance around?
-	unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
-	if (!cipher) {
-		// Unable to create the IAesCipher.
-		return VerifyResult::IAesCipherInitErr;
-	}
-
-	// Set cipher parameters.
-	int ret = cipher->setChainingMode(IAesCipher::ChainingMode::ECB);
-	if (ret != 0) {
-		return VerifyResult::IAesCipherInitErr;
-	}
-	ret = cipher->setKey(pKeyData->key, pKeyData->length);
-	if (ret != 0) {
-		return VerifyResult::IAesCipherInitErr;
-	}
-
-	// Decrypt the test data.
-	// NOTE: IAesCipher decrypts in place, so we need to
-	// make a temporary copy.
-	unique_ptr<uint8_t[]> tmpData(new uint8_t[verifyLen]);
-	memcpy(tmpData.get(), pVerifyData, verifyLen);
-	size_t size = cipher->decrypt(tmpData.get(), verifyLen);
-	if (size != verifyLen) {
-		// Decryption failed.
-		return VerifyResult::IAesCipherDecryptErr;
-	}
-
-	// Verify the test data.
-	if (memcmp(tmpData.get(), verifyTestString, verifyLen) != 0) {
-		// Verification failed.
-		return VerifyResult::WrongKey;
+	// Check the verified key cache.
+	string cacheKey(keyName);
+	cacheKey += '\0';
+	cacheKey.append(reinterpret_cast<const char*>(pVerifyData), verifyLen);
+	const KeyManagerPrivate::VerifyCache *const verifyCache = d->verifyCache.get();
+	if (verifyCache && verifyCache->keyStore == keyStore) {
+		auto iter = verifyCache->results.find(cacheKey);
+		if (iter != verifyCache->results.end()) {
+			// Found a cached result.
+			return (VerifyResult)iter->second;
+		}
 	}
 
-	// Test data verified.
-	return VerifyResult::OK;
+	// Verify the key and cache the result.
+	res = KeyManagerPrivate::verifyKey(pKeyData, pVerifyData);
+	const_cast<KeyManagerPrivate*>(d)->addVerifyResult(keyStore, std::move(cacheKey), res);
+	return res;
 }
 
 /**
@@ -17,16 +17,57 @@
 
 namespace LibRpBase {
 
+class MD5HashPrivate;
 class MD5Hash
 {
-	protected:
-		MD5Hash() { }
-		~MD5Hash() { }
+	public:
+		MD5Hash();
+		~MD5Hash();
 
 	private:
 		RP_DISABLE_COPY(MD5Hash)
+	private:
+		friend class MD5HashPrivate;
+		MD5HashPrivate *const d_ptr;
 
 	public:
+		/**
+		 * MD5 hash length, in bytes.
+		 */
+		static const size_t HASH_LEN = 16;
+
+		/**
+		 * Is the MD5 hash object usable?
+		 * @return True if usable; false if not.
+		 */
+		bool isUsable(void) const;
+
+		/**
+		 * Reset the hash object so a new hash can be calculated.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int reset(void);
+
+		/**
+		 * Add data to the hash.
+		 * Data can be added in chunks of any size.
+		 * @param pData		[in] Input data.
+		 * @param len		[in] Data length.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int process(const void *pData, size_t len);
+
+		/**
+		 * Get the hash of the data added since the last reset().
+		 * The hash object must be reset before it can be reused.
+		 * @param pHash		[out] Output hash buffer. (Must be 16 bytes.)
+		 * @param hash_len	[in] Size of hash buffer.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 2, 3)
+		int getHash(uint8_t *pHash, size_t hash_len);
+
 		/**
 		 * Calculate the MD5 hash of the specified data.
 		 * @param pHash		[out] Output hash buffer. (Must be 16 bytes.)
@@ -35,7 +76,7 @@ class MD5Hash
 		 * @param len		[in] Data length.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		ATTR_ACCESS_SIZE(read_write, 1, 2)
+		ATTR_ACCESS_SIZE(write_only, 1, 2)
 		ATTR_ACCESS_SIZE(read_only, 3, 4)
 		static int calcHash(uint8_t *pHash, size_t hash_len, const void *pData, size_t len);
 };
@@ -1,6 +1,6 @@
 /***************************************************************************
  * ROM Properties Page shell extension. (librpbase)                        *
- * MD5HashCAPI.cpp: MD5 hash class. (Win32 CryptoAPI implementation.)      *
+ * MD5HashCAPI.cpp: MD5 hash class. (Win32 CryptoAPI)                      *
  *                                                                         *
  * Copyright (c) 2016-2020 by David Korth.                                 *
  * SPDX-License-Identifier: GPL-2.0-or-later                               *
@@ -19,61 +19,204 @@
 
 namespace LibRpBase {
 
+class MD5HashPrivate
+{
+	public:
+		MD5HashPrivate();
+		~MD5HashPrivate();
+
+	private:
+		RP_DISABLE_COPY(MD5HashPrivate)
+
+	public:
+		HCRYPTPROV hProvider;
+		HCRYPTHASH hHash;
+
+		/**
+		 * Create a new hash object.
+		 * The previous hash object, if any, is destroyed.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int createHash(void);
+};
+
+/** MD5HashPrivate **/
+
+MD5HashPrivate::MD5HashPrivate()
+	: hProvider(0)
+	, hHash(0)
+{
+	// Get handle to the crypto provider.
+	if (!CryptAcquireContext(&hProvider, nullptr, nullptr,
+	    PROV_RSA_FULL, CRYPT_VERIFYCONTEXT | CRYPT_SILENT))
+	{
+		// Failed to get a handle to the crypto provider.
+		hProvider = 0;
+		return;
+	}
+
+	createHash();
+}
+
+MD5HashPrivate::~MD5HashPrivate()
+{
+	if (hHash) {
+		CryptDestroyHash(hHash);
+	}
+	if (hProvider) {
+		CryptReleaseContext(hProvider, 0);
+	}
+}
+
 /**
- * Calculate the MD5 hash of the specified data.
- * @param pHash		[out] Output hash buffer. (Must be 16 bytes.)
- * @param hash_len	[in] Size of hash buffer.
+ * Create a new hash object.
+ * The previous hash object, if any, is destroyed.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MD5HashPrivate::createHash(void)
+{
+	if (hHash) {
+		CryptDestroyHash(hHash);
+		hHash = 0;
+	}
+	if (!hProvider) {
+		// No crypto provider.
+		return -ENOTSUP;
+	}
+
+	// Create a MD5 hash object.
+	if (!CryptCreateHash(hProvider, CALG_MD5, 0, 0, &hHash)) {
+		// Error creating the MD5 hash object.
+		hHash = 0;
+		return -w32err_to_posix(GetLastError());
+	}
+	return 0;
+}
+
+/** MD5Hash **/
+
+MD5Hash::MD5Hash()
+	: d_ptr(new MD5HashPrivate())
+{ }
+
+MD5Hash::~MD5Hash()
+{
+	delete d_ptr;
+}
+
+/**
+ * Is the MD5 hash object usable?
+ * @return True if usable; false if not.
+ */
+bool MD5Hash::isUsable(void) const
+{
+	RP_D(const MD5Hash);
+	return (d->hHash != 0);
+}
+
+/**
+ * Reset the hash object so a new hash can be calculated.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MD5Hash::reset(void)
+{
+	// CryptoAPI hash objects can't be reset,
+	// so a new hash object is created.
+	RP_D(MD5Hash);
+	return d->createHash();
+}
+
+/**
+ * Add data to the hash.
+ * Data can be added in chunks of any size.
  * @param pData		[in] Input data.
  * @param len		[in] Data length.
  * @return 0 on success; negative POSIX error code on error.
  */
-int MD5Hash::calcHash(uint8_t *pHash, size_t hash_len, const void *pData, size_t len)
+int MD5Hash::process(const void *pData, size_t len)
 {
-	HCRYPTPROV hProvider;
-	HCRYPTHASH hHash;
-
-	assert(pHash != nullptr);
-	assert(hash_len == 16);
-	assert(pData != nullptr);
-	if (!pHash || hash_len != 16 || !pData) {
+	assert(pData != nullptr || len == 0);
+	if (!pData && len != 0) {
 		// Invalid parameters.
 		return -EINVAL;
 	}
 
-	// Get handle to the crypto provider
-	if (!CryptAcquireContext(&hProvider, nullptr, nullptr,
-	    PROV_RSA_FULL, CRYPT_VERIFYCONTEXT | CRYPT_SILENT))
-	{
-		// Failed to get a handle to the crypto provider.
-		return -w32err_to_posix(GetLastError());
+	RP_D(MD5Hash);
+	if (!d->hHash) {
+		// No hash object.
+		return -EBADF;
 	}
 
-	// Create an MD5 hash object.
-	if (!CryptCreateHash(hProvider, CALG_MD5, 0, 0, &hHash)) {
-		// Error creating the MD5 hash object.
-		int ret = -w32err_to_posix(GetLastError());
-		CryptReleaseContext(hProvider, 0);
-		return ret;
+	// NOTE: CryptHashData() takes a DWORD length.
+	const BYTE *p = static_cast<const BYTE*>(pData);
+	while (len > 0) {
+		const DWORD cb = (len > 0x40000000U ? 0x40000000U : static_cast<DWORD>(len));
+		if (!CryptHashData(d->hHash, p, cb, 0)) {
+			// Error hashing the data.
+			return -w32err_to_posix(GetLastError());
+		}
+		p += cb;
+		len -= cb;
 	}
+	return 0;
+}
 
-	// Hash the data.
-	if (!CryptHashData(hHash, static_cast<const BYTE*>(pData), len, 0)) {
-		// Error hashing the data.
-		int ret = -w32err_to_posix(GetLastError());
-		CryptDestroyHash(hHash);
-		CryptReleaseContext(hProvider, 0);
-		return ret;
+/**
+ * Get the hash of the data added since the last reset().
+ * The hash object must be reset before it can be reused.
+ * @param pHash		[out] Output hash buffer. (Must be 16 bytes.)
+ * @param hash_len	[in] Size of hash buffer.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MD5Hash::getHash(uint8_t *pHash, size_t hash_len)
+{
+	assert(pHash != nullptr);
+	assert(hash_len == HASH_LEN);
+	if (!pHash || hash_len != HASH_LEN) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	RP_D(MD5Hash);
+	if (!d->hHash) {
+		// No hash object.
+		return -EBADF;
 	}
 
 	// Get the hash data.
-	int ret = 0;
 	DWORD cbHash = static_cast<DWORD>(hash_len);
-	if (!CryptGetHashParam(hHash, HP_HASHVAL, pHash, &cbHash, 0)) {
+	if (!CryptGetHashParam(d->hHash, HP_HASHVAL, pHash, &cbHash, 0)) {
 		// Error getting the hash.
-		ret = -w32err_to_posix(GetLastError());
+		return -w32err_to_posix(GetLastError());
 	} else if (cbHash != static_cast<DWORD>(hash_len)) {
 		// Wrong hash length.
-		ret = -EINVAL;
+		return -EINVAL;
+	}
+	return 0;
+}
+
+/**
+ * Calculate the MD5 hash of the specified data.
+ * @param pHash		[out] Output hash buffer. (Must be 16 bytes.)
+ * @param hash_len	[in] Size of hash buffer.
+ * @param pData		[in] Input data.
+ * @param len		[in] Data length.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MD5Hash::calcHash(uint8_t *pHash, size_t hash_len, const void *pData, size_t len)
+{
+	assert(pHash != nullptr);
+	assert(hash_len == HASH_LEN);
+	assert(pData != nullptr);
+	if (!pHash || hash_len != HASH_LEN || !pData) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	MD5Hash md5;
+	int ret = md5.process(pData, len);
+	if (ret == 0) {
+		ret = md5.getHash(pHash, hash_len);
 	}
 	return ret;
 }
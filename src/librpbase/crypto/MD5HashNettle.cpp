@@ -1,6 +1,6 @@
 /***************************************************************************
  * ROM Properties Page shell extension. (librpbase)                        *
- * MD5HashNettle.cpp: MD5 hash class. (Win32 CryptoAPI implementation.)    *
+ * MD5HashNettle.cpp: MD5 hash class. (Nettle implementation.)             *
  *                                                                         *
  * Copyright (c) 2016-2020 by David Korth.                                 *
  * SPDX-License-Identifier: GPL-2.0-or-later                               *
@@ -14,6 +14,95 @@
 
 namespace LibRpBase {
 
+class MD5HashPrivate
+{
+	public:
+		MD5HashPrivate()
+		{
+			md5_init(&ctx);
+		}
+
+	private:
+		RP_DISABLE_COPY(MD5HashPrivate)
+
+	public:
+		struct md5_ctx ctx;
+};
+
+/** MD5Hash **/
+
+MD5Hash::MD5Hash()
+	: d_ptr(new MD5HashPrivate())
+{ }
+
+MD5Hash::~MD5Hash()
+{
+	delete d_ptr;
+}
+
+/**
+ * Is the MD5 hash object usable?
+ * @return True if usable; false if not.
+ */
+bool MD5Hash::isUsable(void) const
+{
+	// Nettle is always usable.
+	return true;
+}
+
+/**
+ * Reset the hash object so a new hash can be calculated.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MD5Hash::reset(void)
+{
+	RP_D(MD5Hash);
+	md5_init(&d->ctx);
+	return 0;
+}
+
+/**
+ * Add data to the hash.
+ * Data can be added in chunks of any size.
+ * @param pData		[in] Input data.
+ * @param len		[in] Data length.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MD5Hash::process(const void *pData, size_t len)
+{
+	assert(pData != nullptr || len == 0);
+	if (!pData && len != 0) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	RP_D(MD5Hash);
+	md5_update(&d->ctx, len, static_cast<const uint8_t*>(pData));
+	return 0;
+}
+
+/**
+ * Get the hash of the data added since the last reset().
+ * The hash object must be reset before it can be reused.
+ * @param pHash		[out] Output hash buffer. (Must be 16 bytes.)
+ * @param hash_len	[in] Size of hash buffer.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MD5Hash::getHash(uint8_t *pHash, size_t hash_len)
+{
+	assert(pHash != nullptr);
+	assert(hash_len == HASH_LEN);
+	if (!pHash || hash_len != HASH_LEN) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	// NOTE: md5_digest() also resets the context.
+	RP_D(MD5Hash);
+	md5_digest(&d->ctx, hash_len, pHash);
+	return 0;
+}
+
 /**
  * Calculate the MD5 hash of the specified data.
  * @param pHash		[out] Output hash buffer. (Must be 16 bytes.)
@@ -27,9 +116,9 @@ int MD5Hash::calcHash(uint8_t *pHash, size_t hash_len, const void *pData, size_t
 	struct md5_ctx md5;
 
 	assert(pHash != nullptr);
-	assert(hash_len == 16);
+	assert(hash_len == HASH_LEN);
 	assert(pData != nullptr);
-	if (!pHash || hash_len != 16 || !pData) {
+	if (!pHash || hash_len != HASH_LEN || !pData) {
 		// Invalid parameters.
 		return -EINVAL;
 	}
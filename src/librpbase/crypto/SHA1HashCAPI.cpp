@@ -0,0 +1,224 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * SHA1HashCAPI.cpp: SHA-1 hash class. (Win32 CryptoAPI)                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "SHA1Hash.hpp"
+
+// libwin32common
+#include "libwin32common/RpWin32_sdk.h"
+#include "libwin32common/w32err.h"
+
+// References:
+// - https://docs.microsoft.com/en-us/windows/win32/seccrypto/example-c-program--creating-an-md-5-hash-from-file-content
+#include <wincrypt.h>
+
+namespace LibRpBase {
+
+class SHA1HashPrivate
+{
+	public:
+		SHA1HashPrivate();
+		~SHA1HashPrivate();
+
+	private:
+		RP_DISABLE_COPY(SHA1HashPrivate)
+
+	public:
+		HCRYPTPROV hProvider;
+		HCRYPTHASH hHash;
+
+		/**
+		 * Create a new hash object.
+		 * The previous hash object, if any, is destroyed.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int createHash(void);
+};
+
+/** SHA1HashPrivate **/
+
+SHA1HashPrivate::SHA1HashPrivate()
+	: hProvider(0)
+	, hHash(0)
+{
+	// Get handle to the crypto provider.
+	if (!CryptAcquireContext(&hProvider, nullptr, nullptr,
+	    PROV_RSA_FULL, CRYPT_VERIFYCONTEXT | CRYPT_SILENT))
+	{
+		// Failed to get a handle to the crypto provider.
+		hProvider = 0;
+		return;
+	}
+
+	createHash();
+}
+
+SHA1HashPrivate::~SHA1HashPrivate()
+{
+	if (hHash) {
+		CryptDestroyHash(hHash);
+	}
+	if (hProvider) {
+		CryptReleaseContext(hProvider, 0);
+	}
+}
+
+/**
+ * Create a new hash object.
+ * The previous hash object, if any, is destroyed.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1HashPrivate::createHash(void)
+{
+	if (hHash) {
+		CryptDestroyHash(hHash);
+		hHash = 0;
+	}
+	if (!hProvider) {
+		// No crypto provider.
+		return -ENOTSUP;
+	}
+
+	// Create a SHA-1 hash object.
+	if (!CryptCreateHash(hProvider, CALG_SHA1, 0, 0, &hHash)) {
+		// Error creating the SHA-1 hash object.
+		hHash = 0;
+		return -w32err_to_posix(GetLastError());
+	}
+	return 0;
+}
+
+/** SHA1Hash **/
+
+SHA1Hash::SHA1Hash()
+	: d_ptr(new SHA1HashPrivate())
+{ }
+
+SHA1Hash::~SHA1Hash()
+{
+	delete d_ptr;
+}
+
+/**
+ * Is the SHA-1 hash object usable?
+ * @return True if usable; false if not.
+ */
+bool SHA1Hash::isUsable(void) const
+{
+	RP_D(const SHA1Hash);
+	return (d->hHash != 0);
+}
+
+/**
+ * Reset the hash object so a new hash can be calculated.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1Hash::reset(void)
+{
+	// CryptoAPI hash objects can't be reset,
+	// so a new hash object is created.
+	RP_D(SHA1Hash);
+	return d->createHash();
+}
+
+/**
+ * Add data to the hash.
+ * Data can be added in chunks of any size.
+ * @param pData		[in] Input data.
+ * @param len		[in] Data length.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1Hash::process(const void *pData, size_t len)
+{
+	assert(pData != nullptr || len == 0);
+	if (!pData && len != 0) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	RP_D(SHA1Hash);
+	if (!d->hHash) {
+		// No hash object.
+		return -EBADF;
+	}
+
+	// NOTE: CryptHashData() takes a DWORD length.
+	const BYTE *p = static_cast<const BYTE*>(pData);
+	while (len > 0) {
+		const DWORD cb = (len > 0x40000000U ? 0x40000000U : static_cast<DWORD>(len));
+		if (!CryptHashData(d->hHash, p, cb, 0)) {
+			// Error hashing the data.
+			return -w32err_to_posix(GetLastError());
+		}
+		p += cb;
+		len -= cb;
+	}
+	return 0;
+}
+
+/**
+ * Get the hash of the data added since the last reset().
+ * The hash object must be reset before it can be reused.
+ * @param pHash		[out] Output hash buffer. (Must be 20 bytes.)
+ * @param hash_len	[in] Size of hash buffer.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1Hash::getHash(uint8_t *pHash, size_t hash_len)
+{
+	assert(pHash != nullptr);
+	assert(hash_len == HASH_LEN);
+	if (!pHash || hash_len != HASH_LEN) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	RP_D(SHA1Hash);
+	if (!d->hHash) {
+		// No hash object.
+		return -EBADF;
+	}
+
+	// Get the hash data.
+	DWORD cbHash = static_cast<DWORD>(hash_len);
+	if (!CryptGetHashParam(d->hHash, HP_HASHVAL, pHash, &cbHash, 0)) {
+		// Error getting the hash.
+		return -w32err_to_posix(GetLastError());
+	} else if (cbHash != static_cast<DWORD>(hash_len)) {
+		// Wrong hash length.
+		return -EINVAL;
+	}
+	return 0;
+}
+
+/**
+ * Calculate the SHA-1 hash of the specified data.
+ * @param pHash		[out] Output hash buffer. (Must be 20 bytes.)
+ * @param hash_len	[in] Size of hash buffer.
+ * @param pData		[in] Input data.
+ * @param len		[in] Data length.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1Hash::calcHash(uint8_t *pHash, size_t hash_len, const void *pData, size_t len)
+{
+	assert(pHash != nullptr);
+	assert(hash_len == HASH_LEN);
+	assert(pData != nullptr);
+	if (!pHash || hash_len != HASH_LEN || !pData) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	SHA1Hash sha1;
+	int ret = sha1.process(pData, len);
+	if (ret == 0) {
+		ret = sha1.getHash(pHash, hash_len);
+	}
+	return ret;
+}
+
+}
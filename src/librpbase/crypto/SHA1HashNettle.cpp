@@ -0,0 +1,134 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * SHA1HashNettle.cpp: SHA-1 hash class. (Nettle implementation.)          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "SHA1Hash.hpp"
+
+// Nettle SHA-1 functions.
+// NOTE: Nettle uses the x86 SHA extensions and ARMv8
+// crypto extensions if it was built with fat binary support.
+#include <nettle/sha1.h>
+
+namespace LibRpBase {
+
+class SHA1HashPrivate
+{
+	public:
+		SHA1HashPrivate()
+		{
+			sha1_init(&ctx);
+		}
+
+	private:
+		RP_DISABLE_COPY(SHA1HashPrivate)
+
+	public:
+		struct sha1_ctx ctx;
+};
+
+/** SHA1Hash **/
+
+SHA1Hash::SHA1Hash()
+	: d_ptr(new SHA1HashPrivate())
+{ }
+
+SHA1Hash::~SHA1Hash()
+{
+	delete d_ptr;
+}
+
+/**
+ * Is the SHA-1 hash object usable?
+ * @return True if usable; false if not.
+ */
+bool SHA1Hash::isUsable(void) const
+{
+	// Nettle is always usable.
+	return true;
+}
+
+/**
+ * Reset the hash object so a new hash can be calculated.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1Hash::reset(void)
+{
+	RP_D(SHA1Hash);
+	sha1_init(&d->ctx);
+	return 0;
+}
+
+/**
+ * Add data to the hash.
+ * Data can be added in chunks of any size.
+ * @param pData		[in] Input data.
+ * @param len		[in] Data length.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1Hash::process(const void *pData, size_t len)
+{
+	assert(pData != nullptr || len == 0);
+	if (!pData && len != 0) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	RP_D(SHA1Hash);
+	sha1_update(&d->ctx, len, static_cast<const uint8_t*>(pData));
+	return 0;
+}
+
+/**
+ * Get the hash of the data added since the last reset().
+ * The hash object must be reset before it can be reused.
+ * @param pHash		[out] Output hash buffer. (Must be 20 bytes.)
+ * @param hash_len	[in] Size of hash buffer.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1Hash::getHash(uint8_t *pHash, size_t hash_len)
+{
+	assert(pHash != nullptr);
+	assert(hash_len == HASH_LEN);
+	if (!pHash || hash_len != HASH_LEN) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	// NOTE: sha1_digest() also resets the context.
+	RP_D(SHA1Hash);
+	sha1_digest(&d->ctx, hash_len, pHash);
+	return 0;
+}
+
+/**
+ * Calculate the SHA-1 hash of the specified data.
+ * @param pHash		[out] Output hash buffer. (Must be 20 bytes.)
+ * @param hash_len	[in] Size of hash buffer.
+ * @param pData		[in] Input data.
+ * @param len		[in] Data length.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SHA1Hash::calcHash(uint8_t *pHash, size_t hash_len, const void *pData, size_t len)
+{
+	struct sha1_ctx sha1;
+
+	assert(pHash != nullptr);
+	assert(hash_len == HASH_LEN);
+	assert(pData != nullptr);
+	if (!pHash || hash_len != HASH_LEN || !pData) {
+		// Invalid parameters.
+		return -EINVAL;
+	}
+
+	sha1_init(&sha1);
+	sha1_update(&sha1, len, static_cast<const uint8_t*>(pData));
+	sha1_digest(&sha1, hash_len, pHash);
+	return 0;
+}
+
+}
@@ -0,0 +1,86 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * SHA256Hash.hpp: SHA-256 hash class.                                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_CRYPTO_SHA256HASH_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_CRYPTO_SHA256HASH_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stddef.h>	/* size_t */
+#include <stdint.h>
+
+namespace LibRpBase {
+
+class SHA256HashPrivate;
+class SHA256Hash
+{
+	public:
+		SHA256Hash();
+		~SHA256Hash();
+
+	private:
+		RP_DISABLE_COPY(SHA256Hash)
+	private:
+		friend class SHA256HashPrivate;
+		SHA256HashPrivate *const d_ptr;
+
+	public:
+		/**
+		 * SHA-256 hash length, in bytes.
+		 */
+		static const size_t HASH_LEN = 32;
+
+		/**
+		 * Is the SHA-256 hash object usable?
+		 * @return True if usable; false if not.
+		 */
+		bool isUsable(void) const;
+
+		/**
+		 * Reset the hash object so a new hash can be calculated.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int reset(void);
+
+		/**
+		 * Add data to the hash.
+		 * Data can be added in chunks of any size.
+		 * @param pData		[in] Input data.
+		 * @param len		[in] Data length.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int process(const void *pData, size_t len);
+
+		/**
+		 * Get the hash of the data added since the last reset().
+		 * The hash object must be reset before it can be reused.
+		 * @param pHash		[out] Output hash buffer. (Must be 32 bytes.)
+		 * @param hash_len	[in] Size of hash buffer.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 2, 3)
+		int getHash(uint8_t *pHash, size_t hash_len);
+
+		/**
+		 * Calculate the SHA-256 hash of the specified data.
+		 * @param pHash		[out] Output hash buffer. (Must be 32 bytes.)
+		 * @param hash_len	[in] Size of hash buffer.
+		 * @param pData		[in] Input data.
+		 * @param len		[in] Data length.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 1, 2)
+		ATTR_ACCESS_SIZE(read_only, 3, 4)
+		static int calcHash(uint8_t *pHash, size_t hash_len, const void *pData, size_t len);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_CRYPTO_SHA256HASH_HPP__ */
@@ -47,6 +47,28 @@ class CBCReaderPrivate
 		uint8_t key[16];
 		uint8_t iv[16];
 		LibRpBase::IAesCipher *cipher;
+		bool isCBC;
+
+		// Running IV for CBC chaining.
+		// This is the last ciphertext block before chain_pos.
+		off64_t chain_pos;	// -1 if invalid
+		uint8_t chain_iv[16];
+
+		// Last decrypted block, for unaligned reads.
+		off64_t blk_pos;	// -1 if invalid
+		uint8_t blk_data[16];
+
+		/**
+		 * Read and decrypt full blocks.
+		 * The IV is taken from the running IV if the read
+		 * continues the previous one; otherwise, it's read
+		 * from the preceding ciphertext block.
+		 * @param pos_block	[in] Starting position. (Must be 16-byte aligned.)
+		 * @param buf		[out] Output buffer.
+		 * @param size		[in] Size to read. (Must be a multiple of 16.)
+		 * @return Number of bytes read and decrypted on success; 0 on error.
+		 */
+		size_t readBlocks(off64_t pos_block, uint8_t *buf, size_t size);
 #endif /* ENABLE_DECRYPTION */
 };
 
@@ -61,6 +83,9 @@ CBCReaderPrivate::CBCReaderPrivate(CBCReader *q,
 	, pos(0)
 #ifdef ENABLE_DECRYPTION
 	, cipher(nullptr)
+	, isCBC(iv != nullptr)
+	, chain_pos(-1)
+	, blk_pos(-1)
 #endif
 {
 	assert(q->m_file != nullptr);
@@ -118,6 +143,86 @@ CBCReaderPrivate::~CBCReaderPrivate()
 #endif /* ENABLE_DECRYPTION */
 }
 
+#ifdef ENABLE_DECRYPTION
+/**
+ * Read and decrypt full blocks.
+ * The IV is taken from the running IV if the read
+ * continues the previous one; otherwise, it's read
+ * from the preceding ciphertext block.
+ * @param pos_block	[in] Starting position. (Must be 16-byte aligned.)
+ * @param buf		[out] Output buffer.
+ * @param size		[in] Size to read. (Must be a multiple of 16.)
+ * @return Number of bytes read and decrypted on success; 0 on error.
+ */
+size_t CBCReaderPrivate::readBlocks(off64_t pos_block, uint8_t *buf, size_t size)
+{
+	assert((pos_block & 15) == 0);
+	assert((size & 15) == 0);
+	assert(size != 0);
+	LibRpFile::IRpFile *const file = q_ptr->m_file;
+
+	if (isCBC) {
+		const uint8_t *pIV;
+		if (pos_block == 0) {
+			// Start of data.
+			// Use the specified IV.
+			pIV = this->iv;
+		} else {
+			if (pos_block != chain_pos) {
+				// Not continuing the previous read.
+				// Read the IV from the previous 16 bytes.
+				chain_pos = -1;
+				size_t sz_read = file->seekAndRead(offset + pos_block - 16, chain_iv, sizeof(chain_iv));
+				if (sz_read != sizeof(chain_iv)) {
+					// Read error.
+					q_ptr->m_lastError = file->lastError();
+					if (q_ptr->m_lastError == 0) {
+						q_ptr->m_lastError = EIO;
+					}
+					return 0;
+				}
+				chain_pos = pos_block;
+			}
+			pIV = chain_iv;
+		}
+
+		// Set the IV.
+		int ret = cipher->setIV(pIV, 16);
+		if (ret != 0) {
+			// setIV() failed.
+			q_ptr->m_lastError = EIO;
+			return 0;
+		}
+	}
+
+	size_t sz_read = file->seekAndRead(offset + pos_block, buf, size);
+	if (sz_read != size) {
+		// Short read.
+		// Cannot decrypt with a short read.
+		q_ptr->m_lastError = file->lastError();
+		if (q_ptr->m_lastError == 0) {
+			q_ptr->m_lastError = EIO;
+		}
+		return 0;
+	}
+
+	if (isCBC) {
+		// Save the last ciphertext block as the running IV.
+		memcpy(chain_iv, &buf[size - 16], sizeof(chain_iv));
+		chain_pos = pos_block + size;
+	}
+
+	// Decrypt the data.
+	size_t sz_dec = cipher->decrypt(buf, size);
+	if (sz_dec != size) {
+		// decrypt() failed.
+		q_ptr->m_lastError = EIO;
+		return 0;
+	}
+	return size;
+}
+#endif /* ENABLE_DECRYPTION */
+
 /** CBCReader **/
 
 /**
@@ -201,76 +306,25 @@ size_t CBCReader::read(void *ptr, size_t size)
 #ifdef ENABLE_DECRYPTION
 	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
 
-	// TODO: Check for overflow.
-	if (d->pos + (off64_t)size > d->length) {
-		// Reduce size so it doesn't go out of bounds.
-		size = d->length - d->pos;
-	}
-
-	uint8_t iv[16];
-
-	// Read the first block.
-	// NOTE: If we're in the middle of a block, round it down.
-	const off64_t pos_block = d->pos & ~15LL;
-
 	// Total number of bytes read.
 	size_t total_sz_read = 0;
 
-	// Get the IV.
-	if (pos_block == 0) {
-		// Start of data.
-		// Use the specified IV.
-		memcpy(iv, d->iv, sizeof(iv));
-		m_file->seek(d->offset);
-	} else {
-		// Not start of data.
-		// Read the IV from the previous 16 bytes.
-		// TODO: Cache it!
-		m_file->seek(d->offset + pos_block - 16);
-		size_t sz_read = m_file->read(iv, sizeof(iv));
-		if (sz_read != sizeof(iv)) {
-			// Read error.
-			m_lastError = m_file->lastError();
-			if (m_lastError == 0) {
-				m_lastError = EIO;
-			}
-			return 0;
-		}
-	}
-
-	// Set the IV.
-	int ret = d->cipher->setIV(iv, sizeof(iv));
-	if (ret != 0) {
-		// setIV() failed.
-		m_lastError = EIO;
-		return 0;
-	}
-
-	uint8_t block_tmp[16];
-	if (d->pos != pos_block) {
+	if (d->pos & 15) {
 		// We're in the middle of a block.
-		// Read and decrypt the full block, and copy out
-		// the necessary bytes.
-		const size_t sz = std::min(16U - (static_cast<size_t>(d->pos) & 15U), size);
-		size_t sz_read = m_file->read(block_tmp, sizeof(block_tmp));
-		if (sz_read != sizeof(block_tmp)) {
-			// Read error.
-			m_lastError = m_file->lastError();
-			if (m_lastError == 0) {
-				m_lastError = EIO;
+		// Decrypt the full block if it isn't cached already,
+		// and copy out the necessary bytes.
+		const off64_t pos_block = d->pos & ~15LL;
+		if (d->blk_pos != pos_block) {
+			d->blk_pos = -1;
+			if (d->readBlocks(pos_block, d->blk_data, sizeof(d->blk_data)) != sizeof(d->blk_data)) {
+				// Read and/or decrypt error.
+				return 0;
 			}
-			return 0;
-		}
-
-		// Decrypt the data.
-		size_t sz_dec = d->cipher->decrypt(block_tmp, sizeof(block_tmp));
-		if (sz_dec != sizeof(block_tmp)) {
-			// decrypt() failed.
-			m_lastError = EIO;
-			return 0;
+			d->blk_pos = pos_block;
 		}
 
-		memcpy(ptr8, &block_tmp[d->pos & 15], sz);
+		const size_t sz = std::min(16U - (static_cast<size_t>(d->pos) & 15U), size);
+		memcpy(ptr8, &d->blk_data[d->pos & 15], sz);
 		ptr8 += sz;
 		size -= sz;
 		total_sz_read += sz;
@@ -278,56 +332,32 @@ size_t CBCReader::read(void *ptr, size_t size)
 	}
 
 	// Read full blocks.
-	size_t full_block_sz = size & ~15LL;
+	// These are decrypted in place using a single cipher call.
+	const size_t full_block_sz = size & ~(size_t)15;
 	if (full_block_sz > 0) {
-		size_t sz_read = m_file->read(ptr8, full_block_sz);
-		if (sz_read != full_block_sz) {
-			// Short read.
-			// Cannot decrypt with a short read.
-			m_lastError = m_file->lastError();
-			if (m_lastError == 0) {
-				m_lastError = EIO;
-			}
-			return 0;
-		}
-
-		// Decrypt the data.
-		size_t sz_dec = d->cipher->decrypt(ptr8, full_block_sz);
-		if (sz_dec != full_block_sz) {
-			// decrypt() failed.
-			m_lastError = EIO;
+		if (d->readBlocks(d->pos, ptr8, full_block_sz) != full_block_sz) {
+			// Read and/or decrypt error.
 			return 0;
 		}
 
-		ptr8 += sz_read;
-		size -= sz_read;
-		total_sz_read += sz_read;
-		d->pos += sz_read;
+		ptr8 += full_block_sz;
+		size -= full_block_sz;
+		total_sz_read += full_block_sz;
+		d->pos += full_block_sz;
 	}
 
 	if (size > 0) {
 		// We need to decrypt a partial block at the end.
-		// Read and decrypt the full block, and copy out
-		// the necessary bytes.
-		size_t sz_read = m_file->read(block_tmp, sizeof(block_tmp));
-		if (sz_read != sizeof(block_tmp)) {
-			// Read error.
-			m_lastError = m_file->lastError();
-			if (m_lastError == 0) {
-				m_lastError = EIO;
-			}
-			return 0;
-		}
-
-		// Decrypt the data.
-		size_t sz_dec = d->cipher->decrypt(block_tmp, sizeof(block_tmp));
-		if (sz_dec != sizeof(block_tmp)) {
-			// decrypt() failed.
-			m_lastError = EIO;
+		// Keep the decrypted block so the next sequential
+		// read can use it without any additional I/O.
+		d->blk_pos = -1;
+		if (d->readBlocks(d->pos, d->blk_data, sizeof(d->blk_data)) != sizeof(d->blk_data)) {
+			// Read and/or decrypt error.
 			return 0;
 		}
+		d->blk_pos = d->pos;
 
-		memcpy(ptr8, block_tmp, size);
+		memcpy(ptr8, d->blk_data, size);
 		ptr8 += size;
 		total_sz_read += size;
 		d->pos += size;
@@ -14,6 +14,9 @@
 // librpfile
 using LibRpFile::IRpFile;
 
+// C++ STL classes.
+using std::vector;
+
 namespace LibRpBase {
 
 /**
@@ -144,6 +147,110 @@ int DiscReader::seek(off64_t pos)
 	return ret;
 }
 
+/**
+ * Read data from the specified disc image position.
+ * The request is passed through to IRpFile::pread().
+ *
+ * NOTE: The disc image position is undefined afterwards.
+ *
+ * @param pos	[in] Disc image position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t DiscReader::pread(off64_t pos, void *ptr, size_t size)
+{
+	assert(m_file != nullptr);
+	if (!m_file) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (pos < 0 || pos >= m_length) {
+		// Out of range.
+		return 0;
+	}
+
+	// Constrain size based on offset and length.
+	if (pos + static_cast<off64_t>(size) > m_length) {
+		size = static_cast<size_t>(m_length - pos);
+	}
+
+	size_t ret = m_file->pread(m_offset + pos, ptr, size);
+	m_lastError = m_file->lastError();
+	return ret;
+}
+
+/**
+ * Read data from multiple disc image positions.
+ * The requests are passed through to IRpFile::readv().
+ *
+ * NOTE: The disc image position is undefined afterwards.
+ *
+ * @param vec	[in] Read requests.
+ * @param count	[in] Number of read requests.
+ * @return 0 if all requests were read completely; negative POSIX error code on error.
+ */
+int DiscReader::readv(const ReadVec *vec, size_t count)
+{
+	assert(m_file != nullptr);
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -EBADF;
+	}
+	assert(vec != nullptr || count == 0);
+	if (!vec && count > 0) {
+		return -EINVAL;
+	}
+
+	// Adjust the requests for the starting offset.
+	// Requests outside of the disc image can't be fully read.
+	vector<ReadVec> fvec(vec, vec + count);
+	for (ReadVec &rv : fvec) {
+		if (rv.pos < 0 || rv.pos + static_cast<off64_t>(rv.size) > m_length) {
+			m_lastError = EIO;
+			return -EIO;
+		}
+		rv.pos += m_offset;
+	}
+
+	int ret = m_file->readv(fvec.data(), fvec.size());
+	if (ret != 0) {
+		m_lastError = -ret;
+	}
+	return ret;
+}
+
+/**
+ * Hint that the specified disc image ranges will be read soon.
+ * The ranges are passed through to IRpFile::prefetchv().
+ * @param ranges	[in] Disc image ranges.
+ * @param count		[in] Number of ranges.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int DiscReader::prefetchv(const Range *ranges, size_t count)
+{
+	if (!m_file) {
+		return -EBADF;
+	}
+	assert(ranges != nullptr || count == 0);
+	if (!ranges && count > 0) {
+		return -EINVAL;
+	}
+
+	// Adjust the ranges for the starting offset.
+	// Ranges outside of the disc image are skipped.
+	vector<Range> franges;
+	franges.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		const Range &r = ranges[i];
+		if (r.pos < 0 || r.pos >= m_length || r.size == 0)
+			continue;
+		const off64_t size = std::min(static_cast<off64_t>(r.size), m_length - r.pos);
+		franges.push_back({r.pos + m_offset, static_cast<size_t>(size)});
+	}
+
+	return m_file->prefetchv(franges.data(), franges.size());
+}
+
 /**
  * Get the disc image position.
  * @return Partition position on success; -1 on error.
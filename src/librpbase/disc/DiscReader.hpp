@@ -78,6 +78,43 @@ class DiscReader : public IDiscReader
 		 */
 		int seek(off64_t pos) override;
 
+		/**
+		 * Read data from the specified disc image position.
+		 * The request is passed through to IRpFile::pread().
+		 *
+		 * NOTE: The disc image position is undefined afterwards.
+		 *
+		 * @param pos	[in] Disc image position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		size_t pread(off64_t pos, void *ptr, size_t size) override;
+
+		/**
+		 * Read data from multiple disc image positions.
+		 * The requests are passed through to IRpFile::readv().
+		 *
+		 * NOTE: The disc image position is undefined afterwards.
+		 *
+		 * @param vec	[in] Read requests.
+		 * @param count	[in] Number of read requests.
+		 * @return 0 if all requests were read completely; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int readv(const ReadVec *vec, size_t count) override;
+
+		/**
+		 * Hint that the specified disc image ranges will be read soon.
+		 * The ranges are passed through to IRpFile::prefetchv().
+		 * @param ranges	[in] Disc image ranges.
+		 * @param count		[in] Number of ranges.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int prefetchv(const Range *ranges, size_t count) override;
+
 		/**
 		 * Get the disc image position.
 		 * @return Disc image position on success; -1 on error.
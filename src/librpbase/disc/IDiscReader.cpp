@@ -76,6 +76,99 @@ size_t IDiscReader::seekAndRead(off64_t pos, void *ptr, size_t size)
 	return this->read(ptr, size);
 }
 
+/** Positional reads **/
+
+/**
+ * Read data from the specified disc image position.
+ *
+ * The default implementation calls seekAndRead(). Subclasses
+ * that can map disc image positions without using the disc
+ * image position should override this function.
+ *
+ * NOTE: The disc image position is undefined afterwards.
+ *
+ * @param pos	[in] Disc image position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t IDiscReader::pread(off64_t pos, void *ptr, size_t size)
+{
+	return seekAndRead(pos, ptr, size);
+}
+
+/** Vectored reads **/
+
+/**
+ * Read data from multiple disc image positions.
+ *
+ * The default implementation calls pread() for each
+ * request. Subclasses that pass reads through to an IRpFile
+ * should override this function to use IRpFile::readv().
+ *
+ * NOTE: The disc image position is undefined afterwards.
+ *
+ * @param vec	[in] Read requests.
+ * @param count	[in] Number of read requests.
+ * @return 0 if all requests were read completely; negative POSIX error code on error.
+ */
+int IDiscReader::readv(const ReadVec *vec, size_t count)
+{
+	assert(vec != nullptr || count == 0);
+	if (!vec && count > 0) {
+		return -EINVAL;
+	}
+
+	for (; count > 0; vec++, count--) {
+		if (vec->size == 0)
+			continue;
+		if (pread(vec->pos, vec->ptr, vec->size) != vec->size) {
+			// Seek and/or read error.
+			return (m_lastError != 0 ? -m_lastError : -EIO);
+		}
+	}
+	return 0;
+}
+
+/** Access pattern hints **/
+
+/**
+ * Advise the disc image of the expected access pattern.
+ *
+ * The default implementation passes the hint through to
+ * the underlying file or IDiscReader.
+ *
+ * @param pattern Access pattern.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int IDiscReader::adviseAccess(AccessPattern pattern)
+{
+	if (!m_hasDiscReader) {
+		return (m_file ? m_file->adviseAccess(pattern) : -EBADF);
+	} else {
+		return (m_discReader ? m_discReader->adviseAccess(pattern) : -EBADF);
+	}
+}
+
+/**
+ * Hint that the specified disc image ranges will be read soon.
+ *
+ * This is only a hint; the default implementation does nothing,
+ * since disc image positions don't necessarily map directly to
+ * positions in the underlying file. Subclasses that do map
+ * positions directly should pass the ranges through.
+ *
+ * @param ranges	[in] Disc image ranges.
+ * @param count		[in] Number of ranges.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int IDiscReader::prefetchv(const Range *ranges, size_t count)
+{
+	RP_UNUSED(ranges);
+	RP_UNUSED(count);
+	return 0;
+}
+
 /** Device file functions **/
 
 /**
@@ -19,9 +19,8 @@
 #include "common.h"
 #include "RefBase.hpp"
 
-namespace LibRpFile {
-	class IRpFile;
-}
+// librpfile
+#include "librpfile/IRpFile.hpp"
 
 namespace LibRpBase {
 
@@ -128,6 +127,94 @@ class IDiscReader : public RefBase
 		ATTR_ACCESS_SIZE(write_only, 3, 4)
 		size_t seekAndRead(off64_t pos, void *ptr, size_t size);
 
+	public:
+		/** Positional reads **/
+
+		/**
+		 * Read data from the specified disc image position.
+		 *
+		 * The default implementation calls seekAndRead(). Subclasses
+		 * that can map disc image positions without using the disc
+		 * image position should override this function.
+		 *
+		 * NOTE: The disc image position is undefined afterwards.
+		 *
+		 * @param pos	[in] Disc image position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		virtual size_t pread(off64_t pos, void *ptr, size_t size);
+
+	public:
+		/** Vectored reads **/
+
+		// Read request for readv().
+		typedef LibRpFile::IRpFile::ReadVec ReadVec;
+
+		/**
+		 * Read data from multiple disc image positions.
+		 *
+		 * The default implementation calls pread() for each
+		 * request. Subclasses that pass reads through to an IRpFile
+		 * should override this function to use IRpFile::readv().
+		 *
+		 * NOTE: The disc image position is undefined afterwards.
+		 *
+		 * @param vec	[in] Read requests.
+		 * @param count	[in] Number of read requests.
+		 * @return 0 if all requests were read completely; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		virtual int readv(const ReadVec *vec, size_t count);
+
+	public:
+		/** Access pattern hints **/
+
+		// Access pattern for adviseAccess().
+		typedef LibRpFile::IRpFile::AccessPattern AccessPattern;
+		// File range for prefetchv().
+		typedef LibRpFile::IRpFile::Range Range;
+
+		/**
+		 * Advise the disc image of the expected access pattern.
+		 *
+		 * The default implementation passes the hint through to
+		 * the underlying file or IDiscReader.
+		 *
+		 * @param pattern Access pattern.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int adviseAccess(AccessPattern pattern);
+
+		/**
+		 * Hint that the specified disc image ranges will be read soon.
+		 *
+		 * This is only a hint; the default implementation does nothing,
+		 * since disc image positions don't necessarily map directly to
+		 * positions in the underlying file. Subclasses that do map
+		 * positions directly should pass the ranges through.
+		 *
+		 * @param ranges	[in] Disc image ranges.
+		 * @param count		[in] Number of ranges.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		virtual int prefetchv(const Range *ranges, size_t count);
+
+		/**
+		 * Hint that the specified disc image range will be read soon.
+		 * @param pos	[in] Disc image position.
+		 * @param size	[in] Size, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		inline int prefetch(off64_t pos, size_t size)
+		{
+			const Range range = {pos, size};
+			return prefetchv(&range, 1);
+		}
+
 	public:
 		/** Device file functions **/
 
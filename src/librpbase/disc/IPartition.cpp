@@ -0,0 +1,395 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * IPartition.cpp: Partition reader interface.                             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "IPartition.hpp"
+
+// librpfile
+#include "librpfile/IRpFile.hpp"
+using LibRpFile::IRpFile;
+
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::ThreadPool;
+
+// C++ STL classes.
+using std::unique_ptr;
+using std::vector;
+
+namespace LibRpBase {
+
+/**
+ * Shared block cache.
+ * Blocks are evicted in least-recently-used order.
+ */
+struct IPartition::BlockCache
+{
+	// Block size. (Same as the Wii sector size.)
+	static const unsigned int BLOCK_SIZE = 32768;
+	// Maximum number of cached blocks. (512 KB total)
+	static const unsigned int MAX_BLOCKS = 16;
+	// Reads this size or larger bypass the cache.
+	static const size_t BYPASS_SIZE = BLOCK_SIZE * 4;
+
+	struct Entry {
+		off64_t blockIdx;	// Block index, or -1 if unused.
+		unsigned int len;	// Valid data length. (may be short at EOF)
+		unsigned int lru;	// LRU counter value when last used.
+	};
+	Entry entries[MAX_BLOCKS];
+	unique_ptr<uint8_t[]> data;	// MAX_BLOCKS * BLOCK_SIZE
+	unsigned int lru_counter;
+
+	BlockCache()
+		: data(new uint8_t[MAX_BLOCKS * BLOCK_SIZE])
+		, lru_counter(0)
+	{
+		clear();
+	}
+
+	inline void clear(void)
+	{
+		for (Entry &entry : entries) {
+			entry.blockIdx = -1;
+			entry.len = 0;
+			entry.lru = 0;
+		}
+	}
+
+	/**
+	 * Find a cached block.
+	 * @param blockIdx Block index.
+	 * @return Entry index, or -1 if not cached.
+	 */
+	int find(off64_t blockIdx)
+	{
+		for (unsigned int i = 0; i < MAX_BLOCKS; i++) {
+			if (entries[i].blockIdx == blockIdx) {
+				entries[i].lru = ++lru_counter;
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * Get the least-recently-used entry for replacement.
+	 * @return Entry index.
+	 */
+	unsigned int victim(void) const
+	{
+		unsigned int ret = 0;
+		for (unsigned int i = 1; i < MAX_BLOCKS; i++) {
+			if (entries[i].blockIdx < 0) {
+				// Unused entry.
+				return i;
+			}
+			if (entries[i].lru < entries[ret].lru) {
+				ret = i;
+			}
+		}
+		return ret;
+	}
+
+	inline uint8_t *block(unsigned int idx)
+	{
+		return &data[idx * BLOCK_SIZE];
+	}
+};
+
+IPartition::~IPartition()
+{
+	delete m_blockCache;
+}
+
+/** Block cache **/
+
+/**
+ * Read data using the partition's shared block cache.
+ *
+ * PartitionFile uses this, so multiple files opened on
+ * the same partition share the cached blocks instead of
+ * each going down to the partition separately.
+ *
+ * Large reads bypass the cache.
+ *
+ * NOTE: The partition position is undefined afterwards.
+ *
+ * @param pos		[in] Partition offset.
+ * @param ptr		[out] Output data buffer.
+ * @param size		[in] Amount of data to read, in bytes.
+ * @param readahead	[in] Number of bytes to read ahead on a cache miss.
+ * @return Number of bytes read.
+ */
+size_t IPartition::cachedRead(off64_t pos, void *ptr, size_t size, size_t readahead)
+{
+	if (size >= BlockCache::BYPASS_SIZE) {
+		// Large read. Don't pollute the cache.
+		return seekAndRead(pos, ptr, size);
+	}
+
+	if (!m_blockCache) {
+		m_blockCache = new BlockCache();
+	}
+	BlockCache *const cache = m_blockCache;
+	static const unsigned int BLOCK_SIZE = BlockCache::BLOCK_SIZE;
+
+	// Number of blocks to read on a cache miss.
+	// Limited to half of the cache so readahead can't
+	// evict everything else.
+	unsigned int missBlocks = 1 + static_cast<unsigned int>(
+		std::min(readahead / BLOCK_SIZE, static_cast<size_t>(BlockCache::MAX_BLOCKS / 2 - 1)));
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t ret = 0;
+	while (size > 0) {
+		const off64_t blockIdx = pos / BLOCK_SIZE;
+		const unsigned int blockOffset = static_cast<unsigned int>(pos % BLOCK_SIZE);
+
+		int idx = cache->find(blockIdx);
+		if (idx < 0) {
+			// Cache miss. Read the block, plus any readahead blocks
+			// that aren't already cached.
+			for (unsigned int i = 0; i < missBlocks; i++) {
+				if (i > 0 && cache->find(blockIdx + i) >= 0)
+					break;
+
+				const unsigned int v = cache->victim();
+				BlockCache::Entry &entry = cache->entries[v];
+				entry.blockIdx = -1;
+				const size_t len = seekAndRead((blockIdx + i) * BLOCK_SIZE, cache->block(v), BLOCK_SIZE);
+				if (len == 0)
+					break;
+				entry.blockIdx = blockIdx + i;
+				entry.len = static_cast<unsigned int>(len);
+				entry.lru = ++cache->lru_counter;
+				if (i == 0) {
+					idx = static_cast<int>(v);
+				}
+				if (len != BLOCK_SIZE)
+					break;
+			}
+			// Readahead only applies to the first miss.
+			missBlocks = 1;
+
+			if (idx < 0) {
+				// Read error.
+				break;
+			}
+		}
+
+		const BlockCache::Entry &entry = cache->entries[idx];
+		if (blockOffset >= entry.len) {
+			// End of partition.
+			break;
+		}
+		const size_t cb = std::min(size, static_cast<size_t>(entry.len - blockOffset));
+		memcpy(ptr8, cache->block(idx) + blockOffset, cb);
+		ptr8 += cb;
+		pos += cb;
+		size -= cb;
+		ret += cb;
+
+		if (entry.len != BLOCK_SIZE) {
+			// Short block. No more data is available.
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * Clear the block cache.
+ */
+void IPartition::clearBlockCache(void)
+{
+	if (m_blockCache) {
+		m_blockCache->clear();
+	}
+}
+
+/** Bulk extraction **/
+
+/**
+ * Find a file's extent within the partition.
+ * The offset is the same one PartitionFile uses.
+ *
+ * The default implementation returns -ENOTSUP.
+ *
+ * @param filename	[in] Filename.
+ * @param pOffset	[out] Partition offset.
+ * @param pSize		[out] File size.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int IPartition::findFileExtent(const char *filename, off64_t *pOffset, off64_t *pSize)
+{
+	RP_UNUSED(filename);
+	RP_UNUSED(pOffset);
+	RP_UNUSED(pSize);
+	return -ENOTSUP;
+}
+
+/**
+ * Extract multiple files.
+ *
+ * Files are read in partition offset order, not request order,
+ * using large sequential reads. Files that are close together
+ * share reads. Reading the next chunk is overlapped with writing
+ * the current chunk to the output sinks, so decryption and/or
+ * decompression done by the partition's read function runs
+ * in parallel with the writes.
+ *
+ * @param requests	[in/out] Extraction requests.
+ * @return 0 if all files were extracted; otherwise, the first error. (negative POSIX error code)
+ */
+int IPartition::extractFiles(vector<ExtractRequest> &requests)
+{
+	// Read chunk size.
+	static const size_t CHUNK_SIZE = 2*1024*1024;
+	// Gaps up to this size are read through instead of seeking.
+	static const off64_t MAX_GAP = 64*1024;
+
+	struct Extent {
+		off64_t offset;
+		off64_t size;
+		ExtractRequest *req;
+	};
+
+	// Resolve all of the files.
+	vector<Extent> extents;
+	extents.reserve(requests.size());
+	for (ExtractRequest &req : requests) {
+		req.err = 0;
+		if (!req.filename || !req.out) {
+			req.err = -EINVAL;
+			continue;
+		}
+
+		Extent ext;
+		req.err = findFileExtent(req.filename, &ext.offset, &ext.size);
+		if (req.err != 0)
+			continue;
+		ext.req = &req;
+		if (ext.size > 0) {
+			extents.push_back(ext);
+		}
+	}
+
+	// Sort by partition offset.
+	std::sort(extents.begin(), extents.end(),
+		[](const Extent &a, const Extent &b) { return a.offset < b.offset; });
+
+	// Split the extents into sequential runs.
+	// A run is [start, end).
+	struct Run {
+		off64_t start, end;
+	};
+	vector<Run> runs;
+	for (const Extent &ext : extents) {
+		const off64_t ext_end = ext.offset + ext.size;
+		if (!runs.empty() && ext.offset <= runs.back().end + MAX_GAP) {
+			if (ext_end > runs.back().end) {
+				runs.back().end = ext_end;
+			}
+		} else {
+			runs.push_back({ext.offset, ext_end});
+		}
+	}
+
+	// Split the runs into chunks.
+	vector<Run> chunks;
+	for (const Run &run : runs) {
+		for (off64_t pos = run.start; pos < run.end; pos += CHUNK_SIZE) {
+			chunks.push_back({pos, std::min(pos + static_cast<off64_t>(CHUNK_SIZE), run.end)});
+		}
+	}
+
+	if (!chunks.empty()) {
+		// Double-buffered pipeline:
+		// - Item 0 reads the next chunk.
+		// - Item 1 writes the current chunk to the output sinks.
+		unique_ptr<uint8_t[]> buf[2];
+		buf[0].reset(new uint8_t[CHUNK_SIZE]);
+		buf[1].reset(new uint8_t[CHUNK_SIZE]);
+		size_t len[2] = {0, 0};
+		int readErr[2] = {0, 0};
+
+		auto readChunk = [&](size_t chunkIdx, unsigned int bufIdx) {
+			const Run &chunk = chunks[chunkIdx];
+			const size_t size = static_cast<size_t>(chunk.end - chunk.start);
+			len[bufIdx] = seekAndRead(chunk.start, buf[bufIdx].get(), size);
+			readErr[bufIdx] = 0;
+			if (len[bufIdx] != size) {
+				readErr[bufIdx] = (m_lastError != 0 ? -m_lastError : -EIO);
+			}
+		};
+
+		// First extent that hasn't been fully written.
+		// Chunks are in offset order, so this only moves forward.
+		size_t firstExt = 0;
+		auto writeChunk = [&](size_t chunkIdx, unsigned int bufIdx) {
+			const Run &chunk = chunks[chunkIdx];
+			const off64_t valid_end = chunk.start + static_cast<off64_t>(len[bufIdx]);
+			while (firstExt < extents.size() &&
+			       extents[firstExt].offset + extents[firstExt].size <= chunk.start)
+			{
+				firstExt++;
+			}
+
+			for (size_t i = firstExt; i < extents.size(); i++) {
+				Extent &ext = extents[i];
+				if (ext.offset >= chunk.end)
+					break;
+				const off64_t ext_end = ext.offset + ext.size;
+				if (ext_end <= chunk.start || ext.req->err != 0)
+					continue;
+
+				// Overlapping part of this chunk.
+				const off64_t start = std::max(ext.offset, chunk.start);
+				const off64_t end = std::min(ext_end, chunk.end);
+				if (end > valid_end) {
+					// Short read.
+					ext.req->err = (readErr[bufIdx] != 0 ? readErr[bufIdx] : -EIO);
+					continue;
+				}
+
+				const size_t size = static_cast<size_t>(end - start);
+				const size_t size_written = ext.req->out->write(
+					&buf[bufIdx][start - chunk.start], size);
+				if (size_written != size) {
+					const int err = ext.req->out->lastError();
+					ext.req->err = (err != 0 ? -err : -EIO);
+				}
+			}
+		};
+
+		ThreadPool pool(2);
+		readChunk(0, 0);
+		for (size_t i = 0; i < chunks.size(); i++) {
+			const unsigned int cur = (i & 1);
+			const bool hasNext = (i + 1 < chunks.size());
+			pool.parallelFor(hasNext ? 2 : 1, [&](size_t item) {
+				if (item == 0) {
+					writeChunk(i, cur);
+				} else {
+					readChunk(i + 1, cur ^ 1);
+				}
+			});
+		}
+	}
+
+	// Return the first error, in request order.
+	for (const ExtractRequest &req : requests) {
+		if (req.err != 0)
+			return req.err;
+	}
+	return 0;
+}
+
+}
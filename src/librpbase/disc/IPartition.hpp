@@ -11,13 +11,16 @@
 
 #include "IDiscReader.hpp"
 
+// C++ includes.
+#include <vector>
+
 namespace LibRpBase {
 
 class IPartition : public IDiscReader
 {
 	protected:
-		explicit IPartition(LibRpFile::IRpFile *file) : super(file) { }
-		explicit IPartition(IDiscReader *discReader) : super(discReader) { }
+		explicit IPartition(LibRpFile::IRpFile *file) : super(file), m_blockCache(nullptr) { }
+		explicit IPartition(IDiscReader *discReader) : super(discReader), m_blockCache(nullptr) { }
 	protected:
 		virtual ~IPartition() = 0;	// call unref() instead
 
@@ -59,14 +62,80 @@ class IPartition : public IDiscReader
 		 * @return Used partition size, or -1 on error.
 		 */
 		virtual off64_t partition_size_used(void) const = 0;
-};
 
-/**
- * Both gcc and MSVC fail to compile unless we provide
- * an empty implementation, even though the function is
- * declared as pure-virtual.
- */
-inline IPartition::~IPartition() { }
+	public:
+		/** Block cache **/
+
+		/**
+		 * Read data using the partition's shared block cache.
+		 *
+		 * PartitionFile uses this, so multiple files opened on
+		 * the same partition share the cached blocks instead of
+		 * each going down to the partition separately.
+		 *
+		 * Large reads bypass the cache.
+		 *
+		 * NOTE: The partition position is undefined afterwards.
+		 *
+		 * @param pos		[in] Partition offset.
+		 * @param ptr		[out] Output data buffer.
+		 * @param size		[in] Amount of data to read, in bytes.
+		 * @param readahead	[in] Number of bytes to read ahead on a cache miss.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		size_t cachedRead(off64_t pos, void *ptr, size_t size, size_t readahead = 0);
+
+		/**
+		 * Clear the block cache.
+		 */
+		void clearBlockCache(void);
+
+	public:
+		/** Bulk extraction **/
+
+		/**
+		 * Find a file's extent within the partition.
+		 * The offset is the same one PartitionFile uses.
+		 *
+		 * The default implementation returns -ENOTSUP.
+		 *
+		 * @param filename	[in] Filename.
+		 * @param pOffset	[out] Partition offset.
+		 * @param pSize		[out] File size.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int findFileExtent(const char *filename, off64_t *pOffset, off64_t *pSize);
+
+		/**
+		 * Bulk extraction request.
+		 */
+		struct ExtractRequest {
+			const char *filename;		// [in] Filename.
+			LibRpFile::IRpFile *out;	// [in] Output sink. (written sequentially)
+			int err;			// [out] 0 on success; negative POSIX error code on error.
+		};
+
+		/**
+		 * Extract multiple files.
+		 *
+		 * Files are read in partition offset order, not request order,
+		 * using large sequential reads. Files that are close together
+		 * share reads. Reading the next chunk is overlapped with writing
+		 * the current chunk to the output sinks, so decryption and/or
+		 * decompression done by the partition's read function runs
+		 * in parallel with the writes.
+		 *
+		 * @param requests	[in/out] Extraction requests.
+		 * @return 0 if all files were extracted; otherwise, the first error. (negative POSIX error code)
+		 */
+		int extractFiles(std::vector<ExtractRequest> &requests);
+
+	private:
+		// Shared block cache. (allocated on first use)
+		struct BlockCache;
+		BlockCache *m_blockCache;
+};
 
 }
 
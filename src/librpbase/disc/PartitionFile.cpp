@@ -8,10 +8,11 @@
 
 #include "stdafx.h"
 #include "PartitionFile.hpp"
-#include "IDiscReader.hpp"
+#include "IPartition.hpp"
 
 // C++ STL classes.
 using std::string;
+using std::vector;
 
 namespace LibRpBase {
 
@@ -27,11 +28,15 @@ PartitionFile::PartitionFile(IDiscReader *partition, off64_t offset, off64_t siz
 	, m_offset(offset)
 	, m_size(size)
 	, m_pos(0)
+	, m_readahead(0)
 {
 	if (partition) {
 		m_partition = partition->ref();
+		// If this is an IPartition, use its shared block cache.
+		m_cachePartition = dynamic_cast<IPartition*>(partition);
 	} else {
 		m_partition = nullptr;
+		m_cachePartition = nullptr;
 		m_lastError = EBADF;
 	}
 
@@ -59,6 +64,7 @@ bool PartitionFile::isOpen(void) const
 void PartitionFile::close(void)
 {
 	UNREF_AND_NULL(m_partition);
+	m_cachePartition = nullptr;
 }
 
 /**
@@ -68,39 +74,47 @@ void PartitionFile::close(void)
  * @return Number of bytes read.
  */
 size_t PartitionFile::read(void *ptr, size_t size)
+{
+	const size_t ret = this->pread(m_pos, ptr, size);
+	m_pos += ret;
+	return ret;
+}
+
+/**
+ * Read data from the specified file position.
+ * The file position is not changed.
+ * @param pos	[in] File position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t PartitionFile::pread(off64_t pos, void *ptr, size_t size)
 {
 	if (!m_partition) {
 		m_lastError = EBADF;
 		return 0;
+	} else if (pos < 0 || pos >= m_size) {
+		// Nothing left.
+		// TODO: Set an error?
+		return 0;
 	}
 
 	// Check if size is in bounds.
-	if (m_pos > m_size - static_cast<off64_t>(size)) {
+	if (pos > m_size - static_cast<off64_t>(size)) {
 		// Not enough data.
 		// Copy whatever's left in the file.
-		size = static_cast<size_t>(m_size - m_pos);
-		if (size == 0) {
-			// Nothing left.
-			// TODO: Set an error?
-			return 0;
-		}
+		size = static_cast<size_t>(m_size - pos);
 	}
 
 	m_partition->clearError();
-	int iRet = m_partition->seek(m_offset + m_pos);
-	if (iRet != 0) {
-		m_lastError = m_partition->lastError();
-		return 0;
-	}
-
-	size_t ret = 0;
-	if (size > 0) {
-		m_partition->clearError();
-		ret = m_partition->read(ptr, size);
-		m_pos += ret;
-		m_lastError = m_partition->lastError();
+	size_t ret;
+	if (m_cachePartition) {
+		// Read using the partition's shared block cache.
+		ret = m_cachePartition->cachedRead(m_offset + pos, ptr, size, m_readahead);
+	} else {
+		ret = m_partition->pread(m_offset + pos, ptr, size);
 	}
-
+	m_lastError = m_partition->lastError();
 	return ret;
 }
 
@@ -196,4 +210,52 @@ string PartitionFile::filename(void) const
 	return string();
 }
 
+/** Access pattern hints **/
+
+/**
+ * Advise the file of the expected access pattern.
+ * The hint is passed through to the IDiscReader.
+ * @param pattern Access pattern.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int PartitionFile::adviseAccess(AccessPattern pattern)
+{
+	if (!m_partition) {
+		return -EBADF;
+	}
+	return m_partition->adviseAccess(pattern);
+}
+
+/**
+ * Hint that the specified ranges will be read soon.
+ * The ranges are passed through to the IDiscReader.
+ * @param ranges	[in] File ranges.
+ * @param count		[in] Number of ranges.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int PartitionFile::prefetchv(const Range *ranges, size_t count)
+{
+	if (!m_partition) {
+		return -EBADF;
+	}
+	assert(ranges != nullptr || count == 0);
+	if (!ranges && count > 0) {
+		return -EINVAL;
+	}
+
+	// Adjust the ranges for the file's starting offset.
+	// Ranges outside of the file are skipped.
+	vector<Range> pranges;
+	pranges.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		const Range &r = ranges[i];
+		if (r.pos < 0 || r.pos >= m_size || r.size == 0)
+			continue;
+		const off64_t size = std::min(static_cast<off64_t>(r.size), m_size - r.pos);
+		pranges.push_back({r.pos + m_offset, static_cast<size_t>(size)});
+	}
+
+	return m_partition->prefetchv(pranges.data(), pranges.size());
+}
+
 }
@@ -14,6 +14,7 @@
 namespace LibRpBase {
 
 class IDiscReader;
+class IPartition;
 
 class PartitionFile : public LibRpFile::IRpFile
 {
@@ -55,6 +56,17 @@ class PartitionFile : public LibRpFile::IRpFile
 		ATTR_ACCESS_SIZE(write_only, 2, 3)
 		size_t read(void *ptr, size_t size) final;
 
+		/**
+		 * Read data from the specified file position.
+		 * The file position is not changed.
+		 * @param pos	[in] File position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
 		/**
 		 * Write data to the file.
 		 * (NOTE: Not valid for PartitionFile; this will always return 0.)
@@ -100,11 +112,52 @@ class PartitionFile : public LibRpFile::IRpFile
 		 */
 		std::string filename(void) const final;
 
+	public:
+		/** Access pattern hints **/
+
+		/**
+		 * Advise the file of the expected access pattern.
+		 * The hint is passed through to the IDiscReader.
+		 * @param pattern Access pattern.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int adviseAccess(AccessPattern pattern) final;
+
+		/**
+		 * Hint that the specified ranges will be read soon.
+		 * The ranges are passed through to the IDiscReader.
+		 * @param ranges	[in] File ranges.
+		 * @param count		[in] Number of ranges.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int prefetchv(const Range *ranges, size_t count) final;
+
+	public:
+		/**
+		 * Set the readahead hint.
+		 *
+		 * If the underlying reader is an IPartition, reads go
+		 * through the partition's shared block cache. On a cache
+		 * miss, this many extra bytes are read into the cache.
+		 * Use this for files that are read sequentially in
+		 * small chunks.
+		 *
+		 * @param readahead Readahead size, in bytes. (0 to disable)
+		 */
+		inline void setReadahead(size_t readahead)
+		{
+			m_readahead = readahead;
+		}
+
 	protected:
 		IDiscReader *m_partition;
 		off64_t m_offset;	// File starting offset.
 		off64_t m_size;		// File size.
 		off64_t m_pos;		// Current position.
+
+		IPartition *m_cachePartition;	// Same as m_partition if it's an IPartition.
+		size_t m_readahead;		// Readahead hint.
 };
 
 }
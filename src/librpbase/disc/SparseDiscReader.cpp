@@ -11,8 +11,18 @@
 #include "SparseDiscReader.hpp"
 #include "SparseDiscReader_p.hpp"
 
+// librpfile, librpthreads
+using namespace LibRpFile;
+using LibRpThreads::ThreadPool;
+
+// librpthreads
+#include "librpthreads/CancelToken.hpp"
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::CancelToken;
+
 // librpfile
-using LibRpFile::IRpFile;
+#include "librpfile/RpStats.hpp"
+#include "librpfile/RpTrace.hpp"
 
 namespace LibRpBase {
 
@@ -23,6 +33,17 @@ SparseDiscReaderPrivate::SparseDiscReaderPrivate(SparseDiscReader *q)
 	, disc_size(0)
 	, pos(-1)
 	, block_size(0)
+	, blockCacheBufSize(0)
+	, blockCacheTick(0)
+	, blockCacheHits(0)
+	, blockCacheMisses(0)
+	, parallelLoad(false)
+	, coalesceRuns(false)
+	, threadPool(nullptr)
+	, threadCount(1)
+	, readAheadCount(DEFAULT_READ_AHEAD_COUNT)
+	, seqNextPos(-1)
+	, seqCount(0)
 {
 	// NOTE: Can't check q->m_file here.
 
@@ -30,6 +51,348 @@ SparseDiscReaderPrivate::SparseDiscReaderPrivate(SparseDiscReader *q)
 	// set by the subclass.
 }
 
+SparseDiscReaderPrivate::~SparseDiscReaderPrivate()
+{
+	delete threadPool;
+}
+
+/**
+ * Initialize the block cache.
+ * This should be called by subclasses that override
+ * loadBlock() once block_size is known.
+ *
+ * @param count Number of blocks to cache. (0 to disable)
+ * @param bufSize Size of each cache buffer. (must be >= block_size)
+ */
+void SparseDiscReaderPrivate::initBlockCache(unsigned int count, size_t bufSize)
+{
+	assert(bufSize >= block_size);
+	if (bufSize < block_size) {
+		bufSize = block_size;
+	}
+
+	// NOTE: Buffers are allocated on first use.
+	blockCache.clear();
+	blockCache.resize(count);
+	for (BlockCacheEntry &entry : blockCache) {
+		entry.blockIdx = ~0U;
+		entry.lastUsed = 0;
+	}
+	blockCacheBufSize = bufSize;
+	blockCacheTick = 0;
+}
+
+/**
+ * Find a cached block.
+ * @param blockIdx Block index.
+ * @return Cached block data, or nullptr if not cached.
+ */
+const uint8_t *SparseDiscReaderPrivate::findCachedBlock(uint32_t blockIdx)
+{
+	for (BlockCacheEntry &entry : blockCache) {
+		if (entry.blockIdx == blockIdx) {
+			// Found the block.
+			entry.lastUsed = ++blockCacheTick;
+			blockCacheHits++;
+			RpStats::inc(RpStats::BLOCK_CACHE_HITS);
+			return entry.data.data();
+		}
+	}
+
+	// Block is not cached.
+	blockCacheMisses++;
+	RpStats::inc(RpStats::BLOCK_CACHE_MISSES);
+	return nullptr;
+}
+
+/**
+ * Get the least-recently used block cache entry
+ * and assign it to the specified block index.
+ *
+ * NOTE: If loading the block fails, call
+ * invalidateCachedBlock() to release it.
+ *
+ * @param blockIdx Block index.
+ * @return Cache buffer for the block.
+ */
+uint8_t *SparseDiscReaderPrivate::allocCachedBlock(uint32_t blockIdx)
+{
+	assert(!blockCache.empty());
+
+	// Empty entries have lastUsed == 0, so they're used first.
+	auto iter = std::min_element(blockCache.begin(), blockCache.end(),
+		[](const BlockCacheEntry &a, const BlockCacheEntry &b) {
+			return (a.lastUsed < b.lastUsed);
+		});
+
+	if (iter->data.size() != blockCacheBufSize) {
+		iter->data.resize(blockCacheBufSize);
+	}
+	iter->blockIdx = blockIdx;
+	iter->lastUsed = ++blockCacheTick;
+	return iter->data.data();
+}
+
+/**
+ * Invalidate a cached block.
+ * @param blockIdx Block index.
+ */
+void SparseDiscReaderPrivate::invalidateCachedBlock(uint32_t blockIdx)
+{
+	for (BlockCacheEntry &entry : blockCache) {
+		if (entry.blockIdx == blockIdx) {
+			entry.blockIdx = ~0U;
+			entry.lastUsed = 0;
+		}
+	}
+}
+
+/**
+ * Check if a block is cached.
+ * This does not update the LRU counter or statistics.
+ * @param blockIdx Block index.
+ * @return True if the block is cached; false if not.
+ */
+bool SparseDiscReaderPrivate::isBlockCached(uint32_t blockIdx) const
+{
+	for (const BlockCacheEntry &entry : blockCache) {
+		if (entry.blockIdx == blockIdx) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Load the specified block into a block buffer.
+ * The raw block data is read using the shared raw buffer.
+ * @param blockIdx	[in] Block index.
+ * @param pBuf		[out] Block buffer. (at least block_size bytes)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SparseDiscReaderPrivate::loadBlock(uint32_t blockIdx, uint8_t *pBuf)
+{
+	SparseDiscReader *const q = q_ptr;
+	if (rawBuffer.size() != blockCacheBufSize) {
+		rawBuffer.resize(blockCacheBufSize);
+	}
+
+	size_t rawSize = 0;
+	int ret = q->readRawBlock(blockIdx, rawBuffer.data(), &rawSize);
+	if (ret == 0) {
+		ret = q->decodeRawBlock(blockIdx, rawBuffer.data(), rawSize, pBuf);
+	}
+	return ret;
+}
+
+/**
+ * Load multiple blocks in parallel.
+ *
+ * Full blocks are decoded directly into ptr.
+ * Read-ahead blocks are decoded into the block cache.
+ * Blocks that are already cached are not reloaded.
+ *
+ * @param blockIdx	[in] First block index.
+ * @param count		[in] Number of full blocks to load into ptr.
+ * @param ptr		[out] Output buffer. (count * block_size bytes)
+ * @param readAhead	[in] Number of blocks after the full blocks to load into the cache.
+ * @return Number of full blocks loaded into ptr. (less than count on error)
+ */
+unsigned int SparseDiscReaderPrivate::loadBlocksParallel(uint32_t blockIdx, unsigned int count, uint8_t *ptr, unsigned int readAhead)
+{
+	SparseDiscReader *const q = q_ptr;
+	assert(count == 0 || ptr != nullptr);
+	assert(!blockCache.empty());
+
+	// Read-ahead blocks are stored in the block cache,
+	// so don't read ahead more blocks than can be cached.
+	if (readAhead > blockCache.size()) {
+		readAhead = static_cast<unsigned int>(blockCache.size());
+	}
+
+	// Don't read ahead past the end of the disc.
+	const uint32_t fullEnd = blockIdx + count;
+	const off64_t blockCount = (disc_size + block_size - 1) / block_size;
+	uint32_t end = fullEnd + readAhead;
+	if (static_cast<off64_t>(end) > blockCount) {
+		end = static_cast<uint32_t>(blockCount);
+	}
+	assert(fullEnd <= end);
+
+	// Raw data is read on this thread, then decoded in parallel.
+	// Each batch has two blocks per thread so the threads
+	// don't have to wait on each other as much.
+	ThreadPool *const pool = getThreadPool();
+	const unsigned int batchSize = (pool ? pool->threadCount() * 2 : 1);
+	if (blockJobs.size() < batchSize) {
+		blockJobs.resize(batchSize);
+	}
+
+	const std::function<void(size_t)> decode = [this, q](size_t i) {
+		BlockJob &job = blockJobs[i];
+		job.ret = q->decodeRawBlock(job.blockIdx, job.raw.data(), job.rawSize, job.pDest);
+	};
+
+	uint32_t failIdx = fullEnd;	// First full block that failed.
+	uint32_t idx = blockIdx;
+	while (idx < end && failIdx == fullEnd) {
+		if (CancelToken::isCurrentCancelled()) {
+			// Operation was cancelled.
+			// Read-ahead blocks aren't needed by the caller.
+			if (idx < fullEnd) {
+				q->m_lastError = ECANCELED;
+				failIdx = idx;
+			}
+			break;
+		}
+
+		// Read the raw data for this batch.
+		unsigned int jobCount = 0;
+		for (; idx < end && jobCount < batchSize; idx++) {
+			const bool isFull = (idx < fullEnd);
+			if (isFull) {
+				const uint8_t *const pCached = findCachedBlock(idx);
+				if (pCached) {
+					// Block is cached. Copy it directly.
+					memcpy(&ptr[static_cast<size_t>(idx - blockIdx) * block_size], pCached, block_size);
+					continue;
+				}
+			} else if (isBlockCached(idx)) {
+				// Read-ahead block is already cached.
+				continue;
+			}
+
+			BlockJob &job = blockJobs[jobCount];
+			if (job.raw.size() != blockCacheBufSize) {
+				job.raw.resize(blockCacheBufSize);
+			}
+			int ret = q->readRawBlock(idx, job.raw.data(), &job.rawSize);
+			if (ret != 0) {
+				// Error reading the raw data.
+				// Errors in read-ahead blocks are ignored,
+				// since the caller didn't request them.
+				if (isFull) {
+					q->m_lastError = -ret;
+					failIdx = idx;
+				}
+				end = idx;
+				break;
+			}
+
+			job.blockIdx = idx;
+			job.ret = 0;
+			job.pDest = (isFull
+				? &ptr[static_cast<size_t>(idx - blockIdx) * block_size]
+				: allocCachedBlock(idx));
+			jobCount++;
+		}
+
+		// Decode the blocks.
+		if (pool) {
+			pool->parallelFor(jobCount, decode);
+		} else {
+			for (unsigned int i = 0; i < jobCount; i++) {
+				decode(i);
+			}
+		}
+
+		// Check for errors.
+		for (unsigned int i = 0; i < jobCount; i++) {
+			const BlockJob &job = blockJobs[i];
+			if (job.ret == 0)
+				continue;
+
+			if (job.blockIdx < fullEnd) {
+				if (job.blockIdx < failIdx) {
+					q->m_lastError = -job.ret;
+					failIdx = job.blockIdx;
+				}
+			} else {
+				invalidateCachedBlock(job.blockIdx);
+			}
+		}
+	}
+
+	return failIdx - blockIdx;
+}
+
+/**
+ * Read a run of full blocks that are stored at consecutive
+ * physical addresses using a single read.
+ *
+ * Only used if coalesceRuns is set and the block cache is disabled.
+ *
+ * @param blockIdx	[in] First block index.
+ * @param count		[in] Maximum number of full blocks to read.
+ * @param ptr		[out] Output buffer. (count * block_size bytes)
+ * @return Number of blocks read; 0 if blockIdx doesn't start a run of at least two blocks; -1 on error.
+ */
+int SparseDiscReaderPrivate::readBlockRun(uint32_t blockIdx, unsigned int count, uint8_t *ptr)
+{
+	SparseDiscReader *const q = q_ptr;
+	assert(coalesceRuns);
+	assert(blockCache.empty());
+
+	// Empty blocks (address 0) and invalid blocks aren't part of a run.
+	const off64_t physBlockAddr = q->getPhysBlockAddr(blockIdx);
+	if (physBlockAddr <= 0) {
+		return 0;
+	}
+
+	// Limit the run to 1 GB so the read size fits in an int.
+	const unsigned int maxCount = (1U << 30) / block_size;
+	if (count > maxCount) {
+		count = maxCount;
+	}
+
+	unsigned int runCount = 1;
+	off64_t nextAddr = physBlockAddr + block_size;
+	for (; runCount < count; runCount++, nextAddr += block_size) {
+		if (q->getPhysBlockAddr(blockIdx + runCount) != nextAddr)
+			break;
+	}
+	if (runCount < 2) {
+		// Not a run. Use readBlock() instead.
+		return 0;
+	}
+
+	const size_t size = static_cast<size_t>(runCount) * block_size;
+	const size_t sz_read = q->m_file->pread(physBlockAddr, ptr, size);
+	if (sz_read != size) {
+		// Read error.
+		q->m_lastError = q->m_file->lastError();
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+		return -1;
+	}
+	return static_cast<int>(runCount);
+}
+
+/**
+ * Get the thread pool for parallel block loading.
+ * The thread pool is created on first use.
+ * @return Thread pool, or nullptr if parallel loading is disabled.
+ */
+ThreadPool *SparseDiscReaderPrivate::getThreadPool(void)
+{
+	if (threadPool) {
+		return threadPool;
+	} else if (!parallelLoad || threadCount == 1) {
+		// Parallel loading is disabled.
+		return nullptr;
+	}
+
+	const unsigned int count = (threadCount != 0 ? threadCount : ThreadPool::cpuCount());
+	if (count <= 1) {
+		// Only one CPU.
+		return nullptr;
+	}
+
+	threadPool = new ThreadPool(count);
+	return threadPool;
+}
+
 /** SparseDiscReader **/
 
 SparseDiscReader::SparseDiscReader(SparseDiscReaderPrivate *d, IRpFile *file)
@@ -45,42 +408,61 @@ SparseDiscReader::~SparseDiscReader()
 /** IDiscReader functions. **/
 
 /**
- * Read data from the disc image.
- * @param ptr Output data buffer.
- * @param size Amount of data to read, in bytes.
+ * Read data from the specified disc image position.
+ * The disc image position is not changed.
+ * @param pos	[in] Disc image position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
  * @return Number of bytes read.
  */
-size_t SparseDiscReader::read(void *ptr, size_t size)
+size_t SparseDiscReader::pread(off64_t pos, void *ptr, size_t size)
 {
 	RP_D(SparseDiscReader);
 	assert(m_file != nullptr);
 	assert(d->disc_size > 0);
-	assert(d->pos >= 0);
 	assert(d->block_size != 0);
-	if (!m_file || d->disc_size <= 0 || d->pos < 0 || d->block_size == 0) {
+	if (!m_file || d->disc_size <= 0 || d->block_size == 0) {
 		// Disc image wasn't initialized properly.
 		m_lastError = EBADF;
-		return -1;
+		return 0;
+	} else if (pos < 0) {
+		// Negative is invalid.
+		m_lastError = EINVAL;
+		return 0;
 	}
 
 	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
 	size_t ret = 0;
 
 	// Are we already at the end of the disc?
-	if (d->pos >= d->disc_size) {
+	if (pos >= d->disc_size) {
 		// End of the disc.
 		return 0;
 	}
 
-	// Make sure d->pos + size <= d->disc_size.
+	// Make sure pos + size <= d->disc_size.
 	// If it isn't, we'll do a short read.
-	if (d->pos + static_cast<off64_t>(size) >= d->disc_size) {
-		size = static_cast<size_t>(d->disc_size - d->pos);
+	if (pos + static_cast<off64_t>(size) >= d->disc_size) {
+		size = static_cast<size_t>(d->disc_size - pos);
+	}
+
+	// Check for sequential access.
+	// Blocks are only read ahead after a few sequential reads,
+	// since most RomData subclasses only read a few headers.
+	if (pos == d->seqNextPos) {
+		d->seqCount++;
+	} else {
+		d->seqCount = 0;
+	}
+	unsigned int readAhead = 0;
+	const bool parallel = (!d->blockCache.empty() && d->getThreadPool() != nullptr);
+	if (parallel && d->seqCount >= 2) {
+		readAhead = d->readAheadCount;
 	}
 
 	// Check if we're not starting on a block boundary.
 	const uint32_t block_size = d->block_size;
-	const uint32_t blockStartOffset = d->pos % block_size;
+	const uint32_t blockStartOffset = pos % block_size;
 	if (blockStartOffset != 0) {
 		// Not a block boundary.
 		// Read the end of the block.
@@ -89,7 +471,11 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 			read_sz = static_cast<uint32_t>(size);
 		}
 
-		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
+		const unsigned int blockIdx = static_cast<unsigned int>(pos / block_size);
+		if (readAhead > 0 && !d->isBlockCached(blockIdx)) {
+			// Load this block and the following blocks.
+			d->loadBlocksParallel(blockIdx, 0, nullptr, readAhead);
+		}
 		int rd = this->readBlock(blockIdx, blockStartOffset, ptr8, read_sz);
 		if (rd < 0 || rd != static_cast<int>(read_sz)) {
 			// Error reading the data.
@@ -100,16 +486,62 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 		size -= read_sz;
 		ptr8 += read_sz;
 		ret += read_sz;
-		d->pos += read_sz;
+		pos += read_sz;
 	}
 
 	// Read entire blocks.
+	const unsigned int fullBlocks = static_cast<unsigned int>(size / block_size);
+	if (parallel && (fullBlocks >= 2 || (fullBlocks > 0 && readAhead > 0))) {
+		// Load the blocks in parallel.
+		assert(pos % block_size == 0);
+		const unsigned int blockIdx = static_cast<unsigned int>(pos / block_size);
+		const unsigned int loaded = d->loadBlocksParallel(blockIdx, fullBlocks, ptr8, readAhead);
+		const size_t sz_loaded = static_cast<size_t>(loaded) * block_size;
+		size -= sz_loaded;
+		ptr8 += sz_loaded;
+		ret += sz_loaded;
+		pos += sz_loaded;
+		if (loaded != fullBlocks) {
+			// Error reading the data.
+			return ret;
+		}
+	}
+	const bool coalesce = (d->coalesceRuns && d->blockCache.empty());
 	for (; size >= block_size;
 	    size -= block_size, ptr8 += block_size,
-	    ret += block_size, d->pos += block_size)
+	    ret += block_size, pos += block_size)
 	{
-		assert(d->pos % block_size == 0);
-		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
+		if (CancelToken::isCurrentCancelled()) {
+			// Operation was cancelled.
+			m_lastError = ECANCELED;
+			return ret;
+		}
+
+		assert(pos % block_size == 0);
+		const unsigned int blockIdx = static_cast<unsigned int>(pos / block_size);
+		if (d->blockCache.empty() && size >= block_size * 2) {
+			// Read multiple blocks at once if possible.
+			// If coalesceRuns is set, consecutive physical blocks
+			// are read with a single read. Otherwise, the subclass
+			// may have its own implementation.
+			const unsigned int maxCount = static_cast<unsigned int>(size / block_size);
+			const int runCount = (coalesce
+				? d->readBlockRun(blockIdx, maxCount, ptr8)
+				: this->readBlocks(blockIdx, maxCount, ptr8));
+			if (runCount < 0) {
+				// Error reading the data.
+				return ret;
+			} else if (runCount > 0) {
+				// The last block of the run is handled by the loop increment.
+				const size_t sz_run = static_cast<size_t>(runCount - 1) * block_size;
+				size -= sz_run;
+				ptr8 += sz_run;
+				ret += sz_run;
+				pos += sz_run;
+				continue;
+			}
+		}
+
 		int rd = this->readBlock(blockIdx, 0, ptr8, block_size);
 		if (rd < 0 || rd != static_cast<int>(block_size)) {
 			// Error reading the data.
@@ -120,10 +552,14 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 	// Check if we still have data left. (not a full block)
 	if (size > 0) {
 		// Not a full block.
-		assert(d->pos % block_size == 0);
+		assert(pos % block_size == 0);
 
 		// Read the start of the block.
-		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
+		const unsigned int blockIdx = static_cast<unsigned int>(pos / block_size);
+		if (readAhead > 0 && !d->isBlockCached(blockIdx)) {
+			// Load this block and the following blocks.
+			d->loadBlocksParallel(blockIdx, 0, nullptr, readAhead);
+		}
 		int rd = this->readBlock(blockIdx, 0, ptr8, size);
 		if (rd < 0 || rd != static_cast<int>(size)) {
 			// Error reading the data.
@@ -131,10 +567,35 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 		}
 
 		ret += size;
-		d->pos += size;
+		pos += size;
 	}
 
 	// Finished reading the data.
+	d->seqNextPos = pos;
+	return ret;
+}
+
+/**
+ * Read data from the disc image.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t SparseDiscReader::read(void *ptr, size_t size)
+{
+	RP_D(SparseDiscReader);
+	assert(m_file != nullptr);
+	assert(d->disc_size > 0);
+	assert(d->pos >= 0);
+	assert(d->block_size != 0);
+	if (!m_file || d->disc_size <= 0 || d->pos < 0 || d->block_size == 0) {
+		// Disc image wasn't initialized properly.
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	const size_t ret = this->pread(d->pos, ptr, size);
+	d->pos += ret;
 	return ret;
 }
 
@@ -209,6 +670,131 @@ off64_t SparseDiscReader::size(void)
 	return d->disc_size;
 }
 
+/** Block cache. **/
+
+/**
+ * Set the number of blocks to cache.
+ *
+ * Blocks are cached in least-recently used order.
+ * Subclasses with compressed blocks cache a few
+ * blocks by default; others don't cache any blocks,
+ * since they're read directly from the file.
+ *
+ * If the block cache is disabled, compressed blocks
+ * are decompressed on every read.
+ *
+ * NOTE: Changing the count clears the cache.
+ *
+ * @param count Number of blocks to cache. (0 to disable)
+ */
+void SparseDiscReader::setBlockCacheCount(unsigned int count)
+{
+	RP_D(SparseDiscReader);
+	if (count == d->blockCache.size())
+		return;
+
+	size_t bufSize = d->blockCacheBufSize;
+	if (bufSize < d->block_size) {
+		bufSize = d->block_size;
+	}
+	d->initBlockCache(count, bufSize);
+}
+
+/**
+ * Get the number of blocks to cache.
+ * @return Number of blocks to cache.
+ */
+unsigned int SparseDiscReader::blockCacheCount(void) const
+{
+	RP_D(const SparseDiscReader);
+	return static_cast<unsigned int>(d->blockCache.size());
+}
+
+/**
+ * Get the number of block reads that were handled by the cache.
+ * @return Number of cache hits.
+ */
+uint64_t SparseDiscReader::blockCacheHits(void) const
+{
+	RP_D(const SparseDiscReader);
+	return d->blockCacheHits;
+}
+
+/**
+ * Get the number of block reads that required loading the block.
+ * @return Number of cache misses.
+ */
+uint64_t SparseDiscReader::blockCacheMisses(void) const
+{
+	RP_D(const SparseDiscReader);
+	return d->blockCacheMisses;
+}
+
+/** Parallel block loading. **/
+
+/**
+ * Set the number of threads to use for loading blocks.
+ *
+ * Reads that span multiple blocks, as well as sequential
+ * read-ahead, will load blocks using a thread pool.
+ * Raw block data is read from the file on the calling
+ * thread; the blocks are then decoded in parallel.
+ *
+ * Parallel loading is disabled by default, since each reader
+ * creates its own thread pool. Callers that read large amounts
+ * of data, e.g. hashing or extracting a disc image, can enable it.
+ * RomData::calcChecksums() enables it while hashing the image.
+ *
+ * NOTE: This only has an effect if the block cache is enabled.
+ *
+ * @param count Number of threads. (0 for the number of CPUs; 1 to disable [default])
+ */
+void SparseDiscReader::setThreadCount(unsigned int count)
+{
+	RP_D(SparseDiscReader);
+	if (count == d->threadCount)
+		return;
+
+	// The thread pool will be recreated on next use.
+	delete d->threadPool;
+	d->threadPool = nullptr;
+	d->threadCount = count;
+}
+
+/**
+ * Get the number of threads to use for loading blocks.
+ * @return Number of threads. (0 for the number of CPUs; 1 if disabled)
+ */
+unsigned int SparseDiscReader::threadCount(void) const
+{
+	RP_D(const SparseDiscReader);
+	return d->threadCount;
+}
+
+/**
+ * Set the number of blocks to read ahead during sequential reads.
+ *
+ * Read-ahead blocks are loaded into the block cache,
+ * so at most blockCacheCount() blocks will be read ahead.
+ *
+ * @param count Number of blocks to read ahead. (0 to disable)
+ */
+void SparseDiscReader::setReadAheadCount(unsigned int count)
+{
+	RP_D(SparseDiscReader);
+	d->readAheadCount = count;
+}
+
+/**
+ * Get the number of blocks to read ahead during sequential reads.
+ * @return Number of blocks to read ahead.
+ */
+unsigned int SparseDiscReader::readAheadCount(void) const
+{
+	RP_D(const SparseDiscReader);
+	return d->readAheadCount;
+}
+
 /** SparseDiscReader **/
 
 /**
@@ -225,6 +811,8 @@ off64_t SparseDiscReader::size(void)
  */
 int SparseDiscReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size)
 {
+	RP_TRACE_ZONE("SparseDiscReader::readBlock");
+
 	// Read 'size' bytes of block 'blockIdx', starting at 'pos'.
 	// NOTE: This can only be called by SparseDiscReader,
 	// so the main assertions are already checked there.
@@ -243,6 +831,52 @@ int SparseDiscReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t si
 		return 0;
 	}
 
+	if (!d->blockCache.empty()) {
+		// Block cache is enabled.
+		const uint8_t *pCached = d->findCachedBlock(blockIdx);
+		if (!pCached) {
+			// Block is not cached. Load it.
+			uint8_t *const pBuf = d->allocCachedBlock(blockIdx);
+			int ret = d->loadBlock(blockIdx, pBuf);
+			if (ret != 0) {
+				// Error loading the block.
+				d->invalidateCachedBlock(blockIdx);
+				m_lastError = -ret;
+				return -1;
+			}
+			pCached = pBuf;
+		}
+
+		memcpy(ptr, &pCached[pos], size);
+		return static_cast<int>(size);
+	}
+
+	if (d->parallelLoad) {
+		// Block cache is disabled, but the block has to be decoded.
+		// Full blocks are decoded directly into ptr; partial blocks
+		// are decoded into a temporary buffer.
+		uint8_t *pBuf;
+		if (pos == 0 && size == d->block_size) {
+			pBuf = static_cast<uint8_t*>(ptr);
+		} else {
+			if (d->blockBuffer.size() != d->block_size) {
+				d->blockBuffer.resize(d->block_size);
+			}
+			pBuf = d->blockBuffer.data();
+		}
+
+		int ret = d->loadBlock(blockIdx, pBuf);
+		if (ret != 0) {
+			// Error loading the block.
+			m_lastError = -ret;
+			return -1;
+		}
+		if (pBuf != ptr) {
+			memcpy(ptr, &pBuf[pos], size);
+		}
+		return static_cast<int>(size);
+	}
+
 	// Get the physical address first.
 	const off64_t physBlockAddr = getPhysBlockAddr(blockIdx);
 	assert(physBlockAddr >= 0);
@@ -258,9 +892,120 @@ int SparseDiscReader::readBlock(uint32_t blockIdx, int pos, void *ptr, size_t si
 	}
 
 	// Read from the block.
-	size_t sz_read = m_file->seekAndRead(physBlockAddr + pos, ptr, size);
+	size_t sz_read = m_file->pread(physBlockAddr + pos, ptr, size);
 	m_lastError = m_file->lastError();
 	return (sz_read > 0 ? (int)sz_read : -1);
 }
 
+/**
+ * Read multiple full blocks.
+ *
+ * Subclasses can override this if consecutive blocks can be
+ * read more efficiently than with one readBlock() call per
+ * block, e.g. if each block has to be extracted from a larger
+ * physical sector. This is only used if the block cache is
+ * disabled and coalesceRuns isn't set.
+ *
+ * The default implementation returns 0, in which case
+ * readBlock() is used instead.
+ *
+ * @param blockIdx	[in] First block index.
+ * @param count		[in] Maximum number of blocks to read. (at least 2)
+ * @param ptr		[out] Output buffer. (count * block_size bytes)
+ * @return Number of blocks read; 0 if not supported; -1 on error.
+ */
+int SparseDiscReader::readBlocks(uint32_t blockIdx, unsigned int count, uint8_t *ptr)
+{
+	RP_UNUSED(blockIdx);
+	RP_UNUSED(count);
+	RP_UNUSED(ptr);
+	return 0;
+}
+
+/**
+ * Read the raw data for the specified block.
+ *
+ * This is used when loading blocks into the block cache.
+ * The raw data is passed to decodeRawBlock().
+ *
+ * NOTE: This function is always called on the thread
+ * that called read(), so it may access m_file.
+ *
+ * The default implementation reads the block from the
+ * physical address returned by getPhysBlockAddr().
+ *
+ * @param blockIdx	[in] Block index.
+ * @param pRaw		[out] Raw data buffer. (size is the block cache buffer size)
+ * @param pRawSize	[out] Size of the raw data.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SparseDiscReader::readRawBlock(uint32_t blockIdx, uint8_t *pRaw, size_t *pRawSize)
+{
+	RP_D(const SparseDiscReader);
+
+	// Get the physical address first.
+	const off64_t physBlockAddr = getPhysBlockAddr(blockIdx);
+	assert(physBlockAddr >= 0);
+	if (physBlockAddr < 0) {
+		// Out of range.
+		return -EINVAL;
+	}
+
+	if (physBlockAddr == 0) {
+		// Empty block.
+		*pRawSize = 0;
+		return 0;
+	}
+
+	// Read the block.
+	// NOTE: The last block might be a short read.
+	size_t sz_read = m_file->pread(physBlockAddr, pRaw, d->block_size);
+	if (sz_read == 0) {
+		// Read error.
+		int err = m_file->lastError();
+		if (err == 0) {
+			err = EIO;
+		}
+		return -err;
+	}
+	*pRawSize = sz_read;
+	return 0;
+}
+
+/**
+ * Decode raw block data into a block buffer.
+ *
+ * Subclasses with compressed blocks should override this
+ * in order to decompress the block.
+ *
+ * NOTE: This function may be called from multiple threads
+ * at the same time, so it must not access m_file or any
+ * other mutable state.
+ *
+ * The default implementation copies the raw data and
+ * zero-fills the rest of the block.
+ *
+ * @param blockIdx	[in] Block index.
+ * @param pRaw		[in] Raw data from readRawBlock().
+ * @param rawSize	[in] Size of the raw data.
+ * @param pBuf		[out] Block buffer. (at least block_size bytes)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int SparseDiscReader::decodeRawBlock(uint32_t blockIdx, const uint8_t *pRaw, size_t rawSize, uint8_t *pBuf) const
+{
+	RP_UNUSED(blockIdx);
+	RP_D(const SparseDiscReader);
+	assert(rawSize <= d->block_size);
+	if (rawSize > d->block_size) {
+		// Raw data is too big.
+		return -EIO;
+	}
+
+	memcpy(pBuf, pRaw, rawSize);
+	if (rawSize < d->block_size) {
+		memset(&pBuf[rawSize], 0, d->block_size - rawSize);
+	}
+	return 0;
+}
+
 }
@@ -41,6 +41,17 @@ class SparseDiscReader : public IDiscReader
 		ATTR_ACCESS_SIZE(write_only, 2, 3)
 		size_t read(void *ptr, size_t size) final;
 
+		/**
+		 * Read data from the specified disc image position.
+		 * The disc image position is not changed.
+		 * @param pos	[in] Disc image position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
 		/**
 		 * Set the disc image position.
 		 * @param pos disc image position.
@@ -60,6 +71,88 @@ class SparseDiscReader : public IDiscReader
 		 */
 		off64_t size(void) final;
 
+	public:
+		/** Block cache. **/
+
+		/**
+		 * Set the number of blocks to cache.
+		 *
+		 * Blocks are cached in least-recently used order.
+		 * Subclasses with compressed blocks cache a few
+		 * blocks by default; others don't cache any blocks,
+		 * since they're read directly from the file.
+		 *
+		 * If the block cache is disabled, compressed blocks
+		 * are decompressed on every read.
+		 *
+		 * NOTE: Changing the count clears the cache.
+		 *
+		 * @param count Number of blocks to cache. (0 to disable)
+		 */
+		void setBlockCacheCount(unsigned int count);
+
+		/**
+		 * Get the number of blocks to cache.
+		 * @return Number of blocks to cache.
+		 */
+		unsigned int blockCacheCount(void) const;
+
+		/**
+		 * Get the number of block reads that were handled by the cache.
+		 * @return Number of cache hits.
+		 */
+		uint64_t blockCacheHits(void) const;
+
+		/**
+		 * Get the number of block reads that required loading the block.
+		 * @return Number of cache misses.
+		 */
+		uint64_t blockCacheMisses(void) const;
+
+	public:
+		/** Parallel block loading. **/
+
+		/**
+		 * Set the number of threads to use for loading blocks.
+		 *
+		 * Reads that span multiple blocks, as well as sequential
+		 * read-ahead, will load blocks using a thread pool.
+		 * Raw block data is read from the file on the calling
+		 * thread; the blocks are then decoded in parallel.
+		 *
+		 * Parallel loading is disabled by default, since each reader
+		 * creates its own thread pool. Callers that read large amounts
+		 * of data, e.g. hashing or extracting a disc image, can enable it.
+		 * RomData::calcChecksums() enables it while hashing the image.
+		 *
+		 * NOTE: This only has an effect if the block cache is enabled.
+		 *
+		 * @param count Number of threads. (0 for the number of CPUs; 1 to disable [default])
+		 */
+		void setThreadCount(unsigned int count);
+
+		/**
+		 * Get the number of threads to use for loading blocks.
+		 * @return Number of threads. (0 for the number of CPUs; 1 if disabled)
+		 */
+		unsigned int threadCount(void) const;
+
+		/**
+		 * Set the number of blocks to read ahead during sequential reads.
+		 *
+		 * Read-ahead blocks are loaded into the block cache,
+		 * so at most blockCacheCount() blocks will be read ahead.
+		 *
+		 * @param count Number of blocks to read ahead. (0 to disable)
+		 */
+		void setReadAheadCount(unsigned int count);
+
+		/**
+		 * Get the number of blocks to read ahead during sequential reads.
+		 * @return Number of blocks to read ahead.
+		 */
+		unsigned int readAheadCount(void) const;
+
 	protected:
 		/** Virtual functions for SparseDiscReader subclasses. **/
 
@@ -94,6 +187,65 @@ class SparseDiscReader : public IDiscReader
 		 */
 		ATTR_ACCESS_SIZE(write_only, 4, 5)
 		virtual int readBlock(uint32_t blockIdx, int pos, void *ptr, size_t size);
+
+		/**
+		 * Read multiple full blocks.
+		 *
+		 * Subclasses can override this if consecutive blocks can be
+		 * read more efficiently than with one readBlock() call per
+		 * block, e.g. if each block has to be extracted from a larger
+		 * physical sector. This is only used if the block cache is
+		 * disabled and coalesceRuns isn't set.
+		 *
+		 * The default implementation returns 0, in which case
+		 * readBlock() is used instead.
+		 *
+		 * @param blockIdx	[in] First block index.
+		 * @param count		[in] Maximum number of blocks to read. (at least 2)
+		 * @param ptr		[out] Output buffer. (count * block_size bytes)
+		 * @return Number of blocks read; 0 if not supported; -1 on error.
+		 */
+		virtual int readBlocks(uint32_t blockIdx, unsigned int count, uint8_t *ptr);
+
+		/**
+		 * Read the raw data for the specified block.
+		 *
+		 * This is used when loading blocks into the block cache.
+		 * The raw data is passed to decodeRawBlock().
+		 *
+		 * NOTE: This function is always called on the thread
+		 * that called read(), so it may access m_file.
+		 *
+		 * The default implementation reads the block from the
+		 * physical address returned by getPhysBlockAddr().
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @param pRaw		[out] Raw data buffer. (size is the block cache buffer size)
+		 * @param pRawSize	[out] Size of the raw data.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int readRawBlock(uint32_t blockIdx, uint8_t *pRaw, size_t *pRawSize);
+
+		/**
+		 * Decode raw block data into a block buffer.
+		 *
+		 * Subclasses with compressed blocks should override this
+		 * in order to decompress the block.
+		 *
+		 * NOTE: This function may be called from multiple threads
+		 * at the same time, so it must not access m_file or any
+		 * other mutable state.
+		 *
+		 * The default implementation copies the raw data and
+		 * zero-fills the rest of the block.
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @param pRaw		[in] Raw data from readRawBlock().
+		 * @param rawSize	[in] Size of the raw data.
+		 * @param pBuf		[out] Block buffer. (at least block_size bytes)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int decodeRawBlock(uint32_t blockIdx, const uint8_t *pRaw, size_t rawSize, uint8_t *pBuf) const;
 };
 
 }
@@ -14,6 +14,16 @@
 #include <stdint.h>
 #include "common.h"
 
+// C++ includes.
+#include <vector>
+
+// Uninitialized vector class.
+#include "librpbase/uvector.h"
+
+namespace LibRpThreads {
+	class ThreadPool;
+}
+
 namespace LibRpBase {
 
 class SparseDiscReader;
@@ -22,7 +32,7 @@ class SparseDiscReaderPrivate
 	protected:
 		SparseDiscReaderPrivate(SparseDiscReader *q);
 	public:
-		virtual ~SparseDiscReaderPrivate() { };
+		virtual ~SparseDiscReaderPrivate();
 
 	private:
 		RP_DISABLE_COPY(SparseDiscReaderPrivate)
@@ -34,6 +44,156 @@ class SparseDiscReaderPrivate
 		off64_t disc_size;		// Virtual disc image size.
 		off64_t pos;			// Read position.
 		unsigned int block_size;	// Block size.
+
+	public:
+		/** Block cache. **/
+
+		// Default number of blocks to cache for
+		// subclasses that use compressed blocks.
+		static const unsigned int DEFAULT_BLOCK_CACHE_COUNT = 4;
+
+		/**
+		 * Initialize the block cache.
+		 * This should be called by subclasses that override
+		 * loadBlock() once block_size is known.
+		 *
+		 * @param count Number of blocks to cache. (0 to disable)
+		 * @param bufSize Size of each cache buffer. (must be >= block_size)
+		 */
+		void initBlockCache(unsigned int count, size_t bufSize);
+
+		/**
+		 * Find a cached block.
+		 * @param blockIdx Block index.
+		 * @return Cached block data, or nullptr if not cached.
+		 */
+		const uint8_t *findCachedBlock(uint32_t blockIdx);
+
+		/**
+		 * Get the least-recently used block cache entry
+		 * and assign it to the specified block index.
+		 *
+		 * NOTE: If loading the block fails, call
+		 * invalidateCachedBlock() to release it.
+		 *
+		 * @param blockIdx Block index.
+		 * @return Cache buffer for the block.
+		 */
+		uint8_t *allocCachedBlock(uint32_t blockIdx);
+
+		/**
+		 * Invalidate a cached block.
+		 * @param blockIdx Block index.
+		 */
+		void invalidateCachedBlock(uint32_t blockIdx);
+
+		/**
+		 * Check if a block is cached.
+		 * This does not update the LRU counter or statistics.
+		 * @param blockIdx Block index.
+		 * @return True if the block is cached; false if not.
+		 */
+		bool isBlockCached(uint32_t blockIdx) const;
+
+		struct BlockCacheEntry {
+			uint32_t blockIdx;	// Block index. (~0U if empty)
+			uint32_t lastUsed;	// blockCacheTick value when last used.
+			ao::uvector<uint8_t> data;
+		};
+		std::vector<BlockCacheEntry> blockCache;
+		size_t blockCacheBufSize;	// Size of each cache buffer.
+		uint32_t blockCacheTick;	// LRU counter.
+
+		// Block cache statistics.
+		uint64_t blockCacheHits;
+		uint64_t blockCacheMisses;
+
+	public:
+		/** Block loading. **/
+
+		/**
+		 * Load the specified block into a block buffer.
+		 * The raw block data is read using the shared raw buffer.
+		 * @param blockIdx	[in] Block index.
+		 * @param pBuf		[out] Block buffer. (at least block_size bytes)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadBlock(uint32_t blockIdx, uint8_t *pBuf);
+
+		/**
+		 * Load multiple blocks in parallel.
+		 *
+		 * Full blocks are decoded directly into ptr.
+		 * Read-ahead blocks are decoded into the block cache.
+		 * Blocks that are already cached are not reloaded.
+		 *
+		 * @param blockIdx	[in] First block index.
+		 * @param count		[in] Number of full blocks to load into ptr.
+		 * @param ptr		[out] Output buffer. (count * block_size bytes)
+		 * @param readAhead	[in] Number of blocks after the full blocks to load into the cache.
+		 * @return Number of full blocks loaded into ptr. (less than count on error)
+		 */
+		unsigned int loadBlocksParallel(uint32_t blockIdx, unsigned int count, uint8_t *ptr, unsigned int readAhead);
+
+		/**
+		 * Get the thread pool for parallel block loading.
+		 * The thread pool is created on first use.
+		 * @return Thread pool, or nullptr if parallel loading is disabled.
+		 */
+		LibRpThreads::ThreadPool *getThreadPool(void);
+
+		// Set by subclasses if blocks can be loaded using readRawBlock()
+		// and decodeRawBlock() instead of readBlock().
+		// Parallel block loading is only used if this is set.
+		// If set, uncached reads are decoded using loadBlock().
+		bool parallelLoad;
+
+		// Default number of blocks to read ahead.
+		static const unsigned int DEFAULT_READ_AHEAD_COUNT = 8;
+
+		/**
+		 * Read a run of full blocks that are stored at consecutive
+		 * physical addresses using a single read.
+		 *
+		 * Only used if coalesceRuns is set and the block cache is disabled.
+		 *
+		 * @param blockIdx	[in] First block index.
+		 * @param count		[in] Maximum number of full blocks to read.
+		 * @param ptr		[out] Output buffer. (count * block_size bytes)
+		 * @return Number of blocks read; 0 if blockIdx doesn't start a run of at least two blocks; -1 on error.
+		 */
+		int readBlockRun(uint32_t blockIdx, unsigned int count, uint8_t *ptr);
+
+		// Set by subclasses if full blocks can be read directly from
+		// the physical addresses returned by getPhysBlockAddr(), so
+		// consecutive physical blocks can be read with a single read.
+		// Don't set this if the blocks need to be decoded.
+		bool coalesceRuns;
+
+		// Raw data buffer for loadBlock().
+		// (Same size as the block cache buffers.)
+		ao::uvector<uint8_t> rawBuffer;
+
+		// Decoded block buffer for partial reads
+		// if parallelLoad is set and the block cache is disabled.
+		ao::uvector<uint8_t> blockBuffer;
+
+		// Parallel block loading.
+		struct BlockJob {
+			uint32_t blockIdx;	// Block index.
+			int ret;		// Return value from decodeRawBlock().
+			uint8_t *pDest;		// Destination buffer.
+			size_t rawSize;		// Raw data size.
+			ao::uvector<uint8_t> raw;	// Raw data.
+		};
+		std::vector<BlockJob> blockJobs;
+		LibRpThreads::ThreadPool *threadPool;
+		unsigned int threadCount;	// Requested thread count. (0 == number of CPUs; default is 1)
+		unsigned int readAheadCount;	// Number of blocks to read ahead.
+
+		// Sequential access detection.
+		off64_t seqNextPos;		// Position after the last read.
+		unsigned int seqCount;		// Number of consecutive sequential reads.
 };
 
 }
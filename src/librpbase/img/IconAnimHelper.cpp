@@ -10,8 +10,114 @@
 #include "IconAnimHelper.hpp"
 #include "img/rp_image.hpp"
 
+// librptexture
+using LibRpTexture::rp_image;
+
 namespace LibRpBase {
 
+/**
+ * Check if two icon frames are identical.
+ * @param a Frame A.
+ * @param b Frame B.
+ * @return True if the frames are identical; false if not.
+ */
+static bool isSameFrame(const rp_image *a, const rp_image *b)
+{
+	if (a == b) {
+		return true;
+	} else if (a->width() != b->width() || a->height() != b->height() ||
+	           a->format() != b->format())
+	{
+		return false;
+	}
+
+	if (a->format() == rp_image::Format::CI8) {
+		// Compare the palettes.
+		if (a->palette_len() != b->palette_len() ||
+		    memcmp(a->palette(), b->palette(), a->palette_len() * sizeof(uint32_t)) != 0)
+		{
+			return false;
+		}
+	}
+
+	// Compare the image data.
+	const int row_bytes = a->row_bytes();
+	for (int y = a->height()-1; y >= 0; y--) {
+		if (memcmp(a->scanLine(y), b->scanLine(y), row_bytes) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Find identical frames and update m_baseFrame.
+ */
+void IconAnimHelper::updateBaseFrames(void)
+{
+	for (int i = 0; i < IconAnimData::MAX_FRAMES; i++) {
+		m_baseFrame[i] = static_cast<uint8_t>(i);
+	}
+	if (!m_iconAnimData)
+		return;
+
+	const int count = std::min(m_iconAnimData->count, IconAnimData::MAX_FRAMES);
+	for (int i = 1; i < count; i++) {
+		const rp_image *const frame = m_iconAnimData->frames[i];
+		if (!frame || !frame->isValid())
+			continue;
+
+		for (int j = 0; j < i; j++) {
+			// Only compare against other base frames.
+			if (m_baseFrame[j] != j)
+				continue;
+			const rp_image *const frame_j = m_iconAnimData->frames[j];
+			if (frame_j && frame_j->isValid() && isSameFrame(frame, frame_j)) {
+				m_baseFrame[i] = static_cast<uint8_t>(j);
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * Get the frame that will be displayed for the specified frame.
+ * Invalid frames display the last valid frame.
+ * @param frame Frame number.
+ * @return Displayed frame number. (base frame)
+ */
+int IconAnimHelper::displayedFrame(int frame) const
+{
+	assert(frame >= 0);
+	assert(frame < (int)m_iconAnimData->frames.size());
+	const rp_image *const img = m_iconAnimData->frames[frame];
+	if (img != nullptr && img->isValid()) {
+		// Frame is valid.
+		return m_baseFrame[frame];
+	}
+	return m_last_valid_frame;
+}
+
+/**
+ * Merge subsequent sequence entries that display the current frame.
+ * m_seq_idx is advanced to the last merged entry, and the
+ * merged entries' delays are added to m_delay.
+ */
+void IconAnimHelper::mergeRepeatedFrames(void)
+{
+	const int seq_count = m_iconAnimData->seq_count;
+	for (int i = seq_count-1; i > 0; i--) {
+		const int next_seq_idx = (m_seq_idx >= (seq_count - 1) ? 0 : m_seq_idx + 1);
+		const int next_frame = m_iconAnimData->seq_index[next_seq_idx];
+		if (displayedFrame(next_frame) != m_last_valid_frame)
+			break;
+
+		m_seq_idx = next_seq_idx;
+		m_frame = next_frame;
+		m_delay += m_iconAnimData->delays[next_seq_idx].ms;
+	}
+}
+
 /**
  * Reset the animation.
  */
@@ -25,7 +131,8 @@ void IconAnimHelper::reset(void)
 		m_seq_idx = 0;
 		m_frame = m_iconAnimData->seq_index[0];
 		m_delay = m_iconAnimData->delays[0].ms;
-		m_last_valid_frame = m_frame;
+		m_last_valid_frame = m_baseFrame[m_frame];
+		mergeRepeatedFrames();
 	} else {
 		// No animation.
 		m_seq_idx = 0;
@@ -63,16 +170,15 @@ int IconAnimHelper::nextFrame(int *pDelay)
 
 	// Get the frame delay. (TODO: Must be > 0?)
 	m_delay = m_iconAnimData->delays[m_seq_idx].ms;
-	if (pDelay) {
-		*pDelay = m_delay;
-	}
 
 	// Check if this frame is valid.
-	if (m_iconAnimData->frames[m_frame] != nullptr &&
-	    m_iconAnimData->frames[m_frame]->isValid())
-	{
-		// Frame is valid.
-		m_last_valid_frame = m_frame;
+	m_last_valid_frame = displayedFrame(m_frame);
+
+	// Merge subsequent entries that display the same frame
+	// so the frontend doesn't need to wake up for them.
+	mergeRepeatedFrames();
+	if (pDelay) {
+		*pDelay = m_delay;
 	}
 
 	return m_last_valid_frame;
@@ -12,6 +12,9 @@
 #include "common.h"
 #include "IconAnimData.hpp"
 
+// C includes. (C++ namespace)
+#include <cassert>
+
 namespace LibRpBase {
 
 class IconAnimHelper
@@ -23,7 +26,9 @@ class IconAnimHelper
 			, m_frame(0)
 			, m_delay(0)
 			, m_last_valid_frame(0)
-		{ }
+		{
+			m_baseFrame.fill(0);
+		}
 
 		explicit IconAnimHelper(const IconAnimData *iconAnimData)
 			: m_iconAnimData(iconAnimData)
@@ -32,6 +37,7 @@ class IconAnimHelper
 			, m_delay(0)
 			, m_last_valid_frame(0)
 		{
+			updateBaseFrames();
 			reset();
 		}
 
@@ -53,6 +59,7 @@ class IconAnimHelper
 		{
 			UNREF(m_iconAnimData);
 			m_iconAnimData = iconAnimData->ref();
+			updateBaseFrames();
 			reset();
 		}
 
@@ -95,6 +102,24 @@ class IconAnimHelper
 			return m_last_valid_frame;
 		}
 
+		/**
+		 * Get the base frame for the specified frame.
+		 *
+		 * Frames that are identical to an earlier frame map to
+		 * that earlier frame, so frontends only need to convert
+		 * frames where baseFrame(i) == i. Frame numbers returned
+		 * by frameNumber() and nextFrame() are always base frames.
+		 *
+		 * @param frame Frame number.
+		 * @return Base frame number.
+		 */
+		int baseFrame(int frame) const
+		{
+			assert(frame >= 0);
+			assert(frame < IconAnimData::MAX_FRAMES);
+			return m_baseFrame[frame];
+		}
+
 		/**
 		 * Get the current frame's delay.
 		 * @return Current frame's delay, in milliseconds.
@@ -111,17 +136,45 @@ class IconAnimHelper
 
 		/**
 		 * Advance the animation by one frame.
+		 *
+		 * Subsequent sequence entries that display the same frame
+		 * are merged, and the returned delay is the total delay.
+		 *
 		 * @param pDelay	[out] Pointer to int to store the frame delay, in milliseconds.
 		 * @return Next frame number. (Returns 0 if there's no animation.)
 		 */
 		int nextFrame(int *pDelay);
 
+	private:
+		/**
+		 * Find identical frames and update m_baseFrame.
+		 */
+		void updateBaseFrames(void);
+
+		/**
+		 * Get the frame that will be displayed for the specified frame.
+		 * Invalid frames display the last valid frame.
+		 * @param frame Frame number.
+		 * @return Displayed frame number. (base frame)
+		 */
+		int displayedFrame(int frame) const;
+
+		/**
+		 * Merge subsequent sequence entries that display the current frame.
+		 * m_seq_idx is advanced to the last merged entry, and the
+		 * merged entries' delays are added to m_delay.
+		 */
+		void mergeRepeatedFrames(void);
+
 	protected:
 		const IconAnimData *m_iconAnimData;
 		int m_seq_idx;		// Current sequence index.
 		int m_frame;		// Current frame.
 		int m_delay;		// Current frame delay. (ms)
 		int m_last_valid_frame;	// Last frame that had a valid image.
+
+		// Base frame for each frame. (identical frames are deduplicated)
+		std::array<uint8_t, IconAnimData::MAX_FRAMES> m_baseFrame;
 };
 
 }
@@ -0,0 +1,297 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ImageCache.cpp: Process-wide cache for decoded images.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageCache.hpp"
+#include "SharedImageCache.hpp"
+
+// librpfile, librptexture, librpthreads
+#include "librpfile/RpFile.hpp"
+#include "librptexture/img/rp_image.hpp"
+#include "librpthreads/Mutex.hpp"
+using LibRpFile::IRpFile;
+using LibRpFile::RpFile;
+using LibRpTexture::rp_image;
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
+// C++ includes.
+#include <list>
+
+// C++ STL classes.
+using std::list;
+using std::string;
+using std::unordered_map;
+
+namespace LibRpBase {
+
+class ImageCachePrivate
+{
+	public:
+		ImageCachePrivate();
+		~ImageCachePrivate();
+
+	private:
+		RP_DISABLE_COPY(ImageCachePrivate)
+
+	public:
+		// Static ImageCachePrivate instance.
+		static ImageCachePrivate instance;
+
+		/**
+		 * Hash function for ImageCache::Key.
+		 */
+		struct KeyHash {
+			size_t operator()(const ImageCache::Key &key) const
+			{
+				// FNV-1a over the file identity fields.
+				uint64_t hash = 0xCBF29CE484222325ULL;
+				const uint64_t vals[5] = {
+					key.fileId.dev, key.fileId.ino,
+					static_cast<uint64_t>(key.fileId.mtime_ns),
+					static_cast<uint64_t>(key.imageType),
+					static_cast<uint64_t>(key.reqSize)
+				};
+				for (uint64_t val : vals) {
+					hash ^= val;
+					hash *= 0x100000001B3ULL;
+				}
+				return static_cast<size_t>(hash ^ std::hash<string>()(key.owner));
+			}
+		};
+
+		struct Entry {
+			ImageCache::Key key;
+			const rp_image *img;
+			size_t size;
+		};
+
+		// LRU list. Most recently used images are at the front.
+		typedef list<Entry> EntryList;
+		EntryList lru;
+		unordered_map<ImageCache::Key, EntryList::iterator, KeyHash> map;
+
+		size_t curSize;		// Current cache size, in bytes.
+		size_t maxSize;		// Maximum cache size, in bytes.
+		Mutex mtx;		// Cache mutex.
+
+		/**
+		 * Get the approximate amount of memory used by an image.
+		 * @param img Image.
+		 * @return Image size, in bytes.
+		 */
+		static size_t imageSize(const rp_image *img);
+
+		/**
+		 * Evict images until the cache is at most the specified size.
+		 * NOTE: The mutex must be locked by the caller.
+		 * @param size Size, in bytes.
+		 */
+		void evict(size_t size);
+
+		/**
+		 * Add an image to the process-wide cache.
+		 * @param key Cache key.
+		 * @param img Image.
+		 * @return True if the image was added; false if not.
+		 */
+		bool insert(const ImageCache::Key &key, const rp_image *img);
+};
+
+/** ImageCachePrivate **/
+
+// Singleton instance.
+// Using a static non-pointer variable in order to
+// handle proper destruction when the DLL is unloaded.
+ImageCachePrivate ImageCachePrivate::instance;
+
+ImageCachePrivate::ImageCachePrivate()
+	: curSize(0)
+	, maxSize(ImageCache::DEFAULT_MAX_SIZE)
+{ }
+
+ImageCachePrivate::~ImageCachePrivate()
+{
+	evict(0);
+}
+
+/**
+ * Get the approximate amount of memory used by an image.
+ * @param img Image.
+ * @return Image size, in bytes.
+ */
+size_t ImageCachePrivate::imageSize(const rp_image *img)
+{
+	return (static_cast<size_t>(img->stride()) * static_cast<size_t>(img->height())) +
+		(static_cast<size_t>(img->palette_len()) * sizeof(uint32_t)) +
+		sizeof(Entry);
+}
+
+/**
+ * Evict images until the cache is at most the specified size.
+ * NOTE: The mutex must be locked by the caller.
+ * @param size Size, in bytes.
+ */
+void ImageCachePrivate::evict(size_t size)
+{
+	while (curSize > size && !lru.empty()) {
+		Entry &entry = lru.back();
+		curSize -= entry.size;
+		entry.img->unref();
+		map.erase(entry.key);
+		lru.pop_back();
+	}
+}
+
+/**
+ * Add an image to the process-wide cache.
+ * @param key Cache key.
+ * @param img Image.
+ * @return True if the image was added; false if not.
+ */
+bool ImageCachePrivate::insert(const ImageCache::Key &key, const rp_image *img)
+{
+	const size_t size = imageSize(img);
+
+	MutexLocker mtxLocker(mtx);
+	if (size > maxSize) {
+		// Image is too big to cache.
+		return false;
+	} else if (map.find(key) != map.end()) {
+		// Image is already cached.
+		return false;
+	}
+
+	// Make room for the image.
+	evict(maxSize - size);
+
+	Entry entry;
+	entry.key = key;
+	entry.img = img->ref();
+	entry.size = size;
+	lru.push_front(std::move(entry));
+	map.emplace(key, lru.begin());
+	curSize += size;
+	return true;
+}
+
+/** ImageCache **/
+
+/**
+ * Initialize a cache key for a file.
+ *
+ * Only files on the local file system can be cached,
+ * since other files (e.g. files within a disc image)
+ * don't have a unique identity.
+ *
+ * @param key		[out] Cache key.
+ * @param file		[in] File the image is decoded from.
+ * @param owner		[in,opt] RomData class name, or nullptr for image files. (ASCII)
+ * @param imageType	[in] RomData::ImageType, or 0 for image files.
+ * @param reqSize	[in,opt] Requested decode size, or 0 for the original size.
+ * @return True if the key was initialized; false if this file can't be cached.
+ */
+bool ImageCache::initKey(Key &key, const IRpFile *file, const char *owner, int imageType, int reqSize)
+{
+	if (!file || !dynamic_cast<const RpFile*>(file)) {
+		// Not a file on the local file system.
+		return false;
+	}
+
+	const string filename = file->filename();
+	if (filename.empty() || LibRpFile::FileSystem::get_file_id(filename, &key.fileId) != 0) {
+		// Unable to get the file identity.
+		return false;
+	}
+
+	if (owner) {
+		key.owner = owner;
+	} else {
+		key.owner.clear();
+	}
+	key.imageType = imageType;
+	key.reqSize = reqSize;
+	return true;
+}
+
+/**
+ * Look up an image in the cache.
+ * @param key Cache key.
+ * @return ref()'d image, or nullptr if not found.
+ */
+const rp_image *ImageCache::lookup(const Key &key)
+{
+	ImageCachePrivate *const d = &ImageCachePrivate::instance;
+	{
+		MutexLocker mtxLocker(d->mtx);
+		if (d->maxSize == 0) {
+			// Cache is disabled.
+			return nullptr;
+		}
+
+		auto iter = d->map.find(key);
+		if (iter != d->map.end()) {
+			// Move the image to the front of the LRU list.
+			d->lru.splice(d->lru.begin(), d->lru, iter->second);
+			return iter->second->img->ref();
+		}
+	}
+
+	// Not found. Check if another process already decoded the image.
+	rp_image *const img = SharedImageCache::lookup(key);
+	if (img) {
+		d->insert(key, img);
+	}
+	return img;
+}
+
+/**
+ * Add an image to the cache.
+ * The cache takes its own reference to the image.
+ * Least-recently-used images are evicted if the
+ * cache size exceeds the maximum.
+ * @param key Cache key.
+ * @param img Image.
+ */
+void ImageCache::insert(const Key &key, const rp_image *img)
+{
+	assert(img != nullptr);
+	if (!img || !img->isValid())
+		return;
+
+	ImageCachePrivate *const d = &ImageCachePrivate::instance;
+	if (d->insert(key, img)) {
+		// Share the image with other processes.
+		// NOTE: Done outside of the mutex, since this copies the pixel data.
+		SharedImageCache::insert(key, img);
+	}
+}
+
+/**
+ * Set the maximum cache size.
+ * @param maxSize Maximum cache size, in bytes. (0 to disable the cache)
+ */
+void ImageCache::setMaxSize(size_t maxSize)
+{
+	ImageCachePrivate *const d = &ImageCachePrivate::instance;
+	MutexLocker mtxLocker(d->mtx);
+	d->maxSize = maxSize;
+	d->evict(maxSize);
+}
+
+/**
+ * Remove all images from the cache.
+ */
+void ImageCache::clear(void)
+{
+	ImageCachePrivate *const d = &ImageCachePrivate::instance;
+	MutexLocker mtxLocker(d->mtx);
+	d->evict(0);
+}
+
+}
@@ -0,0 +1,120 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * ImageCache.hpp: Process-wide cache for decoded images.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_IMG_IMAGECACHE_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_IMG_IMAGECACHE_HPP__
+
+#include "common.h"
+
+// librpfile
+#include "librpfile/FileSystem.hpp"
+
+// C++ includes.
+#include <string>
+
+namespace LibRpFile {
+	class IRpFile;
+}
+namespace LibRpTexture {
+	class rp_image;
+}
+
+namespace LibRpBase {
+
+/**
+ * Process-wide LRU cache for decoded images.
+ *
+ * Images are keyed by the identity of the file they were
+ * decoded from, so multiple RomData objects for the same
+ * file (e.g. the thumbnailer and the properties page)
+ * can share decoded images.
+ *
+ * If an image isn't found, SharedImageCache is checked
+ * in case another process already decoded it.
+ *
+ * Cached images are shared, and must not be modified.
+ */
+class ImageCache
+{
+	private:
+		// ImageCache is a static class.
+		ImageCache();
+		~ImageCache();
+		RP_DISABLE_COPY(ImageCache)
+
+	public:
+		/**
+		 * Cache key.
+		 */
+		struct Key {
+			LibRpFile::FileSystem::FileId fileId;	// Source file identity
+			std::string owner;	// RomData class name, or empty for image files
+			int imageType;		// RomData::ImageType, or 0 for image files
+			int reqSize;		// Requested decode size, or 0 for the original size
+
+			inline bool operator==(const Key &other) const
+			{
+				return (fileId == other.fileId && imageType == other.imageType &&
+				        reqSize == other.reqSize && owner == other.owner);
+			}
+		};
+
+		/**
+		 * Default maximum cache size, in bytes.
+		 */
+		static const size_t DEFAULT_MAX_SIZE = 32U*1024U*1024U;
+
+		/**
+		 * Initialize a cache key for a file.
+		 *
+		 * Only files on the local file system can be cached,
+		 * since other files (e.g. files within a disc image)
+		 * don't have a unique identity.
+		 *
+		 * @param key		[out] Cache key.
+		 * @param file		[in] File the image is decoded from.
+		 * @param owner		[in,opt] RomData class name, or nullptr for image files. (ASCII)
+		 * @param imageType	[in] RomData::ImageType, or 0 for image files.
+		 * @param reqSize	[in,opt] Requested decode size, or 0 for the original size.
+		 * @return True if the key was initialized; false if this file can't be cached.
+		 */
+		static bool initKey(Key &key, const LibRpFile::IRpFile *file,
+			const char *owner, int imageType, int reqSize = 0);
+
+		/**
+		 * Look up an image in the cache.
+		 * @param key Cache key.
+		 * @return ref()'d image, or nullptr if not found.
+		 */
+		static const LibRpTexture::rp_image *lookup(const Key &key);
+
+		/**
+		 * Add an image to the cache.
+		 * The cache takes its own reference to the image.
+		 * Least-recently-used images are evicted if the
+		 * cache size exceeds the maximum.
+		 * @param key Cache key.
+		 * @param img Image.
+		 */
+		static void insert(const Key &key, const LibRpTexture::rp_image *img);
+
+		/**
+		 * Set the maximum cache size.
+		 * @param maxSize Maximum cache size, in bytes. (0 to disable the cache)
+		 */
+		static void setMaxSize(size_t maxSize);
+
+		/**
+		 * Remove all images from the cache.
+		 */
+		static void clear(void);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_IMG_IMAGECACHE_HPP__ */
@@ -10,6 +10,7 @@
 #include "config.librpbase.h"
 
 #include "RpImageLoader.hpp"
+#include "ImageCache.hpp"
 #include "librpfile/IRpFile.hpp"
 
 // librpfile, librptexture
@@ -40,6 +41,18 @@ class RpImageLoaderPrivate
 		static const uint8_t jpeg_magic_1[4];
 		static const uint8_t jpeg_magic_2[4];
 #endif /* HAVE_JPEG */
+
+	public:
+		/**
+		 * Load an image from an IRpFile.
+		 * This function does not use the ImageCache.
+		 *
+		 * @param file		[in] IRpFile to load from.
+		 * @param pngCheckLevel	[in] Verification level for PNG images.
+		 * @param pReqSize	[in/out] Requested size; set to 0 if the image format doesn't support scaled decoding.
+		 * @return rp_image*, or nullptr on error.
+		 */
+		static rp_image *load(IRpFile *file, RpPng::CheckLevel pngCheckLevel, int *pReqSize);
 };
 
 /** RpImageLoaderPrivate **/
@@ -63,9 +76,10 @@ const uint8_t RpImageLoaderPrivate::jpeg_magic_2[4] =
  * with untrusted images!
  *
  * @param file IRpFile to load from.
+ * @param reqSize Requested size, or 0 for the original size. (JPEG only; see RpJpeg)
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpImageLoader::loadUnchecked(IRpFile *file)
+rp_image *RpImageLoader::loadUnchecked(IRpFile *file, int reqSize)
 {
 	file->rewind();
 
@@ -87,25 +101,26 @@ rp_image *RpImageLoader::loadUnchecked(IRpFile *file)
 			  sizeof(RpImageLoaderPrivate::jpeg_magic_2)))
 		{
 			// Found a JPEG image.
-			return RpJpeg::loadUnchecked(file);
+			return RpJpeg::loadUnchecked(file, reqSize);
 		}
 #endif /* HAVE_JPEG */
 	}
 
 	// Unsupported image format.
+	RP_UNUSED(reqSize);
 	return nullptr;
 }
 
 /**
  * Load an image from an IRpFile.
+ * This function does not use the ImageCache.
  *
- * This image is verified with various tools to ensure
- * it doesn't have any errors.
- *
- * @param file IRpFile to load from.
+ * @param file		[in] IRpFile to load from.
+ * @param pngCheckLevel	[in] Verification level for PNG images.
+ * @param pReqSize	[in/out] Requested size; set to 0 if the image format doesn't support scaled decoding.
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpImageLoader::load(IRpFile *file)
+rp_image *RpImageLoaderPrivate::load(IRpFile *file, RpPng::CheckLevel pngCheckLevel, int *pReqSize)
 {
 	file->rewind();
 
@@ -118,7 +133,9 @@ rp_image *RpImageLoader::load(IRpFile *file)
 		     sizeof(RpImageLoaderPrivate::png_magic)))
 		{
 			// Found a PNG image.
-			return RpPng::load(file);
+			// PNG images are always decoded at the original size.
+			*pReqSize = 0;
+			return RpPng::load(file, pngCheckLevel);
 		}
 #ifdef HAVE_JPEG
 		else if (!memcmp(buf, RpImageLoaderPrivate::jpeg_magic_1,
@@ -127,7 +144,7 @@ rp_image *RpImageLoader::load(IRpFile *file)
 			  sizeof(RpImageLoaderPrivate::jpeg_magic_2)))
 		{
 			// Found a JPEG image.
-			return RpJpeg::load(file);
+			return RpJpeg::load(file, *pReqSize);
 		}
 #endif /* HAVE_JPEG */
 	}
@@ -136,4 +153,48 @@ rp_image *RpImageLoader::load(IRpFile *file)
 	return nullptr;
 }
 
+/**
+ * Load an image from an IRpFile.
+ *
+ * This image is verified with various tools to ensure
+ * it doesn't have any errors.
+ *
+ * If the file is on the local file system, the decoded image
+ * is shared with other callers using ImageCache, so it must
+ * not be modified.
+ *
+ * If reqSize is specified, JPEG images may be decoded at a
+ * reduced size. The larger dimension will be at least reqSize
+ * pixels, so the caller must still rescale the image.
+ *
+ * @param file IRpFile to load from.
+ * @param pngCheckLevel Verification level for PNG images.
+ * @param reqSize Requested size, or 0 for the original size.
+ * @return rp_image*, or nullptr on error.
+ */
+rp_image *RpImageLoader::load(IRpFile *file, RpPng::CheckLevel pngCheckLevel, int reqSize)
+{
+	// Check if this image was already decoded.
+	// A full-size image can be used for any requested size.
+	ImageCache::Key key;
+	const bool useImageCache = ImageCache::initKey(key, file, nullptr, 0, reqSize);
+	if (useImageCache) {
+		const rp_image *img = ImageCache::lookup(key);
+		if (!img && reqSize > 0) {
+			key.reqSize = 0;
+			img = ImageCache::lookup(key);
+		}
+		if (img) {
+			return const_cast<rp_image*>(img);
+		}
+	}
+
+	rp_image *const img = RpImageLoaderPrivate::load(file, pngCheckLevel, &reqSize);
+	if (img && useImageCache) {
+		key.reqSize = reqSize;
+		ImageCache::insert(key, img);
+	}
+	return img;
+}
+
 }
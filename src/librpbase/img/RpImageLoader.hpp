@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBRPBASE_IMG_RPIMAGELOADER_HPP__
 
 #include "common.h"
+#include "RpPng.hpp"
 
 namespace LibRpFile {
 	class IRpFile;
@@ -36,9 +37,10 @@ class RpImageLoader
 		 * with untrusted images!
 		 *
 		 * @param file IRpFile to load from.
+		 * @param reqSize Requested size, or 0 for the original size. (JPEG only; see RpJpeg)
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *loadUnchecked(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *loadUnchecked(LibRpFile::IRpFile *file, int reqSize = 0);
 
 		/**
 		 * Load an image from an IRpFile.
@@ -46,10 +48,18 @@ class RpImageLoader
 		 * This image is verified with various tools to ensure
 		 * it doesn't have any errors.
 		 *
+		 * If the file is on the local file system, the decoded image
+		 * is shared with other callers using ImageCache, so it must
+		 * not be modified.
+		 *
 		 * @param file IRpFile to load from.
+		 * @param pngCheckLevel Verification level for PNG images.
+		 * @param reqSize Requested size, or 0 for the original size. (JPEG only; see RpJpeg)
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file,
+			RpPng::CheckLevel pngCheckLevel = RpPng::CheckLevel::Full,
+			int reqSize = 0);
 };
 
 }
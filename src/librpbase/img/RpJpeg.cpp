@@ -211,10 +211,16 @@ void RpJpegPrivate::jpeg_IRpFile_src(j_decompress_ptr cinfo, IRpFile *infile)
  * This image is NOT checked for issues; do not use
  * with untrusted images!
  *
+ * If reqSize is specified, the image may be decoded at
+ * 1/2, 1/4, or 1/8 of its original size using libjpeg's
+ * DCT scaling, as long as the larger dimension is still
+ * at least reqSize pixels.
+ *
  * @param file IRpFile to load from.
+ * @param reqSize Requested size, or 0 for the original size.
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpJpeg::loadUnchecked(IRpFile *file)
+rp_image *RpJpeg::loadUnchecked(IRpFile *file, int reqSize)
 {
 	if (!file)
 		return nullptr;
@@ -324,6 +330,20 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 			break;
 	}
 
+	// If a smaller image was requested, let libjpeg do the
+	// downscaling in the IDCT. This skips most of the decoding
+	// work, and the thumbnail is scaled from a much smaller image.
+	// NOTE: Standard libjpeg only supports 1/1, 1/2, 1/4, and 1/8.
+	if (reqSize > 0) {
+		const unsigned int max_dim = std::max(cinfo.image_width, cinfo.image_height);
+		unsigned int denom = 8;
+		while (denom > 1 && ((max_dim + denom - 1) / denom) < static_cast<unsigned int>(reqSize)) {
+			denom /= 2;
+		}
+		cinfo.scale_num = 1;
+		cinfo.scale_denom = denom;
+	}
+
 	/** Step 5: Start decompressor. **/
 	// We can ignore the return value since suspension is not possible
 	// with the stdio data source (and IRpFile).
@@ -391,7 +411,7 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 				return nullptr;
 			}
 
-			img = new rp_image(cinfo.image_width, cinfo.image_height, rp_image::Format::ARGB32);
+			img = new rp_image(cinfo.output_width, cinfo.output_height, rp_image::Format::ARGB32);
 			if (!img->isValid()) {
 				// Could not allocate the image.
 				jpeg_destroy_decompress(&cinfo);
@@ -412,7 +432,7 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 				return nullptr;
 			}
 
-			img = new rp_image(cinfo.image_width, cinfo.image_height, rp_image::Format::ARGB32);
+			img = new rp_image(cinfo.output_width, cinfo.output_height, rp_image::Format::ARGB32);
 			if (!img->isValid()) {
 				// Could not allocate the image.
 				jpeg_destroy_decompress(&cinfo);
@@ -431,7 +451,7 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 				return nullptr;
 			}
 
-			img = new rp_image(cinfo.image_width, cinfo.image_height, rp_image::Format::ARGB32);
+			img = new rp_image(cinfo.output_width, cinfo.output_height, rp_image::Format::ARGB32);
 			if (!img->isValid()) {
 				// Could not allocate the image.
 				jpeg_destroy_decompress(&cinfo);
@@ -471,6 +491,11 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 					break;
 				}
 #endif /* RPJPEG_HAS_SSSE3 */
+#ifdef RPJPEG_HAS_NEON
+				// ARM64 always has NEON.
+				RpJpegPrivate::decodeBGRtoARGB(img, &cinfo, buffer);
+				break;
+#endif /* RPJPEG_HAS_NEON */
 
 				argb32_t *dest = static_cast<argb32_t*>(img->bits());
 				const int dest_stride_adj = (img->stride() / sizeof(argb32_t)) - img->width();
@@ -595,16 +620,22 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
  * This image is verified with various tools to ensure
  * it doesn't have any errors.
  *
+ * If reqSize is specified, the image may be decoded at
+ * 1/2, 1/4, or 1/8 of its original size using libjpeg's
+ * DCT scaling, as long as the larger dimension is still
+ * at least reqSize pixels.
+ *
  * @param file IRpFile to load from.
+ * @param reqSize Requested size, or 0 for the original size.
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpJpeg::load(IRpFile *file)
+rp_image *RpJpeg::load(IRpFile *file, int reqSize)
 {
 	if (!file)
 		return nullptr;
 
 	// FIXME: Add a JPEG equivalent of pngcheck().
-	return loadUnchecked(file);
+	return loadUnchecked(file, reqSize);
 }
 
 }
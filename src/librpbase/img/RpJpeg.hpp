@@ -35,10 +35,16 @@ class RpJpeg
 		 * This image is NOT checked for issues; do not use
 		 * with untrusted images!
 		 *
+		 * If reqSize is specified, the image may be decoded at
+		 * 1/2, 1/4, or 1/8 of its original size using libjpeg's
+		 * DCT scaling, as long as the larger dimension is still
+		 * at least reqSize pixels.
+		 *
 		 * @param file IRpFile to load from.
+		 * @param reqSize Requested size, or 0 for the original size.
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *loadUnchecked(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *loadUnchecked(LibRpFile::IRpFile *file, int reqSize = 0);
 
 		/**
 		 * Load a JPEG image from an IRpFile.
@@ -46,10 +52,16 @@ class RpJpeg
 		 * This image is verified with various tools to ensure
 		 * it doesn't have any errors.
 		 *
+		 * If reqSize is specified, the image may be decoded at
+		 * 1/2, 1/4, or 1/8 of its original size using libjpeg's
+		 * DCT scaling, as long as the larger dimension is still
+		 * at least reqSize pixels.
+		 *
 		 * @param file IRpFile to load from.
+		 * @param reqSize Requested size, or 0 for the original size.
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file, int reqSize = 0);
 };
 
 }
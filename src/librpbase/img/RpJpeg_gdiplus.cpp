@@ -41,11 +41,15 @@ namespace LibRpBase {
  * This image is NOT checked for issues; do not use
  * with untrusted images!
  *
+ * NOTE: reqSize is ignored; GDI+ always decodes the full image.
+ *
  * @param file IRpFile to load from.
+ * @param reqSize Requested size, or 0 for the original size.
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpJpeg::loadUnchecked(IRpFile *file)
+rp_image *RpJpeg::loadUnchecked(IRpFile *file, int reqSize)
 {
+	RP_UNUSED(reqSize);
 	if (!file)
 		return nullptr;
 
@@ -80,16 +84,19 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
  * This image is verified with various tools to ensure
  * it doesn't have any errors.
  *
+ * NOTE: reqSize is ignored; GDI+ always decodes the full image.
+ *
  * @param file IRpFile to load from.
+ * @param reqSize Requested size, or 0 for the original size.
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpJpeg::load(IRpFile *file)
+rp_image *RpJpeg::load(IRpFile *file, int reqSize)
 {
 	if (!file)
 		return nullptr;
 
 	// FIXME: Add a JPEG equivalent of pngcheck().
-	return loadUnchecked(file);
+	return loadUnchecked(file, reqSize);
 }
 
 }
@@ -0,0 +1,69 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * RpJpeg.cpp: JPEG image handler.                                         *
+ * NEON-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2019 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpJpeg_p.hpp"
+
+// librptexture
+using LibRpTexture::rp_image;
+using LibRpTexture::argb32_t;
+
+// NEON intrinsics.
+#include <arm_neon.h>
+
+namespace LibRpBase {
+
+/**
+ * Decode a 24-bit BGR JPEG to 32-bit ARGB.
+ * NEON-optimized version.
+ * NOTE: This function should ONLY be called from RpJpeg::loadUnchecked().
+ * @param img		[in/out] rp_image.
+ * @param cinfo		[in/out] JPEG decompression struct.
+ * @param buffer 	[in/out] Line buffer. (Must be 16-byte aligned!)
+ */
+void RpJpegPrivate::decodeBGRtoARGB(rp_image *RESTRICT img, jpeg_decompress_struct *RESTRICT cinfo, JSAMPARRAY buffer)
+{
+	ASSERT_ALIGNMENT(16, buffer);
+	assert(img->format() == rp_image::Format::ARGB32);
+
+	// vld3q_u8() deinterleaves the source bytes into R, G, and B,
+	// which are then stored as B, G, R, and A using vst4q_u8().
+	const uint8x16_t alpha = vdupq_n_u8(0xFF);
+	argb32_t *dest = static_cast<argb32_t*>(img->bits());
+	const int dest_stride_adj = (img->stride() / sizeof(argb32_t)) - img->width();
+	while (cinfo->output_scanline < cinfo->output_height) {
+		jpeg_read_scanlines(cinfo, buffer, 1);
+		const uint8_t *src = buffer[0];
+
+		// Process 16 pixels per iteration using NEON.
+		unsigned int x = cinfo->output_width;
+		for (; x > 15; x -= 16, dest += 16, src += 16*3) {
+			const uint8x16x3_t rgb = vld3q_u8(src);
+			uint8x16x4_t argb;
+			argb.val[0] = rgb.val[2];
+			argb.val[1] = rgb.val[1];
+			argb.val[2] = rgb.val[0];
+			argb.val[3] = alpha;
+			vst4q_u8(reinterpret_cast<uint8_t*>(dest), argb);
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, dest++, src += 3) {
+			dest->b = src[2];
+			dest->g = src[1];
+			dest->r = src[0];
+			dest->a = 0xFF;
+		}
+
+		// Next line.
+		dest += dest_stride_adj;
+	}
+}
+
+}
@@ -36,6 +36,9 @@
     defined(_M_IX86) || defined(_M_X64)
 # define RPJPEG_HAS_SSSE3 1
 #endif
+#ifdef RP_CPU_ALWAYS_HAS_NEON
+# define RPJPEG_HAS_NEON 1
+#endif
 
 namespace LibRpFile {
 	class IRpFile;
@@ -123,17 +126,17 @@ class RpJpegPrivate
 		static void jpeg_IRpFile_src(j_decompress_ptr cinfo, LibRpFile::IRpFile *infile);
 
 	public:
-#ifdef RPJPEG_HAS_SSSE3
+#if defined(RPJPEG_HAS_SSSE3) || defined(RPJPEG_HAS_NEON)
 		/**
 		 * Decode a 24-bit BGR JPEG to 32-bit ARGB.
-		 * SSSE3-optimized version.
+		 * SSSE3- or NEON-optimized version.
 		 * NOTE: This function should ONLY be called from RpJpeg::loadUnchecked().
 		 * @param img		[in/out] rp_image.
 		 * @param cinfo		[in/out] JPEG decompression struct.
 		 * @param buffer 	[in/out] Line buffer. (Must be 16-byte aligned!)
 		 */
 		static void decodeBGRtoARGB(LibRpTexture::rp_image *RESTRICT img, jpeg_decompress_struct *RESTRICT cinfo, JSAMPARRAY buffer);
-#endif /* RPJPEG_HAS_SSSE3 */
+#endif /* RPJPEG_HAS_SSSE3 || RPJPEG_HAS_NEON */
 };
 
 }
@@ -152,6 +152,17 @@ class RpPngPrivate
 		 * @return rp_image*, or nullptr on error.
 		 */
 		static rp_image *loadPng(png_structp png_ptr, png_infop info_ptr);
+
+		/**
+		 * Check a PNG image's chunk structure.
+		 *
+		 * Only the signature and chunk headers are checked.
+		 * Chunk data and CRCs are left to libpng.
+		 *
+		 * @param file IRpFile to check.
+		 * @return True if the chunk structure is valid; false if not.
+		 */
+		static bool checkChunkStructure(IRpFile *file);
 };
 
 /** RpPngPrivate **/
@@ -334,8 +345,6 @@ void RpPngPrivate::Read_CI8_Palette(png_structp png_ptr, png_infop info_ptr,
  */
 rp_image *RpPngPrivate::loadPng(png_structp png_ptr, png_infop info_ptr)
 {
-	// Row pointers. (NOTE: Allocated after IHDR is read.)
-	const png_byte **row_pointers = nullptr;
 	rp_image *img = nullptr;
 
 	bool has_sBIT = false;
@@ -346,7 +355,6 @@ rp_image *RpPngPrivate::loadPng(png_structp png_ptr, png_infop info_ptr)
 	// WARNING: Do NOT initialize any C++ objects past this point!
 	if (setjmp(png_jmpbuf(png_ptr))) {
 		// PNG read failed.
-		png_free(png_ptr, row_pointers);
 		img->unref();
 		return nullptr;
 	}
@@ -503,12 +511,14 @@ rp_image *RpPngPrivate::loadPng(png_structp png_ptr, png_infop info_ptr)
 	// We're using "BGR" color.
 	png_set_bgr(png_ptr);
 
+	// Interlaced images are read in multiple passes.
+	// NOTE: This must be set before png_read_update_info().
+	const int passes = png_set_interlace_handling(png_ptr);
+
 	// Update the PNG info.
 	png_read_update_info(png_ptr, info_ptr);
 
 	// Create the rp_image.
-
-	// Initialize the row pointers array.
 	img = new rp_image(width, height, fmt);
 	if (!img->isValid()) {
 		// Could not allocate the image.
@@ -516,25 +526,20 @@ rp_image *RpPngPrivate::loadPng(png_structp png_ptr, png_infop info_ptr)
 		return nullptr;
 	}
 
-	// Allocate the row pointers.
-	row_pointers = static_cast<const png_byte**>(
-		png_malloc(png_ptr, sizeof(const png_byte*) * height));
-	if (!row_pointers) {
-		img->unref();
-		return nullptr;
-	}
-
-	// Initialize the row pointers array.
-	const png_byte *pb = static_cast<const png_byte*>(img->bits());
+	// Read the image.
+	// The transforms set above convert each row to the final
+	// CI8 or ARGB32 format, so libpng can write the rows directly
+	// into the rp_image_backend's buffer. No row pointer array
+	// or intermediate buffer is needed.
+	png_byte *const bits = static_cast<png_byte*>(img->bits());
 	const int stride = img->stride();
-	for (png_uint_32 y = 0; y < height; y++, pb += stride) {
-		row_pointers[y] = pb;
+	for (int pass = passes; pass > 0; pass--) {
+		png_byte *pb = bits;
+		for (png_uint_32 y = height; y > 0; y--, pb += stride) {
+			png_read_row(png_ptr, pb, nullptr);
+		}
 	}
 
-	// Read the image.
-	png_read_image(png_ptr, const_cast<png_byte**>(row_pointers));
-	png_free(png_ptr, row_pointers);
-
 	// If CI8, read the palette.
 	if (fmt == rp_image::Format::CI8) {
 		Read_CI8_Palette(png_ptr, info_ptr, color_type, img);
@@ -555,6 +560,76 @@ rp_image *RpPngPrivate::loadPng(png_structp png_ptr, png_infop info_ptr)
 	return img;
 }
 
+/**
+ * Check a PNG image's chunk structure.
+ *
+ * Only the signature and chunk headers are checked.
+ * Chunk data and CRCs are left to libpng.
+ *
+ * @param file IRpFile to check.
+ * @return True if the chunk structure is valid; false if not.
+ */
+bool RpPngPrivate::checkChunkStructure(IRpFile *file)
+{
+	static const uint8_t png_sig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+	const off64_t fileSize = file->size();
+	uint8_t buf[8];
+	if (file->seekAndRead(0, buf, sizeof(buf)) != sizeof(buf) ||
+	    memcmp(buf, png_sig, sizeof(png_sig)) != 0)
+	{
+		// Not a PNG image.
+		return false;
+	}
+
+	// Check the chunk headers.
+	// Each chunk has a 4-byte length, 4-byte type, data, and a 4-byte CRC.
+	off64_t pos = sizeof(png_sig);
+	bool isFirst = true;
+	while (pos + 12 <= fileSize) {
+		if (file->seekAndRead(pos, buf, sizeof(buf)) != sizeof(buf)) {
+			// Read error.
+			return false;
+		}
+
+		uint32_t length;
+		memcpy(&length, buf, sizeof(length));
+		length = be32_to_cpu(length);
+		if (length > 0x7FFFFFFFU) {
+			// Chunk length is invalid.
+			return false;
+		}
+
+		// Chunk type must consist of ASCII letters.
+		for (unsigned int i = 4; i < 8; i++) {
+			if (!ISALPHA(buf[i])) {
+				return false;
+			}
+		}
+
+		if (isFirst) {
+			// The first chunk must be IHDR.
+			if (memcmp(&buf[4], "IHDR", 4) != 0 || length != 13) {
+				return false;
+			}
+			isFirst = false;
+		}
+
+		pos += 12 + static_cast<off64_t>(length);
+		if (pos > fileSize) {
+			// Chunk extends past the end of the file.
+			return false;
+		} else if (!memcmp(&buf[4], "IEND", 4)) {
+			// End of the PNG image.
+			return true;
+		}
+	}
+
+	// NOTE: A missing IEND chunk is allowed,
+	// since pngcheck() considers it a minor error.
+	return !isFirst;
+}
+
 /** RpPng **/
 
 /**
@@ -620,22 +695,41 @@ rp_image *RpPng::loadUnchecked(IRpFile *file)
  * it doesn't have any errors.
  *
  * @param file IRpFile to load from.
+ * @param checkLevel Verification level.
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpPng::load(IRpFile *file)
+rp_image *RpPng::load(IRpFile *file, CheckLevel checkLevel)
 {
 	if (!file)
 		return nullptr;
 
-	// Check the image with pngcheck() first.
-	file->rewind();
-	int ret = pngcheck(file);
-	// NOTE: BK Pocket Bike Racer's icon is missing the IEND chunk.
-	// pngcheck returns kMinorError in that case.
-	// TODO: Make it a special exception?
-	if (ret != kOK && ret != kMinorError) {
-		// PNG image has major errors.
-		return nullptr;
+	switch (checkLevel) {
+		default:
+		case CheckLevel::Full: {
+			// Check the image with pngcheck() first.
+			file->rewind();
+			int ret = pngcheck(file);
+			// NOTE: BK Pocket Bike Racer's icon is missing the IEND chunk.
+			// pngcheck returns kMinorError in that case.
+			// TODO: Make it a special exception?
+			if (ret != kOK && ret != kMinorError) {
+				// PNG image has major errors.
+				return nullptr;
+			}
+			break;
+		}
+
+		case CheckLevel::Structure:
+			// Only check the chunk headers.
+			if (!RpPngPrivate::checkChunkStructure(file)) {
+				// PNG image has structural errors.
+				return nullptr;
+			}
+			break;
+
+		case CheckLevel::None:
+			// Trusted image.
+			break;
 	}
 
 	// PNG image has been validated.
@@ -651,9 +745,11 @@ rp_image *RpPng::load(IRpFile *file)
  *
  * @param file IRpFile to write to.
  * @param img rp_image to save.
+ * @param params Compression parameters. (If nullptr, use the defaults.)
  * @return 0 on success; negative POSIX error code on error.
  */
-int RpPng::save(IRpFile *file, const rp_image *img)
+int RpPng::save(IRpFile *file, const rp_image *img,
+	const RpPngWriter::CompressionParams *params)
 {
 	assert(file != nullptr);
 	assert(img != nullptr);
@@ -665,8 +761,15 @@ int RpPng::save(IRpFile *file, const rp_image *img)
 	if (!pngWriter->isOpen())
 		return -pngWriter->lastError();
 
+	int ret;
+	if (params) {
+		ret = pngWriter->setCompressionParams(*params);
+		if (ret != 0)
+			return ret;
+	}
+
 	// Write the PNG IHDR.
-	int ret = pngWriter->write_IHDR();
+	ret = pngWriter->write_IHDR();
 	if (ret != 0)
 		return ret;
 
@@ -679,9 +782,11 @@ int RpPng::save(IRpFile *file, const rp_image *img)
  *
  * @param filename Destination filename.
  * @param img rp_image to save.
+ * @param params Compression parameters. (If nullptr, use the defaults.)
  * @return 0 on success; negative POSIX error code on error.
  */
-int RpPng::save(const char *filename, const rp_image *img)
+int RpPng::save(const char *filename, const rp_image *img,
+	const RpPngWriter::CompressionParams *params)
 {
 	assert(filename != nullptr);
 	assert(filename[0] != 0);
@@ -694,8 +799,15 @@ int RpPng::save(const char *filename, const rp_image *img)
 	if (!pngWriter->isOpen())
 		return -pngWriter->lastError();
 
+	int ret;
+	if (params) {
+		ret = pngWriter->setCompressionParams(*params);
+		if (ret != 0)
+			return ret;
+	}
+
 	// Write the PNG IHDR.
-	int ret = pngWriter->write_IHDR();
+	ret = pngWriter->write_IHDR();
 	if (ret != 0)
 		return ret;
 
@@ -720,9 +832,11 @@ int RpPng::save(const char *filename, const rp_image *img)
  *
  * @param file IRpFile to write to.
  * @param iconAnimData Animated image data to save.
+ * @param params Compression parameters. (If nullptr, use the defaults.)
  * @return 0 on success; negative POSIX error code on error.
  */
-int RpPng::save(IRpFile *file, const IconAnimData *iconAnimData)
+int RpPng::save(IRpFile *file, const IconAnimData *iconAnimData,
+	const RpPngWriter::CompressionParams *params)
 {
 	assert(file != nullptr);
 	assert(iconAnimData != nullptr);
@@ -734,8 +848,15 @@ int RpPng::save(IRpFile *file, const IconAnimData *iconAnimData)
 	if (!pngWriter->isOpen())
 		return -pngWriter->lastError();
 
+	int ret;
+	if (params) {
+		ret = pngWriter->setCompressionParams(*params);
+		if (ret != 0)
+			return ret;
+	}
+
 	// Write the PNG IHDR.
-	int ret = pngWriter->write_IHDR();
+	ret = pngWriter->write_IHDR();
 	if (ret != 0)
 		return ret;
 
@@ -757,9 +878,11 @@ int RpPng::save(IRpFile *file, const IconAnimData *iconAnimData)
  *
  * @param filename Destination filename.
  * @param iconAnimData Animated image data to save.
+ * @param params Compression parameters. (If nullptr, use the defaults.)
  * @return 0 on success; negative POSIX error code on error.
  */
-int RpPng::save(const char *filename, const IconAnimData *iconAnimData)
+int RpPng::save(const char *filename, const IconAnimData *iconAnimData,
+	const RpPngWriter::CompressionParams *params)
 {
 	assert(filename != nullptr);
 	assert(filename[0] != 0);
@@ -772,8 +895,15 @@ int RpPng::save(const char *filename, const IconAnimData *iconAnimData)
 	if (!pngWriter->isOpen())
 		return -pngWriter->lastError();
 
+	int ret;
+	if (params) {
+		ret = pngWriter->setCompressionParams(*params);
+		if (ret != 0)
+			return ret;
+	}
+
 	// Write the PNG IHDR.
-	int ret = pngWriter->write_IHDR();
+	ret = pngWriter->write_IHDR();
 	if (ret != 0)
 		return ret;
 
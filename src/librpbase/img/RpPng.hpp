@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBRPBASE_IMG_RPPNG_HPP__
 
 #include "common.h"
+#include "RpPngWriter.hpp"
 
 namespace LibRpFile {
 	class IRpFile;
@@ -31,6 +32,24 @@ class RpPng
 		RP_DISABLE_COPY(RpPng)
 
 	public:
+		/**
+		 * PNG verification level for load().
+		 */
+		enum class CheckLevel {
+			// Full pngcheck() verification.
+			// Use this for untrusted images.
+			Full,
+
+			// Check the chunk headers only.
+			// Chunk data and CRCs are not checked.
+			Structure,
+
+			// No verification.
+			// Only use this for images that were
+			// written by rom-properties itself.
+			None,
+		};
+
 		/**
 		 * Load a PNG image from an IRpFile.
 		 *
@@ -49,9 +68,11 @@ class RpPng
 		 * it doesn't have any errors.
 		 *
 		 * @param file IRpFile to load from.
+		 * @param checkLevel Verification level.
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file,
+			CheckLevel checkLevel = CheckLevel::Full);
 
 		/**
 		 * Save an image in PNG format to an IRpFile.
@@ -62,18 +83,22 @@ class RpPng
 		 *
 		 * @param file IRpFile to write to.
 		 * @param img rp_image to save.
+		 * @param params Compression parameters. (If nullptr, use the defaults.)
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		static int save(LibRpFile::IRpFile *file, const LibRpTexture::rp_image *img);
+		static int save(LibRpFile::IRpFile *file, const LibRpTexture::rp_image *img,
+			const RpPngWriter::CompressionParams *params = nullptr);
 
 		/**
 		 * Save an image in PNG format to a file.
 		 *
 		 * @param filename Destination filename.
 		 * @param img rp_image to save.
+		 * @param params Compression parameters. (If nullptr, use the defaults.)
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		static int save(const char *filename, const LibRpTexture::rp_image *img);
+		static int save(const char *filename, const LibRpTexture::rp_image *img,
+			const RpPngWriter::CompressionParams *params = nullptr);
 
 		/**
 		 * Save an animated image in APNG format to an IRpFile.
@@ -92,9 +117,11 @@ class RpPng
 		 *
 		 * @param file IRpFile to write to.
 		 * @param iconAnimData Animated image data to save.
+		 * @param params Compression parameters. (If nullptr, use the defaults.)
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		static int save(LibRpFile::IRpFile *file, const IconAnimData *iconAnimData);
+		static int save(LibRpFile::IRpFile *file, const IconAnimData *iconAnimData,
+			const RpPngWriter::CompressionParams *params = nullptr);
 
 		/**
 		 * Save an animated image in APNG format to a file.
@@ -109,9 +136,11 @@ class RpPng
 		 *
 		 * @param filename Destination filename.
 		 * @param iconAnimData Animated image data to save.
+		 * @param params Compression parameters. (If nullptr, use the defaults.)
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		static int save(const char *filename, const IconAnimData *iconAnimData);
+		static int save(const char *filename, const IconAnimData *iconAnimData,
+			const RpPngWriter::CompressionParams *params = nullptr);
 };
 
 }
@@ -77,14 +77,20 @@ using LibRpTexture::argb32_t;
 #include <csetjmp>
 
 // C++ STL classes.
+#include <atomic>
 using std::array;
 using std::string;
 using std::unique_ptr;
 using std::vector;
 
-#if defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL))
-// Need zlib for delay-load checks.
+// zlib for multi-threaded IDAT compression.
 #include <zlib.h>
+
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::ThreadPool;
+
+#if defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL))
 // MSVC: Exception handling for /DELAYLOAD.
 #include "libwin32common/DelayLoadHelper.h"
 #endif /* defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL)) */
@@ -110,6 +116,215 @@ static int DelayLoad_test_zlib_and_png(void)
 }
 #endif /* defined(_MSC_VER) && (defined(ZLIB_IS_DLL) || defined(PNG_IS_DLL)) */
 
+// Multi-threaded compression: Uncompressed chunk size. (same as pigz)
+static const size_t MT_CHUNK_SIZE = 128U * 1024U;
+// Multi-threaded compression: Preset dictionary size.
+static const size_t ZLIB_WINDOW_SIZE = 32U * 1024U;
+// Maximum IDAT chunk size when writing pre-compressed data.
+static const size_t IDAT_MAX_SIZE = 1024U * 1024U;
+
+/**
+ * Convert an image row to PNG pixel order.
+ * @param dest		[out] Destination row. (width * bytespp)
+ * @param src		[in] Source row: CI8 or ARGB32.
+ * @param width		[in] Width, in pixels.
+ * @param bytespp	[in] Destination bytes per pixel: 1 (CI8), 3 (RGB), or 4 (RGBA)
+ * @param is_abgr	[in] If true, source data is ABGR instead of ARGB.
+ */
+static void convertRow(uint8_t *dest, const uint8_t *src, int width, unsigned int bytespp, bool is_abgr)
+{
+	if (bytespp == 1) {
+		// CI8: Copy as-is.
+		memcpy(dest, src, width);
+		return;
+	}
+
+	const argb32_t *px = reinterpret_cast<const argb32_t*>(src);
+	for (int x = width; x > 0; x--, px++, dest += bytespp) {
+		dest[0] = (is_abgr ? px->b : px->r);
+		dest[1] = px->g;
+		dest[2] = (is_abgr ? px->r : px->b);
+		if (bytespp == 4) {
+			dest[3] = px->a;
+		}
+	}
+}
+
+/**
+ * Reduce an ARGB32 image to CI8 if it has no more than 256 colors.
+ *
+ * Colors are counted using a small open-addressing hash table,
+ * and counting stops as soon as the 257th color is found, so
+ * images with too many colors are rejected early.
+ *
+ * Palette entries with transparency are moved to the start of
+ * the palette so the tRNS chunk is as short as possible.
+ *
+ * @param img		[in] ARGB32 image.
+ * @param palette	[out] Palette. (must have 256 entries)
+ * @param bits		[out] CI8 image data. (width * height)
+ * @return Number of palette entries, or 0 if the image has too many colors.
+ */
+static int reduceToCI8(const rp_image *img, uint32_t *palette, uint8_t *bits)
+{
+	assert(img->format() == rp_image::Format::ARGB32);
+
+	// Hash table. With at most 256 colors, it's never more than 25% full.
+	static const unsigned int HASH_BITS = 10;
+	static const unsigned int HASH_SIZE = 1U << HASH_BITS;
+	uint32_t keys[HASH_SIZE];
+	int16_t values[HASH_SIZE];	// -1 == empty
+	memset(values, 0xFF, sizeof(values));
+
+	const int width = img->width();
+	const int height = img->height();
+	int count = 0;
+
+	// Adjacent pixels are usually the same color.
+	uint32_t last_color = 0;
+	uint8_t last_idx = 0;
+	bool has_last = false;
+
+	uint8_t *dest = bits;
+	for (int y = 0; y < height; y++) {
+		const uint32_t *px = static_cast<const uint32_t*>(img->scanLine(y));
+		for (int x = width; x > 0; x--, px++, dest++) {
+			const uint32_t color = *px;
+			if (has_last && color == last_color) {
+				*dest = last_idx;
+				continue;
+			}
+
+			unsigned int h = (color * 0x9E3779B1U) >> (32 - HASH_BITS);
+			while (values[h] >= 0 && keys[h] != color) {
+				h = (h + 1) & (HASH_SIZE - 1);
+			}
+			if (values[h] < 0) {
+				// New color.
+				if (count >= 256) {
+					// Too many colors.
+					return 0;
+				}
+				keys[h] = color;
+				values[h] = static_cast<int16_t>(count);
+				palette[count++] = color;
+			}
+
+			last_color = color;
+			last_idx = static_cast<uint8_t>(values[h]);
+			has_last = true;
+			*dest = last_idx;
+		}
+	}
+
+	// Move the palette entries with transparency to the start.
+	array<uint8_t, 256> remap;
+	array<uint32_t, 256> sorted;
+	int t = 0;
+	bool identity = true;
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < count; i++) {
+			const bool opaque = ((palette[i] >> 24) == 0xFF);
+			if (opaque == (pass != 0)) {
+				remap[i] = static_cast<uint8_t>(t);
+				sorted[t] = palette[i];
+				identity &= (i == t);
+				t++;
+			}
+		}
+	}
+	if (!identity) {
+		memcpy(palette, sorted.data(), count * sizeof(uint32_t));
+		const size_t size = static_cast<size_t>(width) * static_cast<size_t>(height);
+		for (size_t i = 0; i < size; i++) {
+			bits[i] = remap[bits[i]];
+		}
+	}
+	return count;
+}
+
+/**
+ * PNG Paeth predictor.
+ * @param a Left
+ * @param b Above
+ * @param c Upper left
+ * @return Predicted value.
+ */
+static inline uint8_t paethPredictor(uint8_t a, uint8_t b, uint8_t c)
+{
+	const int p = a + b - c;
+	const int pa = abs(p - a);
+	const int pb = abs(p - b);
+	const int pc = abs(p - c);
+	if (pa <= pb && pa <= pc)
+		return a;
+	return (pb <= pc) ? b : c;
+}
+
+/**
+ * Filter an image row.
+ * If more than one filter is allowed, the filter with the lowest
+ * sum of absolute differences is used. (same heuristic as libpng)
+ * @param dest		[out] Filtered row, including the filter type byte. (row_bytes + 1)
+ * @param cur		[in] Current row.
+ * @param prev		[in] Previous row. (all zeroes for the first row)
+ * @param row_bytes	[in] Row size, in bytes.
+ * @param bytespp	[in] Bytes per pixel.
+ * @param filters	[in] Allowed filters. (RpPngWriter::FilterFlags)
+ * @param tmp		[in] Temporary buffer. (row_bytes + 1)
+ */
+static void filterRow(uint8_t *dest, const uint8_t *cur, const uint8_t *prev,
+	size_t row_bytes, unsigned int bytespp, uint8_t filters, uint8_t *tmp)
+{
+	uint8_t *best = nullptr;
+	uint8_t *cand = dest;
+	unsigned int best_sum = ~0U;
+
+	for (unsigned int type = 0; type < 5; type++) {
+		if (!(filters & (RpPngWriter::FILTER_NONE << type)))
+			continue;
+
+		cand[0] = static_cast<uint8_t>(type);
+		uint8_t *const out = &cand[1];
+		for (size_t i = 0; i < row_bytes; i++) {
+			const uint8_t a = (i >= bytespp ? cur[i - bytespp] : 0);
+			const uint8_t b = prev[i];
+			const uint8_t c = (i >= bytespp ? prev[i - bytespp] : 0);
+			uint8_t pred;
+			switch (type) {
+				default:
+				case 0:	pred = 0; break;
+				case 1:	pred = a; break;
+				case 2:	pred = b; break;
+				case 3:	pred = static_cast<uint8_t>((a + b) / 2); break;
+				case 4:	pred = paethPredictor(a, b, c); break;
+			}
+			out[i] = static_cast<uint8_t>(cur[i] - pred);
+		}
+
+		if (filters == (RpPngWriter::FILTER_NONE << type)) {
+			// Only one filter is allowed.
+			best = cand;
+			break;
+		}
+
+		// Sum of absolute differences, treating bytes as signed.
+		unsigned int sum = 0;
+		for (size_t i = 0; i < row_bytes; i++) {
+			sum += abs(static_cast<int8_t>(out[i]));
+		}
+		if (sum < best_sum) {
+			best_sum = sum;
+			best = cand;
+			cand = (cand == dest ? tmp : dest);
+		}
+	}
+
+	if (best != dest) {
+		memcpy(dest, best, row_bytes + 1);
+	}
+}
+
 class RpPngWriterPrivate
 {
 	public:
@@ -118,18 +333,21 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(IRpFile *file, int width, int height, rp_image::Format format)
 			: lastError(0), file(nullptr), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, IEND_written(false), text_after_IHDR(false)
 		{
 			init(file, width, height, format);
 		}
 		RpPngWriterPrivate(IRpFile *file, const rp_image *img)
 			: lastError(0), file(nullptr), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, IEND_written(false), text_after_IHDR(false)
 		{
 			init(file, img);
 		}
 		RpPngWriterPrivate(IRpFile *file, const IconAnimData *iconAnimData)
 			: lastError(0), file(nullptr), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, IEND_written(false), text_after_IHDR(false)
 		{
 			init(file, iconAnimData);
 		}
@@ -137,6 +355,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, int width, int height, rp_image::Format format)
 			: lastError(0), file(nullptr), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, IEND_written(false), text_after_IHDR(false)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, width, height, format);
@@ -145,6 +364,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, const rp_image *img)
 			: lastError(0), file(nullptr), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, IEND_written(false), text_after_IHDR(false)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, img);
@@ -153,6 +373,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, const IconAnimData *iconAnimData)
 			: lastError(0), file(nullptr), imageTag(ImageTag::Invalid)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, IEND_written(false), text_after_IHDR(false)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, iconAnimData);
@@ -252,6 +473,23 @@ class RpPngWriterPrivate
 #endif /* PNG_sBIT_SUPPORTED */
 			}
 
+#ifdef PNG_sBIT_SUPPORTED
+			/**
+			 * Skip the alpha channel if the image is fully opaque.
+			 * NOTE: Don't use this for animated images, since
+			 * other frames may have transparent pixels.
+			 * @param img rp_image
+			 */
+			void checkOpaque(const rp_image *img)
+			{
+				if (!skip_alpha && img &&
+				    img->format() == rp_image::Format::ARGB32 && img->isOpaque())
+				{
+					skip_alpha = true;
+				}
+			}
+#endif /* PNG_sBIT_SUPPORTED */
+
 			void set_sBIT(const rp_image::sBIT_t* sBIT)
 			{
 				static const rp_image::sBIT_t sBIT_invalid = {0,0,0,0,0};
@@ -273,8 +511,18 @@ class RpPngWriterPrivate
 		png_structp png_ptr;
 		png_infop info_ptr;
 
+		// Compression parameters.
+		RpPngWriter::CompressionParams params;
+
+		// ARGB32 image reduced to CI8 by reducePalette().
+		// If set, this is written instead of the rp_image data.
+		unique_ptr<uint8_t[]> ci8_bits;
+		unique_ptr<uint32_t[]> ci8_palette;
+
 		// Current state.
 		bool IHDR_written;
+		bool IEND_written;	// IEND was written by write_IDAT_mt().
+		bool text_after_IHDR;	// tEXt was set after IHDR, so it must be written by libpng.
 
 	public:
 		/**
@@ -307,6 +555,13 @@ class RpPngWriterPrivate
 	public:
 		/** Internal functions. **/
 
+		/**
+		 * Reduce an ARGB32 rp_image to CI8 if it has no more than 256 colors.
+		 * If successful, the cached format and palette are changed to CI8.
+		 * This must be called before IHDR is written.
+		 */
+		void reducePalette(void);
+
 		/**
 		 * Write the palette from a CI8 image.
 		 * @return 0 on success; negative POSIX error code on error.
@@ -339,6 +594,35 @@ class RpPngWriterPrivate
 		 */
 		int write_IDAT(void);
 
+		/**
+		 * Should the image data be compressed using multiple threads?
+		 * @return True if multi-threaded compression should be used.
+		 */
+		bool useMtCompression(void) const;
+
+		/**
+		 * Write raw image data to the PNG image using multi-threaded compression.
+		 *
+		 * The image is filtered and split into 128 KB chunks, which are
+		 * compressed in parallel as separate raw deflate streams using
+		 * the preceding 32 KB as a preset dictionary. (same as pigz)
+		 *
+		 * The IDAT and IEND chunks are written directly.
+		 *
+		 * @param row_pointers PNG row pointers. Array must have cache.height elements.
+		 * @param is_abgr If true, image data is ABGR instead of ARGB.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int write_IDAT_mt(const png_byte *const *row_pointers, bool is_abgr);
+
+		/**
+		 * Write pre-compressed zlib data as IDAT chunks, followed by IEND.
+		 * @param zdata Compressed zlib stream.
+		 * @param zsize Size of zdata.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int write_IDAT_chunks(const uint8_t *zdata, size_t zsize);
+
 		/**
 		 * Write the animated image data to the PNG image.
 		 *
@@ -475,6 +759,9 @@ void RpPngWriterPrivate::init(IRpFile *file, const rp_image *img)
 	// Cache the image parameters.
 	imageTag = ImageTag::RpImage;
 	cache.setFrom(img);
+#ifdef PNG_sBIT_SUPPORTED
+	cache.checkOpaque(img);
+#endif /* PNG_sBIT_SUPPORTED */
 }
 
 void RpPngWriterPrivate::init(IRpFile *file, const IconAnimData *iconAnimData)
@@ -548,6 +835,9 @@ void RpPngWriterPrivate::init(IRpFile *file, const IconAnimData *iconAnimData)
 	} else {
 		this->img = iconAnimData->frames[iconAnimData->seq_index[0]];
 		cache.setFrom(img);
+#ifdef PNG_sBIT_SUPPORTED
+		cache.checkOpaque(img);
+#endif /* PNG_sBIT_SUPPORTED */
 	}
 
 	// ref() the file.
@@ -612,7 +902,7 @@ void RpPngWriterPrivate::close(void)
 			// TODO: unlink()?
 		} else
 #endif /* PNG_SETJMP_SUPPORTED */
-		{
+		if (!IEND_written) {
 			// Attempt to finish writing the PNG file.
 			png_write_end(png_ptr, info_ptr);
 		}
@@ -658,6 +948,37 @@ void PNGCAPI RpPngWriterPrivate::png_io_IRpFile_flush(png_structp png_ptr)
 	// TODO: IRpFile::flush()
 }
 
+/**
+ * Reduce an ARGB32 rp_image to CI8 if it has no more than 256 colors.
+ * If successful, the cached format and palette are changed to CI8.
+ * This must be called before IHDR is written.
+ */
+void RpPngWriterPrivate::reducePalette(void)
+{
+	assert(!IHDR_written);
+	if (imageTag != ImageTag::RpImage || !img ||
+	    cache.format != rp_image::Format::ARGB32)
+	{
+		// Only single ARGB32 rp_images can be reduced.
+		return;
+	}
+
+	const size_t size = static_cast<size_t>(cache.width) * static_cast<size_t>(cache.height);
+	unique_ptr<uint8_t[]> bits(new uint8_t[size]);
+	unique_ptr<uint32_t[]> palette(new uint32_t[256]);
+	const int count = reduceToCI8(img, palette.get(), bits.get());
+	if (count <= 0) {
+		// Too many colors.
+		return;
+	}
+
+	ci8_bits = std::move(bits);
+	ci8_palette = std::move(palette);
+	cache.format = rp_image::Format::CI8;
+	cache.palette = ci8_palette.get();
+	cache.palette_len = count;
+}
+
 /**
  * Write the palette from a CI8 image.
  * @return 0 on success; negative POSIX error code on error.
@@ -681,13 +1002,13 @@ int RpPngWriterPrivate::write_CI8_palette(void)
 	// Maximum size.
 	array<png_color, 256> png_pal;
 	array<uint8_t, 256> png_tRNS;
-	bool has_tRNS = false;
+	int num_trans = 0;
 
 	// Convert the palette.
 	const argb32_t *p_img_pal = reinterpret_cast<const argb32_t*>(cache.palette);
 	png_color *p_png_pal = png_pal.data();
 	uint8_t *p_png_tRNS = png_tRNS.data();
-	for (int i = cache.palette_len; i > 0; i--, p_img_pal++, p_png_pal++, p_png_tRNS++) {
+	for (int i = 0; i < cache.palette_len; i++, p_img_pal++, p_png_pal++, p_png_tRNS++) {
 		// NOTE: Shifting method is actually more
 		// efficient on gcc, but MSVC handles both
 		// the same as gcc with argb32_t. (movzx)
@@ -695,17 +1016,19 @@ int RpPngWriterPrivate::write_CI8_palette(void)
 		p_png_pal->green = p_img_pal->g;
 		p_png_pal->red   = p_img_pal->r;
 		*p_png_tRNS      = p_img_pal->a;
-		has_tRNS |= (*p_png_tRNS != 0xFF);
+		if (*p_png_tRNS != 0xFF) {
+			num_trans = i + 1;
+		}
 	}
 
 	// Write the PLTE and tRNS chunks.
 	png_set_PLTE(png_ptr, info_ptr, png_pal.data(), cache.palette_len);
-	if (has_tRNS) {
+	if (num_trans > 0) {
 		// Palette has transparency.
-		// Write the tRNS chunk.
+		// Write the tRNS chunk. Trailing opaque entries are omitted.
 		// NOTE: Ignoring skip_alpha here, since it doesn't make
 		// sense to skip for paletted images.
-		png_set_tRNS(png_ptr, info_ptr, png_tRNS.data(), cache.palette_len, nullptr);
+		png_set_tRNS(png_ptr, info_ptr, png_tRNS.data(), num_trans, nullptr);
 	}
 	return 0;
 }
@@ -739,6 +1062,11 @@ int RpPngWriterPrivate::write_IDAT(const png_byte *const *row_pointers, bool is_
 		return -lastError;
 	}
 
+	if (useMtCompression()) {
+		// Compress the image data using multiple threads.
+		return write_IDAT_mt(row_pointers, is_abgr);
+	}
+
 #ifdef PNG_SETJMP_SUPPORTED
 	// WARNING: Do NOT initialize any C++ objects past this point!
 	if (setjmp(png_jmpbuf(png_ptr))) {
@@ -808,8 +1136,15 @@ int RpPngWriterPrivate::write_IDAT(void)
 	}
 
 	// Initialize the row pointers array.
-	for (int y = cache.height-1; y >= 0; y--) {
-		row_pointers[y] = static_cast<const png_byte*>(img->scanLine(y));
+	if (ci8_bits) {
+		// Image was reduced to CI8.
+		for (int y = cache.height-1; y >= 0; y--) {
+			row_pointers[y] = &ci8_bits[static_cast<size_t>(y) * cache.width];
+		}
+	} else {
+		for (int y = cache.height-1; y >= 0; y--) {
+			row_pointers[y] = static_cast<const png_byte*>(img->scanLine(y));
+		}
 	}
 
 	// Write the image data.
@@ -819,6 +1154,220 @@ int RpPngWriterPrivate::write_IDAT(void)
 	return ret;
 }
 
+/**
+ * Should the image data be compressed using multiple threads?
+ * @return True if multi-threaded compression should be used.
+ */
+bool RpPngWriterPrivate::useMtCompression(void) const
+{
+	if (params.threads == 1 || text_after_IHDR) {
+		// Single-threaded compression was requested, or libpng
+		// needs to write tEXt chunks after IDAT.
+		return false;
+	}
+
+	unsigned int bytespp;
+	switch (cache.format) {
+		case rp_image::Format::CI8:
+			bytespp = 1;
+			break;
+		case rp_image::Format::ARGB32:
+			bytespp = (cache.skip_alpha ? 3 : 4);
+			break;
+		default:
+			// Unsupported format.
+			return false;
+	}
+
+	// Don't bother with multi-threading unless there are
+	// at least two chunks to compress.
+	const size_t raw_size = static_cast<size_t>(cache.height) *
+		(static_cast<size_t>(cache.width) * bytespp + 1);
+	if (raw_size < MT_CHUNK_SIZE * 2)
+		return false;
+
+	const unsigned int threads = (params.threads != 0 ? params.threads : ThreadPool::cpuCount());
+	return (threads > 1);
+}
+
+/**
+ * Write raw image data to the PNG image using multi-threaded compression.
+ *
+ * The image is filtered and split into 128 KB chunks, which are
+ * compressed in parallel as separate raw deflate streams using
+ * the preceding 32 KB as a preset dictionary. (same as pigz)
+ *
+ * The IDAT and IEND chunks are written directly.
+ *
+ * @param row_pointers PNG row pointers. Array must have cache.height elements.
+ * @param is_abgr If true, image data is ABGR instead of ARGB.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpPngWriterPrivate::write_IDAT_mt(const png_byte *const *row_pointers, bool is_abgr)
+{
+	const bool is_ci8 = (cache.format == rp_image::Format::CI8);
+	const unsigned int bytespp = (is_ci8 ? 1 : (cache.skip_alpha ? 3 : 4));
+	const size_t row_bytes = static_cast<size_t>(cache.width) * bytespp;
+	const size_t stride = row_bytes + 1;
+	const size_t height = static_cast<size_t>(cache.height);
+	const size_t raw_size = height * stride;
+
+	const unsigned int threads = (params.threads != 0 ? params.threads : ThreadPool::cpuCount());
+	ThreadPool pool(threads);
+
+	// Filter the image data.
+	// Rows are processed in groups of roughly MT_CHUNK_SIZE bytes.
+	unique_ptr<uint8_t[]> raw(new uint8_t[raw_size]);
+	const size_t rows_per_group = std::max<size_t>(1, MT_CHUNK_SIZE / stride);
+	const size_t row_groups = (height + rows_per_group - 1) / rows_per_group;
+	pool.parallelFor(row_groups, [&](size_t group) {
+		unique_ptr<uint8_t[]> buf(new uint8_t[row_bytes * 2 + stride]);
+		uint8_t *cur = buf.get();
+		uint8_t *prev = cur + row_bytes;
+		uint8_t *const tmp = prev + row_bytes;
+
+		const size_t y_start = group * rows_per_group;
+		const size_t y_end = std::min(height, y_start + rows_per_group);
+		if (y_start == 0) {
+			// First row: the previous row is all zeroes.
+			memset(prev, 0, row_bytes);
+		} else {
+			convertRow(prev, row_pointers[y_start - 1], cache.width, bytespp, is_abgr);
+		}
+
+		for (size_t y = y_start; y < y_end; y++) {
+			convertRow(cur, row_pointers[y], cache.width, bytespp, is_abgr);
+			filterRow(&raw[y * stride], cur, prev, row_bytes, bytespp, params.filters, tmp);
+			std::swap(cur, prev);
+		}
+	});
+
+	// Compress the filtered data.
+	const int level = (params.level >= 0 ? params.level : Z_DEFAULT_COMPRESSION);
+	const int strategy = (params.filters == RpPngWriter::FILTER_NONE ? Z_DEFAULT_STRATEGY : Z_FILTERED);
+	const size_t chunk_count = (raw_size + MT_CHUNK_SIZE - 1) / MT_CHUNK_SIZE;
+	vector<vector<uint8_t> > zchunks(chunk_count);
+	unique_ptr<uLong[]> adlers(new uLong[chunk_count]);
+	std::atomic<bool> z_error(false);
+	pool.parallelFor(chunk_count, [&](size_t i) {
+		const size_t offset = i * MT_CHUNK_SIZE;
+		const size_t in_len = std::min(MT_CHUNK_SIZE, raw_size - offset);
+		const bool last = (i == chunk_count - 1);
+		adlers[i] = adler32(adler32(0, nullptr, 0), &raw[offset], static_cast<uInt>(in_len));
+
+		z_stream strm;
+		memset(&strm, 0, sizeof(strm));
+		if (deflateInit2(&strm, level, Z_DEFLATED, -15, 8, strategy) != Z_OK) {
+			z_error = true;
+			return;
+		}
+		if (offset > 0) {
+			// Use the preceding data as the dictionary.
+			const size_t dict_len = std::min(ZLIB_WINDOW_SIZE, offset);
+			deflateSetDictionary(&strm, &raw[offset - dict_len], static_cast<uInt>(dict_len));
+		}
+
+		// Reserve extra space for the sync flush marker.
+		vector<uint8_t> &out = zchunks[i];
+		out.resize(deflateBound(&strm, static_cast<uLong>(in_len)) + 64);
+		strm.next_in = &raw[offset];
+		strm.avail_in = static_cast<uInt>(in_len);
+		strm.next_out = out.data();
+		strm.avail_out = static_cast<uInt>(out.size());
+
+		// All chunks except the last one are byte-aligned
+		// using Z_SYNC_FLUSH so they can be concatenated.
+		const int ret = deflate(&strm, last ? Z_FINISH : Z_SYNC_FLUSH);
+		if (ret != (last ? Z_STREAM_END : Z_OK) || strm.avail_in != 0) {
+			z_error = true;
+		}
+		out.resize(out.size() - strm.avail_out);
+		deflateEnd(&strm);
+	});
+	raw.reset();
+	if (z_error) {
+		lastError = EIO;
+		return -lastError;
+	}
+
+	// Assemble the zlib stream.
+	size_t zsize = 2 + 4;
+	for (const auto &chunk : zchunks) {
+		zsize += chunk.size();
+	}
+	vector<uint8_t> zdata;
+	zdata.reserve(zsize);
+
+	// zlib header: deflate, 32 KB window
+	// FLEVEL is the same as what zlib uses.
+	uint8_t flevel;
+	if (level == Z_DEFAULT_COMPRESSION || level == 6) {
+		flevel = 2;
+	} else if (level < 2) {
+		flevel = 0;
+	} else if (level < 6) {
+		flevel = 1;
+	} else {
+		flevel = 3;
+	}
+	const unsigned int cmf = 0x78;
+	unsigned int flg = (flevel << 6);
+	flg += 31 - ((cmf << 8) + flg) % 31;
+	zdata.push_back(static_cast<uint8_t>(cmf));
+	zdata.push_back(static_cast<uint8_t>(flg));
+
+	uLong adler = adler32(0, nullptr, 0);
+	for (size_t i = 0; i < chunk_count; i++) {
+		const vector<uint8_t> &chunk = zchunks[i];
+		zdata.insert(zdata.end(), chunk.begin(), chunk.end());
+		const size_t in_len = std::min(MT_CHUNK_SIZE, raw_size - (i * MT_CHUNK_SIZE));
+		adler = adler32_combine(adler, adlers[i], static_cast<z_off_t>(in_len));
+	}
+	zchunks.clear();
+
+	// zlib trailer: Adler-32 (big-endian)
+	zdata.push_back(static_cast<uint8_t>(adler >> 24));
+	zdata.push_back(static_cast<uint8_t>(adler >> 16));
+	zdata.push_back(static_cast<uint8_t>(adler >>  8));
+	zdata.push_back(static_cast<uint8_t>(adler));
+
+	return write_IDAT_chunks(zdata.data(), zdata.size());
+}
+
+/**
+ * Write pre-compressed zlib data as IDAT chunks, followed by IEND.
+ * @param zdata Compressed zlib stream.
+ * @param zsize Size of zdata.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpPngWriterPrivate::write_IDAT_chunks(const uint8_t *zdata, size_t zsize)
+{
+#ifdef PNG_SETJMP_SUPPORTED
+	// WARNING: Do NOT initialize any C++ objects past this point!
+	if (setjmp(png_jmpbuf(png_ptr))) {
+		// PNG write failed.
+		lastError = EIO;
+		return -lastError;
+	}
+#endif /* PNG_SETJMP_SUPPORTED */
+
+	static const png_byte png_IDAT[5] = {'I','D','A','T','\0'};
+	static const png_byte png_IEND[5] = {'I','E','N','D','\0'};
+	while (zsize > 0) {
+		const size_t len = (zsize < IDAT_MAX_SIZE ? zsize : IDAT_MAX_SIZE);
+		png_write_chunk(png_ptr, PNG_CONST_CAST(png_bytep)(png_IDAT),
+			PNG_CONST_CAST(png_bytep)(zdata), len);
+		zdata += len;
+		zsize -= len;
+	}
+
+	// libpng doesn't know we wrote IDAT, so png_write_end()
+	// can't be used here. Write IEND manually.
+	png_write_chunk(png_ptr, PNG_CONST_CAST(png_bytep)(png_IEND), nullptr, 0);
+	IEND_written = true;
+	return 0;
+}
+
 /**
  * Write the animated image data to the PNG image.
  *
@@ -1082,6 +1631,48 @@ void RpPngWriter::close(void)
 	d->close();
 }
 
+/**
+ * Set the compression parameters.
+ * This must be called before write_IHDR().
+ *
+ * If more than one thread is specified, large images are
+ * compressed in chunks in parallel, similar to pigz.
+ * APNG images are always compressed using a single thread.
+ *
+ * If reducePalette is set, ARGB32 rp_images that have no
+ * more than 256 colors are written as paletted images.
+ * This doesn't apply to raw images or APNG images.
+ *
+ * @param params Compression parameters.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpPngWriter::setCompressionParams(const CompressionParams &params)
+{
+	static_assert(FILTER_NONE == PNG_FILTER_NONE, "FILTER_NONE is incorrect.");
+	static_assert(FILTER_SUB == PNG_FILTER_SUB, "FILTER_SUB is incorrect.");
+	static_assert(FILTER_UP == PNG_FILTER_UP, "FILTER_UP is incorrect.");
+	static_assert(FILTER_AVG == PNG_FILTER_AVG, "FILTER_AVG is incorrect.");
+	static_assert(FILTER_PAETH == PNG_FILTER_PAETH, "FILTER_PAETH is incorrect.");
+
+	RP_D(RpPngWriter);
+	assert(!d->IHDR_written);
+	if (unlikely(d->IHDR_written)) {
+		// IHDR has already been written.
+		return -EEXIST;
+	}
+
+	assert(params.level >= -1 && params.level <= 9);
+	assert(params.filters != 0 && (params.filters & ~FILTER_ALL) == 0);
+	if (params.level < -1 || params.level > 9 ||
+	    params.filters == 0 || (params.filters & ~FILTER_ALL) != 0)
+	{
+		return -EINVAL;
+	}
+
+	d->params = params;
+	return 0;
+}
+
 /**
  * Write the PNG IHDR.
  * This must be called before writing any other image data.
@@ -1107,6 +1698,11 @@ int RpPngWriter::write_IHDR(void)
 	// TODO: Handle animated images where the different frames
 	// have different widths, heights, and/or formats.
 
+	if (d->params.reducePalette) {
+		// Write ARGB32 images with <= 256 colors as CI8.
+		d->reducePalette();
+	}
+
 #ifdef PNG_SETJMP_SUPPORTED
 	// WARNING: Do NOT initialize any C++ objects past this point!
 	if (setjmp(png_jmpbuf(d->png_ptr))) {
@@ -1117,9 +1713,9 @@ int RpPngWriter::write_IHDR(void)
 #endif /* PNG_SETJMP_SUPPORTED */
 
 	// Initialize compression parameters.
-	// TODO: Customizable?
-	png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
-	png_set_compression_level(d->png_ptr, PNG_Z_DEFAULT_COMPRESSION);
+	png_set_filter(d->png_ptr, 0, d->params.filters);
+	png_set_compression_level(d->png_ptr,
+		(d->params.level >= 0 ? d->params.level : PNG_Z_DEFAULT_COMPRESSION));
 
 	// Write the PNG header.
 	switch (d->cache.format) {
@@ -1383,6 +1979,10 @@ int RpPngWriter::write_tEXt(const kv_vector &kv)
 #endif /* PNG_SETJMP_SUPPORTED */
 
 	png_set_text(d->png_ptr, d->info_ptr, text.get(), static_cast<int>(kv.size()));
+	if (d->IHDR_written) {
+		// Text will be written after IDAT by png_write_end().
+		d->text_after_IHDR = true;
+	}
 	std::for_each(vU8toL1.begin(), vU8toL1.end(), ::free);
 	return 0;
 }
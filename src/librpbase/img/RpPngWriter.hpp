@@ -172,6 +172,55 @@ class RpPngWriter
 		 */
 		void close(void);
 
+		/**
+		 * PNG filter flags.
+		 * These have the same values as libpng's PNG_FILTER_* macros.
+		 */
+		enum FilterFlags : uint8_t {
+			FILTER_NONE	= 0x08,
+			FILTER_SUB	= 0x10,
+			FILTER_UP	= 0x20,
+			FILTER_AVG	= 0x40,
+			FILTER_PAETH	= 0x80,
+
+			// All filters. The best filter is chosen for each row.
+			FILTER_ALL	= FILTER_NONE | FILTER_SUB | FILTER_UP | FILTER_AVG | FILTER_PAETH,
+		};
+
+		/**
+		 * Compression parameters.
+		 */
+		struct CompressionParams {
+			int level;		// zlib compression level. (-1 for default; 0-9)
+			uint8_t filters;	// FilterFlags
+			unsigned int threads;	// Compression threads. (0 for the number of CPUs)
+			bool reducePalette;	// Write ARGB32 rp_images with <= 256 colors as CI8.
+
+			CompressionParams()
+				: level(-1)
+				, filters(FILTER_NONE)
+				, threads(1)
+				, reducePalette(true)
+			{ }
+		};
+
+		/**
+		 * Set the compression parameters.
+		 * This must be called before write_IHDR().
+		 *
+		 * If more than one thread is specified, large images are
+		 * compressed in chunks in parallel, similar to pigz.
+		 * APNG images are always compressed using a single thread.
+		 *
+		 * If reducePalette is set, ARGB32 rp_images that have no
+		 * more than 256 colors are written as paletted images.
+		 * This doesn't apply to raw images or APNG images.
+		 *
+		 * @param params Compression parameters.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setCompressionParams(const CompressionParams &params);
+
 		/**
 		 * Write the PNG IHDR.
 		 * This must be called before writing any other image data.
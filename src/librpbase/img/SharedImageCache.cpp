@@ -0,0 +1,666 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * SharedImageCache.cpp: Cross-process cache for decoded images.           *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librpbase.h"
+#include "SharedImageCache.hpp"
+
+// librptexture, librpthreads
+#include "librptexture/img/rp_image.hpp"
+#include "librpthreads/Atomics.h"
+#include "librpthreads/pthread_once.h"
+using LibRpTexture::rp_image;
+
+#ifdef ENABLE_SHARED_IMAGE_CACHE
+# ifdef _WIN32
+#  include "libwin32common/RpWin32_sdk.h"
+# else /* !_WIN32 */
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+# endif /* _WIN32 */
+#endif /* ENABLE_SHARED_IMAGE_CACHE */
+
+namespace LibRpBase {
+
+#ifdef ENABLE_SHARED_IMAGE_CACHE
+
+// Shared memory segment layout.
+// All fields are host-endian, since the segment
+// is only shared between processes on this system.
+// NOTE: Increment SIC_VERSION and the segment name
+// if the layout is changed.
+#define SIC_MAGIC	0x43495052	// "RPIC"
+#define SIC_VERSION	1
+#define SIC_SLOT_COUNT	256
+#define SIC_DATA_SIZE	(8U*1024U*1024U)
+
+// Writer lock timeout, in seconds.
+// If a process crashes while holding the lock,
+// another process takes it over after this time.
+#define SIC_LOCK_TIMEOUT 2
+
+// Maximum image dimensions.
+#define SIC_MAX_DIMENSION 32768
+
+// Segment initialization state.
+enum SIC_InitState {
+	SIC_INIT_NONE		= 0,
+	SIC_INIT_BUSY		= 1,
+	SIC_INIT_READY		= 2,
+};
+
+struct SIC_Header {
+	volatile int initState;	// SIC_InitState
+	volatile int lock;	// Writer lock: 0 if unlocked; otherwise, time() when locked.
+	uint32_t magic;		// SIC_MAGIC
+	uint32_t version;	// SIC_VERSION
+	uint32_t slotCount;	// Number of index slots
+	uint32_t dataSize;	// Size of the ring buffer, in bytes
+
+	// The following fields are protected by the writer lock.
+	uint32_t writePos;	// Ring buffer write position
+	uint32_t serial;	// Insertion counter
+};
+
+struct SIC_Slot {
+	// Sequence number.
+	// Odd while the slot is being modified.
+	volatile int seq;
+
+	uint32_t serial;	// Insertion counter value; 0 if the slot is empty.
+	uint32_t keyHash;	// Key hash, for quick comparisons.
+	uint32_t dataPos;	// Image position in the ring buffer
+	uint32_t dataLen;	// Image length in the ring buffer
+
+	// Cache key.
+	int32_t imageType;
+	uint64_t dev;
+	uint64_t ino;
+	int64_t size;
+	int64_t mtime_ns;
+	int32_t reqSize;
+	char owner[36];		// NULL-terminated
+};
+
+// Image header. Followed by the palette and pixel data.
+// Pixel data is stored without row padding.
+struct SIC_Image {
+	int32_t width;
+	int32_t height;
+	int32_t format;		// rp_image::Format
+	int32_t palette_len;	// Number of palette entries (CI8 only)
+	int32_t tr_idx;		// Transparent color index (CI8 only)
+	uint8_t has_sBIT;
+	rp_image::sBIT_t sBIT;
+	uint8_t reserved[2];
+};
+
+static const size_t SIC_SEGMENT_SIZE =
+	sizeof(SIC_Header) + (SIC_SLOT_COUNT * sizeof(SIC_Slot)) + SIC_DATA_SIZE;
+
+class SharedImageCachePrivate
+{
+	public:
+		SharedImageCachePrivate();
+		~SharedImageCachePrivate();
+
+	private:
+		RP_DISABLE_COPY(SharedImageCachePrivate)
+
+	public:
+		// Static SharedImageCachePrivate instance.
+		static SharedImageCachePrivate instance;
+
+		// pthread_once() control variable.
+		static pthread_once_t once_control;
+
+		/**
+		 * Open the shared memory segment.
+		 * Called by pthread_once().
+		 */
+		static void openSegment(void);
+
+		/**
+		 * Get the segment header if the segment is ready.
+		 * @return Segment header, or nullptr if the segment isn't available.
+		 */
+		SIC_Header *header(void);
+
+		/**
+		 * Get the index slots.
+		 * @return Index slots.
+		 */
+		inline SIC_Slot *slots(void) const
+		{
+			return reinterpret_cast<SIC_Slot*>(segment + sizeof(SIC_Header));
+		}
+
+		/**
+		 * Get the ring buffer.
+		 * @return Ring buffer.
+		 */
+		inline uint8_t *data(void) const
+		{
+			return segment + sizeof(SIC_Header) + (SIC_SLOT_COUNT * sizeof(SIC_Slot));
+		}
+
+		/**
+		 * Try to take the writer lock.
+		 * @param hdr Segment header.
+		 * @return True if the lock was taken; false if not.
+		 */
+		static bool tryLock(SIC_Header *hdr);
+
+		/**
+		 * Release the writer lock.
+		 * @param hdr Segment header.
+		 */
+		static inline void unlock(SIC_Header *hdr)
+		{
+			ATOMIC_EXCHANGE(&hdr->lock, 0);
+		}
+
+		/**
+		 * Hash a cache key.
+		 * @param key Cache key.
+		 * @return Hash.
+		 */
+		static uint32_t hashKey(const ImageCache::Key &key);
+
+		/**
+		 * Check if an index slot matches a cache key.
+		 * The slot's sequence number must be checked afterwards.
+		 * @param slot Index slot.
+		 * @param key Cache key.
+		 * @param keyHash Key hash.
+		 * @return True if the slot matches.
+		 */
+		static bool slotMatches(const SIC_Slot *slot, const ImageCache::Key &key, uint32_t keyHash);
+
+	public:
+		uint8_t *segment;	// Shared memory segment
+#ifdef _WIN32
+		HANDLE hMapping;	// File mapping handle
+#endif /* _WIN32 */
+};
+
+/** SharedImageCachePrivate **/
+
+// Singleton instance.
+// Using a static non-pointer variable in order to
+// handle proper destruction when the DLL is unloaded.
+SharedImageCachePrivate SharedImageCachePrivate::instance;
+pthread_once_t SharedImageCachePrivate::once_control = PTHREAD_ONCE_INIT;
+
+SharedImageCachePrivate::SharedImageCachePrivate()
+	: segment(nullptr)
+#ifdef _WIN32
+	, hMapping(nullptr)
+#endif /* _WIN32 */
+{ }
+
+SharedImageCachePrivate::~SharedImageCachePrivate()
+{
+	// NOTE: The segment itself isn't removed, since other
+	// processes may still be using it. It's removed when
+	// the user logs out. (or on reboot)
+#ifdef _WIN32
+	if (segment) {
+		UnmapViewOfFile(segment);
+	}
+	if (hMapping) {
+		CloseHandle(hMapping);
+	}
+#else /* !_WIN32 */
+	if (segment) {
+		munmap(segment, SIC_SEGMENT_SIZE);
+	}
+#endif /* _WIN32 */
+}
+
+/**
+ * Open the shared memory segment.
+ * Called by pthread_once().
+ */
+void SharedImageCachePrivate::openSegment(void)
+{
+	SharedImageCachePrivate *const d = &instance;
+	uint8_t *segment;
+
+#ifdef _WIN32
+	// NOTE: The "Local\" namespace is per-session,
+	// so other users can't access the segment.
+	HANDLE hMapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		0, static_cast<DWORD>(SIC_SEGMENT_SIZE), L"Local\\rom-properties-imgcache-v1");
+	if (!hMapping) {
+		// Unable to create the segment.
+		return;
+	}
+	segment = static_cast<uint8_t*>(MapViewOfFile(hMapping,
+		FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, SIC_SEGMENT_SIZE));
+	if (!segment) {
+		CloseHandle(hMapping);
+		return;
+	}
+	d->hMapping = hMapping;
+#else /* !_WIN32 */
+	// NOTE: The user ID is part of the name, and the segment
+	// is only used if it's owned by the user and isn't
+	// accessible by anyone else.
+	char name[64];
+	snprintf(name, sizeof(name), "/rom-properties-imgcache-v1-%u",
+		static_cast<unsigned int>(getuid()));
+	int fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+	if (fd < 0) {
+		// Unable to open the segment.
+		return;
+	}
+
+	struct stat sb;
+	if (fstat(fd, &sb) != 0 || sb.st_uid != getuid() || (sb.st_mode & 077) != 0) {
+		// Wrong owner or permissions.
+		close(fd);
+		return;
+	}
+	if (sb.st_size != static_cast<off_t>(SIC_SEGMENT_SIZE)) {
+		// New segment. Set its size.
+		// NOTE: If another process created the segment,
+		// it's already the correct size.
+		if (sb.st_size != 0 || ftruncate(fd, SIC_SEGMENT_SIZE) != 0) {
+			close(fd);
+			return;
+		}
+	}
+
+	void *const p = mmap(nullptr, SIC_SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) {
+		return;
+	}
+	segment = static_cast<uint8_t*>(p);
+#endif /* _WIN32 */
+
+	// Initialize the header if this is a new segment.
+	// New segments are zero-filled.
+	SIC_Header *const hdr = reinterpret_cast<SIC_Header*>(segment);
+	if (ATOMIC_CMPXCHG(&hdr->initState, SIC_INIT_NONE, SIC_INIT_BUSY) == SIC_INIT_NONE) {
+		hdr->magic = SIC_MAGIC;
+		hdr->version = SIC_VERSION;
+		hdr->slotCount = SIC_SLOT_COUNT;
+		hdr->dataSize = SIC_DATA_SIZE;
+		hdr->writePos = 0;
+		hdr->serial = 0;
+		ATOMIC_EXCHANGE(&hdr->initState, SIC_INIT_READY);
+	}
+
+	d->segment = segment;
+}
+
+/**
+ * Get the segment header if the segment is ready.
+ * @return Segment header, or nullptr if the segment isn't available.
+ */
+SIC_Header *SharedImageCachePrivate::header(void)
+{
+	pthread_once(&once_control, openSegment);
+	if (!segment)
+		return nullptr;
+
+	// NOTE: Another process may still be initializing the segment.
+	SIC_Header *const hdr = reinterpret_cast<SIC_Header*>(segment);
+	if (ATOMIC_OR_FETCH(&hdr->initState, 0) != SIC_INIT_READY ||
+	    hdr->magic != SIC_MAGIC || hdr->version != SIC_VERSION ||
+	    hdr->slotCount != SIC_SLOT_COUNT || hdr->dataSize != SIC_DATA_SIZE)
+	{
+		return nullptr;
+	}
+	return hdr;
+}
+
+/**
+ * Try to take the writer lock.
+ * @param hdr Segment header.
+ * @return True if the lock was taken; false if not.
+ */
+bool SharedImageCachePrivate::tryLock(SIC_Header *hdr)
+{
+	int now = static_cast<int>(time(nullptr));
+	if (now == 0) {
+		// 0 indicates "unlocked".
+		now = 1;
+	}
+
+	const int cur = ATOMIC_CMPXCHG(&hdr->lock, 0, now);
+	if (cur == 0) {
+		// Lock taken.
+		return true;
+	}
+
+	if (now - cur > SIC_LOCK_TIMEOUT) {
+		// The process holding the lock probably crashed.
+		return (ATOMIC_CMPXCHG(&hdr->lock, cur, now) == cur);
+	}
+	return false;
+}
+
+/**
+ * Hash a cache key.
+ * @param key Cache key.
+ * @return Hash.
+ */
+uint32_t SharedImageCachePrivate::hashKey(const ImageCache::Key &key)
+{
+	// FNV-1a over the key fields.
+	uint32_t hash = 0x811C9DC5U;
+	const uint64_t vals[5] = {
+		key.fileId.dev, key.fileId.ino,
+		static_cast<uint64_t>(key.fileId.mtime_ns),
+		static_cast<uint64_t>(key.imageType),
+		static_cast<uint64_t>(key.reqSize)
+	};
+	for (uint64_t val : vals) {
+		for (unsigned int i = 0; i < 8; i++, val >>= 8) {
+			hash ^= static_cast<uint8_t>(val);
+			hash *= 0x01000193U;
+		}
+	}
+	for (const char chr : key.owner) {
+		hash ^= static_cast<uint8_t>(chr);
+		hash *= 0x01000193U;
+	}
+	return hash;
+}
+
+/**
+ * Check if an index slot matches a cache key.
+ * The slot's sequence number must be checked afterwards.
+ * @param slot Index slot.
+ * @param key Cache key.
+ * @param keyHash Key hash.
+ * @return True if the slot matches.
+ */
+bool SharedImageCachePrivate::slotMatches(const SIC_Slot *slot, const ImageCache::Key &key, uint32_t keyHash)
+{
+	return (slot->serial != 0 && slot->keyHash == keyHash &&
+		slot->dev == key.fileId.dev && slot->ino == key.fileId.ino &&
+		slot->size == key.fileId.size && slot->mtime_ns == key.fileId.mtime_ns &&
+		slot->imageType == key.imageType && slot->reqSize == key.reqSize &&
+		strncmp(slot->owner, key.owner.c_str(), sizeof(slot->owner)) == 0);
+}
+
+#endif /* ENABLE_SHARED_IMAGE_CACHE */
+
+/** SharedImageCache **/
+
+// Is the shared cache enabled for this process?
+static bool sic_enabled = false;
+
+/**
+ * Enable or disable the shared cache for this process.
+ * This should be called before any images are loaded.
+ * @param enabled True to enable; false to disable.
+ */
+void SharedImageCache::setEnabled(bool enabled)
+{
+	sic_enabled = enabled;
+}
+
+/**
+ * Is the shared cache enabled for this process?
+ * @return True if enabled; false if not, or if it isn't available.
+ */
+bool SharedImageCache::isEnabled(void)
+{
+#ifdef ENABLE_SHARED_IMAGE_CACHE
+	return sic_enabled;
+#else /* !ENABLE_SHARED_IMAGE_CACHE */
+	return false;
+#endif /* ENABLE_SHARED_IMAGE_CACHE */
+}
+
+/**
+ * Look up an image in the shared cache.
+ * @param key Cache key.
+ * @return Copy of the image, or nullptr if not found.
+ */
+rp_image *SharedImageCache::lookup(const ImageCache::Key &key)
+{
+#ifdef ENABLE_SHARED_IMAGE_CACHE
+	if (!sic_enabled || key.owner.size() >= sizeof(SIC_Slot::owner)) {
+		// Disabled, or the owner name is too long.
+		return nullptr;
+	}
+
+	SharedImageCachePrivate *const d = &SharedImageCachePrivate::instance;
+	SIC_Header *const hdr = d->header();
+	if (!hdr)
+		return nullptr;
+
+	const uint32_t keyHash = SharedImageCachePrivate::hashKey(key);
+	SIC_Slot *const slots = d->slots();
+	const uint8_t *const data = d->data();
+	for (unsigned int i = 0; i < SIC_SLOT_COUNT; i++) {
+		SIC_Slot *const slot = &slots[i];
+		const int seq = ATOMIC_OR_FETCH(&slot->seq, 0);
+		if ((seq & 1) || !SharedImageCachePrivate::slotMatches(slot, key, keyHash))
+			continue;
+
+		// Validate the image location.
+		// NOTE: Any of these fields may be changed by another
+		// process while we're reading them, so everything
+		// has to be bounds-checked.
+		const uint32_t dataPos = slot->dataPos;
+		const uint32_t dataLen = slot->dataLen;
+		if (dataLen < sizeof(SIC_Image) || dataPos > SIC_DATA_SIZE ||
+		    dataLen > SIC_DATA_SIZE - dataPos)
+		{
+			return nullptr;
+		}
+
+		SIC_Image imgHdr;
+		memcpy(&imgHdr, &data[dataPos], sizeof(imgHdr));
+		if (imgHdr.width <= 0 || imgHdr.width > SIC_MAX_DIMENSION ||
+		    imgHdr.height <= 0 || imgHdr.height > SIC_MAX_DIMENSION)
+		{
+			return nullptr;
+		}
+
+		const rp_image::Format format = static_cast<rp_image::Format>(imgHdr.format);
+		size_t row_bytes;
+		switch (format) {
+			case rp_image::Format::CI8:
+				row_bytes = imgHdr.width;
+				if (imgHdr.palette_len < 0 || imgHdr.palette_len > 256)
+					return nullptr;
+				break;
+			case rp_image::Format::ARGB32:
+				row_bytes = imgHdr.width * sizeof(uint32_t);
+				if (imgHdr.palette_len != 0)
+					return nullptr;
+				break;
+			default:
+				return nullptr;
+		}
+		const size_t pal_bytes = imgHdr.palette_len * sizeof(uint32_t);
+		if (sizeof(imgHdr) + pal_bytes + (row_bytes * imgHdr.height) > dataLen)
+			return nullptr;
+
+		// Copy the image.
+		rp_image *const img = new rp_image(imgHdr.width, imgHdr.height, format);
+		if (!img->isValid()) {
+			img->unref();
+			return nullptr;
+		}
+		const uint8_t *src = &data[dataPos + sizeof(imgHdr)];
+		if (format == rp_image::Format::CI8) {
+			uint32_t *const palette = img->palette();
+			const int palette_len = std::min(img->palette_len(), imgHdr.palette_len);
+			if (palette && palette_len > 0) {
+				memcpy(palette, src, palette_len * sizeof(uint32_t));
+			}
+			src += pal_bytes;
+			img->set_tr_idx(imgHdr.tr_idx);
+		}
+		for (int y = 0; y < imgHdr.height; y++, src += row_bytes) {
+			memcpy(img->scanLine(y), src, row_bytes);
+		}
+		if (imgHdr.has_sBIT) {
+			img->set_sBIT(&imgHdr.sBIT);
+		}
+
+		// Make sure the slot wasn't changed while copying.
+		if (ATOMIC_OR_FETCH(&slot->seq, 0) != seq) {
+			img->unref();
+			return nullptr;
+		}
+		return img;
+	}
+#else /* !ENABLE_SHARED_IMAGE_CACHE */
+	RP_UNUSED(key);
+#endif /* ENABLE_SHARED_IMAGE_CACHE */
+
+	// Not found.
+	return nullptr;
+}
+
+/**
+ * Add an image to the shared cache.
+ * The pixel data is copied into shared memory.
+ * @param key Cache key.
+ * @param img Image.
+ */
+void SharedImageCache::insert(const ImageCache::Key &key, const rp_image *img)
+{
+#ifdef ENABLE_SHARED_IMAGE_CACHE
+	assert(img != nullptr);
+	if (!sic_enabled || !img || !img->isValid() || key.owner.size() >= sizeof(SIC_Slot::owner))
+		return;
+
+	size_t row_bytes;
+	int palette_len = 0;
+	switch (img->format()) {
+		case rp_image::Format::CI8:
+			row_bytes = img->width();
+			palette_len = std::min(img->palette_len(), 256);
+			break;
+		case rp_image::Format::ARGB32:
+			row_bytes = img->width() * sizeof(uint32_t);
+			break;
+		default:
+			return;
+	}
+
+	// Images larger than 1/4 of the ring buffer aren't cached,
+	// since they'd evict too many other images.
+	const size_t imgLen = sizeof(SIC_Image) + (palette_len * sizeof(uint32_t)) +
+		(row_bytes * img->height());
+	const uint32_t dataLen = static_cast<uint32_t>((imgLen + 7) & ~7);
+	if (imgLen > SIC_DATA_SIZE / 4)
+		return;
+
+	SharedImageCachePrivate *const d = &SharedImageCachePrivate::instance;
+	SIC_Header *const hdr = d->header();
+	if (!hdr || !SharedImageCachePrivate::tryLock(hdr)) {
+		// Not available, or another process is inserting an image.
+		return;
+	}
+
+	const uint32_t keyHash = SharedImageCachePrivate::hashKey(key);
+	SIC_Slot *const slots = d->slots();
+	uint8_t *const data = d->data();
+
+	// Find a slot: the existing slot for this key,
+	// an empty slot, or the oldest slot.
+	// NOTE: Slots are only modified while holding the lock.
+	SIC_Slot *slot = nullptr;
+	for (unsigned int i = 0; i < SIC_SLOT_COUNT; i++) {
+		SIC_Slot *const cur = &slots[i];
+		if (SharedImageCachePrivate::slotMatches(cur, key, keyHash)) {
+			// Image is already cached.
+			SharedImageCachePrivate::unlock(hdr);
+			return;
+		}
+		if (!slot || (slot->serial != 0 && cur->serial < slot->serial)) {
+			slot = cur;
+		}
+	}
+
+	// Allocate space in the ring buffer.
+	uint32_t dataPos = hdr->writePos;
+	if (dataPos > SIC_DATA_SIZE || dataLen > SIC_DATA_SIZE - dataPos) {
+		// Wrap around to the beginning.
+		dataPos = 0;
+	}
+
+	// Invalidate slots whose images will be overwritten,
+	// as well as the slot that will be reused.
+	for (unsigned int i = 0; i < SIC_SLOT_COUNT; i++) {
+		SIC_Slot *const cur = &slots[i];
+		if (cur->serial == 0)
+			continue;
+		if (cur == slot || (cur->dataPos < dataPos + dataLen &&
+		                    dataPos < cur->dataPos + cur->dataLen))
+		{
+			ATOMIC_INC_FETCH(&cur->seq);
+			cur->serial = 0;
+			ATOMIC_INC_FETCH(&cur->seq);
+		}
+	}
+
+	// Write the image.
+	SIC_Image imgHdr;
+	memset(&imgHdr, 0, sizeof(imgHdr));
+	imgHdr.width = img->width();
+	imgHdr.height = img->height();
+	imgHdr.format = static_cast<int32_t>(img->format());
+	imgHdr.palette_len = palette_len;
+	imgHdr.tr_idx = (img->format() == rp_image::Format::CI8 ? img->tr_idx() : -1);
+	imgHdr.has_sBIT = (img->get_sBIT(&imgHdr.sBIT) == 0);
+	uint8_t *dest = &data[dataPos];
+	memcpy(dest, &imgHdr, sizeof(imgHdr));
+	dest += sizeof(imgHdr);
+	if (palette_len > 0) {
+		memcpy(dest, img->palette(), palette_len * sizeof(uint32_t));
+		dest += palette_len * sizeof(uint32_t);
+	}
+	for (int y = 0; y < imgHdr.height; y++, dest += row_bytes) {
+		memcpy(dest, img->scanLine(y), row_bytes);
+	}
+
+	// Publish the slot.
+	uint32_t serial = hdr->serial + 1;
+	if (serial == 0) {
+		// 0 indicates "empty".
+		serial = 1;
+	}
+	ATOMIC_INC_FETCH(&slot->seq);
+	slot->keyHash = keyHash;
+	slot->dataPos = dataPos;
+	slot->dataLen = dataLen;
+	slot->imageType = key.imageType;
+	slot->dev = key.fileId.dev;
+	slot->ino = key.fileId.ino;
+	slot->size = key.fileId.size;
+	slot->mtime_ns = key.fileId.mtime_ns;
+	slot->reqSize = key.reqSize;
+	strncpy(slot->owner, key.owner.c_str(), sizeof(slot->owner));
+	slot->serial = serial;
+	ATOMIC_INC_FETCH(&slot->seq);
+
+	hdr->serial = serial;
+	hdr->writePos = dataPos + dataLen;
+	SharedImageCachePrivate::unlock(hdr);
+#else /* !ENABLE_SHARED_IMAGE_CACHE */
+	RP_UNUSED(key);
+	RP_UNUSED(img);
+#endif /* ENABLE_SHARED_IMAGE_CACHE */
+}
+
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * SharedImageCache.hpp: Cross-process cache for decoded images.           *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_IMG_SHAREDIMAGECACHE_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_IMG_SHAREDIMAGECACHE_HPP__
+
+#include "ImageCache.hpp"
+
+namespace LibRpTexture {
+	class rp_image;
+}
+
+namespace LibRpBase {
+
+/**
+ * Cross-process cache for decoded images.
+ *
+ * Decoded pixel data is stored in a shared memory segment
+ * that's shared by all processes of the current user,
+ * e.g. the thumbnailer, the properties page, and the
+ * metadata extractor. ImageCache checks this cache if an
+ * image isn't found in the process-wide cache.
+ *
+ * The segment has a fixed-size index and a ring buffer for
+ * the pixel data. Lookups don't take any locks; each index
+ * slot has a sequence number that's checked before and after
+ * the data is copied. Inserts use a try-lock and are skipped
+ * if another process is inserting an image at the same time.
+ * The oldest images are overwritten when the ring buffer
+ * runs out of space.
+ *
+ * The shared cache is disabled by default. UI frontends
+ * enable it using setEnabled(). rpcli and the test suites
+ * don't use it, since their seccomp filters don't allow
+ * creating the shared memory segment.
+ */
+class SharedImageCache
+{
+	private:
+		// SharedImageCache is a static class.
+		SharedImageCache();
+		~SharedImageCache();
+		RP_DISABLE_COPY(SharedImageCache)
+
+	public:
+		/**
+		 * Enable or disable the shared cache for this process.
+		 * This should be called before any images are loaded.
+		 * @param enabled True to enable; false to disable.
+		 */
+		static void setEnabled(bool enabled);
+
+		/**
+		 * Is the shared cache enabled for this process?
+		 * @return True if enabled; false if not, or if it isn't available.
+		 */
+		static bool isEnabled(void);
+
+		/**
+		 * Look up an image in the shared cache.
+		 * @param key Cache key.
+		 * @return Copy of the image, or nullptr if not found.
+		 */
+		static LibRpTexture::rp_image *lookup(const ImageCache::Key &key);
+
+		/**
+		 * Add an image to the shared cache.
+		 * The pixel data is copied into shared memory.
+		 * @param key Cache key.
+		 * @param img Image.
+		 */
+		static void insert(const ImageCache::Key &key, const LibRpTexture::rp_image *img);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_IMG_SHAREDIMAGECACHE_HPP__ */
@@ -18,9 +18,12 @@
 #else /* !_WIN32 */
 # include "../crypto/AesNettle.hpp"
 #endif /* _WIN32 */
+#include "../crypto/AesNI.hpp"
 
 // C includes. (C++ namespace)
 #include <cstdio>
+#include <cstdlib>
+#include <ctime>
 
 // C++ includes.
 #include <iostream>
@@ -110,6 +113,14 @@ class AesCipherTest : public ::testing::TestWithParam<AesCipherTest_mode>
 		// Test string.
 		static const char test_string[64];
 
+		// Buffer size for the large buffer tests.
+		// This is not a multiple of the pipeline width
+		// used by the optimized implementations.
+		static const size_t LARGE_BUFFER_SIZE = (1024*1024) + (3*16);
+
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 64;
+
 		/**
 		 * Compare two byte arrays.
 		 * The byte arrays are converted to hexdumps and then
@@ -515,6 +526,78 @@ TEST_P(AesCipherTest, decryptTest_fourParam_blockAtATime)
 		buf.data(), buf.size(), "plaintext data");
 }
 
+/**
+ * Decrypt a large buffer in one call, then compare it to the
+ * same buffer decrypted one 16-byte block at a time.
+ * This verifies that multi-block code paths match the
+ * single-block code paths.
+ */
+TEST_P(AesCipherTest, decryptTest_largeBuffer)
+{
+	const AesCipherTest_mode &mode = GetParam();
+	if (!mode.isRequired && !m_cipher->isInit()) {
+		return;
+	}
+
+	// Fill the buffer with pseudo-random "ciphertext".
+	vector<uint8_t> buf_all(LARGE_BUFFER_SIZE);
+	srand(1);
+	for (auto iter = buf_all.begin(); iter != buf_all.end(); ++iter) {
+		*iter = static_cast<uint8_t>(rand());
+	}
+	vector<uint8_t> buf_blk(buf_all);
+
+	EXPECT_EQ(0, m_cipher->setChainingMode(mode.chainingMode));
+	EXPECT_EQ(0, m_cipher->setKey(aes_key, mode.key_len));
+	const bool hasIV = (mode.chainingMode != IAesCipher::ChainingMode::ECB);
+
+	// Decrypt the entire buffer at once.
+	if (hasIV) {
+		EXPECT_EQ(buf_all.size(), m_cipher->decrypt(buf_all.data(), buf_all.size(), aes_iv, sizeof(aes_iv)));
+	} else {
+		EXPECT_EQ(buf_all.size(), m_cipher->decrypt(buf_all.data(), buf_all.size()));
+	}
+
+	// Decrypt one block at a time.
+	if (hasIV) {
+		EXPECT_EQ(0, m_cipher->setIV(aes_iv, sizeof(aes_iv)));
+	}
+	for (size_t i = 0; i < buf_blk.size(); i += 16) {
+		ASSERT_EQ(16U, m_cipher->decrypt(&buf_blk[i], 16));
+	}
+
+	EXPECT_TRUE(buf_all == buf_blk);
+}
+
+/**
+ * Decryption throughput benchmark.
+ */
+TEST_P(AesCipherTest, decryptThroughput_benchmark)
+{
+	const AesCipherTest_mode &mode = GetParam();
+	if (!mode.isRequired && !m_cipher->isInit()) {
+		return;
+	}
+
+	EXPECT_EQ(0, m_cipher->setChainingMode(mode.chainingMode));
+	EXPECT_EQ(0, m_cipher->setKey(aes_key, mode.key_len));
+	const bool hasIV = (mode.chainingMode != IAesCipher::ChainingMode::ECB);
+
+	vector<uint8_t> buf(LARGE_BUFFER_SIZE);
+	const clock_t start = clock();
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		if (hasIV) {
+			m_cipher->decrypt(buf.data(), buf.size(), aes_iv, sizeof(aes_iv));
+		} else {
+			m_cipher->decrypt(buf.data(), buf.size());
+		}
+	}
+	const double secs = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+
+	const double mb = (static_cast<double>(buf.size()) * BENCHMARK_ITERATIONS) / (1024.0*1024.0);
+	printf("%s: %.1f MB/s\n", m_cipher->name(), (secs > 0 ? mb / secs : 0.0));
+}
+
 /** Decryption tests. **/
 
 /**
@@ -703,6 +786,9 @@ AesDecryptTestSet(CAPI_NG, false)
 #else /* !_WIN32 */
 AesDecryptTestSet(Nettle, true)
 #endif /* _WIN32 */
+#ifdef AESCIPHER_HAS_AESNI
+AesDecryptTestSet(NI, false)
+#endif /* AESCIPHER_HAS_AESNI */
 
 } }
 
@@ -712,6 +798,7 @@ AesDecryptTestSet(Nettle, true)
 extern "C" int gtest_main(int argc, TCHAR *argv[])
 {
 	fprintf(stderr, "LibRpBase test suite: Crypto tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u\n", LibRpBase::Tests::AesCipherTest::BENCHMARK_ITERATIONS);
 	fflush(nullptr);
 
 	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
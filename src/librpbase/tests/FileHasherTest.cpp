@@ -0,0 +1,163 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * FileHasherTest.cpp: FileHasher class test.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+#include "librpbase/config.librpbase.h"
+
+// FileHasher
+#include "../crypto/FileHasher.hpp"
+#include "../disc/DiscReader.hpp"
+#ifdef ENABLE_DECRYPTION
+# include "../crypto/MD5Hash.hpp"
+# include "../crypto/SHA1Hash.hpp"
+#endif /* ENABLE_DECRYPTION */
+
+// librpfile
+#include "librpfile/RpMemFile.hpp"
+using LibRpFile::RpMemFile;
+
+// zlib for crc32()
+#include <zlib.h>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class FileHasherTest : public ::testing::Test
+{
+	protected:
+		void SetUp(void) final
+		{
+			// Deterministic pseudo-random test data.
+			m_data.resize(TEST_DATA_SIZE);
+			uint32_t seed = 0x12345678;
+			for (uint8_t &byte : m_data) {
+				seed = seed * 1103515245U + 12345U;
+				byte = static_cast<uint8_t>(seed >> 16);
+			}
+		}
+
+	public:
+		// Larger than the FileHasher buffer size,
+		// and not a multiple of 16.
+		static const size_t TEST_DATA_SIZE = (3U*1024U*1024U) + 123U;
+
+		vector<uint8_t> m_data;
+};
+
+/**
+ * Test FileHasher::calcCrc32() against zlib using various lengths
+ * and alignments, including lengths below the PCLMULQDQ minimum.
+ */
+TEST_F(FileHasherTest, crc32LengthsTest)
+{
+	for (size_t offset = 0; offset < 16; offset++) {
+		for (size_t len = 0; len <= 300; len++) {
+			const uint8_t *const p = &m_data[offset];
+			const uint32_t expected = static_cast<uint32_t>(
+				crc32(0, p, static_cast<uInt>(len)));
+			ASSERT_EQ(expected, FileHasher::calcCrc32(0, p, len)) <<
+				"offset == " << offset << ", len == " << len;
+		}
+	}
+}
+
+/**
+ * Test FileHasher::calcCrc32() with an initial CRC
+ * and a large buffer.
+ */
+TEST_F(FileHasherTest, crc32ChainedTest)
+{
+	const uint32_t expected = static_cast<uint32_t>(
+		crc32(0, m_data.data(), static_cast<uInt>(m_data.size())));
+
+	// Single call.
+	EXPECT_EQ(expected, FileHasher::calcCrc32(0, m_data.data(), m_data.size()));
+
+	// Multiple calls with uneven chunk sizes.
+	uint32_t crc = 0;
+	size_t pos = 0;
+	size_t chunk = 1;
+	while (pos < m_data.size()) {
+		const size_t len = std::min(chunk, m_data.size() - pos);
+		crc = FileHasher::calcCrc32(crc, &m_data[pos], len);
+		pos += len;
+		chunk = (chunk * 7) + 3;
+	}
+	EXPECT_EQ(expected, crc);
+}
+
+/**
+ * Test FileHasher::hashDisc().
+ */
+TEST_F(FileHasherTest, hashDiscTest)
+{
+	RpMemFile *const memFile = new RpMemFile(m_data.data(), m_data.size());
+	DiscReader *const discReader = new DiscReader(memFile);
+	memFile->unref();
+	ASSERT_TRUE(discReader->isOpen());
+
+	FileHasher::Hashes hashes;
+	EXPECT_EQ(0, FileHasher::hashDisc(hashes, discReader));
+	discReader->unref();
+
+	EXPECT_EQ(FileHasher::supportedHashes(), hashes.flags);
+	EXPECT_EQ(static_cast<int64_t>(m_data.size()), hashes.size);
+
+	const uint32_t crc_expected = static_cast<uint32_t>(
+		crc32(0, m_data.data(), static_cast<uInt>(m_data.size())));
+	EXPECT_EQ(crc_expected, hashes.crc);
+
+#ifdef ENABLE_DECRYPTION
+	uint8_t md5_expected[MD5Hash::HASH_LEN];
+	ASSERT_EQ(0, MD5Hash::calcHash(md5_expected, sizeof(md5_expected), m_data.data(), m_data.size()));
+	EXPECT_EQ(0, memcmp(md5_expected, hashes.md5, sizeof(md5_expected)));
+
+	uint8_t sha1_expected[SHA1Hash::HASH_LEN];
+	ASSERT_EQ(0, SHA1Hash::calcHash(sha1_expected, sizeof(sha1_expected), m_data.data(), m_data.size()));
+	EXPECT_EQ(0, memcmp(sha1_expected, hashes.sha1, sizeof(sha1_expected)));
+#endif /* ENABLE_DECRYPTION */
+}
+
+/**
+ * Test FileHasher::hashDisc() with an empty file.
+ */
+TEST_F(FileHasherTest, hashDiscEmptyTest)
+{
+	RpMemFile *const memFile = new RpMemFile(m_data.data(), 0);
+	DiscReader *const discReader = new DiscReader(memFile);
+	memFile->unref();
+
+	FileHasher::Hashes hashes;
+	EXPECT_EQ(0, FileHasher::hashDisc(hashes, discReader, FileHasher::HASH_CRC32));
+	discReader->unref();
+
+	EXPECT_EQ(static_cast<unsigned int>(FileHasher::HASH_CRC32), hashes.flags);
+	EXPECT_EQ(0, hashes.size);
+	EXPECT_EQ(0U, hashes.crc);
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpBase test suite: FileHasher tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * IconAnimHelperTest.cpp: IconAnimHelper test.                            *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// librpbase, librptexture
+#include "librpbase/img/IconAnimData.hpp"
+#include "librpbase/img/IconAnimHelper.hpp"
+using LibRpTexture::rp_image;
+
+// C includes. (C++ namespace)
+#include <cstdio>
+
+namespace LibRpBase { namespace Tests {
+
+class IconAnimHelperTest : public ::testing::Test
+{
+	protected:
+		IconAnimHelperTest()
+			: iconAnimData(new IconAnimData())
+		{ }
+
+		~IconAnimHelperTest()
+		{
+			iconAnimData->unref();
+		}
+
+		/**
+		 * Add a solid-color ARGB32 frame.
+		 * @param color Frame color.
+		 */
+		void addFrame(uint32_t color)
+		{
+			rp_image *const img = new rp_image(8, 8, rp_image::Format::ARGB32);
+			for (int y = 0; y < img->height(); y++) {
+				uint32_t *px = static_cast<uint32_t*>(img->scanLine(y));
+				for (int x = img->width(); x > 0; x--, px++) {
+					*px = color;
+				}
+			}
+			iconAnimData->frames[iconAnimData->count++] = img;
+		}
+
+		/**
+		 * Add a sequence entry.
+		 * @param frame Frame number.
+		 * @param ms Delay, in milliseconds.
+		 */
+		void addSeq(int frame, int ms)
+		{
+			const int idx = iconAnimData->seq_count++;
+			iconAnimData->seq_index[idx] = static_cast<uint8_t>(frame);
+			iconAnimData->delays[idx].numer = static_cast<uint16_t>(ms);
+			iconAnimData->delays[idx].denom = 1000;
+			iconAnimData->delays[idx].ms = ms;
+		}
+
+		IconAnimData *iconAnimData;
+};
+
+/**
+ * Identical frames should map to the first identical frame.
+ */
+TEST_F(IconAnimHelperTest, baseFrameTest)
+{
+	addFrame(0xFFFF0000);
+	addFrame(0xFF00FF00);
+	addFrame(0xFFFF0000);
+	addFrame(0xFF00FF00);
+	addSeq(0, 100);
+	addSeq(1, 100);
+	addSeq(2, 100);
+	addSeq(3, 100);
+
+	IconAnimHelper helper;
+	helper.setIconAnimData(iconAnimData);
+	EXPECT_EQ(0, helper.baseFrame(0));
+	EXPECT_EQ(1, helper.baseFrame(1));
+	EXPECT_EQ(0, helper.baseFrame(2));
+	EXPECT_EQ(1, helper.baseFrame(3));
+
+	// Only base frames should be returned.
+	int delay = 0;
+	EXPECT_EQ(0, helper.frameNumber());
+	EXPECT_EQ(1, helper.nextFrame(&delay));
+	EXPECT_EQ(100, delay);
+	EXPECT_EQ(0, helper.nextFrame(&delay));
+	EXPECT_EQ(100, delay);
+	EXPECT_EQ(1, helper.nextFrame(&delay));
+	EXPECT_EQ(100, delay);
+	EXPECT_EQ(0, helper.nextFrame(&delay));
+	EXPECT_EQ(100, delay);
+}
+
+/**
+ * Subsequent sequence entries that display the
+ * same frame should be merged into one delay.
+ */
+TEST_F(IconAnimHelperTest, mergeDelayTest)
+{
+	addFrame(0xFFFF0000);
+	addFrame(0xFF00FF00);
+	addFrame(0xFF00FF00);
+	addSeq(0, 100);
+	addSeq(0, 50);
+	addSeq(1, 200);
+	addSeq(2, 300);
+	addSeq(0, 25);
+
+	IconAnimHelper helper;
+	helper.setIconAnimData(iconAnimData);
+
+	// Frame 0 is shown for the first two entries.
+	EXPECT_EQ(0, helper.frameNumber());
+	EXPECT_EQ(150, helper.frameDelay());
+
+	// Frames 1 and 2 are identical.
+	int delay = 0;
+	EXPECT_EQ(1, helper.nextFrame(&delay));
+	EXPECT_EQ(500, delay);
+
+	// The last entry wraps around to the first two entries.
+	EXPECT_EQ(0, helper.nextFrame(&delay));
+	EXPECT_EQ(175, delay);
+	EXPECT_EQ(1, helper.nextFrame(&delay));
+	EXPECT_EQ(500, delay);
+}
+
+/**
+ * Invalid frames should keep displaying the last valid frame.
+ */
+TEST_F(IconAnimHelperTest, invalidFrameTest)
+{
+	addFrame(0xFFFF0000);
+	addFrame(0xFF00FF00);
+	iconAnimData->count++;	// frame 2 is nullptr
+	addSeq(0, 100);
+	addSeq(1, 100);
+	addSeq(2, 100);
+
+	IconAnimHelper helper;
+	helper.setIconAnimData(iconAnimData);
+
+	int delay = 0;
+	EXPECT_EQ(0, helper.frameNumber());
+	EXPECT_EQ(100, helper.frameDelay());
+	EXPECT_EQ(1, helper.nextFrame(&delay));
+	EXPECT_EQ(200, delay);
+	EXPECT_EQ(0, helper.nextFrame(&delay));
+	EXPECT_EQ(100, delay);
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpBase test suite: IconAnimHelper tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
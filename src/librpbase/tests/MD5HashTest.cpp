@@ -17,6 +17,7 @@
 #include <cstdio>
 
 // C++ includes.
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -133,6 +134,35 @@ TEST_P(MD5HashTest, md5HashTest)
 	CompareByteArrays(mode.md5, md5, sizeof(md5), "MD5 hash");
 }
 
+/**
+ * Run an MD5Hash test by adding the data in small chunks.
+ * The hash object is reused to make sure reset() works.
+ */
+TEST_P(MD5HashTest, processTest)
+{
+	const MD5HashTest_mode &mode = GetParam();
+
+	MD5Hash hash;
+	ASSERT_TRUE(hash.isUsable());
+
+	// Hash some garbage data first.
+	uint8_t md5[MD5Hash::HASH_LEN];
+	EXPECT_EQ(0, hash.process("garbage", 7));
+	EXPECT_EQ(0, hash.getHash(md5, sizeof(md5)));
+	EXPECT_EQ(0, hash.reset());
+
+	// Add the string 3 bytes at a time.
+	const size_t len = strlen(mode.str);
+	for (size_t pos = 0; pos < len; pos += 3) {
+		const size_t chunk = std::min(len - pos, static_cast<size_t>(3));
+		EXPECT_EQ(0, hash.process(&mode.str[pos], chunk));
+	}
+	EXPECT_EQ(0, hash.getHash(md5, sizeof(md5)));
+
+	// Compare the hash to the expected hash.
+	CompareByteArrays(mode.md5, md5, sizeof(md5), "MD5 hash");
+}
+
 /** MD5 hash tests. **/
 
 static const uint8_t md5_exp[][16] = {
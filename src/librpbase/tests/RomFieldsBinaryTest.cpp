@@ -0,0 +1,323 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * RomFieldsBinaryTest.cpp: RomFieldsBinary serialization test.            *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// RomFieldsBinary
+#include "librpbase/RomFieldsBinary.hpp"
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+using LibRpTexture::rp_image;
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+class RomFieldsBinaryTest : public ::testing::Test
+{
+	protected:
+		RomFieldsBinaryTest() = default;
+
+	public:
+		/**
+		 * Initialize RomFields and RomMetaData with one field of each type.
+		 * @param fields RomFields
+		 * @param metaData RomMetaData
+		 */
+		static void initFields(RomFields &fields, RomMetaData &metaData);
+};
+
+/**
+ * Initialize RomFields and RomMetaData with one field of each type.
+ * @param fields RomFields
+ * @param metaData RomMetaData
+ */
+void RomFieldsBinaryTest::initFields(RomFields &fields, RomMetaData &metaData)
+{
+	fields.reserveTabs(2);
+	fields.setTabName(0, "First Tab");
+	fields.setTabName(1, "Second Tab");
+
+	fields.addField_string("Title", "Test ROM", RomFields::STRF_MONOSPACE);
+	fields.addField_string("Empty", "");
+
+	vector<string> *const bitfield_names = new vector<string>({"A", "B", "", "D"});
+	fields.addField_bitfield("Flags", bitfield_names, 2, 0x0B);
+
+	fields.setTabIndex(1);
+
+	RomFields::AFLD_PARAMS params;
+	params.flags = RomFields::RFT_LISTDATA_CHECKBOXES;
+	params.rows_visible = 4;
+	params.headers = new vector<string>({"Name", "Value"});
+	params.data.single = new RomFields::ListData_t({{"a", "1"}, {"b", "2"}, {}});
+	params.mxd.checkboxes = 0x5;
+	fields.addField_listData("List", &params);
+
+	fields.addField_dateTime("Date", 1234567890,
+		RomFields::RFT_DATETIME_HAS_DATE | RomFields::RFT_DATETIME_IS_UTC);
+
+	RomFields::age_ratings_t age_ratings;
+	age_ratings.fill(0);
+	age_ratings[RomFields::AGE_USA] = 13 | RomFields::AGEBF_ACTIVE;
+	fields.addField_ageRatings("Ratings", age_ratings);
+
+	fields.addField_dimensions("Size", 640, 480);
+
+	RomFields::StringMultiMap_t *const str_multi = new RomFields::StringMultiMap_t();
+	(*str_multi)['en'] = "Hello";
+	(*str_multi)['de'] = "Hallo";
+	fields.addField_string_multi("Greeting", str_multi, 'en');
+
+	metaData.addMetaData_string(Property::Title, "Test ROM");
+	metaData.addMetaData_integer(Property::Width, -640);
+	metaData.addMetaData_uint(Property::ReleaseYear, 2009);
+	metaData.addMetaData_timestamp(Property::CreationDate, 1234567890);
+}
+
+/**
+ * Serialize, then read the fields in place.
+ */
+TEST_F(RomFieldsBinaryTest, viewTest)
+{
+	RomFields fields;
+	RomMetaData metaData;
+	initFields(fields, metaData);
+
+	vector<uint8_t> buf;
+	ASSERT_EQ(0, RomFieldsBinary::serialize(buf, &fields, &metaData));
+
+	const RomFieldsBinary bin(buf.data(), buf.size());
+	ASSERT_TRUE(bin.isValid());
+	EXPECT_EQ(buf.size(), bin.size());
+	ASSERT_EQ(2, bin.tabCount());
+	EXPECT_STREQ("Second Tab", bin.tabName(1));
+	ASSERT_EQ(fields.count(), bin.count());
+
+	const RomFieldsBinary::Field title = bin.at(0);
+	EXPECT_STREQ("Title", title.name());
+	EXPECT_EQ(RomFields::RFT_STRING, title.type());
+	EXPECT_EQ(static_cast<unsigned int>(RomFields::STRF_MONOSPACE), title.flags());
+	EXPECT_STREQ("Test ROM", title.str());
+
+	const RomFieldsBinary::Field bitfield = bin.at(2);
+	EXPECT_EQ(2, bitfield.bitfieldElemsPerRow());
+	EXPECT_EQ(0x0BU, bitfield.bitfield());
+	ASSERT_EQ(4U, bitfield.bitfieldNameCount());
+	EXPECT_STREQ("D", bitfield.bitfieldName(3));
+	// Wrong type returns a default value.
+	EXPECT_STREQ("", bitfield.str());
+
+	const RomFieldsBinary::Field list = bin.at(3);
+	EXPECT_EQ(1, list.tabIdx());
+	EXPECT_EQ(4, list.listRowsVisible());
+	EXPECT_EQ(0x5U, list.listCheckboxes());
+	ASSERT_EQ(2U, list.listHeaderCount());
+	EXPECT_STREQ("Value", list.listHeader(1));
+	ASSERT_EQ(1U, list.listDataCount());
+	ASSERT_EQ(3U, list.listRowCount(0));
+	EXPECT_STREQ("2", list.listCell(0, 1, 1));
+	EXPECT_EQ(0U, list.listColCount(0, 2));
+	EXPECT_STREQ("", list.listCell(0, 5, 0));
+
+	EXPECT_EQ(1234567890, bin.at(4).dateTime());
+	EXPECT_EQ(480, bin.at(6).dimension(1));
+
+	ASSERT_EQ(metaData.count(), bin.metaDataCount());
+	EXPECT_EQ(Property::Width, bin.metaDataAt(1).name());
+	EXPECT_EQ(-640, bin.metaDataAt(1).ivalue());
+	EXPECT_STREQ("Test ROM", bin.metaDataAt(0).str());
+
+	// Identical strings are stored once.
+	const char *const s1 = title.str();
+	const char *const s2 = bin.metaDataAt(0).str();
+	EXPECT_EQ(s1, s2);
+}
+
+/**
+ * Serialize, convert back to RomFields, and serialize again.
+ * Both serialized buffers must be identical.
+ */
+TEST_F(RomFieldsBinaryTest, roundTripTest)
+{
+	RomFields fields;
+	RomMetaData metaData;
+	initFields(fields, metaData);
+
+	vector<uint8_t> buf1;
+	ASSERT_EQ(0, RomFieldsBinary::serialize(buf1, &fields, &metaData));
+	const RomFieldsBinary bin(buf1.data(), buf1.size());
+	ASSERT_TRUE(bin.isValid());
+
+	RomFields fields2;
+	RomMetaData metaData2;
+	ASSERT_EQ(0, bin.toRomFields(&fields2));
+	ASSERT_EQ(0, bin.toRomMetaData(&metaData2));
+	ASSERT_EQ(fields.count(), fields2.count());
+	ASSERT_EQ(metaData.count(), metaData2.count());
+
+	vector<uint8_t> buf2;
+	ASSERT_EQ(0, RomFieldsBinary::serialize(buf2, &fields2, &metaData2));
+	ASSERT_EQ(buf1.size(), buf2.size());
+	EXPECT_EQ(0, memcmp(buf1.data(), buf2.data(), buf1.size()));
+}
+
+/**
+ * Lazy RFT_STRING_MULTI strings are only converted when they're accessed.
+ */
+TEST_F(RomFieldsBinaryTest, lazyStringMultiTest)
+{
+	vector<uint32_t> converted;
+	RomFields::StringMultiMap_t *const str_multi = new RomFields::StringMultiMap_t(
+		[&converted](uint32_t lc) -> string {
+			converted.push_back(lc);
+			return (lc == 'en' ? "Hello" : "Hallo");
+		});
+	str_multi->addLazy('en');
+	str_multi->addLazy('de');
+	ASSERT_EQ(2U, str_multi->size());
+
+	RomFields fields;
+	fields.addField_string_multi("Greeting", str_multi, 'en');
+	EXPECT_TRUE(converted.empty());
+
+	// Only the requested language is converted.
+	const string *pStr = RomFields::getFromStringMulti(str_multi, 'en', 'de');
+	ASSERT_NE(nullptr, pStr);
+	EXPECT_EQ("Hallo", *pStr);
+	ASSERT_EQ(1U, converted.size());
+	EXPECT_EQ(static_cast<uint32_t>('de'), converted[0]);
+
+	// Strings are only converted once.
+	pStr = RomFields::getFromStringMulti(str_multi, 'en', 'de');
+	ASSERT_NE(nullptr, pStr);
+	EXPECT_EQ(1U, converted.size());
+
+	// Serialization converts everything else.
+	vector<uint8_t> buf;
+	ASSERT_EQ(0, RomFieldsBinary::serialize(buf, &fields, nullptr));
+	ASSERT_EQ(2U, converted.size());
+	EXPECT_EQ("Hello", str_multi->find('en')->second);
+}
+
+/**
+ * Lazy RFT_LISTDATA icons can be accessed from multiple threads
+ * while the cache is evicting icons.
+ */
+TEST_F(RomFieldsBinaryTest, lazyIconsThreadTest)
+{
+	static const size_t rowCount = 64;
+	std::atomic<unsigned int> loadCount(0);
+	RomFields::ListDataIcons_t *const icons = new RomFields::ListDataIcons_t(rowCount,
+		[&loadCount](size_t idx) -> rp_image* {
+			loadCount++;
+			if (idx % 8 == 0) {
+				// No icon for this row.
+				return nullptr;
+			}
+			rp_image *const img = new rp_image(8, 8, rp_image::Format::ARGB32);
+			*static_cast<uint32_t*>(img->bits()) = static_cast<uint32_t>(idx);
+			return img;
+		}, 4);
+
+	// Cache only holds 4 icons, so most get() calls evict an icon
+	// that another thread may still be using.
+	std::atomic<unsigned int> errCount(0);
+	vector<std::thread> threads;
+	for (unsigned int t = 0; t < 4; t++) {
+		threads.emplace_back([icons, t, &errCount]() {
+			for (unsigned int i = 0; i < 4096; i++) {
+				const size_t idx = ((i * 7) + (t * 13)) % rowCount;
+				const rp_image *const img = icons->get(idx);
+				if (idx % 8 == 0) {
+					if (img) {
+						errCount++;
+						img->unref();
+					}
+					continue;
+				}
+				if (!img || *static_cast<const uint32_t*>(img->bits()) != idx) {
+					errCount++;
+				}
+				UNREF(img);
+			}
+		});
+	}
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(0U, errCount.load());
+	EXPECT_GT(loadCount.load(), static_cast<unsigned int>(rowCount));
+	delete icons;
+}
+
+/**
+ * Truncated and corrupted buffers must be rejected or read safely.
+ */
+TEST_F(RomFieldsBinaryTest, corruptTest)
+{
+	RomFields fields;
+	RomMetaData metaData;
+	initFields(fields, metaData);
+
+	vector<uint8_t> buf;
+	ASSERT_EQ(0, RomFieldsBinary::serialize(buf, &fields, &metaData));
+
+	// Truncated buffer.
+	EXPECT_FALSE(RomFieldsBinary(buf.data(), buf.size() - 1).isValid());
+	EXPECT_FALSE(RomFieldsBinary(buf.data(), 16).isValid());
+
+	// Bad magic.
+	vector<uint8_t> bad = buf;
+	bad[0] ^= 0xFF;
+	EXPECT_FALSE(RomFieldsBinary(bad.data(), bad.size()).isValid());
+
+	// Corrupt every byte after the header in turn.
+	// Reading must never go out of bounds.
+	// NOTE: Metadata isn't converted here, since RomMetaData
+	// asserts if a property has the wrong type.
+	for (size_t i = 48; i < buf.size(); i++) {
+		bad = buf;
+		bad[i] ^= 0xA5;
+		const RomFieldsBinary bin(bad.data(), bad.size());
+		if (!bin.isValid())
+			continue;
+
+		RomFields fields2;
+		bin.toRomFields(&fields2);
+	}
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpBase test suite: RomFieldsBinary tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,205 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * SHA1HashTest.cpp: SHA1Hash class test.                                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// SHA1Hash
+#include "../crypto/SHA1Hash.hpp"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+
+// C++ includes.
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+using std::ostringstream;
+using std::string;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+struct SHA1HashTest_mode
+{
+	// String to hash.
+	const char *str;
+
+	// Hash data. (20 bytes)
+	const uint8_t *sha1;
+
+	SHA1HashTest_mode(const char *str, const uint8_t *sha1)
+		: str(str), sha1(sha1)
+	{ }
+};
+
+class SHA1HashTest : public ::testing::TestWithParam<SHA1HashTest_mode>
+{
+	public:
+		/**
+		 * Compare two byte arrays.
+		 * The byte arrays are converted to hexdumps and then
+		 * compared using EXPECT_EQ().
+		 * @param expected	[in] Expected data.
+		 * @param actual	[in] Actual data.
+		 * @param size		[in] Size of both arrays.
+		 * @param data_type	[in] Data type.
+		 */
+		void CompareByteArrays(
+			const uint8_t *expected,
+			const uint8_t *actual,
+			size_t size,
+			const char *data_type);
+};
+
+/**
+ * Compare two byte arrays.
+ * The byte arrays are converted to hexdumps and then
+ * compared using EXPECT_EQ().
+ * @param expected	[in] Expected data.
+ * @param actual	[in] Actual data.
+ * @param size		[in] Size of both arrays.
+ * @param data_type	[in] Data type.
+ */
+void SHA1HashTest::CompareByteArrays(
+	const uint8_t *expected,
+	const uint8_t *actual,
+	size_t size,
+	const char *data_type)
+{
+	// Output format: (assume ~64 bytes per line)
+	// 0000: 01 23 45 67 89 AB CD EF  01 23 45 67 89 AB CD EF
+	const size_t bufSize = ((size / 16) + !!(size % 16)) * 64;
+	char printf_buf[16];
+	string s_expected, s_actual;
+	s_expected.reserve(bufSize);
+	s_actual.reserve(bufSize);
+
+	const uint8_t *pE = expected, *pA = actual;
+	for (size_t i = 0; i < size; i++, pE++, pA++) {
+		if (i % 16 == 0) {
+			// New line.
+			if (i > 0) {
+				// Append newlines.
+				s_expected += '\n';
+				s_actual += '\n';
+			}
+
+			snprintf(printf_buf, sizeof(printf_buf), "%04X: ", static_cast<unsigned int>(i));
+			s_expected += printf_buf;
+			s_actual += printf_buf;
+		}
+
+		// Print the byte.
+		snprintf(printf_buf, sizeof(printf_buf), "%02X", *pE);
+		s_expected += printf_buf;
+		snprintf(printf_buf, sizeof(printf_buf), "%02X", *pA);
+		s_actual += printf_buf;
+
+		if (i % 16 == 7) {
+			s_expected += "  ";
+			s_actual += "  ";
+		} else if (i % 16  < 15) {
+			s_expected += ' ';
+			s_actual += ' ';
+		}
+	}
+
+	// Compare the byte arrays, and
+	// print the strings on failure.
+	EXPECT_EQ(0, memcmp(expected, actual, size)) <<
+		"Expected " << data_type << ":" << '\n' << s_expected << '\n' <<
+		"Actual " << data_type << ":" << '\n' << s_actual << '\n';
+}
+
+/**
+ * Run a SHA1Hash test using calcHash().
+ */
+TEST_P(SHA1HashTest, calcHashTest)
+{
+	const SHA1HashTest_mode &mode = GetParam();
+
+	uint8_t sha1[SHA1Hash::HASH_LEN];
+	EXPECT_EQ(0, SHA1Hash::calcHash(sha1, sizeof(sha1), mode.str, strlen(mode.str)));
+
+	// Compare the hash to the expected hash.
+	CompareByteArrays(mode.sha1, sha1, sizeof(sha1), "SHA-1 hash");
+}
+
+/**
+ * Run a SHA1Hash test by adding the data in small chunks.
+ * The hash object is reused to make sure reset() works.
+ */
+TEST_P(SHA1HashTest, processTest)
+{
+	const SHA1HashTest_mode &mode = GetParam();
+
+	SHA1Hash hash;
+	ASSERT_TRUE(hash.isUsable());
+
+	// Hash some garbage data first.
+	uint8_t sha1[SHA1Hash::HASH_LEN];
+	EXPECT_EQ(0, hash.process("garbage", 7));
+	EXPECT_EQ(0, hash.getHash(sha1, sizeof(sha1)));
+	EXPECT_EQ(0, hash.reset());
+
+	// Add the string 3 bytes at a time.
+	const size_t len = strlen(mode.str);
+	for (size_t pos = 0; pos < len; pos += 3) {
+		const size_t chunk = std::min(len - pos, static_cast<size_t>(3));
+		EXPECT_EQ(0, hash.process(&mode.str[pos], chunk));
+	}
+	EXPECT_EQ(0, hash.getHash(sha1, sizeof(sha1)));
+
+	// Compare the hash to the expected hash.
+	CompareByteArrays(mode.sha1, sha1, sizeof(sha1), "SHA-1 hash");
+}
+
+/** SHA-1 hash tests. **/
+
+static const uint8_t sha1_exp[][20] = {
+	{0xDA,0x39,0xA3,0xEE,0x5E,0x6B,0x4B,0x0D,
+	 0x32,0x55,0xBF,0xEF,0x95,0x60,0x18,0x90,
+	 0xAF,0xD8,0x07,0x09},
+
+	{0x40,0x8D,0x94,0x38,0x42,0x16,0xF8,0x90,
+	 0xFF,0x7A,0x0C,0x35,0x28,0xE8,0xBE,0xD1,
+	 0xE0,0xB0,0x16,0x21},
+
+	{0x66,0x9B,0x35,0x68,0xF8,0xCE,0x8C,0xE1,
+	 0xBD,0xA9,0x91,0x39,0x27,0x10,0xA8,0x1E,
+	 0x87,0x95,0xCB,0x81},
+
+	{0xCC,0xA0,0x87,0x1E,0xCB,0xE2,0x00,0x37,
+	 0x9F,0x0A,0x1E,0x4B,0x46,0xDE,0x17,0x7E,
+	 0x2D,0x62,0xE6,0x55},
+
+	{0x88,0x7B,0x40,0x5B,0x2B,0xFB,0x35,0x58,
+	 0x58,0x57,0xC8,0x8A,0xA0,0xDA,0xF8,0x61,
+	 0x8A,0x17,0x5E,0x88},
+
+	{0xFC,0x11,0xA3,0x90,0x85,0x41,0xC3,0x09,
+	 0xBB,0xEA,0x23,0x64,0x5F,0x4D,0x36,0x5C,
+	 0x11,0xDF,0x50,0xC8},
+};
+
+INSTANTIATE_TEST_SUITE_P(SHA1StringHashTest, SHA1HashTest,
+	::testing::Values(
+		SHA1HashTest_mode("", sha1_exp[0]),
+		SHA1HashTest_mode("The quick brown fox jumps over the lazy dog.", sha1_exp[1]),
+		SHA1HashTest_mode("▁▂▃▄▅▆▇█▉▊▋▌▍▎▏", sha1_exp[2]),
+		SHA1HashTest_mode("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.", sha1_exp[3]),
+		SHA1HashTest_mode("ＳＰＹＲＯ　ＴＨＥ　ＤＲＡＧＯＮ", sha1_exp[4]),
+		SHA1HashTest_mode("ソニック カラーズ", sha1_exp[5])
+		)
+	);
+
+} }
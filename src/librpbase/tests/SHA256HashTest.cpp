@@ -0,0 +1,211 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase/tests)                  *
+ * SHA256HashTest.cpp: SHA256Hash class test.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// SHA256Hash
+#include "../crypto/SHA256Hash.hpp"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+
+// C++ includes.
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+using std::ostringstream;
+using std::string;
+using std::vector;
+
+namespace LibRpBase { namespace Tests {
+
+struct SHA256HashTest_mode
+{
+	// String to hash.
+	const char *str;
+
+	// Hash data. (32 bytes)
+	const uint8_t *sha256;
+
+	SHA256HashTest_mode(const char *str, const uint8_t *sha256)
+		: str(str), sha256(sha256)
+	{ }
+};
+
+class SHA256HashTest : public ::testing::TestWithParam<SHA256HashTest_mode>
+{
+	public:
+		/**
+		 * Compare two byte arrays.
+		 * The byte arrays are converted to hexdumps and then
+		 * compared using EXPECT_EQ().
+		 * @param expected	[in] Expected data.
+		 * @param actual	[in] Actual data.
+		 * @param size		[in] Size of both arrays.
+		 * @param data_type	[in] Data type.
+		 */
+		void CompareByteArrays(
+			const uint8_t *expected,
+			const uint8_t *actual,
+			size_t size,
+			const char *data_type);
+};
+
+/**
+ * Compare two byte arrays.
+ * The byte arrays are converted to hexdumps and then
+ * compared using EXPECT_EQ().
+ * @param expected	[in] Expected data.
+ * @param actual	[in] Actual data.
+ * @param size		[in] Size of both arrays.
+ * @param data_type	[in] Data type.
+ */
+void SHA256HashTest::CompareByteArrays(
+	const uint8_t *expected,
+	const uint8_t *actual,
+	size_t size,
+	const char *data_type)
+{
+	// Output format: (assume ~64 bytes per line)
+	// 0000: 01 23 45 67 89 AB CD EF  01 23 45 67 89 AB CD EF
+	const size_t bufSize = ((size / 16) + !!(size % 16)) * 64;
+	char printf_buf[16];
+	string s_expected, s_actual;
+	s_expected.reserve(bufSize);
+	s_actual.reserve(bufSize);
+
+	const uint8_t *pE = expected, *pA = actual;
+	for (size_t i = 0; i < size; i++, pE++, pA++) {
+		if (i % 16 == 0) {
+			// New line.
+			if (i > 0) {
+				// Append newlines.
+				s_expected += '\n';
+				s_actual += '\n';
+			}
+
+			snprintf(printf_buf, sizeof(printf_buf), "%04X: ", static_cast<unsigned int>(i));
+			s_expected += printf_buf;
+			s_actual += printf_buf;
+		}
+
+		// Print the byte.
+		snprintf(printf_buf, sizeof(printf_buf), "%02X", *pE);
+		s_expected += printf_buf;
+		snprintf(printf_buf, sizeof(printf_buf), "%02X", *pA);
+		s_actual += printf_buf;
+
+		if (i % 16 == 7) {
+			s_expected += "  ";
+			s_actual += "  ";
+		} else if (i % 16  < 15) {
+			s_expected += ' ';
+			s_actual += ' ';
+		}
+	}
+
+	// Compare the byte arrays, and
+	// print the strings on failure.
+	EXPECT_EQ(0, memcmp(expected, actual, size)) <<
+		"Expected " << data_type << ":" << '\n' << s_expected << '\n' <<
+		"Actual " << data_type << ":" << '\n' << s_actual << '\n';
+}
+
+/**
+ * Run a SHA256Hash test using calcHash().
+ */
+TEST_P(SHA256HashTest, calcHashTest)
+{
+	const SHA256HashTest_mode &mode = GetParam();
+
+	uint8_t sha256[SHA256Hash::HASH_LEN];
+	EXPECT_EQ(0, SHA256Hash::calcHash(sha256, sizeof(sha256), mode.str, strlen(mode.str)));
+
+	// Compare the hash to the expected hash.
+	CompareByteArrays(mode.sha256, sha256, sizeof(sha256), "SHA-256 hash");
+}
+
+/**
+ * Run a SHA256Hash test by adding the data in small chunks.
+ * The hash object is reused to make sure reset() works.
+ */
+TEST_P(SHA256HashTest, processTest)
+{
+	const SHA256HashTest_mode &mode = GetParam();
+
+	SHA256Hash hash;
+	ASSERT_TRUE(hash.isUsable());
+
+	// Hash some garbage data first.
+	uint8_t sha256[SHA256Hash::HASH_LEN];
+	EXPECT_EQ(0, hash.process("garbage", 7));
+	EXPECT_EQ(0, hash.getHash(sha256, sizeof(sha256)));
+	EXPECT_EQ(0, hash.reset());
+
+	// Add the string 3 bytes at a time.
+	const size_t len = strlen(mode.str);
+	for (size_t pos = 0; pos < len; pos += 3) {
+		const size_t chunk = std::min(len - pos, static_cast<size_t>(3));
+		EXPECT_EQ(0, hash.process(&mode.str[pos], chunk));
+	}
+	EXPECT_EQ(0, hash.getHash(sha256, sizeof(sha256)));
+
+	// Compare the hash to the expected hash.
+	CompareByteArrays(mode.sha256, sha256, sizeof(sha256), "SHA-256 hash");
+}
+
+/** SHA-256 hash tests. **/
+
+static const uint8_t sha256_exp[][32] = {
+	{0xE3,0xB0,0xC4,0x42,0x98,0xFC,0x1C,0x14,
+	 0x9A,0xFB,0xF4,0xC8,0x99,0x6F,0xB9,0x24,
+	 0x27,0xAE,0x41,0xE4,0x64,0x9B,0x93,0x4C,
+	 0xA4,0x95,0x99,0x1B,0x78,0x52,0xB8,0x55},
+
+	{0xEF,0x53,0x7F,0x25,0xC8,0x95,0xBF,0xA7,
+	 0x82,0x52,0x65,0x29,0xA9,0xB6,0x3D,0x97,
+	 0xAA,0x63,0x15,0x64,0xD5,0xD7,0x89,0xC2,
+	 0xB7,0x65,0x44,0x8C,0x86,0x35,0xFB,0x6C},
+
+	{0x0C,0x60,0xAA,0x79,0x98,0xFD,0x2A,0x75,
+	 0x67,0xEA,0x22,0xBA,0xBE,0xD7,0xEC,0x6E,
+	 0x09,0xDC,0xA2,0x59,0xED,0xF3,0x0A,0x77,
+	 0x4D,0xDA,0xFB,0xAE,0x4E,0x14,0xBE,0x9C},
+
+	{0x97,0x31,0x53,0xF8,0x6E,0xC2,0xDA,0x17,
+	 0x48,0xE6,0x3F,0x0C,0xF8,0x5B,0x89,0x83,
+	 0x5B,0x42,0xF8,0xEE,0x80,0x18,0xC5,0x49,
+	 0x86,0x8A,0x13,0x08,0xA1,0x9F,0x6C,0xA3},
+
+	{0x06,0x90,0x62,0x5B,0x8A,0x7E,0x76,0x0F,
+	 0xFC,0x5B,0xBF,0x6E,0x41,0x15,0x20,0xA2,
+	 0x51,0xDC,0x41,0x63,0x53,0x50,0x56,0xF0,
+	 0x41,0xBC,0xAE,0xAC,0x79,0xF9,0x8F,0xFD},
+
+	{0x91,0xA9,0x25,0xD3,0x4D,0x0E,0xFD,0xC6,
+	 0xA0,0x04,0x0B,0xE0,0x93,0x57,0x42,0x3A,
+	 0x91,0x05,0xC3,0x5A,0x87,0xA7,0xC1,0x27,
+	 0xAE,0x82,0x8B,0xBB,0x20,0xE8,0x66,0x05},
+};
+
+INSTANTIATE_TEST_SUITE_P(SHA256StringHashTest, SHA256HashTest,
+	::testing::Values(
+		SHA256HashTest_mode("", sha256_exp[0]),
+		SHA256HashTest_mode("The quick brown fox jumps over the lazy dog.", sha256_exp[1]),
+		SHA256HashTest_mode("▁▂▃▄▅▆▇█▉▊▋▌▍▎▏", sha256_exp[2]),
+		SHA256HashTest_mode("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.", sha256_exp[3]),
+		SHA256HashTest_mode("ＳＰＹＲＯ　ＴＨＥ　ＤＲＡＧＯＮ", sha256_exp[4]),
+		SHA256HashTest_mode("ソニック カラーズ", sha256_exp[5])
+		)
+	);
+
+} }
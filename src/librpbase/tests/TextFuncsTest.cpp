@@ -48,6 +48,9 @@ class TextFuncsTest : public ::testing::Test
 		TextFuncsTest() { }
 
 	public:
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 100000;
+
 		// NOTE: 8-bit test strings are unsigned in order to prevent
 		// narrowing conversion warnings from appearing.
 		// char16_t is defined as unsigned, so this isn't a problem
@@ -256,6 +259,30 @@ TEST_F(TextFuncsTest, cp1252_to_utf16)
 	EXPECT_EQ(cp1252_utf16_data, str);
 }
 
+/**
+ * Test cp1252_to_utf8() with strings that are mostly ASCII.
+ * ASCII strings are copied directly, so a single non-ASCII
+ * character at any position must still be converted.
+ */
+TEST_F(TextFuncsTest, cp1252_to_utf8_mostly_ascii)
+{
+	char cp1252_in[40+1];
+	for (int i = 0; i < 40; i++) {
+		memset(cp1252_in, 'a', 40);
+		cp1252_in[40] = '\0';
+		cp1252_in[i] = (char)0xE9;	// 'é'
+
+		const string expected = string(i, 'a') + "\xC3\xA9" + string(40-i-1, 'a');
+		EXPECT_EQ(expected, cp1252_to_utf8(cp1252_in, -1)) << "Non-ASCII character at offset " << i;
+	}
+
+	// Pure ASCII.
+	memset(cp1252_in, 'a', 40);
+	EXPECT_EQ(string(40, 'a'), cp1252_to_utf8(cp1252_in, 40));
+	EXPECT_EQ(u16string(40, u'a'), cp1252_to_utf16(cp1252_in, 40));
+	EXPECT_EQ(string(40, 'a'), utf8_to_cp1252(cp1252_in, 40));
+}
+
 /** Code Page 1252 + Shift-JIS (932) **/
 
 /**
@@ -582,6 +609,84 @@ TEST_F(TextFuncsTest, utf16_to_utf8)
 	EXPECT_EQ((const char*)utf8_data, str);
 }
 
+/**
+ * Test utf16le_to_utf8() and utf16be_to_utf8() with surrogate pairs.
+ * The pairs are placed at every offset in order to test
+ * pairs that cross the SIMD block boundaries.
+ */
+TEST_F(TextFuncsTest, utf16_to_utf8_surrogates)
+{
+	for (int i = 0; i < 24; i++) {
+		// U+1F600: D83D DE00 (F0 9F 98 80)
+		u16string u16str(24, u'a');
+		u16str.replace(i, 0, u"\xD83D\xDE00");
+		const string expected = string(i, 'a') + "\xF0\x9F\x98\x80" + string(24-i, 'a');
+
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+		EXPECT_EQ(expected, utf16le_to_utf8(u16str.data(), static_cast<int>(u16str.size()))) << "offset " << i;
+		u16str = utf16_bswap(u16str.data(), static_cast<int>(u16str.size()));
+		EXPECT_EQ(expected, utf16be_to_utf8(u16str.data(), static_cast<int>(u16str.size()))) << "offset " << i;
+#else /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
+		EXPECT_EQ(expected, utf16be_to_utf8(u16str.data(), static_cast<int>(u16str.size()))) << "offset " << i;
+		u16str = utf16_bswap(u16str.data(), static_cast<int>(u16str.size()));
+		EXPECT_EQ(expected, utf16le_to_utf8(u16str.data(), static_cast<int>(u16str.size()))) << "offset " << i;
+#endif
+	}
+}
+
+/**
+ * Test utf16_to_utf8() with unpaired surrogates.
+ * Unpaired surrogates should be replaced with U+FFFD.
+ */
+TEST_F(TextFuncsTest, utf16_to_utf8_unpaired_surrogates)
+{
+	// High surrogate followed by a non-surrogate.
+	static const char16_t u16_hi[] = u"ab\xD83D" u"cdefghijklmnop";
+	EXPECT_EQ("ab\xEF\xBF\xBD" "cdefghijklmnop", utf16_to_utf8(u16_hi, -1));
+
+	// Low surrogate without a high surrogate.
+	static const char16_t u16_lo[] = u"abcdefg\xDE00hijklmnop";
+	EXPECT_EQ("abcdefg\xEF\xBF\xBD" "hijklmnop", utf16_to_utf8(u16_lo, -1));
+
+	// High surrogate at the end of the string.
+	static const char16_t u16_end[] = u"abcdefghijklmnop\xD83D";
+	EXPECT_EQ("abcdefghijklmnop\xEF\xBF\xBD", utf16_to_utf8(u16_end, -1));
+}
+
+/**
+ * Benchmark utf16le_to_utf8() with ASCII text.
+ */
+TEST_F(TextFuncsTest, utf16le_to_utf8_ascii_benchmark)
+{
+	// Typical Nintendo 3DS SMDH title.
+	static const uint8_t utf16le_in[] = {
+		'P',0, 'o',0, 'k',0, 0xE9,0, 'm',0, 'o',0, 'n',0, ' ',0,
+		'U',0, 'l',0, 't',0, 'r',0, 'a',0, ' ',0, 'S',0, 'u',0,
+		'n',0, 0,0
+	};
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		string str = utf16le_to_utf8((const char16_t*)utf16le_in, ARRAY_SIZE(utf16le_in)/2);
+		EXPECT_EQ(18U, str.size());
+	}
+}
+
+/**
+ * Benchmark utf16be_to_utf8() with Japanese text.
+ */
+TEST_F(TextFuncsTest, utf16be_to_utf8_japanese_benchmark)
+{
+	// "ポケットモンスター ウルトラサン" (UTF-16BE)
+	static const uint8_t utf16be_in[] = {
+		0x30,0xDD, 0x30,0xB1, 0x30,0xC3, 0x30,0xC8, 0x30,0xE2, 0x30,0xF3,
+		0x30,0xB9, 0x30,0xBF, 0x30,0xFC, 0x00,0x20, 0x30,0xA6, 0x30,0xEB,
+		0x30,0xC8, 0x30,0xE9, 0x30,0xB5, 0x30,0xF3, 0x00,0x00
+	};
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		string str = utf16be_to_utf8((const char16_t*)utf16be_in, ARRAY_SIZE(utf16be_in)/2);
+		EXPECT_EQ(46U, str.size());
+	}
+}
+
 /**
  * Test utf16_bswap() with regular text and special characters.
  * This function converts from BE to LE.
@@ -925,6 +1030,8 @@ TEST_F(TextFuncsTest, atascii_to_utf8)
 extern "C" int gtest_main(int argc, TCHAR *argv[])
 {
 	fprintf(stderr, "LibRpBase test suite: TextFuncs tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u\n",
+		LibRpBase::Tests::TextFuncsTest::BENCHMARK_ITERATIONS);
 	fflush(nullptr);
 
 	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
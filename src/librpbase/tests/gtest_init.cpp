@@ -60,6 +60,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 #elif defined(__NR_openat2)
 		__NR_openat2,		// Linux 5.6
 #endif /* __SNR_openat2 || __NR_openat2 */
+		SCMP_SYS(pread64),	// LibRpFile::RpFile::pread()
 
 		// Google Test
 		SCMP_SYS(getcwd),	// testing::internal::FilePath::GetCurrentDir()
@@ -70,6 +71,15 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		SCMP_SYS(close),	// mktime() [mz_zip_dosdate_to_time_t()]
 		SCMP_SYS(stat), SCMP_SYS(stat64),	// mktime() [mz_zip_dosdate_to_time_t()]
 
+		// DetectCacheTest (temporary cache directory)
+		SCMP_SYS(access), SCMP_SYS(faccessat),	// LibUnixCommon::isWritableDirectory()
+		SCMP_SYS(mkdir), SCMP_SYS(mkdirat),	// mkdtemp(), LibRpFile::FileSystem::rmkdir()
+		SCMP_SYS(rename), SCMP_SYS(renameat),	// DetectCache compaction
+#if defined(__SNR_renameat2) || defined(__NR_renameat2)
+		SCMP_SYS(renameat2),	// renameat() on arm64
+#endif /* __SNR_renameat2 || __NR_renameat2 */
+		SCMP_SYS(rmdir), SCMP_SYS(unlink), SCMP_SYS(unlinkat),
+
 		// glibc ncsd
 		// TODO: Restrict connect() to AF_UNIX.
 		SCMP_SYS(connect), SCMP_SYS(recvmsg), SCMP_SYS(sendto),
@@ -86,9 +96,10 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	// Promises:
 	// - stdio: General stdio functionality.
 	// - rpath: Read test cases.
-	param.promises = "stdio rpath";
+	// - wpath, cpath: Temporary cache directory. (DetectCacheTest)
+	param.promises = "stdio rpath wpath cpath";
 #elif defined(HAVE_TAME)
-	param.tame_flags = TAME_STDIO | TAME_RPATH;
+	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH;
 #else
 	param.dummy = 0;
 #endif
@@ -985,6 +985,42 @@ TEST_P(RpPngFormatTest, loadTest)
 	}
 }
 
+/**
+ * Load the PNG image using each RpPng::CheckLevel.
+ */
+TEST_P(RpPngFormatTest, checkLevelTest)
+{
+	const RpPngFormatTest_mode &mode = GetParam();
+	ASSERT_GT(m_png_buf.size(), sizeof(PNG_magic) + sizeof(PNG_IHDR_full_t)) <<
+		"PNG image is too small.";
+
+	static const RpPng::CheckLevel checkLevels[] = {
+		RpPng::CheckLevel::Full,
+		RpPng::CheckLevel::Structure,
+		RpPng::CheckLevel::None,
+	};
+	for (RpPng::CheckLevel checkLevel : checkLevels) {
+		unique_RefBase<RpMemFile> png_mem_file(new RpMemFile(m_png_buf.data(), m_png_buf.size()));
+		ASSERT_TRUE(png_mem_file->isOpen());
+
+		rp_image *const img = RpImageLoader::load(png_mem_file.get(), checkLevel);
+		ASSERT_NE(nullptr, img) << "RpImageLoader failed to load the image. (checkLevel == " << (int)checkLevel << ")";
+		EXPECT_EQ((int)mode.ihdr.width, img->width()) << "rp_image width is incorrect.";
+		EXPECT_EQ((int)mode.ihdr.height, img->height()) << "rp_image height is incorrect.";
+		EXPECT_EQ(mode.rp_format, img->format()) << "rp_image format is incorrect.";
+		img->unref();
+	}
+
+	// A truncated PNG image should fail the chunk structure check.
+	unique_RefBase<RpMemFile> png_mem_file(new RpMemFile(m_png_buf.data(), m_png_buf.size() - 16));
+	ASSERT_TRUE(png_mem_file->isOpen());
+	rp_image *const img = RpPng::load(png_mem_file.get(), RpPng::CheckLevel::Structure);
+	EXPECT_EQ(nullptr, img) << "Truncated PNG image was not rejected.";
+	if (img) {
+		img->unref();
+	}
+}
+
 /**
  * Test case suffix generator.
  * @param info Test parameter information.
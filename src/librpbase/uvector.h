@@ -8,6 +8,9 @@
 #include <utility>
 #include <stdexcept>
 
+// rom-properties: Allocation statistics.
+#include "librpfile/RpAllocStats.hpp"
+
 /**
  * @file uvector.h
  * Header file for uvector and its relational and swap functions.
@@ -904,6 +907,8 @@ private:
 	
 	pointer allocate(size_t n)
 	{
+		// rom-properties: Allocation statistics.
+		LibRpFile::RpAllocStats::onAlloc(LibRpFile::RpAllocStats::TAG_UVECTOR, n * sizeof(Tp));
 		return Alloc::allocate(n);
 	}
 	
@@ -915,7 +920,11 @@ private:
 	void deallocate(pointer begin, size_t n) noexcept
 	{
 		if(begin != nullptr)
+		{
+			// rom-properties: Allocation statistics.
+			LibRpFile::RpAllocStats::onFree(LibRpFile::RpAllocStats::TAG_UVECTOR, n * sizeof(Tp));
 			Alloc::deallocate(begin, n);
+		}
 	}
 	
 	template<typename InputIterator>
@@ -43,8 +43,11 @@ void __byte_swap_16_array_c(uint16_t *ptr, size_t n)
 	// Check if ptr is 32-bit aligned.
 	if (((uintptr_t)ptr & 3) != 0) {
 		// Byteswap the first WORD to fix alignment.
+		if (n == 0)
+			return;
 		*ptr = __swab16(*ptr);
 		ptr++;
+		n -= 2;
 	}
 
 	// Process 8 WORDs per iteration,
@@ -24,10 +24,20 @@
 #if defined(__arm__) || defined(__thumb__) || defined(__arm) || defined(_ARM) || defined(_M_ARM)
 # define RP_CPU_ARM 1
 #endif
-#if defined(__aarch64__)
+#if defined(__aarch64__) || defined(_M_ARM64)
 # define RP_CPU_ARM64 1
 #endif
 
+// ARM NEON (Advanced SIMD).
+// NEON is mandatory on ARM64, so no runtime check is needed.
+// TODO: 32-bit ARM NEON, using getauxval(AT_HWCAP) on Linux.
+// The NEON code currently uses AArch64-only instructions, e.g. TBL.
+// NOTE: Big-endian AArch64 is excluded, since the NEON code
+// assumes argb32_t is stored in little-endian byte order.
+#if defined(RP_CPU_ARM64) && !defined(__AARCH64EB__)
+# define RP_CPU_ALWAYS_HAS_NEON 1
+#endif
+
 // Check for IFUNC.
 // Requires gcc-4.6.0, binutils-2.20.1, and glibc-2.11.1.
 // clang-3.9.0 also supports IFUNC.
@@ -18,6 +18,15 @@
 // librpthreads
 #include "librpthreads/pthread_once.h"
 
+// C includes.
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+# include <fcntl.h>
+# include <unistd.h>
+extern char **environ;
+#endif /* __linux__ */
+
 #if defined(_MSC_VER) && _MSC_VER >= 1400
 # include <intrin.h>
 #endif
@@ -43,9 +52,11 @@
 
 // Flags stored in the %ecx register.
 #define CPUFLAG_IA32_ECX_SSE3		((uint32_t)(1U << 0))
+#define CPUFLAG_IA32_ECX_PCLMULQDQ	((uint32_t)(1U << 1))
 #define CPUFLAG_IA32_ECX_SSSE3		((uint32_t)(1U << 9))
 #define CPUFLAG_IA32_ECX_SSE41		((uint32_t)(1U << 19))
 #define CPUFLAG_IA32_ECX_SSE42		((uint32_t)(1U << 20))
+#define CPUFLAG_IA32_ECX_AESNI		((uint32_t)(1U << 25))
 #define CPUFLAG_IA32_ECX_XSAVE		((uint32_t)(1U << 26))
 #define CPUFLAG_IA32_ECX_OSXSAVE	((uint32_t)(1U << 27))
 #define CPUFLAG_IA32_ECX_AVX		((uint32_t)(1U << 28))
@@ -185,6 +196,73 @@ static FORCEINLINE void cpuid(unsigned int level, unsigned int regs[4])
 #endif
 }
 
+/**
+ * Run the `cpuid` instruction with a subleaf.
+ * @param level
+ * @param subleaf Subleaf. (%ecx)
+ * @param regs Registers. (%eax, %ebx, %ecx, %edx)
+ */
+static FORCEINLINE void cpuid_count(unsigned int level, unsigned int subleaf, unsigned int regs[4])
+{
+#if defined(__GNUC__)
+# ifdef ASM_RESERVE_EBX
+	__asm__ (
+		"xchgl	%%ebx, %1\n"
+		"cpuid\n"
+		"xchgl	%%ebx, %1\n"
+		: "=a" (regs[0]), "=r" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+		: "0" (level), "2" (subleaf)
+		);
+# else /* !ASM_RESERVE_EBX */
+	__asm__ (
+		"cpuid\n"
+		: "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+		: "0" (level), "2" (subleaf)
+		);
+# endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1500
+	// CPUID with subleaf for MSVC 2008+
+	// Uses the __cpuidex() intrinsic.
+	__cpuidex((int*)regs, level, subleaf);
+#else
+	// No subleaf support.
+	// Only used for extended features, so pretend nothing is supported.
+	RP_UNUSED(level);
+	RP_UNUSED(subleaf);
+	regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#endif
+}
+
+// XCR0 bits: SSE and AVX state are saved by the OS.
+#define XCR0_SSE_AVX	((uint32_t)(0x06U))
+
+/**
+ * Read XCR0 using the `xgetbv` instruction.
+ * NOTE: Only call this if CPUID reports OSXSAVE.
+ * @return Low 32 bits of XCR0.
+ */
+static FORCEINLINE uint32_t xgetbv_xcr0(void)
+{
+#if defined(__GNUC__)
+	// NOTE: Using the raw opcode for older assemblers
+	// that don't recognize `xgetbv`.
+	uint32_t __eax, __edx;
+	__asm__ (
+		".byte 0x0f, 0x01, 0xd0\n"
+		: "=a" (__eax), "=d" (__edx)
+		: "c" (0)
+		);
+	RP_UNUSED(__edx);
+	return __eax;
+#elif defined(_MSC_VER) && _MSC_VER >= 1600
+	// MSVC 2010 SP1+
+	return (uint32_t)_xgetbv(0);
+#else
+	// Not supported. Assume the OS doesn't save the YMM registers.
+	return 0;
+#endif
+}
+
 // Register indexes.
 #define REG_EAX 0
 #define REG_EBX 1
@@ -194,6 +272,139 @@ static FORCEINLINE void cpuid(unsigned int level, unsigned int regs[4])
 uint32_t RP_CPU_Flags = 0;
 int RP_CPU_Flags_Init = 0;	// 1 if RP_CPU_Flags has been initialized.
 
+/** CPU tier override **/
+
+// CPU tiers for RP_CPU_TIER.
+// Each tier includes the flags of the previous tiers.
+typedef struct _cpu_tier_t {
+	char name[8];
+	uint32_t flags;
+} cpu_tier_t;
+
+#define CPU_TIER_SSE2 (RP_CPUFLAG_X86_MMX | RP_CPUFLAG_X86_SSE | RP_CPUFLAG_X86_SSE2)
+#define CPU_TIER_SSSE3 (CPU_TIER_SSE2 | RP_CPUFLAG_X86_SSE3 | RP_CPUFLAG_X86_SSSE3)
+#define CPU_TIER_SSE42 (CPU_TIER_SSSE3 | RP_CPUFLAG_X86_SSE41 | RP_CPUFLAG_X86_SSE42)
+
+static const cpu_tier_t cpu_tiers[] = {
+	{"c",		0},
+	{"mmx",		RP_CPUFLAG_X86_MMX},
+	{"sse2",	CPU_TIER_SSE2},
+	{"sse3",	CPU_TIER_SSE2 | RP_CPUFLAG_X86_SSE3},
+	{"ssse3",	CPU_TIER_SSSE3},
+	{"sse41",	CPU_TIER_SSSE3 | RP_CPUFLAG_X86_SSE41},
+	{"sse42",	CPU_TIER_SSE42},
+	{"avx",		CPU_TIER_SSE42 | RP_CPUFLAG_X86_AVX},
+	{"avx2",	CPU_TIER_SSE42 | RP_CPUFLAG_X86_AVX | RP_CPUFLAG_X86_AVX2},
+};
+
+// Selected CPU tier override, or NULL if none.
+static const cpu_tier_t *cpu_tier_override = NULL;
+
+#ifdef __linux__
+/**
+ * Get an environment variable from /proc/self/environ.
+ *
+ * If an IFUNC resolver in the main executable is the first caller of
+ * RP_CPU_InitCPUFlags(), the C library hasn't been initialized yet,
+ * so getenv() won't find anything.
+ *
+ * @param name Variable name, including the trailing '='.
+ * @param buf Buffer for the value.
+ * @param size Size of buf.
+ * @return buf on success; NULL if not found.
+ */
+static const char *procfs_getenv(const char *name, char *buf, size_t size)
+{
+	const size_t name_len = strlen(name);
+	char chunk[512];
+	ssize_t n;
+	size_t pos = 0, vlen = 0;
+	int matching = 1;
+
+	int fd = open("/proc/self/environ", O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	// Entries are NUL-terminated "NAME=value" strings.
+	while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+		ssize_t i;
+		for (i = 0; i < n; i++) {
+			const char chr = chunk[i];
+			if (chr == '\0') {
+				if (matching && pos >= name_len) {
+					// Found the variable.
+					buf[vlen] = '\0';
+					close(fd);
+					return buf;
+				}
+				// Next entry.
+				pos = 0;
+				vlen = 0;
+				matching = 1;
+				continue;
+			}
+
+			if (!matching) {
+				continue;
+			} else if (pos < name_len) {
+				if (chr != name[pos])
+					matching = 0;
+			} else if (vlen < size - 1) {
+				buf[vlen++] = chr;
+			}
+			pos++;
+		}
+	}
+
+	close(fd);
+	return NULL;
+}
+#endif /* __linux__ */
+
+/**
+ * Apply the RP_CPU_TIER override to RP_CPU_Flags.
+ */
+static void RP_CPU_ApplyTierOverride(void)
+{
+	const char *env;
+	uint32_t mask;
+	unsigned int i;
+#ifdef __linux__
+	char buf[16];
+	if (!environ) {
+		// The C library hasn't been initialized yet.
+		env = procfs_getenv("RP_CPU_TIER=", buf, sizeof(buf));
+	} else
+#endif /* __linux__ */
+	{
+		env = getenv("RP_CPU_TIER");
+	}
+	if (!env || env[0] == '\0')
+		return;
+
+	for (i = 0; i < (unsigned int)ARRAY_SIZE(cpu_tiers); i++) {
+		if (!strcmp(env, cpu_tiers[i].name)) {
+			cpu_tier_override = &cpu_tiers[i];
+			break;
+		}
+	}
+	if (!cpu_tier_override) {
+		// Invalid tier. Ignore it.
+		return;
+	}
+
+	mask = cpu_tier_override->flags;
+#if defined(__amd64__) || defined(__x86_64__) || defined(_M_X64)
+	// amd64 always has SSE2.
+	mask |= CPU_TIER_SSE2;
+#endif
+	if (mask & RP_CPUFLAG_X86_SSE2) {
+		// AES-NI and PCLMULQDQ aren't part of the SIMD tiers.
+		mask |= (RP_CPUFLAG_X86_AESNI | RP_CPUFLAG_X86_PCLMULQDQ);
+	}
+	RP_CPU_Flags &= mask;
+}
+
 /**
  * Initialize RP_CPU_Flags. (internal function)
  * Called by pthread_once().
@@ -295,6 +506,20 @@ static void RP_CPU_InitCPUFlags_int(void)
 				RP_CPU_Flags |= RP_CPUFLAG_X86_SSE41;
 			if (regs[REG_ECX] & CPUFLAG_IA32_ECX_SSE42)
 				RP_CPU_Flags |= RP_CPUFLAG_X86_SSE42;
+
+			// AES-NI requires SSE2.
+			if ((regs[REG_EDX] & CPUFLAG_IA32_EDX_SSE2) &&
+			    (regs[REG_ECX] & CPUFLAG_IA32_ECX_AESNI))
+			{
+				RP_CPU_Flags |= RP_CPUFLAG_X86_AESNI;
+			}
+
+			// PCLMULQDQ requires SSE2.
+			if ((regs[REG_EDX] & CPUFLAG_IA32_EDX_SSE2) &&
+			    (regs[REG_ECX] & CPUFLAG_IA32_ECX_PCLMULQDQ))
+			{
+				RP_CPU_Flags |= RP_CPUFLAG_X86_PCLMULQDQ;
+			}
 		}
 #else /* !(defined(__i386__) || defined(_M_IX86)) */
 		// AMD64: SSE2 and lower are always supported.
@@ -307,9 +532,35 @@ static void RP_CPU_InitCPUFlags_int(void)
 			RP_CPU_Flags |= RP_CPUFLAG_X86_SSE41;
 		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_SSE42)
 			RP_CPU_Flags |= RP_CPUFLAG_X86_SSE42;
+		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_AESNI)
+			RP_CPU_Flags |= RP_CPUFLAG_X86_AESNI;
+		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_PCLMULQDQ)
+			RP_CPU_Flags |= RP_CPUFLAG_X86_PCLMULQDQ;
 #endif /* defined(__i386__) || defined(_M_IX86) */
+
+		// Check for AVX and AVX2.
+		// The OS must save the YMM registers. This is checked using
+		// OSXSAVE and XCR0, which handles VMs and older OSes that
+		// don't support AVX.
+		if ((RP_CPU_Flags & RP_CPUFLAG_X86_SSE2) &&
+		    (regs[REG_ECX] & (CPUFLAG_IA32_ECX_OSXSAVE | CPUFLAG_IA32_ECX_AVX)) ==
+		     (CPUFLAG_IA32_ECX_OSXSAVE | CPUFLAG_IA32_ECX_AVX) &&
+		    (xgetbv_xcr0() & XCR0_SSE_AVX) == XCR0_SSE_AVX)
+		{
+			RP_CPU_Flags |= RP_CPUFLAG_X86_AVX;
+
+			// AVX2 is reported in the extended features.
+			if (maxFunc >= CPUID_EXT_FEATURES) {
+				cpuid_count(CPUID_EXT_FEATURES, 0, regs);
+				if (regs[REG_EBX] & CPUFLAG_IA32_FN7_EBX_AVX2)
+					RP_CPU_Flags |= RP_CPUFLAG_X86_AVX2;
+			}
+		}
 	}
 
+	// Apply the RP_CPU_TIER override, if set.
+	RP_CPU_ApplyTierOverride();
+
 	// CPU flags initialized.
 	RP_CPU_Flags_Init = 1;
 }
@@ -322,3 +573,13 @@ void RP_CPU_InitCPUFlags(void)
 	static pthread_once_t once_control = PTHREAD_ONCE_INIT;
 	pthread_once(&once_control, RP_CPU_InitCPUFlags_int);
 }
+
+/**
+ * Get the CPU tier override.
+ * @return Tier name, or NULL if no valid override is set.
+ */
+const char *RP_CPU_GetTierOverride(void)
+{
+	RP_CPU_InitCPUFlags();
+	return (cpu_tier_override ? cpu_tier_override->name : NULL);
+}
@@ -29,6 +29,10 @@ extern "C" {
 #define RP_CPUFLAG_X86_SSSE3		((uint32_t)(1U << 4))
 #define RP_CPUFLAG_X86_SSE41		((uint32_t)(1U << 5))
 #define RP_CPUFLAG_X86_SSE42		((uint32_t)(1U << 6))
+#define RP_CPUFLAG_X86_AESNI		((uint32_t)(1U << 7))
+#define RP_CPUFLAG_X86_AVX		((uint32_t)(1U << 8))
+#define RP_CPUFLAG_X86_AVX2		((uint32_t)(1U << 9))
+#define RP_CPUFLAG_X86_PCLMULQDQ	((uint32_t)(1U << 10))
 
 #endif /* defined(__i386__) || defined(__amd64__) || defined(__x86_64__) */
 
@@ -41,6 +45,23 @@ extern int RP_CPU_Flags_Init;	// 1 if RP_CPU_Flags has been initialized.
  */
 void RP_CPU_InitCPUFlags(void);
 
+/**
+ * Get the CPU tier override.
+ *
+ * The RP_CPU_TIER environment variable limits RP_CPU_Flags to the
+ * specified tier, which affects all RP_CPU_Has*() checks, including
+ * the ones in IFUNC resolvers. This can be used to test and benchmark
+ * the lower-tier code paths on newer CPUs.
+ *
+ * Valid tiers: c, mmx, sse2, sse3, ssse3, sse41, sse42, avx, avx2
+ * AES-NI and PCLMULQDQ are kept if the tier includes SSE2.
+ *
+ * NOTE: amd64 always has SSE2, so "c" and "mmx" are treated as "sse2".
+ *
+ * @return Tier name, or NULL if no valid override is set.
+ */
+const char *RP_CPU_GetTierOverride(void);
+
 /**
  * Check if the CPU supports MMX.
  * @return Non-zero if MMX is supported; 0 if not.
@@ -99,6 +120,56 @@ static FORCEINLINE int RP_CPU_HasSSE41(void)
 	return (RP_CPU_Flags & RP_CPUFLAG_X86_SSE41);
 }
 
+/**
+ * Check if the CPU supports AES-NI.
+ * @return Non-zero if AES-NI is supported; 0 if not.
+ */
+static FORCEINLINE int RP_CPU_HasAESNI(void)
+{
+	if (unlikely(!RP_CPU_Flags_Init)) {
+		RP_CPU_InitCPUFlags();
+	}
+	return (RP_CPU_Flags & RP_CPUFLAG_X86_AESNI);
+}
+
+/**
+ * Check if the CPU supports PCLMULQDQ.
+ * @return Non-zero if PCLMULQDQ is supported; 0 if not.
+ */
+static FORCEINLINE int RP_CPU_HasPCLMULQDQ(void)
+{
+	if (unlikely(!RP_CPU_Flags_Init)) {
+		RP_CPU_InitCPUFlags();
+	}
+	return (RP_CPU_Flags & RP_CPUFLAG_X86_PCLMULQDQ);
+}
+
+/**
+ * Check if the CPU supports AVX.
+ * This also checks if the OS saves the YMM registers.
+ * @return Non-zero if AVX is supported; 0 if not.
+ */
+static FORCEINLINE int RP_CPU_HasAVX(void)
+{
+	if (unlikely(!RP_CPU_Flags_Init)) {
+		RP_CPU_InitCPUFlags();
+	}
+	return (RP_CPU_Flags & RP_CPUFLAG_X86_AVX);
+}
+
+/**
+ * Check if the CPU supports AVX2.
+ * This also checks if the OS saves the YMM registers.
+ * @return Non-zero if AVX2 is supported; 0 if not.
+ */
+static FORCEINLINE int RP_CPU_HasAVX2(void)
+{
+	if (unlikely(!RP_CPU_Flags_Init)) {
+		RP_CPU_InitCPUFlags();
+	}
+	return (RP_CPU_Flags & RP_CPUFLAG_X86_AVX2);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,234 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpcpu)                         *
+ * simd_registry.c: SIMD kernel registry.                                  *
+ *                                                                         *
+ * Copyright (c) 2020 by David Korth.                                      *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "simd_registry.h"
+#include "byteswap.h"
+
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
+// C includes.
+#include <assert.h>
+#include <errno.h>
+
+// Registered kernels.
+#define RP_SIMD_MAX_KERNELS 32
+static const RP_SIMD_Kernel *rp_simd_kernels[RP_SIMD_MAX_KERNELS];
+static unsigned int rp_simd_kernel_count = 0;
+
+/** librpcpu kernels **/
+
+// NOTE: The benchmark functions are wrappers, since the
+// byteswap functions take uint16_t* and uint32_t*.
+#define BYTESWAP_BENCH(bits, opt) \
+static void bench_byte_swap_##bits##_array_##opt(uint8_t *buf, size_t size) \
+{ \
+	__byte_swap_##bits##_array_##opt((uint##bits##_t*)buf, size); \
+}
+
+#ifdef BYTESWAP_HAS_AVX2
+BYTESWAP_BENCH(16, avx2)
+BYTESWAP_BENCH(32, avx2)
+#endif /* BYTESWAP_HAS_AVX2 */
+#ifdef BYTESWAP_HAS_SSSE3
+BYTESWAP_BENCH(16, ssse3)
+BYTESWAP_BENCH(32, ssse3)
+#endif /* BYTESWAP_HAS_SSSE3 */
+#ifdef BYTESWAP_HAS_SSE2
+BYTESWAP_BENCH(16, sse2)
+BYTESWAP_BENCH(32, sse2)
+#endif /* BYTESWAP_HAS_SSE2 */
+#ifdef BYTESWAP_HAS_MMX
+BYTESWAP_BENCH(16, mmx)
+#endif /* BYTESWAP_HAS_MMX */
+#ifdef BYTESWAP_HAS_NEON
+BYTESWAP_BENCH(16, neon)
+BYTESWAP_BENCH(32, neon)
+#endif /* BYTESWAP_HAS_NEON */
+BYTESWAP_BENCH(16, c)
+BYTESWAP_BENCH(32, c)
+
+static const RP_SIMD_Variant byte_swap_16_array_variants[] = {
+#ifdef BYTESWAP_HAS_NEON
+	{"neon", 0, bench_byte_swap_16_array_neon},
+#endif /* BYTESWAP_HAS_NEON */
+#ifdef BYTESWAP_HAS_AVX2
+	{"avx2", RP_CPUFLAG_X86_AVX2, bench_byte_swap_16_array_avx2},
+#endif /* BYTESWAP_HAS_AVX2 */
+#ifdef BYTESWAP_HAS_SSSE3
+	{"ssse3", RP_CPUFLAG_X86_SSSE3, bench_byte_swap_16_array_ssse3},
+#endif /* BYTESWAP_HAS_SSSE3 */
+#ifdef BYTESWAP_HAS_SSE2
+	{"sse2", RP_CPUFLAG_X86_SSE2, bench_byte_swap_16_array_sse2},
+#endif /* BYTESWAP_HAS_SSE2 */
+#ifdef BYTESWAP_HAS_MMX
+	{"mmx", RP_CPUFLAG_X86_MMX, bench_byte_swap_16_array_mmx},
+#endif /* BYTESWAP_HAS_MMX */
+	{"c", 0, bench_byte_swap_16_array_c},
+};
+
+// NOTE: The 32-bit MMX version isn't used by the dispatch
+// function, since it's slower than the C version.
+static const RP_SIMD_Variant byte_swap_32_array_variants[] = {
+#ifdef BYTESWAP_HAS_NEON
+	{"neon", 0, bench_byte_swap_32_array_neon},
+#endif /* BYTESWAP_HAS_NEON */
+#ifdef BYTESWAP_HAS_AVX2
+	{"avx2", RP_CPUFLAG_X86_AVX2, bench_byte_swap_32_array_avx2},
+#endif /* BYTESWAP_HAS_AVX2 */
+#ifdef BYTESWAP_HAS_SSSE3
+	{"ssse3", RP_CPUFLAG_X86_SSSE3, bench_byte_swap_32_array_ssse3},
+#endif /* BYTESWAP_HAS_SSSE3 */
+#ifdef BYTESWAP_HAS_SSE2
+	{"sse2", RP_CPUFLAG_X86_SSE2, bench_byte_swap_32_array_sse2},
+#endif /* BYTESWAP_HAS_SSE2 */
+	{"c", 0, bench_byte_swap_32_array_c},
+};
+
+static const RP_SIMD_Kernel byte_swap_16_array_kernel = {
+	"__byte_swap_16_array", byte_swap_16_array_variants,
+	(unsigned int)ARRAY_SIZE(byte_swap_16_array_variants)
+};
+static const RP_SIMD_Kernel byte_swap_32_array_kernel = {
+	"__byte_swap_32_array", byte_swap_32_array_variants,
+	(unsigned int)ARRAY_SIZE(byte_swap_32_array_variants)
+};
+
+/**
+ * Register a SIMD kernel. (internal function)
+ * @param kernel Kernel.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int RP_SIMD_RegisterKernel_int(const RP_SIMD_Kernel *kernel)
+{
+	unsigned int i;
+
+	// Don't register the same kernel twice.
+	for (i = 0; i < rp_simd_kernel_count; i++) {
+		if (rp_simd_kernels[i] == kernel)
+			return 0;
+	}
+
+	assert(rp_simd_kernel_count < RP_SIMD_MAX_KERNELS);
+	if (rp_simd_kernel_count >= RP_SIMD_MAX_KERNELS)
+		return -ENOSPC;
+
+	rp_simd_kernels[rp_simd_kernel_count++] = kernel;
+	return 0;
+}
+
+/**
+ * Register the librpcpu kernels.
+ * Called by pthread_once().
+ */
+static void RP_SIMD_RegisterBuiltinKernels(void)
+{
+	RP_SIMD_RegisterKernel_int(&byte_swap_16_array_kernel);
+	RP_SIMD_RegisterKernel_int(&byte_swap_32_array_kernel);
+}
+
+/**
+ * Make sure the librpcpu kernels are registered.
+ */
+static FORCEINLINE void RP_SIMD_Init(void)
+{
+	static pthread_once_t once_control = PTHREAD_ONCE_INIT;
+	pthread_once(&once_control, RP_SIMD_RegisterBuiltinKernels);
+}
+
+/** Public functions **/
+
+/**
+ * Register a SIMD kernel.
+ * librpcpu's own kernels are registered automatically.
+ *
+ * NOTE: This function is not thread-safe. Kernels should be
+ * registered by the main thread during program startup.
+ *
+ * @param kernel Kernel. (must remain valid for the lifetime of the program)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RP_SIMD_RegisterKernel(const RP_SIMD_Kernel *kernel)
+{
+	assert(kernel != NULL);
+	assert(kernel->count > 0);
+	if (!kernel || !kernel->variants || kernel->count == 0)
+		return -EINVAL;
+
+	// Register the librpcpu kernels first so they're listed first.
+	RP_SIMD_Init();
+	return RP_SIMD_RegisterKernel_int(kernel);
+}
+
+/**
+ * Get the number of registered SIMD kernels.
+ * @return Number of registered SIMD kernels.
+ */
+unsigned int RP_SIMD_GetKernelCount(void)
+{
+	RP_SIMD_Init();
+	return rp_simd_kernel_count;
+}
+
+/**
+ * Get a registered SIMD kernel.
+ * @param idx Kernel index.
+ * @return Kernel, or NULL if idx is out of range.
+ */
+const RP_SIMD_Kernel *RP_SIMD_GetKernel(unsigned int idx)
+{
+	RP_SIMD_Init();
+	return (idx < rp_simd_kernel_count ? rp_simd_kernels[idx] : NULL);
+}
+
+/**
+ * Is a SIMD kernel variant supported on this CPU?
+ * This takes the RP_CPU_TIER override into account.
+ * @param variant Variant.
+ * @return Non-zero if supported; 0 if not.
+ */
+int RP_SIMD_IsVariantSupported(const RP_SIMD_Variant *variant)
+{
+	assert(variant != NULL);
+	if (!variant)
+		return 0;
+	if (variant->cpu_flags == 0) {
+		// No CPU flags are required.
+		return 1;
+	}
+
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+	if (unlikely(!RP_CPU_Flags_Init)) {
+		RP_CPU_InitCPUFlags();
+	}
+	return ((RP_CPU_Flags & variant->cpu_flags) == variant->cpu_flags);
+#else /* !(RP_CPU_I386 || RP_CPU_AMD64) */
+	// No runtime CPU flags on this architecture.
+	return 0;
+#endif /* RP_CPU_I386 || RP_CPU_AMD64 */
+}
+
+/**
+ * Get the variant of a SIMD kernel that the dispatch function selects.
+ * @param kernel Kernel.
+ * @return Selected variant, or NULL if no variants are supported.
+ */
+const RP_SIMD_Variant *RP_SIMD_GetSelectedVariant(const RP_SIMD_Kernel *kernel)
+{
+	unsigned int i;
+
+	assert(kernel != NULL);
+	if (!kernel)
+		return NULL;
+
+	for (i = 0; i < kernel->count; i++) {
+		if (RP_SIMD_IsVariantSupported(&kernel->variants[i]))
+			return &kernel->variants[i];
+	}
+	return NULL;
+}
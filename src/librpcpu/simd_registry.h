@@ -0,0 +1,106 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpcpu)                         *
+ * simd_registry.h: SIMD kernel registry.                                  *
+ *                                                                         *
+ * Copyright (c) 2020 by David Korth.                                      *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPCPU_SIMD_REGISTRY_H__
+#define __ROMPROPERTIES_LIBRPCPU_SIMD_REGISTRY_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The SIMD registry lists each kernel that has CPU-specific variants,
+ * e.g. __byte_swap_16_array() or ImageDecoder::fromLinear32().
+ *
+ * The registry does not perform dispatch itself. Each module keeps
+ * its own IFUNC resolver or inline dispatch function, and the variant
+ * list for each kernel must be in the same order as its dispatch
+ * function, so the first supported variant is the one that's used.
+ *
+ * All dispatch functions use the RP_CPU_Has*() functions, so the
+ * RP_CPU_TIER environment variable affects both the dispatch functions
+ * and the registry. (See RP_CPU_GetTierOverride().)
+ */
+
+// Size of the buffer passed to RP_SIMD_Variant::bench().
+#define RP_SIMD_BENCH_SIZE (256U*1024U)
+
+/**
+ * SIMD kernel variant.
+ */
+typedef struct _RP_SIMD_Variant {
+	const char *name;	// Variant name, e.g. "sse2"
+	uint32_t cpu_flags;	// Required CPU flags (RP_CPUFLAG_*), or 0 if none.
+
+	/**
+	 * Run this variant once for benchmarking.
+	 * The buffer contents are arbitrary and may be overwritten.
+	 * @param buf Buffer. (32-byte aligned)
+	 * @param size Size of buf. (RP_SIMD_BENCH_SIZE)
+	 */
+	void (*bench)(uint8_t *buf, size_t size);
+} RP_SIMD_Variant;
+
+/**
+ * SIMD kernel.
+ */
+typedef struct _RP_SIMD_Kernel {
+	const char *name;			// Kernel name, e.g. "ImageDecoder::fromLinear32"
+	const RP_SIMD_Variant *variants;	// Variants, in dispatch order.
+	unsigned int count;			// Number of variants.
+} RP_SIMD_Kernel;
+
+/**
+ * Register a SIMD kernel.
+ * librpcpu's own kernels are registered automatically.
+ *
+ * NOTE: This function is not thread-safe. Kernels should be
+ * registered by the main thread during program startup.
+ *
+ * @param kernel Kernel. (must remain valid for the lifetime of the program)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RP_SIMD_RegisterKernel(const RP_SIMD_Kernel *kernel);
+
+/**
+ * Get the number of registered SIMD kernels.
+ * @return Number of registered SIMD kernels.
+ */
+unsigned int RP_SIMD_GetKernelCount(void);
+
+/**
+ * Get a registered SIMD kernel.
+ * @param idx Kernel index.
+ * @return Kernel, or NULL if idx is out of range.
+ */
+const RP_SIMD_Kernel *RP_SIMD_GetKernel(unsigned int idx);
+
+/**
+ * Is a SIMD kernel variant supported on this CPU?
+ * This takes the RP_CPU_TIER override into account.
+ * @param variant Variant.
+ * @return Non-zero if supported; 0 if not.
+ */
+int RP_SIMD_IsVariantSupported(const RP_SIMD_Variant *variant);
+
+/**
+ * Get the variant of a SIMD kernel that the dispatch function selects.
+ * @param kernel Kernel.
+ * @return Selected variant, or NULL if no variants are supported.
+ */
+const RP_SIMD_Variant *RP_SIMD_GetSelectedVariant(const RP_SIMD_Kernel *kernel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROMPROPERTIES_LIBRPCPU_SIMD_REGISTRY_H__ */
@@ -17,6 +17,9 @@
 // C includes. (C++ namespace)
 #include <cstdio>
 
+// C++ includes.
+#include <chrono>
+
 namespace LibRpCpu { namespace Tests {
 
 class ByteswapTest : public ::testing::Test
@@ -52,6 +55,13 @@ class ByteswapTest : public ::testing::Test
 		void SetUp(void) final;
 		void TearDown(void) final;
 
+		/**
+		 * Print the throughput of the current benchmark.
+		 * @param bytes Number of bytes processed per iteration.
+		 * @param start Start time.
+		 */
+		static void printThroughput(size_t bytes, std::chrono::steady_clock::time_point start);
+
 	public:
 		// Temporary aligned memory buffer.
 		// Automatically freed in teardown().
@@ -91,6 +101,23 @@ void ByteswapTest::TearDown(void)
 	align_buf = nullptr;
 }
 
+/**
+ * Print the throughput of the current benchmark.
+ * @param bytes Number of bytes processed per iteration.
+ * @param start Start time.
+ */
+void ByteswapTest::printThroughput(size_t bytes, std::chrono::steady_clock::time_point start)
+{
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	if (elapsed.count() <= 0) {
+		return;
+	}
+	const double gbps = (static_cast<double>(bytes) * BENCHMARK_ITERATIONS) / elapsed.count() / 1e9;
+	const ::testing::TestInfo *const test_info =
+		::testing::UnitTest::GetInstance()->current_test_info();
+	fprintf(stderr, "*** %s: %.2f GB/s\n", test_info->name(), gbps);
+}
+
 /**
  * Test the individual byteswapping macros.
  */
@@ -150,7 +177,7 @@ TEST_F(ByteswapTest, nonHostEndianMacroTest)
 
 /**
  * Macro for testing a 16-bit byteswap function.
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2, neon; dispatch for the dispatch function)
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
  */
@@ -171,7 +198,7 @@ TEST_F(ByteswapTest, __byte_swap_16_array_##opt##_test) \
 
 /**
  * Macro for benchmarking a 16-bit byteswap function.
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2, neon; dispatch for the dispatch function)
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
  */
@@ -182,9 +209,11 @@ TEST_F(ByteswapTest, __byte_swap_16_array_##opt##_benchmark) \
 		fputs(errmsg, stderr); \
 		return; \
 	} \
+	const auto start = std::chrono::steady_clock::now(); \
 	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) { \
 		__byte_swap_16_array_##opt(reinterpret_cast<uint16_t*>(align_buf), ALIGN_BUF_SIZE); \
 	} \
+	printThroughput(ALIGN_BUF_SIZE, start); \
 }
 
 /**
@@ -193,7 +222,7 @@ TEST_F(ByteswapTest, __byte_swap_16_array_##opt##_benchmark) \
  * This version has data that is 16-bit aligned, but not 32-bit aligned,
  * and the block has an odd number of WORDs at the end.
  *
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2, neon; dispatch for the dispatch function)
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
  */
@@ -218,7 +247,7 @@ TEST_F(ByteswapTest, __byte_swap_16_array_unDWORD_##opt##_test) \
  * This version has data that is 16-bit aligned, but not 32-bit aligned,
  * and the block has an odd number of WORDs at the end.
  *
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2, neon; dispatch for the dispatch function)
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
  */
@@ -229,14 +258,16 @@ TEST_F(ByteswapTest, __byte_swap_16_array_unDWORD_##opt##_benchmark) \
 		fputs(errmsg, stderr); \
 		return; \
 	} \
+	const auto start = std::chrono::steady_clock::now(); \
 	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) { \
 		__byte_swap_16_array_##opt(reinterpret_cast<uint16_t*>(&align_buf[2]), ALIGN_BUF_SIZE-6); \
 	} \
+	printThroughput(ALIGN_BUF_SIZE-6, start); \
 }
 
 /**
  * Macro for testing a 32-bit byteswap function.
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2, neon; dispatch for the dispatch function)
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
  */
@@ -257,7 +288,7 @@ TEST_F(ByteswapTest, __byte_swap_32_array_##opt##_test) \
 
 /**
  * Macro for benchmarking a 32-bit byteswap function.
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2, neon; dispatch for the dispatch function)
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
  */
@@ -268,9 +299,11 @@ TEST_F(ByteswapTest, __byte_swap_32_array_##opt##_benchmark) \
 		fputs(errmsg, stderr); \
 		return; \
 	} \
+	const auto start = std::chrono::steady_clock::now(); \
 	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) { \
 		__byte_swap_32_array_##opt(reinterpret_cast<uint32_t*>(align_buf), ALIGN_BUF_SIZE); \
 	} \
+	printThroughput(ALIGN_BUF_SIZE, start); \
 }
 
 /**
@@ -279,7 +312,7 @@ TEST_F(ByteswapTest, __byte_swap_32_array_##opt##_benchmark) \
  * This version has data that is 32-bit aligned, but not 64-bit aligned,
  * and the block has an odd number of DWORDs at the end.
  *
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2, neon; dispatch for the dispatch function)
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
  */
@@ -304,7 +337,7 @@ TEST_F(ByteswapTest, __byte_swap_32_array_unQWORD_##opt##_test) \
  * This version has data that is 32-bit aligned, but not 64-bit aligned,
  * and the block has an odd number of DWORDs at the end.
  *
- * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3; dispatch for the dispatch function)
+ * @param opt		Byteswap function optimization. (c, mmx, sse2, ssse3, avx2, neon; dispatch for the dispatch function)
  * @param expr		Expression to check if this optimization can be used. (Use `true` for c.)
  * @param errmsg	Error message to display if the optimization cannot be used.
  */
@@ -315,9 +348,11 @@ TEST_F(ByteswapTest, __byte_swap_32_array_unQWORD_##opt##_benchmark) \
 		fputs(errmsg, stderr); \
 		return; \
 	} \
+	const auto start = std::chrono::steady_clock::now(); \
 	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) { \
 		__byte_swap_32_array_##opt(reinterpret_cast<uint32_t*>(&align_buf[4]), ALIGN_BUF_SIZE-8); \
 	} \
+	printThroughput(ALIGN_BUF_SIZE-8, start); \
 }
 
 // Standard tests.
@@ -366,8 +401,33 @@ DO_ARRAY_32_unQWORD_TEST	(ssse3, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported
 DO_ARRAY_32_unQWORD_BENCHMARK	(ssse3, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
 #endif /* BYTESWAP_HAS_SSSE3 */
 
+#ifdef BYTESWAP_HAS_AVX2
+// AVX2-optimized tests.
+DO_ARRAY_16_TEST		(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_BENCHMARK		(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_unDWORD_TEST	(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_unDWORD_BENCHMARK	(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_TEST		(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_BENCHMARK		(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_unQWORD_TEST	(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_unQWORD_BENCHMARK	(avx2, RP_CPU_HasAVX2(), "*** AVX2 is not supported on this CPU. Skipping test.\n")
+#endif /* BYTESWAP_HAS_AVX2 */
+
+#ifdef BYTESWAP_HAS_NEON
+// NEON-optimized tests.
+DO_ARRAY_16_TEST		(neon, true, "")
+DO_ARRAY_16_BENCHMARK		(neon, true, "")
+DO_ARRAY_16_unDWORD_TEST	(neon, true, "")
+DO_ARRAY_16_unDWORD_BENCHMARK	(neon, true, "")
+DO_ARRAY_32_TEST		(neon, true, "")
+DO_ARRAY_32_BENCHMARK		(neon, true, "")
+DO_ARRAY_32_unQWORD_TEST	(neon, true, "")
+DO_ARRAY_32_unQWORD_BENCHMARK	(neon, true, "")
+#endif /* BYTESWAP_HAS_NEON */
+
 // NOTE: Add more instruction sets to the #ifdef if other optimizations are added.
-#if defined(BYTESWAP_HAS_MMX) || defined(BYTESWAP_HAS_SSE2) || defined(BYTESWAP_HAS_SSSE3)
+#if defined(BYTESWAP_HAS_MMX) || defined(BYTESWAP_HAS_SSE2) || defined(BYTESWAP_HAS_SSSE3) || \
+    defined(BYTESWAP_HAS_AVX2) || defined(BYTESWAP_HAS_NEON)
 // Dispatch functions.
 DO_ARRAY_16_TEST		(dispatch, true, "")
 DO_ARRAY_16_BENCHMARK		(dispatch, true, "")
@@ -377,7 +437,7 @@ DO_ARRAY_32_TEST		(dispatch, true, "")
 DO_ARRAY_32_BENCHMARK		(dispatch, true, "")
 DO_ARRAY_32_unQWORD_TEST	(dispatch, true, "")
 DO_ARRAY_32_unQWORD_BENCHMARK	(dispatch, true, "")
-#endif /* BYTESWAP_HAS_MMX || BYTESWAP_HAS_SSE2 || BYTESWAP_HAS_SSSE3 */
+#endif /* BYTESWAP_HAS_MMX || BYTESWAP_HAS_SSE2 || BYTESWAP_HAS_SSSE3 || BYTESWAP_HAS_AVX2 || BYTESWAP_HAS_NEON */
 
 } }
 
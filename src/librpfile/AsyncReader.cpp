@@ -0,0 +1,492 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * AsyncReader.cpp: Asynchronous batch reads.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librpfile.h"
+#include "AsyncReader.hpp"
+#include "IRpFile.hpp"
+
+#ifdef HAVE_LIBURING
+// liburing
+#  include <liburing.h>
+#  include <sys/uio.h>
+
+// C++ includes.
+#  include <unordered_set>
+#endif /* HAVE_LIBURING */
+
+namespace LibRpFile {
+
+/** AsyncReaderPrivate **/
+
+class AsyncReaderPrivate
+{
+	public:
+		explicit AsyncReaderPrivate(unsigned int queueDepth);
+		~AsyncReaderPrivate();
+
+	private:
+		RP_DISABLE_COPY(AsyncReaderPrivate)
+
+	public:
+		/**
+		 * Read data synchronously, then call the callback.
+		 * @param file	[in] File to read from.
+		 * @param pos	[in] File position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @param callback [in] Completion callback.
+		 */
+		static void readSync(IRpFile *file, off64_t pos, void *ptr, size_t size,
+			const AsyncReader::ReadCallback &callback);
+
+#ifdef HAVE_LIBURING
+	public:
+		// Number of prepared requests to accumulate
+		// before submitting them to the kernel.
+		static const unsigned int SUBMIT_BATCH = 8;
+
+		/**
+		 * Read request.
+		 */
+		struct Request {
+			IRpFile *file;		// ref()'d until completion
+			int fd;			// file->nativeFd()
+			off64_t pos;		// Current file position.
+			struct iovec iov;	// Remaining output buffer.
+			size_t done;		// Number of bytes read so far.
+			AsyncReader::ReadCallback callback;
+		};
+
+		/**
+		 * Get a submission queue entry.
+		 * If the submission queue is full, the pending requests are submitted.
+		 * @return Submission queue entry, or nullptr on error.
+		 */
+		struct io_uring_sqe *getSqe(void);
+
+		/**
+		 * Prepare a submission queue entry for a request.
+		 * @param req Request.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int prepRequest(Request *req);
+
+		/**
+		 * Submit prepared requests and process completions.
+		 * @param block If true, wait for at least one completion.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int reap(bool block);
+
+		/**
+		 * Handle a completed request.
+		 * Short reads are resubmitted for the remaining data.
+		 * @param req Request.
+		 * @param res Completion result. (bytes read, or negative POSIX error code)
+		 */
+		void complete(Request *req, int res);
+
+	public:
+		struct io_uring ring;
+		bool ringInit;			// True if the ring was initialized.
+		unsigned int queueDepth;	// Maximum number of reads in flight.
+		unsigned int inFlight;		// Requests that haven't completed yet.
+		unsigned int unsubmitted;	// Prepared requests that haven't been submitted yet.
+
+		// Requests that haven't completed yet.
+		// Used by cancel() to find the requests to cancel.
+		std::unordered_set<Request*> requests;
+		unsigned int cancelsInFlight;	// Cancel requests that haven't completed yet.
+		bool cancelling;		// True while cancel() is running.
+#endif /* HAVE_LIBURING */
+};
+
+AsyncReaderPrivate::AsyncReaderPrivate(unsigned int queueDepth)
+#ifdef HAVE_LIBURING
+	: ringInit(false)
+	, queueDepth(queueDepth > 0 ? queueDepth : 1)
+	, inFlight(0)
+	, unsubmitted(0)
+	, cancelsInFlight(0)
+	, cancelling(false)
+#endif /* HAVE_LIBURING */
+{
+#ifdef HAVE_LIBURING
+	// NOTE: io_uring may be unavailable even if liburing is,
+	// e.g. older kernels or if it was disabled by a sysctl
+	// or a container's seccomp profile. Reads will be done
+	// synchronously in that case.
+	memset(&ring, 0, sizeof(ring));
+	ringInit = (io_uring_queue_init(this->queueDepth, &ring, 0) == 0);
+#else /* !HAVE_LIBURING */
+	RP_UNUSED(queueDepth);
+#endif /* HAVE_LIBURING */
+}
+
+AsyncReaderPrivate::~AsyncReaderPrivate()
+{
+#ifdef HAVE_LIBURING
+	if (ringInit) {
+		io_uring_queue_exit(&ring);
+	}
+#endif /* HAVE_LIBURING */
+}
+
+/**
+ * Read data synchronously, then call the callback.
+ * @param file	[in] File to read from.
+ * @param pos	[in] File position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @param callback [in] Completion callback.
+ */
+void AsyncReaderPrivate::readSync(IRpFile *file, off64_t pos, void *ptr, size_t size,
+	const AsyncReader::ReadCallback &callback)
+{
+	file->clearError();
+	const size_t sz_read = file->seekAndRead(pos, ptr, size);
+	const int lastError = file->lastError();
+	callback(sz_read, (sz_read != size && lastError != 0) ? -lastError : 0);
+}
+
+#ifdef HAVE_LIBURING
+/**
+ * Get a submission queue entry.
+ * If the submission queue is full, the pending requests are submitted.
+ * @return Submission queue entry, or nullptr on error.
+ */
+struct io_uring_sqe *AsyncReaderPrivate::getSqe(void)
+{
+	struct io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+	if (!sqe) {
+		// Submission queue is full. Submit the pending requests.
+		// NOTE: This shouldn't happen for reads, since inFlight
+		// is limited to the submission queue size.
+		const int ret = io_uring_submit(&ring);
+		if (ret < 0) {
+			return nullptr;
+		}
+		unsubmitted -= std::min(unsubmitted, static_cast<unsigned int>(ret));
+		sqe = io_uring_get_sqe(&ring);
+	}
+	return sqe;
+}
+
+/**
+ * Prepare a submission queue entry for a request.
+ * @param req Request.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AsyncReaderPrivate::prepRequest(Request *req)
+{
+	struct io_uring_sqe *const sqe = getSqe();
+	if (!sqe) {
+		return -EBUSY;
+	}
+
+	// NOTE: Using readv() instead of read(), since
+	// IORING_OP_READ requires Linux 5.6.
+	io_uring_prep_readv(sqe, req->fd, &req->iov, 1, req->pos);
+	io_uring_sqe_set_data(sqe, req);
+	inFlight++;
+	unsubmitted++;
+	return 0;
+}
+
+/**
+ * Submit prepared requests and process completions.
+ * @param block If true, wait for at least one completion.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AsyncReaderPrivate::reap(bool block)
+{
+	int ret;
+	if (unsubmitted > 0) {
+		ret = io_uring_submit(&ring);
+		if (ret < 0) {
+			return ret;
+		}
+		unsubmitted -= std::min(unsubmitted, static_cast<unsigned int>(ret));
+	}
+
+	struct io_uring_cqe *cqe;
+	do {
+		ret = (block ? io_uring_wait_cqe(&ring, &cqe) : io_uring_peek_cqe(&ring, &cqe));
+	} while (ret == -EINTR);
+
+	while (ret == 0) {
+		Request *const req = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+		const int res = cqe->res;
+		io_uring_cqe_seen(&ring, cqe);
+		if (req) {
+			inFlight--;
+			complete(req, res);
+		} else {
+			// Cancel request from cancel().
+			cancelsInFlight--;
+		}
+
+		ret = io_uring_peek_cqe(&ring, &cqe);
+	}
+
+	// io_uring_peek_cqe() returns -EAGAIN if there are no more completions.
+	return (ret == -EAGAIN ? 0 : ret);
+}
+
+/**
+ * Handle a completed request.
+ * Short reads are resubmitted for the remaining data.
+ * @param req Request.
+ * @param res Completion result. (bytes read, or negative POSIX error code)
+ */
+void AsyncReaderPrivate::complete(Request *req, int res)
+{
+	bool retry = (res == -EAGAIN || res == -EINTR);
+	if (res > 0) {
+		req->done += res;
+		req->pos += res;
+		req->iov.iov_base = static_cast<uint8_t*>(req->iov.iov_base) + res;
+		req->iov.iov_len -= res;
+		retry = (req->iov.iov_len > 0);
+		res = 0;
+	}
+
+	if (retry) {
+		// Short read or interrupted read. Read the rest of the data.
+		// If this was at EOF, the next read will return 0.
+		// NOTE: Reads aren't resubmitted while cancelling.
+		if (cancelling) {
+			res = -ECANCELED;
+		} else if (prepRequest(req) == 0) {
+			return;
+		} else {
+			res = -EIO;
+		}
+	}
+
+	requests.erase(req);
+	req->callback(req->done, res);
+	req->file->unref();
+	delete req;
+}
+#endif /* HAVE_LIBURING */
+
+/** AsyncReader **/
+
+/**
+ * Asynchronous batch reader.
+ *
+ * Reads from many files can be queued up front, and are
+ * completed out of order as the data becomes available.
+ * This is intended for batch workloads, e.g. RomData
+ * detection for a large number of files, where keeping
+ * many reads in flight hides the per-read latency.
+ *
+ * On Linux, io_uring is used if liburing is available
+ * and the kernel supports it. Otherwise, reads are done
+ * synchronously when they're queued.
+ *
+ * NOTE: AsyncReader is not thread-safe. Use a separate
+ * AsyncReader for each thread.
+ *
+ * @param queueDepth Maximum number of reads in flight.
+ */
+AsyncReader::AsyncReader(unsigned int queueDepth)
+	: d_ptr(new AsyncReaderPrivate(queueDepth))
+{ }
+
+AsyncReader::~AsyncReader()
+{
+	// Make sure all callbacks have been called
+	// before the ring is torn down.
+	wait();
+	delete d_ptr;
+}
+
+/**
+ * Are reads actually asynchronous?
+ * If false, read() completes each read before returning.
+ * @return True if asynchronous; false if emulated.
+ */
+bool AsyncReader::isAsync(void) const
+{
+#ifdef HAVE_LIBURING
+	RP_D(const AsyncReader);
+	return d->ringInit;
+#else /* !HAVE_LIBURING */
+	return false;
+#endif /* HAVE_LIBURING */
+}
+
+/**
+ * Queue a read request.
+ *
+ * If the file doesn't support direct reads, or if reads
+ * aren't asynchronous, the data is read immediately and
+ * the callback is called before this function returns.
+ * Otherwise, the callback is called by a later call to
+ * read() or wait() once the read has completed.
+ *
+ * The file is ref()'d until the read has completed.
+ * The file position is undefined afterwards.
+ *
+ * NOTE: Callbacks must not call read() or wait().
+ *
+ * @param file	[in] File to read from.
+ * @param pos	[in] File position.
+ * @param ptr	[out] Output data buffer. (must remain valid until the callback is called)
+ * @param size	[in] Amount of data to read, in bytes.
+ * @param callback [in] Completion callback.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AsyncReader::read(IRpFile *file, off64_t pos, void *ptr, size_t size, const ReadCallback &callback)
+{
+	assert(file != nullptr);
+	assert(ptr != nullptr || size == 0);
+	assert(callback);
+	if (!file || (!ptr && size > 0) || !callback) {
+		return -EINVAL;
+	} else if (size == 0) {
+		// Nothing to read.
+		callback(0, 0);
+		return 0;
+	}
+
+	RP_D(AsyncReader);
+#ifdef HAVE_LIBURING
+	const int fd = (d->ringInit ? file->nativeFd() : -1);
+	if (fd < 0) {
+		// Direct reads aren't supported.
+		d->readSync(file, pos, ptr, size, callback);
+		return 0;
+	}
+
+	// Make sure there's room for another request.
+	while (d->inFlight >= d->queueDepth) {
+		const int ret = d->reap(true);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	AsyncReaderPrivate::Request *const req = new AsyncReaderPrivate::Request;
+	req->file = file->ref();
+	req->fd = fd;
+	req->pos = pos;
+	req->iov.iov_base = ptr;
+	req->iov.iov_len = size;
+	req->done = 0;
+	req->callback = callback;
+
+	int ret = d->prepRequest(req);
+	if (ret != 0) {
+		req->file->unref();
+		delete req;
+		return ret;
+	}
+	d->requests.insert(req);
+
+	// Submit requests in batches to reduce the number of syscalls.
+	// Completions that are already available are processed here
+	// so the completion queue doesn't fill up.
+	if (d->unsubmitted >= AsyncReaderPrivate::SUBMIT_BATCH) {
+		ret = d->reap(false);
+	}
+	return ret;
+#else /* !HAVE_LIBURING */
+	d->readSync(file, pos, ptr, size, callback);
+	return 0;
+#endif /* HAVE_LIBURING */
+}
+
+/**
+ * Wait for all queued reads to complete.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AsyncReader::wait(void)
+{
+#ifdef HAVE_LIBURING
+	RP_D(AsyncReader);
+	while (d->inFlight > 0) {
+		const int ret = d->reap(true);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+#endif /* HAVE_LIBURING */
+	return 0;
+}
+
+/**
+ * Cancel all queued reads.
+ *
+ * Reads that haven't completed yet are cancelled if possible,
+ * and their callbacks are called with -ECANCELED. Reads that
+ * are already in progress may still complete normally.
+ *
+ * All callbacks have been called when this function returns.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AsyncReader::cancel(void)
+{
+#ifdef HAVE_LIBURING
+	RP_D(AsyncReader);
+	if (d->inFlight == 0) {
+		// Nothing to cancel.
+		return 0;
+	}
+
+	// Queue a cancel request for each read.
+	// NOTE: Cancel requests don't count towards inFlight.
+	d->cancelling = true;
+	int ret = 0;
+	for (AsyncReaderPrivate::Request *req : d->requests) {
+		struct io_uring_sqe *const sqe = d->getSqe();
+		if (!sqe) {
+			// Unable to cancel the rest of the reads.
+			// They'll be waited for instead.
+			break;
+		}
+		io_uring_prep_cancel(sqe, req, 0);
+		io_uring_sqe_set_data(sqe, nullptr);
+		d->cancelsInFlight++;
+		d->unsubmitted++;
+	}
+
+	// Wait for the reads and cancel requests to complete.
+	while (d->inFlight > 0 || d->cancelsInFlight > 0) {
+		ret = d->reap(true);
+		if (ret < 0) {
+			break;
+		}
+	}
+	d->cancelling = false;
+	return ret;
+#else /* !HAVE_LIBURING */
+	// Reads are completed when they're queued.
+	return 0;
+#endif /* HAVE_LIBURING */
+}
+
+/**
+ * Get the number of reads that haven't completed yet.
+ * @return Number of pending reads.
+ */
+unsigned int AsyncReader::pending(void) const
+{
+#ifdef HAVE_LIBURING
+	RP_D(const AsyncReader);
+	return d->inFlight;
+#else /* !HAVE_LIBURING */
+	return 0;
+#endif /* HAVE_LIBURING */
+}
+
+}
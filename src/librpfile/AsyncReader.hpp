@@ -0,0 +1,132 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * AsyncReader.hpp: Asynchronous batch reads.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_ASYNCREADER_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_ASYNCREADER_HPP__
+
+// C includes.
+#include <stdint.h>
+#include <sys/types.h>	/* for off64_t */
+
+// C includes. (C++ namespace)
+#include <cstddef>	/* for size_t */
+
+// C++ includes.
+#include <functional>
+
+// common macros
+#include "common.h"
+
+namespace LibRpFile {
+
+class IRpFile;
+
+class AsyncReaderPrivate;
+class AsyncReader
+{
+	public:
+		/**
+		 * Default maximum number of reads in flight.
+		 */
+		static const unsigned int DEFAULT_QUEUE_DEPTH = 64;
+
+		/**
+		 * Read completion callback.
+		 * @param size	[in] Number of bytes read. (less than requested on EOF or error)
+		 * @param err	[in] 0 on success; negative POSIX error code on error.
+		 */
+		typedef std::function<void(size_t size, int err)> ReadCallback;
+
+		/**
+		 * Asynchronous batch reader.
+		 *
+		 * Reads from many files can be queued up front, and are
+		 * completed out of order as the data becomes available.
+		 * This is intended for batch workloads, e.g. RomData
+		 * detection for a large number of files, where keeping
+		 * many reads in flight hides the per-read latency.
+		 *
+		 * On Linux, io_uring is used if liburing is available
+		 * and the kernel supports it. Otherwise, reads are done
+		 * synchronously when they're queued.
+		 *
+		 * NOTE: AsyncReader is not thread-safe. Use a separate
+		 * AsyncReader for each thread.
+		 *
+		 * @param queueDepth Maximum number of reads in flight.
+		 */
+		explicit AsyncReader(unsigned int queueDepth = DEFAULT_QUEUE_DEPTH);
+		~AsyncReader();
+
+	private:
+		RP_DISABLE_COPY(AsyncReader)
+	protected:
+		friend class AsyncReaderPrivate;
+		AsyncReaderPrivate *const d_ptr;
+
+	public:
+		/**
+		 * Are reads actually asynchronous?
+		 * If false, read() completes each read before returning.
+		 * @return True if asynchronous; false if emulated.
+		 */
+		bool isAsync(void) const;
+
+		/**
+		 * Queue a read request.
+		 *
+		 * If the file doesn't support direct reads, or if reads
+		 * aren't asynchronous, the data is read immediately and
+		 * the callback is called before this function returns.
+		 * Otherwise, the callback is called by a later call to
+		 * read() or wait() once the read has completed.
+		 *
+		 * The file is ref()'d until the read has completed.
+		 * The file position is undefined afterwards.
+		 *
+		 * NOTE: Callbacks must not call read() or wait().
+		 *
+		 * @param file	[in] File to read from.
+		 * @param pos	[in] File position.
+		 * @param ptr	[out] Output data buffer. (must remain valid until the callback is called)
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @param callback [in] Completion callback.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 4, 5)
+		int read(IRpFile *file, off64_t pos, void *ptr, size_t size, const ReadCallback &callback);
+
+		/**
+		 * Wait for all queued reads to complete.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int wait(void);
+
+		/**
+		 * Cancel all queued reads.
+		 *
+		 * Reads that haven't completed yet are cancelled if possible,
+		 * and their callbacks are called with -ECANCELED. Reads that
+		 * are already in progress may still complete normally.
+		 *
+		 * All callbacks have been called when this function returns.
+		 *
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int cancel(void);
+
+		/**
+		 * Get the number of reads that haven't completed yet.
+		 * @return Number of pending reads.
+		 */
+		unsigned int pending(void) const;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_ASYNCREADER_HPP__ */
@@ -0,0 +1,357 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * CachedFile.cpp: Read cache wrapper for slow IRpFile subclasses.         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "CachedFile.hpp"
+
+// C++ STL classes.
+using std::string;
+using std::unique_ptr;
+
+namespace LibRpFile {
+
+/**
+ * Wrap an IRpFile with a read cache.
+ *
+ * Data is read from the underlying file in pages, and the
+ * most recently used pages are kept in memory. This is
+ * intended for files with a high per-request overhead,
+ * e.g. files on network shares accessed using GIO or KIO,
+ * where RomDataFactory and the RomData subclasses would
+ * otherwise make a round trip for every small read.
+ *
+ * The resulting IRpFile is read-only.
+ *
+ * @param file Underlying file.
+ * @param params Cache parameters.
+ */
+CachedFile::CachedFile(IRpFile *file, const CacheParams &params)
+	: super()
+	, m_file(nullptr)
+	, m_params(params)
+	, m_size(0)
+	, m_pos(0)
+	, m_useCounter(0)
+	, m_lastLoaded(-2)
+{
+	assert(file != nullptr);
+	if (!file) {
+		// File is missing.
+		m_lastError = EBADF;
+		return;
+	}
+
+	// Sanity checks for the cache parameters.
+	if (m_params.pageSize < 512) {
+		m_params.pageSize = 512;
+	}
+	if (m_params.maxPages < 1) {
+		m_params.maxPages = 1;
+	}
+	if (m_params.readAhead >= m_params.maxPages) {
+		// Make sure read-ahead doesn't evict the requested page.
+		m_params.readAhead = m_params.maxPages - 1;
+	}
+
+	m_file = file->ref();
+	m_size = file->size();
+	m_isCompressed = file->isCompressed();
+	m_pages.reserve(m_params.maxPages);
+}
+
+CachedFile::~CachedFile()
+{
+	UNREF(m_file);
+}
+
+/**
+ * Is the file open?
+ * This usually only returns false if an error occurred.
+ * @return True if the file is open; false if it isn't.
+ */
+bool CachedFile::isOpen(void) const
+{
+	return (m_file != nullptr && m_file->isOpen());
+}
+
+/**
+ * Close the file.
+ */
+void CachedFile::close(void)
+{
+	UNREF_AND_NULL(m_file);
+	m_pages.clear();
+	m_size = 0;
+	m_pos = 0;
+}
+
+/**
+ * Find a page in the cache.
+ * @param index Page index.
+ * @return Page, or nullptr if it isn't cached.
+ */
+CachedFile::Page *CachedFile::findPage(off64_t index)
+{
+	// NOTE: The cache is small, so a linear search is fine.
+	for (Page &page : m_pages) {
+		if (page.index == index) {
+			page.lastUse = ++m_useCounter;
+			return &page;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * Read pages from the underlying file into the cache.
+ * @param index First page index.
+ * @param count Number of pages.
+ * @return First page, or nullptr on error.
+ */
+CachedFile::Page *CachedFile::loadPages(off64_t index, unsigned int count)
+{
+	assert(count >= 1);
+	const size_t pageSize = m_params.pageSize;
+	const off64_t pos = index * static_cast<off64_t>(pageSize);
+
+	// Don't read past EOF, and don't reload pages that are already cached.
+	const off64_t lastIndex = (m_size + static_cast<off64_t>(pageSize) - 1) / static_cast<off64_t>(pageSize);
+	if (index + static_cast<off64_t>(count) > lastIndex) {
+		count = static_cast<unsigned int>(std::max<off64_t>(lastIndex - index, 1));
+	}
+	for (unsigned int i = 1; i < count; i++) {
+		if (findPage(index + i) != nullptr) {
+			count = i;
+			break;
+		}
+	}
+
+	// Read all of the pages using a single request.
+	unique_ptr<uint8_t[]> buf(new uint8_t[pageSize * count]);
+	const size_t sz_read = m_file->seekAndRead(pos, buf.get(), pageSize * count);
+	m_lastError = m_file->lastError();
+	if (sz_read == 0) {
+		// Read error.
+		return nullptr;
+	}
+	m_lastLoaded = index + ((sz_read - 1) / pageSize);
+
+	Page *first = nullptr;
+	for (unsigned int i = 0; i < count && (i * pageSize) < sz_read; i++) {
+		// Find a slot for the page.
+		// If the cache is full, the least-recently-used page is replaced.
+		Page *page;
+		if (m_pages.size() < m_params.maxPages) {
+			m_pages.emplace_back();
+			page = &m_pages.back();
+			page->data.reset(new uint8_t[pageSize]);
+		} else {
+			page = &m_pages[0];
+			for (Page &p : m_pages) {
+				if (p.lastUse < page->lastUse) {
+					page = &p;
+				}
+			}
+		}
+
+		page->index = index + i;
+		page->size = std::min(pageSize, sz_read - (i * pageSize));
+		page->lastUse = ++m_useCounter;
+		memcpy(page->data.get(), &buf[i * pageSize], page->size);
+		if (i == 0) {
+			first = page;
+		}
+	}
+	return first;
+}
+
+/**
+ * Read data from the file.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t CachedFile::read(void *ptr, size_t size)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	// Don't read past EOF.
+	if (m_pos >= m_size) {
+		return 0;
+	} else if (m_pos + static_cast<off64_t>(size) > m_size) {
+		size = static_cast<size_t>(m_size - m_pos);
+	}
+	if (unlikely(size == 0)) {
+		// Not reading anything...
+		return 0;
+	}
+
+	const size_t pageSize = m_params.pageSize;
+	if (size >= pageSize * (m_params.readAhead + 1)) {
+		// Large read. Bypass the cache so it doesn't
+		// evict the pages that are likely to be reused.
+		const size_t sz_read = m_file->seekAndRead(m_pos, ptr, size);
+		m_lastError = m_file->lastError();
+		m_pos += sz_read;
+		return sz_read;
+	}
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t sz_total = 0;
+	while (size > 0) {
+		const off64_t index = m_pos / static_cast<off64_t>(pageSize);
+		Page *page = findPage(index);
+		if (!page) {
+			// Page isn't cached.
+			// If this continues a sequential read, read ahead.
+			const unsigned int count = (index == m_lastLoaded + 1)
+				? (m_params.readAhead + 1) : 1;
+			page = loadPages(index, count);
+			if (!page) {
+				// Read error.
+				break;
+			}
+		}
+
+		const size_t offset = static_cast<size_t>(m_pos - (index * static_cast<off64_t>(pageSize)));
+		if (offset >= page->size) {
+			// Short page. (EOF)
+			break;
+		}
+		const size_t sz_copy = std::min(size, page->size - offset);
+		memcpy(ptr8, &page->data[offset], sz_copy);
+		ptr8 += sz_copy;
+		size -= sz_copy;
+		sz_total += sz_copy;
+		m_pos += sz_copy;
+	}
+
+	return sz_total;
+}
+
+/**
+ * Write data to the file.
+ * (NOTE: Not valid for CachedFile; this will always return 0.)
+ * @param ptr Input data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes written.
+ */
+size_t CachedFile::write(const void *ptr, size_t size)
+{
+	// Not a valid operation for CachedFile.
+	RP_UNUSED(ptr);
+	RP_UNUSED(size);
+	m_lastError = EBADF;
+	return 0;
+}
+
+/**
+ * Set the file position.
+ * @param pos File position.
+ * @return 0 on success; -1 on error.
+ */
+int CachedFile::seek(off64_t pos)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	if (pos <= 0) {
+		m_pos = 0;
+	} else if (pos >= m_size) {
+		m_pos = m_size;
+	} else {
+		m_pos = pos;
+	}
+
+	return 0;
+}
+
+/**
+ * Get the file position.
+ * @return File position, or -1 on error.
+ */
+off64_t CachedFile::tell(void)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_pos;
+}
+
+/**
+ * Truncate the file.
+ * (NOTE: Not valid for CachedFile; this will always return -1.)
+ * @param size New size. (default is 0)
+ * @return 0 on success; -1 on error.
+ */
+int CachedFile::truncate(off64_t size)
+{
+	// Not supported.
+	RP_UNUSED(size);
+	m_lastError = ENOTSUP;
+	return -1;
+}
+
+/** File properties **/
+
+/**
+ * Get the file size.
+ * @return File size, or negative on error.
+ */
+off64_t CachedFile::size(void)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_size;
+}
+
+/**
+ * Get the filename.
+ * @return Filename. (May be empty if the filename is not available.)
+ */
+string CachedFile::filename(void) const
+{
+	return (m_file ? m_file->filename() : string());
+}
+
+/** Access pattern hints **/
+
+/**
+ * Advise the file of the expected access pattern.
+ * The hint is passed through to the underlying file.
+ * @param pattern Access pattern.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CachedFile::adviseAccess(AccessPattern pattern)
+{
+	return (m_file ? m_file->adviseAccess(pattern) : -EBADF);
+}
+
+/**
+ * Hint that the specified ranges will be read soon.
+ * The ranges are passed through to the underlying file.
+ * @param ranges	[in] File ranges.
+ * @param count		[in] Number of ranges.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CachedFile::prefetchv(const Range *ranges, size_t count)
+{
+	return (m_file ? m_file->prefetchv(ranges, count) : -EBADF);
+}
+
+}
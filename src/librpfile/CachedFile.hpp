@@ -0,0 +1,189 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * CachedFile.hpp: Read cache wrapper for slow IRpFile subclasses.         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_CACHEDFILE_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_CACHEDFILE_HPP__
+
+#include "IRpFile.hpp"
+
+// C++ includes.
+#include <memory>
+#include <vector>
+
+namespace LibRpFile {
+
+class CachedFile final : public IRpFile
+{
+	public:
+		/**
+		 * Cache parameters.
+		 */
+		struct CacheParams {
+			size_t pageSize;		// Page size, in bytes.
+			unsigned int readAhead;		// Pages to read ahead on sequential reads.
+			unsigned int maxPages;		// Maximum number of cached pages.
+
+			CacheParams()
+				: pageSize(64*1024)
+				, readAhead(3)
+				, maxPages(32)
+			{ }
+		};
+
+		/**
+		 * Wrap an IRpFile with a read cache.
+		 *
+		 * Data is read from the underlying file in pages, and the
+		 * most recently used pages are kept in memory. This is
+		 * intended for files with a high per-request overhead,
+		 * e.g. files on network shares accessed using GIO or KIO,
+		 * where RomDataFactory and the RomData subclasses would
+		 * otherwise make a round trip for every small read.
+		 *
+		 * The resulting IRpFile is read-only.
+		 *
+		 * @param file Underlying file.
+		 * @param params Cache parameters.
+		 */
+		explicit CachedFile(IRpFile *file, const CacheParams &params = CacheParams());
+	protected:
+		virtual ~CachedFile();	// call unref() instead
+
+	private:
+		typedef IRpFile super;
+		RP_DISABLE_COPY(CachedFile)
+
+	public:
+		/**
+		 * Is the file open?
+		 * This usually only returns false if an error occurred.
+		 * @return True if the file is open; false if it isn't.
+		 */
+		bool isOpen(void) const final;
+
+		/**
+		 * Close the file.
+		 */
+		void close(void) final;
+
+		/**
+		 * Read data from the file.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 2, 3)
+		size_t read(void *ptr, size_t size) final;
+
+		/**
+		 * Write data to the file.
+		 * (NOTE: Not valid for CachedFile; this will always return 0.)
+		 * @param ptr Input data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes written.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		size_t write(const void *ptr, size_t size) final;
+
+		/**
+		 * Set the file position.
+		 * @param pos File position.
+		 * @return 0 on success; -1 on error.
+		 */
+		int seek(off64_t pos) final;
+
+		/**
+		 * Get the file position.
+		 * @return File position, or -1 on error.
+		 */
+		off64_t tell(void) final;
+
+		/**
+		 * Truncate the file.
+		 * (NOTE: Not valid for CachedFile; this will always return -1.)
+		 * @param size New size. (default is 0)
+		 * @return 0 on success; -1 on error.
+		 */
+		int truncate(off64_t size = 0) final;
+
+	public:
+		/** File properties **/
+
+		/**
+		 * Get the file size.
+		 * @return File size, or negative on error.
+		 */
+		off64_t size(void) final;
+
+		/**
+		 * Get the filename.
+		 * @return Filename. (May be empty if the filename is not available.)
+		 */
+		std::string filename(void) const final;
+
+	public:
+		/** Access pattern hints **/
+
+		/**
+		 * Advise the file of the expected access pattern.
+		 * The hint is passed through to the underlying file.
+		 * @param pattern Access pattern.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int adviseAccess(AccessPattern pattern) final;
+
+		/**
+		 * Hint that the specified ranges will be read soon.
+		 * The ranges are passed through to the underlying file.
+		 * @param ranges	[in] File ranges.
+		 * @param count		[in] Number of ranges.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int prefetchv(const Range *ranges, size_t count) final;
+
+	private:
+		/**
+		 * Cached page.
+		 */
+		struct Page {
+			off64_t index;			// Page index. (position / pageSize)
+			size_t size;			// Valid data, in bytes. (may be less than pageSize at EOF)
+			uint64_t lastUse;		// Last use counter, for LRU eviction.
+			std::unique_ptr<uint8_t[]> data;
+		};
+
+		/**
+		 * Find a page in the cache.
+		 * @param index Page index.
+		 * @return Page, or nullptr if it isn't cached.
+		 */
+		Page *findPage(off64_t index);
+
+		/**
+		 * Read pages from the underlying file into the cache.
+		 * @param index First page index.
+		 * @param count Number of pages.
+		 * @return First page, or nullptr on error.
+		 */
+		Page *loadPages(off64_t index, unsigned int count);
+
+	private:
+		IRpFile *m_file;
+		CacheParams m_params;
+		off64_t m_size;		// File size.
+		off64_t m_pos;		// Current position.
+
+		std::vector<Page> m_pages;
+		uint64_t m_useCounter;
+		off64_t m_lastLoaded;	// Index of the last page loaded. (for sequential read detection)
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_CACHEDFILE_HPP__ */
@@ -39,6 +39,12 @@ DualFile::DualFile(IRpFile *file0, IRpFile *file1)
 	m_size[1] = file1->size();
 
 	m_fullSize = m_size[0] + m_size[1];
+
+	// Prefetch the headers.
+	for (int i = 0; i < 2; i++) {
+		const size_t sz = static_cast<size_t>(std::min<off64_t>(m_size[i], sizeof(m_header[i])));
+		m_headerSize[i] = (sz > 0 ? m_file[i]->seekAndRead(0, m_header[i], sz) : 0);
+	}
 }
 
 /**
@@ -54,6 +60,8 @@ DualFile::DualFile()
 	m_file[1] = nullptr;
 	m_size[0] = 0;
 	m_size[1] = 0;
+	m_headerSize[0] = 0;
+	m_headerSize[1] = 0;
 }
 
 DualFile::~DualFile()
@@ -82,6 +90,8 @@ void DualFile::close(void)
 
 	m_size[0] = 0;
 	m_size[1] = 0;
+	m_headerSize[0] = 0;
+	m_headerSize[1] = 0;
 
 	m_pos = 0;
 }
@@ -110,8 +120,7 @@ size_t DualFile::read(void *ptr, size_t size)
 	// Check if the read is fully within file 0.
 	if (m_pos < m_size[0] && ((m_pos + static_cast<off64_t>(size)) < m_size[0])) {
 		// Read is fully within file 0.
-		const size_t sz_read = m_file[0]->seekAndRead(m_pos, ptr8, size);
-		m_lastError = m_file[0]->lastError();
+		const size_t sz_read = readPart(0, m_pos, ptr8, size);
 		m_pos += sz_read;
 		return sz_read;
 	}
@@ -120,8 +129,7 @@ size_t DualFile::read(void *ptr, size_t size)
 	if (m_pos >= m_size[0]) {
 		// Fully within file 1.
 		// NOTE: If the size is past the bounds, the read will be truncated.
-		const size_t sz_read = m_file[1]->seekAndRead(m_pos - m_size[0], ptr8, size);
-		m_lastError = m_file[1]->lastError();
+		const size_t sz_read = readPart(1, m_pos - m_size[0], ptr8, size);
 		m_pos += sz_read;
 		return sz_read;
 	}
@@ -130,8 +138,7 @@ size_t DualFile::read(void *ptr, size_t size)
 
 	// File 0 portion.
 	const size_t file0_sz = m_size[0] - m_pos;
-	size_t sz0_read = m_file[0]->seekAndRead(m_pos, ptr8, file0_sz);
-	m_lastError = m_file[0]->lastError();
+	size_t sz0_read = readPart(0, m_pos, ptr8, file0_sz);
 	m_pos += sz0_read;
 	if (sz0_read != file0_sz) {
 		// Short read.
@@ -141,13 +148,36 @@ size_t DualFile::read(void *ptr, size_t size)
 	ptr8 += sz0_read;
 
 	// File 1 portion.
-	size_t sz1_read = m_file[1]->seekAndRead(0, ptr8, size);
-	m_lastError = m_file[1]->lastError();
+	size_t sz1_read = readPart(1, 0, ptr8, size);
 	m_pos += sz1_read;
 
 	return (sz0_read + sz1_read);
 }
 
+/**
+ * Read data from one of the two files.
+ * Reads within the prefetched headers don't access the files.
+ * @param idx File index. (0 or 1)
+ * @param pos Position within the file.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t DualFile::readPart(int idx, off64_t pos, uint8_t *ptr, size_t size)
+{
+	assert(idx == 0 || idx == 1);
+	if (pos >= 0 && pos + static_cast<off64_t>(size) <= static_cast<off64_t>(m_headerSize[idx])) {
+		// Read is fully within the prefetched header.
+		memcpy(ptr, &m_header[idx][pos], size);
+		m_lastError = 0;
+		return size;
+	}
+
+	const size_t sz_read = m_file[idx]->seekAndRead(pos, ptr, size);
+	m_lastError = m_file[idx]->lastError();
+	return sz_read;
+}
+
 /**
  * Write data to the file.
  * (NOTE: Not valid for DualFile; this will always return 0.)
@@ -105,11 +105,29 @@ class DualFile final : public IRpFile
 		 */
 		std::string filename(void) const final;
 
+	private:
+		/**
+		 * Read data from one of the two files.
+		 * Reads within the prefetched headers don't access the files.
+		 * @param idx File index. (0 or 1)
+		 * @param pos Position within the file.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t readPart(int idx, off64_t pos, uint8_t *ptr, size_t size);
+
 	protected:
 		IRpFile *m_file[2];
 		off64_t m_size[2];
 		off64_t m_fullSize;	// Combined sizes.
 		off64_t m_pos;		// Current position.
+
+		// Prefetched headers.
+		// RomData subclasses usually read the headers of
+		// both files, so these are read up front.
+		uint8_t m_header[2][1024];
+		size_t m_headerSize[2];
 };
 
 }
@@ -38,6 +38,7 @@
 
 // C++ includes.
 #include <string>
+#include <vector>
 
 namespace LibRpFile { namespace FileSystem {
 
@@ -179,6 +180,50 @@ bool isOnBadFS(const char *filename, bool netFS = false);
  */
 int get_file_size_and_mtime(const std::string &filename, off64_t *pFileSize, time_t *pMtime);
 
+/**
+ * File identity.
+ * Used to determine if two filenames refer to the same
+ * file, and if the file has been modified.
+ */
+struct FileId {
+	uint64_t dev;		// Device ID (Windows: volume serial number)
+	uint64_t ino;		// Inode number (Windows: file index)
+	off64_t size;		// File size
+	int64_t mtime_ns;	// Modification time, in nanoseconds (Windows: FILETIME)
+
+	inline bool operator==(const FileId &other) const
+	{
+		return (dev == other.dev && ino == other.ino &&
+		        size == other.size && mtime_ns == other.mtime_ns);
+	}
+};
+
+/**
+ * Get a file's identity.
+ * @param filename	[in] Filename.
+ * @param pFileId	[out] File identity.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int get_file_id(const std::string &filename, FileId *pFileId);
+
+/**
+ * Get the number of hard links to a file.
+ * @param filename Filename.
+ * @return Number of hard links, or negative POSIX error code on error.
+ */
+int get_link_count(const std::string &filename);
+
+/**
+ * Get the names of the regular files in a directory.
+ * Subdirectories and the "." and ".." entries are skipped.
+ * @param dirname	[in] Directory name.
+ * @param vEntries	[out] Filenames. (not including the directory)
+ * @param pvSubdirs	[out,opt] If specified, subdirectory names are stored here.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int read_dir(const std::string &dirname, std::vector<std::string> &vEntries,
+	std::vector<std::string> *pvSubdirs = nullptr);
+
 } }
 
 #endif /* __ROMPROPERTIES_LIBRPFILE_FILESYSTEM_HPP__ */
@@ -11,6 +11,7 @@
 #include "FileSystem.hpp"
 
 // C includes.
+#include <dirent.h>
 #include <fcntl.h>	// AT_FDCWD
 #include <sys/stat.h>	// stat(), statx()
 #include <utime.h>
@@ -44,6 +45,7 @@
 // C++ STL classes.
 using std::string;
 using std::u16string;
+using std::vector;
 
 namespace LibRpFile { namespace FileSystem {
 
@@ -404,4 +406,127 @@ int get_file_size_and_mtime(const string &filename, off64_t *pFileSize, time_t *
 	return 0;
 }
 
+/**
+ * Get a file's identity.
+ * @param filename	[in] Filename.
+ * @param pFileId	[out] File identity.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int get_file_id(const string &filename, FileId *pFileId)
+{
+	assert(pFileId != nullptr);
+
+	struct stat sb;
+	int ret = stat(filename.c_str(), &sb);
+	if (ret != 0) {
+		// stat() failed.
+		int ret = -errno;
+		return (ret != 0 ? ret : -EIO);
+	}
+
+	// Make sure this is not a directory.
+	if (S_ISDIR(sb.st_mode)) {
+		// It's a directory.
+		return -EISDIR;
+	}
+
+	pFileId->dev = static_cast<uint64_t>(sb.st_dev);
+	pFileId->ino = static_cast<uint64_t>(sb.st_ino);
+	pFileId->size = sb.st_size;
+#if defined(__APPLE__)
+	pFileId->mtime_ns = (static_cast<int64_t>(sb.st_mtimespec.tv_sec) * 1000000000LL) + sb.st_mtimespec.tv_nsec;
+#elif defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200809L
+	pFileId->mtime_ns = (static_cast<int64_t>(sb.st_mtim.tv_sec) * 1000000000LL) + sb.st_mtim.tv_nsec;
+#else
+	pFileId->mtime_ns = static_cast<int64_t>(sb.st_mtime) * 1000000000LL;
+#endif
+	return 0;
+}
+
+/**
+ * Get the number of hard links to a file.
+ * @param filename Filename.
+ * @return Number of hard links, or negative POSIX error code on error.
+ */
+int get_link_count(const string &filename)
+{
+	struct stat sb;
+	int ret = stat(filename.c_str(), &sb);
+	if (ret != 0) {
+		// stat() failed.
+		int ret = -errno;
+		return (ret != 0 ? ret : -EIO);
+	}
+
+	// Make sure this is not a directory.
+	if (S_ISDIR(sb.st_mode)) {
+		// It's a directory.
+		return -EISDIR;
+	}
+
+	return static_cast<int>(sb.st_nlink);
+}
+
+/**
+ * Get the names of the regular files in a directory.
+ * Subdirectories and the "." and ".." entries are skipped.
+ * @param dirname	[in] Directory name.
+ * @param vEntries	[out] Filenames. (not including the directory)
+ * @param pvSubdirs	[out,opt] If specified, subdirectory names are stored here.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int read_dir(const string &dirname, vector<string> &vEntries, vector<string> *pvSubdirs)
+{
+	DIR *const dirp = opendir(!dirname.empty() ? dirname.c_str() : ".");
+	if (!dirp) {
+		// opendir() failed.
+		int ret = -errno;
+		return (ret != 0 ? ret : -EIO);
+	}
+
+	vEntries.clear();
+	if (pvSubdirs) {
+		pvSubdirs->clear();
+	}
+	const struct dirent *dirent;
+	while ((dirent = ::readdir(dirp)) != nullptr) {
+		if (dirent->d_name[0] == '.' &&
+		    (dirent->d_name[1] == '\0' ||
+		     (dirent->d_name[1] == '.' && dirent->d_name[2] == '\0')))
+		{
+			// "." or ".."
+			continue;
+		}
+#ifdef _DIRENT_HAVE_D_TYPE
+		// NOTE: DT_UNKNOWN and symlinks are kept, since
+		// determining the actual type requires a stat().
+		bool isDir = (dirent->d_type == DT_DIR);
+		if (pvSubdirs && dirent->d_type == DT_UNKNOWN)
+#else /* !_DIRENT_HAVE_D_TYPE */
+		bool isDir = false;
+		if (pvSubdirs)
+#endif /* _DIRENT_HAVE_D_TYPE */
+		{
+			// Subdirectories were requested, so check the actual type.
+			// NOTE: lstat() is used so symlinked directories aren't followed.
+			string fullname = (!dirname.empty() ? dirname : string("."));
+			fullname += '/';
+			fullname += dirent->d_name;
+			struct stat sb;
+			isDir = (lstat(fullname.c_str(), &sb) == 0 && S_ISDIR(sb.st_mode));
+		}
+
+		if (isDir) {
+			if (pvSubdirs) {
+				pvSubdirs->emplace_back(dirent->d_name);
+			}
+			continue;
+		}
+		vEntries.emplace_back(dirent->d_name);
+	}
+
+	closedir(dirp);
+	return 0;
+}
+
 } }
@@ -0,0 +1,469 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * GzReader.cpp: Random-access gzip decompression.                         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "GzReader.hpp"
+#include "RpStats.hpp"
+
+// zlib
+#include <zlib.h>
+
+// C++ STL classes.
+#include <memory>
+#include <vector>
+using std::unique_ptr;
+using std::vector;
+
+// Based on zran.c from the zlib distribution.
+// Reference: https://github.com/madler/zlib/blob/master/examples/zran.c
+
+namespace LibRpFile {
+
+class GzReaderPrivate
+{
+	public:
+		GzReaderPrivate(GzReader::ReadFunc readFunc, void *userdata);
+		~GzReaderPrivate();
+
+	private:
+		RP_DISABLE_COPY(GzReaderPrivate)
+
+	public:
+		// Sliding window size. (maximum deflate distance)
+		static const unsigned int WINSIZE = 32768;
+		// Compressed data buffer size.
+		static const unsigned int CHUNK = 16384;
+		// Minimum distance between seek points, in decompressed bytes.
+		static const off64_t SPAN = 1024*1024;
+
+		GzReader::ReadFunc readFunc;
+		void *userdata;
+
+		z_stream strm;
+		bool initOK;	// inflateInit2() succeeded
+		bool raw;	// true if decoding raw deflate after restoring a seek point
+		bool eof;	// true if the end of the gzip data was reached
+		int lastError;
+
+		off64_t in_pos;		// Compressed position of the next in_buf load.
+		off64_t out_pos;	// Decompressed position of the next output byte.
+		off64_t pos;		// Requested decompressed position.
+
+		// Sliding window, used as a circular output buffer.
+		unsigned int wpos;	// Next write position in the window.
+		unsigned int have;	// Number of valid bytes in the window.
+		uint8_t window[WINSIZE];
+
+		uint8_t in_buf[CHUNK];
+
+		// Seek point.
+		struct Point {
+			off64_t out;		// Decompressed position.
+			off64_t in;		// Compressed position of the first full byte.
+			int bits;		// Number of bits (1-7) from the byte at in-1, or 0.
+			unsigned int winlen;	// Length of the window data.
+			unique_ptr<uint8_t[]> window;
+
+			Point() : out(0), in(0), bits(0), winlen(0) { }
+		};
+		vector<Point> points;
+
+	public:
+		/**
+		 * Restart decompression from the start of the file.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int restart(void);
+
+		/**
+		 * Restart decompression from a seek point.
+		 * @param pt Seek point.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int restore(const Point &pt);
+
+		/**
+		 * Record a seek point at the current position.
+		 */
+		void addPoint(void);
+
+		/**
+		 * Check for another gzip member at the current compressed position.
+		 * If there isn't one, the end of the data has been reached.
+		 * @param comp_pos Compressed position.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int nextMember(off64_t comp_pos);
+
+		/**
+		 * Decompress data into the sliding window.
+		 * This decompresses until the end of the window is reached.
+		 * @return Number of bytes decompressed, or negative POSIX error code on error. (0 on EOF)
+		 */
+		int inflateChunk(void);
+};
+
+/** GzReaderPrivate **/
+
+GzReaderPrivate::GzReaderPrivate(GzReader::ReadFunc readFunc, void *userdata)
+	: readFunc(readFunc)
+	, userdata(userdata)
+	, initOK(false)
+	, raw(false)
+	, eof(false)
+	, lastError(0)
+	, in_pos(0)
+	, out_pos(0)
+	, pos(0)
+	, wpos(0)
+	, have(0)
+{
+	// Make sure the CRC32 table is initialized.
+	get_crc_table();
+
+	memset(&strm, 0, sizeof(strm));
+	if (inflateInit2(&strm, 16+MAX_WBITS) != Z_OK) {
+		// Error initializing zlib.
+		lastError = ENOMEM;
+		return;
+	}
+	initOK = true;
+}
+
+GzReaderPrivate::~GzReaderPrivate()
+{
+	if (initOK) {
+		inflateEnd(&strm);
+	}
+}
+
+/**
+ * Restart decompression from the start of the file.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GzReaderPrivate::restart(void)
+{
+	if (inflateReset2(&strm, 16+MAX_WBITS) != Z_OK) {
+		return -EIO;
+	}
+	raw = false;
+	eof = false;
+	strm.avail_in = 0;
+	in_pos = 0;
+	out_pos = 0;
+	wpos = 0;
+	have = 0;
+	return 0;
+}
+
+/**
+ * Restart decompression from a seek point.
+ * @param pt Seek point.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GzReaderPrivate::restore(const Point &pt)
+{
+	if (inflateReset2(&strm, -MAX_WBITS) != Z_OK) {
+		return -EIO;
+	}
+	raw = true;
+	eof = false;
+	strm.avail_in = 0;
+	in_pos = pt.in;
+
+	if (pt.bits != 0) {
+		// Seek point starts in the middle of a byte.
+		uint8_t b;
+		if (readFunc(userdata, pt.in - 1, &b, 1) != 1) {
+			return -EIO;
+		}
+		inflatePrime(&strm, pt.bits, b >> (8 - pt.bits));
+	}
+	if (inflateSetDictionary(&strm, pt.window.get(), pt.winlen) != Z_OK) {
+		return -EIO;
+	}
+
+	memcpy(window, pt.window.get(), pt.winlen);
+	wpos = pt.winlen % WINSIZE;
+	have = pt.winlen;
+	out_pos = pt.out;
+	return 0;
+}
+
+/**
+ * Record a seek point at the current position.
+ */
+void GzReaderPrivate::addPoint(void)
+{
+	Point pt;
+	pt.out = out_pos;
+	pt.in = in_pos - strm.avail_in;
+	pt.bits = strm.data_type & 7;
+	pt.winlen = have;
+	pt.window.reset(new uint8_t[have]);
+
+	// Copy the window in linear order.
+	if (have < WINSIZE) {
+		memcpy(pt.window.get(), window, have);
+	} else {
+		memcpy(pt.window.get(), &window[wpos], WINSIZE - wpos);
+		memcpy(&pt.window[WINSIZE - wpos], window, wpos);
+	}
+	points.push_back(std::move(pt));
+}
+
+/**
+ * Check for another gzip member at the current compressed position.
+ * If there isn't one, the end of the data has been reached.
+ * @param comp_pos Compressed position.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int GzReaderPrivate::nextMember(off64_t comp_pos)
+{
+	strm.avail_in = 0;
+	in_pos = comp_pos;
+
+	uint8_t magic[2];
+	if (readFunc(userdata, comp_pos, magic, sizeof(magic)) != sizeof(magic) ||
+	    magic[0] != 0x1F || magic[1] != 0x8B)
+	{
+		// No more gzip members.
+		// NOTE: Trailing garbage is ignored, same as gzread().
+		eof = true;
+		return 0;
+	}
+
+	if (inflateReset2(&strm, 16+MAX_WBITS) != Z_OK) {
+		return -EIO;
+	}
+	raw = false;
+	return 0;
+}
+
+/**
+ * Decompress data into the sliding window.
+ * This decompresses until the end of the window is reached.
+ * @return Number of bytes decompressed, or negative POSIX error code on error. (0 on EOF)
+ */
+int GzReaderPrivate::inflateChunk(void)
+{
+	const unsigned int start = wpos;
+	while (!eof && wpos < WINSIZE) {
+		if (strm.avail_in == 0) {
+			// Read more compressed data.
+			const size_t sz_read = readFunc(userdata, in_pos, in_buf, sizeof(in_buf));
+			if (sz_read == 0) {
+				// Truncated file. Return whatever we have.
+				eof = true;
+				break;
+			}
+			strm.next_in = in_buf;
+			strm.avail_in = static_cast<uInt>(sz_read);
+			in_pos += sz_read;
+		}
+
+		strm.next_out = &window[wpos];
+		strm.avail_out = WINSIZE - wpos;
+		int ret = inflate(&strm, Z_BLOCK);
+		if (ret == Z_NEED_DICT || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR) {
+			return -EIO;
+		}
+
+		const unsigned int produced = (WINSIZE - wpos) - strm.avail_out;
+		wpos += produced;
+		out_pos += produced;
+		have = std::min(have + produced, static_cast<unsigned int>(WINSIZE));
+
+		if (ret == Z_STREAM_END) {
+			// End of the gzip member.
+			off64_t comp_pos = in_pos - strm.avail_in;
+			if (raw) {
+				// Raw deflate doesn't handle the gzip trailer.
+				// Skip the CRC32 and ISIZE fields.
+				comp_pos += 8;
+			}
+			ret = nextMember(comp_pos);
+			if (ret != 0) {
+				return ret;
+			}
+		} else if ((strm.data_type & 128) && !(strm.data_type & 64)) {
+			// At the end of a deflate block, and not the last block.
+			// Record a seek point if it's far enough from the last one.
+			const off64_t last_out = (!points.empty() ? points.back().out : 0);
+			if (out_pos - last_out >= SPAN) {
+				addPoint();
+			}
+		}
+	}
+
+	const int total = static_cast<int>(wpos - start);
+	if (wpos == WINSIZE) {
+		// Wrap around to the start of the window.
+		wpos = 0;
+	}
+	return total;
+}
+
+/** GzReader **/
+
+/**
+ * Decompress a gzip stream with random access.
+ *
+ * Seek points are recorded while decompressing, so
+ * backwards seeks only need to decompress from the
+ * nearest seek point instead of from the beginning.
+ *
+ * @param readFunc	[in] Read function for the compressed data.
+ * @param userdata	[in] User data for readFunc.
+ */
+GzReader::GzReader(ReadFunc readFunc, void *userdata)
+	: d_ptr(new GzReaderPrivate(readFunc, userdata))
+{ }
+
+GzReader::~GzReader()
+{
+	delete d_ptr;
+}
+
+/**
+ * Was the decompressor initialized successfully?
+ * @return True if initialized; false if not.
+ */
+bool GzReader::isOpen(void) const
+{
+	RP_D(const GzReader);
+	return d->initOK;
+}
+
+/**
+ * Get the last error.
+ * @return Last POSIX error, or 0 if no error.
+ */
+int GzReader::lastError(void) const
+{
+	RP_D(const GzReader);
+	return d->lastError;
+}
+
+/**
+ * Read decompressed data.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t GzReader::read(void *ptr, size_t size)
+{
+	RP_D(GzReader);
+	if (!d->initOK) {
+		d->lastError = EBADF;
+		return 0;
+	} else if (size == 0) {
+		return 0;
+	}
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t total_sz_read = 0;
+
+	// Find the nearest seek point before the requested position.
+	auto iter = std::upper_bound(d->points.cbegin(), d->points.cend(), d->pos,
+		[](off64_t pos, const GzReaderPrivate::Point &pt) { return pos < pt.out; });
+	const GzReaderPrivate::Point *const pt = (iter != d->points.cbegin() ? &*(iter - 1) : nullptr);
+
+	if (d->pos < d->out_pos &&
+	    d->out_pos - d->pos <= static_cast<off64_t>(d->have))
+	{
+		// The requested data is still in the sliding window.
+		const unsigned int back = static_cast<unsigned int>(d->out_pos - d->pos);
+		size_t sz = std::min<size_t>(back, size);
+		unsigned int wstart = (d->wpos + GzReaderPrivate::WINSIZE - back) % GzReaderPrivate::WINSIZE;
+		while (sz > 0) {
+			const size_t sz_cp = std::min<size_t>(sz, GzReaderPrivate::WINSIZE - wstart);
+			memcpy(ptr8, &d->window[wstart], sz_cp);
+			ptr8 += sz_cp;
+			size -= sz_cp;
+			sz -= sz_cp;
+			total_sz_read += sz_cp;
+			d->pos += sz_cp;
+			wstart = 0;
+		}
+		if (size == 0) {
+			RpStats::add(RpStats::BYTES_READ_GZIP, total_sz_read);
+			return total_sz_read;
+		}
+	} else if (d->pos < d->out_pos || (pt && pt->out > d->out_pos)) {
+		// Restart from the nearest seek point. This is done for
+		// backwards seeks, and for forwards seeks that skip over
+		// a seek point.
+		const int ret = (pt ? d->restore(*pt) : d->restart());
+		if (ret != 0) {
+			d->lastError = -ret;
+			return 0;
+		}
+	}
+
+	// Decompress up to the requested position and copy the data.
+	while (size > 0) {
+		if (d->pos >= d->out_pos) {
+			// Need more data.
+			const int ret = d->inflateChunk();
+			if (ret <= 0) {
+				if (ret < 0) {
+					d->lastError = -ret;
+				}
+				break;
+			}
+			if (d->pos >= d->out_pos) {
+				// Still skipping.
+				continue;
+			}
+		}
+
+		// Copy from the window.
+		// NOTE: If wpos == 0, the window just wrapped around.
+		const unsigned int wend = (d->wpos != 0 ? d->wpos : GzReaderPrivate::WINSIZE);
+		const unsigned int back = static_cast<unsigned int>(d->out_pos - d->pos);
+		const size_t sz_cp = std::min<size_t>(size, back);
+		memcpy(ptr8, &d->window[wend - back], sz_cp);
+		ptr8 += sz_cp;
+		size -= sz_cp;
+		total_sz_read += sz_cp;
+		d->pos += sz_cp;
+	}
+
+	RpStats::add(RpStats::BYTES_READ_GZIP, total_sz_read);
+	return total_sz_read;
+}
+
+/**
+ * Set the decompressed data position.
+ * The actual seek is deferred until the next read.
+ * @param pos Position.
+ * @return 0 on success; -1 on error.
+ */
+int GzReader::seek(off64_t pos)
+{
+	RP_D(GzReader);
+	if (pos < 0) {
+		d->lastError = EINVAL;
+		return -1;
+	}
+	d->pos = pos;
+	return 0;
+}
+
+/**
+ * Get the decompressed data position.
+ * @return Position.
+ */
+off64_t GzReader::tell(void) const
+{
+	RP_D(const GzReader);
+	return d->pos;
+}
+
+}
@@ -0,0 +1,96 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * GzReader.hpp: Random-access gzip decompression.                         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_GZREADER_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_GZREADER_HPP__
+
+// C includes.
+#include <stdint.h>
+#include <sys/types.h>	/* for off64_t */
+
+// C includes. (C++ namespace)
+#include <cstddef>	/* for size_t */
+
+// common macros
+#include "common.h"
+
+namespace LibRpFile {
+
+class GzReaderPrivate;
+class GzReader
+{
+	public:
+		/**
+		 * Read compressed data from the underlying file.
+		 * @param userdata	[in] User data specified in the constructor.
+		 * @param pos		[in] Position in the compressed file.
+		 * @param ptr		[out] Output buffer.
+		 * @param size		[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read. (0 on EOF or error)
+		 */
+		typedef size_t (*ReadFunc)(void *userdata, off64_t pos, void *ptr, size_t size);
+
+		/**
+		 * Decompress a gzip stream with random access.
+		 *
+		 * Seek points are recorded while decompressing, so
+		 * backwards seeks only need to decompress from the
+		 * nearest seek point instead of from the beginning.
+		 *
+		 * @param readFunc	[in] Read function for the compressed data.
+		 * @param userdata	[in] User data for readFunc.
+		 */
+		GzReader(ReadFunc readFunc, void *userdata);
+		~GzReader();
+
+	private:
+		RP_DISABLE_COPY(GzReader)
+	protected:
+		friend class GzReaderPrivate;
+		GzReaderPrivate *const d_ptr;
+
+	public:
+		/**
+		 * Was the decompressor initialized successfully?
+		 * @return True if initialized; false if not.
+		 */
+		bool isOpen(void) const;
+
+		/**
+		 * Get the last error.
+		 * @return Last POSIX error, or 0 if no error.
+		 */
+		int lastError(void) const;
+
+		/**
+		 * Read decompressed data.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 2, 3)
+		size_t read(void *ptr, size_t size);
+
+		/**
+		 * Set the decompressed data position.
+		 * The actual seek is deferred until the next read.
+		 * @param pos Position.
+		 * @return 0 on success; -1 on error.
+		 */
+		int seek(off64_t pos);
+
+		/**
+		 * Get the decompressed data position.
+		 * @return Position.
+		 */
+		off64_t tell(void) const;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_GZREADER_HPP__ */
@@ -12,6 +12,10 @@
 // librpthreads
 #include "librpthreads/Atomics.h"
 
+// C++ includes.
+#include <vector>
+using std::vector;
+
 namespace LibRpFile {
 
 IRpFile::IRpFile()
@@ -57,6 +61,142 @@ int IRpFile::ungetc(int c)
 	return this->seek(pos-1);
 }
 
+/** Positional reads **/
+
+/**
+ * Read data from the specified file position.
+ *
+ * The default implementation calls seekAndRead(). Subclasses
+ * that can read from a position directly, e.g. using pread(),
+ * override this function so a single file can be read from
+ * multiple threads without sharing the file position.
+ *
+ * NOTE: The file position is undefined afterwards.
+ *
+ * @param pos	[in] File position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t IRpFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	return seekAndRead(pos, ptr, size);
+}
+
+/** Vectored reads **/
+
+/**
+ * Read data from multiple file positions.
+ *
+ * The default implementation calls pread() for each
+ * request. Subclasses with a high per-request overhead,
+ * e.g. network files, should override this function to
+ * coalesce nearby requests into a single read.
+ *
+ * NOTE: The file position is undefined afterwards.
+ *
+ * @param vec	[in] Read requests.
+ * @param count	[in] Number of read requests.
+ * @return 0 if all requests were read completely; negative POSIX error code on error.
+ */
+int IRpFile::readv(const ReadVec *vec, size_t count)
+{
+	assert(vec != nullptr || count == 0);
+	if (!vec && count > 0) {
+		return -EINVAL;
+	}
+
+	for (; count > 0; vec++, count--) {
+		if (vec->size == 0)
+			continue;
+		if (pread(vec->pos, vec->ptr, vec->size) != vec->size) {
+			// Seek and/or read error.
+			return (m_lastError != 0 ? -m_lastError : -EIO);
+		}
+	}
+	return 0;
+}
+
+/**
+ * readv() implementation that coalesces nearby requests.
+ *
+ * Requests are sorted by file position. Requests that are
+ * within maxGap bytes of each other are read using a single
+ * pread() call, then copied to the output buffers.
+ *
+ * @param vec	[in] Read requests.
+ * @param count	[in] Number of read requests.
+ * @param maxGap	[in] Maximum gap between coalesced requests, in bytes.
+ * @return 0 if all requests were read completely; negative POSIX error code on error.
+ */
+int IRpFile::readv_coalesced(const ReadVec *vec, size_t count, size_t maxGap)
+{
+	assert(vec != nullptr || count == 0);
+	if (!vec && count > 0) {
+		return -EINVAL;
+	}
+
+	// Maximum size of a coalesced read.
+	// Larger requests are always read directly.
+	static const off64_t READV_MAX_SIZE = 1024*1024;
+
+	// Sort the requests by file position.
+	vector<const ReadVec*> sorted;
+	sorted.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		if (vec[i].size > 0) {
+			sorted.push_back(&vec[i]);
+		}
+	}
+	std::sort(sorted.begin(), sorted.end(),
+		[](const ReadVec *a, const ReadVec *b) { return a->pos < b->pos; });
+
+	vector<uint8_t> buf;
+	const size_t sorted_count = sorted.size();
+	for (size_t i = 0; i < sorted_count; ) {
+		// Find requests that can be coalesced with this one.
+		const off64_t start = sorted[i]->pos;
+		off64_t end = start + static_cast<off64_t>(sorted[i]->size);
+		size_t j = i + 1;
+		for (; j < sorted_count; j++) {
+			const ReadVec *const rv = sorted[j];
+			if (rv->pos > end + static_cast<off64_t>(maxGap))
+				break;
+			const off64_t rv_end = rv->pos + static_cast<off64_t>(rv->size);
+			const off64_t new_end = std::max(end, rv_end);
+			if (new_end - start > READV_MAX_SIZE)
+				break;
+			end = new_end;
+		}
+
+		if (j == i + 1) {
+			// Single request. Read it directly.
+			const ReadVec *const rv = sorted[i];
+			if (pread(rv->pos, rv->ptr, rv->size) != rv->size) {
+				// Seek and/or read error.
+				return (m_lastError != 0 ? -m_lastError : -EIO);
+			}
+		} else {
+			// Read all of the requests at once.
+			// NOTE: A short read is only an error if it
+			// affects one of the requests.
+			buf.resize(static_cast<size_t>(end - start));
+			const size_t size = pread(start, buf.data(), buf.size());
+			for (size_t k = i; k < j; k++) {
+				const ReadVec *const rv = sorted[k];
+				const size_t offset = static_cast<size_t>(rv->pos - start);
+				if (offset + rv->size > size) {
+					// Seek and/or read error.
+					return (m_lastError != 0 ? -m_lastError : -EIO);
+				}
+				memcpy(rv->ptr, &buf[offset], rv->size);
+			}
+		}
+		i = j;
+	}
+	return 0;
+}
+
 /**
  * Copy data from this IRpFile to another IRpFile.
  * Read/write positions must be set before calling this function.
@@ -188,6 +188,188 @@ class IRpFile : public RefBase
 			return false;
 		}
 
+	public:
+		/** Asynchronous I/O **/
+
+		/**
+		 * Get the POSIX file descriptor for direct reads.
+		 *
+		 * This is used by AsyncReader to read the file data without
+		 * going through the IRpFile. It's only supported by IRpFile
+		 * subclasses that read the file data from an OS file handle
+		 * as-is, i.e. not compressed files or device files.
+		 *
+		 * @return File descriptor, or -1 if not supported.
+		 */
+		virtual int nativeFd(void) const
+		{
+			return -1;
+		}
+
+	public:
+		/** Access pattern hints **/
+
+		/**
+		 * Expected access pattern for adviseAccess().
+		 */
+		enum class AccessPattern {
+			Normal,		// No particular pattern. (default)
+			Sequential,	// Data will be read sequentially.
+			Random,		// Data will be read in random order.
+			Streaming,	// Data will be read once, sequentially. (e.g. hashing)
+					// Data that has already been read may be dropped
+					// from the OS cache so other files aren't evicted.
+		};
+
+		/**
+		 * Advise the file of the expected access pattern.
+		 *
+		 * This is only a hint; the default implementation does nothing.
+		 * Local files map it to posix_fadvise() or madvise().
+		 *
+		 * @param pattern Access pattern.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int adviseAccess(AccessPattern pattern)
+		{
+			RP_UNUSED(pattern);
+			return 0;
+		}
+
+		/**
+		 * File range for prefetchv().
+		 */
+		struct Range {
+			off64_t pos;	// File position.
+			size_t size;	// Size, in bytes.
+		};
+
+		/**
+		 * Hint that the specified ranges will be read soon.
+		 *
+		 * RomData subclasses should call this as soon as they know
+		 * which ranges they'll need, e.g. right after validating the
+		 * header, so the I/O overlaps with parsing. This does not
+		 * wait for the data to be loaded.
+		 *
+		 * This is only a hint; the default implementation does nothing.
+		 * Local files map it to posix_fadvise() or madvise().
+		 *
+		 * @param ranges	[in] File ranges.
+		 * @param count		[in] Number of ranges.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		virtual int prefetchv(const Range *ranges, size_t count)
+		{
+			RP_UNUSED(ranges);
+			RP_UNUSED(count);
+			return 0;
+		}
+
+		/**
+		 * Hint that the specified range will be read soon.
+		 * @param pos	[in] File position.
+		 * @param size	[in] Size, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		inline int prefetch(off64_t pos, size_t size)
+		{
+			const Range range = {pos, size};
+			return prefetchv(&range, 1);
+		}
+
+	public:
+		/** Zero-copy access **/
+
+		/**
+		 * Get a read-only pointer to the file data at the specified position.
+		 *
+		 * This is only supported by IRpFile subclasses whose data is
+		 * already in memory, e.g. RpMemFile and RpFile_mmap. Callers
+		 * must fall back to read() if this function returns nullptr.
+		 *
+		 * The pointer remains valid until the file is closed.
+		 * The file position is not changed.
+		 *
+		 * @param pos	[in] File position.
+		 * @param pSize	[in/out] Requested size; on return, the number of bytes available. (may be less at EOF)
+		 * @return Pointer to the file data, or nullptr if not supported or if pos is out of range.
+		 */
+		ATTR_ACCESS(read_write, 3)
+		virtual const uint8_t *view(off64_t pos, size_t *pSize)
+		{
+			RP_UNUSED(pos);
+			RP_UNUSED(pSize);
+			return nullptr;
+		}
+
+	public:
+		/** Positional reads **/
+
+		/**
+		 * Read data from the specified file position.
+		 *
+		 * The default implementation calls seekAndRead(). Subclasses
+		 * that can read from a position directly, e.g. using pread(),
+		 * override this function so a single file can be read from
+		 * multiple threads without sharing the file position.
+		 *
+		 * NOTE: The file position is undefined afterwards.
+		 *
+		 * @param pos	[in] File position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		virtual size_t pread(off64_t pos, void *ptr, size_t size);
+
+	public:
+		/** Vectored reads **/
+
+		/**
+		 * Read request for readv().
+		 */
+		struct ReadVec {
+			off64_t pos;	// [in] File position.
+			void *ptr;	// [out] Output data buffer.
+			size_t size;	// [in] Amount of data to read, in bytes.
+		};
+
+		/**
+		 * Read data from multiple file positions.
+		 *
+		 * The default implementation calls pread() for each
+		 * request. Subclasses with a high per-request overhead,
+		 * e.g. network files, should override this function to
+		 * coalesce nearby requests into a single read.
+		 *
+		 * NOTE: The file position is undefined afterwards.
+		 *
+		 * @param vec	[in] Read requests.
+		 * @param count	[in] Number of read requests.
+		 * @return 0 if all requests were read completely; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		virtual int readv(const ReadVec *vec, size_t count);
+
+	protected:
+		/**
+		 * readv() implementation that coalesces nearby requests.
+		 *
+		 * Requests are sorted by file position. Requests that are
+		 * within maxGap bytes of each other are read using a single
+		 * pread() call, then copied to the output buffers.
+		 *
+		 * @param vec	[in] Read requests.
+		 * @param count	[in] Number of read requests.
+		 * @param maxGap	[in] Maximum gap between coalesced requests, in bytes.
+		 * @return 0 if all requests were read completely; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int readv_coalesced(const ReadVec *vec, size_t count, size_t maxGap);
+
 	public:
 		/** Convenience functions implemented for all IRpFile classes. **/
 
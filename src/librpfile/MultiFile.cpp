@@ -0,0 +1,266 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * MultiFile.cpp: Special wrapper for handling a multi-part split file     *
+ * as one.                                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "MultiFile.hpp"
+
+// C++ STL classes.
+using std::string;
+using std::vector;
+
+namespace LibRpFile {
+
+/**
+ * Open multiple files and handle them as if they're a single file.
+ * The files are concatenated in the specified order.
+ * The resulting IRpFile is read-only.
+ *
+ * @param files Files. (must have at least one file)
+ */
+MultiFile::MultiFile(const vector<IRpFile*> &files)
+	: super()
+	, m_fullSize(0)
+	, m_pos(0)
+	, m_lastPart(0)
+{
+	assert(!files.empty());
+	if (files.empty()) {
+		// No files.
+		m_lastError = EBADF;
+		return;
+	}
+
+	m_parts.reserve(files.size());
+	for (IRpFile *file : files) {
+		assert(file != nullptr);
+		const off64_t size = (file ? file->size() : -1);
+		if (size < 0) {
+			// File is missing, or the size is invalid.
+			close();
+			m_lastError = EBADF;
+			return;
+		}
+
+		Part part;
+		part.file = file->ref();
+		part.start = m_fullSize;
+		part.size = size;
+		m_parts.push_back(part);
+		m_fullSize += size;
+	}
+}
+
+MultiFile::~MultiFile()
+{
+	for (Part &part : m_parts) {
+		part.file->unref();
+	}
+}
+
+/**
+ * Is the file open?
+ * This usually only returns false if an error occurred.
+ * @return True if the file is open; false if it isn't.
+ */
+bool MultiFile::isOpen(void) const
+{
+	return !m_parts.empty();
+}
+
+/**
+ * Close the file.
+ */
+void MultiFile::close(void)
+{
+	for (Part &part : m_parts) {
+		part.file->unref();
+	}
+	m_parts.clear();
+	m_fullSize = 0;
+	m_pos = 0;
+	m_lastPart = 0;
+}
+
+/**
+ * Find the part that contains the specified position.
+ * @param pos Position. (must be less than m_fullSize)
+ * @return Part index.
+ */
+unsigned int MultiFile::findPart(off64_t pos) const
+{
+	assert(pos >= 0 && pos < m_fullSize);
+
+	// Reads are usually sequential, so check the last part first.
+	const Part &last = m_parts[m_lastPart];
+	if (pos >= last.start && pos < last.start + last.size) {
+		return m_lastPart;
+	}
+
+	// Find the last part that starts at or before pos.
+	// NOTE: Empty parts have the same start position as the
+	// next part, so upper_bound() skips them.
+	auto iter = std::upper_bound(m_parts.cbegin(), m_parts.cend(), pos,
+		[](off64_t pos, const Part &part) {
+			return (pos < part.start);
+		});
+	assert(iter != m_parts.cbegin());
+	return static_cast<unsigned int>(std::distance(m_parts.cbegin(), iter) - 1);
+}
+
+/**
+ * Read data from the file.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t MultiFile::read(void *ptr, size_t size)
+{
+	if (m_parts.empty()) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	// Don't read past the end of the file.
+	if (m_pos >= m_fullSize) {
+		return 0;
+	} else if (m_pos + static_cast<off64_t>(size) > m_fullSize) {
+		size = static_cast<size_t>(m_fullSize - m_pos);
+	}
+
+	if (unlikely(size == 0)) {
+		// Not reading anything...
+		return 0;
+	}
+
+	// uint8_t pointer access.
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t ret = 0;
+
+	unsigned int idx = findPart(m_pos);
+	while (size > 0 && idx < m_parts.size()) {
+		const Part &part = m_parts[idx];
+		const off64_t partPos = m_pos - part.start;
+		size_t part_sz = size;
+		if (partPos + static_cast<off64_t>(part_sz) > part.size) {
+			// Read crosses into the next part.
+			part_sz = static_cast<size_t>(part.size - partPos);
+		}
+
+		m_lastPart = idx;
+		const size_t sz_read = part.file->seekAndRead(partPos, ptr8, part_sz);
+		m_lastError = part.file->lastError();
+		ret += sz_read;
+		m_pos += sz_read;
+		if (sz_read != part_sz) {
+			// Short read.
+			break;
+		}
+
+		size -= sz_read;
+		ptr8 += sz_read;
+		idx++;
+	}
+
+	return ret;
+}
+
+/**
+ * Write data to the file.
+ * (NOTE: Not valid for MultiFile; this will always return 0.)
+ * @param ptr Input data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes written.
+ */
+size_t MultiFile::write(const void *ptr, size_t size)
+{
+	// Not a valid operation for MultiFile.
+	RP_UNUSED(ptr);
+	RP_UNUSED(size);
+	m_lastError = EBADF;
+	return 0;
+}
+
+/**
+ * Set the file position.
+ * @param pos File position.
+ * @return 0 on success; -1 on error.
+ */
+int MultiFile::seek(off64_t pos)
+{
+	if (m_parts.empty()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	if (pos <= 0) {
+		m_pos = 0;
+	} else if (pos >= m_fullSize) {
+		m_pos = m_fullSize;
+	} else {
+		m_pos = pos;
+	}
+
+	return 0;
+}
+
+/**
+ * Get the file position.
+ * @return File position, or -1 on error.
+ */
+off64_t MultiFile::tell(void)
+{
+	if (m_parts.empty()) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	return m_pos;
+}
+
+/**
+ * Truncate the file.
+ * (NOTE: Not valid for MultiFile; this will always return -1.)
+ * @param size New size. (default is 0)
+ * @return 0 on success; -1 on error.
+ */
+int MultiFile::truncate(off64_t size)
+{
+	// Not supported.
+	RP_UNUSED(size);
+	m_lastError = ENOTSUP;
+	return -1;
+}
+
+/** File properties **/
+
+/**
+ * Get the file size.
+ * @return File size, or negative on error.
+ */
+off64_t MultiFile::size(void)
+{
+	if (m_parts.empty()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_fullSize;
+}
+
+/**
+ * Get the filename.
+ * @return Filename. (May be empty if the filename is not available.)
+ */
+string MultiFile::filename(void) const
+{
+	// TODO: Implement this?
+	return string();
+}
+
+}
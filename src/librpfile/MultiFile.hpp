@@ -0,0 +1,140 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * MultiFile.hpp: Special wrapper for handling a multi-part split file     *
+ * as one.                                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_MULTIFILE_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_MULTIFILE_HPP__
+
+#include "IRpFile.hpp"
+
+// C++ includes.
+#include <vector>
+
+namespace LibRpFile {
+
+class MultiFile final : public IRpFile
+{
+	public:
+		/**
+		 * Open multiple files and handle them as if they're a single file.
+		 * The files are concatenated in the specified order.
+		 * The resulting IRpFile is read-only.
+		 *
+		 * @param files Files. (must have at least one file)
+		 */
+		explicit MultiFile(const std::vector<IRpFile*> &files);
+	protected:
+		virtual ~MultiFile();	// call unref() instead
+
+	private:
+		typedef IRpFile super;
+		RP_DISABLE_COPY(MultiFile)
+
+	public:
+		/**
+		 * Is the file open?
+		 * This usually only returns false if an error occurred.
+		 * @return True if the file is open; false if it isn't.
+		 */
+		bool isOpen(void) const final;
+
+		/**
+		 * Close the file.
+		 */
+		void close(void) final;
+
+		/**
+		 * Read data from the file.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 2, 3)
+		size_t read(void *ptr, size_t size) final;
+
+		/**
+		 * Write data to the file.
+		 * (NOTE: Not valid for MultiFile; this will always return 0.)
+		 * @param ptr Input data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes written.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		size_t write(const void *ptr, size_t size) final;
+
+		/**
+		 * Set the file position.
+		 * @param pos File position.
+		 * @return 0 on success; -1 on error.
+		 */
+		int seek(off64_t pos) final;
+
+		/**
+		 * Get the file position.
+		 * @return File position, or -1 on error.
+		 */
+		off64_t tell(void) final;
+
+		/**
+		 * Truncate the file.
+		 * (NOTE: Not valid for MultiFile; this will always return -1.)
+		 * @param size New size. (default is 0)
+		 * @return 0 on success; -1 on error.
+		 */
+		int truncate(off64_t size = 0) final;
+
+	public:
+		/** File properties **/
+
+		/**
+		 * Get the file size.
+		 * @return File size, or negative on error.
+		 */
+		off64_t size(void) final;
+
+		/**
+		 * Get the filename.
+		 * @return Filename. (May be empty if the filename is not available.)
+		 */
+		std::string filename(void) const final;
+
+	public:
+		/** MultiFile functions **/
+
+		/**
+		 * Get the number of parts.
+		 * @return Number of parts.
+		 */
+		inline unsigned int partCount(void) const
+		{
+			return static_cast<unsigned int>(m_parts.size());
+		}
+
+	private:
+		/**
+		 * Find the part that contains the specified position.
+		 * @param pos Position. (must be less than m_fullSize)
+		 * @return Part index.
+		 */
+		unsigned int findPart(off64_t pos) const;
+
+	protected:
+		struct Part {
+			IRpFile *file;
+			off64_t start;	// Starting position within the combined file.
+			off64_t size;	// Size of this part.
+		};
+		std::vector<Part> m_parts;
+		off64_t m_fullSize;	// Combined sizes.
+		off64_t m_pos;		// Current position.
+		unsigned int m_lastPart;	// Part used for the last read.
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_MULTIFILE_HPP__ */
@@ -11,11 +11,129 @@
 #include "FileSystem.hpp"
 #include "RpFile.hpp"
 
+// librpthreads
+#include "librpthreads/RWLock.hpp"
+using LibRpThreads::RWLock;
+using LibRpThreads::ReadLocker;
+using LibRpThreads::WriteLocker;
+
 // C++ STL classes.
 using std::string;
+using std::vector;
 
 namespace LibRpFile { namespace FileSystem {
 
+/**
+ * Directory listing cache.
+ *
+ * Related files are usually requested several times in a row
+ * from the same directory, e.g. .VMI/.VMS pairs and GDI track
+ * files. Listing the directory once lets us resolve all of the
+ * case variants without probing each filename, which is slow
+ * on network file systems.
+ *
+ * The listing expires after a few seconds so newly-created
+ * files will be picked up.
+ *
+ * Lookups only need a read lock, so multiple threads
+ * can search the listing at the same time.
+ */
+static RWLock dirCacheLock;
+static string dirCacheName;
+static vector<string> dirCacheEntries;
+static time_t dirCacheTime = 0;
+static bool dirCacheValid = false;
+static const time_t DIR_CACHE_TTL = 3;	// seconds
+
+/**
+ * Is the directory listing cache valid for the specified directory?
+ * NOTE: dirCacheLock must be held.
+ * @param s_dir	[in] Directory, including the trailing slash. (may be empty)
+ * @param now	[in] Current time.
+ * @return True if valid; false if not.
+ */
+static inline bool isDirCacheValid(const string &s_dir, time_t now)
+{
+	return (dirCacheValid && dirCacheName == s_dir &&
+		now >= dirCacheTime && now - dirCacheTime <= DIR_CACHE_TTL);
+}
+
+/**
+ * Search the directory listing cache.
+ * NOTE: dirCacheLock must be held.
+ * @param name_upper	[in] Filename with an uppercase extension.
+ * @param name_lower	[in] Filename with a lowercase extension.
+ * @param s_found	[out] Filename as it exists in the directory.
+ * @return 0 if found; -ENOENT if not found.
+ */
+static int searchDirCache(const string &name_upper, const string &name_lower, string &s_found)
+{
+	// Check for the uppercase extension first, then the
+	// lowercase extension, then any other case variant.
+	const string *pCaseMatch = nullptr;
+	bool foundLower = false;
+	for (const string &entry : dirCacheEntries) {
+		if (entry == name_upper) {
+			s_found = entry;
+			return 0;
+		} else if (entry == name_lower) {
+			foundLower = true;
+		} else if (!pCaseMatch && entry.size() == name_upper.size() &&
+			   !strcasecmp(entry.c_str(), name_upper.c_str()))
+		{
+			pCaseMatch = &entry;
+		}
+	}
+
+	if (foundLower) {
+		s_found = name_lower;
+		return 0;
+	} else if (pCaseMatch) {
+		s_found = *pCaseMatch;
+		return 0;
+	}
+	return -ENOENT;
+}
+
+/**
+ * Look up a related file in the directory listing cache.
+ * @param s_dir		[in] Directory, including the trailing slash. (may be empty)
+ * @param name_upper	[in] Filename with an uppercase extension.
+ * @param name_lower	[in] Filename with a lowercase extension.
+ * @param s_found	[out] Filename as it exists in the directory.
+ * @return 0 if found; -ENOENT if not found; other negative POSIX error code if the directory couldn't be read.
+ */
+static int findInDirCache(const string &s_dir,
+	const string &name_upper, const string &name_lower,
+	string &s_found)
+{
+	const time_t now = time(nullptr);
+	{
+		// Fast path: The cache is valid for this directory.
+		ReadLocker locker(dirCacheLock);
+		if (isDirCacheValid(s_dir, now)) {
+			return searchDirCache(name_upper, name_lower, s_found);
+		}
+	}
+
+	WriteLocker locker(dirCacheLock);
+	if (!isDirCacheValid(s_dir, now)) {
+		// Cache is stale. Re-read the directory.
+		// NOTE: Another thread may have done this already.
+		dirCacheValid = false;
+		int ret = read_dir(s_dir, dirCacheEntries);
+		if (ret != 0) {
+			dirCacheEntries.clear();
+			return ret;
+		}
+		dirCacheName = s_dir;
+		dirCacheTime = now;
+		dirCacheValid = true;
+	}
+
+	return searchDirCache(name_upper, name_lower, s_found);
+}
+
 /**
  * Attempt to open a related file. (read-only)
  *
@@ -68,26 +186,40 @@ IRpFile *openRelatedFile(const char *filename, const char *basename, const char
 	// on all platforms.
 
 	// Check for uppercase extensions first.
-	string s_ext = ext;
-	std::transform(s_ext.begin(), s_ext.end(), s_ext.begin(),
+	string s_ext_upper = ext;
+	std::transform(s_ext_upper.begin(), s_ext_upper.end(), s_ext_upper.begin(),
 		[](unsigned char c) { return std::toupper(c); });
+	string s_ext_lower = ext;
+	std::transform(s_ext_lower.begin(), s_ext_lower.end(), s_ext_lower.begin(),
+		[](unsigned char c) { return std::tolower(c); });
 
-	// Attempt to open the related file.
-	string rel_filename = s_dir + s_basename + s_ext;
-	IRpFile *test_file = new RpFile(rel_filename, RpFile::FM_OPEN_READ);
-	if (!test_file->isOpen()) {
-		// Error opening the related file.
-		test_file->unref();
-
-		// Try again with a lowercase extension.
-		std::transform(s_ext.begin(), s_ext.end(), s_ext.begin(),
-			[](unsigned char c) { return std::tolower(c); });
-		rel_filename.replace(rel_filename.size() - s_ext.size(), s_ext.size(), s_ext);
-		test_file = new RpFile(rel_filename, RpFile::FM_OPEN_READ);
+	IRpFile *test_file = nullptr;
+	string s_found;
+	int ret = findInDirCache(s_dir, s_basename + s_ext_upper, s_basename + s_ext_lower, s_found);
+	if (ret == 0) {
+		// Found the related file in the directory listing.
+		test_file = new RpFile(s_dir + s_found, RpFile::FM_OPEN_READ);
 		if (!test_file->isOpen()) {
-			// Still can't open the related file.
+			// Error opening the related file.
 			UNREF_AND_NULL_NOCHK(test_file);
 		}
+	} else if (ret != -ENOENT) {
+		// Unable to list the directory.
+		// Attempt to open the related file directly.
+		string rel_filename = s_dir + s_basename + s_ext_upper;
+		test_file = new RpFile(rel_filename, RpFile::FM_OPEN_READ);
+		if (!test_file->isOpen()) {
+			// Error opening the related file.
+			test_file->unref();
+
+			// Try again with a lowercase extension.
+			rel_filename.replace(rel_filename.size() - s_ext_lower.size(), s_ext_lower.size(), s_ext_lower);
+			test_file = new RpFile(rel_filename, RpFile::FM_OPEN_READ);
+			if (!test_file->isOpen()) {
+				// Still can't open the related file.
+				UNREF_AND_NULL_NOCHK(test_file);
+			}
+		}
 	}
 
 	if (!test_file && FileSystem::is_symlink(filename)) {
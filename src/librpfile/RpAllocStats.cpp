@@ -0,0 +1,117 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpAllocStats.cpp: Per-subsystem allocation statistics.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpAllocStats.hpp"
+
+// librpthreads
+#include "librpthreads/Atomics.h"
+
+namespace LibRpFile { namespace RpAllocStats {
+
+// Tag names.
+static const char *const tag_names[TAG_MAX] = {
+	"aligned",
+	"rp_image",
+	"uvector",
+	"romfields",
+};
+
+#ifdef ENABLE_ALLOC_STATS
+
+#ifdef _MSC_VER
+typedef __int64 counter_t;
+#else /* !_MSC_VER */
+typedef int64_t counter_t;
+#endif /* _MSC_VER */
+
+// Counter values.
+static volatile counter_t counters[TAG_MAX][4];
+enum { CTR_COUNT, CTR_BYTES, CTR_CURRENT, CTR_PEAK };
+
+/**
+ * Record an allocation.
+ * @param tag Tag.
+ * @param size Size, in bytes.
+ */
+void onAlloc(Tag tag, size_t size)
+{
+	assert(tag >= 0 && tag < TAG_MAX);
+	if (unlikely(tag < 0 || tag >= TAG_MAX))
+		return;
+
+	volatile counter_t *const ctr = counters[tag];
+	ATOMIC_ADD_FETCH64(&ctr[CTR_COUNT], 1);
+	ATOMIC_ADD_FETCH64(&ctr[CTR_BYTES], static_cast<counter_t>(size));
+	const counter_t current = ATOMIC_ADD_FETCH64(&ctr[CTR_CURRENT], static_cast<counter_t>(size));
+
+	// Update the peak value.
+	counter_t peak = ATOMIC_ADD_FETCH64(&ctr[CTR_PEAK], 0);
+	while (current > peak) {
+		const counter_t prev = ATOMIC_CMPXCHG64(&ctr[CTR_PEAK], peak, current);
+		if (prev == peak)
+			break;
+		peak = prev;
+	}
+}
+
+/**
+ * Record a deallocation.
+ * @param tag Tag.
+ * @param size Size, in bytes. (must match onAlloc())
+ */
+void onFree(Tag tag, size_t size)
+{
+	assert(tag >= 0 && tag < TAG_MAX);
+	if (unlikely(tag < 0 || tag >= TAG_MAX))
+		return;
+	ATOMIC_ADD_FETCH64(&counters[tag][CTR_CURRENT], -static_cast<counter_t>(size));
+}
+
+#endif /* ENABLE_ALLOC_STATS */
+
+/**
+ * Get the counters for a tag.
+ * @param tag Tag.
+ * @param pCounters [out] Counters. (all 0 if the tag is invalid or statistics are disabled)
+ */
+void get(Tag tag, Counters *pCounters)
+{
+	assert(pCounters != nullptr);
+	memset(pCounters, 0, sizeof(*pCounters));
+	assert(tag >= 0 && tag < TAG_MAX);
+	if (unlikely(tag < 0 || tag >= TAG_MAX))
+		return;
+
+#ifdef ENABLE_ALLOC_STATS
+	// NOTE: Adding 0 to ensure 64-bit reads aren't torn on 32-bit systems.
+	volatile counter_t *const ctr = counters[tag];
+	pCounters->count = ATOMIC_ADD_FETCH64(&ctr[CTR_COUNT], 0);
+	pCounters->bytes = ATOMIC_ADD_FETCH64(&ctr[CTR_BYTES], 0);
+	pCounters->current = ATOMIC_ADD_FETCH64(&ctr[CTR_CURRENT], 0);
+	pCounters->peak = ATOMIC_ADD_FETCH64(&ctr[CTR_PEAK], 0);
+#endif /* ENABLE_ALLOC_STATS */
+}
+
+/**
+ * Get the name of a tag.
+ * Names are lowercase identifiers suitable for machine-readable output,
+ * e.g. "rp_image".
+ * @param tag Tag.
+ * @return Tag name, or nullptr if the tag is invalid.
+ */
+const char *name(Tag tag)
+{
+	static_assert(ARRAY_SIZE(tag_names) == TAG_MAX, "tag_names[] is out of sync with Tag");
+	assert(tag >= 0 && tag < TAG_MAX);
+	if (unlikely(tag < 0 || tag >= TAG_MAX))
+		return nullptr;
+	return tag_names[tag];
+}
+
+} }
@@ -0,0 +1,112 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpAllocStats.hpp: Per-subsystem allocation statistics.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_RPALLOCSTATS_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_RPALLOCSTATS_HPP__
+
+#include "librpfile/config.librpfile.h"
+
+// C includes.
+#include <stddef.h>	/* size_t */
+#include <stdint.h>
+
+namespace LibRpFile { namespace RpAllocStats {
+
+/**
+ * Allocation statistics, tracked per subsystem tag.
+ *
+ * Statistics are only compiled in if ENABLE_ALLOC_STATS is set.
+ * Otherwise, onAlloc() and onFree() are no-ops, and all
+ * counters are 0.
+ *
+ * NOTE: Only allocations made through the instrumented paths
+ * are counted, e.g. aligned_malloc() and ao::uvector.
+ */
+enum Tag {
+	TAG_ALIGNED,	// aligned_malloc(): Untagged allocations.
+	TAG_RP_IMAGE,	// rp_image: Image and palette buffers.
+	TAG_UVECTOR,	// ao::uvector: Buffers.
+	TAG_ROMFIELDS,	// RomFields: Field arrays and string arenas.
+
+	TAG_MAX
+};
+
+/**
+ * Counters for a single tag.
+ */
+struct Counters {
+	int64_t count;		// Number of allocations.
+	int64_t bytes;		// Total bytes allocated.
+	int64_t current;	// Bytes currently allocated.
+	int64_t peak;		// Peak value of current.
+};
+
+#ifdef ENABLE_ALLOC_STATS
+
+/**
+ * Record an allocation.
+ * @param tag Tag.
+ * @param size Size, in bytes.
+ */
+void onAlloc(Tag tag, size_t size);
+
+/**
+ * Record a deallocation.
+ * @param tag Tag.
+ * @param size Size, in bytes. (must match onAlloc())
+ */
+void onFree(Tag tag, size_t size);
+
+#else /* !ENABLE_ALLOC_STATS */
+
+static inline void onAlloc(Tag tag, size_t size)
+{
+	((void)tag);
+	((void)size);
+}
+
+static inline void onFree(Tag tag, size_t size)
+{
+	((void)tag);
+	((void)size);
+}
+
+#endif /* ENABLE_ALLOC_STATS */
+
+/**
+ * Are allocation statistics enabled in this build?
+ * @return True if enabled; false if not.
+ */
+static inline bool isEnabled(void)
+{
+#ifdef ENABLE_ALLOC_STATS
+	return true;
+#else /* !ENABLE_ALLOC_STATS */
+	return false;
+#endif /* ENABLE_ALLOC_STATS */
+}
+
+/**
+ * Get the counters for a tag.
+ * @param tag Tag.
+ * @param pCounters [out] Counters. (all 0 if the tag is invalid or statistics are disabled)
+ */
+void get(Tag tag, Counters *pCounters);
+
+/**
+ * Get the name of a tag.
+ * Names are lowercase identifiers suitable for machine-readable output,
+ * e.g. "rp_image".
+ * @param tag Tag.
+ * @return Tag name, or nullptr if the tag is invalid.
+ */
+const char *name(Tag tag);
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_RPALLOCSTATS_HPP__ */
@@ -88,6 +88,33 @@ class RpFile : public IRpFile
 		ATTR_ACCESS_SIZE(write_only, 2, 3)
 		size_t read(void *ptr, size_t size) final;
 
+		/**
+		 * Read data from the specified file position.
+		 * Uncompressed files are read without using the file position.
+		 *
+		 * NOTE: The file position is undefined afterwards.
+		 *
+		 * @param pos	[in] File position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
+		/**
+		 * Read data from multiple file positions.
+		 * Nearby requests are coalesced into a single read.
+		 *
+		 * NOTE: The file position is undefined afterwards.
+		 *
+		 * @param vec	[in] Read requests.
+		 * @param count	[in] Number of read requests.
+		 * @return 0 if all requests were read completely; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int readv(const ReadVec *vec, size_t count) final;
+
 		/**
 		 * Write data to the file.
 		 * @param ptr Input data buffer.
@@ -174,6 +201,36 @@ class RpFile : public IRpFile
 		 */
 		int rereadDeviceSizeScsi(off64_t *pDeviceSize = nullptr, uint32_t *pSectorSize = nullptr);
 
+#ifndef _WIN32
+	public:
+		/** Asynchronous I/O **/
+
+		/**
+		 * Get the POSIX file descriptor for direct reads.
+		 * @return File descriptor, or -1 if not supported.
+		 */
+		int nativeFd(void) const final;
+
+	public:
+		/** Access pattern hints **/
+
+		/**
+		 * Advise the file of the expected access pattern.
+		 * @param pattern Access pattern.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int adviseAccess(AccessPattern pattern) final;
+
+		/**
+		 * Hint that the specified ranges will be read soon.
+		 * @param ranges	[in] File ranges.
+		 * @param count		[in] Number of ranges.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int prefetchv(const Range *ranges, size_t count) final;
+#endif /* !_WIN32 */
+
 	public:
 		/** Public SCSI command wrapper functions **/
 
@@ -0,0 +1,296 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpFile_mmap.cpp: Memory-mapped read-only file object.                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpFile_mmap.hpp"
+#include "RpFile.hpp"
+
+#ifdef _WIN32
+// libwin32common
+# include "libwin32common/RpWin32_sdk.h"
+# include "libwin32common/MiniU82T.hpp"
+# include "libwin32common/w32err.h"
+using LibWin32Common::U82T_s;
+#else /* !_WIN32 */
+// C includes.
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif /* _WIN32 */
+
+// C++ STL classes.
+using std::string;
+
+namespace LibRpFile {
+
+// Maximum file size to map.
+// 32-bit systems don't have enough address space
+// to map large disc images.
+static const uint64_t MMAP_MAX_SIZE =
+	(sizeof(void*) >= 8) ? (1ULL << 40) : (256U * 1024U * 1024U);
+
+/**
+ * Open a local file using a read-only memory mapping.
+ *
+ * Only regular files can be mapped. Check isOpen()
+ * after construction; if it's false, use RpFile.
+ *
+ * @param filename Filename. (UTF-8)
+ */
+RpFile_mmap::RpFile_mmap(const char *filename)
+	: super()
+	, m_filename(filename ? filename : "")
+{
+	init();
+}
+
+/**
+ * Open a local file using a read-only memory mapping.
+ *
+ * Only regular files can be mapped. Check isOpen()
+ * after construction; if it's false, use RpFile.
+ *
+ * @param filename Filename. (UTF-8)
+ */
+RpFile_mmap::RpFile_mmap(const string &filename)
+	: super()
+	, m_filename(filename)
+{
+	init();
+}
+
+/**
+ * Common initialization function for RpFile_mmap's constructors.
+ * Filename must be set in m_filename.
+ */
+void RpFile_mmap::init(void)
+{
+	if (m_filename.empty()) {
+		m_lastError = EINVAL;
+		return;
+	}
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFile(U82T_s(m_filename).c_str(),
+		GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (!hFile || hFile == INVALID_HANDLE_VALUE) {
+		m_lastError = w32err_to_posix(GetLastError());
+		return;
+	}
+
+	// Only regular files can be mapped.
+	LARGE_INTEGER liSize;
+	if (GetFileType(hFile) != FILE_TYPE_DISK ||
+	    !GetFileSizeEx(hFile, &liSize))
+	{
+		CloseHandle(hFile);
+		m_lastError = ENOTSUP;
+		return;
+	}
+	if (liSize.QuadPart <= 0 || static_cast<uint64_t>(liSize.QuadPart) > MMAP_MAX_SIZE) {
+		// Empty files can't be mapped, and very large
+		// files might not fit in the address space.
+		CloseHandle(hFile);
+		m_lastError = ENOTSUP;
+		return;
+	}
+
+	// NOTE: The mapped view keeps the file mapping object
+	// and the file open, so the handles can be closed here.
+	HANDLE hMapping = CreateFileMapping(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (hMapping) {
+		m_buf = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+		if (!m_buf) {
+			m_lastError = w32err_to_posix(GetLastError());
+		}
+		CloseHandle(hMapping);
+	} else {
+		m_lastError = w32err_to_posix(GetLastError());
+	}
+	CloseHandle(hFile);
+	if (!m_buf) {
+		if (m_lastError == 0) {
+			m_lastError = EIO;
+		}
+		return;
+	}
+	m_size = static_cast<size_t>(liSize.QuadPart);
+#else /* !_WIN32 */
+	int fd = ::open(m_filename.c_str(), O_RDONLY
+# ifdef O_CLOEXEC
+		| O_CLOEXEC
+# endif /* O_CLOEXEC */
+		);
+	if (fd < 0) {
+		m_lastError = errno;
+		return;
+	}
+
+	// Only regular files can be mapped.
+	struct stat sb;
+	if (fstat(fd, &sb) != 0) {
+		m_lastError = errno;
+		::close(fd);
+		return;
+	}
+	if (!S_ISREG(sb.st_mode) || sb.st_size <= 0 ||
+	    static_cast<uint64_t>(sb.st_size) > MMAP_MAX_SIZE)
+	{
+		// Devices and directories can't be mapped,
+		// empty files can't be mapped, and very large
+		// files might not fit in the address space.
+		m_lastError = (S_ISDIR(sb.st_mode) ? EISDIR : ENOTSUP);
+		::close(fd);
+		return;
+	}
+
+	// NOTE: The mapping remains valid after the
+	// file descriptor is closed.
+	void *const map = mmap(nullptr, static_cast<size_t>(sb.st_size),
+		PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (map == MAP_FAILED) {
+		m_lastError = errno;
+		return;
+	}
+	m_buf = map;
+	m_size = static_cast<size_t>(sb.st_size);
+#endif /* _WIN32 */
+}
+
+RpFile_mmap::~RpFile_mmap()
+{
+	close();
+}
+
+/**
+ * Open a local file for reading.
+ *
+ * The file is memory-mapped if possible. Otherwise, such as
+ * for devices, gzipped files, or if the mapping fails, an
+ * RpFile using FM_OPEN_READ_GZ is returned instead.
+ *
+ * @param filename Filename. (UTF-8)
+ * @return IRpFile (check isOpen() and lastError())
+ */
+IRpFile *RpFile_mmap::openReadOnly(const char *filename)
+{
+	RpFile_mmap *const mmapFile = new RpFile_mmap(filename);
+	if (mmapFile->isOpen()) {
+		// Gzipped files need transparent decompression,
+		// which is handled by RpFile.
+		const uint8_t *const buf = static_cast<const uint8_t*>(mmapFile->m_buf);
+		if (mmapFile->m_size < 2 || buf[0] != 0x1F || buf[1] != 0x8B) {
+			return mmapFile;
+		}
+	}
+
+	mmapFile->unref();
+	return new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
+}
+
+/**
+ * Close the file.
+ */
+void RpFile_mmap::close(void)
+{
+	if (m_buf) {
+#ifdef _WIN32
+		UnmapViewOfFile(m_buf);
+#else /* !_WIN32 */
+		munmap(const_cast<void*>(m_buf), m_size);
+#endif /* _WIN32 */
+		super::close();
+	}
+}
+
+/**
+ * Get the filename.
+ * @return Filename. (May be empty if the filename is not available.)
+ */
+string RpFile_mmap::filename(void) const
+{
+	return m_filename;
+}
+
+#ifndef _WIN32
+/** Access pattern hints **/
+
+/**
+ * Advise the file of the expected access pattern.
+ * @param pattern Access pattern.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFile_mmap::adviseAccess(AccessPattern pattern)
+{
+	if (!m_buf) {
+		return -EBADF;
+	}
+
+	int advice;
+	switch (pattern) {
+		default:
+		case AccessPattern::Normal:
+			advice = MADV_NORMAL;
+			break;
+		case AccessPattern::Sequential:
+		case AccessPattern::Streaming:
+			// NOTE: MADV_SEQUENTIAL allows the kernel to
+			// reclaim pages soon after they're accessed.
+			advice = MADV_SEQUENTIAL;
+			break;
+		case AccessPattern::Random:
+			advice = MADV_RANDOM;
+			break;
+	}
+
+	if (madvise(const_cast<void*>(m_buf), m_size, advice) != 0) {
+		return -errno;
+	}
+	return 0;
+}
+
+/**
+ * Hint that the specified ranges will be read soon.
+ * @param ranges	[in] File ranges.
+ * @param count		[in] Number of ranges.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFile_mmap::prefetchv(const Range *ranges, size_t count)
+{
+	assert(ranges != nullptr || count == 0);
+	if (!ranges && count > 0) {
+		return -EINVAL;
+	} else if (!m_buf) {
+		return -EBADF;
+	}
+
+	// madvise() requires a page-aligned address.
+	static const uintptr_t pageMask = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1;
+	const uintptr_t base = reinterpret_cast<uintptr_t>(m_buf);
+	for (; count > 0; ranges++, count--) {
+		if (ranges->size == 0 || ranges->pos < 0 ||
+		    static_cast<uint64_t>(ranges->pos) >= m_size)
+		{
+			continue;
+		}
+
+		const size_t size = std::min(ranges->size, m_size - static_cast<size_t>(ranges->pos));
+		const uintptr_t start = base + static_cast<uintptr_t>(ranges->pos);
+		const uintptr_t alignedStart = start & ~pageMask;
+		if (madvise(reinterpret_cast<void*>(alignedStart), size + (start - alignedStart), MADV_WILLNEED) != 0) {
+			return -errno;
+		}
+	}
+	return 0;
+}
+#endif /* !_WIN32 */
+
+}
@@ -0,0 +1,94 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpFile_mmap.hpp: Memory-mapped read-only file object.                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_RPFILE_MMAP_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_RPFILE_MMAP_HPP__
+
+#include "RpMemFile.hpp"
+
+namespace LibRpFile {
+
+class RpFile_mmap final : public RpMemFile
+{
+	public:
+		/**
+		 * Open a local file using a read-only memory mapping.
+		 *
+		 * Only regular files can be mapped. Check isOpen()
+		 * after construction; if it's false, use RpFile.
+		 *
+		 * NOTE: If the file is truncated by another process
+		 * while it's mapped, accessing the truncated area
+		 * may raise SIGBUS (POSIX) or an access violation (Win32).
+		 *
+		 * @param filename Filename. (UTF-8)
+		 */
+		explicit RpFile_mmap(const char *filename);
+		explicit RpFile_mmap(const std::string &filename);
+	private:
+		void init(void);
+	protected:
+		virtual ~RpFile_mmap();	// call unref() instead
+
+	private:
+		typedef RpMemFile super;
+		RP_DISABLE_COPY(RpFile_mmap)
+
+	public:
+		/**
+		 * Open a local file for reading.
+		 *
+		 * The file is memory-mapped if possible. Otherwise, such as
+		 * for devices, gzipped files, or if the mapping fails, an
+		 * RpFile using FM_OPEN_READ_GZ is returned instead.
+		 *
+		 * @param filename Filename. (UTF-8)
+		 * @return IRpFile (check isOpen() and lastError())
+		 */
+		static IRpFile *openReadOnly(const char *filename);
+
+	public:
+		/**
+		 * Close the file.
+		 */
+		void close(void) final;
+
+		/**
+		 * Get the filename.
+		 * @return Filename. (May be empty if the filename is not available.)
+		 */
+		std::string filename(void) const final;
+
+#ifndef _WIN32
+	public:
+		/** Access pattern hints **/
+
+		/**
+		 * Advise the file of the expected access pattern.
+		 * @param pattern Access pattern.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int adviseAccess(AccessPattern pattern) final;
+
+		/**
+		 * Hint that the specified ranges will be read soon.
+		 * @param ranges	[in] File ranges.
+		 * @param count		[in] Number of ranges.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		ATTR_ACCESS_SIZE(read_only, 2, 3)
+		int prefetchv(const Range *ranges, size_t count) final;
+#endif /* !_WIN32 */
+
+	private:
+		std::string m_filename;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_RPFILE_MMAP_HPP__ */
@@ -21,17 +21,8 @@
 using std::string;
 using std::vector;
 
-// zlib for transparent gzip decompression.
-#include <zlib.h>
-// gzclose_r() and gzclose_w() were introduced in zlib-1.2.4.
-#if (ZLIB_VER_MAJOR > 1) || \
-    (ZLIB_VER_MAJOR == 1 && ZLIB_VER_MINOR > 2) || \
-    (ZLIB_VER_MAJOR == 1 && ZLIB_VER_MINOR == 2 && ZLIB_VER_REVISION >= 4)
-// zlib-1.2.4 or later
-#else
-#  define gzclose_r(file) gzclose(file)
-#  define gzclose_w(file) gzclose(file)
-#endif
+// Transparent gzip decompression.
+#include "GzReader.hpp"
 
 #ifdef _WIN32
 // Windows SDK
@@ -74,10 +65,12 @@ class RpFilePrivate
 
 		RpFilePrivate(RpFile *q, const char *filename, RpFile::FileMode mode)
 			: q_ptr(q), file(INVALID_HANDLE_VALUE), filename(filename)
-			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr) { }
+			, mode(mode), gzReader(nullptr), gzsz(-1), devInfo(nullptr)
+			, streaming(false), streamDropPos(0) { }
 		RpFilePrivate(RpFile *q, const string &filename, RpFile::FileMode mode)
 			: q_ptr(q), file(INVALID_HANDLE_VALUE), filename(filename)
-			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr) { }
+			, mode(mode), gzReader(nullptr), gzsz(-1), devInfo(nullptr)
+			, streaming(false), streamDropPos(0) { }
 		~RpFilePrivate();
 
 	private:
@@ -89,9 +82,19 @@ class RpFilePrivate
 		string filename;	// Filename.
 		RpFile::FileMode mode;	// File mode.
 
-		gzFile gzfd;		// Used for transparent gzip decompression.
+		GzReader *gzReader;	// Used for transparent gzip decompression.
 		off64_t gzsz;		// Uncompressed file size.
 
+		/**
+		 * Read compressed data for gzReader.
+		 * @param userdata	[in] RpFilePrivate
+		 * @param pos		[in] Position in the compressed file.
+		 * @param ptr		[out] Output buffer.
+		 * @param size		[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		static size_t gzReadFunc(void *userdata, off64_t pos, void *ptr, size_t size);
+
 		// Device information struct.
 		// Only used if the underlying file
 		// is a device node.
@@ -102,8 +105,17 @@ class RpFilePrivate
 			bool isKreonUnlocked;	// Is Kreon mode unlocked?
 
 			// Sector cache.
-			uint8_t *sector_cache;	// Sector cache.
-			uint32_t lba_cache;	// Last LBA cached.
+			// Holds up to sector_cache_max contiguous sectors,
+			// starting at lba_cache.
+			uint8_t *sector_cache;		// Sector cache.
+			uint32_t lba_cache;		// First LBA cached.
+			uint32_t lba_cache_count;	// Number of LBAs cached.
+			uint32_t sector_cache_max;	// Maximum number of LBAs in the cache.
+			uint32_t lba_next;		// LBA following the last read. (for read-ahead)
+
+			// Sector cache size, in bytes.
+			// Large enough for 64 sectors on optical discs.
+			static const uint32_t SECTOR_CACHE_BYTES = 128*1024;
 
 			// OS-specific variables.
 #ifdef USING_FREEBSD_CAMLIB
@@ -117,6 +129,9 @@ class RpFilePrivate
 				, isKreonUnlocked(0)
 				, sector_cache(nullptr)
 				, lba_cache(~0U)
+				, lba_cache_count(0)
+				, sector_cache_max(0)
+				, lba_next(~0U)
 #ifdef USING_FREEBSD_CAMLIB
 				, cam(nullptr)
 #endif /* USING_FREEBSD_CAMLIB */
@@ -138,15 +153,42 @@ class RpFilePrivate
 				assert(sector_size <= 65536);
 				if (!sector_cache) {
 					if (sector_size >= 512 && sector_size <= 65536) {
-						sector_cache = new uint8_t[sector_size];
+						sector_cache_max = SECTOR_CACHE_BYTES / sector_size;
+						if (sector_cache_max == 0) {
+							sector_cache_max = 1;
+						}
+						sector_cache = new uint8_t[static_cast<size_t>(sector_cache_max) * sector_size];
 					}
 				}
 			}
 
+			/**
+			 * Is the specified LBA in the sector cache?
+			 * @param lba LBA.
+			 * @return True if it's cached; false if not.
+			 */
+			inline bool isLBACached(uint32_t lba) const
+			{
+				return (lba_cache != ~0U && lba >= lba_cache &&
+				        (lba - lba_cache) < lba_cache_count);
+			}
+
+			/**
+			 * Invalidate the sector cache.
+			 */
+			inline void invalidate_sector_cache(void)
+			{
+				lba_cache = ~0U;
+				lba_cache_count = 0;
+				lba_next = ~0U;
+			}
+
 			void close(void)
 			{
 				delete[] sector_cache;
 				sector_cache = nullptr;
+				sector_cache_max = 0;
+				invalidate_sector_cache();
 
 #ifdef USING_FREEBSD_CAMLIB
 				if (cam) {
@@ -159,6 +201,28 @@ class RpFilePrivate
 
 		DeviceInfo *devInfo;
 
+	public:
+		/** Streaming mode **/
+
+		// Minimum amount of data to accumulate before
+		// dropping it from the OS cache.
+		static const off64_t STREAM_DROP_SIZE = 8*1024*1024;
+
+		bool streaming;		// Set by AccessPattern::Streaming.
+		off64_t streamDropPos;	// Start of data that hasn't been dropped yet.
+
+		/**
+		 * Streaming mode: Drop data that has already been read
+		 * from the OS cache, so a single pass over a large file
+		 * doesn't evict everything else.
+		 *
+		 * Data is dropped in chunks of at least STREAM_DROP_SIZE
+		 * bytes to reduce the number of syscalls.
+		 *
+		 * @param endPos End of the data that has been read.
+		 */
+		void dropStreamedData(off64_t endPos);
+
 	public:
 #ifdef _WIN32
 		/**
@@ -188,7 +252,7 @@ class RpFilePrivate
 		/**
 		 * (Re-)Open the main file.
 		 *
-		 * INTERNAL FUNCTION. This does NOT affect gzfd.
+		 * INTERNAL FUNCTION. This does NOT affect gzReader.
 		 * NOTE: This function sets q->m_lastError.
 		 *
 		 * Uses parameters stored in this->filename and this->mode.
@@ -198,11 +262,28 @@ class RpFilePrivate
 
 	public:
 		/**
-		 * Read one sector into the sector cache.
+		 * Read sectors from the device.
+		 * Kreon drives use SCSI READ(10); otherwise, the OS API is used.
+		 * NOTE: This function sets q->m_lastError on error.
+		 * @param lba		[in] First LBA to read.
+		 * @param lbaCount	[in] Number of LBAs to read.
+		 * @param pBuf		[out] Output buffer. (must be at least lbaCount * sector_size bytes)
+		 * @return 0 on success; non-zero on error.
+		 */
+		int readLBAs(uint32_t lba, uint32_t lbaCount, uint8_t *pBuf);
+
+		/**
+		 * Make sure the specified LBA is in the sector cache.
+		 *
+		 * On a cache miss, multiple sectors are read starting at lba.
+		 * If the miss continues the previous read, the entire cache
+		 * is filled (read-ahead); otherwise, half of it is filled.
+		 *
+		 * NOTE: This function sets q->m_lastError on error.
 		 * @param lba LBA to read.
 		 * @return 0 on success; non-zero on error.
 		 */
-		int readOneLBA(uint32_t lba);
+		int fillSectorCache(uint32_t lba);
 
 		/**
 		 * Read using block reads.
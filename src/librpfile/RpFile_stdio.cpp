@@ -15,11 +15,12 @@
 
 #include "RpFile.hpp"
 #include "RpFile_p.hpp"
+#include "RpStats.hpp"
 
 // C includes.
 #include <fcntl.h>	// AT_EMPTY_PATH
 #include <sys/stat.h>	// stat(), statx()
-#include <unistd.h>	// ftruncate()
+#include <unistd.h>	// ftruncate(), pread()
 
 namespace LibRpFile {
 
@@ -27,15 +28,64 @@ namespace LibRpFile {
 
 RpFilePrivate::~RpFilePrivate()
 {
-	if (gzfd != 0) {
-		gzclose_r(gzfd);
-	}
+	delete gzReader;
 	if (file) {
 		fclose(file);
 	}
 	delete devInfo;
 }
 
+/**
+ * Read compressed data for gzReader.
+ * @param userdata	[in] RpFilePrivate
+ * @param pos		[in] Position in the compressed file.
+ * @param ptr		[out] Output buffer.
+ * @param size		[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpFilePrivate::gzReadFunc(void *userdata, off64_t pos, void *ptr, size_t size)
+{
+	RpFilePrivate *const d = static_cast<RpFilePrivate*>(userdata);
+	if (fseeko(d->file, pos, SEEK_SET) != 0) {
+		return 0;
+	}
+	const size_t ret = fread(ptr, 1, size, d->file);
+	if (d->streaming) {
+		d->dropStreamedData(pos + ret);
+	}
+	return ret;
+}
+
+/**
+ * Streaming mode: Drop data that has already been read
+ * from the OS cache, so a single pass over a large file
+ * doesn't evict everything else.
+ *
+ * Data is dropped in chunks of at least STREAM_DROP_SIZE
+ * bytes to reduce the number of syscalls.
+ *
+ * @param endPos End of the data that has been read.
+ */
+void RpFilePrivate::dropStreamedData(off64_t endPos)
+{
+#ifdef HAVE_POSIX_FADVISE
+	if (endPos < streamDropPos) {
+		// Seeked backwards. Start over from here.
+		streamDropPos = endPos;
+		return;
+	} else if (endPos - streamDropPos < STREAM_DROP_SIZE) {
+		// Not enough data yet.
+		return;
+	}
+
+	// NOTE: Errors are ignored, since this is only a hint.
+	posix_fadvise(fileno(file), streamDropPos, endPos - streamDropPos, POSIX_FADV_DONTNEED);
+	streamDropPos = endPos;
+#else /* !HAVE_POSIX_FADVISE */
+	RP_UNUSED(endPos);
+#endif /* HAVE_POSIX_FADVISE */
+}
+
 /**
  * Convert an RpFile::FileMode to an fopen() mode string.
  * @param mode	[in] FileMode
@@ -60,7 +110,7 @@ inline const char *RpFilePrivate::mode_to_str(RpFile::FileMode mode)
 /**
  * (Re-)Open the main file.
  *
- * INTERNAL FUNCTION. This does NOT affect gzfd.
+ * INTERNAL FUNCTION. This does NOT affect gzReader.
  * NOTE: This function sets q->m_lastError.
  *
  * Uses parameters stored in this->filename and this->mode.
@@ -270,29 +320,22 @@ void RpFile::init(void)
 						// TODO: Add better verification heuristics?
 						d->gzsz = (off64_t)uncomp_sz;
 
-						// Make sure the CRC32 table is initialized.
-						get_crc_table();
-
-						// Open the file with gzdopen().
-						::rewind(d->file);
-						::fflush(d->file);
-						int gzfd_dup = ::dup(fileno(d->file));
-						if (gzfd_dup >= 0) {
-							d->gzfd = gzdopen(gzfd_dup, "r");
-							if (d->gzfd) {
-								m_isCompressed = true;
-							} else {
-								// gzdopen() failed.
-								// Close the dup()'d handle to prevent a leak.
-								::close(gzfd_dup);
-							}
+						// Use random-access gzip decompression.
+						// NOTE: GzReader accesses d->file directly.
+						d->gzReader = new GzReader(RpFilePrivate::gzReadFunc, d);
+						if (d->gzReader->isOpen()) {
+							m_isCompressed = true;
+						} else {
+							// Error initializing the decompressor.
+							delete d->gzReader;
+							d->gzReader = nullptr;
 						}
 					}
 				}
 			}
 		}
 
-		if (!d->gzfd) {
+		if (!d->gzReader) {
 			// Not a gzipped file.
 			// Rewind and flush the file.
 			::rewind(d->file);
@@ -332,10 +375,8 @@ void RpFile::close(void)
 		d->devInfo->close();
 	}
 
-	if (d->gzfd != 0) {
-		gzclose_r(d->gzfd);
-		d->gzfd = nullptr;
-	}
+	delete d->gzReader;
+	d->gzReader = nullptr;
 	if (d->file) {
 		fclose(d->file);
 		d->file = nullptr;
@@ -358,18 +399,18 @@ size_t RpFile::read(void *ptr, size_t size)
 
 	if (d->devInfo) {
 		// Block device. Need to read in multiples of the block size.
-		return d->readUsingBlocks(ptr, size);
+		const size_t ret = d->readUsingBlocks(ptr, size);
+		RpStats::add(RpStats::BYTES_READ_FILE, ret);
+		return ret;
 	}
 
 	size_t ret;
-	if (d->gzfd != 0) {
-		int iret = gzread(d->gzfd, ptr, size);
-		if (iret >= 0) {
-			ret = (size_t)iret;
-		} else {
+	if (d->gzReader) {
+		// NOTE: GzReader counts decompressed bytes itself.
+		ret = d->gzReader->read(ptr, size);
+		if (ret != size && d->gzReader->lastError() != 0) {
 			// An error occurred.
-			ret = 0;
-			m_lastError = errno;
+			m_lastError = d->gzReader->lastError();
 		}
 	} else {
 		ret = fread(ptr, 1, size, d->file);
@@ -377,10 +418,83 @@ size_t RpFile::read(void *ptr, size_t size)
 			// An error occurred.
 			m_lastError = errno;
 		}
+		RpStats::add(RpStats::BYTES_READ_FILE, ret);
+		if (d->streaming) {
+			d->dropStreamedData(ftello(d->file));
+		}
+	}
+	return ret;
+}
+
+/**
+ * Read data from the specified file position.
+ * Uncompressed files are read without using the file position.
+ *
+ * NOTE: The file position is undefined afterwards.
+ *
+ * @param pos	[in] File position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	RP_D(RpFile);
+	if (!d->file) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	if (d->devInfo || d->gzReader || (d->mode & FM_WRITE)) {
+		// Device files and compressed files have to be read
+		// using read(). Writable files might have buffered
+		// writes that pread() wouldn't see.
+		return seekAndRead(pos, ptr, size);
+	}
+
+	// NOTE: Streamed data isn't dropped here, since
+	// pread() may be called from multiple threads.
+	const int fd = fileno(d->file);
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t ret = 0;
+	while (size > 0) {
+		const ssize_t sz_read = ::pread(fd, ptr8, size, pos);
+		if (sz_read < 0) {
+			if (errno == EINTR)
+				continue;
+			// An error occurred.
+			m_lastError = errno;
+			break;
+		} else if (sz_read == 0) {
+			// End of file.
+			break;
+		}
+
+		ptr8 += sz_read;
+		pos += sz_read;
+		size -= sz_read;
+		ret += sz_read;
 	}
+	RpStats::add(RpStats::BYTES_READ_FILE, ret);
 	return ret;
 }
 
+/**
+ * Read data from multiple file positions.
+ * Nearby requests are coalesced into a single read.
+ *
+ * NOTE: The file position is undefined afterwards.
+ *
+ * @param vec	[in] Read requests.
+ * @param count	[in] Number of read requests.
+ * @return 0 if all requests were read completely; negative POSIX error code on error.
+ */
+int RpFile::readv(const ReadVec *vec, size_t count)
+{
+	// Reading a few extra KB is cheaper than an extra seek.
+	return readv_coalesced(vec, count, 16*1024);
+}
+
 /**
  * Write data to the file.
  * @param ptr Input data buffer.
@@ -433,17 +547,10 @@ int RpFile::seek(off64_t pos)
 	}
 
 	int ret;
-	if (d->gzfd != 0) {
-		errno = 0;
-		z_off_t zret = gzseek(d->gzfd, pos, SEEK_SET);
-		if (zret >= 0) {
-			ret = 0;
-		} else {
-			ret = -1;
-			m_lastError = -errno;
-			if (m_lastError == 0) {
-				m_lastError = -EIO;
-			}
+	if (d->gzReader) {
+		ret = d->gzReader->seek(pos);
+		if (ret != 0) {
+			m_lastError = d->gzReader->lastError();
 		}
 	} else {
 		ret = fseeko(d->file, pos, SEEK_SET);
@@ -467,8 +574,8 @@ off64_t RpFile::tell(void)
 		return -1;
 	}
 
-	if (d->gzfd != 0) {
-		return (off64_t)gztell(d->gzfd);
+	if (d->gzReader) {
+		return d->gzReader->tell();
 	}
 	return ftello(d->file);
 }
@@ -560,7 +667,7 @@ off64_t RpFile::size(void)
 	if (d->devInfo) {
 		// Block device. Use the cached device size.
 		return d->devInfo->device_size;
-	} else if (d->gzfd != 0) {
+	} else if (d->gzReader) {
 		// gzipped files have the uncompressed size stored
 		// at the end of the stream.
 		return d->gzsz;
@@ -641,4 +748,107 @@ bool RpFile::isDevice(void) const
 	return d->devInfo;
 }
 
+/** Asynchronous I/O **/
+
+/**
+ * Get the POSIX file descriptor for direct reads.
+ * @return File descriptor, or -1 if not supported.
+ */
+int RpFile::nativeFd(void) const
+{
+	RP_D(const RpFile);
+	if (!d->file || d->gzReader || d->devInfo) {
+		// Compressed files and device files must be
+		// read using the IRpFile functions.
+		return -1;
+	}
+	return fileno(d->file);
+}
+
+/** Access pattern hints **/
+
+/**
+ * Advise the file of the expected access pattern.
+ * @param pattern Access pattern.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFile::adviseAccess(AccessPattern pattern)
+{
+#ifdef HAVE_POSIX_FADVISE
+	RP_D(RpFile);
+	if (!d->file) {
+		return -EBADF;
+	}
+
+	// NOTE: For compressed files, this applies to the
+	// compressed data, which is still read in order.
+	int advice;
+	switch (pattern) {
+		default:
+		case AccessPattern::Normal:
+			advice = POSIX_FADV_NORMAL;
+			break;
+		case AccessPattern::Sequential:
+		case AccessPattern::Streaming:
+			advice = POSIX_FADV_SEQUENTIAL;
+			break;
+		case AccessPattern::Random:
+			advice = POSIX_FADV_RANDOM;
+			break;
+	}
+
+	// Streaming mode: Data is dropped from the OS cache after
+	// it's read. This isn't done for device nodes, since
+	// they're read using the sector cache.
+	// NOTE: O_DIRECT isn't used, since it requires aligned
+	// buffers and bypasses stdio buffering entirely.
+	const bool streaming = (pattern == AccessPattern::Streaming && !d->devInfo);
+	if (streaming && !d->streaming) {
+		const off64_t pos = ftello(d->file);
+		d->streamDropPos = (pos >= 0 ? pos : 0);
+	}
+	d->streaming = streaming;
+
+	// NOTE: posix_fadvise() returns a positive error code.
+	return -posix_fadvise(fileno(d->file), 0, 0, advice);
+#else /* !HAVE_POSIX_FADVISE */
+	RP_UNUSED(pattern);
+	return 0;
+#endif /* HAVE_POSIX_FADVISE */
+}
+
+/**
+ * Hint that the specified ranges will be read soon.
+ * @param ranges	[in] File ranges.
+ * @param count		[in] Number of ranges.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpFile::prefetchv(const Range *ranges, size_t count)
+{
+	assert(ranges != nullptr || count == 0);
+	if (!ranges && count > 0) {
+		return -EINVAL;
+	}
+
+#ifdef HAVE_POSIX_FADVISE
+	const int fd = nativeFd();
+	if (fd < 0) {
+		// Compressed files and device files don't map
+		// file positions directly to the OS file.
+		return 0;
+	}
+
+	for (; count > 0; ranges++, count--) {
+		if (ranges->size == 0)
+			continue;
+		// NOTE: posix_fadvise() returns a positive error code.
+		const int ret = posix_fadvise(fd, ranges->pos, ranges->size, POSIX_FADV_WILLNEED);
+		if (ret != 0) {
+			return -ret;
+		}
+	}
+#endif /* HAVE_POSIX_FADVISE */
+	return 0;
+}
+
 }
@@ -8,6 +8,7 @@
 
 #include "stdafx.h"
 #include "RpMemFile.hpp"
+#include "RpStats.hpp"
 
 // C++ STL classes.
 using std::string;
@@ -38,6 +39,63 @@ RpMemFile::RpMemFile(const void *buf, size_t size)
 	}
 }
 
+/**
+ * Open an IRpFile backed by memory, taking ownership of the buffer.
+ * The resulting IRpFile is read-only.
+ *
+ * The buffer is moved into this object, so it isn't copied,
+ * and it's freed when the file is closed.
+ *
+ * @param buf Memory buffer. (will be empty on return)
+ */
+RpMemFile::RpMemFile(ao::uvector<uint8_t> &&buf)
+	: super()
+	, m_buf(nullptr)
+	, m_size(0)
+	, m_pos(0)
+	, m_ownedVec(std::move(buf))
+{
+	assert(!m_ownedVec.empty());
+	if (m_ownedVec.empty()) {
+		// No buffer specified.
+		m_lastError = EBADF;
+		return;
+	}
+
+	m_buf = m_ownedVec.data();
+	m_size = m_ownedVec.size();
+}
+
+/**
+ * Open an IRpFile backed by memory, taking ownership of the buffer.
+ * The resulting IRpFile is read-only.
+ *
+ * The buffer is moved into this object, so it isn't copied,
+ * and it's freed when the file is closed.
+ *
+ * @param buf Memory buffer. (will be nullptr on return)
+ * @param size Size of memory buffer.
+ */
+RpMemFile::RpMemFile(std::unique_ptr<uint8_t[]> &&buf, size_t size)
+	: super()
+	, m_buf(nullptr)
+	, m_size(0)
+	, m_pos(0)
+	, m_ownedBuf(std::move(buf))
+{
+	assert(m_ownedBuf != nullptr);
+	assert(size != 0);
+	if (!m_ownedBuf || size == 0) {
+		// No buffer specified.
+		m_ownedBuf.reset();
+		m_lastError = EBADF;
+		return;
+	}
+
+	m_buf = m_ownedBuf.get();
+	m_size = size;
+}
+
 /**
  * Internal constructor for use by subclasses.
  * This initializes everything to nullptr.
@@ -57,6 +115,11 @@ void RpMemFile::close(void)
 	m_buf = nullptr;
 	m_size = 0;
 	m_pos = 0;
+
+	// Free the owned buffer, if any.
+	m_ownedVec.clear();
+	m_ownedVec.shrink_to_fit();
+	m_ownedBuf.reset();
 }
 
 /**
@@ -89,6 +152,42 @@ size_t RpMemFile::read(void *ptr, size_t size)
 	const uint8_t *const buf = static_cast<const uint8_t*>(m_buf);
 	memcpy(ptr, &buf[m_pos], size);
 	m_pos += size;
+	RpStats::add(RpStats::BYTES_READ_MEM, size);
+	return size;
+}
+
+/**
+ * Read data from the specified file position.
+ * The file position is not changed.
+ * @param pos	[in] File position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpMemFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	if (!m_buf) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	if (unlikely(size == 0) || pos < 0 || static_cast<uint64_t>(pos) >= m_size) {
+		// Nothing to read.
+		return 0;
+	}
+
+	// Check if size is in bounds.
+	const size_t avail = m_size - static_cast<size_t>(pos);
+	if (size > avail) {
+		// Not enough data.
+		// Copy whatever's left in the buffer.
+		size = avail;
+	}
+
+	// Copy the data.
+	const uint8_t *const buf = static_cast<const uint8_t*>(m_buf);
+	memcpy(ptr, &buf[static_cast<size_t>(pos)], size);
+	RpStats::add(RpStats::BYTES_READ_MEM, size);
 	return size;
 }
 
@@ -188,4 +287,34 @@ string RpMemFile::filename(void) const
 	return string();
 }
 
+/** Zero-copy access **/
+
+/**
+ * Get a read-only pointer to the file data at the specified position.
+ * The pointer remains valid until the file is closed.
+ * The file position is not changed.
+ *
+ * @param pos	[in] File position.
+ * @param pSize	[in/out] Requested size; on return, the number of bytes available. (may be less at EOF)
+ * @return Pointer to the file data, or nullptr if pos is out of range.
+ */
+const uint8_t *RpMemFile::view(off64_t pos, size_t *pSize)
+{
+	assert(pSize != nullptr);
+	if (!m_buf) {
+		m_lastError = EBADF;
+		return nullptr;
+	} else if (!pSize || pos < 0 || static_cast<uint64_t>(pos) >= m_size) {
+		// Out of range.
+		return nullptr;
+	}
+
+	const size_t avail = m_size - static_cast<size_t>(pos);
+	if (*pSize > avail) {
+		*pSize = avail;
+	}
+	RpStats::add(RpStats::BYTES_READ_MEM, *pSize);
+	return static_cast<const uint8_t*>(m_buf) + static_cast<size_t>(pos);
+}
+
 }
@@ -10,6 +10,10 @@
 #define __ROMPROPERTIES_LIBRPFILE_RPMEMFILE_HPP__
 
 #include "IRpFile.hpp"
+#include "librpbase/uvector.h"
+
+// C++ includes.
+#include <memory>
 
 namespace LibRpFile {
 
@@ -28,6 +32,29 @@ class RpMemFile : public IRpFile
 		 */
 		ATTR_ACCESS_SIZE(read_only, 2, 3)
 		RpMemFile(const void *buf, size_t size);
+
+		/**
+		 * Open an IRpFile backed by memory, taking ownership of the buffer.
+		 * The resulting IRpFile is read-only.
+		 *
+		 * The buffer is moved into this object, so it isn't copied,
+		 * and it's freed when the file is closed.
+		 *
+		 * @param buf Memory buffer. (will be empty on return)
+		 */
+		explicit RpMemFile(ao::uvector<uint8_t> &&buf);
+
+		/**
+		 * Open an IRpFile backed by memory, taking ownership of the buffer.
+		 * The resulting IRpFile is read-only.
+		 *
+		 * The buffer is moved into this object, so it isn't copied,
+		 * and it's freed when the file is closed.
+		 *
+		 * @param buf Memory buffer. (will be nullptr on return)
+		 * @param size Size of memory buffer.
+		 */
+		RpMemFile(std::unique_ptr<uint8_t[]> &&buf, size_t size);
 	protected:
 		/**
 		 * Internal constructor for use by subclasses.
@@ -66,6 +93,17 @@ class RpMemFile : public IRpFile
 		ATTR_ACCESS_SIZE(write_only, 2, 3)
 		size_t read(void *ptr, size_t size) final;
 
+		/**
+		 * Read data from the specified file position.
+		 * The file position is not changed.
+		 * @param pos	[in] File position.
+		 * @param ptr	[out] Output data buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		ATTR_ACCESS_SIZE(write_only, 3, 4)
+		size_t pread(off64_t pos, void *ptr, size_t size) final;
+
 		/**
 		 * Write data to the file.
 		 * (NOTE: Not valid for RpMemFile; this will always return 0.)
@@ -110,12 +148,32 @@ class RpMemFile : public IRpFile
 		 * Get the filename.
 		 * @return Filename. (May be empty if the filename is not available.)
 		 */
-		std::string filename(void) const final;
+		std::string filename(void) const override;
+
+	public:
+		/** Zero-copy access **/
+
+		/**
+		 * Get a read-only pointer to the file data at the specified position.
+		 * The pointer remains valid until the file is closed.
+		 * The file position is not changed.
+		 *
+		 * @param pos	[in] File position.
+		 * @param pSize	[in/out] Requested size; on return, the number of bytes available. (may be less at EOF)
+		 * @return Pointer to the file data, or nullptr if pos is out of range.
+		 */
+		ATTR_ACCESS(read_write, 3)
+		const uint8_t *view(off64_t pos, size_t *pSize) final;
 
 	protected:
 		const void *m_buf;	// Memory buffer.
 		size_t m_size;		// Size of memory buffer.
 		size_t m_pos;		// Current position.
+
+	private:
+		// Owned memory buffers. (only one is used)
+		ao::uvector<uint8_t> m_ownedVec;
+		std::unique_ptr<uint8_t[]> m_ownedBuf;
 };
 
 }
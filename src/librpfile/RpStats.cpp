@@ -0,0 +1,86 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpStats.cpp: Process-wide runtime statistics counters.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpStats.hpp"
+
+// librpthreads
+#include "librpthreads/Atomics.h"
+
+namespace LibRpFile { namespace RpStats {
+
+#ifdef _MSC_VER
+typedef __int64 counter_t;
+#else /* !_MSC_VER */
+typedef int64_t counter_t;
+#endif /* _MSC_VER */
+
+// Counter values.
+static volatile counter_t counters[COUNTER_MAX];
+
+// Counter names.
+static const char *const counter_names[COUNTER_MAX] = {
+	"bytes_read_file",
+	"bytes_read_gzip",
+	"bytes_read_mem",
+
+	"cache_hits",
+	"cache_misses",
+	"downloads_attempted",
+	"downloads_skipped",
+
+	"block_cache_hits",
+	"block_cache_misses",
+
+	"aes_bytes_decrypted",
+};
+
+/**
+ * Add a value to a counter.
+ * @param counter Counter.
+ * @param value Value to add.
+ */
+void add(Counter counter, int64_t value)
+{
+	assert(counter >= 0 && counter < COUNTER_MAX);
+	if (unlikely(counter < 0 || counter >= COUNTER_MAX))
+		return;
+	ATOMIC_ADD_FETCH64(&counters[counter], value);
+}
+
+/**
+ * Get the current value of a counter.
+ * @param counter Counter.
+ * @return Counter value, or 0 if the counter is invalid.
+ */
+int64_t get(Counter counter)
+{
+	assert(counter >= 0 && counter < COUNTER_MAX);
+	if (unlikely(counter < 0 || counter >= COUNTER_MAX))
+		return 0;
+	// NOTE: Adding 0 to ensure 64-bit reads aren't torn on 32-bit systems.
+	return ATOMIC_ADD_FETCH64(&counters[counter], 0);
+}
+
+/**
+ * Get the name of a counter.
+ * Names are lowercase identifiers suitable for machine-readable output,
+ * e.g. "bytes_read_file".
+ * @param counter Counter.
+ * @return Counter name, or nullptr if the counter is invalid.
+ */
+const char *name(Counter counter)
+{
+	static_assert(ARRAY_SIZE(counter_names) == COUNTER_MAX, "counter_names[] is out of sync with Counter");
+	assert(counter >= 0 && counter < COUNTER_MAX);
+	if (unlikely(counter < 0 || counter >= COUNTER_MAX))
+		return nullptr;
+	return counter_names[counter];
+}
+
+} }
@@ -0,0 +1,73 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpStats.hpp: Process-wide runtime statistics counters.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_RPSTATS_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_RPSTATS_HPP__
+
+// C includes.
+#include <stdint.h>
+
+namespace LibRpFile { namespace RpStats {
+
+/**
+ * Statistics counters.
+ * All counters are process-wide and monotonically increasing.
+ */
+enum Counter {
+	BYTES_READ_FILE,	// Bytes read from RpFile. (uncompressed files and devices)
+	BYTES_READ_GZIP,	// Bytes decompressed by GzReader.
+	BYTES_READ_MEM,		// Bytes read or viewed from RpMemFile/RpFile_mmap.
+
+	CACHE_HITS,		// CacheManager: File found in the local cache.
+	CACHE_MISSES,		// CacheManager: File not found in the local cache.
+	DOWNLOADS_ATTEMPTED,	// CacheManager: rp-download was executed.
+	DOWNLOADS_SKIPPED,	// CacheManager: Download skipped due to the negative cache.
+
+	BLOCK_CACHE_HITS,	// SparseDiscReader: Block found in the block cache.
+	BLOCK_CACHE_MISSES,	// SparseDiscReader: Block not found in the block cache.
+
+	AES_BYTES_DECRYPTED,	// IAesCipher: Bytes decrypted.
+
+	COUNTER_MAX
+};
+
+/**
+ * Add a value to a counter.
+ * @param counter Counter.
+ * @param value Value to add.
+ */
+void add(Counter counter, int64_t value);
+
+/**
+ * Increment a counter.
+ * @param counter Counter.
+ */
+static inline void inc(Counter counter)
+{
+	add(counter, 1);
+}
+
+/**
+ * Get the current value of a counter.
+ * @param counter Counter.
+ * @return Counter value, or 0 if the counter is invalid.
+ */
+int64_t get(Counter counter);
+
+/**
+ * Get the name of a counter.
+ * Names are lowercase identifiers suitable for machine-readable output,
+ * e.g. "bytes_read_file".
+ * @param counter Counter.
+ * @return Counter name, or nullptr if the counter is invalid.
+ */
+const char *name(Counter counter);
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_RPSTATS_HPP__ */
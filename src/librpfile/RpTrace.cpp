@@ -0,0 +1,81 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpTrace.cpp: Hot-path tracing probes.                                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpTrace.hpp"
+
+// USDT probes are header-only.
+// Only the Windows TraceLogging provider needs an implementation.
+#if defined(RP_TRACE_ENABLED) && defined(_WIN32)
+
+// TraceLogging
+#include <TraceLoggingProvider.h>
+
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
+// C includes.
+#include <stdlib.h>	/* atexit() */
+
+// "RomProperties" provider.
+// {09510676-c09b-4980-a7a6-34cc2f316626}
+TRACELOGGING_DEFINE_PROVIDER(
+	rp_trace_provider,
+	"RomProperties",
+	(0x09510676, 0xc09b, 0x4980, 0xa7, 0xa6, 0x34, 0xcc, 0x2f, 0x31, 0x66, 0x26));
+
+namespace LibRpFile { namespace RpTrace {
+
+static pthread_once_t once_control = PTHREAD_ONCE_INIT;
+
+/**
+ * Unregister the TraceLogging provider.
+ * Called by atexit().
+ */
+static void RP_C_API unregisterProvider(void)
+{
+	TraceLoggingUnregister(rp_trace_provider);
+}
+
+/**
+ * Register the TraceLogging provider.
+ * Called by pthread_once().
+ */
+static void registerProvider(void)
+{
+	if (SUCCEEDED(TraceLoggingRegister(rp_trace_provider))) {
+		atexit(unregisterProvider);
+	}
+}
+
+/**
+ * Emit a "ZoneBegin" event.
+ * The TraceLogging provider is registered on first use.
+ * @param name Zone name.
+ */
+void zoneBegin(const char *name)
+{
+	pthread_once(&once_control, registerProvider);
+	TraceLoggingWrite(rp_trace_provider, "ZoneBegin",
+		TraceLoggingString(name, "Zone"));
+}
+
+/**
+ * Emit a "ZoneEnd" event.
+ * @param name Zone name.
+ */
+void zoneEnd(const char *name)
+{
+	// NOTE: zoneBegin() has already registered the provider.
+	TraceLoggingWrite(rp_trace_provider, "ZoneEnd",
+		TraceLoggingString(name, "Zone"));
+}
+
+} }
+
+#endif /* RP_TRACE_ENABLED && _WIN32 */
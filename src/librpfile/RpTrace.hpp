@@ -0,0 +1,106 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpTrace.hpp: Hot-path tracing probes.                                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_RPTRACE_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_RPTRACE_HPP__
+
+#include "config.librpfile.h"
+
+// common macros
+#include "common.h"
+
+/**
+ * Scoped tracing zones for hot paths.
+ *
+ * Tracing is only compiled in if ENABLE_TRACING is set.
+ * Otherwise, RP_TRACE_ZONE() expands to nothing.
+ *
+ * Linux: USDT probes "romprops:zone_begin" and "romprops:zone_end",
+ * with the zone name as the only argument. Use e.g.:
+ *   bpftrace -e 'usdt:./librpbase.so:romprops:zone_begin { ... }'
+ * or `perf probe sdt_romprops:zone_begin`.
+ *
+ * Windows: TraceLogging events "ZoneBegin" and "ZoneEnd" from the
+ * "RomProperties" provider, with the zone name as a string field.
+ */
+
+#if defined(ENABLE_TRACING) && (defined(_WIN32) || defined(HAVE_SYS_SDT_H))
+# define RP_TRACE_ENABLED 1
+#endif
+
+#ifdef RP_TRACE_ENABLED
+
+#ifdef _WIN32
+namespace LibRpFile { namespace RpTrace {
+
+/**
+ * Emit a "ZoneBegin" event.
+ * The TraceLogging provider is registered on first use.
+ * @param name Zone name.
+ */
+void zoneBegin(const char *name);
+
+/**
+ * Emit a "ZoneEnd" event.
+ * @param name Zone name.
+ */
+void zoneEnd(const char *name);
+
+} }
+# define RP_TRACE_BEGIN(name)	LibRpFile::RpTrace::zoneBegin(name)
+# define RP_TRACE_END(name)	LibRpFile::RpTrace::zoneEnd(name)
+#else /* !_WIN32 */
+# include <sys/sdt.h>
+# define RP_TRACE_BEGIN(name)	DTRACE_PROBE1(romprops, zone_begin, name)
+# define RP_TRACE_END(name)	DTRACE_PROBE1(romprops, zone_end, name)
+#endif /* _WIN32 */
+
+namespace LibRpFile {
+
+/**
+ * Scoped tracing zone.
+ * Emits a begin event on construction and an end event on destruction.
+ */
+class RpTraceZone
+{
+	public:
+		explicit RpTraceZone(const char *zoneName)
+			: name(zoneName)
+		{
+			RP_TRACE_BEGIN(name);
+		}
+
+		~RpTraceZone()
+		{
+			RP_TRACE_END(name);
+		}
+
+	private:
+		RP_DISABLE_COPY(RpTraceZone)
+		const char *const name;
+};
+
+}
+
+#define RP_TRACE_ZONE_CONCAT2(a, b) a##b
+#define RP_TRACE_ZONE_CONCAT(a, b) RP_TRACE_ZONE_CONCAT2(a, b)
+
+/**
+ * Trace the current scope.
+ * @param name Zone name. (must be a string that outlives the scope, e.g. __func__)
+ */
+#define RP_TRACE_ZONE(name) \
+	LibRpFile::RpTraceZone RP_TRACE_ZONE_CONCAT(_rp_trace_zone_, __LINE__)(name)
+
+#else /* !RP_TRACE_ENABLED */
+
+#define RP_TRACE_ZONE(name) do { } while (0)
+
+#endif /* RP_TRACE_ENABLED */
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_RPTRACE_HPP__ */
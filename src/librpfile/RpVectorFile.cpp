@@ -29,6 +29,23 @@ RpVectorFile::RpVectorFile()
 	m_isWritable = true;
 }
 
+/**
+ * Open an IRpFile backed by an existing std::vector.
+ * The resulting IRpFile is writable.
+ *
+ * The vector is moved into this object, so it isn't copied.
+ *
+ * @param vec std::vector. (will be empty on return)
+ */
+RpVectorFile::RpVectorFile(std::vector<uint8_t> &&vec)
+	: super()
+	, m_vector(std::move(vec))
+	, m_pos(0)
+{
+	// RpVectorFile is writable.
+	m_isWritable = true;
+}
+
 /**
  * Read data from the file.
  * @param ptr Output data buffer.
@@ -24,6 +24,16 @@ class RpVectorFile final : public IRpFile
 		 * The resulting IRpFile is writable.
 		 */
 		RpVectorFile();
+
+		/**
+		 * Open an IRpFile backed by an existing std::vector.
+		 * The resulting IRpFile is writable.
+		 *
+		 * The vector is moved into this object, so it isn't copied.
+		 *
+		 * @param vec std::vector. (will be empty on return)
+		 */
+		explicit RpVectorFile(std::vector<uint8_t> &&vec);
 	protected:
 		virtual ~RpVectorFile() { }	// call unref() instead
 
@@ -22,11 +22,15 @@
 namespace LibRpFile {
 
 /**
- * Read one sector into the sector cache.
- * @param lba LBA to read.
+ * Read sectors from the device.
+ * Kreon drives use SCSI READ(10); otherwise, the OS API is used.
+ * NOTE: This function sets q->m_lastError on error.
+ * @param lba		[in] First LBA to read.
+ * @param lbaCount	[in] Number of LBAs to read.
+ * @param pBuf		[out] Output buffer. (must be at least lbaCount * sector_size bytes)
  * @return 0 on success; non-zero on error.
  */
-int RpFilePrivate::readOneLBA(uint32_t lba)
+int RpFilePrivate::readLBAs(uint32_t lba, uint32_t lbaCount, uint8_t *pBuf)
 {
 	if (!devInfo) {
 		// Not a device.
@@ -42,86 +46,132 @@ int RpFilePrivate::readOneLBA(uint32_t lba)
 	//
 	// TODO: Not sure about NetBSD...
 	RP_Q(RpFile);
-	if (lba == devInfo->lba_cache) {
-		// This LBA is already cached.
-		// TODO: Special case for ~0U?
-		if (!devInfo->isKreonUnlocked) {
-			// OSAPI: Seek to the next sector.
-			const off64_t seek_pos = (static_cast<off64_t>(lba) + 1) * devInfo->sector_size;
-#ifdef _WIN32
-			LARGE_INTEGER liSeekPos;
-			liSeekPos.QuadPart = seek_pos;
-			BOOL bRet = SetFilePointerEx(file, liSeekPos, nullptr, FILE_BEGIN);
-			if (!bRet) {
-				// Seek error.
-				q->m_lastError = w32err_to_posix(GetLastError());
-				return -q->m_lastError;
-			}
-#else /* !_WIN32 */
-			int ret = fseeko(file, seek_pos, SEEK_SET);
-			if (ret != 0) {
-				// Seek error.
-				q->m_lastError = errno;
-				return -q->m_lastError;
+	const uint32_t sector_size = devInfo->sector_size;
+	if (devInfo->isKreonUnlocked) {
+		// Kreon drive. Use SCSI commands.
+		// NOTE: Reading up to 65535 LBAs at a time due to READ(10) limitations.
+		// FIXME: Seems to have issues above a certain number of LBAs on Linux...
+		// Reducing it to 64 KB maximum reads.
+		const uint32_t lba_increment = 65536 / sector_size;
+		while (lbaCount > 0) {
+			const uint16_t lba_cur_count = static_cast<uint16_t>(
+				lbaCount > lba_increment ? lba_increment : lbaCount);
+			const size_t lba_cur_size = static_cast<size_t>(lba_cur_count) * sector_size;
+			int sret = scsi_read(lba, lba_cur_count, pBuf, lba_cur_size);
+			if (sret != 0) {
+				// Read error.
+				// TODO: Handle this properly?
+				q->m_lastError = sret;
+				return sret;
 			}
-#endif /* !_WIN32 */
+			lba += lba_cur_count;
+			lbaCount -= lba_cur_count;
+			pBuf += lba_cur_size;
 		}
 		return 0;
 	}
 
-	// Read the first block.
-	if (devInfo->isKreonUnlocked) {
-		// Kreon drive. Use SCSI commands.
-		int sret = scsi_read(lba, 1, devInfo->sector_cache, devInfo->sector_size);
-		if (sret != 0) {
-			// Read error.
-			// TODO: Handle this properly?
-			devInfo->lba_cache = ~0U;
-			q->m_lastError = sret;
-			return sret;
-		}
-	} else {
-		// Not a Kreon drive. Use the OS API.
-		const off64_t seek_pos = static_cast<off64_t>(lba) * devInfo->sector_size;
+	// Not a Kreon drive. Use the OS API.
+	const off64_t seek_pos = static_cast<off64_t>(lba) * sector_size;
+	const size_t contig_size = static_cast<size_t>(lbaCount) * sector_size;
 #ifdef _WIN32
-		LARGE_INTEGER liSeekPos;
-		liSeekPos.QuadPart = seek_pos;
-		BOOL bRet = SetFilePointerEx(file, liSeekPos, nullptr, FILE_BEGIN);
-		if (!bRet) {
-			// Seek error.
-			devInfo->lba_cache = ~0U;
-			q->m_lastError = w32err_to_posix(GetLastError());
-			return -q->m_lastError;
-		}
+	LARGE_INTEGER liSeekPos;
+	liSeekPos.QuadPart = seek_pos;
+	BOOL bRet = SetFilePointerEx(file, liSeekPos, nullptr, FILE_BEGIN);
+	if (!bRet) {
+		// Seek error.
+		q->m_lastError = w32err_to_posix(GetLastError());
+		return -q->m_lastError;
+	}
 
-		DWORD bytesRead;
-		bRet = ReadFile(file, devInfo->sector_cache, devInfo->sector_size, &bytesRead, nullptr);
-		if (bRet == 0 || bytesRead != devInfo->sector_size) {
-			// Read error.
-			devInfo->lba_cache = ~0U;
-			q->m_lastError = w32err_to_posix(GetLastError());
-			return -q->m_lastError;
-		}
+	DWORD bytesRead;
+	bRet = ReadFile(file, pBuf, static_cast<DWORD>(contig_size), &bytesRead, nullptr);
+	if (bRet == 0 || bytesRead != contig_size) {
+		// Read error.
+		q->m_lastError = w32err_to_posix(GetLastError());
+		return -q->m_lastError;
+	}
 #else /* !_WIN32 */
-		int ret = fseeko(file, seek_pos, SEEK_SET);
-		if (ret != 0) {
-			// Seek error.
-			devInfo->lba_cache = ~0U;
-			q->m_lastError = errno;
-			return -q->m_lastError;
-		}
-		size_t bytesRead = fread(devInfo->sector_cache, 1, devInfo->sector_size, file);
-		if (ferror(file) || bytesRead != devInfo->sector_size) {
-			// Read error.
-			devInfo->lba_cache = ~0U;
-			q->m_lastError = errno;
-			return -q->m_lastError;
-		}
+	int ret = fseeko(file, seek_pos, SEEK_SET);
+	if (ret != 0) {
+		// Seek error.
+		q->m_lastError = errno;
+		return -q->m_lastError;
+	}
+	size_t bytesRead = fread(pBuf, 1, contig_size, file);
+	if (ferror(file) || bytesRead != contig_size) {
+		// Read error.
+		q->m_lastError = (errno != 0 ? errno : EIO);
+		return -q->m_lastError;
+	}
 #endif /* _WIN32 */
+
+	return 0;
+}
+
+/**
+ * Make sure the specified LBA is in the sector cache.
+ *
+ * On a cache miss, multiple sectors are read starting at lba.
+ * If the miss continues the previous read, the entire cache
+ * is filled (read-ahead); otherwise, half of it is filled.
+ *
+ * NOTE: This function sets q->m_lastError on error.
+ * @param lba LBA to read.
+ * @return 0 on success; non-zero on error.
+ */
+int RpFilePrivate::fillSectorCache(uint32_t lba)
+{
+	if (!devInfo) {
+		// Not a device.
+		return -ENODEV;
+	}
+	if (devInfo->isLBACached(lba)) {
+		// This LBA is already cached.
+		return 0;
+	}
+
+	assert(devInfo->sector_cache != nullptr);
+	if (!devInfo->sector_cache) {
+		// Sector cache wasn't allocated.
+		return -ENOMEM;
+	}
+
+	// Sequential reads fill the entire cache.
+	// Random reads only fill half of it, since
+	// the rest probably won't be used.
+	uint32_t lbaCount = devInfo->sector_cache_max;
+	if (lba != devInfo->lba_next && lbaCount > 1) {
+		lbaCount /= 2;
+	}
+
+	// Don't read past the end of the device.
+	// NOTE: A partial sector at the end of the device is read as a full sector.
+	const off64_t lba_total = (devInfo->device_size + devInfo->sector_size - 1) / devInfo->sector_size;
+	if (static_cast<off64_t>(lba) + lbaCount > lba_total) {
+		lbaCount = (static_cast<off64_t>(lba) < lba_total
+			? static_cast<uint32_t>(lba_total - lba)
+			: 1);
+	}
+
+	int ret = readLBAs(lba, lbaCount, devInfo->sector_cache);
+	if (ret != 0 && lbaCount > 1) {
+		// One of the read-ahead sectors might be unreadable.
+		// Try reading only the requested sector.
+		lbaCount = 1;
+		ret = readLBAs(lba, lbaCount, devInfo->sector_cache);
+	}
+	if (ret != 0) {
+		// Read error.
+		// NOTE: q->m_lastError is set by readLBAs().
+		devInfo->invalidate_sector_cache();
+		return ret;
 	}
 
 	// Sector cache has been updated.
 	devInfo->lba_cache = lba;
+	devInfo->lba_cache_count = lbaCount;
+	devInfo->lba_next = lba + lbaCount;
 	return 0;
 }
 
@@ -152,8 +202,6 @@ size_t RpFilePrivate::readUsingBlocks(void *ptr, size_t size)
 	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
 	size_t ret = 0;
 
-	RP_Q(RpFile);
-
 	// Are we already at the end of the block device?
 	if (devInfo->device_pos >= devInfo->device_size) {
 		// End of the block device.
@@ -167,144 +215,56 @@ size_t RpFilePrivate::readUsingBlocks(void *ptr, size_t size)
 	}
 
 	// sector_size must be a power of two.
-	assert(isPow2(devInfo->sector_size));
-	// TODO: 64-bit LBAs?
-	uint32_t lba_cur = static_cast<uint32_t>(devInfo->device_pos / devInfo->sector_size);
+	const uint32_t sector_size = devInfo->sector_size;
+	assert(isPow2(sector_size));
 
 	// Make sure the sector cache is allocated.
 	devInfo->alloc_sector_cache();
-
-	// Check if we're not starting on a block boundary.
-	const uint32_t blockStartOffset = devInfo->device_pos % devInfo->sector_size;
-	if (blockStartOffset != 0) {
-		// Not a block boundary.
-		// Read the end of the first block.
-		int lret = readOneLBA(lba_cur);
-		if (lret != 0) {
-			// Read error.
-			// NOTE: q->m_lastError is set by readOneLBA().
-			// TODO: readOneLBA() should return number of bytes read,
-			// then return that value instead of 0?
-			return 0;
-		}
-
-		// Copy the data from the sector buffer.
-		uint32_t read_sz = devInfo->sector_size - blockStartOffset;
-		if (size < static_cast<size_t>(read_sz)) {
-			read_sz = static_cast<uint32_t>(size);
-		}
-		memcpy(ptr8, &devInfo->sector_cache[blockStartOffset], read_sz);
-
-		// Starting block read.
-		lba_cur++;
-		devInfo->device_pos += read_sz;
-		size -= read_sz;
-		ptr8 += read_sz;
-		ret += read_sz;
-	}
-
-	if (size == 0) {
-		// Nothing else to read here.
-		return ret;
-	}
-
-	// Must be on a sector boundary now.
-	assert(devInfo->device_pos % devInfo->sector_size == 0);
-
-	// Read contiguous blocks.
-	uint32_t lba_count = static_cast<uint32_t>(size / devInfo->sector_size);
-	size_t contig_size = static_cast<off64_t>(lba_count) * devInfo->sector_size;
-	if (devInfo->isKreonUnlocked) {
-		// Kreon drive. Use SCSI commands.
-		// NOTE: Reading up to 65535 LBAs at a time due to READ(10) limitations.
-		// TODO: Move the 65535 LBA code down to RpFile::scsi_read()?
-		// FIXME: Seems to have issues above a certain number of LBAs on Linux...
-		// Reducing it to 64 KB maximum reads.
-		// TODO: Use the sector cache for the first LBA if possible.
-		uint32_t lba_increment = 65536 / devInfo->sector_size;
-		for (; lba_count > 0; lba_count -= lba_increment) {
-			const uint16_t lba_cur_count = (lba_count > lba_increment ? lba_increment : (uint16_t)lba_count);
-			const size_t lba_cur_size = (size_t)lba_cur_count * devInfo->sector_size;
-			int sret = scsi_read(lba_cur, lba_cur_count, ptr8, lba_cur_size);
-			if (sret != 0) {
+	const size_t sector_cache_bytes = static_cast<size_t>(devInfo->sector_cache_max) * sector_size;
+
+	while (size > 0) {
+		// TODO: 64-bit LBAs?
+		const uint32_t lba_cur = static_cast<uint32_t>(devInfo->device_pos / sector_size);
+		const uint32_t blockOffset = static_cast<uint32_t>(devInfo->device_pos % sector_size);
+
+		if (blockOffset == 0 && size >= sector_cache_bytes && !devInfo->isLBACached(lba_cur)) {
+			// Large aligned read. Read the full sectors
+			// directly into the output buffer.
+			const uint32_t lba_count = static_cast<uint32_t>(size / sector_size);
+			const size_t contig_size = static_cast<size_t>(lba_count) * sector_size;
+			if (readLBAs(lba_cur, lba_count, ptr8) != 0) {
 				// Read error.
-				// TODO: Handle this properly?
-				q->m_lastError = sret;
+				// NOTE: q->m_lastError is set by readLBAs().
 				return ret;
 			}
-			devInfo->device_pos += lba_cur_size;
-			lba_cur += lba_cur_count;
-			size -= lba_cur_size;
-			ptr8 += lba_cur_size;
-			ret += lba_cur_size;
-		}
-	} else {
-		// Not a Kreon drive. Use the OS API.
-		// TODO: Use the sector cache for the first LBA if possible.
-
-		// Make sure we're at the correct address. The initial seek may
-		// have been skipped if we started at the beginning of a block
-		// or if the partial block was cached.
-		const off64_t seek_pos = static_cast<off64_t>(lba_cur) * devInfo->sector_size;
-#ifdef _WIN32
-		LARGE_INTEGER liSeekPos;
-		liSeekPos.QuadPart = seek_pos;
-		BOOL bRet = SetFilePointerEx(file, liSeekPos, nullptr, FILE_BEGIN);
-		if (!bRet) {
-			// Seek error.
-			q->m_lastError = w32err_to_posix(GetLastError());
-			return ret;
-		}
+			devInfo->lba_next = lba_cur + lba_count;
 
-		DWORD bytesRead;
-		bRet = ReadFile(file, ptr8, static_cast<DWORD>(contig_size), &bytesRead, nullptr);
-		if (bRet == 0 || bytesRead != contig_size) {
-			// Read error.
-			q->m_lastError = w32err_to_posix(GetLastError());
-			return ret + bytesRead;
+			devInfo->device_pos += contig_size;
+			size -= contig_size;
+			ptr8 += contig_size;
+			ret += contig_size;
+			continue;
 		}
-#else /* !_WIN32 */
-		int sret = fseeko(file, seek_pos, SEEK_SET);
-		if (sret != 0) {
-			// Seek error.
-			q->m_lastError = errno;
-			return ret;
-		}
-		size_t bytesRead = fread(ptr8, 1, contig_size, file);
-		if (ferror(file) || bytesRead != contig_size) {
-			// Read error.
-			q->m_lastError = errno;
-			return ret + bytesRead;
-		}
-#endif /* !_WIN32 */
-
-		devInfo->device_pos += contig_size;
-		lba_cur += lba_count;
-		size -= contig_size;
-		ptr8 += contig_size;
-		ret += contig_size;
-	}
 
-	// Check if we still have data left. (not a full block)
-	if (size > 0) {
-		// Must be on a sector boundary now.
-		assert(devInfo->device_pos % devInfo->sector_size == 0);
-
-		// Read the last block.
-		int lret = readOneLBA(lba_cur);
-		if (lret != 0) {
+		// Read through the sector cache.
+		if (fillSectorCache(lba_cur) != 0) {
 			// Read error.
-			// NOTE: q->m_lastError is set by readOneLBA().
-			// TODO: readOneLBA() should return number of bytes read,
-			// then add it to ret?
+			// NOTE: q->m_lastError is set by fillSectorCache().
 			return ret;
 		}
 
-		// Copy the data from the sector buffer.
-		memcpy(ptr8, devInfo->sector_cache, size);
+		// Copy the data from the sector cache.
+		const size_t cache_offset = (static_cast<size_t>(lba_cur - devInfo->lba_cache) * sector_size) + blockOffset;
+		size_t read_sz = (static_cast<size_t>(devInfo->lba_cache_count) * sector_size) - cache_offset;
+		if (read_sz > size) {
+			read_sz = size;
+		}
+		memcpy(ptr8, &devInfo->sector_cache[cache_offset], read_sz);
 
-		devInfo->device_pos += size;
-		ret += size;
+		devInfo->device_pos += read_sz;
+		size -= read_sz;
+		ptr8 += read_sz;
+		ret += read_sz;
 	}
 
 	// Finished reading the data.
@@ -0,0 +1,432 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile/tests)                  *
+ * AsyncReaderTest.cpp: AsyncReader asynchronous batch read test.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// librpfile
+#include "librpfile/AsyncReader.hpp"
+#include "CountingMemFile.hpp"
+
+// C includes.
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace LibRpFile { namespace Tests {
+
+/**
+ * IRpFile backed by a POSIX file descriptor.
+ * The file descriptor is used by AsyncReader for direct reads.
+ */
+class FdFile : public IRpFile
+{
+	public:
+		/**
+		 * @param fd File descriptor. (closed when this object is deleted)
+		 */
+		explicit FdFile(int fd)
+			: m_fd(fd)
+			, m_pos(0)
+		{ }
+
+	protected:
+		~FdFile() final
+		{
+			if (m_fd >= 0) {
+				::close(m_fd);
+			}
+		}
+
+	public:
+		bool isOpen(void) const final { return (m_fd >= 0); }
+
+		void close(void) final
+		{
+			if (m_fd >= 0) {
+				::close(m_fd);
+				m_fd = -1;
+			}
+		}
+
+		size_t read(void *ptr, size_t size) final
+		{
+			const size_t sz = pread(m_pos, ptr, size);
+			m_pos += sz;
+			return sz;
+		}
+
+		size_t write(const void *ptr, size_t size) final
+		{
+			RP_UNUSED(ptr);
+			RP_UNUSED(size);
+			m_lastError = EBADF;
+			return 0;
+		}
+
+		int seek(off64_t pos) final
+		{
+			m_pos = pos;
+			return 0;
+		}
+
+		off64_t tell(void) final { return m_pos; }
+
+		int truncate(off64_t size) final
+		{
+			RP_UNUSED(size);
+			m_lastError = ENOTSUP;
+			return -1;
+		}
+
+		off64_t size(void) final { return lseek(m_fd, 0, SEEK_END); }
+		string filename(void) const final { return string(); }
+
+		size_t pread(off64_t pos, void *ptr, size_t size) final
+		{
+			const ssize_t sz = ::pread(m_fd, ptr, size, pos);
+			if (sz < 0) {
+				m_lastError = errno;
+				return 0;
+			}
+			return static_cast<size_t>(sz);
+		}
+
+		int nativeFd(void) const final { return m_fd; }
+
+	private:
+		int m_fd;
+		off64_t m_pos;
+};
+
+/**
+ * Result of a single read.
+ */
+struct ReadResult {
+	unsigned int calls;	// Number of times the callback was called.
+	size_t size;
+	int err;
+
+	ReadResult() : calls(0), size(0), err(0) { }
+};
+
+class AsyncReaderTest : public ::testing::Test
+{
+	protected:
+		AsyncReaderTest()
+			: m_fdFile(nullptr)
+			, m_memFile(nullptr)
+		{ }
+
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+	public:
+		static const size_t DATA_SIZE = 1024*1024 + 123;
+
+	protected:
+		/**
+		 * Get a callback that stores the result in a ReadResult.
+		 * @param result ReadResult.
+		 * @return Callback.
+		 */
+		static AsyncReader::ReadCallback storeResult(ReadResult &result)
+		{
+			return [&result](size_t size, int err) {
+				result.calls++;
+				result.size = size;
+				result.err = err;
+			};
+		}
+
+	protected:
+		vector<uint8_t> m_data;
+		FdFile *m_fdFile;		// Supports direct reads.
+		CountingMemFile *m_memFile;	// Doesn't support direct reads.
+};
+
+void AsyncReaderTest::SetUp(void)
+{
+	// Deterministic pseudo-random test data.
+	m_data.resize(DATA_SIZE);
+	uint32_t seed = 0x12345678;
+	for (uint8_t &byte : m_data) {
+		seed = seed * 1103515245U + 12345U;
+		byte = static_cast<uint8_t>(seed >> 16);
+	}
+
+	// Write the data to a temporary file.
+	char tmp_filename[] = "/tmp/rpAsyncReaderTest.XXXXXX";
+	const int fd = mkstemp(tmp_filename);
+	ASSERT_GE(fd, 0) << "mkstemp() failed: " << strerror(errno);
+	unlink(tmp_filename);
+	m_fdFile = new FdFile(fd);
+	ASSERT_EQ(static_cast<ssize_t>(DATA_SIZE), ::write(fd, m_data.data(), DATA_SIZE));
+
+	m_memFile = new CountingMemFile(m_data);
+}
+
+void AsyncReaderTest::TearDown(void)
+{
+	UNREF_AND_NULL(m_fdFile);
+	UNREF_AND_NULL(m_memFile);
+}
+
+/**
+ * Read from files with and without direct read support.
+ * Completion order is not assumed.
+ */
+TEST_F(AsyncReaderTest, readMany)
+{
+	static const unsigned int COUNT = 300;
+	vector<ReadResult> results(COUNT);
+	vector<size_t> pos(COUNT), size(COUNT);
+	vector<vector<uint8_t> > bufs(COUNT);
+
+	AsyncReader asyncReader(16);
+	srand(1);
+	for (unsigned int i = 0; i < COUNT; i++) {
+		// Some reads extend past EOF.
+		pos[i] = static_cast<size_t>(rand()) % DATA_SIZE;
+		size[i] = static_cast<size_t>(rand()) % 65536 + 1;
+		bufs[i].resize(size[i]);
+
+		IRpFile *const file = (i % 4 == 3) ? static_cast<IRpFile*>(m_memFile) : m_fdFile;
+		ASSERT_EQ(0, asyncReader.read(file, pos[i], bufs[i].data(), size[i], storeResult(results[i])));
+		EXPECT_LE(asyncReader.pending(), 16U);
+	}
+	ASSERT_EQ(0, asyncReader.wait());
+	EXPECT_EQ(0U, asyncReader.pending());
+
+	for (unsigned int i = 0; i < COUNT; i++) {
+		const size_t expected_size = std::min(size[i], DATA_SIZE - pos[i]);
+		EXPECT_EQ(1U, results[i].calls) << "i == " << i;
+		EXPECT_EQ(0, results[i].err) << "i == " << i;
+		ASSERT_EQ(expected_size, results[i].size) << "i == " << i;
+		EXPECT_EQ(0, memcmp(bufs[i].data(), &m_data[pos[i]], expected_size)) << "i == " << i;
+	}
+}
+
+/**
+ * Files without direct read support are read before read() returns.
+ */
+TEST_F(AsyncReaderTest, readSync)
+{
+	AsyncReader asyncReader;
+	ReadResult result;
+	uint8_t buf[256];
+	ASSERT_EQ(0, asyncReader.read(m_memFile, 1000, buf, sizeof(buf), storeResult(result)));
+	EXPECT_EQ(1U, result.calls);
+	EXPECT_EQ(sizeof(buf), result.size);
+	EXPECT_EQ(0, memcmp(buf, &m_data[1000], sizeof(buf)));
+}
+
+/**
+ * Invalid and empty reads.
+ */
+TEST_F(AsyncReaderTest, readInvalid)
+{
+	AsyncReader asyncReader;
+	ReadResult result;
+	uint8_t buf[16];
+
+	// Empty reads complete immediately.
+	ASSERT_EQ(0, asyncReader.read(m_fdFile, 0, buf, 0, storeResult(result)));
+	EXPECT_EQ(1U, result.calls);
+	EXPECT_EQ(0U, result.size);
+
+	// Reads past EOF return 0 bytes.
+	result = ReadResult();
+	ASSERT_EQ(0, asyncReader.read(m_fdFile, DATA_SIZE + 100, buf, sizeof(buf), storeResult(result)));
+	ASSERT_EQ(0, asyncReader.wait());
+	EXPECT_EQ(1U, result.calls);
+	EXPECT_EQ(0U, result.size);
+}
+
+/**
+ * The destructor waits for pending reads.
+ */
+TEST_F(AsyncReaderTest, destructorWaits)
+{
+	static const unsigned int COUNT = 32;
+	vector<ReadResult> results(COUNT);
+	vector<uint8_t> buf(COUNT * 4096);
+	{
+		AsyncReader asyncReader;
+		for (unsigned int i = 0; i < COUNT; i++) {
+			ASSERT_EQ(0, asyncReader.read(m_fdFile, i * 8192, &buf[i * 4096], 4096, storeResult(results[i])));
+		}
+	}
+
+	for (unsigned int i = 0; i < COUNT; i++) {
+		EXPECT_EQ(1U, results[i].calls) << "i == " << i;
+		EXPECT_EQ(0, memcmp(&buf[i * 4096], &m_data[i * 8192], 4096)) << "i == " << i;
+	}
+}
+
+/**
+ * cancel() without any pending reads does nothing.
+ */
+TEST_F(AsyncReaderTest, cancelNothing)
+{
+	AsyncReader asyncReader;
+	EXPECT_EQ(0, asyncReader.cancel());
+
+	// Reads still work afterwards.
+	ReadResult result;
+	uint8_t buf[16];
+	ASSERT_EQ(0, asyncReader.read(m_fdFile, 0, buf, sizeof(buf), storeResult(result)));
+	ASSERT_EQ(0, asyncReader.wait());
+	EXPECT_EQ(1U, result.calls);
+	EXPECT_EQ(0, memcmp(buf, m_data.data(), sizeof(buf)));
+}
+
+/**
+ * Reads complete out of order.
+ *
+ * A read from a pipe is queued first. It can't complete until the
+ * pipe is written to, which is done by the last file read's callback.
+ */
+TEST_F(AsyncReaderTest, readOutOfOrder)
+{
+	AsyncReader asyncReader;
+	if (!asyncReader.isAsync()) {
+		// Reading the pipe would block.
+		GTEST_SKIP() << "Asynchronous reads aren't available.";
+	}
+
+	int pipefd[2];
+	ASSERT_EQ(0, pipe(pipefd));
+	FdFile *const pipeFile = new FdFile(pipefd[0]);
+	const int pipe_wr = pipefd[1];
+
+	static const unsigned int COUNT = 8;
+	vector<unsigned int> order;
+	unsigned int filesDone = 0;
+
+	uint8_t pipeBuf[4];
+	ReadResult pipeResult;
+	ASSERT_EQ(0, asyncReader.read(pipeFile, 0, pipeBuf, sizeof(pipeBuf),
+		[&order, &pipeResult](size_t size, int err) {
+			order.push_back(COUNT);
+			pipeResult.calls++;
+			pipeResult.size = size;
+			pipeResult.err = err;
+		}));
+
+	vector<uint8_t> buf(COUNT * 512);
+	for (unsigned int i = 0; i < COUNT; i++) {
+		ASSERT_EQ(0, asyncReader.read(m_fdFile, i * 1000, &buf[i * 512], 512,
+			[&order, &filesDone, i, pipe_wr](size_t size, int err) {
+				EXPECT_EQ(512U, size);
+				EXPECT_EQ(0, err);
+				order.push_back(i);
+				if (++filesDone == COUNT) {
+					// All file reads are done. Unblock the pipe read.
+					EXPECT_EQ(4, ::write(pipe_wr, "ABCD", 4));
+				}
+			}));
+	}
+	ASSERT_EQ(0, asyncReader.wait());
+	::close(pipe_wr);
+
+	// The pipe read was queued first, but completed last.
+	ASSERT_EQ(COUNT + 1, order.size());
+	EXPECT_EQ(COUNT, order.back());
+	EXPECT_EQ(1U, pipeResult.calls);
+	EXPECT_EQ(0, pipeResult.err);
+	EXPECT_EQ(4U, pipeResult.size);
+	EXPECT_EQ(0, memcmp(pipeBuf, "ABCD", 4));
+	for (unsigned int i = 0; i < COUNT; i++) {
+		EXPECT_EQ(0, memcmp(&buf[i * 512], &m_data[i * 1000], 512)) << "i == " << i;
+	}
+
+	pipeFile->unref();
+}
+
+/**
+ * Pending reads can be cancelled.
+ */
+TEST_F(AsyncReaderTest, cancelPending)
+{
+	AsyncReader asyncReader;
+	if (!asyncReader.isAsync()) {
+		// Reading the pipe would block.
+		GTEST_SKIP() << "Asynchronous reads aren't available.";
+	}
+
+	int pipefd[2];
+	ASSERT_EQ(0, pipe(pipefd));
+	FdFile *const pipeFile = new FdFile(pipefd[0]);
+
+	// This read never completes, since nothing is written to the pipe.
+	uint8_t pipeBuf[16];
+	ReadResult pipeResult;
+	ASSERT_EQ(0, asyncReader.read(pipeFile, 0, pipeBuf, sizeof(pipeBuf), storeResult(pipeResult)));
+
+	// File reads might complete before they're cancelled.
+	static const unsigned int COUNT = 8;
+	vector<ReadResult> results(COUNT);
+	vector<uint8_t> buf(COUNT * 512);
+	for (unsigned int i = 0; i < COUNT; i++) {
+		ASSERT_EQ(0, asyncReader.read(m_fdFile, i * 1000, &buf[i * 512], 512, storeResult(results[i])));
+	}
+
+	EXPECT_EQ(0, asyncReader.cancel());
+	EXPECT_EQ(0U, asyncReader.pending());
+	EXPECT_EQ(1U, pipeResult.calls);
+	EXPECT_EQ(-ECANCELED, pipeResult.err);
+	EXPECT_EQ(0U, pipeResult.size);
+	for (unsigned int i = 0; i < COUNT; i++) {
+		EXPECT_EQ(1U, results[i].calls) << "i == " << i;
+		if (results[i].err == 0) {
+			EXPECT_EQ(512U, results[i].size) << "i == " << i;
+			EXPECT_EQ(0, memcmp(&buf[i * 512], &m_data[i * 1000], 512)) << "i == " << i;
+		} else {
+			EXPECT_EQ(-ECANCELED, results[i].err) << "i == " << i;
+		}
+	}
+
+	// The AsyncReader can still be used afterwards.
+	ReadResult result;
+	ASSERT_EQ(0, asyncReader.read(m_fdFile, 12345, &buf[0], 512, storeResult(result)));
+	ASSERT_EQ(0, asyncReader.wait());
+	EXPECT_EQ(1U, result.calls);
+	EXPECT_EQ(0, result.err);
+	EXPECT_EQ(0, memcmp(&buf[0], &m_data[12345], 512));
+
+	::close(pipefd[1]);
+	pipeFile->unref();
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpFile test suite: AsyncReader tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,241 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile/tests)                  *
+ * CachedFileTest.cpp: CachedFile read cache test.                         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// librpfile
+#include "librpfile/CachedFile.hpp"
+#include "CountingMemFile.hpp"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRpFile { namespace Tests {
+
+class CachedFileTest : public ::testing::Test
+{
+	protected:
+		CachedFileTest()
+			: m_memFile(nullptr)
+			, m_cachedFile(nullptr)
+		{ }
+
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+	public:
+		static const size_t PAGE_SIZE = 4096;
+		static const unsigned int READ_AHEAD = 3;
+		static const unsigned int MAX_PAGES = 8;
+
+		// File size. (not a multiple of PAGE_SIZE)
+		static const size_t DATA_SIZE = (PAGE_SIZE * 40) + 1000;
+
+	protected:
+		/**
+		 * Seek to the specified position and read data,
+		 * then compare it to the reference data.
+		 * @param pos Position.
+		 * @param size Amount of data to read.
+		 * @return AssertionResult.
+		 */
+		::testing::AssertionResult seekAndCompare(size_t pos, size_t size)
+		{
+			vector<uint8_t> buf(size);
+			if (m_cachedFile->seek(pos) != 0) {
+				return ::testing::AssertionFailure() << "seek(" << pos << ") failed";
+			}
+			const size_t sz = m_cachedFile->read(buf.data(), size);
+			if (sz != size) {
+				return ::testing::AssertionFailure() << "pos == " << pos << ": read "
+					<< sz << " bytes; expected " << size;
+			}
+			if (memcmp(buf.data(), &m_data[pos], size) != 0) {
+				return ::testing::AssertionFailure() << "pos == " << pos << ", size == " << size
+					<< ": data doesn't match";
+			}
+			return ::testing::AssertionSuccess();
+		}
+
+	protected:
+		vector<uint8_t> m_data;
+		CountingMemFile *m_memFile;
+		CachedFile *m_cachedFile;
+};
+
+void CachedFileTest::SetUp(void)
+{
+	// Deterministic pseudo-random test data.
+	m_data.resize(DATA_SIZE);
+	uint32_t seed = 0x12345678;
+	for (uint8_t &byte : m_data) {
+		seed = seed * 1103515245U + 12345U;
+		byte = static_cast<uint8_t>(seed >> 16);
+	}
+
+	CachedFile::CacheParams params;
+	params.pageSize = PAGE_SIZE;
+	params.readAhead = READ_AHEAD;
+	params.maxPages = MAX_PAGES;
+
+	m_memFile = new CountingMemFile(m_data);
+	m_cachedFile = new CachedFile(m_memFile, params);
+	ASSERT_TRUE(m_cachedFile->isOpen());
+	ASSERT_EQ(static_cast<off64_t>(DATA_SIZE), m_cachedFile->size());
+}
+
+void CachedFileTest::TearDown(void)
+{
+	UNREF_AND_NULL(m_cachedFile);
+	UNREF_AND_NULL(m_memFile);
+}
+
+/**
+ * Reads that span multiple cache pages.
+ */
+TEST_F(CachedFileTest, readSpanningPages)
+{
+	// Straddle one page boundary.
+	EXPECT_TRUE(seekAndCompare(PAGE_SIZE - 10, 20));
+	// Straddle two page boundaries.
+	EXPECT_TRUE(seekAndCompare((PAGE_SIZE * 5) - 1, PAGE_SIZE + 2));
+	// Start and end exactly on page boundaries.
+	EXPECT_TRUE(seekAndCompare(PAGE_SIZE * 10, PAGE_SIZE * 2));
+	// Straddle pages that are partially cached.
+	EXPECT_TRUE(seekAndCompare((PAGE_SIZE * 11) + 100, PAGE_SIZE * 2));
+	// Just below the cache bypass size.
+	EXPECT_TRUE(seekAndCompare((PAGE_SIZE * 20) + 1, (PAGE_SIZE * (READ_AHEAD + 1)) - 1));
+}
+
+/**
+ * Sequential reads are served from the cache, using read-ahead.
+ */
+TEST_F(CachedFileTest, readSequential)
+{
+	static const size_t chunkSizes[] = {1, 100, 1000, PAGE_SIZE - 1, PAGE_SIZE + 1};
+	for (size_t chunkSize : chunkSizes) {
+		vector<uint8_t> buf(DATA_SIZE);
+		ASSERT_EQ(0, m_cachedFile->seek(0));
+		m_memFile->resetPreadCount();
+
+		size_t pos = 0;
+		while (pos < buf.size()) {
+			const size_t sz = m_cachedFile->read(&buf[pos], chunkSize);
+			ASSERT_GT(sz, 0U);
+			pos += sz;
+		}
+		EXPECT_EQ(m_data.size(), pos);
+		EXPECT_TRUE(buf == m_data) << "chunkSize == " << chunkSize;
+
+		// The file is read in groups of READ_AHEAD+1 pages.
+		const unsigned int pageCount = (DATA_SIZE + PAGE_SIZE - 1) / PAGE_SIZE;
+		EXPECT_LE(m_memFile->preadCount(), (pageCount / (READ_AHEAD + 1)) + 2)
+			<< "chunkSize == " << chunkSize;
+	}
+}
+
+/**
+ * Cached pages aren't read from the underlying file again.
+ */
+TEST_F(CachedFileTest, readCached)
+{
+	ASSERT_TRUE(seekAndCompare(PAGE_SIZE * 3, 100));
+	m_memFile->resetPreadCount();
+	EXPECT_TRUE(seekAndCompare((PAGE_SIZE * 3) + 50, 1000));
+	EXPECT_TRUE(seekAndCompare(PAGE_SIZE * 3, PAGE_SIZE));
+	EXPECT_EQ(0U, m_memFile->preadCount());
+}
+
+/**
+ * Large reads bypass the cache.
+ */
+TEST_F(CachedFileTest, readLarge)
+{
+	const size_t size = PAGE_SIZE * (READ_AHEAD + 1);
+	EXPECT_TRUE(seekAndCompare(PAGE_SIZE + 123, size));
+	EXPECT_EQ(1U, m_memFile->preadCount());
+
+	// The pages weren't cached.
+	m_memFile->resetPreadCount();
+	EXPECT_TRUE(seekAndCompare(PAGE_SIZE * 2, 100));
+	EXPECT_EQ(1U, m_memFile->preadCount());
+}
+
+/**
+ * Read at random positions, which causes pages to be evicted.
+ */
+TEST_F(CachedFileTest, readRandom)
+{
+	srand(1);
+	for (unsigned int i = 0; i < 1000; i++) {
+		const size_t pos = static_cast<size_t>(rand()) % DATA_SIZE;
+		size_t size = static_cast<size_t>(rand()) % (PAGE_SIZE * 3) + 1;
+		if (pos + size > DATA_SIZE) {
+			size = DATA_SIZE - pos;
+		}
+		ASSERT_TRUE(seekAndCompare(pos, size));
+	}
+}
+
+/**
+ * Reads that reach EOF are truncated.
+ */
+TEST_F(CachedFileTest, readAtEOF)
+{
+	uint8_t buf[PAGE_SIZE * 2];
+	const size_t pos = DATA_SIZE - 1500;
+	ASSERT_EQ(0, m_cachedFile->seek(pos));
+	EXPECT_EQ(1500U, m_cachedFile->read(buf, sizeof(buf)));
+	EXPECT_EQ(0, memcmp(buf, &m_data[pos], 1500));
+	EXPECT_EQ(static_cast<off64_t>(DATA_SIZE), m_cachedFile->tell());
+
+	// Reading at EOF returns 0.
+	EXPECT_EQ(0U, m_cachedFile->read(buf, sizeof(buf)));
+}
+
+/**
+ * Seeking past EOF moves the position to EOF.
+ */
+TEST_F(CachedFileTest, seekPastEOF)
+{
+	uint8_t buf[16];
+	ASSERT_EQ(0, m_cachedFile->seek(DATA_SIZE + 1000));
+	EXPECT_EQ(static_cast<off64_t>(DATA_SIZE), m_cachedFile->tell());
+	EXPECT_EQ(0U, m_cachedFile->read(buf, sizeof(buf)));
+
+	// seekAndRead() past EOF doesn't read anything either.
+	m_memFile->resetPreadCount();
+	EXPECT_EQ(0U, m_cachedFile->seekAndRead(DATA_SIZE + PAGE_SIZE, buf, sizeof(buf)));
+	EXPECT_EQ(0U, m_memFile->preadCount());
+
+	// Data can still be read after seeking back.
+	EXPECT_TRUE(seekAndCompare(PAGE_SIZE - 8, sizeof(buf)));
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpFile test suite: CachedFile tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
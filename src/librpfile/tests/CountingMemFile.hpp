@@ -0,0 +1,119 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile/tests)                  *
+ * CountingMemFile.hpp: Memory-backed IRpFile that counts reads.           *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_TESTS_COUNTINGMEMFILE_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_TESTS_COUNTINGMEMFILE_HPP__
+
+// librpfile
+#include "librpfile/IRpFile.hpp"
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <vector>
+
+namespace LibRpFile { namespace Tests {
+
+/**
+ * Memory-backed IRpFile that counts pread() calls.
+ * readv() optionally uses readv_coalesced().
+ */
+class CountingMemFile : public IRpFile
+{
+	public:
+		/**
+		 * @param data Data buffer. (copied)
+		 * @param maxGap Maximum gap for readv_coalesced(), or -1 to use IRpFile::readv().
+		 */
+		explicit CountingMemFile(const std::vector<uint8_t> &data, int maxGap = -1)
+			: m_data(data)
+			, m_pos(0)
+			, m_maxGap(maxGap)
+			, m_preadCount(0)
+		{ }
+
+	public:
+		bool isOpen(void) const final { return true; }
+		void close(void) final { }
+
+		size_t read(void *ptr, size_t size) final
+		{
+			const size_t sz = pread(m_pos, ptr, size);
+			m_pos += sz;
+			return sz;
+		}
+
+		size_t write(const void *ptr, size_t size) final
+		{
+			RP_UNUSED(ptr);
+			RP_UNUSED(size);
+			m_lastError = EBADF;
+			return 0;
+		}
+
+		int seek(off64_t pos) final
+		{
+			if (pos < 0) {
+				m_lastError = EINVAL;
+				return -1;
+			}
+			m_pos = pos;
+			return 0;
+		}
+
+		off64_t tell(void) final { return m_pos; }
+
+		int truncate(off64_t size) final
+		{
+			RP_UNUSED(size);
+			m_lastError = ENOTSUP;
+			return -1;
+		}
+
+		off64_t size(void) final { return static_cast<off64_t>(m_data.size()); }
+		std::string filename(void) const final { return std::string(); }
+
+		size_t pread(off64_t pos, void *ptr, size_t size) final
+		{
+			m_preadCount++;
+			if (pos < 0 || pos >= static_cast<off64_t>(m_data.size())) {
+				return 0;
+			}
+			const size_t avail = m_data.size() - static_cast<size_t>(pos);
+			if (size > avail) {
+				size = avail;
+			}
+			memcpy(ptr, &m_data[static_cast<size_t>(pos)], size);
+			return size;
+		}
+
+		int readv(const ReadVec *vec, size_t count) final
+		{
+			if (m_maxGap < 0) {
+				return IRpFile::readv(vec, count);
+			}
+			return readv_coalesced(vec, count, static_cast<size_t>(m_maxGap));
+		}
+
+	public:
+		unsigned int preadCount(void) const { return m_preadCount; }
+		void resetPreadCount(void) { m_preadCount = 0; }
+
+	private:
+		std::vector<uint8_t> m_data;
+		off64_t m_pos;
+		int m_maxGap;
+		unsigned int m_preadCount;
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_TESTS_COUNTINGMEMFILE_HPP__ */
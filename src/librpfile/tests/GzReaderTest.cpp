@@ -0,0 +1,317 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile/tests)                  *
+ * GzReaderTest.cpp: GzReader random-access gzip decompression test.       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// zlib
+#include <zlib.h>
+
+// librpfile
+#include "librpfile/GzReader.hpp"
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// C++ includes.
+#include <vector>
+using std::vector;
+
+namespace LibRpFile { namespace Tests {
+
+/**
+ * Test parameter: Number of gzip members.
+ */
+class GzReaderTest : public ::testing::TestWithParam<unsigned int>
+{
+	protected:
+		GzReaderTest()
+			: m_gzReader(nullptr)
+		{ }
+
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+	public:
+		// Sliding window size and minimum seek point distance
+		// used by GzReader.
+		static const unsigned int WINSIZE = 32768;
+		static const unsigned int SPAN = 1024*1024;
+
+		// Decompressed data size. (not a multiple of WINSIZE)
+		static const unsigned int DATA_SIZE = (4*SPAN) + (SPAN/2) + 1234;
+
+	protected:
+		/**
+		 * Read function for GzReader.
+		 * @param userdata GzReaderTest
+		 * @param pos Position in the compressed data.
+		 * @param ptr Output buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		static size_t readFunc(void *userdata, off64_t pos, void *ptr, size_t size)
+		{
+			const vector<uint8_t> &gz = static_cast<GzReaderTest*>(userdata)->m_gz;
+			if (pos < 0 || pos >= static_cast<off64_t>(gz.size())) {
+				return 0;
+			}
+			const size_t avail = gz.size() - static_cast<size_t>(pos);
+			if (size > avail) {
+				size = avail;
+			}
+			memcpy(ptr, &gz[static_cast<size_t>(pos)], size);
+			return size;
+		}
+
+		/**
+		 * Compress data as a gzip member and append it to m_gz.
+		 * @param data Data.
+		 * @param size Size of data.
+		 * @return Z_OK on success; zlib error code on error.
+		 */
+		int appendGzipMember(const uint8_t *data, size_t size);
+
+		/**
+		 * Seek to the specified position and read data,
+		 * then compare it to the reference data.
+		 * @param pos Position.
+		 * @param size Amount of data to read.
+		 * @return AssertionResult.
+		 */
+		::testing::AssertionResult seekAndCompare(size_t pos, size_t size);
+
+	protected:
+		vector<uint8_t> m_expected;	// Decompressed reference data.
+		vector<uint8_t> m_gz;		// gzip data.
+		GzReader *m_gzReader;
+};
+
+/**
+ * Compress data as a gzip member and append it to m_gz.
+ * @param data Data.
+ * @param size Size of data.
+ * @return Z_OK on success; zlib error code on error.
+ */
+int GzReaderTest::appendGzipMember(const uint8_t *data, size_t size)
+{
+	z_stream strm;
+	memset(&strm, 0, sizeof(strm));
+	// windowBits == 15+16 for gzip format.
+	int ret = deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15+16, 8, Z_DEFAULT_STRATEGY);
+	if (ret != Z_OK) {
+		return ret;
+	}
+
+	const size_t start = m_gz.size();
+	m_gz.resize(start + deflateBound(&strm, static_cast<uLong>(size)));
+	strm.next_in = const_cast<Bytef*>(data);
+	strm.avail_in = static_cast<uInt>(size);
+	strm.next_out = &m_gz[start];
+	strm.avail_out = static_cast<uInt>(m_gz.size() - start);
+	ret = deflate(&strm, Z_FINISH);
+	m_gz.resize(start + strm.total_out);
+	deflateEnd(&strm);
+	return (ret == Z_STREAM_END ? Z_OK : Z_STREAM_ERROR);
+}
+
+/**
+ * Seek to the specified position and read data,
+ * then compare it to the reference data.
+ * @param pos Position.
+ * @param size Amount of data to read.
+ * @return AssertionResult.
+ */
+::testing::AssertionResult GzReaderTest::seekAndCompare(size_t pos, size_t size)
+{
+	if (pos + size > m_expected.size()) {
+		size = m_expected.size() - pos;
+	}
+
+	vector<uint8_t> buf(size);
+	if (m_gzReader->seek(pos) != 0) {
+		return ::testing::AssertionFailure() << "seek(" << pos << ") failed";
+	}
+	const size_t sz = m_gzReader->read(buf.data(), size);
+	if (sz != size) {
+		return ::testing::AssertionFailure() << "pos == " << pos << ": read "
+			<< sz << " bytes; expected " << size;
+	}
+	if (memcmp(buf.data(), &m_expected[pos], size) != 0) {
+		return ::testing::AssertionFailure() << "pos == " << pos << ", size == " << size
+			<< ": data doesn't match";
+	}
+	if (m_gzReader->tell() != static_cast<off64_t>(pos + size)) {
+		return ::testing::AssertionFailure() << "pos == " << pos << ", size == " << size
+			<< ": tell() == " << m_gzReader->tell();
+	}
+	return ::testing::AssertionSuccess();
+}
+
+/**
+ * Create gzip data in memory.
+ */
+void GzReaderTest::SetUp(void)
+{
+	// Alternate between compressible and incompressible
+	// 64 KB blocks, so the seek points and windows don't
+	// all line up with the compressed data blocks.
+	m_expected.resize(DATA_SIZE);
+	uint32_t seed = 0x12345678;
+	for (unsigned int i = 0; i < DATA_SIZE; i++) {
+		if ((i / 65536) & 1) {
+			seed = seed * 1103515245U + 12345U;
+			m_expected[i] = static_cast<uint8_t>(seed >> 16);
+		} else {
+			m_expected[i] = static_cast<uint8_t>((i / 64) ^ (i / 65536));
+		}
+	}
+
+	// Split the data into gzip members.
+	const unsigned int members = GetParam();
+	ASSERT_GT(members, 0U);
+	size_t pos = 0;
+	for (unsigned int i = 0; i < members; i++) {
+		const size_t end = (i == members-1 ? DATA_SIZE : (DATA_SIZE / members) * (i+1));
+		ASSERT_EQ(Z_OK, appendGzipMember(&m_expected[pos], end - pos));
+		pos = end;
+	}
+
+	m_gzReader = new GzReader(readFunc, this);
+	ASSERT_TRUE(m_gzReader->isOpen());
+}
+
+void GzReaderTest::TearDown(void)
+{
+	delete m_gzReader;
+	m_gzReader = nullptr;
+}
+
+/**
+ * Read the entire file in one read() call.
+ */
+TEST_P(GzReaderTest, readAll)
+{
+	EXPECT_TRUE(seekAndCompare(0, DATA_SIZE));
+
+	// Reading at the end of the file should return 0.
+	uint8_t buf[16];
+	EXPECT_EQ(0U, m_gzReader->read(buf, sizeof(buf)));
+}
+
+/**
+ * Seek backwards across sliding window and seek point boundaries.
+ */
+TEST_P(GzReaderTest, seekBackward)
+{
+	// Decompress the entire file first, so all of the seek points are recorded.
+	ASSERT_TRUE(seekAndCompare(0, DATA_SIZE));
+
+	for (int span = 4; span >= 0; span--) {
+		// Straddle the seek point boundary.
+		EXPECT_TRUE(seekAndCompare((span * SPAN) + 100, 1000));
+		if (span > 0) {
+			EXPECT_TRUE(seekAndCompare((span * SPAN) - 500, 1000));
+		}
+		// Straddle a sliding window boundary within the span.
+		EXPECT_TRUE(seekAndCompare((span * SPAN) + (3 * WINSIZE) - 10, WINSIZE + 20));
+	}
+
+	// Seek back within the sliding window.
+	ASSERT_TRUE(seekAndCompare(3 * SPAN, 20000));
+	EXPECT_TRUE(seekAndCompare((3 * SPAN) + 1000, 5000));
+	EXPECT_TRUE(seekAndCompare(3 * SPAN, 1));
+
+	// Seek back to just before the current sliding window.
+	ASSERT_TRUE(seekAndCompare((2 * SPAN) + (WINSIZE * 3), 100));
+	EXPECT_TRUE(seekAndCompare((2 * SPAN) + (WINSIZE * 3) + 100 - WINSIZE - 1, WINSIZE + 2));
+}
+
+/**
+ * Seek backwards without decompressing the entire file first.
+ */
+TEST_P(GzReaderTest, seekBackwardPartial)
+{
+	// Decompress up to the middle of the third span.
+	ASSERT_TRUE(seekAndCompare(0, (2 * SPAN) + (SPAN / 2)));
+
+	EXPECT_TRUE(seekAndCompare(SPAN + 10, 100));
+	EXPECT_TRUE(seekAndCompare(SPAN - 10, 100));
+	EXPECT_TRUE(seekAndCompare(5, WINSIZE));
+
+	// Continue past the previously-decompressed data.
+	EXPECT_TRUE(seekAndCompare((2 * SPAN) + (SPAN / 2) - 100, SPAN));
+}
+
+/**
+ * Seek forwards across sliding window and seek point boundaries.
+ */
+TEST_P(GzReaderTest, seekForward)
+{
+	// Skip over multiple spans without reading them.
+	EXPECT_TRUE(seekAndCompare(10, 100));
+	EXPECT_TRUE(seekAndCompare((2 * SPAN) - 50, 100));
+	EXPECT_TRUE(seekAndCompare((2 * SPAN) + WINSIZE - 1, 2));
+	EXPECT_TRUE(seekAndCompare((4 * SPAN) + (SPAN / 4), WINSIZE * 2));
+	EXPECT_TRUE(seekAndCompare(DATA_SIZE - 100, 100));
+
+	// Seek forward again after seek points have been recorded.
+	EXPECT_TRUE(seekAndCompare(100, 100));
+	EXPECT_TRUE(seekAndCompare((3 * SPAN) + 12345, 54321));
+}
+
+/**
+ * Read at random positions.
+ */
+TEST_P(GzReaderTest, readRandom)
+{
+	srand(1);
+	for (unsigned int i = 0; i < 200; i++) {
+		const size_t pos = static_cast<size_t>(rand()) % DATA_SIZE;
+		const size_t size = static_cast<size_t>(rand()) % (WINSIZE * 3) + 1;
+		ASSERT_TRUE(seekAndCompare(pos, size));
+	}
+}
+
+/**
+ * Seeking past the end of the data is allowed, but reads return 0.
+ */
+TEST_P(GzReaderTest, seekPastEOF)
+{
+	uint8_t buf[16];
+	ASSERT_EQ(0, m_gzReader->seek(DATA_SIZE + 1000));
+	EXPECT_EQ(static_cast<off64_t>(DATA_SIZE + 1000), m_gzReader->tell());
+	EXPECT_EQ(0U, m_gzReader->read(buf, sizeof(buf)));
+
+	// Data can still be read after seeking back.
+	EXPECT_TRUE(seekAndCompare(SPAN + 1, 1000));
+
+	// Negative positions are rejected.
+	EXPECT_EQ(-1, m_gzReader->seek(-1));
+}
+
+INSTANTIATE_TEST_CASE_P(GzReaderTest, GzReaderTest,
+	::testing::Values(1U, 3U));
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpFile test suite: GzReader tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,244 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile/tests)                  *
+ * ReadvTest.cpp: IRpFile::readv() and DiscReader::readv() tests.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// librpfile
+#include "librpfile/IRpFile.hpp"
+#include "CountingMemFile.hpp"
+
+// librpbase
+#include "librpbase/disc/DiscReader.hpp"
+using LibRpBase::DiscReader;
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+namespace LibRpFile { namespace Tests {
+
+/**
+ * Test parameter: Maximum gap for readv_coalesced(), or -1 to use IRpFile::readv().
+ */
+class ReadvTest : public ::testing::TestWithParam<int>
+{
+	protected:
+		ReadvTest()
+			: m_file(nullptr)
+		{ }
+
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+	public:
+		static const size_t DATA_SIZE = 256*1024;
+
+	protected:
+		/**
+		 * Check that a request was read correctly.
+		 * @param rv Read request.
+		 * @return AssertionResult.
+		 */
+		::testing::AssertionResult isReadCorrectly(const IRpFile::ReadVec &rv) const
+		{
+			if (memcmp(rv.ptr, &m_data[static_cast<size_t>(rv.pos)], rv.size) != 0) {
+				return ::testing::AssertionFailure() << "pos == " << rv.pos << ", size == " << rv.size;
+			}
+			return ::testing::AssertionSuccess();
+		}
+
+	protected:
+		vector<uint8_t> m_data;
+		CountingMemFile *m_file;
+};
+
+void ReadvTest::SetUp(void)
+{
+	// Deterministic pseudo-random test data.
+	m_data.resize(DATA_SIZE);
+	uint32_t seed = 0x12345678;
+	for (uint8_t &byte : m_data) {
+		seed = seed * 1103515245U + 12345U;
+		byte = static_cast<uint8_t>(seed >> 16);
+	}
+
+	m_file = new CountingMemFile(m_data, GetParam());
+}
+
+void ReadvTest::TearDown(void)
+{
+	UNREF_AND_NULL(m_file);
+}
+
+/**
+ * Read unsorted, overlapping, and empty requests.
+ */
+TEST_P(ReadvTest, readUnsorted)
+{
+	uint8_t buf[6][0x200];
+	memset(buf, 0xCC, sizeof(buf));
+	const IRpFile::ReadVec vec[] = {
+		{0x8000,  buf[0], 0x200},
+		{0x100,   buf[1], 0x40},
+		{0x120,   buf[2], 0x100},	// overlaps the previous request
+		{0x30000, buf[3], 0x1FF},	// far away from the others
+		{0x7F00,  buf[4], 0},		// empty request
+		{static_cast<off64_t>(DATA_SIZE - 0x10), buf[5], 0x10},	// ends at EOF
+	};
+	ASSERT_EQ(0, m_file->readv(vec, ARRAY_SIZE(vec)));
+	for (const IRpFile::ReadVec &rv : vec) {
+		EXPECT_TRUE(isReadCorrectly(rv));
+	}
+
+	// The empty request must not be written to.
+	EXPECT_EQ(0xCC, buf[4][0]);
+}
+
+/**
+ * A request that can't be read completely fails the whole readv().
+ */
+TEST_P(ReadvTest, readPastEOF)
+{
+	uint8_t buf[2][0x100];
+	const IRpFile::ReadVec vec[] = {
+		{0x100, buf[0], sizeof(buf[0])},
+		{static_cast<off64_t>(DATA_SIZE - 0x80), buf[1], sizeof(buf[1])},
+	};
+	EXPECT_NE(0, m_file->readv(vec, ARRAY_SIZE(vec)));
+
+	// A request that starts past EOF also fails.
+	const IRpFile::ReadVec vecPastEOF = {static_cast<off64_t>(DATA_SIZE + 0x100), buf[0], sizeof(buf[0])};
+	EXPECT_NE(0, m_file->readv(&vecPastEOF, 1));
+}
+
+/**
+ * No requests.
+ */
+TEST_P(ReadvTest, readNothing)
+{
+	EXPECT_EQ(0, m_file->readv(nullptr, 0));
+	EXPECT_EQ(0U, m_file->preadCount());
+}
+
+/**
+ * DiscReader::readv() adjusts the requests for the disc image offset.
+ */
+TEST_P(ReadvTest, discReaderReadv)
+{
+	static const off64_t DISC_OFFSET = 0x1000;
+	static const off64_t DISC_LENGTH = 0x10000;
+	DiscReader *const discReader = new DiscReader(m_file, DISC_OFFSET, DISC_LENGTH);
+	ASSERT_TRUE(discReader->isOpen());
+
+	uint8_t buf[3][0x100];
+	const DiscReader::ReadVec vec[] = {
+		{0x2000, buf[0], sizeof(buf[0])},
+		{0x0,    buf[1], sizeof(buf[1])},
+		{DISC_LENGTH - 0x100, buf[2], sizeof(buf[2])},
+	};
+	EXPECT_EQ(0, discReader->readv(vec, ARRAY_SIZE(vec)));
+	for (const DiscReader::ReadVec &rv : vec) {
+		EXPECT_EQ(0, memcmp(rv.ptr, &m_data[static_cast<size_t>(DISC_OFFSET + rv.pos)], rv.size))
+			<< "pos == " << rv.pos;
+	}
+
+	// Requests outside of the disc image fail without reading anything,
+	// even if the underlying file has data there.
+	m_file->resetPreadCount();
+	const DiscReader::ReadVec vecOutside = {DISC_LENGTH - 0x80, buf[0], sizeof(buf[0])};
+	EXPECT_EQ(-EIO, discReader->readv(&vecOutside, 1));
+	EXPECT_EQ(EIO, discReader->lastError());
+	EXPECT_EQ(0U, m_file->preadCount());
+
+	discReader->unref();
+}
+
+INSTANTIATE_TEST_CASE_P(ReadvTest, ReadvTest,
+	::testing::Values(-1, 0, 16*1024));
+
+/**
+ * IRpFile::readv() uses one pread() per non-empty request.
+ */
+TEST(ReadvCountTest, defaultReadv)
+{
+	vector<uint8_t> data(0x10000);
+	CountingMemFile *const file = new CountingMemFile(data, -1);
+
+	uint8_t buf[4][0x10];
+	const IRpFile::ReadVec vec[] = {
+		{0x0,  buf[0], sizeof(buf[0])},
+		{0x10, buf[1], sizeof(buf[1])},
+		{0x20, buf[2], 0},
+		{0x30, buf[3], sizeof(buf[3])},
+	};
+	EXPECT_EQ(0, file->readv(vec, ARRAY_SIZE(vec)));
+	EXPECT_EQ(3U, file->preadCount());
+	file->unref();
+}
+
+/**
+ * readv_coalesced() reads requests within maxGap of each other
+ * using a single pread().
+ */
+TEST(ReadvCountTest, coalescedReadv)
+{
+	vector<uint8_t> data(0x40000);
+	CountingMemFile *const file = new CountingMemFile(data, 0x1000);
+
+	// Two groups of requests, separated by more than maxGap.
+	uint8_t buf[5][0x10];
+	const IRpFile::ReadVec vec[] = {
+		{0x20000, buf[0], sizeof(buf[0])},
+		{0x0,     buf[1], sizeof(buf[1])},
+		{0x800,   buf[2], sizeof(buf[2])},
+		{0x1810,  buf[3], sizeof(buf[3])},	// exactly maxGap after the previous request
+		{0x20400, buf[4], sizeof(buf[4])},
+	};
+	EXPECT_EQ(0, file->readv(vec, ARRAY_SIZE(vec)));
+	EXPECT_EQ(2U, file->preadCount());
+
+	// A single request is read directly.
+	file->resetPreadCount();
+	EXPECT_EQ(0, file->readv(vec, 1));
+	EXPECT_EQ(1U, file->preadCount());
+
+	// Requests further than maxGap apart are read separately.
+	file->resetPreadCount();
+	const IRpFile::ReadVec vecFar[] = {
+		{0x0,    buf[0], sizeof(buf[0])},
+		{0x1011, buf[1], sizeof(buf[1])},
+	};
+	EXPECT_EQ(0, file->readv(vecFar, ARRAY_SIZE(vecFar)));
+	EXPECT_EQ(2U, file->preadCount());
+
+	file->unref();
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpFile test suite: readv tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -19,6 +19,7 @@
 // C++ STL classes.
 using std::string;
 using std::u16string;
+using std::vector;
 using std::wstring;
 
 // libwin32common
@@ -510,4 +511,129 @@ int get_file_size_and_mtime(const string &filename, off64_t *pFileSize, time_t *
 	return 0;
 }
 
+/**
+ * Get a file's identity.
+ * @param filename	[in] Filename.
+ * @param pFileId	[out] File identity.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int get_file_id(const string &filename, FileId *pFileId)
+{
+	assert(pFileId != nullptr);
+	const tstring tfilename = makeWinPath(filename);
+
+	// Open the file to get the volume serial number and file index.
+	// NOTE: FILE_FLAG_BACKUP_SEMANTICS is needed in order to
+	// open directories, which are rejected below.
+	HANDLE hFile = CreateFile(tfilename.c_str(),
+		FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+	if (!hFile || hFile == INVALID_HANDLE_VALUE) {
+		// An error occurred.
+		const int err = w32err_to_posix(GetLastError());
+		return (err != 0 ? -err : -EIO);
+	}
+
+	BY_HANDLE_FILE_INFORMATION bhfi;
+	BOOL bRet = GetFileInformationByHandle(hFile, &bhfi);
+	const DWORD dwLastError = GetLastError();
+	CloseHandle(hFile);
+	if (!bRet) {
+		// An error occurred.
+		const int err = w32err_to_posix(dwLastError);
+		return (err != 0 ? -err : -EIO);
+	}
+
+	// Make sure this is not a directory.
+	if (bhfi.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+		// It's a directory.
+		return -EISDIR;
+	}
+
+	pFileId->dev = bhfi.dwVolumeSerialNumber;
+	pFileId->ino = (static_cast<uint64_t>(bhfi.nFileIndexHigh) << 32) | bhfi.nFileIndexLow;
+	pFileId->size = (static_cast<off64_t>(bhfi.nFileSizeHigh) << 32) | bhfi.nFileSizeLow;
+	pFileId->mtime_ns = (static_cast<int64_t>(bhfi.ftLastWriteTime.dwHighDateTime) << 32) |
+		bhfi.ftLastWriteTime.dwLowDateTime;
+	return 0;
+}
+
+/**
+ * Get the number of hard links to a file.
+ * @param filename Filename.
+ * @return Number of hard links, or negative POSIX error code on error.
+ */
+int get_link_count(const string &filename)
+{
+	const tstring tfilename = makeWinPath(filename);
+
+	HANDLE hFile = CreateFile(tfilename.c_str(),
+		FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, 0, nullptr);
+	if (!hFile || hFile == INVALID_HANDLE_VALUE) {
+		// An error occurred.
+		const int err = w32err_to_posix(GetLastError());
+		return (err != 0 ? -err : -EIO);
+	}
+
+	BY_HANDLE_FILE_INFORMATION bhfi;
+	BOOL bRet = GetFileInformationByHandle(hFile, &bhfi);
+	const DWORD dwLastError = GetLastError();
+	CloseHandle(hFile);
+	if (!bRet) {
+		// An error occurred.
+		const int err = w32err_to_posix(dwLastError);
+		return (err != 0 ? -err : -EIO);
+	}
+
+	return static_cast<int>(bhfi.nNumberOfLinks);
+}
+
+/**
+ * Get the names of the regular files in a directory.
+ * Subdirectories and the "." and ".." entries are skipped.
+ * @param dirname	[in] Directory name.
+ * @param vEntries	[out] Filenames. (not including the directory)
+ * @param pvSubdirs	[out,opt] If specified, subdirectory names are stored here.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int read_dir(const string &dirname, vector<string> &vEntries, vector<string> *pvSubdirs)
+{
+	tstring tpattern = makeWinPath(!dirname.empty() ? dirname : string("."));
+	if (!tpattern.empty() && tpattern[tpattern.size()-1] != _T('\\')) {
+		tpattern += _T('\\');
+	}
+	tpattern += _T('*');
+
+	WIN32_FIND_DATA ffd;
+	HANDLE hFind = FindFirstFile(tpattern.c_str(), &ffd);
+	if (!hFind || hFind == INVALID_HANDLE_VALUE) {
+		// An error occurred.
+		const int err = w32err_to_posix(GetLastError());
+		return (err != 0 ? -err : -EIO);
+	}
+
+	vEntries.clear();
+	if (pvSubdirs) {
+		pvSubdirs->clear();
+	}
+	do {
+		if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			// Directory. (includes "." and "..")
+			if (pvSubdirs && !(ffd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) &&
+			    !(ffd.cFileName[0] == _T('.') &&
+			      (ffd.cFileName[1] == _T('\0') ||
+			       (ffd.cFileName[1] == _T('.') && ffd.cFileName[2] == _T('\0')))))
+			{
+				pvSubdirs->emplace_back(T2U8_c(ffd.cFileName));
+			}
+			continue;
+		}
+		vEntries.emplace_back(T2U8_c(ffd.cFileName));
+	} while (FindNextFile(hFind, &ffd));
+
+	FindClose(hFind);
+	return 0;
+}
+
 } }
@@ -10,14 +10,15 @@
 
 #include "../RpFile.hpp"
 #include "../RpFile_p.hpp"
+#include "../RpStats.hpp"
 
 // libwin32common
 #include "libwin32common/MiniU82T.hpp"
 #include "libwin32common/w32err.h"
 using LibWin32Common::U82T_s;
 
-// C includes.
-#include <fcntl.h>
+// zlib (for DelayLoad verification)
+#include <zlib.h>
 
 // C++ STL classes.
 using std::string;
@@ -39,15 +40,37 @@ DELAYLOAD_TEST_FUNCTION_IMPL0(zlibVersion);
 
 RpFilePrivate::~RpFilePrivate()
 {
-	if (gzfd) {
-		gzclose_r(gzfd);
-	}
+	delete gzReader;
 	if (file && file != INVALID_HANDLE_VALUE) {
 		CloseHandle(file);
 	}
 	delete devInfo;
 }
 
+/**
+ * Read compressed data for gzReader.
+ * @param userdata	[in] RpFilePrivate
+ * @param pos		[in] Position in the compressed file.
+ * @param ptr		[out] Output buffer.
+ * @param size		[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpFilePrivate::gzReadFunc(void *userdata, off64_t pos, void *ptr, size_t size)
+{
+	RpFilePrivate *const d = static_cast<RpFilePrivate*>(userdata);
+	LARGE_INTEGER liSeekPos;
+	liSeekPos.QuadPart = pos;
+	if (!SetFilePointerEx(d->file, liSeekPos, nullptr, FILE_BEGIN)) {
+		return 0;
+	}
+
+	DWORD bytesRead;
+	if (!ReadFile(d->file, ptr, static_cast<DWORD>(size), &bytesRead, nullptr)) {
+		return 0;
+	}
+	return bytesRead;
+}
+
 /**
  * Convert an RpFile::FileMode to Win32 CreateFile() parameters.
  * @param mode				[in] FileMode
@@ -90,7 +113,7 @@ inline int RpFilePrivate::mode_to_win32(RpFile::FileMode mode,
 /**
  * (Re-)Open the main file.
  *
- * INTERNAL FUNCTION. This does NOT affect gzfd.
+ * INTERNAL FUNCTION. This does NOT affect gzReader.
  * NOTE: This function sets q->m_lastError.
  *
  * Uses parameters stored in this->filename and this->mode.
@@ -356,43 +379,22 @@ void RpFile::init(void)
 						// NOTE: Not sure if this is needed on Windows.
 						FlushFileBuffers(d->file);
 
-						// Open the file with gzdopen().
-						HANDLE hGzDup;
-						BOOL bRet = DuplicateHandle(
-							GetCurrentProcess(),	// hSourceProcessHandle
-							d->file,		// hSourceHandle
-							GetCurrentProcess(),	// hTargetProcessHandle
-							&hGzDup,		// lpTargetHandle
-							0,			// dwDesiredAccess
-							FALSE,			// bInheritHandle
-							DUPLICATE_SAME_ACCESS);	// dwOptions
-						if (bRet) {
-							// NOTE: close() on gzfd_dup() will close the
-							// underlying Windows handle.
-							int gzfd_dup = _open_osfhandle((intptr_t)hGzDup, _O_RDONLY);
-							if (gzfd_dup >= 0) {
-								// Make sure the CRC32 table is initialized.
-								get_crc_table();
-
-								d->gzfd = gzdopen(gzfd_dup, "r");
-								if (d->gzfd) {
-									m_isCompressed = true;
-								} else {
-									// gzdopen() failed.
-									// Close the dup()'d handle to prevent a leak.
-									_close(gzfd_dup);
-								}
-							} else {
-								// Unable to open an fd.
-								CloseHandle(hGzDup);
-							}
+						// Use random-access gzip decompression.
+						// NOTE: GzReader accesses d->file directly.
+						d->gzReader = new GzReader(RpFilePrivate::gzReadFunc, d);
+						if (d->gzReader->isOpen()) {
+							m_isCompressed = true;
+						} else {
+							// Error initializing the decompressor.
+							delete d->gzReader;
+							d->gzReader = nullptr;
 						}
 					}
 				}
 			}
 		}
 
-		if (!d->gzfd) {
+		if (!d->gzReader) {
 			// Not a gzipped file.
 			// Rewind and flush the file.
 			LARGE_INTEGER liSeekPos;
@@ -435,10 +437,8 @@ void RpFile::close(void)
 		d->devInfo->close();
 	}
 
-	if (d->gzfd) {
-		gzclose_r(d->gzfd);
-		d->gzfd = nullptr;
-	}
+	delete d->gzReader;
+	d->gzReader = nullptr;
 	if (d->file && d->file != INVALID_HANDLE_VALUE) {
 		CloseHandle(d->file);
 		d->file = INVALID_HANDLE_VALUE;
@@ -464,18 +464,18 @@ size_t RpFile::read(void *ptr, size_t size)
 
 	if (d->devInfo) {
 		// Block device. Need to read in multiples of the block size.
-		return d->readUsingBlocks(ptr, size);
+		const size_t ret = d->readUsingBlocks(ptr, size);
+		RpStats::add(RpStats::BYTES_READ_FILE, ret);
+		return ret;
 	}
 
 	DWORD bytesRead;
-	if (d->gzfd) {
-		int iret = gzread(d->gzfd, ptr, (unsigned int)size);
-		if (iret >= 0) {
-			bytesRead = (DWORD)iret;
-		} else {
+	if (d->gzReader) {
+		// NOTE: GzReader counts decompressed bytes itself.
+		bytesRead = static_cast<DWORD>(d->gzReader->read(ptr, size));
+		if (bytesRead != size && d->gzReader->lastError() != 0) {
 			// An error occurred.
-			bytesRead = 0;
-			m_lastError = errno;
+			m_lastError = d->gzReader->lastError();
 		}
 	} else {
 		BOOL bRet = ReadFile(d->file, ptr, static_cast<DWORD>(size), &bytesRead, nullptr);
@@ -484,11 +484,79 @@ size_t RpFile::read(void *ptr, size_t size)
 			m_lastError = w32err_to_posix(GetLastError());
 			bytesRead = 0;
 		}
+		RpStats::add(RpStats::BYTES_READ_FILE, bytesRead);
 	}
 
 	return bytesRead;
 }
 
+/**
+ * Read data from the specified file position.
+ * Uncompressed files are read without using the file position.
+ *
+ * NOTE: The file position is undefined afterwards.
+ *
+ * @param pos	[in] File position.
+ * @param ptr	[out] Output data buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpFile::pread(off64_t pos, void *ptr, size_t size)
+{
+	RP_D(RpFile);
+	if (!d->file || d->file == INVALID_HANDLE_VALUE) {
+		m_lastError = EBADF;
+		return 0;
+	} else if (size == 0) {
+		// Nothing to read.
+		return 0;
+	}
+
+	if (d->devInfo || d->gzReader) {
+		// Device files and compressed files have to be read using read().
+		return seekAndRead(pos, ptr, size);
+	}
+
+	// Read from the specified offset.
+	// NOTE: For synchronous handles, ReadFile() also moves
+	// the file pointer to the end of the data that was read.
+	OVERLAPPED ov;
+	memset(&ov, 0, sizeof(ov));
+	LARGE_INTEGER liPos;
+	liPos.QuadPart = pos;
+	ov.Offset = liPos.LowPart;
+	ov.OffsetHigh = static_cast<DWORD>(liPos.HighPart);
+
+	DWORD bytesRead;
+	BOOL bRet = ReadFile(d->file, ptr, static_cast<DWORD>(size), &bytesRead, &ov);
+	if (!bRet) {
+		const DWORD dwError = GetLastError();
+		if (dwError != ERROR_HANDLE_EOF) {
+			// An error occurred.
+			m_lastError = w32err_to_posix(dwError);
+		}
+		bytesRead = 0;
+	}
+	RpStats::add(RpStats::BYTES_READ_FILE, bytesRead);
+	return bytesRead;
+}
+
+/**
+ * Read data from multiple file positions.
+ * Nearby requests are coalesced into a single read.
+ *
+ * NOTE: The file position is undefined afterwards.
+ *
+ * @param vec	[in] Read requests.
+ * @param count	[in] Number of read requests.
+ * @return 0 if all requests were read completely; negative POSIX error code on error.
+ */
+int RpFile::readv(const ReadVec *vec, size_t count)
+{
+	// Reading a few extra KB is cheaper than an extra seek.
+	return readv_coalesced(vec, count, 16*1024);
+}
+
 /**
  * Write data to the file.
  * @param ptr Input data buffer.
@@ -550,17 +618,10 @@ int RpFile::seek(off64_t pos)
 	}
 
 	int ret;
-	if (d->gzfd) {
-		// FIXME: Might not work with >2GB files...
-		z_off_t zret = gzseek(d->gzfd, (long)pos, SEEK_SET);
-		if (zret >= 0) {
-			ret = 0;
-		} else {
-			ret = -1;
-			m_lastError = -errno;
-			if (m_lastError == 0) {
-				m_lastError = -EIO;
-			}
+	if (d->gzReader) {
+		ret = d->gzReader->seek(pos);
+		if (ret != 0) {
+			m_lastError = d->gzReader->lastError();
 		}
 	} else {
 		LARGE_INTEGER liSeekPos;
@@ -596,8 +657,8 @@ off64_t RpFile::tell(void)
 		return d->devInfo->device_pos;
 	}
 
-	if (d->gzfd) {
-		return (off64_t)gztell(d->gzfd);
+	if (d->gzReader) {
+		return d->gzReader->tell();
 	}
 
 	LARGE_INTEGER liSeekPos, liSeekRet;
@@ -706,7 +767,7 @@ off64_t RpFile::size(void)
 	if (d->devInfo) {
 		// Block device. Use the cached device size.
 		return d->devInfo->device_size;
-	} else if (d->gzfd) {
+	} else if (d->gzReader) {
 		// gzipped files have the uncompressed size stored
 		// at the end of the stream.
 		return d->gzsz;
@@ -100,6 +100,13 @@ int rp_secure_enable(rp_secure_param_t param)
 		seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, SCMP_SYS(clone),
 			(unsigned int)(sizeof(clone_params)/sizeof(clone_params[0])), clone_params);
 
+#if defined(__SNR_clone3) || defined(__NR_clone3)
+		// clone3() passes its flags in a struct, which can't be
+		// checked by seccomp. Make it fail with ENOSYS so glibc
+		// falls back to clone(), which is filtered above.
+		seccomp_rule_add_array(ctx, SCMP_ACT_ERRNO(ENOSYS), SCMP_SYS(clone3), 0, NULL);
+#endif /* __SNR_clone3 || __NR_clone3 */
+
 		// Skip clone() in the loop.
 		p++;
 	}
@@ -108,6 +115,9 @@ int rp_secure_enable(rp_secure_param_t param)
 	// TODO: More extensive syscall parameters?
 	for (; *p != -1; p++) {
 		assert(*p != SCMP_SYS(clone));
+#if defined(__SNR_clone3) || defined(__NR_clone3)
+		assert(*p != SCMP_SYS(clone3));
+#endif /* __SNR_clone3 || __NR_clone3 */
 		seccomp_rule_add_array(ctx, SCMP_ACT_ALLOW, *p, 0, NULL);
 	}
 
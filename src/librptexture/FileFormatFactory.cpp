@@ -16,9 +16,10 @@
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
 
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
 // C++ STL classes.
-using std::string;
-using std::unordered_set;
 using std::vector;
 
 // FileFormat subclasses.
@@ -81,10 +82,43 @@ class FileFormatFactoryPrivate
 		// FileFormat subclasses that use a header at 0 and
 		// definitely have a 32-bit magic number at address 0.
 		static const FileFormatFns FileFormatFns_magic[];
+
+		// Supported file extensions and MIME types.
+		// These are collected once per session.
+		static vector<const char*> vec_exts;
+		static vector<const char*> vec_mimeTypes;
+		static pthread_once_t once_exts;
+		static pthread_once_t once_mimeTypes;
+
+		/**
+		 * Collect strings from FileFormatFns_magic[].
+		 * The resulting vector is sorted, and duplicates are removed.
+		 * @param vec	[out] Vector.
+		 * @param pfn	[in] Member function pointer, e.g. &FileFormatFns::supportedMimeTypes.
+		 */
+		static void collectStrings(vector<const char*> &vec,
+			pfnSupportedFileExtensions_t FileFormatFns::*pfn);
+
+		/**
+		 * Initialize the vector of supported file extensions.
+		 * Internal function; must be called using pthread_once().
+		 */
+		static void init_supportedFileExtensions(void);
+
+		/**
+		 * Initialize the vector of supported MIME types.
+		 * Internal function; must be called using pthread_once().
+		 */
+		static void init_supportedMimeTypes(void);
 };
 
 /** FileFormatFactoryPrivate **/
 
+vector<const char*> FileFormatFactoryPrivate::vec_exts;
+vector<const char*> FileFormatFactoryPrivate::vec_mimeTypes;
+pthread_once_t FileFormatFactoryPrivate::once_exts = PTHREAD_ONCE_INIT;
+pthread_once_t FileFormatFactoryPrivate::once_mimeTypes = PTHREAD_ONCE_INIT;
+
 // FileFormat subclasses that use a header at 0 and
 // definitely have a 32-bit magic number at address 0.
 // TODO: Add support for multiple magic numbers per class.
@@ -198,86 +232,144 @@ FileFormat *FileFormatFactory::create(IRpFile *file)
 }
 
 /**
- * Get all supported file extensions.
- * Used for Win32 COM registration.
+ * Check if a texture file is supported without creating
+ * a FileFormat subclass.
  *
- * @return All supported file extensions, including the leading dot.
+ * Only the magic number is checked, so the texture file
+ * isn't guaranteed to be valid.
+ *
+ * @param pHeader	[in] Texture file header.
+ * @param size		[in] Size of pHeader.
+ * @param pMimeType	[out,opt] Primary MIME type of the matching FileFormat subclass.
+ * @return True if supported; false if not.
  */
-vector<const char*> FileFormatFactory::supportedFileExtensions(void)
+bool FileFormatFactory::isTextureSupported(const uint8_t *pHeader, size_t size, const char **pMimeType)
 {
-	// In order to handle multiple FileFormat subclasses
-	// that support the same extensions, we're using
-	// an unordered_set<string>.
-	//
-	// The actual data is stored in the vector<const char*>.
-	vector<const char*> vec_exts;
-	unordered_set<string> set_exts;
-
-	static const size_t reserve_size = ARRAY_SIZE(FileFormatFactoryPrivate::FileFormatFns_magic);
-	vec_exts.reserve(reserve_size);
-#ifdef HAVE_UNORDERED_SET_RESERVE
-	set_exts.reserve(reserve_size);
-#endif /* HAVE_UNORDERED_SET_RESERVE */
+	assert(pHeader != nullptr);
+	if (!pHeader || size < sizeof(uint32_t)*2) {
+		// Not enough data to check the magic number.
+		return false;
+	}
 
-	const FileFormatFactoryPrivate::FileFormatFns *fns =
-		&FileFormatFactoryPrivate::FileFormatFns_magic[0];
-	for (; fns->supportedFileExtensions != nullptr; fns++) {
-		const char *const *sys_exts = fns->supportedFileExtensions();
-		if (!sys_exts)
-			continue;
+	uint32_t magic[2];
+	memcpy(magic, pHeader, sizeof(magic));
 
-		for (; *sys_exts != nullptr; sys_exts++) {
-			auto iter = set_exts.find(*sys_exts);
-			if (iter == set_exts.end()) {
-				set_exts.insert(*sys_exts);
-				vec_exts.emplace_back(*sys_exts);
+	FileFormatFactoryPrivate::pfnSupportedMimeTypes_t pfnMimeTypes = nullptr;
+	if (magic[0] == cpu_to_be32('\xABKTX')) {
+		// Khronos KTX: Check the version.
+		if (magic[1] == cpu_to_be32(' 11\xBB')) {
+			// KTX 1.1
+			pfnMimeTypes = KhronosKTX::supportedMimeTypes_static;
+		} else if (magic[1] == cpu_to_be32(' 20\xBB')) {
+			// KTX 2.0
+			pfnMimeTypes = KhronosKTX2::supportedMimeTypes_static;
+		}
+	}
+
+	if (!pfnMimeTypes) {
+		magic[0] = be32_to_cpu(magic[0]);
+		const FileFormatFactoryPrivate::FileFormatFns *fns =
+			&FileFormatFactoryPrivate::FileFormatFns_magic[0];
+		for (; fns->supportedFileExtensions != nullptr; fns++) {
+			if (magic[0] == fns->magic) {
+				// Found a matching magic number.
+				pfnMimeTypes = fns->supportedMimeTypes;
+				break;
 			}
 		}
 	}
 
-	return vec_exts;
+	if (!pfnMimeTypes) {
+		// Not supported.
+		return false;
+	}
+
+	if (pMimeType) {
+		const char *const *mimeTypes = pfnMimeTypes();
+		*pMimeType = (mimeTypes ? mimeTypes[0] : nullptr);
+	}
+	return true;
 }
 
 /**
- * Get all supported MIME types.
- * Used for KFileMetaData.
- *
- * @return All supported MIME types.
+ * Collect strings from FileFormatFns_magic[].
+ * The resulting vector is sorted, and duplicates are removed.
+ * @param vec	[out] Vector.
+ * @param pfn	[in] Member function pointer, e.g. &FileFormatFns::supportedMimeTypes.
  */
-vector<const char*> FileFormatFactory::supportedMimeTypes(void)
+void FileFormatFactoryPrivate::collectStrings(vector<const char*> &vec,
+	pfnSupportedFileExtensions_t FileFormatFns::*pfn)
 {
-	// TODO: Add generic types, e.g. application/octet-stream?
+	vec.reserve(ARRAY_SIZE(FileFormatFns_magic) * 2);
+	for (const FileFormatFns *fns = &FileFormatFns_magic[0];
+	     fns->supportedFileExtensions != nullptr; fns++)
+	{
+		const char *const *strs = (fns->*pfn)();
+		if (!strs)
+			continue;
+		for (; *strs != nullptr; strs++) {
+			vec.emplace_back(*strs);
+		}
+	}
 
-	// In order to handle multiple FileFormat subclasses
-	// that support the same MIME types, we're using
-	// an unordered_set<string>. The actual data
-	// is stored in the vector<const char*>.
-	vector<const char*> vec_mimeTypes;
-	unordered_set<string> set_mimeTypes;
+	// Sort the strings and remove duplicates.
+	// NOTE: Multiple FileFormat subclasses may support the same
+	// extensions or MIME types, and the same pointer isn't
+	// guaranteed for identical strings, so strcmp() is used.
+	std::sort(vec.begin(), vec.end(),
+		[](const char *a, const char *b) { return strcmp(a, b) < 0; });
+	vec.erase(std::unique(vec.begin(), vec.end(),
+		[](const char *a, const char *b) { return !strcmp(a, b); }), vec.end());
+	vec.shrink_to_fit();
+}
 
-	static const size_t reserve_size = ARRAY_SIZE(FileFormatFactoryPrivate::FileFormatFns_magic) * 2;
-	vec_mimeTypes.reserve(reserve_size);
-#ifdef HAVE_UNORDERED_SET_RESERVE
-	set_mimeTypes.reserve(reserve_size);
-#endif /* HAVE_UNORDERED_SET_RESERVE */
+/**
+ * Initialize the vector of supported file extensions.
+ * Internal function; must be called using pthread_once().
+ */
+void FileFormatFactoryPrivate::init_supportedFileExtensions(void)
+{
+	collectStrings(vec_exts, &FileFormatFns::supportedFileExtensions);
+}
 
-	const FileFormatFactoryPrivate::FileFormatFns *fns =
-		&FileFormatFactoryPrivate::FileFormatFns_magic[0];
-	for (; fns->supportedFileExtensions != nullptr; fns++) {
-		const char *const *sys_mimeTypes = fns->supportedMimeTypes();
-		if (!sys_mimeTypes)
-			continue;
+/**
+ * Initialize the vector of supported MIME types.
+ * Internal function; must be called using pthread_once().
+ */
+void FileFormatFactoryPrivate::init_supportedMimeTypes(void)
+{
+	// TODO: Add generic types, e.g. application/octet-stream?
+	collectStrings(vec_mimeTypes, &FileFormatFns::supportedMimeTypes);
+}
 
-		for (; *sys_mimeTypes != nullptr; sys_mimeTypes++) {
-			auto iter = set_mimeTypes.find(*sys_mimeTypes);
-			if (iter == set_mimeTypes.end()) {
-				set_mimeTypes.insert(*sys_mimeTypes);
-				vec_mimeTypes.emplace_back(*sys_mimeTypes);
-			}
-		}
-	}
+/**
+ * Get all supported file extensions.
+ * Used for Win32 COM registration.
+ *
+ * The list is sorted, and duplicates are removed.
+ * It's built once per session.
+ *
+ * @return All supported file extensions, including the leading dot.
+ */
+const vector<const char*> &FileFormatFactory::supportedFileExtensions(void)
+{
+	pthread_once(&FileFormatFactoryPrivate::once_exts, FileFormatFactoryPrivate::init_supportedFileExtensions);
+	return FileFormatFactoryPrivate::vec_exts;
+}
 
-	return vec_mimeTypes;
+/**
+ * Get all supported MIME types.
+ * Used for KFileMetaData.
+ *
+ * The list is sorted, and duplicates are removed.
+ * It's built once per session.
+ *
+ * @return All supported MIME types.
+ */
+const vector<const char*> &FileFormatFactory::supportedMimeTypes(void)
+{
+	pthread_once(&FileFormatFactoryPrivate::once_mimeTypes, FileFormatFactoryPrivate::init_supportedMimeTypes);
+	return FileFormatFactoryPrivate::vec_mimeTypes;
 }
 
 }
@@ -47,21 +47,41 @@ class FileFormatFactory
 		 */
 		static LibRpTexture::FileFormat *create(LibRpFile::IRpFile *file);
 
+		/**
+		 * Check if a texture file is supported without creating
+		 * a FileFormat subclass.
+		 *
+		 * Only the magic number is checked, so the texture file
+		 * isn't guaranteed to be valid.
+		 *
+		 * @param pHeader	[in] Texture file header.
+		 * @param size		[in] Size of pHeader.
+		 * @param pMimeType	[out,opt] Primary MIME type of the matching FileFormat subclass.
+		 * @return True if supported; false if not.
+		 */
+		static bool isTextureSupported(const uint8_t *pHeader, size_t size, const char **pMimeType = nullptr);
+
 		/**
 		 * Get all supported file extensions.
 		 * Used for Win32 COM registration.
 		 *
+		 * The list is sorted, and duplicates are removed.
+		 * It's built once per session.
+		 *
 		 * @return All supported file extensions, including the leading dot.
 		 */
-		static std::vector<const char*> supportedFileExtensions(void);
+		static const std::vector<const char*> &supportedFileExtensions(void);
 
 		/**
 		 * Get all supported MIME types.
 		 * Used for KFileMetaData.
 		 *
+		 * The list is sorted, and duplicates are removed.
+		 * It's built once per session.
+		 *
 		 * @return All supported MIME types.
 		 */
-		static std::vector<const char*> supportedMimeTypes(void);
+		static const std::vector<const char*> &supportedMimeTypes(void);
 };
 
 }
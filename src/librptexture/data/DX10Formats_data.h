@@ -0,0 +1,188 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * DX10Formats_data.h: Generated lookup tables.                            *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: DX10Formats_data.txt                                            *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_DX10FORMATS_DATA_H__
+#define __ROMPROPERTIES_LIBRPTEXTURE_DX10FORMATS_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRpTexture { namespace DX10Formats_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (1769 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"R32G32B32A32_TYPELESS\0"
+	"R32G32B32A32_FLOAT\0"
+	"R32G32B32A32_UINT\0"
+	"R32G32B32A32_SINT\0"
+	"R32G32B32_TYPELESS\0"
+	"R32G32B32_FLOAT\0"
+	"R32G32B32_UINT\0"
+	"R32G32B32_SINT\0"
+	"R16G16B16A16_TYPELESS\0"
+	"R16G16B16A16_FLOAT\0"
+	"R16G16B16A16_UNORM\0"
+	"R16G16B16A16_UINT\0"
+	"R16G16B16A16_SNORM\0"
+	"R16G16B16A16_SINT\0"
+	"R32G32_TYPELESS\0"
+	"R32G32_FLOAT\0"
+	"R32G32_UINT\0"
+	"R32G32_SINT\0"
+	"R32G8X24_TYPELESS\0"
+	"D32_FLOAT_S8X24_UINT\0"
+	"R32_FLOAT_X8X24_TYPELESS\0"
+	"X32_TYPELESS_G8X24_UINT\0"
+	"R10G10B10A2_TYPELESS\0"
+	"R10G10B10A2_UNORM\0"
+	"R10G10B10A2_UINT\0"
+	"R11G11B10_FLOAT\0"
+	"R8G8B8A8_TYPELESS\0"
+	"R8G8B8A8_UNORM\0"
+	"R8G8B8A8_UNORM_SRGB\0"
+	"R8G8B8A8_UINT\0"
+	"R8G8B8A8_SNORM\0"
+	"R8G8B8A8_SINT\0"
+	"R16G16_TYPELESS\0"
+	"R16G16_FLOAT\0"
+	"R16G16_UNORM\0"
+	"R16G16_UINT\0"
+	"R16G16_SNORM\0"
+	"R16G16_SINT\0"
+	"R32_TYPELESS\0"
+	"D32_FLOAT\0"
+	"R32_FLOAT\0"
+	"R32_UINT\0"
+	"R32_SINT\0"
+	"R24G8_TYPELESS\0"
+	"D24_UNORM_S8_UINT\0"
+	"R24_UNORM_X8_TYPELESS\0"
+	"X24_TYPELESS_G8_UINT\0"
+	"R8G8_TYPELESS\0"
+	"R8G8_UNORM\0"
+	"R8G8_UINT\0"
+	"R8G8_SNORM\0"
+	"R8G8_SINT\0"
+	"R16_TYPELESS\0"
+	"R16_FLOAT\0"
+	"D16_UNORM\0"
+	"R16_UNORM\0"
+	"R16_UINT\0"
+	"R16_SNORM\0"
+	"R16_SINT\0"
+	"R8_TYPELESS\0"
+	"R8_UNORM\0"
+	"R8_UINT\0"
+	"R8_SNORM\0"
+	"R8_SINT\0"
+	"A8_UNORM\0"
+	"R1_UNORM\0"
+	"R9G9B9E5_SHAREDEXP\0"
+	"R8G8_B8G8_UNORM\0"
+	"G8R8_G8B8_UNORM\0"
+	"BC1_TYPELESS\0"
+	"BC1_UNORM\0"
+	"BC1_UNORM_SRGB\0"
+	"BC2_TYPELESS\0"
+	"BC2_UNORM\0"
+	"BC2_UNORM_SRGB\0"
+	"BC3_TYPELESS\0"
+	"BC3_UNORM\0"
+	"BC3_UNORM_SRGB\0"
+	"BC4_TYPELESS\0"
+	"BC4_UNORM\0"
+	"BC4_SNORM\0"
+	"BC5_TYPELESS\0"
+	"BC5_UNORM\0"
+	"BC5_SNORM\0"
+	"B5G6R5_UNORM\0"
+	"B5G5R5A1_UNORM\0"
+	"B8G8R8A8_UNORM\0"
+	"B8G8R8X8_UNORM\0"
+	"R10G10B10_XR_BIAS_A2_UNORM\0"
+	"B8G8R8A8_TYPELESS\0"
+	"B8G8R8A8_UNORM_SRGB\0"
+	"B8G8R8X8_TYPELESS\0"
+	"B8G8R8X8_UNORM_SRGB\0"
+	"BC6H_TYPELESS\0"
+	"BC6H_UF16\0"
+	"BC6H_SF16\0"
+	"BC7_TYPELESS\0"
+	"BC7_UNORM\0"
+	"BC7_UNORM_SRGB\0"
+	"AYUV\0"
+	"Y410\0"
+	"Y416\0"
+	"NV12\0"
+	"P010\0"
+	"P016\0"
+	"420_OPAQUE\0"
+	"YUY2\0"
+	"Y210\0"
+	"Y216\0"
+	"NV11\0"
+	"AI44\0"
+	"IA44\0"
+	"P8\0"
+	"A8P8\0"
+	"B4G4R4A4_UNORM\0"
+	"XBOX_R10G10B10_7E2_A2_FLOAT\0"
+	"XBOX_R10G10B10_6E4_A2_FLOAT\0"
+	"XBOX_D16_UNORM_S8_UINT\0"
+	"XBOX_R6_UNORM_X8_TYPELESS\0"
+	"XBOX_DXGI_FORMAT_X16_TYPELESS_G8_UINT\0"
+	"P208\0"
+	"V208\0"
+	"V408\0"
+	"XBOX_R10G10B10_SNORM_A2_UNORM\0"
+	"XBOX_R4G4_UNORM\0"
+	"FORCE_UINT\0"
+	"PVRTC 2bpp RGBA\0"
+	"PVRTC 4bpp RGBA\0";
+
+/** dxgiFormat: Array table (133 entries) **/
+static const unsigned int dxgiFormat_count = 133;
+static const uint16_t dxgiFormat_name[133] = {
+	0, 1, 23, 42, 60, 78, 97, 113, 128, 143, 165, 184,
+	203, 221, 240, 258, 274, 287, 299, 311, 329, 350, 375, 399,
+	420, 438, 455, 471, 489, 504, 524, 538, 553, 567, 583, 596,
+	609, 621, 634, 646, 659, 669, 679, 688, 697, 712, 730, 752,
+	773, 787, 798, 808, 819, 829, 842, 852, 862, 872, 881, 891,
+	900, 912, 921, 929, 938, 946, 955, 964, 983, 999, 1015, 1028,
+	1038, 1053, 1066, 1076, 1091, 1104, 1114, 1129, 1142, 1152, 1162, 1175,
+	1185, 1195, 1208, 1223, 1238, 1253, 1280, 1298, 1318, 1336, 1356, 1370,
+	1380, 1390, 1403, 1413, 1428, 1433, 1438, 1443, 1448, 1453, 1458, 1469,
+	1474, 1479, 1484, 1489, 1494, 1499, 1502, 1507, 1522, 1550, 1578, 1601,
+	1627, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1665, 1670,
+	1675,
+};
+
+/** dxgiFormat_ext: Perfect hash table (5 entries) **/
+static_assert(XBOX_DXGI_FORMAT_R10G10B10_SNORM_A2_UNORM == 0xBD, "XBOX_DXGI_FORMAT_R10G10B10_SNORM_A2_UNORM has changed.");
+static_assert(XBOX_DXGI_FORMAT_R4G4_UNORM == 0xBE, "XBOX_DXGI_FORMAT_R4G4_UNORM has changed.");
+static_assert(DXGI_FORMAT_FORCE_UINT == 0xFFFFFFFF, "DXGI_FORMAT_FORCE_UINT has changed.");
+static_assert(DXGI_FORMAT_FAKE_PVRTC_2bpp == 0xF9, "DXGI_FORMAT_FAKE_PVRTC_2bpp has changed.");
+static_assert(DXGI_FORMAT_FAKE_PVRTC_4bpp == 0xFA, "DXGI_FORMAT_FAKE_PVRTC_4bpp has changed.");
+static const uint32_t dxgiFormat_ext_keys[5] = {
+	0xBE, 0xF9, 0xFA, 0xBD, 0xFFFFFFFF,
+};
+static const int16_t dxgiFormat_ext_disp[5] = {
+	-4, -3, -2, 1, 0,
+};
+static const uint16_t dxgiFormat_ext_name[5] = {
+	1710, 1737, 1753, 1680, 1726,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_DX10FORMATS_DATA_H__ */
@@ -0,0 +1,556 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * GLenumStrings_data.h: Generated lookup tables.                          *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: GLenumStrings_data.txt                                          *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_GLENUMSTRINGS_DATA_H__
+#define __ROMPROPERTIES_LIBRPTEXTURE_GLENUMSTRINGS_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRpTexture { namespace GLenumStrings_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (4080 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"BYTE\0"
+	"UNSIGNED_BYTE\0"
+	"SHORT\0"
+	"UNSIGNED_SHORT\0"
+	"INT\0"
+	"UNSIGNED_INT\0"
+	"FLOAT\0"
+	"HALF_FLOAT\0"
+	"STENCIL_INDEX\0"
+	"DEPTH_COMPONENT\0"
+	"RED\0"
+	"GREEN\0"
+	"BLUE\0"
+	"RGB\0"
+	"RGBA\0"
+	"LUMINANCE\0"
+	"LUMINANCE_ALPHA\0"
+	"R3_G3_B2\0"
+	"UNSIGNED_BYTE_3_3_2\0"
+	"UNSIGNED_SHORT_4_4_4_4\0"
+	"UNSIGNED_SHORT_5_5_5_1\0"
+	"UNSIGNED_INT_8_8_8_8\0"
+	"UNSIGNED_INT_10_10_10_2\0"
+	"LUMINANCE4\0"
+	"LUMINANCE8\0"
+	"LUMINANCE12\0"
+	"LUMINANCE16\0"
+	"LUMINANCE4_ALPHA4\0"
+	"LUMINANCE6_ALPHA2\0"
+	"LUMINANCE8_ALPHA8\0"
+	"LUMINANCE12_ALPHA4\0"
+	"LUMINANCE12_ALPHA12\0"
+	"LUMINANCE16_ALPHA16\0"
+	"INTENSITY\0"
+	"INTENSITY4\0"
+	"INTENSITY8\0"
+	"INTENSITY12\0"
+	"INTENSITY16\0"
+	"RGB4\0"
+	"RGB5\0"
+	"RGB8\0"
+	"RGB10\0"
+	"RGB12\0"
+	"RGB16\0"
+	"RGBA2\0"
+	"RGBA4\0"
+	"RGB5_A1\0"
+	"RGBA8\0"
+	"RGB10_A2\0"
+	"RGBA12\0"
+	"RGBA16\0"
+	"BGR\0"
+	"BGRA\0"
+	"DEPTH_COMPONENT16\0"
+	"DEPTH_COMPONENT24\0"
+	"DEPTH_COMPONENT32\0"
+	"COMPRESSED_RED\0"
+	"COMPRESSED_RG\0"
+	"RG\0"
+	"RG_INTEGER\0"
+	"R8\0"
+	"R16\0"
+	"RG8\0"
+	"RG16\0"
+	"R16F\0"
+	"R32F\0"
+	"RG16F\0"
+	"RG32F\0"
+	"R8I\0"
+	"R8UI\0"
+	"R16I\0"
+	"R16UI\0"
+	"R32I\0"
+	"R32UI\0"
+	"RG8I\0"
+	"RG8UI\0"
+	"RG16I\0"
+	"RG16UI\0"
+	"RG32I\0"
+	"RG32UI\0"
+	"UNSIGNED_BYTE_2_3_3_REV\0"
+	"UNSIGNED_SHORT_5_6_5\0"
+	"UNSIGNED_SHORT_5_6_5_REV\0"
+	"UNSIGNED_SHORT_4_4_4_4_REV\0"
+	"UNSIGNED_SHORT_1_5_5_5_REV\0"
+	"UNSIGNED_INT_8_8_8_8_REV\0"
+	"UNSIGNED_INT_2_10_10_10_REV\0"
+	"RGB_S3TC\0"
+	"RGB4_S3TC\0"
+	"RGBA_S3TC\0"
+	"RGBA4_S3TC\0"
+	"RGBA_DXT5_S3TC\0"
+	"RGBA4_DXT5_S3TC\0"
+	"COMPRESSED_RGB_S3TC_DXT1_EXT\0"
+	"COMPRESSED_RGBA_S3TC_DXT1_EXT\0"
+	"COMPRESSED_RGBA_S3TC_DXT3_EXT\0"
+	"COMPRESSED_RGBA_S3TC_DXT5_EXT\0"
+	"COMPRESSED_ALPHA\0"
+	"COMPRESSED_LUMINANCE\0"
+	"COMPRESSED_LUMINANCE_ALPHA\0"
+	"COMPRESSED_INTENSITY\0"
+	"COMPRESSED_RGB\0"
+	"COMPRESSED_RGBA\0"
+	"DEPTH_STENCIL\0"
+	"UNSIGNED_INT_24_8\0"
+	"RGBA32F\0"
+	"RGB32F\0"
+	"RGBA16F\0"
+	"RGB16F\0"
+	"DEPTH24_STENCIL8\0"
+	"COMPRESSED_RGB_PVRTC_4BPPV1_IMG\0"
+	"COMPRESSED_RGB_PVRTC_2BPPV1_IMG\0"
+	"COMPRESSED_RGBA_PVRTC_4BPPV1_IMG\0"
+	"COMPRESSED_RGBA_PVRTC_2BPPV1_IMG\0"
+	"R11F_G11F_B10F\0"
+	"UNSIGNED_INT_10F_11F_11F_REV\0"
+	"RGB9_E5\0"
+	"UNSIGNED_INT_5_9_9_9_REV\0"
+	"SRGB\0"
+	"SRGB8\0"
+	"SRGB_ALPHA\0"
+	"SRGB8_ALPHA8\0"
+	"SLUMINANCE_ALPHA\0"
+	"SLUMINANCE8_ALPHA8\0"
+	"SLUMINANCE\0"
+	"SLUMINANCE8\0"
+	"COMPRESSED_SRGB\0"
+	"COMPRESSED_SRGB_ALPHA\0"
+	"COMPRESSED_SLUMINANCE\0"
+	"COMPRESSED_SLUMINANCE_ALPHA\0"
+	"COMPRESSED_LUMINANCE_LATC1_EXT\0"
+	"COMPRESSED_SIGNED_LUMINANCE_LATC1_EXT\0"
+	"COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT\0"
+	"COMPRESSED_SIGNED_LUMINANCE_ALPHA_LATC2_EXT\0"
+	"DEPTH_COMPONENT32F\0"
+	"DEPTH32F_STENCIL8\0"
+	"STENCIL_INDEX1\0"
+	"STENCIL_INDEX4\0"
+	"STENCIL_INDEX8\0"
+	"STENCIL_INDEX16\0"
+	"RGB565\0"
+	"ETC1_RGB8_OES\0"
+	"RGBA32UI\0"
+	"RGB32UI\0"
+	"RGBA16UI\0"
+	"RGB16UI\0"
+	"RGBA8UI\0"
+	"RGB8UI\0"
+	"RGBA32I\0"
+	"RGB32I\0"
+	"RGBA16I\0"
+	"RGB16I\0"
+	"RGBA8I\0"
+	"RGB8I\0"
+	"RED_INTEGER\0"
+	"GREEN_INTEGER\0"
+	"BLUE_INTEGER\0"
+	"ALPHA_INTEGER\0"
+	"RGB_INTEGER\0"
+	"RGBA_INTEGER\0"
+	"BGR_INTEGER\0"
+	"BGRA_INTEGER\0"
+	"INT_2_10_10_10_REV\0"
+	"FLOAT_32_UNSIGNED_INT_24_8_REV\0"
+	"COMPRESSED_RED_RGTC1\0"
+	"COMPRESSED_SIGNED_RED_RGTC1\0"
+	"COMPRESSED_RG_RGTC2\0"
+	"COMPRESSED_SIGNED_RG_RGTC2\0"
+	"COMPRESSED_RGBA_BPTC_UNORM\0"
+	"COMPRESSED_SRGB_ALPHA_BPTC_UNORM\0"
+	"COMPRESSED_RGB_BPTC_SIGNED_FLOAT\0"
+	"COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT\0"
+	"R8_SNORM\0"
+	"RG8_SNORM\0"
+	"RGB8_SNORM\0"
+	"RGBA8_SNORM\0"
+	"R16_SNORM\0"
+	"RG16_SNORM\0"
+	"RGB16_SNORM\0"
+	"RGBA16_SNORM\0"
+	"RGB10_A2UI\0"
+	"COMPRESSED_RGBA_PVRTC_2BPPV2_IMG\0"
+	"COMPRESSED_RGBA_PVRTC_4BPPV2_IMG\0"
+	"COMPRESSED_SRGB_PVRTC_2BPPV1_EXT\0"
+	"COMPRESSED_SRGB_PVRTC_4BPPV1_EXT\0"
+	"COMPRESSED_SRGB_ALPHA_PVRTC_2BPPV1_EXT\0"
+	"COMPRESSED_SRGB_ALPHA_PVRTC_4BPPV1_EXT\0"
+	"COMPRESSED_R11_EAC\0"
+	"COMPRESSED_SIGNED_R11_EAC\0"
+	"COMPRESSED_RG11_EAC\0"
+	"COMPRESSED_SIGNED_RG11_EAC\0"
+	"COMPRESSED_RGB8_ETC2\0"
+	"COMPRESSED_SRGB8_ETC2\0"
+	"COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2\0"
+	"COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2\0"
+	"COMPRESSED_RGBA8_ETC2_EAC\0"
+	"COMPRESSED_SRGB8_ALPHA8_ETC2_EAC\0"
+	"COMPRESSED_RGBA_ASTC_4x4_KHR\0"
+	"COMPRESSED_RGBA_ASTC_5x4_KHR\0"
+	"COMPRESSED_RGBA_ASTC_5x5_KHR\0"
+	"COMPRESSED_RGBA_ASTC_6x5_KHR\0"
+	"COMPRESSED_RGBA_ASTC_6x6_KHR\0"
+	"COMPRESSED_RGBA_ASTC_8x5_KHR\0"
+	"COMPRESSED_RGBA_ASTC_8x6_KHR\0"
+	"COMPRESSED_RGBA_ASTC_8x8_KHR\0"
+	"COMPRESSED_RGBA_ASTC_10x5_KHR\0"
+	"COMPRESSED_RGBA_ASTC_10x6_KHR\0"
+	"COMPRESSED_RGBA_ASTC_10x8_KHR\0"
+	"COMPRESSED_RGBA_ASTC_10x10_KHR\0"
+	"COMPRESSED_RGBA_ASTC_12x10_KHR\0"
+	"COMPRESSED_RGBA_ASTC_12x12_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR\0"
+	"COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR\0"
+	"COMPRESSED_SRGB_ALPHA_PVRTC_2BPPV2_IMG\0"
+	"COMPRESSED_SRGB_ALPHA_PVRTC_4BPPV2_IMG\0";
+
+/** glEnum: Perfect hash table (227 entries) **/
+static_assert(GL_BYTE == 0x1400, "GL_BYTE has changed.");
+static_assert(GL_UNSIGNED_BYTE == 0x1401, "GL_UNSIGNED_BYTE has changed.");
+static_assert(GL_SHORT == 0x1402, "GL_SHORT has changed.");
+static_assert(GL_UNSIGNED_SHORT == 0x1403, "GL_UNSIGNED_SHORT has changed.");
+static_assert(GL_INT == 0x1404, "GL_INT has changed.");
+static_assert(GL_UNSIGNED_INT == 0x1405, "GL_UNSIGNED_INT has changed.");
+static_assert(GL_FLOAT == 0x1406, "GL_FLOAT has changed.");
+static_assert(GL_HALF_FLOAT == 0x140B, "GL_HALF_FLOAT has changed.");
+static_assert(GL_STENCIL_INDEX == 0x1901, "GL_STENCIL_INDEX has changed.");
+static_assert(GL_DEPTH_COMPONENT == 0x1902, "GL_DEPTH_COMPONENT has changed.");
+static_assert(GL_RED == 0x1903, "GL_RED has changed.");
+static_assert(GL_GREEN == 0x1904, "GL_GREEN has changed.");
+static_assert(GL_BLUE == 0x1905, "GL_BLUE has changed.");
+static_assert(GL_RGB == 0x1907, "GL_RGB has changed.");
+static_assert(GL_RGBA == 0x1908, "GL_RGBA has changed.");
+static_assert(GL_LUMINANCE == 0x1909, "GL_LUMINANCE has changed.");
+static_assert(GL_LUMINANCE_ALPHA == 0x190A, "GL_LUMINANCE_ALPHA has changed.");
+static_assert(GL_R3_G3_B2 == 0x2A10, "GL_R3_G3_B2 has changed.");
+static_assert(GL_UNSIGNED_BYTE_3_3_2 == 0x8032, "GL_UNSIGNED_BYTE_3_3_2 has changed.");
+static_assert(GL_UNSIGNED_SHORT_4_4_4_4 == 0x8033, "GL_UNSIGNED_SHORT_4_4_4_4 has changed.");
+static_assert(GL_UNSIGNED_SHORT_5_5_5_1 == 0x8034, "GL_UNSIGNED_SHORT_5_5_5_1 has changed.");
+static_assert(GL_UNSIGNED_INT_8_8_8_8 == 0x8035, "GL_UNSIGNED_INT_8_8_8_8 has changed.");
+static_assert(GL_UNSIGNED_INT_10_10_10_2 == 0x8036, "GL_UNSIGNED_INT_10_10_10_2 has changed.");
+static_assert(GL_LUMINANCE4 == 0x803F, "GL_LUMINANCE4 has changed.");
+static_assert(GL_LUMINANCE8 == 0x8040, "GL_LUMINANCE8 has changed.");
+static_assert(GL_LUMINANCE12 == 0x8041, "GL_LUMINANCE12 has changed.");
+static_assert(GL_LUMINANCE16 == 0x8042, "GL_LUMINANCE16 has changed.");
+static_assert(GL_LUMINANCE4_ALPHA4 == 0x8043, "GL_LUMINANCE4_ALPHA4 has changed.");
+static_assert(GL_LUMINANCE6_ALPHA2 == 0x8044, "GL_LUMINANCE6_ALPHA2 has changed.");
+static_assert(GL_LUMINANCE8_ALPHA8 == 0x8045, "GL_LUMINANCE8_ALPHA8 has changed.");
+static_assert(GL_LUMINANCE12_ALPHA4 == 0x8046, "GL_LUMINANCE12_ALPHA4 has changed.");
+static_assert(GL_LUMINANCE12_ALPHA12 == 0x8047, "GL_LUMINANCE12_ALPHA12 has changed.");
+static_assert(GL_LUMINANCE16_ALPHA16 == 0x8048, "GL_LUMINANCE16_ALPHA16 has changed.");
+static_assert(GL_INTENSITY == 0x8049, "GL_INTENSITY has changed.");
+static_assert(GL_INTENSITY4 == 0x804A, "GL_INTENSITY4 has changed.");
+static_assert(GL_INTENSITY8 == 0x804B, "GL_INTENSITY8 has changed.");
+static_assert(GL_INTENSITY12 == 0x804C, "GL_INTENSITY12 has changed.");
+static_assert(GL_INTENSITY16 == 0x804D, "GL_INTENSITY16 has changed.");
+static_assert(GL_RGB4 == 0x804F, "GL_RGB4 has changed.");
+static_assert(GL_RGB5 == 0x8050, "GL_RGB5 has changed.");
+static_assert(GL_RGB8 == 0x8051, "GL_RGB8 has changed.");
+static_assert(GL_RGB10 == 0x8052, "GL_RGB10 has changed.");
+static_assert(GL_RGB12 == 0x8053, "GL_RGB12 has changed.");
+static_assert(GL_RGB16 == 0x8054, "GL_RGB16 has changed.");
+static_assert(GL_RGBA2 == 0x8055, "GL_RGBA2 has changed.");
+static_assert(GL_RGBA4 == 0x8056, "GL_RGBA4 has changed.");
+static_assert(GL_RGB5_A1 == 0x8057, "GL_RGB5_A1 has changed.");
+static_assert(GL_RGBA8 == 0x8058, "GL_RGBA8 has changed.");
+static_assert(GL_RGB10_A2 == 0x8059, "GL_RGB10_A2 has changed.");
+static_assert(GL_RGBA12 == 0x805A, "GL_RGBA12 has changed.");
+static_assert(GL_RGBA16 == 0x805B, "GL_RGBA16 has changed.");
+static_assert(GL_BGR == 0x80E0, "GL_BGR has changed.");
+static_assert(GL_BGRA == 0x80E1, "GL_BGRA has changed.");
+static_assert(GL_DEPTH_COMPONENT16 == 0x81A5, "GL_DEPTH_COMPONENT16 has changed.");
+static_assert(GL_DEPTH_COMPONENT24 == 0x81A6, "GL_DEPTH_COMPONENT24 has changed.");
+static_assert(GL_DEPTH_COMPONENT32 == 0x81A7, "GL_DEPTH_COMPONENT32 has changed.");
+static_assert(GL_COMPRESSED_RED == 0x8225, "GL_COMPRESSED_RED has changed.");
+static_assert(GL_COMPRESSED_RG == 0x8226, "GL_COMPRESSED_RG has changed.");
+static_assert(GL_RG == 0x8227, "GL_RG has changed.");
+static_assert(GL_RG_INTEGER == 0x8228, "GL_RG_INTEGER has changed.");
+static_assert(GL_R8 == 0x8229, "GL_R8 has changed.");
+static_assert(GL_R16 == 0x822A, "GL_R16 has changed.");
+static_assert(GL_RG8 == 0x822B, "GL_RG8 has changed.");
+static_assert(GL_RG16 == 0x822C, "GL_RG16 has changed.");
+static_assert(GL_R16F == 0x822D, "GL_R16F has changed.");
+static_assert(GL_R32F == 0x822E, "GL_R32F has changed.");
+static_assert(GL_RG16F == 0x822F, "GL_RG16F has changed.");
+static_assert(GL_RG32F == 0x8230, "GL_RG32F has changed.");
+static_assert(GL_R8I == 0x8231, "GL_R8I has changed.");
+static_assert(GL_R8UI == 0x8232, "GL_R8UI has changed.");
+static_assert(GL_R16I == 0x8233, "GL_R16I has changed.");
+static_assert(GL_R16UI == 0x8234, "GL_R16UI has changed.");
+static_assert(GL_R32I == 0x8235, "GL_R32I has changed.");
+static_assert(GL_R32UI == 0x8236, "GL_R32UI has changed.");
+static_assert(GL_RG8I == 0x8237, "GL_RG8I has changed.");
+static_assert(GL_RG8UI == 0x8238, "GL_RG8UI has changed.");
+static_assert(GL_RG16I == 0x8239, "GL_RG16I has changed.");
+static_assert(GL_RG16UI == 0x823A, "GL_RG16UI has changed.");
+static_assert(GL_RG32I == 0x823B, "GL_RG32I has changed.");
+static_assert(GL_RG32UI == 0x823C, "GL_RG32UI has changed.");
+static_assert(GL_UNSIGNED_BYTE_2_3_3_REV == 0x8362, "GL_UNSIGNED_BYTE_2_3_3_REV has changed.");
+static_assert(GL_UNSIGNED_SHORT_5_6_5 == 0x8363, "GL_UNSIGNED_SHORT_5_6_5 has changed.");
+static_assert(GL_UNSIGNED_SHORT_5_6_5_REV == 0x8364, "GL_UNSIGNED_SHORT_5_6_5_REV has changed.");
+static_assert(GL_UNSIGNED_SHORT_4_4_4_4_REV == 0x8365, "GL_UNSIGNED_SHORT_4_4_4_4_REV has changed.");
+static_assert(GL_UNSIGNED_SHORT_1_5_5_5_REV == 0x8366, "GL_UNSIGNED_SHORT_1_5_5_5_REV has changed.");
+static_assert(GL_UNSIGNED_INT_8_8_8_8_REV == 0x8367, "GL_UNSIGNED_INT_8_8_8_8_REV has changed.");
+static_assert(GL_UNSIGNED_INT_2_10_10_10_REV == 0x8368, "GL_UNSIGNED_INT_2_10_10_10_REV has changed.");
+static_assert(GL_RGB_S3TC == 0x83A0, "GL_RGB_S3TC has changed.");
+static_assert(GL_RGB4_S3TC == 0x83A1, "GL_RGB4_S3TC has changed.");
+static_assert(GL_RGBA_S3TC == 0x83A2, "GL_RGBA_S3TC has changed.");
+static_assert(GL_RGBA4_S3TC == 0x83A3, "GL_RGBA4_S3TC has changed.");
+static_assert(GL_RGBA_DXT5_S3TC == 0x83A4, "GL_RGBA_DXT5_S3TC has changed.");
+static_assert(GL_RGBA4_DXT5_S3TC == 0x83A5, "GL_RGBA4_DXT5_S3TC has changed.");
+static_assert(GL_COMPRESSED_RGB_S3TC_DXT1_EXT == 0x83F0, "GL_COMPRESSED_RGB_S3TC_DXT1_EXT has changed.");
+static_assert(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT == 0x83F1, "GL_COMPRESSED_RGBA_S3TC_DXT1_EXT has changed.");
+static_assert(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT == 0x83F2, "GL_COMPRESSED_RGBA_S3TC_DXT3_EXT has changed.");
+static_assert(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT == 0x83F3, "GL_COMPRESSED_RGBA_S3TC_DXT5_EXT has changed.");
+static_assert(GL_COMPRESSED_ALPHA == 0x84E9, "GL_COMPRESSED_ALPHA has changed.");
+static_assert(GL_COMPRESSED_LUMINANCE == 0x84EA, "GL_COMPRESSED_LUMINANCE has changed.");
+static_assert(GL_COMPRESSED_LUMINANCE_ALPHA == 0x84EB, "GL_COMPRESSED_LUMINANCE_ALPHA has changed.");
+static_assert(GL_COMPRESSED_INTENSITY == 0x84EC, "GL_COMPRESSED_INTENSITY has changed.");
+static_assert(GL_COMPRESSED_RGB == 0x84ED, "GL_COMPRESSED_RGB has changed.");
+static_assert(GL_COMPRESSED_RGBA == 0x84EE, "GL_COMPRESSED_RGBA has changed.");
+static_assert(GL_DEPTH_STENCIL == 0x84F9, "GL_DEPTH_STENCIL has changed.");
+static_assert(GL_UNSIGNED_INT_24_8 == 0x84FA, "GL_UNSIGNED_INT_24_8 has changed.");
+static_assert(GL_RGBA32F == 0x8814, "GL_RGBA32F has changed.");
+static_assert(GL_RGB32F == 0x8815, "GL_RGB32F has changed.");
+static_assert(GL_RGBA16F == 0x881A, "GL_RGBA16F has changed.");
+static_assert(GL_RGB16F == 0x881B, "GL_RGB16F has changed.");
+static_assert(GL_DEPTH24_STENCIL8 == 0x88F0, "GL_DEPTH24_STENCIL8 has changed.");
+static_assert(GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG == 0x8C00, "GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG has changed.");
+static_assert(GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG == 0x8C01, "GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG has changed.");
+static_assert(GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG == 0x8C02, "GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG has changed.");
+static_assert(GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG == 0x8C03, "GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG has changed.");
+static_assert(GL_R11F_G11F_B10F == 0x8C3A, "GL_R11F_G11F_B10F has changed.");
+static_assert(GL_UNSIGNED_INT_10F_11F_11F_REV == 0x8C3B, "GL_UNSIGNED_INT_10F_11F_11F_REV has changed.");
+static_assert(GL_RGB9_E5 == 0x8C3D, "GL_RGB9_E5 has changed.");
+static_assert(GL_UNSIGNED_INT_5_9_9_9_REV == 0x8C3E, "GL_UNSIGNED_INT_5_9_9_9_REV has changed.");
+static_assert(GL_SRGB == 0x8C40, "GL_SRGB has changed.");
+static_assert(GL_SRGB8 == 0x8C41, "GL_SRGB8 has changed.");
+static_assert(GL_SRGB_ALPHA == 0x8C42, "GL_SRGB_ALPHA has changed.");
+static_assert(GL_SRGB8_ALPHA8 == 0x8C43, "GL_SRGB8_ALPHA8 has changed.");
+static_assert(GL_SLUMINANCE_ALPHA == 0x8C44, "GL_SLUMINANCE_ALPHA has changed.");
+static_assert(GL_SLUMINANCE8_ALPHA8 == 0x8C45, "GL_SLUMINANCE8_ALPHA8 has changed.");
+static_assert(GL_SLUMINANCE == 0x8C46, "GL_SLUMINANCE has changed.");
+static_assert(GL_SLUMINANCE8 == 0x8C47, "GL_SLUMINANCE8 has changed.");
+static_assert(GL_COMPRESSED_SRGB == 0x8C48, "GL_COMPRESSED_SRGB has changed.");
+static_assert(GL_COMPRESSED_SRGB_ALPHA == 0x8C49, "GL_COMPRESSED_SRGB_ALPHA has changed.");
+static_assert(GL_COMPRESSED_SLUMINANCE == 0x8C4A, "GL_COMPRESSED_SLUMINANCE has changed.");
+static_assert(GL_COMPRESSED_SLUMINANCE_ALPHA == 0x8C4B, "GL_COMPRESSED_SLUMINANCE_ALPHA has changed.");
+static_assert(GL_COMPRESSED_LUMINANCE_LATC1_EXT == 0x8C70, "GL_COMPRESSED_LUMINANCE_LATC1_EXT has changed.");
+static_assert(GL_COMPRESSED_SIGNED_LUMINANCE_LATC1_EXT == 0x8C71, "GL_COMPRESSED_SIGNED_LUMINANCE_LATC1_EXT has changed.");
+static_assert(GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT == 0x8C72, "GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT has changed.");
+static_assert(GL_COMPRESSED_SIGNED_LUMINANCE_ALPHA_LATC2_EXT == 0x8C73, "GL_COMPRESSED_SIGNED_LUMINANCE_ALPHA_LATC2_EXT has changed.");
+static_assert(GL_DEPTH_COMPONENT32F == 0x8CAC, "GL_DEPTH_COMPONENT32F has changed.");
+static_assert(GL_DEPTH32F_STENCIL8 == 0x8CAD, "GL_DEPTH32F_STENCIL8 has changed.");
+static_assert(GL_STENCIL_INDEX1 == 0x8D46, "GL_STENCIL_INDEX1 has changed.");
+static_assert(GL_STENCIL_INDEX4 == 0x8D47, "GL_STENCIL_INDEX4 has changed.");
+static_assert(GL_STENCIL_INDEX8 == 0x8D48, "GL_STENCIL_INDEX8 has changed.");
+static_assert(GL_STENCIL_INDEX16 == 0x8D49, "GL_STENCIL_INDEX16 has changed.");
+static_assert(GL_RGB565 == 0x8D62, "GL_RGB565 has changed.");
+static_assert(GL_ETC1_RGB8_OES == 0x8D64, "GL_ETC1_RGB8_OES has changed.");
+static_assert(GL_RGBA32UI == 0x8D70, "GL_RGBA32UI has changed.");
+static_assert(GL_RGB32UI == 0x8D71, "GL_RGB32UI has changed.");
+static_assert(GL_RGBA16UI == 0x8D76, "GL_RGBA16UI has changed.");
+static_assert(GL_RGB16UI == 0x8D77, "GL_RGB16UI has changed.");
+static_assert(GL_RGBA8UI == 0x8D7C, "GL_RGBA8UI has changed.");
+static_assert(GL_RGB8UI == 0x8D7D, "GL_RGB8UI has changed.");
+static_assert(GL_RGBA32I == 0x8D82, "GL_RGBA32I has changed.");
+static_assert(GL_RGB32I == 0x8D83, "GL_RGB32I has changed.");
+static_assert(GL_RGBA16I == 0x8D88, "GL_RGBA16I has changed.");
+static_assert(GL_RGB16I == 0x8D89, "GL_RGB16I has changed.");
+static_assert(GL_RGBA8I == 0x8D8E, "GL_RGBA8I has changed.");
+static_assert(GL_RGB8I == 0x8D8F, "GL_RGB8I has changed.");
+static_assert(GL_RED_INTEGER == 0x8D94, "GL_RED_INTEGER has changed.");
+static_assert(GL_GREEN_INTEGER == 0x8D95, "GL_GREEN_INTEGER has changed.");
+static_assert(GL_BLUE_INTEGER == 0x8D96, "GL_BLUE_INTEGER has changed.");
+static_assert(GL_ALPHA_INTEGER == 0x8D97, "GL_ALPHA_INTEGER has changed.");
+static_assert(GL_RGB_INTEGER == 0x8D98, "GL_RGB_INTEGER has changed.");
+static_assert(GL_RGBA_INTEGER == 0x8D99, "GL_RGBA_INTEGER has changed.");
+static_assert(GL_BGR_INTEGER == 0x8D9A, "GL_BGR_INTEGER has changed.");
+static_assert(GL_BGRA_INTEGER == 0x8D9B, "GL_BGRA_INTEGER has changed.");
+static_assert(GL_INT_2_10_10_10_REV == 0x8D9F, "GL_INT_2_10_10_10_REV has changed.");
+static_assert(GL_FLOAT_32_UNSIGNED_INT_24_8_REV == 0x8DAD, "GL_FLOAT_32_UNSIGNED_INT_24_8_REV has changed.");
+static_assert(GL_COMPRESSED_RED_RGTC1 == 0x8DBB, "GL_COMPRESSED_RED_RGTC1 has changed.");
+static_assert(GL_COMPRESSED_SIGNED_RED_RGTC1 == 0x8DBC, "GL_COMPRESSED_SIGNED_RED_RGTC1 has changed.");
+static_assert(GL_COMPRESSED_RG_RGTC2 == 0x8DBD, "GL_COMPRESSED_RG_RGTC2 has changed.");
+static_assert(GL_COMPRESSED_SIGNED_RG_RGTC2 == 0x8DBE, "GL_COMPRESSED_SIGNED_RG_RGTC2 has changed.");
+static_assert(GL_COMPRESSED_RGBA_BPTC_UNORM == 0x8E8C, "GL_COMPRESSED_RGBA_BPTC_UNORM has changed.");
+static_assert(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM == 0x8E8D, "GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM has changed.");
+static_assert(GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT == 0x8E8E, "GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT has changed.");
+static_assert(GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT == 0x8E8F, "GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT has changed.");
+static_assert(GL_R8_SNORM == 0x8F94, "GL_R8_SNORM has changed.");
+static_assert(GL_RG8_SNORM == 0x8F95, "GL_RG8_SNORM has changed.");
+static_assert(GL_RGB8_SNORM == 0x8F96, "GL_RGB8_SNORM has changed.");
+static_assert(GL_RGBA8_SNORM == 0x8F97, "GL_RGBA8_SNORM has changed.");
+static_assert(GL_R16_SNORM == 0x8F98, "GL_R16_SNORM has changed.");
+static_assert(GL_RG16_SNORM == 0x8F99, "GL_RG16_SNORM has changed.");
+static_assert(GL_RGB16_SNORM == 0x8F9A, "GL_RGB16_SNORM has changed.");
+static_assert(GL_RGBA16_SNORM == 0x8F9B, "GL_RGBA16_SNORM has changed.");
+static_assert(GL_RGB10_A2UI == 0x906F, "GL_RGB10_A2UI has changed.");
+static_assert(GL_COMPRESSED_RGBA_PVRTC_2BPPV2_IMG == 0x9137, "GL_COMPRESSED_RGBA_PVRTC_2BPPV2_IMG has changed.");
+static_assert(GL_COMPRESSED_RGBA_PVRTC_4BPPV2_IMG == 0x9138, "GL_COMPRESSED_RGBA_PVRTC_4BPPV2_IMG has changed.");
+static_assert(GL_COMPRESSED_SRGB_PVRTC_2BPPV1_EXT == 0x8A54, "GL_COMPRESSED_SRGB_PVRTC_2BPPV1_EXT has changed.");
+static_assert(GL_COMPRESSED_SRGB_PVRTC_4BPPV1_EXT == 0x8A55, "GL_COMPRESSED_SRGB_PVRTC_4BPPV1_EXT has changed.");
+static_assert(GL_COMPRESSED_SRGB_ALPHA_PVRTC_2BPPV1_EXT == 0x8A56, "GL_COMPRESSED_SRGB_ALPHA_PVRTC_2BPPV1_EXT has changed.");
+static_assert(GL_COMPRESSED_SRGB_ALPHA_PVRTC_4BPPV1_EXT == 0x8A57, "GL_COMPRESSED_SRGB_ALPHA_PVRTC_4BPPV1_EXT has changed.");
+static_assert(GL_COMPRESSED_R11_EAC == 0x9270, "GL_COMPRESSED_R11_EAC has changed.");
+static_assert(GL_COMPRESSED_SIGNED_R11_EAC == 0x9271, "GL_COMPRESSED_SIGNED_R11_EAC has changed.");
+static_assert(GL_COMPRESSED_RG11_EAC == 0x9272, "GL_COMPRESSED_RG11_EAC has changed.");
+static_assert(GL_COMPRESSED_SIGNED_RG11_EAC == 0x9273, "GL_COMPRESSED_SIGNED_RG11_EAC has changed.");
+static_assert(GL_COMPRESSED_RGB8_ETC2 == 0x9274, "GL_COMPRESSED_RGB8_ETC2 has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ETC2 == 0x9275, "GL_COMPRESSED_SRGB8_ETC2 has changed.");
+static_assert(GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 == 0x9276, "GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 has changed.");
+static_assert(GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 == 0x9277, "GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2 has changed.");
+static_assert(GL_COMPRESSED_RGBA8_ETC2_EAC == 0x9278, "GL_COMPRESSED_RGBA8_ETC2_EAC has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC == 0x9279, "GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_4x4_KHR == 0x93B0, "GL_COMPRESSED_RGBA_ASTC_4x4_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_5x4_KHR == 0x93B1, "GL_COMPRESSED_RGBA_ASTC_5x4_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_5x5_KHR == 0x93B2, "GL_COMPRESSED_RGBA_ASTC_5x5_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_6x5_KHR == 0x93B3, "GL_COMPRESSED_RGBA_ASTC_6x5_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_6x6_KHR == 0x93B4, "GL_COMPRESSED_RGBA_ASTC_6x6_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_8x5_KHR == 0x93B5, "GL_COMPRESSED_RGBA_ASTC_8x5_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_8x6_KHR == 0x93B6, "GL_COMPRESSED_RGBA_ASTC_8x6_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_8x8_KHR == 0x93B7, "GL_COMPRESSED_RGBA_ASTC_8x8_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_10x5_KHR == 0x93B8, "GL_COMPRESSED_RGBA_ASTC_10x5_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_10x6_KHR == 0x93B9, "GL_COMPRESSED_RGBA_ASTC_10x6_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_10x8_KHR == 0x93BA, "GL_COMPRESSED_RGBA_ASTC_10x8_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_10x10_KHR == 0x93BB, "GL_COMPRESSED_RGBA_ASTC_10x10_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_12x10_KHR == 0x93BC, "GL_COMPRESSED_RGBA_ASTC_12x10_KHR has changed.");
+static_assert(GL_COMPRESSED_RGBA_ASTC_12x12_KHR == 0x93BD, "GL_COMPRESSED_RGBA_ASTC_12x12_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR == 0x93D0, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR == 0x93D1, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR == 0x93D2, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR == 0x93D3, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR == 0x93D4, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR == 0x93D5, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR == 0x93D6, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR == 0x93D7, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR == 0x93D8, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR == 0x93D9, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR == 0x93DA, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR == 0x93DB, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR == 0x93DC, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR == 0x93DD, "GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR has changed.");
+static_assert(GL_COMPRESSED_SRGB_ALPHA_PVRTC_2BPPV2_IMG == 0x93F0, "GL_COMPRESSED_SRGB_ALPHA_PVRTC_2BPPV2_IMG has changed.");
+static_assert(GL_COMPRESSED_SRGB_ALPHA_PVRTC_4BPPV2_IMG == 0x93F1, "GL_COMPRESSED_SRGB_ALPHA_PVRTC_4BPPV2_IMG has changed.");
+static const uint32_t glEnum_keys[227] = {
+	0x8229, 0x8055, 0x822D, 0x83F3, 0x8362, 0x84FA, 0x8DAD, 0x8C41,
+	0x8C3B, 0x805B, 0x8D8F, 0x8C02, 0x8814, 0x1909, 0x84F9, 0x190A,
+	0x803F, 0x93D0, 0x8C70, 0x93D4, 0x8A55, 0x8234, 0x805A, 0x8D77,
+	0x8C4B, 0x93D9, 0x8034, 0x8228, 0x8D82, 0x1403, 0x93DC, 0x1908,
+	0x8D48, 0x8CAD, 0x8059, 0x83A3, 0x8D9B, 0x822E, 0x84EA, 0x881A,
+	0x8C45, 0x1901, 0x93D5, 0x822A, 0x8D83, 0x1905, 0x93B4, 0x8D47,
+	0x8D96, 0x8052, 0x823C, 0x8C00, 0x83F1, 0x8056, 0x8C03, 0x140B,
+	0x8DBC, 0x8D62, 0x93B7, 0x8C48, 0x8D7C, 0x8F9B, 0x8231, 0x8A56,
+	0x8D76, 0x8043, 0x822B, 0x8DBB, 0x8366, 0x8D8E, 0x8046, 0x1907,
+	0x8C3D, 0x93D1, 0x8364, 0x9274, 0x84EC, 0x93DD, 0x8D88, 0x823A,
+	0x8235, 0x8044, 0x8D94, 0x83F2, 0x8C3E, 0x8033, 0x8815, 0x804A,
+	0x8A54, 0x93D6, 0x83F0, 0x8D7D, 0x8D98, 0x93D2, 0x8F97, 0x822F,
+	0x83A1, 0x1401, 0x93B2, 0x8032, 0x8C01, 0x9272, 0x8048, 0x8F96,
+	0x8230, 0x84EE, 0x8C49, 0x8E8D, 0x8237, 0x8226, 0x84EB, 0x83A5,
+	0x8058, 0x8C71, 0x93B0, 0x8D9F, 0x906F, 0x1405, 0x8C47, 0x8D97,
+	0x8C72, 0x8D64, 0x81A7, 0x9271, 0x8042, 0x8238, 0x93D7, 0x8E8F,
+	0x9137, 0x8D95, 0x881B, 0x8045, 0x93D8, 0x2A10, 0x1404, 0x8041,
+	0x8D89, 0x8239, 0x93B8, 0x8DBE, 0x8D46, 0x804D, 0x8365, 0x8C44,
+	0x8C40, 0x93B9, 0x8036, 0x8D99, 0x83A0, 0x1902, 0x81A6, 0x93B6,
+	0x80E0, 0x8D9A, 0x8236, 0x8DBD, 0x8225, 0x93F0, 0x93B5, 0x8C42,
+	0x8C46, 0x1406, 0x93B1, 0x9277, 0x8233, 0x1903, 0x93DB, 0x93DA,
+	0x823B, 0x8F94, 0x93BB, 0x8053, 0x81A5, 0x83A4, 0x8047, 0x822C,
+	0x9279, 0x8F9A, 0x8E8C, 0x8D70, 0x804F, 0x93F1, 0x8CAC, 0x9138,
+	0x8050, 0x8368, 0x9276, 0x84E9, 0x8F98, 0x9273, 0x8232, 0x8363,
+	0x8D49, 0x84ED, 0x93BA, 0x1904, 0x8227, 0x1400, 0x8D71, 0x8C43,
+	0x8054, 0x8049, 0x8A57, 0x93BD, 0x8035, 0x8057, 0x9270, 0x8C4A,
+	0x8C73, 0x83A2, 0x8F95, 0x8040, 0x804C, 0x93BC, 0x80E1, 0x8F99,
+	0x9278, 0x93D3, 0x804B, 0x1402, 0x9275, 0x8051, 0x8E8E, 0x88F0,
+	0x8C3A, 0x93B3, 0x8367,
+};
+static const int16_t glEnum_disp[227] = {
+	2, 1, -224, -220, -219, 1, 0, 0, 0, -217, 1, -212,
+	-207, 1, -204, -203, 0, -199, -198, 0, 0, 0, 0, 1,
+	0, 0, -197, 0, 0, 0, -190, 0, -184, 1, 3, -181,
+	-178, 1, -176, 2, 1, 0, 1, -175, -173, 1, 1, 0,
+	0, 6, -170, -168, 0, 0, -166, -163, 0, 0, 2, 3,
+	0, 0, 0, -162, 0, 0, -161, -157, 0, -154, 6, 2,
+	0, -148, 0, 0, 0, 1, 0, 0, 2, 0, 1, -147,
+	-146, 0, 0, -140, -139, -137, 4, 1, 0, 0, 0, 0,
+	0, 3, -133, 0, 2, 0, 0, 1, 6, 0, -131, 0,
+	1, 0, 0, 0, 3, -129, 0, 0, 2, 6, 0, -123,
+	1, -120, -116, 1, -114, 0, 0, -113, -108, 0, -107, 4,
+	0, 0, -106, 0, -105, -104, -98, 0, 2, 1, -94, 0,
+	4, -90, -87, 3, 0, 0, -77, -75, 0, 0, -73, 0,
+	-72, -69, 0, 0, 0, 3, 1, -67, -60, 8, 0, 3,
+	1, 6, 0, -59, 8, 1, -58, -57, 1, -56, 8, 0,
+	0, 8, 0, -53, -51, 1, 0, 8, -49, 0, 0, -47,
+	1, 0, 1, -36, 1, -30, -28, 0, 26, 0, 2, 1,
+	-26, -23, 0, 0, -15, -9, 1, 0, -6, 0, 3, -4,
+	-3, 10, 0, 1, 0, -2, 0, 10, 0, -1, 5,
+};
+static const uint16_t glEnum_name[227] = {
+	678, 523, 694, 1121, 784, 1282, 2219, 1559, 1492, 565, 2091, 1411,
+	1300, 129, 1268, 139, 275, 3475, 1736, 3623, 2672, 730, 558, 2031,
+	1708, 3809, 207, 667, 2054, 26, 3924, 124, 1953, 1905, 549, 990,
+	2187, 699, 1168, 1315, 1606, 75, 3660, 681, 2062, 115, 3176, 1938,
+	2123, 505, 777, 1347, 1061, 529, 1444, 64, 2271, 1984, 3263, 1648,
+	2039, 2549, 716, 2705, 2022, 321, 685, 2250, 881, 2084, 375, 120,
+	1521, 3512, 829, 2875, 1216, 3963, 2069, 764, 736, 339, 2097, 1091,
+	1529, 184, 1308, 444, 2639, 3697, 1032, 2047, 2150, 3549, 2504, 704,
+	970, 6, 3118, 164, 1379, 2828, 414, 2493, 710, 1252, 1664, 2373,
+	747, 650, 1189, 1016, 543, 1767, 3060, 2200, 2562, 45, 1636, 2136,
+	1805, 1991, 617, 2802, 309, 752, 3734, 2439, 2573, 2109, 1323, 357,
+	3771, 155, 41, 297, 2077, 758, 3292, 2319, 1923, 478, 854, 1589,
+	1554, 3322, 251, 2162, 961, 89, 599, 3234, 572, 2175, 741, 2299,
+	635, 4002, 3205, 1565, 1625, 58, 3089, 2959, 725, 105, 3885, 3847,
+	771, 2474, 3382, 511, 581, 1001, 394, 689, 3027, 2537, 2346, 2005,
+	490, 4041, 1886, 2606, 495, 933, 2918, 1151, 2516, 2848, 720, 808,
+	1968, 1237, 3352, 109, 664, 1, 2014, 1576, 517, 434, 2744, 3444,
+	230, 535, 2783, 1686, 1842, 980, 2483, 286, 466, 3413, 576, 2526,
+	3001, 3586, 455, 20, 2896, 500, 2406, 1330, 1477, 3147, 908,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_GLENUMSTRINGS_DATA_H__ */
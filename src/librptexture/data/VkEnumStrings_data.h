@@ -0,0 +1,493 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * VkEnumStrings_data.h: Generated lookup tables.                          *
+ *                                                                         *
+ * DO NOT EDIT! Generated by gen_lookup_tables.py.                         *
+ * Source: VkEnumStrings_data.txt                                          *
+ *                                                                         *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_VKENUMSTRINGS_DATA_H__
+#define __ROMPROPERTIES_LIBRPTEXTURE_VKENUMSTRINGS_DATA_H__
+
+#include "librpbase/PerfectHash.hpp"
+
+namespace LibRpTexture { namespace VkEnumStrings_data {
+
+namespace PerfectHash = LibRpBase::PerfectHash;
+
+// String table. (4301 bytes)
+// Offset 0 is nullptr.
+static const char strtbl[] =
+	"\0"
+	"UNDEFINED\0"
+	"R4G4_UNORM_PACK8\0"
+	"R4G4B4A4_UNORM_PACK16\0"
+	"B4G4R4A4_UNORM_PACK16\0"
+	"R5G6B5_UNORM_PACK16\0"
+	"B5G6R5_UNORM_PACK16\0"
+	"R5G5B5A1_UNORM_PACK16\0"
+	"B5G5R5A1_UNORM_PACK16\0"
+	"A1R5G5B5_UNORM_PACK16\0"
+	"R8_UNORM\0"
+	"R8_SNORM\0"
+	"R8_UINT\0"
+	"R8_SINT\0"
+	"R8_SRGB\0"
+	"R8G8_UNORM\0"
+	"R8G8_SNORM\0"
+	"R8G8_UINT\0"
+	"R8G8_SINT\0"
+	"R8G8_SRGB\0"
+	"R8G8B8_UNORM\0"
+	"R8G8B8_SNORM\0"
+	"R8G8B8_UINT\0"
+	"R8G8B8_SINT\0"
+	"R8G8B8_SRGB\0"
+	"B8G8R8_UNORM\0"
+	"B8G8R8_SNORM\0"
+	"B8G8R8_UINT\0"
+	"B8G8R8_SINT\0"
+	"B8G8R8_SRGB\0"
+	"R8G8B8A8_UNORM\0"
+	"R8G8B8A8_SNORM\0"
+	"R8G8B8A8_UINT\0"
+	"R8G8B8A8_SINT\0"
+	"R8G8B8A8_SRGB\0"
+	"B8G8R8A8_UNORM\0"
+	"B8G8R8A8_SNORM\0"
+	"B8G8R8A8_UINT\0"
+	"B8G8R8A8_SINT\0"
+	"B8G8R8A8_SRGB\0"
+	"A2R10G10B10_UNORM_PACK32\0"
+	"A2R10G10B10_SNORM_PACK32\0"
+	"A2R10G10B10_UINT_PACK32\0"
+	"A2R10G10B10_SINT_PACK32\0"
+	"A2B10G10R10_UNORM_PACK32\0"
+	"A2B10G10R10_SNORM_PACK32\0"
+	"A2B10G10R10_UINT_PACK32\0"
+	"A2B10G10R10_SINT_PACK32\0"
+	"R16_UNORM\0"
+	"R16_SNORM\0"
+	"R16_UINT\0"
+	"R16_SINT\0"
+	"R16_SFLOAT\0"
+	"R16G16_UNORM\0"
+	"R16G16_SNORM\0"
+	"R16G16_UINT\0"
+	"R16G16_SINT\0"
+	"R16G16_SFLOAT\0"
+	"R16G16B16_UNORM\0"
+	"R16G16B16_SNORM\0"
+	"R16G16B16_UINT\0"
+	"R16G16B16_SINT\0"
+	"R16G16B16_SFLOAT\0"
+	"R16G16B16A16_UNORM\0"
+	"R16G16B16A16_SNORM\0"
+	"R16G16B16A16_UINT\0"
+	"R16G16B16A16_SINT\0"
+	"R16G16B16A16_SFLOAT\0"
+	"R32_UINT\0"
+	"R32_SINT\0"
+	"R32_SFLOAT\0"
+	"R32G32_UINT\0"
+	"R32G32_SINT\0"
+	"R32G32_SFLOAT\0"
+	"R32G32B32_UINT\0"
+	"R32G32B32_SINT\0"
+	"R32G32B32_SFLOAT\0"
+	"R32G32B32A32_UINT\0"
+	"R32G32B32A32_SINT\0"
+	"R32G32B32A32_SFLOAT\0"
+	"R64_UINT\0"
+	"R64_SINT\0"
+	"R64_SFLOAT\0"
+	"R64G64_UINT\0"
+	"R64G64_SINT\0"
+	"R64G64_SFLOAT\0"
+	"R64G64B64_UINT\0"
+	"R64G64B64_SINT\0"
+	"R64G64B64_SFLOAT\0"
+	"R64G64B64A64_UINT\0"
+	"R64G64B64A64_SINT\0"
+	"R64G64B64A64_SFLOAT\0"
+	"B10G11R11_UFLOAT_PACK32\0"
+	"E5B9G9R9_UFLOAT_PACK32\0"
+	"D16_UNORM\0"
+	"X8_D24_UNORM_PACK32\0"
+	"D32_SFLOAT\0"
+	"S8_UINT\0"
+	"D16_UNORM_S8_UINT\0"
+	"D24_UNORM_S8_UINT\0"
+	"D32_SFLOAT_S8_UINT\0"
+	"BC1_RGB_UNORM_BLOCK\0"
+	"BC1_RGB_SRGB_BLOCK\0"
+	"BC1_RGBA_UNORM_BLOCK\0"
+	"BC1_RGBA_SRGB_BLOCK\0"
+	"BC2_UNORM_BLOCK\0"
+	"BC2_SRGB_BLOCK\0"
+	"BC3_UNORM_BLOCK\0"
+	"BC3_SRGB_BLOCK\0"
+	"BC4_UNORM_BLOCK\0"
+	"BC4_SNORM_BLOCK\0"
+	"BC5_UNORM_BLOCK\0"
+	"BC5_SNORM_BLOCK\0"
+	"BC6H_UFLOAT_BLOCK\0"
+	"BC6H_SFLOAT_BLOCK\0"
+	"BC7_UNORM_BLOCK\0"
+	"BC7_SRGB_BLOCK\0"
+	"ETC2_R8G8B8_UNORM_BLOCK\0"
+	"ETC2_R8G8B8_SRGB_BLOCK\0"
+	"ETC2_R8G8B8A1_UNORM_BLOCK\0"
+	"ETC2_R8G8B8A1_SRGB_BLOCK\0"
+	"ETC2_R8G8B8A8_UNORM_BLOCK\0"
+	"ETC2_R8G8B8A8_SRGB_BLOCK\0"
+	"EAC_R11_UNORM_BLOCK\0"
+	"EAC_R11_SNORM_BLOCK\0"
+	"EAC_R11G11_UNORM_BLOCK\0"
+	"EAC_R11G11_SNORM_BLOCK\0"
+	"ASTC_4x4_UNORM_BLOCK\0"
+	"ASTC_4x4_SRGB_BLOCK\0"
+	"ASTC_5x4_UNORM_BLOCK\0"
+	"ASTC_5x4_SRGB_BLOCK\0"
+	"ASTC_5x5_UNORM_BLOCK\0"
+	"ASTC_5x5_SRGB_BLOCK\0"
+	"ASTC_6x5_UNORM_BLOCK\0"
+	"ASTC_6x5_SRGB_BLOCK\0"
+	"ASTC_6x6_UNORM_BLOCK\0"
+	"ASTC_6x6_SRGB_BLOCK\0"
+	"ASTC_8x5_UNORM_BLOCK\0"
+	"ASTC_8x5_SRGB_BLOCK\0"
+	"ASTC_8x6_UNORM_BLOCK\0"
+	"ASTC_8x6_SRGB_BLOCK\0"
+	"ASTC_8x8_UNORM_BLOCK\0"
+	"ASTC_8x8_SRGB_BLOCK\0"
+	"ASTC_10x5_UNORM_BLOCK\0"
+	"ASTC_10x5_SRGB_BLOCK\0"
+	"ASTC_10x6_UNORM_BLOCK\0"
+	"ASTC_10x6_SRGB_BLOCK\0"
+	"ASTC_10x8_UNORM_BLOCK\0"
+	"ASTC_10x8_SRGB_BLOCK\0"
+	"ASTC_10x10_UNORM_BLOCK\0"
+	"ASTC_10x10_SRGB_BLOCK\0"
+	"ASTC_12x10_UNORM_BLOCK\0"
+	"ASTC_12x10_SRGB_BLOCK\0"
+	"ASTC_12x12_UNORM_BLOCK\0"
+	"ASTC_12x12_SRGB_BLOCK\0"
+	"PVRTC1_2BPP_UNORM_BLOCK_IMG\0"
+	"PVRTC1_4BPP_UNORM_BLOCK_IMG\0"
+	"PVRTC2_2BPP_UNORM_BLOCK_IMG\0"
+	"PVRTC2_4BPP_UNORM_BLOCK_IMG\0"
+	"PVRTC1_2BPP_SRGB_BLOCK_IMG\0"
+	"PVRTC1_4BPP_SRGB_BLOCK_IMG\0"
+	"PVRTC2_2BPP_SRGB_BLOCK_IMG\0"
+	"PVRTC2_4BPP_SRGB_BLOCK_IMG\0"
+	"ASTC_4x4_SFLOAT_BLOCK_EXT\0"
+	"ASTC_5x4_SFLOAT_BLOCK_EXT\0"
+	"ASTC_5x5_SFLOAT_BLOCK_EXT\0"
+	"ASTC_6x5_SFLOAT_BLOCK_EXT\0"
+	"ASTC_6x6_SFLOAT_BLOCK_EXT\0"
+	"ASTC_8x5_SFLOAT_BLOCK_EXT\0"
+	"ASTC_8x6_SFLOAT_BLOCK_EXT\0"
+	"ASTC_8x8_SFLOAT_BLOCK_EXT\0"
+	"ASTC_10x5_SFLOAT_BLOCK_EXT\0"
+	"ASTC_10x6_SFLOAT_BLOCK_EXT\0"
+	"ASTC_10x8_SFLOAT_BLOCK_EXT\0"
+	"ASTC_10x10_SFLOAT_BLOCK_EXT\0"
+	"ASTC_12x10_SFLOAT_BLOCK_EXT\0"
+	"ASTC_12x12_SFLOAT_BLOCK_EXT\0"
+	"G8B8G8R8_422_UNORM\0"
+	"B8G8R8G8_422_UNORM\0"
+	"G8_B8_R8_3PLANE_420_UNORM\0"
+	"G8_B8R8_2PLANE_420_UNORM\0"
+	"G8_B8_R8_3PLANE_422_UNORM\0"
+	"G8_B8R8_2PLANE_422_UNORM\0"
+	"G8_B8_R8_3PLANE_444_UNORM\0"
+	"R10X6_UNORM_PACK16\0"
+	"R10X6G10X6_UNORM_2PACK16\0"
+	"R10X6G10X6B10X6A10X6_UNORM_4PACK16\0"
+	"G10X6B10X6G10X6R10X6_422_UNORM_4PACK16\0"
+	"B10X6G10X6R10X6G10X6_422_UNORM_4PACK16\0"
+	"G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16\0"
+	"G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16\0"
+	"G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16\0"
+	"G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16\0"
+	"G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16\0"
+	"R12X4_UNORM_PACK16\0"
+	"R12X4G12X4_UNORM_2PACK16\0"
+	"R12X4G12X4B12X4A12X4_UNORM_4PACK16\0"
+	"G12X4B12X4G12X4R12X4_422_UNORM_4PACK16\0"
+	"B12X4G12X4R12X4G12X4_422_UNORM_4PACK16\0"
+	"G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16\0"
+	"G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16\0"
+	"G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16\0"
+	"G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16\0"
+	"G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16\0"
+	"G16B16G16R16_422_UNORM\0"
+	"B16G16R16G16_422_UNORM\0"
+	"G16_B16_R16_3PLANE_420_UNORM\0"
+	"G16_B16R16_2PLANE_420_UNORM\0"
+	"G16_B16_R16_3PLANE_422_UNORM\0"
+	"G16_B16R16_2PLANE_422_UNORM\0"
+	"G16_B16_R16_3PLANE_444_UNORM\0";
+
+/** vkFormat_core: Array table (185 entries) **/
+static_assert(VK_FORMAT_UNDEFINED == 0x0, "VK_FORMAT_UNDEFINED has changed.");
+static_assert(VK_FORMAT_R4G4_UNORM_PACK8 == 0x1, "VK_FORMAT_R4G4_UNORM_PACK8 has changed.");
+static_assert(VK_FORMAT_R4G4B4A4_UNORM_PACK16 == 0x2, "VK_FORMAT_R4G4B4A4_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_B4G4R4A4_UNORM_PACK16 == 0x3, "VK_FORMAT_B4G4R4A4_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_R5G6B5_UNORM_PACK16 == 0x4, "VK_FORMAT_R5G6B5_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_B5G6R5_UNORM_PACK16 == 0x5, "VK_FORMAT_B5G6R5_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_R5G5B5A1_UNORM_PACK16 == 0x6, "VK_FORMAT_R5G5B5A1_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_B5G5R5A1_UNORM_PACK16 == 0x7, "VK_FORMAT_B5G5R5A1_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_A1R5G5B5_UNORM_PACK16 == 0x8, "VK_FORMAT_A1R5G5B5_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_R8_UNORM == 0x9, "VK_FORMAT_R8_UNORM has changed.");
+static_assert(VK_FORMAT_R8_SNORM == 0xA, "VK_FORMAT_R8_SNORM has changed.");
+static_assert(VK_FORMAT_R8_UINT == 0xD, "VK_FORMAT_R8_UINT has changed.");
+static_assert(VK_FORMAT_R8_SINT == 0xE, "VK_FORMAT_R8_SINT has changed.");
+static_assert(VK_FORMAT_R8_SRGB == 0xF, "VK_FORMAT_R8_SRGB has changed.");
+static_assert(VK_FORMAT_R8G8_UNORM == 0x10, "VK_FORMAT_R8G8_UNORM has changed.");
+static_assert(VK_FORMAT_R8G8_SNORM == 0x11, "VK_FORMAT_R8G8_SNORM has changed.");
+static_assert(VK_FORMAT_R8G8_UINT == 0x14, "VK_FORMAT_R8G8_UINT has changed.");
+static_assert(VK_FORMAT_R8G8_SINT == 0x15, "VK_FORMAT_R8G8_SINT has changed.");
+static_assert(VK_FORMAT_R8G8_SRGB == 0x16, "VK_FORMAT_R8G8_SRGB has changed.");
+static_assert(VK_FORMAT_R8G8B8_UNORM == 0x17, "VK_FORMAT_R8G8B8_UNORM has changed.");
+static_assert(VK_FORMAT_R8G8B8_SNORM == 0x18, "VK_FORMAT_R8G8B8_SNORM has changed.");
+static_assert(VK_FORMAT_R8G8B8_UINT == 0x1B, "VK_FORMAT_R8G8B8_UINT has changed.");
+static_assert(VK_FORMAT_R8G8B8_SINT == 0x1C, "VK_FORMAT_R8G8B8_SINT has changed.");
+static_assert(VK_FORMAT_R8G8B8_SRGB == 0x1D, "VK_FORMAT_R8G8B8_SRGB has changed.");
+static_assert(VK_FORMAT_B8G8R8_UNORM == 0x1E, "VK_FORMAT_B8G8R8_UNORM has changed.");
+static_assert(VK_FORMAT_B8G8R8_SNORM == 0x1F, "VK_FORMAT_B8G8R8_SNORM has changed.");
+static_assert(VK_FORMAT_B8G8R8_UINT == 0x22, "VK_FORMAT_B8G8R8_UINT has changed.");
+static_assert(VK_FORMAT_B8G8R8_SINT == 0x23, "VK_FORMAT_B8G8R8_SINT has changed.");
+static_assert(VK_FORMAT_B8G8R8_SRGB == 0x24, "VK_FORMAT_B8G8R8_SRGB has changed.");
+static_assert(VK_FORMAT_R8G8B8A8_UNORM == 0x25, "VK_FORMAT_R8G8B8A8_UNORM has changed.");
+static_assert(VK_FORMAT_R8G8B8A8_SNORM == 0x26, "VK_FORMAT_R8G8B8A8_SNORM has changed.");
+static_assert(VK_FORMAT_R8G8B8A8_UINT == 0x29, "VK_FORMAT_R8G8B8A8_UINT has changed.");
+static_assert(VK_FORMAT_R8G8B8A8_SINT == 0x2A, "VK_FORMAT_R8G8B8A8_SINT has changed.");
+static_assert(VK_FORMAT_R8G8B8A8_SRGB == 0x2B, "VK_FORMAT_R8G8B8A8_SRGB has changed.");
+static_assert(VK_FORMAT_B8G8R8A8_UNORM == 0x2C, "VK_FORMAT_B8G8R8A8_UNORM has changed.");
+static_assert(VK_FORMAT_B8G8R8A8_SNORM == 0x2D, "VK_FORMAT_B8G8R8A8_SNORM has changed.");
+static_assert(VK_FORMAT_B8G8R8A8_UINT == 0x30, "VK_FORMAT_B8G8R8A8_UINT has changed.");
+static_assert(VK_FORMAT_B8G8R8A8_SINT == 0x31, "VK_FORMAT_B8G8R8A8_SINT has changed.");
+static_assert(VK_FORMAT_B8G8R8A8_SRGB == 0x32, "VK_FORMAT_B8G8R8A8_SRGB has changed.");
+static_assert(VK_FORMAT_A2R10G10B10_UNORM_PACK32 == 0x3A, "VK_FORMAT_A2R10G10B10_UNORM_PACK32 has changed.");
+static_assert(VK_FORMAT_A2R10G10B10_SNORM_PACK32 == 0x3B, "VK_FORMAT_A2R10G10B10_SNORM_PACK32 has changed.");
+static_assert(VK_FORMAT_A2R10G10B10_UINT_PACK32 == 0x3E, "VK_FORMAT_A2R10G10B10_UINT_PACK32 has changed.");
+static_assert(VK_FORMAT_A2R10G10B10_SINT_PACK32 == 0x3F, "VK_FORMAT_A2R10G10B10_SINT_PACK32 has changed.");
+static_assert(VK_FORMAT_A2B10G10R10_UNORM_PACK32 == 0x40, "VK_FORMAT_A2B10G10R10_UNORM_PACK32 has changed.");
+static_assert(VK_FORMAT_A2B10G10R10_SNORM_PACK32 == 0x41, "VK_FORMAT_A2B10G10R10_SNORM_PACK32 has changed.");
+static_assert(VK_FORMAT_A2B10G10R10_UINT_PACK32 == 0x44, "VK_FORMAT_A2B10G10R10_UINT_PACK32 has changed.");
+static_assert(VK_FORMAT_A2B10G10R10_SINT_PACK32 == 0x45, "VK_FORMAT_A2B10G10R10_SINT_PACK32 has changed.");
+static_assert(VK_FORMAT_R16_UNORM == 0x46, "VK_FORMAT_R16_UNORM has changed.");
+static_assert(VK_FORMAT_R16_SNORM == 0x47, "VK_FORMAT_R16_SNORM has changed.");
+static_assert(VK_FORMAT_R16_UINT == 0x4A, "VK_FORMAT_R16_UINT has changed.");
+static_assert(VK_FORMAT_R16_SINT == 0x4B, "VK_FORMAT_R16_SINT has changed.");
+static_assert(VK_FORMAT_R16_SFLOAT == 0x4C, "VK_FORMAT_R16_SFLOAT has changed.");
+static_assert(VK_FORMAT_R16G16_UNORM == 0x4D, "VK_FORMAT_R16G16_UNORM has changed.");
+static_assert(VK_FORMAT_R16G16_SNORM == 0x4E, "VK_FORMAT_R16G16_SNORM has changed.");
+static_assert(VK_FORMAT_R16G16_UINT == 0x51, "VK_FORMAT_R16G16_UINT has changed.");
+static_assert(VK_FORMAT_R16G16_SINT == 0x52, "VK_FORMAT_R16G16_SINT has changed.");
+static_assert(VK_FORMAT_R16G16_SFLOAT == 0x53, "VK_FORMAT_R16G16_SFLOAT has changed.");
+static_assert(VK_FORMAT_R16G16B16_UNORM == 0x54, "VK_FORMAT_R16G16B16_UNORM has changed.");
+static_assert(VK_FORMAT_R16G16B16_SNORM == 0x55, "VK_FORMAT_R16G16B16_SNORM has changed.");
+static_assert(VK_FORMAT_R16G16B16_UINT == 0x58, "VK_FORMAT_R16G16B16_UINT has changed.");
+static_assert(VK_FORMAT_R16G16B16_SINT == 0x59, "VK_FORMAT_R16G16B16_SINT has changed.");
+static_assert(VK_FORMAT_R16G16B16_SFLOAT == 0x5A, "VK_FORMAT_R16G16B16_SFLOAT has changed.");
+static_assert(VK_FORMAT_R16G16B16A16_UNORM == 0x5B, "VK_FORMAT_R16G16B16A16_UNORM has changed.");
+static_assert(VK_FORMAT_R16G16B16A16_SNORM == 0x5C, "VK_FORMAT_R16G16B16A16_SNORM has changed.");
+static_assert(VK_FORMAT_R16G16B16A16_UINT == 0x5F, "VK_FORMAT_R16G16B16A16_UINT has changed.");
+static_assert(VK_FORMAT_R16G16B16A16_SINT == 0x60, "VK_FORMAT_R16G16B16A16_SINT has changed.");
+static_assert(VK_FORMAT_R16G16B16A16_SFLOAT == 0x61, "VK_FORMAT_R16G16B16A16_SFLOAT has changed.");
+static_assert(VK_FORMAT_R32_UINT == 0x62, "VK_FORMAT_R32_UINT has changed.");
+static_assert(VK_FORMAT_R32_SINT == 0x63, "VK_FORMAT_R32_SINT has changed.");
+static_assert(VK_FORMAT_R32_SFLOAT == 0x64, "VK_FORMAT_R32_SFLOAT has changed.");
+static_assert(VK_FORMAT_R32G32_UINT == 0x65, "VK_FORMAT_R32G32_UINT has changed.");
+static_assert(VK_FORMAT_R32G32_SINT == 0x66, "VK_FORMAT_R32G32_SINT has changed.");
+static_assert(VK_FORMAT_R32G32_SFLOAT == 0x67, "VK_FORMAT_R32G32_SFLOAT has changed.");
+static_assert(VK_FORMAT_R32G32B32_UINT == 0x68, "VK_FORMAT_R32G32B32_UINT has changed.");
+static_assert(VK_FORMAT_R32G32B32_SINT == 0x69, "VK_FORMAT_R32G32B32_SINT has changed.");
+static_assert(VK_FORMAT_R32G32B32_SFLOAT == 0x6A, "VK_FORMAT_R32G32B32_SFLOAT has changed.");
+static_assert(VK_FORMAT_R32G32B32A32_UINT == 0x6B, "VK_FORMAT_R32G32B32A32_UINT has changed.");
+static_assert(VK_FORMAT_R32G32B32A32_SINT == 0x6C, "VK_FORMAT_R32G32B32A32_SINT has changed.");
+static_assert(VK_FORMAT_R32G32B32A32_SFLOAT == 0x6D, "VK_FORMAT_R32G32B32A32_SFLOAT has changed.");
+static_assert(VK_FORMAT_R64_UINT == 0x6E, "VK_FORMAT_R64_UINT has changed.");
+static_assert(VK_FORMAT_R64_SINT == 0x6F, "VK_FORMAT_R64_SINT has changed.");
+static_assert(VK_FORMAT_R64_SFLOAT == 0x70, "VK_FORMAT_R64_SFLOAT has changed.");
+static_assert(VK_FORMAT_R64G64_UINT == 0x71, "VK_FORMAT_R64G64_UINT has changed.");
+static_assert(VK_FORMAT_R64G64_SINT == 0x72, "VK_FORMAT_R64G64_SINT has changed.");
+static_assert(VK_FORMAT_R64G64_SFLOAT == 0x73, "VK_FORMAT_R64G64_SFLOAT has changed.");
+static_assert(VK_FORMAT_R64G64B64_UINT == 0x74, "VK_FORMAT_R64G64B64_UINT has changed.");
+static_assert(VK_FORMAT_R64G64B64_SINT == 0x75, "VK_FORMAT_R64G64B64_SINT has changed.");
+static_assert(VK_FORMAT_R64G64B64_SFLOAT == 0x76, "VK_FORMAT_R64G64B64_SFLOAT has changed.");
+static_assert(VK_FORMAT_R64G64B64A64_UINT == 0x77, "VK_FORMAT_R64G64B64A64_UINT has changed.");
+static_assert(VK_FORMAT_R64G64B64A64_SINT == 0x78, "VK_FORMAT_R64G64B64A64_SINT has changed.");
+static_assert(VK_FORMAT_R64G64B64A64_SFLOAT == 0x79, "VK_FORMAT_R64G64B64A64_SFLOAT has changed.");
+static_assert(VK_FORMAT_B10G11R11_UFLOAT_PACK32 == 0x7A, "VK_FORMAT_B10G11R11_UFLOAT_PACK32 has changed.");
+static_assert(VK_FORMAT_E5B9G9R9_UFLOAT_PACK32 == 0x7B, "VK_FORMAT_E5B9G9R9_UFLOAT_PACK32 has changed.");
+static_assert(VK_FORMAT_D16_UNORM == 0x7C, "VK_FORMAT_D16_UNORM has changed.");
+static_assert(VK_FORMAT_X8_D24_UNORM_PACK32 == 0x7D, "VK_FORMAT_X8_D24_UNORM_PACK32 has changed.");
+static_assert(VK_FORMAT_D32_SFLOAT == 0x7E, "VK_FORMAT_D32_SFLOAT has changed.");
+static_assert(VK_FORMAT_S8_UINT == 0x7F, "VK_FORMAT_S8_UINT has changed.");
+static_assert(VK_FORMAT_D16_UNORM_S8_UINT == 0x80, "VK_FORMAT_D16_UNORM_S8_UINT has changed.");
+static_assert(VK_FORMAT_D24_UNORM_S8_UINT == 0x81, "VK_FORMAT_D24_UNORM_S8_UINT has changed.");
+static_assert(VK_FORMAT_D32_SFLOAT_S8_UINT == 0x82, "VK_FORMAT_D32_SFLOAT_S8_UINT has changed.");
+static_assert(VK_FORMAT_BC1_RGB_UNORM_BLOCK == 0x83, "VK_FORMAT_BC1_RGB_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC1_RGB_SRGB_BLOCK == 0x84, "VK_FORMAT_BC1_RGB_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_BC1_RGBA_UNORM_BLOCK == 0x85, "VK_FORMAT_BC1_RGBA_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC1_RGBA_SRGB_BLOCK == 0x86, "VK_FORMAT_BC1_RGBA_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_BC2_UNORM_BLOCK == 0x87, "VK_FORMAT_BC2_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC2_SRGB_BLOCK == 0x88, "VK_FORMAT_BC2_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_BC3_UNORM_BLOCK == 0x89, "VK_FORMAT_BC3_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC3_SRGB_BLOCK == 0x8A, "VK_FORMAT_BC3_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_BC4_UNORM_BLOCK == 0x8B, "VK_FORMAT_BC4_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC4_SNORM_BLOCK == 0x8C, "VK_FORMAT_BC4_SNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC5_UNORM_BLOCK == 0x8D, "VK_FORMAT_BC5_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC5_SNORM_BLOCK == 0x8E, "VK_FORMAT_BC5_SNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC6H_UFLOAT_BLOCK == 0x8F, "VK_FORMAT_BC6H_UFLOAT_BLOCK has changed.");
+static_assert(VK_FORMAT_BC6H_SFLOAT_BLOCK == 0x90, "VK_FORMAT_BC6H_SFLOAT_BLOCK has changed.");
+static_assert(VK_FORMAT_BC7_UNORM_BLOCK == 0x91, "VK_FORMAT_BC7_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_BC7_SRGB_BLOCK == 0x92, "VK_FORMAT_BC7_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK == 0x93, "VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK == 0x94, "VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK == 0x95, "VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK == 0x96, "VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK == 0x97, "VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK == 0x98, "VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_EAC_R11_UNORM_BLOCK == 0x99, "VK_FORMAT_EAC_R11_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_EAC_R11_SNORM_BLOCK == 0x9A, "VK_FORMAT_EAC_R11_SNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_EAC_R11G11_UNORM_BLOCK == 0x9B, "VK_FORMAT_EAC_R11G11_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_EAC_R11G11_SNORM_BLOCK == 0x9C, "VK_FORMAT_EAC_R11G11_SNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_4x4_UNORM_BLOCK == 0x9D, "VK_FORMAT_ASTC_4x4_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_4x4_SRGB_BLOCK == 0x9E, "VK_FORMAT_ASTC_4x4_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_5x4_UNORM_BLOCK == 0x9F, "VK_FORMAT_ASTC_5x4_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_5x4_SRGB_BLOCK == 0xA0, "VK_FORMAT_ASTC_5x4_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_5x5_UNORM_BLOCK == 0xA1, "VK_FORMAT_ASTC_5x5_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_5x5_SRGB_BLOCK == 0xA2, "VK_FORMAT_ASTC_5x5_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_6x5_UNORM_BLOCK == 0xA3, "VK_FORMAT_ASTC_6x5_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_6x5_SRGB_BLOCK == 0xA4, "VK_FORMAT_ASTC_6x5_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_6x6_UNORM_BLOCK == 0xA5, "VK_FORMAT_ASTC_6x6_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_6x6_SRGB_BLOCK == 0xA6, "VK_FORMAT_ASTC_6x6_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_8x5_UNORM_BLOCK == 0xA7, "VK_FORMAT_ASTC_8x5_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_8x5_SRGB_BLOCK == 0xA8, "VK_FORMAT_ASTC_8x5_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_8x6_UNORM_BLOCK == 0xA9, "VK_FORMAT_ASTC_8x6_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_8x6_SRGB_BLOCK == 0xAA, "VK_FORMAT_ASTC_8x6_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_8x8_UNORM_BLOCK == 0xAB, "VK_FORMAT_ASTC_8x8_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_8x8_SRGB_BLOCK == 0xAC, "VK_FORMAT_ASTC_8x8_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_10x5_UNORM_BLOCK == 0xAD, "VK_FORMAT_ASTC_10x5_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_10x5_SRGB_BLOCK == 0xAE, "VK_FORMAT_ASTC_10x5_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_10x6_UNORM_BLOCK == 0xAF, "VK_FORMAT_ASTC_10x6_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_10x6_SRGB_BLOCK == 0xB0, "VK_FORMAT_ASTC_10x6_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_10x8_UNORM_BLOCK == 0xB1, "VK_FORMAT_ASTC_10x8_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_10x8_SRGB_BLOCK == 0xB2, "VK_FORMAT_ASTC_10x8_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_10x10_UNORM_BLOCK == 0xB3, "VK_FORMAT_ASTC_10x10_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_10x10_SRGB_BLOCK == 0xB4, "VK_FORMAT_ASTC_10x10_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_12x10_UNORM_BLOCK == 0xB5, "VK_FORMAT_ASTC_12x10_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_12x10_SRGB_BLOCK == 0xB6, "VK_FORMAT_ASTC_12x10_SRGB_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_12x12_UNORM_BLOCK == 0xB7, "VK_FORMAT_ASTC_12x12_UNORM_BLOCK has changed.");
+static_assert(VK_FORMAT_ASTC_12x12_SRGB_BLOCK == 0xB8, "VK_FORMAT_ASTC_12x12_SRGB_BLOCK has changed.");
+static const unsigned int vkFormat_core_count = 185;
+static const uint16_t vkFormat_core_name[185] = {
+	1, 11, 28, 50, 72, 92, 112, 134, 156, 178, 187, 0,
+	0, 196, 204, 212, 220, 231, 0, 0, 242, 252, 262, 272,
+	285, 0, 0, 298, 310, 322, 334, 347, 0, 0, 360, 372,
+	384, 396, 411, 0, 0, 426, 440, 454, 468, 483, 0, 0,
+	498, 512, 526, 0, 0, 0, 0, 0, 0, 0, 540, 565,
+	0, 0, 590, 614, 638, 663, 0, 0, 688, 712, 736, 746,
+	0, 0, 756, 765, 774, 785, 798, 0, 0, 811, 823, 835,
+	849, 865, 0, 0, 881, 896, 911, 928, 947, 0, 0, 966,
+	984, 1002, 1022, 1031, 1040, 1051, 1063, 1075, 1089, 1104, 1119, 1136,
+	1154, 1172, 1192, 1201, 1210, 1221, 1233, 1245, 1259, 1274, 1289, 1306,
+	1324, 1342, 1362, 1386, 1409, 1419, 1439, 1450, 1458, 1476, 1494, 1513,
+	1533, 1552, 1573, 1593, 1609, 1624, 1640, 1655, 1671, 1687, 1703, 1719,
+	1737, 1755, 1771, 1786, 1810, 1833, 1859, 1884, 1910, 1935, 1955, 1975,
+	1998, 2021, 2042, 2062, 2083, 2103, 2124, 2144, 2165, 2185, 2206, 2226,
+	2247, 2267, 2288, 2308, 2329, 2349, 2371, 2392, 2414, 2435, 2457, 2478,
+	2501, 2523, 2546, 2568, 2591,
+};
+
+/** vkFormat_ext: Perfect hash table (56 entries) **/
+static_assert(VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG == 0x3B9B9CF0, "VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG has changed.");
+static_assert(VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG == 0x3B9B9CF1, "VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG has changed.");
+static_assert(VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG == 0x3B9B9CF2, "VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG has changed.");
+static_assert(VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG == 0x3B9B9CF3, "VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG has changed.");
+static_assert(VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG == 0x3B9B9CF4, "VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG has changed.");
+static_assert(VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG == 0x3B9B9CF5, "VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG has changed.");
+static_assert(VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG == 0x3B9B9CF6, "VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG has changed.");
+static_assert(VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG == 0x3B9B9CF7, "VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG has changed.");
+static_assert(VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK_EXT == 0x3B9BCBD0, "VK_FORMAT_ASTC_4x4_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK_EXT == 0x3B9BCBD1, "VK_FORMAT_ASTC_5x4_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK_EXT == 0x3B9BCBD2, "VK_FORMAT_ASTC_5x5_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK_EXT == 0x3B9BCBD3, "VK_FORMAT_ASTC_6x5_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK_EXT == 0x3B9BCBD4, "VK_FORMAT_ASTC_6x6_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK_EXT == 0x3B9BCBD5, "VK_FORMAT_ASTC_8x5_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK_EXT == 0x3B9BCBD6, "VK_FORMAT_ASTC_8x6_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK_EXT == 0x3B9BCBD7, "VK_FORMAT_ASTC_8x8_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK_EXT == 0x3B9BCBD8, "VK_FORMAT_ASTC_10x5_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK_EXT == 0x3B9BCBD9, "VK_FORMAT_ASTC_10x6_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK_EXT == 0x3B9BCBDA, "VK_FORMAT_ASTC_10x8_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK_EXT == 0x3B9BCBDB, "VK_FORMAT_ASTC_10x10_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK_EXT == 0x3B9BCBDC, "VK_FORMAT_ASTC_12x10_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK_EXT == 0x3B9BCBDD, "VK_FORMAT_ASTC_12x12_SFLOAT_BLOCK_EXT has changed.");
+static_assert(VK_FORMAT_G8B8G8R8_422_UNORM == 0x3B9D2B60, "VK_FORMAT_G8B8G8R8_422_UNORM has changed.");
+static_assert(VK_FORMAT_B8G8R8G8_422_UNORM == 0x3B9D2B61, "VK_FORMAT_B8G8R8G8_422_UNORM has changed.");
+static_assert(VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM == 0x3B9D2B62, "VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM has changed.");
+static_assert(VK_FORMAT_G8_B8R8_2PLANE_420_UNORM == 0x3B9D2B63, "VK_FORMAT_G8_B8R8_2PLANE_420_UNORM has changed.");
+static_assert(VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM == 0x3B9D2B64, "VK_FORMAT_G8_B8_R8_3PLANE_422_UNORM has changed.");
+static_assert(VK_FORMAT_G8_B8R8_2PLANE_422_UNORM == 0x3B9D2B65, "VK_FORMAT_G8_B8R8_2PLANE_422_UNORM has changed.");
+static_assert(VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM == 0x3B9D2B66, "VK_FORMAT_G8_B8_R8_3PLANE_444_UNORM has changed.");
+static_assert(VK_FORMAT_R10X6_UNORM_PACK16 == 0x3B9D2B67, "VK_FORMAT_R10X6_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_R10X6G10X6_UNORM_2PACK16 == 0x3B9D2B68, "VK_FORMAT_R10X6G10X6_UNORM_2PACK16 has changed.");
+static_assert(VK_FORMAT_R10X6G10X6B10X6A10X6_UNORM_4PACK16 == 0x3B9D2B69, "VK_FORMAT_R10X6G10X6B10X6A10X6_UNORM_4PACK16 has changed.");
+static_assert(VK_FORMAT_G10X6B10X6G10X6R10X6_422_UNORM_4PACK16 == 0x3B9D2B6A, "VK_FORMAT_G10X6B10X6G10X6R10X6_422_UNORM_4PACK16 has changed.");
+static_assert(VK_FORMAT_B10X6G10X6R10X6G10X6_422_UNORM_4PACK16 == 0x3B9D2B6B, "VK_FORMAT_B10X6G10X6R10X6G10X6_422_UNORM_4PACK16 has changed.");
+static_assert(VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16 == 0x3B9D2B6C, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_420_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16 == 0x3B9D2B6D, "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16 == 0x3B9D2B6E, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_422_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16 == 0x3B9D2B6F, "VK_FORMAT_G10X6_B10X6R10X6_2PLANE_422_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16 == 0x3B9D2B70, "VK_FORMAT_G10X6_B10X6_R10X6_3PLANE_444_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_R12X4_UNORM_PACK16 == 0x3B9D2B71, "VK_FORMAT_R12X4_UNORM_PACK16 has changed.");
+static_assert(VK_FORMAT_R12X4G12X4_UNORM_2PACK16 == 0x3B9D2B72, "VK_FORMAT_R12X4G12X4_UNORM_2PACK16 has changed.");
+static_assert(VK_FORMAT_R12X4G12X4B12X4A12X4_UNORM_4PACK16 == 0x3B9D2B73, "VK_FORMAT_R12X4G12X4B12X4A12X4_UNORM_4PACK16 has changed.");
+static_assert(VK_FORMAT_G12X4B12X4G12X4R12X4_422_UNORM_4PACK16 == 0x3B9D2B74, "VK_FORMAT_G12X4B12X4G12X4R12X4_422_UNORM_4PACK16 has changed.");
+static_assert(VK_FORMAT_B12X4G12X4R12X4G12X4_422_UNORM_4PACK16 == 0x3B9D2B75, "VK_FORMAT_B12X4G12X4R12X4G12X4_422_UNORM_4PACK16 has changed.");
+static_assert(VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16 == 0x3B9D2B76, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_420_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16 == 0x3B9D2B77, "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_420_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16 == 0x3B9D2B78, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_422_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16 == 0x3B9D2B79, "VK_FORMAT_G12X4_B12X4R12X4_2PLANE_422_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16 == 0x3B9D2B7A, "VK_FORMAT_G12X4_B12X4_R12X4_3PLANE_444_UNORM_3PACK16 has changed.");
+static_assert(VK_FORMAT_G16B16G16R16_422_UNORM == 0x3B9D2B7B, "VK_FORMAT_G16B16G16R16_422_UNORM has changed.");
+static_assert(VK_FORMAT_B16G16R16G16_422_UNORM == 0x3B9D2B7C, "VK_FORMAT_B16G16R16G16_422_UNORM has changed.");
+static_assert(VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM == 0x3B9D2B7D, "VK_FORMAT_G16_B16_R16_3PLANE_420_UNORM has changed.");
+static_assert(VK_FORMAT_G16_B16R16_2PLANE_420_UNORM == 0x3B9D2B7E, "VK_FORMAT_G16_B16R16_2PLANE_420_UNORM has changed.");
+static_assert(VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM == 0x3B9D2B7F, "VK_FORMAT_G16_B16_R16_3PLANE_422_UNORM has changed.");
+static_assert(VK_FORMAT_G16_B16R16_2PLANE_422_UNORM == 0x3B9D2B80, "VK_FORMAT_G16_B16R16_2PLANE_422_UNORM has changed.");
+static_assert(VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM == 0x3B9D2B81, "VK_FORMAT_G16_B16_R16_3PLANE_444_UNORM has changed.");
+static const uint32_t vkFormat_ext_keys[56] = {
+	0x3B9BCBD6, 0x3B9D2B6B, 0x3B9D2B6E, 0x3B9D2B7B, 0x3B9D2B63, 0x3B9B9CF4, 0x3B9D2B74, 0x3B9D2B69,
+	0x3B9D2B7C, 0x3B9BCBDD, 0x3B9B9CF7, 0x3B9BCBD1, 0x3B9D2B71, 0x3B9D2B62, 0x3B9D2B70, 0x3B9D2B73,
+	0x3B9D2B65, 0x3B9D2B64, 0x3B9D2B81, 0x3B9BCBD3, 0x3B9D2B6A, 0x3B9D2B6F, 0x3B9D2B7F, 0x3B9D2B60,
+	0x3B9BCBD8, 0x3B9B9CF6, 0x3B9B9CF0, 0x3B9B9CF5, 0x3B9D2B6C, 0x3B9D2B7E, 0x3B9B9CF1, 0x3B9D2B77,
+	0x3B9BCBD2, 0x3B9D2B67, 0x3B9BCBD4, 0x3B9D2B66, 0x3B9D2B7A, 0x3B9D2B75, 0x3B9BCBD0, 0x3B9BCBDC,
+	0x3B9D2B68, 0x3B9BCBD5, 0x3B9D2B80, 0x3B9D2B76, 0x3B9BCBDB, 0x3B9D2B61, 0x3B9D2B6D, 0x3B9D2B7D,
+	0x3B9D2B78, 0x3B9BCBD7, 0x3B9BCBDA, 0x3B9BCBD9, 0x3B9B9CF3, 0x3B9D2B79, 0x3B9D2B72, 0x3B9B9CF2,
+};
+static const int16_t vkFormat_ext_disp[56] = {
+	-53, -48, 0, -47, 2, 0, -46, -45, -44, 0, 3, 5,
+	-38, 1, 0, 1, 1, -34, 0, 0, 2, -32, 1, 2,
+	0, -30, -29, 0, 3, 3, 0, 1, -28, 12, 0, -27,
+	-24, -23, -22, 0, -21, 0, -12, 0, -11, -10, 0, 0,
+	0, 1, 0, 5, -7, 0, -4, 0,
+};
+static const uint16_t vkFormat_ext_name[56] = {
+	2989, 3490, 3614, 4112, 3270, 2725, 3821, 3416, 4135, 3178, 2806, 2859,
+	3742, 3244, 3699, 3786, 3321, 3295, 4272, 2911, 3451, 3657, 4215, 3206,
+	3041, 2779, 2613, 2752, 3529, 4187, 2641, 3942, 2885, 3372, 2937, 3346,
+	4069, 3860, 2833, 3150, 3391, 2963, 4244, 3899, 3122, 3225, 3572, 4158,
+	3984, 3015, 3095, 3068, 2697, 4027, 3761, 2669,
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_VKENUMSTRINGS_DATA_H__ */
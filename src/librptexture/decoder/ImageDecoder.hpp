@@ -24,10 +24,18 @@
 # include "librpcpu/cpuflags_x86.h"
 # define IMAGEDECODER_HAS_SSE2 1
 # define IMAGEDECODER_HAS_SSSE3 1
+# define IMAGEDECODER_HAS_SSE41 1
+// AVX2 requires MSVC 2013 or later.
+# if !defined(_MSC_VER) || _MSC_VER >= 1800
+#  define IMAGEDECODER_HAS_AVX2 1
+# endif
 #endif
 #ifdef RP_CPU_AMD64
 # define IMAGEDECODER_ALWAYS_HAS_SSE2 1
 #endif
+#ifdef RP_CPU_ALWAYS_HAS_NEON
+# define IMAGEDECODER_HAS_NEON 1
+#endif
 
 namespace LibRpTexture {
 	class rp_image;
@@ -219,6 +227,26 @@ rp_image *fromLinear16_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz, int stride = 0);
 
+/**
+ * Convert a linear 16-bit RGB image to rp_image.
+ * Lookup table version.
+ *
+ * Each pixel format's 64K-entry ARGB32 lookup table is built
+ * the first time it's used. fromLinear16_cpp() uses this for
+ * large images in formats where it's faster than bit math.
+ *
+ * @param px_format	[in] 16-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] 16-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*2]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear16_lut(PixelFormat px_format,
+	int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz, int stride = 0);
+
 #ifdef IMAGEDECODER_HAS_SSE2
 /**
  * Convert a linear 16-bit RGB image to rp_image.
@@ -236,31 +264,26 @@ rp_image *fromLinear16_sse2(PixelFormat px_format,
 	const uint16_t *RESTRICT img_buf, int img_siz, int stride = 0);
 #endif /* IMAGEDECODER_HAS_SSE2 */
 
-#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
-
-#  ifdef IMAGEDECODER_ALWAYS_HAS_SSE2
-// System does support IFUNC, but it's always guaranteed to have SSE2.
-// Eliminate the IFUNC dispatch on this system.
-
+#ifdef IMAGEDECODER_HAS_AVX2
 /**
  * Convert a linear 16-bit RGB image to rp_image.
+ * AVX2-optimized version.
  * @param px_format	[in] 16-bit pixel format.
  * @param width		[in] Image width.
  * @param height	[in] Image height.
- * @param img_buf	[in] Image buffer.
- * @param img_siz	[in] Size of image data. [must be >= (w*h)*3]
+ * @param img_buf	[in] 16-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*2]
  * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
  * @return rp_image, or nullptr on error.
  */
-static inline rp_image *fromLinear16(PixelFormat px_format,
+rp_image *fromLinear16_avx2(PixelFormat px_format,
 	int width, int height,
-	const uint16_t *img_buf, int img_siz, int stride = 0)
-{
-	// amd64 always has SSE2.
-	return fromLinear16_sse2(px_format, width, height, img_buf, img_siz, stride);
-}
-#  else /* !IMAGEDECODER_ALWAYS_HAS_SSE2 */
-// System supports IFUNC and is not guaranteed to always have SSE2.
+	const uint16_t *RESTRICT img_buf, int img_siz, int stride = 0);
+#endif /* IMAGEDECODER_HAS_AVX2 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+// NOTE: IFUNC is used on amd64 as well, since AVX2 isn't
+// guaranteed to be available.
 
 /**
  * Convert a linear 16-bit RGB image to rp_image.
@@ -272,10 +295,9 @@ static inline rp_image *fromLinear16(PixelFormat px_format,
  * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
  * @return rp_image, or nullptr on error.
  */
-IFUNC_SSE2_STATIC_INLINE rp_image *fromLinear16(PixelFormat px_format,
+IFUNC_STATIC_INLINE rp_image *fromLinear16(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz, int stride = 0);
-#  endif /* IMAGEDECODER_ALWAYS_HAS_SSE2 */
 
 #else /* !RP_HAS_IFUNC or not i386/amd64 */
 // System does not support IFUNC, or we aren't guaranteed to have
@@ -295,9 +317,16 @@ static inline rp_image *fromLinear16(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz, int stride = 0)
 {
+#  ifdef IMAGEDECODER_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return fromLinear16_avx2(px_format, width, height, img_buf, img_siz, stride);
+	} else
+#  endif /* IMAGEDECODER_HAS_AVX2 */
 #  ifdef IMAGEDECODER_ALWAYS_HAS_SSE2
-	// amd64 always has SSE2.
-	return fromLinear16_sse2(px_format, width, height, img_buf, img_siz, stride);
+	{
+		// amd64 always has SSE2.
+		return fromLinear16_sse2(px_format, width, height, img_buf, img_siz, stride);
+	}
 #  else /* !IMAGEDECODER_ALWAYS_HAS_SSE2 */
 #    ifdef IMAGEDECODER_HAS_SSE2
 	if (RP_CPU_HasSSE2()) {
@@ -348,6 +377,42 @@ rp_image *fromLinear24_ssse3(PixelFormat px_format,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride = 0);
 #endif /* IMAGEDECODER_HAS_SSSE3 */
 
+#ifdef IMAGEDECODER_HAS_AVX2
+/**
+ * Convert a linear 24-bit RGB image to rp_image.
+ * AVX2-optimized version.
+ * @param px_format	[in] 24-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer. (must be byte-addressable)
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*3]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 4, 5)
+rp_image *fromLinear24_avx2(PixelFormat px_format,
+	int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz, int stride = 0);
+#endif /* IMAGEDECODER_HAS_AVX2 */
+
+#ifdef IMAGEDECODER_HAS_NEON
+/**
+ * Convert a linear 24-bit RGB image to rp_image.
+ * NEON-optimized version.
+ * @param px_format	[in] 24-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer. (must be byte-addressable)
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*3]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 4, 5)
+rp_image *fromLinear24_neon(PixelFormat px_format,
+	int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz, int stride = 0);
+#endif /* IMAGEDECODER_HAS_NEON */
+
 #if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
 /**
  * Convert a linear 24-bit RGB image to rp_image.
@@ -382,6 +447,15 @@ static inline rp_image *fromLinear24(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride = 0)
 {
+#  ifdef IMAGEDECODER_HAS_NEON
+	// ARM64 always has NEON.
+	return fromLinear24_neon(px_format, width, height, img_buf, img_siz, stride);
+#  else /* !IMAGEDECODER_HAS_NEON */
+#  ifdef IMAGEDECODER_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return fromLinear24_avx2(px_format, width, height, img_buf, img_siz, stride);
+	} else
+#  endif /* IMAGEDECODER_HAS_AVX2 */
 #  ifdef IMAGEDECODER_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return fromLinear24_ssse3(px_format, width, height, img_buf, img_siz, stride);
@@ -390,6 +464,7 @@ static inline rp_image *fromLinear24(PixelFormat px_format,
 	{
 		return fromLinear24_cpp(px_format, width, height, img_buf, img_siz, stride);
 	}
+#  endif /* IMAGEDECODER_HAS_NEON */
 }
 #endif /* RP_HAS_IFUNC && (RP_CPU_I386 || RP_CPU_AMD64) */
 
@@ -427,6 +502,40 @@ rp_image *fromLinear32_ssse3(PixelFormat px_format,
 	const uint32_t *RESTRICT img_buf, int img_siz, int stride = 0);
 #endif /* IMAGEDECODER_HAS_SSSE3 */
 
+#ifdef IMAGEDECODER_HAS_AVX2
+/**
+ * Convert a linear 32-bit RGB image to rp_image.
+ * AVX2-optimized version.
+ * @param px_format	[in] 32-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] 32-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*2]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear32_avx2(PixelFormat px_format,
+	int width, int height,
+	const uint32_t *RESTRICT img_buf, int img_siz, int stride = 0);
+#endif /* IMAGEDECODER_HAS_AVX2 */
+
+#ifdef IMAGEDECODER_HAS_NEON
+/**
+ * Convert a linear 32-bit RGB image to rp_image.
+ * NEON-optimized version.
+ * @param px_format	[in] 32-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] 32-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*2]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear32_neon(PixelFormat px_format,
+	int width, int height,
+	const uint32_t *RESTRICT img_buf, int img_siz, int stride = 0);
+#endif /* IMAGEDECODER_HAS_NEON */
+
 #if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
 /**
  * Convert a linear 32-bit RGB image to rp_image.
@@ -459,6 +568,15 @@ static inline rp_image *fromLinear32(PixelFormat px_format,
 	int width, int height,
 	const uint32_t *RESTRICT img_buf, int img_siz, int stride = 0)
 {
+#  ifdef IMAGEDECODER_HAS_NEON
+	// ARM64 always has NEON.
+	return fromLinear32_neon(px_format, width, height, img_buf, img_siz, stride);
+#  else /* !IMAGEDECODER_HAS_NEON */
+#  ifdef IMAGEDECODER_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return fromLinear32_avx2(px_format, width, height, img_buf, img_siz, stride);
+	} else
+#  endif /* IMAGEDECODER_HAS_AVX2 */
 #  ifdef IMAGEDECODER_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return fromLinear32_ssse3(px_format, width, height, img_buf, img_siz, stride);
@@ -467,11 +585,43 @@ static inline rp_image *fromLinear32(PixelFormat px_format,
 	{
 		return fromLinear32_cpp(px_format, width, height, img_buf, img_siz, stride);
 	}
+#  endif /* IMAGEDECODER_HAS_NEON */
 }
 #endif /* !RP_HAS_IFUNC || (!RP_CPU_I386 && !RP_CPU_AMD64) */
 
 /** GameCube **/
 
+/**
+ * Convert a GameCube 16-bit image to rp_image.
+ * Standard version using regular C++ code.
+ * @param px_format 16-bit pixel format.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB5A3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromGcn16_cpp(PixelFormat px_format,
+	int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz);
+
+#ifdef IMAGEDECODER_HAS_SSE2
+/**
+ * Convert a GameCube 16-bit image to rp_image.
+ * SSE2-optimized version.
+ * @param px_format 16-bit pixel format.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB5A3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromGcn16_sse2(PixelFormat px_format,
+	int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz);
+#endif /* IMAGEDECODER_HAS_SSE2 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
 /**
  * Convert a GameCube 16-bit image to rp_image.
  * @param px_format 16-bit pixel format.
@@ -481,9 +631,38 @@ static inline rp_image *fromLinear32(PixelFormat px_format,
  * @param img_siz Size of image data. [must be >= (w*h)*2]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromGcn16(PixelFormat px_format,
+IFUNC_STATIC_INLINE rp_image *fromGcn16(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
+/**
+ * Convert a GameCube 16-bit image to rp_image.
+ * @param px_format 16-bit pixel format.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB5A3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @return rp_image, or nullptr on error.
+ */
+static inline rp_image *fromGcn16(PixelFormat px_format,
+	int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz)
+{
+#  ifdef IMAGEDECODER_ALWAYS_HAS_SSE2
+	// amd64 always has SSE2.
+	return fromGcn16_sse2(px_format, width, height, img_buf, img_siz);
+#  else /* !IMAGEDECODER_ALWAYS_HAS_SSE2 */
+#    ifdef IMAGEDECODER_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		return fromGcn16_sse2(px_format, width, height, img_buf, img_siz);
+	} else
+#    endif /* IMAGEDECODER_HAS_SSE2 */
+	{
+		return fromGcn16_cpp(px_format, width, height, img_buf, img_siz);
+	}
+#  endif /* IMAGEDECODER_ALWAYS_HAS_SSE2 */
+}
+#endif /* RP_HAS_IFUNC */
 
 /**
  * Convert a GameCube CI8 image to rp_image.
@@ -533,105 +712,506 @@ rp_image *fromNDS_CI4(int width, int height,
 
 /**
  * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
+ * Standard version using regular C++ code.
  * @param width Image width.
  * @param height Image height.
  * @param img_buf RGB565 tiled image buffer.
  * @param img_siz Size of image data. [must be >= (w*h)*2]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromN3DSTiledRGB565(int width, int height,
+rp_image *fromN3DSTiledRGB565_cpp(int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz);
 
+#ifdef IMAGEDECODER_HAS_SSE2
 /**
- * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
+ * SSE2-optimized version.
  * @param width Image width.
  * @param height Image height.
  * @param img_buf RGB565 tiled image buffer.
  * @param img_siz Size of image data. [must be >= (w*h)*2]
- * @param alpha_buf A4 tiled alpha buffer.
- * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
  * @return rp_image, or nullptr on error.
  */
-ATTR_ACCESS_SIZE(read_only, 5, 6)
-rp_image *fromN3DSTiledRGB565_A4(int width, int height,
-	const uint16_t *RESTRICT img_buf, int img_siz,
-	const uint8_t *RESTRICT alpha_buf, int alpha_siz);
-
-/* S3TC */
+rp_image *fromN3DSTiledRGB565_sse2(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz);
+#endif /* IMAGEDECODER_HAS_SSE2 */
 
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
 /**
- * Convert a GameCube DXT1 image to rp_image.
- * The GameCube variant has 2x2 block tiling in addition to 4x4 pixel tiling.
- * S3TC palette index 3 will be interpreted as fully transparent.
- *
+ * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
  * @param width Image width.
  * @param height Image height.
- * @param img_buf DXT1 image buffer.
- * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
  * @return rp_image, or nullptr on error.
  */
-ATTR_ACCESS_SIZE(read_only, 3, 4)
-rp_image *fromDXT1_GCN(int width, int height,
-	const uint8_t *RESTRICT img_buf, int img_siz);
-
+IFUNC_STATIC_INLINE rp_image *fromN3DSTiledRGB565(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
 /**
- * Convert a DXT1 image to rp_image.
- * S3TC palette index 3 will be interpreted as black.
- *
+ * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
  * @param width Image width.
  * @param height Image height.
- * @param img_buf DXT1 image buffer.
- * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
  * @return rp_image, or nullptr on error.
  */
-ATTR_ACCESS_SIZE(read_only, 3, 4)
-rp_image *fromDXT1(int width, int height,
-	const uint8_t *RESTRICT img_buf, int img_siz);
+static inline rp_image *fromN3DSTiledRGB565(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz)
+{
+#  ifdef IMAGEDECODER_ALWAYS_HAS_SSE2
+	// amd64 always has SSE2.
+	return fromN3DSTiledRGB565_sse2(width, height, img_buf, img_siz);
+#  else /* !IMAGEDECODER_ALWAYS_HAS_SSE2 */
+#    ifdef IMAGEDECODER_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		return fromN3DSTiledRGB565_sse2(width, height, img_buf, img_siz);
+	} else
+#    endif /* IMAGEDECODER_HAS_SSE2 */
+	{
+		return fromN3DSTiledRGB565_cpp(width, height, img_buf, img_siz);
+	}
+#  endif /* IMAGEDECODER_ALWAYS_HAS_SSE2 */
+}
+#endif /* RP_HAS_IFUNC */
 
 /**
- * Convert a DXT1 image to rp_image.
- * S3TC palette index 3 will be interpreted as fully transparent.
- *
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * Standard version using regular C++ code.
  * @param width Image width.
  * @param height Image height.
- * @param img_buf DXT1 image buffer.
- * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
  * @return rp_image, or nullptr on error.
  */
-ATTR_ACCESS_SIZE(read_only, 3, 4)
-rp_image *fromDXT1_A1(int width, int height,
-	const uint8_t *RESTRICT img_buf, int img_siz);
+ATTR_ACCESS_SIZE(read_only, 5, 6)
+rp_image *fromN3DSTiledRGB565_A4_cpp(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz);
 
+#ifdef IMAGEDECODER_HAS_SSE2
 /**
- * Convert a DXT2 image to rp_image.
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * SSE2-optimized version.
  * @param width Image width.
  * @param height Image height.
- * @param img_buf DXT2 image buffer.
- * @param img_siz Size of image data. [must be >= (w*h)]
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
  * @return rp_image, or nullptr on error.
  */
-ATTR_ACCESS_SIZE(read_only, 3, 4)
-rp_image *fromDXT2(int width, int height,
-	const uint8_t *RESTRICT img_buf, int img_siz);
+ATTR_ACCESS_SIZE(read_only, 5, 6)
+rp_image *fromN3DSTiledRGB565_A4_sse2(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz);
+#endif /* IMAGEDECODER_HAS_SSE2 */
 
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
 /**
- * Convert a DXT3 image to rp_image.
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
  * @param width Image width.
  * @param height Image height.
- * @param img_buf DXT3 image buffer.
- * @param img_siz Size of image data. [must be >= (w*h)]
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
  * @return rp_image, or nullptr on error.
  */
-ATTR_ACCESS_SIZE(read_only, 3, 4)
-rp_image *fromDXT3(int width, int height,
-	const uint8_t *RESTRICT img_buf, int img_siz);
-
+IFUNC_STATIC_INLINE rp_image *fromN3DSTiledRGB565_A4(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
 /**
- * Convert a DXT4 image to rp_image.
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
  * @param width Image width.
  * @param height Image height.
- * @param img_buf DXT4 image buffer.
- * @param img_siz Size of image data. [must be >= (w*h)]
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+static inline rp_image *fromN3DSTiledRGB565_A4(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz)
+{
+#  ifdef IMAGEDECODER_ALWAYS_HAS_SSE2
+	// amd64 always has SSE2.
+	return fromN3DSTiledRGB565_A4_sse2(width, height, img_buf, img_siz, alpha_buf, alpha_siz);
+#  else /* !IMAGEDECODER_ALWAYS_HAS_SSE2 */
+#    ifdef IMAGEDECODER_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		return fromN3DSTiledRGB565_A4_sse2(width, height, img_buf, img_siz, alpha_buf, alpha_siz);
+	} else
+#    endif /* IMAGEDECODER_HAS_SSE2 */
+	{
+		return fromN3DSTiledRGB565_A4_cpp(width, height, img_buf, img_siz, alpha_buf, alpha_siz);
+	}
+#  endif /* IMAGEDECODER_ALWAYS_HAS_SSE2 */
+}
+#endif /* RP_HAS_IFUNC */
+
+/**
+ * Decode a Nintendo 3DS RGB565+A4 tiled icon
+ * into a caller-provided ARGB32 buffer.
+ * Standard version using regular C++ code.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @param dest ARGB32 destination buffer. [must have height rows of width pixels]
+ * @param dest_stride Destination stride, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 5, 6)
+int decodeN3DSTiledRGB565_A4_cpp(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz,
+	uint32_t *RESTRICT dest, int dest_stride);
+
+#ifdef IMAGEDECODER_HAS_SSE2
+/**
+ * Decode a Nintendo 3DS RGB565+A4 tiled icon
+ * into a caller-provided ARGB32 buffer.
+ * SSE2-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @param dest ARGB32 destination buffer. [must have height rows of width pixels]
+ * @param dest_stride Destination stride, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 5, 6)
+int decodeN3DSTiledRGB565_A4_sse2(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz,
+	uint32_t *RESTRICT dest, int dest_stride);
+#endif /* IMAGEDECODER_HAS_SSE2 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+/**
+ * Decode a Nintendo 3DS RGB565+A4 tiled icon
+ * into a caller-provided ARGB32 buffer.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @param dest ARGB32 destination buffer. [must have height rows of width pixels]
+ * @param dest_stride Destination stride, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+IFUNC_STATIC_INLINE int decodeN3DSTiledRGB565_A4(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz,
+	uint32_t *RESTRICT dest, int dest_stride);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
+/**
+ * Decode a Nintendo 3DS RGB565+A4 tiled icon
+ * into a caller-provided ARGB32 buffer.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @param dest ARGB32 destination buffer. [must have height rows of width pixels]
+ * @param dest_stride Destination stride, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static inline int decodeN3DSTiledRGB565_A4(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz,
+	uint32_t *RESTRICT dest, int dest_stride)
+{
+#  ifdef IMAGEDECODER_ALWAYS_HAS_SSE2
+	// amd64 always has SSE2.
+	return decodeN3DSTiledRGB565_A4_sse2(width, height, img_buf, img_siz, alpha_buf, alpha_siz, dest, dest_stride);
+#  else /* !IMAGEDECODER_ALWAYS_HAS_SSE2 */
+#    ifdef IMAGEDECODER_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		return decodeN3DSTiledRGB565_A4_sse2(width, height, img_buf, img_siz, alpha_buf, alpha_siz, dest, dest_stride);
+	} else
+#    endif /* IMAGEDECODER_HAS_SSE2 */
+	{
+		return decodeN3DSTiledRGB565_A4_cpp(width, height, img_buf, img_siz, alpha_buf, alpha_siz, dest, dest_stride);
+	}
+#  endif /* IMAGEDECODER_ALWAYS_HAS_SSE2 */
+}
+#endif /* RP_HAS_IFUNC */
+
+/**
+ * Convert a grid of Nintendo 3DS RGB565+A4 tiled icons to a single rp_image.
+ * This is used for Nintendo Badge Arcade mega badges.
+ *
+ * Each icon is decoded directly into its position in the
+ * destination image. Large grids are decoded in parallel
+ * using the shared decoder thread pool.
+ *
+ * Icons are stored left to right, then top to bottom.
+ * Each icon has its RGB565 data followed by its A4 data.
+ *
+ * @param width Icon width.
+ * @param height Icon height.
+ * @param cols Number of icons horizontally.
+ * @param rows Number of icons vertically.
+ * @param buf Icon data.
+ * @param buf_siz Size of icon data. [must be >= ((cols*rows)-1)*icon_stride + (w*h)*2 + (w*h)/2]
+ * @param icon_stride Distance between icons in buf, in bytes. [must be >= (w*h)*2 + (w*h)/2, and even]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 5, 6)
+rp_image *fromN3DSTiledRGB565_A4_Grid(int width, int height,
+	int cols, int rows,
+	const uint8_t *buf, size_t buf_siz,
+	unsigned int icon_stride);
+
+/* S3TC */
+
+/**
+ * Convert a GameCube DXT1 image to rp_image.
+ * The GameCube variant has 2x2 block tiling in addition to 4x4 pixel tiling.
+ * S3TC palette index 3 will be interpreted as fully transparent.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT1_GCN(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+
+/**
+ * Convert a DXT1 image to rp_image.
+ * Standard version. (C++ code only)
+ * S3TC palette index 3 will be interpreted as black.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT1_cpp(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+
+#ifdef IMAGEDECODER_HAS_SSE41
+/**
+ * Convert a DXT1 image to rp_image.
+ * SSE4.1-optimized version.
+ * S3TC palette index 3 will be interpreted as black.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT1_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#endif /* IMAGEDECODER_HAS_SSE41 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+/**
+ * Convert a DXT1 image to rp_image.
+ * S3TC palette index 3 will be interpreted as black.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+IFUNC_STATIC_INLINE rp_image *fromDXT1(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
+/**
+ * Convert a DXT1 image to rp_image.
+ * S3TC palette index 3 will be interpreted as black.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+static inline rp_image *fromDXT1(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+#  ifdef IMAGEDECODER_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		return fromDXT1_sse41(width, height, img_buf, img_siz);
+	} else
+#  endif /* IMAGEDECODER_HAS_SSE41 */
+	{
+		return fromDXT1_cpp(width, height, img_buf, img_siz);
+	}
+}
+#endif /* RP_HAS_IFUNC */
+
+/**
+ * Convert a DXT1 image to rp_image.
+ * Standard version. (C++ code only)
+ * S3TC palette index 3 will be interpreted as fully transparent.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT1_A1_cpp(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+
+#ifdef IMAGEDECODER_HAS_SSE41
+/**
+ * Convert a DXT1 image to rp_image.
+ * SSE4.1-optimized version.
+ * S3TC palette index 3 will be interpreted as fully transparent.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT1_A1_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#endif /* IMAGEDECODER_HAS_SSE41 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+/**
+ * Convert a DXT1 image to rp_image.
+ * S3TC palette index 3 will be interpreted as fully transparent.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+IFUNC_STATIC_INLINE rp_image *fromDXT1_A1(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
+/**
+ * Convert a DXT1 image to rp_image.
+ * S3TC palette index 3 will be interpreted as fully transparent.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+static inline rp_image *fromDXT1_A1(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+#  ifdef IMAGEDECODER_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		return fromDXT1_A1_sse41(width, height, img_buf, img_siz);
+	} else
+#  endif /* IMAGEDECODER_HAS_SSE41 */
+	{
+		return fromDXT1_A1_cpp(width, height, img_buf, img_siz);
+	}
+}
+#endif /* RP_HAS_IFUNC */
+
+/**
+ * Convert a DXT2 image to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT2 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT2(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+
+/**
+ * Convert a DXT3 image to rp_image.
+ * Standard version. (C++ code only)
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT3_cpp(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+
+#ifdef IMAGEDECODER_HAS_SSE41
+/**
+ * Convert a DXT3 image to rp_image.
+ * SSE4.1-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT3_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#endif /* IMAGEDECODER_HAS_SSE41 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+/**
+ * Convert a DXT3 image to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+IFUNC_STATIC_INLINE rp_image *fromDXT3(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
+/**
+ * Convert a DXT3 image to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+static inline rp_image *fromDXT3(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+#  ifdef IMAGEDECODER_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		return fromDXT3_sse41(width, height, img_buf, img_siz);
+	} else
+#  endif /* IMAGEDECODER_HAS_SSE41 */
+	{
+		return fromDXT3_cpp(width, height, img_buf, img_siz);
+	}
+}
+#endif /* RP_HAS_IFUNC */
+
+/**
+ * Convert a DXT4 image to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
  * @return rp_image, or nullptr on error.
  */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
@@ -640,6 +1220,21 @@ rp_image *fromDXT4(int width, int height,
 
 /**
  * Convert a DXT5 image to rp_image.
+ * Standard version. (C++ code only)
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT5 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromDXT5_cpp(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+
+#ifdef IMAGEDECODER_HAS_SSE41
+/**
+ * Convert a DXT5 image to rp_image.
+ * SSE4.1-optimized version.
  * @param width Image width.
  * @param height Image height.
  * @param img_buf DXT5 image buffer.
@@ -647,9 +1242,90 @@ rp_image *fromDXT4(int width, int height,
  * @return rp_image, or nullptr on error.
  */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
-rp_image *fromDXT5(int width, int height,
+rp_image *fromDXT5_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#endif /* IMAGEDECODER_HAS_SSE41 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+/**
+ * Convert a DXT5 image to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT5 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+IFUNC_STATIC_INLINE rp_image *fromDXT5(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
+/**
+ * Convert a DXT5 image to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT5 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+static inline rp_image *fromDXT5(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+#  ifdef IMAGEDECODER_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		return fromDXT5_sse41(width, height, img_buf, img_siz);
+	} else
+#  endif /* IMAGEDECODER_HAS_SSE41 */
+	{
+		return fromDXT5_cpp(width, height, img_buf, img_siz);
+	}
+}
+#endif /* RP_HAS_IFUNC */
+
+/**
+ * Convert a BC4 (ATI1) image to rp_image.
+ * Standard version. (C++ code only)
+ * Color component is Red.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf BC4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromBC4_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz);
 
+#ifdef IMAGEDECODER_HAS_SSE41
+/**
+ * Convert a BC4 (ATI1) image to rp_image.
+ * SSE4.1-optimized version.
+ * Color component is Red.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf BC4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 3, 4)
+rp_image *fromBC4_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#endif /* IMAGEDECODER_HAS_SSE41 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+/**
+ * Convert a BC4 (ATI1) image to rp_image.
+ * Color component is Red.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf BC4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+IFUNC_STATIC_INLINE rp_image *fromBC4(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
 /**
  * Convert a BC4 (ATI1) image to rp_image.
  * Color component is Red.
@@ -660,12 +1336,39 @@ rp_image *fromDXT5(int width, int height,
  * @param img_siz Size of image data. [must be >= (w*h)]
  * @return rp_image, or nullptr on error.
  */
+static inline rp_image *fromBC4(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+#  ifdef IMAGEDECODER_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		return fromBC4_sse41(width, height, img_buf, img_siz);
+	} else
+#  endif /* IMAGEDECODER_HAS_SSE41 */
+	{
+		return fromBC4_cpp(width, height, img_buf, img_siz);
+	}
+}
+#endif /* RP_HAS_IFUNC */
+
+/**
+ * Convert a BC5 (ATI2) image to rp_image.
+ * Standard version. (C++ code only)
+ * Color components are Red and Green.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf BC4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
-rp_image *fromBC4(int width, int height,
+rp_image *fromBC5_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz);
 
+#ifdef IMAGEDECODER_HAS_SSE41
 /**
  * Convert a BC5 (ATI2) image to rp_image.
+ * SSE4.1-optimized version.
  * Color components are Red and Green.
  *
  * @param width Image width.
@@ -675,8 +1378,47 @@ rp_image *fromBC4(int width, int height,
  * @return rp_image, or nullptr on error.
  */
 ATTR_ACCESS_SIZE(read_only, 3, 4)
-rp_image *fromBC5(int width, int height,
+rp_image *fromBC5_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz);
+#endif /* IMAGEDECODER_HAS_SSE41 */
+
+#if defined(RP_HAS_IFUNC) && (defined(RP_CPU_I386) || defined(RP_CPU_AMD64))
+/**
+ * Convert a BC5 (ATI2) image to rp_image.
+ * Color components are Red and Green.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf BC4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+IFUNC_STATIC_INLINE rp_image *fromBC5(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz);
+#else /* !RP_HAS_IFUNC or not i386/amd64 */
+/**
+ * Convert a BC5 (ATI2) image to rp_image.
+ * Color components are Red and Green.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf BC4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+static inline rp_image *fromBC5(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+#  ifdef IMAGEDECODER_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		return fromBC5_sse41(width, height, img_buf, img_siz);
+	} else
+#  endif /* IMAGEDECODER_HAS_SSE41 */
+	{
+		return fromBC5_cpp(width, height, img_buf, img_siz);
+	}
+}
+#endif /* RP_HAS_IFUNC */
 
 /**
  * Convert a Red image to Luminance.
@@ -694,6 +1436,94 @@ int fromRed8ToL8(rp_image *img);
  */
  int fromRG8ToLA8(rp_image *img);
 
+/* S3TC region decoding */
+
+/**
+ * Block-compressed formats supported by the region decoding functions.
+ * These don't allocate a full-size rp_image, so large textures can
+ * be decoded in strips, e.g. for thumbnailing.
+ */
+enum BlockFormat {
+	BLKF_DXT1,	// DXT1; palette index 3 is black.
+	BLKF_DXT1_A1,	// DXT1; palette index 3 is fully transparent.
+	BLKF_DXT3,
+	BLKF_DXT5,
+	BLKF_BC4,	// Color component is Red.
+	BLKF_BC5,	// Color components are Red and Green.
+
+	BLKF_MAX
+};
+
+/**
+ * Decode a rectangular region of a block-compressed image
+ * into a caller-provided ARGB32 buffer.
+ *
+ * Only the blocks that intersect the region are decoded.
+ * To stream an image in strips, decode full-width regions
+ * that are a multiple of 4 pixels high.
+ *
+ * @param fmt		[in] Block format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer.
+ * @param img_siz	[in] Size of image data.
+ * @param x		[in] Region X position.
+ * @param y		[in] Region Y position.
+ * @param w		[in] Region width.
+ * @param h		[in] Region height.
+ * @param dest		[out] ARGB32 destination buffer. [must have h rows of w pixels]
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 4, 5)
+int decodeBlockRegion(BlockFormat fmt, int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	int x, int y, int w, int h,
+	uint32_t *RESTRICT dest, int dest_stride);
+
+/**
+ * Convert a rectangular region of a block-compressed image to rp_image.
+ * @param fmt		[in] Block format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer.
+ * @param img_siz	[in] Size of image data.
+ * @param x		[in] Region X position.
+ * @param y		[in] Region Y position.
+ * @param w		[in] Region width.
+ * @param h		[in] Region height.
+ * @return rp_image containing the region, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 4, 5)
+rp_image *fromBlockRegion(BlockFormat fmt, int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	int x, int y, int w, int h);
+
+/**
+ * Convert a block-compressed image to a downscaled rp_image.
+ *
+ * The image is decoded one row of blocks at a time and
+ * box-filtered into the destination image, so the full-size
+ * image is never allocated. The result is identical to
+ * decoding the full image and calling scaled() with SCALE_BOX.
+ *
+ * If the destination is larger than the source in either
+ * dimension, the full image is decoded and then scaled.
+ *
+ * @param fmt		[in] Block format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer.
+ * @param img_siz	[in] Size of image data.
+ * @param dest_width	[in] Destination width.
+ * @param dest_height	[in] Destination height.
+ * @return Downscaled ARGB32 rp_image, or nullptr on error.
+ */
+ATTR_ACCESS_SIZE(read_only, 4, 5)
+rp_image *fromBlockScaled(BlockFormat fmt, int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	int dest_width, int dest_height);
+
 /* Dreamcast */
 
 /**
@@ -863,6 +1693,61 @@ rp_image *fromPVRTCII(int width, int height,
 	uint8_t mode);
 #endif /* ENABLE_PVRTC */
 
+/** Parallel decoding **/
+
+/**
+ * Set the number of threads used to decode large images.
+ *
+ * Large block-compressed images are split into strips of tile rows,
+ * which are decoded using a thread pool shared by all decoders.
+ * Only one image is decoded in parallel at a time; other images
+ * are decoded on the calling thread.
+ *
+ * Programs that already decode multiple images concurrently
+ * should reduce this to avoid oversubscribing the CPU.
+ *
+ * @param count Number of threads, including the calling thread. (0 for the number of CPUs; 1 to disable)
+ */
+void setDecodeThreadCount(unsigned int count);
+
+/**
+ * Get the number of threads used to decode large images.
+ * @return Number of threads. (0 for the number of CPUs; 1 if disabled)
+ */
+unsigned int decodeThreadCount(void);
+
+/** GPU decoding **/
+
+/**
+ * Enable or disable GPU decoding of large block-compressed images.
+ *
+ * If enabled, S3TC, BC4, BC5, BC7, ETC1, and ETC2 images with at
+ * least 2048x2048 pixels are decoded using OpenCL if a GPU device
+ * is available. If OpenCL can't be initialized, if the GPU is
+ * busy with another image, or if GPU decoding fails, the image
+ * is decoded on the CPU.
+ *
+ * GPU decoding is disabled by default, since loading the OpenCL
+ * driver is expensive and isn't allowed by the seccomp filters
+ * used by some frontends.
+ *
+ * @param enabled True to enable; false to disable.
+ */
+void setGpuDecodeEnabled(bool enabled);
+
+/**
+ * Is GPU decoding of large block-compressed images enabled?
+ * NOTE: This doesn't check if OpenCL is actually available.
+ * @return True if enabled; false if not.
+ */
+bool isGpuDecodeEnabled(void);
+
+/**
+ * Register the ImageDecoder SIMD kernels with the SIMD registry.
+ * This is used by `rpcli --cpu-selftest`.
+ */
+void registerSimdKernels(void);
+
 /* BC7 */
 
 /**
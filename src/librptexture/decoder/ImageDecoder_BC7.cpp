@@ -74,68 +74,6 @@ static const uint32_t bc7_3sub[64] = {
 	0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254
 };
 
-/**
- * Interpolate a color component.
- * @tparam bits Index precision, in number of bits.
- * @param index Color/alpha index.
- * @param e0 Endpoint 0 component.
- * @param e1 Endpoint 1 component.
- * @return Interpolated color component.
- */
-static uint8_t interpolate_component(unsigned int bits, unsigned int index, uint8_t e0, uint8_t e1)
-{
-	assert(bits >= 2 && bits <= 4);
-	assert(index < (1U << bits));
-
-	// Shortcut for no-interpolation cases.
-	// TODO: Does this actually improve performance?
-	if (index == 0) {
-		return e0;
-	} else if (index == (1U<<bits)-1) {
-		return e1;
-	}
-
-	uint8_t weight;
-	switch (bits) {
-		case 2:
-			weight = aWeight2[index];
-			break;
-		case 3:
-			weight = aWeight3[index];
-			break;
-		case 4:
-			weight = aWeight4[index];
-			break;
-		default:
-			// Should not happen...
-			return 0;
-	}
-
-	return (uint8_t)((((64 - weight) * (unsigned int)e0) +
-			       ((weight  * (unsigned int)e1) + 32)) >> 6);
-}
-
-/**
- * Get the mode number.
- * @param dword0 LSB DWORD.
- * @return Mode number.
- */
-static inline int get_mode(uint32_t dword0)
-{
-	// TODO: ctz/_BitScanForward?
-	// Benchmarks showed it was *slower* than this function...
-	for (unsigned int i = 0; i < 8; i++, dword0 >>= 1) {
-		if (dword0 & 1) {
-			// Found the mode number.
-			return i;
-		}
-	}
-
-	// Invalid mode.
-	assert(!"BC7 block has an invalid mode.");
-	return -1;
-}
-
 // Anchor indexes for the second subset (idx == 1) in 2-subset modes.
 static const uint8_t anchorIndexes_subset2of2[64] = {
 	15, 15, 15, 15, 15, 15, 15, 15,
@@ -172,48 +110,6 @@ static const uint8_t anchorIndexes_subset3of3[64] = {
 	15, 15, 15, 15,  3, 15, 15,  8,
 };
 
-/**
- * Get the index of the "anchor" bits for implied index bits.
- * @param partition Partition number.
- * @param subset Subset number.
- * @param subsetCount Total number of subsets. (1, 2, 3)
- */
-static uint8_t getAnchorIndex(uint8_t partition, uint8_t subset, uint8_t subsetCount)
-{
-	if (subset == 0) {
-		// Subset 0 always has an anchor index of 0.
-		return 0;
-	}
-
-	uint8_t idx;
-	switch (subsetCount) {
-		default:
-			assert(!"Invalid subset count.");
-			idx = 0;
-			break;
-		case 1:
-			// Should've been handled above but okay.
-			idx = 0;
-			break;
-		case 2:
-			// Two subsets.
-			// Assume this is the second subset.
-			idx = anchorIndexes_subset2of2[partition];
-			break;
-		case 3:
-			// Three subsets.
-			// Subset is either 1 or 2, since subset can't be 0.
-			assert(subset != 0);
-			idx = (subset == 1
-				? anchorIndexes_subset2of3[partition]
-				: anchorIndexes_subset3of3[partition]
-				);
-			break;
-	}
-
-	return idx;
-}
-
 /**
  * Right-shift two 64-bit values as if it's a single 128-bit value.
  * NOTE: Assuming `shamt` is always less than 64.
@@ -237,6 +133,376 @@ static FORCEINLINE void rshift128(uint64_t &msb, uint64_t &lsb, unsigned int sha
 	msb >>= shamt;
 }
 
+/** Per-mode block decoding. **/
+
+// P-bit types.
+enum PBitType {
+	PBIT_NONE = 0,		// No P-bits.
+	PBIT_SHARED,		// One P-bit per subset. (Mode 1)
+	PBIT_UNIQUE,		// One P-bit per endpoint.
+};
+
+/**
+ * BC7 mode properties.
+ * Each mode is specialized at compile time using these values.
+ * @tparam Mode Mode number. (0-7)
+ */
+template<unsigned int Mode> struct BC7Mode;
+
+#define BC7_MODE(mode, subsets, partBits, rotBits, idxSelBits, epBits, alphaBits, pbitType, idxBits, idx2Bits) \
+template<> struct BC7Mode<mode> { \
+	static const unsigned int SubsetCount = (subsets);		/* Number of subsets */ \
+	static const unsigned int PartitionBits = (partBits);		/* Partition selection bits */ \
+	static const unsigned int RotationBits = (rotBits);		/* Component rotation bits */ \
+	static const unsigned int IndexSelBits = (idxSelBits);		/* Index selection bits */ \
+	static const unsigned int EndpointBits = (epBits);		/* Bits per endpoint color component */ \
+	static const unsigned int AlphaBits = (alphaBits);		/* Bits per endpoint alpha component */ \
+	static const PBitType PBits = (pbitType);			/* P-bit type */ \
+	static const unsigned int IndexBits = (idxBits);		/* Bits per primary index */ \
+	static const unsigned int Index2Bits = (idx2Bits);		/* Bits per secondary index */ \
+	static const unsigned int EndpointCount = (subsets) * 2;	/* Number of endpoints */ \
+};
+
+//       mode sub part rot isel ep  a  pbits         idx idx2
+BC7_MODE(0,   3,  4,   0,  0,   4,  0, PBIT_UNIQUE,  3,  0)
+BC7_MODE(1,   2,  6,   0,  0,   6,  0, PBIT_SHARED,  3,  0)
+BC7_MODE(2,   3,  6,   0,  0,   5,  0, PBIT_NONE,    2,  0)
+BC7_MODE(3,   2,  6,   0,  0,   7,  0, PBIT_UNIQUE,  2,  0)
+BC7_MODE(4,   1,  0,   2,  1,   5,  6, PBIT_NONE,    2,  3)
+BC7_MODE(5,   1,  0,   2,  0,   7,  8, PBIT_NONE,    2,  2)
+BC7_MODE(6,   1,  0,   0,  0,   7,  7, PBIT_UNIQUE,  4,  0)
+BC7_MODE(7,   2,  6,   0,  0,   5,  5, PBIT_UNIQUE,  2,  0)
+
+#undef BC7_MODE
+
+/**
+ * Interpolate all four components of two ARGB32 endpoints.
+ *
+ * Each component is placed into a 16-bit lane of a 64-bit value,
+ * so all four components are interpolated with two multiplications.
+ * The largest intermediate value is (64 * 255) + 32, which fits
+ * in a 16-bit lane.
+ *
+ * @tparam bits Index precision, in number of bits. (2, 3, 4)
+ * @param pal	[out] Palette. (must have 1 << bits entries)
+ * @param e0	[in] Endpoint 0. (ARGB32)
+ * @param e1	[in] Endpoint 1. (ARGB32)
+ */
+template<unsigned int bits>
+static FORCEINLINE void interpolatePalette(uint32_t *RESTRICT pal, uint32_t e0, uint32_t e1)
+{
+	const uint8_t *const weights = (bits == 2 ? aWeight2 : (bits == 3 ? aWeight3 : aWeight4));
+
+	const uint64_t x0 =  (e0 & 0x000000FFU) |
+			    ((e0 & 0x0000FF00U) << 8) |
+			    ((static_cast<uint64_t>(e0) & 0x00FF0000U) << 16) |
+			    ((static_cast<uint64_t>(e0) & 0xFF000000U) << 24);
+	const uint64_t x1 =  (e1 & 0x000000FFU) |
+			    ((e1 & 0x0000FF00U) << 8) |
+			    ((static_cast<uint64_t>(e1) & 0x00FF0000U) << 16) |
+			    ((static_cast<uint64_t>(e1) & 0xFF000000U) << 24);
+
+	for (unsigned int i = 0; i < (1U << bits); i++) {
+		const unsigned int weight = weights[i];
+		const uint64_t v = (((64 - weight) * x0 + weight * x1 +
+			0x0020002000200020ULL) >> 6) & 0x00FF00FF00FF00FFULL;
+		pal[i] = static_cast<uint32_t>(
+			 (v & 0xFF) |
+			((v >> 8) & 0xFF00) |
+			((v >> 16) & 0xFF0000) |
+			((v >> 24) & 0xFF000000));
+	}
+}
+
+/**
+ * Decode the index data for a BC7 block.
+ * Anchor indexes have an implied high bit of 0.
+ * @tparam bits Index precision, in number of bits. (2, 3, 4)
+ * @param idx		[out] Indexes.
+ * @param idxData	[in] Index data.
+ * @param anchorMask	[in] Bitfield of anchor index positions.
+ */
+template<unsigned int bits>
+static FORCEINLINE void decodeIndexes(uint8_t idx[16], uint64_t idxData, uint32_t anchorMask)
+{
+	static const uint8_t index_mask = (1U << bits) - 1;
+	for (unsigned int i = 0; i < 16; i++, anchorMask >>= 1) {
+		if (anchorMask & 1) {
+			// This is an anchor index.
+			// Highest bit is 0.
+			idx[i] = idxData & (index_mask >> 1);
+			idxData >>= (bits - 1);
+		} else {
+			// Regular index.
+			idx[i] = idxData & index_mask;
+			idxData >>= bits;
+		}
+	}
+}
+
+/**
+ * Swap the alpha channel with another channel.
+ * Only used by modes 4 and 5.
+ * - 00: ARGB - no swapping
+ * - 01: RAGB - swap A and R
+ * - 10: GRAB - swap A and G
+ * - 11: BRGA - swap A and B
+ * @param tileBuf	[in/out] Tile buffer.
+ * @param rotation	[in] Rotation mode.
+ */
+static inline void rotateComponents(uint32_t tileBuf[16], unsigned int rotation)
+{
+	switch (rotation & 3) {
+		case 0:
+			// ARGB: No rotation.
+			break;
+		case 1:
+			// RAGB: Swap A and R.
+			for (unsigned int i = 0; i < 16; i++) {
+				const uint32_t px = tileBuf[i];
+				tileBuf[i] = (px & 0x0000FFFF) | ((px << 8) & 0xFF000000) | ((px >> 8) & 0x00FF0000);
+			}
+			break;
+		case 2:
+			// GRAB: Swap A and G.
+			for (unsigned int i = 0; i < 16; i++) {
+				const uint32_t px = tileBuf[i];
+				tileBuf[i] = (px & 0x00FF00FF) | ((px << 16) & 0xFF000000) | ((px >> 16) & 0x0000FF00);
+			}
+			break;
+		case 3:
+			// BRGA: Swap A and B.
+			for (unsigned int i = 0; i < 16; i++) {
+				const uint32_t px = tileBuf[i];
+				tileBuf[i] = (px & 0x00FFFF00) | (px << 24) | (px >> 24);
+			}
+			break;
+	}
+}
+
+/**
+ * Decode a BC7 block.
+ * @tparam Mode Mode number. (0-7)
+ * @param tileBuf	[out] Tile buffer. (ARGB32)
+ * @param lsb		[in] LSB QWORD. (host-endian)
+ * @param msb		[in] MSB QWORD. (host-endian)
+ */
+template<unsigned int Mode>
+static void decodeBlock(uint32_t tileBuf[16], uint64_t lsb, uint64_t msb)
+{
+	typedef BC7Mode<Mode> M;
+
+	// Skip the mode bits.
+	rshift128(msb, lsb, Mode+1);
+
+	// Rotation mode. (Modes 4 and 5 only)
+	unsigned int rotation_mode = 0;
+	if (M::RotationBits != 0) {
+		rotation_mode = lsb & 3;
+		rshift128(msb, lsb, M::RotationBits);
+	}
+
+	// Index mode selector. (Mode 4 only)
+	// - idxMode_m4 == 0: Color == 2-bit, Alpha == 3-bit
+	// - idxMode_m4 == 1: Color == 3-bit, Alpha == 2-bit
+	unsigned int idxMode_m4 = 0;
+	if (M::IndexSelBits != 0) {
+		idxMode_m4 = lsb & 1;
+		rshift128(msb, lsb, M::IndexSelBits);
+	}
+
+	// Subset/partition.
+	// Subset 0 is always anchored at pixel 0. Other subsets
+	// depend on the subset count and partition number.
+	uint32_t subset = 0;
+	uint32_t anchorMask = 1;
+	if (M::PartitionBits != 0) {
+		const unsigned int partition = lsb & ((1U << M::PartitionBits) - 1);
+		rshift128(msb, lsb, M::PartitionBits);
+
+		if (M::SubsetCount == 2) {
+			subset = bc7_2sub[partition];
+			anchorMask |= (1U << anchorIndexes_subset2of2[partition]);
+		} else {
+			subset = bc7_3sub[partition];
+			anchorMask |= (1U << anchorIndexes_subset2of3[partition]) |
+				      (1U << anchorIndexes_subset3of3[partition]);
+		}
+	}
+
+	// Extract the components.
+	// NOTE: Components are stored in RRRR/GGGG/BBBB/AAAA order.
+	// [i][0] == R, [i][1] == G, [i][2] == B, [i][3] == A
+	uint8_t endpoints[M::EndpointCount][4];
+	static const uint8_t endpoint_mask = (1U << M::EndpointBits) - 1;
+	for (unsigned int c = 0; c < 3; c++) {
+		for (unsigned int i = 0; i < M::EndpointCount; i++) {
+			endpoints[i][c] = (lsb & endpoint_mask) << (8 - M::EndpointBits);
+			rshift128(msb, lsb, M::EndpointBits);
+		}
+	}
+	if (M::AlphaBits != 0) {
+		static const uint8_t alpha_mask = (1U << M::AlphaBits) - 1;
+		for (unsigned int i = 0; i < M::EndpointCount; i++) {
+			endpoints[i][3] = (lsb & alpha_mask) << (8 - M::AlphaBits);
+			rshift128(msb, lsb, M::AlphaBits);
+		}
+	}
+
+	// P-bits.
+	// The P-bit is placed below the endpoint bits, and the
+	// endpoint bit count is incremented for expansion.
+	unsigned int endpoint_bits = M::EndpointBits;
+	unsigned int alpha_bits = M::AlphaBits;
+	if (M::PBits == PBIT_SHARED) {
+		// One P-bit per subset.
+		static const uint8_t p_ep = 1U << (7 - M::EndpointBits);
+		for (unsigned int s = 0; s < M::SubsetCount; s++) {
+			if (lsb & (1U << s)) {
+				for (unsigned int c = 0; c < 3; c++) {
+					endpoints[s*2][c] |= p_ep;
+					endpoints[s*2+1][c] |= p_ep;
+				}
+			}
+		}
+		rshift128(msb, lsb, M::SubsetCount);
+		endpoint_bits++;
+	} else if (M::PBits == PBIT_UNIQUE) {
+		// One P-bit per endpoint.
+		// The same P-bit is used for the alpha component.
+		static const uint8_t p_ep = 1U << (7 - M::EndpointBits);
+		static const uint8_t p_a = (M::AlphaBits != 0) ? (1U << (7 - M::AlphaBits)) : 0;
+		for (unsigned int i = 0; i < M::EndpointCount; i++) {
+			if (lsb & (1U << i)) {
+				endpoints[i][0] |= p_ep;
+				endpoints[i][1] |= p_ep;
+				endpoints[i][2] |= p_ep;
+				endpoints[i][3] |= p_a;
+			}
+		}
+		rshift128(msb, lsb, M::EndpointCount);
+		endpoint_bits++;
+		if (M::AlphaBits != 0) {
+			alpha_bits++;
+		}
+	}
+
+	// Expand the endpoints and alpha components,
+	// and convert them to ARGB32.
+	uint32_t ep32[M::EndpointCount];
+	for (unsigned int i = 0; i < M::EndpointCount; i++) {
+		uint8_t r = endpoints[i][0], g = endpoints[i][1], b = endpoints[i][2];
+		if (endpoint_bits < 8) {
+			r |= (r >> endpoint_bits);
+			g |= (g >> endpoint_bits);
+			b |= (b >> endpoint_bits);
+		}
+		uint8_t a;
+		if (M::AlphaBits != 0) {
+			a = endpoints[i][3];
+			if (alpha_bits < 8) {
+				a |= (a >> alpha_bits);
+			}
+		} else {
+			// No alpha. Use 255.
+			a = 255;
+		}
+		ep32[i] = (static_cast<uint32_t>(a) << 24) | (r << 16) | (g << 8) | b;
+	}
+
+	// At this point, the only remaining data is indexes,
+	// which fits entirely into LSB, except for mode 4.
+	uint8_t idx[16];
+	if (M::Index2Bits != 0) {
+		// Separate color and alpha indexes. (Modes 4 and 5)
+		// NOTE: Only one subset, so no subset lookups are needed.
+		uint32_t pal[1U << 3], pal_a[1U << 3];
+		uint8_t idx_a[16];
+		if (Mode == 4) {
+			// 2-bit indexes: Low 31 bits.
+			// 3-bit indexes: Remaining 47 bits. We've already shifted by
+			// 50 bits by now, so the MSB contains the high 14 bits of the
+			// index data, and the LSB contains the low 33 bits.
+			const uint64_t idxData2 = lsb & ((1U << 31) - 1);
+			const uint64_t idxData3 = (msb << 33) | (lsb >> 31);
+			if (idxMode_m4) {
+				// idxMode is set: Color data uses the 3-bit indexes.
+				interpolatePalette<3>(pal, ep32[0], ep32[1]);
+				interpolatePalette<2>(pal_a, ep32[0], ep32[1]);
+				decodeIndexes<3>(idx, idxData3, anchorMask);
+				decodeIndexes<2>(idx_a, idxData2, anchorMask);
+			} else {
+				// idxMode is not set: Color data uses the 2-bit indexes.
+				interpolatePalette<2>(pal, ep32[0], ep32[1]);
+				interpolatePalette<3>(pal_a, ep32[0], ep32[1]);
+				decodeIndexes<2>(idx, idxData2, anchorMask);
+				decodeIndexes<3>(idx_a, idxData3, anchorMask);
+			}
+		} else {
+			// Mode 5: Alpha indexes are stored after the color indexes.
+			// NOTE: Both index sets are 2-bit. Using constants here
+			// so other modes don't instantiate 0-bit templates.
+			interpolatePalette<2>(pal, ep32[0], ep32[1]);
+			interpolatePalette<2>(pal_a, ep32[0], ep32[1]);
+			decodeIndexes<2>(idx, lsb, anchorMask);
+			decodeIndexes<2>(idx_a, lsb >> 31, anchorMask);
+		}
+
+		for (unsigned int i = 0; i < 16; i++) {
+			tileBuf[i] = (pal[idx[i]] & 0x00FFFFFF) | (pal_a[idx_a[i]] & 0xFF000000);
+		}
+		rotateComponents(tileBuf, rotation_mode);
+		return;
+	}
+
+	// Shared color and alpha indexes.
+	// One palette is interpolated per subset.
+	uint32_t pal[M::SubsetCount][1U << M::IndexBits];
+	for (unsigned int s = 0; s < M::SubsetCount; s++) {
+		interpolatePalette<M::IndexBits>(pal[s], ep32[s*2], ep32[s*2+1]);
+	}
+	decodeIndexes<M::IndexBits>(idx, lsb, anchorMask);
+
+	if (M::SubsetCount == 1) {
+		for (unsigned int i = 0; i < 16; i++) {
+			tileBuf[i] = pal[0][idx[i]];
+		}
+	} else {
+		for (unsigned int i = 0; i < 16; i++, subset >>= 2) {
+			assert((subset & 3) < M::SubsetCount);
+			tileBuf[i] = pal[subset & 3][idx[i]];
+		}
+	}
+}
+
+/**
+ * Get the mode number.
+ * The mode number is the position of the lowest set bit.
+ * @param byte0 First byte of the block.
+ * @return Mode number, or -1 if invalid.
+ */
+static inline int get_mode(uint8_t byte0)
+{
+	// Lowest set bit in a nybble. (0 is invalid)
+	static const int8_t lowest_bit[16] = {-1, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
+	if (byte0 & 0x0F) {
+		return lowest_bit[byte0 & 0x0F];
+	} else if (byte0 != 0) {
+		return 4 + lowest_bit[byte0 >> 4];
+	}
+
+	// Invalid mode.
+	assert(!"BC7 block has an invalid mode.");
+	return -1;
+}
+
+// Block decoding functions, indexed by mode number.
+typedef void (*DecodeBlockFn)(uint32_t tileBuf[16], uint64_t lsb, uint64_t msb);
+static const DecodeBlockFn decodeBlockFns[8] = {
+	decodeBlock<0>, decodeBlock<1>, decodeBlock<2>, decodeBlock<3>,
+	decodeBlock<4>, decodeBlock<5>, decodeBlock<6>, decodeBlock<7>,
+};
+
 /**
  * Convert a BC7 image to rp_image.
  * @param width Image width.
@@ -248,6 +514,7 @@ static FORCEINLINE void rshift128(uint64_t &msb, uint64_t &lsb, unsigned int sha
 rp_image *fromBC7(int width, int height,
 	const uint8_t *img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -270,6 +537,13 @@ rp_image *fromBC7(int width, int height,
 	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::BC7, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -288,397 +562,43 @@ rp_image *fromBC7(int width, int height,
 	// block format we have is 128-bit little-endian, which will be
 	// represented as two uint64_t values, which will be shifted
 	// as each component is processed.
-	// TODO: Optimize by using fewer shifts?
-	const uint64_t *bc7_src = reinterpret_cast<const uint64_t*>(img_buf);
-
-	// Temporary tile buffer.
-	ALIGNED_VAR(16, argb32_t tileBuf[4*4]);
-
-	// Anchor indexes.
-	// Subset 0 is always anchored at 0.
-	// Other subsets depend on subset count and partition number.
-	// NOTE: Index 3 is invalid. It's present here for alignment
-	// and because the subset index is 2-bit.
-	uint8_t anchor_index[4];
-	anchor_index[0] = 0;
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, bc7_src += 2) {
-		/** BEGIN: Temporary values. **/
-
-		// Endpoints.
-		// - [8]: Individual endpoints.
-		// - [4]: RGBx components. (idx3 is unused)
-		// NOTE: Endpoints 6 and 7 are never used.
-		// They're kept here because the subset index is 2-bit.
-		union {
-			uint8_t   u8[8][4];
-			uint32_t u32[8];
-		} endpoints;
-
-		// Alpha components.
-		// If no alpha is present, this will be 255.
-		// For modes with alpha components, there is always
-		// one alpha channel per endpoint.
-		uint8_t alpha[4];
-
-		/** END: Temporary values. **/
-
-		// TODO: Make sure this is correct on big-endian.
-		uint64_t lsb = le64_to_cpu(bc7_src[0]);
-		uint64_t msb = le64_to_cpu(bc7_src[1]);
-
-		// Check the block mode.
-		const int mode = get_mode(static_cast<uint32_t>(lsb));
-		if (mode < 0) {
-			// Invalid mode.
-			img->unref();
-			return nullptr;
-		}
-		rshift128(msb, lsb, mode+1);
-
-		// Rotation mode.
-		// Only present in modes 4 and 5.
-		// For all other modes, this is assumed to be 00.
-		// - 00: ARGB - no swapping
-		// - 01: RAGB - swap A and R
-		// - 10: GRAB - swap A and G
-		// - 11: BRGA - swap A and B
-		uint8_t rotation_mode;
-		if (mode == 4 || mode == 5) {
-			rotation_mode = lsb & 3;
-			rshift128(msb, lsb, 2);
-		} else {
-			// No rotation.
-			rotation_mode = 0;
-		}
-
-		// Index mode selector. (Mode 4 only)
-		uint8_t idxMode_m4 = 0;
-		if (mode == 4) {
-			// Mode 4 has both 2-bit and 3-bit selectors.
-			// The index selection bit determines which is used for
-			// color data and which is used for alpha data:
-			// - idxMode_m4 == 0: Color == 2-bit, Alpha == 3-bit
-			// - idxMode_m4 == 1: Color == 3-bit, Alpha == 2-bit
-			idxMode_m4 = lsb & 1;
-			rshift128(msb, lsb, 1);
-		}
-
-		// Subset/partition.
-		static const uint8_t SubsetCount[8] = {3, 2, 3, 2, 1, 1, 1, 2};
-		static const uint8_t PartitionBits[8] = {4, 6, 6, 6, 0, 0, 0, 6};
-		uint32_t subset = 0;
-		uint8_t partition = 0;
-		if (PartitionBits[mode] != 0) {
-			partition = lsb & ((1U << PartitionBits[mode]) - 1);
-			rshift128(msb, lsb, PartitionBits[mode]);
-
-			// Determine the subset to use.
-			switch (SubsetCount[mode]) {
-				default:
-				case 1:
-					// One subset.
-					subset = 0;
-					break;
-				case 2:
-					// Two subsets.
-					subset = bc7_2sub[partition];
-					break;
-				case 3:
-					// Three subsets.
-					subset = bc7_3sub[partition];
-					break;
-			}
-		} else {
-			// No subsets/partitions.
-			subset = 0;
-		}
-
-		// Number of endpoints.
-		static const uint8_t EndpointCount[8] = {6, 4, 6, 4, 2, 2, 2, 4};
-		// Bits per endpoint component.
-		static const uint8_t EndpointBits[8] = {4, 6, 5, 7, 5, 7, 7, 5};
-
-		// Extract and extend the components.
-		// NOTE: Components are stored in RRRR/GGGG/BBBB/AAAA order.
-		// Needs to be shuffled for RGBA.
-		uint8_t endpoint_bits = EndpointBits[mode];
-		const uint8_t endpoint_count = EndpointCount[mode];
-		const uint8_t endpoint_mask = (1U << endpoint_bits) - 1;
-		const uint8_t endpoint_shamt = 8U - endpoint_bits;
-		const unsigned int component_count = endpoint_count * 3;
-		uint8_t ep_idx = 0, comp_idx = 0;
-		for (unsigned int i = 0; i < component_count; i++) {
-			endpoints.u8[ep_idx][comp_idx] = (lsb & endpoint_mask) << endpoint_shamt;
-			ep_idx++;
-			if (ep_idx == endpoint_count) {
-				// Next component.
-				comp_idx++;
-				ep_idx = 0;
-			}
-
-			// Shift the data over.
-			rshift128(msb, lsb, endpoint_bits);
-		}
-
-		// Do we have alpha components?
-		static const uint8_t AlphaBits[8] = {0, 0, 0, 0, 6, 8, 7, 5};
-		uint8_t alpha_bits = AlphaBits[mode];
-		if (alpha_bits != 0) {
-			// We have alpha components.
-			// TODO: Might not actually be alpha if rotation is enabled...
-			// TODO: Or, rotation might enable alpha...
-			const uint8_t alpha_mask = (1U << alpha_bits) - 1;
-			const uint8_t alpha_shamt = 8U - alpha_bits;
-			for (unsigned int i = 0; i < endpoint_count; i++) {
-				alpha[i] = (lsb & alpha_mask) << alpha_shamt;
-				rshift128(msb, lsb, alpha_bits);
-			}
-		} else {
-			// No alpha. Use 255.
-			alpha[0] = 255;
-			alpha[1] = 255;
-			alpha[2] = 255;
-			alpha[3] = 255;
-		}
-
-		// P-bits.
-		// NOTE: These are applied per subset.
-		// The P-bit count is needed here in order to determine the
-		// shift amount for the endpoints and alpha values.
-		static const uint8_t PBitCount[8] = {1, 1, 0, 1, 0, 0, 1, 1};
-		if (PBitCount[mode] != 0) {
-			// Optimization to avoid having to shift the
-			// whole 64-bit and/or 128-bit value multiple times.
-			unsigned int lsb8 = (lsb & 0xFF);
-			if (mode == 1) {
-				// Mode 1: Two P-bits for four endpoints.
-
-				// Subset 0
-				if (lsb & 1) {
-					endpoints.u32[0] |= 0x02020202;
-					endpoints.u32[1] |= 0x02020202;
-				}
-
-				// Subset 1
-				if (lsb & 2) {
-					endpoints.u32[2] |= 0x02020202;
-					endpoints.u32[3] |= 0x02020202;
-				}
-
-				rshift128(msb, lsb, 2);
-			} else {
-				// Other modes: Unique P-bit for each endpoint.
-				const uint8_t p_ep_shamt = 7 - endpoint_bits;
-				for (unsigned int i = 0; i < endpoint_count; i++, lsb8 >>= 1) {
-					if (lsb8 & 1) {
-						endpoints.u32[i] |= (0x01010101 << p_ep_shamt);
-					}
-				}
-
-				if (alpha_bits > 0) {
-					// Apply P-bits to the alpha components.
-					assert(endpoint_count <= ARRAY_SIZE(alpha));
-					const uint8_t p_a_shamt = 7 - alpha_bits;
-					lsb8 = (lsb & 0xFF);
-					for (unsigned int i = 0; i < endpoint_count; i++, lsb8 >>= 1) {
-						alpha[i] |= (lsb8 & 1) << p_a_shamt;
-					}
-
-					// Increment the alpha bits to indicate how many bits
-					// need to be copied when expanding the color value.
-					alpha_bits++;
-				}
+	// Each mode has its own decoding function, specialized using
+	// the mode properties in BC7Mode<>.
+	const uint64_t *const bc7_src_start = reinterpret_cast<const uint64_t*>(img_buf);
 
-				rshift128(msb, lsb, endpoint_count);
-			}
-
-			// Increment the endpoint bits to indicate how many bits
-			// need to be copied when expanding the color value.
-			endpoint_bits++;
-		}
-
-		// Expand the endpoints and alpha components.
-		if (endpoint_bits < 8) {
-			for (unsigned int i = 0; i < endpoint_count; i++) {
-				endpoints.u8[i][0] = endpoints.u8[i][0] | (endpoints.u8[i][0] >> endpoint_bits);
-				endpoints.u8[i][1] = endpoints.u8[i][1] | (endpoints.u8[i][1] >> endpoint_bits);
-				endpoints.u8[i][2] = endpoints.u8[i][2] | (endpoints.u8[i][2] >> endpoint_bits);
-			}
-		}
-		if (alpha_bits != 0 && alpha_bits < 8) {
-			for (unsigned int i = 0; i < endpoint_count; i++) {
-				alpha[i] = alpha[i] | (alpha[i] >> alpha_bits);
-			}
-		}
-
-		// Bits per index. (either 2 or 3)
-		// NOTE: Most modes don't have the full 32-bit or 48-bit
-		// index table. Missing bits are assumed to be 0.
-		static const uint8_t IndexBits[8] = {3, 3, 2, 2, 0, 2, 4, 2};
-		unsigned int index_bits = IndexBits[mode];
-
-		// At this point, the only remaining data is indexes,
-		// which fits entirely into LSB. Hence, we can stop
-		// using rshift128().
-
-		// EXCEPTION: Mode 4 has both 2-bit *and* 3-bit indexes.
-		// Depending on idxMode_m4, we have to use one or the other.
-		uint64_t idxData;
-		uint8_t index_mask;
-		if (mode == 4) {
-			// Load the color indexes.
-			if (idxMode_m4) {
-				// idxMode is set: Color data uses the 3-bit indexes.
-				// NOTE: We've already shifted by 50 bits by now, so the
-				// MSB contains the high 14 bits of the index data, and
-				// the LSB contains the low 33 bits of the index data.
-				idxData = (msb << 33) | (lsb >> 31);
-				index_bits = 3;
-				index_mask = (1U << 3) - 1;
-			} else {
-				// idxMode is not set: Color data uses the 2-bit indexes.
-				idxData = lsb & ((1U << 31) - 1);
-				index_bits = 2;
-				index_mask = (1U << 2) - 1;
-			}
-		} else {
-			// Use the LSB indexes as-is.
-			idxData = lsb;
-			index_mask = (1U << index_bits) - 1;
-		}
-
-		// Get the anchor indexes.
-		const uint8_t subset_count = SubsetCount[mode];
-		for (unsigned int i = 1; i < subset_count; i++) {
-			anchor_index[i] = getAnchorIndex(partition, i, subset_count);
-		}
-
-		// Process the index data for the color components.
-		uint32_t subsetData = subset;
-		for (unsigned int i = 0; i < 16; i++, subsetData >>= 2) {
-			const uint8_t subset_idx = subsetData & 3;
-			assert(subset_idx != 3);
-			uint8_t data_idx;
-			if (i == anchor_index[subset_idx]) {
-				// This is an anchor index.
-				// Highest bit is 0.
-				data_idx = idxData & (index_mask >> 1);
-				idxData >>= (index_bits - 1);
-			} else {
-				// Regular index.
-				data_idx = idxData & index_mask;
-				idxData >>= index_bits;
-			}
-
-			const uint8_t ep_idx = subset_idx * 2;
-			tileBuf[i].r = interpolate_component(index_bits, data_idx, endpoints.u8[ep_idx][0], endpoints.u8[ep_idx+1][0]);
-			tileBuf[i].g = interpolate_component(index_bits, data_idx, endpoints.u8[ep_idx][1], endpoints.u8[ep_idx+1][1]);
-			tileBuf[i].b = interpolate_component(index_bits, data_idx, endpoints.u8[ep_idx][2], endpoints.u8[ep_idx+1][2]);
-		}
-
-		// Alpha handling.
-		if (mode == 4) {
-			// Mode 4: Alpha indexes are present.
-			// Load the appropriate indexes based on idxMode.
-			uint8_t index_bits, index_mask;
-			if (idxMode_m4) {
-				// idxMode is set: Alpha data uses the 2-bit indexes.
-				idxData = lsb & ((1U << 31) - 1);
-				index_bits = 2;
-				index_mask = (1U << 2) - 1;
-			} else {
-				// idxMode is not set: Alpha data uses the 3-bit indexes.
-				// NOTE: We've already shifted by 50 bits by now, so the
-				// MSB contains the high 14 bits of the index data, and
-				// the LSB contains the low 33 bits of the index data.
-				idxData = (msb << 33) | (lsb >> 31);
-				index_bits = 3;
-				index_mask = (1U << 3) - 1;
-			}
-
-			subsetData = subset;
-			for (unsigned int i = 0; i < 16; i++, subsetData >>= 2) {
-				const uint8_t subset_idx = subsetData & 3;
-				uint8_t data_idx;
-				if (i == anchor_index[subset_idx]) {
-					// This is an anchor index.
-					// Highest bit is 0.
-					data_idx = idxData & (index_mask >> 1);
-					idxData >>= (index_bits - 1);
-				}
-				else {
-					// Regular index.
-					data_idx = idxData & index_mask;
-					idxData >>= index_bits;
-				}
-
-				tileBuf[i].a = interpolate_component(index_bits, data_idx, alpha[0], alpha[1]);
-			}
-		} else if (alpha_bits == 0) {
-			// No alpha. Assume 255.
-			for (unsigned int i = 0; i < 16; i++) {
-				tileBuf[i].a = 255;
-			}
-		} else {
-			// Process alpha using the index data.
-			if (mode == 5) {
-				// Mode 5: Separate alpha indexes, stored after the color indexes.
-				idxData = lsb >> 31;
-			} else {
-				// Other modes: Same indexes as color data.
-				idxData = lsb;
-			}
-			subsetData = subset;
-			for (unsigned int i = 0; i < 16; i++, subsetData >>= 2) {
-				const uint8_t subset_idx = subsetData & 3;
-				uint8_t data_idx;
-				if (i == anchor_index[subset_idx]) {
-					// This is an anchor index.
-					// Highest bit is 0.
-					data_idx = idxData & (index_mask >> 1);
-					idxData >>= (index_bits - 1);
-				} else {
-					// Regular index.
-					data_idx = idxData & index_mask;
-					idxData >>= index_bits;
-				}
-
-				const uint8_t ep_idx = subset_idx * 2;
-				tileBuf[i].a = interpolate_component(index_bits, data_idx, alpha[ep_idx], alpha[ep_idx+1]);
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		ALIGNED_VAR(16, uint32_t tileBuf[4*4]);
+
+		const uint64_t *bc7_src = &bc7_src_start[yStart * tilesX * 2];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, bc7_src += 2) {
+			// TODO: Make sure this is correct on big-endian.
+			const uint64_t lsb = le64_to_cpu(bc7_src[0]);
+			const uint64_t msb = le64_to_cpu(bc7_src[1]);
+
+			// Check the block mode.
+			const int mode = get_mode(static_cast<uint8_t>(lsb));
+			if (mode < 0) {
+				// Invalid mode.
+				return false;
 			}
-		}
+			decodeBlockFns[mode](tileBuf, lsb, msb);
 
-		// Component rotation.
-		switch (rotation_mode & 3) {
-			case 0:
-				// ARGB: No rotation.
-				break;
-			case 1:
-				// RAGB: Swap A and R.
-				for (unsigned int i = 0; i < 16; i++) {
-					std::swap(tileBuf[i].a, tileBuf[i].r);
-				}
-				break;
-			case 2:
-				// GRAB: Swap A and G.
-				for (unsigned int i = 0; i < 16; i++) {
-					std::swap(tileBuf[i].a, tileBuf[i].g);
-				}
-				break;
-			case 3:
-				// BRGA: Swap A and B.
-				for (unsigned int i = 0; i < 16; i++) {
-					std::swap(tileBuf[i].a, tileBuf[i].b);
-				}
-				break;
-		}
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img,
-			reinterpret_cast<const uint32_t*>(&tileBuf[0]), x, y);
-	} }
+	if (!ok) {
+		// Invalid block mode, or decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
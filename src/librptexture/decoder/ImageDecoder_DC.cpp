@@ -59,6 +59,53 @@ static FORCEINLINE void initDreamcastTwiddleMap(void)
 	pthread_once(&once_control, initDreamcastTwiddleMap_int);
 }
 
+/**
+ * Decode a Dreamcast square twiddled 16-bit image.
+ *
+ * The twiddled index of pixel (x, y) is the interleaved bits of
+ * x and y, with y in the low bit. For even x and y, this means
+ * that (x, y), (x, y+1), (x+1, y), and (x+1, y+1) are four
+ * consecutive source pixels, so even-sized images are decoded
+ * two rows at a time, one 2x2 block per twiddle map lookup.
+ *
+ * @tparam cvt Pixel conversion function.
+ * @param px_dest	[out] ARGB32 image data.
+ * @param dest_stride	[in] Destination stride, in pixels.
+ * @param width		[in] Image width. (Also the height.)
+ * @param img_buf	[in] 16-bit image buffer.
+ */
+template<uint32_t (*cvt)(uint16_t)>
+static inline void decodeSquareTwiddled16(uint32_t *RESTRICT px_dest, int dest_stride,
+	int width, const uint16_t *RESTRICT img_buf)
+{
+	const unsigned int w = static_cast<unsigned int>(width);
+
+	if (w & 1) {
+		// Odd size. Decode one pixel at a time.
+		for (unsigned int y = 0; y < w; y++, px_dest += dest_stride) {
+			const unsigned int tY = dc_tmap[y];
+			for (unsigned int x = 0; x < w; x++) {
+				px_dest[x] = cvt(le16_to_cpu(img_buf[(dc_tmap[x] << 1) | tY]));
+			}
+		}
+		return;
+	}
+
+	for (unsigned int y = 0; y < w; y += 2, px_dest += (dest_stride * 2)) {
+		// dc_tmap[y] for even y == dc_tmap[y/2] << 2
+		const unsigned int tY = dc_tmap[y >> 1] << 2;
+		uint32_t *const row0 = px_dest;
+		uint32_t *const row1 = px_dest + dest_stride;
+		for (unsigned int x = 0; x < w; x += 2) {
+			const uint16_t *const src = &img_buf[(dc_tmap[x >> 1] << 3) | tY];
+			row0[x+0] = cvt(le16_to_cpu(src[0]));
+			row1[x+0] = cvt(le16_to_cpu(src[1]));
+			row0[x+1] = cvt(le16_to_cpu(src[2]));
+			row1[x+1] = cvt(le16_to_cpu(src[3]));
+		}
+	}
+}
+
 /**
  * Convert a Dreamcast square twiddled 16-bit image to rp_image.
  * @param px_format 16-bit pixel format.
@@ -72,6 +119,7 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -97,19 +145,12 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		return nullptr;
 	}
 
-	// Convert one line at a time. (16-bit -> ARGB32)
-	uint32_t *px_dest = static_cast<uint32_t*>(img->bits());
-	const int dest_stride_adj = (img->stride() / sizeof(uint32_t)) - img->width();
+	// Convert the image. (16-bit -> ARGB32)
+	uint32_t *const px_dest = static_cast<uint32_t*>(img->bits());
+	const int dest_stride = img->stride() / sizeof(uint32_t);
 	switch (px_format) {
 		case PXF_ARGB1555: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = ARGB1555_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			decodeSquareTwiddled16<ARGB1555_to_ARGB32>(px_dest, dest_stride, width, img_buf);
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {5,5,5,0,1};
 			img->set_sBIT(&sBIT);
@@ -117,14 +158,7 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		}
 
 		case PXF_RGB565: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = RGB565_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			decodeSquareTwiddled16<RGB565_to_ARGB32>(px_dest, dest_stride, width, img_buf);
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {5,6,5,0,0};
 			img->set_sBIT(&sBIT);
@@ -132,14 +166,7 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		}
 
 		case PXF_ARGB4444: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = ARGB4444_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			decodeSquareTwiddled16<ARGB4444_to_ARGB32>(px_dest, dest_stride, width, img_buf);
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {4,4,4,0,4};
 			img->set_sBIT(&sBIT);
@@ -175,6 +202,7 @@ rp_image *fromDreamcastVQ16(PixelFormat px_format,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const uint16_t *RESTRICT pal_buf, int pal_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -270,8 +298,9 @@ rp_image *fromDreamcastVQ16(PixelFormat px_format,
 	const int dest_stride = (img->stride() / sizeof(uint32_t));
 	const int dest_stride_adj = dest_stride + dest_stride - img->width();
 	for (unsigned int y = 0; y < static_cast<unsigned int>(height); y += 2, px_dest += dest_stride_adj) {
+	const unsigned int tY = dc_tmap[y >> 1];
 	for (unsigned int x = 0; x < static_cast<unsigned int>(width); x += 2, px_dest += 2) {
-		const unsigned int srcIdx = ((dc_tmap[x >> 1] << 1) | dc_tmap[y >> 1]);
+		const unsigned int srcIdx = ((dc_tmap[x >> 1] << 1) | tY);
 		assert(srcIdx < (unsigned int)img_siz);
 		if (srcIdx >= static_cast<unsigned int>(img_siz)) {
 			// Out of bounds.
@@ -609,6 +609,7 @@ static void decodeBlock_ETC_RGB(uint32_t tileBuf[4*4], const etc1_block *etc1_sr
 rp_image *fromETC1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -626,6 +627,13 @@ rp_image *fromETC1(int width, int height,
 	if (width % 4 != 0 || height % 4 != 0)
 		return nullptr;
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::ETC1, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -634,23 +642,36 @@ rp_image *fromETC1(int width, int height,
 		return nullptr;
 	}
 
-	const etc1_block *etc1_src = reinterpret_cast<const etc1_block*>(img_buf);
+	const etc1_block *const etc1_src_start = reinterpret_cast<const etc1_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, etc1_src++) {
-		// Decode the ETC1 RGB block.
-		decodeBlock_ETC_RGB<ETC_DM_ETC1>(tileBuf, etc1_src);
-
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
+
+		const etc1_block *etc1_src = &etc1_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, etc1_src++) {
+			// Decode the ETC1 RGB block.
+			decodeBlock_ETC_RGB<ETC_DM_ETC1>(tileBuf, etc1_src);
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	// Set the sBIT metadata.
 	static const rp_image::sBIT_t sBIT = {8,8,8,0,0};
@@ -671,6 +692,7 @@ rp_image *fromETC1(int width, int height,
 rp_image *fromETC2_RGB(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -688,6 +710,13 @@ rp_image *fromETC2_RGB(int width, int height,
 	if (width % 4 != 0 || height % 4 != 0)
 		return nullptr;
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::ETC2_RGB, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -696,23 +725,36 @@ rp_image *fromETC2_RGB(int width, int height,
 		return nullptr;
 	}
 
-	const etc1_block *etc1_src = reinterpret_cast<const etc1_block*>(img_buf);
+	const etc1_block *const etc1_src_start = reinterpret_cast<const etc1_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, etc1_src++) {
-		// Decode the ETC2 RGB block.
-		decodeBlock_ETC_RGB<ETC_DM_ETC2>(tileBuf, etc1_src);
-
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
+
+		const etc1_block *etc1_src = &etc1_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, etc1_src++) {
+			// Decode the ETC2 RGB block.
+			decodeBlock_ETC_RGB<ETC_DM_ETC2>(tileBuf, etc1_src);
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	// Set the sBIT metadata.
 	static const rp_image::sBIT_t sBIT = {8,8,8,0,0};
@@ -773,6 +815,7 @@ static void decodeBlock_ETC2_alpha(uint32_t tileBuf[4*4], const etc2_alpha *alph
 rp_image *fromETC2_RGBA(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -790,6 +833,13 @@ rp_image *fromETC2_RGBA(int width, int height,
 	if (width % 4 != 0 || height % 4 != 0)
 		return nullptr;
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::ETC2_RGBA, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -798,27 +848,40 @@ rp_image *fromETC2_RGBA(int width, int height,
 		return nullptr;
 	}
 
-	const etc2_rgba_block *etc2_src = reinterpret_cast<const etc2_rgba_block*>(img_buf);
+	const etc2_rgba_block *const etc2_src_start = reinterpret_cast<const etc2_rgba_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, etc2_src++) {
-		// Decode the ETC2 RGB block.
-		decodeBlock_ETC_RGB<ETC_DM_ETC2>(tileBuf, &etc2_src->etc1);
-
-		// Decode the ETC2 alpha block.
-		// TODO: Don't fill in the alpha channel in decodeBlock_ETC2_RGB()?
-		decodeBlock_ETC2_alpha(tileBuf, &etc2_src->alpha);
-
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
+
+		const etc2_rgba_block *etc2_src = &etc2_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, etc2_src++) {
+			// Decode the ETC2 RGB block.
+			decodeBlock_ETC_RGB<ETC_DM_ETC2>(tileBuf, &etc2_src->etc1);
+
+			// Decode the ETC2 alpha block.
+			// TODO: Don't fill in the alpha channel in decodeBlock_ETC2_RGB()?
+			decodeBlock_ETC2_alpha(tileBuf, &etc2_src->alpha);
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	// Set the sBIT metadata.
 	static const rp_image::sBIT_t sBIT = {8,8,8,0,8};
@@ -839,6 +902,7 @@ rp_image *fromETC2_RGBA(int width, int height,
 rp_image *fromETC2_RGB_A1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -856,6 +920,13 @@ rp_image *fromETC2_RGB_A1(int width, int height,
 	if (width % 4 != 0 || height % 4 != 0)
 		return nullptr;
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::ETC2_RGB_A1, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -864,23 +935,36 @@ rp_image *fromETC2_RGB_A1(int width, int height,
 		return nullptr;
 	}
 
-	const etc1_block *etc1_src = reinterpret_cast<const etc1_block*>(img_buf);
+	const etc1_block *const etc1_src_start = reinterpret_cast<const etc1_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, etc1_src++) {
-		// Decode the ETC2 RGB block.
-		decodeBlock_ETC_RGB<ETC_DM_ETC2 | ETC2_DM_A1>(tileBuf, etc1_src);
-
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
+
+		const etc1_block *etc1_src = &etc1_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, etc1_src++) {
+			// Decode the ETC2 RGB block.
+			decodeBlock_ETC_RGB<ETC_DM_ETC2 | ETC2_DM_A1>(tileBuf, etc1_src);
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	// Set the sBIT metadata.
 	static const rp_image::sBIT_t sBIT = {8,8,8,0,1};
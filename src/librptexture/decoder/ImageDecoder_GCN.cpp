@@ -17,6 +17,7 @@ namespace LibRpTexture { namespace ImageDecoder {
 
 /**
  * Convert a GameCube 16-bit image to rp_image.
+ * Standard version using regular C++ code.
  * @param px_format 16-bit pixel format.
  * @param width Image width.
  * @param height Image height.
@@ -24,10 +25,11 @@ namespace LibRpTexture { namespace ImageDecoder {
  * @param img_siz Size of image data. [must be >= (w*h)*2]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromGcn16(PixelFormat px_format,
+rp_image *fromGcn16_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -150,6 +152,7 @@ rp_image *fromGcnCI8(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const uint16_t *RESTRICT pal_buf, int pal_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -242,6 +245,7 @@ rp_image *fromGcnCI8(int width, int height,
 rp_image *fromGcnI8(int width, int height,
 	const uint8_t *img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -0,0 +1,248 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_GCN.cpp: Image decoding functions. (GameCube)              *
+ * SSE2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageDecoder.hpp"
+#include "ImageDecoder_p.hpp"
+
+// SSE2 intrinsics.
+#include <emmintrin.h>
+
+// MSVC complains when the high bit is set in hex values
+// when setting SSE2 registers.
+#ifdef _MSC_VER
+# pragma warning(push)
+# pragma warning(disable: 4309)
+#endif
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/**
+ * Byteswap 8 big-endian 16-bit pixels to host-endian.
+ * @param src Big-endian pixels.
+ * @return Host-endian pixels.
+ */
+static inline __m128i be16_to_cpu_sse2(const __m128i &src)
+{
+	return _mm_or_si128(_mm_slli_epi16(src, 8), _mm_srli_epi16(src, 8));
+}
+
+/**
+ * Convert 8 big-endian RGB5A3 pixels to ARGB32 using SSE2.
+ *
+ * Both the RGB555 and the RGB4A3 conversions are calculated,
+ * and the high bit of each pixel selects the result.
+ *
+ * @param src	[in] Big-endian RGB5A3 pixels.
+ * @param px0	[out] ARGB32 pixels 0-3.
+ * @param px1	[out] ARGB32 pixels 4-7.
+ */
+static inline void RGB5A3_to_ARGB32_sse2(const __m128i &src, __m128i &px0, __m128i &px1)
+{
+	const __m128i s = be16_to_cpu_sse2(src);
+
+	// RGB555: High bit is set.
+	// Blue and red are 5-bit to 8-bit in the low byte;
+	// green is 5-bit to 8-bit in the high byte.
+	__m128i sB5 = _mm_slli_epi16(_mm_and_si128(s, _mm_set1_epi16(0x001F)), 3);
+	sB5 = _mm_or_si128(sB5, _mm_srli_epi16(sB5, 5));
+	__m128i sG5 = _mm_slli_epi16(_mm_and_si128(s, _mm_set1_epi16(0x03E0)), 6);
+	sG5 = _mm_or_si128(sG5, _mm_and_si128(_mm_srli_epi16(sG5, 5), _mm_set1_epi16(0x0700)));
+	__m128i sR5 = _mm_srli_epi16(_mm_and_si128(s, _mm_set1_epi16(0x7C00)), 7);
+	sR5 = _mm_or_si128(sR5, _mm_srli_epi16(sR5, 5));
+	const __m128i sGB5 = _mm_or_si128(sG5, sB5);
+	const __m128i sAR5 = _mm_or_si128(sR5, _mm_set1_epi16(0xFF00));
+
+	// RGB4A3: High bit is clear.
+	// Each 4-bit channel is duplicated into both nybbles.
+	// The 3-bit alpha is expanded by bit replication, which
+	// matches PixelConversion's a3_lookup[] table.
+	__m128i sB4 = _mm_and_si128(s, _mm_set1_epi16(0x000F));
+	sB4 = _mm_or_si128(sB4, _mm_slli_epi16(sB4, 4));
+	const __m128i sG4 = _mm_and_si128(s, _mm_set1_epi16(0x00F0));
+	const __m128i sG4x = _mm_or_si128(_mm_slli_epi16(sG4, 4), _mm_slli_epi16(sG4, 8));
+	__m128i sR4 = _mm_srli_epi16(_mm_and_si128(s, _mm_set1_epi16(0x0F00)), 8);
+	sR4 = _mm_or_si128(sR4, _mm_slli_epi16(sR4, 4));
+	const __m128i sA3 = _mm_and_si128(_mm_srli_epi16(s, 12), _mm_set1_epi16(0x0007));
+	__m128i sA4 = _mm_or_si128(_mm_slli_epi16(sA3, 5), _mm_slli_epi16(sA3, 2));
+	sA4 = _mm_slli_epi16(_mm_or_si128(sA4, _mm_srli_epi16(sA3, 1)), 8);
+	const __m128i sGB4 = _mm_or_si128(sG4x, sB4);
+	const __m128i sAR4 = _mm_or_si128(sA4, sR4);
+
+	// Select the result using the high bit.
+	const __m128i mode = _mm_srai_epi16(s, 15);
+	const __m128i sGB = _mm_or_si128(_mm_and_si128(mode, sGB5), _mm_andnot_si128(mode, sGB4));
+	const __m128i sAR = _mm_or_si128(_mm_and_si128(mode, sAR5), _mm_andnot_si128(mode, sAR4));
+	px0 = _mm_unpacklo_epi16(sGB, sAR);
+	px1 = _mm_unpackhi_epi16(sGB, sAR);
+}
+
+/**
+ * Convert 8 big-endian RGB565 pixels to ARGB32 using SSE2.
+ * @param src	[in] Big-endian RGB565 pixels.
+ * @param px0	[out] ARGB32 pixels 0-3.
+ * @param px1	[out] ARGB32 pixels 4-7.
+ */
+static inline void RGB565_to_ARGB32_sse2(const __m128i &src, __m128i &px0, __m128i &px1)
+{
+	const __m128i s = be16_to_cpu_sse2(src);
+
+	// Blue: 5-bit to 8-bit, in the low byte.
+	__m128i sB = _mm_slli_epi16(_mm_and_si128(s, _mm_set1_epi16(0x001F)), 3);
+	sB = _mm_or_si128(sB, _mm_srli_epi16(sB, 5));
+
+	// Green: 6-bit to 8-bit, in the high byte.
+	__m128i sG = _mm_slli_epi16(_mm_and_si128(s, _mm_set1_epi16(0x07E0)), 5);
+	sG = _mm_or_si128(sG, _mm_and_si128(_mm_srli_epi16(sG, 6), _mm_set1_epi16(0x0300)));
+
+	// Red: 5-bit to 8-bit, in the low byte.
+	__m128i sR = _mm_srli_epi16(_mm_and_si128(s, _mm_set1_epi16(0xF800)), 8);
+	sR = _mm_or_si128(sR, _mm_srli_epi16(sR, 5));
+
+	const __m128i sGB = _mm_or_si128(sG, sB);
+	const __m128i sAR = _mm_or_si128(sR, _mm_set1_epi16(0xFF00));
+	px0 = _mm_unpacklo_epi16(sGB, sAR);
+	px1 = _mm_unpackhi_epi16(sGB, sAR);
+}
+
+/**
+ * Convert 8 big-endian IA8 pixels to ARGB32 using SSE2.
+ * @param src	[in] Big-endian IA8 pixels.
+ * @param px0	[out] ARGB32 pixels 0-3.
+ * @param px1	[out] ARGB32 pixels 4-7.
+ */
+static inline void IA8_to_ARGB32_sse2(const __m128i &src, __m128i &px0, __m128i &px1)
+{
+	// Big-endian IA8 has I in the low byte and A in the high byte,
+	// which is already the AR word.
+	const __m128i sI = _mm_and_si128(src, _mm_set1_epi16(0x00FF));
+	const __m128i sGB = _mm_or_si128(sI, _mm_slli_epi16(sI, 8));
+	px0 = _mm_unpacklo_epi16(sGB, src);
+	px1 = _mm_unpackhi_epi16(sGB, src);
+}
+
+/**
+ * Decode GameCube 16-bit 4x4 tiles directly into an ARGB32 image.
+ * Each 16-byte load is two tile rows.
+ * @tparam cvt Pixel conversion function.
+ * @param img		[out] ARGB32 image.
+ * @param img_buf	[in] 16-bit image buffer.
+ * @param tilesX	[in] Number of tiles, horizontally.
+ * @param tilesY	[in] Number of tiles, vertically.
+ */
+template<void (*cvt)(const __m128i&, __m128i&, __m128i&)>
+static inline void decodeGcn16Tiles_sse2(rp_image *img,
+	const uint16_t *RESTRICT img_buf,
+	unsigned int tilesX, unsigned int tilesY)
+{
+	const int stride_px = img->stride() / sizeof(uint32_t);
+	const __m128i *pSrc = reinterpret_cast<const __m128i*>(img_buf);
+	uint32_t *pDestRow = static_cast<uint32_t*>(img->bits());
+
+	for (unsigned int y = 0; y < tilesY; y++, pDestRow += (stride_px * 4)) {
+		uint32_t *pDest = pDestRow;
+		for (unsigned int x = 0; x < tilesX; x++, pDest += 4, pSrc += 2) {
+			__m128i px0, px1, px2, px3;
+			cvt(_mm_loadu_si128(&pSrc[0]), px0, px1);
+			cvt(_mm_loadu_si128(&pSrc[1]), px2, px3);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest), px0);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + stride_px), px1);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + (stride_px * 2)), px2);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + (stride_px * 3)), px3);
+		}
+	}
+}
+
+/**
+ * Convert a GameCube 16-bit image to rp_image.
+ * SSE2-optimized version.
+ * @param px_format 16-bit pixel format.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB5A3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromGcn16_sse2(PixelFormat px_format,
+	int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(img_siz >= ((width * height) * 2));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < ((width * height) * 2))
+	{
+		return nullptr;
+	}
+
+	// GameCube RGB5A3 uses 4x4 tiles.
+	assert(width % 4 == 0);
+	assert(height % 4 == 0);
+	if (width % 4 != 0 || height % 4 != 0)
+		return nullptr;
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	// Calculate the total number of tiles.
+	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
+	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
+
+	switch (px_format) {
+		case PXF_RGB5A3: {
+			decodeGcn16Tiles_sse2<RGB5A3_to_ARGB32_sse2>(img, img_buf, tilesX, tilesY);
+			// Set the sBIT metadata.
+			// NOTE: Pixels may be RGB555 or ARGB4444.
+			// We'll use 555 for RGB, and 4 for alpha.
+			static const rp_image::sBIT_t sBIT = {5,5,5,0,4};
+			img->set_sBIT(&sBIT);
+			break;
+		}
+
+		case PXF_RGB565: {
+			decodeGcn16Tiles_sse2<RGB565_to_ARGB32_sse2>(img, img_buf, tilesX, tilesY);
+			// Set the sBIT metadata.
+			static const rp_image::sBIT_t sBIT = {5,6,5,0,0};
+			img->set_sBIT(&sBIT);
+			break;
+		}
+
+		case PXF_IA8: {
+			decodeGcn16Tiles_sse2<IA8_to_ARGB32_sse2>(img, img_buf, tilesX, tilesY);
+			// Set the sBIT metadata.
+			static const rp_image::sBIT_t sBIT = {8,8,8,8,8};
+			img->set_sBIT(&sBIT);
+			break;
+		}
+
+		default:
+			assert(!"Invalid pixel format for this function.");
+			img->unref();
+			return nullptr;
+	}
+
+	// Image has been converted.
+	return img;
+}
+
+} }
+
+#ifdef _MSC_VER
+# pragma warning(pop)
+#endif
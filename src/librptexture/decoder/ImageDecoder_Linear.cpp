@@ -14,6 +14,9 @@
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
 
+// One-time initialization.
+#include "librpthreads/pthread_once.h"
+
 namespace LibRpTexture { namespace ImageDecoder {
 
 /**
@@ -33,6 +36,7 @@ rp_image *fromLinearCI4(PixelFormat px_format, bool msn_left,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const void *RESTRICT pal_buf, int pal_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -272,6 +276,7 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const void *RESTRICT pal_buf, int pal_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -475,6 +480,7 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 rp_image *fromLinearMono(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -549,6 +555,7 @@ rp_image *fromLinear8(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_TRACE_ZONE(__func__);
 	static const int bytespp = 1;
 
 	// Verify parameters.
@@ -631,6 +638,53 @@ rp_image *fromLinear8(PixelFormat px_format,
 	return img;
 }
 
+/**
+ * 16-bit to ARGB32 lookup table.
+ * The table is built the first time it's used.
+ * @tparam cvt Pixel conversion function.
+ */
+template<uint32_t (*cvt)(uint16_t)>
+class Linear16LUT
+{
+	public:
+		/**
+		 * Get the lookup table.
+		 * @return Lookup table. (65,536 entries)
+		 */
+		static FORCEINLINE const uint32_t *get(void)
+		{
+			pthread_once(&once_control, init);
+			return lut;
+		}
+
+	private:
+		/**
+		 * Initialize the lookup table.
+		 * This function MUST be called using pthread_once().
+		 */
+		static void init(void)
+		{
+			for (unsigned int i = 0; i < 65536; i++) {
+				lut[i] = cvt(static_cast<uint16_t>(i));
+			}
+		}
+
+		static uint32_t lut[65536];
+		static pthread_once_t once_control;
+};
+
+template<uint32_t (*cvt)(uint16_t)>
+uint32_t Linear16LUT<cvt>::lut[65536];
+template<uint32_t (*cvt)(uint16_t)>
+pthread_once_t Linear16LUT<cvt>::once_control = PTHREAD_ONCE_INIT;
+
+/**
+ * Minimum number of pixels for fromLinear16_cpp() to use a lookup table.
+ * Building a lookup table takes about as long as converting
+ * 64K pixels using the formats that benefit from it.
+ */
+static const int LINEAR16_LUT_MIN_PIXELS = 256*256;
+
 /**
  * Convert a linear 16-bit RGB image to rp_image.
  * Standard version using regular C++ code.
@@ -646,6 +700,7 @@ rp_image *fromLinear16_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_TRACE_ZONE(__func__);
 	static const int bytespp = 2;
 
 	// Verify parameters.
@@ -674,6 +729,19 @@ rp_image *fromLinear16_cpp(PixelFormat px_format,
 		src_stride_adj = (stride / bytespp) - width;
 	}
 
+	// Formats that use branches or small lookup tables are
+	// faster with a full lookup table on large images.
+	// Other formats are faster with bit math.
+	if ((width * height) >= LINEAR16_LUT_MIN_PIXELS) {
+		switch (px_format) {
+			case PXF_ARGB8332:
+			case PXF_BGR5A3:
+				return fromLinear16_lut(px_format, width, height, img_buf, img_siz, stride);
+			default:
+				break;
+		}
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -746,6 +814,123 @@ rp_image *fromLinear16_cpp(PixelFormat px_format,
 	return img;
 }
 
+/**
+ * Convert a linear 16-bit RGB image to rp_image.
+ * Lookup table version.
+ * @param px_format	[in] 16-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] 16-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*2]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear16_lut(PixelFormat px_format,
+	int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz, int stride)
+{
+	RP_TRACE_ZONE(__func__);
+	static const int bytespp = 2;
+
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(img_siz >= ((width * height) * bytespp));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < ((width * height) * bytespp))
+	{
+		return nullptr;
+	}
+
+	// Stride adjustment.
+	int src_stride_adj = 0;
+	assert(stride >= 0);
+	if (stride > 0) {
+		// Set src_stride_adj to the number of pixels we need to
+		// add to the end of each line to get to the next row.
+		assert(stride % bytespp == 0);
+		assert(stride >= (width * bytespp));
+		if (unlikely(stride % bytespp != 0 || stride < (width * bytespp))) {
+			// Invalid stride.
+			return nullptr;
+		}
+		src_stride_adj = (stride / bytespp) - width;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+	const int dest_stride_adj = (img->stride() / sizeof(argb32_t)) - img->width();
+	uint32_t *px_dest = static_cast<uint32_t*>(img->bits());
+
+#define fromLinear16_lut_convert(fmt, r,g,b,gr,a) \
+		case PXF_##fmt: { \
+			const uint32_t *const lut = Linear16LUT<fmt##_to_ARGB32>::get(); \
+			for (unsigned int y = (unsigned int)height; y > 0; y--) { \
+				for (unsigned int x = (unsigned int)width; x > 0; x--) { \
+					*px_dest = lut[le16_to_cpu(*img_buf)]; \
+					img_buf++; \
+					px_dest++; \
+				} \
+				img_buf += src_stride_adj; \
+				px_dest += dest_stride_adj; \
+			} \
+			/* Set the sBIT data. */ \
+			static const rp_image::sBIT_t sBIT = {r,g,b,gr,a}; \
+			img->set_sBIT(&sBIT); \
+		} break
+
+	// Convert one line at a time. (16-bit -> ARGB32)
+	switch (px_format) {
+		// 16-bit RGB.
+		fromLinear16_lut_convert(RGB565, 5,6,5,0,0);
+		fromLinear16_lut_convert(BGR565, 5,6,5,0,0);
+		fromLinear16_lut_convert(ARGB1555, 5,5,5,0,1);
+		fromLinear16_lut_convert(ABGR1555, 5,5,5,0,1);
+		fromLinear16_lut_convert(RGBA5551, 5,5,5,0,1);
+		fromLinear16_lut_convert(BGRA5551, 5,5,5,0,1);
+		fromLinear16_lut_convert(ARGB4444, 4,4,4,0,4);
+		fromLinear16_lut_convert(ABGR4444, 4,4,4,0,4);
+		fromLinear16_lut_convert(RGBA4444, 4,4,4,0,4);
+		fromLinear16_lut_convert(BGRA4444, 4,4,4,0,4);
+		fromLinear16_lut_convert(xRGB4444, 4,4,4,0,4);
+		fromLinear16_lut_convert(xBGR4444, 4,4,4,0,4);
+		fromLinear16_lut_convert(RGBx4444, 4,4,4,0,4);
+		fromLinear16_lut_convert(BGRx4444, 4,4,4,0,4);
+		fromLinear16_lut_convert(ARGB8332, 3,3,2,0,8);
+
+		// PlayStation 2.
+		fromLinear16_lut_convert(BGR5A3, 5,5,5,0,4);
+
+		// 15-bit RGB.
+		fromLinear16_lut_convert(RGB555, 5,5,5,0,0);
+		fromLinear16_lut_convert(BGR555, 5,5,5,0,0);
+
+		// Luminance.
+		// TODO: 16-bit support. Downconverted to 8 for now.
+		fromLinear16_lut_convert(L16, 8,8,8,8,0);
+		fromLinear16_lut_convert(A8L8, 8,8,8,8,8);
+		fromLinear16_lut_convert(L8A8, 8,8,8,8,8);
+
+		// RG formats.
+		fromLinear16_lut_convert(RG88, 8,8,1,0,0);
+		fromLinear16_lut_convert(GR88, 8,8,1,0,0);
+
+		default:
+			assert(!"Unsupported 16-bit pixel format.");
+			img->unref();
+			return nullptr;
+	}
+
+	// Image has been converted.
+	return img;
+}
+
 /**
  * Convert a linear 24-bit RGB image to rp_image.
  * Standard version using regular C++ code.
@@ -761,6 +946,7 @@ rp_image *fromLinear24_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_TRACE_ZONE(__func__);
 	static const int bytespp = 3;
 
 	// Verify parameters.
@@ -862,6 +1048,7 @@ rp_image *fromLinear32_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint32_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_TRACE_ZONE(__func__);
 	static const int bytespp = 4;
 
 	// Verify parameters.
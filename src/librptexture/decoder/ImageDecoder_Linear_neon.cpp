@@ -0,0 +1,415 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_Linear.cpp: Image decoding functions. (Linear)             *
+ * NEON-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageDecoder.hpp"
+#include "ImageDecoder_p.hpp"
+
+#include "PixelConversion.hpp"
+using namespace LibRpTexture::PixelConversion;
+
+// NEON headers.
+#include <arm_neon.h>
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/**
+ * Convert a linear 24-bit RGB image to rp_image.
+ * NEON-optimized version.
+ * @param px_format	[in] 24-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer. (must be byte-addressable)
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*3]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear24_neon(PixelFormat px_format,
+	int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz, int stride)
+{
+	RP_TRACE_ZONE(__func__);
+	static const int bytespp = 3;
+
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(img_siz >= ((width * height) * bytespp));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < ((width * height) * bytespp))
+	{
+		return nullptr;
+	}
+
+	// Stride adjustment.
+	// NOTE: NEON loads don't require alignment,
+	// so any valid stride can be used here.
+	int src_stride_adj = 0;
+	assert(stride >= 0);
+	if (stride > 0) {
+		// Set src_stride_adj to the number of bytes we need to
+		// add to the end of each line to get to the next row.
+		if (unlikely(stride < (width * bytespp))) {
+			// Invalid stride.
+			return nullptr;
+		}
+		// NOTE: Byte addressing, so keep it in units of bytespp.
+		src_stride_adj = stride - (width * bytespp);
+	}
+
+	// Determine the channel order.
+	// vld3q_u8() deinterleaves the source bytes into
+	// three vectors, which are then reordered for vst4q_u8().
+	unsigned int b_idx, r_idx;
+	switch (px_format) {
+		case PXF_RGB888:
+			b_idx = 0;
+			r_idx = 2;
+			break;
+		case PXF_BGR888:
+			// Swap R and B.
+			b_idx = 2;
+			r_idx = 0;
+			break;
+		default:
+			assert(!"Unsupported 24-bit pixel format.");
+			return nullptr;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+	const int dest_stride_adj = (img->stride() / sizeof(argb32_t)) - img->width();
+	argb32_t *px_dest = static_cast<argb32_t*>(img->bits());
+
+	// 24-bit RGB images don't have an alpha channel.
+	const uint8x16_t alpha = vdupq_n_u8(0xFF);
+	// R/B swap mask. vbslq_u8() is used instead of indexing
+	// uint8x16x3_t::val[] at runtime, which would spill to memory.
+	const uint8x16_t swap_rb = vdupq_n_u8(b_idx != 0 ? 0xFF : 0x00);
+
+	for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
+		// Process 16 pixels per iteration using NEON.
+		unsigned int x = static_cast<unsigned int>(width);
+		for (; x > 15; x -= 16, px_dest += 16, img_buf += 16*3) {
+			const uint8x16x3_t src = vld3q_u8(img_buf);
+			uint8x16x4_t dest;
+			dest.val[0] = vbslq_u8(swap_rb, src.val[2], src.val[0]);
+			dest.val[1] = src.val[1];
+			dest.val[2] = vbslq_u8(swap_rb, src.val[0], src.val[2]);
+			dest.val[3] = alpha;
+			vst4q_u8(reinterpret_cast<uint8_t*>(px_dest), dest);
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, px_dest++, img_buf += 3) {
+			px_dest->b = img_buf[b_idx];
+			px_dest->g = img_buf[1];
+			px_dest->r = img_buf[r_idx];
+			px_dest->a = 0xFF;
+		}
+
+		// Next line.
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+
+	// Set the sBIT metadata.
+	static const rp_image::sBIT_t sBIT = {8,8,8,0,0};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Convert a linear 32-bit RGB image to rp_image.
+ * NEON-optimized version.
+ * @param px_format	[in] 32-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] 32-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*3]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear32_neon(PixelFormat px_format,
+	int width, int height,
+	const uint32_t *RESTRICT img_buf, int img_siz, int stride)
+{
+	RP_TRACE_ZONE(__func__);
+	static const int bytespp = 4;
+
+	// Byte shuffle masks for vqtbl1q_u8().
+	// Out-of-range indexes (0xFF) result in 0.
+	static const uint8_t shuf_HOST_xRGB32[16] = {0,1,2,3, 4,5,6,7, 8,9,10,11, 12,13,14,15};
+	static const uint8_t shuf_HOST_RGBA32[16] = {1,2,3,0, 5,6,7,4, 9,10,11,8, 13,14,15,12};
+	static const uint8_t shuf_SWAP_ARGB32[16] = {3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12};
+	static const uint8_t shuf_SWAP_RGBA32[16] = {2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15};
+	static const uint8_t shuf_G16R16[16] = {0xFF,3,1,0xFF, 0xFF,7,5,0xFF, 0xFF,11,9,0xFF, 0xFF,15,13,0xFF};
+	static const uint8_t shuf_RABG8888[16] = {1,0,3,2, 5,4,7,6, 9,8,11,10, 13,12,15,14};
+
+	// FIXME: Add support for these formats.
+	// For now, redirect back to the C++ version.
+	switch (px_format) {
+		case PXF_A2R10G10B10:
+		case PXF_A2B10G10R10:
+		case PXF_RGB9_E5:
+		case PXF_BGR888_ABGR7888:
+			return fromLinear32_cpp(px_format, width, height, img_buf, img_siz, stride);
+
+		default:
+			break;
+	}
+
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(img_siz >= ((width * height) * bytespp));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < ((width * height) * bytespp))
+	{
+		return nullptr;
+	}
+
+	// Stride adjustment.
+	// NOTE: NEON loads don't require alignment,
+	// so any valid stride can be used here.
+	int src_stride_adj = 0;
+	assert(stride >= 0);
+	if (stride > 0) {
+		// Set src_stride_adj to the number of pixels we need to
+		// add to the end of each line to get to the next row.
+		assert(stride % bytespp == 0);
+		assert(stride >= (width * bytespp));
+		if (unlikely(stride % bytespp != 0 || stride < (width * bytespp))) {
+			// Invalid stride.
+			return nullptr;
+		}
+		src_stride_adj = (stride / bytespp) - width;
+	} else {
+		stride = width * bytespp;
+	}
+
+	// Determine the byte shuffle mask.
+	const uint8_t *shuf;
+	bool has_alpha;
+	switch (px_format) {
+		case PXF_HOST_ARGB32:
+			// Handled below.
+			shuf = nullptr;
+			has_alpha = true;
+			break;
+
+		case PXF_HOST_xRGB32:
+			// TODO: Only apply the alpha mask instead of shuffling.
+			shuf = shuf_HOST_xRGB32;
+			has_alpha = false;
+			break;
+
+		case PXF_HOST_RGBA32:
+		case PXF_HOST_RGBx32:
+			shuf = shuf_HOST_RGBA32;
+			has_alpha = (px_format == PXF_HOST_RGBA32);
+			break;
+
+		case PXF_SWAP_ARGB32:
+		case PXF_SWAP_xRGB32:
+			shuf = shuf_SWAP_ARGB32;
+			has_alpha = (px_format == PXF_SWAP_ARGB32);
+			break;
+
+		case PXF_SWAP_RGBA32:
+		case PXF_SWAP_RGBx32:
+			shuf = shuf_SWAP_RGBA32;
+			has_alpha = (px_format == PXF_SWAP_RGBA32);
+			break;
+
+		case PXF_G16R16:
+			// NOTE: Truncates to G8R8.
+			shuf = shuf_G16R16;
+			has_alpha = false;
+			break;
+
+		case PXF_RABG8888:
+			shuf = shuf_RABG8888;
+			has_alpha = true;
+			break;
+
+		default:
+			assert(!"Unsupported 32-bit pixel format.");
+			return nullptr;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	if (px_format == PXF_HOST_ARGB32) {
+		// Host-endian ARGB32.
+		// We can directly copy the image data without conversions.
+		if (stride == img->stride()) {
+			// Stride is identical. Copy the whole image all at once.
+			memcpy(img->bits(), img_buf, stride * height);
+		} else {
+			// Stride is not identical. Copy each scanline.
+			const int dest_stride = img->stride() / sizeof(uint32_t);
+			uint32_t *px_dest = static_cast<uint32_t*>(img->bits());
+			const unsigned int copy_len = static_cast<unsigned int>(width * bytespp);
+			for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
+				memcpy(px_dest, img_buf, copy_len);
+				img_buf += (stride / bytespp);
+				px_dest += dest_stride;
+			}
+		}
+		// Set the sBIT metadata.
+		static const rp_image::sBIT_t sBIT_A32 = {8,8,8,0,8};
+		img->set_sBIT(&sBIT_A32);
+		return img;
+	}
+
+	const int dest_stride_adj = (img->stride() / sizeof(uint32_t)) - img->width();
+	uint32_t *px_dest = static_cast<uint32_t*>(img->bits());
+
+	const uint8x16_t shuf_mask = vld1q_u8(shuf);
+	// Alpha channel mask for images without an alpha channel.
+	const uint8x16_t alpha_mask = vreinterpretq_u8_u32(vdupq_n_u32(
+		has_alpha ? 0x00000000U : 0xFF000000U));
+
+	for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
+		// Process 16 pixels per iteration using NEON.
+		unsigned int x = static_cast<unsigned int>(width);
+		for (; x > 15; x -= 16, px_dest += 16, img_buf += 16) {
+			const uint8_t *const src8 = reinterpret_cast<const uint8_t*>(img_buf);
+			uint8_t *const dest8 = reinterpret_cast<uint8_t*>(px_dest);
+
+			const uint8x16_t sa = vld1q_u8(&src8[0]);
+			const uint8x16_t sb = vld1q_u8(&src8[16]);
+			const uint8x16_t sc = vld1q_u8(&src8[32]);
+			const uint8x16_t sd = vld1q_u8(&src8[48]);
+
+			vst1q_u8(&dest8[0],  vorrq_u8(vqtbl1q_u8(sa, shuf_mask), alpha_mask));
+			vst1q_u8(&dest8[16], vorrq_u8(vqtbl1q_u8(sb, shuf_mask), alpha_mask));
+			vst1q_u8(&dest8[32], vorrq_u8(vqtbl1q_u8(sc, shuf_mask), alpha_mask));
+			vst1q_u8(&dest8[48], vorrq_u8(vqtbl1q_u8(sd, shuf_mask), alpha_mask));
+		}
+
+		// Remaining pixels.
+		switch (px_format) {
+			case PXF_HOST_xRGB32:
+				// Host-endian XRGB32.
+				// Pixel copy is needed, with alpha channel masking.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					*px_dest = *img_buf | 0xFF000000;
+				}
+				break;
+
+			case PXF_HOST_RGBA32:
+				// Host-endian RGBA32.
+				// Pixel copy is needed, with shifting.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					*px_dest = (*img_buf >> 8) | (*img_buf << 24);
+				}
+				break;
+
+			case PXF_HOST_RGBx32:
+				// Host-endian RGBx32.
+				// Pixel copy is needed, with a right shift.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					*px_dest = (*img_buf >> 8) | 0xFF000000;
+				}
+				break;
+
+			case PXF_SWAP_ARGB32:
+				// Byteswapped ARGB32.
+				// Pixel copy is needed, with byteswapping.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					*px_dest = __swab32(*img_buf);
+				}
+				break;
+
+			case PXF_SWAP_xRGB32:
+				// Byteswapped XRGB32.
+				// Pixel copy is needed, with byteswapping and alpha channel masking.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					*px_dest = __swab32(*img_buf) | 0xFF000000;
+				}
+				break;
+
+			case PXF_SWAP_RGBA32:
+				// Byteswapped ABGR32.
+				// Pixel copy is needed, with shifting.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					const uint32_t px = __swab32(*img_buf);
+					*px_dest = (px >> 8) | (px << 24);
+				}
+				break;
+
+			case PXF_SWAP_RGBx32:
+				// Byteswapped RGBx32.
+				// Pixel copy is needed, with byteswapping and a right shift.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					*px_dest = (__swab32(*img_buf) >> 8) | 0xFF000000;
+				}
+				break;
+
+			case PXF_G16R16:
+				// G16R16.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					*px_dest = G16R16_to_ARGB32(le32_to_cpu(*img_buf));
+				}
+				break;
+
+			case PXF_RABG8888:
+				// VTF "ARGB8888", which is actually RABG.
+				// Swap the bytes within each 16-bit half.
+				for (; x > 0; x--, img_buf++, px_dest++) {
+					*px_dest = ((*img_buf >> 8) & 0x00FF00FF) |
+					           ((*img_buf << 8) & 0xFF00FF00);
+				}
+				break;
+
+			default:
+				assert(!"Unsupported 32-bit pixel format.");
+				img->unref();
+				return nullptr;
+		}
+
+		// Next line.
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+
+	// Set the sBIT metadata.
+	if (unlikely(px_format == PXF_G16R16)) {
+		static const rp_image::sBIT_t sBIT_G16R16 = {8,8,1,0,0};
+		img->set_sBIT(&sBIT_G16R16);
+	} else if (has_alpha) {
+		static const rp_image::sBIT_t sBIT_A32 = {8,8,8,0,8};
+		img->set_sBIT(&sBIT_A32);
+	} else {
+		static const rp_image::sBIT_t sBIT_x32 = {8,8,8,0,0};
+		img->set_sBIT(&sBIT_x32);
+	}
+
+	// Image has been converted.
+	return img;
+}
+
+} }
@@ -230,6 +230,7 @@ rp_image *fromLinear16_sse2(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_TRACE_ZONE(__func__);
 	ASSERT_ALIGNMENT(16, img_buf);
 	static const int bytespp = 2;
 
@@ -494,7 +495,7 @@ rp_image *fromLinear16_sse2(PixelFormat px_format,
 
 				// Remaining pixels.
 				for (; x > 0; x--) {
-					*px_dest = RG88_to_ARGB32(*img_buf);
+					*px_dest = GR88_to_ARGB32(*img_buf);
 					img_buf++;
 					px_dest++;
 				}
@@ -35,6 +35,7 @@ rp_image *fromLinear24_ssse3(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_TRACE_ZONE(__func__);
 	ASSERT_ALIGNMENT(16, img_buf);
 	static const int bytespp = 3;
 
@@ -187,6 +188,7 @@ rp_image *fromLinear32_ssse3(PixelFormat px_format,
 	int width, int height,
 	const uint32_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RP_TRACE_ZONE(__func__);
 	ASSERT_ALIGNMENT(16, img_buf);
 	static const int bytespp = 4;
 
@@ -28,15 +28,17 @@ static const uint8_t N3DS_tile_order[] = {
 
 /**
  * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
+ * Standard version using regular C++ code.
  * @param width Image width.
  * @param height Image height.
  * @param img_buf RGB565 tiled image buffer.
  * @param img_siz Size of image data. [must be >= (w*h)*2]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromN3DSTiledRGB565(int width, int height,
+rp_image *fromN3DSTiledRGB565_cpp(int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -92,6 +94,7 @@ rp_image *fromN3DSTiledRGB565(int width, int height,
 
 /**
  * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * Standard version using regular C++ code.
  * @param width Image width.
  * @param height Image height.
  * @param img_buf RGB565 tiled image buffer.
@@ -100,46 +103,93 @@ rp_image *fromN3DSTiledRGB565(int width, int height,
  * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromN3DSTiledRGB565_A4(int width, int height,
+rp_image *fromN3DSTiledRGB565_A4_cpp(int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz,
 	const uint8_t *RESTRICT alpha_buf, int alpha_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0)
+		return nullptr;
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	int ret = decodeN3DSTiledRGB565_A4_cpp(width, height,
+		img_buf, img_siz, alpha_buf, alpha_siz,
+		static_cast<uint32_t*>(img->bits()), img->stride());
+	if (ret != 0) {
+		img->unref();
+		return nullptr;
+	}
+
+	// Set the sBIT metadata.
+	static const rp_image::sBIT_t sBIT = {5,6,5,0,4};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Decode a Nintendo 3DS RGB565+A4 tiled icon
+ * into a caller-provided ARGB32 buffer.
+ * Standard version using regular C++ code.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @param dest ARGB32 destination buffer. [must have height rows of width pixels]
+ * @param dest_stride Destination stride, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int decodeN3DSTiledRGB565_A4_cpp(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz,
+	uint32_t *RESTRICT dest, int dest_stride)
 {
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(alpha_buf != nullptr);
+	assert(dest != nullptr);
 	assert(width > 0);
 	assert(height > 0);
 	assert(img_siz >= ((width * height) * 2));
 	assert(alpha_siz >= ((width * height) / 2));
-	if (!img_buf || !alpha_buf || width <= 0 || height <= 0 ||
+	assert(dest_stride >= width * static_cast<int>(sizeof(uint32_t)));
+	if (!img_buf || !alpha_buf || !dest || width <= 0 || height <= 0 ||
 	    img_siz < ((width * height) * 2) ||
-	    alpha_siz < ((width * height) / 2))
+	    alpha_siz < ((width * height) / 2) ||
+	    dest_stride < width * static_cast<int>(sizeof(uint32_t)))
 	{
-		return nullptr;
+		return -EINVAL;
 	}
 
 	// N3DS tiled images use 8x8 tiles.
 	assert(width % 8 == 0);
 	assert(height % 8 == 0);
 	if (width % 8 != 0 || height % 8 != 0)
-		return nullptr;
+		return -EINVAL;
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(width / 8);
 	const unsigned int tilesY = static_cast<unsigned int>(height / 8);
-
-	// Create an rp_image.
-	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
-	if (!img->isValid()) {
-		// Could not allocate the image.
-		img->unref();
-		return nullptr;
-	}
+	const int stride_px = dest_stride / sizeof(uint32_t);
 
 	// Temporary tile buffer.
 	uint32_t tileBuf[8*8];
 
 	for (unsigned int y = 0; y < tilesY; y++) {
+		uint32_t *const pTileRow = dest + (y * 8 * stride_px);
 		for (unsigned int x = 0; x < tilesX; x++) {
 			// Convert each tile to ARGB32 manually.
 			// FIXME: Nybble ordering for A4?
@@ -151,11 +201,104 @@ rp_image *fromN3DSTiledRGB565_A4(int width, int height,
 					le16_to_cpu(img_buf[1]), *alpha_buf >> 4);
 			}
 
-			// Blit the tile to the main image buffer.
-			ImageDecoderPrivate::BlitTile<uint32_t, 8, 8>(img, tileBuf, x, y);
+			// Copy the tile into the destination buffer.
+			uint32_t *pDest = pTileRow + (x * 8);
+			for (unsigned int ty = 0; ty < 8; ty++, pDest += stride_px) {
+				memcpy(pDest, &tileBuf[ty * 8], 8 * sizeof(uint32_t));
+			}
 		}
 	}
 
+	return 0;
+}
+
+/**
+ * Convert a grid of Nintendo 3DS RGB565+A4 tiled icons to a single rp_image.
+ * This is used for Nintendo Badge Arcade mega badges.
+ *
+ * Each icon is decoded directly into its position in the
+ * destination image. Large grids are decoded in parallel
+ * using the shared decoder thread pool.
+ *
+ * Icons are stored left to right, then top to bottom.
+ * Each icon has its RGB565 data followed by its A4 data.
+ *
+ * @param width Icon width.
+ * @param height Icon height.
+ * @param cols Number of icons horizontally.
+ * @param rows Number of icons vertically.
+ * @param buf Icon data.
+ * @param buf_siz Size of icon data. [must be >= ((cols*rows)-1)*icon_stride + (w*h)*2 + (w*h)/2]
+ * @param icon_stride Distance between icons in buf, in bytes. [must be >= (w*h)*2 + (w*h)/2, and even]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565_A4_Grid(int width, int height,
+	int cols, int rows,
+	const uint8_t *buf, size_t buf_siz,
+	unsigned int icon_stride)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(cols > 0);
+	assert(rows > 0);
+	if (!buf || width <= 0 || height <= 0 || cols <= 0 || rows <= 0)
+		return nullptr;
+
+	const int rgb_siz = (width * height) * 2;
+	const int alpha_siz = (width * height) / 2;
+	const size_t icon_count = static_cast<size_t>(cols) * static_cast<size_t>(rows);
+	assert(icon_stride >= static_cast<unsigned int>(rgb_siz + alpha_siz));
+	assert(icon_stride % 2 == 0);
+	assert(buf_siz >= ((icon_count - 1) * icon_stride) + rgb_siz + alpha_siz);
+	if (icon_stride < static_cast<unsigned int>(rgb_siz + alpha_siz) ||
+	    icon_stride % 2 != 0 ||
+	    buf_siz < ((icon_count - 1) * icon_stride) + rgb_siz + alpha_siz)
+	{
+		return nullptr;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width * cols, height * rows, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+	uint32_t *const bits = static_cast<uint32_t*>(img->bits());
+	const int dest_stride = img->stride();
+	const int stride_px = dest_stride / sizeof(uint32_t);
+
+	// Each row of icons is a strip.
+	// Icons are decoded directly into the image, so strips
+	// never write to the same destination rows.
+	const unsigned int pixelCount = static_cast<unsigned int>(img->width()) *
+	                                static_cast<unsigned int>(img->height());
+	const bool ok = ImageDecoderPrivate::decodeStrips(static_cast<unsigned int>(rows), pixelCount,
+		[=](unsigned int firstRow, unsigned int endRow) -> bool {
+			for (unsigned int y = firstRow; y < endRow; y++) {
+				const uint8_t *pIcon = buf + (static_cast<size_t>(y) * cols * icon_stride);
+				uint32_t *const pDestRow = bits + (static_cast<size_t>(y) * height * stride_px);
+				for (int x = 0; x < cols; x++, pIcon += icon_stride) {
+					int ret = decodeN3DSTiledRGB565_A4(width, height,
+						reinterpret_cast<const uint16_t*>(pIcon), rgb_siz,
+						pIcon + rgb_siz, alpha_siz,
+						pDestRow + (x * width), dest_stride);
+					if (ret != 0) {
+						return false;
+					}
+				}
+			}
+			return true;
+		});
+	if (!ok) {
+		// Decoding failed or was cancelled.
+		img->unref();
+		return nullptr;
+	}
+
 	// Set the sBIT metadata.
 	static const rp_image::sBIT_t sBIT = {5,6,5,0,4};
 	img->set_sBIT(&sBIT);
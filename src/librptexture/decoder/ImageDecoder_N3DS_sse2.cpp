@@ -0,0 +1,302 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_N3DS.cpp: Image decoding functions. (Nintendo 3DS)         *
+ * SSE2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageDecoder.hpp"
+#include "ImageDecoder_p.hpp"
+
+// SSE2 intrinsics.
+#include <emmintrin.h>
+
+// MSVC complains when the high bit is set in hex values
+// when setting SSE2 registers.
+#ifdef _MSC_VER
+# pragma warning(push)
+# pragma warning(disable: 4309)
+#endif
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/**
+ * Convert 8 RGB565 pixels to ARGB32 using SSE2.
+ * @param src	[in] RGB565 pixels.
+ * @param sA	[in] Alpha channel, in the high byte of each word.
+ * @param px0	[out] ARGB32 pixels 0-3.
+ * @param px1	[out] ARGB32 pixels 4-7.
+ */
+static inline void RGB565_to_ARGB32_sse2(const __m128i &src, const __m128i &sA,
+	__m128i &px0, __m128i &px1)
+{
+	const __m128i Mask16_R = _mm_set1_epi16(0xF800);
+	const __m128i Mask16_G = _mm_set1_epi16(0x07E0);
+	const __m128i Mask16_B = _mm_set1_epi16(0x001F);
+	const __m128i Mask16_G_Lo = _mm_set1_epi16(0x0300);
+
+	// Blue: 5-bit to 8-bit, in the low byte.
+	__m128i sB = _mm_slli_epi16(_mm_and_si128(src, Mask16_B), 3);
+	sB = _mm_or_si128(sB, _mm_srli_epi16(sB, 5));
+
+	// Green: 6-bit to 8-bit, in the high byte.
+	__m128i sG = _mm_slli_epi16(_mm_and_si128(src, Mask16_G), 5);
+	sG = _mm_or_si128(sG, _mm_and_si128(_mm_srli_epi16(sG, 6), Mask16_G_Lo));
+
+	// Red: 5-bit to 8-bit, in the low byte.
+	__m128i sR = _mm_srli_epi16(_mm_and_si128(src, Mask16_R), 8);
+	sR = _mm_or_si128(sR, _mm_srli_epi16(sR, 5));
+
+	// Combine the channels into GB and AR words,
+	// then unpack them into DWORDs.
+	const __m128i sGB = _mm_or_si128(sG, sB);
+	const __m128i sAR = _mm_or_si128(sA, sR);
+	px0 = _mm_unpacklo_epi16(sGB, sAR);
+	px1 = _mm_unpackhi_epi16(sGB, sAR);
+}
+
+/**
+ * Expand 8 A4 alpha values to A8, in the high byte of each word.
+ * Each byte has two alpha values. (LeftLSN)
+ * @param alpha_buf A4 alpha buffer. (4 bytes)
+ * @return Alpha channel.
+ */
+static inline __m128i A4_to_A8_sse2(const uint8_t *RESTRICT alpha_buf)
+{
+	const __m128i Mask8_Lo = _mm_set1_epi8(0x0F);
+
+	uint32_t a4;
+	memcpy(&a4, alpha_buf, sizeof(a4));
+	const __m128i sA4 = _mm_cvtsi32_si128(static_cast<int>(a4));
+
+	// Separate the nybbles and interleave them in pixel order.
+	const __m128i sLo = _mm_and_si128(sA4, Mask8_Lo);
+	const __m128i sHi = _mm_and_si128(_mm_srli_epi16(sA4, 4), Mask8_Lo);
+	__m128i sA = _mm_unpacklo_epi8(sLo, sHi);
+
+	// Expand from 4-bit to 8-bit.
+	// NOTE: Each byte is < 16, so the shift won't cross into the next byte.
+	sA = _mm_or_si128(sA, _mm_slli_epi16(sA, 4));
+
+	// Move the alpha values into the high byte of each word.
+	return _mm_unpacklo_epi8(_mm_setzero_si128(), sA);
+}
+
+/**
+ * Store 8 ARGB32 pixels from a 2x2+2x2 Z-order group into a 4x2 region.
+ * @param px0	[in] ARGB32 pixels 0-3. (left 2x2 block)
+ * @param px1	[in] ARGB32 pixels 4-7. (right 2x2 block)
+ * @param pDest	[out] Destination for the first row.
+ * @param stride_px [in] Destination stride, in pixels.
+ */
+static inline void storeZGroup_sse2(const __m128i &px0, const __m128i &px1,
+	uint32_t *pDest, int stride_px)
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest), _mm_unpacklo_epi64(px0, px1));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + stride_px), _mm_unpackhi_epi64(px0, px1));
+}
+
+/**
+ * Get the offset of a Z-order group within an 8x8 tile.
+ *
+ * N3DS uses 3-level Z-ordered tiling, so each group of 8 source
+ * pixels is a 4x2 region of the tile.
+ * Group index bits: [0] == Y+2, [1] == X+4, [2] == Y+4
+ *
+ * @param g Group index. (0-7)
+ * @param stride_px Destination stride, in pixels.
+ * @return Offset of the group's first pixel, in pixels.
+ */
+static inline int N3DS_groupOffset(unsigned int g, int stride_px)
+{
+	const int gx = (g & 2) << 1;
+	const int gy = ((g & 1) << 1) | (g & 4);
+	return (gy * stride_px) + gx;
+}
+
+/**
+ * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
+ * SSE2-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565_sse2(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(img_siz >= ((width * height) * 2));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < ((width * height) * 2))
+	{
+		return nullptr;
+	}
+
+	// N3DS tiled images use 8x8 tiles.
+	assert(width % 8 == 0);
+	assert(height % 8 == 0);
+	if (width % 8 != 0 || height % 8 != 0)
+		return nullptr;
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	// Calculate the total number of tiles.
+	const unsigned int tilesX = static_cast<unsigned int>(width / 8);
+	const unsigned int tilesY = static_cast<unsigned int>(height / 8);
+	const int stride_px = img->stride() / sizeof(uint32_t);
+
+	const __m128i sA = _mm_set1_epi16(0xFF00);
+	const __m128i *xmm_src = reinterpret_cast<const __m128i*>(img_buf);
+	for (unsigned int y = 0; y < tilesY; y++) {
+		uint32_t *const pTileRow = static_cast<uint32_t*>(img->scanLine(y * 8));
+		for (unsigned int x = 0; x < tilesX; x++) {
+			// Convert each 4x2 group directly into the image.
+			uint32_t *const pTile = pTileRow + (x * 8);
+			for (unsigned int g = 0; g < 8; g++, xmm_src++) {
+				__m128i px0, px1;
+				RGB565_to_ARGB32_sse2(_mm_loadu_si128(xmm_src), sA, px0, px1);
+				storeZGroup_sse2(px0, px1, pTile + N3DS_groupOffset(g, stride_px), stride_px);
+			}
+		}
+	}
+
+	// Set the sBIT metadata.
+	static const rp_image::sBIT_t sBIT = {5,6,5,0,0};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * SSE2-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565_A4_sse2(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0)
+		return nullptr;
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	int ret = decodeN3DSTiledRGB565_A4_sse2(width, height,
+		img_buf, img_siz, alpha_buf, alpha_siz,
+		static_cast<uint32_t*>(img->bits()), img->stride());
+	if (ret != 0) {
+		img->unref();
+		return nullptr;
+	}
+
+	// Set the sBIT metadata.
+	static const rp_image::sBIT_t sBIT = {5,6,5,0,4};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Decode a Nintendo 3DS RGB565+A4 tiled icon
+ * into a caller-provided ARGB32 buffer.
+ * SSE2-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @param dest ARGB32 destination buffer. [must have height rows of width pixels]
+ * @param dest_stride Destination stride, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int decodeN3DSTiledRGB565_A4_sse2(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz,
+	uint32_t *RESTRICT dest, int dest_stride)
+{
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(alpha_buf != nullptr);
+	assert(dest != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(img_siz >= ((width * height) * 2));
+	assert(alpha_siz >= ((width * height) / 2));
+	assert(dest_stride >= width * static_cast<int>(sizeof(uint32_t)));
+	if (!img_buf || !alpha_buf || !dest || width <= 0 || height <= 0 ||
+	    img_siz < ((width * height) * 2) ||
+	    alpha_siz < ((width * height) / 2) ||
+	    dest_stride < width * static_cast<int>(sizeof(uint32_t)))
+	{
+		return -EINVAL;
+	}
+
+	// N3DS tiled images use 8x8 tiles.
+	assert(width % 8 == 0);
+	assert(height % 8 == 0);
+	if (width % 8 != 0 || height % 8 != 0)
+		return -EINVAL;
+
+	// Calculate the total number of tiles.
+	const unsigned int tilesX = static_cast<unsigned int>(width / 8);
+	const unsigned int tilesY = static_cast<unsigned int>(height / 8);
+	const int stride_px = dest_stride / sizeof(uint32_t);
+
+	// FIXME: Nybble ordering for A4?
+	// Assuming LeftLSN, same as NDS CI4.
+	const __m128i *xmm_src = reinterpret_cast<const __m128i*>(img_buf);
+	for (unsigned int y = 0; y < tilesY; y++) {
+		uint32_t *const pTileRow = dest + (y * 8 * stride_px);
+		for (unsigned int x = 0; x < tilesX; x++) {
+			// Convert each 4x2 group directly into the destination.
+			uint32_t *const pTile = pTileRow + (x * 8);
+			for (unsigned int g = 0; g < 8; g++, xmm_src++, alpha_buf += 4) {
+				__m128i px0, px1;
+				RGB565_to_ARGB32_sse2(_mm_loadu_si128(xmm_src), A4_to_A8_sse2(alpha_buf), px0, px1);
+				storeZGroup_sse2(px0, px1, pTile + N3DS_groupOffset(g, stride_px), stride_px);
+			}
+		}
+	}
+
+	return 0;
+}
+
+} }
+
+#ifdef _MSC_VER
+# pragma warning(pop)
+#endif
@@ -0,0 +1,598 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_OpenCL.cpp: GPU decoding using OpenCL.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librptexture.h"
+
+#include "ImageDecoder.hpp"
+#include "ImageDecoder_p.hpp"
+
+#ifdef ENABLE_GPU_DECODE
+#  include "ImageDecoder_OpenCL_kernels.h"
+
+// librpthreads
+#  include "librpthreads/Atomics.h"
+#  include "librpthreads/CancelToken.hpp"
+using LibRpThreads::CancelToken;
+
+#  ifndef _WIN32
+// Unix dlopen()
+#    include <dlfcn.h>
+#  else
+// Windows LoadLibrary()
+#    include "libwin32common/RpWin32_sdk.h"
+#    define dlsym(handle, symbol)	((void*)GetProcAddress(handle, symbol))
+#    define dlclose(handle)		FreeLibrary(handle)
+#  endif
+#endif /* ENABLE_GPU_DECODE */
+
+namespace LibRpTexture {
+
+// Is GPU decoding enabled?
+bool ImageDecoderPrivate::gpuDecodeEnabled = false;
+
+#ifdef ENABLE_GPU_DECODE
+
+/** OpenCL declarations **/
+
+// The OpenCL library is loaded at runtime, so we don't need
+// the OpenCL headers or an import library at build time.
+// Only the types, constants, and functions used here are declared.
+// Reference: https://www.khronos.org/registry/OpenCL/api/2.1/cl.h
+
+#ifdef _WIN32
+#  define CL_API_CALL __stdcall
+#else
+#  define CL_API_CALL
+#endif
+
+typedef int32_t cl_int;
+typedef uint32_t cl_uint;
+typedef uint64_t cl_ulong;
+typedef cl_uint cl_bool;
+typedef cl_ulong cl_bitfield;
+typedef cl_bitfield cl_device_type;
+typedef cl_bitfield cl_mem_flags;
+typedef cl_bitfield cl_command_queue_properties;
+typedef cl_uint cl_device_info;
+typedef intptr_t cl_context_properties;
+
+typedef struct _cl_platform_id *cl_platform_id;
+typedef struct _cl_device_id *cl_device_id;
+typedef struct _cl_context *cl_context;
+typedef struct _cl_command_queue *cl_command_queue;
+typedef struct _cl_mem *cl_mem;
+typedef struct _cl_program *cl_program;
+typedef struct _cl_kernel *cl_kernel;
+typedef struct _cl_event *cl_event;
+
+#define CL_SUCCESS			0
+#define CL_FALSE			0
+#define CL_TRUE				1
+#define CL_DEVICE_TYPE_GPU		(1U << 2)
+#define CL_MEM_READ_WRITE		(1U << 0)
+#define CL_MEM_WRITE_ONLY		(1U << 1)
+#define CL_MEM_READ_ONLY		(1U << 2)
+#define CL_MEM_COPY_HOST_PTR		(1U << 5)
+#define CL_DEVICE_MAX_MEM_ALLOC_SIZE	0x1010
+#define CL_DEVICE_ENDIAN_LITTLE		0x1026
+
+typedef cl_int (CL_API_CALL *PFN_clGetPlatformIDs)(cl_uint num_entries, cl_platform_id *platforms, cl_uint *num_platforms);
+typedef cl_int (CL_API_CALL *PFN_clGetDeviceIDs)(cl_platform_id platform, cl_device_type device_type,
+	cl_uint num_entries, cl_device_id *devices, cl_uint *num_devices);
+typedef cl_int (CL_API_CALL *PFN_clGetDeviceInfo)(cl_device_id device, cl_device_info param_name,
+	size_t param_value_size, void *param_value, size_t *param_value_size_ret);
+typedef cl_context (CL_API_CALL *PFN_clCreateContext)(const cl_context_properties *properties,
+	cl_uint num_devices, const cl_device_id *devices,
+	void (CL_API_CALL *pfn_notify)(const char *errinfo, const void *private_info, size_t cb, void *user_data),
+	void *user_data, cl_int *errcode_ret);
+typedef cl_command_queue (CL_API_CALL *PFN_clCreateCommandQueue)(cl_context context, cl_device_id device,
+	cl_command_queue_properties properties, cl_int *errcode_ret);
+typedef cl_program (CL_API_CALL *PFN_clCreateProgramWithSource)(cl_context context, cl_uint count,
+	const char **strings, const size_t *lengths, cl_int *errcode_ret);
+typedef cl_int (CL_API_CALL *PFN_clBuildProgram)(cl_program program, cl_uint num_devices,
+	const cl_device_id *device_list, const char *options,
+	void (CL_API_CALL *pfn_notify)(cl_program program, void *user_data), void *user_data);
+typedef cl_kernel (CL_API_CALL *PFN_clCreateKernel)(cl_program program, const char *kernel_name, cl_int *errcode_ret);
+typedef cl_mem (CL_API_CALL *PFN_clCreateBuffer)(cl_context context, cl_mem_flags flags,
+	size_t size, void *host_ptr, cl_int *errcode_ret);
+typedef cl_int (CL_API_CALL *PFN_clSetKernelArg)(cl_kernel kernel, cl_uint arg_index,
+	size_t arg_size, const void *arg_value);
+typedef cl_int (CL_API_CALL *PFN_clEnqueueNDRangeKernel)(cl_command_queue command_queue, cl_kernel kernel,
+	cl_uint work_dim, const size_t *global_work_offset, const size_t *global_work_size,
+	const size_t *local_work_size, cl_uint num_events_in_wait_list,
+	const cl_event *event_wait_list, cl_event *event);
+typedef cl_int (CL_API_CALL *PFN_clEnqueueReadBuffer)(cl_command_queue command_queue, cl_mem buffer,
+	cl_bool blocking_read, size_t offset, size_t size, void *ptr,
+	cl_uint num_events_in_wait_list, const cl_event *event_wait_list, cl_event *event);
+typedef cl_int (CL_API_CALL *PFN_clFinish)(cl_command_queue command_queue);
+typedef cl_int (CL_API_CALL *PFN_clReleaseMemObject)(cl_mem memobj);
+typedef cl_int (CL_API_CALL *PFN_clReleaseKernel)(cl_kernel kernel);
+typedef cl_int (CL_API_CALL *PFN_clReleaseProgram)(cl_program program);
+typedef cl_int (CL_API_CALL *PFN_clReleaseCommandQueue)(cl_command_queue command_queue);
+typedef cl_int (CL_API_CALL *PFN_clReleaseContext)(cl_context context);
+
+/** OpenCL state **/
+
+// Initialization state.
+enum class GpuState {
+	Uninitialized,
+	Ready,
+	Unavailable,	// OpenCL could not be initialized. Not retried.
+};
+
+// Kernels.
+enum GpuKernel {
+	KERNEL_DXT1,
+	KERNEL_DXT3,
+	KERNEL_DXT5,
+	KERNEL_BC4,
+	KERNEL_BC5,
+	KERNEL_BC7,
+	KERNEL_ETC,
+
+	KERNEL_MAX
+};
+
+static const char *const kernel_names[KERNEL_MAX] = {
+	"decode_dxt1",
+	"decode_dxt3",
+	"decode_dxt5",
+	"decode_bc4",
+	"decode_bc5",
+	"decode_bc7",
+	"decode_etc",
+};
+
+// Block format information.
+struct GpuFormatInfo {
+	uint8_t kernel;		// GpuKernel
+	uint8_t blockSize;	// Block size, in bytes.
+	uint8_t param;		// Kernel parameter. (DXT1: color3_alpha; ETC: mode flags)
+	rp_image::sBIT_t sBIT;	// sBIT metadata. (same as the CPU decoder)
+};
+
+static const GpuFormatInfo gpuFormatInfo[] = {
+	{KERNEL_DXT1,  8, 0, {8,8,8,0,1}},	// DXT1
+	{KERNEL_DXT1,  8, 1, {8,8,8,0,1}},	// DXT1_A1
+	{KERNEL_DXT3, 16, 0, {8,8,8,0,4}},	// DXT3
+	{KERNEL_DXT5, 16, 0, {8,8,8,0,8}},	// DXT5
+	{KERNEL_BC4,   8, 0, {8,1,1,0,0}},	// BC4
+	{KERNEL_BC5,  16, 0, {8,8,1,0,0}},	// BC5
+	{KERNEL_BC7,  16, 0, {8,8,8,0,8}},	// BC7
+	{KERNEL_ETC,   8, 0, {8,8,8,0,0}},	// ETC1
+	{KERNEL_ETC,   8, 1, {8,8,8,0,0}},	// ETC2_RGB
+	{KERNEL_ETC,  16, 5, {8,8,8,0,8}},	// ETC2_RGBA
+	{KERNEL_ETC,   8, 3, {8,8,8,0,1}},	// ETC2_RGB_A1
+};
+static_assert(ARRAY_SIZE(gpuFormatInfo) == static_cast<size_t>(ImageDecoderPrivate::GpuFormat::Max),
+	"gpuFormatInfo[] is out of sync with GpuFormat.");
+
+// Only one thread can use the GPU at a time.
+// Other threads decode on the CPU instead of waiting.
+// The OpenCL state below is only accessed by the thread that set gpuBusy.
+static volatile int gpuBusy = 0;
+static GpuState gpuState = GpuState::Uninitialized;
+
+#ifdef _WIN32
+static HMODULE libOpenCL = nullptr;
+#else /* !_WIN32 */
+static void *libOpenCL = nullptr;
+#endif /* _WIN32 */
+
+static cl_context cl_ctx = nullptr;
+static cl_command_queue cl_queue = nullptr;
+static cl_program cl_prog = nullptr;
+static cl_kernel cl_kernels[KERNEL_MAX];
+static cl_ulong cl_maxAlloc = 0;
+
+// OpenCL function pointers.
+static struct {
+	PFN_clGetPlatformIDs clGetPlatformIDs;
+	PFN_clGetDeviceIDs clGetDeviceIDs;
+	PFN_clGetDeviceInfo clGetDeviceInfo;
+	PFN_clCreateContext clCreateContext;
+	PFN_clCreateCommandQueue clCreateCommandQueue;
+	PFN_clCreateProgramWithSource clCreateProgramWithSource;
+	PFN_clBuildProgram clBuildProgram;
+	PFN_clCreateKernel clCreateKernel;
+	PFN_clCreateBuffer clCreateBuffer;
+	PFN_clSetKernelArg clSetKernelArg;
+	PFN_clEnqueueNDRangeKernel clEnqueueNDRangeKernel;
+	PFN_clEnqueueReadBuffer clEnqueueReadBuffer;
+	PFN_clFinish clFinish;
+	PFN_clReleaseMemObject clReleaseMemObject;
+	PFN_clReleaseKernel clReleaseKernel;
+	PFN_clReleaseProgram clReleaseProgram;
+	PFN_clReleaseCommandQueue clReleaseCommandQueue;
+	PFN_clReleaseContext clReleaseContext;
+} cl;
+
+/**
+ * Release all OpenCL objects and unload the OpenCL library.
+ */
+static void gpuShutdown(void)
+{
+	for (cl_kernel &kernel : cl_kernels) {
+		if (kernel) {
+			cl.clReleaseKernel(kernel);
+			kernel = nullptr;
+		}
+	}
+	if (cl_prog) {
+		cl.clReleaseProgram(cl_prog);
+		cl_prog = nullptr;
+	}
+	if (cl_queue) {
+		cl.clReleaseCommandQueue(cl_queue);
+		cl_queue = nullptr;
+	}
+	if (cl_ctx) {
+		cl.clReleaseContext(cl_ctx);
+		cl_ctx = nullptr;
+	}
+	if (libOpenCL) {
+		dlclose(libOpenCL);
+		libOpenCL = nullptr;
+	}
+	memset(&cl, 0, sizeof(cl));
+}
+
+/**
+ * Load the OpenCL library and build the decoding kernels.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int gpuInit(void)
+{
+	// Load the OpenCL ICD loader.
+#if defined(_WIN32)
+	libOpenCL = LoadLibrary(_T("OpenCL.dll"));
+#elif defined(__APPLE__)
+	libOpenCL = dlopen("/System/Library/Frameworks/OpenCL.framework/OpenCL", RTLD_LOCAL|RTLD_NOW);
+#else
+	libOpenCL = dlopen("libOpenCL.so.1", RTLD_LOCAL|RTLD_NOW);
+#endif
+	if (!libOpenCL) {
+		return -ENOENT;
+	}
+
+#define CL_DLSYM(sym) do { \
+		cl.sym = reinterpret_cast<PFN_##sym>(dlsym(libOpenCL, #sym)); \
+		if (!cl.sym) { \
+			gpuShutdown(); \
+			return -ENOENT; \
+		} \
+	} while (0)
+	CL_DLSYM(clGetPlatformIDs);
+	CL_DLSYM(clGetDeviceIDs);
+	CL_DLSYM(clGetDeviceInfo);
+	CL_DLSYM(clCreateContext);
+	CL_DLSYM(clCreateCommandQueue);
+	CL_DLSYM(clCreateProgramWithSource);
+	CL_DLSYM(clBuildProgram);
+	CL_DLSYM(clCreateKernel);
+	CL_DLSYM(clCreateBuffer);
+	CL_DLSYM(clSetKernelArg);
+	CL_DLSYM(clEnqueueNDRangeKernel);
+	CL_DLSYM(clEnqueueReadBuffer);
+	CL_DLSYM(clFinish);
+	CL_DLSYM(clReleaseMemObject);
+	CL_DLSYM(clReleaseKernel);
+	CL_DLSYM(clReleaseProgram);
+	CL_DLSYM(clReleaseCommandQueue);
+	CL_DLSYM(clReleaseContext);
+#undef CL_DLSYM
+
+	// Find the first GPU device.
+	// TODO: Prefer discrete GPUs if more than one is available?
+	cl_platform_id platforms[8];
+	cl_uint num_platforms = 0;
+	if (cl.clGetPlatformIDs(ARRAY_SIZE(platforms), platforms, &num_platforms) != CL_SUCCESS) {
+		gpuShutdown();
+		return -ENODEV;
+	}
+	num_platforms = std::min(num_platforms, static_cast<cl_uint>(ARRAY_SIZE(platforms)));
+
+	cl_device_id device = nullptr;
+	for (cl_uint i = 0; i < num_platforms; i++) {
+		cl_uint num_devices = 0;
+		if (cl.clGetDeviceIDs(platforms[i], CL_DEVICE_TYPE_GPU, 1, &device, &num_devices) == CL_SUCCESS &&
+		    num_devices > 0)
+		{
+			break;
+		}
+		device = nullptr;
+	}
+	if (!device) {
+		gpuShutdown();
+		return -ENODEV;
+	}
+
+	// The kernels write host-endian ARGB32 pixels,
+	// so the device must have the same endianness.
+	cl_bool little_endian = CL_FALSE;
+	cl.clGetDeviceInfo(device, CL_DEVICE_ENDIAN_LITTLE, sizeof(little_endian), &little_endian, nullptr);
+	if (little_endian != (SYS_BYTEORDER == SYS_LIL_ENDIAN ? CL_TRUE : CL_FALSE)) {
+		gpuShutdown();
+		return -ENOTSUP;
+	}
+	if (cl.clGetDeviceInfo(device, CL_DEVICE_MAX_MEM_ALLOC_SIZE, sizeof(cl_maxAlloc), &cl_maxAlloc, nullptr) != CL_SUCCESS) {
+		gpuShutdown();
+		return -EIO;
+	}
+
+	cl_int err = CL_SUCCESS;
+	cl_ctx = cl.clCreateContext(nullptr, 1, &device, nullptr, nullptr, &err);
+	if (!cl_ctx || err != CL_SUCCESS) {
+		cl_ctx = nullptr;
+		gpuShutdown();
+		return -EIO;
+	}
+	cl_queue = cl.clCreateCommandQueue(cl_ctx, device, 0, &err);
+	if (!cl_queue || err != CL_SUCCESS) {
+		cl_queue = nullptr;
+		gpuShutdown();
+		return -EIO;
+	}
+
+	// Build the kernels.
+	const char *sources[] = {
+		ImageDecoder::ocl_src_s3tc,
+		ImageDecoder::ocl_src_bc7,
+		ImageDecoder::ocl_src_etc,
+	};
+	cl_prog = cl.clCreateProgramWithSource(cl_ctx, ARRAY_SIZE(sources), sources, nullptr, &err);
+	if (!cl_prog || err != CL_SUCCESS) {
+		cl_prog = nullptr;
+		gpuShutdown();
+		return -EIO;
+	}
+	if (cl.clBuildProgram(cl_prog, 1, &device, "", nullptr, nullptr) != CL_SUCCESS) {
+		gpuShutdown();
+		return -EIO;
+	}
+	for (unsigned int i = 0; i < KERNEL_MAX; i++) {
+		cl_kernels[i] = cl.clCreateKernel(cl_prog, kernel_names[i], &err);
+		if (!cl_kernels[i] || err != CL_SUCCESS) {
+			cl_kernels[i] = nullptr;
+			gpuShutdown();
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Decode an image using an OpenCL kernel.
+ * The OpenCL state must have been initialized.
+ * @param info		[in] Format information.
+ * @param tilesX	[in] Number of tiles per row.
+ * @param tilesY	[in] Number of tile rows.
+ * @param img_buf	[in] Image buffer.
+ * @param img		[out] Destination image. (tilesX*4 x tilesY*4, ARGB32)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int gpuRunKernel(const GpuFormatInfo &info, unsigned int tilesX, unsigned int tilesY,
+	const uint8_t *img_buf, rp_image *img)
+{
+	const size_t srcSize = static_cast<size_t>(tilesX) * tilesY * info.blockSize;
+	const size_t dstStride = static_cast<size_t>(tilesX) * 4 * sizeof(uint32_t);
+	const size_t dstSize = dstStride * tilesY * 4;
+	if (srcSize > cl_maxAlloc || dstSize > cl_maxAlloc) {
+		// Too big for the GPU.
+		return -ENOMEM;
+	}
+
+	// NOTE: CL_MEM_COPY_HOST_PTR only reads from host_ptr.
+	cl_int err = CL_SUCCESS;
+	cl_mem srcBuf = cl.clCreateBuffer(cl_ctx, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+		srcSize, const_cast<uint8_t*>(img_buf), &err);
+	if (!srcBuf || err != CL_SUCCESS) {
+		return -ENOMEM;
+	}
+	cl_mem dstBuf = cl.clCreateBuffer(cl_ctx, CL_MEM_WRITE_ONLY, dstSize, nullptr, &err);
+	if (!dstBuf || err != CL_SUCCESS) {
+		cl.clReleaseMemObject(srcBuf);
+		return -ENOMEM;
+	}
+
+	// BC7 reports invalid block modes using an error flag.
+	cl_int errFlag = 0;
+	cl_mem errBuf = nullptr;
+
+	cl_kernel kernel = cl_kernels[info.kernel];
+	err  = cl.clSetKernelArg(kernel, 0, sizeof(srcBuf), &srcBuf);
+	err |= cl.clSetKernelArg(kernel, 1, sizeof(dstBuf), &dstBuf);
+	switch (info.kernel) {
+		case KERNEL_DXT1:
+		case KERNEL_ETC: {
+			const cl_uint param = info.param;
+			err |= cl.clSetKernelArg(kernel, 2, sizeof(param), &param);
+			break;
+		}
+		case KERNEL_BC7: {
+			cl_int errInit = CL_SUCCESS;
+			errBuf = cl.clCreateBuffer(cl_ctx, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+				sizeof(errFlag), &errFlag, &errInit);
+			if (!errBuf || errInit != CL_SUCCESS) {
+				cl.clReleaseMemObject(dstBuf);
+				cl.clReleaseMemObject(srcBuf);
+				return -ENOMEM;
+			}
+			err |= cl.clSetKernelArg(kernel, 2, sizeof(errBuf), &errBuf);
+			break;
+		}
+		default:
+			break;
+	}
+
+	int ret = 0;
+	const size_t globalSize[2] = {tilesX, tilesY};
+	if (err != CL_SUCCESS ||
+	    cl.clEnqueueNDRangeKernel(cl_queue, kernel, 2, nullptr, globalSize, nullptr, 0, nullptr, nullptr) != CL_SUCCESS)
+	{
+		ret = -EIO;
+	}
+
+	// Read the decoded image.
+	// rp_image rows may be padded, so read one row at a time if necessary.
+	if (ret == 0) {
+		const size_t rows = static_cast<size_t>(tilesY) * 4;
+		uint8_t *bits = static_cast<uint8_t*>(img->bits());
+		if (static_cast<size_t>(img->stride()) == dstStride) {
+			err = cl.clEnqueueReadBuffer(cl_queue, dstBuf, CL_FALSE, 0, dstSize, bits, 0, nullptr, nullptr);
+		} else {
+			err = CL_SUCCESS;
+			for (size_t y = 0; y < rows && err == CL_SUCCESS; y++, bits += img->stride()) {
+				err = cl.clEnqueueReadBuffer(cl_queue, dstBuf, CL_FALSE, y * dstStride, dstStride, bits, 0, nullptr, nullptr);
+			}
+		}
+		if (errBuf && err == CL_SUCCESS) {
+			err = cl.clEnqueueReadBuffer(cl_queue, errBuf, CL_FALSE, 0, sizeof(errFlag), &errFlag, 0, nullptr, nullptr);
+		}
+
+		// Wait for the reads to finish, even if one of them failed.
+		if (cl.clFinish(cl_queue) != CL_SUCCESS || err != CL_SUCCESS) {
+			ret = -EIO;
+		} else if (errFlag != 0) {
+			// Invalid BC7 block mode.
+			ret = -EINVAL;
+		}
+	}
+
+	if (errBuf) {
+		cl.clReleaseMemObject(errBuf);
+	}
+	cl.clReleaseMemObject(dstBuf);
+	cl.clReleaseMemObject(srcBuf);
+	return ret;
+}
+
+/**
+ * Decode a block-compressed image on the GPU.
+ * @param fmt		[in] Block format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer.
+ * @param img_siz	[in] Size of image data.
+ * @return rp_image, or nullptr if the image should be decoded on the CPU.
+ */
+rp_image *ImageDecoderPrivate::gpuDecode_int(GpuFormat fmt, int width, int height,
+	const uint8_t *img_buf, int img_siz)
+{
+	assert(fmt >= GpuFormat::DXT1 && fmt < GpuFormat::Max);
+	if (fmt < GpuFormat::DXT1 || fmt >= GpuFormat::Max)
+		return nullptr;
+	const GpuFormatInfo &info = gpuFormatInfo[static_cast<size_t>(fmt)];
+
+	// If decoding was cancelled, let the CPU decoder handle it.
+	if (CancelToken::isCurrentCancelled()) {
+		return nullptr;
+	}
+
+	// Images may have a partial last tile.
+	const int physWidth = ALIGN_BYTES(4, width);
+	const int physHeight = ALIGN_BYTES(4, height);
+	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
+	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
+	if (static_cast<size_t>(img_siz) < static_cast<size_t>(tilesX) * tilesY * info.blockSize) {
+		return nullptr;
+	}
+
+	// If another thread is using the GPU, decode
+	// this image on the CPU instead of waiting.
+	// NOTE: ATOMIC_CMPXCHG() returns the initial value.
+	const int wasBusy = ATOMIC_CMPXCHG(&gpuBusy, 0, 1);
+	if (wasBusy != 0) {
+		return nullptr;
+	}
+
+	if (gpuState == GpuState::Uninitialized) {
+		gpuState = (gpuInit() == 0 ? GpuState::Ready : GpuState::Unavailable);
+	}
+	if (gpuState != GpuState::Ready) {
+		// OpenCL is not available.
+		ATOMIC_EXCHANGE(&gpuBusy, 0);
+		return nullptr;
+	}
+
+	rp_image *img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
+	if (!img->isValid() || gpuRunKernel(info, tilesX, tilesY, img_buf, img) != 0) {
+		// Could not allocate the image, or GPU decoding failed.
+		img->unref();
+		img = nullptr;
+	}
+	ATOMIC_EXCHANGE(&gpuBusy, 0);
+	if (!img) {
+		return nullptr;
+	}
+
+	if (width < physWidth || height < physHeight) {
+		// Shrink the image.
+		img->shrink(width, height);
+	}
+
+	// Set the sBIT metadata.
+	img->set_sBIT(&info.sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+#else /* !ENABLE_GPU_DECODE */
+
+rp_image *ImageDecoderPrivate::gpuDecode_int(GpuFormat fmt, int width, int height,
+	const uint8_t *img_buf, int img_siz)
+{
+	// GPU decoding is not available in this build.
+	RP_UNUSED(fmt);
+	RP_UNUSED(width);
+	RP_UNUSED(height);
+	RP_UNUSED(img_buf);
+	RP_UNUSED(img_siz);
+	return nullptr;
+}
+
+#endif /* ENABLE_GPU_DECODE */
+
+namespace ImageDecoder {
+
+/**
+ * Enable or disable GPU decoding of large block-compressed images.
+ *
+ * If enabled, S3TC, BC4, BC5, BC7, ETC1, and ETC2 images with at
+ * least 2048x2048 pixels are decoded using OpenCL if a GPU device
+ * is available. If OpenCL can't be initialized, if the GPU is
+ * busy with another image, or if GPU decoding fails, the image
+ * is decoded on the CPU.
+ *
+ * GPU decoding is disabled by default, since loading the OpenCL
+ * driver is expensive and isn't allowed by the seccomp filters
+ * used by some frontends.
+ *
+ * @param enabled True to enable; false to disable.
+ */
+void setGpuDecodeEnabled(bool enabled)
+{
+	ImageDecoderPrivate::gpuDecodeEnabled = enabled;
+}
+
+/**
+ * Is GPU decoding of large block-compressed images enabled?
+ * NOTE: This doesn't check if OpenCL is actually available.
+ * @return True if enabled; false if not.
+ */
+bool isGpuDecodeEnabled(void)
+{
+	return ImageDecoderPrivate::gpuDecodeEnabled;
+}
+
+}
+
+}
@@ -0,0 +1,726 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_OpenCL_kernels.h: OpenCL kernels for block decoding.       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_DECODER_IMAGEDECODER_OPENCL_KERNELS_H__
+#define __ROMPROPERTIES_LIBRPTEXTURE_DECODER_IMAGEDECODER_OPENCL_KERNELS_H__
+
+// OpenCL C source code for the GPU block decoders.
+// Each work-item decodes one 4x4 block and writes it to a linear
+// ARGB32 image buffer. The global work size is (tilesX, tilesY).
+//
+// The kernels are ports of the CPU decoders and must produce
+// identical output. If a CPU decoder is changed, the
+// corresponding kernel must be updated as well.
+//
+// NOTE: MSVC limits string literals to 16 KB, so the source code
+// is split into multiple strings. All of the strings are passed
+// to clCreateProgramWithSource() as a single program.
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/** Common functions; S3TC (DXT1, DXT3, DXT5, BC4, BC5) **/
+static const char ocl_src_s3tc[] = R"CLC(
+/* Read little-endian and big-endian values. */
+uint ld_le16(__global const uchar *p)
+{
+	return p[0] | ((uint)p[1] << 8);
+}
+
+uint ld_le32(__global const uchar *p)
+{
+	return p[0] | ((uint)p[1] << 8) | ((uint)p[2] << 16) | ((uint)p[3] << 24);
+}
+
+ulong ld_le64(__global const uchar *p)
+{
+	return (ulong)ld_le32(p) | ((ulong)ld_le32(p + 4) << 32);
+}
+
+uint ld_be16(__global const uchar *p)
+{
+	return ((uint)p[0] << 8) | p[1];
+}
+
+ulong ld_be64(__global const uchar *p)
+{
+	return ((ulong)p[0] << 56) | ((ulong)p[1] << 48) | ((ulong)p[2] << 40) | ((ulong)p[3] << 32) |
+	       ((ulong)p[4] << 24) | ((ulong)p[5] << 16) | ((ulong)p[6] << 8) | (ulong)p[7];
+}
+
+/* Get the source block for this work-item. */
+__global const uchar *get_block(__global const uchar *src, uint blockSize)
+{
+	const uint blk = ((uint)get_global_id(1) * (uint)get_global_size(0)) + (uint)get_global_id(0);
+	return src + (blk * blockSize);
+}
+
+/* Store a 4x4 tile in the destination image. */
+void store_tile(__global uint *dst, const uint *tile)
+{
+	const uint stride = (uint)get_global_size(0) * 4;
+	__global uint *row = dst + ((uint)get_global_id(1) * 4 * stride) + ((uint)get_global_id(0) * 4);
+	for (uint i = 0; i < 16; i += 4, row += stride) {
+		row[0] = tile[i+0];
+		row[1] = tile[i+1];
+		row[2] = tile[i+2];
+		row[3] = tile[i+3];
+	}
+}
+
+uint rgb565_to_argb32(uint px16)
+{
+	uint px32 = 0xFF000000U;
+	px32 |= ((px16 << 8) & 0xF80000) | ((px16 << 3) & 0x0000F8);
+	px32 |=  (px32 >> 5) & 0x070007;
+	px32 |= ((px16 << 5) & 0x00FC00) | ((px16 >> 1) & 0x000300);
+	return px32;
+}
+
+/* (2*a + b) / 3 for each color channel. Alpha is set to 0xFF. */
+uint mix_2_1(uint a, uint b)
+{
+	const uint r = ((2 * ((a >> 16) & 0xFF)) + ((b >> 16) & 0xFF)) / 3;
+	const uint g = ((2 * ((a >>  8) & 0xFF)) + ((b >>  8) & 0xFF)) / 3;
+	const uint bl = ((2 * (a & 0xFF)) + (b & 0xFF)) / 3;
+	return 0xFF000000U | (r << 16) | (g << 8) | bl;
+}
+
+/* (a + b) / 2 for each color channel. Alpha is set to 0xFF. */
+uint mix_1_1(uint a, uint b)
+{
+	const uint r = (((a >> 16) & 0xFF) + ((b >> 16) & 0xFF)) / 2;
+	const uint g = (((a >>  8) & 0xFF) + ((b >>  8) & 0xFF)) / 2;
+	const uint bl = ((a & 0xFF) + (b & 0xFF)) / 2;
+	return 0xFF000000U | (r << 16) | (g << 8) | bl;
+}
+
+/* Decode a DXTn tile color palette. */
+void dxtn_palette(uint *pal, __global const uchar *blk, uint color3_alpha)
+{
+	const uint c0 = ld_le16(blk);
+	const uint c1 = ld_le16(blk + 2);
+	pal[0] = rgb565_to_argb32(c0);
+	pal[1] = rgb565_to_argb32(c1);
+	if (c0 > c1) {
+		pal[2] = mix_2_1(pal[0], pal[1]);
+		pal[3] = mix_2_1(pal[1], pal[0]);
+	} else {
+		pal[2] = mix_1_1(pal[0], pal[1]);
+		pal[3] = (color3_alpha ? 0 : 0xFF000000U);
+	}
+}
+
+/* Decode a DXT5-style alpha value. (Also used by BC4 and BC5.) */
+uint dxt5_alpha(uint code, uint a0, uint a1)
+{
+	if (code == 0) {
+		return a0;
+	} else if (code == 1) {
+		return a1;
+	}
+
+	if (a0 > a1) {
+		return (((8 - code) * a0) + ((code - 1) * a1)) / 7;
+	} else if (code < 6) {
+		return (((6 - code) * a0) + ((code - 1) * a1)) / 5;
+	}
+	return (code == 6 ? 0 : 255);
+}
+
+__kernel void decode_dxt1(__global const uchar *src, __global uint *dst, uint color3_alpha)
+{
+	__global const uchar *const blk = get_block(src, 8);
+	uint pal[4];
+	dxtn_palette(pal, blk, color3_alpha);
+
+	uint tile[16];
+	uint indexes = ld_le32(blk + 4);
+	for (uint i = 0; i < 16; i++, indexes >>= 2) {
+		tile[i] = pal[indexes & 3];
+	}
+	store_tile(dst, tile);
+}
+
+__kernel void decode_dxt3(__global const uchar *src, __global uint *dst)
+{
+	__global const uchar *const blk = get_block(src, 16);
+	uint pal[4];
+	dxtn_palette(pal, blk + 8, 0);
+
+	uint tile[16];
+	uint indexes = ld_le32(blk + 12);
+	ulong alpha = ld_le64(blk);
+	for (uint i = 0; i < 16; i++, indexes >>= 2, alpha >>= 4) {
+		const uint a4 = (uint)(alpha & 0xF);
+		tile[i] = (pal[indexes & 3] & 0x00FFFFFF) | (((a4 << 4) | a4) << 24);
+	}
+	store_tile(dst, tile);
+}
+
+__kernel void decode_dxt5(__global const uchar *src, __global uint *dst)
+{
+	__global const uchar *const blk = get_block(src, 16);
+	uint pal[4];
+	dxtn_palette(pal, blk + 8, 0);
+
+	uint tile[16];
+	uint indexes = ld_le32(blk + 12);
+	ulong alpha48 = ld_le64(blk) >> 16;
+	for (uint i = 0; i < 16; i++, indexes >>= 2, alpha48 >>= 3) {
+		const uint a = dxt5_alpha((uint)(alpha48 & 7), blk[0], blk[1]);
+		tile[i] = (pal[indexes & 3] & 0x00FFFFFF) | (a << 24);
+	}
+	store_tile(dst, tile);
+}
+
+__kernel void decode_bc4(__global const uchar *src, __global uint *dst)
+{
+	__global const uchar *const blk = get_block(src, 8);
+
+	uint tile[16];
+	ulong red48 = ld_le64(blk) >> 16;
+	for (uint i = 0; i < 16; i++, red48 >>= 3) {
+		const uint r = dxt5_alpha((uint)(red48 & 7), blk[0], blk[1]);
+		tile[i] = 0xFF000000U | (r << 16);
+	}
+	store_tile(dst, tile);
+}
+
+__kernel void decode_bc5(__global const uchar *src, __global uint *dst)
+{
+	__global const uchar *const blk = get_block(src, 16);
+
+	uint tile[16];
+	ulong red48   = ld_le64(blk) >> 16;
+	ulong green48 = ld_le64(blk + 8) >> 16;
+	for (uint i = 0; i < 16; i++, red48 >>= 3, green48 >>= 3) {
+		const uint r = dxt5_alpha((uint)(red48   & 7), blk[0], blk[1]);
+		const uint g = dxt5_alpha((uint)(green48 & 7), blk[8], blk[9]);
+		tile[i] = 0xFF000000U | (r << 16) | (g << 8);
+	}
+	store_tile(dst, tile);
+}
+)CLC";
+
+/** BC7 **/
+static const char ocl_src_bc7[] = R"CLC(
+__constant uchar bc7_weight2[4] = {0, 21, 43, 64};
+__constant uchar bc7_weight3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+__constant uchar bc7_weight4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+__constant uint bc7_2sub[64] = {
+	0x50505050, 0x40404040, 0x54545454, 0x54505040, 0x50404000, 0x55545450, 0x55545040, 0x54504000,
+	0x50400000, 0x55555450, 0x55544000, 0x54400000, 0x55555440, 0x55550000, 0x55555500, 0x55000000,
+	0x55150100, 0x00004054, 0x15010000, 0x00405054, 0x00004050, 0x15050100, 0x05010000, 0x40505054,
+	0x00404050, 0x05010100, 0x14141414, 0x05141450, 0x01155440, 0x00555500, 0x15014054, 0x05414150,
+	0x44444444, 0x55005500, 0x11441144, 0x05055050, 0x05500550, 0x11114444, 0x41144114, 0x44111144,
+	0x15055054, 0x01055040, 0x05041050, 0x05455150, 0x14414114, 0x50050550, 0x41411414, 0x00141400,
+	0x00041504, 0x00105410, 0x10541000, 0x04150400, 0x50410514, 0x41051450, 0x05415014, 0x14054150,
+	0x41050514, 0x41505014, 0x40011554, 0x54150140, 0x50505500, 0x00555050, 0x15151010, 0x54540404
+};
+
+__constant uint bc7_3sub[64] = {
+	0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+	0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+	0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+	0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+	0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+	0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+	0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+	0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254
+};
+
+__constant uchar bc7_anchor_2of2[64] = {
+	15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+	15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+	15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+	 6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15
+};
+
+__constant uchar bc7_anchor_2of3[64] = {
+	 3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+	 3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+	 8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+	 3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3
+};
+
+__constant uchar bc7_anchor_3of3[64] = {
+	15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+	15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+	15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+	15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8
+};
+
+/* Mode properties. (Same as BC7Mode<> in ImageDecoder_BC7.cpp.) */
+/* subsets, partBits, rotBits, idxSelBits, epBits, alphaBits, pbits, idxBits, idx2Bits */
+/* pbits: 0 == none, 1 == shared, 2 == unique */
+__constant uchar bc7_modes[8][9] = {
+	{3, 4, 0, 0, 4, 0, 2, 3, 0},
+	{2, 6, 0, 0, 6, 0, 1, 3, 0},
+	{3, 6, 0, 0, 5, 0, 0, 2, 0},
+	{2, 6, 0, 0, 7, 0, 2, 2, 0},
+	{1, 0, 2, 1, 5, 6, 0, 2, 3},
+	{1, 0, 2, 0, 7, 8, 0, 2, 2},
+	{1, 0, 0, 0, 7, 7, 2, 4, 0},
+	{2, 6, 0, 0, 5, 5, 2, 2, 0}
+};
+
+void bc7_rshift128(ulong *msb, ulong *lsb, uint shamt)
+{
+	if (shamt == 0)
+		return;
+	*lsb = (*lsb >> shamt) | (*msb << (64 - shamt));
+	*msb >>= shamt;
+}
+
+void bc7_interpolate(uint *pal, uint bits, uint e0, uint e1)
+{
+	__constant uchar *const weights = (bits == 2 ? bc7_weight2 : (bits == 3 ? bc7_weight3 : bc7_weight4));
+	for (uint i = 0; i < (1U << bits); i++) {
+		const uint w = weights[i];
+		uint px = 0;
+		for (uint shift = 0; shift < 32; shift += 8) {
+			const uint c0 = (e0 >> shift) & 0xFF;
+			const uint c1 = (e1 >> shift) & 0xFF;
+			px |= ((((64 - w) * c0) + (w * c1) + 32) >> 6) << shift;
+		}
+		pal[i] = px;
+	}
+}
+
+void bc7_indexes(uchar *idx, uint bits, ulong idxData, uint anchorMask)
+{
+	const uint index_mask = (1U << bits) - 1;
+	for (uint i = 0; i < 16; i++, anchorMask >>= 1) {
+		if (anchorMask & 1) {
+			idx[i] = (uchar)(idxData & (index_mask >> 1));
+			idxData >>= (bits - 1);
+		} else {
+			idx[i] = (uchar)(idxData & index_mask);
+			idxData >>= bits;
+		}
+	}
+}
+
+void bc7_rotate(uint *tile, uint rotation)
+{
+	for (uint i = 0; i < 16; i++) {
+		const uint px = tile[i];
+		switch (rotation & 3) {
+			default:
+				break;
+			case 1:
+				tile[i] = (px & 0x0000FFFF) | ((px << 8) & 0xFF000000) | ((px >> 8) & 0x00FF0000);
+				break;
+			case 2:
+				tile[i] = (px & 0x00FF00FF) | ((px << 16) & 0xFF000000) | ((px >> 16) & 0x0000FF00);
+				break;
+			case 3:
+				tile[i] = (px & 0x00FFFF00) | (px << 24) | (px >> 24);
+				break;
+		}
+	}
+}
+
+int bc7_get_mode(uint byte0)
+{
+	for (int mode = 0; mode < 8; mode++) {
+		if (byte0 & (1U << mode))
+			return mode;
+	}
+	return -1;
+}
+
+/* Decode a BC7 block. Returns 0 on success; -1 if the mode is invalid. */
+int bc7_decode_block(uint *tile, ulong lsb, ulong msb)
+{
+	const int mode = bc7_get_mode((uint)(lsb & 0xFF));
+	if (mode < 0)
+		return -1;
+
+	__constant uchar *const M = bc7_modes[mode];
+	const uint subsetCount = M[0], partBits = M[1], rotBits = M[2], idxSelBits = M[3];
+	const uint epBits = M[4], alphaBits = M[5], pbits = M[6], idxBits = M[7], idx2Bits = M[8];
+	const uint epCount = subsetCount * 2;
+
+	bc7_rshift128(&msb, &lsb, mode + 1);
+
+	uint rotation = 0;
+	if (rotBits != 0) {
+		rotation = (uint)(lsb & 3);
+		bc7_rshift128(&msb, &lsb, rotBits);
+	}
+
+	uint idxMode_m4 = 0;
+	if (idxSelBits != 0) {
+		idxMode_m4 = (uint)(lsb & 1);
+		bc7_rshift128(&msb, &lsb, idxSelBits);
+	}
+
+	uint subset = 0;
+	uint anchorMask = 1;
+	if (partBits != 0) {
+		const uint partition = (uint)(lsb & ((1U << partBits) - 1));
+		bc7_rshift128(&msb, &lsb, partBits);
+		if (subsetCount == 2) {
+			subset = bc7_2sub[partition];
+			anchorMask |= (1U << bc7_anchor_2of2[partition]);
+		} else {
+			subset = bc7_3sub[partition];
+			anchorMask |= (1U << bc7_anchor_2of3[partition]) |
+				      (1U << bc7_anchor_3of3[partition]);
+		}
+	}
+
+	/* Endpoints: [i][0] == R, [i][1] == G, [i][2] == B, [i][3] == A */
+	uint endpoints[6][4];
+	const uint endpoint_mask = (1U << epBits) - 1;
+	for (uint c = 0; c < 3; c++) {
+		for (uint i = 0; i < epCount; i++) {
+			endpoints[i][c] = ((uint)lsb & endpoint_mask) << (8 - epBits);
+			bc7_rshift128(&msb, &lsb, epBits);
+		}
+	}
+	for (uint i = 0; i < epCount; i++) {
+		endpoints[i][3] = 0;
+	}
+	if (alphaBits != 0) {
+		const uint alpha_mask = (1U << alphaBits) - 1;
+		for (uint i = 0; i < epCount; i++) {
+			endpoints[i][3] = ((uint)lsb & alpha_mask) << (8 - alphaBits);
+			bc7_rshift128(&msb, &lsb, alphaBits);
+		}
+	}
+
+	uint endpoint_bits = epBits;
+	uint alpha_bits = alphaBits;
+	if (pbits == 1) {
+		/* One P-bit per subset. */
+		const uint p_ep = 1U << (7 - epBits);
+		for (uint s = 0; s < subsetCount; s++) {
+			if (lsb & (1U << s)) {
+				for (uint c = 0; c < 3; c++) {
+					endpoints[s*2][c] |= p_ep;
+					endpoints[s*2+1][c] |= p_ep;
+				}
+			}
+		}
+		bc7_rshift128(&msb, &lsb, subsetCount);
+		endpoint_bits++;
+	} else if (pbits == 2) {
+		/* One P-bit per endpoint. */
+		const uint p_ep = 1U << (7 - epBits);
+		const uint p_a = (alphaBits != 0) ? (1U << (7 - alphaBits)) : 0;
+		for (uint i = 0; i < epCount; i++) {
+			if (lsb & (1U << i)) {
+				endpoints[i][0] |= p_ep;
+				endpoints[i][1] |= p_ep;
+				endpoints[i][2] |= p_ep;
+				endpoints[i][3] |= p_a;
+			}
+		}
+		bc7_rshift128(&msb, &lsb, epCount);
+		endpoint_bits++;
+		if (alphaBits != 0) {
+			alpha_bits++;
+		}
+	}
+
+	uint ep32[6];
+	for (uint i = 0; i < epCount; i++) {
+		uint r = endpoints[i][0], g = endpoints[i][1], b = endpoints[i][2];
+		if (endpoint_bits < 8) {
+			r |= (r >> endpoint_bits);
+			g |= (g >> endpoint_bits);
+			b |= (b >> endpoint_bits);
+		}
+		uint a = 255;
+		if (alphaBits != 0) {
+			a = endpoints[i][3];
+			if (alpha_bits < 8) {
+				a |= (a >> alpha_bits);
+			}
+		}
+		ep32[i] = (a << 24) | (r << 16) | (g << 8) | b;
+	}
+
+	uchar idx[16];
+	if (idx2Bits != 0) {
+		/* Separate color and alpha indexes. (Modes 4 and 5) */
+		uint pal[8], pal_a[8];
+		uchar idx_a[16];
+		if (mode == 4) {
+			const ulong idxData2 = lsb & ((1U << 31) - 1);
+			const ulong idxData3 = (msb << 33) | (lsb >> 31);
+			if (idxMode_m4) {
+				bc7_interpolate(pal, 3, ep32[0], ep32[1]);
+				bc7_interpolate(pal_a, 2, ep32[0], ep32[1]);
+				bc7_indexes(idx, 3, idxData3, anchorMask);
+				bc7_indexes(idx_a, 2, idxData2, anchorMask);
+			} else {
+				bc7_interpolate(pal, 2, ep32[0], ep32[1]);
+				bc7_interpolate(pal_a, 3, ep32[0], ep32[1]);
+				bc7_indexes(idx, 2, idxData2, anchorMask);
+				bc7_indexes(idx_a, 3, idxData3, anchorMask);
+			}
+		} else {
+			bc7_interpolate(pal, 2, ep32[0], ep32[1]);
+			bc7_interpolate(pal_a, 2, ep32[0], ep32[1]);
+			bc7_indexes(idx, 2, lsb, anchorMask);
+			bc7_indexes(idx_a, 2, lsb >> 31, anchorMask);
+		}
+
+		for (uint i = 0; i < 16; i++) {
+			tile[i] = (pal[idx[i]] & 0x00FFFFFF) | (pal_a[idx_a[i]] & 0xFF000000);
+		}
+		bc7_rotate(tile, rotation);
+		return 0;
+	}
+
+	/* Shared color and alpha indexes. */
+	uint pal[3][16];
+	for (uint s = 0; s < subsetCount; s++) {
+		bc7_interpolate(pal[s], idxBits, ep32[s*2], ep32[s*2+1]);
+	}
+	bc7_indexes(idx, idxBits, lsb, anchorMask);
+	for (uint i = 0; i < 16; i++, subset >>= 2) {
+		tile[i] = pal[subset & 3][idx[i]];
+	}
+	return 0;
+}
+
+__kernel void decode_bc7(__global const uchar *src, __global uint *dst, __global int *err)
+{
+	__global const uchar *const blk = get_block(src, 16);
+
+	uint tile[16];
+	if (bc7_decode_block(tile, ld_le64(blk), ld_le64(blk + 8)) != 0) {
+		/* Invalid block mode. */
+		*err = 1;
+		return;
+	}
+	store_tile(dst, tile);
+}
+)CLC";
+
+/** ETC1, ETC2 **/
+static const char ocl_src_etc[] = R"CLC(
+/* Intensity modifiers, in two-bit pixel index order. */
+__constant short etc1_intensity[8][4] = {
+	{ 2,   8,  -2,   -8}, { 5,  17,  -5,  -17}, { 9,  29,  -9,  -29}, {13,  42, -13,  -42},
+	{18,  60, -18,  -60}, {24,  80, -24,  -80}, {33, 106, -33, -106}, {47, 183, -47, -183}
+};
+
+/* Intensity modifiers for ETC2 punchthrough alpha. (opaque bit == 0) */
+__constant short etc2_intensity_a1[8][4] = {
+	{0,   8, 0,   -8}, {0,  17, 0,  -17}, {0,  29, 0,  -29}, {0,  42, 0,  -42},
+	{0,  60, 0,  -60}, {0,  80, 0,  -80}, {0, 106, 0, -106}, {0, 183, 0, -183}
+};
+
+__constant uchar etc1_mapping[16] = {0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15};
+__constant uint etc1_subblock_mapping[2] = {0xFF00, 0xCCCC};
+__constant int etc1_3bit_diff_tbl[8] = {0, 1, 2, 3, -4, -3, -2, -1};
+__constant uchar etc2_dist_tbl[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+__constant short etc2_alpha_tbl[16][8] = {
+	{-3, -6,  -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+	{-2, -5,  -8, -13, 1, 4, 7, 12}, {-2, -4,  -6, -13, 1, 3, 5, 12},
+	{-3, -6,  -8, -12, 2, 5, 7, 11}, {-3, -7,  -9, -11, 2, 6, 8, 10},
+	{-4, -7,  -8, -11, 3, 6, 7, 10}, {-3, -5,  -8, -11, 2, 4, 7, 10},
+	{-2, -6,  -8, -10, 1, 5, 7,  9}, {-2, -5,  -8, -10, 1, 4, 7,  9},
+	{-2, -4,  -8, -10, 1, 3, 7,  9}, {-2, -5,  -7, -10, 1, 4, 6,  9},
+	{-3, -4,  -7, -10, 2, 3, 6,  9}, {-1, -2,  -3, -10, 0, 1, 2,  9},
+	{-4, -6,  -8,  -9, 3, 5, 7,  8}, {-3, -5,  -7,  -9, 2, 4, 6,  8}
+};
+
+/* Mode flags. */
+#define ETC_MODE_ETC2	1U	/* ETC2 block modes */
+#define ETC_MODE_A1	2U	/* ETC2 punchthrough alpha */
+#define ETC_MODE_ALPHA	4U	/* ETC2 RGBA (separate alpha block) */
+
+/* Extend color components to 8-bit. (Same truncation as the CPU decoder.) */
+int etc_ext4(int v) { const uint u = (uint)v & 0xFF; return (int)(((u << 4) | u) & 0xFF); }
+int etc_ext5(int v) { const uint u = (uint)v & 0xFF; return (int)(((u << 3) | (u >> 2)) & 0xFF); }
+int etc_ext6(int v) { const uint u = (uint)v & 0xFF; return (int)(((u << 2) | (u >> 4)) & 0xFF); }
+int etc_ext7(int v) { const uint u = (uint)v & 0xFF; return (int)(((u << 1) | (u >> 6)) & 0xFF); }
+
+int etc_clamp(int c) { return (c > 255 ? 255 : (c > 0 ? c : 0)); }
+
+uint etc_rgb(int r, int g, int b)
+{
+	return 0xFF000000U | ((uint)etc_clamp(r) << 16) | ((uint)etc_clamp(g) << 8) | (uint)etc_clamp(b);
+}
+
+/* Decode an ETC1/ETC2 RGB block. */
+void etc_decode_rgb(uint *tile, __global const uchar *p, uint mode)
+{
+	const uint R = p[0], G = p[1], B = p[2], control = p[3];
+	const uint a1_transparent = ((mode & ETC_MODE_A1) && !(control & 0x02));
+
+	/* Block mode: 0 == ETC1, 1 == 'T' or 'H', 2 == 'Planar' */
+	uint block_mode = 0;
+	int base[3][3];
+	uint paint[4];
+
+	if (!(mode & ETC_MODE_A1) && !(control & 0x02)) {
+		/* Individual mode. */
+		base[0][0] = etc_ext4(R >> 4);
+		base[0][1] = etc_ext4(G >> 4);
+		base[0][2] = etc_ext4(B >> 4);
+		base[1][0] = etc_ext4(R & 0x0F);
+		base[1][1] = etc_ext4(G & 0x0F);
+		base[1][2] = etc_ext4(B & 0x0F);
+	} else {
+		const int sR = (int)(R >> 3) + etc1_3bit_diff_tbl[R & 0x07];
+		const int sG = (int)(G >> 3) + etc1_3bit_diff_tbl[G & 0x07];
+		const int sB = (int)(B >> 3) + etc1_3bit_diff_tbl[B & 0x07];
+		uint etc2_mode = 0;
+
+		if (mode & ETC_MODE_ETC2) {
+			if ((sR & ~0x1F) != 0) {
+				/* 'T' mode. */
+				etc2_mode = 1;
+				const int r0 = etc_ext4(((R & 0x18) >> 1) | (R & 0x03));
+				const int g0 = etc_ext4(G >> 4);
+				const int b0 = etc_ext4(G & 0x0F);
+				const int r1 = etc_ext4(B >> 4);
+				const int g1 = etc_ext4(B & 0x0F);
+				const int b1 = etc_ext4(control >> 4);
+				const int d = etc2_dist_tbl[((control & 0x0C) >> 1) | (control & 0x01)];
+				paint[0] = etc_rgb(r0, g0, b0);
+				paint[1] = etc_rgb(r1 + d, g1 + d, b1 + d);
+				paint[2] = etc_rgb(r1, g1, b1);
+				paint[3] = etc_rgb(r1 - d, g1 - d, b1 - d);
+			} else if ((sG & ~0x1F) != 0) {
+				/* 'H' mode. */
+				etc2_mode = 1;
+				const int r0 = etc_ext4(R >> 3);
+				const int g0 = etc_ext4(((R & 0x07) << 1) | ((G >> 4) & 0x01));
+				const int b0 = etc_ext4((G & 0x08) | ((G & 0x03) << 1) | (B >> 7));
+				const int r1 = etc_ext4(B >> 3);
+				const int g1 = etc_ext4(((B & 0x07) << 1) | (control >> 7));
+				const int b1 = etc_ext4((control >> 3) & 0x0F);
+				uint d_idx = (control & 0x04) | ((control & 0x01) << 1);
+				d_idx |= (etc_rgb(r0, g0, b0) >= etc_rgb(r1, g1, b1));
+				const int d = etc2_dist_tbl[d_idx];
+				paint[0] = etc_rgb(r0 + d, g0 + d, b0 + d);
+				paint[1] = etc_rgb(r0 - d, g0 - d, b0 - d);
+				paint[2] = etc_rgb(r1 + d, g1 + d, b1 + d);
+				paint[3] = etc_rgb(r1 - d, g1 - d, b1 - d);
+			} else if ((sB & ~0x1F) != 0) {
+				/* 'Planar' mode. */
+				etc2_mode = 2;
+				const uint p4 = p[4], p5 = p[5], p6 = p[6], p7 = p[7];
+				base[0][0] = etc_ext6((R >> 1) & 0x3F);
+				base[0][1] = etc_ext7(((R << 6) & 0x40) | ((G >> 1) & 0x3F));
+				base[0][2] = etc_ext6(((G << 5) & 0x20) | (B & 0x18) | ((B << 1) & 0x06) | (control >> 7));
+				base[1][0] = etc_ext6(((control >> 1) & 0x3C) | (control & 0x01));
+				base[1][1] = etc_ext7(p4 >> 1);
+				base[1][2] = etc_ext6(((p4 << 5) & 0x20) | (p5 >> 3));
+				base[2][0] = etc_ext6(((p5 << 3) & 0x38) | (p6 >> 5));
+				base[2][1] = etc_ext7(((p6 << 2) & 0x7C) | (p7 >> 6));
+				base[2][2] = etc_ext6(p7 & 0x3F);
+			}
+		}
+
+		if (etc2_mode == 0) {
+			/* ETC1 differential mode. */
+			base[0][0] = etc_ext5(R >> 3);
+			base[0][1] = etc_ext5(G >> 3);
+			base[0][2] = etc_ext5(B >> 3);
+			base[1][0] = etc_ext5(sR);
+			base[1][1] = etc_ext5(sG);
+			base[1][2] = etc_ext5(sB);
+		}
+		block_mode = etc2_mode;
+	}
+
+	uint px_msb = ld_be16(p + 4);
+	uint px_lsb = ld_be16(p + 6);
+	if (block_mode == 0) {
+		/* ETC1 block mode. */
+		__constant short *tbl0;
+		__constant short *tbl1;
+		if (a1_transparent) {
+			tbl0 = etc2_intensity_a1[control >> 5];
+			tbl1 = etc2_intensity_a1[(control >> 2) & 0x07];
+		} else {
+			tbl0 = etc1_intensity[control >> 5];
+			tbl1 = etc1_intensity[(control >> 2) & 0x07];
+		}
+
+		uint subblock = etc1_subblock_mapping[control & 0x01];
+		for (uint i = 0; i < 16; i++, px_msb >>= 1, px_lsb >>= 1, subblock >>= 1) {
+			const uint px_idx = ((px_msb & 1) << 1) | (px_lsb & 1);
+			if (a1_transparent && px_idx == 2) {
+				tile[etc1_mapping[i]] = 0;
+				continue;
+			}
+			const uint cur_sub = subblock & 1;
+			const int adj = (cur_sub ? tbl1[px_idx] : tbl0[px_idx]);
+			tile[etc1_mapping[i]] = etc_rgb(base[cur_sub][0] + adj, base[cur_sub][1] + adj, base[cur_sub][2] + adj);
+		}
+	} else if (block_mode == 1) {
+		/* ETC2 'T' or 'H' mode. */
+		for (uint i = 0; i < 16; i++, px_msb >>= 1, px_lsb >>= 1) {
+			const uint px_idx = ((px_msb & 1) << 1) | (px_lsb & 1);
+			if (a1_transparent && px_idx == 2) {
+				tile[etc1_mapping[i]] = 0;
+				continue;
+			}
+			tile[etc1_mapping[i]] = paint[px_idx];
+		}
+	} else {
+		/* ETC2 'Planar' mode. */
+		for (uint i = 0; i < 16; i++) {
+			const int pX = (int)(i / 4);
+			const int pY = (int)(i % 4);
+			int c[3];
+			for (uint j = 0; j < 3; j++) {
+				c[j] = ((pX * (base[1][j] - base[0][j])) +
+					(pY * (base[2][j] - base[0][j])) +
+					(4 * base[0][j]) + 2) >> 2;
+			}
+			tile[etc1_mapping[i]] = etc_rgb(c[0], c[1], c[2]);
+		}
+	}
+}
+
+/* Decode an ETC2 alpha block. */
+void etc2_decode_alpha(uint *tile, __global const uchar *p)
+{
+	const int base = p[0];
+	const int mult = p[1] >> 4;
+	__constant short *const tbl = etc2_alpha_tbl[p[1] & 0x0F];
+
+	ulong alpha48 = ld_be64(p) & 0x0000FFFFFFFFFFFFUL;
+	for (uint i = 0; i < 16; i++, alpha48 <<= 3) {
+		const int A = etc_clamp(base + (tbl[(uint)(alpha48 >> 45) & 0x07] * mult));
+		const uint j = etc1_mapping[i];
+		tile[j] = (tile[j] & 0x00FFFFFF) | ((uint)A << 24);
+	}
+}
+
+__kernel void decode_etc(__global const uchar *src, __global uint *dst, uint mode)
+{
+	uint tile[16];
+	if (mode & ETC_MODE_ALPHA) {
+		__global const uchar *const blk = get_block(src, 16);
+		etc_decode_rgb(tile, blk + 8, mode);
+		etc2_decode_alpha(tile, blk);
+	} else {
+		__global const uchar *const blk = get_block(src, 8);
+		etc_decode_rgb(tile, blk, mode);
+	}
+	store_tile(dst, tile);
+}
+)CLC";
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_DECODER_IMAGEDECODER_OPENCL_KERNELS_H__ */
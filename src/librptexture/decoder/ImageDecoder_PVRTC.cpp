@@ -35,6 +35,7 @@ rp_image *fromPVRTC(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	uint8_t mode)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -111,6 +112,7 @@ rp_image *fromPVRTCII(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	uint8_t mode)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -0,0 +1,510 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_Region.cpp: Image decoding functions. (S3TC regions)       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+
+#include "ImageDecoder.hpp"
+#include "ImageDecoder_p.hpp"
+
+#include "ImageDecoder_S3TC_p.hpp"
+
+// C++ STL classes.
+using std::unique_ptr;
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+// DXT3 block format.
+struct dxt3_block {
+	uint64_t alpha;		// Alpha values. (4-bit per pixel)
+	dxt1_block colors;	// DXT1-style color block.
+};
+ASSERT_STRUCT(dxt3_block, 16);
+
+// DXT5 block format.
+struct dxt5_block {
+	dxt5_alpha alpha;
+	dxt1_block colors;	// DXT1-style color block.
+};
+ASSERT_STRUCT(dxt5_block, 16);
+
+// BC5 block format.
+struct bc5_block {
+	dxt5_alpha red;
+	dxt5_alpha green;
+};
+ASSERT_STRUCT(bc5_block, 16);
+
+/**
+ * Get the size of a block for the specified block format.
+ * @param fmt Block format.
+ * @return Block size, in bytes, or 0 if the format is invalid.
+ */
+static inline unsigned int blockSize(BlockFormat fmt)
+{
+	switch (fmt) {
+		case BLKF_DXT1:
+		case BLKF_DXT1_A1:
+		case BLKF_BC4:
+			return 8;
+		case BLKF_DXT3:
+		case BLKF_DXT5:
+		case BLKF_BC5:
+			return 16;
+		default:
+			return 0;
+	}
+}
+
+/**
+ * Decode a single 4x4 block.
+ * This matches the output of the full-image S3TC decoders.
+ * @param fmt		[in] Block format.
+ * @param tileBuf	[out] Tile buffer. (16 pixels)
+ * @param src		[in] Block data.
+ */
+static void decodeBlock(BlockFormat fmt, uint32_t *RESTRICT tileBuf, const uint8_t *RESTRICT src)
+{
+	switch (fmt) {
+		default:
+			assert(!"Unsupported block format.");
+			break;
+
+		case BLKF_DXT1:
+		case BLKF_DXT1_A1: {
+			const dxt1_block *const dxt1_src = reinterpret_cast<const dxt1_block*>(src);
+			argb32_t pal[4];
+			if (fmt == BLKF_DXT1_A1) {
+				decode_DXTn_tile_color_palette_S3TC<DXTn_PALETTE_COLOR3_ALPHA>(pal, dxt1_src);
+			} else {
+				decode_DXTn_tile_color_palette_S3TC<0>(pal, dxt1_src);
+			}
+
+			uint32_t indexes = le32_to_cpu(dxt1_src->indexes);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2) {
+				tileBuf[i] = pal[indexes & 3].u32;
+			}
+			break;
+		}
+
+		case BLKF_DXT3: {
+			const dxt3_block *const dxt3_src = reinterpret_cast<const dxt3_block*>(src);
+			argb32_t pal[4];
+			// NOTE: Same palette handling as fromDXT3().
+			decode_DXTn_tile_color_palette_S3TC<0>(pal, &dxt3_src->colors);
+
+			uint32_t indexes = le32_to_cpu(dxt3_src->colors.indexes);
+			uint64_t alpha = le64_to_cpu(dxt3_src->alpha);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha >>= 4) {
+				argb32_t color = pal[indexes & 3];
+				color.a = (alpha & 0xF) | ((alpha & 0xF) << 4);
+				tileBuf[i] = color.u32;
+			}
+			break;
+		}
+
+		case BLKF_DXT5: {
+			const dxt5_block *const dxt5_src = reinterpret_cast<const dxt5_block*>(src);
+			argb32_t pal[4];
+			decode_DXTn_tile_color_palette_S3TC<0>(pal, &dxt5_src->colors);
+
+			uint64_t alpha48 = extract48(&dxt5_src->alpha);
+			uint32_t indexes = le32_to_cpu(dxt5_src->colors.indexes);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha48 >>= 3) {
+				argb32_t color = pal[indexes & 3];
+				color.a = decode_DXT5_alpha_S3TC(alpha48 & 7, dxt5_src->alpha.values);
+				tileBuf[i] = color.u32;
+			}
+			break;
+		}
+
+		case BLKF_BC4: {
+			const dxt5_alpha *const bc4_src = reinterpret_cast<const dxt5_alpha*>(src);
+			uint64_t red48 = extract48(bc4_src);
+
+			argb32_t color;
+			color.u32 = 0xFF000000;	// opaque black
+			for (unsigned int i = 0; i < 16; i++, red48 >>= 3) {
+				color.r = decode_DXT5_alpha_S3TC(red48 & 7, bc4_src->values);
+				tileBuf[i] = color.u32;
+			}
+			break;
+		}
+
+		case BLKF_BC5: {
+			const bc5_block *const bc5_src = reinterpret_cast<const bc5_block*>(src);
+			uint64_t red48   = extract48(&bc5_src->red);
+			uint64_t green48 = extract48(&bc5_src->green);
+
+			argb32_t color;
+			color.u32 = 0xFF000000;	// opaque black
+			for (unsigned int i = 0; i < 16; i++, red48 >>= 3, green48 >>= 3) {
+				color.r = decode_DXT5_alpha_S3TC(red48   & 7, bc5_src->red.values);
+				color.g = decode_DXT5_alpha_S3TC(green48 & 7, bc5_src->green.values);
+				tileBuf[i] = color.u32;
+			}
+			break;
+		}
+	}
+}
+
+/**
+ * Get the sBIT metadata for the specified block format.
+ * @param fmt Block format.
+ * @return sBIT metadata.
+ */
+static const rp_image::sBIT_t *blockFormat_sBIT(BlockFormat fmt)
+{
+	// NOTE: These match the full-image S3TC decoders.
+	static const rp_image::sBIT_t sBIT_DXT1 = {8,8,8,0,1};
+	static const rp_image::sBIT_t sBIT_DXT3 = {8,8,8,0,4};
+	static const rp_image::sBIT_t sBIT_DXT5 = {8,8,8,0,8};
+	static const rp_image::sBIT_t sBIT_BC4  = {8,1,1,0,0};
+	static const rp_image::sBIT_t sBIT_BC5  = {8,8,1,0,0};
+
+	switch (fmt) {
+		default:
+		case BLKF_DXT1:
+		case BLKF_DXT1_A1:
+			return &sBIT_DXT1;
+		case BLKF_DXT3:
+			return &sBIT_DXT3;
+		case BLKF_DXT5:
+			return &sBIT_DXT5;
+		case BLKF_BC4:
+			return &sBIT_BC4;
+		case BLKF_BC5:
+			return &sBIT_BC5;
+	}
+}
+
+/**
+ * Verify the parameters for a block-compressed image.
+ * @param fmt		[in] Block format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer.
+ * @param img_siz	[in] Size of image data.
+ * @return Block size on success; 0 on error.
+ */
+static unsigned int verifyBlockImage(BlockFormat fmt, int width, int height,
+	const uint8_t *img_buf, int img_siz)
+{
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(fmt >= 0 && fmt < BLKF_MAX);
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    fmt < 0 || fmt >= BLKF_MAX)
+	{
+		return 0;
+	}
+
+	// Some container formats allow the last tile to be cut off,
+	// so round up for the physical tile size.
+	const unsigned int bsz = blockSize(fmt);
+	const int64_t tilesX = ALIGN_BYTES(4, static_cast<int64_t>(width)) / 4;
+	const int64_t tilesY = ALIGN_BYTES(4, static_cast<int64_t>(height)) / 4;
+	if (img_siz < 0 || tilesX * tilesY * bsz > static_cast<int64_t>(img_siz)) {
+		return 0;
+	}
+	return bsz;
+}
+
+/**
+ * Decode a rectangular region of a block-compressed image
+ * into a caller-provided ARGB32 buffer.
+ *
+ * Only the blocks that intersect the region are decoded.
+ * To stream an image in strips, decode full-width regions
+ * that are a multiple of 4 pixels high.
+ *
+ * @param fmt		[in] Block format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer.
+ * @param img_siz	[in] Size of image data.
+ * @param x		[in] Region X position.
+ * @param y		[in] Region Y position.
+ * @param w		[in] Region width.
+ * @param h		[in] Region height.
+ * @param dest		[out] ARGB32 destination buffer. [must have h rows of w pixels]
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int decodeBlockRegion(BlockFormat fmt, int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	int x, int y, int w, int h,
+	uint32_t *RESTRICT dest, int dest_stride)
+{
+	const unsigned int bsz = verifyBlockImage(fmt, width, height, img_buf, img_siz);
+	if (bsz == 0) {
+		return -EINVAL;
+	}
+
+	// Verify the region.
+	assert(dest != nullptr);
+	assert(x >= 0 && y >= 0 && w > 0 && h > 0);
+	assert(x + w <= width && y + h <= height);
+	assert(dest_stride >= static_cast<int>(w * sizeof(uint32_t)));
+	if (!dest || x < 0 || y < 0 || w <= 0 || h <= 0 ||
+	    w > width - x || h > height - y ||
+	    dest_stride < static_cast<int>(w * sizeof(uint32_t)))
+	{
+		return -EINVAL;
+	}
+
+	const unsigned int tilesX = static_cast<unsigned int>(ALIGN_BYTES(4, width) / 4);
+	const int dest_stride_px = dest_stride / sizeof(uint32_t);
+
+	// Temporary tile buffer.
+	uint32_t tileBuf[4*4];
+
+	const int tx0 = x / 4, tx1 = (x + w - 1) / 4;
+	const int ty0 = y / 4, ty1 = (y + h - 1) / 4;
+	for (int ty = ty0; ty <= ty1; ty++) {
+		const uint8_t *src = img_buf + ((static_cast<size_t>(ty) * tilesX + tx0) * bsz);
+
+		// Rows of this tile that are within the region.
+		const int py0 = std::max(y, ty * 4);
+		const int py1 = std::min(y + h, (ty * 4) + 4);
+
+		for (int tx = tx0; tx <= tx1; tx++, src += bsz) {
+			decodeBlock(fmt, tileBuf, src);
+
+			// Columns of this tile that are within the region.
+			const int px0 = std::max(x, tx * 4);
+			const int px1 = std::min(x + w, (tx * 4) + 4);
+			const size_t len = (px1 - px0) * sizeof(uint32_t);
+
+			uint32_t *destRow = dest + ((py0 - y) * dest_stride_px) + (px0 - x);
+			for (int py = py0; py < py1; py++, destRow += dest_stride_px) {
+				memcpy(destRow, &tileBuf[((py & 3) * 4) + (px0 & 3)], len);
+			}
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Convert a rectangular region of a block-compressed image to rp_image.
+ * @param fmt		[in] Block format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer.
+ * @param img_siz	[in] Size of image data.
+ * @param x		[in] Region X position.
+ * @param y		[in] Region Y position.
+ * @param w		[in] Region width.
+ * @param h		[in] Region height.
+ * @return rp_image containing the region, or nullptr on error.
+ */
+rp_image *fromBlockRegion(BlockFormat fmt, int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	int x, int y, int w, int h)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	if (verifyBlockImage(fmt, width, height, img_buf, img_siz) == 0 ||
+	    x < 0 || y < 0 || w <= 0 || h <= 0 ||
+	    w > width - x || h > height - y)
+	{
+		return nullptr;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(w, h, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	int ret = decodeBlockRegion(fmt, width, height, img_buf, img_siz,
+		x, y, w, h, static_cast<uint32_t*>(img->bits()), img->stride());
+	if (ret != 0) {
+		img->unref();
+		return nullptr;
+	}
+
+	// Set the sBIT metadata.
+	img->set_sBIT(blockFormat_sBIT(fmt));
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Box filter table entry.
+ * Source pixels [i0, i1) map to a single destination pixel.
+ */
+struct box_t {
+	int i0;
+	int i1;
+};
+
+/**
+ * Calculate a box filter table.
+ * This matches rp_image::scaled() with SCALE_BOX when downscaling.
+ * @param tbl		[out] Table. (must have dest_len entries)
+ * @param dest_len	[in] Destination length.
+ * @param src_len	[in] Source length. (must be >= dest_len)
+ */
+static void calc_box_table(box_t *tbl, int dest_len, int src_len)
+{
+	for (int i = 0; i < dest_len; i++, tbl++) {
+		tbl->i0 = static_cast<int>((static_cast<int64_t>(i) * src_len) / dest_len);
+		tbl->i1 = static_cast<int>((static_cast<int64_t>(i + 1) * src_len) / dest_len);
+	}
+}
+
+/**
+ * Convert a block-compressed image to a downscaled rp_image.
+ *
+ * The image is decoded one row of blocks at a time and
+ * box-filtered into the destination image, so the full-size
+ * image is never allocated. The result is identical to
+ * decoding the full image and calling scaled() with SCALE_BOX.
+ *
+ * If the destination is larger than the source in either
+ * dimension, the full image is decoded and then scaled.
+ *
+ * @param fmt		[in] Block format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image buffer.
+ * @param img_siz	[in] Size of image data.
+ * @param dest_width	[in] Destination width.
+ * @param dest_height	[in] Destination height.
+ * @return Downscaled ARGB32 rp_image, or nullptr on error.
+ */
+rp_image *fromBlockScaled(BlockFormat fmt, int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	int dest_width, int dest_height)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	const unsigned int bsz = verifyBlockImage(fmt, width, height, img_buf, img_siz);
+	assert(dest_width > 0);
+	assert(dest_height > 0);
+	if (bsz == 0 || dest_width <= 0 || dest_height <= 0) {
+		return nullptr;
+	}
+
+	if (dest_width > width || dest_height > height ||
+	    (dest_width == width && dest_height == height))
+	{
+		// Not downscaling. Decode the full image.
+		rp_image *const full = fromBlockRegion(fmt, width, height,
+			img_buf, img_siz, 0, 0, width, height);
+		if (!full || (dest_width == width && dest_height == height)) {
+			return full;
+		}
+		rp_image *const img = full->scaled(dest_width, dest_height, rp_image::SCALE_BOX);
+		full->unref();
+		return img;
+	}
+
+	// Create the destination image.
+	rp_image *const img = new rp_image(dest_width, dest_height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	unique_ptr<box_t[]> xtbl(new box_t[dest_width]);
+	unique_ptr<box_t[]> ytbl(new box_t[dest_height]);
+	calc_box_table(xtbl.get(), dest_width, width);
+	calc_box_table(ytbl.get(), dest_height, height);
+
+	// Strip buffer: one row of blocks. (4 rows of pixels)
+	// Sums are 64-bit, so there's no limit on the box size.
+	const int physWidth = ALIGN_BYTES(4, width);
+	unique_ptr<uint32_t[]> strip(new uint32_t[physWidth * 4]);
+	unique_ptr<uint64_t[]> sums(new uint64_t[dest_width * 4]);
+	memset(sums.get(), 0, dest_width * 4 * sizeof(uint64_t));
+
+	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
+	const uint8_t *src = img_buf;
+
+	uint32_t tileBuf[4*4];
+	int dy = 0;
+	for (int sy0 = 0; sy0 < height; sy0 += 4) {
+		// Decode a row of blocks into the strip buffer.
+		for (unsigned int tx = 0; tx < tilesX; tx++, src += bsz) {
+			decodeBlock(fmt, tileBuf, src);
+			for (unsigned int row = 0; row < 4; row++) {
+				memcpy(&strip[(row * physWidth) + (tx * 4)], &tileBuf[row * 4], 4 * sizeof(uint32_t));
+			}
+		}
+
+		// Filtering is done on premultiplied ARGB32 in order to
+		// prevent colors from transparent pixels from bleeding in.
+		const int rows = std::min(4, height - sy0);
+		for (int row = 0; row < rows; row++) {
+			uint32_t *const line = &strip[row * physWidth];
+			for (int sx = 0; sx < width; sx++) {
+				line[sx] = rp_image::premultiply_pixel(line[sx]);
+			}
+
+			// Add this line to the destination row's sums.
+			uint64_t *pSum = sums.get();
+			for (int dx = 0; dx < dest_width; dx++, pSum += 4) {
+				const box_t &tx = xtbl[dx];
+				unsigned int sum_b = 0, sum_g = 0, sum_r = 0, sum_a = 0;
+				for (int sx = tx.i0; sx < tx.i1; sx++) {
+					argb32_t px;
+					px.u32 = line[sx];
+					sum_b += px.b;
+					sum_g += px.g;
+					sum_r += px.r;
+					sum_a += px.a;
+				}
+				pSum[0] += sum_b;
+				pSum[1] += sum_g;
+				pSum[2] += sum_r;
+				pSum[3] += sum_a;
+			}
+
+			const int sy = sy0 + row;
+			const box_t &ty = ytbl[dy];
+			if (sy + 1 < ty.i1) {
+				// More source lines for this destination row.
+				continue;
+			}
+
+			// Destination row is complete.
+			const uint64_t box_h = ty.i1 - ty.i0;
+			uint32_t *const dest = static_cast<uint32_t*>(img->scanLine(dy));
+			pSum = sums.get();
+			for (int dx = 0; dx < dest_width; dx++, pSum += 4) {
+				const uint64_t n = box_h * (xtbl[dx].i1 - xtbl[dx].i0);
+				argb32_t px;
+				px.b = static_cast<uint8_t>((pSum[0] + (n / 2)) / n);
+				px.g = static_cast<uint8_t>((pSum[1] + (n / 2)) / n);
+				px.r = static_cast<uint8_t>((pSum[2] + (n / 2)) / n);
+				px.a = static_cast<uint8_t>((pSum[3] + (n / 2)) / n);
+				dest[dx] = px.u32;
+			}
+			memset(sums.get(), 0, dest_width * 4 * sizeof(uint64_t));
+			dy++;
+		}
+	}
+	assert(dy == dest_height);
+
+	img->un_premultiply();
+
+	// Set the sBIT metadata.
+	img->set_sBIT(blockFormat_sBIT(fmt));
+
+	// Image has been converted.
+	return img;
+}
+
+} }
@@ -11,8 +11,7 @@
 #include "ImageDecoder.hpp"
 #include "ImageDecoder_p.hpp"
 
-#include "PixelConversion.hpp"
-using namespace LibRpTexture::PixelConversion;
+#include "ImageDecoder_S3TC_p.hpp"
 
 // References:
 // - http://www.matejtomcik.com/Public/KnowHow/DXTDecompression/
@@ -28,158 +27,6 @@ using namespace LibRpTexture::PixelConversion;
 
 namespace LibRpTexture { namespace ImageDecoder {
 
-// DXT1 block format.
-struct dxt1_block {
-	uint16_t color[2];	// Colors 0 and 1, in RGB565 format.
-	uint32_t indexes;	// Two-bit color indexes.
-};
-ASSERT_STRUCT(dxt1_block, 8);
-
-// DXT5 alpha+codes struct.
-// Also used by BC4/BC5 for color channels.
-union dxt5_alpha {
-	struct {
-		uint8_t values[2];	// Alpha values.
-		uint8_t codes[6];	// Alpha operation codes. (48-bit unsigned; 3-bit per pixel)
-	};
-	uint64_t u64;	// Access the 48-bit code value directly. (Requires shifting.)
-};
-
-/**
- * Extract the 48-bit code value from dxt5_alpha.
- * @param data dxt5_alpha.
- * @return 48-bit code value.
- */
-static FORCEINLINE uint64_t extract48(const dxt5_alpha *RESTRICT data)
-{
-	// codes[6] starts at 0x02 within dxt5_alpha.
-	// Hence, we need to lshift it after byteswapping.
-	// TODO: constexpr?
-	return le64_to_cpu(data->u64) >> 16;
-}
-
-// decode_DXTn_tile_color_palette flags.
-enum DXTn_Palette_Flags {
-	DXTn_PALETTE_BIG_ENDIAN		= (1U << 0),
-	DXTn_PALETTE_COLOR3_ALPHA	= (1U << 1),	// GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
-	DXTn_PALETTE_COLOR0_LE_COLOR1	= (1U << 2),	// Assume color0 <= color1. (DXT2/DXT3)
-};
-
-/**
- * Decode a DXTn tile color palette. (S3TC version)
- * @tparam flags Flags. (See DXTn_Palette_Flags)
- * @param pal		[out] Array of four argb32_t values.
- * @param dxt1_src	[in] DXT1 block.
- */
-template<unsigned int flags>
-static inline void decode_DXTn_tile_color_palette_S3TC(argb32_t *RESTRICT pal, const dxt1_block *RESTRICT dxt1_src)
-{
-	// Convert the first two colors from RGB565.
-	uint16_t c0, c1;
-	if (flags & DXTn_PALETTE_BIG_ENDIAN) {
-		c0 = be16_to_cpu(dxt1_src->color[0]);
-		c1 = be16_to_cpu(dxt1_src->color[1]);
-	} else {
-		c0 = le16_to_cpu(dxt1_src->color[0]);
-		c1 = le16_to_cpu(dxt1_src->color[1]);
-	}
-	pal[0].u32 = RGB565_to_ARGB32(c0);
-	pal[1].u32 = RGB565_to_ARGB32(c1);
-
-	// Calculate the second two colors.
-	if (!(flags & DXTn_PALETTE_COLOR0_LE_COLOR1) && (c0 > c1)) {
-		// color0 > color1
-		pal[2].r = ((2 * pal[0].r) + pal[1].r) / 3;
-		pal[2].g = ((2 * pal[0].g) + pal[1].g) / 3;
-		pal[2].b = ((2 * pal[0].b) + pal[1].b) / 3;
-		pal[2].a = 0xFF;
-
-		pal[3].r = ((2 * pal[1].r) + pal[0].r) / 3;
-		pal[3].g = ((2 * pal[1].g) + pal[0].g) / 3;
-		pal[3].b = ((2 * pal[1].b) + pal[0].b) / 3;
-		pal[3].a = 0xFF;
-	} else {
-		// color0 <= color1
-		pal[2].r = (pal[0].r + pal[1].r) / 2;
-		pal[2].g = (pal[0].g + pal[1].g) / 2;
-		pal[2].b = (pal[0].b + pal[1].b) / 2;
-		pal[2].a = 0xFF;
-
-		// Black and/or transparent.
-		pal[3].u32 = ((flags & DXTn_PALETTE_COLOR3_ALPHA) ? 0x00000000 : 0xFF000000);
-	}
-}
-
-/**
- * Decode the DXT5 alpha channel value. (S3TC version)
- * @param a3	3-bit alpha selector code.
- * @param alpha	2-element alpha array from dxt5_block.
- * @return Alpha channel value.
- */
-static inline uint8_t decode_DXT5_alpha_S3TC(unsigned int a3, const uint8_t *RESTRICT alpha)
-{
-	unsigned int a_ret = 255;
-
-	if (alpha[0] > alpha[1]) {
-		switch (a3 & 7) {
-			case 0:
-				a_ret = alpha[0];
-				break;
-			case 1:
-				a_ret = alpha[1];
-				break;
-			case 2:
-				a_ret = ((6 * alpha[0]) + (1 * alpha[1])) / 7;
-				break;
-			case 3:
-				a_ret = ((5 * alpha[0]) + (2 * alpha[1])) / 7;
-				break;
-			case 4:
-				a_ret = ((4 * alpha[0]) + (3 * alpha[1])) / 7;
-				break;
-			case 5:
-				a_ret = ((3 * alpha[0]) + (4 * alpha[1])) / 7;
-				break;
-			case 6:
-				a_ret = ((2 * alpha[0]) + (5 * alpha[1])) / 7;
-				break;
-			case 7:
-				a_ret = ((1 * alpha[0]) + (6 * alpha[1])) / 7;
-				break;
-		}
-	} else {
-		switch (a3 & 7) {
-			case 0:
-				a_ret = alpha[0];
-				break;
-			case 1:
-				a_ret = alpha[1];
-				break;
-			case 2:
-				a_ret = ((4 * alpha[0]) + (1 * alpha[1])) / 5;
-				break;
-			case 3:
-				a_ret = ((3 * alpha[0]) + (2 * alpha[1])) / 5;
-				break;
-			case 4:
-				a_ret = ((2 * alpha[0]) + (3 * alpha[1])) / 5;
-				break;
-			case 5:
-				a_ret = ((1 * alpha[0]) + (4 * alpha[1])) / 5;
-				break;
-			case 6:
-				a_ret = 0;
-				break;
-			case 7:
-				a_ret = 255;
-				break;
-		}
-	}
-
-	// Prevent overflow.
-	return static_cast<uint8_t>(a_ret > 255 ? 255 : a_ret);
-}
-
 /**
  * Convert a GameCube DXT1 image to rp_image.
  * The GameCube variant has 2x2 block tiling in addition to 4x4 pixel tiling.
@@ -194,6 +41,7 @@ static inline uint8_t decode_DXT5_alpha_S3TC(unsigned int a3, const uint8_t *RES
 rp_image *fromDXT1_GCN(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -276,7 +124,7 @@ rp_image *fromDXT1_GCN(int width, int height,
  * @return rp_image, or nullptr on error.
  */
 template<unsigned int palflags>
-static rp_image *T_fromDXT1(int width, int height,
+static rp_image *T_fromDXT1_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
 	// Verify parameters.
@@ -297,6 +145,16 @@ static rp_image *T_fromDXT1(int width, int height,
 		return nullptr;
 	}
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		(palflags & DXTn_PALETTE_COLOR3_ALPHA)
+			? ImageDecoderPrivate::GpuFormat::DXT1_A1
+			: ImageDecoderPrivate::GpuFormat::DXT1,
+		width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -305,30 +163,43 @@ static rp_image *T_fromDXT1(int width, int height,
 		return nullptr;
 	}
 
-	const dxt1_block *dxt1_src = reinterpret_cast<const dxt1_block*>(img_buf);
+	const dxt1_block *const dxt1_src_start = reinterpret_cast<const dxt1_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
 
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, dxt1_src++) {
-		// Decode the DXT1 tile palette.
-		argb32_t pal[4];
-		decode_DXTn_tile_color_palette_S3TC<palflags>(pal, dxt1_src);
+		const dxt1_block *dxt1_src = &dxt1_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, dxt1_src++) {
+			// Decode the DXT1 tile palette.
+			argb32_t pal[4];
+			decode_DXTn_tile_color_palette_S3TC<palflags>(pal, dxt1_src);
 
-		// Process the 16 color indexes.
-		uint32_t indexes = le32_to_cpu(dxt1_src->indexes);
-		for (unsigned int i = 0; i < 16; i++, indexes >>= 2) {
-			tileBuf[i] = pal[indexes & 3].u32;
-		}
+			// Process the 16 color indexes.
+			uint32_t indexes = le32_to_cpu(dxt1_src->indexes);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2) {
+				tileBuf[i] = pal[indexes & 3].u32;
+			}
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
@@ -353,10 +224,11 @@ static rp_image *T_fromDXT1(int width, int height,
  * @param img_siz Size of image data. [must be >= (w*h)/2]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromDXT1(int width, int height,
+rp_image *fromDXT1_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
-	return T_fromDXT1<0>(width, height, img_buf, img_siz);
+	RP_TRACE_ZONE(__func__);
+	return T_fromDXT1_cpp<0>(width, height, img_buf, img_siz);
 }
 
 /**
@@ -369,10 +241,11 @@ rp_image *fromDXT1(int width, int height,
  * @param img_siz Size of image data. [must be >= (w*h)/2]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromDXT1_A1(int width, int height,
+rp_image *fromDXT1_A1_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
-	return T_fromDXT1<DXTn_PALETTE_COLOR3_ALPHA>(width, height, img_buf, img_siz);
+	RP_TRACE_ZONE(__func__);
+	return T_fromDXT1_cpp<DXTn_PALETTE_COLOR3_ALPHA>(width, height, img_buf, img_siz);
 }
 
 /**
@@ -386,6 +259,7 @@ rp_image *fromDXT1_A1(int width, int height,
 rp_image *fromDXT2(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// TODO: Completely untested. Needs testing!
 
 	// Use fromDXT3(), then convert from premultiplied alpha
@@ -412,9 +286,10 @@ rp_image *fromDXT2(int width, int height,
  * @param img_siz Size of image data. [must be >= (w*h)]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromDXT3(int width, int height,
+rp_image *fromDXT3_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -433,6 +308,13 @@ rp_image *fromDXT3(int width, int height,
 		return nullptr;
 	}
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::DXT3, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -447,37 +329,50 @@ rp_image *fromDXT3(int width, int height,
 		dxt1_block colors;	// DXT1-style color block.
 	};
 	ASSERT_STRUCT(dxt3_block, 16);
-	const dxt3_block *dxt3_src = reinterpret_cast<const dxt3_block*>(img_buf);
+	const dxt3_block *const dxt3_src_start = reinterpret_cast<const dxt3_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, dxt3_src++) {
-		// Decode the DXT3 tile palette.
-		argb32_t pal[4];
-		// FIXME: DXTn_PALETTE_COLOR0_LE_COLOR1 seems to result in garbage pixels.
-		// https://github.com/kchapelier/decode-dxt/tree/master/lib has similar code
-		// but handles DXT3 like both DXT1 and DXT5, so disable this for now.
-		decode_DXTn_tile_color_palette_S3TC<0/*DXTn_PALETTE_COLOR0_LE_COLOR1*/>(pal, &dxt3_src->colors);
-
-		// Process the 16 color indexes and apply alpha.
-		uint32_t indexes = le32_to_cpu(dxt3_src->colors.indexes);
-		uint64_t alpha = le64_to_cpu(dxt3_src->alpha);
-		for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha >>= 4) {
-			argb32_t color = pal[indexes & 3];
-			// TODO: Verify alpha value handling for DXT3.
-			color.a = (alpha & 0xF) | ((alpha & 0xF) << 4);
-			tileBuf[i] = color.u32;
-		}
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+		const dxt3_block *dxt3_src = &dxt3_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, dxt3_src++) {
+			// Decode the DXT3 tile palette.
+			argb32_t pal[4];
+			// FIXME: DXTn_PALETTE_COLOR0_LE_COLOR1 seems to result in garbage pixels.
+			// https://github.com/kchapelier/decode-dxt/tree/master/lib has similar code
+			// but handles DXT3 like both DXT1 and DXT5, so disable this for now.
+			decode_DXTn_tile_color_palette_S3TC<0/*DXTn_PALETTE_COLOR0_LE_COLOR1*/>(pal, &dxt3_src->colors);
+
+			// Process the 16 color indexes and apply alpha.
+			uint32_t indexes = le32_to_cpu(dxt3_src->colors.indexes);
+			uint64_t alpha = le64_to_cpu(dxt3_src->alpha);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha >>= 4) {
+				argb32_t color = pal[indexes & 3];
+				// TODO: Verify alpha value handling for DXT3.
+				color.a = (alpha & 0xF) | ((alpha & 0xF) << 4);
+				tileBuf[i] = color.u32;
+			}
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
@@ -503,6 +398,7 @@ rp_image *fromDXT3(int width, int height,
 rp_image *fromDXT4(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// TODO: Completely untested. Needs testing!
 
 	// Use fromDXT5(), then convert from premultiplied alpha
@@ -529,9 +425,10 @@ rp_image *fromDXT4(int width, int height,
  * @param img_siz Size of image data. [must be >= (w*h)]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromDXT5(int width, int height,
+rp_image *fromDXT5_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -550,6 +447,13 @@ rp_image *fromDXT5(int width, int height,
 		return nullptr;
 	}
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::DXT5, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -564,36 +468,49 @@ rp_image *fromDXT5(int width, int height,
 		dxt1_block colors;	// DXT1-style color block.
 	};
 	ASSERT_STRUCT(dxt5_block, 16);
-	const dxt5_block *dxt5_src = reinterpret_cast<const dxt5_block*>(img_buf);
+	const dxt5_block *const dxt5_src_start = reinterpret_cast<const dxt5_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, dxt5_src++) {
-		// Decode the DXT5 tile palette.
-		argb32_t pal[4];
-		decode_DXTn_tile_color_palette_S3TC<0>(pal, &dxt5_src->colors);
-
-		// Get the DXT5 alpha codes.
-		uint64_t alpha48 = extract48(&dxt5_src->alpha);
-
-		// Process the 16 color and alpha indexes.
-		uint32_t indexes = le32_to_cpu(dxt5_src->colors.indexes);
-		for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha48 >>= 3) {
-			argb32_t color = pal[indexes & 3];
-			// Decode the alpha channel value.
-			color.a = decode_DXT5_alpha_S3TC(alpha48 & 7, dxt5_src->alpha.values);
-			tileBuf[i] = color.u32;
-		}
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+		const dxt5_block *dxt5_src = &dxt5_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, dxt5_src++) {
+			// Decode the DXT5 tile palette.
+			argb32_t pal[4];
+			decode_DXTn_tile_color_palette_S3TC<0>(pal, &dxt5_src->colors);
+
+			// Get the DXT5 alpha codes.
+			uint64_t alpha48 = extract48(&dxt5_src->alpha);
+
+			// Process the 16 color and alpha indexes.
+			uint32_t indexes = le32_to_cpu(dxt5_src->colors.indexes);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha48 >>= 3) {
+				argb32_t color = pal[indexes & 3];
+				// Decode the alpha channel value.
+				color.a = decode_DXT5_alpha_S3TC(alpha48 & 7, dxt5_src->alpha.values);
+				tileBuf[i] = color.u32;
+			}
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
@@ -616,9 +533,10 @@ rp_image *fromDXT5(int width, int height,
  * @param img_siz Size of image data. [must be >= (w*h)/2]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromBC4(int width, int height,
+rp_image *fromBC4_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -637,6 +555,13 @@ rp_image *fromBC4(int width, int height,
 		return nullptr;
 	}
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::BC4, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -650,36 +575,48 @@ rp_image *fromBC4(int width, int height,
 		dxt5_alpha red;
 	};
 	ASSERT_STRUCT(bc4_block, 8);
-	const bc4_block *bc4_src = reinterpret_cast<const bc4_block*>(img_buf);
+	const bc4_block *const bc4_src_start = reinterpret_cast<const bc4_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
-
-	// S3TC version.
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, bc4_src++) {
-		// BC4 colors are determined using DXT5-style alpha interpolation.
-
-		// Get the BC4 color codes.
-		uint64_t red48 = extract48(&bc4_src->red);
-
-		// Process the 16 color indexes.
-		// NOTE: Using red instead of grayscale here.
-		argb32_t color;
-		color.u32 = 0xFF000000;	// opaque black
-		for (unsigned int i = 0; i < 16; i++, red48 >>= 3) {
-			// Decode the red channel value.
-			color.r = decode_DXT5_alpha_S3TC(red48 & 7, bc4_src->red.values);
-			tileBuf[i] = color.u32;
-		}
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+		const bc4_block *bc4_src = &bc4_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, bc4_src++) {
+			// BC4 colors are determined using DXT5-style alpha interpolation.
+
+			// Get the BC4 color codes.
+			uint64_t red48 = extract48(&bc4_src->red);
+
+			// Process the 16 color indexes.
+			// NOTE: Using red instead of grayscale here.
+			argb32_t color;
+			color.u32 = 0xFF000000;	// opaque black
+			for (unsigned int i = 0; i < 16; i++, red48 >>= 3) {
+				// Decode the red channel value.
+				color.r = decode_DXT5_alpha_S3TC(red48 & 7, bc4_src->red.values);
+				tileBuf[i] = color.u32;
+			}
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
@@ -704,9 +641,10 @@ rp_image *fromBC4(int width, int height,
  * @param img_siz Size of image data. [must be >= (w*h)]
  * @return rp_image, or nullptr on error.
  */
-rp_image *fromBC5(int width, int height,
+rp_image *fromBC5_cpp(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RP_TRACE_ZONE(__func__);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -725,6 +663,13 @@ rp_image *fromBC5(int width, int height,
 		return nullptr;
 	}
 
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::BC5, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
 	// Create an rp_image.
 	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
 	if (!img->isValid()) {
@@ -739,37 +684,49 @@ rp_image *fromBC5(int width, int height,
 		dxt5_alpha green;
 	};
 	ASSERT_STRUCT(bc5_block, 16);
-	const bc5_block *bc5_src = reinterpret_cast<const bc5_block*>(img_buf);
+	const bc5_block *const bc5_src_start = reinterpret_cast<const bc5_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
-
-	// S3TC version.
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, bc5_src++) {
-		// BC5 colors are determined using DXT5-style alpha interpolation.
-
-		// Get the BC5 color codes.
-		uint64_t red48   = extract48(&bc5_src->red);
-		uint64_t green48 = extract48(&bc5_src->green);
-
-		// Process the 16 color indexes.
-		argb32_t color;
-		color.u32 = 0xFF000000;	// opaque black
-		for (unsigned int i = 0; i < 16; i++, red48 >>= 3, green48 >>= 3) {
-			// Decode the red and green channel values.
-			color.r = decode_DXT5_alpha_S3TC(red48   & 7, bc5_src->red.values);
-			color.g = decode_DXT5_alpha_S3TC(green48 & 7, bc5_src->green.values);
-			tileBuf[i] = color.u32;
-		}
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+		const bc5_block *bc5_src = &bc5_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, bc5_src++) {
+			// BC5 colors are determined using DXT5-style alpha interpolation.
+
+			// Get the BC5 color codes.
+			uint64_t red48   = extract48(&bc5_src->red);
+			uint64_t green48 = extract48(&bc5_src->green);
+
+			// Process the 16 color indexes.
+			argb32_t color;
+			color.u32 = 0xFF000000;	// opaque black
+			for (unsigned int i = 0; i < 16; i++, red48 >>= 3, green48 >>= 3) {
+				// Decode the red and green channel values.
+				color.r = decode_DXT5_alpha_S3TC(red48   & 7, bc5_src->red.values);
+				color.g = decode_DXT5_alpha_S3TC(green48 & 7, bc5_src->green.values);
+				tileBuf[i] = color.u32;
+			}
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
@@ -0,0 +1,177 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_S3TC_p.hpp: Image decoding functions. (S3TC) (PRIVATE)     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_DECODER_IMAGEDECODER_S3TC_P_HPP__
+#define __ROMPROPERTIES_LIBRPTEXTURE_DECODER_IMAGEDECODER_S3TC_P_HPP__
+
+#include "common.h"
+#include "byteswap.h"
+#include "../img/rp_image.hpp"
+
+#include "PixelConversion.hpp"
+
+// Block structs and tile palette functions shared by the
+// standard and SIMD-optimized S3TC decoders.
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+// DXT1 block format.
+struct dxt1_block {
+	uint16_t color[2];	// Colors 0 and 1, in RGB565 format.
+	uint32_t indexes;	// Two-bit color indexes.
+};
+ASSERT_STRUCT(dxt1_block, 8);
+
+// DXT5 alpha+codes struct.
+// Also used by BC4/BC5 for color channels.
+union dxt5_alpha {
+	struct {
+		uint8_t values[2];	// Alpha values.
+		uint8_t codes[6];	// Alpha operation codes. (48-bit unsigned; 3-bit per pixel)
+	};
+	uint64_t u64;	// Access the 48-bit code value directly. (Requires shifting.)
+};
+
+/**
+ * Extract the 48-bit code value from dxt5_alpha.
+ * @param data dxt5_alpha.
+ * @return 48-bit code value.
+ */
+static FORCEINLINE uint64_t extract48(const dxt5_alpha *RESTRICT data)
+{
+	// codes[6] starts at 0x02 within dxt5_alpha.
+	// Hence, we need to lshift it after byteswapping.
+	// TODO: constexpr?
+	return le64_to_cpu(data->u64) >> 16;
+}
+
+// decode_DXTn_tile_color_palette flags.
+enum DXTn_Palette_Flags {
+	DXTn_PALETTE_BIG_ENDIAN		= (1U << 0),
+	DXTn_PALETTE_COLOR3_ALPHA	= (1U << 1),	// GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+	DXTn_PALETTE_COLOR0_LE_COLOR1	= (1U << 2),	// Assume color0 <= color1. (DXT2/DXT3)
+};
+
+/**
+ * Decode a DXTn tile color palette. (S3TC version)
+ * @tparam flags Flags. (See DXTn_Palette_Flags)
+ * @param pal		[out] Array of four argb32_t values.
+ * @param dxt1_src	[in] DXT1 block.
+ */
+template<unsigned int flags>
+static inline void decode_DXTn_tile_color_palette_S3TC(argb32_t *RESTRICT pal, const dxt1_block *RESTRICT dxt1_src)
+{
+	// Convert the first two colors from RGB565.
+	uint16_t c0, c1;
+	if (flags & DXTn_PALETTE_BIG_ENDIAN) {
+		c0 = be16_to_cpu(dxt1_src->color[0]);
+		c1 = be16_to_cpu(dxt1_src->color[1]);
+	} else {
+		c0 = le16_to_cpu(dxt1_src->color[0]);
+		c1 = le16_to_cpu(dxt1_src->color[1]);
+	}
+	pal[0].u32 = PixelConversion::RGB565_to_ARGB32(c0);
+	pal[1].u32 = PixelConversion::RGB565_to_ARGB32(c1);
+
+	// Calculate the second two colors.
+	if (!(flags & DXTn_PALETTE_COLOR0_LE_COLOR1) && (c0 > c1)) {
+		// color0 > color1
+		pal[2].r = ((2 * pal[0].r) + pal[1].r) / 3;
+		pal[2].g = ((2 * pal[0].g) + pal[1].g) / 3;
+		pal[2].b = ((2 * pal[0].b) + pal[1].b) / 3;
+		pal[2].a = 0xFF;
+
+		pal[3].r = ((2 * pal[1].r) + pal[0].r) / 3;
+		pal[3].g = ((2 * pal[1].g) + pal[0].g) / 3;
+		pal[3].b = ((2 * pal[1].b) + pal[0].b) / 3;
+		pal[3].a = 0xFF;
+	} else {
+		// color0 <= color1
+		pal[2].r = (pal[0].r + pal[1].r) / 2;
+		pal[2].g = (pal[0].g + pal[1].g) / 2;
+		pal[2].b = (pal[0].b + pal[1].b) / 2;
+		pal[2].a = 0xFF;
+
+		// Black and/or transparent.
+		pal[3].u32 = ((flags & DXTn_PALETTE_COLOR3_ALPHA) ? 0x00000000 : 0xFF000000);
+	}
+}
+
+/**
+ * Decode the DXT5 alpha channel value. (S3TC version)
+ * @param a3	3-bit alpha selector code.
+ * @param alpha	2-element alpha array from dxt5_block.
+ * @return Alpha channel value.
+ */
+static inline uint8_t decode_DXT5_alpha_S3TC(unsigned int a3, const uint8_t *RESTRICT alpha)
+{
+	unsigned int a_ret = 255;
+
+	if (alpha[0] > alpha[1]) {
+		switch (a3 & 7) {
+			case 0:
+				a_ret = alpha[0];
+				break;
+			case 1:
+				a_ret = alpha[1];
+				break;
+			case 2:
+				a_ret = ((6 * alpha[0]) + (1 * alpha[1])) / 7;
+				break;
+			case 3:
+				a_ret = ((5 * alpha[0]) + (2 * alpha[1])) / 7;
+				break;
+			case 4:
+				a_ret = ((4 * alpha[0]) + (3 * alpha[1])) / 7;
+				break;
+			case 5:
+				a_ret = ((3 * alpha[0]) + (4 * alpha[1])) / 7;
+				break;
+			case 6:
+				a_ret = ((2 * alpha[0]) + (5 * alpha[1])) / 7;
+				break;
+			case 7:
+				a_ret = ((1 * alpha[0]) + (6 * alpha[1])) / 7;
+				break;
+		}
+	} else {
+		switch (a3 & 7) {
+			case 0:
+				a_ret = alpha[0];
+				break;
+			case 1:
+				a_ret = alpha[1];
+				break;
+			case 2:
+				a_ret = ((4 * alpha[0]) + (1 * alpha[1])) / 5;
+				break;
+			case 3:
+				a_ret = ((3 * alpha[0]) + (2 * alpha[1])) / 5;
+				break;
+			case 4:
+				a_ret = ((2 * alpha[0]) + (3 * alpha[1])) / 5;
+				break;
+			case 5:
+				a_ret = ((1 * alpha[0]) + (4 * alpha[1])) / 5;
+				break;
+			case 6:
+				a_ret = 0;
+				break;
+			case 7:
+				a_ret = 255;
+				break;
+		}
+	}
+
+	// Prevent overflow.
+	return static_cast<uint8_t>(a_ret > 255 ? 255 : a_ret);
+}
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_DECODER_IMAGEDECODER_S3TC_P_HPP__ */
@@ -0,0 +1,764 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_S3TC.cpp: Image decoding functions. (S3TC)                 *
+ * SSE4.1-optimized version.                                               *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+
+#include "ImageDecoder.hpp"
+#include "ImageDecoder_p.hpp"
+#include "ImageDecoder_S3TC_p.hpp"
+
+// SSE4.1 headers.
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+
+// MSVC complains when the high bit is set in hex values
+// when setting SSE2 registers.
+#ifdef _MSC_VER
+# pragma warning(push)
+# pragma warning(disable: 4309)
+#endif
+
+// The tile palettes are calculated using the same code as the
+// standard version, so the output is identical. SSE4.1 is used
+// to expand the tile indexes:
+// - _mm_mullo_epi32() shifts each pixel's index into the high
+//   bits of its DWORD, since SSE doesn't have per-lane shifts.
+// - _mm_shuffle_epi8() looks up the palette entries.
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/**
+ * Expand 16 2-bit DXTn color indexes using a 4-color tile palette.
+ * @param rows		[out] Four rows of four ARGB32 pixels.
+ * @param pal		[in] Tile palette. (four ARGB32 values)
+ * @param indexes	[in] Color indexes. (host-endian)
+ */
+static FORCEINLINE void expand_DXTn_indexes_sse41(__m128i rows[4], const __m128i &pal, uint32_t indexes)
+{
+	// Multipliers to move each pixel's index into bits 30-31.
+	const __m128i mul0 = _mm_setr_epi32(1U << 30, 1U << 28, 1U << 26, 1U << 24);
+	const __m128i mul1 = _mm_setr_epi32(1U << 22, 1U << 20, 1U << 18, 1U << 16);
+	const __m128i mul2 = _mm_setr_epi32(1U << 14, 1U << 12, 1U << 10, 1U <<  8);
+	const __m128i mul3 = _mm_setr_epi32(1U <<  6, 1U <<  4, 1U <<  2, 1U <<  0);
+
+	// Copy the low byte of each DWORD to the other bytes,
+	// then add the byte offsets within the palette entry.
+	const __m128i dword_bcast = _mm_setr_epi8(0,0,0,0, 4,4,4,4, 8,8,8,8, 12,12,12,12);
+	const __m128i byte_offsets = _mm_set1_epi32(0x03020100);
+
+	const __m128i idx = _mm_set1_epi32(static_cast<int>(indexes));
+#define EXPAND_ROW(n) do { \
+		__m128i sel = _mm_srli_epi32(_mm_mullo_epi32(idx, mul##n), 30); \
+		sel = _mm_shuffle_epi8(_mm_slli_epi32(sel, 2), dword_bcast); \
+		rows[n] = _mm_shuffle_epi8(pal, _mm_add_epi8(sel, byte_offsets)); \
+	} while (0)
+	EXPAND_ROW(0);
+	EXPAND_ROW(1);
+	EXPAND_ROW(2);
+	EXPAND_ROW(3);
+#undef EXPAND_ROW
+}
+
+/**
+ * Expand 16 3-bit DXT5 alpha codes using an 8-value palette.
+ * Also used by BC4/BC5 for color channels.
+ * @param pal		[in] Alpha palette. (eight bytes)
+ * @param codes48	[in] 48-bit alpha codes. (from extract48())
+ * @return 16 alpha values, one byte per pixel.
+ */
+static FORCEINLINE __m128i expand_DXT5_codes_sse41(const __m128i &pal, uint64_t codes48)
+{
+	// Multipliers to move each pixel's code into bits 29-31.
+	// Each 24-bit half of the code value has eight pixels.
+	const __m128i mul_lo = _mm_setr_epi32(1U << 29, 1U << 26, 1U << 23, 1U << 20);
+	const __m128i mul_hi = _mm_setr_epi32(1U << 17, 1U << 14, 1U << 11, 1U <<  8);
+
+	const __m128i c_lo = _mm_set1_epi32(static_cast<int>(codes48 & 0xFFFFFF));
+	const __m128i c_hi = _mm_set1_epi32(static_cast<int>((codes48 >> 24) & 0xFFFFFF));
+
+	const __m128i i0 = _mm_srli_epi32(_mm_mullo_epi32(c_lo, mul_lo), 29);
+	const __m128i i1 = _mm_srli_epi32(_mm_mullo_epi32(c_lo, mul_hi), 29);
+	const __m128i i2 = _mm_srli_epi32(_mm_mullo_epi32(c_hi, mul_lo), 29);
+	const __m128i i3 = _mm_srli_epi32(_mm_mullo_epi32(c_hi, mul_hi), 29);
+
+	// Pack the codes into bytes and look up the values.
+	const __m128i idx = _mm_packus_epi16(_mm_packus_epi32(i0, i1), _mm_packus_epi32(i2, i3));
+	return _mm_shuffle_epi8(pal, idx);
+}
+
+/**
+ * Calculate the 8-value DXT5 alpha palette.
+ * Also used by BC4/BC5 for color channels.
+ * @param values	[in] 2-element alpha array from dxt5_alpha.
+ * @return Alpha palette. (eight bytes)
+ */
+static FORCEINLINE __m128i decode_DXT5_alpha_palette_sse41(const uint8_t *RESTRICT values)
+{
+	uint8_t pal[8];
+	for (unsigned int i = 0; i < 8; i++) {
+		pal[i] = decode_DXT5_alpha_S3TC(i, values);
+	}
+	return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pal));
+}
+
+/**
+ * Get a shuffle mask to move 4 bytes into one byte of each DWORD.
+ * @param row	[in] Row number. (0-3; selects bytes row*4 through row*4+3)
+ * @param pos	[in] Byte position within each DWORD. (0-3)
+ * @return Shuffle mask.
+ */
+static FORCEINLINE __m128i byte_to_dword_mask(unsigned int row, unsigned int pos)
+{
+	// Shuffle mask bytes with the high bit set are zeroed.
+	uint8_t mask[16];
+	memset(mask, 0x80, sizeof(mask));
+	for (unsigned int i = 0; i < 4; i++) {
+		mask[i*4 + pos] = static_cast<uint8_t>(row*4 + i);
+	}
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+/**
+ * Write a 4x4 tile to an rp_image.
+ * @param px_dest	[out] Top-left pixel of the tile.
+ * @param stride_px	[in] Image stride, in pixels.
+ * @param rows		[in] Four rows of four ARGB32 pixels.
+ */
+static FORCEINLINE void store_tile_sse41(uint32_t *px_dest, int stride_px, const __m128i rows[4])
+{
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(px_dest), rows[0]);
+	px_dest += stride_px;
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(px_dest), rows[1]);
+	px_dest += stride_px;
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(px_dest), rows[2]);
+	px_dest += stride_px;
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(px_dest), rows[3]);
+}
+
+/**
+ * Convert a DXT1 image to rp_image.
+ * SSE4.1-optimized version.
+ * @param palflags decode_DXTn_tile_color_palette_S3TC<>() flags.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+template<unsigned int palflags>
+static rp_image *T_fromDXT1_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+
+	// DXT1 uses 4x4 tiles, but some container formats allow
+	// the last tile to be cut off, so round up for the
+	// physical tile size.
+	const int physWidth = ALIGN_BYTES(4, width);
+	const int physHeight = ALIGN_BYTES(4, height);
+
+	assert(img_siz >= ((width * height) / 2));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < ((physWidth * physHeight) / 2))
+	{
+		return nullptr;
+	}
+
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		(palflags & DXTn_PALETTE_COLOR3_ALPHA)
+			? ImageDecoderPrivate::GpuFormat::DXT1_A1
+			: ImageDecoderPrivate::GpuFormat::DXT1,
+		width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	const dxt1_block *const dxt1_src_start = reinterpret_cast<const dxt1_block*>(img_buf);
+
+	// Calculate the total number of tiles.
+	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
+	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
+
+	const int stride_px = img->stride() / sizeof(uint32_t);
+	uint32_t *const bits = static_cast<uint32_t*>(img->bits());
+
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		const dxt1_block *dxt1_src = &dxt1_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+			uint32_t *px_dest = bits + (y * 4 * stride_px);
+			for (unsigned int x = 0; x < tilesX; x++, dxt1_src++, px_dest += 4) {
+				// Decode the DXT1 tile palette.
+				argb32_t pal[4];
+				decode_DXTn_tile_color_palette_S3TC<palflags>(pal, dxt1_src);
+
+				// Process the 16 color indexes and write the tile.
+				__m128i rows[4];
+				expand_DXTn_indexes_sse41(rows,
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(pal)),
+					le32_to_cpu(dxt1_src->indexes));
+				store_tile_sse41(px_dest, stride_px, rows);
+			}
+		}
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
+
+	if (width < physWidth || height < physHeight) {
+		// Shrink the image.
+		img->shrink(width, height);
+	}
+
+	// Set the sBIT metadata.
+	static const rp_image::sBIT_t sBIT = {8,8,8,0,1};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Convert a DXT1 image to rp_image.
+ * SSE4.1-optimized version.
+ * S3TC palette index 3 will be interpreted as black.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromDXT1_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	return T_fromDXT1_sse41<0>(width, height, img_buf, img_siz);
+}
+
+/**
+ * Convert a DXT1 image to rp_image.
+ * SSE4.1-optimized version.
+ * S3TC palette index 3 will be interpreted as fully transparent.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT1 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromDXT1_A1_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	return T_fromDXT1_sse41<DXTn_PALETTE_COLOR3_ALPHA>(width, height, img_buf, img_siz);
+}
+
+/**
+ * Convert a DXT3 image to rp_image.
+ * SSE4.1-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT3 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromDXT3_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+
+	// DXT3 uses 4x4 tiles, but some container formats allow
+	// the last tile to be cut off, so round up for the
+	// physical tile size.
+	const int physWidth = ALIGN_BYTES(4, width);
+	const int physHeight = ALIGN_BYTES(4, height);
+
+	assert(img_siz >= (physWidth * physHeight));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < (physWidth * physHeight))
+	{
+		return nullptr;
+	}
+
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::DXT3, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	// DXT3 block format.
+	struct dxt3_block {
+		uint64_t alpha;		// Alpha values. (4-bit per pixel)
+		dxt1_block colors;	// DXT1-style color block.
+	};
+	ASSERT_STRUCT(dxt3_block, 16);
+	const dxt3_block *const dxt3_src_start = reinterpret_cast<const dxt3_block*>(img_buf);
+
+	// Calculate the total number of tiles.
+	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
+	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
+
+	const int stride_px = img->stride() / sizeof(uint32_t);
+	uint32_t *const bits = static_cast<uint32_t*>(img->bits());
+
+	const __m128i Mask_RGB = _mm_set1_epi32(0x00FFFFFF);
+	const __m128i Mask_Nyb = _mm_set1_epi8(0x0F);
+	const __m128i mask_a0 = byte_to_dword_mask(0, 3);
+	const __m128i mask_a1 = byte_to_dword_mask(1, 3);
+	const __m128i mask_a2 = byte_to_dword_mask(2, 3);
+	const __m128i mask_a3 = byte_to_dword_mask(3, 3);
+
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		const dxt3_block *dxt3_src = &dxt3_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+			uint32_t *px_dest = bits + (y * 4 * stride_px);
+			for (unsigned int x = 0; x < tilesX; x++, dxt3_src++, px_dest += 4) {
+				// Decode the DXT3 tile palette.
+				// FIXME: DXTn_PALETTE_COLOR0_LE_COLOR1 seems to result in garbage pixels.
+				// (See fromDXT3_cpp().)
+				argb32_t pal[4];
+				decode_DXTn_tile_color_palette_S3TC<0/*DXTn_PALETTE_COLOR0_LE_COLOR1*/>(pal, &dxt3_src->colors);
+
+				// Process the 16 color indexes.
+				__m128i rows[4];
+				expand_DXTn_indexes_sse41(rows,
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(pal)),
+					le32_to_cpu(dxt3_src->colors.indexes));
+
+				// Expand the 4-bit alpha values to 8-bit.
+				// Low nybble is the first pixel.
+				__m128i alpha = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&dxt3_src->alpha));
+				alpha = _mm_unpacklo_epi8(
+					_mm_and_si128(alpha, Mask_Nyb),
+					_mm_and_si128(_mm_srli_epi16(alpha, 4), Mask_Nyb));
+				alpha = _mm_or_si128(alpha, _mm_slli_epi16(alpha, 4));
+
+				// Apply the alpha values.
+				rows[0] = _mm_or_si128(_mm_and_si128(rows[0], Mask_RGB), _mm_shuffle_epi8(alpha, mask_a0));
+				rows[1] = _mm_or_si128(_mm_and_si128(rows[1], Mask_RGB), _mm_shuffle_epi8(alpha, mask_a1));
+				rows[2] = _mm_or_si128(_mm_and_si128(rows[2], Mask_RGB), _mm_shuffle_epi8(alpha, mask_a2));
+				rows[3] = _mm_or_si128(_mm_and_si128(rows[3], Mask_RGB), _mm_shuffle_epi8(alpha, mask_a3));
+				store_tile_sse41(px_dest, stride_px, rows);
+			}
+		}
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
+
+	if (width < physWidth || height < physHeight) {
+		// Shrink the image.
+		img->shrink(width, height);
+	}
+
+	// Set the sBIT metadata.
+	static const rp_image::sBIT_t sBIT = {8,8,8,0,4};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Convert a DXT5 image to rp_image.
+ * SSE4.1-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf DXT5 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromDXT5_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+
+	// DXT5 uses 4x4 tiles, but some container formats allow
+	// the last tile to be cut off, so round up for the
+	// physical tile size.
+	const int physWidth = ALIGN_BYTES(4, width);
+	const int physHeight = ALIGN_BYTES(4, height);
+
+	assert(img_siz >= (physWidth * physHeight));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < (physWidth * physHeight))
+	{
+		return nullptr;
+	}
+
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::DXT5, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	// DXT5 block format.
+	struct dxt5_block {
+		dxt5_alpha alpha;
+		dxt1_block colors;	// DXT1-style color block.
+	};
+	ASSERT_STRUCT(dxt5_block, 16);
+	const dxt5_block *const dxt5_src_start = reinterpret_cast<const dxt5_block*>(img_buf);
+
+	// Calculate the total number of tiles.
+	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
+	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
+
+	const int stride_px = img->stride() / sizeof(uint32_t);
+	uint32_t *const bits = static_cast<uint32_t*>(img->bits());
+
+	const __m128i Mask_RGB = _mm_set1_epi32(0x00FFFFFF);
+	const __m128i mask_a0 = byte_to_dword_mask(0, 3);
+	const __m128i mask_a1 = byte_to_dword_mask(1, 3);
+	const __m128i mask_a2 = byte_to_dword_mask(2, 3);
+	const __m128i mask_a3 = byte_to_dword_mask(3, 3);
+
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		const dxt5_block *dxt5_src = &dxt5_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+			uint32_t *px_dest = bits + (y * 4 * stride_px);
+			for (unsigned int x = 0; x < tilesX; x++, dxt5_src++, px_dest += 4) {
+				// Decode the DXT5 tile palette.
+				argb32_t pal[4];
+				decode_DXTn_tile_color_palette_S3TC<0>(pal, &dxt5_src->colors);
+
+				// Process the 16 color indexes.
+				__m128i rows[4];
+				expand_DXTn_indexes_sse41(rows,
+					_mm_loadu_si128(reinterpret_cast<const __m128i*>(pal)),
+					le32_to_cpu(dxt5_src->colors.indexes));
+
+				// Decode the alpha channel values.
+				const __m128i alpha = expand_DXT5_codes_sse41(
+					decode_DXT5_alpha_palette_sse41(dxt5_src->alpha.values),
+					extract48(&dxt5_src->alpha));
+
+				// Apply the alpha values.
+				rows[0] = _mm_or_si128(_mm_and_si128(rows[0], Mask_RGB), _mm_shuffle_epi8(alpha, mask_a0));
+				rows[1] = _mm_or_si128(_mm_and_si128(rows[1], Mask_RGB), _mm_shuffle_epi8(alpha, mask_a1));
+				rows[2] = _mm_or_si128(_mm_and_si128(rows[2], Mask_RGB), _mm_shuffle_epi8(alpha, mask_a2));
+				rows[3] = _mm_or_si128(_mm_and_si128(rows[3], Mask_RGB), _mm_shuffle_epi8(alpha, mask_a3));
+				store_tile_sse41(px_dest, stride_px, rows);
+			}
+		}
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
+
+	if (width < physWidth || height < physHeight) {
+		// Shrink the image.
+		img->shrink(width, height);
+	}
+
+	// Set the sBIT metadata.
+	static const rp_image::sBIT_t sBIT = {8,8,8,0,8};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Convert a BC4 (ATI1) image to rp_image.
+ * SSE4.1-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf BC4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromBC4_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+
+	// BC4 uses 4x4 tiles, but some container formats allow
+	// the last tile to be cut off, so round up for the
+	// physical tile size.
+	const int physWidth = ALIGN_BYTES(4, width);
+	const int physHeight = ALIGN_BYTES(4, height);
+
+	assert(img_siz >= ((width * height) / 2));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < ((physWidth * physHeight) / 2))
+	{
+		return nullptr;
+	}
+
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::BC4, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	// BC4 block format.
+	struct bc4_block {
+		dxt5_alpha red;
+	};
+	ASSERT_STRUCT(bc4_block, 8);
+	const bc4_block *const bc4_src_start = reinterpret_cast<const bc4_block*>(img_buf);
+
+	// Calculate the total number of tiles.
+	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
+	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
+
+	const int stride_px = img->stride() / sizeof(uint32_t);
+	uint32_t *const bits = static_cast<uint32_t*>(img->bits());
+
+	// NOTE: Using red instead of grayscale here.
+	const __m128i Mask_A = _mm_set1_epi32(0xFF000000);	// opaque black
+	const __m128i mask_r0 = byte_to_dword_mask(0, 2);
+	const __m128i mask_r1 = byte_to_dword_mask(1, 2);
+	const __m128i mask_r2 = byte_to_dword_mask(2, 2);
+	const __m128i mask_r3 = byte_to_dword_mask(3, 2);
+
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		const bc4_block *bc4_src = &bc4_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+			uint32_t *px_dest = bits + (y * 4 * stride_px);
+			for (unsigned int x = 0; x < tilesX; x++, bc4_src++, px_dest += 4) {
+				// BC4 colors are determined using DXT5-style alpha interpolation.
+				const __m128i red = expand_DXT5_codes_sse41(
+					decode_DXT5_alpha_palette_sse41(bc4_src->red.values),
+					extract48(&bc4_src->red));
+
+				__m128i rows[4];
+				rows[0] = _mm_or_si128(Mask_A, _mm_shuffle_epi8(red, mask_r0));
+				rows[1] = _mm_or_si128(Mask_A, _mm_shuffle_epi8(red, mask_r1));
+				rows[2] = _mm_or_si128(Mask_A, _mm_shuffle_epi8(red, mask_r2));
+				rows[3] = _mm_or_si128(Mask_A, _mm_shuffle_epi8(red, mask_r3));
+				store_tile_sse41(px_dest, stride_px, rows);
+			}
+		}
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
+
+	if (width < physWidth || height < physHeight) {
+		// Shrink the image.
+		img->shrink(width, height);
+	}
+
+	// Set the sBIT metadata.
+	// NOTE: We have to set '1' for the empty Green and Blue channels,
+	// since libpng complains if it's set to '0'.
+	static const rp_image::sBIT_t sBIT = {8,1,1,0,0};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+/**
+ * Convert a BC5 (ATI2) image to rp_image.
+ * SSE4.1-optimized version.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf BC5 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromBC5_sse41(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz)
+{
+	RP_TRACE_ZONE(__func__);
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+
+	// BC5 uses 4x4 tiles, but some container formats allow
+	// the last tile to be cut off, so round up for the
+	// physical tile size.
+	const int physWidth = ALIGN_BYTES(4, width);
+	const int physHeight = ALIGN_BYTES(4, height);
+
+	assert(img_siz >= (width * height));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < (physWidth * physHeight))
+	{
+		return nullptr;
+	}
+
+	// Large images may be decoded on the GPU.
+	rp_image *const gpuImg = ImageDecoderPrivate::gpuDecode(
+		ImageDecoderPrivate::GpuFormat::BC5, width, height, img_buf, img_siz);
+	if (gpuImg) {
+		return gpuImg;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(physWidth, physHeight, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	// BC5 block format.
+	struct bc5_block {
+		dxt5_alpha red;
+		dxt5_alpha green;
+	};
+	ASSERT_STRUCT(bc5_block, 16);
+	const bc5_block *const bc5_src_start = reinterpret_cast<const bc5_block*>(img_buf);
+
+	// Calculate the total number of tiles.
+	// NOTE: Matches fromBC5_cpp(), which uses the visible size here.
+	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
+	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
+
+	const int stride_px = img->stride() / sizeof(uint32_t);
+	uint32_t *const bits = static_cast<uint32_t*>(img->bits());
+
+	const __m128i Mask_A = _mm_set1_epi32(0xFF000000);	// opaque black
+	const __m128i mask_r0 = byte_to_dword_mask(0, 2);
+	const __m128i mask_r1 = byte_to_dword_mask(1, 2);
+	const __m128i mask_r2 = byte_to_dword_mask(2, 2);
+	const __m128i mask_r3 = byte_to_dword_mask(3, 2);
+	const __m128i mask_g0 = byte_to_dword_mask(0, 1);
+	const __m128i mask_g1 = byte_to_dword_mask(1, 1);
+	const __m128i mask_g2 = byte_to_dword_mask(2, 1);
+	const __m128i mask_g3 = byte_to_dword_mask(3, 1);
+
+	// Decode the image as strips of tile rows.
+	const bool ok = ImageDecoderPrivate::decodeStrips(tilesY, tilesX * tilesY * 16,
+		[&](unsigned int yStart, unsigned int yEnd) -> bool
+	{
+		const bc5_block *bc5_src = &bc5_src_start[yStart * tilesX];
+		for (unsigned int y = yStart; y < yEnd; y++) {
+			uint32_t *px_dest = bits + (y * 4 * stride_px);
+			for (unsigned int x = 0; x < tilesX; x++, bc5_src++, px_dest += 4) {
+				// BC5 colors are determined using DXT5-style alpha interpolation.
+				const __m128i red = expand_DXT5_codes_sse41(
+					decode_DXT5_alpha_palette_sse41(bc5_src->red.values),
+					extract48(&bc5_src->red));
+				const __m128i green = expand_DXT5_codes_sse41(
+					decode_DXT5_alpha_palette_sse41(bc5_src->green.values),
+					extract48(&bc5_src->green));
+
+				__m128i rows[4];
+				rows[0] = _mm_or_si128(_mm_or_si128(Mask_A, _mm_shuffle_epi8(red, mask_r0)), _mm_shuffle_epi8(green, mask_g0));
+				rows[1] = _mm_or_si128(_mm_or_si128(Mask_A, _mm_shuffle_epi8(red, mask_r1)), _mm_shuffle_epi8(green, mask_g1));
+				rows[2] = _mm_or_si128(_mm_or_si128(Mask_A, _mm_shuffle_epi8(red, mask_r2)), _mm_shuffle_epi8(green, mask_g2));
+				rows[3] = _mm_or_si128(_mm_or_si128(Mask_A, _mm_shuffle_epi8(red, mask_r3)), _mm_shuffle_epi8(green, mask_g3));
+				store_tile_sse41(px_dest, stride_px, rows);
+			}
+		}
+		return true;
+	});
+
+	if (!ok) {
+		// Decoding was cancelled.
+		img->unref();
+		return nullptr;
+	}
+
+	if (width < physWidth || height < physHeight) {
+		// Shrink the image.
+		img->shrink(width, height);
+	}
+
+	// Set the sBIT metadata.
+	// NOTE: We have to set '1' for the empty Blue channel,
+	// since libpng complains if it's set to '0'.
+	static const rp_image::sBIT_t sBIT = {8,8,1,0,0};
+	img->set_sBIT(&sBIT);
+
+	// Image has been converted.
+	return img;
+}
+
+} }
+
+#ifdef _MSC_VER
+# pragma warning(pop)
+#endif
@@ -0,0 +1,162 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_Strips.cpp: Parallel strip decoding.                       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageDecoder.hpp"
+#include "ImageDecoder_p.hpp"
+
+// librpthreads
+#include "librpthreads/Atomics.h"
+#include "librpthreads/CancelToken.hpp"
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::CancelToken;
+using LibRpThreads::ThreadPool;
+
+// C++ STL classes.
+using std::unique_ptr;
+
+namespace LibRpTexture {
+
+// Requested thread count. (0 == number of CPUs)
+static volatile unsigned int decodeThreads = 0;
+
+// Shared thread pool.
+// Only accessed by the thread that set poolBusy.
+static unique_ptr<ThreadPool> pool;
+static unsigned int poolThreads = 0;	// Requested thread count for the pool.
+static volatile int poolBusy = 0;
+
+/**
+ * Decode an image as strips of tile rows.
+ *
+ * If the image has at least PARALLEL_DECODE_MIN_PIXELS pixels
+ * and parallel decoding is enabled, the tile rows are split
+ * into strips, which are decoded using the shared thread pool.
+ * Otherwise, fn() is called once for all tile rows.
+ *
+ * If the calling thread has a CancelToken, strips are checked
+ * for cancellation before they're decoded, and the calling
+ * thread decodes CANCEL_CHECK_TILE_ROWS tile rows at a time.
+ *
+ * fn() must only write to the image rows covered by its strip.
+ *
+ * @param tilesY	[in] Number of tile rows.
+ * @param pixelCount	[in] Number of pixels in the image.
+ * @param fn		[in] Strip function: fn(firstTileRow, endTileRow). Returns false on error.
+ * @return True on success; false if any strip failed, or if decoding was cancelled.
+ */
+bool ImageDecoderPrivate::decodeStrips(unsigned int tilesY, unsigned int pixelCount,
+	const std::function<bool(unsigned int, unsigned int)> &fn)
+{
+	const CancelToken *const cancelToken = CancelToken::current();
+
+	// Decode the image on the calling thread.
+	auto decodeSerial = [&]() -> bool {
+		if (!cancelToken) {
+			return fn(0, tilesY);
+		}
+		for (unsigned int y = 0; y < tilesY; y += CANCEL_CHECK_TILE_ROWS) {
+			if (cancelToken->isCancelled()) {
+				return false;
+			}
+			const unsigned int endRow = std::min(y + CANCEL_CHECK_TILE_ROWS, tilesY);
+			if (!fn(y, endRow)) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	unsigned int threads = decodeThreads;
+	if (pixelCount < PARALLEL_DECODE_MIN_PIXELS || threads == 1 || tilesY < 2) {
+		// Small image, or parallel decoding is disabled.
+		return decodeSerial();
+	}
+
+	if (threads == 0) {
+		threads = ThreadPool::cpuCount();
+		if (threads <= 1) {
+			// Only one CPU.
+			return decodeSerial();
+		}
+	}
+
+	// If another image is using the thread pool,
+	// decode this one on the calling thread instead
+	// of waiting for the other image to finish.
+	// NOTE: ATOMIC_CMPXCHG() returns the initial value.
+	const int wasBusy = ATOMIC_CMPXCHG(&poolBusy, 0, 1);
+	if (wasBusy != 0) {
+		return decodeSerial();
+	}
+
+	if (!pool || poolThreads != threads) {
+		pool.reset(new ThreadPool(threads));
+		poolThreads = threads;
+	}
+
+	// Use a few strips per thread so uneven strips don't stall the pool.
+	unsigned int stripRows = tilesY / (pool->threadCount() * 4);
+	if (stripRows == 0) {
+		stripRows = 1;
+	}
+	const unsigned int stripCount = (tilesY + stripRows - 1) / stripRows;
+
+	volatile int failed = 0;
+	pool->parallelFor(stripCount, [&](size_t i) {
+		if (cancelToken && cancelToken->isCancelled()) {
+			ATOMIC_OR_FETCH(&failed, 1);
+			return;
+		}
+
+		const unsigned int firstRow = static_cast<unsigned int>(i) * stripRows;
+		unsigned int endRow = firstRow + stripRows;
+		if (endRow > tilesY) {
+			endRow = tilesY;
+		}
+		if (!fn(firstRow, endRow)) {
+			ATOMIC_OR_FETCH(&failed, 1);
+		}
+	});
+
+	ATOMIC_EXCHANGE(&poolBusy, 0);
+	return (failed == 0);
+}
+
+namespace ImageDecoder {
+
+/**
+ * Set the number of threads used to decode large images.
+ *
+ * Large block-compressed images are split into strips of tile rows,
+ * which are decoded using a thread pool shared by all decoders.
+ * Only one image is decoded in parallel at a time; other images
+ * are decoded on the calling thread.
+ *
+ * Programs that already decode multiple images concurrently
+ * should reduce this to avoid oversubscribing the CPU.
+ *
+ * @param count Number of threads, including the calling thread. (0 for the number of CPUs; 1 to disable)
+ */
+void setDecodeThreadCount(unsigned int count)
+{
+	decodeThreads = count;
+}
+
+/**
+ * Get the number of threads used to decode large images.
+ * @return Number of threads. (0 for the number of CPUs; 1 if disabled)
+ */
+unsigned int decodeThreadCount(void)
+{
+	return decodeThreads;
+}
+
+}
+
+}
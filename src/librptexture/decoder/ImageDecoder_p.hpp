@@ -13,10 +13,16 @@
 #include "byteswap.h"
 #include "../img/rp_image.hpp"
 
+// librpfile: tracing probes for the from*() entry points.
+#include "librpfile/RpTrace.hpp"
+
 // C includes. (C++ namespace)
 #include <cassert>
 #include <cstring>
 
+// C++ includes.
+#include <functional>
+
 namespace LibRpTexture {
 
 class ImageDecoderPrivate
@@ -59,6 +65,102 @@ class ImageDecoderPrivate
 		static inline void BlitTile_CI4_LeftLSN(
 			rp_image *RESTRICT img, const uint8_t *RESTRICT tileBuf,
 			unsigned int tileX, unsigned int tileY);
+
+	public:
+		/**
+		 * Minimum number of pixels for parallel decoding.
+		 * Smaller images are always decoded on the calling thread.
+		 */
+		static const unsigned int PARALLEL_DECODE_MIN_PIXELS = 1024*1024;
+
+		/**
+		 * Number of tile rows decoded between cancellation checks
+		 * if the calling thread has a CancelToken. (64 pixel rows)
+		 */
+		static const unsigned int CANCEL_CHECK_TILE_ROWS = 16;
+
+		/**
+		 * Decode an image as strips of tile rows.
+		 *
+		 * If the image has at least PARALLEL_DECODE_MIN_PIXELS pixels
+		 * and parallel decoding is enabled, the tile rows are split
+		 * into strips, which are decoded using the shared thread pool.
+		 * Otherwise, fn() is called once for all tile rows.
+		 *
+		 * If the calling thread has a CancelToken, strips are checked
+		 * for cancellation before they're decoded, and the calling
+		 * thread decodes CANCEL_CHECK_TILE_ROWS tile rows at a time.
+		 *
+		 * fn() must only write to the image rows covered by its strip.
+		 *
+		 * @param tilesY	[in] Number of tile rows.
+		 * @param pixelCount	[in] Number of pixels in the image.
+		 * @param fn		[in] Strip function: fn(firstTileRow, endTileRow). Returns false on error.
+		 * @return True on success; false if any strip failed, or if decoding was cancelled.
+		 */
+		static bool decodeStrips(unsigned int tilesY, unsigned int pixelCount,
+			const std::function<bool(unsigned int, unsigned int)> &fn);
+
+	public:
+		/** GPU decoding **/
+
+		/**
+		 * Minimum number of pixels for GPU decoding.
+		 * Uploading the image and starting the kernel has
+		 * a fixed cost, so smaller images are decoded on the CPU.
+		 */
+		static const unsigned int GPU_DECODE_MIN_PIXELS = 2048*2048;
+
+		// Block formats supported by the GPU decoder.
+		enum class GpuFormat {
+			DXT1,
+			DXT1_A1,
+			DXT3,
+			DXT5,
+			BC4,
+			BC5,
+			BC7,
+			ETC1,
+			ETC2_RGB,
+			ETC2_RGBA,
+			ETC2_RGB_A1,
+
+			Max
+		};
+
+		// Is GPU decoding enabled? (set by ImageDecoder::setGpuDecodeEnabled())
+		static bool gpuDecodeEnabled;
+
+		/**
+		 * Decode a block-compressed image on the GPU.
+		 *
+		 * This is called by the CPU decoders after the parameters
+		 * have been validated. If the image is too small, GPU decoding
+		 * is disabled or unavailable, or the GPU is being used by
+		 * another thread, nullptr is returned, and the caller should
+		 * decode the image on the CPU.
+		 *
+		 * @param fmt		[in] Block format.
+		 * @param width		[in] Image width.
+		 * @param height	[in] Image height.
+		 * @param img_buf	[in] Image buffer.
+		 * @param img_siz	[in] Size of image data.
+		 * @return rp_image, or nullptr if the image should be decoded on the CPU.
+		 */
+		static inline rp_image *gpuDecode(GpuFormat fmt, int width, int height,
+			const uint8_t *img_buf, int img_siz)
+		{
+			if (!gpuDecodeEnabled ||
+			    static_cast<unsigned int>(width) * static_cast<unsigned int>(height) < GPU_DECODE_MIN_PIXELS)
+			{
+				return nullptr;
+			}
+			return gpuDecode_int(fmt, width, height, img_buf, img_siz);
+		}
+
+	private:
+		static rp_image *gpuDecode_int(GpuFormat fmt, int width, int height,
+			const uint8_t *img_buf, int img_siz);
 };
 
 /**
@@ -0,0 +1,145 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_simd.cpp: Image decoding functions. (SIMD registry)        *
+ *                                                                         *
+ * Copyright (c) 2020 by David Korth.                                      *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageDecoder.hpp"
+
+// librptexture
+#include "img/rp_image.hpp"
+
+// librpcpu
+#include "librpcpu/simd_registry.h"
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+// Image width for the benchmarks.
+// The height is determined by the buffer size.
+static const int BENCH_WIDTH = 256;
+
+/**
+ * Benchmark a fromLinear16() variant. (RGB565)
+ * @tparam fn fromLinear16() variant.
+ * @param buf Buffer.
+ * @param size Size of buf.
+ */
+template<rp_image* (*fn)(PixelFormat, int, int, const uint16_t *RESTRICT, int, int)>
+static void bench_fromLinear16(uint8_t *buf, size_t size)
+{
+	const int height = static_cast<int>(size / (BENCH_WIDTH * 2));
+	rp_image *const img = fn(PXF_RGB565, BENCH_WIDTH, height,
+		reinterpret_cast<const uint16_t*>(buf), static_cast<int>(size), 0);
+	UNREF(img);
+}
+
+/**
+ * Benchmark a fromLinear24() variant. (RGB888)
+ * @tparam fn fromLinear24() variant.
+ * @param buf Buffer.
+ * @param size Size of buf.
+ */
+template<rp_image* (*fn)(PixelFormat, int, int, const uint8_t *RESTRICT, int, int)>
+static void bench_fromLinear24(uint8_t *buf, size_t size)
+{
+	const int height = static_cast<int>(size / (BENCH_WIDTH * 3));
+	rp_image *const img = fn(PXF_RGB888, BENCH_WIDTH, height,
+		buf, static_cast<int>(size), 0);
+	UNREF(img);
+}
+
+/**
+ * Benchmark a fromLinear32() variant. (RGBA32)
+ * @tparam fn fromLinear32() variant.
+ * @param buf Buffer.
+ * @param size Size of buf.
+ */
+template<rp_image* (*fn)(PixelFormat, int, int, const uint32_t *RESTRICT, int, int)>
+static void bench_fromLinear32(uint8_t *buf, size_t size)
+{
+	const int height = static_cast<int>(size / (BENCH_WIDTH * 4));
+	rp_image *const img = fn(PXF_HOST_RGBA32, BENCH_WIDTH, height,
+		reinterpret_cast<const uint32_t*>(buf), static_cast<int>(size), 0);
+	UNREF(img);
+}
+
+/**
+ * Benchmark a fromDXT1() variant.
+ * @tparam fn fromDXT1() variant.
+ * @param buf Buffer.
+ * @param size Size of buf.
+ */
+template<rp_image* (*fn)(int, int, const uint8_t *RESTRICT, int)>
+static void bench_fromDXT1(uint8_t *buf, size_t size)
+{
+	// DXT1 uses 8 bytes per 4x4 block.
+	const int height = static_cast<int>(size * 2 / BENCH_WIDTH) & ~3;
+	rp_image *const img = fn(BENCH_WIDTH, height, buf, static_cast<int>(size));
+	UNREF(img);
+}
+
+/**
+ * Register the ImageDecoder SIMD kernels with the SIMD registry.
+ * This is used by `rpcli --cpu-selftest`.
+ */
+void registerSimdKernels(void)
+{
+	// NOTE: Variants must be in the same order as the dispatch functions.
+	static const RP_SIMD_Variant fromLinear16_variants[] = {
+#ifdef IMAGEDECODER_HAS_AVX2
+		{"avx2", RP_CPUFLAG_X86_AVX2, bench_fromLinear16<fromLinear16_avx2>},
+#endif /* IMAGEDECODER_HAS_AVX2 */
+#ifdef IMAGEDECODER_HAS_SSE2
+		{"sse2", RP_CPUFLAG_X86_SSE2, bench_fromLinear16<fromLinear16_sse2>},
+#endif /* IMAGEDECODER_HAS_SSE2 */
+		{"cpp", 0, bench_fromLinear16<fromLinear16_cpp>},
+	};
+
+	static const RP_SIMD_Variant fromLinear24_variants[] = {
+#ifdef IMAGEDECODER_HAS_NEON
+		{"neon", 0, bench_fromLinear24<fromLinear24_neon>},
+#endif /* IMAGEDECODER_HAS_NEON */
+#ifdef IMAGEDECODER_HAS_AVX2
+		{"avx2", RP_CPUFLAG_X86_AVX2, bench_fromLinear24<fromLinear24_avx2>},
+#endif /* IMAGEDECODER_HAS_AVX2 */
+#ifdef IMAGEDECODER_HAS_SSSE3
+		{"ssse3", RP_CPUFLAG_X86_SSSE3, bench_fromLinear24<fromLinear24_ssse3>},
+#endif /* IMAGEDECODER_HAS_SSSE3 */
+		{"cpp", 0, bench_fromLinear24<fromLinear24_cpp>},
+	};
+
+	static const RP_SIMD_Variant fromLinear32_variants[] = {
+#ifdef IMAGEDECODER_HAS_NEON
+		{"neon", 0, bench_fromLinear32<fromLinear32_neon>},
+#endif /* IMAGEDECODER_HAS_NEON */
+#ifdef IMAGEDECODER_HAS_AVX2
+		{"avx2", RP_CPUFLAG_X86_AVX2, bench_fromLinear32<fromLinear32_avx2>},
+#endif /* IMAGEDECODER_HAS_AVX2 */
+#ifdef IMAGEDECODER_HAS_SSSE3
+		{"ssse3", RP_CPUFLAG_X86_SSSE3, bench_fromLinear32<fromLinear32_ssse3>},
+#endif /* IMAGEDECODER_HAS_SSSE3 */
+		{"cpp", 0, bench_fromLinear32<fromLinear32_cpp>},
+	};
+
+	static const RP_SIMD_Variant fromDXT1_variants[] = {
+#ifdef IMAGEDECODER_HAS_SSE41
+		{"sse41", RP_CPUFLAG_X86_SSE41, bench_fromDXT1<fromDXT1_sse41>},
+#endif /* IMAGEDECODER_HAS_SSE41 */
+		{"cpp", 0, bench_fromDXT1<fromDXT1_cpp>},
+	};
+
+	static const RP_SIMD_Kernel kernels[] = {
+		{"ImageDecoder::fromLinear16", fromLinear16_variants, ARRAY_SIZE(fromLinear16_variants)},
+		{"ImageDecoder::fromLinear24", fromLinear24_variants, ARRAY_SIZE(fromLinear24_variants)},
+		{"ImageDecoder::fromLinear32", fromLinear32_variants, ARRAY_SIZE(fromLinear32_variants)},
+		{"ImageDecoder::fromDXT1", fromDXT1_variants, ARRAY_SIZE(fromDXT1_variants)},
+	};
+	for (const auto &kernel : kernels) {
+		RP_SIMD_RegisterKernel(&kernel);
+	}
+}
+
+} }
@@ -48,6 +48,41 @@ FileFormatPrivate::~FileFormatPrivate()
 	UNREF(this->file);
 }
 
+/**
+ * Load image data from the texture file.
+ *
+ * If the file supports zero-copy access and the data is
+ * 16-byte aligned, a pointer to the file data is returned.
+ * Otherwise, the data is read into a 16-byte aligned buffer.
+ *
+ * @param buf	[out] Buffer storage. (only allocated if zero-copy access isn't possible)
+ * @param addr	[in] Starting address.
+ * @param size	[in] Data size.
+ * @return Pointer to the image data, or nullptr on error.
+ */
+const uint8_t *FileFormatPrivate::loadImageData(aligned_buf_t &buf, off64_t addr, size_t size)
+{
+	assert(file != nullptr);
+	if (!file || size == 0)
+		return nullptr;
+
+	// ImageDecoder's SIMD functions use aligned loads,
+	// so the view can only be used if it's 16-byte aligned.
+	size_t sz = size;
+	const uint8_t *const pView = file->view(addr, &sz);
+	if (pView && sz == size && (reinterpret_cast<uintptr_t>(pView) % 16) == 0) {
+		// Zero-copy access.
+		return pView;
+	}
+
+	buf = aligned_uptr<uint8_t>(16, size);
+	if (!buf || file->seekAndRead(addr, buf.get(), size) != size) {
+		// Seek and/or read error.
+		return nullptr;
+	}
+	return buf.get();
+}
+
 /** FileFormat **/
 
 FileFormat::FileFormat(FileFormatPrivate *d)
@@ -139,4 +174,99 @@ int FileFormat::getDimensions(int pBuf[3]) const
 	return 0;
 }
 
+/**
+ * Get the dimensions of the embedded low-resolution image.
+ * Most formats don't have one; the default returns -ENOENT.
+ * @param pBuf Two-element array for [x, y].
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int FileFormat::getLowResDimensions(int pBuf[2]) const
+{
+	RP_UNUSED(pBuf);
+	return -ENOENT;
+}
+
+/**
+ * Get the embedded low-resolution image.
+ * This is a separate preview image, not a mipmap.
+ * The image is owned by this object.
+ * @return Image, or nullptr if not available.
+ */
+const rp_image *FileFormat::lowResImage(void) const
+{
+	return nullptr;
+}
+
+/**
+ * Get the smallest mipmap that is at least the specified size.
+ *
+ * This is intended for thumbnailing: only the selected
+ * mipmap level is read and decoded, so large textures
+ * don't need to decode the full image just to downscale it.
+ * If the format has an embedded low-resolution image that
+ * is large enough, it is used instead of any mipmap.
+ *
+ * The image is owned by this object.
+ *
+ * @param minSize Minimum size. (single dimension; compared against the larger side)
+ * @return Image, or nullptr on error. If no mipmap is at least
+ *         minSize, or if minSize <= 0, the full image is returned.
+ */
+const rp_image *FileFormat::mipmapForSize(int minSize) const
+{
+	RP_D(const FileFormat);
+	if (!d->isValid) {
+		// Not supported.
+		return nullptr;
+	}
+
+	if (minSize > 0) {
+		// If the low-resolution image is large enough, use it.
+		// It's usually tiny, so this avoids decoding any mipmaps.
+		int lowResDims[2];
+		if (getLowResDimensions(lowResDims) == 0 &&
+		    std::max(lowResDims[0], lowResDims[1]) >= minSize)
+		{
+			const rp_image *const img = this->lowResImage();
+			if (img) {
+				return img;
+			}
+		}
+	}
+
+	const int mipmapCount = this->mipmapCount();
+	if (minSize <= 0 || mipmapCount <= 1) {
+		// No mipmaps, or no size was requested.
+		return this->image();
+	}
+
+	const int width = d->dimensions[0];
+	const int height = d->dimensions[1];
+	if (width <= 0 || height <= 0) {
+		// Dimensions are unknown.
+		return this->image();
+	}
+
+	// Find the smallest mipmap level where the larger
+	// side is still at least minSize.
+	int mip = 0;
+	for (int i = 1; i < mipmapCount && i < 31; i++) {
+		const int mip_w = std::max(1, width >> i);
+		const int mip_h = std::max(1, height >> i);
+		if (std::max(mip_w, mip_h) < minSize)
+			break;
+		mip = i;
+	}
+
+	// Some formats can't decode every mipmap level.
+	// If decoding fails, try the next larger level.
+	for (; mip > 0; mip--) {
+		const rp_image *const img = this->mipmap(mip);
+		if (img) {
+			return img;
+		}
+	}
+	return this->image();
+}
+
 }
@@ -194,6 +194,39 @@ class FileFormat : public RefBase
 		 * @return Image, or nullptr on error.
 		 */
 		virtual const rp_image *mipmap(int mip) const = 0;
+
+		/**
+		 * Get the dimensions of the embedded low-resolution image.
+		 * Most formats don't have one; the default returns -ENOENT.
+		 * @param pBuf Two-element array for [x, y].
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		virtual int getLowResDimensions(int pBuf[2]) const;
+
+		/**
+		 * Get the embedded low-resolution image.
+		 * This is a separate preview image, not a mipmap.
+		 * The image is owned by this object.
+		 * @return Image, or nullptr if not available.
+		 */
+		virtual const rp_image *lowResImage(void) const;
+
+		/**
+		 * Get the smallest mipmap that is at least the specified size.
+		 *
+		 * This is intended for thumbnailing: only the selected
+		 * mipmap level is read and decoded, so large textures
+		 * don't need to decode the full image just to downscale it.
+		 * If the format has an embedded low-resolution image that
+		 * is large enough, it is used instead of any mipmap.
+		 *
+		 * The image is owned by this object.
+		 *
+		 * @param minSize Minimum size. (single dimension; compared against the larger side)
+		 * @return Image, or nullptr on error. If no mipmap is at least
+		 *         minSize, or if minSize <= 0, the full image is returned.
+		 */
+		const rp_image *mipmapForSize(int minSize) const;
 };
 
 }
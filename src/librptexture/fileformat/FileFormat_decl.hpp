@@ -162,6 +162,26 @@ class klass final : public LibRpTexture::FileFormat { \
 		 */ \
 		void close(void) final;
 
+/**
+ * FileFormat subclass function declarations for formats that
+ * have an embedded low-resolution image.
+ */
+#define FILEFORMAT_DECL_LOWRES() \
+	public: \
+		/** \
+		 * Get the dimensions of the embedded low-resolution image. \
+		 * @param pBuf Two-element array for [x, y]. \
+		 * @return 0 on success; negative POSIX error code on error. \
+		 */ \
+		int getLowResDimensions(int pBuf[2]) const final; \
+		\
+		/** \
+		 * Get the embedded low-resolution image. \
+		 * The image is owned by this object. \
+		 * @return Image, or nullptr if not available. \
+		 */ \
+		const LibRpTexture::rp_image *lowResImage(void) const final;
+
 /**
  * End of FileFormat subclass declaration.
  */
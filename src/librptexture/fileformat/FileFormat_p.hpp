@@ -9,6 +9,9 @@
 #ifndef __ROMPROPERTIES_LIBRPTEXTURE_FILEFORMAT_FILEFORMAT_P_HPP__
 #define __ROMPROPERTIES_LIBRPTEXTURE_FILEFORMAT_FILEFORMAT_P_HPP__
 
+// librpbase
+#include "librpbase/aligned_malloc.h"
+
 namespace LibRpFile {
 	class IRpFile;
 }
@@ -45,6 +48,24 @@ class FileFormatPrivate
 		const char *mimeType;		// MIME type. (ASCII) (default is nullptr)
 		int dimensions[3];		// Dimensions. (width, height, depth)
 						// 2D textures have depth=0.
+
+	public:
+		// Aligned buffer for image data.
+		typedef std::unique_ptr<uint8_t, decltype(&aligned_free)> aligned_buf_t;
+
+		/**
+		 * Load image data from the texture file.
+		 *
+		 * If the file supports zero-copy access and the data is
+		 * 16-byte aligned, a pointer to the file data is returned.
+		 * Otherwise, the data is read into a 16-byte aligned buffer.
+		 *
+		 * @param buf	[out] Buffer storage. (only allocated if zero-copy access isn't possible)
+		 * @param addr	[in] Starting address.
+		 * @param size	[in] Data size.
+		 * @return Pointer to the image data, or nullptr on error.
+		 */
+		const uint8_t *loadImageData(aligned_buf_t &buf, off64_t addr, size_t size);
 };
 
 }
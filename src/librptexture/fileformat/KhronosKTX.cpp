@@ -65,8 +65,9 @@ class KhronosKTXPrivate final : public FileFormatPrivate
 		// Texture data start address.
 		unsigned int texDataStartAddr;
 
-		// Decoded image.
-		rp_image *img;
+		// Decoded mipmaps.
+		// Mipmap 0 is the full image.
+		vector<rp_image*> mipmaps;
 
 		// Invalid pixel format message.
 		char invalid_pixel_format[24];
@@ -79,9 +80,10 @@ class KhronosKTXPrivate final : public FileFormatPrivate
 
 		/**
 		 * Load the image.
+		 * @param mip Mipmap number. (0 == full image)
 		 * @return Image, or nullptr on error.
 		 */
-		const rp_image *loadImage(void);
+		const rp_image *loadImage(int mip);
 
 		/**
 		 * Load key/value data.
@@ -96,7 +98,6 @@ KhronosKTXPrivate::KhronosKTXPrivate(KhronosKTX *q, IRpFile *file)
 	, isByteswapNeeded(false)
 	, flipOp(rp_image::FLIP_V)
 	, texDataStartAddr(0)
-	, img(nullptr)
 {
 	// Clear the KTX header struct.
 	memset(&ktxHeader, 0, sizeof(ktxHeader));
@@ -105,18 +106,32 @@ KhronosKTXPrivate::KhronosKTXPrivate(KhronosKTX *q, IRpFile *file)
 
 KhronosKTXPrivate::~KhronosKTXPrivate()
 {
-	UNREF(img);
+	std::for_each(mipmaps.begin(), mipmaps.end(), [](rp_image *img) { UNREF(img); });
 }
 
 /**
  * Load the image.
+ * @param mip Mipmap number. (0 == full image)
  * @return Image, or nullptr on error.
  */
-const rp_image *KhronosKTXPrivate::loadImage(void)
+const rp_image *KhronosKTXPrivate::loadImage(int mip)
 {
-	if (img) {
+	int mipmapCount = ktxHeader.numberOfMipmapLevels;
+	if (mipmapCount <= 0) {
+		// No mipmaps == one image.
+		mipmapCount = 1;
+	}
+
+	assert(mip >= 0);
+	assert(mip < mipmapCount);
+	if (mip < 0 || mip >= mipmapCount) {
+		// Invalid mipmap number.
+		return nullptr;
+	}
+
+	if (!mipmaps.empty() && mipmaps[mip] != nullptr) {
 		// Image has already been loaded.
-		return img;
+		return mipmaps[mip];
 	} else if (!this->file || !this->isValid) {
 		// Can't load the image.
 		return nullptr;
@@ -147,19 +162,42 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 	}
 	const uint32_t file_sz = static_cast<uint32_t>(file->size());
 
-	// Seek to the start of the texture data.
-	int ret = file->seek(texDataStartAddr);
-	if (ret != 0) {
-		// Seek error.
-		return nullptr;
-	}
+	// NOTE: Mipmaps are stored *after* the main image, from
+	// largest to smallest. Each mipmap level has a 32-bit
+	// imageSize field, followed by the image data, padded
+	// to a multiple of 4 bytes.
+	uint32_t addr = texDataStartAddr;
+	for (int i = 0; i < mip; i++) {
+		uint32_t imageSize;
+		size_t size = file->seekAndRead(addr, &imageSize, sizeof(imageSize));
+		if (size != sizeof(imageSize)) {
+			// Unable to read the image size field.
+			return nullptr;
+		}
+		if (isByteswapNeeded) {
+			imageSize = __swab32(imageSize);
+		}
 
-	// NOTE: Mipmaps are stored *after* the main image.
-	// Hence, no mipmap processing is necessary.
+		// NOTE: For non-array cubemaps, imageSize is the size of
+		// a single face, and each face is padded individually.
+		uint64_t levelSize = ALIGN_BYTES(4, static_cast<uint64_t>(imageSize));
+		if (ktxHeader.numberOfArrayElements == 0 && ktxHeader.numberOfFaces == 6) {
+			levelSize *= 6;
+		}
+		levelSize += sizeof(imageSize);
+		if (addr >= file_sz || levelSize >= file_sz - addr) {
+			// File is too small.
+			return nullptr;
+		}
+		addr += static_cast<uint32_t>(levelSize);
+	}
 
 	// Handle a 1D texture as a "width x 1" 2D texture.
 	// NOTE: Handling a 3D texture as a single 2D texture.
-	const int height = (ktxHeader.pixelHeight > 0 ? ktxHeader.pixelHeight : 1);
+	const int width = static_cast<int>(std::max(1U, ktxHeader.pixelWidth >> mip));
+	const int height = (ktxHeader.pixelHeight > 0
+		? static_cast<int>(std::max(1U, ktxHeader.pixelHeight >> mip))
+		: 1);
 
 	// Calculate the expected size.
 	// NOTE: Scanlines are 4-byte aligned.
@@ -168,26 +206,26 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 	switch (ktxHeader.glFormat) {
 		case GL_RGB:
 			// 24-bit RGB.
-			stride = ALIGN_BYTES(4, ktxHeader.pixelWidth * 3);
+			stride = ALIGN_BYTES(4, width * 3);
 			expected_size = static_cast<unsigned int>(stride * height);
 			break;
 
 		case GL_RGBA:
 			// 32-bit RGBA.
-			stride = ktxHeader.pixelWidth * 4;
+			stride = width * 4;
 			expected_size = static_cast<unsigned int>(stride * height);
 			break;
 
 		case GL_LUMINANCE:
 			// 8-bit luminance.
-			stride = ALIGN_BYTES(4, ktxHeader.pixelWidth);
+			stride = ALIGN_BYTES(4, width);
 			expected_size = static_cast<unsigned int>(stride * height);
 			break;
 
 		case GL_RGB9_E5:
 			// Uncompressed "special" 32bpp formats.
 			// TODO: Does KTX handle GL_RGB9_E5 as compressed?
-			stride = ktxHeader.pixelWidth * 4;
+			stride = width * 4;
 			expected_size = static_cast<unsigned int>(stride * height);
 			break;
 
@@ -200,25 +238,25 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 				case GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG:
 				case GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG:
 					// 32 pixels compressed into 64 bits. (2bpp)
-					expected_size = (ktxHeader.pixelWidth * height) / 4;
+					expected_size = (width * height) / 4;
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_2BPPV2_IMG:
 					// 32 pixels compressed into 64 bits. (2bpp)
 					// NOTE: Width and height must be rounded to the nearest tile. (8x4)
-					expected_size = ALIGN_BYTES(8, ktxHeader.pixelWidth) *
+					expected_size = ALIGN_BYTES(8, width) *
 					                ALIGN_BYTES(4, (int)height) / 4;
 					break;
 
 				case GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG:
 				case GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG:
 					// 16 pixels compressed into 64 bits. (4bpp)
-					expected_size = (ktxHeader.pixelWidth * height) / 2;
+					expected_size = (width * height) / 2;
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_4BPPV2_IMG:
 					// NOTE: Width and height must be rounded to the nearest tile. (4x4)
-					expected_size = ALIGN_BYTES(4, ktxHeader.pixelWidth) *
+					expected_size = ALIGN_BYTES(4, width) *
 					                ALIGN_BYTES(4, (int)height) / 2;
 					break;
 #endif /* ENABLE_PVRTC */
@@ -240,7 +278,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 				case GL_COMPRESSED_SIGNED_LUMINANCE_LATC1_EXT:
 					// 16 pixels compressed into 64 bits. (4bpp)
 					// NOTE: Width and height must be rounded to the nearest tile. (4x4)
-					expected_size = ALIGN_BYTES(4, ktxHeader.pixelWidth) *
+					expected_size = ALIGN_BYTES(4, width) *
 					                ALIGN_BYTES(4, (int)height) / 2;
 					break;
 
@@ -262,14 +300,14 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 				case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
 					// 16 pixels compressed into 128 bits. (8bpp)
 					// NOTE: Width and height must be rounded to the nearest tile. (4x4)
-					expected_size = ALIGN_BYTES(4, ktxHeader.pixelWidth) *
+					expected_size = ALIGN_BYTES(4, width) *
 					                ALIGN_BYTES(4, (int)height);
 					break;
 
 				case GL_RGB9_E5:
 					// Uncompressed "special" 32bpp formats.
 					// TODO: Does KTX handle GL_RGB9_E5 as compressed?
-					expected_size = ktxHeader.pixelWidth * height * 4;
+					expected_size = width * height * 4;
 					break;
 
 				default:
@@ -280,7 +318,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 	}
 
 	// Verify file size.
-	if (texDataStartAddr + expected_size > file_sz) {
+	if (static_cast<uint64_t>(addr) + sizeof(uint32_t) + expected_size > file_sz) {
 		// File is too small.
 		return nullptr;
 	}
@@ -288,7 +326,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 	// Read the image size field.
 	// NOTE: Divide image size by # of layers to get the expected size.
 	uint32_t imageSize;
-	size_t size = file->read(&imageSize, sizeof(imageSize));
+	size_t size = file->seekAndRead(addr, &imageSize, sizeof(imageSize));
 	if (size != sizeof(imageSize)) {
 		// Unable to read the image size field.
 		return nullptr;
@@ -310,10 +348,10 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 		}
 	}
 
-	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size = file->read(buf.get(), expected_size);
-	if (size != expected_size) {
+	// Load the texture data.
+	aligned_buf_t buf_storage(nullptr, &aligned_free);
+	const uint8_t *const buf = loadImageData(buf_storage, addr + sizeof(imageSize), expected_size);
+	if (!buf) {
 		// Read error.
 		return nullptr;
 	}
@@ -321,34 +359,35 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 	// TODO: Byteswapping.
 	// TODO: Handle variants. Check for channel sizes in glInternalFormat?
 	// TODO: Handle sRGB post-processing? (for e.g. GL_SRGB8)
+	rp_image *img = nullptr;
 	switch (ktxHeader.glFormat) {
 		case GL_RGB:
 			// 24-bit RGB.
 			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_BGR888,
-				ktxHeader.pixelWidth, height,
-				buf.get(), expected_size, stride);
+				width, height,
+				buf, expected_size, stride);
 			break;
 
 		case GL_RGBA:
 			// 32-bit RGBA.
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ABGR8888,
-				ktxHeader.pixelWidth, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				width, height,
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		case GL_LUMINANCE:
 			// 8-bit Luminance.
 			img = ImageDecoder::fromLinear8(ImageDecoder::PXF_L8,
-				ktxHeader.pixelWidth, height,
-				buf.get(), expected_size, stride);
+				width, height,
+				buf, expected_size, stride);
 			break;
 
 		case GL_RGB9_E5:
 			// Uncompressed "special" 32bpp formats.
 			// TODO: Does KTX handle GL_RGB9_E5 as compressed?
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
-				ktxHeader.pixelWidth, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				width, height,
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		case 0:
@@ -361,22 +400,22 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 				case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
 					// DXT1-compressed texture.
 					img = ImageDecoder::fromDXT1(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
 					// DXT1-compressed texture with 1-bit alpha.
 					img = ImageDecoder::fromDXT1_A1(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
 					// DXT3-compressed texture.
 					img = ImageDecoder::fromDXT3(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_RGBA_DXT5_S3TC:
@@ -384,15 +423,15 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 				case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
 					// DXT5-compressed texture.
 					img = ImageDecoder::fromDXT5(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_ETC1_RGB8_OES:
 					// ETC1-compressed texture.
 					img = ImageDecoder::fromETC1(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGB8_ETC2:
@@ -400,8 +439,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// ETC2-compressed RGB texture.
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGB(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
@@ -410,8 +449,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// with punchthrough alpha.
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGB_A1(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RGBA8_ETC2_EAC:
@@ -420,8 +459,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// with EAC-compressed alpha channel.
 					// TODO: Handle sRGB.
 					img = ImageDecoder::fromETC2_RGBA(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RED_RGTC1:
@@ -429,8 +468,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// RGTC, one component. (BC4)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC4(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_RG_RGTC2:
@@ -438,8 +477,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// RGTC, two components. (BC5)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC5(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 				case GL_COMPRESSED_LUMINANCE_LATC1_EXT:
@@ -447,8 +486,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// LATC, one component. (BC4)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC4(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					// TODO: If this fails, return it anyway or return nullptr?
 					ImageDecoder::fromRed8ToL8(img);
 					break;
@@ -458,8 +497,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// LATC, two components. (BC5)
 					// TODO: Handle signed properly.
 					img = ImageDecoder::fromBC5(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					// TODO: If this fails, return it anyway or return nullptr?
 					ImageDecoder::fromRG8ToLA8(img);
 					break;
@@ -468,52 +507,52 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 				case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
 					// BPTC-compressed RGBA texture. (BC7)
 					img = ImageDecoder::fromBC7(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
+						width, height,
+						buf, expected_size);
 					break;
 
 #ifdef ENABLE_PVRTC
 				case GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG:
 					// PVRTC, 2bpp, no alpha.
-					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+					img = ImageDecoder::fromPVRTC(width, height,
+						buf, expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG:
 					// PVRTC, 2bpp, has alpha.
-					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+					img = ImageDecoder::fromPVRTC(width, height,
+						buf, expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
 				case GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG:
 					// PVRTC, 4bpp, no alpha.
-					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+					img = ImageDecoder::fromPVRTC(width, height,
+						buf, expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG:
 					// PVRTC, 4bpp, has alpha.
-					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+					img = ImageDecoder::fromPVRTC(width, height,
+						buf, expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_2BPPV2_IMG:
 					// PVRTC-II, 2bpp.
 					// NOTE: Assuming this has alpha.
-					img = ImageDecoder::fromPVRTCII(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+					img = ImageDecoder::fromPVRTCII(width, height,
+						buf, expected_size,
 						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 
 				case GL_COMPRESSED_RGBA_PVRTC_4BPPV2_IMG:
 					// PVRTC-II, 4bpp.
 					// NOTE: Assuming this has alpha.
-					img = ImageDecoder::fromPVRTCII(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
+					img = ImageDecoder::fromPVRTCII(width, height,
+						buf, expected_size,
 						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 					break;
 #endif /* ENABLE_PVRTC */
@@ -522,8 +561,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 					// Uncompressed "special" 32bpp formats.
 					// TODO: Does KTX handle GL_RGB9_E5 as compressed?
 					img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
-						ktxHeader.pixelWidth, height,
-						reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+						width, height,
+						reinterpret_cast<const uint32_t*>(buf), expected_size);
 					break;
 
 				default:
@@ -536,13 +575,13 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 	// Post-processing: Check if a flip is needed.
 	if (img && (flipOp != rp_image::FLIP_NONE) && height > 1) {
 		// TODO: Assert that img dimensions match ktxHeader?
-		rp_image *const flipimg = img->flip(flipOp);
-		if (flipimg) {
-			img->unref();
-			img = flipimg;
-		}
+		img->flip_inplace(flipOp);
 	}
 
+	if (mipmaps.empty()) {
+		mipmaps.resize(mipmapCount);
+	}
+	mipmaps[mip] = img;
 	return img;
 }
 
@@ -1039,11 +1078,8 @@ const rp_image *KhronosKTX::mipmap(int mip) const
 		return nullptr;
 	}
 
-	// FIXME: Support decoding mipmaps.
-	if (mip == 0) {
-		return const_cast<KhronosKTXPrivate*>(d)->loadImage();
-	}
-	return nullptr;
+	// Load the image.
+	return const_cast<KhronosKTXPrivate*>(d)->loadImage(mip);
 }
 
 }
@@ -33,6 +33,16 @@ using LibRpFile::IRpFile;
 #include "img/rp_image.hpp"
 #include "decoder/ImageDecoder.hpp"
 
+// zlib and zstd (supercompression)
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#  include <zstd.h>
+#endif /* HAVE_ZSTD */
+#ifdef _MSC_VER
+// MSVC: Exception handling for /DELAYLOAD.
+#  include "libwin32common/DelayLoadHelper.h"
+#endif /* _MSC_VER */
+
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
@@ -47,6 +57,14 @@ namespace LibRpTexture {
 
 FILEFORMAT_IMPL(KhronosKTX2)
 
+#ifdef _MSC_VER
+// DelayLoad test implementation.
+DELAYLOAD_TEST_FUNCTION_IMPL0(zlibVersion);
+#  ifdef HAVE_ZSTD
+DELAYLOAD_TEST_FUNCTION_IMPL0(ZSTD_versionNumber);
+#  endif /* HAVE_ZSTD */
+#endif /* _MSC_VER */
+
 class KhronosKTX2Private final : public FileFormatPrivate
 {
 	public:
@@ -83,6 +101,21 @@ class KhronosKTX2Private final : public FileFormatPrivate
 		// RFT_LISTDATA.
 		vector<vector<string> > kv_data;
 
+		/**
+		 * Load supercompressed image data from a mipmap level.
+		 *
+		 * The mipmap level is decompressed as a stream, and decoding
+		 * stops once the requested amount of data is available.
+		 * Other faces, layers, and z slices are not decompressed.
+		 *
+		 * @param buf		[out] Buffer storage.
+		 * @param mipinfo	[in] Mipmap level index.
+		 * @param size		[in] Data size.
+		 * @return Pointer to the image data, or nullptr on error.
+		 */
+		const uint8_t *loadSupercompressedData(aligned_buf_t &buf,
+			const KTX2_Mipmap_Index &mipinfo, size_t size);
+
 		/**
 		 * Load the image.
 		 * @param mip Mipmap number. (0 == full image)
@@ -112,6 +145,156 @@ KhronosKTX2Private::~KhronosKTX2Private()
 	std::for_each(mipmaps.begin(), mipmaps.end(), [](rp_image *img) { UNREF(img); });
 }
 
+/**
+ * Load supercompressed image data from a mipmap level.
+ *
+ * The mipmap level is decompressed as a stream, and decoding
+ * stops once the requested amount of data is available.
+ * Other faces, layers, and z slices are not decompressed.
+ *
+ * @param buf		[out] Buffer storage.
+ * @param mipinfo	[in] Mipmap level index.
+ * @param size		[in] Data size.
+ * @return Pointer to the image data, or nullptr on error.
+ */
+const uint8_t *KhronosKTX2Private::loadSupercompressedData(aligned_buf_t &buf,
+	const KTX2_Mipmap_Index &mipinfo, size_t size)
+{
+	assert(file != nullptr);
+	assert(size != 0);
+	if (!file || size == 0 || mipinfo.byteLength == 0)
+		return nullptr;
+
+	// Compressed data is read in chunks of up to 64 KB.
+	static const unsigned int Z_CHUNK_SIZE = 64*1024;
+	const size_t z_buf_size = static_cast<size_t>(
+		std::min(mipinfo.byteLength, static_cast<uint64_t>(Z_CHUNK_SIZE)));
+	unique_ptr<uint8_t[]> z_buf(new uint8_t[z_buf_size]);
+	buf = aligned_uptr<uint8_t>(16, size);
+	if (!buf) {
+		return nullptr;
+	}
+
+	int ret = file->seek(mipinfo.byteOffset);
+	if (ret != 0) {
+		// Seek error.
+		return nullptr;
+	}
+	uint64_t z_remain = mipinfo.byteLength;
+
+	switch (ktx2Header.supercompressionScheme) {
+		default:
+			assert(!"Unsupported supercompression scheme.");
+			return nullptr;
+
+		case KTX2_SUPERZ_ZLIB: {
+#if defined(_MSC_VER) && defined(ZLIB_IS_DLL)
+			// Delay load verification.
+			// TODO: Only if linked with /DELAYLOAD?
+			if (DelayLoad_test_zlibVersion() != 0) {
+				// Delay load failed.
+				return nullptr;
+			}
+#endif /* defined(_MSC_VER) && defined(ZLIB_IS_DLL) */
+
+			z_stream strm = { };
+			if (inflateInit(&strm) != Z_OK) {
+				return nullptr;
+			}
+			strm.next_out = buf.get();
+			strm.avail_out = static_cast<uInt>(size);
+
+			int status = Z_OK;
+			while (strm.avail_out > 0) {
+				if (strm.avail_in == 0) {
+					// Read the next chunk of compressed data.
+					if (z_remain == 0) {
+						// Out of compressed data.
+						break;
+					}
+					const size_t chunk_size = static_cast<size_t>(
+						std::min(z_remain, static_cast<uint64_t>(z_buf_size)));
+					if (file->read(z_buf.get(), chunk_size) != chunk_size) {
+						// Read error.
+						break;
+					}
+					z_remain -= chunk_size;
+					strm.next_in = z_buf.get();
+					strm.avail_in = static_cast<uInt>(chunk_size);
+				}
+
+				status = inflate(&strm, Z_NO_FLUSH);
+				if (status != Z_OK) {
+					// Either the stream ended, or an error occurred.
+					break;
+				}
+			}
+			inflateEnd(&strm);
+
+			if (strm.avail_out != 0 || (status != Z_OK && status != Z_STREAM_END)) {
+				// Not enough data was decompressed.
+				return nullptr;
+			}
+			break;
+		}
+
+#ifdef HAVE_ZSTD
+		case KTX2_SUPERZ_ZSTD: {
+#if defined(_MSC_VER) && defined(ZSTD_IS_DLL)
+			// Delay load verification.
+			// TODO: Only if linked with /DELAYLOAD?
+			if (DelayLoad_test_ZSTD_versionNumber() != 0) {
+				// Delay load failed.
+				return nullptr;
+			}
+#endif /* defined(_MSC_VER) && defined(ZSTD_IS_DLL) */
+
+			ZSTD_DStream *const zds = ZSTD_createDStream();
+			if (!zds) {
+				return nullptr;
+			}
+			ZSTD_initDStream(zds);
+			ZSTD_outBuffer out = { buf.get(), size, 0 };
+			ZSTD_inBuffer in = { z_buf.get(), 0, 0 };
+
+			while (out.pos < out.size) {
+				if (in.pos == in.size) {
+					// Read the next chunk of compressed data.
+					if (z_remain == 0) {
+						// Out of compressed data.
+						break;
+					}
+					const size_t chunk_size = static_cast<size_t>(
+						std::min(z_remain, static_cast<uint64_t>(z_buf_size)));
+					if (file->read(z_buf.get(), chunk_size) != chunk_size) {
+						// Read error.
+						break;
+					}
+					z_remain -= chunk_size;
+					in.size = chunk_size;
+					in.pos = 0;
+				}
+
+				const size_t zret = ZSTD_decompressStream(zds, &out, &in);
+				if (ZSTD_isError(zret) || (zret == 0 && out.pos < out.size)) {
+					// Decompression error, or the frame ended early.
+					break;
+				}
+			}
+			ZSTD_freeDStream(zds);
+
+			if (out.pos != out.size) {
+				// Not enough data was decompressed.
+				return nullptr;
+			}
+			break;
+		}
+#endif /* HAVE_ZSTD */
+	}
+
+	return buf.get();
+}
+
 /**
  * Load the image.
  * @param mip Mipmap number. (0 == full image)
@@ -152,9 +335,19 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 		return nullptr;
 	}
 
-	// TODO: Support supercompression.
-	if (ktx2Header.supercompressionScheme != 0) {
-		return nullptr;
+	// Check the supercompression scheme.
+	// TODO: BasisLZ. (requires a Basis Universal transcoder)
+	switch (ktx2Header.supercompressionScheme) {
+		case KTX2_SUPERZ_NONE:
+		case KTX2_SUPERZ_ZLIB:
+#ifdef HAVE_ZSTD
+		case KTX2_SUPERZ_ZSTD:
+#endif /* HAVE_ZSTD */
+			break;
+
+		default:
+			// Not supported.
+			return nullptr;
 	}
 
 	// TODO: For VK_FORMAT_UNDEFINED, parse the DFD.
@@ -197,13 +390,6 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 	}
 	const uint32_t file_sz = static_cast<uint32_t>(file->size());
 
-	// Seek to the start of the texture data.
-	int ret = file->seek(mipinfo.byteOffset);
-	if (ret != 0) {
-		// Seek error.
-		return nullptr;
-	}
-
 	// Calculate the expected size.
 	// NOTE: Scanlines are 4-byte aligned.
 	// TODO: Differences between UNORM, UINT, SRGB; handle SNORM, SINT.
@@ -317,23 +503,42 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			return nullptr;
 	}
 
-	// Verify mipmap size.
-	if (mipinfo.byteLength < expected_size) {
-		// Mipmap level is too small.
-		// TODO: Should we require the exact size?
-		return nullptr;
-	}
+	// Load the texture data.
+	aligned_buf_t buf_storage(nullptr, &aligned_free);
+	const uint8_t *buf;
+	if (ktx2Header.supercompressionScheme == KTX2_SUPERZ_NONE) {
+		// Verify mipmap size.
+		if (mipinfo.byteLength < expected_size) {
+			// Mipmap level is too small.
+			// TODO: Should we require the exact size?
+			return nullptr;
+		}
 
-	// Verify file size.
-	if (mipinfo.byteOffset + expected_size > file_sz) {
-		// File is too small.
-		return nullptr;
-	}
+		// Verify file size.
+		if (mipinfo.byteOffset + expected_size > file_sz) {
+			// File is too small.
+			return nullptr;
+		}
 
-	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->read(buf.get(), expected_size);
-	if (size != expected_size) {
+		buf = loadImageData(buf_storage, mipinfo.byteOffset, expected_size);
+	} else {
+		// Verify mipmap size.
+		// For supercompressed data, the uncompressed size
+		// of the mipmap level has to be checked.
+		if (mipinfo.uncompressedByteLength < expected_size) {
+			// Mipmap level is too small.
+			return nullptr;
+		}
+
+		// Verify file size.
+		if (mipinfo.byteLength > file_sz || mipinfo.byteOffset + mipinfo.byteLength > file_sz) {
+			// File is too small.
+			return nullptr;
+		}
+
+		buf = loadSupercompressedData(buf_storage, mipinfo, expected_size);
+	}
+	if (!buf) {
 		// Read error.
 		return nullptr;
 	}
@@ -347,7 +552,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// 24-bit RGB.
 			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_BGR888,
 				width, height,
-				buf.get(), expected_size, stride);
+				buf, expected_size, stride);
 			break;
 
 		case VK_FORMAT_B8G8R8_UNORM:
@@ -356,7 +561,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// 24-bit RGB. (R/B swapped)
 			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_RGB888,
 				width, height,
-				buf.get(), expected_size, stride);
+				buf, expected_size, stride);
 			break;
 
 		case VK_FORMAT_R8G8B8A8_UNORM:
@@ -365,7 +570,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// 32-bit RGBA.
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ABGR8888,
 				width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		case VK_FORMAT_B8G8R8A8_UNORM:
@@ -374,7 +579,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// 32-bit RGBA. (R/B swapped)
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ARGB8888,
 				width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		case VK_FORMAT_R8_UNORM:
@@ -384,14 +589,14 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// FIXME: Decode as red, not as L8.
 			img = ImageDecoder::fromLinear8(ImageDecoder::PXF_L8,
 				width, height,
-				buf.get(), expected_size, stride);
+				buf, expected_size, stride);
 			break;
 
 		case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
 			// Uncompressed "special" 32bpp formats.
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
 				width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
+				reinterpret_cast<const uint32_t*>(buf), expected_size, stride);
 			break;
 
 		// Compressed formats.
@@ -403,7 +608,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// DXT1-compressed texture.
 			img = ImageDecoder::fromDXT1(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
@@ -411,7 +616,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// DXT1-compressed texture with 1-bit alpha.
 			img = ImageDecoder::fromDXT1_A1(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_BC2_UNORM_BLOCK:
@@ -419,7 +624,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// DXT3-compressed texture.
 			img = ImageDecoder::fromDXT3(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_BC3_UNORM_BLOCK:
@@ -427,7 +632,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// DXT5-compressed texture.
 			img = ImageDecoder::fromDXT5(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
@@ -436,7 +641,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// TODO: Handle sRGB.
 			img = ImageDecoder::fromETC2_RGB(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
@@ -446,7 +651,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// TODO: Handle sRGB.
 			img = ImageDecoder::fromETC2_RGB_A1(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
@@ -456,7 +661,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// TODO: Handle sRGB.
 			img = ImageDecoder::fromETC2_RGBA(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 		case VK_FORMAT_BC7_UNORM_BLOCK:
@@ -464,7 +669,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// BPTC-compressed RGBA texture. (BC7)
 			img = ImageDecoder::fromBC7(
 				width, height,
-				buf.get(), expected_size);
+				buf, expected_size);
 			break;
 
 #ifdef ENABLE_PVRTC
@@ -475,7 +680,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 		case VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG:
 			// PVRTC, 2bpp.
 			img = ImageDecoder::fromPVRTC(width, height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 			break;
 
@@ -483,7 +688,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 		case VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG:
 			// PVRTC, 4bpp.
 			img = ImageDecoder::fromPVRTC(width, height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 			break;
 
@@ -491,7 +696,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 		case VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG:
 			// PVRTC-II, 2bpp.
 			img = ImageDecoder::fromPVRTCII(width, height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 			break;
 
@@ -500,7 +705,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 			// PVRTC-II, 4bpp.
 			// NOTE: Assuming this has alpha.
 			img = ImageDecoder::fromPVRTCII(width, height,
-				buf.get(), expected_size,
+				buf, expected_size,
 				ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 			break;
 #endif /* ENABLE_PVRTC */
@@ -513,11 +718,7 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 	// Post-processing: Check if a flip is needed.
 	if (img && (flipOp != rp_image::FLIP_NONE) && height > 1) {
 		// TODO: Assert that img dimensions match ktx2Header?
-		rp_image *const flipimg = img->flip(flipOp);
-		if (flipimg) {
-			img->unref();
-			img = flipimg;
-		}
+		img->flip_inplace(flipOp);
 	}
 
 	mipmaps[mip] = img;
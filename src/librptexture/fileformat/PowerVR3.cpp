@@ -424,10 +424,10 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 		return nullptr;
 	}
 
-	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, expected_size);
-	size_t size = file->seekAndRead(start_addr, buf.get(), expected_size);
-	if (size != expected_size) {
+	// Load the texture data.
+	aligned_buf_t buf_storage(nullptr, &aligned_free);
+	const uint8_t *const buf = loadImageData(buf_storage, start_addr, expected_size);
+	if (!buf) {
 		// Seek and/or read error.
 		return nullptr;
 	}
@@ -448,7 +448,7 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 				// 8-bit
 				img = ImageDecoder::fromLinear8(
 					static_cast<ImageDecoder::PixelFormat>(fmtLkup->pxfmt),
-					width, height, buf.get(), expected_size);
+					width, height, buf, expected_size);
 				break;
 
 			case 15:
@@ -457,14 +457,14 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 				img = ImageDecoder::fromLinear16(
 					static_cast<ImageDecoder::PixelFormat>(fmtLkup->pxfmt),
 					width, height,
-					reinterpret_cast<const uint16_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint16_t*>(buf), expected_size);
 				break;
 
 			case 24:
 				// 24-bit
 				img = ImageDecoder::fromLinear24(
 					static_cast<ImageDecoder::PixelFormat>(fmtLkup->pxfmt),
-					width, height, buf.get(), expected_size);
+					width, height, buf, expected_size);
 				break;
 
 			case 32:
@@ -472,7 +472,7 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 				img = ImageDecoder::fromLinear32(
 					static_cast<ImageDecoder::PixelFormat>(fmtLkup->pxfmt),
 					width, height,
-					reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint32_t*>(buf), expected_size);
 				break;
 
 			default:
@@ -486,110 +486,110 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 #ifdef ENABLE_PVRTC
 			case PVR3_PXF_PVRTC_2bpp_RGB:
 				// PVRTC, 2bpp, no alpha.
-				img = ImageDecoder::fromPVRTC(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTC(width, height, buf, expected_size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 				break;
 
 			case PVR3_PXF_PVRTC_2bpp_RGBA:
 				// PVRTC, 2bpp, has alpha.
-				img = ImageDecoder::fromPVRTC(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTC(width, height, buf, expected_size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
 			case PVR3_PXF_PVRTC_4bpp_RGB:
 				// PVRTC, 4bpp, no alpha.
-				img = ImageDecoder::fromPVRTC(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTC(width, height, buf, expected_size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_NONE);
 				break;
 
 			case PVR3_PXF_PVRTC_4bpp_RGBA:
 				// PVRTC, 4bpp, has alpha.
-				img = ImageDecoder::fromPVRTC(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTC(width, height, buf, expected_size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
 			case PVR3_PXF_PVRTCII_2bpp:
 				// PVRTC-II, 2bpp.
 				// NOTE: Assuming this has alpha.
-				img = ImageDecoder::fromPVRTCII(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTCII(width, height, buf, expected_size,
 					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 
 			case PVR3_PXF_PVRTCII_4bpp:
 				// PVRTC-II, 4bpp.
 				// NOTE: Assuming this has alpha.
-				img = ImageDecoder::fromPVRTCII(width, height, buf.get(), expected_size,
+				img = ImageDecoder::fromPVRTCII(width, height, buf, expected_size,
 					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
 				break;
 #endif /* ENABLE_PVRTC */
 
 			case PVR3_PXF_ETC1:
 				// ETC1-compressed texture.
-				img = ImageDecoder::fromETC1(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromETC1(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_ETC2_RGB:
 				// ETC2-compressed RGB texture.
-				img = ImageDecoder::fromETC2_RGB(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromETC2_RGB(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_ETC2_RGB_A1:
 				// ETC2-compressed RGB texture
 				// with punchthrough alpha.
-				img = ImageDecoder::fromETC2_RGB_A1(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromETC2_RGB_A1(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_ETC2_RGBA:
 				// ETC2-compressed RGB texture
 				// with EAC-compressed alpha channel.
-				img = ImageDecoder::fromETC2_RGBA(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromETC2_RGBA(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_DXT1:
 				// DXT1-compressed texture.
-				img = ImageDecoder::fromDXT1(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT1(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_DXT2:
 				// DXT2-compressed texture.
-				img = ImageDecoder::fromDXT2(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT2(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_DXT3:
 				// DXT3-compressed texture.
-				img = ImageDecoder::fromDXT3(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT3(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_DXT4:
 				// DXT4-compressed texture.
-				img = ImageDecoder::fromDXT4(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT4(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_DXT5:
 				// DXT2-compressed texture.
-				img = ImageDecoder::fromDXT5(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromDXT5(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_BC4:
 				// RGTC, one component. (BC4)
-				img = ImageDecoder::fromBC4(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromBC4(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_BC5:
 				// RGTC, two components. (BC5)
-				img = ImageDecoder::fromBC5(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromBC5(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_BC7:
 				// BC7-compressed texture.
-				img = ImageDecoder::fromBC7(width, height, buf.get(), expected_size);
+				img = ImageDecoder::fromBC7(width, height, buf, expected_size);
 				break;
 
 			case PVR3_PXF_R9G9B9E5:
 				// RGB9_E5 (technically uncompressed...)
 				img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
 					width, height,
-					reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
+					reinterpret_cast<const uint32_t*>(buf), expected_size);
 				break;
 
 			default:
@@ -605,11 +605,7 @@ const rp_image *PowerVR3Private::loadImage(int mip)
 	// Post-processing: Check if a flip is needed.
 	if (img && (flipOp != rp_image::FLIP_NONE) && height > 1) {
 		// TODO: Assert that img dimensions match ktxHeader?
-		rp_image *const flipimg = img->flip(flipOp);
-		if (flipimg) {
-			img->unref();
-			img = flipimg;
-		}
+		img->flip_inplace(flipOp);
 	}
 
 	mipmaps[mip] = img;
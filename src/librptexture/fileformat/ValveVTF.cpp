@@ -55,6 +55,9 @@ class ValveVTFPrivate final : public FileFormatPrivate
 		// Mipmap 0 is the full image.
 		vector<rp_image*> mipmaps;
 
+		// Decoded low-resolution image.
+		rp_image *lowResImg;
+
 		// Mipmap sizes and start addresses.
 		struct mipmap_data_t {
 			uint32_t addr;		// start address
@@ -103,6 +106,22 @@ class ValveVTFPrivate final : public FileFormatPrivate
 		 */
 		const rp_image *loadImage(int mip);
 
+		/**
+		 * Decode VTF image data.
+		 * @param format VTF image format.
+		 * @param mdata Image dimensions and size.
+		 * @param buf Image data. (must be mdata.size bytes)
+		 * @return Image, or nullptr on error.
+		 */
+		static rp_image *decodeImageData(int format, const mipmap_data_t &mdata, const uint8_t *buf);
+
+		/**
+		 * Load the low-resolution image.
+		 * This is stored immediately before the high-resolution mipmaps.
+		 * @return Image, or nullptr on error.
+		 */
+		const rp_image *loadLowResImage(void);
+
 #if SYS_BYTEORDER == SYS_BIG_ENDIAN
 		/**
 		 * Byteswap a float. (TODO: Move to byteswap.h?)
@@ -162,6 +181,7 @@ static_assert(ARRAY_SIZE(ValveVTFPrivate::img_format_tbl)-1 == VTF_IMAGE_FORMAT_
 ValveVTFPrivate::ValveVTFPrivate(ValveVTF *q, IRpFile *file)
 	: super(q, file)
 	, texDataStartAddr(0)
+	, lowResImg(nullptr)
 {
 	// Clear the structs and arrays.
 	memset(&vtfHeader, 0, sizeof(vtfHeader));
@@ -171,6 +191,7 @@ ValveVTFPrivate::ValveVTFPrivate(ValveVTF *q, IRpFile *file)
 ValveVTFPrivate::~ValveVTFPrivate()
 {
 	std::for_each(mipmaps.begin(), mipmaps.end(), [](rp_image *img) { UNREF(img); });
+	UNREF(lowResImg);
 }
 
 /**
@@ -417,108 +438,33 @@ int ValveVTFPrivate::getMipmapInfo(void)
 }
 
 /**
- * Load the image.
- * @param mip Mipmap number. (0 == full image)
+ * Decode VTF image data.
+ * @param format VTF image format.
+ * @param mdata Image dimensions and size.
+ * @param buf Image data. (must be mdata.size bytes)
  * @return Image, or nullptr on error.
  */
-const rp_image *ValveVTFPrivate::loadImage(int mip)
+rp_image *ValveVTFPrivate::decodeImageData(int format, const mipmap_data_t &mdata, const uint8_t *buf)
 {
-	// TODO: Option to load the low-res image instead?
-	int mipmapCount = vtfHeader.mipmapCount;
-	if (mipmapCount <= 0) {
-		// No mipmaps == one image.
-		mipmapCount = 1;
-	}
-
-	assert(mip >= 0);
-	assert(mip < mipmapCount);
-	if (mip < 0 || mip >= mipmapCount) {
-		// Invalid mipmap number.
-		return nullptr;
-	}
-
-	if (!mipmaps.empty() && mipmaps[mip] != nullptr) {
-		// Image has already been loaded.
-		return mipmaps[mip];
-	} else if (!this->file || !this->isValid) {
-		// Can't load the image.
-		return nullptr;
-	}
-
-	// Sanity check: Maximum image dimensions of 32768x32768.
-	// NOTE: `height == 0` is allowed here. (1D texture)
-	assert(vtfHeader.width > 0);
-	assert(vtfHeader.width <= 32768);
-	assert(vtfHeader.height <= 32768);
-	if (vtfHeader.width == 0 || vtfHeader.width > 32768 ||
-	    vtfHeader.height > 32768)
-	{
-		// Invalid image dimensions.
-		return nullptr;
-	}
-
-	if (file->size() > 128*1024*1024) {
-		// Sanity check: VTF files shouldn't be more than 128 MB.
-		return nullptr;
-	}
-	const uint32_t file_sz = static_cast<uint32_t>(file->size());
-
-	// Make sure we have the mipmap info.
-	int ret = getMipmapInfo();
-	assert(ret == 0);
-	assert(!mipmap_data.empty());
-	if (ret != 0 || mipmap_data.empty()) {
-		// Error getting the mipmap info.
-		return nullptr;
-	}
-	const auto &mdata = mipmap_data[mip];
-
-	// TODO: Handle environment maps (6-faced cube map) and volumetric textures.
-
-	// Verify file size.
-	if (mdata.addr + mdata.size > file_sz) {
-		// File is too small.
-		return nullptr;
-	}
-
-	// Texture cannot start inside of the VTF header.
-	assert(mdata.addr >= sizeof(vtfHeader));
-	if (mdata.addr < sizeof(vtfHeader)) {
-		// Invalid texture data start address.
-		return nullptr;
-	}
-
-	// Read the texture data.
-	auto buf = aligned_uptr<uint8_t>(16, mdata.size);
-	size_t size = file->seekAndRead(mdata.addr, buf.get(), mdata.size);
-	if (size != mdata.size) {
-		// Read error.
-		return nullptr;
-	}
-
-	// FIXME: Smaller mipmaps have read errors if encoded with e.g. DXTn,
-	// since the width is smaller than 4.
-
-	// Decode the image.
 	// NOTE: VTF channel ordering does NOT match ImageDecoder channel ordering.
 	// (The channels appear to be backwards.)
 	// TODO: Lookup table to convert to PXF constants?
 	// TODO: Verify on big-endian?
 	rp_image *img = nullptr;
-	switch (vtfHeader.highResImageFormat) {
+	switch (format) {
 		/* 32-bit */
 		case VTF_IMAGE_FORMAT_RGBA8888:
 		case VTF_IMAGE_FORMAT_UVWQ8888:	// handling as RGBA8888
 		case VTF_IMAGE_FORMAT_UVLX8888:	// handling as RGBA8888
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ABGR8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 		case VTF_IMAGE_FORMAT_ABGR8888:
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGBA8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 		case VTF_IMAGE_FORMAT_ARGB8888:
@@ -526,19 +472,19 @@ const rp_image *ValveVTFPrivate::loadImage(int mip)
 			// FIXME: May be a bug in VTFEdit. (Tested versions: 1.2.5, 1.3.3)
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RABG8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRA8888:
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ARGB8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRx8888:
 			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_xRGB8888,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint32_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint32_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint32_t));
 			break;
 
@@ -546,26 +492,26 @@ const rp_image *ValveVTFPrivate::loadImage(int mip)
 		case VTF_IMAGE_FORMAT_RGB888:
 			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_BGR888,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width * 3);
 			break;
 		case VTF_IMAGE_FORMAT_BGR888:
 			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_RGB888,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width * 3);
 			break;
 		case VTF_IMAGE_FORMAT_RGB888_BLUESCREEN:
 			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_BGR888,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width * 3);
 			img->apply_chroma_key(0xFF0000FF);
 			break;
 		case VTF_IMAGE_FORMAT_BGR888_BLUESCREEN:
 			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_RGB888,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width * 3);
 			img->apply_chroma_key(0xFF0000FF);
 			break;
@@ -574,31 +520,31 @@ const rp_image *ValveVTFPrivate::loadImage(int mip)
 		case VTF_IMAGE_FORMAT_RGB565:
 			img = ImageDecoder::fromLinear16(ImageDecoder::PXF_BGR565,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGR565:
 			img = ImageDecoder::fromLinear16(ImageDecoder::PXF_RGB565,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRx5551:
 			img = ImageDecoder::fromLinear16(ImageDecoder::PXF_RGB555,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRA4444:
 			img = ImageDecoder::fromLinear16(ImageDecoder::PXF_ARGB4444,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_BGRA5551:
 			img = ImageDecoder::fromLinear16(ImageDecoder::PXF_ARGB1555,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_IA88:
@@ -610,14 +556,14 @@ const rp_image *ValveVTFPrivate::loadImage(int mip)
 			// TODO: Add ImageDecoder::fromLinear16() support for IA8 later.
 			img = ImageDecoder::fromLinear16(ImageDecoder::PXF_A8L8,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 		case VTF_IMAGE_FORMAT_UV88:
 			// We're handling this as a GR88 texture.
 			img = ImageDecoder::fromLinear16(ImageDecoder::PXF_GR88,
 				mdata.width, mdata.height,
-				reinterpret_cast<const uint16_t*>(buf.get()), mdata.size,
+				reinterpret_cast<const uint16_t*>(buf), mdata.size,
 				mdata.row_width * sizeof(uint16_t));
 			break;
 
@@ -628,13 +574,13 @@ const rp_image *ValveVTFPrivate::loadImage(int mip)
 			// https://www.opengl.org/discussion_boards/showthread.php/151701-GL_LUMINANCE-vs-GL_INTENSITY
 			img = ImageDecoder::fromLinear8(ImageDecoder::PXF_L8,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width);
 			break;
 		case VTF_IMAGE_FORMAT_A8:
 			img = ImageDecoder::fromLinear8(ImageDecoder::PXF_A8,
 				mdata.width, mdata.height,
-				buf.get(), mdata.size,
+				buf, mdata.size,
 				mdata.row_width);
 			break;
 
@@ -642,22 +588,22 @@ const rp_image *ValveVTFPrivate::loadImage(int mip)
 		case VTF_IMAGE_FORMAT_DXT1:
 			img = ImageDecoder::fromDXT1(
 				mdata.width, mdata.height,
-				buf.get(), mdata.size);
+				buf, mdata.size);
 			break;
 		case VTF_IMAGE_FORMAT_DXT1_ONEBITALPHA:
 			img = ImageDecoder::fromDXT1_A1(
 				mdata.width, mdata.height,
-				buf.get(), mdata.size);
+				buf, mdata.size);
 			break;
 		case VTF_IMAGE_FORMAT_DXT3:
 			img = ImageDecoder::fromDXT3(
 				mdata.width, mdata.height,
-				buf.get(), mdata.size);
+				buf, mdata.size);
 			break;
 		case VTF_IMAGE_FORMAT_DXT5:
 			img = ImageDecoder::fromDXT5(
 				mdata.width, mdata.height,
-				buf.get(), mdata.size);
+				buf, mdata.size);
 			break;
 
 		case VTF_IMAGE_FORMAT_P8:
@@ -668,10 +614,167 @@ const rp_image *ValveVTFPrivate::loadImage(int mip)
 			break;
 	}
 
+	return img;
+}
+
+/**
+ * Load the image.
+ * @param mip Mipmap number. (0 == full image)
+ * @return Image, or nullptr on error.
+ */
+const rp_image *ValveVTFPrivate::loadImage(int mip)
+{
+	int mipmapCount = vtfHeader.mipmapCount;
+	if (mipmapCount <= 0) {
+		// No mipmaps == one image.
+		mipmapCount = 1;
+	}
+
+	assert(mip >= 0);
+	assert(mip < mipmapCount);
+	if (mip < 0 || mip >= mipmapCount) {
+		// Invalid mipmap number.
+		return nullptr;
+	}
+
+	if (!mipmaps.empty() && mipmaps[mip] != nullptr) {
+		// Image has already been loaded.
+		return mipmaps[mip];
+	} else if (!this->file || !this->isValid) {
+		// Can't load the image.
+		return nullptr;
+	}
+
+	// Sanity check: Maximum image dimensions of 32768x32768.
+	// NOTE: `height == 0` is allowed here. (1D texture)
+	assert(vtfHeader.width > 0);
+	assert(vtfHeader.width <= 32768);
+	assert(vtfHeader.height <= 32768);
+	if (vtfHeader.width == 0 || vtfHeader.width > 32768 ||
+	    vtfHeader.height > 32768)
+	{
+		// Invalid image dimensions.
+		return nullptr;
+	}
+
+	if (file->size() > 128*1024*1024) {
+		// Sanity check: VTF files shouldn't be more than 128 MB.
+		return nullptr;
+	}
+	const uint32_t file_sz = static_cast<uint32_t>(file->size());
+
+	// Make sure we have the mipmap info.
+	int ret = getMipmapInfo();
+	assert(ret == 0);
+	assert(!mipmap_data.empty());
+	if (ret != 0 || mipmap_data.empty()) {
+		// Error getting the mipmap info.
+		return nullptr;
+	}
+	const auto &mdata = mipmap_data[mip];
+
+	// TODO: Handle environment maps (6-faced cube map) and volumetric textures.
+
+	// Verify file size.
+	if (mdata.addr + mdata.size > file_sz) {
+		// File is too small.
+		return nullptr;
+	}
+
+	// Texture cannot start inside of the VTF header.
+	assert(mdata.addr >= sizeof(vtfHeader));
+	if (mdata.addr < sizeof(vtfHeader)) {
+		// Invalid texture data start address.
+		return nullptr;
+	}
+
+	// Read the texture data.
+	auto buf = aligned_uptr<uint8_t>(16, mdata.size);
+	size_t size = file->seekAndRead(mdata.addr, buf.get(), mdata.size);
+	if (size != mdata.size) {
+		// Read error.
+		return nullptr;
+	}
+
+	// FIXME: Smaller mipmaps have read errors if encoded with e.g. DXTn,
+	// since the width is smaller than 4.
+
+	// Decode the image.
+	rp_image *const img = decodeImageData(vtfHeader.highResImageFormat, mdata, buf.get());
 	mipmaps[mip] = img;
 	return img;
 }
 
+/**
+ * Load the low-resolution image.
+ * This is stored immediately before the high-resolution mipmaps.
+ * @return Image, or nullptr on error.
+ */
+const rp_image *ValveVTFPrivate::loadLowResImage(void)
+{
+	if (lowResImg) {
+		// Image has already been loaded.
+		return lowResImg;
+	} else if (!this->file || !this->isValid) {
+		// Can't load the image.
+		return nullptr;
+	}
+
+	// Low-resolution image is optional.
+	// NOTE: `height == 0` is allowed here. (1D texture)
+	if (vtfHeader.lowResImageFormat < 0 ||
+	    vtfHeader.lowResImageFormat >= VTF_IMAGE_FORMAT_MAX ||
+	    vtfHeader.lowResImageWidth == 0)
+	{
+		// No low-resolution image.
+		return nullptr;
+	}
+
+	if (file->size() > 128*1024*1024) {
+		// Sanity check: VTF files shouldn't be more than 128 MB.
+		return nullptr;
+	}
+	const uint32_t file_sz = static_cast<uint32_t>(file->size());
+
+	mipmap_data_t mdata;
+	mdata.addr = texDataStartAddr;
+	mdata.width = vtfHeader.lowResImageWidth;
+	mdata.height = (vtfHeader.lowResImageHeight > 0 ? vtfHeader.lowResImageHeight : 1);
+	mdata.row_width = mdata.width;
+	mdata.size = calcImageSize(
+		static_cast<VTF_IMAGE_FORMAT>(vtfHeader.lowResImageFormat),
+		mdata.width, mdata.height);
+	if (mdata.size == 0) {
+		// Unsupported image format.
+		return nullptr;
+	}
+
+	// Verify file size.
+	if (mdata.addr + mdata.size > file_sz) {
+		// File is too small.
+		return nullptr;
+	}
+
+	// Texture cannot start inside of the VTF header.
+	assert(mdata.addr >= sizeof(vtfHeader));
+	if (mdata.addr < sizeof(vtfHeader)) {
+		// Invalid texture data start address.
+		return nullptr;
+	}
+
+	// Read the texture data.
+	auto buf = aligned_uptr<uint8_t>(16, mdata.size);
+	size_t size = file->seekAndRead(mdata.addr, buf.get(), mdata.size);
+	if (size != mdata.size) {
+		// Read error.
+		return nullptr;
+	}
+
+	// Decode the image.
+	lowResImg = decodeImageData(vtfHeader.lowResImageFormat, mdata, buf.get());
+	return lowResImg;
+}
+
 /** ValveVTF **/
 
 /**
@@ -1066,4 +1169,45 @@ const rp_image *ValveVTF::mipmap(int mip) const
 	return const_cast<ValveVTFPrivate*>(d)->loadImage(mip);
 }
 
+/**
+ * Get the dimensions of the embedded low-resolution image.
+ * @param pBuf Two-element array for [x, y].
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int ValveVTF::getLowResDimensions(int pBuf[2]) const
+{
+	RP_D(const ValveVTF);
+	if (!d->isValid) {
+		// Unknown file type.
+		return -EBADF;
+	}
+
+	const VTFHEADER *const vtfHeader = &d->vtfHeader;
+	if (vtfHeader->lowResImageFormat < 0 || vtfHeader->lowResImageWidth == 0) {
+		// No low-resolution image.
+		return -ENOENT;
+	}
+
+	pBuf[0] = vtfHeader->lowResImageWidth;
+	pBuf[1] = (vtfHeader->lowResImageHeight > 0 ? vtfHeader->lowResImageHeight : 1);
+	return 0;
+}
+
+/**
+ * Get the embedded low-resolution image.
+ * The image is owned by this object.
+ * @return Image, or nullptr if not available.
+ */
+const rp_image *ValveVTF::lowResImage(void) const
+{
+	RP_D(const ValveVTF);
+	if (!d->isValid) {
+		// Unknown file type.
+		return nullptr;
+	}
+
+	// Load the image.
+	return const_cast<ValveVTFPrivate*>(d)->loadLowResImage();
+}
+
 }
@@ -39,6 +39,7 @@ RpGdiplusBackend::RpGdiplusBackend(int width, int height, rp_image::Format forma
 	, m_bytesppShift(0)
 	, m_gdipFmt(0)
 	, m_pImgBuf(nullptr)
+	, m_hbmDib(nullptr)
 	, m_pGdipPalette(nullptr)
 {
 	memset(&m_gdipBmpData, 0, sizeof(m_gdipBmpData));
@@ -69,7 +70,14 @@ RpGdiplusBackend::RpGdiplusBackend(int width, int height, rp_image::Format forma
 			clear_properties();
 			return;
 	}
-	m_pGdipBmp = new Gdiplus::Bitmap(width, height, m_gdipFmt);
+	if (format == rp_image::Format::ARGB32) {
+		// Store the pixels in a DIB section so the image
+		// can be converted to HBITMAP without copying.
+		m_pGdipBmp = createDibBitmap(width, height);
+	}
+	if (!m_pGdipBmp) {
+		m_pGdipBmp = new Gdiplus::Bitmap(width, height, m_gdipFmt);
+	}
 
 	// Do the initial lock.
 	if (doInitialLock() != 0)
@@ -86,7 +94,8 @@ RpGdiplusBackend::RpGdiplusBackend(int width, int height, rp_image::Format forma
 		// followed by the palette. That's 8 extra bytes.
 		static_assert(sizeof(Gdiplus::ColorPalette) == 12, "Need to fix Gdiplus::ColorPalette alignment adjustments!");
 		const size_t gdipPalette_sz = sizeof(Gdiplus::ColorPalette) + (sizeof(Gdiplus::ARGB)*255);
-		uint8_t *const pPalData = static_cast<uint8_t*>(aligned_malloc(16, gdipPalette_sz + 8));
+		uint8_t *const pPalData = static_cast<uint8_t*>(aligned_malloc_tag(
+			LibRpFile::RpAllocStats::TAG_RP_IMAGE, 16, gdipPalette_sz + 8));
 		if (!pPalData) {
 			// ENOMEM
 			delete m_pGdipBmp;
@@ -120,6 +129,7 @@ RpGdiplusBackend::RpGdiplusBackend(Gdiplus::Bitmap *pGdipBmp)
 	, m_bytesppShift(0)
 	, m_gdipFmt(0)
 	, m_pImgBuf(nullptr)
+	, m_hbmDib(nullptr)
 	, m_pGdipPalette(nullptr)
 {
 	assert(pGdipBmp != nullptr);
@@ -214,7 +224,7 @@ RpGdiplusBackend::~RpGdiplusBackend()
 {
 	if (m_pGdipBmp) {
 		// TODO: Is an Unlock required here?
-		if (m_isLocked) {
+		if (m_isLocked && !m_hbmDib) {
 			m_pGdipBmp->UnlockBits(&m_gdipBmpData);
 		}
 		delete m_pGdipBmp;
@@ -227,7 +237,12 @@ RpGdiplusBackend::~RpGdiplusBackend()
 		aligned_free(pPalData);
 	}
 
-	aligned_free(m_pImgBuf);
+	if (m_hbmDib) {
+		// m_pImgBuf is owned by the DIB section.
+		DeleteObject(m_hbmDib);
+	} else {
+		aligned_free(m_pImgBuf);
+	}
 	if (m_gdipToken != 0) {
 		GdiplusHelper::ShutdownGDIPlus(m_gdipToken);
 	}
@@ -246,6 +261,11 @@ int RpGdiplusBackend::doInitialLock(void)
 		// Error locking the GDI+ bitmap.
 		delete m_pGdipBmp;
 		m_pGdipBmp = nullptr;
+		if (m_hbmDib) {
+			DeleteObject(m_hbmDib);
+			m_hbmDib = nullptr;
+			m_pImgBuf = nullptr;
+		}
 		m_gdipFmt = 0;
 		this->width = 0;
 		this->height = 0;
@@ -256,6 +276,65 @@ int RpGdiplusBackend::doInitialLock(void)
 	return 0;
 }
 
+/**
+ * Create a Gdiplus::Bitmap whose pixels are stored in a DIB section.
+ * This is only done for ARGB32 images whose row size is already
+ * 16-byte aligned, since rp_image requires 16-byte stride alignment
+ * and DIB sections are always 4-byte aligned.
+ *
+ * On success, m_hbmDib and m_pImgBuf are set.
+ *
+ * @param width Image width.
+ * @param height Image height.
+ * @return Gdiplus::Bitmap, or nullptr if a DIB section can't be used.
+ */
+Gdiplus::Bitmap *RpGdiplusBackend::createDibBitmap(int width, int height)
+{
+	assert(m_hbmDib == nullptr);
+	const int stride = width * 4;
+	if (stride != ALIGN_BYTES(16, stride)) {
+		// Row size isn't 16-byte aligned.
+		return nullptr;
+	}
+
+	BITMAPINFO bmi;
+	BITMAPINFOHEADER *const bmiHeader = &bmi.bmiHeader;
+	bmiHeader->biSize = sizeof(BITMAPINFOHEADER);
+	bmiHeader->biWidth = width;
+	bmiHeader->biHeight = -height;	// Top-down
+	bmiHeader->biPlanes = 1;
+	bmiHeader->biBitCount = 32;
+	bmiHeader->biCompression = BI_RGB;
+	bmiHeader->biSizeImage = 0;
+	bmiHeader->biXPelsPerMeter = 0;
+	bmiHeader->biYPelsPerMeter = 0;
+	bmiHeader->biClrUsed = 0;
+	bmiHeader->biClrImportant = 0;
+
+	// NOTE: DIB sections are page-aligned, so the
+	// 16-byte alignment requirement is satisfied.
+	void *pvBits;
+	HBITMAP hBitmap = CreateDIBSection(nullptr, &bmi, DIB_RGB_COLORS, &pvBits, nullptr, 0);
+	if (!hBitmap) {
+		// Could not create the DIB section.
+		return nullptr;
+	}
+	ASSERT_ALIGNMENT(16, pvBits);
+
+	// GDI+ will use the DIB section's pixels directly.
+	Gdiplus::Bitmap *const pGdipBmp = new Gdiplus::Bitmap(
+		width, height, stride, PixelFormat32bppARGB, static_cast<BYTE*>(pvBits));
+	if (pGdipBmp->GetLastStatus() != Gdiplus::Status::Ok) {
+		delete pGdipBmp;
+		DeleteObject(hBitmap);
+		return nullptr;
+	}
+
+	m_hbmDib = hBitmap;
+	m_pImgBuf = pvBits;
+	return pGdipBmp;
+}
+
 /**
  * Creator function for rp_image::setBackendCreatorFn().
  */
@@ -333,6 +412,48 @@ int RpGdiplusBackend::shrink(int width, int height)
 		return -EINVAL;
 	}
 
+	if (m_hbmDib) {
+		// The DIB section has to match the image size,
+		// so allocate a new one and copy the pixels over.
+		HBITMAP const hbmDib_old = m_hbmDib;
+		const uint8_t *src = static_cast<const uint8_t*>(m_pImgBuf);
+		const int src_stride = this->stride;
+		m_hbmDib = nullptr;
+		m_pImgBuf = nullptr;
+
+		Gdiplus::Bitmap *pGdipBmp_new = createDibBitmap(width, height);
+		if (pGdipBmp_new) {
+			uint8_t *dest = static_cast<uint8_t*>(m_pImgBuf);
+			const int dest_stride = width * 4;
+			for (int y = height; y > 0; y--) {
+				memcpy(dest, src, dest_stride);
+				dest += dest_stride;
+				src += src_stride;
+			}
+		} else {
+			// Can't use a DIB section for the new size.
+			// Use a regular GDI+ bitmap instead.
+			Gdiplus::Bitmap *const pGdipBmp_tmp = new Gdiplus::Bitmap(
+				this->width, this->height, src_stride, m_gdipFmt,
+				const_cast<BYTE*>(src));
+			pGdipBmp_new = pGdipBmp_tmp->Clone(0, 0, width, height, m_gdipFmt);
+			delete pGdipBmp_tmp;
+		}
+
+		delete m_pGdipBmp;
+		DeleteObject(hbmDib_old);
+		m_pGdipBmp = pGdipBmp_new;
+		m_isLocked = false;
+		if (!m_pGdipBmp) {
+			return -ENOMEM;
+		}
+
+		this->width = width;
+		this->height = height;
+		Gdiplus::Status status = this->lock();
+		return (status == Gdiplus::Status::Ok ? 0 : -EIO);
+	}
+
 	// TODO: Is there a way to resize the Gdiplus::Bitmap in place?
 	// NOTE: Lock() locks a region, so maybe we could use that, but
 	// Gdiplus::Bitmap to HBITMAP conversion uses the whole image...
@@ -363,6 +484,21 @@ Gdiplus::Status RpGdiplusBackend::lock(void)
 	// TODO: Atomic locking?
 	if (m_isLocked)
 		return Gdiplus::Status::Ok;
+	else if (!m_pGdipBmp)
+		return Gdiplus::Status::InvalidParameter;
+
+	if (m_hbmDib) {
+		// The GDI+ bitmap uses the DIB section's pixels directly,
+		// so LockBits() isn't needed.
+		m_gdipBmpData.Width = this->width;
+		m_gdipBmpData.Height = this->height;
+		m_gdipBmpData.Stride = this->width * 4;
+		m_gdipBmpData.PixelFormat = m_gdipFmt;
+		m_gdipBmpData.Scan0 = m_pImgBuf;
+		this->stride = m_gdipBmpData.Stride;
+		m_isLocked = true;
+		return Gdiplus::Status::Ok;
+	}
 
 	// We're using the full stride for the last row
 	// to make it easier to manage.
@@ -374,7 +510,8 @@ Gdiplus::Status RpGdiplusBackend::lock(void)
 
 	if (!m_pImgBuf) {
 		// Allocate the image buffer.
-		m_pImgBuf = aligned_malloc(16, m_gdipBmpData.Stride * this->height);
+		m_pImgBuf = aligned_malloc_tag(LibRpFile::RpAllocStats::TAG_RP_IMAGE,
+			16, m_gdipBmpData.Stride * this->height);
 		if (!m_pImgBuf) {
 			// malloc() failed.
 			return Gdiplus::Status::OutOfMemory;
@@ -419,6 +556,13 @@ Gdiplus::Status RpGdiplusBackend::unlock(void)
 	if (!m_isLocked)
 		return Gdiplus::Status::Ok;
 
+	if (m_hbmDib) {
+		// Make sure GDI is done with the DIB section.
+		GdiFlush();
+		m_isLocked = false;
+		return Gdiplus::Status::Ok;
+	}
+
 	Gdiplus::Status status = m_pGdipBmp->UnlockBits(&m_gdipBmpData);
 	if (status == Gdiplus::Status::Ok) {
 		m_isLocked = false;
@@ -813,6 +957,36 @@ HBITMAP RpGdiplusBackend::toHBITMAP_alpha(const SIZE &size, bool nearest)
 	return hBitmap;
 }
 
+/**
+ * Detach the DIB section containing the image data.
+ * Caller must delete the HBITMAP.
+ *
+ * This hands the image data to the caller without copying it.
+ * The backend is cleared afterwards, so this should only be
+ * used on temporary images that are about to be deleted.
+ *
+ * @return HBITMAP, or nullptr if the image isn't stored in a DIB section.
+ */
+HBITMAP RpGdiplusBackend::detachHBITMAP(void)
+{
+	if (!m_hbmDib)
+		return nullptr;
+
+	// The GDI+ bitmap references the DIB section's pixels,
+	// so it has to be deleted before the HBITMAP is released.
+	delete m_pGdipBmp;
+	m_pGdipBmp = nullptr;
+	m_isLocked = false;
+	memset(&m_gdipBmpData, 0, sizeof(m_gdipBmpData));
+	m_gdipFmt = 0;
+	clear_properties();
+
+	HBITMAP const hBitmap = m_hbmDib;
+	m_hbmDib = nullptr;
+	m_pImgBuf = nullptr;
+	return hBitmap;
+}
+
 /**
  * Convert a locked ARGB32 GDI+ bitmap to an HBITMAP.
  * Alpha transparency is preserved.
@@ -71,6 +71,20 @@ class RpGdiplusBackend : public rp_image_backend
 		 */
 		int doInitialLock(void);
 
+		/**
+		 * Create a Gdiplus::Bitmap whose pixels are stored in a DIB section.
+		 * This is only done for ARGB32 images whose row size is already
+		 * 16-byte aligned, since rp_image requires 16-byte stride alignment
+		 * and DIB sections are always 4-byte aligned.
+		 *
+		 * On success, m_hbmDib and m_pImgBuf are set.
+		 *
+		 * @param width Image width.
+		 * @param height Image height.
+		 * @return Gdiplus::Bitmap, or nullptr if a DIB section can't be used.
+		 */
+		Gdiplus::Bitmap *createDibBitmap(int width, int height);
+
 	public:
 		/**
 		 * Creator function for rp_image::setBackendCreatorFn().
@@ -191,6 +205,18 @@ class RpGdiplusBackend : public rp_image_backend
 		 */
 		HBITMAP toHBITMAP_alpha(const SIZE &size, bool nearest);
 
+		/**
+		 * Detach the DIB section containing the image data.
+		 * Caller must delete the HBITMAP.
+		 *
+		 * This hands the image data to the caller without copying it.
+		 * The backend is cleared afterwards, so this should only be
+		 * used on temporary images that are about to be deleted.
+		 *
+		 * @return HBITMAP, or nullptr if the image isn't stored in a DIB section.
+		 */
+		HBITMAP detachHBITMAP(void);
+
 	protected:
 		/**
 		 * Convert a locked ARGB32 GDI+ bitmap to an HBITMAP.
@@ -219,7 +245,10 @@ class RpGdiplusBackend : public rp_image_backend
 		Gdiplus::BitmapData m_gdipBmpData;
 
 		// Allocated image buffer for Bitmap::LockBits().
+		// If m_hbmDib is set, this points to the DIB section's pixels,
+		// and m_pGdipBmp uses this buffer directly.
 		void *m_pImgBuf;
+		HBITMAP m_hbmDib;
 
 		// Color palette.
 		// Pointer to Entries[0] is used for rp_image_backend::palette.
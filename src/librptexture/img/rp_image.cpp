@@ -10,6 +10,7 @@
 #include "rp_image.hpp"
 #include "rp_image_p.hpp"
 #include "rp_image_backend.hpp"
+#include "rp_image_bufpool.hpp"
 
 // Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
 #define rp_imagePrivate rp_image_private
@@ -68,9 +69,22 @@ class rp_image_backend_default : public rp_image_backend
 		 */
 		int shrink(int width, int height) final;
 
+		/**
+		 * Grow image dimensions without reallocating the image data.
+		 *
+		 * This is only possible if the pooled image data buffer
+		 * is large enough for the new dimensions.
+		 *
+		 * @param width New width.
+		 * @param height New height.
+		 * @return 0 on success; -ENOMEM if the image data buffer is too small; negative POSIX error code on error.
+		 */
+		int grow(int width, int height) final;
+
 	private:
 		void *m_data;
 		size_t m_data_len;
+		size_t m_data_cap;	// Allocated size of m_data. (from BufferPool)
 
 		uint32_t *m_palette;
 		int m_palette_len;
@@ -80,6 +94,7 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 	: super(width, height, format)
 	, m_data(nullptr)
 	, m_data_len(0)
+	, m_data_cap(0)
 	, m_palette(nullptr)
 	, m_palette_len(0)
 {
@@ -100,7 +115,9 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 		return;
 	}
 
-	m_data = aligned_malloc(16, m_data_len);
+	// NOTE: The buffer pool reuses buffers from
+	// previously-freed images of a similar size.
+	m_data = BufferPool::alloc(m_data_len, &m_data_cap);
 	assert(m_data != nullptr);
 	if (!m_data) {
 		// Failed to allocate memory.
@@ -114,12 +131,14 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 		// there's no weird artifacts if the caller
 		// is converting a lower-color image.
 		const size_t palette_sz = 256*sizeof(*m_palette);
-		m_palette = static_cast<uint32_t*>(aligned_malloc(16, palette_sz));
+		m_palette = static_cast<uint32_t*>(aligned_malloc_tag(
+			LibRpFile::RpAllocStats::TAG_RP_IMAGE, 16, palette_sz));
 		if (!m_palette) {
 			// Failed to allocate memory.
-			aligned_free(m_data);
+			BufferPool::free(m_data, m_data_cap);
 			m_data = nullptr;
 			m_data_len = 0;
+			m_data_cap = 0;
 			clear_properties();
 			return;
 		}
@@ -132,7 +151,7 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 
 rp_image_backend_default::~rp_image_backend_default()
 {
-	aligned_free(m_data);
+	BufferPool::free(m_data, m_data_cap);
 	aligned_free(m_palette);
 }
 
@@ -165,6 +184,43 @@ int rp_image_backend_default::shrink(int width, int height)
 	return 0;
 }
 
+/**
+ * Grow image dimensions without reallocating the image data.
+ *
+ * This is only possible if the pooled image data buffer
+ * is large enough for the new dimensions.
+ *
+ * @param width New width.
+ * @param height New height.
+ * @return 0 on success; -ENOMEM if the image data buffer is too small; negative POSIX error code on error.
+ */
+int rp_image_backend_default::grow(int width, int height)
+{
+	assert(width >= this->width);
+	assert(height >= this->height);
+	assert(width <= 32768);
+	assert(height <= 32768);
+	if (this->width <= 0 || this->height <= 0 ||
+	    width < this->width || height < this->height ||
+	    width > 32768 || height > 32768)
+	{
+		return -EINVAL;
+	}
+
+	const int new_stride = calc_stride(width, format);
+	const size_t new_data_len = static_cast<size_t>(height) * new_stride;
+	if (new_data_len > m_data_cap) {
+		// Image data buffer is too small.
+		return -ENOMEM;
+	}
+
+	this->width = width;
+	this->height = height;
+	this->stride = new_stride;
+	m_data_len = new_data_len;
+	return 0;
+}
+
 /** rp_image_private **/
 
 rp_image::rp_image_backend_creator_fn rp_image_private::backend_fn = nullptr;
@@ -181,6 +237,7 @@ rp_image::rp_image_backend_creator_fn rp_image_private::backend_fn = nullptr;
  */
 rp_image_private::rp_image_private(int width, int height, rp_image::Format format)
 	: has_sBIT(false)
+	, opaque(-1)
 {
 	// Clear the metadata.
 	memset(&sBIT, 0, sizeof(sBIT));
@@ -211,6 +268,7 @@ rp_image_private::rp_image_private(int width, int height, rp_image::Format forma
 rp_image_private::rp_image_private(rp_image_backend *backend)
 	: backend(backend)
 	, has_sBIT(false)
+	, opaque(-1)
 {
 	// Clear the metadata.
 	// TODO: Store sBIT in the backend and copy it?
@@ -387,6 +445,7 @@ const void *rp_image::bits(void) const
 void *rp_image::bits(void)
 {
 	RP_D(rp_image);
+	d->opaque = -1;
 	return d->backend->data();
 }
 
@@ -414,6 +473,7 @@ const void *rp_image::scanLine(int i) const
 void *rp_image::scanLine(int i)
 {
 	RP_D(rp_image);
+	d->opaque = -1;
 	uint8_t *data = static_cast<uint8_t*>(d->backend->data());
 	if (!data)
 		return nullptr;
@@ -449,6 +509,7 @@ const uint32_t *rp_image::palette(void) const
 uint32_t *rp_image::palette(void)
 {
 	RP_D(rp_image);
+	d->opaque = -1;
 	return d->backend->palette();
 }
 
@@ -494,7 +555,61 @@ void rp_image::set_tr_idx(int tr_idx)
 	    tr_idx >= -1 && tr_idx < d->backend->palette_len())
 	{
 		d->backend->tr_idx = tr_idx;
+		d->opaque = -1;
+	}
+}
+
+/**
+ * Is the image fully opaque?
+ *
+ * ARGB32 images are opaque if every pixel has alpha == 0xFF.
+ * CI8 images are opaque if every palette entry has alpha == 0xFF
+ * and there's no transparency color index.
+ *
+ * The result is cached. The cached value is cleared if the
+ * image data is accessed using the non-const versions of
+ * bits(), scanLine(), or palette().
+ *
+ * @return True if the image is fully opaque; false if not.
+ */
+bool rp_image::isOpaque(void) const
+{
+	RP_D(const rp_image);
+	if (d->opaque >= 0) {
+		// Cached result.
+		return (d->opaque > 0);
 	}
+
+	const rp_image_backend *const backend = d->backend;
+	bool opaque = false;
+	switch (backend->format) {
+		case Format::ARGB32:
+			opaque = (backend->width > 0 && backend->height > 0 && scan_opaque());
+			break;
+
+		case Format::CI8: {
+			if (backend->tr_idx >= 0)
+				break;
+			const uint32_t *const palette = backend->palette();
+			const int palette_len = backend->palette_len();
+			if (!palette || palette_len <= 0)
+				break;
+			opaque = true;
+			for (int i = 0; i < palette_len; i++) {
+				if ((palette[i] & 0xFF000000U) != 0xFF000000U) {
+					opaque = false;
+					break;
+				}
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	d->opaque = (opaque ? 1 : 0);
+	return opaque;
 }
 
 /**
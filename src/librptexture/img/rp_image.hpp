@@ -23,10 +23,17 @@
 # include "librpcpu/cpuflags_x86.h"
 # define RP_IMAGE_HAS_SSE2 1
 # define RP_IMAGE_HAS_SSE41 1
+// AVX2 requires MSVC 2013 or later.
+# if !defined(_MSC_VER) || _MSC_VER >= 1800
+#  define RP_IMAGE_HAS_AVX2 1
+# endif
 #endif
 #ifdef RP_CPU_AMD64
 # define RP_IMAGE_ALWAYS_HAS_SSE2 1
 #endif
+#ifdef RP_CPU_ALWAYS_HAS_NEON
+# define RP_IMAGE_HAS_NEON 1
+#endif
 
 // TODO: Make this implicitly shared.
 
@@ -269,6 +276,21 @@ class rp_image : public RefBase
 		 */
 		void set_tr_idx(int tr_idx);
 
+		/**
+		 * Is the image fully opaque?
+		 *
+		 * ARGB32 images are opaque if every pixel has alpha == 0xFF.
+		 * CI8 images are opaque if every palette entry has alpha == 0xFF
+		 * and there's no transparency color index.
+		 *
+		 * The result is cached. The cached value is cleared if the
+		 * image data is accessed using the non-const versions of
+		 * bits(), scanLine(), or palette().
+		 *
+		 * @return True if the image is fully opaque; false if not.
+		 */
+		bool isOpaque(void) const;
+
 		/**
 		 * Get the name of a format
 		 * @param format Format.
@@ -333,6 +355,21 @@ class rp_image : public RefBase
 		 */
 		rp_image *squared(void) const;
 
+		/**
+		 * Square the rp_image in place.
+		 *
+		 * If the width and height don't match, transparent rows
+		 * and/or columns will be added to "square" the image.
+		 *
+		 * If the image is ARGB32 and the image data buffer is
+		 * large enough, the image data is rearranged in place.
+		 * Otherwise, the squared image data replaces this image's
+		 * image data. CI8 images are converted to ARGB32.
+		 *
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int squared_inplace(void);
+
 		/**
 		 * Alignment constants for resized().
 		 *
@@ -386,6 +423,101 @@ class rp_image : public RefBase
 			Alignment alignment = AlignDefault,
 			uint32_t bgColor = 0x00000000) const;
 
+		/**
+		 * Scaling methods for scaled().
+		 */
+		enum ScaleMethod : uint8_t {
+			SCALE_NEAREST	= 0,	// Nearest-neighbor
+			SCALE_BILINEAR	= 1,	// Bilinear interpolation
+			SCALE_BOX	= 2,	// Box filter (area averaging); recommended for downscaling
+		};
+
+		/**
+		 * Scale the rp_image.
+		 * Standard version using regular C++ code.
+		 *
+		 * SCALE_NEAREST keeps the original image format.
+		 * All other scaling methods return an ARGB32 image.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @param method Scaling method
+		 * @return New rp_image with a scaled version of the original, or nullptr on error.
+		 */
+		rp_image *scaled_cpp(int width, int height, ScaleMethod method) const;
+
+#ifdef RP_IMAGE_HAS_SSE2
+		/**
+		 * Scale the rp_image.
+		 * SSE2-optimized version.
+		 *
+		 * SCALE_NEAREST keeps the original image format.
+		 * All other scaling methods return an ARGB32 image.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @param method Scaling method
+		 * @return New rp_image with a scaled version of the original, or nullptr on error.
+		 */
+		rp_image *scaled_sse2(int width, int height, ScaleMethod method) const;
+#endif /* RP_IMAGE_HAS_SSE2 */
+
+		/**
+		 * Scale the rp_image.
+		 *
+		 * SCALE_NEAREST keeps the original image format.
+		 * All other scaling methods return an ARGB32 image.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @param method Scaling method
+		 * @return New rp_image with a scaled version of the original, or nullptr on error.
+		 */
+		inline rp_image *scaled(int width, int height, ScaleMethod method = SCALE_BILINEAR) const;
+
+		/**
+		 * Scale the rp_image using nearest-neighbor scaling,
+		 * and convert it to ARGB32.
+		 * Standard version using regular C++ code.
+		 *
+		 * CI8 images are converted in the same pass, so a full-size
+		 * ARGB32 copy of the original image is never created.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return New ARGB32 rp_image with a scaled version of the original, or nullptr on error.
+		 */
+		rp_image *scaled_nearest_ARGB32_cpp(int width, int height) const;
+
+#ifdef RP_IMAGE_HAS_AVX2
+		/**
+		 * Scale the rp_image using nearest-neighbor scaling,
+		 * and convert it to ARGB32.
+		 * AVX2-optimized version.
+		 *
+		 * CI8 images are converted in the same pass, so a full-size
+		 * ARGB32 copy of the original image is never created.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return New ARGB32 rp_image with a scaled version of the original, or nullptr on error.
+		 */
+		rp_image *scaled_nearest_ARGB32_avx2(int width, int height) const;
+#endif /* RP_IMAGE_HAS_AVX2 */
+
+		/**
+		 * Scale the rp_image using nearest-neighbor scaling,
+		 * and convert it to ARGB32.
+		 *
+		 * CI8 images are converted in the same pass, so a full-size
+		 * ARGB32 copy of the original image is never created.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return New ARGB32 rp_image with a scaled version of the original, or nullptr on error.
+		 */
+		inline rp_image *scaled_nearest_ARGB32(int width, int height) const;
+
 		/**
 		 * Un-premultiply this image.
 		 * Standard version using regular C++ code.
@@ -408,6 +540,30 @@ class rp_image : public RefBase
 		int un_premultiply_sse41(void);
 #endif /* RP_IMAGE_HAS_SSE41 */
 
+#ifdef RP_IMAGE_HAS_AVX2
+		/**
+		 * Un-premultiply this image.
+		 * AVX2-optimized version.
+		 *
+		 * Image must be ARGB32.
+		 *
+		 * @return 0 on success; non-zero on error.
+		 */
+		int un_premultiply_avx2(void);
+#endif /* RP_IMAGE_HAS_AVX2 */
+
+#ifdef RP_IMAGE_HAS_NEON
+		/**
+		 * Un-premultiply this image.
+		 * NEON-optimized version.
+		 *
+		 * Image must be ARGB32.
+		 *
+		 * @return 0 on success; non-zero on error.
+		 */
+		int un_premultiply_neon(void);
+#endif /* RP_IMAGE_HAS_NEON */
+
 		/**
 		 * Un-premultiply this image.
 		 *
@@ -426,12 +582,58 @@ class rp_image : public RefBase
 
 		/**
 		 * Premultiply this image.
+		 * Standard version using regular C++ code.
+		 *
+		 * Image must be ARGB32.
+		 *
+		 * @return 0 on success; non-zero on error.
+		 */
+		int premultiply_cpp(void);
+
+#ifdef RP_IMAGE_HAS_SSE41
+		/**
+		 * Premultiply this image.
+		 * SSE4.1-optimized version.
+		 *
+		 * Image must be ARGB32.
+		 *
+		 * @return 0 on success; non-zero on error.
+		 */
+		int premultiply_sse41(void);
+#endif /* RP_IMAGE_HAS_SSE41 */
+
+#ifdef RP_IMAGE_HAS_AVX2
+		/**
+		 * Premultiply this image.
+		 * AVX2-optimized version.
+		 *
+		 * Image must be ARGB32.
+		 *
+		 * @return 0 on success; non-zero on error.
+		 */
+		int premultiply_avx2(void);
+#endif /* RP_IMAGE_HAS_AVX2 */
+
+#ifdef RP_IMAGE_HAS_NEON
+		/**
+		 * Premultiply this image.
+		 * NEON-optimized version.
 		 *
 		 * Image must be ARGB32.
 		 *
 		 * @return 0 on success; non-zero on error.
 		 */
-		int premultiply(void);
+		int premultiply_neon(void);
+#endif /* RP_IMAGE_HAS_NEON */
+
+		/**
+		 * Premultiply this image.
+		 *
+		 * Image must be ARGB32.
+		 *
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int premultiply(void);
 
 		/**
 		 * Convert a chroma-keyed image to standard ARGB32.
@@ -463,6 +665,38 @@ class rp_image : public RefBase
 		int apply_chroma_key_sse2(uint32_t key);
 #endif /* RP_IMAGE_HAS_SSE2 */
 
+#ifdef RP_IMAGE_HAS_AVX2
+		/**
+		 * Convert a chroma-keyed image to standard ARGB32.
+		 * AVX2-optimized version.
+		 *
+		 * This operates on the image itself, and does not return
+		 * a duplicated image with the adjusted image.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 *
+		 * @param key Chroma key color.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int apply_chroma_key_avx2(uint32_t key);
+#endif /* RP_IMAGE_HAS_AVX2 */
+
+#ifdef RP_IMAGE_HAS_NEON
+		/**
+		 * Convert a chroma-keyed image to standard ARGB32.
+		 * NEON-optimized version.
+		 *
+		 * This operates on the image itself, and does not return
+		 * a duplicated image with the adjusted image.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 *
+		 * @param key Chroma key color.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int apply_chroma_key_neon(uint32_t key);
+#endif /* RP_IMAGE_HAS_NEON */
+
 		/**
 		 * Convert a chroma-keyed image to standard ARGB32.
 		 *
@@ -476,6 +710,71 @@ class rp_image : public RefBase
 		 */
 		inline int apply_chroma_key(uint32_t key);
 
+		/**
+		 * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+		 * Standard version using regular C++ code.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 * isOpaque() should usually be used instead, since it
+		 * caches the result and handles CI8 images.
+		 *
+		 * @return True if the image is fully opaque; false if not.
+		 */
+		bool scan_opaque_cpp(void) const;
+
+#ifdef RP_IMAGE_HAS_SSE2
+		/**
+		 * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+		 * SSE2-optimized version.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 * isOpaque() should usually be used instead, since it
+		 * caches the result and handles CI8 images.
+		 *
+		 * @return True if the image is fully opaque; false if not.
+		 */
+		bool scan_opaque_sse2(void) const;
+#endif /* RP_IMAGE_HAS_SSE2 */
+
+#ifdef RP_IMAGE_HAS_AVX2
+		/**
+		 * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+		 * AVX2-optimized version.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 * isOpaque() should usually be used instead, since it
+		 * caches the result and handles CI8 images.
+		 *
+		 * @return True if the image is fully opaque; false if not.
+		 */
+		bool scan_opaque_avx2(void) const;
+#endif /* RP_IMAGE_HAS_AVX2 */
+
+#ifdef RP_IMAGE_HAS_NEON
+		/**
+		 * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+		 * NEON-optimized version.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 * isOpaque() should usually be used instead, since it
+		 * caches the result and handles CI8 images.
+		 *
+		 * @return True if the image is fully opaque; false if not.
+		 */
+		bool scan_opaque_neon(void) const;
+#endif /* RP_IMAGE_HAS_NEON */
+
+		/**
+		 * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 * isOpaque() should usually be used instead, since it
+		 * caches the result and handles CI8 images.
+		 *
+		 * @return True if the image is fully opaque; false if not.
+		 */
+		inline bool scan_opaque(void) const;
+
 		enum FlipOp : uint8_t {
 			FLIP_NONE	= 0,
 			FLIP_V		= (1U << 0),
@@ -485,6 +784,20 @@ class rp_image : public RefBase
 
 		/**
 		 * Flip the image.
+		 * Standard version using regular C++ code.
+		 *
+		 * This function returns a *new* image and leaves the
+		 * original image unmodified.
+		 *
+		 * @param op Flip operation.
+		 * @return Flipped image, or nullptr on error.
+		 */
+		rp_image *flip_cpp(FlipOp op) const;
+
+#ifdef RP_IMAGE_HAS_SSE2
+		/**
+		 * Flip the image.
+		 * SSE2-optimized version.
 		 *
 		 * This function returns a *new* image and leaves the
 		 * original image unmodified.
@@ -492,7 +805,30 @@ class rp_image : public RefBase
 		 * @param op Flip operation.
 		 * @return Flipped image, or nullptr on error.
 		 */
-		rp_image *flip(FlipOp op) const;
+		rp_image *flip_sse2(FlipOp op) const;
+#endif /* RP_IMAGE_HAS_SSE2 */
+
+		/**
+		 * Flip the image.
+		 *
+		 * This function returns a *new* image and leaves the
+		 * original image unmodified.
+		 *
+		 * @param op Flip operation.
+		 * @return Flipped image, or nullptr on error.
+		 */
+		inline rp_image *flip(FlipOp op) const;
+
+		/**
+		 * Flip the image in place.
+		 *
+		 * This operates on the image itself, and does not return
+		 * a duplicated image with the adjusted image.
+		 *
+		 * @param op Flip operation.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int flip_inplace(FlipOp op);
 
 		/**
 		 * Shrink image dimensions.
@@ -503,6 +839,59 @@ class rp_image : public RefBase
 		int shrink(int width, int height);
 };
 
+/**
+ * Scale the rp_image.
+ *
+ * SCALE_NEAREST keeps the original image format.
+ * All other scaling methods return an ARGB32 image.
+ *
+ * @param width New width
+ * @param height New height
+ * @param method Scaling method
+ * @return New rp_image with a scaled version of the original, or nullptr on error.
+ */
+inline rp_image *rp_image::scaled(int width, int height, ScaleMethod method) const
+{
+	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#if defined(RP_IMAGE_ALWAYS_HAS_SSE2)
+	// amd64 always has SSE2.
+	return scaled_sse2(width, height, method);
+#else
+# if defined(RP_IMAGE_HAS_SSE2)
+	if (RP_CPU_HasSSE2()) {
+		return scaled_sse2(width, height, method);
+	} else
+# endif /* RP_IMAGE_HAS_SSE2 */
+	{
+		return scaled_cpp(width, height, method);
+	}
+#endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
+}
+
+/**
+ * Scale the rp_image using nearest-neighbor scaling,
+ * and convert it to ARGB32.
+ *
+ * CI8 images are converted in the same pass, so a full-size
+ * ARGB32 copy of the original image is never created.
+ *
+ * @param width New width
+ * @param height New height
+ * @return New ARGB32 rp_image with a scaled version of the original, or nullptr on error.
+ */
+inline rp_image *rp_image::scaled_nearest_ARGB32(int width, int height) const
+{
+	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return scaled_nearest_ARGB32_avx2(width, height);
+	} else
+#endif /* RP_IMAGE_HAS_AVX2 */
+	{
+		return scaled_nearest_ARGB32_cpp(width, height);
+	}
+}
+
 /**
  * Un-premultiply this image.
  *
@@ -512,7 +901,16 @@ class rp_image : public RefBase
  */
 inline int rp_image::un_premultiply(void)
 {
+#ifdef RP_IMAGE_HAS_NEON
+	// ARM64 always has NEON.
+	return un_premultiply_neon();
+#else /* !RP_IMAGE_HAS_NEON */
 	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return un_premultiply_avx2();
+	} else
+#endif /* RP_IMAGE_HAS_AVX2 */
 #ifdef RP_IMAGE_HAS_SSE41
 	if (RP_CPU_HasSSE41()) {
 		return un_premultiply_sse41();
@@ -521,6 +919,37 @@ inline int rp_image::un_premultiply(void)
 	{
 		return un_premultiply_cpp();
 	}
+#endif /* RP_IMAGE_HAS_NEON */
+}
+
+/**
+ * Premultiply this image.
+ *
+ * Image must be ARGB32.
+ *
+ * @return 0 on success; non-zero on error.
+ */
+inline int rp_image::premultiply(void)
+{
+#ifdef RP_IMAGE_HAS_NEON
+	// ARM64 always has NEON.
+	return premultiply_neon();
+#else /* !RP_IMAGE_HAS_NEON */
+	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return premultiply_avx2();
+	} else
+#endif /* RP_IMAGE_HAS_AVX2 */
+#ifdef RP_IMAGE_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		return premultiply_sse41();
+	} else
+#endif /* RP_IMAGE_HAS_SSE41 */
+	{
+		return premultiply_cpp();
+	}
+#endif /* RP_IMAGE_HAS_NEON */
 }
 
 /**
@@ -536,7 +965,16 @@ inline int rp_image::un_premultiply(void)
  */
 inline int rp_image::apply_chroma_key(uint32_t key)
 {
+#ifdef RP_IMAGE_HAS_NEON
+	// ARM64 always has NEON.
+	return apply_chroma_key_neon(key);
+#else /* !RP_IMAGE_HAS_NEON */
 	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return apply_chroma_key_avx2(key);
+	}
+#endif /* RP_IMAGE_HAS_AVX2 */
 #if defined(RP_IMAGE_ALWAYS_HAS_SSE2)
 	// amd64 always has SSE2.
 	return apply_chroma_key_sse2(key);
@@ -550,6 +988,71 @@ inline int rp_image::apply_chroma_key(uint32_t key)
 		return apply_chroma_key_cpp(key);
 	}
 #endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
+#endif /* RP_IMAGE_HAS_NEON */
+}
+
+/**
+ * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+ *
+ * NOTE: The image *must* be ARGB32.
+ * isOpaque() should usually be used instead, since it
+ * caches the result and handles CI8 images.
+ *
+ * @return True if the image is fully opaque; false if not.
+ */
+inline bool rp_image::scan_opaque(void) const
+{
+#ifdef RP_IMAGE_HAS_NEON
+	// ARM64 always has NEON.
+	return scan_opaque_neon();
+#else /* !RP_IMAGE_HAS_NEON */
+	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return scan_opaque_avx2();
+	}
+#endif /* RP_IMAGE_HAS_AVX2 */
+#if defined(RP_IMAGE_ALWAYS_HAS_SSE2)
+	// amd64 always has SSE2.
+	return scan_opaque_sse2();
+#else
+# if defined(RP_IMAGE_HAS_SSE2)
+	if (RP_CPU_HasSSE2()) {
+		return scan_opaque_sse2();
+	} else
+# endif /* RP_IMAGE_HAS_SSE2 */
+	{
+		return scan_opaque_cpp();
+	}
+#endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
+#endif /* RP_IMAGE_HAS_NEON */
+}
+
+/**
+ * Flip the image.
+ *
+ * This function returns a *new* image and leaves the
+ * original image unmodified.
+ *
+ * @param op Flip operation.
+ * @return Flipped image, or nullptr on error.
+ */
+inline rp_image *rp_image::flip(FlipOp op) const
+{
+	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#if defined(RP_IMAGE_ALWAYS_HAS_SSE2)
+	// amd64 always has SSE2.
+	return flip_sse2(op);
+#else
+# if defined(RP_IMAGE_HAS_SSE2)
+	if (RP_CPU_HasSSE2()) {
+		return flip_sse2(op);
+	} else
+# endif /* RP_IMAGE_HAS_SSE2 */
+	{
+		return flip_cpp(op);
+	}
+#endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
 }
 
 }
@@ -13,7 +13,13 @@ namespace LibRpTexture {
 
 /** rp_image_backend **/
 
-static inline int calc_stride(int width, rp_image::Format format)
+/**
+ * Calculate the stride for the specified width and format.
+ * @param width Image width.
+ * @param format Image format.
+ * @return Stride, in bytes.
+ */
+int rp_image_backend::calc_stride(int width, rp_image::Format format)
 {
 	switch (format) {
 		case rp_image::Format::CI8:
@@ -90,6 +96,26 @@ void rp_image_backend::clear_properties(void)
 	this->format = rp_image::Format::None;
 }
 
+/**
+ * Grow image dimensions without reallocating the image data.
+ *
+ * The stride is recalculated for the new width, but the
+ * existing image data is NOT moved. The caller must
+ * rearrange the image data for the new stride.
+ *
+ * The default implementation doesn't support this.
+ *
+ * @param width New width.
+ * @param height New height.
+ * @return 0 on success; -ENOMEM if the image data buffer is too small; negative POSIX error code on error.
+ */
+int rp_image_backend::grow(int width, int height)
+{
+	RP_UNUSED(width);
+	RP_UNUSED(height);
+	return -ENOTSUP;
+}
+
 /**
  * Check if the palette contains alpha values other than 0 and 255.
  * @return True if an alpha value other than 0 and 255 was found; false if not, or if ARGB32.
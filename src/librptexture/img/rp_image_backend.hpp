@@ -29,6 +29,14 @@ class rp_image_backend
 		bool isValid(void) const;
 
 	protected:
+		/**
+		 * Calculate the stride for the specified width and format.
+		 * @param width Image width.
+		 * @param format Image format.
+		 * @return Stride, in bytes.
+		 */
+		static int calc_stride(int width, rp_image::Format format);
+
 		/**
 		 * Clear the width, height, stride, and format properties.
 		 * Used in error paths.
@@ -50,6 +58,21 @@ class rp_image_backend
 		 */
 		virtual int shrink(int width, int height) = 0;
 
+		/**
+		 * Grow image dimensions without reallocating the image data.
+		 *
+		 * The stride is recalculated for the new width, but the
+		 * existing image data is NOT moved. The caller must
+		 * rearrange the image data for the new stride.
+		 *
+		 * The default implementation doesn't support this.
+		 *
+		 * @param width New width.
+		 * @param height New height.
+		 * @return 0 on success; -ENOMEM if the image data buffer is too small; negative POSIX error code on error.
+		 */
+		virtual int grow(int width, int height);
+
 	public:
 		int width;
 		int height;
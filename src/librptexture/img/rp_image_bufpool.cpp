@@ -0,0 +1,318 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * rp_image_bufpool.cpp: Pixel buffer pool for rp_image_backend_default.   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "rp_image_bufpool.hpp"
+
+// librpbase, librpcpu
+#include "librpbase/aligned_malloc.h"
+#include "librpcpu/bitstuff.h"
+
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+
+namespace LibRpTexture { namespace BufferPool {
+
+/**
+ * Size classes:
+ * - Class 0: MIN_POOLED_SIZE bytes.
+ * - Each power of two above that is split into four classes,
+ *   so a buffer is never more than 25% larger than requested.
+ * - The last class is MAX_POOLED_SIZE bytes.
+ */
+static const unsigned int MIN_POOLED_SHIFT = 12;	// 4 KB
+static const unsigned int MAX_POOLED_SHIFT = 26;	// 64 MB (4096x4096 ARGB32)
+static const size_t MIN_POOLED_SIZE = (1U << MIN_POOLED_SHIFT);
+static const size_t MAX_POOLED_SIZE = (1U << MAX_POOLED_SHIFT);
+static const unsigned int NUM_CLASSES = ((MAX_POOLED_SHIFT - MIN_POOLED_SHIFT) * 4) + 1;
+
+// Per-thread cache limits.
+static const unsigned int THREAD_SLOTS = 2;		// Buffers per size class
+static const size_t THREAD_MAX_BYTES = 16U*1024*1024;	// Total bytes
+
+// Process-wide cache limits.
+static const unsigned int GLOBAL_SLOTS = 8;		// Buffers per size class
+static const size_t GLOBAL_MAX_BYTES = 64U*1024*1024;	// Total bytes
+
+/**
+ * Get the size class for a buffer size.
+ * @param size Buffer size. (must be <= MAX_POOLED_SIZE)
+ * @return Size class.
+ */
+static inline unsigned int size_to_class(size_t size)
+{
+	assert(size <= MAX_POOLED_SIZE);
+	if (size <= MIN_POOLED_SIZE) {
+		return 0;
+	}
+
+	// 2^shift < size <= 2^(shift+1)
+	const unsigned int shift = uilog2(static_cast<unsigned int>(size - 1));
+	const size_t step = (1U << (shift - 2));
+	const unsigned int sub = static_cast<unsigned int>(
+		(size - (1U << shift) + step - 1) >> (shift - 2));
+	return ((shift - MIN_POOLED_SHIFT) * 4) + sub;
+}
+
+/**
+ * Get the buffer size for a size class.
+ * @param cls Size class.
+ * @return Buffer size.
+ */
+static inline size_t class_to_size(unsigned int cls)
+{
+	assert(cls < NUM_CLASSES);
+	if (cls == 0) {
+		return MIN_POOLED_SIZE;
+	}
+
+	const unsigned int shift = ((cls - 1) / 4) + MIN_POOLED_SHIFT;
+	const unsigned int sub = ((cls - 1) % 4) + 1;
+	return (static_cast<size_t>(1U) << shift) + (sub * (static_cast<size_t>(1U) << (shift - 2)));
+}
+
+/**
+ * Process-wide buffer cache.
+ */
+class GlobalCache
+{
+	public:
+		GlobalCache()
+			: bytes(0)
+			, destroyed(false)
+		{
+			memset(count, 0, sizeof(count));
+		}
+
+		~GlobalCache()
+		{
+			clear();
+
+			// Threads that exit after this point
+			// will free their buffers directly.
+			destroyed = true;
+		}
+
+	private:
+		RP_DISABLE_COPY(GlobalCache)
+
+	public:
+		/**
+		 * Get a buffer from the cache.
+		 * @param cls Size class.
+		 * @return Buffer, or nullptr if no buffer is available.
+		 */
+		void *get(unsigned int cls)
+		{
+			if (destroyed) {
+				return nullptr;
+			}
+
+			MutexLocker locker(mutex);
+			if (count[cls] == 0) {
+				return nullptr;
+			}
+			bytes -= class_to_size(cls);
+			return bufs[cls][--count[cls]];
+		}
+
+		/**
+		 * Add a buffer to the cache.
+		 * The buffer is freed if the cache is full.
+		 * @param cls Size class.
+		 * @param buf Buffer.
+		 */
+		void put(unsigned int cls, void *buf)
+		{
+			const size_t size = class_to_size(cls);
+			if (!destroyed) {
+				MutexLocker locker(mutex);
+				if (count[cls] < GLOBAL_SLOTS && bytes + size <= GLOBAL_MAX_BYTES) {
+					bufs[cls][count[cls]++] = buf;
+					bytes += size;
+					return;
+				}
+			}
+
+			// Cache is full.
+			aligned_free(buf);
+		}
+
+		/**
+		 * Free all buffers in the cache.
+		 */
+		void clear(void)
+		{
+			MutexLocker locker(mutex);
+			for (unsigned int cls = 0; cls < NUM_CLASSES; cls++) {
+				for (unsigned int i = 0; i < count[cls]; i++) {
+					aligned_free(bufs[cls][i]);
+				}
+				count[cls] = 0;
+			}
+			bytes = 0;
+		}
+
+	private:
+		Mutex mutex;
+		void *bufs[NUM_CLASSES][GLOBAL_SLOTS];
+		uint8_t count[NUM_CLASSES];
+		size_t bytes;
+		volatile bool destroyed;
+};
+static GlobalCache globalCache;
+
+/**
+ * Per-thread buffer cache.
+ * No locking is needed, since only the owning thread accesses it.
+ */
+class ThreadCache
+{
+	public:
+		ThreadCache()
+			: bytes(0)
+		{
+			memset(count, 0, sizeof(count));
+		}
+
+		~ThreadCache()
+		{
+			// Move the buffers to the process-wide cache
+			// so other threads can use them.
+			for (unsigned int cls = 0; cls < NUM_CLASSES; cls++) {
+				for (unsigned int i = 0; i < count[cls]; i++) {
+					globalCache.put(cls, bufs[cls][i]);
+				}
+			}
+		}
+
+	private:
+		RP_DISABLE_COPY(ThreadCache)
+
+	public:
+		/**
+		 * Get a buffer from the cache.
+		 * @param cls Size class.
+		 * @return Buffer, or nullptr if no buffer is available.
+		 */
+		inline void *get(unsigned int cls)
+		{
+			if (count[cls] == 0) {
+				return nullptr;
+			}
+			bytes -= class_to_size(cls);
+			return bufs[cls][--count[cls]];
+		}
+
+		/**
+		 * Add a buffer to the cache.
+		 * @param cls Size class.
+		 * @param buf Buffer.
+		 * @return True if the buffer was added; false if the cache is full.
+		 */
+		inline bool put(unsigned int cls, void *buf)
+		{
+			const size_t size = class_to_size(cls);
+			if (count[cls] >= THREAD_SLOTS || bytes + size > THREAD_MAX_BYTES) {
+				return false;
+			}
+			bufs[cls][count[cls]++] = buf;
+			bytes += size;
+			return true;
+		}
+
+		/**
+		 * Free all buffers in the cache.
+		 */
+		void clear(void)
+		{
+			for (unsigned int cls = 0; cls < NUM_CLASSES; cls++) {
+				for (unsigned int i = 0; i < count[cls]; i++) {
+					aligned_free(bufs[cls][i]);
+				}
+				count[cls] = 0;
+			}
+			bytes = 0;
+		}
+
+	private:
+		void *bufs[NUM_CLASSES][THREAD_SLOTS];
+		uint8_t count[NUM_CLASSES];
+		size_t bytes;
+};
+static thread_local ThreadCache threadCache;
+
+/**
+ * Allocate a pixel buffer.
+ * @param size		[in] Minimum size, in bytes.
+ * @param pCapacity	[out] Actual size of the buffer, in bytes.
+ * @return Buffer, or nullptr on error.
+ */
+void *alloc(size_t size, size_t *pCapacity)
+{
+	assert(pCapacity != nullptr);
+	if (size < MIN_POOLED_SIZE / 4 || size > MAX_POOLED_SIZE) {
+		// Not pooled.
+		void *const buf = aligned_malloc_tag(LibRpFile::RpAllocStats::TAG_RP_IMAGE, 16, size);
+		*pCapacity = (buf ? size : 0);
+		return buf;
+	}
+
+	const unsigned int cls = size_to_class(size);
+	const size_t capacity = class_to_size(cls);
+	void *buf = threadCache.get(cls);
+	if (!buf) {
+		buf = globalCache.get(cls);
+		if (!buf) {
+			buf = aligned_malloc_tag(LibRpFile::RpAllocStats::TAG_RP_IMAGE, 16, capacity);
+		}
+	}
+
+	*pCapacity = (buf ? capacity : 0);
+	return buf;
+}
+
+/**
+ * Release a pixel buffer.
+ * @param buf Buffer from alloc(). (may be nullptr)
+ * @param capacity Capacity returned by alloc().
+ */
+void free(void *buf, size_t capacity)
+{
+	if (!buf) {
+		return;
+	}
+
+	if (capacity < MIN_POOLED_SIZE / 4 || capacity > MAX_POOLED_SIZE) {
+		// Not pooled.
+		aligned_free(buf);
+		return;
+	}
+
+	// NOTE: Buffers smaller than MIN_POOLED_SIZE were rounded up,
+	// so the capacity always matches a size class exactly.
+	const unsigned int cls = size_to_class(capacity);
+	assert(class_to_size(cls) == capacity);
+	if (!threadCache.put(cls, buf)) {
+		globalCache.put(cls, buf);
+	}
+}
+
+/**
+ * Free all buffers in the process-wide cache and
+ * in the calling thread's cache.
+ */
+void trim(void)
+{
+	threadCache.clear();
+	globalCache.clear();
+}
+
+} }
@@ -0,0 +1,57 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * rp_image_bufpool.hpp: Pixel buffer pool for rp_image_backend_default.   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_IMG_RP_IMAGE_BUFPOOL_HPP__
+#define __ROMPROPERTIES_LIBRPTEXTURE_IMG_RP_IMAGE_BUFPOOL_HPP__
+
+#include "common.h"
+
+// C includes. (C++ namespace)
+#include <cstddef>
+
+namespace LibRpTexture { namespace BufferPool {
+
+/**
+ * Pixel buffer pool.
+ *
+ * Buffers are rounded up to a size class, and freed buffers
+ * are kept in a per-thread cache for reuse by the next image
+ * of the same size class. If the per-thread cache is full,
+ * the buffer is moved to a process-wide cache, which is also
+ * used if the per-thread cache doesn't have a buffer.
+ *
+ * Buffers that are very small or very large are not pooled.
+ *
+ * All buffers are 16-byte aligned. Buffer contents are
+ * NOT initialized, same as aligned_malloc().
+ */
+
+/**
+ * Allocate a pixel buffer.
+ * @param size		[in] Minimum size, in bytes.
+ * @param pCapacity	[out] Actual size of the buffer, in bytes.
+ * @return Buffer, or nullptr on error.
+ */
+void *alloc(size_t size, size_t *pCapacity);
+
+/**
+ * Release a pixel buffer.
+ * @param buf Buffer from alloc(). (may be nullptr)
+ * @param capacity Capacity returned by alloc().
+ */
+void free(void *buf, size_t capacity);
+
+/**
+ * Free all buffers in the process-wide cache and
+ * in the calling thread's cache.
+ */
+void trim(void);
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_IMG_RP_IMAGE_BUFPOOL_HPP__ */
@@ -281,6 +281,94 @@ rp_image *rp_image::squared(void) const
 	return sq_img;
 }
 
+/**
+ * Square the rp_image in place.
+ *
+ * If the width and height don't match, transparent rows
+ * and/or columns will be added to "square" the image.
+ *
+ * If the image is ARGB32 and the image data buffer is
+ * large enough, the image data is rearranged in place.
+ * Otherwise, the squared image data replaces this image's
+ * image data. CI8 images are converted to ARGB32.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int rp_image::squared_inplace(void)
+{
+	RP_D(rp_image);
+	rp_image_backend *const backend = d->backend;
+
+	const int width = backend->width;
+	const int height = backend->height;
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0) {
+		// Cannot resize the image.
+		return -EINVAL;
+	}
+
+	if (width == height) {
+		// Image is already square.
+		return 0;
+	}
+
+	// Transparent rows or columns will be added.
+	d->opaque = -1;
+
+	// Try to grow the image data in place.
+	// TODO: Native 8bpp support?
+	const int max_dim = std::max(width, height);
+	const int src_stride = backend->stride;
+	if (backend->format == rp_image::Format::ARGB32 &&
+	    backend->grow(max_dim, max_dim) == 0)
+	{
+		// NOTE: Using uint8_t* because stride is measured in bytes.
+		uint8_t *const bits = static_cast<uint8_t*>(backend->data());
+		const int dest_stride = backend->stride;
+
+		if (width > height) {
+			// Image is wider. Add rows to the top and bottom.
+			// The stride doesn't change, so the image data
+			// can be moved all at once.
+			const int addToTop = (width-height)/2;
+			const int addToBottom = addToTop + ((width-height)%2);
+			memmove(&bits[addToTop * dest_stride], bits, height * src_stride);
+			memset(bits, 0, addToTop * dest_stride);
+			memset(&bits[(addToTop + height) * dest_stride], 0, addToBottom * dest_stride);
+		} else /*if (width < height)*/ {
+			// Image is taller. Add columns to the left and right.
+			// The new stride is larger, so start at the bottom
+			// to avoid overwriting rows that haven't been moved.
+			const int addToLeft = (height-width)/2;
+			const int left_bytes = addToLeft * sizeof(uint32_t);
+			const int src_row_bytes = width * sizeof(uint32_t);
+			const int right_bytes = dest_stride - left_bytes - src_row_bytes;
+			for (int y = height-1; y >= 0; y--) {
+				uint8_t *const dest = &bits[y * dest_stride];
+				memmove(&dest[left_bytes], &bits[y * src_stride], src_row_bytes);
+				memset(dest, 0, left_bytes);
+				memset(&dest[left_bytes + src_row_bytes], 0, right_bytes);
+			}
+		}
+		return 0;
+	}
+
+	// Not enough space. Create a squared image and
+	// take its image data.
+	rp_image *const sq_img = this->squared();
+	if (!sq_img) {
+		return -ENOMEM;
+	} else if (!sq_img->isValid()) {
+		sq_img->unref();
+		return -ENOMEM;
+	}
+
+	std::swap(d->backend, sq_img->d_ptr->backend);
+	sq_img->unref();
+	return 0;
+}
+
 /**
  * Resize the rp_image.
  *
@@ -498,6 +586,465 @@ rp_image *rp_image::resized(int width, int height, Alignment alignment, uint32_t
 	return img;
 }
 
+/** Scaling functions. **/
+
+/**
+ * Calculate a bilinear scaling table.
+ * @param tbl		[out] Table. (must have dest_len entries)
+ * @param dest_len	[in] Destination length.
+ * @param src_len	[in] Source length.
+ */
+void rp_image_private::calc_bilinear_table(scale_bilinear_t *tbl, int dest_len, int src_len)
+{
+	assert(dest_len > 0);
+	assert(src_len > 0);
+
+	// Pixel centers are aligned, so the source position is
+	// ((i + 0.5) * src_len / dest_len) - 0.5.
+	// This is calculated with 8 bits of fractional precision.
+	const int64_t div = static_cast<int64_t>(dest_len) * 2;
+	for (int i = 0; i < dest_len; i++, tbl++) {
+		int pos = static_cast<int>(((static_cast<int64_t>(i) * 2 + 1) * src_len * 256) / div) - 128;
+		if (pos < 0) {
+			pos = 0;
+		}
+
+		const int i0 = (pos >> 8);
+		if (i0 >= src_len - 1) {
+			// Last source pixel.
+			tbl->i0 = src_len - 1;
+			tbl->i1 = src_len - 1;
+			tbl->w = 0;
+		} else {
+			tbl->i0 = i0;
+			tbl->i1 = i0 + 1;
+			tbl->w = (pos & 0xFF);
+		}
+	}
+}
+
+/**
+ * Calculate a box filter table.
+ * @param tbl		[out] Table. (must have dest_len entries)
+ * @param dest_len	[in] Destination length.
+ * @param src_len	[in] Source length.
+ */
+void rp_image_private::calc_box_table(scale_box_t *tbl, int dest_len, int src_len)
+{
+	assert(dest_len > 0);
+	assert(src_len > 0);
+
+	// NOTE: If upscaling, each box has a single source pixel.
+	for (int i = 0; i < dest_len; i++, tbl++) {
+		tbl->i0 = static_cast<int>((static_cast<int64_t>(i) * src_len) / dest_len);
+		tbl->i1 = static_cast<int>((static_cast<int64_t>(i + 1) * src_len) / dest_len);
+		if (tbl->i1 <= tbl->i0) {
+			tbl->i1 = tbl->i0 + 1;
+		}
+	}
+}
+
+/**
+ * Calculate a nearest-neighbor scaling table.
+ * @param tbl		[out] Table. (must have dest_len entries)
+ * @param dest_len	[in] Destination length.
+ * @param src_len	[in] Source length.
+ */
+void rp_image_private::calc_nearest_table(int *tbl, int dest_len, int src_len)
+{
+	assert(dest_len > 0);
+	assert(src_len > 0);
+
+	// Use the source pixel at the center of each destination pixel.
+	const int64_t div = static_cast<int64_t>(dest_len) * 2;
+	for (int i = 0; i < dest_len; i++, tbl++) {
+		*tbl = static_cast<int>(((static_cast<int64_t>(i) * 2 + 1) * src_len) / div);
+	}
+}
+
+/**
+ * Scale an image using nearest-neighbor scaling.
+ * The original image format is retained.
+ * @param q Source image.
+ * @param width New width.
+ * @param height New height.
+ * @return New image, or nullptr on error.
+ */
+static rp_image *scale_nearest(const rp_image *q, int width, int height)
+{
+	const rp_image::Format format = q->format();
+	int bytespp;
+	switch (format) {
+		case rp_image::Format::CI8:
+			bytespp = 1;
+			break;
+		case rp_image::Format::ARGB32:
+			bytespp = 4;
+			break;
+		default:
+			assert(!"Unsupported rp_image::Format.");
+			return nullptr;
+	}
+
+	rp_image *const img = new rp_image(width, height, format);
+	if (!img->isValid()) {
+		// Image is invalid.
+		img->unref();
+		return nullptr;
+	}
+
+	// Source column for each destination column,
+	// and source row for each destination row.
+	std::unique_ptr<int[]> xtbl(new int[width]);
+	std::unique_ptr<int[]> ytbl(new int[height]);
+	rp_image_private::calc_nearest_table(xtbl.get(), width, q->width());
+	rp_image_private::calc_nearest_table(ytbl.get(), height, q->height());
+
+	for (int y = 0; y < height; y++) {
+		const void *const src = q->scanLine(ytbl[y]);
+		void *const dest = img->scanLine(y);
+
+		if (bytespp == 4) {
+			const uint32_t *const src32 = static_cast<const uint32_t*>(src);
+			uint32_t *const dest32 = static_cast<uint32_t*>(dest);
+			for (int x = 0; x < width; x++) {
+				dest32[x] = src32[xtbl[x]];
+			}
+		} else {
+			const uint8_t *const src8 = static_cast<const uint8_t*>(src);
+			uint8_t *const dest8 = static_cast<uint8_t*>(dest);
+			for (int x = 0; x < width; x++) {
+				dest8[x] = src8[xtbl[x]];
+			}
+		}
+	}
+
+	// If CI8, copy the palette.
+	if (format == rp_image::Format::CI8) {
+		int entries = std::min(img->palette_len(), q->palette_len());
+		uint32_t *const dest_pal = img->palette();
+		memcpy(dest_pal, q->palette(), entries * sizeof(uint32_t));
+		// Palette is zero-initialized, so we don't need to
+		// zero remaining entries.
+	}
+
+	return img;
+}
+
+/**
+ * Start scaling an image.
+ *
+ * If the image can be scaled without filtering, e.g. for
+ * SCALE_NEAREST or if the size didn't change, the final
+ * image is returned and *pSrc is set to nullptr.
+ *
+ * Otherwise, an empty ARGB32 image is returned, and *pSrc
+ * is set to a premultiplied ARGB32 copy of the source image.
+ * The caller must fill in the image and call scale_end().
+ *
+ * @param q		[in] Source image.
+ * @param width		[in] New width.
+ * @param height	[in] New height.
+ * @param pMethod	[in/out] Scaling method. (may be adjusted)
+ * @param pSrc		[out] Premultiplied ARGB32 source image.
+ * @return New image, or nullptr on error.
+ */
+rp_image *rp_image_private::scale_begin(const rp_image *q, int width, int height,
+	rp_image::ScaleMethod *pMethod, rp_image **pSrc)
+{
+	*pSrc = nullptr;
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0) {
+		// Cannot scale the image.
+		return nullptr;
+	}
+
+	const rp_image_private *const d = q->d_ptr;
+	const int orig_width = d->backend->width;
+	const int orig_height = d->backend->height;
+	assert(orig_width > 0);
+	assert(orig_height > 0);
+	if (orig_width <= 0 || orig_height <= 0) {
+		// Cannot scale the image.
+		return nullptr;
+	}
+
+	if (width == orig_width && height == orig_height) {
+		// No scaling is necessary.
+		return q->dup();
+	}
+
+	rp_image::ScaleMethod method = *pMethod;
+	if (method == rp_image::SCALE_BOX) {
+		// Box filter sums are 32-bit, which is enough for boxes
+		// of up to 0x1010101 pixels. If the box is larger than
+		// that, use bilinear scaling instead.
+		const int64_t box_w = (orig_width / width) + 1;
+		const int64_t box_h = (orig_height / height) + 1;
+		if (box_w * box_h > 0x1010101) {
+			method = rp_image::SCALE_BILINEAR;
+		}
+	}
+	*pMethod = method;
+
+	rp_image *img;
+	switch (method) {
+		default:
+			assert(!"Unsupported rp_image::ScaleMethod.");
+			// fall-through
+		case rp_image::SCALE_NEAREST:
+			img = scale_nearest(q, width, height);
+			if (img && d->has_sBIT) {
+				img->set_sBIT(&d->sBIT);
+			}
+			return img;
+
+		case rp_image::SCALE_BILINEAR:
+		case rp_image::SCALE_BOX:
+			break;
+	}
+
+	// Filtering is done on premultiplied ARGB32 in order to
+	// prevent colors from transparent pixels from bleeding in.
+	// Premultiplying an opaque image doesn't change it.
+	rp_image *const src = q->dup_ARGB32();
+	if (!src) {
+		// Unable to convert the image to ARGB32.
+		return nullptr;
+	}
+	if (!q->isOpaque()) {
+		src->premultiply();
+	}
+
+	img = new rp_image(width, height, rp_image::Format::ARGB32);
+	if (!img->isValid()) {
+		// Image is invalid.
+		img->unref();
+		src->unref();
+		return nullptr;
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		img->set_sBIT(&d->sBIT);
+	}
+
+	*pSrc = src;
+	return img;
+}
+
+/**
+ * Finish scaling an image.
+ * This un-premultiplies the new image and frees the source image.
+ * @param img New image from scale_begin().
+ * @param src Premultiplied ARGB32 source image from scale_begin().
+ * @return img
+ */
+rp_image *rp_image_private::scale_end(rp_image *img, rp_image *src)
+{
+	src->unref();
+	// Un-premultiplying an opaque image doesn't change it.
+	if (!img->isOpaque()) {
+		img->un_premultiply();
+	}
+	return img;
+}
+
+/**
+ * Scale the rp_image using nearest-neighbor scaling,
+ * and convert it to ARGB32.
+ * Standard version using regular C++ code.
+ *
+ * CI8 images are converted in the same pass, so a full-size
+ * ARGB32 copy of the original image is never created.
+ *
+ * @param width New width
+ * @param height New height
+ * @return New ARGB32 rp_image with a scaled version of the original, or nullptr on error.
+ */
+rp_image *rp_image::scaled_nearest_ARGB32_cpp(int width, int height) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0 ||
+	    (backend->format != Format::CI8 && backend->format != Format::ARGB32))
+	{
+		assert(backend->format == Format::CI8 || backend->format == Format::ARGB32);
+		return nullptr;
+	}
+
+	rp_image *const img = new rp_image(width, height, Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	// Source column for each destination column,
+	// and source row for each destination row.
+	std::unique_ptr<int[]> xtbl(new int[width]);
+	std::unique_ptr<int[]> ytbl(new int[height]);
+	rp_image_private::calc_nearest_table(xtbl.get(), width, backend->width);
+	rp_image_private::calc_nearest_table(ytbl.get(), height, backend->height);
+
+	// CI8 palette.
+	// Entries past the end of the source palette are transparent.
+	uint32_t palette[256];
+	if (backend->format == Format::CI8) {
+		const int entries = std::min(256, backend->palette_len());
+		memcpy(palette, backend->palette(), entries * sizeof(uint32_t));
+		memset(&palette[entries], 0, (256 - entries) * sizeof(uint32_t));
+	}
+
+	const uint8_t *const src_bits = static_cast<const uint8_t*>(backend->data());
+	const int src_stride = backend->stride;
+	const uint32_t *prev_dest = nullptr;
+	int prev_sy = -1;
+	for (int y = 0; y < height; y++) {
+		uint32_t *const dest = static_cast<uint32_t*>(img->scanLine(y));
+		const int sy = ytbl[y];
+		if (sy == prev_sy) {
+			// Same source row as the previous destination row.
+			memcpy(dest, prev_dest, width * sizeof(uint32_t));
+			continue;
+		}
+
+		if (backend->format == Format::CI8) {
+			// Palette lookup and scale in one step.
+			const uint8_t *const src = &src_bits[sy * src_stride];
+			for (int x = 0; x < width; x++) {
+				dest[x] = palette[src[xtbl[x]]];
+			}
+		} else {
+			const uint32_t *const src = reinterpret_cast<const uint32_t*>(&src_bits[sy * src_stride]);
+			for (int x = 0; x < width; x++) {
+				dest[x] = src[xtbl[x]];
+			}
+		}
+
+		prev_dest = dest;
+		prev_sy = sy;
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		img->set_sBIT(&d->sBIT);
+	}
+
+	return img;
+}
+
+/**
+ * Scale the rp_image.
+ * Standard version using regular C++ code.
+ *
+ * SCALE_NEAREST keeps the original image format.
+ * All other scaling methods return an ARGB32 image.
+ *
+ * @param width New width
+ * @param height New height
+ * @param method Scaling method
+ * @return New rp_image with a scaled version of the original, or nullptr on error.
+ */
+rp_image *rp_image::scaled_cpp(int width, int height, ScaleMethod method) const
+{
+	rp_image *src;
+	rp_image *const img = rp_image_private::scale_begin(this, width, height, &method, &src);
+	if (!src) {
+		// Image was scaled without filtering, or an error occurred.
+		return img;
+	}
+
+	const uint32_t *const src_bits = static_cast<const uint32_t*>(src->bits());
+	const int src_stride = src->stride() / sizeof(uint32_t);
+	uint32_t *dest = static_cast<uint32_t*>(img->bits());
+	const int dest_adj = (img->stride() / sizeof(uint32_t)) - width;
+
+	if (method == SCALE_BOX) {
+		// Box filter.
+		std::unique_ptr<rp_image_private::scale_box_t[]> xtbl(new rp_image_private::scale_box_t[width]);
+		std::unique_ptr<rp_image_private::scale_box_t[]> ytbl(new rp_image_private::scale_box_t[height]);
+		rp_image_private::calc_box_table(xtbl.get(), width, src->width());
+		rp_image_private::calc_box_table(ytbl.get(), height, src->height());
+
+		for (int y = 0; y < height; y++) {
+			const rp_image_private::scale_box_t &ty = ytbl[y];
+			const unsigned int box_h = ty.i1 - ty.i0;
+			for (int x = 0; x < width; x++) {
+				const rp_image_private::scale_box_t &tx = xtbl[x];
+				unsigned int sum_b = 0, sum_g = 0, sum_r = 0, sum_a = 0;
+
+				const uint32_t *src_row = &src_bits[ty.i0 * src_stride];
+				for (unsigned int sy = box_h; sy > 0; sy--, src_row += src_stride) {
+					for (int sx = tx.i0; sx < tx.i1; sx++) {
+						argb32_t px;
+						px.u32 = src_row[sx];
+						sum_b += px.b;
+						sum_g += px.g;
+						sum_r += px.r;
+						sum_a += px.a;
+					}
+				}
+
+				const unsigned int n = box_h * (tx.i1 - tx.i0);
+				argb32_t px;
+				px.b = (sum_b + (n / 2)) / n;
+				px.g = (sum_g + (n / 2)) / n;
+				px.r = (sum_r + (n / 2)) / n;
+				px.a = (sum_a + (n / 2)) / n;
+				*dest++ = px.u32;
+			}
+			dest += dest_adj;
+		}
+	} else /*if (method == SCALE_BILINEAR)*/ {
+		// Bilinear interpolation.
+		std::unique_ptr<rp_image_private::scale_bilinear_t[]> xtbl(new rp_image_private::scale_bilinear_t[width]);
+		std::unique_ptr<rp_image_private::scale_bilinear_t[]> ytbl(new rp_image_private::scale_bilinear_t[height]);
+		rp_image_private::calc_bilinear_table(xtbl.get(), width, src->width());
+		rp_image_private::calc_bilinear_table(ytbl.get(), height, src->height());
+
+		for (int y = 0; y < height; y++) {
+			const rp_image_private::scale_bilinear_t &ty = ytbl[y];
+			const uint32_t *const row0 = &src_bits[ty.i0 * src_stride];
+			const uint32_t *const row1 = &src_bits[ty.i1 * src_stride];
+			const unsigned int wy1 = ty.w;
+			const unsigned int wy0 = 256 - wy1;
+
+			for (int x = 0; x < width; x++) {
+				const rp_image_private::scale_bilinear_t &tx = xtbl[x];
+				const unsigned int wx1 = tx.w;
+				const unsigned int wx0 = 256 - wx1;
+
+				argb32_t tl, tr, bl, br, px;
+				tl.u32 = row0[tx.i0];
+				tr.u32 = row0[tx.i1];
+				bl.u32 = row1[tx.i0];
+				br.u32 = row1[tx.i1];
+
+				// NOTE: The SSE2 version uses the same rounding,
+				// so the results are identical.
+#define BILINEAR_CHANNEL(ch) do { \
+	const unsigned int top = ((tl.ch * wx0) + (tr.ch * wx1) + 128) >> 8; \
+	const unsigned int bot = ((bl.ch * wx0) + (br.ch * wx1) + 128) >> 8; \
+	px.ch = ((top * wy0) + (bot * wy1) + 128) >> 8; \
+} while (0)
+				BILINEAR_CHANNEL(b);
+				BILINEAR_CHANNEL(g);
+				BILINEAR_CHANNEL(r);
+				BILINEAR_CHANNEL(a);
+#undef BILINEAR_CHANNEL
+				*dest++ = px.u32;
+			}
+			dest += dest_adj;
+		}
+	}
+
+	return rp_image_private::scale_end(img, src);
+}
+
 /**
  * Convert a chroma-keyed image to standard ARGB32.
  * Standard version using regular C++ code.
@@ -513,6 +1060,7 @@ rp_image *rp_image::resized(int width, int height, Alignment alignment, uint32_t
 int rp_image::apply_chroma_key_cpp(uint32_t key)
 {
 	RP_D(rp_image);
+	d->opaque = -1;
 	rp_image_backend *const backend = d->backend;
 
 	assert(backend->format == Format::ARGB32);
@@ -557,8 +1105,56 @@ int rp_image::apply_chroma_key_cpp(uint32_t key)
 	return 0;
 }
 
+/**
+ * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+ * Standard version using regular C++ code.
+ *
+ * NOTE: The image *must* be ARGB32.
+ * isOpaque() should usually be used instead, since it
+ * caches the result and handles CI8 images.
+ *
+ * @return True if the image is fully opaque; false if not.
+ */
+bool rp_image::scan_opaque_cpp(void) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+	assert(backend->format == Format::ARGB32);
+	if (backend->format != Format::ARGB32) {
+		// ARGB32 only.
+		return false;
+	}
+
+	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
+	const uint32_t *img_buf = static_cast<const uint32_t*>(backend->data());
+
+	for (unsigned int y = static_cast<unsigned int>(backend->height); y > 0; y--) {
+		// AND all pixels in the row together.
+		// The alpha channel will only be 0xFF if all pixels are opaque.
+		uint32_t px_and = 0xFFFFFFFFU;
+		unsigned int x = static_cast<unsigned int>(backend->width);
+		for (; x > 1; x -= 2, img_buf += 2) {
+			px_and &= img_buf[0] & img_buf[1];
+		}
+		if (x == 1) {
+			px_and &= *img_buf++;
+		}
+		if ((px_and & 0xFF000000U) != 0xFF000000U) {
+			// Found a transparent pixel.
+			return false;
+		}
+
+		// Next row.
+		img_buf += diff;
+	}
+
+	// All pixels are opaque.
+	return true;
+}
+
 /**
  * Flip the image.
+ * Standard version using regular C++ code.
  *
  * This function returns a *new* image and leaves the
  * original image unmodified.
@@ -566,7 +1162,7 @@ int rp_image::apply_chroma_key_cpp(uint32_t key)
  * @param op Flip operation.
  * @return Flipped image, or nullptr on error.
  */
-rp_image *rp_image::flip(FlipOp op) const
+rp_image *rp_image::flip_cpp(FlipOp op) const
 {
 	assert(op >= FLIP_V);
 	assert(op <= FLIP_VH);
@@ -688,6 +1284,81 @@ rp_image *rp_image::flip(FlipOp op) const
 	return flipimg;
 }
 
+/**
+ * Flip the image in place.
+ *
+ * This operates on the image itself, and does not return
+ * a duplicated image with the adjusted image.
+ *
+ * @param op Flip operation.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int rp_image::flip_inplace(FlipOp op)
+{
+	assert(op >= FLIP_NONE);
+	assert(op <= FLIP_VH);
+	if (op == FLIP_NONE) {
+		// No-op...
+		return 0;
+	} else if (op > FLIP_VH) {
+		// Not supported.
+		return -EINVAL;
+	}
+
+	RP_D(rp_image);
+	rp_image_backend *const backend = d->backend;
+
+	const int width = backend->width;
+	const int height = backend->height;
+	assert(width > 0 && height > 0);
+	if (width <= 0 || height <= 0) {
+		return -EINVAL;
+	}
+
+	// NOTE: Using uint8_t* because stride is measured in bytes.
+	uint8_t *const bits = static_cast<uint8_t*>(backend->data());
+	const int stride = backend->stride;
+	const int row_bytes = this->row_bytes();
+
+	if (op & FLIP_H) {
+		// Horizontal flip: Reverse each row.
+		switch (backend->format) {
+			default:
+				assert(!"rp_image format not supported for H-flip.");
+				return -ENOTSUP;
+
+			case rp_image::Format::CI8:
+				for (int y = 0; y < height; y++) {
+					uint8_t *const row = &bits[y * stride];
+					std::reverse(row, row + width);
+				}
+				break;
+
+			case rp_image::Format::ARGB32:
+				for (int y = 0; y < height; y++) {
+					uint32_t *const row = reinterpret_cast<uint32_t*>(&bits[y * stride]);
+					std::reverse(row, row + width);
+				}
+				break;
+		}
+	}
+
+	if (op & FLIP_V) {
+		// Vertical flip: Swap the rows.
+		std::unique_ptr<uint8_t[]> tmp_row(new uint8_t[row_bytes]);
+		uint8_t *top = bits;
+		uint8_t *bottom = &bits[(height - 1) * stride];
+		for (; top < bottom; top += stride, bottom -= stride) {
+			memcpy(tmp_row.get(), top, row_bytes);
+			memcpy(top, bottom, row_bytes);
+			memcpy(bottom, tmp_row.get(), row_bytes);
+		}
+	}
+
+	// Image has been flipped.
+	return 0;
+}
+
 /**
  * Shrink image dimensions.
  * @param width New width.
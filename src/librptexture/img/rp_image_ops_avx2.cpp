@@ -0,0 +1,267 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * rp_image_ops.cpp: Image class. (operations)                             *
+ * AVX2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "rp_image.hpp"
+#include "rp_image_p.hpp"
+#include "rp_image_backend.hpp"
+
+// AVX2 intrinsics.
+#include <immintrin.h>
+
+// Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
+#define rp_imagePrivate rp_image_private
+
+namespace LibRpTexture {
+
+/** Image operations. **/
+
+/**
+ * Convert a chroma-keyed image to standard ARGB32.
+ * AVX2-optimized version.
+ *
+ * This operates on the image itself, and does not return
+ * a duplicated image with the adjusted image.
+ *
+ * NOTE: The image *must* be ARGB32.
+ *
+ * @param key Chroma key color.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int rp_image::apply_chroma_key_avx2(uint32_t key)
+{
+	RP_D(rp_image);
+	d->opaque = -1;
+	rp_image_backend *const backend = d->backend;
+	assert(backend->format == Format::ARGB32);
+	if (backend->format != Format::ARGB32) {
+		// ARGB32 only.
+		return -EINVAL;
+	}
+
+	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
+	uint32_t *img_buf = static_cast<uint32_t*>(backend->data());
+
+	// AVX2 constants.
+	const __m256i ymm_key = _mm256_set1_epi32(key);
+
+	for (unsigned int y = static_cast<unsigned int>(backend->height); y > 0; y--) {
+		// Process 8 pixels per iteration with AVX2.
+		unsigned int x = static_cast<unsigned int>(backend->width);
+		for (; x > 7; x -= 8, img_buf += 8) {
+			__m256i *const ymm_data = reinterpret_cast<__m256i*>(img_buf);
+			const __m256i px = _mm256_loadu_si256(ymm_data);
+
+			// Compare the pixels to the chroma key.
+			// Equal values will be 0xFFFFFFFF.
+			// Non-equal values will be 0x00000000.
+			const __m256i res = _mm256_cmpeq_epi32(px, ymm_key);
+
+			// Mask the original data with the inverted results.
+			// Original data will now have 00s for chroma-keyed pixels.
+			_mm256_storeu_si256(ymm_data, _mm256_andnot_si256(res, px));
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, img_buf++) {
+			if (*img_buf == key) {
+				*img_buf = 0;
+			}
+		}
+
+		// Next row.
+		img_buf += diff;
+	}
+
+	// Adjust sBIT.
+	// TODO: Only if transparent pixels were found.
+	if (d->has_sBIT && d->sBIT.alpha == 0) {
+		d->sBIT.alpha = 1;
+	}
+
+	// Chroma key applied.
+	return 0;
+}
+
+/**
+ * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+ * AVX2-optimized version.
+ *
+ * NOTE: The image *must* be ARGB32.
+ * isOpaque() should usually be used instead, since it
+ * caches the result and handles CI8 images.
+ *
+ * @return True if the image is fully opaque; false if not.
+ */
+bool rp_image::scan_opaque_avx2(void) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+	assert(backend->format == Format::ARGB32);
+	if (backend->format != Format::ARGB32) {
+		// ARGB32 only.
+		return false;
+	}
+
+	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
+	const uint32_t *img_buf = static_cast<const uint32_t*>(backend->data());
+
+	// AVX2 constants.
+	// OR'ing in the RGB mask leaves 0xFFFFFFFF for opaque pixels.
+	const __m256i ymm_rgb_mask = _mm256_set1_epi32(0x00FFFFFF);
+	const __m256i ymm_ones = _mm256_set1_epi32(0xFFFFFFFF);
+
+	for (unsigned int y = static_cast<unsigned int>(backend->height); y > 0; y--) {
+		// Process 16 pixels per iteration with AVX2.
+		// AND all pixels in the row together, then check the alpha channel.
+		__m256i ymm_and = ymm_ones;
+		unsigned int x = static_cast<unsigned int>(backend->width);
+		for (; x > 15; x -= 16, img_buf += 16) {
+			const __m256i px0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&img_buf[0]));
+			const __m256i px1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&img_buf[8]));
+			ymm_and = _mm256_and_si256(ymm_and, _mm256_and_si256(px0, px1));
+		}
+		for (; x > 7; x -= 8, img_buf += 8) {
+			const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(img_buf));
+			ymm_and = _mm256_and_si256(ymm_and, px);
+		}
+		ymm_and = _mm256_or_si256(ymm_and, ymm_rgb_mask);
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(ymm_and, ymm_ones)) != -1) {
+			// Found a transparent pixel.
+			return false;
+		}
+
+		// Remaining pixels.
+		uint32_t px_and = 0xFFFFFFFFU;
+		for (; x > 0; x--, img_buf++) {
+			px_and &= *img_buf;
+		}
+		if ((px_and & 0xFF000000U) != 0xFF000000U) {
+			// Found a transparent pixel.
+			return false;
+		}
+
+		// Next row.
+		img_buf += diff;
+	}
+
+	// All pixels are opaque.
+	return true;
+}
+
+/**
+ * Scale the rp_image using nearest-neighbor scaling,
+ * and convert it to ARGB32.
+ * AVX2-optimized version.
+ *
+ * CI8 images are converted in the same pass, so a full-size
+ * ARGB32 copy of the original image is never created.
+ *
+ * @param width New width
+ * @param height New height
+ * @return New ARGB32 rp_image with a scaled version of the original, or nullptr on error.
+ */
+rp_image *rp_image::scaled_nearest_ARGB32_avx2(int width, int height) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0 ||
+	    (backend->format != Format::CI8 && backend->format != Format::ARGB32))
+	{
+		assert(backend->format == Format::CI8 || backend->format == Format::ARGB32);
+		return nullptr;
+	}
+
+	rp_image *const img = new rp_image(width, height, Format::ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		img->unref();
+		return nullptr;
+	}
+
+	// Source column for each destination column,
+	// and source row for each destination row.
+	std::unique_ptr<int[]> xtbl(new int[width]);
+	std::unique_ptr<int[]> ytbl(new int[height]);
+	rp_image_private::calc_nearest_table(xtbl.get(), width, backend->width);
+	rp_image_private::calc_nearest_table(ytbl.get(), height, backend->height);
+
+	// CI8 palette.
+	// Entries past the end of the source palette are transparent.
+	// Each source row is converted to ARGB32 in rowbuf before scaling,
+	// so only a single row of ARGB32 data is needed.
+	const int src_width = backend->width;
+	uint32_t palette[256];
+	std::unique_ptr<uint32_t[]> rowbuf;
+	if (backend->format == Format::CI8) {
+		const int entries = std::min(256, backend->palette_len());
+		memcpy(palette, backend->palette(), entries * sizeof(uint32_t));
+		memset(&palette[entries], 0, (256 - entries) * sizeof(uint32_t));
+		rowbuf.reset(new uint32_t[src_width]);
+	}
+
+	const uint8_t *const src_bits = static_cast<const uint8_t*>(backend->data());
+	const int src_stride = backend->stride;
+	const uint32_t *prev_dest = nullptr;
+	int prev_sy = -1;
+	for (int y = 0; y < height; y++) {
+		uint32_t *const dest = static_cast<uint32_t*>(img->scanLine(y));
+		const int sy = ytbl[y];
+		if (sy == prev_sy) {
+			// Same source row as the previous destination row.
+			memcpy(dest, prev_dest, width * sizeof(uint32_t));
+			continue;
+		}
+
+		const uint32_t *src;
+		if (backend->format == Format::CI8) {
+			// Look up 8 palette entries per iteration.
+			const uint8_t *const src8 = &src_bits[sy * src_stride];
+			uint32_t *const row = rowbuf.get();
+			int x = 0;
+			for (; x <= src_width - 8; x += 8) {
+				const __m256i idx = _mm256_cvtepu8_epi32(
+					_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&src8[x])));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&row[x]),
+					_mm256_i32gather_epi32(reinterpret_cast<const int*>(palette), idx, 4));
+			}
+			for (; x < src_width; x++) {
+				row[x] = palette[src8[x]];
+			}
+			src = row;
+		} else {
+			src = reinterpret_cast<const uint32_t*>(&src_bits[sy * src_stride]);
+		}
+
+		// Scale 8 pixels per iteration.
+		int x = 0;
+		for (; x <= width - 8; x += 8) {
+			const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&xtbl[x]));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(&dest[x]),
+				_mm256_i32gather_epi32(reinterpret_cast<const int*>(src), idx, 4));
+		}
+		for (; x < width; x++) {
+			dest[x] = src[xtbl[x]];
+		}
+
+		prev_dest = dest;
+		prev_sy = sy;
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		img->set_sBIT(&d->sBIT);
+	}
+
+	return img;
+}
+
+}
@@ -0,0 +1,147 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * rp_image_ops.cpp: Image class. (operations)                             *
+ * NEON-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "rp_image.hpp"
+#include "rp_image_p.hpp"
+#include "rp_image_backend.hpp"
+
+// NEON intrinsics.
+#include <arm_neon.h>
+
+// Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
+#define rp_imagePrivate rp_image_private
+
+namespace LibRpTexture {
+
+/** Image operations. **/
+
+/**
+ * Convert a chroma-keyed image to standard ARGB32.
+ * NEON-optimized version.
+ *
+ * This operates on the image itself, and does not return
+ * a duplicated image with the adjusted image.
+ *
+ * NOTE: The image *must* be ARGB32.
+ *
+ * @param key Chroma key color.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int rp_image::apply_chroma_key_neon(uint32_t key)
+{
+	RP_D(rp_image);
+	d->opaque = -1;
+	rp_image_backend *const backend = d->backend;
+	assert(backend->format == Format::ARGB32);
+	if (backend->format != Format::ARGB32) {
+		// ARGB32 only.
+		return -EINVAL;
+	}
+
+	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
+	uint32_t *img_buf = static_cast<uint32_t*>(backend->data());
+
+	// NEON constants.
+	const uint32x4_t vkey = vdupq_n_u32(key);
+
+	for (unsigned int y = static_cast<unsigned int>(backend->height); y > 0; y--) {
+		// Process 8 pixels per iteration with NEON.
+		unsigned int x = static_cast<unsigned int>(backend->width);
+		for (; x > 7; x -= 8, img_buf += 8) {
+			const uint32x4_t px0 = vld1q_u32(&img_buf[0]);
+			const uint32x4_t px1 = vld1q_u32(&img_buf[4]);
+
+			// Compare the pixels to the chroma key.
+			// Equal values will be 0xFFFFFFFF.
+			// Non-equal values will be 0x00000000.
+			// vbicq_u32() clears the matching pixels.
+			vst1q_u32(&img_buf[0], vbicq_u32(px0, vceqq_u32(px0, vkey)));
+			vst1q_u32(&img_buf[4], vbicq_u32(px1, vceqq_u32(px1, vkey)));
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, img_buf++) {
+			if (*img_buf == key) {
+				*img_buf = 0;
+			}
+		}
+
+		// Next row.
+		img_buf += diff;
+	}
+
+	// Adjust sBIT.
+	// TODO: Only if transparent pixels were found.
+	if (d->has_sBIT && d->sBIT.alpha == 0) {
+		d->sBIT.alpha = 1;
+	}
+
+	// Chroma key applied.
+	return 0;
+}
+
+/**
+ * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+ * NEON-optimized version.
+ *
+ * NOTE: The image *must* be ARGB32.
+ * isOpaque() should usually be used instead, since it
+ * caches the result and handles CI8 images.
+ *
+ * @return True if the image is fully opaque; false if not.
+ */
+bool rp_image::scan_opaque_neon(void) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+	assert(backend->format == Format::ARGB32);
+	if (backend->format != Format::ARGB32) {
+		// ARGB32 only.
+		return false;
+	}
+
+	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
+	const uint32_t *img_buf = static_cast<const uint32_t*>(backend->data());
+
+	for (unsigned int y = static_cast<unsigned int>(backend->height); y > 0; y--) {
+		// Process 8 pixels per iteration with NEON.
+		// AND all pixels in the row together, then check the alpha channel.
+		uint32x4_t vand = vdupq_n_u32(0xFFFFFFFFU);
+		unsigned int x = static_cast<unsigned int>(backend->width);
+		for (; x > 7; x -= 8, img_buf += 8) {
+			const uint32x4_t px0 = vld1q_u32(&img_buf[0]);
+			const uint32x4_t px1 = vld1q_u32(&img_buf[4]);
+			vand = vandq_u32(vand, vandq_u32(px0, px1));
+		}
+		// vminvq_u32() returns the smallest alpha value in the upper byte.
+		if ((vminvq_u32(vorrq_u32(vand, vdupq_n_u32(0x00FFFFFF))) >> 24) != 0xFF) {
+			// Found a transparent pixel.
+			return false;
+		}
+
+		// Remaining pixels.
+		uint32_t px_and = 0xFFFFFFFFU;
+		for (; x > 0; x--, img_buf++) {
+			px_and &= *img_buf;
+		}
+		if ((px_and & 0xFF000000U) != 0xFF000000U) {
+			// Found a transparent pixel.
+			return false;
+		}
+
+		// Next row.
+		img_buf += diff;
+	}
+
+	// All pixels are opaque.
+	return true;
+}
+
+}
@@ -3,7 +3,7 @@
  * rp_image_ops.cpp: Image class. (operations)                             *
  * SSE2-optimized version.                                                 *
  *                                                                         *
- * Copyright (c) 2016-2019 by David Korth.                                 *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
  * SPDX-License-Identifier: GPL-2.0-or-later                               *
  ***************************************************************************/
 
@@ -37,6 +37,7 @@ namespace LibRpTexture {
 int rp_image::apply_chroma_key_sse2(uint32_t key)
 {
 	RP_D(rp_image);
+	d->opaque = -1;
 	rp_image_backend *const backend = d->backend;
 	assert(backend->format == Format::ARGB32);
 	if (backend->format != Format::ARGB32) {
@@ -88,4 +89,322 @@ int rp_image::apply_chroma_key_sse2(uint32_t key)
 	return 0;
 }
 
+/**
+ * Check if all pixels in an ARGB32 image have alpha == 0xFF.
+ * SSE2-optimized version.
+ *
+ * NOTE: The image *must* be ARGB32.
+ * isOpaque() should usually be used instead, since it
+ * caches the result and handles CI8 images.
+ *
+ * @return True if the image is fully opaque; false if not.
+ */
+bool rp_image::scan_opaque_sse2(void) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+	assert(backend->format == Format::ARGB32);
+	if (backend->format != Format::ARGB32) {
+		// ARGB32 only.
+		return false;
+	}
+
+	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
+	const uint32_t *img_buf = static_cast<const uint32_t*>(backend->data());
+
+	// SSE2 constants.
+	// OR'ing in the RGB mask leaves 0xFFFFFFFF for opaque pixels.
+	const __m128i xmm_rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+	const __m128i xmm_ones = _mm_set1_epi32(0xFFFFFFFF);
+
+	for (unsigned int y = static_cast<unsigned int>(backend->height); y > 0; y--) {
+		// Process 8 pixels per iteration with SSE2.
+		// AND all pixels in the row together, then check the alpha channel.
+		__m128i xmm_and = xmm_ones;
+		unsigned int x = static_cast<unsigned int>(backend->width);
+		for (; x > 7; x -= 8, img_buf += 8) {
+			const __m128i px0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&img_buf[0]));
+			const __m128i px1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&img_buf[4]));
+			xmm_and = _mm_and_si128(xmm_and, _mm_and_si128(px0, px1));
+		}
+		xmm_and = _mm_or_si128(xmm_and, xmm_rgb_mask);
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(xmm_and, xmm_ones)) != 0xFFFF) {
+			// Found a transparent pixel.
+			return false;
+		}
+
+		// Remaining pixels.
+		uint32_t px_and = 0xFFFFFFFFU;
+		for (; x > 0; x--, img_buf++) {
+			px_and &= *img_buf;
+		}
+		if ((px_and & 0xFF000000U) != 0xFF000000U) {
+			// Found a transparent pixel.
+			return false;
+		}
+
+		// Next row.
+		img_buf += diff;
+	}
+
+	// All pixels are opaque.
+	return true;
+}
+
+
+/**
+ * Scale the rp_image.
+ * SSE2-optimized version.
+ *
+ * SCALE_NEAREST keeps the original image format.
+ * All other scaling methods return an ARGB32 image.
+ *
+ * @param width New width
+ * @param height New height
+ * @param method Scaling method
+ * @return New rp_image with a scaled version of the original, or nullptr on error.
+ */
+rp_image *rp_image::scaled_sse2(int width, int height, ScaleMethod method) const
+{
+	rp_image *src;
+	rp_image *const img = rp_image_private::scale_begin(this, width, height, &method, &src);
+	if (!src) {
+		// Image was scaled without filtering, or an error occurred.
+		return img;
+	}
+
+	const uint32_t *const src_bits = static_cast<const uint32_t*>(src->bits());
+	const int src_stride = src->stride() / sizeof(uint32_t);
+	uint32_t *dest = static_cast<uint32_t*>(img->bits());
+	const int dest_adj = (img->stride() / sizeof(uint32_t)) - width;
+
+	// SSE2 constants.
+	const __m128i xmm_zero = _mm_setzero_si128();
+
+	if (method == SCALE_BOX) {
+		// Box filter.
+		std::unique_ptr<rp_image_private::scale_box_t[]> xtbl(new rp_image_private::scale_box_t[width]);
+		std::unique_ptr<rp_image_private::scale_box_t[]> ytbl(new rp_image_private::scale_box_t[height]);
+		rp_image_private::calc_box_table(xtbl.get(), width, src->width());
+		rp_image_private::calc_box_table(ytbl.get(), height, src->height());
+
+		for (int y = 0; y < height; y++) {
+			const rp_image_private::scale_box_t &ty = ytbl[y];
+			const unsigned int box_h = ty.i1 - ty.i0;
+			for (int x = 0; x < width; x++) {
+				const rp_image_private::scale_box_t &tx = xtbl[x];
+
+				// 32-bit sums for each channel, in memory order.
+				__m128i xmm_sum = _mm_setzero_si128();
+
+				const uint32_t *src_row = &src_bits[ty.i0 * src_stride];
+				for (unsigned int sy = box_h; sy > 0; sy--, src_row += src_stride) {
+					const uint32_t *px = &src_row[tx.i0];
+					unsigned int sx = static_cast<unsigned int>(tx.i1 - tx.i0);
+
+					// Process 4 pixels per iteration.
+					// NOTE: 16-bit sums of 4 pixels can't overflow.
+					for (; sx > 3; sx -= 4, px += 4) {
+						const __m128i xmm_px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px));
+						const __m128i xmm_px16 = _mm_add_epi16(
+							_mm_unpacklo_epi8(xmm_px, xmm_zero),
+							_mm_unpackhi_epi8(xmm_px, xmm_zero));
+						const __m128i xmm_px16s = _mm_add_epi16(xmm_px16, _mm_srli_si128(xmm_px16, 8));
+						xmm_sum = _mm_add_epi32(xmm_sum, _mm_unpacklo_epi16(xmm_px16s, xmm_zero));
+					}
+
+					// Remaining pixels.
+					for (; sx > 0; sx--, px++) {
+						const __m128i xmm_px = _mm_cvtsi32_si128(static_cast<int>(*px));
+						xmm_sum = _mm_add_epi32(xmm_sum, _mm_unpacklo_epi16(
+							_mm_unpacklo_epi8(xmm_px, xmm_zero), xmm_zero));
+					}
+				}
+
+				// Average the sums.
+				// NOTE: SSE2 doesn't have integer division.
+				union {
+					__m128i xmm;
+					uint32_t u32[4];
+				} sum;
+				sum.xmm = xmm_sum;
+
+				const unsigned int n = box_h * (tx.i1 - tx.i0);
+				uint8_t pxb[4];
+				pxb[0] = (sum.u32[0] + (n / 2)) / n;
+				pxb[1] = (sum.u32[1] + (n / 2)) / n;
+				pxb[2] = (sum.u32[2] + (n / 2)) / n;
+				pxb[3] = (sum.u32[3] + (n / 2)) / n;
+				memcpy(dest, pxb, sizeof(*dest));
+				dest++;
+			}
+			dest += dest_adj;
+		}
+	} else /*if (method == SCALE_BILINEAR)*/ {
+		// Bilinear interpolation.
+		std::unique_ptr<rp_image_private::scale_bilinear_t[]> xtbl(new rp_image_private::scale_bilinear_t[width]);
+		std::unique_ptr<rp_image_private::scale_bilinear_t[]> ytbl(new rp_image_private::scale_bilinear_t[height]);
+		rp_image_private::calc_bilinear_table(xtbl.get(), width, src->width());
+		rp_image_private::calc_bilinear_table(ytbl.get(), height, src->height());
+
+		const __m128i xmm_round = _mm_set1_epi16(128);
+
+		for (int y = 0; y < height; y++) {
+			const rp_image_private::scale_bilinear_t &ty = ytbl[y];
+			const uint32_t *const row0 = &src_bits[ty.i0 * src_stride];
+			const uint32_t *const row1 = &src_bits[ty.i1 * src_stride];
+
+			// Vertical weights: low 4 words are for row0; high 4 words are for row1.
+			const __m128i xmm_wy = _mm_unpacklo_epi64(
+				_mm_set1_epi16(static_cast<short>(256 - ty.w)),
+				_mm_set1_epi16(static_cast<short>(ty.w)));
+
+			for (int x = 0; x < width; x++) {
+				const rp_image_private::scale_bilinear_t &tx = xtbl[x];
+
+				// Horizontal weights: low 4 words are for i0; high 4 words are for i1.
+				const __m128i xmm_wx = _mm_unpacklo_epi64(
+					_mm_set1_epi16(static_cast<short>(256 - tx.w)),
+					_mm_set1_epi16(static_cast<short>(tx.w)));
+
+				// Load the pixels as 16-bit values: [i0, i1]
+				__m128i xmm_top = _mm_unpacklo_epi8(_mm_unpacklo_epi32(
+					_mm_cvtsi32_si128(static_cast<int>(row0[tx.i0])),
+					_mm_cvtsi32_si128(static_cast<int>(row0[tx.i1]))), xmm_zero);
+				__m128i xmm_bot = _mm_unpacklo_epi8(_mm_unpacklo_epi32(
+					_mm_cvtsi32_si128(static_cast<int>(row1[tx.i0])),
+					_mm_cvtsi32_si128(static_cast<int>(row1[tx.i1]))), xmm_zero);
+
+				// Horizontal interpolation.
+				// NOTE: Maximum intermediate value is (255*256)+128,
+				// so unsigned 16-bit arithmetic won't overflow.
+				xmm_top = _mm_mullo_epi16(xmm_top, xmm_wx);
+				xmm_bot = _mm_mullo_epi16(xmm_bot, xmm_wx);
+				xmm_top = _mm_add_epi16(xmm_top, _mm_srli_si128(xmm_top, 8));
+				xmm_bot = _mm_add_epi16(xmm_bot, _mm_srli_si128(xmm_bot, 8));
+				xmm_top = _mm_srli_epi16(_mm_add_epi16(xmm_top, xmm_round), 8);
+				xmm_bot = _mm_srli_epi16(_mm_add_epi16(xmm_bot, xmm_round), 8);
+
+				// Vertical interpolation.
+				__m128i xmm_px = _mm_mullo_epi16(_mm_unpacklo_epi64(xmm_top, xmm_bot), xmm_wy);
+				xmm_px = _mm_add_epi16(xmm_px, _mm_srli_si128(xmm_px, 8));
+				xmm_px = _mm_srli_epi16(_mm_add_epi16(xmm_px, xmm_round), 8);
+
+				*dest++ = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(xmm_px, xmm_px)));
+			}
+			dest += dest_adj;
+		}
+	}
+
+	return rp_image_private::scale_end(img, src);
+}
+
+/**
+ * Flip the image.
+ * SSE2-optimized version.
+ *
+ * This function returns a *new* image and leaves the
+ * original image unmodified.
+ *
+ * @param op Flip operation.
+ * @return Flipped image, or nullptr on error.
+ */
+rp_image *rp_image::flip_sse2(FlipOp op) const
+{
+	// Vertical flips copy whole rows using memcpy(),
+	// so only horizontal flips need SSE2.
+	if (!(op & FLIP_H) || op > FLIP_VH) {
+		return flip_cpp(op);
+	}
+
+	RP_D(const rp_image);
+	rp_image_backend *const backend = d->backend;
+	if (backend->format != Format::CI8 && backend->format != Format::ARGB32) {
+		// Not supported.
+		return flip_cpp(op);
+	}
+
+	const int width = backend->width;
+	const int height = backend->height;
+	assert(width > 0 && height > 0);
+	if (width <= 0 || height <= 0) {
+		return nullptr;
+	}
+
+	rp_image *const flipimg = new rp_image(width, height, backend->format);
+	const uint8_t *src = static_cast<const uint8_t*>(backend->data());
+	uint8_t *dest;
+	int src_stride = backend->stride;
+	int dest_stride = flipimg->stride();
+	if (op & FLIP_V) {
+		// Vertical flip: Destination starts at the bottom of the image.
+		dest = static_cast<uint8_t*>(flipimg->scanLine(height - 1));
+		dest_stride = -dest_stride;
+	} else {
+		// Not a vertical flip: Destination starts at the top of the image.
+		dest = static_cast<uint8_t*>(flipimg->bits());
+	}
+
+	// Horizontal flip: Read the source row backwards and
+	// reverse the pixels within each register.
+	if (backend->format == Format::CI8) {
+		// 8-bit copy.
+		for (int y = height; y > 0; y--, src += src_stride, dest += dest_stride) {
+			const uint8_t *s = src + width;
+			uint8_t *dx = dest;
+
+			// Process 16 pixels per iteration.
+			int x = width;
+			for (; x > 15; x -= 16, dx += 16) {
+				s -= 16;
+				__m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+				// Reverse the DWORDs, then the WORDs, then the bytes.
+				px = _mm_shuffle_epi32(px, _MM_SHUFFLE(0,1,2,3));
+				px = _mm_shufflelo_epi16(px, _MM_SHUFFLE(2,3,0,1));
+				px = _mm_shufflehi_epi16(px, _MM_SHUFFLE(2,3,0,1));
+				px = _mm_or_si128(_mm_slli_epi16(px, 8), _mm_srli_epi16(px, 8));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dx), px);
+			}
+
+			// Remaining pixels.
+			for (; x > 0; x--, dx++) {
+				*dx = *--s;
+			}
+		}
+
+		// Copy the palette.
+		const int entries = std::min(flipimg->palette_len(), backend->palette_len());
+		memcpy(flipimg->palette(), backend->palette(), entries * sizeof(uint32_t));
+		// Palette is zero-initialized, so we don't need to
+		// zero remaining entries.
+	} else /*if (backend->format == Format::ARGB32)*/ {
+		// 32-bit copy.
+		for (int y = height; y > 0; y--, src += src_stride, dest += dest_stride) {
+			const uint32_t *s = reinterpret_cast<const uint32_t*>(src) + width;
+			uint32_t *dx = reinterpret_cast<uint32_t*>(dest);
+
+			// Process 4 pixels per iteration.
+			int x = width;
+			for (; x > 3; x -= 4, dx += 4) {
+				s -= 4;
+				const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dx),
+					_mm_shuffle_epi32(px, _MM_SHUFFLE(0,1,2,3)));
+			}
+
+			// Remaining pixels.
+			for (; x > 0; x--, dx++) {
+				*dx = *--s;
+			}
+		}
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		flipimg->set_sBIT(&d->sBIT);
+	}
+
+	return flipimg;
+}
+
 }
@@ -2,7 +2,7 @@
  * ROM Properties Page shell extension. (librptexture)                     *
  * rp_image_p.hpp: Image class. (Private class)                            *
  *                                                                         *
- * Copyright (c) 2016-2019 by David Korth.                                 *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
  * SPDX-License-Identifier: GPL-2.0-or-later                               *
  ***************************************************************************/
 
@@ -47,6 +47,78 @@ class rp_image_private
 	public:
 		static rp_image::rp_image_backend_creator_fn backend_fn;
 
+	public:
+		/** Scaling functions. (rp_image_ops.cpp) **/
+
+		// Bilinear scaling table entry.
+		// One entry per destination column or row.
+		struct scale_bilinear_t {
+			int i0;		// First source pixel
+			int i1;		// Second source pixel
+			unsigned int w;	// Weight of the second source pixel (0-256)
+		};
+
+		// Box filter table entry.
+		// One entry per destination column or row.
+		struct scale_box_t {
+			int i0;		// First source pixel
+			int i1;		// Last source pixel, plus one
+		};
+
+		/**
+		 * Calculate a bilinear scaling table.
+		 * @param tbl		[out] Table. (must have dest_len entries)
+		 * @param dest_len	[in] Destination length.
+		 * @param src_len	[in] Source length.
+		 */
+		static void calc_bilinear_table(scale_bilinear_t *tbl, int dest_len, int src_len);
+
+		/**
+		 * Calculate a box filter table.
+		 * @param tbl		[out] Table. (must have dest_len entries)
+		 * @param dest_len	[in] Destination length.
+		 * @param src_len	[in] Source length.
+		 */
+		static void calc_box_table(scale_box_t *tbl, int dest_len, int src_len);
+
+		/**
+		 * Calculate a nearest-neighbor scaling table.
+		 * @param tbl		[out] Table. (must have dest_len entries)
+		 * @param dest_len	[in] Destination length.
+		 * @param src_len	[in] Source length.
+		 */
+		static void calc_nearest_table(int *tbl, int dest_len, int src_len);
+
+		/**
+		 * Start scaling an image.
+		 *
+		 * If the image can be scaled without filtering, e.g. for
+		 * SCALE_NEAREST or if the size didn't change, the final
+		 * image is returned and *pSrc is set to nullptr.
+		 *
+		 * Otherwise, an empty ARGB32 image is returned, and *pSrc
+		 * is set to a premultiplied ARGB32 copy of the source image.
+		 * The caller must fill in the image and call scale_end().
+		 *
+		 * @param q		[in] Source image.
+		 * @param width		[in] New width.
+		 * @param height	[in] New height.
+		 * @param pMethod	[in/out] Scaling method. (may be adjusted)
+		 * @param pSrc		[out] Premultiplied ARGB32 source image.
+		 * @return New image, or nullptr on error.
+		 */
+		static rp_image *scale_begin(const rp_image *q, int width, int height,
+			rp_image::ScaleMethod *pMethod, rp_image **pSrc);
+
+		/**
+		 * Finish scaling an image.
+		 * This un-premultiplies the new image and frees the source image.
+		 * @param img New image from scale_begin().
+		 * @param src Premultiplied ARGB32 source image from scale_begin().
+		 * @return img
+		 */
+		static rp_image *scale_end(rp_image *img, rp_image *src);
+
 	public:
 		// Image backend.
 		rp_image_backend *backend;
@@ -54,6 +126,10 @@ class rp_image_private
 		// Metadata.
 		bool has_sBIT;
 		rp_image::sBIT_t sBIT;
+
+		// Cached isOpaque() result.
+		// -1 == unknown; 0 == has transparent pixels; 1 == opaque
+		mutable int8_t opaque;
 };
 
 }
@@ -0,0 +1,176 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * un-premultiply_avx2.cpp: Un-premultiply and premultiply functions.      *
+ * AVX2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "rp_image.hpp"
+#include "rp_image_p.hpp"
+#include "rp_image_backend.hpp"
+
+// AVX2 headers.
+#include <immintrin.h>
+
+// Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
+#define rp_imagePrivate rp_image_private
+
+namespace LibRpTexture {
+
+/**
+ * Un-premultiply an ARGB32 rp_image.
+ * AVX2-optimized version.
+ *
+ * Image must be ARGB32.
+ *
+ * @return 0 on success; non-zero on error.
+ */
+int rp_image::un_premultiply_avx2(void)
+{
+	RP_D(const rp_image);
+	rp_image_backend *const backend = d->backend;
+	assert(backend->format == rp_image::Format::ARGB32);
+	if (backend->format != rp_image::Format::ARGB32) {
+		// Incorrect format...
+		return -1;
+	}
+
+	const int *const inv_premul_factor = reinterpret_cast<const int*>(qt_inv_premul_factor);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i alpha_mask = _mm256_set1_epi32(0xFF000000);
+	const __m256i channel_mask = _mm256_set1_epi32(0xFF);
+	const __m256i rounding = _mm256_set1_epi32(0x8000);
+
+	const int width = backend->width;
+	uint32_t *px_dest = static_cast<uint32_t*>(backend->data());
+	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
+	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+		// Process 8 pixels per iteration.
+		int x = width;
+		for (; x > 7; x -= 8, px_dest += 8) {
+			__m256i *const ymm_dest = reinterpret_cast<__m256i*>(px_dest);
+			const __m256i px = _mm256_loadu_si256(ymm_dest);
+
+			// Look up the inverted pre-multiplication factor for each pixel.
+			const __m256i alpha = _mm256_srli_epi32(px, 24);
+			const __m256i inv_alpha = _mm256_i32gather_epi32(inv_premul_factor, alpha, 4);
+
+			// (c * invAlpha + 0x8000) >> 16 for each color channel.
+			// NOTE: This fits in 32 bits for all values of c and invAlpha.
+			__m256i b = _mm256_and_si256(px, channel_mask);
+			__m256i g = _mm256_and_si256(_mm256_srli_epi32(px, 8), channel_mask);
+			__m256i r = _mm256_and_si256(_mm256_srli_epi32(px, 16), channel_mask);
+			b = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(b, inv_alpha), rounding), 16);
+			g = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(g, inv_alpha), rounding), 16);
+			r = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(r, inv_alpha), rounding), 16);
+
+			// Truncate to 8 bits, same as the C++ version.
+			__m256i res = _mm256_and_si256(b, channel_mask);
+			res = _mm256_or_si256(res, _mm256_slli_epi32(_mm256_and_si256(g, channel_mask), 8));
+			res = _mm256_or_si256(res, _mm256_slli_epi32(_mm256_and_si256(r, channel_mask), 16));
+			res = _mm256_or_si256(res, _mm256_and_si256(px, alpha_mask));
+
+			// Pixels with alpha == 0 or alpha == 255 are left as-is.
+			const __m256i keep = _mm256_or_si256(
+				_mm256_cmpeq_epi32(alpha, zero),
+				_mm256_cmpeq_epi32(alpha, channel_mask));
+			_mm256_storeu_si256(ymm_dest, _mm256_blendv_epi8(res, px, keep));
+		}
+
+		// Remaining pixels.
+		// NOTE: The C++ version is in a different file,
+		// so do the remaining pixels one at a time.
+		for (; x > 0; x--, px_dest++) {
+			argb32_t rpx;
+			rpx.u32 = *px_dest;
+			if (rpx.a == 255 || rpx.a == 0)
+				continue;
+
+			const unsigned int invAlpha = qt_inv_premul_factor[rpx.a];
+			rpx.r = (rpx.r * invAlpha + 0x8000) >> 16;
+			rpx.g = (rpx.g * invAlpha + 0x8000) >> 16;
+			rpx.b = (rpx.b * invAlpha + 0x8000) >> 16;
+			*px_dest = rpx.u32;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Premultiply the 16-bit channels of four ARGB32 pixels. (AVX2 version)
+ * Based on Qt 5.9.1's qPremultiply(): (c*a + ((c*a) >> 8) + 0x80) >> 8
+ *
+ * NOTE: The alpha channel is also multiplied, so it
+ * must be restored by the caller.
+ *
+ * @param px16 Four ARGB32 pixels, unpacked to 16-bit channels.
+ * @return Premultiplied channels.
+ */
+static FORCEINLINE __m256i premultiply_px16_avx2(__m256i px16)
+{
+	// Broadcast each pixel's alpha value to all of its channels.
+	__m256i alpha = _mm256_shufflelo_epi16(px16, _MM_SHUFFLE(3,3,3,3));
+	alpha = _mm256_shufflehi_epi16(alpha, _MM_SHUFFLE(3,3,3,3));
+
+	// c*a is at most 0xFE01, so 16-bit math won't overflow.
+	__m256i t = _mm256_mullo_epi16(px16, alpha);
+	t = _mm256_add_epi16(t, _mm256_srli_epi16(t, 8));
+	t = _mm256_add_epi16(t, _mm256_set1_epi16(0x80));
+	return _mm256_srli_epi16(t, 8);
+}
+
+/**
+ * Premultiply an ARGB32 rp_image.
+ * AVX2-optimized version.
+ *
+ * Image must be ARGB32.
+ *
+ * @return 0 on success; non-zero on error.
+ */
+int rp_image::premultiply_avx2(void)
+{
+	RP_D(const rp_image);
+	rp_image_backend *const backend = d->backend;
+	assert(backend->format == rp_image::Format::ARGB32);
+	if (backend->format != rp_image::Format::ARGB32) {
+		// Incorrect format...
+		return -1;
+	}
+
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i alpha_mask = _mm256_set1_epi32(0xFF000000);
+
+	const int width = backend->width;
+	uint32_t *px_dest = static_cast<uint32_t*>(backend->data());
+	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
+	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+		// Process 8 pixels per iteration.
+		// NOTE: unpack and pack operate within 128-bit lanes,
+		// so the pixel order is preserved.
+		int x = width;
+		for (; x > 7; x -= 8, px_dest += 8) {
+			__m256i *const ymm_dest = reinterpret_cast<__m256i*>(px_dest);
+			const __m256i px = _mm256_loadu_si256(ymm_dest);
+			const __m256i res = _mm256_packus_epi16(
+				premultiply_px16_avx2(_mm256_unpacklo_epi8(px, zero)),
+				premultiply_px16_avx2(_mm256_unpackhi_epi8(px, zero)));
+
+			// Keep the original alpha channel, and keep the original
+			// color channels if alpha is 0. (Same as the C++ version.)
+			const __m256i alpha = _mm256_and_si256(px, alpha_mask);
+			const __m256i keep = _mm256_or_si256(alpha_mask, _mm256_cmpeq_epi32(alpha, zero));
+			_mm256_storeu_si256(ymm_dest, _mm256_blendv_epi8(res, px, keep));
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, px_dest++) {
+			*px_dest = premultiply_pixel(*px_dest);
+		}
+	}
+	return 0;
+}
+
+}
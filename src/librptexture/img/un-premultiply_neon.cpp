@@ -0,0 +1,144 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * un-premultiply_neon.cpp: Un-premultiply and premultiply functions.      *
+ * NEON-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2017-2019 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "rp_image.hpp"
+#include "rp_image_p.hpp"
+#include "rp_image_backend.hpp"
+
+// NEON headers.
+#include <arm_neon.h>
+
+// Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
+#define rp_imagePrivate rp_image_private
+
+namespace LibRpTexture {
+
+/**
+ * Un-premultiply an argb32_t pixel. (NEON version)
+ * Based on qt-5.11.0's qUnpremultiply_sse4().
+ *
+ * This is needed in order to convert DXT2/3 to DXT4/5.
+ *
+ * @param px	[in/out] argb32_t pixel to un-premultiply, in place.
+ */
+static FORCEINLINE void un_premultiply_pixel_neon(argb32_t &px)
+{
+	const unsigned int alpha = px.a;
+	if (alpha == 255 || alpha == 0)
+		return;
+
+	// c * invAlpha is at most 255 * (255 << 16), which fits in uint32_t.
+	const uint32_t invAlpha = rp_image::qt_inv_premul_factor[alpha];
+	const uint8x8_t v8 = vreinterpret_u8_u32(vdup_n_u32(px.u32));
+	uint32x4_t vl = vmovl_u16(vget_low_u16(vmovl_u8(v8)));
+	vl = vmulq_n_u32(vl, invAlpha);
+	// (c * invAlpha + 0x8000) >> 16, saturated to 8-bit.
+	const uint16x4_t v16 = vqrshrn_n_u32(vl, 16);
+	uint8x8_t res = vqmovn_u16(vcombine_u16(v16, v16));
+	res = vset_lane_u8(static_cast<uint8_t>(alpha), res, 3);
+	px.u32 = vget_lane_u32(vreinterpret_u32_u8(res), 0);
+}
+
+/**
+ * Un-premultiply an ARGB32 rp_image.
+ * Image must be ARGB32.
+ * @return 0 on success; non-zero on error.
+ */
+int rp_image::un_premultiply_neon(void)
+{
+	RP_D(const rp_image);
+	rp_image_backend *const backend = d->backend;
+	assert(backend->format == rp_image::Format::ARGB32);
+	if (backend->format != rp_image::Format::ARGB32) {
+		// Incorrect format...
+		return -1;
+	}
+
+	const int width = backend->width;
+	argb32_t *px_dest = static_cast<argb32_t*>(backend->data());
+	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
+	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+		int x = width;
+		for (; x > 1; x -= 2, px_dest += 2) {
+			un_premultiply_pixel_neon(px_dest[0]);
+			un_premultiply_pixel_neon(px_dest[1]);
+		}
+		if (x == 1) {
+			un_premultiply_pixel_neon(*px_dest);
+			px_dest++;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Premultiply a color channel for 8 pixels. (NEON version)
+ * Based on Qt 5.9.1's qPremultiply(): (c*a + ((c*a) >> 8) + 0x80) >> 8
+ *
+ * The original color channel is kept if alpha is 0.
+ * (Same as the C++ version.)
+ *
+ * @param c Color channel.
+ * @param a Alpha channel.
+ * @param a_zero Mask of pixels where alpha is 0.
+ * @return Premultiplied color channel.
+ */
+static FORCEINLINE uint8x8_t premultiply_channel_neon(uint8x8_t c, uint8x8_t a, uint8x8_t a_zero)
+{
+	// c*a is at most 0xFE01, so 16-bit math won't overflow.
+	uint16x8_t t = vmull_u8(c, a);
+	t = vsraq_n_u16(t, t, 8);
+	return vbsl_u8(a_zero, c, vrshrn_n_u16(t, 8));
+}
+
+/**
+ * Premultiply an ARGB32 rp_image.
+ * NEON-optimized version.
+ *
+ * Image must be ARGB32.
+ *
+ * @return 0 on success; non-zero on error.
+ */
+int rp_image::premultiply_neon(void)
+{
+	RP_D(const rp_image);
+	rp_image_backend *const backend = d->backend;
+	assert(backend->format == rp_image::Format::ARGB32);
+	if (backend->format != rp_image::Format::ARGB32) {
+		// Incorrect format...
+		return -1;
+	}
+
+	const int width = backend->width;
+	uint32_t *px_dest = static_cast<uint32_t*>(backend->data());
+	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
+	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+		// Process 8 pixels per iteration.
+		// vld4_u8() deinterleaves the pixels into B, G, R, and A.
+		int x = width;
+		for (; x > 7; x -= 8, px_dest += 8) {
+			uint8_t *const dest8 = reinterpret_cast<uint8_t*>(px_dest);
+			uint8x8x4_t px = vld4_u8(dest8);
+			const uint8x8_t a_zero = vceq_u8(px.val[3], vdup_n_u8(0));
+			px.val[0] = premultiply_channel_neon(px.val[0], px.val[3], a_zero);
+			px.val[1] = premultiply_channel_neon(px.val[1], px.val[3], a_zero);
+			px.val[2] = premultiply_channel_neon(px.val[2], px.val[3], a_zero);
+			vst4_u8(dest8, px);
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, px_dest++) {
+			*px_dest = premultiply_pixel(*px_dest);
+		}
+	}
+	return 0;
+}
+
+}
@@ -1,6 +1,6 @@
 /***************************************************************************
  * ROM Properties Page shell extension. (librptexture)                     *
- * un-premultiply_sse41.cpp: Un-premultiply function.                      *
+ * un-premultiply_sse41.cpp: Un-premultiply and premultiply functions.     *
  * SSE4.1-optimized version.                                               *
  *                                                                         *
  * Copyright (c) 2017-2019 by David Korth.                                 *
@@ -81,4 +81,76 @@ int rp_image::un_premultiply_sse41(void)
 	return 0;
 }
 
+/**
+ * Premultiply the 16-bit channels of two ARGB32 pixels. (SSE2 version)
+ * Based on Qt 5.9.1's qPremultiply(): (c*a + ((c*a) >> 8) + 0x80) >> 8
+ *
+ * NOTE: The alpha channel is also multiplied, so it
+ * must be restored by the caller.
+ *
+ * @param px16 Two ARGB32 pixels, unpacked to 16-bit channels.
+ * @return Premultiplied channels.
+ */
+static FORCEINLINE __m128i premultiply_px16_sse2(__m128i px16)
+{
+	// Broadcast each pixel's alpha value to all of its channels.
+	__m128i alpha = _mm_shufflelo_epi16(px16, _MM_SHUFFLE(3,3,3,3));
+	alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3,3,3,3));
+
+	// c*a is at most 0xFE01, so 16-bit math won't overflow.
+	__m128i t = _mm_mullo_epi16(px16, alpha);
+	t = _mm_add_epi16(t, _mm_srli_epi16(t, 8));
+	t = _mm_add_epi16(t, _mm_set1_epi16(0x80));
+	return _mm_srli_epi16(t, 8);
+}
+
+/**
+ * Premultiply an ARGB32 rp_image.
+ * SSE4.1-optimized version.
+ *
+ * Image must be ARGB32.
+ *
+ * @return 0 on success; non-zero on error.
+ */
+int rp_image::premultiply_sse41(void)
+{
+	RP_D(const rp_image);
+	rp_image_backend *const backend = d->backend;
+	assert(backend->format == rp_image::Format::ARGB32);
+	if (backend->format != rp_image::Format::ARGB32) {
+		// Incorrect format...
+		return -1;
+	}
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alpha_mask = _mm_set1_epi32(0xFF000000);
+
+	const int width = backend->width;
+	uint32_t *px_dest = static_cast<uint32_t*>(backend->data());
+	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
+	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+		// Process 4 pixels per iteration.
+		int x = width;
+		for (; x > 3; x -= 4, px_dest += 4) {
+			__m128i *const xmm_dest = reinterpret_cast<__m128i*>(px_dest);
+			const __m128i px = _mm_loadu_si128(xmm_dest);
+			const __m128i res = _mm_packus_epi16(
+				premultiply_px16_sse2(_mm_unpacklo_epi8(px, zero)),
+				premultiply_px16_sse2(_mm_unpackhi_epi8(px, zero)));
+
+			// Keep the original alpha channel, and keep the original
+			// color channels if alpha is 0. (Same as the C++ version.)
+			const __m128i alpha = _mm_and_si128(px, alpha_mask);
+			const __m128i keep = _mm_or_si128(alpha_mask, _mm_cmpeq_epi32(alpha, zero));
+			_mm_storeu_si128(xmm_dest, _mm_blendv_epi8(res, px, keep));
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, px_dest++) {
+			*px_dest = premultiply_pixel(*px_dest);
+		}
+	}
+	return 0;
+}
+
 }
@@ -0,0 +1,763 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture/tests)               *
+ * ImageDecoderBenchmark.cpp: ImageDecoder micro-benchmarks.               *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * Each decoder is benchmarked with every SIMD variant that was
+ * compiled in and is supported by the CPU. Results are reported
+ * in MPixels/s and, on x86, in TSC cycles per pixel.
+ *
+ * Tests named *benchmark* are excluded when running from ctest.
+ * Run this program directly to get the numbers:
+ * - ImageDecoderBenchmark --gtest_filter=*Synthetic_benchmark*
+ * - ImageDecoderBenchmark --gtest_filter=*RealTexture_benchmark*
+ *
+ * Real textures are loaded from ImageDecoder_data/, which is
+ * copied to the binary directory by the libromdata tests.
+ * They're skipped if the data directory isn't available.
+ */
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+#include "common.h"
+#include "librptexture/config.librptexture.h"
+
+// zlib
+#include <zlib.h>
+
+// librpcpu
+#include "librpcpu/byteswap.h"
+#include "librpcpu/cpu_dispatch.h"
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+#include "librptexture/decoder/ImageDecoder.hpp"
+
+// C includes.
+#include <stdint.h>
+#include <stdlib.h>
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# ifdef _MSC_VER
+#  include <intrin.h>
+# else /* !_MSC_VER */
+#  include <x86intrin.h>
+# endif /* _MSC_VER */
+# define BENCHMARK_HAS_RDTSC 1
+#endif
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace LibRpTexture { namespace Tests {
+
+/**
+ * Decode function.
+ * @param width Image width.
+ * @param height Image height.
+ * @param buf Image buffer.
+ * @param size Size of buf.
+ * @return rp_image, or nullptr on error.
+ */
+typedef rp_image* (*DecodeFn)(int width, int height, const uint8_t *buf, int size);
+
+/**
+ * Decoder variant.
+ */
+struct DecoderVariant {
+	const char *decoder;		// Decoder name, e.g. "S3TC/DXT1"
+	const char *variant;		// Variant name, e.g. "sse41"
+	int (*isSupported)(void);	// CPU check (nullptr if always supported)
+	DecodeFn decode;
+};
+
+/** Wrappers for the decoders. **/
+
+// Size of the palette at the end of the buffer.
+// This must be large enough for Dreamcast VQ. (1024 entries)
+static const int PAL_BYTES = 1024*2;
+
+// NOTE: Palettized decoders use the last PAL_BYTES of the buffer
+// as the palette, so the image data is size - PAL_BYTES.
+#define PAL_PTR16(buf, size)	reinterpret_cast<const uint16_t*>((buf) + (size) - PAL_BYTES)
+
+using namespace LibRpTexture::ImageDecoder;
+
+// Linear 16-bit (RGB565)
+#define LINEAR16_FN(suffix) \
+static rp_image *dec_Linear16_##suffix(int w, int h, const uint8_t *buf, int size) { \
+	return fromLinear16_##suffix(PXF_RGB565, w, h, reinterpret_cast<const uint16_t*>(buf), size); \
+}
+LINEAR16_FN(cpp)
+LINEAR16_FN(lut)
+#ifdef IMAGEDECODER_HAS_SSE2
+LINEAR16_FN(sse2)
+#endif /* IMAGEDECODER_HAS_SSE2 */
+#ifdef IMAGEDECODER_HAS_AVX2
+LINEAR16_FN(avx2)
+#endif /* IMAGEDECODER_HAS_AVX2 */
+
+// Linear 24-bit (RGB888)
+#define LINEAR24_FN(suffix) \
+static rp_image *dec_Linear24_##suffix(int w, int h, const uint8_t *buf, int size) { \
+	return fromLinear24_##suffix(PXF_RGB888, w, h, buf, size); \
+}
+LINEAR24_FN(cpp)
+#ifdef IMAGEDECODER_HAS_SSSE3
+LINEAR24_FN(ssse3)
+#endif /* IMAGEDECODER_HAS_SSSE3 */
+#ifdef IMAGEDECODER_HAS_AVX2
+LINEAR24_FN(avx2)
+#endif /* IMAGEDECODER_HAS_AVX2 */
+#ifdef IMAGEDECODER_HAS_NEON
+LINEAR24_FN(neon)
+#endif /* IMAGEDECODER_HAS_NEON */
+
+// Linear 32-bit (ARGB8888)
+#define LINEAR32_FN(suffix) \
+static rp_image *dec_Linear32_##suffix(int w, int h, const uint8_t *buf, int size) { \
+	return fromLinear32_##suffix(PXF_ARGB8888, w, h, reinterpret_cast<const uint32_t*>(buf), size); \
+}
+LINEAR32_FN(cpp)
+#ifdef IMAGEDECODER_HAS_SSSE3
+LINEAR32_FN(ssse3)
+#endif /* IMAGEDECODER_HAS_SSSE3 */
+#ifdef IMAGEDECODER_HAS_AVX2
+LINEAR32_FN(avx2)
+#endif /* IMAGEDECODER_HAS_AVX2 */
+#ifdef IMAGEDECODER_HAS_NEON
+LINEAR32_FN(neon)
+#endif /* IMAGEDECODER_HAS_NEON */
+
+// Linear 8-bit and palettized
+static rp_image *dec_Linear8(int w, int h, const uint8_t *buf, int size) {
+	return fromLinear8(PXF_L8, w, h, buf, size);
+}
+static rp_image *dec_LinearCI4(int w, int h, const uint8_t *buf, int size) {
+	return fromLinearCI4(PXF_RGB565, true, w, h, buf, size - PAL_BYTES, PAL_PTR16(buf, size), 16*2);
+}
+static rp_image *dec_LinearCI8(int w, int h, const uint8_t *buf, int size) {
+	return fromLinearCI8(PXF_RGB565, w, h, buf, size - PAL_BYTES, PAL_PTR16(buf, size), 256*2);
+}
+static rp_image *dec_LinearMono(int w, int h, const uint8_t *buf, int size) {
+	return fromLinearMono(w, h, buf, size);
+}
+
+// GameCube
+#define GCN16_FN(suffix) \
+static rp_image *dec_Gcn16_##suffix(int w, int h, const uint8_t *buf, int size) { \
+	return fromGcn16_##suffix(PXF_RGB5A3, w, h, reinterpret_cast<const uint16_t*>(buf), size); \
+}
+GCN16_FN(cpp)
+#ifdef IMAGEDECODER_HAS_SSE2
+GCN16_FN(sse2)
+#endif /* IMAGEDECODER_HAS_SSE2 */
+static rp_image *dec_GcnCI8(int w, int h, const uint8_t *buf, int size) {
+	return fromGcnCI8(w, h, buf, size - PAL_BYTES, PAL_PTR16(buf, size), 256*2);
+}
+static rp_image *dec_GcnI8(int w, int h, const uint8_t *buf, int size) {
+	return fromGcnI8(w, h, buf, size);
+}
+static rp_image *dec_DXT1_GCN(int w, int h, const uint8_t *buf, int size) {
+	return fromDXT1_GCN(w, h, buf, size);
+}
+
+// Nintendo DS
+static rp_image *dec_NDS_CI4(int w, int h, const uint8_t *buf, int size) {
+	return fromNDS_CI4(w, h, buf, size - PAL_BYTES, PAL_PTR16(buf, size), 16*2);
+}
+
+// Nintendo 3DS
+#define N3DS_FN(suffix) \
+static rp_image *dec_N3DS_RGB565_##suffix(int w, int h, const uint8_t *buf, int size) { \
+	return fromN3DSTiledRGB565_##suffix(w, h, reinterpret_cast<const uint16_t*>(buf), size); \
+} \
+static rp_image *dec_N3DS_RGB565_A4_##suffix(int w, int h, const uint8_t *buf, int size) { \
+	/* A4 data follows the RGB565 data. */ \
+	const int img_siz = w * h * 2; \
+	return fromN3DSTiledRGB565_A4_##suffix(w, h, \
+		reinterpret_cast<const uint16_t*>(buf), img_siz, \
+		buf + img_siz, size - img_siz); \
+}
+N3DS_FN(cpp)
+#ifdef IMAGEDECODER_HAS_SSE2
+N3DS_FN(sse2)
+#endif /* IMAGEDECODER_HAS_SSE2 */
+
+// Dreamcast
+static rp_image *dec_DC_Twiddled16(int w, int h, const uint8_t *buf, int size) {
+	return fromDreamcastSquareTwiddled16(PXF_RGB565, w, h, reinterpret_cast<const uint16_t*>(buf), size);
+}
+static rp_image *dec_DC_VQ16(int w, int h, const uint8_t *buf, int size) {
+	return fromDreamcastVQ16(PXF_RGB565, false, false, w, h,
+		buf, size - PAL_BYTES, PAL_PTR16(buf, size), 1024*2);
+}
+
+// S3TC
+#define S3TC_FN(name, suffix) \
+static rp_image *dec_##name##_##suffix(int w, int h, const uint8_t *buf, int size) { \
+	return from##name##_##suffix(w, h, buf, size); \
+}
+#ifdef IMAGEDECODER_HAS_SSE41
+# define S3TC_FNS(name) S3TC_FN(name, cpp) S3TC_FN(name, sse41)
+#else /* !IMAGEDECODER_HAS_SSE41 */
+# define S3TC_FNS(name) S3TC_FN(name, cpp)
+#endif /* IMAGEDECODER_HAS_SSE41 */
+S3TC_FNS(DXT1)
+S3TC_FNS(DXT1_A1)
+S3TC_FNS(DXT3)
+S3TC_FNS(DXT5)
+S3TC_FNS(BC4)
+S3TC_FNS(BC5)
+static rp_image *dec_DXT2(int w, int h, const uint8_t *buf, int size) {
+	return fromDXT2(w, h, buf, size);
+}
+static rp_image *dec_DXT4(int w, int h, const uint8_t *buf, int size) {
+	return fromDXT4(w, h, buf, size);
+}
+
+// BC7, ETC, PVRTC
+#define PLAIN_FN(name) \
+static rp_image *dec_##name(int w, int h, const uint8_t *buf, int size) { \
+	return from##name(w, h, buf, size); \
+}
+PLAIN_FN(BC7)
+PLAIN_FN(ETC1)
+PLAIN_FN(ETC2_RGB)
+PLAIN_FN(ETC2_RGBA)
+PLAIN_FN(ETC2_RGB_A1)
+#ifdef ENABLE_PVRTC
+static rp_image *dec_PVRTC_4bpp(int w, int h, const uint8_t *buf, int size) {
+	return fromPVRTC(w, h, buf, size, PVRTC_4BPP | PVRTC_ALPHA_YES);
+}
+static rp_image *dec_PVRTC_2bpp(int w, int h, const uint8_t *buf, int size) {
+	return fromPVRTC(w, h, buf, size, PVRTC_2BPP | PVRTC_ALPHA_YES);
+}
+static rp_image *dec_PVRTCII_4bpp(int w, int h, const uint8_t *buf, int size) {
+	return fromPVRTCII(w, h, buf, size, PVRTC_4BPP);
+}
+static rp_image *dec_PVRTCII_2bpp(int w, int h, const uint8_t *buf, int size) {
+	return fromPVRTCII(w, h, buf, size, PVRTC_2BPP);
+}
+#endif /* ENABLE_PVRTC */
+
+/**
+ * All decoder variants.
+ * The "cpp" variant must be first for each decoder, since
+ * the other variants are checked against it.
+ */
+static const DecoderVariant decoderVariants[] = {
+	// Linear
+	{"Linear/RGB565", "cpp", nullptr, dec_Linear16_cpp},
+	{"Linear/RGB565", "lut", nullptr, dec_Linear16_lut},
+#ifdef IMAGEDECODER_HAS_SSE2
+	{"Linear/RGB565", "sse2", RP_CPU_HasSSE2, dec_Linear16_sse2},
+#endif /* IMAGEDECODER_HAS_SSE2 */
+#ifdef IMAGEDECODER_HAS_AVX2
+	{"Linear/RGB565", "avx2", RP_CPU_HasAVX2, dec_Linear16_avx2},
+#endif /* IMAGEDECODER_HAS_AVX2 */
+
+	{"Linear/RGB888", "cpp", nullptr, dec_Linear24_cpp},
+#ifdef IMAGEDECODER_HAS_SSSE3
+	{"Linear/RGB888", "ssse3", RP_CPU_HasSSSE3, dec_Linear24_ssse3},
+#endif /* IMAGEDECODER_HAS_SSSE3 */
+#ifdef IMAGEDECODER_HAS_AVX2
+	{"Linear/RGB888", "avx2", RP_CPU_HasAVX2, dec_Linear24_avx2},
+#endif /* IMAGEDECODER_HAS_AVX2 */
+#ifdef IMAGEDECODER_HAS_NEON
+	{"Linear/RGB888", "neon", nullptr, dec_Linear24_neon},
+#endif /* IMAGEDECODER_HAS_NEON */
+
+	{"Linear/ARGB8888", "cpp", nullptr, dec_Linear32_cpp},
+#ifdef IMAGEDECODER_HAS_SSSE3
+	{"Linear/ARGB8888", "ssse3", RP_CPU_HasSSSE3, dec_Linear32_ssse3},
+#endif /* IMAGEDECODER_HAS_SSSE3 */
+#ifdef IMAGEDECODER_HAS_AVX2
+	{"Linear/ARGB8888", "avx2", RP_CPU_HasAVX2, dec_Linear32_avx2},
+#endif /* IMAGEDECODER_HAS_AVX2 */
+#ifdef IMAGEDECODER_HAS_NEON
+	{"Linear/ARGB8888", "neon", nullptr, dec_Linear32_neon},
+#endif /* IMAGEDECODER_HAS_NEON */
+
+	{"Linear/L8", "cpp", nullptr, dec_Linear8},
+	{"Linear/CI4", "cpp", nullptr, dec_LinearCI4},
+	{"Linear/CI8", "cpp", nullptr, dec_LinearCI8},
+	{"Linear/Mono", "cpp", nullptr, dec_LinearMono},
+
+	// GameCube
+	{"GCN/RGB5A3", "cpp", nullptr, dec_Gcn16_cpp},
+#ifdef IMAGEDECODER_HAS_SSE2
+	{"GCN/RGB5A3", "sse2", RP_CPU_HasSSE2, dec_Gcn16_sse2},
+#endif /* IMAGEDECODER_HAS_SSE2 */
+	{"GCN/CI8", "cpp", nullptr, dec_GcnCI8},
+	{"GCN/I8", "cpp", nullptr, dec_GcnI8},
+	{"GCN/DXT1", "cpp", nullptr, dec_DXT1_GCN},
+
+	// Nintendo DS
+	{"NDS/CI4", "cpp", nullptr, dec_NDS_CI4},
+
+	// Nintendo 3DS
+	{"N3DS/RGB565", "cpp", nullptr, dec_N3DS_RGB565_cpp},
+#ifdef IMAGEDECODER_HAS_SSE2
+	{"N3DS/RGB565", "sse2", RP_CPU_HasSSE2, dec_N3DS_RGB565_sse2},
+#endif /* IMAGEDECODER_HAS_SSE2 */
+	{"N3DS/RGB565_A4", "cpp", nullptr, dec_N3DS_RGB565_A4_cpp},
+#ifdef IMAGEDECODER_HAS_SSE2
+	{"N3DS/RGB565_A4", "sse2", RP_CPU_HasSSE2, dec_N3DS_RGB565_A4_sse2},
+#endif /* IMAGEDECODER_HAS_SSE2 */
+
+	// Dreamcast
+	{"DC/Twiddled16", "cpp", nullptr, dec_DC_Twiddled16},
+	{"DC/VQ16", "cpp", nullptr, dec_DC_VQ16},
+
+	// S3TC
+#ifdef IMAGEDECODER_HAS_SSE41
+#  define S3TC_VARIANTS(decoder, name) \
+	{decoder, "cpp", nullptr, dec_##name##_cpp}, \
+	{decoder, "sse41", RP_CPU_HasSSE41, dec_##name##_sse41},
+#else /* !IMAGEDECODER_HAS_SSE41 */
+#  define S3TC_VARIANTS(decoder, name) \
+	{decoder, "cpp", nullptr, dec_##name##_cpp},
+#endif /* IMAGEDECODER_HAS_SSE41 */
+	S3TC_VARIANTS("S3TC/DXT1", DXT1)
+	S3TC_VARIANTS("S3TC/DXT1_A1", DXT1_A1)
+	{"S3TC/DXT2", "cpp", nullptr, dec_DXT2},
+	S3TC_VARIANTS("S3TC/DXT3", DXT3)
+	{"S3TC/DXT4", "cpp", nullptr, dec_DXT4},
+	S3TC_VARIANTS("S3TC/DXT5", DXT5)
+	S3TC_VARIANTS("S3TC/BC4", BC4)
+	S3TC_VARIANTS("S3TC/BC5", BC5)
+
+	// BC7
+	{"BC7", "cpp", nullptr, dec_BC7},
+
+	// ETC
+	{"ETC1", "cpp", nullptr, dec_ETC1},
+	{"ETC2/RGB", "cpp", nullptr, dec_ETC2_RGB},
+	{"ETC2/RGBA", "cpp", nullptr, dec_ETC2_RGBA},
+	{"ETC2/RGB_A1", "cpp", nullptr, dec_ETC2_RGB_A1},
+
+#ifdef ENABLE_PVRTC
+	// PVRTC
+	{"PVRTC/4bpp", "cpp", nullptr, dec_PVRTC_4bpp},
+	{"PVRTC/2bpp", "cpp", nullptr, dec_PVRTC_2bpp},
+	{"PVRTC-II/4bpp", "cpp", nullptr, dec_PVRTCII_4bpp},
+	{"PVRTC-II/2bpp", "cpp", nullptr, dec_PVRTCII_2bpp},
+#endif /* ENABLE_PVRTC */
+};
+
+/**
+ * Benchmark result.
+ */
+struct BenchResult {
+	unsigned int iterations;
+	double seconds;
+	double cycles;	// TSC cycles (0 if not available)
+};
+
+class ImageDecoderBenchmark : public ::testing::Test
+{
+	protected:
+		ImageDecoderBenchmark()
+			: m_buf(new uint8_t[BUF_SIZ])
+		{
+			// Initialize the buffer with pseudo-random data.
+			// xorshift32 with a fixed seed, so runs are comparable.
+			uint32_t x = 0x12345678;
+			for (int i = 0; i < BUF_SIZ; i++) {
+				x ^= x << 13;
+				x ^= x >> 17;
+				x ^= x << 5;
+				m_buf[i] = static_cast<uint8_t>(x);
+			}
+		}
+
+		/**
+		 * Is a variant supported on this CPU?
+		 * @param var Decoder variant.
+		 * @return True if supported; false if not.
+		 */
+		static inline bool isSupported(const DecoderVariant &var)
+		{
+			return !var.isSupported || var.isSupported();
+		}
+
+		/**
+		 * Benchmark a decoder variant.
+		 * The decoder is run for at least MIN_SECONDS and MIN_ITERATIONS.
+		 * @param decode	[in] Decode function.
+		 * @param width		[in] Image width.
+		 * @param height	[in] Image height.
+		 * @param buf		[in] Image buffer.
+		 * @param size		[in] Size of buf.
+		 * @param pResult	[out] Result.
+		 * @return True on success; false if the decoder failed.
+		 */
+		static bool benchmark(DecodeFn decode, int width, int height,
+			const uint8_t *buf, int size, BenchResult *pResult);
+
+		/**
+		 * Print a benchmark result.
+		 * @param decoder Decoder name.
+		 * @param variant Variant name.
+		 * @param source Source name.
+		 * @param width Image width.
+		 * @param height Image height.
+		 * @param result Benchmark result.
+		 */
+		static void printResult(const char *decoder, const char *variant,
+			const char *source, int width, int height,
+			const BenchResult &result);
+
+		/**
+		 * Compare two images.
+		 * @param decoder Decoder name.
+		 * @param variant Variant name.
+		 * @param expected Expected image.
+		 * @param actual Actual image.
+		 */
+		static void compareImages(const char *decoder, const char *variant,
+			const rp_image *expected, const rp_image *actual);
+
+	public:
+		// Minimum benchmark time and iterations.
+		static constexpr double MIN_SECONDS = 0.25;
+		static const unsigned int MIN_ITERATIONS = 3;
+
+		// Synthetic image size.
+		static const int WIDTH = 512;
+		static const int HEIGHT = 512;
+		// Buffer size: Large enough for 32-bit images plus the palette.
+		static const int BUF_SIZ = (WIDTH * HEIGHT * 4) + PAL_BYTES;
+
+		// Synthetic data.
+		unique_ptr<uint8_t[]> m_buf;
+};
+
+/**
+ * Benchmark a decoder variant.
+ * The decoder is run for at least MIN_SECONDS and MIN_ITERATIONS.
+ * @param decode	[in] Decode function.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param buf		[in] Image buffer.
+ * @param size		[in] Size of buf.
+ * @param pResult	[out] Result.
+ * @return True on success; false if the decoder failed.
+ */
+bool ImageDecoderBenchmark::benchmark(DecodeFn decode, int width, int height,
+	const uint8_t *buf, int size, BenchResult *pResult)
+{
+	typedef std::chrono::steady_clock clock;
+
+	// Warm up the caches and the decoder's lookup tables.
+	rp_image *img = decode(width, height, buf, size);
+	if (!img) {
+		return false;
+	}
+	img->unref();
+
+	unsigned int iterations = 0;
+	double seconds = 0;
+#ifdef BENCHMARK_HAS_RDTSC
+	const uint64_t tsc_start = __rdtsc();
+#endif /* BENCHMARK_HAS_RDTSC */
+	const clock::time_point start = clock::now();
+	do {
+		img = decode(width, height, buf, size);
+		if (!img) {
+			return false;
+		}
+		img->unref();
+		iterations++;
+		seconds = std::chrono::duration<double>(clock::now() - start).count();
+	} while (seconds < MIN_SECONDS || iterations < MIN_ITERATIONS);
+
+	pResult->iterations = iterations;
+	pResult->seconds = seconds;
+#ifdef BENCHMARK_HAS_RDTSC
+	pResult->cycles = static_cast<double>(__rdtsc() - tsc_start);
+#else /* !BENCHMARK_HAS_RDTSC */
+	pResult->cycles = 0;
+#endif /* BENCHMARK_HAS_RDTSC */
+	return true;
+}
+
+/**
+ * Print a benchmark result.
+ * @param decoder Decoder name.
+ * @param variant Variant name.
+ * @param source Source name.
+ * @param width Image width.
+ * @param height Image height.
+ * @param result Benchmark result.
+ */
+void ImageDecoderBenchmark::printResult(const char *decoder, const char *variant,
+	const char *source, int width, int height,
+	const BenchResult &result)
+{
+	const double pixels = static_cast<double>(width) * height * result.iterations;
+	const double mpix_s = (pixels / 1000000.0) / result.seconds;
+
+	char cpp_buf[32];
+	if (result.cycles > 0) {
+		snprintf(cpp_buf, sizeof(cpp_buf), "%8.2f", result.cycles / pixels);
+	} else {
+		strcpy(cpp_buf, "     n/a");
+	}
+
+	printf("%-18s %-6s %-28s %5dx%-5d %9.1f MPix/s %s cyc/px\n",
+		decoder, variant, source, width, height, mpix_s, cpp_buf);
+	fflush(stdout);
+}
+
+/**
+ * Compare two images.
+ * @param decoder Decoder name.
+ * @param variant Variant name.
+ * @param expected Expected image.
+ * @param actual Actual image.
+ */
+void ImageDecoderBenchmark::compareImages(const char *decoder, const char *variant,
+	const rp_image *expected, const rp_image *actual)
+{
+	ASSERT_EQ(expected->width(), actual->width()) << decoder << ' ' << variant;
+	ASSERT_EQ(expected->height(), actual->height()) << decoder << ' ' << variant;
+	ASSERT_EQ(expected->format(), actual->format()) << decoder << ' ' << variant;
+
+	const int width = expected->width();
+	const int height = expected->height();
+	const size_t row_bytes = (expected->format() == rp_image::Format::ARGB32)
+		? static_cast<size_t>(width) * 4
+		: static_cast<size_t>(width);
+	for (int y = 0; y < height; y++) {
+		const uint8_t *const pExp = static_cast<const uint8_t*>(expected->scanLine(y));
+		const uint8_t *const pAct = static_cast<const uint8_t*>(actual->scanLine(y));
+		if (memcmp(pExp, pAct, row_bytes) != 0) {
+			// Find the first mismatched byte for the error message.
+			size_t x = 0;
+			while (x < row_bytes && pExp[x] == pAct[x]) {
+				x++;
+			}
+			FAIL() << decoder << ' ' << variant << ": mismatch at row " << y
+				<< ", byte " << x;
+		}
+	}
+}
+
+/**
+ * Verify that all SIMD variants match the standard C++ variant.
+ */
+TEST_F(ImageDecoderBenchmark, SimdVariantsMatchCpp)
+{
+	unique_ptr<rp_image, void(*)(rp_image*)> img_cpp(nullptr,
+		[](rp_image *img) { UNREF(img); });
+	const char *cur_decoder = nullptr;
+
+	for (const auto &var : decoderVariants) {
+		if (!cur_decoder || strcmp(cur_decoder, var.decoder) != 0) {
+			// New decoder. The "cpp" variant is first.
+			ASSERT_STREQ("cpp", var.variant) << var.decoder;
+			cur_decoder = var.decoder;
+			img_cpp.reset(var.decode(WIDTH, HEIGHT, m_buf.get(), BUF_SIZ));
+			ASSERT_TRUE(img_cpp != nullptr) << var.decoder << " cpp failed";
+			continue;
+		}
+
+		if (!isSupported(var)) {
+			printf("Skipping %s %s: not supported by this CPU.\n",
+				var.decoder, var.variant);
+			continue;
+		}
+
+		rp_image *const img = var.decode(WIDTH, HEIGHT, m_buf.get(), BUF_SIZ);
+		ASSERT_TRUE(img != nullptr) << var.decoder << ' ' << var.variant << " failed";
+		compareImages(var.decoder, var.variant, img_cpp.get(), img);
+		img->unref();
+		if (HasFatalFailure()) {
+			return;
+		}
+	}
+}
+
+/**
+ * Benchmark all decoder variants using synthetic data.
+ */
+TEST_F(ImageDecoderBenchmark, Synthetic_benchmark)
+{
+	char source[32];
+	snprintf(source, sizeof(source), "synthetic (xorshift)");
+
+	for (const auto &var : decoderVariants) {
+		if (!isSupported(var)) {
+			continue;
+		}
+
+		BenchResult result;
+		EXPECT_TRUE(benchmark(var.decode, WIDTH, HEIGHT, m_buf.get(), BUF_SIZ, &result))
+			<< var.decoder << ' ' << var.variant << " failed";
+		if (!HasFailure()) {
+			printResult(var.decoder, var.variant, source, WIDTH, HEIGHT, result);
+		}
+	}
+}
+
+/** Real textures **/
+
+/**
+ * Real texture file.
+ */
+struct RealTexture {
+	const char *filename;	// Relative to ImageDecoder_data/
+	const char *decoder;	// Decoder name in decoderVariants[]
+};
+
+static const RealTexture realTextures[] = {
+	{"S3TC/dxt1-rgb.dds.gz",		"S3TC/DXT1"},
+	{"S3TC/dxt3-argb.dds.gz",		"S3TC/DXT3"},
+	{"S3TC/dxt5-argb.dds.gz",		"S3TC/DXT5"},
+	{"S3TC/bc4.dds.gz",			"S3TC/BC4"},
+	{"S3TC/bc5.dds.gz",			"S3TC/BC5"},
+	{"BC7/w5_grass200_abd_a.dds.gz",	"BC7"},
+	{"BC7/w5_rock805_nrm.dds.gz",		"BC7"},
+	{"KTX/etc1.ktx.gz",			"ETC1"},
+	{"KTX/etc2-rgb.ktx.gz",			"ETC2/RGB"},
+	{"KTX/etc2-rgba1.ktx.gz",		"ETC2/RGB_A1"},
+	{"KTX/etc2-rgba8.ktx.gz",		"ETC2/RGBA"},
+};
+
+/**
+ * Load a gzipped file.
+ * @param filename	[in] Filename.
+ * @param data		[out] File data.
+ * @return True on success; false on error.
+ */
+static bool loadGzFile(const char *filename, vector<uint8_t> &data)
+{
+	gzFile gz = gzopen(filename, "rb");
+	if (!gz) {
+		return false;
+	}
+
+	data.clear();
+	uint8_t buf[65536];
+	int ret;
+	while ((ret = gzread(gz, buf, sizeof(buf))) > 0) {
+		data.insert(data.end(), buf, buf + ret);
+	}
+	gzclose(gz);
+	return (ret == 0);
+}
+
+/**
+ * Get the image data from a DDS or KTX texture.
+ * Only the first mipmap is used.
+ * @param data		[in] File data.
+ * @param pWidth	[out] Image width.
+ * @param pHeight	[out] Image height.
+ * @param pOffset	[out] Image data offset.
+ * @return True on success; false on error.
+ */
+static bool getTextureImage(const vector<uint8_t> &data, int *pWidth, int *pHeight, size_t *pOffset)
+{
+	if (data.size() >= 128 && !memcmp(data.data(), "DDS ", 4)) {
+		// DDS: 4-byte magic, then a 124-byte DDS_HEADER.
+		uint32_t height, width;
+		memcpy(&height, &data[12], sizeof(height));
+		memcpy(&width, &data[16], sizeof(width));
+		*pWidth = static_cast<int>(le32_to_cpu(width));
+		*pHeight = static_cast<int>(le32_to_cpu(height));
+		// If the FourCC is "DX10", a 20-byte DDS_HEADER_DXT10 follows.
+		*pOffset = (!memcmp(&data[84], "DX10", 4)) ? 128+20 : 128;
+	} else if (data.size() >= 68 && !memcmp(&data[1], "KTX 11", 6)) {
+		// KTX: 64-byte header, key/value data, then imageSize.
+		// NOTE: Assuming little-endian KTX files.
+		uint32_t width, height, kvd;
+		memcpy(&width, &data[36], sizeof(width));
+		memcpy(&height, &data[40], sizeof(height));
+		memcpy(&kvd, &data[60], sizeof(kvd));
+		*pWidth = static_cast<int>(le32_to_cpu(width));
+		*pHeight = static_cast<int>(le32_to_cpu(height));
+		*pOffset = 64 + le32_to_cpu(kvd) + 4;
+	} else {
+		return false;
+	}
+
+	return (*pWidth > 0 && *pHeight > 0 && *pOffset < data.size());
+}
+
+/**
+ * Benchmark decoder variants using real textures.
+ */
+TEST_F(ImageDecoderBenchmark, RealTexture_benchmark)
+{
+	unsigned int loaded = 0;
+	vector<uint8_t> data;
+
+	for (const auto &tex : realTextures) {
+		const string path = string("ImageDecoder_data/") + tex.filename;
+		if (!loadGzFile(path.c_str(), data)) {
+			continue;
+		}
+
+		int width = 0, height = 0;
+		size_t offset = 0;
+		if (!getTextureImage(data, &width, &height, &offset)) {
+			ADD_FAILURE() << "Unable to parse texture: " << path;
+			continue;
+		}
+		loaded++;
+
+		const uint8_t *const buf = &data[offset];
+		const int size = static_cast<int>(data.size() - offset);
+		for (const auto &var : decoderVariants) {
+			if (strcmp(var.decoder, tex.decoder) != 0 || !isSupported(var)) {
+				continue;
+			}
+
+			BenchResult result;
+			if (!benchmark(var.decode, width, height, buf, size, &result)) {
+				ADD_FAILURE() << var.decoder << ' ' << var.variant << " failed: " << path;
+				continue;
+			}
+			printResult(var.decoder, var.variant, tex.filename, width, height, result);
+		}
+	}
+
+	if (loaded == 0) {
+		GTEST_SKIP() << "ImageDecoder_data/ not found; skipping real texture benchmarks.";
+	}
+}
+
+} }
+
+/**
+ * Test suite main function.
+ * Called by gtest_init.cpp.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpTexture test suite: ImageDecoder micro-benchmarks.\n\n");
+	fflush(nullptr);
+
+	// Benchmark the kernels on a single thread.
+	LibRpTexture::ImageDecoder::setDecodeThreadCount(1);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -25,6 +25,7 @@
 #include <cstring>
 
 // C++ includes.
+#include <chrono>
 #include <memory>
 #include <string>
 using std::unique_ptr;
@@ -101,6 +102,15 @@ class ImageDecoderLinearTest : public ::testing::TestWithParam<ImageDecoderLinea
 		// Number of iterations for benchmarks.
 		static const unsigned int BENCHMARK_ITERATIONS = 100000;
 
+		/**
+		 * Print the benchmark result in MPixels/s.
+		 * @param tier	[in] Optimization tier, e.g. "SSE2".
+		 * @param pxf	[in] Pixel format.
+		 * @param start	[in] Benchmark start time.
+		 */
+		static void printBenchmarkResult(const char *tier, ImageDecoder::PixelFormat pxf,
+			std::chrono::steady_clock::time_point start);
+
 	public:
 		// Temporary image buffer.
 		// 128x128 24-bit or 32-bit image data.
@@ -382,6 +392,26 @@ void ImageDecoderLinearTest::Validate_RpImage(
 	}
 }
 
+/**
+ * Print the benchmark result in MPixels/s.
+ * @param tier	[in] Optimization tier, e.g. "SSE2".
+ * @param pxf	[in] Pixel format.
+ * @param start	[in] Benchmark start time.
+ */
+void ImageDecoderLinearTest::printBenchmarkResult(const char *tier, ImageDecoder::PixelFormat pxf,
+	std::chrono::steady_clock::time_point start)
+{
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	if (elapsed.count() <= 0) {
+		// Too fast to measure.
+		return;
+	}
+
+	// All benchmarks use 128x128 images.
+	const double mpixels = (128.0 * 128.0 * BENCHMARK_ITERATIONS) / 1000000.0;
+	printf("%s: %s: %.1f MPixels/s\n", tier, pxfToString(pxf), mpixels / elapsed.count());
+}
+
 /**
  * Test the ImageDecoder::fromLinear*() functions. (Standard version)
  */
@@ -433,6 +463,7 @@ TEST_P(ImageDecoderLinearTest, fromLinear_cpp_benchmark)
 	const ImageDecoderLinearTest_mode &mode = GetParam();
 
 	// Decode the image.
+	const auto start = std::chrono::steady_clock::now();
 	switch (mode.bpp) {
 		case 24:
 			// 24-bit image.
@@ -468,6 +499,79 @@ TEST_P(ImageDecoderLinearTest, fromLinear_cpp_benchmark)
 			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
 			return;
 	}
+
+	printBenchmarkResult("C++", mode.src_pxf, start);
+}
+
+/**
+ * Test the ImageDecoder::fromLinear16_lut() function. (Lookup table version)
+ */
+TEST_P(ImageDecoderLinearTest, fromLinear_lut_test)
+{
+	// Parameterized test.
+	const ImageDecoderLinearTest_mode &mode = GetParam();
+
+	// Decode the image.
+	switch (mode.bpp) {
+		case 24:
+		case 32:
+			// Not implemented...
+			fprintf(stderr, "*** Lookup table decoding is not implemented for %u-bit color.\n", mode.bpp);
+			return;
+
+		case 15:
+		case 16:
+			// 15/16-bit image.
+			m_img = ImageDecoder::fromLinear16_lut(mode.src_pxf, 128, 128,
+				reinterpret_cast<const uint16_t*>(m_img_buf),
+				static_cast<int>(m_img_buf_len), mode.stride);
+			break;
+
+		default:
+			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
+			return;
+	}
+
+	ASSERT_TRUE(m_img != nullptr);
+
+	// Validate the image.
+	ASSERT_NO_FATAL_FAILURE(Validate_RpImage(m_img, mode.dest_pixel));
+}
+
+/**
+ * Benchmark the ImageDecoder::fromLinear16_lut() function. (Lookup table version)
+ */
+TEST_P(ImageDecoderLinearTest, fromLinear_lut_benchmark)
+{
+	// Parameterized test.
+	const ImageDecoderLinearTest_mode &mode = GetParam();
+
+	// Decode the image.
+	const auto start = std::chrono::steady_clock::now();
+	switch (mode.bpp) {
+		case 24:
+		case 32:
+			// Not implemented...
+			fprintf(stderr, "*** Lookup table decoding is not implemented for %u-bit color.\n", mode.bpp);
+			return;
+
+		case 15:
+		case 16:
+			// 15/16-bit image.
+			for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+				m_img = ImageDecoder::fromLinear16_lut(mode.src_pxf, 128, 128,
+					reinterpret_cast<const uint16_t*>(m_img_buf),
+					static_cast<int>(m_img_buf_len), mode.stride);
+				UNREF_AND_NULL(m_img);
+			}
+			break;
+
+		default:
+			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
+			return;
+	}
+
+	printBenchmarkResult("LUT", mode.src_pxf, start);
 }
 
 #ifdef IMAGEDECODER_HAS_SSE2
@@ -525,6 +629,7 @@ TEST_P(ImageDecoderLinearTest, fromLinear_sse2_benchmark)
 	const ImageDecoderLinearTest_mode &mode = GetParam();
 
 	// Decode the image.
+	const auto start = std::chrono::steady_clock::now();
 	switch (mode.bpp) {
 		case 24:
 		case 32:
@@ -547,6 +652,8 @@ TEST_P(ImageDecoderLinearTest, fromLinear_sse2_benchmark)
 			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
 			return;
 	}
+
+	printBenchmarkResult("SSE2", mode.src_pxf, start);
 }
 #endif /* IMAGEDECODER_HAS_SSE2 */
 
@@ -610,6 +717,7 @@ TEST_P(ImageDecoderLinearTest, fromLinear_ssse3_benchmark)
 	const ImageDecoderLinearTest_mode &mode = GetParam();
 
 	// Decode the image.
+	const auto start = std::chrono::steady_clock::now();
 	switch (mode.bpp) {
 		case 24:
 			// 24-bit image.
@@ -640,11 +748,203 @@ TEST_P(ImageDecoderLinearTest, fromLinear_ssse3_benchmark)
 			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
 			return;
 	}
+
+	printBenchmarkResult("SSSE3", mode.src_pxf, start);
 }
 #endif /* IMAGEDECODER_HAS_SSSE3 */
 
+#ifdef IMAGEDECODER_HAS_AVX2
+/**
+ * Test the ImageDecoder::fromLinear*() functions. (AVX2-optimized version)
+ */
+TEST_P(ImageDecoderLinearTest, fromLinear_avx2_test)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.\n");
+		return;
+	}
+
+	// Parameterized test.
+	const ImageDecoderLinearTest_mode &mode = GetParam();
+
+	// Decode the image.
+	switch (mode.bpp) {
+		case 24:
+			// 24-bit image.
+			m_img = ImageDecoder::fromLinear24_avx2(mode.src_pxf, 128, 128,
+				m_img_buf, static_cast<int>(m_img_buf_len), mode.stride);
+			break;
+
+		case 32:
+			// 32-bit image.
+			m_img = ImageDecoder::fromLinear32_avx2(mode.src_pxf, 128, 128,
+				reinterpret_cast<const uint32_t*>(m_img_buf),
+				static_cast<int>(m_img_buf_len), mode.stride);
+			break;
+
+		case 15:
+		case 16:
+			// 15/16-bit image.
+			m_img = ImageDecoder::fromLinear16_avx2(mode.src_pxf, 128, 128,
+				reinterpret_cast<const uint16_t*>(m_img_buf),
+				static_cast<int>(m_img_buf_len), mode.stride);
+			break;
+
+		default:
+			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
+			return;
+	}
+
+	ASSERT_TRUE(m_img != nullptr);
+
+	// Validate the image.
+	ASSERT_NO_FATAL_FAILURE(Validate_RpImage(m_img, mode.dest_pixel));
+}
+
+/**
+ * Benchmark the ImageDecoder::fromLinear*() functions. (AVX2-optimized version)
+ */
+TEST_P(ImageDecoderLinearTest, fromLinear_avx2_benchmark)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.\n");
+		return;
+	}
+
+	// Parameterized test.
+	const ImageDecoderLinearTest_mode &mode = GetParam();
+
+	// Decode the image.
+	const auto start = std::chrono::steady_clock::now();
+	switch (mode.bpp) {
+		case 24:
+			// 24-bit image.
+			for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+				m_img = ImageDecoder::fromLinear24_avx2(mode.src_pxf, 128, 128,
+					m_img_buf, static_cast<int>(m_img_buf_len), mode.stride);
+				UNREF_AND_NULL(m_img);
+			}
+			break;
+
+		case 32:
+			// 32-bit image.
+			for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+				m_img = ImageDecoder::fromLinear32_avx2(mode.src_pxf, 128, 128,
+					reinterpret_cast<const uint32_t*>(m_img_buf),
+					static_cast<int>(m_img_buf_len), mode.stride);
+				UNREF_AND_NULL(m_img);
+			}
+			break;
+
+		case 15:
+		case 16:
+			// 15/16-bit image.
+			for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+				m_img = ImageDecoder::fromLinear16_avx2(mode.src_pxf, 128, 128,
+					reinterpret_cast<const uint16_t*>(m_img_buf),
+					static_cast<int>(m_img_buf_len), mode.stride);
+				UNREF_AND_NULL(m_img);
+			}
+			break;
+
+		default:
+			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
+			return;
+	}
+
+	printBenchmarkResult("AVX2", mode.src_pxf, start);
+}
+#endif /* IMAGEDECODER_HAS_AVX2 */
+
+#ifdef IMAGEDECODER_HAS_NEON
+/**
+ * Test the ImageDecoder::fromLinear*() functions. (NEON-optimized version)
+ */
+TEST_P(ImageDecoderLinearTest, fromLinear_neon_test)
+{
+	// Parameterized test.
+	const ImageDecoderLinearTest_mode &mode = GetParam();
+
+	// Decode the image.
+	switch (mode.bpp) {
+		case 24:
+			// 24-bit image.
+			m_img = ImageDecoder::fromLinear24_neon(mode.src_pxf, 128, 128,
+				m_img_buf, static_cast<int>(m_img_buf_len), mode.stride);
+			break;
+
+		case 32:
+			// 32-bit image.
+			m_img = ImageDecoder::fromLinear32_neon(mode.src_pxf, 128, 128,
+				reinterpret_cast<const uint32_t*>(m_img_buf),
+				static_cast<int>(m_img_buf_len), mode.stride);
+			break;
+
+		case 15:
+		case 16:
+			// Not implemented...
+			fprintf(stderr, "*** NEON decoding is not implemented for %u-bit color.\n", mode.bpp);
+			return;
+
+		default:
+			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
+			return;
+	}
+
+	ASSERT_TRUE(m_img != nullptr);
+
+	// Validate the image.
+	ASSERT_NO_FATAL_FAILURE(Validate_RpImage(m_img, mode.dest_pixel));
+}
+
+/**
+ * Benchmark the ImageDecoder::fromLinear*() functions. (NEON-optimized version)
+ */
+TEST_P(ImageDecoderLinearTest, fromLinear_neon_benchmark)
+{
+	// Parameterized test.
+	const ImageDecoderLinearTest_mode &mode = GetParam();
+
+	// Decode the image.
+	const auto start = std::chrono::steady_clock::now();
+	switch (mode.bpp) {
+		case 24:
+			// 24-bit image.
+			for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+				m_img = ImageDecoder::fromLinear24_neon(mode.src_pxf, 128, 128,
+					m_img_buf, static_cast<int>(m_img_buf_len), mode.stride);
+				UNREF_AND_NULL(m_img);
+			}
+			break;
+
+		case 32:
+			// 32-bit image.
+			for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+				m_img = ImageDecoder::fromLinear32_neon(mode.src_pxf, 128, 128,
+					reinterpret_cast<const uint32_t*>(m_img_buf),
+					static_cast<int>(m_img_buf_len), mode.stride);
+				UNREF_AND_NULL(m_img);
+			}
+			break;
+
+		case 15:
+		case 16:
+			// Not implemented...
+			fprintf(stderr, "*** NEON decoding is not implemented for %u-bit color.\n", mode.bpp);
+			return;
+
+		default:
+			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
+			return;
+	}
+
+	printBenchmarkResult("NEON", mode.src_pxf, start);
+}
+#endif /* IMAGEDECODER_HAS_NEON */
+
 // NOTE: Add more instruction sets to the #ifdef if other optimizations are added.
-#if defined(IMAGEDECODER_HAS_SSE2) || defined(IMAGEDECODER_HAS_SSSE3)
+#if defined(IMAGEDECODER_HAS_SSE2) || defined(IMAGEDECODER_HAS_SSSE3) || defined(IMAGEDECODER_HAS_AVX2) || \
+    defined(IMAGEDECODER_HAS_NEON)
 /**
  * Test the ImageDecoder::fromLinear*() dispatch functions.
  */
@@ -696,6 +996,7 @@ TEST_P(ImageDecoderLinearTest, fromLinear_dispatch_benchmark)
 	const ImageDecoderLinearTest_mode &mode = GetParam();
 
 	// Decode the image.
+	const auto start = std::chrono::steady_clock::now();
 	switch (mode.bpp) {
 		case 24:
 			// 24-bit image.
@@ -731,8 +1032,10 @@ TEST_P(ImageDecoderLinearTest, fromLinear_dispatch_benchmark)
 			ASSERT_TRUE(false) << "Invalid bpp: " << mode.bpp;
 			return;
 	}
+
+	printBenchmarkResult("dispatch", mode.src_pxf, start);
 }
-#endif /* IMAGEDECODER_HAS_SSE2 || IMAGEDECODER_HAS_SSSE3 */
+#endif /* IMAGEDECODER_HAS_SSE2 || IMAGEDECODER_HAS_SSSE3 || IMAGEDECODER_HAS_AVX2 || IMAGEDECODER_HAS_NEON */
 
 // Test cases.
 
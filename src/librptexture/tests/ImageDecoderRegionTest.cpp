@@ -0,0 +1,311 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture/tests)               *
+ * ImageDecoderRegionTest.cpp: Test ImageDecoder region decoding.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+#include "common.h"
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+#include "librptexture/decoder/ImageDecoder.hpp"
+
+// C includes.
+#include <stdint.h>
+#include <stdlib.h>
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <memory>
+using std::unique_ptr;
+
+namespace LibRpTexture { namespace Tests {
+
+class ImageDecoderRegionTest : public ::testing::TestWithParam<ImageDecoder::BlockFormat>
+{
+	protected:
+		ImageDecoderRegionTest()
+			: m_buf(new uint8_t[IMG_SIZ])
+		{
+			// Initialize the block data with pseudo-random data.
+			uint32_t seed = 0x12345678;
+			for (int i = 0; i < IMG_SIZ; i++) {
+				seed = (seed * 1103515245U) + 12345U;
+				m_buf[i] = static_cast<uint8_t>(seed >> 16);
+			}
+		}
+
+		/**
+		 * Decode the full image using the standard decoders.
+		 * @param fmt Block format.
+		 * @return Image, or nullptr on error.
+		 */
+		rp_image *decodeFull(ImageDecoder::BlockFormat fmt) const;
+
+		/**
+		 * Compare two ARGB32 images.
+		 * @param a Image A.
+		 * @param b Image B.
+		 */
+		static void compareImages(const rp_image *a, const rp_image *b);
+
+	public:
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 100;
+
+		// Image size. (16 bytes per block for DXT3, DXT5, and BC5)
+		static const int WIDTH = 512;
+		static const int HEIGHT = 448;
+		static const int IMG_SIZ = WIDTH * HEIGHT;
+
+		// Block data.
+		unique_ptr<uint8_t[]> m_buf;
+};
+
+/**
+ * Decode the full image using the standard decoders.
+ * @param fmt Block format.
+ * @return Image, or nullptr on error.
+ */
+rp_image *ImageDecoderRegionTest::decodeFull(ImageDecoder::BlockFormat fmt) const
+{
+	switch (fmt) {
+		case ImageDecoder::BLKF_DXT1:
+			return ImageDecoder::fromDXT1_cpp(WIDTH, HEIGHT, m_buf.get(), IMG_SIZ);
+		case ImageDecoder::BLKF_DXT1_A1:
+			return ImageDecoder::fromDXT1_A1_cpp(WIDTH, HEIGHT, m_buf.get(), IMG_SIZ);
+		case ImageDecoder::BLKF_DXT3:
+			return ImageDecoder::fromDXT3_cpp(WIDTH, HEIGHT, m_buf.get(), IMG_SIZ);
+		case ImageDecoder::BLKF_DXT5:
+			return ImageDecoder::fromDXT5_cpp(WIDTH, HEIGHT, m_buf.get(), IMG_SIZ);
+		case ImageDecoder::BLKF_BC4:
+			return ImageDecoder::fromBC4_cpp(WIDTH, HEIGHT, m_buf.get(), IMG_SIZ);
+		case ImageDecoder::BLKF_BC5:
+			return ImageDecoder::fromBC5_cpp(WIDTH, HEIGHT, m_buf.get(), IMG_SIZ);
+		default:
+			return nullptr;
+	}
+}
+
+/**
+ * Compare two ARGB32 images.
+ * @param a Image A.
+ * @param b Image B.
+ */
+void ImageDecoderRegionTest::compareImages(const rp_image *a, const rp_image *b)
+{
+	ASSERT_TRUE(a != nullptr);
+	ASSERT_TRUE(b != nullptr);
+	ASSERT_EQ(a->width(), b->width());
+	ASSERT_EQ(a->height(), b->height());
+	ASSERT_EQ(rp_image::Format::ARGB32, a->format());
+	ASSERT_EQ(rp_image::Format::ARGB32, b->format());
+
+	for (int y = 0; y < a->height(); y++) {
+		ASSERT_EQ(0, memcmp(a->scanLine(y), b->scanLine(y), a->row_bytes())) <<
+			"Images differ on line " << y;
+	}
+}
+
+/**
+ * Decoding the full region must match the standard decoder.
+ */
+TEST_P(ImageDecoderRegionTest, full_region)
+{
+	const ImageDecoder::BlockFormat fmt = GetParam();
+	rp_image *const full = decodeFull(fmt);
+	rp_image *const region = ImageDecoder::fromBlockRegion(fmt, WIDTH, HEIGHT,
+		m_buf.get(), IMG_SIZ, 0, 0, WIDTH, HEIGHT);
+	compareImages(full, region);
+	full->unref();
+	region->unref();
+}
+
+/**
+ * Decoding unaligned sub-rectangles must match
+ * the same area of the full image.
+ */
+TEST_P(ImageDecoderRegionTest, sub_region)
+{
+	static const struct {
+		int x, y, w, h;
+	} rects[] = {
+		{0, 0, 1, 1},
+		{3, 5, 7, 9},
+		{101, 37, 222, 131},
+		{WIDTH - 5, HEIGHT - 3, 5, 3},
+		{0, 100, WIDTH, 4},
+	};
+
+	const ImageDecoder::BlockFormat fmt = GetParam();
+	rp_image *const full = decodeFull(fmt);
+	ASSERT_TRUE(full != nullptr);
+
+	for (const auto &r : rects) {
+		rp_image *const region = ImageDecoder::fromBlockRegion(fmt, WIDTH, HEIGHT,
+			m_buf.get(), IMG_SIZ, r.x, r.y, r.w, r.h);
+		ASSERT_TRUE(region != nullptr);
+		ASSERT_EQ(r.w, region->width());
+		ASSERT_EQ(r.h, region->height());
+
+		for (int y = 0; y < r.h; y++) {
+			const uint32_t *const src = static_cast<const uint32_t*>(full->scanLine(r.y + y)) + r.x;
+			EXPECT_EQ(0, memcmp(src, region->scanLine(y), r.w * sizeof(uint32_t))) <<
+				"Region (" << r.x << ',' << r.y << ") " << r.w << 'x' << r.h <<
+				" differs on line " << y;
+		}
+		region->unref();
+	}
+	full->unref();
+}
+
+/**
+ * Out-of-bounds regions must be rejected.
+ */
+TEST_P(ImageDecoderRegionTest, invalid_region)
+{
+	const ImageDecoder::BlockFormat fmt = GetParam();
+	uint32_t dest[4*4];
+	EXPECT_NE(0, ImageDecoder::decodeBlockRegion(fmt, WIDTH, HEIGHT,
+		m_buf.get(), IMG_SIZ, WIDTH - 2, 0, 4, 4, dest, sizeof(uint32_t) * 4));
+	EXPECT_NE(0, ImageDecoder::decodeBlockRegion(fmt, WIDTH, HEIGHT,
+		m_buf.get(), IMG_SIZ, 0, -1, 4, 4, dest, sizeof(uint32_t) * 4));
+	EXPECT_NE(0, ImageDecoder::decodeBlockRegion(fmt, WIDTH, HEIGHT,
+		m_buf.get(), 16, 0, 0, 4, 4, dest, sizeof(uint32_t) * 4));
+}
+
+/**
+ * Streaming downscale must match decoding the full image
+ * and scaling it with the box filter.
+ */
+TEST_P(ImageDecoderRegionTest, scaled_matches_box)
+{
+	static const struct {
+		int w, h;
+	} sizes[] = {
+		{256, 224},	// integer ratio
+		{96, 84},	// non-integer ratio
+		{1, 1},
+		{WIDTH, 3},
+	};
+
+	const ImageDecoder::BlockFormat fmt = GetParam();
+	rp_image *const full = decodeFull(fmt);
+	ASSERT_TRUE(full != nullptr);
+
+	for (const auto &sz : sizes) {
+		rp_image *const expected = full->scaled_cpp(sz.w, sz.h, rp_image::SCALE_BOX);
+		rp_image *const actual = ImageDecoder::fromBlockScaled(fmt, WIDTH, HEIGHT,
+			m_buf.get(), IMG_SIZ, sz.w, sz.h);
+		compareImages(expected, actual);
+		expected->unref();
+		actual->unref();
+	}
+	full->unref();
+}
+
+/**
+ * Benchmark decoding the full image and then scaling it.
+ */
+TEST_P(ImageDecoderRegionTest, full_then_scaled_benchmark)
+{
+	const ImageDecoder::BlockFormat fmt = GetParam();
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		rp_image *const full = decodeFull(fmt);
+		full->scaled_cpp(128, 112, rp_image::SCALE_BOX)->unref();
+		full->unref();
+	}
+}
+
+/**
+ * Benchmark the streaming downscale.
+ */
+TEST_P(ImageDecoderRegionTest, fromBlockScaled_benchmark)
+{
+	const ImageDecoder::BlockFormat fmt = GetParam();
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		ImageDecoder::fromBlockScaled(fmt, WIDTH, HEIGHT,
+			m_buf.get(), IMG_SIZ, 128, 112)->unref();
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(BlockFormats, ImageDecoderRegionTest,
+	::testing::Values(
+		ImageDecoder::BLKF_DXT1,
+		ImageDecoder::BLKF_DXT1_A1,
+		ImageDecoder::BLKF_DXT3,
+		ImageDecoder::BLKF_DXT5,
+		ImageDecoder::BLKF_BC4,
+		ImageDecoder::BLKF_BC5));
+
+/**
+ * Decoding a grid of N3DS icons must match decoding
+ * each icon separately and copying it into place.
+ */
+TEST(ImageDecoderGridTest, N3DSTiledRGB565_A4_Grid)
+{
+	static const int ICON_W = 64, ICON_H = 64;
+	static const int COLS = 3, ROWS = 2;
+	static const int RGB_SIZ = ICON_W * ICON_H * 2;
+	static const int A4_SIZ = ICON_W * ICON_H / 2;
+	// Icons have padding between them, e.g. mega badges.
+	static const unsigned int ICON_STRIDE = RGB_SIZ + A4_SIZ + 0xA00;
+	static const size_t BUF_SIZ = ((COLS * ROWS) - 1) * ICON_STRIDE + RGB_SIZ + A4_SIZ;
+
+	unique_ptr<uint8_t[]> buf(new uint8_t[BUF_SIZ]);
+	uint32_t seed = 0x87654321;
+	for (size_t i = 0; i < BUF_SIZ; i++) {
+		seed = (seed * 1103515245U) + 12345U;
+		buf[i] = static_cast<uint8_t>(seed >> 16);
+	}
+
+	rp_image *const grid = ImageDecoder::fromN3DSTiledRGB565_A4_Grid(
+		ICON_W, ICON_H, COLS, ROWS, buf.get(), BUF_SIZ, ICON_STRIDE);
+	ASSERT_TRUE(grid != nullptr);
+	ASSERT_EQ(ICON_W * COLS, grid->width());
+	ASSERT_EQ(ICON_H * ROWS, grid->height());
+
+	for (int i = 0; i < COLS * ROWS; i++) {
+		const uint8_t *const pIcon = &buf[i * ICON_STRIDE];
+		rp_image *const icon = ImageDecoder::fromN3DSTiledRGB565_A4_cpp(ICON_W, ICON_H,
+			reinterpret_cast<const uint16_t*>(pIcon), RGB_SIZ, pIcon + RGB_SIZ, A4_SIZ);
+		ASSERT_TRUE(icon != nullptr);
+
+		const int gx = (i % COLS) * ICON_W;
+		const int gy = (i / COLS) * ICON_H;
+		for (int y = 0; y < ICON_H; y++) {
+			const uint32_t *const src = static_cast<const uint32_t*>(grid->scanLine(gy + y)) + gx;
+			EXPECT_EQ(0, memcmp(src, icon->scanLine(y), ICON_W * sizeof(uint32_t))) <<
+				"Icon " << i << " differs on line " << y;
+		}
+		icon->unref();
+	}
+
+	grid->unref();
+}
+
+} }
+
+/**
+ * Test suite main function.
+ * Called by gtest_init.cpp.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpTexture test suite: ImageDecoder region tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u\n",
+		LibRpTexture::Tests::ImageDecoderRegionTest::BENCHMARK_ITERATIONS);
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
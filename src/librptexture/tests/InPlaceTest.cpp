@@ -0,0 +1,241 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture/tests)               *
+ * InPlaceTest.cpp: Test rp_image in-place operations.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+#include "common.h"
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+
+// C includes.
+#include <stdint.h>
+#include <stdlib.h>
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+namespace LibRpTexture { namespace Tests {
+
+struct InPlaceTest_mode
+{
+	int width;
+	int height;
+	rp_image::Format format;
+
+	InPlaceTest_mode(int width, int height, rp_image::Format format)
+		: width(width)
+		, height(height)
+		, format(format)
+	{ }
+};
+
+/**
+ * Formatting function for InPlaceTest.
+ */
+inline ::std::ostream& operator<<(::std::ostream& os, const InPlaceTest_mode& mode) {
+	return os << mode.width << 'x' << mode.height << ' '
+		<< (mode.format == rp_image::Format::CI8 ? "CI8" : "ARGB32");
+}
+
+class InPlaceTest : public ::testing::TestWithParam<InPlaceTest_mode>
+{
+	protected:
+		/**
+		 * Create an image with pseudo-random data.
+		 * @param mode Test mode.
+		 * @return Image.
+		 */
+		static rp_image *createImage(const InPlaceTest_mode &mode);
+
+		/**
+		 * Compare two images.
+		 * @param a Image A.
+		 * @param b Image B.
+		 */
+		static void compareImages(const rp_image *a, const rp_image *b);
+};
+
+/**
+ * Create an image with pseudo-random data.
+ * @param mode Test mode.
+ * @return Image.
+ */
+rp_image *InPlaceTest::createImage(const InPlaceTest_mode &mode)
+{
+	rp_image *const img = new rp_image(mode.width, mode.height, mode.format);
+	uint32_t seed = 0x12345678;
+	for (int y = 0; y < img->height(); y++) {
+		uint8_t *line = static_cast<uint8_t*>(img->scanLine(y));
+		for (int x = img->row_bytes(); x > 0; x--, line++) {
+			seed = (seed * 1103515245U) + 12345U;
+			*line = static_cast<uint8_t>(seed >> 16);
+		}
+	}
+
+	if (mode.format == rp_image::Format::CI8) {
+		uint32_t *palette = img->palette();
+		for (int i = img->palette_len(); i > 0; i--, palette++) {
+			seed = (seed * 1103515245U) + 12345U;
+			*palette = seed;
+		}
+	}
+	return img;
+}
+
+/**
+ * Compare two images.
+ * @param a Image A.
+ * @param b Image B.
+ */
+void InPlaceTest::compareImages(const rp_image *a, const rp_image *b)
+{
+	ASSERT_TRUE(a != nullptr);
+	ASSERT_TRUE(b != nullptr);
+	ASSERT_EQ(a->width(), b->width());
+	ASSERT_EQ(a->height(), b->height());
+	ASSERT_EQ(a->format(), b->format());
+
+	for (int y = 0; y < a->height(); y++) {
+		ASSERT_EQ(0, memcmp(a->scanLine(y), b->scanLine(y), a->row_bytes())) <<
+			"Row " << y << " does not match.";
+	}
+
+	if (a->format() == rp_image::Format::CI8) {
+		ASSERT_EQ(a->palette_len(), b->palette_len());
+		ASSERT_EQ(0, memcmp(a->palette(), b->palette(), a->palette_len() * sizeof(uint32_t)));
+	}
+}
+
+/**
+ * Verify that flip_inplace() matches flip().
+ */
+TEST_P(InPlaceTest, flip_inplace_test)
+{
+	const InPlaceTest_mode &mode = GetParam();
+
+	static const rp_image::FlipOp ops[] = {
+		rp_image::FLIP_V, rp_image::FLIP_H, rp_image::FLIP_VH,
+	};
+	for (rp_image::FlipOp op : ops) {
+		rp_image *const img = createImage(mode);
+		rp_image *const expected = img->flip(op);
+		EXPECT_EQ(0, img->flip_inplace(op));
+		compareImages(expected, img);
+		expected->unref();
+		img->unref();
+	}
+}
+
+/**
+ * Verify that squared_inplace() matches squared().
+ */
+TEST_P(InPlaceTest, squared_inplace_test)
+{
+	const InPlaceTest_mode &mode = GetParam();
+
+	rp_image *const img = createImage(mode);
+	rp_image *const expected = img->squared();
+	EXPECT_EQ(0, img->squared_inplace());
+	compareImages(expected, img);
+	expected->unref();
+	img->unref();
+}
+
+/**
+ * Verify that all scan_opaque() variants agree, and that
+ * the isOpaque() cache is invalidated by non-const access.
+ */
+TEST_P(InPlaceTest, isOpaque_test)
+{
+	const InPlaceTest_mode &mode = GetParam();
+	if (mode.format != rp_image::Format::ARGB32) {
+		// Only ARGB32 images are scanned.
+		return;
+	}
+
+	rp_image *const img = createImage(mode);
+
+	// Make the image fully opaque.
+	for (int y = 0; y < img->height(); y++) {
+		uint32_t *line = static_cast<uint32_t*>(img->scanLine(y));
+		for (int x = img->width(); x > 0; x--, line++) {
+			*line |= 0xFF000000U;
+		}
+	}
+	EXPECT_TRUE(img->scan_opaque_cpp());
+#ifdef RP_IMAGE_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		EXPECT_TRUE(img->scan_opaque_sse2());
+	}
+#endif /* RP_IMAGE_HAS_SSE2 */
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		EXPECT_TRUE(img->scan_opaque_avx2());
+	}
+#endif /* RP_IMAGE_HAS_AVX2 */
+	EXPECT_TRUE(img->isOpaque());
+
+	// Clear the alpha channel of the last pixel.
+	// This is usually handled by the scalar tail.
+	uint32_t *const last = static_cast<uint32_t*>(img->scanLine(img->height() - 1));
+	last[img->width() - 1] &= 0xFEFFFFFFU;
+	EXPECT_FALSE(img->scan_opaque_cpp());
+#ifdef RP_IMAGE_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		EXPECT_FALSE(img->scan_opaque_sse2());
+	}
+#endif /* RP_IMAGE_HAS_SSE2 */
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		EXPECT_FALSE(img->scan_opaque_avx2());
+	}
+#endif /* RP_IMAGE_HAS_AVX2 */
+	EXPECT_FALSE(img->isOpaque());
+
+	img->unref();
+}
+
+INSTANTIATE_TEST_SUITE_P(InPlaceTest, InPlaceTest,
+	::testing::Values(
+		// Square
+		InPlaceTest_mode(64, 64, rp_image::Format::ARGB32),
+		InPlaceTest_mode(64, 64, rp_image::Format::CI8),
+
+		// Wider
+		InPlaceTest_mode(256, 192, rp_image::Format::ARGB32),
+		InPlaceTest_mode(255, 200, rp_image::Format::ARGB32),
+		InPlaceTest_mode(101, 100, rp_image::Format::ARGB32),
+		InPlaceTest_mode(1000, 3, rp_image::Format::ARGB32),
+		InPlaceTest_mode(255, 200, rp_image::Format::CI8),
+
+		// Taller
+		InPlaceTest_mode(192, 256, rp_image::Format::ARGB32),
+		InPlaceTest_mode(200, 255, rp_image::Format::ARGB32),
+		InPlaceTest_mode(100, 101, rp_image::Format::ARGB32),
+		InPlaceTest_mode(1, 7, rp_image::Format::ARGB32),
+		InPlaceTest_mode(200, 255, rp_image::Format::CI8))
+	);
+
+} }
+
+/**
+ * Test suite main function.
+ * Called by gtest_init.cpp.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpTexture test suite: rp_image in-place operation tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
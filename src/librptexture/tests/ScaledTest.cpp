@@ -0,0 +1,323 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture/tests)               *
+ * ScaledTest.cpp: Test rp_image::scaled().                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+#include "common.h"
+
+// librptexture
+#include "librptexture/img/rp_image.hpp"
+
+// C includes.
+#include <stdint.h>
+#include <stdlib.h>
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+namespace LibRpTexture { namespace Tests {
+
+class ScaledTest : public ::testing::Test
+{
+	protected:
+		ScaledTest()
+			: m_img(new rp_image(256, 224, rp_image::Format::ARGB32))
+		{
+			// Initialize the image with pseudo-random data,
+			// including partially-transparent pixels.
+			uint32_t seed = 0x12345678;
+			for (int y = 0; y < m_img->height(); y++) {
+				uint32_t *line = static_cast<uint32_t*>(m_img->scanLine(y));
+				for (int x = m_img->width(); x > 0; x--, line++) {
+					seed = (seed * 1103515245U) + 12345U;
+					*line = seed;
+				}
+			}
+		}
+
+		~ScaledTest()
+		{
+			m_img->unref();
+		}
+
+		/**
+		 * Compare two ARGB32 images.
+		 * @param a Image A.
+		 * @param b Image B.
+		 */
+		static void compareImages(const rp_image *a, const rp_image *b);
+
+	public:
+		// Number of iterations for benchmarks.
+		static const unsigned int BENCHMARK_ITERATIONS = 100;
+
+		// Image.
+		rp_image *m_img;
+};
+
+/**
+ * Compare two ARGB32 images.
+ * @param a Image A.
+ * @param b Image B.
+ */
+void ScaledTest::compareImages(const rp_image *a, const rp_image *b)
+{
+	ASSERT_TRUE(a != nullptr);
+	ASSERT_TRUE(b != nullptr);
+	ASSERT_EQ(a->width(), b->width());
+	ASSERT_EQ(a->height(), b->height());
+	ASSERT_EQ(rp_image::Format::ARGB32, a->format());
+	ASSERT_EQ(rp_image::Format::ARGB32, b->format());
+
+	for (int y = 0; y < a->height(); y++) {
+		ASSERT_EQ(0, memcmp(a->scanLine(y), b->scanLine(y), a->row_bytes())) <<
+			"Images differ on line " << y;
+	}
+}
+
+/**
+ * Nearest-neighbor scaling with an integer factor.
+ */
+TEST_F(ScaledTest, nearest_integer)
+{
+	rp_image *const img = m_img->scaled(m_img->width() * 2, m_img->height() * 3, rp_image::SCALE_NEAREST);
+	ASSERT_TRUE(img != nullptr);
+	ASSERT_EQ(m_img->width() * 2, img->width());
+	ASSERT_EQ(m_img->height() * 3, img->height());
+
+	for (int y = 0; y < img->height(); y++) {
+		const uint32_t *const src = static_cast<const uint32_t*>(m_img->scanLine(y / 3));
+		const uint32_t *const dest = static_cast<const uint32_t*>(img->scanLine(y));
+		for (int x = 0; x < img->width(); x++) {
+			ASSERT_EQ(src[x / 2], dest[x]) << "Pixel differs at (" << x << "," << y << ")";
+		}
+	}
+
+	img->unref();
+}
+
+/**
+ * Filtered scaling of a solid-color image should return the same color.
+ */
+TEST_F(ScaledTest, solid_color)
+{
+	static const uint32_t color = 0xFF336699;
+	for (int y = 0; y < m_img->height(); y++) {
+		uint32_t *line = static_cast<uint32_t*>(m_img->scanLine(y));
+		for (int x = m_img->width(); x > 0; x--) {
+			*line++ = color;
+		}
+	}
+
+	static const rp_image::ScaleMethod methods[] = {
+		rp_image::SCALE_BILINEAR, rp_image::SCALE_BOX,
+	};
+	for (const rp_image::ScaleMethod method : methods) {
+		rp_image *const img = m_img->scaled(100, 333, method);
+		ASSERT_TRUE(img != nullptr);
+		for (int y = 0; y < img->height(); y++) {
+			const uint32_t *line = static_cast<const uint32_t*>(img->scanLine(y));
+			for (int x = 0; x < img->width(); x++) {
+				ASSERT_EQ(color, line[x]) << "Pixel differs at (" << x << "," << y << ")";
+			}
+		}
+		img->unref();
+	}
+}
+
+/**
+ * Create a CI8 image with pseudo-random pixels and palette.
+ * @param width Image width.
+ * @param height Image height.
+ * @return CI8 image.
+ */
+static rp_image *createCI8Image(int width, int height)
+{
+	rp_image *const img = new rp_image(width, height, rp_image::Format::CI8);
+	uint32_t seed = 0x87654321;
+	for (int y = 0; y < height; y++) {
+		uint8_t *line = static_cast<uint8_t*>(img->scanLine(y));
+		for (int x = width; x > 0; x--, line++) {
+			seed = (seed * 1103515245U) + 12345U;
+			*line = static_cast<uint8_t>(seed >> 16);
+		}
+	}
+
+	uint32_t *palette = img->palette();
+	for (int i = img->palette_len(); i > 0; i--, palette++) {
+		seed = (seed * 1103515245U) + 12345U;
+		*palette = seed;
+	}
+	return img;
+}
+
+/**
+ * scaled_nearest_ARGB32() must match SCALE_NEAREST followed by dup_ARGB32().
+ */
+TEST_F(ScaledTest, nearest_ARGB32)
+{
+	rp_image *const ci8 = createCI8Image(24, 16);
+	ASSERT_TRUE(ci8 != nullptr);
+
+	static const int sizes[][2] = {{240, 160}, {255, 170}, {24, 16}, {7, 5}};
+	for (const rp_image *const src : {static_cast<const rp_image*>(ci8), static_cast<const rp_image*>(m_img)}) {
+		for (const auto &sz : sizes) {
+			rp_image *const tmp = src->scaled(sz[0], sz[1], rp_image::SCALE_NEAREST);
+			ASSERT_TRUE(tmp != nullptr);
+			rp_image *const expected = tmp->dup_ARGB32();
+			tmp->unref();
+
+			rp_image *img = src->scaled_nearest_ARGB32_cpp(sz[0], sz[1]);
+			compareImages(expected, img);
+			img->unref();
+
+#ifdef RP_IMAGE_HAS_AVX2
+			if (RP_CPU_HasAVX2()) {
+				img = src->scaled_nearest_ARGB32_avx2(sz[0], sz[1]);
+				compareImages(expected, img);
+				img->unref();
+			}
+#endif /* RP_IMAGE_HAS_AVX2 */
+
+			expected->unref();
+		}
+	}
+
+	ci8->unref();
+}
+
+#ifdef RP_IMAGE_HAS_SSE2
+/**
+ * The SSE2 version must match the standard version.
+ */
+TEST_F(ScaledTest, sse2_matches_cpp)
+{
+	if (!RP_CPU_HasSSE2()) {
+		fprintf(stderr, "*** SSE2 is not supported on this CPU. Skipping test.\n");
+		return;
+	}
+
+	static const rp_image::ScaleMethod methods[] = {
+		rp_image::SCALE_BILINEAR, rp_image::SCALE_BOX,
+	};
+	static const int sizes[][2] = {
+		{128, 128}, {292, 224}, {97, 301}, {1, 1}, {513, 7},
+	};
+
+	for (const rp_image::ScaleMethod method : methods) {
+		for (const auto &sz : sizes) {
+			rp_image *const img_cpp = m_img->scaled_cpp(sz[0], sz[1], method);
+			rp_image *const img_sse2 = m_img->scaled_sse2(sz[0], sz[1], method);
+			compareImages(img_cpp, img_sse2);
+			UNREF(img_cpp);
+			UNREF(img_sse2);
+			if (HasFatalFailure()) {
+				return;
+			}
+		}
+	}
+}
+#endif /* RP_IMAGE_HAS_SSE2 */
+
+/**
+ * Benchmark rp_image::scaled(). (Standard version, bilinear)
+ */
+TEST_F(ScaledTest, scaled_cpp_bilinear_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->scaled_cpp(584, 448, rp_image::SCALE_BILINEAR)->unref();
+	}
+}
+
+/**
+ * Benchmark rp_image::scaled(). (Standard version, box filter)
+ */
+TEST_F(ScaledTest, scaled_cpp_box_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->scaled_cpp(96, 84, rp_image::SCALE_BOX)->unref();
+	}
+}
+
+#ifdef RP_IMAGE_HAS_SSE2
+/**
+ * Benchmark rp_image::scaled(). (SSE2-optimized version, bilinear)
+ */
+TEST_F(ScaledTest, scaled_sse2_bilinear_benchmark)
+{
+	if (!RP_CPU_HasSSE2()) {
+		fprintf(stderr, "*** SSE2 is not supported on this CPU. Skipping test.\n");
+		return;
+	}
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->scaled_sse2(584, 448, rp_image::SCALE_BILINEAR)->unref();
+	}
+}
+
+/**
+ * Benchmark rp_image::scaled(). (SSE2-optimized version, box filter)
+ */
+TEST_F(ScaledTest, scaled_sse2_box_benchmark)
+{
+	if (!RP_CPU_HasSSE2()) {
+		fprintf(stderr, "*** SSE2 is not supported on this CPU. Skipping test.\n");
+		return;
+	}
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->scaled_sse2(96, 84, rp_image::SCALE_BOX)->unref();
+	}
+}
+#endif /* RP_IMAGE_HAS_SSE2 */
+
+/**
+ * Benchmark upscaling a CI8 icon to ARGB32 via dup_ARGB32() and scaled().
+ */
+TEST_F(ScaledTest, ci8_dup_scaled_benchmark)
+{
+	rp_image *const ci8 = createCI8Image(32, 32);
+	for (unsigned int i = BENCHMARK_ITERATIONS * 100; i > 0; i--) {
+		rp_image *const tmp = ci8->dup_ARGB32();
+		tmp->scaled(256, 256, rp_image::SCALE_NEAREST)->unref();
+		tmp->unref();
+	}
+	ci8->unref();
+}
+
+/**
+ * Benchmark upscaling a CI8 icon to ARGB32 with scaled_nearest_ARGB32().
+ */
+TEST_F(ScaledTest, ci8_scaled_nearest_ARGB32_benchmark)
+{
+	rp_image *const ci8 = createCI8Image(32, 32);
+	for (unsigned int i = BENCHMARK_ITERATIONS * 100; i > 0; i--) {
+		ci8->scaled_nearest_ARGB32(256, 256)->unref();
+	}
+	ci8->unref();
+}
+
+} }
+
+/**
+ * Test suite main function.
+ * Called by gtest_init.cpp.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpTexture test suite: rp_image::scaled() tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u\n",
+		LibRpTexture::Tests::ScaledTest::BENCHMARK_ITERATIONS);
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
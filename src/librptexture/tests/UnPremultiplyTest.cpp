@@ -84,8 +84,37 @@ TEST_F(UnPremultiplyTest, un_premultiply_sse41_benchmark)
 }
 #endif /* RP_IMAGE_HAS_SSE41 */
 
+#ifdef RP_IMAGE_HAS_AVX2
+/**
+ * Benchmark the ImageDecoder::un_premultiply() function. (AVX2-optimized version)
+ */
+TEST_F(UnPremultiplyTest, un_premultiply_avx2_benchmark)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.\n");
+		return;
+	}
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->un_premultiply_avx2();
+	}
+}
+#endif /* RP_IMAGE_HAS_AVX2 */
+
+#ifdef RP_IMAGE_HAS_NEON
+/**
+ * Benchmark the ImageDecoder::un_premultiply() function. (NEON-optimized version)
+ */
+TEST_F(UnPremultiplyTest, un_premultiply_neon_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->un_premultiply_neon();
+	}
+}
+#endif /* RP_IMAGE_HAS_NEON */
+
 // NOTE: Add more instruction sets to the #ifdef if other optimizations are added.
-#if defined(RP_IMAGE_HAS_SSE41)
+#if defined(RP_IMAGE_HAS_SSE41) || defined(RP_IMAGE_HAS_AVX2) || defined(RP_IMAGE_HAS_NEON)
 /**
  * Benchmark the ImageDecoder::un_premultiply() dispatch function.
  */
@@ -95,17 +124,173 @@ TEST_F(UnPremultiplyTest, un_premultiply_dispatch_benchmark)
 		m_img->un_premultiply();
 	}
 }
+#endif /* RP_IMAGE_HAS_SSE41 || RP_IMAGE_HAS_AVX2 || RP_IMAGE_HAS_NEON */
+
+/**
+ * Fill an ARGB32 image with every alpha value and a range of color values.
+ * @param img ARGB32 image.
+ */
+static void fillPremultiplyTestImage(rp_image *img)
+{
+	const int width = img->width();
+	for (int y = 0; y < img->height(); y++) {
+		uint32_t *px = static_cast<uint32_t*>(img->scanLine(y));
+		for (int x = 0; x < width; x++) {
+			// Alpha: x; Color: Different value per channel.
+			const unsigned int c = static_cast<unsigned int>(y + x);
+			px[x] = ((x & 0xFF) << 24) | ((c & 0xFF) << 16) |
+				(((c * 3) & 0xFF) << 8) | ((c * 7) & 0xFF);
+		}
+	}
+}
+
+/**
+ * Compare two ARGB32 images.
+ * @param expected Expected image.
+ * @param actual Actual image.
+ */
+static void compareImages(const rp_image *expected, const rp_image *actual)
+{
+	ASSERT_EQ(expected->width(), actual->width());
+	ASSERT_EQ(expected->height(), actual->height());
+	const size_t row_bytes = expected->row_bytes();
+	for (int y = 0; y < expected->height(); y++) {
+		ASSERT_EQ(0, memcmp(expected->scanLine(y), actual->scanLine(y), row_bytes))
+			<< "Row " << y << " does not match.";
+	}
+}
+
+/**
+ * Verify that the SIMD-optimized functions match the standard versions.
+ * The image width is not a multiple of 8 in order to test the
+ * remaining pixel handling.
+ */
+TEST_F(UnPremultiplyTest, simd_matches_cpp_test)
+{
+	static const int W = 256+7, H = 256;
+	rp_image *const expected = new rp_image(W, H, rp_image::Format::ARGB32);
+	rp_image *const actual = new rp_image(W, H, rp_image::Format::ARGB32);
+	ASSERT_TRUE(expected->isValid());
+	ASSERT_TRUE(actual->isValid());
+
+	// premultiply()
+	fillPremultiplyTestImage(expected);
+	expected->premultiply_cpp();
+#ifdef RP_IMAGE_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		fillPremultiplyTestImage(actual);
+		actual->premultiply_sse41();
+		compareImages(expected, actual);
+	}
+#endif /* RP_IMAGE_HAS_SSE41 */
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		fillPremultiplyTestImage(actual);
+		actual->premultiply_avx2();
+		compareImages(expected, actual);
+	}
+#endif /* RP_IMAGE_HAS_AVX2 */
+#ifdef RP_IMAGE_HAS_NEON
+	fillPremultiplyTestImage(actual);
+	actual->premultiply_neon();
+	compareImages(expected, actual);
+#endif /* RP_IMAGE_HAS_NEON */
+
+	// un_premultiply()
+	fillPremultiplyTestImage(expected);
+	expected->un_premultiply_cpp();
+#ifdef RP_IMAGE_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		fillPremultiplyTestImage(actual);
+		actual->un_premultiply_sse41();
+		compareImages(expected, actual);
+	}
 #endif /* RP_IMAGE_HAS_SSE41 */
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		fillPremultiplyTestImage(actual);
+		actual->un_premultiply_avx2();
+		compareImages(expected, actual);
+	}
+#endif /* RP_IMAGE_HAS_AVX2 */
+#ifdef RP_IMAGE_HAS_NEON
+	fillPremultiplyTestImage(actual);
+	actual->un_premultiply_neon();
+	compareImages(expected, actual);
+#endif /* RP_IMAGE_HAS_NEON */
+
+	expected->unref();
+	actual->unref();
+}
 
 /**
  * Benchmark the ImageDecoder::premultiply() function. (Standard version)
  */
-TEST_F(UnPremultiplyTest, premultiply_cpp)
+TEST_F(UnPremultiplyTest, premultiply_cpp_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->premultiply_cpp();
+	}
+}
+
+#ifdef RP_IMAGE_HAS_SSE41
+/**
+ * Benchmark the ImageDecoder::premultiply() function. (SSE4.1-optimized version)
+ */
+TEST_F(UnPremultiplyTest, premultiply_sse41_benchmark)
+{
+	if (!RP_CPU_HasSSE41()) {
+		fprintf(stderr, "*** SSE4.1 is not supported on this CPU. Skipping test.\n");
+		return;
+	}
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->premultiply_sse41();
+	}
+}
+#endif /* RP_IMAGE_HAS_SSE41 */
+
+#ifdef RP_IMAGE_HAS_AVX2
+/**
+ * Benchmark the ImageDecoder::premultiply() function. (AVX2-optimized version)
+ */
+TEST_F(UnPremultiplyTest, premultiply_avx2_benchmark)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.\n");
+		return;
+	}
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->premultiply_avx2();
+	}
+}
+#endif /* RP_IMAGE_HAS_AVX2 */
+
+#ifdef RP_IMAGE_HAS_NEON
+/**
+ * Benchmark the ImageDecoder::premultiply() function. (NEON-optimized version)
+ */
+TEST_F(UnPremultiplyTest, premultiply_neon_benchmark)
+{
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_img->premultiply_neon();
+	}
+}
+#endif /* RP_IMAGE_HAS_NEON */
+
+// NOTE: Add more instruction sets to the #ifdef if other optimizations are added.
+#if defined(RP_IMAGE_HAS_SSE41) || defined(RP_IMAGE_HAS_AVX2) || defined(RP_IMAGE_HAS_NEON)
+/**
+ * Benchmark the ImageDecoder::premultiply() dispatch function.
+ */
+TEST_F(UnPremultiplyTest, premultiply_dispatch_benchmark)
 {
 	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
 		m_img->premultiply();
 	}
 }
+#endif /* RP_IMAGE_HAS_SSE41 || RP_IMAGE_HAS_AVX2 || RP_IMAGE_HAS_NEON */
 
 } }
 
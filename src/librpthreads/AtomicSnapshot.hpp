@@ -0,0 +1,90 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * AtomicSnapshot.hpp: Atomically-published immutable snapshots.           *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTHREADS_ATOMICSNAPSHOT_HPP__
+#define __ROMPROPERTIES_LIBRPTHREADS_ATOMICSNAPSHOT_HPP__
+
+#include "Mutex.hpp"
+
+// C++ includes.
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace LibRpThreads {
+
+/**
+ * Atomically-published immutable snapshot.
+ *
+ * Used for read-mostly data, e.g. configuration files, that is
+ * read from many threads and replaced rarely. Readers get the
+ * current snapshot without locking; writers build a complete
+ * new snapshot and publish it.
+ *
+ * Replaced snapshots are retired instead of deleted, since
+ * readers may still be using them, and pointers into snapshot
+ * data may have been returned to callers. Retired snapshots
+ * are deleted when the AtomicSnapshot is destroyed, so this
+ * should only be used for data that's replaced infrequently.
+ *
+ * @tparam T Snapshot type.
+ */
+template<typename T>
+class AtomicSnapshot
+{
+	public:
+		inline AtomicSnapshot()
+			: m_cur(nullptr)
+		{ }
+
+		inline ~AtomicSnapshot()
+		{
+			delete m_cur.load(std::memory_order_relaxed);
+		}
+
+	private:
+		AtomicSnapshot(const AtomicSnapshot &) = delete;
+		AtomicSnapshot &operator=(const AtomicSnapshot &) = delete;
+
+	public:
+		/**
+		 * Get the current snapshot.
+		 * The snapshot remains valid until this object is destroyed.
+		 * @return Current snapshot, or nullptr if nothing has been published.
+		 */
+		inline const T *get(void) const
+		{
+			return m_cur.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * Publish a new snapshot.
+		 * The previous snapshot is retired.
+		 * @param snapshot New snapshot. (takes ownership; must not be modified afterwards)
+		 */
+		inline void publish(T *snapshot)
+		{
+			const T *const old = m_cur.exchange(snapshot, std::memory_order_acq_rel);
+			if (old) {
+				MutexLocker locker(m_mtxRetired);
+				m_retired.emplace_back(old);
+			}
+		}
+
+	private:
+		// Current snapshot.
+		std::atomic<const T*> m_cur;
+
+		// Retired snapshots.
+		Mutex m_mtxRetired;
+		std::vector<std::unique_ptr<const T> > m_retired;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPTHREADS_ATOMICSNAPSHOT_HPP__ */
@@ -41,6 +41,8 @@
 #  define ATOMIC_OR_FETCH(ptr, val)		__sync_or_and_fetch(ptr, val)
 #  define ATOMIC_CMPXCHG(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg);
 #  define ATOMIC_EXCHANGE(ptr, val)		__sync_lock_test_and_set(ptr, val);
+#  define ATOMIC_ADD_FETCH64(ptr, val)		__sync_add_and_fetch(ptr, val)
+#  define ATOMIC_CMPXCHG64(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg)
 # endif
 #elif defined(__GNUC__)
 # if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
@@ -51,6 +53,8 @@
    /* NOTE: C11 version of cmpxchg requires pointers, so we'll use the Itanium-style version. */
 #  define ATOMIC_CMPXCHG(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg)
 #  define ATOMIC_EXCHANGE(ptr, val)		__sync_lock_test_and_set(ptr, val)
+#  define ATOMIC_ADD_FETCH64(ptr, val)		__atomic_add_fetch(ptr, val, __ATOMIC_SEQ_CST)
+#  define ATOMIC_CMPXCHG64(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg)
 # else
    /* gcc-4.6 and earlier: Use Itanium-style atomics. */
 #  define ATOMIC_INC_FETCH(ptr)			__sync_add_and_fetch(ptr, 1)
@@ -58,6 +62,8 @@
 #  define ATOMIC_OR_FETCH(ptr, val)		__sync_or_and_fetch(ptr, val)
 #  define ATOMIC_CMPXCHG(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg)
 #  define ATOMIC_EXCHANGE(ptr, val)		__sync_lock_test_and_set(ptr, val)
+#  define ATOMIC_ADD_FETCH64(ptr, val)		__sync_add_and_fetch(ptr, val)
+#  define ATOMIC_CMPXCHG64(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg)
 # endif
 #elif defined(_MSC_VER)
 # include <intrin.h>
@@ -81,6 +87,23 @@ static __inline int ATOMIC_EXCHANGE(volatile int *ptr, int val)
 {
 	return _InterlockedExchange(REINTERPRET_CAST(volatile long*)(ptr), val);
 }
+static __inline __int64 ATOMIC_ADD_FETCH64(volatile __int64 *ptr, __int64 val)
+{
+#if defined(_M_X64) || defined(_M_ARM) || defined(_M_ARM64)
+	return _InterlockedExchangeAdd64(ptr, val) + val;
+#else
+	/* i386: _InterlockedExchangeAdd64() isn't an intrinsic. */
+	__int64 old;
+	do {
+		old = *ptr;
+	} while (_InterlockedCompareExchange64(ptr, old + val, old) != old);
+	return old + val;
+#endif
+}
+static __inline __int64 ATOMIC_CMPXCHG64(volatile __int64 *ptr, __int64 cmp, __int64 xchg)
+{
+	return _InterlockedCompareExchange64(ptr, xchg, cmp);
+}
 #else
 # error Atomic functions not defined for this compiler.
 #endif
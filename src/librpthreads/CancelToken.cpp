@@ -0,0 +1,38 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * CancelToken.cpp: Cooperative cancellation token.                        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "CancelToken.hpp"
+
+namespace LibRpThreads {
+
+// Current token for this thread.
+static thread_local const CancelToken *tls_current = nullptr;
+
+/**
+ * Get the calling thread's current token.
+ * @return Current token, or nullptr if none is set.
+ */
+const CancelToken *CancelToken::current(void)
+{
+	return tls_current;
+}
+
+CancelToken::Scope::Scope(const CancelToken *token)
+	: m_prev(tls_current)
+{
+	if (token) {
+		tls_current = token;
+	}
+}
+
+CancelToken::Scope::~Scope()
+{
+	tls_current = m_prev;
+}
+
+}
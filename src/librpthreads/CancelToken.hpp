@@ -0,0 +1,117 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * CancelToken.hpp: Cooperative cancellation token.                        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTHREADS_CANCELTOKEN_HPP__
+#define __ROMPROPERTIES_LIBRPTHREADS_CANCELTOKEN_HPP__
+
+#include "Atomics.h"
+
+namespace LibRpThreads {
+
+/**
+ * Cooperative cancellation token.
+ *
+ * Long-running operations, e.g. disc image readers and image
+ * decoders, check the calling thread's current token at block,
+ * sector, or tile granularity, and stop early if it's cancelled.
+ *
+ * The token is carried per-thread instead of being passed to
+ * every function: a caller sets it using CancelToken::Scope,
+ * and ThreadPool::parallelFor() passes it on to its workers.
+ *
+ * cancel() may be called from any thread.
+ */
+class CancelToken
+{
+	public:
+		/**
+		 * Create a cancellation token with its own flag.
+		 */
+		inline CancelToken()
+			: m_flag(0)
+			, m_pFlag(&m_flag)
+		{ }
+
+		/**
+		 * Create a cancellation token that uses an external flag.
+		 * Used by C code, which can't create CancelToken objects.
+		 * @param pFlag Flag. (non-zero if cancelled; must outlive the token)
+		 */
+		explicit inline CancelToken(volatile int *pFlag)
+			: m_flag(0)
+			, m_pFlag(pFlag)
+		{ }
+
+	private:
+		CancelToken(const CancelToken &) = delete;
+		CancelToken &operator=(const CancelToken &) = delete;
+
+	public:
+		/**
+		 * Cancel the operation.
+		 */
+		inline void cancel(void)
+		{
+			ATOMIC_EXCHANGE(m_pFlag, 1);
+		}
+
+		/**
+		 * Has the operation been cancelled?
+		 * @return True if cancelled; false if not.
+		 */
+		inline bool isCancelled(void) const
+		{
+			return (ATOMIC_OR_FETCH(m_pFlag, 0) != 0);
+		}
+
+	public:
+		/**
+		 * Get the calling thread's current token.
+		 * @return Current token, or nullptr if none is set.
+		 */
+		static const CancelToken *current(void);
+
+		/**
+		 * Has the calling thread's current token been cancelled?
+		 * @return True if cancelled; false if not, or if no token is set.
+		 */
+		static inline bool isCurrentCancelled(void)
+		{
+			const CancelToken *const token = current();
+			return (token && token->isCancelled());
+		}
+
+		/**
+		 * Set the calling thread's current token for the lifetime
+		 * of this object. The previous token is restored afterwards.
+		 *
+		 * If token is nullptr, the current token isn't changed,
+		 * so an outer scope's token still applies.
+		 */
+		class Scope
+		{
+			public:
+				explicit Scope(const CancelToken *token);
+				~Scope();
+
+			private:
+				Scope(const Scope &) = delete;
+				Scope &operator=(const Scope &) = delete;
+
+			private:
+				const CancelToken *m_prev;
+		};
+
+	private:
+		volatile int m_flag;
+		volatile int *const m_pFlag;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPTHREADS_CANCELTOKEN_HPP__ */
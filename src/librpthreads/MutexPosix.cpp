@@ -19,8 +19,9 @@ class Mutex
 	public:
 		/**
 		 * Create a mutex.
+		 * @param recursive If true, the mutex can be locked multiple times by the same thread.
 		 */
-		inline explicit Mutex();
+		inline explicit Mutex(bool recursive = false);
 
 		/**
 		 * Delete the mutex.
@@ -59,11 +60,21 @@ class Mutex
 
 /**
  * Create a mutex.
+ * @param recursive If true, the mutex can be locked multiple times by the same thread.
  */
-inline Mutex::Mutex()
+inline Mutex::Mutex(bool recursive)
 	: m_isInit(false)
 {
-	int ret = pthread_mutex_init(&m_mutex, nullptr);
+	int ret;
+	if (recursive) {
+		pthread_mutexattr_t attr;
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+		ret = pthread_mutex_init(&m_mutex, &attr);
+		pthread_mutexattr_destroy(&attr);
+	} else {
+		ret = pthread_mutex_init(&m_mutex, nullptr);
+	}
 	assert(ret == 0);
 	if (ret == 0) {
 		m_isInit = true;
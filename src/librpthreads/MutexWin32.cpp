@@ -30,8 +30,10 @@ class Mutex
 	public:
 		/**
 		 * Create a mutex.
+		 * NOTE: Critical sections are always recursive.
+		 * @param recursive If true, the mutex can be locked multiple times by the same thread.
 		 */
-		inline explicit Mutex();
+		inline explicit Mutex(bool recursive = false);
 
 		/**
 		 * Delete the mutex.
@@ -72,10 +74,14 @@ class Mutex
 
 /**
  * Create a mutex.
+ * NOTE: Critical sections are always recursive.
+ * @param recursive If true, the mutex can be locked multiple times by the same thread.
  */
-inline Mutex::Mutex()
+inline Mutex::Mutex(bool recursive)
 	: m_isInit(false)
 {
+	((void)recursive);
+
 	// Reference: https://msdn.microsoft.com/en-us/library/windows/desktop/ms686908(v=vs.85).aspx
 	if (!InitializeCriticalSectionAndSpinCount(&m_criticalSection, 0x400)) {
 		// FIXME: Do something if an error occurred here...
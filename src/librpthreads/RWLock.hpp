@@ -0,0 +1,91 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * RWLock.hpp: System-specific reader-writer lock implementation.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTHREADS_RWLOCK_HPP__
+#define __ROMPROPERTIES_LIBRPTHREADS_RWLOCK_HPP__
+
+// NOTE: The .cpp files are #included here in order to inline the functions.
+// Do NOT compile them separately!
+
+// Each .cpp file defines the RWLock class itself, with required fields.
+
+#ifdef _WIN32
+# include "RWLockWin32.cpp"
+#else /* !_WIN32 */
+# include "RWLockPosix.cpp"
+#endif
+
+namespace LibRpThreads {
+
+/**
+ * Automatic read locker/unlocker class.
+ * Locks the RWLock for reading when created.
+ * Unlocks the RWLock when it goes out of scope.
+ */
+class ReadLocker
+{
+	public:
+		inline explicit ReadLocker(RWLock &rwlock)
+			: m_rwlock(rwlock)
+		{
+			m_rwlock.lockRead();
+		}
+
+		inline ~ReadLocker()
+		{
+			m_rwlock.unlockRead();
+		}
+
+	private:
+#if __cplusplus >= 201103L
+		ReadLocker(const ReadLocker &) = delete; \
+		ReadLocker &operator=(const ReadLocker &) = delete;
+#else /* __cplusplus < 201103L */
+		ReadLocker(const ReadLocker &); \
+		ReadLocker &operator=(const ReadLocker &);
+#endif /* __cplusplus */
+
+	private:
+		RWLock &m_rwlock;
+};
+
+/**
+ * Automatic write locker/unlocker class.
+ * Locks the RWLock for writing when created.
+ * Unlocks the RWLock when it goes out of scope.
+ */
+class WriteLocker
+{
+	public:
+		inline explicit WriteLocker(RWLock &rwlock)
+			: m_rwlock(rwlock)
+		{
+			m_rwlock.lockWrite();
+		}
+
+		inline ~WriteLocker()
+		{
+			m_rwlock.unlockWrite();
+		}
+
+	private:
+#if __cplusplus >= 201103L
+		WriteLocker(const WriteLocker &) = delete; \
+		WriteLocker &operator=(const WriteLocker &) = delete;
+#else /* __cplusplus < 201103L */
+		WriteLocker(const WriteLocker &); \
+		WriteLocker &operator=(const WriteLocker &);
+#endif /* __cplusplus */
+
+	private:
+		RWLock &m_rwlock;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPTHREADS_RWLOCK_HPP__ */
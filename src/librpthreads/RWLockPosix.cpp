@@ -0,0 +1,159 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * RWLockPosix.cpp: POSIX reader-writer lock implementation.               *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include <pthread.h>
+
+// C includes. (C++ namespace)
+#include <cassert>
+#include <cerrno>
+
+namespace LibRpThreads {
+
+class RWLock
+{
+	public:
+		/**
+		 * Create a reader-writer lock.
+		 */
+		inline RWLock();
+
+		/**
+		 * Delete the reader-writer lock.
+		 * WARNING: RWLock MUST be unlocked!
+		 */
+		inline ~RWLock();
+
+	private:
+#if __cplusplus >= 201103L
+		RWLock(const RWLock &) = delete; \
+		RWLock &operator=(const RWLock &) = delete;
+#else /* __cplusplus < 201103L */
+		RWLock(const RWLock &); \
+		RWLock &operator=(const RWLock &);
+#endif /* __cplusplus */
+
+	public:
+		/**
+		 * Lock the RWLock for reading.
+		 * Multiple threads can hold the read lock at the same time.
+		 * If a thread holds the write lock, this function will block
+		 * until it's unlocked.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int lockRead(void);
+
+		/**
+		 * Unlock the RWLock after reading.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int unlockRead(void);
+
+		/**
+		 * Lock the RWLock for writing.
+		 * If any thread holds the lock, this function will block
+		 * until it's unlocked.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int lockWrite(void);
+
+		/**
+		 * Unlock the RWLock after writing.
+		 * @return 0 on success; non-zero on error.
+		 */
+		inline int unlockWrite(void);
+
+	private:
+		pthread_rwlock_t m_rwlock;
+		bool m_isInit;
+};
+
+/**
+ * Create a reader-writer lock.
+ */
+inline RWLock::RWLock()
+	: m_isInit(false)
+{
+	int ret = pthread_rwlock_init(&m_rwlock, nullptr);
+	assert(ret == 0);
+	if (ret == 0) {
+		m_isInit = true;
+	} else {
+		// FIXME: Do something if an error occurred here...
+	}
+}
+
+/**
+ * Delete the reader-writer lock.
+ * WARNING: RWLock MUST be unlocked!
+ */
+inline RWLock::~RWLock()
+{
+	if (m_isInit) {
+		// TODO: Error checking.
+		pthread_rwlock_destroy(&m_rwlock);
+	}
+}
+
+/**
+ * Lock the RWLock for reading.
+ * Multiple threads can hold the read lock at the same time.
+ * If a thread holds the write lock, this function will block
+ * until it's unlocked.
+ * @return 0 on success; non-zero on error.
+ */
+inline int RWLock::lockRead(void)
+{
+	if (!m_isInit)
+		return -EBADF;
+
+	// TODO: What error to return?
+	return pthread_rwlock_rdlock(&m_rwlock);
+}
+
+/**
+ * Unlock the RWLock after reading.
+ * @return 0 on success; non-zero on error.
+ */
+inline int RWLock::unlockRead(void)
+{
+	if (!m_isInit)
+		return -EBADF;
+
+	// TODO: What error to return?
+	return pthread_rwlock_unlock(&m_rwlock);
+}
+
+/**
+ * Lock the RWLock for writing.
+ * If any thread holds the lock, this function will block
+ * until it's unlocked.
+ * @return 0 on success; non-zero on error.
+ */
+inline int RWLock::lockWrite(void)
+{
+	if (!m_isInit)
+		return -EBADF;
+
+	// TODO: What error to return?
+	return pthread_rwlock_wrlock(&m_rwlock);
+}
+
+/**
+ * Unlock the RWLock after writing.
+ * @return 0 on success; non-zero on error.
+ */
+inline int RWLock::unlockWrite(void)
+{
+	if (!m_isInit)
+		return -EBADF;
+
+	// TODO: What error to return?
+	return pthread_rwlock_unlock(&m_rwlock);
+}
+
+}
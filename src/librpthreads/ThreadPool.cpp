@@ -0,0 +1,298 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * ThreadPool.cpp: Simple worker thread pool.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "ThreadPool.hpp"
+#include "Atomics.h"
+#include "pthread_once.h"
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif /* !_WIN32 */
+
+// C includes. (C++ namespace)
+#include <climits>
+
+// C++ includes.
+#include <algorithm>
+
+namespace LibRpThreads {
+
+// Process-wide worker thread accounting.
+volatile int ThreadPool::s_maxWorkers = -1;
+volatile int ThreadPool::s_activeWorkers = 0;
+volatile int ThreadPool::s_activeJobs = 0;
+static pthread_once_t once_maxWorkers = PTHREAD_ONCE_INIT;
+
+/**
+ * Create a thread pool.
+ *
+ * The calling thread also processes work items,
+ * so (threadCount - 1) worker threads are created.
+ *
+ * @param threadCount Number of threads. (0 for the number of CPUs)
+ */
+ThreadPool::ThreadPool(unsigned int threadCount)
+	: m_semWork(0)
+	, m_semDone(0)
+	, m_fn(nullptr)
+	, m_cancelToken(nullptr)
+	, m_next(0)
+	, m_count(0)
+	, m_quit(false)
+{
+	if (threadCount == 0) {
+		threadCount = cpuCount();
+	}
+
+	m_threads.reserve(threadCount - 1);
+	for (unsigned int i = 1; i < threadCount; i++) {
+#ifdef _WIN32
+		HANDLE hThread = CreateThread(nullptr, 0, workerThread, this, 0, nullptr);
+		if (!hThread)
+			break;
+		m_threads.push_back(hThread);
+#else /* !_WIN32 */
+		pthread_t thread;
+		if (pthread_create(&thread, nullptr, workerThread, this) != 0)
+			break;
+		m_threads.push_back(thread);
+#endif /* _WIN32 */
+	}
+}
+
+/**
+ * Delete the thread pool.
+ * All worker threads will be stopped.
+ */
+ThreadPool::~ThreadPool()
+{
+	m_quit = true;
+	for (size_t i = m_threads.size(); i > 0; i--) {
+		m_semWork.release();
+	}
+
+	for (auto thread : m_threads) {
+#ifdef _WIN32
+		WaitForSingleObject(thread, INFINITE);
+		CloseHandle(thread);
+#else /* !_WIN32 */
+		pthread_join(thread, nullptr);
+#endif /* _WIN32 */
+	}
+}
+
+/**
+ * Get the number of online CPUs.
+ * @return Number of online CPUs. (always at least 1)
+ */
+unsigned int ThreadPool::cpuCount(void)
+{
+#ifdef _WIN32
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	return (sysInfo.dwNumberOfProcessors > 0
+		? static_cast<unsigned int>(sysInfo.dwNumberOfProcessors)
+		: 1);
+#else /* !_WIN32 */
+	const long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+	return (ncpu > 0 ? static_cast<unsigned int>(ncpu) : 1);
+#endif /* _WIN32 */
+}
+
+/**
+ * Initialize the process-wide worker thread limit.
+ * Called by pthread_once().
+ */
+void ThreadPool::initMaxWorkers(void)
+{
+	// Don't override a limit set by setMaxThreads().
+	ATOMIC_CMPXCHG(&s_maxWorkers, -1, static_cast<int>(cpuCount()) - 1);
+}
+
+/**
+ * Get the process-wide thread limit.
+ *
+ * This is the maximum number of threads that can run work items
+ * at the same time, across all thread pools. Each parallelFor()
+ * call always has its calling thread; worker threads are only
+ * used if they're available, and each call reserves at most
+ * an even share of them based on the number of running calls.
+ * Nested or concurrent parallelFor() calls therefore don't
+ * oversubscribe the CPUs.
+ *
+ * @return Process-wide thread limit. (default is the number of CPUs)
+ */
+unsigned int ThreadPool::maxThreads(void)
+{
+	pthread_once(&once_maxWorkers, initMaxWorkers);
+	return static_cast<unsigned int>(ATOMIC_OR_FETCH(&s_maxWorkers, 0)) + 1;
+}
+
+/**
+ * Set the process-wide thread limit.
+ * @param threads Process-wide thread limit. (0 for the number of CPUs)
+ */
+void ThreadPool::setMaxThreads(unsigned int threads)
+{
+	if (threads == 0) {
+		threads = cpuCount();
+	}
+	ATOMIC_EXCHANGE(&s_maxWorkers, static_cast<int>(threads) - 1);
+}
+
+/**
+ * Reserve worker threads from the process-wide limit.
+ * @param want Number of worker threads wanted.
+ * @return Number of worker threads reserved. (may be 0)
+ */
+int ThreadPool::reserveWorkers(int want)
+{
+	pthread_once(&once_maxWorkers, initMaxWorkers);
+	const int maxWorkers = ATOMIC_OR_FETCH(&s_maxWorkers, 0);
+
+	// Running jobs share the worker threads evenly.
+	const int jobs = ATOMIC_OR_FETCH(&s_activeJobs, 0);
+	const int share = (jobs > 1 ? maxWorkers / jobs : maxWorkers);
+	if (want > share) {
+		want = share;
+	}
+
+	int active = ATOMIC_OR_FETCH(&s_activeWorkers, 0);
+	while (true) {
+		const int n = std::min(want, maxWorkers - active);
+		if (n <= 0) {
+			// No worker threads are available.
+			return 0;
+		}
+
+		const int prev = ATOMIC_CMPXCHG(&s_activeWorkers, active, active + n);
+		if (prev == active) {
+			// Worker threads reserved.
+			return n;
+		}
+		active = prev;
+	}
+}
+
+/**
+ * Worker thread entry point.
+ * @param param ThreadPool
+ */
+#ifdef _WIN32
+DWORD WINAPI ThreadPool::workerThread(LPVOID param)
+#else /* !_WIN32 */
+void *ThreadPool::workerThread(void *param)
+#endif /* _WIN32 */
+{
+	ThreadPool *const pool = static_cast<ThreadPool*>(param);
+	while (true) {
+		pool->m_semWork.obtain();
+		if (pool->m_quit)
+			break;
+
+		{
+			CancelToken::Scope cancelScope(pool->m_cancelToken);
+			pool->processItems();
+		}
+		pool->m_semDone.release();
+	}
+
+#ifdef _WIN32
+	return 0;
+#else /* !_WIN32 */
+	return nullptr;
+#endif /* _WIN32 */
+}
+
+/**
+ * Process work items until none are left.
+ */
+void ThreadPool::processItems(void)
+{
+	// NOTE: ATOMIC_INC_FETCH() returns the incremented value.
+	int idx;
+	while ((idx = ATOMIC_INC_FETCH(&m_next) - 1) < m_count) {
+		(*m_fn)(static_cast<size_t>(idx));
+	}
+}
+
+/**
+ * Run a function for each index in [0, count).
+ *
+ * Work items are distributed dynamically, so items
+ * that take longer don't stall the other threads.
+ * The calling thread also processes work items.
+ *
+ * This function blocks until all work items have
+ * been processed.
+ *
+ * The calling thread's CancelToken is set on the worker
+ * threads while they process this call's work items.
+ * fn() must check it if work items should be skipped.
+ *
+ * @param count Number of work items.
+ * @param fn Function to run for each work item.
+ */
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> &fn)
+{
+	assert(count <= INT_MAX);
+	if (count == 0)
+		return;
+
+	if (m_threads.empty() || count == 1) {
+		// No worker threads, or only one item.
+		// Run everything on the calling thread.
+		for (size_t i = 0; i < count; i++) {
+			fn(i);
+		}
+		return;
+	}
+
+	MutexLocker locker(m_mtxRun);
+	ATOMIC_INC_FETCH(&s_activeJobs);
+
+	// Reserve worker threads from the process-wide limit.
+	// The calling thread handles one share of the items.
+	const int workers = reserveWorkers(static_cast<int>(
+		std::min(m_threads.size(), count - 1)));
+	if (workers == 0) {
+		// No worker threads are available.
+		// Run everything on the calling thread.
+		for (size_t i = 0; i < count; i++) {
+			fn(i);
+		}
+		ATOMIC_DEC_FETCH(&s_activeJobs);
+		return;
+	}
+
+	m_fn = &fn;
+	m_cancelToken = CancelToken::current();
+	m_next = 0;
+	m_count = static_cast<int>(count);
+
+	// Wake up the reserved worker threads.
+	// NOTE: Workers that start late will simply find
+	// that there are no work items left.
+	for (int i = workers; i > 0; i--) {
+		m_semWork.release();
+	}
+
+	// Process items on this thread, too.
+	processItems();
+
+	// Wait for all workers to finish.
+	for (int i = workers; i > 0; i--) {
+		m_semDone.obtain();
+		ATOMIC_DEC_FETCH(&s_activeWorkers);
+	}
+	m_fn = nullptr;
+	m_cancelToken = nullptr;
+	ATOMIC_DEC_FETCH(&s_activeJobs);
+}
+
+}
@@ -0,0 +1,177 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * ThreadPool.hpp: Simple worker thread pool.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__
+#define __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__
+
+#include "CancelToken.hpp"
+#include "Mutex.hpp"
+#include "Semaphore.hpp"
+
+// C includes. (C++ namespace)
+#include <cstddef>
+
+// C++ includes.
+#include <functional>
+#include <vector>
+
+namespace LibRpThreads {
+
+class ThreadPool
+{
+	public:
+		/**
+		 * Create a thread pool.
+		 *
+		 * The calling thread also processes work items,
+		 * so (threadCount - 1) worker threads are created.
+		 *
+		 * NOTE: Worker threads are shared with all other thread pools
+		 * in the process while running work items. See maxThreads().
+		 *
+		 * @param threadCount Number of threads. (0 for the number of CPUs)
+		 */
+		explicit ThreadPool(unsigned int threadCount = 0);
+
+		/**
+		 * Delete the thread pool.
+		 * All worker threads will be stopped.
+		 */
+		~ThreadPool();
+
+	private:
+#if __cplusplus >= 201103L
+		ThreadPool(const ThreadPool &) = delete; \
+		ThreadPool &operator=(const ThreadPool &) = delete;
+#else /* __cplusplus < 201103L */
+		ThreadPool(const ThreadPool &); \
+		ThreadPool &operator=(const ThreadPool &);
+#endif /* __cplusplus */
+
+	public:
+		/**
+		 * Get the number of online CPUs.
+		 * @return Number of online CPUs. (always at least 1)
+		 */
+		static unsigned int cpuCount(void);
+
+		/**
+		 * Get the process-wide thread limit.
+		 *
+		 * This is the maximum number of threads that can run work items
+		 * at the same time, across all thread pools. Each parallelFor()
+		 * call always has its calling thread; worker threads are only
+		 * used if they're available, and each call reserves at most
+		 * an even share of them based on the number of running calls.
+		 * Nested or concurrent parallelFor() calls therefore don't
+		 * oversubscribe the CPUs.
+		 *
+		 * @return Process-wide thread limit. (default is the number of CPUs)
+		 */
+		static unsigned int maxThreads(void);
+
+		/**
+		 * Set the process-wide thread limit.
+		 * @param threads Process-wide thread limit. (0 for the number of CPUs)
+		 */
+		static void setMaxThreads(unsigned int threads);
+
+		/**
+		 * Get the number of threads in this pool,
+		 * including the calling thread.
+		 * @return Number of threads.
+		 */
+		inline unsigned int threadCount(void) const
+		{
+			return static_cast<unsigned int>(m_threads.size()) + 1;
+		}
+
+		/**
+		 * Run a function for each index in [0, count).
+		 *
+		 * Work items are distributed dynamically, so items
+		 * that take longer don't stall the other threads.
+		 * The calling thread also processes work items.
+		 *
+		 * Worker threads are only woken up if the process-wide
+		 * thread limit allows it. If no workers are available,
+		 * all work items are processed on the calling thread.
+		 *
+		 * This function blocks until all work items have
+		 * been processed.
+		 *
+		 * The calling thread's CancelToken is set on the worker
+		 * threads while they process this call's work items.
+		 * fn() must check it if work items should be skipped.
+		 *
+		 * @param count Number of work items.
+		 * @param fn Function to run for each work item.
+		 */
+		void parallelFor(size_t count, const std::function<void(size_t)> &fn);
+
+	private:
+		/**
+		 * Worker thread entry point.
+		 * @param param ThreadPool
+		 */
+#ifdef _WIN32
+		static DWORD WINAPI workerThread(LPVOID param);
+#else /* !_WIN32 */
+		static void *workerThread(void *param);
+#endif /* _WIN32 */
+
+		/**
+		 * Process work items until none are left.
+		 */
+		void processItems(void);
+
+		/**
+		 * Initialize the process-wide worker thread limit.
+		 * Called by pthread_once().
+		 */
+		static void initMaxWorkers(void);
+
+		/**
+		 * Reserve worker threads from the process-wide limit.
+		 * @param want Number of worker threads wanted.
+		 * @return Number of worker threads reserved. (may be 0)
+		 */
+		static int reserveWorkers(int want);
+
+	private:
+		// Worker thread handles.
+#ifdef _WIN32
+		std::vector<HANDLE> m_threads;
+#else /* !_WIN32 */
+		std::vector<pthread_t> m_threads;
+#endif /* _WIN32 */
+
+		// Work and completion semaphores.
+		Semaphore m_semWork;
+		Semaphore m_semDone;
+
+		// Only one parallelFor() can run at a time.
+		Mutex m_mtxRun;
+
+		// Current job.
+		const std::function<void(size_t)> *m_fn;
+		const CancelToken *m_cancelToken;	// Calling thread's CancelToken.
+		volatile int m_next;	// Next work item index.
+		int m_count;		// Number of work items.
+		bool m_quit;		// Set on shutdown.
+
+		// Process-wide worker thread accounting.
+		// The calling threads aren't counted.
+		static volatile int s_maxWorkers;	// Maximum number of busy worker threads.
+		static volatile int s_activeWorkers;	// Number of busy worker threads.
+		static volatile int s_activeJobs;	// Number of running parallelFor() calls.
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__ */
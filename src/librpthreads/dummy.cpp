@@ -1 +0,0 @@
-/* dummy file to get cmake to recognize this project as a C++ project */
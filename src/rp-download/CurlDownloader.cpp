@@ -12,21 +12,22 @@
 // C++ STL classes.
 using std::string;
 
-// cURL for network access.
-#include <curl/curl.h>
 
 namespace RpDownload {
 
 CurlDownloader::CurlDownloader()
 	: super()
+	, m_headers(nullptr)
 { }
 
 CurlDownloader::CurlDownloader(const TCHAR *url)
 	: super(url)
+	, m_headers(nullptr)
 { }
 
 CurlDownloader::CurlDownloader(const tstring &url)
 	: super(url)
+	, m_headers(nullptr)
 { }
 
 /**
@@ -90,6 +91,7 @@ size_t CurlDownloader::parse_header(char *ptr, size_t size, size_t nitems, void
 	// Supported headers.
 	static const char http_content_length[] = "Content-Length: ";
 	static const char http_last_modified[] = "Last-Modified: ";
+	static const char http_etag[] = "ETag: ";
 
 	if (len >= sizeof(http_content_length) &&
 	    !strncasecmp(ptr, http_content_length, sizeof(http_content_length)-1))
@@ -145,16 +147,32 @@ size_t CurlDownloader::parse_header(char *ptr, size_t size, size_t nitems, void
 		// Parse the modification time.
 		curlDL->m_mtime = curl_getdate(mtime_str, nullptr);
 	}
+	else if (len >= sizeof(http_etag) &&
+	         !strncasecmp(ptr, http_etag, sizeof(http_etag)-1))
+	{
+		// Found the ETag.
+		// Remove the trailing whitespace, including CRLF.
+		const char *const val = ptr+sizeof(http_etag)-1;
+		size_t val_len = len-(sizeof(http_etag)-1);
+		while (val_len > 0 && ISSPACE(val[val_len-1])) {
+			val_len--;
+		}
+		curlDL->m_etag.assign(val, val_len);
+	}
 
 	// Continue processing.
 	return len;
 }
 
 /**
- * Download the file.
- * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
+ * Create a cURL "easy" handle for the current URL.
+ *
+ * This can be used to add the download to a cURL "multi" handle.
+ * Call finishHandle() once the transfer is complete.
+ *
+ * @return cURL "easy" handle, or nullptr on error.
  */
-int CurlDownloader::download(void)
+CURL *CurlDownloader::createHandle(void)
 {
 	// References:
 	// - http://stackoverflow.com/questions/1636333/download-file-using-libcurl-in-c-c
@@ -164,12 +182,13 @@ int CurlDownloader::download(void)
 	// Clear the previous download.
 	m_data.clear();
 	m_mtime = -1;
+	m_etag.clear();
 
 	// Initialize cURL.
 	CURL *curl = curl_easy_init();
 	if (!curl) {
 		// Could not initialize cURL.
-		return -ENOMEM;	// TODO: Better error?
+		return nullptr;
 	}
 
 	// Proxy settings should be set by the calling application
@@ -206,15 +225,55 @@ int CurlDownloader::download(void)
 	// Set the User-Agent.
 	curl_easy_setopt(curl, CURLOPT_USERAGENT, m_userAgent.c_str());
 
-	// TODO: Set the User-Agent?
-	CURLcode res = curl_easy_perform(curl);
+	// Conditional request validators.
+	// If the file hasn't changed, the server returns 304 with no data.
+	assert(m_headers == nullptr);
+	if (!m_reqETag.empty()) {
+		const string if_none_match = "If-None-Match: " + m_reqETag;
+		m_headers = curl_slist_append(m_headers, if_none_match.c_str());
+		curl_easy_setopt(curl, CURLOPT_HTTPHEADER, m_headers);
+	}
+	if (m_reqMtime >= 0) {
+		curl_easy_setopt(curl, CURLOPT_TIMECONDITION, static_cast<long>(CURL_TIMECOND_IFMODSINCE));
+		curl_easy_setopt(curl, CURLOPT_TIMEVALUE, static_cast<long>(m_reqMtime));
+	}
+
+	return curl;
+}
+
+/**
+ * Finish a transfer started with createHandle().
+ *
+ * The cURL "easy" handle is cleaned up by this function.
+ * If it was added to a cURL "multi" handle, it must be
+ * removed from the "multi" handle first.
+ *
+ * @param curl cURL "easy" handle.
+ * @param res Transfer result.
+ * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
+ */
+int CurlDownloader::finishHandle(CURL *curl, CURLcode res)
+{
+	// Check if we have an HTTP response code.
+	// NOTE: GameTDB sometimes returns nothing instead of 404...
+	long response_code = 0;
+	curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+
+	// If a Last-Modified time condition was set, cURL skips the
+	// data if the server ignored the condition and returned an
+	// older file. This is handled the same as 304.
+	long condition_unmet = 0;
+	if (res == CURLE_OK && m_reqMtime >= 0) {
+		curl_easy_getinfo(curl, CURLINFO_CONDITION_UNMET, &condition_unmet);
+	}
 	curl_easy_cleanup(curl);
+	if (m_headers) {
+		curl_slist_free_all(m_headers);
+		m_headers = nullptr;
+	}
+
 	if (res != CURLE_OK) {
 		// Error downloading the file.
-		// Check if we have an HTTP response code.
-		// NOTE: GameTDB sometimes returns nothing instead of 404...
-		long response_code = 0;
-		curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
 		if (response_code <= 0) {
 			// No HTTP response code.
 			// TODO: Return a cURL error code and/or message...
@@ -223,6 +282,11 @@ int CurlDownloader::download(void)
 		return (int)response_code;
 	}
 
+	if (response_code == 304 || condition_unmet) {
+		// File has not been modified.
+		return 304;
+	}
+
 	// Check if we have data.
 	if (m_data.empty()) {
 		// No data.
@@ -233,4 +297,20 @@ int CurlDownloader::download(void)
 	return 0;
 }
 
+/**
+ * Download the file.
+ * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
+ */
+int CurlDownloader::download(void)
+{
+	CURL *const curl = createHandle();
+	if (!curl) {
+		// Could not initialize cURL.
+		return -ENOMEM;	// TODO: Better error?
+	}
+
+	CURLcode res = curl_easy_perform(curl);
+	return finishHandle(curl, res);
+}
+
 }
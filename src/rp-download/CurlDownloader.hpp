@@ -11,6 +11,9 @@
 
 #include "IDownloader.hpp"
 
+// cURL for network access.
+#include <curl/curl.h>
+
 namespace RpDownload {
 
 class CurlDownloader final : public IDownloader
@@ -46,11 +49,38 @@ class CurlDownloader final : public IDownloader
 		static size_t parse_header(char *ptr, size_t size, size_t nitems, void *userdata);
 
 	public:
+		/**
+		 * Create a cURL "easy" handle for the current URL.
+		 *
+		 * This can be used to add the download to a cURL "multi" handle.
+		 * Call finishHandle() once the transfer is complete.
+		 *
+		 * @return cURL "easy" handle, or nullptr on error.
+		 */
+		CURL *createHandle(void);
+
+		/**
+		 * Finish a transfer started with createHandle().
+		 *
+		 * The cURL "easy" handle is cleaned up by this function.
+		 * If it was added to a cURL "multi" handle, it must be
+		 * removed from the "multi" handle first.
+		 *
+		 * @param curl cURL "easy" handle.
+		 * @param res Transfer result.
+		 * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
+		 */
+		int finishHandle(CURL *curl, CURLcode res);
+
 		/**
 		 * Download the file.
 		 * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
 		 */
 		int download(void) final;
+
+	private:
+		// Request headers for the current transfer.
+		struct curl_slist *m_headers;
 };
 
 }
@@ -25,6 +25,7 @@ namespace RpDownload {
 
 IDownloader::IDownloader()
 	: m_mtime(-1)
+	, m_reqMtime(-1)
 	, m_inProgress(false)
 	, m_maxSize(0)
 #ifdef _WIN32
@@ -37,6 +38,7 @@ IDownloader::IDownloader()
 IDownloader::IDownloader(const TCHAR *url)
 	: m_url(url)
 	, m_mtime(-1)
+	, m_reqMtime(-1)
 	, m_inProgress(false)
 	, m_maxSize(0)
 #ifdef _WIN32
@@ -49,6 +51,7 @@ IDownloader::IDownloader(const TCHAR *url)
 IDownloader::IDownloader(const tstring &url)
 	: m_url(url)
 	, m_mtime(-1)
+	, m_reqMtime(-1)
 	, m_inProgress(false)
 	, m_maxSize(0)
 {
@@ -120,6 +123,24 @@ void IDownloader::setMaxSize(size_t maxSize)
 	m_maxSize = maxSize;
 }
 
+/**
+ * Set the validators for a conditional request.
+ *
+ * If the file on the server matches the validators,
+ * download() will return 304 (HTTP Not Modified)
+ * and no data will be downloaded.
+ *
+ * @param etag ETag of the cached file, or empty string if none.
+ * @param mtime Last-Modified time of the cached file, or -1 if none.
+ */
+void IDownloader::setValidators(const std::string &etag, time_t mtime)
+{
+	assert(!m_inProgress);
+	// TODO: Don't set if m_inProgress?
+	m_reqETag = etag;
+	m_reqMtime = mtime;
+}
+
 /** Data accessors. **/
 
 /**
@@ -149,6 +170,15 @@ time_t IDownloader::mtime(void) const
 	return m_mtime;
 }
 
+/**
+ * Get the ETag.
+ * @return ETag, or empty string if none was set by the server.
+ */
+const std::string &IDownloader::etag(void) const
+{
+	return m_etag;
+}
+
 /**
  * Clear the data.
  */
@@ -81,6 +81,18 @@ class IDownloader
 		 */
 		void setMaxSize(size_t maxSize);
 
+		/**
+		 * Set the validators for a conditional request.
+		 *
+		 * If the file on the server matches the validators,
+		 * download() will return 304 (HTTP Not Modified)
+		 * and no data will be downloaded.
+		 *
+		 * @param etag ETag of the cached file, or empty string if none.
+		 * @param mtime Last-Modified time of the cached file, or -1 if none.
+		 */
+		void setValidators(const std::string &etag, time_t mtime);
+
 	public:
 		/** Data accessors. **/
 
@@ -102,6 +114,12 @@ class IDownloader
 		 */
 		time_t mtime(void) const;
 
+		/**
+		 * Get the ETag.
+		 * @return ETag, or empty string if none was set by the server.
+		 */
+		const std::string &etag(void) const;
+
 		/**
 		 * Clear the data.
 		 */
@@ -135,6 +153,12 @@ class IDownloader
 
 		// Last-Modified time.
 		time_t m_mtime;
+		// ETag.
+		std::string m_etag;
+
+		// Validators for conditional requests.
+		std::string m_reqETag;
+		time_t m_reqMtime;
 
 		bool m_inProgress;	// Set when downloading.
 		size_t m_maxSize;	// Maximum buffer size. (0 == unlimited)
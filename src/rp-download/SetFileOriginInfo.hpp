@@ -15,6 +15,9 @@
 #include <cstdio>
 #include <ctime>
 
+// C++ includes.
+#include <string>
+
 // tcharx
 #include "tcharx.h"
 
@@ -45,6 +48,29 @@ int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime);
 int setFileOriginInfo(FILE *file, const TCHAR *filename, const TCHAR *url, time_t mtime);
 #endif /* _WIN32 */
 
+/**
+ * Set the cache validators for a file.
+ *
+ * The validators are used for conditional requests when
+ * checking if the cached file has been updated on the server.
+ * They're stored using xattrs on Linux and ADS on Windows.
+ *
+ * @param filename Filename.
+ * @param etag ETag from the server, or empty string if none.
+ * @param checked Time the file was last downloaded or checked.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int setFileValidators(const TCHAR *filename, const std::string &etag, time_t checked);
+
+/**
+ * Get the cache validators for a file.
+ * @param filename	[in] Filename.
+ * @param etag		[out] ETag from the server, or empty string if none.
+ * @param pChecked	[out] Time the file was last downloaded or checked.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int getFileValidators(const TCHAR *filename, std::string &etag, time_t *pChecked);
+
 }
 
 #endif /* __ROMPROPERTIES_RP_DOWNLOAD_SETFILEORIGININFO_HPP__ */
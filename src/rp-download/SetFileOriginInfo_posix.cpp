@@ -32,7 +32,7 @@ using std::string;
 # include <sys/xattr.h>
 #elif defined(HAVE_EXTATTR_SET_FD)
 # include <sys/extattr.h>
-// Linux-compatible wrapper.
+// Linux-compatible wrappers.
 static inline int fsetxattr(int fd, const char *name, const void *value, size_t size, int flags)
 {
 	RP_UNUSED(flags);
@@ -43,6 +43,20 @@ static inline int fsetxattr(int fd, const char *name, const void *value, size_t
 	}
 	return 0;
 }
+static inline int setxattr(const char *path, const char *name, const void *value, size_t size, int flags)
+{
+	RP_UNUSED(flags);
+	ssize_t sxret = extattr_set_file(path, EXTATTR_NAMESPACE_USER, name, value, size);
+	if (sxret != size) {
+		errno = EIO;
+		return -1;
+	}
+	return 0;
+}
+static inline ssize_t getxattr(const char *path, const char *name, void *value, size_t size)
+{
+	return extattr_get_file(path, EXTATTR_NAMESPACE_USER, name, value, size);
+}
 #elif defined(HAVE_FSETXATTR_MAC)
 # include <sys/xattr.h>
 // TODO: Define a Linux-compatible version.
@@ -210,4 +224,80 @@ int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime)
 	return -err;
 }
 
+// xattr used for the cache validators.
+// Contents: Checked time (decimal), '\n', ETag
+static const char validators_xattr[] = "user.rom-properties.validators";
+
+/**
+ * Set the cache validators for a file.
+ *
+ * The validators are used for conditional requests when
+ * checking if the cached file has been updated on the server.
+ * They're stored using xattrs on Linux and ADS on Windows.
+ *
+ * @param filename Filename.
+ * @param etag ETag from the server, or empty string if none.
+ * @param checked Time the file was last downloaded or checked.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int setFileValidators(const TCHAR *filename, const string &etag, time_t checked)
+{
+#if defined(HAVE_FSETXATTR_LINUX) || defined(HAVE_EXTATTR_SET_FD)
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%lld\n", static_cast<long long>(checked));
+	string value = buf;
+	value += etag;
+
+	errno = 0;
+	if (setxattr(filename, validators_xattr, value.data(), value.size(), 0) != 0) {
+		const int err = errno;
+		return (err != 0 ? -err : -EIO);
+	}
+	return 0;
+#else /* !(HAVE_FSETXATTR_LINUX || HAVE_EXTATTR_SET_FD) */
+	// TODO: Mac OS X xattrs.
+	RP_UNUSED(filename);
+	RP_UNUSED(etag);
+	RP_UNUSED(checked);
+	return -ENOTSUP;
+#endif /* HAVE_FSETXATTR_LINUX || HAVE_EXTATTR_SET_FD */
+}
+
+/**
+ * Get the cache validators for a file.
+ * @param filename	[in] Filename.
+ * @param etag		[out] ETag from the server, or empty string if none.
+ * @param pChecked	[out] Time the file was last downloaded or checked.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int getFileValidators(const TCHAR *filename, string &etag, time_t *pChecked)
+{
+#if defined(HAVE_FSETXATTR_LINUX) || defined(HAVE_EXTATTR_SET_FD)
+	char buf[320];
+	errno = 0;
+	const ssize_t sz = getxattr(filename, validators_xattr, buf, sizeof(buf)-1);
+	if (sz <= 0) {
+		const int err = errno;
+		return (err != 0 ? -err : -ENOENT);
+	}
+	buf[sz] = '\0';
+
+	char *endptr = nullptr;
+	const long long checked = strtoll(buf, &endptr, 10);
+	if (endptr == buf || *endptr != '\n') {
+		// Invalid validators.
+		return -EIO;
+	}
+	*pChecked = static_cast<time_t>(checked);
+	etag.assign(endptr + 1, &buf[sz] - (endptr + 1));
+	return 0;
+#else /* !(HAVE_FSETXATTR_LINUX || HAVE_EXTATTR_SET_FD) */
+	// TODO: Mac OS X xattrs.
+	RP_UNUSED(filename);
+	RP_UNUSED(etag);
+	RP_UNUSED(pChecked);
+	return -ENOTSUP;
+#endif /* HAVE_FSETXATTR_LINUX || HAVE_EXTATTR_SET_FD */
+}
+
 }
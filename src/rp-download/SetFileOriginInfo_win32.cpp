@@ -171,4 +171,101 @@ int setFileOriginInfo(FILE *file, const TCHAR *filename, const TCHAR *url, time_
 	return -err;
 }
 
+// ADS used for the cache validators.
+// Contents: Checked time (decimal), '\n', ETag
+static const TCHAR validators_ads[] = _T(":rom-properties.validators");
+
+/**
+ * Set the cache validators for a file.
+ *
+ * The validators are used for conditional requests when
+ * checking if the cached file has been updated on the server.
+ * They're stored using xattrs on Linux and ADS on Windows.
+ *
+ * @param filename Filename.
+ * @param etag ETag from the server, or empty string if none.
+ * @param checked Time the file was last downloaded or checked.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int setFileValidators(const TCHAR *filename, const string &etag, time_t checked)
+{
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%lld\n", static_cast<long long>(checked));
+	string value = buf;
+	value += etag;
+
+	tstring tfilename = filename;
+	tfilename += validators_ads;
+	HANDLE hAds = CreateFile(
+		tfilename.c_str(),	// lpFileName
+		GENERIC_WRITE,		// dwDesiredAccess
+		FILE_SHARE_READ,	// dwShareMode
+		nullptr,		// lpSecurityAttributes
+		CREATE_ALWAYS,		// dwCreationDisposition
+		FILE_ATTRIBUTE_NORMAL,	// dwFlagsAndAttributes
+		nullptr);		// hTemplateFile
+	if (!hAds || hAds == INVALID_HANDLE_VALUE) {
+		// Error opening the ADS.
+		const int err = w32err_to_posix(GetLastError());
+		return (err != 0 ? -err : -EIO);
+	}
+
+	int ret = 0;
+	DWORD dwBytesWritten = 0;
+	BOOL bRet = WriteFile(hAds, value.data(), static_cast<DWORD>(value.size()),
+		&dwBytesWritten, nullptr);
+	if (!bRet || dwBytesWritten != static_cast<DWORD>(value.size())) {
+		// Some error occurred...
+		const int err = w32err_to_posix(GetLastError());
+		ret = (err != 0 ? -err : -EIO);
+	}
+	CloseHandle(hAds);
+	return ret;
+}
+
+/**
+ * Get the cache validators for a file.
+ * @param filename	[in] Filename.
+ * @param etag		[out] ETag from the server, or empty string if none.
+ * @param pChecked	[out] Time the file was last downloaded or checked.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int getFileValidators(const TCHAR *filename, string &etag, time_t *pChecked)
+{
+	tstring tfilename = filename;
+	tfilename += validators_ads;
+	HANDLE hAds = CreateFile(
+		tfilename.c_str(),	// lpFileName
+		GENERIC_READ,		// dwDesiredAccess
+		FILE_SHARE_READ,	// dwShareMode
+		nullptr,		// lpSecurityAttributes
+		OPEN_EXISTING,		// dwCreationDisposition
+		FILE_ATTRIBUTE_NORMAL,	// dwFlagsAndAttributes
+		nullptr);		// hTemplateFile
+	if (!hAds || hAds == INVALID_HANDLE_VALUE) {
+		// Error opening the ADS.
+		const int err = w32err_to_posix(GetLastError());
+		return (err != 0 ? -err : -ENOENT);
+	}
+
+	char buf[320];
+	DWORD dwBytesRead = 0;
+	BOOL bRet = ReadFile(hAds, buf, sizeof(buf)-1, &dwBytesRead, nullptr);
+	CloseHandle(hAds);
+	if (!bRet || dwBytesRead == 0) {
+		return -EIO;
+	}
+	buf[dwBytesRead] = '\0';
+
+	char *endptr = nullptr;
+	const long long checked = _strtoi64(buf, &endptr, 10);
+	if (endptr == buf || *endptr != '\n') {
+		// Invalid validators.
+		return -EIO;
+	}
+	*pChecked = static_cast<time_t>(checked);
+	etag.assign(endptr + 1, &buf[dwBytesRead] - (endptr + 1));
+	return 0;
+}
+
 }
@@ -49,6 +49,7 @@ int WinInetDownloader::download(void)
 	// Clear the previous download.
 	m_data.clear();
 	m_mtime = -1;
+	m_etag.clear();
 
 	// Open up an Internet connection.
 	// This doesn't actually connect to anything yet.
@@ -80,12 +81,36 @@ int WinInetDownloader::download(void)
 		}
 	}
 
+	// Conditional request validators.
+	// If the file hasn't changed, the server returns 304 with no data.
+	tstring headers;
+	if (!m_reqETag.empty()) {
+		// NOTE: ETags are ASCII.
+		headers = _T("If-None-Match: ");
+		headers.append(m_reqETag.begin(), m_reqETag.end());
+		headers += _T("\r\n");
+	}
+	if (m_reqMtime >= 0) {
+		SYSTEMTIME st_reqMtime;
+		UnixTimeToSystemTime(m_reqMtime, &st_reqMtime);
+		TCHAR szTime[INTERNET_RFC1123_BUFSIZE+1];
+		if (InternetTimeFromSystemTime(&st_reqMtime, INTERNET_RFC1123_FORMAT, szTime, sizeof(szTime))) {
+			headers += _T("If-Modified-Since: ");
+			headers += szTime;
+			headers += _T("\r\n");
+		}
+	}
+	if (!headers.empty()) {
+		// Don't let WinInet handle the request using its own cache.
+		dwFlags |= INTERNET_FLAG_RELOAD;
+	}
+
 	// Request the URL.
 	HINTERNET hURL = InternetOpenUrl(
 		hConnection,	// hInternet
 		m_url.c_str(),	// lpszUrl (Latin-1 characters only!)
-		nullptr,	// lpszHeaders
-		0,		// dwHeaderLength
+		(!headers.empty() ? headers.c_str() : nullptr),	// lpszHeaders
+		static_cast<DWORD>(headers.size()),		// dwHeaderLength
 		dwFlags,	// dwFlags
 		reinterpret_cast<DWORD_PTR>(this));	// dwContext
 	if (!hURL) {
@@ -113,6 +138,7 @@ int WinInetDownloader::download(void)
 		if (dwBufferLength == static_cast<DWORD>(sizeof(dwHttpStatusCode))) {
 			// Length is valid.
 			// We're only accepting HTTP 200.
+			// HTTP 304 is returned as-is for conditional requests.
 			if (dwHttpStatusCode != 200) {
 				// Unexpected status code.
 				InternetCloseHandle(hURL);
@@ -140,6 +166,24 @@ int WinInetDownloader::download(void)
 		}
 	}
 
+	// Get the ETag if it's available.
+	TCHAR szETag[256];
+	dwBufferLength = static_cast<DWORD>(sizeof(szETag));
+	if (HttpQueryInfo(hURL,			// hRequest
+		HTTP_QUERY_ETAG,		// dwInfoLevel
+		szETag,				// lpBuffer
+		&dwBufferLength,		// lpdwBufferLength
+		0))				// lpdwIndex
+	{
+		// Received the ETag.
+		// NOTE: dwBufferLength is in bytes, not including the NULL terminator.
+		// NOTE: ETags are ASCII.
+		const TCHAR *const pEnd = &szETag[dwBufferLength / sizeof(TCHAR)];
+		for (const TCHAR *p = szETag; p != pEnd; p++) {
+			m_etag += static_cast<char>(*p);
+		}
+	}
+
 	// Get Content-Length.
 	DWORD dwContentLength = 0;
 	dwBufferLength = static_cast<DWORD>(sizeof(dwContentLength));
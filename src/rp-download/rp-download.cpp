@@ -15,8 +15,13 @@
 // C includes.
 #ifndef _WIN32
 # include <fcntl.h>
+# include <sys/socket.h>
 # include <sys/stat.h>
+# include <sys/un.h>
 # include <unistd.h>
+# ifndef MSG_NOSIGNAL
+#  define MSG_NOSIGNAL 0
+# endif /* !MSG_NOSIGNAL */
 #endif /* _WIN32 */
 
 #ifndef __S_ISTYPE
@@ -33,12 +38,17 @@
 #include <cerrno>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 
 // C++ includes.
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <vector>
 using std::string;
 using std::tstring;
 using std::unique_ptr;
+using std::vector;
 
 #ifdef _WIN32
 // libwin32common
@@ -77,12 +87,19 @@ using namespace RpDownload;
 static const TCHAR *argv0 = nullptr;
 static bool verbose = false;
 
+// Minimum time between revalidations of a cache file, in seconds.
+// TODO: Configurable time.
+static const time_t REVALIDATE_INTERVAL = 86400*30;
+
 /**
  * Show command usage.
  */
 static void show_usage(void)
 {
-	_ftprintf(stderr, _T("Syntax: %s [-v] [-f] cache_key\n"), argv0);
+	_ftprintf(stderr, _T("Syntax: %s [-v] [-f] [-r] cache_key\n"), argv0);
+#ifndef _WIN32
+	_ftprintf(stderr, _T("        %s [-v] -d\n"), argv0);
+#endif /* !_WIN32 */
 }
 
 /**
@@ -288,179 +305,154 @@ int rmkdir(const tstring &path)
 }
 
 /**
- * rp-download: Download an image from a supported online database.
- * @param cache_key Cache key, e.g. "ds/cover/US/ADAE.png"
- * @return 0 on success; non-zero on error.
- *
- * TODO:
- * - More error codes based on the error.
+ * Create a hardlink.
+ * @param existing	[in] Existing file.
+ * @param link		[in] New link.
+ * @return 0 on success; negative POSIX error code on error.
  */
-int RP_C_API _tmain(int argc, TCHAR *argv[])
+static int make_hardlink(const tstring &existing, const tstring &link)
 {
-	// Create a downloader based on OS:
-	// - Linux: CurlDownloader
-	// - Windows: WinInetDownloader
-
-	// Syntax: rp-download cache_key
-	// Example: rp-download ds/coverM/US/ADAE.png
-
-	// If http_proxy or https_proxy are set, they will be used
-	// by the downloader code if supported.
-
-	// Reduce process integrity, if available.
-	rp_secure_reduce_integrity();
-
-	// Set OS-specific security options.
-	rp_secure_param_t param;
-#if defined(_WIN32)
-	param.bHighSec = FALSE;
-#elif defined(HAVE_SECCOMP)
-	static const int syscall_wl[] = {
-		// Syscalls used by rp-download.
-		// TODO: Add more syscalls.
-		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
-		// defined in earlier versions, including Ubuntu 14.04.
-
-		// NOTE: Special case for clone(). If it's the first syscall
-		// in the list, it has a parameter restriction added that
-		// ensures it can only be used to create threads.
-		SCMP_SYS(clone),
-		// Other multi-threading syscalls
-		SCMP_SYS(set_robust_list),
-
-		SCMP_SYS(access), SCMP_SYS(clock_gettime),
-#if defined(__SNR_clock_gettime64) || defined(__NR_clock_gettime64)
-		SCMP_SYS(clock_gettime64),
-#endif /* __SNR_clock_gettime64 || __NR_clock_gettime64 */
-		SCMP_SYS(close),
-		SCMP_SYS(fcntl),     SCMP_SYS(fcntl64),		// gcc profiling
-		SCMP_SYS(fsetxattr),
-		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
-		SCMP_SYS(fstatat64), SCMP_SYS(newfstatat),	// Ubuntu 19.10 (32-bit)
-		SCMP_SYS(futex),
-		SCMP_SYS(getdents), SCMP_SYS(getdents64),
-		SCMP_SYS(getppid),	// for bubblewrap verification
-		SCMP_SYS(getrusage),
-		SCMP_SYS(gettimeofday),	// 32-bit only?
-		SCMP_SYS(getuid),	// TODO: Only use geteuid()?
-		SCMP_SYS(lseek), SCMP_SYS(_llseek),
-		//SCMP_SYS(lstat), SCMP_SYS(lstat64),	// Not sure if used?
-		SCMP_SYS(mkdir), SCMP_SYS(mmap), SCMP_SYS(mmap2),
-		SCMP_SYS(munmap),
-		SCMP_SYS(open),		// Ubuntu 16.04
-		SCMP_SYS(openat),	// glibc-2.31
-#if defined(__SNR_openat2)
-		SCMP_SYS(openat2),	// Linux 5.6
-#elif defined(__NR_openat2)
-		__NR_openat2,		// Linux 5.6
-#endif /* __SNR_openat2 || __NR_openat2 */
-		SCMP_SYS(poll), SCMP_SYS(select),
-		SCMP_SYS(stat), SCMP_SYS(stat64),
-		SCMP_SYS(unlink),	// to delete expired cache files
-		SCMP_SYS(utimensat),
-
-#if defined(__SNR_statx) || defined(__NR_statx)
-		SCMP_SYS(getcwd),	// called by glibc's statx()
-		SCMP_SYS(statx),
-#endif /* __SNR_statx || __NR_statx */
-
-#ifndef NDEBUG
-		// Needed for assert() on some systems.
-		SCMP_SYS(uname),
-#endif /* NDEBUG */
-
-		// glibc ncsd
-		// TODO: Restrict connect() to AF_UNIX.
-		SCMP_SYS(connect), SCMP_SYS(recvmsg), SCMP_SYS(sendto),
-		SCMP_SYS(sendmmsg),	// getaddrinfo() (32-bit only?)
-		SCMP_SYS(ioctl),	// getaddrinfo() (32-bit only?) [FIXME: Filter for FIONREAD]
-		SCMP_SYS(recvfrom),	// getaddrinfo() (32-bit only?)
-
-		// Needed for network access on Kubuntu 20.04 for some reason.
-		SCMP_SYS(getpid), SCMP_SYS(uname),
-
-		// cURL and OpenSSL
-		SCMP_SYS(bind),		// getaddrinfo() [curl_thread_create_thunk(), curl-7.68.0]
-#ifdef __SNR_getrandom
-		SCMP_SYS(getrandom),
-#endif /* __SNR_getrandom */
-		SCMP_SYS(getpeername), SCMP_SYS(getsockname),
-		SCMP_SYS(getsockopt), SCMP_SYS(madvise), SCMP_SYS(mprotect),
-		SCMP_SYS(setsockopt), SCMP_SYS(socket),
-		SCMP_SYS(socketcall),	// FIXME: Enhanced filtering? [cURL+GnuTLS only?]
-		SCMP_SYS(socketpair), SCMP_SYS(sysinfo),
-
-		// libnss_resolve.so (systemd-resolved)
-		SCMP_SYS(geteuid),
-		SCMP_SYS(sendmsg),	// libpthread.so [_nss_resolve_gethostbyname4_r() from libnss_resolve.so]
+#ifdef _WIN32
+	if (!CreateHardLink(link.c_str(), existing.c_str(), nullptr)) {
+		const int err = w32err_to_posix(GetLastError());
+		return (err != 0 ? -err : -EIO);
+	}
+#else /* !_WIN32 */
+	if (::link(existing.c_str(), link.c_str()) != 0) {
+		const int err = errno;
+		return (err != 0 ? -err : -EIO);
+	}
+#endif /* _WIN32 */
+	return 0;
+}
 
-		-1	// End of whitelist
-	};
-	param.syscall_wl = syscall_wl;
-#elif defined(HAVE_PLEDGE)
-	// Promises:
-	// - stdio: General stdio functionality.
-	// - rpath: Read from ~/.config/rom-properties/ and ~/.cache/rom-properties/
-	// - wpath: Write to ~/.cache/rom-properties/
-	// - cpath: Create ~/.cache/rom-properties/ if it doesn't exist.
-	// - inet: Internet access.
-	// - fattr: Modify file attributes, e.g. mtime.
-	// - dns: Resolve hostnames.
-	// - getpw: Get user's home directory if HOME is empty.
-	param.promises = "stdio rpath wpath cpath inet fattr dns getpw";
-#elif defined(HAVE_TAME)
-	// NOTE: stdio includes fattr, e.g. utimes().
-	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH |
-	                   TAME_INET | TAME_DNS | TAME_GETPW;
-#else
-	param.dummy = 0;
-#endif
-	rp_secure_enable(param);
+/**
+ * Rename a file, replacing the destination file if it exists.
+ * @param oldname	[in] Old filename.
+ * @param newname	[in] New filename.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int rename_replace(const tstring &oldname, const tstring &newname)
+{
+#ifdef _WIN32
+	if (!MoveFileEx(oldname.c_str(), newname.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+		const int err = w32err_to_posix(GetLastError());
+		return (err != 0 ? -err : -EIO);
+	}
+#else /* !_WIN32 */
+	if (rename(oldname.c_str(), newname.c_str()) != 0) {
+		const int err = errno;
+		return (err != 0 ? -err : -EIO);
+	}
+#endif /* _WIN32 */
+	return 0;
+}
 
-	// Store argv[0] globally.
-	argv0 = argv[0];
+/**
+ * Add a downloaded file to the content store.
+ *
+ * If the content store already has a file with the same contents,
+ * the cache file is replaced with a hardlink to that file, so e.g.
+ * regional variants of the same cover are only stored once.
+ * Otherwise, the cache file is hardlinked into the content store.
+ *
+ * If hardlinks aren't supported, the cache file is kept as-is.
+ *
+ * @param cache_key	[in] Cache key.
+ * @param cache_filename [in] Cache filename.
+ * @param data		[in] File data.
+ * @param size		[in] Size of data.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int addToContentStore(const TCHAR *cache_key, const tstring &cache_filename,
+	const uint8_t *data, size_t size)
+{
+	// Use the cache key's file extension.
+	// NOTE: prepareDownload() only allows ".png" and ".jpg".
+	const TCHAR *const lastdot = _tcsrchr(cache_key, _T('.'));
+	string ext;
+	if (lastdot) {
+		for (const TCHAR *p = lastdot; *p != _T('\0'); p++) {
+			ext += static_cast<char>(*p);
+		}
+	}
 
-	if (argc < 2) {
-		show_usage();
-		return EXIT_FAILURE;
+	// NOTE: Content store keys are ASCII.
+	const string store_key = LibCacheCommon::getContentStoreKey(data, size, ext.c_str());
+	const tstring store_filename = LibCacheCommon::getCacheFilename(
+		tstring(store_key.begin(), store_key.end()));
+	if (store_filename.empty()) {
+		return -ENOENT;
 	}
 
-	// Check for arguments. (simple non-getopt version)
-	bool force = false;
-	int optind = 1;
-	for (; optind < argc; optind++) {
-		if (!argv[optind] || argv[optind][0] != '-') {
-			// End of options.
-			break;
-		}
+	// Check if the content store has a file with the same contents.
+	// The hash may collide, so the contents are always compared.
+	bool exists = false, match = false;
+	FILE *const f_store = _tfopen(store_filename.c_str(), _T("rb"));
+	if (f_store) {
+		// Read one extra byte to make sure the file isn't larger.
+		exists = true;
+		unique_ptr<uint8_t[]> buf(new uint8_t[size + 1]);
+		match = (fread(buf.get(), 1, size + 1, f_store) == size &&
+			 !memcmp(buf.get(), data, size));
+		fclose(f_store);
+	}
 
-		// Allow multiple options in one argument, e.g. '-vf'.
-		for (int i = 1; argv[optind][i] != '\0'; i++) {
-			switch (argv[optind][i]) {
-				case 'v':
-					// Verbose mode is enabled.
-					verbose = true;
-					break;
-				case 'f':
-					// Force download is enabled.
-					force = true;
-					break;
-				default:
-					// Invalid parameter.
-					show_error(_T("Unrecognized option: %c"), argv[optind][i]);
-					show_usage();
-					return EXIT_FAILURE;
+	if (match) {
+		// Replace the cache file with a hardlink to the stored file.
+		// The link is created with a temporary filename first so
+		// the cache file is always valid.
+		const tstring tmp_filename = cache_filename + _T(".tmp");
+		_tremove(tmp_filename.c_str());
+		int ret = make_hardlink(store_filename, tmp_filename);
+		if (ret == 0) {
+			ret = rename_replace(tmp_filename, cache_filename);
+			if (ret != 0) {
+				_tremove(tmp_filename.c_str());
 			}
 		}
+		return ret;
 	}
 
-	if (optind >= argc) {
-		show_error(_T("No cache key specified."));
-		show_usage();
-		return EXIT_FAILURE;
+	// Add the cache file to the content store.
+	// If a different file has the same hash, it's replaced.
+	// (Cache files linked to the old file aren't affected.)
+	int ret = rmkdir(store_filename);
+	if (ret != 0) {
+		return ret;
 	}
-	const TCHAR *const cache_key = argv[optind];
+	if (exists) {
+		_tremove(store_filename.c_str());
+	}
+	return make_hardlink(cache_filename, store_filename);
+}
 
+/**
+ * Check the cache file for a cache key and open it for writing
+ * if the image needs to be downloaded.
+ *
+ * If the download fails, the empty cache file that was opened
+ * by this function will be kept as a negative cache entry.
+ *
+ * If revalidate is true and the file is already cached, the file
+ * is checked for updates on the server using a conditional request
+ * if it wasn't checked in the last REVALIDATE_INTERVAL seconds.
+ * In this case, the downloader's validators are set, and *pf_out
+ * is set to nullptr, since the cache file is only rewritten if the
+ * file was updated on the server.
+ *
+ * @param cache_key		[in] Cache key, e.g. "ds/cover/US/ADAE.png"
+ * @param force			[in] If true, redownload the file even if it's cached.
+ * @param revalidate		[in] If true, check if the cached file was updated on the server.
+ * @param downloader		[in] Downloader.
+ * @param full_url		[out] Full URL.
+ * @param cache_filename	[out] Cache filename.
+ * @param pf_out		[out] Opened cache file, or nullptr if revalidating.
+ * @return 0 if the file needs to be downloaded; 1 if nothing needs to be done; -1 on error.
+ */
+static int prepareDownload(const TCHAR *cache_key, bool force, bool revalidate,
+	IDownloader *downloader, tstring &full_url, tstring &cache_filename, FILE **pf_out)
+{
 	// Check the cache key prefix. The prefix indicates the system
 	// and identifies the online database used.
 	// [key] indicates the cache key without the prefix.
@@ -482,14 +474,14 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		// - Does not contain any slashes.
 		// - First slash is either the first or the last character.
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -1;
 	}
 
 	const ptrdiff_t prefix_len = (slash_pos - cache_key);
 	if (prefix_len <= 0) {
 		// Empty prefix.
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -1;
 	}
 
 	// Cache key must include a lowercase file extension.
@@ -497,14 +489,14 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	if (!lastdot) {
 		// No dot...
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -1;
 	}
 	if (_tcscmp(lastdot, _T(".png")) != 0 &&
 	    _tcscmp(lastdot, _T(".jpg")) != 0)
 	{
 		// Not a supported file extension.
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -1;
 	}
 
 	// urlencode the cache key.
@@ -513,14 +505,14 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	slash_pos = _tcschr(cache_key_urlencode.data(), _T('/'));
 
 	// Determine the full URL based on the cache key.
-	TCHAR full_url[256];
+	TCHAR s_full_url[256];
 	if ((prefix_len == 3 && !_tcsncmp(cache_key, _T("wii"), 3)) ||
 	    (prefix_len == 4 && !_tcsncmp(cache_key, _T("wiiu"), 4)) ||
 	    (prefix_len == 3 && !_tcsncmp(cache_key, _T("3ds"), 3)) ||
 	    (prefix_len == 2 && !_tcsncmp(cache_key, _T("ds"), 2)))
 	{
 		// Wii, Wii U, Nintendo 3DS, Nintendo DS
-		_sntprintf(full_url, _countof(full_url),
+		_sntprintf(s_full_url, _countof(s_full_url),
 			_T("https://art.gametdb.com/%s"), cache_key_urlencode.c_str());
 	} else if (prefix_len == 6 && !_tcsncmp(cache_key, _T("amiibo"), 6)) {
 		// amiibo.
@@ -529,11 +521,11 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		if (filename_len <= 4) {
 			// Can't remove the extension...
 			SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-			return EXIT_FAILURE;
+			return -1;
 		}
 		filename_len -= 4;
 
-		_sntprintf(full_url, _countof(full_url),
+		_sntprintf(s_full_url, _countof(s_full_url),
 			_T("https://amiibo.life/nfc/%.*s/image"),
 			static_cast<int>(filename_len), slash_pos+1);
 	} else if ((prefix_len == 3 && !_tcsncmp(cache_key, _T("gba"), 3)) ||
@@ -541,16 +533,17 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		   (prefix_len == 4 && (!_tcsncmp(cache_key, _T("snes"), 4) || !_tcsncmp(cache_key, _T("ngpc"), 4)))) {
 		// Game Boy, Game Boy Color, Game Boy Advance, Super NES,
 		// Neo Geo Pocket, Neo Geo Pocket Color
-		_sntprintf(full_url, _countof(full_url),
+		_sntprintf(s_full_url, _countof(s_full_url),
 			_T("https://rpdb.gerbilsoft.com/%s"), cache_key_urlencode.c_str());
 	} else {
 		// Prefix is not supported.
 		SHOW_ERROR(_T("Cache key '%s' has an unsupported prefix."), cache_key);
-		return EXIT_FAILURE;
+		return -1;
 	}
 
+	full_url = s_full_url;
 	if (verbose) {
-		_ftprintf(stderr, _T("URL: %s\n"), full_url);
+		_ftprintf(stderr, _T("URL: %s\n"), full_url.c_str());
 	}
 
 	// Make sure we have a valid cache directory.
@@ -559,15 +552,15 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		// Cache directory is invalid...
 		// This may happen if bubblewrap is in use.
 		SHOW_ERROR(_T("Unable to access cache directory. Check the sandbox environment!"));
-		return EXIT_FAILURE;
+		return -1;
 	}
 
 	// Get the cache filename.
-	tstring cache_filename = LibCacheCommon::getCacheFilename(cache_key);
+	cache_filename = LibCacheCommon::getCacheFilename(cache_key);
 	if (cache_filename.empty()) {
 		// Invalid cache filename.
 		SHOW_ERROR(_T("Cache key '%s' is invalid."), cache_key);
-		return EXIT_FAILURE;
+		return -1;
 	}
 	if (verbose) {
 		_ftprintf(stderr, _T("Cache Filename: %s\n"), cache_filename.c_str());
@@ -598,7 +591,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 				// Less than a week old.
 				if (likely(!force)) {
 					SHOW_INFO(_T("Negative cache file for '%s' has not expired; not redownloading."), cache_key);
-					return EXIT_FAILURE;
+					return -1;
 				} else {
 					SHOW_INFO(_T("Negative cache file for '%s' has not expired, but -f was specified. Redownloading anyway."), cache_key);
 				}
@@ -608,19 +601,36 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 			// Delete the cache file and try to download it again.
 			if (_tremove(cache_filename.c_str()) != 0) {
 				SHOW_ERROR(_T("Error deleting negative cache file for '%s': %s"), cache_key, _tcserror(errno));
-				return EXIT_FAILURE;
+				return -1;
 			}
 		} else if (filesize > 0) {
 			// File is larger than 0 bytes, which indicates
 			// it was previously cached successfully
-			if (likely(!force)) {
+			if (revalidate && likely(!force)) {
+				// Check if the file was updated on the server.
+				string etag;
+				time_t checked = 0;
+				if (getFileValidators(cache_filename.c_str(), etag, &checked) == 0 &&
+				    (time(nullptr) - checked) < REVALIDATE_INTERVAL)
+				{
+					SHOW_INFO(_T("Cache file for '%s' was checked recently; not revalidating."), cache_key);
+					return 1;
+				}
+
+				// NOTE: The file's mtime is either the server's Last-Modified
+				// time or the time it was downloaded. Either one works for
+				// If-Modified-Since.
+				downloader->setValidators(etag, filemtime);
+				*pf_out = nullptr;
+				return 0;
+			} else if (likely(!force)) {
 				SHOW_INFO(_T("Cache file for '%s' is already downloaded."), cache_key);
-				return EXIT_SUCCESS;
+				return 1;
 			} else {
 				SHOW_INFO(_T("Cache file for '%s' is already downloaded, but -f was specified. Redownloading anyway."), cache_key);
 				if (_tremove(cache_filename.c_str()) != 0) {
 					SHOW_ERROR(_T("Error deleting cache file for '%s': %s"), cache_key, _tcserror(errno));
-					return EXIT_FAILURE;
+					return -1;
 				}
 			}
 		}
@@ -630,36 +640,73 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		int ret = rmkdir(cache_filename.c_str());
 		if (ret != 0) {
 			SHOW_ERROR(_T("Error creating directory structure: %s"), _tcserror(-ret));
-			return EXIT_FAILURE;
+			return -1;
 		}
 	} else {
 		// Other error.
 		SHOW_ERROR(_T("Error checking cache file for '%s': %s"), cache_key, _tcserror(-ret));
-		return EXIT_FAILURE;
+		return -1;
 	}
 
-	// Attempt to download the file.
-	// TODO: IDownloaderFactory?
-#ifdef _WIN32
-	unique_ptr<IDownloader> m_downloader(new WinInetDownloader());
-#else /* !_WIN32 */
-	unique_ptr<IDownloader> m_downloader(new CurlDownloader());
-#endif /* _WIN32 */
-
 	// Open the cache file now so we can use it as a negative hit
 	// if the download fails.
-	FILE *f_out = _tfopen(cache_filename.c_str(), _T("wb"));
+	FILE *const f_out = _tfopen(cache_filename.c_str(), _T("wb"));
 	if (!f_out) {
 		// Error opening the cache file.
 		SHOW_ERROR(_T("Error writing to cache file: %s"), _tcserror(errno));
-		return EXIT_FAILURE;
+		return -1;
 	}
 
-	// TODO: Configure this somewhere?
-	m_downloader->setMaxSize(4*1024*1024);
+	*pf_out = f_out;
+	return 0;
+}
+
+/**
+ * Finish a download and write the cache file.
+ * The cache file is closed by this function.
+ * @param ret		[in] Return value from the downloader.
+ * @param downloader	[in] Downloader.
+ * @param f_out		[in] Cache file opened by prepareDownload(), or nullptr if revalidating.
+ * @param cache_key	[in] Cache key.
+ * @param cache_filename [in] Cache filename.
+ * @param full_url	[in] Full URL.
+ * @return EXIT_SUCCESS on success; EXIT_FAILURE on error.
+ */
+static int finishDownload(int ret, const IDownloader *downloader, FILE *f_out,
+	const TCHAR *cache_key, const tstring &cache_filename, const tstring &full_url)
+{
+	if (!f_out) {
+		// Revalidating a cached file.
+		if (ret == 304) {
+			// File has not been modified.
+			// Keep the previous ETag if the server didn't send one.
+			string etag = downloader->etag();
+			if (etag.empty()) {
+				time_t checked;
+				getFileValidators(cache_filename.c_str(), etag, &checked);
+			}
+			setFileValidators(cache_filename.c_str(), etag, time(nullptr));
+			SHOW_INFO(_T("Cache file for '%s' has not been modified."), cache_key);
+			return EXIT_SUCCESS;
+		} else if (ret != 0 || downloader->dataSize() <= 0) {
+			// Error checking the file.
+			// The cached file is kept as-is.
+			SHOW_ERROR(_T("Error revalidating cache file for '%s'."), cache_key);
+			return EXIT_FAILURE;
+		}
+
+		// File was updated on the server.
+		// NOTE: The cache file may be hardlinked to the content store,
+		// so it has to be deleted first instead of being overwritten.
+		_tremove(cache_filename.c_str());
+		f_out = _tfopen(cache_filename.c_str(), _T("wb"));
+		if (!f_out) {
+			// Error opening the cache file.
+			SHOW_ERROR(_T("Error writing to cache file: %s"), _tcserror(errno));
+			return EXIT_FAILURE;
+		}
+	}
 
-	m_downloader->setUrl(full_url);
-	ret = m_downloader->download();
 	if (ret != 0) {
 		// Error downloading the file.
 		if (verbose) {
@@ -680,7 +727,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		return EXIT_FAILURE;
 	}
 
-	if (m_downloader->dataSize() <= 0) {
+	if (downloader->dataSize() <= 0) {
 		// No data downloaded...
 		SHOW_ERROR(_T("Error downloading file: 0 bytes received"));
 		fclose(f_out);
@@ -689,22 +736,550 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 
 	// Write the file to the cache.
 	// TODO: Verify the size.
-	const size_t dataSize = m_downloader->dataSize();
-	size_t size = fwrite(m_downloader->data(), 1, dataSize, f_out);
+	const size_t dataSize = downloader->dataSize();
+	size_t size = fwrite(downloader->data(), 1, dataSize, f_out);
 	fflush(f_out);
 
 	// Save the file origin information.
 #ifdef _WIN32
 	// TODO: Figure out how to setFileOriginInfo() on Windows using an open file handle.
-	setFileOriginInfo(f_out, cache_filename.c_str(), full_url, m_downloader->mtime());
+	setFileOriginInfo(f_out, cache_filename.c_str(), full_url.c_str(), downloader->mtime());
 #else /* !_WIN32 */
-	setFileOriginInfo(f_out, full_url, m_downloader->mtime());
+	setFileOriginInfo(f_out, full_url.c_str(), downloader->mtime());
 #endif /* _WIN32 */
 	fclose(f_out);
 
+	// Deduplicate the file using the content store.
+	// NOTE: If the file is linked to an existing file, the validators
+	// below will be set on the existing file, since it's the same file.
+	addToContentStore(cache_key, cache_filename,
+		static_cast<const uint8_t*>(downloader->data()), dataSize);
+
+	// Save the validators for revalidation.
+	setFileValidators(cache_filename.c_str(), downloader->etag(), time(nullptr));
+
 	// Success.
 	SHOW_INFO(_T("Downloaded cache file for '%s': %u byte%s."),
 		cache_key, static_cast<unsigned int>(dataSize),
 		unlikely(dataSize == 1) ? "" : "s");
 	return EXIT_SUCCESS;
 }
+
+#ifndef _WIN32
+/** rp-download daemon **/
+
+// Idle timeout for the daemon, in seconds.
+// The daemon exits if no requests are received during this time.
+static const time_t DAEMON_IDLE_TIMEOUT = 60;
+
+// Maximum length of a daemon request.
+static const size_t DAEMON_MAX_REQUEST_LEN = 1024;
+
+// Pending download.
+struct DaemonDownload {
+	string request;		// Request. (key in the downloads map)
+	string cache_key;
+	tstring full_url;
+	tstring cache_filename;
+	FILE *f_out;
+	CurlDownloader downloader;
+	vector<int> clients;	// Clients waiting for this download.
+};
+
+// Connected client.
+struct DaemonClient {
+	int fd;
+	string request;			// Partial request.
+	DaemonDownload *download;	// Download this client is waiting for.
+};
+
+/**
+ * Send a reply to a daemon client and close the connection.
+ * @param fd Client socket.
+ * @param status rp-download exit status.
+ */
+static void daemon_reply(int fd, int status)
+{
+	char buf[16];
+	const int len = snprintf(buf, sizeof(buf), "%d\n", status);
+	// NOTE: The client may have already disconnected.
+	ssize_t sz = send(fd, buf, len, MSG_NOSIGNAL);
+	RP_UNUSED(sz);
+	close(fd);
+}
+
+/**
+ * Run rp-download as a daemon.
+ *
+ * The daemon listens on a UNIX socket in the cache directory.
+ * Each client sends a cache key terminated by '\n', and receives
+ * the rp-download exit status terminated by '\n'. If the cache key
+ * is prefixed with "-r ", the file is revalidated, as with "-r".
+ *
+ * All downloads share a single cURL "multi" handle, so connections
+ * to the same server are kept alive and multiplexed using HTTP/2
+ * if supported by the server.
+ *
+ * @return EXIT_SUCCESS on success; EXIT_FAILURE on error.
+ */
+static int run_daemon(void)
+{
+	const string sock_filename = LibCacheCommon::getDownloadSocketFilename();
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	if (sock_filename.empty() || sock_filename.size() >= sizeof(addr.sun_path)) {
+		// Socket filename is invalid.
+		SHOW_ERROR(_T("Unable to access cache directory. Check the sandbox environment!"));
+		return EXIT_FAILURE;
+	}
+	addr.sun_family = AF_UNIX;
+	memcpy(addr.sun_path, sock_filename.c_str(), sock_filename.size());
+
+	int ret = rmkdir(sock_filename);
+	if (ret != 0) {
+		SHOW_ERROR(_T("Error creating directory structure: %s"), _tcserror(-ret));
+		return EXIT_FAILURE;
+	}
+
+	int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listen_fd < 0) {
+		SHOW_ERROR(_T("Error creating the daemon socket: %s"), _tcserror(errno));
+		return EXIT_FAILURE;
+	}
+
+	// If another daemon is already listening, let it handle requests.
+	if (connect(listen_fd, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) == 0) {
+		SHOW_INFO(_T("rp-download daemon is already running."));
+		close(listen_fd);
+		return EXIT_SUCCESS;
+	}
+	close(listen_fd);
+
+	// Remove the stale socket, if present.
+	unlink(sock_filename.c_str());
+	listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listen_fd < 0 ||
+	    bind(listen_fd, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) != 0 ||
+	    listen(listen_fd, 16) != 0)
+	{
+		SHOW_ERROR(_T("Error creating the daemon socket: %s"), _tcserror(errno));
+		if (listen_fd >= 0) {
+			close(listen_fd);
+		}
+		return EXIT_FAILURE;
+	}
+	fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+
+	// cURL "multi" handle.
+	// Connections are cached by the multi handle and reused by
+	// subsequent requests to the same server.
+	CURLM *const multi = curl_multi_init();
+	if (!multi) {
+		SHOW_ERROR(_T("Error initializing cURL."));
+		close(listen_fd);
+		unlink(sock_filename.c_str());
+		return EXIT_FAILURE;
+	}
+	curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+	curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, 4L);
+
+	vector<DaemonClient> clients;
+	std::map<string, unique_ptr<DaemonDownload> > downloads;
+	vector<struct curl_waitfd> waitfds;
+	time_t last_activity = time(nullptr);
+
+	for (;;) {
+		// Wait for activity on the listening socket, clients, and transfers.
+		waitfds.resize(clients.size() + 1);
+		waitfds[0].fd = listen_fd;
+		waitfds[0].events = CURL_WAIT_POLLIN;
+		waitfds[0].revents = 0;
+		for (size_t i = 0; i < clients.size(); i++) {
+			waitfds[i+1].fd = clients[i].fd;
+			waitfds[i+1].events = CURL_WAIT_POLLIN;
+			waitfds[i+1].revents = 0;
+		}
+		int numfds = 0;
+		curl_multi_wait(multi, waitfds.data(), static_cast<unsigned int>(waitfds.size()), 1000, &numfds);
+
+		// Process client requests.
+		// NOTE: Iterating backwards so clients can be removed.
+		for (size_t i = clients.size(); i > 0; i--) {
+			if (!(waitfds[i].revents & CURL_WAIT_POLLIN))
+				continue;
+			const size_t idx = i - 1;
+			DaemonClient &client = clients[idx];
+
+			char buf[256];
+			const ssize_t sz = recv(client.fd, buf, sizeof(buf), 0);
+			if (sz <= 0) {
+				// Client disconnected.
+				if (client.download) {
+					vector<int> &dl_clients = client.download->clients;
+					dl_clients.erase(std::remove(dl_clients.begin(), dl_clients.end(), client.fd),
+						dl_clients.end());
+				}
+				close(client.fd);
+				clients.erase(clients.begin() + idx);
+				continue;
+			} else if (client.download) {
+				// Only one request is allowed per connection.
+				continue;
+			}
+
+			client.request.append(buf, sz);
+			const size_t nl_pos = client.request.find('\n');
+			if (nl_pos == string::npos) {
+				if (client.request.size() > DAEMON_MAX_REQUEST_LEN) {
+					// Request is too long.
+					daemon_reply(client.fd, EXIT_FAILURE);
+					clients.erase(clients.begin() + idx);
+				}
+				continue;
+			}
+			const string request = client.request.substr(0, nl_pos);
+			const bool revalidate = (request.compare(0, 3, "-r ") == 0);
+			string cache_key = (revalidate ? request.substr(3) : request);
+			if (cache_key.empty() || LibCacheCommon::filterCacheKey(cache_key) != 0) {
+				// Invalid cache key.
+				daemon_reply(client.fd, EXIT_FAILURE);
+				clients.erase(clients.begin() + idx);
+				continue;
+			}
+
+			auto iter = downloads.find(request);
+			if (iter != downloads.end()) {
+				// This file is already being downloaded.
+				iter->second->clients.push_back(client.fd);
+				client.download = iter->second.get();
+				continue;
+			}
+
+			unique_ptr<DaemonDownload> dl(new DaemonDownload);
+			dl->request = request;
+			dl->cache_key = cache_key;
+			dl->f_out = nullptr;
+			ret = prepareDownload(cache_key.c_str(), false, revalidate, &dl->downloader,
+				dl->full_url, dl->cache_filename, &dl->f_out);
+			if (ret != 0) {
+				// Either the file doesn't need to be downloaded,
+				// or an error occurred.
+				daemon_reply(client.fd, (ret > 0 ? EXIT_SUCCESS : EXIT_FAILURE));
+				clients.erase(clients.begin() + idx);
+				continue;
+			}
+
+			// TODO: Configure this somewhere?
+			dl->downloader.setMaxSize(4*1024*1024);
+			dl->downloader.setUrl(dl->full_url);
+			CURL *const curl = dl->downloader.createHandle();
+			if (!curl) {
+				if (dl->f_out) {
+					fclose(dl->f_out);
+				}
+				daemon_reply(client.fd, EXIT_FAILURE);
+				clients.erase(clients.begin() + idx);
+				continue;
+			}
+			curl_easy_setopt(curl, CURLOPT_PRIVATE, dl.get());
+			// Wait for an existing connection to the server instead
+			// of opening a new one, if possible.
+			curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+			curl_multi_add_handle(multi, curl);
+
+			dl->clients.push_back(client.fd);
+			client.download = dl.get();
+			downloads.emplace(request, std::move(dl));
+		}
+
+		// Process transfers.
+		int running = 0;
+		curl_multi_perform(multi, &running);
+		CURLMsg *msg;
+		int msgs_left;
+		while ((msg = curl_multi_info_read(multi, &msgs_left)) != nullptr) {
+			if (msg->msg != CURLMSG_DONE)
+				continue;
+
+			CURL *const curl = msg->easy_handle;
+			const CURLcode res = msg->data.result;
+			char *priv = nullptr;
+			curl_easy_getinfo(curl, CURLINFO_PRIVATE, &priv);
+			DaemonDownload *const dl = reinterpret_cast<DaemonDownload*>(priv);
+			curl_multi_remove_handle(multi, curl);
+
+			ret = dl->downloader.finishHandle(curl, res);
+			const int status = finishDownload(ret, &dl->downloader, dl->f_out,
+				dl->cache_key.c_str(), dl->cache_filename, dl->full_url);
+			for (int fd : dl->clients) {
+				daemon_reply(fd, status);
+			}
+			clients.erase(std::remove_if(clients.begin(), clients.end(),
+				[dl](const DaemonClient &client) { return client.download == dl; }),
+				clients.end());
+			downloads.erase(dl->request);
+		}
+
+		// Accept new clients.
+		if (waitfds[0].revents & CURL_WAIT_POLLIN) {
+			int fd;
+			while ((fd = accept(listen_fd, nullptr, nullptr)) >= 0) {
+				DaemonClient client;
+				client.fd = fd;
+				client.download = nullptr;
+				clients.push_back(std::move(client));
+			}
+		}
+
+		// Check the idle timeout.
+		const time_t now = time(nullptr);
+		if (!clients.empty() || !downloads.empty()) {
+			last_activity = now;
+		} else if (now - last_activity >= DAEMON_IDLE_TIMEOUT) {
+			// Nothing to do.
+			break;
+		}
+	}
+
+	// Remove the socket first so new clients will start a new daemon.
+	unlink(sock_filename.c_str());
+	close(listen_fd);
+	curl_multi_cleanup(multi);
+	return EXIT_SUCCESS;
+}
+#endif /* !_WIN32 */
+
+/**
+ * rp-download: Download an image from a supported online database.
+ * @param cache_key Cache key, e.g. "ds/cover/US/ADAE.png"
+ * @return 0 on success; non-zero on error.
+ *
+ * TODO:
+ * - More error codes based on the error.
+ */
+int RP_C_API _tmain(int argc, TCHAR *argv[])
+{
+	// Create a downloader based on OS:
+	// - Linux: CurlDownloader
+	// - Windows: WinInetDownloader
+
+	// Syntax: rp-download cache_key
+	// Example: rp-download ds/coverM/US/ADAE.png
+
+	// If http_proxy or https_proxy are set, they will be used
+	// by the downloader code if supported.
+
+	// Reduce process integrity, if available.
+	rp_secure_reduce_integrity();
+
+	// Set OS-specific security options.
+	rp_secure_param_t param;
+#if defined(_WIN32)
+	param.bHighSec = FALSE;
+#elif defined(HAVE_SECCOMP)
+	static const int syscall_wl[] = {
+		// Syscalls used by rp-download.
+		// TODO: Add more syscalls.
+		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
+		// defined in earlier versions, including Ubuntu 14.04.
+
+		// NOTE: Special case for clone(). If it's the first syscall
+		// in the list, it has a parameter restriction added that
+		// ensures it can only be used to create threads.
+		SCMP_SYS(clone),
+		// Other multi-threading syscalls
+		SCMP_SYS(set_robust_list),
+
+		SCMP_SYS(access), SCMP_SYS(clock_gettime),
+#if defined(__SNR_clock_gettime64) || defined(__NR_clock_gettime64)
+		SCMP_SYS(clock_gettime64),
+#endif /* __SNR_clock_gettime64 || __NR_clock_gettime64 */
+		SCMP_SYS(close),
+		SCMP_SYS(fcntl),     SCMP_SYS(fcntl64),		// gcc profiling
+		SCMP_SYS(fsetxattr),
+		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
+		SCMP_SYS(fstatat64), SCMP_SYS(newfstatat),	// Ubuntu 19.10 (32-bit)
+		SCMP_SYS(futex),
+		SCMP_SYS(getdents), SCMP_SYS(getdents64),
+		SCMP_SYS(getxattr), SCMP_SYS(setxattr),	// cache validators (-r)
+		SCMP_SYS(getppid),	// for bubblewrap verification
+		SCMP_SYS(getrusage),
+		SCMP_SYS(gettimeofday),	// 32-bit only?
+		SCMP_SYS(getuid),	// TODO: Only use geteuid()?
+		SCMP_SYS(lseek), SCMP_SYS(_llseek),
+		//SCMP_SYS(lstat), SCMP_SYS(lstat64),	// Not sure if used?
+		SCMP_SYS(mkdir), SCMP_SYS(mmap), SCMP_SYS(mmap2),
+		SCMP_SYS(munmap),
+		SCMP_SYS(open),		// Ubuntu 16.04
+		SCMP_SYS(openat),	// glibc-2.31
+#if defined(__SNR_openat2)
+		SCMP_SYS(openat2),	// Linux 5.6
+#elif defined(__NR_openat2)
+		__NR_openat2,		// Linux 5.6
+#endif /* __SNR_openat2 || __NR_openat2 */
+		SCMP_SYS(poll), SCMP_SYS(select),
+		SCMP_SYS(stat), SCMP_SYS(stat64),
+		SCMP_SYS(link), SCMP_SYS(linkat),	// for the content store
+		SCMP_SYS(rename), SCMP_SYS(renameat),	// for the content store and fan-out layout
+#if defined(__SNR_renameat2)
+		SCMP_SYS(renameat2),	// glibc-2.28 (some architectures)
+#elif defined(__NR_renameat2)
+		__NR_renameat2,		// glibc-2.28 (some architectures)
+#endif /* __SNR_renameat2 || __NR_renameat2 */
+		SCMP_SYS(unlink),	// to delete expired cache files
+		SCMP_SYS(utimensat),
+
+#if defined(__SNR_statx) || defined(__NR_statx)
+		SCMP_SYS(getcwd),	// called by glibc's statx()
+		SCMP_SYS(statx),
+#endif /* __SNR_statx || __NR_statx */
+
+#ifndef NDEBUG
+		// Needed for assert() on some systems.
+		SCMP_SYS(uname),
+#endif /* NDEBUG */
+
+		// glibc ncsd
+		// TODO: Restrict connect() to AF_UNIX.
+		SCMP_SYS(connect), SCMP_SYS(recvmsg), SCMP_SYS(sendto),
+		SCMP_SYS(sendmmsg),	// getaddrinfo() (32-bit only?)
+		SCMP_SYS(ioctl),	// getaddrinfo() (32-bit only?) [FIXME: Filter for FIONREAD]
+		SCMP_SYS(recvfrom),	// getaddrinfo() (32-bit only?)
+
+		// Needed for network access on Kubuntu 20.04 for some reason.
+		SCMP_SYS(getpid), SCMP_SYS(uname),
+
+		// cURL and OpenSSL
+		SCMP_SYS(bind),		// getaddrinfo() [curl_thread_create_thunk(), curl-7.68.0]
+#ifdef __SNR_getrandom
+		SCMP_SYS(getrandom),
+#endif /* __SNR_getrandom */
+		SCMP_SYS(getpeername), SCMP_SYS(getsockname),
+		SCMP_SYS(getsockopt), SCMP_SYS(madvise), SCMP_SYS(mprotect),
+		SCMP_SYS(setsockopt), SCMP_SYS(socket),
+		SCMP_SYS(socketcall),	// FIXME: Enhanced filtering? [cURL+GnuTLS only?]
+		SCMP_SYS(socketpair), SCMP_SYS(sysinfo),
+
+		// rp-download daemon (-d)
+		SCMP_SYS(accept), SCMP_SYS(accept4), SCMP_SYS(listen),
+
+		// libnss_resolve.so (systemd-resolved)
+		SCMP_SYS(geteuid),
+		SCMP_SYS(sendmsg),	// libpthread.so [_nss_resolve_gethostbyname4_r() from libnss_resolve.so]
+
+		-1	// End of whitelist
+	};
+	param.syscall_wl = syscall_wl;
+#elif defined(HAVE_PLEDGE)
+	// Promises:
+	// - stdio: General stdio functionality.
+	// - rpath: Read from ~/.config/rom-properties/ and ~/.cache/rom-properties/
+	// - wpath: Write to ~/.cache/rom-properties/
+	// - cpath: Create ~/.cache/rom-properties/ if it doesn't exist.
+	// - inet: Internet access.
+	// - fattr: Modify file attributes, e.g. mtime.
+	// - dns: Resolve hostnames.
+	// - getpw: Get user's home directory if HOME is empty.
+	// - unix: rp-download daemon socket.
+	param.promises = "stdio rpath wpath cpath inet fattr dns getpw unix";
+#elif defined(HAVE_TAME)
+	// NOTE: stdio includes fattr, e.g. utimes().
+	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH |
+	                   TAME_INET | TAME_DNS | TAME_GETPW;
+#else
+	param.dummy = 0;
+#endif
+	rp_secure_enable(param);
+
+	// Store argv[0] globally.
+	argv0 = argv[0];
+
+	if (argc < 2) {
+		show_usage();
+		return EXIT_FAILURE;
+	}
+
+	// Check for arguments. (simple non-getopt version)
+	bool force = false;
+	bool revalidate = false;
+#ifndef _WIN32
+	bool daemon = false;
+#endif /* !_WIN32 */
+	int optind = 1;
+	for (; optind < argc; optind++) {
+		if (!argv[optind] || argv[optind][0] != '-') {
+			// End of options.
+			break;
+		}
+
+		// Allow multiple options in one argument, e.g. '-vf'.
+		for (int i = 1; argv[optind][i] != '\0'; i++) {
+			switch (argv[optind][i]) {
+				case 'v':
+					// Verbose mode is enabled.
+					verbose = true;
+					break;
+				case 'f':
+					// Force download is enabled.
+					force = true;
+					break;
+				case 'r':
+					// Revalidate the cached file.
+					revalidate = true;
+					break;
+#ifndef _WIN32
+				case 'd':
+					// Daemon mode is enabled.
+					daemon = true;
+					break;
+#endif /* !_WIN32 */
+				default:
+					// Invalid parameter.
+					show_error(_T("Unrecognized option: %c"), argv[optind][i]);
+					show_usage();
+					return EXIT_FAILURE;
+			}
+		}
+	}
+
+#ifndef _WIN32
+	if (daemon) {
+		// Handle requests from the UNIX socket.
+		return run_daemon();
+	}
+#endif /* !_WIN32 */
+
+	if (optind >= argc) {
+		show_error(_T("No cache key specified."));
+		show_usage();
+		return EXIT_FAILURE;
+	}
+	const TCHAR *const cache_key = argv[optind];
+
+	// Create the downloader.
+	// TODO: IDownloaderFactory?
+#ifdef _WIN32
+	unique_ptr<IDownloader> m_downloader(new WinInetDownloader());
+#else /* !_WIN32 */
+	unique_ptr<IDownloader> m_downloader(new CurlDownloader());
+#endif /* _WIN32 */
+
+	// Check the cache file.
+	tstring full_url, cache_filename;
+	FILE *f_out = nullptr;
+	int ret = prepareDownload(cache_key, force, revalidate, m_downloader.get(),
+		full_url, cache_filename, &f_out);
+	if (ret != 0) {
+		// Either the file doesn't need to be downloaded,
+		// or an error occurred.
+		return (ret > 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
+
+	// Attempt to download the file.
+	// TODO: Configure this somewhere?
+	m_downloader->setMaxSize(4*1024*1024);
+
+	m_downloader->setUrl(full_url);
+	ret = m_downloader->download();
+	return finishDownload(ret, m_downloader.get(), f_out, cache_key, cache_filename, full_url);
+}
@@ -20,6 +20,8 @@
 
 // OS-specific security options.
 #include "rp-stub_secure.h"
+// rp-thumbnailer-dbus forwarding.
+#include "rp-stub_dbus.h"
 #include "stdboolx.h"
 
 // C includes.
@@ -55,6 +57,8 @@ typedef int (RP_C_API *PFN_RP_SHOW_CONFIG_DIALOG)(int argc, char *argv[]);
 static bool is_rp_config = false;
 // Is debug logging enabled?
 static bool is_debug = false;
+// Should rp-thumbnailer-dbus be used for thumbnailing?
+static bool use_dbus = true;
 
 static void show_version(void)
 {
@@ -93,6 +97,7 @@ static void show_help(const char *argv0)
 			"  -s, --size\t\tMaximum thumbnail size. (default is 256px)\n"
 			"  -c, --config\t\tShow the configuration dialog instead of thumbnailing.\n"
 			"  -d, --debug\t\tShow debug output when searching for rom-properties.\n"
+			"      --no-dbus\t\tDon't use rp-thumbnailer-dbus; load rom-properties directly.\n"
 			"  -h, --help\t\tDisplay this help and exit.\n"
 			"  -V, --version\t\tOutput version information and exit."));
 	} else {
@@ -170,6 +175,7 @@ int main(int argc, char *argv[])
 		{"debug",	no_argument,		NULL, 'd'},
 		{"help",	no_argument,		NULL, 'h'},
 		{"version",	no_argument,		NULL, 'V'},
+		{"no-dbus",	no_argument,		NULL, 'N'},
 		// TODO: Option to scan for installed plugins.
 
 		{NULL, 0, NULL, 0}
@@ -219,6 +225,11 @@ int main(int argc, char *argv[])
 				is_debug = true;
 				break;
 
+			case 'N':
+				// Don't use rp-thumbnailer-dbus. (long option only)
+				use_dbus = false;
+				break;
+
 			case 'h':
 				show_help(argv[0]);
 				return EXIT_SUCCESS;
@@ -271,11 +282,43 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	int ret;
+	if (!config && use_dbus) {
+		// Try forwarding the request to rp-thumbnailer-dbus first.
+		// The service stays resident between requests, so this avoids
+		// loading and initializing the rom-properties library for
+		// every thumbnail. If the service isn't available, fall back
+		// to loading the library directly.
+		const int dbus_ret = rp_stub_dbus_create_thumbnail(argv[optind], argv[optind+1],
+			maximum_size, &ret, fnDebug);
+		if (dbus_ret == -ETIMEDOUT) {
+			// The service received the request, but it didn't reply in time.
+			// It might still write the output file, so don't fall back.
+			// tr: %1$s == function name, %2$d == return value
+			fprintf_p(stderr, C_("rp-stub", "*** ERROR: %1$s() returned %2$d."), "CreateThumbnail", dbus_ret);
+			putc('\n', stderr);
+			return EXIT_FAILURE;
+		} else if (dbus_ret == 0) {
+			if (ret == 0) {
+				if (is_debug) {
+					// tr: %1$s == function name, %2$d == return value
+					fprintf_p(stderr, C_("rp-stub", "%1$s() returned %2$d."), "CreateThumbnail", ret);
+					putc('\n', stderr);
+				}
+			} else {
+				// tr: %1$s == function name, %2$d == return value
+				fprintf_p(stderr, C_("rp-stub", "*** ERROR: %1$s() returned %2$d."), "CreateThumbnail", ret);
+				putc('\n', stderr);
+			}
+			return ret;
+		}
+	}
+
 	// Search for a usable rom-properties library.
 	// TODO: Desktop override option?
 	const char *const symname = (config ? "rp_show_config_dialog" : "rp_create_thumbnail");
 	void *pDll = NULL, *pfn = NULL;
-	int ret = rp_dll_search(symname, &pDll, &pfn, fnDebug);
+	ret = rp_dll_search(symname, &pDll, &pfn, fnDebug);
 	if (ret != 0) {
 		return ret;
 	}
@@ -0,0 +1,197 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (rp-stub)                          *
+ * rp-stub_dbus.c: Forward thumbnail requests to rp-thumbnailer-dbus.      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "rp-stub_dbus.h"
+
+// C includes.
+#include <dlfcn.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * Minimal GLib/GIO declarations.
+ * rp-stub doesn't link to GLib, so the required types
+ * are declared here and the functions are loaded with dlsym().
+ */
+typedef struct _GDBusConnection GDBusConnection;
+typedef struct _GVariant GVariant;
+typedef struct _GVariantType GVariantType;
+typedef struct _GCancellable GCancellable;
+typedef struct _GError {
+	uint32_t domain;	// GQuark
+	int code;
+	char *message;
+} GError;
+
+#define G_BUS_TYPE_SESSION 2
+#define G_DBUS_CALL_FLAGS_NONE 0
+#define G_IO_ERROR_TIMED_OUT 24
+
+typedef GDBusConnection* (*PFN_G_BUS_GET_SYNC)(int bus_type, GCancellable *cancellable, GError **error);
+typedef GVariant* (*PFN_G_DBUS_CONNECTION_CALL_SYNC)(GDBusConnection *connection,
+	const char *bus_name, const char *object_path,
+	const char *interface_name, const char *method_name,
+	GVariant *parameters, const GVariantType *reply_type,
+	int flags, int timeout_msec, GCancellable *cancellable, GError **error);
+typedef GVariant* (*PFN_G_VARIANT_NEW)(const char *format_string, ...);
+typedef void (*PFN_G_VARIANT_GET)(GVariant *value, const char *format_string, ...);
+typedef void (*PFN_G_VARIANT_UNREF)(GVariant *value);
+typedef void (*PFN_G_OBJECT_UNREF)(void *object);
+typedef void (*PFN_G_ERROR_FREE)(GError *error);
+typedef uint32_t (*PFN_G_IO_ERROR_QUARK)(void);
+
+// D-Bus service information.
+// NOTE: Must match rp-thumbnailer-dbus.
+#define RP_DBUS_NAME	"com.gerbilsoft.rom-properties.SpecializedThumbnailer1"
+#define RP_DBUS_PATH	"/com/gerbilsoft/rom_properties/SpecializedThumbnailer1"
+#define RP_DBUS_IFACE	"org.freedesktop.thumbnails.SpecializedThumbnailer1"
+
+// CreateThumbnail() timeout, in milliseconds.
+// This is longer than the default D-Bus timeout, since the
+// service may need to be started and the source file may
+// be on a slow device.
+#define RP_DBUS_TIMEOUT_MSEC 60000
+
+/**
+ * Convert a filename to an absolute path.
+ * The service has a different working directory, so
+ * relative paths must be resolved here. URIs are
+ * passed through as-is.
+ * @param filename	[in] Filename.
+ * @param buf		[out] Buffer.
+ * @param size		[in] Size of buf.
+ * @return Absolute filename, or NULL on error.
+ */
+static const char *make_absolute(const char *filename, char *buf, size_t size)
+{
+	if (filename[0] == '/' || strstr(filename, "://") != NULL) {
+		// Already absolute, or a URI.
+		return filename;
+	}
+
+	if (!getcwd(buf, size)) {
+		return NULL;
+	}
+	const size_t len = strlen(buf);
+	const int n = snprintf(&buf[len], size - len, "/%s", filename);
+	if (n < 0 || (size_t)n >= size - len) {
+		return NULL;
+	}
+	return buf;
+}
+
+/**
+ * Create a thumbnail using the rp-thumbnailer-dbus service.
+ * @param source_file	[in] Source file.
+ * @param output_file	[in] Output file.
+ * @param maximum_size	[in] Maximum size.
+ * @param pRet		[out] rp_create_thumbnail() return value from the service.
+ * @param pfnDebug	[in,opt] Pointer to debug logging function. (printf-style) (may be NULL)
+ * @return 0 if the request was handled by the service; -ETIMEDOUT if the service didn't reply in time;
+ *         other negative POSIX error code if the service isn't available.
+ */
+int rp_stub_dbus_create_thumbnail(const char *source_file, const char *output_file,
+	int maximum_size, int *pRet, PFN_RP_DLL_DEBUG pfnDebug)
+{
+	char src_buf[PATH_MAX], out_buf[PATH_MAX];
+	source_file = make_absolute(source_file, src_buf, sizeof(src_buf));
+	output_file = make_absolute(output_file, out_buf, sizeof(out_buf));
+	if (!source_file || !output_file) {
+		return -ENAMETOOLONG;
+	}
+
+	// NOTE: libgio-2.0 is never unloaded, since GLib
+	// doesn't support being unloaded.
+	void *const pGio = dlopen("libgio-2.0.so.0", RTLD_LOCAL|RTLD_NOW);
+	if (!pGio) {
+		if (pfnDebug) {
+			pfnDebug(LEVEL_DEBUG, "*** Could not load libgio-2.0.so.0; not using D-Bus.");
+		}
+		return -ENOENT;
+	}
+
+	// dlsym() also searches libgio's dependencies,
+	// so GLib and GObject functions will be found.
+	const PFN_G_BUS_GET_SYNC pfn_g_bus_get_sync =
+		(PFN_G_BUS_GET_SYNC)dlsym(pGio, "g_bus_get_sync");
+	const PFN_G_DBUS_CONNECTION_CALL_SYNC pfn_g_dbus_connection_call_sync =
+		(PFN_G_DBUS_CONNECTION_CALL_SYNC)dlsym(pGio, "g_dbus_connection_call_sync");
+	const PFN_G_VARIANT_NEW pfn_g_variant_new =
+		(PFN_G_VARIANT_NEW)dlsym(pGio, "g_variant_new");
+	const PFN_G_VARIANT_GET pfn_g_variant_get =
+		(PFN_G_VARIANT_GET)dlsym(pGio, "g_variant_get");
+	const PFN_G_VARIANT_UNREF pfn_g_variant_unref =
+		(PFN_G_VARIANT_UNREF)dlsym(pGio, "g_variant_unref");
+	const PFN_G_OBJECT_UNREF pfn_g_object_unref =
+		(PFN_G_OBJECT_UNREF)dlsym(pGio, "g_object_unref");
+	const PFN_G_ERROR_FREE pfn_g_error_free =
+		(PFN_G_ERROR_FREE)dlsym(pGio, "g_error_free");
+	const PFN_G_IO_ERROR_QUARK pfn_g_io_error_quark =
+		(PFN_G_IO_ERROR_QUARK)dlsym(pGio, "g_io_error_quark");
+	if (!pfn_g_bus_get_sync || !pfn_g_dbus_connection_call_sync ||
+	    !pfn_g_variant_new || !pfn_g_variant_get || !pfn_g_variant_unref ||
+	    !pfn_g_object_unref || !pfn_g_error_free || !pfn_g_io_error_quark)
+	{
+		if (pfnDebug) {
+			pfnDebug(LEVEL_DEBUG, "*** libgio-2.0.so.0 is missing required symbols; not using D-Bus.");
+		}
+		return -ENOSYS;
+	}
+
+	GError *error = NULL;
+	GDBusConnection *const connection = pfn_g_bus_get_sync(G_BUS_TYPE_SESSION, NULL, &error);
+	if (!connection) {
+		if (pfnDebug) {
+			pfnDebug(LEVEL_DEBUG, "*** Could not connect to the D-Bus session bus: %s",
+				(error ? error->message : "(unknown error)"));
+		}
+		if (error) {
+			pfn_g_error_free(error);
+		}
+		return -ENOTCONN;
+	}
+
+	if (pfnDebug) {
+		pfnDebug(LEVEL_DEBUG, "Calling D-Bus method: %s.CreateThumbnail(\"%s\", \"%s\", %d)",
+			RP_DBUS_IFACE, source_file, output_file, maximum_size);
+	}
+
+	// NOTE: The parameters GVariant is floating, so the call takes ownership.
+	// The service will be started by D-Bus activation if necessary.
+	GVariant *const result = pfn_g_dbus_connection_call_sync(connection,
+		RP_DBUS_NAME, RP_DBUS_PATH, RP_DBUS_IFACE, "CreateThumbnail",
+		pfn_g_variant_new("(ssi)", source_file, output_file, maximum_size),
+		NULL, G_DBUS_CALL_FLAGS_NONE, RP_DBUS_TIMEOUT_MSEC, NULL, &error);
+	pfn_g_object_unref(connection);
+	if (!result) {
+		if (pfnDebug) {
+			pfnDebug(LEVEL_DEBUG, "*** D-Bus method call failed: %s",
+				(error ? error->message : "(unknown error)"));
+		}
+		// If the call timed out, the service may still be working
+		// on the request, so the caller shouldn't retry it locally;
+		// otherwise, both of them would write to the output file.
+		const int timed_out = (error && error->domain == pfn_g_io_error_quark() &&
+		                       error->code == G_IO_ERROR_TIMED_OUT);
+		if (error) {
+			pfn_g_error_free(error);
+		}
+		return (timed_out ? -ETIMEDOUT : -EIO);
+	}
+
+	int ret = -EIO;
+	pfn_g_variant_get(result, "(i)", &ret);
+	pfn_g_variant_unref(result);
+	*pRet = ret;
+	return 0;
+}
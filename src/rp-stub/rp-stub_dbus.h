@@ -0,0 +1,42 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (rp-stub)                          *
+ * rp-stub_dbus.h: Forward thumbnail requests to rp-thumbnailer-dbus.      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_RP_STUB_RP_STUB_DBUS_H__
+#define __ROMPROPERTIES_RP_STUB_RP_STUB_DBUS_H__
+
+#include "libunixcommon/dll-search.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a thumbnail using the rp-thumbnailer-dbus service.
+ *
+ * GIO is loaded at runtime, so rp-stub doesn't depend on it.
+ * The service is started by D-Bus activation if it isn't
+ * already running, and it stays resident for a while after
+ * the last request, so subsequent thumbnails don't have to
+ * load the rom-properties plugin.
+ *
+ * @param source_file	[in] Source file.
+ * @param output_file	[in] Output file.
+ * @param maximum_size	[in] Maximum size.
+ * @param pRet		[out] rp_create_thumbnail() return value from the service.
+ * @param pfnDebug	[in,opt] Pointer to debug logging function. (printf-style) (may be NULL)
+ * @return 0 if the request was handled by the service; -ETIMEDOUT if the service didn't reply in time;
+ *         other negative POSIX error code if the service isn't available.
+ */
+int rp_stub_dbus_create_thumbnail(const char *source_file, const char *output_file,
+	int maximum_size, int *pRet, PFN_RP_DLL_DEBUG pfnDebug);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROMPROPERTIES_RP_STUB_RP_STUB_DBUS_H__ */
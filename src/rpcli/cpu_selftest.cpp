@@ -0,0 +1,151 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (rpcli)                            *
+ * cpu_selftest.cpp: CPU dispatch self-test.                               *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "cpu_selftest.hpp"
+
+// librpbase
+#include "librpbase/aligned_malloc.h"
+#include "librpbase/TextFuncs.hpp"
+#include "libi18n/i18n.h"
+using LibRpBase::rp_sprintf;
+
+// librpcpu
+#include "librpcpu/cpu_dispatch.h"
+#include "librpcpu/simd_registry.h"
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# include "librpcpu/cpuflags_x86.h"
+#endif /* RP_CPU_I386 || RP_CPU_AMD64 */
+
+// SIMD kernels
+#include "libromdata/utils/SuperMagicDrive.hpp"
+#include "libromdata/utils/RomChecksum.hpp"
+#include "librptexture/decoder/ImageDecoder.hpp"
+using LibRomData::SuperMagicDrive;
+using LibRomData::RomChecksum;
+
+// C++ includes.
+#include <chrono>
+#include <iostream>
+#include <vector>
+using std::cerr;
+using std::endl;
+using std::vector;
+
+// Number of iterations for each variant.
+static const unsigned int BENCH_ITERATIONS = 64;
+
+/**
+ * Benchmark a SIMD kernel variant.
+ * @param variant Variant.
+ * @param buf Buffer.
+ * @param size Size of buf.
+ * @return Throughput, in MB/s.
+ */
+static double BenchVariant(const RP_SIMD_Variant *variant, uint8_t *buf, size_t size)
+{
+	// Warm up the caches once before timing.
+	variant->bench(buf, size);
+
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = BENCH_ITERATIONS; i > 0; i--) {
+		variant->bench(buf, size);
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	const double secs = std::chrono::duration<double>(end - start).count();
+	if (secs <= 0.0)
+		return 0.0;
+	return (static_cast<double>(size) * BENCH_ITERATIONS) / secs / (1024.0 * 1024.0);
+}
+
+/**
+ * Run the CPU dispatch self-test.
+ * This lists all SIMD kernels, benchmarks each supported
+ * variant, and indicates which variant is selected by
+ * the runtime dispatch code.
+ * @return 0 on success; non-zero on error.
+ */
+int CpuSelfTest(void)
+{
+	// Register kernels from the other libraries.
+	// NOTE: librpcpu's own kernels are registered automatically.
+	LibRpTexture::ImageDecoder::registerSimdKernels();
+	SuperMagicDrive::registerSimdKernels();
+	RomChecksum::registerSimdKernels();
+
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+	const char *const tier = RP_CPU_GetTierOverride();
+	if (tier) {
+		cerr << rp_sprintf(C_("rpcli", "CPU tier override: %s"), tier) << endl;
+	}
+#endif /* RP_CPU_I386 || RP_CPU_AMD64 */
+
+	uint8_t *const buf = static_cast<uint8_t*>(aligned_malloc(32, RP_SIMD_BENCH_SIZE));
+	if (!buf) {
+		cerr << C_("rpcli", "ERROR: Unable to allocate the benchmark buffer.") << endl;
+		return 1;
+	}
+
+	int ret = 0;
+	const unsigned int kernelCount = RP_SIMD_GetKernelCount();
+	for (unsigned int i = 0; i < kernelCount; i++) {
+		const RP_SIMD_Kernel *const kernel = RP_SIMD_GetKernel(i);
+		assert(kernel != nullptr);
+		if (!kernel)
+			continue;
+
+		const RP_SIMD_Variant *const selected = RP_SIMD_GetSelectedVariant(kernel);
+		if (!selected) {
+			// No usable variant. This shouldn't happen,
+			// since every kernel has a C/C++ fallback.
+			ret = 1;
+		}
+
+		// Benchmark all supported variants.
+		// The buffer is refilled for each variant, since
+		// some kernels modify the buffer in place.
+		vector<double> results(kernel->count, -1.0);
+		int fastest = -1;
+		for (unsigned int j = 0; j < kernel->count; j++) {
+			const RP_SIMD_Variant *const variant = &kernel->variants[j];
+			if (!RP_SIMD_IsVariantSupported(variant))
+				continue;
+
+			for (size_t k = 0; k < RP_SIMD_BENCH_SIZE; k++) {
+				buf[k] = static_cast<uint8_t>(k * 7 + (k >> 8));
+			}
+			results[j] = BenchVariant(variant, buf, RP_SIMD_BENCH_SIZE);
+			if (fastest < 0 || results[j] > results[fastest]) {
+				fastest = static_cast<int>(j);
+			}
+		}
+
+		cerr << kernel->name << ':' << endl;
+		for (unsigned int j = 0; j < kernel->count; j++) {
+			const RP_SIMD_Variant *const variant = &kernel->variants[j];
+			cerr << "  " << variant->name << ": ";
+			if (results[j] < 0.0) {
+				cerr << C_("rpcli", "not supported") << endl;
+				continue;
+			}
+
+			cerr << rp_sprintf(C_("rpcli", "%0.1f MB/s"), results[j]);
+			if (variant == selected) {
+				cerr << ' ' << C_("rpcli", "[selected]");
+			}
+			if (static_cast<int>(j) == fastest) {
+				cerr << ' ' << C_("rpcli", "[fastest]");
+			}
+			cerr << endl;
+		}
+	}
+
+	aligned_free(buf);
+	return ret;
+}
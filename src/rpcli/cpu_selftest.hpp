@@ -0,0 +1,29 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (rpcli)                            *
+ * cpu_selftest.hpp: CPU dispatch self-test.                               *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_RPCLI_CPU_SELFTEST_HPP__
+#define __ROMPROPERTIES_RPCLI_CPU_SELFTEST_HPP__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Run the CPU dispatch self-test.
+ * This lists all SIMD kernels, benchmarks each supported
+ * variant, and indicates which variant is selected by
+ * the runtime dispatch code.
+ * @return 0 on success; non-zero on error.
+ */
+int CpuSelfTest(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROMPROPERTIES_RPCLI_CPU_SELFTEST_HPP__ */
@@ -22,6 +22,8 @@
 #include "librpbase/img/RpPng.hpp"
 #include "librpbase/img/IconAnimData.hpp"
 #include "librpbase/TextOut.hpp"
+#include "librpbase/RomMetaData.hpp"
+#include "librpbase/config/Config.hpp"
 #include "libi18n/i18n.h"
 using namespace LibRpBase;
 
@@ -29,16 +31,30 @@ using namespace LibRpBase;
 #include "librpfile/config.librpfile.h"
 #include "librpfile/FileSystem.hpp"
 #include "librpfile/RpFile.hpp"
+#include "librpfile/RpFile_mmap.hpp"
+#include "librpfile/RpStats.hpp"
+#include "librpfile/RpAllocStats.hpp"
 using namespace LibRpFile;
 
 // libromdata
 #include "libromdata/RomDataFactory.hpp"
+#include "libromdata/img/CacheManager.hpp"
+#include "libromdata/img/NegativeCache.hpp"
+using LibRomData::CacheManager;
+using LibRomData::NegativeCache;
 using LibRomData::RomDataFactory;
 
 // librptexture
 #include "librptexture/img/rp_image.hpp"
 using LibRpTexture::rp_image;
 
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::Mutex;
+using LibRpThreads::MutexLocker;
+using LibRpThreads::ThreadPool;
+
 #ifdef _WIN32
 // libwin32common
 # include "libwin32common/RpWin32_sdk.h"
@@ -47,6 +63,7 @@ using LibRpTexture::rp_image;
 #ifdef ENABLE_DECRYPTION
 # include "verifykeys.hpp"
 #endif /* ENABLE_DECRYPTION */
+#include "cpu_selftest.hpp"
 #include "device.hpp"
 
 // OS-specific userdirs
@@ -59,6 +76,11 @@ using LibRpTexture::rp_image;
 #endif
 #include "tcharx.h"
 
+// RapidJSON
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
 // C includes.
 #include <stdlib.h>
 
@@ -70,13 +92,19 @@ using LibRpTexture::rp_image;
 #include <fstream>
 #include <iostream>
 #include <locale>
+#include <map>
+#include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 using std::cout;
 using std::cerr;
 using std::endl;
+using std::ifstream;
+using std::istream;
 using std::locale;
 using std::ofstream;
+using std::ostringstream;
 using std::string;
 using std::vector;
 
@@ -97,71 +125,265 @@ struct ExtractParam {
 		: filename(filename), image_type(image_type) { }
 };
 
+/**
+ * Split a comma-separated list.
+ * Empty items are skipped.
+ * @param s List
+ * @param list [out] Items
+ */
+static void SplitList(const char *s, vector<string> &list)
+{
+	while (*s != '\0') {
+		const char *const comma = strchr(s, ',');
+		const size_t len = (comma ? static_cast<size_t>(comma - s) : strlen(s));
+		if (len > 0) {
+			list.emplace_back(s, len);
+		}
+		if (!comma)
+			break;
+		s = comma + 1;
+	}
+}
+
+/**
+ * Parse a language code.
+ * @param s_lang Language code string. (up to 4 characters)
+ * @return Language code, or 0 if invalid.
+ */
+static uint32_t ParseLanguageCode(const char *s_lang)
+{
+	if (!s_lang || s_lang[0] == '\0') {
+		return 0;
+	}
+
+	uint32_t lc = 0;
+	int pos;
+	for (pos = 0; pos < 4 && s_lang[pos] != '\0'; pos++) {
+		lc <<= 8;
+		lc |= (uint8_t)s_lang[pos];
+	}
+	if (pos == 4 && s_lang[pos] != '\0') {
+		// Invalid language code.
+		return 0;
+	}
+	return lc;
+}
+
+/**
+ * Image extraction job.
+ */
+struct ExtractJob {
+	string filename;	// Target filename.
+	int image_type;		// Image Type. -1 = iconAnimData
+	int mip;		// Mipmap number. (0 for the full image)
+
+	ExtractJob(const string &filename, int image_type, int mip = 0)
+		: filename(filename), image_type(image_type), mip(mip) { }
+};
+
+/**
+ * Short image type names for --extract-all filenames.
+ * Indexed by RomData::ImageType.
+ */
+static const char *const image_type_short_names[] = {
+	"icon", "banner", "media", "image",
+};
+static_assert(ARRAY_SIZE(image_type_short_names) == RomData::IMG_INT_MAX + 1,
+	"image_type_short_names[] is out of sync with RomData::ImageType.");
+
+/**
+ * Extract a single image.
+ * @param romData RomData containing the images
+ * @param job Image extraction job
+ * @param pngParams PNG compression parameters
+ * @return Messages to print.
+ */
+static string ExtractImage(const RomData *romData, const ExtractJob &job, const RpPngWriter::CompressionParams &pngParams)
+{
+	ostringstream oss;
+	const char *const filename = job.filename.c_str();
+	int errcode;
+
+	if (job.image_type >= 0) {
+		// normal image
+		const RomData::ImageType imageType = static_cast<RomData::ImageType>(job.image_type);
+		const rp_image *const image = romData->imageMipmap(imageType, job.mip);
+		if (!image || !image->isValid()) {
+			// TODO: Return an error code?
+			oss << "-- " <<
+				rp_sprintf(C_("rpcli", "Image '%s' not found"),
+					RomData::getImageTypeName(imageType)) << '\n';
+			return oss.str();
+		}
+
+		if (job.mip == 0) {
+			oss << "-- " <<
+				// tr: %1$s == image type name, %2$s == output filename
+				rp_sprintf_p(C_("rpcli", "Extracting %1$s into '%2$s'"),
+					RomData::getImageTypeName(imageType), filename) << '\n';
+		} else {
+			oss << "-- " <<
+				// tr: %1$s == image type name, %2$d == mipmap number, %3$s == output filename
+				rp_sprintf_p(C_("rpcli", "Extracting %1$s mipmap %2$d into '%3$s'"),
+					RomData::getImageTypeName(imageType), job.mip, filename) << '\n';
+		}
+		errcode = RpPng::save(filename, image, &pngParams);
+	} else {
+		// iconAnimData image
+		const IconAnimData *const iconAnimData = romData->iconAnimData();
+		if (!iconAnimData || iconAnimData->count == 0 || iconAnimData->seq_count == 0) {
+			// TODO: Return an error code?
+			oss << "-- " << C_("rpcli", "Animated icon not found") << '\n';
+			return oss.str();
+		}
+
+		oss << "-- " << rp_sprintf(C_("rpcli", "Extracting animated icon into '%s'"), filename) << '\n';
+		errcode = RpPng::save(filename, iconAnimData, &pngParams);
+		if (errcode == -ENOTSUP) {
+			oss << "   " << C_("rpcli", "APNG not supported, extracting only the first frame") << '\n';
+			// falling back to outputting the first frame
+			errcode = RpPng::save(filename, iconAnimData->frames[iconAnimData->seq_index[0]], &pngParams);
+		}
+	}
+
+	if (errcode != 0) {
+		// tr: %1$s == filename, %2%s == error message
+		oss << "   " <<
+			rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
+				filename, strerror(-errcode)) << '\n';
+	} else {
+		oss << "   " << C_("rpcli", "Done") << '\n';
+	}
+	return oss.str();
+}
+
 /**
 * Extracts images from romdata
+*
+* If more than one image is requested, the images are extracted
+* using a thread pool. Image decoding is serialized by RomData,
+* but PNG encoding for one image overlaps with decoding the next.
+*
 * @param romData RomData containing the images
 * @param extract Vector of image extraction parameters
+* @param pngParams PNG compression parameters (threads is also used for the thread pool)
+* @param extractAllPrefix If not nullptr, extract all internal images and mipmaps using this filename prefix.
 */
-static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract) {
-	int supported = romData->supportedImageTypes();
+static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract, const RpPngWriter::CompressionParams &pngParams, const char *extractAllPrefix = nullptr)
+{
+	vector<ExtractJob> jobs;
+	jobs.reserve(extract.size());
+	const uint32_t supported = romData->supportedImageTypes();
 	const auto extract_cend = extract.cend();
 	for (auto it = extract.cbegin(); it != extract_cend; ++it) {
 		if (!it->filename) continue;
-		bool found = false;
-		
-		if (it->image_type >= 0 && supported & (1U << it->image_type)) {
-			// normal image
-			auto image = romData->image((RomData::ImageType)it->image_type);
-			if (image && image->isValid()) {
-				found = true;
-				cerr << "-- " <<
-					// tr: %1$s == image type name, %2$s == output filename
-					rp_sprintf_p(C_("rpcli", "Extracting %1$s into '%2$s'"),
-						RomData::getImageTypeName((RomData::ImageType)it->image_type),
-						it->filename) << endl;
-				int errcode = RpPng::save(it->filename, image);
-				if (errcode != 0) {
-					// tr: %1$s == filename, %2%s == error message
-					cerr << rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
-						it->filename, strerror(-errcode)) << endl;
-				} else {
-					cerr << "   " << C_("rpcli", "Done") << endl;
-				}
-			}
+		if (it->image_type >= 0 && !(supported & (1U << it->image_type))) {
+			// TODO: Return an error code?
+			cerr << "-- " <<
+				rp_sprintf(C_("rpcli", "Image '%s' not found"),
+					RomData::getImageTypeName((RomData::ImageType)it->image_type)) << endl;
+			continue;
 		}
+		jobs.emplace_back(it->filename, it->image_type);
+	}
 
-		else if (it->image_type == -1) {
-			// iconAnimData image
-			auto iconAnimData = romData->iconAnimData();
-			if (iconAnimData && iconAnimData->count != 0 && iconAnimData->seq_count != 0) {
-				found = true;
-				cerr << "-- " << rp_sprintf(C_("rpcli", "Extracting animated icon into '%s'"), it->filename) << endl;
-				int errcode = RpPng::save(it->filename, iconAnimData);
-				if (errcode == -ENOTSUP) {
-					cerr << "   " << C_("rpcli", "APNG not supported, extracting only the first frame") << endl;
-					// falling back to outputting the first frame
-					errcode = RpPng::save(it->filename, iconAnimData->frames[iconAnimData->seq_index[0]]);
-				}
-				if (errcode != 0) {
-					cerr << "   " <<
-						rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
-							it->filename, strerror(-errcode)) << endl;
+	if (extractAllPrefix) {
+		// Extract all internal images, including mipmaps.
+		const string prefix(extractAllPrefix);
+		for (int i = RomData::IMG_INT_MIN; i <= RomData::IMG_INT_MAX; i++) {
+			if (!(supported & (1U << i)))
+				continue;
+
+			const RomData::ImageType imageType = static_cast<RomData::ImageType>(i);
+			const string base = prefix + '.' + image_type_short_names[i];
+			const int mipmapCount = romData->imageMipmapCount(imageType);
+			for (int mip = 0; mip < mipmapCount; mip++) {
+				if (mip == 0) {
+					jobs.emplace_back(base + ".png", i);
 				} else {
-					cerr << "   " << C_("rpcli", "Done") << endl;
+					jobs.emplace_back(rp_sprintf("%s.mip%d.png", base.c_str(), mip), i, mip);
 				}
 			}
-		}
-		if (!found) {
-			// TODO: Return an error code?
-			if (it->image_type == -1) {
-				cerr << "-- " << C_("rpcli", "Animated icon not found") << endl;
-			} else {
-				cerr << "-- " <<
-					rp_sprintf(C_("rpcli", "Image '%s' not found"),
-						RomData::getImageTypeName((RomData::ImageType)it->image_type)) << endl;
+
+			if (romData->imgpf(imageType) & RomData::IMGPF_ICON_ANIMATED) {
+				jobs.emplace_back(base + ".anim.png", -1);
 			}
 		}
 	}
+
+	if (jobs.size() <= 1) {
+		// Only one image. Extract it on this thread.
+		if (!jobs.empty()) {
+			cerr << ExtractImage(romData, jobs[0], pngParams);
+		}
+		return;
+	}
+
+	// NOTE: iconAnimData() isn't protected by the image loading
+	// mutex, so the animated icon is loaded before starting the
+	// thread pool. Later calls return the cached icon.
+	for (const ExtractJob &job : jobs) {
+		if (job.image_type < 0) {
+			romData->iconAnimData();
+			break;
+		}
+	}
+
+	Mutex outputMutex;
+	ThreadPool pool(pngParams.threads);
+	pool.parallelFor(jobs.size(), [&](size_t idx) {
+		const string msgs = ExtractImage(romData, jobs[idx], pngParams);
+
+		// Write the messages for this image in one piece.
+		MutexLocker locker(outputMutex);
+		cerr << msgs;
+		cerr.flush();
+	});
+}
+
+/**
+ * Run the data verification ROM operations, if any.
+ * This must be done before the fields are printed, since
+ * the results are added to the fields.
+ * @param romData RomData
+ * @return Status messages, one per line.
+ */
+static string RunVerifyOps(RomData *romData)
+{
+	static const uint32_t verifyFlags = RomData::RomOp::ROF_ENABLED | RomData::RomOp::ROF_VERIFY;
+
+	string msgs;
+	const vector<RomData::RomOp> ops = romData->romOps();
+	for (size_t i = 0; i < ops.size(); i++) {
+		if ((ops[i].flags & verifyFlags) != verifyFlags)
+			continue;
+
+		RomData::RomOpParams params;
+		romData->doRomOp(static_cast<int>(i), &params);
+		if (!params.msg.empty()) {
+			msgs += "-- ";
+			msgs += params.msg;
+			msgs += '\n';
+		}
+	}
+	return msgs;
+}
+
+/**
+ * Calculate whole-file checksums.
+ * This must be done before the fields are printed, since
+ * the checksums are added to the fields.
+ * @param romData RomData
+ * @return Error message, or empty string on success.
+ */
+static string CalcChecksums(RomData *romData)
+{
+	const int ret = romData->calcChecksums();
+	if (ret == 0) {
+		return string();
+	}
+	return rp_sprintf("-- %s\n", rp_sprintf(C_("rpcli", "Unable to calculate checksums: %s"),
+		strerror(-ret)).c_str());
 }
 
 /**
@@ -169,23 +391,39 @@ static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract)
  * @param filename ROM filename
  * @param json Is program running in json mode?
  * @param extract Vector of image extraction parameters
+ * @param pngParams PNG compression parameters for image extraction
  * @param languageCode Language code. (0 for default)
+ * @param verify If true, run the data verification ROM operations.
+ * @param checksums If true, calculate whole-file checksums.
+ * @param filter Output filter, or nullptr to show everything.
+ * @param extractAllPrefix If not nullptr, extract all internal images and mipmaps using this filename prefix.
  */
-static void DoFile(const char *filename, bool json, vector<ExtractParam>& extract, uint32_t languageCode = 0)
+static void DoFile(const char *filename, bool json, vector<ExtractParam>& extract, const RpPngWriter::CompressionParams &pngParams, uint32_t languageCode = 0, bool verify = false, bool checksums = false, const TextOutFilter *filter = nullptr, const char *extractAllPrefix = nullptr)
 {
 	cerr << "== " << rp_sprintf(C_("rpcli", "Reading file '%s'..."), filename) << endl;
-	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
+	IRpFile *const file = RpFile_mmap::openReadOnly(filename);
 	if (file->isOpen()) {
-		RomData *romData = RomDataFactory::create(file);
+		RomData *romData = RomDataFactory::create(file,
+			(filter && filter->metaDataOnly) ? RomDataFactory::RDA_METADATA_ONLY : 0);
 		if (romData && romData->isValid()) {
+			if (verify) {
+				cerr << RunVerifyOps(romData);
+			}
+			if (checksums) {
+				cerr << CalcChecksums(romData);
+			}
 			if (json) {
 				cerr << "-- " << C_("rpcli", "Outputting JSON data") << endl;
-				cout << JSONROMOutput(romData, languageCode) << endl;
+				JSONROMOutput jsonOut(romData, languageCode);
+				jsonOut.setFilter(filter);
+				cout << jsonOut << endl;
 			} else {
-				cout << ROMOutput(romData, languageCode) << endl;
+				ROMOutput romOut(romData, languageCode);
+				romOut.setFilter(filter);
+				cout << romOut << endl;
 			}
 
-			ExtractImages(romData, extract);
+			ExtractImages(romData, extract, pngParams, extractAllPrefix);
 		} else {
 			cerr << "-- " << C_("rpcli", "ROM is not supported") << endl;
 			if (json) cout << "{\"error\":\"rom is not supported\"}" << endl;
@@ -199,6 +437,987 @@ static void DoFile(const char *filename, bool json, vector<ExtractParam>& extrac
 	file->unref();
 }
 
+/**
+ * Escape a string for use as a JSON string value.
+ * @param str String
+ * @return Quoted and escaped JSON string.
+ */
+static string JSONString(const char *str)
+{
+	string ret;
+	ret.reserve(strlen(str) + 2);
+	ret += '"';
+	for (; *str != '\0'; str++) {
+		const uint8_t chr = static_cast<uint8_t>(*str);
+		switch (chr) {
+			case '"':	ret += "\\\""; break;
+			case '\\':	ret += "\\\\"; break;
+			case '\n':	ret += "\\n"; break;
+			case '\r':	ret += "\\r"; break;
+			case '\t':	ret += "\\t"; break;
+			default:
+				if (chr < 0x20) {
+					char buf[8];
+					snprintf(buf, sizeof(buf), "\\u%04X", chr);
+					ret += buf;
+				} else {
+					ret += static_cast<char>(chr);
+				}
+				break;
+		}
+	}
+	ret += '"';
+	return ret;
+}
+
+/**
+ * Read a list of filenames for batch mode.
+ * Each line is one filename. Empty lines are ignored.
+ * @param listfile List filename, or "-" for stdin.
+ * @param paths Vector to append the filenames to.
+ * @return 0 on success; non-zero on error.
+ */
+static int ReadBatchList(const char *listfile, vector<string> &paths)
+{
+	ifstream ifs;
+	istream *is = &std::cin;
+	if (strcmp(listfile, "-") != 0) {
+		ifs.open(listfile);
+		if (!ifs.is_open()) {
+			return -1;
+		}
+		is = &ifs;
+	}
+
+	string line;
+	while (std::getline(*is, line)) {
+		if (!line.empty() && line[line.size()-1] == '\r') {
+			line.resize(line.size()-1);
+		}
+		if (!line.empty()) {
+			paths.emplace_back(std::move(line));
+		}
+	}
+	return 0;
+}
+
+/**
+ * Show info about multiple files using a thread pool.
+ *
+ * In JSON mode, each file is written as a single-line JSON object
+ * tagged with its path (newline-delimited JSON), in completion order.
+ * In text mode, each file's output is written as a single block.
+ *
+ * @param paths Filenames
+ * @param json Is program running in json mode?
+ * @param threadCount Number of threads (0 for the number of CPUs)
+ * @param languageCode Language code. (0 for default)
+ * @param verify If true, run the data verification ROM operations.
+ * @param checksums If true, calculate whole-file checksums.
+ * @param filter Output filter, or nullptr to show everything.
+ */
+static void DoBatch(const vector<string> &paths, bool json, unsigned int threadCount, uint32_t languageCode, bool verify, bool checksums, const TextOutFilter *filter)
+{
+	Mutex outputMutex;
+	ThreadPool pool(threadCount);
+	cerr << "== " << rp_sprintf_p(C_("rpcli", "Processing %1$u files using %2$u threads..."),
+		static_cast<unsigned int>(paths.size()), pool.threadCount()) << endl;
+
+	pool.parallelFor(paths.size(), [&](size_t idx) {
+		const char *const filename = paths[idx].c_str();
+		ostringstream oss;
+		string err, verifyMsgs;
+
+		IRpFile *const file = RpFile_mmap::openReadOnly(filename);
+		if (file->isOpen()) {
+			RomData *romData = RomDataFactory::create(file,
+				(filter && filter->metaDataOnly) ? RomDataFactory::RDA_METADATA_ONLY : 0);
+			if (romData && romData->isValid()) {
+				if (verify) {
+					verifyMsgs = RunVerifyOps(romData);
+				}
+				if (checksums) {
+					verifyMsgs += CalcChecksums(romData);
+				}
+				if (json) {
+					JSONROMOutput jsonOut(romData, languageCode);
+					jsonOut.setCompact(true);
+					jsonOut.setPath(filename);
+					jsonOut.setFilter(filter);
+					oss << jsonOut << '\n';
+				} else {
+					ROMOutput romOut(romData, languageCode);
+					romOut.setFilter(filter);
+					oss << "== " << filename << '\n';
+					oss << romOut << '\n';
+				}
+			} else {
+				err = rp_sprintf("%s: %s", filename, C_("rpcli", "ROM is not supported"));
+				if (json) {
+					oss << "{\"path\":" << JSONString(filename) <<
+						",\"error\":\"rom is not supported\"}\n";
+				}
+			}
+			UNREF(romData);
+		} else {
+			err = rp_sprintf("%s: %s", filename,
+				rp_sprintf(C_("rpcli", "Couldn't open file: %s"), strerror(file->lastError())).c_str());
+			if (json) {
+				oss << "{\"path\":" << JSONString(filename) <<
+					",\"error\":\"couldn't open file\",\"code\":" << file->lastError() << "}\n";
+			}
+		}
+		file->unref();
+
+		// Write the output for this file in one piece.
+		MutexLocker locker(outputMutex);
+		if (!verifyMsgs.empty()) {
+			cerr << "== " << filename << '\n' << verifyMsgs;
+			cerr.flush();
+		}
+		if (!err.empty()) {
+			cerr << "-- " << err << endl;
+		}
+		cout << oss.str();
+		cout.flush();
+	});
+}
+
+/**
+ * Maximum number of simultaneous downloads from a single server
+ * in prefetch mode. This matches rp-download's per-host limit.
+ */
+static const unsigned int PREFETCH_MAX_HOST_DOWNLOADS = 4;
+
+// Set if the rp-download daemon couldn't be started in prefetch mode.
+static bool prefetchDaemonFailed = false;
+
+/**
+ * External image to download in prefetch mode.
+ * The cache keys are tried in order until one of them
+ * is downloaded, the same way the thumbnailer does.
+ */
+struct PrefetchJob {
+	string host;			// Server hostname (from the first URL)
+	vector<string> cache_keys;	// Cache keys
+	string cached_key;		// Cache key that's already cached, if any
+};
+
+/**
+ * Get the hostname from a URL.
+ * @param url URL
+ * @return Hostname, or empty string if not found.
+ */
+static string HostFromUrl(const string &url)
+{
+	size_t pos = url.find("://");
+	pos = (pos != string::npos ? pos + 3 : 0);
+	const size_t end = url.find('/', pos);
+	return url.substr(pos, (end != string::npos ? end - pos : string::npos));
+}
+
+/**
+ * Recursively get the names of all regular files in a directory.
+ * @param dirname Directory name
+ * @param paths Vector to append the filenames to.
+ */
+static void ScanDirTree(const string &dirname, vector<string> &paths)
+{
+	vector<string> vEntries, vSubdirs;
+	if (FileSystem::read_dir(dirname, vEntries, &vSubdirs) != 0) {
+		cerr << "-- " << rp_sprintf(C_("rpcli", "Couldn't read directory '%s'"), dirname.c_str()) << endl;
+		return;
+	}
+
+	string prefix = dirname;
+	if (!prefix.empty() && prefix[prefix.size()-1] != static_cast<char>(DIR_SEP_CHR)) {
+		prefix += static_cast<char>(DIR_SEP_CHR);
+	}
+	for (const string &entry : vEntries) {
+		paths.emplace_back(prefix + entry);
+	}
+	for (const string &subdir : vSubdirs) {
+		ScanDirTree(prefix + subdir, paths);
+	}
+}
+
+/**
+ * Get the external images to download for a ROM image.
+ *
+ * All external image types in the class's image type priority list
+ * are included, since the thumbnailer falls back to lower-priority
+ * image types if a higher-priority image isn't available.
+ *
+ * @param romData RomData object
+ * @param config Config object
+ * @param jobs Vector to append the external images to.
+ */
+static void GetPrefetchJobs(const RomData *romData, const Config *config, vector<PrefetchJob> &jobs)
+{
+	Config::ImgTypePrio_t imgTypePrio;
+	switch (config->getImgTypePrio(romData->classId(), &imgTypePrio)) {
+		case Config::ImgTypeResult::IMGTR_SUCCESS:
+		case Config::ImgTypeResult::IMGTR_SUCCESS_DEFAULTS:
+			break;
+		default:
+			// Thumbnails are disabled for this class,
+			// or an error occurred.
+			return;
+	}
+
+	const uint32_t imgbf = romData->supportedImageTypes();
+	const bool downloadHighResScans = config->downloadHighResScans();
+	for (unsigned int i = 0; i < imgTypePrio.length; i++) {
+		const RomData::ImageType imgType =
+			static_cast<RomData::ImageType>(imgTypePrio.imgTypes[i]);
+		if (imgType < RomData::IMG_EXT_MIN || imgType > RomData::IMG_EXT_MAX ||
+		    !(imgbf & (1U << imgType)))
+		{
+			// Not an external image type, or not supported.
+			continue;
+		}
+
+		vector<RomData::ExtURL> extURLs;
+		if (romData->extURLs(imgType, &extURLs) != 0) {
+			continue;
+		}
+
+		PrefetchJob job;
+		for (const RomData::ExtURL &extURL : extURLs) {
+			if (!downloadHighResScans && extURL.high_res) {
+				// High-resolution downloads are disabled.
+				continue;
+			}
+			if (NegativeCache::isMissing(extURL.cache_key)) {
+				// Recently found to be missing on the server.
+				continue;
+			}
+			if (job.cache_keys.empty()) {
+				job.host = HostFromUrl(extURL.url);
+			}
+			job.cache_keys.push_back(extURL.cache_key);
+		}
+		if (!job.cache_keys.empty()) {
+			jobs.emplace_back(std::move(job));
+		}
+	}
+}
+
+/**
+ * Download external images for all ROM images in the specified
+ * directories, so the thumbnailer can use the cached images.
+ *
+ * Downloads from different servers run concurrently, with up to
+ * PREFETCH_MAX_HOST_DOWNLOADS simultaneous downloads per server.
+ *
+ * @param dirs Directories
+ * @param threadCount Number of threads for scanning files (0 for the number of CPUs)
+ * @param revalidate If true, check if cached images were updated on the server.
+ * @return 0 on success; non-zero on error.
+ */
+static int DoPrefetch(const vector<string> &dirs, unsigned int threadCount, bool revalidate)
+{
+	const Config *const config = Config::instance();
+	if (!config->extImgDownloadEnabled()) {
+		cerr << C_("rpcli", "External image downloads are disabled in the configuration.") << endl;
+		return EXIT_FAILURE;
+	}
+	if (prefetchDaemonFailed) {
+		cerr << C_("rpcli", "Unable to start rp-download.") << endl;
+		return EXIT_FAILURE;
+	}
+
+	vector<string> paths;
+	for (const string &dir : dirs) {
+		ScanDirTree(dir, paths);
+	}
+
+	// Get the external images for each ROM image.
+	// Images that are shared by multiple ROM images
+	// are only downloaded once.
+	Mutex jobsMutex;
+	vector<PrefetchJob> jobs;
+	std::unordered_set<string> seenKeys;
+	{
+		ThreadPool pool(threadCount);
+		cerr << "== " << rp_sprintf_p(C_("rpcli", "Scanning %1$u files using %2$u threads..."),
+			static_cast<unsigned int>(paths.size()), pool.threadCount()) << endl;
+
+		pool.parallelFor(paths.size(), [&](size_t idx) {
+			IRpFile *const file = RpFile_mmap::openReadOnly(paths[idx].c_str());
+			if (!file->isOpen()) {
+				file->unref();
+				return;
+			}
+			RomData *romData = RomDataFactory::create(file);
+			file->unref();
+
+			vector<PrefetchJob> romJobs;
+			if (romData && romData->isValid()) {
+				GetPrefetchJobs(romData, config, romJobs);
+			}
+			UNREF(romData);
+
+			MutexLocker locker(jobsMutex);
+			for (PrefetchJob &job : romJobs) {
+				if (seenKeys.insert(job.cache_keys[0]).second) {
+					jobs.emplace_back(std::move(job));
+				}
+			}
+		});
+	}
+
+	// Skip images that are already cached, unless revalidating,
+	// and group the rest by server.
+	CacheManager cache;
+	unsigned int alreadyCached = 0;
+	std::map<string, vector<const PrefetchJob*> > hostJobs;
+	for (PrefetchJob &job : jobs) {
+		for (const string &cache_key : job.cache_keys) {
+			if (!cache.findInCache(cache_key).empty()) {
+				job.cached_key = cache_key;
+				break;
+			}
+		}
+		if (!job.cached_key.empty() && !revalidate) {
+			alreadyCached++;
+		} else {
+			hostJobs[job.host].push_back(&job);
+		}
+	}
+
+	// Each server's images are split into up to PREFETCH_MAX_HOST_DOWNLOADS
+	// lanes, and each lane downloads its images one at a time.
+	// NOTE: CacheManager's download limit is disabled, since
+	// the lanes limit the simultaneous downloads instead.
+	struct Lane {
+		const vector<const PrefetchJob*> *jobs;
+		unsigned int first;
+		unsigned int step;
+	};
+	vector<Lane> lanes;
+	size_t toDownload = 0;
+	for (const auto &p : hostJobs) {
+		const unsigned int count = static_cast<unsigned int>(
+			std::min<size_t>(p.second.size(), PREFETCH_MAX_HOST_DOWNLOADS));
+		for (unsigned int i = 0; i < count; i++) {
+			lanes.push_back({&p.second, i, count});
+		}
+		toDownload += p.second.size();
+	}
+
+	unsigned int downloaded = 0, failed = 0;
+	unsigned int revalidated = 0, revalidateFailed = 0;
+	if (!lanes.empty()) {
+		cerr << "== " << rp_sprintf_p(C_("rpcli", "Checking %1$u images from %2$u servers..."),
+			static_cast<unsigned int>(toDownload), static_cast<unsigned int>(hostJobs.size())) << endl;
+
+		Mutex countMutex;
+		ThreadPool pool(static_cast<unsigned int>(lanes.size()));
+		pool.parallelFor(lanes.size(), [&](size_t idx) {
+			const Lane &lane = lanes[idx];
+			CacheManager dlCache;
+			dlCache.setLimitDownloads(false);
+
+			unsigned int laneDownloaded = 0, laneFailed = 0;
+			unsigned int laneRevalidated = 0, laneRevalidateFailed = 0;
+			for (size_t i = lane.first; i < lane.jobs->size(); i += lane.step) {
+				const PrefetchJob *const job = (*lane.jobs)[i];
+				if (!job->cached_key.empty()) {
+					// Check if the cached image was updated.
+					if (dlCache.revalidate(job->cached_key) == 0) {
+						laneRevalidated++;
+					} else {
+						laneRevalidateFailed++;
+					}
+					continue;
+				}
+
+				bool ok = false;
+				for (const string &cache_key : job->cache_keys) {
+					if (!dlCache.download(cache_key).empty()) {
+						ok = true;
+						break;
+					}
+				}
+				if (ok) {
+					laneDownloaded++;
+				} else {
+					laneFailed++;
+				}
+			}
+
+			MutexLocker locker(countMutex);
+			downloaded += laneDownloaded;
+			failed += laneFailed;
+			revalidated += laneRevalidated;
+			revalidateFailed += laneRevalidateFailed;
+		});
+	}
+
+	if (revalidate) {
+		cerr << "== " << rp_sprintf_p(C_("rpcli",
+			"Prefetch complete: %1$u downloaded, %2$u not available, %3$u revalidated, %4$u couldn't be revalidated."),
+			downloaded, failed, revalidated, revalidateFailed) << endl;
+	} else {
+		cerr << "== " << rp_sprintf_p(C_("rpcli",
+			"Prefetch complete: %1$u downloaded, %2$u not available, %3$u already cached."),
+			downloaded, failed, alreadyCached) << endl;
+	}
+	return 0;
+}
+
+/** Service mode **/
+
+/**
+ * Maximum number of open handles in service mode.
+ * This prevents a client that never closes its handles
+ * from keeping an unlimited number of files open.
+ */
+static const unsigned int SERVICE_MAX_HANDLES = 256;
+
+// JSON-RPC 2.0 error codes.
+enum ServiceError {
+	SERVICE_PARSE_ERROR	= -32700,
+	SERVICE_INVALID_REQUEST	= -32600,
+	SERVICE_METHOD_NOT_FOUND = -32601,
+	SERVICE_INVALID_PARAMS	= -32602,
+
+	// Application-defined errors.
+	SERVICE_OPEN_FAILED	= -32000,	// Couldn't open the file.
+	SERVICE_NOT_SUPPORTED	= -32001,	// ROM is not supported.
+	SERVICE_INVALID_HANDLE	= -32002,	// Handle is not open.
+	SERVICE_TOO_MANY_HANDLES = -32003,	// Too many open handles.
+	SERVICE_IMAGE_NOT_FOUND	= -32004,	// Image is not available.
+	SERVICE_WRITE_FAILED	= -32005,	// Couldn't write the output file.
+};
+
+/**
+ * Service mode state.
+ *
+ * Requests are handled one at a time, in order. RomData objects
+ * opened with "open" stay open until "close" is called, so field
+ * data, metadata, and images are only loaded once per file.
+ */
+class RpcliService
+{
+	public:
+		RpcliService(uint32_t languageCode, const RpPngWriter::CompressionParams &pngParams)
+			: quit(false)
+			, languageCode(languageCode)
+			, pngParams(pngParams)
+			, nextHandle(1)
+		{ }
+
+		~RpcliService()
+		{
+			for (auto &p : handles) {
+				p.second->unref();
+			}
+		}
+
+	private:
+		RP_DISABLE_COPY(RpcliService)
+
+	public:
+		// Set by the "shutdown" method.
+		bool quit;
+
+	private:
+		uint32_t languageCode;
+		RpPngWriter::CompressionParams pngParams;
+
+		// Open RomData objects.
+		// Key: Handle
+		std::map<unsigned int, RomData*> handles;
+		unsigned int nextHandle;
+
+	private:
+		typedef rapidjson::Writer<rapidjson::StringBuffer> JsonWriter;
+
+		/**
+		 * Write a JSON-RPC error response.
+		 * @param id Request ID (raw JSON)
+		 * @param code Error code
+		 */
+		static void writeError(const string &id, int code)
+		{
+			rapidjson::StringBuffer sb;
+			JsonWriter writer(sb);
+			writer.StartObject();
+			writer.Key("code"); writer.Int(code);
+			writer.Key("message"); writer.String(errorMessage(code));
+			writer.EndObject();
+
+			cout << "{\"jsonrpc\":\"2.0\",\"id\":" << id << ",\"error\":" << sb.GetString() << "}\n";
+			cout.flush();
+		}
+
+		/**
+		 * Write a JSON-RPC result response.
+		 * @param id Request ID (raw JSON)
+		 * @param result Result (raw JSON)
+		 */
+		static void writeResult(const string &id, const char *result)
+		{
+			cout << "{\"jsonrpc\":\"2.0\",\"id\":" << id << ",\"result\":" << result << "}\n";
+			cout.flush();
+		}
+
+		/**
+		 * Get an error message for a service error code.
+		 * @param code Error code
+		 * @return Error message
+		 */
+		static const char *errorMessage(int code)
+		{
+			switch (code) {
+				case SERVICE_PARSE_ERROR:	return "parse error";
+				case SERVICE_INVALID_REQUEST:	return "invalid request";
+				case SERVICE_METHOD_NOT_FOUND:	return "method not found";
+				case SERVICE_INVALID_PARAMS:	return "invalid params";
+				case SERVICE_OPEN_FAILED:	return "couldn't open file";
+				case SERVICE_NOT_SUPPORTED:	return "rom is not supported";
+				case SERVICE_INVALID_HANDLE:	return "invalid handle";
+				case SERVICE_TOO_MANY_HANDLES:	return "too many open handles";
+				case SERVICE_IMAGE_NOT_FOUND:	return "image not found";
+				case SERVICE_WRITE_FAILED:	return "couldn't write file";
+				default:			return "unknown error";
+			}
+		}
+
+		/**
+		 * Open a RomData object.
+		 * @param path Filename
+		 * @param pErr [out] Error code on error.
+		 * @param attrs RomDataFactory::RomDataAttr bitfield.
+		 * @return RomData object, or nullptr on error.
+		 */
+		static RomData *openRomData(const char *path, int *pErr, unsigned int attrs = 0)
+		{
+			IRpFile *const file = RpFile_mmap::openReadOnly(path);
+			if (!file->isOpen()) {
+				*pErr = SERVICE_OPEN_FAILED;
+				file->unref();
+				return nullptr;
+			}
+
+			RomData *romData = RomDataFactory::create(file, attrs);
+			file->unref();
+			if (!romData || !romData->isValid()) {
+				*pErr = SERVICE_NOT_SUPPORTED;
+				UNREF(romData);
+				return nullptr;
+			}
+			return romData;
+		}
+
+		/**
+		 * Get the RomData object for a request.
+		 * If params has "handle", the open RomData object is used.
+		 * Otherwise, the file specified by "path" is opened.
+		 * @param params Request parameters
+		 * @param pErr [out] Error code on error.
+		 * @param attrs RomDataFactory::RomDataAttr bitfield for "path".
+		 * @return RomData object (ref()'d; caller must unref()), or nullptr on error.
+		 */
+		RomData *getRomData(const rapidjson::Value &params, int *pErr, unsigned int attrs = 0)
+		{
+			auto iter = params.FindMember("handle");
+			if (iter != params.MemberEnd()) {
+				if (!iter->value.IsUint()) {
+					*pErr = SERVICE_INVALID_PARAMS;
+					return nullptr;
+				}
+				auto h = handles.find(iter->value.GetUint());
+				if (h == handles.end()) {
+					*pErr = SERVICE_INVALID_HANDLE;
+					return nullptr;
+				}
+				return h->second->ref();
+			}
+
+			iter = params.FindMember("path");
+			if (iter == params.MemberEnd() || !iter->value.IsString()) {
+				*pErr = SERVICE_INVALID_PARAMS;
+				return nullptr;
+			}
+			return openRomData(iter->value.GetString(), pErr, attrs);
+		}
+
+		/**
+		 * Read a list of strings from a request parameter.
+		 * @param params Request parameters
+		 * @param name Parameter name
+		 * @param list [out] List of strings
+		 * @return True on success; false if the parameter isn't an array of strings.
+		 */
+		static bool getStringList(const rapidjson::Value &params, const char *name, vector<string> &list)
+		{
+			auto iter = params.FindMember(name);
+			if (iter == params.MemberEnd()) {
+				return true;
+			} else if (!iter->value.IsArray()) {
+				return false;
+			}
+			for (const auto &v : iter->value.GetArray()) {
+				if (!v.IsString()) {
+					return false;
+				}
+				list.emplace_back(v.GetString(), v.GetStringLength());
+			}
+			return true;
+		}
+
+		/** Methods **/
+
+		/**
+		 * "open": Open a file and keep it open.
+		 * params: {"path": string}
+		 * result: {"handle": uint, "system": string, "filetype": string}
+		 * @return 0 on success; error code on error.
+		 */
+		int do_open(const string &id, const rapidjson::Value &params)
+		{
+			auto iter = params.FindMember("path");
+			if (iter == params.MemberEnd() || !iter->value.IsString()) {
+				return SERVICE_INVALID_PARAMS;
+			} else if (handles.size() >= SERVICE_MAX_HANDLES) {
+				return SERVICE_TOO_MANY_HANDLES;
+			}
+
+			int err = 0;
+			RomData *const romData = openRomData(iter->value.GetString(), &err);
+			if (!romData) {
+				return err;
+			}
+
+			const unsigned int handle = nextHandle++;
+			handles.emplace(handle, romData);
+
+			const char *const systemName = romData->systemName(
+				RomData::SYSNAME_TYPE_LONG | RomData::SYSNAME_REGION_ROM_LOCAL);
+			const char *const fileType = romData->fileType_string();
+
+			rapidjson::StringBuffer sb;
+			JsonWriter writer(sb);
+			writer.StartObject();
+			writer.Key("handle"); writer.Uint(handle);
+			writer.Key("system"); writer.String(systemName ? systemName : "unknown");
+			writer.Key("filetype"); writer.String(fileType ? fileType : "unknown");
+			writer.EndObject();
+			writeResult(id, sb.GetString());
+			return 0;
+		}
+
+		/**
+		 * "close": Close a file.
+		 * params: {"handle": uint}
+		 * result: true
+		 * @return 0 on success; error code on error.
+		 */
+		int do_close(const string &id, const rapidjson::Value &params)
+		{
+			auto iter = params.FindMember("handle");
+			if (iter == params.MemberEnd() || !iter->value.IsUint()) {
+				return SERVICE_INVALID_PARAMS;
+			}
+			auto h = handles.find(iter->value.GetUint());
+			if (h == handles.end()) {
+				return SERVICE_INVALID_HANDLE;
+			}
+			h->second->unref();
+			handles.erase(h);
+			writeResult(id, "true");
+			return 0;
+		}
+
+		/**
+		 * "fields": Get the ROM information, in the same format as `rpcli -j`.
+		 * params: {"handle": uint} or {"path": string},
+		 *         optional "lang": string, "verify": bool, "checksums": bool,
+		 *         "tabs": [string], "fields": [string] (see TextOutFilter)
+		 * result: ROM information object
+		 * @return 0 on success; error code on error.
+		 */
+		int do_fields(const string &id, const rapidjson::Value &params)
+		{
+			uint32_t lc = languageCode;
+			auto iter = params.FindMember("lang");
+			if (iter != params.MemberEnd()) {
+				lc = (iter->value.IsString() ? ParseLanguageCode(iter->value.GetString()) : 0);
+				if (lc == 0) {
+					return SERVICE_INVALID_PARAMS;
+				}
+			}
+
+			TextOutFilter filter;
+			if (!getStringList(params, "tabs", filter.tabs) ||
+			    !getStringList(params, "fields", filter.fields))
+			{
+				return SERVICE_INVALID_PARAMS;
+			}
+
+			int err = 0;
+			RomData *const romData = getRomData(params, &err);
+			if (!romData) {
+				return err;
+			}
+
+			// Verification and checksums must be done before the
+			// fields are written. Messages are written to stderr.
+			iter = params.FindMember("verify");
+			if (iter != params.MemberEnd() && iter->value.IsTrue()) {
+				cerr << RunVerifyOps(romData);
+			}
+			iter = params.FindMember("checksums");
+			if (iter != params.MemberEnd() && iter->value.IsTrue()) {
+				cerr << CalcChecksums(romData);
+			}
+
+			JSONROMOutput jsonOut(romData, lc);
+			jsonOut.setCompact(true);
+			jsonOut.setFilter(&filter);
+			cout << "{\"jsonrpc\":\"2.0\",\"id\":" << id << ",\"result\":" << jsonOut << "}\n";
+			cout.flush();
+
+			romData->unref();
+			return 0;
+		}
+
+		/**
+		 * "metadata": Get the metadata properties.
+		 * params: {"handle": uint} or {"path": string}
+		 * result: {"<property name>": value, ...}
+		 * @return 0 on success; error code on error.
+		 */
+		int do_metadata(const string &id, const rapidjson::Value &params)
+		{
+			// If a path is specified, only the metadata is needed.
+			int err = 0;
+			RomData *const romData = getRomData(params, &err, RomDataFactory::RDA_METADATA_ONLY);
+			if (!romData) {
+				return err;
+			}
+
+			rapidjson::StringBuffer sb;
+			JsonWriter writer(sb);
+			writer.StartObject();
+			const RomMetaData *const metaData = romData->metaData();
+			const int count = (metaData ? metaData->count() : 0);
+			for (int i = 0; i < count; i++) {
+				const RomMetaData::MetaData *const prop = metaData->prop(i);
+				const char *const name = (prop ? RomMetaData::getPropertyName(prop->name) : nullptr);
+				if (!name)
+					continue;
+
+				writer.Key(name);
+				switch (prop->type) {
+					case PropertyType::Integer:
+						writer.Int(prop->data.ivalue);
+						break;
+					case PropertyType::UnsignedInteger:
+						writer.Uint(prop->data.uvalue);
+						break;
+					case PropertyType::String:
+						if (prop->data.str) {
+							writer.String(prop->data.str->data(),
+								static_cast<rapidjson::SizeType>(prop->data.str->size()));
+						} else {
+							writer.Null();
+						}
+						break;
+					case PropertyType::Timestamp:
+						writer.Int64(static_cast<int64_t>(prop->data.timestamp));
+						break;
+					default:
+						writer.Null();
+						break;
+				}
+			}
+			writer.EndObject();
+			writeResult(id, sb.GetString());
+
+			romData->unref();
+			return 0;
+		}
+
+		/**
+		 * "extract-image": Extract an internal image to a PNG file.
+		 * params: {"handle": uint} or {"path": string},
+		 *         "type": int (RomData::ImageType, or -1 for the animated icon),
+		 *         "out": string (output filename)
+		 * result: {"width": int, "height": int}
+		 * @return 0 on success; error code on error.
+		 */
+		int do_extract_image(const string &id, const rapidjson::Value &params)
+		{
+			auto iter_type = params.FindMember("type");
+			auto iter_out = params.FindMember("out");
+			if (iter_type == params.MemberEnd() || !iter_type->value.IsInt() ||
+			    iter_out == params.MemberEnd() || !iter_out->value.IsString())
+			{
+				return SERVICE_INVALID_PARAMS;
+			}
+			const int imageType = iter_type->value.GetInt();
+			if (imageType < -1 || imageType > RomData::IMG_INT_MAX) {
+				return SERVICE_INVALID_PARAMS;
+			}
+			const char *const out = iter_out->value.GetString();
+
+			int err = 0;
+			RomData *const romData = getRomData(params, &err);
+			if (!romData) {
+				return err;
+			}
+
+			// Get the image.
+			const rp_image *image = nullptr;
+			const IconAnimData *iconAnimData = nullptr;
+			if (imageType >= 0) {
+				// Internal image.
+				if (romData->supportedImageTypes() & (1U << imageType)) {
+					image = romData->image(static_cast<RomData::ImageType>(imageType));
+				}
+			} else {
+				// Animated icon.
+				iconAnimData = romData->iconAnimData();
+				if (iconAnimData && iconAnimData->count != 0 && iconAnimData->seq_count != 0) {
+					image = iconAnimData->frames[iconAnimData->seq_index[0]];
+				}
+			}
+			if (!image || !image->isValid()) {
+				romData->unref();
+				return SERVICE_IMAGE_NOT_FOUND;
+			}
+
+			int errcode;
+			if (iconAnimData) {
+				errcode = RpPng::save(out, iconAnimData, &pngParams);
+				if (errcode == -ENOTSUP) {
+					// APNG isn't supported. Save the first frame.
+					errcode = RpPng::save(out, image, &pngParams);
+				}
+			} else {
+				errcode = RpPng::save(out, image, &pngParams);
+			}
+
+			rapidjson::StringBuffer sb;
+			JsonWriter writer(sb);
+			writer.StartObject();
+			writer.Key("width"); writer.Int(image->width());
+			writer.Key("height"); writer.Int(image->height());
+			writer.EndObject();
+			romData->unref();
+
+			if (errcode != 0) {
+				return SERVICE_WRITE_FAILED;
+			}
+			writeResult(id, sb.GetString());
+			return 0;
+		}
+
+	public:
+		/**
+		 * Handle a single request.
+		 * @param line Request (one line of JSON)
+		 */
+		void handleRequest(const string &line)
+		{
+			rapidjson::Document doc;
+			doc.Parse(line.c_str(), line.size());
+			if (doc.HasParseError()) {
+				writeError("null", SERVICE_PARSE_ERROR);
+				return;
+			} else if (!doc.IsObject()) {
+				writeError("null", SERVICE_INVALID_REQUEST);
+				return;
+			}
+
+			// Request ID. This is echoed in the response as-is.
+			string id = "null";
+			auto iter = doc.FindMember("id");
+			if (iter != doc.MemberEnd()) {
+				rapidjson::StringBuffer sb;
+				JsonWriter writer(sb);
+				iter->value.Accept(writer);
+				id.assign(sb.GetString(), sb.GetSize());
+			}
+
+			iter = doc.FindMember("method");
+			if (iter == doc.MemberEnd() || !iter->value.IsString()) {
+				writeError(id, SERVICE_INVALID_REQUEST);
+				return;
+			}
+			const char *const method = iter->value.GetString();
+
+			// Parameters must be an object, if specified.
+			const rapidjson::Value emptyParams(rapidjson::kObjectType);
+			const rapidjson::Value *params = &emptyParams;
+			iter = doc.FindMember("params");
+			if (iter != doc.MemberEnd()) {
+				if (!iter->value.IsObject()) {
+					writeError(id, SERVICE_INVALID_PARAMS);
+					return;
+				}
+				params = &iter->value;
+			}
+
+			int err;
+			if (!strcmp(method, "open")) {
+				err = do_open(id, *params);
+			} else if (!strcmp(method, "close")) {
+				err = do_close(id, *params);
+			} else if (!strcmp(method, "fields")) {
+				err = do_fields(id, *params);
+			} else if (!strcmp(method, "metadata")) {
+				err = do_metadata(id, *params);
+			} else if (!strcmp(method, "extract-image")) {
+				err = do_extract_image(id, *params);
+			} else if (!strcmp(method, "shutdown")) {
+				quit = true;
+				writeResult(id, "true");
+				err = 0;
+			} else {
+				err = SERVICE_METHOD_NOT_FOUND;
+			}
+
+			if (err != 0) {
+				writeError(id, err);
+			}
+		}
+};
+
+/**
+ * Run in service mode.
+ *
+ * Newline-delimited JSON-RPC 2.0 requests are read from stdin,
+ * and one response line is written to stdout for each request.
+ * The process, including the security sandbox, configuration,
+ * and keys, is initialized once for the entire session.
+ *
+ * @param languageCode Default language code. (0 for default)
+ * @param pngParams PNG compression parameters for image extraction
+ * @return 0 on success; non-zero on error.
+ */
+static int DoService(uint32_t languageCode, const RpPngWriter::CompressionParams &pngParams)
+{
+	cerr << "== " << C_("rpcli", "Service mode: reading JSON-RPC requests from stdin.") << endl;
+
+	RpcliService service(languageCode, pngParams);
+	string line;
+	while (!service.quit && std::getline(std::cin, line)) {
+		if (!line.empty() && line[line.size()-1] == '\r') {
+			line.resize(line.size()-1);
+		}
+		if (line.empty()) {
+			continue;
+		}
+		service.handleRequest(line);
+	}
+	return 0;
+}
+
 /**
  * Print the system region information.
  */
@@ -252,6 +1471,32 @@ static void PrintPathnames(void)
 	cout << endl;
 }
 
+/**
+ * Print the runtime statistics counters.
+ * NOTE: Printed to stderr so JSON output isn't affected.
+ */
+static void PrintStats(void)
+{
+	cerr << "-- " << C_("rpcli", "Statistics:") << endl;
+	for (int i = 0; i < RpStats::COUNTER_MAX; i++) {
+		const RpStats::Counter counter = static_cast<RpStats::Counter>(i);
+		cerr << "   " << RpStats::name(counter) << ": " << RpStats::get(counter) << endl;
+	}
+
+	// Allocation statistics are only available if enabled at compile time.
+	if (!RpAllocStats::isEnabled())
+		return;
+	for (int i = 0; i < RpAllocStats::TAG_MAX; i++) {
+		const RpAllocStats::Tag tag = static_cast<RpAllocStats::Tag>(i);
+		RpAllocStats::Counters counters;
+		RpAllocStats::get(tag, &counters);
+		const char *const name = RpAllocStats::name(tag);
+		cerr << "   alloc_" << name << "_count: " << counters.count << endl;
+		cerr << "   alloc_" << name << "_bytes: " << counters.bytes << endl;
+		cerr << "   alloc_" << name << "_peak: " << counters.peak << endl;
+	}
+}
+
 #ifdef RP_OS_SCSI_SUPPORTED
 /**
  * Run a SCSI INQUIRY command on a device.
@@ -317,8 +1562,36 @@ static void DoAtaIdentifyDevice(const char *filename, bool json, bool packet)
 
 int RP_C_API main(int argc, char *argv[])
 {
+	// Check for prefetch mode, which runs rp-download.
+	// Also check if translations should be disabled, since
+	// this has to be done before any strings are translated.
+	bool prefetch = false;
+	bool serve = false;
+	bool no_translate = false;
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--prefetch")) {
+			prefetch = true;
+		} else if (!strcmp(argv[i], "--serve")) {
+			serve = true;
+		} else if (!strcmp(argv[i], "--no-translate")) {
+			no_translate = true;
+		}
+	}
+
+#ifndef _WIN32
+	// Prefetch mode: rp-download can't be run once the security
+	// options are enabled, so start the rp-download daemon first.
+	// The daemon keeps running while we're connected to it.
+	// NOTE: The socket is closed when rpcli exits.
+	if (prefetch) {
+		CacheManager cache;
+		prefetchDaemonFailed = (cache.startRpDownloadDaemon() < 0);
+		CacheManager::setDaemonOnly(true);
+	}
+#endif /* !_WIN32 */
+
 	// Enable security options.
-	rpcli_do_security_options();
+	rpcli_do_security_options(prefetch);
 
 	// Set the C and C++ locales.
 	locale::global(locale(""));
@@ -341,20 +1614,58 @@ int RP_C_API main(int argc, char *argv[])
 
 	// Initialize i18n.
 	rp_i18n_init();
+	if (no_translate) {
+		rp_i18n_set_enabled(0);
+	}
 
 	if(argc < 2){
 #ifdef ENABLE_DECRYPTION
-		cerr << C_("rpcli", "Usage: rpcli [-k] [-c] [-p] [-j] [-l lang] [[-x[b]N outfile]... [-a apngoutfile] filename]...") << endl;
+		cerr << C_("rpcli", "Usage: rpcli [-k] [-c] [-p] [-j] [-V] [-H] [-l lang] [-zN] [[-x[b]N outfile]... [-a apngoutfile] filename]...") << endl;
 		cerr << "  -k:   " << C_("rpcli", "Verify encryption keys in keys.conf.") << endl;
 #else /* !ENABLE_DECRYPTION */
-		cerr << C_("rpcli", "Usage: rpcli [-c] [-p] [-j] [-l lang] [[-x[b]N outfile]... [-a apngoutfile] filename]...") << endl;
+		cerr << C_("rpcli", "Usage: rpcli [-c] [-p] [-j] [-V] [-H] [-l lang] [-zN] [[-x[b]N outfile]... [-a apngoutfile] filename]...") << endl;
 #endif /* ENABLE_DECRYPTION */
 		cerr << "  -c:   " << C_("rpcli", "Print system region information.") << endl;
 		cerr << "  -p:   " << C_("rpcli", "Print system path information.") << endl;
 		cerr << "  -j:   " << C_("rpcli", "Use JSON output format.") << endl;
+		cerr << "  -V:   " << C_("rpcli", "Verify the ROM image's contents, if supported. (may be slow)") << endl;
+#ifdef ENABLE_DECRYPTION
+		cerr << "  -H:   " << C_("rpcli", "Calculate the CRC32, MD5, and SHA-1 of the ROM image. (may be slow)") << endl;
+#else /* !ENABLE_DECRYPTION */
+		cerr << "  -H:   " << C_("rpcli", "Calculate the CRC32 of the ROM image. (may be slow)") << endl;
+#endif /* ENABLE_DECRYPTION */
 		cerr << "  -l:   " << C_("rpcli", "Retrieve the specified language from the ROM image.") << endl;
 		cerr << "  -xN:  " << C_("rpcli", "Extract image N to outfile in PNG format.") << endl;
 		cerr << "  -a:   " << C_("rpcli", "Extract the animated icon to outfile in APNG format.") << endl;
+		cerr << "  -zN:  " << C_("rpcli", "Use zlib compression level N (0-9) for extracted images.") << endl;
+		cerr << "  --extract-all=PREFIX: " << C_("rpcli", "Extract all internal images and mipmaps of the next file to PREFIX.<type>[.mipN].png.") << endl;
+		cerr << "                        " << C_("rpcli", "Images are extracted in parallel. Use -tN to set the number of threads.") << endl;
+		cerr << "  --no-translate: " << C_("rpcli", "Don't translate field names and values. (faster for batch JSON output)") << endl;
+		cerr << endl;
+		cerr << C_("rpcli", "Output selection:") << endl;
+		cerr << "  --metadata-only: " << C_("rpcli", "Only show metadata properties. Field data and images are not loaded.") << endl;
+		cerr << "  --tabs=LIST: " << C_("rpcli", "Only show fields from the specified tabs. (comma-separated names or indexes)") << endl;
+		cerr << "  --fields=LIST: " << C_("rpcli", "Only show the specified fields. (comma-separated names)") << endl;
+		cerr << "               " << C_("rpcli", "Images are not shown if any of these options are used.") << endl;
+		cerr << endl;
+		cerr << C_("rpcli", "Batch mode:") << endl;
+		cerr << "  -b:   " << C_("rpcli", "Read filenames from listfile, one per line. ('-' for stdin)") << endl;
+		cerr << "        " << C_("rpcli", "With -j, newline-delimited JSON is written in completion order.") << endl;
+		cerr << "  -tN:  " << C_("rpcli", "Use N threads for batch mode and PNG compression. (default is the number of CPUs)") << endl;
+		cerr << endl;
+		cerr << C_("rpcli", "Cache:") << endl;
+		cerr << "  --prefetch: " << C_("rpcli", "Download external images for all ROM images in the specified directories.") << endl;
+		cerr << "              " << C_("rpcli", "Use -tN to set the number of threads for scanning files.") << endl;
+		cerr << "  --revalidate: " << C_("rpcli", "With --prefetch, also check if cached images were updated on the server.") << endl;
+		cerr << endl;
+		cerr << C_("rpcli", "Service mode:") << endl;
+		cerr << "  --serve: " << C_("rpcli", "Read JSON-RPC 2.0 requests from stdin, one per line, and write responses to stdout.") << endl;
+		cerr << "           " << C_("rpcli", "Methods: open, close, fields, metadata, extract-image, shutdown") << endl;
+		cerr << endl;
+		cerr << C_("rpcli", "Diagnostics:") << endl;
+		cerr << "  --stats: " << C_("rpcli", "Print I/O, cache, decryption, and allocation statistics to stderr on exit.") << endl;
+		cerr << "  --cpu-selftest: " << C_("rpcli", "Benchmark all SIMD code paths and show which ones are selected.") << endl;
+		cerr << "                  " << C_("rpcli", "Set RP_CPU_TIER (e.g. sse2, ssse3, avx2) to limit the CPU features used.") << endl;
 		cerr << endl;
 #ifdef RP_OS_SCSI_SUPPORTED
 		cerr << C_("rpcli", "Special options for devices:") << endl;
@@ -368,19 +1679,42 @@ int RP_C_API main(int argc, char *argv[])
 		cerr << "\t " << C_("rpcli", "displays info about s3.gen") << endl;
 		cerr << "* rpcli -x0 icon.png pokeb2.nds" << endl;
 		cerr << "\t " << C_("rpcli", "extracts icon from pokeb2.nds") << endl;
+		cerr << "* find roms/ -type f | rpcli -j -t4 -b -" << endl;
+		cerr << "\t " << C_("rpcli", "outputs JSON for each file in roms/ using 4 threads") << endl;
+		cerr << "* rpcli --prefetch roms/" << endl;
+		cerr << "\t " << C_("rpcli", "downloads external images for all files in roms/") << endl;
 	}
 	
 	assert(RomData::IMG_INT_MIN == 0);
 	// DoFile parameters
 	bool json = false;
+	bool batch = false;
 	vector<ExtractParam> extract;
 
-	for (int i = 1; i < argc; i++) { // figure out the json mode in advance
-		if (argv[i][0] == '-' && argv[i][1] == 'j') {
-			json = true;
+	for (int i = 1; i < argc; i++) { // figure out the json and batch modes in advance
+		if (argv[i][0] == '-') {
+			if (argv[i][1] == 'j') {
+				json = true;
+			} else if (argv[i][1] == 'b') {
+				batch = true;
+			}
 		}
 	}
-	if (json) cout << "[\n";
+	// NOTE: Batch mode uses newline-delimited JSON, not an array.
+	// NOTE: Prefetch mode doesn't show any ROM information.
+	// NOTE: Service mode writes one JSON-RPC response per line.
+	if (json && !batch && !prefetch && !serve) cout << "[\n";
+
+	// Batch mode parameters
+	vector<string> batch_paths;
+
+	// Prefetch mode parameters
+	vector<string> prefetch_dirs;
+	bool revalidate = false;
+	unsigned int threadCount = 0;
+
+	// PNG compression parameters
+	RpPngWriter::CompressionParams pngParams;
 
 #ifdef RP_OS_SCSI_SUPPORTED
 	bool inq_scsi = false;
@@ -388,6 +1722,11 @@ int RP_C_API main(int argc, char *argv[])
 	bool inq_ata_packet = false;
 #endif /* RP_OS_SCSI_SUPPORTED */
 	uint32_t languageCode = 0;
+	TextOutFilter filter;
+	const char *extractAllPrefix = nullptr;
+	bool verify = false;
+	bool checksums = false;
+	bool stats = false;
 	bool first = true;
 	int ret = 0;
 	for (int i = 1; i < argc; i++){
@@ -404,6 +1743,14 @@ int RP_C_API main(int argc, char *argv[])
 				break;
 			}
 #endif /* ENABLE_DECRYPTION */
+			case 'V':
+				// Verify the ROM image's contents.
+				verify = true;
+				break;
+			case 'H':
+				// Calculate whole-file checksums.
+				checksums = true;
+				break;
 			case 'c':
 				// Print the system region information.
 				PrintSystemRegion();
@@ -429,15 +1776,11 @@ int RP_C_API main(int argc, char *argv[])
 				}
 
 				// Parse the language code.
-				uint32_t lc = 0;
-				int pos;
-				for (pos = 0; pos < 4 && s_lang[pos] != '\0'; pos++) {
-					lc <<= 8;
-					lc |= (uint8_t)s_lang[pos];
-				}
-				if (pos == 4 && s_lang[pos] != '\0') {
+				const uint32_t lc = ParseLanguageCode(s_lang);
+				if (lc == 0) {
 					// Invalid language code.
-					cerr << rp_sprintf(C_("rpcli", "Warning: ignoring invalid language code '%s'"), s_lang) << endl;
+					cerr << rp_sprintf(C_("rpcli", "Warning: ignoring invalid language code '%s'"),
+						(s_lang ? s_lang : "")) << endl;
 					break;
 				}
 
@@ -457,8 +1800,84 @@ int RP_C_API main(int argc, char *argv[])
 			case 'a':
 				extract.emplace_back(ExtractParam(argv[++i], -1));
 				break;
+			case 'z': {
+				// zlib compression level for extracted images.
+				const char *const s_level = (argv[i][2] == '\0' ? argv[++i] : &argv[i][2]);
+				if (!s_level || s_level[0] < '0' || s_level[0] > '9' || s_level[1] != '\0') {
+					cerr << rp_sprintf(C_("rpcli", "Warning: ignoring invalid compression level '%s'"),
+						(s_level ? s_level : "")) << endl;
+					break;
+				}
+				pngParams.level = s_level[0] - '0';
+				break;
+			}
 			case 'j': // do nothing
 				break;
+			case '-':
+				// Long options.
+				if (!strcmp(&argv[i][2], "stats")) {
+					// Print statistics on exit.
+					stats = true;
+				} else if (!strcmp(&argv[i][2], "cpu-selftest")) {
+					// Run the CPU dispatch self-test.
+					static bool hasRunSelfTest = false;
+					if (!hasRunSelfTest) {
+						hasRunSelfTest = true;
+						ret = CpuSelfTest();
+					}
+				} else if (!strcmp(&argv[i][2], "prefetch")) {
+					// Prefetch mode. (checked above)
+				} else if (!strcmp(&argv[i][2], "serve")) {
+					// Service mode. (checked above)
+				} else if (!strcmp(&argv[i][2], "no-translate")) {
+					// Translations are disabled. (checked above)
+				} else if (!strncmp(&argv[i][2], "extract-all=", 12)) {
+					// Extract all internal images and mipmaps.
+					extractAllPrefix = &argv[i][14];
+				} else if (!strcmp(&argv[i][2], "metadata-only")) {
+					// Only show metadata properties.
+					filter.metaDataOnly = true;
+				} else if (!strncmp(&argv[i][2], "tabs=", 5)) {
+					// Only show fields from the specified tabs.
+					SplitList(&argv[i][7], filter.tabs);
+				} else if (!strncmp(&argv[i][2], "fields=", 7)) {
+					// Only show the specified fields.
+					SplitList(&argv[i][9], filter.fields);
+				} else if (!strcmp(&argv[i][2], "revalidate")) {
+					// Revalidate cached images in prefetch mode.
+					revalidate = true;
+				} else {
+					cerr << rp_sprintf(C_("rpcli", "Warning: skipping unknown option '%s'"), argv[i]) << endl;
+				}
+				break;
+			case 'b': {
+				// Batch mode list file.
+				const char *const listfile = (argv[i][2] == '\0' ? argv[++i] : &argv[i][2]);
+				if (!listfile) {
+					cerr << C_("rpcli", "Warning: no list file specified for '-b'") << endl;
+					break;
+				}
+				if (ReadBatchList(listfile, batch_paths) != 0) {
+					cerr << rp_sprintf(C_("rpcli", "Couldn't open list file '%s'"), listfile) << endl;
+					ret = EXIT_FAILURE;
+				}
+				break;
+			}
+			case 't': {
+				// Thread count for batch mode and PNG compression.
+				const char *const s_threads = (argv[i][2] == '\0' ? argv[++i] : &argv[i][2]);
+				const long num = (s_threads ? atol(s_threads) : 0);
+				if (num <= 0 || num > 1024) {
+					cerr << rp_sprintf(C_("rpcli", "Warning: ignoring invalid thread count '%s'"),
+						(s_threads ? s_threads : "")) << endl;
+					break;
+				}
+				threadCount = static_cast<unsigned int>(num);
+				// Also limit the threads used by nested parallel work,
+				// e.g. image decoding and hashing.
+				ThreadPool::setMaxThreads(threadCount);
+				break;
+			}
 #ifdef RP_OS_SCSI_SUPPORTED
 			case 'i':
 				// These commands take precedence over the usual rpcli functionality.
@@ -489,6 +1908,21 @@ int RP_C_API main(int argc, char *argv[])
 				cerr << rp_sprintf(C_("rpcli", "Warning: skipping unknown switch '%c'"), argv[i][1]) << endl;
 				break;
 			}
+		} else if (serve) {
+			// Service mode: Files are specified in requests.
+			cerr << rp_sprintf(C_("rpcli", "Warning: ignoring filename '%s' in service mode"), argv[i]) << endl;
+		} else if (prefetch) {
+			// Prefetch mode: Directories to scan.
+			prefetch_dirs.emplace_back(argv[i]);
+		} else if (batch) {
+			// Batch mode: Filenames on the command line are
+			// processed along with the list file.
+			if (!extract.empty() || extractAllPrefix) {
+				cerr << C_("rpcli", "Warning: image extraction is not supported in batch mode") << endl;
+				extract.clear();
+				extractAllPrefix = nullptr;
+			}
+			batch_paths.emplace_back(argv[i]);
 		} else {
 			if (first) first = false;
 			else if (json) cout << "," << endl;
@@ -508,7 +1942,9 @@ int RP_C_API main(int argc, char *argv[])
 #endif /* RP_OS_SCSI_SUPPORTED */
 			{
 				// Regular file.
-				DoFile(argv[i], json, extract, languageCode);
+				// PNG compression uses the same thread count as batch mode.
+				pngParams.threads = threadCount;
+				DoFile(argv[i], json, extract, pngParams, languageCode, verify, checksums, &filter, extractAllPrefix);
 			}
 
 #ifdef RP_OS_SCSI_SUPPORTED
@@ -517,8 +1953,34 @@ int RP_C_API main(int argc, char *argv[])
 			inq_ata_packet = false;
 #endif /* RP_OS_SCSI_SUPPORTED */
 			extract.clear();
+			extractAllPrefix = nullptr;
+		}
+	}
+	if (serve) {
+		// PNG compression uses the same thread count as batch mode.
+		pngParams.threads = threadCount;
+		const int sret = DoService(languageCode, pngParams);
+		if (sret != 0) {
+			ret = sret;
+		}
+	} else if (prefetch) {
+		if (!prefetch_dirs.empty()) {
+			const int pret = DoPrefetch(prefetch_dirs, threadCount, revalidate);
+			if (pret != 0) {
+				ret = pret;
+			}
 		}
+	} else if (batch) {
+		if (!batch_paths.empty()) {
+			DoBatch(batch_paths, json, threadCount, languageCode, verify, checksums, &filter);
+		}
+	} else if (json) {
+		cout << "]\n";
+	}
+
+	if (stats) {
+		cout.flush();
+		PrintStats();
 	}
-	if (json) cout << "]\n";
 	return ret;
 }
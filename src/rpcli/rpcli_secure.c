@@ -9,16 +9,19 @@
 #include "stdafx.h"
 #include "rpcli_secure.h"
 #include "librpsecure/os-secure.h"
+#include "common.h"
 
 /**
  * Enable security options.
+ * @param prefetch True for prefetch mode (--prefetch), which runs rp-download.
  * @return 0 on success; negative POSIX error code on error.
  */
-int rpcli_do_security_options(void)
+int rpcli_do_security_options(bool prefetch)
 {
 	// Set OS-specific security options.
 	rp_secure_param_t param;
 #if defined(_WIN32)
+	((void)prefetch);
 	param.bHighSec = 0;
 #elif defined(HAVE_SECCOMP)
 	static const int syscall_wl[] = {
@@ -26,6 +29,10 @@ int rpcli_do_security_options(void)
 		// TODO: Add more syscalls.
 		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
 		// defined in earlier versions, including Ubuntu 14.04.
+
+		// NOTE: clone() must be first; only threads are allowed.
+		SCMP_SYS(clone),	// batch mode (-b) worker threads
+
 		SCMP_SYS(close),
 		SCMP_SYS(dup),		// gzdopen()
 		SCMP_SYS(fcntl),     SCMP_SYS(fcntl64),		// gcc profiling
@@ -48,8 +55,18 @@ int rpcli_do_security_options(void)
 #elif defined(__NR_openat2)
 		__NR_openat2,		// Linux 5.6
 #endif /* __SNR_openat2 || __NR_openat2 */
+		SCMP_SYS(pread64),	// LibRpFile::RpFile::pread() [RomDataPrivate::readAt()]
 		SCMP_SYS(readlink),	// realpath() [LibRpBase::FileSystem::resolve_symlink()]
 
+		// LibRpFile::RpFile::adviseAccess(), prefetch()
+		// - Streaming mode drops data that was read. [RomData::hash()]
+		// NOTE: posix_fadvise() uses a different syscall depending on the architecture.
+		SCMP_SYS(fadvise64),	// 64-bit
+		SCMP_SYS(fadvise64_64),	// 32-bit
+#if defined(__SNR_arm_fadvise64_64) || defined(__NR_arm_fadvise64_64)
+		SCMP_SYS(arm_fadvise64_64),	// 32-bit ARM
+#endif /* __SNR_arm_fadvise64_64 || __NR_arm_fadvise64_64 */
+
 		// KeyManager (keys.conf)
 		SCMP_SYS(access),	// LibUnixCommon::isWritableDirectory()
 		SCMP_SYS(stat), SCMP_SYS(stat64),	// LibUnixCommon::isWritableDirectory()
@@ -64,10 +81,25 @@ int rpcli_do_security_options(void)
 		SCMP_SYS(uname),
 #endif /* NDEBUG */
 
+		// ConfReader: LibRpBase::ConfWatcher (inotify)
+		SCMP_SYS(inotify_init1), SCMP_SYS(inotify_add_watch),
+		SCMP_SYS(pipe2),	// shutdown pipe
+		SCMP_SYS(poll), SCMP_SYS(ppoll),	// watcher thread (ppoll on arm64)
+
 		// glibc ncsd
 		// TODO: Restrict connect() to AF_UNIX.
 		SCMP_SYS(connect), SCMP_SYS(recvmsg), SCMP_SYS(sendto),
 
+		// Batch mode (-b): LibRpThreads::ThreadPool
+		SCMP_SYS(madvise),		// pthread stack cleanup
+		SCMP_SYS(sched_getaffinity),	// sysconf(_SC_NPROCESSORS_ONLN)
+		SCMP_SYS(set_robust_list),	// pthread_create()
+#if defined(__SNR_rseq) || defined(__NR_rseq)
+		SCMP_SYS(rseq),			// glibc-2.35
+#endif /* __SNR_rseq || __NR_rseq */
+		// NOTE: clone3() is rejected with ENOSYS by rp_secure_enable(),
+		// so glibc-2.34's pthread_create() falls back to clone().
+
 		// NOTE: The following syscalls are only made if either access() or stat() can't be run.
 		// TODO: Can this happen in other situations?
 		//SCMP_SYS(geteuid), SCMP_SYS(getuid),
@@ -76,7 +108,43 @@ int rpcli_do_security_options(void)
 
 		-1	// End of whitelist
 	};
-	param.syscall_wl = syscall_wl;
+
+	// Prefetch mode (--prefetch)
+	// NOTE: The rp-download daemon is started before the security
+	// options are enabled, and rp-download isn't run directly.
+	// See CacheManager::setDaemonOnly().
+	static const int syscall_wl_prefetch[] = {
+		SCMP_SYS(socket), SCMP_SYS(recvfrom),	// rp-download daemon socket
+		SCMP_SYS(getdents), SCMP_SYS(getdents64),	// LibRpFile::FileSystem::read_dir()
+
+		// NegativeCache, CacheIndex
+		SCMP_SYS(mkdir), SCMP_SYS(mkdirat),
+		SCMP_SYS(rename), SCMP_SYS(renameat),
+#if defined(__SNR_renameat2) || defined(__NR_renameat2)
+		SCMP_SYS(renameat2),
+#endif /* __SNR_renameat2 || __NR_renameat2 */
+		SCMP_SYS(unlink), SCMP_SYS(unlinkat),
+
+		-1	// End of whitelist
+	};
+
+	if (prefetch) {
+		// Combine both whitelists.
+		// NOTE: clone() must still be first.
+		static int syscall_wl_all[ARRAY_SIZE(syscall_wl) + ARRAY_SIZE(syscall_wl_prefetch) - 1];
+		int *p = syscall_wl_all;
+		const int *q;
+		for (q = syscall_wl; *q != -1; q++) {
+			*p++ = *q;
+		}
+		for (q = syscall_wl_prefetch; *q != -1; q++) {
+			*p++ = *q;
+		}
+		*p = -1;
+		param.syscall_wl = syscall_wl_all;
+	} else {
+		param.syscall_wl = syscall_wl;
+	}
 #elif defined(HAVE_PLEDGE)
 	// Promises:
 	// - stdio: General stdio functionality.
@@ -84,10 +152,18 @@ int rpcli_do_security_options(void)
 	// - wpath: Write to ~/.cache/rom-properties/
 	// - cpath: Create ~/.cache/rom-properties/ if it doesn't exist.
 	// - getpw: Get user's home directory if HOME is empty.
-	param.promises = "stdio rpath wpath cpath getpw";
+	// - unix: Connect to the rp-download daemon's socket. (prefetch mode only)
+	param.promises = (prefetch
+		? "stdio rpath wpath cpath getpw unix"
+		: "stdio rpath wpath cpath getpw");
 #elif defined(HAVE_TAME)
+	if (prefetch) {
+		// TODO: Tame flags for running rp-download.
+		return 0;
+	}
 	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH | TAME_GETPW;
 #else
+	((void)prefetch);
 	param.dummy = 0;
 #endif
 
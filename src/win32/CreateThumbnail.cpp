@@ -94,9 +94,18 @@ HBITMAP CreateThumbnail::rescaleImgClass(const HBITMAP &imgClass, const ImgSize
 	// Our IExtractIcon implementation converts it to HICON later.
 
 	// Resize the image.
-	const SIZE win_sz = {sz.width, sz.height};
-	HBITMAP hbmp = RpImageWin32::toHBITMAP_alpha(img, win_sz, (method == ScalingMethod::Nearest));
+	rp_image *const scaled_img = img->scaled(sz.width, sz.height,
+		(method == ScalingMethod::Nearest ? rp_image::SCALE_NEAREST : rp_image::SCALE_BILINEAR));
 	img->unref();
+	if (!scaled_img) {
+		// Error scaling the image.
+		return nullptr;
+	}
+
+	// The scaled image is temporary, so its DIB section
+	// can be handed off without copying.
+	HBITMAP hbmp = RpImageWin32::detachHBITMAP_alpha(scaled_img);
+	scaled_img->unref();
 	return hbmp;
 }
 
@@ -194,11 +203,16 @@ HBITMAP CreateThumbnailNoAlpha::rescaleImgClass(const HBITMAP &imgClass, const I
 	// Thumbs.db images won't reflect color scheme changes.
 
 	// Resize the image.
-	// TODO: "nearest" parameter.
-	const SIZE win_sz = {sz.width, sz.height};
-	HBITMAP hbmp = RpImageWin32::toHBITMAP(img,
-		LibWin32Common::GetSysColor_ARGB32(COLOR_WINDOW),
-		win_sz, (method == ScalingMethod::Nearest));
+	rp_image *const scaled_img = img->scaled(sz.width, sz.height,
+		(method == ScalingMethod::Nearest ? rp_image::SCALE_NEAREST : rp_image::SCALE_BILINEAR));
 	img->unref();
+	if (!scaled_img) {
+		// Error scaling the image.
+		return nullptr;
+	}
+
+	HBITMAP hbmp = RpImageWin32::toHBITMAP(scaled_img,
+		LibWin32Common::GetSysColor_ARGB32(COLOR_WINDOW));
+	scaled_img->unref();
 	return hbmp;
 }
@@ -43,8 +43,14 @@ using LibWin32Common::RegKey;
 using LibRpTexture::RpGdiplusBackend;
 using LibRpTexture::rp_image;
 
+// librpbase
+#include "librpbase/img/SharedImageCache.hpp"
+using LibRpBase::SharedImageCache;
+
 // For file extensions.
+#include "libromdata/DetectCache.hpp"
 #include "libromdata/RomDataFactory.hpp"
+using LibRomData::DetectCache;
 using LibRomData::RomDataFactory;
 
 // C++ STL classes.
@@ -105,6 +111,13 @@ BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID /*lpReserved*/)
 			// Register RpGdiplusBackend.
 			// TODO: Static initializer somewhere?
 			rp_image::setBackendCreatorFn(RpGdiplusBackend::creator_fn);
+
+			// Share decoded images with other processes,
+			// e.g. Explorer and the thumbnail cache process.
+			SharedImageCache::setEnabled(true);
+
+			// Remember which RomData subclass was detected for each file.
+			DetectCache::setEnabled(true);
 			break;
 		}
 
@@ -761,7 +774,7 @@ STDAPI DllUnregisterServer(void)
 	if (!hklm.isOpen()) return SELFREG_E_CLASS;
 
 	// Unegister all supported file types.
-	const vector<RomDataFactory::ExtInfo> vec_exts = RomDataFactory::supportedFileExtensions();
+	const vector<RomDataFactory::ExtInfo> &vec_exts = RomDataFactory::supportedFileExtensions();
 	const auto vec_exts_cend = vec_exts.cend();
 	const auto user_SIDs_cend = user_SIDs.cend();
 	for (auto ext_iter = vec_exts.cbegin(); ext_iter != vec_exts_cend; ++ext_iter) {
@@ -228,11 +228,22 @@ bool DragImageLabelPrivate::updateBitmaps(void)
 	if (anim && anim->iconAnimData) {
 		const IconAnimData *const iconAnimData = anim->iconAnimData;
 
+		// Set up the IconAnimHelper.
+		anim->iconAnimHelper.setIconAnimData(iconAnimData);
+
 		// Convert the icons to HBITMAP using the window background color.
+		// Duplicate frames are skipped, since the IconAnimHelper
+		// only returns base frames.
 		// TODO: Rescale the icon. (port rescaleImage())
 		for (int i = iconAnimData->count-1; i >= 0; i--) {
+			// Remove the existing frame first.
+			if (anim->iconFrames[i]) {
+				DeleteBitmap(anim->iconFrames[i]);
+				anim->iconFrames[i] = nullptr;
+			}
+
 			const rp_image *const frame = iconAnimData->frames[i];
-			if (frame && frame->isValid()) {
+			if (frame && frame->isValid() && anim->iconAnimHelper.baseFrame(i) == i) {
 				if (actualSize.cx == 0) {
 					// Get the icon size and rescale it, if necessary.
 					actualSize.cx = frame->width();
@@ -245,8 +256,6 @@ bool DragImageLabelPrivate::updateBitmaps(void)
 			}
 		}
 
-		// Set up the IconAnimHelper.
-		anim->iconAnimHelper.setIconAnimData(iconAnimData);
 		if (anim->iconAnimHelper.isAnimated()) {
 			// Initialize the animation.
 			anim->last_frame_number = anim->iconAnimHelper.frameNumber();
@@ -11,6 +11,9 @@
 #include "RP_ExtractImage.hpp"
 #include "RpImageWin32.hpp"
 
+// librptexture
+#include "librptexture/decoder/ImageDecoder.hpp"
+
 // librpbase, librpfile, librptexture, libromdata
 using namespace LibRpBase;
 using namespace LibRpFile;
@@ -110,6 +113,9 @@ IFACEMETHODIMP RP_ExtractImage::Load(LPCOLESTR pszFileName, DWORD dwMode)
 		return E_FAIL;
 	}
 
+	// Decode large textures on the GPU if enabled.
+	LibRpTexture::ImageDecoder::setGpuDecodeEnabled(config->gpuTextureDecode());
+
 	// Attempt to open the ROM file.
 	RpFile *const file = new RpFile(d->filename, RpFile::FM_OPEN_READ_GZ);
 	if (!file->isOpen()) {
@@ -17,17 +17,21 @@
 
 // librpbase, librpfile, libromdata
 #include "librpbase/RomMetaData.hpp"
+#include "libromdata/RomDataCache.hpp"
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
+using LibRomData::RomDataCache;
 using LibRomData::RomDataFactory;
 
 // libwin32common
 #include "libwin32common/propsys_xp.h"
+#include "libwin32common/w32time.h"
 
 // RpFile_IStream
 #include "RpFile_IStream.hpp"
 
 // C++ STL classes.
+using std::string;
 using std::wstring;
 
 // CLSID
@@ -235,8 +239,44 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 	d->pstream = pstream;
 	d->grfMode = grfMode;
 
-	// Attempt to create a RomData object.
-	d->romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_METADATA);
+	// Check the metadata cache first.
+	// NOTE: The IStream name usually doesn't include the directory,
+	// so files with the same name, size, and mtime would collide.
+	// Only use the cache if the IStream name is a full path.
+	const string filename = file->filename();
+	off64_t fileSize = 0;
+	time_t mtime = -1;
+	bool canCache = false;
+	bool isFullPath = false;
+	if (!filename.empty()) {
+		const wstring wfilename = U82W_s(filename);
+		isFullPath = !PathIsRelativeW(wfilename.c_str()) &&
+			(PathGetDriveNumberW(wfilename.c_str()) >= 0 || PathIsUNCW(wfilename.c_str()));
+	}
+	if (isFullPath) {
+		STATSTG statstg;
+		HRESULT hr = pstream->Stat(&statstg, STATFLAG_NONAME);
+		if (SUCCEEDED(hr)) {
+			fileSize = static_cast<off64_t>(statstg.cbSize.QuadPart);
+			mtime = static_cast<time_t>(FileTimeToUnixTime(&statstg.mtime));
+			canCache = true;
+		}
+	}
+	if (canCache) {
+		d->romData = RomDataCache::loadMetaData(filename.c_str(), fileSize, mtime);
+	}
+
+	if (!d->romData) {
+		// Attempt to create a RomData object.
+		// Only metadata is needed here, so don't load the fields
+		// or internal images. The Windows Search indexer calls
+		// this function for every ROM file on the system.
+		d->romData = RomDataFactory::create(file,
+			RomDataFactory::RDA_HAS_METADATA | RomDataFactory::RDA_METADATA_ONLY);
+		if (d->romData && canCache) {
+			RomDataCache::save(filename.c_str(), fileSize, mtime, d->romData);
+		}
+	}
 	if (!d->romData) {
 		// No RomData.
 		return E_FAIL;
@@ -108,6 +108,13 @@ IFACEMETHODIMP RP_ShellIconOverlayIdentifier::IsMemberOf(_In_ PCWSTR pwszPath, D
 	// Convert the filename to UTF-8.
 	const string u8filename = W2U8(pwszPath);
 
+	// Only a few RomData subclasses can have "dangerous" permissions.
+	// Check the file extension before doing any file I/O.
+	if (!RomDataFactory::isDangerousPermissionsCandidate(u8filename.c_str())) {
+		// Not a candidate.
+		return S_FALSE;
+	}
+
 	// Check for "bad" file systems.
 	// TODO: Combine with the above "slow" check?
 	if (FileSystem::isOnBadFS(u8filename.c_str(),
@@ -117,25 +124,9 @@ IFACEMETHODIMP RP_ShellIconOverlayIdentifier::IsMemberOf(_In_ PCWSTR pwszPath, D
 		return S_FALSE;
 	}
 
-	// Open the ROM file.
-	RpFile *const file = new RpFile(u8filename.c_str(), RpFile::FM_OPEN_READ_GZ);
-	if (!file->isOpen()) {
-		// Error opening the ROM file.
-		file->unref();
-		return E_FAIL;
-	}
-
-	// Attempt to create a RomData object.
-	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_DPOVERLAY);
-	file->unref();
-	if (!romData) {
-		// ROM is not supported.
-		return S_FALSE;
-	}
-
-	HRESULT hr = (romData->hasDangerousPermissions() ? S_OK : S_FALSE);
-	romData->unref();
-	return hr;
+	// Check the ROM file.
+	// NOTE: The result is cached by RomDataFactory.
+	return (RomDataFactory::hasDangerousPermissions(u8filename.c_str()) ? S_OK : S_FALSE);
 }
 
 IFACEMETHODIMP RP_ShellIconOverlayIdentifier::GetOverlayInfo(_Out_writes_(cchMax) PWSTR pwszIconFile, int cchMax, _Out_ int *pIndex, _Out_ DWORD *pdwFlags)
@@ -86,6 +86,9 @@ const CLSID CLSID_RP_ShellPropSheetExt =
 #define IDM_OPTIONS_MENU_COPY_TEXT	(IDM_OPTIONS_MENU_BASE - 3)
 #define IDM_OPTIONS_MENU_COPY_JSON	(IDM_OPTIONS_MENU_BASE - 4)
 
+// Posted by the load thread once the RomData object is loaded.
+#define WM_RP_ROMDATA_LOADED		(WM_USER + 0x1301)
+
 /** RP_ShellPropSheetExt_Private **/
 // Workaround for RP_D() expecting the no-underscore naming convention.
 #define RP_ShellPropSheetExtPrivate RP_ShellPropSheetExt_Private
@@ -112,6 +115,12 @@ class RP_ShellPropSheetExt_Private
 		// ROM data. (Not opened until the properties tab is shown.)
 		RomData *romData;
 
+		// Load thread. RomData is loaded on a separate thread
+		// so Explorer doesn't freeze while it's being loaded.
+		HANDLE hLoadThread;
+		RomData *romDataLoaded;	// Set by the load thread.
+		HWND lblLoading;	// "Loading..." placeholder.
+
 		// Useful window handles.
 		HWND hDlgSheet;		// Property sheet.
 		HWND hBtnOptions;	// Options button.
@@ -144,26 +153,54 @@ class RP_ShellPropSheetExt_Private
 		// ListView data struct.
 		// NOTE: Not making vImageList a pointer, since that adds
 		// significantly more complexity.
+		// NOTE: Strings are read directly from the ListData_t
+		// and converted when the ListView requests them.
 		struct LvData_t {
-			vector<vector<tstring> > vvStr;	// String data.
-			vector<int> vImageList;		// ImageList indexes.
+			const RomFields::ListData_t *pListData;	// String data.
+			vector<int> vRowMap;		// ListView row -> ListData_t row. (if empty, 1:1)
+			vector<int> vImageList;		// ImageList indexes. (ICON_NOT_LOADED if not loaded yet)
 			uint32_t checkboxes;		// Checkboxes.
 			bool hasCheckboxes;		// True if checkboxes are valid.
 
+			// For RFT_LISTDATA_ICONS only!
+			// Icons are added to the ImageList when the ListView
+			// requests them, since lazy icons are decoded on demand.
+			const RomFields::ListDataIcons_t *pIcons;
+			HIMAGELIST himl;
+			float iconResizeFactor;		// Icon height factor. (1.0f if not resizing)
+
 			// For RFT_LISTDATA_MULTI only!
 			HWND hListView;
 			const RomFields::Field *pField;
 
 			LvData_t()
-				: checkboxes(0), hasCheckboxes(false)
+				: pListData(nullptr), checkboxes(0), hasCheckboxes(false)
+				, pIcons(nullptr), himl(nullptr), iconResizeFactor(1.0f)
 				, hListView(nullptr), pField(nullptr) { }
 		};
 
+		// vImageList value for icons that haven't been added yet.
+		static const int ICON_NOT_LOADED = -2;
+
+		// Maximum number of ListData rows to measure
+		// when determining the initial column widths.
+		// Measuring every row takes too long for
+		// very large lists, e.g. EXE imports.
+		static const int LISTDATA_MEASURE_ROWS_MAX = 128;
+
 		// ListView data.
 		// - Key: ListView dialog ID
 		// - Value: LvData_t.
 		unordered_map<uint16_t, LvData_t> map_lvData;
 
+		/**
+		 * Add a ListView row's icon to the ImageList.
+		 * @param lvData	[in/out] LvData_t
+		 * @param iItem		[in] ListView row.
+		 * @return ImageList index, or -1 if the row doesn't have an icon.
+		 */
+		int ListView_LoadIcon(LvData_t &lvData, int iItem);
+
 		/**
 		 * ListView GetDispInfo function.
 		 * @param plvdi	[in/out] NMLVDISPINFO
@@ -423,6 +460,28 @@ class RP_ShellPropSheetExt_Private
 		void initBoldFont(HFONT hFont);
 
 	public:
+		/**
+		 * Start loading the RomData object on the load thread.
+		 * A placeholder is shown until it's loaded.
+		 * Called by WM_SHOWWINDOW.
+		 */
+		void startLoading(void);
+
+		/**
+		 * Load thread procedure.
+		 * The RomData object is created, then its fields and header
+		 * images are loaded. WM_RP_ROMDATA_LOADED is posted afterwards.
+		 * @param lpParameter RP_ShellPropSheetExt_Private
+		 * @return 0
+		 */
+		static DWORD WINAPI loadThreadProc(LPVOID lpParameter);
+
+		/**
+		 * The load thread has finished loading the RomData object.
+		 * Called by WM_RP_ROMDATA_LOADED.
+		 */
+		void romDataLoadedEvent(void);
+
 		/**
 		 * Initialize the dialog. (hDlgSheet)
 		 * Called by WM_INITDIALOG.
@@ -502,6 +561,9 @@ RP_ShellPropSheetExt_Private::RP_ShellPropSheetExt_Private(RP_ShellPropSheetExt
 	: q_ptr(q)
 	, filename(std::move(filename))
 	, romData(nullptr)
+	, hLoadThread(nullptr)
+	, romDataLoaded(nullptr)
+	, lblLoading(nullptr)
 	, hDlgSheet(nullptr)
 	, hBtnOptions(nullptr)
 	, hMenuOptions(nullptr)
@@ -545,6 +607,14 @@ RP_ShellPropSheetExt_Private::RP_ShellPropSheetExt_Private(RP_ShellPropSheetExt
 
 RP_ShellPropSheetExt_Private::~RP_ShellPropSheetExt_Private()
 {
+	// Wait for the load thread to finish.
+	// NOTE: The RomData constructor can't be interrupted.
+	if (hLoadThread) {
+		WaitForSingleObject(hLoadThread, INFINITE);
+		CloseHandle(hLoadThread);
+	}
+	UNREF(romDataLoaded);
+
 	// Delete the banner and icon frames.
 	delete lblBanner;
 	delete lblIcon;
@@ -822,8 +892,8 @@ int RP_ShellPropSheetExt_Private::initString(_In_ HWND hDlg, _In_ HWND hWndTab,
 			return 0;
 
 		// NULL string == empty string
-		if (field.data.str) {
-			str_nl = LibWin32Common::unix2dos(U82T_s(*(field.data.str)), &lf_count);
+		if (field.data.str.data) {
+			str_nl = LibWin32Common::unix2dos(U82T_c(field.data.str.data), &lf_count);
 		}
 	} else {
 		// Use the specified string.
@@ -1425,15 +1495,14 @@ int RP_ShellPropSheetExt_Private::initListData(HWND hDlg, HWND hWndTab,
 		checkboxes = field.data.list_data.mxd.checkboxes;
 	}
 
-	// NOTE: We're converting the strings for use with
-	// LVS_OWNERDATA.
-	vector<vector<tstring> > lvStringData;
-	lvStringData.reserve(list_data->size());
+	// NOTE: Strings are converted in ListView_GetDispInfo()
+	// for LVS_OWNERDATA, so only the rows used for measuring
+	// the initial column widths are converted here.
 	LvData_t lvData;
-	lvData.vvStr.reserve(list_data->size());
+	lvData.pListData = list_data;
 	lvData.hasCheckboxes = hasCheckboxes;
-	if (hasIcons) {
-		lvData.vImageList.reserve(list_data->size());
+	if (hasCheckboxes) {
+		lvData.vRowMap.reserve(list_data->size());
 	}
 
 	int lv_row_num = 0, data_row_num = 0;
@@ -1455,56 +1524,21 @@ int RP_ShellPropSheetExt_Private::initListData(HWND hDlg, HWND hWndTab,
 				}
 				checkboxes >>= 1;
 			}
+			lvData.vRowMap.emplace_back(data_row_num);
 		}
 
-		// Destination row.
-		lvData.vvStr.resize(lvData.vvStr.size()+1);
-		auto &lv_row_data = lvData.vvStr.at(lvData.vvStr.size()-1);
-		lv_row_data.reserve(data_row.size());
-
-		// String data.
-		if (isMulti) {
-			// RFT_LISTDATA_MULTI. Allocate space for the strings,
-			// but don't initialize them here.
-			lv_row_data.resize(data_row.size());
-
-			// Check newline counts in all strings to find nl_max.
-			const auto *const multi = field.data.list_data.data.multi;
-			const auto multi_cend = multi->cend();
-			for (auto iter_m = multi->cbegin(); iter_m != multi_cend; ++iter_m) {
-				const RomFields::ListData_t &ld = iter_m->second;
-				const auto ld_cend = ld.cend();
-				for (auto iter_row = ld.cbegin(); iter_row != ld_cend; ++iter_row) {
-					const auto &data_row = *iter_row;
-					const auto data_row_cend = data_row.cend();
-					for (auto iter_col = data_row.cbegin(); iter_col != data_row_cend; ++iter_col) {
-						size_t prev_nl_pos = 0;
-						size_t cur_nl_pos;
-						int nl = 0;
-						while ((cur_nl_pos = iter_col->find('\n', prev_nl_pos)) != tstring::npos) {
-							nl++;
-							prev_nl_pos = cur_nl_pos + 1;
-						}
-						nl_max = std::max(nl_max, nl);
-					}
-				}
-			}
-		} else {
-			// Single language.
+		if (!isMulti && data_row_num < LISTDATA_MEASURE_ROWS_MAX) {
+			// Single language. Measure the strings.
+			// RFT_LISTDATA_MULTI is measured in updateMulti().
 			int col = 0;
 			const auto data_row_cend = data_row.cend();
 			for (auto iter = data_row.cbegin(); iter != data_row_cend; ++iter, col++) {
-				tstring tstr = U82T_s(*iter);
-
 				int nl_count;
-				int width = measureListDataString(hDC, tstr, &nl_count);
+				int width = measureListDataString(hDC, U82T_s(*iter), &nl_count);
 				if (col < colCount) {
 					col_width[col] = std::max(col_width[col], width);
 				}
 				nl_max = std::max(nl_max, nl_count);
-
-				// TODO: Store the icon index if necessary.
-				lv_row_data.emplace_back(std::move(tstr));
 			}
 		}
 
@@ -1512,6 +1546,33 @@ int RP_ShellPropSheetExt_Private::initListData(HWND hDlg, HWND hWndTab,
 		lv_row_num++;
 	}
 
+	if (hasIcons) {
+		// Check newline counts in all strings to find nl_max.
+		// NOTE: This is only needed for the icon size, and it
+		// doesn't require GDI, so all rows are checked here.
+		// For RFT_LISTDATA_MULTI, all languages are checked.
+		auto checkNewlines = [&nl_max](const RomFields::ListData_t &ld) {
+			const auto ld_cend = ld.cend();
+			for (auto iter_row = ld.cbegin(); iter_row != ld_cend; ++iter_row) {
+				const auto &data_row = *iter_row;
+				const auto data_row_cend = data_row.cend();
+				for (auto iter_col = data_row.cbegin(); iter_col != data_row_cend; ++iter_col) {
+					const int nl = static_cast<int>(std::count(iter_col->cbegin(), iter_col->cend(), '\n'));
+					nl_max = std::max(nl_max, nl);
+				}
+			}
+		};
+		if (isMulti) {
+			const auto *const multi = field.data.list_data.data.multi;
+			const auto multi_cend = multi->cend();
+			for (auto iter_m = multi->cbegin(); iter_m != multi_cend; ++iter_m) {
+				checkNewlines(iter_m->second);
+			}
+		} else {
+			checkNewlines(*list_data);
+		}
+	}
+
 	// Icons.
 	if (hasIcons) {
 		// Icon size is 32x32, adjusted for DPI. (TODO: WM_DPICHANGED)
@@ -1544,98 +1605,14 @@ int RP_ShellPropSheetExt_Private::initListData(HWND hDlg, HWND hWndTab,
 			// TODO: The row highlight doesn't surround the empty area
 			// of the icon. LVS_OWNERDRAW is probably needed for that.
 			ListView_SetImageList(hListView, himl, LVSIL_SMALL);
-			uint32_t lvBgColor[2];
-			lvBgColor[0] = LibWin32Common::GetSysColor_ARGB32(COLOR_WINDOW);
-			lvBgColor[1] = LibWin32Common::getAltRowColor_ARGB32();
-
-			// Add icons.
-			uint8_t rowColorIdx = 0;
-			const auto &icons = field.data.list_data.mxd.icons;
-			const auto icons_cend = icons->cend();
-			for (auto iter = icons->cbegin(); iter != icons_cend;
-			     ++iter, rowColorIdx = !rowColorIdx)
-			{
-				bool needsUnref = false;
-				int iImage = -1;
-				const rp_image *icon = *iter;
-				if (!icon) {
-					// No icon for this row.
-					lvData.vImageList.emplace_back(iImage);
-					continue;
-				}
-
-				if (dwExStyleRTL != 0) {
-					// WS_EX_LAYOUTRTL will flip bitmaps in the ListView.
-					// ILC_MIRROR mirrors the bitmaps if the process is mirrored,
-					// but we can't rely on that being the case, and this option
-					// was first introduced in Windows XP.
-					// We'll flip the image here to counteract it.
-					const rp_image *const flipimg = icon->flip(rp_image::FLIP_H);
-					assert(flipimg != nullptr);
-					if (flipimg) {
-						icon = flipimg;
-						needsUnref = true;
-					}
-				}
-
-				// Resize the icon, if necessary.
-				if (resizeNeeded) {
-					SIZE szResize = {icon->width(), icon->height()};
-					szResize.cy = static_cast<LONG>(szResize.cy * factor);
-
-					// If the original icon is CI8, it needs to be
-					// converted to ARGB32 first. Otherwise, the
-					// "empty" background area will be black.
-					// NOTE: We still need to specify a background color,
-					// since the ListView highlight won't show up on
-					// alpha-transparent pixels.
-					// TODO: Handle this in rp_image::resized()?
-					// TODO: Handle theme changes?
-					// TODO: Error handling.
-					if (icon->format() != rp_image::Format::ARGB32) {
-						const rp_image *const icon32 = icon->dup_ARGB32();
-						if (icon32) {
-							if (needsUnref) {
-								icon->unref();
-							}
-							icon = icon32;
-							needsUnref = true;
-						}
-					}
-
-					// Resize the icon.
-					const rp_image *const icon_resized = icon->resized(
-						szResize.cx, szResize.cy,
-						rp_image::AlignVCenter, lvBgColor[rowColorIdx]);
-					assert(icon_resized != nullptr);
-					if (icon_resized) {
-						if (needsUnref) {
-							icon->unref();
-						}
-						icon = icon_resized;
-						needsUnref = true;
-					}
-				}
 
-				HICON hIcon = RpImageWin32::toHICON(icon);
-				if (needsUnref) {
-					icon->unref();
-				}
-
-				assert(hIcon != nullptr);
-				if (hIcon) {
-					int idx = ImageList_AddIcon(himl, hIcon);
-					if (idx >= 0) {
-						// Icon added.
-						iImage = idx;
-					}
-					// ImageList makes a copy of the icon.
-					DestroyIcon(hIcon);
-				}
-
-				// Save the ImageList index for later.
-				lvData.vImageList.emplace_back(iImage);
-			}
+			// Icons are added in ListView_GetDispInfo(),
+			// so only the rows that are displayed are loaded.
+			lvData.pIcons = field.data.list_data.mxd.icons;
+			lvData.himl = himl;
+			lvData.iconResizeFactor = (resizeNeeded ? factor : 1.0f);
+			// NOTE: static_cast<> avoids odr-using ICON_NOT_LOADED.
+			lvData.vImageList.assign(lvData.pIcons->size(), static_cast<int>(ICON_NOT_LOADED));
 		}
 	}
 
@@ -2181,33 +2158,30 @@ void RP_ShellPropSheetExt_Private::updateMulti(uint32_t user_lc)
 			// NOTE: Using the parent dialog's font.
 			AutoGetDC hDC(hListView, hFontDlg);
 
-			// Get the ListView data vector for LVS_OWNERDATA.
-			vector<vector<tstring> > &vvStr = lvData.vvStr;
+			// Switch the ListView to the new ListData_t.
+			// NOTE: Strings are converted in ListView_GetDispInfo().
+			lvData.pListData = pListData;
 
-			auto iter_ld_row = pListData->cbegin();
-			auto iter_vvStr_row = vvStr.begin();
-			const auto pListData_cend = pListData->cend();
-			const auto vvStr_end = vvStr.end();
-			for (; iter_ld_row != pListData_cend && iter_vvStr_row != vvStr_end;
-			     ++iter_ld_row, ++iter_vvStr_row)
-			{
-				const vector<string> &src_data_row = *iter_ld_row;
-				vector<tstring> &dest_data_row = *iter_vvStr_row;
-
-				int col = 0;
-				auto iter_sdr = src_data_row.cbegin();
-				auto iter_ddr = dest_data_row.begin();
-				const auto src_data_row_cend = src_data_row.cend();
-				const auto dest_data_row_end = dest_data_row.end();
-				for (; iter_sdr != src_data_row_cend && iter_ddr != dest_data_row_end;
-				     ++iter_sdr, ++iter_ddr, col++)
+			// Measure the first few rows for the column widths.
+			// NOTE: Only done on first load.
+			if (!cboLanguage) {
+				int row = 0;
+				auto iter_ld_row = pListData->cbegin();
+				const auto pListData_cend = pListData->cend();
+				for (; iter_ld_row != pListData_cend && row < LISTDATA_MEASURE_ROWS_MAX;
+				     ++iter_ld_row, row++)
 				{
-					tstring tstr = U82T_s(*iter_sdr);
-					int width = measureListDataString(hDC, tstr);
-					if (col < colCount) {
+					const vector<string> &src_data_row = *iter_ld_row;
+
+					int col = 0;
+					const auto src_data_row_cend = src_data_row.cend();
+					for (auto iter_sdr = src_data_row.cbegin();
+					     iter_sdr != src_data_row_cend && col < colCount;
+					     ++iter_sdr, col++)
+					{
+						int width = measureListDataString(hDC, U82T_s(*iter_sdr));
 						col_width[col] = std::max(col_width[col], width);
 					}
-					*iter_ddr = std::move(tstr);
 				}
 			}
 
@@ -2224,7 +2198,7 @@ void RP_ShellPropSheetExt_Private::updateMulti(uint32_t user_lc)
 			}
 
 			// Redraw all items.
-			ListView_RedrawItems(hListView, 0, static_cast<int>(vvStr.size()));
+			ListView_RedrawItems(hListView, 0, ListView_GetItemCount(hListView));
 		}
 	}
 
@@ -2428,8 +2402,8 @@ int RP_ShellPropSheetExt_Private::updateField(int fieldIdx)
 				break;
 			}
 
-			if (field->data.str && !field->data.str->empty()) {
-				const tstring ts_text = LibWin32Common::unix2dos(U82T_s(*field->data.str));
+			if (field->data.str.data) {
+				const tstring ts_text = LibWin32Common::unix2dos(U82T_c(field->data.str.data));
 				SetWindowText(hLabel, ts_text.c_str());
 			} else {
 				SetWindowText(hLabel, _T(""));
@@ -2491,6 +2465,132 @@ void RP_ShellPropSheetExt_Private::initBoldFont(HFONT hFont)
 	}
 }
 
+/**
+ * Start loading the RomData object on the load thread.
+ * A placeholder is shown until it's loaded.
+ * Called by WM_SHOWWINDOW.
+ */
+void RP_ShellPropSheetExt_Private::startLoading(void)
+{
+	assert(hDlgSheet != nullptr);
+	assert(hLoadThread == nullptr);
+	if (!hDlgSheet || hLoadThread)
+		return;
+
+	// Show a placeholder while loading.
+	RECT rectDlg;
+	GetClientRect(hDlgSheet, &rectDlg);
+	const SIZE szLabel = {rectDlg.right - rectDlg.left, 32};
+	// tr: Shown while the ROM is being loaded.
+	lblLoading = CreateWindowEx(WS_EX_NOPARENTNOTIFY | WS_EX_TRANSPARENT,
+		WC_STATIC, U82T_c(C_("RomDataView", "Loading...")).c_str(),
+		WS_CHILD | WS_VISIBLE | SS_CENTER,
+		0, 8, szLabel.cx, szLabel.cy,
+		hDlgSheet, nullptr, nullptr, nullptr);
+	SetWindowFont(lblLoading, GetWindowFont(hDlgSheet), false);
+
+	hLoadThread = CreateThread(nullptr, 0, loadThreadProc, this, 0, nullptr);
+	if (!hLoadThread) {
+		// Unable to create the thread. Load the RomData object here.
+		loadThreadProc(this);
+	}
+}
+
+/**
+ * Load thread procedure.
+ * The RomData object is created, then its fields and header
+ * images are loaded. WM_RP_ROMDATA_LOADED is posted afterwards.
+ * @param lpParameter RP_ShellPropSheetExt_Private
+ * @return 0
+ */
+DWORD WINAPI RP_ShellPropSheetExt_Private::loadThreadProc(LPVOID lpParameter)
+{
+	RP_ShellPropSheetExt_Private *const d =
+		static_cast<RP_ShellPropSheetExt_Private*>(lpParameter);
+
+	// Open the RomData object.
+	RomData *romData = nullptr;
+	RpFile *const file = new RpFile(d->filename, RpFile::FM_OPEN_READ_GZ);
+	if (file->isOpen()) {
+		romData = RomDataFactory::create(file);
+		if (romData && !romData->isOpen()) {
+			// RomData is not open.
+			UNREF_AND_NULL_NOCHK(romData);
+		}
+	}
+	file->unref();
+
+	if (romData) {
+		// Load the fields, then the header images.
+		// RomData caches them, so loadImages() and initDialog()
+		// won't have to load them on the UI thread.
+		romData->fields();
+		const uint32_t imgbf = romData->supportedImageTypes();
+		if (imgbf & RomData::IMGBF_INT_BANNER) {
+			romData->image(RomData::IMG_INT_BANNER);
+		}
+		if (imgbf & RomData::IMGBF_INT_ICON) {
+			romData->image(RomData::IMG_INT_ICON);
+			romData->iconAnimData();
+		}
+	}
+
+	d->romDataLoaded = romData;
+	PostMessage(d->hDlgSheet, WM_RP_ROMDATA_LOADED, 0, 0);
+	return 0;
+}
+
+/**
+ * The load thread has finished loading the RomData object.
+ * Called by WM_RP_ROMDATA_LOADED.
+ */
+void RP_ShellPropSheetExt_Private::romDataLoadedEvent(void)
+{
+	if (hLoadThread) {
+		// The load thread has posted its message, so it's
+		// either already exited or about to exit.
+		WaitForSingleObject(hLoadThread, INFINITE);
+		CloseHandle(hLoadThread);
+		hLoadThread = nullptr;
+	}
+
+	// Remove the placeholder.
+	if (lblLoading) {
+		DestroyWindow(lblLoading);
+		lblLoading = nullptr;
+	}
+
+	assert(romData == nullptr);
+	romData = romDataLoaded;
+	romDataLoaded = nullptr;
+	if (!romData) {
+		// Unable to get a RomData object.
+		return;
+	}
+
+	// Load the images.
+	loadImages();
+	// Initialize the dialog.
+	initDialog();
+	// We can close the RomData's underlying IRpFile now.
+	romData->close();
+
+	// Create the "Options" button in the parent window.
+	// NOTE: If a different tab was selected while loading,
+	// the button and the animation will be started by
+	// PSN_SETACTIVE once this tab is selected again.
+	createOptionsButton();
+	const bool isVisible = !!IsWindowVisible(hDlgSheet);
+	if (hBtnOptions && !isVisible) {
+		ShowWindow(hBtnOptions, SW_HIDE);
+	}
+
+	// Start the icon animation timer.
+	if (lblIcon && isVisible) {
+		lblIcon->startAnimTimer();
+	}
+}
+
 /**
  * Initialize the dialog. (hDlgSheet)
  * Called by WM_INITDIALOG.
@@ -3686,6 +3786,98 @@ IFACEMETHODIMP RP_ShellPropSheetExt::ReplacePage(UINT uPageID, LPFNADDPROPSHEETP
 
 /** Property sheet callback functions. **/
 
+/**
+ * Add a ListView row's icon to the ImageList.
+ * @param lvData	[in/out] LvData_t
+ * @param iItem		[in] ListView row.
+ * @return ImageList index, or -1 if the row doesn't have an icon.
+ */
+int RP_ShellPropSheetExt_Private::ListView_LoadIcon(LvData_t &lvData, int iItem)
+{
+	assert(lvData.pIcons != nullptr);
+	assert(lvData.himl != nullptr);
+	if (!lvData.pIcons || !lvData.himl ||
+	    iItem < 0 || iItem >= static_cast<int>(lvData.pIcons->size()))
+	{
+		return -1;
+	}
+
+	// NOTE: get() returns a new reference.
+	const rp_image *icon = lvData.pIcons->get(iItem);
+	if (!icon) {
+		// No icon for this row.
+		return -1;
+	}
+
+	if (dwExStyleRTL != 0) {
+		// WS_EX_LAYOUTRTL will flip bitmaps in the ListView.
+		// ILC_MIRROR mirrors the bitmaps if the process is mirrored,
+		// but we can't rely on that being the case, and this option
+		// was first introduced in Windows XP.
+		// We'll flip the image here to counteract it.
+		const rp_image *const flipimg = icon->flip(rp_image::FLIP_H);
+		assert(flipimg != nullptr);
+		if (flipimg) {
+			icon->unref();
+			icon = flipimg;
+		}
+	}
+
+	// Resize the icon, if necessary.
+	if (lvData.iconResizeFactor != 1.0f) {
+		SIZE szResize = {icon->width(), icon->height()};
+		szResize.cy = static_cast<LONG>(szResize.cy * lvData.iconResizeFactor);
+
+		// If the original icon is CI8, it needs to be
+		// converted to ARGB32 first. Otherwise, the
+		// "empty" background area will be black.
+		// NOTE: We still need to specify a background color,
+		// since the ListView highlight won't show up on
+		// alpha-transparent pixels.
+		// TODO: Handle this in rp_image::resized()?
+		// TODO: Handle theme changes?
+		// TODO: Error handling.
+		if (icon->format() != rp_image::Format::ARGB32) {
+			const rp_image *const icon32 = icon->dup_ARGB32();
+			if (icon32) {
+				icon->unref();
+				icon = icon32;
+			}
+		}
+
+		// Resize the icon.
+		// Odd rows use the alternate row color.
+		const uint32_t bgColor = (iItem % 2)
+			? LibWin32Common::getAltRowColor_ARGB32()
+			: LibWin32Common::GetSysColor_ARGB32(COLOR_WINDOW);
+		const rp_image *const icon_resized = icon->resized(
+			szResize.cx, szResize.cy,
+			rp_image::AlignVCenter, bgColor);
+		assert(icon_resized != nullptr);
+		if (icon_resized) {
+			icon->unref();
+			icon = icon_resized;
+		}
+	}
+
+	HICON hIcon = RpImageWin32::toHICON(icon);
+	icon->unref();
+
+	int iImage = -1;
+	assert(hIcon != nullptr);
+	if (hIcon) {
+		int idx = ImageList_AddIcon(lvData.himl, hIcon);
+		if (idx >= 0) {
+			// Icon added.
+			iImage = idx;
+		}
+		// ImageList makes a copy of the icon.
+		DestroyIcon(hIcon);
+	}
+
+	return iImage;
+}
+
 /**
  * ListView GetDispInfo function.
  * @param plvdi	[in/out] NMLVDISPINFO
@@ -3703,21 +3895,30 @@ inline BOOL RP_ShellPropSheetExtPrivate::ListView_GetDispInfo(NMLVDISPINFO *plvd
 		// ListView data not found...
 		return ret;
 	}
-	const LvData_t &lvData = iter_lvData->second;
+	LvData_t &lvData = iter_lvData->second;
 
-	if (plvItem->mask & LVIF_TEXT) {
+	if ((plvItem->mask & LVIF_TEXT) && lvData.pListData) {
 		// Fill in text.
-		const auto &vvStr = lvData.vvStr;
+		const auto &list_data = *(lvData.pListData);
+
+		// Get the ListData_t row index.
+		int row = plvItem->iItem;
+		if (!lvData.vRowMap.empty()) {
+			row = (row >= 0 && row < static_cast<int>(lvData.vRowMap.size()))
+				? lvData.vRowMap[row] : -1;
+		}
 
 		// Is this row in range?
-		if (plvItem->iItem >= 0 && plvItem->iItem < static_cast<int>(vvStr.size())) {
+		if (row >= 0 && row < static_cast<int>(list_data.size())) {
 			// Get the row data.
-			const auto &row_data = vvStr.at(plvItem->iItem);
+			const auto &row_data = list_data[row];
 
 			// Is the column in range?
 			if (plvItem->iSubItem >= 0 && plvItem->iSubItem < static_cast<int>(row_data.size())) {
-				// Return the string data.
-				_tcscpy_s(plvItem->pszText, plvItem->cchTextMax, row_data[plvItem->iSubItem].c_str());
+				// Convert the string data.
+				// NOTE: Only visible rows are requested by the ListView.
+				_tcscpy_s(plvItem->pszText, plvItem->cchTextMax,
+					U82T_s(row_data[plvItem->iSubItem]).c_str());
 				ret = true;
 			}
 		}
@@ -3742,7 +3943,12 @@ inline BOOL RP_ShellPropSheetExtPrivate::ListView_GetDispInfo(NMLVDISPINFO *plvd
 				// We have an ImageList.
 				// Is this row in range?
 				if (plvItem->iItem >= 0 && plvItem->iItem < static_cast<int>(lvData.vImageList.size())) {
-					const int iImage = lvData.vImageList.at(plvItem->iItem);
+					int iImage = lvData.vImageList[plvItem->iItem];
+					if (iImage == ICON_NOT_LOADED) {
+						// Add the icon to the ImageList.
+						iImage = ListView_LoadIcon(lvData, plvItem->iItem);
+						lvData.vImageList[plvItem->iItem] = iImage;
+					}
 					if (iImage >= 0) {
 						// Set the ImageList index.
 						plvItem->iImage = iImage;
@@ -4023,49 +4229,29 @@ INT_PTR CALLBACK RP_ShellPropSheetExt_Private::DlgProc(HWND hDlg, UINT uMsg, WPA
 				return false;
 			}
 
-			if (d->isFullyInit) {
-				// Dialog is already initialized.
-				break;
-			}
-
-			// Open the RomData object.
-			RpFile *const file = new RpFile(d->filename, RpFile::FM_OPEN_READ_GZ);
-			if (!file->isOpen()) {
-				// Unable to open the file.
-				file->unref();
-				break;
-			}
-
-			d->romData = RomDataFactory::create(file);
-			file->unref();
-			if (!d->romData) {
-				// Unable to get a RomData object.
-				break;
-			} else if (!d->romData->isOpen()) {
-				// RomData is not open.
-				UNREF_AND_NULL_NOCHK(d->romData);
+			if (d->isFullyInit || d->hLoadThread || d->lblLoading) {
+				// Dialog is already initialized, or is being loaded.
 				break;
 			}
 
-			// Load the images.
-			d->loadImages();
-			// Initialize the dialog.
-			d->initDialog();
-			// We can close the RomData's underlying IRpFile now.
-			d->romData->close();
-
-			// Create the "Options" button in the parent window.
-			d->createOptionsButton();
-
-			// Start the icon animation timer.
-			if (d->lblIcon) {
-				d->lblIcon->startAnimTimer();
-			}
+			// Load the RomData object.
+			// The dialog is initialized by WM_RP_ROMDATA_LOADED.
+			d->startLoading();
 
 			// Continue normal processing.
 			break;
 		}
 
+		case WM_RP_ROMDATA_LOADED: {
+			auto *const d = reinterpret_cast<RP_ShellPropSheetExt_Private*>(GetWindowLongPtr(hDlg, GWLP_USERDATA));
+			if (!d) {
+				// No RP_ShellPropSheetExt_Private. Can't do anything...
+				return false;
+			}
+			d->romDataLoadedEvent();
+			return true;
+		}
+
 		case WM_DESTROY: {
 			auto *const d = reinterpret_cast<RP_ShellPropSheetExt_Private*>(GetWindowLongPtr(hDlg, GWLP_USERDATA));
 			if (d && d->lblIcon) {
@@ -4122,7 +4308,10 @@ INT_PTR CALLBACK RP_ShellPropSheetExt_Private::DlgProc(HWND hDlg, UINT uMsg, WPA
 				d->colorAltRow = colorAltRow;
 
 				// Reload images with the new row color.
-				d->loadImages();
+				// NOTE: The RomData object might not be loaded yet.
+				if (d->romData) {
+					d->loadImages();
+				}
 
 				// Invalidate the banner and icon rectangles.
 				if (d->lblBanner) {
@@ -11,6 +11,9 @@
 #include "RP_ThumbnailProvider.hpp"
 #include "RpImageWin32.hpp"
 
+// librptexture
+#include "librptexture/decoder/ImageDecoder.hpp"
+
 // librpbase, librpfile, librptexture
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
@@ -118,6 +121,10 @@ IFACEMETHODIMP RP_ThumbnailProvider::GetThumbnail(UINT cx, HBITMAP *phbmp, WTS_A
 	}
 	*phbmp = nullptr;
 
+	// Decode large textures on the GPU if enabled.
+	LibRpTexture::ImageDecoder::setGpuDecodeEnabled(
+		Config::instance()->gpuTextureDecode());
+
 	CreateThumbnail::GetThumbnailOutParams_t outParams;
 	outParams.retImg = nullptr;
 	int ret = d->thumbnailer.getThumbnail(d->file, cx, &outParams);
@@ -15,16 +15,16 @@
 #include "librpcpu/byteswap.h"
 using namespace LibRpBase;
 
+// librpfile
+#include "librpfile/GzReader.hpp"
+using LibRpFile::GzReader;
+
 // C++ STL classes.
 using std::string;
-using std::unique_ptr;
 
-// zlib for transparent gzip decompression.
+// zlib (for DelayLoad verification)
 #include <zlib.h>
 
-// zlib buffer size.
-#define ZLIB_BUFFER_SIZE 16384
-
 #ifdef _MSC_VER
 // MSVC: Exception handling for /DELAYLOAD.
 #include "libwin32common/DelayLoadHelper.h"
@@ -43,14 +43,12 @@ DELAYLOAD_TEST_FUNCTION_IMPL0(zlibVersion);
 RpFile_IStream::RpFile_IStream(IStream *pStream, bool gzip)
 	: super()
 	, m_pStream(pStream)
+	, m_pRaBuf(nullptr)
+	, m_raPos(0)
+	, m_raLen(0)
+	, m_pos(0)
 	, m_z_uncomp_sz(0)
-	, m_z_filepos(0)
-	, m_z_realpos(0)
-	, m_pZstm(nullptr)
-	// zlib buffer
-	, m_pZbuf(nullptr)
-	, m_zbufLen(0)
-	, m_zcurPos(0)
+	, m_pGzReader(nullptr)
 {
 	pStream->AddRef();
 
@@ -90,40 +88,21 @@ RpFile_IStream::RpFile_IStream(IStream *pStream, bool gzip)
 					m_z_uncomp_sz = le32_to_cpu(m_z_uncomp_sz);
 					if (m_z_uncomp_sz >= uliFileSize.QuadPart-(10+8)) {
 						// Valid filesize.
-						// Initialize zlib.
-						// NOTE: m_pZstm *must* be zero-initialized.
-						// Otherwise, inflateInit() will crash.
-						m_pZstm = static_cast<z_stream*>(calloc(1, sizeof(z_stream)));
-						if (m_pZstm) {
-							// Make sure the CRC32 table is initialized.
-							get_crc_table();
-
-							int err = inflateInit2(m_pZstm, 16 + MAX_WBITS);
-							if (err == Z_OK) {
-								// Allocate the zlib buffer.
-								m_pZbuf = static_cast<uint8_t*>(malloc(ZLIB_BUFFER_SIZE));
-								if (m_pZbuf) {
-									m_isCompressed = true;
-								} else {
-									// malloc() failed.
-									inflateEnd(m_pZstm);
-									free(m_pZstm);
-									m_pZstm = nullptr;
-									m_z_uncomp_sz = 0;
-								}
-							} else {
-								// Error initializing zlib.
-								free(m_pZstm);
-								m_pZstm = nullptr;
-								m_z_uncomp_sz = 0;
-							}
+						// Use random-access gzip decompression.
+						m_pGzReader = new GzReader(gzReadFunc, this);
+						if (m_pGzReader->isOpen()) {
+							m_isCompressed = true;
+						} else {
+							// Error initializing the decompressor.
+							delete m_pGzReader;
+							m_pGzReader = nullptr;
 						}
 					}
 				}
 			}
 		}
 
-		if (!m_pZstm) {
+		if (!m_pGzReader) {
 			// Error initializing zlib.
 			m_z_uncomp_sz = 0;
 		}
@@ -132,17 +111,24 @@ RpFile_IStream::RpFile_IStream(IStream *pStream, bool gzip)
 		li.QuadPart = 0;
 		m_pStream->Seek(li, STREAM_SEEK_SET, nullptr);
 	}
+
+	if (!m_pGzReader) {
+		// Use a read-ahead buffer for uncompressed streams.
+		// Start at the stream's current position.
+		LARGE_INTEGER dlibMove;
+		ULARGE_INTEGER ulibNewPosition;
+		dlibMove.QuadPart = 0;
+		if (SUCCEEDED(m_pStream->Seek(dlibMove, STREAM_SEEK_CUR, &ulibNewPosition))) {
+			m_pos = static_cast<off64_t>(ulibNewPosition.QuadPart);
+		}
+		m_pRaBuf = new uint8_t[READAHEAD_SIZE];
+	}
 }
 
 RpFile_IStream::~RpFile_IStream()
 {
-	free(m_pZbuf);
-
-	if (m_pZstm) {
-		// Close zlib.
-		inflateEnd(m_pZstm);
-		free(m_pZstm);
-	}
+	delete m_pGzReader;
+	delete[] m_pRaBuf;
 
 	if (m_pStream) {
 		m_pStream->Release();
@@ -150,75 +136,65 @@ RpFile_IStream::~RpFile_IStream()
 }
 
 /**
- * Copy the zlib stream from another RpFile_IStream.
- * @param other
- * @return 0 on success; non-zero on error.
+ * Read compressed data for m_pGzReader.
+ * @param userdata	[in] RpFile_IStream
+ * @param pos		[in] Position in the compressed file.
+ * @param ptr		[out] Output buffer.
+ * @param size		[in] Amount of data to read, in bytes.
+ * @return Number of bytes read.
  */
-int RpFile_IStream::copyZlibStream(const RpFile_IStream &other)
+size_t RpFile_IStream::gzReadFunc(void *userdata, off64_t pos, void *ptr, size_t size)
 {
-	int ret = 0;
-
-	// Delete the current stream.
-	if (m_pZstm) {
-		inflateEnd(m_pZstm);
-		free(m_pZstm);
-	}
-	free(m_pZbuf);
-
-	if (!other.m_pZstm) {
-		// No stream to copy.
-		// Zero everything out.
-		goto zero_all_values;
-	}
-
-	// Copy the stream.
-	m_pZstm = static_cast<z_stream*>(malloc(sizeof(z_stream)));
-	if (!m_pZstm) {
-		// Error allocating the z_stream.
-		m_lastError = ENOMEM;
-		ret = -1;
-		goto zero_all_values;
-	}
-	m_pZbuf = static_cast<uint8_t*>(malloc(ZLIB_BUFFER_SIZE));
-	if (!m_pZbuf) {
-		// Error allocating the zlib buffer.
-		free(m_pZstm);
-		m_lastError = ENOMEM;
-		ret = -1;
-		goto zero_all_values;
-	}		
-
-	// Copy the zlib stream.
-	// NOTE: inflateCopy() handles the internal_state struct.
-	inflateCopy(m_pZstm, other.m_pZstm);
-	m_pZstm->next_in = nullptr;
-	m_pZstm->next_out = nullptr;
-
-	// Copy the zlib buffer.
-	memcpy(m_pZbuf, other.m_pZbuf, other.m_zbufLen);
-
-	// Copy the other values.
-	m_z_uncomp_sz = other.m_z_uncomp_sz;
-	m_z_filepos = other.m_z_filepos;
-	m_z_realpos = other.m_z_realpos;
-	m_zbufLen = other.m_zbufLen;
-	m_zcurPos = other.m_zcurPos;
-
-	// We're done here.
-	return 0;
+	RpFile_IStream *const q = static_cast<RpFile_IStream*>(userdata);
+	if (!q->m_pStream) {
+		return 0;
+	}
 
-zero_all_values:
-	// Zero everything.
-	m_pZstm = nullptr;
-	m_pZbuf = nullptr;
+	LARGE_INTEGER dlibMove;
+	dlibMove.QuadPart = pos;
+	HRESULT hr = q->m_pStream->Seek(dlibMove, STREAM_SEEK_SET, nullptr);
+	if (FAILED(hr)) {
+		// Unable to seek.
+		return 0;
+	}
 
-	m_z_uncomp_sz = 0;
-	m_z_filepos = 0;
-	m_z_realpos = 0;
-	m_zbufLen = 0;
-	m_zcurPos = 0;
+	// S_FALSE: End of file. Return whatever was read.
+	ULONG cbRead = 0;
+	hr = q->m_pStream->Read(ptr, static_cast<ULONG>(size), &cbRead);
+	if (FAILED(hr)) {
+		// Read error.
+		return 0;
+	}
+	return cbRead;
+}
 
-	return ret;
+/**
+ * Read data directly from the stream.
+ * @param pos	[in] Position in the stream.
+ * @param ptr	[out] Output buffer.
+ * @param size	[in] Amount of data to read, in bytes.
+ * @return Number of bytes read, or 0 on error. (m_lastError is set on error)
+ */
+size_t RpFile_IStream::readDirect(off64_t pos, void *ptr, size_t size)
+{
+	LARGE_INTEGER dlibMove;
+	dlibMove.QuadPart = pos;
+	HRESULT hr = m_pStream->Seek(dlibMove, STREAM_SEEK_SET, nullptr);
+	if (FAILED(hr)) {
+		// TODO: Convert hr to POSIX?
+		m_lastError = EIO;
+		return 0;
+	}
+
+	// S_FALSE: End of file. Return whatever was read.
+	ULONG cbRead = 0;
+	hr = m_pStream->Read(ptr, static_cast<ULONG>(size), &cbRead);
+	if (FAILED(hr)) {
+		// TODO: Convert hr to POSIX?
+		m_lastError = EIO;
+		return 0;
+	}
+	return static_cast<size_t>(cbRead);
 }
 
 /**
@@ -257,119 +233,47 @@ size_t RpFile_IStream::read(void *ptr, size_t size)
 		return 0;
 	}
 
-	if (m_pZstm) {
+	if (m_pGzReader) {
 		// Read and decompress.
-		// Reference: https://www.codeproject.com/Articles/3602/Zlib-compression-decompression-wrapper-as-ISequent
-		m_pZstm->next_out = static_cast<Bytef*>(ptr);
-		m_pZstm->avail_out = static_cast<uInt>(size);
-
-		// Only seek if we need to read data.
-		bool didSeek = false;
-
-		if (m_zcurPos == m_zbufLen) {
-			// Need to read more data from the gzipped file.
-			if (!didSeek) {
-				// Seek to the last real position.
-				LARGE_INTEGER dlibMove;
-				dlibMove.QuadPart = m_z_realpos;
-				hr = m_pStream->Seek(dlibMove, STREAM_SEEK_SET, nullptr);
-				if (FAILED(hr)) {
-					// Unable to seek.
-					m_lastError = EIO;
-					return 0;
-				}
-				didSeek = true;
-			}
-			// S_FALSE: End of file. Continue processing with
-			//          whatever's left.
-			// E_PENDING: TODO
-			// Other: Error.
-			hr = m_pStream->Read(m_pZbuf, ZLIB_BUFFER_SIZE, &m_zbufLen);
-			if (FAILED(hr) && hr != S_FALSE) {
-				// Read error.
-				m_lastError = EIO;
-				return 0;
-			}
-			m_z_realpos += m_zbufLen;
-			m_zcurPos = 0;
+		const size_t sz_read = m_pGzReader->read(ptr, size);
+		if (sz_read != size && m_pGzReader->lastError() != 0) {
+			m_lastError = m_pGzReader->lastError();
 		}
-
-		int err = Z_OK;
-		do {
-			m_pZstm->next_in = &m_pZbuf[m_zcurPos];
-			m_pZstm->avail_in = m_zbufLen - m_zcurPos;
-
-			if (m_pZstm->avail_in == 0) {
-				// Out of data.
-				return 0;
-			}
-
-			err = inflate(m_pZstm, Z_SYNC_FLUSH);
-			switch (err) {
-				case Z_OK:
-				case Z_STREAM_END:
-					// Data decompressed successfully.
-					// NOTE: Z_STREAM_END occurs if we reached
-					// the end of the stream in this read.
-					break;
-				default:
-					// Error decompressing data.
-					m_lastError = EIO;
-					return 0;
-			}
-
-			if (m_pZstm->avail_out == 0) {
-				m_zcurPos = static_cast<unsigned int>(m_pZstm->next_in - m_pZbuf);
-				break;
-			}
-
-			// Read more data from the gzipped file.
-			if (!didSeek) {
-				// Seek to the last real position.
-				LARGE_INTEGER dlibMove;
-				dlibMove.QuadPart = m_z_realpos;
-				hr = m_pStream->Seek(dlibMove, STREAM_SEEK_SET, nullptr);
-				if (FAILED(hr)) {
-					// Unable to seek.
-					m_lastError = EIO;
-					return 0;
-				}
-				didSeek = true;
-			}
-
-			m_zcurPos = 0;
-			hr = m_pStream->Read(m_pZbuf, ZLIB_BUFFER_SIZE, &m_zbufLen);
-			// S_FALSE: End of file. Continue processing with
-			//          whatever's left.
-			// E_PENDING: TODO
-			// Other: Error.
-			if (FAILED(hr) && hr != S_FALSE) {
-				// Read error.
-				m_lastError = EIO;
-				m_zbufLen = 0;
-				return 0;
-			}
-			m_z_realpos += m_zbufLen;
-		} while (m_pZstm->avail_out > 0);
-
-		// Adjust the current seek pointer based on how much data was read.
-		const unsigned int sz_read = static_cast<unsigned int>(size - m_pZstm->avail_out);
-		m_z_filepos += sz_read;
-
-		// We're done here.
 		return sz_read;
 	}
 
-	ULONG cbRead;
-	hr = m_pStream->Read(ptr, (ULONG)size, &cbRead);
-	if (FAILED(hr)) {
-		// An error occurred.
-		// TODO: Convert hr to POSIX?
-		m_lastError = EIO;
-		return 0;
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t sz_total = 0;
+
+	// Copy whatever is available in the read-ahead buffer.
+	if (m_raLen > 0 && m_pos >= m_raPos && m_pos < m_raPos + static_cast<off64_t>(m_raLen)) {
+		const size_t offset = static_cast<size_t>(m_pos - m_raPos);
+		const size_t sz_copy = std::min(size, m_raLen - offset);
+		memcpy(ptr8, &m_pRaBuf[offset], sz_copy);
+		ptr8 += sz_copy;
+		size -= sz_copy;
+		sz_total += sz_copy;
+		m_pos += sz_copy;
+	}
+	if (size == 0) {
+		return sz_total;
 	}
 
-	return (size_t)cbRead;
+	if (size >= READAHEAD_SIZE) {
+		// Large read. Read it directly into the output buffer.
+		const size_t sz_read = readDirect(m_pos, ptr8, size);
+		m_pos += sz_read;
+		return sz_total + sz_read;
+	}
+
+	// Refill the read-ahead buffer.
+	// NOTE: If the read failed, the buffer is empty.
+	m_raPos = m_pos;
+	m_raLen = readDirect(m_pos, m_pRaBuf, READAHEAD_SIZE);
+	const size_t sz_copy = std::min(size, m_raLen);
+	memcpy(ptr8, m_pRaBuf, sz_copy);
+	m_pos += sz_copy;
+	return sz_total + sz_copy;
 }
 
 /**
@@ -387,13 +291,24 @@ size_t RpFile_IStream::write(const void *ptr, size_t size)
 	}
 
 	// Cannot write to zlib streams.
-	if (m_pZstm) {
+	if (m_pGzReader) {
 		m_lastError = EROFS;
 		return 0;
 	}
 
+	// The stream is modified, so the buffered data may be outdated.
+	invalidateReadAhead();
+	LARGE_INTEGER dlibMove;
+	dlibMove.QuadPart = m_pos;
+	HRESULT hr = m_pStream->Seek(dlibMove, STREAM_SEEK_SET, nullptr);
+	if (FAILED(hr)) {
+		// TODO: Convert HRESULT to POSIX?
+		m_lastError = EIO;
+		return 0;
+	}
+
 	ULONG cbWritten;
-	HRESULT hr = m_pStream->Write(ptr, (ULONG)size, &cbWritten);
+	hr = m_pStream->Write(ptr, (ULONG)size, &cbWritten);
 	if (FAILED(hr)) {
 		// An error occurred.
 		// TODO: Convert HRESULT to POSIX?
@@ -401,6 +316,7 @@ size_t RpFile_IStream::write(const void *ptr, size_t size)
 		return 0;
 	}
 
+	m_pos += cbWritten;
 	return (size_t)cbWritten;
 }
 
@@ -411,113 +327,28 @@ size_t RpFile_IStream::write(const void *ptr, size_t size)
  */
 int RpFile_IStream::seek(off64_t pos)
 {
-	LARGE_INTEGER dlibMove;
-	HRESULT hr;
-
 	if (!m_pStream) {
 		m_lastError = EBADF;
 		return -1;
 	}
 
-	if (m_pZstm) {
-		// zlib stream: Special seek handling.
-		if (pos == m_z_filepos) {
-			// No seek necessary.
-			return 0;
+	if (m_pGzReader) {
+		// zlib stream: Seek within the decompressed data.
+		int ret = m_pGzReader->seek(pos);
+		if (ret != 0) {
+			m_lastError = m_pGzReader->lastError();
 		}
-
-		size_t skip_bytes;
-		if (pos < m_z_filepos) {
-			// Reset the stream first.
-			inflateEnd(m_pZstm);
-
-			m_z_filepos = 0;
-			m_zbufLen = 0;
-			m_zcurPos = 0;
-			memset(m_pZstm, 0, sizeof(*m_pZstm));
-			int err = inflateInit2(m_pZstm, 16+MAX_WBITS);
-
-			// Seek to the beginning of the real file.
-			m_z_realpos = 0;
-			dlibMove.QuadPart = 0;
-			hr = m_pStream->Seek(dlibMove, STREAM_SEEK_SET, nullptr);
-
-			if (err != Z_OK || FAILED(hr)) {
-				// Error initializing the zlib stream
-				// and/or rewinding the base stream.
-				// Cannot continue with this stream.
-				free(m_pZstm);
-				free(m_pZbuf);
-				m_pZstm = nullptr;
-				m_pZbuf = nullptr;
-				m_z_uncomp_sz = 0;
-
-				m_pStream->Release();
-				m_pStream = nullptr;
-				return -1;
-			}
-
-			skip_bytes = static_cast<size_t>(pos);
-		} else if (pos > m_z_filepos) {
-			// Skip over the bytes.
-			skip_bytes = static_cast<size_t>(pos - m_z_filepos);
-		} else {
-			// Should not happen...
-			assert(!"Something happened...");
-			return -1;
-		}
-
-		// Skip over the required number of bytes.
-		unique_ptr<uint8_t[]> skip_buf(new uint8_t[ZLIB_BUFFER_SIZE]);
-		while (skip_bytes > 0) {
-			size_t sz_to_read = (skip_bytes > ZLIB_BUFFER_SIZE ? ZLIB_BUFFER_SIZE : skip_bytes);
-			size_t sz_read = this->read(skip_buf.get(), sz_to_read);
-			if (sz_read != sz_to_read) {
-				// Error...
-				m_lastError = -EIO;
-				return -1;
-			}
-
-			skip_bytes -= sz_to_read;
-		}
-
-		// Seek was successful.
-		return 0;
+		return ret;
 	}
 
-	// Seek in the base stream.
-	dlibMove.QuadPart = pos;
-	hr = m_pStream->Seek(dlibMove, STREAM_SEEK_SET, nullptr);
-	if (FAILED(hr)) {
-		// TODO: Convert hr to POSIX?
-		m_lastError = EIO;
+	// The base stream is seeked when it's accessed, so only
+	// the position needs to be updated here. The read-ahead
+	// buffer is kept, since the new position may be within it.
+	if (pos < 0) {
+		m_lastError = EINVAL;
 		return -1;
 	}
-
-	if (m_pZstm) {
-		// Reset the zlib stream.
-		m_z_filepos = 0;
-		m_z_realpos = 0;
-		m_zbufLen = 0;
-		m_zcurPos = 0;
-		inflateEnd(m_pZstm);
-		memset(m_pZstm, 0, sizeof(*m_pZstm));
-		int err = inflateInit2(m_pZstm, 16+MAX_WBITS);
-		if (err != Z_OK) {
-			// Error initializing the zlib stream...
-			// Cannot continue with this stream.
-			free(m_pZstm);
-			free(m_pZbuf);
-			m_pZstm = nullptr;
-			m_pZbuf = nullptr;
-			m_z_uncomp_sz = 0;
-
-			m_pStream->Release();
-			m_pStream = nullptr;
-			return -1;
-		}
-	}
-
+	m_pos = pos;
 	return 0;
 }
 
@@ -532,22 +363,12 @@ off64_t RpFile_IStream::tell(void)
 		return -1;
 	}
 
-	if (m_pZstm) {
+	if (m_pGzReader) {
 		// zlib-compressed file.
-		return static_cast<off64_t>(m_z_filepos);
+		return m_pGzReader->tell();
 	}
 
-	LARGE_INTEGER dlibMove;
-	ULARGE_INTEGER ulibNewPosition;
-	dlibMove.QuadPart = 0;
-	HRESULT hr = m_pStream->Seek(dlibMove, STREAM_SEEK_CUR, &ulibNewPosition);
-	if (FAILED(hr)) {
-		// TODO: Convert HRESULT to POSIX?
-		m_lastError = EIO;
-		return -1;
-	}
-
-	return static_cast<off64_t>(ulibNewPosition.QuadPart);
+	return m_pos;
 }
 
 /**
@@ -564,27 +385,19 @@ int RpFile_IStream::truncate(off64_t size)
 	} else if (size < 0) {
 		m_lastError = EINVAL;
 		return -1;
-	} else if (m_pZstm) {
+	} else if (m_pGzReader) {
 		// zlib is read-only.
 		m_lastError = EROFS;
 		return -1;
 	}
 
-	// Get the current stream position.
-	LARGE_INTEGER dlibMove;
-	ULARGE_INTEGER ulibNewPosition;
-	dlibMove.QuadPart = 0;
-	HRESULT hr = m_pStream->Seek(dlibMove, STREAM_SEEK_CUR, &ulibNewPosition);
-	if (FAILED(hr)) {
-		// TODO: Convert HRESULT to POSIX?
-		m_lastError = EIO;
-		return -1;
-	}
+	// The buffered data may be past the new end of the stream.
+	invalidateReadAhead();
 
 	// Truncate the stream.
 	ULARGE_INTEGER ulibNewSize;
 	ulibNewSize.QuadPart = static_cast<ULONGLONG>(size);
-	hr = m_pStream->SetSize(ulibNewSize);
+	HRESULT hr = m_pStream->SetSize(ulibNewSize);
 	if (FAILED(hr)) {
 		// TODO: Convert HRESULT to POSIX?
 		m_lastError = EIO;
@@ -593,14 +406,8 @@ int RpFile_IStream::truncate(off64_t size)
 
 	// If the previous position was past the new
 	// stream size, reset the pointer.
-	if (ulibNewPosition.QuadPart > ulibNewSize.QuadPart) {
-		dlibMove.QuadPart = size;
-		hr = m_pStream->Seek(dlibMove, STREAM_SEEK_SET, nullptr);
-		if (FAILED(hr)) {
-			// TODO: Convert HRESULT to POSIX?
-			m_lastError = EIO;
-			return -1;
-		}
+	if (m_pos > size) {
+		m_pos = size;
 	}
 
 	// Stream truncated.
@@ -618,7 +425,7 @@ int RpFile_IStream::flush(void)
 	if (!m_pStream) {
 		m_lastError = EBADF;
 		return -1;
-	} else if (m_pZstm) {
+	} else if (m_pGzReader) {
 		// zlib is read-only.
 		m_lastError = EROFS;
 		return -1;
@@ -651,7 +458,7 @@ off64_t RpFile_IStream::size(void)
 		return -1;
 	}
 
-	if (m_pZstm) {
+	if (m_pGzReader) {
 		// zlib-compressed file.
 		return static_cast<off64_t>(m_z_uncomp_sz);
 	}
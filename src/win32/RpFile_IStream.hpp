@@ -12,8 +12,9 @@
 #include "librpfile/IRpFile.hpp"
 #include <objidl.h>
 
-// zlib
-struct z_stream_s;
+namespace LibRpFile {
+	class GzReader;
+}
 
 class RpFile_IStream final : public LibRpFile::IRpFile
 {
@@ -120,22 +121,48 @@ class RpFile_IStream final : public LibRpFile::IRpFile
 		IStream *m_pStream;
 		std::string m_filename;
 
-		// zlib
+		// Read-ahead buffer. (not used for gzip streams)
+		// Explorer may provide streams backed by SMB shares or
+		// cloud file placeholders, where each IStream::Read()
+		// is a round trip, so small reads are served from a
+		// larger buffer. The file position is tracked in m_pos,
+		// and the stream is always seeked before it's accessed.
+		static const size_t READAHEAD_SIZE = 64*1024;
+		uint8_t *m_pRaBuf;
+		off64_t m_raPos;	// Position of the buffered data.
+		size_t m_raLen;		// Amount of buffered data.
+		off64_t m_pos;		// Current position.
+
+		/**
+		 * Invalidate the read-ahead buffer.
+		 */
+		inline void invalidateReadAhead(void)
+		{
+			m_raLen = 0;
+		}
+
+		/**
+		 * Read data directly from the stream.
+		 * @param pos	[in] Position in the stream.
+		 * @param ptr	[out] Output buffer.
+		 * @param size	[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read, or 0 on error. (m_lastError is set on error)
+		 */
+		size_t readDirect(off64_t pos, void *ptr, size_t size);
+
+		// gzip decompression
 		unsigned int m_z_uncomp_sz;
-		unsigned int m_z_filepos;	// position in compressed file
-		off64_t m_z_realpos;		// position in real file
-		struct z_stream_s *m_pZstm;
-		// zlib buffer
-		uint8_t *m_pZbuf;
-		ULONG m_zbufLen;
-		ULONG m_zcurPos;
+		LibRpFile::GzReader *m_pGzReader;
 
 		/**
-		 * Copy the zlib stream from another RpFile_IStream.
-		 * @param other
-		 * @return 0 on success; non-zero on error.
+		 * Read compressed data for m_pGzReader.
+		 * @param userdata	[in] RpFile_IStream
+		 * @param pos		[in] Position in the compressed file.
+		 * @param ptr		[out] Output buffer.
+		 * @param size		[in] Amount of data to read, in bytes.
+		 * @return Number of bytes read.
 		 */
-		int copyZlibStream(const RpFile_IStream &other);
+		static size_t gzReadFunc(void *userdata, off64_t pos, void *ptr, size_t size);
 };
 
 #endif /* __ROMPROPERTIES_WIN32_RPFILE_ISTREAM_HPP__ */
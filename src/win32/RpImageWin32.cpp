@@ -292,13 +292,64 @@ HBITMAP RpImageWin32::toHBITMAP_alpha(const rp_image *image, const SIZE &size, b
 
 	// Convert to HBITMAP.
 	// TODO: Const-ness stuff.
-	if (size.cx <= 0 || size.cy <= 0) {
+	if (size.cx <= 0 || size.cy <= 0 ||
+	    (size.cx == image->width() && size.cy == image->height()))
+	{
 		// No resize is required.
 		return const_cast<RpGdiplusBackend*>(backend)->toHBITMAP_alpha();
-	} else {
-		// Resize is required.
-		return const_cast<RpGdiplusBackend*>(backend)->toHBITMAP_alpha(size, nearest);
 	}
+
+	// Resize is required.
+	// Use rp_image's scaler instead of GDI+. The scaled image
+	// is temporary, so its DIB section can be used directly.
+	rp_image *const scaled_img = image->scaled(size.cx, size.cy,
+		(nearest ? rp_image::SCALE_NEAREST : rp_image::SCALE_BILINEAR));
+	if (!scaled_img) {
+		// Error scaling the image.
+		return nullptr;
+	}
+
+	HBITMAP hBitmap = detachHBITMAP_alpha(scaled_img);
+	scaled_img->unref();
+	return hBitmap;
+}
+
+/**
+ * Convert a temporary rp_image to HBITMAP.
+ * This version preserves the alpha channel.
+ *
+ * If the image data is stored in a DIB section, it will be
+ * handed off to the caller without copying, and the rp_image
+ * will be cleared. Otherwise, the image will be copied.
+ *
+ * @param image	[in] rp_image. (Must not be used afterwards except for unref().)
+ * @return HBITMAP, or nullptr on error.
+ */
+HBITMAP RpImageWin32::detachHBITMAP_alpha(rp_image *image)
+{
+	assert(image != nullptr);
+	assert(image->isValid());
+	if (!image || !image->isValid()) {
+		// Invalid image.
+		return nullptr;
+	}
+
+	// We should be using the RpGdiplusBackend.
+	// TODO: Const-ness stuff.
+	RpGdiplusBackend *backend = const_cast<RpGdiplusBackend*>(
+		dynamic_cast<const RpGdiplusBackend*>(image->backend()));
+	assert(backend != nullptr);
+	if (!backend) {
+		// Incorrect backend set.
+		return nullptr;
+	}
+
+	HBITMAP hBitmap = backend->detachHBITMAP();
+	if (!hBitmap) {
+		// Not stored in a DIB section.
+		hBitmap = backend->toHBITMAP_alpha();
+	}
+	return hBitmap;
 }
 
 /**
@@ -72,6 +72,19 @@ class RpImageWin32
 		 */
 		static HBITMAP toHBITMAP_alpha(const LibRpTexture::rp_image *image, const SIZE &size, bool nearest);
 
+		/**
+		 * Convert a temporary rp_image to HBITMAP.
+		 * This version preserves the alpha channel.
+		 *
+		 * If the image data is stored in a DIB section, it will be
+		 * handed off to the caller without copying, and the rp_image
+		 * will be cleared. Otherwise, the image will be copied.
+		 *
+		 * @param image	[in] rp_image. (Must not be used afterwards except for unref().)
+		 * @return HBITMAP, or nullptr on error.
+		 */
+		static HBITMAP detachHBITMAP_alpha(LibRpTexture::rp_image *image);
+
 		/**
 		 * Convert an rp_image to HICON.
 		 * @param image rp_image.
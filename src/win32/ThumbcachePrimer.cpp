@@ -0,0 +1,309 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (Win32)                            *
+ * ThumbcachePrimer.cpp: Pre-generate Explorer thumbnails.                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ThumbcachePrimer.hpp"
+#include "thumbcache-wrapper.hpp"
+
+// librpthreads
+#include "librpthreads/Atomics.h"
+#include "librpthreads/ThreadPool.hpp"
+using LibRpThreads::ThreadPool;
+
+// libromdata
+#include "libromdata/RomDataFactory.hpp"
+using LibRomData::RomDataFactory;
+
+// C++ STL classes.
+using std::tstring;
+using std::unordered_set;
+using std::vector;
+
+/**
+ * Thumbnail sizes to generate.
+ * These are the sizes Explorer requests for the
+ * "Medium icons" and "Large icons" views.
+ * ("Extra large icons" uses the 256px thumbnail.)
+ */
+static const UINT thumbnailSizes[] = {96, 256};
+
+/**
+ * Get the file extensions that rom-properties can thumbnail.
+ * @return File extensions, in lowercase, including the leading dot.
+ */
+static const unordered_set<tstring> &thumbnailExts(void)
+{
+	// NOTE: C++11 guarantees thread-safe initialization.
+	static const unordered_set<tstring> exts = []() {
+		unordered_set<tstring> exts;
+		for (const RomDataFactory::ExtInfo &extInfo : RomDataFactory::supportedFileExtensions()) {
+			if (!(extInfo.attrs & RomDataFactory::RDA_HAS_THUMBNAIL))
+				continue;
+			tstring ext = U82T_c(extInfo.ext);
+			CharLower(&ext[0]);
+			exts.insert(std::move(ext));
+		}
+		return exts;
+	}();
+	return exts;
+}
+
+ThumbcachePrimer::ThumbcachePrimer()
+	: m_threadCount(0)
+{ }
+
+/**
+ * Add a directory to scan.
+ * Subdirectories are scanned recursively.
+ * @param path Directory.
+ */
+void ThumbcachePrimer::addDirectory(const tstring &path)
+{
+	if (path.empty())
+		return;
+
+	// Remove trailing backslashes.
+	tstring dir = path;
+	while (dir.size() > 1 && (dir[dir.size()-1] == _T('\\') || dir[dir.size()-1] == _T('/'))) {
+		dir.resize(dir.size()-1);
+	}
+	m_dirs.push_back(std::move(dir));
+}
+
+/**
+ * Is the system running on battery power?
+ * @return True if on battery power; false if on AC power or unknown.
+ */
+bool ThumbcachePrimer::isOnBattery(void)
+{
+	SYSTEM_POWER_STATUS sps;
+	if (!GetSystemPowerStatus(&sps)) {
+		return false;
+	}
+	// ACLineStatus: 0 == offline, 1 == online, 255 == unknown
+	return (sps.ACLineStatus == 0);
+}
+
+/**
+ * Recursively scan a directory for files that can be thumbnailed.
+ * @param path Directory.
+ */
+void ThumbcachePrimer::scanDirectory(const tstring &path)
+{
+	const unordered_set<tstring> &exts = thumbnailExts();
+
+	tstring findFilter = path;
+	findFilter += _T("\\*");
+
+	WIN32_FIND_DATA findFileData;
+	HANDLE hFindFile = FindFirstFile(findFilter.c_str(), &findFileData);
+	if (hFindFile == INVALID_HANDLE_VALUE) {
+		// Error finding files.
+		return;
+	}
+
+	vector<tstring> subdirs;
+	do {
+		const TCHAR *const filename = findFileData.cFileName;
+		if (filename[0] == _T('.') &&
+		    (filename[1] == _T('\0') || (filename[1] == _T('.') && filename[2] == _T('\0'))))
+		{
+			// "." or ".."
+			continue;
+		}
+
+		if (findFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			// Don't follow reparse points, since they
+			// might point back to a parent directory.
+			if (!(findFileData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+				subdirs.emplace_back(path + _T('\\') + filename);
+			}
+			continue;
+		}
+
+		// Check all possible extensions, since some
+		// file extensions have multiple dots.
+		tstring lcname = filename;
+		CharLower(&lcname[0]);
+		for (size_t pos = lcname.find(_T('.'), 1); pos != tstring::npos;
+		     pos = lcname.find(_T('.'), pos + 1))
+		{
+			if (exts.find(lcname.substr(pos)) != exts.end()) {
+				m_files.emplace_back(path + _T('\\') + filename);
+				break;
+			}
+		}
+	} while (FindNextFile(hFindFile, &findFileData));
+	FindClose(hFindFile);
+
+	for (const tstring &subdir : subdirs) {
+		scanDirectory(subdir);
+	}
+}
+
+/**
+ * Scan the directories and generate the thumbnails.
+ * @param pStats [out,opt] Statistics.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int ThumbcachePrimer::run(Stats *pStats)
+{
+	m_files.clear();
+	for (const tstring &dir : m_dirs) {
+		scanDirectory(dir);
+	}
+
+	volatile int generated = 0, cached = 0, failed = 0;
+	volatile int onBattery = isOnBattery();
+	volatile int comError = 0;
+
+	if (!m_files.empty() && !onBattery) {
+		// Each lane processes every Nth file, so COM and the
+		// IThumbnailCache object are only initialized once per lane.
+		// NOTE: Thumbnails are generated by Explorer's thumbnail cache,
+		// which calls RP_ThumbnailProvider, so each request is mostly
+		// waiting on I/O and decoding. This is why background mode is
+		// used instead of just lowering the CPU priority.
+		ThreadPool pool(m_threadCount);
+		const unsigned int lanes = std::min<unsigned int>(pool.threadCount(),
+			static_cast<unsigned int>(m_files.size()));
+		pool.parallelFor(lanes, [&](size_t lane) {
+			// Low CPU, I/O, and memory priority.
+			SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+
+			// NOTE: If the calling thread is processing a lane and
+			// it's already using apartment threading, CoInitializeEx()
+			// returns RPC_E_CHANGED_MODE. COM can still be used.
+			HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+			const bool comInit = SUCCEEDED(hr);
+			if (FAILED(hr) && hr != RPC_E_CHANGED_MODE) {
+				ATOMIC_EXCHANGE(&comError, 1);
+				SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+				return;
+			}
+
+			IThumbnailCache *pCache = nullptr;
+			hr = CoCreateInstance(CLSID_LocalThumbnailCache, nullptr,
+				CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&pCache));
+			if (FAILED(hr)) {
+				ATOMIC_EXCHANGE(&comError, 1);
+				if (comInit) {
+					CoUninitialize();
+				}
+				SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+				return;
+			}
+
+			for (size_t i = lane; i < m_files.size(); i += lanes) {
+				// Stop if the system switched to battery power.
+				// NOTE: Other lanes may have already detected this.
+				if (ATOMIC_OR_FETCH(&onBattery, 0) != 0) {
+					break;
+				} else if (isOnBattery()) {
+					ATOMIC_EXCHANGE(&onBattery, 1);
+					break;
+				}
+
+				IShellItem *pItem = nullptr;
+				hr = SHCreateItemFromParsingName(m_files[i].c_str(), nullptr, IID_PPV_ARGS(&pItem));
+				if (FAILED(hr)) {
+					ATOMIC_INC_FETCH(&failed);
+					continue;
+				}
+
+				for (UINT size : thumbnailSizes) {
+					ISharedBitmap *pBitmap = nullptr;
+					WTS_CACHEFLAGS cacheFlags = WTS_DEFAULT;
+					hr = pCache->GetThumbnail(pItem, size, WTS_EXTRACT,
+						&pBitmap, &cacheFlags, nullptr);
+					if (FAILED(hr)) {
+						ATOMIC_INC_FETCH(&failed);
+						// Other sizes will probably fail, too.
+						break;
+					}
+					if (pBitmap) {
+						pBitmap->Release();
+					}
+					if (cacheFlags & WTS_CACHED) {
+						ATOMIC_INC_FETCH(&cached);
+					} else {
+						ATOMIC_INC_FETCH(&generated);
+					}
+				}
+				pItem->Release();
+			}
+
+			pCache->Release();
+			if (comInit) {
+				CoUninitialize();
+			}
+			SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+		});
+	}
+
+	if (pStats) {
+		pStats->files = static_cast<unsigned int>(m_files.size());
+		pStats->generated = static_cast<unsigned int>(generated);
+		pStats->cached = static_cast<unsigned int>(cached);
+		pStats->failed = static_cast<unsigned int>(failed);
+		pStats->onBattery = !!onBattery;
+	}
+	return (comError ? -ENOTSUP : 0);
+}
+
+/**
+ * Exported function for rundll32.exe.
+ *
+ * Usage: rundll32.exe rom-properties.dll,rp_prime_thumbnail_cache [-tN] dir1 [dir2...]
+ * - -tN: Use N threads. (default is the number of CPUs)
+ *
+ * This can be run as a scheduled task, e.g. with an
+ * "on idle" trigger, to keep the thumbnail cache up to date.
+ *
+ * NOTE: rundll32.exe uses the 'W' function if it's available.
+ *
+ * @param hWnd		[in] Parent window handle.
+ * @param hInstance	[in] rundll32 instance.
+ * @param pszCmdLine	[in] Command line.
+ * @param nCmdShow	[in] nCmdShow
+ */
+extern "C"
+void CALLBACK rp_prime_thumbnail_cacheW(
+	HWND hWnd, HINSTANCE hInstance, LPWSTR pszCmdLine, int nCmdShow)
+{
+	RP_UNUSED(hWnd);
+	RP_UNUSED(hInstance);
+	RP_UNUSED(nCmdShow);
+
+	if (!pszCmdLine || pszCmdLine[0] == L'\0') {
+		// No directories specified.
+		return;
+	}
+
+	int argc = 0;
+	LPWSTR *const argv = CommandLineToArgvW(pszCmdLine, &argc);
+	if (!argv) {
+		return;
+	}
+
+	ThumbcachePrimer primer;
+	for (int i = 0; i < argc; i++) {
+		if (argv[i][0] == L'-' && argv[i][1] == L't') {
+			// Thread count.
+			const long num = wcstol(&argv[i][2], nullptr, 10);
+			if (num > 0 && num <= 1024) {
+				primer.setThreadCount(static_cast<unsigned int>(num));
+			}
+			continue;
+		}
+		primer.addDirectory(argv[i]);
+	}
+	LocalFree(argv);
+
+	primer.run();
+}
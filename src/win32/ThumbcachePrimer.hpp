@@ -0,0 +1,92 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (Win32)                            *
+ * ThumbcachePrimer.hpp: Pre-generate Explorer thumbnails.                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_WIN32_THUMBCACHEPRIMER_HPP__
+#define __ROMPROPERTIES_WIN32_THUMBCACHEPRIMER_HPP__
+
+#include "common.h"
+#include "libwin32common/RpWin32_sdk.h"
+#include "tcharx.h"
+
+// C++ includes.
+#include <string>
+#include <vector>
+
+/**
+ * Pre-generate Explorer thumbnails for ROM images.
+ *
+ * Explorer only requests thumbnails when a folder is opened, so
+ * opening a large folder for the first time is slow. This walks
+ * the specified directories and requests thumbnails for all files
+ * that rom-properties can thumbnail through IThumbnailCache, which
+ * stores them in Explorer's thumbnail cache.
+ *
+ * Requests are processed by low-priority background threads.
+ * Processing stops if the system switches to battery power.
+ */
+class ThumbcachePrimer
+{
+	public:
+		ThumbcachePrimer();
+
+	private:
+		RP_DISABLE_COPY(ThumbcachePrimer)
+
+	public:
+		struct Stats {
+			unsigned int files;	// Files found
+			unsigned int generated;	// Thumbnails generated
+			unsigned int cached;	// Thumbnails that were already cached
+			unsigned int failed;	// Thumbnails that couldn't be generated
+			bool onBattery;		// Stopped because the system is on battery power
+		};
+
+		/**
+		 * Set the number of threads.
+		 * @param threadCount Number of threads. (0 for the number of CPUs)
+		 */
+		inline void setThreadCount(unsigned int threadCount)
+		{
+			m_threadCount = threadCount;
+		}
+
+		/**
+		 * Add a directory to scan.
+		 * Subdirectories are scanned recursively.
+		 * @param path Directory.
+		 */
+		void addDirectory(const std::tstring &path);
+
+		/**
+		 * Scan the directories and generate the thumbnails.
+		 * @param pStats [out,opt] Statistics.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int run(Stats *pStats = nullptr);
+
+	public:
+		/**
+		 * Is the system running on battery power?
+		 * @return True if on battery power; false if on AC power or unknown.
+		 */
+		static bool isOnBattery(void);
+
+	private:
+		/**
+		 * Recursively scan a directory for files that can be thumbnailed.
+		 * @param path Directory.
+		 */
+		void scanDirectory(const std::tstring &path);
+
+	private:
+		std::vector<std::tstring> m_dirs;
+		std::vector<std::tstring> m_files;
+		unsigned int m_threadCount;
+};
+
+#endif /* __ROMPROPERTIES_WIN32_THUMBCACHEPRIMER_HPP__ */
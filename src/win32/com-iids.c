@@ -12,3 +12,9 @@
 #ifndef HAVE_THUMBNAIL_H
 DEFINE_GUID(IID_IThumbnailProvider, 0xe357fccd, 0xa995, 0x4576, 0xb0,0x1f, 0x23, 0x46, 0x30, 0x15, 0x4e, 0x96);
 #endif /* HAVE_THUMBNAIL_H */
+
+#ifndef HAVE_THUMBCACHE_H
+DEFINE_GUID(IID_ISharedBitmap, 0x091162a4, 0xbc96, 0x411f, 0xaa,0xe8, 0xc5, 0x12, 0x2c, 0xd0, 0x33, 0x63);
+DEFINE_GUID(IID_IThumbnailCache, 0xf676c15d, 0x596a, 0x4ce2, 0x82,0x34, 0x33, 0x99, 0x6f, 0x44, 0x5d, 0xb1);
+DEFINE_GUID(CLSID_LocalThumbnailCache, 0x50ef4544, 0xac9f, 0x4a8e, 0xb2,0x1b, 0x8a, 0x26, 0x18, 0x0d, 0xb1, 0x3f);
+#endif /* HAVE_THUMBCACHE_H */
@@ -40,6 +40,82 @@ IThumbnailProvider : public IUnknown
 // Required for MinGW-w64 __uuidof() emulation.
 __CRT_UUID_DECL(IThumbnailProvider, __MSABI_LONG(0xe357fccd), 0xa995, 0x4576, 0xb0,0x1f, 0x23, 0x46, 0x30, 0x15, 0x4e, 0x96)
 
+/** IThumbnailCache (used by ThumbcachePrimer) **/
+
+typedef enum WTS_FLAGS {
+	WTS_NONE			= 0,
+	WTS_EXTRACT			= 0,
+	WTS_INCACHEONLY			= 0x1,
+	WTS_FASTEXTRACT			= 0x2,
+	WTS_FORCEEXTRACTION		= 0x4,
+	WTS_SLOWRECLAIM			= 0x8,
+	WTS_EXTRACTDONOTCACHE		= 0x20,
+	WTS_SCALETOREQUESTEDSIZE	= 0x40,
+	WTS_SKIPFASTEXTRACT		= 0x80,
+	WTS_EXTRACTINPROC		= 0x100,
+	WTS_CROPTOSQUARE		= 0x200,
+	WTS_INSTANCESURROGATE		= 0x400,
+	WTS_REQUIRESURROGATE		= 0x800,
+	WTS_APPSTYLE			= 0x2000,
+	WTS_WIDETHUMBNAILS		= 0x4000,
+	WTS_IDEALCACHESIZEONLY		= 0x8000,
+	WTS_SCALEUP			= 0x10000
+} WTS_FLAGS;
+
+typedef enum WTS_CACHEFLAGS {
+	WTS_DEFAULT	= 0,
+	WTS_LOWQUALITY	= 0x1,
+	WTS_CACHED	= 0x2
+} WTS_CACHEFLAGS;
+
+typedef struct WTS_THUMBNAILID {
+	BYTE rgbKey[16];
+} WTS_THUMBNAILID;
+
+EXTERN_C const IID IID_ISharedBitmap;
+
+MIDL_INTERFACE("091162a4-bc96-411f-aae8-c5122cd03363")
+ISharedBitmap : public IUnknown
+{
+	public:
+		virtual HRESULT STDMETHODCALLTYPE GetSharedBitmap(
+			/* [out] */ __RPC__deref_out_opt HBITMAP *phbm) = 0;
+		virtual HRESULT STDMETHODCALLTYPE GetSize(
+			/* [out] */ __RPC__out SIZE *pSize) = 0;
+		virtual HRESULT STDMETHODCALLTYPE GetFormat(
+			/* [out] */ __RPC__out WTS_ALPHATYPE *pat) = 0;
+		virtual HRESULT STDMETHODCALLTYPE InitializeBitmap(
+			/* [in] */ __RPC__in_opt HBITMAP hbm,
+			/* [in] */ WTS_ALPHATYPE wtsAT) = 0;
+		virtual HRESULT STDMETHODCALLTYPE Detach(
+			/* [out] */ __RPC__deref_out_opt HBITMAP *phbm) = 0;
+};
+
+__CRT_UUID_DECL(ISharedBitmap, __MSABI_LONG(0x091162a4), 0xbc96, 0x411f, 0xaa,0xe8, 0xc5, 0x12, 0x2c, 0xd0, 0x33, 0x63)
+
+EXTERN_C const IID IID_IThumbnailCache;
+EXTERN_C const CLSID CLSID_LocalThumbnailCache;
+
+MIDL_INTERFACE("F676C15D-596A-4ce2-8234-33996F445DB1")
+IThumbnailCache : public IUnknown
+{
+	public:
+		virtual HRESULT STDMETHODCALLTYPE GetThumbnail(
+			/* [in] */ __RPC__in_opt IShellItem *pShellItem,
+			/* [in] */ UINT cxyRequestedThumbSize,
+			/* [in] */ WTS_FLAGS flags,
+			/* [out] */ __RPC__deref_out_opt ISharedBitmap **ppvThumb,
+			/* [out] */ __RPC__out WTS_CACHEFLAGS *pOutFlags,
+			/* [out] */ __RPC__out WTS_THUMBNAILID *pThumbnailID) = 0;
+		virtual HRESULT STDMETHODCALLTYPE GetThumbnailByID(
+			/* [in] */ WTS_THUMBNAILID thumbnailID,
+			/* [in] */ UINT cxyRequestedThumbSize,
+			/* [out] */ __RPC__deref_out_opt ISharedBitmap **ppvThumb,
+			/* [out] */ __RPC__out WTS_CACHEFLAGS *pOutFlags) = 0;
+};
+
+__CRT_UUID_DECL(IThumbnailCache, __MSABI_LONG(0xf676c15d), 0x596a, 0x4ce2, 0x82,0x34, 0x33, 0x99, 0x6f, 0x44, 0x5d, 0xb1)
+
 #endif /* HAVE_THUMBCACHE_H */
 
 #endif /* __ROMPROPERTIES_WIN32_THUMBCACHE_WRAPPER_HPP__ */